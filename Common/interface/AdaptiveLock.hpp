@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Threading
+{
+
+/// Adaptive lock that spins for a bounded number of iterations before parking the thread.
+
+/// On Linux and Android, waiting threads are parked with futex, on Windows - with WaitOnAddress.
+/// On other platforms, waiting threads yield their time slice instead of parking.
+/// The lock is intended for short critical sections that are contended by many threads,
+/// where a pure spin lock wastes CPU time and std::mutex puts threads to sleep too early.
+class AdaptiveLock
+{
+public:
+    AdaptiveLock() noexcept {}
+
+    // clang-format off
+    AdaptiveLock             (const AdaptiveLock&)  = delete;
+    AdaptiveLock& operator = (const AdaptiveLock&)  = delete;
+    AdaptiveLock             (      AdaptiveLock&&) = delete;
+    AdaptiveLock& operator = (      AdaptiveLock&&) = delete;
+    // clang-format on
+
+    void lock() noexcept
+    {
+        // Assume that the lock is free on the first try.
+        std::uint32_t Expected = Unlocked;
+        if (m_State.compare_exchange_strong(Expected, Locked, std::memory_order_acquire, std::memory_order_relaxed))
+            return;
+
+        LockContended();
+    }
+
+    bool try_lock() noexcept
+    {
+        // Do a relaxed load first to prevent unnecessary cache misses if someone does while (!try_lock()).
+        if (is_locked())
+            return false;
+
+        std::uint32_t Expected = Unlocked;
+        return m_State.compare_exchange_strong(Expected, Locked, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept
+    {
+        VERIFY(is_locked(), "Attempting to unlock an adaptive lock that is not locked. This is a strong indication of a flawed logic.");
+        if (m_State.exchange(Unlocked, std::memory_order_release) == LockedWithWaiters)
+            WakeOne();
+    }
+
+    bool is_locked() const noexcept
+    {
+        // Use relaxed load as we only want to check the value.
+        // To impose ordering, lock()/try_lock() must be used.
+        return m_State.load(std::memory_order_relaxed) != Unlocked;
+    }
+
+    struct ContentionStats
+    {
+        /// The number of lock() calls that found the lock taken.
+        size_t NumContendedLocks = 0;
+
+        /// The number of times a thread was parked after spinning.
+        size_t NumParks = 0;
+    };
+
+    /// Returns the lock contention statistics.
+
+    /// The counters are only updated on the contended path and are
+    /// intended for profiling, not for synchronization.
+    ContentionStats GetContentionStats() const noexcept
+    {
+        ContentionStats Stats;
+        Stats.NumContendedLocks = m_NumContendedLocks.load(std::memory_order_relaxed);
+        Stats.NumParks          = m_NumParks.load(std::memory_order_relaxed);
+        return Stats;
+    }
+
+    void ResetContentionStats() noexcept
+    {
+        m_NumContendedLocks.store(0, std::memory_order_relaxed);
+        m_NumParks.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    void LockContended() noexcept;
+    void WaitWhileLockedWithWaiters() noexcept;
+    void WakeOne() noexcept;
+
+private:
+    static constexpr std::uint32_t Unlocked          = 0;
+    static constexpr std::uint32_t Locked            = 1;
+    static constexpr std::uint32_t LockedWithWaiters = 2;
+
+    std::atomic<std::uint32_t> m_State{Unlocked};
+
+    std::atomic<size_t> m_NumContendedLocks{0};
+    std::atomic<size_t> m_NumParks{0};
+};
+
+
+/// Mutex type used by engine-internal managers with short, frequently contended critical sections.
+
+/// When DILIGENT_USE_ADAPTIVE_LOCKS is enabled, this is AdaptiveLock, otherwise std::mutex.
+#if DILIGENT_USE_ADAPTIVE_LOCKS
+using EngineMutex = AdaptiveLock;
+#else
+using EngineMutex = std::mutex;
+#endif
+
+} // namespace Threading
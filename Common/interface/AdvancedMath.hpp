@@ -425,6 +425,219 @@ inline BoxVisibility GetBoxVisibility(const ViewFrustumExt& ViewFrustumExt,
     return BoxVisibility::Intersecting;
 }
 
+/// Structure-of-arrays bounding box data used by GetBoxVisibilityBatch()
+struct BoundBoxSoA
+{
+    const float* MinX = nullptr;
+    const float* MinY = nullptr;
+    const float* MinZ = nullptr;
+    const float* MaxX = nullptr;
+    const float* MaxY = nullptr;
+    const float* MaxZ = nullptr;
+
+    BoundBoxSoA Offset(size_t Count) const
+    {
+        return BoundBoxSoA{MinX + Count, MinY + Count, MinZ + Count, MaxX + Count, MaxY + Count, MaxZ + Count};
+    }
+};
+
+namespace AdvancedMathInternal
+{
+
+// Box coordinate streams that form the farthest (MaxPt) and the nearest (MinPt) box corners
+// along the plane normal, see GetBoxVisibilityAgainstPlane().
+struct BatchCullPlane
+{
+    const float* MaxPt[3];
+    const float* MinPt[3];
+    float        Normal[3];
+    float        Distance;
+};
+
+inline Uint32 InitBatchCullPlanes(const ViewFrustum&  Frustum,
+                                  const BoundBoxSoA&  Boxes,
+                                  FRUSTUM_PLANE_FLAGS PlaneFlags,
+                                  BatchCullPlane      Planes[])
+{
+    const float* const MinStreams[] = {Boxes.MinX, Boxes.MinY, Boxes.MinZ};
+    const float* const MaxStreams[] = {Boxes.MaxX, Boxes.MaxY, Boxes.MaxZ};
+
+    Uint32 NumPlanes = 0;
+    for (Uint32 plane_idx = 0; plane_idx < ViewFrustum::NUM_PLANES; ++plane_idx)
+    {
+        if ((PlaneFlags & (1 << plane_idx)) == 0)
+            continue;
+
+        const Plane3D&  SrcPlane = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(plane_idx));
+        BatchCullPlane& Plane    = Planes[NumPlanes++];
+        for (int i = 0; i < 3; ++i)
+        {
+            const bool IsPositive = SrcPlane.Normal[i] > 0;
+
+            Plane.MaxPt[i]  = IsPositive ? MaxStreams[i] : MinStreams[i];
+            Plane.MinPt[i]  = IsPositive ? MinStreams[i] : MaxStreams[i];
+            Plane.Normal[i] = SrcPlane.Normal[i];
+        }
+        Plane.Distance = SrcPlane.Distance;
+    }
+    return NumPlanes;
+}
+
+// Performs exactly the same operations as GetBoxVisibility() for a single box.
+// CornersMin and CornersMax are the bounds of the frustum corners or null.
+inline bool IsBoxVisibleBatch(const BatchCullPlane Planes[],
+                              Uint32               NumPlanes,
+                              const BoundBoxSoA&   Boxes,
+                              size_t               Idx,
+                              const float3*        CornersMin,
+                              const float3*        CornersMax)
+{
+    bool AllInside = true;
+    for (Uint32 p = 0; p < NumPlanes; ++p)
+    {
+        const BatchCullPlane& Plane = Planes[p];
+
+        float DMax = Plane.MaxPt[0][Idx] * Plane.Normal[0] + Plane.MaxPt[1][Idx] * Plane.Normal[1] + Plane.MaxPt[2][Idx] * Plane.Normal[2] + Plane.Distance;
+        if (DMax < 0)
+            return false;
+
+        float DMin = Plane.MinPt[0][Idx] * Plane.Normal[0] + Plane.MinPt[1][Idx] * Plane.Normal[1] + Plane.MinPt[2][Idx] * Plane.Normal[2] + Plane.Distance;
+        if (!(DMin > 0))
+            AllInside = false;
+    }
+
+    if (AllInside || CornersMin == nullptr)
+        return true;
+
+    // The frustum is outside one of the bounding box planes if all its corners are
+    return !(CornersMax->x <= Boxes.MinX[Idx] || CornersMax->y <= Boxes.MinY[Idx] || CornersMax->z <= Boxes.MinZ[Idx] ||
+             CornersMin->x >= Boxes.MaxX[Idx] || CornersMin->y >= Boxes.MaxY[Idx] || CornersMin->z >= Boxes.MaxZ[Idx]);
+}
+
+#if DILIGENT_USE_SIMD_MATH && (DILIGENT_SIMD_MATH_SSE || DILIGENT_SIMD_MATH_NEON)
+// Returns the 4-bit visibility mask of boxes Idx .. Idx + 3
+inline Uint32 GetBoxVisibilityMask4(const BatchCullPlane Planes[],
+                                    Uint32               NumPlanes,
+                                    const BoundBoxSoA&   Boxes,
+                                    size_t               Idx,
+                                    const float3*        CornersMin,
+                                    const float3*        CornersMax)
+{
+    using namespace SIMDMath;
+
+    const float4v Zero4     = Zero();
+    float4v       Invisible = Zero4;
+    float4v       AllInside = AllOnes();
+    for (Uint32 p = 0; p < NumPlanes; ++p)
+    {
+        const BatchCullPlane& Plane = Planes[p];
+
+        const float4v Nx = Splat(Plane.Normal[0]);
+        const float4v Ny = Splat(Plane.Normal[1]);
+        const float4v Nz = Splat(Plane.Normal[2]);
+        const float4v D  = Splat(Plane.Distance);
+
+        float4v DMax = Add(Add(Add(Mul(Load(Plane.MaxPt[0] + Idx), Nx), Mul(Load(Plane.MaxPt[1] + Idx), Ny)), Mul(Load(Plane.MaxPt[2] + Idx), Nz)), D);
+        float4v DMin = Add(Add(Add(Mul(Load(Plane.MinPt[0] + Idx), Nx), Mul(Load(Plane.MinPt[1] + Idx), Ny)), Mul(Load(Plane.MinPt[2] + Idx), Nz)), D);
+
+        Invisible = Or(Invisible, Less(DMax, Zero4));
+        AllInside = And(AllInside, Greater(DMin, Zero4));
+    }
+
+    if (CornersMin != nullptr)
+    {
+        float4v Outside = LessEqual(Splat(CornersMax->x), Load(Boxes.MinX + Idx));
+        Outside         = Or(Outside, LessEqual(Splat(CornersMax->y), Load(Boxes.MinY + Idx)));
+        Outside         = Or(Outside, LessEqual(Splat(CornersMax->z), Load(Boxes.MinZ + Idx)));
+        Outside         = Or(Outside, GreaterEqual(Splat(CornersMin->x), Load(Boxes.MaxX + Idx)));
+        Outside         = Or(Outside, GreaterEqual(Splat(CornersMin->y), Load(Boxes.MaxY + Idx)));
+        Outside         = Or(Outside, GreaterEqual(Splat(CornersMin->z), Load(Boxes.MaxZ + Idx)));
+        Invisible       = Or(Invisible, AndNot(Outside, AllInside));
+    }
+
+    return ~MoveMask(Invisible) & 0xFu;
+}
+#endif
+
+inline void GetBoxVisibilityBatch(const ViewFrustum&  Frustum,
+                                  const BoundBoxSoA&  Boxes,
+                                  size_t              NumBoxes,
+                                  Uint32*             pVisibilityMask,
+                                  FRUSTUM_PLANE_FLAGS PlaneFlags,
+                                  const float3*       CornersMin,
+                                  const float3*       CornersMax)
+{
+    BatchCullPlane Planes[ViewFrustum::NUM_PLANES];
+
+    const Uint32 NumPlanes = InitBatchCullPlanes(Frustum, Boxes, PlaneFlags, Planes);
+    for (size_t First = 0; First < NumBoxes; First += 32)
+    {
+        const size_t End  = (std::min)(First + 32, NumBoxes);
+        Uint32       Bits = 0;
+
+        size_t i = First;
+#if DILIGENT_USE_SIMD_MATH && (DILIGENT_SIMD_MATH_SSE || DILIGENT_SIMD_MATH_NEON)
+        for (; i + 4 <= End; i += 4)
+            Bits |= GetBoxVisibilityMask4(Planes, NumPlanes, Boxes, i, CornersMin, CornersMax) << (i - First);
+#endif
+        for (; i < End; ++i)
+        {
+            if (IsBoxVisibleBatch(Planes, NumPlanes, Boxes, i, CornersMin, CornersMax))
+                Bits |= 1u << (i - First);
+        }
+
+        pVisibilityMask[First / 32] = Bits;
+    }
+}
+
+} // namespace AdvancedMathInternal
+
+/// Tests a batch of bounding boxes against the view frustum.
+
+/// \param [in]  Frustum         - View frustum.
+/// \param [in]  Boxes           - Structure-of-arrays bounding box coordinates.
+/// \param [in]  NumBoxes        - The number of boxes to test.
+/// \param [out] pVisibilityMask - Visibility bitmask. Bit (i % 32) of pVisibilityMask[i / 32] is set
+///                                if box i is not BoxVisibility::Invisible. The array must contain
+///                                at least (NumBoxes + 31) / 32 elements; unused bits of the last
+///                                element are set to zero.
+/// \param [in]  PlaneFlags      - Frustum planes to test the boxes against.
+///
+/// \remarks    The results are identical to calling GetBoxVisibility() for every box.
+inline void GetBoxVisibilityBatch(const ViewFrustum&  Frustum,
+                                  const BoundBoxSoA&  Boxes,
+                                  size_t              NumBoxes,
+                                  Uint32*             pVisibilityMask,
+                                  FRUSTUM_PLANE_FLAGS PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+{
+    AdvancedMathInternal::GetBoxVisibilityBatch(Frustum, Boxes, NumBoxes, pVisibilityMask, PlaneFlags, nullptr, nullptr);
+}
+
+/// Tests a batch of bounding boxes against the view frustum.
+/// When all frustum planes are enabled, the frustum corners are used to additionally cull
+/// boxes the same way as in GetBoxVisibility(const ViewFrustumExt&, ...).
+inline void GetBoxVisibilityBatch(const ViewFrustumExt& FrustumExt,
+                                  const BoundBoxSoA&    Boxes,
+                                  size_t                NumBoxes,
+                                  Uint32*               pVisibilityMask,
+                                  FRUSTUM_PLANE_FLAGS   PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+{
+    if ((PlaneFlags & FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) != FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+    {
+        GetBoxVisibilityBatch(static_cast<const ViewFrustum&>(FrustumExt), Boxes, NumBoxes, pVisibilityMask, PlaneFlags);
+        return;
+    }
+
+    float3 CornersMin = FrustumExt.FrustumCorners[0];
+    float3 CornersMax = FrustumExt.FrustumCorners[0];
+    for (int i = 1; i < 8; ++i)
+    {
+        CornersMin = (std::min)(CornersMin, FrustumExt.FrustumCorners[i]);
+        CornersMax = (std::max)(CornersMax, FrustumExt.FrustumCorners[i]);
+    }
+    AdvancedMathInternal::GetBoxVisibilityBatch(FrustumExt, Boxes, NumBoxes, pVisibilityMask, PlaneFlags, &CornersMin, &CornersMax);
+}
+
 inline float GetPointToBoxDistance(const BoundBox& BndBox, const float3& Pos)
 {
     VERIFY_EXPR(BndBox.Max.x >= BndBox.Min.x &&
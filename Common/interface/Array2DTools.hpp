@@ -34,6 +34,8 @@
 namespace Diligent
 {
 
+class IThreadPool;
+
 /// Computes the minimum and the maximum value in a 2D floating-point array
 
 /// \param[in]  pData		   - A pointer to the array data.
@@ -49,4 +51,27 @@ void GetArray2DMinMaxValue(const float* pData,
                            float&       MinValue,
                            float&       MaxValue);
 
+/// Computes the minimum and the maximum value in a 2D floating-point array using the thread pool
+
+/// \param[in]  pData          - A pointer to the array data.
+/// \param[in]  StrideInFloats - Row stride in 32-bit floats.
+/// \param[in]  Width          - 2D array width.
+/// \param[in]  Height         - 2D array height.
+/// \param[out] MinValue       - Minimum value.
+/// \param[out] MaxValue       - Maximum value.
+/// \param[in]  pThreadPool    - Thread pool to use. If null, the array is processed by the calling thread.
+/// \param[in]  RowsPerTask    - The number of rows processed by a single task.
+///                              If 0, the value is selected automatically.
+///
+/// \remarks    The calling thread processes a part of the array and waits for the
+///             remaining tasks, so the function must not be called from a thread pool thread.
+void GetArray2DMinMaxValue(const float* pData,
+                           size_t       StrideInFloats,
+                           Uint32       Width,
+                           Uint32       Height,
+                           float&       MinValue,
+                           float&       MaxValue,
+                           IThreadPool* pThreadPool,
+                           Uint32       RowsPerTask = 0);
+
 } // namespace Diligent
@@ -0,0 +1,205 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::AsyncFileReader class
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/DataBlob.h"
+#include "ThreadPool.hpp"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Reads files asynchronously and completes the reads into data blobs.
+
+/// Every read is represented by an asynchronous task that finishes when the data is available.
+/// The task is run by the thread pool the reader was created with, so it can be used as a prerequisite
+/// of other tasks in the same pool (see IThreadPool::EnqueueTask()). This allows e.g. compiling
+/// shaders as soon as their sources are loaded while other files are still being read.
+///
+/// On Linux, the reads are submitted to the io_uring and on Win32 to the I/O completion port,
+/// so that no worker thread is blocked while the data is being read.
+/// On other platforms, or if the native asynchronous I/O is not available, the files are read
+/// by the thread pool worker threads.
+///
+/// \remarks    All methods are thread-safe.
+///             The reader must not be destroyed before the thread pool.
+///             The destructor waits until all submitted reads are finished.
+class AsyncFileReader
+{
+public:
+    /// Asynchronous file I/O backend.
+    enum BACKEND : Uint8
+    {
+        /// Files are read by the thread pool worker threads.
+        BACKEND_THREAD_POOL = 0,
+
+        /// Reads are submitted to the Linux io_uring.
+        BACKEND_IO_URING,
+
+        /// Reads are submitted to the Win32 I/O completion port.
+        BACKEND_IOCP
+    };
+
+    struct CreateInfo
+    {
+        /// Thread pool that runs the read tasks. Must not be null.
+        IThreadPool* pThreadPool = nullptr;
+
+        /// The maximum number of reads that are submitted to the OS at the same time.
+        /// Reads that exceed this number are queued until previous reads complete.
+        Uint32 QueueDepth = 64;
+
+        /// If true, files are always read by the thread pool worker threads,
+        /// even if the native asynchronous I/O is available.
+        bool ForceThreadPool = false;
+    };
+
+    struct ReadRequest
+    {
+        /// Path to the file to read.
+        const Char* Path = nullptr;
+
+        /// Offset, in bytes, from the beginning of the file.
+        Uint64 Offset = 0;
+
+        /// The number of bytes to read.
+        /// If zero, the file is read from Offset to the end.
+        Uint64 Size = 0;
+
+        /// Priority of the read task in the thread pool.
+        float Priority = 0;
+
+        constexpr ReadRequest() noexcept {}
+
+        constexpr ReadRequest(const Char* _Path,
+                              Uint64      _Offset   = ReadRequest{}.Offset,
+                              Uint64      _Size     = ReadRequest{}.Size,
+                              float       _Priority = ReadRequest{}.Priority) noexcept :
+            Path{_Path},
+            Offset{_Offset},
+            Size{_Size},
+            Priority{_Priority}
+        {}
+    };
+
+    class NativeBackend;
+
+    /// Asynchronous task that represents a file read.
+    class ReadTask final : public AsyncTaskBase
+    {
+    public:
+        /// Returns the data blob that contains the file data, or null if the
+        /// task is not finished yet or the read failed.
+        IDataBlob* GetData() const;
+
+        /// Returns true if the task is finished and the data was successfully read.
+        bool IsSucceeded() const { return IsFinished() && m_Succeeded.load(); }
+
+        const std::string& GetPath() const { return m_Path; }
+        Uint64             GetOffset() const { return m_Offset; }
+
+        virtual void Run(Uint32 ThreadId) override final;
+
+    private:
+        template <typename AllocatorType, typename ObjectType>
+        friend class MakeNewRCObj;
+        friend class AsyncFileReader;
+        friend class NativeBackend;
+
+        ReadTask(IReferenceCounters* pRefCounters, const ReadRequest& Request, bool ReadInRun);
+
+        // Validates the requested range and allocates the data blob.
+        bool PrepareData(Uint64 FileSize);
+
+        void SetResult(bool Succeeded) { m_Succeeded.store(Succeeded); }
+
+    private:
+        const std::string m_Path;
+        const Uint64      m_Offset;
+        const Uint64      m_Size;
+
+        // Whether the data is read by the task itself (thread pool backend)
+        // or the task is enqueued when the data has already been read (native backends).
+        const bool m_ReadInRun;
+
+        RefCntAutoPtr<IDataBlob> m_pData;
+        std::atomic<bool>        m_Succeeded{false};
+    };
+
+    explicit AsyncFileReader(const CreateInfo& CI) noexcept(false);
+
+    ~AsyncFileReader();
+
+    // clang-format off
+    AsyncFileReader           (const AsyncFileReader&) = delete;
+    AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+    AsyncFileReader           (AsyncFileReader&&)      = delete;
+    AsyncFileReader& operator=(AsyncFileReader&&)      = delete;
+    // clang-format on
+
+    /// Starts reading the file and returns the task that finishes when the data is read.
+    RefCntAutoPtr<ReadTask> Read(const ReadRequest& Request);
+
+    /// Starts reading the batch of files.
+
+    /// \param [in]  pRequests   - An array of NumRequests read requests.
+    /// \param [in]  NumRequests - The number of requests.
+    /// \param [out] ppTasks     - An array of NumRequests tasks that receive the read tasks.
+    ///
+    /// \remarks    The whole batch is submitted to the OS with a single call, when possible.
+    void Read(const ReadRequest*       pRequests,
+              Uint32                   NumRequests,
+              RefCntAutoPtr<ReadTask>* ppTasks);
+
+    /// Waits until all reads submitted to the OS are complete.
+
+    /// \remarks    The method does not wait for the read tasks to be run by the thread pool.
+    ///             Use IAsyncTask::WaitForCompletion() or IThreadPool::WaitForAllTasks() for that.
+    void WaitForIdle();
+
+    BACKEND GetBackend() const { return m_Backend; }
+
+    IThreadPool* GetThreadPool() const { return m_pThreadPool.RawPtr<IThreadPool>(); }
+
+private:
+    RefCntAutoPtr<IThreadPool> m_pThreadPool;
+
+    std::unique_ptr<NativeBackend> m_pNativeBackend;
+
+    BACKEND m_Backend = BACKEND_THREAD_POOL;
+};
+
+} // namespace Diligent
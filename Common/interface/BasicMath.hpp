@@ -54,6 +54,16 @@
 
 #include "HashUtils.hpp"
 
+#if DILIGENT_USE_SIMD_MATH
+#    if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#        define DILIGENT_SIMD_MATH_SSE 1
+#        include <emmintrin.h>
+#    elif defined(__ARM_NEON) || defined(_M_ARM64)
+#        define DILIGENT_SIMD_MATH_NEON 1
+#        include <arm_neon.h>
+#    endif
+#endif
+
 #ifdef _MSC_VER
 #    pragma warning(push)
 #    pragma warning(disable : 4201) // nonstandard extension used: nameless struct/union
@@ -1972,6 +1982,266 @@ constexpr Vector2<T> operator*(const Matrix2x2<T>& m, const Vector2<T>& v)
     return out;
 }
 
+#if DILIGENT_USE_SIMD_MATH
+
+// SIMD implementations of the most frequently used float vector and matrix operations.
+// Every operation performs exactly the same floating-point operations in the same order
+// as the scalar version, so the results are bit-identical.
+// DILIGENT_USE_SIMD_MATH must be defined consistently for all translation units.
+
+#    if DILIGENT_SIMD_MATH_SSE || DILIGENT_SIMD_MATH_NEON
+
+namespace SIMDMath
+{
+
+#        if DILIGENT_SIMD_MATH_SSE
+
+using float4v = __m128;
+
+// clang-format off
+inline float4v Load    (const float* p)               { return _mm_loadu_ps(p); }
+inline void    Store   (float* p, float4v v)          { _mm_storeu_ps(p, v); }
+inline float4v Splat   (float f)                      { return _mm_set1_ps(f); }
+inline float4v Zero    ()                             { return _mm_setzero_ps(); }
+inline float4v Add     (float4v a, float4v b)         { return _mm_add_ps(a, b); }
+inline float4v Sub     (float4v a, float4v b)         { return _mm_sub_ps(a, b); }
+inline float4v Mul     (float4v a, float4v b)         { return _mm_mul_ps(a, b); }
+// Flips the sign of lanes 1 and 3 (Odd = true) or lanes 0 and 2 (Odd = false)
+inline float4v FlipSign(float4v v, bool Odd)          { return _mm_xor_ps(v, Odd ? _mm_set_ps(-0.f, 0.f, -0.f, 0.f) : _mm_set_ps(0.f, -0.f, 0.f, -0.f)); }
+
+// Comparisons return all-ones lanes where the condition is true and zero lanes otherwise
+inline float4v Less        (float4v a, float4v b) { return _mm_cmplt_ps(a, b); }
+inline float4v LessEqual   (float4v a, float4v b) { return _mm_cmple_ps(a, b); }
+inline float4v Greater     (float4v a, float4v b) { return _mm_cmpgt_ps(a, b); }
+inline float4v GreaterEqual(float4v a, float4v b) { return _mm_cmpge_ps(a, b); }
+inline float4v And         (float4v a, float4v b) { return _mm_and_ps(a, b); }
+inline float4v Or          (float4v a, float4v b) { return _mm_or_ps(a, b); }
+// Returns a & ~b
+inline float4v AndNot      (float4v a, float4v b) { return _mm_andnot_ps(b, a); }
+inline float4v AllOnes     ()                     { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+// Returns a 4-bit mask where bit i is set if lane i of the comparison result is true
+inline Uint32  MoveMask    (float4v m)            { return static_cast<Uint32>(_mm_movemask_ps(m)); }
+// clang-format on
+
+// Returns (v[1], v[0], v[0], v[0]), (v[2], v[2], v[1], v[1]) and (v[3], v[3], v[3], v[2]),
+// which are the columns of the 3x3 minors that exclude columns 0, 1, 2 and 3 respectively.
+inline void GetMinorColumns(float4v v, float4v& A, float4v& B, float4v& C)
+{
+    A = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 1));
+    B = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 2, 2));
+    C = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 3, 3));
+}
+
+inline void Transpose(float4v& r0, float4v& r1, float4v& r2, float4v& r3)
+{
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+}
+
+#        elif DILIGENT_SIMD_MATH_NEON
+
+using float4v = float32x4_t;
+
+// clang-format off
+inline float4v Load    (const float* p)               { return vld1q_f32(p); }
+inline void    Store   (float* p, float4v v)          { vst1q_f32(p, v); }
+inline float4v Splat   (float f)                      { return vdupq_n_f32(f); }
+inline float4v Zero    ()                             { return vdupq_n_f32(0.f); }
+inline float4v Add     (float4v a, float4v b)         { return vaddq_f32(a, b); }
+inline float4v Sub     (float4v a, float4v b)         { return vsubq_f32(a, b); }
+// vmlaq_f32 may be fused, so multiplication and addition are always separate
+inline float4v Mul     (float4v a, float4v b)         { return vmulq_f32(a, b); }
+
+inline float4v Less        (float4v a, float4v b) { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+inline float4v LessEqual   (float4v a, float4v b) { return vreinterpretq_f32_u32(vcleq_f32(a, b)); }
+inline float4v Greater     (float4v a, float4v b) { return vreinterpretq_f32_u32(vcgtq_f32(a, b)); }
+inline float4v GreaterEqual(float4v a, float4v b) { return vreinterpretq_f32_u32(vcgeq_f32(a, b)); }
+inline float4v And         (float4v a, float4v b) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+inline float4v Or          (float4v a, float4v b) { return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+inline float4v AndNot      (float4v a, float4v b) { return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+inline float4v AllOnes     ()                     { return vreinterpretq_f32_u32(vdupq_n_u32(~0u)); }
+// clang-format on
+
+inline Uint32 MoveMask(float4v m)
+{
+    static constexpr uint32_t LaneBits[4] = {1, 2, 4, 8};
+
+    const uint32x4_t Bits = vandq_u32(vreinterpretq_u32_f32(m), vld1q_u32(LaneBits));
+    const uint32x2_t Sum  = vorr_u32(vget_low_u32(Bits), vget_high_u32(Bits));
+    return vget_lane_u32(Sum, 0) | vget_lane_u32(Sum, 1);
+}
+
+inline float4v FlipSign(float4v v, bool Odd)
+{
+    static constexpr uint32_t OddMask[4]  = {0, 0x80000000u, 0, 0x80000000u};
+    static constexpr uint32_t EvenMask[4] = {0x80000000u, 0, 0x80000000u, 0};
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v), vld1q_u32(Odd ? OddMask : EvenMask)));
+}
+
+inline void GetMinorColumns(float4v v, float4v& A, float4v& B, float4v& C)
+{
+    const float32x2_t lo = vget_low_f32(v);  // v0 v1
+    const float32x2_t hi = vget_high_f32(v); // v2 v3
+    // (v1, v0, v0, v0)
+    A = vcombine_f32(vrev64_f32(lo), vdup_lane_f32(lo, 0));
+    // (v2, v2, v1, v1)
+    B = vcombine_f32(vdup_lane_f32(hi, 0), vdup_lane_f32(lo, 1));
+    // (v3, v3, v3, v2)
+    C = vcombine_f32(vdup_lane_f32(hi, 1), vrev64_f32(hi));
+}
+
+inline void Transpose(float4v& r0, float4v& r1, float4v& r2, float4v& r3)
+{
+    const float32x4x2_t t01 = vtrnq_f32(r0, r1); // (00 10 02 12), (01 11 03 13)
+    const float32x4x2_t t23 = vtrnq_f32(r2, r3); // (20 30 22 32), (21 31 23 33)
+
+    r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+
+#        endif
+
+// Sums the lanes in the same order as the scalar code: ((v0 + v1) + v2) + v3
+inline float HorizontalSum(float4v v)
+{
+    float f[4];
+    Store(f, v);
+    return f[0] + f[1] + f[2] + f[3];
+}
+
+// Computes Matrix3x3<float>::Determinant() of four 3x3 matrices, one per lane
+inline float4v Determinant3x3(float4v _11, float4v _12, float4v _13, float4v _21, float4v _22, float4v _23, float4v _31, float4v _32, float4v _33)
+{
+    float4v det = Zero();
+    det         = Add(det, Mul(_11, Sub(Mul(_22, _33), Mul(_32, _23))));
+    det         = Sub(det, Mul(_12, Sub(Mul(_21, _33), Mul(_31, _23))));
+    det         = Add(det, Mul(_13, Sub(Mul(_21, _32), Mul(_31, _22))));
+    return det;
+}
+
+// Computes the determinants of the four 3x3 minors of the matrix formed by rows
+// r0, r1 and r2 that exclude columns 0, 1, 2 and 3 respectively.
+inline float4v MinorDeterminants(float4v r0, float4v r1, float4v r2)
+{
+    float4v A0, B0, C0, A1, B1, C1, A2, B2, C2;
+    GetMinorColumns(r0, A0, B0, C0);
+    GetMinorColumns(r1, A1, B1, C1);
+    GetMinorColumns(r2, A2, B2, C2);
+    return Determinant3x3(A0, B0, C0,
+                          A1, B1, C1,
+                          A2, B2, C2);
+}
+
+} // namespace SIMDMath
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::Mul(const Matrix4x4<float>& m1, const Matrix4x4<float>& m2)
+{
+    const SIMDMath::float4v r0 = SIMDMath::Load(m2.m[0]);
+    const SIMDMath::float4v r1 = SIMDMath::Load(m2.m[1]);
+    const SIMDMath::float4v r2 = SIMDMath::Load(m2.m[2]);
+    const SIMDMath::float4v r3 = SIMDMath::Load(m2.m[3]);
+
+    Matrix4x4<float> mOut;
+    for (int i = 0; i < 4; i++)
+    {
+        // The scalar version accumulates the products starting from zero
+        SIMDMath::float4v row = SIMDMath::Zero();
+        row                   = SIMDMath::Add(row, SIMDMath::Mul(SIMDMath::Splat(m1.m[i][0]), r0));
+        row                   = SIMDMath::Add(row, SIMDMath::Mul(SIMDMath::Splat(m1.m[i][1]), r1));
+        row                   = SIMDMath::Add(row, SIMDMath::Mul(SIMDMath::Splat(m1.m[i][2]), r2));
+        row                   = SIMDMath::Add(row, SIMDMath::Mul(SIMDMath::Splat(m1.m[i][3]), r3));
+        SIMDMath::Store(mOut.m[i], row);
+    }
+    return mOut;
+}
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::Transpose() const
+{
+    SIMDMath::float4v r0 = SIMDMath::Load(m[0]);
+    SIMDMath::float4v r1 = SIMDMath::Load(m[1]);
+    SIMDMath::float4v r2 = SIMDMath::Load(m[2]);
+    SIMDMath::float4v r3 = SIMDMath::Load(m[3]);
+    SIMDMath::Transpose(r0, r1, r2, r3);
+
+    Matrix4x4<float> mOut;
+    SIMDMath::Store(mOut.m[0], r0);
+    SIMDMath::Store(mOut.m[1], r1);
+    SIMDMath::Store(mOut.m[2], r2);
+    SIMDMath::Store(mOut.m[3], r3);
+    return mOut;
+}
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::Inverse() const
+{
+    const SIMDMath::float4v r0 = SIMDMath::Load(m[0]);
+    const SIMDMath::float4v r1 = SIMDMath::Load(m[1]);
+    const SIMDMath::float4v r2 = SIMDMath::Load(m[2]);
+    const SIMDMath::float4v r3 = SIMDMath::Load(m[3]);
+
+    // Cofactors, with the signs alternating as in the scalar version
+    SIMDMath::float4v c0 = SIMDMath::FlipSign(SIMDMath::MinorDeterminants(r1, r2, r3), true);
+    SIMDMath::float4v c1 = SIMDMath::FlipSign(SIMDMath::MinorDeterminants(r0, r2, r3), false);
+    SIMDMath::float4v c2 = SIMDMath::FlipSign(SIMDMath::MinorDeterminants(r0, r1, r3), true);
+    SIMDMath::float4v c3 = SIMDMath::FlipSign(SIMDMath::MinorDeterminants(r0, r1, r2), false);
+
+    const float det = SIMDMath::HorizontalSum(SIMDMath::Mul(r0, c0));
+
+    SIMDMath::Transpose(c0, c1, c2, c3);
+
+    const SIMDMath::float4v s = SIMDMath::Splat(1.f / det);
+
+    Matrix4x4<float> inv;
+    SIMDMath::Store(inv.m[0], SIMDMath::Mul(c0, s));
+    SIMDMath::Store(inv.m[1], SIMDMath::Mul(c1, s));
+    SIMDMath::Store(inv.m[2], SIMDMath::Mul(c2, s));
+    SIMDMath::Store(inv.m[3], SIMDMath::Mul(c3, s));
+    return inv;
+}
+
+template <>
+inline Vector4<float> Vector4<float>::operator*(const Matrix4x4<float>& m) const
+{
+    SIMDMath::float4v out = SIMDMath::Mul(SIMDMath::Splat(x), SIMDMath::Load(m.m[0]));
+    out                   = SIMDMath::Add(out, SIMDMath::Mul(SIMDMath::Splat(y), SIMDMath::Load(m.m[1])));
+    out                   = SIMDMath::Add(out, SIMDMath::Mul(SIMDMath::Splat(z), SIMDMath::Load(m.m[2])));
+    out                   = SIMDMath::Add(out, SIMDMath::Mul(SIMDMath::Splat(w), SIMDMath::Load(m.m[3])));
+
+    Vector4<float> v;
+    SIMDMath::Store(&v.x, out);
+    return v;
+}
+
+inline Vector4<float> operator*(const Matrix4x4<float>& m, const Vector4<float>& v)
+{
+    SIMDMath::float4v c0 = SIMDMath::Load(m.m[0]);
+    SIMDMath::float4v c1 = SIMDMath::Load(m.m[1]);
+    SIMDMath::float4v c2 = SIMDMath::Load(m.m[2]);
+    SIMDMath::float4v c3 = SIMDMath::Load(m.m[3]);
+    SIMDMath::Transpose(c0, c1, c2, c3);
+
+    SIMDMath::float4v out = SIMDMath::Mul(c0, SIMDMath::Splat(v.x));
+    out                   = SIMDMath::Add(out, SIMDMath::Mul(c1, SIMDMath::Splat(v.y)));
+    out                   = SIMDMath::Add(out, SIMDMath::Mul(c2, SIMDMath::Splat(v.z)));
+    out                   = SIMDMath::Add(out, SIMDMath::Mul(c3, SIMDMath::Splat(v.w)));
+
+    Vector4<float> res;
+    SIMDMath::Store(&res.x, out);
+    return res;
+}
+
+inline float dot(const Vector4<float>& a, const Vector4<float>& b)
+{
+    return SIMDMath::HorizontalSum(SIMDMath::Mul(SIMDMath::Load(&a.x), SIMDMath::Load(&b.x)));
+}
+
+#    endif
+
+#endif
+
 // Common HLSL-compatible vector typedefs
 
 using uint  = uint32_t;
@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Implementation of the BufferedFileStream class
+
+#include <vector>
+
+#include "../../Primitives/interface/FileStream.h"
+#include "../../Primitives/interface/DataBlob.h"
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "FileWrapper.hpp"
+
+namespace Diligent
+{
+
+/// File stream that accumulates writes in a large buffer.
+
+/// Small writes are copied to the buffer. When the data does not fit into the buffer,
+/// the buffered data and the new data are written to the file with one vectored write,
+/// so that large writes are never copied. The buffer is allocated on the first write
+/// that fits into it, and is flushed when the stream is destroyed.
+///
+/// The stream is intended for writing large files, e.g. archives produced by
+/// IArchiver::SerializeToStream(), that are made of many small pieces.
+class BufferedFileStream : public ObjectBase<IFileStream>
+{
+public:
+    typedef ObjectBase<IFileStream> TBase;
+
+    static constexpr size_t DefaultBufferSize = size_t{4} << 20;
+
+    /// Buffer alignment, which is a multiple of the file system block size on all platforms.
+    static constexpr size_t BufferAlignment = 4096;
+
+    BufferedFileStream(IReferenceCounters* pRefCounters,
+                       const Char*         Path,
+                       EFileAccessMode     Access     = EFileAccessMode::Overwrite,
+                       size_t              BufferSize = DefaultBufferSize);
+
+    ~BufferedFileStream();
+
+    virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override;
+
+    /// Reads data from the stream. Buffered data is flushed first.
+    virtual void DILIGENT_CALL_TYPE ReadBlob(IDataBlob* pData) override;
+
+    /// Reads data from the stream. Buffered data is flushed first.
+    virtual bool DILIGENT_CALL_TYPE Read(void* Data, size_t Size) override;
+
+    /// Writes data to the stream
+    virtual bool DILIGENT_CALL_TYPE Write(const void* Data, size_t Size) override;
+
+    /// Returns the file size, including the buffered data
+    virtual size_t DILIGENT_CALL_TYPE GetSize() override;
+
+    virtual bool DILIGENT_CALL_TYPE IsValid() override;
+
+    /// Writes the buffered data to the file.
+    bool Flush();
+
+    static RefCntAutoPtr<BufferedFileStream> Create(const Char*     Path,
+                                                    EFileAccessMode Access     = EFileAccessMode::Overwrite,
+                                                    size_t          BufferSize = DefaultBufferSize);
+
+private:
+    FileWrapper m_FileWrpr;
+
+    const size_t m_BufferSize;
+
+    std::vector<Uint8> m_BufferStorage;
+    Uint8*             m_pBuffer      = nullptr;
+    size_t             m_BufferedSize = 0;
+};
+
+} // namespace Diligent
@@ -0,0 +1,137 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::CPUProfiler class and scoped profiling macros
+
+#include <atomic>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// CPU profiler event sink, see CPUProfiler::SetSink().
+struct CPUProfilerSink
+{
+    /// Called when a profiling scope begins in the current thread.
+
+    /// \param [in] Name      - Scope name. Scopes recorded by the engine use string literals.
+    /// \param [in] Timestamp - CPU timestamp of the scope beginning, see GetCPUTimestamp().
+    /// \param [in] pUserData - User data pointer, see pUserData.
+    void (*BeginScope)(const Char* Name, Uint64 Timestamp, void* pUserData) = nullptr;
+
+    /// Called when a profiling scope ends in the current thread.
+    /// Scopes of every thread end in the reverse order of their beginning.
+    void (*EndScope)(const Char* Name, Uint64 Timestamp, void* pUserData) = nullptr;
+
+    /// User data pointer that is passed to the callbacks.
+    void* pUserData = nullptr;
+};
+
+/// Process-wide CPU profiler that forwards the scopes recorded by the engine to the application.
+
+/// The engine records scopes with the DILIGENT_PROFILE_SCOPE macro. The scopes and the events of the
+/// device context instrumentation and the thread pool tasks are forwarded to the sink installed by the
+/// application, with the timestamps of the same CPU timestamp counter, so that they can be shown in one timeline
+/// with the application's own scopes. An application may record its scopes with CPUProfiler::Scope.
+///
+/// When no sink is installed, a scope only performs a single relaxed atomic load.
+/// When the engine is built without DILIGENT_ENABLE_INSTRUMENTATION CMake option,
+/// the engine scopes are compiled out.
+class CPUProfiler
+{
+public:
+    /// Installs the sink. A sink without callbacks disables the profiler.
+
+    /// \remarks    Scopes that began before the call end in the sink they began in.
+    static void SetSink(const CPUProfilerSink& Sink);
+
+    /// Returns true if a sink is installed.
+    static bool IsEnabled() noexcept
+    {
+        return sm_pSink.load(std::memory_order_relaxed) != nullptr;
+    }
+
+    /// Scope that is reported to the sink from construction till destruction.
+    class Scope
+    {
+    public:
+        /// The name must remain valid until the scope ends.
+        explicit Scope(const Char* Name) noexcept
+        {
+            if (IsEnabled())
+                Begin(Name);
+        }
+
+        ~Scope()
+        {
+            if (m_pSink != nullptr)
+                End();
+        }
+
+        // clang-format off
+        Scope           (const Scope&) = delete;
+        Scope           (Scope&&)      = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&)      = delete;
+        // clang-format on
+
+    private:
+        void Begin(const Char* Name) noexcept;
+        void End() noexcept;
+
+        const CPUProfilerSink* m_pSink = nullptr;
+        const Char*            m_Name  = nullptr;
+    };
+
+private:
+    static std::atomic<const CPUProfilerSink*> sm_pSink;
+};
+
+} // namespace Diligent
+
+/// Records the enclosing scope with the CPU profiler, see Diligent::CPUProfiler.
+/// The scope is only compiled in when the engine is built with DILIGENT_ENABLE_INSTRUMENTATION CMake option.
+#if DILIGENT_INSTRUMENTATION
+// Two levels of indirection are required to concatenate expanded macros
+#    define DILIGENT_PROFILE_SCOPE_NAME0(Line) CPUProfilerScope##Line
+#    define DILIGENT_PROFILE_SCOPE_NAME(Line)  DILIGENT_PROFILE_SCOPE_NAME0(Line)
+#    define DILIGENT_PROFILE_SCOPE(Name) \
+        ::Diligent::CPUProfiler::Scope DILIGENT_PROFILE_SCOPE_NAME(__LINE__) { Name }
+#else
+#    define DILIGENT_PROFILE_SCOPE(Name) \
+        do                               \
+        {                                \
+        } while (false)
+#endif
+
+/// Records the enclosing function with the CPU profiler, see DILIGENT_PROFILE_SCOPE.
+#define DILIGENT_PROFILE_FUNCTION() DILIGENT_PROFILE_SCOPE(__FUNCTION__)
@@ -41,6 +41,9 @@ namespace Diligent
 {
 
 /// Base interface for a data blob
+
+/// Small payloads are stored inline in the object, so that the blob requires a single allocation.
+/// Larger buffers are recycled through a global pool of power-of-two size classes.
 class DataBlobImpl final : public Diligent::ObjectBase<IDataBlob>
 {
 public:
@@ -83,8 +86,19 @@ private:
 
     explicit DataBlobImpl(IReferenceCounters* pRefCounters, size_t InitialSize = 0, const void* pData = nullptr);
 
+    bool IsInline() const { return m_pData == reinterpret_cast<const Uint8*>(m_InlineStorage); }
+
+public:
+    /// Payloads up to this size are stored inline in the object
+    static constexpr size_t InlineCapacity = 64;
+
 private:
-    std::vector<Uint8> m_DataBuff;
+    Uint8* m_pData    = nullptr;
+    size_t m_Size     = 0;
+    size_t m_Capacity = InlineCapacity;
+
+    // Uint64 elements guarantee 8-byte alignment of the inline data
+    Uint64 m_InlineStorage[InlineCapacity / sizeof(Uint64)];
 };
 
 class DataBlobAllocatorAdapter final : public IMemoryAllocator
@@ -0,0 +1,84 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of the IDataBlob interface that references external memory
+
+#include <functional>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/DataBlob.h"
+#include "RefCntAutoPtr.hpp"
+#include "ObjectBase.hpp"
+
+namespace Diligent
+{
+
+/// Data blob that references external memory without copying it.
+
+/// The blob does not own the memory. The optional release callback is called when the blob
+/// is destroyed and may be used to free the memory, for example, to release the compiler-owned
+/// output buffer. The blob can't be resized.
+class ExternalDataBlob final : public ObjectBase<IDataBlob>
+{
+public:
+    using TBase               = ObjectBase<IDataBlob>;
+    using ReleaseCallbackType = std::function<void()>;
+
+    static RefCntAutoPtr<ExternalDataBlob> Create(void* pData, size_t Size, ReleaseCallbackType ReleaseCallback = nullptr);
+
+    ~ExternalDataBlob() override;
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DataBlob, TBase)
+
+    /// External data blobs can't be resized.
+    virtual void DILIGENT_CALL_TYPE Resize(size_t NewSize) override;
+
+    /// Returns the size of the external data
+    virtual size_t DILIGENT_CALL_TYPE GetSize() const override;
+
+    /// Returns the pointer to the external data
+    virtual void* DILIGENT_CALL_TYPE GetDataPtr() override;
+
+    /// Returns const pointer to the external data
+    virtual const void* DILIGENT_CALL_TYPE GetConstDataPtr() const override;
+
+private:
+    template <typename AllocatorType, typename ObjectType>
+    friend class MakeNewRCObj;
+
+    ExternalDataBlob(IReferenceCounters* pRefCounters, void* pData, size_t Size, ReleaseCallbackType&& ReleaseCallback);
+
+private:
+    void* const         m_pData;
+    const size_t        m_Size;
+    ReleaseCallbackType m_ReleaseCallback;
+};
+
+} // namespace Diligent
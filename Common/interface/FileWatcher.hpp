@@ -0,0 +1,120 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::FileWatcher class
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Watches directories and reports the files that were changed.
+
+/// On Linux and Android, the watcher uses inotify and on Win32 - ReadDirectoryChangesW.
+/// On other platforms, or if native notifications are not available, the directories
+/// are periodically scanned and file modification times and sizes are compared.
+///
+/// The watcher does not create any threads: the changes are collected when GetChangedFiles()
+/// is called, which never blocks, so that it can be called once per frame. A typical use
+/// is to call IRenderStateCache::Reload() when any shader source file has changed.
+///
+/// \remarks    All methods are thread-safe.
+class FileWatcher
+{
+public:
+    /// File change notification backend.
+    enum BACKEND : Uint8
+    {
+        /// Directories are periodically scanned.
+        BACKEND_POLLING = 0,
+
+        /// Changes are reported by the Linux inotify.
+        BACKEND_INOTIFY,
+
+        /// Changes are reported by the Win32 ReadDirectoryChangesW.
+        BACKEND_READ_DIRECTORY_CHANGES
+    };
+
+    struct CreateInfo
+    {
+        /// The minimum interval, in milliseconds, between two scans of the watched directories.
+        /// Only used by the polling backend.
+        Uint32 PollingInterval = 500;
+
+        /// If true, directories are always scanned, even if native notifications are available.
+        bool ForcePolling = false;
+    };
+
+    class NativeBackend;
+
+    explicit FileWatcher(const CreateInfo& CI) noexcept(false);
+
+    ~FileWatcher();
+
+    // clang-format off
+    FileWatcher           (const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+    FileWatcher           (FileWatcher&&)      = delete;
+    FileWatcher& operator=(FileWatcher&&)      = delete;
+    // clang-format on
+
+    /// Starts watching the directory.
+
+    /// \param [in] Path      - Path to the directory.
+    /// \param [in] Recursive - Whether to watch all subdirectories, including the ones that are created later.
+    ///
+    /// \return     true if the directory is being watched, and false otherwise.
+    bool AddDirectory(const Char* Path, bool Recursive = true);
+
+    /// Returns the paths of the files that were created, modified, removed or renamed
+    /// since the previous call.
+
+    /// \remarks    Every path is reported once and is formed as the path of the watched directory
+    ///             followed by the path of the file relative to it.
+    ///             Renamed files are reported with both the old and the new name.
+    std::vector<std::string> GetChangedFiles();
+
+    BACKEND GetBackend() const { return m_Backend; }
+
+private:
+    std::mutex m_Mtx;
+
+    std::unique_ptr<NativeBackend> m_pBackend;
+
+    BACKEND m_Backend = BACKEND_POLLING;
+};
+
+} // namespace Diligent
@@ -217,6 +217,62 @@ DstType FilterTexture2DBilinear(Uint32         Width,
     return lerp(lerp(S00, S10, UFilterInfo.w), lerp(S01, S11, UFilterInfo.w), VFilterInfo.w);
 }
 
+/// Samples a row of 2D texture values that share the same v coordinate using bilinear filter.
+///
+/// \tparam SrcType           - Source pixel type.
+/// \tparam DstType           - Destination type.
+/// \tparam AddressModeU      - U coordinate address mode.
+/// \tparam AddressModeV      - V coordinate address mode.
+/// \tparam IsNormalizedCoord - Whether sample coordinates are normalized.
+///
+/// \param [in]  Width        - Texture width.
+/// \param [in]  Height       - Texture height.
+/// \param [in]  pData        - Pointer to the texture data.
+/// \param [in]  Stride       - Data stride, in pixels.
+/// \param [in]  pU           - Array of NumSamples u coordinates.
+/// \param [in]  NumSamples   - The number of samples.
+/// \param [in]  v            - Sample v coordinate shared by all samples.
+/// \param [out] pDst         - Destination array of NumSamples filtered samples.
+///
+/// \remarks    The results are identical to calling FilterTexture2DBilinear for every sample,
+///             but the vertical filter information and the row pointers are computed once,
+///             which lets the compiler vectorize the inner loop.
+template <typename SrcType,
+          typename DstType,
+          TEXTURE_ADDRESS_MODE AddressModeU,
+          TEXTURE_ADDRESS_MODE AddressModeV,
+          bool                 IsNormalizedCoord>
+void FilterTexture2DBilinearRow(Uint32         Width,
+                                Uint32         Height,
+                                const SrcType* pData,
+                                size_t         Stride,
+                                const float*   pU,
+                                size_t         NumSamples,
+                                float          v,
+                                DstType*       pDst)
+{
+    auto VFilterInfo = GetLinearTexFilterSampleInfo<AddressModeV, IsNormalizedCoord>(Height, v);
+#ifdef DILIGENT_DEBUG
+    _DbgVerifyFilterInfo<AddressModeV>(VFilterInfo, Height, "vertical", v);
+#endif
+
+    const SrcType* pRow0 = pData + VFilterInfo.i0 * Stride;
+    const SrcType* pRow1 = pData + VFilterInfo.i1 * Stride;
+    for (size_t i = 0; i < NumSamples; ++i)
+    {
+        auto UFilterInfo = GetLinearTexFilterSampleInfo<AddressModeU, IsNormalizedCoord>(Width, pU[i]);
+#ifdef DILIGENT_DEBUG
+        _DbgVerifyFilterInfo<AddressModeU>(UFilterInfo, Width, "horizontal", pU[i]);
+#endif
+
+        auto S00 = static_cast<DstType>(pRow0[UFilterInfo.i0]);
+        auto S10 = static_cast<DstType>(pRow0[UFilterInfo.i1]);
+        auto S01 = static_cast<DstType>(pRow1[UFilterInfo.i0]);
+        auto S11 = static_cast<DstType>(pRow1[UFilterInfo.i1]);
+        pDst[i]  = lerp(lerp(S00, S10, UFilterInfo.w), lerp(S01, S11, UFilterInfo.w), VFilterInfo.w);
+    }
+}
+
 /// Specialization of FilterTexture2DBilinear function that uses CLAMP texture address mode
 /// and takes normalized texture coordinates.
 template <typename SrcType, typename DstType>
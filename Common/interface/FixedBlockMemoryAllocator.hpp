@@ -30,9 +30,9 @@
 /// \file
 /// Declaration of Diligent::FixedBlockMemoryAllocator class
 
-#include <unordered_map>
+#include <array>
+#include <atomic>
 #include <mutex>
-#include <unordered_set>
 #include <vector>
 #include <cstring>
 #include <memory>
@@ -56,9 +56,26 @@ inline void FillWithDebugPattern(void* ptr, Uint8 Pattern, size_t NumBytes)
 class FixedBlockMemoryAllocator final : public IMemoryAllocator
 {
 public:
-    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage);
+    /// \param [in] RawMemoryAllocator - Allocator that is used to allocate memory pages.
+    /// \param [in] BlockSize          - Size of a single block.
+    /// \param [in] NumBlocksInPage    - Number of blocks in one memory page.
+    /// \param [in] EnableThreadCache  - Whether to enable thread caching mode, see remarks.
+    ///
+    /// \remarks   In thread caching mode, every thread keeps released blocks in thread-local
+    ///            magazines and exchanges full and empty magazines with a lock-free depot,
+    ///            so that most Allocate() and Free() calls do not lock the allocator mutex.
+    ///            The price is that up to 2 * MagazineCapacity free blocks may be held by each
+    ///            thread that uses the allocator. Up to MaxThreadCaches threads get a cache;
+    ///            other threads use the mutex-protected path.
+    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage, bool EnableThreadCache = false);
     ~FixedBlockMemoryAllocator();
 
+    /// The number of blocks in a thread cache magazine.
+    static constexpr Uint32 MagazineCapacity = 32;
+
+    /// The maximum number of threads that can have a cache in thread caching mode.
+    static constexpr Uint32 MaxThreadCaches = 64;
+
     /// Allocates block of memory
     virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final;
 
@@ -75,6 +92,53 @@ private:
 
     void CreateNewPage();
 
+    void* AllocateFromPage();
+    void  FreeToPage(void* Ptr);
+    bool  FindPage(const void* Ptr, size_t& PageId) const;
+
+    // Magazine is a fixed-capacity stack of free blocks that moves between thread caches
+    // and the depot, see "Magazines and Vmem: Extending the Slab Allocator to Many CPUs and
+    // Arbitrary Resources" by Jeff Bonwick and Jonathan Adams.
+    static constexpr Uint32 InvalidMagazineIdx = ~Uint32{0};
+
+    struct Magazine
+    {
+        // Index of the next magazine in the depot list
+        std::atomic<Uint32> NextIdx{InvalidMagazineIdx};
+
+        Uint32 NumBlocks = 0;
+        void*  Blocks[MagazineCapacity];
+    };
+
+    // Lock-free list of magazines. The head packs the modification tag in the upper
+    // 32 bits and the index of the first magazine in the lower 32 bits; the tag
+    // prevents the ABA problem when the same magazine is popped and pushed back
+    // while another thread is in the middle of an update.
+    class MagazineList
+    {
+    public:
+        void   Push(FixedBlockMemoryAllocator& Owner, Uint32 MagIdx);
+        Uint32 Pop(FixedBlockMemoryAllocator& Owner);
+
+    private:
+        std::atomic<Uint64> m_Head{InvalidMagazineIdx};
+    };
+
+    struct ThreadCache
+    {
+        Uint32 LoadedIdx   = InvalidMagazineIdx;
+        Uint32 PreviousIdx = InvalidMagazineIdx;
+
+        // Keep caches of different threads in different cache lines
+        Uint8 Padding[64 - sizeof(Uint32) * 2];
+    };
+
+    Magazine& GetMagazine(Uint32 MagIdx) const;
+    Uint32    GetEmptyMagazine();
+
+    void* AllocateCached(ThreadCache& Cache);
+    void  FreeCached(ThreadCache& Cache, void* Ptr);
+
     // Memory page class is based on the fixed-size memory pool described in "Fast Efficient Fixed-Size Memory Pool"
     // by Ben Kenwright
     class MemoryPage
@@ -207,7 +271,13 @@ private:
         }
 
         bool HasSpace() const { return m_NumFreeBlocks > 0; }
-        bool HasAllocations() const { return m_NumFreeBlocks < m_NumInitializedBlocks; }
+        bool HasAllocations() const { return GetNumAllocatedBlocks() > 0; }
+
+        Uint32 GetNumAllocatedBlocks() const
+        {
+            VERIFY_EXPR(m_pOwnerAllocator != nullptr);
+            return m_pOwnerAllocator->m_NumBlocksInPage - m_NumFreeBlocks;
+        }
 
     private:
         MemoryPage(const MemoryPage&) = delete;
@@ -221,17 +291,35 @@ private:
         FixedBlockMemoryAllocator* m_pOwnerAllocator      = nullptr;
     };
 
-    std::vector<MemoryPage, STDAllocatorRawMem<MemoryPage>>                                          m_PagePool;
-    std::unordered_set<size_t, std::hash<size_t>, std::equal_to<size_t>, STDAllocatorRawMem<size_t>> m_AvailablePages;
+    std::vector<MemoryPage, STDAllocatorRawMem<MemoryPage>> m_PagePool;
 
-    using AddrToPageIdMapElem = std::pair<void* const, size_t>;
-    std::unordered_map<void*, size_t, std::hash<void*>, std::equal_to<void*>, STDAllocatorRawMem<AddrToPageIdMapElem>> m_AddrToPageId;
+    // Indices of the pages that have free blocks. New blocks are always allocated from the
+    // last page in the list, and a page is added back when it stops being full.
+    std::vector<size_t, STDAllocatorRawMem<size_t>> m_AvailablePages;
+
+    // Page start addresses sorted in ascending order with the page indices. The page that owns
+    // a block is found with a binary search rather than by tracking every block in a hash map.
+    using PageAddrElem = std::pair<const Uint8*, size_t>;
+    std::vector<PageAddrElem, STDAllocatorRawMem<PageAddrElem>> m_SortedPageAddrs;
 
     std::mutex m_Mutex;
 
     IMemoryAllocator& m_RawMemoryAllocator;
     const size_t      m_BlockSize;
     const Uint32      m_NumBlocksInPage;
+
+    // Thread caching mode data
+
+    // Magazines are never moved or released until the allocator is destroyed. Segment i
+    // holds 2^i magazines, so that magazine indices are stable and can be used by the
+    // lock-free lists.
+    std::array<std::atomic<Magazine*>, 32> m_MagazineSegments = {};
+    std::atomic<Uint32>                    m_NumMagazines{0};
+
+    MagazineList m_FullMagazines;
+    MagazineList m_EmptyMagazines;
+
+    std::vector<ThreadCache, STDAllocatorRawMem<ThreadCache>> m_ThreadCaches;
 };
 
 IMemoryAllocator& GetRawAllocator();
@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <cstring>
@@ -48,6 +49,26 @@
 namespace Diligent
 {
 
+namespace HashUtilsInternal
+{
+
+// Values that are hashed by their bits must be normalized so that values that compare equal
+// have equal hashes. Negative zero compares equal to positive zero and is replaced with it.
+// NaNs never compare equal, so they don't need to be normalized.
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, T>::type NormalizeHashedValue(T Val) noexcept
+{
+    return Val == T{0} ? T{0} : Val;
+}
+
+template <typename T>
+typename std::enable_if<!std::is_floating_point<T>::value, T>::type NormalizeHashedValue(T Val) noexcept
+{
+    return Val;
+}
+
+} // namespace HashUtilsInternal
+
 #if (defined(__clang__) || defined(__GNUC__))
 
 // GCC's and Clang's implementation of std::hash for integral types is IDENTITY,
@@ -86,16 +107,18 @@ constexpr uint64_t twang_mix64(uint64_t key) noexcept
 template <typename T>
 typename std::enable_if<(std::is_fundamental<T>::value || std::is_enum<T>::value) && sizeof(T) == 8, size_t>::type ComputeHash(const T& Val) noexcept
 {
-    uint64_t Val64 = 0;
-    std::memcpy(&Val64, &Val, sizeof(Val));
+    const T  NormVal = HashUtilsInternal::NormalizeHashedValue(Val);
+    uint64_t Val64   = 0;
+    std::memcpy(&Val64, &NormVal, sizeof(NormVal));
     return twang_mix64(Val64);
 }
 
 template <typename T>
 typename std::enable_if<(std::is_fundamental<T>::value || std::is_enum<T>::value) && sizeof(T) <= 4, size_t>::type ComputeHash(const T& Val) noexcept
 {
-    uint32_t Val32 = 0;
-    std::memcpy(&Val32, &Val, sizeof(Val));
+    const T  NormVal = HashUtilsInternal::NormalizeHashedValue(Val);
+    uint32_t Val32   = 0;
+    std::memcpy(&Val32, &NormVal, sizeof(NormVal));
     return jenkins_rev_mix32(Val32);
 }
 
@@ -115,11 +138,52 @@ size_t ComputeHash(const T& Val) noexcept
 
 #endif
 
-// http://www.boost.org/doc/libs/1_35_0/doc/html/hash/combine.html
+namespace HashUtilsInternal
+{
+
+// Returns the value that is combined with the seed by HashCombine.
+// Fundamental types are used as is since the combiner mixes the bits anyway.
+template <typename T>
+typename std::enable_if<(std::is_fundamental<T>::value || std::is_enum<T>::value) && sizeof(T) <= 8, uint64_t>::type GetCombinedValue(const T& Val) noexcept
+{
+    const T  NormVal = NormalizeHashedValue(Val);
+    uint64_t Val64   = 0;
+    std::memcpy(&Val64, &NormVal, sizeof(NormVal));
+    return Val64;
+}
+
+template <typename T>
+typename std::enable_if<!((std::is_fundamental<T>::value || std::is_enum<T>::value) && sizeof(T) <= 8), uint64_t>::type GetCombinedValue(const T& Val) noexcept
+{
+    return static_cast<uint64_t>(ComputeHash(Val));
+}
+
+// xxHash64 primes, see https://github.com/Cyan4973/xxHash
+constexpr uint64_t XXH_PRIME64_1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t XXH_PRIME64_5 = 0x27D4EB2F165667C5ull;
+
+// xxHash64 accumulator round. The prime offset makes sure that
+// combining zero values still changes the seed.
+constexpr uint64_t XXH64Round(uint64_t Acc, uint64_t Input) noexcept
+{
+    Acc += XXH_PRIME64_5 + Input * XXH_PRIME64_2;
+    Acc = (Acc << 31) | (Acc >> 33);
+    return Acc * XXH_PRIME64_1;
+}
+
+} // namespace HashUtilsInternal
+
 template <typename T>
 void HashCombine(std::size_t& Seed, const T& Val) noexcept
 {
+#if SIZE_MAX == UINT64_MAX
+    // One xxHash64 round is cheaper than mixing the value and combining it with the seed
+    Seed = static_cast<std::size_t>(HashUtilsInternal::XXH64Round(Seed, HashUtilsInternal::GetCombinedValue(Val)));
+#else
+    // http://www.boost.org/doc/libs/1_35_0/doc/html/hash/combine.html
     Seed ^= ComputeHash(Val) + 0x9e3779b9 + (Seed << 6) + (Seed >> 2);
+#endif
 }
 
 template <typename FirstArgType, typename... RestArgsType>
@@ -965,6 +1029,60 @@ struct HashCombiner<HasherType, InputLayoutDesc> : HashCombinerBase<HasherType>
 };
 
 
+template <typename HasherType>
+void HashShaderBytecode(HasherType& Hasher, IShader* pShader)
+{
+    if (pShader == nullptr)
+        return;
+
+    const void* pBytecode = nullptr;
+    Uint64      Size      = 0;
+    pShader->GetBytecode(&pBytecode, Size);
+    VERIFY_EXPR(pBytecode != nullptr && Size != 0);
+    Hasher.UpdateRaw(pBytecode, static_cast<size_t>(Size));
+}
+
+namespace HashUtilsInternal
+{
+
+template <typename HasherType, typename ObjectType>
+auto HashDeviceObject(HasherType& Hasher, ObjectType* pObject, int) -> decltype(Hasher.UpdateObject(pObject))
+{
+    return Hasher.UpdateObject(pObject);
+}
+
+template <typename HasherType>
+void HashDeviceObject(HasherType& Hasher, IShader* pShader, long)
+{
+    HashShaderBytecode(Hasher, pShader);
+}
+
+template <typename HasherType>
+void HashDeviceObject(HasherType& Hasher, const IPipelineResourceSignature* pSignature, long)
+{
+    Hasher(pSignature->GetDesc());
+}
+
+template <typename HasherType>
+void HashDeviceObject(HasherType& Hasher, const IRenderPass* pRenderPass, long)
+{
+    Hasher(pRenderPass->GetDesc());
+}
+
+} // namespace HashUtilsInternal
+
+/// Hashes a shader, a resource signature or a render pass referenced by a create info.
+
+/// If the hasher defines UpdateObject() for the object type, it is used to hash the object,
+/// for example by combining a precomputed digest. Otherwise, the shader bytecode or the object
+/// description is hashed. Null objects are skipped.
+template <typename HasherType, typename ObjectType>
+void HashDeviceObject(HasherType& Hasher, ObjectType* pObject)
+{
+    if (pObject != nullptr)
+        HashUtilsInternal::HashDeviceObject(Hasher, pObject, 0);
+}
+
 template <typename HasherType>
 struct HashCombiner<HasherType, GraphicsPipelineDesc> : HashCombinerBase<HasherType>
 {
@@ -987,6 +1105,7 @@ struct HashCombiner<HasherType, GraphicsPipelineDesc> : HashCombinerBase<HasherT
             Desc.InputLayout,
             Desc.PrimitiveTopology,
             Desc.NumViewports,
+            Desc.DynamicStateFlags,
             ((static_cast<uint32_t>(Desc.NumViewports) << 0u) |
              (static_cast<uint32_t>(Desc.NumRenderTargets) << 8u) |
              (static_cast<uint32_t>(Desc.SubpassIndex) << 16u) |
@@ -999,8 +1118,7 @@ struct HashCombiner<HasherType, GraphicsPipelineDesc> : HashCombinerBase<HasherT
                        Desc.SmplDesc,
                        Desc.NodeMask);
 
-        if (Desc.pRenderPass != nullptr)
-            this->m_Hasher(Desc.pRenderPass->GetDesc());
+        HashDeviceObject(this->m_Hasher, Desc.pRenderPass);
     }
 };
 
@@ -1142,10 +1260,7 @@ struct HashCombiner<HasherType, PipelineStateCreateInfo> : HashCombinerBase<Hash
         {
             for (size_t i = 0; i < CI.ResourceSignaturesCount; ++i)
             {
-                if (const auto* pSign = CI.ppResourceSignatures[i])
-                {
-                    this->m_Hasher(pSign->GetDesc());
-                }
+                HashDeviceObject(this->m_Hasher, CI.ppResourceSignatures[i]);
             }
         }
         else
@@ -1155,19 +1270,6 @@ struct HashCombiner<HasherType, PipelineStateCreateInfo> : HashCombinerBase<Hash
     }
 };
 
-template <typename HasherType>
-void HashShaderBytecode(HasherType& Hasher, IShader* pShader)
-{
-    if (pShader == nullptr)
-        return;
-
-    const void* pBytecode = nullptr;
-    Uint64      Size      = 0;
-    pShader->GetBytecode(&pBytecode, Size);
-    VERIFY_EXPR(pBytecode != nullptr && Size != 0);
-    Hasher.UpdateRaw(pBytecode, static_cast<size_t>(Size));
-}
-
 template <typename HasherType>
 struct HashCombiner<HasherType, GraphicsPipelineStateCreateInfo> : HashCombinerBase<HasherType>
 {
@@ -1180,13 +1282,13 @@ struct HashCombiner<HasherType, GraphicsPipelineStateCreateInfo> : HashCombinerB
         this->m_Hasher(
             static_cast<const PipelineStateCreateInfo&>(CI),
             CI.GraphicsPipeline);
-        HashShaderBytecode(this->m_Hasher, CI.pVS);
-        HashShaderBytecode(this->m_Hasher, CI.pPS);
-        HashShaderBytecode(this->m_Hasher, CI.pDS);
-        HashShaderBytecode(this->m_Hasher, CI.pHS);
-        HashShaderBytecode(this->m_Hasher, CI.pGS);
-        HashShaderBytecode(this->m_Hasher, CI.pAS);
-        HashShaderBytecode(this->m_Hasher, CI.pMS);
+        HashDeviceObject(this->m_Hasher, CI.pVS);
+        HashDeviceObject(this->m_Hasher, CI.pPS);
+        HashDeviceObject(this->m_Hasher, CI.pDS);
+        HashDeviceObject(this->m_Hasher, CI.pHS);
+        HashDeviceObject(this->m_Hasher, CI.pGS);
+        HashDeviceObject(this->m_Hasher, CI.pAS);
+        HashDeviceObject(this->m_Hasher, CI.pMS);
     }
 };
 
@@ -1200,7 +1302,7 @@ struct HashCombiner<HasherType, ComputePipelineStateCreateInfo> : HashCombinerBa
     void operator()(const ComputePipelineStateCreateInfo& CI) const
     {
         this->m_Hasher(static_cast<const PipelineStateCreateInfo&>(CI));
-        HashShaderBytecode(this->m_Hasher, CI.pCS);
+        HashDeviceObject(this->m_Hasher, CI.pCS);
     }
 };
 
@@ -1227,24 +1329,24 @@ struct HashCombiner<HasherType, RayTracingPipelineStateCreateInfo> : HashCombine
         {
             const auto& GeneralShader = CI.pGeneralShaders[i];
             this->m_Hasher(GeneralShader.Name);
-            HashShaderBytecode(this->m_Hasher, GeneralShader.pShader);
+            HashDeviceObject(this->m_Hasher, GeneralShader.pShader);
         }
 
         for (size_t i = 0; i < CI.TriangleHitShaderCount; ++i)
         {
             const auto& TriHitShader = CI.pTriangleHitShaders[i];
             this->m_Hasher(TriHitShader.Name);
-            HashShaderBytecode(this->m_Hasher, TriHitShader.pAnyHitShader);
-            HashShaderBytecode(this->m_Hasher, TriHitShader.pClosestHitShader);
+            HashDeviceObject(this->m_Hasher, TriHitShader.pAnyHitShader);
+            HashDeviceObject(this->m_Hasher, TriHitShader.pClosestHitShader);
         }
 
         for (size_t i = 0; i < CI.ProceduralHitShaderCount; ++i)
         {
             const auto& ProcHitShader = CI.pProceduralHitShaders[i];
             this->m_Hasher(ProcHitShader.Name);
-            HashShaderBytecode(this->m_Hasher, ProcHitShader.pAnyHitShader);
-            HashShaderBytecode(this->m_Hasher, ProcHitShader.pClosestHitShader);
-            HashShaderBytecode(this->m_Hasher, ProcHitShader.pIntersectionShader);
+            HashDeviceObject(this->m_Hasher, ProcHitShader.pAnyHitShader);
+            HashDeviceObject(this->m_Hasher, ProcHitShader.pClosestHitShader);
+            HashDeviceObject(this->m_Hasher, ProcHitShader.pIntersectionShader);
         }
     }
 };
@@ -1280,7 +1382,7 @@ struct HashCombiner<HasherType, TilePipelineStateCreateInfo> : HashCombinerBase<
     void operator()(const TilePipelineStateCreateInfo& CI) const
     {
         this->m_Hasher(static_cast<const PipelineStateCreateInfo&>(CI), CI.TilePipeline);
-        HashShaderBytecode(this->m_Hasher, CI.pTS);
+        HashDeviceObject(this->m_Hasher, CI.pTS);
     }
 };
 
@@ -0,0 +1,132 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::HashedName class
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Handle to a string interned in the global thread-safe name table.
+
+/// All handles to equal strings refer to the same table entry, so comparing two handles
+/// is a pointer comparison and the string hash is computed only once, when the string
+/// is interned. Interned strings are never released and remain valid until the
+/// application exits, so the table is intended for names that are reused many times
+/// (resource, variable, pipeline names), not for arbitrary strings.
+///
+/// Looking up and interning strings is lock-free.
+class HashedName
+{
+public:
+    HashedName() noexcept {}
+
+    /// Interns the string, if it has not been interned yet, and returns its handle.
+    explicit HashedName(const Char* Str);
+
+    explicit HashedName(const String& Str) :
+        HashedName{Str.c_str()}
+    {}
+
+    /// Returns the handle of a previously interned string, or a null handle
+    /// if the string has never been interned. Never adds new strings to the table.
+    static HashedName Find(const Char* Str);
+
+    const Char* GetStr() const noexcept
+    {
+        return m_pEntry != nullptr ? m_pEntry->Str : nullptr;
+    }
+
+    size_t GetHash() const noexcept
+    {
+        return m_pEntry != nullptr ? m_pEntry->Hash : 0;
+    }
+
+    size_t GetLength() const noexcept
+    {
+        return m_pEntry != nullptr ? m_pEntry->Length : 0;
+    }
+
+    bool operator==(const HashedName& RHS) const noexcept
+    {
+        return m_pEntry == RHS.m_pEntry;
+    }
+
+    bool operator!=(const HashedName& RHS) const noexcept
+    {
+        return m_pEntry != RHS.m_pEntry;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return m_pEntry != nullptr;
+    }
+
+    struct Hasher
+    {
+        size_t operator()(const HashedName& Name) const noexcept
+        {
+            return Name.GetHash();
+        }
+    };
+
+    /// Table entry. Entries are immutable once they are published in the table.
+    struct Entry
+    {
+        const Entry* pNext;
+        size_t       Hash;
+        size_t       Length;
+        Char         Str[1];
+    };
+
+private:
+    explicit HashedName(const Entry* pEntry) noexcept :
+        m_pEntry{pEntry}
+    {}
+
+    const Entry* m_pEntry = nullptr;
+};
+
+} // namespace Diligent
+
+namespace std
+{
+
+template <>
+struct hash<Diligent::HashedName>
+{
+    size_t operator()(const Diligent::HashedName& Name) const noexcept
+    {
+        return Name.GetHash();
+    }
+};
+
+} // namespace std
@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "Align.hpp"
+
+namespace Threading
+{
+
+/// Bounded lock-free multi-producer multi-consumer queue.
+
+/// The queue is a ring of cells, each tagged with a sequence number that tells whether
+/// the cell is ready to be written or read at the current position.
+/// See http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+///
+/// \tparam T - Element type. Must be default-constructible and move-assignable.
+template <typename T>
+class LockFreeQueue
+{
+public:
+    /// \param [in] Capacity - Queue capacity. Must be a power of two.
+    explicit LockFreeQueue(size_t Capacity) :
+        m_Cells{new Cell[Capacity]},
+        m_Mask{Capacity - 1}
+    {
+        VERIFY(Capacity >= 2 && Diligent::IsPowerOfTwo(Capacity), "Capacity (", Capacity, ") must be a power of two");
+        for (size_t i = 0; i < Capacity; ++i)
+            m_Cells[i].Seq.store(i, std::memory_order_relaxed);
+    }
+
+    // clang-format off
+    LockFreeQueue             (const LockFreeQueue&)  = delete;
+    LockFreeQueue& operator = (const LockFreeQueue&)  = delete;
+    LockFreeQueue             (      LockFreeQueue&&) = delete;
+    LockFreeQueue& operator = (      LockFreeQueue&&) = delete;
+    // clang-format on
+
+    /// Adds an element to the queue. Returns false if the queue is full,
+    /// in which case Value is not moved from.
+    bool TryPush(T&& Value) noexcept
+    {
+        Cell* pCell = nullptr;
+        auto  Pos   = m_EnqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            pCell          = &m_Cells[Pos & m_Mask];
+            const auto Seq = pCell->Seq.load(std::memory_order_acquire);
+            const auto Dif = static_cast<std::ptrdiff_t>(Seq) - static_cast<std::ptrdiff_t>(Pos);
+            if (Dif == 0)
+            {
+                // The cell is free - try to claim it
+                if (m_EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (Dif < 0)
+            {
+                // The cell still holds the element pushed one lap ago
+                return false;
+            }
+            else
+            {
+                // Another thread has claimed the cell
+                Pos = m_EnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        pCell->Value = std::move(Value);
+        pCell->Seq.store(Pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Removes an element from the queue. Returns false if the queue is empty.
+    bool TryPop(T& Value) noexcept
+    {
+        Cell* pCell = nullptr;
+        auto  Pos   = m_DequeuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            pCell          = &m_Cells[Pos & m_Mask];
+            const auto Seq = pCell->Seq.load(std::memory_order_acquire);
+            const auto Dif = static_cast<std::ptrdiff_t>(Seq) - static_cast<std::ptrdiff_t>(Pos + 1);
+            if (Dif == 0)
+            {
+                if (m_DequeuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (Dif < 0)
+            {
+                // The cell has not been written yet
+                return false;
+            }
+            else
+            {
+                Pos = m_DequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        Value = std::move(pCell->Value);
+        pCell->Seq.store(Pos + m_Mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t GetCapacity() const noexcept
+    {
+        return m_Mask + 1;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> Seq{0};
+        T                   Value{};
+    };
+
+    std::unique_ptr<Cell[]> m_Cells;
+    const size_t            m_Mask;
+
+    // Keep producer and consumer positions in separate cache lines
+    std::atomic<size_t> m_EnqueuePos{0};
+    char                m_Padding[64 - sizeof(std::atomic<size_t>)] = {};
+    std::atomic<size_t> m_DequeuePos{0};
+};
+
+} // namespace Threading
@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of the IDataBlob interface backed by a memory-mapped file
+
+#include <memory>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/DataBlob.h"
+#include "../../Platforms/Basic/interface/MemoryMappedFile.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "ObjectBase.hpp"
+
+namespace Diligent
+{
+
+/// Data blob that references the contents of a memory-mapped file.
+
+/// Only the pages that are actually accessed are loaded into memory. The blob can't be resized.
+/// By default, the file is mapped as copy-on-write. Read-only blobs share the pages of the
+/// OS file cache with other processes, and their data must not be written to,
+/// see MemoryMappedFile for details.
+class MemoryMappedFileDataBlob final : public ObjectBase<IDataBlob>
+{
+public:
+    using TBase = ObjectBase<IDataBlob>;
+
+    /// Maps the file at the given path. Returns null if the file can't be mapped.
+    static RefCntAutoPtr<MemoryMappedFileDataBlob> Create(const Char* FilePath, bool ReadOnly = false);
+
+    ~MemoryMappedFileDataBlob() override;
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DataBlob, TBase)
+
+    /// Memory-mapped data blobs can't be resized.
+    virtual void DILIGENT_CALL_TYPE Resize(size_t NewSize) override;
+
+    /// Returns the size of the mapped file
+    virtual size_t DILIGENT_CALL_TYPE GetSize() const override;
+
+    /// Returns the pointer to the mapped file data.
+    /// If the blob is read-only, the data must not be written to through this pointer.
+    virtual void* DILIGENT_CALL_TYPE GetDataPtr() override;
+
+    /// Returns const pointer to the mapped file data
+    virtual const void* DILIGENT_CALL_TYPE GetConstDataPtr() const override;
+
+    bool IsReadOnly() const { return m_pFile->IsReadOnly(); }
+
+private:
+    template <typename AllocatorType, typename ObjectType>
+    friend class MakeNewRCObj;
+
+    MemoryMappedFileDataBlob(IReferenceCounters* pRefCounters, std::unique_ptr<MemoryMappedFile>&& pFile);
+
+private:
+    const std::unique_ptr<MemoryMappedFile> m_pFile;
+};
+
+} // namespace Diligent
@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "AdvancedMath.hpp"
+#include "Align.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+/// Runs GetBoxVisibilityBatch() for chunks of boxes in parallel using the thread pool.
+
+/// \param [in]  pThreadPool     - Thread pool to use. If null, all boxes are processed by the calling thread.
+/// \param [in]  Frustum         - View frustum (ViewFrustum or ViewFrustumExt).
+/// \param [in]  Boxes           - Structure-of-arrays bounding box coordinates.
+/// \param [in]  NumBoxes        - The number of boxes to test.
+/// \param [out] pVisibilityMask - Visibility bitmask, see GetBoxVisibilityBatch().
+/// \param [in]  PlaneFlags      - Frustum planes to test the boxes against.
+/// \param [in]  BoxesPerTask    - The number of boxes processed by a single task.
+///                                The value is rounded up to a multiple of 32 so that
+///                                tasks never write to the same mask element.
+///
+/// \remarks    The calling thread processes the last chunk and then waits for the remaining
+///             tasks to finish, so the function must not be called from a thread pool thread
+///             that the pool may need to run these tasks.
+template <typename FrustumType>
+void GetBoxVisibilityBatchParallel(IThreadPool*        pThreadPool,
+                                   const FrustumType&  Frustum,
+                                   const BoundBoxSoA&  Boxes,
+                                   size_t              NumBoxes,
+                                   Uint32*             pVisibilityMask,
+                                   FRUSTUM_PLANE_FLAGS PlaneFlags   = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM,
+                                   size_t              BoxesPerTask = 8192)
+{
+    BoxesPerTask = (std::max)(AlignUp(BoxesPerTask, size_t{32}), size_t{32});
+    if (pThreadPool == nullptr || NumBoxes <= BoxesPerTask)
+    {
+        GetBoxVisibilityBatch(Frustum, Boxes, NumBoxes, pVisibilityMask, PlaneFlags);
+        return;
+    }
+
+    const size_t NumChunks = (NumBoxes + BoxesPerTask - 1) / BoxesPerTask;
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+    Tasks.reserve(NumChunks - 1);
+    for (size_t Chunk = 0; Chunk < NumChunks - 1; ++Chunk)
+    {
+        const size_t First = Chunk * BoxesPerTask;
+        Tasks.emplace_back(EnqueueAsyncWork(pThreadPool,
+                                            [&Frustum, &Boxes, pVisibilityMask, PlaneFlags, First, BoxesPerTask](Uint32 ThreadId) {
+                                                GetBoxVisibilityBatch(Frustum, Boxes.Offset(First), BoxesPerTask, pVisibilityMask + First / 32, PlaneFlags);
+                                            }));
+    }
+
+    const size_t LastFirst = (NumChunks - 1) * BoxesPerTask;
+    GetBoxVisibilityBatch(Frustum, Boxes.Offset(LastFirst), NumBoxes - LastFirst, pVisibilityMask + LastFirst / 32, PlaneFlags);
+
+    for (auto& pTask : Tasks)
+        pTask->WaitForCompletion();
+}
+
+} // namespace Diligent
@@ -31,12 +31,19 @@
 
 #include <cstring>
 #include <sstream>
+#include <string>
+#include <type_traits>
 
 #include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/FlagEnum.h"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../Platforms/interface/Intrinsics.hpp"
 #include "StringTools.h"
 
+#if defined(_MSC_VER) && (DILIGENT_SSE2_ENABLED || DILIGENT_NEON_ENABLED)
+#    include <intrin.h>
+#endif
+
 namespace Diligent
 {
 
@@ -68,6 +75,192 @@ inline bool IsStatementSeparator(Char Symbol) noexcept
 }
 
 
+namespace Detail
+{
+
+// Character classes used by the scanning functions. Each class tests a single
+// character and, when SIMD is available, 16 characters at a time.
+
+#if DILIGENT_SSE2_ENABLED
+using CharVector = __m128i;
+
+inline CharVector LoadChars(const char* Pos) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(Pos)); }
+inline CharVector SplatChar(char c) { return _mm_set1_epi8(c); }
+inline CharVector CmpEq(CharVector a, CharVector b) { return _mm_cmpeq_epi8(a, b); }
+inline CharVector Or(CharVector a, CharVector b) { return _mm_or_si128(a, b); }
+// Unsigned a - Base < Count
+inline CharVector InRange(CharVector a, char Base, char Count)
+{
+    const auto Offset = _mm_sub_epi8(a, _mm_set1_epi8(Base));
+    return _mm_cmpeq_epi8(_mm_min_epu8(Offset, _mm_set1_epi8(static_cast<char>(Count - 1))), Offset);
+}
+#elif DILIGENT_NEON_ENABLED
+using CharVector = uint8x16_t;
+
+inline CharVector LoadChars(const char* Pos) { return vld1q_u8(reinterpret_cast<const uint8_t*>(Pos)); }
+inline CharVector SplatChar(char c) { return vdupq_n_u8(static_cast<uint8_t>(c)); }
+inline CharVector CmpEq(CharVector a, CharVector b) { return vceqq_u8(a, b); }
+inline CharVector Or(CharVector a, CharVector b) { return vorrq_u8(a, b); }
+// Unsigned a - Base < Count
+inline CharVector InRange(CharVector a, char Base, char Count)
+{
+    return vcltq_u8(vsubq_u8(a, vdupq_n_u8(static_cast<uint8_t>(Base))), vdupq_n_u8(static_cast<uint8_t>(Count)));
+}
+#endif
+
+// New line or null character
+struct NewLineOrNullClass
+{
+    bool operator()(char c) const { return c == '\0' || IsNewLine(c); }
+#if DILIGENT_SSE2_ENABLED || DILIGENT_NEON_ENABLED
+    CharVector operator()(CharVector v) const
+    {
+        return Or(Or(CmpEq(v, SplatChar('\r')), CmpEq(v, SplatChar('\n'))), CmpEq(v, SplatChar('\0')));
+    }
+#endif
+};
+
+// The given character or null character
+struct CharOrNullClass
+{
+    const char Char;
+
+    bool operator()(char c) const { return c == '\0' || c == Char; }
+#if DILIGENT_SSE2_ENABLED || DILIGENT_NEON_ENABLED
+    CharVector operator()(CharVector v) const
+    {
+        return Or(CmpEq(v, SplatChar(Char)), CmpEq(v, SplatChar('\0')));
+    }
+#endif
+};
+
+// Delimiter character (white space or new line)
+struct DelimiterClass
+{
+    bool operator()(char c) const { return IsDelimiter(c); }
+#if DILIGENT_SSE2_ENABLED || DILIGENT_NEON_ENABLED
+    CharVector operator()(CharVector v) const
+    {
+        return Or(Or(CmpEq(v, SplatChar(' ')), CmpEq(v, SplatChar('\t'))),
+                  Or(CmpEq(v, SplatChar('\r')), CmpEq(v, SplatChar('\n'))));
+    }
+#endif
+};
+
+// Identifier character: [a-zA-Z0-9_]
+struct IdentifierCharClass
+{
+    bool operator()(char c) const
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+#if DILIGENT_SSE2_ENABLED || DILIGENT_NEON_ENABLED
+    CharVector operator()(CharVector v) const
+    {
+        return Or(Or(InRange(v, 'a', 26), InRange(v, 'A', 26)),
+                  Or(InRange(v, '0', 10), CmpEq(v, SplatChar('_'))));
+    }
+#endif
+};
+
+#if DILIGENT_SSE2_ENABLED || DILIGENT_NEON_ENABLED
+// Returns the index of the first set (InClass == true) or the first unset (InClass == false)
+// lane in the 16-character mask, or 16 if there is no such lane.
+inline Uint32 FirstCharInMask(CharVector Mask, bool InClass) noexcept
+{
+#    if DILIGENT_SSE2_ENABLED
+    auto Bits = static_cast<Uint32>(_mm_movemask_epi8(Mask));
+    if (!InClass)
+        Bits = ~Bits & 0xFFFFu;
+    if (Bits == 0)
+        return 16;
+#        ifdef _MSC_VER
+    unsigned long Index = 0;
+    _BitScanForward(&Index, Bits);
+    return static_cast<Uint32>(Index);
+#        else
+    return static_cast<Uint32>(__builtin_ctz(Bits));
+#        endif
+#    else
+    // Narrow every 8-bit lane to 4 bits
+    auto Bits = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(Mask), 4)), 0);
+    if (!InClass)
+        Bits = ~Bits;
+    if (Bits == 0)
+        return 16;
+#        ifdef _MSC_VER
+    unsigned long Index = 0;
+    _BitScanForward64(&Index, Bits);
+    return static_cast<Uint32>(Index >> 2);
+#        else
+    return static_cast<Uint32>(__builtin_ctzll(Bits) >> 2);
+#        endif
+#    endif
+}
+#endif
+
+// Returns the position of the first character that belongs (InClass == true)
+// or does not belong (InClass == false) to the character class.
+template <typename CharClassType>
+const char* ScanContiguous(const char* Pos, const char* End, const CharClassType& CharClass, bool InClass) noexcept
+{
+#if DILIGENT_SSE2_ENABLED || DILIGENT_NEON_ENABLED
+    while (End - Pos >= 16)
+    {
+        const auto Index = FirstCharInMask(CharClass(LoadChars(Pos)), InClass);
+        if (Index < 16)
+            return Pos + Index;
+        Pos += 16;
+    }
+#endif
+    while (Pos != End && CharClass(*Pos) != InClass)
+        ++Pos;
+    return Pos;
+}
+
+// Iterators over contiguous character storage that can use the SIMD fast path
+template <typename IteratorType>
+struct IsContiguousCharIterator : std::false_type
+{};
+
+// clang-format off
+template <> struct IsContiguousCharIterator<const char*>                 : std::true_type {};
+template <> struct IsContiguousCharIterator<char*>                       : std::true_type {};
+template <> struct IsContiguousCharIterator<std::string::const_iterator> : std::true_type {};
+template <> struct IsContiguousCharIterator<std::string::iterator>       : std::true_type {};
+// clang-format on
+
+template <typename IteratorType, typename CharClassType>
+IteratorType Scan(const IteratorType& Start, const IteratorType& End, const CharClassType& CharClass, bool InClass, std::true_type) noexcept
+{
+    if (Start == End)
+        return Start;
+
+    const char* const pStart = &*Start;
+    return Start + (ScanContiguous(pStart, pStart + (End - Start), CharClass, InClass) - pStart);
+}
+
+template <typename IteratorType, typename CharClassType>
+IteratorType Scan(const IteratorType& Start, const IteratorType& End, const CharClassType& CharClass, bool InClass, std::false_type) noexcept
+{
+    auto Pos = Start;
+    while (Pos != End && CharClass(*Pos) != InClass)
+        ++Pos;
+    return Pos;
+}
+
+/// Returns the position of the first character in [Start, End) that belongs (InClass == true)
+/// or does not belong (InClass == false) to the character class.
+/// Contiguous char ranges are scanned 16 characters at a time with SSE2 or NEON.
+template <typename IteratorType, typename CharClassType>
+IteratorType Scan(const IteratorType& Start, const IteratorType& End, const CharClassType& CharClass, bool InClass) noexcept
+{
+    return Scan(Start, End, CharClass, InClass, IsContiguousCharIterator<IteratorType>{});
+}
+
+} // namespace Detail
+
+
 /// Skips all characters until the end of the line.
 
 /// \param[inout] Pos          - starting position.
@@ -83,9 +276,7 @@ inline bool IsStatementSeparator(Char Symbol) noexcept
 template <typename InteratorType>
 InteratorType SkipLine(const InteratorType& Start, const InteratorType& End, bool GoToNextLine = false) noexcept
 {
-    auto Pos = Start;
-    while (Pos != End && *Pos != '\0' && !IsNewLine(*Pos))
-        ++Pos;
+    auto Pos = Detail::Scan(Start, End, Detail::NewLineOrNullClass{}, true);
     if (GoToNextLine && Pos != End && IsNewLine(*Pos))
     {
         ++Pos;
@@ -173,6 +364,10 @@ InteratorType SkipComment(const InteratorType& Start, const InteratorType& End,
         //    ^
         while (Pos != End && *Pos != '\0')
         {
+            Pos = Detail::Scan(Pos, End, Detail::CharOrNullClass{'*'}, true);
+            if (Pos == End || *Pos == '\0')
+                break;
+
             if (*Pos == '*')
             {
                 //  /* Comment */
@@ -222,8 +417,7 @@ InteratorType SkipDelimiters(const InteratorType& Start, const InteratorType& En
     }
     else
     {
-        while (Pos != End && IsDelimiter(*Pos))
-            ++Pos;
+        Pos = Detail::Scan(Pos, End, Detail::DelimiterClass{}, false);
     }
     return Pos;
 }
@@ -281,10 +475,7 @@ IteratorType SkipIdentifier(const IteratorType& Start, const IteratorType& End)
     else
         return Pos;
 
-    while (Pos != End && (isalnum(*Pos) || *Pos == '_'))
-        ++Pos;
-
-    return Pos;
+    return Detail::Scan(Pos, End, Detail::IdentifierCharClass{}, false);
 }
 
 
@@ -680,8 +871,7 @@ ContainerType Tokenize(const IteratorType&   SourceStart,
                     Type = TokenType::StringConstant;
                     ++LiteralStart;
                     ++Pos;
-                    while (Pos != SourceEnd && *Pos != '\0' && *Pos != '"')
-                        ++Pos;
+                    Pos = Detail::Scan(Pos, SourceEnd, Detail::CharOrNullClass{'"'}, true);
                     if (Pos == SourceEnd || *Pos != '"')
                         throw std::pair<IteratorType, const char*>{LiteralStart - 1, "Unable to find matching closing quotes."};
 
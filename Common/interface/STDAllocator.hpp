@@ -215,4 +215,67 @@ private:
 };
 template <class T> using STDDeleterRawMem = STDDeleter<T, IMemoryAllocator>;
 
+
+/// STL-compatible allocator that allocates memory from a linear allocator, e.g. DynamicLinearAllocator.
+
+/// The linear allocator must implement Allocate(size_t Size, size_t Alignment).
+/// Memory is never released by deallocate() and is reclaimed all at once when
+/// the linear allocator is discarded, so the containers that use this allocator
+/// must not outlive the discard.
+template <typename T, typename LinearAllocatorType>
+struct STDLinearAllocator
+{
+    using value_type      = T;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    STDLinearAllocator(LinearAllocatorType& Allocator) noexcept :
+        m_Allocator{Allocator}
+    {
+    }
+
+    template <class U>
+    STDLinearAllocator(const STDLinearAllocator<U, LinearAllocatorType>& other) noexcept :
+        m_Allocator{other.m_Allocator}
+    {
+    }
+
+    template <class U> struct rebind
+    {
+        typedef STDLinearAllocator<U, LinearAllocatorType> other;
+    };
+
+    T* allocate(std::size_t count)
+    {
+        return reinterpret_cast<T*>(m_Allocator.Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t count)
+    {
+    }
+
+    inline size_type max_size() const
+    {
+        return (std::numeric_limits<size_type>::max)() / sizeof(T);
+    }
+
+    LinearAllocatorType& m_Allocator;
+};
+
+template <class T, class U, class A>
+bool operator==(const STDLinearAllocator<T, A>& left, const STDLinearAllocator<U, A>& right) noexcept
+{
+    return &left.m_Allocator == &right.m_Allocator;
+}
+
+template <class T, class U, class A>
+bool operator!=(const STDLinearAllocator<T, A>& left, const STDLinearAllocator<U, A>& right)
+{
+    return !(left == right);
+}
+
 } // namespace Diligent
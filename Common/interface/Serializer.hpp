@@ -231,6 +231,25 @@ public:
                         CountType&              Count,
                         ArrayElemSerializerType ElemSerializer);
 
+    /// Serializes an array of trivially serializable elements
+    ///
+    ///  * Measure
+    ///      Writes Count (noop)
+    ///      Aligns up current offset to the element alignment
+    ///      Writes Count elements (noop)
+    ///
+    ///  * Write
+    ///      Writes Count
+    ///      Aligns up current offset to the element alignment
+    ///      Writes Count elements
+    ///
+    ///  * Read
+    ///      Reads Count
+    ///      Aligns up current offset to the element alignment
+    ///      If Elements is a pointer to const and the data is properly aligned,
+    ///      sets Elements to m_Ptr (the source data must outlive the array).
+    ///      Otherwise, copies the elements into the memory allocated from Allocator.
+    ///      Moves m_Ptr by Count elements
     template <typename ElemPtrType, typename CountType>
     bool SerializeArrayRaw(DynamicLinearAllocator* Allocator,
                            ElemPtrType&            Elements,
@@ -296,6 +315,22 @@ private:
     template <typename T>
     bool Copy(T* pData, size_t Size);
 
+    template <typename T>
+    bool BorrowArray(const T*& DstArray)
+    {
+        if (reinterpret_cast<size_t>(m_Ptr) % alignof(T) != 0)
+            return false;
+        DstArray = reinterpret_cast<const T*>(m_Ptr);
+        return true;
+    }
+
+    template <typename T>
+    bool BorrowArray(T*& DstArray)
+    {
+        // Mutable arrays are always copied
+        return false;
+    }
+
     void AlignOffset(size_t Alignment)
     {
         const auto Size       = GetSize();
@@ -482,17 +517,57 @@ bool Serializer<SerializerMode::Read>::SerializeArray(DynamicLinearAllocator* Al
 }
 
 
-template <SerializerMode Mode>
+template <SerializerMode Mode> // Write or Measure
 template <typename ElemPtrType, typename CountType>
 bool Serializer<Mode>::SerializeArrayRaw(DynamicLinearAllocator* Allocator,
-                                         ElemPtrType&            Elements,
+                                         ElemPtrType&            SrcArray,
                                          CountType&              Count)
 {
-    return SerializeArray(Allocator, Elements, Count,
-                          [](Serializer<Mode>& Ser, auto& Elem) //
-                          {
-                              return Ser(Elem);
-                          });
+    static_assert(Mode == SerializerMode::Write || Mode == SerializerMode::Measure, "Unexpected mode");
+    using ElemType = RawType<decltype(SrcArray[0])>;
+    static_assert(IsTriviallySerializable<ElemType>::value, "Element type must be trivially serializable");
+    VERIFY_EXPR((SrcArray != nullptr) == (Count != 0));
+
+    if (!(*this)(Count))
+        return false;
+
+    AlignOffset(alignof(ElemType));
+    return Copy(SrcArray, sizeof(ElemType) * static_cast<size_t>(Count));
+}
+
+template <>
+template <typename ElemPtrType, typename CountType>
+bool Serializer<SerializerMode::Read>::SerializeArrayRaw(DynamicLinearAllocator* Allocator,
+                                                         ElemPtrType&            DstArray,
+                                                         CountType&              Count)
+{
+    using ElemType = RawType<decltype(DstArray[0])>;
+    static_assert(IsTriviallySerializable<ElemType>::value, "Element type must be trivially serializable");
+    VERIFY_EXPR(DstArray == nullptr);
+
+    if (!(*this)(Count))
+        return false;
+
+    AlignOffset(alignof(ElemType));
+
+    const size_t Size = sizeof(ElemType) * static_cast<size_t>(Count);
+    CHECK_REMAINING_SIZE(Size, "Note enough data to read ", Count, " array elements.");
+    if (Count == 0)
+        return true;
+
+    if (!BorrowArray(DstArray))
+    {
+        VERIFY(Allocator != nullptr, "Allocator must not be null when the array can't reference the source data");
+        if (Allocator == nullptr)
+            return false;
+
+        auto* pDstElements = Allocator->Allocate<ElemType>(static_cast<size_t>(Count));
+        std::memcpy(pDstElements, m_Ptr, Size);
+        DstArray = pDstElements;
+    }
+    m_Ptr += Size;
+
+    return true;
 }
 
 #undef CHECK_REMAINING_SIZE
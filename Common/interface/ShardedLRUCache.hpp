@@ -0,0 +1,410 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::ShardedLRUCache class
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Eviction policy of the ShardedLRUCache
+enum class CacheEvictionPolicy : Uint8
+{
+    /// Every cache hit moves the entry to the front of the shard's LRU list,
+    /// which requires an exclusive shard lock.
+    LRU,
+
+    /// Cache hits only take a shared shard lock and mark the entry as referenced.
+    /// When the eviction reaches a referenced entry, it clears the mark and moves
+    /// the entry to the front of the list instead of evicting it (CLOCK approximation of LRU).
+    Clock
+};
+
+/// A thread-safe and exception-safe LRU cache that is split into independent shards.
+///
+/// Every shard has its own lock and its own LRU list, so threads that access keys in different
+/// shards never contend. The maximum size is split evenly between the shards, and
+/// every shard evicts its own entries when it exceeds its part of the budget.
+///
+/// Usage example:
+///
+///     ShardedLRUCache<std::string, CacheData> Cache{{/*MaxSize = */ 32768, /*NumShards = */ 16, CacheEvictionPolicy::Clock}};
+///     auto Data = Cache.Get("DataKey",
+///                           [](CacheData& Data, size_t& Size) //
+///                           {
+///                               // Create the data and return its size.
+///                               // May throw an exception in case of an error.
+///                               Data.pData = pData;
+///                               Size       = pData->GetSize();
+///                           });
+///
+/// \note   Same as in LRUCache, the Get() method returns the data by value. If the data is not found,
+///         it is atomically initialized by the provided initializer function while the shard lock is not held.
+template <typename KeyType, typename DataType, typename KeyHasher = std::hash<KeyType>>
+class ShardedLRUCache
+{
+public:
+    /// Callback that returns the current memory budget of the cache, in the same units as the data
+    /// sizes reported by initializers. It is called by every eviction pass while a shard lock is held,
+    /// so it must be thread-safe and fast.
+    using BudgetCallbackType = std::function<size_t()>;
+
+    struct CreateInfo
+    {
+        /// Maximum cache size. Ignored if GetBudget is set.
+        size_t MaxSize = 0;
+
+        /// The number of shards.
+        Uint32 NumShards = 16;
+
+        /// Eviction policy.
+        CacheEvictionPolicy Policy = CacheEvictionPolicy::LRU;
+
+        /// Optional callback that returns the current cache budget.
+        BudgetCallbackType GetBudget = nullptr;
+    };
+
+    explicit ShardedLRUCache(const CreateInfo& CI) :
+        m_NumShards{(std::max)(CI.NumShards, 1u)},
+        m_Shards{new Shard[m_NumShards]},
+        m_Policy{CI.Policy},
+        m_GetBudget{CI.GetBudget},
+        m_MaxSize{CI.MaxSize}
+    {}
+
+    // clang-format off
+    ShardedLRUCache           (const ShardedLRUCache&) = delete;
+    ShardedLRUCache& operator=(const ShardedLRUCache&) = delete;
+    // clang-format on
+
+    ~ShardedLRUCache()
+    {
+#ifdef DILIGENT_DEBUG
+        size_t DbgSize = 0;
+        for (Uint32 i = 0; i < m_NumShards; ++i)
+        {
+            const Shard& S = m_Shards[i];
+            VERIFY_EXPR(S.Map.size() == S.List.size());
+            for (const auto& it : S.Map)
+                DbgSize += it.second.pWrpr->IsAccounted() ? it.second.pWrpr->GetSize() : 0;
+        }
+        VERIFY_EXPR(DbgSize == m_CurrSize);
+#endif
+    }
+
+    /// Finds the data in the cache and returns it. If the data is not found, it is atomically created
+    /// using the provided initializer.
+    ///
+    /// \param [in] Key      - The data key.
+    /// \param [in] InitData - Initializer function that is called if the data is not found in the cache.
+    ///
+    /// \return     Data with the specified key, either retrieved from the cache or initialized with
+    ///             the InitData function.
+    ///
+    /// \remarks    InitData function may throw in case of an error.
+    template <typename InitDataType>
+    DataType Get(const KeyType& Key,
+                 InitDataType&& InitData // May throw
+                 ) noexcept(false)
+    {
+        Shard& S = GetShard(Key);
+
+        // Since this is a shared pointer, the wrapper may not be destroyed while we keep it,
+        // even if it is evicted from the cache by another thread.
+        std::shared_ptr<DataWrapper> pWrpr = GetDataWrapper(S, Key);
+        VERIFY_EXPR(pWrpr);
+
+        bool     IsNewObject = false;
+        DataType Data;
+        try
+        {
+            Data = pWrpr->GetData(std::forward<InitDataType>(InitData), IsNewObject);
+        }
+        catch (...)
+        {
+            // Remove the failed wrapper so that it does not occupy the shard. If another thread
+            // is retrying the initialization, its result will not be accounted, but it will still
+            // be returned to the caller.
+            std::unique_lock<std::shared_timed_mutex> Lock{S.Mtx};
+
+            auto it = S.Map.find(Key);
+            if (it != S.Map.end() && it->second.pWrpr == pWrpr && !pWrpr->IsInitialized())
+            {
+                S.List.erase(it->second.ListIt);
+                S.Map.erase(it);
+            }
+            throw;
+        }
+
+        if (IsNewObject)
+        {
+            std::vector<std::shared_ptr<DataWrapper>> DeleteList;
+            {
+                std::unique_lock<std::shared_timed_mutex> Lock{S.Mtx};
+
+                // The wrapper may have been evicted while the lock was released
+                auto it = S.Map.find(Key);
+                if (it != S.Map.end() && it->second.pWrpr == pWrpr)
+                {
+                    pWrpr->SetAccounted();
+                    S.Size += pWrpr->GetSize();
+                    m_CurrSize.fetch_add(pWrpr->GetSize());
+                }
+
+                Evict(S, DeleteList);
+            }
+            // Delete objects after releasing the shard lock
+        }
+
+        return Data;
+    }
+
+    /// Evicts entries from all shards until every shard fits its part of the current budget.
+    /// Call this method when the budget returned by the budget callback decreases.
+    void Trim()
+    {
+        for (Uint32 i = 0; i < m_NumShards; ++i)
+        {
+            std::vector<std::shared_ptr<DataWrapper>> DeleteList;
+
+            std::unique_lock<std::shared_timed_mutex> Lock{m_Shards[i].Mtx};
+            Evict(m_Shards[i], DeleteList);
+        }
+    }
+
+    /// Sets the maximum cache size. Ignored if the budget callback is set.
+    void SetMaxSize(size_t MaxSize)
+    {
+        m_MaxSize = MaxSize;
+    }
+
+    /// Returns the current cache size.
+    size_t GetCurrSize() const
+    {
+        return m_CurrSize;
+    }
+
+    Uint32 GetNumShards() const
+    {
+        return m_NumShards;
+    }
+
+private:
+    class DataWrapper
+    {
+    public:
+        template <typename InitDataType>
+        const DataType& GetData(InitDataType&& InitData, bool& IsNewObject) noexcept(false)
+        {
+            // The data is never modified after it has been initialized
+            if (m_Initialized.load(std::memory_order_acquire))
+                return m_Data;
+
+            std::lock_guard<std::mutex> Lock{m_InitDataMtx};
+            if (!m_Initialized.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    size_t DataSize = 0;
+                    InitData(m_Data, DataSize); // May throw
+                    VERIFY_EXPR(DataSize > 0);
+                    m_DataSize = (std::max)(DataSize, size_t{1});
+                    m_Initialized.store(true, std::memory_order_release);
+                    IsNewObject = true;
+                }
+                catch (...)
+                {
+                    m_Data = {};
+                    throw;
+                }
+            }
+            return m_Data;
+        }
+
+        bool IsInitialized() const
+        {
+            return m_Initialized.load(std::memory_order_acquire);
+        }
+
+        size_t GetSize() const
+        {
+            VERIFY_EXPR(IsInitialized());
+            return m_DataSize;
+        }
+
+        // Accounted state is protected by the shard lock
+        void SetAccounted()
+        {
+            VERIFY(!m_Accounted, "The wrapper has already been accounted.");
+            m_Accounted = true;
+        }
+        bool IsAccounted() const { return m_Accounted; }
+
+        void MarkReferenced() { m_Referenced.store(true, std::memory_order_relaxed); }
+        bool ResetReferenced() { return m_Referenced.exchange(false, std::memory_order_relaxed); }
+
+    private:
+        std::mutex        m_InitDataMtx;
+        DataType          m_Data;
+        size_t            m_DataSize = 0;
+        std::atomic<bool> m_Initialized{false};
+        std::atomic<bool> m_Referenced{false};
+        bool              m_Accounted = false;
+    };
+
+    struct Entry;
+    using MapValueType = std::pair<const KeyType, Entry>;
+    // The list keeps pointers to the map elements, which stay valid when the map is rehashed.
+    // The most recently used entries are at the front of the list.
+    using LRUListType = std::list<MapValueType*>;
+
+    struct Entry
+    {
+        std::shared_ptr<DataWrapper>   pWrpr;
+        typename LRUListType::iterator ListIt;
+    };
+
+    struct Shard
+    {
+        std::shared_timed_mutex                       Mtx;
+        std::unordered_map<KeyType, Entry, KeyHasher> Map;
+        LRUListType                                   List;
+        size_t                                        Size = 0;
+    };
+
+    Shard& GetShard(const KeyType& Key) const
+    {
+        size_t Hash = KeyHasher{}(Key);
+        // The map uses the same hash, so mix the bits to decorrelate the shard and the bucket
+        Hash ^= (Hash >> 17u) ^ (Hash >> 31u);
+        Hash *= size_t{0x9E3779B1u};
+        return m_Shards[(Hash >> 7u) % m_NumShards];
+    }
+
+    std::shared_ptr<DataWrapper> GetDataWrapper(Shard& S, const KeyType& Key)
+    {
+        if (m_Policy == CacheEvictionPolicy::Clock)
+        {
+            std::shared_lock<std::shared_timed_mutex> Lock{S.Mtx};
+
+            auto it = S.Map.find(Key);
+            if (it != S.Map.end())
+            {
+                it->second.pWrpr->MarkReferenced();
+                return it->second.pWrpr;
+            }
+        }
+
+        std::unique_lock<std::shared_timed_mutex> Lock{S.Mtx};
+
+        auto it = S.Map.find(Key);
+        if (it == S.Map.end())
+        {
+            it = S.Map.emplace(Key, Entry{std::make_shared<DataWrapper>(), {}}).first;
+            S.List.push_front(&*it);
+            it->second.ListIt = S.List.begin();
+        }
+        else if (m_Policy == CacheEvictionPolicy::Clock)
+        {
+            // The entry has been added by another thread after we released the shared lock
+            it->second.pWrpr->MarkReferenced();
+        }
+        else
+        {
+            S.List.splice(S.List.begin(), S.List, it->second.ListIt);
+        }
+        VERIFY_EXPR(S.Map.size() == S.List.size());
+
+        return it->second.pWrpr;
+    }
+
+    // Must be called while the shard lock is held exclusively
+    void Evict(Shard& S, std::vector<std::shared_ptr<DataWrapper>>& DeleteList)
+    {
+        const size_t Budget      = m_GetBudget ? m_GetBudget() : m_MaxSize.load();
+        const size_t ShardBudget = Budget / m_NumShards + (Budget % m_NumShards != 0 ? 1 : 0);
+
+        // Walk the list from the least recently used entry. In Clock mode, referenced entries are
+        // moved to the front, so every entry is visited at most twice.
+        auto Cursor = S.List.end();
+        while (S.Size > ShardBudget && Cursor != S.List.begin())
+        {
+            auto        curr_it = std::prev(Cursor);
+            const auto& pWrpr   = (*curr_it)->second.pWrpr;
+
+            if (!pWrpr->IsAccounted())
+            {
+                // The data is being initialized by another thread
+                Cursor = curr_it;
+                continue;
+            }
+
+            if (m_Policy == CacheEvictionPolicy::Clock && pWrpr->ResetReferenced())
+            {
+                // Give the entry a second chance
+                S.List.splice(S.List.begin(), S.List, curr_it);
+                continue;
+            }
+
+            const size_t Size = pWrpr->GetSize();
+            VERIFY_EXPR(S.Size >= Size && m_CurrSize >= Size);
+            S.Size -= Size;
+            m_CurrSize.fetch_sub(Size);
+
+            DeleteList.emplace_back(std::move((*curr_it)->second.pWrpr));
+            S.Map.erase(S.Map.find((*curr_it)->first));
+            S.List.erase(curr_it);
+        }
+        VERIFY_EXPR(S.Map.size() == S.List.size());
+    }
+
+    const Uint32                   m_NumShards;
+    const std::unique_ptr<Shard[]> m_Shards;
+    const CacheEvictionPolicy      m_Policy;
+    const BudgetCallbackType       m_GetBudget;
+
+    std::atomic<size_t> m_CurrSize{0};
+    std::atomic<size_t> m_MaxSize{0};
+};
+
+} // namespace Diligent
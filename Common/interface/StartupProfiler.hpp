@@ -0,0 +1,158 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::StartupProfiler class
+
+#include <string>
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Event of the startup timeline recorded by the StartupProfiler
+struct StartupTimelineEvent
+{
+    static constexpr Uint32 InvalidParent = ~0u;
+
+    /// Event name, e.g. "Create Vulkan instance"
+    std::string Name;
+
+    /// Index of the thread that recorded the event.
+    /// Threads are numbered in the order they record their first event.
+    Uint32 ThreadIndex = 0;
+
+    /// Nesting depth of the event within its thread. Top-level events have depth 0.
+    Uint32 Depth = 0;
+
+    /// Index of the enclosing event in StartupTimeline::Events, or InvalidParent for top-level events.
+    Uint32 Parent = InvalidParent;
+
+    /// Time, in seconds, elapsed from the start of the recording to the beginning of the event.
+    double StartTime = 0;
+
+    /// Event duration, in seconds. Marks have zero duration.
+    /// Negative if the event was still in progress when the recording stopped.
+    double Duration = -1;
+};
+
+/// Startup timeline recorded by the StartupProfiler
+struct StartupTimeline
+{
+    /// Events in the order they began. Every parent precedes its children.
+    std::vector<StartupTimelineEvent> Events;
+
+    /// Total recording time, in seconds.
+    double TotalTime = 0;
+
+    /// Returns the human-readable report where the events of every thread are
+    /// listed as a tree with their start times and durations.
+    std::string GetReport() const;
+
+    /// Returns the timeline as a JSON string in the Chrome trace event format
+    /// that can be loaded into chrome://tracing or Perfetto.
+    std::string GetJSON() const;
+
+    /// Writes the JSON returned by GetJSON() to the file.
+    bool WriteJSON(const Char* FilePath) const;
+};
+
+/// Opt-in recorder of the hierarchical timeline of the engine initialization.
+
+/// The engine enables the recording when Diligent::EngineCreateInfo::StartupProfiling.Enable is true.
+/// While the recording is active, engine creation phases, first-use costs (e.g. shader compiler
+/// loading) and device object creation are recorded as nested scopes:
+///
+///     {
+///         StartupProfiler::Scope ProfilerScope{"Create logical device"};
+///         ...
+///     }
+///
+/// When the recording is not active, a scope only performs a single relaxed atomic load.
+///
+/// \remarks    The profiler is process-wide. Scopes may be recorded from any thread.
+class StartupProfiler
+{
+public:
+    /// Starts the recording.
+    /// Returns false if the recording is already in progress.
+    static bool Start();
+
+    /// Stops the recording and returns the recorded timeline in Timeline.
+    /// Returns false if the recording was not in progress.
+    ///
+    /// \remarks    Events that are still in progress have negative durations.
+    ///             They are not updated when their scopes end after the recording stopped.
+    static bool Stop(StartupTimeline& Timeline);
+
+    /// Returns true if the recording is in progress.
+    static bool IsActive() noexcept;
+
+    /// Records a mark (an event with zero duration), e.g. "Frame 0 finished".
+    static void AddMark(const Char* Name);
+
+    /// Scope that records an event from construction till destruction.
+    class Scope
+    {
+    public:
+        /// Begins the event. If Detail is not null, it is appended to the
+        /// name in quotes, e.g. "Create Texture 'Albedo'".
+        explicit Scope(const Char* Name, const Char* Detail = nullptr)
+        {
+            if (IsActive())
+                Begin(Name, Detail);
+        }
+
+        ~Scope()
+        {
+            if (m_Session != 0)
+                End();
+        }
+
+        // clang-format off
+        Scope           (const Scope&) = delete;
+        Scope           (Scope&&)      = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&)      = delete;
+        // clang-format on
+
+    private:
+        void Begin(const Char* Name, const Char* Detail);
+        void End();
+
+        // Recording session, or 0 if the event is not recorded.
+        Uint32 m_Session    = 0;
+        Uint32 m_EventIndex = 0;
+    };
+};
+
+} // namespace Diligent
@@ -28,7 +28,9 @@
 
 #include <atomic>
 #include <functional>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "../../Primitives/interface/Object.h"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
@@ -115,6 +117,62 @@ public:
 };
 
 
+/// Execution record of a task that was run by the thread pool, see IThreadPool::GetTrace().
+
+/// All times are in seconds and are measured from the thread pool creation.
+struct ThreadPoolTaskEvent
+{
+    /// Sequential number of the task assigned when it was enqueued.
+    Uint32 TaskId = 0;
+
+    /// Id of the thread that ran the task, see IAsyncTask::Run().
+    Uint32 ThreadId = 0;
+
+    /// Task priority at the time the task was started.
+    float Priority = 0;
+
+    /// Whether the task was cancelled.
+    bool Cancelled = false;
+
+    /// Time when the task was passed to IThreadPool::EnqueueTask().
+    double EnqueueTime = 0;
+
+    /// Time when all prerequisites of the task were finished and the task was placed into the queue.
+    /// For tasks without prerequisites, this is the same as EnqueueTime.
+    double ReadyTime = 0;
+
+    /// Time when the task was started.
+    double StartTime = 0;
+
+    /// Time when the task was finished.
+    double EndTime = 0;
+};
+
+/// Task execution trace of the thread pool, see IThreadPool::GetTrace().
+struct ThreadPoolTrace
+{
+    /// Events of the finished tasks sorted by their start times.
+    std::vector<ThreadPoolTaskEvent> Events;
+
+    /// The number of events that were overwritten in the trace rings before they could be read.
+    Uint64 NumDroppedEvents = 0;
+
+    /// Time when the trace was read, in seconds from the thread pool creation.
+    double CaptureTime = 0;
+
+    /// Returns the trace as a JSON string in the Chrome trace event format
+    /// that can be loaded into chrome://tracing or Perfetto.
+    ///
+    /// \remarks    Every task is shown as a slice on the track of the thread that ran it.
+    ///             The slice arguments contain the task priority, the time the task spent
+    ///             in the queue and the time it waited for its prerequisites.
+    std::string GetJSON() const;
+
+    /// Writes the JSON returned by GetJSON() to the file.
+    bool WriteJSON(const Char* FilePath) const;
+};
+
+
 // {8BB92B5E-3EAB-4CC3-9DA2-5470DBBA7120}
 static const INTERFACE_ID IID_ThreadPool =
     {0x8bb92b5e, 0x3eab, 0x4cc3, {0x9d, 0xa2, 0x54, 0x70, 0xdb, 0xba, 0x71, 0x20}};
@@ -125,11 +183,20 @@ class IThreadPool : public IObject
 public:
     /// Enqueues asynchronous task for execution.
 
-    /// \param[in] pTask - Task to run.
+    /// \param[in] pTask            - Task to run.
+    /// \param[in] ppPrerequisites  - An array of tasks that must be finished before this task can start.
+    /// \param[in] NumPrerequisites - The number of elements in ppPrerequisites array.
     ///
     /// \remarks   Thread pool will keep a strong reference to the task,
     ///            so an application is free to release it after enqueuing.
-    virtual void EnqueueTask(IAsyncTask* pTask) = 0;
+    ///
+    ///            The task will not be added to the ready queue until all its prerequisites
+    ///            are finished (i.e. complete or cancelled). The thread pool tracks dependencies
+    ///            internally and does not poll prerequisites. All prerequisites that are
+    ///            not finished at the time of the call must be enqueued into the same thread pool.
+    virtual void EnqueueTask(IAsyncTask*  pTask,
+                             IAsyncTask** ppPrerequisites  = nullptr,
+                             Uint32       NumPrerequisites = 0) = 0;
 
 
     /// Reprioritizes the task in the queue.
@@ -160,6 +227,10 @@ public:
     ///
     /// \return    true if the task has been successfully removed from the queue
     ///            or if it has already finished, and false otherwise.
+    ///
+    /// \remarks   The removed task is moved to ASYNC_TASK_STATUS_CANCELLED state.
+    ///            The tasks that depend on the removed task, including the tasks
+    ///            that are enqueued later, are treated as if the removed task has finished.
     virtual bool RemoveTask(IAsyncTask* pTask, bool CancelIfRunning) = 0;
 
 
@@ -173,6 +244,8 @@ public:
 
 
     /// Returns the current queue size.
+
+    /// \remarks   The queue size includes the tasks that are waiting for their prerequisites.
     virtual Uint32 GetQueueSize() = 0;
 
     /// Returns the number of currently running tasks
@@ -238,9 +311,66 @@ public:
     ///                 }
     ///
     virtual bool ProcessTask(Uint32 ThreadId, bool WaitForTask) = 0;
+
+
+    /// Returns the execution events of the tasks that finished since the last call with Clear set to true.
+
+    /// \param[out] Trace - Task execution trace.
+    /// \param[in]  Clear - Whether to remove the returned events from the trace rings.
+    ///
+    /// \return     true if the tracing is enabled, see ThreadPoolCreateInfo::TraceCapacity,
+    ///             and false otherwise.
+    ///
+    /// \remarks    Worker threads record the events into lock-free per-thread rings
+    ///             and are never blocked by this method. If a ring overflows, the oldest
+    ///             events are lost and are counted in ThreadPoolTrace::NumDroppedEvents.
+    virtual bool GetTrace(ThreadPoolTrace& Trace, bool Clear = false) = 0;
 };
 
 
+/// Thread pool scheduling mode
+enum THREAD_POOL_SCHEDULING_MODE : Uint8
+{
+    /// All tasks are stored in a single priority queue.
+    /// Tasks are always started in the order of their priorities.
+    THREAD_POOL_SCHEDULING_MODE_PRIORITY_QUEUE = 0,
+
+    /// Every worker thread has its own task queue. A thread that runs out
+    /// of work steals tasks from the queues of other threads.
+
+    /// \remarks   Tasks enqueued from a worker thread are added to the queue of that thread,
+    ///            other tasks are distributed between the queues in a round-robin fashion.
+    ///            Priorities are respected within every queue, but not across the queues.
+    ///
+    ///            This mode significantly reduces the contention when many small tasks
+    ///            are enqueued and processed by many threads.
+    THREAD_POOL_SCHEDULING_MODE_WORK_STEALING
+};
+
+/// Thread pool worker thread placement policy
+enum THREAD_POOL_PLACEMENT : Uint8
+{
+    /// Worker threads are not pinned to any cores and are scheduled by the OS.
+    THREAD_POOL_PLACEMENT_ANY = 0,
+
+    /// Worker threads only run on performance cores.
+    /// This placement is intended for latency-critical work.
+    THREAD_POOL_PLACEMENT_PERFORMANCE_CORES,
+
+    /// Worker threads only run on efficiency cores, so that they do not compete with
+    /// the latency-critical threads (e.g. the render thread) for performance cores.
+    /// This placement is intended for throughput work such as shader compilation or streaming.
+
+    /// \remarks   If the CPU does not have efficiency cores, all cores are used.
+    THREAD_POOL_PLACEMENT_EFFICIENCY_CORES,
+
+    /// Every worker thread is pinned to its own physical core, so that the worker threads
+    /// do not share cores with SMT siblings. Performance cores are used first.
+
+    /// \remarks   If there are more worker threads than physical cores, the cores are reused.
+    THREAD_POOL_PLACEMENT_ONE_THREAD_PER_CORE
+};
+
 /// Thread pool create information
 struct ThreadPoolCreateInfo
 {
@@ -259,6 +389,35 @@ struct ThreadPoolCreateInfo
     /// An optional function that will be called by the thread pool from
     /// the worker thread before the worker thread exits.
     std::function<void(Uint32)> OnThreadExiting = nullptr;
+
+    /// Task scheduling mode, see Diligent::THREAD_POOL_SCHEDULING_MODE.
+    THREAD_POOL_SCHEDULING_MODE SchedulingMode = THREAD_POOL_SCHEDULING_MODE_PRIORITY_QUEUE;
+
+    /// The number of task queues in THREAD_POOL_SCHEDULING_MODE_WORK_STEALING mode.
+
+    /// \remarks   If zero, the number of queues will be equal to NumThreads, or to the number
+    ///            of hardware threads if NumThreads is zero. IThreadPool::ProcessTask() uses
+    ///            the queue with index ThreadId % NumQueues as the thread's local queue.
+    ///            This member is ignored in THREAD_POOL_SCHEDULING_MODE_PRIORITY_QUEUE mode.
+    Uint32 NumQueues = 0;
+
+    /// Worker thread placement policy, see Diligent::THREAD_POOL_PLACEMENT.
+
+    /// \remarks   The placement is based on the CPU topology reported by PlatformMisc::GetCPUTopology().
+    ///            On platforms that do not support thread affinity, this member is ignored.
+    THREAD_POOL_PLACEMENT Placement = THREAD_POOL_PLACEMENT_ANY;
+
+    /// An optional mask of the logical processors the worker threads are allowed to run on.
+    /// If not zero, the mask is combined with the processors selected by the placement policy.
+    /// This allows e.g. reserving a core for the render thread.
+    Uint64 AffinityMask = 0;
+
+    /// The number of task events that the trace ring of every thread can hold.
+    /// If zero, task tracing is disabled.
+
+    /// \remarks   When tracing is enabled, the thread pool records the enqueue, ready, start
+    ///            and end times of every task, see IThreadPool::GetTrace().
+    Uint32 TraceCapacity = 0;
 };
 
 RefCntAutoPtr<IThreadPool> CreateThreadPool(const ThreadPoolCreateInfo& ThreadPoolCI);
@@ -363,7 +522,11 @@ private:
 
 
 template <typename HanlderType>
-RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool, HanlderType Handler, float fPriority = 0)
+RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool,
+                                           IAsyncTask** ppPrerequisites,
+                                           Uint32       NumPrerequisites,
+                                           HanlderType  Handler,
+                                           float        fPriority = 0)
 {
     class TaskImpl final : public AsyncTaskBase
     {
@@ -386,9 +549,15 @@ RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool, HanlderType
     };
 
     RefCntAutoPtr<TaskImpl> pTask{MakeNewRCObj<TaskImpl>()(fPriority, std::move(Handler))};
-    pThreadPool->EnqueueTask(pTask);
+    pThreadPool->EnqueueTask(pTask, ppPrerequisites, NumPrerequisites);
 
     return pTask;
 }
 
+template <typename HanlderType>
+RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool, HanlderType Handler, float fPriority = 0)
+{
+    return EnqueueAsyncWork(pThreadPool, nullptr, 0, std::move(Handler), fPriority);
+}
+
 } // namespace Diligent
@@ -29,6 +29,22 @@
 
 #include <chrono>
 
+#include "../../Primitives/interface/BasicTypes.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#    define DILIGENT_CPU_TIMESTAMP_RDTSC 1
+#    ifdef _MSC_VER
+#        include <intrin.h>
+#    else
+#        include <x86intrin.h>
+#    endif
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#    define DILIGENT_CPU_TIMESTAMP_CNTVCT 1
+#    ifdef _MSC_VER
+#        include <intrin.h>
+#    endif
+#endif
+
 namespace Diligent
 {
 
@@ -44,4 +60,83 @@ private:
     std::chrono::high_resolution_clock::time_point m_StartTime;
 };
 
+
+/// Returns the value of the CPU timestamp counter.
+
+/// The counter is read with a single instruction: rdtsc on x86 and x64,
+/// and the virtual counter register (cntvct_el0) on ARM64. On other
+/// architectures, the function returns std::chrono::steady_clock time in nanoseconds.
+///
+/// \remarks   On x86, the function relies on the invariant TSC that is present on all modern CPUs
+///            and ticks at a constant rate regardless of the core frequency and power state.
+///            The counter is not serializing, so the timestamps of very short code
+///            sequences may be reordered by the CPU.
+inline Uint64 GetCPUTimestamp() noexcept
+{
+#if DILIGENT_CPU_TIMESTAMP_RDTSC
+    return __rdtsc();
+#elif DILIGENT_CPU_TIMESTAMP_CNTVCT
+#    ifdef _MSC_VER
+    return static_cast<Uint64>(_ReadStatusReg(ARM64_CNTVCT));
+#    else
+    Uint64 Value;
+    asm volatile("mrs %0, cntvct_el0"
+                 : "=r"(Value));
+    return Value;
+#    endif
+#else
+    return static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/// Returns the number of CPU timestamp counter ticks per second, see GetCPUTimestamp().
+
+/// \remarks   On x86, the frequency is calibrated against std::chrono::steady_clock
+///            by the first call, which takes about 10 ms. Call the function during
+///            initialization to avoid the stall later.
+Uint64 GetCPUTimestampFrequency() noexcept;
+
+/// Converts the number of CPU timestamp counter ticks to seconds.
+inline double CPUTicksToSeconds(Uint64 Ticks) noexcept
+{
+    return static_cast<double>(Ticks) / static_cast<double>(GetCPUTimestampFrequency());
+}
+
+/// Converts the number of CPU timestamp counter ticks to nanoseconds.
+inline Uint64 CPUTicksToNanoseconds(Uint64 Ticks) noexcept
+{
+    const auto Frequency = GetCPUTimestampFrequency();
+    // Split the ticks to avoid overflow
+    return (Ticks / Frequency) * Uint64{1000000000} + (Ticks % Frequency) * Uint64{1000000000} / Frequency;
+}
+
+/// Low-overhead timer based on the CPU timestamp counter, see GetCPUTimestamp().
+class CPUTimer
+{
+public:
+    CPUTimer() noexcept :
+        m_StartTicks{GetCPUTimestamp()}
+    {}
+
+    void Restart() noexcept
+    {
+        m_StartTicks = GetCPUTimestamp();
+    }
+
+    /// Returns the number of ticks elapsed since the timer was created or restarted.
+    Uint64 GetElapsedTicks() const noexcept
+    {
+        return GetCPUTimestamp() - m_StartTicks;
+    }
+
+    /// Returns the time, in seconds, elapsed since the timer was created or restarted.
+    double GetElapsedTime() const noexcept
+    {
+        return CPUTicksToSeconds(GetElapsedTicks());
+    }
+
+private:
+    Uint64 m_StartTicks;
+};
+
 } // namespace Diligent
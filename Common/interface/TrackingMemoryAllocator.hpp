@@ -0,0 +1,198 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::TrackingMemoryAllocator class
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+
+#include "../../Primitives/interface/MemoryAllocator.h"
+#include "HashUtils.hpp"
+#include "Timer.hpp"
+
+namespace Diligent
+{
+
+/// Memory statistics of a single allocation tag
+struct MemoryTagStats
+{
+    /// Allocation description (dbgDescription argument of IMemoryAllocator::Allocate)
+    std::string Description;
+
+    /// Source file name (dbgFileName argument of IMemoryAllocator::Allocate)
+    std::string FileName;
+
+    /// The number of bytes that are currently allocated
+    Int64 LiveBytes = 0;
+
+    /// The maximum value that LiveBytes has ever reached.
+    /// In a snapshot difference, this is the peak of the later snapshot.
+    Int64 PeakBytes = 0;
+
+    /// The number of allocations that are currently alive
+    Int64 LiveAllocations = 0;
+
+    /// The total number of allocations
+    Uint64 NumAllocations = 0;
+
+    /// The total number of allocated bytes
+    Uint64 AllocatedBytes = 0;
+};
+
+/// Snapshot of the memory statistics collected by the TrackingMemoryAllocator
+struct MemoryStatsSnapshot
+{
+    /// Time, in seconds, elapsed since the allocator was created.
+    /// In a snapshot difference, this is the time between the two snapshots.
+    double Time = 0;
+
+    /// Statistics of every (description, file name) pair
+    std::vector<MemoryTagStats> Tags;
+
+    /// Returns the statistics aggregated over all tags.
+    /// \note  PeakBytes of aggregated statistics is the sum of the peaks of individual tags,
+    ///        which is an upper bound of the actual peak.
+    MemoryTagStats GetTotal() const;
+
+    /// Returns the statistics aggregated by description, sorted by live bytes from highest to lowest.
+    /// FileName members of the returned elements are empty.
+    std::vector<MemoryTagStats> GetByDescription() const;
+
+    /// Returns the statistics aggregated by file name, sorted by live bytes from highest to lowest.
+    /// Description members of the returned elements are empty.
+    std::vector<MemoryTagStats> GetByFileName() const;
+
+    /// Returns the number of allocations per second. Meaningful for snapshot differences.
+    double GetAllocationRate() const
+    {
+        return Time > 0 ? static_cast<double>(GetTotal().NumAllocations) / Time : 0;
+    }
+
+    /// Returns the difference between the After and Before snapshots of the same allocator.
+    static MemoryStatsSnapshot Diff(const MemoryStatsSnapshot& Before, const MemoryStatsSnapshot& After);
+};
+
+/// Memory allocator that forwards all allocations to another allocator and
+/// collects per-tag memory statistics.
+
+/// Every allocation is attributed to the (dbgDescription, dbgFileName) pair passed to Allocate().
+/// A small header that references the tag counters is stored in front of each allocation,
+/// so that Free() does not need a lookup. Tags are looked up in a thread-local cache,
+/// and counters are updated with relaxed atomic operations, so that allocations do
+/// not take any locks after a thread has seen the tag once.
+///
+/// The allocator can be used as EngineCreateInfo::pRawMemAllocator:
+///
+///     TrackingMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+///     EngineCI.pRawMemAllocator = &Allocator;
+///
+/// \remarks    Description and file name strings must stay valid while the allocator is alive,
+///             which is the case for string literals that are normally used.
+class TrackingMemoryAllocator final : public IMemoryAllocator
+{
+public:
+    explicit TrackingMemoryAllocator(IMemoryAllocator& BaseAllocator);
+    ~TrackingMemoryAllocator();
+
+    /// Allocates block of memory
+    virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final;
+
+    /// Releases memory
+    virtual void Free(void* Ptr) override final;
+
+    /// Returns the snapshot of the current memory statistics.
+    MemoryStatsSnapshot GetSnapshot() const;
+
+private:
+    // clang-format off
+    TrackingMemoryAllocator             (const TrackingMemoryAllocator&) = delete;
+    TrackingMemoryAllocator             (TrackingMemoryAllocator&&)      = delete;
+    TrackingMemoryAllocator& operator = (const TrackingMemoryAllocator&) = delete;
+    TrackingMemoryAllocator& operator = (TrackingMemoryAllocator&&)      = delete;
+    // clang-format on
+
+    struct TagCounters
+    {
+        TagCounters(const Char* _Description, const char* _FileName) noexcept :
+            Description{_Description},
+            FileName{_FileName}
+        {}
+
+        const Char* const Description;
+        const char* const FileName;
+
+        std::atomic<Int64>  LiveBytes{0};
+        std::atomic<Int64>  PeakBytes{0};
+        std::atomic<Int64>  LiveAllocations{0};
+        std::atomic<Uint64> NumAllocations{0};
+        std::atomic<Uint64> AllocatedBytes{0};
+    };
+
+    struct TagKey
+    {
+        const void* Description;
+        const void* FileName;
+
+        bool operator==(const TagKey& Rhs) const
+        {
+            return Description == Rhs.Description && FileName == Rhs.FileName;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const TagKey& Key) const
+            {
+                return ComputeHash(Key.Description, Key.FileName);
+            }
+        };
+    };
+
+    TagCounters& GetTagCounters(const Char* Description, const char* FileName);
+
+private:
+    IMemoryAllocator& m_BaseAllocator;
+
+    // Unique identifier that distinguishes entries of different allocators in thread-local caches
+    const Uint64 m_Id;
+
+    Timer m_Timer;
+
+    mutable std::mutex m_TagsMtx;
+
+    // Deque never moves its elements, so the tag counters can be referenced by the allocations
+    std::deque<TagCounters>                                  m_Tags;
+    std::unordered_map<TagKey, TagCounters*, TagKey::Hasher> m_TagMap;
+};
+
+} // namespace Diligent
@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "AdaptiveLock.hpp"
+
+#include <thread>
+
+#if PLATFORM_LINUX || PLATFORM_ANDROID
+#    include <unistd.h>
+#    include <sys/syscall.h>
+#    include <linux/futex.h>
+#    define DILIGENT_ADAPTIVE_LOCK_FUTEX 1
+#elif PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+#    include "../../Platforms/Win32/interface/WinHPreface.h"
+#    include <Windows.h>
+#    include "../../Platforms/Win32/interface/WinHPostface.h"
+#    if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602 // _WIN32_WINNT_WIN8
+#        include <synchapi.h>
+#        ifdef _MSC_VER
+#            pragma comment(lib, "Synchronization.lib")
+#        endif
+#        define DILIGENT_ADAPTIVE_LOCK_WAIT_ON_ADDRESS 1
+#    endif
+#endif
+
+#if defined(_MSC_VER) && ((_M_IX86_FP >= 2) || defined(_M_X64))
+#    include <emmintrin.h>
+#    define PAUSE _mm_pause
+#elif (defined(__clang__) || defined(__GNUC__)) && (defined(__i386__) || defined(__x86_64__))
+#    define PAUSE __builtin_ia32_pause
+#elif (defined(__clang__) || defined(__GNUC__)) && (defined(__arm__) || defined(__aarch64__))
+#    define PAUSE() asm volatile("yield")
+#else
+#    define PAUSE()
+#endif
+
+namespace Threading
+{
+
+void AdaptiveLock::LockContended() noexcept
+{
+    m_NumContendedLocks.fetch_add(1, std::memory_order_relaxed);
+
+    // Spin for a bounded number of iterations first as the critical sections are expected to be short.
+    constexpr size_t NumPauseIterations = 64;
+    constexpr size_t NumYieldIterations = 4;
+    for (size_t Iter = 0; Iter < NumPauseIterations + NumYieldIterations; ++Iter)
+    {
+        auto State = m_State.load(std::memory_order_relaxed);
+        if (State == Unlocked)
+        {
+            if (m_State.compare_exchange_weak(State, Locked, std::memory_order_acquire, std::memory_order_relaxed))
+                return;
+        }
+        else if (State == LockedWithWaiters)
+        {
+            // Other threads are already parked - there is no point in spinning
+            break;
+        }
+
+        if (Iter < NumPauseIterations)
+        {
+            // Issue X86 PAUSE or ARM YIELD instruction to reduce contention
+            // between hyper-threads.
+            PAUSE();
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // Mark the lock as having waiters so that unlock() wakes one of them up.
+    // The lock is acquired if it was released between the exchanges.
+    while (m_State.exchange(LockedWithWaiters, std::memory_order_acquire) != Unlocked)
+    {
+        m_NumParks.fetch_add(1, std::memory_order_relaxed);
+        WaitWhileLockedWithWaiters();
+    }
+}
+
+void AdaptiveLock::WaitWhileLockedWithWaiters() noexcept
+{
+    static_assert(sizeof(m_State) == sizeof(std::uint32_t), "Futex and WaitOnAddress require 32-bit lock state");
+#if DILIGENT_ADAPTIVE_LOCK_FUTEX
+    // The call returns immediately if the state is no longer LockedWithWaiters.
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&m_State), FUTEX_WAIT_PRIVATE, LockedWithWaiters, nullptr, nullptr, 0);
+#elif DILIGENT_ADAPTIVE_LOCK_WAIT_ON_ADDRESS
+    std::uint32_t CompareState = LockedWithWaiters;
+    WaitOnAddress(&m_State, &CompareState, sizeof(CompareState), INFINITE);
+#else
+    std::this_thread::yield();
+#endif
+}
+
+void AdaptiveLock::WakeOne() noexcept
+{
+#if DILIGENT_ADAPTIVE_LOCK_FUTEX
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&m_State), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#elif DILIGENT_ADAPTIVE_LOCK_WAIT_ON_ADDRESS
+    WakeByAddressSingle(&m_State);
+#endif
+}
+
+} // namespace Threading
@@ -27,10 +27,14 @@
 #include "Array2DTools.hpp"
 
 #include <algorithm>
+#include <vector>
 
 #include "Intrinsics.hpp"
+#include "PlatformMisc.hpp"
 #include "DebugUtilities.hpp"
 #include "Align.hpp"
+#include "BasicMath.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -38,6 +42,7 @@ namespace Diligent
 namespace
 {
 
+#if !DILIGENT_SSE2_ENABLED && !DILIGENT_NEON_ENABLED
 void GetArray2DMinMaxValueGeneric(const float* pData,
                                   size_t       StrideInFloats,
                                   Uint32       Width,
@@ -56,27 +61,68 @@ void GetArray2DMinMaxValueGeneric(const float* pData,
         }
     }
 }
+#endif
 
-#if DILIGENT_AVX2_ENABLED
-bool GetArray2DMinMaxValueAVX2(const float* pData,
+#if DILIGENT_SSE2_ENABLED
+void GetArray2DMinMaxValueSSE2(const float* pData,
                                size_t       StrideInFloats,
                                Uint32       Width,
                                Uint32       Height,
                                float&       MinValue,
                                float&       MaxValue)
 {
-    MinValue   = pData[0];
-    MaxValue   = pData[0];
+    auto mMin = _mm_set1_ps(MinValue);
+    auto mMax = _mm_set1_ps(MaxValue);
+    for (size_t row = 0; row < Height; ++row)
+    {
+        const float* pRowStart = pData + row * StrideInFloats;
+        const float* pRowEnd   = pRowStart + Width;
+
+        const float* Ptr = pRowStart;
+        for (; pRowEnd - Ptr >= 4; Ptr += 4)
+        {
+            auto mVal = _mm_loadu_ps(Ptr);
+
+            mMin = _mm_min_ps(mMin, mVal);
+            mMax = _mm_max_ps(mMax, mVal);
+        }
+
+        for (; Ptr < pRowEnd; ++Ptr)
+        {
+            MinValue = std::min(MinValue, *Ptr);
+            MaxValue = std::max(MaxValue, *Ptr);
+        }
+    }
+
+    // |  A  |  B  |  C  |  D  |   =>  |  C  |  D  |  A  |  B  |
+    mMin = _mm_min_ps(mMin, _mm_shuffle_ps(mMin, mMin, _MM_SHUFFLE(1, 0, 3, 2)));
+    mMax = _mm_max_ps(mMax, _mm_shuffle_ps(mMax, mMax, _MM_SHUFFLE(1, 0, 3, 2)));
+    // | min(A, C) | min(B, D) | ... |   =>  | min(B, D) | min(A, C) | ... |
+    mMin = _mm_min_ps(mMin, _mm_shuffle_ps(mMin, mMin, _MM_SHUFFLE(2, 3, 0, 1)));
+    mMax = _mm_max_ps(mMax, _mm_shuffle_ps(mMax, mMax, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    MinValue = std::min(_mm_cvtss_f32(mMin), MinValue);
+    MaxValue = std::max(_mm_cvtss_f32(mMax), MaxValue);
+}
+#endif
+
+#if DILIGENT_AVX2_SUPPORTED
+DILIGENT_TARGET_AVX2 void GetArray2DMinMaxValueAVX2(const float* pData,
+                                                    size_t       StrideInFloats,
+                                                    Uint32       Width,
+                                                    Uint32       Height,
+                                                    float&       MinValue,
+                                                    float&       MaxValue)
+{
     auto mmMin = _mm256_set1_ps(MinValue);
     auto mmMax = _mm256_set1_ps(MaxValue);
     for (size_t row = 0; row < Height; ++row)
     {
         const float* pRowStart = pData + row * StrideInFloats;
         const float* pRowEnd   = pRowStart + Width;
-        const float* pAVXEnd   = pRowEnd - 8;
 
         const float* Ptr = pRowStart;
-        for (; Ptr < pAVXEnd; Ptr += 8)
+        for (; pRowEnd - Ptr >= 8; Ptr += 8)
         {
             // NOTE: MSVC generates vmovups when using _mm256_load_ps regardless,
             //       so no reason to bother with aligning the pointer.
@@ -93,40 +139,88 @@ bool GetArray2DMinMaxValueAVX2(const float* pData,
         }
     }
 
-// Shuffle only works within 128-bit halves
-#    define MAKE_SHUFFLE(i0, i1, i2, i3) ((i0 << 0) | (i1 << 2) | (i2 << 4) | (i3 << 6))
-    constexpr int Shuffle1032 = MAKE_SHUFFLE(1, 0, 3, 2);
-    // |  0  |  1  |  2  |  3  |       |  1  |  0  |  3  |  2  |
-    // |  A  |  B  |  C  |  D  |   =>  |  B  |  A  |  D  |  C  |
-    mmMin = _mm256_min_ps(mmMin, _mm256_permute_ps(mmMin, Shuffle1032));
-    mmMax = _mm256_max_ps(mmMax, _mm256_permute_ps(mmMax, Shuffle1032));
-
-    constexpr int Shuffle2301 = MAKE_SHUFFLE(2, 3, 0, 1);
-    //       0           1           2          3                    2           3           0           1
-    // | max(A, B) | max(A, B) | max(C, D) | max(C, D) |  =>  | max(C, D) | max(C, D) | max(A, B) | max(A, B) |
-    mmMin = _mm256_min_ps(mmMin, _mm256_permute_ps(mmMin, Shuffle2301));
-    mmMax = _mm256_max_ps(mmMax, _mm256_permute_ps(mmMax, Shuffle2301));
-
-    // Note that _mm256_permute_ps is faster than _mm256_permutevar8x32_ps
-    const auto SelectElement4 = _mm256_set1_epi32(4);
-    // We only need to do min/max between elements 4 and 0
-    mmMin = _mm256_min_ps(mmMin, _mm256_permutevar8x32_ps(mmMin, SelectElement4));
-    mmMax = _mm256_max_ps(mmMax, _mm256_permutevar8x32_ps(mmMax, SelectElement4));
-
-    // Extract lower 128 bits
-    auto mMin0123 = _mm256_castps256_ps128(mmMin);
-    auto mMax0123 = _mm256_castps256_ps128(mmMax);
-
-    float Min0, Max0;
-    _mm_store_ss(&Min0, mMin0123);
-    _mm_store_ss(&Max0, mMax0123);
-    MinValue = std::min(Min0, MinValue);
-    MaxValue = std::max(Max0, MaxValue);
-
-    return true;
+    // Combine the upper and the lower 128-bit halves
+    auto mMin = _mm_min_ps(_mm256_castps256_ps128(mmMin), _mm256_extractf128_ps(mmMin, 1));
+    auto mMax = _mm_max_ps(_mm256_castps256_ps128(mmMax), _mm256_extractf128_ps(mmMax, 1));
+
+    mMin = _mm_min_ps(mMin, _mm_shuffle_ps(mMin, mMin, _MM_SHUFFLE(1, 0, 3, 2)));
+    mMax = _mm_max_ps(mMax, _mm_shuffle_ps(mMax, mMax, _MM_SHUFFLE(1, 0, 3, 2)));
+    mMin = _mm_min_ps(mMin, _mm_shuffle_ps(mMin, mMin, _MM_SHUFFLE(2, 3, 0, 1)));
+    mMax = _mm_max_ps(mMax, _mm_shuffle_ps(mMax, mMax, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    MinValue = std::min(_mm_cvtss_f32(mMin), MinValue);
+    MaxValue = std::max(_mm_cvtss_f32(mMax), MaxValue);
+}
+#endif
+
+#if DILIGENT_NEON_ENABLED
+void GetArray2DMinMaxValueNEON(const float* pData,
+                               size_t       StrideInFloats,
+                               Uint32       Width,
+                               Uint32       Height,
+                               float&       MinValue,
+                               float&       MaxValue)
+{
+    auto vMin = vdupq_n_f32(MinValue);
+    auto vMax = vdupq_n_f32(MaxValue);
+    for (size_t row = 0; row < Height; ++row)
+    {
+        const float* pRowStart = pData + row * StrideInFloats;
+        const float* pRowEnd   = pRowStart + Width;
+
+        const float* Ptr = pRowStart;
+        for (; pRowEnd - Ptr >= 4; Ptr += 4)
+        {
+            auto vVal = vld1q_f32(Ptr);
+
+            vMin = vminq_f32(vMin, vVal);
+            vMax = vmaxq_f32(vMax, vVal);
+        }
+
+        for (; Ptr < pRowEnd; ++Ptr)
+        {
+            MinValue = std::min(MinValue, *Ptr);
+            MaxValue = std::max(MaxValue, *Ptr);
+        }
+    }
+
+    // Pairwise operations are available on both ARMv7 and ARMv8
+    auto vMin2 = vpmin_f32(vget_low_f32(vMin), vget_high_f32(vMin));
+    auto vMax2 = vpmax_f32(vget_low_f32(vMax), vget_high_f32(vMax));
+    vMin2      = vpmin_f32(vMin2, vMin2);
+    vMax2      = vpmax_f32(vMax2, vMax2);
+
+    MinValue = std::min(vget_lane_f32(vMin2, 0), MinValue);
+    MaxValue = std::max(vget_lane_f32(vMax2, 0), MaxValue);
 }
 #endif
 
+// Updates MinValue and MaxValue with the values of the array using the best available implementation
+void UpdateArray2DMinMaxValue(const float* pData,
+                              size_t       StrideInFloats,
+                              Uint32       Width,
+                              Uint32       Height,
+                              float&       MinValue,
+                              float&       MaxValue)
+{
+#if DILIGENT_AVX2_SUPPORTED
+    static const bool AVX2Supported = PlatformMisc::CheckCPUFeatures(CPU_FEATURE_FLAG_AVX2);
+    if (AVX2Supported)
+    {
+        GetArray2DMinMaxValueAVX2(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
+        return;
+    }
+#endif
+
+#if DILIGENT_SSE2_ENABLED
+    GetArray2DMinMaxValueSSE2(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
+#elif DILIGENT_NEON_ENABLED
+    GetArray2DMinMaxValueNEON(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
+#else
+    GetArray2DMinMaxValueGeneric(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
+#endif
+}
+
 } // namespace
 
 void GetArray2DMinMaxValue(const float* pData,
@@ -144,12 +238,67 @@ void GetArray2DMinMaxValue(const float* pData,
     DEV_CHECK_ERR(AlignDown(pData, alignof(float)) == pData, "Data pointer is not naturally aligned");
 
     MinValue = MaxValue = pData[0];
-#if DILIGENT_AVX2_ENABLED
-    if (GetArray2DMinMaxValueAVX2(pData, StrideInFloats, Width, Height, MinValue, MaxValue))
+    UpdateArray2DMinMaxValue(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
+}
+
+void GetArray2DMinMaxValue(const float* pData,
+                           size_t       StrideInFloats,
+                           Uint32       Width,
+                           Uint32       Height,
+                           float&       MinValue,
+                           float&       MaxValue,
+                           IThreadPool* pThreadPool,
+                           Uint32       RowsPerTask)
+{
+    if (Width == 0 || Height == 0)
         return;
-#endif
 
-    GetArray2DMinMaxValueGeneric(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
+    if (RowsPerTask == 0)
+    {
+        // Process about 1M values per task
+        RowsPerTask = std::max((1u << 20u) / Width, 1u);
+    }
+
+    const Uint32 NumTasks = (Height + RowsPerTask - 1) / RowsPerTask;
+    if (pThreadPool == nullptr || NumTasks <= 1)
+    {
+        GetArray2DMinMaxValue(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
+        return;
+    }
+
+    DEV_CHECK_ERR(pData != nullptr, "Data pointer must not be null");
+    DEV_CHECK_ERR(StrideInFloats >= Width, "Row stride (", StrideInFloats, ") must be at least ", Width);
+
+    std::vector<float2> TaskMinMax(NumTasks, float2{pData[0], pData[0]});
+
+    auto ProcessRows = [&](Uint32 Task) {
+        const Uint32 FirstRow = Task * RowsPerTask;
+        const Uint32 NumRows  = std::min(RowsPerTask, Height - FirstRow);
+        UpdateArray2DMinMaxValue(pData + FirstRow * StrideInFloats, StrideInFloats, Width, NumRows, TaskMinMax[Task].x, TaskMinMax[Task].y);
+    };
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+    Tasks.reserve(NumTasks - 1);
+    for (Uint32 Task = 1; Task < NumTasks; ++Task)
+    {
+        Tasks.emplace_back(EnqueueAsyncWork(pThreadPool,
+                                            [&ProcessRows, Task](Uint32 ThreadId) {
+                                                ProcessRows(Task);
+                                            }));
+    }
+
+    // The calling thread processes the first rows while the thread pool works on the rest
+    ProcessRows(0);
+    for (auto& pTask : Tasks)
+        pTask->WaitForCompletion();
+
+    MinValue = TaskMinMax[0].x;
+    MaxValue = TaskMinMax[0].y;
+    for (const auto& MinMax : TaskMinMax)
+    {
+        MinValue = std::min(MinValue, MinMax.x);
+        MaxValue = std::max(MaxValue, MinMax.y);
+    }
 }
 
 } // namespace Diligent
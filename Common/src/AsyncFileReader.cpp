@@ -0,0 +1,833 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+#include "AsyncFileReader.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "DataBlobImpl.hpp"
+#include "FileWrapper.hpp"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../Primitives/interface/Errors.hpp"
+
+#if PLATFORM_LINUX
+#    include <cerrno>
+#    include <fcntl.h>
+#    include <unistd.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <sys/syscall.h>
+#    include <sys/uio.h>
+#    include <linux/io_uring.h>
+#    define DILIGENT_ASYNC_FILE_READER_IO_URING 1
+#elif PLATFORM_WIN32
+#    include "../../Platforms/Win32/interface/WinHPreface.h"
+#    include <Windows.h>
+#    include "../../Platforms/Win32/interface/WinHPostface.h"
+#    include "StringTools.hpp"
+#    define DILIGENT_ASYNC_FILE_READER_IOCP 1
+#endif
+
+namespace Diligent
+{
+
+AsyncFileReader::ReadTask::ReadTask(IReferenceCounters* pRefCounters, const ReadRequest& Request, bool ReadInRun) :
+    AsyncTaskBase{pRefCounters, Request.Priority},
+    m_Path{Request.Path != nullptr ? Request.Path : ""},
+    m_Offset{Request.Offset},
+    m_Size{Request.Size},
+    m_ReadInRun{ReadInRun}
+{
+}
+
+IDataBlob* AsyncFileReader::ReadTask::GetData() const
+{
+    return IsSucceeded() ? m_pData.RawPtr<IDataBlob>() : nullptr;
+}
+
+bool AsyncFileReader::ReadTask::PrepareData(Uint64 FileSize)
+{
+    if (m_Offset > FileSize)
+    {
+        LOG_ERROR_MESSAGE("Failed to read file ", m_Path, ": offset ", m_Offset, " exceeds the file size (", FileSize, ")");
+        return false;
+    }
+
+    const Uint64 Size = m_Size != 0 ? m_Size : FileSize - m_Offset;
+    if (Size > FileSize - m_Offset)
+    {
+        LOG_ERROR_MESSAGE("Failed to read file ", m_Path, ": the range [", m_Offset, ", ", m_Offset + Size,
+                          ") exceeds the file size (", FileSize, ")");
+        return false;
+    }
+    if (Size > SIZE_MAX)
+    {
+        LOG_ERROR_MESSAGE("Failed to read file ", m_Path, ": the size of the data (", Size, ") is too large");
+        return false;
+    }
+
+    m_pData = DataBlobImpl::Create(static_cast<size_t>(Size));
+    return true;
+}
+
+void AsyncFileReader::ReadTask::Run(Uint32 ThreadId)
+{
+    if (m_ReadInRun)
+    {
+        if (m_bSafelyCancel.load())
+        {
+            SetStatus(ASYNC_TASK_STATUS_CANCELLED);
+            return;
+        }
+
+        bool        Succeeded = false;
+        FileWrapper File{m_Path.c_str()};
+        if (File && PrepareData(File->GetSize()))
+        {
+            const auto Size = m_pData->GetSize();
+            if (Size == 0)
+            {
+                Succeeded = true;
+            }
+            else if (File->SetPos(static_cast<size_t>(m_Offset), FilePosOrigin::Start) && File->Read(m_pData->GetDataPtr(), Size))
+            {
+                Succeeded = true;
+            }
+            else
+            {
+                LOG_ERROR_MESSAGE("Failed to read file ", m_Path);
+            }
+        }
+        m_Succeeded.store(Succeeded);
+    }
+
+    // With native backends, the task is enqueued after the data has been read
+    SetStatus(ASYNC_TASK_STATUS_COMPLETE);
+}
+
+
+// Base class of the backends that submit reads to the OS and complete them
+// on a dedicated thread.
+class AsyncFileReader::NativeBackend
+{
+public:
+    NativeBackend(IThreadPool* pThreadPool, Uint32 QueueDepth) :
+        m_pThreadPool{pThreadPool},
+        m_QueueDepth{QueueDepth}
+    {}
+
+    virtual ~NativeBackend()
+    {
+        VERIFY(m_NumActive == 0, "There are active reads. The derived class must wait for them in the destructor.");
+    }
+
+    void Submit(RefCntAutoPtr<ReadTask>* ppTasks, Uint32 NumTasks);
+
+    void WaitForIdle()
+    {
+        std::unique_lock<std::mutex> Lock{m_Mtx};
+        m_IdleCV.wait(Lock, [this]() { return m_NumActive == 0; });
+    }
+
+protected:
+    struct PendingRead
+    {
+#if DILIGENT_ASYNC_FILE_READER_IOCP
+        // Must be the first member so that the completion port returns the pointer to the read.
+        OVERLAPPED Overlapped = {};
+        HANDLE     hFile      = INVALID_HANDLE_VALUE;
+#elif DILIGENT_ASYNC_FILE_READER_IO_URING
+        iovec Iov        = {};
+        int   fd         = -1;
+#endif
+        RefCntAutoPtr<ReadTask> pTask;
+
+        Uint8* pData     = nullptr;
+        Uint64 Size      = 0;
+        Uint64 BytesRead = 0;
+    };
+
+    // The maximum number of bytes read by a single OS request.
+    static constexpr Uint64 MaxChunkSize = Uint64{1} << 30;
+
+    // Opens the file and returns its size.
+    virtual bool OpenFile(PendingRead& Read, Uint64& FileSize) = 0;
+
+    virtual void CloseFile(PendingRead& Read) = 0;
+
+    // Starts reading the next chunk of the file. Called with the mutex locked.
+    virtual bool StartRead(PendingRead& Read) = 0;
+
+    // Submits the reads started by StartRead() to the OS. Called with the mutex locked.
+    virtual void CommitReads() {}
+
+    // Starts as many queued reads as the queue depth allows. Must be called with the mutex locked.
+    void FlushQueue();
+
+    // Handles the completion of the read started by StartRead(). Must be called with the mutex locked.
+    // Result is the number of bytes read or a negative error code.
+    void OnReadComplete(PendingRead* pRead, Int64 Result);
+
+    // Puts the read back to the queue after the OS failed to start it. Must be called with the mutex locked.
+    void RetryRead(PendingRead* pRead);
+
+    void FinishRead(PendingRead* pRead, bool Succeeded);
+
+    static Uint32 GetChunkSize(const PendingRead& Read)
+    {
+        return static_cast<Uint32>(std::min(Read.Size - Read.BytesRead, Uint64{MaxChunkSize}));
+    }
+
+protected:
+    IThreadPool* const m_pThreadPool;
+    const Uint32       m_QueueDepth;
+
+    std::mutex m_Mtx;
+
+private:
+    std::condition_variable m_IdleCV;
+
+    // Reads that wait for a free slot in the OS queue.
+    std::deque<PendingRead*> m_Queue;
+
+    // The number of reads that have been started by StartRead() and not yet completed.
+    Uint32 m_NumInFlight = 0;
+
+    // The number of reads that are queued or in flight.
+    size_t m_NumActive = 0;
+};
+
+void AsyncFileReader::NativeBackend::Submit(RefCntAutoPtr<ReadTask>* ppTasks, Uint32 NumTasks)
+{
+    std::vector<PendingRead*> NewReads;
+    NewReads.reserve(NumTasks);
+    for (Uint32 i = 0; i < NumTasks; ++i)
+    {
+        std::unique_ptr<PendingRead> pRead{new PendingRead{}};
+        pRead->pTask = ppTasks[i];
+
+        Uint64 FileSize = 0;
+        if (!OpenFile(*pRead, FileSize))
+        {
+            ppTasks[i]->SetResult(false);
+            m_pThreadPool->EnqueueTask(ppTasks[i]);
+            continue;
+        }
+
+        if (!ppTasks[i]->PrepareData(FileSize) || ppTasks[i]->m_pData->GetSize() == 0)
+        {
+            CloseFile(*pRead);
+            ppTasks[i]->SetResult(ppTasks[i]->m_pData != nullptr);
+            m_pThreadPool->EnqueueTask(ppTasks[i]);
+            continue;
+        }
+
+        pRead->pData = static_cast<Uint8*>(ppTasks[i]->m_pData->GetDataPtr());
+        pRead->Size  = ppTasks[i]->m_pData->GetSize();
+        NewReads.push_back(pRead.release());
+    }
+
+    if (NewReads.empty())
+        return;
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_NumActive += NewReads.size();
+    m_Queue.insert(m_Queue.end(), NewReads.begin(), NewReads.end());
+    FlushQueue();
+}
+
+void AsyncFileReader::NativeBackend::FlushQueue()
+{
+    Uint32 NumStarted = 0;
+    while (!m_Queue.empty() && m_NumInFlight < m_QueueDepth)
+    {
+        PendingRead* pRead = m_Queue.front();
+        m_Queue.pop_front();
+        if (StartRead(*pRead))
+        {
+            ++m_NumInFlight;
+            ++NumStarted;
+        }
+        else
+        {
+            FinishRead(pRead, false);
+        }
+    }
+
+    if (NumStarted > 0)
+        CommitReads();
+}
+
+void AsyncFileReader::NativeBackend::OnReadComplete(PendingRead* pRead, Int64 Result)
+{
+    VERIFY_EXPR(m_NumInFlight > 0);
+    --m_NumInFlight;
+
+    if (Result > 0)
+    {
+        pRead->BytesRead += static_cast<Uint64>(Result);
+        VERIFY_EXPR(pRead->BytesRead <= pRead->Size);
+        if (pRead->BytesRead < pRead->Size)
+        {
+            // Short read: read the remaining data
+            m_Queue.push_front(pRead);
+        }
+        else
+        {
+            FinishRead(pRead, true);
+        }
+    }
+    else
+    {
+        if (Result == 0)
+            LOG_ERROR_MESSAGE("Failed to read file ", pRead->pTask->GetPath(), ": unexpected end of file");
+        else
+            LOG_ERROR_MESSAGE("Failed to read file ", pRead->pTask->GetPath(), ". Error code: ", -Result);
+        FinishRead(pRead, false);
+    }
+}
+
+void AsyncFileReader::NativeBackend::RetryRead(PendingRead* pRead)
+{
+    VERIFY_EXPR(m_NumInFlight > 0);
+    --m_NumInFlight;
+    m_Queue.push_front(pRead);
+}
+
+void AsyncFileReader::NativeBackend::FinishRead(PendingRead* pRead, bool Succeeded)
+{
+    CloseFile(*pRead);
+    pRead->pTask->SetResult(Succeeded);
+    m_pThreadPool->EnqueueTask(pRead->pTask);
+    delete pRead;
+
+    VERIFY_EXPR(m_NumActive > 0);
+    if (--m_NumActive == 0)
+        m_IdleCV.notify_all();
+}
+
+
+#if DILIGENT_ASYNC_FILE_READER_IO_URING
+
+namespace
+{
+
+int IoUringSetup(Uint32 Entries, io_uring_params& Params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, Entries, &Params));
+}
+
+int IoUringEnter(int Fd, Uint32 ToSubmit, Uint32 MinComplete, Uint32 Flags)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, Fd, ToSubmit, MinComplete, Flags, nullptr, 0));
+}
+
+} // namespace
+
+class IoUringBackend final : public AsyncFileReader::NativeBackend
+{
+public:
+    static std::unique_ptr<AsyncFileReader::NativeBackend> Create(IThreadPool* pThreadPool, Uint32 QueueDepth)
+    {
+        std::unique_ptr<IoUringBackend> pBackend{new IoUringBackend{pThreadPool, QueueDepth}};
+        if (!pBackend->Initialize())
+            return nullptr;
+        return std::unique_ptr<AsyncFileReader::NativeBackend>{pBackend.release()};
+    }
+
+    ~IoUringBackend() override
+    {
+        if (m_CompletionThread.joinable())
+        {
+            WaitForIdle();
+
+            {
+                // Wake up the completion thread with a no-op request that has null user data.
+                std::lock_guard<std::mutex> Lock{m_Mtx};
+                io_uring_sqe&               SQE = GetNextSQE();
+                SQE.opcode                      = IORING_OP_NOP;
+                PushSQE();
+                CommitReads();
+            }
+
+            m_CompletionThread.join();
+        }
+
+        if (m_pCQRing != nullptr && m_pCQRing != m_pSQRing)
+            munmap(m_pCQRing, m_CQRingSize);
+        if (m_pSQRing != nullptr)
+            munmap(m_pSQRing, m_SQRingSize);
+        if (m_pSQEs != nullptr)
+            munmap(m_pSQEs, m_SQEsSize);
+        if (m_RingFd >= 0)
+            close(m_RingFd);
+    }
+
+private:
+    IoUringBackend(IThreadPool* pThreadPool, Uint32 QueueDepth) :
+        NativeBackend{pThreadPool, QueueDepth}
+    {}
+
+    bool Initialize();
+
+    io_uring_sqe& GetNextSQE()
+    {
+        // The tail is only modified by this thread while the mutex is locked
+        const Uint32  Index = *m_SQ.pTail & *m_SQ.pMask;
+        io_uring_sqe& SQE   = m_pSQEs[Index];
+        memset(&SQE, 0, sizeof(SQE));
+        m_SQ.pArray[Index] = Index;
+        return SQE;
+    }
+
+    void PushSQE()
+    {
+        __atomic_store_n(m_SQ.pTail, *m_SQ.pTail + 1, __ATOMIC_RELEASE);
+    }
+
+    virtual bool OpenFile(PendingRead& Read, Uint64& FileSize) override final
+    {
+        const auto& Path = Read.pTask->GetPath();
+
+        Read.fd = open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (Read.fd < 0)
+        {
+            LOG_ERROR_MESSAGE("Failed to open file ", Path, ": ", strerror(errno));
+            return false;
+        }
+
+        struct stat Stat = {};
+        if (fstat(Read.fd, &Stat) != 0)
+        {
+            LOG_ERROR_MESSAGE("Failed to get the size of file ", Path, ": ", strerror(errno));
+            CloseFile(Read);
+            return false;
+        }
+        FileSize = static_cast<Uint64>(Stat.st_size);
+        return true;
+    }
+
+    virtual void CloseFile(PendingRead& Read) override final
+    {
+        if (Read.fd >= 0)
+            close(Read.fd);
+        Read.fd = -1;
+    }
+
+    virtual bool StartRead(PendingRead& Read) override final
+    {
+        Read.Iov.iov_base = Read.pData + Read.BytesRead;
+        Read.Iov.iov_len  = GetChunkSize(Read);
+
+        io_uring_sqe& SQE = GetNextSQE();
+        // IORING_OP_READV is available since Linux 5.1, while IORING_OP_READ requires 5.6
+        SQE.opcode    = IORING_OP_READV;
+        SQE.fd        = Read.fd;
+        SQE.off       = Read.pTask->GetOffset() + Read.BytesRead;
+        SQE.addr      = reinterpret_cast<Uint64>(&Read.Iov);
+        SQE.len       = 1;
+        SQE.user_data = reinterpret_cast<Uint64>(&Read);
+        PushSQE();
+        return true;
+    }
+
+    virtual void CommitReads() override final
+    {
+        const Uint32 NumToSubmit = *m_SQ.pTail - __atomic_load_n(m_SQ.pHead, __ATOMIC_ACQUIRE);
+        if (NumToSubmit == 0)
+            return;
+
+        int Res = 0;
+        do
+        {
+            Res = IoUringEnter(m_RingFd, NumToSubmit, 0, 0);
+        } while (Res < 0 && errno == EINTR);
+
+        // The requests that were not consumed stay in the submission queue and
+        // will be submitted by the next call.
+        if (Res < 0 && errno != EAGAIN && errno != EBUSY)
+            LOG_ERROR_MESSAGE("Failed to submit io_uring requests: ", strerror(errno));
+    }
+
+    void ProcessCompletions();
+
+private:
+    int m_RingFd = -1;
+
+    void*         m_pSQRing    = nullptr;
+    void*         m_pCQRing    = nullptr;
+    io_uring_sqe* m_pSQEs      = nullptr;
+    size_t        m_SQRingSize = 0;
+    size_t        m_CQRingSize = 0;
+    size_t        m_SQEsSize   = 0;
+
+    struct
+    {
+        Uint32* pHead  = nullptr;
+        Uint32* pTail  = nullptr;
+        Uint32* pMask  = nullptr;
+        Uint32* pArray = nullptr;
+    } m_SQ;
+
+    struct
+    {
+        Uint32*       pHead = nullptr;
+        Uint32*       pTail = nullptr;
+        Uint32*       pMask = nullptr;
+        io_uring_cqe* pCQEs = nullptr;
+    } m_CQ;
+
+    std::thread m_CompletionThread;
+};
+
+bool IoUringBackend::Initialize()
+{
+    io_uring_params Params = {};
+
+    m_RingFd = IoUringSetup(m_QueueDepth, Params);
+    if (m_RingFd < 0)
+    {
+        // io_uring may be unavailable in older kernels or disabled by the seccomp policy
+        LOG_INFO_MESSAGE("io_uring is not available (", strerror(errno), "). Files will be read by the thread pool.");
+        return false;
+    }
+
+    m_SQRingSize = Params.sq_off.array + Params.sq_entries * sizeof(Uint32);
+    m_CQRingSize = Params.cq_off.cqes + Params.cq_entries * sizeof(io_uring_cqe);
+    if (Params.features & IORING_FEAT_SINGLE_MMAP)
+        m_SQRingSize = m_CQRingSize = std::max(m_SQRingSize, m_CQRingSize);
+
+    void* pSQRing = mmap(nullptr, m_SQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_RingFd, IORING_OFF_SQ_RING);
+    if (pSQRing == MAP_FAILED)
+    {
+        LOG_ERROR_MESSAGE("Failed to map io_uring submission queue: ", strerror(errno));
+        return false;
+    }
+    m_pSQRing = pSQRing;
+
+    if (Params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        m_pCQRing = m_pSQRing;
+    }
+    else
+    {
+        void* pCQRing = mmap(nullptr, m_CQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_RingFd, IORING_OFF_CQ_RING);
+        if (pCQRing == MAP_FAILED)
+        {
+            LOG_ERROR_MESSAGE("Failed to map io_uring completion queue: ", strerror(errno));
+            return false;
+        }
+        m_pCQRing = pCQRing;
+    }
+
+    m_SQEsSize  = Params.sq_entries * sizeof(io_uring_sqe);
+    void* pSQEs = mmap(nullptr, m_SQEsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_RingFd, IORING_OFF_SQES);
+    if (pSQEs == MAP_FAILED)
+    {
+        LOG_ERROR_MESSAGE("Failed to map io_uring submission queue entries: ", strerror(errno));
+        return false;
+    }
+    m_pSQEs = static_cast<io_uring_sqe*>(pSQEs);
+
+    auto* const pSQ = static_cast<Uint8*>(m_pSQRing);
+    m_SQ.pHead      = reinterpret_cast<Uint32*>(pSQ + Params.sq_off.head);
+    m_SQ.pTail      = reinterpret_cast<Uint32*>(pSQ + Params.sq_off.tail);
+    m_SQ.pMask      = reinterpret_cast<Uint32*>(pSQ + Params.sq_off.ring_mask);
+    m_SQ.pArray     = reinterpret_cast<Uint32*>(pSQ + Params.sq_off.array);
+
+    auto* const pCQ = static_cast<Uint8*>(m_pCQRing);
+    m_CQ.pHead      = reinterpret_cast<Uint32*>(pCQ + Params.cq_off.head);
+    m_CQ.pTail      = reinterpret_cast<Uint32*>(pCQ + Params.cq_off.tail);
+    m_CQ.pMask      = reinterpret_cast<Uint32*>(pCQ + Params.cq_off.ring_mask);
+    m_CQ.pCQEs      = reinterpret_cast<io_uring_cqe*>(pCQ + Params.cq_off.cqes);
+
+    // The kernel may round the number of entries up. The completion queue is at least
+    // as large as the submission queue, so limiting the number of reads in flight by
+    // m_QueueDepth guarantees that it never overflows.
+    VERIFY_EXPR(Params.sq_entries >= m_QueueDepth && Params.cq_entries >= Params.sq_entries);
+
+    m_CompletionThread = std::thread{&IoUringBackend::ProcessCompletions, this};
+    return true;
+}
+
+void IoUringBackend::ProcessCompletions()
+{
+    bool Exit = false;
+    while (!Exit)
+    {
+        if (IoUringEnter(m_RingFd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+        {
+            LOG_ERROR_MESSAGE("Failed to wait for io_uring completions: ", strerror(errno));
+            std::this_thread::yield();
+        }
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        // The head is only modified by this thread
+        Uint32       Head = *m_CQ.pHead;
+        const Uint32 Tail = __atomic_load_n(m_CQ.pTail, __ATOMIC_ACQUIRE);
+        for (; Head != Tail; ++Head)
+        {
+            const io_uring_cqe& CQE = m_CQ.pCQEs[Head & *m_CQ.pMask];
+            if (CQE.user_data == 0)
+            {
+                Exit = true;
+                continue;
+            }
+
+            auto* pRead = reinterpret_cast<PendingRead*>(CQE.user_data);
+            if (CQE.res == -EAGAIN || CQE.res == -EINTR)
+                RetryRead(pRead);
+            else
+                OnReadComplete(pRead, CQE.res);
+        }
+        __atomic_store_n(m_CQ.pHead, Head, __ATOMIC_RELEASE);
+
+        FlushQueue();
+    }
+}
+
+#endif // DILIGENT_ASYNC_FILE_READER_IO_URING
+
+
+#if DILIGENT_ASYNC_FILE_READER_IOCP
+
+class IOCPBackend final : public AsyncFileReader::NativeBackend
+{
+public:
+    static std::unique_ptr<AsyncFileReader::NativeBackend> Create(IThreadPool* pThreadPool, Uint32 QueueDepth)
+    {
+        std::unique_ptr<IOCPBackend> pBackend{new IOCPBackend{pThreadPool, QueueDepth}};
+        if (!pBackend->Initialize())
+            return nullptr;
+        return std::unique_ptr<AsyncFileReader::NativeBackend>{pBackend.release()};
+    }
+
+    ~IOCPBackend() override
+    {
+        if (m_CompletionThread.joinable())
+        {
+            WaitForIdle();
+            PostQueuedCompletionStatus(m_hPort, 0, StopKey, nullptr);
+            m_CompletionThread.join();
+        }
+
+        if (m_hPort != nullptr)
+            CloseHandle(m_hPort);
+    }
+
+private:
+    IOCPBackend(IThreadPool* pThreadPool, Uint32 QueueDepth) :
+        NativeBackend{pThreadPool, QueueDepth}
+    {}
+
+    bool Initialize()
+    {
+        m_hPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+        if (m_hPort == nullptr)
+        {
+            LOG_WARNING_MESSAGE("Failed to create I/O completion port. Error code: ", GetLastError(), ". Files will be read by the thread pool.");
+            return false;
+        }
+
+        m_CompletionThread = std::thread{&IOCPBackend::ProcessCompletions, this};
+        return true;
+    }
+
+    virtual bool OpenFile(PendingRead& Read, Uint64& FileSize) override final
+    {
+        const auto& Path  = Read.pTask->GetPath();
+        const auto  PathW = WidenString(Path);
+
+        Read.hFile = CreateFileW(PathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (Read.hFile == INVALID_HANDLE_VALUE)
+        {
+            LOG_ERROR_MESSAGE("Failed to open file ", Path, ". Error code: ", GetLastError());
+            return false;
+        }
+
+        LARGE_INTEGER Size{};
+        if (!GetFileSizeEx(Read.hFile, &Size))
+        {
+            LOG_ERROR_MESSAGE("Failed to get the size of file ", Path, ". Error code: ", GetLastError());
+            CloseFile(Read);
+            return false;
+        }
+        FileSize = static_cast<Uint64>(Size.QuadPart);
+
+        if (CreateIoCompletionPort(Read.hFile, m_hPort, FileKey, 0) == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Failed to associate file ", Path, " with the I/O completion port. Error code: ", GetLastError());
+            CloseFile(Read);
+            return false;
+        }
+
+        return true;
+    }
+
+    virtual void CloseFile(PendingRead& Read) override final
+    {
+        if (Read.hFile != INVALID_HANDLE_VALUE)
+            CloseHandle(Read.hFile);
+        Read.hFile = INVALID_HANDLE_VALUE;
+    }
+
+    virtual bool StartRead(PendingRead& Read) override final
+    {
+        const Uint64 Offset = Read.pTask->GetOffset() + Read.BytesRead;
+
+        Read.Overlapped            = {};
+        Read.Overlapped.Offset     = static_cast<DWORD>(Offset & 0xFFFFFFFFu);
+        Read.Overlapped.OffsetHigh = static_cast<DWORD>(Offset >> 32u);
+        // The completion packet is queued even if the read completes synchronously
+        if (!::ReadFile(Read.hFile, Read.pData + Read.BytesRead, GetChunkSize(Read), nullptr, &Read.Overlapped))
+        {
+            const auto Error = GetLastError();
+            if (Error != ERROR_IO_PENDING)
+            {
+                LOG_ERROR_MESSAGE("Failed to read file ", Read.pTask->GetPath(), ". Error code: ", Error);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void ProcessCompletions()
+    {
+        while (true)
+        {
+            DWORD       NumBytes    = 0;
+            ULONG_PTR   Key         = 0;
+            OVERLAPPED* pOverlapped = nullptr;
+
+            const BOOL  Res   = GetQueuedCompletionStatus(m_hPort, &NumBytes, &Key, &pOverlapped, INFINITE);
+            const DWORD Error = Res ? ERROR_SUCCESS : GetLastError();
+            if (pOverlapped == nullptr)
+            {
+                if (Key != StopKey)
+                    LOG_ERROR_MESSAGE("Failed to wait for I/O completion. Error code: ", Error);
+                break;
+            }
+
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            static_assert(offsetof(PendingRead, Overlapped) == 0, "Overlapped must be the first member of PendingRead");
+            OnReadComplete(reinterpret_cast<PendingRead*>(pOverlapped), Res ? static_cast<Int64>(NumBytes) : -static_cast<Int64>(Error));
+            FlushQueue();
+        }
+    }
+
+private:
+    static constexpr ULONG_PTR FileKey = 1;
+    static constexpr ULONG_PTR StopKey = 2;
+
+    HANDLE m_hPort = nullptr;
+
+    std::thread m_CompletionThread;
+};
+
+#endif // DILIGENT_ASYNC_FILE_READER_IOCP
+
+
+AsyncFileReader::AsyncFileReader(const CreateInfo& CI) noexcept(false) :
+    m_pThreadPool{CI.pThreadPool}
+{
+    if (CI.pThreadPool == nullptr)
+        LOG_ERROR_AND_THROW("Thread pool must not be null");
+    if (CI.QueueDepth == 0)
+        LOG_ERROR_AND_THROW("Queue depth must not be zero");
+
+    if (!CI.ForceThreadPool)
+    {
+#if DILIGENT_ASYNC_FILE_READER_IO_URING
+        m_pNativeBackend = IoUringBackend::Create(CI.pThreadPool, CI.QueueDepth);
+        if (m_pNativeBackend)
+            m_Backend = BACKEND_IO_URING;
+#elif DILIGENT_ASYNC_FILE_READER_IOCP
+        m_pNativeBackend = IOCPBackend::Create(CI.pThreadPool, CI.QueueDepth);
+        if (m_pNativeBackend)
+            m_Backend = BACKEND_IOCP;
+#endif
+    }
+}
+
+AsyncFileReader::~AsyncFileReader()
+{
+    // The backend destructor waits for all reads to complete
+    m_pNativeBackend.reset();
+}
+
+RefCntAutoPtr<AsyncFileReader::ReadTask> AsyncFileReader::Read(const ReadRequest& Request)
+{
+    RefCntAutoPtr<ReadTask> pTask;
+    Read(&Request, 1, std::addressof(pTask));
+    return pTask;
+}
+
+void AsyncFileReader::Read(const ReadRequest*       pRequests,
+                           Uint32                   NumRequests,
+                           RefCntAutoPtr<ReadTask>* ppTasks)
+{
+    if (NumRequests == 0)
+        return;
+
+    DEV_CHECK_ERR(pRequests != nullptr, "pRequests must not be null");
+    DEV_CHECK_ERR(ppTasks != nullptr, "ppTasks must not be null");
+
+    const bool ReadInRun = !m_pNativeBackend;
+    for (Uint32 i = 0; i < NumRequests; ++i)
+    {
+        DEV_CHECK_ERR(pRequests[i].Path != nullptr, "Path of request ", i, " is null");
+        ppTasks[i] = RefCntAutoPtr<ReadTask>{MakeNewRCObj<ReadTask>()(pRequests[i], ReadInRun)};
+    }
+
+    if (m_pNativeBackend)
+    {
+        m_pNativeBackend->Submit(ppTasks, NumRequests);
+    }
+    else
+    {
+        for (Uint32 i = 0; i < NumRequests; ++i)
+            m_pThreadPool->EnqueueTask(ppTasks[i]);
+    }
+}
+
+void AsyncFileReader::WaitForIdle()
+{
+    if (m_pNativeBackend)
+        m_pNativeBackend->WaitForIdle();
+}
+
+} // namespace Diligent
@@ -0,0 +1,131 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+#include "BufferedFileStream.hpp"
+
+#include <cstring>
+
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+RefCntAutoPtr<BufferedFileStream> BufferedFileStream::Create(const Char*     Path,
+                                                             EFileAccessMode Access,
+                                                             size_t          BufferSize)
+{
+    return RefCntAutoPtr<BufferedFileStream>{MakeNewRCObj<BufferedFileStream>()(Path, Access, BufferSize)};
+}
+
+BufferedFileStream::BufferedFileStream(IReferenceCounters* pRefCounters,
+                                       const Char*         Path,
+                                       EFileAccessMode     Access /* = EFileAccessMode::Overwrite*/,
+                                       size_t              BufferSize /* = DefaultBufferSize*/) :
+    TBase{pRefCounters},
+    m_FileWrpr{Path, Access},
+    m_BufferSize{BufferSize}
+{
+}
+
+BufferedFileStream::~BufferedFileStream()
+{
+    if (!Flush())
+        LOG_ERROR_MESSAGE("Failed to flush buffered data to file ", (m_FileWrpr ? m_FileWrpr->GetPath().c_str() : ""));
+}
+
+IMPLEMENT_QUERY_INTERFACE(BufferedFileStream, IID_FileStream, TBase)
+
+bool BufferedFileStream::Flush()
+{
+    if (m_BufferedSize == 0)
+        return true;
+
+    const auto Size = m_BufferedSize;
+    m_BufferedSize  = 0;
+    return m_FileWrpr && m_FileWrpr->Write(m_pBuffer, Size);
+}
+
+bool BufferedFileStream::Read(void* Data, size_t Size)
+{
+    if (!m_FileWrpr || !Flush())
+        return false;
+
+    return m_FileWrpr->Read(Data, Size);
+}
+
+void BufferedFileStream::ReadBlob(IDataBlob* pData)
+{
+    if (!m_FileWrpr || !Flush())
+        return;
+
+    m_FileWrpr->Read(pData);
+}
+
+bool BufferedFileStream::Write(const void* Data, size_t Size)
+{
+    if (!m_FileWrpr)
+        return false;
+
+    if (m_BufferedSize + Size <= m_BufferSize)
+    {
+        if (m_pBuffer == nullptr)
+        {
+            m_BufferStorage.resize(m_BufferSize + BufferAlignment - 1);
+            m_pBuffer = AlignUp(m_BufferStorage.data(), BufferAlignment);
+        }
+        std::memcpy(m_pBuffer + m_BufferedSize, Data, Size);
+        m_BufferedSize += Size;
+        return true;
+    }
+
+    // The data does not fit into the buffer: write the buffered data
+    // and the new data with one call, without copying the new data.
+    const FileWriteRange Ranges[] = {
+        {m_pBuffer, m_BufferedSize},
+        {Data, Size},
+    };
+    m_BufferedSize = 0;
+    return m_FileWrpr->Write(Ranges, _countof(Ranges));
+}
+
+bool BufferedFileStream::IsValid()
+{
+    return !!m_FileWrpr;
+}
+
+size_t BufferedFileStream::GetSize()
+{
+    if (!m_FileWrpr)
+        return 0;
+
+    Flush();
+    return m_FileWrpr->GetSize();
+}
+
+} // namespace Diligent
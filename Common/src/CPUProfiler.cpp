@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+#include "CPUProfiler.hpp"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Timer.hpp"
+
+namespace Diligent
+{
+
+std::atomic<const CPUProfilerSink*> CPUProfiler::sm_pSink{nullptr};
+
+void CPUProfiler::SetSink(const CPUProfilerSink& Sink)
+{
+    // Sinks are never released as the scopes that are in progress may still reference them.
+    static std::mutex                                    Mtx;
+    static std::vector<std::unique_ptr<CPUProfilerSink>> Sinks;
+
+    const CPUProfilerSink* pSink = nullptr;
+    if (Sink.BeginScope != nullptr || Sink.EndScope != nullptr)
+    {
+        std::lock_guard<std::mutex> Lock{Mtx};
+        Sinks.emplace_back(new CPUProfilerSink{Sink});
+        pSink = Sinks.back().get();
+    }
+    sm_pSink.store(pSink, std::memory_order_release);
+}
+
+void CPUProfiler::Scope::Begin(const Char* Name) noexcept
+{
+    const auto* pSink = sm_pSink.load(std::memory_order_acquire);
+    if (pSink == nullptr)
+        return;
+
+    m_pSink = pSink;
+    m_Name  = Name;
+    if (pSink->BeginScope != nullptr)
+        pSink->BeginScope(Name, GetCPUTimestamp(), pSink->pUserData);
+}
+
+void CPUProfiler::Scope::End() noexcept
+{
+    if (m_pSink->EndScope != nullptr)
+        m_pSink->EndScope(m_Name, GetCPUTimestamp(), m_pSink->pUserData);
+}
+
+} // namespace Diligent
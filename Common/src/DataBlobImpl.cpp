@@ -28,11 +28,141 @@
 #include "pch.h"
 #include "DataBlobImpl.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "Align.hpp"
+#include "PlatformMisc.hpp"
+#include "SpinLock.hpp"
 
 namespace Diligent
 {
 
+namespace
+{
+
+// Recycles heap buffers of data blobs. Buffer capacities are rounded up to
+// power-of-two size classes, so that buffers of blobs with similar sizes can be reused.
+class DataBlobBufferPool
+{
+public:
+    static constexpr Uint32 MinClassSizeLog2 = 7;  // 128 bytes
+    static constexpr Uint32 MaxClassSizeLog2 = 20; // 1 MB
+    static constexpr Uint32 NumClasses       = MaxClassSizeLog2 - MinClassSizeLog2 + 1;
+
+    // The pool keeps at most this many bytes of free buffers per size class
+    static constexpr size_t MaxPooledBytesPerClass = size_t{2} << 20;
+    // ... but no more than this many buffers
+    static constexpr size_t MaxPooledBuffersPerClass = 64;
+
+    DataBlobBufferPool()
+    {
+        for (auto& Class : m_Classes)
+            Class.FreeBuffers.reserve(MaxPooledBuffersPerClass);
+    }
+
+    ~DataBlobBufferPool()
+    {
+        // Blobs may outlive the pool if they are released during static destruction
+        sm_IsDestroyed = true;
+        for (auto& Class : m_Classes)
+        {
+            for (auto* pBuffer : Class.FreeBuffers)
+                delete[] pBuffer;
+        }
+    }
+
+    static DataBlobBufferPool* Get()
+    {
+        static DataBlobBufferPool Pool;
+        return !sm_IsDestroyed ? &Pool : nullptr;
+    }
+
+    // Returns the actual capacity of the buffer allocated for the requested size
+    static size_t GetCapacity(size_t Size)
+    {
+        VERIFY_EXPR(Size > 0);
+        if (Size > (size_t{1} << MaxClassSizeLog2))
+            return Size;
+
+        const auto SizeLog2 = Size > 1 ? PlatformMisc::GetMSB(Uint64{Size} - 1) + 1 : 0;
+        return size_t{1} << std::max(SizeLog2, Uint32{MinClassSizeLog2});
+    }
+
+    Uint8* Allocate(size_t Capacity)
+    {
+        if (auto* pClass = GetSizeClass(Capacity))
+        {
+            Threading::SpinLockGuard Guard{pClass->Lock};
+            if (!pClass->FreeBuffers.empty())
+            {
+                auto* pBuffer = pClass->FreeBuffers.back();
+                pClass->FreeBuffers.pop_back();
+                return pBuffer;
+            }
+        }
+        return new Uint8[Capacity];
+    }
+
+    void Free(Uint8* pBuffer, size_t Capacity)
+    {
+        if (auto* pClass = GetSizeClass(Capacity))
+        {
+            const auto MaxBuffers = std::min(std::max(MaxPooledBytesPerClass / Capacity, size_t{1}), size_t{MaxPooledBuffersPerClass});
+
+            Threading::SpinLockGuard Guard{pClass->Lock};
+            if (pClass->FreeBuffers.size() < MaxBuffers)
+            {
+                pClass->FreeBuffers.push_back(pBuffer);
+                return;
+            }
+        }
+        delete[] pBuffer;
+    }
+
+private:
+    struct SizeClass
+    {
+        Threading::SpinLock Lock;
+        std::vector<Uint8*> FreeBuffers;
+    };
+
+    SizeClass* GetSizeClass(size_t Capacity)
+    {
+        if (Capacity > (size_t{1} << MaxClassSizeLog2))
+            return nullptr;
+
+        VERIFY_EXPR(IsPowerOfTwo(Capacity) && Capacity >= (size_t{1} << MinClassSizeLog2));
+        return &m_Classes[PlatformMisc::GetLSB(Uint64{Capacity}) - MinClassSizeLog2];
+    }
+
+private:
+    std::array<SizeClass, NumClasses> m_Classes;
+
+    static bool sm_IsDestroyed;
+};
+
+bool DataBlobBufferPool::sm_IsDestroyed = false;
+
+Uint8* AllocateBlobBuffer(size_t Capacity)
+{
+    auto* pPool = DataBlobBufferPool::Get();
+    return pPool != nullptr ? pPool->Allocate(Capacity) : new Uint8[Capacity];
+}
+
+void FreeBlobBuffer(Uint8* pBuffer, size_t Capacity)
+{
+    if (auto* pPool = DataBlobBufferPool::Get())
+        pPool->Free(pBuffer, Capacity);
+    else
+        delete[] pBuffer;
+}
+
+} // namespace
+
 RefCntAutoPtr<DataBlobImpl> DataBlobImpl::Create(size_t InitialSize, const void* pData)
 {
     return RefCntAutoPtr<DataBlobImpl>{MakeNewRCObj<DataBlobImpl>()(InitialSize, pData)};
@@ -48,39 +178,71 @@ RefCntAutoPtr<DataBlobImpl> DataBlobImpl::MakeCopy(const IDataBlob* pDataBlob)
 
 DataBlobImpl::DataBlobImpl(IReferenceCounters* pRefCounters, size_t InitialSize, const void* pData) :
     TBase{pRefCounters},
-    m_DataBuff(InitialSize)
+    m_pData{reinterpret_cast<Uint8*>(m_InlineStorage)},
+    m_Size{InitialSize}
 {
-    if (!m_DataBuff.empty() && pData != nullptr)
+    if (InitialSize > InlineCapacity)
     {
-        std::memcpy(m_DataBuff.data(), pData, InitialSize);
+        m_Capacity = DataBlobBufferPool::GetCapacity(InitialSize);
+        m_pData    = AllocateBlobBuffer(m_Capacity);
+    }
+
+    if (InitialSize > 0)
+    {
+        if (pData != nullptr)
+            std::memcpy(m_pData, pData, InitialSize);
+        else
+            std::memset(m_pData, 0, InitialSize);
     }
 }
 
 DataBlobImpl::~DataBlobImpl()
-{}
+{
+    if (!IsInline())
+        FreeBlobBuffer(m_pData, m_Capacity);
+}
 
 /// Sets the size of the internal data buffer
 void DataBlobImpl::Resize(size_t NewSize)
 {
-    m_DataBuff.resize(NewSize);
+    if (NewSize > m_Capacity)
+    {
+        // Grow geometrically to keep repeated resizing linear
+        const auto NewCapacity = DataBlobBufferPool::GetCapacity(std::max(NewSize, m_Capacity + m_Capacity / 2));
+
+        auto* pNewData = AllocateBlobBuffer(NewCapacity);
+        if (m_Size > 0)
+            std::memcpy(pNewData, m_pData, m_Size);
+        if (!IsInline())
+            FreeBlobBuffer(m_pData, m_Capacity);
+
+        m_pData    = pNewData;
+        m_Capacity = NewCapacity;
+    }
+
+    // Zero-initialize new bytes
+    if (NewSize > m_Size)
+        std::memset(m_pData + m_Size, 0, NewSize - m_Size);
+
+    m_Size = NewSize;
 }
 
 /// Returns the size of the internal data buffer
 size_t DataBlobImpl::GetSize() const
 {
-    return m_DataBuff.size();
+    return m_Size;
 }
 
 /// Returns the pointer to the internal data buffer
 void* DataBlobImpl::GetDataPtr()
 {
-    return m_DataBuff.data();
+    return m_pData;
 }
 
 /// Returns const pointer to the internal data buffer
 const void* DataBlobImpl::GetConstDataPtr() const
 {
-    return m_DataBuff.data();
+    return m_pData;
 }
 
 IMPLEMENT_QUERY_INTERFACE(DataBlobImpl, IID_DataBlob, TBase)
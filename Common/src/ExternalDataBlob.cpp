@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "ExternalDataBlob.hpp"
+
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+RefCntAutoPtr<ExternalDataBlob> ExternalDataBlob::Create(void* pData, size_t Size, ReleaseCallbackType ReleaseCallback)
+{
+    return RefCntAutoPtr<ExternalDataBlob>{MakeNewRCObj<ExternalDataBlob>()(pData, Size, std::move(ReleaseCallback))};
+}
+
+ExternalDataBlob::ExternalDataBlob(IReferenceCounters* pRefCounters, void* pData, size_t Size, ReleaseCallbackType&& ReleaseCallback) :
+    TBase{pRefCounters},
+    m_pData{pData},
+    m_Size{Size},
+    m_ReleaseCallback{std::move(ReleaseCallback)}
+{
+    VERIFY(m_pData != nullptr || m_Size == 0, "Data pointer must not be null when size is not zero");
+}
+
+ExternalDataBlob::~ExternalDataBlob()
+{
+    if (m_ReleaseCallback)
+        m_ReleaseCallback();
+}
+
+void ExternalDataBlob::Resize(size_t NewSize)
+{
+    DEV_CHECK_ERR(NewSize == m_Size, "External data blob can't be resized");
+}
+
+size_t ExternalDataBlob::GetSize() const
+{
+    return m_Size;
+}
+
+void* ExternalDataBlob::GetDataPtr()
+{
+    return m_pData;
+}
+
+const void* ExternalDataBlob::GetConstDataPtr() const
+{
+    return m_pData;
+}
+
+} // namespace Diligent
@@ -0,0 +1,508 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+#include "FileWatcher.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <sys/stat.h>
+
+#include "FileSystem.hpp"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../Primitives/interface/Errors.hpp"
+
+#if PLATFORM_LINUX || PLATFORM_ANDROID
+#    include <cerrno>
+#    include <unistd.h>
+#    include <sys/inotify.h>
+#    define DILIGENT_FILE_WATCHER_INOTIFY 1
+#elif PLATFORM_WIN32
+#    include "../../Platforms/Win32/interface/WinHPreface.h"
+#    include <Windows.h>
+#    include "../../Platforms/Win32/interface/WinHPostface.h"
+#    include "StringTools.hpp"
+#    define DILIGENT_FILE_WATCHER_READ_DIRECTORY_CHANGES 1
+#endif
+
+namespace Diligent
+{
+
+class FileWatcher::NativeBackend
+{
+public:
+    virtual ~NativeBackend() {}
+
+    virtual bool AddDirectory(const std::string& Path, bool Recursive) = 0;
+
+    virtual void CollectChanges(std::unordered_set<std::string>& ChangedFiles) = 0;
+};
+
+namespace
+{
+
+std::string MakeChildPath(const std::string& Dir, const Char* Name)
+{
+    std::string Path{Dir};
+    if (!Path.empty() && !FileSystem::IsSlash(Path.back()))
+        Path += FileSystem::SlashSymbol;
+    Path += Name;
+    return Path;
+}
+
+// Calls Handler(Path, IsDirectory) for every entry of the directory.
+// If Recursive is true, subdirectories are processed after the handler is called for them.
+template <typename HandlerType>
+void EnumerateDirectory(const std::string& Dir, bool Recursive, HandlerType&& Handler)
+{
+    const auto Entries = FileSystem::Search(MakeChildPath(Dir, "*").c_str());
+    for (const auto& pEntry : Entries)
+    {
+        const auto* Name = pEntry->Name();
+        if (strcmp(Name, ".") == 0 || strcmp(Name, "..") == 0)
+            continue;
+
+        const auto Path = MakeChildPath(Dir, Name);
+        Handler(Path, pEntry->IsDirectory());
+        if (Recursive && pEntry->IsDirectory())
+            EnumerateDirectory(Path, Recursive, Handler);
+    }
+}
+
+
+class PollingBackend final : public FileWatcher::NativeBackend
+{
+public:
+    explicit PollingBackend(Uint32 PollingInterval) :
+        m_PollingInterval{PollingInterval}
+    {}
+
+    virtual bool AddDirectory(const std::string& Path, bool Recursive) override final
+    {
+        m_Directories.push_back({Path, Recursive});
+        ScanDirectory(m_Directories.back(), m_Files);
+        return true;
+    }
+
+    virtual void CollectChanges(std::unordered_set<std::string>& ChangedFiles) override final
+    {
+        const auto CurrTime = std::chrono::steady_clock::now();
+        if (CurrTime - m_LastScanTime < std::chrono::milliseconds{m_PollingInterval})
+            return;
+        m_LastScanTime = CurrTime;
+
+        std::unordered_map<std::string, FileState> Files;
+        Files.reserve(m_Files.size());
+        for (const auto& Dir : m_Directories)
+            ScanDirectory(Dir, Files);
+
+        for (const auto& it : Files)
+        {
+            auto prev_it = m_Files.find(it.first);
+            if (prev_it == m_Files.end() || prev_it->second != it.second)
+                ChangedFiles.insert(it.first);
+        }
+        for (const auto& it : m_Files)
+        {
+            if (Files.find(it.first) == Files.end())
+                ChangedFiles.insert(it.first);
+        }
+
+        m_Files = std::move(Files);
+    }
+
+private:
+    struct DirectoryInfo
+    {
+        std::string Path;
+        bool        Recursive = false;
+    };
+
+    struct FileState
+    {
+        Int64  ModificationTime = 0;
+        Uint64 Size             = 0;
+
+        bool operator!=(const FileState& RHS) const
+        {
+            return ModificationTime != RHS.ModificationTime || Size != RHS.Size;
+        }
+    };
+
+    static void ScanDirectory(const DirectoryInfo& Dir, std::unordered_map<std::string, FileState>& Files)
+    {
+        EnumerateDirectory(Dir.Path, Dir.Recursive,
+                           [&Files](const std::string& Path, bool IsDirectory) {
+                               if (IsDirectory)
+                                   return;
+
+#ifdef _MSC_VER
+                               struct _stat64 Stat = {};
+                               if (_stat64(Path.c_str(), &Stat) != 0)
+                                   return;
+#else
+                struct stat Stat = {};
+                if (stat(Path.c_str(), &Stat) != 0)
+                    return;
+#endif
+                               Files[Path] = FileState{static_cast<Int64>(Stat.st_mtime), static_cast<Uint64>(Stat.st_size)};
+                           });
+    }
+
+private:
+    const Uint32 m_PollingInterval;
+
+    std::vector<DirectoryInfo>                 m_Directories;
+    std::unordered_map<std::string, FileState> m_Files;
+
+    std::chrono::steady_clock::time_point m_LastScanTime = std::chrono::steady_clock::now();
+};
+
+
+#if DILIGENT_FILE_WATCHER_INOTIFY
+
+class InotifyBackend final : public FileWatcher::NativeBackend
+{
+public:
+    static std::unique_ptr<FileWatcher::NativeBackend> Create()
+    {
+        const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd < 0)
+        {
+            LOG_WARNING_MESSAGE("Failed to initialize inotify: ", strerror(errno), ". Directories will be scanned periodically.");
+            return nullptr;
+        }
+        return std::unique_ptr<FileWatcher::NativeBackend>{new InotifyBackend{fd}};
+    }
+
+    ~InotifyBackend() override
+    {
+        close(m_fd);
+    }
+
+    virtual bool AddDirectory(const std::string& Path, bool Recursive) override final
+    {
+        if (!AddWatch(Path, Recursive))
+            return false;
+
+        if (Recursive)
+        {
+            EnumerateDirectory(Path, /*Recursive = */ false,
+                               [&](const std::string& SubdirPath, bool IsDirectory) {
+                                   if (IsDirectory)
+                                       AddDirectory(SubdirPath, Recursive);
+                               });
+        }
+        return true;
+    }
+
+    virtual void CollectChanges(std::unordered_set<std::string>& ChangedFiles) override final
+    {
+        alignas(inotify_event) char Buffer[4096];
+        while (true)
+        {
+            const auto BytesRead = read(m_fd, Buffer, sizeof(Buffer));
+            if (BytesRead <= 0)
+            {
+                if (BytesRead < 0 && errno == EINTR)
+                    continue;
+                // EAGAIN: no more events
+                break;
+            }
+
+            for (const char* pEvent = Buffer; pEvent < Buffer + BytesRead;)
+            {
+                const auto& Event = *reinterpret_cast<const inotify_event*>(pEvent);
+                ProcessEvent(Event, ChangedFiles);
+                pEvent += sizeof(inotify_event) + Event.len;
+            }
+        }
+    }
+
+private:
+    explicit InotifyBackend(int fd) :
+        m_fd{fd}
+    {}
+
+    bool AddWatch(const std::string& Path, bool Recursive)
+    {
+        constexpr uint32_t Mask =
+            IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+        const int wd = inotify_add_watch(m_fd, Path.c_str(), Mask);
+        if (wd < 0)
+        {
+            LOG_ERROR_MESSAGE("Failed to watch directory ", Path, ": ", strerror(errno));
+            return false;
+        }
+        m_Watches[wd] = {Path, Recursive};
+        return true;
+    }
+
+    void ProcessEvent(const inotify_event& Event, std::unordered_set<std::string>& ChangedFiles)
+    {
+        if (Event.mask & IN_Q_OVERFLOW)
+        {
+            LOG_WARNING_MESSAGE("inotify event queue overflowed. Some file changes may have been lost.");
+            return;
+        }
+
+        auto it = m_Watches.find(Event.wd);
+        if (it == m_Watches.end())
+            return;
+
+        if (Event.mask & IN_IGNORED)
+        {
+            // The directory was removed or unmounted
+            m_Watches.erase(it);
+            return;
+        }
+
+        if (Event.len == 0)
+            return;
+
+        const auto  Path      = MakeChildPath(it->second.Path, Event.name);
+        const auto& Recursive = it->second.Recursive;
+        if ((Event.mask & IN_ISDIR) == 0)
+        {
+            ChangedFiles.insert(Path);
+        }
+        else if (Recursive && (Event.mask & (IN_CREATE | IN_MOVED_TO)) != 0)
+        {
+            // Files could have been added to the new directory before the watch was
+            // created, so report all of them.
+            if (AddDirectory(Path, /*Recursive = */ true))
+            {
+                EnumerateDirectory(Path, /*Recursive = */ true,
+                                   [&ChangedFiles](const std::string& FilePath, bool IsDirectory) {
+                                       if (!IsDirectory)
+                                           ChangedFiles.insert(FilePath);
+                                   });
+            }
+        }
+    }
+
+private:
+    const int m_fd;
+
+    struct WatchInfo
+    {
+        std::string Path;
+        bool        Recursive = false;
+    };
+    std::unordered_map<int, WatchInfo> m_Watches;
+};
+
+#endif // DILIGENT_FILE_WATCHER_INOTIFY
+
+
+#if DILIGENT_FILE_WATCHER_READ_DIRECTORY_CHANGES
+
+class ReadDirectoryChangesBackend final : public FileWatcher::NativeBackend
+{
+public:
+    ~ReadDirectoryChangesBackend() override
+    {
+        for (auto& pDir : m_Directories)
+        {
+            if (pDir->IsPending)
+            {
+                CancelIoEx(pDir->hDirectory, &pDir->Overlapped);
+                DWORD BytesTransferred = 0;
+                GetOverlappedResult(pDir->hDirectory, &pDir->Overlapped, &BytesTransferred, TRUE);
+            }
+            CloseHandle(pDir->hDirectory);
+            CloseHandle(pDir->Overlapped.hEvent);
+        }
+    }
+
+    virtual bool AddDirectory(const std::string& Path, bool Recursive) override final
+    {
+        const auto PathW = WidenString(Path);
+
+        HANDLE hDirectory = CreateFileW(PathW.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                        nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        if (hDirectory == INVALID_HANDLE_VALUE)
+        {
+            LOG_ERROR_MESSAGE("Failed to open directory ", Path, ". Error code: ", GetLastError());
+            return false;
+        }
+
+        std::unique_ptr<DirectoryInfo> pDir{new DirectoryInfo{}};
+        pDir->Path              = Path;
+        pDir->Recursive         = Recursive;
+        pDir->hDirectory        = hDirectory;
+        pDir->Overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (pDir->Overlapped.hEvent == nullptr || !IssueRead(*pDir))
+        {
+            LOG_ERROR_MESSAGE("Failed to watch directory ", Path, ". Error code: ", GetLastError());
+            if (pDir->Overlapped.hEvent != nullptr)
+                CloseHandle(pDir->Overlapped.hEvent);
+            CloseHandle(hDirectory);
+            return false;
+        }
+
+        m_Directories.emplace_back(std::move(pDir));
+        return true;
+    }
+
+    virtual void CollectChanges(std::unordered_set<std::string>& ChangedFiles) override final
+    {
+        for (auto& pDir : m_Directories)
+        {
+            auto& Dir = *pDir;
+            if (!Dir.IsPending)
+            {
+                // The previous read failed; try again
+                IssueRead(Dir);
+                continue;
+            }
+
+            DWORD BytesTransferred = 0;
+            if (!GetOverlappedResult(Dir.hDirectory, &Dir.Overlapped, &BytesTransferred, FALSE))
+            {
+                if (GetLastError() == ERROR_IO_INCOMPLETE)
+                    continue;
+                BytesTransferred = 0;
+            }
+            Dir.IsPending = false;
+
+            if (BytesTransferred == 0)
+            {
+                LOG_WARNING_MESSAGE("Change notification buffer of directory ", Dir.Path, " overflowed. Some file changes may have been lost.");
+            }
+            else
+            {
+                for (const auto* pData = Dir.Buffer.data();;)
+                {
+                    const auto& Info = *reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(pData);
+
+                    const auto Name = NarrowString(Info.FileName, Info.FileNameLength / sizeof(WCHAR));
+                    ChangedFiles.insert(MakeChildPath(Dir.Path, Name.c_str()));
+
+                    if (Info.NextEntryOffset == 0)
+                        break;
+                    pData += Info.NextEntryOffset;
+                }
+            }
+
+            IssueRead(Dir);
+        }
+    }
+
+private:
+    struct DirectoryInfo
+    {
+        std::string Path;
+        bool        Recursive  = false;
+        bool        IsPending  = false;
+        HANDLE      hDirectory = INVALID_HANDLE_VALUE;
+        OVERLAPPED  Overlapped = {};
+
+        // FILE_NOTIFY_INFORMATION entries are DWORD-aligned
+        std::vector<DWORD> Buffer = std::vector<DWORD>(16384);
+    };
+
+    static bool IssueRead(DirectoryInfo& Dir)
+    {
+        constexpr DWORD NotifyFilter =
+            FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_CREATION;
+
+        ResetEvent(Dir.Overlapped.hEvent);
+        Dir.IsPending = ReadDirectoryChangesW(Dir.hDirectory, Dir.Buffer.data(), static_cast<DWORD>(Dir.Buffer.size() * sizeof(DWORD)),
+                                              Dir.Recursive ? TRUE : FALSE, NotifyFilter, nullptr, &Dir.Overlapped, nullptr) != FALSE;
+        return Dir.IsPending;
+    }
+
+private:
+    // Directory info objects are not moved as the OS writes to their buffers and overlapped structures
+    std::vector<std::unique_ptr<DirectoryInfo>> m_Directories;
+};
+
+#endif // DILIGENT_FILE_WATCHER_READ_DIRECTORY_CHANGES
+
+} // namespace
+
+
+FileWatcher::FileWatcher(const CreateInfo& CI) noexcept(false)
+{
+    if (!CI.ForcePolling)
+    {
+#if DILIGENT_FILE_WATCHER_INOTIFY
+        m_pBackend = InotifyBackend::Create();
+        if (m_pBackend)
+            m_Backend = BACKEND_INOTIFY;
+#elif DILIGENT_FILE_WATCHER_READ_DIRECTORY_CHANGES
+        m_pBackend.reset(new ReadDirectoryChangesBackend{});
+        m_Backend = BACKEND_READ_DIRECTORY_CHANGES;
+#endif
+    }
+
+    if (!m_pBackend)
+    {
+        m_pBackend.reset(new PollingBackend{CI.PollingInterval});
+        m_Backend = BACKEND_POLLING;
+    }
+}
+
+FileWatcher::~FileWatcher()
+{
+}
+
+bool FileWatcher::AddDirectory(const Char* Path, bool Recursive)
+{
+    DEV_CHECK_ERR(Path != nullptr && Path[0] != '\0', "Path must not be null or empty");
+    if (Path == nullptr || Path[0] == '\0')
+        return false;
+
+    std::string DirPath{Path};
+    FileSystem::CorrectSlashes(DirPath);
+    while (DirPath.length() > 1 && FileSystem::IsSlash(DirPath.back()))
+        DirPath.pop_back();
+
+    if (!FileSystem::IsDirectory(DirPath.c_str()))
+        return false;
+
+    std::lock_guard<std::mutex> Guard{m_Mtx};
+    return m_pBackend->AddDirectory(DirPath, Recursive);
+}
+
+std::vector<std::string> FileWatcher::GetChangedFiles()
+{
+    std::unordered_set<std::string> ChangedFiles;
+    {
+        std::lock_guard<std::mutex> Guard{m_Mtx};
+        m_pBackend->CollectChanges(ChangedFiles);
+    }
+    return {ChangedFiles.begin(), ChangedFiles.end()};
+}
+
+} // namespace Diligent
@@ -27,8 +27,10 @@
 
 #include "pch.h"
 #include <algorithm>
+#include <functional>
 #include "FixedBlockMemoryAllocator.hpp"
 #include "Align.hpp"
+#include "PlatformMisc.hpp"
 
 namespace Diligent
 {
@@ -38,16 +40,87 @@ static size_t AdjustBlockSize(size_t BlockSize)
     return AlignUp(BlockSize, sizeof(void*));
 }
 
+namespace
+{
+
+// Assigns small indices to threads, so that allocators can keep their thread caches
+// in a flat array. An index is returned to the pool when the thread exits and may then
+// be taken by a new thread, which will reuse the caches left by the previous one.
+class ThreadCacheSlots
+{
+public:
+    static constexpr Uint32 InvalidSlot = ~Uint32{0};
+
+    static ThreadCacheSlots& Get()
+    {
+        static ThreadCacheSlots Slots;
+        return Slots;
+    }
+
+    Uint32 Acquire()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (!m_FreeSlots.empty())
+        {
+            const auto Slot = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+            return Slot;
+        }
+
+        return m_NextSlot < FixedBlockMemoryAllocator::MaxThreadCaches ? m_NextSlot++ : InvalidSlot;
+    }
+
+    void Release(Uint32 Slot)
+    {
+        if (Slot == InvalidSlot)
+            return;
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_FreeSlots.push_back(Slot);
+    }
+
+private:
+    std::mutex          m_Mtx;
+    std::vector<Uint32> m_FreeSlots;
+    Uint32              m_NextSlot = 0;
+};
+
+Uint32 GetThreadCacheSlot()
+{
+    struct SlotHolder
+    {
+        // The reference also makes sure that the slot pool outlives the holder
+        ThreadCacheSlots& Slots = ThreadCacheSlots::Get();
+        const Uint32      Slot  = Slots.Acquire();
+
+        ~SlotHolder()
+        {
+            Slots.Release(Slot);
+        }
+    };
+    static thread_local SlotHolder Holder;
+    return Holder.Slot;
+}
+
+bool PageAddrLess(const Uint8* Addr, const std::pair<const Uint8*, size_t>& Elem)
+{
+    return std::less<const Uint8*>{}(Addr, Elem.first);
+}
+
+} // namespace
+
 FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator,
                                                      size_t            BlockSize,
-                                                     Uint32            NumBlocksInPage) :
+                                                     Uint32            NumBlocksInPage,
+                                                     bool              EnableThreadCache) :
     // clang-format off
     m_PagePool          (STD_ALLOCATOR_RAW_MEM(MemoryPage, RawMemoryAllocator, "Allocator for vector<MemoryPage>")),
-    m_AvailablePages    (STD_ALLOCATOR_RAW_MEM(size_t, RawMemoryAllocator, "Allocator for unordered_set<size_t>") ),
-    m_AddrToPageId      (STD_ALLOCATOR_RAW_MEM(AddrToPageIdMapElem, RawMemoryAllocator, "Allocator for unordered_map<void*, size_t>")),
+    m_AvailablePages    (STD_ALLOCATOR_RAW_MEM(size_t, RawMemoryAllocator, "Allocator for vector<size_t>") ),
+    m_SortedPageAddrs   (STD_ALLOCATOR_RAW_MEM(PageAddrElem, RawMemoryAllocator, "Allocator for vector<PageAddrElem>")),
     m_RawMemoryAllocator{RawMemoryAllocator        },
     m_BlockSize         {AdjustBlockSize(BlockSize)},
-    m_NumBlocksInPage   {NumBlocksInPage           }
+    m_NumBlocksInPage   {NumBlocksInPage           },
+    m_ThreadCaches      (EnableThreadCache ? MaxThreadCaches : 0, ThreadCache{}, STD_ALLOCATOR_RAW_MEM(ThreadCache, RawMemoryAllocator, "Allocator for vector<ThreadCache>"))
 // clang-format on
 {
     // Allocate one page
@@ -59,73 +132,284 @@ FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemory
 
 FixedBlockMemoryAllocator::~FixedBlockMemoryAllocator()
 {
+    const auto NumMagazines = m_NumMagazines.load();
+
 #ifdef DILIGENT_DEBUG
+    // Blocks in thread caches and in the depot are free, but are allocated from the pages' standpoint
+    size_t NumCachedBlocks = 0;
+    for (Uint32 i = 0; i < NumMagazines; ++i)
+        NumCachedBlocks += GetMagazine(i).NumBlocks;
+
+    size_t NumAllocatedBlocks = 0;
     for (size_t p = 0; p < m_PagePool.size(); ++p)
     {
-        VERIFY(!m_PagePool[p].HasAllocations(), "Memory leak detected: memory page has allocated block");
-        VERIFY(m_AvailablePages.find(p) != m_AvailablePages.end(), "Memory page is not in the available page pool");
+        const auto& Page = m_PagePool[p];
+        NumAllocatedBlocks += Page.GetNumAllocatedBlocks();
+        VERIFY(!Page.HasSpace() || std::find(m_AvailablePages.begin(), m_AvailablePages.end(), p) != m_AvailablePages.end(),
+               "Memory page is not in the available page pool");
     }
+    VERIFY(NumAllocatedBlocks == NumCachedBlocks, "Memory leak detected: ", NumAllocatedBlocks - NumCachedBlocks, " block(s) have not been released");
 #endif
+
+    for (size_t Seg = 0; Seg < m_MagazineSegments.size(); ++Seg)
+    {
+        auto* pSegment = m_MagazineSegments[Seg].load();
+        if (pSegment == nullptr)
+            continue;
+
+        for (size_t i = 0; i < (size_t{1} << Seg); ++i)
+            pSegment[i].~Magazine();
+        m_RawMemoryAllocator.Free(pSegment);
+    }
 }
 
 void FixedBlockMemoryAllocator::CreateNewPage()
 {
     VERIFY_EXPR(m_BlockSize > 0);
     m_PagePool.emplace_back(*this);
-    m_AvailablePages.insert(m_PagePool.size() - 1);
-    m_AddrToPageId.reserve(m_PagePool.size() * m_NumBlocksInPage);
+
+    const auto PageId = m_PagePool.size() - 1;
+    m_AvailablePages.push_back(PageId);
+
+    const auto* pPageStart = static_cast<const Uint8*>(m_PagePool.back().GetBlockStartAddress(0));
+    m_SortedPageAddrs.emplace(std::upper_bound(m_SortedPageAddrs.begin(), m_SortedPageAddrs.end(), pPageStart, PageAddrLess), pPageStart, PageId);
 }
 
-void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+bool FixedBlockMemoryAllocator::FindPage(const void* Ptr, size_t& PageId) const
 {
-    VERIFY_EXPR(Size > 0);
+    const auto* pAddr = static_cast<const Uint8*>(Ptr);
 
-    Size = AdjustBlockSize(Size);
-    VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
+    // Find the last page that starts at or before the address
+    auto it = std::upper_bound(m_SortedPageAddrs.begin(), m_SortedPageAddrs.end(), pAddr, PageAddrLess);
+    if (it == m_SortedPageAddrs.begin())
+        return false;
+    --it;
 
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+    const auto* pPageEnd = it->first + m_BlockSize * m_NumBlocksInPage;
+    if (!std::less<const Uint8*>{}(pAddr, pPageEnd))
+        return false;
 
+    PageId = it->second;
+    return true;
+}
+
+void* FixedBlockMemoryAllocator::AllocateFromPage()
+{
     if (m_AvailablePages.empty())
     {
         CreateNewPage();
     }
 
-    auto  PageId = *m_AvailablePages.begin();
-    auto& Page   = m_PagePool[PageId];
-    auto* Ptr    = Page.Allocate();
-    m_AddrToPageId.insert(std::make_pair(Ptr, PageId));
+    const auto PageId = m_AvailablePages.back();
+    auto&      Page   = m_PagePool[PageId];
+    auto*      Ptr    = Page.Allocate();
     if (!Page.HasSpace())
     {
-        m_AvailablePages.erase(m_AvailablePages.begin());
+        m_AvailablePages.pop_back();
     }
 
     return Ptr;
 }
 
+void FixedBlockMemoryAllocator::FreeToPage(void* Ptr)
+{
+    size_t PageId = 0;
+    if (!FindPage(Ptr, PageId))
+    {
+        UNEXPECTED("Address does not belong to any page of this allocator");
+        return;
+    }
+    VERIFY_EXPR(PageId < m_PagePool.size());
+
+    auto&      Page    = m_PagePool[PageId];
+    const auto WasFull = !Page.HasSpace();
+    Page.DeAllocate(Ptr);
+    if (WasFull)
+    {
+        // The page is not in the available list as new blocks are only allocated from the last page
+        // in the list, and the page is removed from the list when it becomes full.
+        m_AvailablePages.push_back(PageId);
+    }
+}
+
+void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    VERIFY_EXPR(Size > 0);
+
+    Size = AdjustBlockSize(Size);
+    VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
+
+    if (!m_ThreadCaches.empty())
+    {
+        const auto Slot = GetThreadCacheSlot();
+        if (Slot < m_ThreadCaches.size())
+            return AllocateCached(m_ThreadCaches[Slot]);
+    }
+
+    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+    return AllocateFromPage();
+}
+
 void FixedBlockMemoryAllocator::Free(void* Ptr)
 {
+    if (!m_ThreadCaches.empty())
+    {
+        const auto Slot = GetThreadCacheSlot();
+        if (Slot < m_ThreadCaches.size())
+        {
+#ifdef DILIGENT_DEBUG
+            {
+                std::lock_guard<std::mutex> LockGuard(m_Mutex);
+
+                size_t PageId = 0;
+                VERIFY(FindPage(Ptr, PageId), "Address does not belong to any page of this allocator");
+            }
+#endif
+            FreeCached(m_ThreadCaches[Slot], Ptr);
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+    FreeToPage(Ptr);
+}
+
+FixedBlockMemoryAllocator::Magazine& FixedBlockMemoryAllocator::GetMagazine(Uint32 MagIdx) const
+{
+    VERIFY_EXPR(MagIdx != InvalidMagazineIdx);
+    // Magazine i is located in segment floor(log2(i + 1)) that holds 2^Seg magazines
+    const auto Pos = Uint64{MagIdx} + 1;
+    const auto Seg = PlatformMisc::GetMSB(Pos);
+
+    auto* pSegment = m_MagazineSegments[Seg].load(std::memory_order_acquire);
+    VERIFY(pSegment != nullptr, "Magazine segment has not been allocated");
+    return pSegment[Pos - (Uint64{1} << Seg)];
+}
+
+Uint32 FixedBlockMemoryAllocator::GetEmptyMagazine()
+{
+    auto MagIdx = m_EmptyMagazines.Pop(*this);
+    if (MagIdx != InvalidMagazineIdx)
+        return MagIdx;
+
     std::lock_guard<std::mutex> LockGuard(m_Mutex);
-    auto                        PageIdIt = m_AddrToPageId.find(Ptr);
-    if (PageIdIt != m_AddrToPageId.end())
-    {
-        auto PageId = PageIdIt->second;
-        VERIFY_EXPR(PageId < m_PagePool.size());
-        m_PagePool[PageId].DeAllocate(Ptr);
-        m_AvailablePages.insert(PageId);
-        m_AddrToPageId.erase(PageIdIt);
-        if (m_AvailablePages.size() > 1 && !m_PagePool[PageId].HasAllocations())
+
+    MagIdx = m_NumMagazines.load(std::memory_order_relaxed);
+    VERIFY(MagIdx != InvalidMagazineIdx, "Too many magazines");
+
+    const auto Seg = PlatformMisc::GetMSB(Uint64{MagIdx} + 1);
+    if (m_MagazineSegments[Seg].load(std::memory_order_relaxed) == nullptr)
+    {
+        const auto SegSize  = size_t{1} << Seg;
+        auto*      pSegment = reinterpret_cast<Magazine*>(m_RawMemoryAllocator.Allocate(sizeof(Magazine) * SegSize, "FixedBlockMemoryAllocator magazines", __FILE__, __LINE__));
+        for (size_t i = 0; i < SegSize; ++i)
+            new (pSegment + i) Magazine;
+        m_MagazineSegments[Seg].store(pSegment, std::memory_order_release);
+    }
+    m_NumMagazines.store(MagIdx + 1, std::memory_order_relaxed);
+
+    return MagIdx;
+}
+
+void FixedBlockMemoryAllocator::MagazineList::Push(FixedBlockMemoryAllocator& Owner, Uint32 MagIdx)
+{
+    auto& Mag = Owner.GetMagazine(MagIdx);
+
+    auto   OldHead = m_Head.load(std::memory_order_relaxed);
+    Uint64 NewHead;
+    do
+    {
+        Mag.NextIdx.store(static_cast<Uint32>(OldHead), std::memory_order_relaxed);
+        NewHead = (((OldHead >> 32) + 1) << 32) | MagIdx;
+    } while (!m_Head.compare_exchange_weak(OldHead, NewHead, std::memory_order_release, std::memory_order_relaxed));
+}
+
+Uint32 FixedBlockMemoryAllocator::MagazineList::Pop(FixedBlockMemoryAllocator& Owner)
+{
+    auto OldHead = m_Head.load(std::memory_order_acquire);
+    for (;;)
+    {
+        const auto MagIdx = static_cast<Uint32>(OldHead);
+        if (MagIdx == InvalidMagazineIdx)
+            return InvalidMagazineIdx;
+
+        // The magazine may be concurrently popped and reused by another thread, in which case
+        // the next index is stale, but the tag makes the exchange below fail.
+        const auto NextIdx = Owner.GetMagazine(MagIdx).NextIdx.load(std::memory_order_relaxed);
+        const auto NewHead = (((OldHead >> 32) + 1) << 32) | NextIdx;
+        if (m_Head.compare_exchange_weak(OldHead, NewHead, std::memory_order_acquire, std::memory_order_acquire))
+            return MagIdx;
+    }
+}
+
+// Thread caches follow the magazine layer algorithm: the previous magazine is always either
+// full or empty, while the loaded magazine may be partially filled.
+void* FixedBlockMemoryAllocator::AllocateCached(ThreadCache& Cache)
+{
+    if (Cache.LoadedIdx == InvalidMagazineIdx || GetMagazine(Cache.LoadedIdx).NumBlocks == 0)
+    {
+        if (Cache.PreviousIdx != InvalidMagazineIdx && GetMagazine(Cache.PreviousIdx).NumBlocks > 0)
         {
-            // In current implementation pages are never released!
-            // Note that if we delete a page, all indices past it will be invalid
+            std::swap(Cache.LoadedIdx, Cache.PreviousIdx);
+        }
+        else
+        {
+            const auto FullIdx = m_FullMagazines.Pop(*this);
+            if (FullIdx != InvalidMagazineIdx)
+            {
+                if (Cache.PreviousIdx != InvalidMagazineIdx)
+                    m_EmptyMagazines.Push(*this, Cache.PreviousIdx);
+                Cache.PreviousIdx = Cache.LoadedIdx;
+                Cache.LoadedIdx   = FullIdx;
+            }
+            else
+            {
+                // The depot has no full magazines: fill the loaded magazine from the pages.
+                // Fill it halfway to leave room for blocks released by this thread.
+                if (Cache.LoadedIdx == InvalidMagazineIdx)
+                    Cache.LoadedIdx = GetEmptyMagazine();
+
+                auto& Mag = GetMagazine(Cache.LoadedIdx);
 
-            //m_PagePool.erase(m_PagePool.begin() + PageId);
-            //m_AvailablePages.erase(PageId);
+                std::lock_guard<std::mutex> LockGuard(m_Mutex);
+                while (Mag.NumBlocks < MagazineCapacity / 2)
+                    Mag.Blocks[Mag.NumBlocks++] = AllocateFromPage();
+            }
         }
     }
-    else
+
+    auto& Mag = GetMagazine(Cache.LoadedIdx);
+    VERIFY_EXPR(Mag.NumBlocks > 0);
+    void* Ptr = Mag.Blocks[--Mag.NumBlocks];
+    FillWithDebugPattern(Ptr, MemoryPage::AllocatedBlockMemPattern, m_BlockSize);
+    return Ptr;
+}
+
+void FixedBlockMemoryAllocator::FreeCached(ThreadCache& Cache, void* Ptr)
+{
+    FillWithDebugPattern(Ptr, MemoryPage::DeallocatedBlockMemPattern, m_BlockSize);
+
+    if (Cache.LoadedIdx == InvalidMagazineIdx)
+        Cache.LoadedIdx = GetEmptyMagazine();
+
+    if (GetMagazine(Cache.LoadedIdx).NumBlocks == MagazineCapacity)
     {
-        UNEXPECTED("Address not found in the allocations list - double freeing memory?");
+        if (Cache.PreviousIdx != InvalidMagazineIdx && GetMagazine(Cache.PreviousIdx).NumBlocks == 0)
+        {
+            std::swap(Cache.LoadedIdx, Cache.PreviousIdx);
+        }
+        else
+        {
+            if (Cache.PreviousIdx != InvalidMagazineIdx)
+                m_FullMagazines.Push(*this, Cache.PreviousIdx);
+            Cache.PreviousIdx = Cache.LoadedIdx;
+            Cache.LoadedIdx   = GetEmptyMagazine();
+        }
     }
+
+    auto& Mag = GetMagazine(Cache.LoadedIdx);
+    VERIFY_EXPR(Mag.NumBlocks < MagazineCapacity);
+    Mag.Blocks[Mag.NumBlocks++] = Ptr;
 }
 
 } // namespace Diligent
@@ -0,0 +1,170 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "HashedName.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#include "HashUtils.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Insert-only hash table with a fixed number of buckets. Each bucket is a singly linked
+// list of immutable entries. New entries are published at the list head with a CAS,
+// so readers never block and only need an acquire load of the head.
+class NameTable
+{
+public:
+    using Entry = HashedName::Entry;
+
+    NameTable() :
+        m_Buckets{new std::atomic<const Entry*>[NumBuckets]}
+    {
+        for (size_t i = 0; i < NumBuckets; ++i)
+            m_Buckets[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    // clang-format off
+    NameTable           (const NameTable&) = delete;
+    NameTable& operator=(const NameTable&) = delete;
+    // clang-format on
+
+    ~NameTable()
+    {
+        for (size_t i = 0; i < NumBuckets; ++i)
+        {
+            const Entry* pEntry = m_Buckets[i].load(std::memory_order_relaxed);
+            while (pEntry != nullptr)
+            {
+                const Entry* pNext = pEntry->pNext;
+                std::free(const_cast<Entry*>(pEntry));
+                pEntry = pNext;
+            }
+        }
+    }
+
+    static NameTable& Get()
+    {
+        static NameTable Table;
+        return Table;
+    }
+
+    const Entry* Find(const Char* Str, size_t Hash, size_t Length) const
+    {
+        return FindInList(GetBucket(Hash).load(std::memory_order_acquire), nullptr, Str, Hash, Length);
+    }
+
+    const Entry* Intern(const Char* Str, size_t Hash, size_t Length)
+    {
+        auto& Bucket = GetBucket(Hash);
+
+        const Entry* pHead = Bucket.load(std::memory_order_acquire);
+        if (const Entry* pEntry = FindInList(pHead, nullptr, Str, Hash, Length))
+            return pEntry;
+
+        Entry* pNewEntry = CreateEntry(Str, Hash, Length);
+        while (true)
+        {
+            pNewEntry->pNext = pHead;
+            if (Bucket.compare_exchange_weak(pHead, pNewEntry, std::memory_order_release, std::memory_order_acquire))
+                return pNewEntry;
+
+            // Another thread has published new entries: only they need to be checked
+            if (const Entry* pEntry = FindInList(pHead, pNewEntry->pNext, Str, Hash, Length))
+            {
+                std::free(pNewEntry);
+                return pEntry;
+            }
+        }
+    }
+
+private:
+    static constexpr size_t NumBuckets = size_t{1} << 14u;
+
+    std::atomic<const Entry*>& GetBucket(size_t Hash) const
+    {
+        // CStringHash is multiplicative, so fold the high bits into the bucket index
+        return m_Buckets[(Hash ^ (Hash >> 15u) ^ (Hash >> 29u)) & (NumBuckets - 1)];
+    }
+
+    static const Entry* FindInList(const Entry* pEntry, const Entry* pEnd, const Char* Str, size_t Hash, size_t Length)
+    {
+        for (; pEntry != pEnd; pEntry = pEntry->pNext)
+        {
+            if (pEntry->Hash == Hash && pEntry->Length == Length && std::memcmp(pEntry->Str, Str, Length) == 0)
+                return pEntry;
+        }
+        return nullptr;
+    }
+
+    static Entry* CreateEntry(const Char* Str, size_t Hash, size_t Length)
+    {
+        void* pMemory = std::malloc(offsetof(Entry, Str) + Length + 1);
+        if (pMemory == nullptr)
+            throw std::bad_alloc{};
+
+        Entry* pEntry  = reinterpret_cast<Entry*>(pMemory);
+        pEntry->pNext  = nullptr;
+        pEntry->Hash   = Hash;
+        pEntry->Length = Length;
+        std::memcpy(pEntry->Str, Str, Length + 1);
+        return pEntry;
+    }
+
+    std::unique_ptr<std::atomic<const Entry*>[]> m_Buckets;
+};
+
+} // namespace
+
+HashedName::HashedName(const Char* Str)
+{
+    VERIFY(Str != nullptr, "String must not be null");
+    if (Str == nullptr)
+        return;
+
+    m_pEntry = NameTable::Get().Intern(Str, CStringHash<Char>{}(Str), strlen(Str));
+}
+
+HashedName HashedName::Find(const Char* Str)
+{
+    if (Str == nullptr)
+        return HashedName{};
+
+    return HashedName{NameTable::Get().Find(Str, CStringHash<Char>{}(Str), strlen(Str))};
+}
+
+} // namespace Diligent
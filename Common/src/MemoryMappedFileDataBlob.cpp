@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "MemoryMappedFileDataBlob.hpp"
+
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+RefCntAutoPtr<MemoryMappedFileDataBlob> MemoryMappedFileDataBlob::Create(const Char* FilePath, bool ReadOnly)
+{
+    std::unique_ptr<MemoryMappedFile> pFile;
+    try
+    {
+        pFile = std::make_unique<MemoryMappedFile>(FilePath, ReadOnly);
+    }
+    catch (...)
+    {
+        return {};
+    }
+
+    return RefCntAutoPtr<MemoryMappedFileDataBlob>{MakeNewRCObj<MemoryMappedFileDataBlob>()(std::move(pFile))};
+}
+
+MemoryMappedFileDataBlob::MemoryMappedFileDataBlob(IReferenceCounters* pRefCounters, std::unique_ptr<MemoryMappedFile>&& pFile) :
+    TBase{pRefCounters},
+    m_pFile{std::move(pFile)}
+{
+    VERIFY_EXPR(m_pFile);
+}
+
+MemoryMappedFileDataBlob::~MemoryMappedFileDataBlob()
+{}
+
+void MemoryMappedFileDataBlob::Resize(size_t NewSize)
+{
+    DEV_CHECK_ERR(NewSize == m_pFile->GetSize(), "Memory-mapped data blob can't be resized");
+}
+
+size_t MemoryMappedFileDataBlob::GetSize() const
+{
+    return m_pFile->GetSize();
+}
+
+void* MemoryMappedFileDataBlob::GetDataPtr()
+{
+    return m_pFile->GetData();
+}
+
+const void* MemoryMappedFileDataBlob::GetConstDataPtr() const
+{
+    return m_pFile->GetData();
+}
+
+} // namespace Diligent
@@ -0,0 +1,298 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+#include "StartupProfiler.hpp"
+
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+#include "Timer.hpp"
+#include "FileWrapper.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct ProfilerState
+{
+    std::atomic<bool> IsActive{false};
+
+    std::mutex Mtx;
+
+    // Incremented by every Start(), so that scopes and thread stacks of
+    // previous recordings are never confused with the current one.
+    Uint32 Session = 0;
+
+    Timer Clock;
+
+    std::vector<StartupTimelineEvent> Events;
+
+    std::unordered_map<std::thread::id, Uint32> ThreadIndices;
+};
+
+ProfilerState& GetProfilerState()
+{
+    static ProfilerState State;
+    return State;
+}
+
+// Events that are in progress in the current thread
+struct ThreadEventStack
+{
+    Uint32              Session = 0;
+    std::vector<Uint32> Events;
+};
+thread_local ThreadEventStack tls_EventStack;
+
+// Adds the event to the state and returns its index. Must be called with the state mutex locked.
+Uint32 AddEvent(ProfilerState& State, const Char* Name, const Char* Detail, double Duration)
+{
+    if (tls_EventStack.Session != State.Session)
+    {
+        tls_EventStack.Session = State.Session;
+        tls_EventStack.Events.clear();
+    }
+
+    const auto EventIndex = static_cast<Uint32>(State.Events.size());
+
+    State.Events.emplace_back();
+    auto& Event = State.Events.back();
+
+    Event.Name = Name != nullptr ? Name : "<Unnamed>";
+    if (Detail != nullptr)
+    {
+        Event.Name += " '";
+        Event.Name += Detail;
+        Event.Name += '\'';
+    }
+    Event.ThreadIndex = State.ThreadIndices.emplace(std::this_thread::get_id(), static_cast<Uint32>(State.ThreadIndices.size())).first->second;
+    Event.Depth       = static_cast<Uint32>(tls_EventStack.Events.size());
+    Event.Parent      = !tls_EventStack.Events.empty() ? tls_EventStack.Events.back() : StartupTimelineEvent::InvalidParent;
+    Event.StartTime   = State.Clock.GetElapsedTime();
+    Event.Duration    = Duration;
+
+    return EventIndex;
+}
+
+void WriteJSONString(std::stringstream& ss, const std::string& Str)
+{
+    ss << '"';
+    for (auto c : Str)
+    {
+        switch (c)
+        {
+            case '"': ss << "\\\""; break;
+            case '\\': ss << "\\\\"; break;
+            case '\n': ss << "\\n"; break;
+            case '\r': ss << "\\r"; break;
+            case '\t': ss << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+                else
+                    ss << c;
+        }
+    }
+    ss << '"';
+}
+
+} // namespace
+
+bool StartupProfiler::Start()
+{
+    auto& State = GetProfilerState();
+
+    std::lock_guard<std::mutex> Lock{State.Mtx};
+    if (State.IsActive.load(std::memory_order_relaxed))
+        return false;
+
+    ++State.Session;
+    if (State.Session == 0)
+        State.Session = 1; // 0 means that the scope is not recorded
+    State.Events.clear();
+    State.ThreadIndices.clear();
+    State.Clock.Restart();
+    State.IsActive.store(true, std::memory_order_relaxed);
+
+    return true;
+}
+
+bool StartupProfiler::Stop(StartupTimeline& Timeline)
+{
+    auto& State = GetProfilerState();
+
+    std::lock_guard<std::mutex> Lock{State.Mtx};
+    if (!State.IsActive.load(std::memory_order_relaxed))
+        return false;
+
+    State.IsActive.store(false, std::memory_order_relaxed);
+
+    Timeline.TotalTime = State.Clock.GetElapsedTime();
+    Timeline.Events    = std::move(State.Events);
+    State.Events.clear();
+    State.ThreadIndices.clear();
+
+    return true;
+}
+
+bool StartupProfiler::IsActive() noexcept
+{
+    return GetProfilerState().IsActive.load(std::memory_order_relaxed);
+}
+
+void StartupProfiler::AddMark(const Char* Name)
+{
+    auto& State = GetProfilerState();
+
+    std::lock_guard<std::mutex> Lock{State.Mtx};
+    if (!State.IsActive.load(std::memory_order_relaxed))
+        return;
+
+    AddEvent(State, Name, nullptr, 0);
+}
+
+void StartupProfiler::Scope::Begin(const Char* Name, const Char* Detail)
+{
+    auto& State = GetProfilerState();
+
+    std::lock_guard<std::mutex> Lock{State.Mtx};
+    if (!State.IsActive.load(std::memory_order_relaxed))
+        return;
+
+    m_EventIndex = AddEvent(State, Name, Detail, -1);
+    m_Session    = State.Session;
+    tls_EventStack.Events.push_back(m_EventIndex);
+}
+
+void StartupProfiler::Scope::End()
+{
+    auto& State = GetProfilerState();
+
+    std::lock_guard<std::mutex> Lock{State.Mtx};
+    if (!State.IsActive.load(std::memory_order_relaxed) || State.Session != m_Session)
+        return;
+
+    auto& Event    = State.Events[m_EventIndex];
+    Event.Duration = State.Clock.GetElapsedTime() - Event.StartTime;
+
+    VERIFY(tls_EventStack.Session == m_Session && !tls_EventStack.Events.empty() && tls_EventStack.Events.back() == m_EventIndex,
+           "Startup profiler scopes must be destroyed in the reverse order of their creation in the same thread");
+    if (!tls_EventStack.Events.empty())
+        tls_EventStack.Events.pop_back();
+}
+
+std::string StartupTimeline::GetReport() const
+{
+    Uint32 NumThreads = 0;
+    for (const auto& Event : Events)
+        NumThreads = std::max(NumThreads, Event.ThreadIndex + 1);
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "Total time: " << TotalTime * 1000.0 << " ms";
+    for (Uint32 Thread = 0; Thread < NumThreads; ++Thread)
+    {
+        ss << "\nThread " << Thread << ':';
+        for (const auto& Event : Events)
+        {
+            if (Event.ThreadIndex != Thread)
+                continue;
+
+            ss << '\n'
+               << std::setw(static_cast<int>(2 + Event.Depth * 2)) << "" << std::setw(10) << Event.StartTime * 1000.0 << " ms  ";
+            if (Event.Duration > 0)
+                ss << Event.Name << ": " << Event.Duration * 1000.0 << " ms";
+            else if (Event.Duration == 0)
+                ss << Event.Name;
+            else
+                ss << Event.Name << ": in progress";
+        }
+    }
+
+    return ss.str();
+}
+
+std::string StartupTimeline::GetJSON() const
+{
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (size_t i = 0; i < Events.size(); ++i)
+    {
+        const auto& Event = Events[i];
+
+        ss << (i > 0 ? ",\n" : "\n") << "{\"name\":";
+        WriteJSONString(ss, Event.Name);
+        ss << ",\"pid\":0,\"tid\":" << Event.ThreadIndex << ",\"ts\":" << Event.StartTime * 1e+6;
+        if (Event.Duration != 0)
+        {
+            // Events that are still in progress are shown as ending at the end of the recording
+            const auto Duration = Event.Duration > 0 ? Event.Duration : TotalTime - Event.StartTime;
+            ss << ",\"ph\":\"X\",\"dur\":" << Duration * 1e+6;
+        }
+        else
+        {
+            ss << ",\"ph\":\"i\",\"s\":\"t\"";
+        }
+        ss << '}';
+    }
+    ss << "\n]}\n";
+
+    return ss.str();
+}
+
+bool StartupTimeline::WriteJSON(const Char* FilePath) const
+{
+    VERIFY_EXPR(FilePath != nullptr);
+
+    FileWrapper File{FilePath, EFileAccessMode::Overwrite};
+    if (!File)
+    {
+        LOG_ERROR_MESSAGE("Failed to open file '", FilePath, "' to write the startup timeline");
+        return false;
+    }
+
+    const auto JSON = GetJSON();
+    if (!File->Write(JSON.data(), JSON.size()))
+    {
+        LOG_ERROR_MESSAGE("Failed to write the startup timeline to file '", FilePath, "'");
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace Diligent
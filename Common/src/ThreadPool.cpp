@@ -26,12 +26,24 @@
 
 #include "ThreadPool.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
 #include <mutex>
+#include <sstream>
 #include <thread>
 #include <map>
+#include <memory>
 #include <vector>
+#include <unordered_map>
 #include <condition_variable>
 
+#include "Cast.hpp"
+#include "CPUProfiler.hpp"
+#include "FileWrapper.hpp"
+#include "Timer.hpp"
+#include "../../Platforms/interface/PlatformMisc.hpp"
+
 namespace Diligent
 {
 
@@ -39,6 +51,124 @@ AsyncTaskBase::~AsyncTaskBase()
 {
 }
 
+namespace
+{
+
+class ThreadPoolImpl;
+
+// The pool and the id of the thread that is currently processing tasks.
+// Used to push tasks enqueued from worker threads into the thread's local queue.
+thread_local const ThreadPoolImpl* tls_pCurrentPool    = nullptr;
+thread_local Uint32                tls_CurrentThreadId = 0;
+
+// Lock-free ring of task execution records.
+// Every worker thread writes to its own ring, but threads that call ProcessTask() manually
+// may share a ring, so writers claim slots atomically. Every slot is protected by a sequence
+// number that lets the reader detect the slots that were overwritten while being read.
+class TaskTraceRing
+{
+public:
+    struct Record
+    {
+        Uint32 TaskId      = 0;
+        Uint32 ThreadId    = 0;
+        float  Priority    = 0;
+        bool   Cancelled   = false;
+        Uint64 EnqueueTime = 0;
+        Uint64 ReadyTime   = 0;
+        Uint64 StartTime   = 0;
+        Uint64 EndTime     = 0;
+    };
+
+    explicit TaskTraceRing(size_t Capacity) :
+        m_Slots(Capacity)
+    {}
+
+    void Write(const Record& Rec) noexcept
+    {
+        const auto Idx  = m_WriteIdx.fetch_add(1, std::memory_order_relaxed);
+        auto&      Slot = m_Slots[Idx % m_Slots.size()];
+
+        Slot.Seq.store(BusySeq, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        Uint32 PriorityBits = 0;
+        memcpy(&PriorityBits, &Rec.Priority, sizeof(PriorityBits));
+        Slot.Data[0].store(Uint64{Rec.TaskId} | (Uint64{Rec.ThreadId} << 32u), std::memory_order_relaxed);
+        Slot.Data[1].store(Uint64{PriorityBits} | (Rec.Cancelled ? Uint64{1} << 32u : 0), std::memory_order_relaxed);
+        Slot.Data[2].store(Rec.EnqueueTime, std::memory_order_relaxed);
+        Slot.Data[3].store(Rec.ReadyTime, std::memory_order_relaxed);
+        Slot.Data[4].store(Rec.StartTime, std::memory_order_relaxed);
+        Slot.Data[5].store(Rec.EndTime, std::memory_order_relaxed);
+
+        // Sequence number Idx + 1 means that the slot contains the record with index Idx
+        Slot.Seq.store(Idx + 1, std::memory_order_release);
+    }
+
+    // Reads the records starting from index FirstIdx and returns the index of the next record to read.
+    // Records that were overwritten or are being written are counted in NumDropped.
+    Uint64 Read(Uint64 FirstIdx, std::vector<Record>& Records, Uint64& NumDropped) const
+    {
+        const auto EndIdx   = m_WriteIdx.load(std::memory_order_acquire);
+        const auto BeginIdx = std::max(FirstIdx, EndIdx > m_Slots.size() ? EndIdx - m_Slots.size() : Uint64{0});
+        NumDropped += BeginIdx - FirstIdx;
+
+        for (auto Idx = BeginIdx; Idx < EndIdx; ++Idx)
+        {
+            const auto& Slot = m_Slots[Idx % m_Slots.size()];
+
+            Uint64 Data[NumDataWords];
+
+            const auto Seq0 = Slot.Seq.load(std::memory_order_acquire);
+            for (size_t i = 0; i < NumDataWords; ++i)
+                Data[i] = Slot.Data[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const auto Seq1 = Slot.Seq.load(std::memory_order_relaxed);
+
+            if (Seq0 != Idx + 1 || Seq1 != Seq0)
+            {
+                ++NumDropped;
+                continue;
+            }
+
+            Record Rec;
+            Rec.TaskId   = static_cast<Uint32>(Data[0]);
+            Rec.ThreadId = static_cast<Uint32>(Data[0] >> 32u);
+
+            const auto PriorityBits = static_cast<Uint32>(Data[1]);
+            memcpy(&Rec.Priority, &PriorityBits, sizeof(PriorityBits));
+            Rec.Cancelled = (Data[1] >> 32u) != 0;
+
+            Rec.EnqueueTime = Data[2];
+            Rec.ReadyTime   = Data[3];
+            Rec.StartTime   = Data[4];
+            Rec.EndTime     = Data[5];
+            Records.push_back(Rec);
+        }
+
+        return EndIdx;
+    }
+
+private:
+    static constexpr Uint64 BusySeq      = ~Uint64{0};
+    static constexpr size_t NumDataWords = 6;
+
+    struct TraceSlot
+    {
+        std::atomic<Uint64> Seq{0};
+        std::atomic<Uint64> Data[NumDataWords];
+
+        TraceSlot()
+        {
+            for (auto& Val : Data)
+                Val.store(0, std::memory_order_relaxed);
+        }
+    };
+    std::vector<TraceSlot> m_Slots;
+
+    std::atomic<Uint64> m_WriteIdx{0};
+};
+
 class ThreadPoolImpl final : public ObjectBase<IThreadPool>
 {
 public:
@@ -46,14 +176,30 @@ public:
 
     ThreadPoolImpl(IReferenceCounters*         pRefCounters,
                    const ThreadPoolCreateInfo& PoolCI) :
-        TBase{pRefCounters}
+        TBase{pRefCounters},
+        m_Queues(GetNumQueues(PoolCI)),
+        m_TraceStartTicks{GetCPUTimestamp()}
     {
+        if (PoolCI.TraceCapacity > 0)
+        {
+            const auto NumRings = std::max(PoolCI.NumThreads, size_t{1});
+            m_TraceRings.reserve(NumRings);
+            for (size_t i = 0; i < NumRings; ++i)
+                m_TraceRings.emplace_back(std::make_unique<TaskTraceRing>(PoolCI.TraceCapacity));
+            m_TraceReadIdx.resize(NumRings);
+        }
+
+        const auto AffinityMasks = GetWorkerAffinityMasks(PoolCI);
+
         m_WorkerThreads.reserve(PoolCI.NumThreads);
         for (Uint32 i = 0; i < PoolCI.NumThreads; ++i)
         {
             m_WorkerThreads.emplace_back(
-                [this, PoolCI, i] //
+                [this, PoolCI, i, AffinityMask = AffinityMasks[i]] //
                 {
+                    if (AffinityMask != 0)
+                        PlatformMisc::SetCurrentThreadAffinity(AffinityMask);
+
                     if (PoolCI.OnThreadStarted)
                         PoolCI.OnThreadStarted(i);
 
@@ -71,9 +217,17 @@ public:
 
     virtual bool ProcessTask(Uint32 ThreadId, bool WaitForTask) override final
     {
-        RefCntAutoPtr<IAsyncTask> pTask;
+        tls_pCurrentPool    = this;
+        tls_CurrentThreadId = ThreadId;
+
+        QueuedTask Task;
+        while (true)
         {
-            std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
+            Task = PopTask(ThreadId);
+            if (Task.pTask)
+                break;
+
+            std::unique_lock<std::mutex> lock{m_NextTaskMtx};
             if (WaitForTask)
             {
                 // The effects of notify_one()/notify_all() and each of the three atomic parts of
@@ -82,76 +236,134 @@ public:
                 // the order is specific to this individual condition variable. This makes it impossible
                 // for notify_one() to, for example, be delayed and unblock a thread that started waiting
                 // just after the call to notify_one() was made.
+                //
+                // NB: the number of sleeping threads must be incremented before the predicate is
+                //     checked for the first time, see EnqueueReadyTask().
+                m_NumSleepingThreads.fetch_add(1);
                 m_NextTaskCond.wait(lock,
                                     [this] //
                                     {
-                                        return m_Stop.load() || !m_TasksQueue.empty();
+                                        return m_Stop.load() || m_NumQueuedTasks.load() > 0;
                                     } //
                 );
+                m_NumSleepingThreads.fetch_add(-1);
             }
 
             // m_Stop must be accessed under the mutex
-            if (m_Stop.load() && m_TasksQueue.empty())
+            if (m_Stop.load() && m_NumQueuedTasks.load() == 0)
                 return false;
 
-            if (!m_TasksQueue.empty())
-            {
-                auto front = m_TasksQueue.begin();
-                pTask      = std::move(front->second);
-                // NB: we must increment the running task counter while holding the lock and
-                //     before removing the task from the queue, otherwise WaitForAllTasks() may
-                //     miss the task.
-                m_NumRunningTasks.fetch_add(1);
-                m_TasksQueue.erase(front);
-            }
+            if (!WaitForTask)
+                return true;
         }
 
-        if (pTask)
+        auto& pTask = Task.pTask;
+
+        const auto StartTime = IsTracingEnabled() ? GetTraceTime() : 0;
+
+        pTask->SetStatus(ASYNC_TASK_STATUS_RUNNING);
         {
-            pTask->SetStatus(ASYNC_TASK_STATUS_RUNNING);
+            DILIGENT_PROFILE_SCOPE("ThreadPool task");
             pTask->Run(ThreadId);
-            DEV_CHECK_ERR((pTask->GetStatus() == ASYNC_TASK_STATUS_COMPLETE ||
-                           pTask->GetStatus() == ASYNC_TASK_STATUS_CANCELLED),
-                          "Finished tasks must be in COMPLETE or CANCELLED state");
-
-            {
-                std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
+        }
+        DEV_CHECK_ERR((pTask->GetStatus() == ASYNC_TASK_STATUS_COMPLETE ||
+                       pTask->GetStatus() == ASYNC_TASK_STATUS_CANCELLED),
+                      "Finished tasks must be in COMPLETE or CANCELLED state");
 
-                const auto NumRunningTasks = m_NumRunningTasks.fetch_add(-1) - 1;
-                if (m_TasksQueue.empty() && NumRunningTasks == 0)
-                {
-                    m_TasksFinishedCond.notify_one();
-                }
-            }
+        if (IsTracingEnabled())
+        {
+            TaskTraceRing::Record Rec;
+            Rec.TaskId      = Task.TraceId;
+            Rec.ThreadId    = ThreadId;
+            Rec.Priority    = pTask->GetPriority();
+            Rec.Cancelled   = pTask->GetStatus() == ASYNC_TASK_STATUS_CANCELLED;
+            Rec.EnqueueTime = Task.EnqueueTime;
+            Rec.ReadyTime   = Task.ReadyTime;
+            Rec.StartTime   = StartTime;
+            Rec.EndTime     = GetTraceTime();
+            m_TraceRings[ThreadId % m_TraceRings.size()]->Write(Rec);
         }
 
+        // NB: dependent tasks must be moved to the ready queue before the task
+        //     is reported as finished, otherwise WaitForAllTasks() may miss them.
+        ReleaseDependentTasks(pTask);
+        m_NumRunningTasks.fetch_add(-1);
+        OnTaskRetired();
+
         return true;
     }
 
-    virtual void EnqueueTask(IAsyncTask* pTask) override final
+    virtual void EnqueueTask(IAsyncTask*  pTask,
+                             IAsyncTask** ppPrerequisites,
+                             Uint32       NumPrerequisites) override final
     {
         VERIFY_EXPR(pTask != nullptr);
         if (pTask == nullptr)
             return;
 
+        DEV_CHECK_ERR(ppPrerequisites != nullptr || NumPrerequisites == 0, "ppPrerequisites must not be null when NumPrerequisites is not zero");
+        DEV_CHECK_ERR(!m_Stop, "Enqueue on a stopped ThreadPool");
+
+        m_NumOutstandingTasks.fetch_add(1);
+
+        QueuedTask Task{RefCntAutoPtr<IAsyncTask>{pTask}};
+        if (IsTracingEnabled())
         {
-            std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-            DEV_CHECK_ERR(!m_Stop, "Enqueue on a stopped ThreadPool");
+            Task.TraceId     = m_NextTraceTaskId.fetch_add(1);
+            Task.EnqueueTime = GetTraceTime();
+        }
+
+        if (NumPrerequisites > 0 && ppPrerequisites != nullptr)
+        {
+            std::unique_lock<std::mutex> lock{m_DependenciesMtx};
+
+            Uint32 NumPending = 0;
+            for (Uint32 i = 0; i < NumPrerequisites; ++i)
+            {
+                IAsyncTask* pPrerequisite = ppPrerequisites[i];
+                if (pPrerequisite == nullptr)
+                    continue;
+                DEV_CHECK_ERR(pPrerequisite != pTask, "A task must not be its own prerequisite");
+
+                // NB: the link counter must be incremented before the prerequisite status is checked.
+                //     The thread that completes the prerequisite sets its status first and then checks the
+                //     counter, so either that thread will see the new link, or this thread will see that
+                //     the prerequisite has finished (see ReleaseDependentTasks()).
+                m_NumDependencyLinks.fetch_add(1);
+                if (pPrerequisite->IsFinished())
+                {
+                    m_NumDependencyLinks.fetch_add(-1);
+                    continue;
+                }
+
+                auto& Prerequisite = m_Prerequisites[pPrerequisite];
+                if (!Prerequisite.pTask)
+                    Prerequisite.pTask = pPrerequisite;
+                Prerequisite.Dependents.push_back(pTask);
+                ++NumPending;
+            }
 
-            m_TasksQueue.emplace(pTask->GetPriority(), pTask);
+            if (NumPending > 0)
+            {
+                auto inserted = m_PendingTasks.emplace(pTask, PendingTaskInfo{std::move(Task), NumPending}).second;
+                DEV_CHECK_ERR(inserted, "The task has already been enqueued");
+                (void)inserted;
+                return;
+            }
         }
-        m_NextTaskCond.notify_one();
+
+        EnqueueReadyTask(std::move(Task));
     }
 
     virtual void WaitForAllTasks() override final
     {
-        std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-        if (!m_TasksQueue.empty() || m_NumRunningTasks.load() > 0)
+        std::unique_lock<std::mutex> lock{m_TasksFinishedMtx};
+        if (m_NumOutstandingTasks.load() > 0)
         {
             m_TasksFinishedCond.wait(lock,
                                      [this] //
                                      {
-                                         return m_TasksQueue.empty() && m_NumRunningTasks.load() == 0;
+                                         return m_NumOutstandingTasks.load() == 0;
                                      } //
             );
         }
@@ -160,7 +372,7 @@ public:
     virtual void StopThreads() override final
     {
         {
-            std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
+            std::unique_lock<std::mutex> lock{m_NextTaskMtx};
             // NB: even if the shared variable is atomic, it must be modified under the mutex
             //     in order to correctly publish the modification to the waiting thread.
             m_Stop.store(true);
@@ -177,14 +389,59 @@ public:
 
     virtual bool RemoveTask(IAsyncTask* pTask, bool CancelIfRunning) override final
     {
-        std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
+        bool Removed = false;
+        for (auto& Queue : m_Queues)
+        {
+            std::unique_lock<std::mutex> lock{Queue.Mtx};
+
+            auto it = Queue.FindTask(pTask);
+            if (it != Queue.Tasks.end())
+            {
+                pTask->SetStatus(ASYNC_TASK_STATUS_CANCELLED);
+                Queue.Tasks.erase(it);
+                m_NumQueuedTasks.fetch_add(-1);
+                Removed = true;
+                break;
+            }
+        }
 
-        auto it = m_TasksQueue.begin();
-        while (it != m_TasksQueue.end() && it->second != pTask)
-            ++it;
-        if (it != m_TasksQueue.end())
+        if (!Removed)
         {
-            m_TasksQueue.erase(it);
+            std::unique_lock<std::mutex> lock{m_DependenciesMtx};
+
+            auto it = m_PendingTasks.find(pTask);
+            if (it != m_PendingTasks.end())
+            {
+                pTask->SetStatus(ASYNC_TASK_STATUS_CANCELLED);
+                m_PendingTasks.erase(it);
+                // Remove stale links so that a new task allocated at the same
+                // address is not mistaken for the removed one.
+                for (auto& Prerequisite : m_Prerequisites)
+                {
+                    auto& Dependents = Prerequisite.second.Dependents;
+                    for (auto dep_it = Dependents.begin(); dep_it != Dependents.end();)
+                    {
+                        if (*dep_it == pTask)
+                        {
+                            dep_it = Dependents.erase(dep_it);
+                            m_NumDependencyLinks.fetch_add(-1);
+                        }
+                        else
+                        {
+                            ++dep_it;
+                        }
+                    }
+                }
+                Removed = true;
+            }
+        }
+
+        if (Removed)
+        {
+            // The removed task is now cancelled, so tasks that are enqueued later with it
+            // as a prerequisite do not wait for it (see EnqueueTask()).
+            ReleaseDependentTasks(pTask);
+            OnTaskRetired();
             return true;
         }
         else
@@ -200,56 +457,69 @@ public:
     {
         const auto Priority = pTask->GetPriority();
 
-        std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-
-        auto it = m_TasksQueue.begin();
-        while (it != m_TasksQueue.end() && it->second != pTask)
-            ++it;
-        if (it != m_TasksQueue.end())
+        for (auto& Queue : m_Queues)
         {
-            if (it->first != Priority)
+            std::unique_lock<std::mutex> lock{Queue.Mtx};
+
+            auto it = Queue.FindTask(pTask);
+            if (it != Queue.Tasks.end())
             {
-                auto pExistingTask = std::move(it->second);
-                m_TasksQueue.erase(it);
-                m_TasksQueue.emplace(Priority, std::move(pExistingTask));
+                if (it->first != Priority)
+                {
+                    auto ExistingTask = std::move(it->second);
+                    Queue.Tasks.erase(it);
+                    Queue.Tasks.emplace(Priority, std::move(ExistingTask));
+                }
+
+                return true;
             }
+        }
 
-            return true;
+        {
+            // Pending tasks are placed into the queue using their priority at the time
+            // when the last prerequisite is finished.
+            std::unique_lock<std::mutex> lock{m_DependenciesMtx};
+            return m_PendingTasks.find(pTask) != m_PendingTasks.end();
         }
-        return false;
     }
 
     virtual void ReprioritizeAllTasks() override final
     {
-        std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-
-        m_ReprioritizationList.clear();
-        auto it = m_TasksQueue.begin();
-        while (it != m_TasksQueue.end())
+        for (auto& Queue : m_Queues)
         {
-            auto pTask    = it->second;
-            auto Priority = pTask->GetPriority();
-            if (it->first != Priority)
-            {
-                it = m_TasksQueue.erase(it);
-                m_ReprioritizationList.emplace_back(Priority, std::move(pTask));
-            }
-            else
+            std::unique_lock<std::mutex> lock{Queue.Mtx};
+
+            Queue.ReprioritizationList.clear();
+            auto it = Queue.Tasks.begin();
+            while (it != Queue.Tasks.end())
             {
-                ++it;
+                auto Priority = it->second.pTask->GetPriority();
+                if (it->first != Priority)
+                {
+                    Queue.ReprioritizationList.emplace_back(Priority, std::move(it->second));
+                    it = Queue.Tasks.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
             }
-        }
 
-        if (!m_ReprioritizationList.empty())
-            m_TasksQueue.insert(m_ReprioritizationList.begin(), m_ReprioritizationList.end());
+            if (!Queue.ReprioritizationList.empty())
+                Queue.Tasks.insert(Queue.ReprioritizationList.begin(), Queue.ReprioritizationList.end());
 
-        m_ReprioritizationList.clear();
+            Queue.ReprioritizationList.clear();
+        }
     }
 
     Uint32 GetQueueSize() override final
     {
-        std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-        return StaticCast<Uint32>(m_TasksQueue.size());
+        size_t NumPendingTasks = 0;
+        {
+            std::unique_lock<std::mutex> lock{m_DependenciesMtx};
+            NumPendingTasks = m_PendingTasks.size();
+        }
+        return StaticCast<Uint32>(std::max(m_NumQueuedTasks.load(), 0) + NumPendingTasks);
     }
 
     virtual Uint32 GetRunningTaskCount() const override final
@@ -257,32 +527,400 @@ public:
         return m_NumRunningTasks.load();
     }
 
+    virtual bool GetTrace(ThreadPoolTrace& Trace, bool Clear) override final
+    {
+        Trace = {};
+        if (!IsTracingEnabled())
+            return false;
+
+        std::vector<TaskTraceRing::Record> Records;
+        {
+            std::unique_lock<std::mutex> lock{m_TraceReadMtx};
+            for (size_t i = 0; i < m_TraceRings.size(); ++i)
+            {
+                const auto EndIdx = m_TraceRings[i]->Read(m_TraceReadIdx[i], Records, Trace.NumDroppedEvents);
+                if (Clear)
+                    m_TraceReadIdx[i] = EndIdx;
+            }
+        }
+
+        Trace.Events.reserve(Records.size());
+        for (const auto& Rec : Records)
+        {
+            Trace.Events.emplace_back();
+            auto& Event       = Trace.Events.back();
+            Event.TaskId      = Rec.TaskId;
+            Event.ThreadId    = Rec.ThreadId;
+            Event.Priority    = Rec.Priority;
+            Event.Cancelled   = Rec.Cancelled;
+            Event.EnqueueTime = CPUTicksToSeconds(Rec.EnqueueTime);
+            Event.ReadyTime   = CPUTicksToSeconds(Rec.ReadyTime);
+            Event.StartTime   = CPUTicksToSeconds(Rec.StartTime);
+            Event.EndTime     = CPUTicksToSeconds(Rec.EndTime);
+        }
+        std::sort(Trace.Events.begin(), Trace.Events.end(),
+                  [](const ThreadPoolTaskEvent& LHS, const ThreadPoolTaskEvent& RHS) {
+                      return LHS.StartTime < RHS.StartTime;
+                  });
+        Trace.CaptureTime = CPUTicksToSeconds(GetTraceTime());
+
+        return true;
+    }
+
     ~ThreadPoolImpl()
     {
         StopThreads();
-        VERIFY_EXPR(m_TasksQueue.empty());
+        VERIFY_EXPR(m_NumQueuedTasks.load() == 0);
         VERIFY_EXPR(m_NumRunningTasks.load() == 0);
+
+        if (tls_pCurrentPool == this)
+            tls_pCurrentPool = nullptr;
     }
 
 private:
-    std::vector<std::thread> m_WorkerThreads;
+    struct QueuedTask
+    {
+        RefCntAutoPtr<IAsyncTask> pTask;
+
+        // Trace information, only set when the tracing is enabled
+        Uint32 TraceId     = 0;
+        Uint64 EnqueueTime = 0;
+        Uint64 ReadyTime   = 0;
+    };
 
     // Priority queue
-    std::mutex                                                           m_TasksQueueMtx;
-    std::multimap<float, RefCntAutoPtr<IAsyncTask>, std::greater<float>> m_TasksQueue;
+    struct TaskQueue
+    {
+        using TasksMapType = std::multimap<float, QueuedTask, std::greater<float>>;
+
+        std::mutex   Mtx;
+        TasksMapType Tasks;
+
+        std::vector<std::pair<float, QueuedTask>> ReprioritizationList;
+
+        TasksMapType::iterator FindTask(IAsyncTask* pTask)
+        {
+            auto it = Tasks.begin();
+            while (it != Tasks.end() && it->second.pTask != pTask)
+                ++it;
+            return it;
+        }
+    };
+
+    bool IsTracingEnabled() const
+    {
+        return !m_TraceRings.empty();
+    }
+
+    // Returns the number of CPU timestamp ticks since the thread pool creation
+    Uint64 GetTraceTime() const
+    {
+        return GetCPUTimestamp() - m_TraceStartTicks;
+    }
+
+    // Returns the affinity mask of every worker thread. Zero mask means no affinity.
+    static std::vector<Uint64> GetWorkerAffinityMasks(const ThreadPoolCreateInfo& PoolCI)
+    {
+        std::vector<Uint64> Masks(PoolCI.NumThreads, PoolCI.AffinityMask);
+        if (PoolCI.Placement == THREAD_POOL_PLACEMENT_ANY || PoolCI.NumThreads == 0)
+            return Masks;
+
+        const auto& Topology = PlatformMisc::GetCPUTopology();
+        const auto  AllowedMask =
+            PoolCI.AffinityMask != 0 ? PoolCI.AffinityMask : (Topology.GetAffinityMask(CPU_CORE_TYPE_PERFORMANCE) | Topology.GetAffinityMask(CPU_CORE_TYPE_EFFICIENCY));
+
+        switch (PoolCI.Placement)
+        {
+            case THREAD_POOL_PLACEMENT_PERFORMANCE_CORES:
+            case THREAD_POOL_PLACEMENT_EFFICIENCY_CORES:
+            {
+                const auto CoreType = PoolCI.Placement == THREAD_POOL_PLACEMENT_PERFORMANCE_CORES ? CPU_CORE_TYPE_PERFORMANCE : CPU_CORE_TYPE_EFFICIENCY;
+
+                Uint64 Mask = Topology.GetAffinityMask(CoreType) & AllowedMask;
+                if (Mask == 0)
+                {
+                    // No cores of the requested type, e.g. efficiency cores on a homogeneous CPU
+                    Mask = AllowedMask;
+                }
+                std::fill(Masks.begin(), Masks.end(), Mask);
+                break;
+            }
+
+            case THREAD_POOL_PLACEMENT_ONE_THREAD_PER_CORE:
+            {
+                std::vector<Uint32> Processors;
+                for (auto Index : Topology.GetPrimaryLogicalProcessors())
+                {
+                    if (Index < 64 && (AllowedMask & (Uint64{1} << Index)) != 0)
+                        Processors.push_back(Index);
+                }
+                if (Processors.empty())
+                    break;
+
+                for (size_t i = 0; i < Masks.size(); ++i)
+                    Masks[i] = Uint64{1} << Processors[i % Processors.size()];
+                break;
+            }
+
+            default:
+                UNEXPECTED("Unexpected thread pool placement");
+        }
+
+        return Masks;
+    }
+
+    static size_t GetNumQueues(const ThreadPoolCreateInfo& PoolCI)
+    {
+        if (PoolCI.SchedulingMode != THREAD_POOL_SCHEDULING_MODE_WORK_STEALING)
+            return 1;
+
+        if (PoolCI.NumQueues != 0)
+            return PoolCI.NumQueues;
+
+        if (PoolCI.NumThreads != 0)
+            return PoolCI.NumThreads;
+
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    size_t GetLocalQueueIndex(Uint32 ThreadId) const
+    {
+        return m_Queues.size() > 1 ? ThreadId % m_Queues.size() : 0;
+    }
+
+    QueuedTask PopTask(Uint32 ThreadId)
+    {
+        QueuedTask Task;
+        if (m_NumQueuedTasks.load() == 0)
+            return Task;
+
+        const auto LocalQueueIdx = GetLocalQueueIndex(ThreadId);
+        // Start with the local queue, then try to steal from other queues. Each queue is sorted by priority,
+        // so the task taken is the highest-priority task of the first non-empty queue, which is not
+        // necessarily the highest-priority task in the pool.
+        for (size_t i = 0; i < m_Queues.size() && !Task.pTask; ++i)
+        {
+            auto& Queue = m_Queues[(LocalQueueIdx + i) % m_Queues.size()];
+
+            std::unique_lock<std::mutex> lock{Queue.Mtx};
+            if (!Queue.Tasks.empty())
+            {
+                auto front = Queue.Tasks.begin();
+                Task       = std::move(front->second);
+                Queue.Tasks.erase(front);
+                // NB: we must increment the running task counter before decrementing the
+                //     queued task counter, otherwise GetQueueSize() + GetRunningTaskCount()
+                //     may briefly report zero.
+                m_NumRunningTasks.fetch_add(1);
+                m_NumQueuedTasks.fetch_add(-1);
+            }
+        }
+
+        return Task;
+    }
+
+    void EnqueueReadyTask(QueuedTask&& Task)
+    {
+        if (IsTracingEnabled())
+            Task.ReadyTime = GetTraceTime();
+
+        size_t QueueIdx = 0;
+        if (m_Queues.size() > 1)
+        {
+            QueueIdx = tls_pCurrentPool == this ?
+                GetLocalQueueIndex(tls_CurrentThreadId) :
+                m_NextQueueIdx.fetch_add(1) % m_Queues.size();
+        }
+
+        {
+            auto&                        Queue = m_Queues[QueueIdx];
+            std::unique_lock<std::mutex> lock{Queue.Mtx};
+            const auto                   Priority = Task.pTask->GetPriority();
+            Queue.Tasks.emplace(Priority, std::move(Task));
+        }
+        m_NumQueuedTasks.fetch_add(1);
+
+        // If a thread is about to go to sleep, it increments m_NumSleepingThreads before it checks
+        // m_NumQueuedTasks, while this thread increments m_NumQueuedTasks before it checks
+        // m_NumSleepingThreads. Thus either the sleeping thread will see the new task, or this
+        // thread will see the sleeping thread and wake it up. Acquiring the mutex guarantees that
+        // the waiting thread has entered the wait and will not miss the notification.
+        if (m_NumSleepingThreads.load() > 0)
+        {
+            {
+                std::unique_lock<std::mutex> lock{m_NextTaskMtx};
+            }
+            m_NextTaskCond.notify_one();
+        }
+    }
+
+    void ReleaseDependentTasks(IAsyncTask* pTask)
+    {
+        // See comments in EnqueueTask()
+        if (m_NumDependencyLinks.load() == 0)
+            return;
+
+        std::vector<QueuedTask> ReadyTasks;
+        {
+            std::unique_lock<std::mutex> lock{m_DependenciesMtx};
+
+            auto prerequisite_it = m_Prerequisites.find(pTask);
+            if (prerequisite_it == m_Prerequisites.end())
+                return;
+
+            for (auto* pDependent : prerequisite_it->second.Dependents)
+            {
+                m_NumDependencyLinks.fetch_add(-1);
+
+                auto pending_it = m_PendingTasks.find(pDependent);
+                if (pending_it == m_PendingTasks.end())
+                {
+                    UNEXPECTED("Dependent task is not found in the pending task list");
+                    continue;
+                }
+
+                VERIFY_EXPR(pending_it->second.NumPrerequisites > 0);
+                if (--pending_it->second.NumPrerequisites == 0)
+                {
+                    ReadyTasks.emplace_back(std::move(pending_it->second.Task));
+                    m_PendingTasks.erase(pending_it);
+                }
+            }
+            m_Prerequisites.erase(prerequisite_it);
+        }
+
+        for (auto& ReadyTask : ReadyTasks)
+            EnqueueReadyTask(std::move(ReadyTask));
+    }
+
+    // Must be called after the task has been either completed or removed.
+    void OnTaskRetired()
+    {
+        const auto NumOutstandingTasks = m_NumOutstandingTasks.fetch_add(-1) - 1;
+        VERIFY_EXPR(NumOutstandingTasks >= 0);
+        if (NumOutstandingTasks == 0)
+        {
+            // Acquire the mutex to make sure that the thread that is waiting
+            // in WaitForAllTasks() does not miss the notification.
+            {
+                std::unique_lock<std::mutex> lock{m_TasksFinishedMtx};
+            }
+            m_TasksFinishedCond.notify_all();
+        }
+    }
+
+private:
+    std::vector<std::thread> m_WorkerThreads;
 
-    std::vector<std::pair<float, RefCntAutoPtr<IAsyncTask>>> m_ReprioritizationList;
+    // One queue in THREAD_POOL_SCHEDULING_MODE_PRIORITY_QUEUE mode,
+    // one queue per thread in THREAD_POOL_SCHEDULING_MODE_WORK_STEALING mode.
+    std::vector<TaskQueue> m_Queues;
+    std::atomic<size_t>    m_NextQueueIdx{0};
 
+    // Tasks that wait for their prerequisites
+    struct PendingTaskInfo
+    {
+        QueuedTask Task;
+        Uint32     NumPrerequisites = 0;
+    };
+    struct PrerequisiteInfo
+    {
+        RefCntAutoPtr<IAsyncTask> pTask;
+        std::vector<IAsyncTask*>  Dependents;
+    };
+    std::mutex                                        m_DependenciesMtx;
+    std::unordered_map<IAsyncTask*, PendingTaskInfo>  m_PendingTasks;
+    std::unordered_map<IAsyncTask*, PrerequisiteInfo> m_Prerequisites;
+    std::atomic<int>                                  m_NumDependencyLinks{0};
+
+    std::mutex              m_NextTaskMtx;
     std::condition_variable m_NextTaskCond{};
-    std::condition_variable m_TasksFinishedCond{};
     std::atomic<bool>       m_Stop{false};
+    std::atomic<int>        m_NumSleepingThreads{0};
+
+    std::mutex              m_TasksFinishedMtx;
+    std::condition_variable m_TasksFinishedCond{};
 
+    std::atomic<int> m_NumQueuedTasks{0};
     std::atomic<int> m_NumRunningTasks{0};
+    // Queued, pending and running tasks
+    std::atomic<int> m_NumOutstandingTasks{0};
+
+    // One ring per worker thread, empty if the tracing is disabled
+    std::vector<std::unique_ptr<TaskTraceRing>> m_TraceRings;
+    const Uint64                                m_TraceStartTicks;
+    std::atomic<Uint32>                         m_NextTraceTaskId{0};
+
+    // Index of the first record in every ring that has not been cleared by GetTrace()
+    std::mutex          m_TraceReadMtx;
+    std::vector<Uint64> m_TraceReadIdx;
 };
 
+} // namespace
+
 RefCntAutoPtr<IThreadPool> CreateThreadPool(const ThreadPoolCreateInfo& ThreadPoolCI)
 {
     return RefCntAutoPtr<ThreadPoolImpl>{MakeNewRCObj<ThreadPoolImpl>()(ThreadPoolCI)};
 }
 
+std::string ThreadPoolTrace::GetJSON() const
+{
+    std::vector<Uint32> ThreadIds;
+    for (const auto& Event : Events)
+        ThreadIds.push_back(Event.ThreadId);
+    std::sort(ThreadIds.begin(), ThreadIds.end());
+    ThreadIds.erase(std::unique(ThreadIds.begin(), ThreadIds.end()), ThreadIds.end());
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool First = true;
+    for (auto ThreadId : ThreadIds)
+    {
+        ss << (First ? "\n" : ",\n")
+           << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << ThreadId
+           << ",\"args\":{\"name\":\"Worker " << ThreadId << "\"}}";
+        First = false;
+    }
+
+    for (const auto& Event : Events)
+    {
+        ss << (First ? "\n" : ",\n")
+           << "{\"name\":\"Task " << Event.TaskId << (Event.Cancelled ? " (cancelled)" : "") << '"'
+           << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << Event.ThreadId
+           << ",\"ts\":" << Event.StartTime * 1e+6
+           << ",\"dur\":" << (Event.EndTime - Event.StartTime) * 1e+6
+           << ",\"args\":{\"priority\":" << Event.Priority
+           << ",\"queue_wait_ms\":" << (Event.StartTime - Event.ReadyTime) * 1e+3
+           << ",\"prerequisite_wait_ms\":" << (Event.ReadyTime - Event.EnqueueTime) * 1e+3
+           << "}}";
+        First = false;
+    }
+    ss << "\n]}\n";
+
+    return ss.str();
+}
+
+bool ThreadPoolTrace::WriteJSON(const Char* FilePath) const
+{
+    VERIFY_EXPR(FilePath != nullptr);
+
+    FileWrapper File{FilePath, EFileAccessMode::Overwrite};
+    if (!File)
+    {
+        LOG_ERROR_MESSAGE("Failed to open file '", FilePath, "' to write the thread pool trace");
+        return false;
+    }
+
+    const auto JSON = GetJSON();
+    if (!File->Write(JSON.data(), JSON.size()))
+    {
+        LOG_ERROR_MESSAGE("Failed to write the thread pool trace to file '", FilePath, "'");
+        return false;
+    }
+
+    return true;
+}
+
 } // namespace Diligent
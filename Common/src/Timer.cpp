@@ -28,6 +28,8 @@
 #include "pch.h"
 #include "Timer.hpp"
 
+#include <algorithm>
+
 using namespace std::chrono;
 namespace Diligent
 {
@@ -61,4 +63,45 @@ float Timer::GetElapsedTimef() const
     return Diligent::GetElapsedTime<float>(m_StartTime);
 }
 
+namespace
+{
+
+Uint64 CalibrateCPUTimestampFrequency()
+{
+#if DILIGENT_CPU_TIMESTAMP_RDTSC
+    // Busy-wait rather than sleep as the sleep granularity may be too coarse
+    const auto StartTime  = steady_clock::now();
+    const auto StartTicks = GetCPUTimestamp();
+
+    steady_clock::time_point EndTime;
+    do
+    {
+        EndTime = steady_clock::now();
+    } while (EndTime - StartTime < milliseconds{10});
+    const auto EndTicks = GetCPUTimestamp();
+
+    const auto ElapsedNs = duration_cast<nanoseconds>(EndTime - StartTime).count();
+    return static_cast<Uint64>(static_cast<double>(EndTicks - StartTicks) * 1e+9 / static_cast<double>(ElapsedNs));
+#elif DILIGENT_CPU_TIMESTAMP_CNTVCT
+#    ifdef _MSC_VER
+    return static_cast<Uint64>(_ReadStatusReg(ARM64_SYSREG(3, 3, 14, 0, 0))); // CNTFRQ_EL0
+#    else
+    Uint64 Frequency;
+    asm volatile("mrs %0, cntfrq_el0"
+                 : "=r"(Frequency));
+    return Frequency;
+#    endif
+#else
+    return 1000000000;
+#endif
+}
+
+} // namespace
+
+Uint64 GetCPUTimestampFrequency() noexcept
+{
+    static const Uint64 Frequency = std::max(CalibrateCPUTimestampFrequency(), Uint64{1});
+    return Frequency;
+}
+
 } // namespace Diligent
@@ -0,0 +1,270 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "TrackingMemoryAllocator.hpp"
+
+#include <algorithm>
+#include <map>
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Header that is stored in front of every allocation
+struct AllocationHeader
+{
+    void*  pTag;
+    size_t Size;
+};
+
+// Keep the user memory aligned the same way as the memory returned by the base allocator
+constexpr size_t AllocationHeaderSize = 16;
+static_assert(sizeof(AllocationHeader) <= AllocationHeaderSize, "Allocation header is too large");
+
+struct ThreadTagCacheKey
+{
+    Uint64      AllocatorId;
+    const void* Description;
+    const void* FileName;
+
+    bool operator==(const ThreadTagCacheKey& Rhs) const
+    {
+        return AllocatorId == Rhs.AllocatorId && Description == Rhs.Description && FileName == Rhs.FileName;
+    }
+
+    struct Hasher
+    {
+        size_t operator()(const ThreadTagCacheKey& Key) const
+        {
+            return ComputeHash(Key.AllocatorId, Key.Description, Key.FileName);
+        }
+    };
+};
+
+std::atomic<Uint64> g_NextAllocatorId{1};
+
+void AccumulateStats(MemoryTagStats& Dst, const MemoryTagStats& Src)
+{
+    Dst.LiveBytes += Src.LiveBytes;
+    Dst.PeakBytes += Src.PeakBytes;
+    Dst.LiveAllocations += Src.LiveAllocations;
+    Dst.NumAllocations += Src.NumAllocations;
+    Dst.AllocatedBytes += Src.AllocatedBytes;
+}
+
+// Aggregates the statistics by the value of the Key member
+std::vector<MemoryTagStats> AggregateStats(const std::vector<MemoryTagStats>& Tags, std::string MemoryTagStats::*Key)
+{
+    std::map<std::string, MemoryTagStats> Groups;
+    for (const auto& Tag : Tags)
+    {
+        auto& Group = Groups[Tag.*Key];
+        Group.*Key  = Tag.*Key;
+        AccumulateStats(Group, Tag);
+    }
+
+    std::vector<MemoryTagStats> Stats;
+    Stats.reserve(Groups.size());
+    for (auto& Group : Groups)
+        Stats.emplace_back(std::move(Group.second));
+
+    std::sort(Stats.begin(), Stats.end(),
+              [](const MemoryTagStats& Lhs, const MemoryTagStats& Rhs) {
+                  return Lhs.LiveBytes > Rhs.LiveBytes;
+              });
+    return Stats;
+}
+
+} // namespace
+
+MemoryTagStats MemoryStatsSnapshot::GetTotal() const
+{
+    MemoryTagStats Total;
+    for (const auto& Tag : Tags)
+        AccumulateStats(Total, Tag);
+    return Total;
+}
+
+std::vector<MemoryTagStats> MemoryStatsSnapshot::GetByDescription() const
+{
+    return AggregateStats(Tags, &MemoryTagStats::Description);
+}
+
+std::vector<MemoryTagStats> MemoryStatsSnapshot::GetByFileName() const
+{
+    return AggregateStats(Tags, &MemoryTagStats::FileName);
+}
+
+MemoryStatsSnapshot MemoryStatsSnapshot::Diff(const MemoryStatsSnapshot& Before, const MemoryStatsSnapshot& After)
+{
+    // Tags are never removed, so every tag of the earlier snapshot is also present in the later one
+    std::map<std::pair<std::string, std::string>, const MemoryTagStats*> BeforeTags;
+    for (const auto& Tag : Before.Tags)
+        BeforeTags.emplace(std::make_pair(Tag.Description, Tag.FileName), &Tag);
+
+    MemoryStatsSnapshot Diff;
+    Diff.Time = After.Time - Before.Time;
+    Diff.Tags.reserve(After.Tags.size());
+    for (const auto& Tag : After.Tags)
+    {
+        Diff.Tags.emplace_back(Tag);
+        auto it = BeforeTags.find(std::make_pair(Tag.Description, Tag.FileName));
+        if (it == BeforeTags.end())
+            continue;
+
+        auto& DiffTag = Diff.Tags.back();
+        DiffTag.LiveBytes -= it->second->LiveBytes;
+        DiffTag.LiveAllocations -= it->second->LiveAllocations;
+        DiffTag.NumAllocations -= it->second->NumAllocations;
+        DiffTag.AllocatedBytes -= it->second->AllocatedBytes;
+    }
+
+    return Diff;
+}
+
+
+TrackingMemoryAllocator::TrackingMemoryAllocator(IMemoryAllocator& BaseAllocator) :
+    m_BaseAllocator{BaseAllocator},
+    m_Id{g_NextAllocatorId.fetch_add(1)}
+{
+}
+
+TrackingMemoryAllocator::~TrackingMemoryAllocator()
+{
+    for (const auto& Tag : m_Tags)
+    {
+        const auto LiveAllocations = Tag.LiveAllocations.load();
+        if (LiveAllocations != 0)
+        {
+            LOG_ERROR_MESSAGE(LiveAllocations, " allocation(s) (", Tag.LiveBytes.load(), " bytes) with description '",
+                              (Tag.Description != nullptr ? Tag.Description : ""), "' made from file '",
+                              (Tag.FileName != nullptr ? Tag.FileName : ""), "' have not been released");
+        }
+    }
+}
+
+TrackingMemoryAllocator::TagCounters& TrackingMemoryAllocator::GetTagCounters(const Char* Description, const char* FileName)
+{
+    // Thread-local cache of tags that the thread has already used.
+    // The cache is shared by all allocators and is never cleaned up, so the allocator
+    // identifier (rather than its address, which may be reused) is a part of the key.
+    static thread_local std::unordered_map<ThreadTagCacheKey, void*, ThreadTagCacheKey::Hasher> ThreadCache;
+
+    const ThreadTagCacheKey CacheKey{m_Id, Description, FileName};
+
+    auto CacheIt = ThreadCache.find(CacheKey);
+    if (CacheIt != ThreadCache.end())
+        return *static_cast<TagCounters*>(CacheIt->second);
+
+    TagCounters* pTag = nullptr;
+    {
+        std::lock_guard<std::mutex> Lock{m_TagsMtx};
+
+        auto& pMapTag = m_TagMap[TagKey{Description, FileName}];
+        if (pMapTag == nullptr)
+        {
+            m_Tags.emplace_back(Description, FileName);
+            pMapTag = &m_Tags.back();
+        }
+        pTag = pMapTag;
+    }
+
+    ThreadCache.emplace(CacheKey, pTag);
+    return *pTag;
+}
+
+void* TrackingMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    VERIFY_EXPR(Size > 0);
+
+    auto& Tag = GetTagCounters(dbgDescription, dbgFileName);
+
+    auto* pMem = static_cast<Uint8*>(m_BaseAllocator.Allocate(Size + AllocationHeaderSize, dbgDescription, dbgFileName, dbgLineNumber));
+    if (pMem == nullptr)
+        return nullptr;
+
+    auto* pHeader = reinterpret_cast<AllocationHeader*>(pMem);
+    pHeader->pTag = &Tag;
+    pHeader->Size = Size;
+
+    const auto Size64    = static_cast<Int64>(Size);
+    const auto LiveBytes = Tag.LiveBytes.fetch_add(Size64, std::memory_order_relaxed) + Size64;
+
+    auto PeakBytes = Tag.PeakBytes.load(std::memory_order_relaxed);
+    while (LiveBytes > PeakBytes && !Tag.PeakBytes.compare_exchange_weak(PeakBytes, LiveBytes, std::memory_order_relaxed))
+    {
+    }
+
+    Tag.LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+    Tag.NumAllocations.fetch_add(1, std::memory_order_relaxed);
+    Tag.AllocatedBytes.fetch_add(Size, std::memory_order_relaxed);
+
+    return pMem + AllocationHeaderSize;
+}
+
+void TrackingMemoryAllocator::Free(void* Ptr)
+{
+    if (Ptr == nullptr)
+        return;
+
+    auto* pMem    = static_cast<Uint8*>(Ptr) - AllocationHeaderSize;
+    auto* pHeader = reinterpret_cast<const AllocationHeader*>(pMem);
+    auto& Tag     = *static_cast<TagCounters*>(pHeader->pTag);
+
+    Tag.LiveBytes.fetch_sub(static_cast<Int64>(pHeader->Size), std::memory_order_relaxed);
+    Tag.LiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+
+    m_BaseAllocator.Free(pMem);
+}
+
+MemoryStatsSnapshot TrackingMemoryAllocator::GetSnapshot() const
+{
+    MemoryStatsSnapshot Snapshot;
+    Snapshot.Time = m_Timer.GetElapsedTime();
+
+    std::lock_guard<std::mutex> Lock{m_TagsMtx};
+    Snapshot.Tags.reserve(m_Tags.size());
+    for (const auto& Tag : m_Tags)
+    {
+        MemoryTagStats Stats;
+        Stats.Description     = Tag.Description != nullptr ? Tag.Description : "";
+        Stats.FileName        = Tag.FileName != nullptr ? Tag.FileName : "";
+        Stats.LiveBytes       = Tag.LiveBytes.load(std::memory_order_relaxed);
+        Stats.PeakBytes       = Tag.PeakBytes.load(std::memory_order_relaxed);
+        Stats.LiveAllocations = Tag.LiveAllocations.load(std::memory_order_relaxed);
+        Stats.NumAllocations  = Tag.NumAllocations.load(std::memory_order_relaxed);
+        Stats.AllocatedBytes  = Tag.AllocatedBytes.load(std::memory_order_relaxed);
+        Snapshot.Tags.emplace_back(std::move(Stats));
+    }
+
+    return Snapshot;
+}
+
+} // namespace Diligent
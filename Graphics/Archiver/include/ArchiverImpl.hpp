@@ -92,6 +92,10 @@ public:
 private:
     bool AddRenderPass(IRenderPass* pRP);
 
+    // Adds all objects to the archive. The archive references the data of the objects
+    // and must be serialized before the archiver is modified.
+    void InitArchive(DeviceObjectArchive& Archive);
+
 private:
     using DeviceType   = DeviceObjectArchive::DeviceType;
     using ResourceType = DeviceObjectArchive::ResourceType;
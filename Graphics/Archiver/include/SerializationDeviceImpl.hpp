@@ -30,6 +30,7 @@
 #include <memory>
 #include <string>
 #include <array>
+#include <exception>
 
 #include "ArchiverFactory.h"
 
@@ -37,6 +38,8 @@
 #include "ObjectBase.hpp"
 #include "DXCompiler.hpp"
 #include "RenderDeviceBase.hpp"
+#include "ThreadPool.hpp"
+#include "BasicMath.hpp"
 
 namespace Diligent
 {
@@ -65,6 +68,7 @@ public:
     UNSUPPORTED_METHOD(void, CreateSampler,     const SamplerDesc&            Desc, ISampler**            ppSampler)
     UNSUPPORTED_METHOD(void, CreateFence,       const FenceDesc&              Desc, IFence**              ppFence)
     UNSUPPORTED_METHOD(void, CreateQuery,       const QueryDesc&              Desc, IQuery**              ppQuery)
+    UNSUPPORTED_METHOD(void, CreateQueryArray,  const QueryArrayDesc&         Desc, IQueryArray**         ppQueryArray)
     UNSUPPORTED_METHOD(void, CreateFramebuffer, const FramebufferDesc&        Desc, IFramebuffer**        ppFramebuffer)
     UNSUPPORTED_METHOD(void, CreateBLAS,        const BottomLevelASDesc&      Desc, IBottomLevelAS**      ppBLAS)
     UNSUPPORTED_METHOD(void, CreateTLAS,        const TopLevelASDesc&         Desc, ITopLevelAS**         ppTLAS)
@@ -169,6 +173,66 @@ public:
         return m_RenderDevices[Type];
     }
 
+    /// Calls Handler(Flag) for every bit set in DeviceFlags.
+    ///
+    /// \remarks  If the device has a compilation thread pool, the handlers run in parallel:
+    ///           the calling thread processes the first flag while the pool processes the rest.
+    ///           Handlers for different flags must only modify data specific to their device type.
+    ///           All handlers run to completion, after which the exception thrown by the first
+    ///           failed handler in the order of the flags is rethrown, so the error reported to
+    ///           the application does not depend on the scheduling.
+    template <typename HandlerType>
+    void ProcessDeviceFlags(ARCHIVE_DEVICE_DATA_FLAGS DeviceFlags, HandlerType&& Handler) const noexcept(false)
+    {
+        std::vector<ARCHIVE_DEVICE_DATA_FLAGS> Flags;
+        while (DeviceFlags != ARCHIVE_DEVICE_DATA_FLAG_NONE)
+            Flags.push_back(ExtractLSB(DeviceFlags));
+
+        auto* pThreadPool = GetShaderCompilationThreadPool();
+        if (pThreadPool == nullptr || Flags.size() < 2)
+        {
+            for (const auto Flag : Flags)
+                Handler(Flag);
+            return;
+        }
+
+        std::vector<std::exception_ptr>        Errors(Flags.size());
+        std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+        Tasks.reserve(Flags.size() - 1);
+        for (size_t i = 1; i < Flags.size(); ++i)
+        {
+            Tasks.emplace_back(EnqueueAsyncWork(pThreadPool,
+                                                [&Handler, &Flags, &Errors, i](Uint32 /*ThreadId*/) {
+                                                    try
+                                                    {
+                                                        Handler(Flags[i]);
+                                                    }
+                                                    catch (...)
+                                                    {
+                                                        Errors[i] = std::current_exception();
+                                                    }
+                                                }));
+        }
+
+        try
+        {
+            Handler(Flags[0]);
+        }
+        catch (...)
+        {
+            Errors[0] = std::current_exception();
+        }
+
+        for (auto& pTask : Tasks)
+            pTask->WaitForCompletion();
+
+        for (const auto& Error : Errors)
+        {
+            if (Error)
+                std::rethrow_exception(Error);
+        }
+    }
+
 protected:
     static PipelineResourceBinding ResDescToPipelineResBinding(const PipelineResourceDesc& ResDesc, SHADER_TYPE Stages, Uint32 Register, Uint32 Space);
 
@@ -182,6 +182,32 @@ struct SerializationDeviceCreateInfo
     /// Metal attributes, see Diligent::SerializationDeviceMtlInfo.
     SerializationDeviceMtlInfo Metal;
 
+    /// An optional thread pool that will be used to compile and patch shaders
+    /// for different device types in parallel.
+
+    /// \remarks   The device keeps a strong reference to the pool.
+    ///            If the pool is null, the device creates its own pool
+    ///            with NumCompilationThreads worker threads.
+    ///
+    ///            The calling thread processes one of the device types itself and then
+    ///            waits for the pool to process the rest, so serialization device methods
+    ///            must not be called from the worker threads of this pool.
+    ///            Shader source stream factories must be thread-safe.
+    ///
+    ///            The archive contents do not depend on the number of threads.
+#if DILIGENT_CPP_INTERFACE
+    class IThreadPool*  pCompilationThreadPool DEFAULT_INITIALIZER(nullptr);
+#else
+    struct IThreadPool* pCompilationThreadPool;
+#endif
+
+    /// The number of worker threads in the compilation thread pool that
+    /// the device creates when pCompilationThreadPool is null.
+
+    /// \remarks   If this value is zero, the device does not create the thread pool,
+    ///            and all device types are processed by the calling thread.
+    Uint32 NumCompilationThreads DEFAULT_INITIALIZER(0);
+
 #if DILIGENT_CPP_INTERFACE
     SerializationDeviceCreateInfo() noexcept
     {
@@ -28,6 +28,8 @@
 #include "Archiver_Inc.hpp"
 
 #include <vector>
+#include <algorithm>
+#include <cstring>
 
 #include "PSOSerializer.hpp"
 
@@ -59,6 +61,36 @@ static DeviceObjectArchive::ResourceType PipelineTypeToArchiveResourceType(PIPEL
     }
 }
 
+// Hash map iteration order depends on the order in which the objects were added, which is not
+// deterministic when objects are created and added from multiple threads. The archive layout
+// must only depend on its contents, so the objects are serialized in the order of their names.
+template <typename MapType, typename KeyLessType>
+static std::vector<const typename MapType::value_type*> GetSortedElements(const MapType& Map, KeyLessType KeyLess)
+{
+    std::vector<const typename MapType::value_type*> Elements;
+    Elements.reserve(Map.size());
+    for (const auto& it : Map)
+        Elements.push_back(&it);
+
+    std::sort(Elements.begin(), Elements.end(),
+              [&KeyLess](const typename MapType::value_type* lhs, const typename MapType::value_type* rhs) {
+                  return KeyLess(lhs->first, rhs->first);
+              });
+    return Elements;
+}
+
+static bool NameKeyLess(const HashMapStringKey& lhs, const HashMapStringKey& rhs)
+{
+    return strcmp(lhs.GetStr(), rhs.GetStr()) < 0;
+}
+
+static bool ResourceKeyLess(const DeviceObjectArchive::NamedResourceKey& lhs, const DeviceObjectArchive::NamedResourceKey& rhs)
+{
+    if (lhs.GetType() != rhs.GetType())
+        return lhs.GetType() < rhs.GetType();
+    return strcmp(lhs.GetName(), rhs.GetName()) < 0;
+}
+
 ArchiverImpl::ArchiverImpl(IReferenceCounters* pRefCounters, SerializationDeviceImpl* pDevice) :
     TBase{pRefCounters},
     m_pSerializationDevice{pDevice}
@@ -68,23 +100,19 @@ ArchiverImpl::~ArchiverImpl()
 {
 }
 
-Bool ArchiverImpl::SerializeToBlob(IDataBlob** ppBlob)
+void ArchiverImpl::InitArchive(DeviceObjectArchive& Archive)
 {
-    DEV_CHECK_ERR(ppBlob != nullptr, "ppBlob must not be null");
-    if (ppBlob == nullptr)
-        return false;
-
-    DeviceObjectArchive Archive;
-
-    // A hash map that maps shader byte code to the index in the archive, for each device type
-    std::array<std::unordered_map<size_t, Uint32>, static_cast<size_t>(DeviceType::Count)> BytecodeHashToIdx;
+    // A hash map that maps shader byte code to the index in the archive, for each device type.
+    // Keys reference the byte code owned by the source objects or by the archive and are compared
+    // by contents, so that different byte code with the same hash is never merged.
+    std::array<std::unordered_map<SerializedData, Uint32, SerializedData::Hasher>, static_cast<size_t>(DeviceType::Count)> BytecodeToIdx;
 
     // Add pipelines and patched shaders
-    for (const auto& pso_it : m_Pipelines)
+    for (const auto* pso_it : GetSortedElements(m_Pipelines, ResourceKeyLess))
     {
-        const auto* Name    = pso_it.first.GetName();
-        const auto  ResType = pso_it.first.GetType();
-        const auto& SrcPSO  = *pso_it.second;
+        const auto* Name    = pso_it->first.GetName();
+        const auto  ResType = pso_it->first.GetType();
+        const auto& SrcPSO  = *pso_it->second;
         const auto& SrcData = SrcPSO.GetData();
         VERIFY_EXPR(SafeStrEqual(Name, SrcPSO.GetDesc().Name));
         VERIFY_EXPR(ResType == PipelineTypeToArchiveResourceType(SrcPSO.GetDesc().PipelineType));
@@ -109,7 +137,7 @@ Bool ArchiverImpl::SerializeToBlob(IDataBlob** ppBlob)
             {
                 VERIFY_EXPR(SrcShader.Data);
 
-                auto it_inserted = BytecodeHashToIdx[device_type].emplace(SrcShader.Hash, StaticCast<Uint32>(DstShaders.size()));
+                auto it_inserted = BytecodeToIdx[device_type].emplace(SerializedData{SrcShader.Data.Ptr(), SrcShader.Data.Size()}, StaticCast<Uint32>(DstShaders.size()));
                 if (it_inserted.second)
                 {
                     // New byte code - add it
@@ -134,10 +162,10 @@ Bool ArchiverImpl::SerializeToBlob(IDataBlob** ppBlob)
     }
 
     // Add resource signatures
-    for (const auto& sign_it : m_Signatures)
+    for (const auto* sign_it : GetSortedElements(m_Signatures, NameKeyLess))
     {
-        const auto* Name    = sign_it.first.GetStr();
-        const auto& SrcSign = *sign_it.second;
+        const auto* Name    = sign_it->first.GetStr();
+        const auto& SrcSign = *sign_it->second;
         VERIFY_EXPR(SafeStrEqual(Name, SrcSign.GetDesc().Name));
         const auto& SrcCommonData = SrcSign.GetCommonData();
 
@@ -153,10 +181,10 @@ Bool ArchiverImpl::SerializeToBlob(IDataBlob** ppBlob)
     }
 
     // Add render passes
-    for (const auto& rp_it : m_RenderPasses)
+    for (const auto* rp_it : GetSortedElements(m_RenderPasses, NameKeyLess))
     {
-        const auto* Name  = rp_it.first.GetStr();
-        const auto& SrcRP = *rp_it.second;
+        const auto* Name  = rp_it->first.GetStr();
+        const auto& SrcRP = *rp_it->second;
         VERIFY_EXPR(SafeStrEqual(Name, SrcRP.GetDesc().Name));
         const auto& SrcData = SrcRP.GetCommonData();
 
@@ -165,10 +193,10 @@ Bool ArchiverImpl::SerializeToBlob(IDataBlob** ppBlob)
     }
 
     // Add standalone shaders
-    for (const auto& shader_it : m_Shaders)
+    for (const auto* shader_it : GetSortedElements(m_Shaders, NameKeyLess))
     {
-        const auto* Name      = shader_it.first.GetStr();
-        const auto& SrcShader = *shader_it.second;
+        const auto* Name      = shader_it->first.GetStr();
+        const auto& SrcShader = *shader_it->second;
         VERIFY_EXPR(SafeStrEqual(Name, SrcShader.GetDesc().Name));
 
         auto& DstData  = Archive.GetResourceData(ResourceType::StandaloneShader, Name);
@@ -181,7 +209,7 @@ Bool ArchiverImpl::SerializeToBlob(IDataBlob** ppBlob)
                 continue;
 
             auto& DstShaders  = Archive.GetDeviceShaders(static_cast<DeviceType>(device_type));
-            auto  it_inserted = BytecodeHashToIdx[device_type].emplace(DeviceData.GetHash(), StaticCast<Uint32>(DstShaders.size()));
+            auto  it_inserted = BytecodeToIdx[device_type].emplace(SerializedData{DeviceData.Ptr(), DeviceData.Size()}, StaticCast<Uint32>(DstShaders.size()));
             if (it_inserted.second)
             {
                 // New byte code
@@ -201,7 +229,16 @@ Bool ArchiverImpl::SerializeToBlob(IDataBlob** ppBlob)
             VERIFY_EXPR(Ser.IsEnded());
         }
     }
+}
 
+Bool ArchiverImpl::SerializeToBlob(IDataBlob** ppBlob)
+{
+    DEV_CHECK_ERR(ppBlob != nullptr, "ppBlob must not be null");
+    if (ppBlob == nullptr)
+        return false;
+
+    DeviceObjectArchive Archive;
+    InitArchive(Archive);
     Archive.Serialize(ppBlob);
 
     return *ppBlob != nullptr;
@@ -214,11 +251,12 @@ Bool ArchiverImpl::SerializeToStream(IFileStream* pStream)
     if (pStream == nullptr)
         return false;
 
-    RefCntAutoPtr<IDataBlob> pDataBlob;
-    if (!SerializeToBlob(&pDataBlob))
-        return false;
+    // Write the archive directly to the stream rather than through an intermediate
+    // blob that would hold a copy of all data blocks.
+    DeviceObjectArchive Archive;
+    InitArchive(Archive);
 
-    return pStream->Write(pDataBlob->GetConstDataPtr(), pDataBlob->GetSize());
+    return Archive.Serialize(pStream);
 }
 
 template <typename ObjectImplType,
@@ -64,13 +64,15 @@ struct CompiledShaderD3D11 final : SerializedShaderImpl::CompiledShader
 
     virtual SerializedData Serialize(ShaderCreateInfo ShaderCI) const override final
     {
-        const auto& pBytecode = ShaderD3D11.GetD3DBytecode();
+        // Pack the shader resources together with the byte code so that
+        // the resources do not need to be reflected when the shader is unpacked.
+        auto pBytecode = ShaderD3DBase::PackBytecodeWithResources(ShaderD3D11.GetD3DBytecode(), ShaderD3D11.GetShaderResources().get());
 
         ShaderCI.Source       = nullptr;
         ShaderCI.FilePath     = nullptr;
         ShaderCI.Macros       = nullptr;
-        ShaderCI.ByteCode     = pBytecode->GetBufferPointer();
-        ShaderCI.ByteCodeSize = pBytecode->GetBufferSize();
+        ShaderCI.ByteCode     = pBytecode->GetConstDataPtr();
+        ShaderCI.ByteCodeSize = pBytecode->GetSize();
         return SerializedShaderImpl::SerializeCreateInfo(ShaderCI);
     }
 
@@ -183,12 +185,23 @@ void SerializedPipelineStateImpl::PatchShadersD3D11(const CreateInfoType& Create
     for (size_t i = 0; i < ShadersD3D11.size(); ++i)
     {
         const auto& pBytecode = ShaderBytecode[i];
-        auto        ShaderCI  = ShaderStages[i].pSerialized->GetCreateInfo();
+        const auto& ShdrDesc  = ShadersD3D11[i]->GetDesc();
+
+        // Resource bindings have been remapped, so reflect the patched byte code
+        const ShaderResourcesD3D11 Resources{
+            pBytecode,
+            ShdrDesc,
+            ShdrDesc.UseCombinedTextureSamplers ? ShdrDesc.CombinedSamplerSuffix : nullptr,
+            false // LoadConstantBufferReflection
+        };
+        auto pBytecodeWithResources = ShaderD3DBase::PackBytecodeWithResources(pBytecode, &Resources);
+
+        auto ShaderCI         = ShaderStages[i].pSerialized->GetCreateInfo();
         ShaderCI.Source       = nullptr;
         ShaderCI.FilePath     = nullptr;
         ShaderCI.Macros       = nullptr;
-        ShaderCI.ByteCode     = pBytecode->GetBufferPointer();
-        ShaderCI.ByteCodeSize = pBytecode->GetBufferSize();
+        ShaderCI.ByteCode     = pBytecodeWithResources->GetConstDataPtr();
+        ShaderCI.ByteCodeSize = pBytecodeWithResources->GetSize();
         SerializeShaderCreateInfo(DeviceType::Direct3D11, ShaderCI);
     }
     VERIFY_EXPR(m_Data.Shaders[static_cast<size_t>(DeviceType::Direct3D11)].size() == ShadersD3D11.size());
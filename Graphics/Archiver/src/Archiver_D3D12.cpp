@@ -53,13 +53,15 @@ struct CompiledShaderD3D12 final : SerializedShaderImpl::CompiledShader
 
     virtual SerializedData Serialize(ShaderCreateInfo ShaderCI) const override final
     {
-        const auto& pBytecode = ShaderD3D12.GetD3DBytecode();
+        // Pack the shader resources together with the byte code so that
+        // the resources do not need to be reflected when the shader is unpacked.
+        auto pBytecode = ShaderD3DBase::PackBytecodeWithResources(ShaderD3D12.GetD3DBytecode(), ShaderD3D12.GetShaderResources().get());
 
         ShaderCI.Source       = nullptr;
         ShaderCI.FilePath     = nullptr;
         ShaderCI.Macros       = nullptr;
-        ShaderCI.ByteCode     = pBytecode->GetBufferPointer();
-        ShaderCI.ByteCodeSize = pBytecode->GetBufferSize();
+        ShaderCI.ByteCode     = pBytecode->GetConstDataPtr();
+        ShaderCI.ByteCodeSize = pBytecode->GetSize();
         return SerializedShaderImpl::SerializeCreateInfo(ShaderCI);
     }
 
@@ -155,12 +157,24 @@ void SerializedPipelineStateImpl::PatchShadersD3D12(const CreateInfoType& Create
         for (size_t i = 0; i < Stage.Count(); ++i)
         {
             const auto& pBytecode = Stage.ByteCodes[i];
-            auto        ShaderCI  = ShaderStages[j].Serialized[i]->GetCreateInfo();
+            const auto& ShdrDesc  = Stage.Shaders[i]->GetDesc();
+
+            // Resource bindings have been remapped, so reflect the patched byte code
+            const ShaderResourcesD3D12 Resources{
+                pBytecode,
+                ShdrDesc,
+                ShdrDesc.UseCombinedTextureSamplers ? ShdrDesc.CombinedSamplerSuffix : nullptr,
+                m_pSerializationDevice->GetD3D12Properties().pDxCompiler,
+                false // LoadConstantBufferReflection
+            };
+            auto pBytecodeWithResources = ShaderD3DBase::PackBytecodeWithResources(pBytecode, &Resources);
+
+            auto ShaderCI         = ShaderStages[j].Serialized[i]->GetCreateInfo();
             ShaderCI.Source       = nullptr;
             ShaderCI.FilePath     = nullptr;
             ShaderCI.Macros       = nullptr;
-            ShaderCI.ByteCode     = pBytecode->GetBufferPointer();
-            ShaderCI.ByteCodeSize = pBytecode->GetBufferSize();
+            ShaderCI.ByteCode     = pBytecodeWithResources->GetConstDataPtr();
+            ShaderCI.ByteCodeSize = pBytecodeWithResources->GetSize();
             SerializeShaderCreateInfo(DeviceType::Direct3D12, ShaderCI);
         }
     }
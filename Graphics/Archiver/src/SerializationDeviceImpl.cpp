@@ -59,8 +59,17 @@ static constexpr ARCHIVE_DEVICE_DATA_FLAGS GetSupportedDeviceFlags()
     return Flags;
 }
 
+static EngineCreateInfo GetEngineCreateInfo(const SerializationDeviceCreateInfo& CreateInfo)
+{
+    EngineCreateInfo EngineCI;
+    // The serialization device uses the shader compilation thread pool to process device types in parallel.
+    EngineCI.pAsyncShaderCompilationThreadPool = CreateInfo.pCompilationThreadPool;
+    EngineCI.NumAsyncShaderCompilationThreads  = CreateInfo.NumCompilationThreads;
+    return EngineCI;
+}
+
 SerializationDeviceImpl::SerializationDeviceImpl(IReferenceCounters* pRefCounters, const SerializationDeviceCreateInfo& CreateInfo) :
-    TBase{pRefCounters, GetRawAllocator(), nullptr, EngineCreateInfo{}, CreateInfo.AdapterInfo},
+    TBase{pRefCounters, GetRawAllocator(), nullptr, GetEngineCreateInfo(CreateInfo), CreateInfo.AdapterInfo},
     m_ValidDeviceFlags{Diligent::GetSupportedDeviceFlags()}
 {
     m_DeviceInfo = CreateInfo.DeviceInfo;
@@ -213,10 +213,8 @@ SerializedPipelineStateImpl::SerializedPipelineStateImpl(IReferenceCounters*
     }
 
     m_Data.Aux.NoShaderReflection = (ArchiveInfo.PSOFlags & PSO_ARCHIVE_FLAG_STRIP_REFLECTION) != 0;
-    while (DeviceBits != 0)
-    {
-        const auto Flag = ExtractLSB(DeviceBits);
 
+    auto PatchShaders = [&](ARCHIVE_DEVICE_DATA_FLAGS Flag) {
         static_assert(ARCHIVE_DEVICE_DATA_FLAG_LAST == ARCHIVE_DEVICE_DATA_FLAG_METAL_IOS, "Please update the switch below to handle the new data type");
         switch (Flag)
         {
@@ -256,8 +254,20 @@ SerializedPipelineStateImpl::SerializedPipelineStateImpl(IReferenceCounters*
                 LOG_ERROR_MESSAGE("Unexpected render device type");
                 break;
         }
+    };
+
+    if (CreateInfo.ResourceSignaturesCount == 0)
+    {
+        // The first device type that requires the default signature creates it, and its description
+        // becomes the common signature description. Process device types serially until the signature
+        // is created so that the archive contents do not depend on the order in which tasks finish.
+        while (DeviceBits != ARCHIVE_DEVICE_DATA_FLAG_NONE && !m_pDefaultSignature)
+            PatchShaders(ExtractLSB(DeviceBits));
     }
 
+    // Patched shaders of every device type are stored separately, so the remaining device types may be processed in parallel.
+    pDevice->ProcessDeviceFlags(DeviceBits, PatchShaders);
+
     if (!m_Data.Common)
     {
         if (CreateInfo.ResourceSignaturesCount == 0)
@@ -38,6 +38,8 @@
 namespace Diligent
 {
 
+DeviceObjectArchive::DeviceType ArchiveDeviceDataFlagToArchiveDeviceType(ARCHIVE_DEVICE_DATA_FLAGS DataTypeFlag);
+
 const INTERFACE_ID SerializedShaderImpl::IID_InternalImpl;
 
 SerializedShaderImpl::SerializedShaderImpl(IReferenceCounters*      pRefCounters,
@@ -71,42 +73,46 @@ SerializedShaderImpl::SerializedShaderImpl(IReferenceCounters*      pRefCounters
         DeviceFlags &= ~ARCHIVE_DEVICE_DATA_FLAG_GLES;
     }
 
-    while (DeviceFlags != ARCHIVE_DEVICE_DATA_FLAG_NONE)
-    {
-        const auto Flag = ExtractLSB(DeviceFlags);
+    // Every device type writes the compiler output to its own blob as device types may be compiled in parallel.
+    std::array<IDataBlob*, static_cast<size_t>(DeviceType::Count)> CompilerOutputs{};
+
+    auto CompileShader = [&](ARCHIVE_DEVICE_DATA_FLAGS Flag) {
+        auto DeviceShaderCI = ShaderCI;
+        if (ShaderCI.ppCompilerOutput != nullptr)
+            DeviceShaderCI.ppCompilerOutput = &CompilerOutputs[static_cast<size_t>(ArchiveDeviceDataFlagToArchiveDeviceType(Flag))];
 
         static_assert(ARCHIVE_DEVICE_DATA_FLAG_LAST == ARCHIVE_DEVICE_DATA_FLAG_METAL_IOS, "Please update the switch below to handle the new device data type");
         switch (Flag)
         {
 #if D3D11_SUPPORTED
             case ARCHIVE_DEVICE_DATA_FLAG_D3D11:
-                CreateShaderD3D11(pRefCounters, ShaderCI);
+                CreateShaderD3D11(pRefCounters, DeviceShaderCI);
                 break;
 #endif
 
 #if D3D12_SUPPORTED
             case ARCHIVE_DEVICE_DATA_FLAG_D3D12:
-                CreateShaderD3D12(pRefCounters, ShaderCI);
+                CreateShaderD3D12(pRefCounters, DeviceShaderCI);
                 break;
 #endif
 
 #if GL_SUPPORTED || GLES_SUPPORTED
             case ARCHIVE_DEVICE_DATA_FLAG_GL:
             case ARCHIVE_DEVICE_DATA_FLAG_GLES:
-                CreateShaderGL(pRefCounters, ShaderCI, Flag == ARCHIVE_DEVICE_DATA_FLAG_GL ? RENDER_DEVICE_TYPE_GL : RENDER_DEVICE_TYPE_GLES);
+                CreateShaderGL(pRefCounters, DeviceShaderCI, Flag == ARCHIVE_DEVICE_DATA_FLAG_GL ? RENDER_DEVICE_TYPE_GL : RENDER_DEVICE_TYPE_GLES);
                 break;
 #endif
 
 #if VULKAN_SUPPORTED
             case ARCHIVE_DEVICE_DATA_FLAG_VULKAN:
-                CreateShaderVk(pRefCounters, ShaderCI);
+                CreateShaderVk(pRefCounters, DeviceShaderCI);
                 break;
 #endif
 
 #if METAL_SUPPORTED
             case ARCHIVE_DEVICE_DATA_FLAG_METAL_MACOS:
             case ARCHIVE_DEVICE_DATA_FLAG_METAL_IOS:
-                CreateShaderMtl(pRefCounters, ShaderCI, Flag == ARCHIVE_DEVICE_DATA_FLAG_METAL_MACOS ? DeviceType::Metal_MacOS : DeviceType::Metal_iOS);
+                CreateShaderMtl(pRefCounters, DeviceShaderCI, Flag == ARCHIVE_DEVICE_DATA_FLAG_METAL_MACOS ? DeviceType::Metal_MacOS : DeviceType::Metal_iOS);
                 break;
 #endif
 
@@ -118,7 +124,31 @@ SerializedShaderImpl::SerializedShaderImpl(IReferenceCounters*      pRefCounters
                 LOG_ERROR_MESSAGE("Unexpected render device type");
                 break;
         }
+    };
+
+    auto ReturnCompilerOutput = [&]() {
+        for (auto* pOutput : CompilerOutputs)
+        {
+            if (pOutput == nullptr)
+                continue;
+
+            // Keep the output of the last device type, which is what serial compilation would return.
+            if (*ShaderCI.ppCompilerOutput != nullptr)
+                (*ShaderCI.ppCompilerOutput)->Release();
+            *ShaderCI.ppCompilerOutput = pOutput;
+        }
+    };
+
+    try
+    {
+        m_pDevice->ProcessDeviceFlags(DeviceFlags, CompileShader);
+    }
+    catch (...)
+    {
+        ReturnCompilerOutput();
+        throw;
     }
+    ReturnCompilerOutput();
 }
 
 SerializedShaderImpl::~SerializedShaderImpl()
@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::CookArchive function
+
+#include <string>
+#include <vector>
+
+#include "Archiver.h"
+
+namespace Diligent
+{
+
+/// Archive cooker attributes.
+struct ArchiveCookerAttribs
+{
+    /// Path to the JSON archive description.
+    std::string DescriptionPath;
+
+    /// Path to the output archive.
+    std::string OutputPath;
+
+    /// Additional shader search directories.
+    std::vector<std::string> ShaderDirectories;
+
+    /// Devices for which the archive is cooked.
+    /// If ARCHIVE_DEVICE_DATA_FLAG_NONE, all devices supported by the archiver are used.
+    ARCHIVE_DEVICE_DATA_FLAGS DeviceFlags = ARCHIVE_DEVICE_DATA_FLAG_NONE;
+
+    /// The number of threads that compile shaders and pipelines.
+    /// If zero, the number of hardware threads is used.
+    Uint32 NumThreads = 0;
+
+    /// Whether to reuse unchanged shaders and pipelines from the previous output archive.
+    bool Incremental = true;
+
+    /// Optional path to the file where the thread pool task trace is written
+    /// in the Chrome trace event format, see Diligent::ThreadPoolTrace.
+    std::string TraceFilePath;
+};
+
+/// Archive cooker statistics.
+struct ArchiveCookerStats
+{
+    /// The number of shaders that were compiled.
+    Uint32 NumShadersCompiled = 0;
+
+    /// The number of pipelines and standalone shaders that were added to the archive.
+    Uint32 NumObjectsCooked = 0;
+
+    /// The number of pipelines and standalone shaders that were copied from the previous archive.
+    Uint32 NumObjectsReused = 0;
+};
+
+/// Compiles the shaders and pipelines described by the archive description and writes the archive.
+
+/// In incremental mode, the cooker stores the content hashes of all pipelines and standalone shaders
+/// in a file next to the output archive (<OutputPath>.hashes). The hash of a pipeline covers its
+/// description, the descriptions of its resource signatures and render pass, and the sources of its
+/// shaders including all included files. Pipelines and shaders whose hashes have not changed since
+/// the previous run are copied from the previous archive without compiling their shaders.
+///
+/// \return     true if the archive was successfully written, and false otherwise.
+bool CookArchive(const ArchiveCookerAttribs& Attribs, ArchiveCookerStats* pStats = nullptr);
+
+} // namespace Diligent
@@ -0,0 +1,134 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ArchiveDescription struct
+
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "GraphicsTypesX.hpp"
+#include "Shader.h"
+
+namespace Diligent
+{
+
+/// Describes a shader that is compiled by the archiver.
+struct ShaderInfo
+{
+    std::string            Name;
+    SHADER_TYPE            Type = SHADER_TYPE_UNKNOWN;
+    std::string            FilePath;
+    std::string            EntryPoint     = "main";
+    SHADER_SOURCE_LANGUAGE SourceLanguage = SHADER_SOURCE_LANGUAGE_DEFAULT;
+    SHADER_COMPILER        ShaderCompiler = SHADER_COMPILER_DEFAULT;
+
+    bool        UseCombinedTextureSamplers = false;
+    std::string CombinedSamplerSuffix      = "_sampler";
+
+    std::vector<std::pair<std::string, std::string>> Macros;
+
+    /// Whether the shader is added to the archive as a standalone shader.
+    /// Shaders that are only used by pipelines do not need to be standalone.
+    bool Standalone = false;
+};
+
+/// Describes a pipeline resource signature.
+struct ResourceSignatureInfo
+{
+    PipelineResourceSignatureDescX Desc;
+
+    // The desc does not keep a copy of the suffix string
+    std::string CombinedSamplerSuffix = "_sampler";
+};
+
+/// Describes a render pass.
+struct RenderPassInfo
+{
+    struct Subpass
+    {
+        std::vector<AttachmentReference> Inputs;
+        std::vector<AttachmentReference> RenderTargets;
+        std::vector<AttachmentReference> Resolves;
+        std::vector<Uint32>              Preserves;
+
+        bool                HasDepthStencil = false;
+        AttachmentReference DepthStencil;
+    };
+
+    std::string Name;
+
+    std::vector<RenderPassAttachmentDesc> Attachments;
+    std::vector<Subpass>                  Subpasses;
+};
+
+/// Describes a graphics or a compute pipeline.
+struct PipelineInfo
+{
+    std::string   Name;
+    PIPELINE_TYPE Type = PIPELINE_TYPE_GRAPHICS;
+
+    /// Shader names for every stage.
+    std::vector<std::pair<SHADER_TYPE, std::string>> Shaders;
+
+    /// Resource signature names.
+    std::vector<std::string> Signatures;
+
+    PipelineResourceLayoutDescX ResourceLayout;
+
+    // Graphics pipeline state. InputLayout and pRenderPass members are set by the archiver.
+    GraphicsPipelineDesc GraphicsPipeline;
+    InputLayoutDescX     InputLayout;
+    std::string          RenderPass;
+};
+
+/// Archive description that is loaded from a JSON file.
+
+/// See the readme file for the description format.
+struct ArchiveDescription
+{
+    /// Shader search directories, relative to the description file.
+    std::vector<std::string> ShaderDirectories;
+
+    std::vector<ShaderInfo>            Shaders;
+    std::vector<ResourceSignatureInfo> Signatures;
+    std::vector<RenderPassInfo>        RenderPasses;
+    std::vector<PipelineInfo>          Pipelines;
+
+    /// Loads the description from the file.
+    /// Throws std::runtime_error if the file can't be read or is invalid.
+    static ArchiveDescription Load(const char* FilePath) noexcept(false);
+
+    /// Parses the description from the JSON text.
+    static ArchiveDescription Parse(const char* pData, size_t Size) noexcept(false);
+};
+
+} // namespace Diligent
@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::JSONValue class
+
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// A minimal read-only JSON document model used to parse archive descriptions.
+
+/// The parser supports the complete JSON grammar, and additionally allows
+/// C++-style line comments. Object members are kept in the order they appear
+/// in the source. All errors are reported by throwing std::runtime_error.
+class JSONValue
+{
+public:
+    enum TYPE : Uint8
+    {
+        TYPE_NULL,
+        TYPE_BOOL,
+        TYPE_NUMBER,
+        TYPE_STRING,
+        TYPE_ARRAY,
+        TYPE_OBJECT
+    };
+
+    using MemberType = std::pair<std::string, JSONValue>;
+
+    JSONValue() noexcept {}
+
+    /// Parses the JSON document.
+    static JSONValue Parse(const char* pData, size_t Size) noexcept(false);
+
+    TYPE GetType() const { return m_Type; }
+
+    /// Returns the source line where the value starts, for error messages.
+    Uint32 GetLine() const { return m_Line; }
+
+    bool IsNull() const { return m_Type == TYPE_NULL; }
+    bool IsObject() const { return m_Type == TYPE_OBJECT; }
+    bool IsArray() const { return m_Type == TYPE_ARRAY; }
+    bool IsString() const { return m_Type == TYPE_STRING; }
+
+    bool               GetBool() const noexcept(false);
+    double             GetNumber() const noexcept(false);
+    Uint32             GetUint() const noexcept(false);
+    const std::string& GetString() const noexcept(false);
+
+    const std::vector<JSONValue>&  GetArray() const noexcept(false);
+    const std::vector<MemberType>& GetMembers() const noexcept(false);
+
+    /// Returns the object member with the given name, or null if there is no such member.
+    const JSONValue* Find(const char* Name) const noexcept(false);
+
+private:
+    class Parser;
+
+    void CheckType(TYPE Type) const noexcept(false);
+
+    TYPE   m_Type = TYPE_NULL;
+    Uint32 m_Line = 0;
+
+    bool        m_Bool   = false;
+    double      m_Number = 0;
+    std::string m_String;
+
+    std::vector<JSONValue>  m_Array;
+    std::vector<MemberType> m_Members;
+};
+
+} // namespace Diligent
@@ -0,0 +1,747 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ArchiveCooker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "ArchiveDescription.hpp"
+#include "ArchiverFactory.h"
+#include "ArchiverFactoryLoader.h"
+#include "DeviceObjectArchive.hpp"
+#include "XXH128Hasher.hpp"
+#include "ThreadPool.hpp"
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+#include "BufferedFileStream.hpp"
+#include "MemoryMappedFileDataBlob.hpp"
+#include "DataBlobImpl.hpp"
+#include "GraphicsAccessories.hpp"
+#include "BasicMath.hpp"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+using ResourceType = DeviceObjectArchive::ResourceType;
+
+// Bump the version when the hashed data changes to invalidate all previous hashes
+const char HashFileHeader[] = "DiligentArchiverCLI content hashes v1";
+
+// Maps "<resource type>:<name>" to the content hash of the resource
+using ContentHashes = std::map<std::string, XXH128Hash>;
+
+std::string GetHashKey(ResourceType Type, const std::string& Name)
+{
+    return std::to_string(static_cast<Uint32>(Type)) + ':' + Name;
+}
+
+std::string HashToString(const XXH128Hash& Hash)
+{
+    char Str[33] = {};
+    snprintf(Str, sizeof(Str), "%016llx%016llx",
+             static_cast<unsigned long long>(Hash.HighPart),
+             static_cast<unsigned long long>(Hash.LowPart));
+    return Str;
+}
+
+bool StringToHash(const std::string& Str, XXH128Hash& Hash)
+{
+    if (Str.length() != 32 || Str.find_first_not_of("0123456789abcdef") != std::string::npos)
+        return false;
+
+    Hash.HighPart = strtoull(Str.substr(0, 16).c_str(), nullptr, 16);
+    Hash.LowPart  = strtoull(Str.substr(16).c_str(), nullptr, 16);
+    return true;
+}
+
+// Returns empty hashes if the file does not exist or is not valid, so that everything is cooked from scratch.
+ContentHashes LoadContentHashes(const std::string& FilePath)
+{
+    ContentHashes Hashes;
+    if (!FileSystem::FileExists(FilePath.c_str()))
+        return Hashes;
+
+    FileWrapper File{FilePath.c_str(), EFileAccessMode::Read};
+    auto        pData = DataBlobImpl::Create();
+    if (!File || !File->Read(pData))
+    {
+        LOG_WARNING_MESSAGE("Failed to read content hashes from '", FilePath, "'. All objects will be cooked.");
+        return Hashes;
+    }
+
+    std::istringstream Stream{std::string{pData->GetConstDataPtr<char>(), pData->GetSize()}};
+
+    std::string Line;
+    if (!std::getline(Stream, Line) || Line != HashFileHeader)
+    {
+        LOG_INFO_MESSAGE("Content hashes in '", FilePath, "' were produced by a different version. All objects will be cooked.");
+        return Hashes;
+    }
+
+    while (std::getline(Stream, Line))
+    {
+        // <hash> <key>
+        XXH128Hash Hash;
+        if (Line.length() < 34 || Line[32] != ' ' || !StringToHash(Line.substr(0, 32), Hash))
+        {
+            LOG_WARNING_MESSAGE("Content hashes in '", FilePath, "' are corrupted. All objects will be cooked.");
+            return {};
+        }
+        Hashes.emplace(Line.substr(33), Hash);
+    }
+    return Hashes;
+}
+
+bool SaveContentHashes(const std::string& FilePath, const ContentHashes& Hashes)
+{
+    std::string Data = HashFileHeader;
+    Data += '\n';
+    for (const auto& it : Hashes)
+    {
+        Data += HashToString(it.second);
+        Data += ' ';
+        Data += it.first;
+        Data += '\n';
+    }
+
+    FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+    if (!File || !File->Write(Data.data(), Data.size()))
+    {
+        LOG_ERROR_MESSAGE("Failed to write content hashes to '", FilePath, "'");
+        return false;
+    }
+    return true;
+}
+
+template <typename HandlerType>
+void ProcessInParallel(IThreadPool* pThreadPool, size_t NumItems, HandlerType&& Handler)
+{
+    if (NumItems <= 1 || pThreadPool == nullptr)
+    {
+        for (size_t i = 0; i < NumItems; ++i)
+            Handler(i);
+        return;
+    }
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks(NumItems);
+    for (size_t i = 0; i < NumItems; ++i)
+    {
+        Tasks[i] = EnqueueAsyncWork(pThreadPool,
+                                    [&Handler, i](Uint32 /*ThreadId*/) {
+                                        Handler(i);
+                                    });
+    }
+    for (auto& pTask : Tasks)
+        pTask->WaitForCompletion();
+}
+
+ResourceType GetPipelineResourceType(PIPELINE_TYPE Type)
+{
+    // Mesh pipelines are serialized as graphics pipelines
+    return Type == PIPELINE_TYPE_COMPUTE ? ResourceType::ComputePipeline : ResourceType::GraphicsPipeline;
+}
+
+class ArchiveCooker
+{
+public:
+    explicit ArchiveCooker(const ArchiveCookerAttribs& Attribs) :
+        m_Attribs{Attribs}
+    {}
+
+    bool Cook(ArchiveCookerStats& Stats) noexcept(false);
+
+private:
+    bool CreateDevice();
+    void CreateShaderSourceFactory();
+    bool CreateSignaturesAndRenderPasses();
+    void ComputeHashes();
+    void LoadPreviousArchive();
+    bool CompileShaders(const std::vector<size_t>& ShaderIndices);
+    bool CreatePipelines(const std::vector<size_t>& PipelineIndices);
+    bool WriteArchive();
+
+    ShaderCreateInfo GetShaderCreateInfo(const ShaderInfo& Shader, std::vector<ShaderMacro>& Macros) const;
+
+    template <typename PSOCreateInfoType>
+    void InitPipelineCreateInfo(const PipelineInfo&                       Pipeline,
+                                PSOCreateInfoType&                        PSOCreateInfo,
+                                std::vector<IPipelineResourceSignature*>& Signatures) const;
+
+    bool IsReused(ResourceType Type, const std::string& Name, const XXH128Hash& Hash) const;
+
+private:
+    const ArchiveCookerAttribs& m_Attribs;
+
+    ArchiveDescription        m_Desc;
+    ARCHIVE_DEVICE_DATA_FLAGS m_DeviceFlags = ARCHIVE_DEVICE_DATA_FLAG_NONE;
+
+    IArchiverFactory*                              m_pArchiverFactory = nullptr;
+    RefCntAutoPtr<ISerializationDevice>            m_pDevice;
+    RefCntAutoPtr<IArchiver>                       m_pArchiver;
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> m_pShaderSourceFactory;
+    RefCntAutoPtr<IThreadPool>                     m_pThreadPool;
+
+    std::unordered_map<std::string, RefCntAutoPtr<IPipelineResourceSignature>> m_Signatures;
+    std::unordered_map<std::string, RefCntAutoPtr<IRenderPass>>                m_RenderPasses;
+    std::unordered_map<std::string, size_t>                                    m_ShaderIndices;
+
+    // Indexed like the shaders and pipelines in the description
+    std::vector<RefCntAutoPtr<IShader>> m_Shaders;
+    std::vector<XXH128Hash>             m_ShaderHashes;
+    std::vector<XXH128Hash>             m_PipelineHashes;
+
+    ContentHashes m_Hashes;
+    ContentHashes m_PrevHashes;
+
+    RefCntAutoPtr<IDataBlob>             m_pPrevArchiveData;
+    std::unique_ptr<DeviceObjectArchive> m_pPrevArchive;
+
+    // Resources that are copied from the previous archive
+    std::unordered_set<std::string> m_ReusedKeys;
+};
+
+bool ArchiveCooker::CreateDevice()
+{
+#if EXPLICITLY_LOAD_ARCHIVER_FACTORY_DLL
+    auto GetArchiverFactory = LoadArchiverFactory();
+    if (GetArchiverFactory != nullptr)
+        m_pArchiverFactory = GetArchiverFactory();
+#else
+    m_pArchiverFactory = GetArchiverFactory();
+#endif
+    if (m_pArchiverFactory == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to get the archiver factory");
+        return false;
+    }
+
+    // Shaders and pipelines are processed in parallel by the cooker, so the device does not need its own threads
+    SerializationDeviceCreateInfo DeviceCI;
+    m_pArchiverFactory->CreateSerializationDevice(DeviceCI, &m_pDevice);
+    if (!m_pDevice)
+    {
+        LOG_ERROR_MESSAGE("Failed to create the serialization device");
+        return false;
+    }
+
+    const auto SupportedFlags = m_pDevice->GetSupportedDeviceFlags();
+    m_DeviceFlags             = m_Attribs.DeviceFlags != ARCHIVE_DEVICE_DATA_FLAG_NONE ? m_Attribs.DeviceFlags : SupportedFlags;
+    if ((m_DeviceFlags & ~SupportedFlags) != 0)
+    {
+        for (auto Flags = m_DeviceFlags & ~SupportedFlags; Flags != 0;)
+        {
+            const auto Flag = ExtractLSB(Flags);
+            LOG_ERROR_MESSAGE(GetArchiveDeviceDataFlagString(Flag), " is not supported by this build of the archiver");
+        }
+        return false;
+    }
+
+    m_pArchiverFactory->CreateArchiver(m_pDevice, &m_pArchiver);
+    if (!m_pArchiver)
+    {
+        LOG_ERROR_MESSAGE("Failed to create the archiver");
+        return false;
+    }
+
+    const auto NumThreads = m_Attribs.NumThreads != 0 ? m_Attribs.NumThreads : std::max(std::thread::hardware_concurrency(), 1u);
+    if (NumThreads > 1)
+    {
+        ThreadPoolCreateInfo ThreadPoolCI;
+        ThreadPoolCI.NumThreads = NumThreads;
+        if (!m_Attribs.TraceFilePath.empty())
+            ThreadPoolCI.TraceCapacity = 4096;
+        m_pThreadPool = CreateThreadPool(ThreadPoolCI);
+    }
+
+    return true;
+}
+
+void ArchiveCooker::CreateShaderSourceFactory()
+{
+    // Directories in the description are relative to the description file
+    std::string DescDir;
+    FileSystem::GetPathComponents(m_Attribs.DescriptionPath, &DescDir, nullptr);
+
+    std::string SearchDirectories;
+    auto        AddDirectory = [&SearchDirectories](const std::string& Dir) {
+        if (!SearchDirectories.empty())
+            SearchDirectories += ';';
+        SearchDirectories += Dir;
+    };
+
+    for (const auto& Dir : m_Desc.ShaderDirectories)
+    {
+        if (FileSystem::IsPathAbsolute(Dir.c_str()) || DescDir.empty())
+            AddDirectory(Dir);
+        else
+            AddDirectory(DescDir + FileSystem::SlashSymbol + Dir);
+    }
+    for (const auto& Dir : m_Attribs.ShaderDirectories)
+        AddDirectory(Dir);
+    AddDirectory(DescDir.empty() ? "." : DescDir);
+
+    m_pArchiverFactory->CreateDefaultShaderSourceStreamFactory(SearchDirectories.c_str(), &m_pShaderSourceFactory);
+}
+
+bool ArchiveCooker::CreateSignaturesAndRenderPasses()
+{
+    // Signatures and render passes do not require compilation, so they are always recreated
+    for (auto& Signature : m_Desc.Signatures)
+    {
+        Signature.Desc.CombinedSamplerSuffix = Signature.CombinedSamplerSuffix.c_str();
+
+        ResourceSignatureArchiveInfo ArchiveInfo;
+        ArchiveInfo.DeviceFlags = m_DeviceFlags;
+
+        RefCntAutoPtr<IPipelineResourceSignature> pSignature;
+        m_pDevice->CreatePipelineResourceSignature(Signature.Desc, ArchiveInfo, &pSignature);
+        if (!pSignature || !m_pArchiver->AddPipelineResourceSignature(pSignature))
+        {
+            LOG_ERROR_MESSAGE("Failed to create resource signature '", Signature.Desc.Name, "'");
+            return false;
+        }
+        m_Signatures.emplace(Signature.Desc.Name, std::move(pSignature));
+    }
+
+    for (const auto& RenderPass : m_Desc.RenderPasses)
+    {
+        std::vector<SubpassDesc> Subpasses(RenderPass.Subpasses.size());
+        for (size_t i = 0; i < Subpasses.size(); ++i)
+        {
+            const auto& Src = RenderPass.Subpasses[i];
+            auto&       Dst = Subpasses[i];
+
+            Dst.InputAttachmentCount        = static_cast<Uint32>(Src.Inputs.size());
+            Dst.pInputAttachments           = Src.Inputs.data();
+            Dst.RenderTargetAttachmentCount = static_cast<Uint32>(Src.RenderTargets.size());
+            Dst.pRenderTargetAttachments    = Src.RenderTargets.data();
+            Dst.pResolveAttachments         = !Src.Resolves.empty() ? Src.Resolves.data() : nullptr;
+            Dst.pDepthStencilAttachment     = Src.HasDepthStencil ? &Src.DepthStencil : nullptr;
+            Dst.PreserveAttachmentCount     = static_cast<Uint32>(Src.Preserves.size());
+            Dst.pPreserveAttachments        = Src.Preserves.data();
+        }
+
+        RenderPassDesc Desc;
+        Desc.Name            = RenderPass.Name.c_str();
+        Desc.AttachmentCount = static_cast<Uint32>(RenderPass.Attachments.size());
+        Desc.pAttachments    = RenderPass.Attachments.data();
+        Desc.SubpassCount    = static_cast<Uint32>(Subpasses.size());
+        Desc.pSubpasses      = Subpasses.data();
+
+        RefCntAutoPtr<IRenderPass> pRenderPass;
+        m_pDevice->CreateRenderPass(Desc, &pRenderPass);
+        if (!pRenderPass)
+        {
+            LOG_ERROR_MESSAGE("Failed to create render pass '", RenderPass.Name, "'");
+            return false;
+        }
+        m_RenderPasses.emplace(RenderPass.Name, std::move(pRenderPass));
+    }
+
+    return true;
+}
+
+ShaderCreateInfo ArchiveCooker::GetShaderCreateInfo(const ShaderInfo& Shader, std::vector<ShaderMacro>& Macros) const
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Desc.Name                       = Shader.Name.c_str();
+    ShaderCI.Desc.ShaderType                 = Shader.Type;
+    ShaderCI.Desc.UseCombinedTextureSamplers = Shader.UseCombinedTextureSamplers;
+    ShaderCI.Desc.CombinedSamplerSuffix      = Shader.CombinedSamplerSuffix.c_str();
+    ShaderCI.FilePath                        = Shader.FilePath.c_str();
+    ShaderCI.EntryPoint                      = Shader.EntryPoint.c_str();
+    ShaderCI.SourceLanguage                  = Shader.SourceLanguage;
+    ShaderCI.ShaderCompiler                  = Shader.ShaderCompiler;
+    ShaderCI.pShaderSourceStreamFactory      = m_pShaderSourceFactory.RawPtr<IShaderSourceInputStreamFactory>();
+
+    if (!Shader.Macros.empty())
+    {
+        Macros.clear();
+        for (const auto& Macro : Shader.Macros)
+            Macros.emplace_back(Macro.first.c_str(), Macro.second.c_str());
+        Macros.emplace_back();
+        ShaderCI.Macros = Macros.data();
+    }
+
+    return ShaderCI;
+}
+
+template <typename PSOCreateInfoType>
+void ArchiveCooker::InitPipelineCreateInfo(const PipelineInfo&                       Pipeline,
+                                           PSOCreateInfoType&                        PSOCreateInfo,
+                                           std::vector<IPipelineResourceSignature*>& Signatures) const
+{
+    PSOCreateInfo.PSODesc.Name           = Pipeline.Name.c_str();
+    PSOCreateInfo.PSODesc.PipelineType   = Pipeline.Type;
+    PSOCreateInfo.PSODesc.ResourceLayout = Pipeline.ResourceLayout;
+
+    Signatures.clear();
+    for (const auto& Name : Pipeline.Signatures)
+        Signatures.push_back(m_Signatures.find(Name)->second.RawPtr<IPipelineResourceSignature>());
+    PSOCreateInfo.ppResourceSignatures    = !Signatures.empty() ? Signatures.data() : nullptr;
+    PSOCreateInfo.ResourceSignaturesCount = static_cast<Uint32>(Signatures.size());
+}
+
+void ArchiveCooker::ComputeHashes()
+{
+    // Hashing reads all shader sources and includes, so it is done once for every shader
+    m_ShaderHashes.resize(m_Desc.Shaders.size());
+    ProcessInParallel(m_pThreadPool, m_Desc.Shaders.size(), [this](size_t i) {
+        std::vector<ShaderMacro> Macros;
+        const auto               ShaderCI = GetShaderCreateInfo(m_Desc.Shaders[i], Macros);
+
+        XXH128State Hasher;
+        Hasher.Update(m_DeviceFlags, ShaderCI);
+        m_ShaderHashes[i] = Hasher.Digest();
+    });
+
+    for (size_t i = 0; i < m_Desc.Shaders.size(); ++i)
+    {
+        const auto& Shader = m_Desc.Shaders[i];
+        m_ShaderIndices.emplace(Shader.Name, i);
+        if (Shader.Standalone)
+            m_Hashes.emplace(GetHashKey(ResourceType::StandaloneShader, Shader.Name), m_ShaderHashes[i]);
+    }
+
+    m_PipelineHashes.resize(m_Desc.Pipelines.size());
+    for (size_t i = 0; i < m_Desc.Pipelines.size(); ++i)
+    {
+        const auto& Pipeline = m_Desc.Pipelines[i];
+
+        XXH128State Hasher;
+        Hasher.Update(m_DeviceFlags);
+
+        // Shaders are not set in the create info, so their hashes are added explicitly
+        std::vector<IPipelineResourceSignature*> Signatures;
+        if (Pipeline.Type == PIPELINE_TYPE_COMPUTE)
+        {
+            ComputePipelineStateCreateInfo PSOCreateInfo;
+            InitPipelineCreateInfo(Pipeline, PSOCreateInfo, Signatures);
+            Hasher.Update(PSOCreateInfo);
+        }
+        else
+        {
+            GraphicsPipelineStateCreateInfo PSOCreateInfo;
+            InitPipelineCreateInfo(Pipeline, PSOCreateInfo, Signatures);
+            PSOCreateInfo.GraphicsPipeline             = Pipeline.GraphicsPipeline;
+            PSOCreateInfo.GraphicsPipeline.InputLayout = Pipeline.InputLayout;
+            if (!Pipeline.RenderPass.empty())
+                PSOCreateInfo.GraphicsPipeline.pRenderPass = m_RenderPasses.find(Pipeline.RenderPass)->second;
+            Hasher.Update(PSOCreateInfo);
+        }
+
+        for (const auto& Stage : Pipeline.Shaders)
+        {
+            const auto& ShaderHash = m_ShaderHashes[m_ShaderIndices.find(Stage.second)->second];
+            Hasher.Update(Stage.first, ShaderHash.LowPart, ShaderHash.HighPart);
+        }
+
+        m_PipelineHashes[i] = Hasher.Digest();
+        m_Hashes.emplace(GetHashKey(GetPipelineResourceType(Pipeline.Type), Pipeline.Name), m_PipelineHashes[i]);
+    }
+}
+
+void ArchiveCooker::LoadPreviousArchive()
+{
+    if (!m_Attribs.Incremental || !FileSystem::FileExists(m_Attribs.OutputPath.c_str()))
+        return;
+
+    m_PrevHashes = LoadContentHashes(m_Attribs.OutputPath + ".hashes");
+    if (m_PrevHashes.empty())
+        return;
+
+    try
+    {
+        // The archive is memory-mapped so that only the reused resources are read
+        m_pPrevArchiveData = MemoryMappedFileDataBlob::Create(m_Attribs.OutputPath.c_str(), /*ReadOnly = */ true);
+        if (m_pPrevArchiveData)
+            m_pPrevArchive = std::make_unique<DeviceObjectArchive>(m_pPrevArchiveData);
+    }
+    catch (...)
+    {
+        LOG_WARNING_MESSAGE("Failed to load the previous archive '", m_Attribs.OutputPath, "'. All objects will be cooked.");
+        m_pPrevArchive.reset();
+        m_pPrevArchiveData.Release();
+    }
+}
+
+bool ArchiveCooker::IsReused(ResourceType Type, const std::string& Name, const XXH128Hash& Hash) const
+{
+    if (!m_pPrevArchive)
+        return false;
+
+    auto hash_it = m_PrevHashes.find(GetHashKey(Type, Name));
+    if (hash_it == m_PrevHashes.end() || !(hash_it->second == Hash))
+        return false;
+
+    const auto& PrevResources = m_pPrevArchive->GetNamedResources();
+    return PrevResources.find(DeviceObjectArchive::NamedResourceKey{Type, Name.c_str()}) != PrevResources.end();
+}
+
+bool ArchiveCooker::CompileShaders(const std::vector<size_t>& ShaderIndices)
+{
+    std::atomic<bool> Succeeded{true};
+    ProcessInParallel(m_pThreadPool, ShaderIndices.size(), [&](size_t i) {
+        const auto&              Shader = m_Desc.Shaders[ShaderIndices[i]];
+        std::vector<ShaderMacro> Macros;
+        const auto               ShaderCI = GetShaderCreateInfo(Shader, Macros);
+
+        ShaderArchiveInfo ArchiveInfo;
+        ArchiveInfo.DeviceFlags = m_DeviceFlags;
+
+        RefCntAutoPtr<IShader> pShader;
+        m_pDevice->CreateShader(ShaderCI, ArchiveInfo, &pShader);
+        if (!pShader)
+        {
+            LOG_ERROR_MESSAGE("Failed to compile shader '", Shader.Name, "'");
+            Succeeded.store(false);
+            return;
+        }
+
+        if (Shader.Standalone && !m_ReusedKeys.count(GetHashKey(ResourceType::StandaloneShader, Shader.Name)))
+        {
+            if (!m_pArchiver->AddShader(pShader))
+                Succeeded.store(false);
+        }
+
+        m_Shaders[ShaderIndices[i]] = std::move(pShader);
+    });
+    return Succeeded.load();
+}
+
+bool ArchiveCooker::CreatePipelines(const std::vector<size_t>& PipelineIndices)
+{
+    std::atomic<bool> Succeeded{true};
+    ProcessInParallel(m_pThreadPool, PipelineIndices.size(), [&](size_t i) {
+        const auto& Pipeline = m_Desc.Pipelines[PipelineIndices[i]];
+
+        auto GetShader = [&Pipeline, this](SHADER_TYPE Type) -> IShader* {
+            for (const auto& Stage : Pipeline.Shaders)
+            {
+                if (Stage.first == Type)
+                    return m_Shaders[m_ShaderIndices.find(Stage.second)->second];
+            }
+            return nullptr;
+        };
+
+        PipelineStateArchiveInfo ArchiveInfo;
+        ArchiveInfo.DeviceFlags = m_DeviceFlags;
+
+        std::vector<IPipelineResourceSignature*> Signatures;
+        RefCntAutoPtr<IPipelineState>            pPSO;
+        if (Pipeline.Type == PIPELINE_TYPE_COMPUTE)
+        {
+            ComputePipelineStateCreateInfo PSOCreateInfo;
+            InitPipelineCreateInfo(Pipeline, PSOCreateInfo, Signatures);
+            PSOCreateInfo.pCS = GetShader(SHADER_TYPE_COMPUTE);
+            m_pDevice->CreateComputePipelineState(PSOCreateInfo, ArchiveInfo, &pPSO);
+        }
+        else
+        {
+            GraphicsPipelineStateCreateInfo PSOCreateInfo;
+            InitPipelineCreateInfo(Pipeline, PSOCreateInfo, Signatures);
+            PSOCreateInfo.GraphicsPipeline             = Pipeline.GraphicsPipeline;
+            PSOCreateInfo.GraphicsPipeline.InputLayout = Pipeline.InputLayout;
+            if (!Pipeline.RenderPass.empty())
+                PSOCreateInfo.GraphicsPipeline.pRenderPass = m_RenderPasses.find(Pipeline.RenderPass)->second;
+
+            PSOCreateInfo.pVS = GetShader(SHADER_TYPE_VERTEX);
+            PSOCreateInfo.pPS = GetShader(SHADER_TYPE_PIXEL);
+            PSOCreateInfo.pGS = GetShader(SHADER_TYPE_GEOMETRY);
+            PSOCreateInfo.pHS = GetShader(SHADER_TYPE_HULL);
+            PSOCreateInfo.pDS = GetShader(SHADER_TYPE_DOMAIN);
+            PSOCreateInfo.pAS = GetShader(SHADER_TYPE_AMPLIFICATION);
+            PSOCreateInfo.pMS = GetShader(SHADER_TYPE_MESH);
+            m_pDevice->CreateGraphicsPipelineState(PSOCreateInfo, ArchiveInfo, &pPSO);
+        }
+
+        if (!pPSO || !m_pArchiver->AddPipelineState(pPSO))
+        {
+            LOG_ERROR_MESSAGE("Failed to create pipeline '", Pipeline.Name, "'");
+            Succeeded.store(false);
+        }
+    });
+    return Succeeded.load();
+}
+
+bool ArchiveCooker::WriteArchive()
+{
+    RefCntAutoPtr<IDataBlob> pNewData;
+    if (!m_pArchiver->SerializeToBlob(&pNewData))
+    {
+        LOG_ERROR_MESSAGE("Failed to serialize the archive");
+        return false;
+    }
+
+    DeviceObjectArchive Archive;
+    if (m_pPrevArchive)
+    {
+        // Copy the reused resources along with their shaders. Unreferenced shaders of the resources
+        // that were removed or changed are not copied. All copied data is owned by the new archive.
+        // Render passes are only serialized with the pipelines that use them, so the render passes
+        // of the reused pipelines are copied as well. They are overridden by the new archive.
+        Archive.Merge(*m_pPrevArchive, /*OverrideExisting = */ false,
+                      [this](ResourceType Type, const char* Name) {
+                          if (Type == ResourceType::RenderPass)
+                              return m_RenderPasses.count(Name) != 0;
+                          return m_ReusedKeys.count(GetHashKey(Type, Name)) != 0;
+                      });
+        m_pPrevArchive.reset();
+        m_pPrevArchiveData.Release();
+    }
+    // Merging deduplicates the shader bytecode shared by the new and the reused resources
+    Archive.Merge(DeviceObjectArchive{pNewData}, /*OverrideExisting = */ true);
+
+    // Remove the hashes first so that the archive is fully cooked next time if writing fails
+    const auto HashesPath = m_Attribs.OutputPath + ".hashes";
+    if (FileSystem::FileExists(HashesPath.c_str()))
+        FileSystem::DeleteFile(HashesPath.c_str());
+
+    {
+        auto pStream = BufferedFileStream::Create(m_Attribs.OutputPath.c_str());
+        if (!pStream || !pStream->IsValid() || !Archive.Serialize(pStream) || !pStream->Flush())
+        {
+            LOG_ERROR_MESSAGE("Failed to write archive '", m_Attribs.OutputPath, "'");
+            return false;
+        }
+    }
+
+    return m_Attribs.Incremental ? SaveContentHashes(HashesPath, m_Hashes) : true;
+}
+
+bool ArchiveCooker::Cook(ArchiveCookerStats& Stats) noexcept(false)
+{
+    m_Desc = ArchiveDescription::Load(m_Attribs.DescriptionPath.c_str());
+
+    if (!CreateDevice())
+        return false;
+
+    CreateShaderSourceFactory();
+    if (!CreateSignaturesAndRenderPasses())
+        return false;
+
+    ComputeHashes();
+    LoadPreviousArchive();
+
+    // Find the objects that need to be cooked and the shaders they use
+    std::vector<size_t> PipelineIndices;
+    std::vector<bool>   IsShaderUsed(m_Desc.Shaders.size());
+    for (size_t i = 0; i < m_Desc.Pipelines.size(); ++i)
+    {
+        const auto& Pipeline = m_Desc.Pipelines[i];
+        const auto  ResType  = GetPipelineResourceType(Pipeline.Type);
+        if (IsReused(ResType, Pipeline.Name, m_PipelineHashes[i]))
+        {
+            m_ReusedKeys.emplace(GetHashKey(ResType, Pipeline.Name));
+            continue;
+        }
+
+        PipelineIndices.push_back(i);
+        for (const auto& Stage : Pipeline.Shaders)
+            IsShaderUsed[m_ShaderIndices.find(Stage.second)->second] = true;
+    }
+
+    for (size_t i = 0; i < m_Desc.Shaders.size(); ++i)
+    {
+        const auto& Shader = m_Desc.Shaders[i];
+        if (!Shader.Standalone)
+            continue;
+
+        if (IsReused(ResourceType::StandaloneShader, Shader.Name, m_ShaderHashes[i]))
+            m_ReusedKeys.emplace(GetHashKey(ResourceType::StandaloneShader, Shader.Name));
+        else
+            IsShaderUsed[i] = true;
+    }
+
+    std::vector<size_t> ShaderIndices;
+    for (size_t i = 0; i < IsShaderUsed.size(); ++i)
+    {
+        if (IsShaderUsed[i])
+            ShaderIndices.push_back(i);
+    }
+
+    m_Shaders.resize(m_Desc.Shaders.size());
+    if (!CompileShaders(ShaderIndices))
+        return false;
+
+    if (!CreatePipelines(PipelineIndices))
+        return false;
+    // Shader bytecode has been copied to the archiver
+    m_Shaders.clear();
+
+    if (!WriteArchive())
+        return false;
+
+    ThreadPoolTrace Trace;
+    if (m_pThreadPool && m_pThreadPool->GetTrace(Trace))
+        Trace.WriteJSON(m_Attribs.TraceFilePath.c_str());
+
+    Stats.NumShadersCompiled = static_cast<Uint32>(ShaderIndices.size());
+    Stats.NumObjectsReused   = static_cast<Uint32>(m_ReusedKeys.size());
+    Stats.NumObjectsCooked   = static_cast<Uint32>(m_Hashes.size() - m_ReusedKeys.size());
+
+    return true;
+}
+
+} // namespace
+
+bool CookArchive(const ArchiveCookerAttribs& Attribs, ArchiveCookerStats* pStats)
+{
+    ArchiveCookerStats Stats;
+    try
+    {
+        ArchiveCooker Cooker{Attribs};
+        if (!Cooker.Cook(Stats))
+            return false;
+    }
+    catch (...)
+    {
+        // The error has already been logged
+        return false;
+    }
+
+    if (pStats != nullptr)
+        *pStats = Stats;
+
+    return true;
+}
+
+} // namespace Diligent
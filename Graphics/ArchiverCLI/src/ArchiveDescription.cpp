@@ -0,0 +1,929 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ArchiveDescription.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "JSONValue.hpp"
+#include "FileWrapper.hpp"
+#include "DataBlobImpl.hpp"
+#include "GraphicsAccessories.hpp"
+#include "ParsingTools.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+template <typename EnumType>
+struct EnumName
+{
+    const char* Name;
+    EnumType    Value;
+};
+
+#define ENUM_NAME(Value) \
+    {                    \
+#        Value, Value    \
+    }
+
+// clang-format off
+const EnumName<SHADER_TYPE> ShaderTypeNames[] = {
+    ENUM_NAME(SHADER_TYPE_UNKNOWN),
+    ENUM_NAME(SHADER_TYPE_VERTEX),
+    ENUM_NAME(SHADER_TYPE_PIXEL),
+    ENUM_NAME(SHADER_TYPE_GEOMETRY),
+    ENUM_NAME(SHADER_TYPE_HULL),
+    ENUM_NAME(SHADER_TYPE_DOMAIN),
+    ENUM_NAME(SHADER_TYPE_COMPUTE),
+    ENUM_NAME(SHADER_TYPE_AMPLIFICATION),
+    ENUM_NAME(SHADER_TYPE_MESH),
+    ENUM_NAME(SHADER_TYPE_ALL_GRAPHICS),
+    ENUM_NAME(SHADER_TYPE_ALL_MESH),
+    ENUM_NAME(SHADER_TYPE_ALL),
+};
+
+const EnumName<SHADER_SOURCE_LANGUAGE> SourceLanguageNames[] = {
+    ENUM_NAME(SHADER_SOURCE_LANGUAGE_DEFAULT),
+    ENUM_NAME(SHADER_SOURCE_LANGUAGE_HLSL),
+    ENUM_NAME(SHADER_SOURCE_LANGUAGE_GLSL),
+    ENUM_NAME(SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM),
+    ENUM_NAME(SHADER_SOURCE_LANGUAGE_MSL),
+    ENUM_NAME(SHADER_SOURCE_LANGUAGE_MSL_VERBATIM),
+};
+
+const EnumName<SHADER_COMPILER> ShaderCompilerNames[] = {
+    ENUM_NAME(SHADER_COMPILER_DEFAULT),
+    ENUM_NAME(SHADER_COMPILER_GLSLANG),
+    ENUM_NAME(SHADER_COMPILER_DXC),
+    ENUM_NAME(SHADER_COMPILER_FXC),
+};
+
+const EnumName<SHADER_RESOURCE_TYPE> ResourceTypeNames[] = {
+    ENUM_NAME(SHADER_RESOURCE_TYPE_CONSTANT_BUFFER),
+    ENUM_NAME(SHADER_RESOURCE_TYPE_TEXTURE_SRV),
+    ENUM_NAME(SHADER_RESOURCE_TYPE_BUFFER_SRV),
+    ENUM_NAME(SHADER_RESOURCE_TYPE_TEXTURE_UAV),
+    ENUM_NAME(SHADER_RESOURCE_TYPE_BUFFER_UAV),
+    ENUM_NAME(SHADER_RESOURCE_TYPE_SAMPLER),
+    ENUM_NAME(SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT),
+    ENUM_NAME(SHADER_RESOURCE_TYPE_ACCEL_STRUCT),
+};
+
+const EnumName<SHADER_RESOURCE_VARIABLE_TYPE> VariableTypeNames[] = {
+    ENUM_NAME(SHADER_RESOURCE_VARIABLE_TYPE_STATIC),
+    ENUM_NAME(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE),
+    ENUM_NAME(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC),
+};
+
+const EnumName<PIPELINE_RESOURCE_FLAGS> ResourceFlagNames[] = {
+    ENUM_NAME(PIPELINE_RESOURCE_FLAG_NONE),
+    ENUM_NAME(PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS),
+    ENUM_NAME(PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER),
+    ENUM_NAME(PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER),
+    ENUM_NAME(PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY),
+    ENUM_NAME(PIPELINE_RESOURCE_FLAG_GENERAL_INPUT_ATTACHMENT),
+    ENUM_NAME(PIPELINE_RESOURCE_FLAG_BINDLESS),
+    ENUM_NAME(PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS),
+};
+
+const EnumName<SHADER_VARIABLE_FLAGS> VariableFlagNames[] = {
+    ENUM_NAME(SHADER_VARIABLE_FLAG_NONE),
+    ENUM_NAME(SHADER_VARIABLE_FLAG_NO_DYNAMIC_BUFFERS),
+    ENUM_NAME(SHADER_VARIABLE_FLAG_GENERAL_INPUT_ATTACHMENT),
+};
+
+const EnumName<FILTER_TYPE> FilterTypeNames[] = {
+    ENUM_NAME(FILTER_TYPE_POINT),
+    ENUM_NAME(FILTER_TYPE_LINEAR),
+    ENUM_NAME(FILTER_TYPE_ANISOTROPIC),
+    ENUM_NAME(FILTER_TYPE_COMPARISON_POINT),
+    ENUM_NAME(FILTER_TYPE_COMPARISON_LINEAR),
+    ENUM_NAME(FILTER_TYPE_COMPARISON_ANISOTROPIC),
+    ENUM_NAME(FILTER_TYPE_MINIMUM_POINT),
+    ENUM_NAME(FILTER_TYPE_MINIMUM_LINEAR),
+    ENUM_NAME(FILTER_TYPE_MINIMUM_ANISOTROPIC),
+    ENUM_NAME(FILTER_TYPE_MAXIMUM_POINT),
+    ENUM_NAME(FILTER_TYPE_MAXIMUM_LINEAR),
+    ENUM_NAME(FILTER_TYPE_MAXIMUM_ANISOTROPIC),
+};
+
+const EnumName<TEXTURE_ADDRESS_MODE> AddressModeNames[] = {
+    ENUM_NAME(TEXTURE_ADDRESS_WRAP),
+    ENUM_NAME(TEXTURE_ADDRESS_MIRROR),
+    ENUM_NAME(TEXTURE_ADDRESS_CLAMP),
+    ENUM_NAME(TEXTURE_ADDRESS_BORDER),
+    ENUM_NAME(TEXTURE_ADDRESS_MIRROR_ONCE),
+};
+
+const EnumName<COMPARISON_FUNCTION> ComparisonFuncNames[] = {
+    ENUM_NAME(COMPARISON_FUNC_NEVER),
+    ENUM_NAME(COMPARISON_FUNC_LESS),
+    ENUM_NAME(COMPARISON_FUNC_EQUAL),
+    ENUM_NAME(COMPARISON_FUNC_LESS_EQUAL),
+    ENUM_NAME(COMPARISON_FUNC_GREATER),
+    ENUM_NAME(COMPARISON_FUNC_NOT_EQUAL),
+    ENUM_NAME(COMPARISON_FUNC_GREATER_EQUAL),
+    ENUM_NAME(COMPARISON_FUNC_ALWAYS),
+};
+
+const EnumName<ATTACHMENT_LOAD_OP> LoadOpNames[] = {
+    ENUM_NAME(ATTACHMENT_LOAD_OP_LOAD),
+    ENUM_NAME(ATTACHMENT_LOAD_OP_CLEAR),
+    ENUM_NAME(ATTACHMENT_LOAD_OP_DISCARD),
+};
+
+const EnumName<ATTACHMENT_STORE_OP> StoreOpNames[] = {
+    ENUM_NAME(ATTACHMENT_STORE_OP_STORE),
+    ENUM_NAME(ATTACHMENT_STORE_OP_DISCARD),
+};
+
+const EnumName<RESOURCE_STATE> ResourceStateNames[] = {
+    ENUM_NAME(RESOURCE_STATE_UNKNOWN),
+    ENUM_NAME(RESOURCE_STATE_UNDEFINED),
+    ENUM_NAME(RESOURCE_STATE_VERTEX_BUFFER),
+    ENUM_NAME(RESOURCE_STATE_CONSTANT_BUFFER),
+    ENUM_NAME(RESOURCE_STATE_INDEX_BUFFER),
+    ENUM_NAME(RESOURCE_STATE_RENDER_TARGET),
+    ENUM_NAME(RESOURCE_STATE_UNORDERED_ACCESS),
+    ENUM_NAME(RESOURCE_STATE_DEPTH_WRITE),
+    ENUM_NAME(RESOURCE_STATE_DEPTH_READ),
+    ENUM_NAME(RESOURCE_STATE_SHADER_RESOURCE),
+    ENUM_NAME(RESOURCE_STATE_STREAM_OUT),
+    ENUM_NAME(RESOURCE_STATE_INDIRECT_ARGUMENT),
+    ENUM_NAME(RESOURCE_STATE_COPY_DEST),
+    ENUM_NAME(RESOURCE_STATE_COPY_SOURCE),
+    ENUM_NAME(RESOURCE_STATE_RESOLVE_DEST),
+    ENUM_NAME(RESOURCE_STATE_RESOLVE_SOURCE),
+    ENUM_NAME(RESOURCE_STATE_INPUT_ATTACHMENT),
+    ENUM_NAME(RESOURCE_STATE_PRESENT),
+    ENUM_NAME(RESOURCE_STATE_SHADING_RATE),
+};
+
+const EnumName<PIPELINE_TYPE> PipelineTypeNames[] = {
+    ENUM_NAME(PIPELINE_TYPE_GRAPHICS),
+    ENUM_NAME(PIPELINE_TYPE_COMPUTE),
+    ENUM_NAME(PIPELINE_TYPE_MESH),
+};
+
+const EnumName<CULL_MODE> CullModeNames[] = {
+    ENUM_NAME(CULL_MODE_NONE),
+    ENUM_NAME(CULL_MODE_FRONT),
+    ENUM_NAME(CULL_MODE_BACK),
+};
+
+const EnumName<FILL_MODE> FillModeNames[] = {
+    ENUM_NAME(FILL_MODE_WIREFRAME),
+    ENUM_NAME(FILL_MODE_SOLID),
+};
+
+const EnumName<BLEND_FACTOR> BlendFactorNames[] = {
+    ENUM_NAME(BLEND_FACTOR_ZERO),
+    ENUM_NAME(BLEND_FACTOR_ONE),
+    ENUM_NAME(BLEND_FACTOR_SRC_COLOR),
+    ENUM_NAME(BLEND_FACTOR_INV_SRC_COLOR),
+    ENUM_NAME(BLEND_FACTOR_SRC_ALPHA),
+    ENUM_NAME(BLEND_FACTOR_INV_SRC_ALPHA),
+    ENUM_NAME(BLEND_FACTOR_DEST_ALPHA),
+    ENUM_NAME(BLEND_FACTOR_INV_DEST_ALPHA),
+    ENUM_NAME(BLEND_FACTOR_DEST_COLOR),
+    ENUM_NAME(BLEND_FACTOR_INV_DEST_COLOR),
+    ENUM_NAME(BLEND_FACTOR_SRC_ALPHA_SAT),
+    ENUM_NAME(BLEND_FACTOR_BLEND_FACTOR),
+    ENUM_NAME(BLEND_FACTOR_INV_BLEND_FACTOR),
+    ENUM_NAME(BLEND_FACTOR_SRC1_COLOR),
+    ENUM_NAME(BLEND_FACTOR_INV_SRC1_COLOR),
+    ENUM_NAME(BLEND_FACTOR_SRC1_ALPHA),
+    ENUM_NAME(BLEND_FACTOR_INV_SRC1_ALPHA),
+};
+
+const EnumName<BLEND_OPERATION> BlendOperationNames[] = {
+    ENUM_NAME(BLEND_OPERATION_ADD),
+    ENUM_NAME(BLEND_OPERATION_SUBTRACT),
+    ENUM_NAME(BLEND_OPERATION_REV_SUBTRACT),
+    ENUM_NAME(BLEND_OPERATION_MIN),
+    ENUM_NAME(BLEND_OPERATION_MAX),
+};
+
+const EnumName<COLOR_MASK> ColorMaskNames[] = {
+    ENUM_NAME(COLOR_MASK_NONE),
+    ENUM_NAME(COLOR_MASK_RED),
+    ENUM_NAME(COLOR_MASK_GREEN),
+    ENUM_NAME(COLOR_MASK_BLUE),
+    ENUM_NAME(COLOR_MASK_ALPHA),
+    ENUM_NAME(COLOR_MASK_ALL),
+};
+
+const EnumName<VALUE_TYPE> ValueTypeNames[] = {
+    ENUM_NAME(VT_INT8),
+    ENUM_NAME(VT_INT16),
+    ENUM_NAME(VT_INT32),
+    ENUM_NAME(VT_UINT8),
+    ENUM_NAME(VT_UINT16),
+    ENUM_NAME(VT_UINT32),
+    ENUM_NAME(VT_FLOAT16),
+    ENUM_NAME(VT_FLOAT32),
+};
+
+const EnumName<INPUT_ELEMENT_FREQUENCY> FrequencyNames[] = {
+    ENUM_NAME(INPUT_ELEMENT_FREQUENCY_PER_VERTEX),
+    ENUM_NAME(INPUT_ELEMENT_FREQUENCY_PER_INSTANCE),
+};
+
+const EnumName<PRIMITIVE_TOPOLOGY> TopologyNames[] = {
+    ENUM_NAME(PRIMITIVE_TOPOLOGY_TRIANGLE_LIST),
+    ENUM_NAME(PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP),
+    ENUM_NAME(PRIMITIVE_TOPOLOGY_POINT_LIST),
+    ENUM_NAME(PRIMITIVE_TOPOLOGY_LINE_LIST),
+    ENUM_NAME(PRIMITIVE_TOPOLOGY_LINE_STRIP),
+    ENUM_NAME(PRIMITIVE_TOPOLOGY_TRIANGLE_LIST_ADJ),
+    ENUM_NAME(PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP_ADJ),
+    ENUM_NAME(PRIMITIVE_TOPOLOGY_LINE_LIST_ADJ),
+    ENUM_NAME(PRIMITIVE_TOPOLOGY_LINE_STRIP_ADJ),
+};
+
+// Shader stage keys in the pipeline 'Shaders' object
+const EnumName<SHADER_TYPE> ShaderStageKeys[] = {
+    {"VS", SHADER_TYPE_VERTEX},
+    {"PS", SHADER_TYPE_PIXEL},
+    {"GS", SHADER_TYPE_GEOMETRY},
+    {"HS", SHADER_TYPE_HULL},
+    {"DS", SHADER_TYPE_DOMAIN},
+    {"AS", SHADER_TYPE_AMPLIFICATION},
+    {"MS", SHADER_TYPE_MESH},
+    {"CS", SHADER_TYPE_COMPUTE},
+};
+// clang-format on
+
+#undef ENUM_NAME
+
+
+template <typename EnumType, size_t N>
+EnumType ParseEnum(const JSONValue& Value, const EnumName<EnumType> (&Names)[N]) noexcept(false)
+{
+    const auto& Str = Value.GetString();
+    for (const auto& Name : Names)
+    {
+        if (Str == Name.Name)
+            return Name.Value;
+    }
+    LOG_ERROR_AND_THROW("Line ", Value.GetLine(), ": '", Str, "' is not a valid enum value");
+}
+
+// Parses flags separated by '|', e.g. "SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL"
+template <typename EnumType, size_t N>
+EnumType ParseFlags(const JSONValue& Value, const EnumName<EnumType> (&Names)[N]) noexcept(false)
+{
+    const auto& Str   = Value.GetString();
+    Uint32      Flags = 0;
+
+    size_t Pos = 0;
+    while (Pos <= Str.length())
+    {
+        auto End = Str.find('|', Pos);
+        if (End == std::string::npos)
+            End = Str.length();
+
+        auto Start = Pos;
+        while (Start < End && Parsing::IsWhitespace(Str[Start]))
+            ++Start;
+        auto Last = End;
+        while (Last > Start && Parsing::IsWhitespace(Str[Last - 1]))
+            --Last;
+        const std::string Flag{Str, Start, Last - Start};
+
+        bool Found = false;
+        for (const auto& Name : Names)
+        {
+            if (Flag == Name.Name)
+            {
+                Flags |= static_cast<Uint32>(Name.Value);
+                Found = true;
+                break;
+            }
+        }
+        if (!Found)
+            LOG_ERROR_AND_THROW("Line ", Value.GetLine(), ": '", Flag, "' is not a valid flag");
+
+        Pos = End + 1;
+    }
+    return static_cast<EnumType>(Flags);
+}
+
+TEXTURE_FORMAT ParseTextureFormat(const JSONValue& Value) noexcept(false)
+{
+    const auto& Str = Value.GetString();
+    for (int Fmt = TEX_FORMAT_UNKNOWN; Fmt < TEX_FORMAT_NUM_FORMATS; ++Fmt)
+    {
+        if (Str == GetTextureFormatAttribs(static_cast<TEXTURE_FORMAT>(Fmt)).Name)
+            return static_cast<TEXTURE_FORMAT>(Fmt);
+    }
+    LOG_ERROR_AND_THROW("Line ", Value.GetLine(), ": '", Str, "' is not a valid texture format");
+}
+
+PRIMITIVE_TOPOLOGY ParseTopology(const JSONValue& Value) noexcept(false)
+{
+    // PRIMITIVE_TOPOLOGY_<N>_CONTROL_POINT_PATCHLIST
+    const auto& Str = Value.GetString();
+    for (Uint32 NumPoints = 1; NumPoints <= 32; ++NumPoints)
+    {
+        if (Str == "PRIMITIVE_TOPOLOGY_" + std::to_string(NumPoints) + "_CONTROL_POINT_PATCHLIST")
+            return static_cast<PRIMITIVE_TOPOLOGY>(PRIMITIVE_TOPOLOGY_1_CONTROL_POINT_PATCHLIST + NumPoints - 1);
+    }
+    return ParseEnum(Value, TopologyNames);
+}
+
+
+// Reads members of a JSON object and reports unknown members, which are most likely typos.
+class ObjectReader
+{
+public:
+    ObjectReader(const JSONValue& Object, const char* Context) noexcept(false) :
+        m_Object{Object},
+        m_Context{Context}
+    {
+        if (!m_Object.IsObject())
+            LOG_ERROR_AND_THROW("Line ", m_Object.GetLine(), ": ", m_Context, " must be an object");
+    }
+
+    const JSONValue* Find(const char* Name)
+    {
+        m_KnownMembers.push_back(Name);
+        return m_Object.Find(Name);
+    }
+
+    const JSONValue& Get(const char* Name) noexcept(false)
+    {
+        const auto* pValue = Find(Name);
+        if (pValue == nullptr)
+            LOG_ERROR_AND_THROW("Line ", m_Object.GetLine(), ": ", m_Context, " must define the '", Name, "' member");
+        return *pValue;
+    }
+
+    void Read(const char* Name, std::string& Str) noexcept(false)
+    {
+        if (const auto* pValue = Find(Name))
+            Str = pValue->GetString();
+    }
+
+    void Read(const char* Name, bool& Val) noexcept(false)
+    {
+        if (const auto* pValue = Find(Name))
+            Val = pValue->GetBool();
+    }
+
+    void Read(const char* Name, Uint32& Val) noexcept(false)
+    {
+        if (const auto* pValue = Find(Name))
+            Val = pValue->GetUint();
+    }
+
+    void Read(const char* Name, Uint8& Val) noexcept(false)
+    {
+        if (const auto* pValue = Find(Name))
+        {
+            const auto Val32 = pValue->GetUint();
+            if (Val32 > 255)
+                LOG_ERROR_AND_THROW("Line ", pValue->GetLine(), ": '", Name, "' must not exceed 255");
+            Val = static_cast<Uint8>(Val32);
+        }
+    }
+
+    void Read(const char* Name, Int32& Val) noexcept(false)
+    {
+        if (const auto* pValue = Find(Name))
+            Val = static_cast<Int32>(pValue->GetNumber());
+    }
+
+    void Read(const char* Name, float& Val) noexcept(false)
+    {
+        if (const auto* pValue = Find(Name))
+            Val = static_cast<float>(pValue->GetNumber());
+    }
+
+    template <typename EnumType, size_t N>
+    void ReadEnum(const char* Name, EnumType& Val, const EnumName<EnumType> (&Names)[N]) noexcept(false)
+    {
+        if (const auto* pValue = Find(Name))
+            Val = ParseEnum(*pValue, Names);
+    }
+
+    template <typename EnumType, size_t N>
+    void ReadFlags(const char* Name, EnumType& Val, const EnumName<EnumType> (&Names)[N]) noexcept(false)
+    {
+        if (const auto* pValue = Find(Name))
+            Val = ParseFlags(*pValue, Names);
+    }
+
+    void ReadFormat(const char* Name, TEXTURE_FORMAT& Fmt) noexcept(false)
+    {
+        if (const auto* pValue = Find(Name))
+            Fmt = ParseTextureFormat(*pValue);
+    }
+
+    template <typename HandlerType>
+    void ReadArray(const char* Name, HandlerType&& Handler) noexcept(false)
+    {
+        if (const auto* pValue = Find(Name))
+        {
+            for (const auto& Elem : pValue->GetArray())
+                Handler(Elem);
+        }
+    }
+
+    // Must be called after all members have been read
+    void CheckUnknownMembers() const noexcept(false)
+    {
+        for (const auto& Member : m_Object.GetMembers())
+        {
+            if (std::find_if(m_KnownMembers.begin(), m_KnownMembers.end(),
+                             [&Member](const char* Name) { return Member.first == Name; }) == m_KnownMembers.end())
+            {
+                LOG_ERROR_AND_THROW("Line ", Member.second.GetLine(), ": unknown ", m_Context, " member '", Member.first, "'");
+            }
+        }
+    }
+
+private:
+    const JSONValue&         m_Object;
+    const char* const        m_Context;
+    std::vector<const char*> m_KnownMembers;
+};
+
+
+ShaderInfo ParseShader(const JSONValue& Value) noexcept(false)
+{
+    ObjectReader Reader{Value, "shader"};
+
+    ShaderInfo Shader;
+    Shader.Name     = Reader.Get("Name").GetString();
+    Shader.Type     = ParseEnum(Reader.Get("Type"), ShaderTypeNames);
+    Shader.FilePath = Reader.Get("FilePath").GetString();
+    Reader.Read("EntryPoint", Shader.EntryPoint);
+    Reader.ReadEnum("SourceLanguage", Shader.SourceLanguage, SourceLanguageNames);
+    Reader.ReadEnum("ShaderCompiler", Shader.ShaderCompiler, ShaderCompilerNames);
+    Reader.Read("UseCombinedTextureSamplers", Shader.UseCombinedTextureSamplers);
+    Reader.Read("CombinedSamplerSuffix", Shader.CombinedSamplerSuffix);
+    Reader.Read("Standalone", Shader.Standalone);
+    if (const auto* pMacros = Reader.Find("Macros"))
+    {
+        for (const auto& Macro : pMacros->GetMembers())
+            Shader.Macros.emplace_back(Macro.first, Macro.second.GetString());
+    }
+    Reader.CheckUnknownMembers();
+
+    if (Shader.Type == SHADER_TYPE_UNKNOWN || !IsPowerOfTwo(Shader.Type))
+        LOG_ERROR_AND_THROW("Line ", Value.GetLine(), ": shader '", Shader.Name, "' must have a single shader type");
+
+    return Shader;
+}
+
+SamplerDesc ParseSamplerDesc(const JSONValue& Value) noexcept(false)
+{
+    ObjectReader Reader{Value, "sampler"};
+
+    SamplerDesc Desc;
+    Reader.ReadEnum("MinFilter", Desc.MinFilter, FilterTypeNames);
+    Reader.ReadEnum("MagFilter", Desc.MagFilter, FilterTypeNames);
+    Reader.ReadEnum("MipFilter", Desc.MipFilter, FilterTypeNames);
+    Reader.ReadEnum("AddressU", Desc.AddressU, AddressModeNames);
+    Reader.ReadEnum("AddressV", Desc.AddressV, AddressModeNames);
+    Reader.ReadEnum("AddressW", Desc.AddressW, AddressModeNames);
+    Reader.Read("MaxAnisotropy", Desc.MaxAnisotropy);
+    Reader.ReadEnum("ComparisonFunc", Desc.ComparisonFunc, ComparisonFuncNames);
+    Reader.Read("MipLODBias", Desc.MipLODBias);
+    Reader.Read("MinLOD", Desc.MinLOD);
+    Reader.Read("MaxLOD", Desc.MaxLOD);
+    Reader.CheckUnknownMembers();
+
+    return Desc;
+}
+
+ImmutableSamplerDesc ParseImmutableSampler(const JSONValue& Value, std::string& Name) noexcept(false)
+{
+    ObjectReader Reader{Value, "immutable sampler"};
+
+    ImmutableSamplerDesc Sampler;
+    Sampler.ShaderStages = ParseFlags(Reader.Get("ShaderStages"), ShaderTypeNames);
+    Name                 = Reader.Get("SamplerOrTextureName").GetString();
+    if (const auto* pDesc = Reader.Find("Desc"))
+        Sampler.Desc = ParseSamplerDesc(*pDesc);
+    Reader.CheckUnknownMembers();
+
+    // The X wrappers copy the name
+    Sampler.SamplerOrTextureName = Name.c_str();
+    return Sampler;
+}
+
+ResourceSignatureInfo ParseSignature(const JSONValue& Value) noexcept(false)
+{
+    ObjectReader Reader{Value, "resource signature"};
+
+    ResourceSignatureInfo Signature;
+    Signature.Desc.SetName(Reader.Get("Name").GetString().c_str());
+    Reader.Read("BindingIndex", Signature.Desc.BindingIndex);
+    Reader.Read("UseCombinedTextureSamplers", Signature.Desc.UseCombinedTextureSamplers);
+    Reader.Read("CombinedSamplerSuffix", Signature.CombinedSamplerSuffix);
+
+    Reader.ReadArray("Resources", [&](const JSONValue& ResValue) {
+        ObjectReader ResReader{ResValue, "pipeline resource"};
+
+        const auto& Name = ResReader.Get("Name").GetString();
+
+        PipelineResourceDesc Res;
+        Res.Name         = Name.c_str();
+        Res.ShaderStages = ParseFlags(ResReader.Get("ShaderStages"), ShaderTypeNames);
+        Res.ResourceType = ParseEnum(ResReader.Get("ResourceType"), ResourceTypeNames);
+        ResReader.Read("ArraySize", Res.ArraySize);
+        ResReader.ReadEnum("VarType", Res.VarType, VariableTypeNames);
+        ResReader.ReadFlags("Flags", Res.Flags, ResourceFlagNames);
+        ResReader.CheckUnknownMembers();
+
+        Signature.Desc.AddResource(Res);
+    });
+
+    Reader.ReadArray("ImmutableSamplers", [&](const JSONValue& SamValue) {
+        std::string Name;
+        Signature.Desc.AddImmutableSampler(ParseImmutableSampler(SamValue, Name));
+    });
+    Reader.CheckUnknownMembers();
+
+    return Signature;
+}
+
+AttachmentReference ParseAttachmentReference(const JSONValue& Value) noexcept(false)
+{
+    ObjectReader Reader{Value, "attachment reference"};
+
+    AttachmentReference Ref;
+    Ref.AttachmentIndex = Reader.Get("AttachmentIndex").GetUint();
+    Ref.State           = ParseEnum(Reader.Get("State"), ResourceStateNames);
+    Reader.CheckUnknownMembers();
+
+    return Ref;
+}
+
+RenderPassInfo ParseRenderPass(const JSONValue& Value) noexcept(false)
+{
+    ObjectReader Reader{Value, "render pass"};
+
+    RenderPassInfo RenderPass;
+    RenderPass.Name = Reader.Get("Name").GetString();
+
+    Reader.ReadArray("Attachments", [&](const JSONValue& AttachmentValue) {
+        ObjectReader AttachmentReader{AttachmentValue, "render pass attachment"};
+
+        RenderPassAttachmentDesc Attachment;
+        Attachment.Format = ParseTextureFormat(AttachmentReader.Get("Format"));
+        AttachmentReader.Read("SampleCount", Attachment.SampleCount);
+        AttachmentReader.ReadEnum("LoadOp", Attachment.LoadOp, LoadOpNames);
+        AttachmentReader.ReadEnum("StoreOp", Attachment.StoreOp, StoreOpNames);
+        AttachmentReader.ReadEnum("StencilLoadOp", Attachment.StencilLoadOp, LoadOpNames);
+        AttachmentReader.ReadEnum("StencilStoreOp", Attachment.StencilStoreOp, StoreOpNames);
+        AttachmentReader.ReadFlags("InitialState", Attachment.InitialState, ResourceStateNames);
+        AttachmentReader.ReadFlags("FinalState", Attachment.FinalState, ResourceStateNames);
+        AttachmentReader.CheckUnknownMembers();
+
+        RenderPass.Attachments.push_back(Attachment);
+    });
+
+    Reader.ReadArray("Subpasses", [&](const JSONValue& SubpassValue) {
+        ObjectReader SubpassReader{SubpassValue, "subpass"};
+
+        RenderPassInfo::Subpass Subpass;
+        SubpassReader.ReadArray("InputAttachments", [&](const JSONValue& Ref) {
+            Subpass.Inputs.push_back(ParseAttachmentReference(Ref));
+        });
+        SubpassReader.ReadArray("RenderTargetAttachments", [&](const JSONValue& Ref) {
+            Subpass.RenderTargets.push_back(ParseAttachmentReference(Ref));
+        });
+        SubpassReader.ReadArray("ResolveAttachments", [&](const JSONValue& Ref) {
+            Subpass.Resolves.push_back(ParseAttachmentReference(Ref));
+        });
+        SubpassReader.ReadArray("PreserveAttachments", [&](const JSONValue& Index) {
+            Subpass.Preserves.push_back(Index.GetUint());
+        });
+        if (const auto* pDepthStencil = SubpassReader.Find("DepthStencilAttachment"))
+        {
+            Subpass.HasDepthStencil = true;
+            Subpass.DepthStencil    = ParseAttachmentReference(*pDepthStencil);
+        }
+        SubpassReader.CheckUnknownMembers();
+
+        if (!Subpass.Resolves.empty() && Subpass.Resolves.size() != Subpass.RenderTargets.size())
+        {
+            LOG_ERROR_AND_THROW("Line ", SubpassValue.GetLine(), ": the number of resolve attachments (", Subpass.Resolves.size(),
+                                ") must match the number of render target attachments (", Subpass.RenderTargets.size(), ")");
+        }
+
+        RenderPass.Subpasses.emplace_back(std::move(Subpass));
+    });
+    Reader.CheckUnknownMembers();
+
+    return RenderPass;
+}
+
+void ParseRasterizerDesc(const JSONValue& Value, RasterizerStateDesc& Desc) noexcept(false)
+{
+    ObjectReader Reader{Value, "rasterizer state"};
+    Reader.ReadEnum("FillMode", Desc.FillMode, FillModeNames);
+    Reader.ReadEnum("CullMode", Desc.CullMode, CullModeNames);
+    Reader.Read("FrontCounterClockwise", Desc.FrontCounterClockwise);
+    Reader.Read("DepthClipEnable", Desc.DepthClipEnable);
+    Reader.Read("ScissorEnable", Desc.ScissorEnable);
+    Reader.Read("AntialiasedLineEnable", Desc.AntialiasedLineEnable);
+    Reader.Read("DepthBias", Desc.DepthBias);
+    Reader.Read("DepthBiasClamp", Desc.DepthBiasClamp);
+    Reader.Read("SlopeScaledDepthBias", Desc.SlopeScaledDepthBias);
+    Reader.CheckUnknownMembers();
+}
+
+void ParseDepthStencilDesc(const JSONValue& Value, DepthStencilStateDesc& Desc) noexcept(false)
+{
+    ObjectReader Reader{Value, "depth-stencil state"};
+    Reader.Read("DepthEnable", Desc.DepthEnable);
+    Reader.Read("DepthWriteEnable", Desc.DepthWriteEnable);
+    Reader.ReadEnum("DepthFunc", Desc.DepthFunc, ComparisonFuncNames);
+    Reader.Read("StencilEnable", Desc.StencilEnable);
+    Reader.Read("StencilReadMask", Desc.StencilReadMask);
+    Reader.Read("StencilWriteMask", Desc.StencilWriteMask);
+    Reader.CheckUnknownMembers();
+}
+
+void ParseBlendDesc(const JSONValue& Value, BlendStateDesc& Desc) noexcept(false)
+{
+    ObjectReader Reader{Value, "blend state"};
+    Reader.Read("AlphaToCoverageEnable", Desc.AlphaToCoverageEnable);
+    Reader.Read("IndependentBlendEnable", Desc.IndependentBlendEnable);
+
+    Uint32 RTIndex = 0;
+    Reader.ReadArray("RenderTargets", [&](const JSONValue& RTValue) {
+        if (RTIndex >= DILIGENT_MAX_RENDER_TARGETS)
+            LOG_ERROR_AND_THROW("Line ", RTValue.GetLine(), ": too many render target blend states");
+
+        auto&        RT = Desc.RenderTargets[RTIndex++];
+        ObjectReader RTReader{RTValue, "render target blend state"};
+        RTReader.Read("BlendEnable", RT.BlendEnable);
+        RTReader.ReadEnum("SrcBlend", RT.SrcBlend, BlendFactorNames);
+        RTReader.ReadEnum("DestBlend", RT.DestBlend, BlendFactorNames);
+        RTReader.ReadEnum("BlendOp", RT.BlendOp, BlendOperationNames);
+        RTReader.ReadEnum("SrcBlendAlpha", RT.SrcBlendAlpha, BlendFactorNames);
+        RTReader.ReadEnum("DestBlendAlpha", RT.DestBlendAlpha, BlendFactorNames);
+        RTReader.ReadEnum("BlendOpAlpha", RT.BlendOpAlpha, BlendOperationNames);
+        RTReader.ReadFlags("RenderTargetWriteMask", RT.RenderTargetWriteMask, ColorMaskNames);
+        RTReader.CheckUnknownMembers();
+    });
+    Reader.CheckUnknownMembers();
+}
+
+PipelineInfo ParsePipeline(const JSONValue& Value) noexcept(false)
+{
+    ObjectReader Reader{Value, "pipeline"};
+
+    PipelineInfo Pipeline;
+    Pipeline.Name = Reader.Get("Name").GetString();
+    Reader.ReadEnum("Type", Pipeline.Type, PipelineTypeNames);
+
+    for (const auto& Stage : Reader.Get("Shaders").GetMembers())
+    {
+        const auto* pKey = std::find_if(std::begin(ShaderStageKeys), std::end(ShaderStageKeys),
+                                        [&Stage](const EnumName<SHADER_TYPE>& Key) { return Stage.first == Key.Name; });
+        if (pKey == std::end(ShaderStageKeys))
+            LOG_ERROR_AND_THROW("Line ", Stage.second.GetLine(), ": '", Stage.first, "' is not a valid shader stage");
+
+        Pipeline.Shaders.emplace_back(pKey->Value, Stage.second.GetString());
+    }
+
+    Reader.ReadArray("ResourceSignatures", [&](const JSONValue& Name) {
+        Pipeline.Signatures.push_back(Name.GetString());
+    });
+
+    if (const auto* pLayout = Reader.Find("ResourceLayout"))
+    {
+        ObjectReader LayoutReader{*pLayout, "resource layout"};
+
+        LayoutReader.ReadEnum("DefaultVariableType", Pipeline.ResourceLayout.DefaultVariableType, VariableTypeNames);
+        LayoutReader.ReadFlags("DefaultVariableMergeStages", Pipeline.ResourceLayout.DefaultVariableMergeStages, ShaderTypeNames);
+        LayoutReader.ReadArray("Variables", [&](const JSONValue& VarValue) {
+            ObjectReader VarReader{VarValue, "shader variable"};
+
+            const auto& Name = VarReader.Get("Name").GetString();
+
+            ShaderResourceVariableDesc Var;
+            Var.Name         = Name.c_str();
+            Var.ShaderStages = ParseFlags(VarReader.Get("ShaderStages"), ShaderTypeNames);
+            Var.Type         = ParseEnum(VarReader.Get("Type"), VariableTypeNames);
+            VarReader.ReadFlags("Flags", Var.Flags, VariableFlagNames);
+            VarReader.CheckUnknownMembers();
+
+            Pipeline.ResourceLayout.AddVariable(Var);
+        });
+        LayoutReader.ReadArray("ImmutableSamplers", [&](const JSONValue& SamValue) {
+            std::string Name;
+            Pipeline.ResourceLayout.AddImmutableSampler(ParseImmutableSampler(SamValue, Name));
+        });
+        LayoutReader.CheckUnknownMembers();
+    }
+
+    if (Pipeline.Type != PIPELINE_TYPE_COMPUTE)
+    {
+        auto& GraphicsPipeline = Pipeline.GraphicsPipeline;
+
+        Uint32 NumRTVs = 0;
+        Reader.ReadArray("RTVFormats", [&](const JSONValue& Fmt) {
+            if (NumRTVs >= DILIGENT_MAX_RENDER_TARGETS)
+                LOG_ERROR_AND_THROW("Line ", Fmt.GetLine(), ": too many render targets");
+            GraphicsPipeline.RTVFormats[NumRTVs++] = ParseTextureFormat(Fmt);
+        });
+        GraphicsPipeline.NumRenderTargets = static_cast<Uint8>(NumRTVs);
+        Reader.ReadFormat("DSVFormat", GraphicsPipeline.DSVFormat);
+        if (const auto* pTopology = Reader.Find("PrimitiveTopology"))
+            GraphicsPipeline.PrimitiveTopology = ParseTopology(*pTopology);
+        Reader.Read("NumViewports", GraphicsPipeline.NumViewports);
+        Reader.Read("SampleCount", GraphicsPipeline.SmplDesc.Count);
+        Reader.Read("SampleMask", GraphicsPipeline.SampleMask);
+        Reader.Read("RenderPass", Pipeline.RenderPass);
+        Reader.Read("SubpassIndex", GraphicsPipeline.SubpassIndex);
+        if (const auto* pRasterizer = Reader.Find("Rasterizer"))
+            ParseRasterizerDesc(*pRasterizer, GraphicsPipeline.RasterizerDesc);
+        if (const auto* pDepthStencil = Reader.Find("DepthStencil"))
+            ParseDepthStencilDesc(*pDepthStencil, GraphicsPipeline.DepthStencilDesc);
+        if (const auto* pBlend = Reader.Find("Blend"))
+            ParseBlendDesc(*pBlend, GraphicsPipeline.BlendDesc);
+
+        Reader.ReadArray("InputLayout", [&](const JSONValue& ElemValue) {
+            ObjectReader ElemReader{ElemValue, "layout element"};
+
+            std::string   HLSLSemantic = LayoutElement{}.HLSLSemantic;
+            LayoutElement Elem;
+            ElemReader.Read("HLSLSemantic", HLSLSemantic);
+            Elem.InputIndex    = ElemReader.Get("InputIndex").GetUint();
+            Elem.NumComponents = ElemReader.Get("NumComponents").GetUint();
+            Elem.ValueType     = ParseEnum(ElemReader.Get("ValueType"), ValueTypeNames);
+            ElemReader.Read("BufferSlot", Elem.BufferSlot);
+            ElemReader.Read("IsNormalized", Elem.IsNormalized);
+            ElemReader.Read("RelativeOffset", Elem.RelativeOffset);
+            ElemReader.Read("Stride", Elem.Stride);
+            ElemReader.ReadEnum("Frequency", Elem.Frequency, FrequencyNames);
+            ElemReader.Read("InstanceDataStepRate", Elem.InstanceDataStepRate);
+            ElemReader.CheckUnknownMembers();
+
+            Elem.HLSLSemantic = HLSLSemantic.c_str();
+            Pipeline.InputLayout.Add(Elem);
+        });
+    }
+    Reader.CheckUnknownMembers();
+
+    return Pipeline;
+}
+
+template <typename ItemType>
+void CheckUniqueNames(const std::vector<ItemType>& Items, const char* ItemTypeStr, const std::string& (*GetName)(const ItemType&)) noexcept(false)
+{
+    std::vector<const std::string*> Names;
+    Names.reserve(Items.size());
+    for (const auto& Item : Items)
+        Names.push_back(&GetName(Item));
+    std::sort(Names.begin(), Names.end(), [](const std::string* lhs, const std::string* rhs) { return *lhs < *rhs; });
+    for (size_t i = 1; i < Names.size(); ++i)
+    {
+        if (*Names[i] == *Names[i - 1])
+            LOG_ERROR_AND_THROW("Archive description contains multiple ", ItemTypeStr, "s named '", *Names[i], "'");
+    }
+}
+
+template <typename ItemType>
+const ItemType* FindByName(const std::vector<ItemType>& Items, const std::string& Name, const std::string& (*GetName)(const ItemType&))
+{
+    for (const auto& Item : Items)
+    {
+        if (GetName(Item) == Name)
+            return &Item;
+    }
+    return nullptr;
+}
+
+const std::string& GetShaderName(const ShaderInfo& Shader) { return Shader.Name; }
+const std::string& GetRenderPassName(const RenderPassInfo& RenderPass) { return RenderPass.Name; }
+const std::string& GetPipelineName(const PipelineInfo& Pipeline) { return Pipeline.Name; }
+
+// Signature names are stored in the desc and can't be returned by reference to std::string
+void CheckSignatureNames(const std::vector<ResourceSignatureInfo>& Signatures) noexcept(false)
+{
+    for (size_t i = 0; i < Signatures.size(); ++i)
+    {
+        for (size_t j = i + 1; j < Signatures.size(); ++j)
+        {
+            if (SafeStrEqual(Signatures[i].Desc.Name, Signatures[j].Desc.Name))
+                LOG_ERROR_AND_THROW("Archive description contains multiple resource signatures named '", Signatures[i].Desc.Name, "'");
+        }
+    }
+}
+
+bool HasSignature(const std::vector<ResourceSignatureInfo>& Signatures, const std::string& Name)
+{
+    return std::any_of(Signatures.begin(), Signatures.end(),
+                       [&Name](const ResourceSignatureInfo& Sign) { return Name == Sign.Desc.Name; });
+}
+
+} // namespace
+
+ArchiveDescription ArchiveDescription::Parse(const char* pData, size_t Size) noexcept(false)
+{
+    const auto Root = JSONValue::Parse(pData, Size);
+
+    ObjectReader       Reader{Root, "archive description"};
+    ArchiveDescription Desc;
+
+    Reader.ReadArray("ShaderDirectories", [&](const JSONValue& Dir) {
+        Desc.ShaderDirectories.push_back(Dir.GetString());
+    });
+    Reader.ReadArray("Shaders", [&](const JSONValue& Shader) {
+        Desc.Shaders.emplace_back(ParseShader(Shader));
+    });
+    Reader.ReadArray("ResourceSignatures", [&](const JSONValue& Signature) {
+        Desc.Signatures.emplace_back(ParseSignature(Signature));
+    });
+    Reader.ReadArray("RenderPasses", [&](const JSONValue& RenderPass) {
+        Desc.RenderPasses.emplace_back(ParseRenderPass(RenderPass));
+    });
+    Reader.ReadArray("Pipelines", [&](const JSONValue& Pipeline) {
+        Desc.Pipelines.emplace_back(ParsePipeline(Pipeline));
+    });
+    Reader.CheckUnknownMembers();
+
+    CheckUniqueNames(Desc.Shaders, "shader", GetShaderName);
+    CheckSignatureNames(Desc.Signatures);
+    CheckUniqueNames(Desc.RenderPasses, "render pass", GetRenderPassName);
+    CheckUniqueNames(Desc.Pipelines, "pipeline", GetPipelineName);
+
+    // Resolve the references so that the archiver does not need to validate them
+    for (const auto& Pipeline : Desc.Pipelines)
+    {
+        for (const auto& Stage : Pipeline.Shaders)
+        {
+            const auto* pShader = FindByName(Desc.Shaders, Stage.second, GetShaderName);
+            if (pShader == nullptr)
+                LOG_ERROR_AND_THROW("Pipeline '", Pipeline.Name, "' references unknown shader '", Stage.second, "'");
+            if (pShader->Type != Stage.first)
+            {
+                LOG_ERROR_AND_THROW("Pipeline '", Pipeline.Name, "' uses ", GetShaderTypeLiteralName(pShader->Type), " shader '",
+                                    pShader->Name, "' as ", GetShaderTypeLiteralName(Stage.first));
+            }
+        }
+        for (const auto& Signature : Pipeline.Signatures)
+        {
+            if (!HasSignature(Desc.Signatures, Signature))
+                LOG_ERROR_AND_THROW("Pipeline '", Pipeline.Name, "' references unknown resource signature '", Signature, "'");
+        }
+        if (!Pipeline.RenderPass.empty() && FindByName(Desc.RenderPasses, Pipeline.RenderPass, GetRenderPassName) == nullptr)
+            LOG_ERROR_AND_THROW("Pipeline '", Pipeline.Name, "' references unknown render pass '", Pipeline.RenderPass, "'");
+    }
+
+    return Desc;
+}
+
+ArchiveDescription ArchiveDescription::Load(const char* FilePath) noexcept(false)
+{
+    FileWrapper File{FilePath, EFileAccessMode::Read};
+    if (!File)
+        LOG_ERROR_AND_THROW("Failed to open archive description file '", FilePath, "'");
+
+    auto pData = DataBlobImpl::Create();
+    if (!File->Read(pData))
+        LOG_ERROR_AND_THROW("Failed to read archive description file '", FilePath, "'");
+
+    return Parse(pData->GetConstDataPtr<char>(), pData->GetSize());
+}
+
+} // namespace Diligent
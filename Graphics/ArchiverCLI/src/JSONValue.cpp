@@ -0,0 +1,459 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "JSONValue.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+const char* GetTypeName(JSONValue::TYPE Type)
+{
+    switch (Type)
+    {
+        case JSONValue::TYPE_NULL: return "null";
+        case JSONValue::TYPE_BOOL: return "boolean";
+        case JSONValue::TYPE_NUMBER: return "number";
+        case JSONValue::TYPE_STRING: return "string";
+        case JSONValue::TYPE_ARRAY: return "array";
+        case JSONValue::TYPE_OBJECT: return "object";
+        default:
+            UNEXPECTED("Unexpected JSON value type");
+            return "unknown";
+    }
+}
+
+void AppendUTF8(std::string& Str, Uint32 CodePoint)
+{
+    if (CodePoint < 0x80)
+    {
+        Str.push_back(static_cast<char>(CodePoint));
+    }
+    else if (CodePoint < 0x800)
+    {
+        Str.push_back(static_cast<char>(0xC0 | (CodePoint >> 6)));
+        Str.push_back(static_cast<char>(0x80 | (CodePoint & 0x3F)));
+    }
+    else if (CodePoint < 0x10000)
+    {
+        Str.push_back(static_cast<char>(0xE0 | (CodePoint >> 12)));
+        Str.push_back(static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F)));
+        Str.push_back(static_cast<char>(0x80 | (CodePoint & 0x3F)));
+    }
+    else
+    {
+        Str.push_back(static_cast<char>(0xF0 | (CodePoint >> 18)));
+        Str.push_back(static_cast<char>(0x80 | ((CodePoint >> 12) & 0x3F)));
+        Str.push_back(static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F)));
+        Str.push_back(static_cast<char>(0x80 | (CodePoint & 0x3F)));
+    }
+}
+
+} // namespace
+
+class JSONValue::Parser
+{
+public:
+    Parser(const char* pData, size_t Size) :
+        m_Pos{pData},
+        m_End{pData + Size}
+    {}
+
+    JSONValue ParseDocument() noexcept(false)
+    {
+        JSONValue Root = ParseValue(0);
+        SkipWhitespace();
+        if (m_Pos != m_End)
+            Error("unexpected data after the end of the document");
+        return Root;
+    }
+
+private:
+    // Limits the nesting depth to avoid stack overflow on malformed input
+    static constexpr Uint32 MaxDepth = 256;
+
+    template <typename... ArgsType>
+    [[noreturn]] void Error(const ArgsType&... Args) const noexcept(false)
+    {
+        LOG_ERROR_AND_THROW("JSON parsing error at line ", m_Line, ": ", Args...);
+    }
+
+    void SkipWhitespace()
+    {
+        while (m_Pos != m_End)
+        {
+            const char c = *m_Pos;
+            if (c == '\n')
+            {
+                ++m_Line;
+                ++m_Pos;
+            }
+            else if (c == ' ' || c == '\t' || c == '\r')
+            {
+                ++m_Pos;
+            }
+            else if (c == '/' && m_Pos + 1 != m_End && m_Pos[1] == '/')
+            {
+                while (m_Pos != m_End && *m_Pos != '\n')
+                    ++m_Pos;
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    bool Consume(const char* Literal)
+    {
+        const size_t Len = strlen(Literal);
+        if (static_cast<size_t>(m_End - m_Pos) < Len || strncmp(m_Pos, Literal, Len) != 0)
+            return false;
+        m_Pos += Len;
+        return true;
+    }
+
+    JSONValue ParseValue(Uint32 Depth) noexcept(false)
+    {
+        if (Depth > MaxDepth)
+            Error("the document is nested too deeply");
+
+        SkipWhitespace();
+        if (m_Pos == m_End)
+            Error("unexpected end of the document");
+
+        JSONValue Value;
+        Value.m_Line = m_Line;
+        switch (*m_Pos)
+        {
+            case '{':
+                Value.m_Type = TYPE_OBJECT;
+                ParseObject(Value, Depth);
+                break;
+
+            case '[':
+                Value.m_Type = TYPE_ARRAY;
+                ParseArray(Value, Depth);
+                break;
+
+            case '"':
+                Value.m_Type   = TYPE_STRING;
+                Value.m_String = ParseString();
+                break;
+
+            default:
+                if (Consume("true"))
+                {
+                    Value.m_Type = TYPE_BOOL;
+                    Value.m_Bool = true;
+                }
+                else if (Consume("false"))
+                {
+                    Value.m_Type = TYPE_BOOL;
+                    Value.m_Bool = false;
+                }
+                else if (Consume("null"))
+                {
+                    Value.m_Type = TYPE_NULL;
+                }
+                else
+                {
+                    Value.m_Type   = TYPE_NUMBER;
+                    Value.m_Number = ParseNumber();
+                }
+        }
+        return Value;
+    }
+
+    void ParseObject(JSONValue& Value, Uint32 Depth) noexcept(false)
+    {
+        VERIFY_EXPR(*m_Pos == '{');
+        ++m_Pos;
+        SkipWhitespace();
+        if (m_Pos != m_End && *m_Pos == '}')
+        {
+            ++m_Pos;
+            return;
+        }
+
+        while (true)
+        {
+            SkipWhitespace();
+            if (m_Pos == m_End || *m_Pos != '"')
+                Error("member name is expected");
+            std::string Name = ParseString();
+
+            SkipWhitespace();
+            if (m_Pos == m_End || *m_Pos != ':')
+                Error("':' is expected after member '", Name, "'");
+            ++m_Pos;
+
+            for (const auto& Member : Value.m_Members)
+            {
+                if (Member.first == Name)
+                    Error("duplicate member '", Name, "'");
+            }
+            Value.m_Members.emplace_back(std::move(Name), ParseValue(Depth + 1));
+
+            SkipWhitespace();
+            if (m_Pos == m_End)
+                Error("unexpected end of the document in an object");
+            if (*m_Pos == '}')
+            {
+                ++m_Pos;
+                return;
+            }
+            if (*m_Pos != ',')
+                Error("',' or '}' is expected");
+            ++m_Pos;
+        }
+    }
+
+    void ParseArray(JSONValue& Value, Uint32 Depth) noexcept(false)
+    {
+        VERIFY_EXPR(*m_Pos == '[');
+        ++m_Pos;
+        SkipWhitespace();
+        if (m_Pos != m_End && *m_Pos == ']')
+        {
+            ++m_Pos;
+            return;
+        }
+
+        while (true)
+        {
+            Value.m_Array.emplace_back(ParseValue(Depth + 1));
+
+            SkipWhitespace();
+            if (m_Pos == m_End)
+                Error("unexpected end of the document in an array");
+            if (*m_Pos == ']')
+            {
+                ++m_Pos;
+                return;
+            }
+            if (*m_Pos != ',')
+                Error("',' or ']' is expected");
+            ++m_Pos;
+        }
+    }
+
+    Uint32 ParseHex4() noexcept(false)
+    {
+        if (m_End - m_Pos < 4)
+            Error("incomplete unicode escape sequence");
+
+        Uint32 Code = 0;
+        for (int i = 0; i < 4; ++i, ++m_Pos)
+        {
+            const char c = *m_Pos;
+            Code <<= 4;
+            if (c >= '0' && c <= '9')
+                Code |= static_cast<Uint32>(c - '0');
+            else if (c >= 'a' && c <= 'f')
+                Code |= static_cast<Uint32>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F')
+                Code |= static_cast<Uint32>(c - 'A' + 10);
+            else
+                Error("invalid unicode escape sequence");
+        }
+        return Code;
+    }
+
+    std::string ParseString() noexcept(false)
+    {
+        VERIFY_EXPR(*m_Pos == '"');
+        ++m_Pos;
+
+        std::string Str;
+        while (true)
+        {
+            if (m_Pos == m_End)
+                Error("unterminated string");
+
+            const char c = *m_Pos++;
+            if (c == '"')
+                break;
+
+            if (static_cast<unsigned char>(c) < 0x20)
+                Error("control characters must be escaped in strings");
+
+            if (c != '\\')
+            {
+                Str.push_back(c);
+                continue;
+            }
+
+            if (m_Pos == m_End)
+                Error("unterminated string");
+
+            const char Escape = *m_Pos++;
+            switch (Escape)
+            {
+                case '"': Str.push_back('"'); break;
+                case '\\': Str.push_back('\\'); break;
+                case '/': Str.push_back('/'); break;
+                case 'b': Str.push_back('\b'); break;
+                case 'f': Str.push_back('\f'); break;
+                case 'n': Str.push_back('\n'); break;
+                case 'r': Str.push_back('\r'); break;
+                case 't': Str.push_back('\t'); break;
+
+                case 'u':
+                {
+                    Uint32 CodePoint = ParseHex4();
+                    if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF)
+                    {
+                        // Surrogate pair
+                        if (!Consume("\\u"))
+                            Error("invalid unicode surrogate pair");
+                        const Uint32 Low = ParseHex4();
+                        if (Low < 0xDC00 || Low > 0xDFFF)
+                            Error("invalid unicode surrogate pair");
+                        CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+                    }
+                    AppendUTF8(Str, CodePoint);
+                    break;
+                }
+
+                default:
+                    Error("invalid escape sequence '\\", Escape, "'");
+            }
+        }
+        return Str;
+    }
+
+    double ParseNumber() noexcept(false)
+    {
+        const char* Start = m_Pos;
+
+        auto SkipDigits = [this]() {
+            const char* DigitsStart = m_Pos;
+            while (m_Pos != m_End && *m_Pos >= '0' && *m_Pos <= '9')
+                ++m_Pos;
+            return m_Pos != DigitsStart;
+        };
+
+        if (m_Pos != m_End && *m_Pos == '-')
+            ++m_Pos;
+        if (!SkipDigits())
+            Error("unexpected character '", *Start, "'");
+        if (m_Pos != m_End && *m_Pos == '.')
+        {
+            ++m_Pos;
+            if (!SkipDigits())
+                Error("digits are expected after the decimal point");
+        }
+        if (m_Pos != m_End && (*m_Pos == 'e' || *m_Pos == 'E'))
+        {
+            ++m_Pos;
+            if (m_Pos != m_End && (*m_Pos == '+' || *m_Pos == '-'))
+                ++m_Pos;
+            if (!SkipDigits())
+                Error("digits are expected in the exponent");
+        }
+
+        // The data is not null-terminated, so copy the number to a string
+        const std::string NumStr{Start, m_Pos};
+        return strtod(NumStr.c_str(), nullptr);
+    }
+
+private:
+    const char*       m_Pos  = nullptr;
+    const char* const m_End  = nullptr;
+    Uint32            m_Line = 1;
+};
+
+JSONValue JSONValue::Parse(const char* pData, size_t Size) noexcept(false)
+{
+    Parser P{pData, Size};
+    return P.ParseDocument();
+}
+
+void JSONValue::CheckType(TYPE Type) const noexcept(false)
+{
+    if (m_Type != Type)
+        LOG_ERROR_AND_THROW("Line ", m_Line, ": ", GetTypeName(Type), " is expected, but ", GetTypeName(m_Type), " is found");
+}
+
+bool JSONValue::GetBool() const noexcept(false)
+{
+    CheckType(TYPE_BOOL);
+    return m_Bool;
+}
+
+double JSONValue::GetNumber() const noexcept(false)
+{
+    CheckType(TYPE_NUMBER);
+    return m_Number;
+}
+
+Uint32 JSONValue::GetUint() const noexcept(false)
+{
+    CheckType(TYPE_NUMBER);
+    if (m_Number < 0 || m_Number > 4294967295.0 || m_Number != static_cast<double>(static_cast<Uint32>(m_Number)))
+        LOG_ERROR_AND_THROW("Line ", m_Line, ": ", m_Number, " is not a valid unsigned integer");
+    return static_cast<Uint32>(m_Number);
+}
+
+const std::string& JSONValue::GetString() const noexcept(false)
+{
+    CheckType(TYPE_STRING);
+    return m_String;
+}
+
+const std::vector<JSONValue>& JSONValue::GetArray() const noexcept(false)
+{
+    CheckType(TYPE_ARRAY);
+    return m_Array;
+}
+
+const std::vector<JSONValue::MemberType>& JSONValue::GetMembers() const noexcept(false)
+{
+    CheckType(TYPE_OBJECT);
+    return m_Members;
+}
+
+const JSONValue* JSONValue::Find(const char* Name) const noexcept(false)
+{
+    for (const auto& Member : GetMembers())
+    {
+        if (Member.first == Name)
+            return &Member.second;
+    }
+    return nullptr;
+}
+
+} // namespace Diligent
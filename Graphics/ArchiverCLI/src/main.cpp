@@ -0,0 +1,198 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "ArchiveCooker.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+void PrintUsage()
+{
+    printf("Usage: DiligentArchiverCLI [options] <description.json> <output archive>\n"
+           "\n"
+           "Options:\n"
+           "  --devices <list>     Comma-separated list of devices to cook the archive for:\n"
+           "                       d3d11, d3d12, gl, gles, vulkan, metal_macos, metal_ios.\n"
+           "                       By default, all devices supported by the archiver are used.\n"
+           "  --threads <N>        The number of compilation threads. By default, the number of\n"
+           "                       hardware threads is used.\n"
+           "  --shader-dir <dir>   Additional shader search directory. May be specified multiple times.\n"
+           "  --full               Cook all objects even when the previous archive is up to date.\n"
+           "  --trace <file>       Write the compilation thread pool trace in the Chrome trace format.\n"
+           "  --help               Print this message.\n");
+}
+
+bool ParseDeviceFlags(const char* List, ARCHIVE_DEVICE_DATA_FLAGS& Flags)
+{
+    static constexpr struct
+    {
+        const char*               Name;
+        ARCHIVE_DEVICE_DATA_FLAGS Flag;
+    } DeviceNames[] = {
+        {"d3d11", ARCHIVE_DEVICE_DATA_FLAG_D3D11},
+        {"d3d12", ARCHIVE_DEVICE_DATA_FLAG_D3D12},
+        {"gl", ARCHIVE_DEVICE_DATA_FLAG_GL},
+        {"gles", ARCHIVE_DEVICE_DATA_FLAG_GLES},
+        {"vulkan", ARCHIVE_DEVICE_DATA_FLAG_VULKAN},
+        {"metal_macos", ARCHIVE_DEVICE_DATA_FLAG_METAL_MACOS},
+        {"metal_ios", ARCHIVE_DEVICE_DATA_FLAG_METAL_IOS},
+    };
+
+    Flags = ARCHIVE_DEVICE_DATA_FLAG_NONE;
+    for (const char* Pos = List; *Pos != '\0';)
+    {
+        const char* End = Pos;
+        while (*End != '\0' && *End != ',')
+            ++End;
+
+        const std::string Name{Pos, End};
+
+        bool Found = false;
+        for (const auto& Device : DeviceNames)
+        {
+            if (Name == Device.Name)
+            {
+                Flags |= Device.Flag;
+                Found = true;
+                break;
+            }
+        }
+        if (!Found)
+        {
+            fprintf(stderr, "Unknown device '%s'\n", Name.c_str());
+            return false;
+        }
+
+        Pos = *End == ',' ? End + 1 : End;
+    }
+    return Flags != ARCHIVE_DEVICE_DATA_FLAG_NONE;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    ArchiveCookerAttribs Attribs;
+
+    int NumPositional = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* Arg = argv[i];
+
+        auto GetValue = [&](const char*& Value) {
+            if (i + 1 >= argc)
+            {
+                fprintf(stderr, "Option %s requires a value\n", Arg);
+                return false;
+            }
+            Value = argv[++i];
+            return true;
+        };
+
+        const char* Value = nullptr;
+        if (strcmp(Arg, "--help") == 0 || strcmp(Arg, "-h") == 0)
+        {
+            PrintUsage();
+            return 0;
+        }
+        else if (strcmp(Arg, "--devices") == 0)
+        {
+            if (!GetValue(Value) || !ParseDeviceFlags(Value, Attribs.DeviceFlags))
+                return 1;
+        }
+        else if (strcmp(Arg, "--threads") == 0)
+        {
+            if (!GetValue(Value))
+                return 1;
+
+            char*               End        = nullptr;
+            const unsigned long NumThreads = strtoul(Value, &End, 10);
+            if (End == Value || *End != '\0')
+            {
+                fprintf(stderr, "Invalid number of threads '%s'\n", Value);
+                return 1;
+            }
+            Attribs.NumThreads = static_cast<Uint32>(NumThreads);
+        }
+        else if (strcmp(Arg, "--shader-dir") == 0)
+        {
+            if (!GetValue(Value))
+                return 1;
+            Attribs.ShaderDirectories.emplace_back(Value);
+        }
+        else if (strcmp(Arg, "--trace") == 0)
+        {
+            if (!GetValue(Value))
+                return 1;
+            Attribs.TraceFilePath = Value;
+        }
+        else if (strcmp(Arg, "--full") == 0)
+        {
+            Attribs.Incremental = false;
+        }
+        else if (Arg[0] == '-')
+        {
+            fprintf(stderr, "Unknown option '%s'\n", Arg);
+            PrintUsage();
+            return 1;
+        }
+        else
+        {
+            switch (NumPositional++)
+            {
+                case 0: Attribs.DescriptionPath = Arg; break;
+                case 1: Attribs.OutputPath = Arg; break;
+                default:
+                    fprintf(stderr, "Unexpected argument '%s'\n", Arg);
+                    return 1;
+            }
+        }
+    }
+
+    if (NumPositional != 2)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    ArchiveCookerStats Stats;
+    if (!CookArchive(Attribs, &Stats))
+        return 1;
+
+    printf("%s: %u objects cooked, %u objects reused, %u shaders compiled\n",
+           Attribs.OutputPath.c_str(), Stats.NumObjectsCooked, Stats.NumObjectsReused, Stats.NumShadersCompiled);
+
+    return 0;
+}
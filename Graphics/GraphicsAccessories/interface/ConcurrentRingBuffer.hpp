@@ -0,0 +1,168 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of Diligent::ConcurrentRingBuffer class
+
+#include <atomic>
+#include <deque>
+#include "../../../Primitives/interface/MemoryAllocator.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Common/interface/Align.hpp"
+#include "../../../Common/interface/STDAllocator.hpp"
+
+namespace Diligent
+{
+
+/// Multi-producer ring buffer with lock-free allocation.
+
+/// Allocate() may be called concurrently from any number of threads.
+/// FinishCurrentFrame() and ReleaseCompletedFrames() may be called concurrently with Allocate(),
+/// but not with each other, and are expected to be called by a single thread that owns the frame.
+///
+/// The buffer tracks a monotonically increasing virtual head and tail. Allocate() reserves
+/// space by advancing the head with a compare-and-swap, and every finished frame records
+/// the head position tagged with the frame fence value. Once the fence value is
+/// completed by the GPU, the tail is moved to the recorded head, releasing the space.
+class ConcurrentRingBuffer
+{
+public:
+    using OffsetType = size_t;
+
+    static constexpr const OffsetType InvalidOffset = static_cast<OffsetType>(-1);
+
+    ConcurrentRingBuffer(OffsetType MaxSize, IMemoryAllocator& Allocator) noexcept :
+        m_CompletedFrameHeads(STD_ALLOCATOR_RAW_MEM(FrameHeadAttribs, Allocator, "Allocator for deque<FrameHeadAttribs>")),
+        m_MaxSize{MaxSize}
+    {}
+
+    // clang-format off
+    ConcurrentRingBuffer             (const ConcurrentRingBuffer&)  = delete;
+    ConcurrentRingBuffer& operator = (const ConcurrentRingBuffer&)  = delete;
+    ConcurrentRingBuffer             (      ConcurrentRingBuffer&&) = delete;
+    ConcurrentRingBuffer& operator = (      ConcurrentRingBuffer&&) = delete;
+    // clang-format on
+
+    ~ConcurrentRingBuffer()
+    {
+        VERIFY(IsEmpty(), "All space in the ring buffer must be released");
+    }
+
+    /// Reserves Size bytes aligned by Alignment and returns the offset of the allocation,
+    /// or InvalidOffset if there is not enough space. The method is thread-safe.
+    OffsetType Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+        Size = AlignUp(Size, Alignment);
+        if (Size > m_MaxSize)
+            return InvalidOffset;
+
+        Uint64 Head = m_Head.load(std::memory_order_relaxed);
+        while (true)
+        {
+            const auto PhysHead = static_cast<OffsetType>(Head % m_MaxSize);
+
+            auto Offset = AlignUp(PhysHead, Alignment);
+            if (Offset + Size > m_MaxSize)
+            {
+                // Skip the remaining space at the end of the buffer and allocate from the beginning
+                Offset = 0;
+            }
+            const Uint64 NewHead = Head + (Offset >= PhysHead ? Offset - PhysHead : m_MaxSize - PhysHead) + Size;
+
+            // The tail only moves forward, so a stale value may only cause a false failure
+            if (NewHead - m_Tail.load(std::memory_order_acquire) > m_MaxSize)
+                return InvalidOffset;
+
+            if (m_Head.compare_exchange_weak(Head, NewHead, std::memory_order_acq_rel, std::memory_order_relaxed))
+                return Offset;
+        }
+    }
+
+    /// Finishes the current frame and tags all space allocated so far with the fence value.
+
+    /// FenceValue is the fence value associated with the command list in which the allocations
+    /// could have been referenced last time. All allocations that belong to the frame must
+    /// have completed before the method is called.
+    void FinishCurrentFrame(Uint64 FenceValue)
+    {
+#ifdef DILIGENT_DEBUG
+        if (!m_CompletedFrameHeads.empty())
+            VERIFY(FenceValue >= m_CompletedFrameHeads.back().FenceValue, "Current frame fence value (", FenceValue, ") is lower than the fence value of the previous frame (", m_CompletedFrameHeads.back().FenceValue, ")");
+#endif
+        const auto Head     = m_Head.load(std::memory_order_acquire);
+        const auto LastHead = m_CompletedFrameHeads.empty() ? m_Tail.load(std::memory_order_relaxed) : m_CompletedFrameHeads.back().Head;
+        // Ignore zero-size frames
+        if (Head != LastHead)
+            m_CompletedFrameHeads.emplace_back(FenceValue, Head);
+    }
+
+    /// Releases the space of all frames whose fence value is less than or equal to CompletedFenceValue.
+    void ReleaseCompletedFrames(Uint64 CompletedFenceValue)
+    {
+        while (!m_CompletedFrameHeads.empty() && m_CompletedFrameHeads.front().FenceValue <= CompletedFenceValue)
+        {
+            m_Tail.store(m_CompletedFrameHeads.front().Head, std::memory_order_release);
+            m_CompletedFrameHeads.pop_front();
+        }
+    }
+
+    // clang-format off
+    OffsetType GetMaxSize()  const { return m_MaxSize; }
+    OffsetType GetUsedSize() const { return static_cast<OffsetType>(m_Head.load(std::memory_order_relaxed) - m_Tail.load(std::memory_order_relaxed)); }
+    bool       IsFull()      const { return GetUsedSize() == m_MaxSize; }
+    bool       IsEmpty()     const { return GetUsedSize() == 0; }
+    // clang-format on
+
+private:
+    struct FrameHeadAttribs
+    {
+        FrameHeadAttribs(Uint64 _FenceValue, Uint64 _Head) noexcept :
+            FenceValue{_FenceValue},
+            Head{_Head}
+        {}
+
+        // Fence value associated with the command list in which
+        // the allocations could have been referenced last time
+        Uint64 FenceValue;
+
+        // Virtual head position at the end of the frame
+        Uint64 Head;
+    };
+    std::deque<FrameHeadAttribs, STDAllocatorRawMem<FrameHeadAttribs>> m_CompletedFrameHeads;
+
+    const OffsetType m_MaxSize;
+
+    // Virtual positions that only grow. The physical offset is the position modulo m_MaxSize.
+    std::atomic<Uint64> m_Head{0};
+    std::atomic<Uint64> m_Tail{0};
+};
+
+} // namespace Diligent
@@ -36,10 +36,25 @@
 
 #include "../../../Primitives/interface/BasicTypes.h"
 #include "../../../Common/interface/HashUtils.hpp"
+#include "ShelfAtlasManager.hpp"
 
 namespace Diligent
 {
 
+/// Region management policy of DynamicAtlasManager
+enum DYNAMIC_ATLAS_MANAGER_POLICY : Uint8
+{
+    /// Free space is recursively split into a tree of rectangles. Free rectangles
+    /// are kept in two ordered maps, and every split or merge allocates or releases
+    /// tree and map nodes. The policy works well for regions of arbitrary shape.
+    DYNAMIC_ATLAS_MANAGER_POLICY_TREE = 0,
+
+    /// Regions of similar height are packed into horizontal shelves (see ShelfAtlasManager).
+    /// Allocations take O(1) time in a typical case, and no memory is allocated in a steady state.
+    /// The policy works best for many small regions of similar height, e.g. glyphs.
+    DYNAMIC_ATLAS_MANAGER_POLICY_SHELF
+};
+
 /// Dynamic 2D atlas manager
 class DynamicAtlasManager
 {
@@ -98,7 +113,7 @@ public:
         };
     };
 
-    DynamicAtlasManager(Uint32 Width, Uint32 Height);
+    DynamicAtlasManager(Uint32 Width, Uint32 Height, DYNAMIC_ATLAS_MANAGER_POLICY Policy = DYNAMIC_ATLAS_MANAGER_POLICY_TREE);
     ~DynamicAtlasManager();
 
     // clang-format off
@@ -113,6 +128,9 @@ public:
 
     Uint32 GetFreeRegionCount() const
     {
+        if (m_Policy == DYNAMIC_ATLAS_MANAGER_POLICY_SHELF)
+            return m_Shelf.GetFreeRegionCount();
+
         VERIFY_EXPR(m_FreeRegionsByWidth.size() == m_FreeRegionsByHeight.size());
         return static_cast<Uint32>(m_FreeRegionsByWidth.size());
     }
@@ -121,8 +139,16 @@ public:
     Uint32 GetHeight() const { return m_Height; }
     Uint64 GetTotalFreeArea() const { return m_TotalFreeArea; }
 
+    DYNAMIC_ATLAS_MANAGER_POLICY GetPolicy() const { return m_Policy; }
+
     bool IsEmpty() const
     {
+        if (m_Policy == DYNAMIC_ATLAS_MANAGER_POLICY_SHELF)
+        {
+            VERIFY_EXPR((m_Shelf.GetAllocationCount() == 0) == (m_TotalFreeArea == Uint64{m_Width} * Uint64{m_Height}));
+            return m_Shelf.GetAllocationCount() == 0;
+        }
+
         VERIFY_EXPR(m_AllocatedRegions.empty() && (m_TotalFreeArea == Uint64{m_Width} * Uint64{m_Height}) ||
                     !m_AllocatedRegions.empty() && (m_TotalFreeArea < Uint64{m_Width} * Uint64{m_Height}));
         return m_AllocatedRegions.empty();
@@ -229,6 +255,11 @@ private:
     std::map<Region, Node*, HeightFirstCompare> m_FreeRegionsByHeight;
     // Allocated regions
     std::unordered_map<Region, Node*, Region::Hasher> m_AllocatedRegions;
+
+    // Only used in DYNAMIC_ATLAS_MANAGER_POLICY_SHELF mode
+    ShelfAtlasManager m_Shelf;
+
+    DYNAMIC_ATLAS_MANAGER_POLICY m_Policy = DYNAMIC_ATLAS_MANAGER_POLICY_TREE;
 };
 
 } // namespace Diligent
@@ -36,6 +36,7 @@
 #include "../../GraphicsEngine/interface/Buffer.h"
 #include "../../GraphicsEngine/interface/RenderDevice.h"
 #include "../../Archiver/interface/Archiver.h"
+#include "TextureFormatTables.hpp"
 #include "../../../Common/interface/BasicMath.hpp"
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 #include "../../../Platforms/interface/PlatformMisc.hpp"
@@ -172,7 +173,18 @@ const Char* GetValueTypeString(VALUE_TYPE Val);
 /// \param [in] Format - Texture format which attributes are requested for.
 /// \return Constant reference to the TextureFormatAttribs structure containing
 ///         format attributes.
-const TextureFormatAttribs& GetTextureFormatAttribs(TEXTURE_FORMAT Format);
+inline const TextureFormatAttribs& GetTextureFormatAttribs(TEXTURE_FORMAT Format)
+{
+    if (Format >= TEX_FORMAT_UNKNOWN && Format < TEX_FORMAT_NUM_FORMATS)
+    {
+        return TextureFormatTables<>::FormatAttribs[Format];
+    }
+    else
+    {
+        UNEXPECTED("Texture format (", int{Format}, ") is out of allowed range [0, ", int{TEX_FORMAT_NUM_FORMATS} - 1, "]");
+        return TextureFormatTables<>::FormatAttribs[TEX_FORMAT_UNKNOWN];
+    }
+}
 
 /// Returns the default format for a specified texture view type
 
@@ -193,7 +205,17 @@ const TextureFormatAttribs& GetTextureFormatAttribs(TEXTURE_FORMAT Format);
 /// \param [in] ViewType - texture view type
 /// \param [in] BindFlags - texture bind flags
 /// \return  texture view type format
-TEXTURE_FORMAT GetDefaultTextureViewFormat(TEXTURE_FORMAT TextureFormat, TEXTURE_VIEW_TYPE ViewType, Uint32 BindFlags);
+inline TEXTURE_FORMAT GetDefaultTextureViewFormat(TEXTURE_FORMAT TextureFormat, TEXTURE_VIEW_TYPE ViewType, Uint32 BindFlags)
+{
+    VERIFY(ViewType > TEXTURE_VIEW_UNDEFINED && ViewType < TEXTURE_VIEW_NUM_VIEWS, "Unexpected texture view type");
+    VERIFY(TextureFormat >= TEX_FORMAT_UNKNOWN && TextureFormat < TEX_FORMAT_NUM_FORMATS, "Unknown texture format");
+    if (TextureFormat == TEX_FORMAT_R16_TYPELESS && (BindFlags & BIND_DEPTH_STENCIL) != 0)
+    {
+        return ViewType == TEXTURE_VIEW_DEPTH_STENCIL ? TEX_FORMAT_D16_UNORM : TEX_FORMAT_R16_UNORM;
+    }
+
+    return TextureFormatTables<>::ViewFormats[TextureFormat][ViewType - 1];
+}
 
 /// Returns the default format for a specified texture view type
 
@@ -727,6 +749,13 @@ TEXTURE_FORMAT TexFormatToSRGB(TEXTURE_FORMAT Fmt);
 
 String GetPipelineShadingRateFlagsString(PIPELINE_SHADING_RATE_FLAGS Flags);
 
+String GetPipelineDynamicStateFlagsString(PIPELINE_DYNAMIC_STATE_FLAGS Flags);
+
+/// Returns true if the two primitive topologies are of the same class
+/// (point, line, triangle or patch list), which is required to
+/// change the topology when PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY is used.
+bool IsSamePrimitiveTopologyClass(PRIMITIVE_TOPOLOGY Topology1, PRIMITIVE_TOPOLOGY Topology2);
+
 /// Returns the sparse texture properties assuming the standard tile shapes
 SparseTextureProperties GetStandardSparseTextureProperties(const TextureDesc& TexDesc);
 
@@ -0,0 +1,207 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of Diligent::LinearProbingTable class
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <utility>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Open-addressing hash table with linear probing and backward-shift deletion.
+
+/// \tparam SlotType       - type of the table slot.
+/// \tparam SlotTraitsType - type that defines the empty slot. It must provide
+///                          static SlotType EmptySlot() and static bool IsEmpty(const SlotType&).
+/// \tparam AllocatorType  - slot allocator type.
+///
+/// The table does not store the hashes. The key of a slot is often kept outside of the
+/// table (e.g. the slot is an index into an array of blocks), so every operation
+/// that moves existing slots takes the GetSlotHash callable that extracts the key
+/// of the slot and returns its 64-bit hash: Uint64 GetSlotHash(const SlotType&).
+///
+/// The capacity is either zero or a power of two, and the load factor is kept
+/// at or below 1/2. Home positions are computed with Fibonacci hashing.
+template <typename SlotType, typename SlotTraitsType, typename AllocatorType = std::allocator<SlotType>>
+class LinearProbingTable
+{
+public:
+    static constexpr size_t InvalidPos      = ~size_t{0};
+    static constexpr Uint32 MinCapacityLog2 = 4;
+
+    explicit LinearProbingTable(const AllocatorType& Allocator = AllocatorType{}) :
+        m_Slots(Allocator)
+    {}
+
+    size_t GetSize() const { return m_NumEntries; }
+    size_t GetCapacity() const { return m_Slots.size(); }
+
+    bool IsOccupied(size_t Pos) const { return !SlotTraitsType::IsEmpty(m_Slots[Pos]); }
+
+    SlotType&       operator[](size_t Pos) { return m_Slots[Pos]; }
+    const SlotType& operator[](size_t Pos) const { return m_Slots[Pos]; }
+
+    size_t GetHomePos(Uint64 Hash) const
+    {
+        VERIFY_EXPR(m_CapacityLog2 > 0);
+        // Fibonacci hashing: the top bits of the product are well mixed
+        return static_cast<size_t>((Hash * Uint64{0x9E3779B97F4A7C15}) >> (64 - m_CapacityLog2));
+    }
+
+    /// Returns the position of the first slot in the probe sequence of Hash
+    /// for which IsMatch(Slot) returns true, or InvalidPos if there is no such slot.
+    template <typename MatchFuncType>
+    size_t Find(Uint64 Hash, MatchFuncType&& IsMatch) const
+    {
+        if (m_NumEntries == 0)
+            return InvalidPos;
+
+        const auto Mask = m_Slots.size() - 1;
+        for (auto Pos = GetHomePos(Hash); IsOccupied(Pos); Pos = (Pos + 1) & Mask)
+        {
+            if (IsMatch(m_Slots[Pos]))
+                return Pos;
+        }
+        return InvalidPos;
+    }
+
+    /// Returns true if the table must grow before a new slot can be inserted.
+    bool NeedsGrow() const
+    {
+        // Keep the load factor at or below 1/2
+        return (m_NumEntries + 1) * 2 > m_Slots.size();
+    }
+
+    /// Doubles the capacity and reinserts the slots for which Keep(Slot) returns true.
+    template <typename SlotHashFuncType, typename KeepFuncType>
+    void Grow(SlotHashFuncType&& GetSlotHash, KeepFuncType&& Keep)
+    {
+        auto OldSlots = std::move(m_Slots);
+        m_Slots       = decltype(m_Slots)(OldSlots.get_allocator());
+
+        m_CapacityLog2 = (std::max)(m_CapacityLog2 + 1, MinCapacityLog2);
+        m_Slots.resize(size_t{1} << m_CapacityLog2, SlotTraitsType::EmptySlot());
+        m_NumEntries = 0;
+        for (auto& Slot : OldSlots)
+        {
+            if (!SlotTraitsType::IsEmpty(Slot) && Keep(Slot))
+                InsertNoGrow(GetSlotHash(Slot), std::move(Slot));
+        }
+    }
+
+    template <typename SlotHashFuncType>
+    void Grow(SlotHashFuncType&& GetSlotHash)
+    {
+        Grow(GetSlotHash, [](const SlotType&) { return true; });
+    }
+
+    /// Inserts the slot and returns its position. The table grows if necessary.
+    /// The slot must not already be in the table.
+    template <typename SlotHashFuncType>
+    size_t Insert(Uint64 Hash, SlotType Slot, SlotHashFuncType&& GetSlotHash)
+    {
+        if (NeedsGrow())
+            Grow(GetSlotHash);
+
+        return InsertNoGrow(Hash, std::move(Slot));
+    }
+
+    /// Removes the slot at the given position.
+
+    /// Other slots may be moved to lower positions, including Pos itself,
+    /// so the slot at Pos must be checked again when iterating over the table.
+    template <typename SlotHashFuncType>
+    void Remove(size_t Pos, SlotHashFuncType&& GetSlotHash)
+    {
+        VERIFY_EXPR(IsOccupied(Pos));
+        const auto Mask = m_Slots.size() - 1;
+
+        // Backward-shift deletion keeps probe sequences intact without tombstones
+        auto Hole = Pos;
+        for (auto i = (Pos + 1) & Mask; IsOccupied(i); i = (i + 1) & Mask)
+        {
+            const auto Home = GetHomePos(GetSlotHash(m_Slots[i]));
+            if (((i - Home) & Mask) >= ((i - Hole) & Mask))
+            {
+                m_Slots[Hole] = std::move(m_Slots[i]);
+                Hole          = i;
+            }
+        }
+        m_Slots[Hole] = SlotTraitsType::EmptySlot();
+        --m_NumEntries;
+    }
+
+private:
+    size_t InsertNoGrow(Uint64 Hash, SlotType&& Slot)
+    {
+        VERIFY_EXPR(!SlotTraitsType::IsEmpty(Slot));
+        VERIFY_EXPR(m_NumEntries < m_Slots.size());
+
+        const auto Mask = m_Slots.size() - 1;
+
+        auto Pos = GetHomePos(Hash);
+        while (IsOccupied(Pos))
+            Pos = (Pos + 1) & Mask;
+
+        m_Slots[Pos] = std::move(Slot);
+        ++m_NumEntries;
+        return Pos;
+    }
+
+private:
+    std::vector<SlotType, AllocatorType> m_Slots;
+
+    size_t m_NumEntries   = 0;
+    Uint32 m_CapacityLog2 = 0;
+};
+
+template <typename SlotType, typename SlotTraitsType, typename AllocatorType>
+constexpr size_t LinearProbingTable<SlotType, SlotTraitsType, AllocatorType>::InvalidPos;
+
+template <typename SlotType, typename SlotTraitsType, typename AllocatorType>
+constexpr Uint32 LinearProbingTable<SlotType, SlotTraitsType, AllocatorType>::MinCapacityLog2;
+
+
+/// Slot traits for tables that store Uint32 indices, where ~0u marks the empty slot.
+struct LinearProbingIndexSlotTraits
+{
+    static constexpr Uint32 EmptyIndex = ~0u;
+
+    static Uint32 EmptySlot() { return EmptyIndex; }
+    static bool   IsEmpty(Uint32 Idx) { return Idx == EmptyIndex; }
+};
+
+} // namespace Diligent
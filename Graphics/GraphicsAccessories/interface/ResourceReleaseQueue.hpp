@@ -35,7 +35,10 @@
 
 #include <mutex>
 #include <deque>
+#include <vector>
 #include <atomic>
+#include <chrono>
+#include <utility>
 
 #include "../../../Primitives/interface/MemoryAllocator.h"
 #include "../../../Common/interface/STDAllocator.hpp"
@@ -220,6 +223,10 @@ private:
 ///   the command list
 /// * Resources are removed and actually destroyed from the queue when fence is signaled and the queue is Purged
 ///
+/// Stale resources are added to a lock-free list, so that threads that release resources never block
+/// each other or the thread that submits command lists. Resources are destroyed outside of the
+/// release queue lock, so Purge() may run on a background thread concurrently with other methods.
+///
 /// \tparam ResourceWrapperType -  Type of the resource wrapper used by the release queue.
 template <typename ResourceWrapperType>
 class ResourceReleaseQueue
@@ -227,6 +234,7 @@ class ResourceReleaseQueue
 public:
     // clang-format off
     ResourceReleaseQueue(IMemoryAllocator& Allocator) :
+        m_Allocator     {Allocator},
         m_ReleaseQueue  (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
         m_StaleResources(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>"))
     {}
@@ -234,8 +242,17 @@ public:
 
     ~ResourceReleaseQueue()
     {
-        DEV_CHECK_ERR(m_StaleResources.empty(), "Not all stale objects were destroyed");
+        DEV_CHECK_ERR(GetStaleResourceCount() == 0, "Not all stale objects were destroyed");
         DEV_CHECK_ERR(m_ReleaseQueue.empty(), "Release queue is not empty");
+
+        // Destroy the resources that have never been discarded to not leak the list nodes
+        StaleResourceNode* pNode = m_pStaleList.exchange(nullptr);
+        while (pNode != nullptr)
+        {
+            StaleResourceNode* pNext = pNode->pNext;
+            DestroyNode(pNode);
+            pNode = pNext;
+        }
     }
 
     /// Creates a resource wrapper for the specific resource type
@@ -261,8 +278,8 @@ public:
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
     void SafeReleaseResource(ResourceWrapperType&& Wrapper, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, std::move(Wrapper));
+        auto* pNode = CreateNode(NextCommandListNumber, std::move(Wrapper));
+        PushStaleNodes(pNode, pNode, 1);
     }
 
     /// Moves a copy of the resource wrapper to the stale resources queue
@@ -270,8 +287,36 @@ public:
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
     void SafeReleaseResource(const ResourceWrapperType& Wrapper, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, Wrapper);
+        auto* pNode = CreateNode(NextCommandListNumber, Wrapper);
+        PushStaleNodes(pNode, pNode, 1);
+    }
+
+    /// Moves multiple resources to the stale resources queue
+    /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
+    /// \param [in] Iterator              - Iterator that returns resources to be released.
+    ///
+    /// \remarks    All resources are added to the queue with a single atomic operation.
+    template <typename ResourceType, typename IteratorType>
+    void SafeReleaseResources(Uint64 NextCommandListNumber, IteratorType Iterator)
+    {
+        // Build the list in the same order as the lock-free list, i.e. the last resource is the first node
+        StaleResourceNode* pFirst = nullptr;
+        StaleResourceNode* pLast  = nullptr;
+        size_t             Count  = 0;
+
+        ResourceType Resource;
+        while (Iterator(Resource))
+        {
+            auto* pNode  = CreateNode(NextCommandListNumber, CreateWrapper(std::move(Resource), 1));
+            pNode->pNext = pFirst;
+            pFirst       = pNode;
+            if (pLast == nullptr)
+                pLast = pNode;
+            ++Count;
+        }
+
+        if (pFirst != nullptr)
+            PushStaleNodes(pFirst, pLast, Count);
     }
 
     /// Adds a resource directly to the release queue
@@ -324,60 +369,171 @@ public:
     ///                                      is greater or equal to the fence value associated with the resource
     void DiscardStaleResources(Uint64 SubmittedCmdBuffNumber, Uint64 FenceValue)
     {
+        // The mutex only serializes the threads that discard stale resources.
+        // Threads that release resources are never blocked.
+        std::lock_guard<std::mutex> StaleObjectsLock(m_StaleObjectsMutex);
+
+        // Take all resources released since the last call. The list is in reverse order.
+        StaleResourceNode* pNode = m_pStaleList.exchange(nullptr, std::memory_order_acquire);
+        if (pNode != nullptr)
+        {
+            StaleResourceNode* pReversed = nullptr;
+            while (pNode != nullptr)
+            {
+                StaleResourceNode* pNext = pNode->pNext;
+                pNode->pNext             = pReversed;
+                pReversed                = pNode;
+                pNode                    = pNext;
+            }
+
+            while (pReversed != nullptr)
+            {
+                StaleResourceNode* pNext = pReversed->pNext;
+                m_StaleResources.emplace_back(pReversed->CmdBufferNumber, std::move(pReversed->Wrapper));
+                DestroyNode(pReversed);
+                pReversed = pNext;
+            }
+        }
+
         // Only discard these stale objects that were released before CmdBuffNumber
         // was executed
-        std::lock_guard<std::mutex> StaleObjectsLock(m_StaleObjectsMutex);
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        while (!m_StaleResources.empty())
+        size_t NumToDiscard = 0;
+        while (NumToDiscard < m_StaleResources.size() && m_StaleResources[NumToDiscard].first <= SubmittedCmdBuffNumber)
+            ++NumToDiscard;
+        if (NumToDiscard == 0)
+            return;
+
         {
-            auto& FirstStaleObj = m_StaleResources.front();
-            if (FirstStaleObj.first <= SubmittedCmdBuffNumber)
+            std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
+            for (size_t i = 0; i < NumToDiscard; ++i)
             {
-                m_ReleaseQueue.emplace_back(FenceValue, std::move(FirstStaleObj.second));
+                m_ReleaseQueue.emplace_back(FenceValue, std::move(m_StaleResources.front().second));
                 m_StaleResources.pop_front();
             }
-            else
-                break;
         }
+        m_StaleResourceCount.fetch_sub(NumToDiscard);
     }
 
 
-    /// Removes all objects from the release queue whose fence value is
+    /// Destroys all objects in the release queue whose fence value is
     /// less than or equal to CompletedFenceValue
     /// \param [in] CompletedFenceValue  -  Value of the fence that has been completed by the GPU
-    void Purge(Uint64 CompletedFenceValue)
+    /// \param [in] MaxTimeInMicroseconds - The maximum time, in microseconds, to spend destroying the objects.
+    ///                                     Zero means no limit. The objects that are not destroyed remain in
+    ///                                     the queue until the next call.
+    ///
+    /// \return     true if all objects whose fence value is completed have been destroyed, and false otherwise.
+    ///
+    /// \remarks    Objects are destroyed outside of the queue lock in batches, so the method may be
+    ///             called from a background thread while other threads add resources to the queue.
+    bool Purge(Uint64 CompletedFenceValue, Uint32 MaxTimeInMicroseconds = 0)
     {
-        std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
+        using ClockType = std::chrono::high_resolution_clock;
+
+        const auto StartTime = MaxTimeInMicroseconds != 0 ? ClockType::now() : ClockType::time_point{};
 
-        // Release all objects whose associated fence value is at most CompletedFenceValue
-        // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
-        while (!m_ReleaseQueue.empty())
+        std::vector<ResourceWrapperType, STDAllocatorRawMem<ResourceWrapperType>> Batch(STD_ALLOCATOR_RAW_MEM(ResourceWrapperType, m_Allocator, "Allocator for vector<ResourceWrapperType>"));
+        while (true)
         {
-            auto& FirstObj = m_ReleaseQueue.front();
-            if (FirstObj.first <= CompletedFenceValue)
-                m_ReleaseQueue.pop_front();
-            else
-                break;
+            {
+                std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
+
+                // Release all objects whose associated fence value is at most CompletedFenceValue
+                // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+                while (!m_ReleaseQueue.empty() && (MaxTimeInMicroseconds == 0 || Batch.size() < PurgeBatchSize))
+                {
+                    auto& FirstObj = m_ReleaseQueue.front();
+                    if (FirstObj.first > CompletedFenceValue)
+                        break;
+
+                    Batch.emplace_back(std::move(FirstObj.second));
+                    m_ReleaseQueue.pop_front();
+                }
+                if (Batch.empty())
+                    return true;
+            }
+
+            // Destroy the objects outside of the lock
+            Batch.clear();
+
+            if (MaxTimeInMicroseconds != 0 &&
+                ClockType::now() - StartTime >= std::chrono::microseconds{MaxTimeInMicroseconds})
+            {
+                std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
+                return m_ReleaseQueue.empty() || m_ReleaseQueue.front().first > CompletedFenceValue;
+            }
         }
     }
 
     /// Returns the number of stale resources
     size_t GetStaleResourceCount() const
     {
-        return m_StaleResources.size();
+        return m_StaleResourceCount.load();
     }
 
     /// Returns the number of resources pending release
     size_t GetPendingReleaseResourceCount() const
     {
+        std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
         return m_ReleaseQueue.size();
     }
 
 private:
-    std::mutex m_ReleaseQueueMutex;
+    struct StaleResourceNode
+    {
+        template <typename WrapperType>
+        StaleResourceNode(Uint64 _CmdBufferNumber, WrapperType&& _Wrapper) :
+            CmdBufferNumber{_CmdBufferNumber},
+            Wrapper{std::forward<WrapperType>(_Wrapper)}
+        {}
+
+        const Uint64        CmdBufferNumber;
+        ResourceWrapperType Wrapper;
+        StaleResourceNode*  pNext = nullptr;
+    };
+
+    template <typename WrapperType>
+    StaleResourceNode* CreateNode(Uint64 CmdBufferNumber, WrapperType&& Wrapper)
+    {
+        void* pRawMem = m_Allocator.Allocate(sizeof(StaleResourceNode), "Stale resource node", __FILE__, __LINE__);
+        return new (pRawMem) StaleResourceNode{CmdBufferNumber, std::forward<WrapperType>(Wrapper)};
+    }
+
+    void DestroyNode(StaleResourceNode* pNode)
+    {
+        pNode->~StaleResourceNode();
+        m_Allocator.Free(pNode);
+    }
+
+    // Atomically prepends the list [pFirst, pLast] to the list of stale resources
+    void PushStaleNodes(StaleResourceNode* pFirst, StaleResourceNode* pLast, size_t Count)
+    {
+        // Increment the counter first so that it never underflows in DiscardStaleResources()
+        m_StaleResourceCount.fetch_add(Count);
+
+        pLast->pNext = m_pStaleList.load(std::memory_order_relaxed);
+        while (!m_pStaleList.compare_exchange_weak(pLast->pNext, pFirst, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // The maximum number of objects that Purge() destroys per lock when the time is limited
+    static constexpr size_t PurgeBatchSize = 64;
+
+    IMemoryAllocator& m_Allocator;
+
+    mutable std::mutex m_ReleaseQueueMutex;
     using ReleaseQueueElemType = std::pair<Uint64, ResourceWrapperType>;
     std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_ReleaseQueue;
 
+    // Lock-free list of the resources released since the last call to DiscardStaleResources(),
+    // from the most recently released to the least recently released.
+    std::atomic<StaleResourceNode*> m_pStaleList{nullptr};
+
+    // The total number of resources in m_pStaleList and m_StaleResources.
+    std::atomic<size_t> m_StaleResourceCount{0};
+
+    // Protects m_StaleResources, which is only accessed by DiscardStaleResources().
     std::mutex                                                                 m_StaleObjectsMutex;
     std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_StaleResources;
 };
@@ -0,0 +1,196 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShelfAtlasManager class
+
+#include <vector>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "LinearProbingTable.hpp"
+
+namespace Diligent
+{
+
+/// Shelf packing 2D atlas manager.
+
+/// The class implements the region management policy of DynamicAtlasManager
+/// in DYNAMIC_ATLAS_MANAGER_POLICY_SHELF mode and is not intended to be used directly.
+///
+/// The atlas is split vertically into shelves. Every shelf hosts regions of similar height
+/// (see GetShelfHeight()) that are packed left to right; the space not occupied by shelves
+/// is kept as free bands. Free spans of every shelf height are kept in segregated lists by
+/// the span width, and a bitmap records non-empty lists, so a suitable span is found with a bit scan.
+/// Spans and shelves are nodes in pools that reference their neighbors, which makes merging on
+/// release O(1). Allocated spans are found by their origin in an open-addressing hash table.
+/// When the last region of a shelf is released, the shelf is merged with the adjacent free bands.
+/// All storage only grows, so allocate and free operations do not allocate memory in a steady state.
+class ShelfAtlasManager
+{
+public:
+    ShelfAtlasManager(Uint32 Width, Uint32 Height);
+
+    /// Creates an empty manager that can't allocate regions.
+    ShelfAtlasManager() noexcept {}
+
+    // clang-format off
+    ShelfAtlasManager           (ShelfAtlasManager&&) = default;
+    ShelfAtlasManager& operator=(ShelfAtlasManager&&) = default;
+    ShelfAtlasManager           (const ShelfAtlasManager&) = delete;
+    ShelfAtlasManager& operator=(const ShelfAtlasManager&) = delete;
+    // clang-format on
+
+    /// Allocates a Width x Height region.
+
+    /// \param [in]  Width  - Region width.
+    /// \param [in]  Height - Region height.
+    /// \param [out] X      - Region origin x coordinate.
+    /// \param [out] Y      - Region origin y coordinate.
+    /// \return       true if the allocation succeeded, and false otherwise.
+    bool Allocate(Uint32 Width, Uint32 Height, Uint32& X, Uint32& Y);
+
+    /// Releases the region previously returned by Allocate().
+
+    /// \return  false if the region has not been found among allocated regions.
+    bool Free(Uint32 X, Uint32 Y, Uint32 Width, Uint32 Height);
+
+    /// Returns the number of free spans in all shelves plus the number of free bands.
+    Uint32 GetFreeRegionCount() const { return m_NumFreeSpans + m_NumFreeBands; }
+
+    Uint32 GetAllocationCount() const { return m_NumAllocations; }
+
+    /// Returns the height of the shelf that hosts regions of the given height.
+
+    /// Heights up to 16 are used as is; larger heights are rounded up
+    /// to 1/8 of their power-of-two range, so at most 1/8 of the shelf is wasted.
+    static Uint32 GetShelfHeight(Uint32 Height);
+
+#ifdef DILIGENT_DEBUG
+    void DbgVerify() const;
+#endif
+
+private:
+    static constexpr Uint32 InvalidIndex    = ~0u;
+    static constexpr Uint32 NumWidthBuckets = 32;
+    // The number of spans in the requested width bucket that are checked before the higher buckets
+    static constexpr Uint32 MaxBucketScanLength = 8;
+
+    struct Shelf
+    {
+        Uint32 y      = 0;
+        Uint32 Height = 0;
+
+        // Vertical neighbors
+        Uint32 Prev = InvalidIndex;
+        Uint32 Next = InvalidIndex;
+
+        // Neighbors in the free band list. For unused nodes, NextFree links the list of unused nodes.
+        Uint32 PrevFree = InvalidIndex;
+        Uint32 NextFree = InvalidIndex;
+
+        Uint32 NumAllocations = 0;
+
+        // Whether this is a free band rather than a shelf
+        bool IsFree = false;
+    };
+
+    struct Span
+    {
+        Uint32 x     = 0;
+        Uint32 Width = 0;
+        // The height of the allocated region; zero for free spans
+        Uint32 Height = 0;
+
+        Uint32 Shelf = InvalidIndex;
+
+        // Horizontal neighbors in the shelf
+        Uint32 PrevPhys = InvalidIndex;
+        Uint32 NextPhys = InvalidIndex;
+
+        // Neighbors in the free list. For unused nodes, NextFree links the list of unused nodes.
+        Uint32 PrevFree = InvalidIndex;
+        Uint32 NextFree = InvalidIndex;
+
+        bool IsFree = false;
+    };
+
+    // Free spans of all shelves with the same height
+    struct HeightClass
+    {
+        explicit HeightClass(Uint32 _Height);
+
+        Uint32 Height = 0;
+        // Non-empty width buckets
+        Uint32 Bitmap = 0;
+        Uint32 FreeLists[NumWidthBuckets];
+    };
+
+    HeightClass*       FindClass(Uint32 ShelfHeight);
+    const HeightClass* FindClass(Uint32 ShelfHeight) const;
+    HeightClass&       GetClass(Uint32 ShelfHeight);
+
+    Uint32 FindFreeSpan(const HeightClass& Class, Uint32 Width) const;
+    Uint32 CreateShelf(Uint32 ShelfHeight);
+    void   ReleaseShelf(Uint32 ShelfIdx);
+
+    void InsertFreeSpan(Uint32 Idx);
+    void RemoveFreeSpan(Uint32 Idx);
+
+    void InsertFreeBand(Uint32 Idx);
+    void RemoveFreeBand(Uint32 Idx);
+
+    Uint32 CreateSpan();
+    void   ReleaseSpan(Uint32 Idx);
+    Uint32 CreateShelfNode();
+    void   ReleaseShelfNode(Uint32 Idx);
+
+    static Uint64 GetSpanKey(Uint32 X, Uint32 Y) { return (Uint64{Y} << 32u) | Uint64{X}; }
+
+    Uint64 GetUsedSpanKey(Uint32 Idx) const;
+    void   InsertUsedSpan(Uint32 Idx);
+    Uint32 RemoveUsedSpan(Uint64 Key);
+
+    Uint32 m_Width  = 0;
+    Uint32 m_Height = 0;
+
+    std::vector<Shelf>       m_Shelves;
+    std::vector<Span>        m_Spans;
+    std::vector<HeightClass> m_Classes; // Sorted by height
+    // Hash table of allocated span indices, keyed by the span origin
+    LinearProbingTable<Uint32, LinearProbingIndexSlotTraits> m_UsedSpans;
+
+    Uint32 m_FirstFreeBand    = InvalidIndex;
+    Uint32 m_FirstUnusedShelf = InvalidIndex;
+    Uint32 m_FirstUnusedSpan  = InvalidIndex;
+    Uint32 m_NumAllocations   = 0;
+    Uint32 m_NumFreeSpans     = 0;
+    Uint32 m_NumFreeBands     = 0;
+};
+
+} // namespace Diligent
@@ -0,0 +1,154 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::TLSFAllocationsManager class
+
+#include <vector>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Primitives/interface/MemoryAllocator.h"
+#include "../../../Common/interface/STDAllocator.hpp"
+#include "LinearProbingTable.hpp"
+
+namespace Diligent
+{
+
+/// Two-level segregated fit (TLSF) free block manager.
+
+/// The class implements the free block management policy of VariableSizeAllocationsManager
+/// in VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF mode and is not intended to be used directly.
+///
+/// Free blocks are kept in segregated lists. The first level splits sizes into power-of-two
+/// ranges, the second level splits every range into SLCount linear sub-ranges. Two bitmaps
+/// record non-empty lists, so a suitable list is found with a couple of bit scans. Every
+/// block, free or allocated, is a node that references its physical neighbors, which makes
+/// merging on release O(1). Allocated blocks are found by their offset in an open-addressing
+/// hash table. Nodes are recycled, and all storage only grows when the number of blocks exceeds
+/// its current capacity, so allocate and free operations do not allocate memory in a steady state.
+class TLSFAllocationsManager
+{
+public:
+    using OffsetType = size_t;
+
+    explicit TLSFAllocationsManager(IMemoryAllocator& Allocator);
+
+    // clang-format off
+    TLSFAllocationsManager           (TLSFAllocationsManager&&) = default;
+    TLSFAllocationsManager& operator=(TLSFAllocationsManager&&) = default;
+    TLSFAllocationsManager           (const TLSFAllocationsManager&) = delete;
+    TLSFAllocationsManager& operator=(const TLSFAllocationsManager&) = delete;
+    // clang-format on
+
+    /// Allocates a block that can hold Size bytes aligned by Alignment.
+
+    /// \param [in]  Size         - Allocation size, must be a multiple of Alignment.
+    /// \param [in]  Alignment    - Allocation alignment, must be power of two.
+    /// \param [out] Offset       - Unaligned offset of the allocated block.
+    /// \param [out] AdjustedSize - Size of the allocated block, including the alignment padding.
+    /// \return       true if the allocation succeeded, and false otherwise.
+    bool Allocate(OffsetType Size, OffsetType Alignment, OffsetType& Offset, OffsetType& AdjustedSize);
+
+    /// Releases the block previously returned by Allocate().
+    void Free(OffsetType Offset, OffsetType Size);
+
+    /// Adds ExtraSize bytes to the end of the managed space.
+    void Extend(OffsetType ExtraSize);
+
+    /// Removes Size bytes from the end of the managed space.
+    /// Size must not exceed GetTrailingFreeSize().
+    void Shrink(OffsetType Size);
+
+    /// Returns the size of the free block at the end of the managed space.
+    OffsetType GetTrailingFreeSize() const;
+
+    size_t GetNumFreeBlocks() const { return m_NumFreeBlocks; }
+
+    OffsetType GetMaxFreeBlockSize() const;
+
+#ifdef DILIGENT_DEBUG
+    void DbgVerify(OffsetType MaxSize, OffsetType FreeSize) const;
+#endif
+
+    static constexpr Uint32 SLCountLog2 = 5;
+    static constexpr Uint32 SLCount     = 1u << SLCountLog2;
+    // Sizes below SLCount use the first level linearly, larger sizes use one level per power of two.
+    static constexpr Uint32 FLCount = sizeof(OffsetType) * 8 - SLCountLog2 + 1;
+
+private:
+    static constexpr Uint32 InvalidIndex = ~0u;
+
+    struct Block
+    {
+        OffsetType Offset = 0;
+        OffsetType Size   = 0;
+
+        // Physical neighbors
+        Uint32 PrevPhys = InvalidIndex;
+        Uint32 NextPhys = InvalidIndex;
+
+        // Neighbors in the free list. For unused nodes, NextFree links the list of unused nodes.
+        Uint32 PrevFree = InvalidIndex;
+        Uint32 NextFree = InvalidIndex;
+
+        bool IsFree = false;
+    };
+
+    static void MapSize(OffsetType Size, Uint32& FL, Uint32& SL);
+
+    Uint32 FindFreeBlock(OffsetType Size, OffsetType Alignment) const;
+    Uint32 FindFreeList(OffsetType Size) const;
+
+    void InsertFreeBlock(Uint32 Idx);
+    void RemoveFreeBlock(Uint32 Idx);
+
+    Uint32 CreateBlock(OffsetType Offset, OffsetType Size);
+    void   ReleaseBlock(Uint32 Idx);
+
+    void   InsertUsedBlock(Uint32 Idx);
+    Uint32 RemoveUsedBlock(OffsetType Offset);
+
+    std::vector<Block, STDAllocatorRawMem<Block>> m_Blocks;
+
+    // FLCount x SLCount free list heads
+    std::vector<Uint32, STDAllocatorRawMem<Uint32>> m_FreeLists;
+    // Second-level bitmaps, one per first level
+    std::vector<Uint32, STDAllocatorRawMem<Uint32>> m_SLBitmaps;
+    // Hash table of allocated block indices, keyed by the block offset
+    LinearProbingTable<Uint32, LinearProbingIndexSlotTraits, STDAllocatorRawMem<Uint32>> m_UsedBlocks;
+
+    Uint64 m_FLBitmap = 0;
+
+    OffsetType m_MaxSize = 0;
+
+    Uint32 m_FirstUnusedBlock = InvalidIndex;
+    Uint32 m_LastBlock        = InvalidIndex;
+    size_t m_NumFreeBlocks    = 0;
+};
+
+} // namespace Diligent
@@ -0,0 +1,300 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines compile-time texture format attribute and view format tables
+
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
+#include "../../GraphicsEngine/interface/TextureView.h"
+#include "../../../Platforms/interface/PlatformDefinitions.h"
+
+namespace Diligent
+{
+
+/// Compile-time tables indexed by the texture format.
+
+/// The tables are static members of a class template, so that they are defined in the header
+/// and every translation unit shares the same instance.
+/// Use GetTextureFormatAttribs() and GetDefaultTextureViewFormat() to access the tables.
+template <typename DummyType = void>
+struct TextureFormatTables
+{
+    /// Texture format attributes, see Diligent::TextureFormatAttribs.
+    // clang-format off
+    static constexpr TextureFormatAttribs FormatAttribs[] =
+    {
+#define TEX_FORMAT_ATTRIBS(TexFmt, ComponentSize, NumComponents, ComponentType, IsTypeless, BlockWidth, BlockHeight) \
+        TextureFormatAttribs{#TexFmt, TexFmt, ComponentSize, NumComponents, ComponentType, IsTypeless, BlockWidth, BlockHeight}
+
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_UNKNOWN,                     0, 0, COMPONENT_TYPE_UNDEFINED,  false, 0, 0),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGBA32_TYPELESS,             4, 4, COMPONENT_TYPE_UNDEFINED,  true,  1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGBA32_FLOAT,                4, 4, COMPONENT_TYPE_FLOAT,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGBA32_UINT,                 4, 4, COMPONENT_TYPE_UINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGBA32_SINT,                 4, 4, COMPONENT_TYPE_SINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGB32_TYPELESS,              4, 3, COMPONENT_TYPE_UNDEFINED,  true,  1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGB32_FLOAT,                 4, 3, COMPONENT_TYPE_FLOAT,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGB32_UINT,                  4, 3, COMPONENT_TYPE_UINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGB32_SINT,                  4, 3, COMPONENT_TYPE_SINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGBA16_TYPELESS,             2, 4, COMPONENT_TYPE_UNDEFINED,  true,  1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGBA16_FLOAT,                2, 4, COMPONENT_TYPE_FLOAT,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGBA16_UNORM,                2, 4, COMPONENT_TYPE_UNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGBA16_UINT,                 2, 4, COMPONENT_TYPE_UINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGBA16_SNORM,                2, 4, COMPONENT_TYPE_SNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGBA16_SINT,                 2, 4, COMPONENT_TYPE_SINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RG32_TYPELESS,               4, 2, COMPONENT_TYPE_UNDEFINED,  true,  1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RG32_FLOAT,                  4, 2, COMPONENT_TYPE_FLOAT,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RG32_UINT,                   4, 2, COMPONENT_TYPE_UINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RG32_SINT,                   4, 2, COMPONENT_TYPE_SINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R32G8X24_TYPELESS,           4, 2, COMPONENT_TYPE_DEPTH_STENCIL, true,  1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_D32_FLOAT_S8X24_UINT,        4, 2, COMPONENT_TYPE_DEPTH_STENCIL, false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R32_FLOAT_X8X24_TYPELESS,    4, 2, COMPONENT_TYPE_DEPTH_STENCIL, false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_X32_TYPELESS_G8X24_UINT,     4, 2, COMPONENT_TYPE_DEPTH_STENCIL, false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGB10A2_TYPELESS,            4, 1, COMPONENT_TYPE_COMPOUND,   true,  1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGB10A2_UNORM,               4, 1, COMPONENT_TYPE_COMPOUND,   false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGB10A2_UINT,                4, 1, COMPONENT_TYPE_COMPOUND,   false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R11G11B10_FLOAT,             4, 1, COMPONENT_TYPE_COMPOUND,   false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGBA8_TYPELESS,              1, 4, COMPONENT_TYPE_UNDEFINED,  true,  1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGBA8_UNORM,                 1, 4, COMPONENT_TYPE_UNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGBA8_UNORM_SRGB,            1, 4, COMPONENT_TYPE_UNORM_SRGB, false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGBA8_UINT,                  1, 4, COMPONENT_TYPE_UINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGBA8_SNORM,                 1, 4, COMPONENT_TYPE_SNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGBA8_SINT,                  1, 4, COMPONENT_TYPE_SINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RG16_TYPELESS,               2, 2, COMPONENT_TYPE_UNDEFINED,  true,  1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RG16_FLOAT,                  2, 2, COMPONENT_TYPE_FLOAT,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RG16_UNORM,                  2, 2, COMPONENT_TYPE_UNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RG16_UINT,                   2, 2, COMPONENT_TYPE_UINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RG16_SNORM,                  2, 2, COMPONENT_TYPE_SNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RG16_SINT,                   2, 2, COMPONENT_TYPE_SINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R32_TYPELESS,                4, 1, COMPONENT_TYPE_UNDEFINED,  true,  1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_D32_FLOAT,                   4, 1, COMPONENT_TYPE_DEPTH,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R32_FLOAT,                   4, 1, COMPONENT_TYPE_FLOAT,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R32_UINT,                    4, 1, COMPONENT_TYPE_UINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R32_SINT,                    4, 1, COMPONENT_TYPE_SINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R24G8_TYPELESS,              4, 1, COMPONENT_TYPE_DEPTH_STENCIL, true,  1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_D24_UNORM_S8_UINT,           4, 1, COMPONENT_TYPE_DEPTH_STENCIL, false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R24_UNORM_X8_TYPELESS,       4, 1, COMPONENT_TYPE_DEPTH_STENCIL, false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_X24_TYPELESS_G8_UINT,        4, 1, COMPONENT_TYPE_DEPTH_STENCIL, false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RG8_TYPELESS,                1, 2, COMPONENT_TYPE_UNDEFINED,  true,  1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RG8_UNORM,                   1, 2, COMPONENT_TYPE_UNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RG8_UINT,                    1, 2, COMPONENT_TYPE_UINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RG8_SNORM,                   1, 2, COMPONENT_TYPE_SNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RG8_SINT,                    1, 2, COMPONENT_TYPE_SINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R16_TYPELESS,                2, 1, COMPONENT_TYPE_UNDEFINED,  true,  1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R16_FLOAT,                   2, 1, COMPONENT_TYPE_FLOAT,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_D16_UNORM,                   2, 1, COMPONENT_TYPE_DEPTH,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R16_UNORM,                   2, 1, COMPONENT_TYPE_UNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R16_UINT,                    2, 1, COMPONENT_TYPE_UINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R16_SNORM,                   2, 1, COMPONENT_TYPE_SNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R16_SINT,                    2, 1, COMPONENT_TYPE_SINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R8_TYPELESS,                 1, 1, COMPONENT_TYPE_UNDEFINED,  true,  1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R8_UNORM,                    1, 1, COMPONENT_TYPE_UNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R8_UINT,                     1, 1, COMPONENT_TYPE_UINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R8_SNORM,                    1, 1, COMPONENT_TYPE_SNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R8_SINT,                     1, 1, COMPONENT_TYPE_SINT,       false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_A8_UNORM,                    1, 1, COMPONENT_TYPE_UNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R1_UNORM,                    1, 1, COMPONENT_TYPE_UNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RGB9E5_SHAREDEXP,            4, 1, COMPONENT_TYPE_COMPOUND,   false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_RG8_B8G8_UNORM,              1, 4, COMPONENT_TYPE_UNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_G8R8_G8B8_UNORM,             1, 4, COMPONENT_TYPE_UNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC1_TYPELESS,                8, 3, COMPONENT_TYPE_COMPRESSED, true,  4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC1_UNORM,                   8, 3, COMPONENT_TYPE_COMPRESSED, false, 4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC1_UNORM_SRGB,              8, 3, COMPONENT_TYPE_COMPRESSED, false, 4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC2_TYPELESS,               16, 4, COMPONENT_TYPE_COMPRESSED, true,  4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC2_UNORM,                  16, 4, COMPONENT_TYPE_COMPRESSED, false, 4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC2_UNORM_SRGB,             16, 4, COMPONENT_TYPE_COMPRESSED, false, 4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC3_TYPELESS,               16, 4, COMPONENT_TYPE_COMPRESSED, true,  4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC3_UNORM,                  16, 4, COMPONENT_TYPE_COMPRESSED, false, 4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC3_UNORM_SRGB,             16, 4, COMPONENT_TYPE_COMPRESSED, false, 4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC4_TYPELESS,                8, 1, COMPONENT_TYPE_COMPRESSED, true,  4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC4_UNORM,                   8, 1, COMPONENT_TYPE_COMPRESSED, false, 4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC4_SNORM,                   8, 1, COMPONENT_TYPE_COMPRESSED, false, 4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC5_TYPELESS,               16, 2, COMPONENT_TYPE_COMPRESSED, true,  4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC5_UNORM,                  16, 2, COMPONENT_TYPE_COMPRESSED, false, 4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC5_SNORM,                  16, 2, COMPONENT_TYPE_COMPRESSED, false, 4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_B5G6R5_UNORM,                2, 1, COMPONENT_TYPE_COMPOUND,   false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_B5G5R5A1_UNORM,              2, 1, COMPONENT_TYPE_COMPOUND,   false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BGRA8_UNORM,                 1, 4, COMPONENT_TYPE_UNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BGRX8_UNORM,                 1, 4, COMPONENT_TYPE_UNORM,      false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_R10G10B10_XR_BIAS_A2_UNORM,  4, 1, COMPONENT_TYPE_COMPOUND,   false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BGRA8_TYPELESS,              1, 4, COMPONENT_TYPE_UNDEFINED,  true,  1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BGRA8_UNORM_SRGB,            1, 4, COMPONENT_TYPE_UNORM_SRGB, false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BGRX8_TYPELESS,              1, 4, COMPONENT_TYPE_UNDEFINED,  true,  1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BGRX8_UNORM_SRGB,            1, 4, COMPONENT_TYPE_UNORM_SRGB, false, 1, 1),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC6H_TYPELESS,              16, 3, COMPONENT_TYPE_COMPRESSED, true,  4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC6H_UF16,                  16, 3, COMPONENT_TYPE_COMPRESSED, false, 4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC6H_SF16,                  16, 3, COMPONENT_TYPE_COMPRESSED, false, 4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC7_TYPELESS,               16, 4, COMPONENT_TYPE_COMPRESSED, true,  4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC7_UNORM,                  16, 4, COMPONENT_TYPE_COMPRESSED, false, 4, 4),
+        TEX_FORMAT_ATTRIBS(TEX_FORMAT_BC7_UNORM_SRGB,             16, 4, COMPONENT_TYPE_COMPRESSED, false, 4, 4),
+
+#undef TEX_FORMAT_ATTRIBS
+    };
+    // clang-format on
+
+    /// Default view formats for the SRV, RTV, DSV, UAV and shading rate views, indexed by TEXTURE_VIEW_TYPE - 1.
+    // clang-format off
+    static constexpr TEXTURE_FORMAT ViewFormats[][TEXTURE_VIEW_NUM_VIEWS - 1] =
+    {
+#define TEX_VIEW_FORMATS(TexFmt, SRVFmt, RTVFmt, DSVFmt, UAVFmt, ShadingRateFmt) \
+        {TEX_FORMAT_##SRVFmt, TEX_FORMAT_##RTVFmt, TEX_FORMAT_##DSVFmt, TEX_FORMAT_##UAVFmt, TEX_FORMAT_##ShadingRateFmt}
+
+        TEX_VIEW_FORMATS(TEX_FORMAT_UNKNOWN,                    UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGBA32_TYPELESS,            RGBA32_FLOAT, RGBA32_FLOAT, UNKNOWN, RGBA32_FLOAT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGBA32_FLOAT,               RGBA32_FLOAT, RGBA32_FLOAT, UNKNOWN, RGBA32_FLOAT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGBA32_UINT,                RGBA32_UINT, RGBA32_UINT, UNKNOWN, RGBA32_UINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGBA32_SINT,                RGBA32_SINT, RGBA32_SINT, UNKNOWN, RGBA32_SINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGB32_TYPELESS,             RGB32_FLOAT, RGB32_FLOAT, UNKNOWN, RGB32_FLOAT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGB32_FLOAT,                RGB32_FLOAT, RGB32_FLOAT, UNKNOWN, RGB32_FLOAT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGB32_UINT,                 RGB32_UINT, RGB32_UINT, UNKNOWN, RGB32_UINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGB32_SINT,                 RGB32_SINT, RGB32_SINT, UNKNOWN, RGB32_SINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGBA16_TYPELESS,            RGBA16_FLOAT, RGBA16_FLOAT, UNKNOWN, RGBA16_FLOAT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGBA16_FLOAT,               RGBA16_FLOAT, RGBA16_FLOAT, UNKNOWN, RGBA16_FLOAT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGBA16_UNORM,               RGBA16_UNORM, RGBA16_UNORM, UNKNOWN, RGBA16_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGBA16_UINT,                RGBA16_UINT, RGBA16_UINT, UNKNOWN, RGBA16_UINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGBA16_SNORM,               RGBA16_SNORM, RGBA16_SNORM, UNKNOWN, RGBA16_SNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGBA16_SINT,                RGBA16_SINT, RGBA16_SINT, UNKNOWN, RGBA16_SINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RG32_TYPELESS,              RG32_FLOAT, RG32_FLOAT, UNKNOWN, RG32_FLOAT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RG32_FLOAT,                 RG32_FLOAT, RG32_FLOAT, UNKNOWN, RG32_FLOAT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RG32_UINT,                  RG32_UINT, RG32_UINT, UNKNOWN, RG32_UINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RG32_SINT,                  RG32_SINT, RG32_SINT, UNKNOWN, RG32_SINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R32G8X24_TYPELESS,          R32_FLOAT_X8X24_TYPELESS, UNKNOWN, D32_FLOAT_S8X24_UINT, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_D32_FLOAT_S8X24_UINT,       R32_FLOAT_X8X24_TYPELESS, UNKNOWN, D32_FLOAT_S8X24_UINT, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R32_FLOAT_X8X24_TYPELESS,   R32_FLOAT_X8X24_TYPELESS, UNKNOWN, D32_FLOAT_S8X24_UINT, R32_FLOAT_X8X24_TYPELESS, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_X32_TYPELESS_G8X24_UINT,    X32_TYPELESS_G8X24_UINT, UNKNOWN, D32_FLOAT_S8X24_UINT, X32_TYPELESS_G8X24_UINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGB10A2_TYPELESS,           RGB10A2_UNORM, RGB10A2_UNORM, UNKNOWN, RGB10A2_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGB10A2_UNORM,              RGB10A2_UNORM, RGB10A2_UNORM, UNKNOWN, RGB10A2_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGB10A2_UINT,               RGB10A2_UINT, RGB10A2_UINT, UNKNOWN, RGB10A2_UINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R11G11B10_FLOAT,            R11G11B10_FLOAT, R11G11B10_FLOAT, UNKNOWN, R11G11B10_FLOAT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGBA8_TYPELESS,             RGBA8_UNORM_SRGB, RGBA8_UNORM_SRGB, UNKNOWN, RGBA8_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGBA8_UNORM,                RGBA8_UNORM, RGBA8_UNORM, UNKNOWN, RGBA8_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGBA8_UNORM_SRGB,           RGBA8_UNORM_SRGB, RGBA8_UNORM_SRGB, UNKNOWN, RGBA8_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGBA8_UINT,                 RGBA8_UINT, RGBA8_UINT, UNKNOWN, RGBA8_UINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGBA8_SNORM,                RGBA8_SNORM, RGBA8_SNORM, UNKNOWN, RGBA8_SNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGBA8_SINT,                 RGBA8_SINT, RGBA8_SINT, UNKNOWN, RGBA8_SINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RG16_TYPELESS,              RG16_FLOAT, RG16_FLOAT, UNKNOWN, RG16_FLOAT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RG16_FLOAT,                 RG16_FLOAT, RG16_FLOAT, UNKNOWN, RG16_FLOAT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RG16_UNORM,                 RG16_UNORM, RG16_UNORM, UNKNOWN, RG16_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RG16_UINT,                  RG16_UINT, RG16_UINT, UNKNOWN, RG16_UINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RG16_SNORM,                 RG16_SNORM, RG16_SNORM, UNKNOWN, RG16_SNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RG16_SINT,                  RG16_SINT, RG16_SINT, UNKNOWN, RG16_SINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R32_TYPELESS,               R32_FLOAT, R32_FLOAT, D32_FLOAT, R32_FLOAT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_D32_FLOAT,                  R32_FLOAT, R32_FLOAT, D32_FLOAT, R32_FLOAT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R32_FLOAT,                  R32_FLOAT, R32_FLOAT, D32_FLOAT, R32_FLOAT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R32_UINT,                   R32_UINT, R32_UINT, UNKNOWN, R32_UINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R32_SINT,                   R32_SINT, R32_SINT, UNKNOWN, R32_SINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R24G8_TYPELESS,             R24_UNORM_X8_TYPELESS, UNKNOWN, D24_UNORM_S8_UINT, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_D24_UNORM_S8_UINT,          R24_UNORM_X8_TYPELESS, UNKNOWN, D24_UNORM_S8_UINT, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R24_UNORM_X8_TYPELESS,      R24_UNORM_X8_TYPELESS, UNKNOWN, D24_UNORM_S8_UINT, R24_UNORM_X8_TYPELESS, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_X24_TYPELESS_G8_UINT,       X24_TYPELESS_G8_UINT, UNKNOWN, D24_UNORM_S8_UINT, X24_TYPELESS_G8_UINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RG8_TYPELESS,               RG8_UNORM, RG8_UNORM, UNKNOWN, RG8_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RG8_UNORM,                  RG8_UNORM, RG8_UNORM, UNKNOWN, RG8_UNORM, RG8_UNORM),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RG8_UINT,                   RG8_UINT, RG8_UINT, UNKNOWN, RG8_UINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RG8_SNORM,                  RG8_SNORM, RG8_SNORM, UNKNOWN, RG8_SNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RG8_SINT,                   RG8_SINT, RG8_SINT, UNKNOWN, RG8_SINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R16_TYPELESS,               R16_FLOAT, R16_FLOAT, UNKNOWN, R16_FLOAT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R16_FLOAT,                  R16_FLOAT, R16_FLOAT, UNKNOWN, R16_FLOAT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_D16_UNORM,                  R16_UNORM, R16_UNORM, D16_UNORM, R16_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R16_UNORM,                  R16_UNORM, R16_UNORM, D16_UNORM, R16_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R16_UINT,                   R16_UINT, R16_UINT, UNKNOWN, R16_UINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R16_SNORM,                  R16_SNORM, R16_SNORM, UNKNOWN, R16_SNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R16_SINT,                   R16_SINT, R16_SINT, UNKNOWN, R16_SINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R8_TYPELESS,                R8_UNORM, R8_UNORM, UNKNOWN, R8_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R8_UNORM,                   R8_UNORM, R8_UNORM, UNKNOWN, R8_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R8_UINT,                    R8_UINT, R8_UINT, UNKNOWN, R8_UINT, R8_UINT),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R8_SNORM,                   R8_SNORM, R8_SNORM, UNKNOWN, R8_SNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R8_SINT,                    R8_SINT, R8_SINT, UNKNOWN, R8_SINT, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_A8_UNORM,                   A8_UNORM, A8_UNORM, UNKNOWN, A8_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R1_UNORM,                   R1_UNORM, R1_UNORM, UNKNOWN, R1_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RGB9E5_SHAREDEXP,           RGB9E5_SHAREDEXP, RGB9E5_SHAREDEXP, UNKNOWN, RGB9E5_SHAREDEXP, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_RG8_B8G8_UNORM,             RG8_B8G8_UNORM, RG8_B8G8_UNORM, UNKNOWN, RG8_B8G8_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_G8R8_G8B8_UNORM,            G8R8_G8B8_UNORM, G8R8_G8B8_UNORM, UNKNOWN, G8R8_G8B8_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC1_TYPELESS,               BC1_UNORM_SRGB, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC1_UNORM,                  BC1_UNORM, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC1_UNORM_SRGB,             BC1_UNORM_SRGB, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC2_TYPELESS,               BC2_UNORM_SRGB, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC2_UNORM,                  BC2_UNORM, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC2_UNORM_SRGB,             BC2_UNORM_SRGB, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC3_TYPELESS,               BC3_UNORM_SRGB, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC3_UNORM,                  BC3_UNORM, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC3_UNORM_SRGB,             BC3_UNORM_SRGB, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC4_TYPELESS,               BC4_UNORM, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC4_UNORM,                  BC4_UNORM, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC4_SNORM,                  BC4_SNORM, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC5_TYPELESS,               BC5_UNORM, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC5_UNORM,                  BC5_UNORM, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC5_SNORM,                  BC5_SNORM, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_B5G6R5_UNORM,               B5G6R5_UNORM, B5G6R5_UNORM, UNKNOWN, B5G6R5_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_B5G5R5A1_UNORM,             B5G5R5A1_UNORM, B5G5R5A1_UNORM, UNKNOWN, B5G5R5A1_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BGRA8_UNORM,                BGRA8_UNORM, BGRA8_UNORM, UNKNOWN, BGRA8_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BGRX8_UNORM,                BGRX8_UNORM, BGRX8_UNORM, UNKNOWN, BGRX8_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_R10G10B10_XR_BIAS_A2_UNORM, R10G10B10_XR_BIAS_A2_UNORM, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BGRA8_TYPELESS,             BGRA8_UNORM_SRGB, BGRA8_UNORM_SRGB, UNKNOWN, BGRA8_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BGRA8_UNORM_SRGB,           BGRA8_UNORM_SRGB, BGRA8_UNORM_SRGB, UNKNOWN, BGRA8_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BGRX8_TYPELESS,             BGRX8_UNORM_SRGB, BGRX8_UNORM_SRGB, UNKNOWN, BGRX8_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BGRX8_UNORM_SRGB,           BGRX8_UNORM_SRGB, BGRX8_UNORM_SRGB, UNKNOWN, BGRX8_UNORM, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC6H_TYPELESS,              BC6H_UF16, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC6H_UF16,                  BC6H_UF16, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC6H_SF16,                  BC6H_SF16, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC7_TYPELESS,               BC7_UNORM_SRGB, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC7_UNORM,                  BC7_UNORM, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+        TEX_VIEW_FORMATS(TEX_FORMAT_BC7_UNORM_SRGB,             BC7_UNORM_SRGB, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN),
+
+#undef TEX_VIEW_FORMATS
+    };
+    // clang-format on
+
+    static constexpr bool IsValid()
+    {
+        for (Uint32 Fmt = 0; Fmt < TEX_FORMAT_NUM_FORMATS; ++Fmt)
+        {
+            if (FormatAttribs[Fmt].Format != static_cast<TEXTURE_FORMAT>(Fmt))
+                return false;
+        }
+        return true;
+    }
+};
+
+template <typename DummyType>
+constexpr TextureFormatAttribs TextureFormatTables<DummyType>::FormatAttribs[];
+
+template <typename DummyType>
+constexpr TEXTURE_FORMAT TextureFormatTables<DummyType>::ViewFormats[][TEXTURE_VIEW_NUM_VIEWS - 1];
+
+static_assert(TEX_FORMAT_NUM_FORMATS == TEX_FORMAT_BC7_UNORM_SRGB + 1, "Not all texture formats initialized.");
+static_assert(_countof(TextureFormatTables<>::FormatAttribs) == TEX_FORMAT_NUM_FORMATS, "Not all texture format attributes initialized.");
+static_assert(_countof(TextureFormatTables<>::ViewFormats) == TEX_FORMAT_NUM_FORMATS, "Not all texture view formats initialized.");
+static_assert(TextureFormatTables<>::IsValid(), "Texture format attributes are not in the order of TEXTURE_FORMAT enum.");
+
+static_assert(TEXTURE_VIEW_SHADER_RESOURCE == 1, "TEXTURE_VIEW_SHADER_RESOURCE == 1 expected");
+static_assert(TEXTURE_VIEW_RENDER_TARGET == 2, "TEXTURE_VIEW_RENDER_TARGET == 2 expected");
+static_assert(TEXTURE_VIEW_DEPTH_STENCIL == 3, "TEXTURE_VIEW_DEPTH_STENCIL == 3 expected");
+static_assert(TEXTURE_VIEW_UNORDERED_ACCESS == 4, "TEXTURE_VIEW_UNORDERED_ACCESS == 4 expected");
+static_assert(TEXTURE_VIEW_SHADING_RATE == 5, "TEXTURE_VIEW_SHADING_RATE == 5 expected");
+
+} // namespace Diligent
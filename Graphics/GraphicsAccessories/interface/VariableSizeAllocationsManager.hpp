@@ -37,9 +37,24 @@
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 #include "../../../Common/interface/Align.hpp"
 #include "../../../Common/interface/STDAllocator.hpp"
+#include "TLSFAllocationsManager.hpp"
 
 namespace Diligent
 {
+
+/// Free block management policy of VariableSizeAllocationsManager
+enum VARIABLE_SIZE_ALLOCATIONS_POLICY : Uint8
+{
+    /// Free blocks are kept in two ordered maps (see the diagram below).
+    /// Allocations use the best fit and take O(log N) time, every operation
+    /// allocates or releases map nodes.
+    VARIABLE_SIZE_ALLOCATIONS_POLICY_ORDERED_MAPS = 0,
+
+    /// Free blocks are kept in two-level segregated lists (see TLSFAllocationsManager).
+    /// Allocations use a good fit and take O(1) time, no memory is allocated in a steady state.
+    VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF
+};
+
 // The class handles free memory block management to accommodate variable-size allocation requests.
 // It keeps track of free blocks only and does not record allocation sizes. The class uses two ordered maps
 // to facilitate operations. The first map keeps blocks sorted by their offsets. The second multimap keeps blocks
@@ -98,25 +113,40 @@ private:
     };
 
 public:
-    VariableSizeAllocationsManager(OffsetType MaxSize, IMemoryAllocator& Allocator) :
+    VariableSizeAllocationsManager(OffsetType                       MaxSize,
+                                   IMemoryAllocator&                Allocator,
+                                   VARIABLE_SIZE_ALLOCATIONS_POLICY Policy = VARIABLE_SIZE_ALLOCATIONS_POLICY_ORDERED_MAPS) :
         m_FreeBlocksByOffset(STD_ALLOCATOR_RAW_MEM(TFreeBlocksByOffsetMap::value_type, Allocator, "Allocator for map<OffsetType, FreeBlockInfo>")),
         m_FreeBlocksBySize(STD_ALLOCATOR_RAW_MEM(TFreeBlocksBySizeMap::value_type, Allocator, "Allocator for multimap<OffsetType, TFreeBlocksByOffsetMap::iterator>")),
+        m_TLSF(Allocator),
         m_MaxSize(MaxSize),
-        m_FreeSize(MaxSize)
+        m_FreeSize(MaxSize),
+        m_Policy(Policy)
     {
-        // Insert single maximum-size block
-        AddNewBlock(0, m_MaxSize);
-        ResetCurrAlignment();
-
+        if (m_Policy == VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF)
+        {
+            m_TLSF.Extend(m_MaxSize);
+        }
+        else
+        {
+            // Insert single maximum-size block
+            AddNewBlock(0, m_MaxSize);
+            ResetCurrAlignment();
 #ifdef DILIGENT_DEBUG
-        DbgVerifyList();
+            DbgVerifyList();
 #endif
+        }
     }
 
     ~VariableSizeAllocationsManager()
     {
 #ifdef DILIGENT_DEBUG
-        if (!m_FreeBlocksByOffset.empty() || !m_FreeBlocksBySize.empty())
+        if (m_Policy == VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF)
+        {
+            VERIFY(m_FreeSize == m_MaxSize, "Not all allocations have been released");
+            VERIFY(m_TLSF.GetNumFreeBlocks() <= 1, "Single free block is expected");
+        }
+        else if (!m_FreeBlocksByOffset.empty() || !m_FreeBlocksBySize.empty())
         {
             VERIFY(m_FreeBlocksByOffset.size() == 1, "Single free block is expected");
             VERIFY(m_FreeBlocksByOffset.begin()->first == 0, "Head chunk offset is expected to be 0");
@@ -135,9 +165,11 @@ public:
     VariableSizeAllocationsManager(VariableSizeAllocationsManager&& rhs) noexcept :
         m_FreeBlocksByOffset {std::move(rhs.m_FreeBlocksByOffset)},
         m_FreeBlocksBySize   {std::move(rhs.m_FreeBlocksBySize)  },
+        m_TLSF               {std::move(rhs.m_TLSF)              },
         m_MaxSize            {rhs.m_MaxSize      },
         m_FreeSize           {rhs.m_FreeSize     },
-        m_CurrAlignment      {rhs.m_CurrAlignment}
+        m_CurrAlignment      {rhs.m_CurrAlignment},
+        m_Policy             {rhs.m_Policy       }
     {
         // clang-format on
         rhs.m_MaxSize       = 0;
@@ -193,6 +225,19 @@ public:
         if (m_FreeSize < Size)
             return Allocation::InvalidAllocation();
 
+        if (m_Policy == VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF)
+        {
+            OffsetType Offset = 0, AdjustedSize = 0;
+            if (!m_TLSF.Allocate(Size, Alignment, Offset, AdjustedSize))
+                return Allocation::InvalidAllocation();
+
+            m_FreeSize -= AdjustedSize;
+#ifdef DILIGENT_DEBUG
+            m_TLSF.DbgVerify(m_MaxSize, m_FreeSize);
+#endif
+            return Allocation{Offset, AdjustedSize};
+        }
+
         auto AlignmentReserve = (Alignment > m_CurrAlignment) ? Alignment - m_CurrAlignment : 0;
         // Get the first block that is large enough to encompass Size + AlignmentReserve bytes
         // lower_bound() returns an iterator pointing to the first element that
@@ -259,6 +304,16 @@ public:
     {
         VERIFY_EXPR(Offset != Allocation::InvalidOffset && Offset + Size <= m_MaxSize);
 
+        if (m_Policy == VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF)
+        {
+            m_TLSF.Free(Offset, Size);
+            m_FreeSize += Size;
+#ifdef DILIGENT_DEBUG
+            m_TLSF.DbgVerify(m_MaxSize, m_FreeSize);
+#endif
+            return;
+        }
+
         // Find the first element whose offset is greater than the specified offset.
         // upper_bound() returns an iterator pointing to the first element in the
         // container whose key is considered to go after k.
@@ -359,18 +414,37 @@ public:
     OffsetType GetUsedSize()const{return m_MaxSize - m_FreeSize;}
     // clang-format on
 
+    VARIABLE_SIZE_ALLOCATIONS_POLICY GetPolicy() const { return m_Policy; }
+
     size_t GetNumFreeBlocks() const
     {
+        if (m_Policy == VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF)
+            return m_TLSF.GetNumFreeBlocks();
+
         return m_FreeBlocksByOffset.size();
     }
 
     OffsetType GetMaxFreeBlockSize() const
     {
+        if (m_Policy == VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF)
+            return m_TLSF.GetMaxFreeBlockSize();
+
         return !m_FreeBlocksBySize.empty() ? m_FreeBlocksBySize.rbegin()->first : 0;
     }
 
     void Extend(size_t ExtraSize)
     {
+        if (m_Policy == VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF)
+        {
+            m_TLSF.Extend(ExtraSize);
+            m_MaxSize += ExtraSize;
+            m_FreeSize += ExtraSize;
+#ifdef DILIGENT_DEBUG
+            m_TLSF.DbgVerify(m_MaxSize, m_FreeSize);
+#endif
+            return;
+        }
+
         size_t NewBlockOffset = m_MaxSize;
         size_t NewBlockSize   = ExtraSize;
 
@@ -399,6 +473,65 @@ public:
         m_MaxSize += ExtraSize;
         m_FreeSize += ExtraSize;
 
+#ifdef DILIGENT_DEBUG
+        DbgVerifyList();
+#endif
+    }
+
+    /// Returns the size of the free space at the end of the managed range,
+    /// i.e. the amount by which the range can be shrunk.
+    OffsetType GetTrailingFreeSize() const
+    {
+        if (m_Policy == VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF)
+            return m_TLSF.GetTrailingFreeSize();
+
+        if (m_FreeBlocksByOffset.empty())
+            return 0;
+
+        const auto& LastBlock = *m_FreeBlocksByOffset.rbegin();
+        return LastBlock.first + LastBlock.second.Size == m_MaxSize ? LastBlock.second.Size : 0;
+    }
+
+    /// Removes Size bytes from the end of the managed range.
+    /// Size must not exceed GetTrailingFreeSize().
+    void Shrink(size_t Size)
+    {
+        if (Size == 0)
+            return;
+
+        if (Size > GetTrailingFreeSize())
+        {
+            UNEXPECTED("Shrink size (", Size, ") exceeds the size of the trailing free space (", GetTrailingFreeSize(), ")");
+            return;
+        }
+
+        if (m_Policy == VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF)
+        {
+            m_TLSF.Shrink(Size);
+            m_MaxSize -= Size;
+            m_FreeSize -= Size;
+#ifdef DILIGENT_DEBUG
+            m_TLSF.DbgVerify(m_MaxSize, m_FreeSize);
+#endif
+            return;
+        }
+
+        auto LastBlockIt = m_FreeBlocksByOffset.end();
+        --LastBlockIt;
+        const auto LastBlockOffset = LastBlockIt->first;
+        const auto LastBlockSize   = LastBlockIt->second.Size;
+
+        m_FreeBlocksBySize.erase(LastBlockIt->second.OrderBySizeIt);
+        m_FreeBlocksByOffset.erase(LastBlockIt);
+        if (LastBlockSize > Size)
+            AddNewBlock(LastBlockOffset, LastBlockSize - Size);
+
+        m_MaxSize -= Size;
+        m_FreeSize -= Size;
+
+        if (IsEmpty())
+            ResetCurrAlignment();
+
 #ifdef DILIGENT_DEBUG
         DbgVerifyList();
 #endif
@@ -461,9 +594,14 @@ private:
     TFreeBlocksByOffsetMap m_FreeBlocksByOffset;
     TFreeBlocksBySizeMap   m_FreeBlocksBySize;
 
+    // Only used in VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF mode
+    TLSFAllocationsManager m_TLSF;
+
     OffsetType m_MaxSize       = 0;
     OffsetType m_FreeSize      = 0;
     OffsetType m_CurrAlignment = 0;
+
+    VARIABLE_SIZE_ALLOCATIONS_POLICY m_Policy = VARIABLE_SIZE_ALLOCATIONS_POLICY_ORDERED_MAPS;
     // When adding new members, do not forget to update move ctor
 };
 } // namespace Diligent
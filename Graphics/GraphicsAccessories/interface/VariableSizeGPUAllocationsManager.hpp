@@ -52,8 +52,10 @@ private:
     };
 
 public:
-    VariableSizeGPUAllocationsManager(OffsetType MaxSize, IMemoryAllocator& Allocator) :
-        VariableSizeAllocationsManager{MaxSize, Allocator},
+    VariableSizeGPUAllocationsManager(OffsetType                       MaxSize,
+                                      IMemoryAllocator&                Allocator,
+                                      VARIABLE_SIZE_ALLOCATIONS_POLICY Policy = VARIABLE_SIZE_ALLOCATIONS_POLICY_ORDERED_MAPS) :
+        VariableSizeAllocationsManager{MaxSize, Allocator, Policy},
         m_StaleAllocations{0, StaleAllocationAttribs(0, 0, 0), STD_ALLOCATOR_RAW_MEM(StaleAllocationAttribs, Allocator, "Allocator for deque<StaleAllocationAttribs>")}
     {}
 
@@ -110,19 +110,26 @@ void DynamicAtlasManager::Node::MergeChildren()
 }
 
 
-DynamicAtlasManager::DynamicAtlasManager(Uint32 Width, Uint32 Height) :
+DynamicAtlasManager::DynamicAtlasManager(Uint32 Width, Uint32 Height, DYNAMIC_ATLAS_MANAGER_POLICY Policy) :
     m_Width{Width},
     m_Height{Height},
-    m_TotalFreeArea{Uint64{Width} * Uint64{Height}}
+    m_TotalFreeArea{Uint64{Width} * Uint64{Height}},
+    m_Shelf{Policy == DYNAMIC_ATLAS_MANAGER_POLICY_SHELF ? ShelfAtlasManager{Width, Height} : ShelfAtlasManager{}},
+    m_Policy{Policy}
 {
     m_Root->R = Region{0, 0, Width, Height};
-    RegisterNode(*m_Root);
+    if (m_Policy != DYNAMIC_ATLAS_MANAGER_POLICY_SHELF)
+        RegisterNode(*m_Root);
 }
 
 
 DynamicAtlasManager::~DynamicAtlasManager()
 {
-    if (m_Root)
+    if (m_Root && m_Policy == DYNAMIC_ATLAS_MANAGER_POLICY_SHELF)
+    {
+        DEV_CHECK_ERR(m_Shelf.GetAllocationCount() == 0, "There must be no allocated regions");
+    }
+    else if (m_Root)
     {
 #if DILIGENT_DEBUG
         DbgVerifyConsistency();
@@ -184,6 +191,17 @@ void DynamicAtlasManager::UnregisterNode(const Node& N)
 
 DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 Height)
 {
+    if (m_Policy == DYNAMIC_ATLAS_MANAGER_POLICY_SHELF)
+    {
+        Region R{0, 0, Width, Height};
+        if (!m_Shelf.Allocate(Width, Height, R.x, R.y))
+            return Region{};
+
+        VERIFY_EXPR(m_TotalFreeArea >= Uint64{R.width} * Uint64{R.height});
+        m_TotalFreeArea -= Uint64{R.width} * Uint64{R.height};
+        return R;
+    }
+
     auto it_w = m_FreeRegionsByWidth.lower_bound(Region{0, 0, Width, 0});
     while (it_w != m_FreeRegionsByWidth.end() && it_w->first.height < Height)
         ++it_w;
@@ -333,6 +351,19 @@ void DynamicAtlasManager::Free(Region&& R)
     DbgVerifyRegion(R);
 #endif
 
+    if (m_Policy == DYNAMIC_ATLAS_MANAGER_POLICY_SHELF)
+    {
+        if (!m_Shelf.Free(R.x, R.y, R.width, R.height))
+        {
+            UNEXPECTED("Unable to find region [", R.x, ", ", R.x + R.width, ") x [", R.y, ", ", R.y + R.height, ") among allocated regions. Have you ever allocated it?");
+            return;
+        }
+
+        m_TotalFreeArea += Uint64{R.width} * Uint64{R.height};
+        R = InvalidRegion;
+        return;
+    }
+
     auto node_it = m_AllocatedRegions.find(R);
     if (node_it == m_AllocatedRegions.end())
     {
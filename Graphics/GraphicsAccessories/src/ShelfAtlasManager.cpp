@@ -0,0 +1,567 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ShelfAtlasManager.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "PlatformMisc.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+constexpr Uint32 ShelfAtlasManager::InvalidIndex;
+constexpr Uint32 ShelfAtlasManager::NumWidthBuckets;
+constexpr Uint32 ShelfAtlasManager::MaxBucketScanLength;
+
+ShelfAtlasManager::HeightClass::HeightClass(Uint32 _Height) :
+    Height{_Height}
+{
+    for (auto& Head : FreeLists)
+        Head = InvalidIndex;
+}
+
+ShelfAtlasManager::ShelfAtlasManager(Uint32 Width, Uint32 Height) :
+    m_Width{Width},
+    m_Height{Height}
+{
+    VERIFY_EXPR(Width > 0 && Height > 0);
+
+    // The first node always starts at y = 0 and is never released
+    const auto Idx = CreateShelfNode();
+    VERIFY_EXPR(Idx == 0);
+    m_Shelves[Idx].Height = Height;
+    InsertFreeBand(Idx);
+}
+
+Uint32 ShelfAtlasManager::GetShelfHeight(Uint32 Height)
+{
+    VERIFY_EXPR(Height > 0);
+    if (Height <= 16)
+        return Height;
+
+    const auto Step = 1u << (PlatformMisc::GetMSB(Height) - 3);
+    return AlignUp(Height, Step);
+}
+
+ShelfAtlasManager::HeightClass* ShelfAtlasManager::FindClass(Uint32 ShelfHeight)
+{
+    return const_cast<HeightClass*>(static_cast<const ShelfAtlasManager*>(this)->FindClass(ShelfHeight));
+}
+
+const ShelfAtlasManager::HeightClass* ShelfAtlasManager::FindClass(Uint32 ShelfHeight) const
+{
+    auto it = std::lower_bound(m_Classes.begin(), m_Classes.end(), ShelfHeight,
+                               [](const HeightClass& Class, Uint32 Height) { return Class.Height < Height; });
+    return it != m_Classes.end() && it->Height == ShelfHeight ? &*it : nullptr;
+}
+
+ShelfAtlasManager::HeightClass& ShelfAtlasManager::GetClass(Uint32 ShelfHeight)
+{
+    auto it = std::lower_bound(m_Classes.begin(), m_Classes.end(), ShelfHeight,
+                               [](const HeightClass& Class, Uint32 Height) { return Class.Height < Height; });
+    if (it == m_Classes.end() || it->Height != ShelfHeight)
+        it = m_Classes.emplace(it, ShelfHeight);
+    return *it;
+}
+
+Uint32 ShelfAtlasManager::FindFreeSpan(const HeightClass& Class, Uint32 Width) const
+{
+    const auto Bucket = PlatformMisc::GetMSB(Width);
+
+    // Spans in the same bucket may be narrower than the requested width.
+    // Check a few of them first to keep wider spans for wider regions.
+    auto Idx = Class.FreeLists[Bucket];
+    for (Uint32 i = 0; i < MaxBucketScanLength && Idx != InvalidIndex; ++i, Idx = m_Spans[Idx].NextFree)
+    {
+        if (m_Spans[Idx].Width >= Width)
+            return Idx;
+    }
+
+    // Spans in the higher buckets are always large enough
+    const auto HigherBuckets = Bucket + 1 < NumWidthBuckets ? Class.Bitmap & (~0u << (Bucket + 1)) : 0u;
+    if (HigherBuckets != 0)
+        return Class.FreeLists[PlatformMisc::GetLSB(HigherBuckets)];
+
+    for (; Idx != InvalidIndex; Idx = m_Spans[Idx].NextFree)
+    {
+        if (m_Spans[Idx].Width >= Width)
+            return Idx;
+    }
+
+    return InvalidIndex;
+}
+
+void ShelfAtlasManager::InsertFreeSpan(Uint32 Idx)
+{
+    auto& Span = m_Spans[Idx];
+    VERIFY_EXPR(!Span.IsFree && Span.Width > 0);
+
+    auto&      Class  = GetClass(m_Shelves[Span.Shelf].Height);
+    const auto Bucket = PlatformMisc::GetMSB(Span.Width);
+
+    Span.IsFree   = true;
+    Span.Height   = 0;
+    Span.PrevFree = InvalidIndex;
+    Span.NextFree = Class.FreeLists[Bucket];
+    if (Span.NextFree != InvalidIndex)
+        m_Spans[Span.NextFree].PrevFree = Idx;
+
+    Class.FreeLists[Bucket] = Idx;
+    Class.Bitmap |= 1u << Bucket;
+    ++m_NumFreeSpans;
+}
+
+void ShelfAtlasManager::RemoveFreeSpan(Uint32 Idx)
+{
+    auto& Span = m_Spans[Idx];
+    VERIFY_EXPR(Span.IsFree);
+
+    if (Span.PrevFree != InvalidIndex)
+    {
+        m_Spans[Span.PrevFree].NextFree = Span.NextFree;
+    }
+    else
+    {
+        auto* pClass = FindClass(m_Shelves[Span.Shelf].Height);
+        VERIFY_EXPR(pClass != nullptr);
+
+        const auto Bucket = PlatformMisc::GetMSB(Span.Width);
+        VERIFY_EXPR(pClass->FreeLists[Bucket] == Idx);
+        pClass->FreeLists[Bucket] = Span.NextFree;
+        if (Span.NextFree == InvalidIndex)
+            pClass->Bitmap &= ~(1u << Bucket);
+    }
+
+    if (Span.NextFree != InvalidIndex)
+        m_Spans[Span.NextFree].PrevFree = Span.PrevFree;
+
+    Span.IsFree   = false;
+    Span.PrevFree = InvalidIndex;
+    Span.NextFree = InvalidIndex;
+    VERIFY_EXPR(m_NumFreeSpans > 0);
+    --m_NumFreeSpans;
+}
+
+void ShelfAtlasManager::InsertFreeBand(Uint32 Idx)
+{
+    auto& Band = m_Shelves[Idx];
+    VERIFY_EXPR(Band.NumAllocations == 0);
+
+    Band.IsFree   = true;
+    Band.PrevFree = InvalidIndex;
+    Band.NextFree = m_FirstFreeBand;
+    if (Band.NextFree != InvalidIndex)
+        m_Shelves[Band.NextFree].PrevFree = Idx;
+    m_FirstFreeBand = Idx;
+    ++m_NumFreeBands;
+}
+
+void ShelfAtlasManager::RemoveFreeBand(Uint32 Idx)
+{
+    auto& Band = m_Shelves[Idx];
+    VERIFY_EXPR(Band.IsFree);
+
+    if (Band.PrevFree != InvalidIndex)
+    {
+        m_Shelves[Band.PrevFree].NextFree = Band.NextFree;
+    }
+    else
+    {
+        VERIFY_EXPR(m_FirstFreeBand == Idx);
+        m_FirstFreeBand = Band.NextFree;
+    }
+
+    if (Band.NextFree != InvalidIndex)
+        m_Shelves[Band.NextFree].PrevFree = Band.PrevFree;
+
+    Band.PrevFree = InvalidIndex;
+    Band.NextFree = InvalidIndex;
+    VERIFY_EXPR(m_NumFreeBands > 0);
+    --m_NumFreeBands;
+}
+
+Uint32 ShelfAtlasManager::CreateSpan()
+{
+    Uint32 Idx = m_FirstUnusedSpan;
+    if (Idx != InvalidIndex)
+    {
+        m_FirstUnusedSpan = m_Spans[Idx].NextFree;
+    }
+    else
+    {
+        VERIFY(m_Spans.size() < InvalidIndex, "Too many spans");
+        Idx = static_cast<Uint32>(m_Spans.size());
+        m_Spans.emplace_back();
+    }
+
+    m_Spans[Idx] = Span{};
+    return Idx;
+}
+
+void ShelfAtlasManager::ReleaseSpan(Uint32 Idx)
+{
+    auto& Span        = m_Spans[Idx];
+    Span              = {};
+    Span.NextFree     = m_FirstUnusedSpan;
+    m_FirstUnusedSpan = Idx;
+}
+
+Uint32 ShelfAtlasManager::CreateShelfNode()
+{
+    Uint32 Idx = m_FirstUnusedShelf;
+    if (Idx != InvalidIndex)
+    {
+        m_FirstUnusedShelf = m_Shelves[Idx].NextFree;
+    }
+    else
+    {
+        VERIFY(m_Shelves.size() < InvalidIndex, "Too many shelves");
+        Idx = static_cast<Uint32>(m_Shelves.size());
+        m_Shelves.emplace_back();
+    }
+
+    m_Shelves[Idx] = Shelf{};
+    return Idx;
+}
+
+void ShelfAtlasManager::ReleaseShelfNode(Uint32 Idx)
+{
+    auto& Node         = m_Shelves[Idx];
+    Node               = {};
+    Node.NextFree      = m_FirstUnusedShelf;
+    m_FirstUnusedShelf = Idx;
+}
+
+Uint32 ShelfAtlasManager::CreateShelf(Uint32 ShelfHeight)
+{
+    // Find the smallest free band that fits the shelf
+    Uint32 BandIdx = InvalidIndex;
+    for (auto Idx = m_FirstFreeBand; Idx != InvalidIndex; Idx = m_Shelves[Idx].NextFree)
+    {
+        const auto& Band = m_Shelves[Idx];
+        if (Band.Height >= ShelfHeight && (BandIdx == InvalidIndex || Band.Height < m_Shelves[BandIdx].Height))
+            BandIdx = Idx;
+    }
+    if (BandIdx == InvalidIndex)
+        return InvalidIndex;
+
+    RemoveFreeBand(BandIdx);
+    if (m_Shelves[BandIdx].Height > ShelfHeight)
+    {
+        // Keep the remaining space as a free band after the shelf
+        const auto RestIdx = CreateShelfNode();
+
+        auto& NewShelf = m_Shelves[BandIdx];
+        auto& Rest     = m_Shelves[RestIdx];
+        Rest.y         = NewShelf.y + ShelfHeight;
+        Rest.Height    = NewShelf.Height - ShelfHeight;
+        Rest.Prev      = BandIdx;
+        Rest.Next      = NewShelf.Next;
+        if (NewShelf.Next != InvalidIndex)
+            m_Shelves[NewShelf.Next].Prev = RestIdx;
+        NewShelf.Next   = RestIdx;
+        NewShelf.Height = ShelfHeight;
+        InsertFreeBand(RestIdx);
+    }
+    m_Shelves[BandIdx].IsFree = false;
+
+    const auto SpanIdx = CreateSpan();
+    auto&      Span    = m_Spans[SpanIdx];
+    Span.Width         = m_Width;
+    Span.Shelf         = BandIdx;
+    InsertFreeSpan(SpanIdx);
+
+    return SpanIdx;
+}
+
+void ShelfAtlasManager::ReleaseShelf(Uint32 ShelfIdx)
+{
+    VERIFY_EXPR(!m_Shelves[ShelfIdx].IsFree && m_Shelves[ShelfIdx].NumAllocations == 0);
+
+    auto Idx = ShelfIdx;
+
+    // Merge with the previous free band
+    const auto Prev = m_Shelves[Idx].Prev;
+    if (Prev != InvalidIndex && m_Shelves[Prev].IsFree)
+    {
+        RemoveFreeBand(Prev);
+
+        auto&       PrevBand = m_Shelves[Prev];
+        const auto& Curr     = m_Shelves[Idx];
+        PrevBand.Height += Curr.Height;
+        PrevBand.Next = Curr.Next;
+        if (Curr.Next != InvalidIndex)
+            m_Shelves[Curr.Next].Prev = Prev;
+
+        ReleaseShelfNode(Idx);
+        Idx = Prev;
+    }
+
+    // Merge with the next free band
+    const auto Next = m_Shelves[Idx].Next;
+    if (Next != InvalidIndex && m_Shelves[Next].IsFree)
+    {
+        RemoveFreeBand(Next);
+
+        auto&       Curr     = m_Shelves[Idx];
+        const auto& NextBand = m_Shelves[Next];
+        Curr.Height += NextBand.Height;
+        Curr.Next = NextBand.Next;
+        if (NextBand.Next != InvalidIndex)
+            m_Shelves[NextBand.Next].Prev = Idx;
+
+        ReleaseShelfNode(Next);
+    }
+
+    InsertFreeBand(Idx);
+}
+
+Uint64 ShelfAtlasManager::GetUsedSpanKey(Uint32 Idx) const
+{
+    const auto& Span = m_Spans[Idx];
+    return GetSpanKey(Span.x, m_Shelves[Span.Shelf].y);
+}
+
+void ShelfAtlasManager::InsertUsedSpan(Uint32 Idx)
+{
+    m_UsedSpans.Insert(GetUsedSpanKey(Idx), Idx,
+                       [this](Uint32 UsedIdx) { return GetUsedSpanKey(UsedIdx); });
+}
+
+Uint32 ShelfAtlasManager::RemoveUsedSpan(Uint64 Key)
+{
+    const auto Pos = m_UsedSpans.Find(Key,
+                                      [&](Uint32 UsedIdx) { return GetUsedSpanKey(UsedIdx) == Key; });
+    if (Pos == m_UsedSpans.InvalidPos)
+        return InvalidIndex;
+
+    const auto Idx = m_UsedSpans[Pos];
+    m_UsedSpans.Remove(Pos, [this](Uint32 UsedIdx) { return GetUsedSpanKey(UsedIdx); });
+    return Idx;
+}
+
+bool ShelfAtlasManager::Allocate(Uint32 Width, Uint32 Height, Uint32& X, Uint32& Y)
+{
+    VERIFY_EXPR(Width > 0 && Height > 0);
+    if (Width > m_Width || Height > m_Height)
+        return false;
+
+    const auto ShelfHeight = (std::min)(GetShelfHeight(Height), m_Height);
+
+    // Try existing shelves of the same height first
+    Uint32 SpanIdx = InvalidIndex;
+    if (const auto* pClass = FindClass(ShelfHeight))
+        SpanIdx = FindFreeSpan(*pClass, Width);
+
+    if (SpanIdx == InvalidIndex)
+        SpanIdx = CreateShelf(ShelfHeight);
+
+    if (SpanIdx == InvalidIndex)
+    {
+        // Use taller shelves as the last resort
+        auto it = std::upper_bound(m_Classes.begin(), m_Classes.end(), ShelfHeight,
+                                   [](Uint32 Height, const HeightClass& Class) { return Height < Class.Height; });
+        for (; it != m_Classes.end() && SpanIdx == InvalidIndex; ++it)
+            SpanIdx = FindFreeSpan(*it, Width);
+    }
+
+    if (SpanIdx == InvalidIndex)
+        return false;
+
+    RemoveFreeSpan(SpanIdx);
+    if (m_Spans[SpanIdx].Width > Width)
+    {
+        // Return the remaining part of the span to the free list
+        const auto RestIdx = CreateSpan();
+
+        auto& Span    = m_Spans[SpanIdx];
+        auto& Rest    = m_Spans[RestIdx];
+        Rest.x        = Span.x + Width;
+        Rest.Width    = Span.Width - Width;
+        Rest.Shelf    = Span.Shelf;
+        Rest.PrevPhys = SpanIdx;
+        Rest.NextPhys = Span.NextPhys;
+        if (Span.NextPhys != InvalidIndex)
+            m_Spans[Span.NextPhys].PrevPhys = RestIdx;
+        Span.NextPhys = RestIdx;
+        Span.Width    = Width;
+        InsertFreeSpan(RestIdx);
+    }
+
+    auto& Span  = m_Spans[SpanIdx];
+    Span.Height = Height;
+
+    auto& Shelf = m_Shelves[Span.Shelf];
+    ++Shelf.NumAllocations;
+
+    ++m_NumAllocations;
+    InsertUsedSpan(SpanIdx);
+
+    X = Span.x;
+    Y = Shelf.y;
+
+#ifdef DILIGENT_DEBUG
+    DbgVerify();
+#endif
+
+    return true;
+}
+
+bool ShelfAtlasManager::Free(Uint32 X, Uint32 Y, Uint32 Width, Uint32 Height)
+{
+    auto Idx = RemoveUsedSpan(GetSpanKey(X, Y));
+    if (Idx == InvalidIndex)
+        return false;
+
+    VERIFY(m_Spans[Idx].Width == Width && m_Spans[Idx].Height == Height,
+           "Region size ", Width, " x ", Height, " does not match the size of the allocated region (",
+           m_Spans[Idx].Width, " x ", m_Spans[Idx].Height, ")");
+    (void)Width;
+    (void)Height;
+
+    const auto ShelfIdx = m_Spans[Idx].Shelf;
+    VERIFY_EXPR(m_Shelves[ShelfIdx].NumAllocations > 0 && m_NumAllocations > 0);
+    --m_Shelves[ShelfIdx].NumAllocations;
+    --m_NumAllocations;
+    m_Spans[Idx].Height = 0;
+
+    // Merge with the previous free span
+    const auto Prev = m_Spans[Idx].PrevPhys;
+    if (Prev != InvalidIndex && m_Spans[Prev].IsFree)
+    {
+        RemoveFreeSpan(Prev);
+
+        auto&       PrevSpan = m_Spans[Prev];
+        const auto& Curr     = m_Spans[Idx];
+        PrevSpan.Width += Curr.Width;
+        PrevSpan.NextPhys = Curr.NextPhys;
+        if (Curr.NextPhys != InvalidIndex)
+            m_Spans[Curr.NextPhys].PrevPhys = Prev;
+
+        ReleaseSpan(Idx);
+        Idx = Prev;
+    }
+
+    // Merge with the next free span
+    const auto Next = m_Spans[Idx].NextPhys;
+    if (Next != InvalidIndex && m_Spans[Next].IsFree)
+    {
+        RemoveFreeSpan(Next);
+
+        auto&       Curr     = m_Spans[Idx];
+        const auto& NextSpan = m_Spans[Next];
+        Curr.Width += NextSpan.Width;
+        Curr.NextPhys = NextSpan.NextPhys;
+        if (NextSpan.NextPhys != InvalidIndex)
+            m_Spans[NextSpan.NextPhys].PrevPhys = Idx;
+
+        ReleaseSpan(Next);
+    }
+
+    if (m_Shelves[ShelfIdx].NumAllocations == 0)
+    {
+        // The shelf is empty - return it to the free space
+        VERIFY_EXPR(m_Spans[Idx].x == 0 && m_Spans[Idx].Width == m_Width);
+        ReleaseSpan(Idx);
+        ReleaseShelf(ShelfIdx);
+    }
+    else
+    {
+        InsertFreeSpan(Idx);
+    }
+
+#ifdef DILIGENT_DEBUG
+    DbgVerify();
+#endif
+
+    return true;
+}
+
+#ifdef DILIGENT_DEBUG
+void ShelfAtlasManager::DbgVerify() const
+{
+    // Node 0 is the first node in the vertical list
+    Uint32 y            = 0;
+    Uint32 NumFreeBands = 0;
+    for (auto Idx = 0u; Idx != InvalidIndex; Idx = m_Shelves[Idx].Next)
+    {
+        const auto& Node = m_Shelves[Idx];
+        VERIFY(Node.y == y, "Shelf y (", Node.y, ") does not match the end of the previous shelf (", y, ")");
+        VERIFY(Node.Height > 0, "Shelf height must not be zero");
+        VERIFY(Node.Next == InvalidIndex || m_Shelves[Node.Next].Prev == Idx, "Broken vertical links");
+        VERIFY(!Node.IsFree || Node.Next == InvalidIndex || !m_Shelves[Node.Next].IsFree, "Adjacent free bands must be merged");
+        if (Node.IsFree)
+            ++NumFreeBands;
+        y += Node.Height;
+    }
+    VERIFY(y == m_Height, "Shelves do not cover the entire atlas height");
+    VERIFY_EXPR(NumFreeBands == m_NumFreeBands);
+
+    std::vector<Uint32> ShelfWidths(m_Shelves.size());
+    std::vector<Uint32> ShelfAllocations(m_Shelves.size());
+
+    Uint32 NumFreeSpans = 0;
+    Uint32 NumUsedSpans = 0;
+    for (size_t Idx = 0; Idx < m_Spans.size(); ++Idx)
+    {
+        const auto& Span = m_Spans[Idx];
+        if (Span.Width == 0)
+            continue; // Unused node
+
+        VERIFY_EXPR(Span.Shelf < m_Shelves.size() && !m_Shelves[Span.Shelf].IsFree);
+        VERIFY(Span.IsFree || (Span.Height > 0 && Span.Height <= m_Shelves[Span.Shelf].Height), "Invalid region height");
+        VERIFY(!Span.IsFree || Span.NextPhys == InvalidIndex || !m_Spans[Span.NextPhys].IsFree, "Adjacent free spans must be merged");
+        ShelfWidths[Span.Shelf] += Span.Width;
+        if (Span.IsFree)
+        {
+            ++NumFreeSpans;
+        }
+        else
+        {
+            ++NumUsedSpans;
+            ++ShelfAllocations[Span.Shelf];
+        }
+    }
+    VERIFY_EXPR(NumFreeSpans == m_NumFreeSpans);
+    VERIFY_EXPR(NumUsedSpans == m_NumAllocations);
+
+    for (auto Idx = 0u; Idx != InvalidIndex; Idx = m_Shelves[Idx].Next)
+    {
+        const auto& Node = m_Shelves[Idx];
+        if (!Node.IsFree)
+        {
+            VERIFY(ShelfWidths[Idx] == m_Width, "Spans do not cover the entire shelf width");
+            VERIFY_EXPR(ShelfAllocations[Idx] == Node.NumAllocations);
+        }
+    }
+}
+#endif
+
+} // namespace Diligent
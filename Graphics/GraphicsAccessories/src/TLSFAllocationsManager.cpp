@@ -0,0 +1,480 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TLSFAllocationsManager.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "PlatformMisc.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+constexpr Uint32 TLSFAllocationsManager::SLCountLog2;
+constexpr Uint32 TLSFAllocationsManager::SLCount;
+constexpr Uint32 TLSFAllocationsManager::FLCount;
+constexpr Uint32 TLSFAllocationsManager::InvalidIndex;
+
+TLSFAllocationsManager::TLSFAllocationsManager(IMemoryAllocator& Allocator) :
+    // clang-format off
+    m_Blocks    {STD_ALLOCATOR_RAW_MEM(Block,  Allocator, "Allocator for vector<TLSFAllocationsManager::Block>")},
+    m_FreeLists {STD_ALLOCATOR_RAW_MEM(Uint32, Allocator, "Allocator for vector<Uint32>")},
+    m_SLBitmaps {STD_ALLOCATOR_RAW_MEM(Uint32, Allocator, "Allocator for vector<Uint32>")},
+    m_UsedBlocks{STD_ALLOCATOR_RAW_MEM(Uint32, Allocator, "Allocator for vector<Uint32>")}
+// clang-format on
+{
+}
+
+void TLSFAllocationsManager::MapSize(OffsetType Size, Uint32& FL, Uint32& SL)
+{
+    VERIFY_EXPR(Size > 0);
+    if (Size < SLCount)
+    {
+        FL = 0;
+        SL = static_cast<Uint32>(Size);
+    }
+    else
+    {
+        const auto MSB = PlatformMisc::GetMSB(static_cast<Uint64>(Size));
+        //  FL = 1: [32, 64),  SL step = 1
+        //  FL = 2: [64, 128), SL step = 2
+        //  ...
+        FL = MSB - SLCountLog2 + 1;
+        SL = static_cast<Uint32>(Size >> (MSB - SLCountLog2)) ^ SLCount;
+    }
+    VERIFY_EXPR(FL < FLCount && SL < SLCount);
+}
+
+Uint32 TLSFAllocationsManager::FindFreeList(OffsetType Size) const
+{
+    if (Size >= SLCount)
+    {
+        // Round the size up to the next list boundary, so that every block
+        // in the list found below is large enough.
+        const auto RoundedSize = Size + (OffsetType{1} << (PlatformMisc::GetMSB(static_cast<Uint64>(Size)) - SLCountLog2)) - 1;
+        if (RoundedSize < Size)
+            return InvalidIndex; // Overflow
+        Size = RoundedSize;
+    }
+
+    Uint32 FL = 0, SL = 0;
+    MapSize(Size, FL, SL);
+
+    auto SLMap = m_SLBitmaps[FL] & (~0u << SL);
+    if (SLMap == 0)
+    {
+        const auto FLMap = FL + 1 < 64 ? m_FLBitmap & (~Uint64{0} << (FL + 1)) : Uint64{0};
+        if (FLMap == 0)
+            return InvalidIndex;
+
+        FL    = PlatformMisc::GetLSB(FLMap);
+        SLMap = m_SLBitmaps[FL];
+        VERIFY_EXPR(SLMap != 0);
+    }
+    SL = PlatformMisc::GetLSB(SLMap);
+
+    const auto Idx = m_FreeLists[FL * SLCount + SL];
+    VERIFY_EXPR(Idx != InvalidIndex);
+    return Idx;
+}
+
+Uint32 TLSFAllocationsManager::FindFreeBlock(OffsetType Size, OffsetType Alignment) const
+{
+    auto Fits = [&](Uint32 Idx) {
+        const auto& Blk = m_Blocks[Idx];
+        return AlignUp(Blk.Offset, Alignment) - Blk.Offset + Size <= Blk.Size;
+    };
+
+    auto Idx = FindFreeList(Size);
+    if (Idx != InvalidIndex && Fits(Idx))
+        return Idx;
+
+    if (Alignment > 1)
+    {
+        // Any block that is at least Size + Alignment - 1 bytes large can hold the aligned allocation
+        Idx = FindFreeList(Size + Alignment - 1);
+        if (Idx != InvalidIndex)
+        {
+            VERIFY_EXPR(Fits(Idx));
+            return Idx;
+        }
+    }
+
+    // Rounding the size up skips the blocks in the size's own list that may still be large enough
+    Uint32 FL = 0, SL = 0;
+    MapSize(Size, FL, SL);
+    for (Idx = m_FreeLists[FL * SLCount + SL]; Idx != InvalidIndex; Idx = m_Blocks[Idx].NextFree)
+    {
+        if (Fits(Idx))
+            return Idx;
+    }
+
+    return InvalidIndex;
+}
+
+void TLSFAllocationsManager::InsertFreeBlock(Uint32 Idx)
+{
+    auto& Blk = m_Blocks[Idx];
+    VERIFY_EXPR(!Blk.IsFree);
+
+    Uint32 FL = 0, SL = 0;
+    MapSize(Blk.Size, FL, SL);
+
+    auto& Head   = m_FreeLists[FL * SLCount + SL];
+    Blk.IsFree   = true;
+    Blk.PrevFree = InvalidIndex;
+    Blk.NextFree = Head;
+    if (Head != InvalidIndex)
+        m_Blocks[Head].PrevFree = Idx;
+    Head = Idx;
+
+    m_SLBitmaps[FL] |= 1u << SL;
+    m_FLBitmap |= Uint64{1} << FL;
+    ++m_NumFreeBlocks;
+}
+
+void TLSFAllocationsManager::RemoveFreeBlock(Uint32 Idx)
+{
+    auto& Blk = m_Blocks[Idx];
+    VERIFY_EXPR(Blk.IsFree);
+
+    Uint32 FL = 0, SL = 0;
+    MapSize(Blk.Size, FL, SL);
+
+    if (Blk.PrevFree != InvalidIndex)
+        m_Blocks[Blk.PrevFree].NextFree = Blk.NextFree;
+    if (Blk.NextFree != InvalidIndex)
+        m_Blocks[Blk.NextFree].PrevFree = Blk.PrevFree;
+
+    auto& Head = m_FreeLists[FL * SLCount + SL];
+    if (Head == Idx)
+    {
+        Head = Blk.NextFree;
+        if (Head == InvalidIndex)
+        {
+            m_SLBitmaps[FL] &= ~(1u << SL);
+            if (m_SLBitmaps[FL] == 0)
+                m_FLBitmap &= ~(Uint64{1} << FL);
+        }
+    }
+
+    Blk.IsFree   = false;
+    Blk.PrevFree = InvalidIndex;
+    Blk.NextFree = InvalidIndex;
+    VERIFY_EXPR(m_NumFreeBlocks > 0);
+    --m_NumFreeBlocks;
+}
+
+Uint32 TLSFAllocationsManager::CreateBlock(OffsetType Offset, OffsetType Size)
+{
+    Uint32 Idx = m_FirstUnusedBlock;
+    if (Idx != InvalidIndex)
+    {
+        m_FirstUnusedBlock = m_Blocks[Idx].NextFree;
+    }
+    else
+    {
+        VERIFY(m_Blocks.size() < InvalidIndex, "Too many blocks");
+        Idx = static_cast<Uint32>(m_Blocks.size());
+        m_Blocks.emplace_back();
+    }
+
+    auto& Blk  = m_Blocks[Idx];
+    Blk        = Block{};
+    Blk.Offset = Offset;
+    Blk.Size   = Size;
+    return Idx;
+}
+
+void TLSFAllocationsManager::ReleaseBlock(Uint32 Idx)
+{
+    auto& Blk          = m_Blocks[Idx];
+    Blk                = Block{};
+    Blk.NextFree       = m_FirstUnusedBlock;
+    m_FirstUnusedBlock = Idx;
+}
+
+void TLSFAllocationsManager::InsertUsedBlock(Uint32 Idx)
+{
+    m_UsedBlocks.Insert(Uint64{m_Blocks[Idx].Offset}, Idx,
+                        [this](Uint32 UsedIdx) { return Uint64{m_Blocks[UsedIdx].Offset}; });
+}
+
+Uint32 TLSFAllocationsManager::RemoveUsedBlock(OffsetType Offset)
+{
+    const auto Pos = m_UsedBlocks.Find(Uint64{Offset},
+                                       [&](Uint32 UsedIdx) { return m_Blocks[UsedIdx].Offset == Offset; });
+    if (Pos == m_UsedBlocks.InvalidPos)
+        return InvalidIndex;
+
+    const auto Idx = m_UsedBlocks[Pos];
+    m_UsedBlocks.Remove(Pos, [this](Uint32 UsedIdx) { return Uint64{m_Blocks[UsedIdx].Offset}; });
+    return Idx;
+}
+
+bool TLSFAllocationsManager::Allocate(OffsetType Size, OffsetType Alignment, OffsetType& Offset, OffsetType& AdjustedSize)
+{
+    VERIFY_EXPR(Size > 0);
+    VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+    VERIFY((Size & (Alignment - 1)) == 0, "Size (", Size, ") must be a multiple of the alignment (", Alignment, ")");
+
+    const auto Idx = FindFreeBlock(Size, Alignment);
+    if (Idx == InvalidIndex)
+        return false;
+
+    RemoveFreeBlock(Idx);
+
+    Offset       = m_Blocks[Idx].Offset;
+    AdjustedSize = AlignUp(Offset, Alignment) - Offset + Size;
+    VERIFY_EXPR(AdjustedSize <= m_Blocks[Idx].Size);
+
+    if (m_Blocks[Idx].Size > AdjustedSize)
+    {
+        //     Blk.Offset
+        //        |                           |
+        //        |<---------Blk.Size-------->|
+        //        |<--AdjustedSize-->|<-Rem.->|
+        //
+        const auto RemIdx = CreateBlock(Offset + AdjustedSize, m_Blocks[Idx].Size - AdjustedSize);
+        // NB: CreateBlock may reallocate the storage
+
+        auto& Blk = m_Blocks[Idx];
+        auto& Rem = m_Blocks[RemIdx];
+
+        Rem.PrevPhys = Idx;
+        Rem.NextPhys = Blk.NextPhys;
+        if (Blk.NextPhys != InvalidIndex)
+            m_Blocks[Blk.NextPhys].PrevPhys = RemIdx;
+        Blk.NextPhys = RemIdx;
+        Blk.Size     = AdjustedSize;
+        if (m_LastBlock == Idx)
+            m_LastBlock = RemIdx;
+
+        InsertFreeBlock(RemIdx);
+    }
+
+    InsertUsedBlock(Idx);
+
+    return true;
+}
+
+void TLSFAllocationsManager::Free(OffsetType Offset, OffsetType Size)
+{
+    auto Idx = RemoveUsedBlock(Offset);
+    if (Idx == InvalidIndex)
+    {
+        UNEXPECTED("Block at offset ", Offset, " was not allocated by this manager");
+        return;
+    }
+    VERIFY(m_Blocks[Idx].Size == Size, "Size of the block being released (", Size, ") does not match the allocated size (", m_Blocks[Idx].Size, ")");
+    (void)Size;
+
+    // Merge with the previous block
+    const auto PrevIdx = m_Blocks[Idx].PrevPhys;
+    if (PrevIdx != InvalidIndex && m_Blocks[PrevIdx].IsFree)
+    {
+        RemoveFreeBlock(PrevIdx);
+
+        auto& Prev = m_Blocks[PrevIdx];
+        auto& Blk  = m_Blocks[Idx];
+        VERIFY_EXPR(Prev.Offset + Prev.Size == Blk.Offset);
+
+        Prev.Size += Blk.Size;
+        Prev.NextPhys = Blk.NextPhys;
+        if (Blk.NextPhys != InvalidIndex)
+            m_Blocks[Blk.NextPhys].PrevPhys = PrevIdx;
+        if (m_LastBlock == Idx)
+            m_LastBlock = PrevIdx;
+
+        ReleaseBlock(Idx);
+        Idx = PrevIdx;
+    }
+
+    // Merge with the next block
+    const auto NextIdx = m_Blocks[Idx].NextPhys;
+    if (NextIdx != InvalidIndex && m_Blocks[NextIdx].IsFree)
+    {
+        RemoveFreeBlock(NextIdx);
+
+        auto& Blk  = m_Blocks[Idx];
+        auto& Next = m_Blocks[NextIdx];
+        VERIFY_EXPR(Blk.Offset + Blk.Size == Next.Offset);
+
+        Blk.Size += Next.Size;
+        Blk.NextPhys = Next.NextPhys;
+        if (Next.NextPhys != InvalidIndex)
+            m_Blocks[Next.NextPhys].PrevPhys = Idx;
+        if (m_LastBlock == NextIdx)
+            m_LastBlock = Idx;
+
+        ReleaseBlock(NextIdx);
+    }
+
+    InsertFreeBlock(Idx);
+}
+
+void TLSFAllocationsManager::Extend(OffsetType ExtraSize)
+{
+    if (ExtraSize == 0)
+        return;
+
+    if (m_FreeLists.empty())
+    {
+        m_FreeLists.assign(size_t{FLCount} * SLCount, InvalidIndex);
+        m_SLBitmaps.assign(FLCount, 0);
+    }
+
+    if (m_LastBlock != InvalidIndex && m_Blocks[m_LastBlock].IsFree)
+    {
+        // Extend the last block
+        RemoveFreeBlock(m_LastBlock);
+        m_Blocks[m_LastBlock].Size += ExtraSize;
+    }
+    else
+    {
+        const auto NewIdx = CreateBlock(m_MaxSize, ExtraSize);
+
+        m_Blocks[NewIdx].PrevPhys = m_LastBlock;
+        if (m_LastBlock != InvalidIndex)
+            m_Blocks[m_LastBlock].NextPhys = NewIdx;
+        m_LastBlock = NewIdx;
+    }
+    InsertFreeBlock(m_LastBlock);
+
+    m_MaxSize += ExtraSize;
+}
+
+void TLSFAllocationsManager::Shrink(OffsetType Size)
+{
+    if (Size == 0)
+        return;
+
+    if (Size > GetTrailingFreeSize())
+    {
+        UNEXPECTED("Shrink size (", Size, ") exceeds the size of the trailing free block (", GetTrailingFreeSize(), ")");
+        return;
+    }
+
+    RemoveFreeBlock(m_LastBlock);
+    auto& LastBlk = m_Blocks[m_LastBlock];
+    LastBlk.Size -= Size;
+    if (LastBlk.Size == 0)
+    {
+        const auto PrevIdx = LastBlk.PrevPhys;
+        if (PrevIdx != InvalidIndex)
+            m_Blocks[PrevIdx].NextPhys = InvalidIndex;
+        ReleaseBlock(m_LastBlock);
+        m_LastBlock = PrevIdx;
+    }
+    else
+    {
+        InsertFreeBlock(m_LastBlock);
+    }
+
+    m_MaxSize -= Size;
+}
+
+TLSFAllocationsManager::OffsetType TLSFAllocationsManager::GetTrailingFreeSize() const
+{
+    return (m_LastBlock != InvalidIndex && m_Blocks[m_LastBlock].IsFree) ? m_Blocks[m_LastBlock].Size : 0;
+}
+
+TLSFAllocationsManager::OffsetType TLSFAllocationsManager::GetMaxFreeBlockSize() const
+{
+    if (m_FLBitmap == 0)
+        return 0;
+
+    const auto FL = PlatformMisc::GetMSB(m_FLBitmap);
+    const auto SL = PlatformMisc::GetMSB(m_SLBitmaps[FL]);
+
+    // Blocks in the list are not sorted
+    OffsetType MaxSize = 0;
+    for (auto Idx = m_FreeLists[FL * SLCount + SL]; Idx != InvalidIndex; Idx = m_Blocks[Idx].NextFree)
+        MaxSize = (std::max)(MaxSize, m_Blocks[Idx].Size);
+
+    return MaxSize;
+}
+
+#ifdef DILIGENT_DEBUG
+void TLSFAllocationsManager::DbgVerify(OffsetType MaxSize, OffsetType FreeSize) const
+{
+    VERIFY_EXPR(m_MaxSize == MaxSize);
+
+    OffsetType TotalFreeSize = 0;
+    size_t     NumFreeBlocks = 0;
+    size_t     NumUsedBlocks = 0;
+
+    // Find the first physical block
+    auto Idx = m_LastBlock;
+    while (Idx != InvalidIndex && m_Blocks[Idx].PrevPhys != InvalidIndex)
+        Idx = m_Blocks[Idx].PrevPhys;
+
+    OffsetType ExpectedOffset = 0;
+    for (auto PrevIdx = InvalidIndex; Idx != InvalidIndex; PrevIdx = Idx, Idx = m_Blocks[Idx].NextPhys)
+    {
+        const auto& Blk = m_Blocks[Idx];
+        VERIFY(Blk.Offset == ExpectedOffset, "Blocks are not contiguous");
+        VERIFY_EXPR(Blk.Size > 0 && Blk.PrevPhys == PrevIdx);
+        if (Blk.IsFree)
+        {
+            VERIFY(PrevIdx == InvalidIndex || !m_Blocks[PrevIdx].IsFree, "Unmerged adjacent free blocks detected");
+            TotalFreeSize += Blk.Size;
+            ++NumFreeBlocks;
+        }
+        else
+        {
+            ++NumUsedBlocks;
+        }
+        ExpectedOffset += Blk.Size;
+    }
+    VERIFY_EXPR(ExpectedOffset == m_MaxSize);
+
+    VERIFY_EXPR(TotalFreeSize == FreeSize);
+    VERIFY_EXPR(NumFreeBlocks == m_NumFreeBlocks);
+    VERIFY_EXPR(NumUsedBlocks == m_UsedBlocks.GetSize());
+
+    for (Uint32 FL = 0; FL < FLCount && !m_FreeLists.empty(); ++FL)
+    {
+        VERIFY_EXPR(((m_FLBitmap >> FL) & 1) == (m_SLBitmaps[FL] != 0 ? 1 : 0));
+        for (Uint32 SL = 0; SL < SLCount; ++SL)
+        {
+            const auto Head = m_FreeLists[FL * SLCount + SL];
+            VERIFY_EXPR(((m_SLBitmaps[FL] >> SL) & 1) == (Head != InvalidIndex ? 1u : 0u));
+            for (auto i = Head; i != InvalidIndex; i = m_Blocks[i].NextFree)
+            {
+                Uint32 BlkFL = 0, BlkSL = 0;
+                MapSize(m_Blocks[i].Size, BlkFL, BlkSL);
+                VERIFY(BlkFL == FL && BlkSL == SL, "Block is in the wrong free list");
+                VERIFY_EXPR(m_Blocks[i].IsFree);
+            }
+        }
+    }
+}
+#endif
+
+} // namespace Diligent
@@ -190,7 +190,11 @@ public:
 
     virtual void DILIGENT_CALL_TYPE SetState(RESOURCE_STATE State) override final
     {
-        this->m_State = State;
+        if (this->m_State != State)
+        {
+            this->m_State = State;
+            OnStateChanged();
+        }
     }
 
     virtual RESOURCE_STATE DILIGENT_CALL_TYPE GetState() const override final
@@ -229,6 +233,14 @@ public:
     }
 
 protected:
+    /// Notifies the device that the resource state has changed, see RenderDeviceBase::GetResourceStateEpoch().
+    void OnStateChanged()
+    {
+        // Device can be null if the object is used for serialization
+        if (this->m_pDevice != nullptr)
+            this->m_pDevice->OnResourceStateChanged();
+    }
+
     /// Pure virtual function that creates buffer view for the specific engine implementation.
     virtual void CreateViewInternal(const struct BufferViewDesc& ViewDesc, IBufferView** ppView, bool bIsDefaultView) = 0;
 
@@ -68,7 +68,8 @@ public:
                     DeviceContextImplType* pDeferredCtx,
                     bool                   bIsDeviceInternal = false) :
         TDeviceObjectBase{pRefCounters, pDevice, CommandListDesc{}, bIsDeviceInternal},
-        m_QueueId{pDeferredCtx->GetDesc().QueueId}
+        m_QueueId{pDeferredCtx->GetDesc().QueueId},
+        m_IsReusable{pDeferredCtx->IsRecordingReusableCommands()}
     {
         VERIFY_EXPR(pDeferredCtx->GetDesc().IsDeferred);
     }
@@ -82,10 +83,18 @@ public:
         return m_QueueId;
     }
 
+    /// Returns true if the command list was recorded after IDeviceContext::BeginReusable()
+    /// and may be executed multiple times.
+    bool IsReusable() const
+    {
+        return m_IsReusable;
+    }
+
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_CommandList, TDeviceObjectBase)
 
 private:
     const Uint8 m_QueueId;
+    const bool  m_IsReusable;
 };
 
 } // namespace Diligent
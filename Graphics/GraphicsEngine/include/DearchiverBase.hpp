@@ -32,7 +32,11 @@
 #include <memory>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
+#include <future>
+#include <atomic>
+#include <condition_variable>
 
 #include "Dearchiver.h"
 #include "RenderDevice.h"
@@ -43,6 +47,7 @@
 #include "RefCntAutoPtr.hpp"
 #include "DeviceObjectArchive.hpp"
 #include "DynamicLinearAllocator.hpp"
+#include "HashedName.hpp"
 
 namespace Diligent
 {
@@ -63,7 +68,7 @@ public:
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_Dearchiver, TObjectBase)
 
     /// Implementation of IDearchiver::LoadArchive().
-    virtual bool DILIGENT_CALL_TYPE LoadArchive(const IDataBlob* pArchiveData, bool MakeCopy) override final;
+    virtual bool DILIGENT_CALL_TYPE LoadArchive(const IDataBlob* pArchiveData, bool MakeCopy, bool Override) override final;
 
     /// Implementation of IDearchiver::UnpackShader().
     virtual void DILIGENT_CALL_TYPE UnpackShader(const ShaderUnpackInfo& UnpackInfo,
@@ -84,6 +89,15 @@ public:
     /// Implementation of IDearchiver::Store().
     virtual bool DILIGENT_CALL_TYPE Store(IDataBlob** ppArchive) const override final;
 
+    /// Implementation of IDearchiver::StoreUsageManifest().
+    virtual bool DILIGENT_CALL_TYPE StoreUsageManifest(IDataBlob** ppManifest) const override final;
+
+    /// Implementation of IDearchiver::Prefetch().
+    virtual bool DILIGENT_CALL_TYPE Prefetch(const DearchiverPrefetchInfo& PrefetchInfo) override final;
+
+    /// Implementation of IDearchiver::GetPrefetchProgress().
+    virtual DearchiverPrefetchProgress DILIGENT_CALL_TYPE GetPrefetchProgress() const override final;
+
     /// Implementation of IDearchiver::Reset().
     virtual void DILIGENT_CALL_TYPE Reset() override final;
 
@@ -104,7 +118,27 @@ protected:
     using DeviceType           = DeviceObjectArchive::DeviceType;
     using SerializedPSOAuxData = DeviceObjectArchive::SerializedPSOAuxData;
     using TPRSNames            = DeviceObjectArchive::TPRSNames;
-    using ResourceKey          = DeviceObjectArchive::NamedResourceKey;
+
+    // Resource type and interned name. Interned names are shared by all caches and
+    // loaded archives, and comparing them does not require string comparisons.
+    struct ResourceKey
+    {
+        ResourceType Type = ResourceType::Undefined;
+        HashedName   Name;
+
+        bool operator==(const ResourceKey& RHS) const noexcept
+        {
+            return Type == RHS.Type && Name == RHS.Name;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const ResourceKey& Key) const noexcept
+            {
+                return ComputeHash(static_cast<size_t>(Key.Type), Key.Name.GetHash());
+            }
+        };
+    };
 
     template <typename ResType>
     class NamedResourceCache
@@ -119,15 +153,24 @@ protected:
         NamedResourceCache& operator=(NamedResourceCache&&)      = default;
         // clang-format on
 
-        bool Get(ResourceType Type, const char* Name, ResType** ppResource);
-        void Set(ResourceType Type, const char* Name, ResType* pResource);
+        void Remove(ResourceType Type, const char* Name);
+
+        // Returns the cached resource or creates it using the Create function.
+        // Concurrent requests for the same resource wait for the thread that creates
+        // it rather than creating their own copies.
+        template <typename CreateFuncType>
+        RefCntAutoPtr<ResType> GetOrCreate(ResourceType Type, const char* Name, CreateFuncType&& Create);
 
         void Clear() { m_Map.clear(); }
 
     private:
+        using ResourceFuture = std::shared_future<RefCntAutoPtr<ResType>>;
+
         std::mutex m_Mtx;
         // Keep weak resource references in the cache
         std::unordered_map<ResourceKey, RefCntWeakPtr<ResType>, ResourceKey::Hasher> m_Map;
+        // Resources that are being created by other threads
+        std::unordered_map<ResourceKey, ResourceFuture, ResourceKey::Hasher> m_Pending;
     };
 
     struct ResourceCache
@@ -163,7 +206,9 @@ private:
     {
         std::mutex Mtx;
 
-        std::vector<RefCntAutoPtr<IShader>> Shaders;
+        // Invalid future indicates that the shader has not been unpacked yet.
+        // The thread that unpacks the shader sets the value, other threads wait for it.
+        std::vector<std::shared_future<RefCntAutoPtr<IShader>>> Shaders;
 
         ShaderCacheData() = default;
         ShaderCacheData(ShaderCacheData&& rhs) noexcept :
@@ -178,8 +223,9 @@ private:
 
     struct ArchiveData
     {
-        explicit ArchiveData(std::unique_ptr<DeviceObjectArchive>&& _pObjArchive) noexcept :
-            pObjArchive{std::move(_pObjArchive)}
+        ArchiveData(std::unique_ptr<DeviceObjectArchive>&& _pObjArchive, bool _Override) noexcept :
+            pObjArchive{std::move(_pObjArchive)},
+            Override{_Override}
         {}
         // clang-format off
         ArchiveData           (const ArchiveData&)  = delete;
@@ -190,6 +236,9 @@ private:
 
         std::unique_ptr<const DeviceObjectArchive> pObjArchive;
 
+        // Whether resources in this archive override resources from previously loaded archives
+        const bool Override;
+
         std::array<ShaderCacheData, static_cast<size_t>(DeviceType::Count)> CachedShaders;
     };
 
@@ -207,92 +256,180 @@ private:
     template <typename CreateInfoType>
     void UnpackPipelineStateImpl(const PipelineStateUnpackInfo& UnpackInfo, IPipelineState** ppPSO);
 
+    template <typename CreateInfoType>
+    void CreatePipelineState(const PipelineStateUnpackInfo& UnpackInfo, IPipelineState** ppPSO);
+
+    void CreateRenderPass(const RenderPassUnpackInfo& UnpackInfo, IRenderPass** ppRP);
+
+    void UnpackRenderPassImpl(const RenderPassUnpackInfo& UnpackInfo, IRenderPass** ppRP);
+
+    // Adds the resource requested by the application to the usage manifest
+    void RecordUsage(ResourceType Type, const char* Name);
+
+    void PrefetchResource(const DearchiverPrefetchInfo& PrefetchInfo, ResourceType Type, const char* Name);
+
+    template <typename CreateInfoType>
+    RefCntAutoPtr<IPipelineState> PrefetchPipelineState(const DearchiverPrefetchInfo& PrefetchInfo, PIPELINE_TYPE PipelineType, const char* Name);
+
+    // Waits until all prefetch tasks are finished
+    void WaitForPrefetch();
+
     ArchiveData* FindArchive(ResourceType ResType, const char* ResName);
 
 private:
     // Resource type and name -> archive index that contains this resource.
-    // Names must be unique for each resource type.
-    using NamedResourceKey = DeviceObjectArchive::NamedResourceKey;
-    std::unordered_map<NamedResourceKey, size_t, NamedResourceKey::Hasher> m_ResNameToArchiveIdx;
+    // Names must be unique for each resource type. When an archive is loaded
+    // with the override flag, its resources are remapped to the new archive.
+    std::unordered_map<ResourceKey, size_t, ResourceKey::Hasher> m_ResNameToArchiveIdx;
 
     std::vector<ArchiveData> m_Archives;
+
+    static constexpr Uint32 UsageManifestMagicNumber = 0xDE00A5F0;
+    static constexpr Uint32 UsageManifestVersion     = 1;
+
+    // Resources unpacked by the application, in the order they were first requested
+    mutable std::mutex                                   m_UsageMtx;
+    std::vector<ResourceKey>                             m_UsageManifest;
+    std::unordered_set<ResourceKey, ResourceKey::Hasher> m_RecordedResources;
+
+    struct PrefetchState
+    {
+        std::mutex              Mtx;
+        std::condition_variable PendingTasksCV;
+        Uint32                  NumPendingTasks = 0;
+
+        // Keep prefetched objects alive until the dearchiver is reset
+        std::vector<RefCntAutoPtr<IDeviceObject>> Objects;
+
+        std::atomic<Uint32> NumResources{0};
+        std::atomic<Uint32> NumUnpacked{0};
+        std::atomic<Uint32> NumFailed{0};
+
+        // Tasks that have not started before the dearchiver is reset skip unpacking
+        std::atomic<bool> Cancelled{false};
+    } m_Prefetch;
 };
 
 
-template <typename RenderDeviceImplType, typename PRSSerializerType>
-RefCntAutoPtr<IPipelineResourceSignature> DearchiverBase::UnpackResourceSignatureImpl(
-    const ResourceSignatureUnpackInfo& DeArchiveInfo,
-    bool                               IsImplicit)
+template <typename ResType>
+template <typename CreateFuncType>
+RefCntAutoPtr<ResType> DearchiverBase::NamedResourceCache<ResType>::GetOrCreate(ResourceType Type, const char* Name, CreateFuncType&& Create)
 {
-    RefCntAutoPtr<IPipelineResourceSignature> pSignature;
-    // Do not reuse implicit signatures
-    if (!IsImplicit)
+    VERIFY_EXPR(Name != nullptr && Name[0] != '\0');
+
+    const ResourceKey Key{Type, HashedName{Name}};
+
+    std::promise<RefCntAutoPtr<ResType>> Promise;
     {
-        // Since signature names must be unique, we use a single cache for all
-        // loaded archives.
-        if (m_Cache.Sign.Get(PRSData::ArchiveResType, DeArchiveInfo.Name, pSignature.RawDblPtr()))
-            return pSignature;
+        std::unique_lock<std::mutex> Lock{m_Mtx};
+
+        auto it = m_Map.find(Key);
+        if (it != m_Map.end())
+        {
+            if (auto pResource = it->second.Lock())
+                return pResource;
+        }
+
+        auto pending_it = m_Pending.find(Key);
+        if (pending_it != m_Pending.end())
+        {
+            // Another thread is creating the resource
+            auto Future = pending_it->second;
+            Lock.unlock();
+            return Future.get();
+        }
+
+        m_Pending.emplace(Key, Promise.get_future().share());
     }
 
-    // Find the archive that contains this signature
-    auto archive_idx_it = m_ResNameToArchiveIdx.find(NamedResourceKey{PRSData::ArchiveResType, DeArchiveInfo.Name});
-    if (archive_idx_it == m_ResNameToArchiveIdx.end())
-        return {};
+    RefCntAutoPtr<ResType> pResource;
+    try
+    {
+        pResource = Create();
+    }
+    catch (...)
+    {
+        LOG_ERROR_MESSAGE("Failed to unpack resource '", Name, "'.");
+    }
 
-    const auto& pObjArchive = m_Archives[archive_idx_it->second].pObjArchive;
-    if (!pObjArchive)
     {
-        UNEXPECTED("Null object archives should never be added to the list. This is a bug.");
-        return {};
+        std::unique_lock<std::mutex> Lock{m_Mtx};
+        if (pResource)
+            m_Map[Key] = RefCntWeakPtr<ResType>{pResource};
+        // Failed requests are not cached, so that the next request tries again
+        m_Pending.erase(Key);
     }
+    Promise.set_value(pResource);
+
+    return pResource;
+}
+
+template <typename RenderDeviceImplType, typename PRSSerializerType>
+RefCntAutoPtr<IPipelineResourceSignature> DearchiverBase::UnpackResourceSignatureImpl(
+    const ResourceSignatureUnpackInfo& DeArchiveInfo,
+    bool                               IsImplicit)
+{
+    auto UnpackSignature = [&]() -> RefCntAutoPtr<IPipelineResourceSignature> {
+        // Find the archive that contains this signature
+        auto* pArchive = FindArchive(PRSData::ArchiveResType, DeArchiveInfo.Name);
+        if (pArchive == nullptr)
+            return {};
 
-    PRSData PRS{GetRawAllocator()};
-    if (!pObjArchive->LoadResourceCommonData(PRSData::ArchiveResType, DeArchiveInfo.Name, PRS))
-        return {};
+        const auto& pObjArchive = pArchive->pObjArchive;
 
-    PRS.Desc.SRBAllocationGranularity = DeArchiveInfo.SRBAllocationGranularity;
+        PRSData PRS{GetRawAllocator()};
+        if (!pObjArchive->LoadResourceCommonData(PRSData::ArchiveResType, DeArchiveInfo.Name, PRS))
+            return {};
 
-    const auto  DevType = GetArchiveDeviceType(DeArchiveInfo.pDevice);
-    const auto& Data    = pObjArchive->GetDeviceSpecificData(PRSData::ArchiveResType, DeArchiveInfo.Name, DevType);
-    if (!Data)
-        return {};
+        PRS.Desc.SRBAllocationGranularity = DeArchiveInfo.SRBAllocationGranularity;
 
-    Serializer<SerializerMode::Read> Ser{Data};
+        const auto  DevType = GetArchiveDeviceType(DeArchiveInfo.pDevice);
+        const auto& Data    = pObjArchive->GetDeviceSpecificData(PRSData::ArchiveResType, DeArchiveInfo.Name, DevType);
+        if (!Data)
+            return {};
 
-    bool SpecialDesc = false;
-    if (!Ser(SpecialDesc))
-    {
-        LOG_ERROR_MESSAGE("Failed to deserialize SpecialDesc flag. Archive file may be corrupted or invalid.");
-        return {};
-    }
+        Serializer<SerializerMode::Read> Ser{Data};
 
-    if (SpecialDesc)
-    {
-        // The signature uses a special description that differs from the common
-        const auto* Name = PRS.Desc.Name;
-        PRS.Desc         = {};
-        if (!PRS.Deserialize(Name, Ser))
+        bool SpecialDesc = false;
+        if (!Ser(SpecialDesc))
         {
-            LOG_ERROR_MESSAGE("Failed to deserialize PRS description. Archive file may be corrupted or invalid.");
+            LOG_ERROR_MESSAGE("Failed to deserialize SpecialDesc flag. Archive file may be corrupted or invalid.");
             return {};
         }
-    }
 
-    typename PRSSerializerType::InternalDataType InternalData;
-    if (!PRSSerializerType::SerializeInternalData(Ser, InternalData, &PRS.Allocator))
-    {
-        LOG_ERROR_MESSAGE("Failed to deserialize PRS internal data. Archive file may be corrupted or invalid.");
-        return {};
-    }
-    VERIFY_EXPR(Ser.IsEnded());
+        if (SpecialDesc)
+        {
+            // The signature uses a special description that differs from the common
+            const auto* Name = PRS.Desc.Name;
+            PRS.Desc         = {};
+            if (!PRS.Deserialize(Name, Ser))
+            {
+                LOG_ERROR_MESSAGE("Failed to deserialize PRS description. Archive file may be corrupted or invalid.");
+                return {};
+            }
+        }
 
-    auto* pRenderDevice = ClassPtrCast<RenderDeviceImplType>(DeArchiveInfo.pDevice);
-    pRenderDevice->CreatePipelineResourceSignature(PRS.Desc, InternalData, &pSignature);
+        typename PRSSerializerType::InternalDataType InternalData;
+        if (!PRSSerializerType::SerializeInternalData(Ser, InternalData, &PRS.Allocator))
+        {
+            LOG_ERROR_MESSAGE("Failed to deserialize PRS internal data. Archive file may be corrupted or invalid.");
+            return {};
+        }
+        VERIFY_EXPR(Ser.IsEnded());
+
+        RefCntAutoPtr<IPipelineResourceSignature> pSignature;
+        auto*                                     pRenderDevice = ClassPtrCast<RenderDeviceImplType>(DeArchiveInfo.pDevice);
+        pRenderDevice->CreatePipelineResourceSignature(PRS.Desc, InternalData, &pSignature);
+        return pSignature;
+    };
 
-    if (!IsImplicit)
-        m_Cache.Sign.Set(PRSData::ArchiveResType, DeArchiveInfo.Name, pSignature.RawPtr());
+    // Do not reuse implicit signatures
+    if (IsImplicit)
+        return UnpackSignature();
 
-    return pSignature;
+    // Since signature names must be unique, we use a single cache for all
+    // loaded archives.
+    return m_Cache.Sign.GetOrCreate(PRSData::ArchiveResType, DeArchiveInfo.Name, UnpackSignature);
 }
 
 } // namespace Diligent
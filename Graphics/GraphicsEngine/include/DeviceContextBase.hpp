@@ -48,6 +48,10 @@
 #include "BasicMath.hpp"
 #include "PlatformMisc.hpp"
 #include "Align.hpp"
+#include "DynamicLinearAllocator.hpp"
+#include "STDAllocator.hpp"
+#include "DeviceContextInstrumentation.hpp"
+#include "StartupProfiler.hpp"
 
 namespace Diligent
 {
@@ -57,6 +61,8 @@ bool VerifyDrawAttribs               (const DrawAttribs&                Attribs)
 bool VerifyDrawIndexedAttribs        (const DrawIndexedAttribs&         Attribs);
 bool VerifyDrawIndirectAttribs       (const DrawIndirectAttribs&        Attribs);
 bool VerifyDrawIndexedIndirectAttribs(const DrawIndexedIndirectAttribs& Attribs);
+bool VerifyMultiDrawAttribs          (const MultiDrawAttribs&           Attribs);
+bool VerifyMultiDrawIndexedAttribs   (const MultiDrawIndexedAttribs&    Attribs);
 
 bool VerifyDispatchComputeAttribs        (const DispatchComputeAttribs&         Attribs);
 bool VerifyDispatchComputeIndirectAttribs(const DispatchComputeIndirectAttribs& Attribs);
@@ -79,7 +85,8 @@ bool VerifyStateTransitionDesc(const IRenderDevice*       pDevice,
                                DeviceContextIndex         ExecutionCtxId,
                                const DeviceContextDesc&   CtxDesc);
 
-bool VerifyBuildBLASAttribs(const BuildBLASAttribs& Attribs, const IRenderDevice* pDevice);
+bool VerifyBuildBLASAttribs(const BuildBLASAttribs& Attribs, const IRenderDevice* pDevice, bool ScratchBufferOptional = false);
+bool VerifyBuildBLASBatchAttribs(const BuildBLASBatchAttribs& Attribs, const IRenderDevice* pDevice);
 bool VerifyBuildTLASAttribs(const BuildTLASAttribs& Attribs, const RayTracingProperties& RTProps);
 bool VerifyCopyBLASAttribs(const IRenderDevice* pDevice, const CopyBLASAttribs& Attribs);
 bool VerifyCopyTLASAttribs(const CopyTLASAttribs& Attribs);
@@ -92,6 +99,8 @@ bool VerifyTraceRaysIndirectAttribs(const IRenderDevice*            pDevice,
 
 bool VerifyBindSparseResourceMemoryAttribs(const IRenderDevice* pDevice, const BindSparseResourceMemoryAttribs& Attribs);
 
+bool VerifyResolveQueryArrayAttribs(const ResolveQueryArrayAttribs& Attribs);
+
 
 /// Describes input vertex stream
 template <typename BufferImplType>
@@ -158,7 +167,9 @@ public:
             Desc.IsDeferred,
             Desc.ContextId,
             Desc.QueueId
-        }
+        },
+        m_FrameAllocator{GetRawAllocator(), 4 << 10},
+        m_Instrumentation{pRenderDevice->GetInstrumentationSink()}
     // clang-format on
     {
         VERIFY_EXPR(m_pDevice != nullptr);
@@ -268,6 +279,8 @@ public:
 
     virtual void DILIGENT_CALL_TYPE GenerateMips(ITextureView* pTexView) override = 0;
 
+    virtual void DILIGENT_CALL_TYPE GenerateMipsBatch(ITextureView* const* ppTexViews, Uint32 NumViews) override = 0;
+
     virtual void DILIGENT_CALL_TYPE ResolveTextureSubresource(ITexture*                               pSrcTexture,
                                                               ITexture*                               pDstTexture,
                                                               const ResolveTextureSubresourceAttribs& ResolveAttribs) override = 0;
@@ -278,6 +291,32 @@ public:
     }
 
     /// Implementation of IDeviceContext::SetUserData.
+    /// Implementation of IDeviceContext::GetInstrumentationStats().
+    virtual void DILIGENT_CALL_TYPE GetInstrumentationStats(DeviceContextInstrumentationStats& Stats) const override final
+    {
+        Stats = m_Instrumentation.GetLastFrameStats();
+    }
+
+    /// Implementation of IDeviceContext::GetFrameStatistics().
+    virtual void DILIGENT_CALL_TYPE GetFrameStatistics(DeviceContextFrameStatistics& Stats) const override final
+    {
+        Stats = m_LastFrameStats;
+    }
+
+    /// Implementation of IDeviceContext::SetValidationLevel().
+    virtual void DILIGENT_CALL_TYPE SetValidationLevel(CONTEXT_VALIDATION_LEVEL Level, Uint32 SamplingInterval) override final
+    {
+        m_ValidationLevel            = ResolveValidationLevel(Level);
+        m_ValidationSamplingInterval = std::max(SamplingInterval, 1u);
+        m_ValidationSampleCounter    = 0;
+    }
+
+    /// Implementation of IDeviceContext::GetValidationLevel().
+    virtual CONTEXT_VALIDATION_LEVEL DILIGENT_CALL_TYPE GetValidationLevel() const override final
+    {
+        return m_ValidationLevel;
+    }
+
     virtual void DILIGENT_CALL_TYPE SetUserData(IObject* pUserData) override final
     {
         m_pUserData = pUserData;
@@ -313,6 +352,9 @@ public:
     /// Returns the render device
     IRenderDevice* GetDevice() { return m_pDevice; }
 
+    /// Returns the resource state epoch of the render device, see RenderDeviceBase::GetResourceStateEpoch().
+    Uint32 GetResourceStateEpoch() const { return m_pDevice->GetResourceStateEpoch(); }
+
     virtual void ResetRenderTargets();
 
     bool IsDeferred() const { return m_Desc.IsDeferred; }
@@ -335,6 +377,10 @@ public:
         return IsDeferred() ? m_DstImmediateContextId : GetContextId();
     }
 
+    // Returns true if the deferred context records a command list that may be
+    // executed multiple times (see IDeviceContext::BeginReusable()).
+    bool IsRecordingReusableCommands() const { return m_IsRecordingReusableCommands; }
+
 protected:
     /// Committed shader resources for each resource signature
     struct CommittedShaderResources
@@ -367,6 +413,19 @@ protected:
         // buffers with dynamic offsets in all backends).
         SRBMaskType DynamicSRBMask = 0;
 
+        // Indicates which SRBs have inline constants that may need to be
+        // written to their buffers before a draw/dispatch command.
+        SRBMaskType InlineConstantsSRBMask = 0;
+
+        // The number of resource signatures in the pipeline for which the resources were
+        // last prepared by PrepareCommittedResources(), or 0 if they have not been prepared.
+        Uint8 PreparedSignatureCount = 0;
+
+        // Unique IDs of the resource signatures of that pipeline (0 for null signatures).
+        // Unique IDs are never reused, so unlike raw pointers they can't alias a signature
+        // that has been released and another one that is allocated at the same address.
+        std::array<UniqueIdentifier, MAX_RESOURCE_SIGNATURES> PreparedSignatureIDs = {};
+
         void Set(Uint32 Index, ShaderResourceBindingImplType* pSRB)
         {
             VERIFY_EXPR(Index < MAX_RESOURCE_SIGNATURES);
@@ -384,6 +443,11 @@ protected:
             else
                 DynamicSRBMask &= ~SRBBit;
 
+            if (pResourceCache != nullptr && pResourceCache->HasInlineConstants())
+                InlineConstantsSRBMask |= SRBBit;
+            else
+                InlineConstantsSRBMask &= ~SRBBit;
+
 #ifdef DILIGENT_DEVELOPMENT
             SRBs[Index] = pSRB;
             if (pSRB != nullptr)
@@ -440,6 +504,10 @@ protected:
 #endif
     };
 
+    /// Writes inline constants of the active SRBs that have changed since the last draw/dispatch
+    /// command to their buffers, and marks the SRBs as stale so that the new buffer data are bound.
+    void UpdateInlineConstantBuffers(CommittedShaderResources& ResInfo);
+
     /// Caches the render target and depth stencil views. Returns true if any view is different
     /// from the cached value and false otherwise.
     inline bool SetRenderTargets(const SetRenderTargetsAttribs& Attribs);
@@ -451,7 +519,14 @@ protected:
 
     inline bool SetStencilRef(Uint32 StencilRef, int Dummy);
 
-    inline void SetPipelineState(RefCntAutoPtr<PipelineStateImplType> pPipelineState, int /*Dummy*/);
+    inline void SetPipelineState(RefCntAutoPtr<PipelineStateImplType>&& pPipelineState, int /*Dummy*/);
+
+    /// Returns true if pPipelineState is the pipeline state that is currently bound to the context.
+    /// Unlike QueryInterface, the check does not touch the reference counters.
+    bool IsBoundPipelineState(const IPipelineState* pPipelineState) const
+    {
+        return pPipelineState != nullptr && static_cast<const IPipelineState*>(m_pPipelineState.RawPtr()) == pPipelineState;
+    }
 
     /// Clears all cached resources
     inline void ClearStateCache();
@@ -473,15 +548,64 @@ protected:
 
     void EndQuery(IQuery* pQuery, int);
 
+    void BeginIndexedQuery(IQueryArray* pQueryArray, Uint32 Index, int);
+    void EndIndexedQuery(IQueryArray* pQueryArray, Uint32 Index, int);
+    void ResolveQueryArray(const ResolveQueryArrayAttribs& Attribs, int);
+    void SetPredication(IBuffer* pBuffer, Uint64 Offset, PREDICATION_OP Op, int);
+    void SetQueryPredication(IQuery* pQuery, PREDICATION_OP Op, int);
+
+    void SetCullMode(CULL_MODE CullMode, int);
+    void SetDepthStencilState(const DepthStencilStateDesc& DSSDesc, int);
+    void SetPrimitiveTopology(PRIMITIVE_TOPOLOGY Topology, int);
+
     void EnqueueSignal(IFence* pFence, Uint64 Value, int);
     void DeviceWaitForFence(IFence* pFence, Uint64 Value, int);
 
     void EndFrame()
     {
+        // All transient CPU data allocated during the frame is freed at once,
+        // the memory pages are kept and reused by the next frame.
+        m_FrameAllocator.Discard();
+        m_Instrumentation.EndFrame();
+        m_LastFrameStats = m_FrameStats;
+        m_FrameStats     = {};
         ++m_FrameNumber;
+
+        // The first frames of the first immediate context are part of the startup timeline
+        if (!IsDeferred() && m_Desc.ContextId == 0 && StartupProfiler::IsActive())
+        {
+            StartupProfiler::AddMark(("Frame " + std::to_string(m_FrameNumber - 1) + " finished").c_str());
+            if (m_FrameNumber == m_pDevice->GetStartupProfilingFrames())
+                m_pDevice->FinishStartupProfiling();
+        }
+
+        if (!IsDeferred() && m_Desc.ContextId == 0)
+            m_pDevice->CheckMemoryPressure();
     }
 
-    void PrepareCommittedResources(CommittedShaderResources& Resources, Uint32& DvpCompatibleSRBCount);
+    /// Vector for transient CPU data that uses the frame allocator, see m_FrameAllocator.
+    template <typename T>
+    using FrameVector = std::vector<T, STDLinearAllocator<T, DynamicLinearAllocator>>;
+
+    /// Creates an empty frame vector and reserves space for Capacity elements.
+    template <typename T>
+    FrameVector<T> MakeFrameVector(size_t Capacity = 0)
+    {
+        FrameVector<T> Vec{STDLinearAllocator<T, DynamicLinearAllocator>{m_FrameAllocator}};
+        Vec.reserve(Capacity);
+        return Vec;
+    }
+
+    /// Computes the scratch buffer offsets of all builds in the batch and returns the context-owned
+    /// scratch buffer that the builds without pScratchBuffer are suballocated from, or null if
+    /// every build provides its own scratch buffer.
+    BufferImplType* PrepareBLASBatchScratchBuffer(const BuildBLASBatchAttribs& Attribs, Uint64* pScratchOffsets);
+
+    /// Prepares the committed resources for the currently bound pipeline state.
+    /// Returns false if the pipeline uses the same resource signatures as the pipeline
+    /// the resources were last prepared for, in which case no work is done and all state
+    /// derived from the resource layout (e.g. descriptor set offsets) remains valid.
+    bool PrepareCommittedResources(CommittedShaderResources& Resources, Uint32& DvpCompatibleSRBCount);
 
     bool IsRecordingDeferredCommands() const
     {
@@ -506,12 +630,29 @@ protected:
     {
         DEV_CHECK_ERR(IsDeferred(), "FinishCommandList() is only allowed for deferred contexts.");
         DEV_CHECK_ERR(IsRecordingDeferredCommands(), "This context is not recording commands. Call Begin() before finishing the recording.");
-        m_DstImmediateContextId = INVALID_CONTEXT_ID;
-        m_Desc.QueueType        = COMMAND_QUEUE_TYPE_UNKNOWN;
+        m_DstImmediateContextId       = INVALID_CONTEXT_ID;
+        m_IsRecordingReusableCommands = false;
+        m_Desc.QueueType              = COMMAND_QUEUE_TYPE_UNKNOWN;
         for (size_t i = 0; i < _countof(m_Desc.TextureCopyGranularity); ++i)
             m_Desc.TextureCopyGranularity[i] = 0;
     }
 
+    // Performs the checks of the draw and dispatch commands enabled by the validation level,
+    // see IDeviceContext::SetValidationLevel(). Returns false if the command must be skipped.
+    // clang-format off
+    bool VerifyDrawArguments                 (const DrawAttribs&                  Attribs);
+    bool VerifyDrawIndexedArguments          (const DrawIndexedAttribs&           Attribs);
+    bool VerifyDrawMeshArguments             (const DrawMeshAttribs&              Attribs);
+    bool VerifyDrawIndirectArguments         (const DrawIndirectAttribs&          Attribs);
+    bool VerifyDrawIndexedIndirectArguments  (const DrawIndexedIndirectAttribs&   Attribs);
+    bool VerifyDrawMeshIndirectArguments     (const DrawMeshIndirectAttribs&      Attribs);
+    bool VerifyMultiDrawArguments            (const MultiDrawAttribs&             Attribs);
+    bool VerifyMultiDrawIndexedArguments     (const MultiDrawIndexedAttribs&      Attribs);
+
+    bool VerifyDispatchArguments        (const DispatchComputeAttribs& Attribs);
+    bool VerifyDispatchIndirectArguments(const DispatchComputeIndirectAttribs& Attribs);
+    // clang-format on
+
 #ifdef DILIGENT_DEVELOPMENT
     // clang-format off
     void DvpVerifyDrawArguments                 (const DrawAttribs&                  Attribs) const;
@@ -520,6 +661,8 @@ protected:
     void DvpVerifyDrawIndirectArguments         (const DrawIndirectAttribs&          Attribs) const;
     void DvpVerifyDrawIndexedIndirectArguments  (const DrawIndexedIndirectAttribs&   Attribs) const;
     void DvpVerifyDrawMeshIndirectArguments     (const DrawMeshIndirectAttribs&      Attribs) const;
+    void DvpVerifyMultiDrawArguments            (const MultiDrawAttribs&             Attribs) const;
+    void DvpVerifyMultiDrawIndexedArguments     (const MultiDrawIndexedAttribs&      Attribs) const;
 
     void DvpVerifyDispatchArguments        (const DispatchComputeAttribs& Attribs) const;
     void DvpVerifyDispatchIndirectArguments(const DispatchComputeIndirectAttribs& Attribs) const;
@@ -546,6 +689,8 @@ protected:
     void DvpVerifyDrawIndirectArguments         (const DrawIndirectAttribs&          Attribs) const {}
     void DvpVerifyDrawIndexedIndirectArguments  (const DrawIndexedIndirectAttribs&   Attribs) const {}
     void DvpVerifyDrawMeshIndirectArguments     (const DrawMeshIndirectAttribs&      Attribs) const {}
+    void DvpVerifyMultiDrawArguments            (const MultiDrawAttribs&             Attribs) const {}
+    void DvpVerifyMultiDrawIndexedArguments     (const MultiDrawIndexedAttribs&      Attribs) const {}
 
     void DvpVerifyDispatchArguments        (const DispatchComputeAttribs& Attribs) const {}
     void DvpVerifyDispatchIndirectArguments(const DispatchComputeIndirectAttribs& Attribs) const {}
@@ -561,7 +706,39 @@ protected:
     // clang-format on
 #endif
 
+    static CONTEXT_VALIDATION_LEVEL ResolveValidationLevel(CONTEXT_VALIDATION_LEVEL Level)
+    {
+#ifdef DILIGENT_DEVELOPMENT
+        return Level == CONTEXT_VALIDATION_LEVEL_DEFAULT ? CONTEXT_VALIDATION_LEVEL_FULL : Level;
+#else
+        // The full validation is not compiled in release builds
+        return Level == CONTEXT_VALIDATION_LEVEL_DEFAULT ? CONTEXT_VALIDATION_LEVEL_OFF : std::min(Level, CONTEXT_VALIDATION_LEVEL_BASIC);
+#endif
+    }
+
+    bool IsBasicValidationEnabled() const
+    {
+        return m_ValidationLevel >= CONTEXT_VALIDATION_LEVEL_BASIC;
+    }
+
+    // Returns true if the current draw or dispatch command must be fully validated.
+    bool SampleFullValidation()
+    {
+#ifdef DILIGENT_DEVELOPMENT
+        m_DvpValidateCurrentCmd =
+            m_ValidationLevel >= CONTEXT_VALIDATION_LEVEL_FULL &&
+            (m_ValidationSamplingInterval <= 1 || (m_ValidationSampleCounter++ % m_ValidationSamplingInterval) == 0);
+        return m_DvpValidateCurrentCmd;
+#else
+        return false;
+#endif
+    }
+
+    // Basic check of the bound pipeline that is performed in all builds
+    bool VerifyBoundPipeline(PIPELINE_TYPE PipelineType, const char* CmdName) const;
+
     void BuildBLAS(const BuildBLASAttribs& Attribs, int) const;
+    void BuildBLASBatch(const BuildBLASBatchAttribs& Attribs, int) const;
     void BuildTLAS(const BuildTLASAttribs& Attribs, int) const;
     void CopyBLAS(const CopyBLASAttribs& Attribs, int) const;
     void CopyTLAS(const CopyTLASAttribs& Attribs, int) const;
@@ -662,16 +839,44 @@ protected:
 
     RefCntAutoPtr<IObject> m_pUserData;
 
+    /// Scratch buffer shared by the builds of IDeviceContext::BuildBLASBatch() that don't provide their own.
+    /// The buffer only grows and is reused by subsequent batches: the state transition to RESOURCE_STATE_BUILD_AS_WRITE
+    /// of every batch is a write-after-write transition that always inserts a barrier.
+    RefCntAutoPtr<IBuffer> m_pBLASBatchScratchBuffer;
+
     // Must go before m_Desc!
     const String m_Name;
 
     DeviceContextDesc m_Desc;
 
+    /// Linear allocator for transient CPU data (temporary arrays of command buffers,
+    /// geometry descriptions, etc.) that is discarded at the end of every frame by EndFrame().
+    /// Since the memory pages are reused, steady-state frames do not allocate heap memory.
+    /// The data must not be referenced after the frame is finished.
+    DynamicLinearAllocator m_FrameAllocator;
+
+    /// CPU instrumentation of the context calls, see DILIGENT_INSTRUMENT_CALL.
+    DeviceContextInstrumentation m_Instrumentation;
+
+    /// Statistics of the current frame that are updated by the backends, and
+    /// the statistics of the last finished frame returned by GetFrameStatistics().
+    DeviceContextFrameStatistics m_FrameStats;
+    DeviceContextFrameStatistics m_LastFrameStats;
+
     // For deferred contexts in recording state only, the index
     // of the destination immediate context where the command list
     // will be submitted.
     DeviceContextIndex m_DstImmediateContextId{INVALID_CONTEXT_ID};
 
+    // For deferred contexts in recording state only, indicates that
+    // the command list was begun by BeginReusable().
+    bool m_IsRecordingReusableCommands = false;
+
+    // Validation level of draw and dispatch commands, see IDeviceContext::SetValidationLevel().
+    CONTEXT_VALIDATION_LEVEL m_ValidationLevel            = ResolveValidationLevel(CONTEXT_VALIDATION_LEVEL_DEFAULT);
+    Uint32                   m_ValidationSamplingInterval = 1;
+    Uint32                   m_ValidationSampleCounter    = 0;
+
 #ifdef DILIGENT_DEBUG
     // std::unordered_map is unbelievably slow. Keeping track of mapped buffers
     // in release builds is not feasible
@@ -683,6 +888,9 @@ protected:
 #endif
 #ifdef DILIGENT_DEVELOPMENT
     int m_DvpDebugGroupCount = 0;
+
+    // Indicates if the current draw or dispatch command is fully validated, see SampleFullValidation().
+    bool m_DvpValidateCurrentCmd = true;
 #endif
 };
 
@@ -754,7 +962,7 @@ inline void DeviceContextBase<ImplementationTraits>::SetVertexBuffers(
 
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::SetPipelineState(
-    RefCntAutoPtr<PipelineStateImplType> pPipelineState,
+    RefCntAutoPtr<PipelineStateImplType>&& pPipelineState,
     int /*Dummy*/)
 {
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_COMPUTE, "SetPipelineState");
@@ -762,6 +970,7 @@ inline void DeviceContextBase<ImplementationTraits>::SetPipelineState(
                   "PSO '", pPipelineState->GetDesc().Name, "' can't be used in device context '", m_Desc.Name, "'.");
 
     m_pPipelineState = std::move(pPipelineState);
+    ++m_FrameStats.PipelineStateBindCount;
 }
 
 template <typename ImplementationTraits>
@@ -776,6 +985,13 @@ inline void DeviceContextBase<ImplementationTraits>::CommitShaderResources(
                   "Do not use RESOURCE_STATE_TRANSITION_MODE_TRANSITION or end the render pass first.");
 
     DEV_CHECK_ERR(pShaderResourceBinding != nullptr, "pShaderResourceBinding must not be null");
+
+    ++m_FrameStats.SRBCommitCount;
+
+#if DILIGENT_INSTRUMENTATION
+    if (StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+        m_Instrumentation.AddImplicitTransition();
+#endif
 }
 
 template <typename ImplementationTraits>
@@ -941,6 +1157,36 @@ inline void DeviceContextBase<ImplementationTraits>::SetScissorRects(
     }
 }
 
+template <typename ImplementationTraits>
+void DeviceContextBase<ImplementationTraits>::UpdateInlineConstantBuffers(CommittedShaderResources& ResInfo)
+{
+    const auto CtxId = Uint32{GetContextId()};
+    for (Uint32 SRBMask = ResInfo.InlineConstantsSRBMask & ResInfo.ActiveSRBMask; SRBMask != 0;)
+    {
+        const auto SRBBit = ExtractLSB(SRBMask);
+        const auto Idx    = PlatformMisc::GetLSB(SRBBit);
+        auto*      pCache = ResInfo.ResourceCaches[Idx];
+        VERIFY_EXPR(pCache != nullptr);
+        if (pCache->InlineConstantBuffersUpToDate(CtxId, m_FrameNumber))
+            continue;
+
+        pCache->UpdateInlineConstantBuffers(
+            CtxId, m_FrameNumber,
+            [this](IBuffer* pBuffer, const Uint32* pConstants, Uint32 NumConstants) //
+            {
+                PVoid pData = nullptr;
+                MapBuffer(pBuffer, MAP_WRITE, MAP_FLAG_DISCARD, pData);
+                if (pData != nullptr)
+                    memcpy(pData, pConstants, sizeof(Uint32) * NumConstants);
+                UnmapBuffer(pBuffer, MAP_WRITE);
+            });
+
+        // Dynamic buffers get new memory every time they are mapped, so the SRB must be bound again
+        // even if the application indicated that dynamic buffers are intact.
+        ResInfo.StaleSRBMask |= static_cast<typename CommittedShaderResources::SRBMaskType>(SRBBit);
+    }
+}
+
 template <typename ImplementationTraits>
 inline bool DeviceContextBase<ImplementationTraits>::SetRenderTargets(const SetRenderTargetsAttribs& Attribs)
 {
@@ -1593,6 +1839,7 @@ template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::BeginQuery(IQuery* pQuery, int)
 {
     DEV_CHECK_ERR(pQuery != nullptr, "IDeviceContext::BeginQuery: pQuery must not be null");
+    DEV_CHECK_ERR(!IsDeferred() || !IsRecordingReusableCommands(), "Queries can't be used in reusable command lists");
 
     const auto QueryType = pQuery->GetDesc().Type;
     DEV_CHECK_ERR(QueryType != QUERY_TYPE_TIMESTAMP,
@@ -1608,6 +1855,7 @@ template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::EndQuery(IQuery* pQuery, int)
 {
     DEV_CHECK_ERR(pQuery != nullptr, "IDeviceContext::EndQuery: pQuery must not be null");
+    DEV_CHECK_ERR(!IsDeferred() || !IsRecordingReusableCommands(), "Queries can't be used in reusable command lists");
 
     const auto QueryType = pQuery->GetDesc().Type;
     const auto QueueType = QueryType == QUERY_TYPE_DURATION || QueryType == QUERY_TYPE_TIMESTAMP ? COMMAND_QUEUE_TYPE_TRANSFER : COMMAND_QUEUE_TYPE_GRAPHICS;
@@ -1616,6 +1864,134 @@ inline void DeviceContextBase<ImplementationTraits>::EndQuery(IQuery* pQuery, in
     ClassPtrCast<QueryImplType>(pQuery)->OnEndQuery(static_cast<DeviceContextImplType*>(this));
 }
 
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::BeginIndexedQuery(IQueryArray* pQueryArray, Uint32 Index, int)
+{
+    DEV_CHECK_ERR(pQueryArray != nullptr, "IDeviceContext::BeginIndexedQuery: pQueryArray must not be null");
+    DEV_CHECK_ERR(!IsDeferred() || !IsRecordingReusableCommands(), "Queries can't be used in reusable command lists");
+
+    const auto& Desc = pQueryArray->GetDesc();
+    DEV_CHECK_ERR(Index < Desc.Size, "IDeviceContext::BeginIndexedQuery: query index (", Index,
+                  ") is out of range for query array '", Desc.Name, "' of size ", Desc.Size);
+    DEV_CHECK_ERR(Desc.Type != QUERY_TYPE_TIMESTAMP,
+                  "BeginIndexedQuery() is disabled for timestamp queries. Call EndIndexedQuery() to set the timestamp.");
+
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "BeginIndexedQuery for query type ", GetQueryTypeString(Desc.Type));
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::EndIndexedQuery(IQueryArray* pQueryArray, Uint32 Index, int)
+{
+    DEV_CHECK_ERR(pQueryArray != nullptr, "IDeviceContext::EndIndexedQuery: pQueryArray must not be null");
+    DEV_CHECK_ERR(!IsDeferred() || !IsRecordingReusableCommands(), "Queries can't be used in reusable command lists");
+
+    const auto& Desc = pQueryArray->GetDesc();
+    DEV_CHECK_ERR(Index < Desc.Size, "IDeviceContext::EndIndexedQuery: query index (", Index,
+                  ") is out of range for query array '", Desc.Name, "' of size ", Desc.Size);
+
+    const auto QueueType = Desc.Type == QUERY_TYPE_TIMESTAMP ? COMMAND_QUEUE_TYPE_COMPUTE : COMMAND_QUEUE_TYPE_GRAPHICS;
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(QueueType, "EndIndexedQuery for query type ", GetQueryTypeString(Desc.Type));
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::ResolveQueryArray(const ResolveQueryArrayAttribs& Attribs, int)
+{
+    DEV_CHECK_ERR(!IsDeferred() || !IsRecordingReusableCommands(), "Queries can't be used in reusable command lists");
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "IDeviceContext::ResolveQueryArray: command must be performed outside of render pass");
+    DEV_CHECK_ERR(VerifyResolveQueryArrayAttribs(Attribs), "ResolveQueryArrayAttribs are invalid");
+
+    if (Attribs.pQueryArray != nullptr)
+    {
+        const auto QueueType = Attribs.pQueryArray->GetDesc().Type == QUERY_TYPE_TIMESTAMP ? COMMAND_QUEUE_TYPE_COMPUTE : COMMAND_QUEUE_TYPE_GRAPHICS;
+        DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(QueueType, "ResolveQueryArray for query type ", GetQueryTypeString(Attribs.pQueryArray->GetDesc().Type));
+    }
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::SetPredication(IBuffer* pBuffer, Uint64 Offset, PREDICATION_OP Op, int)
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_COMPUTE, "SetPredication");
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "IDeviceContext::SetPredication: command must be performed outside of render pass");
+    DEV_CHECK_ERR((m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_PREDICATION) != 0,
+                  "IDeviceContext::SetPredication: predication is not supported by this device");
+    DEV_CHECK_ERR(Op <= PREDICATION_OP_LAST, "IDeviceContext::SetPredication: invalid predication operation");
+
+    if (pBuffer != nullptr)
+    {
+        const auto& BuffDesc = pBuffer->GetDesc();
+        DEV_CHECK_ERR((BuffDesc.BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0,
+                      "IDeviceContext::SetPredication: buffer '", BuffDesc.Name, "' was not created with BIND_INDIRECT_DRAW_ARGS flag");
+        DEV_CHECK_ERR(Offset % 8 == 0, "IDeviceContext::SetPredication: offset (", Offset, ") must be a multiple of 8");
+        DEV_CHECK_ERR(Offset + sizeof(Uint64) <= BuffDesc.Size,
+                      "IDeviceContext::SetPredication: offset (", Offset, ") is out of range for buffer '", BuffDesc.Name, "' of size ", BuffDesc.Size);
+    }
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::SetQueryPredication(IQuery* pQuery, PREDICATION_OP Op, int)
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "SetQueryPredication");
+    DEV_CHECK_ERR((m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_QUERY_PREDICATION) != 0,
+                  "IDeviceContext::SetQueryPredication: query predication is not supported by this device");
+    DEV_CHECK_ERR(Op <= PREDICATION_OP_LAST, "IDeviceContext::SetQueryPredication: invalid predication operation");
+
+    if (pQuery != nullptr)
+    {
+        const auto& QueryDesc = pQuery->GetDesc();
+        DEV_CHECK_ERR(QueryDesc.Type == QUERY_TYPE_BINARY_OCCLUSION,
+                      "IDeviceContext::SetQueryPredication: query '", QueryDesc.Name, "' is not a binary occlusion query");
+        DEV_CHECK_ERR(ClassPtrCast<QueryImplType>(pQuery)->GetState() == QueryImplType::QueryState::Ended,
+                      "IDeviceContext::SetQueryPredication: query '", QueryDesc.Name, "' has not been ended");
+    }
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::SetCullMode(CULL_MODE CullMode, int)
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "SetCullMode");
+    DEV_CHECK_ERR(m_pDevice->GetFeatures().ExtendedDynamicState, "IDeviceContext::SetCullMode: ExtendedDynamicState feature is not enabled");
+    DEV_CHECK_ERR(CullMode > CULL_MODE_UNDEFINED && CullMode < CULL_MODE_NUM_MODES, "IDeviceContext::SetCullMode: invalid cull mode");
+    DEV_CHECK_ERR(m_pPipelineState && m_pPipelineState->GetDesc().IsAnyGraphicsPipeline(),
+                  "IDeviceContext::SetCullMode: no graphics pipeline state is bound");
+    DEV_CHECK_ERR((m_pPipelineState->GetGraphicsPipelineDesc().DynamicStateFlags & PIPELINE_DYNAMIC_STATE_FLAG_CULL_MODE) != 0,
+                  "IDeviceContext::SetCullMode: pipeline state '", m_pPipelineState->GetDesc().Name,
+                  "' was not created with PIPELINE_DYNAMIC_STATE_FLAG_CULL_MODE flag");
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::SetDepthStencilState(const DepthStencilStateDesc& DSSDesc, int)
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "SetDepthStencilState");
+    DEV_CHECK_ERR(m_pDevice->GetFeatures().ExtendedDynamicState, "IDeviceContext::SetDepthStencilState: ExtendedDynamicState feature is not enabled");
+    DEV_CHECK_ERR(m_pPipelineState && m_pPipelineState->GetDesc().IsAnyGraphicsPipeline(),
+                  "IDeviceContext::SetDepthStencilState: no graphics pipeline state is bound");
+    DEV_CHECK_ERR((m_pPipelineState->GetGraphicsPipelineDesc().DynamicStateFlags & (PIPELINE_DYNAMIC_STATE_FLAG_DEPTH | PIPELINE_DYNAMIC_STATE_FLAG_STENCIL)) != 0,
+                  "IDeviceContext::SetDepthStencilState: pipeline state '", m_pPipelineState->GetDesc().Name,
+                  "' was not created with PIPELINE_DYNAMIC_STATE_FLAG_DEPTH or PIPELINE_DYNAMIC_STATE_FLAG_STENCIL flag");
+    DEV_CHECK_ERR(!DSSDesc.DepthEnable || (DSSDesc.DepthFunc > COMPARISON_FUNC_UNKNOWN && DSSDesc.DepthFunc < COMPARISON_FUNC_NUM_FUNCTIONS),
+                  "IDeviceContext::SetDepthStencilState: invalid depth function");
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::SetPrimitiveTopology(PRIMITIVE_TOPOLOGY Topology, int)
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "SetPrimitiveTopology");
+    DEV_CHECK_ERR(m_pDevice->GetFeatures().ExtendedDynamicState, "IDeviceContext::SetPrimitiveTopology: ExtendedDynamicState feature is not enabled");
+    DEV_CHECK_ERR(m_pPipelineState && m_pPipelineState->GetDesc().PipelineType == PIPELINE_TYPE_GRAPHICS,
+                  "IDeviceContext::SetPrimitiveTopology: no graphics pipeline state is bound");
+
+    const auto& GraphicsPipeline = m_pPipelineState->GetGraphicsPipelineDesc();
+    DEV_CHECK_ERR((GraphicsPipeline.DynamicStateFlags & PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY) != 0,
+                  "IDeviceContext::SetPrimitiveTopology: pipeline state '", m_pPipelineState->GetDesc().Name,
+                  "' was not created with PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY flag");
+    DEV_CHECK_ERR(IsSamePrimitiveTopologyClass(Topology, GraphicsPipeline.PrimitiveTopology),
+                  "IDeviceContext::SetPrimitiveTopology: topology ", Uint32{Topology}, " is not of the same class as the topology ",
+                  Uint32{GraphicsPipeline.PrimitiveTopology}, " of pipeline state '", m_pPipelineState->GetDesc().Name, "'");
+    DEV_CHECK_ERR(Topology < PRIMITIVE_TOPOLOGY_1_CONTROL_POINT_PATCHLIST || Topology == GraphicsPipeline.PrimitiveTopology,
+                  "IDeviceContext::SetPrimitiveTopology: the number of patch control points must match the pipeline state '",
+                  m_pPipelineState->GetDesc().Name, "'");
+}
+
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::EnqueueSignal(IFence* pFence, Uint64 Value, int)
 {
@@ -1819,6 +2195,37 @@ inline void DeviceContextBase<ImplementationTraits>::GenerateMips(ITextureView*
 #endif
 }
 
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::GenerateMipsBatch(ITextureView* const* ppTexViews, Uint32 NumViews)
+{
+    DEV_CHECK_ERR(ppTexViews != nullptr || NumViews == 0, "ppTexViews must not be null");
+    for (Uint32 i = 0; i < NumViews; ++i)
+        DeviceContextBase<ImplementationTraits>::GenerateMips(ppTexViews[i]);
+
+#ifdef DILIGENT_DEVELOPMENT
+    for (Uint32 i = 0; i < NumViews; ++i)
+    {
+        const auto& Desc0 = ppTexViews[i]->GetDesc();
+        for (Uint32 j = i + 1; j < NumViews; ++j)
+        {
+            if (ppTexViews[i]->GetTexture() != ppTexViews[j]->GetTexture())
+                continue;
+
+            const auto& Desc1 = ppTexViews[j]->GetDesc();
+
+            const bool MipsOverlap =
+                Desc0.MostDetailedMip < Desc1.MostDetailedMip + Desc1.NumMipLevels &&
+                Desc1.MostDetailedMip < Desc0.MostDetailedMip + Desc0.NumMipLevels;
+            const bool SlicesOverlap =
+                Desc0.FirstArraySlice < Desc1.FirstArraySlice + Desc1.NumArraySlices &&
+                Desc1.FirstArraySlice < Desc0.FirstArraySlice + Desc0.NumArraySlices;
+            DEV_CHECK_ERR(!MipsOverlap || !SlicesOverlap, "Views '", Desc0.Name, "' and '", Desc1.Name,
+                          "' in the GenerateMipsBatch command reference overlapping subresources of the same texture.");
+        }
+    }
+#endif
+}
+
 
 template <typename ImplementationTraits>
 void DeviceContextBase<ImplementationTraits>::ResolveTextureSubresource(
@@ -1848,6 +2255,68 @@ void DeviceContextBase<ImplementationTraits>::BuildBLAS(const BuildBLASAttribs&
     DEV_CHECK_ERR(VerifyBuildBLASAttribs(Attribs, m_pDevice), "BuildBLASAttribs are invalid");
 }
 
+template <typename ImplementationTraits>
+void DeviceContextBase<ImplementationTraits>::BuildBLASBatch(const BuildBLASBatchAttribs& Attribs, int) const
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_COMPUTE, "BuildBLASBatch");
+    DEV_CHECK_ERR(m_pDevice->GetFeatures().RayTracing, "IDeviceContext::BuildBLASBatch: ray tracing is not supported by this device");
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "IDeviceContext::BuildBLASBatch command must be performed outside of render pass");
+    DEV_CHECK_ERR(VerifyBuildBLASBatchAttribs(Attribs, m_pDevice), "BuildBLASBatchAttribs are invalid");
+}
+
+template <typename ImplementationTraits>
+typename DeviceContextBase<ImplementationTraits>::BufferImplType* DeviceContextBase<ImplementationTraits>::PrepareBLASBatchScratchBuffer(
+    const BuildBLASBatchAttribs& Attribs,
+    Uint64*                      pScratchOffsets)
+{
+    const Uint32 Alignment = m_pDevice->GetAdapterInfo().RayTracing.ScratchBufferAlignment;
+
+    Uint64 RequiredSize = 0;
+    for (Uint32 i = 0; i < Attribs.BuildCount; ++i)
+    {
+        const BuildBLASAttribs& Build = Attribs.pBuilds[i];
+        if (Build.pScratchBuffer != nullptr)
+        {
+            pScratchOffsets[i] = Build.ScratchBufferOffset;
+            continue;
+        }
+
+        const ScratchBufferSizes& Sizes = Build.pBLAS->GetScratchBufferSizes();
+
+        pScratchOffsets[i] = RequiredSize;
+        RequiredSize       = AlignUp(RequiredSize + (Build.Update ? Sizes.Update : Sizes.Build), Uint64{Alignment});
+    }
+
+    if (RequiredSize == 0)
+        return nullptr;
+
+    const Uint64 CurrSize = m_pBLASBatchScratchBuffer ? m_pBLASBatchScratchBuffer->GetDesc().Size : 0;
+    if (CurrSize < RequiredSize)
+    {
+        BufferDesc ScratchDesc;
+        ScratchDesc.Name      = "BLAS batch scratch buffer";
+        ScratchDesc.Usage     = USAGE_DEFAULT;
+        ScratchDesc.BindFlags = BIND_RAY_TRACING;
+        // Grow geometrically to avoid recreating the buffer for batches that are only slightly larger.
+        ScratchDesc.Size = std::max(RequiredSize, CurrSize * 2);
+        // Deferred contexts may be executed by any immediate context.
+        ScratchDesc.ImmediateContextMask = IsDeferred() ?
+            (Uint64{1} << m_pDevice->GetCommandQueueCount()) - 1 :
+            Uint64{1} << GetContextId();
+
+        // The previous buffer is released through the device's release queue once the GPU is done with it.
+        m_pBLASBatchScratchBuffer.Release();
+        m_pDevice->CreateBuffer(ScratchDesc, nullptr, &m_pBLASBatchScratchBuffer);
+        if (!m_pBLASBatchScratchBuffer)
+        {
+            LOG_ERROR_MESSAGE("Failed to create BLAS batch scratch buffer of size ", ScratchDesc.Size);
+            return nullptr;
+        }
+    }
+
+    return ClassPtrCast<BufferImplType>(m_pBLASBatchScratchBuffer.RawPtr());
+}
+
 template <typename ImplementationTraits>
 void DeviceContextBase<ImplementationTraits>::BuildTLAS(const BuildTLASAttribs& Attribs, int) const
 {
@@ -2057,21 +2526,47 @@ void DeviceContextBase<ImplementationTraits>::BindSparseResourceMemory(const Bin
 }
 
 template <typename ImplementationTraits>
-inline void DeviceContextBase<ImplementationTraits>::PrepareCommittedResources(CommittedShaderResources& Resources, Uint32& DvpCompatibleSRBCount)
+inline bool DeviceContextBase<ImplementationTraits>::PrepareCommittedResources(CommittedShaderResources& Resources, Uint32& DvpCompatibleSRBCount)
 {
     const auto SignCount = m_pPipelineState->GetResourceSignatureCount();
 
+    DvpCompatibleSRBCount = 0;
+
+    // Pipelines that share resource signatures (e.g. materials sorted by PSO) have the same
+    // resource layout, so SRB compatibility and the active SRB mask do not need to be re-evaluated.
+    if (Resources.PreparedSignatureCount == SignCount)
+    {
+        Uint32 sign = 0;
+        for (; sign < SignCount; ++sign)
+        {
+            const auto* pSignature = m_pPipelineState->GetResourceSignature(sign);
+            if (Resources.PreparedSignatureIDs[sign] != (pSignature != nullptr ? pSignature->GetUniqueID() : 0))
+                break;
+        }
+
+        if (sign == SignCount)
+        {
+#ifdef DILIGENT_DEVELOPMENT
+            DvpCompatibleSRBCount = SignCount;
+            // The shaders are different, so the resources must be validated again
+            Resources.ResourcesValidated = false;
+#endif
+            return false;
+        }
+    }
+
     Resources.ActiveSRBMask = 0;
     for (Uint32 i = 0; i < SignCount; ++i)
     {
         const auto* pSignature = m_pPipelineState->GetResourceSignature(i);
+
+        Resources.PreparedSignatureIDs[i] = pSignature != nullptr ? pSignature->GetUniqueID() : 0;
         if (pSignature == nullptr || pSignature->GetTotalResourceCount() == 0)
             continue;
 
         Resources.ActiveSRBMask |= 1u << i;
     }
-
-    DvpCompatibleSRBCount = 0;
+    Resources.PreparedSignatureCount = static_cast<Uint8>(SignCount);
 
 #ifdef DILIGENT_DEVELOPMENT
     // Layout compatibility means that descriptor sets can be bound to a command buffer
@@ -2114,8 +2609,228 @@ inline void DeviceContextBase<ImplementationTraits>::PrepareCommittedResources(C
 
     Resources.ResourcesValidated = false;
 #endif
+
+    return true;
+}
+
+template <typename ImplementationTraits>
+bool DeviceContextBase<ImplementationTraits>::VerifyBoundPipeline(PIPELINE_TYPE PipelineType, const char* CmdName) const
+{
+    if (!m_pPipelineState)
+    {
+        LOG_ERROR_MESSAGE(CmdName, " command is skipped: no pipeline state is bound.");
+        return false;
+    }
+
+    const auto& PSODesc = m_pPipelineState->GetDesc();
+    if (PSODesc.PipelineType != PipelineType)
+    {
+        LOG_ERROR_MESSAGE(CmdName, " command is skipped: pipeline state '", PSODesc.Name, "' is a ",
+                          GetPipelineTypeString(PSODesc.PipelineType), " pipeline, while ", GetPipelineTypeString(PipelineType), " pipeline is expected.");
+        return false;
+    }
+
+    return true;
 }
 
+#ifdef DILIGENT_DEVELOPMENT
+#    define DVP_VERIFY_SAMPLED(VerifyFunc) \
+        do                                 \
+        {                                  \
+            if (SampleFullValidation())    \
+                VerifyFunc(Attribs);       \
+        } while (false)
+#else
+#    define DVP_VERIFY_SAMPLED(VerifyFunc) (void)0
+#endif
+
+template <typename ImplementationTraits>
+bool DeviceContextBase<ImplementationTraits>::VerifyDrawArguments(const DrawAttribs& Attribs)
+{
+    DVP_VERIFY_SAMPLED(DvpVerifyDrawArguments);
+
+    if (!IsBasicValidationEnabled())
+        return true;
+
+    return VerifyBoundPipeline(PIPELINE_TYPE_GRAPHICS, "Draw");
+}
+
+template <typename ImplementationTraits>
+bool DeviceContextBase<ImplementationTraits>::VerifyDrawIndexedArguments(const DrawIndexedAttribs& Attribs)
+{
+    DVP_VERIFY_SAMPLED(DvpVerifyDrawIndexedArguments);
+
+    if (!IsBasicValidationEnabled())
+        return true;
+
+    if (!VerifyBoundPipeline(PIPELINE_TYPE_GRAPHICS, "DrawIndexed"))
+        return false;
+
+    if (!m_pIndexBuffer)
+    {
+        LOG_ERROR_MESSAGE("DrawIndexed command is skipped: no index buffer is bound.");
+        return false;
+    }
+
+    return true;
+}
+
+template <typename ImplementationTraits>
+bool DeviceContextBase<ImplementationTraits>::VerifyDrawMeshArguments(const DrawMeshAttribs& Attribs)
+{
+    DVP_VERIFY_SAMPLED(DvpVerifyDrawMeshArguments);
+
+    if (!IsBasicValidationEnabled())
+        return true;
+
+    return VerifyBoundPipeline(PIPELINE_TYPE_MESH, "DrawMesh");
+}
+
+template <typename ImplementationTraits>
+bool DeviceContextBase<ImplementationTraits>::VerifyDrawIndirectArguments(const DrawIndirectAttribs& Attribs)
+{
+    DVP_VERIFY_SAMPLED(DvpVerifyDrawIndirectArguments);
+
+    if (!IsBasicValidationEnabled())
+        return true;
+
+    if (!VerifyBoundPipeline(PIPELINE_TYPE_GRAPHICS, "DrawIndirect"))
+        return false;
+
+    if (Attribs.pAttribsBuffer == nullptr)
+    {
+        LOG_ERROR_MESSAGE("DrawIndirect command is skipped: indirect draw arguments buffer must not be null.");
+        return false;
+    }
+
+    return true;
+}
+
+template <typename ImplementationTraits>
+bool DeviceContextBase<ImplementationTraits>::VerifyDrawIndexedIndirectArguments(const DrawIndexedIndirectAttribs& Attribs)
+{
+    DVP_VERIFY_SAMPLED(DvpVerifyDrawIndexedIndirectArguments);
+
+    if (!IsBasicValidationEnabled())
+        return true;
+
+    if (!VerifyBoundPipeline(PIPELINE_TYPE_GRAPHICS, "DrawIndexedIndirect"))
+        return false;
+
+    if (!m_pIndexBuffer)
+    {
+        LOG_ERROR_MESSAGE("DrawIndexedIndirect command is skipped: no index buffer is bound.");
+        return false;
+    }
+
+    if (Attribs.pAttribsBuffer == nullptr)
+    {
+        LOG_ERROR_MESSAGE("DrawIndexedIndirect command is skipped: indirect draw arguments buffer must not be null.");
+        return false;
+    }
+
+    return true;
+}
+
+template <typename ImplementationTraits>
+bool DeviceContextBase<ImplementationTraits>::VerifyDrawMeshIndirectArguments(const DrawMeshIndirectAttribs& Attribs)
+{
+    DVP_VERIFY_SAMPLED(DvpVerifyDrawMeshIndirectArguments);
+
+    if (!IsBasicValidationEnabled())
+        return true;
+
+    if (!VerifyBoundPipeline(PIPELINE_TYPE_MESH, "DrawMeshIndirect"))
+        return false;
+
+    if (Attribs.pAttribsBuffer == nullptr)
+    {
+        LOG_ERROR_MESSAGE("DrawMeshIndirect command is skipped: indirect draw arguments buffer must not be null.");
+        return false;
+    }
+
+    return true;
+}
+
+template <typename ImplementationTraits>
+bool DeviceContextBase<ImplementationTraits>::VerifyMultiDrawArguments(const MultiDrawAttribs& Attribs)
+{
+    DVP_VERIFY_SAMPLED(DvpVerifyMultiDrawArguments);
+
+    if (!IsBasicValidationEnabled())
+        return true;
+
+    if (!VerifyBoundPipeline(PIPELINE_TYPE_GRAPHICS, "MultiDraw"))
+        return false;
+
+    if (Attribs.DrawCount != 0 && Attribs.pDrawItems == nullptr)
+    {
+        LOG_ERROR_MESSAGE("MultiDraw command is skipped: DrawCount is ", Attribs.DrawCount, ", but pDrawItems is null.");
+        return false;
+    }
+
+    return true;
+}
+
+template <typename ImplementationTraits>
+bool DeviceContextBase<ImplementationTraits>::VerifyMultiDrawIndexedArguments(const MultiDrawIndexedAttribs& Attribs)
+{
+    DVP_VERIFY_SAMPLED(DvpVerifyMultiDrawIndexedArguments);
+
+    if (!IsBasicValidationEnabled())
+        return true;
+
+    if (!VerifyBoundPipeline(PIPELINE_TYPE_GRAPHICS, "MultiDrawIndexed"))
+        return false;
+
+    if (!m_pIndexBuffer)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexed command is skipped: no index buffer is bound.");
+        return false;
+    }
+
+    if (Attribs.DrawCount != 0 && Attribs.pDrawItems == nullptr)
+    {
+        LOG_ERROR_MESSAGE("MultiDrawIndexed command is skipped: DrawCount is ", Attribs.DrawCount, ", but pDrawItems is null.");
+        return false;
+    }
+
+    return true;
+}
+
+template <typename ImplementationTraits>
+bool DeviceContextBase<ImplementationTraits>::VerifyDispatchArguments(const DispatchComputeAttribs& Attribs)
+{
+    DVP_VERIFY_SAMPLED(DvpVerifyDispatchArguments);
+
+    if (!IsBasicValidationEnabled())
+        return true;
+
+    return VerifyBoundPipeline(PIPELINE_TYPE_COMPUTE, "DispatchCompute");
+}
+
+template <typename ImplementationTraits>
+bool DeviceContextBase<ImplementationTraits>::VerifyDispatchIndirectArguments(const DispatchComputeIndirectAttribs& Attribs)
+{
+    DVP_VERIFY_SAMPLED(DvpVerifyDispatchIndirectArguments);
+
+    if (!IsBasicValidationEnabled())
+        return true;
+
+    if (!VerifyBoundPipeline(PIPELINE_TYPE_COMPUTE, "DispatchComputeIndirect"))
+        return false;
+
+    if (Attribs.pAttribsBuffer == nullptr)
+    {
+        LOG_ERROR_MESSAGE("DispatchComputeIndirect command is skipped: indirect dispatch arguments buffer must not be null.");
+        return false;
+    }
+
+    return true;
+}
+
+#undef DVP_VERIFY_SAMPLED
+
 #ifdef DILIGENT_DEVELOPMENT
 
 template <typename ImplementationTraits>
@@ -2153,6 +2868,41 @@ inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawIndexedArgumen
     DEV_CHECK_ERR(VerifyDrawIndexedAttribs(Attribs), "DrawIndexedAttribs are invalid");
 }
 
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::DvpVerifyMultiDrawArguments(const MultiDrawAttribs& Attribs) const
+{
+    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return;
+
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "MultiDraw");
+
+    DEV_CHECK_ERR(m_pPipelineState, "MultiDraw command arguments are invalid: no pipeline state is bound.");
+
+    DEV_CHECK_ERR(m_pPipelineState->GetDesc().PipelineType == PIPELINE_TYPE_GRAPHICS,
+                  "MultiDraw command arguments are invalid: pipeline state '", m_pPipelineState->GetDesc().Name, "' is not a graphics pipeline.");
+
+    DEV_CHECK_ERR(VerifyMultiDrawAttribs(Attribs), "MultiDrawAttribs are invalid");
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::DvpVerifyMultiDrawIndexedArguments(const MultiDrawIndexedAttribs& Attribs) const
+{
+    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return;
+
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "MultiDrawIndexed");
+
+    DEV_CHECK_ERR(m_pPipelineState, "MultiDrawIndexed command arguments are invalid: no pipeline state is bound.");
+
+    DEV_CHECK_ERR(m_pPipelineState->GetDesc().PipelineType == PIPELINE_TYPE_GRAPHICS,
+                  "MultiDrawIndexed command arguments are invalid: pipeline state '",
+                  m_pPipelineState->GetDesc().Name, "' is not a graphics pipeline.");
+
+    DEV_CHECK_ERR(m_pIndexBuffer, "MultiDrawIndexed command arguments are invalid: no index buffer is bound.");
+
+    DEV_CHECK_ERR(VerifyMultiDrawIndexedAttribs(Attribs), "MultiDrawIndexedAttribs are invalid");
+}
+
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawMeshArguments(const DrawMeshAttribs& Attribs) const
 {
@@ -2250,6 +3000,9 @@ inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawMeshIndirectAr
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::DvpVerifyRenderTargets() const
 {
+    if (!m_DvpValidateCurrentCmd)
+        return;
+
     DEV_CHECK_ERR(m_pPipelineState, "No pipeline state is bound");
 
     const auto& PSODesc = m_pPipelineState->GetDesc();
@@ -0,0 +1,157 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::DeviceContextInstrumentation class
+
+#include "GraphicsTypes.h"
+#include "DeviceContext.h"
+#include "DebugUtilities.hpp"
+#include "CPUProfiler.hpp"
+#include "Timer.hpp"
+
+namespace Diligent
+{
+
+/// Returns the name of the instrumented call type, e.g. "CommitShaderResources".
+inline const Char* GetInstrumentedCallName(INSTRUMENTED_CALL Call)
+{
+    static_assert(INSTRUMENTED_CALL_COUNT == 7, "Please handle the new instrumented call type below");
+    switch (Call)
+    {
+        // clang-format off
+        case INSTRUMENTED_CALL_SET_PIPELINE_STATE:         return "SetPipelineState";
+        case INSTRUMENTED_CALL_COMMIT_SHADER_RESOURCES:    return "CommitShaderResources";
+        case INSTRUMENTED_CALL_TRANSITION_RESOURCE_STATES: return "TransitionResourceStates";
+        case INSTRUMENTED_CALL_MAP_BUFFER:                 return "MapBuffer";
+        case INSTRUMENTED_CALL_UNMAP_BUFFER:               return "UnmapBuffer";
+        case INSTRUMENTED_CALL_DRAW:                       return "Draw";
+        case INSTRUMENTED_CALL_DISPATCH:                   return "Dispatch";
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected instrumented call type");
+            return "Unknown";
+    }
+}
+
+/// CPU instrumentation of the device context calls.
+
+/// Accumulates the call counts and times of the current frame and forwards begin/end
+/// events to the user-provided sink, see Diligent::InstrumentationSinkDesc, and to the CPU profiler,
+/// see Diligent::CPUProfiler. A device context is not thread-safe, so neither is the instrumentation.
+class DeviceContextInstrumentation
+{
+public:
+    explicit DeviceContextInstrumentation(const InstrumentationSinkDesc& Sink) noexcept :
+        m_Sink{Sink}
+    {}
+
+    /// Measures the scope of an instrumented call.
+    class ScopedCall
+    {
+    public:
+        ScopedCall(DeviceContextInstrumentation& Instrumentation, INSTRUMENTED_CALL Call) noexcept :
+            m_Instrumentation{Instrumentation},
+            m_Call{Call},
+            m_ProfilerScope{GetInstrumentedCallName(Call)}
+        {
+            VERIFY_EXPR(Call < INSTRUMENTED_CALL_COUNT);
+            const auto& Sink = m_Instrumentation.m_Sink;
+            if (Sink.BeginCall != nullptr)
+                Sink.BeginCall(m_Call, GetInstrumentedCallName(m_Call), Sink.pUserData);
+
+            m_StartTicks = GetCPUTimestamp();
+        }
+
+        ~ScopedCall()
+        {
+            // Ticks are converted to nanoseconds once per frame, see EndFrame()
+            auto& Stats = m_Instrumentation.m_CurrFrameStats;
+            Stats.CallCounts[m_Call] += 1;
+            Stats.CallTimes[m_Call] += GetCPUTimestamp() - m_StartTicks;
+
+            const auto& Sink = m_Instrumentation.m_Sink;
+            if (Sink.EndCall != nullptr)
+                Sink.EndCall(m_Call, Sink.pUserData);
+        }
+
+        // clang-format off
+        ScopedCall           (const ScopedCall&) = delete;
+        ScopedCall& operator=(const ScopedCall&) = delete;
+        ScopedCall           (ScopedCall&&)      = delete;
+        ScopedCall& operator=(ScopedCall&&)      = delete;
+        // clang-format on
+
+    private:
+        DeviceContextInstrumentation& m_Instrumentation;
+        const INSTRUMENTED_CALL       m_Call;
+        CPUProfiler::Scope            m_ProfilerScope;
+        Uint64                        m_StartTicks = 0;
+    };
+
+    void AddImplicitTransition()
+    {
+        ++m_CurrFrameStats.ImplicitTransitionCount;
+    }
+
+    /// Makes the statistics of the current frame available through GetLastFrameStats()
+    /// and starts a new frame.
+    void EndFrame()
+    {
+        m_LastFrameStats = m_CurrFrameStats;
+        for (auto& CallTime : m_LastFrameStats.CallTimes)
+            CallTime = CPUTicksToNanoseconds(CallTime);
+        m_CurrFrameStats = {};
+    }
+
+    const DeviceContextInstrumentationStats& GetLastFrameStats() const
+    {
+        return m_LastFrameStats;
+    }
+
+private:
+    const InstrumentationSinkDesc m_Sink;
+
+    DeviceContextInstrumentationStats m_CurrFrameStats;
+    DeviceContextInstrumentationStats m_LastFrameStats;
+};
+
+} // namespace Diligent
+
+/// Instruments the enclosing device context method, see Diligent::DeviceContextInstrumentation.
+/// The instrumentation is only compiled in when the engine is built with DILIGENT_ENABLE_INSTRUMENTATION CMake option.
+#if DILIGENT_INSTRUMENTATION
+#    define DILIGENT_INSTRUMENT_CALL(Call) \
+        DeviceContextInstrumentation::ScopedCall InstrumentedCallScope { m_Instrumentation, Call }
+#else
+#    define DILIGENT_INSTRUMENT_CALL(Call) \
+        do                                 \
+        {                                  \
+        } while (false)
+#endif
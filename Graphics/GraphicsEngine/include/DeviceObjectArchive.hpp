@@ -32,6 +32,7 @@
 #include <array>
 #include <vector>
 #include <unordered_map>
+#include <functional>
 
 #include "GraphicsTypes.h"
 #include "FileStream.h"
@@ -44,11 +45,15 @@
 
 // Device object archive structure:
 //
-// | Header |  Resource Data  |  Shader Data  |
+// | Header | Directory |  Resource Data  |  Shader Data  |
 //
-//     |  Resource Data  | = | Res1 | Res2 | ... | ResN |
+//     | Directory | = | NumResources | Res1 | Res2 | ... | ResN | OpenGL shaders | D3D11 shaders | ...  | Metal-iOS shaders |
 //
-//         | ResI | = | Type | Name | Common Data |  OpenGL data | D3D11 data | ...  | Metal-iOS data |
+//         | ResI | = | Type | Name | Common Data Range |  OpenGL Data Range | D3D11 Data Range | ...  | Metal-iOS Data Range |
+//
+//         | XXX shaders | = | NumShaders | Shader0 Data Range | Shader1 Data Range | ... |
+//
+//     |  Resource Data  | = | Res1 Common Data | Res1 OpenGL Data | ... | ResN Metal-iOS Data |
 //
 //     |  Shader Data  | =  |  OpenGL shaders | D3D11 shaders | ...  | Metal-iOS shaders |
 //
@@ -56,8 +61,15 @@
 // - Magic number
 // - Archive version
 // - API version
-
-// Resource data contains an array of resources. Each resource contains:
+//
+// The directory lists all resources and shaders in the archive. Each data range is the
+// offset of the data block from the beginning of the archive and its size. Only the directory
+// is parsed when the archive is loaded; data blocks are accessed when the resource is unpacked,
+// so that for a memory-mapped archive, only the pages that contain the requested resource and
+// the data for the current device are ever loaded. Identical data blocks are stored once, so
+// several data ranges, possibly of different device types, may reference the same block.
+//
+// Each resource contains:
 // - Type (Signature, Graphics Pipeline, Render Pass, etc.)
 // - Name
 // - Common data (e.g. a resource description)
@@ -127,7 +139,7 @@ public:
     };
 
     static constexpr Uint32 HeaderMagicNumber = 0xDE00000A;
-    static constexpr Uint32 ArchiveVersion    = 4;
+    static constexpr Uint32 ArchiveVersion    = 9;
 
     struct ArchiveHeader
     {
@@ -201,6 +213,10 @@ public:
 
 public:
     /// Initializes a new device object archive from pData.
+
+    /// Only the archive directory is parsed; the resource data is referenced in place.
+    /// To avoid loading the entire archive into memory, pData may be a memory-mapped
+    /// file data blob (see MemoryMappedFileDataBlob), in which case MakeCopy should be false.
     DeviceObjectArchive(const IDataBlob* pData, bool MakeCopy = false) noexcept(false);
 
     /// Initializes an empty archive.
@@ -208,10 +224,22 @@ public:
 
     void RemoveDeviceData(DeviceType Dev) noexcept(false);
     void AppendDeviceData(const DeviceObjectArchive& Src, DeviceType Dev) noexcept(false);
-    void Merge(const DeviceObjectArchive& Src) noexcept(false);
+    /// Returns true if the resource from the source archive should be copied by Merge().
+    using MergeFilterType = std::function<bool(ResourceType Type, const char* Name)>;
+
+    /// Copies resources from Src into this archive. If OverrideExisting is true, resources
+    /// with the same names are replaced by the ones from Src; otherwise, they are kept.
+    ///
+    /// If Filter is not null, only the resources for which it returns true are copied,
+    /// along with the shaders they reference. Otherwise, all resources and shaders are copied.
+    void Merge(const DeviceObjectArchive& Src, bool OverrideExisting = false, const MergeFilterType& Filter = nullptr) noexcept(false);
 
     void Deserialize(const void* pData, size_t Size) noexcept(false);
-    void Serialize(IFileStream* pStream) const;
+
+    /// Writes the archive to the stream piece by piece without creating an intermediate blob.
+    /// Small pieces (the directory and the padding) are best coalesced by a buffered stream,
+    /// see Diligent::BufferedFileStream.
+    bool Serialize(IFileStream* pStream) const;
     void Serialize(IDataBlob** ppDataBlob) const;
 
     std::string ToString() const;
@@ -268,6 +296,12 @@ public:
         return m_NamedResources;
     }
 
+private:
+    // Computes the archive layout, calls BeginArchive with the archive size, and then calls
+    // WriteData for all archive bytes in order, including the padding between the data blocks.
+    bool WriteArchive(const std::function<bool(Uint64 ArchiveSize)>&             BeginArchive,
+                      const std::function<bool(const void* pData, size_t Size)>& WriteData) const;
+
 private:
     // Named resources
     std::unordered_map<NamedResourceKey, ResourceData, NamedResourceKey::Hasher> m_NamedResources;
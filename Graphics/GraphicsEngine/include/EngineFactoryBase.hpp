@@ -38,6 +38,7 @@
 #include "DummyReferenceCounters.hpp"
 #include "EngineMemory.h"
 #include "RefCntAutoPtr.hpp"
+#include "StartupProfiler.hpp"
 
 namespace Diligent
 {
@@ -131,6 +132,15 @@ protected:
             pDearchiver->QueryInterface(IID_Dearchiver, reinterpret_cast<IObject**>(ppDearchiver));
     }
 
+protected:
+    /// Starts the startup timeline recording if it is requested by EngineCI, see EngineCreateInfo::StartupProfiling.
+    /// Must be called by the backend at the beginning of the device creation.
+    static void BeginStartupProfiling(const EngineCreateInfo& EngineCI)
+    {
+        if (EngineCI.StartupProfiling.Enable && !StartupProfiler::Start())
+            LOG_INFO_MESSAGE("Startup profiling has already been started by another engine instance");
+    }
+
 private:
     const INTERFACE_ID                        m_FactoryIID;
     DummyReferenceCounters<EngineFactoryBase> m_RefCounters;
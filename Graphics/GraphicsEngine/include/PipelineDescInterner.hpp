@@ -0,0 +1,325 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of the Diligent::PipelineDescInterner class
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "PipelineState.h"
+#include "InputLayout.h"
+#include "EngineMemory.h"
+#include "FixedLinearAllocator.hpp"
+#include "HashUtils.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Device-wide store of immutable pipeline sub-descriptions that are shared by pipeline states.
+
+/// Many pipelines typically use the same resource layout and the same input layout. Instead of
+/// keeping a private deep copy of these descriptions, every pipeline references an interned block
+/// that holds the description together with all arrays and strings it points to.
+/// Equal descriptions are stored once; a block is released when the last pipeline that references
+/// it is destroyed.
+///
+/// \remarks All methods are thread-safe.
+///
+///          The interner is part of the device. Interned blocks must not outlive it.
+class PipelineDescInterner
+{
+public:
+    template <typename DescType>
+    using InternedPtr = std::shared_ptr<const DescType>;
+
+    explicit PipelineDescInterner(IMemoryAllocator& RawAllocator) :
+        m_ResourceLayouts{RawAllocator},
+        m_InputLayouts{RawAllocator}
+    {}
+
+    // clang-format off
+    PipelineDescInterner           (const PipelineDescInterner&) = delete;
+    PipelineDescInterner& operator=(const PipelineDescInterner&) = delete;
+    // clang-format on
+
+    /// Returns the interned copy of the resource layout description.
+    InternedPtr<PipelineResourceLayoutDesc> Intern(const PipelineResourceLayoutDesc& Layout)
+    {
+        return m_ResourceLayouts.Intern(Layout);
+    }
+
+    /// Returns the interned copy of the input layout description.
+    InternedPtr<InputLayoutDesc> Intern(const InputLayoutDesc& Layout)
+    {
+        return m_InputLayouts.Intern(Layout);
+    }
+
+    /// Returns the number of unique resource layouts that are currently referenced.
+    size_t GetNumResourceLayouts() const { return m_ResourceLayouts.GetSize(); }
+
+    /// Returns the number of unique input layouts that are currently referenced.
+    size_t GetNumInputLayouts() const { return m_InputLayouts.GetSize(); }
+
+private:
+    // Hashes the strings by their contents rather than by the pointers, so that equal
+    // descriptions that use different string storage produce the same hash.
+    class DescHasher
+    {
+    public:
+        template <typename T>
+        typename std::enable_if<std::is_fundamental<T>::value || std::is_enum<T>::value>::type Update(const T& Val) noexcept
+        {
+            HashCombine(m_Hash, Val);
+        }
+
+        void Update(const Char* Str) noexcept
+        {
+            HashCombine(m_Hash, CStringHash<Char>{}(Str));
+        }
+
+        template <typename T>
+        typename std::enable_if<std::is_class<T>::value>::type Update(const T& Val) noexcept
+        {
+            HashCombiner<DescHasher, T> Combiner{*this};
+            Combiner(Val);
+        }
+
+        template <typename FirstArgType, typename... RestArgsType>
+        void Update(const FirstArgType& FirstArg, const RestArgsType&... RestArgs) noexcept
+        {
+            Update(FirstArg);
+            Update(RestArgs...);
+        }
+
+        template <typename... ArgsType>
+        void operator()(const ArgsType&... Args) noexcept
+        {
+            Update(Args...);
+        }
+
+        size_t Get() const { return m_Hash; }
+
+    private:
+        size_t m_Hash = 0;
+    };
+
+    template <typename DescType>
+    static size_t ComputeDescHash(const DescType& Desc)
+    {
+        DescHasher Hasher;
+        Hasher(Desc);
+        return Hasher.Get();
+    }
+
+    static void ReserveSpace(const PipelineResourceLayoutDesc& SrcLayout, FixedLinearAllocator& MemPool) noexcept
+    {
+        MemPool.AddSpace<PipelineResourceLayoutDesc>();
+
+        if (SrcLayout.Variables != nullptr)
+        {
+            MemPool.AddSpace<ShaderResourceVariableDesc>(SrcLayout.NumVariables);
+            for (Uint32 i = 0; i < SrcLayout.NumVariables; ++i)
+            {
+                VERIFY(SrcLayout.Variables[i].Name != nullptr, "Variable name can't be null");
+                MemPool.AddSpaceForString(SrcLayout.Variables[i].Name);
+            }
+        }
+
+        if (SrcLayout.ImmutableSamplers != nullptr)
+        {
+            MemPool.AddSpace<ImmutableSamplerDesc>(SrcLayout.NumImmutableSamplers);
+            for (Uint32 i = 0; i < SrcLayout.NumImmutableSamplers; ++i)
+            {
+                VERIFY(SrcLayout.ImmutableSamplers[i].SamplerOrTextureName != nullptr, "Immutable sampler or texture name can't be null");
+                MemPool.AddSpaceForString(SrcLayout.ImmutableSamplers[i].SamplerOrTextureName);
+            }
+        }
+
+        static_assert(std::is_trivially_destructible<PipelineResourceLayoutDesc>::value, "Add destructor for this object to the block deleter");
+        static_assert(std::is_trivially_destructible<decltype(*SrcLayout.Variables)>::value, "Add destructor for this object to the block deleter");
+        static_assert(std::is_trivially_destructible<decltype(*SrcLayout.ImmutableSamplers)>::value, "Add destructor for this object to the block deleter");
+    }
+
+    static PipelineResourceLayoutDesc* Copy(const PipelineResourceLayoutDesc& SrcLayout, FixedLinearAllocator& MemPool)
+    {
+        auto* pDstLayout = MemPool.Construct<PipelineResourceLayoutDesc>(SrcLayout);
+
+        if (SrcLayout.Variables != nullptr)
+        {
+            auto* const Variables = MemPool.ConstructArray<ShaderResourceVariableDesc>(SrcLayout.NumVariables);
+            pDstLayout->Variables = Variables;
+            for (Uint32 i = 0; i < SrcLayout.NumVariables; ++i)
+            {
+                const auto& SrcVar = SrcLayout.Variables[i];
+                Variables[i]       = SrcVar;
+                Variables[i].Name  = MemPool.CopyString(SrcVar.Name);
+            }
+        }
+
+        if (SrcLayout.ImmutableSamplers != nullptr)
+        {
+            auto* const ImmutableSamplers = MemPool.ConstructArray<ImmutableSamplerDesc>(SrcLayout.NumImmutableSamplers);
+            pDstLayout->ImmutableSamplers = ImmutableSamplers;
+            for (Uint32 i = 0; i < SrcLayout.NumImmutableSamplers; ++i)
+            {
+                const auto& SrcSmplr                      = SrcLayout.ImmutableSamplers[i];
+                ImmutableSamplers[i]                      = SrcSmplr;
+                ImmutableSamplers[i].SamplerOrTextureName = MemPool.CopyString(SrcSmplr.SamplerOrTextureName);
+            }
+        }
+
+        return pDstLayout;
+    }
+
+    static void ReserveSpace(const InputLayoutDesc& SrcLayout, FixedLinearAllocator& MemPool) noexcept
+    {
+        MemPool.AddSpace<InputLayoutDesc>();
+        MemPool.AddSpace<LayoutElement>(SrcLayout.NumElements);
+        for (Uint32 i = 0; i < SrcLayout.NumElements; ++i)
+        {
+            VERIFY(SrcLayout.LayoutElements[i].HLSLSemantic != nullptr, "HLSL semantic can't be null");
+            MemPool.AddSpaceForString(SrcLayout.LayoutElements[i].HLSLSemantic);
+        }
+
+        static_assert(std::is_trivially_destructible<InputLayoutDesc>::value, "Add destructor for this object to the block deleter");
+        static_assert(std::is_trivially_destructible<LayoutElement>::value, "Add destructor for this object to the block deleter");
+    }
+
+    static InputLayoutDesc* Copy(const InputLayoutDesc& SrcLayout, FixedLinearAllocator& MemPool)
+    {
+        auto* pDstLayout = MemPool.Construct<InputLayoutDesc>(SrcLayout);
+
+        auto* const pElements = MemPool.ConstructArray<LayoutElement>(SrcLayout.NumElements);
+        for (Uint32 i = 0; i < SrcLayout.NumElements; ++i)
+        {
+            const auto& SrcElem       = SrcLayout.LayoutElements[i];
+            pElements[i]              = SrcElem;
+            pElements[i].HLSLSemantic = MemPool.CopyString(SrcElem.HLSLSemantic);
+        }
+        pDstLayout->LayoutElements = pElements;
+
+        return pDstLayout;
+    }
+
+    template <typename DescType>
+    class Store
+    {
+    public:
+        explicit Store(IMemoryAllocator& RawAllocator) :
+            m_RawAllocator{RawAllocator}
+        {}
+
+        ~Store()
+        {
+            // Every interned block removes itself from the store when it is released.
+            VERIFY(m_Entries.empty(), m_Entries.size(), " interned pipeline description block(s) outlive the device");
+        }
+
+        InternedPtr<DescType> Intern(const DescType& Desc)
+        {
+            const size_t Hash = ComputeDescHash(Desc);
+
+            std::lock_guard<std::mutex> Guard{m_Mtx};
+
+            auto Range = m_Entries.equal_range(Hash);
+            for (auto it = Range.first; it != Range.second; ++it)
+            {
+                // The block memory is released by the deleter only after the entry is removed,
+                // so the description can be safely compared even if the block is expired.
+                // Note that a strong reference must not be released while the mutex is locked.
+                if (*it->second.pDesc == Desc)
+                {
+                    if (auto pDesc = it->second.wpDesc.lock())
+                        return pDesc;
+                }
+            }
+
+            FixedLinearAllocator MemPool{m_RawAllocator};
+            ReserveSpace(Desc, MemPool);
+            MemPool.Reserve();
+            DescType* pDesc   = Copy(Desc, MemPool);
+            void*     pRawMem = MemPool.ReleaseOwnership();
+            VERIFY_EXPR(pRawMem == pDesc);
+
+            InternedPtr<DescType> pInterned{
+                pDesc,
+                [this, Hash, pRawMem](const DescType* pBlockDesc) //
+                {
+                    Remove(Hash, pBlockDesc);
+                    m_RawAllocator.Free(pRawMem);
+                } //
+            };
+            m_Entries.emplace(Hash, Entry{pDesc, pInterned});
+
+            return pInterned;
+        }
+
+        size_t GetSize() const
+        {
+            std::lock_guard<std::mutex> Guard{m_Mtx};
+            return m_Entries.size();
+        }
+
+    private:
+        void Remove(size_t Hash, const DescType* pDesc)
+        {
+            std::lock_guard<std::mutex> Guard{m_Mtx};
+
+            auto Range = m_Entries.equal_range(Hash);
+            for (auto it = Range.first; it != Range.second; ++it)
+            {
+                if (it->second.pDesc == pDesc)
+                {
+                    m_Entries.erase(it);
+                    return;
+                }
+            }
+            UNEXPECTED("Interned pipeline description block is not found in the store");
+        }
+
+        struct Entry
+        {
+            const DescType*               pDesc = nullptr;
+            std::weak_ptr<const DescType> wpDesc;
+        };
+
+        IMemoryAllocator& m_RawAllocator;
+
+        mutable std::mutex                     m_Mtx;
+        std::unordered_multimap<size_t, Entry> m_Entries;
+    };
+
+    Store<PipelineResourceLayoutDesc> m_ResourceLayouts;
+    Store<InputLayoutDesc>            m_InputLayouts;
+};
+
+} // namespace Diligent
@@ -440,7 +440,7 @@ public:
             return nullptr;
 
         VERIFY_EXPR(static_cast<Uint32>(VarMngrInd) < GetNumStaticResStages());
-        return m_StaticVarsMgrs[VarMngrInd].GetVariable(Name);
+        return m_StaticVarsMgrs[VarMngrInd].GetVariable(ShaderType, Name);
     }
 
     /// Implementation of IPipelineResourceSignature::GetStaticVariableByIndex.
@@ -635,9 +635,30 @@ public:
 
     /// Finds a resource with the given name in the specified shader stage and returns its
     /// index in m_Desc.Resources[], or InvalidPipelineResourceIndex if the resource is not found.
+    /// The name index built at signature creation is used, so the lookup does not scan all resources.
     Uint32 FindResource(SHADER_TYPE ShaderStage, const char* ResourceName) const
     {
-        return Diligent::FindResource(this->m_Desc.Resources, this->m_Desc.NumResources, ShaderStage, ResourceName);
+        VERIFY_EXPR(ResourceName != nullptr && ResourceName[0] != '\0');
+
+        const size_t NameHash = CStringHash<Char>{}(ResourceName);
+
+        const ResourceNameIndexEntry* const pIndexBegin = m_pResourceNameIndex;
+        const ResourceNameIndexEntry* const pIndexEnd   = pIndexBegin + this->m_Desc.NumResources;
+
+        // Entries with the same hash are sorted by the resource index, so the resource
+        // with the smallest index is found first, same as Diligent::FindResource() does.
+        auto* pEntry = std::lower_bound(pIndexBegin, pIndexEnd, NameHash,
+                                        [](const ResourceNameIndexEntry& Entry, size_t Hash) {
+                                            return Entry.NameHash < Hash;
+                                        });
+        for (; pEntry != pIndexEnd && pEntry->NameHash == NameHash; ++pEntry)
+        {
+            const auto& ResDesc = GetResourceDesc(pEntry->ResIndex);
+            if ((ResDesc.ShaderStages & ShaderStage) != 0 && strcmp(ResDesc.Name, ResourceName) == 0)
+                return pEntry->ResIndex;
+        }
+
+        return InvalidPipelineResourceIndex;
     }
 
     /// Finds an immutable with the given name in the specified shader stage and returns its
@@ -690,7 +711,8 @@ public:
     }
 
     // Processes resources with the allowed variable types in the allowed shader stages
-    // and calls user-provided handler for each resource.
+    // and calls user-provided handler for each resource. Resources are processed in the
+    // order of increasing index.
     template <typename HandlerType>
     void ProcessResources(const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
                           Uint32                               NumAllowedTypes,
@@ -702,6 +724,8 @@ public:
 
         for (Uint32 TypeIdx = 0; TypeIdx < NumAllowedTypes; ++TypeIdx)
         {
+            VERIFY(AllowedVarTypes == nullptr || TypeIdx == 0 || AllowedVarTypes[TypeIdx - 1] < AllowedVarTypes[TypeIdx],
+                   "Allowed variable types must be sorted in increasing order");
             const auto IdxRange = AllowedVarTypes != nullptr ?
                 GetResourceIndexRange(AllowedVarTypes[TypeIdx]) :
                 std::make_pair<Uint32, Uint32>(0, GetTotalResourceCount());
@@ -741,6 +765,7 @@ protected:
         ReserveSpaceForPipelineResourceSignatureDesc(Allocator, Desc);
 
         Allocator.AddSpace<PipelineResourceAttribsType>(Desc.NumResources);
+        Allocator.AddSpace<ResourceNameIndexEntry>(Desc.NumResources);
 
         const auto NumStaticResStages = GetNumStaticResStages();
         if (NumStaticResStages > 0)
@@ -774,6 +799,8 @@ protected:
             AllocResourceAttribs(Allocator) :
             Allocator.Allocate<PipelineResourceAttribsType>(Desc.NumResources);
 
+        InitResourceNameIndex(Allocator);
+
         if (NumStaticResStages > 0)
         {
             m_pStaticResCache = Allocator.Construct<ShaderResourceCacheImplType>(ResourceCacheContentType::Signature);
@@ -931,6 +958,9 @@ protected:
         static_assert(std::is_trivially_destructible<PipelineResourceAttribsType>::value, "Destructors for m_pResourceAttribs[] are required");
         m_pResourceAttribs = nullptr;
 
+        static_assert(std::is_trivially_destructible<ResourceNameIndexEntry>::value, "Destructors for m_pResourceNameIndex[] are required");
+        m_pResourceNameIndex = nullptr;
+
         m_pRawMemory.reset();
 
 #if DILIGENT_DEBUG
@@ -967,6 +997,23 @@ protected:
         return SamplerInd;
     }
 
+    // Builds the resource name index used by FindResource().
+    void InitResourceNameIndex(FixedLinearAllocator& Allocator)
+    {
+        const auto NumResources = this->m_Desc.NumResources;
+
+        m_pResourceNameIndex = Allocator.Allocate<ResourceNameIndexEntry>(NumResources);
+        for (Uint32 r = 0; r < NumResources; ++r)
+        {
+            m_pResourceNameIndex[r].NameHash = CStringHash<Char>{}(this->m_Desc.Resources[r].Name);
+            m_pResourceNameIndex[r].ResIndex = r;
+        }
+        std::sort(m_pResourceNameIndex, m_pResourceNameIndex + NumResources,
+                  [](const ResourceNameIndexEntry& lhs, const ResourceNameIndexEntry& rhs) {
+                      return lhs.NameHash != rhs.NameHash ? lhs.NameHash < rhs.NameHash : lhs.ResIndex < rhs.ResIndex;
+                  });
+    }
+
     void CalculateHash()
     {
         const auto* const pThisImpl = static_cast<const PipelineResourceSignatureImplType*>(this);
@@ -985,6 +1032,14 @@ protected:
     // Pipeline resource attributes
     PipelineResourceAttribsType* m_pResourceAttribs = nullptr; // [m_Desc.NumResources]
 
+    struct ResourceNameIndexEntry
+    {
+        size_t NameHash;
+        Uint32 ResIndex;
+    };
+    // Resource indices sorted by the name hash, shared by all SRBs of this signature
+    ResourceNameIndexEntry* m_pResourceNameIndex = nullptr; // [m_Desc.NumResources]
+
     // Static resource cache for all static resources
     ShaderResourceCacheImplType* m_pStaticResCache = nullptr;
 
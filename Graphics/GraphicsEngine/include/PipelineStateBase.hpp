@@ -31,9 +31,13 @@
 /// Implementation of the Diligent::PipelineStateBase template class
 
 #include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <cstring>
+#include <string>
 #include <vector>
 
 #include "PrivateConstants.h"
@@ -45,6 +49,9 @@
 #include "FixedLinearAllocator.hpp"
 #include "HashUtils.hpp"
 #include "PipelineResourceSignatureBase.hpp"
+#include "PipelineDescInterner.hpp"
+#include "GraphicsTypesX.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -74,6 +81,90 @@ struct PSOCreateInternalInfo
     PSO_CREATE_INTERNAL_FLAGS Flags = PSO_CREATE_INTERNAL_FLAG_NONE;
 };
 
+/// Deep copy of the graphics or compute pipeline state create info.
+
+/// The copy owns all strings and arrays and keeps strong references to all objects
+/// referenced by the original create info, so that it can be used to initialize
+/// the pipeline after the original structure has gone out of scope.
+template <typename PSOCreateInfoType>
+class PSOCreateInfoCopy
+{
+public:
+    explicit PSOCreateInfoCopy(const PSOCreateInfoType& CreateInfo) :
+        m_CreateInfo{CreateInfo},
+        m_Name{CreateInfo.PSODesc.Name != nullptr ? CreateInfo.PSODesc.Name : ""},
+        m_ResourceLayout{CreateInfo.PSODesc.ResourceLayout}
+    {
+        auto& PSODesc          = m_CreateInfo.PSODesc;
+        PSODesc.Name           = m_Name.c_str();
+        PSODesc.ResourceLayout = m_ResourceLayout;
+
+        if (CreateInfo.ppResourceSignatures != nullptr)
+        {
+            m_Signatures.assign(CreateInfo.ppResourceSignatures, CreateInfo.ppResourceSignatures + CreateInfo.ResourceSignaturesCount);
+            for (auto* pSignature : m_Signatures)
+                KeepAlive(pSignature);
+            m_CreateInfo.ppResourceSignatures = m_Signatures.data();
+        }
+
+        KeepAlive(CreateInfo.pPSOCache);
+
+        if (CreateInfo.pInternalData != nullptr)
+        {
+            m_InternalInfo             = *static_cast<const PSOCreateInternalInfo*>(CreateInfo.pInternalData);
+            m_CreateInfo.pInternalData = &m_InternalInfo;
+        }
+
+        CopyPipelineData();
+    }
+
+    // clang-format off
+    PSOCreateInfoCopy           (const PSOCreateInfoCopy&) = delete;
+    PSOCreateInfoCopy           (PSOCreateInfoCopy&&)      = delete;
+    PSOCreateInfoCopy& operator=(const PSOCreateInfoCopy&) = delete;
+    PSOCreateInfoCopy& operator=(PSOCreateInfoCopy&&)      = delete;
+    // clang-format on
+
+    const PSOCreateInfoType& Get() const { return m_CreateInfo; }
+
+private:
+    void CopyPipelineData();
+
+    void KeepAlive(IDeviceObject* pObject)
+    {
+        if (pObject != nullptr)
+            m_Objects.emplace_back(pObject);
+    }
+
+    PSOCreateInfoType m_CreateInfo;
+
+    std::string                               m_Name;
+    PipelineResourceLayoutDescX               m_ResourceLayout;
+    InputLayoutDescX                          m_InputLayout;
+    std::vector<IPipelineResourceSignature*>  m_Signatures;
+    PSOCreateInternalInfo                     m_InternalInfo;
+    std::vector<RefCntAutoPtr<IDeviceObject>> m_Objects;
+};
+
+template <>
+inline void PSOCreateInfoCopy<GraphicsPipelineStateCreateInfo>::CopyPipelineData()
+{
+    auto& GraphicsPipeline = m_CreateInfo.GraphicsPipeline;
+
+    m_InputLayout                = InputLayoutDescX{GraphicsPipeline.InputLayout};
+    GraphicsPipeline.InputLayout = m_InputLayout;
+
+    KeepAlive(GraphicsPipeline.pRenderPass);
+    for (auto* pShader : {m_CreateInfo.pVS, m_CreateInfo.pPS, m_CreateInfo.pDS, m_CreateInfo.pHS, m_CreateInfo.pGS, m_CreateInfo.pAS, m_CreateInfo.pMS})
+        KeepAlive(pShader);
+}
+
+template <>
+inline void PSOCreateInfoCopy<ComputePipelineStateCreateInfo>::CopyPipelineData()
+{
+    KeepAlive(m_CreateInfo.pCS);
+}
+
 template <typename PSOCreateInfoType>
 void ValidatePSOCreateInfo(const IRenderDevice*     pDevice,
                            const PSOCreateInfoType& CreateInfo) noexcept(false);
@@ -257,6 +348,7 @@ public:
     void Destruct()
     {
         VERIFY(!m_IsDestructed, "This object has already been destructed");
+        VERIFY(!m_pAsyncInitializer, "Asynchronous initialization task must be finished by the derived class before releasing its resources");
 
         if (this->m_Desc.IsAnyGraphicsPipeline() && m_pGraphicsPipelineData != nullptr)
         {
@@ -278,6 +370,8 @@ public:
             m_Signatures = nullptr;
         }
 
+        m_pResourceLayout.reset();
+
         if (m_pPipelineDataRawMem)
         {
             GetRawAllocator().Free(m_pPipelineDataRawMem);
@@ -372,6 +466,13 @@ public:
             return;
         }
 
+        if (m_Status.load() != PIPELINE_STATE_STATUS_READY)
+        {
+            LOG_ERROR_MESSAGE("Failed to create shader resource binding for pipeline state '", this->m_Desc.Name,
+                              "': the pipeline is not ready. Use IPipelineState::GetStatus() to check the pipeline status.");
+            return;
+        }
+
         return this->GetResourceSignature(0)->CreateShaderResourceBinding(ppShaderResourceBinding, InitStaticResources);
     }
 
@@ -485,6 +586,15 @@ public:
         return this->GetResourceSignature(0)->CopyStaticResources(pDstSign);
     }
 
+    /// Implementation of IPipelineState::GetStatus().
+    virtual PIPELINE_STATE_STATUS DILIGENT_CALL_TYPE GetStatus(bool WaitForCompletion) override // May be overridden
+    {
+        if (WaitForCompletion && m_pAsyncInitializer)
+            m_pAsyncInitializer->WaitForCompletion();
+
+        return m_Status.load();
+    }
+
     /// Implementation of IPipelineState::GetResourceSignatureCount().
     virtual Uint32 DILIGENT_CALL_TYPE GetResourceSignatureCount() const override final
     {
@@ -539,28 +649,20 @@ protected:
                                      FixedLinearAllocator&                  MemPool) noexcept
     {
         MemPool.AddSpace<GraphicsPipelineData>();
-        ReserveResourceLayout(CreateInfo.PSODesc.ResourceLayout, MemPool);
         ReserveResourceSignatures(CreateInfo, MemPool);
 
+        // Input layout elements are stored in the device-wide interner
         const auto& InputLayout     = CreateInfo.GraphicsPipeline.InputLayout;
         Uint32      BufferSlotsUsed = 0;
-        MemPool.AddSpace<LayoutElement>(InputLayout.NumElements);
         for (Uint32 i = 0; i < InputLayout.NumElements; ++i)
-        {
-            auto& LayoutElem = InputLayout.LayoutElements[i];
-            MemPool.AddSpaceForString(LayoutElem.HLSLSemantic);
-            BufferSlotsUsed = std::max(BufferSlotsUsed, LayoutElem.BufferSlot + 1);
-        }
+            BufferSlotsUsed = std::max(BufferSlotsUsed, InputLayout.LayoutElements[i].BufferSlot + 1);
 
         MemPool.AddSpace<Uint32>(BufferSlotsUsed);
-
-        static_assert(std::is_trivially_destructible<decltype(*InputLayout.LayoutElements)>::value, "Add destructor for this object to Destruct()");
     }
 
     void ReserveSpaceForPipelineDesc(const ComputePipelineStateCreateInfo& CreateInfo,
                                      FixedLinearAllocator&                 MemPool) noexcept
     {
-        ReserveResourceLayout(CreateInfo.PSODesc.ResourceLayout, MemPool);
         ReserveResourceSignatures(CreateInfo, MemPool);
     }
 
@@ -591,7 +693,6 @@ protected:
             MemPool.AddSpaceForString(CreateInfo.pProceduralHitShaders[i].Name);
         }
 
-        ReserveResourceLayout(CreateInfo.PSODesc.ResourceLayout, MemPool);
         ReserveResourceSignatures(CreateInfo, MemPool);
     }
 
@@ -599,7 +700,6 @@ protected:
                                      FixedLinearAllocator&              MemPool) noexcept
     {
         MemPool.AddSpace<TilePipelineData>();
-        ReserveResourceLayout(CreateInfo.PSODesc.ResourceLayout, MemPool);
         ReserveResourceSignatures(CreateInfo, MemPool);
     }
 
@@ -786,7 +886,7 @@ protected:
         GraphicsPipeline = CreateInfo.GraphicsPipeline;
         CorrectGraphicsPipelineDesc(GraphicsPipeline);
 
-        CopyResourceLayout(CreateInfo.PSODesc.ResourceLayout, this->m_Desc.ResourceLayout, MemPool);
+        InternResourceLayout(CreateInfo.PSODesc.ResourceLayout);
         CopyResourceSignatures(CreateInfo, MemPool);
 
         pRenderPass = GraphicsPipeline.pRenderPass;
@@ -818,16 +918,11 @@ protected:
             }
         }
 
-        const auto&    InputLayout     = GraphicsPipeline.InputLayout;
-        LayoutElement* pLayoutElements = MemPool.ConstructArray<LayoutElement>(InputLayout.NumElements);
-        for (size_t Elem = 0; Elem < InputLayout.NumElements; ++Elem)
-        {
-            const auto& SrcElem   = InputLayout.LayoutElements[Elem];
-            pLayoutElements[Elem] = SrcElem;
-            VERIFY_EXPR(SrcElem.HLSLSemantic != nullptr);
-            pLayoutElements[Elem].HLSLSemantic = MemPool.CopyString(SrcElem.HLSLSemantic);
-        }
-        GraphicsPipeline.InputLayout.LayoutElements = pLayoutElements;
+        const auto& InputLayout = GraphicsPipeline.InputLayout;
+        // The elements are corrected in a temporary copy that references the application's strings,
+        // and then interned together with the strings.
+        std::vector<LayoutElement> LayoutElements(InputLayout.LayoutElements, InputLayout.LayoutElements + InputLayout.NumElements);
+        LayoutElement*             pLayoutElements = LayoutElements.data();
 
 
         // Correct description and compute offsets and tight strides
@@ -898,6 +993,19 @@ protected:
                 LayoutElem.Stride = Strides[BuffSlot];
         }
 
+        if (InputLayout.NumElements > 0)
+        {
+            InputLayoutDesc CorrectedLayout{pLayoutElements, InputLayout.NumElements};
+
+            auto& pInternedLayout        = this->m_pGraphicsPipelineData->pInputLayout;
+            pInternedLayout              = this->GetDevice()->GetPipelineDescInterner().Intern(CorrectedLayout);
+            GraphicsPipeline.InputLayout = *pInternedLayout;
+        }
+        else
+        {
+            GraphicsPipeline.InputLayout = InputLayoutDesc{};
+        }
+
         pStrides = MemPool.ConstructArray<Uint32>(BufferSlotsUsed);
 
         // Set strides for all unused slots to 0
@@ -913,7 +1021,7 @@ protected:
     {
         m_pPipelineDataRawMem = MemPool.ReleaseOwnership();
 
-        CopyResourceLayout(CreateInfo.PSODesc.ResourceLayout, this->m_Desc.ResourceLayout, MemPool);
+        InternResourceLayout(CreateInfo.PSODesc.ResourceLayout);
         CopyResourceSignatures(CreateInfo, MemPool);
     }
 
@@ -940,7 +1048,7 @@ protected:
         TNameToGroupIndexMap& NameToGroupIndex = this->m_pRayTracingPipelineData->NameToGroupIndex;
         CopyRTShaderGroupNames(NameToGroupIndex, CreateInfo, MemPool);
 
-        CopyResourceLayout(CreateInfo.PSODesc.ResourceLayout, this->m_Desc.ResourceLayout, MemPool);
+        InternResourceLayout(CreateInfo.PSODesc.ResourceLayout);
         CopyResourceSignatures(CreateInfo, MemPool);
     }
 
@@ -953,7 +1061,7 @@ protected:
 
         this->m_pTilePipelineData->Desc = CreateInfo.TilePipeline;
 
-        CopyResourceLayout(CreateInfo.PSODesc.ResourceLayout, this->m_Desc.ResourceLayout, MemPool);
+        InternResourceLayout(CreateInfo.PSODesc.ResourceLayout);
         CopyResourceSignatures(CreateInfo, MemPool);
     }
 
@@ -1052,71 +1160,37 @@ protected:
     }
 
 private:
-    static void ReserveResourceLayout(const PipelineResourceLayoutDesc& SrcLayout, FixedLinearAllocator& MemPool) noexcept
+    void InternResourceLayout(const PipelineResourceLayoutDesc& SrcLayout)
     {
-        if (SrcLayout.Variables != nullptr)
-        {
-            MemPool.AddSpace<ShaderResourceVariableDesc>(SrcLayout.NumVariables);
-            for (Uint32 i = 0; i < SrcLayout.NumVariables; ++i)
-            {
-                VERIFY(SrcLayout.Variables[i].Name != nullptr, "Variable name can't be null");
-                MemPool.AddSpaceForString(SrcLayout.Variables[i].Name);
-            }
-        }
-
+#ifdef DILIGENT_DEVELOPMENT
         if (SrcLayout.ImmutableSamplers != nullptr)
         {
-            MemPool.AddSpace<ImmutableSamplerDesc>(SrcLayout.NumImmutableSamplers);
             for (Uint32 i = 0; i < SrcLayout.NumImmutableSamplers; ++i)
             {
-                VERIFY(SrcLayout.ImmutableSamplers[i].SamplerOrTextureName != nullptr, "Immutable sampler or texture name can't be null");
-                MemPool.AddSpaceForString(SrcLayout.ImmutableSamplers[i].SamplerOrTextureName);
+                const auto& SrcSmplr    = SrcLayout.ImmutableSamplers[i];
+                const auto& BorderColor = SrcSmplr.Desc.BorderColor;
+                if (!((BorderColor[0] == 0 && BorderColor[1] == 0 && BorderColor[2] == 0 && BorderColor[3] == 0) ||
+                      (BorderColor[0] == 0 && BorderColor[1] == 0 && BorderColor[2] == 0 && BorderColor[3] == 1) ||
+                      (BorderColor[0] == 1 && BorderColor[1] == 1 && BorderColor[2] == 1 && BorderColor[3] == 1)))
+                {
+                    LOG_WARNING_MESSAGE("Immutable sampler for variable \"", SrcSmplr.SamplerOrTextureName, "\" specifies border color (",
+                                        BorderColor[0], ", ", BorderColor[1], ", ", BorderColor[2], ", ", BorderColor[3],
+                                        "). D3D12 static samplers only allow transparent black (0,0,0,0), opaque black (0,0,0,1) or opaque white (1,1,1,1) as border colors");
+                }
             }
         }
+#endif
 
-        static_assert(std::is_trivially_destructible<decltype(*SrcLayout.Variables)>::value, "Add destructor for this object to Destruct()");
-        static_assert(std::is_trivially_destructible<decltype(*SrcLayout.ImmutableSamplers)>::value, "Add destructor for this object to Destruct()");
-    }
-
-    static void CopyResourceLayout(const PipelineResourceLayoutDesc& SrcLayout, PipelineResourceLayoutDesc& DstLayout, FixedLinearAllocator& MemPool)
-    {
-        if (SrcLayout.Variables != nullptr)
+        if (SrcLayout.Variables == nullptr && SrcLayout.ImmutableSamplers == nullptr)
         {
-            auto* const Variables = MemPool.ConstructArray<ShaderResourceVariableDesc>(SrcLayout.NumVariables);
-            DstLayout.Variables   = Variables;
-            for (Uint32 i = 0; i < SrcLayout.NumVariables; ++i)
-            {
-                const auto& SrcVar = SrcLayout.Variables[i];
-                Variables[i]       = SrcVar;
-                Variables[i].Name  = MemPool.CopyString(SrcVar.Name);
-            }
+            // Nothing references the application's memory
+            this->m_Desc.ResourceLayout = SrcLayout;
+            return;
         }
 
-        if (SrcLayout.ImmutableSamplers != nullptr)
-        {
-            auto* const ImmutableSamplers = MemPool.ConstructArray<ImmutableSamplerDesc>(SrcLayout.NumImmutableSamplers);
-            DstLayout.ImmutableSamplers   = ImmutableSamplers;
-            for (Uint32 i = 0; i < SrcLayout.NumImmutableSamplers; ++i)
-            {
-                const auto& SrcSmplr = SrcLayout.ImmutableSamplers[i];
-#ifdef DILIGENT_DEVELOPMENT
-                {
-                    const auto& BorderColor = SrcSmplr.Desc.BorderColor;
-                    if (!((BorderColor[0] == 0 && BorderColor[1] == 0 && BorderColor[2] == 0 && BorderColor[3] == 0) ||
-                          (BorderColor[0] == 0 && BorderColor[1] == 0 && BorderColor[2] == 0 && BorderColor[3] == 1) ||
-                          (BorderColor[0] == 1 && BorderColor[1] == 1 && BorderColor[2] == 1 && BorderColor[3] == 1)))
-                    {
-                        LOG_WARNING_MESSAGE("Immutable sampler for variable \"", SrcSmplr.SamplerOrTextureName, "\" specifies border color (",
-                                            BorderColor[0], ", ", BorderColor[1], ", ", BorderColor[2], ", ", BorderColor[3],
-                                            "). D3D12 static samplers only allow transparent black (0,0,0,0), opaque black (0,0,0,1) or opaque white (1,1,1,1) as border colors");
-                    }
-                }
-#endif
-
-                ImmutableSamplers[i]                      = SrcSmplr;
-                ImmutableSamplers[i].SamplerOrTextureName = MemPool.CopyString(SrcSmplr.SamplerOrTextureName);
-            }
-        }
+        // Pipelines that use the same layout share one copy of it
+        m_pResourceLayout           = this->GetDevice()->GetPipelineDescInterner().Intern(SrcLayout);
+        this->m_Desc.ResourceLayout = *m_pResourceLayout;
     }
 
     void ReserveResourceSignatures(const PipelineStateCreateInfo& CreateInfo, FixedLinearAllocator& MemPool)
@@ -1186,6 +1260,101 @@ private:
         }
     }
 
+protected:
+    /// Function that finishes the compilation of a pipeline that was not found in the cache, see InitializePipeline().
+    using CompilePipelineFuncType = std::function<void()>;
+
+    /// Initializes the pipeline by calling InitPipeline either immediately or, if CreateInfo.Flags
+    /// contains PSO_CREATE_FLAG_ASYNCHRONOUS or PSO_CREATE_FLAG_ASYNCHRONOUS_ON_CACHE_MISS and the
+    /// device has a shader compilation thread pool, in the thread pool.
+
+    /// InitPipeline(const PSOCreateInfoType& CI, bool CacheOnly) must return CompilePipelineFuncType.
+    /// When CacheOnly is false, it fully initializes the pipeline and returns an empty function.
+    /// When CacheOnly is true (PSO_CREATE_FLAG_ASYNCHRONOUS_ON_CACHE_MISS flag), it only creates the pipeline
+    /// if this does not require compilation, and otherwise returns the function that compiles the pipeline,
+    /// which is then executed in the thread pool.
+    ///
+    /// \remarks   In synchronous mode, exceptions thrown by InitPipeline are propagated to the caller.
+    ///            In asynchronous mode, InitPipeline receives a deep copy of the create info, and an
+    ///            exception moves the pipeline to PIPELINE_STATE_STATUS_FAILED state. The derived class
+    ///            must call CancelOrWaitAsyncInitialization() before releasing its resources.
+    template <typename PSOCreateInfoType, typename InitPipelineFuncType>
+    void InitializePipeline(const PSOCreateInfoType& CreateInfo, InitPipelineFuncType InitPipeline)
+    {
+        auto* pThreadPool = (CreateInfo.Flags & (PSO_CREATE_FLAG_ASYNCHRONOUS | PSO_CREATE_FLAG_ASYNCHRONOUS_ON_CACHE_MISS)) != 0 ?
+            this->GetDevice()->GetShaderCompilationThreadPool() :
+            nullptr;
+        if (pThreadPool == nullptr)
+        {
+            const auto CompilePipeline = InitPipeline(CreateInfo, false /*CacheOnly*/);
+            VERIFY(!CompilePipeline, "The pipeline must be fully initialized when CacheOnly is false");
+            return;
+        }
+
+        auto pCreateInfoCopy = std::make_unique<PSOCreateInfoCopy<PSOCreateInfoType>>(CreateInfo);
+        // The resource layout will be copied when the pipeline description is initialized.
+        // Until then, make it reference the data owned by the copy rather than by the application.
+        this->m_Desc.ResourceLayout = pCreateInfoCopy->Get().PSODesc.ResourceLayout;
+
+        if ((CreateInfo.Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) == 0)
+        {
+            // Try to create the pipeline from the cache. Exceptions are propagated to the caller.
+            auto CompilePipeline = InitPipeline(pCreateInfoCopy->Get(), true /*CacheOnly*/);
+            if (!CompilePipeline)
+                return;
+
+            // The function may reference the shaders and other objects that are kept alive by the copy.
+            m_Status.store(PIPELINE_STATE_STATUS_COMPILING);
+            m_pAsyncInitializer = EnqueueAsyncWork(
+                pThreadPool,
+                [this, CompilePipeline = std::move(CompilePipeline), pCreateInfoCopy = std::move(pCreateInfoCopy)](Uint32 /*ThreadId*/) //
+                {
+                    try
+                    {
+                        CompilePipeline();
+                        m_Status.store(PIPELINE_STATE_STATUS_READY);
+                    }
+                    catch (...)
+                    {
+                        LOG_ERROR_MESSAGE("Failed to asynchronously compile pipeline state '", this->m_Desc.Name, "'.");
+                        m_Status.store(PIPELINE_STATE_STATUS_FAILED);
+                    }
+                });
+            return;
+        }
+
+        m_Status.store(PIPELINE_STATE_STATUS_COMPILING);
+        m_pAsyncInitializer = EnqueueAsyncWork(
+            pThreadPool,
+            [this, InitPipeline, pCreateInfoCopy = std::move(pCreateInfoCopy)](Uint32 /*ThreadId*/) //
+            {
+                try
+                {
+                    const auto CompilePipeline = InitPipeline(pCreateInfoCopy->Get(), false /*CacheOnly*/);
+                    VERIFY(!CompilePipeline, "The pipeline must be fully initialized when CacheOnly is false");
+                    m_Status.store(PIPELINE_STATE_STATUS_READY);
+                }
+                catch (...)
+                {
+                    LOG_ERROR_MESSAGE("Failed to asynchronously initialize pipeline state '", this->m_Desc.Name, "'.");
+                    m_Status.store(PIPELINE_STATE_STATUS_FAILED);
+                }
+            });
+    }
+
+    /// Removes the asynchronous initialization task from the thread pool if it has not started yet,
+    /// or waits until it is finished otherwise.
+    void CancelOrWaitAsyncInitialization()
+    {
+        if (!m_pAsyncInitializer)
+            return;
+
+        if (!this->GetDevice()->GetShaderCompilationThreadPool()->RemoveTask(m_pAsyncInitializer, false /*CancelIfRunning*/))
+            m_pAsyncInitializer->WaitForCompletion();
+
+        m_pAsyncInitializer.Release();
+    }
+
 protected:
     /// Shader stages that are active in this PSO.
     SHADER_TYPE m_ActiveShaderStages = SHADER_TYPE_UNKNOWN;
@@ -1203,12 +1372,19 @@ protected:
     using SignatureAutoPtrType         = RefCntAutoPtr<PipelineResourceSignatureImplType>;
     SignatureAutoPtrType* m_Signatures = nullptr; // [m_SignatureCount]
 
+    /// Interned resource layout referenced by m_Desc.ResourceLayout, see PipelineDescInterner.
+    /// Null if the layout has no variables and no immutable samplers.
+    PipelineDescInterner::InternedPtr<PipelineResourceLayoutDesc> m_pResourceLayout;
+
     struct GraphicsPipelineData
     {
         GraphicsPipelineDesc Desc;
 
         RefCntAutoPtr<IRenderPass> pRenderPass; ///< Strong reference to the render pass object
 
+        /// Interned input layout referenced by Desc.InputLayout
+        PipelineDescInterner::InternedPtr<InputLayoutDesc> pInputLayout;
+
         Uint32* pStrides        = nullptr;
         Uint8   BufferSlotsUsed = 0;
     };
@@ -1246,6 +1422,14 @@ protected:
         void*                   m_pPipelineDataRawMem = nullptr;
     };
 
+    /// Pipeline state status. Pipelines that are initialized synchronously are ready
+    /// as soon as the constructor returns; asynchronous initialization changes the
+    /// status to PIPELINE_STATE_STATUS_COMPILING until the task is finished.
+    std::atomic<PIPELINE_STATE_STATUS> m_Status{PIPELINE_STATE_STATUS_READY};
+
+    /// Asynchronous initialization task, see InitializePipeline().
+    RefCntAutoPtr<IAsyncTask> m_pAsyncInitializer;
+
 #ifdef DILIGENT_DEBUG
     bool m_IsDestructed = false;
 #endif
@@ -0,0 +1,171 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of the Diligent::QueryArrayBase template class
+
+#include <vector>
+
+#include "Query.h"
+#include "DeviceObjectBase.hpp"
+#include "GraphicsTypes.h"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+/// Template class implementing base functionality of the query array object
+
+/// \tparam EngineImplTraits - Engine implementation type traits.
+template <typename EngineImplTraits>
+class QueryArrayBase : public DeviceObjectBase<typename EngineImplTraits::QueryArrayInterface, typename EngineImplTraits::RenderDeviceImplType, QueryArrayDesc>
+{
+public:
+    // Base interface this class inherits (IQueryArray).
+    using BaseInterface = typename EngineImplTraits::QueryArrayInterface;
+
+    // Render device implementation type (RenderDeviceD3D12Impl, RenderDeviceVkImpl, etc.).
+    using RenderDeviceImplType = typename EngineImplTraits::RenderDeviceImplType;
+
+    using TDeviceObjectBase = DeviceObjectBase<BaseInterface, RenderDeviceImplType, QueryArrayDesc>;
+
+    /// \param pRefCounters - Reference counters object that controls the lifetime of this query array.
+    /// \param pDevice      - Pointer to the device.
+    /// \param Desc         - Query array description.
+    QueryArrayBase(IReferenceCounters*   pRefCounters,
+                   RenderDeviceImplType* pDevice,
+                   const QueryArrayDesc& Desc) :
+        TDeviceObjectBase{pRefCounters, pDevice, Desc}
+    {
+        const auto& deviceFeatures = this->GetDevice()->GetFeatures();
+        static_assert(QUERY_TYPE_NUM_TYPES == 6, "Not all QUERY_TYPE enum values are handled below");
+        switch (Desc.Type)
+        {
+            case QUERY_TYPE_OCCLUSION:
+                if (!deviceFeatures.OcclusionQueries)
+                    LOG_ERROR_AND_THROW("Occlusion queries are not supported by this device");
+                break;
+
+            case QUERY_TYPE_BINARY_OCCLUSION:
+                if (!deviceFeatures.BinaryOcclusionQueries)
+                    LOG_ERROR_AND_THROW("Binary occlusion queries are not supported by this device");
+                break;
+
+            case QUERY_TYPE_TIMESTAMP:
+                if (!deviceFeatures.TimestampQueries)
+                    LOG_ERROR_AND_THROW("Timestamp queries are not supported by this device");
+                break;
+
+            case QUERY_TYPE_PIPELINE_STATISTICS:
+                if (!deviceFeatures.PipelineStatisticsQueries)
+                    LOG_ERROR_AND_THROW("Pipeline statistics queries are not supported by this device");
+                break;
+
+            case QUERY_TYPE_DURATION:
+                LOG_ERROR_AND_THROW("Duration queries can't be used in query arrays. Use a pair of timestamp queries instead.");
+                break;
+
+            default:
+                LOG_ERROR_AND_THROW("Query array '", (this->m_Desc.Name ? this->m_Desc.Name : ""), "' has undefined or unexpected query type");
+        }
+
+        if (Desc.Size == 0)
+            LOG_ERROR_AND_THROW("Query array '", (this->m_Desc.Name ? this->m_Desc.Name : ""), "' must contain at least one query");
+
+#ifdef DILIGENT_DEVELOPMENT
+        m_DvpStates.resize(Desc.Size, QueryState::Inactive);
+#endif
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_QueryArray, TDeviceObjectBase)
+
+    // Validates IDeviceContext::BeginIndexedQuery()
+    void DvpOnBeginQuery(Uint32 Index)
+    {
+#ifdef DILIGENT_DEVELOPMENT
+        DEV_CHECK_ERR(m_DvpStates[Index] != QueryState::Querying,
+                      "Attempting to begin query ", Index, " of query array '", this->m_Desc.Name,
+                      "' twice. A query must be ended before it can be begun again.");
+        DEV_CHECK_ERR(m_DvpStates[Index] != QueryState::Ended,
+                      "Query ", Index, " of query array '", this->m_Desc.Name,
+                      "' has been ended, but its result has not been resolved. Call ResolveQueryArray() before beginning the query again.");
+        m_DvpStates[Index] = QueryState::Querying;
+#endif
+    }
+
+    // Validates IDeviceContext::EndIndexedQuery()
+    void DvpOnEndQuery(Uint32 Index)
+    {
+#ifdef DILIGENT_DEVELOPMENT
+        if (this->m_Desc.Type != QUERY_TYPE_TIMESTAMP)
+        {
+            DEV_CHECK_ERR(m_DvpStates[Index] == QueryState::Querying,
+                          "Attempting to end query ", Index, " of query array '", this->m_Desc.Name, "' that has not been begun.");
+        }
+        else
+        {
+            DEV_CHECK_ERR(m_DvpStates[Index] != QueryState::Ended,
+                          "Timestamp query ", Index, " of query array '", this->m_Desc.Name,
+                          "' has been ended, but its result has not been resolved. Call ResolveQueryArray() before ending the query again.");
+        }
+        m_DvpStates[Index] = QueryState::Ended;
+#endif
+    }
+
+    // Validates IDeviceContext::ResolveQueryArray()
+    void DvpOnResolve(Uint32 FirstQuery, Uint32 NumQueries)
+    {
+#ifdef DILIGENT_DEVELOPMENT
+        for (Uint32 i = FirstQuery; i < FirstQuery + NumQueries; ++i)
+        {
+            if (m_DvpStates[i] != QueryState::Ended)
+            {
+                LOG_ERROR_MESSAGE("Query ", i, " of query array '", this->m_Desc.Name,
+                                  "' is resolved, but has not been ended. All queries in the resolved range must be ended.");
+                break;
+            }
+        }
+        for (Uint32 i = FirstQuery; i < FirstQuery + NumQueries; ++i)
+            m_DvpStates[i] = QueryState::Inactive;
+#endif
+    }
+
+protected:
+#ifdef DILIGENT_DEVELOPMENT
+    enum class QueryState : Uint8
+    {
+        Inactive,
+        Querying,
+        Ended
+    };
+    std::vector<QueryState> m_DvpStates;
+#endif
+};
+
+} // namespace Diligent
@@ -30,11 +30,18 @@
 /// \file
 /// Implementation of the Diligent::RenderDeviceBase template class and related structures
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
 #include "RenderDevice.h"
 #include "DeviceObjectBase.hpp"
 #include "Defines.h"
 #include "ResourceMappingImpl.hpp"
 #include "StateObjectsRegistry.hpp"
+#include "PipelineDescInterner.hpp"
 #include "HashUtils.hpp"
 #include "ObjectBase.hpp"
 #include "DeviceContext.h"
@@ -44,6 +51,9 @@
 #include "EngineMemory.h"
 #include "STDAllocator.hpp"
 #include "IndexWrapper.hpp"
+#include "ThreadPool.hpp"
+#include "StartupProfiler.hpp"
+#include "CPUProfiler.hpp"
 
 namespace Diligent
 {
@@ -117,6 +127,8 @@ public:
     ///
     /// \remarks Render device uses fixed block allocators (see FixedBlockMemoryAllocator) to allocate memory for
     ///          device objects. The object sizes from EngineImplTraits are used to initialize the allocators.
+    ///          Allocators for the objects that are frequently created and released from multiple threads
+    ///          (texture views, buffer views and shader resource bindings) use thread caching mode.
     RenderDeviceBase(IReferenceCounters*        pRefCounters,
                      IMemoryAllocator&          RawMemAllocator,
                      IEngineFactory*            pEngineFactory,
@@ -126,21 +138,27 @@ public:
         TObjectBase              {pRefCounters},
         m_pEngineFactory         {pEngineFactory},
         m_ValidationFlags        {EngineCI.ValidationFlags},
+        m_InstrumentationSink    {EngineCI.InstrumentationSink},
+        m_StartupProfilingFrames {EngineCI.StartupProfiling.NumFrames},
+        m_StartupProfilingEnabled{EngineCI.StartupProfiling.Enable != False},
+        m_StartupProfilingJSONPath{EngineCI.StartupProfiling.Enable && EngineCI.StartupProfiling.JSONFilePath != nullptr ? EngineCI.StartupProfiling.JSONFilePath : ""},
+        m_MemoryPressureThreshold{EngineCI.MemoryPressureThreshold},
         m_AdapterInfo            {AdapterInfo},
         m_SamplersRegistry       {RawMemAllocator, "sampler"},
+        m_PipelineDescInterner   {RawMemAllocator},
         m_TextureFormatsInfo     (TEX_FORMAT_NUM_FORMATS, TextureFormatInfoExt(), STD_ALLOCATOR_RAW_MEM(TextureFormatInfoExt, RawMemAllocator, "Allocator for vector<TextureFormatInfoExt>")),
         m_TexFmtInfoInitFlags    (TEX_FORMAT_NUM_FORMATS, false, STD_ALLOCATOR_RAW_MEM(bool, RawMemAllocator, "Allocator for vector<bool>")),
         m_wpImmediateContexts    (std::max(1u, EngineCI.NumImmediateContexts), RefCntWeakPtr<DeviceContextImplType>(), STD_ALLOCATOR_RAW_MEM(RefCntWeakPtr<DeviceContextImplType>, RawMemAllocator, "Allocator for vector<RefCntWeakPtr<DeviceContextImplType>>")),
         m_wpDeferredContexts     (EngineCI.NumDeferredContexts, RefCntWeakPtr<DeviceContextImplType>(), STD_ALLOCATOR_RAW_MEM(RefCntWeakPtr<DeviceContextImplType>, RawMemAllocator, "Allocator for vector<RefCntWeakPtr<DeviceContextImplType>>")),
         m_RawMemAllocator        {RawMemAllocator},
         m_TexObjAllocator        {RawMemAllocator, sizeof(TextureImplType),                    64},
-        m_TexViewObjAllocator    {RawMemAllocator, sizeof(TextureViewImplType),                64},
+        m_TexViewObjAllocator    {RawMemAllocator, sizeof(TextureViewImplType),                64, true},
         m_BufObjAllocator        {RawMemAllocator, sizeof(BufferImplType),                    128},
-        m_BuffViewObjAllocator   {RawMemAllocator, sizeof(BufferViewImplType),                128},
+        m_BuffViewObjAllocator   {RawMemAllocator, sizeof(BufferViewImplType),                128, true},
         m_ShaderObjAllocator     {RawMemAllocator, sizeof(ShaderImplType),                     32},
         m_SamplerObjAllocator    {RawMemAllocator, sizeof(SamplerImplType),                    32},
         m_PSOAllocator           {RawMemAllocator, sizeof(PipelineStateImplType),             128},
-        m_SRBAllocator           {RawMemAllocator, sizeof(ShaderResourceBindingImplType),    1024},
+        m_SRBAllocator           {RawMemAllocator, sizeof(ShaderResourceBindingImplType),    1024, true},
         m_ResMappingAllocator    {RawMemAllocator, sizeof(ResourceMappingImpl),                16},
         m_FenceAllocator         {RawMemAllocator, sizeof(FenceImplType),                      16},
         m_QueryAllocator         {RawMemAllocator, sizeof(QueryImplType),                      16},
@@ -201,10 +219,22 @@ public:
                 TEX_FORMAT_B5G6R5_UNORM};
         for (Uint32 fmt = 0; fmt < _countof(FilterableFormats); ++fmt)
             m_TextureFormatsInfo[FilterableFormats[fmt]].Filterable = true;
+
+        if (EngineCI.pAsyncShaderCompilationThreadPool != nullptr)
+        {
+            m_pShaderCompilationThreadPool = EngineCI.pAsyncShaderCompilationThreadPool;
+        }
+        else if (EngineCI.NumAsyncShaderCompilationThreads > 0)
+        {
+            ThreadPoolCreateInfo PoolCI;
+            PoolCI.NumThreads              = EngineCI.NumAsyncShaderCompilationThreads;
+            m_pShaderCompilationThreadPool = CreateThreadPool(PoolCI);
+        }
     }
 
     ~RenderDeviceBase()
     {
+        FinishStartupProfiling();
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_RenderDevice, ObjectBase<BaseInterface>)
@@ -284,8 +314,94 @@ public:
         UNSUPPORTED("Tile pipeline is not supported by this device. Please check DeviceFeatures.TileShaders feature.");
     }
 
+    /// Base implementation of IRenderDevice::GetMemoryBudget() for devices that can't query the budget.
+    virtual DeviceMemoryBudget DILIGENT_CALL_TYPE GetMemoryBudget() const override
+    {
+        return {};
+    }
+
+    /// Base implementation of IRenderDevice::GetTextureMemoryRequirements() for devices that don't support placed resources.
+    virtual ResourceMemoryRequirements DILIGENT_CALL_TYPE GetTextureMemoryRequirements(const TextureDesc& TexDesc) const override
+    {
+        return {};
+    }
+
+    /// Base implementation of IRenderDevice::GetBufferMemoryRequirements() for devices that don't support placed resources.
+    virtual ResourceMemoryRequirements DILIGENT_CALL_TYPE GetBufferMemoryRequirements(const BufferDesc& BuffDesc) const override
+    {
+        return {};
+    }
+
+    /// Implementation of IRenderDevice::AddMemoryPressureCallback().
+    virtual void DILIGENT_CALL_TYPE AddMemoryPressureCallback(MemoryPressureCallbackType Callback,
+                                                              void*                      pUserData) override final
+    {
+        DEV_CHECK_ERR(Callback != nullptr, "Memory pressure callback must not be null");
+        if (Callback == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> Lock{m_MemoryPressureCallbacksMtx};
+
+        const MemoryPressureCallbackInfo CallbackInfo{Callback, pUserData};
+        if (std::find(m_MemoryPressureCallbacks.begin(), m_MemoryPressureCallbacks.end(), CallbackInfo) != m_MemoryPressureCallbacks.end())
+        {
+            DEV_ERROR("This memory pressure callback has already been registered");
+            return;
+        }
+        m_MemoryPressureCallbacks.push_back(CallbackInfo);
+    }
+
+    /// Implementation of IRenderDevice::RemoveMemoryPressureCallback().
+    virtual void DILIGENT_CALL_TYPE RemoveMemoryPressureCallback(MemoryPressureCallbackType Callback,
+                                                                 void*                      pUserData) override final
+    {
+        std::lock_guard<std::mutex> Lock{m_MemoryPressureCallbacksMtx};
+
+        auto it = std::find(m_MemoryPressureCallbacks.begin(), m_MemoryPressureCallbacks.end(), MemoryPressureCallbackInfo{Callback, pUserData});
+        if (it == m_MemoryPressureCallbacks.end())
+        {
+            DEV_ERROR("This memory pressure callback has not been registered");
+            return;
+        }
+        m_MemoryPressureCallbacks.erase(it);
+    }
+
+    /// Returns the memory pressure threshold, see EngineCreateInfo::MemoryPressureThreshold.
+    float GetMemoryPressureThreshold() const { return m_MemoryPressureThreshold; }
+
+    /// Queries the memory budget and invokes the memory pressure callbacks if the usage of
+    /// any memory segment exceeds the threshold, see EngineCreateInfo::MemoryPressureThreshold.
+    /// Called by the first immediate context when it finishes a frame.
+    void CheckMemoryPressure()
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_MemoryPressureCallbacksMtx};
+            if (m_MemoryPressureCallbacks.empty())
+                return;
+        }
+
+        const DeviceMemoryBudget Budget = GetMemoryBudget();
+
+        const auto IsUnderPressure = [this](const MemoryHeapBudget& Heap) {
+            return Heap.Budget != 0 && static_cast<double>(Heap.Usage) > static_cast<double>(Heap.Budget) * m_MemoryPressureThreshold;
+        };
+        if (!IsUnderPressure(Budget.Local) && !IsUnderPressure(Budget.NonLocal))
+            return;
+
+        // Callbacks are invoked outside of the lock so that they may unregister themselves
+        std::vector<MemoryPressureCallbackInfo> Callbacks;
+        {
+            std::lock_guard<std::mutex> Lock{m_MemoryPressureCallbacksMtx};
+            Callbacks = m_MemoryPressureCallbacks;
+        }
+        for (const auto& Callback : Callbacks)
+            Callback.first(&Budget, Callback.second);
+    }
+
     StateObjectsRegistry<SamplerDesc>& GetSamplerRegistry() { return m_SamplersRegistry; }
 
+    PipelineDescInterner& GetPipelineDescInterner() { return m_PipelineDescInterner; }
+
     /// Set weak reference to the immediate context
     void SetImmediateContext(size_t Ctx, DeviceContextImplType* pImmediateContext)
     {
@@ -321,6 +437,42 @@ public:
 
     VALIDATION_FLAGS GetValidationFlags() const { return m_ValidationFlags; }
 
+    /// Returns the sink for the device context CPU instrumentation events, see EngineCreateInfo::InstrumentationSink.
+    const InstrumentationSinkDesc& GetInstrumentationSink() const { return m_InstrumentationSink; }
+
+    /// Returns the number of frames after which the startup profiling stops, see StartupProfilingDesc::NumFrames.
+    Uint32 GetStartupProfilingFrames() const { return m_StartupProfilingEnabled ? m_StartupProfilingFrames : 0; }
+
+    /// If the startup profiling was requested by EngineCreateInfo::StartupProfiling, stops the
+    /// recording and writes the timeline to the log and to the JSON file.
+    /// Does nothing if called again or if the recording has been stopped by another device.
+    void FinishStartupProfiling()
+    {
+        if (!m_StartupProfilingEnabled)
+            return;
+        m_StartupProfilingEnabled = false;
+
+        StartupTimeline Timeline;
+        if (!StartupProfiler::Stop(Timeline))
+            return;
+
+        LOG_INFO_MESSAGE("Engine startup timeline:\n", Timeline.GetReport());
+        if (!m_StartupProfilingJSONPath.empty() && Timeline.WriteJSON(m_StartupProfilingJSONPath.c_str()))
+            LOG_INFO_MESSAGE("Engine startup timeline is written to ", m_StartupProfilingJSONPath);
+    }
+
+    /// Returns the thread pool that is used to asynchronously initialize pipeline states,
+    /// or null if asynchronous initialization is disabled.
+    IThreadPool* GetShaderCompilationThreadPool() const { return m_pShaderCompilationThreadPool.RawPtr<IThreadPool>(); }
+
+    /// Returns the resource state epoch. The epoch is incremented every time the state of
+    /// a texture, buffer or top-level AS created by the device changes, so if it is the same,
+    /// no resource has changed its state in the meantime.
+    Uint32 GetResourceStateEpoch() const { return m_ResourceStateEpoch.load(std::memory_order_relaxed); }
+
+    /// Called by device objects when their resource state changes.
+    void OnResourceStateChanged() { m_ResourceStateEpoch.fetch_add(1, std::memory_order_relaxed); }
+
     // Convenience function
     const DeviceFeatures& GetFeatures() const
     {
@@ -363,6 +515,8 @@ protected:
 
         try
         {
+            StartupProfiler::Scope ProfilerScope{ObjectTypeName, Desc.Name};
+            DILIGENT_PROFILE_SCOPE(ObjectTypeName);
             ConstructObject();
         }
         catch (...)
@@ -437,12 +591,13 @@ protected:
         CreateDeviceObject("Sampler", SamplerDesc, ppSampler,
                            [&]() //
                            {
-                               m_SamplersRegistry.Find(SamplerDesc, reinterpret_cast<IDeviceObject**>(ppSampler));
+                               const auto DescHash = m_SamplersRegistry.ComputeDescHash(SamplerDesc);
+                               m_SamplersRegistry.Find(SamplerDesc, DescHash, reinterpret_cast<IDeviceObject**>(ppSampler));
                                if (*ppSampler == nullptr)
                                {
                                    auto* pSamplerImpl = NEW_RC_OBJ(m_SamplerObjAllocator, "Sampler instance", SamplerImplType)(static_cast<RenderDeviceImplType*>(this), SamplerDesc, ExtraArgs...);
                                    pSamplerImpl->QueryInterface(IID_Sampler, reinterpret_cast<IObject**>(ppSampler));
-                                   m_SamplersRegistry.Add(SamplerDesc, *ppSampler);
+                                   m_SamplersRegistry.Add(SamplerDesc, DescHash, *ppSampler);
                                }
                            });
     }
@@ -557,14 +712,28 @@ protected:
 protected:
     RefCntAutoPtr<IEngineFactory> m_pEngineFactory;
 
-    const VALIDATION_FLAGS m_ValidationFlags;
-    GraphicsAdapterInfo    m_AdapterInfo;
-    RenderDeviceInfo       m_DeviceInfo;
+    const VALIDATION_FLAGS        m_ValidationFlags;
+    const InstrumentationSinkDesc m_InstrumentationSink;
+
+    const Uint32      m_StartupProfilingFrames;
+    bool              m_StartupProfilingEnabled;
+    const std::string m_StartupProfilingJSONPath;
+
+    const float m_MemoryPressureThreshold;
+
+    using MemoryPressureCallbackInfo = std::pair<MemoryPressureCallbackType, void*>;
+
+    std::mutex                              m_MemoryPressureCallbacksMtx;
+    std::vector<MemoryPressureCallbackInfo> m_MemoryPressureCallbacks;
+
+    GraphicsAdapterInfo m_AdapterInfo;
+    RenderDeviceInfo    m_DeviceInfo;
 
     // All state object registries hold raw pointers.
     // This is safe because every object unregisters itself
     // when it is deleted.
-    StateObjectsRegistry<SamplerDesc>                                           m_SamplersRegistry; ///< Sampler state registry
+    StateObjectsRegistry<SamplerDesc>                                           m_SamplersRegistry;     ///< Sampler state registry
+    PipelineDescInterner                                                        m_PipelineDescInterner; ///< Resource and input layouts shared by pipeline states
     std::vector<TextureFormatInfoExt, STDAllocatorRawMem<TextureFormatInfoExt>> m_TextureFormatsInfo;
     std::vector<bool, STDAllocatorRawMem<bool>>                                 m_TexFmtInfoInitFlags;
 
@@ -595,6 +764,14 @@ protected:
     FixedBlockMemoryAllocator m_PipeResSignAllocator; ///< Allocator for pipeline resource signature objects
     FixedBlockMemoryAllocator m_MemObjAllocator;      ///< Allocator for device memory objects
     FixedBlockMemoryAllocator m_PSOCacheAllocator;    ///< Allocator for pipeline state cache objects
+
+    /// Thread pool that initializes pipeline states created with PSO_CREATE_FLAG_ASYNCHRONOUS or
+    /// PSO_CREATE_FLAG_ASYNCHRONOUS_ON_CACHE_MISS flag.
+    /// Every pipeline state keeps a strong reference to the device, so the pool outlives all
+    /// pipelines that may have pending initialization tasks.
+    RefCntAutoPtr<IThreadPool> m_pShaderCompilationThreadPool;
+
+    std::atomic<Uint32> m_ResourceStateEpoch{0};
 };
 
 } // namespace Diligent
@@ -31,6 +31,7 @@
 /// Declaration of the Diligent::ResourceMappingImpl class
 
 #include <unordered_map>
+#include <atomic>
 
 #include "ResourceMapping.h"
 #include "ObjectBase.hpp"
@@ -82,6 +83,21 @@ public:
     /// Returns number of resources in the resource mapping.
     virtual size_t DILIGENT_CALL_TYPE GetSize() override final;
 
+    /// Implementation of IResourceMapping::GetResourceArray()
+    virtual Uint32 DILIGENT_CALL_TYPE GetResourceArray(const Char*     Name,
+                                                       Uint32          StartIndex,
+                                                       Uint32          NumElements,
+                                                       IDeviceObject** ppObjects) override final;
+
+    /// Implementation of IResourceMapping::Seal()
+    virtual void DILIGENT_CALL_TYPE Seal() override final;
+
+    /// Implementation of IResourceMapping::IsSealed()
+    virtual Bool DILIGENT_CALL_TYPE IsSealed() const override final
+    {
+        return m_IsSealed.load(std::memory_order_acquire);
+    }
+
 private:
     struct ResMappingHashKey : public HashMapStringKey
     {
@@ -94,6 +110,15 @@ private:
             Ownership_Hash = (ComputeHash(GetHash(), ArrInd) & HashMask) | (Ownership_Hash & StrOwnershipMask);
         }
 
+        // Creates a key that does not own the string, using the string hash
+        // precomputed by HashMapStringKey, so that the string is not hashed again.
+        ResMappingHashKey(const Char* _Str, size_t StrHash, Uint32 ArrInd) noexcept :
+            ArrayIndex{ArrInd}
+        {
+            Str            = _Str;
+            Ownership_Hash = ComputeHash(StrHash, ArrInd) & HashMask;
+        }
+
         ResMappingHashKey(ResMappingHashKey&& rhs) noexcept :
             HashMapStringKey{std::move(rhs)},
             ArrayIndex{rhs.ArrayIndex}
@@ -124,6 +149,9 @@ private:
 
     Threading::SpinLock m_Lock;
 
+    // Sealed mapping can't be modified, so it is read without locking
+    std::atomic<bool> m_IsSealed{false};
+
     using HashTableElem = std::pair<const ResMappingHashKey, RefCntAutoPtr<IDeviceObject>>;
     std::unordered_map<ResMappingHashKey,
                        RefCntAutoPtr<IDeviceObject>,
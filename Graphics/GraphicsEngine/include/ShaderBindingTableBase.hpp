@@ -108,8 +108,12 @@ public:
         this->m_MissShadersRecord.clear();
         this->m_CallableShadersRecord.clear();
         this->m_HitGroupsRecord.clear();
-        this->m_Changed = true;
-        this->m_pPSO    = nullptr;
+        this->m_RayGenDirtyRange   = {};
+        this->m_MissDirtyRange     = {};
+        this->m_CallableDirtyRange = {};
+        this->m_HitGroupDirtyRange = {};
+        this->m_Changed            = true;
+        this->m_pPSO               = nullptr;
 
         this->m_Desc.pPSO = pPSO;
 
@@ -135,7 +139,8 @@ public:
         this->m_DbgHitGroupBindings.clear();
 #endif
         this->m_HitGroupsRecord.clear();
-        this->m_Changed = true;
+        this->m_HitGroupDirtyRange = {};
+        this->m_Changed            = true;
     }
 
 
@@ -149,7 +154,7 @@ public:
 
         const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
         std::memcpy(this->m_RayGenShaderRecord.data() + GroupSize, pData, DataSize);
-        this->m_Changed = true;
+        this->MarkDirty(this->m_RayGenDirtyRange, 0, this->m_ShaderRecordStride);
     }
 
 
@@ -161,11 +166,13 @@ public:
         const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
         const size_t Stride    = this->m_ShaderRecordStride;
         const size_t Offset    = MissIndex * Stride;
-        this->m_MissShadersRecord.resize(std::max(this->m_MissShadersRecord.size(), Offset + Stride), Uint8{EmptyElem});
+        const size_t OldSize   = this->m_MissShadersRecord.size();
+        this->m_MissShadersRecord.resize(std::max(OldSize, Offset + Stride), Uint8{EmptyElem});
 
         this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_MissShadersRecord.data() + Offset, Stride);
         std::memcpy(this->m_MissShadersRecord.data() + Offset + GroupSize, pData, DataSize);
-        this->m_Changed = true;
+        // Records between the old end and the new one are filled with empty elements and must be uploaded as well
+        this->MarkDirty(this->m_MissDirtyRange, std::min(OldSize, Offset), Offset + Stride);
     }
 
 
@@ -181,11 +188,12 @@ public:
         const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
         const size_t Offset    = BindingIndex * Stride;
 
-        this->m_HitGroupsRecord.resize(std::max(this->m_HitGroupsRecord.size(), Offset + Stride), Uint8{EmptyElem});
+        const size_t OldSize = this->m_HitGroupsRecord.size();
+        this->m_HitGroupsRecord.resize(std::max(OldSize, Offset + Stride), Uint8{EmptyElem});
 
         this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_HitGroupsRecord.data() + Offset, Stride);
         std::memcpy(this->m_HitGroupsRecord.data() + Offset + GroupSize, pData, DataSize);
-        this->m_Changed = true;
+        this->MarkDirty(this->m_HitGroupDirtyRange, std::min(OldSize, Offset), Offset + Stride);
 
 #ifdef DILIGENT_DEVELOPMENT
         OnBindHitGroup(nullptr, BindingIndex);
@@ -223,11 +231,12 @@ public:
         const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
         const size_t Offset    = Index * Stride;
 
-        this->m_HitGroupsRecord.resize(std::max(this->m_HitGroupsRecord.size(), Offset + Stride), Uint8{EmptyElem});
+        const size_t OldSize = this->m_HitGroupsRecord.size();
+        this->m_HitGroupsRecord.resize(std::max(OldSize, Offset + Stride), Uint8{EmptyElem});
 
         this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_HitGroupsRecord.data() + Offset, Stride);
         std::memcpy(this->m_HitGroupsRecord.data() + Offset + GroupSize, pData, DataSize);
-        this->m_Changed = true;
+        this->MarkDirty(this->m_HitGroupDirtyRange, std::min(OldSize, Offset), Offset + Stride);
 
 #ifdef DILIGENT_DEVELOPMENT
         VERIFY_EXPR(Index >= Info.FirstContributionToHitGroupIndex && Index <= Info.LastContributionToHitGroupIndex);
@@ -274,8 +283,9 @@ public:
         const Uint32 GroupSize  = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
         const size_t Stride     = this->m_ShaderRecordStride;
 
-        this->m_HitGroupsRecord.resize(std::max(this->m_HitGroupsRecord.size(), EndIndex * Stride), Uint8{EmptyElem});
-        this->m_Changed = true;
+        const size_t OldSize = this->m_HitGroupsRecord.size();
+        this->m_HitGroupsRecord.resize(std::max(OldSize, EndIndex * Stride), Uint8{EmptyElem});
+        this->MarkDirty(this->m_HitGroupDirtyRange, std::min(OldSize, BeginIndex * Stride), EndIndex * Stride);
 
         for (Uint32 i = 0; i < GeometryCount; ++i)
         {
@@ -312,8 +322,11 @@ public:
 
         const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
         const size_t Stride    = this->m_ShaderRecordStride;
-        this->m_HitGroupsRecord.resize(std::max(this->m_HitGroupsRecord.size(), (size_t{Info.LastContributionToHitGroupIndex} + 1) * Stride), Uint8{EmptyElem});
-        this->m_Changed = true;
+        const size_t OldSize   = this->m_HitGroupsRecord.size();
+        this->m_HitGroupsRecord.resize(std::max(OldSize, (size_t{Info.LastContributionToHitGroupIndex} + 1) * Stride), Uint8{EmptyElem});
+        this->MarkDirty(this->m_HitGroupDirtyRange,
+                        std::min(OldSize, size_t{Info.FirstContributionToHitGroupIndex} * Stride),
+                        (size_t{Info.LastContributionToHitGroupIndex} + 1) * Stride);
 
         for (Uint32 Index = RayOffsetInHitGroupIndex + Info.FirstContributionToHitGroupIndex;
              Index <= Info.LastContributionToHitGroupIndex;
@@ -340,11 +353,12 @@ public:
 
         const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
         const size_t Offset    = size_t{CallableIndex} * size_t{this->m_ShaderRecordStride};
-        this->m_CallableShadersRecord.resize(std::max(this->m_CallableShadersRecord.size(), Offset + this->m_ShaderRecordStride), Uint8{EmptyElem});
+        const size_t OldSize   = this->m_CallableShadersRecord.size();
+        this->m_CallableShadersRecord.resize(std::max(OldSize, Offset + this->m_ShaderRecordStride), Uint8{EmptyElem});
 
         this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_CallableShadersRecord.data() + Offset, this->m_ShaderRecordStride);
         std::memcpy(this->m_CallableShadersRecord.data() + Offset + GroupSize, pData, DataSize);
-        this->m_Changed = true;
+        this->MarkDirty(this->m_CallableDirtyRange, std::min(OldSize, Offset), Offset + this->m_ShaderRecordStride);
     }
 
 
@@ -438,10 +452,15 @@ public:
 protected:
     struct BindingTable
     {
+        // Table data, or null if the table has not been modified since the last update.
         const void* pData  = nullptr;
         Uint32      Size   = 0;
         Uint32      Offset = 0;
         Uint32      Stride = 0;
+
+        // Modified byte range relative to the table start that must be uploaded to the buffer.
+        Uint32 DirtyOffset = 0;
+        Uint32 DirtySize   = 0;
     };
     void GetData(BufferImplType*& pSBTBuffer,
                  BindingTable&    RaygenShaderBindingTable,
@@ -461,10 +480,16 @@ protected:
         const Uint32 CallableShadersOffset = AlignToLarger(HitGroupOffset + m_HitGroupsRecord.size());
         const Uint32 BufSize               = AlignToLarger(CallableShadersOffset + m_CallableShadersRecord.size());
 
+        // If the buffer is recreated or the tables have moved, all records must be uploaded again.
+        bool UploadAll = (MissShaderOffset != m_UploadedMissShaderOffset ||
+                          HitGroupOffset != m_UploadedHitGroupOffset ||
+                          CallableShadersOffset != m_UploadedCallableShadersOffset);
+
         // Recreate buffer
         if (m_pBuffer == nullptr || m_pBuffer->GetDesc().Size < BufSize)
         {
             m_pBuffer = nullptr;
+            UploadAll = true;
 
             String     BuffName = String{this->m_Desc.Name} + " - internal buffer";
             BufferDesc BuffDesc;
@@ -482,37 +507,36 @@ protected:
 
         pSBTBuffer = m_pBuffer;
 
-        if (!m_RayGenShaderRecord.empty())
-        {
-            RaygenShaderBindingTable.pData  = m_Changed ? m_RayGenShaderRecord.data() : nullptr;
-            RaygenShaderBindingTable.Offset = RayGenOffset;
-            RaygenShaderBindingTable.Size   = static_cast<Uint32>(m_RayGenShaderRecord.size());
-            RaygenShaderBindingTable.Stride = this->m_ShaderRecordStride;
-        }
+        const auto InitTable = [this, UploadAll](BindingTable& Table, const std::vector<Uint8>& Records, DirtyRange& Dirty, Uint32 Offset) {
+            if (UploadAll)
+                Dirty = {0, Records.size()};
 
-        if (!m_MissShadersRecord.empty())
-        {
-            MissShaderBindingTable.pData  = m_Changed ? m_MissShadersRecord.data() : nullptr;
-            MissShaderBindingTable.Offset = MissShaderOffset;
-            MissShaderBindingTable.Size   = static_cast<Uint32>(m_MissShadersRecord.size());
-            MissShaderBindingTable.Stride = this->m_ShaderRecordStride;
-        }
+            if (!Records.empty())
+            {
+                Table.Offset = Offset;
+                Table.Size   = static_cast<Uint32>(Records.size());
+                Table.Stride = this->m_ShaderRecordStride;
 
-        if (!m_HitGroupsRecord.empty())
-        {
-            HitShaderBindingTable.pData  = m_Changed ? m_HitGroupsRecord.data() : nullptr;
-            HitShaderBindingTable.Offset = HitGroupOffset;
-            HitShaderBindingTable.Size   = static_cast<Uint32>(m_HitGroupsRecord.size());
-            HitShaderBindingTable.Stride = this->m_ShaderRecordStride;
-        }
+                // Records may have been removed after the range was marked dirty
+                const size_t DirtyEnd = std::min(Dirty.End, Records.size());
+                if (Dirty.Begin < DirtyEnd)
+                {
+                    Table.pData       = Records.data();
+                    Table.DirtyOffset = static_cast<Uint32>(Dirty.Begin);
+                    Table.DirtySize   = static_cast<Uint32>(DirtyEnd - Dirty.Begin);
+                }
+            }
+            Dirty = {};
+        };
 
-        if (!m_CallableShadersRecord.empty())
-        {
-            CallableShaderBindingTable.pData  = m_Changed ? m_CallableShadersRecord.data() : nullptr;
-            CallableShaderBindingTable.Offset = CallableShadersOffset;
-            CallableShaderBindingTable.Size   = static_cast<Uint32>(m_CallableShadersRecord.size());
-            CallableShaderBindingTable.Stride = this->m_ShaderRecordStride;
-        }
+        InitTable(RaygenShaderBindingTable, m_RayGenShaderRecord, m_RayGenDirtyRange, RayGenOffset);
+        InitTable(MissShaderBindingTable, m_MissShadersRecord, m_MissDirtyRange, MissShaderOffset);
+        InitTable(HitShaderBindingTable, m_HitGroupsRecord, m_HitGroupDirtyRange, HitGroupOffset);
+        InitTable(CallableShaderBindingTable, m_CallableShadersRecord, m_CallableDirtyRange, CallableShadersOffset);
+
+        m_UploadedMissShaderOffset      = MissShaderOffset;
+        m_UploadedHitGroupOffset        = HitGroupOffset;
+        m_UploadedCallableShadersOffset = CallableShadersOffset;
 
         m_Changed = false;
     }
@@ -539,6 +563,38 @@ protected:
 #endif
 
 private:
+    // Byte range [Begin, End) of the records that were modified since the last update.
+    struct DirtyRange
+    {
+        size_t Begin = 0;
+        size_t End   = 0;
+    };
+
+    void MarkDirty(DirtyRange& Range, size_t Begin, size_t End)
+    {
+        VERIFY_EXPR(Begin < End);
+        if (Range.Begin < Range.End)
+        {
+            Range.Begin = std::min(Range.Begin, Begin);
+            Range.End   = std::max(Range.End, End);
+        }
+        else
+        {
+            Range = {Begin, End};
+        }
+        m_Changed = true;
+    }
+
+    DirtyRange m_RayGenDirtyRange;
+    DirtyRange m_MissDirtyRange;
+    DirtyRange m_CallableDirtyRange;
+    DirtyRange m_HitGroupDirtyRange;
+
+    // Table offsets in the internal buffer at the time of the last update.
+    Uint32 m_UploadedMissShaderOffset      = 0;
+    Uint32 m_UploadedHitGroupOffset        = 0;
+    Uint32 m_UploadedCallableShadersOffset = 0;
+
 #ifdef DILIGENT_DEVELOPMENT
     struct HitGroupBinding
     {
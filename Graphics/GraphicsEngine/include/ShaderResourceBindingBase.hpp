@@ -122,6 +122,8 @@ public:
                 const SHADER_RESOURCE_VARIABLE_TYPE VarTypes[] = {SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC};
                 m_pShaderVarMgrs[MgrInd].Initialize(*pPRS, VarDataAllocator, VarTypes, _countof(VarTypes), ShaderType);
             }
+
+            InitInlineConstantBuffers();
         }
         catch (...)
         {
@@ -192,7 +194,7 @@ public:
             return nullptr;
 
         VERIFY_EXPR(static_cast<Uint32>(MgrInd) < GetNumShaders());
-        return m_pShaderVarMgrs[MgrInd].GetVariable(Name);
+        return m_pShaderVarMgrs[MgrInd].GetVariable(ShaderType, Name);
     }
 
     /// Implementation of IShaderResourceBinding::GetVariableCount().
@@ -265,10 +267,97 @@ public:
         return StaleVarTypes;
     }
 
+    /// Implementation of IShaderResourceBinding::SetResources().
+    virtual void DILIGENT_CALL_TYPE SetResources(const ShaderResourceVariableUpdate* pUpdates,
+                                                 Uint32                              NumUpdates,
+                                                 SET_SHADER_RESOURCE_FLAGS           Flags) override final
+    {
+        DEV_CHECK_ERR(pUpdates != nullptr || NumUpdates == 0, "pUpdates must not be null when NumUpdates is not zero");
+
+        const auto PipelineType = GetPipelineType();
+
+        // Updates are typically grouped by shader stage, so cache the last manager
+        SHADER_TYPE                    LastShaderType = SHADER_TYPE_UNKNOWN;
+        ShaderVariableManagerImplType* pVarMgr        = nullptr;
+        for (Uint32 i = 0; i < NumUpdates; ++i)
+        {
+            const auto& Update = pUpdates[i];
+            if (Update.ShaderType == SHADER_TYPE_UNKNOWN)
+                continue;
+
+            if (Update.ShaderType != LastShaderType)
+            {
+                LastShaderType = Update.ShaderType;
+                pVarMgr        = nullptr;
+                if (IsConsistentShaderType(Update.ShaderType, PipelineType))
+                {
+                    const auto MgrInd = m_ActiveShaderStageIndex[GetShaderTypePipelineIndex(Update.ShaderType, PipelineType)];
+                    if (MgrInd >= 0)
+                        pVarMgr = &m_pShaderVarMgrs[MgrInd];
+                }
+            }
+
+            if (pVarMgr == nullptr)
+            {
+                DEV_ERROR("Unable to set resource for variable at index ", Update.VariableIndex, " in shader stage ", GetShaderTypeLiteralName(Update.ShaderType),
+                          " as the stage has no mutable or dynamic variables in pipeline resource signature '", m_pPRS->GetDesc().Name, "'.");
+                continue;
+            }
+
+            // The variable manager returns the final variable type where possible, which lets the compiler devirtualize the calls below.
+            auto* pVar = pVarMgr->GetVariable(Update.VariableIndex);
+            if (pVar == nullptr)
+                continue;
+
+            if (Update.BufferOffset != 0 || Update.BufferRange != 0)
+                pVar->SetBufferRange(Update.pObject, Update.BufferOffset, Update.BufferRange, Update.ArrayIndex, Flags);
+            else
+                pVar->SetArray(&Update.pObject, Update.ArrayIndex, 1, Flags);
+        }
+    }
+
     ShaderResourceCacheImplType&       GetResourceCache() { return m_ShaderResourceCache; }
     const ShaderResourceCacheImplType& GetResourceCache() const { return m_ShaderResourceCache; }
 
 private:
+    // Creates dynamic constant buffers that emulate inline constants and binds them to the variables
+    void InitInlineConstantBuffers()
+    {
+        for (Uint32 r = 0; r < m_pPRS->GetTotalResourceCount(); ++r)
+        {
+            const auto& ResDesc = m_pPRS->GetResourceDesc(r);
+            if ((ResDesc.Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) == 0)
+                continue;
+
+            VERIFY(ResDesc.VarType != SHADER_RESOURCE_VARIABLE_TYPE_STATIC,
+                   "Static inline constants are not allowed. This error should've been caught by PipelineResourceSignatureBase.");
+
+            const std::string BuffName = std::string{"Inline constants '"} + ResDesc.Name + "' of SRB for signature '" + m_pPRS->GetDesc().Name + '\'';
+
+            BufferDesc CBDesc;
+            CBDesc.Name           = BuffName.c_str();
+            CBDesc.Size           = ResDesc.NumInlineConstants * sizeof(Uint32);
+            CBDesc.Usage          = USAGE_DYNAMIC;
+            CBDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+            CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+
+            RefCntAutoPtr<IBuffer> pBuffer;
+            IRenderDevice*         pDevice = m_pPRS->GetDevice();
+            pDevice->CreateBuffer(CBDesc, nullptr, &pBuffer);
+            if (!pBuffer)
+                LOG_ERROR_AND_THROW("Failed to create the buffer for inline constants '", ResDesc.Name, "'.");
+
+            // All shader stages share the same resource, so it is enough to bind the buffer through any of them.
+            auto  Stages = ResDesc.ShaderStages;
+            auto* pVar   = GetVariableByName(ExtractLSB(Stages), ResDesc.Name);
+            if (pVar == nullptr)
+                LOG_ERROR_AND_THROW("Failed to find the variable for inline constants '", ResDesc.Name, "'.");
+            pVar->Set(pBuffer);
+
+            m_ShaderResourceCache.AddInlineConstantBuffer(r, ResDesc.NumInlineConstants, pBuffer);
+        }
+    }
+
     void Destruct()
     {
         if (m_pShaderVarMgrs != nullptr)
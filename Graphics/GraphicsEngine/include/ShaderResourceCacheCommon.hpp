@@ -31,8 +31,13 @@
 /// Definition of the common share resource cache constants
 
 #include <atomic>
+#include <cstring>
+#include <vector>
 
 #include "BasicTypes.h"
+#include "Buffer.h"
+#include "DebugUtilities.hpp"
+#include "RefCntAutoPtr.hpp"
 
 namespace Diligent
 {
@@ -50,6 +55,100 @@ enum class ResourceCacheContentType : Uint8
 class ShaderResourceCacheBase
 {
 public:
+    /// Returns the bit mask of descriptor sets whose resources have changed
+    /// since the bits were last cleared by ClearDirtySetMask().
+    /// All sets are initially dirty.
+    Uint32 GetDirtySetMask() const
+    {
+        return m_DirtySetMask.load(std::memory_order_relaxed);
+    }
+
+    /// Clears the dirty bits of the descriptor sets in the mask.
+    /// This should be done before the descriptors are written so that
+    /// concurrent modifications are not lost.
+    void ClearDirtySetMask(Uint32 Mask)
+    {
+        m_DirtySetMask.fetch_and(~Mask, std::memory_order_relaxed);
+    }
+
+    /// Returns true if the cache contains inline constants (see PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS).
+    bool HasInlineConstants() const
+    {
+        return !m_InlineConstantBuffers.empty();
+    }
+
+    /// Adds storage for NumConstants inline constants of the resource with index ResIndex
+    /// in the signature. The constants are emulated by the constant buffer pBuffer that
+    /// must be bound to the resource.
+    void AddInlineConstantBuffer(Uint32 ResIndex, Uint32 NumConstants, IBuffer* pBuffer)
+    {
+        VERIFY_EXPR(pBuffer != nullptr && pBuffer->GetDesc().Size >= NumConstants * sizeof(Uint32));
+
+        InlineConstantBufferInfo CBInfo;
+        CBInfo.pBuffer       = pBuffer;
+        CBInfo.ResIndex      = ResIndex;
+        CBInfo.NumConstants  = NumConstants;
+        CBInfo.FirstConstant = static_cast<Uint32>(m_InlineConstants.size());
+        m_InlineConstantBuffers.emplace_back(std::move(CBInfo));
+
+        m_InlineConstants.resize(m_InlineConstants.size() + NumConstants);
+        m_InlineConstantsUploadFrame = ~Uint64{0};
+    }
+
+    /// Sets the values of inline constants of the resource with index ResIndex in the signature.
+    void SetInlineConstants(Uint32 ResIndex, const void* pConstants, Uint32 FirstConstant, Uint32 NumConstants)
+    {
+        for (const auto& CBInfo : m_InlineConstantBuffers)
+        {
+            if (CBInfo.ResIndex == ResIndex)
+            {
+                VERIFY(FirstConstant + NumConstants <= CBInfo.NumConstants, "Inline constant range is out of bounds. This error should've been caught by ShaderVariableBase::SetInlineConstants()");
+                if (NumConstants > 0)
+                    memcpy(&m_InlineConstants[size_t{CBInfo.FirstConstant} + FirstConstant], pConstants, sizeof(Uint32) * NumConstants);
+                // Invalidate the buffer contents in all contexts
+                m_InlineConstantsUploadFrame = ~Uint64{0};
+                return;
+            }
+        }
+        UNEXPECTED("Resource ", ResIndex, " has no inline constants. This error should've been caught by ShaderVariableBase::SetInlineConstants()");
+    }
+
+    /// Returns true if the inline constants have not changed since they were written
+    /// to the buffers by UpdateInlineConstantBuffers() in the same context and frame.
+    bool InlineConstantBuffersUpToDate(Uint32 ContextId, Uint64 FrameNumber) const
+    {
+        return m_InlineConstantsUploadCtxId == ContextId && m_InlineConstantsUploadFrame == FrameNumber;
+    }
+
+    /// Calls Handler(IBuffer* pBuffer, const Uint32* pConstants, Uint32 NumConstants) for every
+    /// inline constant buffer to write the constants, and marks the buffers as up-to-date in the
+    /// given context and frame.
+    template <typename HandlerType>
+    void UpdateInlineConstantBuffers(Uint32 ContextId, Uint64 FrameNumber, HandlerType&& Handler)
+    {
+        for (auto& CBInfo : m_InlineConstantBuffers)
+            Handler(CBInfo.pBuffer.RawPtr(), &m_InlineConstants[CBInfo.FirstConstant], CBInfo.NumConstants);
+
+        m_InlineConstantsUploadCtxId = ContextId;
+        m_InlineConstantsUploadFrame = FrameNumber;
+    }
+
+    /// Returns true if all resources in the cache were transitioned to the required states
+    /// when the device resource state epoch was StateEpoch (see RenderDeviceBase::GetResourceStateEpoch()),
+    /// and no resource has been bound to the cache since then. In this case, only the resources
+    /// that require a barrier every time they are used (see m_BarrierResources) need to be processed.
+    bool ResourceStatesUpToDate(Uint32 StateEpoch) const
+    {
+        return m_ResourceStatesUpToDate.load(std::memory_order_relaxed) && m_TransitionStateEpoch == StateEpoch;
+    }
+
+    /// Marks the resource states as up-to-date at the device resource state epoch StateEpoch.
+    void SetResourceStatesUpToDate(Uint32 StateEpoch)
+    {
+        m_TransitionStateEpoch = StateEpoch;
+        m_ResourceStatesUpToDate.store(true, std::memory_order_relaxed);
+    }
+
 #ifdef DILIGENT_DEVELOPMENT
     uint32_t DvpGetRevision() const
     {
@@ -58,13 +157,59 @@ public:
 #endif
 
 protected:
+    void MarkSetDirty(Uint32 SetIndex)
+    {
+        VERIFY_EXPR(SetIndex < 32);
+        m_DirtySetMask.fetch_or(Uint32{1} << SetIndex, std::memory_order_relaxed);
+    }
+
     void UpdateRevision()
     {
+        InvalidateResourceStates();
 #ifdef DILIGENT_DEVELOPMENT
         m_DvpRevision.fetch_add(1);
 #endif
     }
 
+    /// Indicates that the resources must be fully transitioned by the next state transition.
+    void InvalidateResourceStates()
+    {
+        m_ResourceStatesUpToDate.store(false, std::memory_order_relaxed);
+    }
+
+    std::atomic<Uint32> m_DirtySetMask{~Uint32{0}};
+
+    // Indices of the resources that require a barrier every time they are used (e.g. UAVs),
+    // recorded by the last full state transition. These resources are transitioned
+    // even when the resource states are up-to-date.
+    std::vector<Uint32> m_BarrierResources;
+
+    // Device resource state epoch at the time of the last full state transition
+    Uint32 m_TransitionStateEpoch = 0;
+
+    std::atomic<bool> m_ResourceStatesUpToDate{false};
+
+    struct InlineConstantBufferInfo
+    {
+        // Dynamic constant buffer that emulates the inline constants
+        RefCntAutoPtr<IBuffer> pBuffer;
+
+        // Resource index in the signature
+        Uint32 ResIndex = ~0u;
+
+        Uint32 NumConstants = 0;
+
+        // Index of the first constant in m_InlineConstants
+        Uint32 FirstConstant = 0;
+    };
+    std::vector<InlineConstantBufferInfo> m_InlineConstantBuffers;
+    std::vector<Uint32>                   m_InlineConstants;
+
+    // The context and the frame in which the inline constants were last written to the buffers.
+    // Dynamic buffer contents are only valid within the frame and the context where they were mapped.
+    Uint32 m_InlineConstantsUploadCtxId = ~0u;
+    Uint64 m_InlineConstantsUploadFrame = ~Uint64{0};
+
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic<uint32_t> m_DvpRevision{0};
 #endif
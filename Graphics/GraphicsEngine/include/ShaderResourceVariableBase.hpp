@@ -31,6 +31,7 @@
 /// Implementation of the Diligent::ShaderBase template class
 
 #include <vector>
+#include <algorithm>
 
 #include "ShaderResourceVariable.h"
 #include "PipelineState.h"
@@ -712,6 +713,25 @@ struct ShaderVariableBase : public ResourceVariableBaseInterface
         static_cast<ThisImplType*>(this)->SetDynamicOffset(ArrayIndex, Offset);
     }
 
+    virtual void DILIGENT_CALL_TYPE SetInlineConstants(const void* pConstants,
+                                                       Uint32      FirstConstant,
+                                                       Uint32      NumConstants) override final
+    {
+#ifdef DILIGENT_DEVELOPMENT
+        {
+            const auto& Desc = GetDesc();
+            DEV_CHECK_ERR((Desc.Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) != 0,
+                          "SetInlineConstants() is only allowed for variables created with PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS flag.");
+            DEV_CHECK_ERR(FirstConstant + NumConstants <= Desc.NumInlineConstants,
+                          "SetInlineConstants arguments are invalid for '", Desc.Name, "' variable: specified constant range (", FirstConstant, " .. ",
+                          FirstConstant + NumConstants - 1, ") is out of bounds 0 .. ", Desc.NumInlineConstants - 1);
+            DEV_CHECK_ERR(pConstants != nullptr || NumConstants == 0, "pConstants must not be null when NumConstants is not zero");
+        }
+#endif
+
+        m_ParentManager.SetInlineConstants(m_ResIndex, pConstants, FirstConstant, NumConstants);
+    }
+
 
     virtual SHADER_RESOURCE_VARIABLE_TYPE DILIGENT_CALL_TYPE GetType() const override final
     {
@@ -739,12 +759,25 @@ struct ShaderVariableBase : public ResourceVariableBaseInterface
         if ((Flags & (1u << ResDesc.VarType)) == 0)
             return;
 
+        // Inline constants are bound to internal buffers
+        if ((ResDesc.Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) != 0)
+            return;
+
+        // Look up array elements in batches, so that the name is hashed
+        // and the mapping is locked once per batch rather than per element.
+        constexpr Uint32 MaxBatchSize = 32;
+        IDeviceObject*   pBatchObjects[MaxBatchSize];
+
         for (Uint32 ArrInd = 0; ArrInd < ResDesc.ArraySize; ++ArrInd)
         {
+            const Uint32 BatchElem = ArrInd % MaxBatchSize;
+            if (BatchElem == 0)
+                pResourceMapping->GetResourceArray(ResDesc.Name, ArrInd, std::min(ResDesc.ArraySize - ArrInd, MaxBatchSize), pBatchObjects);
+
             if ((Flags & BIND_SHADER_RESOURCES_KEEP_EXISTING) != 0 && pThis->Get(ArrInd) != nullptr)
                 continue;
 
-            if (auto* pObj = pResourceMapping->GetResource(ResDesc.Name, ArrInd))
+            if (auto* pObj = pBatchObjects[BatchElem])
             {
                 const auto SetResFlags = (Flags & BIND_SHADER_RESOURCES_ALLOW_OVERWRITE) != 0 ?
                     SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE :
@@ -776,6 +809,9 @@ struct ShaderVariableBase : public ResourceVariableBaseInterface
         if ((StaleVarTypes & VarTypeFlag) != 0)
             return; // This variable type is already stale
 
+        if ((ResDesc.Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) != 0)
+            return; // Inline constants are bound to internal buffers
+
         for (Uint32 ArrInd = 0; ArrInd < ResDesc.ArraySize; ++ArrInd)
         {
             const auto* const pBoundObj = pThis->Get(ArrInd);
@@ -804,6 +840,8 @@ struct ShaderVariableBase : public ResourceVariableBaseInterface
 
     const PipelineResourceDesc& GetDesc() const { return m_ParentManager.GetResourceDesc(m_ResIndex); }
 
+    Uint32 GetResourceIndex() const { return m_ResIndex; }
+
 protected:
     // Variable manager that owns this variable
     VarManagerType& m_ParentManager;
@@ -890,6 +928,20 @@ protected:
         }
     }
 
+    // Finds the variable that corresponds to the resource with the given index in the signature.
+    // Variables are created in the order of increasing resource index (see PipelineResourceSignatureBase::ProcessResources()),
+    // so binary search is used.
+    template <typename VarType>
+    static VarType* FindVariableByResIndex(VarType* pVariables, Uint32 NumVariables, Uint32 ResIndex)
+    {
+        auto* const pEnd = pVariables + NumVariables;
+
+        auto* pVar = std::lower_bound(pVariables, pEnd, ResIndex,
+                                      [](const VarType& Var, Uint32 Index) {
+                                          return Var.GetResourceIndex() < Index;
+                                      });
+        return (pVar != pEnd && pVar->GetResourceIndex() == ResIndex) ? pVar : nullptr;
+    }
 
 protected:
     IObject& m_Owner;
@@ -30,11 +30,17 @@
 /// \file
 /// Implementation of the Diligent::StateObjectsRegistry template class
 
-#include <unordered_map>
+#include <vector>
+#include <algorithm>
 #include <atomic>
+#include <new>
 
 #include "DeviceObject.h"
+#include "EngineMemory.h"
 #include "STDAllocator.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "SpinLock.hpp"
+#include "LinearProbingTable.hpp"
 
 namespace Diligent
 {
@@ -60,17 +66,34 @@ namespace Diligent
 /// if other thread has started dtor, the object will be locked by Diligent::RefCountedObject::Release().
 /// If after that this thread locks the registry first, it will be waiting for the object to unlock in
 /// Diligent::RefCntWeakPtr::Lock(), while the dtor thread will be waiting for the registry to unlock.
+/// \remarks
+/// The registry is split into NumShards shards selected by the description hash. Every shard
+/// has its own lock and its own open-addressing hash table, so threads that create different
+/// objects rarely contend. Expired references are removed incrementally: every Add() examines
+/// a few slots of the shard while there are outstanding deleted objects.
 template <typename ResourceDescType>
 class StateObjectsRegistry
 {
 public:
-    /// Number of outstanding deleted objects to purge the registry.
-    static constexpr int DeletedObjectsToPurge = 32;
+    /// The number of independent shards.
+    static constexpr Uint32 NumShards = 16;
+
+    /// The maximum number of table slots examined by every Add() to purge expired references.
+    static constexpr Uint32 PurgeStepSize = 8;
 
     StateObjectsRegistry(IMemoryAllocator& RawAllocator, const Char* RegistryName) :
-        m_DescToObjHashMap(STD_ALLOCATOR_RAW_MEM(HashMapElem, RawAllocator, "Allocator for unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject> >")),
+        m_RawAllocator{RawAllocator},
         m_RegistryName{RegistryName}
-    {}
+    {
+        m_Shards = ALLOCATE(RawAllocator, "Memory for StateObjectsRegistry shards", Shard, NumShards);
+        for (Uint32 s = 0; s < NumShards; ++s)
+            new (m_Shards + s) Shard{RawAllocator};
+    }
+
+    // clang-format off
+    StateObjectsRegistry           (const StateObjectsRegistry&) = delete;
+    StateObjectsRegistry& operator=(const StateObjectsRegistry&) = delete;
+    // clang-format on
 
     ~StateObjectsRegistry()
     {
@@ -80,35 +103,41 @@ public:
         // may only be expired references in the registry. After we
         // purge it, the registry must be empty.
         Purge();
-        VERIFY(m_DescToObjHashMap.empty(), "DescToObjHashMap is not empty");
+        for (Uint32 s = 0; s < NumShards; ++s)
+        {
+            VERIFY(m_Shards[s].Table.GetSize() == 0, "Registry shard is not empty");
+            m_Shards[s].~Shard();
+        }
+        FREE(m_RawAllocator, m_Shards);
+    }
+
+    /// Computes the hash of the object description that can be passed to Find() and Add().
+    static size_t ComputeDescHash(const ResourceDescType& Desc)
+    {
+        return std::hash<ResourceDescType>{}(Desc);
     }
 
     /// Adds a new object to the registry
 
     /// \param [in] ObjectDesc - object description.
-    /// \param [in] pObject - pointer to the object.
+    /// \param [in] DescHash   - object description hash computed by ComputeDescHash().
+    /// \param [in] pObject    - pointer to the object.
     ///
-    /// Besides adding a new object, the function also checks the number of
-    /// outstanding deleted objects and calls Purge() if the number has reached
-    /// the threshold value DeletedObjectsToPurge. Creating a state object is
-    /// assumed to be an expensive operation and should be performed during
-    /// the initialization. Occasional purge operations should not add significant
-    /// cost to it.
-    void Add(const ResourceDescType& ObjectDesc, IDeviceObject* pObject)
+    /// Besides adding a new object, the function also examines up to PurgeStepSize
+    /// slots of the shard and removes expired references if there are outstanding
+    /// deleted objects.
+    void Add(const ResourceDescType& ObjectDesc, size_t DescHash, IDeviceObject* pObject)
     {
-        Threading::SpinLockGuard Guard{m_Lock};
+        VERIFY_EXPR(DescHash == ComputeDescHash(ObjectDesc));
 
-        // If the number of outstanding deleted objects reached the threshold value,
-        // purge the registry. Since we have exclusive access now, it is safe
-        // to do.
-        if (m_NumDeletedObjects.load() >= DeletedObjectsToPurge)
-        {
-            Purge();
-            m_NumDeletedObjects.store(0);
-        }
+        auto& S = GetShard(DescHash);
+
+        Threading::SpinLockGuard Guard{S.Lock};
 
-        // Try to construct the new element in place
-        auto it_inserted = m_DescToObjHashMap.emplace(std::make_pair(ObjectDesc, Diligent::RefCntWeakPtr<IDeviceObject>(pObject)));
+        if (m_NumDeletedObjects.load(std::memory_order_relaxed) > 0)
+            PurgeStep(S);
+
+        const auto Pos = S.Find(ObjectDesc, DescHash);
         // It is theoretically possible that the same object can be found
         // in the registry. This might happen if two threads try to create
         // the same object at the same time. They both will not find the
@@ -122,95 +151,225 @@ public:
         // the second thread creates the same object and tries to add it to
         // the registry. It will find an existing expired reference to the
         // object.
-        if (!it_inserted.second)
+        if (Pos != InvalidPos)
         {
-            auto& it = it_inserted.first;
-            VERIFY(it->first == ObjectDesc, "Incorrect object description");
-            // This message likely adds no value
-            //LOG_INFO_MESSAGE("Object '", (it->first.Name ? it->first.Name : "<unnamed>"),
-            //                 "' with the same description already exists in the ",
-            //                 m_RegistryName, " registry. Replacing with the new object '",
-            //                 (ObjectDesc.Name ? ObjectDesc.Name : "<unnamed>"), "'.");
-            it->second = pObject;
+            auto& Entry = S.Table[Pos];
+            if (!Entry.pObject.IsValid())
+                OnExpiredObjectRemoved();
+            Entry.pObject = pObject;
+            return;
         }
+
+        S.Insert(ObjectDesc, DescHash, pObject, *this);
+    }
+
+    void Add(const ResourceDescType& ObjectDesc, IDeviceObject* pObject)
+    {
+        Add(ObjectDesc, ComputeDescHash(ObjectDesc), pObject);
     }
 
     /// Finds the object in the registry
-    void Find(const ResourceDescType& Desc, IDeviceObject** ppObject)
+
+    /// \param [in]  Desc     - object description.
+    /// \param [in]  DescHash - object description hash computed by ComputeDescHash().
+    /// \param [out] ppObject - address of the memory location where the pointer to the
+    ///                         object will be written, or null if the object is not found.
+    void Find(const ResourceDescType& Desc, size_t DescHash, IDeviceObject** ppObject)
     {
         VERIFY(*ppObject == nullptr, "Overwriting reference to existing object may cause memory leaks");
+        VERIFY_EXPR(DescHash == ComputeDescHash(Desc));
         *ppObject = nullptr;
-        Threading::SpinLockGuard Guard{m_Lock};
 
-        auto It = m_DescToObjHashMap.find(Desc);
-        if (It != m_DescToObjHashMap.end())
+        auto& S = GetShard(DescHash);
+
+        Threading::SpinLockGuard Guard{S.Lock};
+
+        const auto Pos = S.Find(Desc, DescHash);
+        if (Pos == InvalidPos)
+            return;
+
+        // Try to obtain strong reference to the object.
+        // This is an atomic operation and we either get
+        // a new strong reference or object has been destroyed
+        // and we get null.
+        if (auto pObject = S.Table[Pos].pObject.Lock())
         {
-            // Try to obtain strong reference to the object.
-            // This is an atomic operation and we either get
-            // a new strong reference or object has been destroyed
-            // and we get null.
-            if (auto pObject = It->second.Lock())
-            {
-                *ppObject = pObject.Detach();
-                //LOG_INFO_MESSAGE( "Equivalent of the requested state object named \"", Desc.Name ? Desc.Name : "", "\" found in the ", m_RegistryName, " registry. Reusing existing object.");
-            }
-            else
-            {
-                // Expired object found: remove it from the map
-                m_DescToObjHashMap.erase(It);
-                m_NumDeletedObjects.fetch_add(-1);
-            }
+            *ppObject = pObject.Detach();
+        }
+        else
+        {
+            // Expired object found: remove it from the table
+            S.Remove(Pos);
+            OnExpiredObjectRemoved();
         }
     }
 
-    /// Purges outstanding deleted objects from the registry
+    void Find(const ResourceDescType& Desc, IDeviceObject** ppObject)
+    {
+        Find(Desc, ComputeDescHash(Desc), ppObject);
+    }
+
+    /// Purges all expired references from the registry
     void Purge()
     {
         Uint32 NumPurgedObjects = 0;
-        auto   It               = m_DescToObjHashMap.begin();
-        while (It != m_DescToObjHashMap.end())
+        for (Uint32 s = 0; s < NumShards; ++s)
         {
-            auto NextIt = It;
-            ++NextIt;
-            // Note that IsValid() is not a thread-safe function in the sense that it
-            // can give false positive results. The only thread-safe way to check if the
-            // object is alive is to lock the weak pointer, but that requires thread
-            // synchronization. We will immediately unlock the pointer anyway, so we
-            // want to detect 100% expired pointers. IsValid() does provide that information
-            // because once a weak pointer becomes invalid, it will be invalid
-            // until it is destroyed. It is not a problem if we miss an expired weak
-            // pointer as it will definitely be removed next time.
-            if (!It->second.IsValid())
+            auto& S = m_Shards[s];
+
+            Threading::SpinLockGuard Guard{S.Lock};
+            for (size_t Pos = 0; Pos < S.Table.GetCapacity();)
             {
-                m_DescToObjHashMap.erase(It);
-                ++NumPurgedObjects;
+                // Note that IsValid() is not a thread-safe function in the sense that it
+                // can give false positive results. The only thread-safe way to check if the
+                // object is alive is to lock the weak pointer, but that requires thread
+                // synchronization. We will immediately unlock the pointer anyway, so we
+                // want to detect 100% expired pointers. IsValid() does provide that information
+                // because once a weak pointer becomes invalid, it will be invalid
+                // until it is destroyed. It is not a problem if we miss an expired weak
+                // pointer as it will definitely be removed next time.
+                if (S.Table[Pos].IsOccupied && !S.Table[Pos].pObject.IsValid())
+                {
+                    // Backward-shift deletion may move another entry to this slot, so check it again
+                    S.Remove(Pos);
+                    OnExpiredObjectRemoved();
+                    ++NumPurgedObjects;
+                }
+                else
+                {
+                    ++Pos;
+                }
             }
-
-            It = NextIt;
         }
         if (NumPurgedObjects > 0)
             LOG_INFO_MESSAGE("Purged ", NumPurgedObjects, " deleted objects from the ", m_RegistryName, " registry");
     }
 
     /// Increments the number of outstanding deleted objects.
-    /// When this number reaches DeletedObjectsToPurge, Purge() will
-    /// be called.
+    /// While this number is not zero, every Add() purges a few expired references.
     void ReportDeletedObject()
     {
         m_NumDeletedObjects.fetch_add(+1);
     }
 
 private:
-    /// Lock flag to protect the m_DescToObjHashMap
-    Threading::SpinLock m_Lock;
+    struct Slot
+    {
+        size_t                       Hash = 0;
+        ResourceDescType             Desc;
+        RefCntWeakPtr<IDeviceObject> pObject;
+        bool                         IsOccupied = false;
+    };
+
+    struct SlotTraits
+    {
+        static Slot EmptySlot() { return Slot(); }
+        static bool IsEmpty(const Slot& S) { return !S.IsOccupied; }
+    };
+
+    using SlotTable = LinearProbingTable<Slot, SlotTraits, STDAllocatorRawMem<Slot>>;
+
+    static constexpr size_t InvalidPos = SlotTable::InvalidPos;
+
+    static Uint64 GetSlotHash(const Slot& S)
+    {
+        return Uint64{S.Hash};
+    }
+
+    struct Shard
+    {
+        explicit Shard(IMemoryAllocator& RawAllocator) :
+            Table{STD_ALLOCATOR_RAW_MEM(Slot, RawAllocator, "Allocator for vector<StateObjectsRegistry::Slot>")}
+        {}
+
+        size_t Find(const ResourceDescType& Desc, size_t Hash) const
+        {
+            return Table.Find(Hash, [&](const Slot& S) { return S.Hash == Hash && S.Desc == Desc; });
+        }
+
+        void Insert(const ResourceDescType& Desc, size_t Hash, IDeviceObject* pObject, StateObjectsRegistry& Registry)
+        {
+            if (Table.NeedsGrow())
+            {
+                // Expired references are not moved to the new table
+                Table.Grow(GetSlotHash,
+                           [&Registry](const Slot& S) {
+                               if (S.pObject.IsValid())
+                                   return true;
+                               Registry.OnExpiredObjectRemoved();
+                               return false;
+                           });
+                PurgeCursor = 0;
+            }
+
+            Slot NewSlot;
+            NewSlot.Hash       = Hash;
+            NewSlot.Desc       = Desc;
+            NewSlot.pObject    = pObject;
+            NewSlot.IsOccupied = true;
+            Table.Insert(Hash, std::move(NewSlot), GetSlotHash);
+        }
+
+        void Remove(size_t Pos)
+        {
+            Table.Remove(Pos, GetSlotHash);
+        }
+
+        Threading::SpinLock Lock;
+
+        SlotTable Table;
+
+        // Position of the next slot to be examined by PurgeStep()
+        size_t PurgeCursor = 0;
+    };
+
+    Shard& GetShard(size_t DescHash)
+    {
+        return m_Shards[DescHash % NumShards];
+    }
+
+    // Examines up to PurgeStepSize slots of the shard and removes expired references.
+    // The shard must be locked.
+    void PurgeStep(Shard& S)
+    {
+        if (S.Table.GetSize() == 0)
+            return;
+
+        const auto Mask = S.Table.GetCapacity() - 1;
+        for (Uint32 i = 0; i < PurgeStepSize && S.Table.GetSize() > 0; ++i)
+        {
+            const auto& Entry = S.Table[S.PurgeCursor];
+            if (Entry.IsOccupied && !Entry.pObject.IsValid())
+            {
+                // Backward-shift deletion may move another entry to this slot, so do not advance the cursor
+                S.Remove(S.PurgeCursor);
+                OnExpiredObjectRemoved();
+            }
+            else
+            {
+                S.PurgeCursor = (S.PurgeCursor + 1) & Mask;
+            }
+        }
+    }
+
+    void OnExpiredObjectRemoved()
+    {
+        // The counter is only a hint and may be reported after the reference has already
+        // been removed, so never let it go below zero.
+        auto NumDeleted = m_NumDeletedObjects.load(std::memory_order_relaxed);
+        while (NumDeleted > 0 && !m_NumDeletedObjects.compare_exchange_weak(NumDeleted, NumDeleted - 1, std::memory_order_relaxed))
+        {
+        }
+    }
+
+private:
+    IMemoryAllocator& m_RawAllocator;
+
+    Shard* m_Shards = nullptr; // [NumShards]
 
     /// Number of outstanding deleted objects that have not been purged
     std::atomic<long> m_NumDeletedObjects{0};
 
-    /// Hash map that stores weak pointers to the referenced objects
-    typedef std::pair<const ResourceDescType, RefCntWeakPtr<IDeviceObject>>                                                                                           HashMapElem;
-    std::unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject>, std::hash<ResourceDescType>, std::equal_to<ResourceDescType>, STDAllocatorRawMem<HashMapElem>> m_DescToObjHashMap;
-
     /// Registry name used for debug output
     const String m_RegistryName;
 };
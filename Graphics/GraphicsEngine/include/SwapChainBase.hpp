@@ -95,6 +95,9 @@ public:
     virtual void DILIGENT_CALL_TYPE SetMaximumFrameLatency(Uint32 MaxLatency) override
     {}
 
+    virtual void DILIGENT_CALL_TYPE WaitForFrame() override
+    {}
+
 protected:
     bool Resize(Uint32 NewWidth, Uint32 NewHeight, SURFACE_TRANSFORM NewPreTransform, Int32 Dummy = 0 /*To be different from virtual function*/)
     {
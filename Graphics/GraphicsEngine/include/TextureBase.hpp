@@ -32,6 +32,8 @@
 
 #include <memory>
 #include <array>
+#include <mutex>
+#include <unordered_map>
 
 #include "Texture.h"
 #include "GraphicsTypes.h"
@@ -40,6 +42,9 @@
 #include "STDAllocator.hpp"
 #include "FormatString.hpp"
 #include "PlatformMisc.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "HashUtils.hpp"
+#include "StringTools.h"
 
 namespace Diligent
 {
@@ -49,6 +54,9 @@ struct CopyTextureAttribs;
 /// Validates texture description and throws an exception in case of an error.
 void ValidateTextureDesc(const TextureDesc& TexDesc, const IRenderDevice* pDevice) noexcept(false);
 
+/// Validates the device memory the texture is placed in (see TextureData::pMemory) and throws an exception in case of an error.
+void ValidateTextureInitData(const TextureDesc& TexDesc, const TextureData* pInitData) noexcept(false);
+
 /// Validates and corrects texture view description; throws an exception in case of an error.
 void ValidatedAndCorrectTextureViewDesc(const TextureDesc& TexDesc, TextureViewDesc& ViewDesc) noexcept(false);
 
@@ -160,7 +168,47 @@ public:
         else
             UNEXPECTED("Unexpected texture view type.");
 
+        DEV_CHECK_ERR(ppView != nullptr, "Null pointer provided");
+        if (ppView == nullptr)
+            return;
+
+        // Views are requested with the same descriptions over and over again (e.g. by post-processing
+        // effects), so reuse the live view instead of creating a new object and descriptor.
+        std::lock_guard<std::mutex> Lock{m_ViewCacheMtx};
+
+        auto it = m_ViewCache.find(ViewDesc);
+        if (it != m_ViewCache.end())
+        {
+            if (auto pView = it->second.Lock())
+            {
+                // A view with a sampler has been customized by its owner and is not shared.
+                // The view is only shared if its name matches the requested one.
+                if (pView->GetSampler() == nullptr &&
+                    (ViewDesc.Name == nullptr || SafeStrEqual(pView->GetDesc().Name, ViewDesc.Name)))
+                {
+                    *ppView = pView.Detach();
+                    return;
+                }
+            }
+        }
+
         CreateViewInternal(ViewDesc, ppView, false);
+        if (*ppView == nullptr)
+            return;
+
+        // Remove views that have been released
+        for (auto view_it = m_ViewCache.begin(); view_it != m_ViewCache.end();)
+        {
+            if (!view_it->second.IsValid())
+                view_it = m_ViewCache.erase(view_it);
+            else
+                ++view_it;
+        }
+
+        // The name is ignored by the hasher and the comparison operator and may not outlive the view.
+        TextureViewDesc Key = ViewDesc;
+        Key.Name            = nullptr;
+        m_ViewCache[Key]    = RefCntWeakPtr<ITextureView>{*ppView};
     }
 
     ~TextureBase()
@@ -283,7 +331,11 @@ public:
 
     virtual void DILIGENT_CALL_TYPE SetState(RESOURCE_STATE State) override final
     {
-        this->m_State = State;
+        if (this->m_State != State)
+        {
+            this->m_State = State;
+            OnStateChanged();
+        }
     }
 
     virtual RESOURCE_STATE DILIGENT_CALL_TYPE GetState() const override final
@@ -331,6 +383,14 @@ public:
     }
 
 protected:
+    /// Notifies the device that the resource state has changed, see RenderDeviceBase::GetResourceStateEpoch().
+    void OnStateChanged()
+    {
+        // Device can be null if the object is used for serialization
+        if (this->m_pDevice != nullptr)
+            this->m_pDevice->OnResourceStateChanged();
+    }
+
     void DestroyDefaultViews()
     {
         if (m_pDefaultViews == nullptr)
@@ -396,6 +456,11 @@ protected:
     RESOURCE_STATE m_State = RESOURCE_STATE_UNKNOWN;
 
     std::unique_ptr<SparseTextureProperties> m_pSparseProps;
+
+    // Weak references to the live non-default views created by CreateView().
+    // Views keep strong references to the texture, so the cache must not keep them alive.
+    std::mutex                                                       m_ViewCacheMtx;
+    std::unordered_map<TextureViewDesc, RefCntWeakPtr<ITextureView>> m_ViewCache;
 };
 
 } // namespace Diligent
@@ -31,9 +31,12 @@
 /// Implementation of the Diligent::TopLevelASBase template class
 
 #include <unordered_map>
+#include <vector>
 #include <atomic>
+#include <cstring>
 
 #include "TopLevelAS.h"
+#include "DeviceContext.h"
 #include "BottomLevelASBase.hpp"
 #include "DeviceObjectBase.hpp"
 #include "RenderDeviceBase.hpp"
@@ -240,6 +243,68 @@ public:
 #endif
     }
 
+    /// Compares the instance records packed for the current build with the records that were uploaded
+    /// to the instance buffer by the previous build, and appends the ranges {first record, record count}
+    /// that must be uploaded to DirtyRanges. pRecords must point to InstanceCount records of
+    /// TLAS_INSTANCE_DATA_SIZE bytes each. When the previous records are not available (e.g. the
+    /// TLAS was built from scratch, or the instance buffer region is different), all records are dirty.
+    /// The records are kept for the next build.
+    template <typename RangeVectorType>
+    void UpdateUploadedInstanceRecords(const void*      pRecords,
+                                       Uint32           InstanceCount,
+                                       const IBuffer*   pInstanceBuffer,
+                                       Uint64           InstanceBufferOffset,
+                                       bool             Update,
+                                       RangeVectorType& DirtyRanges)
+    {
+        const size_t DataSize = size_t{InstanceCount} * TLAS_INSTANCE_DATA_SIZE;
+        const auto*  pSrc     = static_cast<const Uint8*>(pRecords);
+
+        const bool PrevRecordsValid =
+            Update &&
+            this->m_UploadedInstanceRecords.size() == DataSize &&
+            this->m_UploadedInstanceBufferId == pInstanceBuffer->GetUniqueID() &&
+            this->m_UploadedInstanceBufferOffset == InstanceBufferOffset;
+        if (!PrevRecordsValid)
+        {
+            this->m_UploadedInstanceRecords.assign(pSrc, pSrc + DataSize);
+            this->m_UploadedInstanceBufferId     = pInstanceBuffer->GetUniqueID();
+            this->m_UploadedInstanceBufferOffset = InstanceBufferOffset;
+            if (InstanceCount > 0)
+                DirtyRanges.emplace_back(Uint32{0}, InstanceCount);
+            return;
+        }
+
+        // Clean records between two dirty ones are uploaded too if the gap is small, which
+        // reduces the number of copy regions at the cost of a few extra bytes.
+        constexpr Uint32 MaxCleanGap = 4;
+
+        auto* pDst = this->m_UploadedInstanceRecords.data();
+        for (Uint32 i = 0; i < InstanceCount; ++i)
+        {
+            const size_t Offset = size_t{i} * TLAS_INSTANCE_DATA_SIZE;
+            if (std::memcmp(pDst + Offset, pSrc + Offset, TLAS_INSTANCE_DATA_SIZE) == 0)
+                continue;
+
+            std::memcpy(pDst + Offset, pSrc + Offset, TLAS_INSTANCE_DATA_SIZE);
+            if (!DirtyRanges.empty() && DirtyRanges.back().first + DirtyRanges.back().second + MaxCleanGap >= i)
+                DirtyRanges.back().second = i + 1 - DirtyRanges.back().first;
+            else
+                DirtyRanges.emplace_back(i, Uint32{1});
+        }
+    }
+
+    /// Releases the records kept by UpdateUploadedInstanceRecords().
+    void ReleaseUploadedInstanceRecords()
+    {
+        if (this->m_UploadedInstanceRecords.empty())
+            return;
+
+        std::vector<Uint8>{}.swap(this->m_UploadedInstanceRecords);
+        this->m_UploadedInstanceBufferId     = -1;
+        this->m_UploadedInstanceBufferOffset = 0;
+    }
+
     /// Implementation of ITopLevelAS::GetInstanceDesc().
     virtual TLASInstanceDesc DILIGENT_CALL_TYPE GetInstanceDesc(const char* Name) const override final
     {
@@ -276,7 +341,11 @@ public:
     {
         VERIFY(State == RESOURCE_STATE_UNKNOWN || State == RESOURCE_STATE_BUILD_AS_READ || State == RESOURCE_STATE_BUILD_AS_WRITE || State == RESOURCE_STATE_RAY_TRACING,
                "Unsupported state for top-level acceleration structure");
-        this->m_State = State;
+        if (this->m_State != State)
+        {
+            this->m_State = State;
+            OnStateChanged();
+        }
     }
 
     /// Implementation of ITopLevelAS::GetState().
@@ -383,6 +452,14 @@ private:
     }
 
 protected:
+    /// Notifies the device that the resource state has changed, see RenderDeviceBase::GetResourceStateEpoch().
+    void OnStateChanged()
+    {
+        // Device can be null if the object is used for serialization
+        if (this->m_pDevice != nullptr)
+            this->m_pDevice->OnResourceStateChanged();
+    }
+
     RESOURCE_STATE     m_State = RESOURCE_STATE_UNKNOWN;
     TLASBuildInfo      m_BuildInfo;
     ScratchBufferSizes m_ScratchSize;
@@ -391,6 +468,13 @@ protected:
 
     StringPool m_StringPool;
 
+    // The copy of the instance records in the backend format that were uploaded to the instance buffer region
+    // identified by m_UploadedInstanceBufferId and m_UploadedInstanceBufferOffset by the last build.
+    // Only kept when BuildTLASAttribs::UploadChangedInstancesOnly is true.
+    std::vector<Uint8> m_UploadedInstanceRecords;
+    Int32              m_UploadedInstanceBufferId     = -1;
+    Uint64             m_UploadedInstanceBufferOffset = 0;
+
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic<Uint32> m_DvpVersion{0};
 #endif
@@ -199,6 +199,21 @@ struct BufferData
     /// will be used.
     struct IDeviceContext*  pContext  DEFAULT_INITIALIZER(nullptr);
 
+    /// Optional device memory to place the buffer in.
+
+    /// When not null, the buffer is created at MemoryOffset in the memory object instead of
+    /// allocating its own memory. The memory must be created with DEVICE_MEMORY_TYPE_PLACED,
+    /// and the buffer must use USAGE_DEFAULT. Buffers whose memory ranges overlap alias each other;
+    /// use aliasing barriers (see StateTransitionDesc) to switch between them.
+    /// Use IRenderDevice::GetBufferMemoryRequirements() to get the size and the alignment of the buffer memory.
+    ///
+    /// \remarks The buffer keeps a strong reference to the memory object.
+    struct IDeviceMemory*   pMemory   DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset in pMemory, in bytes. Must be a multiple of ResourceMemoryRequirements::Alignment,
+    /// and the memory range of the buffer must be inside a single memory page.
+    Uint64 MemoryOffset               DEFAULT_INITIALIZER(0);
+
 #if DILIGENT_CPP_INTERFACE
 
     constexpr BufferData() noexcept {}
@@ -151,8 +151,20 @@ struct PipelineStateUnpackInfo
     Uint64 ImmediateContextMask     DEFAULT_INITIALIZER(1);
 
     /// Optional PSO cache.
+
+    /// \remarks   In OpenGL backend, shader programs are loaded from the linked binaries
+    ///             stored in the cache when the cache was generated by the same driver.
     IPipelineStateCache* pCache DEFAULT_INITIALIZER(nullptr);
 
+    /// Additional pipeline state creation flags, see Diligent::PSO_CREATE_FLAGS.
+
+    /// The flags are combined with the flags the pipeline was archived with.
+    /// When PSO_CREATE_FLAG_ASYNCHRONOUS is set and the device supports asynchronous shader
+    /// compilation, UnpackPipelineState returns the pipeline state that is not ready yet and
+    /// is created by the device shader compilation thread pool. An application should use
+    /// IPipelineState::GetStatus() to check when the pipeline state is ready.
+    PSO_CREATE_FLAGS Flags DEFAULT_INITIALIZER(PSO_CREATE_FLAG_NONE);
+
     /// An optional function to be called by the dearchiver to let the application modify
     /// the pipeline state create info.
     ///
@@ -198,6 +210,62 @@ struct RenderPassUnpackInfo
 };
 typedef struct RenderPassUnpackInfo RenderPassUnpackInfo;
 
+
+/// Dearchiver prefetch parameters
+struct DearchiverPrefetchInfo
+{
+    struct IRenderDevice* pDevice DEFAULT_INITIALIZER(nullptr);
+
+    /// Usage manifest to prefetch the resources from, see IDearchiver::StoreUsageManifest().
+    const IDataBlob* pManifest DEFAULT_INITIALIZER(nullptr);
+
+    /// An optional thread pool to unpack the resources in.
+
+    /// \remarks   If the pool is null, the resources are unpacked by the calling thread.
+    ///            In OpenGL backend, the pool is ignored and the resources are always
+    ///            unpacked by the calling thread.
+    ///
+    ///            The device's shader compilation thread pool should not be used here as
+    ///            pipeline states created with PSO_CREATE_FLAG_ASYNCHRONOUS flag are
+    ///            compiled by that pool, see PSOFlags.
+#if DILIGENT_CPP_INTERFACE
+    class IThreadPool*  pThreadPool DEFAULT_INITIALIZER(nullptr);
+#else
+    struct IThreadPool* pThreadPool;
+#endif
+
+    /// Shader resource binding allocation granularity of the prefetched pipeline states
+    /// and resource signatures, see PipelineStateUnpackInfo::SRBAllocationGranularity.
+    Uint32 SRBAllocationGranularity DEFAULT_INITIALIZER(1);
+
+    /// Immediate context mask of the prefetched pipeline states,
+    /// see PipelineStateUnpackInfo::ImmediateContextMask.
+    Uint64 ImmediateContextMask     DEFAULT_INITIALIZER(1);
+
+    /// Additional creation flags of the prefetched pipeline states,
+    /// see PipelineStateUnpackInfo::Flags.
+    PSO_CREATE_FLAGS PSOFlags       DEFAULT_INITIALIZER(PSO_CREATE_FLAG_NONE);
+};
+typedef struct DearchiverPrefetchInfo DearchiverPrefetchInfo;
+
+
+/// Dearchiver prefetch progress, see IDearchiver::GetPrefetchProgress().
+struct DearchiverPrefetchProgress
+{
+    /// The total number of resources scheduled for prefetching.
+    Uint32 NumResources DEFAULT_INITIALIZER(0);
+
+    /// The number of resources that have been unpacked.
+
+    /// \note  Pipeline states created with PSO_CREATE_FLAG_ASYNCHRONOUS flag
+    ///        may still be compiling, see IPipelineState::GetStatus().
+    Uint32 NumUnpacked  DEFAULT_INITIALIZER(0);
+
+    /// The number of resources that could not be unpacked.
+    Uint32 NumFailed    DEFAULT_INITIALIZER(0);
+};
+typedef struct DearchiverPrefetchProgress DearchiverPrefetchProgress;
+
 #undef REF
 
 // clang-format on
@@ -225,12 +293,26 @@ DILIGENT_BEGIN_INTERFACE(IDearchiver, IObject)
     /// \param [in] pArchive - A pointer to the source raw data to load objects from.
     /// \param [in] MakeCopy - Whether to make a copy of the archive, or use the
     ///                        the original contents.
+    /// \param [in] Override - Whether resources in this archive should override resources
+    ///                        with the same names from previously loaded archives.
     /// \return     true if the archive has been loaded successfully, and false otherwise.
     ///
     /// \note       If the archive was not copied, the dearchiver will keep a strong reference
     ///             to the pArchive data blob. It will be kept alive until the dearchiver object
     ///             is released or the Reset() method is called.
     ///
+    /// \note       Only the archive directory is parsed when the archive is loaded; resource data
+    ///             is accessed when the resource is unpacked. To avoid loading the entire archive
+    ///             into memory, pArchive may be backed by a memory-mapped file (see
+    ///             Diligent::MemoryMappedFileDataBlob), in which case MakeCopy should be false.
+    ///
+    /// \note       An archive loaded with Override set to true acts as a patch on top of the
+    ///             previously loaded archives: it only needs to contain new and modified resources,
+    ///             and the base archives are not parsed again. Resources that were unpacked
+    ///             before the patch was loaded are not affected, but subsequent unpack operations
+    ///             as well as Store() will use the objects from the newest archive.
+    ///             If Override is false, resources that already exist are ignored.
+    ///
     /// \warning    If the archive was loaded without making a copy, the application
     ///             must not modify its contents while it is in use by the dearchiver.
     /// 
@@ -238,7 +320,8 @@ DILIGENT_BEGIN_INTERFACE(IDearchiver, IObject)
     ///             with other methods.
     VIRTUAL Bool METHOD(LoadArchive)(THIS_
                                      const IDataBlob* pArchive,
-                                     Bool             MakeCopy DEFAULT_VALUE(false)) PURE;
+                                     Bool             MakeCopy DEFAULT_VALUE(false),
+                                     Bool             Override DEFAULT_VALUE(false)) PURE;
 
     /// Unpacks a shader from the device object archive.
 
@@ -306,8 +389,50 @@ DILIGENT_BEGIN_INTERFACE(IDearchiver, IObject)
     VIRTUAL Bool METHOD(Store)(THIS_
                                IDataBlob** ppArchive) CONST PURE;
 
+    /// Writes the usage manifest to the data blob.
+
+    /// \param [in] ppManifest - Memory location where a pointer to the manifest data blob will be written.
+    /// \return     true if the manifest was written successfully, and false otherwise.
+    ///
+    /// \note       The manifest lists the shaders, pipeline states, resource signatures and render passes
+    ///             that have been unpacked by the application since the dearchiver was created or reset,
+    ///             in the order they were first requested. Resources unpacked with modification callbacks
+    ///             and resources unpacked by Prefetch() are not recorded.
+    ///
+    ///             An application typically records the manifest during a play session and passes it
+    ///             to Prefetch() when the level is loaded next time.
+    ///
+    ///             This method is thread-safe.
+    VIRTUAL Bool METHOD(StoreUsageManifest)(THIS_
+                                            IDataBlob** ppManifest) CONST PURE;
+
+    /// Starts unpacking the resources listed in the usage manifest.
+
+    /// \param [in] PrefetchInfo - Prefetch parameters, see Diligent::DearchiverPrefetchInfo.
+    /// \return     true if the manifest is valid and the resources have been scheduled, and false otherwise.
+    ///
+    /// \note       The resources are unpacked in the order they are listed in the manifest.
+    ///             When a thread pool is provided, the method returns immediately and the resources
+    ///             are unpacked in the pool; use GetPrefetchProgress() to check the progress.
+    ///
+    ///             The dearchiver keeps strong references to the prefetched objects, so that
+    ///             subsequent unpack requests return them from the cache. The objects are released
+    ///             by Reset(). Resources that can't be found in the loaded archives are counted as failed.
+    ///
+    ///             This method is thread-safe.
+    VIRTUAL Bool METHOD(Prefetch)(THIS_
+                                  const DearchiverPrefetchInfo REF PrefetchInfo) PURE;
+
+    /// Returns the progress of the resources scheduled by Prefetch().
+
+    /// \note   This method is thread-safe.
+    VIRTUAL DearchiverPrefetchProgress METHOD(GetPrefetchProgress)(THIS) CONST PURE;
+
     /// Resets the dearchiver state and releases all loaded objects.
     ///
+    /// \remarks    The method waits until all prefetch tasks are finished. Tasks that
+    ///             have not started yet do not unpack their resources.
+    ///
     /// \warning    This method is not thread-safe and must not be called simultaneously
     ///             with other methods.
     VIRTUAL void METHOD(Reset)(THIS) PURE;
@@ -324,6 +449,9 @@ DILIGENT_END_INTERFACE
 #    define IDearchiver_UnpackResourceSignature(This, ...) CALL_IFACE_METHOD(Dearchiver, UnpackResourceSignature, This, __VA_ARGS__)
 #    define IDearchiver_UnpackRenderPass(This, ...)        CALL_IFACE_METHOD(Dearchiver, UnpackRenderPass,        This, __VA_ARGS__)
 #    define IDearchiver_Store(This, ...)                   CALL_IFACE_METHOD(Dearchiver, Store,                   This, __VA_ARGS__)
+#    define IDearchiver_StoreUsageManifest(This, ...)      CALL_IFACE_METHOD(Dearchiver, StoreUsageManifest,      This, __VA_ARGS__)
+#    define IDearchiver_Prefetch(This, ...)                CALL_IFACE_METHOD(Dearchiver, Prefetch,                This, __VA_ARGS__)
+#    define IDearchiver_GetPrefetchProgress(This)          CALL_IFACE_METHOD(Dearchiver, GetPrefetchProgress,     This)
 #    define IDearchiver_Reset(This)                        CALL_IFACE_METHOD(Dearchiver, Reset,                   This)
 
 #endif
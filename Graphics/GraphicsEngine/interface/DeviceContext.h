@@ -147,6 +147,104 @@ struct DeviceContextDesc
 typedef struct DeviceContextDesc DeviceContextDesc;
 
 
+/// CPU instrumentation statistics of a device context, see IDeviceContext::GetInstrumentationStats().
+struct DeviceContextInstrumentationStats
+{
+    /// The number of calls of every type, indexed by Diligent::INSTRUMENTED_CALL.
+    Uint32 CallCounts[INSTRUMENTED_CALL_COUNT] DEFAULT_INITIALIZER({});
+
+    /// Total CPU time, in nanoseconds, spent in the calls of every type,
+    /// indexed by Diligent::INSTRUMENTED_CALL.
+    Uint64 CallTimes[INSTRUMENTED_CALL_COUNT]  DEFAULT_INITIALIZER({});
+
+    /// The number of IDeviceContext::CommitShaderResources() calls that used
+    /// Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION and thus transitioned
+    /// resources implicitly. The time of these transitions is included into
+    /// the time of INSTRUMENTED_CALL_COMMIT_SHADER_RESOURCES.
+    Uint32 ImplicitTransitionCount DEFAULT_INITIALIZER(0);
+};
+typedef struct DeviceContextInstrumentationStats DeviceContextInstrumentationStats;
+
+
+/// Runtime statistics of a device context collected over one frame, see IDeviceContext::GetFrameStatistics().
+struct DeviceContextFrameStatistics
+{
+    /// The number of draw commands (Draw*, MultiDraw* and DrawMesh* calls).
+    Uint32 DrawCount                   DEFAULT_INITIALIZER(0);
+
+    /// The number of dispatch commands (DispatchCompute* and TraceRays* calls).
+    Uint32 DispatchCount               DEFAULT_INITIALIZER(0);
+
+    /// The number of pipeline states bound by IDeviceContext::SetPipelineState().
+    /// Redundant calls that set the already bound pipeline are not counted.
+    Uint32 PipelineStateBindCount      DEFAULT_INITIALIZER(0);
+
+    /// The number of IDeviceContext::CommitShaderResources() calls.
+    Uint32 SRBCommitCount              DEFAULT_INITIALIZER(0);
+
+    /// The number of resource barriers recorded into command lists.
+    /// Barriers that were merged with other barriers are not counted.
+    ///
+    /// \remarks In Direct3D11, this value is always zero.
+    ///          In OpenGL, this is the number of glMemoryBarrier calls.
+    Uint32 BarrierCount                DEFAULT_INITIALIZER(0);
+
+    /// The number of dynamic descriptors allocated by the context.
+    ///
+    /// \remarks In Direct3D12, this is the number of GPU-visible descriptors allocated from
+    ///          the dynamic part of the GPU descriptor heaps. In Vulkan, this is the number
+    ///          of dynamic descriptor sets. In Direct3D11 and OpenGL, this value is always zero.
+    Uint32 DescriptorAllocationCount   DEFAULT_INITIALIZER(0);
+
+    /// The number of bytes allocated from the dynamic heap (dynamic buffers, UpdateBuffer, etc.).
+    ///
+    /// \remarks In Direct3D11, this is the total size of dynamic buffers mapped with
+    ///          Diligent::MAP_FLAG_DISCARD flag. In OpenGL, this is the number of bytes
+    ///          streamed through the upload ring buffer.
+    Uint64 DynamicHeapBytes            DEFAULT_INITIALIZER(0);
+
+    /// The number of bytes allocated from the upload heap (texture updates, mapped textures, etc.).
+    ///
+    /// \remarks In Direct3D11 and OpenGL, this value is always zero.
+    Uint64 UploadHeapBytes             DEFAULT_INITIALIZER(0);
+
+    /// The number of stale resources in the release queue of the context's
+    /// command queue at the end of the frame. Stale resources are released
+    /// resources that have not yet been associated with a submitted command buffer.
+    ///
+    /// \remarks For deferred contexts, and in Direct3D11 and OpenGL, this value is always zero.
+    Uint32 StaleResourceCount          DEFAULT_INITIALIZER(0);
+
+    /// The number of resources in the release queue of the context's command queue
+    /// at the end of the frame that wait for the GPU to finish using them.
+    ///
+    /// \remarks For deferred contexts, and in Direct3D11 and OpenGL, this value is always zero.
+    Uint32 PendingReleaseResourceCount DEFAULT_INITIALIZER(0);
+};
+typedef struct DeviceContextFrameStatistics DeviceContextFrameStatistics;
+
+
+/// Validation level of draw and dispatch commands, see IDeviceContext::SetValidationLevel().
+DILIGENT_TYPED_ENUM(CONTEXT_VALIDATION_LEVEL, Uint8)
+{
+    /// Full validation in Debug and Development builds, no validation in Release builds.
+    CONTEXT_VALIDATION_LEVEL_DEFAULT = 0,
+
+    /// Commands are not validated.
+    CONTEXT_VALIDATION_LEVEL_OFF,
+
+    /// Cheap checks that are available in all builds: the command arguments are not null and
+    /// a pipeline of the right type, as well as the index buffer for indexed draws, is bound.
+    /// Commands that fail the checks are logged and skipped.
+    CONTEXT_VALIDATION_LEVEL_BASIC,
+
+    /// Basic checks and the full validation of the command arguments and the bound state.
+    /// The full validation is only available in Debug and Development builds;
+    /// in Release builds, this level is equivalent to CONTEXT_VALIDATION_LEVEL_BASIC.
+    CONTEXT_VALIDATION_LEVEL_FULL
+};
+
+
 /// Draw command flags
 DILIGENT_TYPED_ENUM(DRAW_FLAGS, Uint8)
 {
@@ -381,6 +479,152 @@ struct DrawIndexedAttribs
 };
 typedef struct DrawIndexedAttribs DrawIndexedAttribs;
 
+/// Multi-draw command item.
+struct MultiDrawItem
+{
+    /// The number of vertices to draw.
+    Uint32 NumVertices         DEFAULT_INITIALIZER(0);
+
+    /// LOCATION (or INDEX, but NOT the byte offset) of the first vertex in the
+    /// vertex buffer to start reading vertices from.
+    Uint32 StartVertexLocation DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure members with default values.
+    constexpr MultiDrawItem() noexcept {}
+
+    /// Initializes the structure with user-specified values.
+    constexpr MultiDrawItem(Uint32 _NumVertices,
+                            Uint32 _StartVertexLocation = 0) noexcept :
+        NumVertices        {_NumVertices        },
+        StartVertexLocation{_StartVertexLocation}
+    {}
+#endif
+};
+typedef struct MultiDrawItem MultiDrawItem;
+
+
+/// Defines the multi-draw command attributes.
+
+/// This structure is used by IDeviceContext::MultiDraw().
+struct MultiDrawAttribs
+{
+    /// The number of draw items to execute.
+    Uint32               DrawCount             DEFAULT_INITIALIZER(0);
+
+    /// A pointer to the array of DrawCount draw items, see Diligent::MultiDrawItem.
+    const MultiDrawItem* pDrawItems            DEFAULT_INITIALIZER(nullptr);
+
+    /// Additional flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS           Flags                 DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+    /// The number of instances to draw for every draw item. If more than one
+    /// instance is specified, instanced draw calls will be performed.
+    Uint32               NumInstances          DEFAULT_INITIALIZER(1);
+
+    /// LOCATION (or INDEX, but NOT the byte offset) in the vertex buffer to start
+    /// reading instance data from.
+    Uint32               FirstInstanceLocation DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure members with default values.
+    constexpr MultiDrawAttribs() noexcept {}
+
+    /// Initializes the structure with user-specified values.
+    constexpr MultiDrawAttribs(Uint32               _DrawCount,
+                               const MultiDrawItem* _pDrawItems,
+                               DRAW_FLAGS           _Flags,
+                               Uint32               _NumInstances          = 1,
+                               Uint32               _FirstInstanceLocation = 0) noexcept :
+        DrawCount            {_DrawCount            },
+        pDrawItems           {_pDrawItems           },
+        Flags                {_Flags                },
+        NumInstances         {_NumInstances         },
+        FirstInstanceLocation{_FirstInstanceLocation}
+    {}
+#endif
+};
+typedef struct MultiDrawAttribs MultiDrawAttribs;
+
+
+/// Multi-draw indexed command item.
+struct MultiDrawIndexedItem
+{
+    /// The number of indices to draw.
+    Uint32 NumIndices         DEFAULT_INITIALIZER(0);
+
+    /// LOCATION (NOT the byte offset) of the first index in
+    /// the index buffer to start reading indices from.
+    Uint32 FirstIndexLocation DEFAULT_INITIALIZER(0);
+
+    /// A constant which is added to each index before accessing the vertex buffer.
+    Uint32 BaseVertex         DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure members with default values.
+    constexpr MultiDrawIndexedItem() noexcept {}
+
+    /// Initializes the structure with user-specified values.
+    constexpr MultiDrawIndexedItem(Uint32 _NumIndices,
+                                   Uint32 _FirstIndexLocation = 0,
+                                   Uint32 _BaseVertex         = 0) noexcept :
+        NumIndices        {_NumIndices        },
+        FirstIndexLocation{_FirstIndexLocation},
+        BaseVertex        {_BaseVertex        }
+    {}
+#endif
+};
+typedef struct MultiDrawIndexedItem MultiDrawIndexedItem;
+
+
+/// Defines the indexed multi-draw command attributes.
+
+/// This structure is used by IDeviceContext::MultiDrawIndexed().
+struct MultiDrawIndexedAttribs
+{
+    /// The number of draw items to execute.
+    Uint32                      DrawCount             DEFAULT_INITIALIZER(0);
+
+    /// A pointer to the array of DrawCount draw items, see Diligent::MultiDrawIndexedItem.
+    const MultiDrawIndexedItem* pDrawItems            DEFAULT_INITIALIZER(nullptr);
+
+    /// The type of elements in the index buffer.
+    /// Allowed values: VT_UINT16 and VT_UINT32.
+    VALUE_TYPE                  IndexType             DEFAULT_INITIALIZER(VT_UNDEFINED);
+
+    /// Additional flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS                  Flags                 DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+    /// Number of instances to draw for every draw item. If more than one
+    /// instance is specified, instanced draw calls will be performed.
+    Uint32                      NumInstances          DEFAULT_INITIALIZER(1);
+
+    /// LOCATION (or INDEX, but NOT the byte offset) in the vertex
+    /// buffer to start reading instance data from.
+    Uint32                      FirstInstanceLocation DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure members with default values.
+    constexpr MultiDrawIndexedAttribs() noexcept {}
+
+    /// Initializes the structure members with user-specified values.
+    constexpr MultiDrawIndexedAttribs(Uint32                      _DrawCount,
+                                      const MultiDrawIndexedItem* _pDrawItems,
+                                      VALUE_TYPE                  _IndexType,
+                                      DRAW_FLAGS                  _Flags,
+                                      Uint32                      _NumInstances          = 1,
+                                      Uint32                      _FirstInstanceLocation = 0) noexcept :
+        DrawCount            {_DrawCount            },
+        pDrawItems           {_pDrawItems           },
+        IndexType            {_IndexType            },
+        Flags                {_Flags                },
+        NumInstances         {_NumInstances         },
+        FirstInstanceLocation{_FirstInstanceLocation}
+    {}
+#endif
+};
+typedef struct MultiDrawIndexedAttribs MultiDrawIndexedAttribs;
+
 
 /// Defines the indirect draw command attributes.
 
@@ -976,6 +1220,23 @@ struct SetRenderTargetsAttribs
     /// and shading rate map being set (see Diligent::RESOURCE_STATE_TRANSITION_MODE).
     RESOURCE_STATE_TRANSITION_MODE StateTransitionMode  DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
 
+    /// Indicates that the contents of the depth-stencil buffer are not needed after
+    /// the render targets are changed or unbound, for instance, when the depth buffer is
+    /// not sampled later.
+
+    /// On tile-based GPUs, this allows the engine to not write the depth-stencil buffer back
+    /// to memory at the end of the implicit render pass:
+    /// - In Vulkan, the implicit render pass uses ATTACHMENT_STORE_OP_DISCARD for the depth-stencil attachment.
+    /// - In OpenGL, the depth-stencil attachment is invalidated with glInvalidateFramebuffer()
+    ///   before the render targets are changed or unbound.
+    ///
+    /// Other backends ignore this member.
+    ///
+    /// \remarks   In Vulkan, the implicit render pass may be interrupted by commands that must be recorded
+    ///            outside of a render pass, such as resource state transitions, copies or dispatches. After
+    ///            such commands, the contents of the discarded depth-stencil buffer are undefined.
+    Bool                           DiscardDepthStencil  DEFAULT_INITIALIZER(False);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr SetRenderTargetsAttribs() noexcept {}
 
@@ -1254,6 +1515,35 @@ struct BuildBLASAttribs
 typedef struct BuildBLASAttribs BuildBLASAttribs;
 
 
+/// This structure is used by IDeviceContext::BuildBLASBatch().
+struct BuildBLASBatchAttribs
+{
+    /// A pointer to an array of BuildCount BuildBLASAttribs structures that describe the builds.
+    /// If pBuilds[i].pScratchBuffer is null, the scratch memory for the build is suballocated
+    /// from the scratch buffer owned by the device context, and ScratchBufferOffset and
+    /// ScratchBufferTransitionMode are ignored.
+    /// All target BLASes must be distinct, and scratch memory ranges that are provided by
+    /// the application must not overlap.
+    const BuildBLASAttribs*        pBuilds                           DEFAULT_INITIALIZER(nullptr);
+
+    /// The number of elements in pBuilds array.
+    Uint32                         BuildCount                        DEFAULT_INITIALIZER(0);
+
+    /// An optional buffer into which the compacted sizes of the BLASes are written after the batch is built.
+    /// A 64-bit compacted size of pBuilds[i].pBLAS is written at CompactedSizeBufferOffset + i * sizeof(Uint64).
+    /// All BLASes must be created with RAYTRACING_BUILD_AS_ALLOW_COMPACTION flag.
+    /// In Direct3D12, the buffer must be created with BIND_UNORDERED_ACCESS flag.
+    IBuffer*                       pCompactedSizeBuffer              DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset from the beginning of pCompactedSizeBuffer to the location of the first compacted size.
+    Uint64                         CompactedSizeBufferOffset         DEFAULT_INITIALIZER(0);
+
+    /// Compacted size buffer state transition mode (see Diligent::RESOURCE_STATE_TRANSITION_MODE).
+    RESOURCE_STATE_TRANSITION_MODE CompactedSizeBufferTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+};
+typedef struct BuildBLASBatchAttribs BuildBLASBatchAttribs;
+
+
 /// Can be used to calculate the TLASBuildInstanceData::ContributionToHitGroupIndex depending on instance count,
 /// geometry count in each instance (in TLASBuildInstanceData::pBLAS) and shader binding mode in BuildTLASAttribs::BindingMode.
 ///
@@ -1434,6 +1724,14 @@ struct BuildTLASAttribs
     /// pTLAS must be created with RAYTRACING_BUILD_AS_ALLOW_UPDATE flag.
     /// An update will be faster than building an acceleration structure from scratch.
     Bool                            Update                        DEFAULT_INITIALIZER(False);
+
+    /// If true, the TLAS keeps a CPU copy of the instance data uploaded to the instance buffer,
+    /// and updates only upload the instances that changed since the previous build,
+    /// which substantially reduces the upload size for large scenes where few instances change.
+    /// All builds of the TLAS must use the same pInstanceBuffer and InstanceBufferOffset, and
+    /// the instance buffer region must not be modified by other commands between the builds.
+    /// If the buffer region is different from the previous build, all instances are uploaded.
+    Bool                            UploadChangedInstancesOnly    DEFAULT_INITIALIZER(False);
 };
 typedef struct BuildTLASAttribs BuildTLASAttribs;
 
@@ -1867,6 +2165,67 @@ struct BindSparseResourceMemoryAttribs
 };
 typedef struct BindSparseResourceMemoryAttribs BindSparseResourceMemoryAttribs;
 
+
+/// This structure is used by IDeviceContext::ResolveQueryArray().
+struct ResolveQueryArrayAttribs
+{
+    /// Query array whose results are resolved.
+    IQueryArray*                   pQueryArray             DEFAULT_INITIALIZER(nullptr);
+
+    /// The index of the first query to resolve.
+    Uint32                         FirstQuery              DEFAULT_INITIALIZER(0);
+
+    /// The number of queries to resolve.
+    Uint32                         NumQueries              DEFAULT_INITIALIZER(0);
+
+    /// The destination buffer. The results are written tightly packed,
+    /// IQueryArray::GetQueryDataStride() bytes per query.
+    IBuffer*                       pDstBuffer              DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset from the beginning of the buffer to the location of the result of the first query.
+    /// Must be a multiple of 8.
+    Uint64                         DstOffset               DEFAULT_INITIALIZER(0);
+
+    /// Destination buffer state transition mode (see Diligent::RESOURCE_STATE_TRANSITION_MODE).
+    /// The buffer is transitioned to RESOURCE_STATE_COPY_DEST state.
+    RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr ResolveQueryArrayAttribs() noexcept {}
+
+    constexpr ResolveQueryArrayAttribs(IQueryArray*                   _pQueryArray,
+                                       Uint32                         _FirstQuery,
+                                       Uint32                         _NumQueries,
+                                       IBuffer*                       _pDstBuffer,
+                                       Uint64                         _DstOffset               = ResolveQueryArrayAttribs{}.DstOffset,
+                                       RESOURCE_STATE_TRANSITION_MODE _DstBufferTransitionMode = ResolveQueryArrayAttribs{}.DstBufferTransitionMode) noexcept :
+        pQueryArray            {_pQueryArray            },
+        FirstQuery             {_FirstQuery             },
+        NumQueries             {_NumQueries             },
+        pDstBuffer             {_pDstBuffer             },
+        DstOffset              {_DstOffset              },
+        DstBufferTransitionMode{_DstBufferTransitionMode}
+    {}
+#endif
+};
+typedef struct ResolveQueryArrayAttribs ResolveQueryArrayAttribs;
+
+
+/// Defines how the predicate value is interpreted by IDeviceContext::SetPredication()
+/// and IDeviceContext::SetQueryPredication().
+DILIGENT_TYPED_ENUM(PREDICATION_OP, Uint8)
+{
+    /// Rendering commands are skipped if the predicate value is zero.
+    /// This is the operation that is typically used with occlusion query results:
+    /// objects whose bounding volume had no visible samples are not drawn.
+    PREDICATION_OP_SKIP_IF_ZERO = 0,
+
+    /// Rendering commands are skipped if the predicate value is not zero.
+    PREDICATION_OP_SKIP_IF_NOT_ZERO,
+
+    PREDICATION_OP_LAST = PREDICATION_OP_SKIP_IF_NOT_ZERO
+};
+
 /// Special constant for all remaining mipmap levels.
 #define DILIGENT_REMAINING_MIP_LEVELS 0xFFFFFFFFU
 
@@ -1897,7 +2256,12 @@ DILIGENT_TYPED_ENUM(STATE_TRANSITION_FLAGS, Uint8)
     STATE_TRANSITION_FLAG_DISCARD_CONTENT = 1u << 1,
 
     /// Indicates state transition between aliased resources that share the same memory.
-    /// Currently it is only supported for sparse resources that were created with aliasing flag.
+    /// It is supported for sparse resources that were created with aliasing flag, and
+    /// for placed resources created in the same DEVICE_MEMORY_TYPE_PLACED memory object
+    /// (see TextureData::pMemory and BufferData::pMemory).
+    ///
+    /// \note  The content of the after-resource is undefined. In Vulkan, the state of the
+    ///        after-texture is reset to RESOURCE_STATE_UNDEFINED if it is known to the engine.
     STATE_TRANSITION_FLAG_ALIASING        = 1u << 2
 };
 DEFINE_FLAG_ENUM_OPERATORS(STATE_TRANSITION_FLAGS);
@@ -2070,6 +2434,34 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
     VIRTUAL void METHOD(Begin)(THIS_
                                Uint32 ImmediateContextId) PURE;
 
+    /// Begins recording a reusable command list in the deferred context.
+
+    /// \param [in] ImmediateContextId - the ID of the immediate context where commands from this
+    ///                                  deferred context will be executed,
+    ///                                  see Diligent::DeviceContextDesc::ContextId.
+    ///
+    /// Unlike command lists recorded after IDeviceContext::Begin(), a command list recorded after this
+    /// method may be submitted to the immediate context identified by ImmediateContextId any number of times,
+    /// including multiple times within the same frame. The command list stays valid until it is released.
+    ///
+    /// \remarks Resource states are validated and transitioned when the commands are recorded, not when
+    ///          the command list is executed. The application must use
+    ///          Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY or Diligent::RESOURCE_STATE_TRANSITION_MODE_NONE
+    ///          for all commands, make sure that all resources are in the expected states before
+    ///          every execution, and keep all resources referenced by the command list alive
+    ///          while it may be executed.
+    ///
+    ///          Reusable command lists must not use dynamic buffers, dynamic shader resource variables,
+    ///          queries, or commands that allocate transient memory (IDeviceContext::UpdateBuffer(),
+    ///          IDeviceContext::UpdateTexture(), Map with MAP_FLAG_DISCARD, etc.) because
+    ///          this memory is recycled once the frame is finished.
+    ///
+    /// \remarks In Direct3D11, the native command list is replayed. In Direct3D12 and Vulkan,
+    ///          the closed command list (command buffer recorded with VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT)
+    ///          is resubmitted. Deferred contexts are not supported in OpenGL.
+    VIRTUAL void METHOD(BeginReusable)(THIS_
+                                       Uint32 ImmediateContextId) PURE;
+
     /// Sets the pipeline state.
 
     /// \param [in] pPipelineState - Pointer to IPipelineState interface to bind to the context.
@@ -2494,6 +2886,46 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                           const DrawMeshIndirectAttribs REF Attribs) PURE;
 
 
+    /// Executes a batch of draw commands.
+
+    /// \param [in] Attribs - Multi-draw command attributes, see Diligent::MultiDrawAttribs for details.
+    ///
+    /// \remarks  The command is equivalent to calling IDeviceContext::Draw() for every draw item,
+    ///           but the arguments are validated and the pipeline state and shader resources
+    ///           are committed only once for the whole batch.
+    ///           If the device supports Diligent::DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW capability,
+    ///           the batch is executed by a single native multi-draw command. Otherwise, the
+    ///           backend issues one draw call per item.
+    ///
+    ///           If Diligent::DRAW_FLAG_VERIFY_STATES flag is set, the method reads the state of vertex
+    ///           buffers, so no other threads are allowed to alter the states of the same resources.
+    ///           It is OK to read these states.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(MultiDraw)(THIS_
+                                   const MultiDrawAttribs REF Attribs) PURE;
+
+
+    /// Executes a batch of indexed draw commands.
+
+    /// \param [in] Attribs - Multi-draw command attributes, see Diligent::MultiDrawIndexedAttribs for details.
+    ///
+    /// \remarks  The command is equivalent to calling IDeviceContext::DrawIndexed() for every draw item,
+    ///           but the arguments are validated and the pipeline state, shader resources and
+    ///           the index buffer are committed only once for the whole batch.
+    ///           If the device supports Diligent::DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW capability,
+    ///           the batch is executed by a single native multi-draw command. Otherwise, the
+    ///           backend issues one draw call per item.
+    ///
+    ///           If Diligent::DRAW_FLAG_VERIFY_STATES flag is set, the method reads the state of vertex/index
+    ///           buffers, so no other threads are allowed to alter the states of the same resources.
+    ///           It is OK to read these states.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(MultiDrawIndexed)(THIS_
+                                          const MultiDrawIndexedAttribs REF Attribs) PURE;
+
+
     /// Executes a dispatch compute command.
 
     /// \param [in] Attribs - Dispatch command attributes, see Diligent::DispatchComputeAttribs for details.
@@ -2606,6 +3038,11 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
     ///          state. When using Diligent::RESOURCE_STATE_TRANSITION_TRANSITION mode, the engine takes care of proper
     ///          resource state transition, otherwise it is the responsibility of the application.
     ///
+    /// \note    In Vulkan backend, clearing a bound render target before the implicit render pass has been started
+    ///          (i.e. before the first draw command after IDeviceContext::SetRenderTargets) is deferred until the
+    ///          render pass begins, and is performed by its ATTACHMENT_LOAD_OP_CLEAR load operation. The same
+    ///          applies to IDeviceContext::ClearDepthStencil.
+    ///
     /// \remarks Supported contexts: graphics.
     VIRTUAL void METHOD(ClearRenderTarget)(THIS_
                                            ITextureView*                  pView,
@@ -2624,7 +3061,8 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
 
     /// \param [in] NumCommandLists - The number of command lists to execute.
     /// \param [in] ppCommandLists  - Pointer to the array of NumCommandLists command lists to execute.
-    /// \remarks After a command list is executed, it is no longer valid and must be released.
+    /// \remarks After a command list is executed, it is no longer valid and must be released,
+    ///          unless it was recorded after IDeviceContext::BeginReusable().
     VIRTUAL void METHOD(ExecuteCommandLists)(THIS_
                                              Uint32               NumCommandLists,
                                              ICommandList* const* ppCommandLists) PURE;
@@ -3205,6 +3643,256 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
     ///          internal queue supports COMMAND_QUEUE_TYPE_SPARSE_BINDING.
     VIRTUAL void METHOD(BindSparseResourceMemory)(THIS_
                                                   const BindSparseResourceMemoryAttribs REF Attribs) PURE;
+
+
+    /// Returns the CPU instrumentation statistics of the last finished frame.
+
+    /// \param [out] Stats - Statistics of the calls made between the last two
+    ///                      IDeviceContext::FinishFrame() calls, see Diligent::DeviceContextInstrumentationStats.
+    ///
+    /// \remarks   The statistics are only collected when the engine is built with
+    ///            DILIGENT_ENABLE_INSTRUMENTATION CMake option. Otherwise, all values are zero.
+    ///
+    ///            The instrumentation events are also forwarded to EngineCreateInfo::InstrumentationSink.
+    VIRTUAL void METHOD(GetInstrumentationStats)(THIS_
+                                                 DeviceContextInstrumentationStats REF Stats) CONST PURE;
+
+
+    /// Returns the runtime statistics of the last finished frame.
+
+    /// \param [out] Stats - Statistics of the commands recorded between the last two
+    ///                      IDeviceContext::FinishFrame() calls, see Diligent::DeviceContextFrameStatistics.
+    ///
+    /// \remarks   Unlike instrumentation statistics, frame statistics are always collected.
+    ///            For deferred contexts, the values refer to the commands recorded by the context.
+    ///            In OpenGL, commands of deferred contexts are counted by the immediate context
+    ///            that executes them.
+    VIRTUAL void METHOD(GetFrameStatistics)(THIS_
+                                            DeviceContextFrameStatistics REF Stats) CONST PURE;
+
+
+    /// Builds a batch of bottom-level acceleration structures.
+
+    /// \param [in] Attribs - Structure describing the batch, see Diligent::BuildBLASBatchAttribs for details.
+    ///
+    /// \remarks  The builds are recorded as a single group: resource state transitions of all builds
+    ///           are issued together before the first build, and in Vulkan all builds are
+    ///           submitted with one command. Builds that do not provide a scratch buffer share
+    ///           the scratch buffer owned by the context, which grows as needed and is reused
+    ///           by subsequent batches.
+    ///
+    /// \note Don't call build or copy operation on the same BLAS in a different contexts, because BLAS has CPU-side data
+    ///       that will not match with GPU-side, so shader binding were incorrect.
+    ///
+    /// \remarks Supported contexts: graphics, compute.
+    VIRTUAL void METHOD(BuildBLASBatch)(THIS_
+                                        const BuildBLASBatchAttribs REF Attribs) PURE;
+
+
+    /// Generates mipmaps for a batch of texture views.
+
+    /// \param [in] ppTextureViews - Array of NumViews shader resource views to generate mipmaps for.
+    ///                              Every view must meet the requirements of IDeviceContext::GenerateMips().
+    /// \param [in] NumViews       - The number of views in ppTextureViews array.
+    ///
+    /// \remarks  The result is the same as calling GenerateMips() for every view, but in Direct3D12 and
+    ///           Vulkan the work is recorded as one group: the views are sorted by format and size, and
+    ///           the mip chains of all textures are processed level by level, so that the state transitions
+    ///           of all textures are issued together for every level and pipeline and root signature
+    ///           changes are minimized.
+    ///
+    ///           Views in the batch must not reference overlapping subresources of the same texture.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(GenerateMipsBatch)(THIS_
+                                           ITextureView* const* ppTextureViews,
+                                           Uint32               NumViews) PURE;
+
+
+    /// Sets the validation level of draw and dispatch commands.
+
+    /// \param [in] Level            - Validation level, see Diligent::CONTEXT_VALIDATION_LEVEL.
+    /// \param [in] SamplingInterval - The interval at which the commands are fully validated when Level is
+    ///                                CONTEXT_VALIDATION_LEVEL_FULL: only every SamplingInterval-th draw or dispatch
+    ///                                command is fully validated, while the basic checks are performed for
+    ///                                all commands. Zero or one means that every command is fully validated.
+    ///
+    /// \remarks Sampling lets development builds keep most of the validation coverage over several frames
+    ///          at a fraction of the CPU cost.
+    ///
+    ///          The level only affects draw and dispatch commands, which are executed most often.
+    ///          Other commands are always validated in Debug and Development builds.
+    VIRTUAL void METHOD(SetValidationLevel)(THIS_
+                                            CONTEXT_VALIDATION_LEVEL Level,
+                                            Uint32                   SamplingInterval DEFAULT_VALUE(1)) PURE;
+
+
+    /// Returns the validation level of the context.
+
+    /// \remarks CONTEXT_VALIDATION_LEVEL_DEFAULT and the levels that are not available
+    ///          in the current build are resolved to the level that is actually used.
+    VIRTUAL CONTEXT_VALIDATION_LEVEL METHOD(GetValidationLevel)(THIS) CONST PURE;
+
+
+    /// Begins the query with the given index in the query array.
+
+    /// \param [in] pQueryArray - Query array. Timestamp query arrays can't be begun, see EndIndexedQuery().
+    /// \param [in] Index       - The index of the query in the array.
+    ///
+    /// \remarks    The same rules as for IDeviceContext::BeginQuery() apply: only one query of each type
+    ///             may be active at a time, and a query that is begun inside a render pass must be ended
+    ///             in the same render pass.
+    ///
+    ///             Unlike regular queries, query array queries are not allocated from the context's
+    ///             query pools and can't be read on the CPU: their results must be written to a buffer
+    ///             with ResolveQueryArray() before the query is begun again.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(BeginIndexedQuery)(THIS_
+                                           IQueryArray* pQueryArray,
+                                           Uint32       Index) PURE;
+
+
+    /// Ends the query with the given index in the query array.
+
+    /// \param [in] pQueryArray - Query array.
+    /// \param [in] Index       - The index of the query in the array.
+    ///
+    /// \remarks    For timestamp query arrays, this writes the timestamp.
+    ///
+    /// \remarks Supported contexts for timestamp query arrays: graphics, compute.
+    ///          Supported contexts for other query types: graphics.
+    VIRTUAL void METHOD(EndIndexedQuery)(THIS_
+                                         IQueryArray* pQueryArray,
+                                         Uint32       Index) PURE;
+
+
+    /// Writes the results of a range of queries in the query array to a buffer.
+
+    /// \param [in] Attribs - Resolve command attributes, see Diligent::ResolveQueryArrayAttribs for details.
+    ///
+    /// \remarks    All queries in the range must have been ended. The results are written
+    ///             by the GPU without a CPU round trip, so that they can be consumed by subsequent
+    ///             GPU commands, e.g. as the predicate of SetPredication(), as indirect draw arguments
+    ///             or by a compute shader that culls the objects. The buffer may also be copied to a
+    ///             staging buffer to read the results on the CPU.
+    ///
+    ///             After the results are resolved, the queries may be begun again.
+    ///
+    ///             The command must be performed outside of a render pass.
+    ///
+    /// \remarks Supported contexts: graphics for occlusion and pipeline statistics queries;
+    ///          graphics and compute for timestamp queries.
+    VIRTUAL void METHOD(ResolveQueryArray)(THIS_
+                                           const ResolveQueryArrayAttribs REF Attribs) PURE;
+
+
+    /// Sets the predicate that conditionally skips subsequent rendering commands.
+
+    /// \param [in] pBuffer - Buffer that contains the predicate, or null to disable predication.
+    ///                       The buffer must have been created with BIND_INDIRECT_DRAW_ARGS flag and
+    ///                       must be in RESOURCE_STATE_INDIRECT_ARGUMENT state.
+    /// \param [in] Offset  - Offset of the predicate in the buffer. Must be a multiple of 8.
+    /// \param [in] Op      - Predication operation, see Diligent::PREDICATION_OP.
+    ///
+    /// \remarks    The predicate is typically the result of an occlusion query written by ResolveQueryArray().
+    ///             While predication is enabled, draw and dispatch commands are skipped by the GPU
+    ///             depending on the predicate value, so that occluded objects are not drawn without
+    ///             reading the query results back on the CPU.
+    ///
+    ///             Direct3D12 interprets the predicate as a 64-bit value; Vulkan reads the 32-bit value
+    ///             at the given offset, so that the predicate must be less than 2^32: use binary
+    ///             occlusion queries or clamp the sample count.
+    ///
+    ///             The predication state is not preserved across command lists and is reset by Flush().
+    ///             Predication must be set and disabled outside of a render pass.
+    ///
+    ///             Predication is supported if the device reports Diligent::DRAW_COMMAND_CAP_FLAG_PREDICATION
+    ///             capability: in Direct3D12, and in Vulkan when VK_EXT_conditional_rendering extension is
+    ///             available. Otherwise, the commands are executed unconditionally.
+    ///
+    /// \remarks Supported contexts: graphics, compute.
+    VIRTUAL void METHOD(SetPredication)(THIS_
+                                        IBuffer*       pBuffer,
+                                        Uint64         Offset,
+                                        PREDICATION_OP Op DEFAULT_VALUE(PREDICATION_OP_SKIP_IF_ZERO)) PURE;
+
+
+    /// Sets the occlusion query whose result conditionally skips subsequent rendering commands.
+
+    /// \param [in] pQuery - Binary occlusion query that has been ended, or null to disable predication.
+    /// \param [in] Op     - Predication operation, see Diligent::PREDICATION_OP. The predicate
+    ///                      value is non-zero if any sample passed the depth and stencil tests.
+    ///
+    /// \remarks    This is the query-based counterpart of SetPredication() for the backends that can't
+    ///             use a buffer as the predicate. The GPU uses the query result directly, so that the
+    ///             result does not need to be read back on the CPU.
+    ///
+    ///             In OpenGL, the GPU waits for the query result before executing the commands.
+    ///             Direct3D11 executes the commands unconditionally if the result is not available yet.
+    ///
+    ///             Predication stays enabled until it is disabled by passing null or replaced by
+    ///             another query. The query must not be begun while it is used as the predicate.
+    ///
+    ///             Query predication is supported if the device reports Diligent::DRAW_COMMAND_CAP_FLAG_QUERY_PREDICATION
+    ///             capability: in Direct3D11 and in desktop OpenGL. PREDICATION_OP_SKIP_IF_NOT_ZERO requires
+    ///             OpenGL 4.5 or GL_ARB_conditional_render_inverted extension.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(SetQueryPredication)(THIS_
+                                             IQuery*        pQuery,
+                                             PREDICATION_OP Op DEFAULT_VALUE(PREDICATION_OP_SKIP_IF_ZERO)) PURE;
+
+
+    /// Sets the cull mode of the current pipeline.
+
+    /// \param [in] CullMode - Cull mode, see Diligent::CULL_MODE.
+    ///
+    /// \remarks    The current pipeline must be created with PIPELINE_DYNAMIC_STATE_FLAG_CULL_MODE flag,
+    ///             which requires DeviceFeatures::ExtendedDynamicState feature.
+    ///
+    ///             Binding a different pipeline resets the state to the value of
+    ///             GraphicsPipelineDesc::RasterizerDesc.CullMode of that pipeline.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(SetCullMode)(THIS_
+                                     CULL_MODE CullMode) PURE;
+
+
+    /// Sets the depth and stencil tests of the current pipeline.
+
+    /// \param [in] DSSDesc - Depth-stencil state description.
+    ///
+    /// \remarks    Depth test enable, depth write enable and depth function are set if the current pipeline
+    ///             was created with PIPELINE_DYNAMIC_STATE_FLAG_DEPTH flag.
+    ///             Stencil test enable, stencil masks and stencil operations of both faces are set if the
+    ///             current pipeline was created with PIPELINE_DYNAMIC_STATE_FLAG_STENCIL flag.
+    ///             The members that correspond to the states that are not dynamic are ignored.
+    ///             Dynamic states require DeviceFeatures::ExtendedDynamicState feature.
+    ///
+    ///             Binding a different pipeline resets the states to the values of
+    ///             GraphicsPipelineDesc::DepthStencilDesc of that pipeline.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(SetDepthStencilState)(THIS_
+                                              const DepthStencilStateDesc REF DSSDesc) PURE;
+
+
+    /// Sets the primitive topology of the current pipeline.
+
+    /// \param [in] Topology - Primitive topology, see Diligent::PRIMITIVE_TOPOLOGY.
+    ///
+    /// \remarks    The current pipeline must be created with PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY flag,
+    ///             which requires DeviceFeatures::ExtendedDynamicState feature. The topology must be of the same
+    ///             class (point, line, triangle or patch list) as GraphicsPipelineDesc::PrimitiveTopology.
+    ///             For patch lists, the number of control points must be the same.
+    ///
+    ///             Binding a different pipeline resets the state to the value of
+    ///             GraphicsPipelineDesc::PrimitiveTopology of that pipeline.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(SetPrimitiveTopology)(THIS_
+                                              PRIMITIVE_TOPOLOGY Topology) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -3216,6 +3904,7 @@ DILIGENT_END_INTERFACE
 
 #    define IDeviceContext_GetDesc(This)                            CALL_IFACE_METHOD(DeviceContext, GetDesc,                   This)
 #    define IDeviceContext_Begin(This, ...)                         CALL_IFACE_METHOD(DeviceContext, Begin,                     This, __VA_ARGS__)
+#    define IDeviceContext_BeginReusable(This, ...)                 CALL_IFACE_METHOD(DeviceContext, BeginReusable,             This, __VA_ARGS__)
 #    define IDeviceContext_SetPipelineState(This, ...)              CALL_IFACE_METHOD(DeviceContext, SetPipelineState,          This, __VA_ARGS__)
 #    define IDeviceContext_TransitionShaderResources(This, ...)     CALL_IFACE_METHOD(DeviceContext, TransitionShaderResources, This, __VA_ARGS__)
 #    define IDeviceContext_CommitShaderResources(This, ...)         CALL_IFACE_METHOD(DeviceContext, CommitShaderResources,     This, __VA_ARGS__)
@@ -3237,6 +3926,8 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_DrawIndexedIndirect(This, ...)           CALL_IFACE_METHOD(DeviceContext, DrawIndexedIndirect,       This, __VA_ARGS__)
 #    define IDeviceContext_DrawMesh(This, ...)                      CALL_IFACE_METHOD(DeviceContext, DrawMesh,                  This, __VA_ARGS__)
 #    define IDeviceContext_DrawMeshIndirect(This, ...)              CALL_IFACE_METHOD(DeviceContext, DrawMeshIndirect,          This, __VA_ARGS__)
+#    define IDeviceContext_MultiDraw(This, ...)                     CALL_IFACE_METHOD(DeviceContext, MultiDraw,                 This, __VA_ARGS__)
+#    define IDeviceContext_MultiDrawIndexed(This, ...)              CALL_IFACE_METHOD(DeviceContext, MultiDrawIndexed,          This, __VA_ARGS__)
 #    define IDeviceContext_DispatchCompute(This, ...)               CALL_IFACE_METHOD(DeviceContext, DispatchCompute,           This, __VA_ARGS__)
 #    define IDeviceContext_DispatchComputeIndirect(This, ...)       CALL_IFACE_METHOD(DeviceContext, DispatchComputeIndirect,   This, __VA_ARGS__)
 #    define IDeviceContext_DispatchTile(This, ...)                  CALL_IFACE_METHOD(DeviceContext, DispatchTile,              This, __VA_ARGS__)
@@ -3282,6 +3973,20 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_UnlockCommandQueue(This)                 CALL_IFACE_METHOD(DeviceContext, UnlockCommandQueue,        This)
 #    define IDeviceContext_SetShadingRate(This, ...)                CALL_IFACE_METHOD(DeviceContext, SetShadingRate,            This, __VA_ARGS__)
 #    define IDeviceContext_BindSparseResourceMemory(This, ...)      CALL_IFACE_METHOD(DeviceContext, BindSparseResourceMemory,  This, __VA_ARGS__)
+#    define IDeviceContext_GetInstrumentationStats(This, ...)       CALL_IFACE_METHOD(DeviceContext, GetInstrumentationStats,   This, __VA_ARGS__)
+#    define IDeviceContext_GetFrameStatistics(This, ...)            CALL_IFACE_METHOD(DeviceContext, GetFrameStatistics,        This, __VA_ARGS__)
+#    define IDeviceContext_BuildBLASBatch(This, ...)                CALL_IFACE_METHOD(DeviceContext, BuildBLASBatch,            This, __VA_ARGS__)
+#    define IDeviceContext_GenerateMipsBatch(This, ...)             CALL_IFACE_METHOD(DeviceContext, GenerateMipsBatch,         This, __VA_ARGS__)
+#    define IDeviceContext_SetValidationLevel(This, ...)            CALL_IFACE_METHOD(DeviceContext, SetValidationLevel,        This, __VA_ARGS__)
+#    define IDeviceContext_GetValidationLevel(This)                 CALL_IFACE_METHOD(DeviceContext, GetValidationLevel,        This)
+#    define IDeviceContext_BeginIndexedQuery(This, ...)             CALL_IFACE_METHOD(DeviceContext, BeginIndexedQuery,         This, __VA_ARGS__)
+#    define IDeviceContext_EndIndexedQuery(This, ...)               CALL_IFACE_METHOD(DeviceContext, EndIndexedQuery,           This, __VA_ARGS__)
+#    define IDeviceContext_ResolveQueryArray(This, ...)             CALL_IFACE_METHOD(DeviceContext, ResolveQueryArray,         This, __VA_ARGS__)
+#    define IDeviceContext_SetPredication(This, ...)                CALL_IFACE_METHOD(DeviceContext, SetPredication,            This, __VA_ARGS__)
+#    define IDeviceContext_SetQueryPredication(This, ...)           CALL_IFACE_METHOD(DeviceContext, SetQueryPredication,       This, __VA_ARGS__)
+#    define IDeviceContext_SetCullMode(This, ...)                   CALL_IFACE_METHOD(DeviceContext, SetCullMode,               This, __VA_ARGS__)
+#    define IDeviceContext_SetDepthStencilState(This, ...)          CALL_IFACE_METHOD(DeviceContext, SetDepthStencilState,      This, __VA_ARGS__)
+#    define IDeviceContext_SetPrimitiveTopology(This, ...)          CALL_IFACE_METHOD(DeviceContext, SetPrimitiveTopology,      This, __VA_ARGS__)
 
 // clang-format on
 
@@ -48,6 +48,14 @@ DILIGENT_TYPED_ENUM(DEVICE_MEMORY_TYPE, Uint8)
 
     /// Indicates that memory will be used for sparse resources.
     DEVICE_MEMORY_TYPE_SPARSE    = 1,
+
+    /// Indicates that memory will be used for placed resources, i.e.
+    /// regular USAGE_DEFAULT textures and buffers that are created at an
+    /// offset in the memory object (see TextureData::pMemory and BufferData::pMemory).
+    /// Placed resources whose memory ranges overlap alias each other.
+    ///
+    /// \remarks Supported in Direct3D12 and Vulkan backends.
+    DEVICE_MEMORY_TYPE_PLACED    = 2,
 };
 
 /// Device memory description
@@ -98,8 +106,11 @@ struct DeviceMemoryCreateInfo
 
     /// An array of NumResources resources that this memory must be compatible with.
     /// For sparse memory, only USAGE_SPARSE buffer and texture resources are allowed.
+    /// For placed memory, only USAGE_DEFAULT buffer and texture resources are allowed;
+    /// the resources are only used to determine memory properties and are not placed in the memory.
     /// 
-    /// \note Vulkan backend requires at least one resource to be provided.
+    /// \note Vulkan backend requires at least one resource to be provided for sparse memory.
+    ///       For placed memory, the list is optional, and if it is empty, the device-local memory type is used.
     ///
     ///       In Direct3D12, the list of resources is optional on D3D12_RESOURCE_HEAP_TIER_2-hardware
     ///       and above, but is required on D3D12_RESOURCE_HEAP_TIER_1-hardware
@@ -112,6 +123,18 @@ struct DeviceMemoryCreateInfo
 };
 typedef struct DeviceMemoryCreateInfo DeviceMemoryCreateInfo;
 
+/// Memory requirements of a placed resource, see IRenderDevice::GetTextureMemoryRequirements()
+/// and IRenderDevice::GetBufferMemoryRequirements().
+struct ResourceMemoryRequirements
+{
+    /// The size of the memory range the resource occupies, in bytes.
+    Uint64  Size       DEFAULT_INITIALIZER(0);
+
+    /// The required alignment of the resource offset in the memory, in bytes.
+    Uint64  Alignment  DEFAULT_INITIALIZER(0);
+};
+typedef struct ResourceMemoryRequirements ResourceMemoryRequirements;
+
 // clang-format on
 
 #define DILIGENT_INTERFACE_NAME IDeviceMemory
@@ -142,6 +165,8 @@ DILIGENT_BEGIN_INTERFACE(IDeviceMemory, IDeviceObject)
     ///
     /// \remarks  This method must be externally synchronized with IDeviceMemory::GetCapacity()
     ///           and IDeviceContext::BindSparseResourceMemory().
+    ///
+    /// \remarks  For placed memory, the pages that are occupied by placed resources must not be released.
     VIRTUAL Bool METHOD(Resize)(THIS_
                                 Uint64 NewSize) PURE;
 
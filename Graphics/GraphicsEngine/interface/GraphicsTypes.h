@@ -1478,6 +1478,30 @@ struct SwapChainDesc
     /// for the primary swap chain, the engine releases stale resources.
     Bool  IsPrimary                     DEFAULT_INITIALIZER(true);
 
+    /// Enables the low-latency presentation mode.
+
+    /// In this mode, Present() does not block to limit the number of frames queued
+    /// for presentation. Instead, the application calls ISwapChain::WaitForFrame()
+    /// every frame right before it samples the user input, which minimizes the
+    /// input-to-photon latency.
+    ///
+    /// \remarks   In Direct3D11 and Direct3D12 backends, the mode uses the frame latency
+    ///            waitable object of the DXGI swap chain. In Vulkan backend, the mode uses
+    ///            VK_KHR_present_wait and VK_KHR_present_id extensions when they are supported,
+    ///            and waits for the swap chain image to be acquired otherwise.
+    Bool  LowLatencyMode                DEFAULT_INITIALIZER(false);
+
+    /// Presents the frames and acquires the next images on a dedicated thread.
+
+    /// When the presentation engine blocks, e.g. because the compositor is busy, Present()
+    /// returns without waiting. The render thread only waits for the next image when it
+    /// first accesses the back buffer, e.g. through ISwapChain::GetCurrentBackBufferRTV().
+    /// Together with EngineCreateInfo::AsyncCommandSubmission, this keeps the render thread
+    /// from blocking in the window system integration.
+    ///
+    /// \remarks   Only Vulkan backend supports this option. Other backends ignore it.
+    Bool  AsyncPresent                  DEFAULT_INITIALIZER(false);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr SwapChainDesc() noexcept
     {
@@ -1771,6 +1795,12 @@ struct DeviceFeatures
     /// Indicates if device supports texture component swizzle.
     DEVICE_FEATURE_STATE TextureComponentSwizzle DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
 
+    /// Indicates if device supports extended dynamic states, see PIPELINE_DYNAMIC_STATE_FLAGS.
+
+    /// \remarks    The feature is currently only supported in Vulkan through
+    ///             VK_EXT_extended_dynamic_state extension.
+    DEVICE_FEATURE_STATE ExtendedDynamicState DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr DeviceFeatures() noexcept {}
 
@@ -1815,11 +1845,12 @@ struct DeviceFeatures
     Handler(VariableRateShading)               \
     Handler(SparseResources)                   \
     Handler(SubpassFramebufferFetch)           \
-    Handler(TextureComponentSwizzle)
+    Handler(TextureComponentSwizzle)           \
+    Handler(ExtendedDynamicState)
 
     explicit constexpr DeviceFeatures(DEVICE_FEATURE_STATE State) noexcept
     {
-        static_assert(sizeof(*this) == 41, "Did you add a new feature to DeviceFeatures? Please add it to ENUMERATE_DEVICE_FEATURES.");
+        static_assert(sizeof(*this) == 42, "Did you add a new feature to DeviceFeatures? Please add it to ENUMERATE_DEVICE_FEATURES.");
     #define INIT_FEATURE(Feature) Feature = State;
         ENUMERATE_DEVICE_FEATURES(INIT_FEATURE)
     #undef INIT_FEATURE
@@ -2879,7 +2910,19 @@ DILIGENT_TYPED_ENUM(DRAW_COMMAND_CAP_FLAGS, Uint16)
     /// Indicates that IDeviceContext::DrawIndirect() and IDeviceContext::DrawIndexedIndirect()
     /// commands may take non-null counter buffer. If this flag is not set, the number
     /// of draw commands must be specified through the command attributes.
-    DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER = 1u << 4
+    DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER = 1u << 4,
+
+    /// Indicates that device natively supports IDeviceContext::MultiDraw() and
+    /// IDeviceContext::MultiDrawIndexed() commands. When this flag is not set,
+    /// the commands are executed as a sequence of individual draw calls.
+    DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW            = 1u << 5,
+
+    /// Indicates that device supports IDeviceContext::SetPredication(). When this flag
+    /// is not set, predication is ignored and all commands are executed unconditionally.
+    DRAW_COMMAND_CAP_FLAG_PREDICATION                  = 1u << 6,
+
+    /// Indicates that device supports IDeviceContext::SetQueryPredication().
+    DRAW_COMMAND_CAP_FLAG_QUERY_PREDICATION            = 1u << 7
 };
 DEFINE_FLAG_ENUM_OPERATORS(DRAW_COMMAND_CAP_FLAGS);
 
@@ -3267,6 +3310,122 @@ struct ImmediateContextCreateInfo
 typedef struct ImmediateContextCreateInfo ImmediateContextCreateInfo;
 
 
+/// Device context calls measured by the optional CPU instrumentation,
+/// see Diligent::DeviceContextInstrumentationStats.
+DILIGENT_TYPED_ENUM(INSTRUMENTED_CALL, Uint8)
+{
+    /// IDeviceContext::SetPipelineState().
+    INSTRUMENTED_CALL_SET_PIPELINE_STATE = 0,
+
+    /// IDeviceContext::CommitShaderResources().
+    INSTRUMENTED_CALL_COMMIT_SHADER_RESOURCES,
+
+    /// IDeviceContext::TransitionResourceStates().
+    INSTRUMENTED_CALL_TRANSITION_RESOURCE_STATES,
+
+    /// IDeviceContext::MapBuffer().
+    INSTRUMENTED_CALL_MAP_BUFFER,
+
+    /// IDeviceContext::UnmapBuffer().
+    INSTRUMENTED_CALL_UNMAP_BUFFER,
+
+    /// All draw commands: IDeviceContext::Draw(), IDeviceContext::DrawIndexed(), their indirect,
+    /// mesh and multi-draw variants.
+    INSTRUMENTED_CALL_DRAW,
+
+    /// IDeviceContext::DispatchCompute() and IDeviceContext::DispatchComputeIndirect().
+    INSTRUMENTED_CALL_DISPATCH,
+
+    /// The number of instrumented call types.
+    INSTRUMENTED_CALL_COUNT
+};
+
+/// Callback that is invoked when an instrumented device context call begins.
+
+/// \param [in] Call      - Call type.
+/// \param [in] Name      - Null-terminated static string with the call name, e.g. "CommitShaderResources".
+/// \param [in] pUserData - User data pointer, see InstrumentationSinkDesc::pUserData.
+typedef void(DILIGENT_CALL_TYPE* InstrumentationBeginCallbackType)(INSTRUMENTED_CALL Call, const Char* Name, void* pUserData);
+
+/// Callback that is invoked when an instrumented device context call ends.
+typedef void(DILIGENT_CALL_TYPE* InstrumentationEndCallbackType)(INSTRUMENTED_CALL Call, void* pUserData);
+
+/// Instrumentation sink description.
+
+/// The sink receives begin/end events of all instrumented device context calls
+/// and may forward them to an external profiler (e.g. Tracy or Superluminal).
+/// The callbacks are invoked from the threads that use the contexts, so they must be thread-safe.
+struct InstrumentationSinkDesc
+{
+    /// Callback that is invoked when an instrumented call begins. May be null.
+    InstrumentationBeginCallbackType BeginCall DEFAULT_INITIALIZER(nullptr);
+
+    /// Callback that is invoked when an instrumented call ends. May be null.
+    InstrumentationEndCallbackType   EndCall   DEFAULT_INITIALIZER(nullptr);
+
+    /// User data pointer that is passed to the callbacks.
+    void*                            pUserData DEFAULT_INITIALIZER(nullptr);
+};
+typedef struct InstrumentationSinkDesc InstrumentationSinkDesc;
+
+/// Startup profiling description, see EngineCreateInfo::StartupProfiling.
+
+/// When the startup profiling is enabled, the engine records the hierarchical timeline of
+/// the initialization phases (instance and device creation, shader compiler loading, etc.)
+/// and of all device objects created until the end of the first frames, and writes it
+/// to the log and, optionally, to a JSON file.
+struct StartupProfilingDesc
+{
+    /// Whether to record the startup timeline.
+    Bool        Enable       DEFAULT_INITIALIZER(False);
+
+    /// The number of frames finished by the first immediate context, see IDeviceContext::FinishFrame(),
+    /// after which the recording stops and the timeline is written.
+    /// If zero, the recording stops when the render device is destroyed.
+    Uint32      NumFrames    DEFAULT_INITIALIZER(1);
+
+    /// Optional path of the file the timeline is written to in the Chrome trace event
+    /// JSON format, which can be loaded into chrome://tracing or Perfetto.
+    /// If null, the timeline is only written to the log.
+    const Char* JSONFilePath DEFAULT_INITIALIZER(nullptr);
+};
+typedef struct StartupProfilingDesc StartupProfilingDesc;
+
+/// Budget and usage of a memory segment, see Diligent::DeviceMemoryBudget.
+struct MemoryHeapBudget
+{
+    /// The amount of memory, in bytes, that the process may use before the OS or
+    /// the driver starts evicting resources or paging them to the system memory.
+    /// Zero if the budget is not known.
+    Uint64 Budget DEFAULT_INITIALIZER(0);
+
+    /// The amount of memory, in bytes, that is currently used by the process.
+    Uint64 Usage  DEFAULT_INITIALIZER(0);
+};
+typedef struct MemoryHeapBudget MemoryHeapBudget;
+
+/// Device memory budget, see IRenderDevice::GetMemoryBudget().
+
+/// The budget is provided by the OS or the driver and may change at any time,
+/// e.g. when other applications allocate or release video memory.
+struct DeviceMemoryBudget
+{
+    /// Device-local memory that is fast to access from the GPU.
+    /// On unified memory architectures, this is the memory shared by the CPU and the GPU.
+    MemoryHeapBudget Local;
+
+    /// Non-local (system) memory that is accessible by the GPU.
+    MemoryHeapBudget NonLocal;
+};
+typedef struct DeviceMemoryBudget DeviceMemoryBudget;
+
+/// Callback that is invoked when the device memory usage exceeds the pressure threshold,
+/// see IRenderDevice::AddMemoryPressureCallback().
+
+/// \param [in] pBudget   - The current memory budget.
+/// \param [in] pUserData - User data pointer that was passed to IRenderDevice::AddMemoryPressureCallback().
+typedef void(DILIGENT_CALL_TYPE* MemoryPressureCallbackType)(const DeviceMemoryBudget* pBudget, void* pUserData);
+
 /// Engine creation information
 struct EngineCreateInfo
 {
@@ -3334,9 +3493,85 @@ struct EngineCreateInfo
     VALIDATION_FLAGS    ValidationFlags             DEFAULT_INITIALIZER(VALIDATION_FLAG_NONE);
 
     /// Pointer to the raw memory allocator that will be used for all memory allocation/deallocation
-    /// operations in the engine
+    /// operations in the engine.
+    /// Use Diligent::TrackingMemoryAllocator to collect per-subsystem memory statistics.
     struct IMemoryAllocator* pRawMemAllocator       DEFAULT_INITIALIZER(nullptr);
 
+    /// An optional thread pool that will be used to initialize pipeline states
+    /// created with Diligent::PSO_CREATE_FLAG_ASYNCHRONOUS flag.
+
+    /// \remarks   The render device keeps a strong reference to the pool.
+    ///            If the pool is null, the device creates its own pool
+    ///            with NumAsyncShaderCompilationThreads worker threads.
+#if DILIGENT_CPP_INTERFACE
+    class IThreadPool*  pAsyncShaderCompilationThreadPool DEFAULT_INITIALIZER(nullptr);
+#else
+    struct IThreadPool* pAsyncShaderCompilationThreadPool;
+#endif
+
+    /// The number of worker threads in the shader compilation thread pool that
+    /// the device creates when pAsyncShaderCompilationThreadPool is null.
+
+    /// \remarks   If this value is zero, the device does not create the thread pool,
+    ///            and Diligent::PSO_CREATE_FLAG_ASYNCHRONOUS flag is ignored.
+    Uint32              NumAsyncShaderCompilationThreads DEFAULT_INITIALIZER(0);
+
+    /// Optional sink for the device context CPU instrumentation events, see Diligent::InstrumentationSinkDesc.
+
+    /// \remarks   The instrumentation is only compiled in when the engine is built with
+    ///            DILIGENT_ENABLE_INSTRUMENTATION CMake option. Otherwise the sink is never invoked.
+    InstrumentationSinkDesc InstrumentationSink;
+
+    /// Startup profiling description, see Diligent::StartupProfilingDesc.
+
+    /// \remarks   The recording is process-wide. If it has already been started by another
+    ///            engine instance, the timeline is shared, and it is written by the device
+    ///            that stops the recording first.
+    StartupProfilingDesc StartupProfiling;
+
+    /// The fraction of the memory budget, see Diligent::DeviceMemoryBudget, after which the
+    /// memory pressure callbacks registered with IRenderDevice::AddMemoryPressureCallback() are invoked.
+
+    /// \remarks   The budget is checked when the first immediate context finishes a frame,
+    ///            see IDeviceContext::FinishFrame(). The callbacks are invoked every frame while
+    ///            the usage of either the local or the non-local memory exceeds the threshold.
+    float               MemoryPressureThreshold DEFAULT_INITIALIZER(0.9f);
+
+    /// Whether to destroy released resources on a background thread.
+
+    /// \remarks   When enabled, the device creates a worker thread that destroys the resources
+    ///            whose last command lists have been completed by the GPU, instead of the thread
+    ///            that calls IRenderDevice::ReleaseStaleResources() or IDeviceContext::FinishFrame().
+    ///            This removes the hitches caused by releasing a large number of resources at once.
+    ///
+    ///            Only Direct3D12 and Vulkan backends support this option.
+    Bool                AsyncResourceDestruction DEFAULT_INITIALIZER(False);
+
+    /// The maximum time, in microseconds, that the device spends destroying released resources
+    /// each time a release queue is purged.
+
+    /// \remarks   Zero means no limit. The resources that are not destroyed within the budget
+    ///            are destroyed when the queue is purged the next time. The budget is ignored
+    ///            when IRenderDevice::ReleaseStaleResources() is called with ForceRelease set to true.
+    ///
+    ///            Only Direct3D12 and Vulkan backends support this option.
+    Uint32              ResourceDestructionTimeBudget DEFAULT_INITIALIZER(0);
+
+    /// Whether to submit command buffers on a dedicated thread.
+
+    /// \remarks   When enabled, the device creates a submission thread for every command queue.
+    ///            IDeviceContext::Flush() and IDeviceContext::ExecuteCommandLists() hand off the recorded
+    ///            command buffers to the thread and return immediately, so that the application may record
+    ///            the next command buffer while the driver processes the submission. The fence values are
+    ///            assigned when the command buffer is handed off, so IDeviceContext::EnqueueSignal() and
+    ///            IDeviceContext::DeviceWaitForFence() work as usual.
+    ///
+    ///            Operations that access the queue directly, such as IDeviceContext::WaitForIdle() or
+    ///            ISwapChain::Present(), wait for the pending submissions to complete.
+    ///
+    ///            Only Direct3D12 and Vulkan backends support this option.
+    Bool                AsyncCommandSubmission DEFAULT_INITIALIZER(False);
+
 #if DILIGENT_CPP_INTERFACE
     EngineCreateInfo() noexcept
     {
@@ -3370,6 +3605,14 @@ struct EngineGLCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// Use IRenderDevice::GetDeviceInfo().NDC to get current NDC.
     Bool         ZeroToOneNDZ DEFAULT_INITIALIZER(false);
 
+    /// The maximum number of vertex array objects kept in the VAO cache of each GL context.
+    /// When the limit is reached, the least recently used VAO is released. Zero means no limit.
+    Uint32       VAOCacheSize DEFAULT_INITIALIZER(4096);
+
+    /// The maximum number of framebuffer objects kept in the FBO cache of each GL context.
+    /// When the limit is reached, the least recently used FBO is released. Zero means no limit.
+    Uint32       FBOCacheSize DEFAULT_INITIALIZER(1024);
+
 #if DILIGENT_CPP_INTERFACE
     EngineGLCreateInfo() noexcept : EngineGLCreateInfo{EngineCreateInfo{}}
     {}
@@ -3554,6 +3797,24 @@ struct EngineD3D12CreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// global dynamic heap manager to avoid page creation at run time.
     Uint32 NumDynamicHeapPagesToReserve DEFAULT_INITIALIZER(1);
 
+    /// The number of frames after which the global dynamic heap manager releases the pages
+    /// that were not needed during these frames. The manager always keeps at least
+    /// NumDynamicHeapPagesToReserve pages. Zero disables shrinking.
+    ///
+    /// \remarks   The dynamic heap grows by creating new pages when the existing pages are
+    ///            exhausted. Use IRenderDeviceD3D12::GetDynamicHeapStats() to query the usage.
+    Uint32 DynamicHeapShrinkInterval DEFAULT_INITIALIZER(256);
+
+    /// The size of the page of the upload heap that device contexts use to stage
+    /// texture data in IDeviceContext::UpdateTexture() and IDeviceContext::MapTextureSubresource().
+    /// Texture updates that do not fit into one page are split into several copies,
+    /// so that large streaming updates do not require creating new upload resources.
+    Uint32 TextureUploadPageSize     DEFAULT_INITIALIZER(8 << 20);
+
+    /// Number of texture upload pages that will be reserved by the
+    /// global texture upload memory manager to avoid page creation at run time.
+    Uint32 NumTextureUploadPagesToReserve DEFAULT_INITIALIZER(1);
+
     /// Query pool size for each query type.
     Uint32 QueryPoolSizes[QUERY_TYPE_NUM_TYPES]
 #if DILIGENT_CPP_INTERFACE
@@ -3568,6 +3829,38 @@ struct EngineD3D12CreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 #endif
     ;
 
+    /// Whether to manage the residency of textures and buffers.
+
+    /// \remarks   When enabled, the device tracks the frames in which textures and buffers are used
+    ///            by the device contexts. When the first immediate context finishes a frame and the local
+    ///            memory usage exceeds EngineCreateInfo::MemoryPressureThreshold, the least recently used
+    ///            resources are evicted with ID3D12Device::Evict(). An evicted resource is made resident
+    ///            again when a device context uses it.
+    ///
+    ///            Render targets, depth-stencil buffers and resources with unordered access are never
+    ///            evicted. They are created with high residency priority whether the residency management
+    ///            is enabled or not.
+    ///
+    ///            Since every shader resource binding has to be processed when it is committed,
+    ///            the residency management adds CPU overhead.
+    Bool EnableResidencyManagement DEFAULT_INITIALIZER(False);
+
+    /// The number of frames finished by the first immediate context during which a resource must not
+    /// be used before it may be evicted. The value must be greater than the maximum number of frames
+    /// that the GPU may be behind the CPU.
+    Uint32 ResidencyEvictionLatency DEFAULT_INITIALIZER(8);
+
+    /// The size of the upload data after which the batched initial data copies are submitted.
+
+    /// \remarks   When non-zero, the commands that copy the initial data of buffers and textures
+    ///            created from any thread are recorded into one command list per command queue instead
+    ///            of being submitted individually. The batch is submitted when the total size of the
+    ///            upload data reaches this value, before the next command list is submitted to the
+    ///            queue, when an immediate context finishes the frame or is idled, and when the device
+    ///            is idled.
+    ///            When zero, the initial data of every resource is submitted as soon as the resource is created.
+    Uint32 InitialDataBatchSize DEFAULT_INITIALIZER(0);
+
     /// Path to DirectX Shader Compiler, which is required to use Shader Model 6.0+ features.
     /// By default, the engine will search for "dxcompiler.dll".
     const Char* pDxCompilerPath DEFAULT_INITIALIZER(nullptr);
@@ -3710,6 +4003,18 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 #endif
     ;
 
+    /// Size of the descriptor pool that is used to allocate update-after-bind descriptor sets
+    /// for static and mutable variables of signatures that contain bindless resources
+    /// (see PIPELINE_RESOURCE_FLAG_BINDLESS). Every pool must be large enough to hold
+    /// the largest bindless descriptor set. If allocation from the current pool fails,
+    /// the engine creates another one.
+    VulkanDescriptorPoolSize BindlessDescriptorPoolSize
+#if DILIGENT_CPP_INTERFACE
+        //Max  SepSm  CmbSm  SmpImg StrImg   UB     SB    UTxB   StTxB  InptAtt  AccelSt
+        {  64,    64,  1024, 32768,  4096,   256, 16384,  4096,  4096,    64,      64}
+#endif
+    ;
+
     /// Allocation granularity for device-local memory
     Uint32 DeviceLocalMemoryPageSize        DEFAULT_INITIALIZER(16 << 20);
 
@@ -3741,6 +4046,17 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// the global dynamic heap to perform lock-free dynamic suballocations
     Uint32 DynamicHeapPageSize              DEFAULT_INITIALIZER(256 << 10);
 
+    /// Whether the dynamic heap pages are allocated from a lock-free ring shared by all contexts.
+
+    /// \remarks   When enabled, contexts allocate dynamic heap pages with a single atomic operation instead
+    ///            of locking the global dynamic heap, and the pages allocated during the frame are reclaimed
+    ///            as soon as the GPU completes the last submission of the frame. All contexts share the same
+    ///            frame: command lists of deferred contexts must be executed before the immediate context
+    ///            finishes the frame, and no context may map dynamic resources while it does.
+    ///            The ring is only used when the device has a single immediate context and DynamicHeapSize
+    ///            is a multiple of DynamicHeapPageSize.
+    Bool   DynamicHeapPageRing              DEFAULT_INITIALIZER(False);
+
     /// Query pool size for each query type.
     Uint32 QueryPoolSizes[QUERY_TYPE_NUM_TYPES]
 #if DILIGENT_CPP_INTERFACE
@@ -3755,6 +4071,17 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 #endif
     ;
 
+    /// The size of the upload data after which the batched initial data copies are submitted.
+
+    /// \remarks   When non-zero, the commands that copy the initial data of buffers and textures
+    ///            created from any thread are recorded into one command buffer per command queue instead
+    ///            of being submitted individually. The batch is submitted when the total size of the
+    ///            upload data reaches this value, before the next command buffer is submitted to the
+    ///            queue, when an immediate context finishes the frame or is idled, and when the device
+    ///            is idled.
+    ///            When zero, the initial data of every resource is submitted as soon as the resource is created.
+    Uint32 InitialDataBatchSize DEFAULT_INITIALIZER(0);
+
     /// Path to DirectX Shader Compiler, which is required to use Shader Model 6.0+
     /// features when compiling shaders from HLSL.
     const Char* pDxCompilerPath DEFAULT_INITIALIZER(nullptr);
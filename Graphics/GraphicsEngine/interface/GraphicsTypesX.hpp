@@ -43,6 +43,7 @@
 #include "RenderDevice.h"
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 #include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/HashUtils.hpp"
 
 namespace Diligent
 {
@@ -105,6 +106,7 @@ struct SubpassDescX
         RenderTargets.push_back(RenderTarget);
         Desc.pRenderTargetAttachments    = RenderTargets.data();
         Desc.RenderTargetAttachmentCount = static_cast<Uint32>(RenderTargets.size());
+        Hash                             = 0;
 
         if (pResolve != nullptr)
         {
@@ -124,6 +126,7 @@ struct SubpassDescX
         Inputs.push_back(Input);
         Desc.pInputAttachments    = Inputs.data();
         Desc.InputAttachmentCount = static_cast<Uint32>(Inputs.size());
+        Hash                      = 0;
         return *this;
     }
 
@@ -132,6 +135,7 @@ struct SubpassDescX
         Preserves.push_back(Preserve);
         Desc.pPreserveAttachments    = Preserves.data();
         Desc.PreserveAttachmentCount = static_cast<Uint32>(Preserves.size());
+        Hash                         = 0;
         return *this;
     }
 
@@ -139,6 +143,7 @@ struct SubpassDescX
     {
         DepthStencil                 = (pDepthStencilAttachment != nullptr) ? *pDepthStencilAttachment : AttachmentReference{};
         Desc.pDepthStencilAttachment = (pDepthStencilAttachment != nullptr) ? &DepthStencil : nullptr;
+        Hash                         = 0;
         return *this;
     }
 
@@ -151,6 +156,7 @@ struct SubpassDescX
     {
         ShadingRate                 = (pShadingRateAttachment != nullptr) ? *pShadingRateAttachment : ShadingRateAttachment{};
         Desc.pShadingRateAttachment = (pShadingRateAttachment != nullptr) ? &ShadingRate : nullptr;
+        Hash                        = 0;
         return *this;
     }
 
@@ -164,6 +170,7 @@ struct SubpassDescX
         Inputs.clear();
         Desc.InputAttachmentCount = 0;
         Desc.pInputAttachments    = nullptr;
+        Hash                      = 0;
     }
 
     void ClearRenderTargets()
@@ -173,6 +180,7 @@ struct SubpassDescX
         Desc.RenderTargetAttachmentCount = 0;
         Desc.pRenderTargetAttachments    = nullptr;
         Desc.pResolveAttachments         = nullptr;
+        Hash                             = 0;
     }
 
     void ClearPreserves()
@@ -180,6 +188,7 @@ struct SubpassDescX
         Preserves.clear();
         Desc.PreserveAttachmentCount = 0;
         Desc.pPreserveAttachments    = nullptr;
+        Hash                         = 0;
     }
 
     const SubpassDesc& Get() const
@@ -210,6 +219,16 @@ struct SubpassDescX
         return *this != static_cast<const SubpassDesc&>(RHS);
     }
 
+    /// Returns the hash of the wrapped SubpassDesc struct.
+
+    /// The hash is computed on the first call and cached until the wrapper is modified.
+    size_t GetHash() const
+    {
+        if (Hash == 0)
+            Hash = StdHasher<SubpassDesc>{}(Desc);
+        return Hash;
+    }
+
     void Clear()
     {
         SubpassDescX CleanDesc;
@@ -226,6 +245,7 @@ struct SubpassDescX
         Preserves.swap(Other.Preserves);
         std::swap(DepthStencil, Other.DepthStencil);
         std::swap(ShadingRate, Other.ShadingRate);
+        std::swap(Hash, Other.Hash);
 
         if (Desc.pDepthStencilAttachment != nullptr)
             Desc.pDepthStencilAttachment = &DepthStencil;
@@ -248,6 +268,8 @@ private:
 
     AttachmentReference   DepthStencil;
     ShadingRateAttachment ShadingRate;
+
+    mutable size_t Hash = 0;
 };
 
 /// C++ wrapper over Diligent::RenderPassDesc.
@@ -353,6 +375,16 @@ struct RenderPassDescX
         return *this != static_cast<const RenderPassDesc&>(RHS);
     }
 
+    /// Returns the hash of the wrapped RenderPassDesc struct.
+
+    /// The hash is computed on the first call and cached until the wrapper is modified.
+    size_t GetHash() const
+    {
+        if (Hash == 0)
+            Hash = StdHasher<RenderPassDesc>{}(Desc);
+        return Hash;
+    }
+
     void Clear()
     {
         RenderPassDescX CleanDesc;
@@ -370,6 +402,8 @@ private:
 
         Desc.DependencyCount = static_cast<Uint32>(Dependencies.size());
         Desc.pDependencies   = Desc.DependencyCount > 0 ? Dependencies.data() : nullptr;
+
+        Hash = 0;
     }
 
     RenderPassDesc Desc;
@@ -377,6 +411,8 @@ private:
     std::vector<RenderPassAttachmentDesc> Attachments;
     std::vector<SubpassDesc>              Subpasses;
     std::vector<SubpassDependencyDesc>    Dependencies;
+
+    mutable size_t Hash = 0;
 };
 
 
@@ -431,6 +467,16 @@ struct InputLayoutDescX
         return Add(Elem);
     }
 
+    /// Returns the hash of the wrapped InputLayoutDesc struct.
+
+    /// The hash is computed on the first call and cached until the wrapper is modified.
+    size_t GetHash() const
+    {
+        if (Hash == 0)
+            Hash = StdHasher<InputLayoutDesc>{}(Desc);
+        return Hash;
+    }
+
     void Clear()
     {
         InputLayoutDescX EmptyDesc;
@@ -476,10 +522,14 @@ private:
             for (auto& Elem : Elements)
                 Elem.HLSLSemantic = StringPool.emplace(Elem.HLSLSemantic).first->c_str();
         }
+
+        Hash = 0;
     }
     InputLayoutDesc                 Desc;
     std::vector<LayoutElement>      Elements;
     std::unordered_set<std::string> StringPool;
+
+    mutable size_t Hash = 0;
 };
 
 
@@ -1335,6 +1385,11 @@ public:
         return CreateDeviceObject<IQuery>("query", Desc.Name, &IRenderDevice::CreateQuery, Desc);
     }
 
+    RefCntAutoPtr<IQueryArray> CreateQueryArray(const QueryArrayDesc& Desc) noexcept(!ThrowOnError)
+    {
+        return CreateDeviceObject<IQueryArray>("query array", Desc.Name, &IRenderDevice::CreateQueryArray, Desc);
+    }
+
     RefCntAutoPtr<IRenderPass> CreateRenderPass(const RenderPassDesc& Desc) noexcept(!ThrowOnError)
     {
         return CreateDeviceObject<IRenderPass>("render pass", Desc.Name, &IRenderDevice::CreateRenderPass, Desc);
@@ -1441,3 +1496,24 @@ private:
 };
 
 } // namespace Diligent
+
+namespace std
+{
+
+#define DEFINE_DESCX_HASH(Type)                           \
+    template <>                                           \
+    struct hash<Type>                                     \
+    {                                                     \
+        size_t operator()(const Type& Val) const noexcept \
+        {                                                 \
+            return Val.GetHash();                         \
+        }                                                 \
+    }
+
+DEFINE_DESCX_HASH(Diligent::SubpassDescX);
+DEFINE_DESCX_HASH(Diligent::RenderPassDescX);
+DEFINE_DESCX_HASH(Diligent::InputLayoutDescX);
+
+#undef DEFINE_DESCX_HASH
+
+} // namespace std
@@ -129,7 +129,39 @@ DILIGENT_TYPED_ENUM(PIPELINE_RESOURCE_FLAGS, Uint8)
     /// \note This flag is only valid in Vulkan.
     PIPELINE_RESOURCE_FLAG_GENERAL_INPUT_ATTACHMENT = 1u << 4,
 
-    PIPELINE_RESOURCE_FLAG_LAST               = PIPELINE_RESOURCE_FLAG_GENERAL_INPUT_ATTACHMENT
+    /// Indicates that the resource is a bindless array: elements of the array may be set or replaced at any time,
+    /// including after the shader resource binding has been committed, as long as they are not accessed by
+    /// commands that are being executed by the GPU; elements that are not accessed by the shader may be left null.
+    /// Applies to mutable SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_TYPE_TEXTURE_UAV,
+    /// SHADER_RESOURCE_TYPE_BUFFER_SRV and SHADER_RESOURCE_TYPE_BUFFER_UAV resources.
+    /// Buffer resources must also use PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS or PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER flag.
+    ///
+    /// \remarks   Changing array elements does not require committing the shader resource binding again,
+    ///             so that the application can put all textures and buffers into large arrays and select
+    ///             them in the shader by index, binding the descriptor set only once. Use
+    ///             IShaderResourceBindingVk::AddBindlessResource() to get stable element indices for resources.
+    ///
+    ///             In Vulkan, the resource is placed into a descriptor set created with update-after-bind
+    ///             flag, which requires that no other resource in the same descriptor set (i.e. no static
+    ///             or mutable resource of the signature) is a buffer with a dynamic offset.
+    ///
+    /// \note This flag is only valid in Vulkan and requires BindlessResources device feature.
+    PIPELINE_RESOURCE_FLAG_BINDLESS = 1u << 5,
+
+    /// Indicates that the constant buffer is a small block of 32-bit constants whose values
+    /// are set directly through IShaderResourceVariable::SetInlineConstants() rather than
+    /// by binding a buffer. The number of constants is given by PipelineResourceDesc::NumInlineConstants.
+    /// Applies to mutable and dynamic SHADER_RESOURCE_TYPE_CONSTANT_BUFFER resources with ArraySize equal to 1.
+    ///
+    /// \remarks   In the shader, the resource is declared as a regular constant buffer.
+    ///             The values are stored in the shader resource binding and are written to
+    ///             an internal dynamic constant buffer by the next draw or dispatch command
+    ///             after they have changed, so updating them does not require committing the SRB again.
+    ///             The internal buffer is bound to the variable when the SRB is created and must
+    ///             not be replaced by the application.
+    PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS = 1u << 6,
+
+    PIPELINE_RESOURCE_FLAG_LAST               = PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS
 };
 DEFINE_FLAG_ENUM_OPERATORS(PIPELINE_RESOURCE_FLAGS);
 
@@ -138,26 +170,31 @@ DEFINE_FLAG_ENUM_OPERATORS(PIPELINE_RESOURCE_FLAGS);
 struct PipelineResourceDesc
 {
     /// Resource name in the shader
-    const Char*                    Name          DEFAULT_INITIALIZER(nullptr);
+    const Char*                    Name               DEFAULT_INITIALIZER(nullptr);
 
     /// Shader stages that this resource applies to. When multiple shader stages are specified,
     /// all stages will share the same resource.
     ///
     /// \remarks    There may be multiple resources with the same name in different shader stages,
     ///             but the stages specified for different resources with the same name must not overlap.
-    SHADER_TYPE                    ShaderStages  DEFAULT_INITIALIZER(SHADER_TYPE_UNKNOWN);
+    SHADER_TYPE                    ShaderStages       DEFAULT_INITIALIZER(SHADER_TYPE_UNKNOWN);
 
     /// Resource array size (must be 1 for non-array resources).
-    Uint32                         ArraySize     DEFAULT_INITIALIZER(1);
+    Uint32                         ArraySize          DEFAULT_INITIALIZER(1);
 
     /// Resource type, see Diligent::SHADER_RESOURCE_TYPE.
-    SHADER_RESOURCE_TYPE           ResourceType  DEFAULT_INITIALIZER(SHADER_RESOURCE_TYPE_UNKNOWN);
+    SHADER_RESOURCE_TYPE           ResourceType       DEFAULT_INITIALIZER(SHADER_RESOURCE_TYPE_UNKNOWN);
 
     /// Resource variable type, see Diligent::SHADER_RESOURCE_VARIABLE_TYPE.
-    SHADER_RESOURCE_VARIABLE_TYPE  VarType       DEFAULT_INITIALIZER(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE);
+    SHADER_RESOURCE_VARIABLE_TYPE  VarType            DEFAULT_INITIALIZER(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE);
 
     /// Special resource flags, see Diligent::PIPELINE_RESOURCE_FLAGS.
-    PIPELINE_RESOURCE_FLAGS        Flags         DEFAULT_INITIALIZER(PIPELINE_RESOURCE_FLAG_NONE);
+    PIPELINE_RESOURCE_FLAGS        Flags              DEFAULT_INITIALIZER(PIPELINE_RESOURCE_FLAG_NONE);
+
+    /// The number of 32-bit constants in the inline constant block.
+    /// Must be zero unless PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS flag is set,
+    /// and must not exceed MAX_INLINE_CONSTANTS otherwise.
+    Uint32                         NumInlineConstants DEFAULT_INITIALIZER(0);
 
 #if DILIGENT_CPP_INTERFACE
     constexpr PipelineResourceDesc() noexcept {}
@@ -166,23 +203,26 @@ struct PipelineResourceDesc
                                    const Char*                   _Name,
                                    Uint32                        _ArraySize,
                                    SHADER_RESOURCE_TYPE          _ResourceType,
-                                   SHADER_RESOURCE_VARIABLE_TYPE _VarType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE,
-                                   PIPELINE_RESOURCE_FLAGS       _Flags   = PIPELINE_RESOURCE_FLAG_NONE)noexcept :
-        Name        {_Name        },
-        ShaderStages{_ShaderStages},
-        ArraySize   {_ArraySize   },
-        ResourceType{_ResourceType},
-        VarType     {_VarType     },
-        Flags       {_Flags       }
+                                   SHADER_RESOURCE_VARIABLE_TYPE _VarType            = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE,
+                                   PIPELINE_RESOURCE_FLAGS       _Flags              = PIPELINE_RESOURCE_FLAG_NONE,
+                                   Uint32                        _NumInlineConstants = 0)noexcept :
+        Name              {_Name              },
+        ShaderStages      {_ShaderStages      },
+        ArraySize         {_ArraySize         },
+        ResourceType      {_ResourceType      },
+        VarType           {_VarType           },
+        Flags             {_Flags             },
+        NumInlineConstants{_NumInlineConstants}
     {}
 
     bool operator==(const PipelineResourceDesc& Rhs) const noexcept
     {
-        return ShaderStages == Rhs.ShaderStages &&
-               ArraySize    == Rhs.ArraySize    &&
-               ResourceType == Rhs.ResourceType &&
-               VarType      == Rhs.VarType      &&
-               Flags        == Rhs.Flags        &&
+        return ShaderStages       == Rhs.ShaderStages       &&
+               ArraySize          == Rhs.ArraySize          &&
+               ResourceType       == Rhs.ResourceType       &&
+               VarType            == Rhs.VarType            &&
+               Flags              == Rhs.Flags              &&
+               NumInlineConstants == Rhs.NumInlineConstants &&
                SafeStrEqual(Name, Rhs.Name);
     }
     bool operator!=(const PipelineResourceDesc& Rhs) const noexcept
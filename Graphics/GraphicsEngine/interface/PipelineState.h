@@ -185,6 +185,37 @@ DILIGENT_TYPED_ENUM(PIPELINE_SHADING_RATE_FLAGS, Uint8)
 };
 DEFINE_FLAG_ENUM_OPERATORS(PIPELINE_SHADING_RATE_FLAGS);
 
+
+/// Pipeline state dynamic state flags.
+
+/// Dynamic states are set by the device context rather than baked into the pipeline, which
+/// allows using the same pipeline in place of several pipelines that only differ by these states.
+/// Dynamic states require DeviceFeatures::ExtendedDynamicState feature.
+DILIGENT_TYPED_ENUM(PIPELINE_DYNAMIC_STATE_FLAGS, Uint8)
+{
+    /// No dynamic states are used.
+    PIPELINE_DYNAMIC_STATE_FLAG_NONE               = 0,
+
+    /// Cull mode is dynamic, see IDeviceContext::SetCullMode().
+    PIPELINE_DYNAMIC_STATE_FLAG_CULL_MODE          = 1u << 0u,
+
+    /// Depth test enable, depth write enable and depth comparison function are dynamic,
+    /// see IDeviceContext::SetDepthStencilState().
+    PIPELINE_DYNAMIC_STATE_FLAG_DEPTH              = 1u << 1u,
+
+    /// Stencil test enable and stencil operations are dynamic,
+    /// see IDeviceContext::SetDepthStencilState().
+    PIPELINE_DYNAMIC_STATE_FLAG_STENCIL            = 1u << 2u,
+
+    /// Primitive topology is dynamic, see IDeviceContext::SetPrimitiveTopology().
+    /// The topology must be of the same class (point, line, triangle or patch list)
+    /// as GraphicsPipelineDesc::PrimitiveTopology.
+    PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY = 1u << 3u,
+
+    PIPELINE_DYNAMIC_STATE_FLAG_LAST               = PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY,
+};
+DEFINE_FLAG_ENUM_OPERATORS(PIPELINE_DYNAMIC_STATE_FLAGS);
+
 /// Pipeline layout description
 struct PipelineResourceLayoutDesc
 {
@@ -306,6 +337,12 @@ struct GraphicsPipelineDesc
     /// Shading rate flags that specify which type of the shading rate will be used with this pipeline.
     PIPELINE_SHADING_RATE_FLAGS ShadingRateFlags DEFAULT_INITIALIZER(PIPELINE_SHADING_RATE_FLAG_NONE);
 
+    /// Dynamic state flags that specify which states are set by the device context, see PIPELINE_DYNAMIC_STATE_FLAGS.
+
+    /// The values of the dynamic states in RasterizerDesc, DepthStencilDesc and PrimitiveTopology
+    /// are used as the initial values that are set when the pipeline is bound.
+    PIPELINE_DYNAMIC_STATE_FLAGS DynamicStateFlags DEFAULT_INITIALIZER(PIPELINE_DYNAMIC_STATE_FLAG_NONE);
+
     /// Render target formats.
     /// All formats must be TEX_FORMAT_UNKNOWN when pRenderPass is not null.
     TEXTURE_FORMAT RTVFormats[DILIGENT_MAX_RENDER_TARGETS] DEFAULT_INITIALIZER({});
@@ -339,6 +376,7 @@ struct GraphicsPipelineDesc
               NumRenderTargets  == Rhs.NumRenderTargets  &&
               SubpassIndex      == Rhs.SubpassIndex      &&
               ShadingRateFlags  == Rhs.ShadingRateFlags  &&
+              DynamicStateFlags == Rhs.DynamicStateFlags &&
               DSVFormat         == Rhs.DSVFormat         &&
               SmplDesc          == Rhs.SmplDesc          &&
               NodeMask          == Rhs.NodeMask))
@@ -629,11 +667,68 @@ DILIGENT_TYPED_ENUM(PSO_CREATE_FLAGS, Uint32)
     /// by the PSO's resource signatures.
     PSO_CREATE_FLAG_DONT_REMAP_SHADER_RESOURCES       = 1u << 2u,
 
-    PSO_CREATE_FLAG_LAST = PSO_CREATE_FLAG_DONT_REMAP_SHADER_RESOURCES
+    /// Create the pipeline asynchronously.
+
+    /// When this flag is set, the pipeline is initialized by the shader compilation
+    /// thread pool of the render device (see EngineCreateInfo::pAsyncShaderCompilationThreadPool
+    /// and EngineCreateInfo::NumAsyncShaderCompilationThreads), and the creation method returns
+    /// immediately. Use IPipelineState::GetStatus() to check if the pipeline is ready.
+    ///
+    /// \remarks    Asynchronous initialization is supported by Direct3D12 and Vulkan backends
+    ///             for graphics and compute pipelines. All other pipelines, and pipelines created
+    ///             by a device that does not have a shader compilation thread pool, ignore
+    ///             this flag and are initialized synchronously.
+    ///             In OpenGL backend, the flag is supported when the driver exposes
+    ///             GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile extension:
+    ///             program links are submitted to the driver, and the link status is
+    ///             queried by IPipelineState::GetStatus(), which must be called from the
+    ///             thread that owns the GL context.
+    PSO_CREATE_FLAG_ASYNCHRONOUS                      = 1u << 3u,
+
+    /// Create the pipeline from the pipeline cache on the calling thread, and compile it
+    /// asynchronously if it is not found in the cache.
+
+    /// When this flag is set, the creation method first tries to create the pipeline without
+    /// compiling it: in Vulkan, the pipeline is created with VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT
+    /// using PipelineStateCreateInfo::pPSOCache as well as the driver's internal cache;
+    /// in Direct3D12, the pipeline is looked up in the pipeline library of PipelineStateCreateInfo::pPSOCache.
+    /// If the pipeline is found, it is ready when the method returns. Otherwise, the pipeline is compiled
+    /// by the shader compilation thread pool of the render device in the same way as with
+    /// PSO_CREATE_FLAG_ASYNCHRONOUS flag, and IPipelineState::GetStatus() returns
+    /// PIPELINE_STATE_STATUS_COMPILING until the compilation is finished.
+    /// This way, the calling thread never waits for the pipeline compilation.
+    ///
+    /// \remarks    The flag is supported by the same pipelines and backends as PSO_CREATE_FLAG_ASYNCHRONOUS,
+    ///             and is ignored in the same cases. Vulkan requires VK_EXT_pipeline_creation_cache_control
+    ///             extension to probe the cache; when the extension is not supported, or when the pipeline
+    ///             is built from graphics pipeline libraries, the pipeline is always compiled asynchronously.
+    ///             In OpenGL, the flag is equivalent to PSO_CREATE_FLAG_ASYNCHRONOUS.
+    ///             When both flags are set, PSO_CREATE_FLAG_ASYNCHRONOUS takes precedence.
+    PSO_CREATE_FLAG_ASYNCHRONOUS_ON_CACHE_MISS        = 1u << 4u,
+
+    PSO_CREATE_FLAG_LAST = PSO_CREATE_FLAG_ASYNCHRONOUS_ON_CACHE_MISS
 };
 DEFINE_FLAG_ENUM_OPERATORS(PSO_CREATE_FLAGS);
 
 
+/// Pipeline state status
+DILIGENT_TYPED_ENUM(PIPELINE_STATE_STATUS, Uint32)
+{
+    /// Initial state.
+    PIPELINE_STATE_STATUS_UNINITIALIZED = 0,
+
+    /// The pipeline is being initialized asynchronously.
+    PIPELINE_STATE_STATUS_COMPILING,
+
+    /// The pipeline is ready to be used.
+    PIPELINE_STATE_STATUS_READY,
+
+    /// The pipeline failed to initialize.
+    /// Details are output to the debug log.
+    PIPELINE_STATE_STATUS_FAILED
+};
+
+
 /// Pipeline state creation attributes
 struct PipelineStateCreateInfo
 {
@@ -1149,6 +1244,24 @@ DILIGENT_BEGIN_INTERFACE(IPipelineState, IDeviceObject)
     /// \return     Pointer to pipeline resource signature interface.
     VIRTUAL IPipelineResourceSignature* METHOD(GetResourceSignature)(THIS_
                                                                      Uint32 Index) CONST PURE;
+
+
+    /// Returns the pipeline state status, see Diligent::PIPELINE_STATE_STATUS.
+
+    /// \param [in] WaitForCompletion - If true, the method will wait until the pipeline
+    ///                                 is initialized if it is being created asynchronously
+    ///                                 (see Diligent::PSO_CREATE_FLAG_ASYNCHRONOUS).
+    ///
+    /// \return    Pipeline state status.
+    ///
+    /// \remarks   Pipelines that are created synchronously are always in
+    ///            PIPELINE_STATE_STATUS_READY state.
+    ///            While the pipeline is in PIPELINE_STATE_STATUS_COMPILING state, an application
+    ///            must not use it in any way other than querying its status.
+    ///            If the pipeline ends up in PIPELINE_STATE_STATUS_FAILED state, the only
+    ///            thing the application can do is to release it.
+    VIRTUAL PIPELINE_STATE_STATUS METHOD(GetStatus)(THIS_
+                                                    Bool WaitForCompletion DEFAULT_VALUE(false)) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -1173,6 +1286,7 @@ DILIGENT_END_INTERFACE
 #    define IPipelineState_IsCompatibleWith(This, ...)             CALL_IFACE_METHOD(PipelineState, IsCompatibleWith,             This, __VA_ARGS__)
 #    define IPipelineState_GetResourceSignatureCount(This)         CALL_IFACE_METHOD(PipelineState, GetResourceSignatureCount,    This)
 #    define IPipelineState_GetResourceSignature(This, ...)         CALL_IFACE_METHOD(PipelineState, GetResourceSignature,         This, __VA_ARGS__)
+#    define IPipelineState_GetStatus(This, ...)                    CALL_IFACE_METHOD(PipelineState, GetStatus,                    This, __VA_ARGS__)
 
 // clang-format on
 
@@ -58,6 +58,8 @@ struct PipelineStateCacheDesc DILIGENT_DERIVE(DeviceObjectAttribs)
     ///       and loading PSOs from it on another.
     ///       Vulkan PSO cache depends on the GPU device, driver version and other parameters,
     ///       so the cache must be generated and used on the same device.
+    ///       OpenGL PSO cache contains linked program binaries and is ignored if the vendor,
+    ///       renderer or version string of the driver differs from the one that generated it.
     PSO_CACHE_MODE Mode DEFAULT_INITIALIZER(PSO_CACHE_MODE_LOAD | PSO_CACHE_MODE_STORE);
 
     // ImmediateContextMask ?
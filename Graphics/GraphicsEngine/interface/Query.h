@@ -28,7 +28,7 @@
 #pragma once
 
 /// \file
-/// Defines Diligent::IQuery interface and related data structures
+/// Defines Diligent::IQuery and Diligent::IQueryArray interfaces and related data structures
 
 #include "DeviceObject.h"
 #include "GraphicsTypes.h"
@@ -39,6 +39,10 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_Query =
     {0x70f2a88a, 0xf8be, 0x4901, {0x8f, 0x5, 0x2f, 0x72, 0xfa, 0x69, 0x5b, 0xa0}};
 
+// {5B8E2C31-94A7-4E6D-B0C3-7F1A2D9E4C68}
+static const INTERFACE_ID IID_QueryArray =
+    {0x5b8e2c31, 0x94a7, 0x4e6d, {0xb0, 0xc3, 0x7f, 0x1a, 0x2d, 0x9e, 0x4c, 0x68}};
+
 /// Occlusion query data.
 /// This structure is filled by IQuery::GetData() for Diligent::QUERY_TYPE_OCCLUSION query type.
 struct QueryDataOcclusion
@@ -226,4 +230,80 @@ DILIGENT_END_INTERFACE
 
 #endif
 
+
+/// Query array description.
+struct QueryArrayDesc DILIGENT_DERIVE(DeviceObjectAttribs)
+
+    /// Type of all queries in the array, see Diligent::QUERY_TYPE.
+
+    /// Allowed types are Diligent::QUERY_TYPE_OCCLUSION, Diligent::QUERY_TYPE_BINARY_OCCLUSION,
+    /// Diligent::QUERY_TYPE_TIMESTAMP and Diligent::QUERY_TYPE_PIPELINE_STATISTICS.
+    enum QUERY_TYPE Type DEFAULT_INITIALIZER(QUERY_TYPE_UNDEFINED);
+
+    /// The number of queries in the array.
+    Uint32 Size DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr QueryArrayDesc() noexcept {};
+
+    constexpr QueryArrayDesc(QUERY_TYPE _Type, Uint32 _Size) noexcept :
+        Type{_Type},
+        Size{_Size}
+    {}
+#endif
+};
+typedef struct QueryArrayDesc QueryArrayDesc;
+
+#define DILIGENT_INTERFACE_NAME IQueryArray
+#include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
+
+#define IQueryArrayInclusiveMethods \
+    IDeviceObjectInclusiveMethods;  \
+    IQueryArrayMethods QueryArray
+
+// clang-format off
+
+/// Query array interface.
+
+/// A query array is a contiguous range of queries of the same type that is owned by the application.
+/// Individual queries are begun and ended with IDeviceContext::BeginIndexedQuery() and
+/// IDeviceContext::EndIndexedQuery(), and the results of any range of queries are written by the GPU
+/// to a buffer with IDeviceContext::ResolveQueryArray(), without reading them back on the CPU.
+/// This allows issuing thousands of occlusion queries per frame, e.g. one per object, and consuming
+/// their results on the GPU, see IDeviceContext::SetPredication().
+DILIGENT_BEGIN_INTERFACE(IQueryArray, IDeviceObject)
+{
+#if DILIGENT_CPP_INTERFACE
+    /// Returns the query array description used to create the object.
+    virtual const QueryArrayDesc& METHOD(GetDesc)() const override = 0;
+#endif
+
+    /// Returns the size, in bytes, of the result of one query written by IDeviceContext::ResolveQueryArray().
+
+    /// \remarks    Occlusion, binary occlusion and timestamp queries are resolved to one 64-bit value.
+    ///             Binary occlusion queries are resolved to 0 or 1.
+    ///             Timestamp values are in ticks of the command queue timestamp frequency.
+    ///
+    ///             Pipeline statistics queries are resolved to an array of 64-bit counters whose
+    ///             layout is backend-specific: D3D12_QUERY_DATA_PIPELINE_STATISTICS in Direct3D12,
+    ///             and the counters enabled for the graphics queue in the order of
+    ///             VkQueryPipelineStatisticFlagBits in Vulkan.
+    VIRTUAL Uint32 METHOD(GetQueryDataStride)(THIS) CONST PURE;
+};
+DILIGENT_END_INTERFACE
+
+#include "../../../Primitives/interface/UndefInterfaceHelperMacros.h"
+
+#if DILIGENT_C_INTERFACE
+
+// clang-format off
+
+#    define IQueryArray_GetDesc(This) (const struct QueryArrayDesc*)IDeviceObject_GetDesc(This)
+
+#    define IQueryArray_GetQueryDataStride(This) CALL_IFACE_METHOD(QueryArray, GetQueryDataStride, This)
+
+// clang-format on
+
+#endif
+
 DILIGENT_END_NAMESPACE // namespace Diligent
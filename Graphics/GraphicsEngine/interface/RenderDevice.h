@@ -227,6 +227,20 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
                                      IQuery**            ppQuery) PURE;
 
 
+    /// Creates a new query array object
+
+    /// \param [in]  Desc         - Query array description, see Diligent::QueryArrayDesc for details.
+    /// \param [out] ppQueryArray - Address of the memory location where a pointer to the
+    ///                             query array interface will be written.
+    ///                             The function calls AddRef(), so that the new object will have
+    ///                             one reference.
+    ///
+    /// \remarks   Query arrays are supported in Direct3D12 and Vulkan backends.
+    VIRTUAL void METHOD(CreateQueryArray)(THIS_
+                                          const QueryArrayDesc REF Desc,
+                                          IQueryArray**            ppQueryArray) PURE;
+
+
     /// Creates a render pass object
 
     /// \param [in]  Desc         - Render pass description, see Diligent::RenderPassDesc for details.
@@ -391,6 +405,69 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
     VIRTUAL IEngineFactory* METHOD(GetEngineFactory)(THIS) CONST PURE;
 
 
+    /// Returns the current device memory budget and usage, see Diligent::DeviceMemoryBudget.
+
+    /// \remarks   The budget is queried from the OS or the driver every time the method is called:
+    ///            in Direct3D11 and Direct3D12, with IDXGIAdapter3::QueryVideoMemoryInfo();
+    ///            in Vulkan, with VK_EXT_memory_budget extension; in OpenGL, with
+    ///            GL_NVX_gpu_memory_info extension.
+    ///            The members are zero if the budget can't be queried.
+    VIRTUAL DeviceMemoryBudget METHOD(GetMemoryBudget)(THIS) CONST PURE;
+
+
+    /// Registers the callback that is invoked when the memory usage exceeds the pressure threshold,
+    /// see EngineCreateInfo::MemoryPressureThreshold.
+
+    /// \param [in] Callback  - Callback function.
+    /// \param [in] pUserData - User data pointer that is passed to the callback.
+    ///
+    /// \remarks   The callbacks are invoked from the thread that calls IDeviceContext::FinishFrame()
+    ///            for the first immediate context before the driver starts paging resources, so that
+    ///            texture streamers and resource pools (e.g. DynamicTextureArray) may release the memory
+    ///            they don't immediately need.
+    ///
+    ///            The same pair of the callback and user data may only be registered once.
+    ///
+    /// \remarks This method is thread-safe.
+    VIRTUAL void METHOD(AddMemoryPressureCallback)(THIS_
+                                                   MemoryPressureCallbackType Callback,
+                                                   void*                      pUserData) PURE;
+
+
+    /// Unregisters the callback previously registered with AddMemoryPressureCallback().
+
+    /// \remarks This method is thread-safe.
+    VIRTUAL void METHOD(RemoveMemoryPressureCallback)(THIS_
+                                                      MemoryPressureCallbackType Callback,
+                                                      void*                      pUserData) PURE;
+
+
+    /// Returns the memory requirements of a texture that is placed in device memory.
+
+    /// \param [in] TexDesc - Texture description. Usage must be USAGE_DEFAULT.
+    ///
+    /// \return    The size and the alignment of the memory range that the texture occupies
+    ///            when it is created with TextureData::pMemory. The members are zero
+    ///            if placed resources are not supported by the device.
+    ///
+    /// \remarks   This method is thread-safe.
+    VIRTUAL ResourceMemoryRequirements METHOD(GetTextureMemoryRequirements)(THIS_
+                                                                           const TextureDesc REF TexDesc) CONST PURE;
+
+
+    /// Returns the memory requirements of a buffer that is placed in device memory.
+
+    /// \param [in] BuffDesc - Buffer description. Usage must be USAGE_DEFAULT.
+    ///
+    /// \return    The size and the alignment of the memory range that the buffer occupies
+    ///            when it is created with BufferData::pMemory. The members are zero
+    ///            if placed resources are not supported by the device.
+    ///
+    /// \remarks   This method is thread-safe.
+    VIRTUAL ResourceMemoryRequirements METHOD(GetBufferMemoryRequirements)(THIS_
+                                                                          const BufferDesc REF BuffDesc) CONST PURE;
+
+
 #if DILIGENT_CPP_INTERFACE
     /// Overloaded alias for CreateGraphicsPipelineState.
     void CreatePipelineState(const GraphicsPipelineStateCreateInfo& CI, IPipelineState** ppPipelineState)
@@ -431,6 +508,7 @@ DILIGENT_END_INTERFACE
 #    define IRenderDevice_CreateRayTracingPipelineState(This, ...)   CALL_IFACE_METHOD(RenderDevice, CreateRayTracingPipelineState,   This, __VA_ARGS__)
 #    define IRenderDevice_CreateFence(This, ...)                     CALL_IFACE_METHOD(RenderDevice, CreateFence,                     This, __VA_ARGS__)
 #    define IRenderDevice_CreateQuery(This, ...)                     CALL_IFACE_METHOD(RenderDevice, CreateQuery,                     This, __VA_ARGS__)
+#    define IRenderDevice_CreateQueryArray(This, ...)                CALL_IFACE_METHOD(RenderDevice, CreateQueryArray,                This, __VA_ARGS__)
 #    define IRenderDevice_CreateRenderPass(This, ...)                CALL_IFACE_METHOD(RenderDevice, CreateRenderPass,                This, __VA_ARGS__)
 #    define IRenderDevice_CreateFramebuffer(This, ...)               CALL_IFACE_METHOD(RenderDevice, CreateFramebuffer,               This, __VA_ARGS__)
 #    define IRenderDevice_CreateBLAS(This, ...)                      CALL_IFACE_METHOD(RenderDevice, CreateBLAS,                      This, __VA_ARGS__)
@@ -446,6 +524,11 @@ DILIGENT_END_INTERFACE
 #    define IRenderDevice_ReleaseStaleResources(This, ...)           CALL_IFACE_METHOD(RenderDevice, ReleaseStaleResources,           This, __VA_ARGS__)
 #    define IRenderDevice_IdleGPU(This)                              CALL_IFACE_METHOD(RenderDevice, IdleGPU,                         This)
 #    define IRenderDevice_GetEngineFactory(This)                     CALL_IFACE_METHOD(RenderDevice, GetEngineFactory,                This)
+#    define IRenderDevice_GetMemoryBudget(This)                      CALL_IFACE_METHOD(RenderDevice, GetMemoryBudget,                 This)
+#    define IRenderDevice_AddMemoryPressureCallback(This, ...)       CALL_IFACE_METHOD(RenderDevice, AddMemoryPressureCallback,       This, __VA_ARGS__)
+#    define IRenderDevice_RemoveMemoryPressureCallback(This, ...)    CALL_IFACE_METHOD(RenderDevice, RemoveMemoryPressureCallback,    This, __VA_ARGS__)
+#    define IRenderDevice_GetTextureMemoryRequirements(This, ...)    CALL_IFACE_METHOD(RenderDevice, GetTextureMemoryRequirements,    This, __VA_ARGS__)
+#    define IRenderDevice_GetBufferMemoryRequirements(This, ...)     CALL_IFACE_METHOD(RenderDevice, GetBufferMemoryRequirements,     This, __VA_ARGS__)
 // clang-format on
 
 #endif
@@ -167,6 +167,37 @@ DILIGENT_BEGIN_INTERFACE(IResourceMapping, IObject)
 
     /// Returns the size of the resource mapping, i.e. the number of objects.
     VIRTUAL size_t METHOD(GetSize)(THIS) PURE;
+
+    /// Finds consecutive elements of a resource array in the mapping.
+
+    /// \param [in]  Name        - Resource array name.
+    /// \param [in]  StartIndex  - Index of the first array element to find.
+    /// \param [in]  NumElements - The number of elements to find.
+    /// \param [out] ppObjects   - Pointer to the array of NumElements pointers that receive
+    ///                            the objects. Elements that are not found are set to null.
+    ///
+    /// \return The number of elements that were found.
+    ///
+    /// \remarks This method is equivalent to calling GetResource() for every element, but
+    ///          computes the name hash and locks the mapping only once.
+    ///          Same as GetResource(), the method does *NOT* increase the reference counters
+    ///          of the returned objects.
+    VIRTUAL Uint32 METHOD(GetResourceArray)(THIS_
+                                            const Char*     Name,
+                                            Uint32          StartIndex,
+                                            Uint32          NumElements,
+                                            IDeviceObject** ppObjects) PURE;
+
+    /// Seals the resource mapping.
+
+    /// \remarks After the mapping is sealed, resources can't be added to or removed from it,
+    ///          and lookups do not lock the mapping. Sealing is typically done once all global
+    ///          resources have been added, before the mapping is used to bind resources from
+    ///          multiple threads. A sealed mapping can't be unsealed.
+    VIRTUAL void METHOD(Seal)(THIS) PURE;
+
+    /// Returns true if the resource mapping is sealed, see IResourceMapping::Seal().
+    VIRTUAL Bool METHOD(IsSealed)(THIS) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -181,6 +212,9 @@ DILIGENT_END_INTERFACE
 #    define IResourceMapping_RemoveResourceByName(This, ...) CALL_IFACE_METHOD(ResourceMapping, RemoveResourceByName, This, __VA_ARGS__)
 #    define IResourceMapping_GetResource(This, ...)          CALL_IFACE_METHOD(ResourceMapping, GetResource,          This, __VA_ARGS__)
 #    define IResourceMapping_GetSize(This)                   CALL_IFACE_METHOD(ResourceMapping, GetSize,              This)
+#    define IResourceMapping_GetResourceArray(This, ...)     CALL_IFACE_METHOD(ResourceMapping, GetResourceArray,     This, __VA_ARGS__)
+#    define IResourceMapping_Seal(This)                      CALL_IFACE_METHOD(ResourceMapping, Seal,                 This)
+#    define IResourceMapping_IsSealed(This)                  CALL_IFACE_METHOD(ResourceMapping, IsSealed,             This)
 
 // clang-format on
 
@@ -312,9 +312,11 @@ struct ShaderCreateInfo
     /// Compiled shader bytecode.
 
     /// If shader byte code is provided, FilePath and Source members must be null
-    /// \note  This option is supported for D3D11, D3D12, Vulkan and Metal backends.
+    /// \note  This option is supported for D3D11, D3D12, Vulkan, Metal and OpenGL backends.
     ///        For D3D11 and D3D12 backends, DXBC should be provided.
     ///        Vulkan backend expects SPIRV bytecode.
+    ///        OpenGL backend expects the full GLSL source returned by IShader::GetBytecode,
+    ///        which is compiled as is without HLSL-to-GLSL conversion.
     ///        Metal backend supports .metallib bytecode to create MTLLibrary
     ///        or SPIRV to translate it to MSL and compile (may be slow).
     ///
@@ -45,6 +45,53 @@ static const INTERFACE_ID IID_ShaderResourceBinding =
     {0x61f8774, 0x9a09, 0x48e8, {0x84, 0x11, 0xb5, 0xbd, 0x20, 0x56, 0x1, 0x4}};
 
 
+/// Describes a single resource update performed by IShaderResourceBinding::SetResources().
+struct ShaderResourceVariableUpdate
+{
+    // clang-format off
+    /// Shader stage of the variable. Must be one of Diligent::SHADER_TYPE.
+    /// Updates with SHADER_TYPE_UNKNOWN are skipped.
+    SHADER_TYPE    ShaderType    DEFAULT_INITIALIZER(SHADER_TYPE_UNKNOWN);
+
+    /// Index of the variable in the shader stage, see IShaderResourceBinding::GetVariableByIndex().
+    Uint32         VariableIndex DEFAULT_INITIALIZER(0);
+
+    /// Array element to update.
+    Uint32         ArrayIndex    DEFAULT_INITIALIZER(0);
+
+    /// Object to bind. May be null to unbind the resource.
+    IDeviceObject* pObject       DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset of the buffer range to bind, see IShaderResourceVariable::SetBufferRange().
+    /// Only allowed for constant buffers.
+    Uint64         BufferOffset  DEFAULT_INITIALIZER(0);
+
+    /// Size of the buffer range to bind. Zero means the whole buffer starting at BufferOffset.
+    Uint64         BufferRange   DEFAULT_INITIALIZER(0);
+    // clang-format on
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr ShaderResourceVariableUpdate() noexcept
+    {}
+
+    constexpr ShaderResourceVariableUpdate(SHADER_TYPE    _ShaderType,
+                                           Uint32         _VariableIndex,
+                                           IDeviceObject* _pObject,
+                                           Uint32         _ArrayIndex   = ShaderResourceVariableUpdate{}.ArrayIndex,
+                                           Uint64         _BufferOffset = ShaderResourceVariableUpdate{}.BufferOffset,
+                                           Uint64         _BufferRange  = ShaderResourceVariableUpdate{}.BufferRange) noexcept :
+        ShaderType{_ShaderType},
+        VariableIndex{_VariableIndex},
+        ArrayIndex{_ArrayIndex},
+        pObject{_pObject},
+        BufferOffset{_BufferOffset},
+        BufferRange{_BufferRange}
+    {}
+#endif
+};
+typedef struct ShaderResourceVariableUpdate ShaderResourceVariableUpdate;
+
+
 #define DILIGENT_INTERFACE_NAME IShaderResourceBinding
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -151,6 +198,24 @@ DILIGENT_BEGIN_INTERFACE(IShaderResourceBinding, IObject)
 
     /// Returns true if static resources have been initialized in this SRB.
     VIRTUAL Bool METHOD(StaticResourcesInitialized)(THIS) CONST PURE;
+
+
+    /// Sets multiple mutable and dynamic resources in one call.
+
+    /// \param [in] pUpdates   - Array of resource updates, see Diligent::ShaderResourceVariableUpdate.
+    /// \param [in] NumUpdates - Number of elements in pUpdates array.
+    /// \param [in] Flags      - Flags that apply to every update, see Diligent::SET_SHADER_RESOURCE_FLAGS.
+    ///
+    /// \remarks   The method is equivalent to calling IShaderResourceVariable::SetArray() or
+    ///            IShaderResourceVariable::SetBufferRange() for every update, but avoids a
+    ///            virtual call and a variable lookup per resource.
+    ///            Variable indices do not change for SRBs created by the same pipeline resource
+    ///            signature, so they may be resolved once with GetVariableByName() and
+    ///            IShaderResourceVariable::GetIndex() and then reused.
+    VIRTUAL void METHOD(SetResources)(THIS_
+                                      const ShaderResourceVariableUpdate* pUpdates,
+                                      Uint32                              NumUpdates,
+                                      SET_SHADER_RESOURCE_FLAGS           Flags DEFAULT_VALUE(SET_SHADER_RESOURCE_FLAG_NONE)) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -167,6 +232,7 @@ DILIGENT_END_INTERFACE
 #    define IShaderResourceBinding_GetVariableCount(This, ...)        CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableCount,             This, __VA_ARGS__)
 #    define IShaderResourceBinding_GetVariableByIndex(This, ...)      CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableByIndex,           This, __VA_ARGS__)
 #    define IShaderResourceBinding_StaticResourcesInitialized(This)   CALL_IFACE_METHOD(ShaderResourceBinding, StaticResourcesInitialized,   This)
+#    define IShaderResourceBinding_SetResources(This, ...)            CALL_IFACE_METHOD(ShaderResourceBinding, SetResources,                 This, __VA_ARGS__)
 
 // clang-format on
 
@@ -269,6 +269,26 @@ DILIGENT_BEGIN_INTERFACE(IShaderResourceVariable, IObject)
     ///                          non-array variables.
     VIRTUAL IDeviceObject* METHOD(Get)(THIS_
                                        Uint32 ArrayIndex DEFAULT_VALUE(0)) CONST PURE;
+
+
+    /// Sets the values of inline constants
+
+    /// \param [in] pConstants    - a pointer to the array of 32-bit constant values.
+    /// \param [in] FirstConstant - index of the first 32-bit constant to set.
+    /// \param [in] NumConstants  - the number of 32-bit constants in pConstants array.
+    ///
+    /// \remarks This method is only allowed for variables created with
+    ///          PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS flag. The range
+    ///          [FirstConstant, FirstConstant + NumConstants) must not exceed
+    ///          PipelineResourceDesc::NumInlineConstants. Constants outside of the range
+    ///          keep their previous values (initially zero).
+    ///
+    ///          Changing inline constants does not require committing the SRB: new values
+    ///          are used by the next draw or dispatch command.
+    VIRTUAL void METHOD(SetInlineConstants)(THIS_
+                                            const void* pConstants,
+                                            Uint32      FirstConstant,
+                                            Uint32      NumConstants) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -278,14 +298,15 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IShaderResourceVariable_Set(This, ...)             CALL_IFACE_METHOD(ShaderResourceVariable, Set,             This, __VA_ARGS__)
-#    define IShaderResourceVariable_SetArray(This, ...)        CALL_IFACE_METHOD(ShaderResourceVariable, SetArray,        This, __VA_ARGS__)
-#    define IShaderResourceVariable_SetBufferRange(This, ...)  CALL_IFACE_METHOD(ShaderResourceVariable, SetBufferRange,  This, __VA_ARGS__)
-#    define IShaderResourceVariable_SetBufferOffset(This, ...) CALL_IFACE_METHOD(ShaderResourceVariable, SetBufferOffset, This, __VA_ARGS__)
-#    define IShaderResourceVariable_GetType(This)              CALL_IFACE_METHOD(ShaderResourceVariable, GetType,         This)
-#    define IShaderResourceVariable_GetResourceDesc(This, ...) CALL_IFACE_METHOD(ShaderResourceVariable, GetResourceDesc, This, __VA_ARGS__)
-#    define IShaderResourceVariable_GetIndex(This)             CALL_IFACE_METHOD(ShaderResourceVariable, GetIndex,        This)
-#    define IShaderResourceVariable_Get(This, ...)             CALL_IFACE_METHOD(ShaderResourceVariable, Get,             This, __VA_ARGS__)
+#    define IShaderResourceVariable_Set(This, ...)                CALL_IFACE_METHOD(ShaderResourceVariable, Set,                This, __VA_ARGS__)
+#    define IShaderResourceVariable_SetArray(This, ...)           CALL_IFACE_METHOD(ShaderResourceVariable, SetArray,           This, __VA_ARGS__)
+#    define IShaderResourceVariable_SetBufferRange(This, ...)     CALL_IFACE_METHOD(ShaderResourceVariable, SetBufferRange,     This, __VA_ARGS__)
+#    define IShaderResourceVariable_SetBufferOffset(This, ...)    CALL_IFACE_METHOD(ShaderResourceVariable, SetBufferOffset,    This, __VA_ARGS__)
+#    define IShaderResourceVariable_GetType(This)                 CALL_IFACE_METHOD(ShaderResourceVariable, GetType,            This)
+#    define IShaderResourceVariable_GetResourceDesc(This, ...)    CALL_IFACE_METHOD(ShaderResourceVariable, GetResourceDesc,    This, __VA_ARGS__)
+#    define IShaderResourceVariable_GetIndex(This)                CALL_IFACE_METHOD(ShaderResourceVariable, GetIndex,           This)
+#    define IShaderResourceVariable_Get(This, ...)                CALL_IFACE_METHOD(ShaderResourceVariable, Get,                This, __VA_ARGS__)
+#    define IShaderResourceVariable_SetInlineConstants(This, ...) CALL_IFACE_METHOD(ShaderResourceVariable, SetInlineConstants, This, __VA_ARGS__)
 
 // clang-format on
 
@@ -91,7 +91,8 @@ DILIGENT_BEGIN_INTERFACE(ISwapChain, IObject)
 
     /// Sets the maximum number of frames that the swap chain is allowed to queue for rendering.
 
-    /// This value is only relevant for D3D11 and D3D12 backends and ignored for others.
+    /// This value is only relevant for D3D11 and D3D12 backends, and for Vulkan backend in the
+    /// low-latency mode (see SwapChainDesc::LowLatencyMode). It is ignored for others.
     /// By default it matches the number of buffers in the swap chain. For example, for a 2-buffer
     /// swap chain, the CPU can enqueue frames 0 and 1, but Present command of frame 2
     /// will block until frame 0 is presented. If in the example above the maximum frame latency is set
@@ -99,6 +100,15 @@ DILIGENT_BEGIN_INTERFACE(ISwapChain, IObject)
     VIRTUAL void METHOD(SetMaximumFrameLatency)(THIS_
                                                 Uint32 MaxLatency) PURE;
 
+    /// Waits until the swap chain is ready to accept a new frame without exceeding the maximum frame latency.
+
+    /// In the low-latency mode (see SwapChainDesc::LowLatencyMode), the application must call
+    /// this method every frame right before it samples the user input. In other modes, the
+    /// swap chain waits in Present() and the method returns immediately.
+    ///
+    /// \note  The method must be called from the same thread as Present().
+    VIRTUAL void METHOD(WaitForFrame)(THIS) PURE;
+
     /// Returns render target view of the current back buffer in the swap chain
 
     /// \note For Direct3D12 and Vulkan backends, the function returns
@@ -131,6 +141,7 @@ DILIGENT_END_INTERFACE
 #    define ISwapChain_SetFullscreenMode(This, ...)      CALL_IFACE_METHOD(SwapChain, SetFullscreenMode,       This, __VA_ARGS__)
 #    define ISwapChain_SetWindowedMode(This)             CALL_IFACE_METHOD(SwapChain, SetWindowedMode,         This)
 #    define ISwapChain_SetMaximumFrameLatency(This, ...) CALL_IFACE_METHOD(SwapChain, SetMaximumFrameLatency,  This, __VA_ARGS__)
+#    define ISwapChain_WaitForFrame(This)                CALL_IFACE_METHOD(SwapChain, WaitForFrame,            This)
 #    define ISwapChain_GetCurrentBackBufferRTV(This)     CALL_IFACE_METHOD(SwapChain, GetCurrentBackBufferRTV, This)
 #    define ISwapChain_GetDepthBufferDSV(This)           CALL_IFACE_METHOD(SwapChain, GetDepthBufferDSV,       This)
 
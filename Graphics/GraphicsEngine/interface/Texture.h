@@ -336,6 +336,21 @@ struct TextureData
     /// will be used.
     struct IDeviceContext* pContext     DEFAULT_INITIALIZER(nullptr);
 
+    /// Optional device memory to place the texture in.
+
+    /// When not null, the texture is created at MemoryOffset in the memory object instead of
+    /// allocating its own memory. The memory must be created with DEVICE_MEMORY_TYPE_PLACED,
+    /// and the texture must use USAGE_DEFAULT. Textures whose memory ranges overlap alias each other;
+    /// use aliasing barriers (see StateTransitionDesc) to switch between them.
+    /// Use IRenderDevice::GetTextureMemoryRequirements() to get the size and the alignment of the texture memory.
+    ///
+    /// \remarks The texture keeps a strong reference to the memory object.
+    struct IDeviceMemory* pMemory       DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset in pMemory, in bytes. Must be a multiple of ResourceMemoryRequirements::Alignment,
+    /// and the memory range of the texture must be inside a single memory page.
+    Uint64             MemoryOffset     DEFAULT_INITIALIZER(0);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr TextureData() noexcept {}
 
@@ -441,6 +456,10 @@ DILIGENT_BEGIN_INTERFACE(ITexture, IDeviceObject)
     ///          For non-array textures, the only allowed values for the number of slices are 0 and 1.\n
     ///          Texture view will contain strong reference to the texture, so the texture will not be destroyed
     ///          until all views are released.\n
+    ///          If a view with the same description and name is still alive, the texture
+    ///          returns that view instead of creating a new one. If ViewDesc.Name is null, the name
+    ///          is ignored. Views that have been assigned a sampler with ITextureView::SetSampler()
+    ///          are never returned to other callers.\n
     ///          The function calls AddRef() for the created interface, so it must be released by
     ///          a call to Release() when it is no longer needed.
     VIRTUAL void METHOD(CreateView)(THIS_
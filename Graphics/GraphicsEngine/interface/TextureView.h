@@ -255,7 +255,7 @@ struct TextureViewDesc DILIGENT_DERIVE(DeviceObjectAttribs)
     /// \param [in] RHS - reference to the structure to compare with.
     ///
     /// \return     true if all members of the two structures *except for the Name* are equal,
-    ///             and false otherwise.
+    ///           and false otherwise.
     ///
     /// \note   The operator ignores the Name field as it is used for debug purposes and
     ///         doesn't affect the texture view properties.
@@ -312,12 +312,21 @@ DILIGENT_BEGIN_INTERFACE(ITextureView, IDeviceObject)
     /// when accessing a texture from shaders. Only
     /// shader resource views can be assigned a sampler.
     /// The view will keep strong reference to the sampler.
+    ///
+    /// \remarks ITexture::CreateView() may return the same view object to several callers
+    ///          that request identical views. The sampler is a property of the view object,
+    ///          so it is seen by all holders of the view. Once a sampler is set, the view is
+    ///          no longer returned by ITexture::CreateView(), so subsequent requests get a new view.
+    ///          To avoid affecting other holders, set the sampler on a view right after creating it.
     VIRTUAL void METHOD(SetSampler)(THIS_ struct ISampler * pSampler) PURE;
 
     /// Returns the pointer to the sampler object set by the ITextureView::SetSampler().
 
     /// The method does *NOT* increment the reference counter of the returned object,
     /// so Release() must not be called.
+    ///
+    /// \remarks If the view is shared (see ITexture::CreateView()), the method returns
+    ///          the sampler set by any of its holders.
     VIRTUAL struct ISampler* METHOD(GetSampler)(THIS) PURE;
 
 
@@ -27,6 +27,7 @@
 
 #include "BufferBase.hpp"
 #include "DeviceContext.h"
+#include "DeviceMemory.h"
 #include "GraphicsAccessories.hpp"
 
 namespace Diligent
@@ -209,6 +210,17 @@ void ValidateBufferInitData(const BufferDesc& Desc, const BufferData* pBuffData)
         VERIFY_BUFFER(pBuffData->DataSize >= Desc.Size,
                       "Buffer initial DataSize (", pBuffData->DataSize, ") must be larger than the buffer size (", Desc.Size, ")");
     }
+
+    if (pBuffData != nullptr && pBuffData->pMemory != nullptr)
+    {
+        const auto& MemDesc = pBuffData->pMemory->GetDesc();
+        VERIFY_BUFFER(Desc.Usage == USAGE_DEFAULT, "buffers that are placed in device memory must use USAGE_DEFAULT.");
+        VERIFY_BUFFER(MemDesc.Type == DEVICE_MEMORY_TYPE_PLACED,
+                      "device memory must be created with DEVICE_MEMORY_TYPE_PLACED.");
+        VERIFY_BUFFER((Desc.ImmediateContextMask & ~MemDesc.ImmediateContextMask) == 0,
+                      "ImmediateContextMask (", std::hex, Desc.ImmediateContextMask, ") must be a subset of the ImmediateContextMask (",
+                      std::hex, MemDesc.ImmediateContextMask, ") of the device memory.");
+    }
 }
 
 #undef VERIFY_BUFFER
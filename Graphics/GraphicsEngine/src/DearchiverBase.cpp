@@ -27,6 +27,8 @@
 #include "DearchiverBase.hpp"
 #include "PipelineStateBase.hpp"
 #include "PSOSerializer.hpp"
+#include "DataBlobImpl.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -146,40 +148,14 @@ struct DearchiverBase::RPData
 
 
 template <typename ResType>
-bool DearchiverBase::NamedResourceCache<ResType>::Get(ResourceType Type, const char* Name, ResType** ppResource)
+void DearchiverBase::NamedResourceCache<ResType>::Remove(ResourceType Type, const char* Name)
 {
     VERIFY_EXPR(Name != nullptr && Name[0] != '\0');
-    VERIFY_EXPR(ppResource != nullptr && *ppResource == nullptr);
-    *ppResource = nullptr;
 
     std::unique_lock<std::mutex> Lock{m_Mtx};
-
-    auto it = m_Map.find(NamedResourceKey{Type, Name});
-    if (it == m_Map.end())
-        return false;
-
-    auto Ptr = it->second.Lock();
-    if (!Ptr)
-        return false;
-
-    *ppResource = Ptr.Detach();
-    return true;
-}
-
-template <typename ResType>
-void DearchiverBase::NamedResourceCache<ResType>::Set(ResourceType Type, const char* Name, ResType* pResource)
-{
-    VERIFY_EXPR(Name != nullptr && Name[0] != '\0');
-    VERIFY_EXPR(pResource != nullptr);
-
-    std::unique_lock<std::mutex> Lock{m_Mtx};
-    m_Map.emplace(NamedResourceKey{Type, Name, /*CopyName = */ true}, pResource);
+    m_Map.erase(ResourceKey{Type, HashedName::Find(Name)});
 }
 
-// Instantiation is required by UnpackResourceSignatureImpl
-template class DearchiverBase::NamedResourceCache<IPipelineResourceSignature>;
-
-
 bool DearchiverBase::PRSData::Deserialize(const char* Name, Serializer<SerializerMode::Read>& Ser)
 {
     Desc.Name = Name;
@@ -431,6 +407,28 @@ bool DearchiverBase::UnpackPSOShaders(ArchiveData&             Archive,
 
     auto& ShaderCache = Archive.CachedShaders[static_cast<size_t>(DevType)];
 
+    auto UnpackShaderByIndex = [&](Uint32 Idx) -> RefCntAutoPtr<IShader> {
+        const auto& SerializedShader = pObjArchive->GetSerializedShader(DevType, Idx);
+        if (!SerializedShader)
+            return {};
+
+        ShaderCreateInfo ShaderCI;
+        {
+            Serializer<SerializerMode::Read> ShaderSer{SerializedShader};
+            if (!ShaderSerializer<SerializerMode::Read>::SerializeCI(ShaderSer, ShaderCI))
+            {
+                LOG_ERROR_MESSAGE("Failed to deserialize shader create info. Archive file may be corrupted or invalid.");
+                return {};
+            }
+            VERIFY_EXPR(ShaderSer.IsEnded());
+        }
+
+        if ((PSO.InternalCI.Flags & PSO_CREATE_INTERNAL_FLAG_NO_SHADER_REFLECTION) != 0)
+            ShaderCI.CompileFlags |= SHADER_COMPILE_FLAG_SKIP_REFLECTION;
+
+        return UnpackShader(ShaderCI, pDevice);
+    };
+
     PSO.Shaders.resize(ShaderIndices.Count);
     for (Uint32 i = 0; i < ShaderIndices.Count; ++i)
     {
@@ -438,48 +436,46 @@ bool DearchiverBase::UnpackPSOShaders(ArchiveData&             Archive,
 
         const Uint32 Idx = ShaderIndices.pIndices[i];
 
+        std::promise<RefCntAutoPtr<IShader>> Promise;
         {
-            std::unique_lock<std::mutex> ReadLock{ShaderCache.Mtx};
-            if (Idx < ShaderCache.Shaders.size())
-            {
-                // Try to get cached shader
-                pShader = ShaderCache.Shaders[Idx];
-                if (pShader)
-                    continue;
-            }
-        }
-
-        const auto& SerializedShader = pObjArchive->GetSerializedShader(DevType, Idx);
-        if (!SerializedShader)
-            return false;
+            std::unique_lock<std::mutex> Lock{ShaderCache.Mtx};
+            if (Idx >= ShaderCache.Shaders.size())
+                ShaderCache.Shaders.resize(size_t{Idx} + 1);
 
-        {
-            ShaderCreateInfo ShaderCI;
+            auto& CachedShader = ShaderCache.Shaders[Idx];
+            if (CachedShader.valid())
             {
-                Serializer<SerializerMode::Read> ShaderSer{SerializedShader};
-                if (!ShaderSerializer<SerializerMode::Read>::SerializeCI(ShaderSer, ShaderCI))
-                {
-                    LOG_ERROR_MESSAGE("Failed to deserialize shader create info. Archive file may be corrupted or invalid.");
+                // The shader is either cached or is being unpacked by another thread
+                auto Future = CachedShader;
+                Lock.unlock();
+                pShader = Future.get();
+                if (!pShader)
                     return false;
-                }
-                VERIFY_EXPR(ShaderSer.IsEnded());
+                continue;
             }
 
-            if ((PSO.InternalCI.Flags & PSO_CREATE_INTERNAL_FLAG_NO_SHADER_REFLECTION) != 0)
-                ShaderCI.CompileFlags |= SHADER_COMPILE_FLAG_SKIP_REFLECTION;
+            CachedShader = Promise.get_future().share();
+        }
 
-            pShader = UnpackShader(ShaderCI, pDevice);
-            if (!pShader)
-                return false;
+        try
+        {
+            pShader = UnpackShaderByIndex(Idx);
+        }
+        catch (...)
+        {
+            LOG_ERROR_MESSAGE("Failed to unpack shader ", Idx, ".");
         }
 
-        // Add to the cache
+        if (!pShader)
         {
-            std::unique_lock<std::mutex> WriteLock{ShaderCache.Mtx};
-            if (Idx >= ShaderCache.Shaders.size())
-                ShaderCache.Shaders.resize(size_t{Idx} + 1);
-            ShaderCache.Shaders[Idx] = pShader;
+            // Let the next request try again
+            std::unique_lock<std::mutex> Lock{ShaderCache.Mtx};
+            ShaderCache.Shaders[Idx] = {};
         }
+        Promise.set_value(pShader);
+
+        if (!pShader)
+            return false;
     }
 
     return true;
@@ -490,7 +486,11 @@ DearchiverBase::ArchiveData* DearchiverBase::FindArchive(ResourceType ResType, c
     VERIFY_EXPR(ResType != ResourceType::Undefined);
     VERIFY_EXPR(ResName != nullptr);
 
-    const auto archive_idx_it = m_ResNameToArchiveIdx.find(NamedResourceKey{ResType, ResName});
+    const HashedName Name = HashedName::Find(ResName);
+    if (!Name)
+        return nullptr;
+
+    const auto archive_idx_it = m_ResNameToArchiveIdx.find(ResourceKey{ResType, Name});
     if (archive_idx_it == m_ResNameToArchiveIdx.end())
         return nullptr;
 
@@ -601,10 +601,25 @@ void DearchiverBase::UnpackPipelineStateImpl(const PipelineStateUnpackInfo& Unpa
     if (UnpackInfo.ModifyPipelineStateCreateInfo == nullptr)
     {
         // Since PSO names must be unique (for each PSO type), we use a single cache for all
-        // loaded archives.
-        if (m_Cache.PSO.Get(ResType, UnpackInfo.Name, ppPSO))
-            return;
+        // loaded archives. Concurrent requests for the same PSO wait for the thread that unpacks it.
+        auto pPSO = m_Cache.PSO.GetOrCreate(ResType, UnpackInfo.Name, [&]() {
+            RefCntAutoPtr<IPipelineState> pNewPSO;
+            CreatePipelineState<CreateInfoType>(UnpackInfo, &pNewPSO);
+            return pNewPSO;
+        });
+        *ppPSO    = pPSO.Detach();
     }
+    else
+    {
+        CreatePipelineState<CreateInfoType>(UnpackInfo, ppPSO);
+    }
+}
+
+template <typename CreateInfoType>
+void DearchiverBase::CreatePipelineState(const PipelineStateUnpackInfo& UnpackInfo,
+                                         IPipelineState**               ppPSO)
+{
+    constexpr auto ResType = PSOData<CreateInfoType>::ArchiveResType;
 
     // Find the archive that contains this PSO
     auto* pArchiveData = FindArchive(ResType, UnpackInfo.Name);
@@ -638,17 +653,15 @@ void DearchiverBase::UnpackPipelineStateImpl(const PipelineStateUnpackInfo& Unpa
     PSO.CreateInfo.PSODesc.SRBAllocationGranularity = UnpackInfo.SRBAllocationGranularity;
     PSO.CreateInfo.PSODesc.ImmediateContextMask     = UnpackInfo.ImmediateContextMask;
     PSO.CreateInfo.pPSOCache                        = UnpackInfo.pCache;
+    PSO.CreateInfo.Flags |= UnpackInfo.Flags;
 
     if (!ModifyPipelineStateCreateInfo(PSO.CreateInfo, UnpackInfo))
         return;
 
     PSO.CreatePipeline(UnpackInfo.pDevice, ppPSO);
-
-    if (UnpackInfo.ModifyPipelineStateCreateInfo == nullptr)
-        m_Cache.PSO.Set(ResType, UnpackInfo.Name, *ppPSO);
 }
 
-bool DearchiverBase::LoadArchive(const IDataBlob* pArchiveData, bool MakeCopy)
+bool DearchiverBase::LoadArchive(const IDataBlob* pArchiveData, bool MakeCopy, bool Override)
 {
     if (pArchiveData == nullptr)
         return false;
@@ -670,18 +683,28 @@ bool DearchiverBase::LoadArchive(const IDataBlob* pArchiveData, bool MakeCopy)
         const auto& ArchiveResources = pObjArchive->GetNamedResources();
         for (const auto& it : ArchiveResources)
         {
-            const auto     ResType      = it.first.GetType();
-            const auto*    ResName      = it.first.GetName();
-            constexpr auto MakeNameCopy = true;
+            const auto  ResType = it.first.GetType();
+            const auto* ResName = it.first.GetName();
 
-            const auto inserted = m_ResNameToArchiveIdx.emplace(NamedResourceKey{ResType, ResName, MakeNameCopy}, ArchiveIdx).second;
-            if (!inserted)
+            auto it_inserted = m_ResNameToArchiveIdx.emplace(ResourceKey{ResType, HashedName{ResName}}, ArchiveIdx);
+            if (!it_inserted.second)
             {
-                LOG_ERROR_MESSAGE("Resource with name '", ResName, "' already exists in the archive.");
+                if (Override)
+                {
+                    // Resolve the name to the new archive and drop objects unpacked from the old one
+                    it_inserted.first->second = ArchiveIdx;
+                    m_Cache.Sign.Remove(ResType, ResName);
+                    m_Cache.RenderPass.Remove(ResType, ResName);
+                    m_Cache.PSO.Remove(ResType, ResName);
+                }
+                else
+                {
+                    LOG_ERROR_MESSAGE("Resource with name '", ResName, "' already exists in the archive.");
+                }
             }
         }
 
-        m_Archives.emplace_back(std::move(pObjArchive));
+        m_Archives.emplace_back(std::move(pObjArchive), Override);
 
         return true;
     }
@@ -699,23 +722,28 @@ void DearchiverBase::UnpackPipelineState(const PipelineStateUnpackInfo& UnpackIn
 
     *ppPSO = nullptr;
 
+    ResourceType ResType = ResourceType::Undefined;
     switch (UnpackInfo.PipelineType)
     {
         case PIPELINE_TYPE_GRAPHICS:
         case PIPELINE_TYPE_MESH:
             UnpackPipelineStateImpl<GraphicsPipelineStateCreateInfo>(UnpackInfo, ppPSO);
+            ResType = PSOData<GraphicsPipelineStateCreateInfo>::ArchiveResType;
             break;
 
         case PIPELINE_TYPE_COMPUTE:
             UnpackPipelineStateImpl<ComputePipelineStateCreateInfo>(UnpackInfo, ppPSO);
+            ResType = PSOData<ComputePipelineStateCreateInfo>::ArchiveResType;
             break;
 
         case PIPELINE_TYPE_RAY_TRACING:
             UnpackPipelineStateImpl<RayTracingPipelineStateCreateInfo>(UnpackInfo, ppPSO);
+            ResType = PSOData<RayTracingPipelineStateCreateInfo>::ArchiveResType;
             break;
 
         case PIPELINE_TYPE_TILE:
             UnpackPipelineStateImpl<TilePipelineStateCreateInfo>(UnpackInfo, ppPSO);
+            ResType = PSOData<TilePipelineStateCreateInfo>::ArchiveResType;
             break;
 
         case PIPELINE_TYPE_INVALID:
@@ -723,6 +751,9 @@ void DearchiverBase::UnpackPipelineState(const PipelineStateUnpackInfo& UnpackIn
             LOG_ERROR_MESSAGE("Unsupported pipeline type");
             return;
     }
+
+    if (*ppPSO != nullptr && UnpackInfo.ModifyPipelineStateCreateInfo == nullptr)
+        RecordUsage(ResType, UnpackInfo.Name);
 }
 
 static bool ModifyShaderDesc(ShaderDesc&             Desc,
@@ -812,7 +843,9 @@ void DearchiverBase::UnpackResourceSignature(const ResourceSignatureUnpackInfo&
     *ppSignature = nullptr;
 
     auto pSignature = UnpackResourceSignature(DeArchiveInfo, false /*IsImplicit*/);
-    *ppSignature    = pSignature.Detach();
+    if (pSignature)
+        RecordUsage(PRSData::ArchiveResType, DeArchiveInfo.Name);
+    *ppSignature = pSignature.Detach();
 }
 
 void DearchiverBase::UnpackRenderPass(const RenderPassUnpackInfo& UnpackInfo, IRenderPass** ppRP)
@@ -822,16 +855,34 @@ void DearchiverBase::UnpackRenderPass(const RenderPassUnpackInfo& UnpackInfo, IR
 
     *ppRP = nullptr;
 
+    UnpackRenderPassImpl(UnpackInfo, ppRP);
+    if (*ppRP != nullptr && UnpackInfo.ModifyRenderPassDesc == nullptr)
+        RecordUsage(RPData::ArchiveResType, UnpackInfo.Name);
+}
+
+void DearchiverBase::UnpackRenderPassImpl(const RenderPassUnpackInfo& UnpackInfo, IRenderPass** ppRP)
+{
     VERIFY_EXPR(UnpackInfo.pDevice != nullptr);
     // Do not cache modified render passes.
     if (UnpackInfo.ModifyRenderPassDesc == nullptr)
     {
         // Since render pass names must be unique, we use a single cache for all
         // loaded archives.
-        if (m_Cache.RenderPass.Get(RPData::ArchiveResType, UnpackInfo.Name, ppRP))
-            return;
+        auto pRP = m_Cache.RenderPass.GetOrCreate(RPData::ArchiveResType, UnpackInfo.Name, [&]() {
+            RefCntAutoPtr<IRenderPass> pNewRP;
+            CreateRenderPass(UnpackInfo, &pNewRP);
+            return pNewRP;
+        });
+        *ppRP    = pRP.Detach();
     }
+    else
+    {
+        CreateRenderPass(UnpackInfo, ppRP);
+    }
+}
 
+void DearchiverBase::CreateRenderPass(const RenderPassUnpackInfo& UnpackInfo, IRenderPass** ppRP)
+{
     // Find the archive that contains this render pass.
     auto* pArchiveData = FindArchive(RPData::ArchiveResType, UnpackInfo.Name);
     if (pArchiveData == nullptr)
@@ -848,9 +899,6 @@ void DearchiverBase::UnpackRenderPass(const RenderPassUnpackInfo& UnpackInfo, IR
         UnpackInfo.ModifyRenderPassDesc(RP.Desc, UnpackInfo.pUserData);
 
     UnpackInfo.pDevice->CreateRenderPass(RP.Desc, ppRP);
-
-    if (UnpackInfo.ModifyRenderPassDesc == nullptr)
-        m_Cache.RenderPass.Set(RPData::ArchiveResType, UnpackInfo.Name, *ppRP);
 }
 
 bool DearchiverBase::Store(IDataBlob** ppArchive) const
@@ -869,7 +917,7 @@ bool DearchiverBase::Store(IDataBlob** ppArchive) const
         for (const auto& Archive : m_Archives)
         {
             if (Archive.pObjArchive)
-                MergedArchive.Merge(*Archive.pObjArchive);
+                MergedArchive.Merge(*Archive.pObjArchive, Archive.Override);
         }
 
         MergedArchive.Serialize(ppArchive);
@@ -881,9 +929,282 @@ bool DearchiverBase::Store(IDataBlob** ppArchive) const
     }
 }
 
+void DearchiverBase::RecordUsage(ResourceType Type, const char* Name)
+{
+    if (Name == nullptr)
+        return;
+
+    const ResourceKey Key{Type, HashedName{Name}};
+
+    std::lock_guard<std::mutex> Guard{m_UsageMtx};
+    if (m_RecordedResources.insert(Key).second)
+        m_UsageManifest.push_back(Key);
+}
+
+bool DearchiverBase::StoreUsageManifest(IDataBlob** ppManifest) const
+{
+    if (ppManifest == nullptr)
+    {
+        DEV_ERROR("ppManifest must not be null");
+        return false;
+    }
+    DEV_CHECK_ERR(*ppManifest == nullptr, "*ppManifest must be null - make sure you are not overwriting "
+                                          "reference to an existing object as this will cause memory leaks.");
+
+    std::vector<ResourceKey> Manifest;
+    {
+        std::lock_guard<std::mutex> Guard{m_UsageMtx};
+        Manifest = m_UsageManifest;
+    }
+
+    auto WriteData = [&Manifest](auto& Ser) {
+        const Uint32 MagicNumber  = UsageManifestMagicNumber;
+        const Uint32 Version      = UsageManifestVersion;
+        const Uint32 NumResources = static_cast<Uint32>(Manifest.size());
+        Ser(MagicNumber, Version, NumResources);
+        for (const auto& Key : Manifest)
+        {
+            const char* Name = Key.Name.GetStr();
+            Ser(Key.Type, Name);
+        }
+    };
+
+    Serializer<SerializerMode::Measure> MeasureSer;
+    WriteData(MeasureSer);
+
+    const auto Data = MeasureSer.AllocateData(GetRawAllocator());
+
+    Serializer<SerializerMode::Write> WriteSer{Data};
+    WriteData(WriteSer);
+    VERIFY_EXPR(WriteSer.IsEnded());
+
+    *ppManifest = DataBlobImpl::Create(Data.Size(), Data.Ptr()).Detach();
+    return true;
+}
+
+template <typename CreateInfoType>
+RefCntAutoPtr<IPipelineState> DearchiverBase::PrefetchPipelineState(const DearchiverPrefetchInfo& PrefetchInfo,
+                                                                    PIPELINE_TYPE                 PipelineType,
+                                                                    const char*                   Name)
+{
+    PipelineStateUnpackInfo UnpackInfo;
+    UnpackInfo.pDevice                  = PrefetchInfo.pDevice;
+    UnpackInfo.Name                     = Name;
+    UnpackInfo.PipelineType             = PipelineType;
+    UnpackInfo.SRBAllocationGranularity = PrefetchInfo.SRBAllocationGranularity;
+    UnpackInfo.ImmediateContextMask     = PrefetchInfo.ImmediateContextMask;
+    UnpackInfo.Flags                    = PrefetchInfo.PSOFlags;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    UnpackPipelineStateImpl<CreateInfoType>(UnpackInfo, &pPSO);
+    return pPSO;
+}
+
+void DearchiverBase::PrefetchResource(const DearchiverPrefetchInfo& PrefetchInfo, ResourceType Type, const char* Name)
+{
+    RefCntAutoPtr<IDeviceObject> pObject;
+    try
+    {
+        switch (Type)
+        {
+            case ResourceType::ResourceSignature:
+            {
+                ResourceSignatureUnpackInfo UnpackInfo;
+                UnpackInfo.pDevice                  = PrefetchInfo.pDevice;
+                UnpackInfo.Name                     = Name;
+                UnpackInfo.SRBAllocationGranularity = PrefetchInfo.SRBAllocationGranularity;
+
+                pObject = UnpackResourceSignature(UnpackInfo, false /*IsImplicit*/);
+                break;
+            }
+
+            case ResourceType::RenderPass:
+            {
+                RenderPassUnpackInfo UnpackInfo;
+                UnpackInfo.pDevice = PrefetchInfo.pDevice;
+                UnpackInfo.Name    = Name;
+
+                RefCntAutoPtr<IRenderPass> pRP;
+                UnpackRenderPassImpl(UnpackInfo, &pRP);
+                pObject = pRP;
+                break;
+            }
+
+            case ResourceType::GraphicsPipeline:
+                pObject = PrefetchPipelineState<GraphicsPipelineStateCreateInfo>(PrefetchInfo, PIPELINE_TYPE_GRAPHICS, Name);
+                break;
+
+            case ResourceType::ComputePipeline:
+                pObject = PrefetchPipelineState<ComputePipelineStateCreateInfo>(PrefetchInfo, PIPELINE_TYPE_COMPUTE, Name);
+                break;
+
+            case ResourceType::RayTracingPipeline:
+                pObject = PrefetchPipelineState<RayTracingPipelineStateCreateInfo>(PrefetchInfo, PIPELINE_TYPE_RAY_TRACING, Name);
+                break;
+
+            case ResourceType::TilePipeline:
+                pObject = PrefetchPipelineState<TilePipelineStateCreateInfo>(PrefetchInfo, PIPELINE_TYPE_TILE, Name);
+                break;
+
+            default:
+                LOG_ERROR_MESSAGE("Unexpected resource type in the usage manifest");
+        }
+    }
+    catch (...)
+    {
+        LOG_ERROR_MESSAGE("Failed to prefetch resource '", Name, "'.");
+    }
+
+    if (pObject)
+    {
+        {
+            std::lock_guard<std::mutex> Guard{m_Prefetch.Mtx};
+            m_Prefetch.Objects.emplace_back(std::move(pObject));
+        }
+        m_Prefetch.NumUnpacked.fetch_add(1);
+    }
+    else
+    {
+        m_Prefetch.NumFailed.fetch_add(1);
+    }
+}
+
+bool DearchiverBase::Prefetch(const DearchiverPrefetchInfo& PrefetchInfo)
+{
+    if (PrefetchInfo.pDevice == nullptr)
+    {
+        DEV_ERROR("PrefetchInfo.pDevice must not be null");
+        return false;
+    }
+    if (PrefetchInfo.pManifest == nullptr)
+    {
+        DEV_ERROR("PrefetchInfo.pManifest must not be null");
+        return false;
+    }
+
+    std::vector<ResourceKey> Resources;
+    {
+        const SerializedData Data{const_cast<void*>(PrefetchInfo.pManifest->GetConstDataPtr()), StaticCast<size_t>(PrefetchInfo.pManifest->GetSize())};
+
+        Serializer<SerializerMode::Read> Ser{Data};
+
+        Uint32 MagicNumber  = 0;
+        Uint32 Version      = 0;
+        Uint32 NumResources = 0;
+        if (!Ser(MagicNumber, Version, NumResources) || MagicNumber != UsageManifestMagicNumber)
+        {
+            LOG_ERROR_MESSAGE("Invalid usage manifest.");
+            return false;
+        }
+        if (Version != UsageManifestVersion)
+        {
+            LOG_ERROR_MESSAGE("Unsupported usage manifest version: ", Version, ". Expected version: ", Uint32{UsageManifestVersion}, ".");
+            return false;
+        }
+
+        Resources.reserve(NumResources);
+        for (Uint32 i = 0; i < NumResources; ++i)
+        {
+            ResourceType Type = ResourceType::Undefined;
+            const char*  Name = nullptr;
+            if (!Ser(Type, Name) || Name == nullptr || Name[0] == '\0')
+            {
+                LOG_ERROR_MESSAGE("Failed to read usage manifest. The data may be corrupted or invalid.");
+                return false;
+            }
+            Resources.push_back(ResourceKey{Type, HashedName{Name}});
+        }
+        VERIFY_EXPR(Ser.IsEnded());
+    }
+
+    m_Prefetch.NumResources.fetch_add(static_cast<Uint32>(Resources.size()));
+
+    // OpenGL objects can't be created by worker threads
+    auto* pThreadPool = GetArchiveDeviceType(PrefetchInfo.pDevice) != DeviceType::OpenGL ? PrefetchInfo.pThreadPool : nullptr;
+    if (pThreadPool == nullptr)
+    {
+        for (const auto& Res : Resources)
+            PrefetchResource(PrefetchInfo, Res.Type, Res.Name.GetStr());
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> Guard{m_Prefetch.Mtx};
+        m_Prefetch.NumPendingTasks += static_cast<Uint32>(Resources.size());
+    }
+
+    // Tasks keep the dearchiver and the device alive until they are finished
+    RefCntAutoPtr<DearchiverBase> pThis{this};
+    RefCntAutoPtr<IRenderDevice>  pDevice{PrefetchInfo.pDevice};
+
+    DearchiverPrefetchInfo TaskInfo = PrefetchInfo;
+    TaskInfo.pManifest              = nullptr;
+    TaskInfo.pThreadPool            = nullptr;
+    for (size_t i = 0; i < Resources.size(); ++i)
+    {
+        // Resources that were requested first have higher priority
+        EnqueueAsyncWork(
+            pThreadPool,
+            [pThis, pDevice, TaskInfo, Res = Resources[i]](Uint32 /*ThreadId*/) mutable //
+            {
+                auto& Prefetch = pThis->m_Prefetch;
+                if (!Prefetch.Cancelled.load())
+                    pThis->PrefetchResource(TaskInfo, Res.Type, Res.Name.GetStr());
+
+                std::lock_guard<std::mutex> Guard{Prefetch.Mtx};
+                VERIFY_EXPR(Prefetch.NumPendingTasks > 0);
+                if (--Prefetch.NumPendingTasks == 0)
+                    Prefetch.PendingTasksCV.notify_all();
+            },
+            -static_cast<float>(i));
+    }
+
+    return true;
+}
+
+DearchiverPrefetchProgress DearchiverBase::GetPrefetchProgress() const
+{
+    DearchiverPrefetchProgress Progress;
+    Progress.NumResources = m_Prefetch.NumResources.load();
+    Progress.NumUnpacked  = m_Prefetch.NumUnpacked.load();
+    Progress.NumFailed    = m_Prefetch.NumFailed.load();
+    return Progress;
+}
+
+void DearchiverBase::WaitForPrefetch()
+{
+    m_Prefetch.Cancelled.store(true);
+
+    std::vector<RefCntAutoPtr<IDeviceObject>> Objects;
+    {
+        std::unique_lock<std::mutex> Lock{m_Prefetch.Mtx};
+        m_Prefetch.PendingTasksCV.wait(Lock, [this]() { return m_Prefetch.NumPendingTasks == 0; });
+        Objects.swap(m_Prefetch.Objects);
+    }
+    // Release the objects outside of the lock
+    Objects.clear();
+
+    m_Prefetch.NumResources.store(0);
+    m_Prefetch.NumUnpacked.store(0);
+    m_Prefetch.NumFailed.store(0);
+    m_Prefetch.Cancelled.store(false);
+}
+
 void DearchiverBase::Reset()
 {
+    WaitForPrefetch();
+
+    {
+        std::lock_guard<std::mutex> Guard{m_UsageMtx};
+        m_UsageManifest.clear();
+        m_RecordedResources.clear();
+    }
+
+    m_ResNameToArchiveIdx.clear();
     m_Archives.clear();
+    m_Cache.Sign.Clear();
+    m_Cache.RenderPass.Clear();
+    m_Cache.PSO.Clear();
 }
 
 } // namespace Diligent
@@ -27,6 +27,8 @@
 
 #include "DeviceContextBase.hpp"
 
+#include <unordered_set>
+
 #include "GraphicsAccessories.hpp"
 
 namespace Diligent
@@ -77,6 +79,42 @@ bool VerifyDrawIndexedAttribs(const DrawIndexedAttribs& Attribs)
     return true;
 }
 
+bool VerifyMultiDrawAttribs(const MultiDrawAttribs& Attribs)
+{
+#define CHECK_MULTI_DRAW_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Multi-draw attribs are invalid: ", __VA_ARGS__)
+
+    CHECK_MULTI_DRAW_ATTRIBS(Attribs.DrawCount == 0 || Attribs.pDrawItems != nullptr,
+                             "pDrawItems must not be null when DrawCount (", Attribs.DrawCount, ") is not zero.");
+
+    if (Attribs.DrawCount == 0)
+        LOG_INFO_MESSAGE("MultiDrawAttribs.DrawCount is 0. This is OK as the draw command will be ignored, but may be unintentional.");
+    if (Attribs.NumInstances == 0)
+        LOG_INFO_MESSAGE("MultiDrawAttribs.NumInstances is 0. This is OK as the draw command will be ignored, but may be unintentional.");
+
+#undef CHECK_MULTI_DRAW_ATTRIBS
+
+    return true;
+}
+
+bool VerifyMultiDrawIndexedAttribs(const MultiDrawIndexedAttribs& Attribs)
+{
+#define CHECK_MULTI_DRAW_INDEXED_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Multi-draw indexed attribs are invalid: ", __VA_ARGS__)
+
+    CHECK_MULTI_DRAW_INDEXED_ATTRIBS(Attribs.IndexType == VT_UINT16 || Attribs.IndexType == VT_UINT32,
+                                     "IndexType (", GetValueTypeString(Attribs.IndexType), ") must be VT_UINT16 or VT_UINT32.");
+    CHECK_MULTI_DRAW_INDEXED_ATTRIBS(Attribs.DrawCount == 0 || Attribs.pDrawItems != nullptr,
+                                     "pDrawItems must not be null when DrawCount (", Attribs.DrawCount, ") is not zero.");
+
+    if (Attribs.DrawCount == 0)
+        LOG_INFO_MESSAGE("MultiDrawIndexedAttribs.DrawCount is 0. This is OK as the draw command will be ignored, but may be unintentional.");
+    if (Attribs.NumInstances == 0)
+        LOG_INFO_MESSAGE("MultiDrawIndexedAttribs.NumInstances is 0. This is OK as the draw command will be ignored, but may be unintentional.");
+
+#undef CHECK_MULTI_DRAW_INDEXED_ATTRIBS
+
+    return true;
+}
+
 bool VerifyDrawMeshAttribs(Uint32 MaxDrawMeshTasksCount, const DrawMeshAttribs& Attribs)
 {
 #define CHECK_DRAW_MESH_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Draw mesh attribs are invalid: ", __VA_ARGS__)
@@ -379,7 +417,7 @@ static bool VerifyAliasingBarrierDesc(const StateTransitionDesc& Barrier)
 {
     VERIFY_EXPR(Barrier.Flags & STATE_TRANSITION_FLAG_ALIASING);
 
-    auto VerifySparseAliasedResource = [](IDeviceObject* pResource) //
+    auto VerifyAliasedResource = [](IDeviceObject* pResource) //
     {
         if (pResource == nullptr)
             return RESOURCE_DIM_UNDEFINED;
@@ -387,10 +425,11 @@ static bool VerifyAliasingBarrierDesc(const StateTransitionDesc& Barrier)
         if (RefCntAutoPtr<ITexture> pTexture{pResource, IID_Texture})
         {
             const auto& TexDesc = pTexture->GetDesc();
-            DEV_CHECK_ERR(TexDesc.Usage == USAGE_SPARSE,
-                          "Texture '", TexDesc.Name, "' used in an aliasing barrier is not a sparse resource");
-            DEV_CHECK_ERR((TexDesc.MiscFlags & MISC_TEXTURE_FLAG_SPARSE_ALIASING) != 0,
-                          "Texture '", TexDesc.Name, "' used in an aliasing barrier was not created with MISC_TEXTURE_FLAG_SPARSE_ALIASING flag");
+            // Placed textures are created in device memory with USAGE_DEFAULT
+            DEV_CHECK_ERR(TexDesc.Usage == USAGE_SPARSE || TexDesc.Usage == USAGE_DEFAULT,
+                          "Texture '", TexDesc.Name, "' used in an aliasing barrier is neither a sparse nor a placed resource");
+            DEV_CHECK_ERR(TexDesc.Usage != USAGE_SPARSE || (TexDesc.MiscFlags & MISC_TEXTURE_FLAG_SPARSE_ALIASING) != 0,
+                          "Sparse texture '", TexDesc.Name, "' used in an aliasing barrier was not created with MISC_TEXTURE_FLAG_SPARSE_ALIASING flag");
 
             return TexDesc.Type;
         }
@@ -398,10 +437,10 @@ static bool VerifyAliasingBarrierDesc(const StateTransitionDesc& Barrier)
         {
             const auto& BuffDesc = pBuffer->GetDesc();
 
-            DEV_CHECK_ERR(BuffDesc.Usage == USAGE_SPARSE,
-                          "Buffer '", BuffDesc.Name, "' used in an aliasing barrier is not a sparse resource");
-            DEV_CHECK_ERR((BuffDesc.MiscFlags & MISC_BUFFER_FLAG_SPARSE_ALIASING) != 0,
-                          "Buffer '", BuffDesc.Name, "' used in an aliasing barrier was not created with MISC_BUFFER_FLAG_SPARSE_ALIASING flag");
+            DEV_CHECK_ERR(BuffDesc.Usage == USAGE_SPARSE || BuffDesc.Usage == USAGE_DEFAULT,
+                          "Buffer '", BuffDesc.Name, "' used in an aliasing barrier is neither a sparse nor a placed resource");
+            DEV_CHECK_ERR(BuffDesc.Usage != USAGE_SPARSE || (BuffDesc.MiscFlags & MISC_BUFFER_FLAG_SPARSE_ALIASING) != 0,
+                          "Sparse buffer '", BuffDesc.Name, "' used in an aliasing barrier was not created with MISC_BUFFER_FLAG_SPARSE_ALIASING flag");
 
             return RESOURCE_DIM_BUFFER;
         }
@@ -412,13 +451,13 @@ static bool VerifyAliasingBarrierDesc(const StateTransitionDesc& Barrier)
         }
     };
 
-    auto BeforeDim = VerifySparseAliasedResource(Barrier.pResourceBefore);
-    auto AfterDim  = VerifySparseAliasedResource(Barrier.pResource);
+    auto BeforeDim = VerifyAliasedResource(Barrier.pResourceBefore);
+    auto AfterDim  = VerifyAliasedResource(Barrier.pResource);
     if (BeforeDim != RESOURCE_DIM_UNDEFINED && AfterDim != RESOURCE_DIM_UNDEFINED)
     {
         CHECK_STATE_TRANSITION_DESC((BeforeDim == RESOURCE_DIM_BUFFER) == (AfterDim == RESOURCE_DIM_BUFFER),
                                     "Both before- and after-resources must either be buffers or textures. "
-                                    "Sparse aliasing between textures and buffers is not allowed.");
+                                    "Aliasing between textures and buffers is not allowed.");
     }
 
     CHECK_STATE_TRANSITION_DESC(Barrier.OldState == RESOURCE_STATE_UNKNOWN && Barrier.NewState == RESOURCE_STATE_UNKNOWN,
@@ -559,7 +598,7 @@ bool VerifyStateTransitionDesc(const IRenderDevice*       pDevice,
 #undef CHECK_STATE_TRANSITION_DESC
 
 
-bool VerifyBuildBLASAttribs(const BuildBLASAttribs& Attribs, const IRenderDevice* pDevice)
+bool VerifyBuildBLASAttribs(const BuildBLASAttribs& Attribs, const IRenderDevice* pDevice, bool ScratchBufferOptional)
 {
 #define CHECK_BUILD_BLAS_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Build BLAS attribs are invalid: ", __VA_ARGS__)
 
@@ -567,7 +606,7 @@ bool VerifyBuildBLASAttribs(const BuildBLASAttribs& Attribs, const IRenderDevice
     const auto  DeviceType = pDevice->GetDeviceInfo().Type;
 
     CHECK_BUILD_BLAS_ATTRIBS(Attribs.pBLAS != nullptr, "pBLAS must not be null.");
-    CHECK_BUILD_BLAS_ATTRIBS(Attribs.pScratchBuffer != nullptr, "pScratchBuffer must not be null.");
+    CHECK_BUILD_BLAS_ATTRIBS(Attribs.pScratchBuffer != nullptr || ScratchBufferOptional, "pScratchBuffer must not be null.");
     CHECK_BUILD_BLAS_ATTRIBS((Attribs.BoxDataCount != 0) ^ (Attribs.TriangleDataCount != 0), "exactly one of TriangleDataCount and BoxDataCount must be non-zero.");
     CHECK_BUILD_BLAS_ATTRIBS(Attribs.pBoxData != nullptr || Attribs.BoxDataCount == 0, "BoxDataCount is ", Attribs.BoxDataCount, ", but pBoxData is null.");
     CHECK_BUILD_BLAS_ATTRIBS(Attribs.pTriangleData != nullptr || Attribs.TriangleDataCount == 0, "TriangleDataCount is ", Attribs.TriangleDataCount, ", but pTriangleData is null.");
@@ -733,6 +772,9 @@ bool VerifyBuildBLASAttribs(const BuildBLASAttribs& Attribs, const IRenderDevice
                                  "pBoxData[", i, "].pBoxBuffer was not created with BIND_RAY_TRACING flag.");
     }
 
+    if (Attribs.pScratchBuffer == nullptr)
+        return true;
+
     const auto& ScratchDesc = Attribs.pScratchBuffer->GetDesc();
 
     CHECK_BUILD_BLAS_ATTRIBS(Attribs.ScratchBufferOffset <= ScratchDesc.Size,
@@ -761,6 +803,55 @@ bool VerifyBuildBLASAttribs(const BuildBLASAttribs& Attribs, const IRenderDevice
     return true;
 }
 
+bool VerifyBuildBLASBatchAttribs(const BuildBLASBatchAttribs& Attribs, const IRenderDevice* pDevice)
+{
+#define CHECK_BUILD_BLAS_BATCH_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Build BLAS batch attribs are invalid: ", __VA_ARGS__)
+
+    CHECK_BUILD_BLAS_BATCH_ATTRIBS(Attribs.pBuilds != nullptr || Attribs.BuildCount == 0, "BuildCount is ", Attribs.BuildCount, ", but pBuilds is null.");
+
+    std::unordered_set<const IBottomLevelAS*> UniqueBLASes;
+    for (Uint32 i = 0; i < Attribs.BuildCount; ++i)
+    {
+        const BuildBLASAttribs& Build = Attribs.pBuilds[i];
+        if (!VerifyBuildBLASAttribs(Build, pDevice, /*ScratchBufferOptional = */ true))
+        {
+            LOG_ERROR_MESSAGE("Build BLAS batch attribs are invalid: pBuilds[", i, "] is invalid.");
+            return false;
+        }
+
+        CHECK_BUILD_BLAS_BATCH_ATTRIBS(UniqueBLASes.insert(Build.pBLAS).second,
+                                       "pBuilds[", i, "].pBLAS ('", Build.pBLAS->GetDesc().Name, "') is used by another build in the batch.");
+
+        if (Attribs.pCompactedSizeBuffer != nullptr)
+        {
+            CHECK_BUILD_BLAS_BATCH_ATTRIBS((Build.pBLAS->GetDesc().Flags & RAYTRACING_BUILD_AS_ALLOW_COMPACTION) == RAYTRACING_BUILD_AS_ALLOW_COMPACTION,
+                                           "pCompactedSizeBuffer is not null, but pBuilds[", i, "].pBLAS was not created with RAYTRACING_BUILD_AS_ALLOW_COMPACTION flag.");
+        }
+    }
+
+    if (Attribs.pCompactedSizeBuffer != nullptr)
+    {
+        const BufferDesc& DstDesc = Attribs.pCompactedSizeBuffer->GetDesc();
+
+        CHECK_BUILD_BLAS_BATCH_ATTRIBS(Attribs.CompactedSizeBufferOffset % sizeof(Uint64) == 0,
+                                       "CompactedSizeBufferOffset (", Attribs.CompactedSizeBufferOffset, ") must be a multiple of 8.");
+
+        CHECK_BUILD_BLAS_BATCH_ATTRIBS(Attribs.CompactedSizeBufferOffset + Uint64{Attribs.BuildCount} * sizeof(Uint64) <= DstDesc.Size,
+                                       "pCompactedSizeBuffer is too small: at least ", Attribs.CompactedSizeBufferOffset + Uint64{Attribs.BuildCount} * sizeof(Uint64),
+                                       " bytes are required.");
+
+        if (pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_D3D12)
+        {
+            CHECK_BUILD_BLAS_BATCH_ATTRIBS((DstDesc.BindFlags & BIND_UNORDERED_ACCESS) == BIND_UNORDERED_ACCESS,
+                                           "pCompactedSizeBuffer must have been created with BIND_UNORDERED_ACCESS flag in Direct3D12.");
+        }
+    }
+
+#undef CHECK_BUILD_BLAS_BATCH_ATTRIBS
+
+    return true;
+}
+
 
 bool VerifyBuildTLASAttribs(const BuildTLASAttribs& Attribs, const RayTracingProperties& RTProps)
 {
@@ -1340,4 +1431,29 @@ bool VerifyBindSparseResourceMemoryAttribs(const IRenderDevice* pDevice, const B
     return true;
 }
 
+bool VerifyResolveQueryArrayAttribs(const ResolveQueryArrayAttribs& Attribs)
+{
+#define CHECK_RESOLVE_QUERY_ARRAY_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Resolve query array attribs are invalid: ", __VA_ARGS__)
+
+    CHECK_RESOLVE_QUERY_ARRAY_ATTRIBS(Attribs.pQueryArray != nullptr, "pQueryArray must not be null.");
+    CHECK_RESOLVE_QUERY_ARRAY_ATTRIBS(Attribs.pDstBuffer != nullptr, "pDstBuffer must not be null.");
+
+    const QueryArrayDesc& QADesc = Attribs.pQueryArray->GetDesc();
+    CHECK_RESOLVE_QUERY_ARRAY_ATTRIBS(Attribs.NumQueries > 0, "NumQueries must not be zero.");
+    CHECK_RESOLVE_QUERY_ARRAY_ATTRIBS(Uint64{Attribs.FirstQuery} + Attribs.NumQueries <= QADesc.Size,
+                                      "the range of queries [", Attribs.FirstQuery, ", ", Uint64{Attribs.FirstQuery} + Attribs.NumQueries,
+                                      ") is out of bounds of query array '", QADesc.Name, "' of size ", QADesc.Size, ".");
+
+    const BufferDesc& DstDesc = Attribs.pDstBuffer->GetDesc();
+    CHECK_RESOLVE_QUERY_ARRAY_ATTRIBS(Attribs.DstOffset % 8 == 0, "DstOffset (", Attribs.DstOffset, ") must be a multiple of 8.");
+    CHECK_RESOLVE_QUERY_ARRAY_ATTRIBS(Attribs.DstOffset + Uint64{Attribs.pQueryArray->GetQueryDataStride()} * Attribs.NumQueries <= DstDesc.Size,
+                                      "pDstBuffer '", DstDesc.Name, "' is too small.");
+    CHECK_RESOLVE_QUERY_ARRAY_ATTRIBS(DstDesc.Usage == USAGE_DEFAULT || DstDesc.Usage == USAGE_SPARSE,
+                                      "pDstBuffer '", DstDesc.Name, "' must be a default or sparse buffer.");
+
+#undef CHECK_RESOLVE_QUERY_ARRAY_ATTRIBS
+
+    return true;
+}
+
 } // namespace Diligent
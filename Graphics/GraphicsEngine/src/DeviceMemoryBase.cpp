@@ -53,6 +53,14 @@ void ValidateDeviceMemoryDesc(const DeviceMemoryDesc& Desc, const IRenderDevice*
         VERIFY_DEVMEMORY((Desc.PageSize % SparseRes.StandardBlockSize) == 0,
                          "page size (", Desc.PageSize, ") is not a multiple of sparse block size (", SparseRes.StandardBlockSize, ")");
     }
+    else if (Desc.Type == DEVICE_MEMORY_TYPE_PLACED)
+    {
+        const auto DeviceType = pDevice->GetDeviceInfo().Type;
+        VERIFY_DEVMEMORY(DeviceType == RENDER_DEVICE_TYPE_D3D12 || DeviceType == RENDER_DEVICE_TYPE_VULKAN,
+                         "placed memory is only supported in Direct3D12 and Vulkan");
+
+        VERIFY_DEVMEMORY(Desc.PageSize != 0, "page size must not be zero");
+    }
     else
     {
         LOG_DEVMEMORY_ERROR_AND_THROW("Unexpected device memory type");
@@ -27,6 +27,7 @@
 #include "DeviceObjectArchive.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <sstream>
 
 #include "Shader.h"
@@ -70,6 +71,18 @@ DeviceObjectArchive::ArchiveHeader::ArchiveHeader() noexcept
 namespace
 {
 
+// Location of a data block in the archive
+struct DataRange
+{
+    // Offset of the block from the beginning of the archive
+    Uint64 Offset = 0;
+    // Block size, in bytes
+    Uint64 Size = 0;
+};
+
+// Alignment of data blocks in the archive
+constexpr Uint64 DataBlockAlignment = 8;
+
 template <SerializerMode Mode>
 struct ArchiveSerializer
 {
@@ -79,66 +92,18 @@ struct ArchiveSerializer
     using ConstQual = typename Serializer<Mode>::template ConstQual<T>;
 
     using ArchiveHeader = DeviceObjectArchive::ArchiveHeader;
-    using ResourceData  = DeviceObjectArchive::ResourceData;
-    using ShadersVector = std::vector<SerializedData>;
 
     bool SerializeHeader(ConstQual<ArchiveHeader>& Header) const
     {
         return Ser(Header.MagicNumber, Header.Version, Header.APIVersion, Header.GitHash);
     }
 
-    bool SerializeResourceData(ConstQual<ResourceData>& ResData) const
+    bool SerializeDataRange(ConstQual<DataRange>& Range) const
     {
-        if (!Ser.Serialize(ResData.Common))
-            return true;
-
-        for (auto& DevData : ResData.DeviceSpecific)
-        {
-            if (!Ser.Serialize(DevData))
-                return false;
-        }
-
-        return true;
+        return Ser(Range.Offset, Range.Size);
     }
-
-    bool SerializeShaders(ConstQual<ShadersVector>& Shaders) const;
 };
 
-template <SerializerMode Mode>
-bool ArchiveSerializer<Mode>::SerializeShaders(ConstQual<ShadersVector>& Shaders) const
-{
-    static_assert(Mode == SerializerMode::Measure || Mode == SerializerMode::Write, "Measure or Write mode is expected.");
-
-    Uint32 NumShaders = static_cast<Uint32>(Shaders.size());
-    if (!Ser(NumShaders))
-        return false;
-
-    for (const auto& Shader : Shaders)
-    {
-        if (!Ser.Serialize(Shader))
-            return false;
-    }
-
-    return true;
-}
-
-template <>
-bool ArchiveSerializer<SerializerMode::Read>::SerializeShaders(ShadersVector& Shaders) const
-{
-    Uint32 NumShaders = 0;
-    if (!Ser(NumShaders))
-        return false;
-
-    Shaders.resize(NumShaders);
-    for (auto& Shader : Shaders)
-    {
-        if (!Ser.Serialize(Shader))
-            return false;
-    }
-
-    return true;
-}
-
 } // namespace
 
 DeviceObjectArchive::DeviceObjectArchive() noexcept
@@ -160,10 +125,27 @@ void DeviceObjectArchive::Deserialize(const void* pData, size_t Size) noexcept(f
     if (Header.Version != ArchiveVersion)
         LOG_ERROR_AND_THROW("Unsupported device object archive version: ", Header.Version, ". Expected version: ", Uint32{ArchiveVersion});
 
+    // Only the directory is read here. Data blocks are referenced in place and are not
+    // accessed until the resource is unpacked, so that for a memory-mapped archive, pages
+    // that hold other resources or other devices' data are never loaded.
+    auto GetDataBlock = [pData, Size](const DataRange& Range) {
+        if (Range.Size == 0)
+            return SerializedData{};
+
+        if (Range.Offset > Size || Range.Size > Size - Range.Offset)
+        {
+            LOG_ERROR_AND_THROW("Data block [", Range.Offset, ", ", Range.Offset + Range.Size, ") is out of the archive bounds (",
+                                Size, " bytes). Archive file may be corrupted or invalid.");
+        }
+        auto* pBlockData = const_cast<Uint8*>(static_cast<const Uint8*>(pData)) + Range.Offset;
+        return SerializedData{pBlockData, static_cast<size_t>(Range.Size)};
+    };
+
     Uint32 NumResources = 0;
     if (!Reader(NumResources))
         LOG_ERROR_AND_THROW("Failed to read the number of named resources in the device object archive.");
 
+    m_NamedResources.reserve(NumResources);
     for (Uint32 res = 0; res < NumResources; ++res)
     {
         const char*  Name    = nullptr;
@@ -176,33 +158,74 @@ void DeviceObjectArchive::Deserialize(const void* pData, size_t Size) noexcept(f
         constexpr auto MakeNameCopy = false;
         auto&          ResData      = m_NamedResources[NamedResourceKey{ResType, Name, MakeNameCopy}];
 
-        if (!ArchiveReader.SerializeResourceData(ResData))
-            LOG_ERROR_AND_THROW("Failed to read data of resource '", Name, "'.");
+        DataRange Range;
+        if (!ArchiveReader.SerializeDataRange(Range))
+            LOG_ERROR_AND_THROW("Failed to read common data range of resource '", Name, "'.");
+        ResData.Common = GetDataBlock(Range);
+
+        for (auto& DevData : ResData.DeviceSpecific)
+        {
+            if (!ArchiveReader.SerializeDataRange(Range))
+                LOG_ERROR_AND_THROW("Failed to read device-specific data range of resource '", Name, "'.");
+            DevData = GetDataBlock(Range);
+        }
     }
 
     for (auto& Shaders : m_DeviceShaders)
     {
-        if (!ArchiveReader.SerializeShaders(Shaders))
-            LOG_ERROR_AND_THROW("Failed to read shader data from the device object archive.");
+        Uint32 NumShaders = 0;
+        if (!Reader(NumShaders))
+            LOG_ERROR_AND_THROW("Failed to read the number of shaders in the device object archive.");
+
+        if (NumShaders > Reader.GetRemainingSize() / (sizeof(Uint64) * 2))
+            LOG_ERROR_AND_THROW("The number of shaders (", NumShaders, ") is invalid. Archive file may be corrupted or invalid.");
+
+        Shaders.resize(NumShaders);
+        for (auto& Shader : Shaders)
+        {
+            DataRange Range;
+            if (!ArchiveReader.SerializeDataRange(Range))
+                LOG_ERROR_AND_THROW("Failed to read shader data range from the device object archive.");
+            Shader = GetDataBlock(Range);
+        }
     }
 }
 
-void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob) const
+bool DeviceObjectArchive::WriteArchive(const std::function<bool(Uint64 ArchiveSize)>&             BeginArchive,
+                                       const std::function<bool(const void* pData, size_t Size)>& WriteData) const
 {
-    if (ppDataBlob == nullptr)
+    // Data blocks in the order they are referenced by the directory
+    std::vector<const SerializedData*> DataBlocks;
+    DataBlocks.reserve(m_NamedResources.size() * (1 + static_cast<size_t>(DeviceType::Count)));
+    for (const auto& res_it : m_NamedResources)
     {
-        DEV_ERROR("Pointer to the data blob object must not be null");
-        return;
+        DataBlocks.push_back(&res_it.second.Common);
+        for (const auto& DevData : res_it.second.DeviceSpecific)
+            DataBlocks.push_back(&DevData);
+    }
+    for (const auto& Shaders : m_DeviceShaders)
+    {
+        for (const auto& Shader : Shaders)
+            DataBlocks.push_back(&Shader);
     }
-    DEV_CHECK_ERR(*ppDataBlob == nullptr, "Data blob object must be null");
 
-    auto SerializeThis = [this](auto& Ser) {
+    // Block offsets are null in Measure mode, which does not affect the directory size.
+    auto SerializeDirectory = [this, &DataBlocks](auto& Ser, const Uint64* BlockOffsets) {
         constexpr auto SerMode    = std::remove_reference<decltype(Ser)>::type::GetMode();
         const auto     ArchiveSer = ArchiveSerializer<SerMode>{Ser};
 
         auto res = ArchiveSer.SerializeHeader(ArchiveHeader{});
         VERIFY(res, "Failed to serialize header");
 
+        size_t BlockIdx               = 0;
+        auto   SerializeNextDataRange = [&]() {
+            DataRange Range;
+            Range.Offset = BlockOffsets != nullptr ? BlockOffsets[BlockIdx] : 0;
+            Range.Size   = DataBlocks[BlockIdx]->Size();
+            ++BlockIdx;
+            return ArchiveSer.SerializeDataRange(Range);
+        };
+
         Uint32 NumResources = StaticCast<Uint32>(m_NamedResources.size());
         res                 = Ser(NumResources);
         VERIFY(res, "Failed to serialize the number of resources");
@@ -215,29 +238,134 @@ void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob) const
             res = Ser(ResType, Name);
             VERIFY(res, "Failed to serialize resource type and name");
 
-            res = ArchiveSer.SerializeResourceData(res_it.second);
-            VERIFY(res, "Failed to serialize resource data");
+            for (size_t i = 0; i < 1 + static_cast<size_t>(DeviceType::Count); ++i)
+            {
+                res = SerializeNextDataRange();
+                VERIFY(res, "Failed to serialize resource data range");
+            }
         }
 
-        for (auto& Shaders : m_DeviceShaders)
+        for (const auto& Shaders : m_DeviceShaders)
         {
-            res = ArchiveSer.SerializeShaders(Shaders);
-            VERIFY(res, "Failed to serialize shaders");
+            Uint32 NumShaders = StaticCast<Uint32>(Shaders.size());
+            res               = Ser(NumShaders);
+            VERIFY(res, "Failed to serialize the number of shaders");
+
+            for (size_t i = 0; i < Shaders.size(); ++i)
+            {
+                res = SerializeNextDataRange();
+                VERIFY(res, "Failed to serialize shader data range");
+            }
         }
+        VERIFY_EXPR(BlockIdx == DataBlocks.size());
     };
 
     Serializer<SerializerMode::Measure> Measurer;
-    SerializeThis(Measurer);
+    SerializeDirectory(Measurer, nullptr);
+    const auto DirectorySize = Measurer.GetSize();
 
-    auto pDataBlob = DataBlobImpl::Create(Measurer.GetSize());
+    std::vector<Uint64> BlockOffsets(DataBlocks.size());
+    // Indicates that the block is a copy of another block and is not written to the archive
+    std::vector<bool> IsDuplicateBlock(DataBlocks.size());
 
-    Serializer<SerializerMode::Write> Writer{SerializedData{pDataBlob->GetDataPtr(), pDataBlob->GetSize()}};
-    SerializeThis(Writer);
-    VERIFY_EXPR(Writer.IsEnded());
+    // Identical blocks (e.g. the same byte code used by different device types or pipelines
+    // coming from merged archives) are stored once and referenced by all directory entries.
+    struct BlockHasher
+    {
+        size_t operator()(const SerializedData* pBlock) const { return pBlock->GetHash(); }
+    };
+    struct BlockEqual
+    {
+        bool operator()(const SerializedData* pLhs, const SerializedData* pRhs) const { return *pLhs == *pRhs; }
+    };
+    std::unordered_map<const SerializedData*, Uint64, BlockHasher, BlockEqual> UniqueBlockOffsets;
+    UniqueBlockOffsets.reserve(DataBlocks.size());
 
-    *ppDataBlob = pDataBlob.Detach();
+    auto ArchiveSize = AlignUp(Uint64{DirectorySize}, DataBlockAlignment);
+    for (size_t i = 0; i < DataBlocks.size(); ++i)
+    {
+        const auto BlockSize = DataBlocks[i]->Size();
+        if (BlockSize == 0)
+            continue;
+
+        auto it_inserted = UniqueBlockOffsets.emplace(DataBlocks[i], 0);
+        if (!it_inserted.second)
+        {
+            BlockOffsets[i]     = it_inserted.first->second;
+            IsDuplicateBlock[i] = true;
+            continue;
+        }
+
+        BlockOffsets[i]           = AlignUp(ArchiveSize, DataBlockAlignment);
+        ArchiveSize               = BlockOffsets[i] + BlockSize;
+        it_inserted.first->second = BlockOffsets[i];
+    }
+
+    if (!BeginArchive(ArchiveSize))
+        return false;
+
+    {
+        std::vector<Uint8> Directory(DirectorySize);
+
+        Serializer<SerializerMode::Write> Writer{SerializedData{Directory.data(), Directory.size()}};
+        SerializeDirectory(Writer, BlockOffsets.data());
+        VERIFY_EXPR(Writer.IsEnded());
+
+        if (!WriteData(Directory.data(), Directory.size()))
+            return false;
+    }
+
+    // Unique blocks are laid out in the order of increasing offsets
+    static constexpr Uint8 Padding[DataBlockAlignment] = {};
+
+    Uint64 Offset = DirectorySize;
+    for (size_t i = 0; i < DataBlocks.size(); ++i)
+    {
+        const auto& Block = *DataBlocks[i];
+        if (Block.Size() == 0 || IsDuplicateBlock[i])
+            continue;
+
+        VERIFY_EXPR(BlockOffsets[i] >= Offset && BlockOffsets[i] - Offset < DataBlockAlignment);
+        if (BlockOffsets[i] > Offset && !WriteData(Padding, StaticCast<size_t>(BlockOffsets[i] - Offset)))
+            return false;
+
+        if (!WriteData(Block.Ptr(), Block.Size()))
+            return false;
+        Offset = BlockOffsets[i] + Block.Size();
+    }
+    // The archive without data blocks is padded to the block alignment
+    VERIFY_EXPR(Offset <= ArchiveSize && ArchiveSize - Offset < DataBlockAlignment);
+    if (ArchiveSize > Offset && !WriteData(Padding, StaticCast<size_t>(ArchiveSize - Offset)))
+        return false;
+
+    return true;
 }
 
+void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob) const
+{
+    if (ppDataBlob == nullptr)
+    {
+        DEV_ERROR("Pointer to the data blob object must not be null");
+        return;
+    }
+    DEV_CHECK_ERR(*ppDataBlob == nullptr, "Data blob object must be null");
+
+    RefCntAutoPtr<DataBlobImpl> pDataBlob;
+    Uint8*                      pDstData = nullptr;
+    WriteArchive(
+        [&](Uint64 ArchiveSize) {
+            pDataBlob = DataBlobImpl::Create(StaticCast<size_t>(ArchiveSize));
+            pDstData  = pDataBlob->GetDataPtr<Uint8>();
+            return true;
+        },
+        [&](const void* pData, size_t Size) {
+            std::memcpy(pDstData, pData, Size);
+            pDstData += Size;
+            return true;
+        });
+
+    *ppDataBlob = pDataBlob.Detach();
+}
 
 namespace
 {
@@ -508,38 +636,81 @@ void DeviceObjectArchive::AppendDeviceData(const DeviceObjectArchive& Src, Devic
         DstShaders.emplace_back(SrcShader.MakeCopy(Allocator));
 }
 
-void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
+void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src, bool OverrideExisting, const MergeFilterType& Filter) noexcept(false)
 {
     static_assert(static_cast<size_t>(ResourceType::Count) == 8, "Did you add a new resource type? You may need to handle it here.");
 
     auto&                  Allocator = GetRawAllocator();
     DynamicLinearAllocator DynAllocator{Allocator, 512};
 
-    // Copy shaders
-    std::array<Uint32, static_cast<size_t>(DeviceType::Count)> ShaderBaseIndices{};
+    // Source shaders are copied when they are first referenced, unless they are already present in this archive.
+    // For every source shader, ShaderIndexRemap contains its index in this archive, or InvalidShaderIndex
+    // if the shader has not been copied yet.
+    static constexpr Uint32 InvalidShaderIndex = ~0u;
+
+    std::array<std::vector<Uint32>, static_cast<size_t>(DeviceType::Count)>                                                ShaderIndexRemap;
+    std::array<std::unordered_map<SerializedData, Uint32, SerializedData::Hasher>, static_cast<size_t>(DeviceType::Count)> DstShaderIndices;
     for (size_t i = 0; i < m_DeviceShaders.size(); ++i)
     {
         const auto& SrcShaders = Src.m_DeviceShaders[i];
-        auto&       DstShaders = m_DeviceShaders[i];
-        ShaderBaseIndices[i]   = static_cast<Uint32>(DstShaders.size());
+        const auto& DstShaders = m_DeviceShaders[i];
         if (SrcShaders.empty())
             continue;
-        DstShaders.reserve(DstShaders.size() + SrcShaders.size());
-        for (const auto& SrcShader : SrcShaders)
-            DstShaders.emplace_back(SrcShader.MakeCopy(Allocator));
+
+        DstShaderIndices[i].reserve(DstShaders.size() + SrcShaders.size());
+        for (Uint32 idx = 0; idx < DstShaders.size(); ++idx)
+        {
+            // NB: the map only references the shader data and does not own it
+            DstShaderIndices[i].emplace(SerializedData{DstShaders[idx].Ptr(), DstShaders[idx].Size()}, idx);
+        }
+        ShaderIndexRemap[i].resize(SrcShaders.size(), InvalidShaderIndex);
+    }
+
+    auto RemapShaderIndex = [&](size_t DevType, Uint32 SrcIndex) {
+        auto& Remap = ShaderIndexRemap[DevType];
+        if (SrcIndex >= Remap.size())
+            LOG_ERROR_AND_THROW("Shader index ", SrcIndex, " is out of range. Archive file may be corrupted or invalid.");
+
+        if (Remap[SrcIndex] == InvalidShaderIndex)
+        {
+            const auto& SrcShader   = Src.m_DeviceShaders[DevType][SrcIndex];
+            auto&       DstShaders  = m_DeviceShaders[DevType];
+            auto        it_inserted = DstShaderIndices[DevType].emplace(SerializedData{SrcShader.Ptr(), SrcShader.Size()}, static_cast<Uint32>(DstShaders.size()));
+            if (it_inserted.second)
+                DstShaders.emplace_back(SrcShader.MakeCopy(Allocator));
+            Remap[SrcIndex] = it_inserted.first->second;
+        }
+        return Remap[SrcIndex];
+    };
+
+    if (!Filter)
+    {
+        // Copy all source shaders in their original order
+        for (size_t i = 0; i < ShaderIndexRemap.size(); ++i)
+        {
+            for (Uint32 idx = 0; idx < ShaderIndexRemap[i].size(); ++idx)
+                RemapShaderIndex(i, idx);
+        }
     }
 
     // Copy named resources
     for (auto& src_res_it : Src.m_NamedResources)
     {
-        const auto  ResType     = src_res_it.first.GetType();
-        const auto* ResName     = src_res_it.first.GetName();
-        auto        it_inserted = m_NamedResources.emplace(NamedResourceKey{ResType, ResName, /*CopyName = */ true}, src_res_it.second.MakeCopy(Allocator));
+        const auto  ResType = src_res_it.first.GetType();
+        const auto* ResName = src_res_it.first.GetName();
+        if (Filter && !Filter(ResType, ResName))
+            continue;
+
+        auto it_inserted = m_NamedResources.emplace(NamedResourceKey{ResType, ResName, /*CopyName = */ true}, src_res_it.second.MakeCopy(Allocator));
 
         if (!it_inserted.second)
         {
-            LOG_WARNING_MESSAGE("Failed to copy resource '", ResName, "': resource with the same name already exists.");
-            continue;
+            if (!OverrideExisting)
+            {
+                LOG_WARNING_MESSAGE("Failed to copy resource '", ResName, "': resource with the same name already exists.");
+                continue;
+            }
+            it_inserted.first->second = src_res_it.second.MakeCopy(Allocator);
         }
 
         const auto IsStandaloneShader = (ResType == ResourceType::StandaloneShader);
@@ -554,8 +725,6 @@ void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
         {
             for (size_t i = 0; i < static_cast<size_t>(DeviceType::Count); ++i)
             {
-                const auto BaseIdx = ShaderBaseIndices[i];
-
                 auto& DeviceData = it_inserted.first->second.DeviceSpecific[i];
                 if (!DeviceData)
                     continue;
@@ -571,7 +740,7 @@ void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
                         VERIFY(Ser.IsEnded(), "No other data besides the shader index is expected");
                     }
 
-                    ShaderIndex += BaseIdx;
+                    ShaderIndex = RemapShaderIndex(i, ShaderIndex);
 
                     {
                         Serializer<SerializerMode::Write> Ser{DeviceData};
@@ -592,7 +761,7 @@ void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
 
                     std::vector<Uint32> NewIndices{ShaderIndices.pIndices, ShaderIndices.pIndices + ShaderIndices.Count};
                     for (auto& Idx : NewIndices)
-                        Idx += BaseIdx;
+                        Idx = RemapShaderIndex(i, Idx);
 
                     {
                         Serializer<SerializerMode::Write> Ser{DeviceData};
@@ -609,13 +778,17 @@ void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
     }
 }
 
-void DeviceObjectArchive::Serialize(IFileStream* pStream) const
+bool DeviceObjectArchive::Serialize(IFileStream* pStream) const
 {
     DEV_CHECK_ERR(pStream != nullptr, "File stream must not be null");
-    RefCntAutoPtr<IDataBlob> pDataBlob;
-    Serialize(&pDataBlob);
-    VERIFY_EXPR(pDataBlob);
-    pStream->Write(pDataBlob->GetConstDataPtr(), pDataBlob->GetSize());
+    if (pStream == nullptr)
+        return false;
+
+    return WriteArchive(
+        [](Uint64 /*ArchiveSize*/) { return true; },
+        [pStream](const void* pData, size_t Size) {
+            return pStream->Write(pData, Size);
+        });
 }
 
 } // namespace Diligent
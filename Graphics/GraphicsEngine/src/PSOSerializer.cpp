@@ -78,7 +78,8 @@ bool PRSSerializer<Mode>::SerializeDesc(
                                            ResDesc.ArraySize,
                                            ResDesc.ResourceType,
                                            ResDesc.VarType,
-                                           ResDesc.Flags);
+                                           ResDesc.Flags,
+                                           ResDesc.NumInlineConstants);
                             }))
         return false;
 
@@ -194,6 +195,7 @@ bool PSOSerializer<Mode>::SerializeCreateInfo(
                CreateInfo.GraphicsPipeline.NumRenderTargets,
                CreateInfo.GraphicsPipeline.SubpassIndex,
                CreateInfo.GraphicsPipeline.ShadingRateFlags,
+               CreateInfo.GraphicsPipeline.DynamicStateFlags,
                CreateInfo.GraphicsPipeline.RTVFormats,
                CreateInfo.GraphicsPipeline.DSVFormat,
                CreateInfo.GraphicsPipeline.SmplDesc,
@@ -143,6 +143,65 @@ void ValidatePipelineResourceSignatureDesc(const PipelineResourceSignatureDesc&
             LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "].Flags contain GENERAL_INPUT_ATTACHMENT which is only valid in Vulkan");
         }
 
+        if ((Res.Flags & PIPELINE_RESOURCE_FLAG_BINDLESS) != 0)
+        {
+            if (DeviceInfo.Type != RENDER_DEVICE_TYPE_UNDEFINED && // May be UNDEFINED for serialized signature
+                !DeviceInfo.IsVulkanDevice())
+            {
+                LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "].Flags contain BINDLESS which is only valid in Vulkan");
+            }
+
+            if (Features.BindlessResources == DEVICE_FEATURE_STATE_DISABLED)
+            {
+                LOG_PRS_ERROR_AND_THROW("Incorrect Desc.Resources[", i, "].Flags (BINDLESS). The flag can only be used if BindlessResources device feature is enabled.");
+            }
+
+            if (Res.VarType != SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE)
+            {
+                LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "].Flags contain BINDLESS, but the variable type is ", GetShaderVariableTypeLiteralName(Res.VarType),
+                                        ". Bindless arrays must be mutable.");
+            }
+
+            if ((Res.ResourceType == SHADER_RESOURCE_TYPE_BUFFER_SRV || Res.ResourceType == SHADER_RESOURCE_TYPE_BUFFER_UAV) &&
+                (Res.Flags & (PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS | PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER)) == 0)
+            {
+                LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "].Flags contain BINDLESS, but neither NO_DYNAMIC_BUFFERS nor FORMATTED_BUFFER flag is set. "
+                                                              "Buffers in bindless arrays can't use dynamic offsets.");
+            }
+        }
+
+        if ((Res.Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) != 0)
+        {
+            if (Res.NumInlineConstants == 0 || Res.NumInlineConstants > MAX_INLINE_CONSTANTS)
+            {
+                LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "].NumInlineConstants (", Res.NumInlineConstants,
+                                        ") must be in range [1, ", MAX_INLINE_CONSTANTS, "] for resources with INLINE_CONSTANTS flag.");
+            }
+
+            if (Res.ArraySize != 1)
+            {
+                LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "].Flags contain INLINE_CONSTANTS, but ArraySize is ", Res.ArraySize,
+                                        ". Inline constants can't be arrays.");
+            }
+
+            if (Res.VarType == SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+            {
+                LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "].Flags contain INLINE_CONSTANTS, but the variable type is STATIC. "
+                                                              "Inline constants are stored in the shader resource binding and must be mutable or dynamic.");
+            }
+
+            if ((Res.Flags & (PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS | PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY)) != 0)
+            {
+                LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "].Flags (", GetPipelineResourceFlagsString(Res.Flags),
+                                        ") are invalid: INLINE_CONSTANTS flag can't be combined with NO_DYNAMIC_BUFFERS or RUNTIME_ARRAY flags.");
+            }
+        }
+        else if (Res.NumInlineConstants != 0)
+        {
+            LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "].NumInlineConstants is ", Res.NumInlineConstants,
+                                    ", but INLINE_CONSTANTS flag is not set.");
+        }
+
         Resources.emplace(Res.Name, Res);
 
         // NB: when creating immutable sampler array, we have to define the sampler as both resource and
@@ -363,11 +422,12 @@ inline bool PipelineResourcesCompatible(const PipelineResourceDesc& lhs, const P
 {
     // Ignore resource names.
     // clang-format off
-    return lhs.ShaderStages == rhs.ShaderStages &&
-           lhs.ArraySize    == rhs.ArraySize    &&
-           lhs.ResourceType == rhs.ResourceType &&
-           lhs.VarType      == rhs.VarType      &&
-           lhs.Flags        == rhs.Flags;
+    return lhs.ShaderStages       == rhs.ShaderStages       &&
+           lhs.ArraySize          == rhs.ArraySize          &&
+           lhs.ResourceType       == rhs.ResourceType       &&
+           lhs.VarType            == rhs.VarType            &&
+           lhs.Flags              == rhs.Flags              &&
+           lhs.NumInlineConstants == rhs.NumInlineConstants;
     // clang-format on
 }
 
@@ -412,7 +472,7 @@ size_t CalculatePipelineResourceSignatureDescHash(const PipelineResourceSignatur
     for (Uint32 i = 0; i < Desc.NumResources; ++i)
     {
         const auto& Res = Desc.Resources[i];
-        HashCombine(Hash, Uint32{Res.ShaderStages}, Res.ArraySize, Uint32{Res.ResourceType}, Uint32{Res.VarType}, Uint32{Res.Flags});
+        HashCombine(Hash, Uint32{Res.ShaderStages}, Res.ArraySize, Uint32{Res.ResourceType}, Uint32{Res.VarType}, Uint32{Res.Flags}, Res.NumInlineConstants);
     }
 
     for (Uint32 i = 0; i < Desc.NumImmutableSamplers; ++i)
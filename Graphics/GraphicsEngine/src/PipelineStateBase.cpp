@@ -642,6 +642,20 @@ void ValidateGraphicsPipelineCreateInfo(const GraphicsPipelineStateCreateInfo& C
         if (!Features.VariableRateShading)
             LOG_PSO_ERROR_AND_THROW("ShadingRateFlags (", GetPipelineShadingRateFlagsString(CreateInfo.GraphicsPipeline.ShadingRateFlags), ") require VariableRateShading feature");
     }
+
+    if (CreateInfo.GraphicsPipeline.DynamicStateFlags != PIPELINE_DYNAMIC_STATE_FLAG_NONE)
+    {
+        if (!Features.ExtendedDynamicState)
+            LOG_PSO_ERROR_AND_THROW("DynamicStateFlags (", GetPipelineDynamicStateFlagsString(CreateInfo.GraphicsPipeline.DynamicStateFlags), ") require ExtendedDynamicState feature");
+
+        if ((CreateInfo.GraphicsPipeline.DynamicStateFlags & PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY) != 0)
+        {
+            if (CreateInfo.PSODesc.PipelineType == PIPELINE_TYPE_MESH)
+                LOG_PSO_ERROR_AND_THROW("PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY can't be used with mesh pipelines.");
+            if (CreateInfo.GraphicsPipeline.PrimitiveTopology == PRIMITIVE_TOPOLOGY_UNDEFINED)
+                LOG_PSO_ERROR_AND_THROW("PrimitiveTopology must not be PRIMITIVE_TOPOLOGY_UNDEFINED when PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY is used as it defines the topology class.");
+        }
+    }
 }
 
 void ValidateComputePipelineCreateInfo(const ComputePipelineStateCreateInfo& CreateInfo,
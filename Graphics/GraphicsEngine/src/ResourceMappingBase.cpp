@@ -41,6 +41,12 @@ void ResourceMappingImpl::AddResourceArray(const Char* Name, Uint32 StartIndex,
         return;
 
     Threading::SpinLockGuard Guard{m_Lock};
+    if (m_IsSealed.load(std::memory_order_relaxed))
+    {
+        DEV_ERROR("Unable to add resource '", Name, "': the resource mapping is sealed");
+        return;
+    }
+
     for (Uint32 Elem = 0; Elem < NumElements; ++Elem)
     {
         auto* pObject = ppObjects[Elem];
@@ -74,6 +80,12 @@ void ResourceMappingImpl::RemoveResourceByName(const Char* Name, Uint32 ArrayInd
         return;
 
     Threading::SpinLockGuard Guard{m_Lock};
+    if (m_IsSealed.load(std::memory_order_relaxed))
+    {
+        DEV_ERROR("Unable to remove resource '", Name, "': the resource mapping is sealed");
+        return;
+    }
+
     // Remove object with the given name
     // Name will be implicitly converted to HashMapStringKey without making a copy
     m_HashTable.erase(ResMappingHashKey{Name, false, ArrayIndex});
@@ -87,13 +99,49 @@ IDeviceObject* ResourceMappingImpl::GetResource(const Char* Name, Uint32 ArrayIn
         return nullptr;
     }
 
-    Threading::SpinLockGuard Guard{m_Lock};
+    std::unique_lock<Threading::SpinLock> Lock{m_Lock, std::defer_lock};
+    if (!IsSealed())
+        Lock.lock();
 
     // Find an object with the requested name
     auto It = m_HashTable.find(ResMappingHashKey{Name, false, ArrayIndex});
     return It != m_HashTable.end() ? It->second.RawPtr() : nullptr;
 }
 
+Uint32 ResourceMappingImpl::GetResourceArray(const Char* Name, Uint32 StartIndex, Uint32 NumElements, IDeviceObject** ppObjects)
+{
+    if (Name == nullptr || *Name == '\0')
+    {
+        DEV_ERROR("Name must not be null or empty");
+        return 0;
+    }
+    DEV_CHECK_ERR(ppObjects != nullptr || NumElements == 0, "ppObjects must not be null when NumElements is not zero");
+
+    // Hash the name once for all elements
+    const size_t StrHash = HashMapStringKey{Name}.GetHash();
+
+    std::unique_lock<Threading::SpinLock> Lock{m_Lock, std::defer_lock};
+    if (!IsSealed())
+        Lock.lock();
+
+    Uint32 NumFound = 0;
+    for (Uint32 Elem = 0; Elem < NumElements; ++Elem)
+    {
+        auto It         = m_HashTable.find(ResMappingHashKey{Name, StrHash, StartIndex + Elem});
+        ppObjects[Elem] = It != m_HashTable.end() ? It->second.RawPtr() : nullptr;
+        if (ppObjects[Elem] != nullptr)
+            ++NumFound;
+    }
+
+    return NumFound;
+}
+
+void ResourceMappingImpl::Seal()
+{
+    Threading::SpinLockGuard Guard{m_Lock};
+    m_IsSealed.store(true, std::memory_order_release);
+}
+
 size_t ResourceMappingImpl::GetSize()
 {
     return m_HashTable.size();
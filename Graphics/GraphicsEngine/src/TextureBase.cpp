@@ -30,6 +30,7 @@
 #include <algorithm>
 
 #include "DeviceContext.h"
+#include "DeviceMemory.h"
 #include "GraphicsAccessories.hpp"
 #include "Align.hpp"
 
@@ -321,6 +322,21 @@ void ValidateTextureDesc(const TextureDesc& Desc, const IRenderDevice* pDevice)
     }
 }
 
+void ValidateTextureInitData(const TextureDesc& Desc, const TextureData* pInitData) noexcept(false)
+{
+    if (pInitData == nullptr || pInitData->pMemory == nullptr)
+        return;
+
+    const auto& MemDesc = pInitData->pMemory->GetDesc();
+    VERIFY_TEXTURE(Desc.Usage == USAGE_DEFAULT, "textures that are placed in device memory must use USAGE_DEFAULT.");
+    VERIFY_TEXTURE((Desc.MiscFlags & MISC_TEXTURE_FLAG_MEMORYLESS) == 0, "memoryless textures can't be placed in device memory.");
+    VERIFY_TEXTURE(MemDesc.Type == DEVICE_MEMORY_TYPE_PLACED,
+                   "device memory must be created with DEVICE_MEMORY_TYPE_PLACED.");
+    VERIFY_TEXTURE((Desc.ImmediateContextMask & ~MemDesc.ImmediateContextMask) == 0,
+                   "ImmediateContextMask (", std::hex, Desc.ImmediateContextMask, ") must be a subset of the ImmediateContextMask (",
+                   std::hex, MemDesc.ImmediateContextMask, ") of the device memory.");
+}
+
 
 void ValidateTextureRegion(const TextureDesc& TexDesc, Uint32 MipLevel, Uint32 Slice, const Box& Box)
 {
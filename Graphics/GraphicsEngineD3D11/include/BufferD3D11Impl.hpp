@@ -35,6 +35,7 @@
 #include "EngineD3D11ImplTraits.hpp"
 #include "BufferBase.hpp"
 #include "ResourceD3D11Base.hpp"
+#include "D3D11DynamicCBRing.hpp"
 
 namespace Diligent
 {
@@ -65,6 +66,10 @@ public:
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final;
 
     /// Implementation of IBufferD3D11::GetD3D11Buffer().
+
+    /// \remarks   The immediate context may keep the data of small USAGE_DYNAMIC uniform buffers
+    ///             in the dynamic constant buffer ring, in which case the returned buffer does not
+    ///             contain the data written through IDeviceContext::MapBuffer().
     virtual ID3D11Buffer* DILIGENT_CALL_TYPE GetD3D11Buffer() const override final { return m_pd3d11Buffer; }
 
     /// Implementation of IBuffer::GetNativeHandle().
@@ -75,18 +80,30 @@ public:
 
     void AddState(RESOURCE_STATE State)
     {
+        const auto OldState = m_State;
         m_State &= ~(RESOURCE_STATE_COMMON | RESOURCE_STATE_UNDEFINED);
         m_State |= State;
+        if (m_State != OldState)
+            OnStateChanged();
     }
 
     void ClearState(RESOURCE_STATE State)
     {
         VERIFY_EXPR(IsInKnownState());
+        const auto OldState = m_State;
         m_State &= ~State;
         if (m_State == RESOURCE_STATE_UNKNOWN)
             m_State = RESOURCE_STATE_UNDEFINED;
+        if (m_State != OldState)
+            OnStateChanged();
     }
 
+    /// Returns true if the immediate context may suballocate the buffer data from the dynamic constant buffer ring.
+    bool IsDynamicCBRingCandidate() const { return m_IsDynamicCBRingCandidate; }
+
+    /// Returns the location of the buffer data in the dynamic constant buffer ring of the immediate context.
+    const D3D11DynamicCBRing::Allocation& GetDynamicCBAllocation() const { return m_DynamicCBAllocation; }
+
 private:
     virtual void CreateViewInternal(const struct BufferViewDesc& ViewDesc, IBufferView** ppView, bool bIsDefaultView) override;
 
@@ -95,6 +112,12 @@ private:
 
     friend class DeviceContextD3D11Impl;
     CComPtr<ID3D11Buffer> m_pd3d11Buffer; ///< D3D11 buffer object
+
+    /// Location of the latest data in the dynamic constant buffer ring.
+    /// Only accessed by the immediate context.
+    D3D11DynamicCBRing::Allocation m_DynamicCBAllocation;
+
+    bool m_IsDynamicCBRingCandidate = false;
 };
 
 } // namespace Diligent
@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::D3D11DynamicCBRing class
+
+#include <memory>
+#include <vector>
+
+#include <atlbase.h>
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Pages of dynamic constant buffer memory that back USAGE_DYNAMIC uniform buffers in the immediate context.
+
+/// Instead of renaming the buffer on every MapBuffer(MAP_WRITE, MAP_FLAG_DISCARD), the immediate context
+/// suballocates the data from the current page with D3D11_MAP_WRITE_NO_OVERWRITE and binds the page
+/// with *SSetConstantBuffers1 using the first constant of the allocation. When the page is full, the
+/// ring switches to a page that no buffer references anymore and maps it with D3D11_MAP_WRITE_DISCARD,
+/// so that draw calls that have already been recorded keep reading the previous contents.
+///
+/// Every buffer keeps a strong reference to the page that holds its latest data, so the contents
+/// stay valid until the buffer is mapped again, exactly as with a renamed D3D11 buffer.
+class D3D11DynamicCBRing final
+{
+public:
+    struct Page
+    {
+        CComPtr<ID3D11Buffer> pd3d11Buffer;
+
+        Uint8* pMappedData = nullptr;
+        Uint32 MapCount    = 0;
+    };
+
+    /// Location of the buffer data in the ring.
+    struct Allocation
+    {
+        std::shared_ptr<Page> pPage;
+
+        /// Offset of the data in the page, in bytes.
+        Uint32 Offset = 0;
+
+        /// Whether the allocation is currently mapped.
+        bool IsMapped = false;
+
+        explicit operator bool() const noexcept
+        {
+            return pPage != nullptr;
+        }
+    };
+
+    /// Size of one page. Constant buffers larger than 64 KB are not supported on all Direct3D11.1 drivers.
+    static constexpr Uint32 PageSize = 64u << 10u;
+
+    /// Maximum size of a buffer whose data is suballocated from the ring.
+    static constexpr Uint32 MaxAllocationSize = PageSize / 4;
+
+    /// Offsets passed to *SSetConstantBuffers1 must be multiples of 16 constants.
+    static constexpr Uint32 AllocationAlignment = 256;
+
+    D3D11DynamicCBRing(ID3D11Device* pd3d11Device, Uint32 MaxPages);
+    ~D3D11DynamicCBRing();
+
+    // clang-format off
+    D3D11DynamicCBRing           (const D3D11DynamicCBRing&)  = delete;
+    D3D11DynamicCBRing           (      D3D11DynamicCBRing&&) = delete;
+    D3D11DynamicCBRing& operator=(const D3D11DynamicCBRing&)  = delete;
+    D3D11DynamicCBRing& operator=(      D3D11DynamicCBRing&&) = delete;
+    // clang-format on
+
+    /// Allocates Size bytes, maps the allocation for writing and returns the pointer to its data.
+    /// Returns null if the data is too large or all pages are in use.
+    void* Allocate(ID3D11DeviceContext* pd3d11Ctx, Uint32 Size, Allocation& Alloc);
+
+    /// Maps the existing allocation with D3D11_MAP_WRITE_NO_OVERWRITE and returns the pointer to its data.
+    void* Map(ID3D11DeviceContext* pd3d11Ctx, Allocation& Alloc);
+
+    /// Unmaps the allocation that was mapped by Allocate() or Map().
+    void Unmap(ID3D11DeviceContext* pd3d11Ctx, Allocation& Alloc);
+
+    /// Returns true if the device supports all features that the ring relies on.
+    static bool IsSupported(ID3D11Device* pd3d11Device);
+
+private:
+    bool   SelectFreePage();
+    Uint8* MapPage(ID3D11DeviceContext* pd3d11Ctx, Page& P, D3D11_MAP MapType);
+
+private:
+    ID3D11Device* const m_pd3d11Device;
+    const Uint32        m_MaxPages;
+
+    std::vector<std::shared_ptr<Page>> m_Pages;
+
+    size_t m_CurrPage   = 0;
+    Uint32 m_CurrOffset = PageSize;
+
+    Uint64 m_TotalAllocationSize = 0;
+    Uint32 m_NumPageSwitches     = 0;
+};
+
+} // namespace Diligent
@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::D3D11UploadRing class
+
+#include <atlbase.h>
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Ring of upload memory used by the immediate context to batch small buffer updates.
+
+/// The ring is backed by a single dynamic D3D11 buffer. Every allocation maps the buffer
+/// with D3D11_MAP_WRITE_NO_OVERWRITE, so the driver neither renames the buffer nor
+/// copies the data to its internal staging memory as UpdateSubresource does. When the
+/// ring wraps, the buffer is mapped with D3D11_MAP_WRITE_DISCARD, which lets the driver
+/// hand out fresh memory while the GPU still reads the old contents.
+class D3D11UploadRing final
+{
+public:
+    D3D11UploadRing(ID3D11Device* pd3d11Device, Uint32 Size);
+    ~D3D11UploadRing();
+
+    // clang-format off
+    D3D11UploadRing           (const D3D11UploadRing&)  = delete;
+    D3D11UploadRing           (      D3D11UploadRing&&) = delete;
+    D3D11UploadRing& operator=(const D3D11UploadRing&)  = delete;
+    D3D11UploadRing& operator=(      D3D11UploadRing&&) = delete;
+    // clang-format on
+
+    /// Copies the data to the ring and returns the offset of the copy in the ring buffer.
+    /// Returns ~0u if the data is too large to be uploaded through the ring.
+    Uint32 Upload(ID3D11DeviceContext* pd3d11Ctx, const void* pData, Uint32 Size);
+
+    ID3D11Buffer* GetD3D11Buffer() const { return m_pd3d11Buffer; }
+
+    /// Maximum size of a single update that goes through the ring.
+    Uint32 GetMaxUploadSize() const { return m_Size / 4; }
+
+    static constexpr Uint32 InvalidOffset = ~0u;
+
+private:
+    CComPtr<ID3D11Buffer> m_pd3d11Buffer;
+
+    const Uint32 m_Size;
+    Uint32       m_CurrOffset = 0;
+
+    Uint64 m_TotalUploadSize = 0;
+    Uint32 m_NumWraps        = 0;
+};
+
+} // namespace Diligent
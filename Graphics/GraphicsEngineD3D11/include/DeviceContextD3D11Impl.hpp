@@ -41,6 +41,8 @@
 #include "FramebufferD3D11Impl.hpp"
 #include "RenderPassD3D11Impl.hpp"
 #include "DisjointQueryPool.hpp"
+#include "D3D11UploadRing.hpp"
+#include "D3D11DynamicCBRing.hpp"
 #include "BottomLevelASBase.hpp"
 #include "TopLevelASBase.hpp"
 #include "ShaderResourceBindingD3D11Impl.hpp"
@@ -65,6 +67,9 @@ public:
     /// Implementation of IDeviceContext::Begin() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE Begin(Uint32 ImmediateContextId) override final;
 
+    /// Implementation of IDeviceContext::BeginReusable() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE BeginReusable(Uint32 ImmediateContextId) override final;
+
     /// Implementation of IDeviceContext::SetPipelineState() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE SetPipelineState(IPipelineState* pPipelineState) override final;
 
@@ -134,6 +139,10 @@ public:
     virtual void DILIGENT_CALL_TYPE DrawMesh(const DrawMeshAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawMeshIndirect() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDraw() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE MultiDraw(const MultiDrawAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndexed() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs) override final;
 
     /// Implementation of IDeviceContext::DispatchCompute() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE DispatchCompute(const DispatchComputeAttribs& Attribs) override final;
@@ -199,6 +208,9 @@ public:
     /// Implementation of IDeviceContext::GenerateMips() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE GenerateMips(ITextureView* pTextureView) override final;
 
+    /// Implementation of IDeviceContext::GenerateMipsBatch() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE GenerateMipsBatch(ITextureView* const* ppTextureViews, Uint32 NumViews) override final;
+
     /// Implementation of IDeviceContext::FinishFrame() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE FinishFrame() override final;
 
@@ -232,12 +244,39 @@ public:
     /// Implementation of IDeviceContext::EndQuery() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE EndQuery(IQuery* pQuery) override final;
 
+    /// Implementation of IDeviceContext::BeginIndexedQuery() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE BeginIndexedQuery(IQueryArray* pQueryArray, Uint32 Index) override final;
+
+    /// Implementation of IDeviceContext::EndIndexedQuery() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE EndIndexedQuery(IQueryArray* pQueryArray, Uint32 Index) override final;
+
+    /// Implementation of IDeviceContext::ResolveQueryArray() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE ResolveQueryArray(const ResolveQueryArrayAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::SetPredication() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE SetPredication(IBuffer* pBuffer, Uint64 Offset, PREDICATION_OP Op) override final;
+
+    /// Implementation of IDeviceContext::SetQueryPredication() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE SetQueryPredication(IQuery* pQuery, PREDICATION_OP Op) override final;
+
+    /// Implementation of IDeviceContext::SetCullMode() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE SetCullMode(CULL_MODE CullMode) override final;
+
+    /// Implementation of IDeviceContext::SetDepthStencilState() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE SetDepthStencilState(const DepthStencilStateDesc& DSSDesc) override final;
+
+    /// Implementation of IDeviceContext::SetPrimitiveTopology() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE SetPrimitiveTopology(PRIMITIVE_TOPOLOGY Topology) override final;
+
     /// Implementation of IDeviceContext::Flush() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE Flush() override final;
 
     /// Implementation of IDeviceContext::BuildBLAS() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE BuildBLAS(const BuildBLASAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::BuildBLASBatch() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE BuildBLASBatch(const BuildBLASBatchAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::BuildTLAS() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE BuildTLAS(const BuildTLASAttribs& Attribs) override final;
 
@@ -317,11 +356,12 @@ private:
     template <typename TD3D11ResourceViewType,
               typename TSetD3D11View,
               size_t NumSlots>
-    void UnbindResourceView(TD3D11ResourceViewType CommittedD3D11ViewsArr[][NumSlots],
-                            ID3D11Resource*        CommittedD3D11ResourcesArr[][NumSlots],
-                            Uint8                  NumCommittedResourcesArr[],
-                            ID3D11Resource*        pd3d11ResToUndind,
-                            TSetD3D11View          SetD3D11ViewMethods[]);
+    void UnbindResourceView(TD3D11ResourceViewType                 CommittedD3D11ViewsArr[][NumSlots],
+                            ID3D11Resource*                        CommittedD3D11ResourcesArr[][NumSlots],
+                            Uint8                                  NumCommittedResourcesArr[],
+                            ResourceD3D11Base::CommittedSlotsMask& CommittedSlots,
+                            ID3D11Resource*                        pd3d11ResToUndind,
+                            TSetD3D11View                          SetD3D11ViewMethods[]);
 
     /// Unbinds a texture from shader resource view slots.
     /// \note The function only unbinds the texture from d3d11 device
@@ -337,7 +377,7 @@ private:
     /// Unbinds a resource from UAV slots.
     /// \note The function only unbinds the resource from d3d11 device
     ///       context. All shader bindings are retained.
-    void UnbindResourceFromUAV(ID3D11Resource* pd3d11Resource);
+    void UnbindResourceFromUAV(ResourceD3D11Base& Resource, ID3D11Resource* pd3d11Resource);
 
     /// Unbinds a texture from render target slots.
     void UnbindTextureFromRenderTarget(TextureBaseD3D11& Resource);
@@ -361,6 +401,13 @@ private:
     void BindShaderResources(Uint32 BindSRBMask);
 
     static constexpr int NumShaderTypes = D3D11ResourceBindPoints::NumShaderTypes;
+
+    /// Size of the upload ring used to batch small buffer updates
+    static constexpr Uint32 UploadRingSize = 1u << 20u;
+
+    /// Maximum number of pages in the dynamic constant buffer ring
+    static constexpr Uint32 DynamicCBRingMaxPages = 256;
+
     struct TCommittedResources
     {
         // clang-format off
@@ -501,6 +548,15 @@ private:
     DisjointQueryPool                                        m_DisjointQueryPool;
     std::shared_ptr<DisjointQueryPool::DisjointQueryWrapper> m_ActiveDisjointQuery;
 
+    /// Upload ring used by the immediate context to batch small buffer updates.
+    /// The ring is created on first use. Deferred contexts use UpdateSubresource.
+    std::unique_ptr<D3D11UploadRing> m_pUploadRing;
+
+    /// Ring that holds the data of small USAGE_DYNAMIC constant buffers mapped by the immediate context.
+    /// Null in deferred contexts and if the device does not support constant buffer offsetting
+    /// or D3D11_MAP_WRITE_NO_OVERWRITE for dynamic constant buffers.
+    std::unique_ptr<D3D11DynamicCBRing> m_pDynamicCBRing;
+
     std::vector<OptimizedClearValue> m_AttachmentClearValues;
 
 #ifdef DILIGENT_DEVELOPMENT
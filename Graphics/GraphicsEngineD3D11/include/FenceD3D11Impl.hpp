@@ -73,6 +73,13 @@ public:
 
     void Wait(Uint64 Value, bool FlushCommands);
 
+    /// Blocks until the GPU reaches the event query.
+
+    /// \remarks   Direct3D11 queries cannot signal an OS event, so the method polls the query.
+    ///             The commands are flushed at most once, and the thread yields while waiting
+    ///             instead of sleeping, which on Windows rounds up to the system timer resolution.
+    static void WaitForQuery(ID3D11DeviceContext* pd3d11Ctx, ID3D11Query* pd3d11Query, bool FlushCommands);
+
 private:
     struct PendingFenceData
     {
@@ -90,6 +90,10 @@ public:
     virtual void DILIGENT_CALL_TYPE CreateQuery(const QueryDesc& Desc,
                                                 IQuery**         ppQuery) override final;
 
+    /// Implementation of IRenderDevice::CreateQueryArray() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE CreateQueryArray(const QueryArrayDesc& Desc,
+                                                     IQueryArray**         ppQueryArray) override final;
+
     /// Implementation of IRenderDevice::CreateRenderPass() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE CreateRenderPass(const RenderPassDesc& Desc,
                                                      IRenderPass**         ppRenderPass) override final;
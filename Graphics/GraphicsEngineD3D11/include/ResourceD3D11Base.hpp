@@ -49,12 +49,38 @@ public:
         m_pSparseResourceMemory = pMemory;
     }
 
+    /// Shader stages and slots where the resource may be bound as a view in the immediate context.
+
+    /// The masks are conservative: a bit may remain set after the resource has been unbound,
+    /// but a bit is never clear while the resource is bound. This lets the context only visit
+    /// the stages and slots where the resource can actually be found when it unbinds the resource.
+    struct CommittedSlotsMask
+    {
+        /// Bit for every shader stage index
+        Uint32 Stages = 0;
+
+        /// Bit (Slot % 64) for every slot, in all stages
+        Uint64 Slots = 0;
+
+        void Add(Uint32 ShaderInd, Uint32 Slot)
+        {
+            Stages |= 1u << ShaderInd;
+            Slots |= Uint64{1} << (Slot % 64u);
+        }
+    };
+
+    CommittedSlotsMask& GetCommittedSRVSlots() { return m_CommittedSRVSlots; }
+    CommittedSlotsMask& GetCommittedUAVSlots() { return m_CommittedUAVSlots; }
+
 protected:
     // There appears to be a bug on NVidia GPUs: when calling UpdateTileMappings() with
     // null tile pool, all mappings get invalidated including those that are not
     // specified in the call. To workaround the bug, we have to keep the pointer to
     // the last used memory pool.
     RefCntWeakPtr<IDeviceMemoryD3D11> m_pSparseResourceMemory;
+
+    CommittedSlotsMask m_CommittedSRVSlots;
+    CommittedSlotsMask m_CommittedUAVSlots;
 };
 
 } // namespace Diligent
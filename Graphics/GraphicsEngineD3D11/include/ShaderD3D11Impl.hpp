@@ -32,6 +32,8 @@
 
 #include <mutex>
 #include <unordered_map>
+#include <vector>
+#include <string>
 #include <cstring>
 
 #include <atlbase.h>
@@ -41,6 +43,7 @@
 #include "ShaderD3DBase.hpp"
 #include "ShaderResourcesD3D11.hpp"
 #include "HashUtils.hpp"
+#include "ResourceBindingMap.hpp"
 
 namespace Diligent
 {
@@ -110,11 +113,43 @@ public:
         ShaderD3DBase::GetBytecode(ppBytecode, Size);
     }
 
+    /// Implementation of IShaderD3D::GetBytecodeWithResources() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE GetBytecodeWithResources(IDataBlob** ppBytecode) const override final
+    {
+        DEV_CHECK_ERR(ppBytecode != nullptr, "ppBytecode must not be null");
+        *ppBytecode = PackBytecodeWithResources(m_pShaderByteCode, m_pShaderResources.get()).Detach();
+    }
+
     const std::shared_ptr<const ShaderResourcesD3D11>& GetShaderResources() const { return m_pShaderResources; }
 
     ID3D11DeviceChild* GetD3D11Shader(ID3DBlob* pBlob) noexcept(false);
 
+    /// Returns the byte code with resource bindings remapped according to ResourceMap.
+    /// Remapped byte code is cached, so that pipelines that use the same bindings do not
+    /// patch the byte code and recompute the container checksum again.
+    CComPtr<ID3DBlob> GetRemappedBytecode(const ResourceBinding::TMap& ResourceMap) noexcept(false);
+
 private:
+    struct BindingMapKey
+    {
+        // Bindings sorted by resource name
+        std::vector<std::pair<std::string, ResourceBinding::BindInfo>> Bindings;
+
+        size_t Hash = 0;
+
+        explicit BindingMapKey(const ResourceBinding::TMap& ResourceMap);
+
+        struct Hasher
+        {
+            size_t operator()(const BindingMapKey& Key) const noexcept
+            {
+                return Key.Hash;
+            }
+        };
+
+        bool operator==(const BindingMapKey& rhs) const noexcept;
+    };
+
     struct BlobHashKey
     {
         const size_t      Hash;
@@ -163,6 +198,12 @@ private:
 
     std::mutex                                                                       m_d3dShaderCacheMtx;
     std::unordered_map<BlobHashKey, CComPtr<ID3D11DeviceChild>, BlobHashKey::Hasher> m_d3dShaderCache;
+    // Blobs that are keys in m_d3dShaderCache, which lets cached remapped byte code skip hashing.
+    // The blobs are kept alive by the keys, so the pointers can't be reused.
+    std::unordered_map<const ID3DBlob*, ID3D11DeviceChild*> m_d3dShaderByBlob;
+
+    std::mutex                                                                  m_RemappedBytecodeMtx;
+    std::unordered_map<BindingMapKey, CComPtr<ID3DBlob>, BindingMapKey::Hasher> m_RemappedBytecodeCache;
 
     // ShaderResources class instance must be referenced through the shared pointer, because
     // it is referenced by ShaderResourceLayoutD3D11 class instances
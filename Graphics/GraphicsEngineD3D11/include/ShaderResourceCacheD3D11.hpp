@@ -232,6 +232,14 @@ public:
             return pView.RawPtr<IDeviceObject>();
         }
 
+        // Returns the texture or the buffer as ResourceD3D11Base
+        ResourceD3D11Base* GetResourceBase() const
+        {
+            return pTexture != nullptr ?
+                static_cast<ResourceD3D11Base*>(pTexture) :
+                static_cast<ResourceD3D11Base*>(pBuffer);
+        }
+
         // Returns ID3D11ShaderResourceView or ID3D11UnorderedAccessView (not pd3d11Resource!)
         template <D3D11_RESOURCE_RANGE ResRange>
         typename CachedResourceTraits<ResRange>::D3D11ResourceType* GetD3D11Resource();
@@ -289,6 +297,19 @@ public:
     template <D3D11_RESOURCE_RANGE ResRange>
     bool CopyResource(const ShaderResourceCacheD3D11& SrcCache, const D3D11ResourceBindPoints& BindPoints);
 
+    // Returns the ring page that holds the buffer data and adds the offset of the data in the page to Offset.
+    // Returns pd3d11CB if the data is not in the ring.
+    static __forceinline ID3D11Buffer* GetDynamicCBRingBuffer(const CachedCB& CB, ID3D11Buffer* pd3d11CB, Uint32& Offset)
+    {
+        VERIFY_EXPR(CB.pBuff && CB.pBuff->IsDynamicCBRingCandidate());
+        const auto& Alloc = CB.pBuff->GetDynamicCBAllocation();
+        if (!Alloc)
+            return pd3d11CB;
+
+        Offset += Alloc.Offset;
+        return Alloc.pPage->pd3d11Buffer;
+    }
+
     template <D3D11_RESOURCE_RANGE ResRange>
     __forceinline bool IsResourceBound(const D3D11ResourceBindPoints& BindPoints) const
     {
@@ -348,17 +369,23 @@ public:
                                     typename CachedResourceTraits<Range>::D3D11ResourceType* CommittedD3D11Resources[],
                                     const D3D11ShaderResourceCounters&                       BaseBindings) const;
 
+    // When TrackCommittedSlots is true, the slots of every newly bound view are added to
+    // the committed slot masks of its resource (see ResourceD3D11Base::CommittedSlotsMask).
     template <D3D11_RESOURCE_RANGE Range>
     inline MinMaxSlot BindResourceViews(Uint32                                                   ShaderInd,
                                         typename CachedResourceTraits<Range>::D3D11ResourceType* CommittedD3D11Views[],
                                         ID3D11Resource*                                          CommittedD3D11Resources[],
-                                        const D3D11ShaderResourceCounters&                       BaseBindings) const;
+                                        const D3D11ShaderResourceCounters&                       BaseBindings,
+                                        bool                                                     TrackCommittedSlots) const;
 
+    // When UseDynamicCBRing is true, constant buffers whose data lives in the dynamic
+    // constant buffer ring are bound as ranges of the ring pages.
     inline MinMaxSlot BindCBs(Uint32                             ShaderInd,
                               ID3D11Buffer*                      CommittedD3D11Resources[],
                               UINT                               FirstConstants[],
                               UINT                               NumConstants[],
-                              const D3D11ShaderResourceCounters& BaseBindings) const;
+                              const D3D11ShaderResourceCounters& BaseBindings,
+                              bool                               UseDynamicCBRing) const;
 
     template <typename BindHandlerType>
     inline void BindDynamicCBs(Uint32                             ShaderInd,
@@ -366,6 +393,7 @@ public:
                                UINT                               FirstConstants[],
                                UINT                               NumConstants[],
                                const D3D11ShaderResourceCounters& BaseBindings,
+                               bool                               UseDynamicCBRing,
                                BindHandlerType&&                  BindHandler) const;
 
     enum class StateTransitionMode
@@ -373,7 +401,8 @@ public:
         Transition,
         Verify
     };
-    // Transitions all resources in the cache
+    // Transitions all resources in the cache. Does nothing if the resource states are
+    // up-to-date (see ShaderResourceCacheBase::ResourceStatesUpToDate()).
     template <StateTransitionMode Mode>
     void TransitionResourceStates(DeviceContextD3D11Impl& Ctx);
 
@@ -382,11 +411,19 @@ public:
         return m_DynamicCBOffsetsMask[ShaderInd];
     }
 
+    // Returns the mask of slots that need to be rebound by every draw or dispatch command,
+    // i.e. slots that contain constant buffers with dynamic offsets or whose data may move
+    // in the dynamic constant buffer ring.
+    Uint32 GetDynamicCBMask(Uint32 ShaderInd) const
+    {
+        return m_DynamicCBOffsetsMask[ShaderInd] | m_DynamicCBRingSlotsMask[ShaderInd];
+    }
+
     bool HasDynamicResources() const
     {
-        for (auto Mask : m_DynamicCBOffsetsMask)
+        for (Uint32 ShaderInd = 0; ShaderInd < NumShaderTypes; ++ShaderInd)
         {
-            if (Mask != 0)
+            if (GetDynamicCBMask(ShaderInd) != 0)
                 return true;
         }
         return false;
@@ -478,6 +515,10 @@ private:
     std::array<Uint16, NumShaderTypes> m_DynamicCBOffsetsMask{};
     static_assert(sizeof(m_DynamicCBOffsetsMask[0]) * 8 >= D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT, "Not enough bits for all dynamic buffer slots");
 
+    // Indicates which slots contain constant buffers whose data may be suballocated
+    // from the dynamic constant buffer ring (see BufferD3D11Impl::IsDynamicCBRingCandidate())
+    std::array<Uint16, NumShaderTypes> m_DynamicCBRingSlotsMask{};
+
     std::unique_ptr<Uint8, STDDeleter<Uint8, IMemoryAllocator>> m_pResourceData;
 };
 
@@ -600,8 +641,11 @@ inline ShaderResourceCacheD3D11::MinMaxSlot ShaderResourceCacheD3D11::BindResour
     Uint32                                                   ShaderInd,
     typename CachedResourceTraits<Range>::D3D11ResourceType* CommittedD3D11Views[],
     ID3D11Resource*                                          CommittedD3D11Resources[],
-    const D3D11ShaderResourceCounters&                       BaseBindings) const
+    const D3D11ShaderResourceCounters&                       BaseBindings,
+    bool                                                     TrackCommittedSlots) const
 {
+    static_assert(Range == D3D11_RESOURCE_RANGE_SRV || Range == D3D11_RESOURCE_RANGE_UAV, "Unexpected resource range");
+
     const auto   ResCount    = GetResourceCount<Range>(ShaderInd);
     const auto   ResArrays   = GetConstResourceArrays<Range>(ShaderInd);
     const Uint32 BaseBinding = BaseBindings[Range][ShaderInd];
@@ -611,8 +655,21 @@ inline ShaderResourceCacheD3D11::MinMaxSlot ShaderResourceCacheD3D11::BindResour
     {
         const Uint32 Slot = BaseBinding + res;
         if (CommittedD3D11Views[Slot] != ResArrays.second[res])
+        {
             Slots.Add(Slot);
 
+            if (TrackCommittedSlots)
+            {
+                if (auto* pResource = ResArrays.first[res].GetResourceBase())
+                {
+                    auto& CommittedSlots = Range == D3D11_RESOURCE_RANGE_SRV ?
+                        pResource->GetCommittedSRVSlots() :
+                        pResource->GetCommittedUAVSlots();
+                    CommittedSlots.Add(ShaderInd, Slot);
+                }
+            }
+        }
+
         // Note that a resource is allowed to be null if it is not used by the PSO.
         // Resources actually used by the PSO will be validated by PipelineStateD3D11Impl::DvpVerifySRBResources and
         // null resources will be reported.
@@ -629,21 +686,26 @@ inline ShaderResourceCacheD3D11::MinMaxSlot ShaderResourceCacheD3D11::BindCBs(
     ID3D11Buffer*                      CommittedD3D11Resources[],
     UINT                               FirstConstants[],
     UINT                               NumConstants[],
-    const D3D11ShaderResourceCounters& BaseBindings) const
+    const D3D11ShaderResourceCounters& BaseBindings,
+    bool                               UseDynamicCBRing) const
 {
     constexpr auto Range = D3D11_RESOURCE_RANGE_CBV;
 
     const auto   ResCount    = GetResourceCount<Range>(ShaderInd);
     const auto   ResArrays   = GetConstResourceArrays<Range>(ShaderInd);
     const Uint32 BaseBinding = BaseBindings[Range][ShaderInd];
+    const Uint32 RingMask    = UseDynamicCBRing ? Uint32{m_DynamicCBRingSlotsMask[ShaderInd]} : 0u;
 
     MinMaxSlot Slots;
     for (Uint32 res = 0; res < ResCount; ++res)
     {
         const Uint32 Slot     = BaseBinding + res;
-        auto* const  pd3d11CB = ResArrays.second[res];
+        Uint32       Offset   = ResArrays.first[res].BaseOffset + ResArrays.first[res].DynamicOffset;
+        auto* const  pd3d11CB = (RingMask & (1u << res)) != 0 ?
+            GetDynamicCBRingBuffer(ResArrays.first[res], ResArrays.second[res], Offset) :
+            ResArrays.second[res];
         // Offsets in Direct3D11 are measure in float4 constants.
-        const auto FirstCBConstant = StaticCast<UINT>((ResArrays.first[res].BaseOffset + ResArrays.first[res].DynamicOffset) / 16u);
+        const auto FirstCBConstant = StaticCast<UINT>(Offset / 16u);
         // The number of constants must be a multiple of 16 constants. It is OK if it is past the end of the buffer.
         const auto NumCBConstants = StaticCast<UINT>(AlignUp(ResArrays.first[res].RangeSize / 16u, 16u));
         // clang-format off
@@ -673,24 +735,29 @@ inline void ShaderResourceCacheD3D11::BindDynamicCBs(Uint32
                                                      UINT                               FirstConstants[],
                                                      UINT                               NumConstants[],
                                                      const D3D11ShaderResourceCounters& BaseBindings,
+                                                     bool                               UseDynamicCBRing,
                                                      BindHandlerType&&                  BindHandler) const
 {
     constexpr auto Range = D3D11_RESOURCE_RANGE_CBV;
 
     const auto   ResArrays   = GetConstResourceArrays<Range>(ShaderInd);
     const Uint32 BaseBinding = BaseBindings[Range][ShaderInd];
+    const Uint32 RingMask    = UseDynamicCBRing ? Uint32{m_DynamicCBRingSlotsMask[ShaderInd]} : 0u;
 
-    for (Uint32 DynamicCBMask = m_DynamicCBOffsetsMask[ShaderInd]; DynamicCBMask != 0;)
+    for (Uint32 DynamicCBMask = m_DynamicCBOffsetsMask[ShaderInd] | RingMask; DynamicCBMask != 0;)
     {
         const auto CBBit   = ExtractLSB(DynamicCBMask);
         const auto Binding = PlatformMisc::GetLSB(CBBit);
 
         const Uint32 Slot = BaseBinding + Binding;
         const auto&  CB   = ResArrays.first[Binding];
-        VERIFY_EXPR(CB.AllowsDynamicOffset() && (m_DynamicCBSlotsMask[ShaderInd] & CBBit) != 0);
-        auto* const pd3d11CB = ResArrays.second[Binding];
+        VERIFY_EXPR((RingMask & CBBit) != 0 || (CB.AllowsDynamicOffset() && (m_DynamicCBSlotsMask[ShaderInd] & CBBit) != 0));
+        Uint32      Offset   = CB.BaseOffset + CB.DynamicOffset;
+        auto* const pd3d11CB = (RingMask & CBBit) != 0 ?
+            GetDynamicCBRingBuffer(CB, ResArrays.second[Binding], Offset) :
+            ResArrays.second[Binding];
         // Offsets in Direct3D11 are measure in float4 constants.
-        const auto FirstCBConstant = StaticCast<UINT>((CB.BaseOffset + CB.DynamicOffset) / 16u);
+        const auto FirstCBConstant = StaticCast<UINT>(Offset / 16u);
         // The number of constants must be a multiple of 16 constants. It is OK if it is past the end of the buffer.
         const auto NumCBConstants = StaticCast<UINT>(AlignUp(CB.RangeSize / 16u, 16u));
         // clang-format off
@@ -750,6 +817,11 @@ inline void ShaderResourceCacheD3D11::UpdateDynamicCBOffsetFlag<D3D11_RESOURCE_R
         VERIFY((m_DynamicCBOffsetsMask[ShaderInd] & BufferBit) == 0,
                "A bit in m_DynamicCBOffsetsMask should never be set when corresponding bit in m_DynamicCBOffsetsMask is not set");
     }
+
+    if (CB.pBuff && CB.pBuff->IsDynamicCBRingCandidate())
+        m_DynamicCBRingSlotsMask[ShaderInd] |= BufferBit;
+    else
+        m_DynamicCBRingSlotsMask[ShaderInd] &= ~BufferBit;
 }
 
 
@@ -44,6 +44,13 @@ public:
                          const ShaderDesc& ShdrDesc,
                          const char*       CombinedSamplerSuffix,
                          bool              LoadConstantBufferReflection);
+
+    // Loads shader resources from the data written by ShaderResources::Serialize()
+    ShaderResourcesD3D11(const void*       pSerializedData,
+                         size_t            DataSize,
+                         const ShaderDesc& ShdrDesc,
+                         const char*       CombinedSamplerSuffix);
+
     ~ShaderResourcesD3D11();
 
     // clang-format off
@@ -59,6 +66,8 @@ public:
     // clang-format on
 
 private:
+    class NewResourceHandler;
+
     using MaxBindPointType = Int8;
 
     // clang-format off
@@ -189,11 +189,16 @@ public:
                         BIND_SHADER_RESOURCES_FLAGS          Flags,
                         SHADER_RESOURCE_VARIABLE_TYPE_FLAGS& StaleVarTypes) const;
 
-    IShaderResourceVariable* GetVariable(const Char* Name) const;
+    IShaderResourceVariable* GetVariable(SHADER_TYPE ShaderType, const Char* Name) const;
     IShaderResourceVariable* GetVariable(Uint32 Index) const;
 
     IObject& GetOwner() { return m_Owner; }
 
+    void SetInlineConstants(Uint32 ResIndex, const void* pConstants, Uint32 FirstConstant, Uint32 NumConstants)
+    {
+        m_ResourceCache.SetInlineConstants(ResIndex, pConstants, FirstConstant, NumConstants);
+    }
+
     Uint32 GetVariableCount() const;
 
     Uint32 GetVariableIndex(const IShaderResourceVariable& Variable) const;
@@ -250,7 +255,7 @@ private:
     }
 
     template <typename ResourceType>
-    IShaderResourceVariable* GetResourceByName(const Char* Name) const;
+    IShaderResourceVariable* GetResourceByResIndex(Uint32 ResIndex) const;
 
     template <typename THandleCB,
               typename THandleTexSRV,
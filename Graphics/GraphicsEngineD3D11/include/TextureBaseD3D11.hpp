@@ -65,16 +65,22 @@ public:
 
     void AddState(RESOURCE_STATE State)
     {
+        const auto OldState = m_State;
         m_State &= ~(RESOURCE_STATE_COMMON | RESOURCE_STATE_UNDEFINED);
         m_State |= State;
+        if (m_State != OldState)
+            OnStateChanged();
     }
 
     void ClearState(RESOURCE_STATE State)
     {
         VERIFY_EXPR(IsInKnownState());
+        const auto OldState = m_State;
         m_State &= ~State;
         if (m_State == RESOURCE_STATE_UNKNOWN)
             m_State = RESOURCE_STATE_UNDEFINED;
+        if (m_State != OldState)
+            OnStateChanged();
     }
 
     bool IsUsingNVApi() const
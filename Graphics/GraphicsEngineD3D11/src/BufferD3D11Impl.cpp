@@ -133,6 +133,13 @@ BufferD3D11Impl::BufferD3D11Impl(IReferenceCounters*        pRefCounters,
 
     // The memory is always coherent in Direct3D11
     m_MemoryProperties = MEMORY_PROPERTY_HOST_COHERENT;
+
+    // Small dynamic buffers that are only used as constant buffers can be suballocated from
+    // the dynamic constant buffer ring instead of being renamed on every map.
+    m_IsDynamicCBRingCandidate =
+        m_Desc.Usage == USAGE_DYNAMIC &&
+        m_Desc.BindFlags == BIND_UNIFORM_BUFFER &&
+        m_Desc.Size <= D3D11DynamicCBRing::MaxAllocationSize;
 }
 
 static BufferDesc BuffDescFromD3D11Buffer(ID3D11Buffer* pd3d11Buffer, BufferDesc BuffDesc)
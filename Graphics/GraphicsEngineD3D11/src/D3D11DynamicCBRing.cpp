@@ -0,0 +1,187 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "D3D11DynamicCBRing.hpp"
+
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+D3D11DynamicCBRing::D3D11DynamicCBRing(ID3D11Device* pd3d11Device, Uint32 MaxPages) :
+    m_pd3d11Device{pd3d11Device},
+    m_MaxPages{MaxPages}
+{
+    m_Pages.reserve(MaxPages);
+}
+
+D3D11DynamicCBRing::~D3D11DynamicCBRing()
+{
+    LOG_INFO_MESSAGE("D3D11 dynamic constant buffer ring: ", m_TotalAllocationSize, " bytes allocated, ", m_Pages.size(),
+                     (m_Pages.size() == 1 ? " page, " : " pages, "), m_NumPageSwitches, (m_NumPageSwitches == 1 ? " page switch" : " page switches"));
+}
+
+bool D3D11DynamicCBRing::IsSupported(ID3D11Device* pd3d11Device)
+{
+    D3D11_FEATURE_DATA_D3D11_OPTIONS d3d11Options{};
+    if (FAILED(pd3d11Device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &d3d11Options, sizeof(d3d11Options))))
+        return false;
+
+    return d3d11Options.ConstantBufferOffsetting && d3d11Options.MapNoOverwriteOnDynamicConstantBuffer;
+}
+
+bool D3D11DynamicCBRing::SelectFreePage()
+{
+    // Look for a page that is not referenced by any buffer, starting from the one after the current page.
+    // The current page is checked last.
+    const size_t NumPages = m_Pages.size();
+    for (size_t i = 1; i <= NumPages; ++i)
+    {
+        const size_t PageIdx = (m_CurrPage + i) % NumPages;
+        if (m_Pages[PageIdx].use_count() == 1)
+        {
+            VERIFY(m_Pages[PageIdx]->MapCount == 0, "A page that is not referenced by any buffer can't be mapped");
+            m_CurrPage = PageIdx;
+            return true;
+        }
+    }
+
+    if (NumPages >= m_MaxPages)
+        return false;
+
+    D3D11_BUFFER_DESC d3d11BuffDesc{};
+    d3d11BuffDesc.ByteWidth      = PageSize;
+    d3d11BuffDesc.Usage          = D3D11_USAGE_DYNAMIC;
+    d3d11BuffDesc.BindFlags      = D3D11_BIND_CONSTANT_BUFFER;
+    d3d11BuffDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    auto    pPage = std::make_shared<Page>();
+    HRESULT hr    = m_pd3d11Device->CreateBuffer(&d3d11BuffDesc, nullptr, &pPage->pd3d11Buffer);
+    if (FAILED(hr))
+    {
+        LOG_ERROR_MESSAGE("Failed to create D3D11 dynamic constant buffer ring page");
+        return false;
+    }
+
+    constexpr char PageName[] = "Dynamic constant buffer ring page";
+    pPage->pd3d11Buffer->SetPrivateData(WKPDID_D3DDebugObjectName, static_cast<UINT>(sizeof(PageName) - 1), PageName);
+
+    m_CurrPage = m_Pages.size();
+    m_Pages.emplace_back(std::move(pPage));
+    return true;
+}
+
+Uint8* D3D11DynamicCBRing::MapPage(ID3D11DeviceContext* pd3d11Ctx, Page& P, D3D11_MAP MapType)
+{
+    if (P.MapCount == 0)
+    {
+        D3D11_MAPPED_SUBRESOURCE MappedData{};
+
+        HRESULT hr = pd3d11Ctx->Map(P.pd3d11Buffer, 0, MapType, 0, &MappedData);
+        if (FAILED(hr))
+        {
+            LOG_ERROR_MESSAGE("Failed to map D3D11 dynamic constant buffer ring page");
+            return nullptr;
+        }
+        P.pMappedData = static_cast<Uint8*>(MappedData.pData);
+    }
+    else
+    {
+        // Several allocations from the same page may be mapped at the same time, but
+        // Direct3D11 does not allow mapping the resource that is already mapped.
+        VERIFY(MapType == D3D11_MAP_WRITE_NO_OVERWRITE, "A page that is already mapped can't be discarded");
+    }
+    ++P.MapCount;
+
+    return P.pMappedData;
+}
+
+void* D3D11DynamicCBRing::Allocate(ID3D11DeviceContext* pd3d11Ctx, Uint32 Size, Allocation& Alloc)
+{
+    if (Size == 0 || Size > MaxAllocationSize)
+        return nullptr;
+
+    const Uint32 AlignedSize = AlignUp(Size, AllocationAlignment);
+
+    D3D11_MAP MapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+    if (m_CurrPage >= m_Pages.size() || m_CurrOffset + AlignedSize > PageSize)
+    {
+        if (!SelectFreePage())
+            return nullptr;
+
+        // Let the driver rename the page. Draw calls that have already been recorded
+        // keep reading the previous contents.
+        MapType      = D3D11_MAP_WRITE_DISCARD;
+        m_CurrOffset = 0;
+        ++m_NumPageSwitches;
+    }
+
+    const auto& pPage = m_Pages[m_CurrPage];
+
+    auto* pPageData = MapPage(pd3d11Ctx, *pPage, MapType);
+    if (pPageData == nullptr)
+        return nullptr;
+
+    Alloc.pPage    = pPage;
+    Alloc.Offset   = m_CurrOffset;
+    Alloc.IsMapped = true;
+
+    m_CurrOffset += AlignedSize;
+    m_TotalAllocationSize += AlignedSize;
+
+    return pPageData + Alloc.Offset;
+}
+
+void* D3D11DynamicCBRing::Map(ID3D11DeviceContext* pd3d11Ctx, Allocation& Alloc)
+{
+    VERIFY_EXPR(Alloc && !Alloc.IsMapped);
+
+    auto* pPageData = MapPage(pd3d11Ctx, *Alloc.pPage, D3D11_MAP_WRITE_NO_OVERWRITE);
+    if (pPageData == nullptr)
+        return nullptr;
+
+    Alloc.IsMapped = true;
+    return pPageData + Alloc.Offset;
+}
+
+void D3D11DynamicCBRing::Unmap(ID3D11DeviceContext* pd3d11Ctx, Allocation& Alloc)
+{
+    VERIFY_EXPR(Alloc && Alloc.IsMapped);
+
+    auto& P = *Alloc.pPage;
+    VERIFY_EXPR(P.MapCount > 0);
+    if (--P.MapCount == 0)
+    {
+        pd3d11Ctx->Unmap(P.pd3d11Buffer, 0);
+        P.pMappedData = nullptr;
+    }
+    Alloc.IsMapped = false;
+}
+
+} // namespace Diligent
@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "D3D11UploadRing.hpp"
+
+#include <cstring>
+
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+D3D11UploadRing::D3D11UploadRing(ID3D11Device* pd3d11Device, Uint32 Size) :
+    m_Size{AlignUp(Size, Uint32{16})}
+{
+    D3D11_BUFFER_DESC d3d11BuffDesc{};
+    d3d11BuffDesc.ByteWidth = m_Size;
+    d3d11BuffDesc.Usage     = D3D11_USAGE_DYNAMIC;
+    // Dynamic buffers must have at least one bind flag. Vertex buffers are the only
+    // buffers that support D3D11_MAP_WRITE_NO_OVERWRITE on all D3D11.0 drivers.
+    d3d11BuffDesc.BindFlags      = D3D11_BIND_VERTEX_BUFFER;
+    d3d11BuffDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    HRESULT hr = pd3d11Device->CreateBuffer(&d3d11BuffDesc, nullptr, &m_pd3d11Buffer);
+    CHECK_D3D_RESULT_THROW(hr, "Failed to create D3D11 upload ring buffer");
+
+    constexpr char UploadRingName[] = "Upload ring";
+    m_pd3d11Buffer->SetPrivateData(WKPDID_D3DDebugObjectName, static_cast<UINT>(sizeof(UploadRingName) - 1), UploadRingName);
+}
+
+D3D11UploadRing::~D3D11UploadRing()
+{
+    LOG_INFO_MESSAGE("D3D11 upload ring: ", m_TotalUploadSize, " bytes uploaded, ", m_NumWraps, (m_NumWraps == 1 ? " wrap" : " wraps"));
+}
+
+Uint32 D3D11UploadRing::Upload(ID3D11DeviceContext* pd3d11Ctx, const void* pData, Uint32 Size)
+{
+    if (Size == 0 || Size > GetMaxUploadSize())
+        return InvalidOffset;
+
+    D3D11_MAP MapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+    if (m_CurrOffset + Size > m_Size)
+    {
+        // Let the driver rename the buffer. Copies that have already been recorded
+        // keep reading the previous contents.
+        MapType      = D3D11_MAP_WRITE_DISCARD;
+        m_CurrOffset = 0;
+        ++m_NumWraps;
+    }
+
+    D3D11_MAPPED_SUBRESOURCE MappedData{};
+
+    HRESULT hr = pd3d11Ctx->Map(m_pd3d11Buffer, 0, MapType, 0, &MappedData);
+    if (FAILED(hr))
+    {
+        LOG_ERROR_MESSAGE("Failed to map D3D11 upload ring buffer");
+        return InvalidOffset;
+    }
+
+    const Uint32 Offset = m_CurrOffset;
+    memcpy(reinterpret_cast<Uint8*>(MappedData.pData) + Offset, pData, Size);
+    pd3d11Ctx->Unmap(m_pd3d11Buffer, 0);
+
+    m_CurrOffset = AlignUp(Offset + Size, Uint32{16});
+    m_TotalUploadSize += Size;
+
+    return Offset;
+}
+
+} // namespace Diligent
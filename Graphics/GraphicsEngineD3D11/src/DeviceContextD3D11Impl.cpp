@@ -65,6 +65,9 @@ DeviceContextD3D11Impl::DeviceContextD3D11Impl(IReferenceCounters*          pRef
     m_CmdListAllocator    {GetRawAllocator(), sizeof(CommandListD3D11Impl), 64}
 // clang-format on
 {
+    // Deferred contexts can't use the ring as their command lists may be executed after the pages are reused.
+    if (!Desc.IsDeferred && D3D11DynamicCBRing::IsSupported(pDevice->GetD3D11Device()))
+        m_pDynamicCBRing = std::make_unique<D3D11DynamicCBRing>(pDevice->GetD3D11Device(), Uint32{DynamicCBRingMaxPages});
 }
 
 IMPLEMENT_QUERY_INTERFACE(DeviceContextD3D11Impl, IID_DeviceContextD3D11, TDeviceContextBase)
@@ -76,8 +79,22 @@ void DeviceContextD3D11Impl::Begin(Uint32 ImmediateContextId)
     TDeviceContextBase::Begin(DeviceContextIndex{ImmediateContextId}, COMMAND_QUEUE_TYPE_GRAPHICS);
 }
 
+void DeviceContextD3D11Impl::BeginReusable(Uint32 ImmediateContextId)
+{
+    Begin(ImmediateContextId);
+    // ID3D11DeviceContext::ExecuteCommandList() does not consume the command list,
+    // so it can be executed any number of times.
+    m_IsRecordingReusableCommands = true;
+}
+
 void DeviceContextD3D11Impl::SetPipelineState(IPipelineState* pPipelineState)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_SET_PIPELINE_STATE);
+
+    // Avoid QueryInterface and AddRef/Release when the same PSO is bound again
+    if (IsBoundPipelineState(pPipelineState))
+        return;
+
     RefCntAutoPtr<PipelineStateD3D11Impl> pPipelineStateD3D11{pPipelineState, PipelineStateD3D11Impl::IID_InternalImpl};
     VERIFY(pPipelineState == nullptr || pPipelineStateD3D11 != nullptr, "Unknown pipeline state object implementation");
     if (PipelineStateD3D11Impl::IsSameObject(m_pPipelineState, pPipelineStateD3D11))
@@ -217,6 +234,8 @@ void DeviceContextD3D11Impl::TransitionShaderResources(IPipelineState* pPipeline
 
 void DeviceContextD3D11Impl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_COMMIT_SHADER_RESOURCES);
+
     DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/);
 
     auto* const pShaderResBindingD3D11 = ClassPtrCast<ShaderResourceBindingD3D11Impl>(pShaderResourceBinding);
@@ -256,7 +275,7 @@ void DeviceContextD3D11Impl::BindCacheResources(const ShaderResourceCacheD3D11&
             auto* d3d11CBs       = m_CommittedRes.d3d11CBs[ShaderInd];
             auto* FirstConstants = m_CommittedRes.CBFirstConstants[ShaderInd];
             auto* NumConstants   = m_CommittedRes.CBNumConstants[ShaderInd];
-            if (auto Slots = ResourceCache.BindCBs(ShaderInd, d3d11CBs, FirstConstants, NumConstants, BaseBindings))
+            if (auto Slots = ResourceCache.BindCBs(ShaderInd, d3d11CBs, FirstConstants, NumConstants, BaseBindings, m_pDynamicCBRing != nullptr))
             {
                 auto SetCB1Method = SetCB1Methods[ShaderInd];
                 (m_pd3d11DeviceContext->*SetCB1Method)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1,
@@ -277,7 +296,7 @@ void DeviceContextD3D11Impl::BindCacheResources(const ShaderResourceCacheD3D11&
         {
             auto* d3d11SRVs   = m_CommittedRes.d3d11SRVs[ShaderInd];
             auto* d3d11SRVRes = m_CommittedRes.d3d11SRVResources[ShaderInd];
-            if (auto Slots = ResourceCache.BindResourceViews<D3D11_RESOURCE_RANGE_SRV>(ShaderInd, d3d11SRVs, d3d11SRVRes, BaseBindings))
+            if (auto Slots = ResourceCache.BindResourceViews<D3D11_RESOURCE_RANGE_SRV>(ShaderInd, d3d11SRVs, d3d11SRVRes, BaseBindings, !IsDeferred()))
             {
                 auto SetSRVMethod = SetSRVMethods[ShaderInd];
                 (m_pd3d11DeviceContext->*SetSRVMethod)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1, d3d11SRVs + Slots.MinSlot);
@@ -315,7 +334,7 @@ void DeviceContextD3D11Impl::BindCacheResources(const ShaderResourceCacheD3D11&
 
             auto* d3d11UAVs   = m_CommittedRes.d3d11UAVs[ShaderInd];
             auto* d3d11UAVRes = m_CommittedRes.d3d11UAVResources[ShaderInd];
-            if (auto Slots = ResourceCache.BindResourceViews<D3D11_RESOURCE_RANGE_UAV>(ShaderInd, d3d11UAVs, d3d11UAVRes, BaseBindings))
+            if (auto Slots = ResourceCache.BindResourceViews<D3D11_RESOURCE_RANGE_UAV>(ShaderInd, d3d11UAVs, d3d11UAVRes, BaseBindings, !IsDeferred()))
             {
                 if (ShaderInd == PSInd)
                 {
@@ -349,9 +368,9 @@ void DeviceContextD3D11Impl::BindDynamicCBs(const ShaderResourceCacheD3D11&    R
     for (SHADER_TYPE ActiveStages = m_BindInfo.ActiveStages; ActiveStages != SHADER_TYPE_UNKNOWN;)
     {
         const auto ShaderInd = ExtractFirstShaderStageIndex(ActiveStages);
-        if (ResourceCache.GetDynamicCBOffsetsMask(ShaderInd) == 0)
+        if (ResourceCache.GetDynamicCBMask(ShaderInd) == 0)
         {
-            // Skip stages that don't have any constant buffers with dynamic offsets
+            // Skip stages that don't have any constant buffers with dynamic offsets or in the dynamic constant buffer ring
             continue;
         }
 
@@ -360,7 +379,7 @@ void DeviceContextD3D11Impl::BindDynamicCBs(const ShaderResourceCacheD3D11&    R
         auto* NumConstants   = m_CommittedRes.CBNumConstants[ShaderInd];
         auto  SetCB1Method   = SetCB1Methods[ShaderInd];
 
-        ResourceCache.BindDynamicCBs(ShaderInd, d3d11CBs, FirstConstants, NumConstants, BaseBindings,
+        ResourceCache.BindDynamicCBs(ShaderInd, d3d11CBs, FirstConstants, NumConstants, BaseBindings, m_pDynamicCBRing != nullptr,
                                      [&](Uint32 Slot) //
                                      {
                                          (m_pd3d11DeviceContext->*SetCB1Method)(Slot, 1, d3d11CBs + Slot, FirstConstants + Slot, NumConstants + Slot);
@@ -533,9 +552,10 @@ void DeviceContextD3D11Impl::CommitD3D11IndexBuffer(VALUE_TYPE IndexType)
 void DeviceContextD3D11Impl::CommitD3D11VertexBuffers(PipelineStateD3D11Impl* pPipelineStateD3D11)
 {
     VERIFY(m_NumVertexStreams <= MAX_BUFFER_SLOTS, "Too many buffers are being set");
-    UINT NumBuffersToSet = std::max(m_NumVertexStreams, m_NumCommittedD3D11VBs);
 
-    bool BindVBs = m_NumVertexStreams != m_NumCommittedD3D11VBs;
+    // Only the contiguous range of slots that have changed is set
+    UINT StartSlot = MAX_BUFFER_SLOTS;
+    UINT EndSlot   = 0;
 
     for (UINT Slot = 0; Slot < m_NumVertexStreams; ++Slot)
     {
@@ -551,7 +571,8 @@ void DeviceContextD3D11Impl::CommitD3D11VertexBuffers(PipelineStateD3D11Impl* pP
             m_CommittedD3D11VBStrides[Slot] != Stride ||
             m_CommittedD3D11VBOffsets[Slot] != Offset)
         {
-            BindVBs = true;
+            StartSlot = std::min(StartSlot, Slot);
+            EndSlot   = Slot + 1;
 
             m_CommittedD3D11VertexBuffers[Slot] = pd3d11Buffer;
             m_CommittedD3D11VBStrides[Slot]     = Stride;
@@ -563,8 +584,13 @@ void DeviceContextD3D11Impl::CommitD3D11VertexBuffers(PipelineStateD3D11Impl* pP
     }
 
     // Unbind all buffers at the end
-    for (Uint32 Slot = m_NumVertexStreams; Slot < m_NumCommittedD3D11VBs; ++Slot)
+    for (UINT Slot = m_NumVertexStreams; Slot < m_NumCommittedD3D11VBs; ++Slot)
     {
+        if (m_CommittedD3D11VertexBuffers[Slot] != nullptr)
+        {
+            StartSlot = std::min(StartSlot, Slot);
+            EndSlot   = Slot + 1;
+        }
         m_CommittedD3D11VertexBuffers[Slot] = nullptr;
         m_CommittedD3D11VBStrides[Slot]     = 0;
         m_CommittedD3D11VBOffsets[Slot]     = 0;
@@ -572,9 +598,12 @@ void DeviceContextD3D11Impl::CommitD3D11VertexBuffers(PipelineStateD3D11Impl* pP
 
     m_NumCommittedD3D11VBs = m_NumVertexStreams;
 
-    if (BindVBs)
+    if (StartSlot < EndSlot)
     {
-        m_pd3d11DeviceContext->IASetVertexBuffers(0, NumBuffersToSet, m_CommittedD3D11VertexBuffers, m_CommittedD3D11VBStrides, m_CommittedD3D11VBOffsets);
+        m_pd3d11DeviceContext->IASetVertexBuffers(StartSlot, EndSlot - StartSlot,
+                                                  m_CommittedD3D11VertexBuffers + StartSlot,
+                                                  m_CommittedD3D11VBStrides + StartSlot,
+                                                  m_CommittedD3D11VBOffsets + StartSlot);
     }
 
     m_bCommittedD3D11VBsUpToDate = true;
@@ -594,6 +623,8 @@ void DeviceContextD3D11Impl::PrepareForDraw(DRAW_FLAGS Flags)
         CommitD3D11VertexBuffers(m_pPipelineState);
     }
 
+    if ((m_BindInfo.InlineConstantsSRBMask & m_BindInfo.ActiveSRBMask) != 0)
+        UpdateInlineConstantBuffers(m_BindInfo);
     if (Uint32 BindSRBMask = m_BindInfo.GetCommitMask(Flags & DRAW_FLAG_DYNAMIC_RESOURCE_BUFFERS_INTACT))
     {
         BindShaderResources(BindSRBMask);
@@ -660,7 +691,11 @@ void DeviceContextD3D11Impl::PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE
 
 void DeviceContextD3D11Impl::Draw(const DrawAttribs& Attribs)
 {
-    DvpVerifyDrawArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawArguments(Attribs))
+        return;
 
     PrepareForDraw(Attribs.Flags);
 
@@ -675,7 +710,11 @@ void DeviceContextD3D11Impl::Draw(const DrawAttribs& Attribs)
 
 void DeviceContextD3D11Impl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
-    DvpVerifyDrawIndexedArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawIndexedArguments(Attribs))
+        return;
 
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
 
@@ -690,7 +729,11 @@ void DeviceContextD3D11Impl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 
 void DeviceContextD3D11Impl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 {
-    DvpVerifyDrawIndirectArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawIndirectArguments(Attribs))
+        return;
     DEV_CHECK_ERR(Attribs.pCounterBuffer == nullptr, "Direct3D11 does not support indirect counter buffer");
 
     PrepareForDraw(Attribs.Flags);
@@ -727,7 +770,11 @@ void DeviceContextD3D11Impl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 
 void DeviceContextD3D11Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs)
 {
-    DvpVerifyDrawIndexedIndirectArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawIndexedIndirectArguments(Attribs))
+        return;
     DEV_CHECK_ERR(Attribs.pCounterBuffer == nullptr, "Direct3D11 does not support indirect counter buffer");
 
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
@@ -763,18 +810,86 @@ void DeviceContextD3D11Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttrib
 
 void DeviceContextD3D11Impl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
     UNSUPPORTED("DrawMesh is not supported in DirectX 11");
 }
 
 void DeviceContextD3D11Impl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
     UNSUPPORTED("DrawMeshIndirect is not supported in DirectX 11");
 }
 
+void DeviceContextD3D11Impl::MultiDraw(const MultiDrawAttribs& Attribs)
+{
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyMultiDrawArguments(Attribs))
+        return;
+
+    // Direct3D11 has no native multi-draw, so commit the states once and
+    // issue the draw calls for all items back to back.
+    PrepareForDraw(Attribs.Flags);
+
+    if (Attribs.NumInstances == 0)
+        return;
+
+    const bool UseInstancedDraw = Attribs.NumInstances > 1 || Attribs.FirstInstanceLocation != 0;
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        if (Item.NumVertices == 0)
+            continue;
+
+        if (UseInstancedDraw)
+            m_pd3d11DeviceContext->DrawInstanced(Item.NumVertices, Attribs.NumInstances, Item.StartVertexLocation, Attribs.FirstInstanceLocation);
+        else
+            m_pd3d11DeviceContext->Draw(Item.NumVertices, Item.StartVertexLocation);
+    }
+}
+
+void DeviceContextD3D11Impl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
+{
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyMultiDrawIndexedArguments(Attribs))
+        return;
+
+    PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
+
+    if (Attribs.NumInstances == 0)
+        return;
+
+    const bool UseInstancedDraw = Attribs.NumInstances > 1 || Attribs.FirstInstanceLocation != 0;
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        if (Item.NumIndices == 0)
+            continue;
+
+        if (UseInstancedDraw)
+            m_pd3d11DeviceContext->DrawIndexedInstanced(Item.NumIndices, Attribs.NumInstances, Item.FirstIndexLocation, Item.BaseVertex, Attribs.FirstInstanceLocation);
+        else
+            m_pd3d11DeviceContext->DrawIndexed(Item.NumIndices, Item.FirstIndexLocation, Item.BaseVertex);
+    }
+}
+
 void DeviceContextD3D11Impl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
-    DvpVerifyDispatchArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DISPATCH);
+    ++m_FrameStats.DispatchCount;
 
+    if (!VerifyDispatchArguments(Attribs))
+        return;
+
+    if ((m_BindInfo.InlineConstantsSRBMask & m_BindInfo.ActiveSRBMask) != 0)
+        UpdateInlineConstantBuffers(m_BindInfo);
     if (Uint32 BindSRBMask = m_BindInfo.GetCommitMask())
     {
         BindShaderResources(BindSRBMask);
@@ -803,8 +918,14 @@ void DeviceContextD3D11Impl::DispatchCompute(const DispatchComputeAttribs& Attri
 
 void DeviceContextD3D11Impl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs)
 {
-    DvpVerifyDispatchIndirectArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DISPATCH);
+    ++m_FrameStats.DispatchCount;
+
+    if (!VerifyDispatchIndirectArguments(Attribs))
+        return;
 
+    if ((m_BindInfo.InlineConstantsSRBMask & m_BindInfo.ActiveSRBMask) != 0)
+        UpdateInlineConstantBuffers(m_BindInfo);
     if (Uint32 BindSRBMask = m_BindInfo.GetCommitMask())
     {
         BindShaderResources(BindSRBMask);
@@ -885,6 +1006,29 @@ void DeviceContextD3D11Impl::UpdateBuffer(IBuffer*                       pBuffer
 
     auto* pBufferD3D11Impl = ClassPtrCast<BufferD3D11Impl>(pBuffer);
 
+    // Small updates on the immediate context are written to the upload ring and copied
+    // with CopySubresourceRegion. This avoids the extra copy UpdateSubresource makes to
+    // driver-internal memory as well as buffer renaming.
+    if (!IsDeferred() && Size <= UploadRingSize / 4)
+    {
+        if (!m_pUploadRing)
+            m_pUploadRing = std::make_unique<D3D11UploadRing>(m_pDevice->GetD3D11Device(), Uint32{UploadRingSize});
+
+        const auto RingOffset = m_pUploadRing->Upload(m_pd3d11DeviceContext, pData, StaticCast<Uint32>(Size));
+        if (RingOffset != D3D11UploadRing::InvalidOffset)
+        {
+            D3D11_BOX SrcBox;
+            SrcBox.left   = RingOffset;
+            SrcBox.right  = RingOffset + StaticCast<UINT>(Size);
+            SrcBox.top    = 0;
+            SrcBox.bottom = 1;
+            SrcBox.front  = 0;
+            SrcBox.back   = 1;
+            m_pd3d11DeviceContext->CopySubresourceRegion(pBufferD3D11Impl->m_pd3d11Buffer, 0, StaticCast<UINT>(Offset), 0, 0, m_pUploadRing->GetD3D11Buffer(), 0, &SrcBox);
+            return;
+        }
+    }
+
     D3D11_BOX DstBox;
     DstBox.left   = StaticCast<UINT>(Offset);
     DstBox.right  = StaticCast<UINT>(Offset + Size);
@@ -909,6 +1053,15 @@ void DeviceContextD3D11Impl::CopyBuffer(IBuffer*                       pSrcBuffe
     auto* pSrcBufferD3D11Impl = ClassPtrCast<BufferD3D11Impl>(pSrcBuffer);
     auto* pDstBufferD3D11Impl = ClassPtrCast<BufferD3D11Impl>(pDstBuffer);
 
+    ID3D11Buffer* pd3d11SrcBuffer = pSrcBufferD3D11Impl->m_pd3d11Buffer;
+    if (m_pDynamicCBRing && pSrcBufferD3D11Impl->m_DynamicCBAllocation)
+    {
+        // The source data lives in the dynamic constant buffer ring
+        const auto& SrcAlloc = pSrcBufferD3D11Impl->m_DynamicCBAllocation;
+        pd3d11SrcBuffer      = SrcAlloc.pPage->pd3d11Buffer;
+        SrcOffset += SrcAlloc.Offset;
+    }
+
     D3D11_BOX SrcBox;
     SrcBox.left   = StaticCast<UINT>(SrcOffset);
     SrcBox.right  = StaticCast<UINT>(SrcOffset + Size);
@@ -916,15 +1069,42 @@ void DeviceContextD3D11Impl::CopyBuffer(IBuffer*                       pSrcBuffe
     SrcBox.bottom = 1;
     SrcBox.front  = 0;
     SrcBox.back   = 1;
-    m_pd3d11DeviceContext->CopySubresourceRegion(pDstBufferD3D11Impl->m_pd3d11Buffer, 0, StaticCast<UINT>(DstOffset), 0, 0, pSrcBufferD3D11Impl->m_pd3d11Buffer, 0, &SrcBox);
+    m_pd3d11DeviceContext->CopySubresourceRegion(pDstBufferD3D11Impl->m_pd3d11Buffer, 0, StaticCast<UINT>(DstOffset), 0, 0, pd3d11SrcBuffer, 0, &SrcBox);
 }
 
 
 void DeviceContextD3D11Impl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_MAP_BUFFER);
+
     TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
 
-    auto*     pBufferD3D11  = ClassPtrCast<BufferD3D11Impl>(pBuffer);
+    auto* pBufferD3D11 = ClassPtrCast<BufferD3D11Impl>(pBuffer);
+    if (m_pDynamicCBRing && pBufferD3D11->IsDynamicCBRingCandidate() && MapType == MAP_WRITE)
+    {
+        auto& DynamicCBAlloc = pBufferD3D11->m_DynamicCBAllocation;
+        if ((MapFlags & MAP_FLAG_DISCARD) != 0)
+        {
+            // Suballocate the data from the ring instead of renaming the buffer
+            D3D11DynamicCBRing::Allocation NewAlloc;
+            pMappedData = m_pDynamicCBRing->Allocate(m_pd3d11DeviceContext, StaticCast<Uint32>(pBufferD3D11->GetDesc().Size), NewAlloc);
+            if (pMappedData != nullptr)
+            {
+                DynamicCBAlloc = std::move(NewAlloc);
+                m_FrameStats.DynamicHeapBytes += pBufferD3D11->GetDesc().Size;
+                return;
+            }
+        }
+        else if ((MapFlags & MAP_FLAG_NO_OVERWRITE) != 0 && DynamicCBAlloc)
+        {
+            pMappedData = m_pDynamicCBRing->Map(m_pd3d11DeviceContext, DynamicCBAlloc);
+            return;
+        }
+
+        // The data will be written to the buffer itself
+        DynamicCBAlloc = {};
+    }
+
     D3D11_MAP d3d11MapType  = static_cast<D3D11_MAP>(0);
     UINT      d3d11MapFlags = 0;
     MapParamsToD3D11MapParams(MapType, MapFlags, d3d11MapType, d3d11MapFlags);
@@ -937,12 +1117,22 @@ void DeviceContextD3D11Impl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_F
         DEV_CHECK_ERR(SUCCEEDED(hr), "Failed to map buffer '", pBufferD3D11->GetDesc().Name, "'");
     }
     pMappedData = SUCCEEDED(hr) ? MappedBuff.pData : nullptr;
+
+    if (pMappedData != nullptr && (MapFlags & MAP_FLAG_DISCARD) != 0)
+        m_FrameStats.DynamicHeapBytes += pBufferD3D11->GetDesc().Size;
 }
 
 void DeviceContextD3D11Impl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_UNMAP_BUFFER);
+
     TDeviceContextBase::UnmapBuffer(pBuffer, MapType);
     auto* pBufferD3D11 = ClassPtrCast<BufferD3D11Impl>(pBuffer);
+    if (m_pDynamicCBRing && pBufferD3D11->m_DynamicCBAllocation.IsMapped)
+    {
+        m_pDynamicCBRing->Unmap(m_pd3d11DeviceContext, pBufferD3D11->m_DynamicCBAllocation);
+        return;
+    }
     m_pd3d11DeviceContext->Unmap(pBufferD3D11->m_pd3d11Buffer, 0);
 }
 
@@ -1067,6 +1257,19 @@ void DeviceContextD3D11Impl::GenerateMips(ITextureView* pTextureView)
     m_pd3d11DeviceContext->GenerateMips(pd3d11SRV);
 }
 
+void DeviceContextD3D11Impl::GenerateMipsBatch(ITextureView* const* ppTextureViews, Uint32 NumViews)
+{
+    TDeviceContextBase::GenerateMipsBatch(ppTextureViews, NumViews);
+    // Direct3D11 does not expose the barriers and pipelines used to generate mipmaps,
+    // so there is nothing to batch.
+    for (Uint32 i = 0; i < NumViews; ++i)
+    {
+        auto& TexViewD3D11 = *ClassPtrCast<TextureViewD3D11Impl>(ppTextureViews[i]);
+        auto* pd3d11SRV    = static_cast<ID3D11ShaderResourceView*>(TexViewD3D11.GetD3D11View());
+        m_pd3d11DeviceContext->GenerateMips(pd3d11SRV);
+    }
+}
+
 void DeviceContextD3D11Impl::FinishFrame()
 {
     if (m_ActiveDisjointQuery)
@@ -1096,7 +1299,7 @@ void DeviceContextD3D11Impl::SetVertexBuffers(Uint32                         Sta
             {
                 if (pBuffD3D11Impl->IsInKnownState() && pBuffD3D11Impl->CheckState(RESOURCE_STATE_UNORDERED_ACCESS))
                 {
-                    UnbindResourceFromUAV(pBuffD3D11Impl->m_pd3d11Buffer);
+                    UnbindResourceFromUAV(*pBuffD3D11Impl, pBuffD3D11Impl->m_pd3d11Buffer);
                     pBuffD3D11Impl->ClearState(RESOURCE_STATE_UNORDERED_ACCESS);
                 }
             }
@@ -1126,7 +1329,7 @@ void DeviceContextD3D11Impl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOf
         {
             if (m_pIndexBuffer->IsInKnownState() && m_pIndexBuffer->CheckState(RESOURCE_STATE_UNORDERED_ACCESS))
             {
-                UnbindResourceFromUAV(m_pIndexBuffer->m_pd3d11Buffer);
+                UnbindResourceFromUAV(*m_pIndexBuffer, m_pIndexBuffer->m_pd3d11Buffer);
                 m_pIndexBuffer->ClearState(RESOURCE_STATE_UNORDERED_ACCESS);
             }
         }
@@ -1290,25 +1493,36 @@ bool UnbindPixelShaderUAV<ID3D11UnorderedAccessView, TSetUnorderedAccessViewsTyp
 ///                                     shader resources, for each shader stage
 /// \param CommittedResourcesArr      - Pointer to the array of strong references to currently bound
 ///                                     shader resources, for each shader stage
+/// \param CommittedSlots             - Stages and slots where the resource may be bound.
+///                                     Only used by the immediate context, deferred contexts check all slots.
 /// \param pd3d11ResToUndind          - D3D11 resource to unbind
 /// \param SetD3D11ViewMethods        - Array of pointers to device context methods used to set the view,
 ///                                     for every shader stage
 template <typename TD3D11ResourceViewType,
           typename TSetD3D11View,
           size_t NumSlots>
-void DeviceContextD3D11Impl::UnbindResourceView(TD3D11ResourceViewType CommittedD3D11ViewsArr[][NumSlots],
-                                                ID3D11Resource*        CommittedD3D11ResourcesArr[][NumSlots],
-                                                Uint8                  NumCommittedResourcesArr[],
-                                                ID3D11Resource*        pd3d11ResToUndind,
-                                                TSetD3D11View          SetD3D11ViewMethods[])
-{
-    for (Int32 ShaderTypeInd = 0; ShaderTypeInd < NumShaderTypes; ++ShaderTypeInd)
+void DeviceContextD3D11Impl::UnbindResourceView(TD3D11ResourceViewType                 CommittedD3D11ViewsArr[][NumSlots],
+                                                ID3D11Resource*                        CommittedD3D11ResourcesArr[][NumSlots],
+                                                Uint8                                  NumCommittedResourcesArr[],
+                                                ResourceD3D11Base::CommittedSlotsMask& CommittedSlots,
+                                                ID3D11Resource*                        pd3d11ResToUndind,
+                                                TSetD3D11View                          SetD3D11ViewMethods[])
+{
+    // The immediate context tracks where every resource is bound, see BindCacheResources().
+    const bool UseCommittedSlots = !IsDeferred();
+    if (UseCommittedSlots && CommittedSlots.Stages == 0)
+        return;
+
+    const Uint32 AllStages = (1u << NumShaderTypes) - 1u;
+    for (Uint32 Stages = UseCommittedSlots ? CommittedSlots.Stages : AllStages; Stages != 0;)
     {
+        const auto ShaderTypeInd = PlatformMisc::GetLSB(ExtractLSB(Stages));
+
         auto* CommittedD3D11Views     = CommittedD3D11ViewsArr[ShaderTypeInd];
         auto* CommittedD3D11Resources = CommittedD3D11ResourcesArr[ShaderTypeInd];
         auto& NumCommittedSlots       = NumCommittedResourcesArr[ShaderTypeInd];
 
-        for (Uint32 Slot = 0; Slot < NumCommittedSlots; ++Slot)
+        auto UnbindSlot = [&](Uint32 Slot) //
         {
             if (CommittedD3D11Resources[Slot] == pd3d11ResToUndind)
             {
@@ -1324,6 +1538,22 @@ void DeviceContextD3D11Impl::UnbindResourceView(TD3D11ResourceViewType Committed
                     UnbindView(m_pd3d11DeviceContext, SetViewMethod, Slot);
                 }
             }
+        };
+
+        if (UseCommittedSlots)
+        {
+            // Only check the slots whose bits are set in the mask
+            for (Uint64 SlotBits = CommittedSlots.Slots; SlotBits != 0;)
+            {
+                const auto SlotBit = PlatformMisc::GetLSB(ExtractLSB(SlotBits));
+                for (Uint32 Slot = SlotBit; Slot < NumCommittedSlots; Slot += 64)
+                    UnbindSlot(Slot);
+            }
+        }
+        else
+        {
+            for (Uint32 Slot = 0; Slot < NumCommittedSlots; ++Slot)
+                UnbindSlot(Slot);
         }
 
         // Pop null resources from the end of arrays
@@ -1333,11 +1563,17 @@ void DeviceContextD3D11Impl::UnbindResourceView(TD3D11ResourceViewType Committed
             --NumCommittedSlots;
         }
     }
+
+    if (UseCommittedSlots)
+    {
+        // The resource is now unbound from all slots
+        CommittedSlots = {};
+    }
 }
 
 void DeviceContextD3D11Impl::UnbindTextureFromInput(TextureBaseD3D11& Texture, ID3D11Resource* pd3d11Resource)
 {
-    UnbindResourceView(m_CommittedRes.d3d11SRVs, m_CommittedRes.d3d11SRVResources, m_CommittedRes.NumSRVs, pd3d11Resource, SetSRVMethods);
+    UnbindResourceView(m_CommittedRes.d3d11SRVs, m_CommittedRes.d3d11SRVResources, m_CommittedRes.NumSRVs, Texture.GetCommittedSRVSlots(), pd3d11Resource, SetSRVMethods);
     if (Texture.IsInKnownState())
         Texture.ClearState(RESOURCE_STATE_SHADER_RESOURCE | RESOURCE_STATE_INPUT_ATTACHMENT);
 }
@@ -1346,7 +1582,7 @@ void DeviceContextD3D11Impl::UnbindBufferFromInput(BufferD3D11Impl& Buffer, RESO
 {
     if (OldState & RESOURCE_STATE_SHADER_RESOURCE)
     {
-        UnbindResourceView(m_CommittedRes.d3d11SRVs, m_CommittedRes.d3d11SRVResources, m_CommittedRes.NumSRVs, pd3d11Buffer, SetSRVMethods);
+        UnbindResourceView(m_CommittedRes.d3d11SRVs, m_CommittedRes.d3d11SRVResources, m_CommittedRes.NumSRVs, Buffer.GetCommittedSRVSlots(), pd3d11Buffer, SetSRVMethods);
         if (Buffer.IsInKnownState())
             Buffer.ClearState(RESOURCE_STATE_SHADER_RESOURCE);
     }
@@ -1413,9 +1649,9 @@ void DeviceContextD3D11Impl::UnbindBufferFromInput(BufferD3D11Impl& Buffer, RESO
     }
 }
 
-void DeviceContextD3D11Impl::UnbindResourceFromUAV(ID3D11Resource* pd3d11Resource)
+void DeviceContextD3D11Impl::UnbindResourceFromUAV(ResourceD3D11Base& Resource, ID3D11Resource* pd3d11Resource)
 {
-    UnbindResourceView(m_CommittedRes.d3d11UAVs, m_CommittedRes.d3d11UAVResources, m_CommittedRes.NumUAVs, pd3d11Resource, SetUAVMethods);
+    UnbindResourceView(m_CommittedRes.d3d11UAVs, m_CommittedRes.d3d11UAVResources, m_CommittedRes.NumUAVs, Resource.GetCommittedUAVSlots(), pd3d11Resource, SetUAVMethods);
 }
 
 void DeviceContextD3D11Impl::UnbindTextureFromRenderTarget(TextureBaseD3D11& Texture)
@@ -1538,7 +1774,7 @@ void DeviceContextD3D11Impl::BeginSubpass()
             if (auto* pTexView = FBDesc.ppAttachments[AttachmentRef.AttachmentIndex])
             {
                 auto* pTexD3D11 = ClassPtrCast<TextureBaseD3D11>(pTexView->GetTexture());
-                UnbindResourceView(m_CommittedRes.d3d11SRVs, m_CommittedRes.d3d11SRVResources, m_CommittedRes.NumSRVs, pTexD3D11->GetD3D11Texture(), SetSRVMethods);
+                UnbindResourceView(m_CommittedRes.d3d11SRVs, m_CommittedRes.d3d11SRVResources, m_CommittedRes.NumSRVs, pTexD3D11->GetCommittedSRVSlots(), pTexD3D11->GetD3D11Texture(), SetSRVMethods);
             }
         }
     };
@@ -1878,9 +2114,7 @@ void DeviceContextD3D11Impl::WaitForIdle()
     auto*                pd3d11Device = m_pDevice->GetD3D11Device();
     CComPtr<ID3D11Query> pd3d11Query  = CreateD3D11QueryEvent(pd3d11Device);
     m_pd3d11DeviceContext->End(pd3d11Query);
-    BOOL Data;
-    while (m_pd3d11DeviceContext->GetData(pd3d11Query, &Data, sizeof(Data), 0) != S_OK)
-        std::this_thread::sleep_for(std::chrono::microseconds{1});
+    FenceD3D11Impl::WaitForQuery(m_pd3d11DeviceContext, pd3d11Query, true);
 }
 
 std::shared_ptr<DisjointQueryPool::DisjointQueryWrapper> DeviceContextD3D11Impl::BeginDisjointQuery()
@@ -2055,6 +2289,8 @@ static void AliasingBarrier(ID3D11DeviceContext* pd3d11Ctx, IDeviceObject* pReso
 
 void DeviceContextD3D11Impl::TransitionResourceStates(Uint32 BarrierCount, const StateTransitionDesc* pResourceBarriers)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_TRANSITION_RESOURCE_STATES);
+
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
 
     for (Uint32 i = 0; i < BarrierCount; ++i)
@@ -2135,7 +2371,7 @@ void DeviceContextD3D11Impl::TransitionResource(TextureBaseD3D11& Texture, RESOU
 
         if ((OldState & RESOURCE_STATE_UNORDERED_ACCESS) != 0)
         {
-            UnbindResourceFromUAV(Texture.GetD3D11Texture());
+            UnbindResourceFromUAV(Texture, Texture.GetD3D11Texture());
             if (Texture.IsInKnownState())
                 Texture.ClearState(RESOURCE_STATE_UNORDERED_ACCESS);
         }
@@ -2179,7 +2415,7 @@ void DeviceContextD3D11Impl::TransitionResource(BufferD3D11Impl& Buffer, RESOURC
 
     if ((NewState & RESOURCE_STATE_GENERIC_READ) != 0)
     {
-        UnbindResourceFromUAV(Buffer.m_pd3d11Buffer);
+        UnbindResourceFromUAV(Buffer, Buffer.m_pd3d11Buffer);
         if (Buffer.IsInKnownState())
             Buffer.ClearState(RESOURCE_STATE_UNORDERED_ACCESS);
     }
@@ -2228,6 +2464,11 @@ void DeviceContextD3D11Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
     UNSUPPORTED("BuildBLAS is not supported in DirectX 11");
 }
 
+void DeviceContextD3D11Impl::BuildBLASBatch(const BuildBLASBatchAttribs& Attribs)
+{
+    UNSUPPORTED("BuildBLASBatch is not supported in DirectX 11");
+}
+
 void DeviceContextD3D11Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
 {
     UNSUPPORTED("BuildTLAS is not supported in DirectX 11");
@@ -2273,6 +2514,59 @@ void DeviceContextD3D11Impl::SetShadingRate(SHADING_RATE BaseRate, SHADING_RATE_
     UNSUPPORTED("SetShadingRate is not supported in DirectX 11");
 }
 
+void DeviceContextD3D11Impl::BeginIndexedQuery(IQueryArray* pQueryArray, Uint32 Index)
+{
+    UNSUPPORTED("BeginIndexedQuery is not supported in DirectX 11");
+}
+
+void DeviceContextD3D11Impl::EndIndexedQuery(IQueryArray* pQueryArray, Uint32 Index)
+{
+    UNSUPPORTED("EndIndexedQuery is not supported in DirectX 11");
+}
+
+void DeviceContextD3D11Impl::ResolveQueryArray(const ResolveQueryArrayAttribs& Attribs)
+{
+    UNSUPPORTED("ResolveQueryArray is not supported in DirectX 11");
+}
+
+void DeviceContextD3D11Impl::SetPredication(IBuffer* pBuffer, Uint64 Offset, PREDICATION_OP Op)
+{
+    UNSUPPORTED("SetPredication is not supported in DirectX 11");
+}
+
+void DeviceContextD3D11Impl::SetQueryPredication(IQuery* pQuery, PREDICATION_OP Op)
+{
+    TDeviceContextBase::SetQueryPredication(pQuery, Op, 0);
+
+    if (pQuery == nullptr)
+    {
+        m_pd3d11DeviceContext->SetPredication(nullptr, FALSE);
+        return;
+    }
+
+    // Binary occlusion queries are created as D3D11_QUERY_OCCLUSION_PREDICATE queries
+    CComQIPtr<ID3D11Predicate> pd3d11Predicate{ClassPtrCast<QueryD3D11Impl>(pQuery)->GetD3D11Query(0)};
+    DEV_CHECK_ERR(pd3d11Predicate, "Failed to query ID3D11Predicate interface from the query '", pQuery->GetDesc().Name, "'");
+
+    // The predicate value is TRUE if any sample passed. Rendering is skipped when the value matches PredicateValue.
+    m_pd3d11DeviceContext->SetPredication(pd3d11Predicate, Op == PREDICATION_OP_SKIP_IF_ZERO ? FALSE : TRUE);
+}
+
+void DeviceContextD3D11Impl::SetCullMode(CULL_MODE CullMode)
+{
+    UNSUPPORTED("SetCullMode is not supported in DirectX 11");
+}
+
+void DeviceContextD3D11Impl::SetDepthStencilState(const DepthStencilStateDesc& DSSDesc)
+{
+    UNSUPPORTED("SetDepthStencilState is not supported in DirectX 11");
+}
+
+void DeviceContextD3D11Impl::SetPrimitiveTopology(PRIMITIVE_TOPOLOGY Topology)
+{
+    UNSUPPORTED("SetPrimitiveTopology is not supported in DirectX 11");
+}
+
 void DeviceContextD3D11Impl::BindSparseResourceMemory(const BindSparseResourceMemoryAttribs& Attribs)
 {
     TDeviceContextBase::BindSparseResourceMemory(Attribs, 0);
@@ -178,6 +178,9 @@ void EngineFactoryD3D11Impl::CreateDeviceAndContextsD3D11(const EngineD3D11Creat
     *ppDevice = nullptr;
     memset(ppContexts, 0, sizeof(*ppContexts) * (size_t{std::max(1u, EngineCI.NumImmediateContexts)} + size_t{EngineCI.NumDeferredContexts}));
 
+    BeginStartupProfiling(EngineCI);
+    StartupProfiler::Scope ProfilerScope{"CreateDeviceAndContextsD3D11"};
+
     // This flag adds support for surfaces with a different color channel ordering
     // than the API default. It is required for compatibility with Direct2D.
     // D3D11_CREATE_DEVICE_BGRA_SUPPORT;
@@ -209,6 +212,8 @@ void EngineFactoryD3D11Impl::CreateDeviceAndContextsD3D11(const EngineD3D11Creat
 
     for (int adapterType = 0; adapterType < 2 && !pd3d11Device; ++adapterType)
     {
+        StartupProfiler::Scope DeviceScope{"Create D3D11 device"};
+
         IDXGIAdapter*   adapter    = nullptr;
         D3D_DRIVER_TYPE driverType = D3D_DRIVER_TYPE_UNKNOWN;
         switch (adapterType)
@@ -304,11 +309,16 @@ void EngineFactoryD3D11Impl::AttachToD3D11Device(void*                        pd
         SetRawAllocator(EngineCI.pRawMemAllocator);
         auto& RawAllocator = GetRawAllocator();
 
-        RenderDeviceD3D11Impl* pRenderDeviceD3D11{
-            NEW_RC_OBJ(RawAllocator, "RenderDeviceD3D11Impl instance", RenderDeviceD3D11Impl)(
-                RawAllocator, this, EngineCI, AdapterInfo, pd3d11Device) //
-        };
-        pRenderDeviceD3D11->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
+        RenderDeviceD3D11Impl* pRenderDeviceD3D11 = nullptr;
+        {
+            StartupProfiler::Scope RenderDeviceScope{"Create render device"};
+
+            pRenderDeviceD3D11 = NEW_RC_OBJ(RawAllocator, "RenderDeviceD3D11Impl instance", RenderDeviceD3D11Impl)(
+                RawAllocator, this, EngineCI, AdapterInfo, pd3d11Device);
+            pRenderDeviceD3D11->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
+        }
+
+        StartupProfiler::Scope ContextsScope{"Create device contexts"};
 
         CComQIPtr<ID3D11DeviceContext1> pd3d11ImmediateCtx1{pd3d11ImmediateCtx};
         if (!pd3d11ImmediateCtx1)
@@ -438,7 +448,7 @@ GraphicsAdapterInfo EngineFactoryD3D11Impl::GetGraphicsAdapterInfo(void*
         }
         Features.ShaderFloat16 = ShaderFloat16Supported ? DEVICE_FEATURE_STATE_ENABLED : DEVICE_FEATURE_STATE_DISABLED;
     }
-    ASSERT_SIZEOF(Features, 41, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
+    ASSERT_SIZEOF(Features, 42, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
 
     // Texture properties
     {
@@ -498,7 +508,7 @@ GraphicsAdapterInfo EngineFactoryD3D11Impl::GetGraphicsAdapterInfo(void*
     // Draw command properties
     {
         auto& DrawCommandProps{AdapterInfo.DrawCommand};
-        DrawCommandProps.CapFlags |= DRAW_COMMAND_CAP_FLAG_BASE_VERTEX;
+        DrawCommandProps.CapFlags |= DRAW_COMMAND_CAP_FLAG_BASE_VERTEX | DRAW_COMMAND_CAP_FLAG_QUERY_PREDICATION;
 #if D3D11_REQ_DRAWINDEXED_INDEX_COUNT_2_TO_EXP >= 32
         DrawCommandProps.MaxIndexValue = ~0u;
 #else
@@ -28,6 +28,10 @@
 #include "pch.h"
 
 #include "FenceD3D11Impl.hpp"
+
+#include <chrono>
+#include <thread>
+
 #include "RenderDeviceD3D11Impl.hpp"
 #include "EngineMemory.h"
 
@@ -86,16 +90,39 @@ void FenceD3D11Impl::Wait(Uint64 Value, bool FlushCommands)
         if (QueryData.Value > Value)
             break;
 
-        BOOL Data;
-        while (QueryData.pd3d11Ctx->GetData(QueryData.pd3d11Query, &Data, sizeof(Data), FlushCommands ? 0 : D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
-            std::this_thread::sleep_for(std::chrono::microseconds{1});
+        WaitForQuery(QueryData.pd3d11Ctx, QueryData.pd3d11Query, FlushCommands);
+        // Commands submitted before this query have been flushed already
+        FlushCommands = false;
 
-        VERIFY_EXPR(Data == TRUE);
         UpdateLastCompletedFenceValue(QueryData.Value);
         m_PendingQueries.pop_front();
     }
 }
 
+void FenceD3D11Impl::WaitForQuery(ID3D11DeviceContext* pd3d11Ctx, ID3D11Query* pd3d11Query, bool FlushCommands)
+{
+    // Yield for a short time to keep the latency low when the GPU is about to finish,
+    // and then sleep to release the CPU during long waits.
+    constexpr auto MaxYieldDuration = std::chrono::milliseconds{2};
+
+    BOOL Data = FALSE;
+    if (pd3d11Ctx->GetData(pd3d11Query, &Data, sizeof(Data), FlushCommands ? 0 : D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK)
+    {
+        VERIFY_EXPR(Data == TRUE);
+        return;
+    }
+
+    const auto StartTime = std::chrono::steady_clock::now();
+    while (pd3d11Ctx->GetData(pd3d11Query, &Data, sizeof(Data), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+    {
+        if (std::chrono::steady_clock::now() - StartTime < MaxYieldDuration)
+            std::this_thread::yield();
+        else
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    VERIFY_EXPR(Data == TRUE);
+}
+
 void FenceD3D11Impl::Signal(Uint64 Value)
 {
     DEV_ERROR("Signal() is not supported in Direct3D11 backend");
@@ -122,7 +122,6 @@ void PipelineStateD3D11Impl::RemapOrVerifyShaderResources(const TShaderStages&
     {
         auto* const pShader    = Shaders[s];
         auto const  ShaderType = pShader->GetDesc().ShaderType;
-        auto* const pBytecode  = Shaders[s]->GetD3DBytecode();
 
         ResourceBinding::TMap ResourceMap;
         for (Uint32 sign = 0; sign < SignatureCount; ++sign)
@@ -140,13 +139,7 @@ void PipelineStateD3D11Impl::RemapOrVerifyShaderResources(const TShaderStages&
 
         if (HandleRemappedBytecodeFn)
         {
-            CComPtr<ID3DBlob> pPatchedBytecode;
-            D3DCreateBlob(pBytecode->GetBufferSize(), &pPatchedBytecode);
-            memcpy(pPatchedBytecode->GetBufferPointer(), pBytecode->GetBufferPointer(), pBytecode->GetBufferSize());
-
-            if (!DXBCUtils::RemapResourceBindings(ResourceMap, pPatchedBytecode->GetBufferPointer(), pPatchedBytecode->GetBufferSize()))
-                LOG_ERROR_AND_THROW("Failed to remap resource bindings in shader '", pShader->GetDesc().Name, "'.");
-
+            CComPtr<ID3DBlob> pPatchedBytecode = pShader->GetRemappedBytecode(ResourceMap);
             HandleRemappedBytecodeFn(s, pShader, pPatchedBytecode);
         }
 
@@ -110,6 +110,13 @@ RenderDeviceD3D11Impl::RenderDeviceD3D11Impl(IReferenceCounters*          pRefCo
 
     // Initialize device features
     m_DeviceInfo.Features = EnableDeviceFeatures(m_AdapterInfo.Features, EngineCI.Features);
+
+    if (CComQIPtr<IDXGIDevice> pDXGIDevice{m_pd3d11Device})
+    {
+        CComPtr<IDXGIAdapter> pDXGIAdapter;
+        if (SUCCEEDED(pDXGIDevice->GetAdapter(&pDXGIAdapter)))
+            InitDXGIAdapter(pDXGIAdapter);
+    }
 }
 
 RenderDeviceD3D11Impl::~RenderDeviceD3D11Impl()
@@ -240,6 +247,9 @@ void RenderDeviceD3D11Impl::CreateTexture(const TextureDesc& TexDesc, const Text
     CreateDeviceObject("texture", TexDesc, ppTexture,
                        [&]() //
                        {
+                           if (pData != nullptr && pData->pMemory != nullptr)
+                               LOG_ERROR_AND_THROW("Placed textures are not supported in Direct3D11");
+
                            TextureBaseD3D11* pTextureD3D11 = nullptr;
                            switch (TexDesc.Type)
                            {
@@ -297,6 +307,12 @@ void RenderDeviceD3D11Impl::CreateQuery(const QueryDesc& Desc, IQuery** ppQuery)
     CreateQueryImpl(ppQuery, Desc);
 }
 
+void RenderDeviceD3D11Impl::CreateQueryArray(const QueryArrayDesc& Desc, IQueryArray** ppQueryArray)
+{
+    UNSUPPORTED("CreateQueryArray is not supported in DirectX 11");
+    *ppQueryArray = nullptr;
+}
+
 void RenderDeviceD3D11Impl::CreateRenderPass(const RenderPassDesc& Desc, IRenderPass** ppRenderPass)
 {
     CreateRenderPassImpl(ppRenderPass, Desc);
@@ -28,7 +28,15 @@
 #include "pch.h"
 
 #include "ShaderD3D11Impl.hpp"
+
+#include <algorithm>
+
+#include "WinHPreface.h"
+#include <d3dcompiler.h>
+#include "WinHPostface.h"
+
 #include "RenderDeviceD3D11Impl.hpp"
+#include "DXBCUtils.hpp"
 
 namespace Diligent
 {
@@ -106,13 +114,24 @@ ShaderD3D11Impl::ShaderD3D11Impl(IReferenceCounters*     pRefCounters,
     // Load shader resources
     if ((ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_SKIP_REFLECTION) == 0)
     {
+        const char* CombinedSamplerSuffix = m_Desc.UseCombinedTextureSamplers ? m_Desc.CombinedSamplerSuffix : nullptr;
+
+        // Serialized resources do not contain constant buffer reflection
+        const void* pSerializedResources = nullptr;
+        size_t      SerializedResSize    = 0;
+        if (!ShaderCI.LoadConstantBufferReflection && ShaderCI.ByteCode != nullptr)
+        {
+            const void* pBytecode    = nullptr;
+            size_t      BytecodeSize = 0;
+            if (!UnpackBytecodeWithResources(ShaderCI.ByteCode, ShaderCI.ByteCodeSize, pBytecode, BytecodeSize, pSerializedResources, SerializedResSize))
+                pSerializedResources = nullptr;
+        }
+
         auto& Allocator  = GetRawAllocator();
         auto* pRawMem    = ALLOCATE(Allocator, "Allocator for ShaderResources", ShaderResourcesD3D11, 1);
-        auto* pResources = new (pRawMem) ShaderResourcesD3D11{
-            m_pShaderByteCode,
-            m_Desc,
-            m_Desc.UseCombinedTextureSamplers ? m_Desc.CombinedSamplerSuffix : nullptr,
-            ShaderCI.LoadConstantBufferReflection};
+        auto* pResources = pSerializedResources != nullptr ?
+            new (pRawMem) ShaderResourcesD3D11{pSerializedResources, SerializedResSize, m_Desc, CombinedSamplerSuffix} :
+            new (pRawMem) ShaderResourcesD3D11{m_pShaderByteCode, m_Desc, CombinedSamplerSuffix, ShaderCI.LoadConstantBufferReflection};
         m_pShaderResources.reset(pResources, STDDeleterRawMem<ShaderResourcesD3D11>(Allocator));
     }
 }
@@ -140,6 +159,12 @@ ID3D11DeviceChild* ShaderD3D11Impl::GetD3D11Shader(ID3DBlob* pBlob) noexcept(fal
 {
     std::lock_guard<std::mutex> Lock{m_d3dShaderCacheMtx};
 
+    {
+        auto blob_it = m_d3dShaderByBlob.find(pBlob);
+        if (blob_it != m_d3dShaderByBlob.end())
+            return blob_it->second;
+    }
+
     BlobHashKey BlobKey{pBlob};
 
     auto it = m_d3dShaderCache.find(BlobKey);
@@ -189,7 +214,67 @@ ID3D11DeviceChild* ShaderD3D11Impl::GetD3D11Shader(ID3DBlob* pBlob) noexcept(fal
         DEV_CHECK_ERR(SUCCEEDED(hr), "Failed to set shader name");
     }
 
-    return m_d3dShaderCache.emplace(BlobKey, std::move(pd3d11Shader)).first->second;
+    auto* pShader = m_d3dShaderCache.emplace(BlobKey, std::move(pd3d11Shader)).first->second.p;
+    m_d3dShaderByBlob.emplace(pBlob, pShader);
+    return pShader;
+}
+
+ShaderD3D11Impl::BindingMapKey::BindingMapKey(const ResourceBinding::TMap& ResourceMap)
+{
+    Bindings.reserve(ResourceMap.size());
+    for (const auto& it : ResourceMap)
+        Bindings.emplace_back(it.first.GetStr(), it.second);
+    std::sort(Bindings.begin(), Bindings.end(),
+              [](const std::pair<std::string, ResourceBinding::BindInfo>& lhs, const std::pair<std::string, ResourceBinding::BindInfo>& rhs) {
+                  return lhs.first < rhs.first;
+              });
+
+    for (const auto& Binding : Bindings)
+        HashCombine(Hash, Binding.first, Binding.second.BindPoint, Binding.second.Space, Binding.second.ArraySize);
+}
+
+bool ShaderD3D11Impl::BindingMapKey::operator==(const BindingMapKey& rhs) const noexcept
+{
+    if (Hash != rhs.Hash || Bindings.size() != rhs.Bindings.size())
+        return false;
+
+    for (size_t i = 0; i < Bindings.size(); ++i)
+    {
+        const auto& Binding0 = Bindings[i];
+        const auto& Binding1 = rhs.Bindings[i];
+        if (Binding0.first != Binding1.first ||
+            Binding0.second.BindPoint != Binding1.second.BindPoint ||
+            Binding0.second.Space != Binding1.second.Space ||
+            Binding0.second.ArraySize != Binding1.second.ArraySize)
+            return false;
+    }
+
+    return true;
+}
+
+CComPtr<ID3DBlob> ShaderD3D11Impl::GetRemappedBytecode(const ResourceBinding::TMap& ResourceMap) noexcept(false)
+{
+    BindingMapKey Key{ResourceMap};
+
+    {
+        std::lock_guard<std::mutex> Lock{m_RemappedBytecodeMtx};
+
+        auto it = m_RemappedBytecodeCache.find(Key);
+        if (it != m_RemappedBytecodeCache.end())
+            return it->second;
+    }
+
+    // Patch the byte code outside of the lock
+    CComPtr<ID3DBlob> pRemappedBytecode;
+    D3DCreateBlob(m_pShaderByteCode->GetBufferSize(), &pRemappedBytecode);
+    memcpy(pRemappedBytecode->GetBufferPointer(), m_pShaderByteCode->GetBufferPointer(), m_pShaderByteCode->GetBufferSize());
+
+    if (!DXBCUtils::RemapResourceBindings(ResourceMap, pRemappedBytecode->GetBufferPointer(), pRemappedBytecode->GetBufferSize()))
+        LOG_ERROR_AND_THROW("Failed to remap resource bindings in shader '", m_Desc.Name, "'.");
+
+    std::lock_guard<std::mutex> Lock{m_RemappedBytecodeMtx};
+    // Another thread may have remapped the byte code in the meantime
+    return m_RemappedBytecodeCache.emplace(std::move(Key), std::move(pRemappedBytecode)).first->second;
 }
 
 } // namespace Diligent
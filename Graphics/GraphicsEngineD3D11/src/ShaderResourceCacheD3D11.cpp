@@ -180,10 +180,22 @@ void ShaderResourceCacheD3D11::TransitionResourceStates(DeviceContextD3D11Impl&
 {
     VERIFY_EXPR(IsInitialized());
 
+    if (Mode == StateTransitionMode::Transition && ResourceStatesUpToDate(Ctx.GetResourceStateEpoch()))
+    {
+        // No resource has been bound to the cache and no resource has changed its state since
+        // the last full transition. Unlike other backends, Direct3D11 does not need UAV barriers,
+        // so there is nothing to do.
+        return;
+    }
+
     TransitionResources<Mode>(Ctx, static_cast<ID3D11Buffer*>(nullptr));
     TransitionResources<Mode>(Ctx, static_cast<ID3D11ShaderResourceView*>(nullptr));
     TransitionResources<Mode>(Ctx, static_cast<ID3D11SamplerState*>(nullptr));
     TransitionResources<Mode>(Ctx, static_cast<ID3D11UnorderedAccessView*>(nullptr));
+
+    // Note that the epoch must be read after the transitions as they may change it.
+    if (Mode == StateTransitionMode::Transition)
+        SetResourceStatesUpToDate(Ctx.GetResourceStateEpoch());
 }
 
 template <ShaderResourceCacheD3D11::StateTransitionMode Mode>
@@ -338,6 +350,9 @@ void ShaderResourceCacheD3D11::DbgVerifyDynamicBufferMasks() const
 
             const auto IsDynamicOffset = CB.AllowsDynamicOffset() && (m_DynamicCBSlotsMask[ShaderInd] & BuffBit) != 0;
             VERIFY(IsDynamicOffset == ((m_DynamicCBOffsetsMask[ShaderInd] & BuffBit) != 0), "Bit ", i, " in m_DynamicCBOffsetsMask is not valid");
+
+            const auto IsRingCandidate = CB.pBuff && CB.pBuff->IsDynamicCBRingCandidate();
+            VERIFY(IsRingCandidate == ((m_DynamicCBRingSlotsMask[ShaderInd] & BuffBit) != 0), "Bit ", i, " in m_DynamicCBRingSlotsMask is not valid");
         }
     }
 }
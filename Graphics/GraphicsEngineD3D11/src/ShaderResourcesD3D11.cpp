@@ -43,76 +43,76 @@ static constexpr Uint32 GetRegisterSpace(const D3D11_SHADER_INPUT_BIND_DESC&)
     return 0;
 }
 
+class ShaderResourcesD3D11::NewResourceHandler
+{
+public:
+    NewResourceHandler(const ShaderDesc&     _ShdrDesc,
+                       const char*           _CombinedSamplerSuffix,
+                       ShaderResourcesD3D11& _Resources) :
+        // clang-format off
+        ShdrDesc             {_ShdrDesc             },
+        CombinedSamplerSuffix{_CombinedSamplerSuffix},
+        Resources            {_Resources            }
+    // clang-format on
+    {}
+
+    void OnNewCB(const D3DShaderResourceAttribs& CBAttribs)
+    {
+        VERIFY(CBAttribs.BindPoint + CBAttribs.BindCount - 1 <= MaxAllowedBindPoint, "CB bind point exceeds supported range");
+        Resources.m_MaxCBBindPoint = std::max(Resources.m_MaxCBBindPoint, static_cast<MaxBindPointType>(CBAttribs.BindPoint + CBAttribs.BindCount - 1));
+    }
+
+    void OnNewTexUAV(const D3DShaderResourceAttribs& TexUAV)
+    {
+        VERIFY(TexUAV.BindPoint + TexUAV.BindCount - 1 <= MaxAllowedBindPoint, "Tex UAV bind point exceeds supported range");
+        Resources.m_MaxUAVBindPoint = std::max(Resources.m_MaxUAVBindPoint, static_cast<MaxBindPointType>(TexUAV.BindPoint + TexUAV.BindCount - 1));
+    }
+
+    void OnNewBuffUAV(const D3DShaderResourceAttribs& BuffUAV)
+    {
+        VERIFY(BuffUAV.BindPoint + BuffUAV.BindCount - 1 <= MaxAllowedBindPoint, "Buff UAV bind point exceeds supported range");
+        Resources.m_MaxUAVBindPoint = std::max(Resources.m_MaxUAVBindPoint, static_cast<MaxBindPointType>(BuffUAV.BindPoint + BuffUAV.BindCount - 1));
+    }
+
+    void OnNewBuffSRV(const D3DShaderResourceAttribs& BuffSRV)
+    {
+        VERIFY(BuffSRV.BindPoint + BuffSRV.BindCount - 1 <= MaxAllowedBindPoint, "Buff SRV bind point exceeds supported range");
+        Resources.m_MaxSRVBindPoint = std::max(Resources.m_MaxSRVBindPoint, static_cast<MaxBindPointType>(BuffSRV.BindPoint + BuffSRV.BindCount - 1));
+    }
+
+    void OnNewSampler(const D3DShaderResourceAttribs& SamplerAttribs)
+    {
+        VERIFY(SamplerAttribs.BindPoint + SamplerAttribs.BindCount - 1 <= MaxAllowedBindPoint, "Sampler bind point exceeds supported range");
+        Resources.m_MaxSamplerBindPoint = std::max(Resources.m_MaxSamplerBindPoint, static_cast<MaxBindPointType>(SamplerAttribs.BindPoint + SamplerAttribs.BindCount - 1));
+    }
+
+    void OnNewTexSRV(const D3DShaderResourceAttribs& TexAttribs)
+    {
+        VERIFY(TexAttribs.BindPoint + TexAttribs.BindCount - 1 <= MaxAllowedBindPoint, "Tex SRV bind point exceeds supported range");
+        Resources.m_MaxSRVBindPoint = std::max(Resources.m_MaxSRVBindPoint, static_cast<MaxBindPointType>(TexAttribs.BindPoint + TexAttribs.BindCount - 1));
+    }
+
+    void OnNewAccelStruct(const D3DShaderResourceAttribs& ASAttribs)
+    {
+        UNEXPECTED("Acceleration structure is not supported in DirectX 11");
+    }
+
+    ~NewResourceHandler()
+    {
+    }
+
+private:
+    const ShaderDesc&     ShdrDesc;
+    const char*           CombinedSamplerSuffix;
+    ShaderResourcesD3D11& Resources;
+};
+
 ShaderResourcesD3D11::ShaderResourcesD3D11(ID3DBlob*         pShaderBytecode,
                                            const ShaderDesc& ShdrDesc,
                                            const char*       CombinedSamplerSuffix,
                                            bool              LoadConstantBufferReflection) :
     ShaderResources{ShdrDesc.ShaderType}
 {
-    class NewResourceHandler
-    {
-    public:
-        NewResourceHandler(const ShaderDesc&     _ShdrDesc,
-                           const char*           _CombinedSamplerSuffix,
-                           ShaderResourcesD3D11& _Resources) :
-            // clang-format off
-            ShdrDesc             {_ShdrDesc             },
-            CombinedSamplerSuffix{_CombinedSamplerSuffix},
-            Resources            {_Resources            }
-        // clang-format on
-        {}
-
-        void OnNewCB(const D3DShaderResourceAttribs& CBAttribs)
-        {
-            VERIFY(CBAttribs.BindPoint + CBAttribs.BindCount - 1 <= MaxAllowedBindPoint, "CB bind point exceeds supported range");
-            Resources.m_MaxCBBindPoint = std::max(Resources.m_MaxCBBindPoint, static_cast<MaxBindPointType>(CBAttribs.BindPoint + CBAttribs.BindCount - 1));
-        }
-
-        void OnNewTexUAV(const D3DShaderResourceAttribs& TexUAV)
-        {
-            VERIFY(TexUAV.BindPoint + TexUAV.BindCount - 1 <= MaxAllowedBindPoint, "Tex UAV bind point exceeds supported range");
-            Resources.m_MaxUAVBindPoint = std::max(Resources.m_MaxUAVBindPoint, static_cast<MaxBindPointType>(TexUAV.BindPoint + TexUAV.BindCount - 1));
-        }
-
-        void OnNewBuffUAV(const D3DShaderResourceAttribs& BuffUAV)
-        {
-            VERIFY(BuffUAV.BindPoint + BuffUAV.BindCount - 1 <= MaxAllowedBindPoint, "Buff UAV bind point exceeds supported range");
-            Resources.m_MaxUAVBindPoint = std::max(Resources.m_MaxUAVBindPoint, static_cast<MaxBindPointType>(BuffUAV.BindPoint + BuffUAV.BindCount - 1));
-        }
-
-        void OnNewBuffSRV(const D3DShaderResourceAttribs& BuffSRV)
-        {
-            VERIFY(BuffSRV.BindPoint + BuffSRV.BindCount - 1 <= MaxAllowedBindPoint, "Buff SRV bind point exceeds supported range");
-            Resources.m_MaxSRVBindPoint = std::max(Resources.m_MaxSRVBindPoint, static_cast<MaxBindPointType>(BuffSRV.BindPoint + BuffSRV.BindCount - 1));
-        }
-
-        void OnNewSampler(const D3DShaderResourceAttribs& SamplerAttribs)
-        {
-            VERIFY(SamplerAttribs.BindPoint + SamplerAttribs.BindCount - 1 <= MaxAllowedBindPoint, "Sampler bind point exceeds supported range");
-            Resources.m_MaxSamplerBindPoint = std::max(Resources.m_MaxSamplerBindPoint, static_cast<MaxBindPointType>(SamplerAttribs.BindPoint + SamplerAttribs.BindCount - 1));
-        }
-
-        void OnNewTexSRV(const D3DShaderResourceAttribs& TexAttribs)
-        {
-            VERIFY(TexAttribs.BindPoint + TexAttribs.BindCount - 1 <= MaxAllowedBindPoint, "Tex SRV bind point exceeds supported range");
-            Resources.m_MaxSRVBindPoint = std::max(Resources.m_MaxSRVBindPoint, static_cast<MaxBindPointType>(TexAttribs.BindPoint + TexAttribs.BindCount - 1));
-        }
-
-        void OnNewAccelStruct(const D3DShaderResourceAttribs& ASAttribs)
-        {
-            UNEXPECTED("Acceleration structure is not supported in DirectX 11");
-        }
-
-        ~NewResourceHandler()
-        {
-        }
-
-    private:
-        const ShaderDesc&     ShdrDesc;
-        const char*           CombinedSamplerSuffix;
-        ShaderResourcesD3D11& Resources;
-    };
-
     CComPtr<ID3D11ShaderReflection> pShaderReflection;
     HRESULT                         hr = D3DReflect(pShaderBytecode->GetBufferPointer(), pShaderBytecode->GetBufferSize(), __uuidof(pShaderReflection), reinterpret_cast<void**>(&pShaderReflection));
     CHECK_D3D_RESULT_THROW(hr, "Failed to get the shader reflection");
@@ -134,6 +134,16 @@ ShaderResourcesD3D11::ShaderResourcesD3D11(ID3DBlob*         pShaderBytecode,
         LoadConstantBufferReflection);
 }
 
+ShaderResourcesD3D11::ShaderResourcesD3D11(const void*       pSerializedData,
+                                           size_t            DataSize,
+                                           const ShaderDesc& ShdrDesc,
+                                           const char*       CombinedSamplerSuffix) :
+    ShaderResources{ShdrDesc.ShaderType}
+{
+    Serializer<SerializerMode::Read> Ser{SerializedData{const_cast<void*>(pSerializedData), DataSize}};
+    Initialize(Ser, NewResourceHandler{ShdrDesc, CombinedSamplerSuffix, *this}, ShdrDesc.Name, CombinedSamplerSuffix);
+}
+
 
 ShaderResourcesD3D11::~ShaderResourcesD3D11()
 {
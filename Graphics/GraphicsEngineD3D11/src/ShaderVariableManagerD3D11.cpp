@@ -525,44 +525,36 @@ void ShaderVariableManagerD3D11::BindResources(IResourceMapping* pResourceMappin
 }
 
 template <typename ResourceType>
-IShaderResourceVariable* ShaderVariableManagerD3D11::GetResourceByName(const Char* Name) const
+IShaderResourceVariable* ShaderVariableManagerD3D11::GetResourceByResIndex(Uint32 ResIndex) const
 {
-    auto NumResources = GetNumResources<ResourceType>();
-    for (Uint32 res = 0; res < NumResources; ++res)
-    {
-        auto& Resource = GetResource<ResourceType>(res);
-        if (strcmp(Resource.GetDesc().Name, Name) == 0)
-            return &Resource;
-    }
-
-    return nullptr;
+    const auto NumResources = GetNumResources<ResourceType>();
+    return NumResources > 0 ?
+        FindVariableByResIndex(&GetResource<ResourceType>(0), NumResources, ResIndex) :
+        nullptr;
 }
 
-IShaderResourceVariable* ShaderVariableManagerD3D11::GetVariable(const Char* Name) const
+IShaderResourceVariable* ShaderVariableManagerD3D11::GetVariable(SHADER_TYPE ShaderType, const Char* Name) const
 {
-    if (auto* pCB = GetResourceByName<ConstBuffBindInfo>(Name))
-        return pCB;
+    const auto ResIndex = m_pSignature->FindResource(ShaderType, Name);
+    if (ResIndex == InvalidPipelineResourceIndex)
+        return nullptr;
 
-    if (auto* pTexSRV = GetResourceByName<TexSRVBindInfo>(Name))
-        return pTexSRV;
-
-    if (auto* pTexUAV = GetResourceByName<TexUAVBindInfo>(Name))
-        return pTexUAV;
-
-    if (auto* pBuffSRV = GetResourceByName<BuffSRVBindInfo>(Name))
-        return pBuffSRV;
-
-    if (auto* pBuffUAV = GetResourceByName<BuffUAVBindInfo>(Name))
-        return pBuffUAV;
-
-    if (!m_pSignature->IsUsingCombinedSamplers())
+    // Combined and immutable samplers are never initialized as variables and will not be found
+    static_assert(SHADER_RESOURCE_TYPE_LAST == 8, "Please update the switch below to handle the new shader resource type");
+    switch (GetResourceDesc(ResIndex).ResourceType)
     {
-        // Immutable samplers are never initialized as variables
-        if (auto* pSampler = GetResourceByName<SamplerBindInfo>(Name))
-            return pSampler;
+        // clang-format off
+        case SHADER_RESOURCE_TYPE_CONSTANT_BUFFER:  return GetResourceByResIndex<ConstBuffBindInfo>(ResIndex);
+        case SHADER_RESOURCE_TYPE_TEXTURE_SRV:      return GetResourceByResIndex<TexSRVBindInfo>   (ResIndex);
+        case SHADER_RESOURCE_TYPE_BUFFER_SRV:       return GetResourceByResIndex<BuffSRVBindInfo>  (ResIndex);
+        case SHADER_RESOURCE_TYPE_TEXTURE_UAV:      return GetResourceByResIndex<TexUAVBindInfo>   (ResIndex);
+        case SHADER_RESOURCE_TYPE_BUFFER_UAV:       return GetResourceByResIndex<BuffUAVBindInfo>  (ResIndex);
+        case SHADER_RESOURCE_TYPE_SAMPLER:          return GetResourceByResIndex<SamplerBindInfo>  (ResIndex);
+        case SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT: return GetResourceByResIndex<TexSRVBindInfo>   (ResIndex);
+        // clang-format on
+        default:
+            return nullptr;
     }
-
-    return nullptr;
 }
 
 class ShaderVariableIndexLocator
@@ -43,6 +43,9 @@ namespace Diligent
 
 class DeviceContextD3D12Impl;
 
+/// Converts buffer description to D3D12 resource description.
+D3D12_RESOURCE_DESC BufferDescToD3D12ResourceDesc(const BufferDesc& BuffDesc);
+
 /// Buffer object implementation in Direct3D12 backend.
 class BufferD3D12Impl final : public BufferBase<EngineD3D12ImplTraits>, public D3D12ResourceBase
 {
@@ -127,6 +130,9 @@ private:
 
     DescriptorHeapAllocation m_CBVDescriptorAllocation;
 
+    // Device memory the buffer is placed in, see BufferData::pMemory.
+    RefCntAutoPtr<IDeviceMemory> m_pMemory;
+
     // Align the struct size to the cache line size to avoid false sharing
     static constexpr size_t CacheLineSize = 64;
     struct alignas(CacheLineSize) CtxDynamicData : D3D12DynamicAllocation
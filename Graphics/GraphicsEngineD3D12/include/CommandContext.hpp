@@ -29,6 +29,7 @@
 #pragma once
 
 #include <vector>
+#include <utility>
 
 #include "DeviceContext.h"
 #include "D3D12ResourceBase.hpp"
@@ -140,9 +141,14 @@ public:
     {
         if (!m_PendingResourceBarriers.empty())
         {
+            DEV_CHECK_ERR(GetCommandListType() != D3D12_COMMAND_LIST_TYPE_BUNDLE, "Resource barriers are not allowed in bundles. Use RESOURCE_STATE_TRANSITION_MODE_VERIFY "
+                                                                                  "and transition resources in the context that executes the bundle.");
             m_pCommandList->ResourceBarrier(static_cast<UINT>(m_PendingResourceBarriers.size()), m_PendingResourceBarriers.data());
             m_PendingResourceBarriers.clear();
         }
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+        FlushEnhancedBarriers();
+#endif
     }
 
 
@@ -172,6 +178,19 @@ public:
     };
     void SetDescriptorHeaps(ShaderDescriptorHeaps Heaps);
 
+    // Executes the bundle in this command list. The pipeline state, root signatures and primitive topology
+    // set by the bundle persist in the command list, so the cached states are reset.
+    void ExecuteBundle(ID3D12GraphicsCommandList* pBundle)
+    {
+        FlushResourceBarriers();
+        m_pCommandList->ExecuteBundle(pBundle);
+
+        m_pCurPipelineState         = nullptr;
+        m_pCurGraphicsRootSignature = nullptr;
+        m_pCurComputeRootSignature  = nullptr;
+        m_PrimitiveTopology         = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+    }
+
     void ExecuteIndirect(ID3D12CommandSignature* pCmdSignature, Uint32 MaxCommandCount, ID3D12Resource* pArgsBuff, Uint64 ArgsOffset, ID3D12Resource* pCountBuff = nullptr, Uint64 CountOffset = 0)
     {
         FlushResourceBarriers();
@@ -189,10 +208,25 @@ public:
         return m_DynamicGPUDescriptorAllocators[Type].Allocate(Count);
     }
 
-    void ResourceBarrier(const D3D12_RESOURCE_BARRIER& Barrier)
-    {
-        m_PendingResourceBarriers.emplace_back(Barrier);
-    }
+    // Adds the barrier to the list of pending barriers that are submitted by a single
+    // ResourceBarrier call before the next command that requires them.
+    // Transitions of the same subresource that follow each other are merged into one
+    // and duplicate UAV barriers are skipped.
+    void ResourceBarrier(const D3D12_RESOURCE_BARRIER& Barrier);
+
+    // Returns the number of barriers recorded since the last call and resets the counter.
+    Uint32 ExtractBarrierCount() { return std::exchange(m_BarrierCount, 0u); }
+
+    // Returns true if resource state transitions are performed with enhanced barriers
+    // (ID3D12GraphicsCommandList7::Barrier) rather than legacy resource barriers.
+    bool UseEnhancedBarriers() const { return m_UseEnhancedBarriers; }
+
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    // Add the barrier to the list of pending enhanced barriers. Legacy and enhanced barriers
+    // are submitted in the order they were added.
+    void TextureBarrier(const D3D12_TEXTURE_BARRIER& Barrier);
+    void BufferBarrier(const D3D12_BUFFER_BARRIER& Barrier);
+#endif
 
     void SetPipelineState(ID3D12PipelineState* pPSO)
     {
@@ -228,6 +262,11 @@ public:
         m_pCommandList->ResolveQueryData(pQueryHeap, Type, StartIndex, NumQueries, pDestinationBuffer, AlignedDestinationBufferOffset);
     }
 
+    void SetPredication(ID3D12Resource* pBuffer, UINT64 AlignedBufferOffset, D3D12_PREDICATION_OP Operation)
+    {
+        m_pCommandList->SetPredication(pBuffer, AlignedBufferOffset, Operation);
+    }
+
     void DiscardResource(ID3D12Resource* pResource, const D3D12_DISCARD_REGION* pRegion)
     {
         m_pCommandList->DiscardResource(pResource, pRegion);
@@ -252,6 +291,15 @@ public:
 protected:
     void InsertAliasBarrier(D3D12ResourceBase& Before, D3D12ResourceBase& After, bool FlushImmediate = false);
 
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    void FlushEnhancedBarriers()
+    {
+        if (!m_PendingTextureBarriers.empty() || !m_PendingBufferBarriers.empty())
+            SubmitEnhancedBarriers();
+    }
+    void SubmitEnhancedBarriers();
+#endif
+
     CComPtr<ID3D12GraphicsCommandList> m_pCommandList;
     CComPtr<ID3D12CommandAllocator>    m_pCurrentAllocator;
 
@@ -260,6 +308,10 @@ protected:
     ID3D12RootSignature* m_pCurComputeRootSignature  = nullptr;
 
     std::vector<D3D12_RESOURCE_BARRIER, STDAllocatorRawMem<D3D12_RESOURCE_BARRIER>> m_PendingResourceBarriers;
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    std::vector<D3D12_TEXTURE_BARRIER, STDAllocatorRawMem<D3D12_TEXTURE_BARRIER>> m_PendingTextureBarriers;
+    std::vector<D3D12_BUFFER_BARRIER, STDAllocatorRawMem<D3D12_BUFFER_BARRIER>>   m_PendingBufferBarriers;
+#endif
 
     ShaderDescriptorHeaps m_BoundDescriptorHeaps;
 
@@ -270,6 +322,11 @@ protected:
     D3D12_PRIMITIVE_TOPOLOGY m_PrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
 
     Uint32 m_MaxInterfaceVer = 0;
+
+    // The number of barriers recorded into the command list, see ExtractBarrierCount().
+    Uint32 m_BarrierCount = 0;
+
+    bool m_UseEnhancedBarriers = false;
 };
 
 class ComputeContext : public CommandContext
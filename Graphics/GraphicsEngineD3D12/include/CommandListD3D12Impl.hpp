@@ -54,15 +54,29 @@ public:
             pDeferredCtx
         },
         m_pDeferredCtx{pDeferredCtx          },
-        m_pCmdContext {std::move(pCmdContext)}
+        m_pCmdContext {std::move(pCmdContext)},
+        m_CmdQueueId  {pDeferredCtx->GetCommandQueueId()},
+        m_IsBundle    {m_pCmdContext->GetCommandListType() == D3D12_COMMAND_LIST_TYPE_BUNDLE}
     // clang-format on
     {
         VERIFY_EXPR(m_pCmdContext);
+        if (IsReusable())
+        {
+            // Reusable command lists are closed once and are never reset while the object is alive,
+            // so that the same ID3D12CommandList can be submitted any number of times.
+            m_pd3d12ClosedCmdList = m_pCmdContext->Close(m_pCmdAllocator);
+        }
     }
 
     ~CommandListD3D12Impl()
     {
-        if (m_pCmdContext != nullptr)
+        if (IsReusable())
+        {
+            // The command list may still be executed by the GPU, so the allocator
+            // can only be reset after the last submission has completed.
+            m_pDevice->DisposeClosedCommandContext(std::move(m_pCmdContext), std::move(m_pCmdAllocator), m_CmdQueueId, m_LastSubmittedFenceValue);
+        }
+        else if (m_pCmdContext != nullptr)
         {
             LOG_WARNING_MESSAGE("Destroying command list that has not been executed");
             m_pDevice->DisposeCommandContext(std::move(m_pCmdContext));
@@ -75,13 +89,43 @@ public:
 
     RenderDeviceD3D12Impl::PooledCommandContext Close(RefCntAutoPtr<DeviceContextD3D12Impl>& pDeferredCtx)
     {
+        VERIFY(!IsReusable(), "Reusable command lists must not be closed");
         pDeferredCtx = std::move(m_pDeferredCtx);
         return std::move(m_pCmdContext);
     }
 
+    /// Returns the closed D3D12 command list of a reusable command list.
+    ID3D12GraphicsCommandList* GetClosedD3D12CommandList() const
+    {
+        VERIFY(IsReusable(), "Only reusable command lists are closed at creation time");
+        return m_pd3d12ClosedCmdList;
+    }
+
+    DeviceContextD3D12Impl* GetDeferredContext() const { return m_pDeferredCtx; }
+
+    /// Returns true if the command list is a bundle recorded with IDeviceContextD3D12::BeginBundle().
+    bool IsBundle() const { return m_IsBundle; }
+
+    /// Records the fence value of the latest submission of a reusable command list.
+    void SetLastSubmittedFenceValue(SoftwareQueueIndex CmdQueueId, Uint64 FenceValue)
+    {
+        VERIFY(IsReusable(), "Only reusable command lists may be submitted multiple times");
+        DEV_CHECK_ERR(CmdQueueId == m_CmdQueueId, "Reusable command list recorded for command queue ", Uint32{m_CmdQueueId},
+                      " is executed in command queue ", Uint32{CmdQueueId});
+        m_LastSubmittedFenceValue = FenceValue;
+    }
+
 private:
     RefCntAutoPtr<DeviceContextD3D12Impl>       m_pDeferredCtx;
     RenderDeviceD3D12Impl::PooledCommandContext m_pCmdContext;
+
+    const SoftwareQueueIndex m_CmdQueueId;
+    const bool               m_IsBundle;
+
+    // Reusable command lists only
+    CComPtr<ID3D12CommandAllocator> m_pCmdAllocator;
+    ID3D12GraphicsCommandList*      m_pd3d12ClosedCmdList     = nullptr;
+    Uint64                          m_LastSubmittedFenceValue = 0;
 };
 
 } // namespace Diligent
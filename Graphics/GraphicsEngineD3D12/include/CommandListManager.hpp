@@ -73,6 +73,11 @@ public:
         return m_CmdListType;
     }
 
+    RenderDeviceD3D12Impl& GetDevice() const
+    {
+        return m_DeviceD3D12Impl;
+    }
+
 private:
     std::mutex                                                                                        m_AllocatorMutex;
     std::vector<CComPtr<ID3D12CommandAllocator>, STDAllocatorRawMem<CComPtr<ID3D12CommandAllocator>>> m_FreeAllocators;
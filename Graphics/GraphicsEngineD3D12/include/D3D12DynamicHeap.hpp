@@ -32,10 +32,13 @@
 #include <deque>
 #include <atomic>
 
+#include "AdaptiveLock.hpp"
+
 namespace Diligent
 {
 
 class RenderDeviceD3D12Impl;
+struct DynamicHeapStatsD3D12;
 
 struct D3D12DynamicAllocation
 {
@@ -122,10 +125,13 @@ private:
 class D3D12DynamicMemoryManager
 {
 public:
+    // ShrinkInterval is the number of frames after which the pages that were not needed
+    // during these frames are released, see EngineD3D12CreateInfo::DynamicHeapShrinkInterval.
     D3D12DynamicMemoryManager(IMemoryAllocator&      Allocator,
                               RenderDeviceD3D12Impl& DeviceD3D12Impl,
                               Uint32                 NumPagesToReserve,
-                              Uint64                 PageSize);
+                              Uint64                 PageSize,
+                              Uint32                 ShrinkInterval = 0);
     ~D3D12DynamicMemoryManager();
 
     // clang-format off
@@ -141,6 +147,12 @@ public:
 
     D3D12DynamicPage AllocatePage(Uint64 SizeInBytes);
 
+    // Updates the per-frame high-water mark and releases the pages that have not been needed
+    // for the last ShrinkInterval frames. Called once per frame by the immediate context.
+    void EndFrame();
+
+    void GetStats(DynamicHeapStatsD3D12& Stats);
+
 #ifdef DILIGENT_DEVELOPMENT
     Int32 GetAllocatedPageCounter() const
     {
@@ -151,10 +163,30 @@ public:
 private:
     RenderDeviceD3D12Impl& m_DeviceD3D12Impl;
 
-    std::mutex m_AvailablePagesMtx;
+    Threading::EngineMutex m_AvailablePagesMtx;
     using AvailablePagesMapElemType = std::pair<const Uint64, D3D12DynamicPage>;
     std::multimap<Uint64, D3D12DynamicPage, std::less<Uint64>, STDAllocatorRawMem<AvailablePagesMapElemType>> m_AvailablePages;
 
+    // All members below are protected by m_AvailablePagesMtx
+    const Uint64 m_ReservedSize;
+    const Uint32 m_ShrinkInterval;
+
+    // The total size of the pages in m_AvailablePages
+    Uint64 m_AvailableSize = 0;
+    // The total size of the pages handed out to dynamic heaps, including the pages
+    // that are waiting in release queues
+    Uint64 m_UsedSize          = 0;
+    Uint64 m_PeakUsedSize      = 0;
+    Uint64 m_FramePeakUsedSize = 0;
+    Uint64 m_LastFramePeakSize = 0;
+
+    // The peak used size over the current shrink interval
+    Uint64 m_IntervalPeakUsedSize = 0;
+    Uint32 m_IntervalFrameCount   = 0;
+
+    Uint32 m_GrowCount   = 0;
+    Uint32 m_ShrinkCount = 0;
+
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic<Int32> m_AllocatedPageCounter = 0;
 #endif
@@ -185,6 +217,8 @@ public:
     static constexpr Uint64 InvalidOffset = static_cast<Uint64>(-1);
 
     size_t GetAllocatedPagesCount() const { return m_AllocatedPages.size(); }
+    Uint64 GetCurrUsedSize() const { return m_CurrUsedSize; }
+    Uint64 GetPageSize() const { return m_PageSize; }
 
 private:
     D3D12DynamicMemoryManager& m_GlobalDynamicMemMgr;
@@ -0,0 +1,114 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::D3D12ResidencyManager class
+
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+
+#include "D3D12ResourceBase.hpp"
+
+namespace Diligent
+{
+
+/// Manages the residency of committed textures and buffers, see EngineD3D12CreateInfo::EnableResidencyManagement.
+
+/// Device contexts mark every resource they use with MarkUsed(). When the first immediate context
+/// finishes a frame and the local memory usage exceeds the budget threshold, EndFrame() evicts the
+/// least recently used resources that have not been used for the eviction latency. An evicted resource
+/// is made resident again by MarkUsed() before the command list that uses it is submitted.
+class D3D12ResidencyManager
+{
+public:
+    D3D12ResidencyManager(ID3D12Device* pd3d12Device, Uint32 EvictionLatency);
+
+    // clang-format off
+    D3D12ResidencyManager           (const D3D12ResidencyManager&)  = delete;
+    D3D12ResidencyManager           (      D3D12ResidencyManager&&) = delete;
+    D3D12ResidencyManager& operator=(const D3D12ResidencyManager&)  = delete;
+    D3D12ResidencyManager& operator=(      D3D12ResidencyManager&&) = delete;
+    // clang-format on
+
+    /// Starts managing the residency of the resource. The resource must have been created
+    /// as a committed resource in the default heap.
+    void RegisterResource(D3D12ResourceBase& Resource);
+
+    /// Stops managing the residency of the resource. Must be called before the resource is destroyed.
+    void UnregisterResource(D3D12ResourceBase& Resource);
+
+    /// Marks the resource as used by the commands that are being recorded.
+    /// If the resource has been evicted, makes it resident.
+    ///
+    /// \remarks    This method is thread-safe.
+    void MarkUsed(D3D12ResourceBase& Resource)
+    {
+        auto& Residency = Resource.m_Residency;
+        if (Residency.Size == 0)
+            return;
+
+        // The store must be visible to EndFrame() before IsEvicted is read, so that
+        // the resource is either not evicted or is made resident below.
+        Residency.LastUsedFrame.store(m_FrameNumber.load());
+        if (Residency.IsEvicted.load())
+            MakeResident(Resource);
+    }
+
+    /// Finishes the frame and, if the local memory usage exceeds the threshold fraction of
+    /// the budget, evicts the least recently used resources until the usage falls below it.
+    void EndFrame(const MemoryHeapBudget& LocalBudget, float Threshold);
+
+    /// Sets the high residency priority for the resource, so that the OS evicts it after resources with the normal priority.
+    /// Does nothing if ID3D12Device1 is not supported.
+    static void SetHighResidencyPriority(ID3D12Device* pd3d12Device, ID3D12Resource* pd3d12Resource);
+
+    /// Returns the total size of the evicted resources.
+    Uint64 GetEvictedSize() const { return m_EvictedSize.load(); }
+
+private:
+    void MakeResident(D3D12ResourceBase& Resource);
+
+private:
+    CComPtr<ID3D12Device> m_pd3d12Device;
+
+    const Uint32 m_EvictionLatency;
+
+    // The number of the current frame. Resources are marked with it when they are used.
+    std::atomic<Uint64> m_FrameNumber;
+
+    std::atomic<Uint64> m_EvictedSize{0};
+
+    // Protects m_Resources and serializes eviction and making resources resident.
+    std::mutex m_Mtx;
+
+    std::unordered_set<D3D12ResourceBase*> m_Resources;
+};
+
+} // namespace Diligent
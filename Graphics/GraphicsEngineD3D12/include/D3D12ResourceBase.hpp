@@ -30,6 +30,8 @@
 /// \file
 /// Implementation of the Diligent::D3D12ResourceBase class
 
+#include <atomic>
+
 namespace Diligent
 {
 
@@ -44,6 +46,23 @@ public:
 
 protected:
     CComPtr<ID3D12Resource> m_pd3d12Resource; ///< D3D12 resource object
+
+private:
+    friend class D3D12ResidencyManager;
+
+    /// Residency state of the resource that is managed by D3D12ResidencyManager.
+    struct ResidencyState
+    {
+        /// The size of the resource allocation. Zero if the residency of the resource is not managed.
+        Uint64 Size = 0;
+
+        /// The frame in which the resource was last used, see D3D12ResidencyManager::MarkUsed().
+        std::atomic<Uint64> LastUsedFrame{0};
+
+        /// Whether the resource has been evicted.
+        std::atomic<bool> IsEvicted{false};
+    };
+    ResidencyState m_Residency;
 };
 
 } // namespace Diligent
@@ -81,6 +81,12 @@ D3D12_RESOURCE_STATES     ResourceStateFlagsToD3D12ResourceStates(RESOURCE_STATE
 RESOURCE_STATE            D3D12ResourceStatesToResourceStateFlags(D3D12_RESOURCE_STATES StateFlags);
 D3D12_RESOURCE_STATES     GetSupportedD3D12ResourceStatesForCommandList(D3D12_COMMAND_LIST_TYPE CmdListType);
 
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+D3D12_BARRIER_LAYOUT ResourceStateFlagsToD3D12BarrierLayout(RESOURCE_STATE StateFlags, D3D12_COMMAND_LIST_TYPE CmdListType);
+D3D12_BARRIER_ACCESS ResourceStateFlagsToD3D12BarrierAccess(RESOURCE_STATE StateFlags, D3D12_COMMAND_LIST_TYPE CmdListType);
+D3D12_BARRIER_SYNC   ResourceStateFlagsToD3D12BarrierSync(RESOURCE_STATE StateFlags, D3D12_COMMAND_LIST_TYPE CmdListType);
+#endif
+
 D3D12_QUERY_HEAP_TYPE QueryTypeToD3D12QueryHeapType(QUERY_TYPE QueryType, HardwareQueueIndex QueueId);
 D3D12_QUERY_TYPE      QueryTypeToD3D12QueryType(QUERY_TYPE QueryType);
 
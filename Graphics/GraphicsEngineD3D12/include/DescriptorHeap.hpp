@@ -36,8 +36,10 @@
 #include <string>
 #include <unordered_set>
 #include <atomic>
+#include <array>
 
 #include "VariableSizeAllocationsManager.hpp"
+#include "SpinLock.hpp"
 
 namespace Diligent
 {
@@ -45,6 +47,8 @@ namespace Diligent
 class DescriptorHeapAllocation;
 class DescriptorHeapAllocationManager;
 class RenderDeviceD3D12Impl;
+class ShaderResourceCacheD3D12;
+struct GPUDescriptorHeapStatsD3D12;
 
 class IDescriptorAllocator
 {
@@ -317,6 +321,15 @@ public:
     size_t GetMaxAllocatedSize()       const { return m_MaxAllocatedSize;               }
     // clang-format on
 
+    struct UsageStats
+    {
+        Uint32 UsedSize         = 0;
+        Uint32 PeakUsedSize     = 0;
+        Uint32 NumFreeBlocks    = 0;
+        Uint32 MaxFreeBlockSize = 0;
+    };
+    UsageStats GetUsageStats();
+
 #ifdef DILIGENT_DEVELOPMENT
     Int32 DvpGetAllocationsCounter() const
     {
@@ -386,6 +399,15 @@ private:
 // Render device contains four CPUDescriptorHeap object instances (one for each D3D12 heap type). The heaps are accessed
 // when a texture or a buffer view is created.
 //
+// Single-descriptor allocations, which are by far the most common, are served from per-thread caches.
+// A cache is refilled from the pool of managers and trimmed back to it in chunks of CacheChunkSize
+// descriptors, so that threads creating views concurrently do not serialize on m_HeapPoolMutex:
+//
+//   m_ThreadCaches[0]  | X X X |     <- thread 0
+//   m_ThreadCaches[1]  | X |         <- thread 1
+//         ...                              \
+//                                           m_HeapPoolMutex -> m_HeapPool
+//
 class CPUDescriptorHeap final : public IDescriptorAllocator
 {
 public:
@@ -416,9 +438,43 @@ public:
 private:
     void FreeAllocation(DescriptorHeapAllocation&& Allocation);
 
+    // Allocates descriptors from the pool of heap managers. m_HeapPoolMutex must be locked.
+    DescriptorHeapAllocation AllocateFromPool(uint32_t Count);
+    // Returns descriptors to the pool of heap managers. m_HeapPoolMutex must be locked.
+    void FreeToPool(DescriptorHeapAllocation&& Allocation);
+
+    DescriptorHeapAllocation AllocateCached();
+    void                     FreeCached(DescriptorHeapAllocation&& Allocation);
+
+    void UpdateCurrentSize(Int32 Delta);
+
+    // Single descriptor that is allocated from a heap manager and is kept in a thread cache
+    struct CachedDescriptor
+    {
+        D3D12_CPU_DESCRIPTOR_HANDLE CpuHandle  = {0};
+        D3D12_GPU_DESCRIPTOR_HANDLE GpuHandle  = {0};
+        ID3D12DescriptorHeap*       pd3d12Heap = nullptr;
+        Uint16                      ManagerId  = 0;
+    };
+    CachedDescriptor         ExtractCachedDescriptor(DescriptorHeapAllocation&& Allocation);
+    DescriptorHeapAllocation MakeAllocation(const CachedDescriptor& Descriptor);
+
+    struct ThreadCache
+    {
+        Threading::SpinLock           Lock;
+        std::vector<CachedDescriptor> Descriptors;
+    };
+    ThreadCache& GetThreadCache();
+
+    static constexpr size_t NumThreadCaches      = 16;
+    static constexpr Uint32 CacheChunkSize       = 32;
+    static constexpr Uint32 MaxCachedDescriptors = CacheChunkSize * 2;
+
     IMemoryAllocator&      m_MemAllocator;
     RenderDeviceD3D12Impl& m_DeviceD3D12Impl;
 
+    std::array<ThreadCache, NumThreadCaches> m_ThreadCaches;
+
     // Pool of descriptor heap managers
     std::mutex                                                                                        m_HeapPoolMutex;
     std::vector<DescriptorHeapAllocationManager, STDAllocatorRawMem<DescriptorHeapAllocationManager>> m_HeapPool;
@@ -428,9 +484,10 @@ private:
     D3D12_DESCRIPTOR_HEAP_DESC m_HeapDesc;
     const UINT                 m_DescriptorSize = 0;
 
-    // Maximum heap size during the application lifetime - for statistic purposes
-    Uint32 m_MaxSize     = 0;
-    Uint32 m_CurrentSize = 0;
+    // Maximum heap size during the application lifetime - for statistic purposes.
+    // Descriptors in the thread caches are not counted.
+    std::atomic<Uint32> m_MaxSize{0};
+    std::atomic<Uint32> m_CurrentSize{0};
 };
 
 // GPU descriptor heap provides storage for shader-visible descriptors
@@ -505,9 +562,21 @@ public:
     }
 
     const D3D12_DESCRIPTOR_HEAP_DESC& GetHeapDesc() const { return m_HeapDesc; }
+    ID3D12DescriptorHeap*             GetD3D12DescriptorHeap() const { return m_pd3d12DescriptorHeap; }
     Uint32                            GetMaxStaticDescriptors() const { return m_HeapAllocationManager.GetMaxDescriptors(); }
     Uint32                            GetMaxDynamicDescriptors() const { return m_DynamicAllocationsManager.GetMaxDescriptors(); }
 
+    void GetStats(GPUDescriptorHeapStatsD3D12& Stats);
+
+    // Registers the SRB resource cache whose static/mutable descriptor tables
+    // are allocated in this heap and may be relocated by Compact().
+    void RegisterRelocatableCache(ShaderResourceCacheD3D12& Cache);
+    void UnregisterRelocatableCache(ShaderResourceCacheD3D12& Cache);
+
+    // Moves descriptor tables of the registered caches closer to the start of the
+    // static/mutable part of the heap. Returns the number of relocated descriptors.
+    Uint32 Compact(Uint32 MaxDescriptorsToMove);
+
 #ifdef DILIGENT_DEVELOPMENT
     int32_t DvpGetTotalAllocationCount() const
     {
@@ -529,6 +598,11 @@ protected:
 
     // Allocation manager for dynamic part
     DescriptorHeapAllocationManager m_DynamicAllocationsManager;
+
+    // SRB resource caches that own static/mutable descriptor tables in this heap
+    std::mutex m_RelocatableCachesMtx;
+    std::unordered_set<ShaderResourceCacheD3D12*, std::hash<ShaderResourceCacheD3D12*>, std::equal_to<ShaderResourceCacheD3D12*>, STDAllocatorRawMem<ShaderResourceCacheD3D12*>>
+        m_RelocatableCaches;
 };
 
 
@@ -572,6 +646,7 @@ public:
     virtual Uint32 GetDescriptorSize() const override final { return m_ParentGPUHeap.GetDescriptorSize(); }
 
     size_t GetSuballocationCount() const { return m_Suballocations.size(); }
+    Uint32 GetCurrDescriptorCount() const { return m_CurrDescriptorCount; }
 
 private:
     // Parent GPU descriptor heap that is used to allocate chunks
@@ -30,6 +30,7 @@
 /// \file
 /// Declaration of Diligent::DeviceContextD3D12Impl class
 
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -72,6 +73,9 @@ public:
     /// Implementation of IDeviceContext::Begin() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE Begin(Uint32 ImmediateContextId) override final;
 
+    /// Implementation of IDeviceContext::BeginReusable() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE BeginReusable(Uint32 ImmediateContextId) override final;
+
     /// Implementation of IDeviceContext::SetPipelineState() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE SetPipelineState(IPipelineState* pPipelineState) override final;
 
@@ -142,6 +146,10 @@ public:
     virtual void DILIGENT_CALL_TYPE DrawMesh           (const DrawMeshAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawMeshIndirect() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE DrawMeshIndirect   (const DrawMeshIndirectAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDraw() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE MultiDraw          (const MultiDrawAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndexed() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexed   (const MultiDrawIndexedAttribs& Attribs) override final;
 
 
     /// Implementation of IDeviceContext::DispatchCompute() in Direct3D12 backend.
@@ -244,6 +252,30 @@ public:
     /// Implementation of IDeviceContext::EndQuery() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE EndQuery(IQuery* pQuery) override final;
 
+    /// Implementation of IDeviceContext::BeginIndexedQuery() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE BeginIndexedQuery(IQueryArray* pQueryArray, Uint32 Index) override final;
+
+    /// Implementation of IDeviceContext::EndIndexedQuery() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE EndIndexedQuery(IQueryArray* pQueryArray, Uint32 Index) override final;
+
+    /// Implementation of IDeviceContext::ResolveQueryArray() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE ResolveQueryArray(const ResolveQueryArrayAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::SetPredication() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE SetPredication(IBuffer* pBuffer, Uint64 Offset, PREDICATION_OP Op) override final;
+
+    /// Implementation of IDeviceContext::SetQueryPredication() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE SetQueryPredication(IQuery* pQuery, PREDICATION_OP Op) override final;
+
+    /// Implementation of IDeviceContext::SetCullMode() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE SetCullMode(CULL_MODE CullMode) override final;
+
+    /// Implementation of IDeviceContext::SetDepthStencilState() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE SetDepthStencilState(const DepthStencilStateDesc& DSSDesc) override final;
+
+    /// Implementation of IDeviceContext::SetPrimitiveTopology() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE SetPrimitiveTopology(PRIMITIVE_TOPOLOGY Topology) override final;
+
     /// Implementation of IDeviceContext::Flush() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE Flush() override final;
 
@@ -256,6 +288,9 @@ public:
     /// Implementation of IDeviceContext::BuildBLAS() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE BuildBLAS(const BuildBLASAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::BuildBLASBatch() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE BuildBLASBatch(const BuildBLASBatchAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::BuildTLAS() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE BuildTLAS(const BuildTLASAttribs& Attribs) override final;
 
@@ -292,6 +327,12 @@ public:
     /// Implementation of IDeviceContextD3D12::ID3D12GraphicsCommandList() in Direct3D12 backend.
     virtual ID3D12GraphicsCommandList* DILIGENT_CALL_TYPE GetD3D12CommandList() override final;
 
+    /// Implementation of IDeviceContextD3D12::ExecuteIndirect() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE ExecuteIndirect(const ExecuteIndirectAttribsD3D12& Attribs) override final;
+
+    /// Implementation of IDeviceContextD3D12::BeginBundle() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE BeginBundle(Uint32 ImmediateContextId) override final;
+
     /// Implementation of IDeviceContext::SetShadingRate() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE SetShadingRate(SHADING_RATE          BaseRate,
                                                    SHADING_RATE_COMBINER PrimitiveCombiner,
@@ -336,6 +377,24 @@ public:
                            const Box&                     DstBox,
                            RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode);
 
+    // Region of a texture subresource that is copied from a buffer
+    struct TextureCopyChunk
+    {
+        ID3D12Resource* pd3d12Buffer   = nullptr;
+        Uint64          SrcOffset      = 0;
+        Uint64          SrcStride      = 0;
+        Uint64          SrcDepthStride = 0;
+        Uint64          BufferSize     = 0;
+        Box             DstBox;
+    };
+    // Copies all chunks to the same texture subresource. If the subresource needs to be
+    // transitioned to COPY_DEST state, this is done once for all chunks.
+    void CopyTextureChunks(const TextureCopyChunk*        pChunks,
+                           Uint32                         NumChunks,
+                           class TextureD3D12Impl&        TextureD3D12,
+                           Uint32                         DstSubResIndex,
+                           RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode);
+
     void UpdateTextureRegion(const void*                    pSrcData,
                              Uint64                         SrcStride,
                              Uint64                         SrcDepthStride,
@@ -346,6 +405,9 @@ public:
 
     virtual void DILIGENT_CALL_TYPE GenerateMips(ITextureView* pTexView) override final;
 
+    /// Implementation of IDeviceContext::GenerateMipsBatch() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE GenerateMipsBatch(ITextureView* const* ppTexViews, Uint32 NumViews) override final;
+
     D3D12DynamicAllocation AllocateDynamicSpace(Uint64 NumBytes, Uint32 Alignment);
 
     size_t GetNumCommandsInCtx() const { return m_State.NumCommands; }
@@ -371,6 +433,11 @@ private:
 
     __forceinline void RequestCommandContext();
 
+    void ExecuteBundles(Uint32               NumCommandLists,
+                        ICommandList* const* ppCommandLists);
+
+    CommandContext::ShaderDescriptorHeaps GetShaderDescriptorHeaps();
+
     __forceinline void TransitionOrVerifyBufferState(CommandContext&                CmdCtx,
                                                      BufferD3D12Impl&               Buffer,
                                                      RESOURCE_STATE_TRANSITION_MODE TransitionMode,
@@ -392,6 +459,24 @@ private:
                                                    RESOURCE_STATE                 RequiredState,
                                                    const char*                    OperationName);
 
+    // Records the state transitions of the BLAS build and appends its geometries to Geometries.
+    // d3d12BuildASDesc.Inputs.pGeometryDescs is left null as the vector may be reallocated by
+    // the subsequent builds of the batch.
+    void PrepareBLASBuild(CommandContext&                                     CmdCtx,
+                          const BuildBLASAttribs&                             Attribs,
+                          BufferD3D12Impl&                                    ScratchBuffer,
+                          Uint64                                              ScratchBufferOffset,
+                          RESOURCE_STATE_TRANSITION_MODE                      ScratchBufferTransitionMode,
+                          const char*                                         OpName,
+                          D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC& d3d12BuildASDesc,
+                          FrameVector<D3D12_RAYTRACING_GEOMETRY_DESC>&        Geometries);
+
+    // Uploads the instance records of the TLAS build that changed since the previous build.
+    void UploadChangedTLASInstances(TopLevelASD3D12Impl&                               TLASD3D12,
+                                    const BuildTLASAttribs&                            Attribs,
+                                    const FrameVector<D3D12_RAYTRACING_INSTANCE_DESC>& Records,
+                                    const char*                                        OpName);
+
     __forceinline void PrepareForDraw(GraphicsContext& GraphCtx, DRAW_FLAGS Flags);
 
     __forceinline void PrepareForIndexedDraw(GraphicsContext& GraphCtx, DRAW_FLAGS Flags, VALUE_TYPE IndexType);
@@ -419,8 +504,16 @@ private:
     void DvpValidateCommittedShaderResources(RootTableInfo& RootInfo) const;
 #endif
 
+    // Resolves the data of all queries ended in the current command list
+    void ResolvePendingQueries();
+
     ID3D12CommandSignature* GetDrawIndirectSignature(Uint32 Stride);
     ID3D12CommandSignature* GetDrawIndexedIndirectSignature(Uint32 Stride);
+    // Returns the command signature for the argument layout, creating it if necessary
+    ID3D12CommandSignature* GetExecuteIndirectSignature(const D3D12_INDIRECT_ARGUMENT_DESC* pArgs,
+                                                        Uint32                              NumArgs,
+                                                        Uint32                              Stride,
+                                                        ID3D12RootSignature*                pd3d12RootSig);
 
     struct TextureUploadSpace
     {
@@ -432,8 +525,11 @@ private:
         Uint32                 RowCount      = 0;
         Box                    Region;
     };
-    TextureUploadSpace AllocateTextureUploadSpace(TEXTURE_FORMAT TexFmt,
-                                                  const Box&     Region);
+    // Computes the layout of the texture region in the upload heap without allocating the space
+    static TextureUploadSpace GetTextureUploadLayout(TEXTURE_FORMAT TexFmt,
+                                                     const Box&     Region);
+    TextureUploadSpace        AllocateTextureUploadSpace(TEXTURE_FORMAT TexFmt,
+                                                         const Box&     Region);
 
 
     friend class SwapChainD3D12Impl;
@@ -476,8 +572,28 @@ private:
     CComPtr<ID3D12CommandSignature>                             m_pDrawMeshIndirectSignature;
     CComPtr<ID3D12CommandSignature>                             m_pTraceRaysIndirectSignature;
 
+    struct ExecuteIndirectSignature
+    {
+        // Keep the root signature alive so that its address can't be reused by another one
+        CComPtr<ID3D12RootSignature>    pd3d12RootSig;
+        CComPtr<ID3D12CommandSignature> pd3d12CmdSig;
+    };
+    // Command signatures for IDeviceContextD3D12::ExecuteIndirect() keyed by the
+    // byte image of the stride, the root signature and the argument descriptions
+    std::unordered_map<std::string, ExecuteIndirectSignature> m_ExecuteIndirectSignatures;
+
+    // Argument descriptions and signature key of the current ExecuteIndirect() call, kept to avoid allocations
+    std::vector<D3D12_INDIRECT_ARGUMENT_DESC> m_IndirectArgDescs;
+    std::string                               m_IndirectSignatureKey;
+
     D3D12DynamicHeap m_DynamicHeap;
 
+    // Upload heap with large pages that is used to stage texture updates
+    D3D12DynamicHeap m_TextureUploadHeap;
+
+    // Texture copy chunks of the current UpdateTexture() call, kept to avoid allocations
+    std::vector<TextureCopyChunk> m_TextureCopyChunks;
+
     // Every context must use its own allocator that maintains individual list of retired descriptor heaps to
     // avoid interference with other command contexts
     // The allocations in heaps are discarded at the end of the frame.
@@ -515,8 +631,17 @@ private:
 
     QueryManagerD3D12* m_QueryMgr = nullptr;
 
+    // Queries ended in the current command list that have not been resolved yet
+    QueryManagerD3D12::PendingResolves m_PendingQueryResolves;
+
     // Null render targets require a null RTV. NULL descriptor causes an error.
     DescriptorHeapAllocation m_NullRTV;
+
+    // Indicates that the deferred context is recording a bundle (see BeginBundle())
+    bool m_IsRecordingBundle = false;
+
+    // Bundles executed in the current command list. Their fence values are set when the list is submitted.
+    std::vector<RefCntAutoPtr<CommandListD3D12Impl>> m_PendingBundles;
 };
 
 } // namespace Diligent
@@ -68,6 +68,7 @@ class ShaderD3D12Impl;
 class SamplerD3D12Impl;
 class FenceD3D12Impl;
 class QueryD3D12Impl;
+class QueryArrayD3D12Impl;
 class RenderPassD3D12Impl;
 class FramebufferD3D12Impl;
 class CommandListD3D12Impl;
@@ -103,6 +104,7 @@ struct EngineD3D12ImplTraits
     using SamplerInterface                   = ISamplerD3D12;
     using FenceInterface                     = IFenceD3D12;
     using QueryInterface                     = IQueryD3D12;
+    using QueryArrayInterface                = IQueryArray;
     using RenderPassInterface                = IRenderPass;
     using FramebufferInterface               = IFramebuffer;
     using CommandListInterface               = ICommandList;
@@ -126,6 +128,7 @@ struct EngineD3D12ImplTraits
     using SamplerImplType                   = SamplerD3D12Impl;
     using FenceImplType                     = FenceD3D12Impl;
     using QueryImplType                     = QueryD3D12Impl;
+    using QueryArrayImplType                = QueryArrayD3D12Impl;
     using RenderPassImplType                = RenderPassD3D12Impl;
     using FramebufferImplType               = FramebufferD3D12Impl;
     using CommandListImplType               = CommandListD3D12Impl;
@@ -59,6 +59,11 @@ public:
 
     void GenerateMips(ID3D12Device* pd3d12Device, class TextureViewD3D12Impl* pTexView, class CommandContext& Ctx) const;
 
+    // Generates mipmaps for all views pass by pass, so that the state transitions of all textures
+    // are flushed together and consecutive dispatches that use the same pipeline state are not interleaved
+    // with pipeline changes.
+    void GenerateMips(ID3D12Device* pd3d12Device, class TextureViewD3D12Impl* const* ppTexViews, Uint32 NumViews, class CommandContext& Ctx) const;
+
 private:
     CComPtr<ID3D12RootSignature> m_pGenerateMipsRS;
     CComPtr<ID3D12PipelineState> m_pGenerateMipsLinearPSO[4];
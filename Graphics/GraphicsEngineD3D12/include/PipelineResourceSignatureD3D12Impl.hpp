@@ -155,6 +155,34 @@ public:
     // Make the base class method visible
     using TPipelineResourceSignatureBase::CopyStaticResources;
 
+    // Collects dynamic descriptor ranges of all signatures committed together, so that
+    // they are copied to the GPU-visible heap with a single CopyDescriptors call per heap type.
+    struct DynamicDescriptorCopyBatch
+    {
+        void AddRange(D3D12_DESCRIPTOR_HEAP_TYPE  d3d12HeapType,
+                      D3D12_CPU_DESCRIPTOR_HANDLE DstHandle,
+                      D3D12_CPU_DESCRIPTOR_HANDLE SrcHandle,
+                      UINT                        NumDescriptors,
+                      UINT                        DescriptorSize);
+
+        void Flush(ID3D12Device* pd3d12Device);
+
+    private:
+        struct HeapTypeRanges
+        {
+            // Each signature adds at most one range per heap type
+            std::array<D3D12_CPU_DESCRIPTOR_HANDLE, MAX_RESOURCE_SIGNATURES> DstHandles;
+            std::array<UINT, MAX_RESOURCE_SIGNATURES>                        DstSizes;
+            std::array<D3D12_CPU_DESCRIPTOR_HANDLE, MAX_RESOURCE_SIGNATURES> SrcHandles;
+            std::array<UINT, MAX_RESOURCE_SIGNATURES>                        SrcSizes;
+
+            UINT NumDstRanges   = 0;
+            UINT NumSrcRanges   = 0;
+            UINT DescriptorSize = 0;
+        };
+        std::array<HeapTypeRanges, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER + 1> m_Heaps;
+    };
+
     struct CommitCacheResourcesAttribs
     {
         ID3D12Device* const             pd3d12Device;
@@ -163,6 +191,10 @@ public:
         const bool                      IsCompute;
         const ShaderResourceCacheD3D12* pResourceCache = nullptr;
         Uint32                          BaseRootIndex  = ~0u;
+
+        // If not null, dynamic descriptors are added to the batch instead of being copied immediately.
+        // The batch must be flushed before the command list is submitted.
+        DynamicDescriptorCopyBatch* pDescriptorCopyBatch = nullptr;
     };
     void CommitRootTables(const CommitCacheResourcesAttribs& CommitAttribs) const;
 
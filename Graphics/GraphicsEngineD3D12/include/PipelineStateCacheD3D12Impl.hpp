@@ -29,8 +29,14 @@
 /// \file
 /// Declaration of Diligent::PipelineStateCacheD3D12Impl class
 
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 #include "EngineD3D12ImplTraits.hpp"
 #include "PipelineStateCacheBase.hpp"
+#include "DataBlob.h"
+#include "RefCntAutoPtr.hpp"
 
 namespace Diligent
 {
@@ -56,8 +62,25 @@ public:
 
     bool StorePipeline(const wchar_t* Name, ID3D12DeviceChild* pPSO);
 
+    /// Returns the serialized root signature with the given description key,
+    /// or null if the cache does not contain it.
+    RefCntAutoPtr<IDataBlob> LoadRootSignature(const std::string& DescKey);
+
+    /// Adds the serialized root signature to the cache.
+    void StoreRootSignature(const std::string& DescKey, IDataBlob* pSerializedRootSig);
+
 private:
+    bool ParseCacheData(const void* pData, size_t DataSize, const void*& pLibraryData, size_t& LibraryDataSize);
+
+private:
+    // The pipeline library references its initial data, which must stay alive as long as the library.
+    RefCntAutoPtr<IDataBlob>       m_pLibraryData;
     CComPtr<ID3D12PipelineLibrary> m_pLibrary;
+
+    // Serialized root signatures keyed by the root signature description, see RootSignatureD3D12::GetDescKey().
+    // Storing them alongside the pipeline library lets warm starts skip D3D12SerializeRootSignature.
+    std::mutex                                                m_RootSigsMtx;
+    std::unordered_map<std::string, RefCntAutoPtr<IDataBlob>> m_RootSigs;
 };
 
 } // namespace Diligent
@@ -27,8 +27,9 @@
 
 #pragma once
 
-#include <mutex>
+#include <atomic>
 #include <array>
+#include <memory>
 #include <vector>
 
 #include "Query.h"
@@ -59,6 +60,11 @@ public:
 
     static constexpr Uint32 InvalidIndex = static_cast<Uint32>(-1);
 
+    // Indices of the queries ended in a command list, for every query type.
+    // The queries are resolved by a single ResolveQueryData call for every
+    // contiguous range of indices before the command list is closed.
+    using PendingResolves = std::array<std::vector<Uint32>, QUERY_TYPE_NUM_TYPES>;
+
     Uint32 AllocateQuery(QUERY_TYPE Type);
     void   ReleaseQuery(QUERY_TYPE Type, Uint32 Index);
 
@@ -68,7 +74,8 @@ public:
     }
 
     void BeginQuery(CommandContext& Ctx, QUERY_TYPE Type, Uint32 Index) const;
-    void EndQuery(CommandContext& Ctx, QUERY_TYPE Type, Uint32 Index) const;
+    void EndQuery(CommandContext& Ctx, QUERY_TYPE Type, Uint32 Index, PendingResolves& Resolves) const;
+    void ResolveQueries(CommandContext& Ctx, PendingResolves& Resolves) const;
     void ReadQueryData(QUERY_TYPE Type, Uint32 Index, void* pDataPtr, Uint32 DataSize) const;
 
     SoftwareQueueIndex GetCommandQueueId() const
@@ -108,7 +115,7 @@ private:
         }
         Uint32 GetMaxAllocatedQueries() const
         {
-            return m_MaxAllocatedQueries;
+            return m_MaxAllocatedQueries.load();
         }
         Uint32 GetResolveBufferOffset(Uint32 QueryIdx) const
         {
@@ -127,13 +134,22 @@ private:
     private:
         CComPtr<ID3D12QueryHeap> m_pd3d12QueryHeap;
 
-        std::mutex          m_AvailableQueriesMtx;
-        std::vector<Uint32> m_AvailableQueries;
+        // Lock-free allocator: every bit of the mask corresponds to one query in the heap.
+        // Bits past the end of the heap are always set.
+        std::unique_ptr<std::atomic<Uint64>[]> m_AllocatedMask;
+
+        Uint32 m_MaskSize = 0;
+
+        // The mask word where the last query was allocated. The search for a free query
+        // starts from this word, so that consecutive allocations get contiguous indices.
+        std::atomic<Uint32> m_SearchStart{0};
+
+        std::atomic<Uint32> m_NumAllocatedQueries{0};
+        std::atomic<Uint32> m_MaxAllocatedQueries{0};
 
         QUERY_TYPE m_Type = QUERY_TYPE_UNDEFINED;
 
-        Uint32 m_QueryCount          = 0;
-        Uint32 m_MaxAllocatedQueries = 0;
+        Uint32 m_QueryCount = 0;
 
         Uint32 m_ResolveBufferBaseOffset = 0;
         Uint32 m_AlignedQueryDataSize    = 0;
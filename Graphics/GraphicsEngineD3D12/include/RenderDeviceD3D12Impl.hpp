@@ -33,6 +33,8 @@
 #include <atomic>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <functional>
 
 #include "EngineD3D12ImplTraits.hpp"
 #include "RenderDeviceD3DBase.hpp"
@@ -41,6 +43,7 @@
 #include "CommandListManager.hpp"
 #include "CommandContext.hpp"
 #include "D3D12DynamicHeap.hpp"
+#include "D3D12ResidencyManager.hpp"
 #include "GenerateMips.hpp"
 #include "DXCompiler.hpp"
 #include "RootSignature.hpp"
@@ -125,6 +128,9 @@ public:
     /// Implementation of IRenderDevice::CreateQuery() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE CreateQuery(const QueryDesc& Desc, IQuery** ppQuery) override final;
 
+    /// Implementation of IRenderDevice::CreateQueryArray() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE CreateQueryArray(const QueryArrayDesc& Desc, IQueryArray** ppQueryArray) override final;
+
     /// Implementation of IRenderDevice::CreateRenderPass() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE CreateRenderPass(const RenderPassDesc& Desc,
                                                      IRenderPass**         ppRenderPass) override final;
@@ -171,6 +177,12 @@ public:
                                                                                   RESOURCE_DIMENSION Dimension,
                                                                                   Uint32             SampleCount) const override final;
 
+    /// Implementation of IRenderDevice::GetTextureMemoryRequirements() in Direct3D12 backend.
+    virtual ResourceMemoryRequirements DILIGENT_CALL_TYPE GetTextureMemoryRequirements(const TextureDesc& TexDesc) const override final;
+
+    /// Implementation of IRenderDevice::GetBufferMemoryRequirements() in Direct3D12 backend.
+    virtual ResourceMemoryRequirements DILIGENT_CALL_TYPE GetBufferMemoryRequirements(const BufferDesc& BuffDesc) const override final;
+
     /// Implementation of IRenderDeviceD3D12::GetD3D12Device().
     virtual ID3D12Device* DILIGENT_CALL_TYPE GetD3D12Device() const override final { return m_pd3d12Device; }
 
@@ -203,7 +215,24 @@ public:
         return m_MaxShaderVersion;
     }
 
-    void CreateRootSignature(const RefCntAutoPtr<class PipelineResourceSignatureD3D12Impl>* ppSignatures, Uint32 SignatureCount, size_t Hash, RootSignatureD3D12** ppRootSig);
+    /// Implementation of IRenderDeviceD3D12::GetGPUDescriptorHeapStats().
+    virtual void DILIGENT_CALL_TYPE GetGPUDescriptorHeapStats(D3D12_DESCRIPTOR_HEAP_TYPE   HeapType,
+                                                              GPUDescriptorHeapStatsD3D12& Stats) override final;
+
+    /// Implementation of IRenderDeviceD3D12::CompactGPUDescriptorHeaps().
+    virtual Uint32 DILIGENT_CALL_TYPE CompactGPUDescriptorHeaps(Uint32 MaxDescriptorsToMove) override final;
+
+    /// Implementation of IRenderDeviceD3D12::GetDynamicHeapStats().
+    virtual void DILIGENT_CALL_TYPE GetDynamicHeapStats(DynamicHeapStatsD3D12& Stats) override final
+    {
+        m_DynamicMemoryManager.GetStats(Stats);
+    }
+
+    void CreateRootSignature(const RefCntAutoPtr<class PipelineResourceSignatureD3D12Impl>* ppSignatures,
+                             Uint32                                                         SignatureCount,
+                             size_t                                                         Hash,
+                             class PipelineStateCacheD3D12Impl*                             pPSOCache,
+                             RootSignatureD3D12**                                           ppRootSig);
 
     RootSignatureCacheD3D12& GetRootSignatureCache() { return m_RootSignatureCache; }
 
@@ -221,14 +250,32 @@ public:
     using PooledCommandContext = std::unique_ptr<CommandContext, STDDeleterRawMem<CommandContext>>;
     PooledCommandContext AllocateCommandContext(SoftwareQueueIndex CommandQueueId, const Char* ID = "");
 
+    // Allocates a command context that records a D3D12 bundle
+    PooledCommandContext AllocateBundleContext(const Char* ID = "");
+
     void CloseAndExecuteTransientCommandContext(SoftwareQueueIndex CommandQueueId, PooledCommandContext&& Ctx);
 
+    // Records the commands that copy the initial data of a buffer or a texture from the upload buffer.
+    // If initial data batching is enabled (see EngineD3D12CreateInfo::InitialDataBatchSize), the commands
+    // are recorded into the command context shared by all threads that is submitted by FlushInitialDataBatch().
+    // Otherwise, the commands are recorded into a transient command context that is executed immediately.
+    void RecordInitialDataCopy(SoftwareQueueIndex                          CommandQueueId,
+                               Uint64                                      UploadDataSize,
+                               const std::function<void(CommandContext&)>& RecordCommands);
+
+    // Submits the batched initial data copy commands to the queue.
+    // The batch must be submitted before any command list that may use the initialized resources.
+    void FlushInitialDataBatch(SoftwareQueueIndex CommandQueueId);
+
+    // Closes and executes command contexts. If pContexts[i] is null, the command list
+    // ppClosedCmdLists[i] that has already been closed is executed instead.
     Uint64 CloseAndExecuteCommandContexts(SoftwareQueueIndex                                     CommandQueueId,
                                           Uint32                                                 NumContexts,
                                           PooledCommandContext                                   pContexts[],
                                           bool                                                   DiscardStaleObjects,
                                           std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pSignalFences,
-                                          std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pWaitFences);
+                                          std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pWaitFences,
+                                          ID3D12CommandList* const*                              ppClosedCmdLists = nullptr);
 
     void SignalFences(SoftwareQueueIndex CommandQueueId, std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>& SignalFences);
     void WaitFences(SoftwareQueueIndex CommandQueueId, std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>& WaitFences);
@@ -236,12 +283,20 @@ public:
     // Disposes an unused command context
     void DisposeCommandContext(PooledCommandContext&& Ctx);
 
+    // Disposes a command context that was closed by a reusable command list, once
+    // the GPU has completed the submission identified by FenceValue.
+    void DisposeClosedCommandContext(PooledCommandContext&&            Ctx,
+                                     CComPtr<ID3D12CommandAllocator>&& pAllocator,
+                                     SoftwareQueueIndex                CommandQueueId,
+                                     Uint64                            FenceValue);
+
     void FlushStaleResources(SoftwareQueueIndex CommandQueueId);
 
     /// Implementation of IRenderDevice::() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE ReleaseStaleResources(bool ForceRelease = false) override final;
 
     D3D12DynamicMemoryManager& GetDynamicMemoryManager() { return m_DynamicMemoryManager; }
+    D3D12DynamicMemoryManager& GetTextureUploadMemoryManager() { return m_TextureUploadMemoryManager; }
 
     GPUDescriptorHeap& GetGPUDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE Type)
     {
@@ -278,6 +333,12 @@ public:
         return m_pNVApiHeap;
     }
 
+    bool IsEnhancedBarriersSupported() const { return m_IsEnhancedBarriersSupported; }
+
+    /// Returns the residency manager, or null if residency management is disabled,
+    /// see EngineD3D12CreateInfo::EnableResidencyManagement.
+    D3D12ResidencyManager* GetResidencyManager() const { return m_pResidencyMgr.get(); }
+
 private:
     virtual void TestTextureFormat(TEXTURE_FORMAT TexFormat) override final;
     void         FreeCommandContext(PooledCommandContext&& Ctx);
@@ -285,22 +346,34 @@ private:
     CommandListManager& GetCmdListManager(SoftwareQueueIndex CommandQueueId);
     CommandListManager& GetCmdListManager(D3D12_COMMAND_LIST_TYPE CmdListType);
 
+    PooledCommandContext AllocateCommandContext(CommandListManager& CmdListMngr, const Char* ID);
+
     CComPtr<ID3D12Device> m_pd3d12Device;
 
+    // Note: the residency manager must be destroyed after all resources have been released
+    std::unique_ptr<D3D12ResidencyManager> m_pResidencyMgr;
+
     CPUDescriptorHeap m_CPUDescriptorHeaps[D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES];
     GPUDescriptorHeap m_GPUDescriptorHeaps[2]; // D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV == 0
                                                // D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER	 == 1
 
     CommandListManager m_CmdListManagers[3];
+    CommandListManager m_BundleCmdListManager;
 
     std::mutex                                                                  m_ContextPoolMutex;
     std::vector<PooledCommandContext, STDAllocatorRawMem<PooledCommandContext>> m_ContextPool;
+    // Bundle command lists can't be reset with allocators of other types, so they are pooled separately
+    std::vector<PooledCommandContext, STDAllocatorRawMem<PooledCommandContext>> m_BundleContextPool;
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic_int m_AllocatedCtxCounter{0};
 #endif
 
     D3D12DynamicMemoryManager m_DynamicMemoryManager;
 
+    // Large pages used by device contexts to stage texture updates. They are kept
+    // separately from dynamic heap pages, so that the two never compete for the same pages.
+    D3D12DynamicMemoryManager m_TextureUploadMemoryManager;
+
     // Note: mips generator must be released after the device has been idled
     GenerateMipsHelper m_MipsGenerator;
 
@@ -314,10 +387,21 @@ private:
     // Each command queue needs its own query manager to avoid race conditions.
     std::vector<std::unique_ptr<QueryManagerD3D12>> m_QueryMgrs;
 
+    // Initial data copy commands recorded by resource constructors from all threads, one batch per command queue.
+    struct InitialDataBatch
+    {
+        std::mutex           Mtx;
+        PooledCommandContext Ctx;
+        Uint64               UploadDataSize = 0;
+    };
+    const Uint64                        m_InitialDataBatchSize;
+    std::unique_ptr<InitialDataBatch[]> m_InitialDataBatches;
+
     // Dummy heap required by NvAPI_D3D12_CreateReservedResource.
     CComPtr<ID3D12Heap> m_pNVApiHeap;
 
-    bool m_IsPSOCacheSupported = false;
+    bool m_IsPSOCacheSupported         = false;
+    bool m_IsEnhancedBarriersSupported = false;
 
 #ifdef DILIGENT_DEVELOPMENT
     Uint32 m_MaxD3D12DeviceVersion = 0;
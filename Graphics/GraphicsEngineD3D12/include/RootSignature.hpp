@@ -50,11 +50,13 @@
 #include <mutex>
 #include <unordered_map>
 #include <memory>
+#include <string>
 
 #include "PrivateConstants.h"
 #include "ShaderResources.hpp"
 #include "ObjectBase.hpp"
 #include "ResourceBindingMap.hpp"
+#include "DataBlob.h"
 
 namespace Diligent
 {
@@ -62,6 +64,7 @@ namespace Diligent
 class RenderDeviceD3D12Impl;
 class RootSignatureCacheD3D12;
 class PipelineResourceSignatureD3D12Impl;
+class PipelineStateCacheD3D12Impl;
 
 /// Implementation of the Diligent::RootSignature class
 class RootSignatureD3D12 final : public ObjectBase<IObject>
@@ -71,7 +74,8 @@ public:
                        RenderDeviceD3D12Impl*                                  pDeviceD3D12Impl,
                        const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl> ppSignatures[],
                        Uint32                                                  SignatureCount,
-                       size_t                                                  Hash);
+                       size_t                                                  Hash,
+                       PipelineStateCacheD3D12Impl*                            pPSOCache = nullptr);
     ~RootSignatureD3D12();
 
     size_t GetHash() const { return m_Hash; }
@@ -110,6 +114,12 @@ public:
 
     bool IsCompatibleWith(const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl> ppSignatures[], Uint32 SignatureCount) const noexcept;
 
+    /// Returns the key that uniquely identifies the d3d12 root signature description.
+    const std::string& GetDescKey() const { return m_DescKey; }
+
+    /// Returns the serialized d3d12 root signature.
+    IDataBlob* GetSerializedData() const { return m_pSerializedData; }
+
 private:
     // The number of pipeline resource signatures used to initialize this root signature.
     const Uint32 m_SignatureCount;
@@ -122,6 +132,11 @@ private:
 
     CComPtr<ID3D12RootSignature> m_pd3d12RootSignature;
 
+    // Byte representation of the d3d12 root signature description and the serialized root signature,
+    // both are kept to store the root signature in pipeline state caches.
+    std::string              m_DescKey;
+    RefCntAutoPtr<IDataBlob> m_pSerializedData;
+
     struct ResourceSignatureInfo
     {
         RefCntAutoPtr<PipelineResourceSignatureD3D12Impl> pSignature;
@@ -179,7 +194,11 @@ public:
 
     ~RootSignatureCacheD3D12();
 
-    RefCntAutoPtr<RootSignatureD3D12> GetRootSig(const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl>* ppSignatures, Uint32 SignatureCount);
+    /// Returns the root signature for the given resource signatures. If the root signature is not
+    /// found and pPSOCache is not null, the cache is used to skip root signature serialization.
+    RefCntAutoPtr<RootSignatureD3D12> GetRootSig(const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl>* ppSignatures,
+                                                 Uint32                                                   SignatureCount,
+                                                 PipelineStateCacheD3D12Impl*                             pPSOCache = nullptr);
 
     void OnDestroyRootSig(RootSignatureD3D12* pRootSig);
 
@@ -98,6 +98,13 @@ public:
         ShaderD3DBase::GetBytecode(ppBytecode, Size);
     }
 
+    /// Implementation of IShaderD3D::GetBytecodeWithResources() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE GetBytecodeWithResources(IDataBlob** ppBytecode) const override final
+    {
+        DEV_CHECK_ERR(ppBytecode != nullptr, "ppBytecode must not be null");
+        *ppBytecode = PackBytecodeWithResources(m_pShaderByteCode, m_pShaderResources.get()).Detach();
+    }
+
     const Char* GetEntryPoint() const { return m_EntryPoint.c_str(); }
 
     const std::shared_ptr<const ShaderResourcesD3D12>& GetShaderResources() const { return m_pShaderResources; }
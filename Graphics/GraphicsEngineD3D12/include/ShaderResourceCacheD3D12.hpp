@@ -116,6 +116,7 @@ namespace Diligent
 
 class CommandContext;
 class RenderDeviceD3D12Impl;
+class D3D12ResidencyManager;
 
 class ShaderResourceCacheD3D12 : public ShaderResourceCacheBase
 {
@@ -212,19 +213,24 @@ public:
     class RootTable
     {
     public:
-        RootTable(Uint32    _NumResources,
-                  Resource* _pResources,
-                  bool      _IsRootView,
-                  Uint32    _TableStartOffset = InvalidDescriptorOffset) noexcept :
+        RootTable(Uint32                     _NumResources,
+                  Resource*                  _pResources,
+                  bool                       _IsRootView,
+                  Uint32                     _TableStartOffset = InvalidDescriptorOffset,
+                  D3D12_DESCRIPTOR_HEAP_TYPE _HeapType         = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV,
+                  ROOT_PARAMETER_GROUP       _Group            = ROOT_PARAMETER_GROUP_STATIC_MUTABLE) noexcept :
             // clang-format off
             m_NumResources    {_NumResources        },
             m_IsRootView      {_IsRootView ? 1u : 0u},
+            m_IsSamplerTable  {_HeapType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ? 1u : 0u},
+            m_Group           {static_cast<Uint32>(_Group)},
             m_pResources      {_pResources          },
             m_TableStartOffset{_TableStartOffset    }
         // clang-format on
         {
             VERIFY_EXPR(GetSize() == _NumResources);
             VERIFY_EXPR(IsRootView() == _IsRootView);
+            VERIFY_EXPR(GetHeapType() == _HeapType && GetGroup() == _Group);
             VERIFY(!IsRootView() || GetSize() == 1, "Root views may only contain one resource");
         }
 
@@ -238,6 +244,9 @@ public:
         Uint32 GetStartOffset() const { return m_TableStartOffset; }
         bool   IsRootView() const { return m_IsRootView != 0; }
 
+        D3D12_DESCRIPTOR_HEAP_TYPE GetHeapType() const { return m_IsSamplerTable ? D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER : D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV; }
+        ROOT_PARAMETER_GROUP       GetGroup() const { return static_cast<ROOT_PARAMETER_GROUP>(m_Group); }
+
     private:
         friend class ShaderResourceCacheD3D12;
         Resource& GetResource(Uint32 OffsetFromTableStart)
@@ -251,11 +260,15 @@ public:
         const Uint32 m_TableStartOffset;
 
         // The total number of resources in the table, accounting for array sizes
-        const Uint32 m_NumResources : 31;
+        const Uint32 m_NumResources : 29;
 
         // Flag indicating if this table stores the resource of a root view
         const Uint32 m_IsRootView : 1;
 
+        // Descriptor heap type and root parameter group of the table (only valid for SRB caches)
+        const Uint32 m_IsSamplerTable : 1;
+        const Uint32 m_Group : 1;
+
         Resource* const m_pResources;
     };
 
@@ -270,6 +283,13 @@ public:
                                  Uint32          OffsetFromTableStart,
                                  const Resource& SrcRes);
 
+    // Writes descriptors of all resources in static/mutable tables of the given heap type
+    // to the new GPU-visible allocation and replaces the current allocation with it.
+    // The current allocation is released once the GPU is done with it.
+    void RelocateDescriptorTables(ID3D12Device*              pd3d12Device,
+                                  D3D12_DESCRIPTOR_HEAP_TYPE HeapType,
+                                  DescriptorHeapAllocation&& NewAllocation);
+
     // Resets the resource at the given root index and offset from the table start to default state
     const Resource& ResetResource(Uint32 RootIndex,
                                   Uint32 OffsetFromTableStart)
@@ -328,8 +348,13 @@ public:
         Transition,
         Verify
     };
-    // Transitions all resources in the cache
-    void TransitionResourceStates(CommandContext& Ctx, StateTransitionMode Mode);
+    // Transitions all resources in the cache. If the resource states are up-to-date
+    // (see ShaderResourceCacheBase::ResourceStatesUpToDate()), only UAVs and acceleration
+    // structures that require a barrier every time they are used are processed.
+    void TransitionResourceStates(CommandContext& Ctx, StateTransitionMode Mode, const RenderDeviceD3D12Impl& Device);
+
+    // Marks all textures and buffers in the cache as used, see D3D12ResidencyManager::MarkUsed().
+    void MarkResourcesUsed(D3D12ResidencyManager& ResidencyMgr);
 
     ResourceCacheContentType GetContentType() const { return m_ContentType; }
 
@@ -362,11 +387,20 @@ private:
 
     size_t AllocateMemory(IMemoryAllocator& MemAllocator);
 
+    // Writes the descriptor of the resource to the GPU-visible descriptor table
+    static void WriteTableDescriptor(ID3D12Device*               pd3d12Device,
+                                     D3D12_DESCRIPTOR_HEAP_TYPE  HeapType,
+                                     D3D12_CPU_DESCRIPTOR_HANDLE DstDescrHandle,
+                                     const Resource&             Res);
+
 private:
     static constexpr Uint32 MaxRootTables = 64;
 
     std::unique_ptr<void, STDDeleter<void, IMemoryAllocator>> m_pMemory;
 
+    // The device whose GPU descriptor heaps may relocate the static/mutable tables (only set for SRB caches)
+    RenderDeviceD3D12Impl* m_pDevice = nullptr;
+
     // Descriptor heap allocations, indexed by m_AllocationIndex
     DescriptorHeapAllocation* m_DescriptorAllocations = nullptr;
 
@@ -46,6 +46,12 @@ public:
                          class IDXCompiler* pDXCompiler,
                          bool               LoadConstantBufferReflection);
 
+    // Loads shader resources from the data written by ShaderResources::Serialize()
+    ShaderResourcesD3D12(const void*       pSerializedData,
+                         size_t            DataSize,
+                         const ShaderDesc& ShdrDesc,
+                         const char*       CombinedSamplerSuffix);
+
     // clang-format off
     ShaderResourcesD3D12             (const ShaderResourcesD3D12&)  = delete;
     ShaderResourcesD3D12             (      ShaderResourcesD3D12&&) = delete;
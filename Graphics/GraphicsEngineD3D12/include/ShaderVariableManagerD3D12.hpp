@@ -95,7 +95,7 @@ public:
 
     void Destroy(IMemoryAllocator& Allocator);
 
-    ShaderVariableD3D12Impl* GetVariable(const Char* Name) const;
+    ShaderVariableD3D12Impl* GetVariable(SHADER_TYPE ShaderType, const Char* Name) const;
     ShaderVariableD3D12Impl* GetVariable(Uint32 Index) const;
 
     // Binds object pObj to resource with index ResIndex and array index ArrayIndex.
@@ -124,6 +124,11 @@ public:
 
     IObject& GetOwner() { return m_Owner; }
 
+    void SetInlineConstants(Uint32 ResIndex, const void* pConstants, Uint32 FirstConstant, Uint32 NumConstants)
+    {
+        m_ResourceCache.SetInlineConstants(ResIndex, pConstants, FirstConstant, NumConstants);
+    }
+
 private:
     friend TBase;
     friend ShaderVariableD3D12Impl;
@@ -39,6 +39,9 @@
 namespace Diligent
 {
 
+/// Converts texture description to D3D12 resource description.
+D3D12_RESOURCE_DESC TextureDescToD3D12ResourceDesc(const TextureDesc& TexDesc) noexcept(false);
+
 /// Implementation of a texture object in Direct3D12 backend.
 class TextureD3D12Impl final : public TextureBase<EngineD3D12ImplTraits>, public D3D12ResourceBase
 {
@@ -101,6 +104,9 @@ protected:
     void InitSparseProperties();
 
     D3D12_PLACED_SUBRESOURCE_FOOTPRINT* m_StagingFootprints = nullptr;
+
+    // Device memory the texture is placed in, see TextureData::pMemory.
+    RefCntAutoPtr<IDeviceMemory> m_pMemory;
 };
 
 } // namespace Diligent
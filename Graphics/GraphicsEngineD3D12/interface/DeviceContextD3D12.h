@@ -48,6 +48,118 @@ static const INTERFACE_ID IID_DeviceContextD3D12 =
 
 // clang-format off
 
+/// Indirect argument type, see Diligent::IndirectArgumentDescD3D12.
+DILIGENT_TYPED_ENUM(INDIRECT_ARGUMENT_TYPE_D3D12, Uint8)
+{
+    /// Undefined argument type.
+    INDIRECT_ARGUMENT_TYPE_D3D12_UNDEFINED = 0,
+
+    /// Draw command.
+    /// The argument buffer contains D3D12_DRAW_ARGUMENTS structure.
+    INDIRECT_ARGUMENT_TYPE_D3D12_DRAW,
+
+    /// Indexed draw command.
+    /// The argument buffer contains D3D12_DRAW_INDEXED_ARGUMENTS structure.
+    INDIRECT_ARGUMENT_TYPE_D3D12_DRAW_INDEXED,
+
+    /// Compute dispatch command.
+    /// The argument buffer contains D3D12_DISPATCH_ARGUMENTS structure.
+    INDIRECT_ARGUMENT_TYPE_D3D12_DISPATCH,
+
+    /// Mesh shader dispatch command.
+    /// The argument buffer contains D3D12_DISPATCH_MESH_ARGUMENTS structure.
+    INDIRECT_ARGUMENT_TYPE_D3D12_DISPATCH_MESH,
+
+    /// Vertex buffer change for the slot defined by IndirectArgumentDescD3D12::VertexBufferSlot.
+    /// The argument buffer contains D3D12_VERTEX_BUFFER_VIEW structure.
+    INDIRECT_ARGUMENT_TYPE_D3D12_VERTEX_BUFFER_VIEW,
+
+    /// Index buffer change.
+    /// The argument buffer contains D3D12_INDEX_BUFFER_VIEW structure.
+    INDIRECT_ARGUMENT_TYPE_D3D12_INDEX_BUFFER_VIEW,
+
+    /// Root view change for the constant buffer or buffer SRV defined by
+    /// IndirectArgumentDescD3D12::Name and IndirectArgumentDescD3D12::ShaderStages.
+    /// The argument buffer contains the D3D12_GPU_VIRTUAL_ADDRESS of the buffer data.
+    ///
+    /// \note  The resource must be assigned to a root view, which is the case for
+    ///        constant buffers and non-formatted buffer SRVs that are not arrays and
+    ///        are not labeled with PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS.
+    INDIRECT_ARGUMENT_TYPE_D3D12_ROOT_VIEW,
+
+    INDIRECT_ARGUMENT_TYPE_D3D12_COUNT
+};
+
+
+/// Indirect argument description, see Diligent::ExecuteIndirectAttribsD3D12.
+struct IndirectArgumentDescD3D12
+{
+    /// Argument type, see Diligent::INDIRECT_ARGUMENT_TYPE_D3D12.
+    INDIRECT_ARGUMENT_TYPE_D3D12 Type             DEFAULT_INITIALIZER(INDIRECT_ARGUMENT_TYPE_D3D12_UNDEFINED);
+
+    /// For INDIRECT_ARGUMENT_TYPE_D3D12_VERTEX_BUFFER_VIEW, the vertex buffer slot to change.
+    Uint32                       VertexBufferSlot DEFAULT_INITIALIZER(0);
+
+    /// For INDIRECT_ARGUMENT_TYPE_D3D12_ROOT_VIEW, shader stages of the resource.
+    SHADER_TYPE                  ShaderStages     DEFAULT_INITIALIZER(SHADER_TYPE_UNKNOWN);
+
+    /// For INDIRECT_ARGUMENT_TYPE_D3D12_ROOT_VIEW, the name of the resource in the
+    /// resource signatures of the currently bound pipeline state.
+    const Char*                  Name             DEFAULT_INITIALIZER(nullptr);
+};
+typedef struct IndirectArgumentDescD3D12 IndirectArgumentDescD3D12;
+
+
+/// This structure is used by IDeviceContextD3D12::ExecuteIndirect().
+struct ExecuteIndirectAttribsD3D12
+{
+    /// A pointer to the array of NumArguments argument descriptions.
+    ///
+    /// \remarks  Arguments are tightly packed in the argument buffer in the order
+    ///           they are given in the array. The last argument must be a draw or
+    ///           dispatch command, all other arguments must be state changes.
+    const IndirectArgumentDescD3D12* pArguments   DEFAULT_INITIALIZER(nullptr);
+
+    /// The number of elements in pArguments array.
+    Uint32                           NumArguments DEFAULT_INITIALIZER(0);
+
+    /// The byte stride between successive sets of arguments in the argument buffer.
+    /// Must be a multiple of 4 and not less than the total size of all arguments.
+    Uint32                           ArgsStride   DEFAULT_INITIALIZER(0);
+
+    /// For indexed draw commands that do not change the index buffer, the type of the
+    /// elements in the bound index buffer. Allowed values: VT_UINT16 and VT_UINT32.
+    VALUE_TYPE                       IndexType    DEFAULT_INITIALIZER(VT_UNDEFINED);
+
+    /// Additional flags for draw commands, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS                       Flags        DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+    /// The number of commands to execute. When pCounterBuffer is not null, this member
+    /// defines the maximum number of commands that will be executed.
+    Uint32                           CommandCount DEFAULT_INITIALIZER(1);
+
+    /// A pointer to the buffer, from which the arguments will be read.
+    IBuffer*                         pArgsBuffer  DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset from the beginning of the buffer to the location of the first set of arguments.
+    Uint64                           ArgsOffset   DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for the argument buffer.
+    RESOURCE_STATE_TRANSITION_MODE   ArgsBufferStateTransitionMode    DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// A pointer to the optional buffer, from which Uint32 value with the command count will be read.
+    IBuffer*                         pCounterBuffer                   DEFAULT_INITIALIZER(nullptr);
+
+    /// When pCounterBuffer is not null, offset from the beginning of the counter buffer to the
+    /// location of the command counter.
+    Uint64                           CounterOffset                    DEFAULT_INITIALIZER(0);
+
+    /// When pCounterBuffer is not null, state transition mode for the counter buffer.
+    RESOURCE_STATE_TRANSITION_MODE   CounterBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+};
+typedef struct ExecuteIndirectAttribsD3D12 ExecuteIndirectAttribsD3D12;
+
+
 /// Exposes Direct3D12-specific functionality of a device context.
 DILIGENT_BEGIN_INTERFACE(IDeviceContextD3D12, IDeviceContext)
 {
@@ -85,6 +197,47 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContextD3D12, IDeviceContext)
     ///           calling IDeviceContext::InvalidateState() and then manually restore all required states via
     ///           appropriate Diligent API calls.
     VIRTUAL ID3D12GraphicsCommandList* METHOD(GetD3D12CommandList)(THIS) PURE;
+
+    /// Executes GPU-generated commands with the user-defined argument layout
+
+    /// \param [in] Attribs - Execute indirect command attributes, see Diligent::ExecuteIndirectAttribsD3D12.
+    ///
+    /// \remarks  Every set of arguments in the argument buffer may change vertex buffers,
+    ///           the index buffer and root views before the draw or dispatch command,
+    ///           which lets a compute shader drive the rendering of the whole scene.
+    ///
+    ///           The engine creates D3D12 command signatures for argument layouts on demand
+    ///           and caches them in the context.
+    ///
+    ///           The engine does not track the states of the buffers referenced by the arguments.
+    ///           An application is responsible for transitioning them to the required states.
+    ///
+    ///           Vertex buffers, the index buffer and root views changed by the command are
+    ///           restored by the next draw or dispatch command.
+    VIRTUAL void METHOD(ExecuteIndirect)(THIS_
+                                         const ExecuteIndirectAttribsD3D12 REF Attribs) PURE;
+
+    /// Begins recording a Direct3D12 bundle in the deferred context.
+
+    /// \param [in] ImmediateContextId - the ID of the immediate context where the bundle will be executed.
+    ///                                  The context must use a graphics queue.
+    ///
+    /// \remarks  Bundles replay short, fixed sequences of draw and dispatch commands with very little
+    ///           CPU overhead. A bundle recorded by this method is returned by IDeviceContext::FinishCommandList()
+    ///           and is executed by IDeviceContext::ExecuteCommandLists() inside the current command list
+    ///           of the immediate context, without flushing it. A bundle may be executed any number of times.
+    ///
+    ///           Render targets, viewports and scissor rects are inherited from the executing context.
+    ///           Render targets set in the deferred context are only used to validate pipeline states.
+    ///
+    ///           Bundles have the same restrictions as command lists recorded after IDeviceContext::BeginReusable().
+    ///           In addition, they must not transition resource states, clear, copy or resolve resources,
+    ///           or begin render passes.
+    ///
+    ///           The pipeline state and shader resources bound in the immediate context are reset
+    ///           after a bundle is executed and must be bound again.
+    VIRTUAL void METHOD(BeginBundle)(THIS_
+                                     Uint32 ImmediateContextId) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -97,6 +250,8 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContextD3D12_TransitionTextureState(This, ...) CALL_IFACE_METHOD(DeviceContextD3D12, TransitionTextureState,This, __VA_ARGS__)
 #    define IDeviceContextD3D12_TransitionBufferState(This, ...)  CALL_IFACE_METHOD(DeviceContextD3D12, TransitionBufferState, This, __VA_ARGS__)
 #    define IDeviceContextD3D12_GetD3D12CommandList(This)         CALL_IFACE_METHOD(DeviceContextD3D12, GetD3D12CommandList,   This)
+#    define IDeviceContextD3D12_ExecuteIndirect(This, ...)         CALL_IFACE_METHOD(DeviceContextD3D12, ExecuteIndirect,       This, __VA_ARGS__)
+#    define IDeviceContextD3D12_BeginBundle(This, ...)             CALL_IFACE_METHOD(DeviceContextD3D12, BeginBundle,           This, __VA_ARGS__)
 
 // clang-format on
 
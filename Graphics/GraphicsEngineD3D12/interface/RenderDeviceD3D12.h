@@ -38,6 +38,74 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_RenderDeviceD3D12 =
     {0xc7987c98, 0x87fe, 0x4309, {0xae, 0x88, 0xe9, 0x8f, 0x4, 0x4b, 0x0, 0xf6}};
 
+// clang-format off
+/// GPU-visible descriptor heap usage statistics, see IRenderDeviceD3D12::GetGPUDescriptorHeapStats().
+struct GPUDescriptorHeapStatsD3D12
+{
+    /// The total number of descriptors in the static/mutable part of the heap
+    /// (EngineD3D12CreateInfo::GPUDescriptorHeapSize).
+    Uint32 StaticSize             DEFAULT_INITIALIZER(0);
+
+    /// The number of descriptors currently allocated in the static/mutable part of the heap.
+    Uint32 StaticUsedSize         DEFAULT_INITIALIZER(0);
+
+    /// The peak number of descriptors allocated in the static/mutable part of the heap.
+    Uint32 StaticPeakUsedSize     DEFAULT_INITIALIZER(0);
+
+    /// The number of free blocks in the static/mutable part of the heap.
+    Uint32 StaticFreeBlockCount   DEFAULT_INITIALIZER(0);
+
+    /// The size of the largest continuous free block in the static/mutable part of the heap.
+
+    /// \note   An SRB whose static and mutable resources require more descriptors than
+    ///         this value cannot be created, even if StaticSize - StaticUsedSize is larger.
+    ///         Use IRenderDeviceD3D12::CompactGPUDescriptorHeaps() to reduce fragmentation.
+    Uint32 StaticMaxFreeBlockSize DEFAULT_INITIALIZER(0);
+
+    /// The number of SRBs whose static/mutable descriptor tables may be relocated by IRenderDeviceD3D12::CompactGPUDescriptorHeaps().
+    Uint32 RelocatableSRBCount    DEFAULT_INITIALIZER(0);
+
+    /// The total number of descriptors in the dynamic part of the heap
+    /// (EngineD3D12CreateInfo::GPUDescriptorHeapDynamicSize).
+    Uint32 DynamicSize            DEFAULT_INITIALIZER(0);
+
+    /// The number of descriptors currently allocated in the dynamic part of the heap.
+    Uint32 DynamicUsedSize        DEFAULT_INITIALIZER(0);
+
+    /// The peak number of descriptors allocated in the dynamic part of the heap.
+    Uint32 DynamicPeakUsedSize    DEFAULT_INITIALIZER(0);
+};
+// clang-format on
+typedef struct GPUDescriptorHeapStatsD3D12 GPUDescriptorHeapStatsD3D12;
+
+// clang-format off
+/// Dynamic heap usage statistics, see IRenderDeviceD3D12::GetDynamicHeapStats().
+struct DynamicHeapStatsD3D12
+{
+    /// The total size, in bytes, of all dynamic heap pages, including the pages
+    /// that are available for reuse.
+    Uint64 TotalSize         DEFAULT_INITIALIZER(0);
+
+    /// The size of the pages currently used by device contexts, including the pages
+    /// that wait until the GPU finishes the commands that use them.
+    Uint64 UsedSize          DEFAULT_INITIALIZER(0);
+
+    /// The peak used size since the device was created.
+    Uint64 PeakUsedSize      DEFAULT_INITIALIZER(0);
+
+    /// The peak used size during the last frame.
+    Uint64 FramePeakUsedSize DEFAULT_INITIALIZER(0);
+
+    /// The number of pages that were created at run time because no suitable page was available.
+    Uint32 GrowCount         DEFAULT_INITIALIZER(0);
+
+    /// The number of pages that were released after sustained low usage,
+    /// see EngineD3D12CreateInfo::DynamicHeapShrinkInterval.
+    Uint32 ShrinkCount       DEFAULT_INITIALIZER(0);
+};
+// clang-format on
+typedef struct DynamicHeapStatsD3D12 DynamicHeapStatsD3D12;
+
 #define DILIGENT_INTERFACE_NAME IRenderDeviceD3D12
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -120,6 +188,48 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceD3D12, IRenderDevice)
 
     /// Returns the maximum shader version supported by this render device.
     VIRTUAL const ShaderVersion REF METHOD(GetMaxShaderVersion)(THIS) CONST PURE;
+
+    /// Returns the usage statistics of the GPU-visible descriptor heap of the given type.
+
+    /// \param [in]  HeapType - Descriptor heap type. Must be D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV
+    ///                          or D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER.
+    /// \param [out] Stats    - Heap usage statistics, see Diligent::GPUDescriptorHeapStatsD3D12.
+    ///
+    /// \remarks   The method is thread-safe.
+    VIRTUAL void METHOD(GetGPUDescriptorHeapStats)(THIS_
+                                                   D3D12_DESCRIPTOR_HEAP_TYPE      HeapType,
+                                                   GPUDescriptorHeapStatsD3D12 REF Stats) PURE;
+
+    /// Reduces the fragmentation of the static/mutable part of GPU-visible descriptor heaps.
+
+    /// \param [in] MaxDescriptorsToMove - The maximum number of descriptors to relocate
+    ///                                    in every heap.
+    ///
+    /// \return    The total number of relocated descriptors.
+    ///
+    /// \remarks   The method moves descriptor tables of static and mutable SRB resources
+    ///            closer to the start of the heap, so that free space is merged into larger blocks.
+    ///            Descriptor space that was released by relocation becomes available when the GPU
+    ///            has finished all commands that were submitted up to this point, so an application
+    ///            should call the method repeatedly, e.g. once per frame when the GPU load is low,
+    ///            limiting the amount of work with MaxDescriptorsToMove.
+    ///
+    ///            Relocated tables must be committed again by IDeviceContext::CommitShaderResources()
+    ///            to take effect in new commands. Commands that have already been recorded keep using
+    ///            the original descriptors.
+    ///
+    ///            The method must not be called while any other thread binds resources to SRBs or
+    ///            commits SRBs. Creating and destroying SRBs at the same time is allowed.
+    VIRTUAL Uint32 METHOD(CompactGPUDescriptorHeaps)(THIS_
+                                                     Uint32 MaxDescriptorsToMove) PURE;
+
+    /// Returns the usage statistics of the dynamic heap shared by all device contexts.
+
+    /// \param [out] Stats - Dynamic heap usage statistics, see Diligent::DynamicHeapStatsD3D12.
+    ///
+    /// \remarks   The method is thread-safe.
+    VIRTUAL void METHOD(GetDynamicHeapStats)(THIS_
+                                             DynamicHeapStatsD3D12 REF Stats) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -135,6 +245,9 @@ DILIGENT_END_INTERFACE
 #    define IRenderDeviceD3D12_CreateBLASFromD3DResource(This, ...)    CALL_IFACE_METHOD(RenderDeviceD3D12, CreateBLASFromD3DResource,    This, __VA_ARGS__)
 #    define IRenderDeviceD3D12_CreateTLASFromD3DResource(This, ...)    CALL_IFACE_METHOD(RenderDeviceD3D12, CreateTLASFromD3DResource,    This, __VA_ARGS__)
 #    define IRenderDeviceD3D12_GetMaxShaderVersion(This)               CALL_IFACE_METHOD(RenderDeviceD3D12, GetMaxShaderVersion,          This)
+#    define IRenderDeviceD3D12_GetGPUDescriptorHeapStats(This, ...)    CALL_IFACE_METHOD(RenderDeviceD3D12, GetGPUDescriptorHeapStats,    This, __VA_ARGS__)
+#    define IRenderDeviceD3D12_CompactGPUDescriptorHeaps(This, ...)    CALL_IFACE_METHOD(RenderDeviceD3D12, CompactGPUDescriptorHeaps,    This, __VA_ARGS__)
+#    define IRenderDeviceD3D12_GetDynamicHeapStats(This, ...)          CALL_IFACE_METHOD(RenderDeviceD3D12, GetDynamicHeapStats,          This, __VA_ARGS__)
 
 // clang-format on
 
@@ -31,6 +31,7 @@
 
 #include "RenderDeviceD3D12Impl.hpp"
 #include "DeviceContextD3D12Impl.hpp"
+#include "DeviceMemoryD3D12Impl.hpp"
 
 #include "D3D12TypeConversions.hpp"
 #include "GraphicsAccessories.hpp"
@@ -41,6 +42,30 @@
 namespace Diligent
 {
 
+D3D12_RESOURCE_DESC BufferDescToD3D12ResourceDesc(const BufferDesc& BuffDesc)
+{
+    D3D12_RESOURCE_DESC d3d12BuffDesc{};
+    d3d12BuffDesc.Dimension          = D3D12_RESOURCE_DIMENSION_BUFFER;
+    d3d12BuffDesc.Alignment          = 0;
+    d3d12BuffDesc.Width              = BuffDesc.Size;
+    d3d12BuffDesc.Height             = 1;
+    d3d12BuffDesc.DepthOrArraySize   = 1;
+    d3d12BuffDesc.MipLevels          = 1;
+    d3d12BuffDesc.Format             = DXGI_FORMAT_UNKNOWN;
+    d3d12BuffDesc.SampleDesc.Count   = 1;
+    d3d12BuffDesc.SampleDesc.Quality = 0;
+    // Layout must be D3D12_TEXTURE_LAYOUT_ROW_MAJOR, as buffer memory layouts are
+    // understood by applications and row-major texture data is commonly marshaled through buffers.
+    d3d12BuffDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    d3d12BuffDesc.Flags  = D3D12_RESOURCE_FLAG_NONE;
+    if ((BuffDesc.BindFlags & BIND_UNORDERED_ACCESS) || (BuffDesc.BindFlags & BIND_RAY_TRACING))
+        d3d12BuffDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+    if (!(BuffDesc.BindFlags & BIND_SHADER_RESOURCE) && !(BuffDesc.BindFlags & BIND_RAY_TRACING))
+        d3d12BuffDesc.Flags |= D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE;
+
+    return d3d12BuffDesc;
+}
+
 BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
                                  FixedBlockMemoryAllocator& BuffViewObjMemAllocator,
                                  RenderDeviceD3D12Impl*     pRenderDeviceD3D12,
@@ -95,24 +120,7 @@ BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
         VERIFY(m_Desc.Usage != USAGE_DYNAMIC || PlatformMisc::CountOneBits(m_Desc.ImmediateContextMask) <= 1,
                "ImmediateContextMask must contain single set bit, this error should've been handled in ValidateBufferDesc()");
 
-        D3D12_RESOURCE_DESC d3d12BuffDesc{};
-        d3d12BuffDesc.Dimension          = D3D12_RESOURCE_DIMENSION_BUFFER;
-        d3d12BuffDesc.Alignment          = 0;
-        d3d12BuffDesc.Width              = m_Desc.Size;
-        d3d12BuffDesc.Height             = 1;
-        d3d12BuffDesc.DepthOrArraySize   = 1;
-        d3d12BuffDesc.MipLevels          = 1;
-        d3d12BuffDesc.Format             = DXGI_FORMAT_UNKNOWN;
-        d3d12BuffDesc.SampleDesc.Count   = 1;
-        d3d12BuffDesc.SampleDesc.Quality = 0;
-        // Layout must be D3D12_TEXTURE_LAYOUT_ROW_MAJOR, as buffer memory layouts are
-        // understood by applications and row-major texture data is commonly marshaled through buffers.
-        d3d12BuffDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-        d3d12BuffDesc.Flags  = D3D12_RESOURCE_FLAG_NONE;
-        if ((m_Desc.BindFlags & BIND_UNORDERED_ACCESS) || (m_Desc.BindFlags & BIND_RAY_TRACING))
-            d3d12BuffDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
-        if (!(m_Desc.BindFlags & BIND_SHADER_RESOURCE) && !(m_Desc.BindFlags & BIND_RAY_TRACING))
-            d3d12BuffDesc.Flags |= D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE;
+        D3D12_RESOURCE_DESC d3d12BuffDesc = BufferDescToD3D12ResourceDesc(m_Desc);
 
         auto* pd3d12Device = pRenderDeviceD3D12->GetD3D12Device();
 
@@ -166,18 +174,44 @@ BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
 
             const auto d3d12State = ResourceStateFlagsToD3D12ResourceStates(GetState()) & StateMask;
 
-            // By default, committed resources and heaps are almost always zeroed upon creation.
-            // CREATE_NOT_ZEROED flag allows this to be elided in some scenarios to lower the overhead
-            // of creating the heap. No need to zero the resource if we initialize it.
-            const auto d3d12HeapFlags = InitialDataSize > 0 ?
-                D3D12_HEAP_FLAG_CREATE_NOT_ZEROED :
-                D3D12_HEAP_FLAG_NONE;
-
-            auto hr = pd3d12Device->CreateCommittedResource(
-                &HeapProps, d3d12HeapFlags, &d3d12BuffDesc, d3d12State,
-                nullptr, // pOptimizedClearValue
-                __uuidof(m_pd3d12Resource),
-                reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
+            const bool IsPlaced = pBuffData != nullptr && pBuffData->pMemory != nullptr;
+
+            HRESULT hr = E_FAIL;
+            if (IsPlaced)
+            {
+                // Create the buffer in the heap of the device memory object. The memory may be shared by other
+                // placed resources, so the buffer must be activated with an aliasing barrier before it is used.
+                const auto d3d12AllocInfo = pd3d12Device->GetResourceAllocationInfo(0, 1, &d3d12BuffDesc);
+
+                m_pMemory = pBuffData->pMemory;
+
+                const auto MemRange = m_pMemory.RawPtr<DeviceMemoryD3D12Impl>()->GetRange(pBuffData->MemoryOffset, d3d12AllocInfo.SizeInBytes);
+                if (MemRange.pHandle == nullptr)
+                    LOG_ERROR_AND_THROW("Memory range [", pBuffData->MemoryOffset, ", ", pBuffData->MemoryOffset + d3d12AllocInfo.SizeInBytes, ") is not a valid range of the device memory");
+                if ((MemRange.Offset % d3d12AllocInfo.Alignment) != 0)
+                    LOG_ERROR_AND_THROW("Memory offset (", pBuffData->MemoryOffset, ") is not a multiple of the required alignment (", d3d12AllocInfo.Alignment, ")");
+
+                hr = pd3d12Device->CreatePlacedResource(
+                    MemRange.pHandle, MemRange.Offset, &d3d12BuffDesc, d3d12State,
+                    nullptr, // pOptimizedClearValue
+                    __uuidof(m_pd3d12Resource),
+                    reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
+            }
+            else
+            {
+                // By default, committed resources and heaps are almost always zeroed upon creation.
+                // CREATE_NOT_ZEROED flag allows this to be elided in some scenarios to lower the overhead
+                // of creating the heap. No need to zero the resource if we initialize it.
+                const auto d3d12HeapFlags = InitialDataSize > 0 ?
+                    D3D12_HEAP_FLAG_CREATE_NOT_ZEROED :
+                    D3D12_HEAP_FLAG_NONE;
+
+                hr = pd3d12Device->CreateCommittedResource(
+                    &HeapProps, d3d12HeapFlags, &d3d12BuffDesc, d3d12State,
+                    nullptr, // pOptimizedClearValue
+                    __uuidof(m_pd3d12Resource),
+                    reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
+            }
             if (FAILED(hr))
                 LOG_ERROR_AND_THROW("Failed to create D3D12 buffer");
 
@@ -211,13 +245,11 @@ BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
                 memcpy(DestAddress, pBuffData->pData, StaticCast<size_t>(InitialDataSize));
                 UploadBuffer->Unmap(0, nullptr);
 
-                auto InitContext = pRenderDeviceD3D12->AllocateCommandContext(CmdQueueInd);
                 // copy data to the intermediate upload heap and then schedule a copy from the upload heap to the default buffer
                 VERIFY_EXPR(CheckState(RESOURCE_STATE_COPY_DEST));
                 // We MUST NOT call TransitionResource() from here, because
                 // it will call AddRef() and potentially Release(), while
                 // the object is not constructed yet
-                InitContext->CopyResource(m_pd3d12Resource, UploadBuffer);
 
                 // Command list fence should only be signaled when submitting cmd list
                 // from the immediate context, otherwise the basic requirement will be violated
@@ -237,11 +269,17 @@ BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
                 //                  |     N+1, but resource it references    |                                   |
                 //                  |     was added to the delete queue      |                                   |
                 //                  |     with value N                       |                                   |
-                pRenderDeviceD3D12->CloseAndExecuteTransientCommandContext(CmdQueueInd, std::move(InitContext));
+                //
+                // The copy may be batched with the copies of other resources, see EngineD3D12CreateInfo::InitialDataBatchSize.
+                pRenderDeviceD3D12->RecordInitialDataCopy(CmdQueueInd, InitialDataSize,
+                                                          [&](CommandContext& InitContext) {
+                                                              InitContext.CopyResource(m_pd3d12Resource, UploadBuffer);
+                                                          });
 
                 // Add reference to the object to the release queue to keep it alive
                 // until copy operation is complete. This must be done after
-                // submitting command list for execution!
+                // recording the copy command! The batched copies are always
+                // submitted before the stale resources of the queue are discarded.
                 pRenderDeviceD3D12->SafeReleaseDeviceObject(std::move(UploadBuffer), Uint64{1} << CmdQueueInd);
             }
 
@@ -250,6 +288,16 @@ BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
                 m_CBVDescriptorAllocation = pRenderDeviceD3D12->AllocateDescriptors(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
                 CreateCBV(m_CBVDescriptorAllocation.GetCpuHandle());
             }
+
+            // The residency of placed buffers is defined by the heap they are placed in
+            if (HeapProps.Type == D3D12_HEAP_TYPE_DEFAULT && !IsPlaced)
+            {
+                // UAV buffers are typically written every frame and are never evicted
+                if ((m_Desc.BindFlags & BIND_UNORDERED_ACCESS) != 0)
+                    D3D12ResidencyManager::SetHighResidencyPriority(pd3d12Device, m_pd3d12Resource);
+                else if (auto* pResidencyMgr = pRenderDeviceD3D12->GetResidencyManager())
+                    pResidencyMgr->RegisterResource(*this);
+            }
         }
     }
 
@@ -336,6 +384,8 @@ BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
 
 BufferD3D12Impl::~BufferD3D12Impl()
 {
+    if (auto* pResidencyMgr = GetDevice()->GetResidencyManager())
+        pResidencyMgr->UnregisterResource(*this);
     // D3D12 object can only be destroyed when it is no longer used by the GPU
     GetDevice()->SafeReleaseDeviceObject(std::move(m_pd3d12Resource), m_Desc.ImmediateContextMask);
 }
@@ -55,10 +55,27 @@ namespace Diligent
 {
 
 CommandContext::CommandContext(CommandListManager& CmdListManager) :
+    // clang-format off
     m_PendingResourceBarriers(STD_ALLOCATOR_RAW_MEM(D3D12_RESOURCE_BARRIER, GetRawAllocator(), "Allocator for vector<D3D12_RESOURCE_BARRIER>"))
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    ,
+    m_PendingTextureBarriers (STD_ALLOCATOR_RAW_MEM(D3D12_TEXTURE_BARRIER,  GetRawAllocator(), "Allocator for vector<D3D12_TEXTURE_BARRIER>")),
+    m_PendingBufferBarriers  (STD_ALLOCATOR_RAW_MEM(D3D12_BUFFER_BARRIER,   GetRawAllocator(), "Allocator for vector<D3D12_BUFFER_BARRIER>"))
+#endif
+// clang-format on
 {
     m_PendingResourceBarriers.reserve(32);
     CmdListManager.CreateNewCommandList(&m_pCommandList, &m_pCurrentAllocator, m_MaxInterfaceVer);
+
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    // Enhanced barriers require ID3D12GraphicsCommandList7
+    m_UseEnhancedBarriers = m_MaxInterfaceVer >= 7 && CmdListManager.GetDevice().IsEnhancedBarriersSupported();
+    if (m_UseEnhancedBarriers)
+    {
+        m_PendingTextureBarriers.reserve(32);
+        m_PendingBufferBarriers.reserve(32);
+    }
+#endif
 }
 
 CommandContext::~CommandContext(void)
@@ -84,7 +101,12 @@ void CommandContext::Reset(CommandListManager& CmdListManager)
     m_pCurGraphicsRootSignature = nullptr;
     m_pCurComputeRootSignature  = nullptr;
     m_PendingResourceBarriers.clear();
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    m_PendingTextureBarriers.clear();
+    m_PendingBufferBarriers.clear();
+#endif
     m_BoundDescriptorHeaps = ShaderDescriptorHeaps{};
+    m_BarrierCount         = 0;
 
     m_DynamicGPUDescriptorAllocators = nullptr;
 
@@ -177,6 +199,19 @@ public:
     void AddD3D12ResourceBarriers(TopLevelASD3D12Impl& TLAS, D3D12_RESOURCE_BARRIER& d3d12Barrier);
     void AddD3D12ResourceBarriers(BottomLevelASD3D12Impl& BLAS, D3D12_RESOURCE_BARRIER& d3d12Barrier);
 
+    void AddD3D12UAVBarrier(TextureD3D12Impl& Tex);
+    void AddD3D12UAVBarrier(BufferD3D12Impl& Buff);
+    void AddD3D12UAVBarrier(TopLevelASD3D12Impl& TLAS);
+    void AddD3D12UAVBarrier(BottomLevelASD3D12Impl& BLAS);
+
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    template <typename BarrierType>
+    void InitEnhancedBarrier(BarrierType& d3d12Barrier) const;
+
+    void AddD3D12TextureBarrier(const D3D12_BARRIER_SUBRESOURCE_RANGE& Subresources);
+    void AddD3D12BufferBarrier();
+#endif
+
     template <typename ResourceType>
     void operator()(ResourceType& Resource);
 
@@ -191,6 +226,7 @@ private:
     CommandContext& m_CmdCtx;
 
     RESOURCE_STATE  m_OldState       = RESOURCE_STATE_UNKNOWN;
+    RESOURCE_STATE  m_NewState       = RESOURCE_STATE_UNKNOWN;
     ID3D12Resource* m_pd3d12Resource = nullptr;
 
     bool m_RequireUAVBarrier = false;
@@ -314,8 +350,19 @@ void StateTransitionHelper::AddD3D12ResourceBarriers(TextureD3D12Impl& Tex, D3D1
             m_Barrier.FirstArraySlice == 0 && (m_Barrier.ArraySliceCount == REMAINING_ARRAY_SLICES || m_Barrier.ArraySliceCount == TexDesc.GetArraySize()))
         {
             DiscardIfAppropriate(TexDesc, d3d12Barrier.Transition.StateBefore);
-            d3d12Barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-            m_CmdCtx.ResourceBarrier(d3d12Barrier);
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+            if (m_CmdCtx.UseEnhancedBarriers())
+            {
+                D3D12_BARRIER_SUBRESOURCE_RANGE AllSubresources{};
+                AllSubresources.IndexOrFirstMipLevel = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+                AddD3D12TextureBarrier(AllSubresources);
+            }
+            else
+#endif
+            {
+                d3d12Barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+                m_CmdCtx.ResourceBarrier(d3d12Barrier);
+            }
             DiscardIfAppropriate(TexDesc, d3d12Barrier.Transition.StateAfter);
         }
         else
@@ -323,12 +370,29 @@ void StateTransitionHelper::AddD3D12ResourceBarriers(TextureD3D12Impl& Tex, D3D1
             Uint32 EndMip   = m_Barrier.MipLevelsCount == REMAINING_MIP_LEVELS ? TexDesc.MipLevels : m_Barrier.FirstMipLevel + m_Barrier.MipLevelsCount;
             Uint32 EndSlice = m_Barrier.ArraySliceCount == REMAINING_ARRAY_SLICES ? TexDesc.GetArraySize() : m_Barrier.FirstArraySlice + m_Barrier.ArraySliceCount;
             DiscardIfAppropriate(TexDesc, d3d12Barrier.Transition.StateBefore, EndMip, EndSlice);
-            for (Uint32 mip = m_Barrier.FirstMipLevel; mip < EndMip; ++mip)
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+            if (m_CmdCtx.UseEnhancedBarriers())
+            {
+                // A single enhanced barrier covers the whole range of subresources
+                D3D12_BARRIER_SUBRESOURCE_RANGE Subresources{};
+                Subresources.IndexOrFirstMipLevel = m_Barrier.FirstMipLevel;
+                Subresources.NumMipLevels         = EndMip - m_Barrier.FirstMipLevel;
+                Subresources.FirstArraySlice      = m_Barrier.FirstArraySlice;
+                Subresources.NumArraySlices       = EndSlice - m_Barrier.FirstArraySlice;
+                Subresources.FirstPlane           = 0;
+                Subresources.NumPlanes            = 1;
+                AddD3D12TextureBarrier(Subresources);
+            }
+            else
+#endif
             {
-                for (Uint32 slice = m_Barrier.FirstArraySlice; slice < EndSlice; ++slice)
+                for (Uint32 mip = m_Barrier.FirstMipLevel; mip < EndMip; ++mip)
                 {
-                    d3d12Barrier.Transition.Subresource = D3D12CalcSubresource(mip, slice, 0, TexDesc.MipLevels, TexDesc.GetArraySize());
-                    m_CmdCtx.ResourceBarrier(d3d12Barrier);
+                    for (Uint32 slice = m_Barrier.FirstArraySlice; slice < EndSlice; ++slice)
+                    {
+                        d3d12Barrier.Transition.Subresource = D3D12CalcSubresource(mip, slice, 0, TexDesc.MipLevels, TexDesc.GetArraySize());
+                        m_CmdCtx.ResourceBarrier(d3d12Barrier);
+                    }
                 }
             }
             DiscardIfAppropriate(TexDesc, d3d12Barrier.Transition.StateAfter, EndMip, EndSlice);
@@ -340,6 +404,13 @@ void StateTransitionHelper::AddD3D12ResourceBarriers(BufferD3D12Impl& Buff, D3D1
 {
     if (d3d12Barrier.Transition.StateBefore != d3d12Barrier.Transition.StateAfter)
     {
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+        if (m_CmdCtx.UseEnhancedBarriers())
+        {
+            AddD3D12BufferBarrier();
+            return;
+        }
+#endif
         m_CmdCtx.ResourceBarrier(d3d12Barrier);
     }
 }
@@ -371,6 +442,107 @@ void StateTransitionHelper::AddD3D12ResourceBarriers(BottomLevelASD3D12Impl& BLA
         m_RequireUAVBarrier = true;
 }
 
+void StateTransitionHelper::AddD3D12UAVBarrier(TextureD3D12Impl& /*Tex*/)
+{
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    if (m_CmdCtx.UseEnhancedBarriers())
+    {
+        D3D12_BARRIER_SUBRESOURCE_RANGE AllSubresources{};
+        AllSubresources.IndexOrFirstMipLevel = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        AddD3D12TextureBarrier(AllSubresources);
+        return;
+    }
+#endif
+    D3D12_RESOURCE_BARRIER d3d12Barrier{D3D12_RESOURCE_BARRIER_TYPE_UAV, D3D12_RESOURCE_BARRIER_FLAG_NONE};
+    d3d12Barrier.UAV.pResource = m_pd3d12Resource;
+    m_CmdCtx.ResourceBarrier(d3d12Barrier);
+}
+
+void StateTransitionHelper::AddD3D12UAVBarrier(BufferD3D12Impl& /*Buff*/)
+{
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    if (m_CmdCtx.UseEnhancedBarriers())
+    {
+        AddD3D12BufferBarrier();
+        return;
+    }
+#endif
+    D3D12_RESOURCE_BARRIER d3d12Barrier{D3D12_RESOURCE_BARRIER_TYPE_UAV, D3D12_RESOURCE_BARRIER_FLAG_NONE};
+    d3d12Barrier.UAV.pResource = m_pd3d12Resource;
+    m_CmdCtx.ResourceBarrier(d3d12Barrier);
+}
+
+void StateTransitionHelper::AddD3D12UAVBarrier(TopLevelASD3D12Impl& /*TLAS*/)
+{
+    // Acceleration structures always use legacy UAV barriers as they are never transitioned
+    D3D12_RESOURCE_BARRIER d3d12Barrier{D3D12_RESOURCE_BARRIER_TYPE_UAV, D3D12_RESOURCE_BARRIER_FLAG_NONE};
+    d3d12Barrier.UAV.pResource = m_pd3d12Resource;
+    m_CmdCtx.ResourceBarrier(d3d12Barrier);
+}
+
+void StateTransitionHelper::AddD3D12UAVBarrier(BottomLevelASD3D12Impl& /*BLAS*/)
+{
+    D3D12_RESOURCE_BARRIER d3d12Barrier{D3D12_RESOURCE_BARRIER_TYPE_UAV, D3D12_RESOURCE_BARRIER_FLAG_NONE};
+    d3d12Barrier.UAV.pResource = m_pd3d12Resource;
+    m_CmdCtx.ResourceBarrier(d3d12Barrier);
+}
+
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+template <typename BarrierType>
+void StateTransitionHelper::InitEnhancedBarrier(BarrierType& d3d12Barrier) const
+{
+    const auto d3d12CmdListType = m_CmdCtx.GetCommandListType();
+
+    d3d12Barrier.SyncBefore   = ResourceStateFlagsToD3D12BarrierSync(m_OldState, d3d12CmdListType);
+    d3d12Barrier.SyncAfter    = ResourceStateFlagsToD3D12BarrierSync(m_NewState, d3d12CmdListType);
+    d3d12Barrier.AccessBefore = ResourceStateFlagsToD3D12BarrierAccess(m_OldState, d3d12CmdListType);
+    d3d12Barrier.AccessAfter  = ResourceStateFlagsToD3D12BarrierAccess(m_NewState, d3d12CmdListType);
+
+    // Split barriers are expressed with D3D12_BARRIER_SYNC_SPLIT in place of the sync scope
+    // that is resolved by the matching end (or begin) barrier.
+    switch (m_Barrier.TransitionType)
+    {
+        case STATE_TRANSITION_TYPE_IMMEDIATE:
+            break;
+
+        case STATE_TRANSITION_TYPE_BEGIN:
+            d3d12Barrier.SyncAfter = D3D12_BARRIER_SYNC_SPLIT;
+            break;
+
+        case STATE_TRANSITION_TYPE_END:
+            d3d12Barrier.SyncBefore = D3D12_BARRIER_SYNC_SPLIT;
+            break;
+
+        default:
+            UNEXPECTED("Unexpected state transition type");
+    }
+}
+
+void StateTransitionHelper::AddD3D12TextureBarrier(const D3D12_BARRIER_SUBRESOURCE_RANGE& Subresources)
+{
+    const auto d3d12CmdListType = m_CmdCtx.GetCommandListType();
+
+    D3D12_TEXTURE_BARRIER d3d12Barrier{};
+    InitEnhancedBarrier(d3d12Barrier);
+    d3d12Barrier.LayoutBefore = ResourceStateFlagsToD3D12BarrierLayout(m_OldState, d3d12CmdListType);
+    d3d12Barrier.LayoutAfter  = ResourceStateFlagsToD3D12BarrierLayout(m_NewState, d3d12CmdListType);
+    d3d12Barrier.pResource    = m_pd3d12Resource;
+    d3d12Barrier.Subresources = Subresources;
+    d3d12Barrier.Flags        = D3D12_TEXTURE_BARRIER_FLAG_NONE;
+    m_CmdCtx.TextureBarrier(d3d12Barrier);
+}
+
+void StateTransitionHelper::AddD3D12BufferBarrier()
+{
+    D3D12_BUFFER_BARRIER d3d12Barrier{};
+    InitEnhancedBarrier(d3d12Barrier);
+    d3d12Barrier.pResource = m_pd3d12Resource;
+    d3d12Barrier.Offset    = 0;
+    d3d12Barrier.Size      = UINT64_MAX;
+    m_CmdCtx.BufferBarrier(d3d12Barrier);
+}
+#endif
+
 template <typename ResourceType>
 void StateTransitionHelper::operator()(ResourceType& Resource)
 {
@@ -404,6 +576,7 @@ void StateTransitionHelper::operator()(ResourceType& Resource)
         if ((m_OldState & RESOURCE_STATE_GENERIC_READ) == m_OldState &&
             (NewState & RESOURCE_STATE_GENERIC_READ) == NewState)
             NewState |= m_OldState;
+        m_NewState = NewState;
 
         D3D12_RESOURCE_BARRIER d3d12Barrier;
         d3d12Barrier.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
@@ -429,9 +602,8 @@ void StateTransitionHelper::operator()(ResourceType& Resource)
         // must complete before any future UAV accesses (reads or writes) can begin.
 
         DEV_CHECK_ERR(m_Barrier.TransitionType == STATE_TRANSITION_TYPE_IMMEDIATE, "UAV barriers must not be split");
-        D3D12_RESOURCE_BARRIER d3d12Barrier{D3D12_RESOURCE_BARRIER_TYPE_UAV, D3D12_RESOURCE_BARRIER_FLAG_NONE};
-        d3d12Barrier.UAV.pResource = m_pd3d12Resource;
-        m_CmdCtx.ResourceBarrier(d3d12Barrier);
+        m_NewState = m_Barrier.NewState;
+        AddD3D12UAVBarrier(Resource);
     }
 }
 
@@ -461,9 +633,88 @@ void CommandContext::TransitionResource(TopLevelASD3D12Impl& TLAS, const StateTr
     Helper(TLAS);
 }
 
+static bool BarrierReferencesResource(const D3D12_RESOURCE_BARRIER& Barrier, const ID3D12Resource* pResource)
+{
+    switch (Barrier.Type)
+    {
+        case D3D12_RESOURCE_BARRIER_TYPE_TRANSITION:
+            return Barrier.Transition.pResource == pResource;
+
+        case D3D12_RESOURCE_BARRIER_TYPE_ALIASING:
+            // Null resources in aliasing barriers mean that any placed resource may be aliased
+            return Barrier.Aliasing.pResourceBefore == pResource || Barrier.Aliasing.pResourceAfter == pResource ||
+                Barrier.Aliasing.pResourceBefore == nullptr || Barrier.Aliasing.pResourceAfter == nullptr;
+
+        case D3D12_RESOURCE_BARRIER_TYPE_UAV:
+            return Barrier.UAV.pResource == pResource || Barrier.UAV.pResource == nullptr;
+
+        default:
+            UNEXPECTED("Unexpected barrier type");
+            return true;
+    }
+}
+
+void CommandContext::ResourceBarrier(const D3D12_RESOURCE_BARRIER& Barrier)
+{
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    // Preserve the order of enhanced and legacy barriers
+    FlushEnhancedBarriers();
+#endif
+
+    if (Barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION && Barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE)
+    {
+        // Find the last pending barrier that references the same resource. If it is a transition of the
+        // same subresource that ends in the state this transition starts from, merge the two transitions
+        // as there can be no commands between them.
+        for (auto it = m_PendingResourceBarriers.rbegin(); it != m_PendingResourceBarriers.rend(); ++it)
+        {
+            if (!BarrierReferencesResource(*it, Barrier.Transition.pResource))
+                continue;
+
+            auto& PendingTransition = it->Transition;
+            if (it->Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION &&
+                it->Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE &&
+                PendingTransition.Subresource == Barrier.Transition.Subresource &&
+                PendingTransition.StateAfter == Barrier.Transition.StateBefore)
+            {
+                if (PendingTransition.StateBefore != Barrier.Transition.StateAfter)
+                {
+                    PendingTransition.StateAfter = Barrier.Transition.StateAfter;
+                }
+                else
+                {
+                    // The transitions cancel each other out
+                    m_PendingResourceBarriers.erase(std::next(it).base());
+                    if (m_BarrierCount > 0)
+                        --m_BarrierCount;
+                }
+                return;
+            }
+            break;
+        }
+    }
+    else if (Barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_UAV)
+    {
+        // A UAV barrier for the same resource is already pending and there are no commands in between
+        for (const auto& PendingBarrier : m_PendingResourceBarriers)
+        {
+            if (PendingBarrier.Type == D3D12_RESOURCE_BARRIER_TYPE_UAV && PendingBarrier.UAV.pResource == Barrier.UAV.pResource)
+                return;
+        }
+    }
+
+    m_PendingResourceBarriers.emplace_back(Barrier);
+    ++m_BarrierCount;
+}
+
 void CommandContext::InsertAliasBarrier(D3D12ResourceBase& Before, D3D12ResourceBase& After, bool FlushImmediate)
 {
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    FlushEnhancedBarriers();
+#endif
+
     m_PendingResourceBarriers.emplace_back();
+    ++m_BarrierCount;
     D3D12_RESOURCE_BARRIER& BarrierDesc = m_PendingResourceBarriers.back();
 
     BarrierDesc.Type                     = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
@@ -475,6 +726,103 @@ void CommandContext::InsertAliasBarrier(D3D12ResourceBase& Before, D3D12Resource
         FlushResourceBarriers();
 }
 
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+static bool IsSplitBarrier(D3D12_BARRIER_SYNC SyncBefore, D3D12_BARRIER_SYNC SyncAfter)
+{
+    return SyncBefore == D3D12_BARRIER_SYNC_SPLIT || SyncAfter == D3D12_BARRIER_SYNC_SPLIT;
+}
+
+void CommandContext::TextureBarrier(const D3D12_TEXTURE_BARRIER& Barrier)
+{
+    VERIFY(m_UseEnhancedBarriers, "Enhanced barriers are not supported");
+
+    // Preserve the order of enhanced and legacy barriers
+    if (!m_PendingResourceBarriers.empty())
+        FlushResourceBarriers();
+
+    if (!IsSplitBarrier(Barrier.SyncBefore, Barrier.SyncAfter) && Barrier.Flags == D3D12_TEXTURE_BARRIER_FLAG_NONE)
+    {
+        // Merge with the last pending barrier of the same subresource range if it ends in the
+        // layout this barrier starts from, as there can be no commands between them.
+        for (auto it = m_PendingTextureBarriers.rbegin(); it != m_PendingTextureBarriers.rend(); ++it)
+        {
+            if (it->pResource != Barrier.pResource)
+                continue;
+
+            if (!IsSplitBarrier(it->SyncBefore, it->SyncAfter) &&
+                it->LayoutAfter == Barrier.LayoutBefore &&
+                memcmp(&it->Subresources, &Barrier.Subresources, sizeof(Barrier.Subresources)) == 0)
+            {
+                it->SyncAfter   = Barrier.SyncAfter;
+                it->AccessAfter = Barrier.AccessAfter;
+                it->LayoutAfter = Barrier.LayoutAfter;
+                return;
+            }
+            break;
+        }
+    }
+
+    m_PendingTextureBarriers.emplace_back(Barrier);
+    ++m_BarrierCount;
+}
+
+void CommandContext::BufferBarrier(const D3D12_BUFFER_BARRIER& Barrier)
+{
+    VERIFY(m_UseEnhancedBarriers, "Enhanced barriers are not supported");
+
+    // Preserve the order of enhanced and legacy barriers
+    if (!m_PendingResourceBarriers.empty())
+        FlushResourceBarriers();
+
+    if (!IsSplitBarrier(Barrier.SyncBefore, Barrier.SyncAfter))
+    {
+        for (auto it = m_PendingBufferBarriers.rbegin(); it != m_PendingBufferBarriers.rend(); ++it)
+        {
+            if (it->pResource != Barrier.pResource)
+                continue;
+
+            if (!IsSplitBarrier(it->SyncBefore, it->SyncAfter) &&
+                it->Offset == Barrier.Offset &&
+                it->Size == Barrier.Size)
+            {
+                it->SyncAfter   = Barrier.SyncAfter;
+                it->AccessAfter = Barrier.AccessAfter;
+                return;
+            }
+            break;
+        }
+    }
+
+    m_PendingBufferBarriers.emplace_back(Barrier);
+    ++m_BarrierCount;
+}
+
+void CommandContext::SubmitEnhancedBarriers()
+{
+    D3D12_BARRIER_GROUP BarrierGroups[2] = {};
+    UINT32              NumGroups        = 0;
+    if (!m_PendingTextureBarriers.empty())
+    {
+        auto& Group            = BarrierGroups[NumGroups++];
+        Group.Type             = D3D12_BARRIER_TYPE_TEXTURE;
+        Group.NumBarriers      = static_cast<UINT32>(m_PendingTextureBarriers.size());
+        Group.pTextureBarriers = m_PendingTextureBarriers.data();
+    }
+    if (!m_PendingBufferBarriers.empty())
+    {
+        auto& Group           = BarrierGroups[NumGroups++];
+        Group.Type            = D3D12_BARRIER_TYPE_BUFFER;
+        Group.NumBarriers     = static_cast<UINT32>(m_PendingBufferBarriers.size());
+        Group.pBufferBarriers = m_PendingBufferBarriers.data();
+    }
+
+    static_cast<ID3D12GraphicsCommandList7*>(m_pCommandList.p)->Barrier(NumGroups, BarrierGroups);
+
+    m_PendingTextureBarriers.clear();
+    m_PendingBufferBarriers.clear();
+}
+#endif
+
 #ifdef DILIGENT_USE_PIX
 inline UINT ConvertColor(const float* pColor)
 {
@@ -54,6 +54,9 @@ void CommandListManager::CreateNewCommandList(ID3D12GraphicsCommandList** List,
 
     const IID CmdListIIDs[] =
         {
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+            __uuidof(ID3D12GraphicsCommandList7),
+#endif
 #ifdef D3D12_H_HAS_MESH_SHADER
             __uuidof(ID3D12GraphicsCommandList6),
             __uuidof(ID3D12GraphicsCommandList5),
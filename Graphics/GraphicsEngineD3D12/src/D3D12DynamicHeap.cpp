@@ -78,21 +78,25 @@ D3D12DynamicPage::D3D12DynamicPage(ID3D12Device* pd3d12Device, Uint64 Size)
 D3D12DynamicMemoryManager::D3D12DynamicMemoryManager(IMemoryAllocator&      Allocator,
                                                      RenderDeviceD3D12Impl& DeviceD3D12Impl,
                                                      Uint32                 NumPagesToReserve,
-                                                     Uint64                 PageSize) :
+                                                     Uint64                 PageSize,
+                                                     Uint32                 ShrinkInterval) :
     m_DeviceD3D12Impl{DeviceD3D12Impl},
-    m_AvailablePages(STD_ALLOCATOR_RAW_MEM(AvailablePagesMapElemType, Allocator, "Allocator for multimap<AvailablePagesMapElemType>"))
+    m_AvailablePages(STD_ALLOCATOR_RAW_MEM(AvailablePagesMapElemType, Allocator, "Allocator for multimap<AvailablePagesMapElemType>")),
+    m_ReservedSize{Uint64{NumPagesToReserve} * PageSize},
+    m_ShrinkInterval{ShrinkInterval}
 {
     for (Uint32 i = 0; i < NumPagesToReserve; ++i)
     {
         D3D12DynamicPage Page(m_DeviceD3D12Impl.GetD3D12Device(), PageSize);
         auto             Size = Page.GetSize();
         m_AvailablePages.emplace(Size, std::move(Page));
+        m_AvailableSize += Size;
     }
 }
 
 D3D12DynamicPage D3D12DynamicMemoryManager::AllocatePage(Uint64 SizeInBytes)
 {
-    std::lock_guard<std::mutex> AvailablePagesLock{m_AvailablePagesMtx};
+    std::lock_guard<Threading::EngineMutex> AvailablePagesLock{m_AvailablePagesMtx};
 #ifdef DILIGENT_DEVELOPMENT
     ++m_AllocatedPageCounter;
 #endif
@@ -102,12 +106,69 @@ D3D12DynamicPage D3D12DynamicMemoryManager::AllocatePage(Uint64 SizeInBytes)
         VERIFY_EXPR(PageIt->first >= SizeInBytes);
         D3D12DynamicPage Page(std::move(PageIt->second));
         m_AvailablePages.erase(PageIt);
+        m_AvailableSize -= Page.GetSize();
+        m_UsedSize += Page.GetSize();
+        m_PeakUsedSize      = std::max(m_PeakUsedSize, m_UsedSize);
+        m_FramePeakUsedSize = std::max(m_FramePeakUsedSize, m_UsedSize);
         return Page;
     }
     else
     {
-        return D3D12DynamicPage{m_DeviceD3D12Impl.GetD3D12Device(), SizeInBytes};
+        // No suitable page is available: grow the pool
+        D3D12DynamicPage Page{m_DeviceD3D12Impl.GetD3D12Device(), SizeInBytes};
+        if (Page.IsValid())
+        {
+            ++m_GrowCount;
+            m_UsedSize += Page.GetSize();
+            m_PeakUsedSize      = std::max(m_PeakUsedSize, m_UsedSize);
+            m_FramePeakUsedSize = std::max(m_FramePeakUsedSize, m_UsedSize);
+        }
+        return Page;
+    }
+}
+
+void D3D12DynamicMemoryManager::EndFrame()
+{
+    std::lock_guard<Threading::EngineMutex> AvailablePagesLock{m_AvailablePagesMtx};
+
+    m_LastFramePeakSize    = m_FramePeakUsedSize;
+    m_IntervalPeakUsedSize = std::max(m_IntervalPeakUsedSize, m_FramePeakUsedSize);
+    // The pages handed out during the previous frame may still be in use
+    m_FramePeakUsedSize = m_UsedSize;
+
+    if (m_ShrinkInterval == 0 || ++m_IntervalFrameCount < m_ShrinkInterval)
+        return;
+
+    // Release the largest available pages as long as the remaining pages cover
+    // the peak usage of the interval and the reserved size.
+    const auto TargetSize = std::max(m_IntervalPeakUsedSize, m_ReservedSize);
+    while (!m_AvailablePages.empty())
+    {
+        auto       PageIt   = std::prev(m_AvailablePages.end());
+        const auto PageSize = PageIt->first;
+        if (m_UsedSize + m_AvailableSize < TargetSize + PageSize)
+            break;
+
+        // Available pages are not used by the GPU and can be destroyed immediately
+        m_AvailableSize -= PageSize;
+        m_AvailablePages.erase(PageIt);
+        ++m_ShrinkCount;
     }
+
+    m_IntervalPeakUsedSize = 0;
+    m_IntervalFrameCount   = 0;
+}
+
+void D3D12DynamicMemoryManager::GetStats(DynamicHeapStatsD3D12& Stats)
+{
+    std::lock_guard<Threading::EngineMutex> AvailablePagesLock{m_AvailablePagesMtx};
+
+    Stats.TotalSize         = m_UsedSize + m_AvailableSize;
+    Stats.UsedSize          = m_UsedSize;
+    Stats.PeakUsedSize      = m_PeakUsedSize;
+    Stats.FramePeakUsedSize = m_LastFramePeakSize;
+    Stats.GrowCount         = m_GrowCount;
+    Stats.ShrinkCount       = m_ShrinkCount;
 }
 
 void D3D12DynamicMemoryManager::ReleasePages(std::vector<D3D12DynamicPage>& Pages, Uint64 QueueMask)
@@ -140,12 +201,15 @@ void D3D12DynamicMemoryManager::ReleasePages(std::vector<D3D12DynamicPage>& Page
         {
             if (Mgr != nullptr)
             {
-                std::lock_guard<std::mutex> Lock{Mgr->m_AvailablePagesMtx};
+                std::lock_guard<Threading::EngineMutex> Lock{Mgr->m_AvailablePagesMtx};
 #ifdef DILIGENT_DEVELOPMENT
                 --Mgr->m_AllocatedPageCounter;
 #endif
                 auto PageSize = Page.GetSize();
                 Mgr->m_AvailablePages.emplace(PageSize, std::move(Page));
+                VERIFY_EXPR(Mgr->m_UsedSize >= PageSize);
+                Mgr->m_UsedSize -= PageSize;
+                Mgr->m_AvailableSize += PageSize;
             }
         }
     };
@@ -167,6 +231,7 @@ void D3D12DynamicMemoryManager::Destroy()
                      FormatMemorySize(TotalAllocatedSize, 2));
 
     m_AvailablePages.clear();
+    m_AvailableSize = 0;
 }
 
 D3D12DynamicMemoryManager::~D3D12DynamicMemoryManager()
@@ -0,0 +1,177 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "D3D12ResidencyManager.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace Diligent
+{
+
+D3D12ResidencyManager::D3D12ResidencyManager(ID3D12Device* pd3d12Device, Uint32 EvictionLatency) :
+    m_pd3d12Device{pd3d12Device},
+    m_EvictionLatency{std::max(EvictionLatency, 1u)},
+    m_FrameNumber{1}
+{
+}
+
+void D3D12ResidencyManager::SetHighResidencyPriority(ID3D12Device* pd3d12Device, ID3D12Resource* pd3d12Resource)
+{
+    CComQIPtr<ID3D12Device1> pd3d12Device1{pd3d12Device};
+    if (!pd3d12Device1)
+        return;
+
+    ID3D12Pageable*                pPageable = pd3d12Resource;
+    const D3D12_RESIDENCY_PRIORITY Priority  = D3D12_RESIDENCY_PRIORITY_HIGH;
+    if (FAILED(pd3d12Device1->SetResidencyPriority(1, &pPageable, &Priority)))
+        LOG_WARNING_MESSAGE("Failed to set the residency priority of the resource");
+}
+
+void D3D12ResidencyManager::RegisterResource(D3D12ResourceBase& Resource)
+{
+    auto* const pd3d12Resource = Resource.GetD3D12Resource();
+    VERIFY_EXPR(pd3d12Resource != nullptr);
+
+    const auto d3d12Desc = pd3d12Resource->GetDesc();
+    const auto AllocInfo = m_pd3d12Device->GetResourceAllocationInfo(0, 1, &d3d12Desc);
+
+    auto& Residency = Resource.m_Residency;
+    VERIFY(Residency.Size == 0, "The resource has already been registered");
+    Residency.Size = AllocInfo.SizeInBytes;
+    Residency.LastUsedFrame.store(m_FrameNumber.load());
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Resources.insert(&Resource);
+}
+
+void D3D12ResidencyManager::UnregisterResource(D3D12ResourceBase& Resource)
+{
+    auto& Residency = Resource.m_Residency;
+    if (Residency.Size == 0)
+        return;
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Resources.erase(&Resource);
+    // Evicted resources may be released without being made resident
+    if (Residency.IsEvicted.load())
+        m_EvictedSize.fetch_sub(Residency.Size);
+    Residency.Size = 0;
+}
+
+void D3D12ResidencyManager::MakeResident(D3D12ResourceBase& Resource)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    auto& Residency = Resource.m_Residency;
+    // Another thread may have already made the resource resident
+    if (!Residency.IsEvicted.load())
+        return;
+
+    ID3D12Pageable* pPageable = Resource.GetD3D12Resource();
+    // MakeResident blocks until the resource is resident
+    if (FAILED(m_pd3d12Device->MakeResident(1, &pPageable)))
+    {
+        // The command list that uses the resource must not be submitted, but there is no
+        // way to report the error to the caller. The device will be removed.
+        LOG_ERROR_MESSAGE("Failed to make the resource resident. The system is out of memory.");
+        return;
+    }
+    Residency.IsEvicted.store(false);
+    m_EvictedSize.fetch_sub(Residency.Size);
+}
+
+void D3D12ResidencyManager::EndFrame(const MemoryHeapBudget& LocalBudget, float Threshold)
+{
+    const Uint64 FrameNumber = m_FrameNumber.fetch_add(1);
+
+    const Uint64 TargetUsage = static_cast<Uint64>(static_cast<double>(LocalBudget.Budget) * Threshold);
+    if (LocalBudget.Budget == 0 || LocalBudget.Usage <= TargetUsage)
+        return;
+
+    const Uint64 ExcessSize = LocalBudget.Usage - TargetUsage;
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    // Resources that have been used within the eviction latency may still be referenced
+    // by command lists that the GPU has not finished executing.
+    std::vector<D3D12ResourceBase*> Candidates;
+    for (auto* pResource : m_Resources)
+    {
+        const auto& Residency = pResource->m_Residency;
+        if (!Residency.IsEvicted.load() && Residency.LastUsedFrame.load() + m_EvictionLatency <= FrameNumber)
+            Candidates.push_back(pResource);
+    }
+    if (Candidates.empty())
+        return;
+
+    std::sort(Candidates.begin(), Candidates.end(),
+              [](const D3D12ResourceBase* pRes0, const D3D12ResourceBase* pRes1) {
+                  return pRes0->m_Residency.LastUsedFrame.load() < pRes1->m_Residency.LastUsedFrame.load();
+              });
+
+    std::vector<D3D12ResourceBase*> Evicted;
+    std::vector<ID3D12Pageable*>    Pageables;
+    Uint64                          EvictedSize = 0;
+    for (auto* pResource : Candidates)
+    {
+        if (EvictedSize >= ExcessSize)
+            break;
+
+        auto& Residency = pResource->m_Residency;
+        // Mark the resource as evicted first so that a thread that is about to use it
+        // either sees the flag or its LastUsedFrame update is seen here.
+        Residency.IsEvicted.store(true);
+        if (Residency.LastUsedFrame.load() + m_EvictionLatency > FrameNumber)
+        {
+            // The resource has just been used
+            Residency.IsEvicted.store(false);
+            continue;
+        }
+
+        Evicted.push_back(pResource);
+        Pageables.push_back(pResource->GetD3D12Resource());
+        EvictedSize += Residency.Size;
+    }
+    if (Pageables.empty())
+        return;
+
+    // The mutex is locked, so MakeResident() can't run before Evict() is complete.
+    if (FAILED(m_pd3d12Device->Evict(static_cast<UINT>(Pageables.size()), Pageables.data())))
+    {
+        LOG_WARNING_MESSAGE("Failed to evict ", Pageables.size(), " resources");
+        for (auto* pResource : Evicted)
+            pResource->m_Residency.IsEvicted.store(false);
+        return;
+    }
+
+    m_EvictedSize.fetch_add(EvictedSize);
+}
+
+} // namespace Diligent
@@ -472,6 +472,132 @@ D3D12_RESOURCE_STATES GetSupportedD3D12ResourceStatesForCommandList(D3D12_COMMAN
     }
 }
 
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+D3D12_BARRIER_LAYOUT ResourceStateFlagsToD3D12BarrierLayout(RESOURCE_STATE StateFlags, D3D12_COMMAND_LIST_TYPE CmdListType)
+{
+    // Layouts are derived from the legacy states so that they remain compatible with
+    // the layouts D3D12 assigns to resources created or transitioned with legacy barriers.
+    const auto d3d12States = ResourceStateFlagsToD3D12ResourceStates(StateFlags) & GetSupportedD3D12ResourceStatesForCommandList(CmdListType);
+    switch (d3d12States)
+    {
+        // clang-format off
+        case D3D12_RESOURCE_STATE_COMMON:              return D3D12_BARRIER_LAYOUT_COMMON;
+        case D3D12_RESOURCE_STATE_RENDER_TARGET:       return D3D12_BARRIER_LAYOUT_RENDER_TARGET;
+        case D3D12_RESOURCE_STATE_UNORDERED_ACCESS:    return D3D12_BARRIER_LAYOUT_UNORDERED_ACCESS;
+        case D3D12_RESOURCE_STATE_DEPTH_WRITE:         return D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_WRITE;
+        case D3D12_RESOURCE_STATE_COPY_SOURCE:         return D3D12_BARRIER_LAYOUT_COPY_SOURCE;
+        case D3D12_RESOURCE_STATE_COPY_DEST:           return D3D12_BARRIER_LAYOUT_COPY_DEST;
+        case D3D12_RESOURCE_STATE_RESOLVE_SOURCE:      return D3D12_BARRIER_LAYOUT_RESOLVE_SOURCE;
+        case D3D12_RESOURCE_STATE_RESOLVE_DEST:        return D3D12_BARRIER_LAYOUT_RESOLVE_DEST;
+        case D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE: return D3D12_BARRIER_LAYOUT_SHADING_RATE_SOURCE;
+
+        case D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE:
+        case D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE:
+        case D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE:  return D3D12_BARRIER_LAYOUT_SHADER_RESOURCE;
+            // clang-format on
+
+        default:
+            // Combination of read-only states
+            VERIFY((d3d12States & (D3D12_RESOURCE_STATE_GENERIC_READ | D3D12_RESOURCE_STATE_DEPTH_READ | D3D12_RESOURCE_STATE_RESOLVE_SOURCE | D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE)) == d3d12States,
+                   "Only read-only states can be combined");
+            return (d3d12States & D3D12_RESOURCE_STATE_DEPTH_READ) != 0 ?
+                D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_READ :
+                D3D12_BARRIER_LAYOUT_GENERIC_READ;
+    }
+}
+
+D3D12_BARRIER_ACCESS ResourceStateFlagsToD3D12BarrierAccess(RESOURCE_STATE StateFlags, D3D12_COMMAND_LIST_TYPE CmdListType)
+{
+    const auto d3d12States = ResourceStateFlagsToD3D12ResourceStates(StateFlags) & GetSupportedD3D12ResourceStatesForCommandList(CmdListType);
+    if (d3d12States == D3D12_RESOURCE_STATE_COMMON)
+        return D3D12_BARRIER_ACCESS_COMMON;
+
+    D3D12_BARRIER_ACCESS Access = D3D12_BARRIER_ACCESS_COMMON;
+
+    Uint32 Bits = d3d12States;
+    while (Bits != 0)
+    {
+        const auto lsb = PlatformMisc::GetLSB(Bits);
+        Bits &= ~(1 << lsb);
+        switch (static_cast<D3D12_RESOURCE_STATES>(1 << lsb))
+        {
+            // clang-format off
+            case D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER:        Access |= D3D12_BARRIER_ACCESS_VERTEX_BUFFER | D3D12_BARRIER_ACCESS_CONSTANT_BUFFER; break;
+            case D3D12_RESOURCE_STATE_INDEX_BUFFER:                      Access |= D3D12_BARRIER_ACCESS_INDEX_BUFFER;        break;
+            case D3D12_RESOURCE_STATE_RENDER_TARGET:                     Access |= D3D12_BARRIER_ACCESS_RENDER_TARGET;       break;
+            case D3D12_RESOURCE_STATE_UNORDERED_ACCESS:                  Access |= D3D12_BARRIER_ACCESS_UNORDERED_ACCESS;    break;
+            case D3D12_RESOURCE_STATE_DEPTH_WRITE:                       Access |= D3D12_BARRIER_ACCESS_DEPTH_STENCIL_WRITE; break;
+            case D3D12_RESOURCE_STATE_DEPTH_READ:                        Access |= D3D12_BARRIER_ACCESS_DEPTH_STENCIL_READ;  break;
+            case D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE:         Access |= D3D12_BARRIER_ACCESS_SHADER_RESOURCE;     break;
+            case D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE:             Access |= D3D12_BARRIER_ACCESS_SHADER_RESOURCE;     break;
+            case D3D12_RESOURCE_STATE_STREAM_OUT:                        Access |= D3D12_BARRIER_ACCESS_STREAM_OUTPUT;       break;
+            case D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT:                 Access |= D3D12_BARRIER_ACCESS_INDIRECT_ARGUMENT;   break;
+            case D3D12_RESOURCE_STATE_COPY_DEST:                         Access |= D3D12_BARRIER_ACCESS_COPY_DEST;           break;
+            case D3D12_RESOURCE_STATE_COPY_SOURCE:                       Access |= D3D12_BARRIER_ACCESS_COPY_SOURCE;         break;
+            case D3D12_RESOURCE_STATE_RESOLVE_DEST:                      Access |= D3D12_BARRIER_ACCESS_RESOLVE_DEST;        break;
+            case D3D12_RESOURCE_STATE_RESOLVE_SOURCE:                    Access |= D3D12_BARRIER_ACCESS_RESOLVE_SOURCE;      break;
+            case D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE:               Access |= D3D12_BARRIER_ACCESS_SHADING_RATE_SOURCE; break;
+            case D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE: Access |= D3D12_BARRIER_ACCESS_RAYTRACING_ACCELERATION_STRUCTURE_READ | D3D12_BARRIER_ACCESS_RAYTRACING_ACCELERATION_STRUCTURE_WRITE; break;
+            // clang-format on
+            default:
+                UNEXPECTED("Unexpected D3D12 resource state");
+        }
+    }
+
+    return Access;
+}
+
+D3D12_BARRIER_SYNC ResourceStateFlagsToD3D12BarrierSync(RESOURCE_STATE StateFlags, D3D12_COMMAND_LIST_TYPE CmdListType)
+{
+    static_assert(RESOURCE_STATE_MAX_BIT == (1u << 21), "This function must be updated to handle new resource state flag");
+
+    const auto d3d12States = ResourceStateFlagsToD3D12ResourceStates(StateFlags) & GetSupportedD3D12ResourceStatesForCommandList(CmdListType);
+    if (d3d12States == D3D12_RESOURCE_STATE_COMMON)
+        return D3D12_BARRIER_SYNC_ALL;
+
+    D3D12_BARRIER_SYNC Sync = D3D12_BARRIER_SYNC_NONE;
+
+    Uint32 Bits = d3d12States;
+    while (Bits != 0)
+    {
+        const auto lsb = PlatformMisc::GetLSB(Bits);
+        Bits &= ~(1 << lsb);
+        switch (static_cast<D3D12_RESOURCE_STATES>(1 << lsb))
+        {
+            // clang-format off
+            case D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER: Sync |= D3D12_BARRIER_SYNC_ALL_SHADING;       break;
+            case D3D12_RESOURCE_STATE_INDEX_BUFFER:               Sync |= D3D12_BARRIER_SYNC_INDEX_INPUT;       break;
+            case D3D12_RESOURCE_STATE_RENDER_TARGET:              Sync |= D3D12_BARRIER_SYNC_RENDER_TARGET;     break;
+            case D3D12_RESOURCE_STATE_UNORDERED_ACCESS:           Sync |= D3D12_BARRIER_SYNC_ALL_SHADING;       break;
+            case D3D12_RESOURCE_STATE_DEPTH_WRITE:                Sync |= D3D12_BARRIER_SYNC_DEPTH_STENCIL;     break;
+            case D3D12_RESOURCE_STATE_DEPTH_READ:                 Sync |= D3D12_BARRIER_SYNC_DEPTH_STENCIL;     break;
+            case D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE:  Sync |= D3D12_BARRIER_SYNC_NON_PIXEL_SHADING; break;
+            case D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE:      Sync |= D3D12_BARRIER_SYNC_PIXEL_SHADING;     break;
+            case D3D12_RESOURCE_STATE_STREAM_OUT:                 Sync |= D3D12_BARRIER_SYNC_VERTEX_SHADING;    break;
+            case D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT:          Sync |= D3D12_BARRIER_SYNC_EXECUTE_INDIRECT;  break;
+            case D3D12_RESOURCE_STATE_COPY_DEST:                  Sync |= D3D12_BARRIER_SYNC_COPY;              break;
+            case D3D12_RESOURCE_STATE_COPY_SOURCE:                Sync |= D3D12_BARRIER_SYNC_COPY;              break;
+            case D3D12_RESOURCE_STATE_RESOLVE_DEST:               Sync |= D3D12_BARRIER_SYNC_RESOLVE;           break;
+            case D3D12_RESOURCE_STATE_RESOLVE_SOURCE:             Sync |= D3D12_BARRIER_SYNC_RESOLVE;           break;
+            case D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE:        Sync |= D3D12_BARRIER_SYNC_PIXEL_SHADING;     break;
+            case D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE: Sync |= D3D12_BARRIER_SYNC_RAYTRACING; break;
+            // clang-format on
+            default:
+                UNEXPECTED("Unexpected D3D12 resource state");
+        }
+    }
+
+    // Ray tracing states are mapped to shader resource and unordered access legacy states,
+    // but are accessed by different stages.
+    if ((StateFlags & (RESOURCE_STATE_BUILD_AS_READ | RESOURCE_STATE_BUILD_AS_WRITE)) != 0)
+        Sync |= D3D12_BARRIER_SYNC_BUILD_RAYTRACING_ACCELERATION_STRUCTURE;
+    if ((StateFlags & RESOURCE_STATE_RAY_TRACING) != 0)
+        Sync |= D3D12_BARRIER_SYNC_RAYTRACING;
+
+    return Sync;
+}
+#endif
+
 static RESOURCE_STATE D3D12ResourceStateToResourceStateFlags(D3D12_RESOURCE_STATES state)
 {
     static_assert(RESOURCE_STATE_MAX_BIT == (1u << 21), "This function must be updated to handle new resource state flag");
@@ -29,6 +29,7 @@
 #include "DescriptorHeap.hpp"
 #include "RenderDeviceD3D12Impl.hpp"
 #include "D3D12Utils.h"
+#include "ShaderResourceCacheD3D12.hpp"
 
 namespace Diligent
 {
@@ -252,6 +253,18 @@ void DescriptorHeapAllocationManager::FreeAllocation(DescriptorHeapAllocation&&
 #endif
 }
 
+DescriptorHeapAllocationManager::UsageStats DescriptorHeapAllocationManager::GetUsageStats()
+{
+    std::lock_guard<std::mutex> LockGuard(m_FreeBlockManagerMutex);
+
+    UsageStats Stats;
+    Stats.UsedSize         = static_cast<Uint32>(m_FreeBlockManager.GetUsedSize());
+    Stats.PeakUsedSize     = static_cast<Uint32>(m_MaxAllocatedSize);
+    Stats.NumFreeBlocks    = static_cast<Uint32>(m_FreeBlockManager.GetNumFreeBlocks());
+    Stats.MaxFreeBlockSize = static_cast<Uint32>(m_FreeBlockManager.GetMaxFreeBlockSize());
+    return Stats;
+}
+
 
 
 //
@@ -284,6 +297,14 @@ CPUDescriptorHeap::CPUDescriptorHeap(IMemoryAllocator&           Allocator,
 
 CPUDescriptorHeap::~CPUDescriptorHeap()
 {
+    // Return cached descriptors to the heap managers
+    for (auto& Cache : m_ThreadCaches)
+    {
+        for (const auto& Descriptor : Cache.Descriptors)
+            FreeToPool(MakeAllocation(Descriptor));
+        Cache.Descriptors.clear();
+    }
+
     DEV_CHECK_ERR(m_CurrentSize == 0, "Not all allocations released");
 
     DEV_CHECK_ERR(m_AvailableHeaps.size() == m_HeapPool.size(), "Not all descriptor heap pools are released");
@@ -295,8 +316,8 @@ CPUDescriptorHeap::~CPUDescriptorHeap()
     }
 
     LOG_INFO_MESSAGE(std::setw(38), std::left, GetD3D12DescriptorHeapTypeLiteralName(m_HeapDesc.Type), " CPU heap allocated pool count: ", m_HeapPool.size(),
-                     ". Max descriptors: ", m_MaxSize, '/', TotalDescriptors,
-                     " (", std::fixed, std::setprecision(2), m_MaxSize * 100.0 / std::max(TotalDescriptors, 1u), "%).");
+                     ". Max descriptors: ", m_MaxSize.load(), '/', TotalDescriptors,
+                     " (", std::fixed, std::setprecision(2), m_MaxSize.load() * 100.0 / std::max(TotalDescriptors, 1u), "%).");
 }
 
 #ifdef DILIGENT_DEVELOPMENT
@@ -304,16 +325,131 @@ int32_t CPUDescriptorHeap::DvpGetTotalAllocationCount()
 {
     int32_t AllocationCount = 0;
 
-    std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
-    for (auto& Heap : m_HeapPool)
-        AllocationCount += Heap.DvpGetAllocationsCounter();
+    {
+        std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
+        for (auto& Heap : m_HeapPool)
+            AllocationCount += Heap.DvpGetAllocationsCounter();
+    }
+
+    // Cached descriptors are allocated from the managers, but are not used
+    for (auto& Cache : m_ThreadCaches)
+    {
+        Threading::SpinLockGuard CacheGuard{Cache.Lock};
+        AllocationCount -= static_cast<int32_t>(Cache.Descriptors.size());
+    }
     return AllocationCount;
 }
 #endif
 
+CPUDescriptorHeap::ThreadCache& CPUDescriptorHeap::GetThreadCache()
+{
+    // Threads are assigned to the caches in round-robin order, so that
+    // up to NumThreadCaches threads never contend for the same cache.
+    static std::atomic<size_t> NextCacheIdx{0};
+    thread_local const size_t  CacheIdx = NextCacheIdx.fetch_add(1) % NumThreadCaches;
+    return m_ThreadCaches[CacheIdx];
+}
+
+CPUDescriptorHeap::CachedDescriptor CPUDescriptorHeap::ExtractCachedDescriptor(DescriptorHeapAllocation&& Allocation)
+{
+    VERIFY_EXPR(Allocation.GetNumHandles() == 1);
+
+    CachedDescriptor Descriptor;
+    Descriptor.CpuHandle  = Allocation.GetCpuHandle();
+    Descriptor.GpuHandle  = Allocation.IsShaderVisible() ? Allocation.GetGpuHandle() : D3D12_GPU_DESCRIPTOR_HANDLE{0};
+    Descriptor.pd3d12Heap = Allocation.GetDescriptorHeap();
+    Descriptor.ManagerId  = static_cast<Uint16>(Allocation.GetAllocationManagerId());
+    // The descriptor remains allocated in the manager
+    Allocation.Reset();
+    return Descriptor;
+}
+
+DescriptorHeapAllocation CPUDescriptorHeap::MakeAllocation(const CachedDescriptor& Descriptor)
+{
+    return DescriptorHeapAllocation{*this, Descriptor.pd3d12Heap, Descriptor.CpuHandle, Descriptor.GpuHandle, 1, Descriptor.ManagerId};
+}
+
+void CPUDescriptorHeap::UpdateCurrentSize(Int32 Delta)
+{
+    const auto CurrentSize = static_cast<Uint32>(static_cast<Int32>(m_CurrentSize.fetch_add(static_cast<Uint32>(Delta))) + Delta);
+
+    auto MaxSize = m_MaxSize.load();
+    while (MaxSize < CurrentSize && !m_MaxSize.compare_exchange_weak(MaxSize, CurrentSize))
+    {
+    }
+}
+
 DescriptorHeapAllocation CPUDescriptorHeap::Allocate(uint32_t Count)
 {
+    DescriptorHeapAllocation Allocation;
+    if (Count == 1)
+    {
+        Allocation = AllocateCached();
+    }
+    else
+    {
+        std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
+        Allocation = AllocateFromPool(Count);
+    }
+
+    UpdateCurrentSize(static_cast<Int32>(Allocation.GetNumHandles()));
+
+    return Allocation;
+}
+
+DescriptorHeapAllocation CPUDescriptorHeap::AllocateCached()
+{
+    auto& Cache = GetThreadCache();
+    {
+        Threading::SpinLockGuard CacheGuard{Cache.Lock};
+        if (!Cache.Descriptors.empty())
+        {
+            const auto Descriptor = Cache.Descriptors.back();
+            Cache.Descriptors.pop_back();
+            return MakeAllocation(Descriptor);
+        }
+    }
+
+    // Refill the cache with a chunk of descriptors. Do this outside of the cache lock
+    // as a new descriptor heap may need to be created.
+    std::array<CachedDescriptor, CacheChunkSize> Chunk;
+    {
+        std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
+        for (auto& Descriptor : Chunk)
+            Descriptor = ExtractCachedDescriptor(AllocateFromPool(1));
+    }
+
+    {
+        Threading::SpinLockGuard CacheGuard{Cache.Lock};
+        Cache.Descriptors.insert(Cache.Descriptors.end(), Chunk.begin() + 1, Chunk.end());
+    }
+
+    return MakeAllocation(Chunk[0]);
+}
+
+void CPUDescriptorHeap::FreeCached(DescriptorHeapAllocation&& Allocation)
+{
+    auto& Cache = GetThreadCache();
+
+    std::array<CachedDescriptor, CacheChunkSize> Chunk;
+    {
+        Threading::SpinLockGuard CacheGuard{Cache.Lock};
+        Cache.Descriptors.emplace_back(ExtractCachedDescriptor(std::move(Allocation)));
+        if (Cache.Descriptors.size() <= MaxCachedDescriptors)
+            return;
+
+        // Trim the cache as descriptors may be released by one thread and allocated by another
+        std::copy(Cache.Descriptors.end() - CacheChunkSize, Cache.Descriptors.end(), Chunk.begin());
+        Cache.Descriptors.resize(Cache.Descriptors.size() - CacheChunkSize);
+    }
+
     std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
+    for (const auto& Descriptor : Chunk)
+        FreeToPool(MakeAllocation(Descriptor));
+}
+
+DescriptorHeapAllocation CPUDescriptorHeap::AllocateFromPool(uint32_t Count)
+{
     // Note that every DescriptorHeapAllocationManager object instance is itself
     // thread-safe. Nested mutexes cannot cause a deadlock
 
@@ -357,9 +493,6 @@ DescriptorHeapAllocation CPUDescriptorHeap::Allocate(uint32_t Count)
         Allocation = m_HeapPool[*NewHeapIt.first].Allocate(Count);
     }
 
-    m_CurrentSize += static_cast<Uint32>(Allocation.GetNumHandles());
-    m_MaxSize = std::max(m_MaxSize, m_CurrentSize);
-
     return Allocation;
 }
 
@@ -401,9 +534,23 @@ void CPUDescriptorHeap::Free(DescriptorHeapAllocation&& Allocation, Uint64 CmdQu
 
 void CPUDescriptorHeap::FreeAllocation(DescriptorHeapAllocation&& Allocation)
 {
-    std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
-    auto                        ManagerId = Allocation.GetAllocationManagerId();
-    m_CurrentSize -= static_cast<Uint32>(Allocation.GetNumHandles());
+    const auto NumHandles = Allocation.GetNumHandles();
+    if (NumHandles == 1)
+    {
+        FreeCached(std::move(Allocation));
+    }
+    else
+    {
+        std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
+        FreeToPool(std::move(Allocation));
+    }
+
+    UpdateCurrentSize(-static_cast<Int32>(NumHandles));
+}
+
+void CPUDescriptorHeap::FreeToPool(DescriptorHeapAllocation&& Allocation)
+{
+    auto ManagerId = Allocation.GetAllocationManagerId();
     m_HeapPool[ManagerId].FreeAllocation(std::move(Allocation));
     // Return the manager to the pool of available managers
     VERIFY_EXPR(m_HeapPool[ManagerId].GetNumAvailableDescriptors() > 0);
@@ -438,13 +585,16 @@ GPUDescriptorHeap::GPUDescriptorHeap(IMemoryAllocator&           Allocator,
     },
     m_DescriptorSize           {Device.GetD3D12Device()->GetDescriptorHandleIncrementSize(Type)},
     m_HeapAllocationManager    {Allocator, Device, *this, 0, m_pd3d12DescriptorHeap, 0, NumDescriptorsInHeap},
-    m_DynamicAllocationsManager{Allocator, Device, *this, 1, m_pd3d12DescriptorHeap, NumDescriptorsInHeap, NumDynamicDescriptors}
+    m_DynamicAllocationsManager{Allocator, Device, *this, 1, m_pd3d12DescriptorHeap, NumDescriptorsInHeap, NumDynamicDescriptors},
+    m_RelocatableCaches        (STD_ALLOCATOR_RAW_MEM(ShaderResourceCacheD3D12*, GetRawAllocator(), "Allocator for unordered_set<ShaderResourceCacheD3D12*>"))
 // clang-format on
 {
 }
 
 GPUDescriptorHeap::~GPUDescriptorHeap()
 {
+    DEV_CHECK_ERR(m_RelocatableCaches.empty(), "Not all shader resource caches have been unregistered");
+
     auto TotalStaticSize  = m_HeapAllocationManager.GetMaxDescriptors();
     auto TotalDynamicSize = m_DynamicAllocationsManager.GetMaxDescriptors();
     auto MaxStaticSize    = m_HeapAllocationManager.GetMaxAllocatedSize();
@@ -502,6 +652,95 @@ void GPUDescriptorHeap::Free(DescriptorHeapAllocation&& Allocation, Uint64 CmdQu
     m_DeviceD3D12Impl.SafeReleaseDeviceObject(StaleAllocation{std::move(Allocation), *this}, CmdQueueMask);
 }
 
+void GPUDescriptorHeap::GetStats(GPUDescriptorHeapStatsD3D12& Stats)
+{
+    const auto StaticStats  = m_HeapAllocationManager.GetUsageStats();
+    const auto DynamicStats = m_DynamicAllocationsManager.GetUsageStats();
+
+    Stats.StaticSize             = m_HeapAllocationManager.GetMaxDescriptors();
+    Stats.StaticUsedSize         = StaticStats.UsedSize;
+    Stats.StaticPeakUsedSize     = StaticStats.PeakUsedSize;
+    Stats.StaticFreeBlockCount   = StaticStats.NumFreeBlocks;
+    Stats.StaticMaxFreeBlockSize = StaticStats.MaxFreeBlockSize;
+    Stats.DynamicSize            = m_DynamicAllocationsManager.GetMaxDescriptors();
+    Stats.DynamicUsedSize        = DynamicStats.UsedSize;
+    Stats.DynamicPeakUsedSize    = DynamicStats.PeakUsedSize;
+
+    std::lock_guard<std::mutex> Guard{m_RelocatableCachesMtx};
+    Stats.RelocatableSRBCount = static_cast<Uint32>(m_RelocatableCaches.size());
+}
+
+void GPUDescriptorHeap::RegisterRelocatableCache(ShaderResourceCacheD3D12& Cache)
+{
+    std::lock_guard<std::mutex> Guard{m_RelocatableCachesMtx};
+    auto                        Inserted = m_RelocatableCaches.insert(&Cache).second;
+    VERIFY(Inserted, "The cache has already been registered");
+    (void)Inserted;
+}
+
+void GPUDescriptorHeap::UnregisterRelocatableCache(ShaderResourceCacheD3D12& Cache)
+{
+    std::lock_guard<std::mutex> Guard{m_RelocatableCachesMtx};
+    auto                        NumErased = m_RelocatableCaches.erase(&Cache);
+    VERIFY(NumErased == 1, "The cache has not been registered");
+    (void)NumErased;
+}
+
+Uint32 GPUDescriptorHeap::Compact(Uint32 MaxDescriptorsToMove)
+{
+    if (MaxDescriptorsToMove == 0)
+        return 0;
+
+    std::lock_guard<std::mutex> Guard{m_RelocatableCachesMtx};
+
+    // Process the tables that are located farthest from the start of the heap first
+    std::vector<std::pair<SIZE_T, ShaderResourceCacheD3D12*>> Caches;
+    Caches.reserve(m_RelocatableCaches.size());
+    for (auto* pCache : m_RelocatableCaches)
+    {
+        const auto& Allocation = pCache->GetDescriptorAllocation(m_HeapDesc.Type, ROOT_PARAMETER_GROUP_STATIC_MUTABLE);
+        Caches.emplace_back(Allocation.GetCpuHandle().ptr, pCache);
+    }
+    std::sort(Caches.begin(), Caches.end(),
+              [](const std::pair<SIZE_T, ShaderResourceCacheD3D12*>& lhs, const std::pair<SIZE_T, ShaderResourceCacheD3D12*>& rhs) {
+                  return lhs.first > rhs.first;
+              });
+
+    auto* const pd3d12Device = m_DeviceD3D12Impl.GetD3D12Device();
+
+    Uint32 NumRelocated = 0;
+    for (const auto& CacheInfo : Caches)
+    {
+        // A single free block is the end of the heap, or a hole that cannot be filled
+        // if the end of the heap is fully used.
+        if (m_HeapAllocationManager.GetUsageStats().NumFreeBlocks <= 1)
+            break;
+
+        auto* const pCache         = CacheInfo.second;
+        const auto  NumDescriptors = pCache->GetDescriptorAllocation(m_HeapDesc.Type, ROOT_PARAMETER_GROUP_STATIC_MUTABLE).GetNumHandles();
+        if (NumRelocated + NumDescriptors > MaxDescriptorsToMove)
+            continue;
+
+        auto NewAllocation = m_HeapAllocationManager.Allocate(NumDescriptors);
+        if (NewAllocation.IsNull())
+            continue;
+
+        if (NewAllocation.GetCpuHandle().ptr >= CacheInfo.first)
+        {
+            // The new location is no better than the current one. The allocation has never
+            // been referenced by the GPU and can be released immediately.
+            m_HeapAllocationManager.FreeAllocation(std::move(NewAllocation));
+            continue;
+        }
+
+        // The current allocation will be released once the GPU is done with it
+        pCache->RelocateDescriptorTables(pd3d12Device, m_HeapDesc.Type, std::move(NewAllocation));
+        NumRelocated += NumDescriptors;
+    }
+
+    return NumRelocated;
+}
+
 
 DynamicSuballocationsManager::DynamicSuballocationsManager(IMemoryAllocator&  Allocator,
                                                            GPUDescriptorHeap& ParentGPUHeap,
@@ -41,6 +41,7 @@
 #include "CommandListD3D12Impl.hpp"
 #include "DeviceMemoryD3D12Impl.hpp"
 #include "CommandQueueD3D12Impl.hpp"
+#include "QueryArrayD3D12Impl.hpp"
 
 #include "CommandContext.hpp"
 #include "D3D12TypeConversions.hpp"
@@ -82,6 +83,12 @@ DeviceContextD3D12Impl::DeviceContextD3D12Impl(IReferenceCounters*          pRef
         GetContextObjectName("Dynamic heap", Desc.IsDeferred, Desc.ContextId),
         EngineCI.DynamicHeapPageSize
     },
+    m_TextureUploadHeap
+    {
+        pDeviceD3D12Impl->GetTextureUploadMemoryManager(),
+        GetContextObjectName("Texture upload heap", Desc.IsDeferred, Desc.ContextId),
+        EngineCI.TextureUploadPageSize
+    },
     m_DynamicGPUDescriptorAllocator
     {
         {
@@ -197,6 +204,7 @@ DeviceContextD3D12Impl::~DeviceContextD3D12Impl()
     // Note: as dynamic pages are returned to the global dynamic memory manager hosted by the render device,
     // the dynamic heap can be destroyed before all pages are actually returned to the global manager.
     DEV_CHECK_ERR(m_DynamicHeap.GetAllocatedPagesCount() == 0, "All dynamic pages must have been released by now.");
+    DEV_CHECK_ERR(m_TextureUploadHeap.GetAllocatedPagesCount() == 0, "All texture upload pages must have been released by now.");
 
     for (size_t i = 0; i < _countof(m_DynamicGPUDescriptorAllocator); ++i)
     {
@@ -251,6 +259,38 @@ ID3D12CommandSignature* DeviceContextD3D12Impl::GetDrawIndexedIndirectSignature(
     return Sig;
 }
 
+ID3D12CommandSignature* DeviceContextD3D12Impl::GetExecuteIndirectSignature(const D3D12_INDIRECT_ARGUMENT_DESC* pArgs,
+                                                                            Uint32                              NumArgs,
+                                                                            Uint32                              Stride,
+                                                                            ID3D12RootSignature*                pd3d12RootSig)
+{
+    auto& Key = m_IndirectSignatureKey;
+    Key.assign(reinterpret_cast<const char*>(&Stride), sizeof(Stride));
+    Key.append(reinterpret_cast<const char*>(&pd3d12RootSig), sizeof(pd3d12RootSig));
+    Key.append(reinterpret_cast<const char*>(pArgs), sizeof(*pArgs) * NumArgs);
+
+    auto& Sig = m_ExecuteIndirectSignatures[Key];
+    if (Sig.pd3d12CmdSig == nullptr)
+    {
+        D3D12_COMMAND_SIGNATURE_DESC CmdSignatureDesc{};
+        CmdSignatureDesc.NodeMask         = 0;
+        CmdSignatureDesc.NumArgumentDescs = NumArgs;
+        CmdSignatureDesc.pArgumentDescs   = pArgs;
+        CmdSignatureDesc.ByteStride       = Stride;
+
+        // Root signature is only required when the command signature changes root arguments
+        auto hr = m_pDevice->GetD3D12Device()->CreateCommandSignature(&CmdSignatureDesc, pd3d12RootSig, IID_PPV_ARGS(&Sig.pd3d12CmdSig));
+        if (FAILED(hr))
+        {
+            LOG_ERROR_MESSAGE("Failed to create execute indirect command signature");
+            m_ExecuteIndirectSignatures.erase(Key);
+            return nullptr;
+        }
+        Sig.pd3d12RootSig = pd3d12RootSig;
+    }
+    return Sig.pd3d12CmdSig;
+}
+
 void DeviceContextD3D12Impl::Begin(Uint32 ImmediateContextId)
 {
     DEV_CHECK_ERR(ImmediateContextId < m_pDevice->GetCommandQueueCount(), "ImmediateContextId is out of range");
@@ -262,14 +302,58 @@ void DeviceContextD3D12Impl::Begin(Uint32 ImmediateContextId)
     m_QueryMgr = &m_pDevice->GetQueryMgr(CommandQueueId);
 }
 
+void DeviceContextD3D12Impl::BeginReusable(Uint32 ImmediateContextId)
+{
+    Begin(ImmediateContextId);
+    // The command list is closed when the recording is finished and is not reset
+    // until the command list object is destroyed (see CommandListD3D12Impl).
+    m_IsRecordingReusableCommands = true;
+}
+
+void DeviceContextD3D12Impl::BeginBundle(Uint32 ImmediateContextId)
+{
+    DEV_CHECK_ERR(IsDeferred(), "Only deferred contexts can record bundles");
+    DEV_CHECK_ERR(ImmediateContextId < m_pDevice->GetCommandQueueCount(), "ImmediateContextId is out of range");
+    SoftwareQueueIndex CommandQueueId{ImmediateContextId};
+    const auto         d3d12CmdListType = m_pDevice->GetCommandQueueType(CommandQueueId);
+    DEV_CHECK_ERR(d3d12CmdListType == D3D12_COMMAND_LIST_TYPE_DIRECT, "Bundles can only be executed by graphics contexts");
+    TDeviceContextBase::Begin(DeviceContextIndex{ImmediateContextId}, D3D12CommandListTypeToCmdQueueType(d3d12CmdListType));
+
+    m_CurrCmdCtx = m_pDevice->AllocateBundleContext();
+    m_CurrCmdCtx->SetDynamicGPUDescriptorAllocators(m_DynamicGPUDescriptorAllocator);
+    // Descriptor heaps set in a bundle must match the heaps bound in the command list that executes it.
+    m_CurrCmdCtx->SetDescriptorHeaps(GetShaderDescriptorHeaps());
+    m_QueryMgr = &m_pDevice->GetQueryMgr(CommandQueueId);
+
+    // Bundles are closed when the recording is finished and can be executed any number of times
+    m_IsRecordingReusableCommands = true;
+    m_IsRecordingBundle           = true;
+}
+
+CommandContext::ShaderDescriptorHeaps DeviceContextD3D12Impl::GetShaderDescriptorHeaps()
+{
+    return CommandContext::ShaderDescriptorHeaps{
+        m_pDevice->GetGPUDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV).GetD3D12DescriptorHeap(),
+        m_pDevice->GetGPUDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER).GetD3D12DescriptorHeap(),
+    };
+}
+
 void DeviceContextD3D12Impl::SetPipelineState(IPipelineState* pPipelineState)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_SET_PIPELINE_STATE);
+
+    // Avoid QueryInterface and AddRef/Release when the same PSO is bound again
+    if (IsBoundPipelineState(pPipelineState))
+        return;
+
     RefCntAutoPtr<PipelineStateD3D12Impl> pPipelineStateD3D12{pPipelineState, PipelineStateD3D12Impl::IID_InternalImpl};
     VERIFY(pPipelineState == nullptr || pPipelineStateD3D12 != nullptr, "Unknown pipeline state object implementation");
     if (PipelineStateD3D12Impl::IsSameObject(m_pPipelineState, pPipelineStateD3D12))
         return;
 
     const auto& PSODesc = pPipelineStateD3D12->GetDesc();
+    DEV_CHECK_ERR(pPipelineStateD3D12->GetStatus() == PIPELINE_STATE_STATUS_READY, "Pipeline state '", PSODesc.Name,
+                  "' is not ready and can't be bound. Use IPipelineState::GetStatus() to check the pipeline status.");
 
     bool CommitStates  = false;
     bool CommitScissor = false;
@@ -382,6 +466,10 @@ void DeviceContextD3D12Impl::CommitRootTablesAndViews(RootTableInfo& RootInfo, U
             IsCompute //
         };
 
+    // Dynamic descriptors of all committed signatures are copied with a single call per heap type
+    PipelineResourceSignatureD3D12Impl::DynamicDescriptorCopyBatch DescriptorCopyBatch;
+    CommitAttribs.pDescriptorCopyBatch = &DescriptorCopyBatch;
+
     VERIFY(CommitSRBMask != 0, "This method should not be called when there is nothing to commit");
     while (CommitSRBMask != 0)
     {
@@ -399,6 +487,16 @@ void DeviceContextD3D12Impl::CommitRootTablesAndViews(RootTableInfo& RootInfo, U
         CommitAttribs.BaseRootIndex  = RootSig.GetBaseRootIndex(sign);
         if ((RootInfo.StaleSRBMask & SignBit) != 0)
         {
+#ifdef DILIGENT_DEVELOPMENT
+            if (IsDeferred() && IsRecordingReusableCommands())
+            {
+                const auto& RootParams = pSignature->GetRootParams();
+                DEV_CHECK_ERR(RootParams.GetParameterGroupSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, ROOT_PARAMETER_GROUP_DYNAMIC) == 0 &&
+                                  RootParams.GetParameterGroupSize(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, ROOT_PARAMETER_GROUP_DYNAMIC) == 0,
+                              "Resource signature '", pSignature->GetDesc().Name, "' contains dynamic shader resource variables. Dynamic variables "
+                                                                                  "are not allowed in reusable command lists as their GPU descriptors are recycled at the end of the frame.");
+            }
+#endif
             // Commit root tables for stale SRBs only
             pSignature->CommitRootTables(CommitAttribs);
         }
@@ -420,6 +518,8 @@ void DeviceContextD3D12Impl::CommitRootTablesAndViews(RootTableInfo& RootInfo, U
         }
     }
 
+    DescriptorCopyBatch.Flush(CommitAttribs.pd3d12Device);
+
     VERIFY_EXPR((CommitSRBMask & RootInfo.ActiveSRBMask) == 0);
     RootInfo.StaleSRBMask &= ~RootInfo.ActiveSRBMask;
 }
@@ -433,11 +533,13 @@ void DeviceContextD3D12Impl::TransitionShaderResources(IPipelineState* pPipeline
     auto* pResBindingD3D12Impl = ClassPtrCast<ShaderResourceBindingD3D12Impl>(pShaderResourceBinding);
     auto& ResourceCache        = pResBindingD3D12Impl->GetResourceCache();
 
-    ResourceCache.TransitionResourceStates(CmdCtx, ShaderResourceCacheD3D12::StateTransitionMode::Transition);
+    ResourceCache.TransitionResourceStates(CmdCtx, ShaderResourceCacheD3D12::StateTransitionMode::Transition, *m_pDevice);
 }
 
 void DeviceContextD3D12Impl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_COMMIT_SHADER_RESOURCES);
+
     DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/);
 
     auto* pResBindingD3D12Impl = ClassPtrCast<ShaderResourceBindingD3D12Impl>(pShaderResourceBinding);
@@ -451,15 +553,18 @@ void DeviceContextD3D12Impl::CommitShaderResources(IShaderResourceBinding* pShad
 
     if (StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
     {
-        ResourceCache.TransitionResourceStates(CmdCtx, ShaderResourceCacheD3D12::StateTransitionMode::Transition);
+        ResourceCache.TransitionResourceStates(CmdCtx, ShaderResourceCacheD3D12::StateTransitionMode::Transition, *m_pDevice);
     }
 #ifdef DILIGENT_DEVELOPMENT
     else if (StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_VERIFY)
     {
-        ResourceCache.TransitionResourceStates(CmdCtx, ShaderResourceCacheD3D12::StateTransitionMode::Verify);
+        ResourceCache.TransitionResourceStates(CmdCtx, ShaderResourceCacheD3D12::StateTransitionMode::Verify, *m_pDevice);
     }
 #endif
 
+    if (auto* pResidencyMgr = m_pDevice->GetResidencyManager())
+        ResourceCache.MarkResourcesUsed(*pResidencyMgr);
+
     const auto SRBIndex = pResBindingD3D12Impl->GetBindingIndex();
     auto&      RootInfo = GetRootTableInfo(pSignature->GetPipelineType());
 
@@ -629,6 +734,8 @@ void DeviceContextD3D12Impl::PrepareForDraw(GraphicsContext& GraphCtx, DRAW_FLAG
 #endif
 
     auto& RootInfo = GetRootTableInfo(PIPELINE_TYPE_GRAPHICS);
+    if ((RootInfo.InlineConstantsSRBMask & RootInfo.ActiveSRBMask) != 0)
+        UpdateInlineConstantBuffers(RootInfo);
 #ifdef DILIGENT_DEVELOPMENT
     DvpValidateCommittedShaderResources(RootInfo);
 #endif
@@ -668,7 +775,11 @@ void DeviceContextD3D12Impl::PrepareForIndexedDraw(GraphicsContext& GraphCtx, DR
 
 void DeviceContextD3D12Impl::Draw(const DrawAttribs& Attribs)
 {
-    DvpVerifyDrawArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawArguments(Attribs))
+        return;
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
     PrepareForDraw(GraphCtx, Attribs.Flags);
@@ -681,7 +792,11 @@ void DeviceContextD3D12Impl::Draw(const DrawAttribs& Attribs)
 
 void DeviceContextD3D12Impl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
-    DvpVerifyDrawIndexedArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawIndexedArguments(Attribs))
+        return;
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
     PrepareForIndexedDraw(GraphCtx, Attribs.Flags, Attribs.IndexType);
@@ -716,7 +831,11 @@ void DeviceContextD3D12Impl::PrepareIndirectAttribsBuffer(CommandContext&
 
 void DeviceContextD3D12Impl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 {
-    DvpVerifyDrawIndirectArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawIndirectArguments(Attribs))
+        return;
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
     PrepareForDraw(GraphCtx, Attribs.Flags);
@@ -752,7 +871,11 @@ void DeviceContextD3D12Impl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 
 void DeviceContextD3D12Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs)
 {
-    DvpVerifyDrawIndexedIndirectArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawIndexedIndirectArguments(Attribs))
+        return;
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
     PrepareForIndexedDraw(GraphCtx, Attribs.Flags, Attribs.IndexType);
@@ -789,7 +912,11 @@ void DeviceContextD3D12Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttrib
 
 void DeviceContextD3D12Impl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
-    DvpVerifyDrawMeshArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawMeshArguments(Attribs))
+        return;
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext6();
     PrepareForDraw(GraphCtx, Attribs.Flags);
@@ -803,7 +930,11 @@ void DeviceContextD3D12Impl::DrawMesh(const DrawMeshAttribs& Attribs)
 
 void DeviceContextD3D12Impl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs)
 {
-    DvpVerifyDrawMeshIndirectArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawMeshIndirectArguments(Attribs))
+        return;
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
     PrepareForDraw(GraphCtx, Attribs.Flags);
@@ -834,9 +965,63 @@ void DeviceContextD3D12Impl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Att
     ++m_State.NumCommands;
 }
 
+void DeviceContextD3D12Impl::MultiDraw(const MultiDrawAttribs& Attribs)
+{
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyMultiDrawArguments(Attribs))
+        return;
+
+    // Direct3D12 has no native multi-draw, so commit the root tables, views and
+    // vertex buffers once and record the draw calls for all items back to back.
+    auto& GraphCtx = GetCmdContext().AsGraphicsContext();
+    PrepareForDraw(GraphCtx, Attribs.Flags);
+
+    if (Attribs.NumInstances == 0)
+        return;
+
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        if (Item.NumVertices > 0)
+        {
+            GraphCtx.Draw(Item.NumVertices, Attribs.NumInstances, Item.StartVertexLocation, Attribs.FirstInstanceLocation);
+            ++m_State.NumCommands;
+        }
+    }
+}
+
+void DeviceContextD3D12Impl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
+{
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyMultiDrawIndexedArguments(Attribs))
+        return;
+
+    auto& GraphCtx = GetCmdContext().AsGraphicsContext();
+    PrepareForIndexedDraw(GraphCtx, Attribs.Flags, Attribs.IndexType);
+
+    if (Attribs.NumInstances == 0)
+        return;
+
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        if (Item.NumIndices > 0)
+        {
+            GraphCtx.DrawIndexed(Item.NumIndices, Attribs.NumInstances, Item.FirstIndexLocation, Item.BaseVertex, Attribs.FirstInstanceLocation);
+            ++m_State.NumCommands;
+        }
+    }
+}
+
 void DeviceContextD3D12Impl::PrepareForDispatchCompute(ComputeContext& ComputeCtx)
 {
     auto& RootInfo = GetRootTableInfo(PIPELINE_TYPE_COMPUTE);
+    if ((RootInfo.InlineConstantsSRBMask & RootInfo.ActiveSRBMask) != 0)
+        UpdateInlineConstantBuffers(RootInfo);
 #ifdef DILIGENT_DEVELOPMENT
     DvpValidateCommittedShaderResources(RootInfo);
 #endif
@@ -849,6 +1034,8 @@ void DeviceContextD3D12Impl::PrepareForDispatchCompute(ComputeContext& ComputeCt
 void DeviceContextD3D12Impl::PrepareForDispatchRays(GraphicsContext& GraphCtx)
 {
     auto& RootInfo = GetRootTableInfo(PIPELINE_TYPE_RAY_TRACING);
+    if ((RootInfo.InlineConstantsSRBMask & RootInfo.ActiveSRBMask) != 0)
+        UpdateInlineConstantBuffers(RootInfo);
 #ifdef DILIGENT_DEVELOPMENT
     DvpValidateCommittedShaderResources(RootInfo);
 #endif
@@ -860,7 +1047,11 @@ void DeviceContextD3D12Impl::PrepareForDispatchRays(GraphicsContext& GraphCtx)
 
 void DeviceContextD3D12Impl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
-    DvpVerifyDispatchArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DISPATCH);
+    ++m_FrameStats.DispatchCount;
+
+    if (!VerifyDispatchArguments(Attribs))
+        return;
 
     auto& ComputeCtx = GetCmdContext().AsComputeContext();
     PrepareForDispatchCompute(ComputeCtx);
@@ -873,7 +1064,11 @@ void DeviceContextD3D12Impl::DispatchCompute(const DispatchComputeAttribs& Attri
 
 void DeviceContextD3D12Impl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs)
 {
-    DvpVerifyDispatchIndirectArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DISPATCH);
+    ++m_FrameStats.DispatchCount;
+
+    if (!VerifyDispatchIndirectArguments(Attribs))
+        return;
 
     auto& ComputeCtx = GetCmdContext().AsComputeContext();
     PrepareForDispatchCompute(ComputeCtx);
@@ -887,6 +1082,202 @@ void DeviceContextD3D12Impl::DispatchComputeIndirect(const DispatchComputeIndire
     ++m_State.NumCommands;
 }
 
+void DeviceContextD3D12Impl::ExecuteIndirect(const ExecuteIndirectAttribsD3D12& Attribs)
+{
+    DEV_CHECK_ERR(m_pPipelineState, "ExecuteIndirect command arguments are invalid: no pipeline state is bound.");
+    DEV_CHECK_ERR(Attribs.pArguments != nullptr && Attribs.NumArguments > 0, "ExecuteIndirect command arguments are invalid: at least one argument must be specified.");
+    DEV_CHECK_ERR((Attribs.ArgsStride % 4) == 0, "ExecuteIndirect command arguments are invalid: ArgsStride (", Attribs.ArgsStride, ") must be a multiple of 4.");
+
+    const auto  PipelineType = m_pPipelineState->GetDesc().PipelineType;
+    const auto& RootSig      = m_pPipelineState->GetRootSignature();
+
+    auto& d3d12Args = m_IndirectArgDescs;
+    d3d12Args.resize(Attribs.NumArguments);
+
+    Uint32 ArgsSize         = 0;
+    bool   ChangesVBs       = false;
+    bool   ChangesIB        = false;
+    bool   ChangesRootViews = false;
+    for (Uint32 i = 0; i < Attribs.NumArguments; ++i)
+    {
+        const auto& Arg      = Attribs.pArguments[i];
+        auto&       d3d12Arg = d3d12Args[i];
+        d3d12Arg             = D3D12_INDIRECT_ARGUMENT_DESC{};
+
+        const bool IsLastArg = i + 1 == Attribs.NumArguments;
+        static_assert(INDIRECT_ARGUMENT_TYPE_D3D12_COUNT == 8, "Please update the switch below to handle the new argument type");
+        switch (Arg.Type)
+        {
+            case INDIRECT_ARGUMENT_TYPE_D3D12_DRAW:
+                DEV_CHECK_ERR(PipelineType == PIPELINE_TYPE_GRAPHICS, "Draw argument requires a graphics pipeline, but pipeline '", m_pPipelineState->GetDesc().Name, "' is not.");
+                d3d12Arg.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW;
+                ArgsSize += sizeof(D3D12_DRAW_ARGUMENTS);
+                break;
+
+            case INDIRECT_ARGUMENT_TYPE_D3D12_DRAW_INDEXED:
+                DEV_CHECK_ERR(PipelineType == PIPELINE_TYPE_GRAPHICS, "Indexed draw argument requires a graphics pipeline, but pipeline '", m_pPipelineState->GetDesc().Name, "' is not.");
+                d3d12Arg.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+                ArgsSize += sizeof(D3D12_DRAW_INDEXED_ARGUMENTS);
+                break;
+
+            case INDIRECT_ARGUMENT_TYPE_D3D12_DISPATCH:
+                DEV_CHECK_ERR(PipelineType == PIPELINE_TYPE_COMPUTE, "Dispatch argument requires a compute pipeline, but pipeline '", m_pPipelineState->GetDesc().Name, "' is not.");
+                d3d12Arg.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH;
+                ArgsSize += sizeof(D3D12_DISPATCH_ARGUMENTS);
+                break;
+
+            case INDIRECT_ARGUMENT_TYPE_D3D12_DISPATCH_MESH:
+#ifdef D3D12_H_HAS_MESH_SHADER
+                DEV_CHECK_ERR(PipelineType == PIPELINE_TYPE_MESH, "Mesh dispatch argument requires a mesh pipeline, but pipeline '", m_pPipelineState->GetDesc().Name, "' is not.");
+                d3d12Arg.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH_MESH;
+                ArgsSize += sizeof(D3D12_DISPATCH_MESH_ARGUMENTS);
+                break;
+#else
+                UNSUPPORTED("Mesh shaders are not supported by the Direct3D12 headers this engine was built with.");
+                return;
+#endif
+
+            case INDIRECT_ARGUMENT_TYPE_D3D12_VERTEX_BUFFER_VIEW:
+                DEV_CHECK_ERR(Arg.VertexBufferSlot < MAX_BUFFER_SLOTS, "Vertex buffer slot (", Arg.VertexBufferSlot, ") exceeds the maximum allowed value (", MAX_BUFFER_SLOTS - 1, ").");
+                d3d12Arg.Type              = D3D12_INDIRECT_ARGUMENT_TYPE_VERTEX_BUFFER_VIEW;
+                d3d12Arg.VertexBuffer.Slot = Arg.VertexBufferSlot;
+                ArgsSize += sizeof(D3D12_VERTEX_BUFFER_VIEW);
+                ChangesVBs = true;
+                break;
+
+            case INDIRECT_ARGUMENT_TYPE_D3D12_INDEX_BUFFER_VIEW:
+                d3d12Arg.Type = D3D12_INDIRECT_ARGUMENT_TYPE_INDEX_BUFFER_VIEW;
+                ArgsSize += sizeof(D3D12_INDEX_BUFFER_VIEW);
+                ChangesIB = true;
+                break;
+
+            case INDIRECT_ARGUMENT_TYPE_D3D12_ROOT_VIEW:
+            {
+                DEV_CHECK_ERR(Arg.Name != nullptr && Arg.Name[0] != '\0', "Root view argument ", i, " must have a resource name.");
+
+                const PipelineResourceAttribsD3D12* pResAttribs   = nullptr;
+                Uint32                              BaseRootIndex = 0;
+                for (Uint32 sign = 0; sign < RootSig.GetSignatureCount() && pResAttribs == nullptr; ++sign)
+                {
+                    const auto* pSignature = RootSig.GetResourceSignature(sign);
+                    if (pSignature == nullptr)
+                        continue;
+
+                    const auto ResIndex = pSignature->FindResource(Arg.ShaderStages, Arg.Name);
+                    if (ResIndex != InvalidPipelineResourceIndex)
+                    {
+                        pResAttribs   = &pSignature->GetResourceAttribs(ResIndex);
+                        BaseRootIndex = RootSig.GetBaseRootIndex(sign);
+                    }
+                }
+                if (pResAttribs == nullptr || !pResAttribs->IsRootView())
+                {
+                    LOG_ERROR_MESSAGE("Resource '", Arg.Name, "' used by root view argument ", i, " is ",
+                                      (pResAttribs == nullptr ? "not found in the resource signatures of pipeline '" : "not a root view in pipeline '"),
+                                      m_pPipelineState->GetDesc().Name, "'.");
+                    return;
+                }
+
+                const auto RootIndex = BaseRootIndex + pResAttribs->SRBRootIndex;
+                switch (pResAttribs->GetD3D12RootParamType())
+                {
+                    case D3D12_ROOT_PARAMETER_TYPE_CBV:
+                        d3d12Arg.Type                                  = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT_BUFFER_VIEW;
+                        d3d12Arg.ConstantBufferView.RootParameterIndex = RootIndex;
+                        break;
+
+                    case D3D12_ROOT_PARAMETER_TYPE_SRV:
+                        d3d12Arg.Type                                  = D3D12_INDIRECT_ARGUMENT_TYPE_SHADER_RESOURCE_VIEW;
+                        d3d12Arg.ShaderResourceView.RootParameterIndex = RootIndex;
+                        break;
+
+                    case D3D12_ROOT_PARAMETER_TYPE_UAV:
+                        d3d12Arg.Type                                   = D3D12_INDIRECT_ARGUMENT_TYPE_UNORDERED_ACCESS_VIEW;
+                        d3d12Arg.UnorderedAccessView.RootParameterIndex = RootIndex;
+                        break;
+
+                    default:
+                        UNEXPECTED("Unexpected root view type");
+                }
+                ArgsSize += sizeof(D3D12_GPU_VIRTUAL_ADDRESS);
+                ChangesRootViews = true;
+                break;
+            }
+
+            default:
+                UNEXPECTED("Unexpected indirect argument type");
+                return;
+        }
+
+        const bool IsCommand = (Arg.Type == INDIRECT_ARGUMENT_TYPE_D3D12_DRAW ||
+                                Arg.Type == INDIRECT_ARGUMENT_TYPE_D3D12_DRAW_INDEXED ||
+                                Arg.Type == INDIRECT_ARGUMENT_TYPE_D3D12_DISPATCH ||
+                                Arg.Type == INDIRECT_ARGUMENT_TYPE_D3D12_DISPATCH_MESH);
+        DEV_CHECK_ERR(IsCommand == IsLastArg, "ExecuteIndirect command arguments are invalid: the last argument must be a draw or dispatch command, and all other arguments must be state changes.");
+        (void)IsCommand;
+        (void)IsLastArg;
+    }
+    DEV_CHECK_ERR(Attribs.ArgsStride >= ArgsSize, "ExecuteIndirect command arguments are invalid: ArgsStride (", Attribs.ArgsStride, ") is smaller than the total size of all arguments (", ArgsSize, ").");
+
+    const auto CmdType = Attribs.pArguments[Attribs.NumArguments - 1].Type;
+
+    auto* pd3d12CmdSig = GetExecuteIndirectSignature(d3d12Args.data(), Attribs.NumArguments, Attribs.ArgsStride,
+                                                     ChangesRootViews ? m_pPipelineState->GetD3D12RootSignature() : nullptr);
+    if (pd3d12CmdSig == nullptr)
+        return;
+
+    auto& CmdCtx = GetCmdContext();
+    if (CmdType == INDIRECT_ARGUMENT_TYPE_D3D12_DISPATCH)
+    {
+        PrepareForDispatchCompute(CmdCtx.AsComputeContext());
+    }
+    else if (CmdType == INDIRECT_ARGUMENT_TYPE_D3D12_DRAW_INDEXED && !ChangesIB)
+    {
+        PrepareForIndexedDraw(CmdCtx.AsGraphicsContext(), Attribs.Flags, Attribs.IndexType);
+    }
+    else
+    {
+        PrepareForDraw(CmdCtx.AsGraphicsContext(), Attribs.Flags);
+    }
+
+    ID3D12Resource* pd3d12ArgsBuff          = nullptr;
+    Uint64          BuffDataStartByteOffset = 0;
+    PrepareIndirectAttribsBuffer(CmdCtx, Attribs.pArgsBuffer, Attribs.ArgsBufferStateTransitionMode, pd3d12ArgsBuff, BuffDataStartByteOffset,
+                                 "Execute indirect (DeviceContextD3D12Impl::ExecuteIndirect)");
+
+    ID3D12Resource* pd3d12CountBuff              = nullptr;
+    Uint64          CountBuffDataStartByteOffset = 0;
+    if (Attribs.pCounterBuffer != nullptr)
+    {
+        PrepareIndirectAttribsBuffer(CmdCtx, Attribs.pCounterBuffer, Attribs.CounterBufferStateTransitionMode, pd3d12CountBuff, CountBuffDataStartByteOffset,
+                                     "Counter buffer (DeviceContextD3D12Impl::ExecuteIndirect)");
+    }
+
+    if (Attribs.CommandCount > 0)
+    {
+        CmdCtx.ExecuteIndirect(pd3d12CmdSig,
+                               Attribs.CommandCount,
+                               pd3d12ArgsBuff,
+                               Attribs.ArgsOffset + BuffDataStartByteOffset,
+                               pd3d12CountBuff,
+                               pd3d12CountBuff != nullptr ? Attribs.CounterOffset + CountBuffDataStartByteOffset : 0);
+
+        // States changed by the command signature are undefined after the command,
+        // so restore them at the next draw or dispatch
+        if (ChangesVBs)
+            m_State.bCommittedD3D12VBsUpToDate = false;
+        if (ChangesIB)
+        {
+            m_State.CommittedD3D12IndexBuffer.Release();
+            m_State.bCommittedD3D12IBUpToDate = false;
+        }
+        if (ChangesRootViews)
+            GetRootTableInfo(PipelineType).MakeAllStale();
+    }
+
+    ++m_State.NumCommands;
+}
+
 void DeviceContextD3D12Impl::ClearDepthStencil(ITextureView*                  pView,
                                                CLEAR_DEPTH_STENCIL_FLAGS      ClearFlags,
                                                float                          fDepth,
@@ -896,6 +1287,7 @@ void DeviceContextD3D12Impl::ClearDepthStencil(ITextureView*                  pV
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Direct3D12 does not allow depth-stencil clears inside a render pass");
 
     TDeviceContextBase::ClearDepthStencil(pView);
+    DEV_CHECK_ERR(!m_IsRecordingBundle, "ClearDepthStencil is not allowed in bundles");
 
     auto* pViewD3D12    = ClassPtrCast<ITextureViewD3D12>(pView);
     auto* pTextureD3D12 = ClassPtrCast<TextureD3D12Impl>(pViewD3D12->GetTexture());
@@ -917,6 +1309,7 @@ void DeviceContextD3D12Impl::ClearRenderTarget(ITextureView* pView, const float*
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Direct3D12 does not allow render target clears inside a render pass");
 
     TDeviceContextBase::ClearRenderTarget(pView);
+    DEV_CHECK_ERR(!m_IsRecordingBundle, "ClearRenderTarget is not allowed in bundles");
 
     auto* pViewD3D12 = ClassPtrCast<ITextureViewD3D12>(pView);
 
@@ -950,27 +1343,46 @@ void DeviceContextD3D12Impl::Flush(bool                 RequestNewCmdCtx,
                   "Flushing device context that has ", m_ActiveQueriesCounter,
                   " active queries. Direct3D12 requires that queries are begun and ended in the same command list");
 
-    // TODO: use small_vector
-    std::vector<RenderDeviceD3D12Impl::PooledCommandContext> Contexts;
-    Contexts.reserve(size_t{NumCommandLists} + 1);
+    auto Contexts       = MakeFrameVector<RenderDeviceD3D12Impl::PooledCommandContext>(size_t{NumCommandLists} + 1);
+    auto ClosedCmdLists = MakeFrameVector<ID3D12CommandList*>(size_t{NumCommandLists} + 1);
 
     // First, execute current context
     if (m_CurrCmdCtx)
     {
         VERIFY(!IsDeferred(), "Deferred contexts cannot execute command lists directly");
+        ResolvePendingQueries();
+        m_FrameStats.BarrierCount += m_CurrCmdCtx->ExtractBarrierCount();
         if (m_State.NumCommands != 0)
+        {
             Contexts.emplace_back(std::move(m_CurrCmdCtx));
+            ClosedCmdLists.emplace_back(nullptr);
+        }
         else
             m_pDevice->DisposeCommandContext(std::move(m_CurrCmdCtx));
     }
+    VERIFY(Contexts.size() == 1 || m_PendingBundles.empty(), "Pending bundles must be submitted along with the current command context");
 
     // Next, add extra command lists from deferred contexts
+    bool HasReusableCmdLists = false;
     for (Uint32 i = 0; i < NumCommandLists; ++i)
     {
         auto* const pCmdListD3D12 = ClassPtrCast<CommandListD3D12Impl>(ppCommandLists[i]);
+        DEV_CHECK_ERR(pCmdListD3D12 != nullptr, "Command list must not be null");
+        DEV_CHECK_ERR(!pCmdListD3D12->IsBundle(), "Bundles must not be submitted along with regular command lists");
+
+        if (pCmdListD3D12->IsReusable())
+        {
+            // Reusable command lists are already closed and keep their command contexts
+            Contexts.emplace_back();
+            ClosedCmdLists.emplace_back(pCmdListD3D12->GetClosedD3D12CommandList());
+            pCmdListD3D12->GetDeferredContext()->UpdateSubmittedBuffersCmdQueueMask(GetCommandQueueId());
+            HasReusableCmdLists = true;
+            continue;
+        }
 
         RefCntAutoPtr<DeviceContextD3D12Impl> pDeferredCtx;
         Contexts.emplace_back(pCmdListD3D12->Close(pDeferredCtx));
+        ClosedCmdLists.emplace_back(nullptr);
         VERIFY(Contexts.back() && pDeferredCtx, "Trying to execute empty command buffer");
         // Set the bit in the deferred context cmd queue mask corresponding to the cmd queue of this context
         pDeferredCtx->UpdateSubmittedBuffersCmdQueueMask(GetCommandQueueId());
@@ -978,9 +1390,24 @@ void DeviceContextD3D12Impl::Flush(bool                 RequestNewCmdCtx,
 
     if (!Contexts.empty())
     {
-        m_pDevice->CloseAndExecuteCommandContexts(GetCommandQueueId(), static_cast<Uint32>(Contexts.size()), Contexts.data(), true, &m_SignalFences, &m_WaitFences);
+        const auto FenceValue = m_pDevice->CloseAndExecuteCommandContexts(GetCommandQueueId(), static_cast<Uint32>(Contexts.size()), Contexts.data(), true,
+                                                                          &m_SignalFences, &m_WaitFences, ClosedCmdLists.data());
         m_SignalFences.clear();
 
+        if (HasReusableCmdLists)
+        {
+            for (Uint32 i = 0; i < NumCommandLists; ++i)
+            {
+                auto* const pCmdListD3D12 = ClassPtrCast<CommandListD3D12Impl>(ppCommandLists[i]);
+                if (pCmdListD3D12->IsReusable())
+                    pCmdListD3D12->SetLastSubmittedFenceValue(GetCommandQueueId(), FenceValue);
+            }
+        }
+
+        for (auto& pBundle : m_PendingBundles)
+            pBundle->SetLastSubmittedFenceValue(GetCommandQueueId(), FenceValue);
+        m_PendingBundles.clear();
+
 #ifdef DILIGENT_DEBUG
         for (Uint32 i = 0; i < NumCommandLists; ++i)
             VERIFY(!Contexts[i], "All contexts must be disposed by CloseAndExecuteCommandContexts");
@@ -1061,15 +1488,35 @@ void DeviceContextD3D12Impl::FinishFrame()
     const auto QueueMask = GetSubmittedBuffersCmdQueueMask();
     VERIFY_EXPR(IsDeferred() || QueueMask == (Uint64{1} << GetCommandQueueId()));
 
+    if (m_CurrCmdCtx)
+        m_FrameStats.BarrierCount += m_CurrCmdCtx->ExtractBarrierCount();
+    m_FrameStats.DynamicHeapBytes = m_DynamicHeap.GetCurrUsedSize();
+    m_FrameStats.UploadHeapBytes  = m_TextureUploadHeap.GetCurrUsedSize();
+    for (size_t i = 0; i < _countof(m_DynamicGPUDescriptorAllocator); ++i)
+        m_FrameStats.DescriptorAllocationCount += m_DynamicGPUDescriptorAllocator[i].GetCurrDescriptorCount();
+
     // Released pages are returned to the global dynamic memory manager hosted by render device.
     m_DynamicHeap.ReleaseAllocatedPages(QueueMask);
+    m_TextureUploadHeap.ReleaseAllocatedPages(QueueMask);
 
     // Dynamic GPU descriptor allocations are returned to the global GPU descriptor heap
     // hosted by the render device.
     for (size_t i = 0; i < _countof(m_DynamicGPUDescriptorAllocator); ++i)
         m_DynamicGPUDescriptorAllocator[i].ReleaseAllocations(QueueMask);
 
+    // Submit the initial data copies of the resources created during this frame
+    if (!IsDeferred())
+        m_pDevice->FlushInitialDataBatch(GetCommandQueueId());
+
     EndFrame();
+
+    if (!IsDeferred() && GetContextId() == 0)
+    {
+        m_pDevice->GetDynamicMemoryManager().EndFrame();
+
+        if (auto* pResidencyMgr = m_pDevice->GetResidencyManager())
+            pResidencyMgr->EndFrame(m_pDevice->GetMemoryBudget().Local, m_pDevice->GetMemoryPressureThreshold());
+    }
 }
 
 void DeviceContextD3D12Impl::SetVertexBuffers(Uint32                         StartSlot,
@@ -1116,6 +1563,10 @@ void DeviceContextD3D12Impl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOf
 
 void DeviceContextD3D12Impl::CommitViewports()
 {
+    // Bundles inherit viewports from the command list that executes them
+    if (m_IsRecordingBundle)
+        return;
+
     static_assert(MAX_VIEWPORTS >= D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE, "MaxViewports constant must be greater than D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE");
     D3D12_VIEWPORT d3d12Viewports[MAX_VIEWPORTS]; // Do not waste time initializing array to zero
 
@@ -1172,6 +1623,10 @@ static constexpr RECT MaxD3D12TexSizeRects[D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT
 
 void DeviceContextD3D12Impl::CommitScissorRects(GraphicsContext& GraphCtx, bool ScissorEnable)
 {
+    // Bundles inherit scissor rects from the command list that executes them
+    if (m_IsRecordingBundle)
+        return;
+
     if (ScissorEnable)
     {
         // Commit currently set scissor rectangles
@@ -1220,6 +1675,10 @@ void DeviceContextD3D12Impl::CommitRenderTargets(RESOURCE_STATE_TRANSITION_MODE
 {
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "This method must not be called inside a render pass");
 
+    // Bundles inherit render targets from the command list that executes them
+    if (m_IsRecordingBundle)
+        return;
+
     const Uint32 MaxD3D12RTs      = D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT;
     Uint32       NumRenderTargets = m_NumBoundRenderTargets;
     VERIFY(NumRenderTargets <= MaxD3D12RTs, "D3D12 only allows 8 simultaneous render targets");
@@ -1538,6 +1997,7 @@ void DeviceContextD3D12Impl::CommitSubpassRenderTargets()
 void DeviceContextD3D12Impl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
 {
     TDeviceContextBase::BeginRenderPass(Attribs);
+    DEV_CHECK_ERR(!m_IsRecordingBundle, "BeginRenderPass is not allowed in bundles");
 
     m_AttachmentClearValues.resize(Attribs.ClearValueCount);
     for (Uint32 i = 0; i < Attribs.ClearValueCount; ++i)
@@ -1568,6 +2028,7 @@ void DeviceContextD3D12Impl::EndRenderPass()
 
 D3D12DynamicAllocation DeviceContextD3D12Impl::AllocateDynamicSpace(Uint64 NumBytes, Uint32 Alignment)
 {
+    DEV_CHECK_ERR(!IsDeferred() || !IsRecordingReusableCommands(), "Dynamic memory must not be allocated in reusable command lists as it is recycled at the end of the frame");
     return m_DynamicHeap.Allocate(NumBytes, Alignment, GetFrameNumber());
 }
 
@@ -1599,6 +2060,7 @@ void DeviceContextD3D12Impl::UpdateBuffer(IBuffer*                       pBuffer
     // be resource barrier issues in the cmd list in the device context
     auto* pBuffD3D12 = ClassPtrCast<BufferD3D12Impl>(pBuffer);
     VERIFY(pBuffD3D12->GetDesc().Usage != USAGE_DYNAMIC, "Dynamic buffers must be updated via Map()");
+    DEV_CHECK_ERR(!IsDeferred() || !IsRecordingReusableCommands(), "UpdateBuffer() is not allowed in reusable command lists as the upload memory is recycled at the end of the frame");
     constexpr size_t DefaultAlignment = 16;
     auto             TmpSpace         = m_DynamicHeap.Allocate(Size, DefaultAlignment, GetFrameNumber());
     memcpy(TmpSpace.CPUAddress, pData, StaticCast<size_t>(Size));
@@ -1614,6 +2076,7 @@ void DeviceContextD3D12Impl::CopyBuffer(IBuffer*                       pSrcBuffe
                                         RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode)
 {
     TDeviceContextBase::CopyBuffer(pSrcBuffer, SrcOffset, SrcBufferTransitionMode, pDstBuffer, DstOffset, Size, DstBufferTransitionMode);
+    DEV_CHECK_ERR(!m_IsRecordingBundle, "CopyBuffer is not allowed in bundles");
 
     auto* pSrcBuffD3D12 = ClassPtrCast<BufferD3D12Impl>(pSrcBuffer);
     auto* pDstBuffD3D12 = ClassPtrCast<BufferD3D12Impl>(pDstBuffer);
@@ -1637,6 +2100,8 @@ void DeviceContextD3D12Impl::CopyBuffer(IBuffer*                       pSrcBuffe
 
 void DeviceContextD3D12Impl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_MAP_BUFFER);
+
     TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
     auto*       pBufferD3D12   = ClassPtrCast<BufferD3D12Impl>(pBuffer);
     const auto& BuffDesc       = pBufferD3D12->GetDesc();
@@ -1713,6 +2178,8 @@ void DeviceContextD3D12Impl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_F
 
 void DeviceContextD3D12Impl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_UNMAP_BUFFER);
+
     TDeviceContextBase::UnmapBuffer(pBuffer, MapType);
     auto*       pBufferD3D12   = ClassPtrCast<BufferD3D12Impl>(pBuffer);
     const auto& BuffDesc       = pBufferD3D12->GetDesc();
@@ -1793,7 +2260,7 @@ void DeviceContextD3D12Impl::UpdateTexture(ITexture*                      pTextu
     }
     else
     {
-        CopyTextureRegion(SubresData.pSrcBuffer, 0, SubresData.Stride, SubresData.DepthStride,
+        CopyTextureRegion(SubresData.pSrcBuffer, SubresData.SrcOffset, SubresData.Stride, SubresData.DepthStride,
                           *pTexD3D12, DstSubResIndex, *pBox,
                           SrcBufferTransitionMode, TextureTransitionMode);
     }
@@ -1802,6 +2269,7 @@ void DeviceContextD3D12Impl::UpdateTexture(ITexture*                      pTextu
 void DeviceContextD3D12Impl::CopyTexture(const CopyTextureAttribs& CopyAttribs)
 {
     TDeviceContextBase::CopyTexture(CopyAttribs);
+    DEV_CHECK_ERR(!m_IsRecordingBundle, "CopyTexture is not allowed in bundles");
 
     auto* pSrcTexD3D12 = ClassPtrCast<TextureD3D12Impl>(CopyAttribs.pSrcTexture);
     auto* pDstTexD3D12 = ClassPtrCast<TextureD3D12Impl>(CopyAttribs.pDstTexture);
@@ -1901,6 +2369,22 @@ void DeviceContextD3D12Impl::CopyTextureRegion(ID3D12Resource*                pd
                                                Uint32                         DstSubResIndex,
                                                const Box&                     DstBox,
                                                RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode)
+{
+    TextureCopyChunk Chunk;
+    Chunk.pd3d12Buffer   = pd3d12Buffer;
+    Chunk.SrcOffset      = SrcOffset;
+    Chunk.SrcStride      = SrcStride;
+    Chunk.SrcDepthStride = SrcDepthStride;
+    Chunk.BufferSize     = BufferSize;
+    Chunk.DstBox         = DstBox;
+    CopyTextureChunks(&Chunk, 1, TextureD3D12, DstSubResIndex, TextureTransitionMode);
+}
+
+void DeviceContextD3D12Impl::CopyTextureChunks(const TextureCopyChunk*        pChunks,
+                                               Uint32                         NumChunks,
+                                               TextureD3D12Impl&              TextureD3D12,
+                                               Uint32                         DstSubResIndex,
+                                               RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode)
 {
     const auto& TexDesc = TextureD3D12.GetDesc();
     auto&       CmdCtx  = GetCmdContext();
@@ -1935,42 +2419,50 @@ void DeviceContextD3D12Impl::CopyTextureRegion(ID3D12Resource*                pd
     DstLocation.pResource        = TextureD3D12.GetD3D12Resource();
     DstLocation.SubresourceIndex = StaticCast<UINT>(DstSubResIndex);
 
-    D3D12_TEXTURE_COPY_LOCATION SrcLocation;
-    SrcLocation.Type                              = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-    SrcLocation.pResource                         = pd3d12Buffer;
-    D3D12_PLACED_SUBRESOURCE_FOOTPRINT& Footprint = SrcLocation.PlacedFootprint;
-    Footprint.Offset                              = SrcOffset;
-    Footprint.Footprint.Width                     = StaticCast<UINT>(DstBox.Width());
-    Footprint.Footprint.Height                    = StaticCast<UINT>(DstBox.Height());
-    Footprint.Footprint.Depth                     = StaticCast<UINT>(DstBox.Depth()); // Depth cannot be 0
-    Footprint.Footprint.Format                    = TexFormatToDXGI_Format(TexDesc.Format);
+    const auto DXGIFormat = TexFormatToDXGI_Format(TexDesc.Format);
+
+    CmdCtx.FlushResourceBarriers();
+    for (Uint32 i = 0; i < NumChunks; ++i)
+    {
+        const auto& Chunk  = pChunks[i];
+        const auto& DstBox = Chunk.DstBox;
+
+        D3D12_TEXTURE_COPY_LOCATION SrcLocation;
+        SrcLocation.Type                              = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+        SrcLocation.pResource                         = Chunk.pd3d12Buffer;
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT& Footprint = SrcLocation.PlacedFootprint;
+        Footprint.Offset                              = Chunk.SrcOffset;
+        Footprint.Footprint.Width                     = StaticCast<UINT>(DstBox.Width());
+        Footprint.Footprint.Height                    = StaticCast<UINT>(DstBox.Height());
+        Footprint.Footprint.Depth                     = StaticCast<UINT>(DstBox.Depth()); // Depth cannot be 0
+        Footprint.Footprint.Format                    = DXGIFormat;
 
-    Footprint.Footprint.RowPitch = StaticCast<UINT>(SrcStride);
+        Footprint.Footprint.RowPitch = StaticCast<UINT>(Chunk.SrcStride);
 
 #ifdef DILIGENT_DEBUG
-    {
-        const auto&  FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
-        const Uint32 RowCount   = std::max((Footprint.Footprint.Height / FmtAttribs.BlockHeight), 1u);
-        VERIFY(BufferSize >= Uint64{Footprint.Footprint.RowPitch} * RowCount * Footprint.Footprint.Depth, "Buffer is not large enough");
-        VERIFY(Footprint.Footprint.Depth == 1 || StaticCast<UINT>(SrcDepthStride) == Footprint.Footprint.RowPitch * RowCount, "Depth stride must be equal to the size of 2D plane");
-    }
+        {
+            const auto&  FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+            const Uint32 RowCount   = std::max((Footprint.Footprint.Height / FmtAttribs.BlockHeight), 1u);
+            VERIFY(Chunk.BufferSize >= Uint64{Footprint.Footprint.RowPitch} * RowCount * Footprint.Footprint.Depth, "Buffer is not large enough");
+            VERIFY(Footprint.Footprint.Depth == 1 || StaticCast<UINT>(Chunk.SrcDepthStride) == Footprint.Footprint.RowPitch * RowCount, "Depth stride must be equal to the size of 2D plane");
+        }
 #endif
 
-    D3D12_BOX D3D12SrcBox;
-    D3D12SrcBox.left   = 0;
-    D3D12SrcBox.right  = Footprint.Footprint.Width;
-    D3D12SrcBox.top    = 0;
-    D3D12SrcBox.bottom = Footprint.Footprint.Height;
-    D3D12SrcBox.front  = 0;
-    D3D12SrcBox.back   = Footprint.Footprint.Depth;
-    CmdCtx.FlushResourceBarriers();
-    CmdCtx.GetCommandList()->CopyTextureRegion(&DstLocation,
-                                               StaticCast<UINT>(DstBox.MinX),
-                                               StaticCast<UINT>(DstBox.MinY),
-                                               StaticCast<UINT>(DstBox.MinZ),
-                                               &SrcLocation, &D3D12SrcBox);
+        D3D12_BOX D3D12SrcBox;
+        D3D12SrcBox.left   = 0;
+        D3D12SrcBox.right  = Footprint.Footprint.Width;
+        D3D12SrcBox.top    = 0;
+        D3D12SrcBox.bottom = Footprint.Footprint.Height;
+        D3D12SrcBox.front  = 0;
+        D3D12SrcBox.back   = Footprint.Footprint.Depth;
+        CmdCtx.GetCommandList()->CopyTextureRegion(&DstLocation,
+                                                   StaticCast<UINT>(DstBox.MinX),
+                                                   StaticCast<UINT>(DstBox.MinY),
+                                                   StaticCast<UINT>(DstBox.MinZ),
+                                                   &SrcLocation, &D3D12SrcBox);
 
-    ++m_State.NumCommands;
+        ++m_State.NumCommands;
+    }
 
     if (StateTransitionRequired)
     {
@@ -2013,14 +2505,13 @@ void DeviceContextD3D12Impl::CopyTextureRegion(IBuffer*                       pS
                       pBufferD3D12->GetDesc().Size, TextureD3D12, DstSubResIndex, DstBox, TextureTransitionMode);
 }
 
-DeviceContextD3D12Impl::TextureUploadSpace DeviceContextD3D12Impl::AllocateTextureUploadSpace(TEXTURE_FORMAT TexFmt,
-                                                                                              const Box&     Region)
+DeviceContextD3D12Impl::TextureUploadSpace DeviceContextD3D12Impl::GetTextureUploadLayout(TEXTURE_FORMAT TexFmt,
+                                                                                          const Box&     Region)
 {
     TextureUploadSpace UploadSpace;
     VERIFY_EXPR(Region.IsValid());
     auto UpdateRegionWidth  = Region.Width();
     auto UpdateRegionHeight = Region.Height();
-    auto UpdateRegionDepth  = Region.Depth();
 
     const auto& FmtAttribs = GetTextureFormatAttribs(TexFmt);
     if (FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
@@ -2037,12 +2528,21 @@ DeviceContextD3D12Impl::TextureUploadSpace DeviceContextD3D12Impl::AllocateTextu
         UploadSpace.RowCount = UpdateRegionHeight;
     }
     // RowPitch must be a multiple of 256 (aka. D3D12_TEXTURE_DATA_PITCH_ALIGNMENT)
-    UploadSpace.Stride        = (UploadSpace.RowSize + D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1) & ~(D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1);
-    UploadSpace.DepthStride   = UploadSpace.RowCount * UploadSpace.Stride;
-    const auto MemorySize     = UpdateRegionDepth * UploadSpace.DepthStride;
-    UploadSpace.Allocation    = AllocateDynamicSpace(MemorySize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+    UploadSpace.Stride      = (UploadSpace.RowSize + D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1) & ~(D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1);
+    UploadSpace.DepthStride = UploadSpace.RowCount * UploadSpace.Stride;
+    UploadSpace.Region      = Region;
+
+    return UploadSpace;
+}
+
+DeviceContextD3D12Impl::TextureUploadSpace DeviceContextD3D12Impl::AllocateTextureUploadSpace(TEXTURE_FORMAT TexFmt,
+                                                                                              const Box&     Region)
+{
+    auto UploadSpace = GetTextureUploadLayout(TexFmt, Region);
+    DEV_CHECK_ERR(!IsDeferred() || !IsRecordingReusableCommands(), "Texture upload memory must not be allocated in reusable command lists as it is recycled at the end of the frame");
+    const auto MemorySize     = Region.Depth() * UploadSpace.DepthStride;
+    UploadSpace.Allocation    = m_TextureUploadHeap.Allocate(MemorySize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT, GetFrameNumber());
     UploadSpace.AlignedOffset = (UploadSpace.Allocation.Offset + (D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1)) & ~(D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1);
-    UploadSpace.Region        = Region;
 
     return UploadSpace;
 }
@@ -2056,38 +2556,78 @@ void DeviceContextD3D12Impl::UpdateTextureRegion(const void*
                                                  RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode)
 {
     const auto& TexDesc           = TextureD3D12.GetDesc();
-    auto        UploadSpace       = AllocateTextureUploadSpace(TexDesc.Format, DstBox);
-    auto        UpdateRegionDepth = DstBox.Depth();
+    const auto  Layout            = GetTextureUploadLayout(TexDesc.Format, DstBox);
+    const auto  UpdateRegionDepth = DstBox.Depth();
 #ifdef DILIGENT_DEBUG
     {
-        VERIFY(SrcStride >= UploadSpace.RowSize, "Source data stride (", SrcStride, ") is below the image row size (", UploadSpace.RowSize, ")");
-        const auto PlaneSize = SrcStride * UploadSpace.RowCount;
+        VERIFY(SrcStride >= Layout.RowSize, "Source data stride (", SrcStride, ") is below the image row size (", Layout.RowSize, ")");
+        const auto PlaneSize = SrcStride * Layout.RowCount;
         VERIFY(UpdateRegionDepth == 1 || SrcDepthStride >= PlaneSize, "Source data depth stride (", SrcDepthStride, ") is below the image plane size (", PlaneSize, ")");
     }
 #endif
-    const auto AlignedOffset = UploadSpace.AlignedOffset;
 
-    for (Uint32 DepthSlice = 0; DepthSlice < UpdateRegionDepth; ++DepthSlice)
+    // Split updates that do not fit into one upload page into chunks of whole depth slices
+    // or, if a single slice does not fit, of whole block rows, so that the upload heap never
+    // needs to create a new page that is larger than the default page size.
+    const auto PageSize       = m_TextureUploadHeap.GetPageSize();
+    Uint32     SlicesPerChunk = UpdateRegionDepth;
+    Uint32     RowsPerChunk   = Layout.RowCount;
+    if (Layout.DepthStride * UpdateRegionDepth > PageSize)
     {
-        for (Uint32 row = 0; row < UploadSpace.RowCount; ++row)
+        SlicesPerChunk = static_cast<Uint32>(std::max(PageSize / Layout.DepthStride, Uint64{1}));
+        if (Layout.DepthStride > PageSize)
+            RowsPerChunk = static_cast<Uint32>(std::max(PageSize / Layout.Stride, Uint64{1}));
+    }
+
+    const auto& FmtAttribs  = GetTextureFormatAttribs(TexDesc.Format);
+    const auto  BlockHeight = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED ? Uint32{FmtAttribs.BlockHeight} : 1u;
+
+    m_TextureCopyChunks.clear();
+    for (Uint32 FirstSlice = 0; FirstSlice < UpdateRegionDepth; FirstSlice += SlicesPerChunk)
+    {
+        for (Uint32 FirstRow = 0; FirstRow < Layout.RowCount; FirstRow += RowsPerChunk)
         {
-            const auto* pSrcPtr =
-                reinterpret_cast<const Uint8*>(pSrcData) + row * SrcStride + DepthSlice * SrcDepthStride;
-            auto* pDstPtr =
-                reinterpret_cast<Uint8*>(UploadSpace.Allocation.CPUAddress) + (AlignedOffset - UploadSpace.Allocation.Offset) + row * UploadSpace.Stride + DepthSlice * UploadSpace.DepthStride;
+            Box ChunkBox = DstBox;
+            ChunkBox.MinZ += FirstSlice;
+            ChunkBox.MaxZ = std::min(ChunkBox.MinZ + SlicesPerChunk, DstBox.MaxZ);
+            ChunkBox.MinY += FirstRow * BlockHeight;
+            ChunkBox.MaxY = std::min(ChunkBox.MinY + RowsPerChunk * BlockHeight, DstBox.MaxY);
+
+            const auto UploadSpace = AllocateTextureUploadSpace(TexDesc.Format, ChunkBox);
+            if (UploadSpace.Allocation.CPUAddress == nullptr)
+            {
+                LOG_ERROR_MESSAGE("Failed to allocate ", UploadSpace.DepthStride * ChunkBox.Depth(), " bytes in the texture upload heap");
+                return;
+            }
+
+            const auto  AlignedOffset = UploadSpace.AlignedOffset;
+            const auto* pSrcChunkData = reinterpret_cast<const Uint8*>(pSrcData) + FirstRow * SrcStride + FirstSlice * SrcDepthStride;
+
+            for (Uint32 DepthSlice = 0; DepthSlice < ChunkBox.Depth(); ++DepthSlice)
+            {
+                for (Uint32 row = 0; row < UploadSpace.RowCount; ++row)
+                {
+                    const auto* pSrcPtr =
+                        pSrcChunkData + row * SrcStride + DepthSlice * SrcDepthStride;
+                    auto* pDstPtr =
+                        reinterpret_cast<Uint8*>(UploadSpace.Allocation.CPUAddress) + (AlignedOffset - UploadSpace.Allocation.Offset) + row * UploadSpace.Stride + DepthSlice * UploadSpace.DepthStride;
+
+                    memcpy(pDstPtr, pSrcPtr, StaticCast<size_t>(UploadSpace.RowSize));
+                }
+            }
 
-            memcpy(pDstPtr, pSrcPtr, StaticCast<size_t>(UploadSpace.RowSize));
+            TextureCopyChunk Chunk;
+            Chunk.pd3d12Buffer   = UploadSpace.Allocation.pBuffer;
+            Chunk.SrcOffset      = AlignedOffset;
+            Chunk.SrcStride      = UploadSpace.Stride;
+            Chunk.SrcDepthStride = UploadSpace.DepthStride;
+            Chunk.BufferSize     = UploadSpace.Allocation.Size - (AlignedOffset - UploadSpace.Allocation.Offset);
+            Chunk.DstBox         = ChunkBox;
+            m_TextureCopyChunks.emplace_back(Chunk);
         }
     }
-    CopyTextureRegion(UploadSpace.Allocation.pBuffer,
-                      StaticCast<Uint32>(AlignedOffset),
-                      UploadSpace.Stride,
-                      UploadSpace.DepthStride,
-                      StaticCast<Uint32>(UploadSpace.Allocation.Size - (AlignedOffset - UploadSpace.Allocation.Offset)),
-                      TextureD3D12,
-                      DstSubResIndex,
-                      DstBox,
-                      TextureTransitionMode);
+
+    CopyTextureChunks(m_TextureCopyChunks.data(), static_cast<Uint32>(m_TextureCopyChunks.size()), TextureD3D12, DstSubResIndex, TextureTransitionMode);
 }
 
 void DeviceContextD3D12Impl::MapTextureSubresource(ITexture*                 pTexture,
@@ -2242,6 +2782,7 @@ void DeviceContextD3D12Impl::UnmapTextureSubresource(ITexture* pTexture, Uint32
 void DeviceContextD3D12Impl::GenerateMips(ITextureView* pTexView)
 {
     TDeviceContextBase::GenerateMips(pTexView);
+    DEV_CHECK_ERR(!m_IsRecordingBundle, "GenerateMips is not allowed in bundles");
 
     PipelineStateD3D12Impl* pCurrPSO = nullptr;
     if (m_pPipelineState)
@@ -2269,11 +2810,52 @@ void DeviceContextD3D12Impl::GenerateMips(ITextureView* pTexView)
     }
 }
 
+void DeviceContextD3D12Impl::GenerateMipsBatch(ITextureView* const* ppTexViews, Uint32 NumViews)
+{
+    TDeviceContextBase::GenerateMipsBatch(ppTexViews, NumViews);
+    DEV_CHECK_ERR(!m_IsRecordingBundle, "GenerateMipsBatch is not allowed in bundles");
+    if (NumViews == 0)
+        return;
+
+    PipelineStateD3D12Impl* pCurrPSO = nullptr;
+    if (m_pPipelineState)
+    {
+        const auto& PSODesc = m_pPipelineState->GetDesc();
+        if (PSODesc.IsComputePipeline() || PSODesc.IsRayTracingPipeline())
+        {
+            // Mips generator will set its own compute pipeline, root signature and root resources.
+            // We need to invalidate current PSO and reset it afterwards.
+            pCurrPSO = m_pPipelineState;
+            m_pPipelineState.Release();
+            m_ComputeResources.pd3d12RootSig = nullptr;
+        }
+    }
+
+    std::vector<TextureViewD3D12Impl*> TexViewsD3D12(NumViews);
+    for (Uint32 i = 0; i < NumViews; ++i)
+        TexViewsD3D12[i] = ClassPtrCast<TextureViewD3D12Impl>(ppTexViews[i]);
+
+    auto& Ctx = GetCmdContext();
+
+    const auto& MipsGenerator = m_pDevice->GetMipsGenerator();
+    MipsGenerator.GenerateMips(m_pDevice->GetD3D12Device(), TexViewsD3D12.data(), NumViews, Ctx);
+    ++m_State.NumCommands;
+
+    if (pCurrPSO != nullptr)
+    {
+        SetPipelineState(pCurrPSO);
+    }
+}
+
 void DeviceContextD3D12Impl::FinishCommandList(ICommandList** ppCommandList)
 {
     DEV_CHECK_ERR(IsDeferred(), "Only deferred context can record command list");
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Finishing command list inside an active render pass.");
 
+    ResolvePendingQueries();
+    if (m_CurrCmdCtx)
+        m_FrameStats.BarrierCount += m_CurrCmdCtx->ExtractBarrierCount();
+
     CommandListD3D12Impl* pCmdListD3D12(NEW_RC_OBJ(m_CmdListAllocator, "CommandListD3D12Impl instance", CommandListD3D12Impl)(m_pDevice, this, std::move(m_CurrCmdCtx)));
     pCmdListD3D12->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
 
@@ -2281,7 +2863,8 @@ void DeviceContextD3D12Impl::FinishCommandList(ICommandList** ppCommandList)
     constexpr auto RequestNewCmdCtx = false;
     Flush(RequestNewCmdCtx);
 
-    m_QueryMgr = nullptr;
+    m_QueryMgr          = nullptr;
+    m_IsRecordingBundle = false;
     InvalidateState();
 
     TDeviceContextBase::FinishCommandList();
@@ -2296,11 +2879,49 @@ void DeviceContextD3D12Impl::ExecuteCommandLists(Uint32               NumCommand
         return;
     DEV_CHECK_ERR(ppCommandLists != nullptr, "ppCommandLists must not be null when NumCommandLists is not zero");
 
+    if (ClassPtrCast<CommandListD3D12Impl>(ppCommandLists[0])->IsBundle())
+    {
+        ExecuteBundles(NumCommandLists, ppCommandLists);
+        return;
+    }
+
     Flush(true, NumCommandLists, ppCommandLists);
 
     InvalidateState();
 }
 
+void DeviceContextD3D12Impl::ExecuteBundles(Uint32               NumCommandLists,
+                                            ICommandList* const* ppCommandLists)
+{
+    auto& CmdCtx = GetCmdContext();
+    DEV_CHECK_ERR(CmdCtx.GetCommandListType() == D3D12_COMMAND_LIST_TYPE_DIRECT, "Bundles can only be executed by graphics contexts");
+
+    // Descriptor heaps bound in the command list must match the heaps used by the bundles
+    CmdCtx.SetDescriptorHeaps(GetShaderDescriptorHeaps());
+
+    for (Uint32 i = 0; i < NumCommandLists; ++i)
+    {
+        auto* const pCmdListD3D12 = ClassPtrCast<CommandListD3D12Impl>(ppCommandLists[i]);
+        DEV_CHECK_ERR(pCmdListD3D12 != nullptr, "Command list must not be null");
+        DEV_CHECK_ERR(pCmdListD3D12->IsBundle(), "Bundles and regular command lists must not be executed in the same call");
+
+        CmdCtx.ExecuteBundle(pCmdListD3D12->GetClosedD3D12CommandList());
+        // Set the bit in the deferred context cmd queue mask corresponding to the cmd queue of this context
+        pCmdListD3D12->GetDeferredContext()->UpdateSubmittedBuffersCmdQueueMask(GetCommandQueueId());
+        // The fence value is recorded when the command list is submitted
+        m_PendingBundles.emplace_back(pCmdListD3D12);
+    }
+    ++m_State.NumCommands;
+
+    // The pipeline state and the root arguments set by a bundle are inherited by the command list.
+    // Render targets, viewports and scissor rects remain unchanged.
+    m_pPipelineState                   = nullptr;
+    m_GraphicsResources                = {};
+    m_ComputeResources                 = {};
+    m_State.bCommittedD3D12VBsUpToDate = false;
+    m_State.bCommittedD3D12IBUpToDate  = false;
+}
+
 void DeviceContextD3D12Impl::EnqueueSignal(IFence* pFence, Uint64 Value)
 {
     TDeviceContextBase::EnqueueSignal(pFence, Value, 0);
@@ -2317,6 +2938,7 @@ void DeviceContextD3D12Impl::WaitForIdle()
 {
     DEV_CHECK_ERR(!IsDeferred(), "Only immediate contexts can be idled");
     Flush();
+    m_pDevice->FlushInitialDataBatch(GetCommandQueueId());
     m_pDevice->IdleCommandQueue(GetCommandQueueId(), true);
 }
 
@@ -2335,7 +2957,13 @@ void DeviceContextD3D12Impl::BeginQuery(IQuery* pQuery)
     if (QueryType != QUERY_TYPE_DURATION)
         QueryMgr.BeginQuery(Ctx, QueryType, Idx);
     else
-        QueryMgr.EndQuery(Ctx, QueryType, Idx);
+        QueryMgr.EndQuery(Ctx, QueryType, Idx, m_PendingQueryResolves);
+}
+
+void DeviceContextD3D12Impl::ResolvePendingQueries()
+{
+    if (m_QueryMgr != nullptr && m_CurrCmdCtx)
+        m_QueryMgr->ResolveQueries(*m_CurrCmdCtx, m_PendingQueryResolves);
 }
 
 void DeviceContextD3D12Impl::EndQuery(IQuery* pQuery)
@@ -2353,7 +2981,92 @@ void DeviceContextD3D12Impl::EndQuery(IQuery* pQuery)
     auto& QueryMgr = GetQueryManager();
     auto& Ctx      = GetCmdContext();
     auto  Idx      = pQueryD3D12Impl->GetQueryHeapIndex(QueryType == QUERY_TYPE_DURATION ? 1 : 0);
-    QueryMgr.EndQuery(Ctx, QueryType, Idx);
+    QueryMgr.EndQuery(Ctx, QueryType, Idx, m_PendingQueryResolves);
+}
+
+void DeviceContextD3D12Impl::BeginIndexedQuery(IQueryArray* pQueryArray, Uint32 Index)
+{
+    TDeviceContextBase::BeginIndexedQuery(pQueryArray, Index, 0);
+
+    auto* pQueryArrayD3D12 = ClassPtrCast<QueryArrayD3D12Impl>(pQueryArray);
+    pQueryArrayD3D12->DvpOnBeginQuery(Index);
+
+    ++m_ActiveQueriesCounter;
+    GetCmdContext().BeginQuery(pQueryArrayD3D12->GetD3D12QueryHeap(), pQueryArrayD3D12->GetD3D12QueryType(), Index);
+}
+
+void DeviceContextD3D12Impl::EndIndexedQuery(IQueryArray* pQueryArray, Uint32 Index)
+{
+    TDeviceContextBase::EndIndexedQuery(pQueryArray, Index, 0);
+
+    auto* pQueryArrayD3D12 = ClassPtrCast<QueryArrayD3D12Impl>(pQueryArray);
+    pQueryArrayD3D12->DvpOnEndQuery(Index);
+
+    if (pQueryArrayD3D12->GetDesc().Type != QUERY_TYPE_TIMESTAMP)
+    {
+        VERIFY(m_ActiveQueriesCounter > 0, "Active query counter is 0 which means there was a mismatch between BeginIndexedQuery() / EndIndexedQuery() calls");
+        --m_ActiveQueriesCounter;
+    }
+
+    GetCmdContext().EndQuery(pQueryArrayD3D12->GetD3D12QueryHeap(), pQueryArrayD3D12->GetD3D12QueryType(), Index);
+}
+
+void DeviceContextD3D12Impl::ResolveQueryArray(const ResolveQueryArrayAttribs& Attribs)
+{
+    TDeviceContextBase::ResolveQueryArray(Attribs, 0);
+
+    auto* pQueryArrayD3D12 = ClassPtrCast<QueryArrayD3D12Impl>(Attribs.pQueryArray);
+    auto* pDstBuffD3D12    = ClassPtrCast<BufferD3D12Impl>(Attribs.pDstBuffer);
+    pQueryArrayD3D12->DvpOnResolve(Attribs.FirstQuery, Attribs.NumQueries);
+
+    auto& CmdCtx = GetCmdContext();
+    TransitionOrVerifyBufferState(CmdCtx, *pDstBuffD3D12, Attribs.DstBufferTransitionMode, RESOURCE_STATE_COPY_DEST,
+                                  "Resolve query array (DeviceContextD3D12Impl::ResolveQueryArray)");
+
+    // Query heap entries do not need to be reset before they are reused.
+    CmdCtx.ResolveQueryData(pQueryArrayD3D12->GetD3D12QueryHeap(), pQueryArrayD3D12->GetD3D12QueryType(),
+                            Attribs.FirstQuery, Attribs.NumQueries, pDstBuffD3D12->GetD3D12Resource(), Attribs.DstOffset);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextD3D12Impl::SetPredication(IBuffer* pBuffer, Uint64 Offset, PREDICATION_OP Op)
+{
+    TDeviceContextBase::SetPredication(pBuffer, Offset, Op, 0);
+
+    auto& CmdCtx = GetCmdContext();
+    if (pBuffer != nullptr)
+    {
+        auto* pBuffD3D12 = ClassPtrCast<BufferD3D12Impl>(pBuffer);
+        // D3D12_RESOURCE_STATE_PREDICATION is the same as D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT
+        TransitionOrVerifyBufferState(CmdCtx, *pBuffD3D12, RESOURCE_STATE_TRANSITION_MODE_VERIFY, RESOURCE_STATE_INDIRECT_ARGUMENT,
+                                      "Set predication (DeviceContextD3D12Impl::SetPredication)");
+        CmdCtx.SetPredication(pBuffD3D12->GetD3D12Resource(), Offset,
+                              Op == PREDICATION_OP_SKIP_IF_ZERO ? D3D12_PREDICATION_OP_EQUAL_ZERO : D3D12_PREDICATION_OP_NOT_EQUAL_ZERO);
+    }
+    else
+    {
+        CmdCtx.SetPredication(nullptr, 0, D3D12_PREDICATION_OP_EQUAL_ZERO);
+    }
+}
+
+void DeviceContextD3D12Impl::SetQueryPredication(IQuery* pQuery, PREDICATION_OP Op)
+{
+    UNSUPPORTED("SetQueryPredication is not supported in Direct3D12. Use SetPredication with the results resolved by ResolveQueryArray.");
+}
+
+void DeviceContextD3D12Impl::SetCullMode(CULL_MODE CullMode)
+{
+    UNSUPPORTED("SetCullMode is not supported in Direct3D12");
+}
+
+void DeviceContextD3D12Impl::SetDepthStencilState(const DepthStencilStateDesc& DSSDesc)
+{
+    UNSUPPORTED("SetDepthStencilState is not supported in Direct3D12");
+}
+
+void DeviceContextD3D12Impl::SetPrimitiveTopology(PRIMITIVE_TOPOLOGY Topology)
+{
+    UNSUPPORTED("SetPrimitiveTopology is not supported in Direct3D12");
 }
 
 static void AliasingBarrier(CommandContext& CmdCtx, IDeviceObject* pResourceBefore, IDeviceObject* pResourceAfter)
@@ -2399,7 +3112,10 @@ static void AliasingBarrier(CommandContext& CmdCtx, IDeviceObject* pResourceBefo
 
 void DeviceContextD3D12Impl::TransitionResourceStates(Uint32 BarrierCount, const StateTransitionDesc* pResourceBarriers)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_TRANSITION_RESOURCE_STATES);
+
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
+    DEV_CHECK_ERR(!m_IsRecordingBundle, "State transitions are not allowed in bundles");
 
     auto& CmdCtx = GetCmdContext();
     for (Uint32 i = 0; i < BarrierCount; ++i)
@@ -2414,10 +3130,19 @@ void DeviceContextD3D12Impl::TransitionResourceStates(Uint32 BarrierCount, const
         }
         else
         {
+            auto* const pResidencyMgr = m_pDevice->GetResidencyManager();
             if (RefCntAutoPtr<TextureD3D12Impl> pTextureD3D12Impl{Barrier.pResource, IID_TextureD3D12})
+            {
+                if (pResidencyMgr != nullptr)
+                    pResidencyMgr->MarkUsed(*pTextureD3D12Impl);
                 CmdCtx.TransitionResource(*pTextureD3D12Impl, Barrier);
+            }
             else if (RefCntAutoPtr<BufferD3D12Impl> pBufferD3D12Impl{Barrier.pResource, IID_BufferD3D12})
+            {
+                if (pResidencyMgr != nullptr)
+                    pResidencyMgr->MarkUsed(*pBufferD3D12Impl);
                 CmdCtx.TransitionResource(*pBufferD3D12Impl, Barrier);
+            }
             else if (RefCntAutoPtr<BottomLevelASD3D12Impl> pBLASD3D12Impl{Barrier.pResource, IID_BottomLevelASD3D12})
                 CmdCtx.TransitionResource(*pBLASD3D12Impl, Barrier);
             else if (RefCntAutoPtr<TopLevelASD3D12Impl> pTLASD3D12Impl{Barrier.pResource, IID_TopLevelASD3D12})
@@ -2434,6 +3159,9 @@ void DeviceContextD3D12Impl::TransitionOrVerifyBufferState(CommandContext&
                                                            RESOURCE_STATE                 RequiredState,
                                                            const char*                    OperationName)
 {
+    if (auto* pResidencyMgr = m_pDevice->GetResidencyManager())
+        pResidencyMgr->MarkUsed(Buffer);
+
     if (TransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
     {
         if (Buffer.IsInKnownState())
@@ -2453,6 +3181,9 @@ void DeviceContextD3D12Impl::TransitionOrVerifyTextureState(CommandContext&
                                                             RESOURCE_STATE                 RequiredState,
                                                             const char*                    OperationName)
 {
+    if (auto* pResidencyMgr = m_pDevice->GetResidencyManager())
+        pResidencyMgr->MarkUsed(Texture);
+
     if (TransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
     {
         if (Texture.IsInKnownState())
@@ -2532,6 +3263,7 @@ void DeviceContextD3D12Impl::ResolveTextureSubresource(ITexture*
                                                        const ResolveTextureSubresourceAttribs& ResolveAttribs)
 {
     TDeviceContextBase::ResolveTextureSubresource(pSrcTexture, pDstTexture, ResolveAttribs);
+    DEV_CHECK_ERR(!m_IsRecordingBundle, "ResolveTextureSubresource is not allowed in bundles");
 
     auto*       pSrcTexD3D12 = ClassPtrCast<TextureD3D12Impl>(pSrcTexture);
     auto*       pDstTexD3D12 = ClassPtrCast<TextureD3D12Impl>(pDstTexture);
@@ -2565,26 +3297,29 @@ void DeviceContextD3D12Impl::ResolveTextureSubresource(ITexture*
     CmdCtx.ResolveSubresource(pDstTexD3D12->GetD3D12Resource(), DstSubresIndex, pSrcTexD3D12->GetD3D12Resource(), SrcSubresIndex, DXGIFmt);
 }
 
-void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
+void DeviceContextD3D12Impl::PrepareBLASBuild(CommandContext&                                     CmdCtx,
+                                              const BuildBLASAttribs&                             Attribs,
+                                              BufferD3D12Impl&                                    ScratchBuffer,
+                                              Uint64                                              ScratchBufferOffset,
+                                              RESOURCE_STATE_TRANSITION_MODE                      ScratchBufferTransitionMode,
+                                              const char*                                         OpName,
+                                              D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC& d3d12BuildASDesc,
+                                              FrameVector<D3D12_RAYTRACING_GEOMETRY_DESC>&        Geometries)
 {
-    TDeviceContextBase::BuildBLAS(Attribs, 0);
+    auto* const pBLASD3D12 = ClassPtrCast<BottomLevelASD3D12Impl>(Attribs.pBLAS);
+    const auto& BLASDesc   = pBLASD3D12->GetDesc();
 
-    auto* const pBLASD3D12    = ClassPtrCast<BottomLevelASD3D12Impl>(Attribs.pBLAS);
-    auto* const pScratchD3D12 = ClassPtrCast<BufferD3D12Impl>(Attribs.pScratchBuffer);
-    const auto& BLASDesc      = pBLASD3D12->GetDesc();
-
-    auto&       CmdCtx = GetCmdContext();
-    const char* OpName = "Build BottomLevelAS (DeviceContextD3D12Impl::BuildBLAS)";
     TransitionOrVerifyBLASState(CmdCtx, *pBLASD3D12, Attribs.BLASTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
-    TransitionOrVerifyBufferState(CmdCtx, *pScratchD3D12, Attribs.ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
+    TransitionOrVerifyBufferState(CmdCtx, ScratchBuffer, ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
 
-    D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC    d3d12BuildASDesc   = {};
     D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS& d3d12BuildASInputs = d3d12BuildASDesc.Inputs;
-    std::vector<D3D12_RAYTRACING_GEOMETRY_DESC>           Geometries;
+
+    // Geometries of the build are appended to the geometries of the previous builds in the batch
+    const size_t FirstGeometry = Geometries.size();
 
     if (Attribs.pTriangleData != nullptr)
     {
-        Geometries.resize(Attribs.TriangleDataCount);
+        Geometries.resize(FirstGeometry + Attribs.TriangleDataCount);
         pBLASD3D12->SetActualGeometryCount(Attribs.TriangleDataCount);
 
         for (Uint32 i = 0; i < Attribs.TriangleDataCount; ++i)
@@ -2599,7 +3334,7 @@ void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
                 continue;
             }
 
-            auto&       d3d12Geo  = Geometries[Idx];
+            auto&       d3d12Geo  = Geometries[FirstGeometry + Idx];
             auto&       d3d12Tris = d3d12Geo.Triangles;
             const auto& TriDesc   = BLASDesc.pTriangles[GeoIdx];
 
@@ -2656,7 +3391,7 @@ void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
     }
     else if (Attribs.pBoxData != nullptr)
     {
-        Geometries.resize(Attribs.BoxDataCount);
+        Geometries.resize(FirstGeometry + Attribs.BoxDataCount);
         pBLASD3D12->SetActualGeometryCount(Attribs.BoxDataCount);
 
         for (Uint32 i = 0; i < Attribs.BoxDataCount; ++i)
@@ -2671,7 +3406,7 @@ void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
                 continue;
             }
 
-            auto& d3d12Geo  = Geometries[Idx];
+            auto& d3d12Geo  = Geometries[FirstGeometry + Idx];
             auto& d3d12AABs = d3d12Geo.AABBs;
 
             d3d12Geo.Type  = D3D12_RAYTRACING_GEOMETRY_TYPE_PROCEDURAL_PRIMITIVE_AABBS;
@@ -2692,11 +3427,11 @@ void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
     d3d12BuildASInputs.Type           = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL;
     d3d12BuildASInputs.Flags          = BuildASFlagsToD3D12ASBuildFlags(BLASDesc.Flags);
     d3d12BuildASInputs.DescsLayout    = D3D12_ELEMENTS_LAYOUT_ARRAY;
-    d3d12BuildASInputs.NumDescs       = static_cast<UINT>(Geometries.size());
-    d3d12BuildASInputs.pGeometryDescs = Geometries.data();
+    d3d12BuildASInputs.NumDescs       = static_cast<UINT>(Geometries.size() - FirstGeometry);
+    d3d12BuildASInputs.pGeometryDescs = nullptr; // Set by the caller when all geometries are written
 
     d3d12BuildASDesc.DestAccelerationStructureData    = pBLASD3D12->GetGPUAddress();
-    d3d12BuildASDesc.ScratchAccelerationStructureData = pScratchD3D12->GetGPUAddress() + Attribs.ScratchBufferOffset;
+    d3d12BuildASDesc.ScratchAccelerationStructureData = ScratchBuffer.GetGPUAddress() + ScratchBufferOffset;
     d3d12BuildASDesc.SourceAccelerationStructureData  = 0;
 
     if (Attribs.Update)
@@ -2708,14 +3443,109 @@ void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
     DEV_CHECK_ERR(d3d12BuildASDesc.ScratchAccelerationStructureData % D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT == 0,
                   "Scratch data address is not properly aligned");
 
-    CmdCtx.AsGraphicsContext4().BuildRaytracingAccelerationStructure(d3d12BuildASDesc, 0, nullptr);
-    ++m_State.NumCommands;
-
 #ifdef DILIGENT_DEVELOPMENT
     pBLASD3D12->DvpUpdateVersion();
 #endif
 }
 
+void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
+{
+    TDeviceContextBase::BuildBLAS(Attribs, 0);
+
+    auto& CmdCtx = GetCmdContext();
+
+    D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC d3d12BuildASDesc = {};
+    auto                                               Geometries       = MakeFrameVector<D3D12_RAYTRACING_GEOMETRY_DESC>();
+
+    PrepareBLASBuild(CmdCtx, Attribs, *ClassPtrCast<BufferD3D12Impl>(Attribs.pScratchBuffer), Attribs.ScratchBufferOffset, Attribs.ScratchBufferTransitionMode,
+                     "Build BottomLevelAS (DeviceContextD3D12Impl::BuildBLAS)", d3d12BuildASDesc, Geometries);
+
+    d3d12BuildASDesc.Inputs.pGeometryDescs = Geometries.data();
+
+    CmdCtx.AsGraphicsContext4().BuildRaytracingAccelerationStructure(d3d12BuildASDesc, 0, nullptr);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextD3D12Impl::BuildBLASBatch(const BuildBLASBatchAttribs& Attribs)
+{
+    TDeviceContextBase::BuildBLASBatch(Attribs, 0);
+
+    if (Attribs.BuildCount == 0)
+        return;
+
+    auto&       CmdCtx = GetCmdContext();
+    const char* OpName = "Build BottomLevelAS batch (DeviceContextD3D12Impl::BuildBLASBatch)";
+
+    auto ScratchOffsets = MakeFrameVector<Uint64>(Attribs.BuildCount);
+    ScratchOffsets.resize(Attribs.BuildCount);
+    BufferD3D12Impl* pBatchScratchD3D12 = PrepareBLASBatchScratchBuffer(Attribs, ScratchOffsets.data());
+    if (pBatchScratchD3D12 != nullptr)
+    {
+        // The builds that share the context scratch buffer use non-overlapping ranges, so a single
+        // transition is enough. It also adds the UAV barrier that separates them from the previous batch.
+        TransitionOrVerifyBufferState(CmdCtx, *pBatchScratchD3D12, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
+    }
+
+    auto* pDestBuffD3D12 = ClassPtrCast<BufferD3D12Impl>(Attribs.pCompactedSizeBuffer);
+    if (pDestBuffD3D12 != nullptr)
+    {
+        static_assert(sizeof(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC) == sizeof(Uint64),
+                      "Engine api specifies that compacted size is 64 bits");
+        TransitionOrVerifyBufferState(CmdCtx, *pDestBuffD3D12, Attribs.CompactedSizeBufferTransitionMode, RESOURCE_STATE_UNORDERED_ACCESS, OpName);
+    }
+
+    Uint32 TotalGeometryCount = 0;
+    for (Uint32 i = 0; i < Attribs.BuildCount; ++i)
+        TotalGeometryCount += Attribs.pBuilds[i].TriangleDataCount + Attribs.pBuilds[i].BoxDataCount;
+
+    auto d3d12BuildASDescs = MakeFrameVector<D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC>(Attribs.BuildCount);
+    auto Geometries        = MakeFrameVector<D3D12_RAYTRACING_GEOMETRY_DESC>(TotalGeometryCount);
+    d3d12BuildASDescs.resize(Attribs.BuildCount);
+
+    // State transitions of all builds are recorded before the first build, so
+    // that they are flushed with a single ResourceBarrier call.
+    for (Uint32 i = 0; i < Attribs.BuildCount; ++i)
+    {
+        const BuildBLASAttribs& Build = Attribs.pBuilds[i];
+        if (Build.pScratchBuffer != nullptr)
+        {
+            PrepareBLASBuild(CmdCtx, Build, *ClassPtrCast<BufferD3D12Impl>(Build.pScratchBuffer), ScratchOffsets[i], Build.ScratchBufferTransitionMode,
+                             OpName, d3d12BuildASDescs[i], Geometries);
+        }
+        else
+        {
+            PrepareBLASBuild(CmdCtx, Build, *pBatchScratchD3D12, ScratchOffsets[i], RESOURCE_STATE_TRANSITION_MODE_NONE,
+                             OpName, d3d12BuildASDescs[i], Geometries);
+        }
+    }
+
+    size_t FirstGeometry = 0;
+    for (Uint32 i = 0; i < Attribs.BuildCount; ++i)
+    {
+        auto& d3d12BuildASDesc = d3d12BuildASDescs[i];
+
+        d3d12BuildASDesc.Inputs.pGeometryDescs = Geometries.data() + FirstGeometry;
+        FirstGeometry += d3d12BuildASDesc.Inputs.NumDescs;
+
+        if (pDestBuffD3D12 != nullptr)
+        {
+            // The compacted size is emitted by the build itself, which avoids a separate postbuild info command
+            D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC d3d12PostbuildDesc = {};
+
+            d3d12PostbuildDesc.DestBuffer = pDestBuffD3D12->GetGPUAddress() + Attribs.CompactedSizeBufferOffset + Uint64{i} * sizeof(Uint64);
+            d3d12PostbuildDesc.InfoType   = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE;
+
+            CmdCtx.AsGraphicsContext4().BuildRaytracingAccelerationStructure(d3d12BuildASDesc, 1, &d3d12PostbuildDesc);
+        }
+        else
+        {
+            CmdCtx.AsGraphicsContext4().BuildRaytracingAccelerationStructure(d3d12BuildASDesc, 0, nullptr);
+        }
+        ++m_State.NumCommands;
+    }
+    VERIFY_EXPR(FirstGeometry == Geometries.size());
+}
+
 void DeviceContextD3D12Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
 {
     TDeviceContextBase::BuildTLAS(Attribs, 0);
@@ -2744,8 +3574,25 @@ void DeviceContextD3D12Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
 
     // copy instance data into instance buffer
     {
-        size_t Size     = Attribs.InstanceCount * sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
-        auto   TmpSpace = m_DynamicHeap.Allocate(Size, 16, m_FrameNumber);
+        DEV_CHECK_ERR(!IsDeferred() || !IsRecordingReusableCommands(), "Building TLAS is not allowed in reusable command lists as instance data is uploaded through memory that is recycled at the end of the frame");
+        size_t Size = Attribs.InstanceCount * sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
+
+        D3D12DynamicAllocation          TmpSpace;
+        D3D12_RAYTRACING_INSTANCE_DESC* pRecords = nullptr;
+
+        auto Records = MakeFrameVector<D3D12_RAYTRACING_INSTANCE_DESC>();
+        if (Attribs.UploadChangedInstancesOnly)
+        {
+            // Instances are packed to CPU memory first and compared with the previously uploaded ones
+            Records.resize(Attribs.InstanceCount);
+            pRecords = Records.data();
+        }
+        else
+        {
+            pTLASD3D12->ReleaseUploadedInstanceRecords();
+            TmpSpace = m_DynamicHeap.Allocate(Size, 16, m_FrameNumber);
+            pRecords = static_cast<D3D12_RAYTRACING_INSTANCE_DESC*>(TmpSpace.CPUAddress);
+        }
 
         for (Uint32 i = 0; i < Attribs.InstanceCount; ++i)
         {
@@ -2758,7 +3605,7 @@ void DeviceContextD3D12Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
                 return;
             }
 
-            auto& d3d12Inst  = static_cast<D3D12_RAYTRACING_INSTANCE_DESC*>(TmpSpace.CPUAddress)[InstDesc.InstanceIndex];
+            auto& d3d12Inst  = pRecords[InstDesc.InstanceIndex];
             auto* pBLASD3D12 = ClassPtrCast<BottomLevelASD3D12Impl>(Inst.pBLAS);
 
             static_assert(sizeof(d3d12Inst.Transform) == sizeof(Inst.Transform), "size mismatch");
@@ -2772,7 +3619,10 @@ void DeviceContextD3D12Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
 
             TransitionOrVerifyBLASState(CmdCtx, *pBLASD3D12, Attribs.BLASTransitionMode, RESOURCE_STATE_BUILD_AS_READ, OpName);
         }
-        UpdateBufferRegion(pInstancesD3D12, TmpSpace, Attribs.InstanceBufferOffset, Size, Attribs.InstanceBufferTransitionMode);
+        if (Attribs.UploadChangedInstancesOnly)
+            UploadChangedTLASInstances(*pTLASD3D12, Attribs, Records, OpName);
+        else
+            UpdateBufferRegion(pInstancesD3D12, TmpSpace, Attribs.InstanceBufferOffset, Size, Attribs.InstanceBufferTransitionMode);
     }
     TransitionOrVerifyBufferState(CmdCtx, *pInstancesD3D12, Attribs.InstanceBufferTransitionMode, RESOURCE_STATE_BUILD_AS_READ, OpName);
 
@@ -2804,6 +3654,47 @@ void DeviceContextD3D12Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
     ++m_State.NumCommands;
 }
 
+void DeviceContextD3D12Impl::UploadChangedTLASInstances(TopLevelASD3D12Impl&                               TLASD3D12,
+                                                        const BuildTLASAttribs&                            Attribs,
+                                                        const FrameVector<D3D12_RAYTRACING_INSTANCE_DESC>& Records,
+                                                        const char*                                        OpName)
+{
+    auto* pInstancesD3D12 = ClassPtrCast<BufferD3D12Impl>(Attribs.pInstanceBuffer);
+
+    auto DirtyRanges = MakeFrameVector<std::pair<Uint32, Uint32>>();
+    TLASD3D12.UpdateUploadedInstanceRecords(Records.data(), Attribs.InstanceCount, pInstancesD3D12, Attribs.InstanceBufferOffset, Attribs.Update, DirtyRanges);
+    if (DirtyRanges.empty())
+        return;
+
+    Uint32 DirtyCount = 0;
+    for (const auto& Range : DirtyRanges)
+        DirtyCount += Range.second;
+
+    // Dirty records are packed contiguously in the dynamic heap and copied to their locations in the instance buffer
+    auto TmpSpace = m_DynamicHeap.Allocate(DirtyCount * sizeof(D3D12_RAYTRACING_INSTANCE_DESC), 16, m_FrameNumber);
+
+    auto& CmdCtx = GetCmdContext();
+    TransitionOrVerifyBufferState(CmdCtx, *pInstancesD3D12, Attribs.InstanceBufferTransitionMode, RESOURCE_STATE_COPY_DEST, OpName);
+    CmdCtx.FlushResourceBarriers();
+
+    Uint64 DstBuffDataStartByteOffset;
+    auto*  pd3d12Buff = pInstancesD3D12->GetD3D12Buffer(DstBuffDataStartByteOffset, this);
+    VERIFY(DstBuffDataStartByteOffset == 0, "Dst buffer must not be suballocated");
+
+    Uint64 SrcOffset = 0;
+    for (const auto& Range : DirtyRanges)
+    {
+        const Uint64 RangeSize = Uint64{Range.second} * sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
+        std::memcpy(static_cast<Uint8*>(TmpSpace.CPUAddress) + SrcOffset, &Records[Range.first], static_cast<size_t>(RangeSize));
+
+        const Uint64 DstOffset = Attribs.InstanceBufferOffset + Uint64{Range.first} * sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
+        CmdCtx.GetCommandList()->CopyBufferRegion(pd3d12Buff, DstOffset + DstBuffDataStartByteOffset, TmpSpace.pBuffer, TmpSpace.Offset + SrcOffset, RangeSize);
+        ++m_State.NumCommands;
+
+        SrcOffset += RangeSize;
+    }
+}
+
 void DeviceContextD3D12Impl::CopyBLAS(const CopyBLASAttribs& Attribs)
 {
     TDeviceContextBase::CopyBLAS(Attribs, 0);
@@ -2902,6 +3793,7 @@ void DeviceContextD3D12Impl::WriteTLASCompactedSize(const WriteTLASCompactedSize
 void DeviceContextD3D12Impl::TraceRays(const TraceRaysAttribs& Attribs)
 {
     TDeviceContextBase::TraceRays(Attribs, 0);
+    ++m_FrameStats.DispatchCount;
 
     auto&       CmdCtx    = GetCmdContext().AsGraphicsContext4();
     const auto* pSBTD3D12 = ClassPtrCast<const ShaderBindingTableD3D12Impl>(Attribs.pSBT);
@@ -2921,6 +3813,7 @@ void DeviceContextD3D12Impl::TraceRays(const TraceRaysAttribs& Attribs)
 void DeviceContextD3D12Impl::TraceRaysIndirect(const TraceRaysIndirectAttribs& Attribs)
 {
     TDeviceContextBase::TraceRaysIndirect(Attribs, 0);
+    ++m_FrameStats.DispatchCount;
 
     auto&       CmdCtx              = GetCmdContext().AsGraphicsContext4();
     auto*       pAttribsBufferD3D12 = ClassPtrCast<BufferD3D12Impl>(Attribs.pAttribsBuffer);
@@ -2953,18 +3846,19 @@ void DeviceContextD3D12Impl::UpdateSBT(IShaderBindingTable* pSBT, const UpdateIn
     {
         TransitionOrVerifyBufferState(CmdCtx, *pSBTBufferD3D12, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_COPY_DEST, OpName);
 
+        // Only the modified records of each table are uploaded.
         // Buffer ranges do not intersect, so we don't need to add barriers between them
         if (RayGenShaderRecord.pData)
-            UpdateBuffer(pSBTBufferD3D12, RayGenShaderRecord.Offset, RayGenShaderRecord.Size, RayGenShaderRecord.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            UpdateBuffer(pSBTBufferD3D12, RayGenShaderRecord.Offset + RayGenShaderRecord.DirtyOffset, RayGenShaderRecord.DirtySize, static_cast<const Uint8*>(RayGenShaderRecord.pData) + RayGenShaderRecord.DirtyOffset, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         if (MissShaderTable.pData)
-            UpdateBuffer(pSBTBufferD3D12, MissShaderTable.Offset, MissShaderTable.Size, MissShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            UpdateBuffer(pSBTBufferD3D12, MissShaderTable.Offset + MissShaderTable.DirtyOffset, MissShaderTable.DirtySize, static_cast<const Uint8*>(MissShaderTable.pData) + MissShaderTable.DirtyOffset, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         if (HitGroupTable.pData)
-            UpdateBuffer(pSBTBufferD3D12, HitGroupTable.Offset, HitGroupTable.Size, HitGroupTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            UpdateBuffer(pSBTBufferD3D12, HitGroupTable.Offset + HitGroupTable.DirtyOffset, HitGroupTable.DirtySize, static_cast<const Uint8*>(HitGroupTable.pData) + HitGroupTable.DirtyOffset, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         if (CallableShaderTable.pData)
-            UpdateBuffer(pSBTBufferD3D12, CallableShaderTable.Offset, CallableShaderTable.Size, CallableShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            UpdateBuffer(pSBTBufferD3D12, CallableShaderTable.Offset + CallableShaderTable.DirtyOffset, CallableShaderTable.DirtySize, static_cast<const Uint8*>(CallableShaderTable.pData) + CallableShaderTable.DirtyOffset, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         TransitionOrVerifyBufferState(CmdCtx, *pSBTBufferD3D12, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_RAY_TRACING, OpName);
     }
@@ -42,12 +42,17 @@ namespace Diligent
 namespace
 {
 
-D3D12_HEAP_FLAGS GetD3D12HeapFlags(ID3D12Device*   pd3d12Device,
-                                   IDeviceObject** ppResources,
-                                   Uint32          NumResources,
-                                   bool&           AllowMSAA,
-                                   bool&           UseNVApi) noexcept(false)
+D3D12_HEAP_FLAGS GetD3D12HeapFlags(ID3D12Device*      pd3d12Device,
+                                   DEVICE_MEMORY_TYPE MemType,
+                                   IDeviceObject**    ppResources,
+                                   Uint32             NumResources,
+                                   bool&              AllowMSAA,
+                                   bool&              UseNVApi) noexcept(false)
 {
+    // Sparse memory is only compatible with sparse resources, while placed memory
+    // is compatible with regular resources that are created in the heap.
+    const auto RequiredUsage = MemType == DEVICE_MEMORY_TYPE_PLACED ? USAGE_DEFAULT : USAGE_SPARSE;
+
     AllowMSAA = false;
     UseNVApi  = false;
 
@@ -97,8 +102,8 @@ D3D12_HEAP_FLAGS GetD3D12HeapFlags(ID3D12Device*   pd3d12Device,
             const auto* pTexD3D12Impl = pTexture.RawPtr<const TextureD3D12Impl>();
             const auto& TexDesc       = pTexD3D12Impl->GetDesc();
 
-            if (TexDesc.Usage != USAGE_SPARSE)
-                LOG_ERROR_AND_THROW("Resource must be created with USAGE_SPARSE");
+            if (TexDesc.Usage != RequiredUsage)
+                LOG_ERROR_AND_THROW("Resource must be created with ", GetUsageString(RequiredUsage));
 
             if (TexDesc.SampleCount > 1)
                 AllowMSAA = true;
@@ -121,8 +126,8 @@ D3D12_HEAP_FLAGS GetD3D12HeapFlags(ID3D12Device*   pd3d12Device,
         {
             const auto& BuffDesc = pBuffer.RawPtr<const BufferD3D12Impl>()->GetDesc();
 
-            if (BuffDesc.Usage != USAGE_SPARSE)
-                LOG_ERROR_AND_THROW("Resource must be created with USAGE_SPARSE");
+            if (BuffDesc.Usage != RequiredUsage)
+                LOG_ERROR_AND_THROW("Resource must be created with ", GetUsageString(RequiredUsage));
 
             HeapFlags &= ~D3D12_HEAP_FLAG_DENY_BUFFERS;
             if (BuffDesc.BindFlags & BIND_UNORDERED_ACCESS)
@@ -189,7 +194,7 @@ DeviceMemoryD3D12Impl::DeviceMemoryD3D12Impl(IReferenceCounters*           pRefC
                                              const DeviceMemoryCreateInfo& MemCI) :
     TDeviceMemoryBase{pRefCounters, pDeviceD3D11, MemCI}
 {
-    m_d3d12HeapFlags = GetD3D12HeapFlags(m_pDevice->GetD3D12Device(), MemCI.ppCompatibleResources, MemCI.NumResources, m_AllowMSAA, m_UseNVApi);
+    m_d3d12HeapFlags = GetD3D12HeapFlags(m_pDevice->GetD3D12Device(), m_Desc.Type, MemCI.ppCompatibleResources, MemCI.NumResources, m_AllowMSAA, m_UseNVApi);
 
     if (!Resize(MemCI.InitialSize))
         LOG_ERROR_AND_THROW("Failed to allocate device memory");
@@ -248,7 +253,7 @@ Bool DeviceMemoryD3D12Impl::IsCompatible(IDeviceObject* pResource) const
     {
         bool AllowMSAA              = false;
         bool UseNVApi               = false;
-        auto d3d12RequiredHeapFlags = GetD3D12HeapFlags(m_pDevice->GetD3D12Device(), &pResource, 1, AllowMSAA, UseNVApi);
+        auto d3d12RequiredHeapFlags = GetD3D12HeapFlags(m_pDevice->GetD3D12Device(), m_Desc.Type, &pResource, 1, AllowMSAA, UseNVApi);
         return ((m_d3d12HeapFlags & d3d12RequiredHeapFlags) == d3d12RequiredHeapFlags) && (!AllowMSAA || m_AllowMSAA) && (UseNVApi == m_UseNVApi);
     }
     catch (...)
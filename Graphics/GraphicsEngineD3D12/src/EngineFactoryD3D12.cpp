@@ -246,8 +246,14 @@ void EngineFactoryD3D12Impl::CreateDeviceAndContextsD3D12(const EngineD3D12Creat
         return;
     }
 
-    if (!LoadD3D12(EngineCI.D3D12DllName))
-        return;
+    BeginStartupProfiling(EngineCI);
+    StartupProfiler::Scope ProfilerScope{"CreateDeviceAndContextsD3D12"};
+
+    {
+        StartupProfiler::Scope LoadScope{"Load D3D12 library"};
+        if (!LoadD3D12(EngineCI.D3D12DllName))
+            return;
+    }
 
     VERIFY(ppDevice && ppContexts, "Null pointer provided");
     if (!ppDevice || !ppContexts)
@@ -316,38 +322,42 @@ void EngineFactoryD3D12Impl::CreateDeviceAndContextsD3D12(const EngineD3D12Creat
             LOG_INFO_MESSAGE("D3D12-capable adapter found: ", NarrowString(desc.Description), " (", desc.DedicatedVideoMemory >> 20, " MB)");
         }
 
-        const Version FeatureLevelList[] = {{12, 1}, {12, 0}, {11, 1}, {11, 0}};
-        for (auto FeatureLevel : FeatureLevelList)
         {
-            auto d3dFeatureLevel = GetD3DFeatureLevel(FeatureLevel);
-
-            hr = D3D12CreateDevice(hardwareAdapter, d3dFeatureLevel, __uuidof(d3d12Device), reinterpret_cast<void**>(static_cast<ID3D12Device**>(&d3d12Device)));
-            if (SUCCEEDED(hr))
-            {
-                VERIFY_EXPR(d3d12Device);
-                break;
-            }
-        }
-        if (FAILED(hr))
-        {
-            LOG_WARNING_MESSAGE("Failed to create hardware device. Attempting to create WARP device");
-
-            CComPtr<IDXGIAdapter> warpAdapter;
-            hr = factory->EnumWarpAdapter(__uuidof(warpAdapter), reinterpret_cast<void**>(static_cast<IDXGIAdapter**>(&warpAdapter)));
-            CHECK_D3D_RESULT_THROW(hr, "Failed to enum warp adapter");
+            StartupProfiler::Scope DeviceScope{"Create D3D12 device"};
 
+            const Version FeatureLevelList[] = {{12, 1}, {12, 0}, {11, 1}, {11, 0}};
             for (auto FeatureLevel : FeatureLevelList)
             {
                 auto d3dFeatureLevel = GetD3DFeatureLevel(FeatureLevel);
 
-                hr = D3D12CreateDevice(warpAdapter, d3dFeatureLevel, __uuidof(d3d12Device), reinterpret_cast<void**>(static_cast<ID3D12Device**>(&d3d12Device)));
+                hr = D3D12CreateDevice(hardwareAdapter, d3dFeatureLevel, __uuidof(d3d12Device), reinterpret_cast<void**>(static_cast<ID3D12Device**>(&d3d12Device)));
                 if (SUCCEEDED(hr))
                 {
                     VERIFY_EXPR(d3d12Device);
                     break;
                 }
             }
-            CHECK_D3D_RESULT_THROW(hr, "Failed to create warp device");
+            if (FAILED(hr))
+            {
+                LOG_WARNING_MESSAGE("Failed to create hardware device. Attempting to create WARP device");
+
+                CComPtr<IDXGIAdapter> warpAdapter;
+                hr = factory->EnumWarpAdapter(__uuidof(warpAdapter), reinterpret_cast<void**>(static_cast<IDXGIAdapter**>(&warpAdapter)));
+                CHECK_D3D_RESULT_THROW(hr, "Failed to enum warp adapter");
+
+                for (auto FeatureLevel : FeatureLevelList)
+                {
+                    auto d3dFeatureLevel = GetD3DFeatureLevel(FeatureLevel);
+
+                    hr = D3D12CreateDevice(warpAdapter, d3dFeatureLevel, __uuidof(d3d12Device), reinterpret_cast<void**>(static_cast<ID3D12Device**>(&d3d12Device)));
+                    if (SUCCEEDED(hr))
+                    {
+                        VERIFY_EXPR(d3d12Device);
+                        break;
+                    }
+                }
+                CHECK_D3D_RESULT_THROW(hr, "Failed to create warp device");
+            }
         }
 
         if (EngineCI.EnableValidation)
@@ -549,9 +559,15 @@ void EngineFactoryD3D12Impl::AttachToD3D12Device(void*                        pd
         const auto AdapterInfo = GetGraphicsAdapterInfo(pd3d12NativeDevice, pDXGIAdapter1);
         VerifyEngineCreateInfo(EngineCI, AdapterInfo);
 
-        RenderDeviceD3D12Impl* pRenderDeviceD3D12{
-            NEW_RC_OBJ(RawMemAllocator, "RenderDeviceD3D12Impl instance", RenderDeviceD3D12Impl)(RawMemAllocator, this, EngineCI, AdapterInfo, d3d12Device, CommandQueueCount, ppCommandQueues)};
-        pRenderDeviceD3D12->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
+        RenderDeviceD3D12Impl* pRenderDeviceD3D12 = nullptr;
+        {
+            StartupProfiler::Scope RenderDeviceScope{"Create render device"};
+
+            pRenderDeviceD3D12 = NEW_RC_OBJ(RawMemAllocator, "RenderDeviceD3D12Impl instance", RenderDeviceD3D12Impl)(RawMemAllocator, this, EngineCI, AdapterInfo, d3d12Device, CommandQueueCount, ppCommandQueues);
+            pRenderDeviceD3D12->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
+        }
+
+        StartupProfiler::Scope ContextsScope{"Create device contexts"};
 
         for (Uint32 CtxInd = 0; CtxInd < NumImmediateContexts; ++CtxInd)
         {
@@ -1053,11 +1069,12 @@ GraphicsAdapterInfo EngineFactoryD3D12Impl::GetGraphicsAdapterInfo(void*
         DrawCommandProps.CapFlags |=
             DRAW_COMMAND_CAP_FLAG_BASE_VERTEX |
             DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW_INDIRECT |
-            DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER;
+            DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER |
+            DRAW_COMMAND_CAP_FLAG_PREDICATION;
         ASSERT_SIZEOF(DrawCommandProps, 12, "Did you add a new member to DrawCommandProperties? Please initialize it here.");
     }
 
-    ASSERT_SIZEOF(DeviceFeatures, 41, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
+    ASSERT_SIZEOF(DeviceFeatures, 42, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
 
     return AdapterInfo;
 }
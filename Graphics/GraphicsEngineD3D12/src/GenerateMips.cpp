@@ -44,6 +44,9 @@
 
 #include "pch.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "GenerateMips.hpp"
 
 #include "d3dx12_win.h"
@@ -115,58 +118,45 @@ GenerateMipsHelper::GenerateMipsHelper(ID3D12Device* pd3d12Device)
     CreatePSO(m_pGenerateMipsGammaPSO[3], g_pGenerateMipsGammaOddCS);
 }
 
-void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D12Impl* pTexView, CommandContext& Ctx) const
+namespace
 {
-    auto& ComputeCtx = Ctx.AsComputeContext();
-    ComputeCtx.SetComputeRootSignature(m_pGenerateMipsRS);
-    auto*       pTexD3D12 = pTexView->GetTexture<TextureD3D12Impl>();
-    const auto& TexDesc   = pTexD3D12->GetDesc();
-    const auto& ViewDesc  = pTexView->GetDesc();
-
-    bool IsAllSlices =
-        (TexDesc.Type != RESOURCE_DIM_TEX_1D_ARRAY &&
-         TexDesc.Type != RESOURCE_DIM_TEX_2D_ARRAY &&
-         TexDesc.Type != RESOURCE_DIM_TEX_CUBE_ARRAY) ||
-        TexDesc.ArraySize == ViewDesc.NumArraySlices;
-    bool IsAllMips = ViewDesc.NumMipLevels == TexDesc.MipLevels;
-
-    auto SRVDescriptorHandle = pTexView->GetTexArraySRV();
-
-    if (!pTexD3D12->IsInKnownState())
-    {
-        LOG_ERROR_MESSAGE("Unable to generate mips for texture '", TexDesc.Name, "' because the texture state is unknown");
-        return;
-    }
 
-    if (pTexD3D12->GetState() == RESOURCE_STATE_UNDEFINED)
+struct MipChainInfo
+{
+    TextureViewD3D12Impl*  pTexView      = nullptr;
+    TextureD3D12Impl*      pTexD3D12     = nullptr;
+    const TextureDesc*     pTexDesc      = nullptr;
+    const TextureViewDesc* pViewDesc     = nullptr;
+    RESOURCE_STATE         OriginalState = RESOURCE_STATE_UNKNOWN;
+    RESOURCE_STATE         FinalState    = RESOURCE_STATE_UNKNOWN;
+
+    // Mip levels relative to the view's most detailed mip
+    Uint32 TopMip    = 0;
+    Uint32 BottomMip = 0;
+
+    // Parameters of the current pass
+    Uint32              NumMips       = 0;
+    Uint32              NonPowerOfTwo = 0;
+    Uint32              DstWidth      = 0;
+    Uint32              DstHeight     = 0;
+    StateTransitionDesc SrcMipBarrier;
+    StateTransitionDesc DstMipsBarrier;
+
+    bool IsComplete() const { return TopMip >= BottomMip; }
+
+    void InitPass()
     {
-        // If texture state is undefined, transition it to shader resource state.
-        // We need all subresources to be in a defined state at the end of the procedure.
-        Ctx.TransitionResource(*pTexD3D12, RESOURCE_STATE_SHADER_RESOURCE);
-    }
+        const auto& TexDesc  = *pTexDesc;
+        const auto& ViewDesc = *pViewDesc;
 
-    const auto OriginalState = pTexD3D12->GetState();
-    pTexD3D12->SetState(RESOURCE_STATE_UNKNOWN); // Switch to manual state management
-
-    // If we are processing the entire texture, we will leave it in SHADER_RESOURCE layout.
-    // Otherwise we will transition affected subresources back to original layout.
-    const auto FinalState = (IsAllSlices && IsAllMips) ? RESOURCE_STATE_SHADER_RESOURCE : OriginalState;
-
-    auto BottomMip = ViewDesc.NumMipLevels - 1;
-    for (uint32_t TopMip = 0; TopMip < BottomMip;)
-    {
-        uint32_t SrcWidth  = std::max(TexDesc.Width >> (TopMip + ViewDesc.MostDetailedMip), 1u);
-        uint32_t SrcHeight = std::max(TexDesc.Height >> (TopMip + ViewDesc.MostDetailedMip), 1u);
-        uint32_t DstWidth  = std::max(SrcWidth >> 1, 1u);
-        uint32_t DstHeight = std::max(SrcHeight >> 1, 1u);
+        Uint32 SrcWidth  = std::max(TexDesc.Width >> (TopMip + ViewDesc.MostDetailedMip), 1u);
+        Uint32 SrcHeight = std::max(TexDesc.Height >> (TopMip + ViewDesc.MostDetailedMip), 1u);
+        DstWidth         = std::max(SrcWidth >> 1, 1u);
+        DstHeight        = std::max(SrcHeight >> 1, 1u);
 
         // Determine if the first downsample is more than 2:1.  This happens whenever
         // the source width or height is odd.
-        uint32_t NonPowerOfTwo = (SrcWidth & 1) | (SrcHeight & 1) << 1;
-        if (TexDesc.Format == TEX_FORMAT_RGBA8_UNORM_SRGB)
-            ComputeCtx.SetPipelineState(m_pGenerateMipsGammaPSO[NonPowerOfTwo]);
-        else
-            ComputeCtx.SetPipelineState(m_pGenerateMipsLinearPSO[NonPowerOfTwo]);
+        NonPowerOfTwo = (SrcWidth & 1) | (SrcHeight & 1) << 1;
 
         // We can downsample up to four times, but if the ratio between levels is not
         // exactly 2:1, we have to shift our blend weights, which gets complicated or
@@ -175,82 +165,37 @@ void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D
         // in the low bits.  Zeros indicate we can divide by two without truncating.
         uint32_t AdditionalMips;
         _BitScanForward((unsigned long*)&AdditionalMips, DstWidth | DstHeight);
-        uint32_t NumMips = 1 + (AdditionalMips > 3 ? 3 : AdditionalMips);
+        NumMips = 1 + (AdditionalMips > 3 ? 3 : AdditionalMips);
         if (TopMip + NumMips > BottomMip)
             NumMips = BottomMip - TopMip;
 
-        // These are clamped to 1 after computing additional mips because clamped
-        // dimensions should not limit us from downsampling multiple times.  (E.g.
-        // 16x1 -> 8x1 -> 4x1 -> 2x1 -> 1x1.)
-        if (DstWidth == 0)
-            DstWidth = 1;
-        if (DstHeight == 0)
-            DstHeight = 1;
-
-        D3D12_DESCRIPTOR_HEAP_TYPE HeapType        = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-        auto                       DescriptorAlloc = Ctx.AllocateDynamicGPUVisibleDescriptor(HeapType, 5);
-
-        CommandContext::ShaderDescriptorHeaps Heaps{DescriptorAlloc.GetDescriptorHeap(), nullptr};
-        ComputeCtx.SetDescriptorHeaps(Heaps);
-        Ctx.GetCommandList()->SetComputeRootDescriptorTable(1, DescriptorAlloc.GetGpuHandle(0));
-        Ctx.GetCommandList()->SetComputeRootDescriptorTable(2, DescriptorAlloc.GetGpuHandle(1));
-        struct RootCBData
-        {
-            Uint32 SrcMipLevel;  // Texture level of source mip
-            Uint32 NumMipLevels; // Number of OutMips to write: [1, 4]
-            Uint32 FirstArraySlice;
-            Uint32 Dummy;
-            float  TexelSize[2]; // 1.0 / OutMip1.Dimensions
-        };
-        RootCBData CBData{
-            TopMip, // Mip levels are relateive to the view's most detailed mip
-            NumMips,
-            0, // Array slices are relative to the view's first array slice
-            0,
-            1.0f / static_cast<float>(DstWidth), 1.0f / static_cast<float>(DstHeight)};
-
-        Ctx.GetCommandList()->SetComputeRoot32BitConstants(0, 6, &CBData, 0);
-
-        D3D12_CPU_DESCRIPTOR_HANDLE DstDescriptorRange     = DescriptorAlloc.GetCpuHandle();
-        const Uint32                MaxMipsHandledByCS     = 4; // Max number of mip levels processed by one CS shader invocation
-        UINT                        DstRangeSize           = 1 + MaxMipsHandledByCS;
-        D3D12_CPU_DESCRIPTOR_HANDLE SrcDescriptorRanges[5] = {};
-
-        SrcDescriptorRanges[0] = SRVDescriptorHandle;
-        UINT SrcRangeSizes[5]  = {1, 1, 1, 1, 1};
-        // On Resource Binding Tier 2 hardware, all descriptor tables of type CBV and UAV declared in the set
-        // Root Signature must be populated and initialized, even if the shaders do not need the descriptor.
-        // So we must populate all 4 slots even though we may actually process less than 4 mip levels
-        // Copy top mip level UAV descriptor handle to all unused slots
-        for (Uint32 u = 0; u < MaxMipsHandledByCS; ++u)
-            SrcDescriptorRanges[1 + u] = pTexView->GetMipLevelUAV(TopMip + std::min(u + 1, NumMips));
-
-        pd3d12Device->CopyDescriptors(1, &DstDescriptorRange, &DstRangeSize, 1 + MaxMipsHandledByCS, SrcDescriptorRanges, SrcRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+        SrcMipBarrier  = StateTransitionDesc{pTexD3D12, TopMip == 0 ? OriginalState : RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_NONE};
+        DstMipsBarrier = StateTransitionDesc{pTexD3D12, OriginalState, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_NONE};
+
+        SrcMipBarrier.FirstMipLevel   = ViewDesc.MostDetailedMip + TopMip;
+        SrcMipBarrier.MipLevelsCount  = 1;
+        SrcMipBarrier.FirstArraySlice = ViewDesc.FirstArraySlice;
+        SrcMipBarrier.ArraySliceCount = ViewDesc.NumArraySlices;
 
+        DstMipsBarrier.FirstMipLevel   = ViewDesc.MostDetailedMip + TopMip + 1;
+        DstMipsBarrier.MipLevelsCount  = NumMips;
+        DstMipsBarrier.FirstArraySlice = ViewDesc.FirstArraySlice;
+        DstMipsBarrier.ArraySliceCount = ViewDesc.NumArraySlices;
+    }
+
+    void TransitionMipsBeforePass(CommandContext& Ctx) const
+    {
         // Transition top mip level to the shader resource state
-        StateTransitionDesc SrcMipBarrier{pTexD3D12, TopMip == 0 ? OriginalState : RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_NONE};
         if (SrcMipBarrier.OldState != SrcMipBarrier.NewState)
-        {
-            SrcMipBarrier.FirstMipLevel   = ViewDesc.MostDetailedMip + TopMip;
-            SrcMipBarrier.MipLevelsCount  = 1;
-            SrcMipBarrier.FirstArraySlice = ViewDesc.FirstArraySlice;
-            SrcMipBarrier.ArraySliceCount = ViewDesc.NumArraySlices;
             Ctx.TransitionResource(*pTexD3D12, SrcMipBarrier);
-        }
 
         // Transition dst mip levels to UAV state
-        StateTransitionDesc DstMipsBarrier{pTexD3D12, OriginalState, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_NONE};
         if (DstMipsBarrier.OldState != DstMipsBarrier.NewState)
-        {
-            DstMipsBarrier.FirstMipLevel   = ViewDesc.MostDetailedMip + TopMip + 1;
-            DstMipsBarrier.MipLevelsCount  = NumMips;
-            DstMipsBarrier.FirstArraySlice = ViewDesc.FirstArraySlice;
-            DstMipsBarrier.ArraySliceCount = ViewDesc.NumArraySlices;
             Ctx.TransitionResource(*pTexD3D12, DstMipsBarrier);
-        }
-
-        ComputeCtx.Dispatch((DstWidth + 7) / 8, (DstHeight + 7) / 8, ViewDesc.NumArraySlices);
+    }
 
+    void TransitionMipsAfterPass(CommandContext& Ctx)
+    {
         // Transition the lowest level back to original layout or leave it in RESOURCE_STATE_SHADER_RESOURCE
         // if all subresources are processed
         if (SrcMipBarrier.NewState != FinalState)
@@ -273,8 +218,176 @@ void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D
 
         TopMip += NumMips;
     }
+};
+
+} // namespace
+
+void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D12Impl* pTexView, CommandContext& Ctx) const
+{
+    GenerateMips(pd3d12Device, &pTexView, 1, Ctx);
+}
+
+void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D12Impl* const* ppTexViews, Uint32 NumViews, CommandContext& Ctx) const
+{
+    std::vector<MipChainInfo> Chains;
+    Chains.reserve(NumViews);
+    for (Uint32 i = 0; i < NumViews; ++i)
+    {
+        MipChainInfo Chain;
+        Chain.pTexView  = ppTexViews[i];
+        Chain.pTexD3D12 = Chain.pTexView->GetTexture<TextureD3D12Impl>();
+        Chain.pTexDesc  = &Chain.pTexD3D12->GetDesc();
+        Chain.pViewDesc = &Chain.pTexView->GetDesc();
+
+        if (!Chain.pTexD3D12->IsInKnownState())
+        {
+            LOG_ERROR_MESSAGE("Unable to generate mips for texture '", Chain.pTexDesc->Name, "' because the texture state is unknown");
+            continue;
+        }
+        Chains.push_back(Chain);
+    }
+    if (Chains.empty())
+        return;
+
+    // Group the textures by format and size, so that consecutive dispatches of every pass
+    // use the same pipeline state.
+    std::stable_sort(Chains.begin(), Chains.end(),
+                     [](const MipChainInfo& Chain0, const MipChainInfo& Chain1) {
+                         const auto& Desc0 = *Chain0.pTexDesc;
+                         const auto& Desc1 = *Chain1.pTexDesc;
+                         if (Desc0.Format != Desc1.Format)
+                             return Desc0.Format < Desc1.Format;
+                         if (Desc0.Width != Desc1.Width)
+                             return Desc0.Width > Desc1.Width;
+                         return Desc0.Height > Desc1.Height;
+                     });
+
+    for (auto& Chain : Chains)
+    {
+        auto*       pTexD3D12 = Chain.pTexD3D12;
+        const auto& TexDesc   = *Chain.pTexDesc;
+        const auto& ViewDesc  = *Chain.pViewDesc;
+
+        bool IsAllSlices =
+            (TexDesc.Type != RESOURCE_DIM_TEX_1D_ARRAY &&
+             TexDesc.Type != RESOURCE_DIM_TEX_2D_ARRAY &&
+             TexDesc.Type != RESOURCE_DIM_TEX_CUBE_ARRAY) ||
+            TexDesc.ArraySize == ViewDesc.NumArraySlices;
+        bool IsAllMips = ViewDesc.NumMipLevels == TexDesc.MipLevels;
+
+        if (pTexD3D12->GetState() == RESOURCE_STATE_UNDEFINED)
+        {
+            // If texture state is undefined, transition it to shader resource state.
+            // We need all subresources to be in a defined state at the end of the procedure.
+            Ctx.TransitionResource(*pTexD3D12, RESOURCE_STATE_SHADER_RESOURCE);
+        }
+
+        if (pTexD3D12->GetState() == RESOURCE_STATE_UNKNOWN)
+        {
+            // Another view of the same texture is processed in this batch, and the texture has
+            // already been switched to manual state management.
+            auto FirstChain = std::find_if(Chains.begin(), Chains.end(), [pTexD3D12](const MipChainInfo& Other) { return Other.pTexD3D12 == pTexD3D12; });
+            VERIFY_EXPR(&*FirstChain != &Chain);
+            Chain.OriginalState = FirstChain->OriginalState;
+        }
+        else
+        {
+            Chain.OriginalState = pTexD3D12->GetState();
+            pTexD3D12->SetState(RESOURCE_STATE_UNKNOWN); // Switch to manual state management
+        }
+
+        // If we are processing the entire texture, we will leave it in SHADER_RESOURCE layout.
+        // Otherwise we will transition affected subresources back to original layout.
+        Chain.FinalState = (IsAllSlices && IsAllMips) ? RESOURCE_STATE_SHADER_RESOURCE : Chain.OriginalState;
+
+        Chain.TopMip    = 0;
+        Chain.BottomMip = ViewDesc.NumMipLevels - 1;
+    }
+
+    auto& ComputeCtx = Ctx.AsComputeContext();
+    ComputeCtx.SetComputeRootSignature(m_pGenerateMipsRS);
+
+    // Every pass downsamples up to four mip levels of every texture. The transitions of all textures
+    // are recorded before the dispatches of the pass, so that the first dispatch flushes them
+    // together with the transitions that follow the previous pass.
+    bool AllComplete = false;
+    while (!AllComplete)
+    {
+        for (auto& Chain : Chains)
+        {
+            if (Chain.IsComplete())
+                continue;
+
+            Chain.InitPass();
+            Chain.TransitionMipsBeforePass(Ctx);
+        }
+
+        for (const auto& Chain : Chains)
+        {
+            if (Chain.IsComplete())
+                continue;
+
+            if (Chain.pTexDesc->Format == TEX_FORMAT_RGBA8_UNORM_SRGB)
+                ComputeCtx.SetPipelineState(m_pGenerateMipsGammaPSO[Chain.NonPowerOfTwo]);
+            else
+                ComputeCtx.SetPipelineState(m_pGenerateMipsLinearPSO[Chain.NonPowerOfTwo]);
+
+            D3D12_DESCRIPTOR_HEAP_TYPE HeapType        = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+            auto                       DescriptorAlloc = Ctx.AllocateDynamicGPUVisibleDescriptor(HeapType, 5);
+
+            CommandContext::ShaderDescriptorHeaps Heaps{DescriptorAlloc.GetDescriptorHeap(), nullptr};
+            ComputeCtx.SetDescriptorHeaps(Heaps);
+            Ctx.GetCommandList()->SetComputeRootDescriptorTable(1, DescriptorAlloc.GetGpuHandle(0));
+            Ctx.GetCommandList()->SetComputeRootDescriptorTable(2, DescriptorAlloc.GetGpuHandle(1));
+            struct RootCBData
+            {
+                Uint32 SrcMipLevel;  // Texture level of source mip
+                Uint32 NumMipLevels; // Number of OutMips to write: [1, 4]
+                Uint32 FirstArraySlice;
+                Uint32 Dummy;
+                float  TexelSize[2]; // 1.0 / OutMip1.Dimensions
+            };
+            RootCBData CBData{
+                Chain.TopMip, // Mip levels are relateive to the view's most detailed mip
+                Chain.NumMips,
+                0, // Array slices are relative to the view's first array slice
+                0,
+                1.0f / static_cast<float>(Chain.DstWidth), 1.0f / static_cast<float>(Chain.DstHeight)};
+
+            Ctx.GetCommandList()->SetComputeRoot32BitConstants(0, 6, &CBData, 0);
+
+            D3D12_CPU_DESCRIPTOR_HANDLE DstDescriptorRange     = DescriptorAlloc.GetCpuHandle();
+            const Uint32                MaxMipsHandledByCS     = 4; // Max number of mip levels processed by one CS shader invocation
+            UINT                        DstRangeSize           = 1 + MaxMipsHandledByCS;
+            D3D12_CPU_DESCRIPTOR_HANDLE SrcDescriptorRanges[5] = {};
+
+            SrcDescriptorRanges[0] = Chain.pTexView->GetTexArraySRV();
+            UINT SrcRangeSizes[5]  = {1, 1, 1, 1, 1};
+            // On Resource Binding Tier 2 hardware, all descriptor tables of type CBV and UAV declared in the set
+            // Root Signature must be populated and initialized, even if the shaders do not need the descriptor.
+            // So we must populate all 4 slots even though we may actually process less than 4 mip levels
+            // Copy top mip level UAV descriptor handle to all unused slots
+            for (Uint32 u = 0; u < MaxMipsHandledByCS; ++u)
+                SrcDescriptorRanges[1 + u] = Chain.pTexView->GetMipLevelUAV(Chain.TopMip + std::min(u + 1, Chain.NumMips));
+
+            pd3d12Device->CopyDescriptors(1, &DstDescriptorRange, &DstRangeSize, 1 + MaxMipsHandledByCS, SrcDescriptorRanges, SrcRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+            ComputeCtx.Dispatch((Chain.DstWidth + 7) / 8, (Chain.DstHeight + 7) / 8, Chain.pViewDesc->NumArraySlices);
+        }
+
+        AllComplete = true;
+        for (auto& Chain : Chains)
+        {
+            if (Chain.IsComplete())
+                continue;
+
+            Chain.TransitionMipsAfterPass(Ctx);
+            AllComplete = AllComplete && Chain.IsComplete();
+        }
+    }
 
     // Set state
-    pTexD3D12->SetState(FinalState);
+    for (auto& Chain : Chains)
+        Chain.pTexD3D12->SetState(Chain.FinalState);
 }
 } // namespace Diligent
@@ -533,6 +533,80 @@ void PipelineResourceSignatureD3D12Impl::CommitRootViews(const CommitCacheResour
     }
 }
 
+void PipelineResourceSignatureD3D12Impl::DynamicDescriptorCopyBatch::AddRange(D3D12_DESCRIPTOR_HEAP_TYPE  d3d12HeapType,
+                                                                              D3D12_CPU_DESCRIPTOR_HANDLE DstHandle,
+                                                                              D3D12_CPU_DESCRIPTOR_HANDLE SrcHandle,
+                                                                              UINT                        NumDescriptors,
+                                                                              UINT                        DescriptorSize)
+{
+    VERIFY_EXPR(d3d12HeapType < m_Heaps.size());
+    VERIFY_EXPR(NumDescriptors > 0);
+
+    auto& Heap = m_Heaps[d3d12HeapType];
+    VERIFY(Heap.DescriptorSize == 0 || Heap.DescriptorSize == DescriptorSize, "Inconsistent descriptor size");
+    Heap.DescriptorSize = DescriptorSize;
+
+    // Source and destination ranges are independent in CopyDescriptors, so adjacent
+    // ranges are merged separately. Consecutive dynamic allocations are typically
+    // contiguous in the GPU-visible heap.
+    const auto TryMerge = [DescriptorSize, NumDescriptors](D3D12_CPU_DESCRIPTOR_HANDLE* Handles, UINT* Sizes, UINT NumRanges, D3D12_CPU_DESCRIPTOR_HANDLE Handle) {
+        if (NumRanges == 0)
+            return false;
+
+        const auto LastRange = NumRanges - 1;
+        if (Handles[LastRange].ptr + SIZE_T{Sizes[LastRange]} * SIZE_T{DescriptorSize} != Handle.ptr)
+            return false;
+
+        Sizes[LastRange] += NumDescriptors;
+        return true;
+    };
+
+    if (!TryMerge(Heap.DstHandles.data(), Heap.DstSizes.data(), Heap.NumDstRanges, DstHandle))
+    {
+        VERIFY(Heap.NumDstRanges < Heap.DstHandles.size(), "Too many descriptor ranges");
+        Heap.DstHandles[Heap.NumDstRanges] = DstHandle;
+        Heap.DstSizes[Heap.NumDstRanges]   = NumDescriptors;
+        ++Heap.NumDstRanges;
+    }
+
+    if (!TryMerge(Heap.SrcHandles.data(), Heap.SrcSizes.data(), Heap.NumSrcRanges, SrcHandle))
+    {
+        VERIFY(Heap.NumSrcRanges < Heap.SrcHandles.size(), "Too many descriptor ranges");
+        Heap.SrcHandles[Heap.NumSrcRanges] = SrcHandle;
+        Heap.SrcSizes[Heap.NumSrcRanges]   = NumDescriptors;
+        ++Heap.NumSrcRanges;
+    }
+}
+
+void PipelineResourceSignatureD3D12Impl::DynamicDescriptorCopyBatch::Flush(ID3D12Device* pd3d12Device)
+{
+    for (Uint32 heap_type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV; heap_type < m_Heaps.size(); ++heap_type)
+    {
+        auto& Heap = m_Heaps[heap_type];
+        if (Heap.NumDstRanges == 0)
+        {
+            VERIFY_EXPR(Heap.NumSrcRanges == 0);
+            continue;
+        }
+
+        const auto d3d12HeapType = static_cast<D3D12_DESCRIPTOR_HEAP_TYPE>(heap_type);
+        if (Heap.NumDstRanges == 1 && Heap.NumSrcRanges == 1)
+        {
+            VERIFY_EXPR(Heap.DstSizes[0] == Heap.SrcSizes[0]);
+            pd3d12Device->CopyDescriptorsSimple(Heap.DstSizes[0], Heap.DstHandles[0], Heap.SrcHandles[0], d3d12HeapType);
+        }
+        else
+        {
+            pd3d12Device->CopyDescriptors(Heap.NumDstRanges, Heap.DstHandles.data(), Heap.DstSizes.data(),
+                                          Heap.NumSrcRanges, Heap.SrcHandles.data(), Heap.SrcSizes.data(),
+                                          d3d12HeapType);
+        }
+
+        Heap.NumDstRanges = 0;
+        Heap.NumSrcRanges = 0;
+    }
+}
+
 void PipelineResourceSignatureD3D12Impl::CommitRootTables(const CommitCacheResourcesAttribs& CommitAttribs) const
 {
     VERIFY_EXPR(CommitAttribs.pResourceCache != nullptr);
@@ -572,7 +646,16 @@ void PipelineResourceSignatureD3D12Impl::CommitRootTables(const CommitCacheResou
             // Copy all dynamic descriptors from the CPU-only cache allocation
             const auto& SrcDynamicAllocation = ResourceCache.GetDescriptorAllocation(d3d12HeapType, ROOT_PARAMETER_GROUP_DYNAMIC);
             VERIFY_EXPR(SrcDynamicAllocation.GetNumHandles() == NumDynamicDescriptors);
-            pd3d12Device->CopyDescriptorsSimple(NumDynamicDescriptors, pAllocation->GetCpuHandle(), SrcDynamicAllocation.GetCpuHandle(), d3d12HeapType);
+            if (CommitAttribs.pDescriptorCopyBatch != nullptr)
+            {
+                // The CPU handles of dynamic GPU-visible allocations remain valid until the end of the frame
+                CommitAttribs.pDescriptorCopyBatch->AddRange(d3d12HeapType, pAllocation->GetCpuHandle(), SrcDynamicAllocation.GetCpuHandle(),
+                                                             NumDynamicDescriptors, pAllocation->GetDescriptorSize());
+            }
+            else
+            {
+                pd3d12Device->CopyDescriptorsSimple(NumDynamicDescriptors, pAllocation->GetCpuHandle(), SrcDynamicAllocation.GetCpuHandle(), d3d12HeapType);
+            }
         }
     }
 
@@ -32,6 +32,81 @@
 namespace Diligent
 {
 
+namespace
+{
+
+// Cache data layout:
+//
+//   CacheDataHeader
+//   Pipeline library data (LibrarySize bytes)
+//   NumRootSignatures x { Uint32 KeySize, Uint32 BlobSize, Key bytes, Blob bytes }
+//
+// Data that does not start with the header is treated as a raw pipeline library blob.
+struct CacheDataHeader
+{
+    static constexpr Uint32 ExpectedMagic   = 0x43535044; // 'DPSC'
+    static constexpr Uint32 ExpectedVersion = 1;
+
+    Uint32 Magic             = ExpectedMagic;
+    Uint32 Version           = ExpectedVersion;
+    Uint64 LibrarySize       = 0;
+    Uint32 NumRootSignatures = 0;
+    Uint32 Reserved          = 0;
+};
+static_assert(sizeof(CacheDataHeader) == 24, "Cache data header size must not change");
+
+} // namespace
+
+bool PipelineStateCacheD3D12Impl::ParseCacheData(const void* pData, size_t DataSize, const void*& pLibraryData, size_t& LibraryDataSize)
+{
+    const auto* const pStart = static_cast<const Uint8*>(pData);
+    const auto* const pEnd   = pStart + DataSize;
+
+    CacheDataHeader Header;
+    if (DataSize >= sizeof(Header))
+        memcpy(&Header, pStart, sizeof(Header));
+    else
+        Header.Magic = 0;
+
+    if (Header.Magic != CacheDataHeader::ExpectedMagic)
+    {
+        // Data produced by the previous cache versions contains the pipeline library only.
+        pLibraryData    = pData;
+        LibraryDataSize = DataSize;
+        return true;
+    }
+
+    if (Header.Version != CacheDataHeader::ExpectedVersion)
+        return false;
+
+    const auto* pCurr = pStart + sizeof(Header);
+    if (Header.LibrarySize > static_cast<size_t>(pEnd - pCurr))
+        return false;
+
+    pLibraryData    = pCurr;
+    LibraryDataSize = StaticCast<size_t>(Header.LibrarySize);
+    pCurr += LibraryDataSize;
+
+    for (Uint32 i = 0; i < Header.NumRootSignatures; ++i)
+    {
+        Uint32 Sizes[2] = {}; // KeySize, BlobSize
+        if (sizeof(Sizes) > static_cast<size_t>(pEnd - pCurr))
+            return false;
+        memcpy(Sizes, pCurr, sizeof(Sizes));
+        pCurr += sizeof(Sizes);
+
+        if (size_t{Sizes[0]} + size_t{Sizes[1]} > static_cast<size_t>(pEnd - pCurr))
+            return false;
+
+        std::string Key{reinterpret_cast<const char*>(pCurr), Sizes[0]};
+        pCurr += Sizes[0];
+        m_RootSigs.emplace(std::move(Key), DataBlobImpl::Create(Sizes[1], pCurr));
+        pCurr += Sizes[1];
+    }
+
+    return true;
+}
+
 PipelineStateCacheD3D12Impl::PipelineStateCacheD3D12Impl(IReferenceCounters*                 pRefCounters,
                                                          RenderDeviceD3D12Impl*              pRenderDeviceD3D12,
                                                          const PipelineStateCacheCreateInfo& CreateInfo) :
@@ -45,15 +120,48 @@ PipelineStateCacheD3D12Impl::PipelineStateCacheD3D12Impl(IReferenceCounters*
     }
 // clang-format on
 {
-    auto hr = pRenderDeviceD3D12->GetD3D12Device1()->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_pLibrary));
-    if (FAILED(hr))
-        LOG_ERROR_AND_THROW("Failed to create D3D12 pipeline library");
+    auto* const pd3d12Device1 = pRenderDeviceD3D12->GetD3D12Device1();
+
+    const void* pLibraryData    = nullptr;
+    size_t      LibraryDataSize = 0;
+    if (CreateInfo.pCacheData != nullptr && CreateInfo.CacheDataSize > 0 && (m_Desc.Mode & PSO_CACHE_MODE_LOAD) != 0)
+    {
+        if (!ParseCacheData(CreateInfo.pCacheData, CreateInfo.CacheDataSize, pLibraryData, LibraryDataSize))
+        {
+            LOG_WARNING_MESSAGE("D3D12 pipeline state cache data is invalid and will be ignored");
+            m_RootSigs.clear();
+            LibraryDataSize = 0;
+        }
+    }
+
+    if (LibraryDataSize > 0)
+    {
+        m_pLibraryData = DataBlobImpl::Create(LibraryDataSize, pLibraryData);
+
+        auto hr = pd3d12Device1->CreatePipelineLibrary(m_pLibraryData->GetConstDataPtr(), LibraryDataSize, IID_PPV_ARGS(&m_pLibrary));
+        if (FAILED(hr))
+        {
+            // This is expected when the driver or the adapter has changed. Serialized root signatures
+            // do not depend on the driver and remain valid.
+            LOG_INFO_MESSAGE("Failed to load D3D12 pipeline library from the cache data. An empty library will be used.");
+            m_pLibraryData.Release();
+        }
+    }
+
+    if (!m_pLibrary)
+    {
+        auto hr = pd3d12Device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_pLibrary));
+        if (FAILED(hr))
+            LOG_ERROR_AND_THROW("Failed to create D3D12 pipeline library");
+    }
 }
 
 PipelineStateCacheD3D12Impl::~PipelineStateCacheD3D12Impl()
 {
     // D3D12 object can only be destroyed when it is no longer used by the GPU
     GetDevice()->SafeReleaseDeviceObject(std::move(m_pLibrary), ~Uint64{0});
+    if (m_pLibraryData)
+        GetDevice()->SafeReleaseDeviceObject(std::move(m_pLibraryData), ~Uint64{0});
 }
 
 CComPtr<ID3D12DeviceChild> PipelineStateCacheD3D12Impl::LoadComputePipeline(const wchar_t* Name, const D3D12_COMPUTE_PIPELINE_STATE_DESC& Desc)
@@ -93,19 +201,67 @@ bool PipelineStateCacheD3D12Impl::StorePipeline(const wchar_t* Name, ID3D12Devic
     return SUCCEEDED(hr);
 }
 
+RefCntAutoPtr<IDataBlob> PipelineStateCacheD3D12Impl::LoadRootSignature(const std::string& DescKey)
+{
+    if ((m_Desc.Mode & PSO_CACHE_MODE_LOAD) == 0)
+        return {};
+
+    std::lock_guard<std::mutex> Lock{m_RootSigsMtx};
+
+    auto it = m_RootSigs.find(DescKey);
+    return it != m_RootSigs.end() ? it->second : RefCntAutoPtr<IDataBlob>{};
+}
+
+void PipelineStateCacheD3D12Impl::StoreRootSignature(const std::string& DescKey, IDataBlob* pSerializedRootSig)
+{
+    VERIFY_EXPR(pSerializedRootSig != nullptr);
+    if ((m_Desc.Mode & PSO_CACHE_MODE_STORE) == 0)
+        return;
+
+    std::lock_guard<std::mutex> Lock{m_RootSigsMtx};
+    m_RootSigs.emplace(DescKey, pSerializedRootSig);
+}
+
 void PipelineStateCacheD3D12Impl::GetData(IDataBlob** ppBlob)
 {
     DEV_CHECK_ERR(ppBlob != nullptr, "ppBlob must not be null");
     *ppBlob = nullptr;
 
-    auto pDataBlob = DataBlobImpl::Create(m_pLibrary->GetSerializedSize());
+    std::lock_guard<std::mutex> Lock{m_RootSigsMtx};
+
+    CacheDataHeader Header;
+    Header.LibrarySize       = m_pLibrary->GetSerializedSize();
+    Header.NumRootSignatures = static_cast<Uint32>(m_RootSigs.size());
 
-    auto hr = m_pLibrary->Serialize(pDataBlob->GetDataPtr(), pDataBlob->GetSize());
+    size_t DataSize = sizeof(Header) + StaticCast<size_t>(Header.LibrarySize);
+    for (const auto& it : m_RootSigs)
+        DataSize += sizeof(Uint32) * 2 + it.first.size() + it.second->GetSize();
+
+    auto  pDataBlob = DataBlobImpl::Create(DataSize);
+    auto* pData     = pDataBlob->GetDataPtr<Uint8>();
+
+    memcpy(pData, &Header, sizeof(Header));
+    pData += sizeof(Header);
+
+    auto hr = m_pLibrary->Serialize(pData, StaticCast<SIZE_T>(Header.LibrarySize));
     if (FAILED(hr))
     {
         LOG_ERROR_MESSAGE("Failed to serialize D3D12 pipeline library");
         return;
     }
+    pData += Header.LibrarySize;
+
+    for (const auto& it : m_RootSigs)
+    {
+        const Uint32 Sizes[] = {static_cast<Uint32>(it.first.size()), static_cast<Uint32>(it.second->GetSize())};
+        memcpy(pData, Sizes, sizeof(Sizes));
+        pData += sizeof(Sizes);
+        memcpy(pData, it.first.data(), Sizes[0]);
+        pData += Sizes[0];
+        memcpy(pData, it.second->GetConstDataPtr(), Sizes[1]);
+        pData += Sizes[1];
+    }
+    VERIFY_EXPR(pData == pDataBlob->GetDataPtr<Uint8>() + DataSize);
 
     *ppBlob = pDataBlob.Detach();
 }
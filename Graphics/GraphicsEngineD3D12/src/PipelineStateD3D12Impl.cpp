@@ -31,6 +31,7 @@
 #include "PipelineStateCacheD3D12Impl.hpp"
 
 #include <array>
+#include <memory>
 #include <sstream>
 #include <unordered_map>
 
@@ -517,10 +518,16 @@ void PipelineStateD3D12Impl::InitRootSignature(const PipelineStateCreateInfo& Cr
         VERIFY_EXPR(m_Signatures[0]);
     }
 
-    m_RootSig = GetDevice()->GetRootSignatureCache().GetRootSig(m_Signatures, m_SignatureCount);
+    auto* const pPSOCacheD3D12 = ClassPtrCast<PipelineStateCacheD3D12Impl>(CreateInfo.pPSOCache);
+
+    m_RootSig = GetDevice()->GetRootSignatureCache().GetRootSig(m_Signatures, m_SignatureCount, pPSOCacheD3D12);
     if (!m_RootSig)
         LOG_ERROR_AND_THROW("Failed to create root signature for pipeline '", m_Desc.Name, "'.");
 
+    // The root signature may have been created for another pipeline, so always add it to the cache.
+    if (pPSOCacheD3D12 != nullptr)
+        pPSOCacheD3D12->StoreRootSignature(m_RootSig->GetDescKey(), m_RootSig->GetSerializedData());
+
     if (pLocalRootSig != nullptr && pLocalRootSig->IsDefined())
     {
         if (!pLocalRootSig->Create(GetDevice()->GetD3D12Device(), m_RootSig->GetTotalSpaces()))
@@ -679,205 +686,232 @@ PipelineStateD3D12Impl::PipelineStateD3D12Impl(IReferenceCounters*
 {
     try
     {
-        const auto WName = WidenString(m_Desc.Name);
-
-        TShaderStages ShaderStages;
-        InitInternalObjects(CreateInfo, ShaderStages);
+        InitializePipeline(
+            CreateInfo,
+            [this](const GraphicsPipelineStateCreateInfo& CI, bool CacheOnly) -> CompilePipelineFuncType //
+            {
+                // The shader byte codes are shared with the compilation function that may run in another thread
+                auto pShaderStages = std::make_shared<TShaderStages>();
+                InitInternalObjects(CI, *pShaderStages);
 
-        auto* pd3d12Device = pDeviceD3D12->GetD3D12Device();
-        if (m_Desc.PipelineType == PIPELINE_TYPE_GRAPHICS)
-        {
-            const auto& GraphicsPipeline = GetGraphicsPipelineDesc();
+                RefCntAutoPtr<IPipelineStateCache> pPSOCache{CI.pPSOCache};
 
-            D3D12_GRAPHICS_PIPELINE_STATE_DESC d3d12PSODesc = {};
+                auto CreatePipeline = [this, pShaderStages, pPSOCache](bool FailIfCompileRequired) {
+                    const auto  WName        = WidenString(m_Desc.Name);
+                    const auto& ShaderStages = *pShaderStages;
 
-            for (const auto& Stage : ShaderStages)
-            {
-                VERIFY_EXPR(Stage.Count() == 1);
-                const auto& pByteCode = Stage.ByteCodes[0];
+                    auto* pd3d12Device = GetDevice()->GetD3D12Device();
+                    if (m_Desc.PipelineType == PIPELINE_TYPE_GRAPHICS)
+                    {
+                        const auto& GraphicsPipeline = GetGraphicsPipelineDesc();
 
-                D3D12_SHADER_BYTECODE* pd3d12ShaderBytecode = nullptr;
-                switch (Stage.Type)
-                {
-                    // clang-format off
-                    case SHADER_TYPE_VERTEX:   pd3d12ShaderBytecode = &d3d12PSODesc.VS; break;
-                    case SHADER_TYPE_PIXEL:    pd3d12ShaderBytecode = &d3d12PSODesc.PS; break;
-                    case SHADER_TYPE_GEOMETRY: pd3d12ShaderBytecode = &d3d12PSODesc.GS; break;
-                    case SHADER_TYPE_HULL:     pd3d12ShaderBytecode = &d3d12PSODesc.HS; break;
-                    case SHADER_TYPE_DOMAIN:   pd3d12ShaderBytecode = &d3d12PSODesc.DS; break;
-                    // clang-format on
-                    default: UNEXPECTED("Unexpected shader type");
-                }
+                        D3D12_GRAPHICS_PIPELINE_STATE_DESC d3d12PSODesc = {};
 
-                pd3d12ShaderBytecode->pShaderBytecode = pByteCode->GetBufferPointer();
-                pd3d12ShaderBytecode->BytecodeLength  = pByteCode->GetBufferSize();
-            }
+                        for (const auto& Stage : ShaderStages)
+                        {
+                            VERIFY_EXPR(Stage.Count() == 1);
+                            const auto& pByteCode = Stage.ByteCodes[0];
+
+                            D3D12_SHADER_BYTECODE* pd3d12ShaderBytecode = nullptr;
+                            switch (Stage.Type)
+                            {
+                                // clang-format off
+                                case SHADER_TYPE_VERTEX:   pd3d12ShaderBytecode = &d3d12PSODesc.VS; break;
+                                case SHADER_TYPE_PIXEL:    pd3d12ShaderBytecode = &d3d12PSODesc.PS; break;
+                                case SHADER_TYPE_GEOMETRY: pd3d12ShaderBytecode = &d3d12PSODesc.GS; break;
+                                case SHADER_TYPE_HULL:     pd3d12ShaderBytecode = &d3d12PSODesc.HS; break;
+                                case SHADER_TYPE_DOMAIN:   pd3d12ShaderBytecode = &d3d12PSODesc.DS; break;
+                                // clang-format on
+                                default: UNEXPECTED("Unexpected shader type");
+                            }
+
+                            pd3d12ShaderBytecode->pShaderBytecode = pByteCode->GetBufferPointer();
+                            pd3d12ShaderBytecode->BytecodeLength  = pByteCode->GetBufferSize();
+                        }
 
-            d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
+                        d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
 
-            memset(&d3d12PSODesc.StreamOutput, 0, sizeof(d3d12PSODesc.StreamOutput));
+                        memset(&d3d12PSODesc.StreamOutput, 0, sizeof(d3d12PSODesc.StreamOutput));
 
-            BlendStateDesc_To_D3D12_BLEND_DESC(GraphicsPipeline.BlendDesc, d3d12PSODesc.BlendState);
-            // The sample mask for the blend state.
-            d3d12PSODesc.SampleMask = GraphicsPipeline.SampleMask;
+                        BlendStateDesc_To_D3D12_BLEND_DESC(GraphicsPipeline.BlendDesc, d3d12PSODesc.BlendState);
+                        // The sample mask for the blend state.
+                        d3d12PSODesc.SampleMask = GraphicsPipeline.SampleMask;
 
-            RasterizerStateDesc_To_D3D12_RASTERIZER_DESC(GraphicsPipeline.RasterizerDesc, d3d12PSODesc.RasterizerState);
-            DepthStencilStateDesc_To_D3D12_DEPTH_STENCIL_DESC(GraphicsPipeline.DepthStencilDesc, d3d12PSODesc.DepthStencilState);
+                        RasterizerStateDesc_To_D3D12_RASTERIZER_DESC(GraphicsPipeline.RasterizerDesc, d3d12PSODesc.RasterizerState);
+                        DepthStencilStateDesc_To_D3D12_DEPTH_STENCIL_DESC(GraphicsPipeline.DepthStencilDesc, d3d12PSODesc.DepthStencilState);
 
-            std::vector<D3D12_INPUT_ELEMENT_DESC, STDAllocatorRawMem<D3D12_INPUT_ELEMENT_DESC>> d312InputElements(STD_ALLOCATOR_RAW_MEM(D3D12_INPUT_ELEMENT_DESC, GetRawAllocator(), "Allocator for vector<D3D12_INPUT_ELEMENT_DESC>"));
+                        std::vector<D3D12_INPUT_ELEMENT_DESC, STDAllocatorRawMem<D3D12_INPUT_ELEMENT_DESC>> d312InputElements(STD_ALLOCATOR_RAW_MEM(D3D12_INPUT_ELEMENT_DESC, GetRawAllocator(), "Allocator for vector<D3D12_INPUT_ELEMENT_DESC>"));
 
-            const auto& InputLayout = GetGraphicsPipelineDesc().InputLayout;
-            if (InputLayout.NumElements > 0)
-            {
-                LayoutElements_To_D3D12_INPUT_ELEMENT_DESCs(InputLayout, d312InputElements);
-                d3d12PSODesc.InputLayout.NumElements        = static_cast<UINT>(d312InputElements.size());
-                d3d12PSODesc.InputLayout.pInputElementDescs = d312InputElements.data();
-            }
-            else
-            {
-                d3d12PSODesc.InputLayout.NumElements        = 0;
-                d3d12PSODesc.InputLayout.pInputElementDescs = nullptr;
-            }
+                        const auto& InputLayout = GetGraphicsPipelineDesc().InputLayout;
+                        if (InputLayout.NumElements > 0)
+                        {
+                            LayoutElements_To_D3D12_INPUT_ELEMENT_DESCs(InputLayout, d312InputElements);
+                            d3d12PSODesc.InputLayout.NumElements        = static_cast<UINT>(d312InputElements.size());
+                            d3d12PSODesc.InputLayout.pInputElementDescs = d312InputElements.data();
+                        }
+                        else
+                        {
+                            d3d12PSODesc.InputLayout.NumElements        = 0;
+                            d3d12PSODesc.InputLayout.pInputElementDescs = nullptr;
+                        }
 
-            d3d12PSODesc.IBStripCutValue = (GraphicsPipeline.PrimitiveTopology == PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP ||
-                                            GraphicsPipeline.PrimitiveTopology == PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP_ADJ ||
-                                            GraphicsPipeline.PrimitiveTopology == PRIMITIVE_TOPOLOGY_LINE_STRIP ||
-                                            GraphicsPipeline.PrimitiveTopology == PRIMITIVE_TOPOLOGY_LINE_STRIP_ADJ) ?
-                D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_0xFFFFFFFF :
-                D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
-            static const PrimitiveTopology_To_D3D12_PRIMITIVE_TOPOLOGY_TYPE PrimTopologyToD3D12TopologyType;
-            d3d12PSODesc.PrimitiveTopologyType = PrimTopologyToD3D12TopologyType[GraphicsPipeline.PrimitiveTopology];
-
-            d3d12PSODesc.NumRenderTargets = GraphicsPipeline.NumRenderTargets;
-            for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
-                d3d12PSODesc.RTVFormats[rt] = TexFormatToDXGI_Format(GraphicsPipeline.RTVFormats[rt]);
-            for (Uint32 rt = GraphicsPipeline.NumRenderTargets; rt < _countof(d3d12PSODesc.RTVFormats); ++rt)
-                d3d12PSODesc.RTVFormats[rt] = DXGI_FORMAT_UNKNOWN;
-            d3d12PSODesc.DSVFormat = TexFormatToDXGI_Format(GraphicsPipeline.DSVFormat);
-
-            d3d12PSODesc.SampleDesc.Count   = GraphicsPipeline.SmplDesc.Count;
-            d3d12PSODesc.SampleDesc.Quality = GraphicsPipeline.SmplDesc.Quality;
-
-            // For single GPU operation, set this to zero. If there are multiple GPU nodes,
-            // set bits to identify the nodes (the device's physical adapters) for which the
-            // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
-            d3d12PSODesc.NodeMask = 0;
-
-            d3d12PSODesc.CachedPSO.pCachedBlob           = nullptr;
-            d3d12PSODesc.CachedPSO.CachedBlobSizeInBytes = 0;
-
-            // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
-            d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
-
-            // Try to load from the cache
-            auto* const pPSOCacheD3D12 = ClassPtrCast<PipelineStateCacheD3D12Impl>(CreateInfo.pPSOCache);
-            if (pPSOCacheD3D12 != nullptr && !WName.empty())
-                m_pd3d12PSO = pPSOCacheD3D12->LoadGraphicsPipeline(WName.c_str(), d3d12PSODesc);
-            if (!m_pd3d12PSO)
-            {
-                // Note: renderdoc frame capture fails if any interface but IID_ID3D12PipelineState is requested
-                HRESULT hr = pd3d12Device->CreateGraphicsPipelineState(&d3d12PSODesc, __uuidof(ID3D12PipelineState), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
-                if (FAILED(hr))
-                    LOG_ERROR_AND_THROW("Failed to create pipeline state");
-
-                // Add to the cache
-                if (pPSOCacheD3D12 != nullptr && !WName.empty())
-                    pPSOCacheD3D12->StorePipeline(WName.c_str(), m_pd3d12PSO);
-            }
-        }
+                        d3d12PSODesc.IBStripCutValue = (GraphicsPipeline.PrimitiveTopology == PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP ||
+                                                        GraphicsPipeline.PrimitiveTopology == PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP_ADJ ||
+                                                        GraphicsPipeline.PrimitiveTopology == PRIMITIVE_TOPOLOGY_LINE_STRIP ||
+                                                        GraphicsPipeline.PrimitiveTopology == PRIMITIVE_TOPOLOGY_LINE_STRIP_ADJ) ?
+                            D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_0xFFFFFFFF :
+                            D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
+                        static const PrimitiveTopology_To_D3D12_PRIMITIVE_TOPOLOGY_TYPE PrimTopologyToD3D12TopologyType;
+                        d3d12PSODesc.PrimitiveTopologyType = PrimTopologyToD3D12TopologyType[GraphicsPipeline.PrimitiveTopology];
+
+                        d3d12PSODesc.NumRenderTargets = GraphicsPipeline.NumRenderTargets;
+                        for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
+                            d3d12PSODesc.RTVFormats[rt] = TexFormatToDXGI_Format(GraphicsPipeline.RTVFormats[rt]);
+                        for (Uint32 rt = GraphicsPipeline.NumRenderTargets; rt < _countof(d3d12PSODesc.RTVFormats); ++rt)
+                            d3d12PSODesc.RTVFormats[rt] = DXGI_FORMAT_UNKNOWN;
+                        d3d12PSODesc.DSVFormat = TexFormatToDXGI_Format(GraphicsPipeline.DSVFormat);
+
+                        d3d12PSODesc.SampleDesc.Count   = GraphicsPipeline.SmplDesc.Count;
+                        d3d12PSODesc.SampleDesc.Quality = GraphicsPipeline.SmplDesc.Quality;
+
+                        // For single GPU operation, set this to zero. If there are multiple GPU nodes,
+                        // set bits to identify the nodes (the device's physical adapters) for which the
+                        // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
+                        d3d12PSODesc.NodeMask = 0;
+
+                        d3d12PSODesc.CachedPSO.pCachedBlob           = nullptr;
+                        d3d12PSODesc.CachedPSO.CachedBlobSizeInBytes = 0;
+
+                        // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
+                        d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+
+                        // Try to load from the cache
+                        auto* const pPSOCacheD3D12 = pPSOCache.RawPtr<PipelineStateCacheD3D12Impl>();
+                        if (pPSOCacheD3D12 != nullptr && !WName.empty())
+                            m_pd3d12PSO = pPSOCacheD3D12->LoadGraphicsPipeline(WName.c_str(), d3d12PSODesc);
+                        if (!m_pd3d12PSO)
+                        {
+                            // The pipeline is not in the cache
+                            if (FailIfCompileRequired)
+                                return false;
+
+                            // Note: renderdoc frame capture fails if any interface but IID_ID3D12PipelineState is requested
+                            HRESULT hr = pd3d12Device->CreateGraphicsPipelineState(&d3d12PSODesc, __uuidof(ID3D12PipelineState), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
+                            if (FAILED(hr))
+                                LOG_ERROR_AND_THROW("Failed to create pipeline state");
+
+                            // Add to the cache
+                            if (pPSOCacheD3D12 != nullptr && !WName.empty())
+                                pPSOCacheD3D12->StorePipeline(WName.c_str(), m_pd3d12PSO);
+                        }
+                    }
 #ifdef D3D12_H_HAS_MESH_SHADER
-        else if (m_Desc.PipelineType == PIPELINE_TYPE_MESH)
-        {
-            const auto& GraphicsPipeline = GetGraphicsPipelineDesc();
-
-            struct MESH_SHADER_PIPELINE_STATE_DESC
-            {
-                PSS_SubObject<D3D12_PIPELINE_STATE_FLAGS, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_FLAGS>            Flags;
-                PSS_SubObject<UINT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_NODE_MASK>                              NodeMask;
-                PSS_SubObject<ID3D12RootSignature*, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_ROOT_SIGNATURE>         pRootSignature;
-                PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS>                    PS;
-                PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_AS>                    AS;
-                PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_MS>                    MS;
-                PSS_SubObject<D3D12_BLEND_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND>                      BlendState;
-                PSS_SubObject<D3D12_DEPTH_STENCIL_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL>      DepthStencilState;
-                PSS_SubObject<D3D12_RASTERIZER_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER>            RasterizerState;
-                PSS_SubObject<DXGI_SAMPLE_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC>                SampleDesc;
-                PSS_SubObject<UINT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK>                            SampleMask;
-                PSS_SubObject<DXGI_FORMAT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT>            DSVFormat;
-                PSS_SubObject<D3D12_RT_FORMAT_ARRAY, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS> RTVFormatArray;
-                PSS_SubObject<D3D12_CACHED_PIPELINE_STATE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_CACHED_PSO>      CachedPSO;
-            };
-            MESH_SHADER_PIPELINE_STATE_DESC d3d12PSODesc = {};
-
-            for (const auto& Stage : ShaderStages)
-            {
-                VERIFY_EXPR(Stage.Count() == 1);
-                const auto& pByteCode = Stage.ByteCodes[0];
+                    else if (m_Desc.PipelineType == PIPELINE_TYPE_MESH)
+                    {
+                        const auto& GraphicsPipeline = GetGraphicsPipelineDesc();
 
-                D3D12_SHADER_BYTECODE* pd3d12ShaderBytecode = nullptr;
-                switch (Stage.Type)
-                {
-                    // clang-format off
-                    case SHADER_TYPE_AMPLIFICATION: pd3d12ShaderBytecode = &d3d12PSODesc.AS; break;
-                    case SHADER_TYPE_MESH:          pd3d12ShaderBytecode = &d3d12PSODesc.MS; break;
-                    case SHADER_TYPE_PIXEL:         pd3d12ShaderBytecode = &d3d12PSODesc.PS; break;
-                    // clang-format on
-                    default: UNEXPECTED("Unexpected shader type");
-                }
+                        struct MESH_SHADER_PIPELINE_STATE_DESC
+                        {
+                            PSS_SubObject<D3D12_PIPELINE_STATE_FLAGS, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_FLAGS>            Flags;
+                            PSS_SubObject<UINT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_NODE_MASK>                              NodeMask;
+                            PSS_SubObject<ID3D12RootSignature*, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_ROOT_SIGNATURE>         pRootSignature;
+                            PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS>                    PS;
+                            PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_AS>                    AS;
+                            PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_MS>                    MS;
+                            PSS_SubObject<D3D12_BLEND_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND>                      BlendState;
+                            PSS_SubObject<D3D12_DEPTH_STENCIL_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL>      DepthStencilState;
+                            PSS_SubObject<D3D12_RASTERIZER_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER>            RasterizerState;
+                            PSS_SubObject<DXGI_SAMPLE_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC>                SampleDesc;
+                            PSS_SubObject<UINT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK>                            SampleMask;
+                            PSS_SubObject<DXGI_FORMAT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT>            DSVFormat;
+                            PSS_SubObject<D3D12_RT_FORMAT_ARRAY, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS> RTVFormatArray;
+                            PSS_SubObject<D3D12_CACHED_PIPELINE_STATE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_CACHED_PSO>      CachedPSO;
+                        };
+                        MESH_SHADER_PIPELINE_STATE_DESC d3d12PSODesc = {};
+
+                        for (const auto& Stage : ShaderStages)
+                        {
+                            VERIFY_EXPR(Stage.Count() == 1);
+                            const auto& pByteCode = Stage.ByteCodes[0];
+
+                            D3D12_SHADER_BYTECODE* pd3d12ShaderBytecode = nullptr;
+                            switch (Stage.Type)
+                            {
+                                // clang-format off
+                                case SHADER_TYPE_AMPLIFICATION: pd3d12ShaderBytecode = &d3d12PSODesc.AS; break;
+                                case SHADER_TYPE_MESH:          pd3d12ShaderBytecode = &d3d12PSODesc.MS; break;
+                                case SHADER_TYPE_PIXEL:         pd3d12ShaderBytecode = &d3d12PSODesc.PS; break;
+                                // clang-format on
+                                default: UNEXPECTED("Unexpected shader type");
+                            }
+
+                            pd3d12ShaderBytecode->pShaderBytecode = pByteCode->GetBufferPointer();
+                            pd3d12ShaderBytecode->BytecodeLength  = pByteCode->GetBufferSize();
+                        }
 
-                pd3d12ShaderBytecode->pShaderBytecode = pByteCode->GetBufferPointer();
-                pd3d12ShaderBytecode->BytecodeLength  = pByteCode->GetBufferSize();
-            }
+                        d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
 
-            d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
+                        BlendStateDesc_To_D3D12_BLEND_DESC(GraphicsPipeline.BlendDesc, *d3d12PSODesc.BlendState);
+                        d3d12PSODesc.SampleMask = GraphicsPipeline.SampleMask;
 
-            BlendStateDesc_To_D3D12_BLEND_DESC(GraphicsPipeline.BlendDesc, *d3d12PSODesc.BlendState);
-            d3d12PSODesc.SampleMask = GraphicsPipeline.SampleMask;
+                        RasterizerStateDesc_To_D3D12_RASTERIZER_DESC(GraphicsPipeline.RasterizerDesc, *d3d12PSODesc.RasterizerState);
+                        DepthStencilStateDesc_To_D3D12_DEPTH_STENCIL_DESC(GraphicsPipeline.DepthStencilDesc, *d3d12PSODesc.DepthStencilState);
 
-            RasterizerStateDesc_To_D3D12_RASTERIZER_DESC(GraphicsPipeline.RasterizerDesc, *d3d12PSODesc.RasterizerState);
-            DepthStencilStateDesc_To_D3D12_DEPTH_STENCIL_DESC(GraphicsPipeline.DepthStencilDesc, *d3d12PSODesc.DepthStencilState);
+                        d3d12PSODesc.RTVFormatArray->NumRenderTargets = GraphicsPipeline.NumRenderTargets;
+                        for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
+                            d3d12PSODesc.RTVFormatArray->RTFormats[rt] = TexFormatToDXGI_Format(GraphicsPipeline.RTVFormats[rt]);
+                        for (Uint32 rt = GraphicsPipeline.NumRenderTargets; rt < _countof(d3d12PSODesc.RTVFormatArray->RTFormats); ++rt)
+                            d3d12PSODesc.RTVFormatArray->RTFormats[rt] = DXGI_FORMAT_UNKNOWN;
+                        d3d12PSODesc.DSVFormat = TexFormatToDXGI_Format(GraphicsPipeline.DSVFormat);
 
-            d3d12PSODesc.RTVFormatArray->NumRenderTargets = GraphicsPipeline.NumRenderTargets;
-            for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
-                d3d12PSODesc.RTVFormatArray->RTFormats[rt] = TexFormatToDXGI_Format(GraphicsPipeline.RTVFormats[rt]);
-            for (Uint32 rt = GraphicsPipeline.NumRenderTargets; rt < _countof(d3d12PSODesc.RTVFormatArray->RTFormats); ++rt)
-                d3d12PSODesc.RTVFormatArray->RTFormats[rt] = DXGI_FORMAT_UNKNOWN;
-            d3d12PSODesc.DSVFormat = TexFormatToDXGI_Format(GraphicsPipeline.DSVFormat);
+                        d3d12PSODesc.SampleDesc->Count   = GraphicsPipeline.SmplDesc.Count;
+                        d3d12PSODesc.SampleDesc->Quality = GraphicsPipeline.SmplDesc.Quality;
 
-            d3d12PSODesc.SampleDesc->Count   = GraphicsPipeline.SmplDesc.Count;
-            d3d12PSODesc.SampleDesc->Quality = GraphicsPipeline.SmplDesc.Quality;
+                        // For single GPU operation, set this to zero. If there are multiple GPU nodes,
+                        // set bits to identify the nodes (the device's physical adapters) for which the
+                        // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
+                        d3d12PSODesc.NodeMask = 0;
 
-            // For single GPU operation, set this to zero. If there are multiple GPU nodes,
-            // set bits to identify the nodes (the device's physical adapters) for which the
-            // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
-            d3d12PSODesc.NodeMask = 0;
+                        d3d12PSODesc.CachedPSO->pCachedBlob           = nullptr;
+                        d3d12PSODesc.CachedPSO->CachedBlobSizeInBytes = 0;
 
-            d3d12PSODesc.CachedPSO->pCachedBlob           = nullptr;
-            d3d12PSODesc.CachedPSO->CachedBlobSizeInBytes = 0;
+                        // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
+                        d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 
-            // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
-            d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+                        // Mesh pipelines are not cached
+                        if (FailIfCompileRequired)
+                            return false;
 
-            D3D12_PIPELINE_STATE_STREAM_DESC streamDesc;
-            streamDesc.SizeInBytes                   = sizeof(d3d12PSODesc);
-            streamDesc.pPipelineStateSubobjectStream = &d3d12PSODesc;
+                        D3D12_PIPELINE_STATE_STREAM_DESC streamDesc;
+                        streamDesc.SizeInBytes                   = sizeof(d3d12PSODesc);
+                        streamDesc.pPipelineStateSubobjectStream = &d3d12PSODesc;
 
-            auto* pd3d12Device2 = pDeviceD3D12->GetD3D12Device2();
-            // Note: renderdoc frame capture fails if any interface but IID_ID3D12PipelineState is requested
-            HRESULT hr = pd3d12Device2->CreatePipelineState(&streamDesc, __uuidof(ID3D12PipelineState), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
-            if (FAILED(hr))
-                LOG_ERROR_AND_THROW("Failed to create pipeline state");
-        }
+                        auto* pd3d12Device2 = GetDevice()->GetD3D12Device2();
+                        // Note: renderdoc frame capture fails if any interface but IID_ID3D12PipelineState is requested
+                        HRESULT hr = pd3d12Device2->CreatePipelineState(&streamDesc, __uuidof(ID3D12PipelineState), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
+                        if (FAILED(hr))
+                            LOG_ERROR_AND_THROW("Failed to create pipeline state");
+                    }
 #endif // D3D12_H_HAS_MESH_SHADER
-        else
-        {
-            LOG_ERROR_AND_THROW("Unsupported pipeline type");
-        }
+                    else
+                    {
+                        LOG_ERROR_AND_THROW("Unsupported pipeline type");
+                    }
 
-        if (!WName.empty())
-        {
-            m_pd3d12PSO->SetName(WName.c_str());
-        }
+                    if (!WName.empty())
+                    {
+                        m_pd3d12PSO->SetName(WName.c_str());
+                    }
+                    return true;
+                };
+
+                if (CreatePipeline(CacheOnly))
+                    return {};
+
+                return [CreatePipeline]() {
+                    CreatePipeline(false);
+                };
+            });
     }
     catch (...)
     {
@@ -893,53 +927,77 @@ PipelineStateD3D12Impl::PipelineStateD3D12Impl(IReferenceCounters*
 {
     try
     {
-        TShaderStages ShaderStages;
-        InitInternalObjects(CreateInfo, ShaderStages);
+        InitializePipeline(
+            CreateInfo,
+            [this](const ComputePipelineStateCreateInfo& CI, bool CacheOnly) -> CompilePipelineFuncType //
+            {
+                // The shader byte codes are shared with the compilation function that may run in another thread
+                auto pShaderStages = std::make_shared<TShaderStages>();
+                InitInternalObjects(CI, *pShaderStages);
 
-        auto* pd3d12Device = pDeviceD3D12->GetD3D12Device();
+                RefCntAutoPtr<IPipelineStateCache> pPSOCache{CI.pPSOCache};
 
-        D3D12_COMPUTE_PIPELINE_STATE_DESC d3d12PSODesc = {};
+                auto CreatePipeline = [this, pShaderStages, pPSOCache](bool FailIfCompileRequired) {
+                    const auto& ShaderStages = *pShaderStages;
 
-        VERIFY_EXPR(ShaderStages[0].Type == SHADER_TYPE_COMPUTE);
-        VERIFY_EXPR(ShaderStages[0].Count() == 1);
-        const auto& pByteCode           = ShaderStages[0].ByteCodes[0];
-        d3d12PSODesc.CS.pShaderBytecode = pByteCode->GetBufferPointer();
-        d3d12PSODesc.CS.BytecodeLength  = pByteCode->GetBufferSize();
+                    auto* pd3d12Device = GetDevice()->GetD3D12Device();
 
-        // For single GPU operation, set this to zero. If there are multiple GPU nodes,
-        // set bits to identify the nodes (the device's physical adapters) for which the
-        // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
-        d3d12PSODesc.NodeMask = 0;
+                    D3D12_COMPUTE_PIPELINE_STATE_DESC d3d12PSODesc = {};
 
-        d3d12PSODesc.CachedPSO.pCachedBlob           = nullptr;
-        d3d12PSODesc.CachedPSO.CachedBlobSizeInBytes = 0;
+                    VERIFY_EXPR(ShaderStages[0].Type == SHADER_TYPE_COMPUTE);
+                    VERIFY_EXPR(ShaderStages[0].Count() == 1);
+                    const auto& pByteCode           = ShaderStages[0].ByteCodes[0];
+                    d3d12PSODesc.CS.pShaderBytecode = pByteCode->GetBufferPointer();
+                    d3d12PSODesc.CS.BytecodeLength  = pByteCode->GetBufferSize();
 
-        // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
-        d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+                    // For single GPU operation, set this to zero. If there are multiple GPU nodes,
+                    // set bits to identify the nodes (the device's physical adapters) for which the
+                    // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
+                    d3d12PSODesc.NodeMask = 0;
 
-        d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
+                    d3d12PSODesc.CachedPSO.pCachedBlob           = nullptr;
+                    d3d12PSODesc.CachedPSO.CachedBlobSizeInBytes = 0;
 
-        // Try to load from the cache
-        const auto  WName          = WidenString(m_Desc.Name);
-        auto* const pPSOCacheD3D12 = ClassPtrCast<PipelineStateCacheD3D12Impl>(CreateInfo.pPSOCache);
-        if (pPSOCacheD3D12 != nullptr && !WName.empty())
-            m_pd3d12PSO = pPSOCacheD3D12->LoadComputePipeline(WName.c_str(), d3d12PSODesc);
-        if (!m_pd3d12PSO)
-        {
-            // Note: renderdoc frame capture fails if any interface but IID_ID3D12PipelineState is requested
-            HRESULT hr = pd3d12Device->CreateComputePipelineState(&d3d12PSODesc, __uuidof(ID3D12PipelineState), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
-            if (FAILED(hr))
-                LOG_ERROR_AND_THROW("Failed to create pipeline state");
-
-            // Add to the cache
-            if (pPSOCacheD3D12 != nullptr && !WName.empty())
-                pPSOCacheD3D12->StorePipeline(WName.c_str(), m_pd3d12PSO);
-        }
+                    // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
+                    d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 
-        if (!WName.empty())
-        {
-            m_pd3d12PSO->SetName(WName.c_str());
-        }
+                    d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
+
+                    // Try to load from the cache
+                    const auto  WName          = WidenString(m_Desc.Name);
+                    auto* const pPSOCacheD3D12 = pPSOCache.RawPtr<PipelineStateCacheD3D12Impl>();
+                    if (pPSOCacheD3D12 != nullptr && !WName.empty())
+                        m_pd3d12PSO = pPSOCacheD3D12->LoadComputePipeline(WName.c_str(), d3d12PSODesc);
+                    if (!m_pd3d12PSO)
+                    {
+                        // The pipeline is not in the cache
+                        if (FailIfCompileRequired)
+                            return false;
+
+                        // Note: renderdoc frame capture fails if any interface but IID_ID3D12PipelineState is requested
+                        HRESULT hr = pd3d12Device->CreateComputePipelineState(&d3d12PSODesc, __uuidof(ID3D12PipelineState), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
+                        if (FAILED(hr))
+                            LOG_ERROR_AND_THROW("Failed to create pipeline state");
+
+                        // Add to the cache
+                        if (pPSOCacheD3D12 != nullptr && !WName.empty())
+                            pPSOCacheD3D12->StorePipeline(WName.c_str(), m_pd3d12PSO);
+                    }
+
+                    if (!WName.empty())
+                    {
+                        m_pd3d12PSO->SetName(WName.c_str());
+                    }
+                    return true;
+                };
+
+                if (CreatePipeline(CacheOnly))
+                    return {};
+
+                return [CreatePipeline]() {
+                    CreatePipeline(false);
+                };
+            });
     }
     catch (...)
     {
@@ -1004,6 +1062,8 @@ PipelineStateD3D12Impl::~PipelineStateD3D12Impl()
 
 void PipelineStateD3D12Impl::Destruct()
 {
+    CancelOrWaitAsyncInitialization();
+
     m_RootSig.Release();
 
     if (m_pd3d12PSO)
@@ -35,6 +35,7 @@
 #include "GraphicsAccessories.hpp"
 #include "CommandContext.hpp"
 #include "Align.hpp"
+#include "PlatformMisc.hpp"
 #include "RenderDeviceD3D12Impl.hpp"
 
 namespace Diligent
@@ -82,41 +83,61 @@ void QueryManagerD3D12::QueryHeapInfo::Init(ID3D12Device*                pd3d12D
     m_ResolveBufferBaseOffset = CurrResolveBufferOffset;
     CurrResolveBufferOffset += m_AlignedQueryDataSize * m_QueryCount;
 
-    m_AvailableQueries.resize(m_QueryCount);
-    for (Uint32 i = 0; i < m_QueryCount; ++i)
-        m_AvailableQueries[i] = i;
+    m_MaskSize      = (m_QueryCount + 63) / 64;
+    m_AllocatedMask = std::make_unique<std::atomic<Uint64>[]>(m_MaskSize);
+    for (Uint32 i = 0; i < m_MaskSize; ++i)
+        m_AllocatedMask[i].store(0);
+    if (const auto NumTailBits = m_QueryCount % 64)
+        m_AllocatedMask[m_MaskSize - 1].store(~Uint64{0} << NumTailBits);
 }
 
 Uint32 QueryManagerD3D12::QueryHeapInfo::Allocate()
 {
-    Uint32 Index = InvalidIndex;
-
-    std::lock_guard<std::mutex> Lock{m_AvailableQueriesMtx};
-    if (!m_AvailableQueries.empty())
+    const auto SearchStart = m_SearchStart.load(std::memory_order_relaxed);
+    for (Uint32 i = 0; i < m_MaskSize; ++i)
     {
-        Index = m_AvailableQueries.back();
-        m_AvailableQueries.pop_back();
-        m_MaxAllocatedQueries = std::max(m_MaxAllocatedQueries, m_QueryCount - static_cast<Uint32>(m_AvailableQueries.size()));
+        const auto WordIdx = (SearchStart + i) % m_MaskSize;
+        auto&      Word    = m_AllocatedMask[WordIdx];
+
+        auto Bits = Word.load(std::memory_order_relaxed);
+        while (Bits != ~Uint64{0})
+        {
+            // Take the lowest free bit
+            const auto FreeBit = ~Bits & (Bits + 1);
+            if (Word.compare_exchange_weak(Bits, Bits | FreeBit, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                m_SearchStart.store(WordIdx, std::memory_order_relaxed);
+
+                const auto NumAllocated = m_NumAllocatedQueries.fetch_add(1) + 1;
+                auto       MaxAllocated = m_MaxAllocatedQueries.load();
+                while (MaxAllocated < NumAllocated && !m_MaxAllocatedQueries.compare_exchange_weak(MaxAllocated, NumAllocated))
+                {
+                }
+
+                return WordIdx * 64 + PlatformMisc::GetLSB(FreeBit);
+            }
+        }
     }
 
-    return Index;
+    return InvalidIndex;
 }
 
 void QueryManagerD3D12::QueryHeapInfo::Release(Uint32 Index)
 {
     VERIFY(Index < m_QueryCount, "Query index ", Index, " is out of range");
 
-    std::lock_guard<std::mutex> Lock{m_AvailableQueriesMtx};
-    VERIFY(std::find(m_AvailableQueries.begin(), m_AvailableQueries.end(), Index) == m_AvailableQueries.end(),
-           "Index ", Index, " already present in available queries list");
-    m_AvailableQueries.push_back(Index);
+    const auto Bit      = Uint64{1} << (Index % 64);
+    const auto PrevBits = m_AllocatedMask[Index / 64].fetch_and(~Bit, std::memory_order_release);
+    VERIFY((PrevBits & Bit) != 0, "Index ", Index, " is not allocated");
+    (void)PrevBits;
+
+    m_NumAllocatedQueries.fetch_sub(1);
 }
 
 QueryManagerD3D12::QueryHeapInfo::~QueryHeapInfo()
 {
-    if (m_AvailableQueries.size() != m_QueryCount)
+    if (const auto OutstandingQueries = m_NumAllocatedQueries.load())
     {
-        auto OutstandingQueries = m_QueryCount - m_AvailableQueries.size();
         if (OutstandingQueries == 1)
         {
             LOG_ERROR_MESSAGE("One query of type ", GetQueryTypeString(m_Type),
@@ -250,7 +271,7 @@ void QueryManagerD3D12::BeginQuery(CommandContext& Ctx, QUERY_TYPE Type, Uint32
     Ctx.BeginQuery(HeapInfo.GetD3D12QueryHeap(), d3d12QueryType, Index);
 }
 
-void QueryManagerD3D12::EndQuery(CommandContext& Ctx, QUERY_TYPE Type, Uint32 Index) const
+void QueryManagerD3D12::EndQuery(CommandContext& Ctx, QUERY_TYPE Type, Uint32 Index, PendingResolves& Resolves) const
 {
     const auto  d3d12QueryType = QueryTypeToD3D12QueryType(Type);
     const auto& HeapInfo       = m_Heaps[Type];
@@ -259,8 +280,44 @@ void QueryManagerD3D12::EndQuery(CommandContext& Ctx, QUERY_TYPE Type, Uint32 In
     VERIFY(Index < HeapInfo.GetQueryCount(), "Query index ", Index, " is out of range");
     Ctx.EndQuery(HeapInfo.GetD3D12QueryHeap(), d3d12QueryType, Index);
 
-    // https://microsoft.github.io/DirectX-Specs/d3d/CountersAndQueries.html#resolvequerydata
-    Ctx.ResolveQueryData(HeapInfo.GetD3D12QueryHeap(), d3d12QueryType, Index, 1, m_pd3d12ResolveBuffer, HeapInfo.GetResolveBufferOffset(Index));
+    // The query is resolved by ResolveQueries() before the command list is closed
+    Resolves[Type].push_back(Index);
+}
+
+void QueryManagerD3D12::ResolveQueries(CommandContext& Ctx, PendingResolves& Resolves) const
+{
+    for (Uint32 query_type = QUERY_TYPE_UNDEFINED + 1; query_type < QUERY_TYPE_NUM_TYPES; ++query_type)
+    {
+        const auto QueryType = static_cast<QUERY_TYPE>(query_type);
+
+        auto& Indices = Resolves[QueryType];
+        if (Indices.empty())
+            continue;
+
+        const auto  d3d12QueryType = QueryTypeToD3D12QueryType(QueryType);
+        const auto& HeapInfo       = m_Heaps[QueryType];
+        VERIFY_EXPR(HeapInfo.GetType() == QueryType);
+
+        // A query may be ended multiple times in the same command list.
+        // Resolving it once at the end gives the latest data.
+        std::sort(Indices.begin(), Indices.end());
+        Indices.erase(std::unique(Indices.begin(), Indices.end()), Indices.end());
+
+        // Resolve every contiguous range of queries with a single call.
+        // https://microsoft.github.io/DirectX-Specs/d3d/CountersAndQueries.html#resolvequerydata
+        for (size_t RangeStart = 0; RangeStart < Indices.size();)
+        {
+            size_t RangeEnd = RangeStart + 1;
+            while (RangeEnd < Indices.size() && Indices[RangeEnd] == Indices[RangeEnd - 1] + 1)
+                ++RangeEnd;
+
+            const auto StartIndex = Indices[RangeStart];
+            Ctx.ResolveQueryData(HeapInfo.GetD3D12QueryHeap(), d3d12QueryType, StartIndex, static_cast<UINT>(RangeEnd - RangeStart),
+                                 m_pd3d12ResolveBuffer, HeapInfo.GetResolveBufferOffset(StartIndex));
+            RangeStart = RangeEnd;
+        }
+        Indices.clear();
+    }
 }
 
 void QueryManagerD3D12::ReadQueryData(QUERY_TYPE Type, Uint32 Index, void* pDataPtr, Uint32 DataSize) const
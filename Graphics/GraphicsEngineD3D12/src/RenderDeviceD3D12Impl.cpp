@@ -44,6 +44,7 @@
 #include "DeviceContextD3D12Impl.hpp"
 #include "FenceD3D12Impl.hpp"
 #include "QueryD3D12Impl.hpp"
+#include "QueryArrayD3D12Impl.hpp"
 #include "RenderPassD3D12Impl.hpp"
 #include "FramebufferD3D12Impl.hpp"
 #include "BottomLevelASD3D12Impl.hpp"
@@ -148,6 +149,7 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
         {*this, D3D12_COMMAND_LIST_TYPE_COMPUTE},
         {*this, D3D12_COMMAND_LIST_TYPE_COPY}
     },
+    m_BundleCmdListManager{*this, D3D12_COMMAND_LIST_TYPE_BUNDLE},
     m_CPUDescriptorHeaps
     {
         {RawMemAllocator, *this, EngineCI.CPUDescriptorHeapAllocationSize[0], D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, D3D12_DESCRIPTOR_HEAP_FLAG_NONE},
@@ -161,11 +163,15 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
         {RawMemAllocator, *this, EngineCI.GPUDescriptorHeapSize[1], EngineCI.GPUDescriptorHeapDynamicSize[1], D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER,     D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE}
     },
     m_ContextPool           (STD_ALLOCATOR_RAW_MEM(PooledCommandContext, GetRawAllocator(), "Allocator for vector<PooledCommandContext>")),
-    m_DynamicMemoryManager  {GetRawAllocator(), *this, EngineCI.NumDynamicHeapPagesToReserve, EngineCI.DynamicHeapPageSize},
+    m_BundleContextPool     (STD_ALLOCATOR_RAW_MEM(PooledCommandContext, GetRawAllocator(), "Allocator for vector<PooledCommandContext>")),
+    m_DynamicMemoryManager  {GetRawAllocator(), *this, EngineCI.NumDynamicHeapPagesToReserve, EngineCI.DynamicHeapPageSize, EngineCI.DynamicHeapShrinkInterval},
+    m_TextureUploadMemoryManager{GetRawAllocator(), *this, EngineCI.NumTextureUploadPagesToReserve, EngineCI.TextureUploadPageSize},
     m_MipsGenerator         {pd3d12Device},
     m_pDxCompiler           {CreateDXCompiler(DXCompilerTarget::Direct3D12, 0, EngineCI.pDxCompilerPath)},
     m_RootSignatureAllocator{GetRawAllocator(), sizeof(RootSignatureD3D12), 128},
-    m_RootSignatureCache    {*this}
+    m_RootSignatureCache    {*this},
+    m_InitialDataBatchSize  {EngineCI.InitialDataBatchSize},
+    m_InitialDataBatches    {m_InitialDataBatchSize != 0 ? std::make_unique<InitialDataBatch[]>(CommandQueueCount) : nullptr}
 // clang-format on
 {
     m_DeviceInfo.Type = RENDER_DEVICE_TYPE_D3D12;
@@ -245,6 +251,19 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
         if (IsNvApiEnabled())
             m_pNVApiHeap = CreateDummyNVApiHeap(m_pd3d12Device);
 
+        if (EngineCI.EnableResidencyManagement)
+            m_pResidencyMgr = std::make_unique<D3D12ResidencyManager>(m_pd3d12Device, EngineCI.ResidencyEvictionLatency);
+
+        {
+            CComPtr<IDXGIFactory4> pDXGIFactory;
+            if (SUCCEEDED(CreateDXGIFactory1(__uuidof(pDXGIFactory), reinterpret_cast<void**>(static_cast<IDXGIFactory4**>(&pDXGIFactory)))))
+            {
+                CComPtr<IDXGIAdapter1> pDXGIAdapter1;
+                if (SUCCEEDED(pDXGIFactory->EnumAdapterByLuid(m_pd3d12Device->GetAdapterLuid(), __uuidof(pDXGIAdapter1), reinterpret_cast<void**>(static_cast<IDXGIAdapter1**>(&pDXGIAdapter1)))))
+                    InitDXGIAdapter(pDXGIAdapter1);
+            }
+        }
+
         // Check PSO cache support
         {
             D3D12_FEATURE_DATA_SHADER_CACHE ShaderCacheFeature{};
@@ -254,10 +273,22 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
                 m_IsPSOCacheSupported = (ShaderCacheFeature.SupportFlags & D3D12_SHADER_CACHE_SUPPORT_LIBRARY) != 0;
             }
         }
+
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+        // Check enhanced barriers support
+        {
+            D3D12_FEATURE_DATA_D3D12_OPTIONS12 d3d12Features12{};
+            if (SUCCEEDED(m_pd3d12Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS12, &d3d12Features12, sizeof(d3d12Features12))))
+            {
+                m_IsEnhancedBarriersSupported = d3d12Features12.EnhancedBarriersSupported != FALSE;
+            }
+        }
+#endif
     }
     catch (...)
     {
         m_DynamicMemoryManager.Destroy();
+        m_TextureUploadMemoryManager.Destroy();
         throw;
     }
 }
@@ -269,6 +300,8 @@ CommandListManager& RenderDeviceD3D12Impl::GetCmdListManager(SoftwareQueueIndex
 
 CommandListManager& RenderDeviceD3D12Impl::GetCmdListManager(D3D12_COMMAND_LIST_TYPE CmdListType)
 {
+    if (CmdListType == D3D12_COMMAND_LIST_TYPE_BUNDLE)
+        return m_BundleCmdListManager;
     return m_CmdListManagers[D3D12CommandListTypeToQueueId(CmdListType)];
 }
 
@@ -291,12 +324,16 @@ RenderDeviceD3D12Impl::~RenderDeviceD3D12Impl()
 
     DEV_CHECK_ERR(m_DynamicMemoryManager.GetAllocatedPageCounter() == 0, "All allocated dynamic pages must have been returned to the manager at this point.");
     m_DynamicMemoryManager.Destroy();
+    DEV_CHECK_ERR(m_TextureUploadMemoryManager.GetAllocatedPageCounter() == 0, "All allocated texture upload pages must have been returned to the manager at this point.");
+    m_TextureUploadMemoryManager.Destroy();
 
     for (auto& CmdListMngr : m_CmdListManagers)
         DEV_CHECK_ERR(CmdListMngr.GetAllocatorCounter() == 0, "All allocators must have been returned to the manager at this point.");
+    DEV_CHECK_ERR(m_BundleCmdListManager.GetAllocatorCounter() == 0, "All bundle allocators must have been returned to the manager at this point.");
     DEV_CHECK_ERR(m_AllocatedCtxCounter == 0, "All contexts must have been released.");
 
     m_ContextPool.clear();
+    m_BundleContextPool.clear();
     DestroyCommandQueues();
 }
 
@@ -311,10 +348,23 @@ void RenderDeviceD3D12Impl::DisposeCommandContext(PooledCommandContext&& Ctx)
     FreeCommandContext(std::move(Ctx));
 }
 
+void RenderDeviceD3D12Impl::DisposeClosedCommandContext(PooledCommandContext&&            Ctx,
+                                                        CComPtr<ID3D12CommandAllocator>&& pAllocator,
+                                                        SoftwareQueueIndex                CommandQueueId,
+                                                        Uint64                            FenceValue)
+{
+    VERIFY_EXPR(Ctx && pAllocator);
+    auto& CmdListMngr = GetCmdListManager(Ctx->GetCommandListType());
+    CmdListMngr.ReleaseAllocator(std::move(pAllocator), CommandQueueId, FenceValue);
+    // It is safe to reset the command list as soon as it has been submitted
+    FreeCommandContext(std::move(Ctx));
+}
+
 void RenderDeviceD3D12Impl::FreeCommandContext(PooledCommandContext&& Ctx)
 {
     std::lock_guard<std::mutex> LockGuard(m_ContextPoolMutex);
-    m_ContextPool.emplace_back(std::move(Ctx));
+    auto&                       Pool = Ctx->GetCommandListType() == D3D12_COMMAND_LIST_TYPE_BUNDLE ? m_BundleContextPool : m_ContextPool;
+    Pool.emplace_back(std::move(Ctx));
 #ifdef DILIGENT_DEVELOPMENT
     m_AllocatedCtxCounter.fetch_add(-1);
 #endif
@@ -339,15 +389,70 @@ void RenderDeviceD3D12Impl::CloseAndExecuteTransientCommandContext(SoftwareQueue
     FreeCommandContext(std::move(Ctx));
 }
 
+void RenderDeviceD3D12Impl::RecordInitialDataCopy(SoftwareQueueIndex                          CommandQueueId,
+                                                  Uint64                                      UploadDataSize,
+                                                  const std::function<void(CommandContext&)>& RecordCommands)
+{
+    if (!m_InitialDataBatches)
+    {
+        auto InitContext = AllocateCommandContext(CommandQueueId);
+        RecordCommands(*InitContext);
+        CloseAndExecuteTransientCommandContext(CommandQueueId, std::move(InitContext));
+        return;
+    }
+
+    VERIFY_EXPR(CommandQueueId < m_CmdQueueCount);
+    auto& Batch = m_InitialDataBatches[CommandQueueId];
+
+    bool FlushBatch = false;
+    {
+        std::lock_guard<std::mutex> Lock{Batch.Mtx};
+        if (!Batch.Ctx)
+            Batch.Ctx = AllocateCommandContext(CommandQueueId, "Initial data batch");
+
+        // Every command initializes its own resource, so the commands do not need to be synchronized with each other
+        RecordCommands(*Batch.Ctx);
+        Batch.UploadDataSize += UploadDataSize;
+        FlushBatch = Batch.UploadDataSize >= m_InitialDataBatchSize;
+    }
+
+    // Large batches are submitted right away to limit the amount of upload memory in flight
+    if (FlushBatch)
+        FlushInitialDataBatch(CommandQueueId);
+}
+
+void RenderDeviceD3D12Impl::FlushInitialDataBatch(SoftwareQueueIndex CommandQueueId)
+{
+    if (!m_InitialDataBatches)
+        return;
+
+    VERIFY_EXPR(CommandQueueId < m_CmdQueueCount);
+    auto& Batch = m_InitialDataBatches[CommandQueueId];
+
+    std::lock_guard<std::mutex> Lock{Batch.Mtx};
+    if (!Batch.Ctx)
+        return;
+
+    // The upload buffers of the batch have been released to the stale object list of the queue.
+    // The batch is executed before the next command list that discards them, so they
+    // are only destroyed after the batch has been completed.
+    CloseAndExecuteTransientCommandContext(CommandQueueId, std::move(Batch.Ctx));
+    Batch.UploadDataSize = 0;
+}
+
 Uint64 RenderDeviceD3D12Impl::CloseAndExecuteCommandContexts(SoftwareQueueIndex                                     CommandQueueId,
                                                              Uint32                                                 NumContexts,
                                                              PooledCommandContext                                   pContexts[],
                                                              bool                                                   DiscardStaleObjects,
                                                              std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pSignalFences,
-                                                             std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pWaitFences)
+                                                             std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pWaitFences,
+                                                             ID3D12CommandList* const*                              ppClosedCmdLists)
 {
     VERIFY_EXPR(NumContexts > 0 && pContexts != 0);
 
+    // The command lists may use the resources initialized by the batched copies
+    FlushInitialDataBatch(CommandQueueId);
+
     // TODO: use small_vector
     std::vector<ID3D12CommandList*>              d3d12CmdLists;
     std::vector<CComPtr<ID3D12CommandAllocator>> CmdAllocators;
@@ -358,7 +463,13 @@ Uint64 RenderDeviceD3D12Impl::CloseAndExecuteCommandContexts(SoftwareQueueIndex
     for (Uint32 i = 0; i < NumContexts; ++i)
     {
         auto& pCtx = pContexts[i];
-        VERIFY_EXPR(pCtx);
+        if (!pCtx)
+        {
+            VERIFY(ppClosedCmdLists != nullptr && ppClosedCmdLists[i] != nullptr, "Either a command context or a closed command list must be provided");
+            d3d12CmdLists.emplace_back(ppClosedCmdLists[i]);
+            CmdAllocators.emplace_back();
+            continue;
+        }
         VERIFY_EXPR(CmdListMngr.GetCommandListType() == pCtx->GetCommandListType());
         CComPtr<ID3D12CommandAllocator> pAllocator;
         d3d12CmdLists.emplace_back(pCtx->Close(pAllocator));
@@ -366,6 +477,46 @@ Uint64 RenderDeviceD3D12Impl::CloseAndExecuteCommandContexts(SoftwareQueueIndex
     }
 
     Uint64 FenceValue = 0;
+    if (IsAsyncSubmissionEnabled(CommandQueueId))
+    {
+        // The fences must be waited for and signaled by the submission thread to keep the queue order.
+        // The command contexts are returned to the pool after the submission as a command list
+        // must not be reset before it is executed.
+        struct DeferredSubmission
+        {
+            std::vector<ID3D12CommandList*>                       d3d12CmdLists;
+            std::vector<PooledCommandContext>                     Contexts;
+            std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>> SignalFences;
+            std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>> WaitFences;
+        };
+        auto pSubmission = std::make_shared<DeferredSubmission>();
+
+        pSubmission->d3d12CmdLists = std::move(d3d12CmdLists);
+        pSubmission->Contexts.reserve(NumContexts);
+        for (Uint32 i = 0; i < NumContexts; ++i)
+            pSubmission->Contexts.emplace_back(std::move(pContexts[i]));
+        if (pSignalFences != nullptr)
+            pSubmission->SignalFences = *pSignalFences;
+        if (pWaitFences != nullptr)
+            pSubmission->WaitFences = *pWaitFences;
+
+        // The stale objects are discarded the same way as in the synchronous path below.
+        auto SubmittedCmdBuffInfo = TRenderDeviceBase::SubmitCommandBufferAsync(
+            CommandQueueId, true,
+            [this, CommandQueueId, pSubmission](ICommandQueueD3D12* pCmdQueue) {
+                WaitFences(CommandQueueId, pSubmission->WaitFences);
+                const auto SubmittedFenceValue = pCmdQueue->Submit(static_cast<Uint32>(pSubmission->d3d12CmdLists.size()), pSubmission->d3d12CmdLists.data());
+                SignalFences(CommandQueueId, pSubmission->SignalFences);
+                for (auto& pCtx : pSubmission->Contexts)
+                {
+                    if (pCtx)
+                        FreeCommandContext(std::move(pCtx));
+                }
+                return SubmittedFenceValue;
+            });
+        FenceValue = SubmittedCmdBuffInfo.FenceValue;
+    }
+    else
     {
         // Stale objects should only be discarded when submitting cmd list from
         // the immediate context, otherwise the basic requirement may be violated
@@ -395,8 +546,12 @@ Uint64 RenderDeviceD3D12Impl::CloseAndExecuteCommandContexts(SoftwareQueueIndex
 
     for (Uint32 i = 0; i < NumContexts; ++i)
     {
-        CmdListMngr.ReleaseAllocator(std::move(CmdAllocators[i]), CommandQueueId, FenceValue);
-        FreeCommandContext(std::move(pContexts[i]));
+        // The allocator is not reused until the fence value is reached, so it
+        // is safe to release it before an asynchronous submission is executed.
+        if (CmdAllocators[i])
+            CmdListMngr.ReleaseAllocator(std::move(CmdAllocators[i]), CommandQueueId, FenceValue);
+        if (pContexts[i])
+            FreeCommandContext(std::move(pContexts[i]));
     }
 
     PurgeReleaseQueue(CommandQueueId);
@@ -430,12 +585,18 @@ void RenderDeviceD3D12Impl::WaitFences(SoftwareQueueIndex CommandQueueId, std::v
 
 void RenderDeviceD3D12Impl::IdleGPU()
 {
+    for (Uint32 q = 0; q < m_CmdQueueCount; ++q)
+        FlushInitialDataBatch(SoftwareQueueIndex{q});
+
     IdleAllCommandQueues(true);
     ReleaseStaleResources();
 }
 
 void RenderDeviceD3D12Impl::FlushStaleResources(SoftwareQueueIndex CommandQueueId)
 {
+    // Stale upload buffers must not be discarded before the batched copies that use them are executed
+    FlushInitialDataBatch(CommandQueueId);
+
     // Submit empty command list to the queue. This will effectively signal the fence and
     // discard all resources
     TRenderDeviceBase::SubmitCommandBuffer(CommandQueueId, true, 0, nullptr);
@@ -449,13 +610,24 @@ void RenderDeviceD3D12Impl::ReleaseStaleResources(bool ForceRelease)
 
 RenderDeviceD3D12Impl::PooledCommandContext RenderDeviceD3D12Impl::AllocateCommandContext(SoftwareQueueIndex CommandQueueId, const Char* ID)
 {
-    auto& CmdListMngr = GetCmdListManager(CommandQueueId);
+    return AllocateCommandContext(GetCmdListManager(CommandQueueId), ID);
+}
+
+RenderDeviceD3D12Impl::PooledCommandContext RenderDeviceD3D12Impl::AllocateBundleContext(const Char* ID)
+{
+    return AllocateCommandContext(m_BundleCmdListManager, ID);
+}
+
+RenderDeviceD3D12Impl::PooledCommandContext RenderDeviceD3D12Impl::AllocateCommandContext(CommandListManager& CmdListMngr, const Char* ID)
+{
     {
         std::lock_guard<std::mutex> LockGuard(m_ContextPoolMutex);
-        if (!m_ContextPool.empty())
+
+        auto& Pool = CmdListMngr.GetCommandListType() == D3D12_COMMAND_LIST_TYPE_BUNDLE ? m_BundleContextPool : m_ContextPool;
+        if (!Pool.empty())
         {
-            PooledCommandContext Ctx = std::move(m_ContextPool.back());
-            m_ContextPool.pop_back();
+            PooledCommandContext Ctx = std::move(Pool.back());
+            Pool.pop_back();
             Ctx->Reset(CmdListMngr);
             Ctx->SetID(ID);
 #ifdef DILIGENT_DEVELOPMENT
@@ -598,6 +770,16 @@ void RenderDeviceD3D12Impl::CreateQuery(const QueryDesc& Desc, IQuery** ppQuery)
     CreateQueryImpl(ppQuery, Desc);
 }
 
+void RenderDeviceD3D12Impl::CreateQueryArray(const QueryArrayDesc& Desc, IQueryArray** ppQueryArray)
+{
+    CreateDeviceObject("Query array", Desc, ppQueryArray,
+                       [&]() //
+                       {
+                           auto* pQueryArrayD3D12{NEW_RC_OBJ(GetRawAllocator(), "QueryArrayD3D12Impl instance", QueryArrayD3D12Impl)(this, Desc)};
+                           pQueryArrayD3D12->QueryInterface(IID_QueryArray, reinterpret_cast<IObject**>(ppQueryArray));
+                       });
+}
+
 void RenderDeviceD3D12Impl::CreateRenderPass(const RenderPassDesc& Desc, IRenderPass** ppRenderPass)
 {
     CreateRenderPassImpl(ppRenderPass, Desc);
@@ -675,9 +857,32 @@ DescriptorHeapAllocation RenderDeviceD3D12Impl::AllocateGPUDescriptors(D3D12_DES
     return m_GPUDescriptorHeaps[Type].Allocate(Count);
 }
 
-void RenderDeviceD3D12Impl::CreateRootSignature(const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl>* ppSignatures, Uint32 SignatureCount, size_t Hash, RootSignatureD3D12** ppRootSig)
+void RenderDeviceD3D12Impl::GetGPUDescriptorHeapStats(D3D12_DESCRIPTOR_HEAP_TYPE HeapType, GPUDescriptorHeapStatsD3D12& Stats)
 {
-    RootSignatureD3D12* pRootSigD3D12{NEW_RC_OBJ(m_RootSignatureAllocator, "RootSignatureD3D12 instance", RootSignatureD3D12)(this, ppSignatures, SignatureCount, Hash)};
+    if (HeapType != D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV && HeapType != D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER)
+    {
+        LOG_ERROR_MESSAGE("Invalid heap type (", int{HeapType}, "): only CBV_SRV_UAV and SAMPLER heaps are GPU-visible");
+        Stats = {};
+        return;
+    }
+    m_GPUDescriptorHeaps[HeapType].GetStats(Stats);
+}
+
+Uint32 RenderDeviceD3D12Impl::CompactGPUDescriptorHeaps(Uint32 MaxDescriptorsToMove)
+{
+    Uint32 NumRelocated = 0;
+    for (auto& Heap : m_GPUDescriptorHeaps)
+        NumRelocated += Heap.Compact(MaxDescriptorsToMove);
+    return NumRelocated;
+}
+
+void RenderDeviceD3D12Impl::CreateRootSignature(const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl>* ppSignatures,
+                                                Uint32                                                   SignatureCount,
+                                                size_t                                                   Hash,
+                                                PipelineStateCacheD3D12Impl*                             pPSOCache,
+                                                RootSignatureD3D12**                                     ppRootSig)
+{
+    RootSignatureD3D12* pRootSigD3D12{NEW_RC_OBJ(m_RootSignatureAllocator, "RootSignatureD3D12 instance", RootSignatureD3D12)(this, ppSignatures, SignatureCount, Hash, pPSOCache)};
     pRootSigD3D12->AddRef();
     *ppRootSig = pRootSigD3D12;
 }
@@ -715,4 +920,34 @@ SparseTextureFormatInfo RenderDeviceD3D12Impl::GetSparseTextureFormatInfo(TEXTUR
     return TRenderDeviceBase::GetSparseTextureFormatInfo(TexFormat, Dimension, SampleCount);
 }
 
+ResourceMemoryRequirements RenderDeviceD3D12Impl::GetTextureMemoryRequirements(const TextureDesc& TexDesc) const
+{
+    D3D12_RESOURCE_DESC d3d12TexDesc{};
+    try
+    {
+        d3d12TexDesc = TextureDescToD3D12ResourceDesc(TexDesc);
+    }
+    catch (...)
+    {
+        return {};
+    }
+    const auto d3d12AllocInfo = m_pd3d12Device->GetResourceAllocationInfo(0, 1, &d3d12TexDesc);
+
+    ResourceMemoryRequirements MemReqs;
+    MemReqs.Size      = d3d12AllocInfo.SizeInBytes;
+    MemReqs.Alignment = d3d12AllocInfo.Alignment;
+    return MemReqs;
+}
+
+ResourceMemoryRequirements RenderDeviceD3D12Impl::GetBufferMemoryRequirements(const BufferDesc& BuffDesc) const
+{
+    const auto d3d12BuffDesc  = BufferDescToD3D12ResourceDesc(BuffDesc);
+    const auto d3d12AllocInfo = m_pd3d12Device->GetResourceAllocationInfo(0, 1, &d3d12BuffDesc);
+
+    ResourceMemoryRequirements MemReqs;
+    MemReqs.Size      = d3d12AllocInfo.SizeInBytes;
+    MemReqs.Alignment = d3d12AllocInfo.Alignment;
+    return MemReqs;
+}
+
 } // namespace Diligent
@@ -31,6 +31,8 @@
 
 #include "RenderDeviceD3D12Impl.hpp"
 #include "PipelineResourceSignatureD3D12Impl.hpp"
+#include "PipelineStateCacheD3D12Impl.hpp"
+#include "DataBlobImpl.hpp"
 #include "CommandContext.hpp"
 #include "D3D12TypeConversions.hpp"
 #include "HashUtils.hpp"
@@ -38,11 +40,59 @@
 namespace Diligent
 {
 
+namespace
+{
+
+template <typename T>
+void AppendBytes(std::string& Key, const T& Value)
+{
+    Key.append(reinterpret_cast<const char*>(&Value), sizeof(Value));
+}
+
+// Returns the byte representation of the root signature description with all pointers resolved.
+// All structures that are copied as a whole have no padding.
+std::string GetRootSignatureDescKey(const D3D12_ROOT_SIGNATURE_DESC& Desc)
+{
+    std::string Key;
+    AppendBytes(Key, D3D_ROOT_SIGNATURE_VERSION_1);
+    AppendBytes(Key, Desc.Flags);
+    AppendBytes(Key, Desc.NumParameters);
+    for (UINT i = 0; i < Desc.NumParameters; ++i)
+    {
+        const auto& Param = Desc.pParameters[i];
+        AppendBytes(Key, Param.ParameterType);
+        AppendBytes(Key, Param.ShaderVisibility);
+        switch (Param.ParameterType)
+        {
+            case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
+                AppendBytes(Key, Param.DescriptorTable.NumDescriptorRanges);
+                for (UINT r = 0; r < Param.DescriptorTable.NumDescriptorRanges; ++r)
+                    AppendBytes(Key, Param.DescriptorTable.pDescriptorRanges[r]);
+                break;
+
+            case D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS:
+                AppendBytes(Key, Param.Constants);
+                break;
+
+            default:
+                AppendBytes(Key, Param.Descriptor);
+        }
+    }
+    AppendBytes(Key, Desc.NumStaticSamplers);
+    for (UINT i = 0; i < Desc.NumStaticSamplers; ++i)
+        AppendBytes(Key, Desc.pStaticSamplers[i]);
+
+    return Key;
+}
+
+} // namespace
+
 RootSignatureD3D12::RootSignatureD3D12(IReferenceCounters*                                     pRefCounters,
                                        RenderDeviceD3D12Impl*                                  pDeviceD3D12Impl,
                                        const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl> ppSignatures[],
                                        Uint32                                                  SignatureCount,
-                                       size_t                                                  Hash) :
+                                       size_t                                                  Hash,
+                                       PipelineStateCacheD3D12Impl*                            pPSOCache) :
     ObjectBase<IObject>{pRefCounters},
     m_SignatureCount{SignatureCount},
     m_Hash{Hash}
@@ -225,22 +275,40 @@ RootSignatureD3D12::RootSignatureD3D12(IReferenceCounters*
 
     if (pDeviceD3D12Impl)
     {
-        CComPtr<ID3DBlob> signature;
-        CComPtr<ID3DBlob> error;
+        auto* pd3d12Device = pDeviceD3D12Impl->GetD3D12Device();
 
-        HRESULT hr = D3D12SerializeRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, &error);
-        if (error)
+        m_DescKey = GetRootSignatureDescKey(rootSignatureDesc);
+        if (pPSOCache != nullptr)
         {
-            LOG_ERROR_MESSAGE("Error: ", (const char*)error->GetBufferPointer());
+            if (auto pCachedData = pPSOCache->LoadRootSignature(m_DescKey))
+            {
+                HRESULT hr = pd3d12Device->CreateRootSignature(0, pCachedData->GetConstDataPtr(), pCachedData->GetSize(), __uuidof(m_pd3d12RootSignature), reinterpret_cast<void**>(static_cast<ID3D12RootSignature**>(&m_pd3d12RootSignature)));
+                if (SUCCEEDED(hr))
+                    m_pSerializedData = std::move(pCachedData);
+                else
+                    LOG_WARNING_MESSAGE("Failed to create root signature from the cached data. The root signature will be serialized again.");
+            }
         }
-        CHECK_D3D_RESULT_THROW(hr, "Failed to serialize root signature");
 
-        m_pCache = &pDeviceD3D12Impl->GetRootSignatureCache();
+        if (!m_pd3d12RootSignature)
+        {
+            CComPtr<ID3DBlob> signature;
+            CComPtr<ID3DBlob> error;
 
-        auto* pd3d12Device = pDeviceD3D12Impl->GetD3D12Device();
+            HRESULT hr = D3D12SerializeRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, &error);
+            if (error)
+            {
+                LOG_ERROR_MESSAGE("Error: ", (const char*)error->GetBufferPointer());
+            }
+            CHECK_D3D_RESULT_THROW(hr, "Failed to serialize root signature");
+
+            hr = pd3d12Device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), __uuidof(m_pd3d12RootSignature), reinterpret_cast<void**>(static_cast<ID3D12RootSignature**>(&m_pd3d12RootSignature)));
+            CHECK_D3D_RESULT_THROW(hr, "Failed to create root signature");
 
-        hr = pd3d12Device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), __uuidof(m_pd3d12RootSignature), reinterpret_cast<void**>(static_cast<ID3D12RootSignature**>(&m_pd3d12RootSignature)));
-        CHECK_D3D_RESULT_THROW(hr, "Failed to create root signature");
+            m_pSerializedData = DataBlobImpl::Create(signature->GetBufferSize(), signature->GetBufferPointer());
+        }
+
+        m_pCache = &pDeviceD3D12Impl->GetRootSignatureCache();
     }
 }
 
@@ -331,7 +399,9 @@ RootSignatureCacheD3D12::~RootSignatureCacheD3D12()
     VERIFY(m_RootSigCache.empty(), "All pipeline resource signatures must be released before the cache is destroyed.");
 }
 
-RefCntAutoPtr<RootSignatureD3D12> RootSignatureCacheD3D12::GetRootSig(const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl>* ppSignatures, Uint32 SignatureCount)
+RefCntAutoPtr<RootSignatureD3D12> RootSignatureCacheD3D12::GetRootSig(const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl>* ppSignatures,
+                                                                      Uint32                                                   SignatureCount,
+                                                                      PipelineStateCacheD3D12Impl*                             pPSOCache)
 {
     size_t Hash = 0;
     if (SignatureCount > 0)
@@ -362,7 +432,7 @@ RefCntAutoPtr<RootSignatureD3D12> RootSignatureCacheD3D12::GetRootSig(const RefC
     }
 
     RefCntAutoPtr<RootSignatureD3D12> pNewRootSig;
-    m_DeviceD3D12Impl.CreateRootSignature(ppSignatures, SignatureCount, Hash, &pNewRootSig);
+    m_DeviceD3D12Impl.CreateRootSignature(ppSignatures, SignatureCount, Hash, pPSOCache, &pNewRootSig);
 
     m_RootSigCache.emplace(Hash, pNewRootSig);
     return pNewRootSig;
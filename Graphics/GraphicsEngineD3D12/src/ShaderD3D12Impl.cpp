@@ -123,16 +123,24 @@ ShaderD3D12Impl::ShaderD3D12Impl(IReferenceCounters*     pRefCounters,
     // Load shader resources
     if ((ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_SKIP_REFLECTION) == 0)
     {
+        const char* CombinedSamplerSuffix = m_Desc.UseCombinedTextureSamplers ? m_Desc.CombinedSamplerSuffix : nullptr;
+
+        // Serialized resources do not contain constant buffer reflection
+        const void* pSerializedResources = nullptr;
+        size_t      SerializedResSize    = 0;
+        if (!ShaderCI.LoadConstantBufferReflection && ShaderCI.ByteCode != nullptr)
+        {
+            const void* pBytecode    = nullptr;
+            size_t      BytecodeSize = 0;
+            if (!UnpackBytecodeWithResources(ShaderCI.ByteCode, ShaderCI.ByteCodeSize, pBytecode, BytecodeSize, pSerializedResources, SerializedResSize))
+                pSerializedResources = nullptr;
+        }
+
         auto& Allocator  = GetRawAllocator();
         auto* pRawMem    = ALLOCATE(Allocator, "Allocator for ShaderResources", ShaderResourcesD3D12, 1);
-        auto* pResources = new (pRawMem) ShaderResourcesD3D12 //
-            {
-                m_pShaderByteCode,
-                m_Desc,
-                m_Desc.UseCombinedTextureSamplers ? m_Desc.CombinedSamplerSuffix : nullptr,
-                D3D12ShaderCI.pDXCompiler,
-                ShaderCI.LoadConstantBufferReflection //
-            };
+        auto* pResources = pSerializedResources != nullptr ?
+            new (pRawMem) ShaderResourcesD3D12{pSerializedResources, SerializedResSize, m_Desc, CombinedSamplerSuffix} :
+            new (pRawMem) ShaderResourcesD3D12{m_pShaderByteCode, m_Desc, CombinedSamplerSuffix, D3D12ShaderCI.pDXCompiler, ShaderCI.LoadConstantBufferReflection};
         m_pShaderResources.reset(pResources, STDDeleterRawMem<ShaderResourcesD3D12>(Allocator));
     }
 }
@@ -35,6 +35,7 @@
 #include "TextureD3D12Impl.hpp"
 #include "TextureViewD3D12Impl.hpp"
 #include "TopLevelASD3D12Impl.hpp"
+#include "D3D12TypeConversions.hpp"
 
 #include "CommandContext.hpp"
 
@@ -191,7 +192,9 @@ void ShaderResourceCacheD3D12::Initialize(IMemoryAllocator&        MemAllocator,
             TableSize,
             &GetResource(ResIdx),
             false, // IsRootView
-            RootTbl.TableOffsetInGroupAllocation};
+            RootTbl.TableOffsetInGroupAllocation,
+            D3D12DescriptorRangeTypeToD3D12HeapType(RootTbl.d3d12RootParam.DescriptorTable.pDescriptorRanges[0].RangeType),
+            RootTbl.Group};
         ResIdx += TableSize;
 
 #ifdef DILIGENT_DEBUG
@@ -250,6 +253,12 @@ void ShaderResourceCacheD3D12::Initialize(IMemoryAllocator&        MemAllocator,
                 {
                     // For static/mutable parameters, allocate GPU-visible descriptor space
                     Allocation = pDevice->AllocateGPUDescriptors(d3d12HeapType, TotalTableResources);
+                    if (!Allocation.IsNull())
+                    {
+                        // Long-lived static/mutable tables may be moved by IRenderDeviceD3D12::CompactGPUDescriptorHeaps()
+                        pDevice->GetGPUDescriptorHeap(d3d12HeapType).RegisterRelocatableCache(*this);
+                        m_pDevice = pDevice;
+                    }
                 }
                 else if (GroupType == ROOT_PARAMETER_GROUP_DYNAMIC)
                 {
@@ -267,7 +276,8 @@ void ShaderResourceCacheD3D12::Initialize(IMemoryAllocator&        MemAllocator,
                               (d3d12HeapType == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV ? "CBV/SRV/UAV" : "Sampler"),
                               " descriptor(s). Consider increasing ",
                               (GroupType == ROOT_PARAMETER_GROUP_STATIC_MUTABLE ? "GPUDescriptorHeapSize" : "CPUDescriptorHeapSize"),
-                              '[', int{d3d12HeapType}, "] in EngineD3D12CreateInfo.");
+                              '[', int{d3d12HeapType}, "] in EngineD3D12CreateInfo",
+                              (GroupType == ROOT_PARAMETER_GROUP_STATIC_MUTABLE ? " or calling IRenderDeviceD3D12::CompactGPUDescriptorHeaps() to reduce fragmentation." : "."));
             }
             else
             {
@@ -280,6 +290,17 @@ void ShaderResourceCacheD3D12::Initialize(IMemoryAllocator&        MemAllocator,
 
 ShaderResourceCacheD3D12::~ShaderResourceCacheD3D12()
 {
+    if (m_pDevice != nullptr)
+    {
+        // Unregister the cache before the allocations are released so that the heaps never see a partially destroyed cache
+        for (auto d3d12HeapType : {D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER})
+        {
+            const auto AllocationIdx = m_AllocationIndex[d3d12HeapType][ROOT_PARAMETER_GROUP_STATIC_MUTABLE];
+            if (AllocationIdx >= 0 && !m_DescriptorAllocations[AllocationIdx].IsNull())
+                m_pDevice->GetGPUDescriptorHeap(d3d12HeapType).UnregisterRelocatableCache(*this);
+        }
+    }
+
     if (m_pMemory)
     {
         for (Uint32 res = 0; res < m_TotalResourceCount; ++res)
@@ -402,23 +423,63 @@ const ShaderResourceCacheD3D12::Resource& ShaderResourceCacheD3D12::CopyResource
 
             auto DstDescrHandle = GetDescriptorTableHandle<D3D12_CPU_DESCRIPTOR_HANDLE>(
                 HeapType, ROOT_PARAMETER_GROUP_STATIC_MUTABLE, RootIndex, OffsetFromTableStart);
-            if (DstRes.CPUDescriptorHandle.ptr != 0)
-            {
-                pd3d12Device->CopyDescriptorsSimple(1, DstDescrHandle, SrcRes.CPUDescriptorHandle, HeapType);
-            }
-            else
-            {
-                VERIFY(DstRes.Type == SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, "Null CPU descriptor is only allowed for constant buffers");
-                const auto* pBuffer = DstRes.pObject.RawPtr<const BufferD3D12Impl>();
-                VERIFY(DstRes.BufferRangeSize < pBuffer->GetDesc().Size, "Null CPU descriptor is only allowed for partial views of constant buffers");
-                pBuffer->CreateCBV(DstDescrHandle, DstRes.BufferBaseOffset, DstRes.BufferRangeSize);
-            }
+            WriteTableDescriptor(pd3d12Device, HeapType, DstDescrHandle, DstRes);
         }
     }
 
     return DstRes;
 }
 
+void ShaderResourceCacheD3D12::WriteTableDescriptor(ID3D12Device*               pd3d12Device,
+                                                    D3D12_DESCRIPTOR_HEAP_TYPE  HeapType,
+                                                    D3D12_CPU_DESCRIPTOR_HANDLE DstDescrHandle,
+                                                    const Resource&             Res)
+{
+    if (Res.CPUDescriptorHandle.ptr != 0)
+    {
+        pd3d12Device->CopyDescriptorsSimple(1, DstDescrHandle, Res.CPUDescriptorHandle, HeapType);
+    }
+    else
+    {
+        VERIFY(Res.Type == SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, "Null CPU descriptor is only allowed for constant buffers");
+        const auto* pBuffer = Res.pObject.RawPtr<const BufferD3D12Impl>();
+        VERIFY(Res.BufferRangeSize < pBuffer->GetDesc().Size, "Null CPU descriptor is only allowed for partial views of constant buffers");
+        pBuffer->CreateCBV(DstDescrHandle, Res.BufferBaseOffset, Res.BufferRangeSize);
+    }
+}
+
+void ShaderResourceCacheD3D12::RelocateDescriptorTables(ID3D12Device*              pd3d12Device,
+                                                        D3D12_DESCRIPTOR_HEAP_TYPE HeapType,
+                                                        DescriptorHeapAllocation&& NewAllocation)
+{
+    VERIFY_EXPR(m_ContentType == ResourceCacheContentType::SRB);
+
+    const auto AllocationIdx = m_AllocationIndex[HeapType][ROOT_PARAMETER_GROUP_STATIC_MUTABLE];
+    VERIFY(AllocationIdx >= 0, "Descriptor space is not assigned to static/mutable tables of this heap type");
+    auto& Allocation = m_DescriptorAllocations[AllocationIdx];
+    VERIFY_EXPR(NewAllocation.GetNumHandles() == Allocation.GetNumHandles());
+
+    // Source descriptors must not be read from the shader-visible heap, so
+    // all descriptors are written again from the CPU-only heaps.
+    for (Uint32 t = 0; t < m_NumTables; ++t)
+    {
+        const auto& Tbl = GetRootTable(t);
+        if (Tbl.IsRootView() || Tbl.GetGroup() != ROOT_PARAMETER_GROUP_STATIC_MUTABLE || Tbl.GetHeapType() != HeapType)
+            continue;
+
+        for (Uint32 res = 0; res < Tbl.GetSize(); ++res)
+        {
+            const auto& Res = Tbl.GetResource(res);
+            if (!Res.IsNull())
+                WriteTableDescriptor(pd3d12Device, HeapType, NewAllocation.GetCpuHandle(Tbl.GetStartOffset() + res), Res);
+        }
+    }
+
+    // Note that move-assignment does not release the allocation
+    DescriptorHeapAllocation OldAllocation{std::move(Allocation)};
+    Allocation = std::move(NewAllocation);
+}
+
 
 #ifdef DILIGENT_DEBUG
 void ShaderResourceCacheD3D12::DbgValidateDynamicBuffersMask() const
@@ -673,8 +734,23 @@ void ShaderResourceCacheD3D12::Resource::DvpVerifyResourceState()
 }
 #endif // DILIGENT_DEVELOPMENT
 
-void ShaderResourceCacheD3D12::TransitionResourceStates(CommandContext& Ctx, StateTransitionMode Mode)
+void ShaderResourceCacheD3D12::TransitionResourceStates(CommandContext& Ctx, StateTransitionMode Mode, const RenderDeviceD3D12Impl& Device)
 {
+    if (Mode == StateTransitionMode::Transition)
+    {
+        if (ResourceStatesUpToDate(Device.GetResourceStateEpoch()))
+        {
+            // No resource has been bound to the cache and no resource has changed its state
+            // since the last full transition, so only the resources that require a barrier
+            // every time they are used need to be processed.
+            for (auto r : m_BarrierResources)
+                GetResource(r).TransitionResource(Ctx);
+            return;
+        }
+
+        m_BarrierResources.clear();
+    }
+
     for (Uint32 r = 0; r < m_TotalResourceCount; ++r)
     {
         auto& Res = GetResource(r);
@@ -682,6 +758,12 @@ void ShaderResourceCacheD3D12::TransitionResourceStates(CommandContext& Ctx, Sta
         {
             case StateTransitionMode::Transition:
                 Res.TransitionResource(Ctx);
+                // UAVs and acceleration structures are transitioned even when the state is the same (see TransitionResource())
+                if (Res.pObject != nullptr &&
+                    (Res.Type == SHADER_RESOURCE_TYPE_BUFFER_UAV || Res.Type == SHADER_RESOURCE_TYPE_TEXTURE_UAV || Res.Type == SHADER_RESOURCE_TYPE_ACCEL_STRUCT))
+                {
+                    m_BarrierResources.push_back(r);
+                }
                 break;
 
             case StateTransitionMode::Verify:
@@ -694,6 +776,43 @@ void ShaderResourceCacheD3D12::TransitionResourceStates(CommandContext& Ctx, Sta
                 UNEXPECTED("Unexpected mode");
         }
     }
+
+    // Note that the epoch must be read after the transitions as they may change it.
+    if (Mode == StateTransitionMode::Transition)
+        SetResourceStatesUpToDate(Device.GetResourceStateEpoch());
+}
+
+void ShaderResourceCacheD3D12::MarkResourcesUsed(D3D12ResidencyManager& ResidencyMgr)
+{
+    static_assert(SHADER_RESOURCE_TYPE_LAST == 8, "Please update this function to handle the new resource type");
+    for (Uint32 r = 0; r < m_TotalResourceCount; ++r)
+    {
+        auto& Res = GetResource(r);
+        if (Res.IsNull())
+            continue;
+
+        switch (Res.Type)
+        {
+            case SHADER_RESOURCE_TYPE_CONSTANT_BUFFER:
+                ResidencyMgr.MarkUsed(*Res.pObject.RawPtr<BufferD3D12Impl>());
+                break;
+
+            case SHADER_RESOURCE_TYPE_BUFFER_SRV:
+            case SHADER_RESOURCE_TYPE_BUFFER_UAV:
+                ResidencyMgr.MarkUsed(*Res.pObject.RawPtr<BufferViewD3D12Impl>()->GetBuffer<BufferD3D12Impl>());
+                break;
+
+            case SHADER_RESOURCE_TYPE_TEXTURE_SRV:
+            case SHADER_RESOURCE_TYPE_TEXTURE_UAV:
+            case SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT:
+                ResidencyMgr.MarkUsed(*Res.pObject.RawPtr<TextureViewD3D12Impl>()->GetTexture<TextureD3D12Impl>());
+                break;
+
+            default:
+                // Samplers and acceleration structures are not managed
+                break;
+        }
+    }
 }
 
 } // namespace Diligent
@@ -45,6 +45,25 @@ static Uint32 GetRegisterSpace(const D3D12_SHADER_INPUT_BIND_DESC& BindingDesc)
     return BindingDesc.Space;
 }
 
+namespace
+{
+
+class NewResourceHandler
+{
+public:
+    // clang-format off
+    void OnNewCB         (const D3DShaderResourceAttribs& CBAttribs)     {}
+    void OnNewTexUAV     (const D3DShaderResourceAttribs& TexUAV)        {}
+    void OnNewBuffUAV    (const D3DShaderResourceAttribs& BuffUAV)       {}
+    void OnNewBuffSRV    (const D3DShaderResourceAttribs& BuffSRV)       {}
+    void OnNewSampler    (const D3DShaderResourceAttribs& SamplerAttribs){}
+    void OnNewTexSRV     (const D3DShaderResourceAttribs& TexAttribs)    {}
+    void OnNewAccelStruct(const D3DShaderResourceAttribs& ASAttribs)     {}
+    // clang-format on
+};
+
+} // namespace
+
 ShaderResourcesD3D12::ShaderResourcesD3D12(ID3DBlob*         pShaderBytecode,
                                            const ShaderDesc& ShdrDesc,
                                            const char*       CombinedSamplerSuffix,
@@ -69,19 +88,6 @@ ShaderResourcesD3D12::ShaderResourcesD3D12(ID3DBlob*         pShaderBytecode,
         CHECK_D3D_RESULT_THROW(hr, "Failed to get the shader reflection");
     }
 
-    class NewResourceHandler
-    {
-    public:
-        // clang-format off
-        void OnNewCB         (const D3DShaderResourceAttribs& CBAttribs)     {}
-        void OnNewTexUAV     (const D3DShaderResourceAttribs& TexUAV)        {}
-        void OnNewBuffUAV    (const D3DShaderResourceAttribs& BuffUAV)       {}
-        void OnNewBuffSRV    (const D3DShaderResourceAttribs& BuffSRV)       {}
-        void OnNewSampler    (const D3DShaderResourceAttribs& SamplerAttribs){}
-        void OnNewTexSRV     (const D3DShaderResourceAttribs& TexAttribs)    {}
-        void OnNewAccelStruct(const D3DShaderResourceAttribs& ASAttribs)     {}
-        // clang-format on
-    };
     struct D3D12ReflectionTraits
     {
         using D3D_SHADER_DESC            = D3D12_SHADER_DESC;
@@ -98,4 +104,14 @@ ShaderResourcesD3D12::ShaderResourcesD3D12(ID3DBlob*         pShaderBytecode,
         LoadConstantBufferReflection);
 }
 
+ShaderResourcesD3D12::ShaderResourcesD3D12(const void*       pSerializedData,
+                                           size_t            DataSize,
+                                           const ShaderDesc& ShdrDesc,
+                                           const char*       CombinedSamplerSuffix) :
+    ShaderResources{ShdrDesc.ShaderType}
+{
+    Serializer<SerializerMode::Read> Ser{SerializedData{const_cast<void*>(pSerializedData), DataSize}};
+    Initialize(Ser, NewResourceHandler{}, ShdrDesc.Name, CombinedSamplerSuffix);
+}
+
 } // namespace Diligent
@@ -133,15 +133,13 @@ const ShaderVariableManagerD3D12::ResourceAttribs& ShaderVariableManagerD3D12::G
 }
 
 
-ShaderVariableD3D12Impl* ShaderVariableManagerD3D12::GetVariable(const Char* Name) const
+ShaderVariableD3D12Impl* ShaderVariableManagerD3D12::GetVariable(SHADER_TYPE ShaderType, const Char* Name) const
 {
-    for (Uint32 v = 0; v < m_NumVariables; ++v)
-    {
-        auto& Var = m_pVariables[v];
-        if (strcmp(Var.GetDesc().Name, Name) == 0)
-            return &Var;
-    }
-    return nullptr;
+    const auto ResIndex = m_pSignature->FindResource(ShaderType, Name);
+    if (ResIndex == InvalidPipelineResourceIndex)
+        return nullptr;
+
+    return FindVariableByResIndex(m_pVariables, m_NumVariables, ResIndex);
 }
 
 
@@ -150,17 +150,27 @@ void SwapChainD3D12Impl::Present(Uint32 SyncInterval)
     pImmediateCtxD3D12->Flush();
 
     // In contrast to MSDN sample, we wait for the frame as late as possible - right
-    // before presenting.
+    // before presenting. In the low-latency mode, the application waits for the frame
+    // itself using WaitForFrame().
     // https://docs.microsoft.com/en-us/windows/uwp/gaming/reduce-latency-with-dxgi-1-3-swap-chains#step-4-wait-before-rendering-each-frame
-    WaitForFrame();
+    if (!m_SwapChainDesc.LowLatencyMode)
+        WaitForFrameLatencyObject();
 
-    auto hr = m_pSwapChain->Present(SyncInterval, 0);
+    auto* pDeviceD3D12 = ClassPtrCast<RenderDeviceD3D12Impl>(pImmediateCtxD3D12->GetDevice());
+
+    HRESULT hr = S_OK;
+    // The present must be queued after the command lists that the submission thread may not have submitted yet
+    pDeviceD3D12->LockCmdQueueAndRun(
+        pImmediateCtxD3D12->GetCommandQueueId(),
+        [&](ICommandQueueD3D12* /*pCmdQueue*/) //
+        {
+            hr = m_pSwapChain->Present(SyncInterval, 0);
+        });
     VERIFY(SUCCEEDED(hr), "Present failed");
 
     if (m_SwapChainDesc.IsPrimary)
     {
         pImmediateCtxD3D12->FinishFrame();
-        auto* pDeviceD3D12 = ClassPtrCast<RenderDeviceD3D12Impl>(pImmediateCtxD3D12->GetDevice());
         pDeviceD3D12->ReleaseStaleResources();
     }
 
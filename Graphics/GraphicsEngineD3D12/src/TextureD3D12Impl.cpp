@@ -32,6 +32,7 @@
 #include "RenderDeviceD3D12Impl.hpp"
 #include "DeviceContextD3D12Impl.hpp"
 #include "TextureViewD3D12Impl.hpp"
+#include "DeviceMemoryD3D12Impl.hpp"
 
 #include "D3D12TypeConversions.hpp"
 #include "DXGITypeConversions.hpp"
@@ -80,23 +81,23 @@ static DXGI_FORMAT GetClearFormat(DXGI_FORMAT Fmt, D3D12_RESOURCE_FLAGS Flags)
     return Fmt;
 }
 
-D3D12_RESOURCE_DESC TextureD3D12Impl::GetD3D12TextureDesc() const
+D3D12_RESOURCE_DESC TextureDescToD3D12ResourceDesc(const TextureDesc& TexDesc) noexcept(false)
 {
     D3D12_RESOURCE_DESC Desc = {};
 
     Desc.Alignment = 0;
-    if (m_Desc.IsArray())
-        Desc.DepthOrArraySize = StaticCast<UINT16>(m_Desc.ArraySize);
-    else if (m_Desc.Is3D())
-        Desc.DepthOrArraySize = StaticCast<UINT16>(m_Desc.Depth);
+    if (TexDesc.IsArray())
+        Desc.DepthOrArraySize = StaticCast<UINT16>(TexDesc.ArraySize);
+    else if (TexDesc.Is3D())
+        Desc.DepthOrArraySize = StaticCast<UINT16>(TexDesc.Depth);
     else
         Desc.DepthOrArraySize = 1;
 
-    if (m_Desc.Is1D())
+    if (TexDesc.Is1D())
         Desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE1D;
-    else if (m_Desc.Is2D())
+    else if (TexDesc.Is2D())
         Desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-    else if (m_Desc.Is3D())
+    else if (TexDesc.Is3D())
         Desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE3D;
     else
     {
@@ -104,31 +105,36 @@ D3D12_RESOURCE_DESC TextureD3D12Impl::GetD3D12TextureDesc() const
     }
 
     Desc.Flags = D3D12_RESOURCE_FLAG_NONE;
-    if (m_Desc.BindFlags & BIND_RENDER_TARGET)
+    if (TexDesc.BindFlags & BIND_RENDER_TARGET)
         Desc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
-    if (m_Desc.BindFlags & BIND_DEPTH_STENCIL)
+    if (TexDesc.BindFlags & BIND_DEPTH_STENCIL)
         Desc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
-    if ((m_Desc.BindFlags & BIND_UNORDERED_ACCESS) || (m_Desc.MiscFlags & MISC_TEXTURE_FLAG_GENERATE_MIPS))
+    if ((TexDesc.BindFlags & BIND_UNORDERED_ACCESS) || (TexDesc.MiscFlags & MISC_TEXTURE_FLAG_GENERATE_MIPS))
         Desc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
-    if ((m_Desc.BindFlags & (BIND_SHADER_RESOURCE | BIND_INPUT_ATTACHMENT)) == 0 && (m_Desc.BindFlags & BIND_DEPTH_STENCIL) != 0)
+    if ((TexDesc.BindFlags & (BIND_SHADER_RESOURCE | BIND_INPUT_ATTACHMENT)) == 0 && (TexDesc.BindFlags & BIND_DEPTH_STENCIL) != 0)
         Desc.Flags |= D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE;
 
-    auto Format = TexFormatToDXGI_Format(m_Desc.Format, m_Desc.BindFlags);
+    auto Format = TexFormatToDXGI_Format(TexDesc.Format, TexDesc.BindFlags);
     if (Format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB && (Desc.Flags & D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS))
         Desc.Format = DXGI_FORMAT_R8G8B8A8_TYPELESS;
     else
         Desc.Format = Format;
 
-    Desc.Height             = UINT{m_Desc.Height};
+    Desc.Height             = UINT{TexDesc.Height};
     Desc.Layout             = D3D12_TEXTURE_LAYOUT_UNKNOWN;
-    Desc.MipLevels          = StaticCast<UINT16>(m_Desc.MipLevels);
-    Desc.SampleDesc.Count   = m_Desc.SampleCount;
+    Desc.MipLevels          = StaticCast<UINT16>(TexDesc.MipLevels);
+    Desc.SampleDesc.Count   = TexDesc.SampleCount;
     Desc.SampleDesc.Quality = 0;
-    Desc.Width              = UINT64{m_Desc.Width};
+    Desc.Width              = UINT64{TexDesc.Width};
 
     return Desc;
 }
 
+D3D12_RESOURCE_DESC TextureD3D12Impl::GetD3D12TextureDesc() const
+{
+    return TextureDescToD3D12ResourceDesc(m_Desc);
+}
+
 TextureD3D12Impl::TextureD3D12Impl(IReferenceCounters*        pRefCounters,
                                    FixedBlockMemoryAllocator& TexViewObjAllocator,
                                    RenderDeviceD3D12Impl*     pRenderDeviceD3D12,
@@ -139,6 +145,8 @@ TextureD3D12Impl::TextureD3D12Impl(IReferenceCounters*        pRefCounters,
     if (m_Desc.Usage == USAGE_IMMUTABLE && (pInitData == nullptr || pInitData->pSubResources == nullptr))
         LOG_ERROR_AND_THROW("Immutable textures must be initialized with data at creation time: pInitData can't be null");
 
+    ValidateTextureInitData(m_Desc, pInitData);
+
     if ((m_Desc.MiscFlags & MISC_TEXTURE_FLAG_GENERATE_MIPS) != 0)
     {
         if (m_Desc.Type != RESOURCE_DIM_TEX_2D && m_Desc.Type != RESOURCE_DIM_TEX_2D_ARRAY)
@@ -230,18 +238,42 @@ TextureD3D12Impl::TextureD3D12Impl(IReferenceCounters*        pRefCounters,
 
         const auto d3d12State = ResourceStateFlagsToD3D12ResourceStates(InitialState) & d3d12StateMask;
 
-        // By default, committed resources and heaps are almost always zeroed upon creation.
-        // CREATE_NOT_ZEROED flag allows this to be elided in some scenarios to lower the overhead
-        // of creating the heap. No need to zero the resource if we initialize it.
-        const auto d3d12HeapFlags = bInitializeTexture ?
-            D3D12_HEAP_FLAG_CREATE_NOT_ZEROED :
-            D3D12_HEAP_FLAG_NONE;
+        const bool IsPlaced = pInitData != nullptr && pInitData->pMemory != nullptr;
+        if (IsPlaced)
+        {
+            // Create the texture in the heap of the device memory object. The memory may be shared by other
+            // placed resources, so the texture must be activated with an aliasing barrier before it is used.
+            const auto d3d12AllocInfo = pd3d12Device->GetResourceAllocationInfo(0, 1, &d3d12TexDesc);
 
-        auto hr = pd3d12Device->CreateCommittedResource(
-            &HeapProps, d3d12HeapFlags, &d3d12TexDesc, d3d12State, pClearValue, __uuidof(m_pd3d12Resource),
-            reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
-        if (FAILED(hr))
-            LOG_ERROR_AND_THROW("Failed to create D3D12 texture");
+            m_pMemory = pInitData->pMemory;
+
+            const auto MemRange = m_pMemory.RawPtr<DeviceMemoryD3D12Impl>()->GetRange(pInitData->MemoryOffset, d3d12AllocInfo.SizeInBytes);
+            if (MemRange.pHandle == nullptr)
+                LOG_ERROR_AND_THROW("Memory range [", pInitData->MemoryOffset, ", ", pInitData->MemoryOffset + d3d12AllocInfo.SizeInBytes, ") is not a valid range of the device memory");
+            if ((MemRange.Offset % d3d12AllocInfo.Alignment) != 0)
+                LOG_ERROR_AND_THROW("Memory offset (", pInitData->MemoryOffset, ") is not a multiple of the required alignment (", d3d12AllocInfo.Alignment, ")");
+
+            auto hr = pd3d12Device->CreatePlacedResource(
+                MemRange.pHandle, MemRange.Offset, &d3d12TexDesc, d3d12State, pClearValue, __uuidof(m_pd3d12Resource),
+                reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
+            if (FAILED(hr))
+                LOG_ERROR_AND_THROW("Failed to create placed D3D12 texture");
+        }
+        else
+        {
+            // By default, committed resources and heaps are almost always zeroed upon creation.
+            // CREATE_NOT_ZEROED flag allows this to be elided in some scenarios to lower the overhead
+            // of creating the heap. No need to zero the resource if we initialize it.
+            const auto d3d12HeapFlags = bInitializeTexture ?
+                D3D12_HEAP_FLAG_CREATE_NOT_ZEROED :
+                D3D12_HEAP_FLAG_NONE;
+
+            auto hr = pd3d12Device->CreateCommittedResource(
+                &HeapProps, d3d12HeapFlags, &d3d12TexDesc, d3d12State, pClearValue, __uuidof(m_pd3d12Resource),
+                reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
+            if (FAILED(hr))
+                LOG_ERROR_AND_THROW("Failed to create D3D12 texture");
+        }
 
         if (*m_Desc.Name != 0)
             m_pd3d12Resource->SetName(WidenString(m_Desc.Name).c_str());
@@ -285,7 +317,6 @@ TextureD3D12Impl::TextureD3D12Impl(IReferenceCounters*        pRefCounters,
             if (FAILED(hr))
                 LOG_ERROR_AND_THROW("Failed to create committed resource in an upload heap");
 
-            auto InitContext = pRenderDeviceD3D12->AllocateCommandContext(CmdQueueInd);
             // copy data to the intermediate upload heap and then schedule a copy from the upload heap to the default texture
             VERIFY_EXPR(CheckState(RESOURCE_STATE_COPY_DEST));
             std::vector<D3D12_SUBRESOURCE_DATA, STDAllocatorRawMem<D3D12_SUBRESOURCE_DATA>> D3D12SubResData(pInitData->NumSubresources, D3D12_SUBRESOURCE_DATA(), STD_ALLOCATOR_RAW_MEM(D3D12_SUBRESOURCE_DATA, GetRawAllocator(), "Allocator for vector<D3D12_SUBRESOURCE_DATA>"));
@@ -295,8 +326,6 @@ TextureD3D12Impl::TextureD3D12Impl(IReferenceCounters*        pRefCounters,
                 D3D12SubResData[subres].RowPitch   = static_cast<LONG_PTR>(pInitData->pSubResources[subres].Stride);
                 D3D12SubResData[subres].SlicePitch = static_cast<LONG_PTR>(pInitData->pSubResources[subres].DepthStride);
             }
-            auto UploadedSize = UpdateSubresources(InitContext->GetCommandList(), m_pd3d12Resource, UploadBuffer, 0, 0, pInitData->NumSubresources, D3D12SubResData.data());
-            VERIFY(UploadedSize == uploadBufferSize, "Incorrect uploaded data size (", UploadedSize, "). ", uploadBufferSize, " is expected");
 
             // Command list fence should only be signaled when submitting cmd list
             // from the immediate context, otherwise the basic requirement will be violated
@@ -316,16 +345,33 @@ TextureD3D12Impl::TextureD3D12Impl(IReferenceCounters*        pRefCounters,
             //                  |     N+1, but resource it references    |                                   |
             //                  |     was added to the delete queue      |                                   |
             //                  |     with value N                       |                                   |
-            pRenderDeviceD3D12->CloseAndExecuteTransientCommandContext(CmdQueueInd, std::move(InitContext));
+            //
+            // The copy may be batched with the copies of other resources, see EngineD3D12CreateInfo::InitialDataBatchSize.
+            pRenderDeviceD3D12->RecordInitialDataCopy(CmdQueueInd, uploadBufferSize,
+                                                      [&](CommandContext& InitContext) {
+                                                          auto UploadedSize = UpdateSubresources(InitContext.GetCommandList(), m_pd3d12Resource, UploadBuffer, 0, 0, pInitData->NumSubresources, D3D12SubResData.data());
+                                                          VERIFY(UploadedSize == uploadBufferSize, "Incorrect uploaded data size (", UploadedSize, "). ", uploadBufferSize, " is expected");
+                                                      });
 
             // We MUST NOT call TransitionResource() from here, because
             // it will call AddRef() and potentially Release(), while
             // the object is not constructed yet
             // Add reference to the object to the release queue to keep it alive
             // until copy operation is complete.  This must be done after
-            // submitting command list for execution!
+            // recording the copy command! The batched copies are always
+            // submitted before the stale resources of the queue are discarded.
             pRenderDeviceD3D12->SafeReleaseDeviceObject(std::move(UploadBuffer), Uint64{1} << CmdQueueInd);
         }
+
+        // The residency of placed textures is defined by the heap they are placed in
+        if (!IsPlaced)
+        {
+            // Render targets, depth buffers and UAVs are typically used every frame and are never evicted
+            if ((m_Desc.BindFlags & (BIND_RENDER_TARGET | BIND_DEPTH_STENCIL | BIND_UNORDERED_ACCESS)) != 0)
+                D3D12ResidencyManager::SetHighResidencyPriority(pd3d12Device, m_pd3d12Resource);
+            else if (auto* pResidencyMgr = pRenderDeviceD3D12->GetResidencyManager())
+                pResidencyMgr->RegisterResource(*this);
+        }
     }
     else if (m_Desc.Usage == USAGE_STAGING)
     {
@@ -621,6 +667,8 @@ void TextureD3D12Impl::CreateViewInternal(const TextureViewDesc& ViewDesc, IText
 
 TextureD3D12Impl::~TextureD3D12Impl()
 {
+    if (auto* pResidencyMgr = GetDevice()->GetResidencyManager())
+        pResidencyMgr->UnregisterResource(*this);
     // D3D12 object can only be destroyed when it is no longer used by the GPU
     GetDevice()->SafeReleaseDeviceObject(std::move(m_pd3d12Resource), m_Desc.ImmediateContextMask);
     if (m_StagingFootprints != nullptr)
@@ -216,6 +216,7 @@ public:
             Features.TileShaders                   = DEVICE_FEATURE_STATE_DISABLED;
             Features.SubpassFramebufferFetch       = DEVICE_FEATURE_STATE_DISABLED;
             Features.TextureComponentSwizzle       = DEVICE_FEATURE_STATE_DISABLED;
+            Features.ExtendedDynamicState          = DEVICE_FEATURE_STATE_DISABLED;
         }
 
         // Set memory properties
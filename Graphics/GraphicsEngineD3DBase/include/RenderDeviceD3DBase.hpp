@@ -31,7 +31,7 @@
 /// Implementation of the Diligent::RenderDeviceBase template class and related structures
 
 #include "WinHPreface.h"
-#include <dxgi.h>
+#include <dxgi1_4.h>
 #include "WinHPostface.h"
 
 #include "RenderDeviceBase.hpp"
@@ -215,8 +215,43 @@ protected:
         return Info;
     }
 
+    /// Implementation of IRenderDevice::GetMemoryBudget() in Direct3D11 and Direct3D12 backends.
+    virtual DeviceMemoryBudget DILIGENT_CALL_TYPE GetMemoryBudget() const override final
+    {
+        DeviceMemoryBudget Budget;
+        if (!m_pDXGIAdapter3)
+            return Budget;
+
+        const auto QuerySegmentGroup = [this](DXGI_MEMORY_SEGMENT_GROUP SegmentGroup, MemoryHeapBudget& Heap) {
+            DXGI_QUERY_VIDEO_MEMORY_INFO Info{};
+            if (SUCCEEDED(m_pDXGIAdapter3->QueryVideoMemoryInfo(0, SegmentGroup, &Info)))
+            {
+                Heap.Budget = Info.Budget;
+                Heap.Usage  = Info.CurrentUsage;
+            }
+        };
+        QuerySegmentGroup(DXGI_MEMORY_SEGMENT_GROUP_LOCAL, Budget.Local);
+        QuerySegmentGroup(DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL, Budget.NonLocal);
+
+        return Budget;
+    }
+
+protected:
+    /// Initializes the adapter interface that is used to query the memory budget.
+    /// IDXGIAdapter3 is only available on Windows 10, so the budget is not reported on earlier versions.
+    void InitDXGIAdapter(IDXGIAdapter* pDXGIAdapter)
+    {
+        if (pDXGIAdapter == nullptr)
+            return;
+
+        if (FAILED(pDXGIAdapter->QueryInterface(__uuidof(m_pDXGIAdapter3), reinterpret_cast<void**>(static_cast<IDXGIAdapter3**>(&m_pDXGIAdapter3)))))
+            LOG_INFO_MESSAGE("IDXGIAdapter3 interface is not supported: device memory budget will not be available");
+    }
+
 protected:
     NVApiLoader m_NVApi;
+
+    CComPtr<IDXGIAdapter3> m_pDXGIAdapter3;
 };
 
 } // namespace Diligent
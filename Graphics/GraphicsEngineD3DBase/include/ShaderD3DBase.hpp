@@ -32,6 +32,8 @@
 #include "WinHPostface.h"
 
 #include "Shader.h"
+#include "DataBlob.h"
+#include "RefCntAutoPtr.hpp"
 
 /// \file
 /// Base implementation of a D3D shader
@@ -39,12 +41,32 @@
 namespace Diligent
 {
 
+class ShaderResources;
+
 /// Base implementation of a D3D shader
 class ShaderD3DBase
 {
 public:
     ShaderD3DBase(const ShaderCreateInfo& ShaderCI, ShaderVersion ShaderModel, class IDXCompiler* DxCompiler);
 
+    // The byte code container that holds the serialized shader resources followed by the D3D byte code,
+    // see IShaderD3D::GetBytecodeWithResources().
+    static constexpr Uint32 BytecodeWithResourcesMagic   = 0x52444C44; // "DLDR"
+    static constexpr Uint32 BytecodeWithResourcesVersion = 1;
+
+    // Packs the byte code and the serialized resources into the container.
+    // If pResources is null, returns the copy of the byte code.
+    static RefCntAutoPtr<IDataBlob> PackBytecodeWithResources(ID3DBlob* pBytecode, const ShaderResources* pResources);
+
+    // If pData is the byte code container, returns true and sets pBytecode and pResources to the
+    // D3D byte code and the serialized resources. Otherwise, returns false and leaves the outputs unchanged.
+    static bool UnpackBytecodeWithResources(const void*  pData,
+                                            size_t       DataSize,
+                                            const void*& pBytecode,
+                                            size_t&      BytecodeSize,
+                                            const void*& pResources,
+                                            size_t&      ResourcesSize) noexcept(false);
+
     void GetBytecode(const void** ppBytecode,
                      Uint64&      Size) const
     {
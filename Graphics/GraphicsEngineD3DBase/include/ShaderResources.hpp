@@ -57,6 +57,7 @@
 //
 
 #include <memory>
+#include <vector>
 
 #include "WinHPreface.h"
 #include <d3dcommon.h>
@@ -70,6 +71,7 @@
 #include "STDAllocator.hpp"
 #include "HashUtils.hpp"
 #include "StringPool.hpp"
+#include "Serializer.hpp"
 #include "D3DShaderResourceLoader.hpp"
 #include "PipelineState.h"
 #include "D3DCommonTypeConversions.hpp"
@@ -432,6 +434,11 @@ public:
         Minor = (m_ShaderVersion & 0x0000000F);
     }
 
+    // Serializes the resources, so that they can later be loaded without the shader reflection.
+    // Constant buffer reflection is not serialized. Combined samplers are assigned when the resources are loaded.
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser) const;
+
 protected:
     template <typename TD3DReflectionTraits,
               typename TShaderReflection,
@@ -442,6 +449,13 @@ protected:
                     const Char*         SamplerSuffix,
                     bool                LoadConstantBufferReflection);
 
+    // Initializes the resources from the data written by Serialize()
+    template <typename TNewResourceHandler>
+    void Initialize(Serializer<SerializerMode::Read>& Ser,
+                    TNewResourceHandler               NewResHandler,
+                    const Char*                       ShaderName,
+                    const Char*                       SamplerSuffix) noexcept(false);
+
 
     __forceinline D3DShaderResourceAttribs& GetResAttribs(Uint32 n, Uint32 NumResources, Uint32 Offset) noexcept
     {
@@ -468,6 +482,21 @@ protected:
     // clang-format on
 
 private:
+    template <typename TLoadResources,
+              typename TNewResourceHandler>
+    void InitializeImpl(TLoadResources      LoadResources,
+                        TNewResourceHandler NewResHandler,
+                        const Char*         ShaderName,
+                        const Char*         SamplerSuffix,
+                        bool                LoadConstantBufferReflection);
+
+    // Reads the resources written by Serialize(). Resource names point to the serialized data.
+    static bool DeserializeResources(Serializer<SerializerMode::Read>&      Ser,
+                                     Uint32&                                ShaderVersion,
+                                     D3DShaderResourceCounters&             ResCounters,
+                                     std::vector<D3DShaderResourceAttribs>& Resources,
+                                     size_t&                                ResourceNamesPoolSize);
+
     void AllocateMemory(IMemoryAllocator&                Allocator,
                         const D3DShaderResourceCounters& ResCounters,
                         size_t                           ResourceNamesPoolSize,
@@ -510,8 +539,98 @@ void ShaderResources::Initialize(TShaderReflection*  pShaderReflection,
                                  const Char*         CombinedSamplerSuffix,
                                  bool                LoadConstantBufferReflection)
 {
-    using D3D_SHADER_DESC = TD3DReflectionTraits::D3D_SHADER_DESC;
+    InitializeImpl(
+        [&](auto&&... Handlers) //
+        {
+            LoadD3DShaderResources<TD3DReflectionTraits>(pShaderReflection, LoadConstantBufferReflection, std::forward<decltype(Handlers)>(Handlers)...);
+        },
+        std::move(NewResHandler),
+        ShaderName,
+        CombinedSamplerSuffix,
+        LoadConstantBufferReflection);
+}
+
+template <typename TNewResourceHandler>
+void ShaderResources::Initialize(Serializer<SerializerMode::Read>& Ser,
+                                 TNewResourceHandler               NewResHandler,
+                                 const Char*                       ShaderName,
+                                 const Char*                       CombinedSamplerSuffix) noexcept(false)
+{
+    Uint32                                ShaderVersion = 0;
+    D3DShaderResourceCounters             ResCounters;
+    std::vector<D3DShaderResourceAttribs> Resources;
+    size_t                                ResourceNamesPoolSize = 0;
+    // Read all resources before the memory is allocated, so that corrupted data is detected early
+    if (!DeserializeResources(Ser, ShaderVersion, ResCounters, Resources, ResourceNamesPoolSize))
+        LOG_ERROR_AND_THROW("Failed to load serialized resources of shader '", ShaderName, "'");
+
+    InitializeImpl(
+        [&](auto HandleShaderDesc,
+            auto OnResourcesCounted,
+            auto OnNewCB,
+            auto OnNewTexUAV,
+            auto OnNewBuffUAV,
+            auto OnNewBuffSRV,
+            auto OnNewSampler,
+            auto OnNewTexSRV,
+            auto OnNewAccelStruct) //
+        {
+            struct
+            {
+                Uint32 Version;
+            } ShaderDesc{ShaderVersion};
+            HandleShaderDesc(ShaderDesc);
+
+            OnResourcesCounted(ResCounters, ResourceNamesPoolSize);
+
+            // Resources are serialized in the order of the resource table:
+            // | CBs | TexSRVs | TexUAVs | BufSRVs | BufUAVs | Samplers | AccelStructs |
+            Uint32 Offset = 0;
+
+            auto GetRange = [&](Uint32 Count) {
+                const auto* pBegin = Resources.data() + Offset;
+                Offset += Count;
+                return std::make_pair(pBegin, pBegin + Count);
+            };
+            const auto CBs          = GetRange(ResCounters.NumCBs);
+            const auto TexSRVs      = GetRange(ResCounters.NumTexSRVs);
+            const auto TexUAVs      = GetRange(ResCounters.NumTexUAVs);
+            const auto BufSRVs      = GetRange(ResCounters.NumBufSRVs);
+            const auto BufUAVs      = GetRange(ResCounters.NumBufUAVs);
+            const auto Samplers     = GetRange(ResCounters.NumSamplers);
+            const auto AccelStructs = GetRange(ResCounters.NumAccelStructs);
+            VERIFY_EXPR(Offset == Resources.size());
+
+            for (auto* pRes = CBs.first; pRes != CBs.second; ++pRes)
+                OnNewCB(*pRes, ShaderCodeBufferDescX{});
+            for (auto* pRes = TexUAVs.first; pRes != TexUAVs.second; ++pRes)
+                OnNewTexUAV(*pRes);
+            for (auto* pRes = BufUAVs.first; pRes != BufUAVs.second; ++pRes)
+                OnNewBuffUAV(*pRes);
+            for (auto* pRes = BufSRVs.first; pRes != BufSRVs.second; ++pRes)
+                OnNewBuffSRV(*pRes);
+            // All samplers must be initialized before texture SRVs
+            for (auto* pRes = Samplers.first; pRes != Samplers.second; ++pRes)
+                OnNewSampler(*pRes);
+            for (auto* pRes = TexSRVs.first; pRes != TexSRVs.second; ++pRes)
+                OnNewTexSRV(*pRes);
+            for (auto* pRes = AccelStructs.first; pRes != AccelStructs.second; ++pRes)
+                OnNewAccelStruct(*pRes);
+        },
+        std::move(NewResHandler),
+        ShaderName,
+        CombinedSamplerSuffix,
+        false);
+}
 
+template <typename TLoadResources,
+          typename TNewResourceHandler>
+void ShaderResources::InitializeImpl(TLoadResources      LoadResources,
+                                     TNewResourceHandler NewResHandler,
+                                     const Char*         ShaderName,
+                                     const Char*         CombinedSamplerSuffix,
+                                     bool                LoadConstantBufferReflection)
+{
     Uint32 CurrCB = 0, CurrTexSRV = 0, CurrTexUAV = 0, CurrBufSRV = 0, CurrBufUAV = 0, CurrSampler = 0, CurrAS = 0;
 
     // Resource names pool is only needed to facilitate string allocation.
@@ -520,10 +639,8 @@ void ShaderResources::Initialize(TShaderReflection*  pShaderReflection,
     // Constant buffer reflections
     std::vector<ShaderCodeBufferDescX> CBReflections;
 
-    LoadD3DShaderResources<TD3DReflectionTraits>(
-        pShaderReflection, LoadConstantBufferReflection,
-
-        [&](const D3D_SHADER_DESC& d3dShaderDesc) //
+    LoadResources(
+        [&](const auto& d3dShaderDesc) //
         {
             m_ShaderVersion = d3dShaderDesc.Version;
         },
@@ -277,7 +277,7 @@ protected:
         }
     }
 
-    void WaitForFrame()
+    void WaitForFrameLatencyObject()
     {
         // https://docs.microsoft.com/en-us/windows/uwp/gaming/reduce-latency-with-dxgi-1-3-swap-chains#step-4-wait-before-rendering-each-frame
         if (m_FrameLatencyWaitableObject != NULL)
@@ -295,6 +295,14 @@ protected:
         }
     }
 
+    virtual void DILIGENT_CALL_TYPE WaitForFrame() override final
+    {
+        // In the low-latency mode, the application waits for the frame right before
+        // it samples the input, and Present() does not block.
+        if (m_SwapChainDesc.LowLatencyMode)
+            WaitForFrameLatencyObject();
+    }
+
     virtual void DILIGENT_CALL_TYPE SetFullscreenMode(const DisplayModeAttribs& DisplayMode) override final
     {
         if (m_pSwapChain)
@@ -68,6 +68,26 @@ DILIGENT_BEGIN_INTERFACE(IShaderD3D, IShader)
     VIRTUAL void METHOD(GetHLSLResource)(THIS_
                                          Uint32                     Index,
                                          HLSLShaderResourceDesc REF ResourceDesc) CONST PURE;
+
+    /// Returns the shader byte code packed together with the serialized shader resources.
+
+    /// \param [out] ppBytecode - Address of the memory location where a pointer to the
+    ///                           data blob will be written.
+    ///                           The function calls AddRef(), so that the new object will have
+    ///                           one reference.
+    ///
+    /// \remarks    When the data is passed to ShaderCreateInfo::ByteCode, the shader resources
+    ///             are loaded from the data and the Direct3D shader reflection is not used, which
+    ///             makes the shader creation considerably faster. This is the data that should
+    ///             be stored in the byte code cache (see IBytecodeCache).
+    ///
+    ///             Constant buffer reflection is not serialized. If ShaderCreateInfo::LoadConstantBufferReflection
+    ///             is true, the shader reflection is used as usual.
+    ///
+    ///             If the shader was created with SHADER_COMPILE_FLAG_SKIP_REFLECTION, the data contains
+    ///             the byte code only.
+    VIRTUAL void METHOD(GetBytecodeWithResources)(THIS_
+                                                  IDataBlob** ppBytecode) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -77,7 +97,8 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IShaderD3D_GetHLSLResource(This, ...) CALL_IFACE_METHOD(ShaderD3D, GetHLSLResource, This, __VA_ARGS__)
+#    define IShaderD3D_GetHLSLResource(This, ...)          CALL_IFACE_METHOD(ShaderD3D, GetHLSLResource,          This, __VA_ARGS__)
+#    define IShaderD3D_GetBytecodeWithResources(This, ...) CALL_IFACE_METHOD(ShaderD3D, GetBytecodeWithResources, This, __VA_ARGS__)
 
 // clang-format on
 
@@ -38,8 +38,11 @@
 
 #include "D3DErrors.hpp"
 #include "DataBlobImpl.hpp"
+#include "ExternalDataBlob.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "ShaderD3DBase.hpp"
+#include "ShaderResources.hpp"
+#include "Serializer.hpp"
 #include "DXCompiler.hpp"
 #include "HLSLUtils.hpp"
 #include "BasicMath.hpp"
@@ -182,8 +185,17 @@ ShaderD3DBase::ShaderD3DBase(const ShaderCreateInfo& ShaderCI, const ShaderVersi
     else if (ShaderCI.ByteCode)
     {
         DEV_CHECK_ERR(ShaderCI.ByteCodeSize != 0, "ByteCode size must be greater than 0");
-        CHECK_D3D_RESULT_THROW(D3DCreateBlob(ShaderCI.ByteCodeSize, &m_pShaderByteCode), "Failed to create D3D blob");
-        memcpy(m_pShaderByteCode->GetBufferPointer(), ShaderCI.ByteCode, ShaderCI.ByteCodeSize);
+
+        const void* pBytecode    = ShaderCI.ByteCode;
+        size_t      BytecodeSize = ShaderCI.ByteCodeSize;
+        // The byte code may be packed together with the serialized shader resources,
+        // which are loaded by the backend-specific shader implementation.
+        const void* pResources    = nullptr;
+        size_t      ResourcesSize = 0;
+        UnpackBytecodeWithResources(ShaderCI.ByteCode, ShaderCI.ByteCodeSize, pBytecode, BytecodeSize, pResources, ResourcesSize);
+
+        CHECK_D3D_RESULT_THROW(D3DCreateBlob(BytecodeSize, &m_pShaderByteCode), "Failed to create D3D blob");
+        memcpy(m_pShaderByteCode->GetBufferPointer(), pBytecode, BytecodeSize);
     }
     else
     {
@@ -191,4 +203,81 @@ ShaderD3DBase::ShaderD3DBase(const ShaderCreateInfo& ShaderCI, const ShaderVersi
     }
 }
 
+RefCntAutoPtr<IDataBlob> ShaderD3DBase::PackBytecodeWithResources(ID3DBlob* pBytecode, const ShaderResources* pResources)
+{
+    VERIFY_EXPR(pBytecode != nullptr);
+    if (pResources == nullptr)
+    {
+        // Reference the compiler-owned bytecode without copying it
+        CComPtr<ID3DBlob> pBlob{pBytecode};
+        return RefCntAutoPtr<IDataBlob>{ExternalDataBlob::Create(pBytecode->GetBufferPointer(), pBytecode->GetBufferSize(),
+                                                                 [pBlob]() mutable { pBlob.Release(); })};
+    }
+
+    Serializer<SerializerMode::Measure> ResMeasureSer;
+    pResources->Serialize(ResMeasureSer);
+
+    SerializedData ResData = ResMeasureSer.AllocateData(GetRawAllocator());
+    {
+        Serializer<SerializerMode::Write> ResSer{ResData};
+        pResources->Serialize(ResSer);
+        VERIFY_EXPR(ResSer.IsEnded());
+    }
+
+    const void*  pBytecodeData = pBytecode->GetBufferPointer();
+    const size_t BytecodeSize  = pBytecode->GetBufferSize();
+
+    auto SerializeContainer = [&](auto& Ser) {
+        constexpr Uint32 Magic   = BytecodeWithResourcesMagic;
+        constexpr Uint32 Version = BytecodeWithResourcesVersion;
+        return Ser(Magic, Version) && Ser.Serialize(ResData) && Ser.SerializeBytes(pBytecodeData, BytecodeSize);
+    };
+
+    Serializer<SerializerMode::Measure> MeasureSer;
+    SerializeContainer(MeasureSer);
+
+    auto pContainer = DataBlobImpl::Create(MeasureSer.GetSize());
+
+    Serializer<SerializerMode::Write> Ser{SerializedData{pContainer->GetDataPtr(), pContainer->GetSize()}};
+    SerializeContainer(Ser);
+    VERIFY_EXPR(Ser.IsEnded());
+
+    return RefCntAutoPtr<IDataBlob>{pContainer};
+}
+
+bool ShaderD3DBase::UnpackBytecodeWithResources(const void*  pData,
+                                                size_t       DataSize,
+                                                const void*& pBytecode,
+                                                size_t&      BytecodeSize,
+                                                const void*& pResources,
+                                                size_t&      ResourcesSize) noexcept(false)
+{
+    if (pData == nullptr || DataSize < sizeof(Uint32) * 2)
+        return false;
+
+    Serializer<SerializerMode::Read> Ser{SerializedData{const_cast<void*>(pData), DataSize}};
+
+    Uint32 Magic   = 0;
+    Uint32 Version = 0;
+    Ser(Magic, Version);
+    if (Magic != BytecodeWithResourcesMagic)
+        return false;
+
+    if (Version != BytecodeWithResourcesVersion)
+        LOG_ERROR_AND_THROW("Byte code with resources version (", Version, ") is not supported. Expected version: ", BytecodeWithResourcesVersion);
+
+    const void* pResData     = nullptr;
+    size_t      ResDataSize  = 0;
+    const void* pCodeData    = nullptr;
+    size_t      CodeDataSize = 0;
+    if (!Ser.SerializeBytes(pResData, ResDataSize) || !Ser.SerializeBytes(pCodeData, CodeDataSize) || CodeDataSize == 0)
+        LOG_ERROR_AND_THROW("Byte code with resources is corrupted");
+
+    pResources    = pResData;
+    ResourcesSize = ResDataSize;
+    pBytecode     = pCodeData;
+    BytecodeSize  = CodeDataSize;
+    return true;
+}
+
 } // namespace Diligent
@@ -401,4 +401,126 @@ size_t ShaderResources::GetHash() const
     return hash;
 }
 
+template <SerializerMode Mode>
+bool ShaderResources::Serialize(Serializer<Mode>& Ser) const
+{
+    static_assert(Mode == SerializerMode::Write || Mode == SerializerMode::Measure, "Only Write and Measure modes are supported");
+
+    const Uint32 NumCBs          = GetNumCBs();
+    const Uint32 NumTexSRVs      = GetNumTexSRV();
+    const Uint32 NumTexUAVs      = GetNumTexUAV();
+    const Uint32 NumBufSRVs      = GetNumBufSRV();
+    const Uint32 NumBufUAVs      = GetNumBufUAV();
+    const Uint32 NumSamplers     = GetNumSamplers();
+    const Uint32 NumAccelStructs = GetNumAccelStructs();
+    if (!Ser(m_ShaderVersion, NumCBs, NumTexSRVs, NumTexUAVs, NumBufSRVs, NumBufUAVs, NumSamplers, NumAccelStructs))
+        return false;
+
+    // Resources are written in the order of the resource table
+    for (Uint32 n = 0; n < m_TotalResources; ++n)
+    {
+        const auto& Res = GetResAttribs(n, m_TotalResources, 0);
+
+        const Uint8 InputType    = static_cast<Uint8>(Res.GetInputType());
+        const Uint8 SRVDimension = static_cast<Uint8>(Res.GetSRVDimension());
+        if (!Ser(Res.Name, Res.BindPoint, Res.BindCount, Res.Space, InputType, SRVDimension))
+            return false;
+    }
+
+    return true;
+}
+
+template bool ShaderResources::Serialize<SerializerMode::Write>(Serializer<SerializerMode::Write>& Ser) const;
+template bool ShaderResources::Serialize<SerializerMode::Measure>(Serializer<SerializerMode::Measure>& Ser) const;
+
+// Returns the index of the resource table section the resource belongs to:
+// | CBs | TexSRVs | TexUAVs | BufSRVs | BufUAVs | Samplers | AccelStructs |
+static Uint32 GetResourceTableSection(Uint32 InputType, Uint32 SRVDimension)
+{
+    switch (InputType)
+    {
+        // clang-format off
+        case D3D_SIT_CBUFFER:                 return 0;
+        case D3D_SIT_TEXTURE:                 return SRVDimension == D3D_SRV_DIMENSION_BUFFER ? 3 : 1;
+        case D3D_SIT_UAV_RWTYPED:             return SRVDimension == D3D_SRV_DIMENSION_BUFFER ? 4 : 2;
+        case D3D_SIT_STRUCTURED:              return 3;
+        case D3D_SIT_BYTEADDRESS:             return 3;
+        case D3D_SIT_UAV_RWSTRUCTURED:        return 4;
+        case D3D_SIT_UAV_RWBYTEADDRESS:       return 4;
+        case D3D_SIT_SAMPLER:                 return 5;
+        case D3D_SIT_RTACCELERATIONSTRUCTURE: return 6;
+        default:                              return ~0u;
+            // clang-format on
+    }
+}
+
+bool ShaderResources::DeserializeResources(Serializer<SerializerMode::Read>&      Ser,
+                                           Uint32&                                ShaderVersion,
+                                           D3DShaderResourceCounters&             ResCounters,
+                                           std::vector<D3DShaderResourceAttribs>& Resources,
+                                           size_t&                                ResourceNamesPoolSize)
+{
+    if (!Ser(ShaderVersion,
+             ResCounters.NumCBs,
+             ResCounters.NumTexSRVs,
+             ResCounters.NumTexUAVs,
+             ResCounters.NumBufSRVs,
+             ResCounters.NumBufUAVs,
+             ResCounters.NumSamplers,
+             ResCounters.NumAccelStructs))
+        return false;
+
+    const Uint32 SectionSizes[] = {
+        ResCounters.NumCBs,
+        ResCounters.NumTexSRVs,
+        ResCounters.NumTexUAVs,
+        ResCounters.NumBufSRVs,
+        ResCounters.NumBufUAVs,
+        ResCounters.NumSamplers,
+        ResCounters.NumAccelStructs,
+    };
+
+    Uint64 TotalResources = 0;
+    for (auto Size : SectionSizes)
+        TotalResources += Size;
+    // Every serialized resource takes at least 20 bytes
+    if (TotalResources > std::numeric_limits<OffsetType>::max() || TotalResources * 20 > Ser.GetRemainingSize())
+        return false;
+
+    Resources.clear();
+    Resources.reserve(static_cast<size_t>(TotalResources));
+    ResourceNamesPoolSize = 0;
+
+    Uint32 Section    = 0;
+    Uint32 SectionEnd = SectionSizes[0];
+    for (Uint32 n = 0; n < TotalResources; ++n)
+    {
+        while (n == SectionEnd)
+            SectionEnd += SectionSizes[++Section];
+
+        const char* Name         = nullptr;
+        Uint32      BindPoint    = 0;
+        Uint32      BindCount    = 0;
+        Uint32      Space        = 0;
+        Uint8       InputType    = 0;
+        Uint8       SRVDimension = 0;
+        if (!Ser(Name, BindPoint, BindCount, Space, InputType, SRVDimension))
+            return false;
+
+        if (*Name == '\0' ||
+            InputType >= (1u << D3DShaderResourceAttribs::ShaderInputTypeBits) ||
+            SRVDimension >= (1u << D3DShaderResourceAttribs::SRVDimBits) ||
+            GetResourceTableSection(InputType, SRVDimension) != Section)
+            return false;
+
+        Resources.emplace_back(Name, BindPoint, BindCount, Space,
+                               static_cast<D3D_SHADER_INPUT_TYPE>(InputType),
+                               static_cast<D3D_SRV_DIMENSION>(SRVDimension),
+                               D3DShaderResourceAttribs::InvalidSamplerId);
+        ResourceNamesPoolSize += strlen(Name) + 1;
+    }
+
+    return true;
+}
+
 } // namespace Diligent
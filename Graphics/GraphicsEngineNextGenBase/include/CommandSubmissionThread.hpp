@@ -0,0 +1,217 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::CommandSubmissionThread class
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+#include "BasicTypes.h"
+#include "DebugUtilities.hpp"
+#include "LockFreeQueue.hpp"
+
+namespace Diligent
+{
+
+/// Dedicated thread that submits command buffers to a command queue.
+
+/// Device contexts hand off fully recorded submissions through a lock-free queue and
+/// immediately get the fence value that the submission will signal. The thread executes
+/// the submissions in order while holding the command queue mutex, so recording of the next
+/// command buffer overlaps with the submission of the previous one.
+///
+/// Any other access to the command queue must be enclosed in BeginExclusiveAccess() and
+/// EndExclusiveAccess(). These wait for the pending submissions and block new ones, so that
+/// the fence values produced by the queue always match the values that have been returned.
+template <typename CommandQueueType>
+class CommandSubmissionThread
+{
+public:
+    /// Submits the command buffer to the queue and returns the fence value that the queue has assigned.
+    using SubmitTaskType = std::function<Uint64(CommandQueueType*)>;
+
+    CommandSubmissionThread(CommandQueueType* pQueue, std::mutex& QueueMtx) :
+        m_pQueue{pQueue},
+        m_QueueMtx{QueueMtx}
+    {
+        m_Thread = std::thread{[this]() {
+            ThreadFunc();
+        }};
+    }
+
+    ~CommandSubmissionThread()
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            m_Stop = true;
+        }
+        m_WakeCV.notify_one();
+        m_Thread.join();
+        VERIFY(m_NumPending == 0, "All submissions must have been executed");
+    }
+
+    // clang-format off
+    CommandSubmissionThread           (const CommandSubmissionThread&) = delete;
+    CommandSubmissionThread& operator=(const CommandSubmissionThread&) = delete;
+    CommandSubmissionThread           (CommandSubmissionThread&&)      = delete;
+    CommandSubmissionThread& operator=(CommandSubmissionThread&&)      = delete;
+    // clang-format on
+
+    /// Enqueues the submission and returns the fence value that it will signal.
+
+    /// \param [in] Submit     - Submission task that is executed by the thread.
+    /// \param [in] OnEnqueued - Handler that is called before the task becomes visible to other
+    ///                          submissions, e.g. to assign the command buffer number in the same order.
+    template <typename HandlerType>
+    Uint64 Enqueue(SubmitTaskType&& Submit, HandlerType&& OnEnqueued)
+    {
+        std::unique_lock<std::mutex> Lock{m_Mtx};
+        // Wait while another thread accesses the queue directly or the queue is full.
+        // The fence value must only be assigned once the submission can be pushed, as other
+        // submissions may be enqueued while the mutex is released.
+        m_StateCV.wait(Lock, [this]() { return m_ExclusiveAccessCount == 0 && m_NumPending < MaxPendingSubmissions; });
+
+        const Uint64 FenceValue = GetNextFenceValueInternal();
+
+        // The number of pending submissions includes the one being executed, so there is always room in the queue
+        const auto Pushed = m_Tasks.TryPush(Task{std::move(Submit), FenceValue});
+        VERIFY(Pushed, "The submission queue is full. This should never happen as the number of pending submissions is limited.");
+        (void)Pushed;
+
+        m_LastFenceValue = FenceValue;
+        ++m_NumPending;
+        OnEnqueued();
+
+        Lock.unlock();
+        m_WakeCV.notify_one();
+
+        return FenceValue;
+    }
+
+    /// Waits until all pending submissions are executed and blocks new ones until EndExclusiveAccess() is called.
+
+    /// \note   The method must not be called while the command queue mutex is locked.
+    void BeginExclusiveAccess()
+    {
+        std::unique_lock<std::mutex> Lock{m_Mtx};
+        ++m_ExclusiveAccessCount;
+        m_StateCV.wait(Lock, [this]() { return m_NumPending == 0; });
+    }
+
+    void EndExclusiveAccess()
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            VERIFY(m_ExclusiveAccessCount > 0, "Unbalanced EndExclusiveAccess() call");
+            --m_ExclusiveAccessCount;
+        }
+        m_StateCV.notify_all();
+    }
+
+    /// Returns the fence value that the next submission will signal.
+    Uint64 GetNextFenceValue()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return GetNextFenceValueInternal();
+    }
+
+private:
+    Uint64 GetNextFenceValueInternal() const
+    {
+        // When there are no pending submissions, no other thread may access the queue
+        // while the mutex is locked, so the queue's next fence value is up to date.
+        return m_NumPending == 0 ? m_pQueue->GetNextFenceValue() : m_LastFenceValue + 1;
+    }
+
+    void ThreadFunc()
+    {
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> Lock{m_Mtx};
+                m_WakeCV.wait(Lock, [this]() { return m_NumPending != 0 || m_Stop; });
+                if (m_NumPending == 0)
+                    break;
+            }
+
+            Task CurrTask;
+            while (m_Tasks.TryPop(CurrTask))
+            {
+                Uint64 FenceValue = 0;
+                {
+                    std::lock_guard<std::mutex> QueueLock{m_QueueMtx};
+                    FenceValue = CurrTask.Submit(m_pQueue);
+                }
+                VERIFY(FenceValue == CurrTask.FenceValue, "The submission has signaled fence value ", FenceValue,
+                       " while ", CurrTask.FenceValue, " was expected. This indicates that the command queue has been accessed directly.");
+                (void)FenceValue;
+
+                // Release the resources captured by the task before reporting completion
+                CurrTask = {};
+
+                {
+                    std::lock_guard<std::mutex> Lock{m_Mtx};
+                    VERIFY_EXPR(m_NumPending > 0);
+                    --m_NumPending;
+                }
+                m_StateCV.notify_all();
+            }
+        }
+    }
+
+    struct Task
+    {
+        SubmitTaskType Submit;
+        Uint64         FenceValue = 0;
+    };
+
+    static constexpr size_t MaxPendingSubmissions = 64;
+
+    CommandQueueType* const m_pQueue;
+    std::mutex&             m_QueueMtx;
+
+    Threading::LockFreeQueue<Task> m_Tasks{MaxPendingSubmissions};
+
+    std::mutex              m_Mtx; // Protects the members below
+    std::condition_variable m_WakeCV;
+    std::condition_variable m_StateCV;
+
+    size_t m_NumPending           = 0;
+    Uint64 m_LastFenceValue       = 0;
+    Uint32 m_ExclusiveAccessCount = 0;
+    bool   m_Stop                 = false;
+
+    std::thread m_Thread;
+};
+
+} // namespace Diligent
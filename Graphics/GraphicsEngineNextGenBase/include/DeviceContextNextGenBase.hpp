@@ -95,7 +95,11 @@ protected:
         }
         else
         {
+            auto& ReleaseQueue = this->m_pDevice->GetReleaseQueue(this->GetCommandQueueId());
+            // Stale resources are counted before they are moved into the release queue
+            this->m_FrameStats.StaleResourceCount = static_cast<Uint32>(ReleaseQueue.GetStaleResourceCount());
             this->m_pDevice->FlushStaleResources(this->GetCommandQueueId());
+            this->m_FrameStats.PendingReleaseResourceCount = static_cast<Uint32>(ReleaseQueue.GetPendingReleaseResourceCount());
         }
         TBase::EndFrame();
     }
@@ -34,8 +34,9 @@
 #include <deque>
 #include <vector>
 #include <atomic>
+#include <algorithm>
 #include "VariableSizeAllocationsManager.hpp"
-#include "RingBuffer.hpp"
+#include "ConcurrentRingBuffer.hpp"
 
 namespace Diligent
 {
@@ -51,9 +52,9 @@ namespace DynamicHeap
 class MasterBlockRingBufferBasedManager
 {
 public:
-    using OffsetType                                = RingBuffer::OffsetType;
-    using MasterBlock                               = RingBuffer::OffsetType;
-    static constexpr const OffsetType InvalidOffset = RingBuffer::InvalidOffset;
+    using OffsetType                                = ConcurrentRingBuffer::OffsetType;
+    using MasterBlock                               = ConcurrentRingBuffer::OffsetType;
+    static constexpr const OffsetType InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
 
     MasterBlockRingBufferBasedManager(IMemoryAllocator& Allocator,
                                       Uint32            Size) :
@@ -69,13 +70,13 @@ public:
 
     void DiscardMasterBlocks(std::vector<MasterBlock>& /*Blocks*/, Uint64 FenceValue)
     {
-        std::lock_guard<std::mutex> Lock{m_RingBufferMtx};
+        std::lock_guard<std::mutex> Lock{m_FramesMtx};
         m_RingBuffer.FinishCurrentFrame(FenceValue);
     }
 
     void ReleaseStaleBlocks(Uint64 LastCompletedFenceValue)
     {
-        std::lock_guard<std::mutex> Lock{m_RingBufferMtx};
+        std::lock_guard<std::mutex> Lock{m_FramesMtx};
         m_RingBuffer.ReleaseCompletedFrames(LastCompletedFenceValue);
     }
 
@@ -85,13 +86,14 @@ public:
 protected:
     MasterBlock AllocateMasterBlock(OffsetType SizeInBytes, OffsetType Alignment)
     {
-        std::lock_guard<std::mutex> Lock{m_RingBufferMtx};
+        // Allocation is lock-free and may run concurrently with frame management
         return m_RingBuffer.Allocate(SizeInBytes, Alignment);
     }
 
 private:
-    std::mutex m_RingBufferMtx;
-    RingBuffer m_RingBuffer;
+    // Serializes frame finishing and releasing; allocations do not take the mutex
+    std::mutex           m_FramesMtx;
+    ConcurrentRingBuffer m_RingBuffer;
 };
 
 
@@ -204,6 +206,152 @@ private:
 #endif
 };
 
+
+// Lock-free alternative to MasterBlockListBasedManager that hands out fixed-size pages from a ring
+// shared by all contexts. A page is allocated with a single atomic operation, so contexts do not
+// contend for a mutex, and pages are only as large as a dynamic heap page, so that partially used
+// master blocks of many contexts do not waste space.
+//
+// Similar to MasterBlockRingBufferBasedManager, all contexts share the same frame: FinishFrame() records
+// the pages allocated since the previous call and the fence value that is signaled when the GPU is done
+// with them, and ReleaseCompletedFrames() reclaims them exactly when the fence completes. FinishFrame()
+// must not be called while any context allocates master blocks.
+//
+// The manager uses the same master block type as MasterBlockListBasedManager, so that a dynamic heap
+// can take its blocks from either manager.
+//
+//      Tail (oldest page in use)                      Head (next free page)
+//        |                                               |
+//  [     | Frame N-2 fence | Frame N-1 fence | Frame N    |                          ]
+//
+class MasterBlockLockFreeRingManager
+{
+public:
+    using OffsetType  = VariableSizeAllocationsManager::OffsetType;
+    using MasterBlock = VariableSizeAllocationsManager::Allocation;
+
+    MasterBlockLockFreeRingManager(IMemoryAllocator& Allocator,
+                                   Uint32            Size,
+                                   Uint32            PageSize) :
+        m_PageSize{PageSize},
+        m_NumPages{PageSize != 0 ? Size / PageSize : 0},
+        m_CompletedFrames(STD_ALLOCATOR_RAW_MEM(FrameAttribs, Allocator, "Allocator for deque<FrameAttribs>"))
+    {
+        VERIFY(m_NumPages > 0, "Heap size (", Size, ") must be at least one page (", PageSize, ")");
+        VERIFY(Size % PageSize == 0, "Heap size (", Size, ") must be a multiple of the page size (", PageSize, ")");
+    }
+
+    // clang-format off
+    MasterBlockLockFreeRingManager            (const MasterBlockLockFreeRingManager&)  = delete;
+    MasterBlockLockFreeRingManager            (      MasterBlockLockFreeRingManager&&) = delete;
+    MasterBlockLockFreeRingManager& operator= (const MasterBlockLockFreeRingManager&)  = delete;
+    MasterBlockLockFreeRingManager& operator= (      MasterBlockLockFreeRingManager&&) = delete;
+    // clang-format on
+
+    ~MasterBlockLockFreeRingManager()
+    {
+        DEV_CHECK_ERR(m_Head.load() == m_Tail.load(), m_Head.load() - m_Tail.load(), " page(s) have not been released");
+    }
+
+    // The pages are reclaimed by ReleaseCompletedFrames(), so the blocks are simply dropped.
+    void DiscardMasterBlocks(std::vector<MasterBlock>& Blocks, Uint64 /*FenceValue*/)
+    {
+        Blocks.clear();
+    }
+
+    // Associates all pages allocated since the previous call with FenceValue.
+    void FinishFrame(Uint64 FenceValue)
+    {
+        std::lock_guard<std::mutex> Lock{m_FramesMtx};
+
+        const auto Head = m_Head.load(std::memory_order_acquire);
+        // Ignore empty frames
+        if (Head == m_LastFrameHead)
+            return;
+
+        VERIFY(m_CompletedFrames.empty() || FenceValue >= m_CompletedFrames.back().FenceValue,
+               "Frame fence value (", FenceValue, ") is lower than the fence value of the previous frame (", m_CompletedFrames.back().FenceValue, ")");
+        m_CompletedFrames.emplace_back(FenceValue, Head);
+        m_LastFrameHead = Head;
+    }
+
+    // Reclaims the pages of all frames whose fence value is less than or equal to CompletedFenceValue.
+    void ReleaseCompletedFrames(Uint64 CompletedFenceValue)
+    {
+        std::lock_guard<std::mutex> Lock{m_FramesMtx};
+        while (!m_CompletedFrames.empty() && m_CompletedFrames.front().FenceValue <= CompletedFenceValue)
+        {
+            m_Tail.store(m_CompletedFrames.front().Head, std::memory_order_release);
+            m_CompletedFrames.pop_front();
+        }
+    }
+
+    // clang-format off
+    OffsetType GetSize()     const { return OffsetType{m_NumPages} * m_PageSize; }
+    OffsetType GetPageSize() const { return m_PageSize; }
+    OffsetType GetUsedSize() const { return static_cast<OffsetType>(m_Head.load() - m_Tail.load()) * m_PageSize; }
+    // clang-format on
+
+    // Allocates the smallest number of consecutive pages that fit SizeInBytes.
+    // The page size must be a multiple of the alignment as the blocks are only aligned by the page size
+    // relative to the start of the heap. The method is thread-safe and lock-free.
+    MasterBlock AllocateMasterBlock(OffsetType SizeInBytes, OffsetType Alignment)
+    {
+        VERIFY(Alignment == 0 || m_PageSize % Alignment == 0, "Page size (", m_PageSize, ") is not a multiple of the alignment (", Alignment, ")");
+
+        const Uint64 NumPages = std::max((SizeInBytes + m_PageSize - 1) / m_PageSize, OffsetType{1});
+        if (NumPages > m_NumPages)
+            return MasterBlock{};
+
+        // Page indices grow monotonically; the position in the ring is the index modulo the number of pages.
+        auto Head = m_Head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto       Start   = Head;
+            const auto RingPos = Start % m_NumPages;
+            // The block must be contiguous: skip the pages at the end of the ring if the block does not fit.
+            // The skipped pages are released together with the frame.
+            if (RingPos + NumPages > m_NumPages)
+                Start += m_NumPages - RingPos;
+
+            const auto End = Start + NumPages;
+            if (End - m_Tail.load(std::memory_order_acquire) > m_NumPages)
+                return MasterBlock{};
+
+            if (m_Head.compare_exchange_weak(Head, End, std::memory_order_acq_rel, std::memory_order_relaxed))
+            {
+                return MasterBlock{
+                    static_cast<OffsetType>(Start % m_NumPages) * m_PageSize,
+                    static_cast<OffsetType>(NumPages) * m_PageSize,
+                };
+            }
+        }
+    }
+
+private:
+    struct FrameAttribs
+    {
+        FrameAttribs(Uint64 _FenceValue, Uint64 _Head) noexcept :
+            FenceValue{_FenceValue},
+            Head{_Head}
+        {}
+
+        Uint64 FenceValue;
+        // The head of the ring at the end of the frame
+        Uint64 Head;
+    };
+
+    const OffsetType m_PageSize;
+    const Uint64     m_NumPages;
+
+    std::atomic<Uint64> m_Head{0};
+    std::atomic<Uint64> m_Tail{0};
+
+    std::mutex                                                 m_FramesMtx;
+    std::deque<FrameAttribs, STDAllocatorRawMem<FrameAttribs>> m_CompletedFrames;
+    Uint64                                                     m_LastFrameHead = 0;
+};
+
 } // namespace DynamicHeap
 
 } // namespace Diligent
@@ -30,23 +30,25 @@
 #include <vector>
 #include <mutex>
 #include <atomic>
+#include <memory>
 
 #include "PrivateConstants.h"
 #include "EngineFactory.h"
+#include "GraphicsTypes.h"
 #include "BasicTypes.h"
 #include "ReferenceCounters.h"
 #include "MemoryAllocator.h"
 #include "RefCntAutoPtr.hpp"
 #include "PlatformMisc.hpp"
 #include "ResourceReleaseQueue.hpp"
+#include "ThreadPool.hpp"
 #include "EngineMemory.h"
 #include "IndexWrapper.hpp"
+#include "CommandSubmissionThread.hpp"
 
 namespace Diligent
 {
 
-struct EngineCreateInfo;
-
 /// Base implementation of the render device for next-generation backends.
 
 template <class TBase, typename CommandQueueType>
@@ -61,13 +63,30 @@ public:
                             const EngineCreateInfo&    EngineCI,
                             const GraphicsAdapterInfo& AdapterInfo) :
         TBase{pRefCounters, RawMemAllocator, pEngineFactory, EngineCI, AdapterInfo},
-        m_CmdQueueCount{CmdQueueCount}
+        m_CmdQueueCount{CmdQueueCount},
+        m_ResourceDestructionTimeBudget{EngineCI.ResourceDestructionTimeBudget}
     {
         VERIFY(m_CmdQueueCount < MAX_COMMAND_QUEUES, "The number of command queue is greater than maximum allowed value (", MAX_COMMAND_QUEUES, ")");
 
         m_CommandQueues = ALLOCATE(this->m_RawMemAllocator, "Raw memory for the device command/release queues", CommandQueue, m_CmdQueueCount);
         for (size_t q = 0; q < m_CmdQueueCount; ++q)
             new (m_CommandQueues + q) CommandQueue{RefCntAutoPtr<CommandQueueType>(Queues[q]), this->m_RawMemAllocator};
+
+        if (EngineCI.AsyncResourceDestruction)
+        {
+            ThreadPoolCreateInfo PoolCI;
+            PoolCI.NumThreads                = 1;
+            m_pResourceDestructionThreadPool = CreateThreadPool(PoolCI);
+        }
+
+        if (EngineCI.AsyncCommandSubmission)
+        {
+            for (size_t q = 0; q < m_CmdQueueCount; ++q)
+            {
+                auto& Queue = m_CommandQueues[q];
+                Queue.pSubmissionThread.reset(new CommandSubmissionThread<CommandQueueType>{Queue.CmdQueue.RawPtr(), Queue.Mtx});
+            }
+        }
     }
 
     ~RenderDeviceNextGenBase()
@@ -151,9 +170,30 @@ public:
     void PurgeReleaseQueue(SoftwareQueueIndex QueueInd, bool ForceRelease = false)
     {
         VERIFY_EXPR(QueueInd < m_CmdQueueCount);
-        auto& Queue               = m_CommandQueues[QueueInd];
-        auto  CompletedFenceValue = ForceRelease ? std::numeric_limits<Uint64>::max() : Queue.CmdQueue->GetCompletedFenceValue();
-        Queue.ReleaseQueue.Purge(CompletedFenceValue);
+        auto& Queue = m_CommandQueues[QueueInd];
+        if (ForceRelease)
+        {
+            WaitForResourceDestruction(Queue);
+            Queue.ReleaseQueue.Purge(std::numeric_limits<Uint64>::max());
+            return;
+        }
+
+        const auto CompletedFenceValue = Queue.CmdQueue->GetCompletedFenceValue();
+        if (!m_pResourceDestructionThreadPool)
+        {
+            Queue.ReleaseQueue.Purge(CompletedFenceValue, m_ResourceDestructionTimeBudget);
+            return;
+        }
+
+        std::lock_guard<std::mutex> Lock{Queue.DestructionTaskMtx};
+        // If the previous task is still running, the resources will be destroyed by the next task
+        if (Queue.pDestructionTask && !Queue.pDestructionTask->IsFinished())
+            return;
+
+        Queue.pDestructionTask = EnqueueAsyncWork(m_pResourceDestructionThreadPool,
+                                                  [&ReleaseQueue = Queue.ReleaseQueue, CompletedFenceValue, TimeBudget = m_ResourceDestructionTimeBudget](Uint32 /*ThreadId*/) {
+                                                      ReleaseQueue.Purge(CompletedFenceValue, TimeBudget);
+                                                  });
     }
 
     void IdleCommandQueue(SoftwareQueueIndex QueueInd, bool ReleaseResources)
@@ -164,6 +204,7 @@ public:
         Uint64 CmdBufferNumber = 0;
         Uint64 FenceValue      = 0;
         {
+            ExclusiveQueueAccess        ExclusiveAccess{Queue};
             std::lock_guard<std::mutex> Lock{Queue.Mtx};
 
             if (ReleaseResources)
@@ -204,6 +245,7 @@ public:
         auto& Queue = m_CommandQueues[QueueInd];
 
         {
+            ExclusiveQueueAccess        ExclusiveAccess{Queue};
             std::lock_guard<std::mutex> Lock{Queue.Mtx};
 
             // Increment the command buffer number before submitting the cmd buffer.
@@ -216,22 +258,59 @@ public:
         }
 
         if (DiscardStaleResources)
+            DiscardSubmittedStaleResources(Queue, CmdBuffInfo);
+
+        return CmdBuffInfo;
+    }
+
+    /// Returns true if command buffers submitted with SubmitCommandBufferAsync() are
+    /// executed by the submission thread of the queue, see EngineCreateInfo::AsyncCommandSubmission.
+    bool IsAsyncSubmissionEnabled(SoftwareQueueIndex QueueInd) const
+    {
+        VERIFY_EXPR(QueueInd < m_CmdQueueCount);
+        return m_CommandQueues[QueueInd].pSubmissionThread != nullptr;
+    }
+
+    using SubmitTaskType = typename CommandSubmissionThread<CommandQueueType>::SubmitTaskType;
+
+    /// Submits the command buffer using the submission thread of the queue.
+
+    /// \param [in] QueueInd              - Software queue index.
+    /// \param [in] DiscardStaleResources - Whether to move stale resources into the release queue.
+    /// \param [in] Submit                - Task that submits the command buffer to the queue and returns the fence value.
+    ///                                     The task must own all the data it references, as it is executed later by another thread.
+    ///
+    /// \return     The command buffer number and the fence value that the submission will signal.
+    ///             Resources that are used by the command buffer may be released using this fence value right away,
+    ///             as the fence can't be signaled before the command buffer is submitted.
+    ///
+    /// \remarks    If the asynchronous submission is not enabled, the task is executed by the calling thread.
+    SubmittedCommandBufferInfo SubmitCommandBufferAsync(SoftwareQueueIndex QueueInd, bool DiscardStaleResources, SubmitTaskType&& Submit)
+    {
+        SubmittedCommandBufferInfo CmdBuffInfo;
+        VERIFY_EXPR(QueueInd < m_CmdQueueCount);
+        auto& Queue = m_CommandQueues[QueueInd];
+
+        if (Queue.pSubmissionThread)
         {
-            // The following basic requirement guarantees correctness of resource deallocation:
-            //
-            //        A resource is never released before the last draw command referencing it is submitted for execution
-            //
-
-            // Move stale objects into the release queue.
-            // Note that objects are moved from stale list to release queue based on the cmd buffer number,
-            // not fence value. This makes sure that basic requirement is met even when the fence value is
-            // not incremented while executing the command buffer (as is the case with Unity command queue).
-
-            // As long as resources used by deferred contexts are not released before the command list
-            // is executed through immediate context, this strategy always works.
-            Queue.ReleaseQueue.DiscardStaleResources(CmdBuffInfo.CmdBufferNumber, CmdBuffInfo.FenceValue);
+            // Assign the command buffer number while the submission thread lock is held,
+            // so that the numbers are ordered the same way as the fence values.
+            CmdBuffInfo.FenceValue = Queue.pSubmissionThread->Enqueue(std::move(Submit),
+                                                                      [&]() {
+                                                                          CmdBuffInfo.CmdBufferNumber = Queue.NextCmdBufferNumber.fetch_add(1);
+                                                                      });
+        }
+        else
+        {
+            std::lock_guard<std::mutex> Lock{Queue.Mtx};
+
+            CmdBuffInfo.CmdBufferNumber = Queue.NextCmdBufferNumber.fetch_add(1);
+            CmdBuffInfo.FenceValue      = Submit(Queue.CmdQueue.RawPtr());
         }
 
+        if (DiscardStaleResources)
+            DiscardSubmittedStaleResources(Queue, CmdBuffInfo);
+
         return CmdBuffInfo;
     }
 
@@ -254,7 +333,11 @@ public:
 
     Uint64 GetNextFenceValue(SoftwareQueueIndex CommandQueueInd)
     {
-        return m_CommandQueues[CommandQueueInd].CmdQueue->GetNextFenceValue();
+        auto& Queue = m_CommandQueues[CommandQueueInd];
+        // Account for the submissions that have not been executed by the submission thread yet
+        return Queue.pSubmissionThread ?
+            Queue.pSubmissionThread->GetNextFenceValue() :
+            Queue.CmdQueue->GetNextFenceValue();
     }
 
     template <typename TAction>
@@ -262,6 +345,7 @@ public:
     {
         VERIFY_EXPR(QueueInd < m_CmdQueueCount);
         auto&                       Queue = m_CommandQueues[QueueInd];
+        ExclusiveQueueAccess        ExclusiveAccess{Queue};
         std::lock_guard<std::mutex> Lock{Queue.Mtx};
         Action(Queue.CmdQueue);
     }
@@ -270,6 +354,8 @@ public:
     {
         VERIFY_EXPR(QueueInd < m_CmdQueueCount);
         auto& Queue = m_CommandQueues[QueueInd];
+        if (Queue.pSubmissionThread)
+            Queue.pSubmissionThread->BeginExclusiveAccess();
         Queue.Mtx.lock();
         return Queue.CmdQueue;
     }
@@ -279,6 +365,8 @@ public:
         VERIFY_EXPR(QueueInd < m_CmdQueueCount);
         auto& Queue = m_CommandQueues[QueueInd];
         Queue.Mtx.unlock();
+        if (Queue.pSubmissionThread)
+            Queue.pSubmissionThread->EndExclusiveAccess();
     }
 
 protected:
@@ -286,9 +374,14 @@ protected:
     {
         if (m_CommandQueues != nullptr)
         {
+            // Stop the submission threads first as the pending submissions may release resources
+            for (size_t q = 0; q < m_CmdQueueCount; ++q)
+                m_CommandQueues[q].pSubmissionThread.reset();
+
             for (size_t q = 0; q < m_CmdQueueCount; ++q)
             {
                 auto& Queue = m_CommandQueues[q];
+                WaitForResourceDestruction(Queue);
                 DEV_CHECK_ERR(Queue.ReleaseQueue.GetStaleResourceCount() == 0, "All stale resources must be released before destroying a command queue");
                 DEV_CHECK_ERR(Queue.ReleaseQueue.GetPendingReleaseResourceCount() == 0, "All resources must be released before destroying a command queue");
                 Queue.~CommandQueue();
@@ -318,9 +411,76 @@ protected:
         std::atomic<Uint64>                               NextCmdBufferNumber{0};
         RefCntAutoPtr<CommandQueueType>                   CmdQueue;
         ResourceReleaseQueue<DynamicStaleResourceWrapper> ReleaseQueue;
+
+        std::mutex                DestructionTaskMtx; // Protects access to the pDestructionTask.
+        RefCntAutoPtr<IAsyncTask> pDestructionTask;   // The task that purges the release queue when AsyncResourceDestruction is enabled.
+
+        // The thread that executes the submissions when AsyncCommandSubmission is enabled.
+        std::unique_ptr<CommandSubmissionThread<CommandQueueType>> pSubmissionThread;
+    };
+
+    // Waits for the pending asynchronous submissions and blocks new ones while the queue is accessed directly.
+    // Must be acquired before the queue mutex is locked.
+    class ExclusiveQueueAccess
+    {
+    public:
+        explicit ExclusiveQueueAccess(CommandQueue& Queue) :
+            m_pSubmissionThread{Queue.pSubmissionThread.get()}
+        {
+            if (m_pSubmissionThread != nullptr)
+                m_pSubmissionThread->BeginExclusiveAccess();
+        }
+
+        ~ExclusiveQueueAccess()
+        {
+            if (m_pSubmissionThread != nullptr)
+                m_pSubmissionThread->EndExclusiveAccess();
+        }
+
+        // clang-format off
+        ExclusiveQueueAccess           (const ExclusiveQueueAccess&) = delete;
+        ExclusiveQueueAccess& operator=(const ExclusiveQueueAccess&) = delete;
+        // clang-format on
+
+    private:
+        CommandSubmissionThread<CommandQueueType>* const m_pSubmissionThread;
     };
+
+    void DiscardSubmittedStaleResources(CommandQueue& Queue, const SubmittedCommandBufferInfo& CmdBuffInfo)
+    {
+        // The following basic requirement guarantees correctness of resource deallocation:
+        //
+        //        A resource is never released before the last draw command referencing it is submitted for execution
+        //
+
+        // Move stale objects into the release queue.
+        // Note that objects are moved from stale list to release queue based on the cmd buffer number,
+        // not fence value. This makes sure that basic requirement is met even when the fence value is
+        // not incremented while executing the command buffer (as is the case with Unity command queue).
+
+        // As long as resources used by deferred contexts are not released before the command list
+        // is executed through immediate context, this strategy always works.
+        Queue.ReleaseQueue.DiscardStaleResources(CmdBuffInfo.CmdBufferNumber, CmdBuffInfo.FenceValue);
+    }
+
+    void WaitForResourceDestruction(CommandQueue& Queue)
+    {
+        std::lock_guard<std::mutex> Lock{Queue.DestructionTaskMtx};
+        if (Queue.pDestructionTask)
+        {
+            Queue.pDestructionTask->WaitForCompletion();
+            Queue.pDestructionTask.Release();
+        }
+    }
+
     const size_t  m_CmdQueueCount = 0;
     CommandQueue* m_CommandQueues = nullptr;
+
+    // See EngineCreateInfo::ResourceDestructionTimeBudget
+    const Uint32 m_ResourceDestructionTimeBudget;
+
+    // Thread pool with one worker thread that destroys released resources, see EngineCreateInfo::AsyncResourceDestruction
+    RefCntAutoPtr<IThreadPool> m_pResourceDestructionThreadPool;
 };
 
 } // namespace Diligent
@@ -33,6 +33,7 @@
 #include "GLObjectWrapper.hpp"
 #include "AsyncWritableResource.hpp"
 #include "GLContextState.hpp"
+#include "UploadRingBufferGL.hpp"
 
 namespace Diligent
 {
@@ -64,10 +65,10 @@ public:
     /// Queries the specific interface, see IObject::QueryInterface() for details
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override;
 
-    void UpdateData(GLContextState& CtxState, Uint64 Offset, Uint64 Size, const void* pData);
+    void UpdateData(GLContextState& CtxState, UploadRingBufferGL& UploadRing, Uint64 Offset, Uint64 Size, const void* pData);
     void CopyData(GLContextState& CtxState, BufferGLImpl& SrcBufferGL, Uint64 SrcOffset, Uint64 DstOffset, Uint64 Size);
-    void Map(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapFlags, PVoid& pMappedData);
-    void MapRange(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapFlags, Uint64 Offset, Uint64 Length, PVoid& pMappedData);
+    void Map(GLContextState& CtxState, UploadRingBufferGL& UploadRing, MAP_TYPE MapType, Uint32 MapFlags, PVoid& pMappedData);
+    void MapRange(GLContextState& CtxState, UploadRingBufferGL& UploadRing, MAP_TYPE MapType, Uint32 MapFlags, Uint64 Offset, Uint64 Length, PVoid& pMappedData);
     void Unmap(GLContextState& CtxState);
 
     __forceinline void BufferMemoryBarrier(MEMORY_BARRIER RequiredBarriers, GLContextState& GLContextState);
@@ -86,12 +87,26 @@ public:
 private:
     virtual void CreateViewInternal(const struct BufferViewDesc& ViewDesc, IBufferView** ppView, bool bIsDefaultView) override;
 
+    void CopyBufferSubData(GLContextState& CtxState, const GLObjectWrappers::GLBufferObj& SrcBuffer, Uint64 SrcOffset, Uint64 DstOffset, Uint64 Size);
+
     friend class DeviceContextGLImpl;
     friend class VAOCache;
 
     GLObjectWrappers::GLBufferObj m_GlBuffer;
     const Uint32                  m_BindTarget;
     const GLenum                  m_GLUsageHint;
+
+    // Upload ring allocation that holds the contents of a dynamic buffer mapped with MAP_FLAG_DISCARD.
+    // The mapped range is copied to the buffer by Unmap().
+    UploadRingBufferGL::Allocation m_UploadRingAlloc;
+    Uint64                         m_UploadRingFrame        = 0;
+    Uint64                         m_UploadRingMappedOffset = 0;
+    Uint64                         m_UploadRingMappedSize   = 0;
+    bool                           m_IsMappedFromUploadRing = false;
+
+    // Set to false when the buffer is mapped with MAP_FLAG_NO_OVERWRITE across frames, which
+    // requires the previous contents to stay in the buffer.
+    bool m_UseUploadRing = true;
 };
 
 void BufferGLImpl::BufferMemoryBarrier(MEMORY_BARRIER RequiredBarriers, GLContextState& GLState)
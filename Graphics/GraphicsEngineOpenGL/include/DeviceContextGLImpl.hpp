@@ -28,6 +28,7 @@
 #pragma once
 
 #include <vector>
+#include <initializer_list>
 
 #include "EngineGLImplTraits.hpp"
 #include "DeviceContextBase.hpp"
@@ -42,7 +43,10 @@
 #include "ShaderResourceBindingGLImpl.hpp"
 
 #include "GLContextState.hpp"
+#include "UploadRingBufferGL.hpp"
 #include "GLObjectWrapper.hpp"
+#include "GLCommandStream.hpp"
+#include "FixedBlockMemoryAllocator.hpp"
 
 namespace Diligent
 {
@@ -63,6 +67,9 @@ public:
     /// Implementation of IDeviceContext::Begin() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE Begin(Uint32 ImmediateContextId) override final;
 
+    /// Implementation of IDeviceContext::BeginReusable() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE BeginReusable(Uint32 ImmediateContextId) override final;
+
     /// Implementation of IDeviceContext::SetPipelineState() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE SetPipelineState(IPipelineState* pPipelineState) override final;
 
@@ -133,6 +140,10 @@ public:
     virtual void DILIGENT_CALL_TYPE DrawMesh           (const DrawMeshAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawMeshIndirect() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE DrawMeshIndirect   (const DrawMeshIndirectAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDraw() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE MultiDraw          (const MultiDrawAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndexed() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexed   (const MultiDrawIndexedAttribs& Attribs) override final;
 
     /// Implementation of IDeviceContext::DispatchCompute() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE DispatchCompute        (const DispatchComputeAttribs& Attribs) override final;
@@ -202,6 +213,9 @@ public:
     /// Implementation of IDeviceContext::GenerateMips() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE GenerateMips(ITextureView* pTexView) override;
 
+    /// Implementation of IDeviceContext::GenerateMipsBatch() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE GenerateMipsBatch(ITextureView* const* ppTexViews, Uint32 NumViews) override final;
+
     /// Implementation of IDeviceContext::FinishFrame() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE FinishFrame() override final;
 
@@ -235,12 +249,39 @@ public:
     /// Implementation of IDeviceContext::EndQuery() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE EndQuery(IQuery* pQuery) override final;
 
+    /// Implementation of IDeviceContext::BeginIndexedQuery() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE BeginIndexedQuery(IQueryArray* pQueryArray, Uint32 Index) override final;
+
+    /// Implementation of IDeviceContext::EndIndexedQuery() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE EndIndexedQuery(IQueryArray* pQueryArray, Uint32 Index) override final;
+
+    /// Implementation of IDeviceContext::ResolveQueryArray() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE ResolveQueryArray(const ResolveQueryArrayAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::SetPredication() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE SetPredication(IBuffer* pBuffer, Uint64 Offset, PREDICATION_OP Op) override final;
+
+    /// Implementation of IDeviceContext::SetQueryPredication() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE SetQueryPredication(IQuery* pQuery, PREDICATION_OP Op) override final;
+
+    /// Implementation of IDeviceContext::SetCullMode() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE SetCullMode(CULL_MODE CullMode) override final;
+
+    /// Implementation of IDeviceContext::SetDepthStencilState() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE SetDepthStencilState(const DepthStencilStateDesc& DSSDesc) override final;
+
+    /// Implementation of IDeviceContext::SetPrimitiveTopology() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE SetPrimitiveTopology(PRIMITIVE_TOPOLOGY Topology) override final;
+
     /// Implementation of IDeviceContext::Flush() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE Flush() override final;
 
     /// Implementation of IDeviceContext::BuildBLAS() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE BuildBLAS(const BuildBLASAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::BuildBLASBatch() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE BuildBLASBatch(const BuildBLASBatchAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::BuildTLAS() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE BuildTLAS(const BuildTLASAttribs& Attribs) override final;
 
@@ -294,9 +335,22 @@ public:
     GLContextState& GetContextState() { return m_ContextState; }
 
     void CommitRenderTargets();
+    void InvalidateDepthStencil();
 
     virtual void DILIGENT_CALL_TYPE SetSwapChain(ISwapChainGL* pSwapChain) override final;
 
+    /// Implementation of IDeviceContextGL::GetStateCacheStats().
+    virtual void DILIGENT_CALL_TYPE GetStateCacheStats(GLStateCacheStats& Stats) const override final
+    {
+        Stats = m_ContextState.GetStats();
+    }
+
+    /// Implementation of IDeviceContextGL::ResetStateCacheStats().
+    virtual void DILIGENT_CALL_TYPE ResetStateCacheStats() override final
+    {
+        m_ContextState.ResetStats();
+    }
+
     virtual void ResetRenderTargets() override final;
 
 
@@ -307,7 +361,29 @@ protected:
 
     GLContextState m_ContextState;
 
+    // Persistently mapped ring buffer that streams dynamic buffer contents and buffer updates.
+    static constexpr Uint64 UploadRingSize = Uint64{8} << 20;
+    UploadRingBufferGL      m_UploadRing;
+
 private:
+    // Records the command into the deferred command stream.
+    template <typename CommandType>
+    void RecordDeferredCommand(CommandType&& Command)
+    {
+        DEV_CHECK_ERR(IsRecordingDeferredCommands(), "Deferred context is not in recording state. Call Begin() first.");
+        m_DeferredCommands.Record(std::forward<CommandType>(Command));
+    }
+
+    // Records the command that references the objects. The stream keeps
+    // strong references to the objects until the command list is released.
+    template <typename CommandType>
+    void RecordDeferredCommand(std::initializer_list<IObject*> Objects, CommandType&& Command)
+    {
+        for (auto* pObject : Objects)
+            m_DeferredCommands.KeepAlive(pObject);
+        RecordDeferredCommand(std::forward<CommandType>(Command));
+    }
+
     __forceinline void PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, GLenum& GlTopology);
     __forceinline void PrepareForIndexedDraw(VALUE_TYPE IndexType, Uint32 FirstIndexLocation, GLenum& GLIndexType, size_t& FirstIndexByteOffset);
     __forceinline void PrepareForIndirectDraw(IBuffer* pAttribsBuffer);
@@ -349,9 +425,30 @@ private:
 
     bool m_IsDefaultFBOBound = false;
 
+    // Whether the contents of the bound depth-stencil buffer are discarded when the render targets change,
+    // see SetRenderTargetsAttribs::DiscardDepthStencil.
+    bool m_DiscardDepthStencil = false;
+
+    // Whether conditional rendering begun by SetQueryPredication() is active.
+    bool m_QueryPredicationActive = false;
+
     GLObjectWrappers::GLFrameBufferObj m_DefaultFBO;
 
     std::vector<OptimizedClearValue> m_AttachmentClearValues;
+
+    // Scratch arrays used by MultiDraw() and MultiDrawIndexed() to pass per-item
+    // arguments to glMultiDrawArrays() and glMultiDrawElementsBaseVertex().
+    struct MultiDrawScratchSpace
+    {
+        std::vector<GLsizei> Counts;
+        std::vector<GLint>   FirstsOrBaseVertices;
+        std::vector<GLvoid*> IndexOffsets;
+    } m_MultiDrawScratch;
+
+    // Commands recorded by a deferred context since the last call to Begin().
+    GLCommandStream m_DeferredCommands;
+
+    FixedBlockMemoryAllocator m_CmdListAllocator;
 };
 
 } // namespace Diligent
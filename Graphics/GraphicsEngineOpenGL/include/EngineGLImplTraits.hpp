@@ -43,6 +43,7 @@
 #include "QueryGL.h"
 #include "RenderPass.h"
 #include "Framebuffer.h"
+#include "CommandList.h"
 #include "PipelineResourceSignature.h"
 #include "DeviceContextGL.h"
 #include "BaseInterfacesGL.h"
@@ -64,13 +65,13 @@ class FenceGLImpl;
 class QueryGLImpl;
 class RenderPassGLImpl;
 class FramebufferGLImpl;
+class CommandListGLImpl;
 class BottomLevelASGLImpl;
 class TopLevelASGLImpl;
 class ShaderBindingTableGLImpl;
 class PipelineResourceSignatureGLImpl;
 class DeviceMemoryGLImpl;
-class PipelineStateCacheGlImpl
-{};
+class PipelineStateCacheGLImpl;
 
 class FixedBlockMemoryAllocator;
 
@@ -104,7 +105,9 @@ struct EngineGLImplTraits
     using QueryInterface                     = IQueryGL;
     using RenderPassInterface                = IRenderPass;
     using FramebufferInterface               = IFramebuffer;
+    using CommandListInterface               = ICommandList;
     using PipelineResourceSignatureInterface = IPipelineResourceSignature;
+    using PipelineStateCacheInterface        = IPipelineStateCache;
 
     using RenderDeviceImplType              = RenderDeviceGLImpl;
     using DeviceContextImplType             = DeviceContextGLImpl;
@@ -120,12 +123,13 @@ struct EngineGLImplTraits
     using QueryImplType                     = QueryGLImpl;
     using RenderPassImplType                = RenderPassGLImpl;
     using FramebufferImplType               = FramebufferGLImpl;
+    using CommandListImplType               = CommandListGLImpl;
     using BottomLevelASImplType             = BottomLevelASGLImpl;
     using TopLevelASImplType                = TopLevelASGLImpl;
     using ShaderBindingTableImplType        = ShaderBindingTableGLImpl;
     using PipelineResourceSignatureImplType = PipelineResourceSignatureGLImpl;
     using DeviceMemoryImplType              = DeviceMemoryGLImpl;
-    using PipelineStateCacheImplType        = PipelineStateCacheGlImpl;
+    using PipelineStateCacheImplType        = PipelineStateCacheGLImpl;
 
     using BuffViewObjAllocatorType = FixedBlockMemoryAllocator;
     using TexViewObjAllocatorType  = FixedBlockMemoryAllocator;
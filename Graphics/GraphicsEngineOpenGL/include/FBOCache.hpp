@@ -27,6 +27,10 @@
 
 #pragma once
 
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "GraphicsTypes.h"
 #include "TextureView.h"
 #include "SpinLock.hpp"
@@ -42,7 +46,9 @@ class GLContextState;
 class FBOCache
 {
 public:
-    FBOCache();
+    // MaxSize is the maximum number of FBOs in the cache. When the limit is reached,
+    // the least recently used FBO is released. Zero means no limit.
+    explicit FBOCache(Uint32 MaxSize);
     ~FBOCache();
 
     // clang-format off
@@ -65,39 +71,84 @@ public:
     void OnReleaseTexture(ITexture* pTexture);
 
 private:
+    // Compact description of a single framebuffer attachment.
+    // Only the view attributes that affect the attachment are stored.
+    struct AttachmentKey
+    {
+        // Unique ID of the texture (using pointers is not reliable!)
+        UniqueIdentifier TexId      = 0;
+        Uint32           MipLevel   = 0;
+        Uint32           FirstSlice = 0;
+        Uint32           NumSlices  = 0;
+
+        AttachmentKey() noexcept {}
+        AttachmentKey(UniqueIdentifier _TexId, const TextureViewDesc& ViewDesc) noexcept :
+            // clang-format off
+            TexId     {_TexId},
+            MipLevel  {ViewDesc.MostDetailedMip},
+            FirstSlice{ViewDesc.FirstArraySlice},
+            NumSlices {ViewDesc.NumArraySlices}
+        // clang-format on
+        {}
+
+        bool operator!=(const AttachmentKey& rhs) const noexcept
+        {
+            // clang-format off
+            return TexId      != rhs.TexId      ||
+                   MipLevel   != rhs.MipLevel   ||
+                   FirstSlice != rhs.FirstSlice ||
+                   NumSlices  != rhs.NumSlices;
+            // clang-format on
+        }
+    };
+
     // This structure is used as the key to find FBO
     struct FBOCacheKey
     {
-        // Using pointers is not reliable!
-
         Uint32 NumRenderTargets = 0;
 
-        // Unique IDs of textures bound as render targets
-        UniqueIdentifier RTIds[MAX_RENDER_TARGETS] = {};
-        TextureViewDesc  RTVDescs[MAX_RENDER_TARGETS];
-
-        // Unique IDs of texture bound as depth stencil
-        UniqueIdentifier DSId    = 0;
-        TextureViewDesc  DSVDesc = {};
+        AttachmentKey RTs[MAX_RENDER_TARGETS];
+        AttachmentKey DS;
 
-        mutable size_t Hash = 0;
+        size_t Hash = 0;
 
         bool operator==(const FBOCacheKey& Key) const noexcept;
     };
 
     struct FBOCacheKeyHashFunc
     {
-        std::size_t operator()(const FBOCacheKey& Key) const noexcept;
+        std::size_t operator()(const FBOCacheKey& Key) const noexcept
+        {
+            return Key.Hash;
+        }
     };
 
+    // Keys are stored in m_Cache only. Other containers reference them by pointers,
+    // which remain valid until the element is erased from the map.
+    using LRUListType = std::list<const FBOCacheKey*>;
+
+    struct CacheEntry
+    {
+        GLObjectWrappers::GLFrameBufferObj FBO;
+        LRUListType::iterator              LRUIt;
+    };
+    using CacheType = std::unordered_map<FBOCacheKey, CacheEntry, FBOCacheKeyHashFunc>;
+
+    // Removes the FBO from the cache along with all references to its key
+    void RemoveFBO(CacheType::iterator It);
 
     friend class RenderDeviceGLImpl;
-    Threading::SpinLock                                                                      m_CacheLock;
-    std::unordered_map<FBOCacheKey, GLObjectWrappers::GLFrameBufferObj, FBOCacheKeyHashFunc> m_Cache;
 
-    // Multimap that sets up correspondence between unique texture id and all
-    // FBOs it is used in
-    std::unordered_multimap<UniqueIdentifier, FBOCacheKey> m_TexIdToKey;
+    const Uint32 m_MaxSize;
+
+    Threading::SpinLock m_CacheLock;
+    CacheType           m_Cache;
+
+    // The most recently used FBO is at the front of the list
+    LRUListType m_LRUList;
+
+    // Sets up correspondence between unique texture id and all FBOs it is used in
+    std::unordered_map<UniqueIdentifier, std::unordered_set<const FBOCacheKey*>> m_TexIdToKeys;
 };
 
 } // namespace Diligent
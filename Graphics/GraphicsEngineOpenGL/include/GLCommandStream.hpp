@@ -0,0 +1,154 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GLCommandStream class
+
+#include <vector>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <new>
+#include <cstring>
+
+#include "Object.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+class DeviceContextGLImpl;
+
+/// Linear stream of device context commands recorded by a deferred context
+/// and replayed by the immediate context.
+///
+/// \remarks    Commands and their data are placed into fixed-size memory pages that never move,
+///             so pointers returned by Allocate() stay valid for the lifetime of the stream.
+///             The stream keeps strong references to all objects passed to KeepAlive().
+class GLCommandStream
+{
+public:
+    GLCommandStream() noexcept {}
+    ~GLCommandStream();
+
+    // clang-format off
+    GLCommandStream             (const GLCommandStream&)  = delete;
+    GLCommandStream             (      GLCommandStream&&) noexcept;
+    GLCommandStream& operator = (const GLCommandStream&)  = delete;
+    GLCommandStream& operator = (      GLCommandStream&&) noexcept;
+    // clang-format on
+
+    /// Records a command. The command is a callable object that takes DeviceContextGLImpl&
+    /// and is executed when the stream is replayed.
+    template <typename CommandType>
+    void Record(CommandType&& Command)
+    {
+        using CmdType = typename std::decay<CommandType>::type;
+
+        void* pMem = Allocate(sizeof(CommandHeader) + sizeof(CmdType), alignof(CommandHeader) > alignof(CmdType) ? alignof(CommandHeader) : alignof(CmdType));
+
+        auto* pHeader    = new (pMem) CommandHeader{};
+        pHeader->Execute = [](const void* pCmd, DeviceContextGLImpl& Ctx) {
+            (*static_cast<const CmdType*>(pCmd))(Ctx);
+        };
+        if (!std::is_trivially_destructible<CmdType>::value)
+        {
+            pHeader->Destroy = [](void* pCmd) {
+                static_cast<CmdType*>(pCmd)->~CmdType();
+            };
+        }
+        pHeader->pCommand = new (pHeader + 1) CmdType{std::forward<CommandType>(Command)};
+
+        if (m_pLastCmd != nullptr)
+            m_pLastCmd->pNext = pHeader;
+        else
+            m_pFirstCmd = pHeader;
+        m_pLastCmd = pHeader;
+        ++m_NumCommands;
+    }
+
+    /// Allocates memory in the stream.
+    void* Allocate(size_t Size, size_t Alignment = sizeof(void*) * 2);
+
+    /// Copies an array of trivially copyable elements into the stream.
+    /// Returns null if pData is null or Count is zero.
+    template <typename DataType>
+    DataType* Copy(const DataType* pData, size_t Count)
+    {
+        static_assert(std::is_trivially_copyable<DataType>::value, "Only trivially copyable types can be copied into the stream");
+        if (pData == nullptr || Count == 0)
+            return nullptr;
+        auto* pDst = static_cast<DataType*>(Allocate(sizeof(DataType) * Count, alignof(DataType)));
+        memcpy(pDst, pData, sizeof(DataType) * Count);
+        return pDst;
+    }
+
+    /// Copies a null-terminated string into the stream.
+    const Char* CopyString(const Char* Str);
+
+    /// Keeps a strong reference to the object until the stream is cleared.
+    void KeepAlive(IObject* pObject)
+    {
+        if (pObject != nullptr)
+            m_Objects.emplace_back(pObject);
+    }
+
+    /// Executes all recorded commands in the order they were recorded.
+    void Execute(DeviceContextGLImpl& Ctx) const;
+
+    /// Destroys all commands and releases the memory and object references.
+    void Clear();
+
+    size_t GetNumCommands() const { return m_NumCommands; }
+
+private:
+    struct CommandHeader
+    {
+        void (*Execute)(const void* pCmd, DeviceContextGLImpl& Ctx) = nullptr;
+        void (*Destroy)(void* pCmd)                                 = nullptr;
+
+        void*          pCommand = nullptr;
+        CommandHeader* pNext    = nullptr;
+    };
+
+    static constexpr size_t PageSize = size_t{64} << 10;
+
+    std::vector<std::unique_ptr<Uint8[]>> m_Pages;
+
+    Uint8* m_pCurrPos = nullptr;
+    Uint8* m_pPageEnd = nullptr;
+
+    CommandHeader* m_pFirstCmd   = nullptr;
+    CommandHeader* m_pLastCmd    = nullptr;
+    size_t         m_NumCommands = 0;
+
+    std::vector<RefCntAutoPtr<IObject>> m_Objects;
+};
+
+} // namespace Diligent
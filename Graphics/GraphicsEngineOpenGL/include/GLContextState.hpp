@@ -28,8 +28,10 @@
 #pragma once
 
 #include <limits>
+#include <utility>
 
 #include "GraphicsTypes.h"
+#include "DeviceContextGL.h"
 #include "GLObjectWrapper.hpp"
 #include "UniqueIdentifier.hpp"
 #include "GLContext.hpp"
@@ -91,6 +93,13 @@ public:
     void SetNumPatchVertices(Int32 NumVertices);
     void Invalidate();
 
+    // Starts a batch of texture, sampler, uniform buffer and storage block bindings.
+    // If multi-bind is supported (GL_ARB_multi_bind), bindings to non-negative slots
+    // are not sent to GL immediately, but are committed by EndBindBatch() with
+    // a single call per contiguous range of changed binding points.
+    void BeginBindBatch();
+    void EndBindBatch();
+
     void InvalidateVAO()
     {
         m_VAOId = -1;
@@ -112,13 +121,73 @@ public:
     {
         bool  IsFillModeSelectionSupported = true;
         bool  IsProgramPipelineSupported   = true;
+        bool  IsDSASupported               = false;
+        bool  IsMultiBindSupported         = false;
         GLint MaxCombinedTexUnits          = 0;
         GLint MaxDrawBuffers               = 0;
         GLint MaxUniformBufferBindings     = 0;
     };
     const ContextCaps& GetContextCaps() { return m_Caps; }
 
+    const GLStateCacheStats& GetStats() const { return m_Stats; }
+    void                     ResetStats() { m_Stats = GLStateCacheStats{}; }
+
+    // Returns the number of glMemoryBarrier calls issued since the last call and resets the counter.
+    Uint32 ExtractMemoryBarrierCount() { return std::exchange(m_MemoryBarrierCount, 0u); }
+
 private:
+    // Accumulates the bindings that have not been sent to GL yet, so that
+    // consecutive binding points can be committed with multi-bind functions.
+    class PendingBindRange
+    {
+    public:
+        void Set(Uint32 Slot, GLuint Handle, GLintptr Offset = 0, GLsizeiptr Size = 0);
+
+        // Calls Handler(First, Count, Handles, Offsets, Sizes) for every contiguous range of pending bindings
+        template <typename HandlerType>
+        void Commit(HandlerType&& Handler)
+        {
+            for (Uint32 Slot = m_First; Slot <= m_Last;)
+            {
+                if (!m_IsPending[Slot])
+                {
+                    ++Slot;
+                    continue;
+                }
+
+                Uint32 End = Slot;
+                while (End <= m_Last && m_IsPending[End])
+                    m_IsPending[End++] = false;
+
+                Handler(Slot, End - Slot, &m_Handles[Slot], &m_Offsets[Slot], &m_Sizes[Slot]);
+                Slot = End;
+            }
+            m_First = ~0u;
+            m_Last  = 0;
+        }
+
+    private:
+        std::vector<bool>       m_IsPending;
+        std::vector<GLuint>     m_Handles;
+        std::vector<GLintptr>   m_Offsets;
+        std::vector<GLsizeiptr> m_Sizes;
+
+        Uint32 m_First = ~0u;
+        Uint32 m_Last  = 0;
+    };
+
+    void CommitPendingBindings();
+
+    // Updates the state cache statistics and returns IsChanged
+    bool TrackStateChange(bool IsChanged)
+    {
+        if (IsChanged)
+            ++m_Stats.IssuedCalls;
+        else
+            ++m_Stats.FilteredCalls;
+        return IsChanged;
+    }
+
     // It is unsafe to use GL handle to keep track of bound objects
     // When an object is released, GL is free to reuse its handle for
     // the new created objects.
@@ -276,6 +345,16 @@ private:
 
     ContextCaps m_Caps;
 
+    GLStateCacheStats m_Stats;
+
+    Uint32 m_MemoryBarrierCount = 0;
+
+    bool             m_IsBindBatchActive = false;
+    PendingBindRange m_PendingTextures;
+    PendingBindRange m_PendingSamplers;
+    PendingBindRange m_PendingUniformBuffers;
+    PendingBindRange m_PendingStorageBlocks;
+
     Uint32            m_ColorWriteMasks[MAX_RENDER_TARGETS] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
     EnableStateHelper m_bIndependentWriteMasks;
     Int32             m_iActiveTexture   = -1;
@@ -42,3 +42,15 @@
 #    define GL_SUBGROUP_FEATURE_CLUSTERED_BIT_KHR        0x00000040
 #    define GL_SUBGROUP_FEATURE_QUAD_BIT_KHR             0x00000080
 #endif /* GL_KHR_shader_subgroup */
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#    define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+
+#ifndef GL_MAP_COHERENT_BIT
+#    define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+#ifndef GL_COMPLETION_STATUS_KHR
+#    define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
@@ -1141,6 +1141,12 @@ void UnsupportedGLFunctionStub( const T &Name )
 #define glTexStorage1D(...) UnsupportedGLFunctionStub("glTexStorage1D")
 #define glTexSubImage1D(...) UnsupportedGLFunctionStub("glTexSubImage1D")
 
+// Direct state access is not available in GLES
+#define glNamedBufferSubData(...) UnsupportedGLFunctionStub("glNamedBufferSubData")
+#define glCopyNamedBufferSubData(...) UnsupportedGLFunctionStub("glCopyNamedBufferSubData")
+#define glTextureSubImage2D(...) UnsupportedGLFunctionStub("glTextureSubImage2D")
+#define glCompressedTextureSubImage2D(...) UnsupportedGLFunctionStub("glCompressedTextureSubImage2D")
+
 #ifndef GL_ES_VERSION_3_1
 
     #define LOAD_GL_BIND_IMAGE_TEXTURE
@@ -1364,6 +1370,11 @@ extern PFNGLMULTIDRAWELEMENTSINDIRECTPROC glMultiDrawElementsIndirect;
 typedef void (GL_APIENTRYP PFNGLCLIPCONTROLPROC) (GLenum origin, GLenum depth);
 extern PFNGLCLIPCONTROLPROC glClipControl;
 
+// GL_EXT_buffer_storage
+#define LOAD_GL_BUFFER_STORAGE
+typedef void (GL_APIENTRY* PFNGLBUFFERSTORAGEPROC) (GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+extern PFNGLBUFFERSTORAGEPROC glBufferStorage;
+
 #ifndef GL_ES_VERSION_3_2
 
     typedef void (GL_APIENTRY* GLDEBUGPROC) (GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam);
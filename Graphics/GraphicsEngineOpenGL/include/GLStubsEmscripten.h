@@ -694,3 +694,8 @@ static void (*glGetQueryObjectui64v)(GLuint id, GLenum pname, GLuint64* params)
 #define glDispatchCompute(...)         UnsupportedGLFunctionStub("glDispatchCompute", __VA_ARGS__)
 #define glPatchParameteri(...)         UnsupportedGLFunctionStub("glPatchParameteri", __VA_ARGS__)
 #define glTexStorage2DMultisample(...) UnsupportedGLFunctionStub("glTexStorage2DMultisample", __VA_ARGS__)
+#define glBufferStorage(...)           UnsupportedGLFunctionStub("glBufferStorage", __VA_ARGS__)
+#define glNamedBufferSubData(...)          UnsupportedGLFunctionStub("glNamedBufferSubData", __VA_ARGS__)
+#define glCopyNamedBufferSubData(...)      UnsupportedGLFunctionStub("glCopyNamedBufferSubData", __VA_ARGS__)
+#define glTextureSubImage2D(...)           UnsupportedGLFunctionStub("glTextureSubImage2D", __VA_ARGS__)
+#define glCompressedTextureSubImage2D(...) UnsupportedGLFunctionStub("glCompressedTextureSubImage2D", __VA_ARGS__)
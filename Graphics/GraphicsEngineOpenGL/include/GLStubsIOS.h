@@ -632,6 +632,11 @@ static void (*glPolygonMode)(GLenum face, GLenum mode) = nullptr;
 #define glFramebufferTexture(...)     UnsupportedGLFunctionStub("glFramebufferTexture")
 #define glFramebufferTexture1D(...)   UnsupportedGLFunctionStub("glFramebufferTexture1D")
 #define glClipControl(...)            UnsupportedGLFunctionStub("glClipControl")
+#define glBufferStorage(...)          UnsupportedGLFunctionStub("glBufferStorage")
+#define glNamedBufferSubData(...)          UnsupportedGLFunctionStub("glNamedBufferSubData")
+#define glCopyNamedBufferSubData(...)      UnsupportedGLFunctionStub("glCopyNamedBufferSubData")
+#define glTextureSubImage2D(...)           UnsupportedGLFunctionStub("glTextureSubImage2D")
+#define glCompressedTextureSubImage2D(...) UnsupportedGLFunctionStub("glCompressedTextureSubImage2D")
 static void (*glGetQueryObjectui64v)(GLuint id, GLenum pname, GLuint64* params) = nullptr;
 
 #ifndef GL_BUFFER
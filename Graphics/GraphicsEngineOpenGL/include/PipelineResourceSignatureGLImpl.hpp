@@ -148,6 +148,9 @@ public:
 private:
     void CreateLayout(bool IsSerialized);
 
+    // Initializes immutable samplers of the resources in the given index range
+    void InitImmutableSamplers(ShaderResourceCacheGL& ResourceCache, const std::pair<Uint32, Uint32>& ResIdxRange) const;
+
     void Destruct();
 
 private:
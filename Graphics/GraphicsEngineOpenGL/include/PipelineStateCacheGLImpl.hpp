@@ -0,0 +1,112 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// Declaration of Diligent::PipelineStateCacheGLImpl class
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "EngineGLImplTraits.hpp"
+#include "PipelineStateCacheBase.hpp"
+#include "GLObjectWrapper.hpp"
+
+namespace Diligent
+{
+
+/// Pipeline state cache implementation in OpenGL backend.
+
+/// The cache stores linked program binaries retrieved with glGetProgramBinary.
+/// Binaries are only valid for the driver that produced them, so the cache data
+/// is discarded when the vendor, renderer or version string of the driver changes.
+class PipelineStateCacheGLImpl final : public PipelineStateCacheBase<EngineGLImplTraits>
+{
+public:
+    using TPipelineStateCacheBase = PipelineStateCacheBase<EngineGLImplTraits>;
+
+    PipelineStateCacheGLImpl(IReferenceCounters*                 pRefCounters,
+                             RenderDeviceGLImpl*                 pDeviceGL,
+                             const PipelineStateCacheCreateInfo& CreateInfo);
+    ~PipelineStateCacheGLImpl();
+
+    /// Implementation of IPipelineStateCache::GetData().
+    virtual void DILIGENT_CALL_TYPE GetData(IDataBlob** ppBlob) override final;
+
+    struct ProgramKey
+    {
+        // Hash of the shader types and GLSL sources of all shaders in the program
+        Uint64 Hash = 0;
+        // Total length of the GLSL sources
+        Uint64 SourceLength = 0;
+
+        ProgramKey() noexcept {}
+        ProgramKey(ShaderGLImpl* const* ppShaders, Uint32 NumShaders, bool IsSeparableProgram) noexcept;
+
+        bool operator==(const ProgramKey& rhs) const
+        {
+            return Hash == rhs.Hash && SourceLength == rhs.SourceLength;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const ProgramKey& Key) const
+            {
+                return static_cast<size_t>(Key.Hash);
+            }
+        };
+    };
+
+    /// Creates a program from the cached binary. Returns a null program if the
+    /// cache does not contain the binary or if the driver rejects it.
+    GLObjectWrappers::GLProgramObj LoadProgram(const ProgramKey& Key, bool IsSeparableProgram);
+
+    /// Retrieves the binary of a linked program and adds it to the cache.
+    void StoreProgram(const ProgramKey& Key, GLuint GLProgram);
+
+private:
+    static std::string GetDriverId();
+
+    bool ParseCacheData(const void* pData, size_t DataSize);
+
+private:
+    struct ProgramBinary
+    {
+        Uint32             Format = 0;
+        std::vector<Uint8> Data;
+    };
+
+    // Vendor, renderer and version strings of the driver
+    const std::string m_DriverId;
+
+    std::mutex                                                        m_ProgramsMtx;
+    std::unordered_map<ProgramKey, ProgramBinary, ProgramKey::Hasher> m_Programs;
+};
+
+} // namespace Diligent
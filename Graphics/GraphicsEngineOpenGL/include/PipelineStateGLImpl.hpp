@@ -28,6 +28,7 @@
 #pragma once
 
 #include <vector>
+#include <memory>
 
 #include "EngineGLImplTraits.hpp"
 #include "PipelineStateBase.hpp"
@@ -63,6 +64,13 @@ public:
     /// Queries the specific interface, see IObject::QueryInterface() for details
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override;
 
+    /// Implementation of IPipelineState::GetStatus() in OpenGL backend.
+    ///
+    /// When the pipeline is linked asynchronously, the method polls the link status of the programs
+    /// and finishes the initialization once all of them are linked. Must be called from the thread
+    /// that owns the GL context.
+    virtual PIPELINE_STATE_STATUS DILIGENT_CALL_TYPE GetStatus(bool WaitForCompletion) override final;
+
     void CommitProgram(GLContextState& State);
 
     using TBindings = PipelineResourceSignatureGLImpl::TBindings;
@@ -101,6 +109,8 @@ private:
         const TShaderStages& ShaderStages,
         SHADER_TYPE          ActiveStages);
 
+    void FinalizeLink();
+
     void Destruct();
 
     SHADER_TYPE GetShaderStageType(Uint32 Index) const;
@@ -129,6 +139,11 @@ private:
 
     TBindings* m_BaseBindings = nullptr; // [m_SignatureCount]
 
+    // Programs that are being linked by the driver when PSO_CREATE_FLAG_ASYNCHRONOUS is used.
+    // Resource layout is initialized once all programs are linked, see FinalizeLink().
+    struct PendingLinkInfo;
+    std::unique_ptr<PendingLinkInfo> m_pPendingLink;
+
 #ifdef DILIGENT_DEVELOPMENT
     // Shader resources for all shaders in all shader stages in the pipeline.
     std::vector<std::shared_ptr<const ShaderResourcesGL>> m_ShaderResources;
@@ -36,6 +36,7 @@
 #include "BaseInterfacesGL.h"
 #include "FBOCache.hpp"
 #include "TexRegionRender.hpp"
+#include "TexRegionCompute.hpp"
 
 namespace Diligent
 {
@@ -118,6 +119,9 @@ public:
     /// Implementation of IRenderDevice::CreateQuery() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE CreateQuery(const QueryDesc& Desc, IQuery** ppQuery) override final;
 
+    /// Implementation of IRenderDevice::CreateQueryArray() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE CreateQueryArray(const QueryArrayDesc& Desc, IQueryArray** ppQueryArray) override final;
+
     /// Implementation of IRenderDevice::CreateRenderPass() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE CreateRenderPass(const RenderPassDesc& Desc,
                                                      IRenderPass**         ppRenderPass) override final;
@@ -183,6 +187,9 @@ public:
     virtual void DILIGENT_CALL_TYPE CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
                                                              IPipelineStateCache**               ppPSOCache) override final;
 
+    /// Implementation of IRenderDevice::GetMemoryBudget() in OpenGL backend.
+    virtual DeviceMemoryBudget DILIGENT_CALL_TYPE GetMemoryBudget() const override final;
+
     /// Implementation of IRenderDevice::GetSparseTextureFormatInfo() in OpenGL backend.
     virtual SparseTextureFormatInfo DILIGENT_CALL_TYPE GetSparseTextureFormatInfo(TEXTURE_FORMAT     TexFormat,
                                                                                   RESOURCE_DIMENSION Dimension,
@@ -209,6 +216,21 @@ public:
     };
     const GLDeviceLimits& GetDeviceLimits() const { return m_DeviceLimits; }
 
+    // Returns true if the driver can link programs in background threads (GL_KHR_parallel_shader_compile).
+    bool IsParallelShaderCompileSupported() const { return m_IsParallelShaderCompileSupported; }
+
+    // Returns true if the driver supports persistently mapped buffers (GL_ARB_buffer_storage).
+    bool IsBufferStorageSupported() const { return m_IsBufferStorageSupported; }
+
+    // Returns true if objects can be modified without binding them (GL_ARB_direct_state_access).
+    bool IsDSASupported() const { return m_IsDSASupported; }
+
+    // Returns true if consecutive binding points can be set with a single call (GL_ARB_multi_bind).
+    bool IsMultiBindSupported() const { return m_IsMultiBindSupported; }
+
+    // Returns true if inverted conditional rendering modes are supported (GL_ARB_conditional_render_inverted).
+    bool IsConditionalRenderInvertedSupported() const { return m_IsConditionalRenderInvertedSupported; }
+
 protected:
     friend class DeviceContextGLImpl;
     friend class TextureBaseGL;
@@ -230,7 +252,11 @@ protected:
     Threading::SpinLock                                          m_FBOCacheLock;
     std::unordered_map<GLContext::NativeGLContextType, FBOCache> m_FBOCache;
 
-    std::unique_ptr<TexRegionRender> m_pTexRegionRender;
+    std::unique_ptr<TexRegionRender>  m_pTexRegionRender;
+    std::unique_ptr<TexRegionCompute> m_pTexRegionCompute;
+
+    const Uint32 m_VAOCacheSize;
+    const Uint32 m_FBOCacheSize;
 
 private:
     virtual void TestTextureFormat(TEXTURE_FORMAT TexFormat) override final;
@@ -241,6 +267,14 @@ private:
     int m_ShowDebugGLOutput = 1;
 
     GLDeviceLimits m_DeviceLimits = {};
+
+    bool m_IsPSOCacheSupported                  = false;
+    bool m_IsParallelShaderCompileSupported     = false;
+    bool m_IsBufferStorageSupported             = false;
+    bool m_IsDSASupported                       = false;
+    bool m_IsMultiBindSupported                 = false;
+    bool m_IsConditionalRenderInvertedSupported = false;
+    bool m_IsNVXMemoryInfoSupported             = false;
 };
 
 } // namespace Diligent
@@ -68,7 +68,27 @@ public:
     /// Implementation of IShader::GetConstantBufferDesc() in OpenGL backend.
     virtual const ShaderCodeBufferDesc* DILIGENT_CALL_TYPE GetConstantBufferDesc(Uint32 Index) const override final;
 
-    static GLObjectWrappers::GLProgramObj LinkProgram(ShaderGLImpl* const* ppShaders, Uint32 NumShaders, bool IsSeparableProgram);
+    /// Links the program from the shaders. If the PSO cache is not null, the program is
+    /// loaded from its binary when possible, and the binary of a new program is added to the cache.
+    static GLObjectWrappers::GLProgramObj LinkProgram(ShaderGLImpl* const*      ppShaders,
+                                                      Uint32                    NumShaders,
+                                                      bool                      IsSeparableProgram,
+                                                      PipelineStateCacheGLImpl* pPSOCache = nullptr);
+
+    /// Submits the program link to the driver without waiting for its result.
+    /// Use GetLinkStatus() to get the result once IsLinkCompleted() returns true.
+    static GLObjectWrappers::GLProgramObj BeginLinkProgram(ShaderGLImpl* const* ppShaders,
+                                                           Uint32               NumShaders,
+                                                           bool                 IsSeparableProgram,
+                                                           bool                 IsBinaryRetrievable);
+
+    /// Returns true if the driver has finished linking the program.
+    /// Requires GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile extension.
+    static bool IsLinkCompleted(GLuint GLProg);
+
+    /// Returns the link status of the program and logs the error if the program failed to link.
+    /// Blocks until the link is completed.
+    static bool GetLinkStatus(GLuint GLProg);
 
     const std::shared_ptr<const ShaderResourcesGL>& GetShaderResources() const { return m_pShaderResources; }
 
@@ -162,20 +162,7 @@ public:
         UB.RangeSize     = StaticCast<Uint32>(RangeSize);
         UB.DynamicOffset = 0;
 
-        Uint64 UBBit = Uint64{1} << Uint64{CacheOffset};
-        if (m_DynamicUBOSlotMask & UBBit)
-        {
-            // Only set the flag for those slots that allow dynamic buffers
-            // (i.e. the variable was not created with NO_DYNAMIC_BUFFERS flag).
-            if (UB.IsDynamic())
-                m_DynamicUBOMask |= UBBit;
-            else
-                m_DynamicUBOMask &= ~UBBit;
-        }
-        else
-        {
-            VERIFY((m_DynamicUBOMask & UBBit) == 0, "Dynamic UBO bit should never be set when corresponding bit in m_DynamicUBOSlotMask is not set");
-        }
+        UpdateDynamicUBOMask(CacheOffset);
         UpdateRevision();
     }
 
@@ -222,20 +209,7 @@ public:
         SSBO.pBufferView   = std::move(pBuffView);
         SSBO.DynamicOffset = 0;
 
-        Uint64 SSBOBit = Uint64{1} << Uint64{CacheOffset};
-        if (m_DynamicSSBOSlotMask & SSBOBit)
-        {
-            // Only set the flag for those slots that allow dynamic buffers
-            // (i.e. the variable was not created with NO_DYNAMIC_BUFFERS flag).
-            if (SSBO.IsDynamic())
-                m_DynamicSSBOMask |= SSBOBit;
-            else
-                m_DynamicSSBOMask &= ~SSBOBit;
-        }
-        else
-        {
-            VERIFY((m_DynamicSSBOMask & SSBOBit) == 0, "Dynamic SSBO bit should never be set when corresponding bit in m_DynamicSSBOSlotMask is not set");
-        }
+        UpdateDynamicSSBOMask(CacheOffset);
         UpdateRevision();
     }
 
@@ -245,6 +219,10 @@ public:
         GetSSBO(CacheOffset).DynamicOffset = DynamicOffset;
     }
 
+    // Copies all resources from SrcCache, which must only contain static resources,
+    // to the same slots of this cache. Slots that have no resource in SrcCache are skipped.
+    // Returns true if all slots of SrcCache have resources bound.
+    bool CopyStaticResources(const ShaderResourceCacheGL& SrcCache);
 
     bool IsUBBound(Uint32 CacheOffset) const
     {
@@ -370,6 +348,42 @@ private:
         return const_cast<CachedSSBO&>(const_cast<const ShaderResourceCacheGL*>(this)->GetConstSSBO(CacheOffset));
     }
 
+    void UpdateDynamicUBOMask(Uint32 CacheOffset)
+    {
+        const Uint64 UBBit = Uint64{1} << Uint64{CacheOffset};
+        if (m_DynamicUBOSlotMask & UBBit)
+        {
+            // Only set the flag for those slots that allow dynamic buffers
+            // (i.e. the variable was not created with NO_DYNAMIC_BUFFERS flag).
+            if (GetConstUB(CacheOffset).IsDynamic())
+                m_DynamicUBOMask |= UBBit;
+            else
+                m_DynamicUBOMask &= ~UBBit;
+        }
+        else
+        {
+            VERIFY((m_DynamicUBOMask & UBBit) == 0, "Dynamic UBO bit should never be set when corresponding bit in m_DynamicUBOSlotMask is not set");
+        }
+    }
+
+    void UpdateDynamicSSBOMask(Uint32 CacheOffset)
+    {
+        const Uint64 SSBOBit = Uint64{1} << Uint64{CacheOffset};
+        if (m_DynamicSSBOSlotMask & SSBOBit)
+        {
+            // Only set the flag for those slots that allow dynamic buffers
+            // (i.e. the variable was not created with NO_DYNAMIC_BUFFERS flag).
+            if (GetConstSSBO(CacheOffset).IsDynamic())
+                m_DynamicSSBOMask |= SSBOBit;
+            else
+                m_DynamicSSBOMask &= ~SSBOBit;
+        }
+        else
+        {
+            VERIFY((m_DynamicSSBOMask & SSBOBit) == 0, "Dynamic SSBO bit should never be set when corresponding bit in m_DynamicSSBOSlotMask is not set");
+        }
+    }
+
 private:
     static constexpr const Uint16 InvalidResourceOffset = 0xFFFF;
     static constexpr const Uint16 m_UBsOffset           = 0;
@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <unordered_map>
+
+namespace Diligent
+{
+
+// Helper class to facilitate texture copying and mip generation with compute shaders
+class TexRegionCompute
+{
+public:
+    TexRegionCompute(class RenderDeviceGLImpl* pDeviceGL);
+
+    // Returns the GLSL image format qualifier for the given format, or null if
+    // the format can't be used with image load/store operations.
+    static const char* GetImageFormatQualifier(TEXTURE_FORMAT Format);
+
+    bool CanCopy(const TextureDesc& SrcTexDesc, const TextureDesc& DstTexDesc) const;
+
+    void Copy(class DeviceContextGLImpl* pCtxGL,
+              ITextureView*              pSrcSRV,
+              ITextureView*              pDstUAV,
+              Int32                      DstToSrcXOffset,
+              Int32                      DstToSrcYOffset,
+              Int32                      SrcZ,
+              Int32                      SrcMipLevel,
+              Uint32                     DstX,
+              Uint32                     DstY,
+              Uint32                     Width,
+              Uint32                     Height);
+
+    bool CanGenerateMips(const TextureDesc& TexDesc, const TextureViewDesc& ViewDesc) const;
+
+    void GenerateMips(class DeviceContextGLImpl* pCtxGL, class TextureViewGLImpl* pTexView);
+
+    void SetStates(class DeviceContextGLImpl* pCtxGL);
+    void RestoreStates(class DeviceContextGLImpl* pCtxGL);
+
+private:
+    struct ComputePipeline
+    {
+        RefCntAutoPtr<IPipelineState>         pPSO;
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    };
+    ComputePipeline& GetCopyPipeline(RESOURCE_DIMENSION SrcType, TEXTURE_FORMAT SrcFormat, TEXTURE_FORMAT DstFormat);
+    ComputePipeline& GetMipPipeline(TEXTURE_FORMAT Format);
+    ComputePipeline  CreatePipeline(const char* Name, const String& Source, bool UseConstants);
+
+    RenderDeviceGLImpl* const m_pDeviceGL;
+
+    RefCntAutoPtr<IBuffer> m_pConstantBuffer;
+
+    // Pipelines are created on first use as the number of
+    // dimension/format combinations is large.
+    std::unordered_map<Uint32, ComputePipeline> m_CopyPipelines;
+    std::unordered_map<Uint32, ComputePipeline> m_MipPipelines;
+
+    RefCntAutoPtr<IPipelineState> m_pOrigPSO;
+    Uint32                        m_OrigStencilRef      = 0;
+    float                         m_OrigBlendFactors[4] = {};
+};
+
+} // namespace Diligent
@@ -59,7 +59,8 @@ public:
                             Uint32                   MipLevel,
                             Uint32                   Slice,
                             const Box&               DstBox,
-                            const TextureSubResData& SubresData) override final;
+                            const TextureSubResData& SubresData,
+                            GLuint                   UploadBuffer = 0) override final;
 
     /// Implementation of TextureBaseGL::AttachToFramebuffer() for 3D texture.
     virtual void AttachToFramebuffer(const struct TextureViewDesc& ViewDesc,
@@ -101,11 +101,17 @@ public:
     /// Implementation of ITexture::GetNativeHandle() in OpenGL backend.
     virtual Uint64 DILIGENT_CALL_TYPE GetNativeHandle() override final { return BitCast<Uint64>(GetGLTextureHandle()); }
 
+    /// Updates the texture subresource region.
+
+    /// \param [in] UploadBuffer - Optional GL buffer object that contains the pixel data at offset SubresData.SrcOffset.
+    ///                            The device context uses it to upload CPU data through the upload ring buffer.
+    ///                            Must be 0 if SubresData.pSrcBuffer or SubresData.pData is not null.
     virtual void UpdateData(class GLContextState&    CtxState,
                             Uint32                   MipLevel,
                             Uint32                   Slice,
                             const Box&               DstBox,
-                            const TextureSubResData& SubresData) = 0;
+                            const TextureSubResData& SubresData,
+                            GLuint                   UploadBuffer = 0) = 0;
 
     static constexpr Uint32 PBOOffsetAlignment = 4;
 
@@ -121,6 +127,9 @@ protected:
 
     void SetDefaultGLParameters();
 
+    // Returns the buffer object the pixel data of UpdateData() are unpacked from, or 0 if the data are in CPU memory.
+    static GLuint GetUnpackBuffer(const TextureSubResData& SubresData, GLuint UploadBuffer);
+
     GLObjectWrappers::GLTextureObj m_GlTexture;
     RefCntAutoPtr<IBuffer>         m_pPBO; // For staging textures
     const GLenum                   m_BindTarget;
@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::UploadRingBufferGL class
+
+#include <deque>
+#include <utility>
+
+#include "GLObjectWrapper.hpp"
+#include "RingBuffer.hpp"
+
+namespace Diligent
+{
+
+class GLContextState;
+
+/// Persistently mapped coherent ring buffer that is used by the device context to
+/// stream CPU data into buffers and textures without going through glMapBufferRange(),
+/// glBufferSubData() or glTexSubImage*() from CPU memory.
+///
+/// \remarks    The CPU writes the data into the ring buffer memory, and the context then
+///             copies it to the destination buffer with glCopyBufferSubData(), or unpacks it
+///             to the destination texture with the ring buffer bound to GL_PIXEL_UNPACK_BUFFER.
+///             The space is recycled when the fence inserted by FinishFrame() is signaled.
+///             Requires GL 4.4, GL_ARB_buffer_storage or GL_EXT_buffer_storage.
+class UploadRingBufferGL
+{
+public:
+    UploadRingBufferGL(Uint64 Size, bool IsSupported) noexcept;
+    ~UploadRingBufferGL();
+
+    // clang-format off
+    UploadRingBufferGL             (const UploadRingBufferGL&)  = delete;
+    UploadRingBufferGL             (      UploadRingBufferGL&&) = delete;
+    UploadRingBufferGL& operator = (const UploadRingBufferGL&)  = delete;
+    UploadRingBufferGL& operator = (      UploadRingBufferGL&&) = delete;
+    // clang-format on
+
+    struct Allocation
+    {
+        const GLObjectWrappers::GLBufferObj* pBuffer = nullptr;
+
+        Uint64 Offset      = 0;
+        void*  pCPUAddress = nullptr;
+
+        explicit operator bool() const { return pCPUAddress != nullptr; }
+    };
+
+    /// Allocates space in the ring buffer. If the ring buffer is full, waits until the GPU
+    /// releases the oldest frame. Returns an empty allocation if the ring buffer is not supported,
+    /// or if the size is too large to be streamed through the ring buffer.
+    Allocation Allocate(GLContextState& CtxState, Uint64 Size);
+
+    /// Inserts a fence that is signaled when the GPU is done with all allocations
+    /// made since the previous call.
+    void FinishFrame();
+
+    /// Returns the index of the frame the allocations are currently made in.
+    Uint64 GetCurrentFrame() const { return m_NextFenceValue; }
+
+    /// Waits until the GPU is done with all allocations made in the given frame.
+    void WaitForFrame(Uint64 Frame);
+
+    /// Returns the total size of allocations made since the last call and resets the counter.
+    Uint64 ExtractAllocatedSize() { return std::exchange(m_AllocatedSize, Uint64{0}); }
+
+private:
+    bool Initialize(GLContextState& CtxState);
+    void ReleaseCompletedFrames();
+
+    const Uint64 m_Size;
+
+    // Set to false if the buffer could not be created, so that creation is not attempted again.
+    bool m_IsSupported;
+
+    GLObjectWrappers::GLBufferObj m_Buffer{false};
+    Uint8*                        m_pMappedData = nullptr;
+
+    RingBuffer m_RingBuffer;
+
+    std::deque<std::pair<Uint64, GLObjectWrappers::GLSyncObj>> m_PendingFences;
+
+    Uint64 m_NextFenceValue      = 1;
+    Uint64 m_CompletedFenceValue = 0;
+
+    Uint64 m_AllocatedSize = 0;
+};
+
+} // namespace Diligent
@@ -29,7 +29,9 @@
 
 #include <cstring>
 #include <vector>
+#include <list>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "GraphicsTypes.h"
 #include "Buffer.h"
@@ -47,7 +49,9 @@ class BufferGLImpl;
 class VAOCache
 {
 public:
-    VAOCache();
+    // MaxSize is the maximum number of VAOs in the cache. When the limit is reached,
+    // the least recently used VAO is released. Zero means no limit.
+    explicit VAOCache(Uint32 MaxSize);
     ~VAOCache();
 
     // clang-format off
@@ -117,14 +121,36 @@ private:
         };
     };
 
-    // Clears stale entries from m_PSOToKey and m_BuffToKey when a VAO is removed from m_Cache
-    void ClearStaleKeys(const std::vector<VAOHashKey>& StaleKeys);
+    // Keys are stored in m_Cache only. Other containers reference them by pointers,
+    // which remain valid until the element is erased from the map.
+    using LRUListType = std::list<const VAOHashKey*>;
 
-    Threading::SpinLock                                                                    m_CacheLock;
-    std::unordered_map<VAOHashKey, GLObjectWrappers::GLVertexArrayObj, VAOHashKey::Hasher> m_Cache;
+    struct CacheEntry
+    {
+        GLObjectWrappers::GLVertexArrayObj VAO;
+        LRUListType::iterator              LRUIt;
+    };
+    using CacheType = std::unordered_map<VAOHashKey, CacheEntry, VAOHashKey::Hasher>;
+
+    // Maps PSO or buffer unique ID to all keys that use this object
+    using IdToKeysMapType = std::unordered_map<UniqueIdentifier, std::unordered_set<const VAOHashKey*>>;
+
+    // Removes the VAO from the cache along with all references to its key
+    void RemoveVAO(CacheType::iterator It);
+
+    // Removes all VAOs that use the object with the given ID
+    void RemoveVAOs(UniqueIdentifier ObjectId, IdToKeysMapType& IdToKeys);
+
+    const Uint32 m_MaxSize;
+
+    Threading::SpinLock m_CacheLock;
+    CacheType           m_Cache;
+
+    // The most recently used VAO is at the front of the list
+    LRUListType m_LRUList;
 
-    std::unordered_multimap<UniqueIdentifier, VAOHashKey> m_PSOToKey;
-    std::unordered_multimap<UniqueIdentifier, VAOHashKey> m_BuffToKey;
+    IdToKeysMapType m_PSOToKeys;
+    IdToKeysMapType m_BuffToKeys;
 
     // Any draw command fails if no VAO is bound. We will use this empty
     // VAO for draw commands with null input layout, such as these that
@@ -40,6 +40,20 @@ struct ISwapChainGL;
 static const INTERFACE_ID IID_DeviceContextGL =
     {0x3464fdf1, 0xc548, 0x4935, {0x96, 0xc3, 0xb4, 0x54, 0xc9, 0xdf, 0x6f, 0x6a}};
 
+// clang-format off
+/// GL state cache statistics, see IDeviceContextGL::GetStateCacheStats().
+struct GLStateCacheStats
+{
+    /// The number of state-changing GL calls that were issued to the driver.
+    Uint64 IssuedCalls   DEFAULT_INITIALIZER(0);
+
+    /// The number of redundant state-changing GL calls that were filtered out
+    /// by the state cache because the requested state was already set.
+    Uint64 FilteredCalls DEFAULT_INITIALIZER(0);
+};
+// clang-format on
+typedef struct GLStateCacheStats GLStateCacheStats;
+
 #define DILIGENT_INTERFACE_NAME IDeviceContextGL
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -65,6 +79,14 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContextGL, IDeviceContext)
     /// to obtain the default FBO handle.
     VIRTUAL void METHOD(SetSwapChain)(THIS_
                                       struct ISwapChainGL* pSwapChain) PURE;
+
+    /// Returns the GL state cache statistics accumulated since the context was created
+    /// or since the last call to IDeviceContextGL::ResetStateCacheStats().
+    VIRTUAL void METHOD(GetStateCacheStats)(THIS_
+                                            GLStateCacheStats REF Stats) CONST PURE;
+
+    /// Resets the GL state cache statistics.
+    VIRTUAL void METHOD(ResetStateCacheStats)(THIS) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -74,8 +96,10 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IDeviceContextGL_UpdateCurrentGLContext(This) CALL_IFACE_METHOD(DeviceContextGL, UpdateCurrentGLContext, This)
-#    define IDeviceContextGL_SetSwapChain(This, ...)      CALL_IFACE_METHOD(DeviceContextGL, SetSwapChain,           This, __VA_ARGS__)
+#    define IDeviceContextGL_UpdateCurrentGLContext(This)    CALL_IFACE_METHOD(DeviceContextGL, UpdateCurrentGLContext, This)
+#    define IDeviceContextGL_SetSwapChain(This, ...)         CALL_IFACE_METHOD(DeviceContextGL, SetSwapChain,           This, __VA_ARGS__)
+#    define IDeviceContextGL_GetStateCacheStats(This, ...)   CALL_IFACE_METHOD(DeviceContextGL, GetStateCacheStats,     This, __VA_ARGS__)
+#    define IDeviceContextGL_ResetStateCacheStats(This)      CALL_IFACE_METHOD(DeviceContextGL, ResetStateCacheStats,   This)
 
 // clang-format on
 
@@ -214,7 +214,7 @@ BufferGLImpl::~BufferGLImpl()
 
 IMPLEMENT_QUERY_INTERFACE(BufferGLImpl, IID_BufferGL, TBufferBase)
 
-void BufferGLImpl::UpdateData(GLContextState& CtxState, Uint64 Offset, Uint64 Size, const void* pData)
+void BufferGLImpl::UpdateData(GLContextState& CtxState, UploadRingBufferGL& UploadRing, Uint64 Offset, Uint64 Size, const void* pData)
 {
     BufferMemoryBarrier(
         MEMORY_BARRIER_BUFFER_UPDATE, // Reads or writes to buffer objects via any OpenGL API functions that allow
@@ -223,6 +223,24 @@ void BufferGLImpl::UpdateData(GLContextState& CtxState, Uint64 Offset, Uint64 Si
                                       // the completion of any shader writes to the same memory initiated prior to the barrier.
         CtxState);
 
+    // Write the data into the persistently mapped upload ring and let the GPU copy it.
+    // This avoids the implicit synchronization glBufferSubData() may incur when the buffer is in use.
+    if (auto Alloc = UploadRing.Allocate(CtxState, Size))
+    {
+        memcpy(Alloc.pCPUAddress, pData, StaticCast<size_t>(Size));
+        CopyBufferSubData(CtxState, *Alloc.pBuffer, Alloc.Offset, Offset, Size);
+        return;
+    }
+
+    if (CtxState.GetContextCaps().IsDSASupported)
+    {
+        // Direct state access does not require binding the buffer and thus
+        // does not disturb the VAO and buffer bindings.
+        glNamedBufferSubData(m_GlBuffer, StaticCast<GLintptr>(Offset), StaticCast<GLsizeiptr>(Size), pData);
+        CHECK_GL_ERROR("glNamedBufferSubData() failed");
+        return;
+    }
+
     // We must unbind VAO because otherwise we will break the bindings
     constexpr bool ResetVAO = true;
     CtxState.BindBuffer(GL_ARRAY_BUFFER, m_GlBuffer, ResetVAO);
@@ -246,27 +264,70 @@ void BufferGLImpl::CopyData(GLContextState& CtxState, BufferGLImpl& SrcBufferGL,
         MEMORY_BARRIER_BUFFER_UPDATE,
         CtxState);
 
+    CopyBufferSubData(CtxState, SrcBufferGL.m_GlBuffer, SrcOffset, DstOffset, Size);
+}
+
+void BufferGLImpl::CopyBufferSubData(GLContextState& CtxState, const GLObjectWrappers::GLBufferObj& SrcBuffer, Uint64 SrcOffset, Uint64 DstOffset, Uint64 Size)
+{
     // Whilst glCopyBufferSubData() can be used to copy data between buffers bound to any two targets,
     // the targets GL_COPY_READ_BUFFER and GL_COPY_WRITE_BUFFER are provided specifically for this purpose.
     // Neither target is used for anything else by OpenGL, and so you can safely bind buffers to them for
     // the purposes of copying or staging data without disturbing OpenGL state or needing to keep track of
     // what was bound to the target before your copy.
+    if (CtxState.GetContextCaps().IsDSASupported)
+    {
+        glCopyNamedBufferSubData(SrcBuffer, m_GlBuffer, StaticCast<GLintptr>(SrcOffset), StaticCast<GLintptr>(DstOffset), StaticCast<GLsizeiptr>(Size));
+        CHECK_GL_ERROR("glCopyNamedBufferSubData() failed");
+        return;
+    }
+
     constexpr bool ResetVAO = false; // No need to reset VAO for READ/WRITE targets
     CtxState.BindBuffer(GL_COPY_WRITE_BUFFER, m_GlBuffer, ResetVAO);
-    CtxState.BindBuffer(GL_COPY_READ_BUFFER, SrcBufferGL.m_GlBuffer, ResetVAO);
+    CtxState.BindBuffer(GL_COPY_READ_BUFFER, SrcBuffer, ResetVAO);
     glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, StaticCast<GLintptr>(SrcOffset), StaticCast<GLintptr>(DstOffset), StaticCast<GLsizeiptr>(Size));
     CHECK_GL_ERROR("glCopyBufferSubData() failed");
     CtxState.BindBuffer(GL_COPY_READ_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
     CtxState.BindBuffer(GL_COPY_WRITE_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
 }
 
-void BufferGLImpl::Map(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapFlags, PVoid& pMappedData)
+void BufferGLImpl::Map(GLContextState& CtxState, UploadRingBufferGL& UploadRing, MAP_TYPE MapType, Uint32 MapFlags, PVoid& pMappedData)
 {
-    MapRange(CtxState, MapType, MapFlags, 0, m_Desc.Size, pMappedData);
+    MapRange(CtxState, UploadRing, MapType, MapFlags, 0, m_Desc.Size, pMappedData);
 }
 
-void BufferGLImpl::MapRange(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapFlags, Uint64 Offset, Uint64 Length, PVoid& pMappedData)
+void BufferGLImpl::MapRange(GLContextState& CtxState, UploadRingBufferGL& UploadRing, MAP_TYPE MapType, Uint32 MapFlags, Uint64 Offset, Uint64 Length, PVoid& pMappedData)
 {
+    if (MapType == MAP_WRITE && m_Desc.Usage == USAGE_DYNAMIC && m_UseUploadRing)
+    {
+        if (MapFlags & MAP_FLAG_DISCARD)
+        {
+            // The new contents are written into the persistently mapped upload ring, which
+            // makes the update a plain memcpy. The space for the entire buffer is allocated so that
+            // subsequent no-overwrite maps in the same frame can write to the same allocation.
+            m_UploadRingAlloc = UploadRing.Allocate(CtxState, m_Desc.Size);
+            m_UploadRingFrame = UploadRing.GetCurrentFrame();
+        }
+        else if (m_UploadRingAlloc && m_UploadRingFrame != UploadRing.GetCurrentFrame())
+        {
+            // The allocation from the previous frame may be recycled, and its copy to the buffer
+            // may still be pending. Wait for the copy since the buffer is going to be written
+            // without synchronization, and map the buffer directly from now on.
+            UploadRing.WaitForFrame(m_UploadRingFrame);
+            m_UploadRingAlloc = {};
+            m_UseUploadRing   = false;
+        }
+
+        if (m_UploadRingAlloc)
+        {
+            m_UploadRingMappedOffset = Offset;
+            m_UploadRingMappedSize   = Length;
+            m_IsMappedFromUploadRing = true;
+
+            pMappedData = static_cast<Uint8*>(m_UploadRingAlloc.pCPUAddress) + Offset;
+            return;
+        }
+    }
+
     BufferMemoryBarrier(
         MEMORY_BARRIER_CLIENT_MAPPED_BUFFER, // Access by the client to persistent mapped regions of buffer
                                              // objects will reflect data written by shaders prior to the barrier.
@@ -328,6 +389,15 @@ void BufferGLImpl::MapRange(GLContextState& CtxState, MAP_TYPE MapType, Uint32 M
 
 void BufferGLImpl::Unmap(GLContextState& CtxState)
 {
+    if (m_IsMappedFromUploadRing)
+    {
+        VERIFY_EXPR(m_UploadRingAlloc);
+        BufferMemoryBarrier(MEMORY_BARRIER_BUFFER_UPDATE, CtxState);
+        CopyBufferSubData(CtxState, *m_UploadRingAlloc.pBuffer, m_UploadRingAlloc.Offset + m_UploadRingMappedOffset, m_UploadRingMappedOffset, m_UploadRingMappedSize);
+        m_IsMappedFromUploadRing = false;
+        return;
+    }
+
     constexpr bool ResetVAO = true;
     CtxState.BindBuffer(m_BindTarget, m_GlBuffer, ResetVAO);
     auto Result = glUnmapBuffer(m_BindTarget);
@@ -49,6 +49,7 @@
 #include "PipelineStateGLImpl.hpp"
 #include "FenceGLImpl.hpp"
 #include "ShaderResourceBindingGLImpl.hpp"
+#include "CommandListGLImpl.hpp"
 
 #include "GLTypeConversions.hpp"
 #include "VAOCache.hpp"
@@ -69,7 +70,9 @@ DeviceContextGLImpl::DeviceContextGLImpl(IReferenceCounters*      pRefCounters,
         Desc
     },
     m_ContextState{pDeviceGL},
-    m_DefaultFBO  {false    }
+    m_UploadRing  {UploadRingSize, pDeviceGL->IsBufferStorageSupported()},
+    m_DefaultFBO  {false    },
+    m_CmdListAllocator{GetRawAllocator(), sizeof(CommandListGLImpl), 64}
 // clang-format on
 {
     m_BoundWritableTextures.reserve(16);
@@ -81,19 +84,40 @@ IMPLEMENT_QUERY_INTERFACE(DeviceContextGLImpl, IID_DeviceContextGL, TDeviceConte
 
 void DeviceContextGLImpl::Begin(Uint32 ImmediateContextId)
 {
-    UNEXPECTED("OpenGL does not support deferred contexts");
-    (void)(ImmediateContextId);
+    DEV_CHECK_ERR(ImmediateContextId == 0, "OpenGL supports only one immediate context");
+    TDeviceContextBase::Begin(DeviceContextIndex{ImmediateContextId}, COMMAND_QUEUE_TYPE_GRAPHICS);
+    VERIFY(m_DeferredCommands.GetNumCommands() == 0, "The command stream must be empty at the beginning of the recording");
+}
+
+void DeviceContextGLImpl::BeginReusable(Uint32 ImmediateContextId)
+{
+    Begin(ImmediateContextId);
+    // Replaying the command list does not consume it,
+    // so it can be executed any number of times.
+    m_IsRecordingReusableCommands = true;
 }
 
 void DeviceContextGLImpl::SetPipelineState(IPipelineState* pPipelineState)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_SET_PIPELINE_STATE);
+
+    if (IsDeferred())
+        return RecordDeferredCommand({pPipelineState}, [pPipelineState](DeviceContextGLImpl& Ctx) { Ctx.SetPipelineState(pPipelineState); });
+
     VERIFY_EXPR(pPipelineState != nullptr);
 
+    // Avoid QueryInterface and AddRef/Release when the same PSO is bound again
+    if (IsBoundPipelineState(pPipelineState))
+        return;
+
     RefCntAutoPtr<PipelineStateGLImpl> pPipelineStateGLImpl{pPipelineState, PipelineStateGLImpl::IID_InternalImpl};
     VERIFY(pPipelineState == nullptr || pPipelineStateGLImpl != nullptr, "Unknown pipeline state object implementation");
     if (PipelineStateGLImpl::IsSameObject(m_pPipelineState, pPipelineStateGLImpl))
         return;
 
+    DEV_CHECK_ERR(pPipelineStateGLImpl->GetStatus(false) == PIPELINE_STATE_STATUS_READY, "Pipeline state '", pPipelineStateGLImpl->GetDesc().Name,
+                  "' is not ready and can't be bound. Use IPipelineState::GetStatus() to check the pipeline status.");
+
     TDeviceContextBase::SetPipelineState(std::move(pPipelineStateGLImpl), 0 /*Dummy*/);
 
     const auto& Desc = m_pPipelineState->GetDesc();
@@ -171,11 +195,27 @@ void DeviceContextGLImpl::SetPipelineState(IPipelineState* pPipelineState)
 
 void DeviceContextGLImpl::TransitionShaderResources(IPipelineState* pPipelineState, IShaderResourceBinding* pShaderResourceBinding)
 {
+    if (IsDeferred())
+    {
+        return RecordDeferredCommand({pPipelineState, pShaderResourceBinding}, [pPipelineState, pShaderResourceBinding](DeviceContextGLImpl& Ctx) {
+            Ctx.TransitionShaderResources(pPipelineState, pShaderResourceBinding);
+        });
+    }
+
     DEV_CHECK_ERR(!m_pActiveRenderPass, "State transitions are not allowed inside a render pass.");
 }
 
 void DeviceContextGLImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_COMMIT_SHADER_RESOURCES);
+
+    if (IsDeferred())
+    {
+        return RecordDeferredCommand({pShaderResourceBinding}, [pShaderResourceBinding, StateTransitionMode](DeviceContextGLImpl& Ctx) {
+            Ctx.CommitShaderResources(pShaderResourceBinding, StateTransitionMode);
+        });
+    }
+
     DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0);
 
     auto* const pShaderResBindingGL = ClassPtrCast<ShaderResourceBindingGLImpl>(pShaderResourceBinding);
@@ -190,6 +230,9 @@ void DeviceContextGLImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
 
 void DeviceContextGLImpl::SetStencilRef(Uint32 StencilRef)
 {
+    if (IsDeferred())
+        return RecordDeferredCommand([StencilRef](DeviceContextGLImpl& Ctx) { Ctx.SetStencilRef(StencilRef); });
+
     if (TDeviceContextBase::SetStencilRef(StencilRef, 0))
     {
         m_ContextState.SetStencilRef(GL_FRONT, StencilRef);
@@ -199,6 +242,12 @@ void DeviceContextGLImpl::SetStencilRef(Uint32 StencilRef)
 
 void DeviceContextGLImpl::SetBlendFactors(const float* pBlendFactors)
 {
+    if (IsDeferred())
+    {
+        const auto* pFactors = m_DeferredCommands.Copy(pBlendFactors, 4);
+        return RecordDeferredCommand([pFactors](DeviceContextGLImpl& Ctx) { Ctx.SetBlendFactors(pFactors); });
+    }
+
     if (TDeviceContextBase::SetBlendFactors(pBlendFactors, 0))
     {
         m_ContextState.SetBlendFactors(m_BlendFactors);
@@ -212,12 +261,26 @@ void DeviceContextGLImpl::SetVertexBuffers(Uint32                         StartS
                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                            SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
+    if (IsDeferred())
+    {
+        auto*       ppBuffersCopy = m_DeferredCommands.Copy(ppBuffers, NumBuffersSet);
+        const auto* pOffsetsCopy  = m_DeferredCommands.Copy(pOffsets, NumBuffersSet);
+        for (Uint32 i = 0; ppBuffers != nullptr && i < NumBuffersSet; ++i)
+            m_DeferredCommands.KeepAlive(ppBuffers[i]);
+        return RecordDeferredCommand([=](DeviceContextGLImpl& Ctx) {
+            Ctx.SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffersCopy, pOffsetsCopy, StateTransitionMode, Flags);
+        });
+    }
+
     TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
     m_ContextState.InvalidateVAO();
 }
 
 void DeviceContextGLImpl::InvalidateState()
 {
+    if (IsDeferred())
+        return RecordDeferredCommand([](DeviceContextGLImpl& Ctx) { Ctx.InvalidateState(); });
+
     TDeviceContextBase::InvalidateState();
 
     m_ContextState.Invalidate();
@@ -229,12 +292,23 @@ void DeviceContextGLImpl::InvalidateState()
 
 void DeviceContextGLImpl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        return RecordDeferredCommand({pIndexBuffer}, [=](DeviceContextGLImpl& Ctx) { Ctx.SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode); });
+    }
+
     TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
     m_ContextState.InvalidateVAO();
 }
 
 void DeviceContextGLImpl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
+    if (IsDeferred())
+    {
+        const auto* pViewportsCopy = m_DeferredCommands.Copy(pViewports, NumViewports);
+        return RecordDeferredCommand([=](DeviceContextGLImpl& Ctx) { Ctx.SetViewports(NumViewports, pViewportsCopy, RTWidth, RTHeight); });
+    }
+
     TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
 
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
@@ -298,6 +372,12 @@ void DeviceContextGLImpl::SetViewports(Uint32 NumViewports, const Viewport* pVie
 
 void DeviceContextGLImpl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
+    if (IsDeferred())
+    {
+        const auto* pRectsCopy = m_DeferredCommands.Copy(pRects, NumRects);
+        return RecordDeferredCommand([=](DeviceContextGLImpl& Ctx) { Ctx.SetScissorRects(NumRects, pRectsCopy, RTWidth, RTHeight); });
+    }
+
     TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
 
     VERIFY(NumRects == m_NumScissorRects, "Unexpected number of scissor rects");
@@ -398,8 +478,26 @@ void DeviceContextGLImpl::CommitRenderTargets()
 
 void DeviceContextGLImpl::SetRenderTargetsExt(const SetRenderTargetsAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        auto AttribsCopy            = Attribs;
+        AttribsCopy.ppRenderTargets = m_DeferredCommands.Copy(Attribs.ppRenderTargets, Attribs.NumRenderTargets);
+        for (Uint32 rt = 0; Attribs.ppRenderTargets != nullptr && rt < Attribs.NumRenderTargets; ++rt)
+            m_DeferredCommands.KeepAlive(Attribs.ppRenderTargets[rt]);
+        return RecordDeferredCommand({Attribs.pDepthStencil, Attribs.pShadingRateMap}, [AttribsCopy](DeviceContextGLImpl& Ctx) { Ctx.SetRenderTargetsExt(AttribsCopy); });
+    }
+
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Calling SetRenderTargets inside active render pass is invalid. End the render pass first");
 
+    if (m_DiscardDepthStencil && m_pBoundDepthStencil)
+    {
+        bool RenderTargetsChange = Attribs.pDepthStencil != m_pBoundDepthStencil || Attribs.NumRenderTargets != m_NumBoundRenderTargets;
+        for (Uint32 rt = 0; rt < Attribs.NumRenderTargets && !RenderTargetsChange; ++rt)
+            RenderTargetsChange = Attribs.ppRenderTargets[rt] != m_pBoundRenderTargets[rt];
+        if (RenderTargetsChange)
+            InvalidateDepthStencil();
+    }
+
     if (TDeviceContextBase::SetRenderTargets(Attribs))
     {
         if (m_NumBoundRenderTargets == 1 && m_pBoundRenderTargets[0] && m_pBoundRenderTargets[0]->GetTexture<TextureBaseGL>()->GetGLHandle() == 0)
@@ -421,15 +519,51 @@ void DeviceContextGLImpl::SetRenderTargetsExt(const SetRenderTargetsAttribs& Att
 
         CommitRenderTargets();
     }
+
+    m_DiscardDepthStencil = Attribs.DiscardDepthStencil && m_pBoundDepthStencil;
 }
 
 void DeviceContextGLImpl::ResetRenderTargets()
 {
+    if (m_DiscardDepthStencil && m_pBoundDepthStencil && !IsDeferred())
+        InvalidateDepthStencil();
+
     TDeviceContextBase::ResetRenderTargets();
-    m_IsDefaultFBOBound = false;
+    m_IsDefaultFBOBound   = false;
+    m_DiscardDepthStencil = false;
     m_ContextState.InvalidateFBO();
 }
 
+void DeviceContextGLImpl::InvalidateDepthStencil()
+{
+    VERIFY_EXPR(m_pBoundDepthStencil && m_pActiveRenderPass == nullptr);
+    m_DiscardDepthStencil = false;
+
+    if (glInvalidateFramebuffer == nullptr)
+        return;
+
+    // The framebuffer must be invalidated while it is bound, and other commands may have bound another one.
+    // Note that this resets the viewport, which is also done when the new render targets are set.
+    CommitRenderTargets();
+
+    const auto& FmtAttribs = GetTextureFormatAttribs(m_pBoundDepthStencil->GetDesc().Format);
+
+    GLsizei               Count = 0;
+    std::array<GLenum, 2> Attachments;
+    if (m_IsDefaultFBOBound)
+    {
+        Attachments[Count++] = GL_DEPTH;
+        if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+            Attachments[Count++] = GL_STENCIL;
+    }
+    else
+    {
+        Attachments[Count++] = FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH ? GL_DEPTH_ATTACHMENT : GL_DEPTH_STENCIL_ATTACHMENT;
+    }
+    glInvalidateFramebuffer(GL_DRAW_FRAMEBUFFER, Count, Attachments.data());
+    DEV_CHECK_GL_ERROR("glInvalidateFramebuffer() failed");
+}
+
 void DeviceContextGLImpl::BeginSubpass()
 {
     VERIFY_EXPR(m_pActiveRenderPass);
@@ -607,6 +741,13 @@ void DeviceContextGLImpl::EndSubpass()
 
 void DeviceContextGLImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        auto AttribsCopy         = Attribs;
+        AttribsCopy.pClearValues = m_DeferredCommands.Copy(Attribs.pClearValues, Attribs.ClearValueCount);
+        return RecordDeferredCommand({Attribs.pRenderPass, Attribs.pFramebuffer}, [AttribsCopy](DeviceContextGLImpl& Ctx) { Ctx.BeginRenderPass(AttribsCopy); });
+    }
+
     TDeviceContextBase::BeginRenderPass(Attribs);
 
     m_AttachmentClearValues.resize(Attribs.ClearValueCount);
@@ -622,6 +763,9 @@ void DeviceContextGLImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
 
 void DeviceContextGLImpl::NextSubpass()
 {
+    if (IsDeferred())
+        return RecordDeferredCommand([](DeviceContextGLImpl& Ctx) { Ctx.NextSubpass(); });
+
     EndSubpass();
     TDeviceContextBase::NextSubpass();
     BeginSubpass();
@@ -630,6 +774,9 @@ void DeviceContextGLImpl::NextSubpass()
 
 void DeviceContextGLImpl::EndRenderPass()
 {
+    if (IsDeferred())
+        return RecordDeferredCommand([](DeviceContextGLImpl& Ctx) { Ctx.EndRenderPass(); });
+
     EndSubpass();
     TDeviceContextBase::EndRenderPass();
     m_ContextState.InvalidateFBO();
@@ -659,6 +806,8 @@ void DeviceContextGLImpl::BindProgramResources(Uint32 BindSRBMask)
 
     m_CommittedResourcesTentativeBarriers = MEMORY_BARRIER_NONE;
 
+    // Commit bindings of all SRBs to contiguous ranges of binding points with as few calls as possible
+    m_ContextState.BeginBindBatch();
     while (BindSRBMask != 0)
     {
         auto SignBit = ExtractLSB(BindSRBMask);
@@ -683,6 +832,7 @@ void DeviceContextGLImpl::BindProgramResources(Uint32 BindSRBMask)
             pResourceCache->BindDynamicBuffers(GetContextState(), BaseBindings);
         }
     }
+    m_ContextState.EndBindBatch();
     m_BindInfo.StaleSRBMask &= ~m_BindInfo.ActiveSRBMask;
 
 
@@ -721,6 +871,9 @@ void DeviceContextGLImpl::PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, GLenu
     // The program might have changed since the last SetPipelineState call if a shader was
     // created after the call (ShaderResourcesGL needs to bind a program to load uniforms).
     m_pPipelineState->CommitProgram(m_ContextState);
+    // Inline constants must be updated before the VAO is bound as mapping a buffer resets the VAO
+    if ((m_BindInfo.InlineConstantsSRBMask & m_BindInfo.ActiveSRBMask) != 0)
+        UpdateInlineConstantBuffers(m_BindInfo);
     if (Uint32 BindSRBMask = m_BindInfo.GetCommitMask(Flags & DRAW_FLAG_DYNAMIC_RESOURCE_BUFFERS_INTACT))
     {
         BindProgramResources(BindSRBMask);
@@ -797,7 +950,15 @@ void DeviceContextGLImpl::PostDraw()
 
 void DeviceContextGLImpl::Draw(const DrawAttribs& Attribs)
 {
-    DvpVerifyDrawArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+
+    if (IsDeferred())
+        return RecordDeferredCommand([Attribs](DeviceContextGLImpl& Ctx) { Ctx.Draw(Attribs); });
+
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawArguments(Attribs))
+        return;
 
     GLenum GlTopology;
     PrepareForDraw(Attribs.Flags, false, GlTopology);
@@ -823,7 +984,15 @@ void DeviceContextGLImpl::Draw(const DrawAttribs& Attribs)
 
 void DeviceContextGLImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
-    DvpVerifyDrawIndexedArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+
+    if (IsDeferred())
+        return RecordDeferredCommand([Attribs](DeviceContextGLImpl& Ctx) { Ctx.DrawIndexed(Attribs); });
+
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawIndexedArguments(Attribs))
+        return;
 
     GLenum GlTopology;
     PrepareForDraw(Attribs.Flags, true, GlTopology);
@@ -908,7 +1077,15 @@ void DeviceContextGLImpl::PrepareForIndirectDrawCount(IBuffer* pCountBuffer)
 
 void DeviceContextGLImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 {
-    DvpVerifyDrawIndirectArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+
+    if (IsDeferred())
+        return RecordDeferredCommand({Attribs.pAttribsBuffer, Attribs.pCounterBuffer}, [Attribs](DeviceContextGLImpl& Ctx) { Ctx.DrawIndirect(Attribs); });
+
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawIndirectArguments(Attribs))
+        return;
 
     GLenum GlTopology;
     PrepareForDraw(Attribs.Flags, true, GlTopology);
@@ -982,7 +1159,15 @@ void DeviceContextGLImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 
 void DeviceContextGLImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs)
 {
-    DvpVerifyDrawIndexedIndirectArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+
+    if (IsDeferred())
+        return RecordDeferredCommand({Attribs.pAttribsBuffer, Attribs.pCounterBuffer}, [Attribs](DeviceContextGLImpl& Ctx) { Ctx.DrawIndexedIndirect(Attribs); });
+
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawIndexedIndirectArguments(Attribs))
+        return;
 
     GLenum GlTopology;
     PrepareForDraw(Attribs.Flags, true, GlTopology);
@@ -1063,23 +1248,202 @@ void DeviceContextGLImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
 
 void DeviceContextGLImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
     UNSUPPORTED("DrawMesh is not supported in OpenGL");
 }
 
 void DeviceContextGLImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
     UNSUPPORTED("DrawMeshIndirect is not supported in OpenGL");
 }
 
+void DeviceContextGLImpl::MultiDraw(const MultiDrawAttribs& Attribs)
+{
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+
+    if (IsDeferred())
+    {
+        auto AttribsCopy       = Attribs;
+        AttribsCopy.pDrawItems = m_DeferredCommands.Copy(Attribs.pDrawItems, Attribs.DrawCount);
+        return RecordDeferredCommand([AttribsCopy](DeviceContextGLImpl& Ctx) { Ctx.MultiDraw(AttribsCopy); });
+    }
+
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyMultiDrawArguments(Attribs))
+        return;
+
+    GLenum GlTopology;
+    PrepareForDraw(Attribs.Flags, false, GlTopology);
+
+    if (Attribs.DrawCount > 0 && Attribs.NumInstances > 0)
+    {
+        const bool IsInstanced = Attribs.NumInstances > 1 || Attribs.FirstInstanceLocation != 0;
+
+        bool NativeMultiDrawExecuted = false;
+#if GL_VERSION_3_2
+        // There is no instanced version of glMultiDrawArrays
+        if (!IsInstanced && (m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW) != 0)
+        {
+            auto& Counts = m_MultiDrawScratch.Counts;
+            auto& Firsts = m_MultiDrawScratch.FirstsOrBaseVertices;
+            Counts.resize(Attribs.DrawCount);
+            Firsts.resize(Attribs.DrawCount);
+            for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+            {
+                const auto& Item = Attribs.pDrawItems[i];
+                Counts[i]        = static_cast<GLsizei>(Item.NumVertices);
+                Firsts[i]        = static_cast<GLint>(Item.StartVertexLocation);
+            }
+            glMultiDrawArrays(GlTopology, Firsts.data(), Counts.data(), static_cast<GLsizei>(Attribs.DrawCount));
+            DEV_CHECK_GL_ERROR("glMultiDrawArrays() failed");
+            NativeMultiDrawExecuted = true;
+        }
+#endif
+
+        if (!NativeMultiDrawExecuted)
+        {
+            for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+            {
+                const auto& Item = Attribs.pDrawItems[i];
+                if (Item.NumVertices == 0)
+                    continue;
+
+                if (IsInstanced)
+                {
+                    if (Attribs.FirstInstanceLocation != 0)
+                        glDrawArraysInstancedBaseInstance(GlTopology, Item.StartVertexLocation, Item.NumVertices, Attribs.NumInstances, Attribs.FirstInstanceLocation);
+                    else
+                        glDrawArraysInstanced(GlTopology, Item.StartVertexLocation, Item.NumVertices, Attribs.NumInstances);
+                }
+                else
+                {
+                    glDrawArrays(GlTopology, Item.StartVertexLocation, Item.NumVertices);
+                }
+            }
+            DEV_CHECK_GL_ERROR("OpenGL draw command failed");
+        }
+    }
+
+    PostDraw();
+}
+
+void DeviceContextGLImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
+{
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+
+    if (IsDeferred())
+    {
+        auto AttribsCopy       = Attribs;
+        AttribsCopy.pDrawItems = m_DeferredCommands.Copy(Attribs.pDrawItems, Attribs.DrawCount);
+        return RecordDeferredCommand([AttribsCopy](DeviceContextGLImpl& Ctx) { Ctx.MultiDrawIndexed(AttribsCopy); });
+    }
+
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyMultiDrawIndexedArguments(Attribs))
+        return;
+
+    GLenum GlTopology;
+    PrepareForDraw(Attribs.Flags, true, GlTopology);
+    GLenum GLIndexType;
+    size_t IndexDataStartByteOffset;
+    PrepareForIndexedDraw(Attribs.IndexType, 0, GLIndexType, IndexDataStartByteOffset);
+
+    if (Attribs.DrawCount > 0 && Attribs.NumInstances > 0)
+    {
+        const bool   IsInstanced = Attribs.NumInstances > 1 || Attribs.FirstInstanceLocation != 0;
+        const size_t IndexSize   = GetValueSize(Attribs.IndexType);
+
+        bool NativeMultiDrawExecuted = false;
+#if GL_VERSION_3_2
+        // There is no instanced version of glMultiDrawElementsBaseVertex
+        if (!IsInstanced && (m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW) != 0)
+        {
+            auto& Counts       = m_MultiDrawScratch.Counts;
+            auto& BaseVertices = m_MultiDrawScratch.FirstsOrBaseVertices;
+            auto& IndexOffsets = m_MultiDrawScratch.IndexOffsets;
+            Counts.resize(Attribs.DrawCount);
+            BaseVertices.resize(Attribs.DrawCount);
+            IndexOffsets.resize(Attribs.DrawCount);
+            for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+            {
+                const auto& Item = Attribs.pDrawItems[i];
+                Counts[i]        = static_cast<GLsizei>(Item.NumIndices);
+                BaseVertices[i]  = static_cast<GLint>(Item.BaseVertex);
+                IndexOffsets[i]  = reinterpret_cast<GLvoid*>(IndexDataStartByteOffset + IndexSize * Item.FirstIndexLocation);
+            }
+            glMultiDrawElementsBaseVertex(GlTopology, Counts.data(), GLIndexType, IndexOffsets.data(), static_cast<GLsizei>(Attribs.DrawCount), BaseVertices.data());
+            DEV_CHECK_GL_ERROR("glMultiDrawElementsBaseVertex() failed");
+            NativeMultiDrawExecuted = true;
+        }
+#endif
+
+        if (!NativeMultiDrawExecuted)
+        {
+            for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+            {
+                const auto& Item = Attribs.pDrawItems[i];
+                if (Item.NumIndices == 0)
+                    continue;
+
+                auto* pIndexOffset = reinterpret_cast<GLvoid*>(IndexDataStartByteOffset + IndexSize * Item.FirstIndexLocation);
+                if (IsInstanced)
+                {
+                    if (Item.BaseVertex > 0)
+                    {
+                        if (Attribs.FirstInstanceLocation != 0)
+                            glDrawElementsInstancedBaseVertexBaseInstance(GlTopology, Item.NumIndices, GLIndexType, pIndexOffset, Attribs.NumInstances, Item.BaseVertex, Attribs.FirstInstanceLocation);
+                        else
+                            glDrawElementsInstancedBaseVertex(GlTopology, Item.NumIndices, GLIndexType, pIndexOffset, Attribs.NumInstances, Item.BaseVertex);
+                    }
+                    else
+                    {
+                        if (Attribs.FirstInstanceLocation != 0)
+                            glDrawElementsInstancedBaseInstance(GlTopology, Item.NumIndices, GLIndexType, pIndexOffset, Attribs.NumInstances, Attribs.FirstInstanceLocation);
+                        else
+                            glDrawElementsInstanced(GlTopology, Item.NumIndices, GLIndexType, pIndexOffset, Attribs.NumInstances);
+                    }
+                }
+                else
+                {
+                    if (Item.BaseVertex > 0)
+                        glDrawElementsBaseVertex(GlTopology, Item.NumIndices, GLIndexType, pIndexOffset, Item.BaseVertex);
+                    else
+                        glDrawElements(GlTopology, Item.NumIndices, GLIndexType, pIndexOffset);
+                }
+            }
+            DEV_CHECK_GL_ERROR("OpenGL draw command failed");
+        }
+    }
+
+    PostDraw();
+}
+
 
 void DeviceContextGLImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
-    DvpVerifyDispatchArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DISPATCH);
+
+    if (IsDeferred())
+        return RecordDeferredCommand([Attribs](DeviceContextGLImpl& Ctx) { Ctx.DispatchCompute(Attribs); });
+
+    ++m_FrameStats.DispatchCount;
+
+    if (!VerifyDispatchArguments(Attribs))
+        return;
 
 #if GL_ARB_compute_shader
     // The program might have changed since the last SetPipelineState call if a shader was
     // created after the call (ShaderResourcesGL needs to bind a program to load uniforms).
     m_pPipelineState->CommitProgram(m_ContextState);
+    if ((m_BindInfo.InlineConstantsSRBMask & m_BindInfo.ActiveSRBMask) != 0)
+        UpdateInlineConstantBuffers(m_BindInfo);
     if (Uint32 BindSRBMask = m_BindInfo.GetCommitMask())
     {
         BindProgramResources(BindSRBMask);
@@ -1104,12 +1468,22 @@ void DeviceContextGLImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 
 void DeviceContextGLImpl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs)
 {
-    DvpVerifyDispatchIndirectArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DISPATCH);
+
+    if (IsDeferred())
+        return RecordDeferredCommand({Attribs.pAttribsBuffer}, [Attribs](DeviceContextGLImpl& Ctx) { Ctx.DispatchComputeIndirect(Attribs); });
+
+    ++m_FrameStats.DispatchCount;
+
+    if (!VerifyDispatchIndirectArguments(Attribs))
+        return;
 
 #if GL_ARB_compute_shader
     // The program might have changed since the last SetPipelineState call if a shader was
     // created after the call (ShaderResourcesGL needs to bind a program to load uniforms).
     m_pPipelineState->CommitProgram(m_ContextState);
+    if ((m_BindInfo.InlineConstantsSRBMask & m_BindInfo.ActiveSRBMask) != 0)
+        UpdateInlineConstantBuffers(m_BindInfo);
     if (Uint32 BindSRBMask = m_BindInfo.GetCommitMask())
     {
         BindProgramResources(BindSRBMask);
@@ -1150,6 +1524,11 @@ void DeviceContextGLImpl::ClearDepthStencil(ITextureView*                  pView
                                             Uint8                          Stencil,
                                             RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        return RecordDeferredCommand({pView}, [=](DeviceContextGLImpl& Ctx) { Ctx.ClearDepthStencil(pView, ClearFlags, fDepth, Stencil, StateTransitionMode); });
+    }
+
     TDeviceContextBase::ClearDepthStencil(pView);
 
     if (pView != m_pBoundDepthStencil)
@@ -1184,6 +1563,12 @@ void DeviceContextGLImpl::ClearDepthStencil(ITextureView*                  pView
 
 void DeviceContextGLImpl::ClearRenderTarget(ITextureView* pView, const float* RGBA, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        const auto* pColor = m_DeferredCommands.Copy(RGBA, 4);
+        return RecordDeferredCommand({pView}, [=](DeviceContextGLImpl& Ctx) { Ctx.ClearRenderTarget(pView, pColor, StateTransitionMode); });
+    }
+
     TDeviceContextBase::ClearRenderTarget(pView);
 
     Int32 RTIndex = -1;
@@ -1233,6 +1618,7 @@ void DeviceContextGLImpl::ClearRenderTarget(ITextureView* pView, const float* RG
 
 void DeviceContextGLImpl::Flush()
 {
+    DEV_CHECK_ERR(!IsDeferred(), "Flush() is not supported for deferred contexts in OpenGL.");
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Flushing device context inside an active render pass.");
 
     glFlush();
@@ -1242,18 +1628,44 @@ void DeviceContextGLImpl::Flush()
 
 void DeviceContextGLImpl::FinishFrame()
 {
+    if (!IsDeferred())
+        m_UploadRing.FinishFrame();
+
+    m_FrameStats.DynamicHeapBytes = m_UploadRing.ExtractAllocatedSize();
+    m_FrameStats.BarrierCount     = m_ContextState.ExtractMemoryBarrierCount();
+
     TDeviceContextBase::EndFrame();
 }
 
 void DeviceContextGLImpl::FinishCommandList(ICommandList** ppCommandList)
 {
-    LOG_ERROR("Deferred contexts are not supported in OpenGL mode");
+    DEV_CHECK_ERR(IsDeferred(), "Only deferred contexts can record command list");
+
+    CommandListGLImpl* pCmdListGL(NEW_RC_OBJ(m_CmdListAllocator, "CommandListGLImpl instance", CommandListGLImpl)(m_pDevice, this, std::move(m_DeferredCommands)));
+    pCmdListGL->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
+
+    TDeviceContextBase::FinishCommandList();
 }
 
 void DeviceContextGLImpl::ExecuteCommandLists(Uint32               NumCommandLists,
                                               ICommandList* const* ppCommandLists)
 {
-    LOG_ERROR("Deferred contexts are not supported in OpenGL mode");
+    DEV_CHECK_ERR(!IsDeferred(), "Only immediate context can execute command list");
+
+    if (NumCommandLists == 0)
+        return;
+    DEV_CHECK_ERR(ppCommandLists != nullptr, "ppCommandLists must not be null when NumCommandLists is not zero");
+
+    // Every command list starts in the default state, like a deferred context does
+    InvalidateState();
+    for (Uint32 i = 0; i < NumCommandLists; ++i)
+    {
+        const auto* pCmdListGL = ClassPtrCast<const CommandListGLImpl>(ppCommandLists[i]);
+        pCmdListGL->Execute(*this);
+
+        // Device context is now in default state
+        InvalidateState();
+    }
 }
 
 void DeviceContextGLImpl::EnqueueSignal(IFence* pFence, Uint64 Value)
@@ -1287,6 +1699,9 @@ void DeviceContextGLImpl::WaitForIdle()
 
 void DeviceContextGLImpl::BeginQuery(IQuery* pQuery)
 {
+    if (IsDeferred())
+        return RecordDeferredCommand({pQuery}, [pQuery](DeviceContextGLImpl& Ctx) { Ctx.BeginQuery(pQuery); });
+
     TDeviceContextBase::BeginQuery(pQuery, 0);
 
     auto* pQueryGLImpl = ClassPtrCast<QueryGLImpl>(pQuery);
@@ -1334,6 +1749,9 @@ void DeviceContextGLImpl::BeginQuery(IQuery* pQuery)
 
 void DeviceContextGLImpl::EndQuery(IQuery* pQuery)
 {
+    if (IsDeferred())
+        return RecordDeferredCommand({pQuery}, [pQuery](DeviceContextGLImpl& Ctx) { Ctx.EndQuery(pQuery); });
+
     TDeviceContextBase::EndQuery(pQuery, 0);
 
     auto* pQueryGLImpl = ClassPtrCast<QueryGLImpl>(pQuery);
@@ -1403,10 +1821,16 @@ void DeviceContextGLImpl::UpdateBuffer(IBuffer*                       pBuffer,
                                        const void*                    pData,
                                        RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        const auto* pDataCopy = m_DeferredCommands.Copy(static_cast<const Uint8*>(pData), StaticCast<size_t>(Size));
+        return RecordDeferredCommand({pBuffer}, [=](DeviceContextGLImpl& Ctx) { Ctx.UpdateBuffer(pBuffer, Offset, Size, pDataCopy, StateTransitionMode); });
+    }
+
     TDeviceContextBase::UpdateBuffer(pBuffer, Offset, Size, pData, StateTransitionMode);
 
     auto* pBufferGL = ClassPtrCast<BufferGLImpl>(pBuffer);
-    pBufferGL->UpdateData(m_ContextState, Offset, Size, pData);
+    pBufferGL->UpdateData(m_ContextState, m_UploadRing, Offset, Size, pData);
 }
 
 void DeviceContextGLImpl::CopyBuffer(IBuffer*                       pSrcBuffer,
@@ -1417,6 +1841,13 @@ void DeviceContextGLImpl::CopyBuffer(IBuffer*                       pSrcBuffer,
                                      Uint64                         Size,
                                      RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode)
 {
+    if (IsDeferred())
+    {
+        return RecordDeferredCommand({pSrcBuffer, pDstBuffer}, [=](DeviceContextGLImpl& Ctx) {
+            Ctx.CopyBuffer(pSrcBuffer, SrcOffset, SrcBufferTransitionMode, pDstBuffer, DstOffset, Size, DstBufferTransitionMode);
+        });
+    }
+
     TDeviceContextBase::CopyBuffer(pSrcBuffer, SrcOffset, SrcBufferTransitionMode, pDstBuffer, DstOffset, Size, DstBufferTransitionMode);
 
     auto* pSrcBufferGL = ClassPtrCast<BufferGLImpl>(pSrcBuffer);
@@ -1426,18 +1857,63 @@ void DeviceContextGLImpl::CopyBuffer(IBuffer*                       pSrcBuffer,
 
 void DeviceContextGLImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_MAP_BUFFER);
+
+    if (IsDeferred())
+    {
+        pMappedData = nullptr;
+        if (MapType != MAP_WRITE || (MapFlags & MAP_FLAG_DISCARD) == 0)
+        {
+            LOG_ERROR_MESSAGE("Deferred contexts in OpenGL only support mapping buffers with MAP_WRITE and MAP_FLAG_DISCARD");
+            return;
+        }
+
+        // The CPU writes the data into the command stream memory, and
+        // it is copied into the buffer when the command list is executed.
+        const auto Size  = pBuffer->GetDesc().Size;
+        auto*      pData = m_DeferredCommands.Allocate(StaticCast<size_t>(Size));
+        pMappedData      = pData;
+        return RecordDeferredCommand({pBuffer}, [=](DeviceContextGLImpl& Ctx) {
+            PVoid pDstData = nullptr;
+            Ctx.MapBuffer(pBuffer, MAP_WRITE, MapFlags, pDstData);
+            if (pDstData != nullptr)
+                memcpy(pDstData, pData, StaticCast<size_t>(Size));
+            Ctx.UnmapBuffer(pBuffer, MAP_WRITE);
+        });
+    }
+
     TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
     auto* pBufferGL = ClassPtrCast<BufferGLImpl>(pBuffer);
-    pBufferGL->Map(m_ContextState, MapType, MapFlags, pMappedData);
+    pBufferGL->Map(m_ContextState, m_UploadRing, MapType, MapFlags, pMappedData);
 }
 
 void DeviceContextGLImpl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_UNMAP_BUFFER);
+
+    if (IsDeferred())
+    {
+        // The buffer is mapped and unmapped by the command recorded in MapBuffer()
+        return;
+    }
+
     TDeviceContextBase::UnmapBuffer(pBuffer, MapType);
     auto* pBufferGL = ClassPtrCast<BufferGLImpl>(pBuffer);
     pBufferGL->Unmap(m_ContextState);
 }
 
+// Returns the size of the CPU data that are read by UpdateTexture()
+static Uint64 GetUpdateTextureDataSize(const TextureDesc& TexDesc, const Box& DstBox, const TextureSubResData& SubresData)
+{
+    const auto&  FmtAttribs   = GetTextureFormatAttribs(TexDesc.Format);
+    const bool   IsCompressed = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED;
+    const Uint32 BlockWidth   = IsCompressed ? FmtAttribs.BlockWidth : 1;
+    const Uint32 BlockHeight  = IsCompressed ? FmtAttribs.BlockHeight : 1;
+    const Uint64 RowSize      = Uint64{(DstBox.Width() + BlockWidth - 1) / BlockWidth} * FmtAttribs.GetElementSize();
+    const Uint64 NumRows      = (DstBox.Height() + BlockHeight - 1) / BlockHeight;
+    return SubresData.DepthStride * (DstBox.Depth() - 1) + SubresData.Stride * (NumRows - 1) + RowSize;
+}
+
 void DeviceContextGLImpl::UpdateTexture(ITexture*                      pTexture,
                                         Uint32                         MipLevel,
                                         Uint32                         Slice,
@@ -1446,13 +1922,51 @@ void DeviceContextGLImpl::UpdateTexture(ITexture*                      pTexture,
                                         RESOURCE_STATE_TRANSITION_MODE SrcBufferStateTransitionMode,
                                         RESOURCE_STATE_TRANSITION_MODE TextureStateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        auto SubresDataCopy = SubresData;
+        if (SubresData.pData != nullptr)
+        {
+            const auto DataSize  = GetUpdateTextureDataSize(pTexture->GetDesc(), DstBox, SubresData);
+            SubresDataCopy.pData = m_DeferredCommands.Copy(static_cast<const Uint8*>(SubresData.pData), StaticCast<size_t>(DataSize));
+        }
+        return RecordDeferredCommand({pTexture, SubresData.pSrcBuffer}, [=](DeviceContextGLImpl& Ctx) {
+            Ctx.UpdateTexture(pTexture, MipLevel, Slice, DstBox, SubresDataCopy, SrcBufferStateTransitionMode, TextureStateTransitionMode);
+        });
+    }
+
     TDeviceContextBase::UpdateTexture(pTexture, MipLevel, Slice, DstBox, SubresData, SrcBufferStateTransitionMode, TextureStateTransitionMode);
     auto* pTexGL = ClassPtrCast<TextureBaseGL>(pTexture);
+    if (SubresData.pSrcBuffer == nullptr && SubresData.pData != nullptr)
+    {
+        // Copy the data into the upload ring buffer and unpack it from there. Unlike glTexSubImage*()
+        // from CPU memory, this does not stall until the driver copies the data, and the transfer
+        // to the texture is performed asynchronously by the GPU.
+        const auto DataSize = GetUpdateTextureDataSize(pTexGL->GetDesc(), DstBox, SubresData);
+        if (auto UploadAlloc = m_UploadRing.Allocate(m_ContextState, DataSize))
+        {
+            memcpy(UploadAlloc.pCPUAddress, SubresData.pData, StaticCast<size_t>(DataSize));
+
+            TextureSubResData UploadSubresData;
+            UploadSubresData.SrcOffset   = UploadAlloc.Offset;
+            UploadSubresData.Stride      = SubresData.Stride;
+            UploadSubresData.DepthStride = SubresData.DepthStride;
+            pTexGL->UpdateData(m_ContextState, MipLevel, Slice, DstBox, UploadSubresData, *UploadAlloc.pBuffer);
+            return;
+        }
+    }
     pTexGL->UpdateData(m_ContextState, MipLevel, Slice, DstBox, SubresData);
 }
 
 void DeviceContextGLImpl::CopyTexture(const CopyTextureAttribs& CopyAttribs)
 {
+    if (IsDeferred())
+    {
+        auto AttribsCopy    = CopyAttribs;
+        AttribsCopy.pSrcBox = m_DeferredCommands.Copy(CopyAttribs.pSrcBox, 1);
+        return RecordDeferredCommand({CopyAttribs.pSrcTexture, CopyAttribs.pDstTexture}, [AttribsCopy](DeviceContextGLImpl& Ctx) { Ctx.CopyTexture(AttribsCopy); });
+    }
+
     TDeviceContextBase::CopyTexture(CopyAttribs);
     auto* pSrcTexGL = ClassPtrCast<TextureBaseGL>(CopyAttribs.pSrcTexture);
     auto* pDstTexGL = ClassPtrCast<TextureBaseGL>(CopyAttribs.pDstTexture);
@@ -1574,6 +2088,13 @@ void DeviceContextGLImpl::MapTextureSubresource(ITexture*                 pTextu
                                                 const Box*                pMapRegion,
                                                 MappedTextureSubresource& MappedData)
 {
+    if (IsDeferred())
+    {
+        LOG_ERROR_MESSAGE("Textures can't be mapped by deferred contexts in OpenGL");
+        MappedData = MappedTextureSubresource{};
+        return;
+    }
+
     TDeviceContextBase::MapTextureSubresource(pTexture, MipLevel, ArraySlice, MapType, MapFlags, pMapRegion, MappedData);
     auto*       pTexGL  = ClassPtrCast<TextureBaseGL>(pTexture);
     const auto& TexDesc = pTexGL->GetDesc();
@@ -1582,7 +2103,7 @@ void DeviceContextGLImpl::MapTextureSubresource(ITexture*                 pTextu
         auto PBOOffset       = GetStagingTextureSubresourceOffset(TexDesc, ArraySlice, MipLevel, TextureBaseGL::PBOOffsetAlignment);
         auto MipLevelAttribs = GetMipLevelProperties(TexDesc, MipLevel);
         auto pPBO            = ClassPtrCast<BufferGLImpl>(pTexGL->GetPBO());
-        pPBO->MapRange(m_ContextState, MapType, MapFlags, PBOOffset, MipLevelAttribs.MipSize, MappedData.pData);
+        pPBO->MapRange(m_ContextState, m_UploadRing, MapType, MapFlags, PBOOffset, MipLevelAttribs.MipSize, MappedData.pData);
 
         MappedData.Stride      = MipLevelAttribs.RowSize;
         MappedData.DepthStride = MipLevelAttribs.MipSize;
@@ -1597,6 +2118,9 @@ void DeviceContextGLImpl::MapTextureSubresource(ITexture*                 pTextu
 
 void DeviceContextGLImpl::UnmapTextureSubresource(ITexture* pTexture, Uint32 MipLevel, Uint32 ArraySlice)
 {
+    if (IsDeferred())
+        return;
+
     TDeviceContextBase::UnmapTextureSubresource(pTexture, MipLevel, ArraySlice);
     auto*       pTexGL  = ClassPtrCast<TextureBaseGL>(pTexture);
     const auto& TexDesc = pTexGL->GetDesc();
@@ -1613,17 +2137,38 @@ void DeviceContextGLImpl::UnmapTextureSubresource(ITexture* pTexture, Uint32 Mip
 
 void DeviceContextGLImpl::GenerateMips(ITextureView* pTexView)
 {
+    if (IsDeferred())
+        return RecordDeferredCommand({pTexView}, [pTexView](DeviceContextGLImpl& Ctx) { Ctx.GenerateMips(pTexView); });
+
     TDeviceContextBase::GenerateMips(pTexView);
     auto* pTexViewGL = ClassPtrCast<TextureViewGLImpl>(pTexView);
-    auto  BindTarget = pTexViewGL->GetBindTarget();
+
+    auto* pTexRegionCompute = m_pDevice->m_pTexRegionCompute.get();
+    if (pTexRegionCompute != nullptr && pTexRegionCompute->CanGenerateMips(pTexViewGL->GetTexture()->GetDesc(), pTexViewGL->GetDesc()))
+    {
+        pTexRegionCompute->GenerateMips(this, pTexViewGL);
+        return;
+    }
+
+    auto BindTarget = pTexViewGL->GetBindTarget();
     m_ContextState.BindTexture(-1, BindTarget, pTexViewGL->GetHandle());
     glGenerateMipmap(BindTarget);
     DEV_CHECK_GL_ERROR("Failed to generate mip maps");
     m_ContextState.BindTexture(-1, BindTarget, GLObjectWrappers::GLTextureObj::Null());
 }
 
+void DeviceContextGLImpl::GenerateMipsBatch(ITextureView* const* ppTexViews, Uint32 NumViews)
+{
+    // OpenGL generates mipmaps one texture at a time, so the views are processed one by one.
+    // Deferred contexts record a separate command for every view.
+    for (Uint32 i = 0; i < NumViews; ++i)
+        GenerateMips(ppTexViews[i]);
+}
+
 void DeviceContextGLImpl::TransitionResourceStates(Uint32 BarrierCount, const StateTransitionDesc* pResourceBarriers)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_TRANSITION_RESOURCE_STATES);
+
     VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
 }
 
@@ -1631,6 +2176,11 @@ void DeviceContextGLImpl::ResolveTextureSubresource(ITexture*
                                                     ITexture*                               pDstTexture,
                                                     const ResolveTextureSubresourceAttribs& ResolveAttribs)
 {
+    if (IsDeferred())
+    {
+        return RecordDeferredCommand({pSrcTexture, pDstTexture}, [=](DeviceContextGLImpl& Ctx) { Ctx.ResolveTextureSubresource(pSrcTexture, pDstTexture, ResolveAttribs); });
+    }
+
     TDeviceContextBase::ResolveTextureSubresource(pSrcTexture, pDstTexture, ResolveAttribs);
     auto*       pSrcTexGl  = ClassPtrCast<TextureBaseGL>(pSrcTexture);
     auto*       pDstTexGl  = ClassPtrCast<TextureBaseGL>(pDstTexture);
@@ -1713,6 +2263,11 @@ void DeviceContextGLImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
     UNSUPPORTED("BuildBLAS is not supported in OpenGL");
 }
 
+void DeviceContextGLImpl::BuildBLASBatch(const BuildBLASBatchAttribs& Attribs)
+{
+    UNSUPPORTED("BuildBLASBatch is not supported in OpenGL");
+}
+
 void DeviceContextGLImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
 {
     UNSUPPORTED("BuildTLAS is not supported in OpenGL");
@@ -1758,6 +2313,84 @@ void DeviceContextGLImpl::SetShadingRate(SHADING_RATE BaseRate, SHADING_RATE_COM
     UNSUPPORTED("SetShadingRate is not supported in OpenGL");
 }
 
+void DeviceContextGLImpl::BeginIndexedQuery(IQueryArray* pQueryArray, Uint32 Index)
+{
+    UNSUPPORTED("BeginIndexedQuery is not supported in OpenGL");
+}
+
+void DeviceContextGLImpl::EndIndexedQuery(IQueryArray* pQueryArray, Uint32 Index)
+{
+    UNSUPPORTED("EndIndexedQuery is not supported in OpenGL");
+}
+
+void DeviceContextGLImpl::ResolveQueryArray(const ResolveQueryArrayAttribs& Attribs)
+{
+    UNSUPPORTED("ResolveQueryArray is not supported in OpenGL");
+}
+
+void DeviceContextGLImpl::SetPredication(IBuffer* pBuffer, Uint64 Offset, PREDICATION_OP Op)
+{
+    UNSUPPORTED("SetPredication is not supported in OpenGL");
+}
+
+void DeviceContextGLImpl::SetQueryPredication(IQuery* pQuery, PREDICATION_OP Op)
+{
+    if (IsDeferred())
+        return RecordDeferredCommand({pQuery}, [pQuery, Op](DeviceContextGLImpl& Ctx) { Ctx.SetQueryPredication(pQuery, Op); });
+
+    TDeviceContextBase::SetQueryPredication(pQuery, Op, 0);
+
+#if GL_QUERY_WAIT
+    if (m_QueryPredicationActive)
+    {
+        glEndConditionalRender();
+        DEV_CHECK_GL_ERROR("Failed to end conditional rendering");
+        m_QueryPredicationActive = false;
+    }
+
+    if (pQuery == nullptr)
+        return;
+
+    GLenum Mode = GL_QUERY_WAIT;
+    if (Op == PREDICATION_OP_SKIP_IF_NOT_ZERO)
+    {
+#    if GL_QUERY_WAIT_INVERTED
+        if (m_pDevice->IsConditionalRenderInvertedSupported())
+        {
+            Mode = GL_QUERY_WAIT_INVERTED;
+        }
+        else
+#    endif
+        {
+            LOG_ERROR_MESSAGE("PREDICATION_OP_SKIP_IF_NOT_ZERO requires OpenGL 4.5 or GL_ARB_conditional_render_inverted extension");
+            return;
+        }
+    }
+
+    // Rendering commands are discarded if no sample passed, or if any sample passed in the inverted mode
+    glBeginConditionalRender(ClassPtrCast<QueryGLImpl>(pQuery)->GetGlQueryHandle(), Mode);
+    DEV_CHECK_GL_ERROR("Failed to begin conditional rendering");
+    m_QueryPredicationActive = true;
+#else
+    UNSUPPORTED("SetQueryPredication is not supported in this OpenGL configuration");
+#endif
+}
+
+void DeviceContextGLImpl::SetCullMode(CULL_MODE CullMode)
+{
+    UNSUPPORTED("SetCullMode is not supported in OpenGL");
+}
+
+void DeviceContextGLImpl::SetDepthStencilState(const DepthStencilStateDesc& DSSDesc)
+{
+    UNSUPPORTED("SetDepthStencilState is not supported in OpenGL");
+}
+
+void DeviceContextGLImpl::SetPrimitiveTopology(PRIMITIVE_TOPOLOGY Topology)
+{
+    UNSUPPORTED("SetPrimitiveTopology is not supported in OpenGL");
+}
+
 void DeviceContextGLImpl::BindSparseResourceMemory(const BindSparseResourceMemoryAttribs& Attribs)
 {
     UNSUPPORTED("BindSparseResourceMemory is not supported in OpenGL");
@@ -1765,6 +2398,13 @@ void DeviceContextGLImpl::BindSparseResourceMemory(const BindSparseResourceMemor
 
 void DeviceContextGLImpl::BeginDebugGroup(const Char* Name, const float* pColor)
 {
+    if (IsDeferred())
+    {
+        const auto* NameCopy   = m_DeferredCommands.CopyString(Name);
+        const auto* pColorCopy = m_DeferredCommands.Copy(pColor, 4);
+        return RecordDeferredCommand([=](DeviceContextGLImpl& Ctx) { Ctx.BeginDebugGroup(NameCopy, pColorCopy); });
+    }
+
     TDeviceContextBase::BeginDebugGroup(Name, pColor, 0);
 
 #if GL_KHR_debug
@@ -1775,6 +2415,9 @@ void DeviceContextGLImpl::BeginDebugGroup(const Char* Name, const float* pColor)
 
 void DeviceContextGLImpl::EndDebugGroup()
 {
+    if (IsDeferred())
+        return RecordDeferredCommand([](DeviceContextGLImpl& Ctx) { Ctx.EndDebugGroup(); });
+
     TDeviceContextBase::EndDebugGroup(0);
 
 #if GL_KHR_debug
@@ -1785,6 +2428,13 @@ void DeviceContextGLImpl::EndDebugGroup()
 
 void DeviceContextGLImpl::InsertDebugLabel(const Char* Label, const float* pColor)
 {
+    if (IsDeferred())
+    {
+        const auto* LabelCopy  = m_DeferredCommands.CopyString(Label);
+        const auto* pColorCopy = m_DeferredCommands.Copy(pColor, 4);
+        return RecordDeferredCommand([=](DeviceContextGLImpl& Ctx) { Ctx.InsertDebugLabel(LabelCopy, pColorCopy); });
+    }
+
     TDeviceContextBase::InsertDebugLabel(Label, pColor, 0);
 
 #if GL_KHR_debug
@@ -160,7 +160,8 @@ void EngineFactoryOpenGLImpl::EnumerateAdapters(Version              MinVersion,
 /// \param [out] ppDevice           - Address of the memory location where pointer to
 ///                                   the created device will be written.
 /// \param [out] ppImmediateContext - Address of the memory location where pointers to
-///                                   the immediate context will be written.
+///                                   the immediate context will be written. Pointers to the
+///                                   deferred contexts are written afterwards.
 /// \param [in]  SCDesc             - Swap chain description.
 /// \param [out] ppSwapChain        - Address of the memory location where pointer to the new
 ///                                   swap chain will be written.
@@ -180,21 +181,19 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
     if (!ppDevice || !ppImmediateContext || !ppSwapChain)
         return;
 
-    if (EngineCI.NumDeferredContexts > 0)
-    {
-        LOG_ERROR_MESSAGE("OpenGL back-end does not support deferred contexts");
-        return;
-    }
-
     if (EngineCI.NumImmediateContexts > 1)
     {
         LOG_ERROR_MESSAGE("OpenGL back-end does not support multiple immediate contexts");
         return;
     }
 
-    *ppDevice           = nullptr;
-    *ppImmediateContext = nullptr;
-    *ppSwapChain        = nullptr;
+    *ppDevice    = nullptr;
+    *ppSwapChain = nullptr;
+    for (Uint32 ctx = 0; ctx < 1 + EngineCI.NumDeferredContexts; ++ctx)
+        ppImmediateContext[ctx] = nullptr;
+
+    BeginStartupProfiling(EngineCI);
+    StartupProfiler::Scope ProfilerScope{"CreateDeviceAndSwapChainGL"};
 
     try
     {
@@ -205,12 +204,13 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
         SetRawAllocator(EngineCI.pRawMemAllocator);
         auto& RawMemAllocator = GetRawAllocator();
 
-        RenderDeviceGLImpl* pRenderDeviceOpenGL{
-            NEW_RC_OBJ(RawMemAllocator, "TRenderDeviceGLImpl instance", TRenderDeviceGLImpl)(
-                RawMemAllocator, this, EngineCI, &SCDesc //
-                )                                        //
-        };
-        pRenderDeviceOpenGL->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
+        RenderDeviceGLImpl* pRenderDeviceOpenGL = nullptr;
+        {
+            StartupProfiler::Scope RenderDeviceScope{"Create render device"};
+
+            pRenderDeviceOpenGL = NEW_RC_OBJ(RawMemAllocator, "TRenderDeviceGLImpl instance", TRenderDeviceGLImpl)(RawMemAllocator, this, EngineCI, &SCDesc);
+            pRenderDeviceOpenGL->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
+        }
 
         DeviceContextGLImpl* pDeviceContextOpenGL{
             NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(
@@ -228,6 +228,24 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
         pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppImmediateContext));
         pRenderDeviceOpenGL->SetImmediateContext(0, pDeviceContextOpenGL);
 
+        for (Uint32 DeferredCtx = 0; DeferredCtx < EngineCI.NumDeferredContexts; ++DeferredCtx)
+        {
+            RefCntAutoPtr<DeviceContextGLImpl> pDeferredCtxGL{
+                NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(
+                    pRenderDeviceOpenGL,
+                    DeviceContextDesc{
+                        nullptr,
+                        COMMAND_QUEUE_TYPE_GRAPHICS,
+                        True,           // IsDeferred
+                        1 + DeferredCtx // Context id
+                    })                  //
+            };
+            // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceOpenGL will
+            // keep a weak reference to the context
+            pDeferredCtxGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppImmediateContext + 1 + DeferredCtx));
+            pRenderDeviceOpenGL->SetDeferredContext(DeferredCtx, pDeferredCtxGL);
+        }
+
         // Need to create immediate context first
         pRenderDeviceOpenGL->InitTexRegionRender();
 
@@ -244,10 +262,13 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
             *ppDevice = nullptr;
         }
 
-        if (*ppImmediateContext)
+        for (Uint32 ctx = 0; ctx < 1 + EngineCI.NumDeferredContexts; ++ctx)
         {
-            (*ppImmediateContext)->Release();
-            *ppImmediateContext = nullptr;
+            if (ppImmediateContext[ctx] != nullptr)
+            {
+                ppImmediateContext[ctx]->Release();
+                ppImmediateContext[ctx] = nullptr;
+            }
         }
 
         if (*ppSwapChain)
@@ -267,7 +288,8 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
 /// \param [out] ppDevice - Address of the memory location where pointer to
 ///                         the created device will be written.
 /// \param [out] ppImmediateContext - Address of the memory location where pointers to
-///                                   the immediate context will be written.
+///                                   the immediate context will be written. Pointers to the
+///                                   deferred contexts are written afterwards.
 void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo& EngineCI,
                                                       IRenderDevice**           ppDevice,
                                                       IDeviceContext**          ppImmediateContext)
@@ -282,20 +304,18 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
     if (!ppDevice || !ppImmediateContext)
         return;
 
-    if (EngineCI.NumDeferredContexts > 0)
-    {
-        LOG_ERROR_MESSAGE("OpenGL back-end does not support deferred contexts");
-        return;
-    }
-
     if (EngineCI.NumImmediateContexts > 1)
     {
         LOG_ERROR_MESSAGE("OpenGL back-end does not support multiple immediate contexts");
         return;
     }
 
-    *ppDevice           = nullptr;
-    *ppImmediateContext = nullptr;
+    *ppDevice = nullptr;
+    for (Uint32 ctx = 0; ctx < 1 + EngineCI.NumDeferredContexts; ++ctx)
+        ppImmediateContext[ctx] = nullptr;
+
+    BeginStartupProfiling(EngineCI);
+    StartupProfiler::Scope ProfilerScope{"AttachToActiveGLContext"};
 
     try
     {
@@ -306,12 +326,13 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
         SetRawAllocator(EngineCI.pRawMemAllocator);
         auto& RawMemAllocator = GetRawAllocator();
 
-        RenderDeviceGLImpl* pRenderDeviceOpenGL{
-            NEW_RC_OBJ(RawMemAllocator, "TRenderDeviceGLImpl instance", TRenderDeviceGLImpl)(
-                RawMemAllocator, this, EngineCI //
-                )                               //
-        };
-        pRenderDeviceOpenGL->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
+        RenderDeviceGLImpl* pRenderDeviceOpenGL = nullptr;
+        {
+            StartupProfiler::Scope RenderDeviceScope{"Create render device"};
+
+            pRenderDeviceOpenGL = NEW_RC_OBJ(RawMemAllocator, "TRenderDeviceGLImpl instance", TRenderDeviceGLImpl)(RawMemAllocator, this, EngineCI);
+            pRenderDeviceOpenGL->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
+        }
 
         DeviceContextGLImpl* pDeviceContextOpenGL{
             NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(
@@ -328,6 +349,24 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
         // keep a weak reference to the context
         pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppImmediateContext));
         pRenderDeviceOpenGL->SetImmediateContext(0, pDeviceContextOpenGL);
+
+        for (Uint32 DeferredCtx = 0; DeferredCtx < EngineCI.NumDeferredContexts; ++DeferredCtx)
+        {
+            RefCntAutoPtr<DeviceContextGLImpl> pDeferredCtxGL{
+                NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(
+                    pRenderDeviceOpenGL,
+                    DeviceContextDesc{
+                        nullptr,
+                        COMMAND_QUEUE_TYPE_GRAPHICS,
+                        True,           // IsDeferred
+                        1 + DeferredCtx // Context id
+                    })                  //
+            };
+            // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceOpenGL will
+            // keep a weak reference to the context
+            pDeferredCtxGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppImmediateContext + 1 + DeferredCtx));
+            pRenderDeviceOpenGL->SetDeferredContext(DeferredCtx, pDeferredCtxGL);
+        }
     }
     catch (const std::runtime_error&)
     {
@@ -337,10 +376,13 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
             *ppDevice = nullptr;
         }
 
-        if (*ppImmediateContext)
+        for (Uint32 ctx = 0; ctx < 1 + EngineCI.NumDeferredContexts; ++ctx)
         {
-            (*ppImmediateContext)->Release();
-            *ppImmediateContext = nullptr;
+            if (ppImmediateContext[ctx] != nullptr)
+            {
+                ppImmediateContext[ctx]->Release();
+                ppImmediateContext[ctx] = nullptr;
+            }
         }
 
         LOG_ERROR("Failed to initialize OpenGL-based render device");
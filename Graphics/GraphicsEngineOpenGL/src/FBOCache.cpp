@@ -37,62 +37,58 @@ namespace Diligent
 
 bool FBOCache::FBOCacheKey::operator==(const FBOCacheKey& Key) const noexcept
 {
-    if (Hash != 0 && Key.Hash != 0 && Hash != Key.Hash)
+    if (Hash != Key.Hash || NumRenderTargets != Key.NumRenderTargets || DS != Key.DS)
         return false;
 
-    if (NumRenderTargets != Key.NumRenderTargets)
-        return false;
     for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
     {
-        if (RTIds[rt] != Key.RTIds[rt])
-            return false;
-        if (RTIds[rt])
-        {
-            if (!(RTVDescs[rt] == Key.RTVDescs[rt]))
-                return false;
-        }
-    }
-    if (DSId != Key.DSId)
-        return false;
-    if (DSId)
-    {
-        if (!(DSVDesc == Key.DSVDesc))
+        if (RTs[rt] != Key.RTs[rt])
             return false;
     }
     return true;
 }
 
-std::size_t FBOCache::FBOCacheKeyHashFunc::operator()(const FBOCacheKey& Key) const noexcept
-{
-    if (Key.Hash == 0)
-    {
-        std::hash<TextureViewDesc> TexViewDescHasher;
-        Key.Hash = 0;
-        HashCombine(Key.Hash, Key.NumRenderTargets);
-        for (Uint32 rt = 0; rt < Key.NumRenderTargets; ++rt)
-        {
-            HashCombine(Key.Hash, Key.RTIds[rt]);
-            if (Key.RTIds[rt])
-                HashCombine(Key.Hash, TexViewDescHasher(Key.RTVDescs[rt]));
-        }
-        HashCombine(Key.Hash, Key.DSId);
-        if (Key.DSId)
-            HashCombine(Key.Hash, TexViewDescHasher(Key.DSVDesc));
-    }
-    return Key.Hash;
-}
-
 
-FBOCache::FBOCache()
+FBOCache::FBOCache(Uint32 MaxSize) :
+    m_MaxSize{MaxSize}
 {
     m_Cache.max_load_factor(0.5f);
-    m_TexIdToKey.max_load_factor(0.5f);
+    m_TexIdToKeys.max_load_factor(0.5f);
 }
 
 FBOCache::~FBOCache()
 {
     VERIFY(m_Cache.empty(), "FBO cache is not empty. Are there any unreleased objects?");
-    VERIFY(m_TexIdToKey.empty(), "TexIdToKey cache is not empty.");
+    VERIFY(m_LRUList.empty(), "LRU list is not empty");
+    VERIFY(m_TexIdToKeys.empty(), "TexIdToKeys cache is not empty.");
+}
+
+void FBOCache::RemoveFBO(CacheType::iterator It)
+{
+    const auto* pKey = &It->first;
+
+    auto RemoveKeyRef = [this, pKey](UniqueIdentifier TexId) //
+    {
+        auto KeysIt = m_TexIdToKeys.find(TexId);
+        // The same texture may be used in several attachments, so the key may have already been removed
+        if (KeysIt != m_TexIdToKeys.end())
+        {
+            KeysIt->second.erase(pKey);
+            if (KeysIt->second.empty())
+                m_TexIdToKeys.erase(KeysIt);
+        }
+    };
+
+    if (pKey->DS.TexId != 0)
+        RemoveKeyRef(pKey->DS.TexId);
+    for (Uint32 rt = 0; rt < pKey->NumRenderTargets; ++rt)
+    {
+        if (pKey->RTs[rt].TexId != 0)
+            RemoveKeyRef(pKey->RTs[rt].TexId);
+    }
+
+    m_LRUList.erase(It->second.LRUIt);
+    m_Cache.erase(It);
 }
 
 void FBOCache::OnReleaseTexture(ITexture* pTexture)
@@ -101,12 +97,19 @@ void FBOCache::OnReleaseTexture(ITexture* pTexture)
 
     auto* pTexGL = ClassPtrCast<TextureBaseGL>(pTexture);
     // Find all FBOs that this texture used in
-    auto EqualRange = m_TexIdToKey.equal_range(pTexGL->GetUniqueID());
-    for (auto It = EqualRange.first; It != EqualRange.second; ++It)
+    auto KeysIt = m_TexIdToKeys.find(pTexGL->GetUniqueID());
+    if (KeysIt == m_TexIdToKeys.end())
+        return;
+
+    // RemoveFBO() modifies the set, so we need to copy the keys first
+    const std::vector<const FBOCacheKey*> Keys{KeysIt->second.begin(), KeysIt->second.end()};
+    for (const auto* pKey : Keys)
     {
-        m_Cache.erase(It->second);
+        auto It = m_Cache.find(*pKey);
+        VERIFY_EXPR(It != m_Cache.end() && &It->first == pKey);
+        RemoveFBO(It);
     }
-    m_TexIdToKey.erase(EqualRange.first, EqualRange.second);
+    VERIFY_EXPR(m_TexIdToKeys.find(pTexGL->GetUniqueID()) == m_TexIdToKeys.end());
 }
 
 GLObjectWrappers::GLFrameBufferObj FBOCache::CreateFBO(GLContextState&    ContextState,
@@ -252,41 +255,62 @@ const GLObjectWrappers::GLFrameBufferObj& FBOCache::GetFBO(Uint32             Nu
                                         // on the completion of all shader writes issued prior to the barrier.
             ContextState);
 
-        Key.RTIds[rt]    = pColorTexGL->GetUniqueID();
-        Key.RTVDescs[rt] = pRTView->GetDesc();
+        Key.RTs[rt] = AttachmentKey{pColorTexGL->GetUniqueID(), pRTView->GetDesc()};
     }
 
     if (pDSV)
     {
         auto* pDepthTexGL = pDSV->GetTexture<TextureBaseGL>();
         pDepthTexGL->TextureMemoryBarrier(MEMORY_BARRIER_FRAMEBUFFER, ContextState);
-        Key.DSId    = pDepthTexGL->GetUniqueID();
-        Key.DSVDesc = pDSV->GetDesc();
+        Key.DS = AttachmentKey{pDepthTexGL->GetUniqueID(), pDSV->GetDesc()};
+    }
+
+    Key.Hash = ComputeHash(Key.NumRenderTargets, Key.DS.TexId, Key.DS.MipLevel, Key.DS.FirstSlice, Key.DS.NumSlices);
+    for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
+    {
+        const auto& RT = Key.RTs[rt];
+        HashCombine(Key.Hash, RT.TexId, RT.MipLevel, RT.FirstSlice, RT.NumSlices);
     }
 
     // Try to find FBO in the map
     auto It = m_Cache.find(Key);
     if (It != m_Cache.end())
     {
-        return It->second;
+        // Move the FBO to the front of the LRU list
+        m_LRUList.splice(m_LRUList.begin(), m_LRUList, It->second.LRUIt);
+        return It->second.FBO;
     }
     else
     {
+        // Release the least recently used FBOs. Never release the most recently used one
+        // as the caller may still be holding a reference to it (e.g. when copying between
+        // two textures, see DeviceContextGLImpl::ResolveTextureSubresource).
+        while (m_MaxSize != 0 && m_Cache.size() >= m_MaxSize && m_LRUList.size() > 1)
+        {
+            auto LRUIt = m_Cache.find(*m_LRUList.back());
+            VERIFY_EXPR(LRUIt != m_Cache.end());
+            RemoveFBO(LRUIt);
+        }
+
         // Create a new FBO
         auto NewFBO = CreateFBO(ContextState, NumRenderTargets, ppRTVs, pDSV);
 
-        auto NewElems = m_Cache.emplace(std::make_pair(Key, std::move(NewFBO)));
+        auto NewElems = m_Cache.emplace(std::make_pair(Key, CacheEntry{std::move(NewFBO), {}}));
         // New element must be actually inserted
         VERIFY(NewElems.second, "New element was not inserted");
-        if (Key.DSId != 0)
-            m_TexIdToKey.insert(std::make_pair(Key.DSId, Key));
+
+        const auto* pKey             = &NewElems.first->first;
+        NewElems.first->second.LRUIt = m_LRUList.emplace(m_LRUList.begin(), pKey);
+
+        if (Key.DS.TexId != 0)
+            m_TexIdToKeys[Key.DS.TexId].emplace(pKey);
         for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
         {
-            if (Key.RTIds[rt] != 0)
-                m_TexIdToKey.insert(std::make_pair(Key.RTIds[rt], Key));
+            if (Key.RTs[rt].TexId != 0)
+                m_TexIdToKeys[Key.RTs[rt].TexId].emplace(pKey);
         }
 
-        return NewElems.first->second;
+        return NewElems.first->second.FBO;
     }
 }
 
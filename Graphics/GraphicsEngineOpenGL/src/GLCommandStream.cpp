@@ -0,0 +1,126 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "GLCommandStream.hpp"
+
+#include <cstring>
+
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+GLCommandStream::~GLCommandStream()
+{
+    Clear();
+}
+
+GLCommandStream::GLCommandStream(GLCommandStream&& Other) noexcept
+{
+    *this = std::move(Other);
+}
+
+GLCommandStream& GLCommandStream::operator=(GLCommandStream&& Other) noexcept
+{
+    if (this == &Other)
+        return *this;
+
+    Clear();
+
+    m_Pages       = std::move(Other.m_Pages);
+    m_pCurrPos    = Other.m_pCurrPos;
+    m_pPageEnd    = Other.m_pPageEnd;
+    m_pFirstCmd   = Other.m_pFirstCmd;
+    m_pLastCmd    = Other.m_pLastCmd;
+    m_NumCommands = Other.m_NumCommands;
+    m_Objects     = std::move(Other.m_Objects);
+
+    // The commands are now owned by this stream, so don't let Other destroy them
+    Other.m_pFirstCmd   = nullptr;
+    Other.m_pLastCmd    = nullptr;
+    Other.m_NumCommands = 0;
+    Other.Clear();
+
+    return *this;
+}
+
+void* GLCommandStream::Allocate(size_t Size, size_t Alignment)
+{
+    VERIFY_EXPR(IsPowerOfTwo(Alignment));
+    if (Size + Alignment > PageSize / 2)
+    {
+        // Large allocations get a dedicated page so that the current page is not wasted
+        m_Pages.emplace_back(new Uint8[Size + Alignment]);
+        return AlignUp(m_Pages.back().get(), Alignment);
+    }
+
+    auto* pMem = m_pCurrPos != nullptr ? AlignUp(m_pCurrPos, Alignment) : nullptr;
+    if (pMem == nullptr || pMem + Size > m_pPageEnd)
+    {
+        m_Pages.emplace_back(new Uint8[PageSize]);
+        m_pCurrPos = m_Pages.back().get();
+        m_pPageEnd = m_pCurrPos + PageSize;
+        pMem       = AlignUp(m_pCurrPos, Alignment);
+    }
+    m_pCurrPos = pMem + Size;
+    return pMem;
+}
+
+const Char* GLCommandStream::CopyString(const Char* Str)
+{
+    if (Str == nullptr)
+        return nullptr;
+    return Copy(Str, strlen(Str) + 1);
+}
+
+void GLCommandStream::Execute(DeviceContextGLImpl& Ctx) const
+{
+    for (const auto* pHeader = m_pFirstCmd; pHeader != nullptr; pHeader = pHeader->pNext)
+        pHeader->Execute(pHeader->pCommand, Ctx);
+}
+
+void GLCommandStream::Clear()
+{
+    for (auto* pHeader = m_pFirstCmd; pHeader != nullptr; pHeader = pHeader->pNext)
+    {
+        if (pHeader->Destroy != nullptr)
+            pHeader->Destroy(pHeader->pCommand);
+    }
+    m_pFirstCmd   = nullptr;
+    m_pLastCmd    = nullptr;
+    m_NumCommands = 0;
+
+    m_Pages.clear();
+    m_pCurrPos = nullptr;
+    m_pPageEnd = nullptr;
+
+    m_Objects.clear();
+}
+
+} // namespace Diligent
@@ -47,6 +47,8 @@ GLContextState::GLContextState(RenderDeviceGLImpl* pDeviceGL)
     const auto& AdapterInfo             = pDeviceGL->GetAdapterInfo();
     m_Caps.IsFillModeSelectionSupported = AdapterInfo.Features.WireframeFill;
     m_Caps.IsProgramPipelineSupported   = AdapterInfo.Features.SeparablePrograms;
+    m_Caps.IsDSASupported               = pDeviceGL->IsDSASupported();
+    m_Caps.IsMultiBindSupported         = pDeviceGL->IsMultiBindSupported();
 
     {
         m_Caps.MaxCombinedTexUnits = 0;
@@ -77,6 +79,8 @@ GLContextState::GLContextState(RenderDeviceGLImpl* pDeviceGL)
 
 void GLContextState::Invalidate()
 {
+    VERIFY(!m_IsBindBatchActive, "Context state must not be invalidated while bind batch is active");
+
 #if !PLATFORM_ANDROID
     // On Android this results in OpenGL error, so we will not
     // clear the barriers. All the required barriers will be
@@ -142,7 +146,7 @@ bool UpdateBoundObject(UniqueIdentifier& CurrentObjectID, const ObjectType& NewO
 void GLContextState::SetProgram(const GLProgramObj& GLProgram)
 {
     GLuint GLProgHandle = 0;
-    if (UpdateBoundObject(m_GLProgId, GLProgram, GLProgHandle))
+    if (TrackStateChange(UpdateBoundObject(m_GLProgId, GLProgram, GLProgHandle)))
     {
         glUseProgram(GLProgHandle);
         DEV_CHECK_GL_ERROR("Failed to set GL program");
@@ -152,7 +156,7 @@ void GLContextState::SetProgram(const GLProgramObj& GLProgram)
 void GLContextState::SetPipeline(const GLPipelineObj& GLPipeline)
 {
     GLuint GLPipelineHandle = 0;
-    if (UpdateBoundObject(m_GLPipelineId, GLPipeline, GLPipelineHandle))
+    if (TrackStateChange(UpdateBoundObject(m_GLPipelineId, GLPipeline, GLPipelineHandle)))
     {
         if (m_Caps.IsProgramPipelineSupported)
         {
@@ -169,7 +173,7 @@ void GLContextState::SetPipeline(const GLPipelineObj& GLPipeline)
 void GLContextState::BindVAO(const GLVertexArrayObj& VAO)
 {
     GLuint VAOHandle = 0;
-    if (UpdateBoundObject(m_VAOId, VAO, VAOHandle))
+    if (TrackStateChange(UpdateBoundObject(m_VAOId, VAO, VAOHandle)))
     {
         glBindVertexArray(VAOHandle);
         DEV_CHECK_GL_ERROR("Failed to set VAO");
@@ -179,7 +183,7 @@ void GLContextState::BindVAO(const GLVertexArrayObj& VAO)
 void GLContextState::BindFBO(const GLFrameBufferObj& FBO)
 {
     GLuint FBOHandle = 0;
-    if (UpdateBoundObject(m_FBOId, FBO, FBOHandle))
+    if (TrackStateChange(UpdateBoundObject(m_FBOId, FBO, FBOHandle)))
     {
         // Even though the write mask only applies to writes to a framebuffer, the mask state is NOT
         // Framebuffer state. So it is NOT part of a Framebuffer Object or the Default Framebuffer.
@@ -212,7 +216,7 @@ void GLContextState::SetActiveTexture(Int32 Index)
     }
     VERIFY(0 <= Index && Index < m_Caps.MaxCombinedTexUnits, "Texture unit is out of range");
 
-    if (m_iActiveTexture != Index)
+    if (TrackStateChange(m_iActiveTexture != Index))
     {
         glActiveTexture(GL_TEXTURE0 + Index);
         DEV_CHECK_GL_ERROR("Failed to activate texture slot ", Index);
@@ -222,6 +226,26 @@ void GLContextState::SetActiveTexture(Int32 Index)
 
 void GLContextState::BindTexture(Int32 Index, GLenum BindTarget, const GLObjectWrappers::GLTextureObj& Tex)
 {
+    if (m_IsBindBatchActive)
+    {
+        if (Index >= 0)
+        {
+            VERIFY(Index < m_Caps.MaxCombinedTexUnits, "Texture unit is out of range");
+
+            // glBindTextures() does not use the active texture unit
+            GLuint GLTexHandle = 0;
+            if (UpdateBoundObjectsArr(m_BoundTextures, Index, Tex, GLTexHandle))
+                m_PendingTextures.Set(Index, GLTexHandle);
+            else
+                ++m_Stats.FilteredCalls;
+            return;
+        }
+
+        // The texture is bound to the scratch unit to be accessed right away,
+        // so all pending bindings must be committed first.
+        CommitPendingBindings();
+    }
+
     if (Index < 0)
     {
         Index += m_Caps.MaxCombinedTexUnits;
@@ -232,7 +256,7 @@ void GLContextState::BindTexture(Int32 Index, GLenum BindTarget, const GLObjectW
     SetActiveTexture(Index);
 
     GLuint GLTexHandle = 0;
-    if (UpdateBoundObjectsArr(m_BoundTextures, Index, Tex, GLTexHandle))
+    if (TrackStateChange(UpdateBoundObjectsArr(m_BoundTextures, Index, Tex, GLTexHandle)))
     {
         glBindTexture(BindTarget, GLTexHandle);
         DEV_CHECK_GL_ERROR("Failed to bind texture to slot ", Index);
@@ -242,7 +266,16 @@ void GLContextState::BindTexture(Int32 Index, GLenum BindTarget, const GLObjectW
 void GLContextState::BindSampler(Uint32 Index, const GLObjectWrappers::GLSamplerObj& GLSampler)
 {
     GLuint GLSamplerHandle = 0;
-    if (UpdateBoundObjectsArr(m_BoundSamplers, Index, GLSampler, GLSamplerHandle))
+    if (m_IsBindBatchActive)
+    {
+        if (UpdateBoundObjectsArr(m_BoundSamplers, Index, GLSampler, GLSamplerHandle))
+            m_PendingSamplers.Set(Index, GLSamplerHandle);
+        else
+            ++m_Stats.FilteredCalls;
+        return;
+    }
+
+    if (TrackStateChange(UpdateBoundObjectsArr(m_BoundSamplers, Index, GLSampler, GLSamplerHandle)))
     {
         glBindSampler(Index, GLSamplerHandle);
         DEV_CHECK_GL_ERROR("Failed to bind sampler to slot ", Index);
@@ -270,7 +303,7 @@ void GLContextState::BindImage(Uint32             Index,
         };
     if (Index >= m_BoundImages.size())
         m_BoundImages.resize(size_t{Index} + 1);
-    if (m_BoundImages[Index] != NewImageInfo)
+    if (TrackStateChange(m_BoundImages[Index] != NewImageInfo))
     {
         m_BoundImages[Index] = NewImageInfo;
         glBindImageTexture(Index, NewImageInfo.GLHandle, MipLevel, IsLayered, Layer, Access, Format);
@@ -296,7 +329,7 @@ void GLContextState::BindImage(Uint32 Index, BufferViewGLImpl* pBuffView, GLenum
         };
     if (Index >= m_BoundImages.size())
         m_BoundImages.resize(size_t{Index} + 1);
-    if (m_BoundImages[Index] != NewImageInfo)
+    if (TrackStateChange(m_BoundImages[Index] != NewImageInfo))
     {
         m_BoundImages[Index] = NewImageInfo;
         glBindImageTexture(Index, NewImageInfo.GLHandle, 0, GL_FALSE, 0, Access, Format);
@@ -349,7 +382,21 @@ void GLContextState::BindUniformBuffer(Int32 Index, const GLObjectWrappers::GLBu
     if (Index >= static_cast<Int32>(m_BoundUniformBuffers.size()))
         m_BoundUniformBuffers.resize(static_cast<size_t>(Index) + 1);
 
-    if (m_BoundUniformBuffers[Index] != NewUBOInfo)
+    if (m_IsBindBatchActive)
+    {
+        if (m_BoundUniformBuffers[Index] != NewUBOInfo)
+        {
+            m_BoundUniformBuffers[Index] = NewUBOInfo;
+            m_PendingUniformBuffers.Set(Index, Buff, Offset, Size);
+        }
+        else
+        {
+            ++m_Stats.FilteredCalls;
+        }
+        return;
+    }
+
+    if (TrackStateChange(m_BoundUniformBuffers[Index] != NewUBOInfo))
     {
         m_BoundUniformBuffers[Index] = NewUBOInfo;
         GLuint GLBufferHandle        = Buff;
@@ -367,7 +414,21 @@ void GLContextState::BindStorageBlock(Int32 Index, const GLObjectWrappers::GLBuf
     if (Index >= static_cast<Int32>(m_BoundStorageBlocks.size()))
         m_BoundStorageBlocks.resize(static_cast<size_t>(Index) + 1);
 
-    if (m_BoundStorageBlocks[Index] != NewSSBOInfo)
+    if (m_IsBindBatchActive)
+    {
+        if (m_BoundStorageBlocks[Index] != NewSSBOInfo)
+        {
+            m_BoundStorageBlocks[Index] = NewSSBOInfo;
+            m_PendingStorageBlocks.Set(Index, Buff, Offset, Size);
+        }
+        else
+        {
+            ++m_Stats.FilteredCalls;
+        }
+        return;
+    }
+
+    if (TrackStateChange(m_BoundStorageBlocks[Index] != NewSSBOInfo))
     {
         m_BoundStorageBlocks[Index] = NewSSBOInfo;
         GLuint GLBufferHandle       = Buff;
@@ -381,6 +442,75 @@ void GLContextState::BindStorageBlock(Int32 Index, const GLObjectWrappers::GLBuf
 #endif
 }
 
+void GLContextState::PendingBindRange::Set(Uint32 Slot, GLuint Handle, GLintptr Offset, GLsizeiptr Size)
+{
+    if (Slot >= m_IsPending.size())
+    {
+        const size_t NewSize = size_t{Slot} + 1;
+        m_IsPending.resize(NewSize, false);
+        m_Handles.resize(NewSize);
+        m_Offsets.resize(NewSize);
+        m_Sizes.resize(NewSize);
+    }
+
+    m_IsPending[Slot] = true;
+    m_Handles[Slot]   = Handle;
+    m_Offsets[Slot]   = Offset;
+    m_Sizes[Slot]     = Size;
+
+    m_First = std::min(m_First, Slot);
+    m_Last  = std::max(m_Last, Slot);
+}
+
+void GLContextState::BeginBindBatch()
+{
+    VERIFY(!m_IsBindBatchActive, "Bind batch is already active");
+    m_IsBindBatchActive = m_Caps.IsMultiBindSupported;
+}
+
+void GLContextState::EndBindBatch()
+{
+    if (m_IsBindBatchActive)
+    {
+        CommitPendingBindings();
+        m_IsBindBatchActive = false;
+    }
+}
+
+void GLContextState::CommitPendingBindings()
+{
+#if GL_ARB_multi_bind
+    m_PendingTextures.Commit([this](Uint32 First, Uint32 Count, const GLuint* Handles, const GLintptr*, const GLsizeiptr*) {
+        // If a texture name is non-zero, it is bound to the target of the texture.
+        // If it is zero, all targets of the texture unit are unbound.
+        glBindTextures(First, Count, Handles);
+        DEV_CHECK_GL_ERROR("Failed to bind ", Count, " textures to slots ", First, "...", First + Count - 1);
+        ++m_Stats.IssuedCalls;
+    });
+
+    m_PendingSamplers.Commit([this](Uint32 First, Uint32 Count, const GLuint* Handles, const GLintptr*, const GLsizeiptr*) {
+        glBindSamplers(First, Count, Handles);
+        DEV_CHECK_GL_ERROR("Failed to bind ", Count, " samplers to slots ", First, "...", First + Count - 1);
+        ++m_Stats.IssuedCalls;
+    });
+
+    // Unlike glBindBufferRange(), glBindBuffersRange() does not bind the buffers to the generic binding point
+    m_PendingUniformBuffers.Commit([this](Uint32 First, Uint32 Count, const GLuint* Handles, const GLintptr* Offsets, const GLsizeiptr* Sizes) {
+        glBindBuffersRange(GL_UNIFORM_BUFFER, First, Count, Handles, Offsets, Sizes);
+        DEV_CHECK_GL_ERROR("Failed to bind ", Count, " uniform buffers to slots ", First, "...", First + Count - 1);
+        ++m_Stats.IssuedCalls;
+    });
+
+    m_PendingStorageBlocks.Commit([this](Uint32 First, Uint32 Count, const GLuint* Handles, const GLintptr* Offsets, const GLsizeiptr* Sizes) {
+        glBindBuffersRange(GL_SHADER_STORAGE_BUFFER, First, Count, Handles, Offsets, Sizes);
+        DEV_CHECK_GL_ERROR("Failed to bind ", Count, " shader storage blocks to slots ", First, "...", First + Count - 1);
+        ++m_Stats.IssuedCalls;
+    });
+#else
+    UNSUPPORTED("GL_ARB_multi_bind is not supported");
+#endif
+}
+
 void GLContextState::BindBuffer(GLenum BindTarget, const GLObjectWrappers::GLBufferObj& Buff, bool ResetVAO)
 {
     // Binding ARRAY_BUFFER or ELEMENT_ARRAY_BUFFER affects currently bound VAO
@@ -397,6 +527,7 @@ void GLContextState::BindBuffer(GLenum BindTarget, const GLObjectWrappers::GLBuf
     // must be used to bind a buffer to an indexed uniform buffer, atomic counter buffer or shader storage buffer binding point.
     glBindBuffer(BindTarget, Buff);
     DEV_CHECK_GL_ERROR("Failed to bind buffer ", static_cast<GLint>(Buff), " to target ", BindTarget);
+    ++m_Stats.IssuedCalls;
 }
 
 void GLContextState::EnsureMemoryBarrier(MEMORY_BARRIER RequiredBarriers, AsyncWritableResource* pRes /* = nullptr */)
@@ -438,6 +569,7 @@ void GLContextState::EnsureMemoryBarrier(MEMORY_BARRIER RequiredBarriers, AsyncW
         glMemoryBarrier(RequiredBarriers);
         DEV_CHECK_GL_ERROR("glMemoryBarrier() failed");
         m_PendingMemoryBarriers &= ~RequiredBarriers;
+        ++m_MemoryBarrierCount;
     }
 
     // Leave only these barriers that are still pending
@@ -455,7 +587,7 @@ void GLContextState::SetPendingMemoryBarriers(MEMORY_BARRIER PendingBarriers)
 
 void GLContextState::EnableDepthTest(bool bEnable)
 {
-    if (m_DSState.m_DepthEnableState != bEnable)
+    if (TrackStateChange(m_DSState.m_DepthEnableState != bEnable))
     {
         if (bEnable)
         {
@@ -473,7 +605,7 @@ void GLContextState::EnableDepthTest(bool bEnable)
 
 void GLContextState::EnableDepthWrites(bool bEnable)
 {
-    if (m_DSState.m_DepthWritesEnableState != bEnable)
+    if (TrackStateChange(m_DSState.m_DepthWritesEnableState != bEnable))
     {
         // If mask is non-zero, the depth buffer is enabled for writing; otherwise, it is disabled.
         glDepthMask(bEnable ? 1 : 0);
@@ -484,7 +616,7 @@ void GLContextState::EnableDepthWrites(bool bEnable)
 
 void GLContextState::SetDepthFunc(COMPARISON_FUNCTION CmpFunc)
 {
-    if (m_DSState.m_DepthCmpFunc != CmpFunc)
+    if (TrackStateChange(m_DSState.m_DepthCmpFunc != CmpFunc))
     {
         auto GlCmpFunc = CompareFuncToGLCompareFunc(CmpFunc);
         glDepthFunc(GlCmpFunc);
@@ -495,7 +627,7 @@ void GLContextState::SetDepthFunc(COMPARISON_FUNCTION CmpFunc)
 
 void GLContextState::EnableStencilTest(bool bEnable)
 {
-    if (m_DSState.m_StencilTestEnableState != bEnable)
+    if (TrackStateChange(m_DSState.m_StencilTestEnableState != bEnable))
     {
         if (bEnable)
         {
@@ -513,7 +645,7 @@ void GLContextState::EnableStencilTest(bool bEnable)
 
 void GLContextState::SetStencilWriteMask(Uint8 StencilWriteMask)
 {
-    if (m_DSState.m_StencilWriteMask != StencilWriteMask)
+    if (TrackStateChange(m_DSState.m_StencilWriteMask != StencilWriteMask))
     {
         glStencilMask(StencilWriteMask);
         m_DSState.m_StencilWriteMask = StencilWriteMask;
@@ -526,6 +658,7 @@ void GLContextState::SetStencilRef(GLenum Face, Int32 Ref)
     auto  GlStencilFunc = CompareFuncToGLCompareFunc(FaceStencilOp.Func);
     glStencilFuncSeparate(Face, GlStencilFunc, Ref, FaceStencilOp.Mask);
     DEV_CHECK_GL_ERROR("Failed to set stencil function");
+    ++m_Stats.IssuedCalls;
 }
 
 void GLContextState::SetStencilFunc(GLenum Face, COMPARISON_FUNCTION Func, Int32 Ref, Uint32 Mask)
@@ -541,14 +674,18 @@ void GLContextState::SetStencilFunc(GLenum Face, COMPARISON_FUNCTION Func, Int32
 
         SetStencilRef(Face, Ref);
     }
+    else
+    {
+        ++m_Stats.FilteredCalls;
+    }
 }
 
 void GLContextState::SetStencilOp(GLenum Face, STENCIL_OP StencilFailOp, STENCIL_OP StencilDepthFailOp, STENCIL_OP StencilPassOp)
 {
     auto& FaceStencilOp = m_DSState.m_StencilOpState[Face == GL_FRONT ? 0 : 1];
-    if (FaceStencilOp.StencilFailOp != StencilFailOp ||
-        FaceStencilOp.StencilDepthFailOp != StencilDepthFailOp ||
-        FaceStencilOp.StencilPassOp != StencilPassOp)
+    if (TrackStateChange(FaceStencilOp.StencilFailOp != StencilFailOp ||
+                         FaceStencilOp.StencilDepthFailOp != StencilDepthFailOp ||
+                         FaceStencilOp.StencilPassOp != StencilPassOp))
     {
         auto glsfail = StencilOp2GlStencilOp(StencilFailOp);
         auto dpfail  = StencilOp2GlStencilOp(StencilDepthFailOp);
@@ -567,7 +704,7 @@ void GLContextState::SetFillMode(FILL_MODE FillMode)
 {
     if (m_Caps.IsFillModeSelectionSupported)
     {
-        if (m_RSState.FillMode != FillMode)
+        if (TrackStateChange(m_RSState.FillMode != FillMode))
         {
             if (glPolygonMode != nullptr)
             {
@@ -593,7 +730,7 @@ void GLContextState::SetFillMode(FILL_MODE FillMode)
 
 void GLContextState::SetCullMode(CULL_MODE CullMode)
 {
-    if (m_RSState.CullMode != CullMode)
+    if (TrackStateChange(m_RSState.CullMode != CullMode))
     {
         if (CullMode == CULL_MODE_NONE)
         {
@@ -616,7 +753,7 @@ void GLContextState::SetCullMode(CULL_MODE CullMode)
 
 void GLContextState::SetFrontFace(bool FrontCounterClockwise)
 {
-    if (m_RSState.FrontCounterClockwise != FrontCounterClockwise)
+    if (TrackStateChange(m_RSState.FrontCounterClockwise != FrontCounterClockwise))
     {
         auto FrontFace = FrontCounterClockwise ? GL_CCW : GL_CW;
         glFrontFace(FrontFace);
@@ -627,8 +764,8 @@ void GLContextState::SetFrontFace(bool FrontCounterClockwise)
 
 void GLContextState::SetDepthBias(float fDepthBias, float fSlopeScaledDepthBias)
 {
-    if (m_RSState.fDepthBias != fDepthBias ||
-        m_RSState.fSlopeScaledDepthBias != fSlopeScaledDepthBias)
+    if (TrackStateChange(m_RSState.fDepthBias != fDepthBias ||
+                         m_RSState.fSlopeScaledDepthBias != fSlopeScaledDepthBias))
     {
         if (fDepthBias != 0 || fSlopeScaledDepthBias != 0)
         {
@@ -651,7 +788,7 @@ void GLContextState::SetDepthBias(float fDepthBias, float fSlopeScaledDepthBias)
 
 void GLContextState::SetDepthClamp(bool bEnableDepthClamp)
 {
-    if (m_RSState.DepthClampEnable != bEnableDepthClamp)
+    if (TrackStateChange(m_RSState.DepthClampEnable != bEnableDepthClamp))
     {
         if (bEnableDepthClamp)
         {
@@ -686,7 +823,7 @@ void GLContextState::SetDepthClamp(bool bEnableDepthClamp)
 
 void GLContextState::EnableScissorTest(bool bEnableScissorTest)
 {
-    if (m_RSState.ScissorTestEnable != bEnableScissorTest)
+    if (TrackStateChange(m_RSState.ScissorTestEnable != bEnableScissorTest))
     {
         if (bEnableScissorTest)
         {
@@ -707,6 +844,7 @@ void GLContextState::SetBlendFactors(const float* BlendFactors)
 {
     glBlendColor(BlendFactors[0], BlendFactors[1], BlendFactors[2], BlendFactors[3]);
     DEV_CHECK_GL_ERROR("Failed to set blend color");
+    ++m_Stats.IssuedCalls;
 }
 
 void GLContextState::SetBlendState(const BlendStateDesc& BSDsc, Uint32 SampleMask)
@@ -714,6 +852,9 @@ void GLContextState::SetBlendState(const BlendStateDesc& BSDsc, Uint32 SampleMas
     if (SampleMask != 0xFFFFFFFF)
         LOG_ERROR_MESSAGE("Sample mask is not currently implemented in GL backend");
 
+    // Blend state is not cached and is always set
+    ++m_Stats.IssuedCalls;
+
     bool bEnableBlend = false;
     if (BSDsc.IndependentBlendEnable)
     {
@@ -826,8 +967,8 @@ void GLContextState::SetColorWriteMask(Uint32 RTIndex, Uint32 WriteMask, Bool bI
     if (!bIsIndependent)
         RTIndex = 0;
 
-    if (m_ColorWriteMasks[RTIndex] != WriteMask ||
-        m_bIndependentWriteMasks != bIsIndependent)
+    if (TrackStateChange(m_ColorWriteMasks[RTIndex] != WriteMask ||
+                         m_bIndependentWriteMasks != bIsIndependent))
     {
         if (bIsIndependent)
         {
@@ -871,7 +1012,7 @@ void GLContextState::GetColorWriteMask(Uint32 RTIndex, Uint32& WriteMask, Bool&
 void GLContextState::SetNumPatchVertices(Int32 NumVertices)
 {
 #if GL_ARB_tessellation_shader
-    if (NumVertices != m_NumPatchVertices)
+    if (TrackStateChange(NumVertices != m_NumPatchVertices))
     {
         m_NumPatchVertices = NumVertices;
         glPatchParameteri(GL_PATCH_VERTICES, static_cast<GLint>(NumVertices));
@@ -257,6 +257,10 @@
     DECLARE_GL_FUNCTION_NO_STUB( glClipControl, PFNGLCLIPCONTROLPROC)
 #endif
 
+#ifdef LOAD_GL_BUFFER_STORAGE
+    DECLARE_GL_FUNCTION( glBufferStorage, PFNGLBUFFERSTORAGEPROC, GLenum target, GLsizeiptr size, const void* data, GLbitfield flags )
+#endif
+
 #ifdef LOAD_GL_MULTIDRAW_ARRAYS_INDIRECT
     DECLARE_GL_FUNCTION( glMultiDrawArraysIndirect, PFNGLMULTIDRAWARRAYSINDIRECTPROC, GLenum mode, const void *indirect, GLsizei primcount, GLsizei stride)
 #endif
@@ -505,6 +509,10 @@ void LoadGLFunctions()
     LOAD_GL_FUNCTION_NO_STUB(glClipControl, {{"glClipControlEXT", {3,0}}} );
 #endif
 
+#ifdef LOAD_GL_BUFFER_STORAGE
+    LOAD_GL_FUNCTION2(glBufferStorage, {{"glBufferStorageEXT", {3,1}}} )
+#endif
+
 #ifdef LOAD_GL_MULTIDRAW_ARRAYS_INDIRECT
     LOAD_GL_FUNCTION_NO_STUB(glMultiDrawArraysIndirect, {{"glMultiDrawArraysIndirectEXT", {3,1}}} );
 #endif
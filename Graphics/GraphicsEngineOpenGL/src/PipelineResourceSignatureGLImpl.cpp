@@ -204,6 +204,10 @@ void PipelineResourceSignatureGLImpl::CreateLayout(const bool IsSerialized)
     if (m_pStaticResCache)
     {
         m_pStaticResCache->Initialize(StaticResCounter, GetRawAllocator(), 0x0, 0x0);
+        // Immutable samplers are stored in the static cache too, so that
+        // CopyStaticResources() can copy texture slots as a whole.
+        if (HasDevice())
+            InitImmutableSamplers(*m_pStaticResCache, GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_STATIC));
     }
 }
 
@@ -406,113 +410,43 @@ void PipelineResourceSignatureGLImpl::CopyStaticResources(ShaderResourceCacheGL&
     VERIFY_EXPR(SrcResourceCache.GetContentType() == ResourceCacheContentType::Signature);
     const auto DstCacheType = DstResourceCache.GetContentType();
 
-    const auto StaticResIdxRange = GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
-    for (Uint32 r = StaticResIdxRange.first; r < StaticResIdxRange.second; ++r)
+    // Static resources occupy the first slots of every binding range in both caches,
+    // so all of them are copied at once without going through the resource descriptions.
+    const auto AllResourcesBound = DstResourceCache.CopyStaticResources(SrcResourceCache);
+
+    if (!AllResourcesBound && DstCacheType == ResourceCacheContentType::SRB)
     {
-        const auto& ResDesc = GetResourceDesc(r);
-        const auto& ResAttr = GetResourceAttribs(r);
-        VERIFY_EXPR(ResDesc.VarType == SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
+        const auto StaticResIdxRange = GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
+        for (Uint32 r = StaticResIdxRange.first; r < StaticResIdxRange.second; ++r)
+        {
+            const auto& ResDesc = GetResourceDesc(r);
+            const auto& ResAttr = GetResourceAttribs(r);
+            VERIFY_EXPR(ResDesc.VarType == SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
 
-        if (ResDesc.ResourceType == SHADER_RESOURCE_TYPE_SAMPLER)
-            continue; // Skip separate samplers
+            if (ResDesc.ResourceType == SHADER_RESOURCE_TYPE_SAMPLER)
+                continue; // Skip separate samplers
 
-        static_assert(BINDING_RANGE_COUNT == 4, "Please update the switch below to handle the new shader resource range");
-        switch (PipelineResourceToBindingRange(ResDesc))
-        {
-            case BINDING_RANGE_UNIFORM_BUFFER:
-                for (Uint32 ArrInd = 0; ArrInd < ResDesc.ArraySize; ++ArrInd)
-                {
-                    const auto& SrcCachedRes = SrcResourceCache.GetConstUB(ResAttr.CacheOffset + ArrInd);
-                    if (!SrcCachedRes.pBuffer)
-                    {
-                        if (DstCacheType == ResourceCacheContentType::SRB)
-                            LOG_ERROR_MESSAGE("No resource is assigned to static shader variable '", GetShaderResourcePrintName(ResDesc, ArrInd), "' in pipeline resource signature '", m_Desc.Name, "'.");
-                        continue;
-                    }
-
-                    DstResourceCache.SetUniformBuffer(ResAttr.CacheOffset + ArrInd,
-                                                      RefCntAutoPtr<BufferGLImpl>{SrcCachedRes.pBuffer},
-                                                      SrcCachedRes.BaseOffset, SrcCachedRes.RangeSize);
-                }
-                break;
-            case BINDING_RANGE_STORAGE_BUFFER:
-                for (Uint32 ArrInd = 0; ArrInd < ResDesc.ArraySize; ++ArrInd)
-                {
-                    const auto& SrcCachedRes = SrcResourceCache.GetConstSSBO(ResAttr.CacheOffset + ArrInd);
-                    if (!SrcCachedRes.pBufferView)
-                    {
-                        if (DstCacheType == ResourceCacheContentType::SRB)
-                            LOG_ERROR_MESSAGE("No resource is assigned to static shader variable '", GetShaderResourcePrintName(ResDesc, ArrInd), "' in pipeline resource signature '", m_Desc.Name, "'.");
-                        continue;
-                    }
+            for (Uint32 ArrInd = 0; ArrInd < ResDesc.ArraySize; ++ArrInd)
+            {
+                const auto CacheOffset = ResAttr.CacheOffset + ArrInd;
 
-                    DstResourceCache.SetSSBO(ResAttr.CacheOffset + ArrInd, RefCntAutoPtr<BufferViewGLImpl>{SrcCachedRes.pBufferView});
-                }
-                break;
-            case BINDING_RANGE_TEXTURE:
-                for (Uint32 ArrInd = 0; ArrInd < ResDesc.ArraySize; ++ArrInd)
+                bool IsBound = false;
+                static_assert(BINDING_RANGE_COUNT == 4, "Please update the switch below to handle the new shader resource range");
+                switch (PipelineResourceToBindingRange(ResDesc))
                 {
-                    const auto& SrcCachedRes = SrcResourceCache.GetConstTexture(ResAttr.CacheOffset + ArrInd);
-                    if (!SrcCachedRes.pView)
-                    {
-                        if (DstCacheType == ResourceCacheContentType::SRB)
-                            LOG_ERROR_MESSAGE("No resource is assigned to static shader variable '", GetShaderResourcePrintName(ResDesc, ArrInd), "' in pipeline resource signature '", m_Desc.Name, "'.");
-                        continue;
-                    }
-
-                    if (ResDesc.ResourceType == SHADER_RESOURCE_TYPE_TEXTURE_SRV ||
-                        ResDesc.ResourceType == SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT)
-                    {
-                        const auto HasImmutableSampler = GetImmutableSamplerIdx(ResAttr) != InvalidImmutableSamplerIndex;
-
-                        RefCntAutoPtr<TextureViewGLImpl> pTexViewGl{SrcCachedRes.pView.RawPtr<TextureViewGLImpl>()};
-                        DstResourceCache.SetTexture(ResAttr.CacheOffset + ArrInd, std::move(pTexViewGl), !HasImmutableSampler);
-                        if (HasImmutableSampler && DstCacheType == ResourceCacheContentType::SRB)
-                        {
-                            VERIFY(DstResourceCache.GetConstTexture(ResAttr.CacheOffset + ArrInd).pSampler, "Immutable sampler is not initialized in the cache. This is a bug.");
-                        }
-                    }
-                    else if (ResDesc.ResourceType == SHADER_RESOURCE_TYPE_BUFFER_SRV)
-                    {
-                        RefCntAutoPtr<BufferViewGLImpl> pViewGl{SrcCachedRes.pView.RawPtr<BufferViewGLImpl>()};
-                        DstResourceCache.SetTexelBuffer(ResAttr.CacheOffset + ArrInd, std::move(pViewGl));
-                    }
-                    else
-                    {
-                        UNEXPECTED("Unexpected resource type");
-                    }
+                    // clang-format off
+                    case BINDING_RANGE_UNIFORM_BUFFER: IsBound = SrcResourceCache.GetConstUB(CacheOffset).pBuffer;       break;
+                    case BINDING_RANGE_STORAGE_BUFFER: IsBound = SrcResourceCache.GetConstSSBO(CacheOffset).pBufferView; break;
+                    case BINDING_RANGE_TEXTURE:        IsBound = SrcResourceCache.GetConstTexture(CacheOffset).pView;    break;
+                    case BINDING_RANGE_IMAGE:          IsBound = SrcResourceCache.GetConstImage(CacheOffset).pView;      break;
+                    // clang-format on
+                    default:
+                        UNEXPECTED("Unsupported shader resource range type.");
                 }
-                break;
-            case BINDING_RANGE_IMAGE:
-                for (Uint32 ArrInd = 0; ArrInd < ResDesc.ArraySize; ++ArrInd)
-                {
-                    const auto& SrcCachedRes = SrcResourceCache.GetConstImage(ResAttr.CacheOffset + ArrInd);
-                    if (!SrcCachedRes.pView)
-                    {
-                        if (DstCacheType == ResourceCacheContentType::SRB)
-                            LOG_ERROR_MESSAGE("No resource is assigned to static shader variable '", GetShaderResourcePrintName(ResDesc, ArrInd), "' in pipeline resource signature '", m_Desc.Name, "'.");
-                        continue;
-                    }
 
-                    if (ResDesc.ResourceType == SHADER_RESOURCE_TYPE_TEXTURE_UAV)
-                    {
-                        RefCntAutoPtr<TextureViewGLImpl> pTexViewGl{SrcCachedRes.pView.RawPtr<TextureViewGLImpl>()};
-                        DstResourceCache.SetTexImage(ResAttr.CacheOffset + ArrInd, std::move(pTexViewGl));
-                    }
-                    else if (ResDesc.ResourceType == SHADER_RESOURCE_TYPE_BUFFER_UAV ||
-                             ResDesc.ResourceType == SHADER_RESOURCE_TYPE_BUFFER_SRV)
-                    {
-                        RefCntAutoPtr<BufferViewGLImpl> pViewGl{SrcCachedRes.pView.RawPtr<BufferViewGLImpl>()};
-                        DstResourceCache.SetBufImage(ResAttr.CacheOffset + ArrInd, std::move(pViewGl));
-                    }
-                    else
-                    {
-                        UNEXPECTED("Unexpected resource type");
-                    }
-                }
-                break;
-            default:
-                UNEXPECTED("Unsupported shader resource range type.");
+                if (!IsBound)
+                    LOG_ERROR_MESSAGE("No resource is assigned to static shader variable '", GetShaderResourcePrintName(ResDesc, ArrInd), "' in pipeline resource signature '", m_Desc.Name, "'.");
+            }
         }
     }
 
@@ -528,9 +462,12 @@ void PipelineResourceSignatureGLImpl::CopyStaticResources(ShaderResourceCacheGL&
 void PipelineResourceSignatureGLImpl::InitSRBResourceCache(ShaderResourceCacheGL& ResourceCache)
 {
     ResourceCache.Initialize(m_BindingCount, m_SRBMemAllocator.GetResourceCacheDataAllocator(0), m_DynamicUBOMask, m_DynamicSSBOMask);
+    InitImmutableSamplers(ResourceCache, {0, m_Desc.NumResources});
+}
 
-    // Initialize immutable samplers
-    for (Uint32 r = 0; r < m_Desc.NumResources; ++r)
+void PipelineResourceSignatureGLImpl::InitImmutableSamplers(ShaderResourceCacheGL& ResourceCache, const std::pair<Uint32, Uint32>& ResIdxRange) const
+{
+    for (Uint32 r = ResIdxRange.first; r < ResIdxRange.second; ++r)
     {
         const auto& ResDesc = GetResourceDesc(r);
         const auto& ResAttr = GetResourceAttribs(r);
@@ -0,0 +1,275 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "PipelineStateCacheGLImpl.hpp"
+#include "RenderDeviceGLImpl.hpp"
+#include "ShaderGLImpl.hpp"
+#include "DataBlobImpl.hpp"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Cache data layout:
+//
+//   CacheDataHeader
+//   Driver id (DriverIdLength bytes)
+//   NumPrograms x { ProgramRecordHeader, Binary bytes }
+struct CacheDataHeader
+{
+    static constexpr Uint32 ExpectedMagic   = 0x43504744; // 'DGPC'
+    static constexpr Uint32 ExpectedVersion = 1;
+
+    Uint32 Magic          = ExpectedMagic;
+    Uint32 Version        = ExpectedVersion;
+    Uint32 DriverIdLength = 0;
+    Uint32 NumPrograms    = 0;
+};
+static_assert(sizeof(CacheDataHeader) == 16, "Cache data header size must not change");
+
+struct ProgramRecordHeader
+{
+    Uint64 Hash         = 0;
+    Uint64 SourceLength = 0;
+    Uint32 Format       = 0;
+    Uint32 BinarySize   = 0;
+};
+static_assert(sizeof(ProgramRecordHeader) == 24, "Program record header size must not change");
+
+} // namespace
+
+PipelineStateCacheGLImpl::ProgramKey::ProgramKey(ShaderGLImpl* const* ppShaders, Uint32 NumShaders, bool IsSeparableProgram) noexcept
+{
+    size_t KeyHash = ComputeHash(NumShaders, IsSeparableProgram);
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        const void* pSource = nullptr;
+        Uint64      Length  = 0;
+        ppShaders[i]->GetBytecode(&pSource, Length);
+        HashCombine(KeyHash, ppShaders[i]->GetDesc().ShaderType, ComputeHashRaw(pSource, StaticCast<size_t>(Length)));
+        SourceLength += Length;
+    }
+    Hash = KeyHash;
+}
+
+std::string PipelineStateCacheGLImpl::GetDriverId()
+{
+    std::string DriverId;
+    for (GLenum Name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+    {
+        if (const auto* Str = reinterpret_cast<const char*>(glGetString(Name)))
+            DriverId.append(Str);
+        DriverId.push_back('\n');
+    }
+    return DriverId;
+}
+
+bool PipelineStateCacheGLImpl::ParseCacheData(const void* pData, size_t DataSize)
+{
+    const auto* const pStart = static_cast<const Uint8*>(pData);
+    const auto* const pEnd   = pStart + DataSize;
+
+    CacheDataHeader Header;
+    if (DataSize < sizeof(Header))
+        return false;
+    memcpy(&Header, pStart, sizeof(Header));
+
+    if (Header.Magic != CacheDataHeader::ExpectedMagic || Header.Version != CacheDataHeader::ExpectedVersion)
+        return false;
+
+    const auto* pCurr = pStart + sizeof(Header);
+    if (Header.DriverIdLength > static_cast<size_t>(pEnd - pCurr))
+        return false;
+
+    if (m_DriverId.compare(0, std::string::npos, reinterpret_cast<const char*>(pCurr), Header.DriverIdLength) != 0)
+    {
+        // Program binaries are only compatible with the driver that produced them
+        LOG_INFO_MESSAGE("OpenGL pipeline state cache data was created by a different driver and will be ignored");
+        return true;
+    }
+    pCurr += Header.DriverIdLength;
+
+    for (Uint32 i = 0; i < Header.NumPrograms; ++i)
+    {
+        ProgramRecordHeader Record;
+        if (sizeof(Record) > static_cast<size_t>(pEnd - pCurr))
+            return false;
+        memcpy(&Record, pCurr, sizeof(Record));
+        pCurr += sizeof(Record);
+
+        if (Record.BinarySize > static_cast<size_t>(pEnd - pCurr))
+            return false;
+
+        ProgramKey Key;
+        Key.Hash         = Record.Hash;
+        Key.SourceLength = Record.SourceLength;
+
+        ProgramBinary Binary;
+        Binary.Format = Record.Format;
+        Binary.Data.assign(pCurr, pCurr + Record.BinarySize);
+        pCurr += Record.BinarySize;
+
+        m_Programs.emplace(Key, std::move(Binary));
+    }
+
+    return true;
+}
+
+PipelineStateCacheGLImpl::PipelineStateCacheGLImpl(IReferenceCounters*                 pRefCounters,
+                                                   RenderDeviceGLImpl*                 pRenderDeviceGL,
+                                                   const PipelineStateCacheCreateInfo& CreateInfo) :
+    // clang-format off
+    TPipelineStateCacheBase
+    {
+        pRefCounters,
+        pRenderDeviceGL,
+        CreateInfo,
+        false
+    },
+    m_DriverId{GetDriverId()}
+// clang-format on
+{
+    if (CreateInfo.pCacheData != nullptr && CreateInfo.CacheDataSize > 0 && (m_Desc.Mode & PSO_CACHE_MODE_LOAD) != 0)
+    {
+        if (!ParseCacheData(CreateInfo.pCacheData, CreateInfo.CacheDataSize))
+        {
+            LOG_WARNING_MESSAGE("OpenGL pipeline state cache data is invalid and will be ignored");
+            m_Programs.clear();
+        }
+    }
+}
+
+PipelineStateCacheGLImpl::~PipelineStateCacheGLImpl()
+{
+}
+
+GLObjectWrappers::GLProgramObj PipelineStateCacheGLImpl::LoadProgram(const ProgramKey& Key, bool IsSeparableProgram)
+{
+    if ((m_Desc.Mode & PSO_CACHE_MODE_LOAD) == 0)
+        return GLObjectWrappers::GLProgramObj::Null();
+
+    std::lock_guard<std::mutex> Lock{m_ProgramsMtx};
+
+    auto it = m_Programs.find(Key);
+    if (it == m_Programs.end())
+        return GLObjectWrappers::GLProgramObj::Null();
+
+    const auto& Binary = it->second;
+
+    GLObjectWrappers::GLProgramObj GLProg{true};
+    // GL_PROGRAM_SEPARABLE parameter must be set before loading the binary
+    if (IsSeparableProgram)
+        glProgramParameteri(GLProg, GL_PROGRAM_SEPARABLE, GL_TRUE);
+
+    glProgramBinary(GLProg, Binary.Format, Binary.Data.data(), static_cast<GLsizei>(Binary.Data.size()));
+    GLint IsLinked = GL_FALSE;
+    glGetProgramiv(GLProg, GL_LINK_STATUS, &IsLinked);
+    if (glGetError() != GL_NO_ERROR || !IsLinked)
+    {
+        // The driver may reject binaries for any reason, e.g. after an update
+        // that did not change the version string.
+        LOG_INFO_MESSAGE("Failed to load program binary from the pipeline state cache. The program will be linked from source.");
+        m_Programs.erase(it);
+        return GLObjectWrappers::GLProgramObj::Null();
+    }
+
+    return GLProg;
+}
+
+void PipelineStateCacheGLImpl::StoreProgram(const ProgramKey& Key, GLuint GLProgram)
+{
+    if ((m_Desc.Mode & PSO_CACHE_MODE_STORE) == 0)
+        return;
+
+    GLint BinaryLength = 0;
+    glGetProgramiv(GLProgram, GL_PROGRAM_BINARY_LENGTH, &BinaryLength);
+    if (glGetError() != GL_NO_ERROR || BinaryLength <= 0)
+        return;
+
+    ProgramBinary Binary;
+    Binary.Data.resize(static_cast<size_t>(BinaryLength));
+
+    GLsizei BytesWritten = 0;
+    GLenum  Format       = 0;
+    glGetProgramBinary(GLProgram, BinaryLength, &BytesWritten, &Format, Binary.Data.data());
+    if (glGetError() != GL_NO_ERROR || BytesWritten <= 0)
+    {
+        LOG_INFO_MESSAGE("Failed to retrieve program binary");
+        return;
+    }
+    Binary.Format = Format;
+    Binary.Data.resize(static_cast<size_t>(BytesWritten));
+
+    std::lock_guard<std::mutex> Lock{m_ProgramsMtx};
+    m_Programs.emplace(Key, std::move(Binary));
+}
+
+void PipelineStateCacheGLImpl::GetData(IDataBlob** ppBlob)
+{
+    DEV_CHECK_ERR(ppBlob != nullptr, "ppBlob must not be null");
+    *ppBlob = nullptr;
+
+    std::lock_guard<std::mutex> Lock{m_ProgramsMtx};
+
+    CacheDataHeader Header;
+    Header.DriverIdLength = static_cast<Uint32>(m_DriverId.size());
+    Header.NumPrograms    = static_cast<Uint32>(m_Programs.size());
+
+    size_t DataSize = sizeof(Header) + m_DriverId.size();
+    for (const auto& it : m_Programs)
+        DataSize += sizeof(ProgramRecordHeader) + it.second.Data.size();
+
+    auto  pDataBlob = DataBlobImpl::Create(DataSize);
+    auto* pData     = pDataBlob->GetDataPtr<Uint8>();
+
+    memcpy(pData, &Header, sizeof(Header));
+    pData += sizeof(Header);
+    memcpy(pData, m_DriverId.data(), m_DriverId.size());
+    pData += m_DriverId.size();
+
+    for (const auto& it : m_Programs)
+    {
+        ProgramRecordHeader Record;
+        Record.Hash         = it.first.Hash;
+        Record.SourceLength = it.first.SourceLength;
+        Record.Format       = it.second.Format;
+        Record.BinarySize   = static_cast<Uint32>(it.second.Data.size());
+        memcpy(pData, &Record, sizeof(Record));
+        pData += sizeof(Record);
+        memcpy(pData, it.second.Data.data(), it.second.Data.size());
+        pData += it.second.Data.size();
+    }
+    VERIFY_EXPR(pData == pDataBlob->GetDataPtr<Uint8>() + DataSize);
+
+    *ppBlob = pDataBlob.Detach();
+}
+
+} // namespace Diligent
@@ -35,6 +35,7 @@
 #include "DeviceContextGLImpl.hpp"
 #include "ShaderResourceBindingGLImpl.hpp"
 #include "GLTypeConversions.hpp"
+#include "PipelineStateCacheGLImpl.hpp"
 
 #include "EngineMemory.h"
 
@@ -236,6 +237,20 @@ void PipelineStateGLImpl::InitResourceLayout(PSO_CREATE_INTERNAL_FLAGS InternalF
         LOG_ERROR_AND_THROW("The number of bindings in range '", GetBindingRangeName(BINDING_RANGE_IMAGE), "' is greater than the maximum allowed (", Limits.MaxImagesUnits, ").");
 }
 
+struct PipelineStateGLImpl::PendingLinkInfo
+{
+    // Keep shaders alive until the resource layout is initialized
+    std::vector<RefCntAutoPtr<ShaderGLImpl>> Shaders;
+
+    RefCntAutoPtr<PipelineStateCacheGLImpl> pPSOCache;
+
+    std::vector<PipelineStateCacheGLImpl::ProgramKey> CacheKeys;     // [m_NumPrograms]
+    std::vector<bool>                                 IsLinkPending; // [m_NumPrograms]
+
+    PSO_CREATE_INTERNAL_FLAGS InternalFlags = PSO_CREATE_INTERNAL_FLAG_NONE;
+    SHADER_TYPE               ActiveStages  = SHADER_TYPE_UNKNOWN;
+};
+
 template <typename PSOCreateInfoType>
 void PipelineStateGLImpl::InitInternalObjects(const PSOCreateInfoType& CreateInfo, const TShaderStages& ShaderStages)
 {
@@ -269,27 +284,121 @@ void PipelineStateGLImpl::InitInternalObjects(const PSOCreateInfoType& CreateInf
         ActiveStages |= ShaderType;
     }
 
+    auto* const pPSOCache = ClassPtrCast<PipelineStateCacheGLImpl>(CreateInfo.pPSOCache);
+
+    // With parallel shader compile, the driver links programs in background threads and
+    // the link status is queried by GetStatus().
+    if ((CreateInfo.Flags & (PSO_CREATE_FLAG_ASYNCHRONOUS | PSO_CREATE_FLAG_ASYNCHRONOUS_ON_CACHE_MISS)) != 0 && GetDevice()->IsParallelShaderCompileSupported())
+    {
+        m_pPendingLink = std::make_unique<PendingLinkInfo>();
+        m_pPendingLink->Shaders.assign(ShaderStages.begin(), ShaderStages.end());
+        m_pPendingLink->pPSOCache = pPSOCache;
+        m_pPendingLink->CacheKeys.resize(m_NumPrograms);
+        m_pPendingLink->IsLinkPending.resize(m_NumPrograms, false);
+        m_pPendingLink->InternalFlags = GetInternalCreateFlags(CreateInfo);
+        m_pPendingLink->ActiveStages  = ActiveStages;
+    }
+
+    auto LinkProgram = [&](Uint32 Prog, ShaderGLImpl* const* ppShaders, Uint32 NumShaders, bool IsSeparable) {
+        if (!m_pPendingLink)
+        {
+            m_GLPrograms[Prog] = ShaderGLImpl::LinkProgram(ppShaders, NumShaders, IsSeparable, pPSOCache);
+            return;
+        }
+
+        if (pPSOCache != nullptr)
+        {
+            m_pPendingLink->CacheKeys[Prog] = PipelineStateCacheGLImpl::ProgramKey{ppShaders, NumShaders, IsSeparable};
+            m_GLPrograms[Prog]              = pPSOCache->LoadProgram(m_pPendingLink->CacheKeys[Prog], IsSeparable);
+            if (m_GLPrograms[Prog])
+                return;
+        }
+
+        const bool IsBinaryRetrievable = pPSOCache != nullptr && (pPSOCache->GetDesc().Mode & PSO_CACHE_MODE_STORE) != 0;
+
+        m_GLPrograms[Prog]                  = ShaderGLImpl::BeginLinkProgram(ppShaders, NumShaders, IsSeparable, IsBinaryRetrievable);
+        m_pPendingLink->IsLinkPending[Prog] = true;
+    };
+
     // Create programs.
     if (m_IsProgramPipelineSupported)
     {
         for (size_t i = 0; i < ShaderStages.size(); ++i)
         {
-            auto* pShaderGL  = ShaderStages[i];
-            m_GLPrograms[i]  = GLProgramObj{ShaderGLImpl::LinkProgram(&ShaderStages[i], 1, true)};
+            auto* pShaderGL = ShaderStages[i];
+            LinkProgram(static_cast<Uint32>(i), &ShaderStages[i], 1, true);
             m_ShaderTypes[i] = pShaderGL->GetDesc().ShaderType;
         }
     }
     else
     {
-        m_GLPrograms[0]  = ShaderGLImpl::LinkProgram(ShaderStages.data(), static_cast<Uint32>(ShaderStages.size()), false);
+        LinkProgram(0, ShaderStages.data(), static_cast<Uint32>(ShaderStages.size()), false);
         m_ShaderTypes[0] = ActiveStages;
 
         m_GLPrograms[0].SetName(m_Desc.Name);
     }
 
+    if (m_pPendingLink)
+    {
+        m_Status.store(PIPELINE_STATE_STATUS_COMPILING);
+        return;
+    }
+
     InitResourceLayout(GetInternalCreateFlags(CreateInfo), ShaderStages, ActiveStages);
 }
 
+void PipelineStateGLImpl::FinalizeLink()
+{
+    VERIFY_EXPR(m_pPendingLink);
+    const std::unique_ptr<PendingLinkInfo> pPendingLink = std::move(m_pPendingLink);
+
+    try
+    {
+        for (Uint32 p = 0; p < m_NumPrograms; ++p)
+        {
+            if (!pPendingLink->IsLinkPending[p])
+                continue;
+
+            if (!ShaderGLImpl::GetLinkStatus(m_GLPrograms[p]))
+                LOG_ERROR_AND_THROW("Failed to link program for pipeline state '", m_Desc.Name, "'.");
+
+            if (pPendingLink->pPSOCache)
+                pPendingLink->pPSOCache->StoreProgram(pPendingLink->CacheKeys[p], m_GLPrograms[p]);
+        }
+
+        TShaderStages ShaderStages{pPendingLink->Shaders.begin(), pPendingLink->Shaders.end()};
+        InitResourceLayout(pPendingLink->InternalFlags, ShaderStages, pPendingLink->ActiveStages);
+
+        m_Status.store(PIPELINE_STATE_STATUS_READY);
+    }
+    catch (...)
+    {
+        m_Status.store(PIPELINE_STATE_STATUS_FAILED);
+    }
+}
+
+PIPELINE_STATE_STATUS PipelineStateGLImpl::GetStatus(bool WaitForCompletion)
+{
+    if (m_pPendingLink)
+    {
+        bool IsLinkCompleted = true;
+        if (!WaitForCompletion)
+        {
+            for (Uint32 p = 0; p < m_NumPrograms && IsLinkCompleted; ++p)
+            {
+                if (m_pPendingLink->IsLinkPending[p])
+                    IsLinkCompleted = ShaderGLImpl::IsLinkCompleted(m_GLPrograms[p]);
+            }
+        }
+
+        // GetLinkStatus() blocks until the link is completed by the driver
+        if (IsLinkCompleted)
+            FinalizeLink();
+    }
+
+    return TPipelineStateBase::GetStatus(WaitForCompletion);
+}
+
 PipelineStateGLImpl::PipelineStateGLImpl(IReferenceCounters*                    pRefCounters,
                                          RenderDeviceGLImpl*                    pDeviceGL,
                                          const GraphicsPipelineStateCreateInfo& CreateInfo,
@@ -370,6 +479,8 @@ void PipelineStateGLImpl::Destruct()
 {
     GetDevice()->OnDestroyPSO(*this);
 
+    m_pPendingLink.reset();
+
     if (m_GLPrograms)
     {
         for (Uint32 i = 0; i < m_NumPrograms; ++i)
@@ -47,6 +47,7 @@
 #include "RenderPassGLImpl.hpp"
 #include "FramebufferGLImpl.hpp"
 #include "PipelineResourceSignatureGLImpl.hpp"
+#include "PipelineStateCacheGLImpl.hpp"
 
 #include "GLTypeConversions.hpp"
 #include "VAOCache.hpp"
@@ -174,13 +175,13 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
         GraphicsAdapterInfo{} // Adapter properties can only be queried after GL context is initialized
     },
     // Device caps must be filled in before the constructor of Pipeline Cache is called!
-    m_GLContext{EngineCI, m_DeviceInfo.Type, m_DeviceInfo.APIVersion, pSCDesc}
+    m_GLContext{EngineCI, m_DeviceInfo.Type, m_DeviceInfo.APIVersion, pSCDesc},
+    m_VAOCacheSize{EngineCI.VAOCacheSize},
+    m_FBOCacheSize{EngineCI.FBOCacheSize}
 // clang-format on
 {
     VerifyEngineGLCreateInfo(EngineCI);
 
-    VERIFY(EngineCI.NumDeferredContexts == 0, "EngineCI.NumDeferredContexts > 0 should've been caught by CreateDeviceAndSwapChainGL() or AttachToActiveGLContext()");
-
     GLint NumExtensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &NumExtensions);
     CHECK_GL_ERROR("Failed to get the number of extensions");
@@ -292,6 +293,39 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
 #endif
         }
     }
+
+    // Pipeline state cache stores program binaries, which may not be supported by the driver
+    {
+        GLint NumProgramBinaryFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &NumProgramBinaryFormats);
+        m_IsPSOCacheSupported = glGetError() == GL_NO_ERROR && NumProgramBinaryFormats > 0;
+    }
+
+    // The number of compiler threads is left to the driver's default.
+    m_IsParallelShaderCompileSupported = CheckExtension("GL_KHR_parallel_shader_compile") || CheckExtension("GL_ARB_parallel_shader_compile");
+
+    // Buffer storage is core in GL 4.4, and is only available as an extension in GLES.
+    m_IsBufferStorageSupported =
+        (m_DeviceInfo.Type == RENDER_DEVICE_TYPE_GL && m_DeviceInfo.APIVersion >= Version{4, 4}) ||
+        CheckExtension("GL_ARB_buffer_storage") || CheckExtension("GL_EXT_buffer_storage");
+
+    // Direct state access is core in GL 4.5 and is not available in GLES.
+    m_IsDSASupported =
+        m_DeviceInfo.Type == RENDER_DEVICE_TYPE_GL &&
+        (m_DeviceInfo.APIVersion >= Version{4, 5} || CheckExtension("GL_ARB_direct_state_access"));
+
+    // Multi-bind is core in GL 4.4 and is not available in GLES.
+    m_IsMultiBindSupported =
+        m_DeviceInfo.Type == RENDER_DEVICE_TYPE_GL &&
+        (m_DeviceInfo.APIVersion >= Version{4, 4} || CheckExtension("GL_ARB_multi_bind"));
+
+    // Inverted conditional rendering is core in GL 4.5 and is not available in GLES.
+    m_IsConditionalRenderInvertedSupported =
+        m_DeviceInfo.Type == RENDER_DEVICE_TYPE_GL &&
+        (m_DeviceInfo.APIVersion >= Version{4, 5} || CheckExtension("GL_ARB_conditional_render_inverted"));
+
+    // The memory budget is only available through the NVidia extension.
+    m_IsNVXMemoryInfoSupported = CheckExtension("GL_NVX_gpu_memory_info");
 }
 
 RenderDeviceGLImpl::~RenderDeviceGLImpl()
@@ -303,6 +337,10 @@ IMPLEMENT_QUERY_INTERFACE(RenderDeviceGLImpl, IID_RenderDeviceGL, TRenderDeviceB
 void RenderDeviceGLImpl::InitTexRegionRender()
 {
     m_pTexRegionRender = std::make_unique<TexRegionRender>(this);
+    // Compute-based copies and mip generation are only used on GLES 3.1+, where
+    // glCopyImageSubData may be missing and quad rendering is the only other option.
+    if (m_DeviceInfo.Type == RENDER_DEVICE_TYPE_GLES && m_DeviceInfo.Features.ComputeShaders != DEVICE_FEATURE_STATE_DISABLED)
+        m_pTexRegionCompute = std::make_unique<TexRegionCompute>(this);
 }
 
 void RenderDeviceGLImpl::CreateBuffer(const BufferDesc& BuffDesc, const BufferData* pBuffData, IBuffer** ppBuffer, bool bIsDeviceInternal)
@@ -356,6 +394,9 @@ void RenderDeviceGLImpl::CreateTexture(const TextureDesc& TexDesc, const Texture
                 LOG_ERROR_AND_THROW(FmtInfo.Name, " is not supported texture format");
             }
 
+            if (pData != nullptr && pData->pMemory != nullptr)
+                LOG_ERROR_AND_THROW("Placed textures are not supported in OpenGL");
+
             TextureBaseGL* pTextureOGL = nullptr;
             switch (TexDesc.Type)
             {
@@ -524,6 +565,12 @@ void RenderDeviceGLImpl::CreateQuery(const QueryDesc& Desc, IQuery** ppQuery)
     CreateQueryImpl(ppQuery, Desc);
 }
 
+void RenderDeviceGLImpl::CreateQueryArray(const QueryArrayDesc& Desc, IQueryArray** ppQueryArray)
+{
+    UNSUPPORTED("CreateQueryArray is not supported in OpenGL");
+    *ppQueryArray = nullptr;
+}
+
 void RenderDeviceGLImpl::CreateRenderPass(const RenderPassDesc& Desc, IRenderPass** ppRenderPass)
 {
     CreateRenderPassImpl(ppRenderPass, Desc);
@@ -589,7 +636,13 @@ void RenderDeviceGLImpl::CreateDeviceMemory(const DeviceMemoryCreateInfo& Create
 void RenderDeviceGLImpl::CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
                                                   IPipelineStateCache**               ppPSOCache)
 {
-    *ppPSOCache = nullptr;
+    if (m_IsPSOCacheSupported)
+        CreatePipelineStateCacheImpl(ppPSOCache, CreateInfo);
+    else
+    {
+        LOG_INFO_MESSAGE("Pipeline state cache is not supported as the driver does not support program binaries");
+        *ppPSOCache = nullptr;
+    }
 }
 
 SparseTextureFormatInfo RenderDeviceGLImpl::GetSparseTextureFormatInfo(TEXTURE_FORMAT     TexFormat,
@@ -724,6 +777,7 @@ void RenderDeviceGLImpl::InitAdapterInfo()
         Features.TileShaders                = DEVICE_FEATURE_STATE_DISABLED;
         Features.SubpassFramebufferFetch    = DEVICE_FEATURE_STATE_DISABLED;
         Features.TextureComponentSwizzle    = DEVICE_FEATURE_STATE_DISABLED;
+        Features.ExtendedDynamicState       = DEVICE_FEATURE_STATE_DISABLED;
 
         {
             bool WireframeFillSupported = (glPolygonMode != nullptr);
@@ -981,6 +1035,18 @@ void RenderDeviceGLImpl::InitAdapterInfo()
             if (GLVersion >= Version{4, 6} || CheckExtension("GL_ARB_indirect_parameters"))
                 DrawCommandProps.CapFlags |= DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER;
 
+#if GL_VERSION_3_2
+            // glMultiDrawElementsBaseVertex is core since 3.2
+            if (GLVersion >= Version{3, 2} || CheckExtension("GL_ARB_draw_elements_base_vertex"))
+                DrawCommandProps.CapFlags |= DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW;
+#endif
+
+#if GL_QUERY_WAIT
+            // glBeginConditionalRender is core since 3.0
+            if (GLVersion >= Version{3, 0})
+                DrawCommandProps.CapFlags |= DRAW_COMMAND_CAP_FLAG_QUERY_PREDICATION;
+#endif
+
             // Always 2^32-1 on desktop
             DrawCommandProps.MaxIndexValue = ~Uint32{0};
         }
@@ -1023,7 +1089,7 @@ void RenderDeviceGLImpl::InitAdapterInfo()
         m_AdapterInfo.Queues[0].TextureCopyGranularity[2] = 1;
     }
 
-    ASSERT_SIZEOF(DeviceFeatures, 41, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
+    ASSERT_SIZEOF(DeviceFeatures, 42, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
 }
 
 void RenderDeviceGLImpl::FlagSupportedTexFormats()
@@ -1484,7 +1550,10 @@ void RenderDeviceGLImpl::TestTextureFormat(TEXTURE_FORMAT TexFormat)
 FBOCache& RenderDeviceGLImpl::GetFBOCache(GLContext::NativeGLContextType Context)
 {
     Threading::SpinLockGuard FBOCacheGuard{m_FBOCacheLock};
-    return m_FBOCache[Context];
+    auto                     it = m_FBOCache.find(Context);
+    if (it == m_FBOCache.end())
+        it = m_FBOCache.emplace(std::piecewise_construct, std::forward_as_tuple(Context), std::forward_as_tuple(m_FBOCacheSize)).first;
+    return it->second;
 }
 
 void RenderDeviceGLImpl::OnReleaseTexture(ITexture* pTexture)
@@ -1497,7 +1566,10 @@ void RenderDeviceGLImpl::OnReleaseTexture(ITexture* pTexture)
 VAOCache& RenderDeviceGLImpl::GetVAOCache(GLContext::NativeGLContextType Context)
 {
     Threading::SpinLockGuard VAOCacheGuard{m_VAOCacheLock};
-    return m_VAOCache[Context];
+    auto                     it = m_VAOCache.find(Context);
+    if (it == m_VAOCache.end())
+        it = m_VAOCache.emplace(std::piecewise_construct, std::forward_as_tuple(Context), std::forward_as_tuple(m_VAOCacheSize)).first;
+    return it->second;
 }
 
 void RenderDeviceGLImpl::OnDestroyPSO(PipelineStateGLImpl& PSO)
@@ -1519,4 +1591,33 @@ void RenderDeviceGLImpl::IdleGPU()
     glFinish();
 }
 
+DeviceMemoryBudget RenderDeviceGLImpl::GetMemoryBudget() const
+{
+    DeviceMemoryBudget Budget;
+    if (!m_IsNVXMemoryInfoSupported)
+        return Budget;
+
+#ifndef GL_GPU_MEM_INFO_TOTAL_AVAILABLE_MEM_NVX
+    static constexpr GLenum GL_GPU_MEM_INFO_TOTAL_AVAILABLE_MEM_NVX = 0x9048;
+#endif
+#ifndef GL_GPU_MEM_INFO_CURRENT_AVAILABLE_MEM_NVX
+    static constexpr GLenum GL_GPU_MEM_INFO_CURRENT_AVAILABLE_MEM_NVX = 0x9049;
+#endif
+
+    // https://registry.khronos.org/OpenGL/extensions/NVX/NVX_gpu_memory_info.txt
+    // The extension reports the memory available to all processes, so the usage
+    // includes the memory allocated by other applications.
+    GLint TotalAvailableMemoryKb   = 0;
+    GLint CurrentAvailableMemoryKb = 0;
+    glGetIntegerv(GL_GPU_MEM_INFO_TOTAL_AVAILABLE_MEM_NVX, &TotalAvailableMemoryKb);
+    glGetIntegerv(GL_GPU_MEM_INFO_CURRENT_AVAILABLE_MEM_NVX, &CurrentAvailableMemoryKb);
+    if (glGetError() == GL_NO_ERROR && TotalAvailableMemoryKb >= CurrentAvailableMemoryKb)
+    {
+        Budget.Local.Budget = static_cast<Uint64>(TotalAvailableMemoryKb) * Uint64{1024};
+        Budget.Local.Usage  = static_cast<Uint64>(TotalAvailableMemoryKb - CurrentAvailableMemoryKb) * Uint64{1024};
+    }
+
+    return Budget;
+}
+
 } // namespace Diligent
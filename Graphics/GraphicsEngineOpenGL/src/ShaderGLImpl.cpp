@@ -37,6 +37,7 @@
 #include "GLSLUtils.hpp"
 #include "ShaderToolsCommon.hpp"
 #include "GLTypeConversions.hpp"
+#include "PipelineStateCacheGLImpl.hpp"
 
 using namespace Diligent;
 
@@ -64,14 +65,28 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
     m_GLShaderObj{pDeviceGL != nullptr, GLObjectWrappers::GLShaderObjCreateReleaseHelper{GetGLShaderType(m_Desc.ShaderType)}}
 // clang-format on
 {
-    DEV_CHECK_ERR(ShaderCI.ByteCode == nullptr, "'ByteCode' must be null when shader is created from the source code or a file");
     DEV_CHECK_ERR(ShaderCI.ShaderCompiler == SHADER_COMPILER_DEFAULT, "only default compiler is supported in OpenGL");
 
     const auto& DeviceInfo  = GLShaderCI.DeviceInfo;
     const auto& AdapterInfo = GLShaderCI.AdapterInfo;
 
     ShaderSourceFileData SourceData;
-    if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM)
+    if (ShaderCI.ByteCode != nullptr)
+    {
+        DEV_CHECK_ERR(ShaderCI.ByteCodeSize != 0, "ByteCodeSize must not be zero");
+
+        // The byte code is the full GLSL source previously returned by GetBytecode(),
+        // e.g. loaded from the byte code cache. Use it as is to skip the conversion.
+        m_GLSLSourceString.assign(static_cast<const char*>(ShaderCI.ByteCode), ShaderCI.ByteCodeSize);
+        // The size may include the null terminator
+        while (!m_GLSLSourceString.empty() && m_GLSLSourceString.back() == '\0')
+            m_GLSLSourceString.pop_back();
+
+        auto SourceLang = ParseShaderSourceLanguageDefinition(m_GLSLSourceString);
+        if (SourceLang != SHADER_SOURCE_LANGUAGE_DEFAULT)
+            m_SourceLanguage = SourceLang;
+    }
+    else if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM)
     {
         if (ShaderCI.Macros != nullptr)
         {
@@ -206,7 +221,34 @@ ShaderGLImpl::~ShaderGLImpl()
 IMPLEMENT_QUERY_INTERFACE2(ShaderGLImpl, IID_ShaderGL, IID_InternalImpl, TShaderBase)
 
 
-GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl* const* ppShaders, Uint32 NumShaders, bool IsSeparableProgram)
+GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl* const*      ppShaders,
+                                                         Uint32                    NumShaders,
+                                                         bool                      IsSeparableProgram,
+                                                         PipelineStateCacheGLImpl* pPSOCache)
+{
+    PipelineStateCacheGLImpl::ProgramKey CacheKey;
+    if (pPSOCache != nullptr)
+    {
+        CacheKey = PipelineStateCacheGLImpl::ProgramKey{ppShaders, NumShaders, IsSeparableProgram};
+        if (auto CachedProg = pPSOCache->LoadProgram(CacheKey, IsSeparableProgram))
+            return CachedProg;
+    }
+
+    const bool IsBinaryRetrievable = pPSOCache != nullptr && (pPSOCache->GetDesc().Mode & PSO_CACHE_MODE_STORE) != 0;
+
+    GLObjectWrappers::GLProgramObj GLProg = BeginLinkProgram(ppShaders, NumShaders, IsSeparableProgram, IsBinaryRetrievable);
+    if (!GetLinkStatus(GLProg))
+        UNEXPECTED("glLinkProgram failed");
+    else if (pPSOCache != nullptr)
+        pPSOCache->StoreProgram(CacheKey, GLProg);
+
+    return GLProg;
+}
+
+GLObjectWrappers::GLProgramObj ShaderGLImpl::BeginLinkProgram(ShaderGLImpl* const* ppShaders,
+                                                              Uint32               NumShaders,
+                                                              bool                 IsSeparableProgram,
+                                                              bool                 IsBinaryRetrievable)
 {
     VERIFY(!IsSeparableProgram || NumShaders == 1, "Number of shaders must be 1 when separable program is created");
 
@@ -216,6 +258,10 @@ GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl* const* pp
     if (IsSeparableProgram)
         glProgramParameteri(GLProg, GL_PROGRAM_SEPARABLE, GL_TRUE);
 
+    // Some drivers only keep the binary of programs linked with the retrievable hint
+    if (IsBinaryRetrievable)
+        glProgramParameteri(GLProg, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
     for (Uint32 i = 0; i < NumShaders; ++i)
     {
         auto* pCurrShader = ppShaders[i];
@@ -235,6 +281,29 @@ GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl* const* pp
     //of the inputs on the interface will be undefined.
     glLinkProgram(GLProg);
     CHECK_GL_ERROR("glLinkProgram() failed");
+
+    // Shaders can be detached as soon as the link is submitted, even if the driver
+    // completes it later (see GL_KHR_parallel_shader_compile).
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        auto* pCurrShader = ClassPtrCast<const ShaderGLImpl>(ppShaders[i]);
+        glDetachShader(GLProg, pCurrShader->m_GLShaderObj);
+        CHECK_GL_ERROR("glDetachShader() failed");
+    }
+
+    return GLProg;
+}
+
+bool ShaderGLImpl::IsLinkCompleted(GLuint GLProg)
+{
+    GLint IsCompleted = GL_TRUE;
+    glGetProgramiv(GLProg, GL_COMPLETION_STATUS_KHR, &IsCompleted);
+    CHECK_GL_ERROR("glGetProgramiv(GL_COMPLETION_STATUS_KHR) failed");
+    return IsCompleted != GL_FALSE;
+}
+
+bool ShaderGLImpl::GetLinkStatus(GLuint GLProg)
+{
     int IsLinked = GL_FALSE;
     glGetProgramiv(GLProg, GL_LINK_STATUS, &IsLinked);
     CHECK_GL_ERROR("glGetProgramiv() failed");
@@ -252,17 +321,9 @@ GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl* const* pp
         glGetProgramInfoLog(GLProg, LengthWithNull, &Length, shaderProgramInfoLog.data());
         VERIFY(Length == LengthWithNull - 1, "Incorrect program info log len");
         LOG_ERROR_MESSAGE("Failed to link shader program:\n", shaderProgramInfoLog.data(), '\n');
-        UNEXPECTED("glLinkProgram failed");
-    }
-
-    for (Uint32 i = 0; i < NumShaders; ++i)
-    {
-        auto* pCurrShader = ClassPtrCast<const ShaderGLImpl>(ppShaders[i]);
-        glDetachShader(GLProg, pCurrShader->m_GLShaderObj);
-        CHECK_GL_ERROR("glDetachShader() failed");
     }
 
-    return GLProg;
+    return IsLinked != GL_FALSE;
 }
 
 Uint32 ShaderGLImpl::GetResourceCount() const
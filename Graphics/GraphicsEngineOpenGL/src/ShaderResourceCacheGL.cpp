@@ -120,6 +120,79 @@ ShaderResourceCacheGL::~ShaderResourceCacheGL()
     m_pResourceData.reset();
 }
 
+bool ShaderResourceCacheGL::CopyStaticResources(const ShaderResourceCacheGL& SrcCache)
+{
+    VERIFY_EXPR(SrcCache.GetContentType() == ResourceCacheContentType::Signature);
+    // clang-format off
+    VERIFY(SrcCache.GetUBCount()      <= GetUBCount()      &&
+           SrcCache.GetTextureCount() <= GetTextureCount() &&
+           SrcCache.GetImageCount()   <= GetImageCount()   &&
+           SrcCache.GetSSBOCount()    <= GetSSBOCount(),
+           "Source cache must not contain more resources than the destination cache");
+    // clang-format on
+
+    bool AllResourcesBound = true;
+
+    // Cached resources are copied directly: the strong references are added by the
+    // RefCntAutoPtr assignments, while the raw texture, buffer and sampler pointers
+    // have already been resolved in the source cache.
+    for (Uint32 ub = 0; ub < SrcCache.GetUBCount(); ++ub)
+    {
+        const auto& SrcUB = SrcCache.GetConstUB(ub);
+        if (!SrcUB.pBuffer)
+        {
+            AllResourcesBound = false;
+            continue;
+        }
+
+        auto& DstUB         = GetUB(ub);
+        DstUB               = SrcUB;
+        DstUB.DynamicOffset = 0;
+        UpdateDynamicUBOMask(ub);
+    }
+
+    for (Uint32 t = 0; t < SrcCache.GetTextureCount(); ++t)
+    {
+        const auto& SrcTex = SrcCache.GetConstTexture(t);
+        if (!SrcTex.pView)
+        {
+            AllResourcesBound = false;
+            continue;
+        }
+        GetTexture(t) = SrcTex;
+    }
+
+    for (Uint32 img = 0; img < SrcCache.GetImageCount(); ++img)
+    {
+        const auto& SrcImg = SrcCache.GetConstImage(img);
+        if (!SrcImg.pView)
+        {
+            AllResourcesBound = false;
+            continue;
+        }
+        GetImage(img) = SrcImg;
+    }
+
+    for (Uint32 s = 0; s < SrcCache.GetSSBOCount(); ++s)
+    {
+        const auto& SrcSSBO = SrcCache.GetConstSSBO(s);
+        if (!SrcSSBO.pBufferView)
+        {
+            AllResourcesBound = false;
+            continue;
+        }
+
+        auto& DstSSBO         = GetSSBO(s);
+        DstSSBO               = SrcSSBO;
+        DstSSBO.DynamicOffset = 0;
+        UpdateDynamicSSBOMask(s);
+    }
+
+    UpdateRevision();
+
+    return AllResourcesBound;
+}
+
 void ShaderResourceCacheGL::BindResources(GLContextState&              GLState,
                                           const std::array<Uint16, 4>& BaseBindings,
                                           std::vector<TextureBaseGL*>& WritableTextures,
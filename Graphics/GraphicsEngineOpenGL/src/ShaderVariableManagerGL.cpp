@@ -446,36 +446,38 @@ void ShaderVariableManagerGL::CheckResources(IResourceMapping*
 }
 
 template <typename ResourceType>
-IShaderResourceVariable* ShaderVariableManagerGL::GetResourceByName(const Char* Name) const
+IShaderResourceVariable* ShaderVariableManagerGL::GetResourceByResIndex(Uint32 ResIndex) const
 {
-    auto NumResources = GetNumResources<ResourceType>();
-    for (Uint32 res = 0; res < NumResources; ++res)
-    {
-        auto&       Resource = GetResource<ResourceType>(res);
-        const auto& ResDesc  = Resource.GetDesc();
-        if (strcmp(ResDesc.Name, Name) == 0)
-            return &Resource;
-    }
-
-    return nullptr;
+    const auto NumResources = GetNumResources<ResourceType>();
+    return NumResources > 0 ?
+        FindVariableByResIndex(&GetResource<ResourceType>(0), NumResources, ResIndex) :
+        nullptr;
 }
 
 
-IShaderResourceVariable* ShaderVariableManagerGL::GetVariable(const Char* Name) const
+IShaderResourceVariable* ShaderVariableManagerGL::GetVariable(SHADER_TYPE ShaderType, const Char* Name) const
 {
-    if (auto* pUB = GetResourceByName<UniformBuffBindInfo>(Name))
-        return pUB;
-
-    if (auto* pTexture = GetResourceByName<TextureBindInfo>(Name))
-        return pTexture;
+    const auto ResIndex = m_pSignature->FindResource(ShaderType, Name);
+    if (ResIndex == InvalidPipelineResourceIndex)
+        return nullptr;
 
-    if (auto* pImage = GetResourceByName<ImageBindInfo>(Name))
-        return pImage;
+    const auto& ResDesc = GetResourceDesc(ResIndex);
+    // Samplers are never initialized as variables
+    if (ResDesc.ResourceType == SHADER_RESOURCE_TYPE_SAMPLER)
+        return nullptr;
 
-    if (auto* pSSBO = GetResourceByName<StorageBufferBindInfo>(Name))
-        return pSSBO;
-
-    return nullptr;
+    static_assert(BINDING_RANGE_COUNT == 4, "Please update the switch below to handle the new shader resource range");
+    switch (PipelineResourceToBindingRange(ResDesc))
+    {
+        // clang-format off
+        case BINDING_RANGE_UNIFORM_BUFFER: return GetResourceByResIndex<UniformBuffBindInfo>  (ResIndex);
+        case BINDING_RANGE_TEXTURE:        return GetResourceByResIndex<TextureBindInfo>      (ResIndex);
+        case BINDING_RANGE_IMAGE:          return GetResourceByResIndex<ImageBindInfo>        (ResIndex);
+        case BINDING_RANGE_STORAGE_BUFFER: return GetResourceByResIndex<StorageBufferBindInfo>(ResIndex);
+        // clang-format on
+        default:
+            return nullptr;
+    }
 }
 
 class ShaderVariableLocator
@@ -0,0 +1,412 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "TexRegionCompute.hpp"
+#include "RenderDeviceGLImpl.hpp"
+#include "DeviceContextGLImpl.hpp"
+#include "TextureViewGLImpl.hpp"
+#include "../../GraphicsTools/interface/MapHelper.hpp"
+
+
+namespace Diligent
+{
+
+static constexpr Uint32 ThreadGroupSize = 8;
+
+static Uint32 GetComponentTypeIndex(TEXTURE_FORMAT Format)
+{
+    const auto& FmtAttribs = GetTextureFormatAttribs(Format);
+    switch (FmtAttribs.ComponentType)
+    {
+        case COMPONENT_TYPE_SINT: return 1;
+        case COMPONENT_TYPE_UINT: return 2;
+        default: return 0;
+    }
+}
+
+static const char* CmpTypePrefix[3] = {"", "i", "u"};
+
+// clang-format off
+static const Char* MipShaderSource =
+{
+    "void main()                                                            \n"
+    "{                                                                      \n"
+    "    ivec2 DstCoord = ivec2(gl_GlobalInvocationID.xy);                  \n"
+    "    ivec2 DstSize  = imageSize(gDstMip);                               \n"
+    "    if (DstCoord.x >= DstSize.x || DstCoord.y >= DstSize.y)            \n"
+    "        return;                                                        \n"
+    "    ivec2 MaxCoord = imageSize(gSrcMip) - ivec2(1, 1);                 \n"
+    "    ivec2 SrcCoord = DstCoord * 2;                                     \n"
+    "    vec4 Color =                                                       \n"
+    "        imageLoad(gSrcMip, min(SrcCoord,               MaxCoord)) +    \n"
+    "        imageLoad(gSrcMip, min(SrcCoord + ivec2(1, 0), MaxCoord)) +    \n"
+    "        imageLoad(gSrcMip, min(SrcCoord + ivec2(0, 1), MaxCoord)) +    \n"
+    "        imageLoad(gSrcMip, min(SrcCoord + ivec2(1, 1), MaxCoord));     \n"
+    "    imageStore(gDstMip, DstCoord, Color * 0.25);                       \n"
+    "}                                                                      \n"
+};
+// clang-format on
+
+TexRegionCompute::TexRegionCompute(RenderDeviceGLImpl* pDeviceGL) :
+    m_pDeviceGL{pDeviceGL}
+{
+    BufferDesc CBDesc;
+    CBDesc.Name                           = "TexRegionCompute: CS constants CB";
+    CBDesc.Size                           = sizeof(Int32) * 8;
+    CBDesc.Usage                          = USAGE_DYNAMIC;
+    CBDesc.BindFlags                      = BIND_UNIFORM_BUFFER;
+    CBDesc.CPUAccessFlags                 = CPU_ACCESS_WRITE;
+    constexpr bool IsInternalDeviceObject = true;
+    m_pDeviceGL->CreateBuffer(CBDesc, nullptr, &m_pConstantBuffer, IsInternalDeviceObject);
+}
+
+const char* TexRegionCompute::GetImageFormatQualifier(TEXTURE_FORMAT Format)
+{
+    // Formats that are guaranteed to be supported by image load/store in GLES 3.1
+    switch (Format)
+    {
+        // clang-format off
+        case TEX_FORMAT_RGBA32_FLOAT: return "rgba32f";
+        case TEX_FORMAT_RGBA16_FLOAT: return "rgba16f";
+        case TEX_FORMAT_R32_FLOAT:    return "r32f";
+        case TEX_FORMAT_RGBA8_UNORM:  return "rgba8";
+        case TEX_FORMAT_RGBA8_SNORM:  return "rgba8_snorm";
+        case TEX_FORMAT_RGBA32_SINT:  return "rgba32i";
+        case TEX_FORMAT_RGBA16_SINT:  return "rgba16i";
+        case TEX_FORMAT_RGBA8_SINT:   return "rgba8i";
+        case TEX_FORMAT_R32_SINT:     return "r32i";
+        case TEX_FORMAT_RGBA32_UINT:  return "rgba32ui";
+        case TEX_FORMAT_RGBA16_UINT:  return "rgba16ui";
+        case TEX_FORMAT_RGBA8_UINT:   return "rgba8ui";
+        case TEX_FORMAT_R32_UINT:     return "r32ui";
+        // clang-format on
+        default: return nullptr;
+    }
+}
+
+bool TexRegionCompute::CanCopy(const TextureDesc& SrcTexDesc, const TextureDesc& DstTexDesc) const
+{
+    // There is no texelFetch() for texture cube [array] and no 1D images in GLES
+    if (SrcTexDesc.Type != RESOURCE_DIM_TEX_2D &&
+        SrcTexDesc.Type != RESOURCE_DIM_TEX_2D_ARRAY &&
+        SrcTexDesc.Type != RESOURCE_DIM_TEX_3D)
+        return false;
+
+    if (DstTexDesc.Type == RESOURCE_DIM_TEX_1D ||
+        DstTexDesc.Type == RESOURCE_DIM_TEX_1D_ARRAY)
+        return false;
+
+    if (SrcTexDesc.SampleCount > 1 || DstTexDesc.SampleCount > 1)
+        return false;
+
+    if (GetImageFormatQualifier(DstTexDesc.Format) == nullptr)
+        return false;
+
+    const auto& FmtInfo = m_pDeviceGL->GetTextureFormatInfoExt(DstTexDesc.Format);
+    return (FmtInfo.BindFlags & BIND_UNORDERED_ACCESS) != 0;
+}
+
+bool TexRegionCompute::CanGenerateMips(const TextureDesc& TexDesc, const TextureViewDesc& ViewDesc) const
+{
+    if (TexDesc.Type != RESOURCE_DIM_TEX_2D &&
+        TexDesc.Type != RESOURCE_DIM_TEX_2D_ARRAY &&
+        TexDesc.Type != RESOURCE_DIM_TEX_CUBE &&
+        TexDesc.Type != RESOURCE_DIM_TEX_CUBE_ARRAY)
+        return false;
+
+    if (TexDesc.SampleCount > 1)
+        return false;
+
+    // Integer formats can't be filtered, and sRGB formats can't be used with images
+    const auto& FmtAttribs = GetTextureFormatAttribs(ViewDesc.Format);
+    if (FmtAttribs.ComponentType != COMPONENT_TYPE_UNORM &&
+        FmtAttribs.ComponentType != COMPONENT_TYPE_SNORM &&
+        FmtAttribs.ComponentType != COMPONENT_TYPE_FLOAT)
+        return false;
+
+    if (GetImageFormatQualifier(ViewDesc.Format) == nullptr)
+        return false;
+
+    const auto& FmtInfo = m_pDeviceGL->GetTextureFormatInfoExt(ViewDesc.Format);
+    return (FmtInfo.BindFlags & BIND_UNORDERED_ACCESS) != 0;
+}
+
+TexRegionCompute::ComputePipeline TexRegionCompute::CreatePipeline(const char* Name, const String& Source, bool UseConstants)
+{
+    constexpr bool IsInternalDeviceObject = true;
+
+    ShaderCreateInfo ShaderAttrs;
+    ShaderAttrs.Desc.Name       = Name;
+    ShaderAttrs.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderAttrs.Source          = Source.c_str();
+
+    RefCntAutoPtr<IShader> pCS;
+    m_pDeviceGL->CreateShader(ShaderAttrs, &pCS, IsInternalDeviceObject);
+
+    ComputePipeline Pipeline;
+    if (!pCS)
+        return Pipeline;
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name         = Name;
+    PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.pCS                  = pCS;
+
+    auto& ResourceLayout = PSOCreateInfo.PSODesc.ResourceLayout;
+
+    ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+    ShaderResourceVariableDesc Vars[] =
+        {
+            {SHADER_TYPE_COMPUTE, "cbConstants", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE} //
+        };
+    if (UseConstants)
+    {
+        ResourceLayout.NumVariables = _countof(Vars);
+        ResourceLayout.Variables    = Vars;
+    }
+
+    m_pDeviceGL->CreateComputePipelineState(PSOCreateInfo, &Pipeline.pPSO, IsInternalDeviceObject);
+    if (!Pipeline.pPSO)
+        return Pipeline;
+
+    Pipeline.pPSO->CreateShaderResourceBinding(&Pipeline.pSRB);
+    if (UseConstants)
+        Pipeline.pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "cbConstants")->Set(m_pConstantBuffer);
+
+    return Pipeline;
+}
+
+TexRegionCompute::ComputePipeline& TexRegionCompute::GetCopyPipeline(RESOURCE_DIMENSION SrcType, TEXTURE_FORMAT SrcFormat, TEXTURE_FORMAT DstFormat)
+{
+    const auto SrcCmpType = GetComponentTypeIndex(SrcFormat);
+    const auto DstCmpType = GetComponentTypeIndex(DstFormat);
+
+    const Uint32 Key = static_cast<Uint32>(SrcType) | (SrcCmpType << 4u) | (static_cast<Uint32>(DstFormat) << 8u);
+    auto         It  = m_CopyPipelines.find(Key);
+    if (It != m_CopyPipelines.end())
+        return It->second;
+
+    static const char* SamplerType[RESOURCE_DIM_NUM_DIMENSIONS] = {};
+
+    SamplerType[RESOURCE_DIM_TEX_2D]       = "sampler2D";
+    SamplerType[RESOURCE_DIM_TEX_2D_ARRAY] = "sampler2DArray";
+    SamplerType[RESOURCE_DIM_TEX_3D]       = "sampler3D";
+
+    static const char* SrcLocations[RESOURCE_DIM_NUM_DIMENSIONS] = {};
+
+    SrcLocations[RESOURCE_DIM_TEX_2D]       = "DstCoord + Constants.xy";
+    SrcLocations[RESOURCE_DIM_TEX_2D_ARRAY] = "ivec3(DstCoord + Constants.xy, Constants.z)";
+    SrcLocations[RESOURCE_DIM_TEX_3D]       = "ivec3(DstCoord + Constants.xy, Constants.z)";
+
+    VERIFY(SamplerType[SrcType] != nullptr, "Unsupported source texture type");
+    const auto* DstQualifier = GetImageFormatQualifier(DstFormat);
+    VERIFY(DstQualifier != nullptr, "Unsupported destination texture format");
+
+    const auto* SrcPrefix = CmpTypePrefix[SrcCmpType];
+    const auto* DstPrefix = CmpTypePrefix[DstCmpType];
+
+    std::stringstream SourceSS;
+    SourceSS << "layout(local_size_x = " << ThreadGroupSize << ", local_size_y = " << ThreadGroupSize << ", local_size_z = 1) in;\n"
+             << "uniform " << SrcPrefix << SamplerType[SrcType] << " gSourceTex;\n"
+             << "layout(" << DstQualifier << ") uniform writeonly " << DstPrefix << "image2D gDstImage;\n"
+             << "uniform cbConstants\n"
+                "{\n"
+                "    ivec4 Constants;\n" // xy - dst to src offset, z - src slice, w - src mip
+                "    ivec4 DstRegion;\n" // xy - dst offset, zw - region size
+                "};\n"
+                "void main()\n"
+                "{\n"
+                "    ivec2 Offset = ivec2(gl_GlobalInvocationID.xy);\n"
+                "    if (Offset.x >= DstRegion.z || Offset.y >= DstRegion.w)\n"
+                "        return;\n"
+                "    ivec2 DstCoord = DstRegion.xy + Offset;\n"
+                "    imageStore(gDstImage, DstCoord, "
+             << DstPrefix << "vec4(texelFetch(gSourceTex, " << SrcLocations[SrcType] << ", Constants.w)));\n"
+             << "}\n";
+
+    String Name = "TexRegionCompute : Copy ";
+    Name.append(SrcPrefix);
+    Name.append(SamplerType[SrcType]);
+    Name.append(" to ");
+    Name.append(DstQualifier);
+
+    return m_CopyPipelines.emplace(Key, CreatePipeline(Name.c_str(), SourceSS.str(), true)).first->second;
+}
+
+TexRegionCompute::ComputePipeline& TexRegionCompute::GetMipPipeline(TEXTURE_FORMAT Format)
+{
+    const Uint32 Key = static_cast<Uint32>(Format);
+    auto         It  = m_MipPipelines.find(Key);
+    if (It != m_MipPipelines.end())
+        return It->second;
+
+    const auto* Qualifier = GetImageFormatQualifier(Format);
+    VERIFY(Qualifier != nullptr, "Unsupported texture format");
+
+    std::stringstream SourceSS;
+    SourceSS << "layout(local_size_x = " << ThreadGroupSize << ", local_size_y = " << ThreadGroupSize << ", local_size_z = 1) in;\n"
+             << "layout(" << Qualifier << ") uniform readonly image2D gSrcMip;\n"
+             << "layout(" << Qualifier << ") uniform writeonly image2D gDstMip;\n"
+             << MipShaderSource;
+
+    String Name = "TexRegionCompute : Generate mips ";
+    Name.append(Qualifier);
+
+    return m_MipPipelines.emplace(Key, CreatePipeline(Name.c_str(), SourceSS.str(), false)).first->second;
+}
+
+void TexRegionCompute::SetStates(DeviceContextGLImpl* pCtxGL)
+{
+    pCtxGL->GetPipelineState(&m_pOrigPSO, m_OrigBlendFactors, m_OrigStencilRef);
+}
+
+void TexRegionCompute::RestoreStates(DeviceContextGLImpl* pCtxGL)
+{
+    if (m_pOrigPSO)
+        pCtxGL->SetPipelineState(m_pOrigPSO);
+    m_pOrigPSO.Release();
+}
+
+void TexRegionCompute::Copy(DeviceContextGLImpl* pCtxGL,
+                            ITextureView*        pSrcSRV,
+                            ITextureView*        pDstUAV,
+                            Int32                DstToSrcXOffset,
+                            Int32                DstToSrcYOffset,
+                            Int32                SrcZ,
+                            Int32                SrcMipLevel,
+                            Uint32               DstX,
+                            Uint32               DstY,
+                            Uint32               Width,
+                            Uint32               Height)
+{
+    auto& Pipeline = GetCopyPipeline(pSrcSRV->GetTexture()->GetDesc().Type, pSrcSRV->GetDesc().Format, pDstUAV->GetDesc().Format);
+    DEV_CHECK_ERR(Pipeline.pPSO, "TexRegionCompute failed to create the copy pipeline");
+    if (!Pipeline.pPSO)
+        return;
+
+    {
+        MapHelper<int> pConstant(pCtxGL, m_pConstantBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
+        pConstant[0] = DstToSrcXOffset;
+        pConstant[1] = DstToSrcYOffset;
+        pConstant[2] = SrcZ;
+        pConstant[3] = SrcMipLevel;
+        pConstant[4] = static_cast<Int32>(DstX);
+        pConstant[5] = static_cast<Int32>(DstY);
+        pConstant[6] = static_cast<Int32>(Width);
+        pConstant[7] = static_cast<Int32>(Height);
+    }
+
+    auto* pSrcTexVar = Pipeline.pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "gSourceTex");
+    auto* pDstImgVar = Pipeline.pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "gDstImage");
+
+    pCtxGL->SetPipelineState(Pipeline.pPSO);
+    pSrcTexVar->Set(pSrcSRV);
+    pDstImgVar->Set(pDstUAV);
+    pCtxGL->CommitShaderResources(Pipeline.pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    DispatchComputeAttribs DispatchAttrs{
+        (Width + ThreadGroupSize - 1) / ThreadGroupSize,
+        (Height + ThreadGroupSize - 1) / ThreadGroupSize //
+    };
+    pCtxGL->DispatchCompute(DispatchAttrs);
+
+    // The views may be temporary objects, so release them before they go out of scope
+    pSrcTexVar->Set(nullptr);
+    pDstImgVar->Set(nullptr);
+}
+
+void TexRegionCompute::GenerateMips(DeviceContextGLImpl* pCtxGL, TextureViewGLImpl* pTexView)
+{
+    const auto& ViewDesc = pTexView->GetDesc();
+    auto*       pTexGL   = pTexView->GetTexture<TextureBaseGL>();
+    const auto& TexDesc  = pTexGL->GetDesc();
+
+    auto& Pipeline = GetMipPipeline(ViewDesc.Format);
+    DEV_CHECK_ERR(Pipeline.pPSO, "TexRegionCompute failed to create the mip generation pipeline");
+    if (!Pipeline.pPSO)
+        return;
+
+    auto* pSrcMipVar = Pipeline.pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "gSrcMip");
+    auto* pDstMipVar = Pipeline.pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "gDstMip");
+
+    SetStates(pCtxGL);
+    pCtxGL->SetPipelineState(Pipeline.pPSO);
+
+    const Uint32 NumSlices = TexDesc.IsArray() ? ViewDesc.NumArraySlices : 1;
+    for (Uint32 Slice = 0; Slice < NumSlices; ++Slice)
+    {
+        for (Uint32 Mip = ViewDesc.MostDetailedMip + 1; Mip < ViewDesc.MostDetailedMip + ViewDesc.NumMipLevels; ++Mip)
+        {
+            // Create temporary UAVs for the source and destination mip levels of a single slice.
+            // Each slice is bound as a non-layered image and is treated as a 2D texture.
+            TextureViewDesc UAVDesc;
+            UAVDesc.ViewType        = TEXTURE_VIEW_UNORDERED_ACCESS;
+            UAVDesc.Format          = ViewDesc.Format;
+            UAVDesc.MostDetailedMip = Mip - 1;
+            UAVDesc.FirstArraySlice = TexDesc.IsArray() ? ViewDesc.FirstArraySlice + Slice : 0;
+            UAVDesc.NumArraySlices  = 1;
+            UAVDesc.AccessFlags     = UAV_ACCESS_FLAG_READ;
+            ValidatedAndCorrectTextureViewDesc(TexDesc, UAVDesc);
+            TextureViewGLImpl SrcUAV(pTexGL->GetReferenceCounters(), m_pDeviceGL, UAVDesc, pTexGL,
+                                     false, // Do NOT create texture view OpenGL object
+                                     true   // The view, like default view, should not
+                                            // keep strong reference to the texture
+            );
+
+            UAVDesc.MostDetailedMip = Mip;
+            UAVDesc.AccessFlags     = UAV_ACCESS_FLAG_WRITE;
+            TextureViewGLImpl DstUAV(pTexGL->GetReferenceCounters(), m_pDeviceGL, UAVDesc, pTexGL,
+                                     false, // Do NOT create texture view OpenGL object
+                                     true   // The view, like default view, should not
+                                            // keep strong reference to the texture
+            );
+
+            // Binding the destination image for writing issues the image access barrier
+            // that makes the previous level written by the prior dispatch visible.
+            pSrcMipVar->Set(&SrcUAV);
+            pDstMipVar->Set(&DstUAV);
+            pCtxGL->CommitShaderResources(Pipeline.pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+            const Uint32           MipWidth  = std::max(TexDesc.Width >> Mip, 1u);
+            const Uint32           MipHeight = std::max(TexDesc.Height >> Mip, 1u);
+            DispatchComputeAttribs DispatchAttrs{
+                (MipWidth + ThreadGroupSize - 1) / ThreadGroupSize,
+                (MipHeight + ThreadGroupSize - 1) / ThreadGroupSize //
+            };
+            pCtxGL->DispatchCompute(DispatchAttrs);
+
+            pSrcMipVar->Set(nullptr);
+            pDstMipVar->Set(nullptr);
+        }
+    }
+
+    RestoreStates(pCtxGL);
+}
+
+} // namespace Diligent
@@ -182,19 +182,18 @@ void Texture2D_GL::UpdateData(GLContextState&          ContextState,
                               Uint32                   MipLevel,
                               Uint32                   Slice,
                               const Box&               DstBox,
-                              const TextureSubResData& SubresData)
+                              const TextureSubResData& SubresData,
+                              GLuint                   UploadBuffer)
 {
     TextureBaseGL::UpdateData(ContextState, MipLevel, Slice, DstBox, SubresData);
 
-    ContextState.BindTexture(-1, m_BindTarget, m_GlTexture);
+    // With direct state access, the texture is updated by its name and does not need to be bound
+    const auto UseDSA = ContextState.GetContextCaps().IsDSASupported;
+    if (!UseDSA)
+        ContextState.BindTexture(-1, m_BindTarget, m_GlTexture);
 
     // Bind buffer if it is provided; copy from CPU memory otherwise
-    GLuint UnpackBuffer = 0;
-    if (SubresData.pSrcBuffer != nullptr)
-    {
-        auto* pBufferGL = ClassPtrCast<BufferGLImpl>(SubresData.pSrcBuffer);
-        UnpackBuffer    = pBufferGL->GetGLHandle();
-    }
+    const GLuint UnpackBuffer = GetUnpackBuffer(SubresData, UploadBuffer);
 
     // Transfers to OpenGL memory are called unpack operations
     // If there is a buffer bound to GL_PIXEL_UNPACK_BUFFER target, then all the pixel transfer
@@ -228,24 +227,40 @@ void Texture2D_GL::UpdateData(GLContextState&          ContextState,
         auto UpdateRegionHeight = DstBox.Height();
         UpdateRegionWidth       = std::min(UpdateRegionWidth, MipWidth - DstBox.MinX);
         UpdateRegionHeight      = std::min(UpdateRegionHeight, MipHeight - DstBox.MinY);
-        glCompressedTexSubImage2D(m_BindTarget, MipLevel,
-                                  DstBox.MinX,
-                                  DstBox.MinY,
-                                  UpdateRegionWidth,
-                                  UpdateRegionHeight,
-                                  // The format must be the same compressed-texture format previously
-                                  // specified by glTexStorage2D() (thank you OpenGL for another useless
-                                  // parameter that is nothing but the source of confusion), otherwise
-                                  // INVALID_OPERATION error is generated.
-                                  m_GLTexFormat,
-                                  // An INVALID_VALUE error is generated if imageSize is not consistent with
-                                  // the format, dimensions, and contents of the compressed image( too little or
-                                  // too much data ),
-                                  StaticCast<GLsizei>(((DstBox.Height() + 3) / 4) * SubresData.Stride),
-                                  // If a non-zero named buffer object is bound to the GL_PIXEL_UNPACK_BUFFER target, 'data' is treated
-                                  // as a byte offset into the buffer object's data store.
-                                  // https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glCompressedTexSubImage2D.xhtml
-                                  SubresData.pSrcBuffer != nullptr ? reinterpret_cast<void*>(StaticCast<size_t>(SubresData.SrcOffset)) : SubresData.pData);
+        const auto ImageSize    = StaticCast<GLsizei>(((DstBox.Height() + 3) / 4) * SubresData.Stride);
+        // If a non-zero named buffer object is bound to the GL_PIXEL_UNPACK_BUFFER target, 'data' is treated
+        // as a byte offset into the buffer object's data store.
+        // https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glCompressedTexSubImage2D.xhtml
+        const void* pData = UnpackBuffer != 0 ? reinterpret_cast<void*>(StaticCast<size_t>(SubresData.SrcOffset)) : SubresData.pData;
+        if (UseDSA)
+        {
+            glCompressedTextureSubImage2D(m_GlTexture, MipLevel,
+                                          DstBox.MinX,
+                                          DstBox.MinY,
+                                          UpdateRegionWidth,
+                                          UpdateRegionHeight,
+                                          m_GLTexFormat,
+                                          ImageSize,
+                                          pData);
+        }
+        else
+        {
+            glCompressedTexSubImage2D(m_BindTarget, MipLevel,
+                                      DstBox.MinX,
+                                      DstBox.MinY,
+                                      UpdateRegionWidth,
+                                      UpdateRegionHeight,
+                                      // The format must be the same compressed-texture format previously
+                                      // specified by glTexStorage2D() (thank you OpenGL for another useless
+                                      // parameter that is nothing but the source of confusion), otherwise
+                                      // INVALID_OPERATION error is generated.
+                                      m_GLTexFormat,
+                                      // An INVALID_VALUE error is generated if imageSize is not consistent with
+                                      // the format, dimensions, and contents of the compressed image( too little or
+                                      // too much data ),
+                                      ImageSize,
+                                      pData);
+        }
     }
     else
     {
@@ -256,23 +271,38 @@ void Texture2D_GL::UpdateData(GLContextState&          ContextState,
         glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
         glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
 
-        glTexSubImage2D(m_BindTarget, MipLevel,
-                        DstBox.MinX,
-                        DstBox.MinY,
-                        DstBox.Width(),
-                        DstBox.Height(),
-                        TransferAttribs.PixelFormat, TransferAttribs.DataType,
-                        // If a non-zero named buffer object is bound to the GL_PIXEL_UNPACK_BUFFER target, 'data' is treated
-                        // as a byte offset into the buffer object's data store.
-                        // https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glTexSubImage2D.xhtml
-                        SubresData.pSrcBuffer != nullptr ? reinterpret_cast<void*>(StaticCast<size_t>(SubresData.SrcOffset)) : SubresData.pData);
+        // If a non-zero named buffer object is bound to the GL_PIXEL_UNPACK_BUFFER target, 'data' is treated
+        // as a byte offset into the buffer object's data store.
+        // https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glTexSubImage2D.xhtml
+        const void* pData = UnpackBuffer != 0 ? reinterpret_cast<void*>(StaticCast<size_t>(SubresData.SrcOffset)) : SubresData.pData;
+        if (UseDSA)
+        {
+            glTextureSubImage2D(m_GlTexture, MipLevel,
+                                DstBox.MinX,
+                                DstBox.MinY,
+                                DstBox.Width(),
+                                DstBox.Height(),
+                                TransferAttribs.PixelFormat, TransferAttribs.DataType,
+                                pData);
+        }
+        else
+        {
+            glTexSubImage2D(m_BindTarget, MipLevel,
+                            DstBox.MinX,
+                            DstBox.MinY,
+                            DstBox.Width(),
+                            DstBox.Height(),
+                            TransferAttribs.PixelFormat, TransferAttribs.DataType,
+                            pData);
+        }
     }
     CHECK_GL_ERROR("Failed to update subimage data");
 
     if (UnpackBuffer != 0)
         glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
-    ContextState.BindTexture(-1, m_BindTarget, GLObjectWrappers::GLTextureObj::Null());
+    if (!UseDSA)
+        ContextState.BindTexture(-1, m_BindTarget, GLObjectWrappers::GLTextureObj::Null());
 }
 
 void Texture2D_GL::AttachToFramebuffer(const TextureViewDesc& ViewDesc, GLenum AttachmentPoint)
@@ -32,6 +32,7 @@
 #include "RenderDeviceGLImpl.hpp"
 #include "DeviceContextGLImpl.hpp"
 #include "TextureViewGLImpl.hpp"
+#include "BufferGLImpl.hpp"
 
 #include "GLTypeConversions.hpp"
 #include "EngineMemory.h"
@@ -521,7 +522,7 @@ void TextureBaseGL::CreateViewInternal(const TextureViewDesc& OrigViewDesc, ITex
 }
 
 
-void TextureBaseGL::UpdateData(GLContextState& CtxState, Uint32 MipLevel, Uint32 Slice, const Box& DstBox, const TextureSubResData& SubresData)
+void TextureBaseGL::UpdateData(GLContextState& CtxState, Uint32 MipLevel, Uint32 Slice, const Box& DstBox, const TextureSubResData& SubresData, GLuint UploadBuffer)
 {
     // GL_TEXTURE_UPDATE_BARRIER_BIT:
     //      Writes to a texture via glTex( Sub )Image*, glCopyTex( Sub )Image*, glClearTex*Image,
@@ -532,6 +533,18 @@ void TextureBaseGL::UpdateData(GLContextState& CtxState, Uint32 MipLevel, Uint32
     TextureMemoryBarrier(MEMORY_BARRIER_TEXTURE_UPDATE, CtxState);
 }
 
+GLuint TextureBaseGL::GetUnpackBuffer(const TextureSubResData& SubresData, GLuint UploadBuffer)
+{
+    if (SubresData.pSrcBuffer != nullptr)
+    {
+        VERIFY(UploadBuffer == 0, "Upload buffer must be 0 when the source buffer is provided");
+        return ClassPtrCast<BufferGLImpl>(SubresData.pSrcBuffer)->GetGLHandle();
+    }
+
+    VERIFY(UploadBuffer == 0 || SubresData.pData == nullptr, "CPU data must be null when the upload buffer is provided");
+    return UploadBuffer;
+}
+
 //void TextureBaseGL::UpdateData(Uint32 Offset, Uint32 Size, const void* pData)
 //{
 //    CTexture::UpdateData(Offset, Size, pData);
@@ -572,12 +585,20 @@ void TextureBaseGL::CopyData(DeviceContextGLImpl* pDeviceCtxGL,
         pSrcBox = &SrcBox;
     }
 
-#if GL_ARB_copy_image
+    // We can't use glCopyImageSubData or compute shaders with the proxy texture of a default
+    // framebuffer because we don't have the texture handle. Resort to quad rendering in this case.
     const bool IsDefaultBackBuffer = GetGLHandle() == 0;
-    // We can't use glCopyImageSubData with the proxy texture of a default framebuffer
-    // because we don't have the texture handle. Resort to quad rendering in this case.
-    if (glCopyImageSubData && !IsDefaultBackBuffer)
+    // glCopyImageSubData copies raw texel data and can't convert between formats of different sizes.
+    const bool IsRawCopy         = GetTextureFormatAttribs(SrcTexDesc.Format).GetElementSize() == GetTextureFormatAttribs(m_Desc.Format).GetElementSize();
+    auto*      pTexRegionCompute = GetDevice()->m_pTexRegionCompute.get();
+#if GL_ARB_copy_image
+    const bool UseCopyImage = glCopyImageSubData != nullptr && !IsDefaultBackBuffer && IsRawCopy;
+#else
+    const bool UseCopyImage = false;
+#endif
+    if (UseCopyImage)
     {
+#if GL_ARB_copy_image
         GLint SrcSliceY = (SrcTexDesc.Type == RESOURCE_DIM_TEX_1D_ARRAY) ? SrcSlice : 0;
         GLint SrcSliceZ = (SrcTexDesc.Type == RESOURCE_DIM_TEX_2D_ARRAY) ? SrcSlice : 0;
         GLint DstSliceY = (m_Desc.Type == RESOURCE_DIM_TEX_1D_ARRAY) ? DstSlice : 0;
@@ -599,9 +620,54 @@ void TextureBaseGL::CopyData(DeviceContextGLImpl* pDeviceCtxGL,
             pSrcBox->Height(),
             pSrcBox->Depth());
         CHECK_GL_ERROR("glCopyImageSubData() failed");
+#endif
+    }
+    else if (pTexRegionCompute != nullptr && !IsDefaultBackBuffer && pTexRegionCompute->CanCopy(SrcTexDesc, m_Desc))
+    {
+        // Create temporary SRV for the entire source texture
+        TextureViewDesc SRVDesc;
+        SRVDesc.TextureDim = SrcTexDesc.Type;
+        SRVDesc.ViewType   = TEXTURE_VIEW_SHADER_RESOURCE;
+        ValidatedAndCorrectTextureViewDesc(SrcTexDesc, SRVDesc);
+        TextureViewGLImpl SRV(GetReferenceCounters(), GetDevice(), SRVDesc, pSrcTextureGL,
+                              false, // Do NOT create texture view OpenGL object
+                              true   // The view, like default view, should not
+                                     // keep strong reference to the texture
+        );
+
+        pTexRegionCompute->SetStates(pDeviceCtxGL);
+        for (Uint32 DepthSlice = 0; DepthSlice < pSrcBox->Depth(); ++DepthSlice)
+        {
+            // Create temporary UAV for the target subresource. The slice is bound
+            // as a non-layered image and is treated as a 2D texture.
+            TextureViewDesc UAVDesc;
+            UAVDesc.ViewType        = TEXTURE_VIEW_UNORDERED_ACCESS;
+            UAVDesc.FirstArraySlice = DstSlice + DstZ + DepthSlice;
+            UAVDesc.MostDetailedMip = DstMipLevel;
+            UAVDesc.NumArraySlices  = 1;
+            UAVDesc.AccessFlags     = UAV_ACCESS_FLAG_WRITE;
+            ValidatedAndCorrectTextureViewDesc(m_Desc, UAVDesc);
+            TextureViewGLImpl UAV(GetReferenceCounters(), GetDevice(), UAVDesc, this,
+                                  false, // Do NOT create texture view OpenGL object
+                                  true   // The view, like default view, should not
+                                         // keep strong reference to the texture
+            );
+
+            pTexRegionCompute->Copy(pDeviceCtxGL,
+                                    &SRV,
+                                    &UAV,
+                                    static_cast<Int32>(pSrcBox->MinX) - static_cast<Int32>(DstX),
+                                    static_cast<Int32>(pSrcBox->MinY) - static_cast<Int32>(DstY),
+                                    SrcSlice + pSrcBox->MinZ + DepthSlice,
+                                    SrcMipLevel,
+                                    DstX,
+                                    DstY,
+                                    pSrcBox->Width(),
+                                    pSrcBox->Height());
+        }
+        pTexRegionCompute->RestoreStates(pDeviceCtxGL);
     }
     else
-#endif
     {
         const auto& FmtAttribs = GetDevice()->GetTextureFormatInfoExt(m_Desc.Format);
         if ((FmtAttribs.BindFlags & BIND_RENDER_TARGET) == 0)
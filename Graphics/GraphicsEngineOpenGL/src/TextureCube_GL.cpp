@@ -161,7 +161,8 @@ void TextureCube_GL::UpdateData(GLContextState&          ContextState,
                                 Uint32                   MipLevel,
                                 Uint32                   Slice,
                                 const Box&               DstBox,
-                                const TextureSubResData& SubresData)
+                                const TextureSubResData& SubresData,
+                                GLuint                   UploadBuffer)
 {
     TextureBaseGL::UpdateData(ContextState, MipLevel, Slice, DstBox, SubresData);
 
@@ -172,12 +173,7 @@ void TextureCube_GL::UpdateData(GLContextState&          ContextState,
     auto CubeMapFaceBindTarget = CubeMapFaces[Slice];
 
     // Bind buffer if it is provided; copy from CPU memory otherwise
-    GLuint UnpackBuffer = 0;
-    if (SubresData.pSrcBuffer != nullptr)
-    {
-        auto* pBufferGL = ClassPtrCast<BufferGLImpl>(SubresData.pSrcBuffer);
-        UnpackBuffer    = pBufferGL->GetGLHandle();
-    }
+    const GLuint UnpackBuffer = GetUnpackBuffer(SubresData, UploadBuffer);
 
     // Transfers to OpenGL memory are called unpack operations
     // If there is a buffer bound to GL_PIXEL_UNPACK_BUFFER target, then all the pixel transfer
@@ -233,7 +229,7 @@ void TextureCube_GL::UpdateData(GLContextState&          ContextState,
                                   // If a non-zero named buffer object is bound to the GL_PIXEL_UNPACK_BUFFER target, 'data' is treated
                                   // as a byte offset into the buffer object's data store.
                                   // https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glCompressedTexSubImage2D.xhtml
-                                  SubresData.pSrcBuffer != nullptr ? reinterpret_cast<void*>(StaticCast<size_t>(SubresData.SrcOffset)) : SubresData.pData);
+                                  UnpackBuffer != 0 ? reinterpret_cast<void*>(StaticCast<size_t>(SubresData.SrcOffset)) : SubresData.pData);
     }
     else
     {
@@ -255,7 +251,7 @@ void TextureCube_GL::UpdateData(GLContextState&          ContextState,
                         // If a non-zero named buffer object is bound to the GL_PIXEL_UNPACK_BUFFER target, 'data' is treated
                         // as a byte offset into the buffer object's data store.
                         // https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glTexSubImage2D.xhtml
-                        SubresData.pSrcBuffer != nullptr ? reinterpret_cast<void*>(StaticCast<size_t>(SubresData.SrcOffset)) : SubresData.pData);
+                        UnpackBuffer != 0 ? reinterpret_cast<void*>(StaticCast<size_t>(SubresData.SrcOffset)) : SubresData.pData);
     }
     CHECK_GL_ERROR("Failed to update subimage data");
 
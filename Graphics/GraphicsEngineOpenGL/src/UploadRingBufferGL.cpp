@@ -0,0 +1,181 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "UploadRingBufferGL.hpp"
+
+#include <limits>
+
+#include "GLContextState.hpp"
+#include "EngineMemory.h"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Allocations are aligned to keep CPU writes into the ring buffer memory efficient.
+constexpr RingBuffer::OffsetType UploadRingAlignment = 16;
+
+} // namespace
+
+UploadRingBufferGL::UploadRingBufferGL(Uint64 Size, bool IsSupported) noexcept :
+    m_Size{Size},
+    m_IsSupported{IsSupported && Size > 0},
+    m_RingBuffer{StaticCast<RingBuffer::OffsetType>(Size), GetRawAllocator()}
+{
+}
+
+UploadRingBufferGL::~UploadRingBufferGL()
+{
+    if (m_pMappedData != nullptr)
+    {
+        // Wait until the GPU is done with all allocations before releasing the buffer.
+        // The buffer is implicitly unmapped when it is deleted.
+        FinishFrame();
+        WaitForFrame(m_NextFenceValue - 1);
+    }
+}
+
+bool UploadRingBufferGL::Initialize(GLContextState& CtxState)
+{
+    VERIFY_EXPR(m_IsSupported && !m_Buffer);
+
+    GLObjectWrappers::GLBufferObj Buffer{true};
+
+    constexpr GLbitfield StorageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    constexpr bool ResetVAO = false; // No need to reset VAO for READ/WRITE targets
+    CtxState.BindBuffer(GL_COPY_WRITE_BUFFER, Buffer, ResetVAO);
+    glBufferStorage(GL_COPY_WRITE_BUFFER, StaticCast<GLsizeiptr>(m_Size), nullptr, StorageFlags);
+    if (glGetError() == GL_NO_ERROR)
+    {
+        m_pMappedData = static_cast<Uint8*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, StaticCast<GLsizeiptr>(m_Size), StorageFlags));
+        CHECK_GL_ERROR("glMapBufferRange() failed");
+    }
+    CtxState.BindBuffer(GL_COPY_WRITE_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+
+    if (m_pMappedData == nullptr)
+    {
+        LOG_WARNING_MESSAGE("Failed to create persistently mapped upload ring buffer. Buffer updates will use glMapBufferRange() and glBufferSubData().");
+        m_IsSupported = false;
+        return false;
+    }
+
+    m_Buffer = std::move(Buffer);
+    m_Buffer.SetName("Upload ring buffer");
+
+    return true;
+}
+
+UploadRingBufferGL::Allocation UploadRingBufferGL::Allocate(GLContextState& CtxState, Uint64 Size)
+{
+    // Large updates go through the driver to avoid frequently stalling on the ring buffer.
+    if (!m_IsSupported || Size == 0 || Size > m_Size / 4)
+        return {};
+
+    if (!m_Buffer && !Initialize(CtxState))
+        return {};
+
+    ReleaseCompletedFrames();
+
+    const auto AllocSize = StaticCast<RingBuffer::OffsetType>(Size);
+
+    auto Offset = m_RingBuffer.Allocate(AllocSize, UploadRingAlignment);
+    while (Offset == RingBuffer::InvalidOffset)
+    {
+        // Close the current frame so that its space can be reclaimed, and
+        // wait until the GPU is done with the oldest frame.
+        FinishFrame();
+        WaitForFrame(m_PendingFences.front().first);
+        Offset = m_RingBuffer.Allocate(AllocSize, UploadRingAlignment);
+    }
+
+    Allocation Alloc;
+    Alloc.pBuffer     = &m_Buffer;
+    Alloc.Offset      = Offset;
+    Alloc.pCPUAddress = m_pMappedData + Offset;
+
+    m_AllocatedSize += Size;
+    return Alloc;
+}
+
+void UploadRingBufferGL::FinishFrame()
+{
+    if (!m_Buffer)
+        return;
+
+    GLObjectWrappers::GLSyncObj GLFence{glFenceSync(
+        GL_SYNC_GPU_COMMANDS_COMPLETE, // Condition must always be GL_SYNC_GPU_COMMANDS_COMPLETE
+        0                              // Flags, must be 0
+        )};
+    DEV_CHECK_GL_ERROR("Failed to create gl fence");
+
+    const auto FenceValue = m_NextFenceValue++;
+    m_PendingFences.emplace_back(FenceValue, std::move(GLFence));
+    m_RingBuffer.FinishCurrentFrame(FenceValue);
+}
+
+void UploadRingBufferGL::ReleaseCompletedFrames()
+{
+    while (!m_PendingFences.empty())
+    {
+        auto& ValFence = m_PendingFences.front();
+
+        const auto Res = glClientWaitSync(ValFence.second, 0, 0);
+        if (Res != GL_ALREADY_SIGNALED && Res != GL_CONDITION_SATISFIED)
+            break;
+
+        m_CompletedFenceValue = ValFence.first;
+        m_PendingFences.pop_front();
+    }
+
+    m_RingBuffer.ReleaseCompletedFrames(m_CompletedFenceValue);
+}
+
+void UploadRingBufferGL::WaitForFrame(Uint64 Frame)
+{
+    VERIFY(Frame < m_NextFenceValue, "Frame ", Frame, " has not been finished");
+
+    while (!m_PendingFences.empty() && m_PendingFences.front().first <= Frame)
+    {
+        auto& ValFence = m_PendingFences.front();
+
+        auto Res = glClientWaitSync(ValFence.second, GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max());
+        VERIFY_EXPR(Res == GL_ALREADY_SIGNALED || Res == GL_CONDITION_SATISFIED);
+        (void)Res;
+
+        m_CompletedFenceValue = ValFence.first;
+        m_PendingFences.pop_front();
+    }
+
+    m_RingBuffer.ReleaseCompletedFrames(m_CompletedFenceValue);
+}
+
+} // namespace Diligent
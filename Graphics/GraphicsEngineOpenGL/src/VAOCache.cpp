@@ -29,8 +29,6 @@
 
 #include "VAOCache.hpp"
 
-#include <unordered_set>
-
 #include "RenderDeviceGLImpl.hpp"
 #include "BufferGLImpl.hpp"
 #include "PipelineStateGLImpl.hpp"
@@ -44,100 +42,82 @@
 namespace Diligent
 {
 
-VAOCache::VAOCache() :
+VAOCache::VAOCache(Uint32 MaxSize) :
+    m_MaxSize{MaxSize},
     m_EmptyVAO{true}
 {
     m_Cache.max_load_factor(0.5f);
-    m_PSOToKey.max_load_factor(0.5f);
-    m_BuffToKey.max_load_factor(0.5f);
+    m_PSOToKeys.max_load_factor(0.5f);
+    m_BuffToKeys.max_load_factor(0.5f);
 }
 
 VAOCache::~VAOCache()
 {
     VERIFY(m_Cache.empty(), "VAO cache is not empty. Are there any unreleased objects?");
-    VERIFY(m_PSOToKey.empty(), "PSOToKey hash is not empty");
-    VERIFY(m_BuffToKey.empty(), "BuffToKey hash is not empty");
+    VERIFY(m_LRUList.empty(), "LRU list is not empty");
+    VERIFY(m_PSOToKeys.empty(), "PSOToKeys hash is not empty");
+    VERIFY(m_BuffToKeys.empty(), "BuffToKeys hash is not empty");
 }
 
-void VAOCache::OnDestroyBuffer(const BufferGLImpl& Buffer)
+void VAOCache::RemoveVAO(CacheType::iterator It)
 {
-    // Collect all stale keys that use this buffer.
-    std::vector<VAOHashKey> StaleKeys;
+    const auto* pKey = &It->first;
 
-    Threading::SpinLockGuard CacheGuard{m_CacheLock};
+    auto RemoveKeyRef = [pKey](UniqueIdentifier Id, IdToKeysMapType& IdToKeys) //
+    {
+        auto KeysIt = IdToKeys.find(Id);
+        // The same buffer may be used in several slots, so the key may have already been removed
+        if (KeysIt != IdToKeys.end())
+        {
+            KeysIt->second.erase(pKey);
+            if (KeysIt->second.empty())
+                IdToKeys.erase(KeysIt);
+        }
+    };
+
+    RemoveKeyRef(pKey->PsoUId, m_PSOToKeys);
+    if (pKey->IndexBufferUId != 0)
+        RemoveKeyRef(pKey->IndexBufferUId, m_BuffToKeys);
 
-    const auto range = m_BuffToKey.equal_range(Buffer.GetUniqueID());
-    for (auto it = range.first; it != range.second; ++it)
+    for (auto SlotMask = pKey->UsedSlotsMask; SlotMask != 0;)
     {
-        StaleKeys.push_back(it->second);
-        m_Cache.erase(it->second);
+        const auto SlotBit = ExtractLSB(SlotMask);
+        const auto Slot    = PlatformMisc::GetLSB(SlotBit);
+        VERIFY_EXPR(pKey->Streams[Slot].BufferUId >= 0);
+        RemoveKeyRef(pKey->Streams[Slot].BufferUId, m_BuffToKeys);
     }
-    m_BuffToKey.erase(range.first, range.second);
 
-    // Clear stale entries in m_PSOToKey and m_BuffToKey that refer to dead VAOs
-    // to avoid memory leaks.
-    ClearStaleKeys(StaleKeys);
+    m_LRUList.erase(It->second.LRUIt);
+    m_Cache.erase(It);
 }
 
-void VAOCache::OnDestroyPSO(const PipelineStateGLImpl& PSO)
+void VAOCache::RemoveVAOs(UniqueIdentifier ObjectId, IdToKeysMapType& IdToKeys)
 {
-    // Collect all stale keys that use this PSO.
-    std::vector<VAOHashKey> StaleKeys;
-
-    Threading::SpinLockGuard CacheGuard{m_CacheLock};
+    auto KeysIt = IdToKeys.find(ObjectId);
+    if (KeysIt == IdToKeys.end())
+        return;
 
-    const auto range = m_PSOToKey.equal_range(PSO.GetUniqueID());
-    for (auto it = range.first; it != range.second; ++it)
+    // RemoveVAO() modifies the set, so we need to copy the keys first
+    const std::vector<const VAOHashKey*> Keys{KeysIt->second.begin(), KeysIt->second.end()};
+    for (const auto* pKey : Keys)
     {
-        StaleKeys.push_back(it->second);
-        m_Cache.erase(it->second);
+        auto It = m_Cache.find(*pKey);
+        VERIFY_EXPR(It != m_Cache.end() && &It->first == pKey);
+        RemoveVAO(It);
     }
-    m_PSOToKey.erase(range.first, range.second);
-
-    // Clear stale entries in m_PSOToKey and m_BuffToKey that refer to dead VAOs
-    // to avoid memory leaks.
-    ClearStaleKeys(StaleKeys);
+    VERIFY_EXPR(IdToKeys.find(ObjectId) == IdToKeys.end());
 }
 
-void VAOCache::ClearStaleKeys(const std::vector<VAOHashKey>& StaleKeys)
+void VAOCache::OnDestroyBuffer(const BufferGLImpl& Buffer)
 {
-    // Collect unique PSOs and buffers used in stale keys.
-    std::unordered_set<UniqueIdentifier> CandidatePSOs;
-    std::unordered_set<UniqueIdentifier> CandidateBuffers;
-    for (const auto& StaleKey : StaleKeys)
-    {
-        CandidatePSOs.emplace(StaleKey.PsoUId);
-
-        if (StaleKey.IndexBufferUId != 0)
-            CandidateBuffers.emplace(StaleKey.IndexBufferUId);
-
-        for (auto SlotMask = StaleKey.UsedSlotsMask; SlotMask != 0;)
-        {
-            const auto SlotBit = ExtractLSB(SlotMask);
-            const auto Slot    = PlatformMisc::GetLSB(SlotBit);
-            VERIFY_EXPR(StaleKey.Streams[Slot].BufferUId >= 0);
-            CandidateBuffers.emplace(StaleKey.Streams[Slot].BufferUId);
-        }
-    }
+    Threading::SpinLockGuard CacheGuard{m_CacheLock};
+    RemoveVAOs(Buffer.GetUniqueID(), m_BuffToKeys);
+}
 
-    auto RemoveStaleEntries = [this](const std::unordered_set<UniqueIdentifier>&            CandidateIds,
-                                     std::unordered_multimap<UniqueIdentifier, VAOHashKey>& IdToKey) //
-    {
-        // Delete stale entries that reference dead keys
-        for (const auto Id : CandidateIds)
-        {
-            const auto range = IdToKey.equal_range(Id);
-            for (auto it = range.first; it != range.second;)
-            {
-                if (m_Cache.find(it->second) == m_Cache.end())
-                    it = IdToKey.erase(it); // There is no more VAO with this key
-                else
-                    ++it;
-            }
-        }
-    };
-    RemoveStaleEntries(CandidatePSOs, m_PSOToKey);
-    RemoveStaleEntries(CandidateBuffers, m_BuffToKey);
+void VAOCache::OnDestroyPSO(const PipelineStateGLImpl& PSO)
+{
+    Threading::SpinLockGuard CacheGuard{m_CacheLock};
+    RemoveVAOs(PSO.GetUniqueID(), m_PSOToKeys);
 }
 
 VAOCache::VAOHashKey::VAOHashKey(const VAOAttribs& Attribs) :
@@ -250,10 +230,21 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(const VAOAttribs& Att
     auto It = m_Cache.find(Key);
     if (It != m_Cache.end())
     {
-        return It->second;
+        // Move the VAO to the front of the LRU list
+        m_LRUList.splice(m_LRUList.begin(), m_LRUList, It->second.LRUIt);
+        return It->second.VAO;
     }
     else
     {
+        // Release the least recently used VAOs. Never release the most recently used one
+        // as the caller may still be holding a reference to it.
+        while (m_MaxSize != 0 && m_Cache.size() >= m_MaxSize && m_LRUList.size() > 1)
+        {
+            auto LRUIt = m_Cache.find(*m_LRUList.back());
+            VERIFY_EXPR(LRUIt != m_Cache.end());
+            RemoveVAO(LRUIt);
+        }
+
         // Create a new VAO
         GLObjectWrappers::GLVertexArrayObj NewVAO{true};
 
@@ -305,16 +296,20 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(const VAOAttribs& Att
             GLState.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, Attribs.pIndexBuffer->m_GlBuffer, ResetVAO);
         }
 
-        auto NewElems = m_Cache.emplace(std::make_pair(Key, std::move(NewVAO)));
+        auto NewElems = m_Cache.emplace(std::make_pair(Key, CacheEntry{std::move(NewVAO), {}}));
         // New element must be actually inserted
         VERIFY(NewElems.second, "New element was not inserted into the cache");
+
+        const auto* pKey             = &NewElems.first->first;
+        NewElems.first->second.LRUIt = m_LRUList.emplace(m_LRUList.begin(), pKey);
+
         VERIFY_EXPR(Key.PsoUId == Attribs.PSO.GetUniqueID());
-        m_PSOToKey.emplace(Key.PsoUId, Key);
+        m_PSOToKeys[Key.PsoUId].emplace(pKey);
 
         if (Attribs.pIndexBuffer)
         {
             VERIFY_EXPR(Key.IndexBufferUId == Attribs.pIndexBuffer->GetUniqueID());
-            m_BuffToKey.emplace(Key.IndexBufferUId, Key);
+            m_BuffToKeys[Key.IndexBufferUId].emplace(pKey);
         }
 
         for (auto SlotMask = Key.UsedSlotsMask; SlotMask != 0;)
@@ -330,9 +325,9 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(const VAOAttribs& Att
             }
 #endif
 
-            m_BuffToKey.emplace(Key.Streams[Slot].BufferUId, Key);
+            m_BuffToKeys[Key.Streams[Slot].BufferUId].emplace(pKey);
         }
-        return NewElems.first->second;
+        return NewElems.first->second.VAO;
     }
 }
 
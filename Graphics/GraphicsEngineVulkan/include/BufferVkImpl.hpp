@@ -156,6 +156,11 @@ private:
 
     VulkanUtilities::BufferWrapper          m_VulkanBuffer;
     VulkanUtilities::VulkanMemoryAllocation m_MemoryAllocation;
+
+    // Device memory the buffer is placed in, see BufferData::pMemory.
+    RefCntAutoPtr<IDeviceMemory> m_pMemory;
 };
 
+VkBufferCreateInfo BufferDescToVkBufferCreateInfo(const BufferDesc& Desc) noexcept;
+
 } // namespace Diligent
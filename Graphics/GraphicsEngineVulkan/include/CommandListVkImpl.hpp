@@ -32,6 +32,7 @@
 
 #include "EngineVkImplTraits.hpp"
 #include "VulkanUtilities/VulkanHeaders.h"
+#include "VulkanUtilities/VulkanCommandBufferPool.hpp"
 #include "CommandListBase.hpp"
 
 namespace Diligent
@@ -43,33 +44,55 @@ class CommandListVkImpl final : public CommandListBase<EngineVkImplTraits>
 public:
     using TCommandListBase = CommandListBase<EngineVkImplTraits>;
 
-    CommandListVkImpl(IReferenceCounters*  pRefCounters,
-                      RenderDeviceVkImpl*  pDevice,
-                      DeviceContextVkImpl* pDeferredCtx,
-                      VkCommandBuffer      vkCmdBuff) :
-        // clang-format off
-        TCommandListBase {pRefCounters, pDevice, pDeferredCtx},
-        m_pDeferredCtx   {pDeferredCtx},
-        m_vkCmdBuff      {vkCmdBuff   }
-    // clang-format on
-    {
-    }
+    CommandListVkImpl(IReferenceCounters*                       pRefCounters,
+                      RenderDeviceVkImpl*                       pDevice,
+                      DeviceContextVkImpl*                      pDeferredCtx,
+                      VkCommandBuffer                           vkCmdBuff,
+                      bool                                      IsSecondary,
+                      VulkanUtilities::VulkanCommandBufferPool* pCmdPool);
 
-    ~CommandListVkImpl()
-    {
-        VERIFY(m_vkCmdBuff == VK_NULL_HANDLE && !m_pDeferredCtx, "Destroying command list that was never executed");
-    }
+    ~CommandListVkImpl();
 
     void Close(RefCntAutoPtr<IDeviceContext>& outDeferredCtx, VkCommandBuffer& outVkCmdBuff)
     {
+        VERIFY(!IsReusable(), "Reusable command lists must not be closed");
         outVkCmdBuff   = m_vkCmdBuff;
         outDeferredCtx = std::move(m_pDeferredCtx);
         m_vkCmdBuff    = VK_NULL_HANDLE;
     }
 
+    /// Returns true if the command list was recorded with IDeviceContextVk::BeginSecondary()
+    bool IsSecondary() const { return m_IsSecondary; }
+
+    /// Returns the command buffer of a reusable command list.
+    VkCommandBuffer GetVkCmdBuffer() const
+    {
+        VERIFY(IsReusable(), "Command buffers of non-reusable command lists must be retrieved with Close()");
+        return m_vkCmdBuff;
+    }
+
+    DeviceContextVkImpl* GetDeferredContext() const;
+
+    /// Records the fence value of the latest submission of a reusable command list.
+    void SetLastSubmittedFenceValue(SoftwareQueueIndex CmdQueueId, Uint64 FenceValue)
+    {
+        VERIFY(IsReusable(), "Only reusable command lists may be submitted multiple times");
+        DEV_CHECK_ERR(CmdQueueId == m_CmdQueueId, "Reusable command list recorded for command queue ", Uint32{m_CmdQueueId},
+                      " is executed in command queue ", Uint32{CmdQueueId});
+        m_LastSubmittedFenceValue = FenceValue;
+    }
+
 private:
     RefCntAutoPtr<IDeviceContext> m_pDeferredCtx;
     VkCommandBuffer               m_vkCmdBuff;
+    const bool                    m_IsSecondary;
+
+    // Reusable command lists only
+    VulkanUtilities::VulkanCommandBufferPool* const m_pCmdPool;
+
+    const SoftwareQueueIndex m_CmdQueueId;
+
+    Uint64 m_LastSubmittedFenceValue = 0;
 };
 
 } // namespace Diligent
@@ -27,16 +27,16 @@
 
 #pragma once
 
-#include <deque>
-#include <mutex>
 #include <atomic>
-#include "STDAllocator.hpp"
+#include "LockFreeQueue.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 
 namespace Diligent
 {
 
+// Manages transient command pools that can be allocated and recycled by any thread.
+// Available pools are kept in a lock-free queue.
 class CommandPoolManager
 {
 public:
@@ -81,8 +81,11 @@ private:
     const HardwareQueueIndex       m_QueueFamilyIndex;
     const VkCommandPoolCreateFlags m_CmdPoolFlags;
 
-    std::mutex                                                                                               m_Mutex;
-    std::deque<VulkanUtilities::CommandPoolWrapper, STDAllocatorRawMem<VulkanUtilities::CommandPoolWrapper>> m_CmdPools;
+    // The maximum number of available pools. Pools recycled when the queue
+    // is full are destroyed.
+    static constexpr size_t MaxAvailablePools = 256;
+
+    Threading::LockFreeQueue<VulkanUtilities::CommandPoolWrapper> m_CmdPools{MaxAvailablePools};
 
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic<Int32> m_AllocatedPoolCounter{0};
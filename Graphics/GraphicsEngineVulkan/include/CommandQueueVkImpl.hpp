@@ -54,7 +54,8 @@ private:
                 Uint32                                    NumContexts,
                 VulkanUtilities::VulkanSyncObjectManager& SyncObjectMngr,
                 VkDevice                                  LogicalDevice,
-                Uint64                                    dbgValue);
+                Uint64                                    Value,
+                VkSemaphore                               vkQueueTimelineSemaphore);
 
     void GetSemaphores(std::vector<VkSemaphore>& Semaphores);
 
@@ -73,12 +74,12 @@ public:
         return std::move(m_Semaphores[CommandQueueId]);
     }
 
-    // vkGetFenceStatus and vkWaitForFences with same fence can be used in multiple threads.
-    // Other functions requires external synchronization.
-    VkFence GetFence() const
-    {
-        return m_Fence;
-    }
+    // Returns VK_SUCCESS if the sync point has been reached, and VK_NOT_READY otherwise.
+    // vkGetFenceStatus and vkGetSemaphoreCounterValue are thread safe.
+    VkResult GetStatus(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice) const;
+
+    // vkWaitForFences and vkWaitSemaphores with the same object can be used in multiple threads.
+    VkResult Wait(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, Uint64 Timeout) const;
 
     SoftwareQueueIndex GetCommandQueueId() const
     {
@@ -86,8 +87,12 @@ public:
     }
 
 private:
+    // When timeline semaphores are supported, the sync point is reached when the
+    // queue timeline semaphore reaches m_Value, and no fence is allocated.
     const SoftwareQueueIndex                 m_CommandQueueId;
     const Uint8                              m_NumSemaphores; // same as NumContexts
+    const Uint64                             m_Value;
+    const VkSemaphore                        m_vkQueueTimelineSemaphore;
     VulkanUtilities::VulkanRecycledFence     m_Fence;
     VulkanUtilities::VulkanRecycledSemaphore m_Semaphores[1]; // [m_NumSemaphores]
 };
@@ -160,6 +165,17 @@ private:
 
     void InternalSignalSemaphore(VkSemaphore vkTimelineSemaphore, Uint64 Value);
 
+    // Merges the sync point semaphores, the semaphores from the submit info and the
+    // queue timeline semaphore into m_TempSignalSemaphores and updates the submit info.
+    // Returns false if the queue timeline semaphore could not be merged and must be signaled separately.
+    template <typename SubmitInfoType>
+    bool PrepareSignalSemaphores(SubmitInfoType&                InOutInfo,
+                                 VkTimelineSemaphoreSubmitInfo& TimelineSubmitInfo,
+                                 SyncPointVk&                   SyncPoint,
+                                 Uint64                         FenceValue);
+
+    void UpdateLastCompletedFenceValue(Uint64 Value);
+
     std::shared_ptr<VulkanUtilities::VulkanLogicalDevice> m_LogicalDevice;
 
     const VkQueue            m_VkQueue;
@@ -177,11 +193,20 @@ private:
     // A value that will be signaled by the command queue next
     std::atomic<Uint64> m_NextFenceValue{1};
 
+    // Timeline semaphore that is signaled with the fence value by every submission.
+    // Only used when timeline semaphores are supported, m_pFence is used otherwise.
+    VulkanUtilities::SemaphoreWrapper m_vkTimelineSemaphore;
+
+    // Cached value of m_vkTimelineSemaphore counter that can be read without querying the semaphore.
+    std::atomic<Uint64> m_LastCompletedFenceValue{0};
+
     // Protects access to the m_VkQueue internal data.
     std::mutex m_QueueMutex;
 
     // Array used to merge semaphores from SubmitInfo and from SyncPointVk
     std::vector<VkSemaphore> m_TempSignalSemaphores;
+    // Signal values for m_TempSignalSemaphores when the queue timeline semaphore is used
+    std::vector<Uint64> m_TempSignalValues;
 
     // Protects access to the m_LastSyncPoint
     Threading::SpinLock m_LastSyncPointLock;
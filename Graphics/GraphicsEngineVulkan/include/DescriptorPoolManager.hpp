@@ -36,6 +36,7 @@
 #include <atomic>
 
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "AdaptiveLock.hpp"
 
 namespace Diligent
 {
@@ -138,7 +139,8 @@ public:
                           std::string                       PoolName,
                           std::vector<VkDescriptorPoolSize> PoolSizes,
                           uint32_t                          MaxSets,
-                          bool                              AllowFreeing) noexcept;
+                          bool                              AllowFreeing,
+                          bool                              UpdateAfterBind = false) noexcept;
     ~DescriptorPoolManager();
 
     DescriptorPoolManager             (const DescriptorPoolManager&) = delete;
@@ -169,8 +171,11 @@ protected:
     const std::vector<VkDescriptorPoolSize> m_PoolSizes;
     const uint32_t                          m_MaxSets;
     const bool                              m_AllowFreeing;
+    // Pools are created with VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT flag
+    // and can only be used to allocate sets with update-after-bind layouts.
+    const bool m_UpdateAfterBind;
 
-    std::mutex                                         m_Mutex;
+    Threading::EngineMutex                             m_Mutex;
     std::deque<VulkanUtilities::DescriptorPoolWrapper> m_Pools;
 
 private:
@@ -192,7 +197,8 @@ public:
                            std::string                       PoolName,
                            std::vector<VkDescriptorPoolSize> PoolSizes,
                            uint32_t                          MaxSets,
-                           bool                              AllowFreeing) noexcept :
+                           bool                              AllowFreeing,
+                           bool                              UpdateAfterBind = false) noexcept :
         // clang-format off
         DescriptorPoolManager
         {
@@ -200,7 +206,8 @@ public:
             std::move(PoolName),
             std::move(PoolSizes),
             MaxSets,
-            AllowFreeing
+            AllowFreeing,
+            UpdateAfterBind
         }
     // clang-format on
     {
@@ -270,11 +277,15 @@ public:
 
     size_t GetAllocatedPoolCount() const { return m_AllocatedPools.size(); }
 
+    // Returns the number of descriptor sets allocated since the last call to ReleasePools().
+    Uint32 GetAllocatedSetCount() const { return m_AllocatedSetCount; }
+
 private:
     DescriptorPoolManager&                              m_GlobalPoolMgr;
     const std::string                                   m_Name;
     std::vector<VulkanUtilities::DescriptorPoolWrapper> m_AllocatedPools;
-    size_t                                              m_PeakPoolCount = 0;
+    size_t                                              m_PeakPoolCount     = 0;
+    Uint32                                              m_AllocatedSetCount = 0;
 };
 
 } // namespace Diligent
@@ -43,6 +43,7 @@
 #include "QueryVkImpl.hpp"
 #include "FramebufferVkImpl.hpp"
 #include "RenderPassVkImpl.hpp"
+#include "RenderPassCache.hpp"
 #include "BottomLevelASVkImpl.hpp"
 #include "TopLevelASVkImpl.hpp"
 #include "ShaderBindingTableVkImpl.hpp"
@@ -81,6 +82,9 @@ public:
     /// Implementation of IDeviceContext::Begin() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE Begin(Uint32 ImmediateContextId) override final;
 
+    /// Implementation of IDeviceContext::BeginReusable() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE BeginReusable(Uint32 ImmediateContextId) override final;
+
     /// Implementation of IDeviceContext::SetPipelineState() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE SetPipelineState(IPipelineState* pPipelineState) override final;
 
@@ -151,6 +155,10 @@ public:
     virtual void DILIGENT_CALL_TYPE DrawMesh           (const DrawMeshAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawMeshIndirect() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE DrawMeshIndirect   (const DrawMeshIndirectAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDraw() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE MultiDraw          (const MultiDrawAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndexed() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexed   (const MultiDrawIndexedAttribs& Attribs) override final;
 
     /// Implementation of IDeviceContext::DispatchCompute() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE DispatchCompute        (const DispatchComputeAttribs& Attribs) override final;
@@ -244,12 +252,39 @@ public:
     /// Implementation of IDeviceContext::EndQuery() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE EndQuery(IQuery* pQuery) override final;
 
+    /// Implementation of IDeviceContext::BeginIndexedQuery() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE BeginIndexedQuery(IQueryArray* pQueryArray, Uint32 Index) override final;
+
+    /// Implementation of IDeviceContext::EndIndexedQuery() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE EndIndexedQuery(IQueryArray* pQueryArray, Uint32 Index) override final;
+
+    /// Implementation of IDeviceContext::ResolveQueryArray() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE ResolveQueryArray(const ResolveQueryArrayAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::SetPredication() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE SetPredication(IBuffer* pBuffer, Uint64 Offset, PREDICATION_OP Op) override final;
+
+    /// Implementation of IDeviceContext::SetQueryPredication() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE SetQueryPredication(IQuery* pQuery, PREDICATION_OP Op) override final;
+
+    /// Implementation of IDeviceContext::SetCullMode() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE SetCullMode(CULL_MODE CullMode) override final;
+
+    /// Implementation of IDeviceContext::SetDepthStencilState() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE SetDepthStencilState(const DepthStencilStateDesc& DSSDesc) override final;
+
+    /// Implementation of IDeviceContext::SetPrimitiveTopology() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE SetPrimitiveTopology(PRIMITIVE_TOPOLOGY Topology) override final;
+
     /// Implementation of IDeviceContext::Flush() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE Flush() override final;
 
     /// Implementation of IDeviceContext::BuildBLAS() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE BuildBLAS(const BuildBLASAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::BuildBLASBatch() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE BuildBLASBatch(const BuildBLASBatchAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::BuildTLAS() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE BuildTLAS(const BuildTLASAttribs& Attribs) override final;
 
@@ -318,6 +353,15 @@ public:
     /// Implementation of IDeviceContextVk::GetVkCommandBuffer().
     virtual VkCommandBuffer DILIGENT_CALL_TYPE GetVkCommandBuffer() override final;
 
+    /// Implementation of IDeviceContextVk::BeginSecondary().
+    virtual void DILIGENT_CALL_TYPE BeginSecondary(Uint32        ImmediateContextId,
+                                                   IRenderPass*  pRenderPass,
+                                                   Uint32        SubpassIndex,
+                                                   IFramebuffer* pFramebuffer) override final;
+
+    /// Implementation of IDeviceContextVk::SetSubpassContents().
+    virtual void DILIGENT_CALL_TYPE SetSubpassContents(VkSubpassContents Contents) override final;
+
     // Transitions BLAS state from OldState to NewState, and optionally updates internal state.
     // If OldState == RESOURCE_STATE_UNKNOWN, internal BLAS state is used as old state.
     void TransitionBLASState(BottomLevelASVkImpl& BLAS,
@@ -373,6 +417,9 @@ public:
 
     virtual void DILIGENT_CALL_TYPE GenerateMips(ITextureView* pTexView) override final;
 
+    /// Implementation of IDeviceContext::GenerateMipsBatch() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE GenerateMipsBatch(ITextureView* const* ppTexViews, Uint32 NumViews) override final;
+
     size_t GetNumCommandsInCtx() const { return m_State.NumCommands; }
 
     __forceinline VulkanUtilities::VulkanCommandBuffer& GetCommandBuffer()
@@ -399,6 +446,13 @@ public:
 
     VulkanDynamicAllocation AllocateDynamicSpace(Uint64 SizeInBytes, Uint32 Alignment);
 
+    // Returns the command buffer to the pool once the GPU has completed the submission identified by FenceValue.
+    void DisposeVkCmdBuffer(VulkanUtilities::VulkanCommandBufferPool& CmdPool,
+                            SoftwareQueueIndex                        CmdQueue,
+                            VkCommandBuffer                           vkCmdBuff,
+                            Uint64                                    FenceValue,
+                            bool                                      IsSecondary);
+
     virtual void ResetRenderTargets() override final;
 
     QueryManagerVk* GetQueryManager() { return m_pQueryMgr; }
@@ -409,6 +463,8 @@ private:
     void               CommitVkVertexBuffers();
     void               CommitViewports();
     void               CommitScissorRects();
+    void               CommitDynamicStates(const GraphicsPipelineDesc& GraphicsPipeline);
+    void               CommitDepthStencilState(const DepthStencilStateDesc& DSSDesc, PIPELINE_DYNAMIC_STATE_FLAGS DynamicStateFlags);
 
     void Flush(Uint32               NumCommandLists,
                ICommandList* const* ppCommandLists);
@@ -446,12 +502,26 @@ private:
         m_State.NumCommands = m_State.NumCommands != 0 ? m_State.NumCommands : 1;
         if (m_CommandBuffer.GetVkCmdBuffer() == VK_NULL_HANDLE)
         {
-            auto vkCmdBuff = m_CmdPool->GetCommandBuffer();
+            const auto* pInheritanceInfo = IsRecordingSecondaryCommands() ? &m_vkSecondaryInheritance : nullptr;
+
+            auto vkCmdBuff = m_CmdPool->GetCommandBuffer("", pInheritanceInfo, m_IsRecordingReusableCommands);
             m_CommandBuffer.SetVkCmdBuffer(vkCmdBuff, m_CmdPool->GetSupportedStagesMask(), m_CmdPool->GetSupportedAccessMask());
+            if (pInheritanceInfo != nullptr)
+                m_CommandBuffer.SetInheritedRenderPass(m_vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight);
         }
+
+        // The command being recorded may depend on the results of the pending
+        // load operations, so begin the implicit render pass that executes them.
+        if (m_HasPendingLoadOps)
+            CommitPendingLoadOps();
     }
 
-    inline void DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue);
+    // Returns true if the deferred context records a secondary command buffer (see BeginSecondary())
+    bool IsRecordingSecondaryCommands() const { return m_vkSecondaryInheritance.renderPass != VK_NULL_HANDLE; }
+
+    void ExecuteSecondaryCommandLists(Uint32 NumCommandLists, ICommandList* const* ppCommandLists);
+
+    inline void DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue, bool IsSecondary = false);
     inline void DisposeCurrentCmdBuffer(SoftwareQueueIndex CmdQueue, Uint64 FenceValue);
 
     void CopyBufferToTexture(VkBuffer                       vkSrcBuffer,
@@ -482,9 +552,42 @@ private:
 
     void CreateASCompactedSizeQueryPool();
 
+    // Uploads the instance records of the TLAS build that changed since the previous build.
+    void UploadChangedTLASInstances(TopLevelASVkImpl&                                      TLASVk,
+                                    const BuildTLASAttribs&                                Attribs,
+                                    const FrameVector<VkAccelerationStructureInstanceKHR>& Records,
+                                    const char*                                            OpName);
+
+    // Records the state transitions of the BLAS build and appends its geometries and build ranges
+    // to vkGeometries and vkRanges. vkASBuildInfo.pGeometries is left null as the vectors may be
+    // reallocated by the subsequent builds of the batch.
+    void PrepareBLASBuild(const BuildBLASAttribs&                                Attribs,
+                          BufferVkImpl&                                          ScratchBuffer,
+                          Uint64                                                 ScratchBufferOffset,
+                          RESOURCE_STATE_TRANSITION_MODE                         ScratchBufferTransitionMode,
+                          const char*                                            OpName,
+                          VkAccelerationStructureBuildGeometryInfoKHR&           vkASBuildInfo,
+                          FrameVector<VkAccelerationStructureGeometryKHR>&       vkGeometries,
+                          FrameVector<VkAccelerationStructureBuildRangeInfoKHR>& vkRanges);
+
     void PrepareCommandPool(SoftwareQueueIndex CommandQueueId);
 
     void ChooseRenderPassAndFramebuffer();
+    void BeginImplicitRenderPass();
+    void BeginDynamicRendering();
+
+    // Returns true if the render pass or the dynamic render pass instance that
+    // matches currently bound render targets is active in the command buffer.
+    bool IsImplicitRenderPassActive() const;
+
+    // Returns true if load operations of the implicit render pass can be changed,
+    // i.e. the implicit render pass has not begun yet.
+    bool CanDeferImplicitLoadOps() const;
+
+    void CommitPendingLoadOps();
+    // Begins the implicit render pass if there are pending clears, and
+    // drops all other pending load operations.
+    void FlushPendingLoadOps();
 
     VulkanUtilities::VulkanCommandBuffer m_CommandBuffer;
 
@@ -524,6 +627,9 @@ private:
             // Note that this is not the actual number of dynamic buffers in the resource cache.
             Uint32 DynamicOffsetCount = 0;
 
+            // Index of the first dynamic offset of this signature in m_BoundDynamicBufferOffsets
+            Uint32 DynamicOffsetStart = 0;
+
 #ifdef DILIGENT_DEVELOPMENT
             // The descriptor set base index that was used in the last BindDescriptorSets() call
             Uint32 LastBoundBaseInd = ~0u;
@@ -534,11 +640,19 @@ private:
         // Pipeline layout of the currently bound pipeline
         VkPipelineLayout vkPipelineLayout = VK_NULL_HANDLE;
 
+        // The total number of descriptors with dynamic offset in all descriptor sets
+        Uint32 TotalDynamicOffsetCount = 0;
+
+        // Indicates the signatures whose dynamic offsets in m_BoundDynamicBufferOffsets
+        // are the ones that their descriptor sets are currently bound with
+        SRBMaskType BoundDynamicOffsetsMask = 0;
+
         ResourceBindInfo()
         {}
     };
 
     __forceinline ResourceBindInfo& GetBindInfo(PIPELINE_TYPE Type);
+    __forceinline size_t            GetBindPointIndex(const ResourceBindInfo& BindInfo) const;
 
     __forceinline void CommitDescriptorSets(ResourceBindInfo& BindInfo, Uint32 CommitSRBMask);
 #ifdef DILIGENT_DEVELOPMENT
@@ -551,6 +665,18 @@ private:
     /// Memory to store dynamic buffer offsets for descriptor sets.
     std::vector<Uint32> m_DynamicBufferOffsets;
 
+    /// Dynamic buffer offsets that the descriptor sets of each bind point were last bound with,
+    /// see ResourceBindInfo::BoundDynamicOffsetsMask. The arrays are not released when the
+    /// bind info is reset, so that they are reused by subsequent command buffers.
+    std::array<std::vector<Uint32>, NUM_PIPELINE_BIND_POINTS> m_BoundDynamicBufferOffsets;
+
+    /// Scratch space used to write dynamic descriptor sets with update templates
+    std::vector<PipelineResourceSignatureVkImpl::DescriptorUpdateData> m_DescriptorUpdateData;
+
+    /// Scratch space used to translate multi-draw items into VK_EXT_multi_draw structures
+    std::vector<VkMultiDrawInfoEXT>        m_MultiDrawInfo;
+    std::vector<VkMultiDrawIndexedInfoEXT> m_MultiDrawIndexedInfo;
+
     /// Temporary array used by CommitDescriptorSets
     std::array<VkDescriptorSet, MAX_RESOURCE_SIGNATURES* MAX_DESCR_SET_PER_SIGNATURE> m_DescriptorSets = {};
 
@@ -562,6 +688,26 @@ private:
     /// This framebuffer may or may not be currently set in the command buffer
     VkFramebuffer m_vkFramebuffer = VK_NULL_HANDLE;
 
+    /// Whether currently bound render targets are rendered to using dynamic rendering
+    /// (VK_KHR_dynamic_rendering) instead of the implicit render pass and framebuffer.
+    /// In this case m_vkRenderPass and m_vkFramebuffer are null.
+    bool m_UseDynamicRendering = false;
+
+    /// Implicit render pass cache key of currently bound render targets
+    RenderPassCache::RenderPassCacheKey m_ImplicitRenderPassKey;
+
+    /// Attachment load and store operations that are used when the implicit
+    /// render pass or the dynamic render pass instance begins.
+    /// Load operations are reset to ATTACHMENT_LOAD_OP_LOAD once the pass begins.
+    RenderPassCache::AttachmentOps m_ImplicitAttachmentOps;
+
+    /// Clear values of the render targets and the depth-stencil buffer (the last element)
+    /// that use ATTACHMENT_LOAD_OP_CLEAR.
+    std::array<VkClearValue, MAX_RENDER_TARGETS + 1> m_ImplicitClearValues = {};
+
+    /// Whether m_ImplicitAttachmentOps contains load operations other than ATTACHMENT_LOAD_OP_LOAD
+    bool m_HasPendingLoadOps = false;
+
     FixedBlockMemoryAllocator m_CmdListAllocator;
 
     // Semaphores are not owned by the command context
@@ -619,6 +765,10 @@ private:
     VulkanDynamicHeap             m_DynamicHeap;
     DynamicDescriptorSetAllocator m_DynamicDescrSetAllocator;
 
+    // Globally unique identifier of the current generation of dynamic descriptor sets.
+    // Changes every time the allocator releases its pools, which invalidates all sets allocated before.
+    Uint64 m_DynamicDescrSetEpoch = 0;
+
     // In Vulkan we can't bind null vertex buffer, so we have to create a dummy VB
     RefCntAutoPtr<BufferVkImpl> m_DummyVB;
 
@@ -627,6 +777,20 @@ private:
 
     std::vector<VkClearValue> m_vkClearValues;
 
+    // Contents of the subpasses begun by BeginRenderPass() and NextSubpass()
+    VkSubpassContents m_vkSubpassContents = VK_SUBPASS_CONTENTS_INLINE;
+
+    // Inheritance info of the secondary command buffer recorded by the deferred context.
+    // renderPass is null when the context records a primary command buffer.
+    VkCommandBufferInheritanceInfo m_vkSecondaryInheritance{};
+
+    // Secondary command buffers executed by the current command buffer of the immediate context,
+    // and the deferred contexts that recorded them.
+    std::vector<std::pair<RefCntAutoPtr<IDeviceContext>, VkCommandBuffer>> m_PendingSecondaryCmdBuffs;
+
+    // The number of queries in m_ASQueryPool. BuildBLASBatch() writes compacted sizes in chunks of this size.
+    static constexpr Uint32 ASCompactedSizeQueryCount = 64;
+
     VulkanUtilities::QueryPoolWrapper m_ASQueryPool;
 };
 
@@ -63,6 +63,9 @@ public:
     /// Implementation of IDeviceMemoryVk::GetRange().
     virtual DeviceMemoryRangeVk DILIGENT_CALL_TYPE GetRange(Uint64 Offset, Uint64 Size) const override final;
 
+    /// Returns the index of the Vulkan memory type the pages are allocated from.
+    uint32_t GetMemoryTypeIndex() const { return m_MemoryTypeIndex; }
+
 private:
     std::vector<VulkanUtilities::DeviceMemoryWrapper> m_Pages;
     uint32_t                                          m_MemoryTypeIndex = ~0u;
@@ -68,6 +68,7 @@ class ShaderVkImpl;
 class SamplerVkImpl;
 class FenceVkImpl;
 class QueryVkImpl;
+class QueryArrayVkImpl;
 class RenderPassVkImpl;
 class FramebufferVkImpl;
 class CommandListVkImpl;
@@ -103,6 +104,7 @@ struct EngineVkImplTraits
     using SamplerInterface                   = ISamplerVk;
     using FenceInterface                     = IFenceVk;
     using QueryInterface                     = IQueryVk;
+    using QueryArrayInterface                = IQueryArray;
     using RenderPassInterface                = IRenderPassVk;
     using FramebufferInterface               = IFramebufferVk;
     using CommandListInterface               = ICommandList;
@@ -126,6 +128,7 @@ struct EngineVkImplTraits
     using SamplerImplType                   = SamplerVkImpl;
     using FenceImplType                     = FenceVkImpl;
     using QueryImplType                     = QueryVkImpl;
+    using QueryArrayImplType                = QueryArrayVkImpl;
     using RenderPassImplType                = RenderPassVkImpl;
     using FramebufferImplType               = FramebufferVkImpl;
     using CommandListImplType               = CommandListVkImpl;
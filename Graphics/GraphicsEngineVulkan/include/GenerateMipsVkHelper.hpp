@@ -39,6 +39,10 @@ class DeviceContextVkImpl;
 namespace GenerateMipsVkHelper
 {
 void GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx);
-}
+
+// Generates mipmaps for all views level by level, so that the layout transitions
+// of all textures for every level are recorded as one pipeline barrier.
+void GenerateMips(TextureViewVkImpl* const* ppTexViews, Uint32 NumViews, DeviceContextVkImpl& Ctx);
+} // namespace GenerateMipsVkHelper
 
 } // namespace Diligent
@@ -0,0 +1,181 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GraphicsPipelineLibraryCache class
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "HashUtils.hpp"
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "VulkanUtilities/VulkanLogicalDevice.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+/// Cache of graphics pipeline libraries (VK_EXT_graphics_pipeline_library).
+
+/// A graphics pipeline is split into vertex input interface, pre-rasterization shaders,
+/// fragment shader and fragment output interface parts that are compiled as separate
+/// libraries and then linked. Pipelines that share a part, e.g. permutations that only
+/// differ by the blend state, reuse the library and only pay for the fast link.
+///
+/// The cache only keeps weak references to the libraries: a library is owned by the pipelines
+/// linked from it and is released when the last of them is destroyed. Since the owning pipelines also
+/// keep their render passes and resource signatures alive, the Vulkan handles that are part of the keys
+/// can't be reused while the library is in the cache.
+class GraphicsPipelineLibraryCache
+{
+public:
+    enum LIBRARY_TYPE : Uint8
+    {
+        LIBRARY_TYPE_VERTEX_INPUT = 0,
+        LIBRARY_TYPE_PRE_RASTERIZATION,
+        LIBRARY_TYPE_FRAGMENT_SHADER,
+        LIBRARY_TYPE_FRAGMENT_OUTPUT,
+        LIBRARY_TYPE_COUNT
+    };
+
+    struct Library
+    {
+        VulkanUtilities::PipelineWrapper Pipeline;
+
+        // Shader libraries keep their own layout as the layout of the pipeline
+        // that created the library may be destroyed before the library is reused.
+        VulkanUtilities::PipelineLayoutWrapper Layout;
+    };
+    using LibraryPtr = std::shared_ptr<Library>;
+
+    /// Library key that consists of the raw values of the library state.
+    class Key
+    {
+    public:
+        explicit Key(LIBRARY_TYPE Type) :
+            m_Type{Type}
+        {}
+
+        template <typename T>
+        void Add(const T& Val)
+        {
+            static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value,
+                          "Only scalar values can be added to the key. Complex types must be added member by member to avoid padding.");
+            AddRaw(&Val, sizeof(Val));
+        }
+
+        template <typename FirstArgType, typename... RestArgsType>
+        void Add(const FirstArgType& FirstArg, const RestArgsType&... RestArgs)
+        {
+            Add(FirstArg);
+            Add(RestArgs...);
+        }
+
+        void AddRaw(const void* pData, size_t Size)
+        {
+            const auto* pBytes = static_cast<const Uint8*>(pData);
+            m_Data.insert(m_Data.end(), pBytes, pBytes + Size);
+            m_Hash = 0;
+        }
+
+        LIBRARY_TYPE GetType() const { return m_Type; }
+
+        bool operator==(const Key& rhs) const noexcept
+        {
+            return m_Type == rhs.m_Type && GetHash() == rhs.GetHash() && m_Data == rhs.m_Data;
+        }
+
+        size_t GetHash() const noexcept
+        {
+            if (m_Hash == 0)
+                m_Hash = ComputeHash(m_Type, ComputeHashRaw(m_Data.data(), m_Data.size()));
+            return m_Hash;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const Key& Key) const noexcept
+            {
+                return Key.GetHash();
+            }
+        };
+
+    private:
+        LIBRARY_TYPE       m_Type;
+        std::vector<Uint8> m_Data;
+        mutable size_t     m_Hash = 0;
+    };
+
+    GraphicsPipelineLibraryCache(RenderDeviceVkImpl& DeviceVk) noexcept;
+
+    // clang-format off
+    GraphicsPipelineLibraryCache             (const GraphicsPipelineLibraryCache&) = delete;
+    GraphicsPipelineLibraryCache             (GraphicsPipelineLibraryCache&&)      = delete;
+    GraphicsPipelineLibraryCache& operator = (const GraphicsPipelineLibraryCache&) = delete;
+    GraphicsPipelineLibraryCache& operator = (GraphicsPipelineLibraryCache&&)      = delete;
+    // clang-format on
+
+    /// Returns true if the device supports fast linking of graphics pipeline libraries.
+    bool IsSupported() const { return m_IsSupported; }
+
+    /// Finds the library with the given key. If there is no such library, creates
+    /// it with the CreateLibrary function that must return a Library object.
+
+    /// \remarks    The library is created without holding the cache lock, so multiple
+    ///             threads may create the same library simultaneously. In this case, only
+    ///             one of them is added to the cache and is returned to all threads.
+    template <typename CreateLibraryFuncType>
+    LibraryPtr GetLibrary(const Key& LibKey, CreateLibraryFuncType&& CreateLibrary) noexcept(false)
+    {
+        if (auto pLibrary = Find(LibKey))
+            return pLibrary;
+
+        return Add(LibKey, MakeLibraryPtr(CreateLibrary()));
+    }
+
+private:
+    LibraryPtr Find(const Key& LibKey);
+    LibraryPtr Add(const Key& LibKey, LibraryPtr pLibrary);
+    LibraryPtr MakeLibraryPtr(Library&& Lib);
+
+private:
+    RenderDeviceVkImpl& m_DeviceVk;
+    const bool          m_IsSupported;
+
+    std::mutex                                                   m_Mutex;
+    std::unordered_map<Key, std::weak_ptr<Library>, Key::Hasher> m_Cache;
+
+    // The number of cache entries after the last purge of expired libraries
+    size_t m_NumEntriesAfterPurge = 0;
+};
+
+} // namespace Diligent
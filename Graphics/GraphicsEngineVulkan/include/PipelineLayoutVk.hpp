@@ -59,6 +59,12 @@ public:
         return m_FirstDescrSetIndex[Index];
     }
 
+    // Returns the number of descriptor sets used by this pipeline layout
+    Uint32 GetDescrSetCount() const { return m_DescrSetCount; }
+
+    // Returns the descriptor set layouts this pipeline layout was created from
+    const VkDescriptorSetLayout* GetVkDescriptorSetLayouts() const { return m_DescSetLayouts.data(); }
+
 private:
     VulkanUtilities::PipelineLayoutWrapper m_VkPipelineLayout;
 
@@ -70,6 +76,9 @@ private:
     // (Maximum is MAX_RESOURCE_SIGNATURES * 2)
     Uint8 m_DescrSetCount = 0;
 
+    // Descriptor set layouts are owned by the resource signatures that the pipeline keeps alive
+    std::array<VkDescriptorSetLayout, MAX_RESOURCE_SIGNATURES* 2> m_DescSetLayouts = {};
+
 #ifdef DILIGENT_DEBUG
     Uint32 m_DbgMaxBindIndex = 0;
 #endif
@@ -31,6 +31,7 @@
 /// Declaration of Diligent::PipelineResourceSignatureVkImpl class
 
 #include <array>
+#include <vector>
 
 #include "EngineVkImplTraits.hpp"
 #include "PipelineResourceSignatureBase.hpp"
@@ -151,6 +152,10 @@ public:
     bool   HasDescriptorSet(DESCRIPTOR_SET_ID SetId) const { return m_VkDescrSetLayouts[SetId] != VK_NULL_HANDLE; }
     Uint32 GetDescriptorSetSize(DESCRIPTOR_SET_ID SetId) const { return m_DescriptorSetSizes[SetId]; }
 
+    // Returns true if the static/mutable descriptor set contains bindless resources
+    // and uses update-after-bind layout.
+    bool IsStaticMutableSetUpdateAfterBind() const { return m_IsStaticMutableSetUpdateAfterBind; }
+
     void InitSRBResourceCache(ShaderResourceCacheVk& ResourceCache);
 
     // Copies static resources from the static resource cache to the destination cache
@@ -158,9 +163,21 @@ public:
     // Make the base class method visible
     using TPipelineResourceSignatureBase::CopyStaticResources;
 
-    // Commits dynamic resources from ResourceCache to vkDynamicDescriptorSet
-    void CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
-                                VkDescriptorSet              vkDynamicDescriptorSet) const;
+    // Descriptor data consumed by the dynamic descriptor set update template.
+    // Every element of the dynamic set occupies one entry at its cache offset.
+    union DescriptorUpdateData
+    {
+        VkDescriptorImageInfo      ImageInfo;
+        VkDescriptorBufferInfo     BufferInfo;
+        VkBufferView               BufferView;
+        VkAccelerationStructureKHR AccelStruct;
+    };
+
+    // Commits dynamic resources from ResourceCache to vkDynamicDescriptorSet.
+    // UpdateData is the scratch space used to write descriptors with the update template.
+    void CommitDynamicResources(const ShaderResourceCacheVk&       ResourceCache,
+                                VkDescriptorSet                    vkDynamicDescriptorSet,
+                                std::vector<DescriptorUpdateData>& UpdateData) const;
 
 #ifdef DILIGENT_DEVELOPMENT
     /// Verifies committed resource using the SPIRV resource attributes from the PSO.
@@ -206,12 +223,36 @@ private:
 
     void CreateSetLayouts(bool IsSerialized);
 
+    void VerifyBindlessDescriptorTypeSupport(const PipelineResourceDesc& ResDesc, DescriptorType DescrType) const;
+
+    // Creates the template that writes all descriptors of the variables of the given type
+    // in the given set. Returns null if there are no such descriptors.
+    VulkanUtilities::DescrUpdateTemplateWrapper CreateSetUpdateTemplate(SHADER_RESOURCE_VARIABLE_TYPE VarType, DESCRIPTOR_SET_ID SetId) const;
+
+    static DescriptorUpdateData GetDescriptorUpdateData(DescriptorType DescrType, const ShaderResourceCacheVk::Resource& CachedRes);
+
+    // Copies static resources to the SRB cache and writes them with the update template.
+    // Returns false if some static resources are not bound or have already been copied.
+    bool CopyStaticResourcesWithTemplate(ShaderResourceCacheVk& DstResourceCache) const;
+
+    // Writes all dynamic resources with the update template.
+    // Returns false if some array elements are not bound.
+    bool CommitDynamicResourcesWithTemplate(const ShaderResourceCacheVk&       ResourceCache,
+                                            VkDescriptorSet                    vkDynamicDescriptorSet,
+                                            std::vector<DescriptorUpdateData>& UpdateData) const;
+
     static inline CACHE_GROUP       GetResourceCacheGroup(const PipelineResourceDesc& Res);
     static inline DESCRIPTOR_SET_ID VarTypeToDescriptorSetId(SHADER_RESOURCE_VARIABLE_TYPE VarType);
 
 private:
     std::array<VulkanUtilities::DescriptorSetLayoutWrapper, DESCRIPTOR_SET_ID_NUM_SETS> m_VkDescrSetLayouts;
 
+    // Update template that writes all descriptors of the dynamic set in a single call
+    VulkanUtilities::DescrUpdateTemplateWrapper m_DynamicSetUpdateTemplate;
+
+    // Update template that writes all static variable descriptors of the static/mutable set in a single call
+    VulkanUtilities::DescrUpdateTemplateWrapper m_StaticVarsUpdateTemplate;
+
     // Descriptor set sizes indexed by the set index in the layout (not DESCRIPTOR_SET_ID!)
     std::array<Uint32, MAX_DESCRIPTOR_SETS> m_DescriptorSetSizes = {~0U, ~0U};
 
@@ -222,6 +263,10 @@ private:
     // accounting for array size.
     Uint16 m_DynamicStorageBufferCount = 0;
 
+    // Static/mutable descriptor set layout is created with
+    // VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT flag.
+    bool m_IsStaticMutableSetUpdateAfterBind = false;
+
     ImmutableSamplerAttribs* m_ImmutableSamplers = nullptr; // [m_Desc.NumImmutableSamplers]
 };
 
@@ -29,6 +29,11 @@
 /// \file
 /// Declaration of Diligent::PipelineStateCacheVkImpl class
 
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #include "EngineVkImplTraits.hpp"
 #include "PipelineStateCacheBase.hpp"
 
@@ -57,8 +62,26 @@ public:
     /// Implementation of IPipelineStateCacheVk::GetVkPipelineCache().
     virtual VkPipelineCache DILIGENT_CALL_TYPE GetVkPipelineCache() const override final { return m_PipelineStateCache; }
 
+    /// Returns the pipeline cache that is used by the calling thread to create pipelines.
+
+    /// Every thread gets its own cache initialized with the same data, so that pipelines
+    /// can be created in parallel without contending on the cache. GetData() merges
+    /// all thread caches into the main cache.
+    VkPipelineCache GetThreadVkPipelineCache();
+
+private:
+    void MergeThreadCaches();
+
 private:
     VulkanUtilities::PipelineCacheWrapper m_PipelineStateCache;
+
+    // Validated driver data that thread caches are initialized with.
+    std::vector<Uint8> m_InitialData;
+
+    // Protects the thread caches and the main cache while the caches are merged.
+    std::mutex m_CachesMtx;
+
+    std::unordered_map<std::thread::id, VulkanUtilities::PipelineCacheWrapper> m_ThreadCaches;
 };
 
 } // namespace Diligent
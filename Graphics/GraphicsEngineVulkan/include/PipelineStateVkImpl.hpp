@@ -31,6 +31,7 @@
 /// Declaration of Diligent::PipelineStateVkImpl class
 
 #include <array>
+#include <atomic>
 #include <memory>
 
 #include "EngineVkImplTraits.hpp"
@@ -41,6 +42,7 @@
 #include "FixedBlockMemoryAllocator.hpp"
 #include "SRBMemoryAllocator.hpp"
 #include "PipelineLayoutVk.hpp"
+#include "GraphicsPipelineLibraryCache.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 #include "VulkanUtilities/VulkanCommandBuffer.hpp"
 
@@ -69,10 +71,21 @@ public:
     virtual IRenderPassVk* DILIGENT_CALL_TYPE GetRenderPass() const override final { return GetRenderPassPtr().RawPtr<IRenderPassVk>(); }
 
     /// Implementation of IPipelineStateVk::GetVkPipeline().
-    virtual VkPipeline DILIGENT_CALL_TYPE GetVkPipeline() const override final { return m_Pipeline; }
+    virtual VkPipeline DILIGENT_CALL_TYPE GetVkPipeline() const override final
+    {
+        const auto vkOptimizedPipeline = m_vkOptimizedPipeline.load(std::memory_order_acquire);
+        return vkOptimizedPipeline != VK_NULL_HANDLE ? vkOptimizedPipeline : static_cast<VkPipeline>(m_Pipeline);
+    }
 
     const PipelineLayoutVk& GetPipelineLayout() const { return m_PipelineLayout; }
 
+    /// Returns true if this is a graphics pipeline created for dynamic rendering
+    /// (VK_KHR_dynamic_rendering) rather than for the implicit render pass.
+    bool UsesDynamicRendering() const
+    {
+        return m_Desc.IsAnyGraphicsPipeline() && GetDevice()->UseDynamicRendering(GetGraphicsPipelineDesc());
+    }
+
     struct ShaderStageInfo
     {
         ShaderStageInfo() {}
@@ -91,6 +104,8 @@ public:
     };
     using TShaderStages = std::vector<ShaderStageInfo>;
 
+    using TGraphicsPipelineLibraries = std::array<GraphicsPipelineLibraryCache::LibraryPtr, GraphicsPipelineLibraryCache::LIBRARY_TYPE_COUNT>;
+
 #ifdef DILIGENT_DEVELOPMENT
     // Performs validation of SRB resource parameters that are not possible to validate
     // when resource is bound.
@@ -129,11 +144,22 @@ private:
     void InitPipelineLayout(const PipelineStateCreateInfo& CreateInfo,
                             TShaderStages&                 ShaderStages) noexcept(false);
 
+    void EnqueueOptimizedLink(IPipelineStateCache* pPSOCache);
+
     void Destruct();
 
     VulkanUtilities::PipelineWrapper m_Pipeline;
     PipelineLayoutVk                 m_PipelineLayout;
 
+    // Graphics pipeline libraries m_Pipeline was fast-linked from, if any
+    TGraphicsPipelineLibraries m_Libraries;
+
+    // Pipeline linked from m_Libraries with link-time optimization in the background.
+    // Once it is ready, m_vkOptimizedPipeline is set and replaces m_Pipeline.
+    VulkanUtilities::PipelineWrapper m_OptimizedPipeline;
+    std::atomic<VkPipeline>          m_vkOptimizedPipeline{VK_NULL_HANDLE};
+    RefCntAutoPtr<IAsyncTask>        m_pOptimizedLinkTask;
+
 #ifdef DILIGENT_DEVELOPMENT
     // Shader resources for all shaders in all shader stages
     TShaderResources m_ShaderResources;
@@ -36,6 +36,7 @@
 #include "VulkanUtilities/VulkanPhysicalDevice.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 #include "VulkanUtilities/VulkanCommandBuffer.hpp"
+#include "AdaptiveLock.hpp"
 
 namespace Diligent
 {
@@ -84,9 +85,12 @@ private:
     class QueryPoolInfo
     {
     public:
+        // If Deferred is true, the Vulkan query pool is created and reset on the host
+        // when the first query is allocated. This requires hostQueryReset feature.
         void Init(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
                   const VkQueryPoolCreateInfo&                QueryPoolCI,
-                  QUERY_TYPE                                  Type);
+                  QUERY_TYPE                                  Type,
+                  bool                                        Deferred);
 
         QueryPoolInfo() noexcept {}
         ~QueryPoolInfo();
@@ -123,16 +127,23 @@ private:
             return m_vkQueryPool == VK_NULL_HANDLE;
         }
 
+    private:
+        void CreateDeferredPool();
+
     private:
         VulkanUtilities::QueryPoolWrapper m_vkQueryPool;
 
+        // Logical device and create info of the deferred pool that has not been created yet
+        const VulkanUtilities::VulkanLogicalDevice* m_pLogicalDevice = nullptr;
+        VkQueryPoolCreateInfo                       m_DeferredPoolCI = {};
+
         QUERY_TYPE m_Type                = QUERY_TYPE_UNDEFINED;
         Uint32     m_QueryCount          = 0;
         Uint32     m_MaxAllocatedQueries = 0;
 
-        std::mutex          m_QueriesMtx;
-        std::vector<Uint32> m_AvailableQueries;
-        std::vector<Uint32> m_StaleQueries;
+        Threading::EngineMutex m_QueriesMtx;
+        std::vector<Uint32>    m_AvailableQueries;
+        std::vector<Uint32>    m_StaleQueries;
     };
 
     const SoftwareQueueIndex m_CommandQueueId;
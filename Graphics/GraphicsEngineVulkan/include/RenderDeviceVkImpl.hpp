@@ -29,7 +29,9 @@
 
 /// \file
 /// Declaration of Diligent::RenderDeviceVkImpl class
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -51,6 +53,7 @@
 #include "VulkanUploadHeap.hpp"
 #include "FramebufferCache.hpp"
 #include "RenderPassCache.hpp"
+#include "GraphicsPipelineLibraryCache.hpp"
 #include "CommandPoolManager.hpp"
 #include "DXCompiler.hpp"
 
@@ -112,6 +115,9 @@ public:
     /// Implementation of IRenderDevice::CreateQuery() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE CreateQuery(const QueryDesc& Desc, IQuery** ppQuery) override final;
 
+    /// Implementation of IRenderDevice::CreateQueryArray() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE CreateQueryArray(const QueryArrayDesc& Desc, IQueryArray** ppQueryArray) override final;
+
     /// Implementation of IRenderDevice::CreateRenderPass() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE CreateRenderPass(const RenderPassDesc& Desc,
                                                      IRenderPass**         ppRenderPass) override final;
@@ -199,6 +205,12 @@ public:
                                                                   const FenceDesc& Desc,
                                                                   IFence**         ppFence) override final;
 
+    /// Implementation of IRenderDeviceVk::GetDynamicHeapStats().
+    virtual void DILIGENT_CALL_TYPE GetDynamicHeapStats(DynamicHeapStatsVk& Stats) override final
+    {
+        m_DynamicMemoryManager.GetStats(Stats);
+    }
+
     /// Implementation of IRenderDevice::IdleGPU() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE IdleGPU() override final;
 
@@ -212,6 +224,19 @@ public:
                                   const Char*                           DebugPoolName = nullptr);
     void ExecuteAndDisposeTransientCmdBuff(SoftwareQueueIndex CommandQueueId, VkCommandBuffer vkCmdBuff, VulkanUtilities::CommandPoolWrapper&& CmdPool);
 
+    // Records the commands that copy the initial data of a buffer or a texture from the staging buffer.
+    // If initial data batching is enabled (see EngineVkCreateInfo::InitialDataBatchSize), the commands
+    // are recorded into the command buffer shared by all threads that is submitted by FlushInitialDataBatch().
+    // Otherwise, the commands are recorded into a transient command buffer that is submitted immediately.
+    void RecordInitialDataCopy(SoftwareQueueIndex                                                CommandQueueId,
+                               Uint64                                                            StagingDataSize,
+                               const Char*                                                       DebugPoolName,
+                               const std::function<void(VulkanUtilities::VulkanCommandBuffer&)>& RecordCommands);
+
+    // Submits the batched initial data copy commands to the queue.
+    // The batch must be submitted before any command buffer that may use the initialized resources.
+    void FlushInitialDataBatch(SoftwareQueueIndex CommandQueueId);
+
     /// Implementation of IRenderDevice::ReleaseStaleResources() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE ReleaseStaleResources(bool ForceRelease = false) override final;
 
@@ -220,10 +245,24 @@ public:
                                                                                   RESOURCE_DIMENSION Dimension,
                                                                                   Uint32             SampleCount) const override final;
 
+    /// Implementation of IRenderDevice::GetMemoryBudget() in Vulkan backend.
+    virtual DeviceMemoryBudget DILIGENT_CALL_TYPE GetMemoryBudget() const override final;
+
+    /// Implementation of IRenderDevice::GetTextureMemoryRequirements() in Vulkan backend.
+    virtual ResourceMemoryRequirements DILIGENT_CALL_TYPE GetTextureMemoryRequirements(const TextureDesc& TexDesc) const override final;
+
+    /// Implementation of IRenderDevice::GetBufferMemoryRequirements() in Vulkan backend.
+    virtual ResourceMemoryRequirements DILIGENT_CALL_TYPE GetBufferMemoryRequirements(const BufferDesc& BuffDesc) const override final;
+
     DescriptorSetAllocation AllocateDescriptorSet(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName = "")
     {
         return m_DescriptorSetAllocator.Allocate(CommandQueueMask, SetLayout, DebugName);
     }
+    // Allocates a descriptor set with VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT layout
+    DescriptorSetAllocation AllocateBindlessDescriptorSet(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName = "")
+    {
+        return m_BindlessDescriptorSetAllocator.Allocate(CommandQueueMask, SetLayout, DebugName);
+    }
     DescriptorPoolManager& GetDynamicDescriptorPool() { return m_DynamicDescriptorPool; }
 
     std::shared_ptr<const VulkanUtilities::VulkanInstance> GetVulkanInstance() const { return m_VulkanInstance; }
@@ -234,16 +273,42 @@ public:
     FramebufferCache& GetFramebufferCache() { return m_FramebufferCache; }
     RenderPassCache&  GetImplicitRenderPassCache() { return m_ImplicitRenderPassCache; }
 
-    VulkanUtilities::VulkanMemoryAllocation AllocateMemory(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProperties, VkMemoryAllocateFlags AllocateFlags = 0)
+    GraphicsPipelineLibraryCache& GetGraphicsPipelineLibraryCache() { return m_GraphicsPipelineLibraryCache; }
+
+    // Returns true if VK_KHR_dynamic_rendering is enabled and render targets set with
+    // SetRenderTargets() are rendered without implicit render passes and framebuffers.
+    bool IsDynamicRenderingEnabled() const
+    {
+        return m_LogicalVkDevice->GetEnabledExtFeatures().DynamicRendering.dynamicRendering != VK_FALSE;
+    }
+
+    // Returns true if graphics pipelines that use the given description are created for dynamic
+    // rendering instead of an implicit render pass. Pipelines with explicit render passes and
+    // pipelines that use a shading rate texture always use render passes.
+    bool UseDynamicRendering(const GraphicsPipelineDesc& GraphicsPipeline) const
     {
-        return m_MemoryMgr.Allocate(MemReqs, MemoryProperties, AllocateFlags);
+        return IsDynamicRenderingEnabled() &&
+            GraphicsPipeline.pRenderPass == nullptr &&
+            (GraphicsPipeline.ShadingRateFlags & PIPELINE_SHADING_RATE_FLAG_TEXTURE_BASED) == 0;
     }
-    VulkanUtilities::VulkanMemoryAllocation AllocateMemory(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, VkMemoryAllocateFlags AllocateFlags = 0)
+
+    VulkanUtilities::VulkanMemoryAllocation AllocateMemory(const VkMemoryRequirements&                           MemReqs,
+                                                           VkMemoryPropertyFlags                                 MemoryProperties,
+                                                           VkMemoryAllocateFlags                                 AllocateFlags  = 0,
+                                                           const VulkanUtilities::VulkanDedicatedAllocationInfo* pDedicatedInfo = nullptr)
+    {
+        return m_MemoryMgr.Allocate(MemReqs, MemoryProperties, AllocateFlags, pDedicatedInfo);
+    }
+    VulkanUtilities::VulkanMemoryAllocation AllocateMemory(VkDeviceSize                                          Size,
+                                                           VkDeviceSize                                          Alignment,
+                                                           uint32_t                                              MemoryTypeIndex,
+                                                           VkMemoryAllocateFlags                                 AllocateFlags  = 0,
+                                                           const VulkanUtilities::VulkanDedicatedAllocationInfo* pDedicatedInfo = nullptr)
     {
         const auto& MemoryProps = m_PhysicalDevice->GetMemoryProperties();
         VERIFY_EXPR(MemoryTypeIndex < MemoryProps.memoryTypeCount);
         const auto MemoryFlags = MemoryProps.memoryTypes[MemoryTypeIndex].propertyFlags;
-        return m_MemoryMgr.Allocate(Size, Alignment, MemoryTypeIndex, (MemoryFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0, AllocateFlags);
+        return m_MemoryMgr.Allocate(Size, Alignment, MemoryTypeIndex, (MemoryFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0, AllocateFlags, pDedicatedInfo);
     }
     VulkanUtilities::VulkanMemoryManager& GetGlobalMemoryManager() { return m_MemoryMgr; }
 
@@ -297,6 +362,9 @@ private:
     RenderPassCache        m_ImplicitRenderPassCache;
     DescriptorSetAllocator m_DescriptorSetAllocator;
     DescriptorPoolManager  m_DynamicDescriptorPool;
+    DescriptorSetAllocator m_BindlessDescriptorSetAllocator;
+
+    GraphicsPipelineLibraryCache m_GraphicsPipelineLibraryCache;
 
     // These one-time command pools are used by buffer and texture constructors to
     // issue copy commands. Vulkan requires that every command pool is used by one thread
@@ -310,6 +378,17 @@ private:
 
     VulkanDynamicMemoryManager m_DynamicMemoryManager;
 
+    // Initial data copy commands recorded by resource constructors from all threads, one batch per command queue.
+    struct InitialDataBatch
+    {
+        std::mutex                           Mtx;
+        VulkanUtilities::CommandPoolWrapper  CmdPool;
+        VulkanUtilities::VulkanCommandBuffer CmdBuffer;
+        Uint64                               StagingDataSize = 0;
+    };
+    const Uint64                        m_InitialDataBatchSize;
+    std::unique_ptr<InitialDataBatch[]> m_InitialDataBatches;
+
     std::unique_ptr<IDXCompiler> m_pDxCompiler;
 };
 
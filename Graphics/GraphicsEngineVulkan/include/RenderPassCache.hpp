@@ -34,10 +34,12 @@
 #include <mutex>
 
 #include "GraphicsTypes.h"
+#include "RenderPass.h"
 #include "Constants.h"
 #include "HashUtils.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 #include "RefCntAutoPtr.hpp"
+#include "AdaptiveLock.hpp"
 
 namespace Diligent
 {
@@ -59,6 +61,47 @@ public:
 
     ~RenderPassCache();
 
+    // Load and store operations of the implicit render pass attachments.
+    // Render passes that only differ by these operations are compatible
+    // and can use the same framebuffer.
+    struct AttachmentOps
+    {
+        ATTACHMENT_LOAD_OP  RTVLoadOps[MAX_RENDER_TARGETS] = {};
+        ATTACHMENT_LOAD_OP  DepthLoadOp                    = ATTACHMENT_LOAD_OP_LOAD;
+        ATTACHMENT_LOAD_OP  StencilLoadOp                  = ATTACHMENT_LOAD_OP_LOAD;
+        ATTACHMENT_STORE_OP DepthStencilStoreOp            = ATTACHMENT_STORE_OP_STORE;
+
+        // Returns true if any attachment uses a load operation other than ATTACHMENT_LOAD_OP_LOAD
+        bool HasLoadOps(Uint32 NumRenderTargets) const noexcept
+        {
+            for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
+            {
+                if (RTVLoadOps[rt] != ATTACHMENT_LOAD_OP_LOAD)
+                    return true;
+            }
+            return DepthLoadOp != ATTACHMENT_LOAD_OP_LOAD || StencilLoadOp != ATTACHMENT_LOAD_OP_LOAD;
+        }
+
+        // Returns true if any attachment is cleared by ATTACHMENT_LOAD_OP_CLEAR
+        bool HasClearOps(Uint32 NumRenderTargets) const noexcept
+        {
+            for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
+            {
+                if (RTVLoadOps[rt] == ATTACHMENT_LOAD_OP_CLEAR)
+                    return true;
+            }
+            return DepthLoadOp == ATTACHMENT_LOAD_OP_CLEAR || StencilLoadOp == ATTACHMENT_LOAD_OP_CLEAR;
+        }
+
+        void ResetLoadOps() noexcept
+        {
+            for (auto& LoadOp : RTVLoadOps)
+                LoadOp = ATTACHMENT_LOAD_OP_LOAD;
+            DepthLoadOp   = ATTACHMENT_LOAD_OP_LOAD;
+            StencilLoadOp = ATTACHMENT_LOAD_OP_LOAD;
+        }
+    };
+
     // This structure is used as the key to find framebuffer
     struct RenderPassCacheKey
     {
@@ -86,6 +129,13 @@ public:
         bool           EnableVRS                      = false;
         TEXTURE_FORMAT DSVFormat                      = TEX_FORMAT_UNKNOWN;
         TEXTURE_FORMAT RTVFormats[MAX_RENDER_TARGETS] = {};
+        AttachmentOps  Ops;
+
+        void SetAttachmentOps(const AttachmentOps& _Ops) noexcept
+        {
+            Ops  = _Ops;
+            Hash = 0;
+        }
 
         bool operator==(const RenderPassCacheKey& rhs) const noexcept
         {
@@ -94,14 +144,17 @@ public:
                 NumRenderTargets != rhs.NumRenderTargets ||
                 SampleCount      != rhs.SampleCount      ||
                 EnableVRS        != rhs.EnableVRS        ||
-                DSVFormat        != rhs.DSVFormat)
+                DSVFormat        != rhs.DSVFormat        ||
+                Ops.DepthLoadOp         != rhs.Ops.DepthLoadOp   ||
+                Ops.StencilLoadOp       != rhs.Ops.StencilLoadOp ||
+                Ops.DepthStencilStoreOp != rhs.Ops.DepthStencilStoreOp)
             {
                 return false;
             }
             // clang-format on
 
             for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
-                if (RTVFormats[rt] != rhs.RTVFormats[rt])
+                if (RTVFormats[rt] != rhs.RTVFormats[rt] || Ops.RTVLoadOps[rt] != rhs.Ops.RTVLoadOps[rt])
                     return false;
 
             return true;
@@ -111,9 +164,9 @@ public:
         {
             if (Hash == 0)
             {
-                Hash = ComputeHash(NumRenderTargets, SampleCount, DSVFormat, EnableVRS);
+                Hash = ComputeHash(NumRenderTargets, SampleCount, DSVFormat, EnableVRS, Ops.DepthLoadOp, Ops.StencilLoadOp, Ops.DepthStencilStoreOp);
                 for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
-                    HashCombine(Hash, RTVFormats[rt]);
+                    HashCombine(Hash, RTVFormats[rt], Ops.RTVLoadOps[rt]);
             }
             return Hash;
         }
@@ -137,7 +190,7 @@ private:
 
     RenderDeviceVkImpl& m_DeviceVkImpl;
 
-    std::mutex                                                                                      m_Mutex;
+    Threading::EngineMutex                                                                          m_Mutex;
     std::unordered_map<RenderPassCacheKey, RefCntAutoPtr<RenderPassVkImpl>, RenderPassCacheKeyHash> m_Cache;
 };
 
@@ -30,6 +30,9 @@
 /// \file
 /// Declaration of Diligent::ShaderResourceBindingVkImpl class
 
+#include <unordered_map>
+#include <vector>
+
 #include "EngineVkImplTraits.hpp"
 #include "ShaderResourceBindingBase.hpp"
 #include "ShaderBase.hpp"
@@ -55,6 +58,28 @@ public:
     ~ShaderResourceBindingVkImpl();
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ShaderResourceBindingVk, TBase)
+
+    /// Implementation of IShaderResourceBindingVk::AddBindlessResource().
+    virtual Uint32 DILIGENT_CALL_TYPE AddBindlessResource(IShaderResourceVariable* pVariable,
+                                                          IDeviceObject*           pObject) override final;
+
+    /// Implementation of IShaderResourceBindingVk::RemoveBindlessResource().
+    virtual void DILIGENT_CALL_TYPE RemoveBindlessResource(IShaderResourceVariable* pVariable,
+                                                           IDeviceObject*           pObject) override final;
+
+private:
+    const ShaderVariableVkImpl* FindBindlessVariable(IShaderResourceVariable* pVariable) const;
+
+    // Element allocation state of a bindless array
+    struct BindlessArrayElements
+    {
+        // Resources kept in the cache are referenced by the cache, so raw pointers are safe.
+        std::unordered_map<const IDeviceObject*, Uint32> Indices;
+        std::vector<Uint32>                              FreeIndices;
+        Uint32                                           NextIndex = 0;
+    };
+    // Indexed by the resource index in the signature
+    std::unordered_map<Uint32, BindlessArrayElements> m_BindlessArrays;
 };
 
 } // namespace Diligent
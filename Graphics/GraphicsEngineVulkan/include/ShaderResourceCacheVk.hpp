@@ -112,8 +112,7 @@ public:
 
 /* 0 */ const DescriptorType         Type;
 /* 1 */ const bool                   HasImmutableSampler;
-/*2-3*/ // Unused
-/* 4 */ Uint32                       BufferDynamicOffset = 0;
+/*2-7*/ // Unused
 /* 8 */ RefCntAutoPtr<IDeviceObject> pObject;
 
         // For uniform and storage buffers only
@@ -210,6 +209,10 @@ public:
         const Uint64 BufferBaseOffset = 0;
         const Uint64 BufferRangeSize  = 0;
 
+        // The resource belongs to an update-after-bind (bindless) binding, so changing it
+        // does not invalidate the committed descriptor set and does not update the cache revision.
+        const bool UpdateAfterBind = false;
+
         SetResourceInfo() noexcept
         {
         }
@@ -218,13 +221,15 @@ public:
                         Uint32                         _ArrayIndex,
                         RefCntAutoPtr<IDeviceObject>&& _pObject,
                         Uint64                         _BufferBaseOffset = 0,
-                        Uint64                         _BufferRangeSize  = 0) noexcept :
+                        Uint64                         _BufferRangeSize  = 0,
+                        bool                           _UpdateAfterBind  = false) noexcept :
             // clang-format off
             BindingIndex    {_BindingIndex      },
             ArrayIndex      {_ArrayIndex        },
             pObject         {std::move(_pObject)},
             BufferBaseOffset{_BufferBaseOffset  },
-            BufferRangeSize {_BufferRangeSize   }
+            BufferRangeSize {_BufferRangeSize   },
+            UpdateAfterBind {_UpdateAfterBind   }
         // clang-format on
         {
         }
@@ -236,9 +241,10 @@ public:
                                 SetResourceInfo&&                           SrcRes);
 
     const Resource& ResetResource(Uint32 SetIndex,
-                                  Uint32 Offset)
+                                  Uint32 Offset,
+                                  bool   UpdateAfterBind = false)
     {
-        return SetResource(nullptr, SetIndex, Offset, {});
+        return SetResource(nullptr, SetIndex, Offset, {0, 0, {}, 0, 0, UpdateAfterBind});
     }
 
     void SetDynamicBufferOffset(Uint32 DescrSetIndex,
@@ -249,6 +255,19 @@ public:
     Uint32 GetNumDescriptorSets() const { return m_NumSets; }
     bool   HasDynamicResources() const { return m_NumDynamicBuffers > 0; }
 
+    // Returns the dynamic descriptor set written by the last commit if it was allocated
+    // by the dynamic descriptor set allocator generation identified by AllocatorEpoch.
+    VkDescriptorSet GetCommittedDynamicSet(Uint64 AllocatorEpoch) const
+    {
+        return m_CommittedDynamicSetEpoch == AllocatorEpoch ? m_vkCommittedDynamicSet : VK_NULL_HANDLE;
+    }
+
+    void SetCommittedDynamicSet(VkDescriptorSet vkSet, Uint64 AllocatorEpoch)
+    {
+        m_vkCommittedDynamicSet    = vkSet;
+        m_CommittedDynamicSetEpoch = AllocatorEpoch;
+    }
+
     ResourceCacheContentType GetContentType() const { return static_cast<ResourceCacheContentType>(m_ContentType); }
 
 #ifdef DILIGENT_DEBUG
@@ -257,6 +276,9 @@ public:
     void DbgVerifyDynamicBuffersCounter() const;
 #endif
 
+    // Transitions all resources in the cache. If the resource states are up-to-date
+    // (see ShaderResourceCacheBase::ResourceStatesUpToDate()), only storage resources and
+    // acceleration structures that must be processed every time they are used are transitioned.
     template <bool VerifyOnly>
     void TransitionResources(DeviceContextVkImpl* pCtxVkImpl);
 
@@ -280,6 +302,15 @@ private:
         return reinterpret_cast<DescriptorSet*>(m_pMemory.get())[Index];
     }
 
+    // Returns the index of the dynamic buffer slot in m_DynamicSlotBuffers and m_DynamicSlotOffsets
+    Uint32 GetDynamicBufferSlot(Uint32 SetIndex, Uint32 CacheOffset) const
+    {
+        VERIFY_EXPR(SetIndex < m_NumSets);
+        VERIFY(CacheOffset < m_FirstDynamicSlot[SetIndex + 1] - m_FirstDynamicSlot[SetIndex],
+               "Resource at offset ", CacheOffset, " in set ", SetIndex, " is not a dynamic uniform or storage buffer");
+        return m_FirstDynamicSlot[SetIndex] + CacheOffset;
+    }
+
     std::unique_ptr<void, STDDeleter<void, IMemoryAllocator>> m_pMemory;
 
     Uint16 m_NumSets = 0;
@@ -292,6 +323,22 @@ private:
     // Indicates what types of resources are stored in the cache
     const Uint32 m_ContentType : 1;
 
+    // Dynamic descriptor set written by the last commit. The set remains valid while the
+    // allocator epoch of the context that allocated it is unchanged, and is reused by
+    // subsequent commits as long as no dynamic resource has been modified.
+    VkDescriptorSet m_vkCommittedDynamicSet    = VK_NULL_HANDLE;
+    Uint64          m_CommittedDynamicSetEpoch = 0;
+
+    // Hot data of the dynamic uniform and storage buffer descriptors that is read by every draw call.
+    // The data is stored in parallel arrays separately from the resources, in the order in which dynamic
+    // offsets are passed to vkCmdBindDescriptorSets: all slots of set 0 go first, followed by the slots
+    // of set 1. Dynamic buffers always go first in each descriptor set.
+    std::vector<const BufferVkImpl*> m_DynamicSlotBuffers;
+    std::vector<Uint32>              m_DynamicSlotOffsets;
+
+    // Index of the first dynamic buffer slot of every set. The last element is the total number of slots.
+    std::vector<Uint32> m_FirstDynamicSlot;
+
 #ifdef DILIGENT_DEBUG
     // Debug array that stores flags indicating if resources in the cache have been initialized
     std::vector<std::vector<bool>> m_DbgInitializedResources;
@@ -332,67 +379,39 @@ __forceinline Uint32 ShaderResourceCacheVk::GetDynamicBufferOffsets(DeviceContex
     // for every shader stage come first, followed by all storage buffers with dynamic offsets
     // (DescriptorType::StorageBufferDynamic and DescriptorType::StorageBufferDynamic_ReadOnly) for every shader stage,
     // followed by all other resources.
-    Uint32 OffsetInd = StartInd;
-    for (Uint32 set = 0; set < m_NumSets; ++set)
+    const auto NumSlots = static_cast<Uint32>(m_DynamicSlotBuffers.size());
+    for (Uint32 slot = 0; slot < NumSlots; ++slot)
     {
-        const auto& DescrSet = GetDescriptorSet(set);
-        const auto  SetSize  = DescrSet.GetSize();
-
-        Uint32 res = 0;
-        while (res < SetSize)
-        {
-            const auto& Res = DescrSet.GetResource(res);
-            if (Res.Type == DescriptorType::UniformBufferDynamic)
-            {
-                const auto* pBufferVk = Res.pObject.RawPtr<const BufferVkImpl>();
-                // Do not verify dynamic allocation here as there may be some buffers that are not used by the PSO.
-                // The allocations of the buffers that are actually used will be verified by
-                // PipelineResourceSignatureVkImpl::DvpValidateCommittedResource().
-                const auto Offset = pBufferVk != nullptr ? pBufferVk->GetDynamicOffset(CtxId, nullptr /* Do not verify allocation*/) : 0;
-                // The effective offset used for dynamic uniform and storage buffer bindings is the sum of the relative
-                // offset taken from pDynamicOffsets, and the base address of the buffer plus base offset in the descriptor set.
-                // The range of the dynamic uniform and storage buffer bindings is the buffer range as specified in the descriptor set.
-                Offsets[OffsetInd++] = StaticCast<Uint32>(Res.BufferDynamicOffset + Offset);
-                ++res;
-            }
-            else
-                break;
-        }
-
-        while (res < SetSize)
-        {
-            const auto& Res = DescrSet.GetResource(res);
-            if (Res.Type == DescriptorType::StorageBufferDynamic ||
-                Res.Type == DescriptorType::StorageBufferDynamic_ReadOnly)
-            {
-                const auto* pBufferVkView = Res.pObject.RawPtr<const BufferViewVkImpl>();
-                const auto* pBufferVk     = pBufferVkView != nullptr ? pBufferVkView->GetBuffer<const BufferVkImpl>() : nullptr;
-                // Do not verify dynamic allocation here as there may be some buffers that are not used by the PSO.
-                // The allocations of the buffers that are actually used will be verified by
-                // PipelineResourceSignatureVkImpl::DvpValidateCommittedResource().
-                const auto Offset = pBufferVk != nullptr ? pBufferVk->GetDynamicOffset(CtxId, nullptr /* Do not verify allocation*/) : 0;
-                // The effective offset used for dynamic uniform and storage buffer bindings is the sum of the relative
-                // offset taken from pDynamicOffsets, and the base address of the buffer plus base offset in the descriptor set.
-                // The range of the dynamic uniform and storage buffer bindings is the buffer range as specified in the descriptor set.
-                Offsets[OffsetInd++] = StaticCast<Uint32>(Res.BufferDynamicOffset + Offset);
-                ++res;
-            }
-            else
-                break;
-        }
+        const auto* pBufferVk = m_DynamicSlotBuffers[slot];
+        // Do not verify dynamic allocation here as there may be some buffers that are not used by the PSO.
+        // The allocations of the buffers that are actually used will be verified by
+        // PipelineResourceSignatureVkImpl::DvpValidateCommittedResource().
+        const auto Offset = pBufferVk != nullptr ? pBufferVk->GetDynamicOffset(CtxId, nullptr /* Do not verify allocation*/) : 0;
+        // The effective offset used for dynamic uniform and storage buffer bindings is the sum of the relative
+        // offset taken from pDynamicOffsets, and the base address of the buffer plus base offset in the descriptor set.
+        // The range of the dynamic uniform and storage buffer bindings is the buffer range as specified in the descriptor set.
+        Offsets[StartInd + slot] = StaticCast<Uint32>(m_DynamicSlotOffsets[slot] + Offset);
+    }
 
 #ifdef DILIGENT_DEBUG
-        for (; res < SetSize; ++res)
+    for (Uint32 set = 0; set < m_NumSets; ++set)
+    {
+        const auto& DescrSet        = GetDescriptorSet(set);
+        const auto  NumDynamicSlots = m_FirstDynamicSlot[set + 1] - m_FirstDynamicSlot[set];
+        for (Uint32 res = 0; res < DescrSet.GetSize(); ++res)
         {
             const auto& Res = DescrSet.GetResource(res);
-            VERIFY((Res.Type != DescriptorType::UniformBufferDynamic &&
-                    Res.Type != DescriptorType::StorageBufferDynamic &&
-                    Res.Type != DescriptorType::StorageBufferDynamic_ReadOnly),
+            const auto  IsDynamicSlot =
+                (Res.Type == DescriptorType::UniformBufferDynamic ||
+                 Res.Type == DescriptorType::StorageBufferDynamic ||
+                 Res.Type == DescriptorType::StorageBufferDynamic_ReadOnly);
+            VERIFY(IsDynamicSlot == (res < NumDynamicSlots),
                    "All dynamic uniform and storage buffers are expected to go first in the beginning of each descriptor set");
         }
-#endif
     }
-    return OffsetInd - StartInd;
+#endif
+
+    return NumSlots;
 }
 
 } // namespace Diligent
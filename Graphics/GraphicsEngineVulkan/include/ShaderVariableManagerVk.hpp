@@ -89,7 +89,7 @@ public:
 
     void Destroy(IMemoryAllocator& Allocator);
 
-    ShaderVariableVkImpl* GetVariable(const Char* Name) const;
+    ShaderVariableVkImpl* GetVariable(SHADER_TYPE ShaderType, const Char* Name) const;
     ShaderVariableVkImpl* GetVariable(Uint32 Index) const;
 
     // Binds object pObj to resource with index ResIndex and array index ArrayIndex.
@@ -118,6 +118,11 @@ public:
 
     IObject& GetOwner() { return m_Owner; }
 
+    void SetInlineConstants(Uint32 ResIndex, const void* pConstants, Uint32 FirstConstant, Uint32 NumConstants)
+    {
+        m_ResourceCache.SetInlineConstants(ResIndex, pConstants, FirstConstant, NumConstants);
+    }
+
 private:
     friend TBase;
     friend ShaderVariableVkImpl;
@@ -30,12 +30,15 @@
 /// \file
 /// Declaration of Diligent::SwapChainVkImpl class
 
+#include <memory>
+
 #include "EngineVkImplTraits.hpp"
 #include "SwapChainVk.h"
 #include "SwapChainBase.hpp"
 #include "VulkanUtilities/VulkanInstance.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 #include "ManagedVulkanObject.hpp"
+#include "IndexWrapper.hpp"
 
 namespace Diligent
 {
@@ -67,15 +70,17 @@ public:
     /// Implementation of ISwapChain::SetWindowedMode() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE SetWindowedMode() override final;
 
+    /// Implementation of ISwapChain::SetMaximumFrameLatency() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE SetMaximumFrameLatency(Uint32 MaxLatency) override final;
+
+    /// Implementation of ISwapChain::WaitForFrame() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE WaitForFrame() override final;
+
     /// Implementation of ISwapChainVk::GetVkSwapChain().
     virtual VkSwapchainKHR DILIGENT_CALL_TYPE GetVkSwapChain() override final { return m_VkSwapChain; }
 
     /// Implementation of ISwapChain::GetCurrentBackBufferRTV() in Vulkan backend.
-    virtual ITextureViewVk* DILIGENT_CALL_TYPE GetCurrentBackBufferRTV() override final
-    {
-        VERIFY_EXPR(m_BackBufferIndex < m_SwapChainDesc.BufferCount);
-        return m_pBackBufferRTV[m_BackBufferIndex];
-    }
+    virtual ITextureViewVk* DILIGENT_CALL_TYPE GetCurrentBackBufferRTV() override final;
 
     /// Implementation of ISwapChain::GetDepthBufferDSV() in Vulkan backend.
     virtual ITextureViewVk* DILIGENT_CALL_TYPE GetDepthBufferDSV() override final { return m_pDepthBufferDSV; }
@@ -85,6 +90,10 @@ private:
     void     CreateVulkanSwapChain();
     void     InitBuffersAndViews();
     VkResult AcquireNextImage(DeviceContextVkImpl* pDeviceCtxVk);
+    VkResult AcquireNextVkImage();
+    void     InitAcquiredImage(DeviceContextVkImpl* pDeviceCtxVk);
+    VkResult QueuePresent(SoftwareQueueIndex CmdQueueId, Uint32 SemaphoreIndex);
+    void     WaitForPresentThread(DeviceContextVkImpl* pImmediateCtxVk);
     void     RecreateVulkanSwapchain(DeviceContextVkImpl* pImmediateCtxVk);
     void     WaitForImageAcquiredFences();
     void     ReleaseSwapChainResources(DeviceContextVkImpl* pImmediateCtxVk, bool DestroyVkSwapChain);
@@ -124,6 +133,17 @@ private:
     uint32_t m_BackBufferIndex = 0;
     bool     m_IsMinimized     = false;
     bool     m_VSyncEnabled    = true;
+
+    // The maximum number of frames queued for presentation in the low-latency mode.
+    Uint32 m_MaxFrameLatency = 0;
+
+    // The id of the last present operation, see VK_KHR_present_id.
+    // Only used in the low-latency mode when VK_KHR_present_wait is enabled.
+    Uint64 m_PresentId = 0;
+
+    // Executes the present and the acquire of the next image when SwapChainDesc::AsyncPresent is enabled.
+    class PresentThread;
+    std::unique_ptr<PresentThread> m_pPresentThread;
 };
 
 } // namespace Diligent
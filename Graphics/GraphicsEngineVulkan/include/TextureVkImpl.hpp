@@ -115,6 +115,9 @@ protected:
     VulkanUtilities::BufferWrapper          m_StagingBuffer;
     VulkanUtilities::VulkanMemoryAllocation m_MemoryAllocation;
     VkDeviceSize                            m_StagingDataAlignedOffset = 0;
+
+    // Device memory the texture is placed in, see TextureData::pMemory.
+    RefCntAutoPtr<IDeviceMemory> m_pMemory;
 };
 
 VkImageCreateInfo TextureDescToVkImageCreateInfo(const TextureDesc& Desc, const RenderDeviceVkImpl* pDevice) noexcept;
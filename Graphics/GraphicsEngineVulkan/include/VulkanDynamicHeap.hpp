@@ -28,6 +28,7 @@
 #pragma once
 
 #include <mutex>
+#include <memory>
 #include "VulkanUtilities/VulkanHeaders.h"
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
@@ -45,6 +46,7 @@ namespace Diligent
 class RenderDeviceVkImpl;
 class VulkanRingBuffer;
 class VulkanDynamicMemoryManager;
+struct DynamicHeapStatsVk;
 
 // sizeof(VulkanDynamicAllocation) must be at least 16 to avoid false cache line sharing problems
 struct VulkanDynamicAllocation
@@ -113,7 +115,10 @@ struct VulkanDynamicAllocation
 //  |_______________________________________________________________________|
 //
 // We cannot use global memory manager for dynamic resources because they
-// need to use the same Vulkan buffer
+// need to use the same Vulkan buffer.
+//
+// When EngineVkCreateInfo::DynamicHeapPageRing is enabled, the master blocks are instead allocated
+// from the lock-free page ring, see DynamicHeap::MasterBlockLockFreeRingManager.
 class VulkanDynamicMemoryManager : public DynamicHeap::MasterBlockListBasedManager
 {
 public:
@@ -124,7 +129,8 @@ public:
     VulkanDynamicMemoryManager(IMemoryAllocator&         Allocator,
                                class RenderDeviceVkImpl& DeviceVk,
                                Uint32                    Size,
-                               Uint64                    CommandQueueMask);
+                               Uint64                    CommandQueueMask,
+                               Uint32                    RingPageSize = 0);
     ~VulkanDynamicMemoryManager();
 
     // clang-format off
@@ -142,6 +148,25 @@ public:
     static constexpr const Uint32 MasterBlockAlignment = 1024;
     MasterBlock                   AllocateMasterBlock(OffsetType SizeInBytes, OffsetType Alignment);
 
+    void ReleaseMasterBlocks(std::vector<MasterBlock>& Blocks, RenderDeviceVkImpl& DeviceVk, Uint64 CmdQueueMask);
+
+    // Updates the per-frame high-water mark and finishes the frame of the page ring.
+    // Called once per frame by the immediate context.
+    void EndFrame();
+
+    // Reclaims the ring pages of the frames that have been completed by the GPU.
+    void ReleaseCompletedFrames(bool ForceRelease = false);
+
+    OffsetType GetSize() const;
+    OffsetType GetUsedSize() const;
+
+    void GetStats(DynamicHeapStatsVk& Stats);
+
+private:
+    MasterBlock AllocateMasterBlockInternal(OffsetType SizeInBytes, OffsetType Alignment);
+
+    void UpdatePeakSize();
+
 private:
     RenderDeviceVkImpl&                  m_DeviceVk;
     VulkanUtilities::BufferWrapper       m_VkBuffer;
@@ -149,7 +174,15 @@ private:
     Uint8*                               m_CPUAddress;
     const VkDeviceSize                   m_DefaultAlignment;
     const Uint64                         m_CommandQueueMask;
-    OffsetType                           m_TotalPeakSize = 0;
+
+    std::unique_ptr<DynamicHeap::MasterBlockLockFreeRingManager> m_pPageRing;
+
+    std::mutex m_StatsMtx;
+    OffsetType m_TotalPeakSize         = 0;
+    OffsetType m_FramePeakSize         = 0;
+    OffsetType m_LastFramePeakSize     = 0;
+    Uint32     m_StallCount            = 0;
+    Uint32     m_FailedAllocationCount = 0;
 };
 
 
@@ -212,6 +245,7 @@ public:
     static constexpr OffsetType InvalidOffset = static_cast<OffsetType>(-1);
 
     size_t GetAllocatedMasterBlockCount() const { return m_MasterBlocks.size(); }
+    Uint32 GetCurrUsedSize() const { return m_CurrUsedSize; }
 
 private:
     VulkanDynamicMemoryManager& m_GlobalDynamicMemMgr;
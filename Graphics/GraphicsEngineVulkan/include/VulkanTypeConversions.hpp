@@ -44,6 +44,7 @@ TEXTURE_FORMAT VkFormatToTexFormat(VkFormat VkFmt);
 VkFormat    TypeToVkFormat(VALUE_TYPE ValType, Uint32 NumComponents, Bool bIsNormalized);
 VkIndexType TypeToVkIndexType(VALUE_TYPE IndexType);
 
+VkCullModeFlagBits                     CullModeToVkCullMode(CULL_MODE CullMode);
 VkPipelineRasterizationStateCreateInfo RasterizerStateDesc_To_VkRasterizationStateCI(const struct RasterizerStateDesc& RasterizerDesc);
 VkPipelineDepthStencilStateCreateInfo  DepthStencilStateDesc_To_VkDepthStencilStateCI(const struct DepthStencilStateDesc& DepthStencilDesc);
 
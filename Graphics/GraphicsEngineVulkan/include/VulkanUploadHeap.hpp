@@ -27,7 +27,13 @@
 
 #pragma once
 
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
+
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 
@@ -38,7 +44,11 @@ namespace Diligent
 // UpdateBufferRegion() and UpdateTextureRegion().
 //
 // The heap allocates pages from the global memory manager.
-// The pages are released and returned to the manager at the end of every frame.
+// The pages are released at the end of every frame. Once the GPU is done with a page, the release queue
+// puts it into the page cache, from where the heap takes it in the next frames instead of allocating a new one.
+// Pages of allocations that are larger than half of the page size are rounded up to a power-of-two multiple
+// of the page size, so that they can be reused as well. The cache is trimmed to the maximum size
+// allocated by the heap in the last HighWaterMarkFrames frames; excess pages are returned to the memory manager.
 //
 //   _______________________________________________________________________________________________________________________________
 //  |                                                                                                                               |
@@ -49,10 +59,16 @@ namespace Diligent
 //  |__________|____________________________________________________________________________________________________________________|
 //             |                                      A                   |
 //             |                                      |                   |
-//             |Allocate()             CreateNewPage()|                   |ReleaseAllocatedPages()
+//             |Allocate()               AcquirePage()|                   |ReleaseAllocatedPages()
 //             |                                ______|___________________V____
 //             V                               |                              |
-//   VulkanUploadAllocation                    |    Global Memory Manager     |
+//   VulkanUploadAllocation                    |          Page cache          |<-- Release queue
+//                                             |______________________________|
+//                                                    A                   |
+//                                     CreateNewPage()|                   |Trim
+//                                              ______|___________________V____
+//                                             |                              |
+//                                             |    Global Memory Manager     |
 //                                             |    (VulkanMemoryManager)     |
 //                                             |                              |
 //                                             |______________________________|
@@ -102,16 +118,27 @@ public:
 
     VulkanUploadAllocation Allocate(VkDeviceSize SizeInBytes, VkDeviceSize Alignment);
 
-    // Releases all allocated pages that are later returned to the global memory manager by the release queues.
+    // Releases all allocated pages that are later returned to the page cache by the release queues.
     // As global memory manager is hosted by the render device, the upload heap can be destroyed before the
-    // pages are actually returned to the manager.
+    // pages are actually returned to the cache. In this case, the pages are returned to the manager.
     void ReleaseAllocatedPages(Uint64 CmdQueueMask);
 
+    // The number of frames whose allocated size defines the maximum size of the page cache.
+    static constexpr size_t HighWaterMarkFrames = 64;
+
     size_t GetStalePagesCount() const
     {
         return m_Pages.size();
     }
 
+    VkDeviceSize GetCurrFrameSize() const
+    {
+        return m_CurrFrameSize;
+    }
+
+    // Returns the total size of the pages in the cache.
+    VkDeviceSize GetCachedSize() const;
+
 private:
     RenderDeviceVkImpl& m_RenderDevice;
     std::string         m_HeapName;
@@ -122,10 +149,12 @@ private:
         // clang-format off
         UploadPageInfo(VulkanUtilities::VulkanMemoryAllocation&& _MemAllocation,
                        VulkanUtilities::BufferWrapper&&          _Buffer,
-                       Uint8*                                    _CPUAddress) :
+                       Uint8*                                    _CPUAddress,
+                       VkDeviceSize                              _Size) :
             MemAllocation{std::move(_MemAllocation)},
             Buffer       {std::move(_Buffer)       },
-            CPUAddress   {_CPUAddress              }
+            CPUAddress   {_CPUAddress              },
+            Size         {_Size                    }
         {
         }
         // clang-format on
@@ -133,9 +162,32 @@ private:
         VulkanUtilities::VulkanMemoryAllocation MemAllocation;
         VulkanUtilities::BufferWrapper          Buffer;
         Uint8* const                            CPUAddress = nullptr;
+        const VkDeviceSize                      Size       = 0; // Buffer size, which is the page size class
     };
     std::vector<UploadPageInfo> m_Pages;
 
+    // Pages that are no longer used by the GPU, sorted by size.
+    // The cache is shared with the stale pages in the release queues that may outlive the heap.
+    struct PageCache
+    {
+        std::mutex Mtx;
+
+        std::map<VkDeviceSize, std::vector<UploadPageInfo>> Pages;
+
+        VkDeviceSize TotalSize = 0;
+        VkDeviceSize MaxSize   = 0;
+
+        void Add(UploadPageInfo&& Page);
+        // Returns an empty page if there are no cached pages of the given size.
+        UploadPageInfo Get(VkDeviceSize Size);
+        // Returns the largest pages to the memory manager until the total size fits into MaxSize.
+        void Trim();
+    };
+    std::shared_ptr<PageCache> m_pPageCache;
+
+    // Page that has been released by the heap and waits in the release queues until the GPU is done with it.
+    class StalePage;
+
     struct CurrPageInfo
     {
         VkBuffer     vkBuffer       = VK_NULL_HANDLE;
@@ -164,7 +216,15 @@ private:
     VkDeviceSize m_CurrAllocatedSize = 0;
     VkDeviceSize m_PeakAllocatedSize = 0;
 
+    // Allocated sizes of the last HighWaterMarkFrames frames.
+    std::array<VkDeviceSize, HighWaterMarkFrames> m_FrameAllocatedSizes = {};
+
+    size_t m_FrameIndex     = 0;
+    Uint64 m_NumNewPages    = 0;
+    Uint64 m_NumReusedPages = 0;
+
     UploadPageInfo CreateNewPage(VkDeviceSize SizeInBytes) const;
+    UploadPageInfo AcquirePage(VkDeviceSize SizeInBytes);
 };
 
 } // namespace Diligent
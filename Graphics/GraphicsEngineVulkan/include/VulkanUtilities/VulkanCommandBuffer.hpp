@@ -28,6 +28,7 @@
 #pragma once
 
 #include <vector>
+#include <utility>
 #include "VulkanHeaders.h"
 #include "DebugUtilities.hpp"
 
@@ -51,7 +52,7 @@ public:
                                        const VkImageSubresourceRange& Subresource)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdClearColorImage() must be called outside of render pass (17.1)");
+        VERIFY(!m_State.InsideRenderPass(), "vkCmdClearColorImage() must be called outside of render pass (17.1)");
         VERIFY(Subresource.aspectMask == VK_IMAGE_ASPECT_COLOR_BIT, "The aspectMask of all image subresource ranges must only include VK_IMAGE_ASPECT_COLOR_BIT (17.1)");
 
         FlushBarriers();
@@ -69,7 +70,7 @@ public:
                                               const VkImageSubresourceRange&  Subresource)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdClearDepthStencilImage() must be called outside of render pass (17.1)");
+        VERIFY(!m_State.InsideRenderPass(), "vkCmdClearDepthStencilImage() must be called outside of render pass (17.1)");
         // clang-format off
         VERIFY((Subresource.aspectMask &  (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) != 0 &&
                (Subresource.aspectMask & ~(VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) == 0,
@@ -89,7 +90,7 @@ public:
     __forceinline void ClearAttachment(const VkClearAttachment& Attachment, const VkClearRect& ClearRect)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdClearAttachments() must be called inside render pass (17.2)");
+        VERIFY(m_State.InsideRenderPass(), "vkCmdClearAttachments() must be called inside render pass (17.2)");
 
         vkCmdClearAttachments(
             m_VkCmdBuffer,
@@ -104,7 +105,7 @@ public:
     __forceinline void Draw(uint32_t VertexCount, uint32_t InstanceCount, uint32_t FirstVertex, uint32_t FirstInstance)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDraw() must be called inside render pass (19.3)");
+        VERIFY(m_State.InsideRenderPass(), "vkCmdDraw() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDraw(m_VkCmdBuffer, VertexCount, InstanceCount, FirstVertex, FirstInstance);
@@ -113,17 +114,45 @@ public:
     __forceinline void DrawIndexed(uint32_t IndexCount, uint32_t InstanceCount, uint32_t FirstIndex, int32_t VertexOffset, uint32_t FirstInstance)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndexed() must be called inside render pass (19.3)");
+        VERIFY(m_State.InsideRenderPass(), "vkCmdDrawIndexed() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
         VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
 
         vkCmdDrawIndexed(m_VkCmdBuffer, IndexCount, InstanceCount, FirstIndex, VertexOffset, FirstInstance);
     }
 
+    __forceinline void DrawMulti(uint32_t DrawCount, const VkMultiDrawInfoEXT* pVertexInfo, uint32_t InstanceCount, uint32_t FirstInstance)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(m_State.InsideRenderPass(), "vkCmdDrawMultiEXT() must be called inside render pass");
+        VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
+
+        vkCmdDrawMultiEXT(m_VkCmdBuffer, DrawCount, pVertexInfo, InstanceCount, FirstInstance, sizeof(VkMultiDrawInfoEXT));
+#else
+        UNSUPPORTED("DrawMulti is not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void DrawMultiIndexed(uint32_t DrawCount, const VkMultiDrawIndexedInfoEXT* pIndexInfo, uint32_t InstanceCount, uint32_t FirstInstance)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(m_State.InsideRenderPass(), "vkCmdDrawMultiIndexedEXT() must be called inside render pass");
+        VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
+        VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
+
+        // Vertex offsets are read from pIndexInfo when pVertexOffset is null
+        vkCmdDrawMultiIndexedEXT(m_VkCmdBuffer, DrawCount, pIndexInfo, InstanceCount, FirstInstance, sizeof(VkMultiDrawIndexedInfoEXT), nullptr);
+#else
+        UNSUPPORTED("DrawMultiIndexed is not supported when vulkan library is linked statically");
+#endif
+    }
+
     __forceinline void DrawIndirect(VkBuffer Buffer, VkDeviceSize Offset, uint32_t DrawCount, uint32_t Stride)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndirect() must be called inside render pass (19.3)");
+        VERIFY(m_State.InsideRenderPass(), "vkCmdDrawIndirect() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawIndirect(m_VkCmdBuffer, Buffer, Offset, DrawCount, Stride);
@@ -132,7 +161,7 @@ public:
     __forceinline void DrawIndexedIndirect(VkBuffer Buffer, VkDeviceSize Offset, uint32_t DrawCount, uint32_t Stride)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndirect() must be called inside render pass (19.3)");
+        VERIFY(m_State.InsideRenderPass(), "vkCmdDrawIndirect() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
         VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
 
@@ -143,7 +172,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndirectCountKHR() must be called inside render pass (19.3)");
+        VERIFY(m_State.InsideRenderPass(), "vkCmdDrawIndirectCountKHR() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawIndirectCountKHR(m_VkCmdBuffer, Buffer, Offset, CountBuffer, CountBufferOffset, MaxDrawCount, Stride);
@@ -156,7 +185,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndirect() must be called inside render pass (19.3)");
+        VERIFY(m_State.InsideRenderPass(), "vkCmdDrawIndirect() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
         VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
 
@@ -170,7 +199,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawMeshTasksNV() must be called inside render pass");
+        VERIFY(m_State.InsideRenderPass(), "vkCmdDrawMeshTasksNV() must be called inside render pass");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawMeshTasksNV(m_VkCmdBuffer, TaskCount, FirstTask);
@@ -183,7 +212,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawMeshTasksNV() must be called inside render pass");
+        VERIFY(m_State.InsideRenderPass(), "vkCmdDrawMeshTasksNV() must be called inside render pass");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawMeshTasksIndirectNV(m_VkCmdBuffer, Buffer, Offset, DrawCount, Stride);
@@ -196,7 +225,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawMeshTasksIndirectCountNV() must be called inside render pass");
+        VERIFY(m_State.InsideRenderPass(), "vkCmdDrawMeshTasksIndirectCountNV() must be called inside render pass");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawMeshTasksIndirectCountNV(m_VkCmdBuffer, Buffer, Offset, CountBuffer, CountBufferOffset, MaxDrawCount, Stride);
@@ -208,7 +237,7 @@ public:
     __forceinline void Dispatch(uint32_t GroupCountX, uint32_t GroupCountY, uint32_t GroupCountZ)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdDispatch() must be called outside of render pass (27)");
+        VERIFY(!m_State.InsideRenderPass(), "vkCmdDispatch() must be called outside of render pass (27)");
         VERIFY(m_State.ComputePipeline != VK_NULL_HANDLE, "No compute pipeline bound");
 
         FlushBarriers();
@@ -218,7 +247,7 @@ public:
     __forceinline void DispatchIndirect(VkBuffer Buffer, VkDeviceSize Offset)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdDispatchIndirect() must be called outside of render pass (27)");
+        VERIFY(!m_State.InsideRenderPass(), "vkCmdDispatchIndirect() must be called outside of render pass (27)");
         VERIFY(m_State.ComputePipeline != VK_NULL_HANDLE, "No compute pipeline bound");
 
         FlushBarriers();
@@ -230,10 +259,11 @@ public:
                                        uint32_t            FramebufferWidth,
                                        uint32_t            FramebufferHeight,
                                        uint32_t            ClearValueCount = 0,
-                                       const VkClearValue* pClearValues    = nullptr)
+                                       const VkClearValue* pClearValues    = nullptr,
+                                       VkSubpassContents   Contents        = VK_SUBPASS_CONTENTS_INLINE)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Current pass has not been ended");
+        VERIFY(!m_State.InsideRenderPass(), "Current pass has not been ended");
 
         if (m_State.RenderPass != RenderPass || m_State.Framebuffer != Framebuffer)
         {
@@ -254,11 +284,12 @@ public:
                                                       // corresponding to cleared attachments are used. Other elements of pClearValues are
                                                       // ignored (7.4)
 
-            vkCmdBeginRenderPass(m_VkCmdBuffer, &BeginInfo,
-                                 VK_SUBPASS_CONTENTS_INLINE // the contents of the subpass will be recorded inline in the
-                                                            // primary command buffer, and secondary command buffers must not
-                                                            // be executed within the subpass
-            );
+            // VK_SUBPASS_CONTENTS_INLINE - the contents of the subpass will be recorded inline in the primary
+            //                              command buffer, and secondary command buffers must not be executed
+            //                              within the subpass.
+            // VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS - the contents are recorded in secondary command
+            //                              buffers, and vkCmdExecuteCommands is the only valid command in the subpass.
+            vkCmdBeginRenderPass(m_VkCmdBuffer, &BeginInfo, Contents);
             m_State.RenderPass        = RenderPass;
             m_State.Framebuffer       = Framebuffer;
             m_State.FramebufferWidth  = FramebufferWidth;
@@ -266,11 +297,42 @@ public:
         }
     }
 
+    // Begins a dynamic render pass instance (VK_KHR_dynamic_rendering).
+    // The instance is ended by EndRenderPass().
+    __forceinline void BeginRendering(const VkRenderingInfoKHR& RenderingInfo)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(!m_State.InsideRenderPass(), "Current pass has not been ended");
+
+        FlushBarriers();
+        vkCmdBeginRenderingKHR(m_VkCmdBuffer, &RenderingInfo);
+        m_State.DynamicRendering  = true;
+        m_State.FramebufferWidth  = RenderingInfo.renderArea.extent.width;
+        m_State.FramebufferHeight = RenderingInfo.renderArea.extent.height;
+#else
+        UNSUPPORTED("Dynamic rendering is not supported when vulkan library is linked statically");
+#endif
+    }
+
+    // Ends the render pass instance begun by either BeginRenderPass() or BeginRendering().
     __forceinline void EndRenderPass()
     {
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "Render pass has not been started");
+        VERIFY(m_State.InsideRenderPass(), "Render pass has not been started");
+        VERIFY(!m_State.IsSecondary, "Render pass inherited by a secondary command buffer can't be ended. "
+                                     "This may happen if a resource state transition is recorded into the secondary command buffer.");
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        vkCmdEndRenderPass(m_VkCmdBuffer);
+        if (m_State.DynamicRendering)
+        {
+#if DILIGENT_USE_VOLK
+            vkCmdEndRenderingKHR(m_VkCmdBuffer);
+#endif
+            m_State.DynamicRendering = false;
+        }
+        else
+        {
+            vkCmdEndRenderPass(m_VkCmdBuffer);
+        }
         m_State.RenderPass        = VK_NULL_HANDLE;
         m_State.Framebuffer       = VK_NULL_HANDLE;
         m_State.FramebufferWidth  = 0;
@@ -284,17 +346,50 @@ public:
         }
     }
 
-    __forceinline void NextSubpass()
+    __forceinline void NextSubpass(VkSubpassContents Contents = VK_SUBPASS_CONTENTS_INLINE)
     {
         VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "Render pass has not been started");
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        vkCmdNextSubpass(m_VkCmdBuffer, VK_SUBPASS_CONTENTS_INLINE);
+        vkCmdNextSubpass(m_VkCmdBuffer, Contents);
+    }
+
+    // Marks the render pass instance that the secondary command buffer was begun with
+    // as active to let draw commands be recorded without beginning a render pass.
+    __forceinline void SetInheritedRenderPass(VkRenderPass  RenderPass,
+                                              VkFramebuffer Framebuffer,
+                                              uint32_t      FramebufferWidth,
+                                              uint32_t      FramebufferHeight)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(!m_State.InsideRenderPass(), "Current pass has not been ended");
+        m_State.RenderPass        = RenderPass;
+        m_State.Framebuffer       = Framebuffer;
+        m_State.FramebufferWidth  = FramebufferWidth;
+        m_State.FramebufferHeight = FramebufferHeight;
+        m_State.IsSecondary       = true;
+    }
+
+    __forceinline void ExecuteCommands(uint32_t CommandBufferCount, const VkCommandBuffer* pCommandBuffers)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "Secondary command buffers can only be executed inside a render pass");
+        FlushBarriers();
+        vkCmdExecuteCommands(m_VkCmdBuffer, CommandBufferCount, pCommandBuffers);
+
+        // The pipeline, the index buffer and all dynamic states become undefined after
+        // the secondary command buffers have been executed.
+        m_State.GraphicsPipeline   = VK_NULL_HANDLE;
+        m_State.ComputePipeline    = VK_NULL_HANDLE;
+        m_State.RayTracingPipeline = VK_NULL_HANDLE;
+        m_State.IndexBuffer        = VK_NULL_HANDLE;
+        m_State.IndexBufferOffset  = 0;
+        m_State.IndexType          = VK_INDEX_TYPE_MAX_ENUM;
     }
 
     __forceinline void EndCommandBuffer()
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Render pass has not been ended");
+        VERIFY(!m_State.InsideRenderPass(), "Render pass has not been ended");
         FlushBarriers();
         vkEndCommandBuffer(m_VkCmdBuffer);
     }
@@ -364,6 +459,57 @@ public:
         vkCmdSetBlendConstants(m_VkCmdBuffer, BlendConstants);
     }
 
+    // Extended dynamic state setters (VK_EXT_extended_dynamic_state).
+    __forceinline void SetCullMode(VkCullModeFlags CullMode)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdSetCullModeEXT(m_VkCmdBuffer, CullMode);
+#else
+        UNSUPPORTED("Extended dynamic state is not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void SetDepthState(VkBool32 DepthTestEnable, VkBool32 DepthWriteEnable, VkCompareOp DepthCompareOp)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdSetDepthTestEnableEXT(m_VkCmdBuffer, DepthTestEnable);
+        vkCmdSetDepthWriteEnableEXT(m_VkCmdBuffer, DepthWriteEnable);
+        vkCmdSetDepthCompareOpEXT(m_VkCmdBuffer, DepthCompareOp);
+#else
+        UNSUPPORTED("Extended dynamic state is not supported when vulkan library is linked statically");
+#endif
+    }
+
+    // Sets stencil test enable, stencil operations and stencil masks of both faces.
+    // The reference value in the face states is ignored, see SetStencilReference().
+    __forceinline void SetStencilState(VkBool32 StencilTestEnable, const VkStencilOpState& Front, const VkStencilOpState& Back)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdSetStencilTestEnableEXT(m_VkCmdBuffer, StencilTestEnable);
+        vkCmdSetStencilOpEXT(m_VkCmdBuffer, VK_STENCIL_FACE_FRONT_BIT, Front.failOp, Front.passOp, Front.depthFailOp, Front.compareOp);
+        vkCmdSetStencilOpEXT(m_VkCmdBuffer, VK_STENCIL_FACE_BACK_BIT, Back.failOp, Back.passOp, Back.depthFailOp, Back.compareOp);
+        vkCmdSetStencilCompareMask(m_VkCmdBuffer, VK_STENCIL_FACE_FRONT_BIT, Front.compareMask);
+        vkCmdSetStencilCompareMask(m_VkCmdBuffer, VK_STENCIL_FACE_BACK_BIT, Back.compareMask);
+        vkCmdSetStencilWriteMask(m_VkCmdBuffer, VK_STENCIL_FACE_FRONT_BIT, Front.writeMask);
+        vkCmdSetStencilWriteMask(m_VkCmdBuffer, VK_STENCIL_FACE_BACK_BIT, Back.writeMask);
+#else
+        UNSUPPORTED("Extended dynamic state is not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void SetPrimitiveTopology(VkPrimitiveTopology Topology)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdSetPrimitiveTopologyEXT(m_VkCmdBuffer, Topology);
+#else
+        UNSUPPORTED("Extended dynamic state is not supported when vulkan library is linked statically");
+#endif
+    }
+
     __forceinline void BindIndexBuffer(VkBuffer Buffer, VkDeviceSize Offset, VkIndexType IndexType)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
@@ -416,7 +562,7 @@ public:
                                   const VkBufferCopy* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (m_State.InsideRenderPass())
         {
             // Copy buffer operation must be performed outside of render pass.
             EndRenderPass();
@@ -433,7 +579,7 @@ public:
                                  const VkImageCopy* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (m_State.InsideRenderPass())
         {
             // Copy operations must be performed outside of render pass.
             EndRenderPass();
@@ -449,7 +595,7 @@ public:
                                          const VkBufferImageCopy* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (m_State.InsideRenderPass())
         {
             // Copy operations must be performed outside of render pass.
             EndRenderPass();
@@ -465,7 +611,7 @@ public:
                                          const VkBufferImageCopy* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (m_State.InsideRenderPass())
         {
             // Copy operations must be performed outside of render pass.
             EndRenderPass();
@@ -483,7 +629,7 @@ public:
                                  VkFilter           filter)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (m_State.InsideRenderPass())
         {
             // Blit must be performed outside of render pass.
             EndRenderPass();
@@ -500,7 +646,7 @@ public:
                                     const VkImageResolve* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (m_State.InsideRenderPass())
         {
             // Resolve must be performed outside of render pass.
             EndRenderPass();
@@ -530,7 +676,7 @@ public:
 
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         vkCmdBeginQuery(m_VkCmdBuffer, queryPool, query, flags);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (m_State.InsideRenderPass())
             m_State.InsidePassQueries |= queryFlag;
         else
             m_State.OutsidePassQueries |= queryFlag;
@@ -542,7 +688,7 @@ public:
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         vkCmdEndQuery(m_VkCmdBuffer, queryPool, query);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (m_State.InsideRenderPass())
         {
             VERIFY((m_State.InsidePassQueries & queryFlag) != 0, "No active inside-pass queries found.");
             m_State.InsidePassQueries &= ~queryFlag;
@@ -567,7 +713,7 @@ public:
                                       uint32_t    queryCount)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (m_State.InsideRenderPass())
         {
             // Query pool reset must be performed outside of render pass (17.2).
             EndRenderPass();
@@ -585,7 +731,7 @@ public:
                                             VkQueryResultFlags flags)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (m_State.InsideRenderPass())
         {
             // Copy query results must be performed outside of render pass (17.2).
             EndRenderPass();
@@ -595,13 +741,57 @@ public:
                                   dstBuffer, dstOffset, stride, flags);
     }
 
+    // Begins conditional rendering (VK_EXT_conditional_rendering).
+    // The 32-bit predicate is read from the buffer at the given offset.
+    __forceinline void BeginConditionalRendering(VkBuffer                       buffer,
+                                                 VkDeviceSize                   offset,
+                                                 VkConditionalRenderingFlagsEXT flags)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(!m_State.ConditionalRendering, "Conditional rendering is already active");
+        if (m_State.InsideRenderPass())
+        {
+            // Conditional rendering that is begun outside of a render pass instance
+            // must also be ended outside of it, which allows it to span several passes.
+            EndRenderPass();
+        }
+        FlushBarriers();
+
+        VkConditionalRenderingBeginInfoEXT BeginInfo{};
+        BeginInfo.sType  = VK_STRUCTURE_TYPE_CONDITIONAL_RENDERING_BEGIN_INFO_EXT;
+        BeginInfo.buffer = buffer;
+        BeginInfo.offset = offset;
+        BeginInfo.flags  = flags;
+        vkCmdBeginConditionalRenderingEXT(m_VkCmdBuffer, &BeginInfo);
+        m_State.ConditionalRendering = true;
+#else
+        UNSUPPORTED("Conditional rendering is not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void EndConditionalRendering()
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(m_State.ConditionalRendering, "Conditional rendering is not active");
+        if (m_State.InsideRenderPass())
+            EndRenderPass();
+
+        vkCmdEndConditionalRenderingEXT(m_VkCmdBuffer);
+        m_State.ConditionalRendering = false;
+#else
+        UNSUPPORTED("Conditional rendering is not supported when vulkan library is linked statically");
+#endif
+    }
+
     __forceinline void BuildAccelerationStructure(uint32_t                                               infoCount,
                                                   const VkAccelerationStructureBuildGeometryInfoKHR*     pInfos,
                                                   const VkAccelerationStructureBuildRangeInfoKHR* const* ppBuildRangeInfos)
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (m_State.InsideRenderPass())
         {
             // Build AS operations must be performed outside of render pass.
             EndRenderPass();
@@ -617,7 +807,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (m_State.InsideRenderPass())
         {
             // Copy AS operations must be performed outside of render pass.
             EndRenderPass();
@@ -629,17 +819,21 @@ public:
 #endif
     }
 
-    __forceinline void WriteAccelerationStructuresProperties(VkAccelerationStructureKHR accelerationStructure, VkQueryType queryType, VkQueryPool queryPool, uint32_t firstQuery)
+    __forceinline void WriteAccelerationStructuresProperties(uint32_t                          accelerationStructureCount,
+                                                             const VkAccelerationStructureKHR* pAccelerationStructures,
+                                                             VkQueryType                       queryType,
+                                                             VkQueryPool                       queryPool,
+                                                             uint32_t                          firstQuery)
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (m_State.InsideRenderPass())
         {
             // Write AS properties operations must be performed outside of render pass.
             EndRenderPass();
         }
         FlushBarriers();
-        vkCmdWriteAccelerationStructuresPropertiesKHR(m_VkCmdBuffer, 1, &accelerationStructure, queryType, queryPool, firstQuery);
+        vkCmdWriteAccelerationStructuresPropertiesKHR(m_VkCmdBuffer, accelerationStructureCount, pAccelerationStructures, queryType, queryPool, firstQuery);
 #else
         UNSUPPORTED("Ray tracing is not supported when vulkan library is linked statically");
 #endif
@@ -656,7 +850,7 @@ public:
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         VERIFY(m_State.RayTracingPipeline != VK_NULL_HANDLE, "No ray tracing pipeline bound");
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (m_State.InsideRenderPass())
         {
             EndRenderPass();
         }
@@ -676,7 +870,7 @@ public:
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         VERIFY(m_State.RayTracingPipeline != VK_NULL_HANDLE, "No ray tracing pipeline bound");
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (m_State.InsideRenderPass())
         {
             EndRenderPass();
         }
@@ -740,6 +934,9 @@ public:
 
     void FlushBarriers();
 
+    // Returns the number of barriers issued since the last call and resets the counter.
+    Uint32 ExtractBarrierCount() { return std::exchange(m_BarrierCount, 0u); }
+
     __forceinline void SetVkCmdBuffer(VkCommandBuffer VkCmdBuffer, VkPipelineStageFlags StageMask, VkAccessFlags AccessMask)
     {
         m_VkCmdBuffer                 = VkCmdBuffer;
@@ -765,6 +962,24 @@ public:
         uint32_t      FramebufferHeight  = 0;
         uint32_t      InsidePassQueries  = 0;
         uint32_t      OutsidePassQueries = 0;
+
+        // Whether this is a secondary command buffer that continues
+        // the render pass begun in a primary command buffer.
+        bool IsSecondary = false;
+
+        // Whether a dynamic render pass instance begun by BeginRendering() is active.
+        // RenderPass and Framebuffer are null in this case.
+        bool DynamicRendering = false;
+
+        // Whether conditional rendering begun by BeginConditionalRendering() is active.
+        bool ConditionalRendering = false;
+
+        // Returns true if a render pass instance is active, either a render pass
+        // or a dynamic render pass instance.
+        bool InsideRenderPass() const
+        {
+            return RenderPass != VK_NULL_HANDLE || DynamicRendering;
+        }
     };
 
     const StateCache& GetState() const { return m_State; }
@@ -789,6 +1004,9 @@ private:
     PipelineBarrier m_Barrier;
 
     std::vector<VkImageMemoryBarrier> m_ImageBarriers;
+
+    // The number of memory and image barriers issued by FlushBarriers(), see ExtractBarrierCount().
+    Uint32 m_BarrierCount = 0;
 };
 
 } // namespace VulkanUtilities
@@ -27,17 +27,29 @@
 
 #pragma once
 
-#include <deque>
+#include <vector>
 #include <memory>
 #include <mutex>
 #include <atomic>
+#include <unordered_map>
 #include "VulkanHeaders.h"
 #include "VulkanLogicalDevice.hpp"
 #include "VulkanObjectWrappers.hpp"
+#include "LockFreeQueue.hpp"
+#include "AdaptiveLock.hpp"
 
 namespace VulkanUtilities
 {
 
+// Command buffer pool owned by a single device context.
+//
+// Command buffers are allocated from a ring of Vulkan command pools. Every pool hands out up to
+// CmdBuffersPerPool command buffers, after which the next pool whose command buffers have all
+// been returned is reset as a whole with vkResetCommandPool, or a new pool is created.
+//
+// GetCommandBuffer() must only be called by the owning context and takes no locks.
+// RecycleCommandBuffer() may be called from any thread (typically by release queues)
+// and pushes the command buffer to a lock-free queue that is drained by GetCommandBuffer().
 class VulkanCommandBufferPool
 {
 public:
@@ -54,9 +66,17 @@ public:
 
     ~VulkanCommandBufferPool();
 
-    VkCommandBuffer GetCommandBuffer(const char* DebugName = "");
-    // The GPU must have finished with the command buffer being returned to the pool
-    void RecycleCommandBuffer(VkCommandBuffer&& CmdBuffer);
+    // If pInheritanceInfo is not null, returns a secondary command buffer that continues
+    // the render pass specified by the inheritance info.
+    // If SimultaneousUse is true, the command buffer is begun with VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT
+    // and may be submitted multiple times, otherwise it is begun with VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT.
+    VkCommandBuffer GetCommandBuffer(const char*                           DebugName        = "",
+                                     const VkCommandBufferInheritanceInfo* pInheritanceInfo = nullptr,
+                                     bool                                  SimultaneousUse  = false);
+    // The GPU must have finished with the command buffer being returned to the pool.
+    // This method is thread-safe. The command buffer level is tracked by the pool,
+    // so IsSecondary is not required.
+    void RecycleCommandBuffer(VkCommandBuffer&& CmdBuffer, bool IsSecondary = false);
 
     VkPipelineStageFlags GetSupportedStagesMask() const { return m_SupportedStagesMask; }
     VkAccessFlags        GetSupportedAccessMask() const { return m_SupportedAccessMask; }
@@ -65,12 +85,48 @@ private:
     // Shared point to logical device must be defined before the command pool
     std::shared_ptr<const VulkanLogicalDevice> m_LogicalDevice;
 
-    CommandPoolWrapper m_CmdPool;
+    static constexpr uint32_t CmdBuffersPerPool           = 8;
+    static constexpr size_t   ReturnedCmdBuffersQueueSize = 1024;
 
-    std::mutex                  m_Mutex;
-    std::deque<VkCommandBuffer> m_CmdBuffers;
-    const VkPipelineStageFlags  m_SupportedStagesMask;
-    const VkAccessFlags         m_SupportedAccessMask;
+    struct CmdPoolInfo
+    {
+        CommandPoolWrapper CmdPool;
+
+        // All command buffers allocated from the pool, indexed by IsSecondary.
+        // The first NumUsed[i] buffers have been handed out since the pool was last reset.
+        std::vector<VkCommandBuffer> CmdBuffers[2];
+        uint32_t                     NumUsed[2] = {};
+
+        // The number of command buffers that have been handed out and not yet returned
+        uint32_t NumActive = 0;
+
+        uint32_t GetNumUsed() const { return NumUsed[0] + NumUsed[1]; }
+    };
+
+    // Moves the command buffers returned by RecycleCommandBuffer() back to their pools.
+    void ProcessReturnedCmdBuffers();
+
+    // Makes sure that the current pool can hand out another command buffer.
+    CmdPoolInfo& GetCurrentPool();
+
+    const HardwareQueueIndex       m_QueueFamilyIndex;
+    const VkCommandPoolCreateFlags m_CmdPoolFlags;
+
+    // The following members are only accessed by the owning context
+    std::vector<std::unique_ptr<CmdPoolInfo>>   m_CmdPools;
+    size_t                                      m_CurrPoolIdx = 0;
+    std::unordered_map<VkCommandBuffer, size_t> m_CmdBufferToPoolIdx;
+
+    // Command buffers returned from any thread
+    Threading::LockFreeQueue<VkCommandBuffer> m_ReturnedCmdBuffers{ReturnedCmdBuffersQueueSize};
+
+    // Command buffers that did not fit into the queue
+    Threading::EngineMutex       m_OverflowMtx;
+    std::vector<VkCommandBuffer> m_OverflowCmdBuffers;
+    std::atomic<bool>            m_HasOverflowCmdBuffers{false};
+
+    const VkPipelineStageFlags m_SupportedStagesMask;
+    const VkAccessFlags        m_SupportedAccessMask;
 
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic<int32_t> m_BuffCounter{0};
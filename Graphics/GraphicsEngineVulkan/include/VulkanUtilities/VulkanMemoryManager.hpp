@@ -45,6 +45,17 @@ namespace VulkanUtilities
 class VulkanMemoryPage;
 class VulkanMemoryManager;
 
+// Describes the resource the memory is allocated for.
+// A dedicated allocation is bound to exactly one buffer or image (VK_KHR_dedicated_allocation).
+struct VulkanDedicatedAllocationInfo
+{
+    VkBuffer vkBuffer = VK_NULL_HANDLE;
+    VkImage  vkImage  = VK_NULL_HANDLE;
+
+    // The driver prefers or requires a dedicated allocation for this resource
+    bool Preferred = false;
+};
+
 struct VulkanMemoryAllocation
 {
     VulkanMemoryAllocation() noexcept {}
@@ -95,11 +106,12 @@ struct VulkanMemoryAllocation
 class VulkanMemoryPage
 {
 public:
-    VulkanMemoryPage(VulkanMemoryManager&  ParentMemoryMgr,
-                     VkDeviceSize          PageSize,
-                     uint32_t              MemoryTypeIndex,
-                     bool                  IsHostVisible,
-                     VkMemoryAllocateFlags AllocateFlags);
+    VulkanMemoryPage(VulkanMemoryManager&                 ParentMemoryMgr,
+                     VkDeviceSize                         PageSize,
+                     uint32_t                             MemoryTypeIndex,
+                     bool                                 IsHostVisible,
+                     VkMemoryAllocateFlags                AllocateFlags,
+                     const VulkanDedicatedAllocationInfo* pDedicatedInfo = nullptr);
     ~VulkanMemoryPage();
 
     // clang-format off
@@ -107,7 +119,8 @@ public:
         m_ParentMemoryMgr {rhs.m_ParentMemoryMgr         },
         m_AllocationMgr   {std::move(rhs.m_AllocationMgr)},
         m_VkMemory        {std::move(rhs.m_VkMemory)     },
-        m_CPUMemory       {rhs.m_CPUMemory               }
+        m_CPUMemory       {rhs.m_CPUMemory               },
+        m_IsDedicated     {rhs.m_IsDedicated             }
     {
         rhs.m_CPUMemory = nullptr;
     }
@@ -120,6 +133,7 @@ public:
     bool IsFull()  const { return m_AllocationMgr.IsFull();  }
     VkDeviceSize GetPageSize() const { return m_AllocationMgr.GetMaxSize();  }
     VkDeviceSize GetUsedSize() const { return m_AllocationMgr.GetUsedSize(); }
+    bool IsDedicated() const { return m_IsDedicated; }
 
     // clang-format on
 
@@ -141,6 +155,9 @@ private:
     Diligent::VariableSizeAllocationsManager m_AllocationMgr;
     VulkanUtilities::DeviceMemoryWrapper     m_VkMemory;
     void*                                    m_CPUMemory = nullptr;
+
+    // Dedicated pages hold a single allocation and are destroyed as soon as it is released
+    bool m_IsDedicated = false;
 };
 
 class VulkanMemoryManager
@@ -175,6 +192,7 @@ public:
         m_PhysicalDevice  {rhs.m_PhysicalDevice    },
         m_Allocator       {rhs.m_Allocator         },
         m_Pages           {std::move(rhs.m_Pages)  },
+        m_DedicatedPages  {std::move(rhs.m_DedicatedPages)},
 
         m_DeviceLocalPageSize    {rhs.m_DeviceLocalPageSize   },
         m_HostVisiblePageSize    {rhs.m_HostVisiblePageSize   },
@@ -199,9 +217,15 @@ public:
     VulkanMemoryManager& operator= (VulkanMemoryManager&&)      = delete;
     // clang-format on
 
-    VulkanMemoryAllocation Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags);
-    VulkanMemoryAllocation Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags);
-    void                   ShrinkMemory();
+    // Allocations that are larger than half of the page size, as well as allocations for resources
+    // the driver prefers to keep in their own memory objects, are placed in dedicated pages.
+    VulkanMemoryAllocation Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags, const VulkanDedicatedAllocationInfo* pDedicatedInfo = nullptr);
+    VulkanMemoryAllocation Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags, const VulkanDedicatedAllocationInfo* pDedicatedInfo = nullptr);
+
+    // Releases empty pages that exceed the reserve size. At most one page of each kind
+    // (device-local and host-visible) is released per call so that returning large amounts
+    // of memory to the driver is spread over several frames.
+    void ShrinkMemory();
 
 protected:
     friend class VulkanMemoryPage;
@@ -222,21 +246,25 @@ protected:
         const uint32_t              MemoryTypeIndex;
         const VkMemoryAllocateFlags AllocateFlags;
         const bool                  IsHostVisible;
+        const bool                  IsSmall; // Small allocations are kept in separate pages to reduce fragmentation
 
         // clang-format off
         MemoryPageIndex(uint32_t              _MemoryTypeIndex,
                         bool                  _IsHostVisible,
-                        VkMemoryAllocateFlags _AllocateFlags) :
+                        VkMemoryAllocateFlags _AllocateFlags,
+                        bool                  _IsSmall) :
             MemoryTypeIndex{_MemoryTypeIndex},
             AllocateFlags  {_AllocateFlags},
-            IsHostVisible  {_IsHostVisible}
+            IsHostVisible  {_IsHostVisible},
+            IsSmall        {_IsSmall}
         {}
 
         bool operator == (const MemoryPageIndex& rhs)const
         {
             return MemoryTypeIndex == rhs.MemoryTypeIndex &&
                    AllocateFlags   == rhs.AllocateFlags   &&
-                   IsHostVisible   == rhs.IsHostVisible;
+                   IsHostVisible   == rhs.IsHostVisible   &&
+                   IsSmall         == rhs.IsSmall;
         }
         // clang-format on
 
@@ -244,12 +272,19 @@ protected:
         {
             size_t operator()(const MemoryPageIndex& PageIndex) const
             {
-                return Diligent::ComputeHash(PageIndex.MemoryTypeIndex, PageIndex.AllocateFlags, PageIndex.IsHostVisible);
+                return Diligent::ComputeHash(PageIndex.MemoryTypeIndex, PageIndex.AllocateFlags, PageIndex.IsHostVisible, PageIndex.IsSmall);
             }
         };
     };
     std::unordered_multimap<MemoryPageIndex, VulkanMemoryPage, MemoryPageIndex::Hasher> m_Pages;
 
+    // Dedicated pages indexed by their device memory handle
+    std::unordered_map<VkDeviceMemory, VulkanMemoryPage> m_DedicatedPages;
+
+    // Allocations that are not greater than the page size divided by this value
+    // are placed in small-allocation pages.
+    static constexpr VkDeviceSize SmallAllocationPageSizeRatio = 64;
+
     const VkDeviceSize m_DeviceLocalPageSize;
     const VkDeviceSize m_HostVisiblePageSize;
     const VkDeviceSize m_DeviceLocalReserveSize;
@@ -257,6 +292,9 @@ protected:
 
     void OnFreeAllocation(VkDeviceSize Size, bool IsHostVisible);
 
+    // Destroys the dedicated page when its allocation is released.
+    void OnDedicatedPageReleased(VulkanMemoryPage& Page);
+
     // 0 == Device local, 1 == Host-visible
     std::array<std::atomic<int64_t>, 2> m_CurrUsedSize      = {};
     std::array<VkDeviceSize, 2>         m_PeakUsedSize      = {};
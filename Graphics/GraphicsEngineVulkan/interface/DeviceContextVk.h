@@ -84,6 +84,42 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContextVk, IDeviceContext)
     ///           calling IDeviceContext::InvalidateState() and then manually restore all required states via
     ///           appropriate Diligent API calls.
     VIRTUAL VkCommandBuffer METHOD(GetVkCommandBuffer)(THIS) PURE;
+
+    /// Begins recording commands in the deferred context into a secondary command buffer
+    /// that will be executed inside the given subpass of a render pass instance.
+
+    /// \param [in] ImmediateContextId - the ID of the immediate context where commands from this
+    ///                                  deferred context will be executed, see IDeviceContext::Begin().
+    /// \param [in] pRenderPass        - render pass that will be active when the command list is executed.
+    /// \param [in] SubpassIndex       - index of the subpass in which the command list will be executed.
+    /// \param [in] pFramebuffer       - framebuffer that will be used by the render pass instance.
+    ///
+    /// \remarks  This method is used instead of IDeviceContext::Begin(). The context behaves as if the render pass
+    ///           was begun and the given subpass is active, but the render pass instance itself is begun and ended
+    ///           by the immediate context. The command list recorded by FinishCommandList() must be executed by
+    ///           IDeviceContext::ExecuteCommandLists() inside the corresponding subpass, which must be begun with
+    ///           VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS contents (see SetSubpassContents()).
+    ///
+    ///           Render passes, subpasses and resource state transitions can't be recorded by the context
+    ///           until FinishCommandList() is called, so all commands must use RESOURCE_STATE_TRANSITION_MODE_VERIFY
+    ///           or RESOURCE_STATE_TRANSITION_MODE_NONE mode.
+    VIRTUAL void METHOD(BeginSecondary)(THIS_
+                                        Uint32        ImmediateContextId,
+                                        IRenderPass*  pRenderPass,
+                                        Uint32        SubpassIndex,
+                                        IFramebuffer* pFramebuffer) PURE;
+
+    /// Sets the contents of the subpasses begun by subsequent IDeviceContext::BeginRenderPass()
+    /// and IDeviceContext::NextSubpass() calls in the immediate context.
+
+    /// \param [in] Contents - VK_SUBPASS_CONTENTS_INLINE (default) or VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS.
+    ///
+    /// \remarks  Subpasses whose contents are VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS can only execute
+    ///           secondary command lists recorded with BeginSecondary(). No other commands can be recorded
+    ///           by the immediate context in these subpasses. The pipeline, shader resources, vertex and index
+    ///           buffers must be set again after the command lists have been executed.
+    VIRTUAL void METHOD(SetSubpassContents)(THIS_
+                                            VkSubpassContents Contents) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -95,6 +131,8 @@ DILIGENT_END_INTERFACE
 
 #    define IDeviceContextVk_TransitionImageLayout(This, ...) CALL_IFACE_METHOD(DeviceContextVk, TransitionImageLayout, This, __VA_ARGS__)
 #    define IDeviceContextVk_BufferMemoryBarrier(This, ...)   CALL_IFACE_METHOD(DeviceContextVk, BufferMemoryBarrier,   This, __VA_ARGS__)
+#    define IDeviceContextVk_BeginSecondary(This, ...)        CALL_IFACE_METHOD(DeviceContextVk, BeginSecondary,        This, __VA_ARGS__)
+#    define IDeviceContextVk_SetSubpassContents(This, ...)    CALL_IFACE_METHOD(DeviceContextVk, SetSubpassContents,    This, __VA_ARGS__)
 
 // clang-format on
 
@@ -38,6 +38,33 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_RenderDeviceVk =
     {0xab8cf3a6, 0xd959, 0x41c1, {0xae, 0x0, 0xa5, 0x8a, 0xe9, 0x82, 0xe, 0x6a}};
 
+// clang-format off
+/// Dynamic heap usage statistics, see IRenderDeviceVk::GetDynamicHeapStats().
+struct DynamicHeapStatsVk
+{
+    /// The size of the dynamic heap buffer shared by all contexts (EngineVkCreateInfo::DynamicHeapSize).
+    Uint64 Size                  DEFAULT_INITIALIZER(0);
+
+    /// The size of the master blocks currently used by device contexts, including the blocks
+    /// that wait until the GPU finishes the commands that use them.
+    Uint64 UsedSize              DEFAULT_INITIALIZER(0);
+
+    /// The peak used size since the device was created.
+    Uint64 PeakUsedSize          DEFAULT_INITIALIZER(0);
+
+    /// The peak used size during the last frame.
+    Uint64 FramePeakUsedSize     DEFAULT_INITIALIZER(0);
+
+    /// The number of master block allocations that had to wait for the GPU
+    /// because the dynamic heap was exhausted.
+    Uint32 StallCount            DEFAULT_INITIALIZER(0);
+
+    /// The number of master block allocations that failed because the dynamic heap was exhausted.
+    Uint32 FailedAllocationCount DEFAULT_INITIALIZER(0);
+};
+// clang-format on
+typedef struct DynamicHeapStatsVk DynamicHeapStatsVk;
+
 #define DILIGENT_INTERFACE_NAME IRenderDeviceVk
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -157,6 +184,18 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceVk, IRenderDevice)
                                                        VkSemaphore         vkTimelineSemaphore,
                                                        const FenceDesc REF Desc,
                                                        IFence**            ppFence) PURE;
+
+    /// Returns the usage statistics of the dynamic heap shared by all device contexts.
+
+    /// \param [out] Stats - Dynamic heap usage statistics, see Diligent::DynamicHeapStatsVk.
+    ///
+    /// \remarks   The dynamic heap size is fixed at device creation because dynamic buffers are bound
+    ///            with dynamic offsets into the single heap buffer. Use the peak used size to choose
+    ///            EngineVkCreateInfo::DynamicHeapSize, and StallCount to detect that the heap is too small.
+    ///
+    ///            The method is thread-safe.
+    VIRTUAL void METHOD(GetDynamicHeapStats)(THIS_
+                                             DynamicHeapStatsVk REF Stats) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -174,6 +213,7 @@ DILIGENT_END_INTERFACE
 #    define IRenderDeviceVk_CreateBLASFromVulkanResource(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateBLASFromVulkanResource,   This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateTLASFromVulkanResource(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateTLASFromVulkanResource,   This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateFenceFromVulkanResource(This, ...)  CALL_IFACE_METHOD(RenderDeviceVk, CreateFenceFromVulkanResource,  This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetDynamicHeapStats(This, ...)            CALL_IFACE_METHOD(RenderDeviceVk, GetDynamicHeapStats,            This, __VA_ARGS__)
 
 // clang-format on
 
@@ -42,25 +42,61 @@ static const INTERFACE_ID IID_ShaderResourceBindingVk =
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
 #define IShaderResourceBindingVkInclusiveMethods \
-    IShaderResourceBindingInclusiveMethods
-//IShaderResourceBindingVkMethods ShaderResourceBindingVk
+    IShaderResourceBindingInclusiveMethods;      \
+    IShaderResourceBindingVkMethods ShaderResourceBindingVk
 
-#if DILIGENT_CPP_INTERFACE
+// clang-format off
 
 /// Exposes Vulkan-specific functionality of a shader resource binding object.
-DILIGENT_BEGIN_INTERFACE(IShaderResourceBindingVk, IShaderResourceBinding){};
+DILIGENT_BEGIN_INTERFACE(IShaderResourceBindingVk, IShaderResourceBinding)
+{
+    /// Places the resource into the bindless array and returns its index in the array.
+
+    /// \param [in] pVariable - Shader resource variable that was defined with PIPELINE_RESOURCE_FLAG_BINDLESS flag.
+    /// \param [in] pObject   - Texture view or buffer view to add to the array.
+    ///
+    /// \return    The index of the element in the array that the shader should use to access the resource,
+    ///            or 0xFFFFFFFF if the array is full or the variable is not bindless.
+    ///
+    /// \remarks   If the resource is already in the array, the method returns the same index.
+    ///            The index remains valid until the resource is removed with RemoveBindlessResource(),
+    ///            after which it may be reused for another resource. All shader stages that share
+    ///            the resource also share the index.
+    ///
+    ///            Adding resources does not require committing the shader resource binding again,
+    ///            but the application must not modify the array elements that are accessed by commands
+    ///            being executed by the GPU.
+    ///
+    ///            The method is not thread-safe.
+    VIRTUAL Uint32 METHOD(AddBindlessResource)(THIS_
+                                               IShaderResourceVariable* pVariable,
+                                               IDeviceObject*           pObject) PURE;
+
+    /// Removes the resource from the bindless array and makes its index available for reuse.
+
+    /// \param [in] pVariable - Shader resource variable that was defined with PIPELINE_RESOURCE_FLAG_BINDLESS flag.
+    /// \param [in] pObject   - Resource that was previously added with AddBindlessResource().
+    ///
+    /// \remarks   The application is responsible for making sure that the GPU does not access the element
+    ///            when it is reused. The method is not thread-safe.
+    VIRTUAL void METHOD(RemoveBindlessResource)(THIS_
+                                                IShaderResourceVariable* pVariable,
+                                                IDeviceObject*           pObject) PURE;
+};
 DILIGENT_END_INTERFACE
 
-#endif
+// clang-format on
 
 #include "../../../Primitives/interface/UndefInterfaceHelperMacros.h"
 
 #if DILIGENT_C_INTERFACE
 
-typedef struct IShaderResourceBindingVkVtbl
-{
-    IShaderResourceBindingVkInclusiveMethods;
-} IShaderResourceBindingVkVtbl;
+// clang-format off
+
+#    define IShaderResourceBindingVk_AddBindlessResource(This, ...)    CALL_IFACE_METHOD(ShaderResourceBindingVk, AddBindlessResource,    This, __VA_ARGS__)
+#    define IShaderResourceBindingVk_RemoveBindlessResource(This, ...) CALL_IFACE_METHOD(ShaderResourceBindingVk, RemoveBindlessResource, This, __VA_ARGS__)
+
+// clang-format on
 
 #endif
 
@@ -31,6 +31,7 @@
 #include "DeviceContextVkImpl.hpp"
 #include "VulkanTypeConversions.hpp"
 #include "BufferViewVkImpl.hpp"
+#include "DeviceMemoryVkImpl.hpp"
 #include "GraphicsAccessories.hpp"
 #include "EngineMemory.h"
 #include "StringTools.hpp"
@@ -40,79 +41,50 @@
 namespace Diligent
 {
 
-BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
-                           FixedBlockMemoryAllocator& BuffViewObjMemAllocator,
-                           RenderDeviceVkImpl*        pRenderDeviceVk,
-                           const BufferDesc&          BuffDesc,
-                           const BufferData*          pBuffData /*= nullptr*/) :
-    // clang-format off
-    TBufferBase
-    {
-        pRefCounters,
-        BuffViewObjMemAllocator,
-        pRenderDeviceVk,
-        BuffDesc,
-        false
-    },
-    m_DynamicData(STD_ALLOCATOR_RAW_MEM(CtxDynamicData, GetRawAllocator(), "Allocator for vector<VulkanDynamicAllocation>"))
-// clang-format on
+VkBufferCreateInfo BufferDescToVkBufferCreateInfo(const BufferDesc& Desc) noexcept
 {
-    ValidateBufferInitData(m_Desc, pBuffData);
-
-    const auto& LogicalDevice  = pRenderDeviceVk->GetLogicalDevice();
-    const auto& PhysicalDevice = pRenderDeviceVk->GetPhysicalDevice();
-    const auto& DeviceLimits   = PhysicalDevice.GetProperties().limits;
-    m_DynamicOffsetAlignment   = std::max(Uint32{4}, static_cast<Uint32>(DeviceLimits.optimalBufferCopyOffsetAlignment));
-
     VkBufferCreateInfo VkBuffCI{};
     VkBuffCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     VkBuffCI.pNext = nullptr;
     VkBuffCI.flags = 0; // VK_BUFFER_CREATE_SPARSE_BINDING_BIT, VK_BUFFER_CREATE_SPARSE_RESIDENCY_BIT, VK_BUFFER_CREATE_SPARSE_ALIASED_BIT
-    VkBuffCI.size  = m_Desc.Size;
+    VkBuffCI.size  = Desc.Size;
     VkBuffCI.usage =
         VK_BUFFER_USAGE_TRANSFER_SRC_BIT | // The buffer can be used as the source of a transfer command
         VK_BUFFER_USAGE_TRANSFER_DST_BIT;  // The buffer can be used as the destination of a transfer command
 
     static_assert(BIND_FLAG_LAST == 0x800, "Please update this function to handle the new bind flags");
 
-    for (auto BindFlags = m_Desc.BindFlags; BindFlags != 0;)
+    for (auto BindFlags = Desc.BindFlags; BindFlags != 0;)
     {
         auto BindFlag = ExtractLSB(BindFlags);
         switch (BindFlag)
         {
             case BIND_SHADER_RESOURCE:
             {
-                if (m_Desc.Mode == BUFFER_MODE_FORMATTED)
+                if (Desc.Mode == BUFFER_MODE_FORMATTED)
                 {
                     // Formatted buffers are mapped to uniform texel buffers in Vulkan.
                     VkBuffCI.usage |= VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT;
-                    m_DynamicOffsetAlignment = std::max(m_DynamicOffsetAlignment, static_cast<Uint32>(DeviceLimits.minTexelBufferOffsetAlignment));
                 }
                 else
                 {
                     // Structured and ByteAddress buffers are mapped to read-only storage buffers in Vulkan.
                     VkBuffCI.usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-                    m_DynamicOffsetAlignment = std::max(m_DynamicOffsetAlignment, static_cast<Uint32>(DeviceLimits.minStorageBufferOffsetAlignment));
                 }
 
                 break;
             }
             case BIND_UNORDERED_ACCESS:
             {
-                if (m_Desc.Mode == BUFFER_MODE_FORMATTED)
+                if (Desc.Mode == BUFFER_MODE_FORMATTED)
                 {
                     // RW formatted buffers are mapped to storage texel buffers in Vulkan.
                     VkBuffCI.usage |= VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT;
-                    m_DynamicOffsetAlignment = std::max(m_DynamicOffsetAlignment, static_cast<Uint32>(DeviceLimits.minTexelBufferOffsetAlignment));
                 }
                 else
                 {
                     // RWStructured and RWByteAddress buffers are mapped to storage buffers in Vulkan.
                     VkBuffCI.usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-                    // Each element of pDynamicOffsets of vkCmdBindDescriptorSets function which corresponds to a descriptor
-                    // binding with type VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC must be a multiple of
-                    // VkPhysicalDeviceLimits::minStorageBufferOffsetAlignment (13.2.5)
-                    m_DynamicOffsetAlignment = std::max(m_DynamicOffsetAlignment, static_cast<Uint32>(DeviceLimits.minStorageBufferOffsetAlignment));
                 }
 
                 break;
@@ -135,11 +107,6 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
             case BIND_UNIFORM_BUFFER:
             {
                 VkBuffCI.usage |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-
-                // Each element of pDynamicOffsets parameter of vkCmdBindDescriptorSets function which corresponds to a descriptor
-                // binding with type VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC must be a multiple of
-                // VkPhysicalDeviceLimits::minUniformBufferOffsetAlignment (13.2.5)
-                m_DynamicOffsetAlignment = std::max(m_DynamicOffsetAlignment, static_cast<Uint32>(DeviceLimits.minUniformBufferOffsetAlignment));
                 break;
             }
             case BIND_RAY_TRACING:
@@ -156,17 +123,71 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
         }
     }
 
+    VkBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE; // Sharing mode of the buffer when it is accessed by multiple queue families.
+    VkBuffCI.queueFamilyIndexCount = 0;                         // The number of entries in the pQueueFamilyIndices array.
+    VkBuffCI.pQueueFamilyIndices   = nullptr;                   // The list of queue families that will access this buffer
+                                                                // (ignored if sharingMode is not VK_SHARING_MODE_CONCURRENT).
+
+    return VkBuffCI;
+}
+
+BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
+                           FixedBlockMemoryAllocator& BuffViewObjMemAllocator,
+                           RenderDeviceVkImpl*        pRenderDeviceVk,
+                           const BufferDesc&          BuffDesc,
+                           const BufferData*          pBuffData /*= nullptr*/) :
+    // clang-format off
+    TBufferBase
+    {
+        pRefCounters,
+        BuffViewObjMemAllocator,
+        pRenderDeviceVk,
+        BuffDesc,
+        false
+    },
+    m_DynamicData(STD_ALLOCATOR_RAW_MEM(CtxDynamicData, GetRawAllocator(), "Allocator for vector<VulkanDynamicAllocation>"))
+// clang-format on
+{
+    ValidateBufferInitData(m_Desc, pBuffData);
+
+    const auto& LogicalDevice  = pRenderDeviceVk->GetLogicalDevice();
+    const auto& PhysicalDevice = pRenderDeviceVk->GetPhysicalDevice();
+    const auto& DeviceLimits   = PhysicalDevice.GetProperties().limits;
+    m_DynamicOffsetAlignment   = std::max(Uint32{4}, static_cast<Uint32>(DeviceLimits.optimalBufferCopyOffsetAlignment));
+
+    VkBufferCreateInfo VkBuffCI = BufferDescToVkBufferCreateInfo(m_Desc);
+    if ((m_Desc.BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0 &&
+        LogicalDevice.GetEnabledExtFeatures().ConditionalRendering.conditionalRendering != VK_FALSE)
+    {
+        // Indirect argument buffers may be used as predicates, see IDeviceContext::SetPredication()
+        VkBuffCI.usage |= VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT;
+    }
+
+    if (m_Desc.BindFlags & (BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS))
+    {
+        // Formatted buffers are mapped to texel buffers, other buffers are mapped to storage buffers in Vulkan.
+        // Each element of pDynamicOffsets of vkCmdBindDescriptorSets function which corresponds to a descriptor
+        // binding with type VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC must be a multiple of
+        // VkPhysicalDeviceLimits::minStorageBufferOffsetAlignment (13.2.5)
+        const auto OffsetAlignment = m_Desc.Mode == BUFFER_MODE_FORMATTED ?
+            DeviceLimits.minTexelBufferOffsetAlignment :
+            DeviceLimits.minStorageBufferOffsetAlignment;
+        m_DynamicOffsetAlignment = std::max(m_DynamicOffsetAlignment, static_cast<Uint32>(OffsetAlignment));
+    }
+    if (m_Desc.BindFlags & BIND_UNIFORM_BUFFER)
+    {
+        // Each element of pDynamicOffsets parameter of vkCmdBindDescriptorSets function which corresponds to a descriptor
+        // binding with type VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC must be a multiple of
+        // VkPhysicalDeviceLimits::minUniformBufferOffsetAlignment (13.2.5)
+        m_DynamicOffsetAlignment = std::max(m_DynamicOffsetAlignment, static_cast<Uint32>(DeviceLimits.minUniformBufferOffsetAlignment));
+    }
+
     if (m_Desc.Usage == USAGE_DYNAMIC)
     {
         auto CtxCount = pRenderDeviceVk->GetNumImmediateContexts() + pRenderDeviceVk->GetNumDeferredContexts();
         m_DynamicData.resize(CtxCount);
     }
 
-    VkBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE; // Sharing mode of the buffer when it is accessed by multiple queue families.
-    VkBuffCI.queueFamilyIndexCount = 0;                         // The number of entries in the pQueueFamilyIndices array.
-    VkBuffCI.pQueueFamilyIndices   = nullptr;                   // The list of queue families that will access this buffer
-                                                                // (ignored if sharingMode is not VK_SHARING_MODE_CONCURRENT).
-
     const auto QueueFamilyIndices = PlatformMisc::CountOneBits(m_Desc.ImmediateContextMask) > 1 ?
         GetDevice()->ConvertCmdQueueIdsToQueueFamilies(m_Desc.ImmediateContextMask) :
         std::vector<uint32_t>{};
@@ -238,7 +259,10 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
 
         m_VulkanBuffer = LogicalDevice.CreateBuffer(VkBuffCI, m_Desc.Name);
 
-        VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_VulkanBuffer);
+        VulkanUtilities::VulkanDedicatedAllocationInfo DedicatedInfo;
+        DedicatedInfo.vkBuffer = m_VulkanBuffer;
+
+        VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_VulkanBuffer, DedicatedInfo.Preferred);
 
         static constexpr auto InvalidMemoryTypeIndex = VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex;
 
@@ -316,13 +340,42 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
         }
 
         VERIFY(IsPowerOfTwo(RequiredAlignment), "Alignment is not power of 2!");
-        m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs.size, RequiredAlignment, MemoryTypeIndex, AllocateFlags);
 
-        m_BufferMemoryAlignedOffset = AlignUp(VkDeviceSize{m_MemoryAllocation.UnalignedOffset}, RequiredAlignment);
-        VERIFY(m_MemoryAllocation.Size >= MemReqs.size + (m_BufferMemoryAlignedOffset - m_MemoryAllocation.UnalignedOffset), "Size of memory allocation is too small");
-        auto Memory = m_MemoryAllocation.Page->GetVkMemory();
-        auto err    = LogicalDevice.BindBufferMemory(m_VulkanBuffer, Memory, m_BufferMemoryAlignedOffset);
-        CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
+        const bool IsPlaced = pBuffData != nullptr && pBuffData->pMemory != nullptr;
+        if (IsPlaced)
+        {
+            // Bind the buffer to the memory range of the device memory object. The memory may be shared by other
+            // placed resources, so the buffer must be activated with an aliasing barrier before it is used.
+            if (AllocateFlags != 0)
+                LOG_ERROR_AND_THROW("Buffers with BIND_RAY_TRACING flag can't be placed in device memory in Vulkan");
+
+            const auto* pMemoryVk = ClassPtrCast<const DeviceMemoryVkImpl>(pBuffData->pMemory);
+            if ((MemReqs.memoryTypeBits & (1u << pMemoryVk->GetMemoryTypeIndex())) == 0)
+                LOG_ERROR_AND_THROW("The memory type of the device memory is not compatible with the buffer");
+            MemoryTypeIndex = pMemoryVk->GetMemoryTypeIndex();
+
+            const auto MemRange = pMemoryVk->GetRange(pBuffData->MemoryOffset, MemReqs.size);
+            if (MemRange.Handle == VK_NULL_HANDLE)
+                LOG_ERROR_AND_THROW("Memory range [", pBuffData->MemoryOffset, ", ", pBuffData->MemoryOffset + MemReqs.size, ") is not a valid range of the device memory");
+            if ((MemRange.Offset % RequiredAlignment) != 0)
+                LOG_ERROR_AND_THROW("Memory offset (", pBuffData->MemoryOffset, ") is not a multiple of the required alignment (", RequiredAlignment, ")");
+
+            m_pMemory = pBuffData->pMemory;
+
+            m_BufferMemoryAlignedOffset = MemRange.Offset;
+            auto err                    = LogicalDevice.BindBufferMemory(m_VulkanBuffer, MemRange.Handle, m_BufferMemoryAlignedOffset);
+            CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
+        }
+        else
+        {
+            m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs.size, RequiredAlignment, MemoryTypeIndex, AllocateFlags, &DedicatedInfo);
+
+            m_BufferMemoryAlignedOffset = AlignUp(VkDeviceSize{m_MemoryAllocation.UnalignedOffset}, RequiredAlignment);
+            VERIFY(m_MemoryAllocation.Size >= MemReqs.size + (m_BufferMemoryAlignedOffset - m_MemoryAllocation.UnalignedOffset), "Size of memory allocation is too small");
+            auto Memory = m_MemoryAllocation.Page->GetVkMemory();
+            auto err    = LogicalDevice.BindBufferMemory(m_VulkanBuffer, Memory, m_BufferMemoryAlignedOffset);
+            CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
+        }
 
         VERIFY(!AlignToNonCoherentAtomSize || (m_BufferMemoryAlignedOffset + MemReqs.size) % DeviceLimits.nonCoherentAtomSize == 0, "End offset is not properly aligned");
 
@@ -347,7 +400,8 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
             const auto& MemoryProps = PhysicalDevice.GetMemoryProperties();
             VERIFY_EXPR(MemoryTypeIndex < MemoryProps.memoryTypeCount);
             const auto MemoryPropFlags = MemoryProps.memoryTypes[MemoryTypeIndex].propertyFlags;
-            if ((MemoryPropFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0)
+            // Placed memory is never mapped, so placed buffers are always initialized through the staging buffer
+            if ((MemoryPropFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0 && !IsPlaced)
             {
                 // Memory is directly accessible by CPU
                 auto* pData = reinterpret_cast<uint8_t*>(m_MemoryAllocation.Page->GetCPUMemory());
@@ -393,25 +447,24 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
                     ClassPtrCast<DeviceContextVkImpl>(pBuffData->pContext)->GetCommandQueueId() :
                     SoftwareQueueIndex{PlatformMisc::GetLSB(m_Desc.ImmediateContextMask)};
 
-                VulkanUtilities::CommandPoolWrapper  CmdPool;
-                VulkanUtilities::VulkanCommandBuffer CmdBuffer;
-                pRenderDeviceVk->AllocateTransientCmdPool(CmdQueueInd, CmdPool, CmdBuffer, "Transient command pool to copy staging data to a device buffer");
-
-                CmdBuffer.MemoryBarrier(VK_ACCESS_HOST_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_HOST_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
-                InitialState              = RESOURCE_STATE_COPY_DEST;
-                VkAccessFlags AccessFlags = ResourceStateFlagsToVkAccessFlags(InitialState);
+                InitialState                    = RESOURCE_STATE_COPY_DEST;
+                const VkAccessFlags AccessFlags = ResourceStateFlagsToVkAccessFlags(InitialState);
                 VERIFY_EXPR(AccessFlags == VK_ACCESS_TRANSFER_WRITE_BIT);
-                CmdBuffer.MemoryBarrier(0, AccessFlags, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
 
-                // Copy commands MUST be recorded outside of a render pass instance. This is OK here
-                // as copy will be the only command in the cmd buffer
-                VkBufferCopy BuffCopy{};
-                BuffCopy.srcOffset = 0;
-                BuffCopy.dstOffset = 0;
-                BuffCopy.size      = VkBuffCI.size;
-                CmdBuffer.CopyBuffer(StagingBuffer, m_VulkanBuffer, 1, &BuffCopy);
+                pRenderDeviceVk->RecordInitialDataCopy(
+                    CmdQueueInd, VkBuffCI.size, "Transient command pool to copy staging data to a device buffer",
+                    [&](VulkanUtilities::VulkanCommandBuffer& CmdBuffer) {
+                        CmdBuffer.MemoryBarrier(VK_ACCESS_HOST_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_HOST_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+                        CmdBuffer.MemoryBarrier(0, AccessFlags, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
 
-                pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(CmdQueueInd, CmdBuffer.GetVkCmdBuffer(), std::move(CmdPool));
+                        // Copy commands MUST be recorded outside of a render pass instance. This is OK here
+                        // as the command buffer only contains copy commands
+                        VkBufferCopy BuffCopy{};
+                        BuffCopy.srcOffset = 0;
+                        BuffCopy.dstOffset = 0;
+                        BuffCopy.size      = VkBuffCI.size;
+                        CmdBuffer.CopyBuffer(StagingBuffer, m_VulkanBuffer, 1, &BuffCopy);
+                    });
 
 
                 // After command buffer is submitted, safe-release staging resources. This strategy
@@ -422,7 +475,7 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
                 //              |            |                                                |
                 //      N       |     F      |                                                |
                 //              |            |                                                |
-                //              |            |  ExecuteAndDisposeTransientCmdBuff(vkCmdBuff)  |
+                //              |            |  RecordInitialDataCopy()                       |
                 //              |            |  - SubmittedCmdBuffNumber = N                  |
                 //              |            |  - SubmittedFenceValue = F                     |
                 //     N+1 -  - | -  F+1  -  |                                                |
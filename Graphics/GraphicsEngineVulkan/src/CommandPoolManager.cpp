@@ -38,22 +38,16 @@ CommandPoolManager::CommandPoolManager(const CreateInfo& CI) noexcept :
     m_LogicalDevice   {CI.LogicalDevice   },
     m_Name            {CI.Name            },
     m_QueueFamilyIndex{CI.queueFamilyIndex},
-    m_CmdPoolFlags    {CI.flags           },
-    m_CmdPools        (STD_ALLOCATOR_RAW_MEM(VulkanUtilities::CommandPoolWrapper, GetRawAllocator(), "Allocator for deque<VulkanUtilities::CommandPoolWrapper>"))
+    m_CmdPoolFlags    {CI.flags           }
 // clang-format on
 {
 }
 
 VulkanUtilities::CommandPoolWrapper CommandPoolManager::AllocateCommandPool(const char* DebugName)
 {
-    std::lock_guard<std::mutex> LockGuard{m_Mutex};
-
     VulkanUtilities::CommandPoolWrapper CmdPool;
-    if (!m_CmdPools.empty())
+    if (m_CmdPools.TryPop(CmdPool))
     {
-        CmdPool = std::move(m_CmdPools.front());
-        m_CmdPools.pop_front();
-
         m_LogicalDevice.ResetCommandPool(CmdPool);
     }
 
@@ -80,24 +74,32 @@ VulkanUtilities::CommandPoolWrapper CommandPoolManager::AllocateCommandPool(cons
 
 void CommandPoolManager::RecycleCommandPool(VulkanUtilities::CommandPoolWrapper&& CmdPool)
 {
-    std::lock_guard<std::mutex> LockGuard{m_Mutex};
 #ifdef DILIGENT_DEVELOPMENT
     --m_AllocatedPoolCounter;
 #endif
-    m_CmdPools.emplace_back(std::move(CmdPool));
+    if (!m_CmdPools.TryPush(std::move(CmdPool)))
+    {
+        // Too many pools are available - destroy this one
+        CmdPool.Release();
+    }
 }
 
 void CommandPoolManager::DestroyPools()
 {
-    std::lock_guard<std::mutex> LockGuard{m_Mutex};
     DEV_CHECK_ERR(m_AllocatedPoolCounter == 0, m_AllocatedPoolCounter, " pool(s) have not been recycled. This will cause a crash if the references to these pools are still in release queues when CommandPoolManager::RecycleCommandPool() is called for destroyed CommandPoolManager object.");
-    LOG_INFO_MESSAGE(m_Name, " allocated descriptor pool count: ", m_CmdPools.size());
-    m_CmdPools.clear();
+    size_t                              PoolCount = 0;
+    VulkanUtilities::CommandPoolWrapper CmdPool;
+    while (m_CmdPools.TryPop(CmdPool))
+    {
+        CmdPool.Release();
+        ++PoolCount;
+    }
+    LOG_INFO_MESSAGE(m_Name, " allocated descriptor pool count: ", PoolCount);
 }
 
 CommandPoolManager::~CommandPoolManager()
 {
-    DEV_CHECK_ERR(m_CmdPools.empty() && m_AllocatedPoolCounter == 0, "Command pools have not been destroyed");
+    DEV_CHECK_ERR(m_AllocatedPoolCounter == 0, "Command pools have not been destroyed");
 }
 
 } // namespace Diligent
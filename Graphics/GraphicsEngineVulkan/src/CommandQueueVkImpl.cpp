@@ -60,7 +60,15 @@ CommandQueueVkImpl::CommandQueueVkImpl(IReferenceCounters*
     if (CreateInfo.Name != nullptr)
         VulkanUtilities::SetQueueName(m_LogicalDevice->GetVkDevice(), m_VkQueue, CreateInfo.Name);
 
+    if (m_SupportedTimelineSemaphore)
+    {
+        // All command buffers with fence value less than or equal to the semaphore counter
+        // are guaranteed to be finished by the GPU.
+        m_vkTimelineSemaphore = m_LogicalDevice->CreateTimelineSemaphore(0, "Command queue timeline semaphore");
+    }
+
     m_TempSignalSemaphores.reserve(16);
+    m_TempSignalValues.reserve(16);
 }
 
 CommandQueueVkImpl::~CommandQueueVkImpl()
@@ -73,6 +81,9 @@ CommandQueueVkImpl::~CommandQueueVkImpl()
     m_pFence.Release();
     m_LastSyncPoint.reset();
 
+    // The queue is idle at this point, so the semaphore can be destroyed immediately.
+    m_vkTimelineSemaphore.Release();
+
     // Queues are created along with the logical device during vkCreateDevice.
     // All queues associated with the logical device are destroyed when vkDestroyDevice
     // is called on that device.
@@ -82,11 +93,17 @@ SyncPointVk::SyncPointVk(SoftwareQueueIndex                        CommandQueueI
                          Uint32                                    NumContexts,
                          VulkanUtilities::VulkanSyncObjectManager& SyncObjectMngr,
                          VkDevice                                  LogicalDevice,
-                         Uint64                                    dbgValue) :
+                         Uint64                                    Value,
+                         VkSemaphore                               vkQueueTimelineSemaphore) :
     m_CommandQueueId{CommandQueueId},
     m_NumSemaphores{static_cast<Uint8>(NumContexts)},
-    m_Fence{SyncObjectMngr.CreateFence()}
+    m_Value{Value},
+    m_vkQueueTimelineSemaphore{vkQueueTimelineSemaphore}
 {
+    // The queue timeline semaphore replaces the fence
+    if (m_vkQueueTimelineSemaphore == VK_NULL_HANDLE)
+        m_Fence = SyncObjectMngr.CreateFence();
+
     VERIFY(m_CommandQueueId == CommandQueueId, "Not enough bits to store command queue index");
     VERIFY(m_NumSemaphores == NumContexts, "Not enough bits to store command queue count");
 
@@ -104,14 +121,15 @@ SyncPointVk::SyncPointVk(SoftwareQueueIndex                        CommandQueueI
     }
 
 #ifdef DILIGENT_DEBUG
-    String Name = String{"Queue ("} + std::to_string(CommandQueueId) + ") Value (" + std::to_string(dbgValue) + ")";
-    VulkanUtilities::SetFenceName(LogicalDevice, m_Fence, Name.c_str());
+    String Name = String{"Queue ("} + std::to_string(CommandQueueId) + ") Value (" + std::to_string(Value) + ")";
+    if (m_Fence)
+        VulkanUtilities::SetFenceName(LogicalDevice, m_Fence, Name.c_str());
 
     for (Uint32 s = 0; s < m_NumSemaphores; ++s)
     {
         if (m_Semaphores[s])
         {
-            Name = String{"Queue ("} + std::to_string(CommandQueueId) + ") Value (" + std::to_string(dbgValue) + ") Ctx (" + std::to_string(s) + ")";
+            Name = String{"Queue ("} + std::to_string(CommandQueueId) + ") Value (" + std::to_string(Value) + ") Ctx (" + std::to_string(s) + ")";
             VulkanUtilities::SetSemaphoreName(LogicalDevice, m_Semaphores[s], Name.c_str());
         }
     }
@@ -125,6 +143,42 @@ SyncPointVk::~SyncPointVk()
         m_Semaphores[s].~RecycledSyncObject();
 }
 
+VkResult SyncPointVk::GetStatus(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice) const
+{
+    if (m_vkQueueTimelineSemaphore != VK_NULL_HANDLE)
+    {
+        Uint64 SemaphoreCounter = 0;
+        auto   err              = LogicalDevice.GetSemaphoreCounter(m_vkQueueTimelineSemaphore, &SemaphoreCounter);
+        if (err != VK_SUCCESS)
+            return err;
+        return SemaphoreCounter >= m_Value ? VK_SUCCESS : VK_NOT_READY;
+    }
+    else
+    {
+        return LogicalDevice.GetFenceStatus(m_Fence);
+    }
+}
+
+VkResult SyncPointVk::Wait(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, Uint64 Timeout) const
+{
+    if (m_vkQueueTimelineSemaphore != VK_NULL_HANDLE)
+    {
+        VkSemaphoreWaitInfo WaitInfo{};
+        WaitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        WaitInfo.pNext          = nullptr;
+        WaitInfo.flags          = 0;
+        WaitInfo.semaphoreCount = 1;
+        WaitInfo.pSemaphores    = &m_vkQueueTimelineSemaphore;
+        WaitInfo.pValues        = &m_Value;
+        return LogicalDevice.WaitSemaphores(WaitInfo, Timeout);
+    }
+    else
+    {
+        VkFence Fence = m_Fence;
+        return LogicalDevice.WaitForFences(1, &Fence, VK_TRUE, Timeout);
+    }
+}
+
 __forceinline void SyncPointVk::GetSemaphores(std::vector<VkSemaphore>& Semaphores)
 {
     for (Uint32 s = 0; s < m_NumSemaphores; ++s)
@@ -134,7 +188,7 @@ __forceinline void SyncPointVk::GetSemaphores(std::vector<VkSemaphore>& Semaphor
     }
 }
 
-__forceinline SyncPointVkPtr CommandQueueVkImpl::CreateSyncPoint(Uint64 dbgValue)
+__forceinline SyncPointVkPtr CommandQueueVkImpl::CreateSyncPoint(Uint64 Value)
 {
     auto* pAllocator = &m_SyncPointAllocator;
     void* ptr        = pAllocator->Allocate(SyncPointVk::SizeOf(m_NumCommandQueues), "SyncPointVk", __FILE__, __LINE__);
@@ -144,40 +198,97 @@ __forceinline SyncPointVkPtr CommandQueueVkImpl::CreateSyncPoint(Uint64 dbgValue
         pAllocator->Free(ptr);
     };
 
-    return {new (ptr) SyncPointVk{m_CommandQueueId, m_NumCommandQueues, *m_SyncObjectManager, m_LogicalDevice->GetVkDevice(), dbgValue}, std::move(Deleter)};
+    return {new (ptr) SyncPointVk{m_CommandQueueId, m_NumCommandQueues, *m_SyncObjectManager, m_LogicalDevice->GetVkDevice(), Value, m_vkTimelineSemaphore}, std::move(Deleter)};
 }
 
-Uint64 CommandQueueVkImpl::Submit(const VkSubmitInfo& InSubmitInfo)
+template <typename SubmitInfoType>
+bool CommandQueueVkImpl::PrepareSignalSemaphores(SubmitInfoType&                InOutInfo,
+                                                 VkTimelineSemaphoreSubmitInfo& TimelineSubmitInfo,
+                                                 SyncPointVk&                   SyncPoint,
+                                                 Uint64                         FenceValue)
 {
-    std::lock_guard<std::mutex> QueueGuard{m_QueueMutex};
+    m_TempSignalSemaphores.clear();
+    SyncPoint.GetSemaphores(m_TempSignalSemaphores);
 
-    // Increment the value before submitting the buffer to be overly safe
-    const uint64_t FenceValue = m_NextFenceValue.fetch_add(1);
+    // Only the timeline semaphore info at the head of the chain can be merged, as the chain is read-only
+    const VkTimelineSemaphoreSubmitInfo* pInTimelineInfo = nullptr;
+    if (InOutInfo.pNext != nullptr && static_cast<const VkBaseInStructure*>(InOutInfo.pNext)->sType == VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO)
+        pInTimelineInfo = static_cast<const VkTimelineSemaphoreSubmitInfo*>(InOutInfo.pNext);
 
-    auto NewSyncPoint = CreateSyncPoint(FenceValue);
+    bool HasTimelineInfo = pInTimelineInfo != nullptr;
+    for (const VkBaseInStructure* pStruct = static_cast<const VkBaseInStructure*>(InOutInfo.pNext); pStruct != nullptr && !HasTimelineInfo; pStruct = pStruct->pNext)
+        HasTimelineInfo = pStruct->sType == VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
 
-    m_TempSignalSemaphores.clear();
-    NewSyncPoint->GetSemaphores(m_TempSignalSemaphores);
+    VERIFY(!HasTimelineInfo || m_TempSignalSemaphores.empty(), "Can not append semaphores when timeline semaphores are used");
 
-#ifdef DILIGENT_DEBUG
-    const VkBaseInStructure* pStruct = static_cast<const VkBaseInStructure*>(InSubmitInfo.pNext);
-    for (; pStruct != nullptr;)
+    const auto NumSyncPointSemaphores = m_TempSignalSemaphores.size();
+    for (uint32_t s = 0; s < InOutInfo.signalSemaphoreCount; ++s)
+        m_TempSignalSemaphores.push_back(InOutInfo.pSignalSemaphores[s]);
+
+    bool TimelineSemaphoreMerged = false;
+    if (m_vkTimelineSemaphore && (pInTimelineInfo != nullptr || !HasTimelineInfo))
     {
-        if (pStruct->sType == VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO)
+        // Values are ignored for binary semaphores
+        m_TempSignalValues.assign(NumSyncPointSemaphores, 0);
+        if (pInTimelineInfo != nullptr && pInTimelineInfo->signalSemaphoreValueCount != 0)
+        {
+            VERIFY_EXPR(pInTimelineInfo->signalSemaphoreValueCount == InOutInfo.signalSemaphoreCount);
+            m_TempSignalValues.insert(m_TempSignalValues.end(), pInTimelineInfo->pSignalSemaphoreValues, pInTimelineInfo->pSignalSemaphoreValues + pInTimelineInfo->signalSemaphoreValueCount);
+        }
+        else
         {
-            VERIFY(m_TempSignalSemaphores.empty(), "Can not append semaphores when timeline semaphores are used");
-            break;
+            m_TempSignalValues.resize(m_TempSignalSemaphores.size(), 0);
         }
-        pStruct = pStruct->pNext;
+
+        m_TempSignalSemaphores.push_back(m_vkTimelineSemaphore);
+        m_TempSignalValues.push_back(FenceValue);
+        VERIFY_EXPR(m_TempSignalValues.size() == m_TempSignalSemaphores.size());
+
+        if (pInTimelineInfo != nullptr)
+        {
+            TimelineSubmitInfo = *pInTimelineInfo;
+        }
+        else
+        {
+            TimelineSubmitInfo                         = {};
+            TimelineSubmitInfo.sType                   = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            TimelineSubmitInfo.pNext                   = InOutInfo.pNext;
+            TimelineSubmitInfo.waitSemaphoreValueCount = 0;
+            TimelineSubmitInfo.pWaitSemaphoreValues    = nullptr;
+        }
+        TimelineSubmitInfo.signalSemaphoreValueCount = static_cast<Uint32>(m_TempSignalValues.size());
+        TimelineSubmitInfo.pSignalSemaphoreValues    = m_TempSignalValues.data();
+
+        InOutInfo.pNext         = &TimelineSubmitInfo;
+        TimelineSemaphoreMerged = true;
     }
-#endif
 
-    for (uint32_t s = 0; s < InSubmitInfo.signalSemaphoreCount; ++s)
-        m_TempSignalSemaphores.push_back(InSubmitInfo.pSignalSemaphores[s]);
+    InOutInfo.signalSemaphoreCount = static_cast<Uint32>(m_TempSignalSemaphores.size());
+    InOutInfo.pSignalSemaphores    = m_TempSignalSemaphores.data();
 
-    VkSubmitInfo SubmitInfo         = InSubmitInfo;
-    SubmitInfo.signalSemaphoreCount = static_cast<Uint32>(m_TempSignalSemaphores.size());
-    SubmitInfo.pSignalSemaphores    = m_TempSignalSemaphores.data();
+    return TimelineSemaphoreMerged || !m_vkTimelineSemaphore;
+}
+
+void CommandQueueVkImpl::UpdateLastCompletedFenceValue(Uint64 Value)
+{
+    auto LastValue = m_LastCompletedFenceValue.load();
+    while (LastValue < Value && !m_LastCompletedFenceValue.compare_exchange_weak(LastValue, Value))
+    {
+    }
+}
+
+Uint64 CommandQueueVkImpl::Submit(const VkSubmitInfo& InSubmitInfo)
+{
+    std::lock_guard<std::mutex> QueueGuard{m_QueueMutex};
+
+    // Increment the value before submitting the buffer to be overly safe
+    const uint64_t FenceValue = m_NextFenceValue.fetch_add(1);
+
+    auto NewSyncPoint = CreateSyncPoint(FenceValue);
+
+    VkSubmitInfo                  SubmitInfo = InSubmitInfo;
+    VkTimelineSemaphoreSubmitInfo TimelineSubmitInfo{};
+    const bool                    TimelineSemaphoreMerged = PrepareSignalSemaphores(SubmitInfo, TimelineSubmitInfo, *NewSyncPoint, FenceValue);
 
     const uint32_t SubmitCount =
         (SubmitInfo.waitSemaphoreCount != 0 ||
@@ -186,12 +297,21 @@ Uint64 CommandQueueVkImpl::Submit(const VkSubmitInfo& InSubmitInfo)
         1 :
         0;
 
-    auto err = vkQueueSubmit(m_VkQueue, SubmitCount, &SubmitInfo, NewSyncPoint->GetFence());
+    // When timeline semaphores are supported, the sync point has no fence and the submission is tracked by the queue semaphore
+    auto err = vkQueueSubmit(m_VkQueue, SubmitCount, &SubmitInfo, NewSyncPoint->m_Fence);
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to submit command buffer to the command queue");
     (void)err;
 
-    VERIFY(m_pFence != nullptr, "Command queue fence has not been initialized");
-    m_pFence->AddPendingSyncPoint(m_CommandQueueId, FenceValue, NewSyncPoint);
+    if (m_vkTimelineSemaphore)
+    {
+        if (!TimelineSemaphoreMerged)
+            InternalSignalSemaphore(m_vkTimelineSemaphore, FenceValue);
+    }
+    else
+    {
+        VERIFY(m_pFence != nullptr, "Command queue fence has not been initialized");
+        m_pFence->AddPendingSyncPoint(m_CommandQueueId, FenceValue, NewSyncPoint);
+    }
 
     // Update the last sync point
     {
@@ -229,16 +349,51 @@ Uint64 CommandQueueVkImpl::WaitForIdle()
     const auto FenceValue = m_NextFenceValue.fetch_add(1);
 
     vkQueueWaitIdle(m_VkQueue);
-    // For some reason after idling the queue not all fences are signaled
-    m_pFence->Wait(UINT64_MAX);
-    m_pFence->Reset(FenceValue);
+
+    if (m_vkTimelineSemaphore)
+    {
+        // All submitted values have been signaled, so the semaphore can be advanced on the host
+        VkSemaphoreSignalInfo SignalInfo{};
+        SignalInfo.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+        SignalInfo.pNext     = nullptr;
+        SignalInfo.semaphore = m_vkTimelineSemaphore;
+        SignalInfo.value     = FenceValue;
+
+        auto err = m_LogicalDevice->SignalSemaphore(SignalInfo);
+        DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to signal command queue timeline semaphore");
+        (void)err;
+
+        UpdateLastCompletedFenceValue(FenceValue);
+    }
+    else
+    {
+        // For some reason after idling the queue not all fences are signaled
+        m_pFence->Wait(UINT64_MAX);
+        m_pFence->Reset(FenceValue);
+    }
 
     return FenceValue;
 }
 
 Uint64 CommandQueueVkImpl::GetCompletedFenceValue()
 {
-    return m_pFence->GetCompletedValue();
+    if (!m_vkTimelineSemaphore)
+        return m_pFence->GetCompletedValue();
+
+    // Skip querying the semaphore if all submitted commands are known to be complete
+    const auto LastCompletedValue = m_LastCompletedFenceValue.load();
+    if (LastCompletedValue + 1 >= m_NextFenceValue.load())
+        return LastCompletedValue;
+
+    // GetSemaphoreCounter() is thread safe and does not require the queue mutex
+    Uint64 SemaphoreCounter = 0;
+    auto   err              = m_LogicalDevice->GetSemaphoreCounter(m_vkTimelineSemaphore, &SemaphoreCounter);
+    DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to get command queue timeline semaphore counter");
+    if (err != VK_SUCCESS)
+        return LastCompletedValue;
+
+    UpdateLastCompletedFenceValue(SemaphoreCounter);
+    return m_LastCompletedFenceValue.load();
 }
 
 void CommandQueueVkImpl::EnqueueSignalFence(VkFence vkFence)
@@ -299,35 +454,24 @@ Uint64 CommandQueueVkImpl::BindSparse(const VkBindSparseInfo& InBindInfo)
 
     auto NewSyncPoint = CreateSyncPoint(FenceValue);
 
-    m_TempSignalSemaphores.clear();
-    NewSyncPoint->GetSemaphores(m_TempSignalSemaphores);
+    VkBindSparseInfo              BindInfo = InBindInfo;
+    VkTimelineSemaphoreSubmitInfo TimelineSubmitInfo{};
+    const bool                    TimelineSemaphoreMerged = PrepareSignalSemaphores(BindInfo, TimelineSubmitInfo, *NewSyncPoint, FenceValue);
 
-#ifdef DILIGENT_DEBUG
-    const VkBaseInStructure* pStruct = static_cast<const VkBaseInStructure*>(InBindInfo.pNext);
-    for (; pStruct != nullptr;)
-    {
-        if (pStruct->sType == VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO)
-        {
-            VERIFY(m_TempSignalSemaphores.empty(), "Can not append semaphores when timeline semaphores are used");
-            break;
-        }
-        pStruct = pStruct->pNext;
-    }
-#endif
-
-    for (uint32_t s = 0; s < InBindInfo.signalSemaphoreCount; ++s)
-        m_TempSignalSemaphores.push_back(InBindInfo.pSignalSemaphores[s]);
-
-    VkBindSparseInfo BindInfo     = InBindInfo;
-    BindInfo.signalSemaphoreCount = static_cast<Uint32>(m_TempSignalSemaphores.size());
-    BindInfo.pSignalSemaphores    = m_TempSignalSemaphores.data();
-
-    auto err = vkQueueBindSparse(m_VkQueue, 1, &BindInfo, NewSyncPoint->GetFence());
+    auto err = vkQueueBindSparse(m_VkQueue, 1, &BindInfo, NewSyncPoint->m_Fence);
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to submit sparse bind commands to the command queue");
     (void)err;
 
-    VERIFY(m_pFence != nullptr, "Command queue fence has not been initialized");
-    m_pFence->AddPendingSyncPoint(m_CommandQueueId, FenceValue, NewSyncPoint);
+    if (m_vkTimelineSemaphore)
+    {
+        if (!TimelineSemaphoreMerged)
+            InternalSignalSemaphore(m_vkTimelineSemaphore, FenceValue);
+    }
+    else
+    {
+        VERIFY(m_pFence != nullptr, "Command queue fence has not been initialized");
+        m_pFence->AddPendingSyncPoint(m_CommandQueueId, FenceValue, NewSyncPoint);
+    }
 
     // Update the last sync point
     {
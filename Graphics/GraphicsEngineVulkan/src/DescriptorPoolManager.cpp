@@ -52,7 +52,11 @@ VulkanUtilities::DescriptorPoolWrapper DescriptorPoolManager::CreateDescriptorPo
     // VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT specifies that descriptor sets can
     // return their individual allocations to the pool, i.e. all of vkAllocateDescriptorSets,
     // vkFreeDescriptorSets, and vkResetDescriptorPool are allowed. (13.2.3)
-    PoolCI.flags         = m_AllowFreeing ? VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT : 0;
+    PoolCI.flags = m_AllowFreeing ? VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT : 0;
+    // Descriptor sets with VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT layout
+    // must be allocated from a pool with VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT.
+    if (m_UpdateAfterBind)
+        PoolCI.flags |= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
     PoolCI.maxSets       = m_MaxSets;
     PoolCI.poolSizeCount = static_cast<uint32_t>(m_PoolSizes.size());
     PoolCI.pPoolSizes    = m_PoolSizes.data();
@@ -64,6 +68,13 @@ static std::vector<VkDescriptorPoolSize> PrunePoolSizes(RenderDeviceVkImpl& Devi
     const auto& Feats = DeviceVkImpl.GetLogicalDevice().GetEnabledExtFeatures();
     for (auto iter = PoolSizes.begin(); iter != PoolSizes.end();)
     {
+        // descriptorCount must be greater than 0 (VUID-VkDescriptorPoolSize-descriptorCount-00302)
+        if (iter->descriptorCount == 0)
+        {
+            iter = PoolSizes.erase(iter);
+            continue;
+        }
+
         switch (iter->type)
         {
             case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
@@ -83,13 +94,15 @@ DescriptorPoolManager::DescriptorPoolManager(RenderDeviceVkImpl&               D
                                              std::string                       PoolName,
                                              std::vector<VkDescriptorPoolSize> PoolSizes,
                                              uint32_t                          MaxSets,
-                                             bool                              AllowFreeing) noexcept :
+                                             bool                              AllowFreeing,
+                                             bool                              UpdateAfterBind) noexcept :
     // clang-format off
-    m_DeviceVkImpl{DeviceVkImpl        },
-    m_PoolName    {std::move(PoolName) },
-    m_PoolSizes   (PrunePoolSizes(DeviceVkImpl, std::move(PoolSizes))),
-    m_MaxSets     {MaxSets             },
-    m_AllowFreeing{AllowFreeing        }
+    m_DeviceVkImpl   {DeviceVkImpl        },
+    m_PoolName       {std::move(PoolName) },
+    m_PoolSizes      (PrunePoolSizes(DeviceVkImpl, std::move(PoolSizes))),
+    m_MaxSets        {MaxSets             },
+    m_AllowFreeing   {AllowFreeing        },
+    m_UpdateAfterBind{UpdateAfterBind     }
 // clang-format on
 {
 #ifdef DILIGENT_DEVELOPMENT
@@ -105,7 +118,7 @@ DescriptorPoolManager::~DescriptorPoolManager()
 
 VulkanUtilities::DescriptorPoolWrapper DescriptorPoolManager::GetPool(const char* DebugName)
 {
-    std::lock_guard<std::mutex> Lock{m_Mutex};
+    std::lock_guard<Threading::EngineMutex> Lock{m_Mutex};
 #ifdef DILIGENT_DEVELOPMENT
     ++m_AllocatedPoolCounter;
 #endif
@@ -163,7 +176,7 @@ void DescriptorPoolManager::DisposePool(VulkanUtilities::DescriptorPoolWrapper&&
 
 void DescriptorPoolManager::FreePool(VulkanUtilities::DescriptorPoolWrapper&& Pool)
 {
-    std::lock_guard<std::mutex> Lock{m_Mutex};
+    std::lock_guard<Threading::EngineMutex> Lock{m_Mutex};
     m_DeviceVkImpl.GetLogicalDevice().ResetDescriptorPool(Pool);
     m_Pools.emplace_back(std::move(Pool));
 #ifdef DILIGENT_DEVELOPMENT
@@ -199,7 +212,7 @@ DescriptorSetAllocation DescriptorSetAllocator::Allocate(Uint64 CommandQueueMask
 {
     // Descriptor pools are externally synchronized, meaning that the application must not allocate
     // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3)
-    std::lock_guard<std::mutex> Lock{m_Mutex};
+    std::lock_guard<Threading::EngineMutex> Lock{m_Mutex};
 
     const auto& LogicalDevice = m_DeviceVkImpl.GetLogicalDevice();
     // Try all pools starting from the frontmost
@@ -270,7 +283,7 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         {
             if (Allocator != nullptr)
             {
-                std::lock_guard<std::mutex> Lock{Allocator->m_Mutex};
+                std::lock_guard<Threading::EngineMutex> Lock{Allocator->m_Mutex};
                 Allocator->m_DeviceVkImpl.GetLogicalDevice().FreeDescriptorSet(Pool, Set);
 #ifdef DILIGENT_DEVELOPMENT
                 --Allocator->m_AllocatedSetCounter;
@@ -302,6 +315,9 @@ VkDescriptorSet DynamicDescriptorSetAllocator::Allocate(VkDescriptorSetLayout Se
         set = AllocateDescriptorSet(LogicalDevice, m_AllocatedPools.back(), SetLayout, DebugName);
     }
 
+    if (set != VK_NULL_HANDLE)
+        ++m_AllocatedSetCount;
+
     return set;
 }
 
@@ -313,6 +329,7 @@ void DynamicDescriptorSetAllocator::ReleasePools(Uint64 QueueMask)
     }
     m_PeakPoolCount = std::max(m_PeakPoolCount, m_AllocatedPools.size());
     m_AllocatedPools.clear();
+    m_AllocatedSetCount = 0;
 }
 
 DynamicDescriptorSetAllocator::~DynamicDescriptorSetAllocator()
@@ -29,6 +29,8 @@
 
 #include "DeviceContextVkImpl.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <sstream>
 #include <vector>
 
@@ -39,6 +41,7 @@
 #include "RenderPassVkImpl.hpp"
 #include "FenceVkImpl.hpp"
 #include "DeviceMemoryVkImpl.hpp"
+#include "QueryArrayVkImpl.hpp"
 
 #include "VulkanTypeConversions.hpp"
 #include "CommandListVkImpl.hpp"
@@ -61,6 +64,14 @@ static std::string GetContextObjectName(const char* Object, bool bIsDeferred, Ui
     return ss.str();
 }
 
+// Returns a new globally unique dynamic descriptor set generation, so that sets
+// committed by one context are never mistaken for sets of another context.
+static Uint64 GetNextDynamicDescrSetEpoch()
+{
+    static std::atomic<Uint64> NextEpoch{1};
+    return NextEpoch.fetch_add(1);
+}
+
 DeviceContextVkImpl::DeviceContextVkImpl(IReferenceCounters*       pRefCounters,
                                          RenderDeviceVkImpl*       pDeviceVkImpl,
                                          const EngineVkCreateInfo& EngineCI,
@@ -98,7 +109,8 @@ DeviceContextVkImpl::DeviceContextVkImpl(IReferenceCounters*       pRefCounters,
     {
         pDeviceVkImpl->GetDynamicDescriptorPool(),
         GetContextObjectName("Dynamic descriptor set allocator", Desc.IsDeferred, Desc.ContextId),
-    }
+    },
+    m_DynamicDescrSetEpoch{GetNextDynamicDescrSetEpoch()}
 // clang-format on
 {
     if (!IsDeferred())
@@ -183,12 +195,13 @@ void DeviceContextVkImpl::PrepareCommandPool(SoftwareQueueIndex CommandQueueId)
     auto& Pool = m_QueueFamilyCmdPools[QueueFamilyIndex];
     if (!Pool)
     {
-        // Command pools must be thread-safe because command buffers are returned into pools by release queues
-        // potentially running in another thread
+        // Command buffers are returned into pools by release queues potentially running in another thread
+        // through a lock-free queue. Command buffers are never reset individually: the pool resets
+        // its Vulkan command pools as a whole.
         Pool = std::make_unique<VulkanUtilities::VulkanCommandBufferPool>(
             m_pDevice->GetLogicalDevice().GetSharedPtr(),
             QueueFamilyIndex,
-            VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+            VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
     }
     m_CmdPool = Pool.get();
 
@@ -212,18 +225,81 @@ void DeviceContextVkImpl::Begin(Uint32 ImmediateContextId)
     m_pQueryMgr = &m_pDevice->GetQueryMgr(CommandQueueId);
 }
 
-void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue)
+void DeviceContextVkImpl::BeginReusable(Uint32 ImmediateContextId)
+{
+    Begin(ImmediateContextId);
+    // The command buffer is begun with VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT (see EnsureVkCmdBuffer())
+    // and is not recycled until the command list object is destroyed (see CommandListVkImpl).
+    m_IsRecordingReusableCommands = true;
+}
+
+void DeviceContextVkImpl::BeginSecondary(Uint32        ImmediateContextId,
+                                         IRenderPass*  pRenderPass,
+                                         Uint32        SubpassIndex,
+                                         IFramebuffer* pFramebuffer)
+{
+    DEV_CHECK_ERR(pRenderPass != nullptr, "Render pass must not be null");
+    DEV_CHECK_ERR(pFramebuffer != nullptr, "Framebuffer must not be null");
+    DEV_CHECK_ERR(SubpassIndex < pRenderPass->GetDesc().SubpassCount, "Subpass index (", SubpassIndex, ") exceeds the number of subpasses (",
+                  pRenderPass->GetDesc().SubpassCount, ") in render pass '", pRenderPass->GetDesc().Name, "'");
+
+    Begin(ImmediateContextId);
+
+    // Make the render pass active in the context without beginning it in the command buffer.
+    // The render pass instance is begun by the immediate context that executes the command list.
+    BeginRenderPassAttribs Attribs;
+    Attribs.pRenderPass         = pRenderPass;
+    Attribs.pFramebuffer        = pFramebuffer;
+    Attribs.StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+    TDeviceContextBase::BeginRenderPass(Attribs);
+    while (m_SubpassIndex < SubpassIndex)
+        TDeviceContextBase::NextSubpass();
+
+    m_vkRenderPass  = m_pActiveRenderPass->GetVkRenderPass();
+    m_vkFramebuffer = m_pBoundFramebuffer->GetVkFramebuffer();
+
+    m_vkSecondaryInheritance             = {};
+    m_vkSecondaryInheritance.sType       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    m_vkSecondaryInheritance.renderPass  = m_vkRenderPass;
+    m_vkSecondaryInheritance.subpass     = SubpassIndex;
+    m_vkSecondaryInheritance.framebuffer = m_vkFramebuffer;
+
+    EnsureVkCmdBuffer();
+
+    // Set the viewport to match the framebuffer size
+    SetViewports(1, nullptr, 0, 0);
+}
+
+void DeviceContextVkImpl::SetSubpassContents(VkSubpassContents Contents)
+{
+    DEV_CHECK_ERR(!IsDeferred(), "Subpass contents can only be set in immediate contexts");
+    DEV_CHECK_ERR(Contents == VK_SUBPASS_CONTENTS_INLINE || Contents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS, "Unexpected subpass contents");
+    m_vkSubpassContents = Contents;
+}
+
+void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue, bool IsSecondary)
 {
-    VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
     VERIFY_EXPR(m_CmdPool != nullptr);
+    DisposeVkCmdBuffer(*m_CmdPool, CmdQueue, vkCmdBuff, FenceValue, IsSecondary);
+}
+
+void DeviceContextVkImpl::DisposeVkCmdBuffer(VulkanUtilities::VulkanCommandBufferPool& CmdPool,
+                                             SoftwareQueueIndex                        CmdQueue,
+                                             VkCommandBuffer                           vkCmdBuff,
+                                             Uint64                                    FenceValue,
+                                             bool                                      IsSecondary)
+{
+    VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
     class CmdBufferRecycler
     {
     public:
         // clang-format off
         CmdBufferRecycler(VkCommandBuffer                           _vkCmdBuff,
-                         VulkanUtilities::VulkanCommandBufferPool& _Pool) noexcept :
-            vkCmdBuff {_vkCmdBuff},
-            Pool      {&_Pool    }
+                         VulkanUtilities::VulkanCommandBufferPool& _Pool,
+                         bool                                      _IsSecondary) noexcept :
+            vkCmdBuff   {_vkCmdBuff  },
+            Pool        {&_Pool      },
+            IsSecondary {_IsSecondary}
         {
             VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
         }
@@ -233,8 +309,9 @@ void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkComm
         CmdBufferRecycler& operator = (      CmdBufferRecycler&&) = delete;
 
         CmdBufferRecycler(CmdBufferRecycler&& rhs) noexcept :
-            vkCmdBuff {rhs.vkCmdBuff},
-            Pool      {rhs.Pool     }
+            vkCmdBuff   {rhs.vkCmdBuff  },
+            Pool        {rhs.Pool       },
+            IsSecondary {rhs.IsSecondary}
         {
             rhs.vkCmdBuff = VK_NULL_HANDLE;
             rhs.Pool      = nullptr;
@@ -245,24 +322,25 @@ void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkComm
         {
             if (Pool != nullptr)
             {
-                Pool->RecycleCommandBuffer(std::move(vkCmdBuff));
+                Pool->RecycleCommandBuffer(std::move(vkCmdBuff), IsSecondary);
             }
         }
 
     private:
-        VkCommandBuffer                           vkCmdBuff = VK_NULL_HANDLE;
-        VulkanUtilities::VulkanCommandBufferPool* Pool      = nullptr;
+        VkCommandBuffer                           vkCmdBuff   = VK_NULL_HANDLE;
+        VulkanUtilities::VulkanCommandBufferPool* Pool        = nullptr;
+        bool                                      IsSecondary = false;
     };
 
     // Discard command buffer directly to the release queue since we know exactly which queue it was submitted to
     // as well as the associated FenceValue.
     auto& ReleaseQueue = m_pDevice->GetReleaseQueue(CmdQueue);
-    ReleaseQueue.DiscardResource(CmdBufferRecycler{vkCmdBuff, *m_CmdPool}, FenceValue);
+    ReleaseQueue.DiscardResource(CmdBufferRecycler{vkCmdBuff, CmdPool, IsSecondary}, FenceValue);
 }
 
 inline void DeviceContextVkImpl::DisposeCurrentCmdBuffer(SoftwareQueueIndex CmdQueue, Uint64 FenceValue)
 {
-    VERIFY(m_CommandBuffer.GetState().RenderPass == VK_NULL_HANDLE, "Disposing command buffer with unfinished render pass");
+    VERIFY(!m_CommandBuffer.GetState().InsideRenderPass(), "Disposing command buffer with unfinished render pass");
     auto vkCmdBuff = m_CommandBuffer.GetVkCmdBuffer();
     if (vkCmdBuff != VK_NULL_HANDLE)
     {
@@ -274,12 +352,20 @@ inline void DeviceContextVkImpl::DisposeCurrentCmdBuffer(SoftwareQueueIndex CmdQ
 
 void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_SET_PIPELINE_STATE);
+
+    // Avoid QueryInterface and AddRef/Release when the same PSO is bound again
+    if (IsBoundPipelineState(pPipelineState))
+        return;
+
     RefCntAutoPtr<PipelineStateVkImpl> pPipelineStateVk{pPipelineState, PipelineStateVkImpl::IID_InternalImpl};
     VERIFY(pPipelineState == nullptr || pPipelineStateVk != nullptr, "Unknown pipeline state object implementation");
     if (PipelineStateVkImpl::IsSameObject(m_pPipelineState, pPipelineStateVk))
         return;
 
     const auto& PSODesc = pPipelineStateVk->GetDesc();
+    DEV_CHECK_ERR(pPipelineStateVk->GetStatus() == PIPELINE_STATE_STATUS_READY, "Pipeline state '", PSODesc.Name,
+                  "' is not ready and can't be bound. Use IPipelineState::GetStatus() to check the pipeline status.");
 
     bool CommitStates  = false;
     bool CommitScissor = false;
@@ -317,6 +403,11 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
             auto& GraphicsPipeline = m_pPipelineState->GetGraphicsPipelineDesc();
             m_CommandBuffer.BindGraphicsPipeline(vkPipeline);
 
+            // Dynamic states are reset to the values from the pipeline description
+            // every time a new pipeline is bound.
+            if (GraphicsPipeline.DynamicStateFlags != PIPELINE_DYNAMIC_STATE_FLAG_NONE)
+                CommitDynamicStates(GraphicsPipeline);
+
             if (CommitStates)
             {
                 m_CommandBuffer.SetStencilReference(m_StencilRef);
@@ -354,39 +445,51 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
     const auto  SignCount = m_pPipelineState->GetResourceSignatureCount();
     auto&       BindInfo  = GetBindInfo(PSODesc.PipelineType);
 
+    BindInfo.vkPipelineLayout = Layout.GetVkPipelineLayout();
+
     Uint32 DvpCompatibleSRBCount = 0;
-    PrepareCommittedResources(BindInfo, DvpCompatibleSRBCount);
-#ifdef DILIGENT_DEVELOPMENT
-    for (auto sign = DvpCompatibleSRBCount; sign < SignCount; ++sign)
+    if (PrepareCommittedResources(BindInfo, DvpCompatibleSRBCount))
     {
-        // Do not clear DescriptorSetBaseInd and DynamicOffsetCount!
-        BindInfo.SetInfo[sign].vkSets.fill(VK_NULL_HANDLE);
-    }
+#ifdef DILIGENT_DEVELOPMENT
+        for (auto sign = DvpCompatibleSRBCount; sign < SignCount; ++sign)
+        {
+            // Do not clear DescriptorSetBaseInd and DynamicOffsetCount!
+            BindInfo.SetInfo[sign].vkSets.fill(VK_NULL_HANDLE);
+        }
 #endif
 
-    BindInfo.vkPipelineLayout = Layout.GetVkPipelineLayout();
+        BindInfo.TotalDynamicOffsetCount = 0;
+        BindInfo.BoundDynamicOffsetsMask = 0;
+        for (Uint32 i = 0; i < SignCount; ++i)
+        {
+            auto& SetInfo = BindInfo.SetInfo[i];
 
-    Uint32 TotalDynamicOffsetCount = 0;
-    for (Uint32 i = 0; i < SignCount; ++i)
-    {
-        auto& SetInfo = BindInfo.SetInfo[i];
+            auto* pSignature = m_pPipelineState->GetResourceSignature(i);
+            if (pSignature == nullptr || pSignature->GetNumDescriptorSets() == 0)
+            {
+                SetInfo = {};
+                continue;
+            }
 
-        auto* pSignature = m_pPipelineState->GetResourceSignature(i);
-        if (pSignature == nullptr || pSignature->GetNumDescriptorSets() == 0)
-        {
-            SetInfo = {};
-            continue;
-        }
+            VERIFY_EXPR(BindInfo.ActiveSRBMask & (1u << i));
 
-        VERIFY_EXPR(BindInfo.ActiveSRBMask & (1u << i));
+            SetInfo.BaseInd            = Layout.GetFirstDescrSetIndex(pSignature->GetDesc().BindingIndex);
+            SetInfo.DynamicOffsetCount = pSignature->GetDynamicOffsetCount();
+            SetInfo.DynamicOffsetStart = BindInfo.TotalDynamicOffsetCount;
+            BindInfo.TotalDynamicOffsetCount += SetInfo.DynamicOffsetCount;
+        }
 
-        SetInfo.BaseInd            = Layout.GetFirstDescrSetIndex(pSignature->GetDesc().BindingIndex);
-        SetInfo.DynamicOffsetCount = pSignature->GetDynamicOffsetCount();
-        TotalDynamicOffsetCount += SetInfo.DynamicOffsetCount;
+        m_BoundDynamicBufferOffsets[GetBindPointIndex(BindInfo)].resize(BindInfo.TotalDynamicOffsetCount);
+    }
+    else
+    {
+        // The pipeline uses the same resource signatures, so descriptor set base indices and
+        // dynamic offset counts are the same, and the bound descriptor sets remain valid.
     }
 
-    // Reserve space to store all dynamic buffer offsets
-    m_DynamicBufferOffsets.resize(TotalDynamicOffsetCount);
+    // Reserve space to store all dynamic buffer offsets.
+    // Note that the space is shared by all bind points, so it must be resized every time.
+    m_DynamicBufferOffsets.resize(BindInfo.TotalDynamicOffsetCount);
 }
 
 DeviceContextVkImpl::ResourceBindInfo& DeviceContextVkImpl::GetBindInfo(PIPELINE_TYPE Type)
@@ -412,13 +515,46 @@ DeviceContextVkImpl::ResourceBindInfo& DeviceContextVkImpl::GetBindInfo(PIPELINE
     return m_BindInfo[Indices[Uint32{Type}]];
 }
 
+size_t DeviceContextVkImpl::GetBindPointIndex(const ResourceBindInfo& BindInfo) const
+{
+    const auto BindPointIdx = static_cast<size_t>(&BindInfo - m_BindInfo.data());
+    VERIFY_EXPR(BindPointIdx < m_BindInfo.size());
+    return BindPointIdx;
+}
+
 void DeviceContextVkImpl::CommitDescriptorSets(ResourceBindInfo& BindInfo, Uint32 CommitSRBMask)
 {
     VERIFY(CommitSRBMask != 0, "This method should not be called when there is nothing to commit");
 
+    VERIFY_EXPR(PlatformMisc::GetMSB(CommitSRBMask) < m_pPipelineState->GetResourceSignatureCount());
+
+    auto& BoundOffsets = m_BoundDynamicBufferOffsets[GetBindPointIndex(BindInfo)];
+
+    // The descriptor sets of the SRBs that are not stale are still bound, and these SRBs are only
+    // committed again to update the dynamic offsets. Skip the SRBs whose offsets have not changed
+    // since the last bind, e.g. because their dynamic buffers have not been mapped again.
+    for (Uint32 DynamicOnlyMask = CommitSRBMask & BindInfo.BoundDynamicOffsetsMask & ~Uint32{BindInfo.StaleSRBMask}; DynamicOnlyMask != 0;)
+    {
+        const auto  SignBit = ExtractLSB(DynamicOnlyMask);
+        const auto  sign    = PlatformMisc::GetLSB(SignBit);
+        const auto& SetInfo = BindInfo.SetInfo[sign];
+
+        const auto* pResourceCache = BindInfo.ResourceCaches[sign];
+        VERIFY_EXPR(pResourceCache != nullptr);
+        VERIFY_EXPR(m_DynamicBufferOffsets.size() >= SetInfo.DynamicOffsetCount);
+
+        pResourceCache->GetDynamicBufferOffsets(GetContextId(), m_DynamicBufferOffsets, 0);
+        if (std::equal(m_DynamicBufferOffsets.begin(), m_DynamicBufferOffsets.begin() + SetInfo.DynamicOffsetCount,
+                       BoundOffsets.begin() + SetInfo.DynamicOffsetStart))
+        {
+            CommitSRBMask &= ~SignBit;
+        }
+    }
+    if (CommitSRBMask == 0)
+        return;
+
     const auto FirstSign = PlatformMisc::GetLSB(CommitSRBMask);
     const auto LastSign  = PlatformMisc::GetMSB(CommitSRBMask);
-    VERIFY_EXPR(LastSign < m_pPipelineState->GetResourceSignatureCount());
 
     // Bind all descriptor sets in a single BindDescriptorSets call
     uint32_t   DynamicOffsetCount = 0;
@@ -455,8 +591,11 @@ void DeviceContextVkImpl::CommitDescriptorSets(ResourceBindInfo& BindInfo, Uint3
 
             auto NumOffsetsWritten = pResourceCache->GetDynamicBufferOffsets(GetContextId(), m_DynamicBufferOffsets, DynamicOffsetCount);
             VERIFY_EXPR(NumOffsetsWritten == SetInfo.DynamicOffsetCount);
+            std::copy(m_DynamicBufferOffsets.begin() + DynamicOffsetCount, m_DynamicBufferOffsets.begin() + DynamicOffsetCount + SetInfo.DynamicOffsetCount,
+                      BoundOffsets.begin() + SetInfo.DynamicOffsetStart);
             DynamicOffsetCount += SetInfo.DynamicOffsetCount;
         }
+        BindInfo.BoundDynamicOffsetsMask |= static_cast<ResourceBindInfo::SRBMaskType>(1u << sign);
 
 #ifdef DILIGENT_DEVELOPMENT
         SetInfo.LastBoundBaseInd = SetInfo.BaseInd;
@@ -529,6 +668,8 @@ void DeviceContextVkImpl::TransitionShaderResources(IPipelineState*, IShaderReso
 
 void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_COMMIT_SHADER_RESOURCES);
+
     TDeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/);
 
     auto* pResBindingVkImpl = ClassPtrCast<ShaderResourceBindingVkImpl>(pShaderResourceBinding);
@@ -581,20 +722,29 @@ void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
 
         const auto vkLayout = pSignature->GetVkDescriptorSetLayout(PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC);
 
-        VkDescriptorSet vkDynamicDescrSet   = VK_NULL_HANDLE;
-        const char*     DynamicDescrSetName = "Dynamic Descriptor Set";
+        DEV_CHECK_ERR(!IsDeferred() || !IsRecordingReusableCommands(), "Resource signature '", pSignature->GetDesc().Name, "' contains dynamic shader resource variables. Dynamic variables are not allowed in reusable command lists as their descriptor sets are recycled at the end of the frame.");
+
+        // Reuse the set written by the previous commit if no dynamic resource has changed since then
+        const Uint32    DynamicSetBit     = Uint32{1} << DSIndex;
+        VkDescriptorSet vkDynamicDescrSet = ResourceCache.GetCommittedDynamicSet(m_DynamicDescrSetEpoch);
+        if (vkDynamicDescrSet == VK_NULL_HANDLE || (ResourceCache.GetDirtySetMask() & DynamicSetBit) != 0)
+        {
+            const char* DynamicDescrSetName = "Dynamic Descriptor Set";
 #ifdef DILIGENT_DEVELOPMENT
-        String _DynamicDescrSetName{DynamicDescrSetName};
-        _DynamicDescrSetName.append(" (");
-        _DynamicDescrSetName.append(pSignature->GetDesc().Name);
-        _DynamicDescrSetName += ')';
-        DynamicDescrSetName = _DynamicDescrSetName.c_str();
+            String _DynamicDescrSetName{DynamicDescrSetName};
+            _DynamicDescrSetName.append(" (");
+            _DynamicDescrSetName.append(pSignature->GetDesc().Name);
+            _DynamicDescrSetName += ')';
+            DynamicDescrSetName = _DynamicDescrSetName.c_str();
 #endif
-        // Allocate vulkan descriptor set for dynamic resources
-        vkDynamicDescrSet = AllocateDynamicDescriptorSet(vkLayout, DynamicDescrSetName);
+            // Allocate vulkan descriptor set for dynamic resources
+            vkDynamicDescrSet = AllocateDynamicDescriptorSet(vkLayout, DynamicDescrSetName);
 
-        // Write all dynamic resource descriptors
-        pSignature->CommitDynamicResources(ResourceCache, vkDynamicDescrSet);
+            // Write all dynamic resource descriptors
+            ResourceCache.ClearDirtySetMask(DynamicSetBit);
+            pSignature->CommitDynamicResources(ResourceCache, vkDynamicDescrSet, m_DescriptorUpdateData);
+            ResourceCache.SetCommittedDynamicSet(vkDynamicDescrSet, m_DynamicDescrSetEpoch);
+        }
 
         SetInfo.vkSets[DSIndex] = vkDynamicDescrSet;
         ++DSIndex;
@@ -722,8 +872,8 @@ void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
     if ((Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
         DvpVerifyRenderTargets();
 
-    VERIFY(m_vkRenderPass != VK_NULL_HANDLE, "No render pass is active while executing draw command");
-    VERIFY(m_vkFramebuffer != VK_NULL_HANDLE, "No framebuffer is bound while executing draw command");
+    VERIFY(m_UseDynamicRendering || m_vkRenderPass != VK_NULL_HANDLE, "No render pass is active while executing draw command");
+    VERIFY(m_UseDynamicRendering || m_vkFramebuffer != VK_NULL_HANDLE, "No framebuffer is bound while executing draw command");
 #endif
 
     EnsureVkCmdBuffer();
@@ -747,6 +897,8 @@ void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
 #endif
 
     auto& BindInfo = GetBindInfo(PIPELINE_TYPE_GRAPHICS);
+    if ((BindInfo.InlineConstantsSRBMask & BindInfo.ActiveSRBMask) != 0)
+        UpdateInlineConstantBuffers(BindInfo);
     // First time we must always bind descriptor sets with dynamic offsets as SRBs are stale.
     // If there are no dynamic buffers bound in the resource cache, for all subsequent
     // calls we do not need to bind the sets again.
@@ -762,7 +914,9 @@ void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
     if (m_pPipelineState->GetGraphicsPipelineDesc().pRenderPass == nullptr)
     {
 #ifdef DILIGENT_DEVELOPMENT
-        if (m_pPipelineState->GetRenderPass()->GetVkRenderPass() != m_vkRenderPass)
+        if (m_UseDynamicRendering ?
+                !m_pPipelineState->UsesDynamicRendering() :
+                m_pPipelineState->GetRenderPass()->GetVkRenderPass() != m_vkRenderPass)
         {
             // Note that different Vulkan render passes may still be compatible,
             // so we should only verify implicit render passes
@@ -809,7 +963,11 @@ void DeviceContextVkImpl::PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE Ind
 
 void DeviceContextVkImpl::Draw(const DrawAttribs& Attribs)
 {
-    DvpVerifyDrawArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawArguments(Attribs))
+        return;
 
     PrepareForDraw(Attribs.Flags);
 
@@ -822,7 +980,11 @@ void DeviceContextVkImpl::Draw(const DrawAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
-    DvpVerifyDrawIndexedArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawIndexedArguments(Attribs))
+        return;
 
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
 
@@ -835,7 +997,11 @@ void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 {
-    DvpVerifyDrawIndirectArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawIndirectArguments(Attribs))
+        return;
 
     // We must prepare indirect draw attribs buffer first because state transitions must
     // be performed outside of render pass, and PrepareForDraw commits render pass
@@ -870,7 +1036,11 @@ void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs)
 {
-    DvpVerifyDrawIndexedIndirectArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawIndexedIndirectArguments(Attribs))
+        return;
 
     // We must prepare indirect draw attribs buffer first because state transitions must
     // be performed outside of render pass, and PrepareForDraw commits render pass
@@ -905,7 +1075,11 @@ void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
 
 void DeviceContextVkImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
-    DvpVerifyDrawMeshArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawMeshArguments(Attribs))
+        return;
 
     PrepareForDraw(Attribs.Flags);
 
@@ -918,7 +1092,11 @@ void DeviceContextVkImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs)
 {
-    DvpVerifyDrawMeshIndirectArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyDrawMeshIndirectArguments(Attribs))
+        return;
 
     // We must prepare indirect draw attribs buffer first because state transitions must
     // be performed outside of render pass, and PrepareForDraw commits render pass
@@ -952,15 +1130,112 @@ void DeviceContextVkImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attrib
     ++m_State.NumCommands;
 }
 
+void DeviceContextVkImpl::MultiDraw(const MultiDrawAttribs& Attribs)
+{
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyMultiDrawArguments(Attribs))
+        return;
+
+    PrepareForDraw(Attribs.Flags);
+
+    if (Attribs.DrawCount == 0 || Attribs.NumInstances == 0)
+        return;
+
+    if ((m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW) != 0)
+    {
+        m_MultiDrawInfo.resize(Attribs.DrawCount);
+        for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+        {
+            const auto& Item               = Attribs.pDrawItems[i];
+            m_MultiDrawInfo[i].firstVertex = Item.StartVertexLocation;
+            m_MultiDrawInfo[i].vertexCount = Item.NumVertices;
+        }
+
+        const Uint32 MaxDrawCount = m_pDevice->GetPhysicalDevice().GetExtProperties().MultiDraw.maxMultiDrawCount;
+        VERIFY_EXPR(MaxDrawCount > 0);
+        for (Uint32 FirstDraw = 0; FirstDraw < Attribs.DrawCount;)
+        {
+            const Uint32 DrawCount = std::min(Attribs.DrawCount - FirstDraw, MaxDrawCount);
+            m_CommandBuffer.DrawMulti(DrawCount, &m_MultiDrawInfo[FirstDraw], Attribs.NumInstances, Attribs.FirstInstanceLocation);
+            FirstDraw += DrawCount;
+        }
+        ++m_State.NumCommands;
+    }
+    else
+    {
+        for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+        {
+            const auto& Item = Attribs.pDrawItems[i];
+            if (Item.NumVertices > 0)
+            {
+                m_CommandBuffer.Draw(Item.NumVertices, Attribs.NumInstances, Item.StartVertexLocation, Attribs.FirstInstanceLocation);
+                ++m_State.NumCommands;
+            }
+        }
+    }
+}
+
+void DeviceContextVkImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
+{
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DRAW);
+    ++m_FrameStats.DrawCount;
+
+    if (!VerifyMultiDrawIndexedArguments(Attribs))
+        return;
+
+    PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
+
+    if (Attribs.DrawCount == 0 || Attribs.NumInstances == 0)
+        return;
+
+    if ((m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW) != 0)
+    {
+        m_MultiDrawIndexedInfo.resize(Attribs.DrawCount);
+        for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+        {
+            const auto& Item                       = Attribs.pDrawItems[i];
+            m_MultiDrawIndexedInfo[i].firstIndex   = Item.FirstIndexLocation;
+            m_MultiDrawIndexedInfo[i].indexCount   = Item.NumIndices;
+            m_MultiDrawIndexedInfo[i].vertexOffset = static_cast<int32_t>(Item.BaseVertex);
+        }
+
+        const Uint32 MaxDrawCount = m_pDevice->GetPhysicalDevice().GetExtProperties().MultiDraw.maxMultiDrawCount;
+        VERIFY_EXPR(MaxDrawCount > 0);
+        for (Uint32 FirstDraw = 0; FirstDraw < Attribs.DrawCount;)
+        {
+            const Uint32 DrawCount = std::min(Attribs.DrawCount - FirstDraw, MaxDrawCount);
+            m_CommandBuffer.DrawMultiIndexed(DrawCount, &m_MultiDrawIndexedInfo[FirstDraw], Attribs.NumInstances, Attribs.FirstInstanceLocation);
+            FirstDraw += DrawCount;
+        }
+        ++m_State.NumCommands;
+    }
+    else
+    {
+        for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+        {
+            const auto& Item = Attribs.pDrawItems[i];
+            if (Item.NumIndices > 0)
+            {
+                m_CommandBuffer.DrawIndexed(Item.NumIndices, Attribs.NumInstances, Item.FirstIndexLocation, Item.BaseVertex, Attribs.FirstInstanceLocation);
+                ++m_State.NumCommands;
+            }
+        }
+    }
+}
+
 void DeviceContextVkImpl::PrepareForDispatchCompute()
 {
     EnsureVkCmdBuffer();
 
     // Dispatch commands must be executed outside of render pass
-    if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+    if (m_CommandBuffer.GetState().InsideRenderPass())
         m_CommandBuffer.EndRenderPass();
 
     auto& BindInfo = GetBindInfo(PIPELINE_TYPE_COMPUTE);
+    if ((BindInfo.InlineConstantsSRBMask & BindInfo.ActiveSRBMask) != 0)
+        UpdateInlineConstantBuffers(BindInfo);
     if (Uint32 CommitMask = BindInfo.GetCommitMask())
     {
         CommitDescriptorSets(BindInfo, CommitMask);
@@ -977,6 +1252,8 @@ void DeviceContextVkImpl::PrepareForRayTracing()
     EnsureVkCmdBuffer();
 
     auto& BindInfo = GetBindInfo(PIPELINE_TYPE_RAY_TRACING);
+    if ((BindInfo.InlineConstantsSRBMask & BindInfo.ActiveSRBMask) != 0)
+        UpdateInlineConstantBuffers(BindInfo);
     if (Uint32 CommitMask = BindInfo.GetCommitMask())
     {
         CommitDescriptorSets(BindInfo, CommitMask);
@@ -990,7 +1267,11 @@ void DeviceContextVkImpl::PrepareForRayTracing()
 
 void DeviceContextVkImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
-    DvpVerifyDispatchArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DISPATCH);
+    ++m_FrameStats.DispatchCount;
+
+    if (!VerifyDispatchArguments(Attribs))
+        return;
 
     PrepareForDispatchCompute();
 
@@ -1003,7 +1284,11 @@ void DeviceContextVkImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 
 void DeviceContextVkImpl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs)
 {
-    DvpVerifyDispatchIndirectArguments(Attribs);
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_DISPATCH);
+    ++m_FrameStats.DispatchCount;
+
+    if (!VerifyDispatchIndirectArguments(Attribs))
+        return;
 
     PrepareForDispatchCompute();
 
@@ -1049,6 +1334,29 @@ void DeviceContextVkImpl::ClearDepthStencil(ITextureView*                  pView
 
     auto* pVkDSV = ClassPtrCast<ITextureViewVk>(pView);
 
+    if (pVkDSV == m_pBoundDepthStencil && CanDeferImplicitLoadOps())
+    {
+        // The implicit render pass has not begun yet, so defer the clear
+        // and perform it with the load operation when the pass begins.
+        TransitionRenderTargets(StateTransitionMode);
+
+        auto& ClearValue = m_ImplicitClearValues[MAX_RENDER_TARGETS].depthStencil;
+        if (ClearFlags & CLEAR_DEPTH_FLAG)
+        {
+            m_ImplicitAttachmentOps.DepthLoadOp = ATTACHMENT_LOAD_OP_CLEAR;
+            ClearValue.depth                    = fDepth;
+        }
+        if (ClearFlags & CLEAR_STENCIL_FLAG)
+        {
+            m_ImplicitAttachmentOps.StencilLoadOp = ATTACHMENT_LOAD_OP_CLEAR;
+            ClearValue.stencil                    = Stencil;
+        }
+        m_HasPendingLoadOps = true;
+
+        ++m_State.NumCommands;
+        return;
+    }
+
     EnsureVkCmdBuffer();
 
     const auto& ViewDesc = pVkDSV->GetDesc();
@@ -1060,7 +1368,7 @@ void DeviceContextVkImpl::ClearDepthStencil(ITextureView*                  pView
            "checks if the DSV is bound as a framebuffer attachment and triggers an assert otherwise (in development mode).");
     if (ClearAsAttachment)
     {
-        VERIFY_EXPR(m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE);
+        VERIFY_EXPR(m_UseDynamicRendering || (m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE));
         if (m_pActiveRenderPass == nullptr)
         {
             // Render pass may not be currently committed
@@ -1092,7 +1400,7 @@ void DeviceContextVkImpl::ClearDepthStencil(ITextureView*                  pView
     else
     {
         // End render pass to clear the buffer with vkCmdClearDepthStencilImage
-        if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+        if (m_CommandBuffer.GetState().InsideRenderPass())
             m_CommandBuffer.EndRenderPass();
 
         auto* pTexture   = pVkDSV->GetTexture();
@@ -1154,8 +1462,6 @@ void DeviceContextVkImpl::ClearRenderTarget(ITextureView* pView, const float* RG
     if (RGBA == nullptr)
         RGBA = Zero;
 
-    EnsureVkCmdBuffer();
-
     const auto& ViewDesc = pVkRTV->GetDesc();
     VERIFY(ViewDesc.TextureDim != RESOURCE_DIM_TEX_3D, "Render target view of a 3D texture should've been created as 2D texture array view");
 
@@ -1172,13 +1478,29 @@ void DeviceContextVkImpl::ClearRenderTarget(ITextureView* pView, const float* RG
         }
     }
 
+    if (attachmentIndex != InvalidAttachmentIndex && CanDeferImplicitLoadOps())
+    {
+        // The implicit render pass has not begun yet, so defer the clear
+        // and perform it with the load operation when the pass begins.
+        TransitionRenderTargets(StateTransitionMode);
+
+        m_ImplicitAttachmentOps.RTVLoadOps[attachmentIndex] = ATTACHMENT_LOAD_OP_CLEAR;
+        m_ImplicitClearValues[attachmentIndex].color        = ClearValueToVkClearValue(RGBA, ViewDesc.Format);
+        m_HasPendingLoadOps                                 = true;
+
+        ++m_State.NumCommands;
+        return;
+    }
+
+    EnsureVkCmdBuffer();
+
     VERIFY(m_pActiveRenderPass == nullptr || attachmentIndex != InvalidAttachmentIndex,
            "Render target was not found in the framebuffer. This is unexpected because TDeviceContextBase::ClearRenderTarget "
            "checks if the RTV is bound as a framebuffer attachment and triggers an assert otherwise (in development mode).");
 
     if (attachmentIndex != InvalidAttachmentIndex)
     {
-        VERIFY_EXPR(m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE);
+        VERIFY_EXPR(m_UseDynamicRendering || (m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE));
         if (m_pActiveRenderPass == nullptr)
         {
             // Render pass may not be currently committed
@@ -1212,7 +1534,7 @@ void DeviceContextVkImpl::ClearRenderTarget(ITextureView* pView, const float* RG
         VERIFY(m_pActiveRenderPass == nullptr, "This branch should never execute inside a render pass.");
 
         // End current render pass and clear the image with vkCmdClearColorImage
-        if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+        if (m_CommandBuffer.GetState().InsideRenderPass())
             m_CommandBuffer.EndRenderPass();
 
         auto* pTexture   = pVkRTV->GetTexture();
@@ -1286,6 +1608,11 @@ void DeviceContextVkImpl::FinishFrame()
     const Uint64 QueueMask = GetSubmittedBuffersCmdQueueMask();
     VERIFY_EXPR(IsDeferred() || QueueMask == (Uint64{1} << GetCommandQueueId()));
 
+    m_FrameStats.BarrierCount              = m_CommandBuffer.ExtractBarrierCount();
+    m_FrameStats.DynamicHeapBytes          = m_DynamicHeap.GetCurrUsedSize();
+    m_FrameStats.UploadHeapBytes           = m_UploadHeap.GetCurrFrameSize();
+    m_FrameStats.DescriptorAllocationCount = m_DynamicDescrSetAllocator.GetAllocatedSetCount();
+
     // Release resources used by the context during this frame.
 
     // Upload heap returns all allocated pages to the global memory manager.
@@ -1302,6 +1629,15 @@ void DeviceContextVkImpl::FinishFrame()
     // Note: as global pool manager is hosted by the render device, the allocator can
     // be destroyed before the pools are actually returned to the global pool manager.
     m_DynamicDescrSetAllocator.ReleasePools(QueueMask);
+    // Sets committed by SRBs during this frame must not be reused
+    m_DynamicDescrSetEpoch = GetNextDynamicDescrSetEpoch();
+
+    if (!IsDeferred() && GetContextId() == 0)
+        m_pDevice->GetDynamicMemoryManager().EndFrame();
+
+    // Submit the initial data copies of the resources created during this frame
+    if (!IsDeferred())
+        m_pDevice->FlushInitialDataBatch(GetCommandQueueId());
 
     EndFrame();
 }
@@ -1323,11 +1659,11 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr,
                   "Flushing device context inside an active render pass.");
 
-    // TODO: replace with small_vector
-    std::vector<VkCommandBuffer>               vkCmdBuffs;
-    std::vector<RefCntAutoPtr<IDeviceContext>> DeferredCtxs;
-    vkCmdBuffs.reserve(size_t{NumCommandLists} + 1);
-    DeferredCtxs.reserve(size_t{NumCommandLists} + 1);
+    if (m_HasPendingLoadOps)
+        FlushPendingLoadOps();
+
+    auto vkCmdBuffs   = MakeFrameVector<VkCommandBuffer>(size_t{NumCommandLists} + 1);
+    auto DeferredCtxs = MakeFrameVector<RefCntAutoPtr<IDeviceContext>>(size_t{NumCommandLists} + 1);
 
     auto vkCmdBuff = m_CommandBuffer.GetVkCmdBuffer();
     if (vkCmdBuff != VK_NULL_HANDLE)
@@ -1342,11 +1678,15 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
 
         if (m_State.NumCommands != 0)
         {
-            if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+            if (m_CommandBuffer.GetState().InsideRenderPass())
             {
                 m_CommandBuffer.EndRenderPass();
             }
 
+            // Predication is not inherited by the next command buffer
+            if (m_CommandBuffer.GetState().ConditionalRendering)
+                m_CommandBuffer.EndConditionalRendering();
+
 #ifdef DILIGENT_DEVELOPMENT
             DEV_CHECK_ERR(m_DvpDebugGroupCount == 0, "Not all debug groups have been ended");
             m_DvpDebugGroupCount = 0;
@@ -1365,8 +1705,17 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
         auto* pCmdListVk = ClassPtrCast<CommandListVkImpl>(ppCommandLists[i]);
         DEV_CHECK_ERR(pCmdListVk != nullptr, "Command list must not be null");
         DEV_CHECK_ERR(pCmdListVk->GetQueueId() == GetDesc().QueueId, "Command list recorded for QueueId ", pCmdListVk->GetQueueId(), ", but executed on QueueId ", GetDesc().QueueId, ".");
+        DEV_CHECK_ERR(!pCmdListVk->IsSecondary(), "Secondary command lists can only be executed inside a render pass");
         DeferredCtxs.emplace_back();
         vkCmdBuffs.emplace_back();
+        if (pCmdListVk->IsReusable())
+        {
+            // Reusable command lists keep their command buffers
+            vkCmdBuffs.back()   = pCmdListVk->GetVkCmdBuffer();
+            DeferredCtxs.back() = pCmdListVk->GetDeferredContext();
+            VERIFY(vkCmdBuffs.back() != VK_NULL_HANDLE, "Trying to execute empty command buffer");
+            continue;
+        }
         pCmdListVk->Close(DeferredCtxs.back(), vkCmdBuffs.back());
         VERIFY(vkCmdBuffs.back() != VK_NULL_HANDLE, "Trying to execute empty command buffer");
         VERIFY_EXPR(DeferredCtxs.back() != nullptr);
@@ -1489,12 +1838,29 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
         auto pDeferredCtxVkImpl = DeferredCtxs[i].RawPtr<DeviceContextVkImpl>();
         // Set the bit in the deferred context cmd queue mask corresponding to cmd queue of this context
         pDeferredCtxVkImpl->UpdateSubmittedBuffersCmdQueueMask(GetCommandQueueId());
+
+        auto* pCmdListVk = ClassPtrCast<CommandListVkImpl>(ppCommandLists[i]);
+        if (pCmdListVk->IsReusable())
+        {
+            // The command buffer is disposed when the command list is destroyed
+            pCmdListVk->SetLastSubmittedFenceValue(GetCommandQueueId(), SubmittedFenceValue);
+            continue;
+        }
         // It is OK to dispose command buffer from another thread. We are not going to
         // record any commands and only need to add the buffer to the queue
         pDeferredCtxVkImpl->DisposeVkCmdBuffer(GetCommandQueueId(), std::move(vkCmdBuffs[buff_idx]), SubmittedFenceValue);
     }
     VERIFY_EXPR(buff_idx == vkCmdBuffs.size());
 
+    // Secondary command buffers were executed by the primary command buffer that has just been submitted
+    VERIFY(m_PendingSecondaryCmdBuffs.empty() || vkCmdBuff != VK_NULL_HANDLE, "Secondary command buffers must have been executed by the current command buffer");
+    for (auto& Pending : m_PendingSecondaryCmdBuffs)
+    {
+        auto pDeferredCtxVkImpl = Pending.first.RawPtr<DeviceContextVkImpl>();
+        pDeferredCtxVkImpl->DisposeVkCmdBuffer(GetCommandQueueId(), Pending.second, SubmittedFenceValue, /*IsSecondary = */ true);
+    }
+    m_PendingSecondaryCmdBuffs.clear();
+
     m_State    = {};
     m_BindInfo = {};
     m_CommandBuffer.Reset();
@@ -1534,7 +1900,12 @@ void DeviceContextVkImpl::InvalidateState()
     m_vkRenderPass  = VK_NULL_HANDLE;
     m_vkFramebuffer = VK_NULL_HANDLE;
 
-    VERIFY(m_CommandBuffer.GetState().RenderPass == VK_NULL_HANDLE, "Invalidating context with unfinished render pass");
+    m_UseDynamicRendering = false;
+
+    m_ImplicitAttachmentOps = {};
+    m_HasPendingLoadOps     = false;
+
+    VERIFY(!m_CommandBuffer.GetState().InsideRenderPass(), "Invalidating context with unfinished render pass");
     m_CommandBuffer.Reset();
 }
 
@@ -1645,9 +2016,30 @@ void DeviceContextVkImpl::TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE
     VERIFY(StateTransitionMode != RESOURCE_STATE_TRANSITION_MODE_TRANSITION || m_pActiveRenderPass == nullptr,
            "State transitions are not allowed inside a render pass.");
 
+    // Pending load operations must not begin the render pass before the attachments are transitioned.
+    // All attachments are already in the required states when load operations are pending, so
+    // the clears executed later by the render pass do not need to precede these transitions.
+    bool HasPendingLoadOps = m_HasPendingLoadOps;
+    m_HasPendingLoadOps    = false;
+
+    // The contents of the attachments in undefined state do not need to be loaded
+    const bool InferLoadOps = StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION && CanDeferImplicitLoadOps();
+    auto       IsUndefined  = [](const TextureVkImpl& Tex) {
+        return Tex.IsInKnownState() && Tex.GetState() == RESOURCE_STATE_UNDEFINED;
+    };
+
     if (m_pBoundDepthStencil)
     {
         auto* pDepthBufferVk = m_pBoundDepthStencil->GetTexture<TextureVkImpl>();
+        if (InferLoadOps && IsUndefined(*pDepthBufferVk))
+        {
+            auto& Ops = m_ImplicitAttachmentOps;
+            if (Ops.DepthLoadOp == ATTACHMENT_LOAD_OP_LOAD)
+                Ops.DepthLoadOp = ATTACHMENT_LOAD_OP_DISCARD;
+            if (Ops.StencilLoadOp == ATTACHMENT_LOAD_OP_LOAD)
+                Ops.StencilLoadOp = ATTACHMENT_LOAD_OP_DISCARD;
+            HasPendingLoadOps = true;
+        }
         TransitionOrVerifyTextureState(*pDepthBufferVk, StateTransitionMode, RESOURCE_STATE_DEPTH_WRITE, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
                                        "Binding depth-stencil buffer (DeviceContextVkImpl::TransitionRenderTargets)");
     }
@@ -1657,6 +2049,11 @@ void DeviceContextVkImpl::TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE
         if (auto& pRTVVk = m_pBoundRenderTargets[rt])
         {
             auto* pRenderTargetVk = pRTVVk->GetTexture<TextureVkImpl>();
+            if (InferLoadOps && IsUndefined(*pRenderTargetVk) && m_ImplicitAttachmentOps.RTVLoadOps[rt] == ATTACHMENT_LOAD_OP_LOAD)
+            {
+                m_ImplicitAttachmentOps.RTVLoadOps[rt] = ATTACHMENT_LOAD_OP_DISCARD;
+                HasPendingLoadOps                      = true;
+            }
             TransitionOrVerifyTextureState(*pRenderTargetVk, StateTransitionMode, RESOURCE_STATE_RENDER_TARGET, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
                                            "Binding render targets (DeviceContextVkImpl::TransitionRenderTargets)");
         }
@@ -1673,6 +2070,8 @@ void DeviceContextVkImpl::TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE
         TransitionOrVerifyTextureState(*pShadingRateMapVk, StateTransitionMode, RESOURCE_STATE_SHADING_RATE, vkRequiredLayout,
                                        "Binding shading rate map (DeviceContextVkImpl::TransitionRenderTargets)");
     }
+
+    m_HasPendingLoadOps = HasPendingLoadOps;
 }
 
 void DeviceContextVkImpl::CommitRenderPassAndFramebuffer(bool VerifyStates)
@@ -1680,7 +2079,25 @@ void DeviceContextVkImpl::CommitRenderPassAndFramebuffer(bool VerifyStates)
     VERIFY(m_pActiveRenderPass == nullptr, "This method must not be called inside an active render pass.");
 
     const auto& CmdBufferState = m_CommandBuffer.GetState();
-    if (CmdBufferState.Framebuffer != m_vkFramebuffer)
+    if (m_UseDynamicRendering)
+    {
+        // The dynamic render pass instance is ended whenever render targets change
+        // or a resource transition is required, so if it is active, it is up to date.
+        if (!CmdBufferState.DynamicRendering)
+        {
+            if (CmdBufferState.RenderPass != VK_NULL_HANDLE)
+                m_CommandBuffer.EndRenderPass();
+
+#ifdef DILIGENT_DEVELOPMENT
+            if (VerifyStates)
+            {
+                TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            }
+#endif
+            BeginDynamicRendering();
+        }
+    }
+    else if (CmdBufferState.Framebuffer != m_vkFramebuffer)
     {
         if (CmdBufferState.RenderPass != VK_NULL_HANDLE)
             m_CommandBuffer.EndRenderPass();
@@ -1694,13 +2111,164 @@ void DeviceContextVkImpl::CommitRenderPassAndFramebuffer(bool VerifyStates)
                 TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE_VERIFY);
             }
 #endif
-            m_CommandBuffer.BeginRenderPass(m_vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight);
+            BeginImplicitRenderPass();
+        }
+    }
+}
+
+bool DeviceContextVkImpl::IsImplicitRenderPassActive() const
+{
+    const auto& CmdBufferState = m_CommandBuffer.GetState();
+    if (m_UseDynamicRendering)
+        return CmdBufferState.DynamicRendering;
+    else
+        return m_vkFramebuffer != VK_NULL_HANDLE && CmdBufferState.Framebuffer == m_vkFramebuffer;
+}
+
+bool DeviceContextVkImpl::CanDeferImplicitLoadOps() const
+{
+    if (m_pActiveRenderPass != nullptr || IsRecordingSecondaryCommands())
+        return false;
+
+    if (!m_UseDynamicRendering && m_vkFramebuffer == VK_NULL_HANDLE)
+        return false;
+
+    return !IsImplicitRenderPassActive();
+}
+
+void DeviceContextVkImpl::CommitPendingLoadOps()
+{
+    VERIFY_EXPR(m_HasPendingLoadOps);
+    VERIFY_EXPR(m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE);
+    // Reset the flag first as the render pass may need to end the currently active pass
+    m_HasPendingLoadOps = false;
+    CommitRenderPassAndFramebuffer(false);
+}
+
+void DeviceContextVkImpl::FlushPendingLoadOps()
+{
+    VERIFY_EXPR(m_HasPendingLoadOps);
+    if (m_ImplicitAttachmentOps.HasClearOps(m_NumBoundRenderTargets))
+    {
+        // EnsureVkCmdBuffer() begins the render pass that executes the clears
+        EnsureVkCmdBuffer();
+    }
+    m_ImplicitAttachmentOps.ResetLoadOps();
+    m_HasPendingLoadOps = false;
+}
+
+void DeviceContextVkImpl::BeginImplicitRenderPass()
+{
+    VERIFY_EXPR(!m_UseDynamicRendering && m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE);
+
+    auto&        Ops          = m_ImplicitAttachmentOps;
+    VkRenderPass vkRenderPass = m_vkRenderPass;
+
+    // Clear values are indexed by the attachment index. The depth-stencil attachment
+    // goes first, followed by non-null render targets (see RenderPassCache).
+    std::array<VkClearValue, MAX_RENDER_TARGETS + 1> ClearValues;
+    Uint32                                           ClearValueCount = 0;
+
+    if (Ops.HasLoadOps(m_NumBoundRenderTargets) || Ops.DepthStencilStoreOp != ATTACHMENT_STORE_OP_STORE)
+    {
+        // Render passes that differ only by load and store operations are compatible,
+        // so the framebuffer created for m_vkRenderPass can be used with this pass.
+        auto RenderPassKey = m_ImplicitRenderPassKey;
+        RenderPassKey.SetAttachmentOps(Ops);
+        if (auto* pRenderPass = m_pDevice->GetImplicitRenderPassCache().GetRenderPass(RenderPassKey))
+            vkRenderPass = pRenderPass->GetVkRenderPass();
+        else
+            UNEXPECTED("Unable to get implicit render pass with custom load and store operations");
+
+        if (m_pBoundDepthStencil)
+            ClearValues[ClearValueCount++] = m_ImplicitClearValues[MAX_RENDER_TARGETS];
+        for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
+        {
+            if (m_pBoundRenderTargets[rt])
+                ClearValues[ClearValueCount++] = m_ImplicitClearValues[rt];
         }
     }
+
+    m_CommandBuffer.BeginRenderPass(vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight,
+                                    ClearValueCount, ClearValueCount > 0 ? ClearValues.data() : nullptr);
+
+    // The attachments are loaded when the render pass is restarted
+    Ops.ResetLoadOps();
+    m_HasPendingLoadOps = false;
+}
+
+void DeviceContextVkImpl::BeginDynamicRendering()
+{
+    VERIFY_EXPR(m_UseDynamicRendering);
+
+    auto& Ops = m_ImplicitAttachmentOps;
+
+    std::array<VkRenderingAttachmentInfoKHR, MAX_RENDER_TARGETS> ColorAttachments;
+    for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
+    {
+        auto& Attachment       = ColorAttachments[rt];
+        Attachment             = {};
+        Attachment.sType       = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        Attachment.imageView   = m_pBoundRenderTargets[rt] ? m_pBoundRenderTargets[rt]->GetVulkanImageView() : VK_NULL_HANDLE;
+        Attachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        Attachment.loadOp      = AttachmentLoadOpToVkAttachmentLoadOp(Ops.RTVLoadOps[rt]);
+        Attachment.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
+        Attachment.clearValue  = m_ImplicitClearValues[rt];
+    }
+
+    VkRenderingAttachmentInfoKHR DepthAttachment{};
+    DepthAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+
+    VkRenderingAttachmentInfoKHR StencilAttachment{};
+
+    bool HasStencil = false;
+    if (m_pBoundDepthStencil)
+    {
+        const auto& FmtAttribs = GetTextureFormatAttribs(m_pBoundDepthStencil->GetDesc().Format);
+
+        DepthAttachment.imageView   = m_pBoundDepthStencil->GetVulkanImageView();
+        DepthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        DepthAttachment.loadOp      = AttachmentLoadOpToVkAttachmentLoadOp(Ops.DepthLoadOp);
+        DepthAttachment.storeOp     = AttachmentStoreOpToVkAttachmentStoreOp(Ops.DepthStencilStoreOp);
+        DepthAttachment.clearValue  = m_ImplicitClearValues[MAX_RENDER_TARGETS];
+        HasStencil                  = FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL;
+
+        StencilAttachment        = DepthAttachment;
+        StencilAttachment.loadOp = AttachmentLoadOpToVkAttachmentLoadOp(Ops.StencilLoadOp);
+    }
+
+    VkRenderingInfoKHR RenderingInfo{};
+    RenderingInfo.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+    RenderingInfo.renderArea           = {{0, 0}, {m_FramebufferWidth, m_FramebufferHeight}};
+    RenderingInfo.layerCount           = std::max(m_FramebufferSlices, 1u);
+    RenderingInfo.colorAttachmentCount = m_NumBoundRenderTargets;
+    RenderingInfo.pColorAttachments    = ColorAttachments.data();
+    RenderingInfo.pDepthAttachment     = m_pBoundDepthStencil ? &DepthAttachment : nullptr;
+    RenderingInfo.pStencilAttachment   = HasStencil ? &StencilAttachment : nullptr;
+
+    m_CommandBuffer.BeginRendering(RenderingInfo);
+
+    // The attachments are loaded when the dynamic render pass instance is restarted
+    Ops.ResetLoadOps();
+    m_HasPendingLoadOps = false;
 }
 
 void DeviceContextVkImpl::ChooseRenderPassAndFramebuffer()
 {
+    // Render passes that use shading rate maps still go through the implicit render pass,
+    // since dynamic rendering requires a separate shading rate attachment structure.
+    m_UseDynamicRendering = m_pDevice->IsDynamicRenderingEnabled() && !m_pBoundShadingRateMap;
+
+    VERIFY(!m_HasPendingLoadOps, "Pending load operations must be flushed before render targets change");
+    m_ImplicitAttachmentOps.ResetLoadOps();
+
+    if (m_UseDynamicRendering)
+    {
+        m_vkRenderPass  = VK_NULL_HANDLE;
+        m_vkFramebuffer = VK_NULL_HANDLE;
+        return;
+    }
+
     FramebufferCache::FramebufferCacheKey FBKey;
     RenderPassCache::RenderPassCacheKey   RenderPassKey;
     if (m_pBoundDepthStencil)
@@ -1752,6 +2320,7 @@ void DeviceContextVkImpl::ChooseRenderPassAndFramebuffer()
     auto& FBCache = m_pDevice->GetFramebufferCache();
     auto& RPCache = m_pDevice->GetImplicitRenderPassCache();
 
+    m_ImplicitRenderPassKey = RenderPassKey;
     if (auto* pRenderPass = RPCache.GetRenderPass(RenderPassKey))
     {
         m_vkRenderPass         = pRenderPass->GetVkRenderPass();
@@ -1771,14 +2340,25 @@ void DeviceContextVkImpl::SetRenderTargetsExt(const SetRenderTargetsAttribs& Att
 {
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Calling SetRenderTargets inside active render pass is invalid. End the render pass first");
 
+    if (m_HasPendingLoadOps)
+        FlushPendingLoadOps();
+
     if (TDeviceContextBase::SetRenderTargets(Attribs))
     {
+        // Dynamic render pass instance does not reference a framebuffer object, so
+        // it must be explicitly ended when render targets change.
+        if (m_CommandBuffer.GetState().DynamicRendering)
+            m_CommandBuffer.EndRenderPass();
+
         ChooseRenderPassAndFramebuffer();
 
         // Set the viewport to match the render target size
         SetViewports(1, nullptr, 0, 0);
     }
 
+    // The store operation takes effect when the implicit render pass begins next time
+    m_ImplicitAttachmentOps.DepthStencilStoreOp = Attribs.DiscardDepthStencil ? ATTACHMENT_STORE_OP_DISCARD : ATTACHMENT_STORE_OP_STORE;
+
     // Layout transitions can only be performed outside of render pass, so defer
     // CommitRenderPassAndFramebuffer() until draw call, otherwise we may have to
     // to end render pass and begin it again if we need to transition any resource
@@ -1788,10 +2368,16 @@ void DeviceContextVkImpl::SetRenderTargetsExt(const SetRenderTargetsAttribs& Att
 
 void DeviceContextVkImpl::ResetRenderTargets()
 {
+    if (m_HasPendingLoadOps)
+        FlushPendingLoadOps();
+
     TDeviceContextBase::ResetRenderTargets();
-    m_vkRenderPass  = VK_NULL_HANDLE;
-    m_vkFramebuffer = VK_NULL_HANDLE;
-    if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+    m_vkRenderPass        = VK_NULL_HANDLE;
+    m_vkFramebuffer       = VK_NULL_HANDLE;
+    m_UseDynamicRendering = false;
+
+    m_ImplicitAttachmentOps.DepthStencilStoreOp = ATTACHMENT_STORE_OP_STORE;
+    if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.GetState().InsideRenderPass())
         m_CommandBuffer.EndRenderPass();
     m_State.ShadingRateIsSet = false;
 }
@@ -1837,23 +2423,29 @@ void DeviceContextVkImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
     }
 
     EnsureVkCmdBuffer();
-    m_CommandBuffer.BeginRenderPass(m_vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight, Attribs.ClearValueCount, pVkClearValues);
+    m_CommandBuffer.BeginRenderPass(m_vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight, Attribs.ClearValueCount, pVkClearValues, m_vkSubpassContents);
 
     // Set the viewport to match the framebuffer size
-    SetViewports(1, nullptr, 0, 0);
+    if (m_vkSubpassContents == VK_SUBPASS_CONTENTS_INLINE)
+        SetViewports(1, nullptr, 0, 0);
+    else
+        TDeviceContextBase::SetViewports(1, nullptr, 0, 0); // No commands other than vkCmdExecuteCommands are allowed in the subpass
 
     m_State.ShadingRateIsSet = false;
 }
 
 void DeviceContextVkImpl::NextSubpass()
 {
+    DEV_CHECK_ERR(!IsRecordingSecondaryCommands(), "NextSubpass() can't be called in a secondary command list");
     TDeviceContextBase::NextSubpass();
     VERIFY_EXPR(m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE);
-    m_CommandBuffer.NextSubpass();
+    m_CommandBuffer.NextSubpass(m_vkSubpassContents);
 }
 
 void DeviceContextVkImpl::EndRenderPass()
 {
+    DEV_CHECK_ERR(!IsRecordingSecondaryCommands(), "EndRenderPass() can't be called in a secondary command list. "
+                                                   "The render pass is ended by the immediate context that executes the command list.");
     TDeviceContextBase::EndRenderPass();
     // TDeviceContextBase::EndRenderPass calls ResetRenderTargets() that in turn
     // calls m_CommandBuffer.EndRenderPass()
@@ -1895,6 +2487,8 @@ void DeviceContextVkImpl::UpdateBuffer(IBuffer*                       pBuffer,
 
     DEV_CHECK_ERR(pBuffVk->GetDesc().Usage != USAGE_DYNAMIC, "Dynamic buffers must be updated via Map()");
 
+    DEV_CHECK_ERR(!IsDeferred() || !IsRecordingReusableCommands(), "UpdateBuffer() is not allowed in reusable command lists as the upload memory is recycled at the end of the frame");
+
     constexpr size_t Alignment = 4;
     // Source buffer offset must be multiple of 4 (18.4)
     auto TmpSpace = m_UploadHeap.Allocate(Size, Alignment);
@@ -1935,6 +2529,8 @@ void DeviceContextVkImpl::CopyBuffer(IBuffer*                       pSrcBuffer,
 
 void DeviceContextVkImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_MAP_BUFFER);
+
     TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
     auto* const pBufferVk = ClassPtrCast<BufferVkImpl>(pBuffer);
     const auto& BuffDesc  = pBufferVk->GetDesc();
@@ -2012,6 +2608,8 @@ void DeviceContextVkImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAG
 
 void DeviceContextVkImpl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_UNMAP_BUFFER);
+
     TDeviceContextBase::UnmapBuffer(pBuffer, MapType);
     auto* const pBufferVk = ClassPtrCast<BufferVkImpl>(pBuffer);
     const auto& BuffDesc  = pBufferVk->GetDesc();
@@ -2064,7 +2662,32 @@ void DeviceContextVkImpl::UpdateTexture(ITexture*                      pTexture,
 
     if (SubresData.pSrcBuffer != nullptr)
     {
-        UNSUPPORTED("Copying buffer to texture is not implemented");
+        auto* pSrcBuffVk = ClassPtrCast<BufferVkImpl>(SubresData.pSrcBuffer);
+        DEV_CHECK_ERR(pSrcBuffVk->GetDesc().Usage != USAGE_DYNAMIC, "Dynamic buffers can't be used as the texture update source in Vulkan");
+
+        // bufferImageHeight is always zero, so depth slices must be tightly packed (18.4)
+        const auto CopyInfo = GetBufferToTextureCopyInfo(pTexVk->GetDesc().Format, DstBox, 1);
+        DEV_CHECK_ERR(SubresData.Stride >= CopyInfo.RowSize, "Source data stride (", SubresData.Stride, ") is below the image row size (", CopyInfo.RowSize, ")");
+        DEV_CHECK_ERR(DstBox.Depth() == 1 || SubresData.DepthStride == SubresData.Stride * CopyInfo.RowCount,
+                      "Source data depth stride (", SubresData.DepthStride, ") must be equal to the row stride times the number of rows (", SubresData.Stride * CopyInfo.RowCount, ")");
+
+        const auto& FmtAttribs = GetTextureFormatAttribs(pTexVk->GetDesc().Format);
+        const auto  RowStrideInTexels =
+            FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED ?
+            StaticCast<Uint32>(SubresData.Stride / Uint64{FmtAttribs.ComponentSize} * Uint64{FmtAttribs.BlockWidth}) :
+            StaticCast<Uint32>(SubresData.Stride / (Uint64{FmtAttribs.ComponentSize} * Uint64{FmtAttribs.NumComponents}));
+
+        EnsureVkCmdBuffer();
+        TransitionOrVerifyBufferState(*pSrcBuffVk, SrcBufferStateTransitionMode, RESOURCE_STATE_COPY_SOURCE, VK_ACCESS_TRANSFER_READ_BIT,
+                                      "Using buffer as copy source (DeviceContextVkImpl::UpdateTexture)");
+        CopyBufferToTexture(pSrcBuffVk->GetVkBuffer(),
+                            SubresData.SrcOffset,
+                            RowStrideInTexels,
+                            *pTexVk,
+                            DstBox,
+                            MipLevel,
+                            Slice,
+                            TextureStateTransitionMode);
     }
     else
     {
@@ -2248,6 +2871,7 @@ void DeviceContextVkImpl::UpdateTextureRegion(const void*                    pSr
     {
         BufferOffsetAlignment = std::max(BufferOffsetAlignment, VkDeviceSize{FmtAttribs.ComponentSize});
     }
+    DEV_CHECK_ERR(!IsDeferred() || !IsRecordingReusableCommands(), "Texture upload memory must not be allocated in reusable command lists as it is recycled at the end of the frame");
     auto Allocation = m_UploadHeap.Allocate(CopyInfo.MemorySize, BufferOffsetAlignment);
     // The allocation will stay in the upload heap until the end of the frame at which point all upload
     // pages will be discarded
@@ -2294,6 +2918,19 @@ void DeviceContextVkImpl::GenerateMips(ITextureView* pTexView)
     GenerateMipsVkHelper::GenerateMips(*ClassPtrCast<TextureViewVkImpl>(pTexView), *this);
 }
 
+void DeviceContextVkImpl::GenerateMipsBatch(ITextureView* const* ppTexViews, Uint32 NumViews)
+{
+    TDeviceContextBase::GenerateMipsBatch(ppTexViews, NumViews);
+    if (NumViews == 0)
+        return;
+
+    std::vector<TextureViewVkImpl*> TexViewsVk(NumViews);
+    for (Uint32 i = 0; i < NumViews; ++i)
+        TexViewsVk[i] = ClassPtrCast<TextureViewVkImpl>(ppTexViews[i]);
+
+    GenerateMipsVkHelper::GenerateMips(TexViewsVk.data(), NumViews, *this);
+}
+
 static VkBufferImageCopy GetBufferImageCopyInfo(Uint64             BufferOffset,
                                                 Uint32             BufferRowStrideInTexels,
                                                 const TextureDesc& TexDesc,
@@ -2559,22 +3196,40 @@ void DeviceContextVkImpl::UnmapTextureSubresource(ITexture* pTexture,
 void DeviceContextVkImpl::FinishCommandList(ICommandList** ppCommandList)
 {
     DEV_CHECK_ERR(IsDeferred(), "Only deferred context can record command list");
-    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Finishing command list inside an active render pass.");
 
-    if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+    const bool IsSecondary = IsRecordingSecondaryCommands();
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr || IsSecondary, "Finishing command list inside an active render pass.");
+
+    if (m_HasPendingLoadOps)
+        FlushPendingLoadOps();
+
+    if (m_CommandBuffer.GetState().InsideRenderPass() && !IsSecondary)
     {
         m_CommandBuffer.EndRenderPass();
     }
 
+    if (m_CommandBuffer.GetState().ConditionalRendering)
+        m_CommandBuffer.EndConditionalRendering();
+
     auto vkCmdBuff = m_CommandBuffer.GetVkCmdBuffer();
     auto err       = vkEndCommandBuffer(vkCmdBuff);
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to end command buffer");
     (void)err;
 
-    CommandListVkImpl* pCmdListVk{NEW_RC_OBJ(m_CmdListAllocator, "CommandListVkImpl instance", CommandListVkImpl)(m_pDevice, this, vkCmdBuff)};
+    CommandListVkImpl* pCmdListVk{NEW_RC_OBJ(m_CmdListAllocator, "CommandListVkImpl instance", CommandListVkImpl)(m_pDevice, this, vkCmdBuff, IsSecondary, m_CmdPool)};
     pCmdListVk->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
 
     m_CommandBuffer.Reset();
+    if (IsSecondary)
+    {
+        // The inherited render pass is not ended in the secondary command buffer,
+        // so release it directly rather than through EndRenderPass().
+        m_pActiveRenderPass.Release();
+        m_pBoundFramebuffer.Release();
+        m_SubpassIndex = 0;
+        ResetRenderTargets();
+        m_vkSecondaryInheritance = {};
+    }
     m_State          = ContextState{};
     m_pPipelineState = nullptr;
     m_pQueryMgr      = nullptr;
@@ -2593,11 +3248,59 @@ void DeviceContextVkImpl::ExecuteCommandLists(Uint32               NumCommandLis
         return;
     DEV_CHECK_ERR(ppCommandLists != nullptr, "ppCommandLists must not be null when NumCommandLists is not zero");
 
+    if (m_pActiveRenderPass != nullptr)
+    {
+        // Command lists recorded with BeginSecondary() are executed inside the active render pass
+        ExecuteSecondaryCommandLists(NumCommandLists, ppCommandLists);
+        return;
+    }
+
     Flush(NumCommandLists, ppCommandLists);
 
     InvalidateState();
 }
 
+void DeviceContextVkImpl::ExecuteSecondaryCommandLists(Uint32               NumCommandLists,
+                                                       ICommandList* const* ppCommandLists)
+{
+    DEV_CHECK_ERR(m_vkSubpassContents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS,
+                  "Secondary command lists can only be executed in subpasses begun with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS contents. "
+                  "Call IDeviceContextVk::SetSubpassContents() before beginning the render pass.");
+
+    EnsureVkCmdBuffer();
+    VERIFY_EXPR(m_CommandBuffer.GetState().RenderPass == m_vkRenderPass);
+
+    auto vkCmdBuffs = MakeFrameVector<VkCommandBuffer>();
+    vkCmdBuffs.resize(NumCommandLists);
+    for (Uint32 i = 0; i < NumCommandLists; ++i)
+    {
+        auto* pCmdListVk = ClassPtrCast<CommandListVkImpl>(ppCommandLists[i]);
+        DEV_CHECK_ERR(pCmdListVk != nullptr, "Command list must not be null");
+        DEV_CHECK_ERR(pCmdListVk->IsSecondary(), "Only secondary command lists can be executed inside a render pass");
+        DEV_CHECK_ERR(pCmdListVk->GetQueueId() == GetDesc().QueueId, "Command list recorded for QueueId ", pCmdListVk->GetQueueId(), ", but executed on QueueId ", GetDesc().QueueId, ".");
+
+        RefCntAutoPtr<IDeviceContext> pDeferredCtx;
+        pCmdListVk->Close(pDeferredCtx, vkCmdBuffs[i]);
+        VERIFY(vkCmdBuffs[i] != VK_NULL_HANDLE, "Trying to execute empty command buffer");
+        // Set the bit in the deferred context cmd queue mask corresponding to cmd queue of this context
+        pDeferredCtx.RawPtr<DeviceContextVkImpl>()->UpdateSubmittedBuffersCmdQueueMask(GetCommandQueueId());
+        // Command buffers are disposed when the primary command buffer is submitted
+        m_PendingSecondaryCmdBuffs.emplace_back(std::move(pDeferredCtx), vkCmdBuffs[i]);
+    }
+
+    m_CommandBuffer.ExecuteCommands(NumCommandLists, vkCmdBuffs.data());
+    ++m_State.NumCommands;
+
+    // The pipeline, bound resources and dynamic states are undefined after vkCmdExecuteCommands.
+    // Render targets and the render pass remain active.
+    m_pPipelineState             = nullptr;
+    m_BindInfo                   = {};
+    m_State.CommittedVBsUpToDate = false;
+    m_State.CommittedIBUpToDate  = false;
+    m_State.ShadingRateIsSet     = false;
+    m_State.vkPipelineBindPoint  = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+}
+
 void DeviceContextVkImpl::EnqueueSignal(IFence* pFence, Uint64 Value)
 {
     TDeviceContextBase::EnqueueSignal(pFence, Value, 0);
@@ -2614,6 +3317,7 @@ void DeviceContextVkImpl::WaitForIdle()
 {
     DEV_CHECK_ERR(!IsDeferred(), "Only immediate contexts can be idled");
     Flush();
+    m_pDevice->FlushInitialDataBatch(GetCommandQueueId());
     m_pDevice->IdleCommandQueue(GetCommandQueueId(), true);
 }
 
@@ -2695,12 +3399,12 @@ void DeviceContextVkImpl::EndQuery(IQuery* pQuery)
                "No query flag is set which indicates there was no matching BeginQuery call or there was an error while beginning the query.");
         if (CmdBuffState.OutsidePassQueries & (1 << QueryType))
         {
-            if (m_CommandBuffer.GetState().RenderPass)
+            if (m_CommandBuffer.GetState().InsideRenderPass())
                 m_CommandBuffer.EndRenderPass();
         }
         else
         {
-            if (!m_CommandBuffer.GetState().RenderPass)
+            if (!m_CommandBuffer.GetState().InsideRenderPass())
                 LOG_ERROR_MESSAGE("The query was started inside render pass, but is being ended outside of render pass. "
                                   "Vulkan requires that a query must either begin and end inside the same "
                                   "subpass of a render pass instance, or must both begin and end outside of a render pass "
@@ -2712,6 +3416,186 @@ void DeviceContextVkImpl::EndQuery(IQuery* pQuery)
     }
 }
 
+void DeviceContextVkImpl::BeginIndexedQuery(IQueryArray* pQueryArray, Uint32 Index)
+{
+    TDeviceContextBase::BeginIndexedQuery(pQueryArray, Index, 0);
+
+    auto*      pQueryArrayVk = ClassPtrCast<QueryArrayVkImpl>(pQueryArray);
+    const auto QueryType     = pQueryArrayVk->GetDesc().Type;
+    pQueryArrayVk->DvpOnBeginQuery(Index);
+
+    EnsureVkCmdBuffer();
+
+    const auto& CmdBuffState = m_CommandBuffer.GetState();
+    if ((CmdBuffState.InsidePassQueries | CmdBuffState.OutsidePassQueries) & (1u << QueryType))
+    {
+        LOG_ERROR_MESSAGE("Another query of type ", GetQueryTypeString(QueryType),
+                          " is currently active. Overlapping queries do not work in Vulkan. "
+                          "End the first query before beginning another one.");
+        return;
+    }
+
+    ++m_ActiveQueriesCounter;
+    m_CommandBuffer.BeginQuery(pQueryArrayVk->GetVkQueryPool(),
+                               Index,
+                               QueryType == QUERY_TYPE_OCCLUSION ? VK_QUERY_CONTROL_PRECISE_BIT : 0,
+                               1u << QueryType);
+}
+
+void DeviceContextVkImpl::EndIndexedQuery(IQueryArray* pQueryArray, Uint32 Index)
+{
+    TDeviceContextBase::EndIndexedQuery(pQueryArray, Index, 0);
+
+    auto*      pQueryArrayVk = ClassPtrCast<QueryArrayVkImpl>(pQueryArray);
+    const auto QueryType     = pQueryArrayVk->GetDesc().Type;
+    pQueryArrayVk->DvpOnEndQuery(Index);
+
+    EnsureVkCmdBuffer();
+    if (QueryType == QUERY_TYPE_TIMESTAMP)
+    {
+        m_CommandBuffer.WriteTimestamp(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, pQueryArrayVk->GetVkQueryPool(), Index);
+    }
+    else
+    {
+        const auto& CmdBuffState = m_CommandBuffer.GetState();
+        if (((CmdBuffState.InsidePassQueries | CmdBuffState.OutsidePassQueries) & (1u << QueryType)) == 0)
+        {
+            LOG_ERROR_MESSAGE("No query of type ", GetQueryTypeString(QueryType), " is active. "
+                                                                                  "This may happen if there was an error while beginning the query.");
+            return;
+        }
+
+        // See comments in EndQuery()
+        if (CmdBuffState.OutsidePassQueries & (1u << QueryType))
+        {
+            if (CmdBuffState.InsideRenderPass())
+                m_CommandBuffer.EndRenderPass();
+        }
+
+        VERIFY(m_ActiveQueriesCounter > 0, "Active query counter is 0 which means there was a mismatch between BeginIndexedQuery() / EndIndexedQuery() calls");
+        --m_ActiveQueriesCounter;
+        m_CommandBuffer.EndQuery(pQueryArrayVk->GetVkQueryPool(), Index, 1u << QueryType);
+    }
+}
+
+void DeviceContextVkImpl::ResolveQueryArray(const ResolveQueryArrayAttribs& Attribs)
+{
+    TDeviceContextBase::ResolveQueryArray(Attribs, 0);
+
+    auto* pQueryArrayVk = ClassPtrCast<QueryArrayVkImpl>(Attribs.pQueryArray);
+    auto* pDstBuffVk    = ClassPtrCast<BufferVkImpl>(Attribs.pDstBuffer);
+    pQueryArrayVk->DvpOnResolve(Attribs.FirstQuery, Attribs.NumQueries);
+
+    EnsureVkCmdBuffer();
+    TransitionOrVerifyBufferState(*pDstBuffVk, Attribs.DstBufferTransitionMode, RESOURCE_STATE_COPY_DEST, VK_ACCESS_TRANSFER_WRITE_BIT,
+                                  "Resolve query array (DeviceContextVkImpl::ResolveQueryArray)");
+
+    // All queries in the range have been ended, so waiting for the results
+    // does not stall the GPU for longer than the queries take to complete.
+    m_CommandBuffer.CopyQueryPoolResults(pQueryArrayVk->GetVkQueryPool(), Attribs.FirstQuery, Attribs.NumQueries,
+                                         pDstBuffVk->GetVkBuffer(), Attribs.DstOffset, pQueryArrayVk->GetQueryDataStride(),
+                                         VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+
+    // Unlike Direct3D12, Vulkan queries must be reset before they are reused.
+    // Query commands execute in submission order, so the reset does not affect the copy (17.2).
+    m_CommandBuffer.ResetQueryPool(pQueryArrayVk->GetVkQueryPool(), Attribs.FirstQuery, Attribs.NumQueries);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextVkImpl::SetPredication(IBuffer* pBuffer, Uint64 Offset, PREDICATION_OP Op)
+{
+    TDeviceContextBase::SetPredication(pBuffer, Offset, Op, 0);
+
+    if (m_pDevice->GetLogicalDevice().GetEnabledExtFeatures().ConditionalRendering.conditionalRendering == VK_FALSE)
+    {
+        LOG_ERROR_MESSAGE("Predication requires VK_EXT_conditional_rendering extension");
+        return;
+    }
+
+    EnsureVkCmdBuffer();
+    if (m_CommandBuffer.GetState().ConditionalRendering)
+        m_CommandBuffer.EndConditionalRendering();
+
+    if (pBuffer == nullptr)
+        return;
+
+    auto* pBuffVk = ClassPtrCast<BufferVkImpl>(pBuffer);
+    TransitionOrVerifyBufferState(*pBuffVk, RESOURCE_STATE_TRANSITION_MODE_VERIFY, RESOURCE_STATE_INDIRECT_ARGUMENT,
+                                  VK_ACCESS_INDIRECT_COMMAND_READ_BIT, "Set predication (DeviceContextVkImpl::SetPredication)");
+
+    // Indirect argument state does not make the predicate visible to the conditional rendering stage
+    m_CommandBuffer.MemoryBarrier(VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+                                  VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT,
+                                  VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                  VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT);
+
+    // Vulkan predicate is a 32-bit value. Draw and dispatch commands are discarded when it is zero,
+    // or when it is not zero if the inverted flag is used.
+    m_CommandBuffer.BeginConditionalRendering(pBuffVk->GetVkBuffer(), Offset,
+                                              Op == PREDICATION_OP_SKIP_IF_NOT_ZERO ? VK_CONDITIONAL_RENDERING_INVERTED_BIT_EXT : 0);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextVkImpl::SetQueryPredication(IQuery* pQuery, PREDICATION_OP Op)
+{
+    UNSUPPORTED("SetQueryPredication is not supported in Vulkan. Use SetPredication with the results resolved by ResolveQueryArray.");
+}
+
+void DeviceContextVkImpl::CommitDynamicStates(const GraphicsPipelineDesc& GraphicsPipeline)
+{
+    const auto DynamicStateFlags = GraphicsPipeline.DynamicStateFlags;
+    if ((DynamicStateFlags & PIPELINE_DYNAMIC_STATE_FLAG_CULL_MODE) != 0)
+        m_CommandBuffer.SetCullMode(CullModeToVkCullMode(GraphicsPipeline.RasterizerDesc.CullMode));
+
+    if ((DynamicStateFlags & (PIPELINE_DYNAMIC_STATE_FLAG_DEPTH | PIPELINE_DYNAMIC_STATE_FLAG_STENCIL)) != 0)
+        CommitDepthStencilState(GraphicsPipeline.DepthStencilDesc, DynamicStateFlags);
+
+    if ((DynamicStateFlags & PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY) != 0)
+    {
+        VkPrimitiveTopology vkTopology         = VK_PRIMITIVE_TOPOLOGY_MAX_ENUM;
+        uint32_t            PatchControlPoints = 0;
+        PrimitiveTopology_To_VkPrimitiveTopologyAndPatchCPCount(GraphicsPipeline.PrimitiveTopology, vkTopology, PatchControlPoints);
+        m_CommandBuffer.SetPrimitiveTopology(vkTopology);
+    }
+}
+
+void DeviceContextVkImpl::CommitDepthStencilState(const DepthStencilStateDesc& DSSDesc, PIPELINE_DYNAMIC_STATE_FLAGS DynamicStateFlags)
+{
+    const auto DSStateCI = DepthStencilStateDesc_To_VkDepthStencilStateCI(DSSDesc);
+    if ((DynamicStateFlags & PIPELINE_DYNAMIC_STATE_FLAG_DEPTH) != 0)
+        m_CommandBuffer.SetDepthState(DSStateCI.depthTestEnable, DSStateCI.depthWriteEnable, DSStateCI.depthCompareOp);
+    if ((DynamicStateFlags & PIPELINE_DYNAMIC_STATE_FLAG_STENCIL) != 0)
+        m_CommandBuffer.SetStencilState(DSStateCI.stencilTestEnable, DSStateCI.front, DSStateCI.back);
+}
+
+void DeviceContextVkImpl::SetCullMode(CULL_MODE CullMode)
+{
+    TDeviceContextBase::SetCullMode(CullMode, 0);
+
+    EnsureVkCmdBuffer();
+    m_CommandBuffer.SetCullMode(CullModeToVkCullMode(CullMode));
+}
+
+void DeviceContextVkImpl::SetDepthStencilState(const DepthStencilStateDesc& DSSDesc)
+{
+    TDeviceContextBase::SetDepthStencilState(DSSDesc, 0);
+
+    EnsureVkCmdBuffer();
+    CommitDepthStencilState(DSSDesc, m_pPipelineState->GetGraphicsPipelineDesc().DynamicStateFlags);
+}
+
+void DeviceContextVkImpl::SetPrimitiveTopology(PRIMITIVE_TOPOLOGY Topology)
+{
+    TDeviceContextBase::SetPrimitiveTopology(Topology, 0);
+
+    VkPrimitiveTopology vkTopology         = VK_PRIMITIVE_TOPOLOGY_MAX_ENUM;
+    uint32_t            PatchControlPoints = 0;
+    PrimitiveTopology_To_VkPrimitiveTopologyAndPatchCPCount(Topology, vkTopology, PatchControlPoints);
+
+    EnsureVkCmdBuffer();
+    m_CommandBuffer.SetPrimitiveTopology(vkTopology);
+}
+
 
 void DeviceContextVkImpl::TransitionImageLayout(ITexture* pTexture, VkImageLayout NewLayout)
 {
@@ -3087,6 +3971,7 @@ VulkanDynamicAllocation DeviceContextVkImpl::AllocateDynamicSpace(Uint64 SizeInB
 {
     DEV_CHECK_ERR(SizeInBytes < std::numeric_limits<Uint32>::max(),
                   "Dynamic allocation size must be less than 2^32");
+    DEV_CHECK_ERR(!IsDeferred() || !IsRecordingReusableCommands(), "Dynamic memory must not be allocated in reusable command lists as it is recycled at the end of the frame");
 
     auto DynAlloc = m_DynamicHeap.Allocate(static_cast<Uint32>(SizeInBytes), Alignment);
 #ifdef DILIGENT_DEVELOPMENT
@@ -3097,6 +3982,8 @@ VulkanDynamicAllocation DeviceContextVkImpl::AllocateDynamicSpace(Uint64 SizeInB
 
 void DeviceContextVkImpl::TransitionResourceStates(Uint32 BarrierCount, const StateTransitionDesc* pResourceBarriers)
 {
+    DILIGENT_INSTRUMENT_CALL(INSTRUMENTED_CALL_TRANSITION_RESOURCE_STATES);
+
     VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
 
     if (BarrierCount == 0)
@@ -3183,6 +4070,15 @@ void DeviceContextVkImpl::AliasingBarrier(IDeviceObject* pResourceBefore, IDevic
 
     EnsureVkCmdBuffer();
     m_CommandBuffer.MemoryBarrier(vkSrcAccessMask, vkDstAccessMask, vkSrcStages, vkDstStages);
+
+    // The content of the image that aliases other resources is undefined, and its next
+    // layout transition must start from VK_IMAGE_LAYOUT_UNDEFINED.
+    if (RefCntAutoPtr<ITextureVk> pTexture{pResourceAfter, IID_TextureVk})
+    {
+        auto* pTexVk = pTexture.RawPtr<TextureVkImpl>();
+        if (pTexVk->IsInKnownState())
+            pTexVk->SetState(RESOURCE_STATE_UNDEFINED);
+    }
 }
 
 void DeviceContextVkImpl::ResolveTextureSubresource(ITexture*                               pSrcTexture,
@@ -3240,28 +4136,29 @@ void DeviceContextVkImpl::ResolveTextureSubresource(ITexture*
                                  1, &ResolveRegion);
 }
 
-void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
+void DeviceContextVkImpl::PrepareBLASBuild(const BuildBLASAttribs&                                Attribs,
+                                           BufferVkImpl&                                          ScratchBuffer,
+                                           Uint64                                                 ScratchBufferOffset,
+                                           RESOURCE_STATE_TRANSITION_MODE                         ScratchBufferTransitionMode,
+                                           const char*                                            OpName,
+                                           VkAccelerationStructureBuildGeometryInfoKHR&           vkASBuildInfo,
+                                           FrameVector<VkAccelerationStructureGeometryKHR>&       vkGeometries,
+                                           FrameVector<VkAccelerationStructureBuildRangeInfoKHR>& vkRanges)
 {
-    TDeviceContextBase::BuildBLAS(Attribs, 0);
-
-    auto* pBLASVk    = ClassPtrCast<BottomLevelASVkImpl>(Attribs.pBLAS);
-    auto* pScratchVk = ClassPtrCast<BufferVkImpl>(Attribs.pScratchBuffer);
-    auto& BLASDesc   = pBLASVk->GetDesc();
-
-    EnsureVkCmdBuffer();
+    auto* pBLASVk  = ClassPtrCast<BottomLevelASVkImpl>(Attribs.pBLAS);
+    auto& BLASDesc = pBLASVk->GetDesc();
 
-    const char* OpName = "Build BottomLevelAS (DeviceContextVkImpl::BuildBLAS)";
     TransitionOrVerifyBLASState(*pBLASVk, Attribs.BLASTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
-    TransitionOrVerifyBufferState(*pScratchVk, Attribs.ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR, OpName);
+    TransitionOrVerifyBufferState(ScratchBuffer, ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR, OpName);
 
-    VkAccelerationStructureBuildGeometryInfoKHR           vkASBuildInfo = {};
-    std::vector<VkAccelerationStructureBuildRangeInfoKHR> vkRanges;
-    std::vector<VkAccelerationStructureGeometryKHR>       vkGeometries;
+    // Geometries of the build are appended to the geometries of the previous builds in the batch
+    const size_t FirstGeometry = vkGeometries.size();
+    VERIFY_EXPR(vkRanges.size() == FirstGeometry);
 
     if (Attribs.pTriangleData != nullptr)
     {
-        vkGeometries.resize(Attribs.TriangleDataCount);
-        vkRanges.resize(Attribs.TriangleDataCount);
+        vkGeometries.resize(FirstGeometry + Attribs.TriangleDataCount);
+        vkRanges.resize(FirstGeometry + Attribs.TriangleDataCount);
         pBLASVk->SetActualGeometryCount(Attribs.TriangleDataCount);
 
         for (Uint32 i = 0; i < Attribs.TriangleDataCount; ++i)
@@ -3276,9 +4173,9 @@ void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
                 continue;
             }
 
-            auto&       vkGeo   = vkGeometries[Idx];
+            auto&       vkGeo   = vkGeometries[FirstGeometry + Idx];
             auto&       vkTris  = vkGeo.geometry.triangles;
-            auto&       off     = vkRanges[Idx];
+            auto&       off     = vkRanges[FirstGeometry + Idx];
             const auto& TriDesc = BLASDesc.pTriangles[GeoIdx];
 
             vkGeo.sType        = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
@@ -3343,8 +4240,8 @@ void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
     }
     else if (Attribs.pBoxData != nullptr)
     {
-        vkGeometries.resize(Attribs.BoxDataCount);
-        vkRanges.resize(Attribs.BoxDataCount);
+        vkGeometries.resize(FirstGeometry + Attribs.BoxDataCount);
+        vkRanges.resize(FirstGeometry + Attribs.BoxDataCount);
         pBLASVk->SetActualGeometryCount(Attribs.BoxDataCount);
 
         for (Uint32 i = 0; i < Attribs.BoxDataCount; ++i)
@@ -3359,9 +4256,9 @@ void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
                 continue;
             }
 
-            auto& vkGeo   = vkGeometries[Idx];
+            auto& vkGeo   = vkGeometries[FirstGeometry + Idx];
             auto& vkAABBs = vkGeo.geometry.aabbs;
-            auto& off     = vkRanges[Idx];
+            auto& off     = vkRanges[FirstGeometry + Idx];
 
             vkGeo.sType        = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
             vkGeo.pNext        = nullptr;
@@ -3386,29 +4283,128 @@ void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
         }
     }
 
-    VkAccelerationStructureBuildRangeInfoKHR const* VkRangePtr = vkRanges.data();
-
     vkASBuildInfo.sType                     = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
     vkASBuildInfo.type                      = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;                 // type must be compatible with create info
     vkASBuildInfo.flags                     = BuildASFlagsToVkBuildAccelerationStructureFlags(BLASDesc.Flags); // flags must be compatible with create info
     vkASBuildInfo.mode                      = Attribs.Update ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
     vkASBuildInfo.srcAccelerationStructure  = Attribs.Update ? pBLASVk->GetVkBLAS() : VK_NULL_HANDLE;
     vkASBuildInfo.dstAccelerationStructure  = pBLASVk->GetVkBLAS();
-    vkASBuildInfo.geometryCount             = static_cast<uint32_t>(vkGeometries.size());
-    vkASBuildInfo.pGeometries               = vkGeometries.data();
+    vkASBuildInfo.geometryCount             = static_cast<uint32_t>(vkGeometries.size() - FirstGeometry);
+    vkASBuildInfo.pGeometries               = nullptr; // Set by the caller when all geometries are written
     vkASBuildInfo.ppGeometries              = nullptr;
-    vkASBuildInfo.scratchData.deviceAddress = pScratchVk->GetVkDeviceAddress() + Attribs.ScratchBufferOffset;
+    vkASBuildInfo.scratchData.deviceAddress = ScratchBuffer.GetVkDeviceAddress() + ScratchBufferOffset;
 
     const auto& ASLimits = m_pDevice->GetPhysicalDevice().GetExtProperties().AccelStruct;
     VERIFY(vkASBuildInfo.scratchData.deviceAddress % ASLimits.minAccelerationStructureScratchOffsetAlignment == 0, "Scratch buffer start address is not properly aligned");
 
+#ifdef DILIGENT_DEVELOPMENT
+    pBLASVk->DvpUpdateVersion();
+#endif
+}
+
+void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
+{
+    TDeviceContextBase::BuildBLAS(Attribs, 0);
+
     EnsureVkCmdBuffer();
+
+    VkAccelerationStructureBuildGeometryInfoKHR vkASBuildInfo = {};
+    auto                                        vkRanges      = MakeFrameVector<VkAccelerationStructureBuildRangeInfoKHR>();
+    auto                                        vkGeometries  = MakeFrameVector<VkAccelerationStructureGeometryKHR>();
+
+    PrepareBLASBuild(Attribs, *ClassPtrCast<BufferVkImpl>(Attribs.pScratchBuffer), Attribs.ScratchBufferOffset, Attribs.ScratchBufferTransitionMode,
+                     "Build BottomLevelAS (DeviceContextVkImpl::BuildBLAS)", vkASBuildInfo, vkGeometries, vkRanges);
+
+    vkASBuildInfo.pGeometries = vkGeometries.data();
+
+    VkAccelerationStructureBuildRangeInfoKHR const* VkRangePtr = vkRanges.data();
     m_CommandBuffer.BuildAccelerationStructure(1, &vkASBuildInfo, &VkRangePtr);
     ++m_State.NumCommands;
+}
 
-#ifdef DILIGENT_DEVELOPMENT
-    pBLASVk->DvpUpdateVersion();
-#endif
+void DeviceContextVkImpl::BuildBLASBatch(const BuildBLASBatchAttribs& Attribs)
+{
+    TDeviceContextBase::BuildBLASBatch(Attribs, 0);
+
+    if (Attribs.BuildCount == 0)
+        return;
+
+    EnsureVkCmdBuffer();
+
+    const char* OpName = "Build BottomLevelAS batch (DeviceContextVkImpl::BuildBLASBatch)";
+
+    auto ScratchOffsets = MakeFrameVector<Uint64>(Attribs.BuildCount);
+    ScratchOffsets.resize(Attribs.BuildCount);
+    BufferVkImpl* pBatchScratchVk = PrepareBLASBatchScratchBuffer(Attribs, ScratchOffsets.data());
+    if (pBatchScratchVk != nullptr)
+    {
+        // The builds that share the context scratch buffer use non-overlapping ranges, so a single
+        // transition is enough. It also separates the builds from the previous batch.
+        TransitionOrVerifyBufferState(*pBatchScratchVk, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_BUILD_AS_WRITE, VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR, OpName);
+    }
+
+    Uint32 TotalGeometryCount = 0;
+    for (Uint32 i = 0; i < Attribs.BuildCount; ++i)
+        TotalGeometryCount += Attribs.pBuilds[i].TriangleDataCount + Attribs.pBuilds[i].BoxDataCount;
+
+    auto vkBuildInfos = MakeFrameVector<VkAccelerationStructureBuildGeometryInfoKHR>(Attribs.BuildCount);
+    auto vkRangePtrs  = MakeFrameVector<const VkAccelerationStructureBuildRangeInfoKHR*>(Attribs.BuildCount);
+    auto vkRanges     = MakeFrameVector<VkAccelerationStructureBuildRangeInfoKHR>(TotalGeometryCount);
+    auto vkGeometries = MakeFrameVector<VkAccelerationStructureGeometryKHR>(TotalGeometryCount);
+    vkBuildInfos.resize(Attribs.BuildCount);
+
+    // State transitions of all builds are recorded before the build command, so
+    // that they are flushed with a single pipeline barrier.
+    for (Uint32 i = 0; i < Attribs.BuildCount; ++i)
+    {
+        const BuildBLASAttribs& Build = Attribs.pBuilds[i];
+        if (Build.pScratchBuffer != nullptr)
+        {
+            PrepareBLASBuild(Build, *ClassPtrCast<BufferVkImpl>(Build.pScratchBuffer), ScratchOffsets[i], Build.ScratchBufferTransitionMode,
+                             OpName, vkBuildInfos[i], vkGeometries, vkRanges);
+        }
+        else
+        {
+            PrepareBLASBuild(Build, *pBatchScratchVk, ScratchOffsets[i], RESOURCE_STATE_TRANSITION_MODE_NONE,
+                             OpName, vkBuildInfos[i], vkGeometries, vkRanges);
+        }
+    }
+
+    size_t FirstGeometry = 0;
+    for (auto& vkASBuildInfo : vkBuildInfos)
+    {
+        vkASBuildInfo.pGeometries = vkGeometries.data() + FirstGeometry;
+        vkRangePtrs.push_back(vkRanges.data() + FirstGeometry);
+        FirstGeometry += vkASBuildInfo.geometryCount;
+    }
+    VERIFY_EXPR(FirstGeometry == vkGeometries.size());
+
+    m_CommandBuffer.BuildAccelerationStructure(Attribs.BuildCount, vkBuildInfos.data(), vkRangePtrs.data());
+    ++m_State.NumCommands;
+
+    if (Attribs.pCompactedSizeBuffer == nullptr)
+        return;
+
+    auto* pDestBuffVk = ClassPtrCast<BufferVkImpl>(Attribs.pCompactedSizeBuffer);
+    auto  vkBLASes    = MakeFrameVector<VkAccelerationStructureKHR>(Attribs.BuildCount);
+    for (Uint32 i = 0; i < Attribs.BuildCount; ++i)
+    {
+        auto* pBLASVk = ClassPtrCast<BottomLevelASVkImpl>(Attribs.pBuilds[i].pBLAS);
+        // The BLAS has just been written by the build, so the barrier is required regardless of the transition mode
+        TransitionBLASState(*pBLASVk, RESOURCE_STATE_BUILD_AS_WRITE, RESOURCE_STATE_BUILD_AS_READ, pBLASVk->IsInKnownState());
+        vkBLASes.push_back(pBLASVk->GetVkBLAS());
+    }
+    TransitionOrVerifyBufferState(*pDestBuffVk, Attribs.CompactedSizeBufferTransitionMode, RESOURCE_STATE_COPY_DEST, VK_ACCESS_TRANSFER_WRITE_BIT, OpName);
+
+    for (Uint32 FirstBLAS = 0; FirstBLAS < Attribs.BuildCount; FirstBLAS += ASCompactedSizeQueryCount)
+    {
+        const Uint32 QueryCount = std::min(Attribs.BuildCount - FirstBLAS, Uint32{ASCompactedSizeQueryCount});
+        m_CommandBuffer.ResetQueryPool(m_ASQueryPool, 0, QueryCount);
+        m_CommandBuffer.WriteAccelerationStructuresProperties(QueryCount, &vkBLASes[FirstBLAS], VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR, m_ASQueryPool, 0);
+        m_CommandBuffer.CopyQueryPoolResults(m_ASQueryPool, 0, QueryCount, pDestBuffVk->GetVkBuffer(), Attribs.CompactedSizeBufferOffset + Uint64{FirstBLAS} * sizeof(Uint64),
+                                             sizeof(Uint64), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+        ++m_State.NumCommands;
+    }
 }
 
 void DeviceContextVkImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
@@ -3441,8 +4437,25 @@ void DeviceContextVkImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
 
     // copy instance data into instance buffer
     {
-        size_t Size     = Attribs.InstanceCount * sizeof(VkAccelerationStructureInstanceKHR);
-        auto   TmpSpace = m_UploadHeap.Allocate(Size, 16);
+        DEV_CHECK_ERR(!IsDeferred() || !IsRecordingReusableCommands(), "Building TLAS is not allowed in reusable command lists as instance data is uploaded through memory that is recycled at the end of the frame");
+        size_t Size = Attribs.InstanceCount * sizeof(VkAccelerationStructureInstanceKHR);
+
+        VulkanUploadAllocation              TmpSpace;
+        VkAccelerationStructureInstanceKHR* pRecords = nullptr;
+
+        auto Records = MakeFrameVector<VkAccelerationStructureInstanceKHR>();
+        if (Attribs.UploadChangedInstancesOnly)
+        {
+            // Instances are packed to CPU memory first and compared with the previously uploaded ones
+            Records.resize(Attribs.InstanceCount);
+            pRecords = Records.data();
+        }
+        else
+        {
+            pTLASVk->ReleaseUploadedInstanceRecords();
+            TmpSpace = m_UploadHeap.Allocate(Size, 16);
+            pRecords = static_cast<VkAccelerationStructureInstanceKHR*>(TmpSpace.CPUAddress);
+        }
 
         for (Uint32 i = 0; i < Attribs.InstanceCount; ++i)
         {
@@ -3455,7 +4468,7 @@ void DeviceContextVkImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
                 return;
             }
 
-            auto& vkASInst = static_cast<VkAccelerationStructureInstanceKHR*>(TmpSpace.CPUAddress)[InstDesc.InstanceIndex];
+            auto& vkASInst = pRecords[InstDesc.InstanceIndex];
             auto* pBLASVk  = ClassPtrCast<BottomLevelASVkImpl>(Inst.pBLAS);
 
             static_assert(sizeof(vkASInst.transform) == sizeof(Inst.Transform), "size mismatch");
@@ -3470,7 +4483,10 @@ void DeviceContextVkImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
             TransitionOrVerifyBLASState(*pBLASVk, Attribs.BLASTransitionMode, RESOURCE_STATE_BUILD_AS_READ, OpName);
         }
 
-        UpdateBufferRegion(pInstancesVk, Attribs.InstanceBufferOffset, Size, TmpSpace.vkBuffer, TmpSpace.AlignedOffset, Attribs.InstanceBufferTransitionMode);
+        if (Attribs.UploadChangedInstancesOnly)
+            UploadChangedTLASInstances(*pTLASVk, Attribs, Records, OpName);
+        else
+            UpdateBufferRegion(pInstancesVk, Attribs.InstanceBufferOffset, Size, TmpSpace.vkBuffer, TmpSpace.AlignedOffset, Attribs.InstanceBufferTransitionMode);
     }
     TransitionOrVerifyBufferState(*pInstancesVk, Attribs.InstanceBufferTransitionMode, RESOURCE_STATE_BUILD_AS_READ, VK_ACCESS_SHADER_READ_BIT, OpName);
 
@@ -3513,6 +4529,47 @@ void DeviceContextVkImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
     ++m_State.NumCommands;
 }
 
+void DeviceContextVkImpl::UploadChangedTLASInstances(TopLevelASVkImpl&                                      TLASVk,
+                                                     const BuildTLASAttribs&                                Attribs,
+                                                     const FrameVector<VkAccelerationStructureInstanceKHR>& Records,
+                                                     const char*                                            OpName)
+{
+    auto* pInstancesVk = ClassPtrCast<BufferVkImpl>(Attribs.pInstanceBuffer);
+
+    auto DirtyRanges = MakeFrameVector<std::pair<Uint32, Uint32>>();
+    TLASVk.UpdateUploadedInstanceRecords(Records.data(), Attribs.InstanceCount, pInstancesVk, Attribs.InstanceBufferOffset, Attribs.Update, DirtyRanges);
+    if (DirtyRanges.empty())
+        return;
+
+    Uint32 DirtyCount = 0;
+    for (const auto& Range : DirtyRanges)
+        DirtyCount += Range.second;
+
+    // Dirty records are packed contiguously in the upload heap and copied to
+    // their locations in the instance buffer with a single copy command.
+    auto TmpSpace    = m_UploadHeap.Allocate(DirtyCount * sizeof(VkAccelerationStructureInstanceKHR), 16);
+    auto CopyRegions = MakeFrameVector<VkBufferCopy>(DirtyRanges.size());
+
+    VkDeviceSize SrcOffset = 0;
+    for (const auto& Range : DirtyRanges)
+    {
+        const VkDeviceSize RangeSize = VkDeviceSize{Range.second} * sizeof(VkAccelerationStructureInstanceKHR);
+        std::memcpy(static_cast<Uint8*>(TmpSpace.CPUAddress) + SrcOffset, &Records[Range.first], static_cast<size_t>(RangeSize));
+
+        VkBufferCopy CopyRegion;
+        CopyRegion.srcOffset = TmpSpace.AlignedOffset + SrcOffset;
+        CopyRegion.dstOffset = Attribs.InstanceBufferOffset + VkDeviceSize{Range.first} * sizeof(VkAccelerationStructureInstanceKHR);
+        CopyRegion.size      = RangeSize;
+        CopyRegions.push_back(CopyRegion);
+
+        SrcOffset += RangeSize;
+    }
+
+    TransitionOrVerifyBufferState(*pInstancesVk, Attribs.InstanceBufferTransitionMode, RESOURCE_STATE_COPY_DEST, VK_ACCESS_TRANSFER_WRITE_BIT, OpName);
+    m_CommandBuffer.CopyBuffer(TmpSpace.vkBuffer, pInstancesVk->GetVkBuffer(), static_cast<uint32_t>(CopyRegions.size()), CopyRegions.data());
+    ++m_State.NumCommands;
+}
+
 void DeviceContextVkImpl::CopyBLAS(const CopyBLASAttribs& Attribs)
 {
     TDeviceContextBase::CopyBLAS(Attribs, 0);
@@ -3588,8 +4645,9 @@ void DeviceContextVkImpl::WriteBLASCompactedSize(const WriteBLASCompactedSizeAtt
     TransitionOrVerifyBLASState(*pBLASVk, Attribs.BLASTransitionMode, RESOURCE_STATE_BUILD_AS_READ, OpName);
     TransitionOrVerifyBufferState(*pDestBuffVk, Attribs.BufferTransitionMode, RESOURCE_STATE_COPY_DEST, VK_ACCESS_TRANSFER_WRITE_BIT, OpName);
 
+    const VkAccelerationStructureKHR vkAS = pBLASVk->GetVkBLAS();
     m_CommandBuffer.ResetQueryPool(m_ASQueryPool, QueryIndex, 1);
-    m_CommandBuffer.WriteAccelerationStructuresProperties(pBLASVk->GetVkBLAS(), VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR, m_ASQueryPool, QueryIndex);
+    m_CommandBuffer.WriteAccelerationStructuresProperties(1, &vkAS, VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR, m_ASQueryPool, QueryIndex);
     m_CommandBuffer.CopyQueryPoolResults(m_ASQueryPool, QueryIndex, 1, pDestBuffVk->GetVkBuffer(), Attribs.DestBufferOffset, sizeof(Uint64), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
     ++m_State.NumCommands;
 }
@@ -3608,8 +4666,9 @@ void DeviceContextVkImpl::WriteTLASCompactedSize(const WriteTLASCompactedSizeAtt
     TransitionOrVerifyTLASState(*pTLASVk, Attribs.TLASTransitionMode, RESOURCE_STATE_BUILD_AS_READ, OpName);
     TransitionOrVerifyBufferState(*pDestBuffVk, Attribs.BufferTransitionMode, RESOURCE_STATE_COPY_DEST, VK_ACCESS_TRANSFER_WRITE_BIT, OpName);
 
+    const VkAccelerationStructureKHR vkAS = pTLASVk->GetVkTLAS();
     m_CommandBuffer.ResetQueryPool(m_ASQueryPool, QueryIndex, 1);
-    m_CommandBuffer.WriteAccelerationStructuresProperties(pTLASVk->GetVkTLAS(), VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR, m_ASQueryPool, QueryIndex);
+    m_CommandBuffer.WriteAccelerationStructuresProperties(1, &vkAS, VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR, m_ASQueryPool, QueryIndex);
     m_CommandBuffer.CopyQueryPoolResults(m_ASQueryPool, QueryIndex, 1, pDestBuffVk->GetVkBuffer(), Attribs.DestBufferOffset, sizeof(Uint64), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
     ++m_State.NumCommands;
 }
@@ -3622,7 +4681,7 @@ void DeviceContextVkImpl::CreateASCompactedSizeQueryPool()
         VkQueryPoolCreateInfo Info          = {};
 
         Info.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
-        Info.queryCount = 1;
+        Info.queryCount = ASCompactedSizeQueryCount;
         Info.queryType  = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR;
 
         m_ASQueryPool = LogicalDevice.CreateQueryPool(Info, "AS Compacted Size Query");
@@ -3632,6 +4691,7 @@ void DeviceContextVkImpl::CreateASCompactedSizeQueryPool()
 void DeviceContextVkImpl::TraceRays(const TraceRaysAttribs& Attribs)
 {
     TDeviceContextBase::TraceRays(Attribs, 0);
+    ++m_FrameStats.DispatchCount;
 
     const auto* pSBTVk       = ClassPtrCast<const ShaderBindingTableVkImpl>(Attribs.pSBT);
     const auto& BindingTable = pSBTVk->GetVkBindingTable();
@@ -3645,6 +4705,7 @@ void DeviceContextVkImpl::TraceRays(const TraceRaysAttribs& Attribs)
 void DeviceContextVkImpl::TraceRaysIndirect(const TraceRaysIndirectAttribs& Attribs)
 {
     TDeviceContextBase::TraceRaysIndirect(Attribs, 0);
+    ++m_FrameStats.DispatchCount;
 
     const auto* pSBTVk       = ClassPtrCast<const ShaderBindingTableVkImpl>(Attribs.pSBT);
     const auto& BindingTable = pSBTVk->GetVkBindingTable();
@@ -3678,18 +4739,19 @@ void DeviceContextVkImpl::UpdateSBT(IShaderBindingTable* pSBT, const UpdateIndir
     {
         TransitionOrVerifyBufferState(*pSBTBufferVk, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_COPY_DEST, VK_ACCESS_TRANSFER_WRITE_BIT, OpName);
 
+        // Only the modified records of each table are uploaded.
         // Buffer ranges do not intersect, so we don't need to add barriers between them
         if (RayGenShaderRecord.pData)
-            UpdateBuffer(pSBTBufferVk, RayGenShaderRecord.Offset, RayGenShaderRecord.Size, RayGenShaderRecord.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            UpdateBuffer(pSBTBufferVk, RayGenShaderRecord.Offset + RayGenShaderRecord.DirtyOffset, RayGenShaderRecord.DirtySize, static_cast<const Uint8*>(RayGenShaderRecord.pData) + RayGenShaderRecord.DirtyOffset, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         if (MissShaderTable.pData)
-            UpdateBuffer(pSBTBufferVk, MissShaderTable.Offset, MissShaderTable.Size, MissShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            UpdateBuffer(pSBTBufferVk, MissShaderTable.Offset + MissShaderTable.DirtyOffset, MissShaderTable.DirtySize, static_cast<const Uint8*>(MissShaderTable.pData) + MissShaderTable.DirtyOffset, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         if (HitGroupTable.pData)
-            UpdateBuffer(pSBTBufferVk, HitGroupTable.Offset, HitGroupTable.Size, HitGroupTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            UpdateBuffer(pSBTBufferVk, HitGroupTable.Offset + HitGroupTable.DirtyOffset, HitGroupTable.DirtySize, static_cast<const Uint8*>(HitGroupTable.pData) + HitGroupTable.DirtyOffset, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         if (CallableShaderTable.pData)
-            UpdateBuffer(pSBTBufferVk, CallableShaderTable.Offset, CallableShaderTable.Size, CallableShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            UpdateBuffer(pSBTBufferVk, CallableShaderTable.Offset + CallableShaderTable.DirtyOffset, CallableShaderTable.DirtySize, static_cast<const Uint8*>(CallableShaderTable.pData) + CallableShaderTable.DirtyOffset, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         TransitionOrVerifyBufferState(*pSBTBufferVk, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_RAY_TRACING, VK_ACCESS_SHADER_READ_BIT, OpName);
     }
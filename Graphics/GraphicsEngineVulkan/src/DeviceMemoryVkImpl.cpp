@@ -48,10 +48,15 @@ DeviceMemoryVkImpl::DeviceMemoryVkImpl(IReferenceCounters*           pRefCounter
     const auto& PhysicalDevice = m_pDevice->GetPhysicalDevice();
     const auto& LogicalDevice  = m_pDevice->GetLogicalDevice();
 
-    if (MemCI.NumResources == 0)
+    // Sparse memory is only compatible with sparse resources, while placed memory
+    // is compatible with regular resources that are bound to the memory.
+    const auto RequiredUsage = m_Desc.Type == DEVICE_MEMORY_TYPE_PLACED ? USAGE_DEFAULT : USAGE_SPARSE;
+
+    // Placed memory without compatible resources uses the device-local memory type
+    if (MemCI.NumResources == 0 && m_Desc.Type != DEVICE_MEMORY_TYPE_PLACED)
         DEVMEM_CHECK_CREATE_INFO("Vulkan requires at least one resource to choose memory type");
 
-    if (MemCI.ppCompatibleResources == nullptr)
+    if (MemCI.NumResources != 0 && MemCI.ppCompatibleResources == nullptr)
         DEVMEM_CHECK_CREATE_INFO("ppCompatibleResources must not be null");
 
     uint32_t MemoryTypeBits = ~0u;
@@ -62,16 +67,16 @@ DeviceMemoryVkImpl::DeviceMemoryVkImpl(IReferenceCounters*           pRefCounter
         if (RefCntAutoPtr<ITextureVk> pTexture{pResource, IID_TextureVk})
         {
             const auto* pTexVk = pTexture.RawPtr<const TextureVkImpl>();
-            if (pTexVk->GetDesc().Usage != USAGE_SPARSE)
-                DEVMEM_CHECK_CREATE_INFO("ppCompatibleResources[", i, "] must be created with USAGE_SPARSE");
+            if (pTexVk->GetDesc().Usage != RequiredUsage)
+                DEVMEM_CHECK_CREATE_INFO("ppCompatibleResources[", i, "] must be created with ", GetUsageString(RequiredUsage));
 
             MemoryTypeBits &= LogicalDevice.GetImageMemoryRequirements(pTexVk->GetVkImage()).memoryTypeBits;
         }
         else if (RefCntAutoPtr<IBufferVk> pBuffer{pResource, IID_BufferVk})
         {
             const auto* pBuffVk = pBuffer.RawPtr<const BufferVkImpl>();
-            if (pBuffVk->GetDesc().Usage != USAGE_SPARSE)
-                DEVMEM_CHECK_CREATE_INFO("ppCompatibleResources[", i, "] must be created with USAGE_SPARSE");
+            if (pBuffVk->GetDesc().Usage != RequiredUsage)
+                DEVMEM_CHECK_CREATE_INFO("ppCompatibleResources[", i, "] must be created with ", GetUsageString(RequiredUsage));
 
             MemoryTypeBits &= LogicalDevice.GetBufferMemoryRequirements(pBuffVk->GetVkBuffer()).memoryTypeBits;
         }
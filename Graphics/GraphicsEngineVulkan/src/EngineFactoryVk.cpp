@@ -30,6 +30,8 @@
 
 #include "pch.h"
 #include <array>
+#include <future>
+#include <mutex>
 #include "EngineFactoryVk.h"
 #include "RenderDeviceVkImpl.hpp"
 #include "DeviceContextVkImpl.hpp"
@@ -108,7 +110,10 @@ public:
 
     virtual void DILIGENT_CALL_TYPE EnableDeviceSimulation() override final
     {
+        std::lock_guard<std::mutex> Lock{m_AdaptersCacheMtx};
         m_EnableDeviceSimulation = true;
+        // Simulated devices report different properties
+        m_AdaptersCacheValid = false;
     }
 
     virtual void DILIGENT_CALL_TYPE CreateDearchiver(const DearchiverCreateInfo& CreateInfo,
@@ -130,6 +135,12 @@ private:
     RefCntWeakPtr<IRenderDevice> m_wpDevice;
 
     bool m_EnableDeviceSimulation = false;
+
+    // Creating the instance and querying every physical device is expensive, and applications
+    // typically call EnumerateAdapters() twice: to get the adapter count and to get the adapters.
+    mutable std::mutex                       m_AdaptersCacheMtx;
+    mutable std::vector<GraphicsAdapterInfo> m_CachedAdapters;
+    mutable bool                             m_AdaptersCacheValid = false;
 };
 
 
@@ -449,6 +460,13 @@ GraphicsAdapterInfo GetPhysicalDeviceGraphicsAdapterInfo(const VulkanUtilities::
             DrawCommandProps.CapFlags |= DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_FIRST_INSTANCE;
         if (vkExtFeatures.DrawIndirectCount)
             DrawCommandProps.CapFlags |= DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER;
+        if (vkExtFeatures.MultiDraw.multiDraw != VK_FALSE)
+            DrawCommandProps.CapFlags |= DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW;
+#if DILIGENT_USE_VOLK
+        // Conditional rendering is only enabled with volk, see CreateDeviceAndContextsVk()
+        if (vkExtFeatures.ConditionalRendering.conditionalRendering != VK_FALSE)
+            DrawCommandProps.CapFlags |= DRAW_COMMAND_CAP_FLAG_PREDICATION;
+#endif
         ASSERT_SIZEOF(DrawCommandProps, 12, "Did you add a new member to DrawCommandProperties? Please initialize it here.");
     }
 
@@ -595,26 +613,50 @@ void EngineFactoryVkImpl::EnumerateAdapters(Version              MinVersion,
         return;
     }
 
-    VulkanUtilities::VulkanInstance::CreateInfo InstanceCI;
-    // Create instance with the maximum available version.
-    // If Volk is not enabled, the version will be 1.0.
-    InstanceCI.ApiVersion             = VK_MAKE_VERSION(0xFF, 0xFF, 0);
-    InstanceCI.EnableDeviceSimulation = m_EnableDeviceSimulation;
+    std::lock_guard<std::mutex> Lock{m_AdaptersCacheMtx};
+    if (!m_AdaptersCacheValid)
+    {
+        VulkanUtilities::VulkanInstance::CreateInfo InstanceCI;
+        // Create instance with the maximum available version.
+        // If Volk is not enabled, the version will be 1.0.
+        InstanceCI.ApiVersion             = VK_MAKE_VERSION(0xFF, 0xFF, 0);
+        InstanceCI.EnableDeviceSimulation = m_EnableDeviceSimulation;
+
+        auto Instance = VulkanUtilities::VulkanInstance::Create(InstanceCI);
+
+        const auto& vkDevices = Instance->GetVkPhysicalDevices();
 
-    auto Instance = VulkanUtilities::VulkanInstance::Create(InstanceCI);
+        // Physical device queries do not require external synchronization,
+        // so query all devices in parallel.
+        std::vector<std::future<GraphicsAdapterInfo>> AdapterInfos;
+        AdapterInfos.reserve(vkDevices.size());
+        for (size_t i = 0; i < vkDevices.size(); ++i)
+        {
+            AdapterInfos.emplace_back(std::async(
+                i + 1 < vkDevices.size() ? std::launch::async : std::launch::deferred,
+                [&Instance, vkDevice = vkDevices[i]]() {
+                    auto PhysicalDevice = VulkanUtilities::VulkanPhysicalDevice::Create({*Instance, vkDevice});
+                    return GetPhysicalDeviceGraphicsAdapterInfo(*PhysicalDevice);
+                }));
+        }
+
+        m_CachedAdapters.clear();
+        m_CachedAdapters.reserve(AdapterInfos.size());
+        for (auto& AdapterInfo : AdapterInfos)
+            m_CachedAdapters.push_back(AdapterInfo.get());
+
+        m_AdaptersCacheValid = true;
+    }
 
     if (Adapters == nullptr)
     {
-        NumAdapters = static_cast<Uint32>(Instance->GetVkPhysicalDevices().size());
+        NumAdapters = static_cast<Uint32>(m_CachedAdapters.size());
         return;
     }
 
-    NumAdapters = std::min(NumAdapters, static_cast<Uint32>(Instance->GetVkPhysicalDevices().size()));
+    NumAdapters = std::min(NumAdapters, static_cast<Uint32>(m_CachedAdapters.size()));
     for (Uint32 i = 0; i < NumAdapters; ++i)
-    {
-        auto PhysicalDevice = VulkanUtilities::VulkanPhysicalDevice::Create({*Instance, Instance->GetVkPhysicalDevices()[i]});
-        Adapters[i]         = GetPhysicalDeviceGraphicsAdapterInfo(*PhysicalDevice);
-    }
+        Adapters[i] = m_CachedAdapters[i];
 }
 
 void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& EngineCI,
@@ -641,9 +683,12 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
     }
 
     SetRawAllocator(EngineCI.pRawMemAllocator);
+    BeginStartupProfiling(EngineCI);
 
     try
     {
+        StartupProfiler::Scope ProfilerScope{"CreateDeviceAndContextsVk"};
+
         const auto GraphicsAPIVersion = EngineCI.GraphicsAPIVersion == Version{0, 0} ?
             Version{0xFF, 0xFF} : // Instance will use the maximum available version
             EngineCI.GraphicsAPIVersion;
@@ -661,10 +706,19 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
         InstanceCI.IgnoreDebugMessageCount   = EngineCI.IgnoreDebugMessageCount;
         InstanceCI.ppIgnoreDebugMessageNames = EngineCI.ppIgnoreDebugMessageNames;
 
-        auto Instance = VulkanUtilities::VulkanInstance::Create(InstanceCI);
+        std::shared_ptr<VulkanUtilities::VulkanInstance> Instance;
+        {
+            StartupProfiler::Scope InstanceScope{"Create Vulkan instance"};
+            Instance = VulkanUtilities::VulkanInstance::Create(InstanceCI);
+        }
 
-        auto vkDevice       = Instance->SelectPhysicalDevice(EngineCI.AdapterId);
-        auto PhysicalDevice = VulkanUtilities::VulkanPhysicalDevice::Create({*Instance, vkDevice, /*LogExtensions = */ true});
+        std::unique_ptr<VulkanUtilities::VulkanPhysicalDevice> PhysicalDevice;
+        {
+            StartupProfiler::Scope PhysicalDeviceScope{"Select physical device"};
+
+            auto vkDevice  = Instance->SelectPhysicalDevice(EngineCI.AdapterId);
+            PhysicalDevice = VulkanUtilities::VulkanPhysicalDevice::Create({*Instance, vkDevice, /*LogExtensions = */ true});
+        }
 
         std::vector<const char*> DeviceExtensions;
         if (Instance->IsExtensionEnabled(VK_KHR_SURFACE_EXTENSION_NAME))
@@ -1137,6 +1191,130 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
                     VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME));
                     DeviceExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
                 }
+
+                // Native multi-draw is used by MultiDraw() and MultiDrawIndexed() commands
+                // whenever it is available, so enable it unconditionally.
+                if (DeviceExtFeatures.MultiDraw.multiDraw != VK_FALSE)
+                {
+                    VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_MULTI_DRAW_EXTENSION_NAME));
+                    DeviceExtensions.push_back(VK_EXT_MULTI_DRAW_EXTENSION_NAME);
+
+                    EnabledExtFeats.MultiDraw = DeviceExtFeatures.MultiDraw;
+
+                    *NextExt = &EnabledExtFeats.MultiDraw;
+                    NextExt  = &EnabledExtFeats.MultiDraw.pNext;
+                }
+            }
+
+            // Graphics pipeline libraries are used to speed up pipeline creation
+            // whenever they are available, so enable them unconditionally.
+            if (DeviceExtFeatures.GraphicsPipelineLibrary.graphicsPipelineLibrary != VK_FALSE)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME));
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME); // Required for VK_EXT_graphics_pipeline_library
+                DeviceExtensions.push_back(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+
+                EnabledExtFeats.GraphicsPipelineLibrary = DeviceExtFeatures.GraphicsPipelineLibrary;
+
+                *NextExt = &EnabledExtFeats.GraphicsPipelineLibrary;
+                NextExt  = &EnabledExtFeats.GraphicsPipelineLibrary.pNext;
+            }
+
+#if DILIGENT_USE_VOLK
+            // Dynamic rendering is used instead of implicit render passes and framebuffers
+            // for render targets set with SetRenderTargets() whenever it is available.
+            // vkCmdBeginRenderingKHR is not exported by the loader, so it requires volk.
+            if (DeviceExtFeatures.DynamicRendering.dynamicRendering != VK_FALSE)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+
+                EnabledExtFeats.DynamicRendering = DeviceExtFeatures.DynamicRendering;
+
+                *NextExt = &EnabledExtFeats.DynamicRendering;
+                NextExt  = &EnabledExtFeats.DynamicRendering.pNext;
+            }
+
+            // Present id and present wait are used by the low-latency swap chain mode
+            // (see SwapChainDesc::LowLatencyMode) whenever they are available.
+            // vkWaitForPresentKHR is not exported by the loader, so it requires volk.
+            if (DeviceExtFeatures.PresentId.presentId != VK_FALSE &&
+                DeviceExtFeatures.PresentWait.presentWait != VK_FALSE)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_PRESENT_ID_EXTENSION_NAME));
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_PRESENT_WAIT_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME); // Required for VK_KHR_present_wait
+                DeviceExtensions.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+
+                EnabledExtFeats.PresentId   = DeviceExtFeatures.PresentId;
+                EnabledExtFeats.PresentWait = DeviceExtFeatures.PresentWait;
+
+                *NextExt = &EnabledExtFeats.PresentId;
+                NextExt  = &EnabledExtFeats.PresentId.pNext;
+
+                *NextExt = &EnabledExtFeats.PresentWait;
+                NextExt  = &EnabledExtFeats.PresentWait.pNext;
+            }
+
+            // Conditional rendering implements IDeviceContext::SetPredication().
+            // vkCmdBeginConditionalRenderingEXT is not exported by the loader, so it requires volk.
+            if (DeviceExtFeatures.ConditionalRendering.conditionalRendering != VK_FALSE)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME);
+
+                EnabledExtFeats.ConditionalRendering = DeviceExtFeatures.ConditionalRendering;
+
+                *NextExt = &EnabledExtFeats.ConditionalRendering;
+                NextExt  = &EnabledExtFeats.ConditionalRendering.pNext;
+            }
+
+            // Extended dynamic state is only reported with volk, see VkFeaturesToDeviceFeatures().
+            if (EnabledFeatures.ExtendedDynamicState != DEVICE_FEATURE_STATE_DISABLED)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+
+                EnabledExtFeats.ExtendedDynamicState = DeviceExtFeatures.ExtendedDynamicState;
+
+                *NextExt = &EnabledExtFeats.ExtendedDynamicState;
+                NextExt  = &EnabledExtFeats.ExtendedDynamicState.pNext;
+            }
+#endif
+
+            // Pipeline creation cache control allows probing the pipeline cache without compiling the pipeline,
+            // see PSO_CREATE_FLAG_ASYNCHRONOUS_ON_CACHE_MISS.
+            if (DeviceExtFeatures.PipelineCreationCacheControl.pipelineCreationCacheControl != VK_FALSE)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_PIPELINE_CREATION_CACHE_CONTROL_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_PIPELINE_CREATION_CACHE_CONTROL_EXTENSION_NAME);
+
+                EnabledExtFeats.PipelineCreationCacheControl = DeviceExtFeatures.PipelineCreationCacheControl;
+
+                *NextExt = &EnabledExtFeats.PipelineCreationCacheControl;
+                NextExt  = &EnabledExtFeats.PipelineCreationCacheControl.pNext;
+            }
+
+            // Dedicated allocations are used by the memory manager for large resources
+            // and for resources the driver prefers to keep in their own memory objects.
+            if (DeviceExtFeatures.DedicatedAllocation)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME));
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME); // Required for VK_KHR_dedicated_allocation
+                DeviceExtensions.push_back(VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME);
+
+                EnabledExtFeats.DedicatedAllocation = true;
+            }
+
+            // The memory budget is used to report the memory pressure, see IRenderDevice::GetMemoryBudget().
+            if (DeviceExtFeatures.MemoryBudget)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+                EnabledExtFeats.MemoryBudget = true;
             }
 
             // Append user-defined features
@@ -1148,7 +1326,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
                 LOG_ERROR_MESSAGE("Can not enable extended device features when VK_KHR_get_physical_device_properties2 extension is not supported by device");
         }
 
-        ASSERT_SIZEOF(Diligent::DeviceFeatures, 41, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
+        ASSERT_SIZEOF(Diligent::DeviceFeatures, 42, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
 
         for (Uint32 i = 0; i < EngineCI.DeviceExtensionCount; ++i)
         {
@@ -1176,8 +1354,13 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
         vkDeviceCreateInfo.ppEnabledExtensionNames = DeviceExtensions.empty() ? nullptr : DeviceExtensions.data();
         vkDeviceCreateInfo.enabledExtensionCount   = static_cast<uint32_t>(DeviceExtensions.size());
 
-        auto vkAllocator   = Instance->GetVkAllocator();
-        auto LogicalDevice = VulkanUtilities::VulkanLogicalDevice::Create(*PhysicalDevice, vkDeviceCreateInfo, EnabledExtFeats, vkAllocator);
+        auto vkAllocator = Instance->GetVkAllocator();
+
+        std::shared_ptr<VulkanUtilities::VulkanLogicalDevice> LogicalDevice;
+        {
+            StartupProfiler::Scope LogicalDeviceScope{"Create logical device"};
+            LogicalDevice = VulkanUtilities::VulkanLogicalDevice::Create(*PhysicalDevice, vkDeviceCreateInfo, EnabledExtFeats, vkAllocator);
+        }
 
         auto& RawMemAllocator = GetRawAllocator();
 
@@ -1270,14 +1453,19 @@ void EngineFactoryVkImpl::AttachToVulkanDevice(std::shared_ptr<VulkanUtilities::
     {
         auto& RawMemAllocator = GetRawAllocator();
 
-        RenderDeviceVkImpl* pRenderDeviceVk{
-            NEW_RC_OBJ(RawMemAllocator, "RenderDeviceVkImpl instance", RenderDeviceVkImpl)(
-                RawMemAllocator, this, EngineCI, AdapterInfo, CommandQueueCount, ppCommandQueues, Instance, std::move(PhysicalDevice), LogicalDevice) //
-        };
-        pRenderDeviceVk->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
+        RenderDeviceVkImpl* pRenderDeviceVk = nullptr;
+        {
+            StartupProfiler::Scope RenderDeviceScope{"Create render device"};
+
+            pRenderDeviceVk = NEW_RC_OBJ(RawMemAllocator, "RenderDeviceVkImpl instance", RenderDeviceVkImpl)(
+                RawMemAllocator, this, EngineCI, AdapterInfo, CommandQueueCount, ppCommandQueues, Instance, std::move(PhysicalDevice), LogicalDevice);
+            pRenderDeviceVk->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
+
+            if (m_OnRenderDeviceCreated != nullptr)
+                m_OnRenderDeviceCreated(pRenderDeviceVk);
+        }
 
-        if (m_OnRenderDeviceCreated != nullptr)
-            m_OnRenderDeviceCreated(pRenderDeviceVk);
+        StartupProfiler::Scope ContextsScope{"Create device contexts"};
 
 
 
@@ -132,7 +132,7 @@ Uint64 FenceVkImpl::InternalGetCompletedValue()
     {
         auto& Item = m_SyncPoints.front();
 
-        auto status = LogicalDevice.GetFenceStatus(Item.SyncPoint->GetFence());
+        auto status = Item.SyncPoint->GetStatus(LogicalDevice);
         if (status == VK_SUCCESS)
         {
             UpdateLastCompletedFenceValue(Item.Value);
@@ -207,25 +207,41 @@ void FenceVkImpl::Wait(Uint64 Value)
     }
     else
     {
-        std::lock_guard<std::mutex> Lock{m_SyncPointsGuard};
-
-        const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
-        while (!m_SyncPoints.empty())
+        // Wait without holding the lock so that other threads may keep enqueuing
+        // signals and querying the fence while this thread is blocked.
+        std::vector<SyncPointVkPtr> SyncPoints;
+        Uint64                      LastValue = 0;
         {
-            auto& Item = m_SyncPoints.front();
-            if (Item.Value > Value)
-                break;
-
-            VkFence Fence  = Item.SyncPoint->GetFence();
-            auto    status = LogicalDevice.GetFenceStatus(Fence);
-            if (status == VK_NOT_READY)
+            std::lock_guard<std::mutex> Lock{m_SyncPointsGuard};
+            for (const auto& Item : m_SyncPoints)
             {
-                status = LogicalDevice.WaitForFences(1, &Fence, VK_TRUE, UINT64_MAX);
+                if (Item.Value > Value)
+                    break;
+                SyncPoints.push_back(Item.SyncPoint);
+                LastValue = Item.Value;
             }
+        }
+        if (SyncPoints.empty())
+            return;
+
+        const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
 
+        // Sync points are normally submitted to the same queue and complete in order, so waiting
+        // for the last one is enough, and the status of the others is checked without blocking.
+        auto status = SyncPoints.back()->Wait(LogicalDevice, UINT64_MAX);
+        DEV_CHECK_ERR(status == VK_SUCCESS, "Failed to wait for the sync point");
+        for (size_t i = 0; i + 1 < SyncPoints.size(); ++i)
+        {
+            status = SyncPoints[i]->GetStatus(LogicalDevice);
+            if (status == VK_NOT_READY)
+                status = SyncPoints[i]->Wait(LogicalDevice, UINT64_MAX);
             DEV_CHECK_ERR(status == VK_SUCCESS, "All pending fences must now be complete!");
-            UpdateLastCompletedFenceValue(Item.Value);
+        }
 
+        std::lock_guard<std::mutex> Lock{m_SyncPointsGuard};
+        while (!m_SyncPoints.empty() && m_SyncPoints.front().Value <= LastValue)
+        {
+            UpdateLastCompletedFenceValue(m_SyncPoints.front().Value);
             m_SyncPoints.pop_front();
         }
     }
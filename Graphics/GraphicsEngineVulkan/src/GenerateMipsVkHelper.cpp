@@ -27,6 +27,9 @@
 
 #include "pch.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "GenerateMipsVkHelper.hpp"
 
 #include "DeviceContextVkImpl.hpp"
@@ -41,20 +44,32 @@ namespace Diligent
 namespace GenerateMipsVkHelper
 {
 
-void GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx)
+namespace
+{
+
+struct MipChainInfo
+{
+    TextureVkImpl*         pTexVk         = nullptr;
+    const TextureDesc*     pTexDesc       = nullptr;
+    const TextureViewDesc* pViewDesc      = nullptr;
+    VkImage                vkImage        = VK_NULL_HANDLE;
+    VkImageLayout          OriginalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkPipelineStageFlags   OldStages      = 0;
+    VkImageAspectFlags     AspectMask     = 0;
+};
+
+bool InitMipChain(TextureViewVkImpl& TexView, MipChainInfo& Chain)
 {
     auto* pTexVk = TexView.GetTexture<TextureVkImpl>();
     if (!pTexVk->IsInKnownState())
     {
         LOG_ERROR_MESSAGE("Unable to generate mips for texture '", pTexVk->GetDesc().Name, "' because the texture state is unknown");
-        return;
+        return false;
     }
 
-    const auto  OriginalState  = pTexVk->GetState();
-    const auto  OriginalLayout = pTexVk->GetLayout();
-    const auto  OldStages      = ResourceStateFlagsToVkPipelineStageFlags(OriginalState);
-    const auto& TexDesc        = pTexVk->GetDesc();
-    const auto& ViewDesc       = TexView.GetDesc();
+    const auto  OriginalState = pTexVk->GetState();
+    const auto& TexDesc       = pTexVk->GetDesc();
+    const auto& ViewDesc      = TexView.GetDesc();
 
     DEV_CHECK_ERR(ViewDesc.NumMipLevels > 1, "Number of mip levels in the view must be greater than 1");
     DEV_CHECK_ERR(OriginalState != RESOURCE_STATE_UNDEFINED,
@@ -62,92 +77,149 @@ void GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx)
                   "' which is in RESOURCE_STATE_UNDEFINED state ."
                   "This is not expected in Vulkan backend as textures are transition to a defined state when created.");
 
-    const auto& FmtAttribs = GetTextureFormatAttribs(ViewDesc.Format);
+    Chain.pTexVk         = pTexVk;
+    Chain.pTexDesc       = &TexDesc;
+    Chain.pViewDesc      = &ViewDesc;
+    Chain.vkImage        = pTexVk->GetVkImage();
+    Chain.OriginalLayout = pTexVk->GetLayout();
+    Chain.OldStages      = ResourceStateFlagsToVkPipelineStageFlags(OriginalState);
 
-    VkImageSubresourceRange SubresRange{};
+    const auto& FmtAttribs = GetTextureFormatAttribs(ViewDesc.Format);
     if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH)
-        SubresRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+        Chain.AspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
     else if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
     {
         // If image has a depth / stencil format with both depth and stencil components, then the
         // aspectMask member of subresourceRange must include both VK_IMAGE_ASPECT_DEPTH_BIT and
         // VK_IMAGE_ASPECT_STENCIL_BIT (6.7.3)
-        SubresRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        Chain.AspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
     }
     else
-        SubresRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    SubresRange.baseArrayLayer = ViewDesc.FirstArraySlice;
-    SubresRange.layerCount     = ViewDesc.NumArraySlices;
-    SubresRange.baseMipLevel   = ViewDesc.MostDetailedMip;
-    SubresRange.levelCount     = 1;
+        Chain.AspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+
+    return true;
+}
+
+VkImageSubresourceRange GetMipRange(const MipChainInfo& Chain, Uint32 Mip, Uint32 NumMips = 1)
+{
+    VkImageSubresourceRange SubresRange{};
+    SubresRange.aspectMask     = Chain.AspectMask;
+    SubresRange.baseArrayLayer = Chain.pViewDesc->FirstArraySlice;
+    SubresRange.layerCount     = Chain.pViewDesc->NumArraySlices;
+    SubresRange.baseMipLevel   = Mip;
+    SubresRange.levelCount     = NumMips;
+    return SubresRange;
+}
+
+void BlitMipLevel(const MipChainInfo& Chain, Uint32 mip, VulkanUtilities::VulkanCommandBuffer& CmdBuffer)
+{
+    const auto& TexDesc  = *Chain.pTexDesc;
+    const auto& ViewDesc = *Chain.pViewDesc;
 
     VkImageBlit BlitRegion{};
     BlitRegion.srcSubresource.baseArrayLayer = ViewDesc.FirstArraySlice;
     BlitRegion.srcSubresource.layerCount     = ViewDesc.NumArraySlices;
-    BlitRegion.srcSubresource.aspectMask     = SubresRange.aspectMask;
+    BlitRegion.srcSubresource.aspectMask     = Chain.AspectMask;
+    BlitRegion.srcSubresource.mipLevel       = mip - 1;
     BlitRegion.dstSubresource.baseArrayLayer = BlitRegion.srcSubresource.baseArrayLayer;
     BlitRegion.dstSubresource.layerCount     = BlitRegion.srcSubresource.layerCount;
     BlitRegion.dstSubresource.aspectMask     = BlitRegion.srcSubresource.aspectMask;
+    BlitRegion.dstSubresource.mipLevel       = mip;
     BlitRegion.srcOffsets[0]                 = VkOffset3D{0, 0, 0};
     BlitRegion.dstOffsets[0]                 = VkOffset3D{0, 0, 0};
 
-    SubresRange.baseMipLevel = ViewDesc.MostDetailedMip;
-    SubresRange.levelCount   = 1;
+    BlitRegion.srcOffsets[1] =
+        VkOffset3D //
+        {
+            static_cast<int32_t>(std::max(TexDesc.Width >> (mip - 1), 1u)),
+            static_cast<int32_t>(std::max(TexDesc.Height >> (mip - 1), 1u)),
+            1 //
+        };
+    BlitRegion.dstOffsets[1] =
+        VkOffset3D //
+        {
+            static_cast<int32_t>(std::max(TexDesc.Width >> mip, 1u)),
+            static_cast<int32_t>(std::max(TexDesc.Height >> mip, 1u)),
+            1 //
+        };
+    if (TexDesc.Type == RESOURCE_DIM_TEX_3D)
+    {
+        BlitRegion.srcOffsets[1].z = std::max(TexDesc.Depth >> (mip - 1), 1u);
+        BlitRegion.dstOffsets[1].z = std::max(TexDesc.Depth >> mip, 1u);
+    }
+
+    // For sRGB source formats, nonlinear RGB values are converted to linear representation prior to filtering.
+    // In case of sRGB destination format, linear RGB values are converted to nonlinear representation before writing the pixel to the image.
+    CmdBuffer.BlitImage(Chain.vkImage,
+                        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, //  must be VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL
+                        Chain.vkImage,
+                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, //  must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL
+                        1,
+                        &BlitRegion,
+                        VK_FILTER_LINEAR);
+}
 
-    auto&      CmdBuffer = Ctx.GetCommandBuffer();
-    const auto vkImage   = pTexVk->GetVkImage();
-    if (OriginalState != RESOURCE_STATE_COPY_SOURCE)
-        CmdBuffer.TransitionImageLayout(vkImage, OriginalLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, SubresRange, OldStages, VK_PIPELINE_STAGE_TRANSFER_BIT);
+void GenerateMipChains(std::vector<MipChainInfo>& Chains, DeviceContextVkImpl& Ctx)
+{
+    if (Chains.empty())
+        return;
+
+    auto& CmdBuffer = Ctx.GetCommandBuffer();
 
-    for (uint32_t mip = ViewDesc.MostDetailedMip + 1; mip < ViewDesc.MostDetailedMip + ViewDesc.NumMipLevels; ++mip)
+    // Transition the most detailed level of every texture to the transfer source layout
+    Uint32 MaxMipLevels = 0;
+    for (const auto& Chain : Chains)
     {
-        BlitRegion.srcSubresource.mipLevel = mip - 1;
-        BlitRegion.dstSubresource.mipLevel = mip;
+        const auto& ViewDesc = *Chain.pViewDesc;
+        if (Chain.pTexVk->GetState() != RESOURCE_STATE_COPY_SOURCE)
+        {
+            CmdBuffer.TransitionImageLayout(Chain.vkImage, Chain.OriginalLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                            GetMipRange(Chain, ViewDesc.MostDetailedMip), Chain.OldStages, VK_PIPELINE_STAGE_TRANSFER_BIT);
+        }
+        MaxMipLevels = std::max(MaxMipLevels, ViewDesc.NumMipLevels);
+    }
 
-        BlitRegion.srcOffsets[1] =
-            VkOffset3D //
-            {
-                static_cast<int32_t>(std::max(TexDesc.Width >> (mip - 1), 1u)),
-                static_cast<int32_t>(std::max(TexDesc.Height >> (mip - 1), 1u)),
-                1 //
-            };
-        BlitRegion.dstOffsets[1] =
-            VkOffset3D //
-            {
-                static_cast<int32_t>(std::max(TexDesc.Width >> mip, 1u)),
-                static_cast<int32_t>(std::max(TexDesc.Height >> mip, 1u)),
-                1 //
-            };
-        if (TexDesc.Type == RESOURCE_DIM_TEX_3D)
+    // Process all textures level by level. The transitions of the next level are recorded together with
+    // the transitions of the previous level to the source layout, and are flushed by the first blit.
+    for (Uint32 Level = 1; Level < MaxMipLevels; ++Level)
+    {
+        for (const auto& Chain : Chains)
         {
-            BlitRegion.srcOffsets[1].z = std::max(TexDesc.Depth >> (mip - 1), 1u);
-            BlitRegion.dstOffsets[1].z = std::max(TexDesc.Depth >> mip, 1u);
+            if (Level < Chain.pViewDesc->NumMipLevels && Chain.OriginalLayout != VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+            {
+                CmdBuffer.TransitionImageLayout(Chain.vkImage, Chain.OriginalLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                GetMipRange(Chain, Chain.pViewDesc->MostDetailedMip + Level), Chain.OldStages, VK_PIPELINE_STAGE_TRANSFER_BIT);
+            }
         }
 
-        SubresRange.baseMipLevel = mip;
-        if (OriginalLayout != VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+        for (const auto& Chain : Chains)
         {
-            CmdBuffer.TransitionImageLayout(vkImage, OriginalLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                            SubresRange, OldStages, VK_PIPELINE_STAGE_TRANSFER_BIT);
+            if (Level < Chain.pViewDesc->NumMipLevels)
+                BlitMipLevel(Chain, Chain.pViewDesc->MostDetailedMip + Level, CmdBuffer);
         }
 
-        // For sRGB source formats, nonlinear RGB values are converted to linear representation prior to filtering.
-        // In case of sRGB destination format, linear RGB values are converted to nonlinear representation before writing the pixel to the image.
-        CmdBuffer.BlitImage(vkImage,
-                            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, //  must be VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL
-                            vkImage,
-                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, //  must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL
-                            1,
-                            &BlitRegion,
-                            VK_FILTER_LINEAR);
-        CmdBuffer.TransitionImageLayout(vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                                        SubresRange, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+        for (const auto& Chain : Chains)
+        {
+            if (Level < Chain.pViewDesc->NumMipLevels)
+            {
+                CmdBuffer.TransitionImageLayout(Chain.vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                                GetMipRange(Chain, Chain.pViewDesc->MostDetailedMip + Level), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+            }
+        }
     }
 
     const auto AffectedMipLevelLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-    // All affected mip levels are now in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL state
-    if (AffectedMipLevelLayout != OriginalLayout)
+
+    bool BarriersFlushed = false;
+    for (const auto& Chain : Chains)
     {
+        // All affected mip levels are now in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL layout
+        if (AffectedMipLevelLayout == Chain.OriginalLayout)
+            continue;
+
+        const auto& TexDesc  = *Chain.pTexDesc;
+        const auto& ViewDesc = *Chain.pViewDesc;
+
         bool IsAllSlices = (TexDesc.Type != RESOURCE_DIM_TEX_1D_ARRAY &&
                             TexDesc.Type != RESOURCE_DIM_TEX_2D_ARRAY &&
                             TexDesc.Type != RESOURCE_DIM_TEX_CUBE_ARRAY) ||
@@ -155,22 +227,63 @@ void GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx)
         bool IsAllMips = ViewDesc.NumMipLevels == TexDesc.MipLevels;
         if (IsAllSlices && IsAllMips)
         {
-            pTexVk->SetLayout(AffectedMipLevelLayout);
+            Chain.pTexVk->SetLayout(AffectedMipLevelLayout);
         }
         else
         {
-            VERIFY(OriginalLayout != VK_IMAGE_LAYOUT_UNDEFINED, "Original layout must not be undefined");
-            SubresRange.baseMipLevel = ViewDesc.MostDetailedMip;
-            SubresRange.levelCount   = ViewDesc.NumMipLevels;
+            VERIFY(Chain.OriginalLayout != VK_IMAGE_LAYOUT_UNDEFINED, "Original layout must not be undefined");
+            if (!BarriersFlushed)
+            {
+                CmdBuffer.FlushBarriers();
+                BarriersFlushed = true;
+            }
             // Transition all affected subresources back to original layout
-            CmdBuffer.FlushBarriers();
-            CmdBuffer.TransitionImageLayout(vkImage, AffectedMipLevelLayout, OriginalLayout,
-                                            SubresRange, VK_PIPELINE_STAGE_TRANSFER_BIT, OldStages);
-            VERIFY_EXPR(pTexVk->GetLayout() == OriginalLayout);
+            CmdBuffer.TransitionImageLayout(Chain.vkImage, AffectedMipLevelLayout, Chain.OriginalLayout,
+                                            GetMipRange(Chain, ViewDesc.MostDetailedMip, ViewDesc.NumMipLevels),
+                                            VK_PIPELINE_STAGE_TRANSFER_BIT, Chain.OldStages);
+            VERIFY_EXPR(Chain.pTexVk->GetLayout() == Chain.OriginalLayout);
         }
     }
 }
 
+} // namespace
+
+void GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx)
+{
+    std::vector<MipChainInfo> Chains(1);
+    if (!InitMipChain(TexView, Chains[0]))
+        return;
+
+    GenerateMipChains(Chains, Ctx);
+}
+
+void GenerateMips(TextureViewVkImpl* const* ppTexViews, Uint32 NumViews, DeviceContextVkImpl& Ctx)
+{
+    std::vector<MipChainInfo> Chains;
+    Chains.reserve(NumViews);
+    for (Uint32 i = 0; i < NumViews; ++i)
+    {
+        MipChainInfo Chain;
+        if (InitMipChain(*ppTexViews[i], Chain))
+            Chains.push_back(Chain);
+    }
+
+    // Group the textures by format and size so that similar blits are recorded
+    // next to each other, which is friendlier to the driver.
+    std::stable_sort(Chains.begin(), Chains.end(),
+                     [](const MipChainInfo& Chain0, const MipChainInfo& Chain1) {
+                         const auto& Desc0 = *Chain0.pTexDesc;
+                         const auto& Desc1 = *Chain1.pTexDesc;
+                         if (Desc0.Format != Desc1.Format)
+                             return Desc0.Format < Desc1.Format;
+                         if (Desc0.Width != Desc1.Width)
+                             return Desc0.Width > Desc1.Width;
+                         return Desc0.Height > Desc1.Height;
+                     });
+
+    GenerateMipChains(Chains, Ctx);
+}
+
 } // namespace GenerateMipsVkHelper
 
 } // namespace Diligent
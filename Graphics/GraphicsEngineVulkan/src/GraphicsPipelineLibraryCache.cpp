@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "GraphicsPipelineLibraryCache.hpp"
+
+#include "RenderDeviceVkImpl.hpp"
+
+namespace Diligent
+{
+
+static bool IsGraphicsPipelineLibrarySupported(const RenderDeviceVkImpl& DeviceVk)
+{
+    const auto& ExtFeats = DeviceVk.GetLogicalDevice().GetEnabledExtFeatures();
+    const auto& ExtProps = DeviceVk.GetPhysicalDevice().GetExtProperties();
+    // Libraries are only beneficial when linking is fast. Independent interpolation decoration
+    // allows compiling the pre-rasterization and fragment shader libraries separately.
+    return (ExtFeats.GraphicsPipelineLibrary.graphicsPipelineLibrary != VK_FALSE &&
+            ExtProps.GraphicsPipelineLibrary.graphicsPipelineLibraryFastLinking != VK_FALSE &&
+            ExtProps.GraphicsPipelineLibrary.graphicsPipelineLibraryIndependentInterpolationDecoration != VK_FALSE);
+}
+
+GraphicsPipelineLibraryCache::GraphicsPipelineLibraryCache(RenderDeviceVkImpl& DeviceVk) noexcept :
+    m_DeviceVk{DeviceVk},
+    m_IsSupported{IsGraphicsPipelineLibrarySupported(DeviceVk)}
+{}
+
+GraphicsPipelineLibraryCache::LibraryPtr GraphicsPipelineLibraryCache::Find(const Key& LibKey)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    auto it = m_Cache.find(LibKey);
+    return it != m_Cache.end() ? it->second.lock() : nullptr;
+}
+
+GraphicsPipelineLibraryCache::LibraryPtr GraphicsPipelineLibraryCache::Add(const Key& LibKey, LibraryPtr pLibrary)
+{
+    VERIFY_EXPR(pLibrary);
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    auto it_inserted = m_Cache.emplace(LibKey, pLibrary);
+    if (!it_inserted.second)
+    {
+        if (auto pExistingLibrary = it_inserted.first->second.lock())
+        {
+            // Another thread has created the same library.
+            // Our library will be released when pLibrary goes out of scope.
+            return pExistingLibrary;
+        }
+        // The library has expired - replace it
+        it_inserted.first->second = pLibrary;
+    }
+
+    // Purge expired libraries when the cache doubles in size since the last purge
+    if (m_Cache.size() >= std::max(m_NumEntriesAfterPurge * 2, size_t{64}))
+    {
+        for (auto it = m_Cache.begin(); it != m_Cache.end();)
+        {
+            if (it->second.expired())
+                it = m_Cache.erase(it);
+            else
+                ++it;
+        }
+        m_NumEntriesAfterPurge = m_Cache.size();
+    }
+
+    return pLibrary;
+}
+
+GraphicsPipelineLibraryCache::LibraryPtr GraphicsPipelineLibraryCache::MakeLibraryPtr(Library&& Lib)
+{
+    auto& DeviceVk = m_DeviceVk;
+    return LibraryPtr{
+        new Library{std::move(Lib)},
+        [&DeviceVk](Library* pLib) {
+            // Libraries are shared between pipelines that may be used by any context
+            constexpr Uint64 QueueMask = ~Uint64{0};
+            DeviceVk.SafeReleaseDeviceObject(std::move(pLib->Pipeline), QueueMask);
+            DeviceVk.SafeReleaseDeviceObject(std::move(pLib->Layout), QueueMask);
+            delete pLib;
+        }};
+}
+
+} // namespace Diligent
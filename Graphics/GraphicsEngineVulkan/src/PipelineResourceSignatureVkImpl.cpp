@@ -264,6 +264,8 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
     Uint32 StaticCacheOffset = 0;
 
     std::array<std::vector<VkDescriptorSetLayoutBinding>, DESCRIPTOR_SET_ID_NUM_SETS> vkSetLayoutBindings;
+    // Binding flags for every binding in vkSetLayoutBindings
+    std::array<std::vector<VkDescriptorBindingFlagsEXT>, DESCRIPTOR_SET_ID_NUM_SETS> vkBindingFlags;
 
     DynamicLinearAllocator TempAllocator{GetRawAllocator(), 256};
 
@@ -353,6 +355,19 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
         vkSetLayoutBinding.descriptorType     = DescriptorTypeToVkDescriptorType(pAttribs->GetDescriptorType());
         vkSetLayoutBindings[SetId].push_back(vkSetLayoutBinding);
 
+        VkDescriptorBindingFlagsEXT vkBindingFlag = 0;
+        if ((ResDesc.Flags & PIPELINE_RESOURCE_FLAG_BINDLESS) != 0)
+        {
+            VERIFY(SetId == DESCRIPTOR_SET_ID_STATIC_MUTABLE, "Bindless resources must be mutable, which should've been verified by ValidatePipelineResourceSignatureDesc");
+            // Array elements can be updated after the set has been bound, and the ones
+            // that are not dynamically used by the shader may remain invalid.
+            vkBindingFlag                       = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT;
+            m_IsStaticMutableSetUpdateAfterBind = true;
+            if (HasDevice())
+                VerifyBindlessDescriptorTypeSupport(ResDesc, pAttribs->GetDescriptorType());
+        }
+        vkBindingFlags[SetId].push_back(vkBindingFlag);
+
         if (ResDesc.VarType == SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
         {
             VERIFY(pAttribs->DescrSet == 0, "Static resources must always be allocated in descriptor set 0");
@@ -369,6 +384,16 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
     }
 #endif
 
+    if (m_IsStaticMutableSetUpdateAfterBind &&
+        (CacheGroupSizes[CACHE_GROUP_DYN_UB_STAT_VAR] != 0 || CacheGroupSizes[CACHE_GROUP_DYN_SB_STAT_VAR] != 0))
+    {
+        // VUID-VkDescriptorSetLayoutCreateInfo-descriptorType-03001
+        LOG_ERROR_AND_THROW("Description of a pipeline resource signature '", m_Desc.Name,
+                            "' is invalid: the signature contains bindless resources, so all static and mutable buffers "
+                            "must be defined with PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS or PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER flag. "
+                            "Buffers with dynamic offsets are not allowed in update-after-bind descriptor sets.");
+    }
+
     m_DynamicUniformBufferCount = static_cast<Uint16>(CacheGroupSizes[CACHE_GROUP_DYN_UB_STAT_VAR] + CacheGroupSizes[CACHE_GROUP_DYN_UB_DYN_VAR]);
     m_DynamicStorageBufferCount = static_cast<Uint16>(CacheGroupSizes[CACHE_GROUP_DYN_SB_STAT_VAR] + CacheGroupSizes[CACHE_GROUP_DYN_SB_DYN_VAR]);
     VERIFY_EXPR(m_DynamicUniformBufferCount == CacheGroupSizes[CACHE_GROUP_DYN_UB_STAT_VAR] + CacheGroupSizes[CACHE_GROUP_DYN_UB_DYN_VAR]);
@@ -442,6 +467,7 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
         vkSetLayoutBinding.descriptorType     = VK_DESCRIPTOR_TYPE_SAMPLER;
         vkSetLayoutBinding.pImmutableSamplers = TempAllocator.Construct<VkSampler>(ImmutableSampler.GetVkSampler());
         vkSetLayoutBindings[SetId].push_back(vkSetLayoutBinding);
+        vkBindingFlags[SetId].push_back(0);
     }
 
     Uint32 NumSets = 0;
@@ -485,9 +511,165 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
 
             SetLayoutCI.bindingCount = StaticCast<uint32_t>(vkSetLayoutBinding.size());
             SetLayoutCI.pBindings    = vkSetLayoutBinding.data();
-            m_VkDescrSetLayouts[i]   = LogicalDevice.CreateDescriptorSetLayout(SetLayoutCI);
+
+            VkDescriptorSetLayoutBindingFlagsCreateInfoEXT BindingFlagsCI{};
+            if (i == DESCRIPTOR_SET_ID_STATIC_MUTABLE && m_IsStaticMutableSetUpdateAfterBind)
+            {
+                VERIFY_EXPR(vkBindingFlags[i].size() == vkSetLayoutBinding.size());
+                BindingFlagsCI.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+                BindingFlagsCI.bindingCount  = SetLayoutCI.bindingCount;
+                BindingFlagsCI.pBindingFlags = vkBindingFlags[i].data();
+
+                SetLayoutCI.pNext = &BindingFlagsCI;
+                SetLayoutCI.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+            }
+            else
+            {
+                SetLayoutCI.pNext = nullptr;
+                SetLayoutCI.flags = 0;
+            }
+            m_VkDescrSetLayouts[i] = LogicalDevice.CreateDescriptorSetLayout(SetLayoutCI);
         }
         VERIFY_EXPR(NumSets == GetNumDescriptorSets());
+
+        // vkUpdateDescriptorSetWithTemplate is core in Vulkan 1.1
+        if (GetDevice()->GetPhysicalDevice().GetVkVersion() >= VK_API_VERSION_1_1)
+        {
+            if (m_VkDescrSetLayouts[DESCRIPTOR_SET_ID_DYNAMIC])
+                m_DynamicSetUpdateTemplate = CreateSetUpdateTemplate(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, DESCRIPTOR_SET_ID_DYNAMIC);
+            if (m_VkDescrSetLayouts[DESCRIPTOR_SET_ID_STATIC_MUTABLE])
+                m_StaticVarsUpdateTemplate = CreateSetUpdateTemplate(SHADER_RESOURCE_VARIABLE_TYPE_STATIC, DESCRIPTOR_SET_ID_STATIC_MUTABLE);
+        }
+    }
+}
+
+VulkanUtilities::DescrUpdateTemplateWrapper PipelineResourceSignatureVkImpl::CreateSetUpdateTemplate(SHADER_RESOURCE_VARIABLE_TYPE VarType, DESCRIPTOR_SET_ID SetId) const
+{
+    VERIFY_EXPR(VarTypeToDescriptorSetId(VarType) == SetId);
+
+    const auto ResIdxRange = GetResourceIndexRange(VarType);
+
+    std::vector<VkDescriptorUpdateTemplateEntry> Entries;
+    Entries.reserve(ResIdxRange.second - ResIdxRange.first);
+    for (Uint32 r = ResIdxRange.first; r < ResIdxRange.second; ++r)
+    {
+        const auto& Attr = GetResourceAttribs(r);
+        // Immutable samplers are permanently bound into the set layout
+        if (Attr.GetDescriptorType() == DescriptorType::Sampler && Attr.IsImmutableSamplerAssigned())
+            continue;
+
+        VkDescriptorUpdateTemplateEntry Entry{};
+        Entry.dstBinding      = Attr.BindingIndex;
+        Entry.dstArrayElement = 0;
+        Entry.descriptorCount = Attr.ArraySize;
+        Entry.descriptorType  = DescriptorTypeToVkDescriptorType(Attr.GetDescriptorType());
+        Entry.offset          = size_t{Attr.CacheOffset(ResourceCacheContentType::SRB)} * sizeof(DescriptorUpdateData);
+        Entry.stride          = sizeof(DescriptorUpdateData);
+        Entries.push_back(Entry);
+    }
+    if (Entries.empty())
+        return {};
+
+    VkDescriptorUpdateTemplateCreateInfo TemplateCI{};
+    TemplateCI.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+    TemplateCI.descriptorUpdateEntryCount = StaticCast<uint32_t>(Entries.size());
+    TemplateCI.pDescriptorUpdateEntries   = Entries.data();
+    TemplateCI.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+    TemplateCI.descriptorSetLayout        = m_VkDescrSetLayouts[SetId];
+
+    return GetDevice()->GetLogicalDevice().CreateDescriptorUpdateTemplate(TemplateCI, m_Desc.Name);
+}
+
+PipelineResourceSignatureVkImpl::DescriptorUpdateData PipelineResourceSignatureVkImpl::GetDescriptorUpdateData(DescriptorType DescrType, const ShaderResourceCacheVk::Resource& CachedRes)
+{
+    DescriptorUpdateData Data;
+
+    static_assert(static_cast<Uint32>(DescriptorType::Count) == 16, "Please update the switch below to handle the new descriptor type");
+    switch (DescrType)
+    {
+        case DescriptorType::UniformBuffer:
+        case DescriptorType::UniformBufferDynamic:
+            Data.BufferInfo = CachedRes.GetUniformBufferDescriptorWriteInfo();
+            break;
+
+        case DescriptorType::StorageBuffer:
+        case DescriptorType::StorageBufferDynamic:
+        case DescriptorType::StorageBuffer_ReadOnly:
+        case DescriptorType::StorageBufferDynamic_ReadOnly:
+            Data.BufferInfo = CachedRes.GetStorageBufferDescriptorWriteInfo();
+            break;
+
+        case DescriptorType::UniformTexelBuffer:
+        case DescriptorType::StorageTexelBuffer:
+        case DescriptorType::StorageTexelBuffer_ReadOnly:
+            Data.BufferView = CachedRes.GetBufferViewWriteInfo();
+            break;
+
+        case DescriptorType::CombinedImageSampler:
+        case DescriptorType::SeparateImage:
+        case DescriptorType::StorageImage:
+            Data.ImageInfo = CachedRes.GetImageDescriptorWriteInfo();
+            break;
+
+        case DescriptorType::InputAttachment:
+        case DescriptorType::InputAttachment_General:
+            Data.ImageInfo = CachedRes.GetInputAttachmentDescriptorWriteInfo();
+            break;
+
+        case DescriptorType::Sampler:
+            Data.ImageInfo = CachedRes.GetSamplerDescriptorWriteInfo();
+            break;
+
+        case DescriptorType::AccelerationStructure:
+            Data.AccelStruct = *CachedRes.GetAccelerationStructureWriteInfo().pAccelerationStructures;
+            break;
+
+        default:
+            UNEXPECTED("Unexpected resource type");
+    }
+
+    return Data;
+}
+
+void PipelineResourceSignatureVkImpl::VerifyBindlessDescriptorTypeSupport(const PipelineResourceDesc& ResDesc, DescriptorType DescrType) const
+{
+    const auto& DescIndFeats = GetDevice()->GetLogicalDevice().GetEnabledExtFeatures().DescriptorIndexing;
+
+    VkBool32 UpdateAfterBindSupported = VK_FALSE;
+    switch (DescrType)
+    {
+        case DescriptorType::CombinedImageSampler:
+        case DescriptorType::SeparateImage:
+            UpdateAfterBindSupported = DescIndFeats.descriptorBindingSampledImageUpdateAfterBind;
+            break;
+
+        case DescriptorType::StorageImage:
+            UpdateAfterBindSupported = DescIndFeats.descriptorBindingStorageImageUpdateAfterBind;
+            break;
+
+        case DescriptorType::UniformTexelBuffer:
+            UpdateAfterBindSupported = DescIndFeats.descriptorBindingUniformTexelBufferUpdateAfterBind;
+            break;
+
+        case DescriptorType::StorageTexelBuffer:
+        case DescriptorType::StorageTexelBuffer_ReadOnly:
+            UpdateAfterBindSupported = DescIndFeats.descriptorBindingStorageTexelBufferUpdateAfterBind;
+            break;
+
+        case DescriptorType::StorageBuffer:
+        case DescriptorType::StorageBuffer_ReadOnly:
+            UpdateAfterBindSupported = DescIndFeats.descriptorBindingStorageBufferUpdateAfterBind;
+            break;
+
+        default:
+            UNEXPECTED("Unexpected descriptor type for a bindless resource");
+    }
+
+    if (UpdateAfterBindSupported == VK_FALSE || DescIndFeats.descriptorBindingPartiallyBound == VK_FALSE)
+    {
+        LOG_ERROR_AND_THROW("Bindless resource '", ResDesc.Name, "' in pipeline resource signature '", m_Desc.Name,
+                            "' is not supported by the device: update-after-bind and partially bound descriptors of this type are not enabled. "
+                            "Note that VK_EXT_descriptor_indexing extension is only enabled when ShaderResourceRuntimeArray device feature is enabled.");
     }
 }
 
@@ -504,6 +686,11 @@ void PipelineResourceSignatureVkImpl::Destruct()
             GetDevice()->SafeReleaseDeviceObject(std::move(Layout), ~0ull);
     }
 
+    if (m_DynamicSetUpdateTemplate)
+        GetDevice()->SafeReleaseDeviceObject(std::move(m_DynamicSetUpdateTemplate), ~0ull);
+    if (m_StaticVarsUpdateTemplate)
+        GetDevice()->SafeReleaseDeviceObject(std::move(m_StaticVarsUpdateTemplate), ~0ull);
+
     if (m_ImmutableSamplers != nullptr)
     {
         for (Uint32 i = 0; i < m_Desc.NumImmutableSamplers; ++i)
@@ -549,7 +736,9 @@ void PipelineResourceSignatureVkImpl::InitSRBResourceCache(ShaderResourceCacheVk
         _DescrSetName.append(" - static/mutable set");
         DescrSetName = _DescrSetName.c_str();
 #endif
-        DescriptorSetAllocation SetAllocation = GetDevice()->AllocateDescriptorSet(~Uint64{0}, vkLayout, DescrSetName);
+        DescriptorSetAllocation SetAllocation = m_IsStaticMutableSetUpdateAfterBind ?
+            GetDevice()->AllocateBindlessDescriptorSet(~Uint64{0}, vkLayout, DescrSetName) :
+            GetDevice()->AllocateDescriptorSet(~Uint64{0}, vkLayout, DescrSetName);
         ResourceCache.AssignDescriptorSetAllocation(GetDescriptorSetIndex<DESCRIPTOR_SET_ID_STATIC_MUTABLE>(), std::move(SetAllocation));
     }
 }
@@ -570,6 +759,9 @@ void PipelineResourceSignatureVkImpl::CopyStaticResources(ShaderResourceCacheVk&
     const auto  SrcCacheType     = SrcResourceCache.GetContentType();
     const auto  DstCacheType     = DstResourceCache.GetContentType();
 
+    if (m_StaticVarsUpdateTemplate && DstDescrSet.GetVkDescriptorSet() != VK_NULL_HANDLE && CopyStaticResourcesWithTemplate(DstResourceCache))
+        return;
+
     for (Uint32 r = ResIdxRange.first; r < ResIdxRange.second; ++r)
     {
         const auto& ResDesc = GetResourceDesc(r);
@@ -618,6 +810,71 @@ void PipelineResourceSignatureVkImpl::CopyStaticResources(ShaderResourceCacheVk&
 #endif
 }
 
+bool PipelineResourceSignatureVkImpl::CopyStaticResourcesWithTemplate(ShaderResourceCacheVk& DstResourceCache) const
+{
+    VERIFY_EXPR(m_StaticVarsUpdateTemplate);
+    VERIFY_EXPR(DstResourceCache.GetContentType() == ResourceCacheContentType::SRB);
+
+    const auto& SrcResourceCache = *m_pStaticResCache;
+    const auto  StaticSetIdx     = GetDescriptorSetIndex<DESCRIPTOR_SET_ID_STATIC_MUTABLE>();
+    const auto& SrcDescrSet      = SrcResourceCache.GetDescriptorSet(StaticSetIdx);
+    const auto& DstDescrSet      = const_cast<const ShaderResourceCacheVk&>(DstResourceCache).GetDescriptorSet(StaticSetIdx);
+    const auto  ResIdxRange      = GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
+    const auto  SrcCacheType     = SrcResourceCache.GetContentType();
+
+    constexpr auto DstCacheType = ResourceCacheContentType::SRB;
+
+    // The template writes every array element, so unbound static resources must be handled by the regular path
+    for (Uint32 r = ResIdxRange.first; r < ResIdxRange.second; ++r)
+    {
+        const auto& Attr = GetResourceAttribs(r);
+        if (Attr.GetDescriptorType() == DescriptorType::Sampler && Attr.IsImmutableSamplerAssigned())
+            continue;
+
+        for (Uint32 ArrInd = 0; ArrInd < Attr.ArraySize; ++ArrInd)
+        {
+            const auto& DstCachedRes = DstDescrSet.GetResource(Attr.CacheOffset(DstCacheType) + ArrInd);
+            if (!SrcDescrSet.GetResource(Attr.CacheOffset(SrcCacheType) + ArrInd) || DstCachedRes)
+                return false;
+        }
+    }
+
+    std::vector<DescriptorUpdateData> UpdateData(DstDescrSet.GetSize());
+    for (Uint32 r = ResIdxRange.first; r < ResIdxRange.second; ++r)
+    {
+        const auto& Attr      = GetResourceAttribs(r);
+        const auto  DescrType = Attr.GetDescriptorType();
+        if (DescrType == DescriptorType::Sampler && Attr.IsImmutableSamplerAssigned())
+            continue;
+
+        for (Uint32 ArrInd = 0; ArrInd < Attr.ArraySize; ++ArrInd)
+        {
+            const auto  DstCacheOffset = Attr.CacheOffset(DstCacheType) + ArrInd;
+            const auto& SrcCachedRes   = SrcDescrSet.GetResource(Attr.CacheOffset(SrcCacheType) + ArrInd);
+
+            // Null logical device: the descriptor is written below with the update template
+            const auto& DstCachedRes   = DstResourceCache.SetResource(nullptr,
+                                                                    StaticSetIdx,
+                                                                    DstCacheOffset,
+                                                                    {
+                                                                        Attr.BindingIndex,
+                                                                        ArrInd,
+                                                                        RefCntAutoPtr<IDeviceObject>{SrcCachedRes.pObject},
+                                                                        SrcCachedRes.BufferBaseOffset,
+                                                                        SrcCachedRes.BufferRangeSize //
+                                                                    });
+            UpdateData[DstCacheOffset] = GetDescriptorUpdateData(DescrType, DstCachedRes);
+        }
+    }
+
+    GetDevice()->GetLogicalDevice().UpdateDescriptorSetWithTemplate(DstDescrSet.GetVkDescriptorSet(), m_StaticVarsUpdateTemplate, UpdateData.data());
+
+#ifdef DILIGENT_DEBUG
+    DstResourceCache.DbgVerifyDynamicBuffersCounter();
+#endif
+    return true;
+}
+
 template <>
 Uint32 PipelineResourceSignatureVkImpl::GetDescriptorSetIndex<PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_STATIC_MUTABLE>() const
 {
@@ -632,13 +889,56 @@ Uint32 PipelineResourceSignatureVkImpl::GetDescriptorSetIndex<PipelineResourceSi
     return HasDescriptorSet(DESCRIPTOR_SET_ID_STATIC_MUTABLE) ? 1 : 0;
 }
 
-void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
-                                                             VkDescriptorSet              vkDynamicDescriptorSet) const
+bool PipelineResourceSignatureVkImpl::CommitDynamicResourcesWithTemplate(const ShaderResourceCacheVk&       ResourceCache,
+                                                                         VkDescriptorSet                    vkDynamicDescriptorSet,
+                                                                         std::vector<DescriptorUpdateData>& UpdateData) const
+{
+    VERIFY_EXPR(m_DynamicSetUpdateTemplate);
+
+    const auto  DynamicSetIdx  = GetDescriptorSetIndex<DESCRIPTOR_SET_ID_DYNAMIC>();
+    const auto& SetResources   = ResourceCache.GetDescriptorSet(DynamicSetIdx);
+    const auto  DynResIdxRange = GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+
+    if (UpdateData.size() < SetResources.GetSize())
+        UpdateData.resize(SetResources.GetSize());
+
+    constexpr auto CacheType = ResourceCacheContentType::SRB;
+    for (Uint32 ResIdx = DynResIdxRange.first; ResIdx < DynResIdxRange.second; ++ResIdx)
+    {
+        const auto& Attr        = GetResourceAttribs(ResIdx);
+        const auto  CacheOffset = Attr.CacheOffset(CacheType);
+        const auto  DescrType   = Attr.GetDescriptorType();
+
+        if (DescrType == DescriptorType::Sampler && Attr.IsImmutableSamplerAssigned())
+            continue;
+
+        for (Uint32 ArrElem = 0; ArrElem < Attr.ArraySize; ++ArrElem)
+        {
+            const auto& CachedRes = SetResources.GetResource(CacheOffset + ArrElem);
+            // The template writes every array element, so null resources must be skipped by the regular path
+            if (!CachedRes)
+                return false;
+
+            UpdateData[CacheOffset + ArrElem] = GetDescriptorUpdateData(DescrType, CachedRes);
+        }
+    }
+
+    GetDevice()->GetLogicalDevice().UpdateDescriptorSetWithTemplate(vkDynamicDescriptorSet, m_DynamicSetUpdateTemplate, UpdateData.data());
+    return true;
+}
+
+void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourceCacheVk&       ResourceCache,
+                                                             VkDescriptorSet                    vkDynamicDescriptorSet,
+                                                             std::vector<DescriptorUpdateData>& UpdateData) const
 {
     VERIFY(HasDescriptorSet(DESCRIPTOR_SET_ID_DYNAMIC), "This signature does not contain dynamic resources");
     VERIFY_EXPR(vkDynamicDescriptorSet != VK_NULL_HANDLE);
     VERIFY_EXPR(ResourceCache.GetContentType() == ResourceCacheContentType::SRB);
 
+    // Write all descriptors with a single call when every array element is bound
+    if (m_DynamicSetUpdateTemplate && CommitDynamicResourcesWithTemplate(ResourceCache, vkDynamicDescriptorSet, UpdateData))
+        return;
+
 #ifdef DILIGENT_DEBUG
     static constexpr size_t ImgUpdateBatchSize          = 4;
     static constexpr size_t BuffUpdateBatchSize         = 2;
@@ -847,6 +1147,11 @@ bool PipelineResourceSignatureVkImpl::DvpValidateCommittedResource(const DeviceC
         const auto& Res = DescrSetResources.GetResource(CacheOffset + ArrIndex);
         if (Res.IsNull())
         {
+            // Bindless arrays are partially bound, and the shader is expected
+            // to only access the elements that are set by the application.
+            if ((ResDesc.Flags & PIPELINE_RESOURCE_FLAG_BINDLESS) != 0)
+                continue;
+
             LOG_ERROR_MESSAGE("No resource is bound to variable '", GetShaderResourcePrintName(SPIRVAttribs, ArrIndex),
                               "' in shader '", ShaderName, "' of PSO '", PSOName, "'");
             BindingsOK = false;
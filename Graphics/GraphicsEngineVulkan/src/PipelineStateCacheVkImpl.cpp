@@ -29,10 +29,91 @@
 #include "RenderDeviceVkImpl.hpp"
 #include "VulkanTypeConversions.hpp"
 #include "DataBlobImpl.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
 
+namespace
+{
+
+// Header of the container that wraps the driver cache data returned by GetData().
+// In addition to the fields of VkPipelineCacheHeaderVersionOne, the container records the driver
+// version and the hash of the data, so that stale or corrupted caches are rejected.
+struct PipelineCacheContainerHeader
+{
+    static constexpr Uint32 ExpectedMagic   = 0x43505644; // DVPC
+    static constexpr Uint32 ExpectedVersion = 1;
+
+    Uint32 Magic   = ExpectedMagic;
+    Uint32 Version = ExpectedVersion;
+
+    Uint32 VendorID      = 0;
+    Uint32 DeviceID      = 0;
+    Uint32 DriverVersion = 0;
+    Uint32 Padding       = 0;
+
+    Uint8 PipelineCacheUUID[VK_UUID_SIZE] = {};
+
+    Uint64 DataSize = 0;
+    Uint64 DataHash = 0;
+};
+static_assert(sizeof(PipelineCacheContainerHeader) == 56, "Changing the size of the header requires incrementing the version");
+
+bool IsCompatibleDriverData(const void* pData, size_t DataSize, const VkPhysicalDeviceProperties& Props)
+{
+    if (pData == nullptr || DataSize <= sizeof(VkPipelineCacheHeaderVersionOne))
+        return false;
+
+    VkPipelineCacheHeaderVersionOne HeaderVersion;
+    std::memcpy(&HeaderVersion, pData, sizeof(HeaderVersion));
+
+    return (HeaderVersion.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+            HeaderVersion.headerSize == 32 && // from specs
+            HeaderVersion.deviceID == Props.deviceID &&
+            HeaderVersion.vendorID == Props.vendorID &&
+            std::memcmp(HeaderVersion.pipelineCacheUUID, Props.pipelineCacheUUID, sizeof(HeaderVersion.pipelineCacheUUID)) == 0);
+}
+
+// Returns the driver data stored in the container, or null if the container is not compatible with the device.
+const void* UnpackContainer(const void* pData, size_t DataSize, const VkPhysicalDeviceProperties& Props, size_t& DriverDataSize)
+{
+    DriverDataSize = 0;
+
+    PipelineCacheContainerHeader Header;
+    std::memcpy(&Header, pData, sizeof(Header));
+
+    const char* Reason = nullptr;
+    if (Header.Version != PipelineCacheContainerHeader::ExpectedVersion)
+        Reason = "container version mismatch";
+    else if (Header.VendorID != Props.vendorID || Header.DeviceID != Props.deviceID)
+        Reason = "the data was created for a different device";
+    else if (Header.DriverVersion != Props.driverVersion)
+        Reason = "driver version mismatch";
+    else if (std::memcmp(Header.PipelineCacheUUID, Props.pipelineCacheUUID, sizeof(Header.PipelineCacheUUID)) != 0)
+        Reason = "pipeline cache UUID mismatch";
+    else if (Header.DataSize != DataSize - sizeof(Header))
+        Reason = "the data is truncated";
+
+    const auto* pDriverData = static_cast<const Uint8*>(pData) + sizeof(Header);
+    if (Reason == nullptr && Header.DataHash != Uint64{ComputeHashRaw(pDriverData, static_cast<size_t>(Header.DataSize))})
+        Reason = "the data is corrupted";
+
+    if (Reason == nullptr && !IsCompatibleDriverData(pDriverData, static_cast<size_t>(Header.DataSize), Props))
+        Reason = "the driver data header is not compatible with the device";
+
+    if (Reason != nullptr)
+    {
+        LOG_INFO_MESSAGE("Pipeline cache data is ignored: ", Reason);
+        return nullptr;
+    }
+
+    DriverDataSize = static_cast<size_t>(Header.DataSize);
+    return pDriverData;
+}
+
+} // namespace
+
 PipelineStateCacheVkImpl::PipelineStateCacheVkImpl(IReferenceCounters*                 pRefCounters,
                                                    RenderDeviceVkImpl*                 pRenderDeviceVk,
                                                    const PipelineStateCacheCreateInfo& CreateInfo) :
@@ -49,52 +130,129 @@ PipelineStateCacheVkImpl::PipelineStateCacheVkImpl(IReferenceCounters*
     // Separate load/store is not supported in Vulkan.
     m_Desc.Mode |= PSO_CACHE_MODE_LOAD | PSO_CACHE_MODE_STORE;
 
-    VkPipelineCacheCreateInfo VkPipelineStateCacheCI{};
-    VkPipelineStateCacheCI.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-
-    if (CreateInfo.pCacheData != nullptr && CreateInfo.CacheDataSize > sizeof(VkPipelineCacheHeaderVersionOne))
+    if (CreateInfo.pCacheData != nullptr)
     {
         const auto& Props = GetDevice()->GetPhysicalDevice().GetProperties();
 
-        VkPipelineCacheHeaderVersionOne HeaderVersion;
-        std::memcpy(&HeaderVersion, CreateInfo.pCacheData, sizeof(HeaderVersion));
+        const void* pDriverData    = nullptr;
+        size_t      DriverDataSize = 0;
 
-        if (HeaderVersion.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
-            HeaderVersion.headerSize == 32 && // from specs
-            HeaderVersion.deviceID == Props.deviceID &&
-            HeaderVersion.vendorID == Props.vendorID &&
-            std::memcmp(HeaderVersion.pipelineCacheUUID, Props.pipelineCacheUUID, sizeof(HeaderVersion.pipelineCacheUUID)) == 0)
+        Uint32 Magic = 0;
+        if (CreateInfo.CacheDataSize >= sizeof(PipelineCacheContainerHeader))
+            std::memcpy(&Magic, CreateInfo.pCacheData, sizeof(Magic));
+
+        if (Magic == PipelineCacheContainerHeader::ExpectedMagic)
+        {
+            pDriverData = UnpackContainer(CreateInfo.pCacheData, CreateInfo.CacheDataSize, Props, DriverDataSize);
+        }
+        else if (IsCompatibleDriverData(CreateInfo.pCacheData, CreateInfo.CacheDataSize, Props))
         {
-            VkPipelineStateCacheCI.initialDataSize = CreateInfo.CacheDataSize;
-            VkPipelineStateCacheCI.pInitialData    = CreateInfo.pCacheData;
+            // Raw driver data, e.g. produced by an older version of the engine.
+            pDriverData    = CreateInfo.pCacheData;
+            DriverDataSize = CreateInfo.CacheDataSize;
+        }
+
+        if (pDriverData != nullptr)
+        {
+            const auto* pBytes = static_cast<const Uint8*>(pDriverData);
+            m_InitialData.assign(pBytes, pBytes + DriverDataSize);
         }
     }
 
+    VkPipelineCacheCreateInfo VkPipelineStateCacheCI{};
+    VkPipelineStateCacheCI.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    VkPipelineStateCacheCI.initialDataSize = m_InitialData.size();
+    VkPipelineStateCacheCI.pInitialData    = !m_InitialData.empty() ? m_InitialData.data() : nullptr;
+
     m_PipelineStateCache = m_pDevice->GetLogicalDevice().CreatePipelineCache(VkPipelineStateCacheCI, m_Desc.Name);
 }
 
 PipelineStateCacheVkImpl::~PipelineStateCacheVkImpl()
 {
     // Vk object can only be destroyed when it is no longer used by the GPU
+    for (auto& it : m_ThreadCaches)
+    {
+        if (it.second != VK_NULL_HANDLE)
+            m_pDevice->SafeReleaseDeviceObject(std::move(it.second), ~Uint64{0});
+    }
     if (m_PipelineStateCache != VK_NULL_HANDLE)
         m_pDevice->SafeReleaseDeviceObject(std::move(m_PipelineStateCache), ~Uint64{0});
 }
 
+VkPipelineCache PipelineStateCacheVkImpl::GetThreadVkPipelineCache()
+{
+    std::lock_guard<std::mutex> Lock{m_CachesMtx};
+
+    auto& ThreadCache = m_ThreadCaches[std::this_thread::get_id()];
+    if (ThreadCache == VK_NULL_HANDLE)
+    {
+        VkPipelineCacheCreateInfo VkPipelineStateCacheCI{};
+        VkPipelineStateCacheCI.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        VkPipelineStateCacheCI.initialDataSize = m_InitialData.size();
+        VkPipelineStateCacheCI.pInitialData    = !m_InitialData.empty() ? m_InitialData.data() : nullptr;
+
+        ThreadCache = m_pDevice->GetLogicalDevice().CreatePipelineCache(VkPipelineStateCacheCI, m_Desc.Name);
+    }
+    return ThreadCache;
+}
+
+void PipelineStateCacheVkImpl::MergeThreadCaches()
+{
+    // m_CachesMtx must be locked.
+    if (m_ThreadCaches.empty())
+        return;
+
+    std::vector<VkPipelineCache> vkSrcCaches;
+    vkSrcCaches.reserve(m_ThreadCaches.size());
+    for (const auto& it : m_ThreadCaches)
+    {
+        if (it.second != VK_NULL_HANDLE)
+            vkSrcCaches.push_back(it.second);
+    }
+    if (vkSrcCaches.empty())
+        return;
+
+    // Only the destination cache requires external synchronization, so threads may keep
+    // creating pipelines with their caches while they are merged.
+    const auto vkDevice = m_pDevice->GetLogicalDevice().GetVkDevice();
+    if (vkMergePipelineCaches(vkDevice, m_PipelineStateCache, static_cast<Uint32>(vkSrcCaches.size()), vkSrcCaches.data()) != VK_SUCCESS)
+        LOG_ERROR_MESSAGE("Failed to merge thread pipeline caches");
+}
+
 void PipelineStateCacheVkImpl::GetData(IDataBlob** ppBlob)
 {
     DEV_CHECK_ERR(ppBlob != nullptr, "ppBlob must not be null");
     *ppBlob = nullptr;
 
+    std::lock_guard<std::mutex> Lock{m_CachesMtx};
+
+    MergeThreadCaches();
+
     const auto vkDevice = m_pDevice->GetLogicalDevice().GetVkDevice();
 
     size_t DataSize = 0;
     if (vkGetPipelineCacheData(vkDevice, m_PipelineStateCache, &DataSize, nullptr) != VK_SUCCESS)
         return;
 
-    auto pDataBlob = DataBlobImpl::Create(DataSize);
+    auto pDataBlob   = DataBlobImpl::Create(sizeof(PipelineCacheContainerHeader) + DataSize);
+    auto pDriverData = pDataBlob->GetDataPtr<Uint8>() + sizeof(PipelineCacheContainerHeader);
 
-    if (vkGetPipelineCacheData(vkDevice, m_PipelineStateCache, &DataSize, pDataBlob->GetDataPtr()) != VK_SUCCESS)
+    // The driver may return less data than it reported
+    if (vkGetPipelineCacheData(vkDevice, m_PipelineStateCache, &DataSize, pDriverData) != VK_SUCCESS)
         return;
+    pDataBlob->Resize(sizeof(PipelineCacheContainerHeader) + DataSize);
+    pDriverData = pDataBlob->GetDataPtr<Uint8>() + sizeof(PipelineCacheContainerHeader);
+
+    const auto& Props = GetDevice()->GetPhysicalDevice().GetProperties();
+
+    PipelineCacheContainerHeader Header;
+    Header.VendorID      = Props.vendorID;
+    Header.DeviceID      = Props.deviceID;
+    Header.DriverVersion = Props.driverVersion;
+    std::memcpy(Header.PipelineCacheUUID, Props.pipelineCacheUUID, sizeof(Header.PipelineCacheUUID));
+    Header.DataSize = DataSize;
+    Header.DataHash = ComputeHashRaw(pDriverData, DataSize);
+    std::memcpy(pDataBlob->GetDataPtr(), &Header, sizeof(Header));
 
     *ppBlob = pDataBlob.Detach();
 }
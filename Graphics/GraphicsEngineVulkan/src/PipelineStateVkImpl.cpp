@@ -30,6 +30,8 @@
 #include "PipelineStateVkImpl.hpp"
 
 #include <array>
+#include <cstring>
+#include <memory>
 #include <unordered_map>
 
 #include "RenderDeviceVkImpl.hpp"
@@ -55,6 +57,14 @@ constexpr INTERFACE_ID PipelineStateVkImpl::IID_InternalImpl;
 namespace
 {
 
+// Shader stages that are used to create graphics and compute pipelines
+struct InternalShaderStages
+{
+    std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
+    std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
+    PipelineStateVkImpl::TShaderStages                ShaderStages;
+};
+
 void InitPipelineShaderStages(const VulkanUtilities::VulkanLogicalDevice&        LogicalDevice,
                               PipelineStateVkImpl::TShaderStages&                ShaderStages,
                               std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules,
@@ -101,15 +111,21 @@ void InitPipelineShaderStages(const VulkanUtilities::VulkanLogicalDevice&
 }
 
 
-void CreateComputePipeline(RenderDeviceVkImpl*                           pDeviceVk,
+// Returns false if FailIfCompileRequired is true and the pipeline can't be created without compilation.
+bool CreateComputePipeline(RenderDeviceVkImpl*                           pDeviceVk,
                            std::vector<VkPipelineShaderStageCreateInfo>& Stages,
                            const PipelineLayoutVk&                       Layout,
                            const PipelineStateDesc&                      PSODesc,
                            VulkanUtilities::PipelineWrapper&             Pipeline,
-                           VkPipelineCache                               vkPSOCache)
+                           VkPipelineCache                               vkPSOCache,
+                           bool                                          FailIfCompileRequired)
 {
     const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
 
+    // Without the pipeline creation cache control, the cache can't be probed
+    if (FailIfCompileRequired && LogicalDevice.GetEnabledExtFeatures().PipelineCreationCacheControl.pipelineCreationCacheControl == VK_FALSE)
+        return false;
+
     VkComputePipelineCreateInfo PipelineCI{};
     PipelineCI.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
     PipelineCI.pNext = nullptr;
@@ -121,24 +137,396 @@ void CreateComputePipeline(RenderDeviceVkImpl*                           pDevice
 
     PipelineCI.stage  = Stages[0];
     PipelineCI.layout = Layout.GetVkPipelineLayout();
+    if (FailIfCompileRequired)
+        PipelineCI.flags |= VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT_EXT;
 
     Pipeline = LogicalDevice.CreateComputePipeline(PipelineCI, vkPSOCache, PSODesc.Name);
+    return Pipeline != VK_NULL_HANDLE;
+}
+
+
+using GPLCache = GraphicsPipelineLibraryCache;
+
+void AddShaderStagesToKey(GPLCache::Key&                                      Key,
+                          const std::vector<VkPipelineShaderStageCreateInfo>& Stages,
+                          const PipelineStateVkImpl::TShaderStages&           ShaderStages,
+                          bool                                                FragmentStage)
+{
+    VERIFY_EXPR(Stages.size() == ShaderStages.size());
+    for (size_t i = 0; i < Stages.size(); ++i)
+    {
+        const auto& StageCI = Stages[i];
+        if ((StageCI.stage == VK_SHADER_STAGE_FRAGMENT_BIT) != FragmentStage)
+            continue;
+
+        // Graphics pipelines have exactly one shader per stage
+        VERIFY_EXPR(ShaderStages[i].SPIRVs.size() == 1);
+        const auto& SPIRV = ShaderStages[i].SPIRVs[0];
+
+        Key.Add(StageCI.stage, SPIRV.size());
+        // Use the byte code itself rather than its hash as a collision would silently produce a wrong pipeline
+        Key.AddRaw(SPIRV.data(), SPIRV.size() * sizeof(SPIRV[0]));
+        Key.AddRaw(StageCI.pName, strlen(StageCI.pName) + 1);
+    }
+}
+
+void AddDynamicStatesToKey(GPLCache::Key& Key, const VkPipelineDynamicStateCreateInfo& DynamicStateCI)
+{
+    Key.Add(DynamicStateCI.dynamicStateCount);
+    for (uint32_t i = 0; i < DynamicStateCI.dynamicStateCount; ++i)
+        Key.Add(DynamicStateCI.pDynamicStates[i]);
+}
+
+void AddLayoutToKey(GPLCache::Key& Key, const PipelineLayoutVk& Layout)
+{
+    const auto  SetCount   = Layout.GetDescrSetCount();
+    const auto* SetLayouts = Layout.GetVkDescriptorSetLayouts();
+    Key.Add(SetCount);
+    for (Uint32 i = 0; i < SetCount; ++i)
+        Key.Add(SetLayouts[i]);
+}
+
+void AddMultisampleStateToKey(GPLCache::Key& Key, const VkPipelineMultisampleStateCreateInfo& MSStateCI)
+{
+    Key.Add(MSStateCI.rasterizationSamples,
+            MSStateCI.sampleShadingEnable,
+            MSStateCI.minSampleShading,
+            MSStateCI.alphaToCoverageEnable,
+            MSStateCI.alphaToOneEnable);
+    const uint32_t SampleMaskSize = (static_cast<uint32_t>(MSStateCI.rasterizationSamples) + 31) / 32;
+    for (uint32_t i = 0; i < SampleMaskSize; ++i)
+        Key.Add(MSStateCI.pSampleMask[i]);
+}
+
+void AddStencilOpStateToKey(GPLCache::Key& Key, const VkStencilOpState& StencilOp)
+{
+    Key.Add(StencilOp.failOp,
+            StencilOp.passOp,
+            StencilOp.depthFailOp,
+            StencilOp.compareOp,
+            StencilOp.compareMask,
+            StencilOp.writeMask,
+            StencilOp.reference);
+}
+
+GPLCache::Key GetVertexInputLibraryKey(const VkGraphicsPipelineCreateInfo& PipelineCI)
+{
+    GPLCache::Key Key{GPLCache::LIBRARY_TYPE_VERTEX_INPUT};
+
+    const auto& VertexInputCI = *PipelineCI.pVertexInputState;
+    Key.Add(VertexInputCI.vertexBindingDescriptionCount);
+    for (uint32_t i = 0; i < VertexInputCI.vertexBindingDescriptionCount; ++i)
+    {
+        const auto& Binding = VertexInputCI.pVertexBindingDescriptions[i];
+        Key.Add(Binding.binding, Binding.stride, Binding.inputRate);
+    }
+    Key.Add(VertexInputCI.vertexAttributeDescriptionCount);
+    for (uint32_t i = 0; i < VertexInputCI.vertexAttributeDescriptionCount; ++i)
+    {
+        const auto& Attrib = VertexInputCI.pVertexAttributeDescriptions[i];
+        Key.Add(Attrib.location, Attrib.binding, Attrib.format, Attrib.offset);
+    }
+    if (VertexInputCI.pNext != nullptr)
+    {
+        const auto& DivisorCI = *static_cast<const VkPipelineVertexInputDivisorStateCreateInfoEXT*>(VertexInputCI.pNext);
+        VERIFY_EXPR(DivisorCI.sType == VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_DIVISOR_STATE_CREATE_INFO_EXT);
+        Key.Add(DivisorCI.vertexBindingDivisorCount);
+        for (uint32_t i = 0; i < DivisorCI.vertexBindingDivisorCount; ++i)
+            Key.Add(DivisorCI.pVertexBindingDivisors[i].binding, DivisorCI.pVertexBindingDivisors[i].divisor);
+    }
+
+    Key.Add(PipelineCI.pInputAssemblyState->topology, PipelineCI.pInputAssemblyState->primitiveRestartEnable);
+    AddDynamicStatesToKey(Key, *PipelineCI.pDynamicState);
+
+    return Key;
+}
+
+void AddRenderPassToKey(GPLCache::Key& Key, const VkGraphicsPipelineCreateInfo& PipelineCI)
+{
+    Key.Add(PipelineCI.renderPass, PipelineCI.subpass);
+    if (PipelineCI.renderPass == VK_NULL_HANDLE && PipelineCI.pNext != nullptr)
+    {
+        // Pipelines for dynamic rendering are only compatible if their attachment formats match
+        const auto& RenderingCI = *static_cast<const VkPipelineRenderingCreateInfoKHR*>(PipelineCI.pNext);
+        VERIFY_EXPR(RenderingCI.sType == VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR);
+        Key.Add(RenderingCI.colorAttachmentCount);
+        for (uint32_t i = 0; i < RenderingCI.colorAttachmentCount; ++i)
+            Key.Add(RenderingCI.pColorAttachmentFormats[i]);
+        Key.Add(RenderingCI.depthAttachmentFormat, RenderingCI.stencilAttachmentFormat);
+    }
+}
+
+GPLCache::Key GetPreRasterizationLibraryKey(const VkGraphicsPipelineCreateInfo&                 PipelineCI,
+                                            const PipelineStateVkImpl::TShaderStages&           ShaderStages,
+                                            const std::vector<VkPipelineShaderStageCreateInfo>& Stages,
+                                            const PipelineLayoutVk&                             Layout)
+{
+    GPLCache::Key Key{GPLCache::LIBRARY_TYPE_PRE_RASTERIZATION};
+
+    AddShaderStagesToKey(Key, Stages, ShaderStages, false /*FragmentStage*/);
+
+    Key.Add(PipelineCI.pTessellationState->patchControlPoints);
+
+    const auto& ViewportCI = *PipelineCI.pViewportState;
+    Key.Add(ViewportCI.viewportCount, ViewportCI.scissorCount, ViewportCI.pScissors != nullptr);
+    if (ViewportCI.pScissors != nullptr)
+        Key.Add(ViewportCI.pScissors->extent.width, ViewportCI.pScissors->extent.height);
+
+    const auto& RasterizerCI = *PipelineCI.pRasterizationState;
+    Key.Add(RasterizerCI.depthClampEnable,
+            RasterizerCI.rasterizerDiscardEnable,
+            RasterizerCI.polygonMode,
+            RasterizerCI.cullMode,
+            RasterizerCI.frontFace,
+            RasterizerCI.depthBiasEnable,
+            RasterizerCI.depthBiasConstantFactor,
+            RasterizerCI.depthBiasClamp,
+            RasterizerCI.depthBiasSlopeFactor,
+            RasterizerCI.lineWidth);
+
+    AddDynamicStatesToKey(Key, *PipelineCI.pDynamicState);
+    AddLayoutToKey(Key, Layout);
+    AddRenderPassToKey(Key, PipelineCI);
+
+    return Key;
+}
+
+GPLCache::Key GetFragmentShaderLibraryKey(const VkGraphicsPipelineCreateInfo&                 PipelineCI,
+                                          const PipelineStateVkImpl::TShaderStages&           ShaderStages,
+                                          const std::vector<VkPipelineShaderStageCreateInfo>& Stages,
+                                          const PipelineLayoutVk&                             Layout)
+{
+    GPLCache::Key Key{GPLCache::LIBRARY_TYPE_FRAGMENT_SHADER};
+
+    AddShaderStagesToKey(Key, Stages, ShaderStages, true /*FragmentStage*/);
+
+    const auto& DepthStencilCI = *PipelineCI.pDepthStencilState;
+    Key.Add(DepthStencilCI.depthTestEnable,
+            DepthStencilCI.depthWriteEnable,
+            DepthStencilCI.depthCompareOp,
+            DepthStencilCI.depthBoundsTestEnable,
+            DepthStencilCI.stencilTestEnable,
+            DepthStencilCI.minDepthBounds,
+            DepthStencilCI.maxDepthBounds);
+    AddStencilOpStateToKey(Key, DepthStencilCI.front);
+    AddStencilOpStateToKey(Key, DepthStencilCI.back);
+
+    AddMultisampleStateToKey(Key, *PipelineCI.pMultisampleState);
+    AddDynamicStatesToKey(Key, *PipelineCI.pDynamicState);
+    AddLayoutToKey(Key, Layout);
+    AddRenderPassToKey(Key, PipelineCI);
+
+    return Key;
+}
+
+GPLCache::Key GetFragmentOutputLibraryKey(const VkGraphicsPipelineCreateInfo& PipelineCI)
+{
+    GPLCache::Key Key{GPLCache::LIBRARY_TYPE_FRAGMENT_OUTPUT};
+
+    const auto& BlendStateCI = *PipelineCI.pColorBlendState;
+    Key.Add(BlendStateCI.logicOpEnable, BlendStateCI.logicOp, BlendStateCI.attachmentCount);
+    for (uint32_t i = 0; i < BlendStateCI.attachmentCount; ++i)
+    {
+        const auto& Attachment = BlendStateCI.pAttachments[i];
+        Key.Add(Attachment.blendEnable,
+                Attachment.srcColorBlendFactor,
+                Attachment.dstColorBlendFactor,
+                Attachment.colorBlendOp,
+                Attachment.srcAlphaBlendFactor,
+                Attachment.dstAlphaBlendFactor,
+                Attachment.alphaBlendOp,
+                Attachment.colorWriteMask);
+    }
+    for (auto BlendConstant : BlendStateCI.blendConstants)
+        Key.Add(BlendConstant);
+
+    AddMultisampleStateToKey(Key, *PipelineCI.pMultisampleState);
+    AddDynamicStatesToKey(Key, *PipelineCI.pDynamicState);
+    AddRenderPassToKey(Key, PipelineCI);
+
+    return Key;
+}
+
+VulkanUtilities::PipelineWrapper CreatePipelineLibrary(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
+                                                       VkGraphicsPipelineCreateInfo                LibraryCI,
+                                                       VkGraphicsPipelineLibraryFlagsEXT           LibraryFlags,
+                                                       VkPipelineCache                             vkPSOCache,
+                                                       const char*                                 Name)
+{
+    VkGraphicsPipelineLibraryCreateInfoEXT GPLibraryCI{};
+    GPLibraryCI.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+    GPLibraryCI.pNext = LibraryCI.pNext; // VkPipelineRenderingCreateInfoKHR, if any
+    GPLibraryCI.flags = LibraryFlags;
+
+    LibraryCI.pNext = &GPLibraryCI;
+    // Retain the link-time optimization information so that the libraries can also be used to link an optimized pipeline
+    LibraryCI.flags |= VK_PIPELINE_CREATE_LIBRARY_BIT_KHR | VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
+    LibraryCI.basePipelineHandle = VK_NULL_HANDLE;
+    LibraryCI.basePipelineIndex  = -1;
+
+    return LogicalDevice.CreateGraphicsPipeline(LibraryCI, vkPSOCache, Name);
 }
 
+GPLCache::Library CreateShaderPipelineLibrary(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
+                                              VkGraphicsPipelineCreateInfo                LibraryCI,
+                                              VkGraphicsPipelineLibraryFlagsEXT           LibraryFlags,
+                                              const PipelineLayoutVk&                     Layout,
+                                              VkPipelineCache                             vkPSOCache,
+                                              const char*                                 Name)
+{
+    // The library may outlive the pipeline, so it needs its own layout, which
+    // is compatible with the layout of every pipeline that will be linked with it.
+    VkPipelineLayoutCreateInfo PipelineLayoutCI{};
+    PipelineLayoutCI.sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    PipelineLayoutCI.pNext          = nullptr;
+    PipelineLayoutCI.flags          = 0;
+    PipelineLayoutCI.setLayoutCount = Layout.GetDescrSetCount();
+    PipelineLayoutCI.pSetLayouts    = Layout.GetDescrSetCount() != 0 ? Layout.GetVkDescriptorSetLayouts() : nullptr;
+
+    GPLCache::Library Library;
+    Library.Layout   = LogicalDevice.CreatePipelineLayout(PipelineLayoutCI, Name);
+    LibraryCI.layout = Library.Layout;
+    Library.Pipeline = CreatePipelineLibrary(LogicalDevice, LibraryCI, LibraryFlags, vkPSOCache, Name);
+    return Library;
+}
+
+void CreateGraphicsPipelineLibraries(RenderDeviceVkImpl*                                 pDeviceVk,
+                                     const VkGraphicsPipelineCreateInfo&                 PipelineCI,
+                                     const std::vector<VkPipelineShaderStageCreateInfo>& Stages,
+                                     const PipelineStateVkImpl::TShaderStages&           ShaderStages,
+                                     const PipelineLayoutVk&                             Layout,
+                                     const PipelineStateDesc&                            PSODesc,
+                                     PipelineStateVkImpl::TGraphicsPipelineLibraries&    Libraries,
+                                     VkPipelineCache                                     vkPSOCache)
+{
+    const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
+    auto&       LibCache      = pDeviceVk->GetGraphicsPipelineLibraryCache();
+
+    VkGraphicsPipelineCreateInfo LibraryCI{};
+    LibraryCI.sType         = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    LibraryCI.flags         = PipelineCI.flags;
+    LibraryCI.pDynamicState = PipelineCI.pDynamicState;
+
+    Libraries[GPLCache::LIBRARY_TYPE_VERTEX_INPUT] = LibCache.GetLibrary(
+        GetVertexInputLibraryKey(PipelineCI),
+        [&]() {
+            VkGraphicsPipelineCreateInfo VertexInputCI = LibraryCI;
+            VertexInputCI.pVertexInputState            = PipelineCI.pVertexInputState;
+            VertexInputCI.pInputAssemblyState          = PipelineCI.pInputAssemblyState;
+
+            GPLCache::Library Library;
+            Library.Pipeline = CreatePipelineLibrary(LogicalDevice, VertexInputCI, VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT, vkPSOCache, PSODesc.Name);
+            return Library;
+        });
+
+    std::vector<VkPipelineShaderStageCreateInfo> PreRasterStages;
+    std::vector<VkPipelineShaderStageCreateInfo> FragmentStages;
+    for (const auto& StageCI : Stages)
+        (StageCI.stage == VK_SHADER_STAGE_FRAGMENT_BIT ? FragmentStages : PreRasterStages).push_back(StageCI);
+
+    Libraries[GPLCache::LIBRARY_TYPE_PRE_RASTERIZATION] = LibCache.GetLibrary(
+        GetPreRasterizationLibraryKey(PipelineCI, ShaderStages, Stages, Layout),
+        [&]() {
+            VkGraphicsPipelineCreateInfo PreRasterCI = LibraryCI;
+            PreRasterCI.stageCount                   = static_cast<uint32_t>(PreRasterStages.size());
+            PreRasterCI.pStages                      = PreRasterStages.data();
+            PreRasterCI.pTessellationState           = PipelineCI.pTessellationState;
+            PreRasterCI.pViewportState               = PipelineCI.pViewportState;
+            PreRasterCI.pRasterizationState          = PipelineCI.pRasterizationState;
+            PreRasterCI.pNext                        = PipelineCI.pNext;
+            PreRasterCI.renderPass                   = PipelineCI.renderPass;
+            PreRasterCI.subpass                      = PipelineCI.subpass;
+            return CreateShaderPipelineLibrary(LogicalDevice, PreRasterCI, VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT, Layout, vkPSOCache, PSODesc.Name);
+        });
+
+    Libraries[GPLCache::LIBRARY_TYPE_FRAGMENT_SHADER] = LibCache.GetLibrary(
+        GetFragmentShaderLibraryKey(PipelineCI, ShaderStages, Stages, Layout),
+        [&]() {
+            VkGraphicsPipelineCreateInfo FragmentCI = LibraryCI;
+            FragmentCI.stageCount                   = static_cast<uint32_t>(FragmentStages.size());
+            FragmentCI.pStages                      = !FragmentStages.empty() ? FragmentStages.data() : nullptr;
+            FragmentCI.pDepthStencilState           = PipelineCI.pDepthStencilState;
+            FragmentCI.pMultisampleState            = PipelineCI.pMultisampleState;
+            FragmentCI.pNext                        = PipelineCI.pNext;
+            FragmentCI.renderPass                   = PipelineCI.renderPass;
+            FragmentCI.subpass                      = PipelineCI.subpass;
+            return CreateShaderPipelineLibrary(LogicalDevice, FragmentCI, VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT, Layout, vkPSOCache, PSODesc.Name);
+        });
+
+    Libraries[GPLCache::LIBRARY_TYPE_FRAGMENT_OUTPUT] = LibCache.GetLibrary(
+        GetFragmentOutputLibraryKey(PipelineCI),
+        [&]() {
+            VkGraphicsPipelineCreateInfo FragmentOutputCI = LibraryCI;
+            FragmentOutputCI.pColorBlendState             = PipelineCI.pColorBlendState;
+            FragmentOutputCI.pMultisampleState            = PipelineCI.pMultisampleState;
+            FragmentOutputCI.pNext                        = PipelineCI.pNext;
+            FragmentOutputCI.renderPass                   = PipelineCI.renderPass;
+            FragmentOutputCI.subpass                      = PipelineCI.subpass;
+
+            GPLCache::Library Library;
+            Library.Pipeline = CreatePipelineLibrary(LogicalDevice, FragmentOutputCI, VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT, vkPSOCache, PSODesc.Name);
+            return Library;
+        });
+}
+
+VulkanUtilities::PipelineWrapper LinkGraphicsPipelineLibraries(const VulkanUtilities::VulkanLogicalDevice&            LogicalDevice,
+                                                               const PipelineStateVkImpl::TGraphicsPipelineLibraries& Libraries,
+                                                               const PipelineLayoutVk&                                Layout,
+                                                               bool                                                   Optimize,
+                                                               VkPipelineCache                                        vkPSOCache,
+                                                               const char*                                            Name)
+{
+    std::array<VkPipeline, GPLCache::LIBRARY_TYPE_COUNT> vkLibraries{};
+    for (size_t i = 0; i < Libraries.size(); ++i)
+    {
+        VERIFY_EXPR(Libraries[i]);
+        vkLibraries[i] = Libraries[i]->Pipeline;
+    }
+
+    VkPipelineLibraryCreateInfoKHR LibraryCI{};
+    LibraryCI.sType        = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+    LibraryCI.pNext        = nullptr;
+    LibraryCI.libraryCount = static_cast<uint32_t>(vkLibraries.size());
+    LibraryCI.pLibraries   = vkLibraries.data();
+
+    VkGraphicsPipelineCreateInfo PipelineCI{};
+    PipelineCI.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    PipelineCI.pNext = &LibraryCI;
+    // Without the link-time optimization flag, the libraries are linked as is, which is fast
+    PipelineCI.flags              = Optimize ? VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT : 0;
+    PipelineCI.layout             = Layout.GetVkPipelineLayout();
+    PipelineCI.basePipelineHandle = VK_NULL_HANDLE;
+    PipelineCI.basePipelineIndex  = -1;
+
+    return LogicalDevice.CreateGraphicsPipeline(PipelineCI, vkPSOCache, Name);
+}
 
-void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDeviceVk,
-                            std::vector<VkPipelineShaderStageCreateInfo>& Stages,
-                            const PipelineLayoutVk&                       Layout,
-                            const PipelineStateDesc&                      PSODesc,
-                            const GraphicsPipelineDesc&                   GraphicsPipeline,
-                            VulkanUtilities::PipelineWrapper&             Pipeline,
-                            RefCntAutoPtr<IRenderPass>&                   pRenderPass,
-                            VkPipelineCache                               vkPSOCache)
+// Returns false if FailIfCompileRequired is true and the pipeline can't be created without compilation.
+bool CreateGraphicsPipeline(RenderDeviceVkImpl*                              pDeviceVk,
+                            std::vector<VkPipelineShaderStageCreateInfo>&    Stages,
+                            const PipelineStateVkImpl::TShaderStages&        ShaderStages,
+                            const PipelineLayoutVk&                          Layout,
+                            const PipelineStateDesc&                         PSODesc,
+                            const GraphicsPipelineDesc&                      GraphicsPipeline,
+                            VulkanUtilities::PipelineWrapper&                Pipeline,
+                            PipelineStateVkImpl::TGraphicsPipelineLibraries& Libraries,
+                            RefCntAutoPtr<IRenderPass>&                      pRenderPass,
+                            VkPipelineCache                                  vkPSOCache,
+                            bool                                             FailIfCompileRequired)
 {
     const auto& LogicalDevice  = pDeviceVk->GetLogicalDevice();
     const auto& PhysicalDevice = pDeviceVk->GetPhysicalDevice();
     auto&       RPCache        = pDeviceVk->GetImplicitRenderPassCache();
 
+    const bool UseLibraries = PSODesc.PipelineType == PIPELINE_TYPE_GRAPHICS && pDeviceVk->GetGraphicsPipelineLibraryCache().IsSupported();
+    if (FailIfCompileRequired)
+    {
+        // Without the pipeline creation cache control, the cache can't be probed.
+        // Pipeline libraries are compiled and linked in one go, so the pipeline is always compiled asynchronously.
+        if (UseLibraries || LogicalDevice.GetEnabledExtFeatures().PipelineCreationCacheControl.pipelineCreationCacheControl == VK_FALSE)
+            return false;
+    }
+
     if (pRenderPass == nullptr)
     {
         RenderPassCache::RenderPassCacheKey Key{
@@ -318,6 +706,30 @@ void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDevic
         DynamicStates.push_back(VK_DYNAMIC_STATE_FRAGMENT_SHADING_RATE_KHR);
     }
 
+    // Extended dynamic states are set by DeviceContextVkImpl::SetPipelineState() from the pipeline
+    // description and may then be changed by SetCullMode(), SetDepthStencilState() and SetPrimitiveTopology().
+    if ((GraphicsPipeline.DynamicStateFlags & PIPELINE_DYNAMIC_STATE_FLAG_CULL_MODE) != 0)
+    {
+        DynamicStates.push_back(VK_DYNAMIC_STATE_CULL_MODE_EXT);
+    }
+    if ((GraphicsPipeline.DynamicStateFlags & PIPELINE_DYNAMIC_STATE_FLAG_DEPTH) != 0)
+    {
+        DynamicStates.push_back(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT);
+        DynamicStates.push_back(VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT);
+        DynamicStates.push_back(VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT);
+    }
+    if ((GraphicsPipeline.DynamicStateFlags & PIPELINE_DYNAMIC_STATE_FLAG_STENCIL) != 0)
+    {
+        DynamicStates.push_back(VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE_EXT);
+        DynamicStates.push_back(VK_DYNAMIC_STATE_STENCIL_OP_EXT);
+        DynamicStates.push_back(VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK);
+        DynamicStates.push_back(VK_DYNAMIC_STATE_STENCIL_WRITE_MASK);
+    }
+    if ((GraphicsPipeline.DynamicStateFlags & PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY) != 0)
+    {
+        DynamicStates.push_back(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT);
+    }
+
     DynamicStateCI.dynamicStateCount = static_cast<uint32_t>(DynamicStates.size());
     DynamicStateCI.pDynamicStates    = DynamicStates.data();
     PipelineCI.pDynamicState         = &DynamicStateCI;
@@ -328,7 +740,44 @@ void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDevic
     PipelineCI.basePipelineHandle = VK_NULL_HANDLE; // a pipeline to derive from
     PipelineCI.basePipelineIndex  = -1;             // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
+    std::array<VkFormat, MAX_RENDER_TARGETS> ColorAttachmentFormats{};
+    VkPipelineRenderingCreateInfoKHR         RenderingCI{};
+    if (pDeviceVk->UseDynamicRendering(GraphicsPipeline))
+    {
+        // The pipeline is used with dynamic rendering, so only the attachment formats are required.
+        // The implicit render pass is still created as it is exposed through IPipelineState::GetRenderPass().
+        for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
+            ColorAttachmentFormats[rt] = TexFormatToVkFormat(GraphicsPipeline.RTVFormats[rt]);
+
+        RenderingCI.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+        RenderingCI.pNext                   = nullptr;
+        RenderingCI.viewMask                = 0;
+        RenderingCI.colorAttachmentCount    = GraphicsPipeline.NumRenderTargets;
+        RenderingCI.pColorAttachmentFormats = ColorAttachmentFormats.data();
+        RenderingCI.depthAttachmentFormat   = TexFormatToVkFormat(GraphicsPipeline.DSVFormat);
+        RenderingCI.stencilAttachmentFormat =
+            GetTextureFormatAttribs(GraphicsPipeline.DSVFormat).ComponentType == COMPONENT_TYPE_DEPTH_STENCIL ?
+            RenderingCI.depthAttachmentFormat :
+            VK_FORMAT_UNDEFINED;
+
+        PipelineCI.pNext      = &RenderingCI;
+        PipelineCI.renderPass = VK_NULL_HANDLE;
+        PipelineCI.subpass    = 0;
+    }
+
+    if (UseLibraries)
+    {
+        // Compile the pipeline parts as libraries that can be shared with other pipelines and quickly link them.
+        CreateGraphicsPipelineLibraries(pDeviceVk, PipelineCI, Stages, ShaderStages, Layout, PSODesc, Libraries, vkPSOCache);
+        Pipeline = LinkGraphicsPipelineLibraries(LogicalDevice, Libraries, Layout, false /*Optimize*/, vkPSOCache, PSODesc.Name);
+        return true;
+    }
+
+    if (FailIfCompileRequired)
+        PipelineCI.flags |= VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT_EXT;
+
     Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, vkPSOCache, PSODesc.Name);
+    return Pipeline != VK_NULL_HANDLE;
 }
 
 
@@ -824,13 +1273,36 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
 {
     try
     {
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
+        InitializePipeline(
+            CreateInfo,
+            [this](const GraphicsPipelineStateCreateInfo& CI, bool CacheOnly) -> CompilePipelineFuncType //
+            {
+                // The shader modules are shared with the compilation function that may run in another thread
+                auto pStages = std::make_shared<InternalShaderStages>();
+
+                pStages->ShaderStages = InitInternalObjects(CI, pStages->vkShaderStages, pStages->ShaderModules);
 
-        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
+                RefCntAutoPtr<IPipelineStateCache> pPSOCache{CI.pPSOCache};
 
-        const auto vkSPOCache = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
-        CreateGraphicsPipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, GetGraphicsPipelineDesc(), m_Pipeline, GetRenderPassPtr(), vkSPOCache);
+                auto CreatePipeline = [this, pStages, pPSOCache](bool FailIfCompileRequired) {
+                    // Vulkan pipeline caches are per-thread
+                    const auto vkSPOCache = pPSOCache ? pPSOCache.RawPtr<PipelineStateCacheVkImpl>()->GetThreadVkPipelineCache() : VK_NULL_HANDLE;
+                    if (!CreateGraphicsPipeline(GetDevice(), pStages->vkShaderStages, pStages->ShaderStages, m_PipelineLayout, m_Desc, GetGraphicsPipelineDesc(),
+                                                m_Pipeline, m_Libraries, GetRenderPassPtr(), vkSPOCache, FailIfCompileRequired))
+                        return false;
+
+                    if (m_Libraries[GraphicsPipelineLibraryCache::LIBRARY_TYPE_VERTEX_INPUT])
+                        EnqueueOptimizedLink(pPSOCache.RawPtr<IPipelineStateCache>());
+                    return true;
+                };
+
+                if (CreatePipeline(CacheOnly))
+                    return {};
+
+                return [CreatePipeline]() {
+                    CreatePipeline(false);
+                };
+            });
     }
     catch (...)
     {
@@ -844,13 +1316,30 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
 {
     try
     {
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
+        InitializePipeline(
+            CreateInfo,
+            [this](const ComputePipelineStateCreateInfo& CI, bool CacheOnly) -> CompilePipelineFuncType //
+            {
+                // The shader modules are shared with the compilation function that may run in another thread
+                auto pStages = std::make_shared<InternalShaderStages>();
+
+                pStages->ShaderStages = InitInternalObjects(CI, pStages->vkShaderStages, pStages->ShaderModules);
 
-        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
+                RefCntAutoPtr<IPipelineStateCache> pPSOCache{CI.pPSOCache};
 
-        const auto vkSPOCache = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
-        CreateComputePipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, m_Pipeline, vkSPOCache);
+                auto CreatePipeline = [this, pStages, pPSOCache](bool FailIfCompileRequired) {
+                    // Vulkan pipeline caches are per-thread
+                    const auto vkSPOCache = pPSOCache ? pPSOCache.RawPtr<PipelineStateCacheVkImpl>()->GetThreadVkPipelineCache() : VK_NULL_HANDLE;
+                    return CreateComputePipeline(GetDevice(), pStages->vkShaderStages, m_PipelineLayout, m_Desc, m_Pipeline, vkSPOCache, FailIfCompileRequired);
+                };
+
+                if (CreatePipeline(CacheOnly))
+                    return {};
+
+                return [CreatePipeline]() {
+                    CreatePipeline(false);
+                };
+            });
     }
     catch (...)
     {
@@ -871,7 +1360,7 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
 
         const auto ShaderStages   = InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
         const auto vkShaderGroups = BuildRTShaderGroupDescription(CreateInfo, m_pRayTracingPipelineData->NameToGroupIndex, ShaderStages);
-        const auto vkSPOCache     = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
+        const auto vkSPOCache     = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetThreadVkPipelineCache() : VK_NULL_HANDLE;
 
         CreateRayTracingPipeline(pDeviceVk, vkShaderStages, vkShaderGroups, m_PipelineLayout, m_Desc, GetRayTracingPipelineDesc(), m_Pipeline, vkSPOCache);
 
@@ -894,9 +1383,50 @@ PipelineStateVkImpl::~PipelineStateVkImpl()
     Destruct();
 }
 
+void PipelineStateVkImpl::EnqueueOptimizedLink(IPipelineStateCache* pPSOCache)
+{
+    auto* pThreadPool = GetDevice()->GetShaderCompilationThreadPool();
+    if (pThreadPool == nullptr)
+        return;
+
+    // The fast-linked pipeline may be slower than the monolithic one, so link
+    // an optimized pipeline in the background and switch to it once it is ready.
+    m_pOptimizedLinkTask = EnqueueAsyncWork(
+        pThreadPool,
+        [this, pCache = RefCntAutoPtr<IPipelineStateCache>{pPSOCache}](Uint32 /*ThreadId*/) //
+        {
+            const auto vkSPOCache = pCache ? pCache.RawPtr<PipelineStateCacheVkImpl>()->GetThreadVkPipelineCache() : VK_NULL_HANDLE;
+            try
+            {
+                m_OptimizedPipeline = LinkGraphicsPipelineLibraries(GetDevice()->GetLogicalDevice(), m_Libraries, m_PipelineLayout, true /*Optimize*/, vkSPOCache, m_Desc.Name);
+                m_vkOptimizedPipeline.store(m_OptimizedPipeline, std::memory_order_release);
+            }
+            catch (...)
+            {
+                LOG_WARNING_MESSAGE("Failed to link optimized pipeline for PSO '", m_Desc.Name, "'. The fast-linked pipeline will be used.");
+            }
+        },
+        -1.f // Optimized pipelines have lower priority than the pipelines that are not yet ready
+    );
+}
+
 void PipelineStateVkImpl::Destruct()
 {
+    CancelOrWaitAsyncInitialization();
+
+    if (m_pOptimizedLinkTask)
+    {
+        if (!GetDevice()->GetShaderCompilationThreadPool()->RemoveTask(m_pOptimizedLinkTask, false /*CancelIfRunning*/))
+            m_pOptimizedLinkTask->WaitForCompletion();
+        m_pOptimizedLinkTask.Release();
+    }
+
+    m_vkOptimizedPipeline.store(VK_NULL_HANDLE);
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_OptimizedPipeline), m_Desc.ImmediateContextMask);
     m_pDevice->SafeReleaseDeviceObject(std::move(m_Pipeline), m_Desc.ImmediateContextMask);
+    // Libraries are released by the cache once the last pipeline that uses them is destroyed.
+    for (auto& pLibrary : m_Libraries)
+        pLibrary.reset();
     m_PipelineLayout.Release(m_pDevice, m_Desc.ImmediateContextMask);
 
     TPipelineStateBase::Destruct();
@@ -0,0 +1,146 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "QueryArrayVkImpl.hpp"
+
+#include "RenderDeviceVkImpl.hpp"
+#include "VulkanUtilities/VulkanCommandBuffer.hpp"
+
+namespace Diligent
+{
+
+QueryArrayVkImpl::QueryArrayVkImpl(IReferenceCounters*   pRefCounters,
+                                   RenderDeviceVkImpl*   pDevice,
+                                   const QueryArrayDesc& Desc) :
+    TQueryArrayBase{pRefCounters, pDevice, Desc}
+{
+    const auto& LogicalDevice   = pDevice->GetLogicalDevice();
+    const auto& EnabledFeatures = LogicalDevice.GetEnabledFeatures();
+
+    VkQueryPoolCreateInfo QueryPoolCI{};
+    QueryPoolCI.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    QueryPoolCI.pNext      = nullptr;
+    QueryPoolCI.flags      = 0;
+    QueryPoolCI.queryCount = m_Desc.Size;
+
+    static_assert(QUERY_TYPE_NUM_TYPES == 6, "Not all QUERY_TYPE enum values are handled below");
+    switch (m_Desc.Type)
+    {
+        case QUERY_TYPE_OCCLUSION:
+        case QUERY_TYPE_BINARY_OCCLUSION:
+            QueryPoolCI.queryType = VK_QUERY_TYPE_OCCLUSION;
+            break;
+
+        case QUERY_TYPE_TIMESTAMP:
+            QueryPoolCI.queryType = VK_QUERY_TYPE_TIMESTAMP;
+            break;
+
+        case QUERY_TYPE_PIPELINE_STATISTICS:
+        {
+            // Use the same counters as the query manager, see QueryManagerVk::QueryManagerVk()
+            QueryPoolCI.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+            QueryPoolCI.pipelineStatistics =
+                VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+                VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+                VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+                VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT |
+                VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+                VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+                VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+
+            if (EnabledFeatures.geometryShader != VK_FALSE)
+            {
+                QueryPoolCI.pipelineStatistics |=
+                    VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_INVOCATIONS_BIT |
+                    VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_PRIMITIVES_BIT;
+            }
+            if (EnabledFeatures.tessellationShader != VK_FALSE)
+            {
+                QueryPoolCI.pipelineStatistics |=
+                    VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_CONTROL_SHADER_PATCHES_BIT |
+                    VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_EVALUATION_SHADER_INVOCATIONS_BIT;
+            }
+
+            // Every enabled counter writes one value
+            m_NumValuesPerQuery = PlatformMisc::CountOneBits(QueryPoolCI.pipelineStatistics);
+        }
+        break;
+
+        default:
+            UNEXPECTED("Unexpected query type");
+    }
+
+    m_vkQueryPool = LogicalDevice.CreateQueryPool(QueryPoolCI, m_Desc.Name);
+    if (!m_vkQueryPool)
+        LOG_ERROR_AND_THROW("Failed to create Vulkan query pool for query array '", m_Desc.Name, '\'');
+
+    // Every query must be reset before it is used for the first time (17.2)
+    if (LogicalDevice.GetEnabledExtFeatures().HostQueryReset.hostQueryReset)
+    {
+        LogicalDevice.ResetQueryPool(m_vkQueryPool, 0, m_Desc.Size);
+    }
+    else
+    {
+        // vkCmdResetQueryPool requires a graphics or compute queue
+        const auto& QueueProperties = pDevice->GetPhysicalDevice().GetQueueProperties();
+
+        Uint32 QueueInd = 0;
+        while (QueueInd < pDevice->GetCommandQueueCount())
+        {
+            const auto QueueFamilyIndex = pDevice->GetQueueFamilyIndex(SoftwareQueueIndex{QueueInd});
+            if ((QueueProperties[QueueFamilyIndex].queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) != 0)
+                break;
+            ++QueueInd;
+        }
+        if (QueueInd == pDevice->GetCommandQueueCount())
+            LOG_ERROR_AND_THROW("Failed to find a graphics or compute queue to reset the query pool of query array '", m_Desc.Name, '\'');
+
+        const SoftwareQueueIndex CmdQueueInd{QueueInd};
+
+        VulkanUtilities::CommandPoolWrapper  CmdPool;
+        VulkanUtilities::VulkanCommandBuffer CmdBuffer;
+        pDevice->AllocateTransientCmdPool(CmdQueueInd, CmdPool, CmdBuffer, "Transient command pool to reset query array pool");
+        CmdBuffer.ResetQueryPool(m_vkQueryPool, 0, m_Desc.Size);
+        pDevice->ExecuteAndDisposeTransientCmdBuff(CmdQueueInd, CmdBuffer.GetVkCmdBuffer(), std::move(CmdPool));
+    }
+}
+
+QueryArrayVkImpl::~QueryArrayVkImpl()
+{
+    // The pool may still be used by the commands in flight in any queue
+    GetDevice()->SafeReleaseDeviceObject(std::move(m_vkQueryPool), ~Uint64{0});
+}
+
+Uint32 QueryArrayVkImpl::GetQueryDataStride() const
+{
+    // Query results are copied with VK_QUERY_RESULT_64_BIT flag
+    return m_NumValuesPerQuery * static_cast<Uint32>(sizeof(Uint64));
+}
+
+} // namespace Diligent
@@ -40,10 +40,20 @@ namespace Diligent
 
 void QueryManagerVk::QueryPoolInfo::Init(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
                                          const VkQueryPoolCreateInfo&                QueryPoolCI,
-                                         QUERY_TYPE                                  Type)
+                                         QUERY_TYPE                                  Type,
+                                         bool                                        Deferred)
 {
-    m_Type        = Type;
-    m_QueryCount  = QueryPoolCI.queryCount;
+    m_Type       = Type;
+    m_QueryCount = QueryPoolCI.queryCount;
+
+    if (Deferred)
+    {
+        VERIFY(LogicalDevice.GetEnabledExtFeatures().HostQueryReset.hostQueryReset, "Deferred query pools require host query reset");
+        m_pLogicalDevice = &LogicalDevice;
+        m_DeferredPoolCI = QueryPoolCI;
+        return;
+    }
+
     m_vkQueryPool = LogicalDevice.CreateQueryPool(QueryPoolCI, "QueryManagerVk: query pool");
 
     m_StaleQueries.resize(m_QueryCount);
@@ -51,8 +61,26 @@ void QueryManagerVk::QueryPoolInfo::Init(const VulkanUtilities::VulkanLogicalDev
         m_StaleQueries[i] = i;
 }
 
+void QueryManagerVk::QueryPoolInfo::CreateDeferredPool()
+{
+    VERIFY_EXPR(m_pLogicalDevice != nullptr && IsNull());
+
+    m_vkQueryPool = m_pLogicalDevice->CreateQueryPool(m_DeferredPoolCI, "QueryManagerVk: query pool");
+    // Every query must be reset before it is used for the first time (17.2)
+    m_pLogicalDevice->ResetQueryPool(m_vkQueryPool, 0, m_QueryCount);
+
+    m_AvailableQueries.resize(m_QueryCount);
+    for (Uint32 i = 0; i < m_QueryCount; ++i)
+        m_AvailableQueries[i] = m_QueryCount - 1 - i;
+
+    m_pLogicalDevice = nullptr;
+}
+
 QueryManagerVk::QueryPoolInfo::~QueryPoolInfo()
 {
+    if (IsNull())
+        return;
+
     auto OutstandingQueries = GetQueryCount() - (m_AvailableQueries.size() + m_StaleQueries.size());
     if (OutstandingQueries == 1)
     {
@@ -70,7 +98,10 @@ Uint32 QueryManagerVk::QueryPoolInfo::Allocate()
 {
     Uint32 Index = InvalidIndex;
 
-    std::lock_guard<std::mutex> Lock{m_QueriesMtx};
+    std::lock_guard<Threading::EngineMutex> Lock{m_QueriesMtx};
+    if (m_pLogicalDevice != nullptr)
+        CreateDeferredPool();
+
     if (!m_AvailableQueries.empty())
     {
         Index = m_AvailableQueries.back();
@@ -83,7 +114,7 @@ Uint32 QueryManagerVk::QueryPoolInfo::Allocate()
 
 void QueryManagerVk::QueryPoolInfo::Discard(Uint32 Index)
 {
-    std::lock_guard<std::mutex> Lock{m_QueriesMtx};
+    std::lock_guard<Threading::EngineMutex> Lock{m_QueriesMtx};
 
     VERIFY(Index < m_QueryCount, "Query index ", Index, " is out of range");
     VERIFY(m_vkQueryPool != VK_NULL_HANDLE, "Query pool is not initialized");
@@ -117,7 +148,7 @@ Uint32 QueryManagerVk::QueryPoolInfo::ResetStaleQueries(const VulkanUtilities::V
         }
     };
 
-    std::lock_guard<std::mutex> Lock{m_QueriesMtx};
+    std::lock_guard<Threading::EngineMutex> Lock{m_QueriesMtx};
     VERIFY(!IsNull(), "Query pool is not initialized");
 
     // After query pool creation, each query must be reset before it is used.
@@ -128,17 +159,27 @@ Uint32 QueryManagerVk::QueryPoolInfo::ResetStaleQueries(const VulkanUtilities::V
         ResetQueries(0, m_QueryCount);
         m_AvailableQueries.resize(m_QueryCount);
         for (Uint32 i = 0; i < m_QueryCount; ++i)
-            m_AvailableQueries[i] = i;
+            m_AvailableQueries[i] = m_QueryCount - 1 - i;
         NumCommands = 1;
     }
     else
     {
-        for (auto& StaleQuery : m_StaleQueries)
+        // Reset every contiguous range of stale queries with a single command
+        std::sort(m_StaleQueries.begin(), m_StaleQueries.end());
+        for (size_t RangeStart = 0; RangeStart < m_StaleQueries.size();)
         {
-            ResetQueries(StaleQuery, 1);
-            m_AvailableQueries.push_back(StaleQuery);
+            size_t RangeEnd = RangeStart + 1;
+            while (RangeEnd < m_StaleQueries.size() && m_StaleQueries[RangeEnd] == m_StaleQueries[RangeEnd - 1] + 1)
+                ++RangeEnd;
+
+            ResetQueries(m_StaleQueries[RangeStart], static_cast<uint32_t>(RangeEnd - RangeStart));
+            ++NumCommands;
+            RangeStart = RangeEnd;
         }
-        NumCommands = static_cast<Uint32>(m_StaleQueries.size());
+
+        // Queries are allocated from the back of the list, so add them in reverse
+        // order to make consecutive allocations get contiguous indices.
+        m_AvailableQueries.insert(m_AvailableQueries.end(), m_StaleQueries.rbegin(), m_StaleQueries.rend());
     }
     m_StaleQueries.clear();
 
@@ -163,6 +204,9 @@ QueryManagerVk::QueryManagerVk(RenderDeviceVkImpl* pRenderDeviceVk,
     const auto& DeviceInfo             = pRenderDeviceVk->GetDeviceInfo();
     const bool  IsTransferQueue        = (QueueFlags & (VK_QUEUE_COMPUTE_BIT | VK_QUEUE_GRAPHICS_BIT)) == 0;
     const bool  QueueSupportsTimestamp = PhysicalDevice.GetQueueProperties()[QueueFamilyIndex].timestampValidBits > 0;
+    // Most applications never use most query types. When queries can be reset on the host,
+    // pools are only created when the first query of the type is allocated.
+    const bool DeferPoolCreation = LogicalDevice.GetEnabledExtFeatures().HostQueryReset.hostQueryReset != VK_FALSE;
 
     for (Uint32 query_type = QUERY_TYPE_UNDEFINED + 1; query_type < QUERY_TYPE_NUM_TYPES; ++query_type)
     {
@@ -246,8 +290,8 @@ QueryManagerVk::QueryManagerVk(RenderDeviceVkImpl* pRenderDeviceVk,
             QueryPoolCI.queryCount *= 2;
 
         auto& PoolInfo = m_Pools[QueryType];
-        PoolInfo.Init(LogicalDevice, QueryPoolCI, QueryType);
-        VERIFY_EXPR(!PoolInfo.IsNull() && PoolInfo.GetQueryCount() == QueryPoolCI.queryCount && PoolInfo.GetType() == QueryType);
+        PoolInfo.Init(LogicalDevice, QueryPoolCI, QueryType, DeferPoolCreation);
+        VERIFY_EXPR((DeferPoolCreation || !PoolInfo.IsNull()) && PoolInfo.GetQueryCount() == QueryPoolCI.queryCount && PoolInfo.GetType() == QueryType);
     }
 }
 
@@ -38,6 +38,7 @@
 #include "DeviceContextVkImpl.hpp"
 #include "FenceVkImpl.hpp"
 #include "QueryVkImpl.hpp"
+#include "QueryArrayVkImpl.hpp"
 #include "RenderPassVkImpl.hpp"
 #include "FramebufferVkImpl.hpp"
 #include "BottomLevelASVkImpl.hpp"
@@ -125,6 +126,29 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         EngineCI.DynamicDescriptorPoolSize.MaxDescriptorSets,
         false // Pools can only be reset
     },
+    m_BindlessDescriptorSetAllocator
+    {
+        *this,
+        "Bindless descriptor pool",
+        std::vector<VkDescriptorPoolSize>
+        {
+            {VK_DESCRIPTOR_TYPE_SAMPLER,                    EngineCI.BindlessDescriptorPoolSize.NumSeparateSamplerDescriptors},
+            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,     EngineCI.BindlessDescriptorPoolSize.NumCombinedSamplerDescriptors},
+            {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,              EngineCI.BindlessDescriptorPoolSize.NumSampledImageDescriptors},
+            {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,              EngineCI.BindlessDescriptorPoolSize.NumStorageImageDescriptors},
+            {VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,       EngineCI.BindlessDescriptorPoolSize.NumUniformTexelBufferDescriptors},
+            {VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER,       EngineCI.BindlessDescriptorPoolSize.NumStorageTexelBufferDescriptors},
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,             EngineCI.BindlessDescriptorPoolSize.NumUniformBufferDescriptors},
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,             EngineCI.BindlessDescriptorPoolSize.NumStorageBufferDescriptors},
+            // Dynamic buffers are not allowed in update-after-bind descriptor sets
+            {VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT,           EngineCI.BindlessDescriptorPoolSize.NumInputAttachmentDescriptors},
+            {VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, EngineCI.BindlessDescriptorPoolSize.NumAccelStructDescriptors}
+        },
+        EngineCI.BindlessDescriptorPoolSize.MaxDescriptorSets,
+        true,
+        true // Update after bind
+    },
+    m_GraphicsPipelineLibraryCache{*this},
     m_MemoryMgr
     {
         "Global resource memory manager",
@@ -141,12 +165,19 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         GetRawAllocator(),
         *this,
         EngineCI.DynamicHeapSize,
-        ~Uint64{0}
+        ~Uint64{0},
+        // The pages of the ring are reclaimed using the fence of the only command queue
+        EngineCI.DynamicHeapPageRing && CommandQueueCount == 1 ? EngineCI.DynamicHeapPageSize : 0
     },
+    m_InitialDataBatchSize{EngineCI.InitialDataBatchSize},
+    m_InitialDataBatches  {m_InitialDataBatchSize != 0 ? std::make_unique<InitialDataBatch[]>(CommandQueueCount) : nullptr},
     m_pDxCompiler{CreateDXCompiler(DXCompilerTarget::Vulkan, m_PhysicalDevice->GetVkVersion(), EngineCI.pDxCompilerPath)}
 // clang-format on
 {
-    static_assert(sizeof(VulkanDescriptorPoolSize) == sizeof(Uint32) * 11, "Please add new descriptors to m_DescriptorSetAllocator and m_DynamicDescriptorPool constructors");
+    static_assert(sizeof(VulkanDescriptorPoolSize) == sizeof(Uint32) * 11, "Please add new descriptors to m_DescriptorSetAllocator, m_DynamicDescriptorPool and m_BindlessDescriptorSetAllocator constructors");
+
+    if (EngineCI.DynamicHeapPageRing && CommandQueueCount > 1)
+        LOG_WARNING_MESSAGE("Dynamic heap page ring is only supported with a single immediate context and will not be used");
 
     const auto vkVersion    = m_PhysicalDevice->GetVkVersion();
     m_DeviceInfo.Type       = RENDER_DEVICE_TYPE_VULKAN;
@@ -207,6 +238,7 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
 
     DEV_CHECK_ERR(m_DescriptorSetAllocator.GetAllocatedDescriptorSetCounter() == 0, "All allocated descriptor sets must have been released now.");
     DEV_CHECK_ERR(m_DynamicDescriptorPool.GetAllocatedPoolCounter() == 0, "All allocated dynamic descriptor pools must have been released now.");
+    DEV_CHECK_ERR(m_BindlessDescriptorSetAllocator.GetAllocatedDescriptorSetCounter() == 0, "All allocated bindless descriptor sets must have been released now.");
     DEV_CHECK_ERR(m_DynamicMemoryManager.GetMasterBlockCounter() == 0, "All allocated dynamic master blocks must have been returned to the pool.");
 
     // Immediately destroys all command pools
@@ -384,6 +416,131 @@ void RenderDeviceVkImpl::ExecuteAndDisposeTransientCmdBuff(SoftwareQueueIndex
     // clang-format on
 }
 
+void RenderDeviceVkImpl::RecordInitialDataCopy(SoftwareQueueIndex                                                CommandQueueId,
+                                               Uint64                                                            StagingDataSize,
+                                               const Char*                                                       DebugPoolName,
+                                               const std::function<void(VulkanUtilities::VulkanCommandBuffer&)>& RecordCommands)
+{
+    if (!m_InitialDataBatches)
+    {
+        VulkanUtilities::CommandPoolWrapper  CmdPool;
+        VulkanUtilities::VulkanCommandBuffer CmdBuffer;
+        AllocateTransientCmdPool(CommandQueueId, CmdPool, CmdBuffer, DebugPoolName);
+        RecordCommands(CmdBuffer);
+        ExecuteAndDisposeTransientCmdBuff(CommandQueueId, CmdBuffer.GetVkCmdBuffer(), std::move(CmdPool));
+        return;
+    }
+
+    VERIFY_EXPR(CommandQueueId < m_CmdQueueCount);
+    auto& Batch = m_InitialDataBatches[CommandQueueId];
+
+    bool FlushBatch = false;
+    {
+        std::lock_guard<std::mutex> Lock{Batch.Mtx};
+        if (Batch.CmdBuffer.GetVkCmdBuffer() == VK_NULL_HANDLE)
+            AllocateTransientCmdPool(CommandQueueId, Batch.CmdPool, Batch.CmdBuffer, "Transient command pool for batched initial data copies");
+
+        // Copy commands are recorded outside of a render pass, and every command
+        // initializes its own resource, so they do not need to be synchronized with each other.
+        RecordCommands(Batch.CmdBuffer);
+        Batch.StagingDataSize += StagingDataSize;
+        FlushBatch = Batch.StagingDataSize >= m_InitialDataBatchSize;
+    }
+
+    // Large batches are submitted right away to limit the amount of staging memory in flight
+    if (FlushBatch)
+        FlushInitialDataBatch(CommandQueueId);
+}
+
+void RenderDeviceVkImpl::FlushInitialDataBatch(SoftwareQueueIndex CommandQueueId)
+{
+    if (!m_InitialDataBatches)
+        return;
+
+    VERIFY_EXPR(CommandQueueId < m_CmdQueueCount);
+    auto& Batch = m_InitialDataBatches[CommandQueueId];
+
+    std::lock_guard<std::mutex> Lock{Batch.Mtx};
+    if (Batch.CmdBuffer.GetVkCmdBuffer() == VK_NULL_HANDLE)
+        return;
+
+    // The staging buffers of the batch have been released to the stale object list of the queue.
+    // The batch is submitted before the next command buffer that discards them, so they
+    // are only destroyed after the batch has been executed.
+    Batch.CmdBuffer.FlushBarriers();
+    ExecuteAndDisposeTransientCmdBuff(CommandQueueId, Batch.CmdBuffer.GetVkCmdBuffer(), std::move(Batch.CmdPool));
+    Batch.CmdBuffer.Reset();
+    Batch.StagingDataSize = 0;
+}
+
+namespace
+{
+
+// Copy of the submit info data that is executed by the submission thread
+// after the device context has reset its internal arrays.
+struct DeferredVkSubmission
+{
+    explicit DeferredVkSubmission(const VkSubmitInfo& SubmitInfo) :
+        // clang-format off
+        CmdBuffers      {SubmitInfo.pCommandBuffers,   SubmitInfo.pCommandBuffers   + SubmitInfo.commandBufferCount},
+        WaitSemaphores  {SubmitInfo.pWaitSemaphores,   SubmitInfo.pWaitSemaphores   + SubmitInfo.waitSemaphoreCount},
+        WaitStageMasks  {SubmitInfo.pWaitDstStageMask, SubmitInfo.pWaitDstStageMask + SubmitInfo.waitSemaphoreCount},
+        SignalSemaphores{SubmitInfo.pSignalSemaphores, SubmitInfo.pSignalSemaphores + SubmitInfo.signalSemaphoreCount}
+    // clang-format on
+    {
+        if (const auto* pTimelineInfo = static_cast<const VkTimelineSemaphoreSubmitInfo*>(SubmitInfo.pNext))
+        {
+            VERIFY_EXPR(pTimelineInfo->sType == VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO && pTimelineInfo->pNext == nullptr);
+            UseTimelineInfo = true;
+            WaitValues.assign(pTimelineInfo->pWaitSemaphoreValues, pTimelineInfo->pWaitSemaphoreValues + pTimelineInfo->waitSemaphoreValueCount);
+            SignalValues.assign(pTimelineInfo->pSignalSemaphoreValues, pTimelineInfo->pSignalSemaphoreValues + pTimelineInfo->signalSemaphoreValueCount);
+        }
+    }
+
+    static bool IsSupported(const VkSubmitInfo& SubmitInfo)
+    {
+        const auto* pNext = static_cast<const VkBaseInStructure*>(SubmitInfo.pNext);
+        return pNext == nullptr || (pNext->sType == VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO && pNext->pNext == nullptr);
+    }
+
+    Uint64 operator()(ICommandQueueVk* pQueue) const
+    {
+        VkSubmitInfo SubmitInfo{};
+        SubmitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        SubmitInfo.commandBufferCount   = static_cast<uint32_t>(CmdBuffers.size());
+        SubmitInfo.pCommandBuffers      = CmdBuffers.data();
+        SubmitInfo.waitSemaphoreCount   = static_cast<uint32_t>(WaitSemaphores.size());
+        SubmitInfo.pWaitSemaphores      = !WaitSemaphores.empty() ? WaitSemaphores.data() : nullptr;
+        SubmitInfo.pWaitDstStageMask    = !WaitStageMasks.empty() ? WaitStageMasks.data() : nullptr;
+        SubmitInfo.signalSemaphoreCount = static_cast<uint32_t>(SignalSemaphores.size());
+        SubmitInfo.pSignalSemaphores    = !SignalSemaphores.empty() ? SignalSemaphores.data() : nullptr;
+
+        VkTimelineSemaphoreSubmitInfo TimelineInfo{};
+        if (UseTimelineInfo)
+        {
+            SubmitInfo.pNext = &TimelineInfo;
+
+            TimelineInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            TimelineInfo.waitSemaphoreValueCount   = static_cast<uint32_t>(WaitValues.size());
+            TimelineInfo.pWaitSemaphoreValues      = !WaitValues.empty() ? WaitValues.data() : nullptr;
+            TimelineInfo.signalSemaphoreValueCount = static_cast<uint32_t>(SignalValues.size());
+            TimelineInfo.pSignalSemaphoreValues    = !SignalValues.empty() ? SignalValues.data() : nullptr;
+        }
+
+        return pQueue->Submit(SubmitInfo);
+    }
+
+    std::vector<VkCommandBuffer>      CmdBuffers;
+    std::vector<VkSemaphore>          WaitSemaphores;
+    std::vector<VkPipelineStageFlags> WaitStageMasks;
+    std::vector<VkSemaphore>          SignalSemaphores;
+    std::vector<Uint64>               WaitValues;
+    std::vector<Uint64>               SignalValues;
+    bool                              UseTimelineInfo = false;
+};
+
+} // namespace
+
 void RenderDeviceVkImpl::SubmitCommandBuffer(SoftwareQueueIndex                                          CommandQueueId,
                                              const VkSubmitInfo&                                         SubmitInfo,
                                              Uint64&                                                     SubmittedCmdBuffNumber, // Number of the submitted command buffer
@@ -391,6 +548,27 @@ void RenderDeviceVkImpl::SubmitCommandBuffer(SoftwareQueueIndex
                                              std::vector<std::pair<Uint64, RefCntAutoPtr<FenceVkImpl>>>* pSignalFences           // List of fences to signal
 )
 {
+    // Binary semaphore fences are signaled through the sync point of the submission,
+    // which is only known after the command buffer has been submitted.
+    bool SubmitAsync = IsAsyncSubmissionEnabled(CommandQueueId) && DeferredVkSubmission::IsSupported(SubmitInfo);
+    if (SubmitAsync && pSignalFences != nullptr)
+    {
+        for (const auto& val_fence : *pSignalFences)
+        {
+            if (!val_fence.second.RawPtr<FenceVkImpl>()->IsTimelineSemaphore())
+                SubmitAsync = false;
+        }
+    }
+
+    if (SubmitAsync)
+    {
+        // Hand off the command list to the submission thread
+        auto CmbBuffInfo       = TRenderDeviceBase::SubmitCommandBufferAsync(CommandQueueId, true, DeferredVkSubmission{SubmitInfo});
+        SubmittedFenceValue    = CmbBuffInfo.FenceValue;
+        SubmittedCmdBuffNumber = CmbBuffInfo.CmdBufferNumber;
+        return;
+    }
+
     // Submit the command list to the queue
     auto CmbBuffInfo       = TRenderDeviceBase::SubmitCommandBuffer(CommandQueueId, true, SubmitInfo);
     SubmittedFenceValue    = CmbBuffInfo.FenceValue;
@@ -412,6 +590,9 @@ void RenderDeviceVkImpl::SubmitCommandBuffer(SoftwareQueueIndex
 
 Uint64 RenderDeviceVkImpl::ExecuteCommandBuffer(SoftwareQueueIndex CommandQueueId, const VkSubmitInfo& SubmitInfo, std::vector<std::pair<Uint64, RefCntAutoPtr<FenceVkImpl>>>* pSignalFences)
 {
+    // The command buffer may use the resources initialized by the batched copies
+    FlushInitialDataBatch(CommandQueueId);
+
     Uint64 SubmittedFenceValue    = 0;
     Uint64 SubmittedCmdBuffNumber = 0;
     SubmitCommandBuffer(CommandQueueId, SubmitInfo, SubmittedCmdBuffNumber, SubmittedFenceValue, pSignalFences);
@@ -425,6 +606,9 @@ Uint64 RenderDeviceVkImpl::ExecuteCommandBuffer(SoftwareQueueIndex CommandQueueI
 
 void RenderDeviceVkImpl::IdleGPU()
 {
+    for (Uint32 q = 0; q < m_CmdQueueCount; ++q)
+        FlushInitialDataBatch(SoftwareQueueIndex{q});
+
     IdleAllCommandQueues(true);
     m_LogicalVkDevice->WaitIdle();
     ReleaseStaleResources();
@@ -432,6 +616,9 @@ void RenderDeviceVkImpl::IdleGPU()
 
 void RenderDeviceVkImpl::FlushStaleResources(SoftwareQueueIndex CmdQueueIndex)
 {
+    // Stale staging buffers must not be discarded before the batched copies that use them are submitted
+    FlushInitialDataBatch(CmdQueueIndex);
+
     // Submit empty command buffer to the queue. This will effectively signal the fence and
     // discard all resources
     VkSubmitInfo DummySubmitInfo{};
@@ -443,6 +630,7 @@ void RenderDeviceVkImpl::ReleaseStaleResources(bool ForceRelease)
 {
     m_MemoryMgr.ShrinkMemory();
     PurgeReleaseQueues(ForceRelease);
+    m_DynamicMemoryManager.ReleaseCompletedFrames(ForceRelease);
 }
 
 
@@ -636,6 +824,16 @@ void RenderDeviceVkImpl::CreateQuery(const QueryDesc& Desc, IQuery** ppQuery)
     CreateQueryImpl(ppQuery, Desc);
 }
 
+void RenderDeviceVkImpl::CreateQueryArray(const QueryArrayDesc& Desc, IQueryArray** ppQueryArray)
+{
+    CreateDeviceObject("Query array", Desc, ppQueryArray,
+                       [&]() //
+                       {
+                           auto* pQueryArrayVk{NEW_RC_OBJ(GetRawAllocator(), "QueryArrayVkImpl instance", QueryArrayVkImpl)(this, Desc)};
+                           pQueryArrayVk->QueryInterface(IID_QueryArray, reinterpret_cast<IObject**>(ppQueryArray));
+                       });
+}
+
 void RenderDeviceVkImpl::CreateRenderPass(const RenderPassDesc& Desc,
                                           IRenderPass**         ppRenderPass,
                                           bool                  IsDeviceInternal)
@@ -804,4 +1002,71 @@ SparseTextureFormatInfo RenderDeviceVkImpl::GetSparseTextureFormatInfo(TEXTURE_F
     return Info;
 }
 
+DeviceMemoryBudget RenderDeviceVkImpl::GetMemoryBudget() const
+{
+    DeviceMemoryBudget Budget;
+    if (!m_LogicalVkDevice->GetEnabledExtFeatures().MemoryBudget)
+        return Budget;
+
+    const auto  vkMemoryBudget = m_PhysicalDevice->GetMemoryBudget();
+    const auto& MemoryProps    = m_PhysicalDevice->GetMemoryProperties();
+    for (uint32_t heap = 0; heap < MemoryProps.memoryHeapCount; ++heap)
+    {
+        auto& Heap = (MemoryProps.memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0 ? Budget.Local : Budget.NonLocal;
+        Heap.Budget += vkMemoryBudget.heapBudget[heap];
+        Heap.Usage += vkMemoryBudget.heapUsage[heap];
+    }
+
+    return Budget;
+}
+
+ResourceMemoryRequirements RenderDeviceVkImpl::GetTextureMemoryRequirements(const TextureDesc& TexDesc) const
+{
+    // The requirements can only be queried from the image object
+    auto ImageCI          = TextureDescToVkImageCreateInfo(TexDesc, this);
+    ImageCI.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    ResourceMemoryRequirements Reqs;
+    try
+    {
+        const auto TmpImage = m_LogicalVkDevice->CreateImage(ImageCI, "Temporary image for memory requirements query");
+        const auto MemReqs  = m_LogicalVkDevice->GetImageMemoryRequirements(TmpImage);
+
+        Reqs.Size      = MemReqs.size;
+        Reqs.Alignment = MemReqs.alignment;
+    }
+    catch (...)
+    {
+        LOG_ERROR_MESSAGE("Failed to query memory requirements of texture '", (TexDesc.Name != nullptr ? TexDesc.Name : ""), "'");
+    }
+    return Reqs;
+}
+
+ResourceMemoryRequirements RenderDeviceVkImpl::GetBufferMemoryRequirements(const BufferDesc& BuffDesc) const
+{
+    // The requirements can only be queried from the buffer object
+    auto VkBuffCI = BufferDescToVkBufferCreateInfo(BuffDesc);
+    if ((BuffDesc.BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0 &&
+        m_LogicalVkDevice->GetEnabledExtFeatures().ConditionalRendering.conditionalRendering != VK_FALSE)
+    {
+        // Must match the usage of the buffer, see BufferVkImpl::BufferVkImpl()
+        VkBuffCI.usage |= VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT;
+    }
+
+    ResourceMemoryRequirements Reqs;
+    try
+    {
+        const auto TmpBuffer = m_LogicalVkDevice->CreateBuffer(VkBuffCI, "Temporary buffer for memory requirements query");
+        const auto MemReqs   = m_LogicalVkDevice->GetBufferMemoryRequirements(TmpBuffer);
+
+        Reqs.Size      = MemReqs.size;
+        Reqs.Alignment = MemReqs.alignment;
+    }
+    catch (...)
+    {
+        LOG_ERROR_MESSAGE("Failed to query memory requirements of buffer '", (BuffDesc.Name != nullptr ? BuffDesc.Name : ""), "'");
+    }
+    return Reqs;
+}
+
 } // namespace Diligent
@@ -66,6 +66,7 @@ static RenderPassDesc GetImplicitRenderPassDesc(
     const TEXTURE_FORMAT                                          RTVFormats[],
     TEXTURE_FORMAT                                                DSVFormat,
     Uint8                                                         SampleCount,
+    const RenderPassCache::AttachmentOps&                         Ops,
     TEXTURE_FORMAT                                                ShadingRateTexFormat,
     uint2                                                         ShadingRateTileSize,
     std::array<RenderPassAttachmentDesc, MAX_RENDER_TARGETS + 2>& Attachments,
@@ -86,14 +87,14 @@ static RenderPassDesc GetImplicitRenderPassDesc(
 
         DepthAttachment.Format      = DSVFormat;
         DepthAttachment.SampleCount = SampleCount;
-        DepthAttachment.LoadOp      = ATTACHMENT_LOAD_OP_LOAD; // previous contents of the image within the render area
-                                                               // will be preserved. For attachments with a depth/stencil format,
-                                                               // this uses the access type VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT.
-        DepthAttachment.StoreOp = ATTACHMENT_STORE_OP_STORE;   // the contents generated during the render pass and within the render
-                                                               // area are written to memory. For attachments with a depth/stencil format,
-                                                               // this uses the access type VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT.
-        DepthAttachment.StencilLoadOp  = ATTACHMENT_LOAD_OP_LOAD;
-        DepthAttachment.StencilStoreOp = ATTACHMENT_STORE_OP_STORE;
+        DepthAttachment.LoadOp      = Ops.DepthLoadOp;     // ATTACHMENT_LOAD_OP_LOAD by default: previous contents of the image within the
+                                                           // render area will be preserved. For attachments with a depth/stencil format,
+                                                           // this uses the access type VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT.
+        DepthAttachment.StoreOp = Ops.DepthStencilStoreOp; // ATTACHMENT_STORE_OP_STORE by default: the contents generated during the render pass
+                                                           // and within the render area are written to memory. For attachments with a depth/stencil
+                                                           // format, this uses the access type VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT.
+        DepthAttachment.StencilLoadOp  = Ops.StencilLoadOp;
+        DepthAttachment.StencilStoreOp = Ops.DepthStencilStoreOp;
         DepthAttachment.InitialState   = RESOURCE_STATE_DEPTH_WRITE;
         DepthAttachment.FinalState     = RESOURCE_STATE_DEPTH_WRITE;
 
@@ -119,12 +120,12 @@ static RenderPassDesc GetImplicitRenderPassDesc(
 
         ColorAttachment.Format      = RTVFormats[rt];
         ColorAttachment.SampleCount = SampleCount;
-        ColorAttachment.LoadOp      = ATTACHMENT_LOAD_OP_LOAD; // previous contents of the image within the render area
-                                                               // will be preserved. For attachments with a depth/stencil format,
-                                                               // this uses the access type VK_ACCESS_COLOR_ATTACHMENT_READ_BIT.
-        ColorAttachment.StoreOp = ATTACHMENT_STORE_OP_STORE;   // the contents generated during the render pass and within the render
-                                                               // area are written to memory. For attachments with a color format,
-                                                               // this uses the access type VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT.
+        ColorAttachment.LoadOp      = Ops.RTVLoadOps[rt];    // ATTACHMENT_LOAD_OP_LOAD by default: previous contents of the image within the
+                                                             // render area will be preserved. For attachments with a color format,
+                                                             // this uses the access type VK_ACCESS_COLOR_ATTACHMENT_READ_BIT.
+        ColorAttachment.StoreOp = ATTACHMENT_STORE_OP_STORE; // the contents generated during the render pass and within the render
+                                                             // area are written to memory. For attachments with a color format,
+                                                             // this uses the access type VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT.
         ColorAttachment.StencilLoadOp  = ATTACHMENT_LOAD_OP_DISCARD;
         ColorAttachment.StencilStoreOp = ATTACHMENT_STORE_OP_DISCARD;
         ColorAttachment.InitialState   = RESOURCE_STATE_RENDER_TARGET;
@@ -182,8 +183,8 @@ static RenderPassDesc GetImplicitRenderPassDesc(
 
 RenderPassVkImpl* RenderPassCache::GetRenderPass(const RenderPassCacheKey& Key)
 {
-    std::lock_guard<std::mutex> Lock{m_Mutex};
-    auto                        it = m_Cache.find(Key);
+    std::lock_guard<Threading::EngineMutex> Lock{m_Mutex};
+    auto                                    it = m_Cache.find(Key);
     if (it == m_Cache.end())
     {
         // Do not zero-initialize arrays
@@ -208,7 +209,7 @@ RenderPassVkImpl* RenderPassCache::GetRenderPass(const RenderPassCacheKey& Key)
         SubpassDesc           Subpass;
         ShadingRateAttachment ShadingRate;
 
-        auto RPDesc = GetImplicitRenderPassDesc(Key.NumRenderTargets, Key.RTVFormats, Key.DSVFormat, Key.SampleCount, SRFormat, SRTileSize,
+        auto RPDesc = GetImplicitRenderPassDesc(Key.NumRenderTargets, Key.RTVFormats, Key.DSVFormat, Key.SampleCount, Key.Ops, SRFormat, SRTileSize,
                                                 Attachments, AttachmentReferences, Subpass, ShadingRate);
 
         std::stringstream PassNameSS;
@@ -224,6 +225,10 @@ RenderPassVkImpl* RenderPassCache::GetRenderPass(const RenderPassCacheKey& Key)
         }
         if (Key.EnableVRS)
             PassNameSS << "; VRS";
+        if (Key.Ops.HasLoadOps(Key.NumRenderTargets))
+            PassNameSS << "; custom load ops";
+        if (Key.Ops.DepthStencilStoreOp != ATTACHMENT_STORE_OP_STORE)
+            PassNameSS << "; discard depth-stencil";
 
         const auto PassName{PassNameSS.str()};
         RPDesc.Name = PassName.c_str();
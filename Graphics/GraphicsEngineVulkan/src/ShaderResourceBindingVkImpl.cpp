@@ -43,4 +43,100 @@ ShaderResourceBindingVkImpl::~ShaderResourceBindingVkImpl()
 {
 }
 
+const ShaderVariableVkImpl* ShaderResourceBindingVkImpl::FindBindlessVariable(IShaderResourceVariable* pVariable) const
+{
+    if (pVariable == nullptr)
+    {
+        DEV_ERROR("Variable must not be null");
+        return nullptr;
+    }
+
+    // The variable may belong to any shader stage
+    for (Uint32 s = 0; s < GetNumShaders(); ++s)
+    {
+        const auto& VarMgr = m_pShaderVarMgrs[s];
+        for (Uint32 v = 0; v < VarMgr.GetVariableCount(); ++v)
+        {
+            const auto* pVar = VarMgr.GetVariable(v);
+            if (pVar != pVariable)
+                continue;
+
+            if ((pVar->GetDesc().Flags & PIPELINE_RESOURCE_FLAG_BINDLESS) == 0)
+            {
+                DEV_ERROR("Variable '", pVar->GetDesc().Name, "' is not bindless. Use PIPELINE_RESOURCE_FLAG_BINDLESS flag to define bindless resources.");
+                return nullptr;
+            }
+            return pVar;
+        }
+    }
+
+    DEV_ERROR("Variable does not belong to this shader resource binding");
+    return nullptr;
+}
+
+Uint32 ShaderResourceBindingVkImpl::AddBindlessResource(IShaderResourceVariable* pVariable,
+                                                        IDeviceObject*           pObject)
+{
+    DEV_CHECK_ERR(pObject != nullptr, "Bindless resource must not be null");
+
+    const auto* pVar = FindBindlessVariable(pVariable);
+    if (pVar == nullptr || pObject == nullptr)
+        return ~0u;
+
+    auto& Elements = m_BindlessArrays[pVar->GetResourceIndex()];
+
+    auto it = Elements.Indices.find(pObject);
+    if (it != Elements.Indices.end())
+        return it->second;
+
+    Uint32 Index = ~0u;
+    if (!Elements.FreeIndices.empty())
+    {
+        Index = Elements.FreeIndices.back();
+        Elements.FreeIndices.pop_back();
+    }
+    else if (Elements.NextIndex < pVar->GetDesc().ArraySize)
+    {
+        Index = Elements.NextIndex++;
+    }
+    else
+    {
+        LOG_ERROR_MESSAGE("Unable to add resource '", pObject->GetDesc().Name, "' to bindless array '", pVar->GetDesc().Name,
+                          "': all ", pVar->GetDesc().ArraySize, " elements of the array are in use.");
+        return ~0u;
+    }
+
+    pVar->BindResource(BindResourceInfo{Index, pObject, SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE});
+    Elements.Indices.emplace(pObject, Index);
+
+    return Index;
+}
+
+void ShaderResourceBindingVkImpl::RemoveBindlessResource(IShaderResourceVariable* pVariable,
+                                                         IDeviceObject*           pObject)
+{
+    const auto* pVar = FindBindlessVariable(pVariable);
+    if (pVar == nullptr)
+        return;
+
+    auto arr_it = m_BindlessArrays.find(pVar->GetResourceIndex());
+    if (arr_it == m_BindlessArrays.end())
+        return;
+
+    auto& Elements = arr_it->second;
+
+    auto it = Elements.Indices.find(pObject);
+    if (it == Elements.Indices.end())
+    {
+        DEV_ERROR("Resource is not in bindless array '", pVar->GetDesc().Name, "'");
+        return;
+    }
+
+    const auto Index = it->second;
+    Elements.Indices.erase(it);
+    // Reset the element so that the cache does not keep the object alive.
+    pVar->BindResource(BindResourceInfo{Index, nullptr, SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE});
+    Elements.FreeIndices.push_back(Index);
+}
+
 } // namespace Diligent
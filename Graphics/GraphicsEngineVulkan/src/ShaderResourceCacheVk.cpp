@@ -79,6 +79,7 @@ void ShaderResourceCacheVk::InitializeSets(IMemoryAllocator& MemAllocator, Uint3
 #ifdef DILIGENT_DEBUG
     m_DbgInitializedResources.resize(m_NumSets);
 #endif
+    m_FirstDynamicSlot.assign(size_t{m_NumSets} + 1, 0);
     if (MemorySize > 0)
     {
         m_pMemory = decltype(m_pMemory){
@@ -100,6 +101,13 @@ void ShaderResourceCacheVk::InitializeSets(IMemoryAllocator& MemAllocator, Uint3
     }
 }
 
+inline bool IsDynamicDescriptorType(DescriptorType DescrType)
+{
+    return (DescrType == DescriptorType::UniformBufferDynamic ||
+            DescrType == DescriptorType::StorageBufferDynamic ||
+            DescrType == DescriptorType::StorageBufferDynamic_ReadOnly);
+}
+
 void ShaderResourceCacheVk::InitializeResources(Uint32 Set, Uint32 Offset, Uint32 ArraySize, DescriptorType Type, bool HasImmutableSampler)
 {
     auto& DescrSet = GetDescriptorSet(Set);
@@ -110,13 +118,21 @@ void ShaderResourceCacheVk::InitializeResources(Uint32 Set, Uint32 Offset, Uint3
         m_DbgInitializedResources[Set][size_t{Offset} + res] = true;
 #endif
     }
-}
 
-inline bool IsDynamicDescriptorType(DescriptorType DescrType)
-{
-    return (DescrType == DescriptorType::UniformBufferDynamic ||
-            DescrType == DescriptorType::StorageBufferDynamic ||
-            DescrType == DescriptorType::StorageBufferDynamic_ReadOnly);
+    // Dynamic offsets are only used by SRB caches, where dynamic buffers go first in each set.
+    if (GetContentType() == ResourceCacheContentType::SRB && IsDynamicDescriptorType(Type))
+    {
+        const auto NumSetSlots = m_FirstDynamicSlot[Set + 1] - m_FirstDynamicSlot[Set];
+        if (Offset + ArraySize > NumSetSlots)
+        {
+            // No resources have been bound to the cache yet, so all slots are empty and may be shifted
+            const auto NumNewSlots = Offset + ArraySize - NumSetSlots;
+            for (Uint32 t = Set + 1; t <= m_NumSets; ++t)
+                m_FirstDynamicSlot[t] += NumNewSlots;
+            m_DynamicSlotBuffers.resize(m_FirstDynamicSlot[m_NumSets], nullptr);
+            m_DynamicSlotOffsets.resize(m_FirstDynamicSlot[m_NumSets], 0);
+        }
+    }
 }
 
 static bool IsDynamicBuffer(const ShaderResourceCacheVk::Resource& Res)
@@ -224,9 +240,6 @@ void ShaderResourceCacheVk::Resource::SetUniformBuffer(RefCntAutoPtr<IDeviceObje
     BufferRangeSize  = _RangeSize;
     if (BufferRangeSize == 0)
         BufferRangeSize = pBuffVk != nullptr ? (pBuffVk->GetDesc().Size - BufferBaseOffset) : 0;
-
-    // Reset dynamic offset
-    BufferDynamicOffset = 0;
 }
 
 void ShaderResourceCacheVk::Resource::SetStorageBuffer(RefCntAutoPtr<IDeviceObject>&& _pBufferView)
@@ -238,9 +251,8 @@ void ShaderResourceCacheVk::Resource::SetStorageBuffer(RefCntAutoPtr<IDeviceObje
 
     pObject = std::move(_pBufferView);
 
-    BufferDynamicOffset = 0; // It is essential to reset dynamic offset
-    BufferBaseOffset    = 0;
-    BufferRangeSize     = 0;
+    BufferBaseOffset = 0;
+    BufferRangeSize  = 0;
 
     if (!pObject)
         return;
@@ -328,10 +340,25 @@ const ShaderResourceCacheVk::Resource& ShaderResourceCacheVk::SetResource(
         ++m_NumDynamicBuffers;
     }
 
+    if (GetContentType() == ResourceCacheContentType::SRB && IsDynamicDescriptorType(DstRes.Type))
+    {
+        const auto Slot = GetDynamicBufferSlot(DescrSetIndex, CacheOffset);
+
+        const BufferVkImpl* pBufferVk = nullptr;
+        if (DstRes.pObject)
+        {
+            pBufferVk = DstRes.Type == DescriptorType::UniformBufferDynamic ?
+                DstRes.pObject.RawPtr<const BufferVkImpl>() :
+                DstRes.pObject.RawPtr<const BufferViewVkImpl>()->GetBuffer<const BufferVkImpl>();
+        }
+        m_DynamicSlotBuffers[Slot] = pBufferVk;
+        m_DynamicSlotOffsets[Slot] = 0; // It is essential to reset dynamic offset
+    }
+
+    // If the logical device is null, the caller writes the descriptor itself, e.g. with an update template
     auto vkSet = DescrSet.GetVkDescriptorSet();
-    if (vkSet != VK_NULL_HANDLE && DstRes.pObject)
+    if (vkSet != VK_NULL_HANDLE && DstRes.pObject && pLogicalDevice != nullptr)
     {
-        VERIFY(pLogicalDevice != nullptr, "Logical device must not be null to write descriptor to a non-null set");
 
         VkWriteDescriptorSet WriteDescrSet;
         WriteDescrSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -410,7 +437,14 @@ const ShaderResourceCacheVk::Resource& ShaderResourceCacheVk::SetResource(
         pLogicalDevice->UpdateDescriptorSets(1, &WriteDescrSet, 0, nullptr);
     }
 
-    UpdateRevision();
+    // Descriptors in update-after-bind bindings may be updated while the set is bound,
+    // so there is no need to commit the cache again.
+    if (!SrcRes.UpdateAfterBind)
+        UpdateRevision();
+    else
+        InvalidateResourceStates();
+
+    MarkSetDirty(DescrSetIndex);
 
     return DstRes;
 }
@@ -430,7 +464,9 @@ void ShaderResourceCacheVk::SetDynamicBufferOffset(Uint32 DescrSetIndex,
     DEV_CHECK_ERR(DstRes.BufferBaseOffset + DstRes.BufferRangeSize + DynamicBufferOffset <= pBufferVk->GetDesc().Size,
                   "Specified offset is out of buffer bounds");
 
-    DstRes.BufferDynamicOffset = DynamicBufferOffset;
+    // Dynamic offsets of static resources are not copied to SRBs, so they are only stored in SRB caches
+    if (GetContentType() == ResourceCacheContentType::SRB)
+        m_DynamicSlotOffsets[GetDynamicBufferSlot(DescrSetIndex, CacheOffset)] = DynamicBufferOffset;
 }
 
 
@@ -646,58 +682,97 @@ inline void TransitionAccelStruct(DeviceContextVkImpl* pCtxVkImpl,
 #endif
 }
 
-} // namespace
-
 template <bool VerifyOnly>
-void ShaderResourceCacheVk::TransitionResources(DeviceContextVkImpl* pCtxVkImpl)
+inline void TransitionResource(DeviceContextVkImpl* pCtxVkImpl, ShaderResourceCacheVk::Resource& Res)
 {
-    auto* pResources = GetFirstResourcePtr();
-    for (Uint32 res = 0; res < m_TotalResources; ++res)
+    static_assert(static_cast<Uint32>(DescriptorType::Count) == 16, "Please update the switch below to handle the new descriptor type");
+    switch (Res.Type)
     {
-        auto& Res = pResources[res];
+        case DescriptorType::UniformBuffer:
+        case DescriptorType::UniformBufferDynamic:
+            TransitionUniformBuffer<VerifyOnly>(pCtxVkImpl, Res.pObject.RawPtr<BufferVkImpl>(), Res.Type);
+            break;
 
-        static_assert(static_cast<Uint32>(DescriptorType::Count) == 16, "Please update the switch below to handle the new descriptor type");
-        switch (Res.Type)
-        {
-            case DescriptorType::UniformBuffer:
-            case DescriptorType::UniformBufferDynamic:
-                TransitionUniformBuffer<VerifyOnly>(pCtxVkImpl, Res.pObject.RawPtr<BufferVkImpl>(), Res.Type);
-                break;
+        case DescriptorType::StorageBuffer:
+        case DescriptorType::StorageBufferDynamic:
+        case DescriptorType::StorageBuffer_ReadOnly:
+        case DescriptorType::StorageBufferDynamic_ReadOnly:
+        case DescriptorType::UniformTexelBuffer:
+        case DescriptorType::StorageTexelBuffer:
+        case DescriptorType::StorageTexelBuffer_ReadOnly:
+            TransitionBufferView<VerifyOnly>(pCtxVkImpl, Res.pObject.RawPtr<BufferViewVkImpl>(), Res.Type);
+            break;
 
-            case DescriptorType::StorageBuffer:
-            case DescriptorType::StorageBufferDynamic:
-            case DescriptorType::StorageBuffer_ReadOnly:
-            case DescriptorType::StorageBufferDynamic_ReadOnly:
-            case DescriptorType::UniformTexelBuffer:
-            case DescriptorType::StorageTexelBuffer:
-            case DescriptorType::StorageTexelBuffer_ReadOnly:
-                TransitionBufferView<VerifyOnly>(pCtxVkImpl, Res.pObject.RawPtr<BufferViewVkImpl>(), Res.Type);
-                break;
+        case DescriptorType::CombinedImageSampler:
+        case DescriptorType::SeparateImage:
+        case DescriptorType::StorageImage:
+            TransitionTextureView<VerifyOnly>(pCtxVkImpl, Res.pObject.RawPtr<TextureViewVkImpl>(), Res.Type);
+            break;
 
-            case DescriptorType::CombinedImageSampler:
-            case DescriptorType::SeparateImage:
-            case DescriptorType::StorageImage:
-                TransitionTextureView<VerifyOnly>(pCtxVkImpl, Res.pObject.RawPtr<TextureViewVkImpl>(), Res.Type);
-                break;
+        case DescriptorType::Sampler:
+            // Nothing to do with samplers
+            break;
 
-            case DescriptorType::Sampler:
-                // Nothing to do with samplers
-                break;
+        case DescriptorType::InputAttachment:
+        case DescriptorType::InputAttachment_General:
+            // Nothing to do with input attachments - they are transitioned by the render pass.
+            // There is nothing we can validate here - a texture may be in different state at
+            // the beginning of the render pass before being transitioned to INPUT_ATTACHMENT state.
+            break;
 
-            case DescriptorType::InputAttachment:
-            case DescriptorType::InputAttachment_General:
-                // Nothing to do with input attachments - they are transitioned by the render pass.
-                // There is nothing we can validate here - a texture may be in different state at
-                // the beginning of the render pass before being transitioned to INPUT_ATTACHMENT state.
-                break;
+        case DescriptorType::AccelerationStructure:
+            TransitionAccelStruct<VerifyOnly>(pCtxVkImpl, Res.pObject.RawPtr<TopLevelASVkImpl>(), Res.Type);
+            break;
 
-            case DescriptorType::AccelerationStructure:
-                TransitionAccelStruct<VerifyOnly>(pCtxVkImpl, Res.pObject.RawPtr<TopLevelASVkImpl>(), Res.Type);
-                break;
+        default: UNEXPECTED("Unexpected resource type");
+    }
+}
 
-            default: UNEXPECTED("Unexpected resource type");
-        }
+// Returns true if the resource must be processed by every state transition,
+// even if its state has not changed.
+bool RequiresBarrierOnEveryUse(const ShaderResourceCacheVk::Resource& Res)
+{
+    if (!Res.pObject)
+        return false;
+
+    // UAV barriers must be executed every time for storage resources.
+    // Acceleration structures are processed every time to validate their content.
+    return DescriptorTypeToResourceState(Res.Type) == RESOURCE_STATE_UNORDERED_ACCESS ||
+        Res.Type == DescriptorType::AccelerationStructure;
+}
+
+} // namespace
+
+template <bool VerifyOnly>
+void ShaderResourceCacheVk::TransitionResources(DeviceContextVkImpl* pCtxVkImpl)
+{
+    auto* pResources = GetFirstResourcePtr();
+
+    if (!VerifyOnly && ResourceStatesUpToDate(pCtxVkImpl->GetResourceStateEpoch()))
+    {
+        // No resource has been bound to the cache and no resource has changed its state
+        // since the last full transition, so only the resources that require a barrier
+        // every time they are used need to be processed.
+        for (auto res : m_BarrierResources)
+            TransitionResource<VerifyOnly>(pCtxVkImpl, pResources[res]);
+        return;
+    }
+
+    if (!VerifyOnly)
+        m_BarrierResources.clear();
+
+    for (Uint32 res = 0; res < m_TotalResources; ++res)
+    {
+        auto& Res = pResources[res];
+        TransitionResource<VerifyOnly>(pCtxVkImpl, Res);
+
+        if (!VerifyOnly && RequiresBarrierOnEveryUse(Res))
+            m_BarrierResources.push_back(res);
     }
+
+    // Note that the epoch must be read after the transitions as they may change it.
+    if (!VerifyOnly)
+        SetResourceStatesUpToDate(pCtxVkImpl->GetResourceStateEpoch());
 }
 
 template void ShaderResourceCacheVk::TransitionResources<false>(DeviceContextVkImpl* pCtxVkImpl);
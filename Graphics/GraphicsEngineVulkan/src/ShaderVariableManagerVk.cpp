@@ -114,15 +114,13 @@ void ShaderVariableManagerVk::Destroy(IMemoryAllocator& Allocator)
     TBase::Destroy(Allocator);
 }
 
-ShaderVariableVkImpl* ShaderVariableManagerVk::GetVariable(const Char* Name) const
+ShaderVariableVkImpl* ShaderVariableManagerVk::GetVariable(SHADER_TYPE ShaderType, const Char* Name) const
 {
-    for (Uint32 v = 0; v < m_NumVariables; ++v)
-    {
-        auto& Var = m_pVariables[v];
-        if (strcmp(Var.GetDesc().Name, Name) == 0)
-            return &Var;
-    }
-    return nullptr;
+    const auto ResIndex = m_pSignature->FindResource(ShaderType, Name);
+    if (ResIndex == InvalidPipelineResourceIndex)
+        return nullptr;
+
+    return FindVariableByResIndex(m_pVariables, m_NumVariables, ResIndex);
 }
 
 
@@ -383,7 +381,7 @@ void BindResourceHelper::operator()(const BindResourceInfo& BindInfo) const
                       "If this is intended and you ensured proper synchronization, use the SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE flag. "
                       "Otherwise, use another shader resource binding instance or label the variable as dynamic.");
 
-        m_ResourceCache.ResetResource(m_Attribs.DescrSet, m_DstResCacheOffset);
+        m_ResourceCache.ResetResource(m_Attribs.DescrSet, m_DstResCacheOffset, (m_ResDesc.Flags & PIPELINE_RESOURCE_FLAG_BINDLESS) != 0);
     }
 }
 
@@ -413,7 +411,8 @@ bool BindResourceHelper::UpdateCachedResource(RefCntAutoPtr<ObjectType>&& pObjec
                                         m_ArrayIndex,
                                         std::move(pObject),
                                         BufferBaseOffset,
-                                        BufferRangeSize //
+                                        BufferRangeSize,
+                                        (m_ResDesc.Flags & PIPELINE_RESOURCE_FLAG_BINDLESS) != 0 //
                                     });
         return true;
     }
@@ -631,7 +630,21 @@ void ShaderVariableManagerVk::BindResource(Uint32 ResIndex, const BindResourceIn
         ResIndex,
         BindInfo.ArrayIndex};
 
-    BindHelper(BindInfo);
+    const auto& ResDesc = m_pSignature->GetResourceDesc(ResIndex);
+    if ((ResDesc.Flags & PIPELINE_RESOURCE_FLAG_BINDLESS) != 0)
+    {
+        // Elements of bindless arrays may be replaced at any time
+        BindHelper(BindResourceInfo{
+            BindInfo.ArrayIndex,
+            BindInfo.pObject,
+            BindInfo.Flags | SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE,
+            BindInfo.BufferBaseOffset,
+            BindInfo.BufferRangeSize});
+    }
+    else
+    {
+        BindHelper(BindInfo);
+    }
 }
 
 void ShaderVariableManagerVk::SetBufferDynamicOffset(Uint32 ResIndex,
@@ -27,6 +27,12 @@
 
 #include "pch.h"
 #include "SwapChainVkImpl.hpp"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
 #include "RenderDeviceVkImpl.hpp"
 #include "DeviceContextVkImpl.hpp"
 #include "TextureVkImpl.hpp"
@@ -37,6 +43,103 @@
 namespace Diligent
 {
 
+/// Thread that executes the present and the acquire of the next image, see SwapChainDesc::AsyncPresent.
+
+/// The swap chain posts at most one task at a time and waits for it before it accesses
+/// the Vulkan swap chain again.
+class SwapChainVkImpl::PresentThread
+{
+public:
+    using TaskType = std::function<VkResult()>;
+
+    PresentThread()
+    {
+        m_Thread = std::thread{[this]() {
+            ThreadFunc();
+        }};
+    }
+
+    ~PresentThread()
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            m_Stop = true;
+        }
+        m_CV.notify_all();
+        m_Thread.join();
+    }
+
+    // clang-format off
+    PresentThread           (const PresentThread&) = delete;
+    PresentThread& operator=(const PresentThread&) = delete;
+    PresentThread           (PresentThread&&)      = delete;
+    PresentThread& operator=(PresentThread&&)      = delete;
+    // clang-format on
+
+    void Post(TaskType&& Task)
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            VERIFY(!m_Pending, "The previous task must be waited for before posting a new one");
+            m_Task    = std::move(Task);
+            m_Pending = true;
+            m_Done    = false;
+        }
+        m_CV.notify_all();
+    }
+
+    /// Waits for the last posted task and returns its result.
+    /// Returns false if there is no task to wait for.
+    bool Wait(VkResult& Result)
+    {
+        std::unique_lock<std::mutex> Lock{m_Mtx};
+        if (!m_Pending)
+            return false;
+
+        m_CV.wait(Lock, [this]() { return m_Done; });
+        Result    = m_Result;
+        m_Pending = false;
+        return true;
+    }
+
+private:
+    void ThreadFunc()
+    {
+        while (true)
+        {
+            TaskType Task;
+            {
+                std::unique_lock<std::mutex> Lock{m_Mtx};
+                m_CV.wait(Lock, [this]() { return m_Task || m_Stop; });
+                if (!m_Task)
+                    break;
+                Task   = std::move(m_Task);
+                m_Task = nullptr;
+            }
+
+            const auto Result = Task();
+
+            {
+                std::lock_guard<std::mutex> Lock{m_Mtx};
+                m_Result = Result;
+                m_Done   = true;
+            }
+            m_CV.notify_all();
+        }
+    }
+
+    std::mutex              m_Mtx; // Protects the members below
+    std::condition_variable m_CV;
+
+    TaskType m_Task;
+    VkResult m_Result  = VK_SUCCESS;
+    bool     m_Pending = false;
+    bool     m_Done    = false;
+    bool     m_Stop    = false;
+
+    std::thread m_Thread;
+};
+
 SwapChainVkImpl::SwapChainVkImpl(IReferenceCounters*  pRefCounters,
                                  const SwapChainDesc& SCDesc,
                                  RenderDeviceVkImpl*  pRenderDeviceVk,
@@ -47,6 +150,7 @@ SwapChainVkImpl::SwapChainVkImpl(IReferenceCounters*  pRefCounters,
     m_Window                     {Window},
     m_VulkanInstance             {pRenderDeviceVk->GetVulkanInstance()},
     m_DesiredBufferCount         {SCDesc.BufferCount},
+    m_MaxFrameLatency            {SCDesc.BufferCount},
     m_pBackBufferRTV             (STD_ALLOCATOR_RAW_MEM(RefCntAutoPtr<ITextureView>, GetRawAllocator(), "Allocator for vector<RefCntAutoPtr<ITextureView>>")),
     m_SwapChainImagesInitialized (STD_ALLOCATOR_RAW_MEM(bool, GetRawAllocator(), "Allocator for vector<bool>")),
     m_ImageAcquiredFenceSubmitted(STD_ALLOCATOR_RAW_MEM(bool, GetRawAllocator(), "Allocator for vector<bool>"))
@@ -58,6 +162,9 @@ SwapChainVkImpl::SwapChainVkImpl(IReferenceCounters*  pRefCounters,
     auto res = AcquireNextImage(pDeviceContextVk);
     DEV_CHECK_ERR(res == VK_SUCCESS, "Failed to acquire next image for the newly created swap chain");
     (void)res;
+
+    if (m_SwapChainDesc.AsyncPresent)
+        m_pPresentThread.reset(new PresentThread{});
 }
 
 void SwapChainVkImpl::CreateSurface()
@@ -535,6 +642,8 @@ SwapChainVkImpl::~SwapChainVkImpl()
         ReleaseSwapChainResources(pImmediateCtxVk, /*DestroyVkSwapChain=*/true);
         VERIFY_EXPR(m_VkSwapChain == VK_NULL_HANDLE);
     }
+    // ReleaseSwapChainResources() has waited for the last task of the present thread
+    m_pPresentThread.reset();
 
     if (m_VkSurface != VK_NULL_HANDLE)
     {
@@ -613,6 +722,18 @@ void SwapChainVkImpl::InitBuffersAndViews()
 }
 
 VkResult SwapChainVkImpl::AcquireNextImage(DeviceContextVkImpl* pDeviceCtxVk)
+{
+    auto res = AcquireNextVkImage();
+    if (res == VK_SUCCESS)
+    {
+        InitAcquiredImage(pDeviceCtxVk);
+        pDeviceCtxVk->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    }
+
+    return res;
+}
+
+VkResult SwapChainVkImpl::AcquireNextVkImage()
 {
     auto*       pDeviceVk     = m_pRenderDevice.RawPtr<RenderDeviceVkImpl>();
     const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
@@ -657,27 +778,28 @@ VkResult SwapChainVkImpl::AcquireNextImage(DeviceContextVkImpl* pDeviceCtxVk)
     auto res = vkAcquireNextImageKHR(LogicalDevice.GetVkDevice(), m_VkSwapChain, UINT64_MAX, ImageAcquiredSemaphore, ImageAcquiredFence, &m_BackBufferIndex);
 
     m_ImageAcquiredFenceSubmitted[m_SemaphoreIndex] = (res == VK_SUCCESS);
-    if (res == VK_SUCCESS)
+
+    return res;
+}
+
+void SwapChainVkImpl::InitAcquiredImage(DeviceContextVkImpl* pDeviceCtxVk)
+{
+    // Next command in the device context must wait for the next image to be acquired.
+    // Unlike fences or events, the act of waiting for a semaphore also unsignals that semaphore (6.4.2).
+    // Swapchain image may be used as render target or as destination for copy command.
+    pDeviceCtxVk->AddWaitSemaphore(m_ImageAcquiredSemaphores[m_SemaphoreIndex], VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT);
+    if (!m_SwapChainImagesInitialized[m_BackBufferIndex])
     {
-        // Next command in the device context must wait for the next image to be acquired.
-        // Unlike fences or events, the act of waiting for a semaphore also unsignals that semaphore (6.4.2).
-        // Swapchain image may be used as render target or as destination for copy command.
-        pDeviceCtxVk->AddWaitSemaphore(m_ImageAcquiredSemaphores[m_SemaphoreIndex], VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT);
-        if (!m_SwapChainImagesInitialized[m_BackBufferIndex])
-        {
-            // Vulkan validation layers do not like uninitialized memory.
-            // Clear back buffer first time we acquire it.
-
-            ITextureView* pRTV = GetCurrentBackBufferRTV();
-            ITextureView* pDSV = GetDepthBufferDSV();
-            pDeviceCtxVk->SetRenderTargets(1, &pRTV, pDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-            pDeviceCtxVk->ClearRenderTarget(GetCurrentBackBufferRTV(), nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
-            m_SwapChainImagesInitialized[m_BackBufferIndex] = true;
-        }
+        // Vulkan validation layers do not like uninitialized memory.
+        // Clear back buffer first time we acquire it.
+
+        ITextureView* pRTV = GetCurrentBackBufferRTV();
+        ITextureView* pDSV = GetDepthBufferDSV();
+        pDeviceCtxVk->SetRenderTargets(1, &pRTV, pDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pDeviceCtxVk->ClearRenderTarget(GetCurrentBackBufferRTV(), nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
         pDeviceCtxVk->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+        m_SwapChainImagesInitialized[m_BackBufferIndex] = true;
     }
-
-    return res;
 }
 
 void SwapChainVkImpl::Present(Uint32 SyncInterval)
@@ -709,29 +831,33 @@ void SwapChainVkImpl::Present(Uint32 SyncInterval)
 
     pImmediateCtxVk->Flush();
 
-    if (!m_IsMinimized)
+    const bool EnableVSync = SyncInterval != 0;
+
+    // The present thread presents the image and acquires the next one, so that the render thread does
+    // not block in the presentation engine. Changing the vsync mode requires recreating the swap chain,
+    // which is done synchronously.
+    const bool PresentAsync = m_pPresentThread && !m_IsMinimized && m_VSyncEnabled == EnableVSync;
+    if (PresentAsync)
     {
-        VkPresentInfoKHR PresentInfo = {};
-
-        PresentInfo.sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-        PresentInfo.pNext              = nullptr;
-        PresentInfo.waitSemaphoreCount = 1;
-        // Unlike fences or events, the act of waiting for a semaphore also unsignals that semaphore (6.4.2)
-        VkSemaphore WaitSemaphore[] = {m_DrawCompleteSemaphores[m_SemaphoreIndex]->Get()};
-        PresentInfo.pWaitSemaphores = WaitSemaphore;
-        PresentInfo.swapchainCount  = 1;
-        PresentInfo.pSwapchains     = &m_VkSwapChain;
-        PresentInfo.pImageIndices   = &m_BackBufferIndex;
-        VkResult Result             = VK_SUCCESS;
-        PresentInfo.pResults        = &Result;
-        pDeviceVk->LockCmdQueueAndRun(
-            pImmediateCtxVk->GetCommandQueueId(),
-            [&PresentInfo](ICommandQueueVk* pCmdQueueVk) //
+        const auto CmdQueueId     = pImmediateCtxVk->GetCommandQueueId();
+        const auto SemaphoreIndex = m_SemaphoreIndex;
+
+        ++m_SemaphoreIndex;
+        if (m_SemaphoreIndex >= m_SwapChainDesc.BufferCount)
+            m_SemaphoreIndex = 0;
+
+        m_pPresentThread->Post(
+            [this, CmdQueueId, SemaphoreIndex]() //
             {
-                pCmdQueueVk->Present(PresentInfo);
+                // If the present fails, the swap chain is recreated by the render thread, see WaitForPresentThread().
+                auto res = QueuePresent(CmdQueueId, SemaphoreIndex);
+                return res == VK_SUCCESS ? AcquireNextVkImage() : res;
             } //
         );
-
+    }
+    else if (!m_IsMinimized)
+    {
+        auto Result = QueuePresent(pImmediateCtxVk->GetCommandQueueId(), m_SemaphoreIndex);
         if (Result == VK_SUBOPTIMAL_KHR || Result == VK_ERROR_OUT_OF_DATE_KHR)
         {
             RecreateVulkanSwapchain(pImmediateCtxVk);
@@ -749,14 +875,12 @@ void SwapChainVkImpl::Present(Uint32 SyncInterval)
         pDeviceVk->ReleaseStaleResources();
     }
 
-    if (!m_IsMinimized)
+    if (!m_IsMinimized && !PresentAsync)
     {
         ++m_SemaphoreIndex;
         if (m_SemaphoreIndex >= m_SwapChainDesc.BufferCount)
             m_SemaphoreIndex = 0;
 
-        bool EnableVSync = SyncInterval != 0;
-
         auto res = (m_VSyncEnabled == EnableVSync) ? AcquireNextImage(pImmediateCtxVk) : VK_ERROR_OUT_OF_DATE_KHR;
         if (res == VK_SUBOPTIMAL_KHR || res == VK_ERROR_OUT_OF_DATE_KHR)
         {
@@ -770,6 +894,143 @@ void SwapChainVkImpl::Present(Uint32 SyncInterval)
     }
 }
 
+VkResult SwapChainVkImpl::QueuePresent(SoftwareQueueIndex CmdQueueId, Uint32 SemaphoreIndex)
+{
+    auto* pDeviceVk = m_pRenderDevice.RawPtr<RenderDeviceVkImpl>();
+
+    VkPresentInfoKHR PresentInfo = {};
+
+    PresentInfo.sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    PresentInfo.pNext              = nullptr;
+    PresentInfo.waitSemaphoreCount = 1;
+    // Unlike fences or events, the act of waiting for a semaphore also unsignals that semaphore (6.4.2)
+    VkSemaphore WaitSemaphore[] = {m_DrawCompleteSemaphores[SemaphoreIndex]->Get()};
+    PresentInfo.pWaitSemaphores = WaitSemaphore;
+    PresentInfo.swapchainCount  = 1;
+    PresentInfo.pSwapchains     = &m_VkSwapChain;
+    PresentInfo.pImageIndices   = &m_BackBufferIndex;
+    VkResult Result             = VK_SUCCESS;
+    PresentInfo.pResults        = &Result;
+
+    // In the low-latency mode, WaitForFrame() waits for the present operations by their ids.
+    VkPresentIdKHR PresentIdInfo = {};
+    if (m_SwapChainDesc.LowLatencyMode && pDeviceVk->GetLogicalDevice().GetEnabledExtFeatures().PresentWait.presentWait != VK_FALSE)
+    {
+        ++m_PresentId;
+
+        PresentIdInfo.sType          = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+        PresentIdInfo.swapchainCount = 1;
+        PresentIdInfo.pPresentIds    = &m_PresentId;
+
+        PresentInfo.pNext = &PresentIdInfo;
+    }
+
+    pDeviceVk->LockCmdQueueAndRun(
+        CmdQueueId,
+        [&PresentInfo](ICommandQueueVk* pCmdQueueVk) //
+        {
+            pCmdQueueVk->Present(PresentInfo);
+        } //
+    );
+
+    return Result;
+}
+
+void SwapChainVkImpl::WaitForPresentThread(DeviceContextVkImpl* pImmediateCtxVk)
+{
+    VkResult res = VK_SUCCESS;
+    if (!m_pPresentThread || !m_pPresentThread->Wait(res))
+        return;
+
+    if (pImmediateCtxVk == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Immediate context has been released");
+        return;
+    }
+
+    if (res == VK_SUCCESS)
+    {
+        InitAcquiredImage(pImmediateCtxVk);
+        return;
+    }
+
+    if (res == VK_SUBOPTIMAL_KHR || res == VK_ERROR_OUT_OF_DATE_KHR)
+    {
+        RecreateVulkanSwapchain(pImmediateCtxVk);
+        res = AcquireNextImage(pImmediateCtxVk);
+    }
+    DEV_CHECK_ERR(res == VK_SUCCESS, "Failed to acquire next swap chain image");
+}
+
+ITextureViewVk* SwapChainVkImpl::GetCurrentBackBufferRTV()
+{
+    if (m_pPresentThread)
+    {
+        // The present thread may still be acquiring the image
+        auto pDeviceContext = m_wpDeviceContext.Lock();
+        WaitForPresentThread(pDeviceContext.RawPtr<DeviceContextVkImpl>());
+    }
+
+    VERIFY_EXPR(m_BackBufferIndex < m_SwapChainDesc.BufferCount);
+    return m_pBackBufferRTV[m_BackBufferIndex];
+}
+
+void SwapChainVkImpl::SetMaximumFrameLatency(Uint32 MaxLatency)
+{
+    m_MaxFrameLatency = std::max(MaxLatency, 1u);
+}
+
+void SwapChainVkImpl::WaitForFrame()
+{
+    if (!m_SwapChainDesc.LowLatencyMode || m_IsMinimized)
+        return;
+
+    if (m_pPresentThread)
+    {
+        // The swap chain must not be accessed while the present thread uses it
+        auto pDeviceContext = m_wpDeviceContext.Lock();
+        WaitForPresentThread(pDeviceContext.RawPtr<DeviceContextVkImpl>());
+    }
+
+    const auto& LogicalDevice = m_pRenderDevice.RawPtr<RenderDeviceVkImpl>()->GetLogicalDevice();
+    if (LogicalDevice.GetEnabledExtFeatures().PresentWait.presentWait != VK_FALSE)
+    {
+        // Wait until no more than m_MaxFrameLatency frames, including the next one, are queued for presentation.
+        //
+        //   m_MaxFrameLatency = 2
+        //
+        //     Id-1           Id          (Next frame)
+        //      |             |             |
+        //      |
+        //  Wait for this present
+        //
+        if (m_PresentId + 1 > m_MaxFrameLatency)
+        {
+            const auto WaitId = m_PresentId + 1 - m_MaxFrameLatency;
+
+            constexpr Uint64 Timeout = Uint64{500} * 1000 * 1000; // 0.5 second timeout (shouldn't ever occur)
+
+            auto res = LogicalDevice.WaitForPresent(m_VkSwapChain, WaitId, Timeout);
+            // The swap chain will be recreated by the next Present()
+            if (res != VK_SUCCESS && res != VK_ERROR_OUT_OF_DATE_KHR && res != VK_SUBOPTIMAL_KHR)
+            {
+                LOG_ERROR_MESSAGE("Waiting for the present operation ", WaitId, " failed. This is a strong indication of a synchronization error.");
+            }
+        }
+    }
+    else
+    {
+        // Without VK_KHR_present_wait, wait until the presentation engine releases
+        // the image that was acquired for the next frame.
+        if (m_ImageAcquiredFenceSubmitted[m_SemaphoreIndex])
+        {
+            VkFence ImageAcquiredFence = m_ImageAcquiredFences[m_SemaphoreIndex];
+            if (LogicalDevice.GetFenceStatus(ImageAcquiredFence) == VK_NOT_READY)
+                LogicalDevice.WaitForFences(1, &ImageAcquiredFence, VK_TRUE, UINT64_MAX);
+        }
+    }
+}
+
 void SwapChainVkImpl::WaitForImageAcquiredFences()
 {
     const auto& LogicalDevice = m_pRenderDevice.RawPtr<RenderDeviceVkImpl>()->GetLogicalDevice();
@@ -789,6 +1050,14 @@ void SwapChainVkImpl::ReleaseSwapChainResources(DeviceContextVkImpl* pImmediateC
     if (m_VkSwapChain == VK_NULL_HANDLE)
         return;
 
+    if (m_pPresentThread)
+    {
+        // Wait for the present thread to finish using the swap chain. The image it may have
+        // acquired is released together with the swap chain.
+        VkResult res = VK_SUCCESS;
+        m_pPresentThread->Wait(res);
+    }
+
     if (pImmediateCtxVk != nullptr)
     {
         // Flush to submit all pending commands and semaphores to the queue.
@@ -868,6 +1137,9 @@ void SwapChainVkImpl::RecreateVulkanSwapchain(DeviceContextVkImpl* pImmediateCtx
 
     CreateVulkanSwapChain();
     InitBuffersAndViews();
+
+    // Present ids are only meaningful within one swap chain
+    m_PresentId = 0;
 }
 
 void SwapChainVkImpl::Resize(Uint32 NewWidth, Uint32 NewHeight, SURFACE_TRANSFORM NewPreTransform)
@@ -30,6 +30,7 @@
 #include "RenderDeviceVkImpl.hpp"
 #include "DeviceContextVkImpl.hpp"
 #include "TextureViewVkImpl.hpp"
+#include "DeviceMemoryVkImpl.hpp"
 #include "VulkanTypeConversions.hpp"
 #include "EngineMemory.h"
 #include "StringTools.hpp"
@@ -162,6 +163,8 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
     if (m_Desc.Usage == USAGE_IMMUTABLE && (pInitData == nullptr || pInitData->pSubResources == nullptr))
         LOG_ERROR_AND_THROW("Immutable textures must be initialized with data at creation time: pInitData can't be null");
 
+    ValidateTextureInitData(m_Desc, pInitData);
+
     const auto IsMemoryless = (m_Desc.MiscFlags & MISC_TEXTURE_FLAG_MEMORYLESS) != 0;
     if (IsMemoryless && pInitData != nullptr && pInitData->pSubResources != nullptr)
         LOG_ERROR_AND_THROW("Memoryless textures can't be initialized");
@@ -205,15 +208,45 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
 
             InitSparseProperties();
         }
+        else if (pInitData != nullptr && pInitData->pMemory != nullptr)
+        {
+            // Bind the image to the memory range of the device memory object. The memory may be shared by other
+            // placed resources, so the texture must be activated with an aliasing barrier before it is used.
+            m_VulkanImage = LogicalDevice.CreateImage(ImageCI, m_Desc.Name);
+
+            const auto  MemReqs   = LogicalDevice.GetImageMemoryRequirements(m_VulkanImage);
+            const auto* pMemoryVk = ClassPtrCast<const DeviceMemoryVkImpl>(pInitData->pMemory);
+            if ((MemReqs.memoryTypeBits & (1u << pMemoryVk->GetMemoryTypeIndex())) == 0)
+                LOG_ERROR_AND_THROW("The memory type of the device memory is not compatible with the texture");
+
+            const auto MemRange = pMemoryVk->GetRange(pInitData->MemoryOffset, MemReqs.size);
+            if (MemRange.Handle == VK_NULL_HANDLE)
+                LOG_ERROR_AND_THROW("Memory range [", pInitData->MemoryOffset, ", ", pInitData->MemoryOffset + MemReqs.size, ") is not a valid range of the device memory");
+            if ((MemRange.Offset % MemReqs.alignment) != 0)
+                LOG_ERROR_AND_THROW("Memory offset (", pInitData->MemoryOffset, ") is not a multiple of the required alignment (", MemReqs.alignment, ")");
+
+            m_pMemory = pInitData->pMemory;
+
+            auto err = LogicalDevice.BindImageMemory(m_VulkanImage, MemRange.Handle, MemRange.Offset);
+            CHECK_VK_ERROR_AND_THROW(err, "Failed to bind image memory");
+
+            if (pInitData->pSubResources != nullptr && pInitData->NumSubresources > 0)
+                InitializeTextureContent(*pInitData, FmtAttribs, ImageCI);
+            else
+                SetState(RESOURCE_STATE_UNDEFINED);
+        }
         else
         {
             m_VulkanImage = LogicalDevice.CreateImage(ImageCI, m_Desc.Name);
 
-            VkMemoryRequirements MemReqs = LogicalDevice.GetImageMemoryRequirements(m_VulkanImage);
+            VulkanUtilities::VulkanDedicatedAllocationInfo DedicatedInfo;
+            DedicatedInfo.vkImage = m_VulkanImage;
+
+            VkMemoryRequirements MemReqs = LogicalDevice.GetImageMemoryRequirements(m_VulkanImage, DedicatedInfo.Preferred);
 
             const auto ImageMemoryFlags = IsMemoryless ? VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
             VERIFY(IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
-            m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, ImageMemoryFlags);
+            m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, ImageMemoryFlags, 0, &DedicatedInfo);
             auto AlignedOffset = AlignUp(m_MemoryAllocation.UnalignedOffset, MemReqs.alignment);
             VERIFY_EXPR(m_MemoryAllocation.Size >= MemReqs.size + (AlignedOffset - m_MemoryAllocation.UnalignedOffset));
             auto Memory = m_MemoryAllocation.Page->GetVkMemory();
@@ -251,10 +284,6 @@ void TextureVkImpl::InitializeTextureContent(const TextureData&          InitDat
     // Vulkan validation layers do not like uninitialized memory, so if no initial data
     // is provided, we will clear the memory
 
-    VulkanUtilities::CommandPoolWrapper  CmdPool;
-    VulkanUtilities::VulkanCommandBuffer CmdBuffer;
-    GetDevice()->AllocateTransientCmdPool(CmdQueueInd, CmdPool, CmdBuffer, "Transient command pool to copy staging data to a device buffer");
-
     VkImageAspectFlags aspectMask = 0;
     if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH)
         aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
@@ -275,7 +304,6 @@ void TextureVkImpl::InitializeTextureContent(const TextureData&          InitDat
     SubresRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
     SubresRange.baseMipLevel   = 0;
     SubresRange.levelCount     = VK_REMAINING_MIP_LEVELS;
-    CmdBuffer.TransitionImageLayout(m_VulkanImage, ImageCI.initialLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SubresRange, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
     SetState(RESOURCE_STATE_COPY_DEST);
     const auto CurrentLayout = GetLayout();
     VERIFY_EXPR(CurrentLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
@@ -394,15 +422,18 @@ void TextureVkImpl::InitializeTextureContent(const TextureData&          InitDat
     auto err = LogicalDevice.BindBufferMemory(StagingBuffer, StagingBufferMemory, AlignedStagingMemOffset);
     CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging buffer memory");
 
-    CmdBuffer.MemoryBarrier(VK_ACCESS_HOST_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_HOST_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
-
-    // Copy commands MUST be recorded outside of a render pass instance. This is OK here
-    // as copy will be the only command in the cmd buffer
-    CmdBuffer.CopyBufferToImage(StagingBuffer, m_VulkanImage,
-                                CurrentLayout, // dstImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
-                                static_cast<uint32_t>(Regions.size()), Regions.data());
-
-    GetDevice()->ExecuteAndDisposeTransientCmdBuff(CmdQueueInd, CmdBuffer.GetVkCmdBuffer(), std::move(CmdPool));
+    GetDevice()->RecordInitialDataCopy(
+        CmdQueueInd, uploadBufferSize, "Transient command pool to copy staging data to a device buffer",
+        [&](VulkanUtilities::VulkanCommandBuffer& CmdBuffer) {
+            CmdBuffer.TransitionImageLayout(m_VulkanImage, ImageCI.initialLayout, CurrentLayout, SubresRange, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+            CmdBuffer.MemoryBarrier(VK_ACCESS_HOST_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_HOST_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+            // Copy commands MUST be recorded outside of a render pass instance. This is OK here
+            // as the command buffer only contains copy commands
+            CmdBuffer.CopyBufferToImage(StagingBuffer, m_VulkanImage,
+                                        CurrentLayout, // dstImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
+                                        static_cast<uint32_t>(Regions.size()), Regions.data());
+        });
 
     // After command buffer is submitted, safe-release resources. This strategy
     // is little overconservative as the resources will be released after the first
@@ -31,6 +31,7 @@
 
 #include <chrono>
 #include <thread>
+#include <limits>
 
 #include "RenderDeviceVkImpl.hpp"
 
@@ -47,7 +48,8 @@ static VkDeviceSize GetDefaultAlignment(const VulkanUtilities::VulkanPhysicalDev
 VulkanDynamicMemoryManager::VulkanDynamicMemoryManager(IMemoryAllocator&   Allocator,
                                                        RenderDeviceVkImpl& DeviceVk,
                                                        Uint32              Size,
-                                                       Uint64              CommandQueueMask) :
+                                                       Uint64              CommandQueueMask,
+                                                       Uint32              RingPageSize) :
     // clang-format off
     TBase             {Allocator, Size},
     m_DeviceVk        {DeviceVk},
@@ -57,6 +59,19 @@ VulkanDynamicMemoryManager::VulkanDynamicMemoryManager(IMemoryAllocator&   Alloc
 {
     VERIFY((Size & (MasterBlockAlignment - 1)) == 0, "Heap size (", Size, " is not aligned by the master block alignment (", Uint32{MasterBlockAlignment}, ")");
 
+    if (RingPageSize != 0)
+    {
+        if (RingPageSize % MasterBlockAlignment == 0 && Size % RingPageSize == 0)
+        {
+            m_pPageRing = std::make_unique<DynamicHeap::MasterBlockLockFreeRingManager>(Allocator, Size, RingPageSize);
+        }
+        else
+        {
+            LOG_WARNING_MESSAGE("Dynamic heap page ring is disabled: heap size (", Size, ") must be a multiple of the page size (",
+                                RingPageSize, ") and the page size must be a multiple of ", Uint32{MasterBlockAlignment});
+        }
+    }
+
     VkBufferCreateInfo VkBuffCI{};
     VkBuffCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     VkBuffCI.pNext = nullptr;
@@ -151,9 +166,14 @@ VulkanDynamicMemoryManager::MasterBlock VulkanDynamicMemoryManager::AllocateMast
         return MasterBlock{};
     }
 
-    auto Block = TBase::AllocateMasterBlock(SizeInBytes, Alignment);
+    auto Block = AllocateMasterBlockInternal(SizeInBytes, Alignment);
     if (!Block.IsValid())
     {
+        {
+            std::lock_guard<std::mutex> Lock{m_StatsMtx};
+            ++m_StallCount;
+        }
+
         // Allocation failed. Try to wait for GPU to finish pending frames to release some space
         auto                          StartIdleTime   = std::chrono::high_resolution_clock::now();
         static constexpr const auto   SleepPeriod     = std::chrono::milliseconds(1);
@@ -163,7 +183,8 @@ VulkanDynamicMemoryManager::MasterBlock VulkanDynamicMemoryManager::AllocateMast
         while (!Block.IsValid() && IdleDuration < MaxIdleDuration)
         {
             m_DeviceVk.PurgeReleaseQueues();
-            Block = TBase::AllocateMasterBlock(SizeInBytes, Alignment);
+            ReleaseCompletedFrames();
+            Block = AllocateMasterBlockInternal(SizeInBytes, Alignment);
             if (!Block.IsValid())
             {
                 std::this_thread::sleep_for(SleepPeriod);
@@ -177,10 +198,15 @@ VulkanDynamicMemoryManager::MasterBlock VulkanDynamicMemoryManager::AllocateMast
         if (!Block.IsValid())
         {
             // Last resort - idle GPU (there seems to have been a driver bug at some point: vkQueueWaitIdle() would deadlock and never return)
+            // This also reclaims the pages of all finished frames of the page ring
             m_DeviceVk.IdleGPU();
-            Block = TBase::AllocateMasterBlock(SizeInBytes, Alignment);
+            Block = AllocateMasterBlockInternal(SizeInBytes, Alignment);
             if (!Block.IsValid())
             {
+                {
+                    std::lock_guard<std::mutex> Lock{m_StatsMtx};
+                    ++m_FailedAllocationCount;
+                }
                 LOG_ERROR_MESSAGE("Space in dynamic heap is exhausted! After idling for ",
                                   std::fixed, std::setprecision(1), IdleDuration.count() * 1000.0,
                                   " ms still no space is available. Increase the size of the heap by setting "
@@ -212,11 +238,96 @@ VulkanDynamicMemoryManager::MasterBlock VulkanDynamicMemoryManager::AllocateMast
     }
 
     if (Block.IsValid())
+        UpdatePeakSize();
+
+    return Block;
+}
+
+VulkanDynamicMemoryManager::MasterBlock VulkanDynamicMemoryManager::AllocateMasterBlockInternal(OffsetType SizeInBytes, OffsetType Alignment)
+{
+    return m_pPageRing ?
+        m_pPageRing->AllocateMasterBlock(SizeInBytes, Alignment) :
+        TBase::AllocateMasterBlock(SizeInBytes, Alignment);
+}
+
+void VulkanDynamicMemoryManager::ReleaseMasterBlocks(std::vector<MasterBlock>& Blocks, RenderDeviceVkImpl& DeviceVk, Uint64 CmdQueueMask)
+{
+    if (m_pPageRing)
     {
-        m_TotalPeakSize = std::max(m_TotalPeakSize, GetUsedSize());
+        // The pages are reclaimed when the frame is completed
+        m_pPageRing->DiscardMasterBlocks(Blocks, 0);
     }
+    else
+    {
+        TBase::ReleaseMasterBlocks(Blocks, DeviceVk, CmdQueueMask);
+    }
+}
 
-    return Block;
+void VulkanDynamicMemoryManager::ReleaseCompletedFrames(bool ForceRelease)
+{
+    if (!m_pPageRing)
+        return;
+
+    // The page ring is only used with a single command queue
+    const SoftwareQueueIndex QueueInd{0};
+    if (ForceRelease)
+    {
+        // Pages that have been allocated since the last frame was finished
+        m_pPageRing->FinishFrame(m_DeviceVk.GetNextFenceValue(QueueInd));
+        m_pPageRing->ReleaseCompletedFrames(std::numeric_limits<Uint64>::max());
+    }
+    else
+    {
+        m_pPageRing->ReleaseCompletedFrames(m_DeviceVk.GetCompletedFenceValue(QueueInd));
+    }
+}
+
+VulkanDynamicMemoryManager::OffsetType VulkanDynamicMemoryManager::GetSize() const
+{
+    return m_pPageRing ? m_pPageRing->GetSize() : TBase::GetSize();
+}
+
+VulkanDynamicMemoryManager::OffsetType VulkanDynamicMemoryManager::GetUsedSize() const
+{
+    return m_pPageRing ? m_pPageRing->GetUsedSize() : TBase::GetUsedSize();
+}
+
+void VulkanDynamicMemoryManager::UpdatePeakSize()
+{
+    const auto UsedSize = GetUsedSize();
+
+    std::lock_guard<std::mutex> Lock{m_StatsMtx};
+    m_TotalPeakSize = std::max(m_TotalPeakSize, UsedSize);
+    m_FramePeakSize = std::max(m_FramePeakSize, UsedSize);
+}
+
+void VulkanDynamicMemoryManager::EndFrame()
+{
+    if (m_pPageRing)
+    {
+        // All command buffers that use the pages of this frame must have been submitted, and
+        // the pages are reclaimed when the GPU completes the next submission.
+        m_pPageRing->FinishFrame(m_DeviceVk.GetNextFenceValue(SoftwareQueueIndex{0}));
+    }
+
+    const auto UsedSize = GetUsedSize();
+
+    std::lock_guard<std::mutex> Lock{m_StatsMtx};
+    m_LastFramePeakSize = m_FramePeakSize;
+    // The master blocks allocated during the previous frame may still be in use
+    m_FramePeakSize = UsedSize;
+}
+
+void VulkanDynamicMemoryManager::GetStats(DynamicHeapStatsVk& Stats)
+{
+    Stats.Size     = GetSize();
+    Stats.UsedSize = GetUsedSize();
+
+    std::lock_guard<std::mutex> Lock{m_StatsMtx};
+    Stats.PeakUsedSize          = m_TotalPeakSize;
+    Stats.FramePeakUsedSize     = m_LastFramePeakSize;
+    Stats.StallCount            = m_StallCount;
+    Stats.FailedAllocationCount = m_FailedAllocationCount;
 }
 
 
@@ -2028,6 +2028,14 @@ DeviceFeatures VkFeaturesToDeviceFeatures(uint32_t
                   ExtFeatures.ShadingRate.attachmentFragmentShadingRate != VK_FALSE ||
                   ExtFeatures.FragmentDensityMap.fragmentDensityMap != VK_FALSE));
 
+#if DILIGENT_USE_VOLK
+    // vkCmdSet*EXT functions of VK_EXT_extended_dynamic_state are not exported by the loader, so the feature requires volk.
+    INIT_FEATURE(ExtendedDynamicState,
+                 ExtFeatures.ExtendedDynamicState.extendedDynamicState != VK_FALSE);
+#else
+    Features.ExtendedDynamicState = DEVICE_FEATURE_STATE_DISABLED;
+#endif
+
 #undef INIT_FEATURE
 
     // Not supported in Vulkan on top of Metal.
@@ -2037,7 +2045,7 @@ DeviceFeatures VkFeaturesToDeviceFeatures(uint32_t
     Features.DurationQueries        = DEVICE_FEATURE_STATE_DISABLED;
 #endif
 
-    ASSERT_SIZEOF(DeviceFeatures, 41, "Did you add a new feature to DeviceFeatures? Please handle its status here (if necessary).");
+    ASSERT_SIZEOF(DeviceFeatures, 42, "Did you add a new feature to DeviceFeatures? Please handle its status here (if necessary).");
 
     return Features;
 }
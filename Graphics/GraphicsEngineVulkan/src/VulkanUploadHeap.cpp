@@ -26,6 +26,9 @@
  */
 
 #include "pch.h"
+
+#include <algorithm>
+
 #include "VulkanUploadHeap.hpp"
 #include "RenderDeviceVkImpl.hpp"
 
@@ -38,7 +41,8 @@ VulkanUploadHeap::VulkanUploadHeap(RenderDeviceVkImpl& RenderDevice,
     // clang-format off
     m_RenderDevice {RenderDevice       },
     m_HeapName     {std::move(HeapName)},
-    m_PageSize     {PageSize           }
+    m_PageSize     {PageSize           },
+    m_pPageCache   {std::make_shared<PageCache>()}
 // clang-format on
 {
 }
@@ -49,7 +53,88 @@ VulkanUploadHeap::~VulkanUploadHeap()
     auto PeakAllocatedPages = m_PeakAllocatedSize / m_PageSize;
     LOG_INFO_MESSAGE(m_HeapName, " peak used/allocated frame size: ", FormatMemorySize(m_PeakFrameSize, 2, m_PeakAllocatedSize),
                      " / ", FormatMemorySize(m_PeakAllocatedSize, 2),
-                     " (", PeakAllocatedPages, (PeakAllocatedPages == 1 ? " page)" : " pages)"));
+                     " (", PeakAllocatedPages, (PeakAllocatedPages == 1 ? " page)" : " pages)"),
+                     ". Pages created/reused: ", m_NumNewPages, " / ", m_NumReusedPages);
+}
+
+class VulkanUploadHeap::StalePage
+{
+public:
+    StalePage(UploadPageInfo&& Page, std::weak_ptr<PageCache> pCache) noexcept :
+        m_Page{std::move(Page)},
+        m_pCache{std::move(pCache)}
+    {}
+
+    // clang-format off
+    StalePage            (const StalePage&)  = delete;
+    StalePage& operator= (const StalePage&)  = delete;
+    StalePage            (      StalePage&&) = default;
+    StalePage& operator= (      StalePage&&) = delete;
+    // clang-format on
+
+    // The destructor is called by the release queue when the GPU is done with the page.
+    ~StalePage()
+    {
+        if (m_Page.Buffer == VK_NULL_HANDLE)
+            return;
+
+        // If the heap has been destroyed, the page is returned to the memory manager.
+        if (auto pCache = m_pCache.lock())
+            pCache->Add(std::move(m_Page));
+    }
+
+private:
+    UploadPageInfo           m_Page;
+    std::weak_ptr<PageCache> m_pCache;
+};
+
+void VulkanUploadHeap::PageCache::Add(UploadPageInfo&& Page)
+{
+    std::lock_guard<std::mutex> Lock{Mtx};
+
+    TotalSize += Page.Size;
+    Pages[Page.Size].emplace_back(std::move(Page));
+    Trim();
+}
+
+VulkanUploadHeap::UploadPageInfo VulkanUploadHeap::PageCache::Get(VkDeviceSize Size)
+{
+    std::lock_guard<std::mutex> Lock{Mtx};
+
+    auto it = Pages.find(Size);
+    if (it == Pages.end() || it->second.empty())
+        return UploadPageInfo{VulkanUtilities::VulkanMemoryAllocation{}, VulkanUtilities::BufferWrapper{}, nullptr, 0};
+
+    UploadPageInfo Page{std::move(it->second.back())};
+    it->second.pop_back();
+    if (it->second.empty())
+        Pages.erase(it);
+
+    VERIFY_EXPR(TotalSize >= Page.Size);
+    TotalSize -= Page.Size;
+    return Page;
+}
+
+void VulkanUploadHeap::PageCache::Trim()
+{
+    // Mtx must be locked.
+    while (TotalSize > MaxSize && !Pages.empty())
+    {
+        auto  it      = std::prev(Pages.end());
+        auto& Largest = it->second;
+        VERIFY_EXPR(!Largest.empty() && TotalSize >= it->first);
+        TotalSize -= it->first;
+        // The page is not used by the GPU, so its memory is returned to the manager immediately.
+        Largest.pop_back();
+        if (Largest.empty())
+            Pages.erase(it);
+    }
+}
+
+VkDeviceSize VulkanUploadHeap::GetCachedSize() const
+{
+    std::lock_guard<std::mutex> Lock{m_pPageCache->Mtx};
+    return m_pPageCache->TotalSize;
 }
 
 VulkanUploadHeap::UploadPageInfo VulkanUploadHeap::CreateNewPage(VkDeviceSize SizeInBytes) const
@@ -86,7 +171,20 @@ VulkanUploadHeap::UploadPageInfo VulkanUploadHeap::CreateNewPage(VkDeviceSize Si
     (void)err;
     auto CPUAddress = reinterpret_cast<Uint8*>(MemAllocation.Page->GetCPUMemory()) + AlignedOffset;
 
-    return UploadPageInfo{std::move(MemAllocation), std::move(NewBuffer), CPUAddress};
+    return UploadPageInfo{std::move(MemAllocation), std::move(NewBuffer), CPUAddress, SizeInBytes};
+}
+
+VulkanUploadHeap::UploadPageInfo VulkanUploadHeap::AcquirePage(VkDeviceSize SizeInBytes)
+{
+    auto Page = m_pPageCache->Get(SizeInBytes);
+    if (Page.Buffer != VK_NULL_HANDLE)
+    {
+        ++m_NumReusedPages;
+        return Page;
+    }
+
+    ++m_NumNewPages;
+    return CreateNewPage(SizeInBytes);
 }
 
 VulkanUploadAllocation VulkanUploadHeap::Allocate(VkDeviceSize SizeInBytes, VkDeviceSize Alignment)
@@ -96,8 +194,13 @@ VulkanUploadAllocation VulkanUploadHeap::Allocate(VkDeviceSize SizeInBytes, VkDe
     VulkanUploadAllocation Allocation;
     if (SizeInBytes >= m_PageSize / 2)
     {
-        // Allocate large chunk directly from the memory manager
-        auto NewPage          = CreateNewPage(SizeInBytes);
+        // Allocate a dedicated page. Round the size up to a power-of-two multiple of the
+        // page size so that the page can be reused by the allocations of similar size.
+        auto PageSize = m_PageSize;
+        while (PageSize < SizeInBytes)
+            PageSize *= 2;
+
+        auto NewPage          = AcquirePage(PageSize);
         Allocation.vkBuffer   = NewPage.Buffer;
         Allocation.CPUAddress = NewPage.CPUAddress;
         Allocation.Size       = SizeInBytes;
@@ -112,7 +215,7 @@ VulkanUploadAllocation VulkanUploadHeap::Allocate(VkDeviceSize SizeInBytes, VkDe
         if (m_CurrPage.AvailableSize < SizeInBytes + AlignmentOffset)
         {
             // Allocate new page
-            auto NewPage = CreateNewPage(m_PageSize);
+            auto NewPage = AcquirePage(m_PageSize);
             m_CurrPage.Reset(NewPage, m_PageSize);
             m_CurrAllocatedSize += NewPage.MemAllocation.Size;
             m_Pages.emplace_back(std::move(NewPage));
@@ -138,14 +241,21 @@ VulkanUploadAllocation VulkanUploadHeap::Allocate(VkDeviceSize SizeInBytes, VkDe
 
 void VulkanUploadHeap::ReleaseAllocatedPages(Uint64 CmdQueueMask)
 {
-    // The pages will go into the stale resources queue first, however they will move into the release
-    // queue immediately when RenderDeviceVkImpl::FlushStaleResources() is called by the DeviceContextVkImpl::FinishFrame()
-    for (auto& Page : m_Pages)
+    // Keep as many cached pages as the heap allocated in the busiest of the recent frames.
+    m_FrameAllocatedSizes[m_FrameIndex % HighWaterMarkFrames] = m_CurrAllocatedSize;
+    ++m_FrameIndex;
     {
-        m_RenderDevice.SafeReleaseDeviceObject(std::move(Page.MemAllocation), CmdQueueMask);
-        m_RenderDevice.SafeReleaseDeviceObject(std::move(Page.Buffer), CmdQueueMask);
+        std::lock_guard<std::mutex> Lock{m_pPageCache->Mtx};
+        m_pPageCache->MaxSize = *std::max_element(m_FrameAllocatedSizes.begin(), m_FrameAllocatedSizes.end());
+        m_pPageCache->Trim();
     }
 
+    // The pages will go into the stale resources queue first, however they will move into the release
+    // queue immediately when RenderDeviceVkImpl::FlushStaleResources() is called by the DeviceContextVkImpl::FinishFrame().
+    // When the GPU is done with a page, the release queue returns it to the page cache.
+    for (auto& Page : m_Pages)
+        m_RenderDevice.SafeReleaseDeviceObject(StalePage{std::move(Page), m_pPageCache}, CmdQueueMask);
+
     m_Pages.clear();
 
     m_CurrPage          = CurrPageInfo{};
@@ -155,7 +155,7 @@ void VulkanCommandBuffer::TransitionImageLayout(VkImage                        I
                                                 VkPipelineStageFlags           SrcStages,
                                                 VkPipelineStageFlags           DstStages)
 {
-    if (m_State.RenderPass != VK_NULL_HANDLE)
+    if (m_State.InsideRenderPass())
     {
         // Image layout transitions within a render pass execute
         // dependencies between attachments
@@ -178,12 +178,29 @@ void VulkanCommandBuffer::TransitionImageLayout(VkImage                        I
     // Check overlapping subresources
     for (size_t i = 0; i < m_ImageBarriers.size(); ++i)
     {
-        const auto& ImgBarrier = m_ImageBarriers[i];
+        auto& ImgBarrier = m_ImageBarriers[i];
         if (ImgBarrier.image != Image)
             continue;
 
         const auto& OtherRange = ImgBarrier.subresourceRange;
 
+        if (ImgBarrier.newLayout == OldLayout &&
+            OtherRange.aspectMask == SubresRange.aspectMask &&
+            OtherRange.baseMipLevel == SubresRange.baseMipLevel &&
+            OtherRange.levelCount == SubresRange.levelCount &&
+            OtherRange.baseArrayLayer == SubresRange.baseArrayLayer &&
+            OtherRange.layerCount == SubresRange.layerCount)
+        {
+            // The pending barrier transitions the same subresources to the layout this barrier
+            // starts from. There can be no commands between the two barriers, so merge them into
+            // one transition from the original layout. The source stages are not needed as the
+            // intermediate layout is never accessed.
+            ImgBarrier.newLayout     = NewLayout;
+            ImgBarrier.dstAccessMask = AccessMaskFromImageLayout(NewLayout, true) & m_Barrier.SupportedAccessMask;
+            m_Barrier.ImageDstStages |= DstStages;
+            return;
+        }
+
         const auto StartLayer0 = SubresRange.baseArrayLayer;
         const auto EndLayer0   = SubresRange.layerCount != VK_REMAINING_ARRAY_LAYERS ? (SubresRange.baseArrayLayer + SubresRange.layerCount) : ~0u;
         const auto StartLayer1 = OtherRange.baseArrayLayer;
@@ -228,7 +245,7 @@ void VulkanCommandBuffer::MemoryBarrier(VkAccessFlags        srcAccessMask,
                                         VkPipelineStageFlags SrcStages,
                                         VkPipelineStageFlags DstStages)
 {
-    if (m_State.RenderPass != VK_NULL_HANDLE)
+    if (m_State.InsideRenderPass())
     {
         EndRenderPass();
     }
@@ -248,7 +265,7 @@ void VulkanCommandBuffer::FlushBarriers()
     if (m_Barrier.MemorySrcStages == 0 && m_Barrier.MemoryDstStages == 0 && m_ImageBarriers.empty())
         return;
 
-    if (m_State.RenderPass != VK_NULL_HANDLE)
+    if (m_State.InsideRenderPass())
     {
         EndRenderPass();
     }
@@ -280,6 +297,7 @@ void VulkanCommandBuffer::FlushBarriers()
                          static_cast<uint32_t>(m_ImageBarriers.size()),
                          m_ImageBarriers.empty() ? nullptr : m_ImageBarriers.data());
 
+    m_BarrierCount += static_cast<Uint32>(m_ImageBarriers.size()) + (HasMemoryBarrier ? 1 : 0);
     m_ImageBarriers.clear();
     m_Barrier.ImageSrcStages  = 0;
     m_Barrier.ImageDstStages  = 0;
@@ -39,17 +39,11 @@ VulkanCommandBufferPool::VulkanCommandBufferPool(std::shared_ptr<const VulkanLog
                                                  HardwareQueueIndex                         queueFamilyIndex,
                                                  VkCommandPoolCreateFlags                   flags) :
     m_LogicalDevice{std::move(LogicalDevice)},
+    m_QueueFamilyIndex{queueFamilyIndex},
+    m_CmdPoolFlags{flags},
     m_SupportedStagesMask{m_LogicalDevice->GetSupportedStagesMask(queueFamilyIndex)},
     m_SupportedAccessMask{m_LogicalDevice->GetSupportedAccessMask(queueFamilyIndex)}
 {
-    VkCommandPoolCreateInfo CmdPoolCI{};
-    CmdPoolCI.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-    CmdPoolCI.pNext            = nullptr;
-    CmdPoolCI.queueFamilyIndex = queueFamilyIndex;
-    CmdPoolCI.flags            = flags;
-
-    m_CmdPool = m_LogicalDevice->CreateCommandPool(CmdPoolCI);
-    DEV_CHECK_ERR(m_CmdPool != VK_NULL_HANDLE, "Failed to create vulkan command pool");
 }
 
 VulkanCommandBufferPool::~VulkanCommandBufferPool()
@@ -59,46 +53,104 @@ VulkanCommandBufferPool::~VulkanCommandBufferPool()
                   "buffers in release queues, VulkanCommandBufferPool::RecycleCommandBuffer() will crash when attempting to "
                   "return the buffer to the pool.");
 
-    for (auto CmdBuff : m_CmdBuffers)
-        m_LogicalDevice->FreeCommandBuffer(m_CmdPool, CmdBuff);
-    m_CmdPool.Release();
+    // Destroying a command pool frees all command buffers allocated from it
+    m_CmdPools.clear();
 }
 
-VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName)
+void VulkanCommandBufferPool::ProcessReturnedCmdBuffers()
 {
+    auto ReturnCmdBuffer = [this](VkCommandBuffer CmdBuffer) {
+        auto it = m_CmdBufferToPoolIdx.find(CmdBuffer);
+        VERIFY(it != m_CmdBufferToPoolIdx.end(), "Command buffer was not allocated from this pool");
+        auto& Pool = *m_CmdPools[it->second];
+        VERIFY_EXPR(Pool.NumActive > 0);
+        --Pool.NumActive;
+    };
+
     VkCommandBuffer CmdBuffer = VK_NULL_HANDLE;
+    while (m_ReturnedCmdBuffers.TryPop(CmdBuffer))
+        ReturnCmdBuffer(CmdBuffer);
 
+    if (m_HasOverflowCmdBuffers.load(std::memory_order_acquire))
     {
-        std::lock_guard<std::mutex> Lock{m_Mutex};
+        std::lock_guard<Threading::EngineMutex> Lock{m_OverflowMtx};
+        for (auto OverflowCmdBuffer : m_OverflowCmdBuffers)
+            ReturnCmdBuffer(OverflowCmdBuffer);
+        m_OverflowCmdBuffers.clear();
+        m_HasOverflowCmdBuffers.store(false, std::memory_order_release);
+    }
+}
+
+VulkanCommandBufferPool::CmdPoolInfo& VulkanCommandBufferPool::GetCurrentPool()
+{
+    if (!m_CmdPools.empty() && m_CmdPools[m_CurrPoolIdx]->GetNumUsed() < CmdBuffersPerPool)
+        return *m_CmdPools[m_CurrPoolIdx];
+
+    ProcessReturnedCmdBuffers();
 
-        if (!m_CmdBuffers.empty())
+    // Find the next pool whose command buffers are no longer used by the GPU, starting after the current one
+    for (size_t i = 1; i <= m_CmdPools.size(); ++i)
+    {
+        const auto PoolIdx = (m_CurrPoolIdx + i) % m_CmdPools.size();
+        auto&      Pool    = *m_CmdPools[PoolIdx];
+        if (Pool.NumActive == 0)
         {
-            CmdBuffer = m_CmdBuffers.front();
-            auto err  = vkResetCommandBuffer(
-                CmdBuffer,
-                0 // VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT -  specifies that most or all memory resources currently
-                  // owned by the command buffer should be returned to the parent command pool.
-            );
-            DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to reset command buffer");
-            (void)err;
-            m_CmdBuffers.pop_front();
+            // Reset all command buffers allocated from the pool at once
+            m_LogicalDevice->ResetCommandPool(Pool.CmdPool);
+            Pool.NumUsed[0] = 0;
+            Pool.NumUsed[1] = 0;
+            m_CurrPoolIdx   = PoolIdx;
+            return Pool;
         }
     }
 
-    // If no cmd buffers were ready to be reused, create a new one
-    if (CmdBuffer == VK_NULL_HANDLE)
+    VkCommandPoolCreateInfo CmdPoolCI{};
+    CmdPoolCI.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    CmdPoolCI.pNext            = nullptr;
+    CmdPoolCI.queueFamilyIndex = m_QueueFamilyIndex;
+    CmdPoolCI.flags            = m_CmdPoolFlags;
+
+    auto NewPool     = std::make_unique<CmdPoolInfo>();
+    NewPool->CmdPool = m_LogicalDevice->CreateCommandPool(CmdPoolCI);
+    DEV_CHECK_ERR(NewPool->CmdPool != VK_NULL_HANDLE, "Failed to create vulkan command pool");
+
+    m_CurrPoolIdx = m_CmdPools.size();
+    m_CmdPools.emplace_back(std::move(NewPool));
+    return *m_CmdPools.back();
+}
+
+VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName, const VkCommandBufferInheritanceInfo* pInheritanceInfo, bool SimultaneousUse)
+{
+    const bool IsSecondary = pInheritanceInfo != nullptr;
+
+    auto& Pool       = GetCurrentPool();
+    auto& CmdBuffers = Pool.CmdBuffers[IsSecondary ? 1 : 0];
+    auto& NumUsed    = Pool.NumUsed[IsSecondary ? 1 : 0];
+
+    VkCommandBuffer CmdBuffer = VK_NULL_HANDLE;
+    if (NumUsed < CmdBuffers.size())
+    {
+        // The command buffer was reset together with the pool
+        CmdBuffer = CmdBuffers[NumUsed];
+    }
+    else
     {
         VkCommandBufferAllocateInfo BuffAllocInfo = {};
 
         BuffAllocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
         BuffAllocInfo.pNext              = nullptr;
-        BuffAllocInfo.commandPool        = m_CmdPool;
-        BuffAllocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        BuffAllocInfo.commandPool        = Pool.CmdPool;
+        BuffAllocInfo.level              = IsSecondary ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY;
         BuffAllocInfo.commandBufferCount = 1;
 
         CmdBuffer = m_LogicalDevice->AllocateVkCommandBuffer(BuffAllocInfo);
         DEV_CHECK_ERR(CmdBuffer != VK_NULL_HANDLE, "Failed to allocate vulkan command buffer");
+
+        CmdBuffers.push_back(CmdBuffer);
+        m_CmdBufferToPoolIdx[CmdBuffer] = m_CurrPoolIdx;
     }
+    ++NumUsed;
+    ++Pool.NumActive;
 
     VkCommandBufferBeginInfo CmdBuffBeginInfo = {};
 
@@ -107,7 +159,17 @@ VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName)
     CmdBuffBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT; // Each recording of the command buffer will only be
                                                                           // submitted once, and the command buffer will be reset
                                                                           // and recorded again between each submission.
-    CmdBuffBeginInfo.pInheritanceInfo = nullptr;                          // Ignored for a primary command buffer
+    CmdBuffBeginInfo.pInheritanceInfo = pInheritanceInfo;                 // Ignored for a primary command buffer
+    if (SimultaneousUse)
+    {
+        // The command buffer can be resubmitted while it is in the pending state
+        CmdBuffBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+    }
+    if (IsSecondary)
+    {
+        // The secondary command buffer will be executed entirely inside a render pass
+        CmdBuffBeginInfo.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    }
 
     auto err = vkBeginCommandBuffer(CmdBuffer, &CmdBuffBeginInfo);
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to begin command buffer");
@@ -118,10 +180,16 @@ VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName)
     return CmdBuffer;
 }
 
-void VulkanCommandBufferPool::RecycleCommandBuffer(VkCommandBuffer&& CmdBuffer)
+void VulkanCommandBufferPool::RecycleCommandBuffer(VkCommandBuffer&& CmdBuffer, bool /*IsSecondary*/)
 {
-    std::lock_guard<std::mutex> Lock{m_Mutex};
-    m_CmdBuffers.emplace_back(CmdBuffer);
+    if (!m_ReturnedCmdBuffers.TryPush(std::move(CmdBuffer)))
+    {
+        // The queue is full, which may only happen if the owning context has not requested
+        // command buffers for a long time.
+        std::lock_guard<Threading::EngineMutex> Lock{m_OverflowMtx};
+        m_OverflowCmdBuffers.push_back(CmdBuffer);
+        m_HasOverflowCmdBuffers.store(true, std::memory_order_release);
+    }
     CmdBuffer = VK_NULL_HANDLE;
 #ifdef DILIGENT_DEVELOPMENT
     --m_BuffCounter;
@@ -466,6 +466,11 @@ void SetAccelStructName(VkDevice device, VkAccelerationStructureKHR accelStruct,
     SetObjectName(device, (uint64_t)accelStruct, VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR, name);
 }
 
+void SetDescriptorUpdateTemplateName(VkDevice device, VkDescriptorUpdateTemplate updateTemplate, const char* name)
+{
+    SetObjectName(device, (uint64_t)updateTemplate, VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE, name);
+}
+
 void SetPipelineCacheName(VkDevice device, VkPipelineCache pipeCache, const char* name)
 {
     SetObjectName(device, (uint64_t)pipeCache, VK_OBJECT_TYPE_PIPELINE_CACHE, name);
@@ -610,6 +615,12 @@ void SetVulkanObjectName<VkPipelineCache, VulkanHandleTypeId::PipelineCache>(VkD
     SetPipelineCacheName(device, pipeCache, name);
 }
 
+template <>
+void SetVulkanObjectName<VkDescriptorUpdateTemplate, VulkanHandleTypeId::DescriptorUpdateTemplate>(VkDevice device, VkDescriptorUpdateTemplate updateTemplate, const char* name)
+{
+    SetDescriptorUpdateTemplateName(device, updateTemplate, name);
+}
+
 
 const char* VkResultToString(VkResult errorCode)
 {
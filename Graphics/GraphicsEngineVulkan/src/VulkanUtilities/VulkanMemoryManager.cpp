@@ -40,37 +40,60 @@ VulkanMemoryAllocation::~VulkanMemoryAllocation()
     }
 }
 
-VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager&  ParentMemoryMgr,
-                                   VkDeviceSize          PageSize,
-                                   uint32_t              MemoryTypeIndex,
-                                   bool                  IsHostVisible,
-                                   VkMemoryAllocateFlags AllocateFlags) :
+VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager&                 ParentMemoryMgr,
+                                   VkDeviceSize                         PageSize,
+                                   uint32_t                             MemoryTypeIndex,
+                                   bool                                 IsHostVisible,
+                                   VkMemoryAllocateFlags                AllocateFlags,
+                                   const VulkanDedicatedAllocationInfo* pDedicatedInfo) :
     // clang-format off
     m_ParentMemoryMgr{ParentMemoryMgr},
-    m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator}
+    m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator},
+    m_IsDedicated    {pDedicatedInfo != nullptr}
 // clang-format on
 {
     VERIFY(PageSize <= std::numeric_limits<AllocationsMgrOffsetType>::max(),
            "PageSize (", PageSize, ") exceeds maximum allowed value ",
            std::numeric_limits<AllocationsMgrOffsetType>::max());
 
-    VkMemoryAllocateInfo      MemAlloc    = {};
-    VkMemoryAllocateFlagsInfo MemFlagInfo = {};
+    VkMemoryAllocateInfo          MemAlloc      = {};
+    VkMemoryAllocateFlagsInfo     MemFlagInfo   = {};
+    VkMemoryDedicatedAllocateInfo DedicatedInfo = {};
 
     MemAlloc.pNext           = nullptr;
     MemAlloc.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
     MemAlloc.allocationSize  = PageSize;
     MemAlloc.memoryTypeIndex = MemoryTypeIndex;
 
+    const void** NextInfo = &MemAlloc.pNext;
     if (AllocateFlags)
     {
-        MemAlloc.pNext    = &MemFlagInfo;
         MemFlagInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
         MemFlagInfo.pNext = nullptr;
         MemFlagInfo.flags = AllocateFlags;
+
+        *NextInfo = &MemFlagInfo;
+        NextInfo  = &MemFlagInfo.pNext;
+    }
+
+    if (pDedicatedInfo != nullptr &&
+        (pDedicatedInfo->vkBuffer != VK_NULL_HANDLE || pDedicatedInfo->vkImage != VK_NULL_HANDLE) &&
+        ParentMemoryMgr.m_LogicalDevice.GetEnabledExtFeatures().DedicatedAllocation)
+    {
+        VERIFY(pDedicatedInfo->vkBuffer == VK_NULL_HANDLE || pDedicatedInfo->vkImage == VK_NULL_HANDLE,
+               "Dedicated allocation can't be made for both a buffer and an image");
+
+        DedicatedInfo.sType  = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+        DedicatedInfo.pNext  = nullptr;
+        DedicatedInfo.buffer = pDedicatedInfo->vkBuffer;
+        DedicatedInfo.image  = pDedicatedInfo->vkImage;
+
+        *NextInfo = &DedicatedInfo;
+        NextInfo  = &DedicatedInfo.pNext;
     }
 
-    auto MemoryName = Diligent::FormatString("Device memory page. Size: ", Diligent::FormatMemorySize(PageSize, 2), ", type: ", MemoryTypeIndex);
+    auto MemoryName = Diligent::FormatString(m_IsDedicated ? "Dedicated device memory. Size: " : "Device memory page. Size: ",
+                                             Diligent::FormatMemorySize(PageSize, 2), ", type: ", MemoryTypeIndex);
     m_VkMemory      = ParentMemoryMgr.m_LogicalDevice.AllocateDeviceMemory(MemAlloc, MemoryName.c_str());
 
     if (IsHostVisible)
@@ -119,14 +142,23 @@ VulkanMemoryAllocation VulkanMemoryPage::Allocate(VkDeviceSize size, VkDeviceSiz
 void VulkanMemoryPage::Free(VulkanMemoryAllocation&& Allocation)
 {
     m_ParentMemoryMgr.OnFreeAllocation(Allocation.Size, m_CPUMemory != nullptr);
-    std::lock_guard<std::mutex> Lock{m_Mutex};
-    VERIFY_EXPR(Allocation.UnalignedOffset <= std::numeric_limits<AllocationsMgrOffsetType>::max());
-    VERIFY_EXPR(Allocation.Size <= std::numeric_limits<AllocationsMgrOffsetType>::max());
-    m_AllocationMgr.Free(static_cast<AllocationsMgrOffsetType>(Allocation.UnalignedOffset), static_cast<AllocationsMgrOffsetType>(Allocation.Size));
-    Allocation = VulkanMemoryAllocation{};
+    {
+        std::lock_guard<std::mutex> Lock{m_Mutex};
+        VERIFY_EXPR(Allocation.UnalignedOffset <= std::numeric_limits<AllocationsMgrOffsetType>::max());
+        VERIFY_EXPR(Allocation.Size <= std::numeric_limits<AllocationsMgrOffsetType>::max());
+        m_AllocationMgr.Free(static_cast<AllocationsMgrOffsetType>(Allocation.UnalignedOffset), static_cast<AllocationsMgrOffsetType>(Allocation.Size));
+        Allocation = VulkanMemoryAllocation{};
+    }
+
+    if (m_IsDedicated)
+    {
+        VERIFY_EXPR(IsEmpty());
+        // The page is destroyed by this call, so no members must be accessed after it.
+        m_ParentMemoryMgr.OnDedicatedPageReleased(*this);
+    }
 }
 
-VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags)
+VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags, const VulkanDedicatedAllocationInfo* pDedicatedInfo)
 {
     // memoryTypeBits is a bitmask and contains one bit set for every supported memory type for the resource.
     // Bit i is set if the memory type i in the VkPhysicalDeviceMemoryProperties structure for the
@@ -155,13 +187,46 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements&
     }
 
     bool HostVisible = (MemoryProps & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
-    return Allocate(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, HostVisible, AllocateFlags);
+    return Allocate(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, HostVisible, AllocateFlags, pDedicatedInfo);
 }
 
-VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags)
+VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags, const VulkanDedicatedAllocationInfo* pDedicatedInfo)
 {
     VulkanMemoryAllocation Allocation;
 
+    const auto   PageSize = HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
+    const size_t stat_ind = HostVisible ? 1 : 0;
+
+    // Large allocations are not suballocated as they would either leave most of a page unused
+    // or require a page that is much larger than the resource.
+    if (Size > PageSize / 2 || (pDedicatedInfo != nullptr && pDedicatedInfo->Preferred))
+    {
+        const VulkanDedicatedAllocationInfo NoResource;
+
+        // Device memory is allocated outside of the lock as dedicated pages are never shared
+        VulkanMemoryPage NewPage{*this, Size, MemoryTypeIndex, HostVisible, AllocateFlags, pDedicatedInfo != nullptr ? pDedicatedInfo : &NoResource};
+
+        std::lock_guard<std::mutex> Lock{m_PagesMtx};
+
+        auto vkMemory = NewPage.GetVkMemory();
+        auto it       = m_DedicatedPages.emplace(vkMemory, std::move(NewPage)).first;
+
+        m_CurrAllocatedSize[stat_ind] += Size;
+        m_PeakAllocatedSize[stat_ind] = std::max(m_PeakAllocatedSize[stat_ind], m_CurrAllocatedSize[stat_ind]);
+
+        OnNewPageCreated(it->second);
+        Allocation = it->second.Allocate(Size, 1);
+        DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate dedicated memory");
+        // The memory object is allocated with the exact size, so its start is aligned to any
+        // alignment the resource may require.
+        VERIFY_EXPR(Allocation.UnalignedOffset == 0);
+
+        m_CurrUsedSize[stat_ind].fetch_add(Allocation.Size);
+        m_PeakUsedSize[stat_ind] = std::max(m_PeakUsedSize[stat_ind], static_cast<VkDeviceSize>(m_CurrUsedSize[stat_ind].load()));
+
+        return Allocation;
+    }
+
     // On integrated GPUs, there is no difference between host-visible and GPU-only
     // memory, so MemoryTypeIndex is the same. As GPU-only pages do not have CPU address,
     // we need to use HostVisible flag to differentiate the two.
@@ -169,24 +234,37 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
     // even though on integrated GPUs same pages can be used for both GPU-only and staging
     // allocations. Staging allocations are short-living and will be released when upload is
     // complete, while GPU-only allocations are expected to be long-living.
-    MemoryPageIndex             PageIdx{MemoryTypeIndex, HostVisible, AllocateFlags};
+    // Small allocations are kept in separate pages so that they do not fragment pages
+    // used by larger resources.
+    const bool                  IsSmall = Size <= PageSize / SmallAllocationPageSizeRatio;
+    MemoryPageIndex             PageIdx{MemoryTypeIndex, HostVisible, AllocateFlags, IsSmall};
     std::lock_guard<std::mutex> Lock{m_PagesMtx};
 
+    // Empty pages are only used when no other page has enough space, so that they
+    // can be released by ShrinkMemory() instead of being kept alive by new allocations.
+    VulkanMemoryPage* pEmptyPage = nullptr;
+
     auto range = m_Pages.equal_range(PageIdx);
     for (auto page_it = range.first; page_it != range.second; ++page_it)
     {
-        Allocation = page_it->second.Allocate(Size, Alignment);
+        auto& Page = page_it->second;
+        if (Page.IsEmpty())
+        {
+            if (pEmptyPage == nullptr)
+                pEmptyPage = &Page;
+            continue;
+        }
+
+        Allocation = Page.Allocate(Size, Alignment);
         if (Allocation.Page != nullptr)
             break;
     }
 
-    size_t stat_ind = HostVisible ? 1 : 0;
+    if (Allocation.Page == nullptr && pEmptyPage != nullptr)
+        Allocation = pEmptyPage->Allocate(Size, Alignment);
+
     if (Allocation.Page == nullptr)
     {
-        auto PageSize = HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
-        while (PageSize < Size)
-            PageSize *= 2;
-
         m_CurrAllocatedSize[stat_ind] += PageSize;
         m_PeakAllocatedSize[stat_ind] = std::max(m_PeakAllocatedSize[stat_ind], m_CurrAllocatedSize[stat_ind]);
 
@@ -216,16 +294,22 @@ void VulkanMemoryManager::ShrinkMemory()
     if (m_CurrAllocatedSize[0] <= m_DeviceLocalReserveSize && m_CurrAllocatedSize[1] <= m_HostVisibleReserveSize)
         return;
 
+    // Releasing many pages at once may cause a noticeable stall, so at most one page
+    // of each kind is released per call.
+    std::array<bool, 2> PageReleased = {};
+
     auto it = m_Pages.begin();
-    while (it != m_Pages.end())
+    while (it != m_Pages.end() && !(PageReleased[0] && PageReleased[1]))
     {
         auto curr_it = it;
         ++it;
         auto& Page          = curr_it->second;
         bool  IsHostVisible = Page.GetCPUMemory() != nullptr;
         auto  ReserveSize   = IsHostVisible ? m_HostVisibleReserveSize : m_DeviceLocalReserveSize;
-        if (Page.IsEmpty() && m_CurrAllocatedSize[IsHostVisible ? 1 : 0] > ReserveSize)
+        if (!PageReleased[IsHostVisible ? 1 : 0] && Page.IsEmpty() && m_CurrAllocatedSize[IsHostVisible ? 1 : 0] > ReserveSize)
         {
+            PageReleased[IsHostVisible ? 1 : 0] = true;
+
             auto PageSize = Page.GetPageSize();
             m_CurrAllocatedSize[IsHostVisible ? 1 : 0] -= PageSize;
             LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': destroying ", (IsHostVisible ? "host-visible" : "device-local"),
@@ -238,6 +322,27 @@ void VulkanMemoryManager::ShrinkMemory()
     }
 }
 
+void VulkanMemoryManager::OnDedicatedPageReleased(VulkanMemoryPage& Page)
+{
+    VERIFY_EXPR(Page.IsDedicated() && Page.IsEmpty());
+
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+
+    auto it = m_DedicatedPages.find(Page.GetVkMemory());
+    if (it == m_DedicatedPages.end())
+    {
+        UNEXPECTED("Dedicated page is not found in the map");
+        return;
+    }
+    VERIFY_EXPR(&it->second == &Page);
+
+    const size_t stat_ind = Page.GetCPUMemory() != nullptr ? 1 : 0;
+    m_CurrAllocatedSize[stat_ind] -= Page.GetPageSize();
+
+    OnPageDestroy(Page);
+    m_DedicatedPages.erase(it);
+}
+
 void VulkanMemoryManager::OnFreeAllocation(VkDeviceSize Size, bool IsHostVisible)
 {
     m_CurrUsedSize[IsHostVisible ? 1 : 0].fetch_add(-static_cast<int64_t>(Size));
@@ -259,6 +364,7 @@ VulkanMemoryManager::~VulkanMemoryManager()
 
     for (auto it = m_Pages.begin(); it != m_Pages.end(); ++it)
         VERIFY(it->second.IsEmpty(), "The page contains outstanding allocations");
+    VERIFY(m_DedicatedPages.empty(), "Not all dedicated allocations have been released");
     VERIFY(m_CurrUsedSize[0] == 0 && m_CurrUsedSize[1] == 0, "Not all allocations have been released");
 }
 
@@ -305,11 +305,99 @@ VulkanPhysicalDevice::VulkanPhysicalDevice(const CreateInfo& CI) :
             m_ExtFeatures.HostQueryReset.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_QUERY_RESET_FEATURES;
         }
 
+        if (IsExtensionSupported(VK_EXT_PIPELINE_CREATION_CACHE_CONTROL_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.PipelineCreationCacheControl;
+            NextFeat  = &m_ExtFeatures.PipelineCreationCacheControl.pNext;
+
+            m_ExtFeatures.PipelineCreationCacheControl.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_CREATION_CACHE_CONTROL_FEATURES_EXT;
+        }
+
         if (IsExtensionSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME))
         {
             m_ExtFeatures.DrawIndirectCount = true;
         }
 
+        if (IsExtensionSupported(VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME) &&
+            IsExtensionSupported(VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME))
+        {
+            m_ExtFeatures.DedicatedAllocation = true;
+        }
+
+        if (IsExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME))
+        {
+            m_ExtFeatures.MemoryBudget = true;
+        }
+
+        if (IsExtensionSupported(VK_EXT_MULTI_DRAW_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.MultiDraw;
+            NextFeat  = &m_ExtFeatures.MultiDraw.pNext;
+
+            m_ExtFeatures.MultiDraw.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTI_DRAW_FEATURES_EXT;
+
+            *NextProp = &m_ExtProperties.MultiDraw;
+            NextProp  = &m_ExtProperties.MultiDraw.pNext;
+
+            m_ExtProperties.MultiDraw.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTI_DRAW_PROPERTIES_EXT;
+        }
+
+        if (IsExtensionSupported(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME) &&
+            IsExtensionSupported(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.GraphicsPipelineLibrary;
+            NextFeat  = &m_ExtFeatures.GraphicsPipelineLibrary.pNext;
+
+            m_ExtFeatures.GraphicsPipelineLibrary.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+
+            *NextProp = &m_ExtProperties.GraphicsPipelineLibrary;
+            NextProp  = &m_ExtProperties.GraphicsPipelineLibrary.pNext;
+
+            m_ExtProperties.GraphicsPipelineLibrary.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT;
+        }
+
+        // Dynamic rendering depends on VK_KHR_depth_stencil_resolve and VK_KHR_create_renderpass2
+        // that are part of the Vulkan 1.2 core.
+        if (m_VkVersion >= VK_API_VERSION_1_2 && IsExtensionSupported(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.DynamicRendering;
+            NextFeat  = &m_ExtFeatures.DynamicRendering.pNext;
+
+            m_ExtFeatures.DynamicRendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+        }
+
+        if (IsExtensionSupported(VK_KHR_PRESENT_ID_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.PresentId;
+            NextFeat  = &m_ExtFeatures.PresentId.pNext;
+
+            m_ExtFeatures.PresentId.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+
+            if (IsExtensionSupported(VK_KHR_PRESENT_WAIT_EXTENSION_NAME))
+            {
+                *NextFeat = &m_ExtFeatures.PresentWait;
+                NextFeat  = &m_ExtFeatures.PresentWait.pNext;
+
+                m_ExtFeatures.PresentWait.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+            }
+        }
+
+        if (IsExtensionSupported(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.ConditionalRendering;
+            NextFeat  = &m_ExtFeatures.ConditionalRendering.pNext;
+
+            m_ExtFeatures.ConditionalRendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONDITIONAL_RENDERING_FEATURES_EXT;
+        }
+
+        if (IsExtensionSupported(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.ExtendedDynamicState;
+            NextFeat  = &m_ExtFeatures.ExtendedDynamicState.pNext;
+
+            m_ExtFeatures.ExtendedDynamicState.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+        }
+
         if (IsExtensionSupported(VK_KHR_MAINTENANCE3_EXTENSION_NAME))
         {
             *NextProp = &m_ExtProperties.Maintenance3;
@@ -498,4 +586,17 @@ VkFormatProperties VulkanPhysicalDevice::GetPhysicalDeviceFormatProperties(VkFor
     return formatProperties;
 }
 
+VkPhysicalDeviceMemoryBudgetPropertiesEXT VulkanPhysicalDevice::GetMemoryBudget() const
+{
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT MemoryBudget{};
+    MemoryBudget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+    VkPhysicalDeviceMemoryProperties2 MemoryProps2{};
+    MemoryProps2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    MemoryProps2.pNext = &MemoryBudget;
+
+    vkGetPhysicalDeviceMemoryProperties2KHR(m_VkDevice, &MemoryProps2);
+    return MemoryBudget;
+}
+
 } // namespace VulkanUtilities
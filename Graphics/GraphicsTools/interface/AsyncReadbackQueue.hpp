@@ -0,0 +1,183 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::AsyncReadbackQueue class
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.hpp"
+#include "GPUCompletionAwaitQueue.hpp"
+
+namespace Diligent
+{
+
+/// Helper class that asynchronously reads buffer and texture data back to the CPU.
+
+/// Every readback copies the source data into a staging resource that is taken from
+/// an internal pool, so that steady-state readbacks do not create GPU resources.
+/// When the GPU is done with the copy, the staging resource is mapped and the data
+/// is delivered to the user callback. Readbacks issued in consecutive frames are
+/// pipelined: the application never waits for the GPU unless it calls Flush().
+///
+/// \remarks All methods must be called from the thread that owns the device context,
+///          and all readbacks must be issued through the same immediate context.
+///
+///          If a thread pool is provided, callbacks are executed by the thread pool
+///          workers while the staging resource remains mapped. Otherwise, callbacks
+///          are executed by the thread that calls Process().
+///
+///          Readbacks become available only after the context is flushed, see IDeviceContext::Flush().
+class AsyncReadbackQueue
+{
+public:
+    /// Readback data passed to the callback.
+    struct ReadbackData
+    {
+        /// Pointer to the data. The pointer is only valid while the callback is executed.
+        const void* pData = nullptr;
+
+        /// Data size, in bytes.
+        Uint64 Size = 0;
+
+        /// For textures, row and depth slice strides of the data, in bytes.
+        Uint64 Stride      = 0;
+        Uint64 DepthStride = 0;
+
+        /// For textures, the region that was read back.
+        Box Region;
+    };
+
+    /// Function that is called when the data is available.
+    using CallbackType = std::function<void(const ReadbackData& Data)>;
+
+    struct CreateInfo
+    {
+        IRenderDevice* pDevice = nullptr;
+
+        /// Thread pool that executes callbacks.
+        /// If null, callbacks are executed by the thread that calls Process().
+        IThreadPool* pThreadPool = nullptr;
+
+        /// The maximum number of staging resources that are kept in the pool for reuse.
+        Uint32 MaxPooledResources = 32;
+    };
+
+    explicit AsyncReadbackQueue(const CreateInfo& CI) noexcept(false);
+
+    /// Waits until all running callbacks are finished.
+    /// Callbacks of readbacks that have not been processed are not called.
+    ~AsyncReadbackQueue();
+
+    // clang-format off
+    AsyncReadbackQueue           (const AsyncReadbackQueue&) = delete;
+    AsyncReadbackQueue& operator=(const AsyncReadbackQueue&) = delete;
+    AsyncReadbackQueue           (AsyncReadbackQueue&&)      = delete;
+    AsyncReadbackQueue& operator=(AsyncReadbackQueue&&)      = delete;
+    // clang-format on
+
+    /// Records a copy of Size bytes starting at Offset from the source buffer into a staging buffer.
+
+    /// \return     true if the readback was enqueued, and false otherwise.
+    ///
+    /// \remarks    The source buffer is transitioned to RESOURCE_STATE_COPY_SOURCE state.
+    bool ReadBuffer(IDeviceContext* pContext,
+                    IBuffer*        pSrcBuffer,
+                    Uint64          Offset,
+                    Uint64          Size,
+                    CallbackType    Callback);
+
+    /// Records a copy of the texture subresource region into a staging texture.
+
+    /// \param [in] pRegion - Region to read back. If null, the entire subresource is read.
+    ///
+    /// \return     true if the readback was enqueued, and false otherwise.
+    ///
+    /// \remarks    The source texture is transitioned to RESOURCE_STATE_COPY_SOURCE state.
+    bool ReadTexture(IDeviceContext* pContext,
+                     ITexture*       pSrcTexture,
+                     Uint32          MipLevel,
+                     Uint32          Slice,
+                     const Box*      pRegion,
+                     CallbackType    Callback);
+
+    /// Delivers the data of the readbacks completed by the GPU to the callbacks, and returns
+    /// the staging resources of the readbacks whose callbacks have finished to the pool.
+
+    /// \remarks    This method is typically called once per frame.
+    void Process(IDeviceContext* pContext);
+
+    /// Flushes the context, waits for the GPU to complete all readbacks, and waits
+    /// until all callbacks are finished.
+    void Flush(IDeviceContext* pContext);
+
+    /// Returns the number of readbacks whose callbacks have not finished yet.
+    size_t GetNumPendingReadbacks() const { return m_NumPendingReadbacks; }
+
+    /// Returns the number of staging resources in the pool.
+    size_t GetNumPooledResources() const { return m_StagingBuffers.size() + m_StagingTextures.size(); }
+
+private:
+    struct Readback;
+
+    std::unique_ptr<Readback> CreateReadback(CallbackType&& Callback);
+
+    bool MapReadback(IDeviceContext* pContext, Readback& RB);
+    void DispatchReadback(IDeviceContext* pContext, std::unique_ptr<Readback>&& pRB);
+    void RetireReadback(IDeviceContext* pContext, std::unique_ptr<Readback>&& pRB);
+    void RetireFinishedReadbacks(IDeviceContext* pContext, bool WaitForCallbacks);
+
+    RefCntAutoPtr<IBuffer>  GetStagingBuffer(Uint64 Size);
+    RefCntAutoPtr<ITexture> GetStagingTexture(const TextureDesc& Desc);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    RefCntAutoPtr<IThreadPool>   m_pThreadPool;
+
+    const Uint32 m_MaxPooledResources;
+
+    // Readbacks whose copies have been recorded, in submission order.
+    GPUCompletionAwaitQueue<std::unique_ptr<Readback>> m_AwaitQueue;
+
+    // Readbacks whose staging resources are mapped and whose callbacks are running.
+    std::deque<std::unique_ptr<Readback>> m_MappedReadbacks;
+
+    std::vector<RefCntAutoPtr<IBuffer>>  m_StagingBuffers;
+    std::vector<RefCntAutoPtr<ITexture>> m_StagingTextures;
+
+    size_t m_NumPendingReadbacks = 0;
+};
+
+} // namespace Diligent
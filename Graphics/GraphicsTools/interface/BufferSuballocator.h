@@ -84,6 +84,14 @@ struct BufferSuballocatorUsageStats
     /// The size of the internal buffer, in bytes.
     Uint64 Size = 0;
 
+    /// The amount of memory committed for the internal buffer, in bytes.
+
+    /// \remarks   For sparse buffers, this is the size of the committed memory pages.
+    ///            For other buffers, this is the size of the internal buffer plus
+    ///            the size of the previous buffer while its contents is being copied.
+    ///            The value is updated by IBufferSuballocator::GetBuffer().
+    Uint64 CommittedSize = 0;
+
     /// The total used size, in bytes.
     Uint64 UsedSize = 0;
 
@@ -94,6 +102,41 @@ struct BufferSuballocatorUsageStats
     Uint32 AllocationCount = 0;
 };
 
+/// Callback that is called by IBufferSuballocator::Defragment() for every moved suballocation.
+
+/// \param [in] pSuballocation - Suballocation that has been moved. IBufferSuballocation::GetOffset()
+///                              returns the new offset.
+/// \param [in] OldOffset      - The previous offset of the suballocation.
+/// \param [in] pUserData      - User data pointer, see BufferSuballocatorDefragmentAttribs::pCallbackUserData.
+///
+/// \remarks   The callback is called while the internal mutex is locked. It must not call any
+///            methods of the suballocator and must not add references to the suballocation,
+///            which may be in the process of being released.
+typedef void (*BufferSuballocationMovedCallbackType)(IBufferSuballocation* pSuballocation, Uint32 OldOffset, void* pUserData);
+
+/// Buffer suballocator defragmentation attributes.
+struct BufferSuballocatorDefragmentAttribs
+{
+    /// Render device that will be used to create the scratch buffer, if necessary.
+    IRenderDevice* pDevice = nullptr;
+
+    /// Device context that will be used to copy the data.
+    IDeviceContext* pContext = nullptr;
+
+    /// The maximum number of bytes to move.
+
+    /// If zero, all suballocations that can be moved closer to the
+    /// beginning of the buffer are moved. At least one suballocation
+    /// is always moved, if possible.
+    Uint64 MaxBytesToMove = 0;
+
+    /// Optional callback that is called for every moved suballocation.
+    BufferSuballocationMovedCallbackType MovedCallback = nullptr;
+
+    /// User data pointer that is passed to MovedCallback.
+    void* pCallbackUserData = nullptr;
+};
+
 /// Buffer suballocator.
 struct IBufferSuballocator : public IObject
 {
@@ -108,6 +151,11 @@ struct IBufferSuballocator : public IObject
     ///             be used to create a new buffer and copy existing contents to the new buffer.
     ///             The method is not thread-safe and an application must externally synchronize the
     ///             access.
+    ///
+    ///             pContext may be a transfer queue context if the buffer's ImmediateContextMask
+    ///             includes it. In this case, call GetBuffer() again with the context that uses
+    ///             the buffer, which will make it wait for the copy to complete
+    ///             (see Diligent::DynamicBuffer::Resize()).
     virtual IBuffer* GetBuffer(IRenderDevice* pDevice, IDeviceContext* pContext) = 0;
 
 
@@ -129,8 +177,26 @@ struct IBufferSuballocator : public IObject
 
 
     /// Returns internal buffer version. The version is incremented every time
-    /// the buffer is expanded.
+    /// the buffer is expanded or suballocations are moved by Defragment().
     virtual Uint32 GetVersion() const = 0;
+
+
+    /// Moves suballocations closer to the beginning of the buffer to reduce fragmentation.
+
+    /// \param[in] Attribs - Defragmentation attributes, see Diligent::BufferSuballocatorDefragmentAttribs.
+    ///
+    /// \return    The number of moved suballocations.
+    ///
+    /// \remarks   Defragmentation must be enabled by BufferSuballocatorCreateInfo::EnableDefragmentation.
+    ///            Suballocations are processed starting from the end of the buffer. Each one is
+    ///            moved to the lowest free block that fits it, through a scratch buffer, since
+    ///            copies within the same buffer are not supported by all backends.
+    ///
+    ///            After the method returns, the data of the moved suballocations is only available
+    ///            at their new offsets; an application must update all references to the old offsets
+    ///            (e.g. using the MovedCallback) before recording any commands that use them.
+    ///            The method must not be called concurrently with GetBuffer().
+    virtual Uint32 Defragment(const BufferSuballocatorDefragmentAttribs& Attribs) = 0;
 };
 
 /// Buffer suballocator create information.
@@ -158,6 +224,23 @@ struct BufferSuballocatorCreateInfo
 
     /// If Desc.Usage == USAGE_SPARSE, the virtual buffer size; ignored otherwise.
     Uint64 VirtualSize = 0;
+
+    /// Whether to shrink the buffer when the free space at its end becomes larger than
+    /// the expansion size.
+
+    /// \remarks   The buffer is shrunk by a multiple of the expansion size (or the initial
+    ///            buffer size if ExpansionSize is zero), and never below the initial size.
+    ///            The shrink is committed by the next call to IBufferSuballocator::GetBuffer().
+    ///            For sparse buffers, unused memory pages are decommitted. For other buffers,
+    ///            a smaller buffer is created and the contents is copied, so shrinking should
+    ///            only be enabled for these buffers if usage drops rarely.
+    bool ShrinkUnusedSpace = false;
+
+    /// Whether to allow IBufferSuballocator::Defragment().
+
+    /// \remarks   When enabled, the suballocator keeps track of all live suballocations,
+    ///            which adds a small overhead to every allocation and release.
+    bool EnableDefragmentation = false;
 };
 
 /// Creates a new buffer suballocator.
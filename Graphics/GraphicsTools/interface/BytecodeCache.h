@@ -35,6 +35,36 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 struct BytecodeCacheCreateInfo
 {
     enum RENDER_DEVICE_TYPE DeviceType DEFAULT_INITIALIZER(RENDER_DEVICE_TYPE_UNDEFINED);
+
+    /// Device API version, see Diligent::RenderDeviceInfo::APIVersion.
+
+    /// \remarks   The version is included in the byte code key. For OpenGL and GLES,
+    ///             it determines the GLSL version of the cached source.
+    Version DeviceAPIVersion;
+
+    /// Optional path to the file where the cache incrementally persists its contents.
+
+    /// \remarks   If the path is not null, the cache loads the byte code from the file
+    ///             when it is created, and appends new and removed entries to the file
+    ///             from a background thread. The file is compacted when the number
+    ///             of appended records reaches CompactionThreshold. If the application
+    ///             terminates unexpectedly, only the last few entries may be lost.
+    const Char* FilePath DEFAULT_INITIALIZER(nullptr);
+
+    /// An optional thread pool to write the file from.
+
+    /// \remarks   The pool must have at least one worker thread. If the pool is null,
+    ///             the cache creates its own pool with one worker thread.
+    ///             This member is ignored if FilePath is null.
+#if DILIGENT_CPP_INTERFACE
+    class IThreadPool*  pWriterThreadPool DEFAULT_INITIALIZER(nullptr);
+#else
+    struct IThreadPool* pWriterThreadPool;
+#endif
+
+    /// The number of records in the file that triggers compaction.
+    /// If zero, the file is never compacted. This member is ignored if FilePath is null.
+    Uint32 CompactionThreshold DEFAULT_INITIALIZER(64);
 };
 typedef struct BytecodeCacheCreateInfo BytecodeCacheCreateInfo;
 
@@ -74,6 +104,9 @@ DILIGENT_BEGIN_INTERFACE(IBytecodeCache, IObject)
                                      IDataBlob**                ppByteCode) PURE;
 
     /// Adds the byte code to the cache.
+    ///
+    /// \remarks    For OpenGL, the byte code is the full GLSL source returned by IShader::GetBytecode.
+    ///             It can be passed to ShaderCreateInfo::ByteCode to skip the HLSL-to-GLSL conversion.
 
     /// \param [in] ShaderCI  - Shader create parameters for the byte code to add.
     /// \param [in] pByteCode - A pointer to the byte code to add to the cache.
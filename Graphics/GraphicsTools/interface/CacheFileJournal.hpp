@@ -0,0 +1,155 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::CacheFileJournal class
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Primitives/interface/DataBlob.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.hpp"
+
+namespace Diligent
+{
+
+/// Append-only cache file that is written on a background thread.
+
+/// The file consists of a header followed by a sequence of records. Every record
+/// is protected by a hash, and the file is flushed after every record is appended,
+/// so that if the process terminates unexpectedly, at most the records that have
+/// not been written yet are lost. Records that fail validation when the
+/// file is loaded are discarded.
+///
+/// When the number of records reaches the compaction threshold, the records are merged
+/// into a single record that is written to a temporary file, which then replaces
+/// the original one.
+///
+/// \note   The durability is guaranteed against process crashes, but not against
+///         power loss, since the data are not synchronized with the storage device.
+class CacheFileJournal
+{
+public:
+    /// Callback that returns the data of the new record to append to the file,
+    /// or null if there are no pending data. Called from the background thread.
+    using ReadPendingDataCallbackType = std::function<RefCntAutoPtr<IDataBlob>()>;
+
+    /// Callback that merges the records into a single one. Called from the background thread.
+    using MergeRecordsCallbackType = std::function<RefCntAutoPtr<IDataBlob>(const std::vector<RefCntAutoPtr<IDataBlob>>& Records)>;
+
+    struct CreateInfo
+    {
+        /// Path to the cache file.
+        const char* FilePath = nullptr;
+
+        /// File magic number that identifies the type of the data.
+        Uint32 Magic = 0;
+
+        /// Data format version. If the version in the file does not match,
+        /// the contents of the file are discarded.
+        Uint32 Version = 0;
+
+        /// Thread pool to run the write tasks in. The pool must have worker threads.
+        /// If null, the journal creates its own pool with one worker thread.
+        IThreadPool* pThreadPool = nullptr;
+
+        /// The number of records in the file that triggers compaction.
+        /// If zero, the file is never compacted.
+        Uint32 CompactionThreshold = 64;
+
+        /// Optional callback that returns the pending data, see ReadPendingDataCallbackType.
+        ReadPendingDataCallbackType ReadPendingData;
+
+        /// Callback that merges the records, see MergeRecordsCallbackType.
+        /// Must not be null if CompactionThreshold is not zero.
+        MergeRecordsCallbackType MergeRecords;
+    };
+
+    explicit CacheFileJournal(const CreateInfo& CI) noexcept(false);
+    ~CacheFileJournal();
+
+    // clang-format off
+    CacheFileJournal           (const CacheFileJournal&)  = delete;
+    CacheFileJournal           (      CacheFileJournal&&) = delete;
+    CacheFileJournal& operator=(const CacheFileJournal&)  = delete;
+    CacheFileJournal& operator=(      CacheFileJournal&&) = delete;
+    // clang-format on
+
+    /// Reads all valid records from the file.
+
+    /// \remarks    If the file is corrupted or truncated, it is rewritten
+    ///             to only contain the valid records.
+    std::vector<RefCntAutoPtr<IDataBlob>> Load();
+
+    /// Queues the record to be appended to the file and requests the write.
+    void Append(IDataBlob* pData);
+
+    /// Requests the pending data to be written to the file on the background thread.
+
+    /// \remarks    Multiple requests made before the write task starts
+    ///             are coalesced into a single task.
+    void RequestWrite();
+
+    /// Waits until all requested writes are complete.
+    void WaitForIdle();
+
+    /// Waits for pending writes and discards all records in the file.
+    void Clear();
+
+private:
+    void ProcessWrites();
+    void AppendRecords(const std::vector<RefCntAutoPtr<IDataBlob>>& Records);
+    void Compact();
+
+private:
+    const std::string                 m_FilePath;
+    const std::string                 m_TmpFilePath;
+    const Uint32                      m_Magic;
+    const Uint32                      m_Version;
+    const Uint32                      m_CompactionThreshold;
+    const ReadPendingDataCallbackType m_ReadPendingData;
+    const MergeRecordsCallbackType    m_MergeRecords;
+
+    RefCntAutoPtr<IThreadPool> m_pThreadPool;
+
+    // Protects m_WriteRequested, m_PendingRecords and m_Tasks
+    std::mutex                             m_TaskMtx;
+    bool                                   m_WriteRequested = false;
+    std::vector<RefCntAutoPtr<IDataBlob>>  m_PendingRecords;
+    std::vector<RefCntAutoPtr<IAsyncTask>> m_Tasks;
+
+    // Protects the file and m_NumRecords
+    std::mutex m_FileMtx;
+    Uint32     m_NumRecords = 0;
+};
+
+} // namespace Diligent
@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::CommandListBatch class
+
+#include <mutex>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/CommandList.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Helper class that collects command lists recorded by multiple deferred contexts
+/// and executes them with a single IDeviceContext::ExecuteCommandLists() call.
+
+/// Every ExecuteCommandLists() call results in a separate queue submission with its own
+/// fence signal. When many contexts record the work of a frame (e.g. one context per pass
+/// and per thread), the application may add all command lists to the batch and execute them
+/// at once, so that the whole frame is submitted to the queue with one submission.
+///
+/// The command lists are executed in the order of their slots. A thread that records
+/// a command list reserves the slot in advance, typically when the work is dispatched,
+/// so that the order does not depend on which thread finishes first.
+///
+/// \remarks All methods are thread-safe.
+///
+///          Commands recorded by the immediate context are executed before all command lists
+///          of the batch. In particular, the resource state transitions required by all the
+///          command lists must be performed before Execute() is called.
+///
+///          IDeviceContext::FinishFrame() must not be called for the deferred contexts
+///          until the batch that contains their command lists has been executed.
+class CommandListBatch
+{
+public:
+    CommandListBatch() = default;
+
+    // clang-format off
+    CommandListBatch           (const CommandListBatch&) = delete;
+    CommandListBatch& operator=(const CommandListBatch&) = delete;
+    CommandListBatch           (CommandListBatch&&)      = delete;
+    CommandListBatch& operator=(CommandListBatch&&)      = delete;
+    // clang-format on
+
+    /// Reserves NumSlots consecutive slots at the end of the batch and returns the index of the first one.
+
+    /// \remarks   The slots are only valid until the batch is executed or cleared.
+    Uint32 ReserveSlots(Uint32 NumSlots);
+
+    /// Stores the command list in the slot that was previously reserved with ReserveSlots().
+    void SetCommandList(Uint32 Slot, ICommandList* pCmdList);
+
+    /// Appends the command list to the end of the batch.
+    void AddCommandList(ICommandList* pCmdList);
+
+    /// Executes all command lists of the batch in the order of their slots and clears the batch.
+
+    /// \param [in] pImmediateCtx - Immediate context to execute the command lists in.
+    ///
+    /// \return     The number of command lists that have been executed.
+    ///
+    /// \remarks    Reserved slots without a command list are skipped.
+    Uint32 Execute(IDeviceContext* pImmediateCtx);
+
+    /// Releases all command lists without executing them.
+    void Clear();
+
+    /// Returns the number of reserved slots.
+    Uint32 GetNumSlots() const;
+
+private:
+    mutable std::mutex m_Mtx;
+
+    std::vector<RefCntAutoPtr<ICommandList>> m_CmdLists;
+
+    // Keeps the array storage between the batches.
+    std::vector<ICommandList*> m_CmdListPtrs;
+};
+
+} // namespace Diligent
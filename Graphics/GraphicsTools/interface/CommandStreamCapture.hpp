@@ -0,0 +1,323 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::CommandStreamRecorder and Diligent::CommandStreamPlayer classes
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Call types recorded in a command stream.
+enum COMMAND_STREAM_CALL : Uint32
+{
+    // Device calls. The player executes them once, when the stream is loaded.
+    COMMAND_STREAM_CALL_CREATE_BUFFER = 0,
+    COMMAND_STREAM_CALL_CREATE_TEXTURE,
+    COMMAND_STREAM_CALL_CREATE_SAMPLER,
+    COMMAND_STREAM_CALL_CREATE_SHADER,
+    COMMAND_STREAM_CALL_CREATE_GRAPHICS_PIPELINE_STATE,
+    COMMAND_STREAM_CALL_CREATE_COMPUTE_PIPELINE_STATE,
+    COMMAND_STREAM_CALL_CREATE_SHADER_RESOURCE_BINDING,
+    COMMAND_STREAM_CALL_SET_STATIC_VARIABLE,
+
+    // Context calls. The player executes them every time the stream is replayed.
+    COMMAND_STREAM_CALL_SET_SHADER_VARIABLE,
+    COMMAND_STREAM_CALL_SET_PIPELINE_STATE,
+    COMMAND_STREAM_CALL_COMMIT_SHADER_RESOURCES,
+    COMMAND_STREAM_CALL_SET_VERTEX_BUFFERS,
+    COMMAND_STREAM_CALL_SET_INDEX_BUFFER,
+    COMMAND_STREAM_CALL_SET_VIEWPORTS,
+    COMMAND_STREAM_CALL_SET_SCISSOR_RECTS,
+    COMMAND_STREAM_CALL_SET_RENDER_TARGETS,
+    COMMAND_STREAM_CALL_SET_STENCIL_REF,
+    COMMAND_STREAM_CALL_SET_BLEND_FACTORS,
+    COMMAND_STREAM_CALL_CLEAR_RENDER_TARGET,
+    COMMAND_STREAM_CALL_CLEAR_DEPTH_STENCIL,
+    COMMAND_STREAM_CALL_UPDATE_BUFFER,
+    COMMAND_STREAM_CALL_MAP_BUFFER,
+    COMMAND_STREAM_CALL_DRAW,
+    COMMAND_STREAM_CALL_DRAW_INDEXED,
+    COMMAND_STREAM_CALL_DISPATCH_COMPUTE,
+    COMMAND_STREAM_CALL_FLUSH,
+    COMMAND_STREAM_CALL_FINISH_FRAME,
+
+    COMMAND_STREAM_CALL_COUNT
+};
+
+/// Returns the literal name of the command stream call, e.g. "DrawIndexed".
+const char* GetCommandStreamCallName(COMMAND_STREAM_CALL Call);
+
+
+/// Helper class that forwards render device and device context calls to the engine
+/// and serializes them, together with the resource initial data, into a compact command stream.
+
+/// The application calls the methods of the recorder instead of the corresponding methods
+/// of IRenderDevice, IDeviceContext, IPipelineState and IShaderResourceBinding for the
+/// frames it wants to capture. The stream can then be saved to a file and played back on
+/// any backend with CommandStreamPlayer to measure the CPU cost of the engine.
+///
+/// Objects are referenced by the order they were created by the recorder. Texture and buffer
+/// views must be the default views of the recorded resources. Render target and depth-stencil
+/// views of other textures (e.g. swap chain buffers) are recorded as external views that
+/// the player substitutes with the views provided in CommandStreamPlayer::CreateInfo.
+///
+/// \remarks All methods must be called from the same thread.
+///
+///          Shaders must be created from source or byte code; shaders loaded from files and
+///          pipelines that use explicit resource signatures or render passes are created,
+///          but not recorded.
+///
+///          When a recorded buffer is mapped for writing, MapBuffer() returns a pointer to
+///          the CPU copy of the buffer that the recorder keeps. UnmapBuffer() copies the whole
+///          buffer to the mapped memory and records it.
+class CommandStreamRecorder
+{
+public:
+    struct CreateInfo
+    {
+        IRenderDevice* pDevice = nullptr;
+
+        /// Context whose commands are recorded.
+        IDeviceContext* pContext = nullptr;
+    };
+
+    explicit CommandStreamRecorder(const CreateInfo& CI) noexcept(false);
+
+    ~CommandStreamRecorder();
+
+    // clang-format off
+    CommandStreamRecorder           (const CommandStreamRecorder&) = delete;
+    CommandStreamRecorder& operator=(const CommandStreamRecorder&) = delete;
+    CommandStreamRecorder           (CommandStreamRecorder&&)      = delete;
+    CommandStreamRecorder& operator=(CommandStreamRecorder&&)      = delete;
+    // clang-format on
+
+    // Device calls, see IRenderDevice.
+    void CreateBuffer(const BufferDesc& BuffDesc, const BufferData* pBuffData, IBuffer** ppBuffer);
+    void CreateTexture(const TextureDesc& TexDesc, const TextureData* pData, ITexture** ppTexture);
+    void CreateSampler(const SamplerDesc& SamDesc, ISampler** ppSampler);
+    void CreateShader(const ShaderCreateInfo& ShaderCI, IShader** ppShader);
+    void CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState);
+    void CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState);
+
+    /// See IPipelineState::CreateShaderResourceBinding.
+    void CreateShaderResourceBinding(IPipelineState* pPSO, IShaderResourceBinding** ppSRB, bool InitStaticResources = false);
+
+    /// Binds the object to the static variable of the pipeline state, see IPipelineState::GetStaticVariableByName.
+    void SetStaticVariable(IPipelineState* pPSO, SHADER_TYPE ShaderType, const char* Name, IDeviceObject* pObject);
+
+    /// Binds the object to the variable of the shader resource binding, see IShaderResourceBinding::GetVariableByName.
+    void SetShaderVariable(IShaderResourceBinding* pSRB, SHADER_TYPE ShaderType, const char* Name, IDeviceObject* pObject);
+
+    // Context calls, see IDeviceContext.
+    void SetPipelineState(IPipelineState* pPipelineState);
+    void CommitShaderResources(IShaderResourceBinding* pSRB, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+    void SetVertexBuffers(Uint32                         StartSlot,
+                          Uint32                         NumBuffersSet,
+                          IBuffer**                      ppBuffers,
+                          const Uint64*                  pOffsets,
+                          RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                          SET_VERTEX_BUFFERS_FLAGS       Flags = SET_VERTEX_BUFFERS_FLAG_NONE);
+    void SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+    void SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight);
+    void SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight);
+    void SetRenderTargets(Uint32                         NumRenderTargets,
+                          ITextureView*                  ppRenderTargets[],
+                          ITextureView*                  pDepthStencil,
+                          RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+    void SetStencilRef(Uint32 StencilRef);
+    void SetBlendFactors(const float* pBlendFactors = nullptr);
+    void ClearRenderTarget(ITextureView* pView, const float* RGBA, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+    void ClearDepthStencil(ITextureView*                  pView,
+                           CLEAR_DEPTH_STENCIL_FLAGS      ClearFlags,
+                           float                          fDepth,
+                           Uint8                          Stencil,
+                           RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+    void UpdateBuffer(IBuffer* pBuffer, Uint64 Offset, Uint64 Size, const void* pData, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+    void MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData);
+    void UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType);
+    void Draw(const DrawAttribs& Attribs);
+    void DrawIndexed(const DrawIndexedAttribs& Attribs);
+    void DispatchCompute(const DispatchComputeAttribs& Attribs);
+    void Flush();
+    void FinishFrame();
+
+    /// Returns the recorded command stream.
+    const std::vector<Uint8>& GetData() const { return m_Data; }
+
+    /// Writes the recorded command stream to the file.
+    bool SaveToFile(const char* FilePath) const;
+
+    /// Returns the number of recorded commands.
+    size_t GetNumCommands() const { return m_NumCommands; }
+
+private:
+    template <typename HandlerType>
+    void Record(COMMAND_STREAM_CALL Call, const HandlerType& Handler);
+
+    void AddObject(IObject* pObject);
+
+    // Returns the identifier of the recorded object and the type of the default view, if the object is a view.
+    void GetObjectRef(IObject* pObject, Uint32& Id, Uint32& ViewType) const;
+
+private:
+    RefCntAutoPtr<IRenderDevice>  m_pDevice;
+    RefCntAutoPtr<IDeviceContext> m_pContext;
+
+    std::vector<Uint8> m_Data;
+    size_t             m_NumCommands = 0;
+
+    // Recorded objects are kept alive so that their addresses can't be reused by other objects.
+    std::vector<RefCntAutoPtr<IObject>>        m_Objects;
+    std::unordered_map<const IObject*, Uint32> m_ObjectIds;
+
+    struct MappedBufferInfo
+    {
+        // Memory returned by IDeviceContext::MapBuffer
+        PVoid     pData    = nullptr;
+        MAP_FLAGS MapFlags = MAP_FLAG_NONE;
+    };
+    // Buffers mapped for writing.
+    std::unordered_map<const IBuffer*, MappedBufferInfo> m_MappedBuffers;
+
+    // CPU copies of the buffers mapped for writing. The mapped memory may be write-only,
+    // so the data are written to the copy first.
+    std::unordered_map<const IBuffer*, std::vector<Uint8>> m_ShadowData;
+};
+
+
+/// Helper class that plays back a command stream recorded by CommandStreamRecorder
+/// and measures the CPU time spent in every call type.
+
+/// Load() parses the stream and executes the device calls, which create all resources.
+/// Replay() executes the context calls and may be called any number of times, e.g. to
+/// benchmark the frames of the stream.
+class CommandStreamPlayer
+{
+public:
+    struct CreateInfo
+    {
+        IRenderDevice* pDevice = nullptr;
+
+        /// Context that executes the commands.
+        IDeviceContext* pContext = nullptr;
+
+        /// Render target view that replaces the render target views that were not
+        /// created by the recorder, e.g. the swap chain back buffer.
+        ITextureView* pExternalRTV = nullptr;
+
+        /// Depth-stencil view that replaces the depth-stencil views that were not
+        /// created by the recorder.
+        ITextureView* pExternalDSV = nullptr;
+    };
+
+    struct CallStats
+    {
+        /// The number of executed calls.
+        Uint32 NumCalls = 0;
+
+        /// The total CPU time spent in the calls, in seconds.
+        double Time = 0;
+    };
+
+    struct Stats
+    {
+        std::array<CallStats, COMMAND_STREAM_CALL_COUNT> Calls = {};
+
+        /// The number of executed FinishFrame() calls.
+        Uint32 NumFrames = 0;
+    };
+
+    explicit CommandStreamPlayer(const CreateInfo& CI) noexcept(false);
+
+    ~CommandStreamPlayer();
+
+    // clang-format off
+    CommandStreamPlayer           (const CommandStreamPlayer&) = delete;
+    CommandStreamPlayer& operator=(const CommandStreamPlayer&) = delete;
+    CommandStreamPlayer           (CommandStreamPlayer&&)      = delete;
+    CommandStreamPlayer& operator=(CommandStreamPlayer&&)      = delete;
+    // clang-format on
+
+    /// Parses the command stream and executes the device calls.
+
+    /// \param [in]  pData  - Command stream data. The data is copied by the player.
+    /// \param [in]  Size   - Data size.
+    /// \param [out] pStats - Optional statistics that the device call times are added to.
+    ///
+    /// \return     true if the stream was successfully parsed, and false otherwise.
+    bool Load(const void* pData, size_t Size, Stats* pStats = nullptr);
+
+    /// Reads the command stream from the file and calls Load().
+    bool LoadFromFile(const char* FilePath, Stats* pStats = nullptr);
+
+    /// Executes the context calls of the command stream.
+
+    /// \param [out] pStats - Optional statistics that the context call times are added to.
+    ///
+    /// \return     true if all commands were successfully executed, and false otherwise.
+    bool Replay(Stats* pStats = nullptr);
+
+    /// Returns the number of context commands executed by Replay().
+    size_t GetNumCommands() const { return m_Commands.size(); }
+
+private:
+    struct Command
+    {
+        COMMAND_STREAM_CALL Call   = COMMAND_STREAM_CALL_COUNT;
+        Uint32              Size   = 0;
+        size_t              Offset = 0;
+    };
+
+    bool ExecuteDeviceCommand(const Command& Cmd, Stats* pStats);
+    bool ExecuteContextCommand(const Command& Cmd, Stats* pStats);
+
+    IObject* ResolveObject(Uint32 Id, Uint32 ViewType) const;
+
+private:
+    RefCntAutoPtr<IRenderDevice>  m_pDevice;
+    RefCntAutoPtr<IDeviceContext> m_pContext;
+    RefCntAutoPtr<ITextureView>   m_pExternalRTV;
+    RefCntAutoPtr<ITextureView>   m_pExternalDSV;
+
+    std::vector<Uint8>   m_Data;
+    std::vector<Command> m_Commands;
+
+    std::vector<RefCntAutoPtr<IObject>> m_Objects;
+};
+
+} // namespace Diligent
@@ -0,0 +1,203 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ComputePrimitives class
+
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/PipelineState.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Helper class that implements parallel prefix scan, stream compaction and radix sort
+/// of 32-bit unsigned integers on the GPU.
+
+/// All operations work on structured buffers of Uint32 elements. The scan and the compaction
+/// preserve the order of the elements, and the radix sort is stable.
+///
+/// The thread group scans use wave intrinsics when the device supports wave arithmetic operations
+/// in compute shaders (see doc/WaveOp.md), and fall back to a shared memory implementation otherwise.
+/// The wave path is only used in Direct3D12 and Vulkan backends, where the shaders are compiled by DXC.
+///
+/// \remarks All methods must be called from the thread that owns the device context.
+///          The device must support compute shaders.
+///
+///          The scratch buffers that the operations need are created on demand and reused
+///          by the following calls.
+class ComputePrimitives
+{
+public:
+    struct CreateInfo
+    {
+        IRenderDevice* pDevice = nullptr;
+
+        /// The compute shader thread group size. Must be a power of two between 32 and 1024.
+        Uint32 ThreadGroupSize = 256;
+
+        /// Whether to use wave intrinsics when the device supports them.
+        bool UseWaveOps = true;
+    };
+
+    explicit ComputePrimitives(const CreateInfo& CI) noexcept(false);
+
+    // clang-format off
+    ComputePrimitives           (const ComputePrimitives&) = delete;
+    ComputePrimitives& operator=(const ComputePrimitives&) = delete;
+    ComputePrimitives           (ComputePrimitives&&)      = delete;
+    ComputePrimitives& operator=(ComputePrimitives&&)      = delete;
+    // clang-format on
+
+    struct ScanAttribs
+    {
+        /// Structured buffer of the input Uint32 elements.
+        IBuffer* pInput = nullptr;
+
+        /// Structured buffer of the output Uint32 elements that is bound as unordered access view.
+        /// Must be different from pInput.
+        IBuffer* pOutput = nullptr;
+
+        /// The number of elements to scan.
+        Uint32 NumElements = 0;
+
+        /// If true, the output element i is the sum of the input elements [0, i].
+        /// Otherwise, it is the sum of the input elements [0, i - 1].
+        bool Inclusive = false;
+    };
+
+    /// Computes the prefix sums of the input elements.
+    void Scan(IDeviceContext* pContext, const ScanAttribs& Attribs);
+
+    struct CompactAttribs
+    {
+        /// Structured buffer of the input Uint32 elements.
+        IBuffer* pInput = nullptr;
+
+        /// Structured buffer of Uint32 flags, one per input element.
+        /// The input element i is kept if the flag i is not zero.
+        IBuffer* pFlags = nullptr;
+
+        /// Structured buffer of the output Uint32 elements that is bound as unordered access view.
+        IBuffer* pOutput = nullptr;
+
+        /// Structured buffer that is bound as unordered access view. The number of the
+        /// elements written to pOutput is stored in its first Uint32 element.
+        IBuffer* pCount = nullptr;
+
+        /// The number of input elements.
+        Uint32 NumElements = 0;
+    };
+
+    /// Writes the input elements whose flags are not zero to the output buffer, preserving their order.
+    void Compact(IDeviceContext* pContext, const CompactAttribs& Attribs);
+
+    struct SortAttribs
+    {
+        /// Structured buffer of Uint32 keys. The buffer is sorted in place.
+        IBuffer* pKeys = nullptr;
+
+        /// Optional structured buffer of Uint32 values, one per key, such as element indices.
+        /// The values are reordered together with the keys.
+        IBuffer* pValues = nullptr;
+
+        /// Scratch buffers of at least NumElements elements that the sort alternates with pKeys and pValues.
+        /// pTempValues must not be null if pValues is not null.
+        IBuffer* pTempKeys   = nullptr;
+        IBuffer* pTempValues = nullptr;
+
+        /// The number of keys.
+        Uint32 NumElements = 0;
+
+        /// The number of the least significant key bits to sort by.
+        Uint32 NumKeyBits = 32;
+    };
+
+    /// Sorts the keys and the values in ascending order of the keys.
+
+    /// All buffers must be created with BIND_SHADER_RESOURCE and BIND_UNORDERED_ACCESS flags.
+    ///
+    /// \remarks    The sort processes RadixBits bits per pass. To sort floating-point keys,
+    ///             flip all bits of the negative keys and the sign bit of the positive keys.
+    void Sort(IDeviceContext* pContext, const SortAttribs& Attribs);
+
+    /// The number of key bits that the radix sort processes in one pass.
+    static constexpr Uint32 RadixBits = 4;
+
+    /// Returns true if the shaders use wave intrinsics.
+    bool IsUsingWaveOps() const { return m_UseWaveOps; }
+
+    /// Returns the number of elements that one thread group processes.
+    Uint32 GetElementsPerGroup() const { return m_ThreadGroupSize * ItemsPerThread; }
+
+private:
+    static constexpr Uint32 ItemsPerThread = 4;
+
+    struct ComputePipeline
+    {
+        RefCntAutoPtr<IPipelineState>         pPSO;
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    };
+    bool CreatePipelines(bool UseWaveOps);
+    bool CreatePipeline(ComputePipeline& Pipeline, const char* Name, const char* Kernel, bool UseWaveOps, bool ScanInPlace, bool SortValues);
+
+    void UpdateConstants(IDeviceContext* pContext, Uint32 NumElements, Uint32 NumBlocks, Uint32 Shift, bool Inclusive, bool ScanFlags);
+    void Dispatch(IDeviceContext* pContext, ComputePipeline& Pipeline, Uint32 NumGroups);
+
+    // Scans NumElements elements of pInput into pOutput. If pInput is null, the scan is performed in place.
+    void ScanLevel(IDeviceContext* pContext, IBuffer* pInput, IBuffer* pOutput, Uint32 NumElements, bool Inclusive, bool ScanFlags, size_t Level);
+
+    IBuffer* GetScratchBuffer(RefCntAutoPtr<IBuffer>& pBuffer, Uint32 NumElements, const char* Name);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    RefCntAutoPtr<IBuffer>       m_pConstants;
+
+    const Uint32 m_ThreadGroupSize;
+    bool         m_UseWaveOps = false;
+
+    ComputePipeline m_ScanBlocks;
+    ComputePipeline m_ScanBlocksInPlace;
+    ComputePipeline m_AddBlockOffsets;
+    ComputePipeline m_CompactScatter;
+    ComputePipeline m_RadixHistogram;
+    ComputePipeline m_RadixScatterKeys;
+    ComputePipeline m_RadixScatterKeyValues;
+
+    // Block sums of every level of the hierarchical scan
+    std::vector<RefCntAutoPtr<IBuffer>> m_BlockSums;
+
+    RefCntAutoPtr<IBuffer> m_pCompactOffsets;
+    RefCntAutoPtr<IBuffer> m_pRadixHistograms;
+};
+
+} // namespace Diligent
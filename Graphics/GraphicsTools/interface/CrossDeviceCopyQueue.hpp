@@ -0,0 +1,139 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::CrossDeviceCopyQueue class
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "AsyncReadbackQueue.hpp"
+
+namespace Diligent
+{
+
+/// Helper class that copies buffer and texture data between resources of two render devices,
+/// e.g. devices created for different adapters in the same process.
+
+/// Every copy reads the source data back to the CPU with an AsyncReadbackQueue and uploads
+/// it to the destination resource with IDeviceContext::UpdateBuffer() or IDeviceContext::UpdateTexture()
+/// once the source device has finished the readback. Copies issued in consecutive frames are
+/// pipelined: neither device waits for the other unless the application calls Flush().
+///
+/// \remarks All methods must be called from the same thread, and all copies must be issued
+///          through the same source and destination immediate contexts.
+///
+///          The destination resources must be created with USAGE_DEFAULT.
+///          The source and destination devices may be the same device.
+class CrossDeviceCopyQueue
+{
+public:
+    struct CreateInfo
+    {
+        /// Device that owns the source resources.
+        IRenderDevice* pSrcDevice = nullptr;
+
+        /// Thread pool that copies the data from the mapped staging resources.
+        /// If null, the data is copied by the thread that calls Process().
+        IThreadPool* pThreadPool = nullptr;
+
+        /// The maximum number of staging resources that are kept in the pool for reuse.
+        Uint32 MaxPooledResources = 32;
+    };
+
+    explicit CrossDeviceCopyQueue(const CreateInfo& CI) noexcept(false);
+
+    ~CrossDeviceCopyQueue();
+
+    // clang-format off
+    CrossDeviceCopyQueue           (const CrossDeviceCopyQueue&) = delete;
+    CrossDeviceCopyQueue& operator=(const CrossDeviceCopyQueue&) = delete;
+    CrossDeviceCopyQueue           (CrossDeviceCopyQueue&&)      = delete;
+    CrossDeviceCopyQueue& operator=(CrossDeviceCopyQueue&&)      = delete;
+    // clang-format on
+
+    /// Enqueues a copy of Size bytes from the source buffer to the destination buffer.
+
+    /// \return     true if the copy was enqueued, and false otherwise.
+    bool CopyBuffer(IDeviceContext* pSrcContext,
+                    IBuffer*        pSrcBuffer,
+                    Uint64          SrcOffset,
+                    Uint64          Size,
+                    IBuffer*        pDstBuffer,
+                    Uint64          DstOffset);
+
+    /// Enqueues a copy of the source texture subresource region to the destination texture subresource.
+
+    /// \param [in] pSrcRegion - Source region. If null, the entire source subresource is copied.
+    /// \param [in] DstX, DstY, DstZ - Destination region offset.
+    ///
+    /// \return     true if the copy was enqueued, and false otherwise.
+    bool CopyTexture(IDeviceContext* pSrcContext,
+                     ITexture*       pSrcTexture,
+                     Uint32          SrcMipLevel,
+                     Uint32          SrcSlice,
+                     const Box*      pSrcRegion,
+                     ITexture*       pDstTexture,
+                     Uint32          DstMipLevel,
+                     Uint32          DstSlice,
+                     Uint32          DstX = 0,
+                     Uint32          DstY = 0,
+                     Uint32          DstZ = 0);
+
+    /// Uploads the data of the copies whose readbacks have been completed by the source device.
+
+    /// \remarks    This method is typically called once per frame.
+    void Process(IDeviceContext* pSrcContext, IDeviceContext* pDstContext);
+
+    /// Flushes the source context, waits for the source device to complete all readbacks,
+    /// and uploads all pending copies to the destination resources.
+    void Flush(IDeviceContext* pSrcContext, IDeviceContext* pDstContext);
+
+    /// Returns the number of copies that have not been uploaded yet.
+    size_t GetNumPendingCopies() const { return m_NumPendingCopies.load(); }
+
+private:
+    struct PendingCopy;
+
+    void UploadReadyCopies(IDeviceContext* pDstContext);
+
+private:
+    AsyncReadbackQueue m_ReadbackQueue;
+
+    // Copies whose data has been read back, in completion order.
+    // Readback callbacks may run in the thread pool.
+    std::mutex                                m_ReadyCopiesMtx;
+    std::vector<std::shared_ptr<PendingCopy>> m_ReadyCopies;
+
+    std::atomic<size_t> m_NumPendingCopies{0};
+};
+
+} // namespace Diligent
@@ -115,6 +115,13 @@ public:
     ///
     ///             Typically pDevice and pContext should be null when the method is called from a worker thread.
     ///
+    ///             pContext may be a transfer queue context, in which case the copy does not stall
+    ///             the graphics queue. The buffer's ImmediateContextMask must then include both the
+    ///             transfer context and the contexts that use the buffer. After the copy, the transfer
+    ///             context signals a fence and is flushed. The next call to GetBuffer() with another
+    ///             context makes that context wait for the fence. The application is responsible
+    ///             for synchronizing any pending GPU writes to the buffer with the transfer queue.
+    ///
     ///             If NewSize is zero, internal buffer will be released.
     IBuffer* Resize(IRenderDevice*  pDevice,
                     IDeviceContext* pContext,
@@ -156,6 +163,13 @@ public:
     }
 
 
+    /// Returns the amount of memory currently used by the dynamic buffer, in bytes.
+
+    /// \remarks   For sparse buffers, this is the size of the committed memory pages.
+    ///            For other buffers, this is the total size of the internal buffer and
+    ///            the stale buffer whose contents has not been copied yet.
+    Uint64 GetMemoryUsage() const;
+
     /// Returns the dynamic buffer version.
     /// The version is incremented every time a new internal buffer is created.
     Uint32 GetVersion() const
@@ -166,6 +180,7 @@ public:
 private:
     void InitBuffer(IRenderDevice* pDevice);
     void CreateSparseBuffer(IRenderDevice* pDevice);
+    void CreateResizeFences(IRenderDevice* pDevice);
 
     void CommitResize(IRenderDevice*  pDevice,
                       IDeviceContext* pContext,
@@ -193,6 +208,9 @@ private:
 
     RefCntAutoPtr<IFence> m_pBeforeResizeFence;
     RefCntAutoPtr<IFence> m_pAfterResizeFence;
+
+    // Transfer context that copied the contents of the stale buffer (only used for comparison).
+    const IDeviceContext* m_pCopyContext = nullptr;
 };
 
 } // namespace Diligent
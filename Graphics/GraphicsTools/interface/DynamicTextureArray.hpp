@@ -109,6 +109,13 @@ public:
     ///
     ///             Typically pContext is null when the method is called from a worker thread.
     ///
+    ///             pContext may be a transfer queue context, in which case the copy does not stall
+    ///             the graphics queue. The texture's ImmediateContextMask must then include both the
+    ///             transfer context and the contexts that use the texture. After the copy, the transfer
+    ///             context signals a fence and is flushed. The next call to GetTexture() with another
+    ///             context makes that context wait for the fence. The application is responsible
+    ///             for synchronizing any pending GPU writes to the texture with the transfer queue.
+    ///
     ///             If NewArraySize is zero, internal buffer will be released.
     ITexture* Resize(IRenderDevice*  pDevice,
                      IDeviceContext* pContext,
@@ -168,6 +175,7 @@ private:
     void ResizeDefaultTexture(IDeviceContext* pContext);
 
     void CreateSparseTexture(IRenderDevice* pDevice);
+    void CreateResizeFences(IRenderDevice* pDevice);
     void CreateResources(IRenderDevice* pDevice);
 
     const std::string m_Name;
@@ -190,6 +198,9 @@ private:
 
     RefCntAutoPtr<IFence> m_pBeforeResizeFence;
     RefCntAutoPtr<IFence> m_pAfterResizeFence;
+
+    // Transfer context that copied the contents of the stale texture (only used for comparison).
+    const IDeviceContext* m_pCopyContext = nullptr;
 };
 
 } // namespace Diligent
@@ -34,6 +34,7 @@
 #include "../../GraphicsEngine/interface/DeviceContext.h"
 #include "../../GraphicsEngine/interface/Texture.h"
 #include "../../../Common/interface/BasicMath.hpp"
+#include "../../GraphicsAccessories/interface/DynamicAtlasManager.hpp"
 
 namespace Diligent
 {
@@ -114,6 +115,42 @@ struct DynamicTextureAtlasUsageStats
 };
 
 
+/// Callback that is called by IDynamicTextureAtlas::Defragment() for every moved suballocation.
+
+/// \param [in] pSuballocation - Suballocation that has been moved. ITextureAtlasSuballocation::GetOrigin()
+///                              and ITextureAtlasSuballocation::GetSlice() return the new location.
+/// \param [in] OldOrigin      - The previous origin of the suballocation.
+/// \param [in] OldSlice       - The previous slice of the suballocation.
+/// \param [in] pUserData      - User data pointer, see DynamicTextureAtlasDefragmentAttribs::pCallbackUserData.
+///
+/// \remarks   The callback is called while the internal mutex is locked. It must not call any
+///            methods of the atlas and must not add references to the suballocation,
+///            which may be in the process of being released.
+typedef void (*TextureAtlasSuballocationMovedCallbackType)(ITextureAtlasSuballocation* pSuballocation, const uint2& OldOrigin, Uint32 OldSlice, void* pUserData);
+
+/// Dynamic texture atlas defragmentation attributes.
+struct DynamicTextureAtlasDefragmentAttribs
+{
+    /// Render device that will be used to create the scratch texture, if necessary.
+    IRenderDevice* pDevice = nullptr;
+
+    /// Device context that will be used to copy the data.
+    IDeviceContext* pContext = nullptr;
+
+    /// The maximum total area, in texels, of the suballocations to move.
+
+    /// If zero, all suballocations that can be moved to lower slices are moved.
+    /// At least one suballocation is always moved, if possible.
+    Uint64 MaxAreaToMove = 0;
+
+    /// Optional callback that is called for every moved suballocation.
+    TextureAtlasSuballocationMovedCallbackType MovedCallback = nullptr;
+
+    /// User data pointer that is passed to MovedCallback.
+    void* pCallbackUserData = nullptr;
+};
+
+
 /// Dynamic texture atlas.
 struct IDynamicTextureAtlas : public IObject
 {
@@ -154,7 +191,7 @@ struct IDynamicTextureAtlas : public IObject
     virtual const TextureDesc& GetAtlasDesc() const = 0;
 
     /// Returns internal texture array version. The version is incremented every time
-    /// the array is expanded.
+    /// the array is resized or suballocations are moved by Defragment().
     virtual Uint32 GetVersion() const = 0;
 
     /// Returns the usage stats, see Diligent::DynamicTextureAtlasUsageStats.
@@ -167,6 +204,33 @@ struct IDynamicTextureAtlas : public IObject
     /// \param [in] Height - Region height.
     /// \return            - Allocation alignment.
     virtual Uint32 GetAllocationAlignment(Uint32 Width, Uint32 Height) const = 0;
+
+
+    /// Moves suballocations from the last slices of the texture array to the free space
+    /// in lower slices.
+
+    /// \param[in] Attribs - Defragmentation attributes, see Diligent::DynamicTextureAtlasDefragmentAttribs.
+    ///
+    /// \return    The number of moved suballocations.
+    ///
+    /// \remarks   Defragmentation must be enabled by DynamicTextureAtlasCreateInfo::EnableDefragmentation
+    ///            and is only performed for texture arrays. A suballocation may only be moved to a
+    ///            slice that contains other suballocations with the same alignment. The data is copied
+    ///            through a scratch texture, since copies within the same texture are not supported
+    ///            by all backends. Only the mip levels where the suballocation covers whole texels
+    ///            are copied.
+    ///
+    ///            Slices that become empty are released, and the texture array is shrunk by the
+    ///            next call to GetTexture() if the trailing slices are not used, but never below
+    ///            the initial array size.
+    ///
+    ///            After the method returns, the data of the moved suballocations is only available
+    ///            at their new locations; an application must update all references to the old
+    ///            locations (e.g. using the MovedCallback) before recording any commands that use them.
+    ///            The method must not be called concurrently with GetTexture(), and
+    ///            ITextureAtlasSuballocation::GetOrigin() and ITextureAtlasSuballocation::GetSlice()
+    ///            must not be called concurrently with this method.
+    virtual Uint32 Defragment(const DynamicTextureAtlasDefragmentAttribs& Attribs) = 0;
 };
 
 
@@ -232,8 +296,20 @@ struct DynamicTextureAtlasCreateInfo
     /// the number of objects in one page.
     Uint32 SuballocationObjAllocationGranularity = 64;
 
+    /// Region packing policy of every slice, see Diligent::DYNAMIC_ATLAS_MANAGER_POLICY.
+
+    /// DYNAMIC_ATLAS_MANAGER_POLICY_SHELF is considerably faster when the atlas hosts
+    /// many small regions of similar height, e.g. glyphs or lightmap charts.
+    DYNAMIC_ATLAS_MANAGER_POLICY PackingPolicy = DYNAMIC_ATLAS_MANAGER_POLICY_TREE;
+
     /// Silence allocation errors.
     bool Silent = false;
+
+    /// Whether to allow IDynamicTextureAtlas::Defragment().
+
+    /// \remarks   When enabled, the atlas keeps track of all live suballocations,
+    ///            which adds a small overhead to every allocation and release.
+    bool EnableDefragmentation = false;
 };
 
 
@@ -0,0 +1,151 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// Declaration of Diligent::FenceWaitService class
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/Fence.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Runs callbacks when fences reach the given values, without polling the fences every frame.
+
+/// On backends where fences may be queried by any thread (Direct3D12, Vulkan and Metal),
+/// the service starts a worker thread that runs the callbacks. The worker checks the completed
+/// values of all fences with pending requests, and sleeps for CreateInfo::PollIntervalUs when
+/// none of them has completed. It is woken up immediately when a request is enqueued.
+///
+/// Direct3D11 and OpenGL fences are tied to the immediate context and cannot be waited for
+/// by another thread. On these backends no worker thread is started and the callbacks of
+/// the completed requests are run by Poll(), which must be called by the thread that owns the
+/// immediate context.
+///
+/// \remarks    A request is served as soon as its fence reaches the value, regardless of the requests
+///             for other fences or for greater values that were enqueued before it. The callbacks of
+///             the requests that complete at the same time are run in the order the requests were enqueued.
+///             The commands that signal the fences must be flushed, see IDeviceContext::Flush().
+class FenceWaitService
+{
+public:
+    /// Function called when the fence reaches the value.
+    using CallbackType = std::function<void()>;
+
+    struct CreateInfo
+    {
+        IRenderDevice* pDevice = nullptr;
+
+        /// If true, the worker thread is not started and callbacks are run by Poll()
+        /// on all backends.
+        bool DisableWorkerThread = false;
+
+        /// The time, in microseconds, the worker thread sleeps when none of the pending
+        /// requests has completed.
+        Uint32 PollIntervalUs = 500;
+    };
+
+    explicit FenceWaitService(const CreateInfo& CI) noexcept(false);
+
+    /// Drops the pending requests without running their callbacks.
+    /// If the worker thread is used, waits until the running callbacks return.
+    ~FenceWaitService();
+
+    // clang-format off
+    FenceWaitService           (const FenceWaitService&) = delete;
+    FenceWaitService& operator=(const FenceWaitService&) = delete;
+    FenceWaitService           (FenceWaitService&&)      = delete;
+    FenceWaitService& operator=(FenceWaitService&&)      = delete;
+    // clang-format on
+
+    /// Requests the callback to be called when the fence reaches or exceeds the value.
+
+    /// \remarks    The method may be called by any thread. The callback is run by the worker
+    ///             thread, or by the thread that calls Poll() or WaitIdle() if the worker is not used.
+    void Enqueue(IFence* pFence, Uint64 Value, CallbackType Callback);
+
+    /// Runs the callbacks of the completed requests on the calling thread.
+
+    /// \return     The number of callbacks that were run.
+    ///
+    /// \remarks    If the worker thread is used, the method does nothing and returns zero.
+    Uint32 Poll();
+
+    /// Blocks until all pending requests complete and their callbacks return.
+    void WaitIdle();
+
+    /// Returns true if the callbacks are run by the worker thread.
+    bool IsAsync() const { return m_Worker.joinable(); }
+
+    /// Returns the number of requests whose callbacks have not returned yet.
+    size_t GetNumPendingRequests() const;
+
+private:
+    struct Request
+    {
+        RefCntAutoPtr<IFence> pFence;
+        Uint64                Value = 0;
+        CallbackType          Callback;
+    };
+
+    void WorkerThreadProc();
+
+    // Moves the completed requests to Completed, preserving their order.
+    void ExtractCompletedRequests(std::vector<Request>& Completed);
+
+private:
+    mutable std::mutex      m_Mtx;
+    std::condition_variable m_WakeCV;
+    std::condition_variable m_IdleCV;
+
+    std::deque<Request> m_Requests;
+
+    // Completed values of the fences, cached by ExtractCompletedRequests().
+    std::vector<std::pair<IFence*, Uint64>> m_CompletedValues;
+
+    // The number of extracted requests whose callbacks are running.
+    size_t m_NumRunningCallbacks = 0;
+
+    bool m_Stop = false;
+
+    const std::chrono::microseconds m_PollInterval;
+
+    std::thread m_Worker;
+};
+
+} // namespace Diligent
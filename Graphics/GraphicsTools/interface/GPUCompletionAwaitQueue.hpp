@@ -97,6 +97,26 @@ public:
         pCtx->EnqueueSignal(m_pFence, m_NextFenceValue++);
     }
 
+    /// Waits until the GPU completes the first pending object and returns it.
+    /// The context the object was enqueued to must have been flushed.
+    ObjectType WaitForFirstCompleted()
+    {
+        ObjectType Obj{};
+        if (!m_PendingObjects.empty())
+        {
+            m_pFence->Wait(m_PendingObjects.front().FenceValue);
+            Obj = std::move(m_PendingObjects.front().Object);
+            m_PendingObjects.pop();
+        }
+
+        return Obj;
+    }
+
+    size_t GetNumPendingObjects() const
+    {
+        return m_PendingObjects.size();
+    }
+
 private:
     struct PendingObject
     {
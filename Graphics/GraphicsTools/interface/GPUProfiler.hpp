@@ -0,0 +1,289 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GPUProfiler class
+
+#include <mutex>
+#include <vector>
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Query.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/Timer.hpp"
+#include "ScopedDebugGroup.hpp"
+
+namespace Diligent
+{
+
+/// Hierarchical GPU profiler.
+
+/// The profiler records named nested scopes in any number of device contexts using a pair of
+/// timestamp queries per scope. Query results are read back with a latency of a few frames
+/// without stalling the GPU, converted to the CPU timeline and can be exported in the Chrome
+/// trace event format (chrome://tracing, Perfetto).
+///
+/// Typical usage:
+///
+///     Profiler.BeginFrame();
+///     {
+///         GPUProfiler::Scope ShadowPass{Profiler, pCtx, "Shadow pass"};
+///         ...
+///     }
+///     Profiler.EndFrame();
+///     if (Profiler.GetLastResolvedFrame(Frame)) ...
+///
+/// \remarks  All methods are thread-safe. Scopes must be properly nested within every context
+///           and must be closed before EndFrame() is called.
+///
+///           All contexts are assumed to share the same GPU clock, which is the case for all queues
+///           of a device in Direct3D12 and Vulkan.
+class GPUProfiler
+{
+public:
+    struct CreateInfo
+    {
+        /// Render device that is used to create timestamp queries.
+        IRenderDevice* pDevice = nullptr;
+
+        /// Immediate context that is used to calibrate GPU timestamps against the CPU clock.
+        /// If null, calibration is not performed until Calibrate() is called.
+        IDeviceContext* pCalibrationCtx = nullptr;
+
+        /// The number of timestamp queries to create upfront.
+        Uint32 NumQueriesToReserve = 64;
+
+        /// The number of frames that are expected to be pending readback.
+        /// A warning is issued if this limit is exceeded.
+        Uint32 ExpectedFrameLatency = 5;
+    };
+
+    static constexpr Uint32 InvalidIndex = ~0u;
+
+    struct ScopeData
+    {
+        /// Scope name.
+        std::string Name;
+
+        /// Index of the context in the array returned by GetContextNames().
+        Uint32 ContextIndex = 0;
+
+        /// Nesting depth of the scope, 0 for top-level scopes.
+        Uint32 Depth = 0;
+
+        /// Index of the parent scope in FrameData::Scopes, or InvalidIndex for top-level scopes.
+        Uint32 ParentIndex = InvalidIndex;
+
+        /// Scope start and end time, in seconds, on the CPU timeline (see GetCPUTime()).
+        double StartTime = 0;
+        double EndTime   = 0;
+    };
+
+    struct FrameData
+    {
+        /// Frame number, starting from 0.
+        Uint64 FrameNumber = 0;
+
+        /// CPU time when BeginFrame() and EndFrame() were called for this frame, in seconds.
+        double CPUBeginTime = 0;
+        double CPUEndTime   = 0;
+
+        /// Scopes in the order they were begun in every context.
+        /// A parent scope always precedes its children.
+        std::vector<ScopeData> Scopes;
+    };
+
+    explicit GPUProfiler(const CreateInfo& CI);
+    ~GPUProfiler();
+
+    // clang-format off
+    GPUProfiler           (const GPUProfiler&) = delete;
+    GPUProfiler& operator=(const GPUProfiler&) = delete;
+    GPUProfiler           (GPUProfiler&&)      = delete;
+    GPUProfiler& operator=(GPUProfiler&&)      = delete;
+    // clang-format on
+
+
+    /// Calibrates GPU timestamps against the CPU clock.
+
+    /// \param [in] pImmediateCtx - Immediate context to record the calibration timestamp.
+    /// \return     true if the calibration succeeded, and false otherwise.
+    ///
+    /// \remarks    The method idles the context, so it should not be called every frame.
+    ///             If the profiler is not calibrated, the first timestamp of every frame is
+    ///             aligned with the CPU time when BeginFrame() was called.
+    bool Calibrate(IDeviceContext* pImmediateCtx);
+
+
+    /// Begins a new frame.
+    void BeginFrame();
+
+
+    /// Ends the current frame and reads back the results of the previous frames that are ready.
+
+    /// \return     true if a new frame has been resolved, and false otherwise.
+    bool EndFrame();
+
+
+    /// Begins a profiling scope in the given context.
+
+    /// \remarks    The call must be matched by EndScope() in the same context.
+    ///             Use GPUProfiler::Scope to also open a debug group with the same name.
+    void BeginScope(IDeviceContext* pCtx, const Char* Name);
+
+
+    /// Ends the innermost scope in the given context.
+    void EndScope(IDeviceContext* pCtx);
+
+
+    /// Returns the latest fully resolved frame.
+
+    /// \return     true if there is a resolved frame, and false otherwise.
+    bool GetLastResolvedFrame(FrameData& Frame) const;
+
+
+    /// Returns the latest resolved frame in the Chrome trace event JSON format.
+
+    /// \remarks    Every context is exported as a separate thread. If there is no
+    ///             resolved frame, an empty trace is returned.
+    std::string GetChromeTrace() const;
+
+
+    /// Writes the frame in the Chrome trace event JSON format.
+    static void WriteChromeTrace(const FrameData& Frame, const std::vector<std::string>& ContextNames, std::string& Json);
+
+
+    /// Returns the names of all contexts that have been used for profiling.
+    std::vector<std::string> GetContextNames() const;
+
+
+    /// Returns the current CPU time, in seconds, measured from the profiler creation.
+    double GetCPUTime() const { return m_Timer.GetElapsedTime(); }
+
+    bool IsCalibrated() const
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_IsCalibrated;
+    }
+
+
+    /// RAII helper that opens a debug group and a profiling scope with the same name.
+    class Scope
+    {
+    public:
+        Scope(GPUProfiler& Profiler, IDeviceContext* pCtx, const Char* Name, const float* pColor = nullptr) :
+            m_DebugGroup{pCtx, Name, pColor},
+            m_Profiler{Profiler},
+            m_pCtx{pCtx}
+        {
+            m_Profiler.BeginScope(m_pCtx, Name);
+        }
+
+        ~Scope()
+        {
+            m_Profiler.EndScope(m_pCtx);
+        }
+
+        // clang-format off
+        Scope           (const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope           (Scope&&)      = delete;
+        Scope& operator=(Scope&&)      = delete;
+        // clang-format on
+
+    private:
+        // The debug group is closed after the scope's end timestamp is recorded
+        ScopedDebugGroup m_DebugGroup;
+
+        GPUProfiler&          m_Profiler;
+        IDeviceContext* const m_pCtx;
+    };
+
+private:
+    RefCntAutoPtr<IQuery> AcquireQuery();
+    void                  ReleaseQuery(RefCntAutoPtr<IQuery>&& pQuery);
+    bool                  ResolveFrame();
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const Uint32 m_ExpectedFrameLatency;
+
+    const Timer m_Timer;
+
+    mutable std::mutex m_Mtx;
+
+    struct PendingScope
+    {
+        std::string           Name;
+        Uint32                ContextIndex = 0;
+        Uint32                Depth        = 0;
+        Uint32                ParentIndex  = InvalidIndex;
+        RefCntAutoPtr<IQuery> pBeginQuery;
+        RefCntAutoPtr<IQuery> pEndQuery;
+    };
+
+    struct PendingFrame
+    {
+        Uint64                    FrameNumber  = 0;
+        double                    CPUBeginTime = 0;
+        double                    CPUEndTime   = 0;
+        std::vector<PendingScope> Scopes;
+    };
+
+    struct ContextState
+    {
+        Uint32 Index = 0;
+
+        // Indices of the open scopes in m_CurrentFrame.Scopes
+        std::vector<Uint32> ScopeStack;
+    };
+    std::unordered_map<IDeviceContext*, ContextState> m_Contexts;
+    std::vector<std::string>                          m_ContextNames;
+
+    bool         m_FrameActive     = false;
+    Uint64       m_NextFrameNumber = 0;
+    PendingFrame m_CurrentFrame;
+
+    std::deque<PendingFrame> m_PendingFrames;
+
+    FrameData m_LastResolvedFrame;
+    bool      m_HasResolvedFrame = false;
+
+    // CPU time minus GPU time, in seconds
+    double m_CalibrationOffset = 0;
+    bool   m_IsCalibrated      = false;
+
+    std::vector<RefCntAutoPtr<IQuery>> m_AvailableQueries;
+};
+
+} // namespace Diligent
@@ -0,0 +1,194 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the CPU-side geometry preprocessing functions
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Common/interface/AdvancedMath.hpp"
+#include "../../../Common/interface/ThreadPool.hpp"
+
+namespace Diligent
+{
+
+/// The default number of elements (indices, vertices or triangles) processed by one thread pool task.
+static constexpr Uint32 DefaultGeometryElementsPerTask = 65536;
+
+/// Converts 32-bit indices to 16-bit indices.
+
+/// \param [in]  pSrcIndices     - Source indices.
+/// \param [in]  NumIndices      - The number of indices.
+/// \param [out] pDstIndices     - Destination 16-bit indices. May not alias the source.
+/// \param [in]  pThreadPool     - Optional thread pool that converts the indices in parallel.
+/// \param [in]  IndicesPerTask  - The number of indices processed by one task.
+///
+/// \return     true if all indices fit into 16 bits, and false otherwise. In the latter case,
+///             the content of pDstIndices is undefined and 32-bit indices must be used.
+///
+/// \remarks    Primitive restart index 0xFFFFFFFF is not converted and is treated as a regular index.
+bool ConvertIndicesToUint16(const Uint32* pSrcIndices,
+                            Uint32        NumIndices,
+                            Uint16*       pDstIndices,
+                            IThreadPool*  pThreadPool    = nullptr,
+                            Uint32        IndicesPerTask = DefaultGeometryElementsPerTask);
+
+/// Generates the vertex remap table that welds binary identical vertices.
+
+/// \param [in]  pVertices       - Vertex data.
+/// \param [in]  NumVertices     - The number of vertices.
+/// \param [in]  VertexStride    - The size of one vertex, in bytes. All bytes of the vertex are compared.
+/// \param [out] pRemap          - Remap table with NumVertices elements. pRemap[v] is the new index of vertex v.
+///                                The unique vertices are numbered in the order of their first occurrence.
+/// \param [in]  pThreadPool     - Optional thread pool that hashes the vertices in parallel.
+/// \param [in]  VerticesPerTask - The number of vertices processed by one task.
+///
+/// \return     The number of unique vertices.
+///
+/// \remarks    Use RemapVertices() and RemapIndices() to apply the table to the vertex and index buffers.
+Uint32 GenerateVertexWeldRemap(const void*  pVertices,
+                               Uint32       NumVertices,
+                               Uint32       VertexStride,
+                               Uint32*      pRemap,
+                               IThreadPool* pThreadPool     = nullptr,
+                               Uint32       VerticesPerTask = DefaultGeometryElementsPerTask);
+
+/// Generates the vertex remap table that orders the vertices by their first use in the index buffer.
+
+/// Running this function after OptimizeVertexCache() improves the locality of vertex fetches.
+///
+/// \param [in]  pIndices    - Triangle list indices.
+/// \param [in]  NumIndices  - The number of indices.
+/// \param [in]  NumVertices - The number of vertices.
+/// \param [out] pRemap      - Remap table with NumVertices elements. pRemap[v] is the new index of vertex v,
+///                            or ~0u if the vertex is not referenced by the index buffer.
+///
+/// \return     The number of referenced vertices.
+///
+/// \remarks    The function throws an exception if an index is out of range.
+Uint32 GenerateVertexFetchRemap(const Uint32* pIndices,
+                                Uint32        NumIndices,
+                                Uint32        NumVertices,
+                                Uint32*       pRemap) noexcept(false);
+
+/// Applies the remap table to the index buffer: pDstIndices[i] = pRemap[pIndices[i]].
+
+/// pDstIndices may be the same as pIndices.
+void RemapIndices(const Uint32* pIndices,
+                  Uint32        NumIndices,
+                  const Uint32* pRemap,
+                  Uint32*       pDstIndices,
+                  IThreadPool*  pThreadPool    = nullptr,
+                  Uint32        IndicesPerTask = DefaultGeometryElementsPerTask);
+
+/// Applies the remap table to the vertex buffer: vertex v is copied to position pRemap[v] of pDstVertices.
+
+/// Vertices whose remap value is ~0u are dropped. When several vertices are remapped to the same
+/// position, one of them is copied. pDstVertices must not alias pVertices and must have enough
+/// space for the largest remapped index.
+void RemapVertices(const void*   pVertices,
+                   Uint32        NumVertices,
+                   Uint32        VertexStride,
+                   const Uint32* pRemap,
+                   void*         pDstVertices,
+                   IThreadPool*  pThreadPool     = nullptr,
+                   Uint32        VerticesPerTask = DefaultGeometryElementsPerTask);
+
+
+/// Vertex cache optimization attributes, see Diligent::OptimizeVertexCache.
+struct VertexCacheOptimizationAttribs
+{
+    /// Triangle list indices that are reordered in place.
+    Uint32* pIndices = nullptr;
+
+    /// The number of indices, must be a multiple of 3.
+    Uint32 NumIndices = 0;
+
+    /// The number of vertices.
+    Uint32 NumVertices = 0;
+
+    /// The size of the simulated LRU post-transform cache, must be in the range [4, 64].
+    Uint32 CacheSize = 32;
+
+    /// Optional thread pool. If not null, the index buffer is split into chunks
+    /// of TrianglesPerTask triangles that are optimized in parallel.
+    IThreadPool* pThreadPool = nullptr;
+
+    /// The number of triangles processed by one task when pThreadPool is not null.
+    Uint32 TrianglesPerTask = 16384;
+};
+
+/// Reorders the triangles to improve the post-transform vertex cache hit rate.
+
+/// The function implements the linear-speed vertex cache optimization algorithm by Tom Forsyth.
+/// When the work is split between threads, the triangles never move across the boundary of a task
+/// chunk, so the result is deterministic and only depends on TrianglesPerTask. For the best
+/// results, the triangles of every chunk should be spatially coherent, e.g. belong to the same mesh.
+///
+/// \remarks The function throws an exception if the attributes are invalid.
+void OptimizeVertexCache(const VertexCacheOptimizationAttribs& Attribs) noexcept(false);
+
+/// Returns the average number of vertex shader invocations per triangle (ACMR) for
+/// a FIFO post-transform cache of the given size. Lower values are better; the best
+/// achievable value for a regular grid is about 0.5.
+float ComputeVertexCacheACMR(const Uint32* pIndices, Uint32 NumIndices, Uint32 NumVertices, Uint32 CacheSize);
+
+
+/// Computes the bounding box of the vertex positions.
+
+/// \param [in] pPositions      - Vertex positions, three floats per vertex.
+/// \param [in] NumVertices     - The number of vertices.
+/// \param [in] PositionStride  - The byte stride between successive positions.
+/// \param [in] pThreadPool     - Optional thread pool that processes the vertices in parallel.
+/// \param [in] VerticesPerTask - The number of vertices processed by one task.
+///
+/// \return     The bounding box. If NumVertices is 0, Min is +FLT_MAX and Max is -FLT_MAX.
+BoundBox ComputeBoundingBox(const void*  pPositions,
+                            Uint32       NumVertices,
+                            Uint32       PositionStride  = sizeof(float) * 3,
+                            IThreadPool* pThreadPool     = nullptr,
+                            Uint32       VerticesPerTask = DefaultGeometryElementsPerTask);
+
+/// Computes the bounding box of every triangle, e.g. to build a BVH or procedural AABB geometry.
+
+/// \param [in]  pIndices         - Triangle list indices.
+/// \param [in]  NumIndices       - The number of indices, must be a multiple of 3.
+/// \param [in]  pPositions       - Vertex positions, three floats per vertex.
+/// \param [in]  PositionStride   - The byte stride between successive positions.
+/// \param [out] pBoxes           - Output boxes, one per triangle.
+/// \param [in]  pThreadPool      - Optional thread pool that processes the triangles in parallel.
+/// \param [in]  TrianglesPerTask - The number of triangles processed by one task.
+void ComputeTriangleBoundingBoxes(const Uint32* pIndices,
+                                  Uint32        NumIndices,
+                                  const void*   pPositions,
+                                  Uint32        PositionStride,
+                                  BoundBox*     pBoxes,
+                                  IThreadPool*  pThreadPool      = nullptr,
+                                  Uint32        TrianglesPerTask = DefaultGeometryElementsPerTask);
+
+} // namespace Diligent
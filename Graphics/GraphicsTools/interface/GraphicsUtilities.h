@@ -141,6 +141,60 @@ typedef struct ComputeMipLevelAttribs ComputeMipLevelAttribs;
 
 void DILIGENT_GLOBAL_FUNCTION(ComputeMipLevel)(const ComputeMipLevelAttribs REF Attribs);
 
+#if DILIGENT_CPP_INTERFACE
+
+class IThreadPool;
+
+/// ComputeMipChain function attributes
+struct ComputeMipChainAttribs
+{
+    /// Texture format.
+    TEXTURE_FORMAT Format = TEX_FORMAT_UNKNOWN;
+
+    /// Width of the most detailed mip level.
+    Uint32 Width = 0;
+
+    /// Height of the most detailed mip level.
+    Uint32 Height = 0;
+
+    /// The number of array slices.
+    Uint32 ArraySize = 1;
+
+    /// The number of mip levels. If 0, the full mip chain is generated.
+    Uint32 MipLevels = 0;
+
+    /// Pointers to the data of all subresources, ArraySize * MipLevels elements.
+    /// The subresources are ordered as in TextureData::pSubResources:
+    /// all mip levels of slice 0, then all mip levels of slice 1, etc.
+    /// The most detailed level of every slice is the source data, the remaining levels are written.
+    void* const* ppSubresData = nullptr;
+
+    /// Row strides of all subresources, in bytes, in the same order as ppSubresData.
+    const size_t* pSubresStrides = nullptr;
+
+    /// Filter type, see ComputeMipLevelAttribs::FilterType.
+    MIP_FILTER_TYPE FilterType = MIP_FILTER_TYPE_DEFAULT;
+
+    /// Alpha cutoff value, see ComputeMipLevelAttribs::AlphaCutoff.
+    float AlphaCutoff = 0;
+
+    /// Thread pool to use. If null, all levels are computed by the calling thread.
+    IThreadPool* pThreadPool = nullptr;
+
+    /// The number of coarse rows processed by a single task.
+    /// If 0, the value is selected automatically. The value is rounded up to a multiple of 4.
+    Uint32 RowsPerTask = 0;
+};
+
+/// Computes all mip levels of a texture or a texture array from the most detailed levels.
+
+/// \remarks   The subresources of one level are split into bands of rows that are processed
+///             by the thread pool. The calling thread processes one band and waits for the
+///             remaining tasks, so the function must not be called from a thread pool thread.
+void ComputeMipChain(const ComputeMipChainAttribs& Attribs);
+
+#endif
+
 /// For a Direct3D12 render device, returns the maximum supported shader version. For any other device type, returns 0.
 
 /// \param [in]  pDevice - a pointer to the render device object.
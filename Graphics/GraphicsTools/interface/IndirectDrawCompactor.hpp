@@ -0,0 +1,172 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::IndirectDrawCompactor class
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/PipelineState.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/BasicMath.hpp"
+#include "../../../Common/interface/AdvancedMath.hpp"
+
+namespace Diligent
+{
+
+/// Helper class that culls draw commands on the GPU and compacts the visible ones
+/// into an indirect argument buffer.
+
+/// The application provides two structured buffers with one element per object:
+/// the world-space bounding boxes (see IndirectDrawCompactor::ObjectBounds) and
+/// the draw records (see IndirectDrawCompactor::DrawRecord). The compute shader tests
+/// every bounding box against the view frustum and, optionally, against a hierarchical
+/// depth buffer (Hi-Z), and appends the draw records of the visible objects to the
+/// output argument buffer. The number of appended records is written to the count buffer,
+/// so that the result can be directly used with the count-buffer path of
+/// IDeviceContext::DrawIndexedIndirect():
+///
+///     DrawIndexedIndirectAttribs DrawAttribs{pArgsBuffer, DRAW_FLAG_NONE, NumObjects};
+///     DrawAttribs.pCounterBuffer = pCountBuffer;
+///
+/// The Hi-Z texture is a full mip chain of the previous frame depth buffer where every
+/// texel of mip level N + 1 contains the farthest depth of the corresponding 2x2 texels
+/// of mip level N (the maximum depth or, with reverse Z, the minimum depth).
+///
+/// \remarks All methods must be called from the thread that owns the device context.
+///          The device must support compute shaders and draw indirect count buffers
+///          (DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER).
+class IndirectDrawCompactor
+{
+public:
+    /// The bounding box of one object, in world space. The w components are not used.
+    struct ObjectBounds
+    {
+        float4 Min;
+        float4 Max;
+    };
+    static_assert(sizeof(ObjectBounds) == 32, "The size of ObjectBounds must match the shader structure");
+
+    /// Draw record, laid out as the arguments of the indexed indirect draw command.
+    struct DrawRecord
+    {
+        Uint32 NumIndices            = 0;
+        Uint32 NumInstances          = 0;
+        Uint32 FirstIndexLocation    = 0;
+        Int32  BaseVertex            = 0;
+        Uint32 FirstInstanceLocation = 0;
+    };
+    static_assert(sizeof(DrawRecord) == 20, "The size of DrawRecord must match the indexed indirect draw arguments");
+
+    struct CreateInfo
+    {
+        IRenderDevice* pDevice = nullptr;
+
+        /// The compute shader thread group size.
+        Uint32 ThreadGroupSize = 64;
+
+        /// Whether to create the pipeline that performs Hi-Z occlusion culling.
+        bool EnableHiZ = true;
+
+        /// Whether the depth buffer uses reverse Z, i.e. the near plane is at depth 1.
+        bool ReverseZ = false;
+    };
+
+    explicit IndirectDrawCompactor(const CreateInfo& CI) noexcept(false);
+
+    // clang-format off
+    IndirectDrawCompactor           (const IndirectDrawCompactor&) = delete;
+    IndirectDrawCompactor& operator=(const IndirectDrawCompactor&) = delete;
+    IndirectDrawCompactor           (IndirectDrawCompactor&&)      = delete;
+    IndirectDrawCompactor& operator=(IndirectDrawCompactor&&)      = delete;
+    // clang-format on
+
+    /// Creates the buffers that can be used as the output of Compact() for up to MaxDraws draw commands.
+
+    /// \param [in]  MaxDraws     - The maximum number of draw commands.
+    /// \param [out] ppArgsBuffer - The address of the memory location where the pointer to the
+    ///                             indirect argument buffer will be written.
+    /// \param [out] ppCountBuffer - The address of the memory location where the pointer to the
+    ///                             count buffer will be written.
+    void CreateOutputBuffers(Uint32 MaxDraws, IBuffer** ppArgsBuffer, IBuffer** ppCountBuffer);
+
+    struct CompactAttribs
+    {
+        /// Structured buffer of ObjectBounds elements.
+        IBuffer* pBoundsBuffer = nullptr;
+
+        /// Structured buffer of DrawRecord elements. The draw record with index i is
+        /// appended to the output when the object with index i is visible.
+        IBuffer* pDrawRecordsBuffer = nullptr;
+
+        /// Output structured buffer of DrawRecord elements, see CreateOutputBuffers().
+        IBuffer* pArgsBuffer = nullptr;
+
+        /// Output count buffer, see CreateOutputBuffers(). The count is written to the
+        /// first Uint32 element.
+        IBuffer* pCountBuffer = nullptr;
+
+        /// The number of objects.
+        Uint32 NumObjects = 0;
+
+        /// The view frustum planes, see ExtractViewFrustumPlanesFromMatrix().
+        /// An object is culled if its bounding box is completely outside of any plane.
+        const ViewFrustum* pFrustum = nullptr;
+
+        /// The view-projection matrix that is used to project the bounding boxes onto the Hi-Z texture.
+        float4x4 ViewProj = float4x4::Identity();
+
+        /// Hi-Z texture view. If null, occlusion culling is not performed.
+        /// Must be null if the compactor was created with CreateInfo::EnableHiZ set to false.
+        ITextureView* pHiZ = nullptr;
+    };
+
+    /// Culls the objects and writes the compacted draw commands and their count to the output buffers.
+    void Compact(IDeviceContext* pContext, const CompactAttribs& Attribs);
+
+private:
+    struct CullingPipeline
+    {
+        RefCntAutoPtr<IPipelineState>         pPSO;
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    };
+    CullingPipeline CreatePipeline(bool EnableHiZ);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    RefCntAutoPtr<IBuffer>       m_pConstants;
+
+    const Uint32 m_ThreadGroupSize;
+    const bool   m_ReverseZ;
+
+    CullingPipeline m_FrustumPipeline;
+    CullingPipeline m_HiZPipeline;
+};
+
+} // namespace Diligent
@@ -0,0 +1,183 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the meshlet building functions and the reference meshlet culling shaders
+
+#include <vector>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Common/interface/BasicMath.hpp"
+#include "../../../Common/interface/ThreadPool.hpp"
+
+namespace Diligent
+{
+
+/// Meshlet, a small cluster of triangles that is processed by one mesh shader thread group.
+struct Meshlet
+{
+    /// The offset of the first meshlet vertex in MeshletData::VertexIndices.
+    Uint32 VertexOffset = 0;
+
+    /// The number of meshlet vertices.
+    Uint32 VertexCount = 0;
+
+    /// The offset of the first meshlet primitive in MeshletData::PrimitiveIndices.
+    Uint32 PrimitiveOffset = 0;
+
+    /// The number of meshlet primitives.
+    Uint32 PrimitiveCount = 0;
+};
+static_assert(sizeof(Meshlet) == 16, "The size of Meshlet must match the shader structure");
+
+/// Meshlet bounds that are used for culling.
+struct MeshletBounds
+{
+    /// Bounding sphere: the center in xyz, the radius in w.
+    float4 Sphere;
+
+    /// Normal cone: the axis in xyz, the cosine of the cutoff angle in w.
+    /// The meshlet is back-facing for a camera at position C if
+    ///
+    ///     dot(normalize(Sphere.xyz - C), Cone.xyz) >= Cone.w + Sphere.w / length(Sphere.xyz - C)
+    ///
+    /// The cone is degenerate when Cone.w is 1, and the meshlet is never culled by the cone test.
+    float4 Cone;
+};
+static_assert(sizeof(MeshletBounds) == 32, "The size of MeshletBounds must match the shader structure");
+
+/// Meshlet build output.
+struct MeshletData
+{
+    std::vector<Meshlet>       Meshlets;
+    std::vector<MeshletBounds> Bounds;
+
+    /// Indices of the meshlet vertices in the source vertex buffer.
+    std::vector<Uint32> VertexIndices;
+
+    /// Meshlet triangles, one element per triangle. Every element packs the three
+    /// local vertex indices, relative to Meshlet::VertexOffset, into bits 0-7, 8-15 and 16-23.
+    std::vector<Uint32> PrimitiveIndices;
+};
+
+/// Meshlet build attributes, see Diligent::BuildMeshlets.
+struct MeshletBuildAttribs
+{
+    /// Triangle list indices.
+    const Uint32* pIndices = nullptr;
+
+    /// The number of indices, must be a multiple of 3.
+    Uint32 NumIndices = 0;
+
+    /// Vertex positions, three floats per vertex.
+    const void* pPositions = nullptr;
+
+    /// The number of vertices.
+    Uint32 NumVertices = 0;
+
+    /// The byte stride between successive positions.
+    Uint32 PositionStride = sizeof(float) * 3;
+
+    /// The maximum number of vertices in one meshlet, must be in the range [3, 256].
+    Uint32 MaxVertices = 64;
+
+    /// The maximum number of triangles in one meshlet, must be in the range [1, 256].
+    Uint32 MaxPrimitives = 124;
+
+    /// Optional thread pool. If not null, the index buffer is split into chunks
+    /// of TrianglesPerTask triangles that are partitioned in parallel.
+    IThreadPool* pThreadPool = nullptr;
+
+    /// The number of triangles processed by one task when pThreadPool is not null.
+    Uint32 TrianglesPerTask = 16384;
+};
+
+/// Partitions the triangle list into meshlets.
+
+/// The triangles are added to the meshlets in the order of the index buffer, so the
+/// index buffer should be optimized for vertex locality. A new meshlet is started when
+/// the next triangle does not fit into the current one. When the work is split between
+/// threads, a meshlet never crosses the boundary of a task chunk.
+///
+/// \remarks The function throws an exception if the attributes are invalid.
+void BuildMeshlets(const MeshletBuildAttribs& Attribs, MeshletData& Data) noexcept(false);
+
+/// Computes the bounding sphere and the normal cone of the meshlet.
+MeshletBounds ComputeMeshletBounds(const MeshletData& Data, const Meshlet& Meshlet, const void* pPositions, Uint32 PositionStride);
+
+
+/// Constant buffer structure of the reference meshlet culling shader, see GetMeshletCullingShaderSource().
+struct MeshletCullingConstants
+{
+    float4x4 ViewProj;
+    float4   FrustumPlanes[6];
+    float4   CameraPos;
+    Uint32   NumMeshlets = 0;
+    Uint32   Padding[3]  = {};
+};
+static_assert(sizeof(MeshletCullingConstants) % 16 == 0, "Constant buffer size must be a multiple of 16 bytes");
+
+/// Initializes the meshlet culling constants. ViewProj is the view-projection matrix in the
+/// engine convention (it is transposed for the shader), IsGL indicates the OpenGL clip space.
+void InitMeshletCullingConstants(const float4x4& ViewProj, const float3& CameraPos, Uint32 NumMeshlets, bool IsGL, MeshletCullingConstants& Constants);
+
+/// Returns the HLSL source of the reference amplification shader that culls meshlets against
+/// the view frustum and the normal cone and dispatches one mesh shader group per visible meshlet.
+
+/// The shader uses the following resources:
+///
+///     cbuffer cbMeshletCulling                         - see MeshletCullingConstants
+///     StructuredBuffer<MeshletBounds> g_MeshletBounds  - see MeshletBounds
+///
+/// and passes the indices of the visible meshlets to the mesh shader in the payload:
+///
+///     struct MeshletPayload
+///     {
+///         uint MeshletIndices[MESHLET_AS_GROUP_SIZE];
+///     };
+///
+/// MESHLET_AS_GROUP_SIZE macro defines the thread group size and defaults to 32.
+/// The number of dispatched groups is (NumMeshlets + MESHLET_AS_GROUP_SIZE - 1) / MESHLET_AS_GROUP_SIZE.
+const char* GetMeshletCullingShaderSource();
+
+/// Returns the HLSL source of the reference mesh shader that draws the meshlets selected by
+/// the amplification shader returned by GetMeshletCullingShaderSource().
+
+/// The shader reads the meshlet data from the following buffers:
+///
+///     StructuredBuffer<Meshlet> g_Meshlets          - see Meshlet
+///     StructuredBuffer<uint>    g_VertexIndices     - see MeshletData::VertexIndices
+///     StructuredBuffer<uint>    g_PrimitiveIndices  - see MeshletData::PrimitiveIndices
+///     StructuredBuffer<float4>  g_Positions         - vertex positions, w is ignored
+///
+/// and outputs the clip-space position and the meshlet index. MESHLET_MAX_VERTICES and
+/// MESHLET_MAX_PRIMITIVES macros must match MeshletBuildAttribs and default to 64 and 124.
+const char* GetMeshletShaderSource();
+
+} // namespace Diligent
@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the offscreen swap chain
+
+#include <functional>
+
+#include "../../GraphicsEngine/interface/SwapChain.h"
+#include "AsyncReadbackQueue.hpp"
+
+namespace Diligent
+{
+
+/// Offscreen swap chain create info.
+struct OffscreenSwapChainCreateInfo
+{
+    /// Swap chain description.
+
+    /// BufferCount defines the maximum number of presented frames whose readbacks
+    /// may be in flight. Present() blocks when this number is exceeded.
+    SwapChainDesc Desc;
+
+    /// Thread pool that executes the frame callbacks.
+    /// If null, callbacks are executed by the thread that calls Present().
+    /// Multiple swap chains may share the same thread pool.
+    IThreadPool* pThreadPool = nullptr;
+
+    /// The maximum number of staging textures that are kept in the pool for reuse.
+    Uint32 MaxPooledResources = 4;
+
+    /// Function that is called when the data of a presented frame is available.
+
+    /// FrameId is the zero-based index of the frame in the order of Present() calls.
+    /// The data pointer is only valid while the callback is executed.
+    std::function<void(Uint64 FrameId, const AsyncReadbackQueue::ReadbackData& Data)> OnFrameReady;
+};
+
+/// Creates a swap chain that renders to offscreen textures and reads every presented frame back to the CPU.
+
+/// \param[in]  pDevice     - Render device.
+/// \param[in]  pContext    - Immediate device context that presents the frames.
+/// \param[in]  CreateInfo  - Swap chain create info, see Diligent::OffscreenSwapChainCreateInfo.
+/// \param[out] ppSwapChain - Memory location where pointer to the swap chain will be stored.
+///
+/// \remarks    The swap chain does not require a window or a presentation engine and can be used
+///             on headless systems, with the engine initialized without a native swap chain.
+///             Present() records the readback of the back buffer, flushes the context and delivers
+///             the frames completed by the GPU to the callback, so that the rendering of the
+///             next frames overlaps with the readback of the previous ones.
+///
+///             The swap chain does not bind itself to the device context: the application
+///             must set the back buffer RTV and depth buffer DSV as render targets explicitly.
+///             SetFullscreenMode() and SetWindowedMode() are not supported.
+void CreateOffscreenSwapChain(IRenderDevice*                      pDevice,
+                              IDeviceContext*                     pContext,
+                              const OffscreenSwapChainCreateInfo& CreateInfo,
+                              ISwapChain**                        ppSwapChain);
+
+} // namespace Diligent
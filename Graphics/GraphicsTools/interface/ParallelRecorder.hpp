@@ -0,0 +1,168 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ParallelRecorder class
+
+#include <functional>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/CommandList.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.hpp"
+#include "CommandListBatch.hpp"
+
+namespace Diligent
+{
+
+/// Helper class that records a list of draw items in parallel using deferred contexts.
+
+/// The items are split into contiguous ranges, one range per deferred context. Each range
+/// is recorded by a thread pool worker (the first range is recorded by the calling thread)
+/// into a context that inherits the render target, pipeline, viewport and scissor state
+/// given to Record(). All resulting command lists are then submitted to the immediate
+/// context with a single ExecuteCommandLists() call, in the order of the ranges.
+///
+/// \remarks Deferred contexts can't transition resource states, so all resources used by the items
+///          must be transitioned to the required states in the immediate context before calling Record(),
+///          and the record function should use RESOURCE_STATE_TRANSITION_MODE_VERIFY or RESOURCE_STATE_TRANSITION_MODE_NONE.
+///
+///          Every deferred context begins its own render pass instance, so if the inherited state
+///          uses a render pass, its attachments must use ATTACHMENT_LOAD_OP_LOAD and ATTACHMENT_STORE_OP_STORE.
+///          Render targets bound through the SetRenderTargets path do not have this restriction.
+class ParallelRecorder
+{
+public:
+    struct CreateInfo
+    {
+        /// Immediate context that executes the recorded command lists.
+        IDeviceContext* pImmediateCtx = nullptr;
+
+        /// Deferred contexts used for recording.
+        IDeviceContext* const* ppDeferredCtxs = nullptr;
+
+        /// The number of elements in ppDeferredCtxs array.
+        Uint32 NumDeferredCtxs = 0;
+
+        /// Thread pool that runs the recording workers.
+        /// If null, all ranges are recorded by the calling thread.
+        IThreadPool* pThreadPool = nullptr;
+
+        /// The minimum number of items recorded by a single context.
+        /// Small lists use fewer contexts as the cost of a command list is not negligible.
+        Uint32 MinItemsPerContext = 64;
+    };
+
+    /// State inherited by every deferred context before the first item is recorded.
+    struct InheritedState
+    {
+        /// Render targets to bind. Ignored if pRenderPass is not null.
+        ITextureView* const* ppRenderTargets  = nullptr;
+        Uint32               NumRenderTargets = 0;
+        ITextureView*        pDepthStencil    = nullptr;
+
+        /// Optional render pass to begin in every context.
+        const BeginRenderPassAttribs* pRenderPass = nullptr;
+
+        /// Optional pipeline state to set.
+        IPipelineState* pPSO = nullptr;
+
+        /// Viewports to set. If NumViewports is 0, the default viewport is used.
+        const Viewport* pViewports   = nullptr;
+        Uint32          NumViewports = 0;
+
+        /// Optional scissor rects to set.
+        const Rect* pScissorRects   = nullptr;
+        Uint32      NumScissorRects = 0;
+
+        /// Render target size used to set viewports and scissor rects.
+        /// If zero, the size of the first render target or the depth buffer is used.
+        Uint32 RTWidth  = 0;
+        Uint32 RTHeight = 0;
+
+        Uint32 StencilRef = 0;
+
+        /// Optional blend factors.
+        const float* pBlendFactors = nullptr;
+    };
+
+    /// Function that records items [FirstItem, FirstItem + NumItems) into the given context.
+
+    /// \remarks The function is called concurrently from multiple threads with different contexts.
+    ///          WorkerIndex is the index of the range and of the deferred context in CreateInfo::ppDeferredCtxs.
+    using RecordFuncType = std::function<void(IDeviceContext* pCtx, Uint32 WorkerIndex, Uint32 FirstItem, Uint32 NumItems)>;
+
+    explicit ParallelRecorder(const CreateInfo& CI) noexcept(false);
+
+    // clang-format off
+    ParallelRecorder           (const ParallelRecorder&) = delete;
+    ParallelRecorder& operator=(const ParallelRecorder&) = delete;
+    ParallelRecorder           (ParallelRecorder&&)      = delete;
+    ParallelRecorder& operator=(ParallelRecorder&&)      = delete;
+    // clang-format on
+
+    /// Records NumItems items in parallel and executes the command lists in the immediate context.
+
+    /// \param [in] State    - State inherited by all deferred contexts.
+    /// \param [in] NumItems - The total number of items to record.
+    /// \param [in] Record   - Function that records a range of items.
+    /// \param [in] pBatch   - Optional batch to add the command lists to instead of executing them.
+    ///                        This allows submitting several Record() calls, or the command lists
+    ///                        of other recorders, with a single ExecuteCommandLists() call.
+    ///
+    /// \remarks When the command lists are executed, the immediate context has no render targets or render pass bound
+    ///          and its committed state is reset, as is the case after any ExecuteCommandLists() call.
+    void Record(const InheritedState& State, Uint32 NumItems, const RecordFuncType& Record, CommandListBatch* pBatch = nullptr);
+
+    /// Finishes the frame in all deferred contexts.
+
+    /// \remarks This method must be called once per frame after all command lists recorded during
+    ///          the frame have been executed, see IDeviceContext::FinishFrame().
+    void FinishFrame();
+
+    /// Returns the maximum number of contexts that can be used for recording.
+    Uint32 GetNumContexts() const { return static_cast<Uint32>(m_DeferredCtxs.size()); }
+
+private:
+    void RecordRange(const InheritedState& State, Uint32 WorkerIndex, Uint32 FirstItem, Uint32 NumItems, const RecordFuncType& Record);
+
+private:
+    RefCntAutoPtr<IDeviceContext>              m_pImmediateCtx;
+    std::vector<RefCntAutoPtr<IDeviceContext>> m_DeferredCtxs;
+    RefCntAutoPtr<IThreadPool>                 m_pThreadPool;
+
+    const Uint32 m_MinItemsPerContext;
+
+    // Command lists are kept between frames to reuse the array storage.
+    std::vector<RefCntAutoPtr<ICommandList>> m_CmdLists;
+    std::vector<ICommandList*>               m_CmdListPtrs;
+    std::vector<RefCntAutoPtr<IAsyncTask>>   m_Tasks;
+};
+
+} // namespace Diligent
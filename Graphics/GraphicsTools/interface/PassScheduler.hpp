@@ -0,0 +1,234 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::PassScheduler class
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Fence.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Helper class that schedules passes with declared resource accesses between
+/// the graphics and the asynchronous compute queue.
+
+/// An application adds passes in the order they must be executed and declares the
+/// state every resource is accessed in by every pass. When Execute() is called, the scheduler:
+/// - Runs compute passes in the asynchronous compute context (if one is provided),
+///   so that they overlap with the graphics work;
+/// - Inserts fence waits between the queues only where a pass depends on a pass
+///   executed by the other queue;
+/// - Transitions resources to the required states before every pass, using split
+///   barriers when there are other passes on the same queue between two accesses.
+///
+/// \remarks Passes must not transition the resources they declare themselves, i.e. they
+///          should use RESOURCE_STATE_TRANSITION_MODE_VERIFY or RESOURCE_STATE_TRANSITION_MODE_NONE.
+///          The states of the resources must be known to the engine, and resources that are
+///          accessed by both queues must be created with ImmediateContextMask that includes both contexts.
+///
+///          The scheduler tracks dependencies between passes executed by different Execute() calls,
+///          so the same instance should be used every frame.
+class PassScheduler
+{
+public:
+    enum PASS_TYPE : Uint8
+    {
+        /// The pass is executed in the graphics context.
+        PASS_TYPE_GRAPHICS = 0,
+
+        /// The pass is executed in the asynchronous compute context, or in the graphics
+        /// context if no compute context was provided.
+        PASS_TYPE_COMPUTE
+    };
+
+    /// Resource access declared by a pass.
+    struct ResourceAccess
+    {
+        /// Texture, buffer, BLAS or TLAS accessed by the pass.
+        IDeviceObject* pResource = nullptr;
+
+        /// The state the resource must be in when the pass is executed.
+        RESOURCE_STATE State = RESOURCE_STATE_UNKNOWN;
+
+        constexpr ResourceAccess() noexcept {}
+
+        constexpr ResourceAccess(IDeviceObject* _pResource, RESOURCE_STATE _State) noexcept :
+            pResource{_pResource},
+            State{_State}
+        {}
+    };
+
+    /// Pass function that records the pass commands into the given context.
+    using ExecutePassFuncType = std::function<void(IDeviceContext* pCtx)>;
+
+    struct CreateInfo
+    {
+        IRenderDevice* pDevice = nullptr;
+
+        /// Immediate graphics context.
+        IDeviceContext* pGraphicsCtx = nullptr;
+
+        /// Optional immediate compute context that uses a different hardware queue.
+        IDeviceContext* pComputeCtx = nullptr;
+    };
+
+    explicit PassScheduler(const CreateInfo& CI) noexcept(false);
+
+    // clang-format off
+    PassScheduler           (const PassScheduler&) = delete;
+    PassScheduler& operator=(const PassScheduler&) = delete;
+    PassScheduler           (PassScheduler&&)      = delete;
+    PassScheduler& operator=(PassScheduler&&)      = delete;
+    // clang-format on
+
+    /// Adds a pass to the list of passes executed by the next Execute() call.
+
+    /// \param [in] Name         - Pass name, used for debug groups.
+    /// \param [in] Type         - Pass type.
+    /// \param [in] pAccesses    - Resources accessed by the pass.
+    /// \param [in] NumAccesses  - The number of elements in pAccesses array.
+    /// \param [in] Execute      - Function that records the pass commands.
+    void AddPass(const char*           Name,
+                 PASS_TYPE             Type,
+                 const ResourceAccess* pAccesses,
+                 Uint32                NumAccesses,
+                 ExecutePassFuncType   Execute);
+
+    /// Executes all passes added since the last call and flushes the contexts.
+    void Execute();
+
+    /// Returns the context that the passes of the given type are executed in.
+    IDeviceContext* GetContext(PASS_TYPE Type) { return m_Queues[GetQueueIndex(Type)].pCtx; }
+
+    /// Returns true if the compute passes run in a separate compute context.
+    bool HasAsyncCompute() const { return m_NumQueues > 1; }
+
+private:
+    static constexpr Uint32 MaxQueues = 2;
+
+    Uint32 GetQueueIndex(PASS_TYPE Type) const { return Type == PASS_TYPE_COMPUTE && m_NumQueues > 1 ? 1 : 0; }
+
+    struct Pass
+    {
+        std::string                 Name;
+        Uint32                      QueueIdx = 0;
+        std::vector<ResourceAccess> Accesses;
+        ExecutePassFuncType         Execute;
+
+        // Barriers executed before the pass
+        std::vector<StateTransitionDesc> BarriersBefore;
+        // Barriers executed after the pass
+        std::vector<StateTransitionDesc> BarriersAfter;
+
+        // For every queue, the index of the latest pass in the current frame this pass must wait for, or -1.
+        int WaitPass[MaxQueues] = {-1, -1};
+
+        // For every queue, the fence value from the previous frames this pass must wait for, or 0.
+        Uint64 WaitValue[MaxQueues] = {};
+
+        // Whether the queue must signal its fence after the pass
+        bool Signal = false;
+
+        // Fence value signaled after the pass
+        Uint64 SignalValue = 0;
+    };
+
+    // Point in the command stream after which a resource access is complete
+    struct SyncPoint
+    {
+        // Pass index in the current frame, or -1 if the access is from a previous frame.
+        int Pass = -1;
+
+        // Fence value signaled by the queue after the access, if the access is from a previous frame.
+        Uint64 Value = 0;
+
+        bool IsValid() const { return Pass >= 0 || Value != 0; }
+    };
+
+    struct ResourceHistory
+    {
+        RefCntWeakPtr<IDeviceObject> wpResource;
+
+        // The last write to the resource
+        SyncPoint LastWrite;
+        Uint32    LastWriteQueue = 0;
+
+        // The last read on every queue after the last write
+        SyncPoint LastRead[MaxQueues];
+
+        // The pass that accessed the resource last in the current frame and the queue it was executed in
+        int    LastPass      = -1;
+        Uint32 LastPassQueue = 0;
+
+        // The expected state after the last pass of the current frame
+        RESOURCE_STATE State = RESOURCE_STATE_UNKNOWN;
+    };
+
+    ResourceHistory& GetHistory(IDeviceObject* pResource);
+
+    void AddDependency(Pass& Dst, Uint32 SrcQueue, const SyncPoint& Src);
+
+    void SchedulePass(int PassIdx);
+
+    void ExecutePass(Pass& P);
+
+    void Signal(Uint32 QueueIdx, Uint64& Value);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    struct Queue
+    {
+        RefCntAutoPtr<IDeviceContext> pCtx;
+        RefCntAutoPtr<IFence>         pFence;
+
+        // The last value signaled on the fence
+        Uint64 LastSignaledValue = 0;
+
+        // For every queue, the last fence value this queue has waited for
+        Uint64 LastWaitedValue[MaxQueues] = {};
+    };
+    Queue        m_Queues[MaxQueues];
+    const Uint32 m_NumQueues;
+
+    // Pass 0 is the prologue pass that is executed by the graphics queue and performs the
+    // state transitions that the compute queue is not allowed to do.
+    std::vector<Pass> m_Passes;
+
+    std::unordered_map<const IDeviceObject*, ResourceHistory> m_Resources;
+};
+
+} // namespace Diligent
@@ -69,6 +69,32 @@ struct RenderStateCacheCreateInfo
     /// shaders. If null, original source factory will be used.
     IShaderSourceInputStreamFactory* pReloadSource DEFAULT_INITIALIZER(nullptr);
 
+    /// Optional path to the file where the cache incrementally persists render states.
+
+    /// \remarks   If the path is not null, the cache loads render states from the file
+    ///             when it is created, and appends new shaders and pipeline states to the
+    ///             file from a background thread as they are added to the cache. The file is
+    ///             compacted when the number of appended records reaches CompactionThreshold.
+    ///             If the application terminates unexpectedly, only the last few states may
+    ///             be lost. IRenderStateCache::WriteToBlob() and IRenderStateCache::WriteToStream()
+    ///             can still be used to produce the complete cache archive.
+    const Char* FilePath DEFAULT_INITIALIZER(nullptr);
+
+    /// An optional thread pool to write the file from.
+
+    /// \remarks   The pool must have at least one worker thread. If the pool is null,
+    ///             the cache creates its own pool with one worker thread.
+    ///             This member is ignored if FilePath is null.
+#if DILIGENT_CPP_INTERFACE
+    class IThreadPool*  pWriterThreadPool DEFAULT_INITIALIZER(nullptr);
+#else
+    struct IThreadPool* pWriterThreadPool;
+#endif
+
+    /// The number of records in the file that triggers compaction.
+    /// If zero, the file is never compacted. This member is ignored if FilePath is null.
+    Uint32 CompactionThreshold DEFAULT_INITIALIZER(64);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr RenderStateCacheCreateInfo() noexcept
     {}
@@ -213,6 +239,12 @@ DILIGENT_BEGIN_INTERFACE(IRenderStateCache, IObject)
     ///
     /// \remars     Reloading is only enabled if the cache was created with the EnableHotReload member of
     ///             RenderStateCacheCreateInfo member set to true.
+    ///
+    ///             Only the shaders whose source file or any of its includes has changed are recompiled,
+    ///             and only the pipelines that use these shaders are re-created, unless ReloadGraphicsPipeline
+    ///             is not null, in which case all pipelines are processed. New shaders and pipelines are created
+    ///             in parallel (except for OpenGL), and replace the old ones when all of them are ready.
+    ///             Diligent::FileWatcher may be used to call this method when the source files change.
     VIRTUAL Uint32 METHOD(Reload)(THIS_
                                   ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline DEFAULT_VALUE(nullptr), 
                                   void*                              pUserData              DEFAULT_VALUE(nullptr)) PURE;
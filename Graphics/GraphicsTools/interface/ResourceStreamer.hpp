@@ -0,0 +1,209 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ResourceStreamer class
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Fence.h"
+#include "../../GraphicsAccessories/interface/RingBuffer.hpp"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.hpp"
+
+namespace Diligent
+{
+
+/// Helper class that streams file ranges into buffers and textures.
+
+/// File data is read by thread pool workers directly into a persistently mapped staging buffer,
+/// so that every byte is written to system memory only once, and is then copied to the destination
+/// resource by the GPU. Every request is assigned a fence value that is signaled when the data
+/// is available in the destination resource, see GetFence().
+///
+/// Compressed file ranges are supported through the user-provided decompression function
+/// that writes the decompressed data directly into the staging memory.
+///
+/// \remarks The streamer requires persistently mapped staging buffers and is only supported
+///          in Direct3D12 and Vulkan backends.
+///
+///          Requests are submitted to the context in the order they were enqueued.
+///          Fence values are signaled by the GPU only after the context is flushed,
+///          see IDeviceContext::Flush().
+class ResourceStreamer
+{
+public:
+    /// Function that decompresses SrcSize bytes from pSrc into DstSize bytes at pDst.
+
+    /// \remarks The function is called concurrently from multiple threads.
+    ///          pDst may point to write-combined memory and should not be read from.
+    using DecompressFuncType = std::function<bool(const void* pSrc, size_t SrcSize, void* pDst, size_t DstSize)>;
+
+    struct CreateInfo
+    {
+        IRenderDevice*  pDevice  = nullptr;
+        IDeviceContext* pContext = nullptr;
+
+        /// Thread pool that runs the file reads.
+        /// If null, files are read by the thread that calls Process().
+        IThreadPool* pThreadPool = nullptr;
+
+        /// Staging buffer size. A single request can't be larger than this size.
+        Uint64 StagingBufferSize = Uint64{64} << 20;
+
+        /// The maximum number of file reads executed at the same time.
+        Uint32 MaxConcurrentReads = 8;
+
+        /// Optional decompression function, see ReadRequest::UncompressedSize.
+        DecompressFuncType Decompress = nullptr;
+    };
+
+    /// Source file range.
+    struct ReadRequest
+    {
+        const char* FilePath = nullptr;
+
+        /// Offset of the data in the file.
+        Uint64 Offset = 0;
+
+        /// Size of the data in the file.
+        Uint64 Size = 0;
+
+        /// If not zero, the data in the file is compressed and UncompressedSize is the size
+        /// of the data after decompression with CreateInfo::Decompress.
+        Uint64 UncompressedSize = 0;
+    };
+
+    /// Request to read a file range into a buffer.
+    struct BufferReadRequest : ReadRequest
+    {
+        IBuffer* pDstBuffer = nullptr;
+        Uint64   DstOffset  = 0;
+    };
+
+    /// Request to read a file range into a texture subresource.
+    struct TextureReadRequest : ReadRequest
+    {
+        ITexture* pDstTexture = nullptr;
+        Uint32    MipLevel    = 0;
+        Uint32    Slice       = 0;
+
+        /// Destination region. If null, the entire subresource is updated.
+        const Box* pDstBox = nullptr;
+
+        /// Row and depth slice strides of the (decompressed) data in the file.
+        /// If zero, the data is assumed to be tightly packed.
+        Uint64 Stride      = 0;
+        Uint64 DepthStride = 0;
+    };
+
+    explicit ResourceStreamer(const CreateInfo& CI) noexcept(false);
+    ~ResourceStreamer();
+
+    // clang-format off
+    ResourceStreamer           (const ResourceStreamer&) = delete;
+    ResourceStreamer& operator=(const ResourceStreamer&) = delete;
+    ResourceStreamer           (ResourceStreamer&&)      = delete;
+    ResourceStreamer& operator=(ResourceStreamer&&)      = delete;
+    // clang-format on
+
+    /// Enqueues a buffer read request and returns the fence value that will be signaled
+    /// when the data is available in the buffer.
+
+    /// \remarks This method is thread-safe. The request is started by Process().
+    Uint64 Enqueue(const BufferReadRequest& Request);
+
+    /// Enqueues a texture read request and returns the fence value that will be signaled
+    /// when the data is available in the texture.
+
+    /// \remarks This method is thread-safe. The request is started by Process().
+    Uint64 Enqueue(const TextureReadRequest& Request);
+
+    /// Starts pending file reads and submits GPU copies for completed reads.
+
+    /// \remarks This method must be called from the thread that owns the device context,
+    ///          typically once per frame.
+    ///
+    ///          If a request fails, an error is logged and its fence value is still signaled,
+    ///          and the destination contents are undefined.
+    void Process();
+
+    /// Processes all enqueued requests, waiting for the file reads and the staging space
+    /// to become available, and flushes the context.
+    void Flush();
+
+    /// Returns the fence that is signaled with the values returned by Enqueue().
+    IFence* GetFence() { return m_pFence; }
+
+    /// Returns true if the request with the given fence value has been completed by the GPU.
+    bool IsComplete(Uint64 FenceValue) { return m_pFence->GetCompletedValue() >= FenceValue; }
+
+    /// Returns the number of requests that have not been submitted to the context yet.
+    size_t GetNumPendingRequests() const { return m_NumPendingRequests.load(); }
+
+private:
+    struct Request;
+
+    Uint64 EnqueueRequest(std::unique_ptr<Request>&& pRequest);
+    bool   StartRead(Request& Req);
+    bool   ReadData(const Request& Req, Uint8* pDst) const;
+    void   SubmitRequest(Request& Req);
+
+private:
+    RefCntAutoPtr<IRenderDevice>  m_pDevice;
+    RefCntAutoPtr<IDeviceContext> m_pContext;
+    RefCntAutoPtr<IThreadPool>    m_pThreadPool;
+    RefCntAutoPtr<IFence>         m_pFence;
+    RefCntAutoPtr<IBuffer>        m_pStagingBuffer;
+
+    const Uint32             m_MaxConcurrentReads;
+    const DecompressFuncType m_Decompress;
+
+    Uint8*     m_pStagingData = nullptr;
+    RingBuffer m_StagingRing;
+
+    // Requests that have not been started yet.
+    std::mutex                           m_PendingRequestsMtx;
+    std::deque<std::unique_ptr<Request>> m_PendingRequests;
+    Uint64                               m_NextFenceValue = 1;
+    std::atomic<size_t>                  m_NumPendingRequests{0};
+
+    // Requests whose reads have been started, in fence value order.
+    std::deque<std::unique_ptr<Request>> m_ActiveRequests;
+
+    Uint64 m_LastSignaledValue = 0;
+};
+
+} // namespace Diligent
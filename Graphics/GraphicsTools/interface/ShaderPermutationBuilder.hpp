@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShaderPermutationBuilder class
+
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.hpp"
+#include "RenderStateCache.h"
+#include "ShaderMacroHelper.hpp"
+
+namespace Diligent
+{
+
+/// Helper class that creates all permutations of a shader defined by a macro matrix.
+
+/// Every macro in the matrix takes one of its values, and every combination of values is a permutation.
+/// Permutations are indexed so that the first macro changes fastest, and are enumerated on demand.
+///
+/// Before compiling, permutations that differ only in the values of macros that the shader source
+/// never references are merged, since they produce identical preprocessed code. Only one shader
+/// per group is created, and all permutations of the group share the same shader object.
+class ShaderPermutationBuilder
+{
+public:
+    /// Adds a macro that takes every value from Values in turn.
+    void AddMacro(const Char* Name, std::vector<std::string> Values);
+
+    /// Adds a macro that takes every value from Values in turn.
+    /// The values are formatted the same way as by ShaderMacroHelper::AddShaderMacro().
+    template <typename DefinitionType>
+    void AddMacro(const Char* Name, std::initializer_list<DefinitionType> Values)
+    {
+        std::vector<std::string> Definitions;
+        Definitions.reserve(Values.size());
+        for (const auto& Value : Values)
+        {
+            ShaderMacroHelper Helper;
+            Helper.AddShaderMacro(Name, Value);
+            Definitions.emplace_back(static_cast<const ShaderMacro*>(Helper)[0].Definition);
+        }
+        AddMacro(Name, std::move(Definitions));
+    }
+
+    /// Returns the total number of permutations.
+    Uint32 GetNumPermutations() const;
+
+    /// Adds the macros of the given permutation to Macros.
+    void GetPermutationMacros(Uint32 Permutation, ShaderMacroHelper& Macros) const;
+
+    /// Finds permutations that produce identical preprocessed shader source.
+
+    /// \param [in] ShaderCI - Shader create info. Includes are resolved through ShaderCI.pShaderSourceStreamFactory.
+    ///
+    /// \return     For every permutation, the index of the first permutation that produces the
+    ///             same preprocessed source. Unique permutations refer to themselves.
+    ///
+    /// \remarks    The shader is not preprocessed for every permutation. Instead, a macro from the matrix
+    ///             is considered significant if its name occurs as an identifier in the shader source
+    ///             (with all includes unrolled) or in any macro definition. Permutations that only differ
+    ///             in insignificant macros are merged. If the source can't be read or uses token pasting,
+    ///             all macros are considered significant.
+    std::vector<Uint32> FindUniquePermutations(const ShaderCreateInfo& ShaderCI) const noexcept(false);
+
+    struct CreateShadersAttribs
+    {
+        /// Render device that creates the shaders.
+        IRenderDevice* pDevice = nullptr;
+
+        /// Optional render state cache. If not null, shaders are created through the cache.
+        IRenderStateCache* pStateCache = nullptr;
+
+        /// Optional thread pool that compiles the shaders in parallel.
+        /// If null, all shaders are compiled by the calling thread.
+        IThreadPool* pThreadPool = nullptr;
+    };
+
+    /// Creates shaders for all permutations.
+
+    /// \param [in] ShaderCI - Shader create info. The macros of every permutation are added to ShaderCI.Macros,
+    ///                        which must not define any macro from the matrix.
+    /// \param [in] Attribs  - Shader creation attributes.
+    ///
+    /// \return     Shaders for every permutation. Permutations that produce identical preprocessed source
+    ///             share the same shader object. If a shader fails to compile, the entries of all
+    ///             permutations in its group are null.
+    std::vector<RefCntAutoPtr<IShader>> CreateShaders(const ShaderCreateInfo& ShaderCI, const CreateShadersAttribs& Attribs) const noexcept(false);
+
+private:
+    struct MacroInfo
+    {
+        std::string              Name;
+        std::vector<std::string> Values;
+    };
+    std::vector<MacroInfo> m_Macros;
+};
+
+} // namespace Diligent
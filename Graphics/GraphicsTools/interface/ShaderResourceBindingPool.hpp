@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShaderResourceBindingPool class
+
+#include <mutex>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/PipelineResourceSignature.h"
+#include "../../GraphicsEngine/interface/ShaderResourceBinding.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Pool that recycles shader resource binding objects of a single pipeline resource signature.
+
+/// Creating and destroying an SRB allocates the resource cache and variable data from the
+/// signature's memory allocator and, in next-gen backends, allocates descriptor sets that are
+/// released through the device release queue. Transient SRBs (e.g. ones created every frame)
+/// can instead be returned to the pool and reused with their caches and descriptor sets intact.
+///
+/// When an SRB is recycled, all its dynamic variables are unbound, while static and mutable
+/// resources are kept. The application thus only needs to rebind dynamic variables when it
+/// reuses the SRB. Mutable resources of a recycled SRB must not be changed while the GPU may
+/// still be using the SRB, the same as for any other SRB.
+///
+/// \remarks    All methods are thread-safe.
+class ShaderResourceBindingPool
+{
+public:
+    struct CreateInfo
+    {
+        /// Signature that creates the SRBs.
+        IPipelineResourceSignature* pSignature = nullptr;
+
+        /// Whether to initialize static resources in new SRBs,
+        /// see IPipelineResourceSignature::CreateShaderResourceBinding().
+        bool InitStaticResources = true;
+
+        /// The maximum number of SRBs that are kept in the pool for reuse.
+        /// Recycled SRBs that exceed this limit are released.
+        Uint32 MaxPooledSRBs = 256;
+    };
+
+    explicit ShaderResourceBindingPool(const CreateInfo& CI) noexcept(false);
+
+    // clang-format off
+    ShaderResourceBindingPool           (const ShaderResourceBindingPool&) = delete;
+    ShaderResourceBindingPool& operator=(const ShaderResourceBindingPool&) = delete;
+    ShaderResourceBindingPool           (ShaderResourceBindingPool&&)      = delete;
+    ShaderResourceBindingPool& operator=(ShaderResourceBindingPool&&)      = delete;
+    // clang-format on
+
+    /// Returns an SRB from the pool or creates a new one if the pool is empty.
+    RefCntAutoPtr<IShaderResourceBinding> Allocate();
+
+    /// Unbinds dynamic variables and returns the SRB to the pool.
+
+    /// \param [in] pSRB - SRB to recycle. It must have been created by the signature of this pool.
+    ///
+    /// \remarks    The application must not use the SRB after it has been recycled.
+    void Recycle(IShaderResourceBinding* pSRB);
+
+    /// Releases all SRBs in the pool.
+    void Clear();
+
+    /// Returns the number of SRBs in the pool that are ready for reuse.
+    size_t GetNumPooledSRBs() const;
+
+private:
+    void InitResetUpdates(IShaderResourceBinding* pSRB);
+
+private:
+    RefCntAutoPtr<IPipelineResourceSignature> m_pSignature;
+
+    const bool   m_InitStaticResources;
+    const Uint32 m_MaxPooledSRBs;
+
+    mutable std::mutex                                 m_PoolMtx;
+    std::vector<RefCntAutoPtr<IShaderResourceBinding>> m_PooledSRBs;
+
+    // Updates that unbind every element of every dynamic variable.
+    // Initialized from the first created SRB as variable indices are the same for all SRBs of the signature.
+    std::vector<ShaderResourceVariableUpdate> m_ResetUpdates;
+    bool                                      m_ResetUpdatesInitialized = false;
+};
+
+} // namespace Diligent
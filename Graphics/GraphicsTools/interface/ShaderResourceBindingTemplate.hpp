@@ -0,0 +1,107 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::ShaderResourceBindingTemplate class
+
+#include <vector>
+
+#include "../../GraphicsEngine/interface/ShaderResourceBinding.h"
+#include "../../GraphicsEngine/interface/PipelineResourceSignature.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Binding template that resolves shader resource variable names to indices once
+/// and then updates any SRB of a compatible signature with a single IShaderResourceBinding::SetResources() call.
+
+/// The template stores one slot per variable description passed to the constructor.
+/// Objects assigned to the slots are not reference-counted: the application must keep
+/// them alive until Apply() returns.
+class ShaderResourceBindingTemplate
+{
+public:
+    /// Variable description
+    struct VariableDesc
+    {
+        /// Shader stage of the variable.
+        SHADER_TYPE ShaderType = SHADER_TYPE_UNKNOWN;
+
+        /// Variable name.
+        const Char* Name = nullptr;
+
+        /// Array element that the slot updates.
+        Uint32 ArrayIndex = 0;
+    };
+
+    /// \param [in] pSRB         - Shader resource binding used to resolve variable names.
+    ///                            Any SRB created by the same signature may be used.
+    /// \param [in] pVariables   - Array of variable descriptions, one per slot.
+    /// \param [in] NumVariables - The number of elements in pVariables array.
+    ///
+    /// \remarks    Variables that are not found are reported and their slots are ignored by Apply().
+    ShaderResourceBindingTemplate(IShaderResourceBinding* pSRB,
+                                  const VariableDesc*     pVariables,
+                                  Uint32                  NumVariables);
+
+    // clang-format off
+    ShaderResourceBindingTemplate           (const ShaderResourceBindingTemplate&) = default;
+    ShaderResourceBindingTemplate& operator=(const ShaderResourceBindingTemplate&) = default;
+    ShaderResourceBindingTemplate           (ShaderResourceBindingTemplate&&)      = default;
+    ShaderResourceBindingTemplate& operator=(ShaderResourceBindingTemplate&&)      = default;
+    // clang-format on
+
+    /// Returns the number of slots in the template.
+    Uint32 GetNumSlots() const { return static_cast<Uint32>(m_Updates.size()); }
+
+    /// Returns true if the variable of the given slot was found in the signature.
+    bool IsResolved(Uint32 Slot) const;
+
+    /// Sets the object that Apply() will bind to the given slot.
+    void SetResource(Uint32 Slot, IDeviceObject* pObject);
+
+    /// Sets the constant buffer range that Apply() will bind to the given slot.
+    void SetBufferRange(Uint32 Slot, IDeviceObject* pBuffer, Uint64 Offset, Uint64 Size);
+
+    /// Binds the objects of all resolved slots to the SRB.
+
+    /// \param [in] pSRB  - Shader resource binding to update. Its signature must be compatible
+    ///                     with the signature of the SRB the template was created from.
+    /// \param [in] Flags - Flags passed to IShaderResourceBinding::SetResources().
+    void Apply(IShaderResourceBinding* pSRB, SET_SHADER_RESOURCE_FLAGS Flags = SET_SHADER_RESOURCE_FLAG_NONE) const;
+
+private:
+    RefCntAutoPtr<IPipelineResourceSignature> m_pSignature;
+
+    // Unresolved slots have SHADER_TYPE_UNKNOWN and are skipped by SetResources().
+    std::vector<ShaderResourceVariableUpdate> m_Updates;
+};
+
+} // namespace Diligent
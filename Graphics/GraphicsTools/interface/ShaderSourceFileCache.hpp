@@ -0,0 +1,119 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::ShaderSourceFileCache class
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "../../../Graphics/GraphicsEngine/interface/Shader.h"
+#include "../../../Common/interface/ObjectBase.hpp"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "XXH128Hasher.hpp"
+
+namespace Diligent
+{
+
+/// Shader source stream factory that caches the files loaded through another factory.
+
+/// Every file is loaded from the underlying factory once and is then served from memory,
+/// together with the hash of its contents. The cache is thread-safe and can be shared
+/// by all shaders that are created from the same set of files.
+///
+/// When shader create info that references the cache is hashed by XXH128State (e.g. by
+/// the render state cache or the bytecode cache), the cached file hashes are used
+/// instead of hashing the contents of every include file again.
+class ShaderSourceFileCache final : public ObjectBase<IShaderSourceInputStreamFactory>
+{
+public:
+    using TBase = ObjectBase<IShaderSourceInputStreamFactory>;
+
+    // {DC70F9A0-47C7-448F-96A7-10C338C91D60}
+    static constexpr INTERFACE_ID IID_InternalImpl =
+        {0xdc70f9a0, 0x47c7, 0x448f, {0x96, 0xa7, 0x10, 0xc3, 0x38, 0xc9, 0x1d, 0x60}};
+
+    /// Callback that returns the modification timestamp of the file with the given name.
+    using GetFileTimestampCallbackType = std::function<Uint64(const Char* Name)>;
+
+    struct CreateInfo
+    {
+        /// The factory to load the files from. Must not be null.
+        IShaderSourceInputStreamFactory* pFactory = nullptr;
+
+        /// Optional callback that returns the file timestamp, see GetFileTimestampCallbackType.
+        /// If the callback is provided, it is called every time a stream is requested, and
+        /// the file is reloaded when its timestamp changes. Otherwise, the files are
+        /// never reloaded unless they are explicitly invalidated.
+        GetFileTimestampCallbackType GetFileTimestamp;
+    };
+
+    static RefCntAutoPtr<ShaderSourceFileCache> Create(const CreateInfo& CI);
+
+    ShaderSourceFileCache(IReferenceCounters* pRefCounters, const CreateInfo& CI);
+
+    IMPLEMENT_QUERY_INTERFACE2_IN_PLACE(IID_IShaderSourceInputStreamFactory, IID_InternalImpl, TBase)
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final;
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream2(const Char*                             Name,
+                                                       CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
+                                                       IFileStream**                           ppStream) override final;
+
+    /// Returns the hash of the cached file contents.
+
+    /// \param [in]  Name - File name, as it was passed to CreateInputStream.
+    /// \param [out] Hash - The hash of the file contents.
+    /// \return     true if the file is in the cache, and false otherwise.
+    bool GetFileHash(const Char* Name, XXH128Hash& Hash);
+
+    /// Removes the file from the cache, so that it is reloaded next time it is requested.
+    void InvalidateFile(const Char* Name);
+
+    /// Removes all files from the cache.
+    void Clear();
+
+private:
+    struct FileInfo
+    {
+        RefCntAutoPtr<IDataBlob> pData;
+        XXH128Hash               Hash;
+        Uint64                   Timestamp = 0;
+    };
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> m_pFactory;
+    const GetFileTimestampCallbackType             m_GetFileTimestamp;
+
+    std::mutex                                m_FilesMtx;
+    std::unordered_map<std::string, FileInfo> m_Files;
+};
+
+} // namespace Diligent
@@ -0,0 +1,149 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShadingRateMapGenerator class
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/PipelineState.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/BasicMath.hpp"
+
+namespace Diligent
+{
+
+/// Helper class that generates the shading rate texture for texture-based variable rate shading.
+
+/// The generator runs a compute shader that processes one shading rate tile per thread group.
+/// For every tile, it computes the average luminance gradient along each axis of the previous
+/// frame color and, optionally, the average motion of the tile. The shading rate along an axis
+/// is reduced when the gradient is below the luminance threshold; fast motion raises the threshold,
+/// as motion blur and temporal filtering hide the detail. The selected rates are remapped to the
+/// closest rates supported by the device, see ShadingRateProperties::ShadingRates.
+///
+/// The shading rate texture uses the format reported by ShadingRateProperties::Format:
+/// TEX_FORMAT_R8_UINT with SHADING_RATE values for SHADING_RATE_FORMAT_PALETTE, and
+/// TEX_FORMAT_RG8_UNORM with fragment densities for SHADING_RATE_FORMAT_UNORM8. The tile size
+/// is ShadingRateProperties::MaxTileSize.
+///
+/// \remarks All methods must be called from the thread that owns the device context.
+///          SHADING_RATE_FORMAT_COL_ROW_FP32 (Metal rasterization rate maps) is not supported,
+///          as the shading rate is not defined by a texture.
+class ShadingRateMapGenerator
+{
+public:
+    struct CreateInfo
+    {
+        IRenderDevice* pDevice = nullptr;
+
+        /// The number of samples of the render target the shading rate is used with.
+        /// Only the shading rates that support this sample count are used.
+        Uint32 SampleCount = 1;
+
+        /// Whether the generator reads motion vectors.
+        bool UseMotionVectors = true;
+    };
+
+    explicit ShadingRateMapGenerator(const CreateInfo& CI) noexcept(false);
+
+    // clang-format off
+    ShadingRateMapGenerator           (const ShadingRateMapGenerator&) = delete;
+    ShadingRateMapGenerator& operator=(const ShadingRateMapGenerator&) = delete;
+    ShadingRateMapGenerator           (ShadingRateMapGenerator&&)      = delete;
+    ShadingRateMapGenerator& operator=(ShadingRateMapGenerator&&)      = delete;
+    // clang-format on
+
+    struct GenerateAttribs
+    {
+        /// Shader resource view of the previous frame color. The luminance is computed from the
+        /// RGB channels as they are stored in the texture, so the texture should be in display space,
+        /// e.g. after tone mapping.
+        ITextureView* pColor = nullptr;
+
+        /// Shader resource view of the previous frame motion vectors. Must not be null if the
+        /// generator was created with CreateInfo::UseMotionVectors set to true, and is ignored otherwise.
+        ITextureView* pMotionVectors = nullptr;
+
+        /// The scale that converts the motion vectors to pixels. For motion vectors in texture
+        /// coordinate space, this is the render target size.
+        float2 MotionVectorScale = float2{1, 1};
+
+        /// The average luminance difference between adjacent pixels below which the shading
+        /// rate along an axis is halved. A four times reduction requires a twice lower difference.
+        float LuminanceThreshold = 1.f / 64.f;
+
+        /// How much the luminance threshold grows per pixel of motion.
+        float MotionSensitivity = 0.25f;
+    };
+
+    /// Generates the shading rate texture for the color texture resolution.
+    /// The shading rate texture is recreated when the resolution changes.
+    void Generate(IDeviceContext* pContext, const GenerateAttribs& Attribs);
+
+    /// Returns the shading rate texture, or null if Generate() has not been called.
+    ITexture* GetShadingRateTexture() const { return m_pShadingRateTex.RawPtr<ITexture>(); }
+
+    /// Returns the shading rate view that can be passed to IDeviceContext::SetRenderTargetsExt(),
+    /// or null if Generate() has not been called.
+    ITextureView* GetShadingRateView() const { return m_pShadingRateView.RawPtr<ITextureView>(); }
+
+    /// Returns the size of the tile that corresponds to one texel of the shading rate texture.
+    const Uint32* GetTileSize() const { return m_TileSize; }
+
+    /// Returns the shading rate that is used instead of the requested rate, see ShadingRateProperties::ShadingRates.
+    SHADING_RATE GetSupportedShadingRate(SHADING_RATE Rate) const
+    {
+        return m_RateRemap[static_cast<Uint32>(Rate) & 0xFu];
+    }
+
+private:
+    void CreateShadingRateTexture(Uint32 Width, Uint32 Height);
+
+private:
+    RefCntAutoPtr<IRenderDevice>          m_pDevice;
+    RefCntAutoPtr<IBuffer>                m_pConstants;
+    RefCntAutoPtr<IPipelineState>         m_pPSO;
+    RefCntAutoPtr<IShaderResourceBinding> m_pSRB;
+
+    RefCntAutoPtr<ITexture>     m_pShadingRateTex;
+    RefCntAutoPtr<ITextureView> m_pShadingRateView;
+
+    const SHADING_RATE_FORMAT m_Format;
+    const bool                m_UseMotionVectors;
+
+    Uint32       m_TileSize[2]   = {};
+    SHADING_RATE m_RateRemap[16] = {};
+
+    // Render target size the shading rate texture was created for
+    Uint32 m_RTWidth  = 0;
+    Uint32 m_RTHeight = 0;
+};
+
+} // namespace Diligent
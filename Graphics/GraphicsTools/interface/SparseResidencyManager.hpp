@@ -0,0 +1,256 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::SparseResidencyManager class
+
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/DeviceMemory.h"
+#include "../../GraphicsEngine/interface/Fence.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Helper class that manages the tile residency of a sparse 2D texture or 2D texture array.
+
+/// The application requests tiles, either directly or by passing the feedback produced by the GPU
+/// (e.g. the min-mip map collected by TextureFeedbackBuffer), and calls Update() once per frame.
+/// Update() allocates memory blocks for the requested tiles from the device memory pool, evicts
+/// the least recently used tiles when the memory budget is exhausted, and records all binds and
+/// unbinds into a single IDeviceContext::BindSparseResourceMemory() command.
+///
+/// The mip tail is bound in the first update and always stays resident, so that the application
+/// may always fall back to it.
+///
+/// \remarks All methods must be called from the same thread.
+///
+///          The content of newly resident tiles is undefined: the application must upload the tile data
+///          after the graphics context waits for the fence value returned by Update().
+///
+///          The manager does not track how the GPU uses the texture. When the graphics queue may still access
+///          tiles that are evicted, the application must provide the fence that the sparse binding queue waits for,
+///          see UpdateAttribs::pWaitFence.
+class SparseResidencyManager
+{
+public:
+    /// Identifies a tile of a mip level that is not in the mip tail.
+    struct TileId
+    {
+        Uint32 MipLevel = 0;
+        Uint32 Slice    = 0;
+
+        /// Tile coordinates in the mip level, in tiles.
+        Uint32 X = 0;
+        Uint32 Y = 0;
+
+        constexpr TileId() noexcept {}
+
+        constexpr TileId(Uint32 _MipLevel, Uint32 _Slice, Uint32 _X, Uint32 _Y) noexcept :
+            MipLevel{_MipLevel},
+            Slice{_Slice},
+            X{_X},
+            Y{_Y}
+        {}
+
+        constexpr bool operator==(const TileId& RHS) const
+        {
+            return MipLevel == RHS.MipLevel && Slice == RHS.Slice && X == RHS.X && Y == RHS.Y;
+        }
+    };
+
+    struct CreateInfo
+    {
+        IRenderDevice* pDevice = nullptr;
+
+        /// Sparse texture whose residency is managed. Must be a 2D texture or a 2D texture array.
+        ITexture* pTexture = nullptr;
+
+        /// Memory object to allocate tiles from.
+        /// If null, the manager creates the memory that is compatible with the texture.
+        ///
+        /// \note In Metal, the memory must be the one that was used to create the sparse texture.
+        IDeviceMemory* pMemory = nullptr;
+
+        /// The maximum size of the memory that is used by the texture tiles, including the mip tail.
+        /// If zero, the texture address space size is used.
+        Uint64 MemoryBudget = 0;
+
+        /// The number of tiles in one memory page. The memory pool grows one page at a time.
+        /// Ignored if pMemory is not null.
+        Uint32 TilesPerMemoryPage = 64;
+
+        /// The number of updates during which a tile is not evicted after it was last requested.
+        Uint32 MinTileLifetime = 2;
+
+        /// Immediate context mask of the memory created by the manager, see DeviceMemoryDesc::ImmediateContextMask.
+        Uint64 ImmediateContextMask = 1;
+    };
+
+    explicit SparseResidencyManager(const CreateInfo& CI) noexcept(false);
+
+    ~SparseResidencyManager();
+
+    // clang-format off
+    SparseResidencyManager           (const SparseResidencyManager&) = delete;
+    SparseResidencyManager& operator=(const SparseResidencyManager&) = delete;
+    SparseResidencyManager           (SparseResidencyManager&&)      = delete;
+    SparseResidencyManager& operator=(SparseResidencyManager&&)      = delete;
+    // clang-format on
+
+    /// Requests the tile to be resident in the next update.
+    void RequestTile(const TileId& Tile);
+
+    /// Requests tiles from the min-mip feedback map.
+
+    /// \param [in] pMinMip - Feedback map, where every element covers the region of the most detailed mip level
+    ///                       of the size (TextureWidth / Width) x (TextureHeight / Height) and
+    ///                       contains the most detailed mip level that was requested for it.
+    ///                       The value of 0xFF indicates that the region has not been accessed.
+    /// \param [in] Width   - Feedback map width.
+    /// \param [in] Height  - Feedback map height.
+    /// \param [in] Stride  - Feedback map row stride, in bytes.
+    /// \param [in] Slice   - Texture array slice the feedback was produced for.
+    ///
+    /// \remarks    The tiles of all less detailed mip levels that cover the region are requested as well,
+    ///             so that the sampler can always fall back to a coarser level.
+    void ProcessFeedback(const Uint8* pMinMip,
+                         Uint32       Width,
+                         Uint32       Height,
+                         Uint32       Stride,
+                         Uint32       Slice = 0);
+
+    struct UpdateAttribs
+    {
+        /// Context that executes the sparse binding commands.
+        /// Must be an immediate context that supports COMMAND_QUEUE_TYPE_SPARSE_BINDING.
+        IDeviceContext* pSparseBindingContext = nullptr;
+
+        /// Optional fence that the sparse binding queue waits for before it binds and evicts tiles.
+        /// Typically, this is the fence that the graphics queue signals after the last frame that may use the texture.
+        IFence* pWaitFence = nullptr;
+
+        /// The value of pWaitFence to wait for.
+        Uint64 WaitFenceValue = 0;
+    };
+
+    /// Binds memory to the requested tiles, evicts unused tiles if the memory budget is exhausted,
+    /// and clears the requests.
+
+    /// \return     The value of the fence returned by GetFence() that is signaled when the
+    ///             binding is complete, or 0 if nothing was bound or there is no fence.
+    ///
+    /// \remarks    The requests that could not be satisfied because the budget is exhausted
+    ///             are discarded. The application is expected to request them again.
+    Uint64 Update(const UpdateAttribs& Attribs);
+
+    /// Returns the fence that is signaled by the sparse binding queue.
+    /// The graphics context should wait for the value returned by Update() using IDeviceContext::DeviceWaitForFence()
+    /// before it uploads the data of newly resident tiles.
+    ///
+    /// \note   In Direct3D11, the fence is null as there is only one immediate context.
+    IFence* GetFence() const { return m_pFence.RawPtr<IFence>(); }
+
+    /// Returns the tiles that became resident in the last update.
+    const std::vector<TileId>& GetNewlyResidentTiles() const { return m_NewlyResidentTiles; }
+
+    /// Returns the tiles that were evicted in the last update.
+    const std::vector<TileId>& GetEvictedTiles() const { return m_EvictedTiles; }
+
+    /// Returns true if the tile is resident.
+    bool IsTileResident(const TileId& Tile) const;
+
+    /// Returns the number of resident tiles, not counting the mip tail.
+    size_t GetNumResidentTiles() const { return m_ResidentTiles.size(); }
+
+    /// Returns the size of the memory that is used by the resident tiles and the mip tail.
+    Uint64 GetUsedMemorySize() const { return (m_NumMemoryBlocks - m_FreeBlocks.size()) * m_BlockSize; }
+
+    /// Returns the current capacity of the memory pool.
+    Uint64 GetMemoryCapacity() const { return m_NumMemoryBlocks * m_BlockSize; }
+
+private:
+    // Tile identifier packed into 64 bits.
+    using TileKey = Uint64;
+
+    TileKey PackTileId(const TileId& Tile) const;
+    TileId  UnpackTileId(TileKey Key) const;
+
+    bool   ValidateTileId(const TileId& Tile) const;
+    Uint32 GetNumTilesX(Uint32 MipLevel) const;
+    Uint32 GetNumTilesY(Uint32 MipLevel) const;
+    Box    GetTileRegion(const TileId& Tile) const;
+
+    bool AllocateBlock(Uint32& Block, std::vector<SparseTextureMemoryBindRange>& Ranges);
+    bool GrowMemory();
+    void BindMipTail(std::vector<SparseTextureMemoryBindRange>& Ranges);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    RefCntAutoPtr<ITexture>      m_pTexture;
+    RefCntAutoPtr<IDeviceMemory> m_pMemory;
+    RefCntAutoPtr<IFence>        m_pFence;
+
+    const Uint64 m_BlockSize;
+    const Uint64 m_MemoryBudget;
+    const Uint32 m_MinTileLifetime;
+
+    Uint64 m_NextFenceValue = 1;
+    Uint64 m_UpdateIndex    = 0;
+    bool   m_MipTailBound   = false;
+
+    // The number of blocks in the memory pool.
+    Uint64 m_NumMemoryBlocks = 0;
+
+    // Indices of the memory blocks that are not bound to any tile.
+    std::vector<Uint32> m_FreeBlocks;
+
+    struct ResidentTile
+    {
+        TileKey Key         = 0;
+        Uint32  Block       = 0;
+        Uint64  LastRequest = 0;
+    };
+    // Resident tiles, from the most recently requested to the least recently requested.
+    std::list<ResidentTile>                                        m_LRU;
+    std::unordered_map<TileKey, std::list<ResidentTile>::iterator> m_ResidentTiles;
+
+    std::unordered_set<TileKey> m_RequestedTiles;
+
+    std::vector<TileId> m_NewlyResidentTiles;
+    std::vector<TileId> m_EvictedTiles;
+};
+
+} // namespace Diligent
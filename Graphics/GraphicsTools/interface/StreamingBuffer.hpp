@@ -30,11 +30,14 @@
 #include <functional>
 #include <vector>
 #include <string>
+#include <atomic>
+#include <cstring>
 
 #include "../../GraphicsEngine/interface/RenderDevice.h"
 #include "../../GraphicsEngine/interface/DeviceContext.h"
 #include "../../GraphicsEngine/interface/Buffer.h"
 #include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/Align.hpp"
 #include "MapHelper.hpp"
 
 namespace Diligent
@@ -52,6 +55,8 @@ struct StreamingBufferCreateInfo
 class StreamingBuffer
 {
 public:
+    static constexpr Uint32 InvalidOffset = ~Uint32{0};
+
     StreamingBuffer() noexcept
     {}
 
@@ -80,6 +85,7 @@ public:
         for (const auto& mapInfo : m_MapInfo)
         {
             VERIFY(!mapInfo.m_MappedData, "Destroying streaming buffer that is still mapped");
+            VERIFY(!mapInfo.m_SharedMapping, "Destroying streaming buffer that is still mapped in shared mode");
         }
     }
 
@@ -89,6 +95,7 @@ public:
         VERIFY_EXPR(Size > 0);
 
         auto& MapInfo = m_MapInfo[CtxNum];
+        VERIFY(!MapInfo.m_SharedMapping, "Map() must not be called while the buffer is mapped in shared mode");
         // Check if there is enough space in the buffer
         if (MapInfo.m_CurrOffset + Size > m_BufferSize)
         {
@@ -148,6 +155,7 @@ public:
 
     void Unmap(size_t CtxNum = 0)
     {
+        VERIFY(!m_MapInfo[CtxNum].m_SharedMapping, "Use EndSharedMapping() to unmap the buffer mapped in shared mode");
         if (!m_UsePersistentMap)
         {
             m_MapInfo[CtxNum].m_MappedData.Unmap();
@@ -156,6 +164,7 @@ public:
 
     void Flush(size_t CtxNum = 0)
     {
+        VERIFY(!m_MapInfo[CtxNum].m_SharedMapping, "Flush() must not be called while the buffer is mapped in shared mode");
         m_MapInfo[CtxNum].m_MappedData.Unmap();
         m_MapInfo[CtxNum].m_CurrOffset = 0;
     }
@@ -166,6 +175,90 @@ public:
             Flush(ctx);
     }
 
+    /// Maps the region of ReserveSize bytes for the shared allocation mode.
+
+    /// \param [in] pCtx        - Device context to map the buffer in. All commands that read
+    ///                           the data must be recorded in this context.
+    /// \param [in] pDevice     - Render device that is used to extend the buffer if necessary.
+    /// \param [in] ReserveSize - Size of the region to reserve for the shared allocations.
+    /// \param [in] CtxNum      - Context index.
+    ///
+    /// \remarks   While the buffer is mapped in shared mode, any number of threads may
+    ///            concurrently call AllocateShared() and UpdateShared() to reserve disjoint
+    ///            ranges of the mapped region, e.g. to write per-object constants while
+    ///            preparing draw commands in parallel. Allocation is a lock-free bump of
+    ///            an atomic offset.
+    ///            Map(), Update(), Unmap() and Flush() must not be called for this context
+    ///            until EndSharedMapping() is called.
+    void BeginSharedMapping(IDeviceContext* pCtx, IRenderDevice* pDevice, Uint32 ReserveSize, size_t CtxNum = 0)
+    {
+        auto& MapInfo = m_MapInfo[CtxNum];
+        VERIFY(!MapInfo.m_SharedMapping, "The buffer is already mapped in shared mode");
+
+        const auto Offset = Map(pCtx, pDevice, ReserveSize, CtxNum);
+
+        MapInfo.m_SharedOffset.store(Offset, std::memory_order_relaxed);
+        MapInfo.m_SharedEnd     = Offset + ReserveSize;
+        MapInfo.m_SharedMapping = true;
+    }
+
+    /// Reserves Size bytes with the given alignment in the region mapped by BeginSharedMapping().
+
+    /// \return    Offset of the allocated range from the start of the buffer, or InvalidOffset
+    ///            if the reserved region is exhausted.
+    ///
+    /// \remarks   The method is thread-safe. Use GetMappedCPUAddress() to get the CPU address
+    ///            of the mapped data.
+    Uint32 AllocateShared(Uint32 Size, Uint32 Alignment = 16, size_t CtxNum = 0)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be a power of two");
+
+        auto& MapInfo = m_MapInfo[CtxNum];
+        VERIFY(MapInfo.m_SharedMapping, "The buffer is not mapped in shared mode");
+
+        Uint32 CurrOffset = MapInfo.m_SharedOffset.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            const Uint64 Offset = AlignUp(Uint64{CurrOffset}, Uint64{Alignment});
+            if (Offset + Size > MapInfo.m_SharedEnd)
+                return InvalidOffset;
+
+            if (MapInfo.m_SharedOffset.compare_exchange_weak(CurrOffset, static_cast<Uint32>(Offset + Size), std::memory_order_relaxed))
+                return static_cast<Uint32>(Offset);
+        }
+    }
+
+    /// Allocates Size bytes in the shared region and copies pData into them.
+
+    /// \return    Offset of the data from the start of the buffer, or InvalidOffset
+    ///            if the reserved region is exhausted.
+    Uint32 UpdateShared(const void* pData, Uint32 Size, Uint32 Alignment = 16, size_t CtxNum = 0)
+    {
+        VERIFY_EXPR(pData != nullptr);
+        const auto Offset = AllocateShared(Size, Alignment, CtxNum);
+        if (Offset != InvalidOffset)
+        {
+            auto* pCPUAddress = reinterpret_cast<Uint8*>(GetMappedCPUAddress(CtxNum)) + Offset;
+            memcpy(pCPUAddress, pData, Size);
+        }
+        return Offset;
+    }
+
+    /// Ends the shared allocation mode and unmaps the buffer.
+
+    /// \remarks   All threads must have finished writing the data before this method is called.
+    ///            The unused tail of the reserved region is returned to the buffer.
+    void EndSharedMapping(size_t CtxNum = 0)
+    {
+        auto& MapInfo = m_MapInfo[CtxNum];
+        VERIFY(MapInfo.m_SharedMapping, "The buffer is not mapped in shared mode");
+
+        MapInfo.m_CurrOffset    = std::min(MapInfo.m_SharedOffset.load(std::memory_order_relaxed), MapInfo.m_SharedEnd);
+        MapInfo.m_SharedMapping = false;
+        Unmap(CtxNum);
+    }
+
     IBuffer* GetBuffer() const { return m_pBuffer.RawPtr<IBuffer>(); }
 
     void* GetMappedCPUAddress(size_t CtxNum = 0)
@@ -186,6 +279,34 @@ private:
     {
         MapHelper<Uint8> m_MappedData;
         Uint32           m_CurrOffset = 0;
+
+        // Shared allocation mode, see BeginSharedMapping()
+        std::atomic<Uint32> m_SharedOffset{0};
+        Uint32              m_SharedEnd     = 0;
+        bool                m_SharedMapping = false;
+
+        MapInfo() noexcept {}
+
+        MapInfo(MapInfo&& Other) noexcept :
+            m_MappedData{std::move(Other.m_MappedData)},
+            m_CurrOffset{Other.m_CurrOffset},
+            m_SharedOffset{Other.m_SharedOffset.load(std::memory_order_relaxed)},
+            m_SharedEnd{Other.m_SharedEnd},
+            m_SharedMapping{Other.m_SharedMapping}
+        {
+            Other.m_SharedMapping = false;
+        }
+
+        MapInfo& operator=(MapInfo&& Other) noexcept
+        {
+            m_MappedData = std::move(Other.m_MappedData);
+            m_CurrOffset = Other.m_CurrOffset;
+            m_SharedOffset.store(Other.m_SharedOffset.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            m_SharedEnd           = Other.m_SharedEnd;
+            m_SharedMapping       = Other.m_SharedMapping;
+            Other.m_SharedMapping = false;
+            return *this;
+        }
     };
     // We need to keep track of mapped data for every context
     std::vector<MapInfo> m_MapInfo;
@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::TextureFeedbackBuffer class
+
+#include <functional>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "AsyncReadbackQueue.hpp"
+
+namespace Diligent
+{
+
+/// Helper class that collects the texture mip levels sampled by shaders and reads them back to the CPU.
+
+/// The feedback is stored in a structured buffer of uint elements that contains one min-mip map of
+/// Width x Height elements per texture array slice. Shaders bind the buffer as RWStructuredBuffer<uint>
+/// and write the feedback with the WRITE_TEXTURE_FEEDBACK() macro defined in HLSLDefinitions.fxh:
+///
+///     RWStructuredBuffer<uint> g_Feedback;
+///     ...
+///     float LOD = ComputeTextureFeedbackLOD(ddx(UV), ddy(UV), TexDim);
+///     WRITE_TEXTURE_FEEDBACK(g_Feedback, FeedbackDim, Slice, UV, LOD);
+///
+/// The feedback maps are read back through AsyncReadbackQueue and delivered in the format that
+/// is accepted by SparseResidencyManager::ProcessFeedback().
+///
+/// \remarks All methods must be called from the thread that owns the device context.
+class TextureFeedbackBuffer
+{
+public:
+    struct CreateInfo
+    {
+        IRenderDevice* pDevice = nullptr;
+
+        /// Feedback buffer name.
+        const char* Name = nullptr;
+
+        /// Feedback map dimensions.
+        Uint32 Width  = 0;
+        Uint32 Height = 0;
+
+        /// The number of texture array slices.
+        Uint32 NumSlices = 1;
+    };
+
+    explicit TextureFeedbackBuffer(const CreateInfo& CI) noexcept(false);
+
+    // clang-format off
+    TextureFeedbackBuffer           (const TextureFeedbackBuffer&) = delete;
+    TextureFeedbackBuffer& operator=(const TextureFeedbackBuffer&) = delete;
+    TextureFeedbackBuffer           (TextureFeedbackBuffer&&)      = delete;
+    TextureFeedbackBuffer& operator=(TextureFeedbackBuffer&&)      = delete;
+    // clang-format on
+
+    /// Function that receives the feedback map of one texture array slice.
+
+    /// Every element contains the most detailed mip level that was sampled
+    /// in the region it covers, or 0xFF if the region was not accessed.
+    /// The data is only valid while the function is executed.
+    using CallbackType = std::function<void(const Uint8* pMinMip, Uint32 Width, Uint32 Height, Uint32 Stride, Uint32 Slice)>;
+
+    /// Resets all elements of the feedback maps to TEXTURE_FEEDBACK_NOT_ACCESSED.
+
+    /// \remarks    This method is typically called once per frame before the feedback is written.
+    ///             The buffer is transitioned to RESOURCE_STATE_COPY_DEST state.
+    void Clear(IDeviceContext* pContext);
+
+    /// Enqueues the readback of the feedback maps.
+
+    /// \param [in] pContext      - Device context that records the copy.
+    /// \param [in] ReadbackQueue - Readback queue that delivers the data.
+    /// \param [in] Callback      - Function that is called for every texture array slice when the data is available.
+    ///                             If the readback queue uses a thread pool, the function is executed by a worker thread.
+    ///
+    /// \return     true if the readback was enqueued, and false otherwise.
+    bool Readback(IDeviceContext* pContext, AsyncReadbackQueue& ReadbackQueue, CallbackType Callback);
+
+    /// Returns the feedback buffer.
+    IBuffer* GetBuffer() const { return m_pBuffer.RawPtr<IBuffer>(); }
+
+    /// Returns the unordered access view of the feedback buffer.
+    IBufferView* GetUAV() const { return GetBuffer()->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS); }
+
+    Uint32 GetWidth() const { return m_Width; }
+    Uint32 GetHeight() const { return m_Height; }
+    Uint32 GetNumSlices() const { return m_NumSlices; }
+
+private:
+    const Uint32 m_Width;
+    const Uint32 m_Height;
+    const Uint32 m_NumSlices;
+
+    RefCntAutoPtr<IBuffer> m_pBuffer;
+
+    // Data that is used to clear the buffer
+    std::vector<Uint32> m_ClearData;
+};
+
+} // namespace Diligent
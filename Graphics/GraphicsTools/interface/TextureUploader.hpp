@@ -27,8 +27,11 @@
 
 #pragma once
 
+#include <functional>
+
 #include "../../GraphicsEngine/interface/RenderDevice.h"
 #include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -47,10 +50,12 @@ struct UploadBufferDesc
 
     bool operator == (const UploadBufferDesc &rhs) const
     {
-        return Width  == rhs.Width  &&
-                Height == rhs.Height &&
-                Depth  == rhs.Depth  &&
-                Format == rhs.Format;
+        return Width     == rhs.Width     &&
+               Height    == rhs.Height    &&
+               Depth     == rhs.Depth     &&
+               MipLevels == rhs.MipLevels &&
+               ArraySize == rhs.ArraySize &&
+               Format    == rhs.Format;
     }
 };
 // clang-format on
@@ -66,6 +71,18 @@ public:
 /// Texture uploader description.
 struct TextureUploaderDesc
 {
+    /// The maximum number of bytes that a single call to ITextureUploader::RenderThreadUpdate
+    /// copies from upload buffers to destination textures. Zero means no limit.
+
+    /// \remarks   Copy operations that do not fit into the budget remain queued and are executed
+    ///            by subsequent calls to RenderThreadUpdate. At least one copy operation is always
+    ///            executed, so a copy that is larger than the budget does not stall the queue.
+    ///            Copies scheduled by the render thread (non-null context passed to
+    ///            ITextureUploader::ScheduleGPUCopy) are executed immediately and are not
+    ///            subject to the budget.
+    ///
+    ///            Currently the budget is only honored by the Direct3D12 and Vulkan uploader.
+    Uint64 MaxCopyBytesPerUpdate = 0;
 };
 
 
@@ -73,6 +90,10 @@ struct TextureUploaderDesc
 struct TextureUploaderStats
 {
     Uint32 NumPendingOperations = 0;
+
+    /// The number of copy operations deferred to the next ITextureUploader::RenderThreadUpdate
+    /// call because they did not fit into TextureUploaderDesc::MaxCopyBytesPerUpdate.
+    Uint32 NumDeferredCopies = 0;
 };
 
 /// Asynchronous texture uploader
@@ -119,6 +140,9 @@ public:
     /// \param [in] MipLevel      - Destination mip level. When multiple mip levels are copied,
     ///                             the starting mip level.
     /// \param [in] pUploadBuffer - Upload buffer to copy data from.
+    /// \param [in] Priority      - Copy priority. Queued copies with higher priority are
+    ///                             executed first; copies with equal priority are executed
+    ///                             in the order they were scheduled.
     ///
     /// \remarks  When the method is called from a worker thread (pContext is null),
     ///           it may enqueue a render-thread operation and block until the operation is
@@ -127,11 +151,17 @@ public:
     ///           when calling the method from the render thread. On the other hand, always
     ///           pass null when calling the method from a worker thread to avoid
     ///           synchronization issues, which may result in an undefined behavior.
+    ///
+    ///           Copy operations are recorded into the context passed to RenderThreadUpdate,
+    ///           which may be a context of a transfer queue.
+    ///
+    ///           Currently the priority is only honored by the Direct3D12 and Vulkan uploader.
     virtual void ScheduleGPUCopy(IDeviceContext* pContext,
                                  ITexture*       pDstTexture,
                                  Uint32          ArraySlice,
                                  Uint32          MipLevel,
-                                 IUploadBuffer*  pUploadBuffer) = 0;
+                                 IUploadBuffer*  pUploadBuffer,
+                                 Uint32          Priority = 0) = 0;
 
 
     /// Recycles upload buffer to make it available for future operations.
@@ -146,4 +176,82 @@ public:
 
 void CreateTextureUploader(IRenderDevice* pDevice, const TextureUploaderDesc& Desc, ITextureUploader** ppUploader);
 
+
+/// Subresource information passed to the texture transcoding callback.
+struct TextureTranscodeSubresourceInfo
+{
+    /// Mip level and array slice of the upload buffer subresource.
+    Uint32 MipLevel   = 0;
+    Uint32 ArraySlice = 0;
+
+    /// Subresource dimensions, in texels.
+    Uint32 Width  = 0;
+    Uint32 Height = 0;
+    Uint32 Depth  = 0;
+
+    /// Upload buffer format, e.g. TEX_FORMAT_BC7_UNORM.
+    TEXTURE_FORMAT Format = TEX_FORMAT_UNKNOWN;
+
+    /// Mapped memory of the upload buffer subresource that the transcoded data
+    /// must be written to, see IUploadBuffer::GetMappedData.
+    MappedTextureSubresource DstData;
+
+    /// Id of the thread pool thread that runs the callback, or 0 if the callback
+    /// is executed by the calling thread.
+    Uint32 ThreadId = 0;
+};
+
+/// Transcodes one subresource and writes the result directly into TextureTranscodeSubresourceInfo::DstData.
+/// Returns false if the subresource could not be transcoded.
+using TextureTranscodeCallbackType = std::function<bool(const TextureTranscodeSubresourceInfo& Info)>;
+
+/// Attributes of the TranscodeToUploadBuffer function.
+struct TextureTranscodeAttribs
+{
+    /// Upload buffer to write the transcoded data to. The buffer must be allocated with
+    /// ITextureUploader::AllocateUploadBuffer.
+    IUploadBuffer* pUploadBuffer = nullptr;
+
+    /// Callback that transcodes one subresource, e.g. a Basis Universal or KTX2 wrapper
+    /// that transcodes the supercompressed data to BC7 or ASTC.
+    ///
+    /// \remarks    The callback is called concurrently from multiple threads for different
+    ///             subresources, and must be thread-safe.
+    TextureTranscodeCallbackType TranscodeSubresource;
+
+    /// Thread pool that runs one transcoding task per mip level and array slice.
+    /// If null, all subresources are transcoded by the calling thread.
+    IThreadPool* pThreadPool = nullptr;
+
+    /// Priority of the transcoding tasks.
+    float TaskPriority = 0;
+
+    /// Optional texture uploader and destination texture. If not null, the GPU copy
+    /// is scheduled from the worker thread when all subresources are transcoded,
+    /// as if ITextureUploader::ScheduleGPUCopy was called with null context.
+    ITextureUploader* pUploader     = nullptr;
+    ITexture*         pDstTexture   = nullptr;
+    Uint32            DstArraySlice = 0;
+    Uint32            DstMipLevel   = 0;
+    Uint32            CopyPriority  = 0;
+};
+
+/// Transcodes supercompressed texture data into the upload buffer.
+
+/// \param [in] Attribs - Transcoding attributes, see Diligent::TextureTranscodeAttribs.
+///
+/// \return     The task that is finished when all subresources are transcoded and, if requested,
+///             the GPU copy is scheduled. If any subresource fails to transcode, the task status
+///             is ASYNC_TASK_STATUS_CANCELLED and the copy is not scheduled; otherwise the status
+///             is ASYNC_TASK_STATUS_COMPLETE. When Attribs.pThreadPool is null, the function
+///             returns a finished task.
+///
+/// \remarks    Every subresource is transcoded straight into the mapped memory of the upload buffer,
+///             so no intermediate copies are made.
+///
+///             If the GPU copy is scheduled by a worker thread, the render thread must keep calling
+///             ITextureUploader::RenderThreadUpdate until the task is finished. The application must
+///             call IUploadBuffer::WaitForCopyScheduled before it recycles the upload buffer.
+RefCntAutoPtr<IAsyncTask> TranscodeToUploadBuffer(const TextureTranscodeAttribs& Attribs);
+
 } // namespace Diligent
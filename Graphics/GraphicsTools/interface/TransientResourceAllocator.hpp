@@ -0,0 +1,225 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::TransientResourceAllocator class
+
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/DeviceMemory.h"
+#include "../../GraphicsEngine/interface/Fence.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Helper class that allocates transient textures, such as intermediate render targets of
+/// a post-processing chain, whose lifetime is limited to a range of passes of one frame.
+
+/// Every frame, the application calls BeginFrame(), requests the textures it needs together
+/// with the range of passes that use them, and calls Update(). Textures whose pass ranges do
+/// not overlap share the same memory: Update() places them into a common device memory pool
+/// and binds the memory using IDeviceContext::BindSparseResourceMemory(). The application then
+/// calls BeginPass() before every pass, which emits the aliasing barriers for the textures whose
+/// lifetime starts in this pass.
+///
+/// Aliased textures are sparse textures created with MISC_TEXTURE_FLAG_SPARSE_ALIASING.
+/// If the device does not support sparse aliasing, or the texture can't be sparse, the allocator
+/// falls back to regular textures. All textures are pooled and reused by the following frames,
+/// so that the textures are not recreated every frame; the textures that have not been requested
+/// for CreateInfo::MaxUnusedFrames frames are released.
+///
+/// \remarks All methods must be called from the same thread.
+///
+///          The content of a transient texture is undefined at the beginning of its first pass:
+///          the first pass must fully overwrite or clear the texture.
+///
+///          The memory of aliased textures may be rebound by Update(). When the GPU may still use
+///          the textures of the previous frames, the application must provide the fence that the
+///          sparse binding queue waits for, see UpdateAttribs::pWaitFence.
+class TransientResourceAllocator
+{
+public:
+    struct CreateInfo
+    {
+        IRenderDevice* pDevice = nullptr;
+
+        /// The size of one memory page. The memory pool grows one page at a time.
+        /// The size is rounded up to the multiple of the sparse block size.
+        Uint64 MemoryPageSize = Uint64{16} << 20;
+
+        /// The number of frames after which a pooled texture that is not requested is released.
+        Uint32 MaxUnusedFrames = 4;
+
+        /// Immediate context mask of the textures and the memory, see TextureDesc::ImmediateContextMask.
+        Uint64 ImmediateContextMask = 1;
+
+        /// If true, the allocator does not alias the memory and always uses regular textures.
+        bool DisableAliasing = false;
+    };
+
+    explicit TransientResourceAllocator(const CreateInfo& CI) noexcept(false);
+
+    ~TransientResourceAllocator();
+
+    // clang-format off
+    TransientResourceAllocator           (const TransientResourceAllocator&) = delete;
+    TransientResourceAllocator& operator=(const TransientResourceAllocator&) = delete;
+    TransientResourceAllocator           (TransientResourceAllocator&&)      = delete;
+    TransientResourceAllocator& operator=(TransientResourceAllocator&&)      = delete;
+    // clang-format on
+
+    /// Request identifier that is returned when the texture can't be allocated.
+    static constexpr Uint32 InvalidRequestId = ~0u;
+
+    /// Starts a new frame and discards the requests of the previous frame.
+    void BeginFrame();
+
+    /// Requests a texture that is used by the passes in the range [FirstPass, LastPass].
+
+    /// \param [in] Desc      - Texture description. Usage must be USAGE_DEFAULT.
+    /// \param [in] FirstPass - The index of the first pass that uses the texture.
+    /// \param [in] LastPass  - The index of the last pass that uses the texture.
+    ///
+    /// \return     The request identifier that is passed to GetTexture(), or InvalidRequestId
+    ///             if the texture could not be created.
+    ///
+    /// \remarks    Pass indices are arbitrary, but must increase in the order the passes are executed.
+    Uint32 RequestTexture(const TextureDesc& Desc, Uint32 FirstPass, Uint32 LastPass);
+
+    struct UpdateAttribs
+    {
+        /// Context that executes the sparse binding commands.
+        /// Must be an immediate context that supports COMMAND_QUEUE_TYPE_SPARSE_BINDING.
+        /// May be null if no texture is aliased, see IsAliasingEnabled().
+        IDeviceContext* pSparseBindingContext = nullptr;
+
+        /// Optional fence that the sparse binding queue waits for before it rebinds the memory.
+        /// Typically, this is the fence that the graphics queue signals after the last frame that may use the textures.
+        IFence* pWaitFence = nullptr;
+
+        /// The value of pWaitFence to wait for.
+        Uint64 WaitFenceValue = 0;
+    };
+
+    /// Places the requested aliased textures into the memory pool and binds the memory
+    /// to the textures whose placement has changed.
+
+    /// \return     The value of the fence returned by GetFence() that is signaled when the
+    ///             binding is complete, or 0 if nothing was bound or there is no fence.
+    Uint64 Update(const UpdateAttribs& Attribs);
+
+    /// Returns the texture of the request made in the current frame.
+    ITexture* GetTexture(Uint32 RequestId) const;
+
+    /// Emits the aliasing barriers for the textures whose first pass is Pass.
+    /// Must be called before every pass after Update().
+    void BeginPass(IDeviceContext* pContext, Uint32 Pass);
+
+    /// Returns the fence that is signaled by the sparse binding queue.
+    /// The graphics context should wait for the value returned by Update() using IDeviceContext::DeviceWaitForFence()
+    /// before it uses the textures.
+    ///
+    /// \note   In Direct3D11, the fence is null as there is only one immediate context.
+    IFence* GetFence() const { return m_pFence.RawPtr<IFence>(); }
+
+    /// Returns true if the allocator aliases the memory of the textures.
+    bool IsAliasingEnabled() const { return m_AliasingEnabled; }
+
+    /// Returns the current capacity of the memory pool.
+    Uint64 GetMemoryCapacity() const;
+
+    /// Returns the size of the pool memory that is used by the aliased textures of the current frame.
+    Uint64 GetFrameMemorySize() const { return m_FrameMemorySize; }
+
+    /// Returns the total size of the aliased textures of the current frame, as if they did not share memory.
+    Uint64 GetRequestedMemorySize() const { return m_RequestedMemorySize; }
+
+    /// Returns the number of textures in the pool, including the ones that are not used by the current frame.
+    size_t GetNumPooledTextures() const { return m_Textures.size(); }
+
+private:
+    static constexpr Uint64 InvalidOffset = ~Uint64{0};
+
+    struct PooledTexture
+    {
+        RefCntAutoPtr<ITexture> pTexture;
+
+        // The number of memory blocks the texture occupies, or 0 if the texture is not aliased.
+        Uint64 NumBlocks = 0;
+
+        // The offset of the memory bound to the texture, in blocks.
+        Uint64 BoundOffset = InvalidOffset;
+
+        // The last frame that requested the texture.
+        Uint64 LastUsedFrame = 0;
+    };
+
+    struct Request
+    {
+        Uint32 FirstPass  = 0;
+        Uint32 LastPass   = 0;
+        Uint32 TextureIdx = 0;
+
+        // The offset of the texture in the memory pool, in blocks.
+        Uint64 Offset = InvalidOffset;
+    };
+
+    bool   CanAlias(const TextureDesc& Desc) const;
+    Uint32 FindOrCreateTexture(const TextureDesc& Desc, bool Aliased);
+    bool   InitAliasedTexture(PooledTexture& Tex);
+    void   PlaceAliasedTextures();
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    RefCntAutoPtr<IDeviceMemory> m_pMemory;
+    RefCntAutoPtr<IFence>        m_pFence;
+
+    const Uint32 m_MaxUnusedFrames;
+    const Uint64 m_ImmediateContextMask;
+    const bool   m_AliasingEnabled;
+
+    // Sparse block size and memory page size, or 0 if aliasing is disabled.
+    const Uint64 m_BlockSize;
+    const Uint64 m_MemoryPageSize;
+
+    Uint64 m_FrameIndex      = 0;
+    Uint64 m_NextFenceValue  = 1;
+    bool   m_FrameUpdated    = false;
+    Uint64 m_FrameMemorySize = 0;
+
+    Uint64 m_RequestedMemorySize = 0;
+
+    std::vector<PooledTexture> m_Textures;
+    std::vector<Request>       m_Requests;
+};
+
+} // namespace Diligent
@@ -0,0 +1,362 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// Defines Diligent::TypedResourceSignature and Diligent::TypedShaderResourceBinding class templates
+
+#include <array>
+
+#include "../../GraphicsEngine/interface/PipelineResourceSignature.h"
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/ShaderResourceBinding.h"
+#include "../../GraphicsEngine/interface/GraphicsTypesX.hpp"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Compile-time description of a pipeline resource.
+
+/// A resource is declared as a type that derives from TypedResource and defines
+/// a static constexpr GetName() method that returns the resource name, e.g.:
+///
+///     struct cbCameraAttribs : TypedResource<SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_STATIC>
+///     {
+///         static constexpr const char* GetName() { return "cbCameraAttribs"; }
+///     };
+template <SHADER_TYPE                   _ShaderStages,
+          SHADER_RESOURCE_TYPE          _ResourceType,
+          SHADER_RESOURCE_VARIABLE_TYPE _VarType   = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE,
+          Uint32                        _ArraySize = 1,
+          PIPELINE_RESOURCE_FLAGS       _Flags     = PIPELINE_RESOURCE_FLAG_NONE>
+struct TypedResource
+{
+    static_assert(_ShaderStages != SHADER_TYPE_UNKNOWN, "Resource must be used by at least one shader stage");
+    static_assert(_ArraySize != 0, "Resource array size must not be zero");
+    static_assert(_VarType < SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES, "Invalid variable type");
+
+    static constexpr SHADER_TYPE                   ShaderStages = _ShaderStages;
+    static constexpr SHADER_RESOURCE_TYPE          ResourceType = _ResourceType;
+    static constexpr SHADER_RESOURCE_VARIABLE_TYPE VarType      = _VarType;
+    static constexpr Uint32                        ArraySize    = _ArraySize;
+    static constexpr PIPELINE_RESOURCE_FLAGS       Flags        = _Flags;
+};
+
+namespace TypedResourceSignatureInternal
+{
+
+static constexpr Uint32 InvalidSlot = ~0u;
+
+// Resources shared between stages have a single variable in the signature,
+// so the variable is looked up in the lowest stage.
+constexpr SHADER_TYPE GetLookupStage(SHADER_TYPE Stages)
+{
+    return static_cast<SHADER_TYPE>(static_cast<Uint32>(Stages) & (~static_cast<Uint32>(Stages) + 1u));
+}
+
+template <typename ResType, typename... ListTypes>
+struct SlotIndex;
+
+template <typename ResType>
+struct SlotIndex<ResType>
+{
+    static constexpr Uint32 Value = InvalidSlot;
+};
+
+template <typename ResType, typename... ListTypes>
+struct SlotIndex<ResType, ResType, ListTypes...>
+{
+    static constexpr Uint32 Value = 0;
+};
+
+template <typename ResType, typename FirstType, typename... ListTypes>
+struct SlotIndex<ResType, FirstType, ListTypes...>
+{
+    static constexpr Uint32 Value = SlotIndex<ResType, ListTypes...>::Value == InvalidSlot ?
+        InvalidSlot :
+        SlotIndex<ResType, ListTypes...>::Value + 1;
+};
+
+} // namespace TypedResourceSignatureInternal
+
+
+template <typename SignatureType>
+class TypedShaderResourceBinding;
+
+/// Pipeline resource signature whose resources are defined at compile time.
+
+/// \tparam ResourceTypes - Resource types derived from Diligent::TypedResource.
+///                         The order of the types defines the slot indices.
+///
+/// The class wraps an IPipelineResourceSignature object created from the description
+/// returned by MakeDesc(). Static variables are resolved once when the wrapper is created,
+/// so SetStatic() performs no name lookups. Resource types that are not part of the signature
+/// or whose variable type does not match the setter are rejected at compile time.
+template <typename... ResourceTypes>
+class TypedResourceSignature
+{
+public:
+    static constexpr Uint32 NumResources = static_cast<Uint32>(sizeof...(ResourceTypes));
+    static_assert(NumResources > 0, "Signature must contain at least one resource");
+
+    using SRBType = TypedShaderResourceBinding<TypedResourceSignature<ResourceTypes...>>;
+
+    /// Returns the slot index of the resource in the signature.
+    template <typename ResType>
+    static constexpr Uint32 GetSlot()
+    {
+        static_assert(TypedResourceSignatureInternal::SlotIndex<ResType, ResourceTypes...>::Value != TypedResourceSignatureInternal::InvalidSlot,
+                      "Resource is not part of the signature");
+        return TypedResourceSignatureInternal::SlotIndex<ResType, ResourceTypes...>::Value;
+    }
+
+    /// Returns the descriptions of all resources in slot order.
+    static constexpr std::array<PipelineResourceDesc, sizeof...(ResourceTypes)> GetResourceDescs()
+    {
+        return {{
+            PipelineResourceDesc{
+                ResourceTypes::ShaderStages,
+                ResourceTypes::GetName(),
+                ResourceTypes::ArraySize,
+                ResourceTypes::ResourceType,
+                ResourceTypes::VarType,
+                ResourceTypes::Flags,
+            }...,
+        }};
+    }
+
+    /// Returns the signature description that contains all resources.
+
+    /// \param [in] Name         - Signature name.
+    /// \param [in] BindingIndex - Signature binding index.
+    ///
+    /// \remarks    Immutable samplers and other attributes may be added to the returned description
+    ///             before the signature is created.
+    static PipelineResourceSignatureDescX MakeDesc(const char* Name, Uint8 BindingIndex = 0)
+    {
+        PipelineResourceSignatureDescX Desc;
+        Desc.SetName(Name);
+        Desc.BindingIndex = BindingIndex;
+        for (const PipelineResourceDesc& Res : GetResourceDescs())
+            Desc.AddResource(Res);
+        return Desc;
+    }
+
+    TypedResourceSignature() = default;
+
+    /// \param [in] pSignature - Signature created from the description returned by MakeDesc().
+    explicit TypedResourceSignature(IPipelineResourceSignature* pSignature) :
+        m_pSignature{pSignature}
+    {
+        if (!m_pSignature)
+            return;
+
+        const std::array<PipelineResourceDesc, sizeof...(ResourceTypes)> Descs = GetResourceDescs();
+        for (Uint32 Slot = 0; Slot < NumResources; ++Slot)
+        {
+            const PipelineResourceDesc& Res = Descs[Slot];
+            if (Res.VarType != SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+                continue;
+
+            m_StaticVars[Slot] = m_pSignature->GetStaticVariableByName(TypedResourceSignatureInternal::GetLookupStage(Res.ShaderStages), Res.Name);
+            DEV_CHECK_ERR(m_StaticVars[Slot] != nullptr, "Static variable '", Res.Name, "' is not found in signature '",
+                          m_pSignature->GetDesc().Name, "'. Was the signature created from TypedResourceSignature::MakeDesc()?");
+        }
+    }
+
+    /// Creates the signature from the description returned by MakeDesc().
+    static TypedResourceSignature Create(IRenderDevice* pDevice, const char* Name, Uint8 BindingIndex = 0)
+    {
+        RefCntAutoPtr<IPipelineResourceSignature> pSignature;
+        pDevice->CreatePipelineResourceSignature(MakeDesc(Name, BindingIndex), &pSignature);
+        return TypedResourceSignature{pSignature};
+    }
+
+    IPipelineResourceSignature* GetSignature() const { return m_pSignature.RawPtr<IPipelineResourceSignature>(); }
+
+    explicit operator bool() const { return m_pSignature != nullptr; }
+
+    /// Returns the static variable of the resource.
+    template <typename ResType>
+    IShaderResourceVariable* GetStaticVariable() const
+    {
+        static_assert(ResType::VarType == SHADER_RESOURCE_VARIABLE_TYPE_STATIC, "Only static resources are accessed through the signature");
+        return m_StaticVars[GetSlot<ResType>()];
+    }
+
+    /// Binds the object to the static resource.
+    template <typename ResType>
+    void SetStatic(IDeviceObject* pObject, SET_SHADER_RESOURCE_FLAGS Flags = SET_SHADER_RESOURCE_FLAG_NONE)
+    {
+        IShaderResourceVariable* pVar = GetStaticVariable<ResType>();
+        VERIFY(pVar != nullptr, "Static variable '", ResType::GetName(), "' is not resolved");
+        pVar->Set(pObject, Flags);
+    }
+
+    /// Binds the objects to the static resource array.
+    template <typename ResType>
+    void SetStaticArray(IDeviceObject* const* ppObjects, Uint32 FirstElement, Uint32 NumElements, SET_SHADER_RESOURCE_FLAGS Flags = SET_SHADER_RESOURCE_FLAG_NONE)
+    {
+        VERIFY(FirstElement + NumElements <= ResType::ArraySize, "Elements [", FirstElement, ", ", FirstElement + NumElements,
+               ") are out of range of array '", ResType::GetName(), "' of size ", Uint32{ResType::ArraySize});
+        IShaderResourceVariable* pVar = GetStaticVariable<ResType>();
+        VERIFY(pVar != nullptr, "Static variable '", ResType::GetName(), "' is not resolved");
+        pVar->SetArray(ppObjects, FirstElement, NumElements, Flags);
+    }
+
+    /// Creates a typed shader resource binding.
+    SRBType CreateSRB(bool InitStaticResources = true) const;
+
+private:
+    RefCntAutoPtr<IPipelineResourceSignature> m_pSignature;
+
+    // Only the slots of static resources are not null.
+    std::array<IShaderResourceVariable*, sizeof...(ResourceTypes)> m_StaticVars{};
+};
+
+
+/// Shader resource binding of a typed resource signature.
+
+/// \tparam SignatureType - Diligent::TypedResourceSignature specialization.
+///
+/// Mutable and dynamic variables are resolved once when the wrapper is created and are then
+/// accessed by their compile-time slot index. The setters only verify their arguments in debug builds
+/// and call the variable directly, with no name or index lookups.
+template <typename SignatureType>
+class TypedShaderResourceBinding
+{
+public:
+    static constexpr Uint32 NumResources = SignatureType::NumResources;
+
+    TypedShaderResourceBinding() = default;
+
+    /// \param [in] pSRB - Shader resource binding created by the signature described by SignatureType.
+    explicit TypedShaderResourceBinding(IShaderResourceBinding* pSRB) :
+        m_pSRB{pSRB}
+    {
+        if (!m_pSRB)
+            return;
+
+        const std::array<PipelineResourceDesc, SignatureType::NumResources> Descs = SignatureType::GetResourceDescs();
+        for (Uint32 Slot = 0; Slot < NumResources; ++Slot)
+        {
+            const PipelineResourceDesc& Res = Descs[Slot];
+            if (Res.VarType == SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+                continue;
+
+            m_Vars[Slot] = m_pSRB->GetVariableByName(TypedResourceSignatureInternal::GetLookupStage(Res.ShaderStages), Res.Name);
+            DEV_CHECK_ERR(m_Vars[Slot] != nullptr, "Variable '", Res.Name, "' is not found in the SRB of signature '",
+                          m_pSRB->GetPipelineResourceSignature()->GetDesc().Name, "'");
+        }
+    }
+
+    IShaderResourceBinding* GetSRB() const { return m_pSRB.RawPtr<IShaderResourceBinding>(); }
+
+    explicit operator bool() const { return m_pSRB != nullptr; }
+
+    /// Returns the mutable or dynamic variable of the resource.
+    template <typename ResType>
+    IShaderResourceVariable* GetVariable() const
+    {
+        static_assert(ResType::VarType != SHADER_RESOURCE_VARIABLE_TYPE_STATIC,
+                      "Static resources are not accessed through the SRB. Use TypedResourceSignature::SetStatic()");
+        return m_Vars[SignatureType::template GetSlot<ResType>()];
+    }
+
+    /// Binds the object to the resource.
+    template <typename ResType>
+    void Set(IDeviceObject* pObject, SET_SHADER_RESOURCE_FLAGS Flags = SET_SHADER_RESOURCE_FLAG_NONE)
+    {
+        IShaderResourceVariable* pVar = GetVariable<ResType>();
+        VERIFY(pVar != nullptr, "Variable '", ResType::GetName(), "' is not resolved");
+        pVar->Set(pObject, Flags);
+    }
+
+    /// Binds the objects to the resource array.
+    template <typename ResType>
+    void SetArray(IDeviceObject* const* ppObjects, Uint32 FirstElement, Uint32 NumElements, SET_SHADER_RESOURCE_FLAGS Flags = SET_SHADER_RESOURCE_FLAG_NONE)
+    {
+        VERIFY(FirstElement + NumElements <= ResType::ArraySize, "Elements [", FirstElement, ", ", FirstElement + NumElements,
+               ") are out of range of array '", ResType::GetName(), "' of size ", Uint32{ResType::ArraySize});
+        IShaderResourceVariable* pVar = GetVariable<ResType>();
+        VERIFY(pVar != nullptr, "Variable '", ResType::GetName(), "' is not resolved");
+        pVar->SetArray(ppObjects, FirstElement, NumElements, Flags);
+    }
+
+    /// Binds the constant buffer range to the resource.
+    template <typename ResType>
+    void SetBufferRange(IDeviceObject*            pBuffer,
+                        Uint64                    Offset,
+                        Uint64                    Size,
+                        Uint32                    ArrayIndex = 0,
+                        SET_SHADER_RESOURCE_FLAGS Flags      = SET_SHADER_RESOURCE_FLAG_NONE)
+    {
+        static_assert(ResType::ResourceType == SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, "Buffer ranges are only allowed for constant buffers");
+        VERIFY(ArrayIndex < ResType::ArraySize, "Array index ", ArrayIndex, " is out of range of array '", ResType::GetName(),
+               "' of size ", Uint32{ResType::ArraySize});
+        IShaderResourceVariable* pVar = GetVariable<ResType>();
+        VERIFY(pVar != nullptr, "Variable '", ResType::GetName(), "' is not resolved");
+        pVar->SetBufferRange(pBuffer, Offset, Size, ArrayIndex, Flags);
+    }
+
+    /// Sets the dynamic offset of the constant or structured buffer resource.
+    template <typename ResType>
+    void SetBufferOffset(Uint32 Offset, Uint32 ArrayIndex = 0)
+    {
+        static_assert(ResType::ResourceType == SHADER_RESOURCE_TYPE_CONSTANT_BUFFER ||
+                          ResType::ResourceType == SHADER_RESOURCE_TYPE_BUFFER_SRV ||
+                          ResType::ResourceType == SHADER_RESOURCE_TYPE_BUFFER_UAV,
+                      "Dynamic offsets are only allowed for buffers");
+        static_assert((ResType::Flags & PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS) == 0,
+                      "Dynamic offsets are not allowed for resources with PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS flag");
+        VERIFY(ArrayIndex < ResType::ArraySize, "Array index ", ArrayIndex, " is out of range of array '", ResType::GetName(),
+               "' of size ", Uint32{ResType::ArraySize});
+        IShaderResourceVariable* pVar = GetVariable<ResType>();
+        VERIFY(pVar != nullptr, "Variable '", ResType::GetName(), "' is not resolved");
+        pVar->SetBufferOffset(Offset, ArrayIndex);
+    }
+
+private:
+    RefCntAutoPtr<IShaderResourceBinding> m_pSRB;
+
+    // Only the slots of mutable and dynamic resources are not null.
+    std::array<IShaderResourceVariable*, SignatureType::NumResources> m_Vars{};
+};
+
+
+template <typename... ResourceTypes>
+typename TypedResourceSignature<ResourceTypes...>::SRBType TypedResourceSignature<ResourceTypes...>::CreateSRB(bool InitStaticResources) const
+{
+    VERIFY(m_pSignature, "Signature is null");
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    GetSignature()->CreateShaderResourceBinding(&pSRB, InitStaticResources);
+    return SRBType{pSRB};
+}
+
+} // namespace Diligent
@@ -27,11 +27,14 @@
 #pragma once
 
 #include <cstring>
+#include <mutex>
+#include <unordered_map>
 
 #include "../../../Primitives/interface/BasicTypes.h"
 #include "../../../Graphics/GraphicsEngine/interface/Shader.h"
 #include "../../../Common/interface/StringTools.hpp"
 #include "../../../Common/interface/HashUtils.hpp"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
 
 struct XXH3_state_s;
 
@@ -49,25 +52,33 @@ struct XXH128Hash
     }
 };
 
+class XXH128DigestCache;
+
 struct XXH128State final
 {
     XXH128State();
 
+    /// \param [in] pDigestCache - Cache of the digests of shaders, resource signatures and render passes
+    ///                            that UpdateObject() combines. May be null.
+    explicit XXH128State(XXH128DigestCache* pDigestCache);
+
     ~XXH128State();
 
     XXH128State(const XXH128State& RHS) = delete;
     XXH128State& operator=(const XXH128State& RHS) = delete;
 
     XXH128State(XXH128State&& RHS) noexcept :
-        m_State{RHS.m_State}
+        m_State{RHS.m_State},
+        m_pDigestCache{RHS.m_pDigestCache}
     {
         RHS.m_State = nullptr;
     }
 
     XXH128State& operator=(XXH128State&& RHS) noexcept
     {
-        this->m_State = RHS.m_State;
-        RHS.m_State   = nullptr;
+        this->m_State        = RHS.m_State;
+        this->m_pDigestCache = RHS.m_pDigestCache;
+        RHS.m_State          = nullptr;
 
         return *this;
     }
@@ -123,6 +134,15 @@ struct XXH128State final
 
     void Update(const ShaderCreateInfo& ShaderCI) noexcept;
 
+    /// Combines the digest of the object referenced by a pipeline state create info.
+
+    /// The digest is taken from the digest cache if one was given to the constructor,
+    /// and is computed by XXH128DigestCache::ComputeDigest() otherwise. In both cases
+    /// the resulting hash is the same.
+    void UpdateObject(IShader* pShader) noexcept;
+    void UpdateObject(const IPipelineResourceSignature* pSignature) noexcept;
+    void UpdateObject(const IRenderPass* pRenderPass) noexcept;
+
     template <typename T>
     typename std::enable_if<(std::is_same<typename std::remove_cv<T>::type, SamplerDesc>::value ||
                              std::is_same<typename std::remove_cv<T>::type, StencilOpDesc>::value ||
@@ -165,8 +185,69 @@ struct XXH128State final
 
     XXH128Hash Digest() noexcept;
 
+private:
+    void UpdateDigest(const XXH128Hash& Digest) noexcept
+    {
+        Update(Digest.LowPart, Digest.HighPart);
+    }
+
 private:
     XXH3_state_s* m_State = nullptr;
+
+    XXH128DigestCache* m_pDigestCache = nullptr;
+};
+
+
+/// Cache of XXH128 digests of immutable device objects: shaders, resource signatures and render passes.
+
+/// Hashing a pipeline state create info with an XXH128State that uses the cache combines
+/// the digests of the referenced objects instead of re-hashing the shader bytecode and the
+/// signature and render pass descriptions every time.
+///
+/// Digests are keyed by object address. The cache keeps weak references to the objects,
+/// so that a digest is recomputed if an object is destroyed and another one is created
+/// at the same address. Objects whose contents change in place (e.g. hot-reloadable shaders)
+/// must be removed with Invalidate() after they are modified.
+///
+/// \remarks   All methods are thread-safe.
+class XXH128DigestCache
+{
+public:
+    XXH128Hash GetDigest(IShader* pShader);
+    XXH128Hash GetDigest(const IPipelineResourceSignature* pSignature);
+    XXH128Hash GetDigest(const IRenderPass* pRenderPass);
+
+    static XXH128Hash ComputeDigest(IShader* pShader);
+    static XXH128Hash ComputeDigest(const IPipelineResourceSignature* pSignature);
+    static XXH128Hash ComputeDigest(const IRenderPass* pRenderPass);
+
+    /// Removes the digest of the object.
+    void Invalidate(const IObject* pObject);
+
+    /// Removes all digests.
+    void Clear();
+
+    /// Returns the number of cached digests.
+    size_t GetSize() const;
+
+private:
+    template <typename ObjectType>
+    XXH128Hash GetDigestImpl(ObjectType* pObject);
+
+    // Removes the entries of destroyed objects.
+    void PurgeExpired();
+
+    struct Entry
+    {
+        RefCntWeakPtr<IObject> wpObject;
+        XXH128Hash             Digest;
+    };
+
+    mutable std::mutex                        m_Mtx;
+    std::unordered_map<const IObject*, Entry> m_Entries;
+
+    // The entries of destroyed objects are purged when the cache grows to this size.
+    size_t m_PurgeThreshold = 64;
 };
 
 } // namespace Diligent
@@ -0,0 +1,376 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "AsyncReadbackQueue.hpp"
+
+#include <algorithm>
+
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "GraphicsAccessories.hpp"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Staging buffer sizes are rounded up to a power of two, so that
+// the buffers can be reused by readbacks of similar sizes.
+constexpr Uint64 MinStagingBufferSize = 256;
+
+IRenderDevice* ValidateDevice(IRenderDevice* pDevice)
+{
+    if (pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+    return pDevice;
+}
+
+bool IsSameStagingTexture(const TextureDesc& Desc1, const TextureDesc& Desc2)
+{
+    // clang-format off
+    return Desc1.Type      == Desc2.Type      &&
+           Desc1.Width     == Desc2.Width     &&
+           Desc1.Height    == Desc2.Height    &&
+           Desc1.Depth     == Desc2.Depth     &&
+           Desc1.Format    == Desc2.Format    &&
+           Desc1.MipLevels == Desc2.MipLevels;
+    // clang-format on
+}
+
+} // namespace
+
+struct AsyncReadbackQueue::Readback
+{
+    RefCntAutoPtr<IBuffer>  pStagingBuffer;
+    RefCntAutoPtr<ITexture> pStagingTexture;
+
+    CallbackType Callback;
+    ReadbackData Data;
+
+    // The task that runs the callback when the thread pool is used.
+    RefCntAutoPtr<IAsyncTask> pTask;
+
+    bool IsMapped = false;
+};
+
+AsyncReadbackQueue::AsyncReadbackQueue(const CreateInfo& CI) :
+    // clang-format off
+    m_pDevice           {ValidateDevice(CI.pDevice)},
+    m_pThreadPool       {CI.pThreadPool},
+    m_MaxPooledResources{CI.MaxPooledResources},
+    m_AwaitQueue        {CI.pDevice}
+// clang-format on
+{
+}
+
+AsyncReadbackQueue::~AsyncReadbackQueue()
+{
+    for (auto& pRB : m_MappedReadbacks)
+    {
+        if (pRB->pTask)
+            pRB->pTask->WaitForCompletion();
+    }
+    DEV_CHECK_ERR(m_MappedReadbacks.empty(), "Destroying async readback queue with mapped staging resources. Call Flush() or Process() to unmap them.");
+}
+
+std::unique_ptr<AsyncReadbackQueue::Readback> AsyncReadbackQueue::CreateReadback(CallbackType&& Callback)
+{
+    auto pRB = m_AwaitQueue.GetRecycled();
+    if (!pRB)
+        pRB = std::make_unique<Readback>();
+    pRB->Callback = std::move(Callback);
+    return pRB;
+}
+
+RefCntAutoPtr<IBuffer> AsyncReadbackQueue::GetStagingBuffer(Uint64 Size)
+{
+    Uint64 StagingSize = MinStagingBufferSize;
+    while (StagingSize < Size)
+        StagingSize *= 2;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+
+    auto it = std::find_if(m_StagingBuffers.begin(), m_StagingBuffers.end(),
+                           [StagingSize](const RefCntAutoPtr<IBuffer>& pBuff) { return pBuff->GetDesc().Size == StagingSize; });
+    if (it != m_StagingBuffers.end())
+    {
+        pBuffer = std::move(*it);
+        m_StagingBuffers.erase(it);
+        return pBuffer;
+    }
+
+    BufferDesc Desc;
+    Desc.Name           = "Async readback staging buffer";
+    Desc.Size           = StagingSize;
+    Desc.Usage          = USAGE_STAGING;
+    Desc.CPUAccessFlags = CPU_ACCESS_READ;
+    m_pDevice->CreateBuffer(Desc, nullptr, &pBuffer);
+    if (!pBuffer)
+        LOG_ERROR_MESSAGE("Failed to create staging buffer of size ", StagingSize);
+
+    return pBuffer;
+}
+
+RefCntAutoPtr<ITexture> AsyncReadbackQueue::GetStagingTexture(const TextureDesc& Desc)
+{
+    RefCntAutoPtr<ITexture> pTexture;
+
+    auto it = std::find_if(m_StagingTextures.begin(), m_StagingTextures.end(),
+                           [&Desc](const RefCntAutoPtr<ITexture>& pTex) { return IsSameStagingTexture(pTex->GetDesc(), Desc); });
+    if (it != m_StagingTextures.end())
+    {
+        pTexture = std::move(*it);
+        m_StagingTextures.erase(it);
+        return pTexture;
+    }
+
+    m_pDevice->CreateTexture(Desc, nullptr, &pTexture);
+    if (!pTexture)
+        LOG_ERROR_MESSAGE("Failed to create ", Desc.Width, "x", Desc.Height, " staging texture");
+
+    return pTexture;
+}
+
+bool AsyncReadbackQueue::ReadBuffer(IDeviceContext* pContext,
+                                    IBuffer*        pSrcBuffer,
+                                    Uint64          Offset,
+                                    Uint64          Size,
+                                    CallbackType    Callback)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(pSrcBuffer != nullptr, "Source buffer must not be null");
+    DEV_CHECK_ERR(Callback, "Callback must not be null");
+
+    const auto& SrcDesc = pSrcBuffer->GetDesc();
+    if (Size == 0 || Offset + Size > SrcDesc.Size)
+    {
+        LOG_ERROR_MESSAGE("Readback range [", Offset, ", ", Offset + Size, ") is empty or exceeds the size of buffer '", SrcDesc.Name, "' (", SrcDesc.Size, ")");
+        return false;
+    }
+
+    auto pStagingBuffer = GetStagingBuffer(Size);
+    if (!pStagingBuffer)
+        return false;
+
+    pContext->CopyBuffer(pSrcBuffer, Offset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    auto pRB            = CreateReadback(std::move(Callback));
+    pRB->pStagingBuffer = std::move(pStagingBuffer);
+    pRB->Data.Size      = Size;
+    m_AwaitQueue.Enqueue(pContext, std::move(pRB));
+    ++m_NumPendingReadbacks;
+
+    return true;
+}
+
+bool AsyncReadbackQueue::ReadTexture(IDeviceContext* pContext,
+                                     ITexture*       pSrcTexture,
+                                     Uint32          MipLevel,
+                                     Uint32          Slice,
+                                     const Box*      pRegion,
+                                     CallbackType    Callback)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(pSrcTexture != nullptr, "Source texture must not be null");
+    DEV_CHECK_ERR(Callback, "Callback must not be null");
+
+    const auto& SrcDesc = pSrcTexture->GetDesc();
+    if (MipLevel >= SrcDesc.MipLevels || Slice >= SrcDesc.GetArraySize())
+    {
+        LOG_ERROR_MESSAGE("Mip level ", MipLevel, " or slice ", Slice, " is out of range of texture '", SrcDesc.Name, "'");
+        return false;
+    }
+
+    const auto MipProps = GetMipLevelProperties(SrcDesc, MipLevel);
+
+    const Box Region = pRegion != nullptr ? *pRegion : Box{0, MipProps.LogicalWidth, 0, MipProps.LogicalHeight, 0, MipProps.Depth};
+    if (Region.Width() == 0 || Region.Height() == 0 || Region.Depth() == 0 ||
+        Region.MaxX > MipProps.LogicalWidth || Region.MaxY > MipProps.LogicalHeight || Region.MaxZ > MipProps.Depth)
+    {
+        LOG_ERROR_MESSAGE("Readback region is empty or exceeds the dimensions of mip level ", MipLevel, " of texture '", SrcDesc.Name, "'");
+        return false;
+    }
+
+    TextureDesc StagingDesc;
+    StagingDesc.Name           = "Async readback staging texture";
+    StagingDesc.Type           = SrcDesc.Is3D() ? RESOURCE_DIM_TEX_3D : (SrcDesc.Is1D() ? RESOURCE_DIM_TEX_1D : RESOURCE_DIM_TEX_2D);
+    StagingDesc.Width          = Region.Width();
+    StagingDesc.Height         = Region.Height();
+    StagingDesc.Depth          = SrcDesc.Is3D() ? Region.Depth() : 1;
+    StagingDesc.Format         = SrcDesc.Format;
+    StagingDesc.Usage          = USAGE_STAGING;
+    StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    auto pStagingTexture = GetStagingTexture(StagingDesc);
+    if (!pStagingTexture)
+        return false;
+
+    CopyTextureAttribs CopyAttribs{pSrcTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+    CopyAttribs.SrcMipLevel = MipLevel;
+    CopyAttribs.SrcSlice    = Slice;
+    CopyAttribs.pSrcBox     = &Region;
+    pContext->CopyTexture(CopyAttribs);
+
+    auto pRB             = CreateReadback(std::move(Callback));
+    pRB->pStagingTexture = std::move(pStagingTexture);
+    pRB->Data.Region     = Region;
+    m_AwaitQueue.Enqueue(pContext, std::move(pRB));
+    ++m_NumPendingReadbacks;
+
+    return true;
+}
+
+bool AsyncReadbackQueue::MapReadback(IDeviceContext* pContext, Readback& RB)
+{
+    if (RB.pStagingBuffer)
+    {
+        void* pData = nullptr;
+        pContext->MapBuffer(RB.pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        RB.Data.pData = pData;
+    }
+    else
+    {
+        MappedTextureSubresource MappedData;
+        pContext->MapTextureSubresource(RB.pStagingTexture, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+        RB.Data.pData       = MappedData.pData;
+        RB.Data.Stride      = MappedData.Stride;
+        RB.Data.DepthStride = MappedData.DepthStride;
+
+        const auto& Region   = RB.Data.Region;
+        const auto  CopyInfo = GetBufferToTextureCopyInfo(RB.pStagingTexture->GetDesc().Format, Box{0, Region.Width(), 0, Region.Height(), 0, Region.Depth()}, 1);
+        RB.Data.Size         = (Region.Depth() - 1) * RB.Data.DepthStride + (CopyInfo.RowCount - 1) * RB.Data.Stride + CopyInfo.RowSize;
+    }
+
+    RB.IsMapped = RB.Data.pData != nullptr;
+    return RB.IsMapped;
+}
+
+void AsyncReadbackQueue::DispatchReadback(IDeviceContext* pContext, std::unique_ptr<Readback>&& pRB)
+{
+    if (!MapReadback(pContext, *pRB))
+    {
+        LOG_ERROR_MESSAGE("Failed to map the staging resource. The readback callback will not be called.");
+        RetireReadback(pContext, std::move(pRB));
+        return;
+    }
+
+    if (m_pThreadPool)
+    {
+        // The readback object is owned by m_MappedReadbacks until the task is finished.
+        Readback* pRawRB = pRB.get();
+        pRB->pTask       = EnqueueAsyncWork(m_pThreadPool, [pRawRB](Uint32) {
+            pRawRB->Callback(pRawRB->Data);
+        });
+        m_MappedReadbacks.emplace_back(std::move(pRB));
+    }
+    else
+    {
+        pRB->Callback(pRB->Data);
+        RetireReadback(pContext, std::move(pRB));
+    }
+}
+
+void AsyncReadbackQueue::RetireReadback(IDeviceContext* pContext, std::unique_ptr<Readback>&& pRB)
+{
+    if (pRB->pStagingBuffer)
+    {
+        if (pRB->IsMapped)
+            pContext->UnmapBuffer(pRB->pStagingBuffer, MAP_READ);
+        if (m_StagingBuffers.size() >= m_MaxPooledResources && !m_StagingBuffers.empty())
+            m_StagingBuffers.erase(m_StagingBuffers.begin());
+        if (m_MaxPooledResources > 0)
+            m_StagingBuffers.emplace_back(std::move(pRB->pStagingBuffer));
+    }
+    else if (pRB->pStagingTexture)
+    {
+        if (pRB->IsMapped)
+            pContext->UnmapTextureSubresource(pRB->pStagingTexture, 0, 0);
+        if (m_StagingTextures.size() >= m_MaxPooledResources && !m_StagingTextures.empty())
+            m_StagingTextures.erase(m_StagingTextures.begin());
+        if (m_MaxPooledResources > 0)
+            m_StagingTextures.emplace_back(std::move(pRB->pStagingTexture));
+    }
+
+    pRB->pStagingBuffer.Release();
+    pRB->pStagingTexture.Release();
+    pRB->Callback = nullptr;
+    pRB->Data     = {};
+    pRB->pTask.Release();
+    pRB->IsMapped = false;
+    m_AwaitQueue.Recycle(std::move(pRB));
+
+    VERIFY_EXPR(m_NumPendingReadbacks > 0);
+    --m_NumPendingReadbacks;
+}
+
+void AsyncReadbackQueue::RetireFinishedReadbacks(IDeviceContext* pContext, bool WaitForCallbacks)
+{
+    auto it = m_MappedReadbacks.begin();
+    while (it != m_MappedReadbacks.end())
+    {
+        auto& pTask = (*it)->pTask;
+        if (pTask && !pTask->IsFinished())
+        {
+            if (!WaitForCallbacks)
+            {
+                ++it;
+                continue;
+            }
+            pTask->WaitForCompletion();
+        }
+
+        RetireReadback(pContext, std::move(*it));
+        it = m_MappedReadbacks.erase(it);
+    }
+}
+
+void AsyncReadbackQueue::Process(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    RetireFinishedReadbacks(pContext, false);
+
+    while (auto pRB = m_AwaitQueue.GetFirstCompleted())
+        DispatchReadback(pContext, std::move(pRB));
+}
+
+void AsyncReadbackQueue::Flush(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    pContext->Flush();
+    while (auto pRB = m_AwaitQueue.WaitForFirstCompleted())
+        DispatchReadback(pContext, std::move(pRB));
+
+    RetireFinishedReadbacks(pContext, true);
+}
+
+} // namespace Diligent
@@ -29,6 +29,9 @@
 
 #include <mutex>
 #include <atomic>
+#include <vector>
+#include <unordered_set>
+#include <algorithm>
 
 #include "DebugUtilities.hpp"
 #include "ObjectBase.hpp"
@@ -52,13 +55,15 @@ public:
                             BufferSuballocatorImpl*                      pParentAllocator,
                             Uint32                                       Offset,
                             Uint32                                       Size,
+                            Uint32                                       Alignment,
                             VariableSizeAllocationsManager::Allocation&& Subregion) :
         // clang-format off
         TBase             {pRefCounters},
         m_pParentAllocator{pParentAllocator},
         m_Subregion       {std::move(Subregion)},
         m_Offset          {Offset},
-        m_Size            {Size}
+        m_Size            {Size},
+        m_Alignment       {Alignment}
     // clang-format on
     {
         VERIFY_EXPR(m_pParentAllocator);
@@ -83,7 +88,7 @@ public:
 
     virtual Uint32 GetOffset() const override final
     {
-        return m_Offset;
+        return m_Offset.load();
     }
 
     virtual Uint32 GetSize() const override final
@@ -93,6 +98,22 @@ public:
 
     virtual IBufferSuballocator* GetAllocator() override final;
 
+    Uint32 GetAlignment() const
+    {
+        return m_Alignment;
+    }
+
+    // Replaces the subregion with the new one and returns the old subregion.
+    // Must be called with the parent's mutex locked.
+    VariableSizeAllocationsManager::Allocation Move(Uint32 NewOffset, VariableSizeAllocationsManager::Allocation&& NewSubregion)
+    {
+        VERIFY_EXPR(NewSubregion.IsValid());
+        auto OldSubregion = std::move(m_Subregion);
+        m_Subregion       = std::move(NewSubregion);
+        m_Offset.store(NewOffset);
+        return OldSubregion;
+    }
+
     virtual void SetUserData(IObject* pUserData) override final
     {
         m_pUserData = pUserData;
@@ -106,10 +127,13 @@ public:
 private:
     RefCntAutoPtr<BufferSuballocatorImpl> m_pParentAllocator;
 
+    // Protected by the parent's mutex
     VariableSizeAllocationsManager::Allocation m_Subregion;
 
-    const Uint32 m_Offset;
-    const Uint32 m_Size;
+    // The offset may be changed by defragmentation
+    std::atomic<Uint32> m_Offset{0};
+    const Uint32        m_Size;
+    const Uint32        m_Alignment;
 
     RefCntAutoPtr<IObject> m_pUserData;
 };
@@ -139,7 +163,11 @@ public:
             }
         },
         m_BufferSize{m_Buffer.GetDesc().Size},
+        m_CommittedSize{m_Buffer.GetMemoryUsage()},
         m_ExpansionSize{CreateInfo.ExpansionSize},
+        m_MinSize{m_MgrSize.load()},
+        m_ShrinkPageSize{CreateInfo.ShrinkUnusedSpace ? (CreateInfo.ExpansionSize != 0 ? CreateInfo.ExpansionSize : StaticCast<size_t>(CreateInfo.Desc.Size)) : 0},
+        m_DefragmentationEnabled{CreateInfo.EnableDefragmentation},
         m_SuballocationsAllocator
         {
             DefaultRawMemoryAllocator::GetAllocator(),
@@ -152,21 +180,30 @@ public:
     ~BufferSuballocatorImpl()
     {
         VERIFY_EXPR(m_AllocationCount.load() == 0);
+        VERIFY_EXPR(m_Suballocations.empty());
     }
 
     virtual IBuffer* GetBuffer(IRenderDevice* pDevice, IDeviceContext* pContext) override final
     {
         // NB: mutex must not be locked here to avoid stalling render thread
+
+        // Reset the flag before reading the manager size so that a shrink that happens
+        // after this point is committed by the next call.
+        const auto ShrinkPending = m_ShrinkPending.exchange(false);
+
         const auto MgrSize = m_MgrSize.load();
         VERIFY_EXPR(m_BufferSize.load() == m_Buffer.GetDesc().Size);
-        if (MgrSize > m_Buffer.GetDesc().Size)
+        if (MgrSize > m_Buffer.GetDesc().Size || (ShrinkPending && MgrSize < m_Buffer.GetDesc().Size))
         {
             m_Buffer.Resize(pDevice, pContext, MgrSize);
             // We must use atomic because this value is read in another thread,
             // while m_Buffer internally does not use mutex or other synchronization.
             m_BufferSize.store(m_Buffer.GetDesc().Size);
         }
-        return m_Buffer.GetBuffer(pDevice, pContext);
+
+        auto* pBuffer = m_Buffer.GetBuffer(pDevice, pContext);
+        m_CommittedSize.store(m_Buffer.GetMemoryUsage());
+        return pBuffer;
     }
 
     virtual void Allocate(Uint32                 Size,
@@ -192,9 +229,11 @@ public:
             {
                 // After the resize, the actual buffer size may be larger due to alignment
                 // requirements (for sparse buffers, the size is aligned by the memory page size).
+                // If the manager has been shrunk, but the buffer has not been resized yet,
+                // the difference is not the alignment padding.
                 const auto BufferSize = m_BufferSize.load();
                 const auto MgrSize    = m_Mgr.GetMaxSize();
-                if (BufferSize > MgrSize)
+                if (BufferSize > MgrSize && !m_ShrinkPending.load())
                 {
                     m_Mgr.Extend(StaticCast<size_t>(BufferSize - MgrSize));
                     VERIFY_EXPR(m_Mgr.GetMaxSize() == BufferSize);
@@ -226,38 +265,177 @@ public:
                 this,
                 AlignUp(static_cast<Uint32>(Subregion.UnalignedOffset), Alignment),
                 Size,
+                Alignment,
                 std::move(Subregion)
             )
         };
         // clang-format on
 
+        if (m_DefragmentationEnabled)
+        {
+            std::lock_guard<std::mutex> Lock{m_MgrMtx};
+            m_Suballocations.insert(pSuballocation);
+        }
+
         pSuballocation->QueryInterface(IID_BufferSuballocation, reinterpret_cast<IObject**>(ppSuballocation));
         m_AllocationCount.fetch_add(1);
     }
 
-    void Free(VariableSizeAllocationsManager::Allocation&& Subregion)
+    void Free(BufferSuballocationImpl* pSuballocation, VariableSizeAllocationsManager::Allocation& Subregion)
     {
         std::lock_guard<std::mutex> Lock{m_MgrMtx};
+        if (m_DefragmentationEnabled)
+            m_Suballocations.erase(pSuballocation);
+        // NB: the subregion must be read while the mutex is locked as it may be changed by Defragment()
         m_Mgr.Free(std::move(Subregion));
         m_AllocationCount.fetch_add(-1);
+        if (m_ShrinkPageSize != 0)
+            ShrinkUnusedSpace();
         UpdateUsageStats();
     }
 
     virtual Uint32 GetVersion() const override final
     {
-        return m_Buffer.GetVersion();
+        return m_Buffer.GetVersion() + m_DefragmentationVersion.load();
     }
 
     virtual void GetUsageStats(BufferSuballocatorUsageStats& UsageStats) override final
     {
         // NB: mutex must not be locked here to avoid stalling render thread
         UsageStats.Size             = m_BufferSize.load();
+        UsageStats.CommittedSize    = m_CommittedSize.load();
         UsageStats.UsedSize         = m_UsedSize.load();
         UsageStats.MaxFreeChunkSize = m_MaxFreeBlockSize.load();
         UsageStats.AllocationCount  = m_AllocationCount.load();
     }
 
+    virtual Uint32 Defragment(const BufferSuballocatorDefragmentAttribs& Attribs) override final
+    {
+        if (!m_DefragmentationEnabled)
+        {
+            DEV_ERROR("Defragmentation is not enabled. Set BufferSuballocatorCreateInfo::EnableDefragmentation to true.");
+            return 0;
+        }
+        DEV_CHECK_ERR(Attribs.pContext != nullptr, "Device context must not be null");
+
+        // Commit pending resizes first so that the buffer covers the entire manager range.
+        auto* pBuffer = GetBuffer(Attribs.pDevice, Attribs.pContext);
+        if (pBuffer == nullptr)
+            return 0;
+
+        std::lock_guard<std::mutex> Lock{m_MgrMtx};
+
+        const auto BufferSize = m_BufferSize.load();
+
+        // Process suballocations starting from the end of the buffer
+        std::vector<BufferSuballocationImpl*> Suballocations{m_Suballocations.begin(), m_Suballocations.end()};
+        std::sort(Suballocations.begin(), Suballocations.end(),
+                  [](const BufferSuballocationImpl* lhs, const BufferSuballocationImpl* rhs) {
+                      return lhs->GetOffset() > rhs->GetOffset();
+                  });
+
+        Uint32 NumMoved   = 0;
+        Uint64 BytesMoved = 0;
+        for (auto* pSuballocation : Suballocations)
+        {
+            const auto Size = pSuballocation->GetSize();
+            if (Attribs.MaxBytesToMove != 0 && NumMoved > 0 && BytesMoved + Size > Attribs.MaxBytesToMove)
+                break;
+
+            const auto OldOffset = pSuballocation->GetOffset();
+            const auto Alignment = pSuballocation->GetAlignment();
+
+            auto NewSubregion = m_Mgr.Allocate(Size, Alignment);
+            if (!NewSubregion.IsValid())
+                continue;
+
+            const auto NewOffset = AlignUp(static_cast<Uint32>(NewSubregion.UnalignedOffset), Alignment);
+            if (NewOffset >= OldOffset || NewOffset + Size > BufferSize)
+            {
+                // The only free block that fits the suballocation is not closer to the beginning
+                m_Mgr.Free(std::move(NewSubregion));
+                continue;
+            }
+
+            if (!CopyData(Attribs.pDevice, Attribs.pContext, pBuffer, OldOffset, NewOffset, Size))
+            {
+                m_Mgr.Free(std::move(NewSubregion));
+                break;
+            }
+
+            m_Mgr.Free(pSuballocation->Move(NewOffset, std::move(NewSubregion)));
+
+            if (Attribs.MovedCallback != nullptr)
+                Attribs.MovedCallback(pSuballocation, OldOffset, Attribs.pCallbackUserData);
+
+            ++NumMoved;
+            BytesMoved += Size;
+        }
+
+        if (NumMoved > 0)
+        {
+            m_DefragmentationVersion.fetch_add(1);
+            if (m_ShrinkPageSize != 0)
+                ShrinkUnusedSpace();
+            UpdateUsageStats();
+        }
+
+        return NumMoved;
+    }
+
 private:
+    // Copies the data between two regions of the buffer through the scratch buffer.
+    // Must be called with m_MgrMtx locked.
+    bool CopyData(IRenderDevice* pDevice, IDeviceContext* pContext, IBuffer* pBuffer, Uint64 SrcOffset, Uint64 DstOffset, Uint64 Size)
+    {
+        if (!m_pScratchBuffer || m_pScratchBuffer->GetDesc().Size < Size)
+        {
+            if (pDevice == nullptr)
+            {
+                DEV_ERROR("Render device must not be null when the scratch buffer needs to be created");
+                return false;
+            }
+
+            BufferDesc Desc        = pBuffer->GetDesc();
+            Desc.Name              = "Buffer suballocator defragmentation scratch buffer";
+            Desc.Usage             = USAGE_DEFAULT;
+            Desc.BindFlags         = BIND_NONE;
+            Desc.CPUAccessFlags    = CPU_ACCESS_NONE;
+            Desc.Mode              = BUFFER_MODE_UNDEFINED;
+            Desc.ElementByteStride = 0;
+            Desc.Size              = std::max(Size, m_pScratchBuffer ? m_pScratchBuffer->GetDesc().Size * 2 : Uint64{0});
+
+            m_pScratchBuffer.Release();
+            pDevice->CreateBuffer(Desc, nullptr, &m_pScratchBuffer);
+            if (!m_pScratchBuffer)
+            {
+                LOG_ERROR_MESSAGE("Failed to create the defragmentation scratch buffer");
+                return false;
+            }
+        }
+
+        pContext->CopyBuffer(pBuffer, SrcOffset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             m_pScratchBuffer, 0, Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->CopyBuffer(m_pScratchBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             pBuffer, DstOffset, Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        return true;
+    }
+
+    // Releases the free space at the end of the manager range in whole pages.
+    // Must be called with m_MgrMtx locked.
+    void ShrinkUnusedSpace()
+    {
+        const auto MgrSize       = m_Mgr.GetMaxSize();
+        const auto TrailingFree  = std::min(m_Mgr.GetTrailingFreeSize(), MgrSize - std::min(MgrSize, m_MinSize));
+        const auto SizeToRelease = TrailingFree - TrailingFree % m_ShrinkPageSize;
+        if (SizeToRelease == 0)
+            return;
+
+        m_Mgr.Shrink(SizeToRelease);
+        m_MgrSize.store(m_Mgr.GetMaxSize());
+        m_ShrinkPending.store(true);
+    }
+
     void UpdateUsageStats()
     {
         m_UsedSize.store(m_Mgr.GetUsedSize());
@@ -272,9 +450,27 @@ private:
 
     DynamicBuffer       m_Buffer;
     std::atomic<Uint64> m_BufferSize{0};
+    std::atomic<Uint64> m_CommittedSize{0};
 
     const Uint32 m_ExpansionSize;
 
+    // The buffer is never shrunk below its initial size
+    const size_t m_MinSize;
+    // Shrink granularity; zero if shrinking is disabled
+    const size_t m_ShrinkPageSize;
+
+    // Set when the manager has been shrunk, but the buffer has not been resized yet
+    std::atomic<bool> m_ShrinkPending{false};
+
+    const bool m_DefragmentationEnabled;
+
+    // Live suballocations; only tracked when defragmentation is enabled. Protected by m_MgrMtx.
+    std::unordered_set<BufferSuballocationImpl*> m_Suballocations;
+
+    RefCntAutoPtr<IBuffer> m_pScratchBuffer;
+
+    std::atomic<Uint32> m_DefragmentationVersion{0};
+
     std::atomic<Int32>  m_AllocationCount{0};
     std::atomic<Uint64> m_UsedSize{0};
     std::atomic<Uint64> m_MaxFreeBlockSize{0};
@@ -285,7 +481,7 @@ private:
 
 BufferSuballocationImpl::~BufferSuballocationImpl()
 {
-    m_pParentAllocator->Free(std::move(m_Subregion));
+    m_pParentAllocator->Free(this, m_Subregion);
 }
 
 IBufferSuballocator* BufferSuballocationImpl::GetAllocator()
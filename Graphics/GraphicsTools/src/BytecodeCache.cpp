@@ -25,6 +25,9 @@
  */
 
 #include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "RefCntAutoPtr.hpp"
 #include "DataBlobImpl.hpp"
@@ -33,6 +36,7 @@
 #include "BytecodeCache.h"
 #include "XXH128Hasher.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
+#include "CacheFileJournal.hpp"
 
 namespace Diligent
 {
@@ -46,7 +50,7 @@ public:
     struct BytecodeCacheHeader
     {
         static constexpr Uint32 HeaderMagic   = 0x7ADECACE;
-        static constexpr Uint32 HeaderVersion = 1;
+        static constexpr Uint32 HeaderVersion = 2;
 
         Uint32 Magic   = HeaderMagic;
         Uint32 Version = HeaderVersion;
@@ -76,8 +80,26 @@ public:
     BytecodeCacheImpl(IReferenceCounters*            pRefCounters,
                       const BytecodeCacheCreateInfo& CreateInfo) :
         TBase{pRefCounters},
-        m_DeviceType{CreateInfo.DeviceType}
+        m_DeviceType{CreateInfo.DeviceType},
+        m_DeviceAPIVersion{CreateInfo.DeviceAPIVersion}
     {
+        if (CreateInfo.FilePath != nullptr)
+        {
+            CacheFileJournal::CreateInfo JournalCI;
+            JournalCI.FilePath            = CreateInfo.FilePath;
+            JournalCI.Magic               = BytecodeCacheHeader::HeaderMagic;
+            JournalCI.Version             = BytecodeCacheHeader::HeaderVersion;
+            JournalCI.pThreadPool         = CreateInfo.pWriterThreadPool;
+            JournalCI.CompactionThreshold = CreateInfo.CompactionThreshold;
+            JournalCI.ReadPendingData     = [this]() {
+                return ReadPendingEntries();
+            };
+            JournalCI.MergeRecords = MergeJournalRecords;
+
+            m_pJournal = std::make_unique<CacheFileJournal>(JournalCI);
+            for (const auto& pRecord : m_pJournal->Load())
+                ReadEntries(pRecord, m_HashMap, /*IsJournalRecord = */ true);
+        }
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_BytecodeCache, TBase);
@@ -90,33 +112,7 @@ public:
             return false;
         }
 
-        Serializer<SerializerMode::Read> Stream{SerializedData{pDataBlob->GetDataPtr(), pDataBlob->GetSize()}};
-
-        BytecodeCacheHeader Header;
-        Header.Serialize(Stream);
-        if (Header.Magic != BytecodeCacheHeader::HeaderMagic)
-        {
-            LOG_ERROR_MESSAGE("Incorrect bytecode header magic number");
-            return false;
-        }
-
-        if (Header.Version != BytecodeCacheHeader::HeaderVersion)
-        {
-            LOG_ERROR_MESSAGE("Incorrect bytecode header version (", Header.Version, "). ", Uint32{BytecodeCacheHeader::HeaderVersion}, " is expected.");
-            return false;
-        }
-
-        for (Uint64 ItemID = 0; ItemID < Header.ElementCount; ItemID++)
-        {
-            BytecodeCacheElementHeader ElementHeader;
-            ElementHeader.Serialize(Stream);
-
-            auto pBytecode = DataBlobImpl::Create(ElementHeader.DataSize);
-            Stream.CopyBytes(pBytecode->GetDataPtr(), ElementHeader.DataSize);
-            m_HashMap.emplace(ElementHeader.Hash, pBytecode);
-        }
-
-        return true;
+        return ReadEntries(pDataBlob, m_HashMap, /*IsJournalRecord = */ false);
     }
 
     virtual void DILIGENT_CALL_TYPE GetBytecode(const ShaderCreateInfo& ShaderCI, IDataBlob** ppByteCode) override final
@@ -139,12 +135,16 @@ public:
         const auto Iter = m_HashMap.emplace(Hash, pByteCode);
         if (!Iter.second)
             Iter.first->second = pByteCode;
+
+        if (m_pJournal)
+            AddPendingEntry(Hash, pByteCode);
     }
 
     virtual void DILIGENT_CALL_TYPE RemoveBytecode(const ShaderCreateInfo& ShaderCI) override final
     {
         const auto Hash = ComputeHash(ShaderCI);
-        m_HashMap.erase(Hash);
+        if (m_HashMap.erase(Hash) != 0 && m_pJournal)
+            AddPendingEntry(Hash, nullptr);
     }
 
     virtual void DILIGENT_CALL_TYPE Store(IDataBlob** ppDataBlob) override final
@@ -152,22 +152,88 @@ public:
         DEV_CHECK_ERR(ppDataBlob != nullptr, "ppDataBlob must not be null.");
         DEV_CHECK_ERR(*ppDataBlob == nullptr, "*ppDataBlob is not null. Make sure you are not overwriting reference to an existing object as this may result in memory leaks.");
 
+        *ppDataBlob = WriteEntries(m_HashMap).Detach();
+    }
+
+    virtual void DILIGENT_CALL_TYPE Clear() override final
+    {
+        m_HashMap.clear();
+
+        if (m_pJournal)
+        {
+            {
+                std::lock_guard<std::mutex> Guard{m_PendingEntriesMtx};
+                m_PendingEntries.clear();
+            }
+            m_pJournal->Clear();
+        }
+    }
+
+private:
+    using HashMapType = std::unordered_map<XXH128Hash, RefCntAutoPtr<IDataBlob>>;
+
+    // In journal records, entries with zero data size mark the removed byte code.
+    static bool ReadEntries(const IDataBlob* pDataBlob, HashMapType& HashMap, bool IsJournalRecord)
+    {
+        Serializer<SerializerMode::Read> Stream{SerializedData{const_cast<void*>(pDataBlob->GetConstDataPtr()), pDataBlob->GetSize()}};
+
+        BytecodeCacheHeader Header;
+        Header.Serialize(Stream);
+        if (Header.Magic != BytecodeCacheHeader::HeaderMagic)
+        {
+            LOG_ERROR_MESSAGE("Incorrect bytecode header magic number");
+            return false;
+        }
+
+        if (Header.Version != BytecodeCacheHeader::HeaderVersion)
+        {
+            LOG_ERROR_MESSAGE("Incorrect bytecode header version (", Header.Version, "). ", Uint32{BytecodeCacheHeader::HeaderVersion}, " is expected.");
+            return false;
+        }
+
+        for (Uint64 ItemID = 0; ItemID < Header.ElementCount; ItemID++)
+        {
+            BytecodeCacheElementHeader ElementHeader;
+            ElementHeader.Serialize(Stream);
+
+            if (IsJournalRecord && ElementHeader.DataSize == 0)
+            {
+                HashMap.erase(ElementHeader.Hash);
+                continue;
+            }
+
+            auto pBytecode = DataBlobImpl::Create(ElementHeader.DataSize);
+            Stream.CopyBytes(pBytecode->GetDataPtr(), ElementHeader.DataSize);
+            if (IsJournalRecord)
+                HashMap[ElementHeader.Hash] = pBytecode;
+            else
+                HashMap.emplace(ElementHeader.Hash, pBytecode);
+        }
+
+        return true;
+    }
+
+    // Null byte code is written with zero data size, see ReadEntries().
+    template <typename EntriesType>
+    static RefCntAutoPtr<IDataBlob> WriteEntries(const EntriesType& Entries)
+    {
         auto WriteData = [&](auto& Stream) //
         {
             BytecodeCacheHeader Header{};
-            Header.ElementCount = m_HashMap.size();
+            Header.ElementCount = Entries.size();
             Header.Serialize(Stream);
 
-            for (auto const& Pair : m_HashMap)
+            for (auto const& Entry : Entries)
             {
-                const auto& pBytecode = Pair.second;
+                const auto& pBytecode = Entry.second;
 
                 BytecodeCacheElementHeader ElementHeader;
-                ElementHeader.Hash     = Pair.first;
-                ElementHeader.DataSize = pBytecode->GetSize();
+                ElementHeader.Hash     = Entry.first;
+                ElementHeader.DataSize = pBytecode ? pBytecode->GetSize() : 0;
                 ElementHeader.Serialize(Stream);
 
-                Stream.CopyBytes(pBytecode->GetConstDataPtr(), ElementHeader.DataSize);
+                if (pBytecode)
+                    Stream.CopyBytes(pBytecode->GetConstDataPtr(), ElementHeader.DataSize);
             }
         };
 
@@ -180,26 +246,60 @@ public:
         WriteData(WriteStream);
         VERIFY_EXPR(WriteStream.IsEnded());
 
-        *ppDataBlob = DataBlobImpl::Create(Memory.Size(), Memory.Ptr()).Detach();
+        return RefCntAutoPtr<IDataBlob>{DataBlobImpl::Create(Memory.Size(), Memory.Ptr())};
     }
 
-    virtual void DILIGENT_CALL_TYPE Clear() override final
+    void AddPendingEntry(const XXH128Hash& Hash, IDataBlob* pByteCode)
     {
-        m_HashMap.clear();
+        {
+            std::lock_guard<std::mutex> Guard{m_PendingEntriesMtx};
+            m_PendingEntries.emplace_back(Hash, pByteCode);
+        }
+        m_pJournal->RequestWrite();
+    }
+
+    // Called by the journal from the background thread
+    RefCntAutoPtr<IDataBlob> ReadPendingEntries()
+    {
+        std::vector<std::pair<XXH128Hash, RefCntAutoPtr<IDataBlob>>> Entries;
+        {
+            std::lock_guard<std::mutex> Guard{m_PendingEntriesMtx};
+            Entries.swap(m_PendingEntries);
+        }
+        return !Entries.empty() ? WriteEntries(Entries) : RefCntAutoPtr<IDataBlob>{};
+    }
+
+    // Called by the journal from the background thread
+    static RefCntAutoPtr<IDataBlob> MergeJournalRecords(const std::vector<RefCntAutoPtr<IDataBlob>>& Records)
+    {
+        HashMapType HashMap;
+        for (const auto& pRecord : Records)
+        {
+            if (!ReadEntries(pRecord, HashMap, /*IsJournalRecord = */ true))
+                return {};
+        }
+        return WriteEntries(HashMap);
     }
 
 private:
     XXH128Hash ComputeHash(const ShaderCreateInfo& ShaderCI) const
     {
         XXH128State Hasher;
-        Hasher.Update(ShaderCI, m_DeviceType);
+        Hasher.Update(ShaderCI, m_DeviceType, m_DeviceAPIVersion);
         return Hasher.Digest();
     }
 
 private:
     RENDER_DEVICE_TYPE m_DeviceType;
+    Version            m_DeviceAPIVersion;
+
+    HashMapType m_HashMap;
+
+    std::mutex                                                   m_PendingEntriesMtx;
+    std::vector<std::pair<XXH128Hash, RefCntAutoPtr<IDataBlob>>> m_PendingEntries;
 
-    std::unordered_map<XXH128Hash, RefCntAutoPtr<IDataBlob>> m_HashMap;
+    // Must be destroyed first as it waits for the background tasks that access the pending entries
+    std::unique_ptr<CacheFileJournal> m_pJournal;
 };
 
 void CreateBytecodeCache(const BytecodeCacheCreateInfo& CreateInfo,
@@ -0,0 +1,444 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "CacheFileJournal.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#include "DataBlobImpl.hpp"
+#include "FileSystem.hpp"
+#include "XXH128Hasher.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct JournalFileHeader
+{
+    Uint32 Magic   = 0;
+    Uint32 Version = 0;
+};
+static_assert(sizeof(JournalFileHeader) == 8, "Unexpected size of JournalFileHeader");
+
+struct JournalRecordHeader
+{
+    static constexpr Uint32 RecordMagic = 0x7EC0DDA7;
+
+    Uint32 Magic    = RecordMagic;
+    Uint32 Reserved = 0;
+    Uint64 DataSize = 0;
+    Uint64 HashLow  = 0;
+    Uint64 HashHigh = 0;
+};
+static_assert(sizeof(JournalRecordHeader) == 32, "Unexpected size of JournalRecordHeader");
+
+XXH128Hash ComputeRecordHash(const void* pData, size_t Size)
+{
+    XXH128State Hasher;
+    Hasher.UpdateRaw(pData, Size);
+    return Hasher.Digest();
+}
+
+bool ReadFileData(const std::string& Path, std::vector<Uint8>& Data)
+{
+    FILE* pFile = fopen(Path.c_str(), "rb");
+    if (pFile == nullptr)
+        return false;
+
+    fseek(pFile, 0, SEEK_END);
+    const auto Size = ftell(pFile);
+    fseek(pFile, 0, SEEK_SET);
+
+    bool Res = Size >= 0;
+    if (Res)
+    {
+        Data.resize(static_cast<size_t>(Size));
+        Res = Data.empty() || fread(Data.data(), 1, Data.size(), pFile) == Data.size();
+    }
+    fclose(pFile);
+
+    return Res;
+}
+
+bool WriteRecord(FILE* pFile, const IDataBlob* pData)
+{
+    const auto* pBytes = pData->GetConstDataPtr();
+    const auto  Size   = pData->GetSize();
+    const auto  Hash   = ComputeRecordHash(pBytes, Size);
+
+    JournalRecordHeader Header;
+    Header.DataSize = Size;
+    Header.HashLow  = Hash.LowPart;
+    Header.HashHigh = Hash.HighPart;
+    if (fwrite(&Header, sizeof(Header), 1, pFile) != 1)
+        return false;
+    if (Size > 0 && fwrite(pBytes, Size, 1, pFile) != 1)
+        return false;
+
+    // Flush the record to the OS so that it survives the process termination
+    return fflush(pFile) == 0;
+}
+
+} // namespace
+
+CacheFileJournal::CacheFileJournal(const CreateInfo& CI) noexcept(false) :
+    m_FilePath{CI.FilePath != nullptr ? CI.FilePath : ""},
+    m_TmpFilePath{m_FilePath + ".tmp"},
+    m_Magic{CI.Magic},
+    m_Version{CI.Version},
+    m_CompactionThreshold{CI.CompactionThreshold},
+    m_ReadPendingData{CI.ReadPendingData},
+    m_MergeRecords{CI.MergeRecords},
+    m_pThreadPool{CI.pThreadPool}
+{
+    if (m_FilePath.empty())
+        LOG_ERROR_AND_THROW("Cache file path must not be null or empty");
+
+    if (m_CompactionThreshold != 0 && !m_MergeRecords)
+        LOG_ERROR_AND_THROW("MergeRecords callback must not be null when compaction threshold is not zero");
+
+    if (!m_pThreadPool)
+    {
+        ThreadPoolCreateInfo ThreadPoolCI;
+        ThreadPoolCI.NumThreads = 1;
+        m_pThreadPool           = CreateThreadPool(ThreadPoolCI);
+        if (!m_pThreadPool)
+            LOG_ERROR_AND_THROW("Failed to create the thread pool for the cache file '", m_FilePath, "'");
+    }
+}
+
+CacheFileJournal::~CacheFileJournal()
+{
+    WaitForIdle();
+}
+
+std::vector<RefCntAutoPtr<IDataBlob>> CacheFileJournal::Load()
+{
+    std::lock_guard<std::mutex> Guard{m_FileMtx};
+
+    // The process may have terminated after the original file was removed, but before
+    // the compacted file was renamed.
+    if (!FileSystem::FileExists(m_FilePath.c_str()) && FileSystem::FileExists(m_TmpFilePath.c_str()))
+        std::rename(m_TmpFilePath.c_str(), m_FilePath.c_str());
+
+    std::vector<RefCntAutoPtr<IDataBlob>> Records;
+
+    std::vector<Uint8> Data;
+    if (!ReadFileData(m_FilePath, Data))
+    {
+        m_NumRecords = 0;
+        return Records;
+    }
+
+    size_t ValidSize = 0;
+
+    JournalFileHeader FileHeader;
+    if (Data.size() >= sizeof(FileHeader))
+    {
+        memcpy(&FileHeader, Data.data(), sizeof(FileHeader));
+        if (FileHeader.Magic == m_Magic && FileHeader.Version == m_Version)
+        {
+            ValidSize = sizeof(FileHeader);
+            while (Data.size() - ValidSize >= sizeof(JournalRecordHeader))
+            {
+                JournalRecordHeader RecordHeader;
+                memcpy(&RecordHeader, &Data[ValidSize], sizeof(RecordHeader));
+                if (RecordHeader.Magic != JournalRecordHeader::RecordMagic ||
+                    RecordHeader.DataSize > Data.size() - ValidSize - sizeof(RecordHeader))
+                    break;
+
+                const auto* pRecordData = &Data[ValidSize + sizeof(RecordHeader)];
+                const auto  RecordSize  = static_cast<size_t>(RecordHeader.DataSize);
+                const auto  Hash        = ComputeRecordHash(pRecordData, RecordSize);
+                if (Hash.LowPart != RecordHeader.HashLow || Hash.HighPart != RecordHeader.HashHigh)
+                    break;
+
+                Records.emplace_back(DataBlobImpl::Create(RecordSize, pRecordData));
+                ValidSize += sizeof(RecordHeader) + RecordSize;
+            }
+        }
+        else
+        {
+            LOG_WARNING_MESSAGE("Cache file '", m_FilePath, "' has incompatible format and will be discarded");
+        }
+    }
+
+    m_NumRecords = static_cast<Uint32>(Records.size());
+
+    if (ValidSize != Data.size())
+    {
+        if (ValidSize > sizeof(FileHeader))
+        {
+            LOG_WARNING_MESSAGE("Cache file '", m_FilePath, "' is truncated or corrupted. ", Data.size() - ValidSize,
+                                " bytes at the end of the file will be discarded");
+        }
+
+        // Rewrite the file so that new records are not appended after the garbage
+        FILE* pFile = fopen(m_TmpFilePath.c_str(), "wb");
+        if (pFile != nullptr)
+        {
+            JournalFileHeader NewHeader{m_Magic, m_Version};
+
+            bool Res = fwrite(&NewHeader, sizeof(NewHeader), 1, pFile) == 1;
+            for (size_t i = 0; i < Records.size() && Res; ++i)
+                Res = WriteRecord(pFile, Records[i]);
+            fclose(pFile);
+
+            if (Res)
+            {
+                std::remove(m_FilePath.c_str());
+                Res = std::rename(m_TmpFilePath.c_str(), m_FilePath.c_str()) == 0;
+            }
+            if (!Res)
+                LOG_ERROR_MESSAGE("Failed to rewrite cache file '", m_FilePath, "'");
+        }
+        else
+        {
+            LOG_ERROR_MESSAGE("Failed to open file '", m_TmpFilePath, "' for writing");
+        }
+    }
+
+    return Records;
+}
+
+void CacheFileJournal::Append(IDataBlob* pData)
+{
+    if (pData == nullptr || pData->GetSize() == 0)
+        return;
+
+    {
+        std::lock_guard<std::mutex> Guard{m_TaskMtx};
+        m_PendingRecords.emplace_back(pData);
+    }
+    RequestWrite();
+}
+
+void CacheFileJournal::RequestWrite()
+{
+    std::lock_guard<std::mutex> Guard{m_TaskMtx};
+    if (m_WriteRequested)
+    {
+        // The task that has not started yet will pick up all pending data
+        return;
+    }
+    m_WriteRequested = true;
+
+    // Remove finished tasks
+    for (size_t i = 0; i < m_Tasks.size();)
+    {
+        if (m_Tasks[i]->IsFinished())
+        {
+            m_Tasks[i] = std::move(m_Tasks.back());
+            m_Tasks.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    m_Tasks.emplace_back(EnqueueAsyncWork(m_pThreadPool,
+                                          [this](Uint32 ThreadId) //
+                                          {
+                                              ProcessWrites();
+                                          }));
+}
+
+void CacheFileJournal::ProcessWrites()
+{
+    // Hold the file mutex while collecting the data so that records
+    // are written in the order they were requested.
+    std::lock_guard<std::mutex> FileGuard{m_FileMtx};
+
+    std::vector<RefCntAutoPtr<IDataBlob>> Records;
+    {
+        std::lock_guard<std::mutex> TaskGuard{m_TaskMtx};
+        m_WriteRequested = false;
+        Records.swap(m_PendingRecords);
+    }
+
+    if (m_ReadPendingData)
+    {
+        if (auto pData = m_ReadPendingData())
+        {
+            if (pData->GetSize() > 0)
+                Records.emplace_back(std::move(pData));
+        }
+    }
+
+    if (!Records.empty())
+        AppendRecords(Records);
+
+    if (m_CompactionThreshold != 0 && m_NumRecords >= m_CompactionThreshold)
+        Compact();
+}
+
+void CacheFileJournal::AppendRecords(const std::vector<RefCntAutoPtr<IDataBlob>>& Records)
+{
+    FILE* pFile = fopen(m_FilePath.c_str(), "ab");
+    if (pFile == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to open cache file '", m_FilePath, "' for writing");
+        return;
+    }
+
+    // Start the new file if it did not exist or does not contain a valid header
+    fseek(pFile, 0, SEEK_END);
+    bool Res = true;
+    if (ftell(pFile) < static_cast<long>(sizeof(JournalFileHeader)))
+    {
+        pFile = freopen(m_FilePath.c_str(), "wb", pFile);
+        if (pFile == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Failed to open cache file '", m_FilePath, "' for writing");
+            return;
+        }
+
+        JournalFileHeader Header{m_Magic, m_Version};
+        Res          = fwrite(&Header, sizeof(Header), 1, pFile) == 1;
+        m_NumRecords = 0;
+    }
+
+    for (size_t i = 0; i < Records.size() && Res; ++i)
+    {
+        Res = WriteRecord(pFile, Records[i]);
+        if (Res)
+            ++m_NumRecords;
+    }
+    fclose(pFile);
+
+    if (!Res)
+        LOG_ERROR_MESSAGE("Failed to write to cache file '", m_FilePath, "'");
+}
+
+void CacheFileJournal::Compact()
+{
+    std::vector<Uint8> Data;
+    if (!ReadFileData(m_FilePath, Data) || Data.size() < sizeof(JournalFileHeader))
+        return;
+
+    std::vector<RefCntAutoPtr<IDataBlob>> Records;
+    Records.reserve(m_NumRecords);
+
+    size_t Offset = sizeof(JournalFileHeader);
+    while (Data.size() - Offset >= sizeof(JournalRecordHeader))
+    {
+        JournalRecordHeader RecordHeader;
+        memcpy(&RecordHeader, &Data[Offset], sizeof(RecordHeader));
+        if (RecordHeader.Magic != JournalRecordHeader::RecordMagic ||
+            RecordHeader.DataSize > Data.size() - Offset - sizeof(RecordHeader))
+            break;
+
+        const auto RecordSize = static_cast<size_t>(RecordHeader.DataSize);
+        Records.emplace_back(DataBlobImpl::Create(RecordSize, &Data[Offset + sizeof(RecordHeader)]));
+        Offset += sizeof(RecordHeader) + RecordSize;
+    }
+    Data.clear();
+
+    RefCntAutoPtr<IDataBlob> pMerged = m_MergeRecords(Records);
+    if (!pMerged)
+    {
+        LOG_ERROR_MESSAGE("Failed to merge records of cache file '", m_FilePath, "'");
+        return;
+    }
+
+    FILE* pFile = fopen(m_TmpFilePath.c_str(), "wb");
+    if (pFile == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to open file '", m_TmpFilePath, "' for writing");
+        return;
+    }
+
+    JournalFileHeader Header{m_Magic, m_Version};
+
+    bool Res = fwrite(&Header, sizeof(Header), 1, pFile) == 1 && WriteRecord(pFile, pMerged);
+    fclose(pFile);
+    if (!Res)
+    {
+        LOG_ERROR_MESSAGE("Failed to write compacted cache file '", m_TmpFilePath, "'");
+        std::remove(m_TmpFilePath.c_str());
+        return;
+    }
+
+    // rename() replaces the destination atomically on POSIX systems, but fails
+    // on Windows if the destination exists. In the latter case, the original file
+    // is removed first, and Load() recovers from the temporary file if the process
+    // terminates in between.
+    if (std::rename(m_TmpFilePath.c_str(), m_FilePath.c_str()) != 0)
+    {
+        std::remove(m_FilePath.c_str());
+        if (std::rename(m_TmpFilePath.c_str(), m_FilePath.c_str()) != 0)
+        {
+            LOG_ERROR_MESSAGE("Failed to replace cache file '", m_FilePath, "' with the compacted file");
+            return;
+        }
+    }
+
+    m_NumRecords = 1;
+}
+
+void CacheFileJournal::WaitForIdle()
+{
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+    {
+        std::lock_guard<std::mutex> Guard{m_TaskMtx};
+        Tasks = m_Tasks;
+    }
+
+    for (auto& pTask : Tasks)
+        pTask->WaitForCompletion();
+}
+
+void CacheFileJournal::Clear()
+{
+    WaitForIdle();
+
+    std::lock_guard<std::mutex> FileGuard{m_FileMtx};
+    {
+        std::lock_guard<std::mutex> TaskGuard{m_TaskMtx};
+        m_PendingRecords.clear();
+    }
+
+    FILE* pFile = fopen(m_FilePath.c_str(), "wb");
+    if (pFile == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to open cache file '", m_FilePath, "' for writing");
+        return;
+    }
+
+    JournalFileHeader Header{m_Magic, m_Version};
+    if (fwrite(&Header, sizeof(Header), 1, pFile) != 1 || fflush(pFile) != 0)
+        LOG_ERROR_MESSAGE("Failed to write to cache file '", m_FilePath, "'");
+    fclose(pFile);
+
+    m_NumRecords = 0;
+}
+
+} // namespace Diligent
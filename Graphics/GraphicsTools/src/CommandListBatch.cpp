@@ -0,0 +1,117 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "CommandListBatch.hpp"
+
+#include <utility>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+Uint32 CommandListBatch::ReserveSlots(Uint32 NumSlots)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    const auto FirstSlot = static_cast<Uint32>(m_CmdLists.size());
+    m_CmdLists.resize(m_CmdLists.size() + NumSlots);
+    return FirstSlot;
+}
+
+void CommandListBatch::SetCommandList(Uint32 Slot, ICommandList* pCmdList)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    DEV_CHECK_ERR(Slot < m_CmdLists.size(), "Slot ", Slot, " has not been reserved");
+    if (Slot >= m_CmdLists.size())
+        return;
+
+    DEV_CHECK_ERR(!m_CmdLists[Slot], "Slot ", Slot, " already contains a command list");
+    m_CmdLists[Slot] = pCmdList;
+}
+
+void CommandListBatch::AddCommandList(ICommandList* pCmdList)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_CmdLists.emplace_back(pCmdList);
+}
+
+Uint32 CommandListBatch::Execute(IDeviceContext* pImmediateCtx)
+{
+    DEV_CHECK_ERR(pImmediateCtx != nullptr, "Immediate context must not be null");
+    DEV_CHECK_ERR(pImmediateCtx == nullptr || !pImmediateCtx->GetDesc().IsDeferred, "Command lists can only be executed by an immediate context");
+
+    // Take the command lists so that other threads may start filling the next batch
+    // while the command lists are being submitted.
+    std::vector<RefCntAutoPtr<ICommandList>> CmdLists;
+    std::vector<ICommandList*>               CmdListPtrs;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        CmdLists.swap(m_CmdLists);
+        CmdListPtrs.swap(m_CmdListPtrs);
+    }
+
+    CmdListPtrs.clear();
+    for (auto& pCmdList : CmdLists)
+    {
+        if (pCmdList)
+            CmdListPtrs.push_back(pCmdList);
+    }
+
+    const auto NumCmdLists = static_cast<Uint32>(CmdListPtrs.size());
+    if (NumCmdLists > 0 && pImmediateCtx != nullptr)
+        pImmediateCtx->ExecuteCommandLists(NumCmdLists, CmdListPtrs.data());
+
+    // Command lists can only be executed once, so release them right away.
+    CmdLists.clear();
+    CmdListPtrs.clear();
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (m_CmdLists.empty())
+            m_CmdLists.swap(CmdLists);
+        if (m_CmdListPtrs.empty())
+            m_CmdListPtrs.swap(CmdListPtrs);
+    }
+
+    return NumCmdLists;
+}
+
+void CommandListBatch::Clear()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_CmdLists.clear();
+}
+
+Uint32 CommandListBatch::GetNumSlots() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return static_cast<Uint32>(m_CmdLists.size());
+}
+
+} // namespace Diligent
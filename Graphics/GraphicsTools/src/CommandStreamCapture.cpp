@@ -0,0 +1,1522 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "CommandStreamCapture.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Serializer.hpp"
+#include "PSOSerializer.hpp"
+#include "EngineMemory.h"
+#include "FileWrapper.hpp"
+#include "Timer.hpp"
+#include "GraphicsAccessories.hpp"
+#include "Align.hpp"
+#include "Cast.hpp"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr Uint32 CommandStreamMagic   = 0x53434744; // "DGCS"
+constexpr Uint32 CommandStreamVersion = 1;
+
+struct StreamHeader
+{
+    Uint32 Magic   = CommandStreamMagic;
+    Uint32 Version = CommandStreamVersion;
+};
+static_assert(sizeof(StreamHeader) == 8, "Stream header size must be a multiple of 8 to keep the payloads aligned");
+
+struct CommandHeader
+{
+    Uint32 Call = 0;
+    // Payload size, always a multiple of 8.
+    Uint32 Size = 0;
+};
+static_assert(sizeof(CommandHeader) == 8, "Command header size must be a multiple of 8 to keep the payloads aligned");
+
+// Object identifiers of the external views
+constexpr Uint32 ExternalRTVId = ~0u;
+constexpr Uint32 ExternalDSVId = ~0u - 1;
+
+// View types of the default buffer views are combined with this bit to
+// distinguish them from the texture view types.
+constexpr Uint32 BufferViewBit = 0x100;
+
+constexpr Uint32 NumGraphicsShaders = 7;
+
+template <SerializerMode Mode, typename T>
+using ConstQual = typename Serializer<Mode>::template ConstQual<T>;
+
+template <SerializerMode Mode>
+bool SerializeBufferDesc(Serializer<Mode>& Ser, ConstQual<Mode, BufferDesc>& Desc)
+{
+    return Ser(Desc.Name,
+               Desc.Size,
+               Desc.BindFlags,
+               Desc.Usage,
+               Desc.CPUAccessFlags,
+               Desc.Mode,
+               Desc.MiscFlags,
+               Desc.ElementByteStride,
+               Desc.ImmediateContextMask);
+}
+
+template <SerializerMode Mode>
+bool SerializeTextureDesc(Serializer<Mode>& Ser, ConstQual<Mode, TextureDesc>& Desc)
+{
+    return Ser(Desc.Name,
+               Desc.Type,
+               Desc.Width,
+               Desc.Height,
+               Desc.ArraySize,
+               Desc.Format,
+               Desc.MipLevels,
+               Desc.SampleCount,
+               Desc.BindFlags,
+               Desc.Usage,
+               Desc.CPUAccessFlags,
+               Desc.MiscFlags,
+               Desc.ClearValue.Format,
+               Desc.ClearValue.Color,
+               Desc.ClearValue.DepthStencil.Depth,
+               Desc.ClearValue.DepthStencil.Stencil,
+               Desc.ImmediateContextMask);
+}
+
+template <SerializerMode Mode>
+bool SerializeSamplerDesc(Serializer<Mode>& Ser, ConstQual<Mode, SamplerDesc>& Desc)
+{
+    return Ser(Desc.Name,
+               Desc.MinFilter,
+               Desc.MagFilter,
+               Desc.MipFilter,
+               Desc.AddressU,
+               Desc.AddressV,
+               Desc.AddressW,
+               Desc.Flags,
+               Desc.UnnormalizedCoords,
+               Desc.MipLODBias,
+               Desc.MaxAnisotropy,
+               Desc.ComparisonFunc,
+               Desc.BorderColor,
+               Desc.MinLOD,
+               Desc.MaxLOD);
+}
+
+template <SerializerMode Mode>
+bool SerializePSOCreateInfo(Serializer<Mode>& Ser, ConstQual<Mode, GraphicsPipelineStateCreateInfo>& CI, DynamicLinearAllocator* Allocator)
+{
+    // Resource signatures and render passes are not recorded
+    typename PSOSerializer<Mode>::TPRSNames PRSNames       = {};
+    const char*                             RenderPassName = nullptr;
+    return PSOSerializer<Mode>::SerializeCreateInfo(Ser, CI, PRSNames, Allocator, RenderPassName);
+}
+
+template <SerializerMode Mode>
+bool SerializePSOCreateInfo(Serializer<Mode>& Ser, ConstQual<Mode, ComputePipelineStateCreateInfo>& CI, DynamicLinearAllocator* Allocator)
+{
+    typename PSOSerializer<Mode>::TPRSNames PRSNames = {};
+    return PSOSerializer<Mode>::SerializeCreateInfo(Ser, CI, PRSNames, Allocator);
+}
+
+// Returns the size of the texture subresource data that the engine reads.
+size_t GetSubresourceDataSize(const TextureDesc& Desc, Uint32 Subresource, const TextureSubResData& SubResData)
+{
+    const auto  Mip        = Subresource % Desc.MipLevels;
+    const auto  MipProps   = GetMipLevelProperties(Desc, Mip);
+    const auto& FmtAttribs = GetTextureFormatAttribs(Desc.Format);
+
+    const Uint64 NumRows  = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED ? MipProps.StorageHeight / FmtAttribs.BlockHeight : MipProps.StorageHeight;
+    const Uint64 NumSlice = Desc.Type == RESOURCE_DIM_TEX_3D ? MipProps.Depth : 1;
+    return static_cast<size_t>((NumSlice - 1) * SubResData.DepthStride + (NumRows - 1) * SubResData.Stride + MipProps.RowSize);
+}
+
+// Measures the CPU time of the engine call and adds it to the statistics.
+template <typename EngineCallType>
+void TimeCall(CommandStreamPlayer::Stats* pStats, COMMAND_STREAM_CALL Call, const EngineCallType& EngineCall)
+{
+    if (pStats == nullptr)
+    {
+        EngineCall();
+        return;
+    }
+
+    CPUTimer CallTimer;
+    EngineCall();
+    auto& CallStats = pStats->Calls[Call];
+    CallStats.Time += CallTimer.GetElapsedTime();
+    ++CallStats.NumCalls;
+}
+
+const char* GetObjectName(const IDeviceObject* pObject)
+{
+    const auto* Name = pObject->GetDesc().Name;
+    return Name != nullptr ? Name : "";
+}
+
+} // namespace
+
+DECL_TRIVIALLY_SERIALIZABLE(Viewport);
+DECL_TRIVIALLY_SERIALIZABLE(Rect);
+
+const char* GetCommandStreamCallName(COMMAND_STREAM_CALL Call)
+{
+    static_assert(COMMAND_STREAM_CALL_COUNT == 27, "Please handle the new call type below");
+    switch (Call)
+    {
+        // clang-format off
+        case COMMAND_STREAM_CALL_CREATE_BUFFER:                  return "CreateBuffer";
+        case COMMAND_STREAM_CALL_CREATE_TEXTURE:                 return "CreateTexture";
+        case COMMAND_STREAM_CALL_CREATE_SAMPLER:                 return "CreateSampler";
+        case COMMAND_STREAM_CALL_CREATE_SHADER:                  return "CreateShader";
+        case COMMAND_STREAM_CALL_CREATE_GRAPHICS_PIPELINE_STATE: return "CreateGraphicsPipelineState";
+        case COMMAND_STREAM_CALL_CREATE_COMPUTE_PIPELINE_STATE:  return "CreateComputePipelineState";
+        case COMMAND_STREAM_CALL_CREATE_SHADER_RESOURCE_BINDING: return "CreateShaderResourceBinding";
+        case COMMAND_STREAM_CALL_SET_STATIC_VARIABLE:            return "SetStaticVariable";
+        case COMMAND_STREAM_CALL_SET_SHADER_VARIABLE:            return "SetShaderVariable";
+        case COMMAND_STREAM_CALL_SET_PIPELINE_STATE:             return "SetPipelineState";
+        case COMMAND_STREAM_CALL_COMMIT_SHADER_RESOURCES:        return "CommitShaderResources";
+        case COMMAND_STREAM_CALL_SET_VERTEX_BUFFERS:             return "SetVertexBuffers";
+        case COMMAND_STREAM_CALL_SET_INDEX_BUFFER:               return "SetIndexBuffer";
+        case COMMAND_STREAM_CALL_SET_VIEWPORTS:                  return "SetViewports";
+        case COMMAND_STREAM_CALL_SET_SCISSOR_RECTS:              return "SetScissorRects";
+        case COMMAND_STREAM_CALL_SET_RENDER_TARGETS:             return "SetRenderTargets";
+        case COMMAND_STREAM_CALL_SET_STENCIL_REF:                return "SetStencilRef";
+        case COMMAND_STREAM_CALL_SET_BLEND_FACTORS:              return "SetBlendFactors";
+        case COMMAND_STREAM_CALL_CLEAR_RENDER_TARGET:            return "ClearRenderTarget";
+        case COMMAND_STREAM_CALL_CLEAR_DEPTH_STENCIL:            return "ClearDepthStencil";
+        case COMMAND_STREAM_CALL_UPDATE_BUFFER:                  return "UpdateBuffer";
+        case COMMAND_STREAM_CALL_MAP_BUFFER:                     return "MapBuffer";
+        case COMMAND_STREAM_CALL_DRAW:                           return "Draw";
+        case COMMAND_STREAM_CALL_DRAW_INDEXED:                   return "DrawIndexed";
+        case COMMAND_STREAM_CALL_DISPATCH_COMPUTE:               return "DispatchCompute";
+        case COMMAND_STREAM_CALL_FLUSH:                          return "Flush";
+        case COMMAND_STREAM_CALL_FINISH_FRAME:                   return "FinishFrame";
+            // clang-format on
+
+        default:
+            UNEXPECTED("Unexpected command stream call");
+            return "Unknown";
+    }
+}
+
+
+CommandStreamRecorder::CommandStreamRecorder(const CreateInfo& CI) :
+    m_pDevice{CI.pDevice},
+    m_pContext{CI.pContext}
+{
+    if (!m_pDevice)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+    if (!m_pContext)
+        LOG_ERROR_AND_THROW("Device context must not be null");
+
+    const StreamHeader Header;
+    m_Data.resize(sizeof(Header));
+    std::memcpy(m_Data.data(), &Header, sizeof(Header));
+}
+
+CommandStreamRecorder::~CommandStreamRecorder()
+{
+    DEV_CHECK_ERR(m_MappedBuffers.empty(), "Not all mapped buffers have been unmapped");
+}
+
+template <typename HandlerType>
+void CommandStreamRecorder::Record(COMMAND_STREAM_CALL Call, const HandlerType& Handler)
+{
+    Serializer<SerializerMode::Measure> MeasureSer;
+    if (!Handler(MeasureSer))
+    {
+        UNEXPECTED("Failed to measure the size of the ", GetCommandStreamCallName(Call), " command");
+        return;
+    }
+
+    const auto PayloadSize = AlignUp(MeasureSer.GetSize(), size_t{8});
+    const auto Offset      = m_Data.size();
+    // New bytes are zero-initialized, so the padding is deterministic
+    m_Data.resize(Offset + sizeof(CommandHeader) + PayloadSize);
+
+    CommandHeader Header;
+    Header.Call = Call;
+    Header.Size = StaticCast<Uint32>(PayloadSize);
+    std::memcpy(m_Data.data() + Offset, &Header, sizeof(Header));
+
+    Serializer<SerializerMode::Write> WriteSer{SerializedData{m_Data.data() + Offset + sizeof(Header), PayloadSize}};
+    if (!Handler(WriteSer))
+    {
+        UNEXPECTED("Failed to serialize the ", GetCommandStreamCallName(Call), " command");
+        m_Data.resize(Offset);
+        return;
+    }
+    VERIFY_EXPR(WriteSer.GetSize() == MeasureSer.GetSize());
+
+    ++m_NumCommands;
+}
+
+void CommandStreamRecorder::AddObject(IObject* pObject)
+{
+    VERIFY_EXPR(pObject != nullptr);
+    m_Objects.emplace_back(pObject);
+    m_ObjectIds.emplace(pObject, static_cast<Uint32>(m_Objects.size()));
+}
+
+void CommandStreamRecorder::GetObjectRef(IObject* pObject, Uint32& Id, Uint32& ViewType) const
+{
+    Id       = 0;
+    ViewType = 0;
+    if (pObject == nullptr)
+        return;
+
+    const auto GetId = [this](const IObject* pObj) -> Uint32 {
+        auto it = m_ObjectIds.find(pObj);
+        return it != m_ObjectIds.end() ? it->second : 0;
+    };
+
+    Id = GetId(pObject);
+    if (Id != 0)
+        return;
+
+    if (RefCntAutoPtr<ITextureView> pView{pObject, IID_TextureView})
+    {
+        const auto Type     = pView->GetDesc().ViewType;
+        auto*      pTexture = pView->GetTexture();
+        if (const auto TexId = GetId(pTexture))
+        {
+            if (pTexture->GetDefaultView(Type) == pView.RawPtr())
+            {
+                Id       = TexId;
+                ViewType = Type;
+                return;
+            }
+            LOG_ERROR_MESSAGE("Texture view '", GetObjectName(pView), "' is not the default view of its texture. Only default views can be recorded.");
+            return;
+        }
+
+        if (Type == TEXTURE_VIEW_RENDER_TARGET)
+        {
+            Id = ExternalRTVId;
+            return;
+        }
+        if (Type == TEXTURE_VIEW_DEPTH_STENCIL)
+        {
+            Id = ExternalDSVId;
+            return;
+        }
+    }
+    else if (RefCntAutoPtr<IBufferView> pView{pObject, IID_BufferView})
+    {
+        const auto Type    = pView->GetDesc().ViewType;
+        auto*      pBuffer = pView->GetBuffer();
+        if (const auto BuffId = GetId(pBuffer))
+        {
+            if (pBuffer->GetDefaultView(Type) == pView.RawPtr())
+            {
+                Id       = BuffId;
+                ViewType = BufferViewBit | Type;
+                return;
+            }
+            LOG_ERROR_MESSAGE("Buffer view '", GetObjectName(pView), "' is not the default view of its buffer. Only default views can be recorded.");
+            return;
+        }
+    }
+
+    RefCntAutoPtr<IDeviceObject> pDeviceObject{pObject, IID_DeviceObject};
+    LOG_ERROR_MESSAGE("Object '", (pDeviceObject ? GetObjectName(pDeviceObject) : ""), "' was not created by the command stream recorder and is recorded as null.");
+}
+
+void CommandStreamRecorder::CreateBuffer(const BufferDesc& BuffDesc, const BufferData* pBuffData, IBuffer** ppBuffer)
+{
+    m_pDevice->CreateBuffer(BuffDesc, pBuffData, ppBuffer);
+    if (*ppBuffer == nullptr)
+        return;
+
+    const void*  pData    = pBuffData != nullptr ? pBuffData->pData : nullptr;
+    const size_t DataSize = pData != nullptr ? static_cast<size_t>(pBuffData->DataSize) : 0;
+    Record(COMMAND_STREAM_CALL_CREATE_BUFFER,
+           [&](auto& Ser) {
+               return SerializeBufferDesc(Ser, BuffDesc) && Ser.SerializeBytes(pData, DataSize);
+           });
+    AddObject(*ppBuffer);
+
+    if ((BuffDesc.CPUAccessFlags & CPU_ACCESS_WRITE) != 0 && DataSize > 0)
+    {
+        // The contents of the buffer persist between the maps without the discard flag
+        auto& ShadowData = m_ShadowData[*ppBuffer];
+        ShadowData.resize(static_cast<size_t>(BuffDesc.Size));
+        std::memcpy(ShadowData.data(), pData, std::min(DataSize, ShadowData.size()));
+    }
+}
+
+void CommandStreamRecorder::CreateTexture(const TextureDesc& TexDesc, const TextureData* pData, ITexture** ppTexture)
+{
+    m_pDevice->CreateTexture(TexDesc, pData, ppTexture);
+    if (*ppTexture == nullptr)
+        return;
+
+    Uint32              NumSubresources = pData != nullptr ? pData->NumSubresources : 0;
+    std::vector<size_t> SubresSizes(NumSubresources);
+    for (Uint32 i = 0; i < NumSubresources; ++i)
+    {
+        const auto& SubResData = pData->pSubResources[i];
+        if (SubResData.pData == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Initial data of texture '", GetObjectName(*ppTexture), "' is not recorded: only the data in CPU memory is supported.");
+            NumSubresources = 0;
+            break;
+        }
+        SubresSizes[i] = GetSubresourceDataSize(TexDesc, i, SubResData);
+    }
+
+    Record(COMMAND_STREAM_CALL_CREATE_TEXTURE,
+           [&](auto& Ser) {
+               if (!SerializeTextureDesc(Ser, TexDesc) || !Ser(NumSubresources))
+                   return false;
+               for (Uint32 i = 0; i < NumSubresources; ++i)
+               {
+                   const auto& SubResData = pData->pSubResources[i];
+                   if (!Ser(SubResData.Stride, SubResData.DepthStride) || !Ser.SerializeBytes(SubResData.pData, SubresSizes[i]))
+                       return false;
+               }
+               return true;
+           });
+    AddObject(*ppTexture);
+}
+
+void CommandStreamRecorder::CreateSampler(const SamplerDesc& SamDesc, ISampler** ppSampler)
+{
+    m_pDevice->CreateSampler(SamDesc, ppSampler);
+    if (*ppSampler == nullptr)
+        return;
+
+    Record(COMMAND_STREAM_CALL_CREATE_SAMPLER,
+           [&](auto& Ser) {
+               return SerializeSamplerDesc(Ser, SamDesc);
+           });
+    AddObject(*ppSampler);
+}
+
+void CommandStreamRecorder::CreateShader(const ShaderCreateInfo& ShaderCI, IShader** ppShader)
+{
+    m_pDevice->CreateShader(ShaderCI, ppShader);
+    if (*ppShader == nullptr)
+        return;
+
+    if (ShaderCI.Source == nullptr && ShaderCI.ByteCode == nullptr)
+    {
+        LOG_WARNING_MESSAGE("Shader '", GetObjectName(*ppShader), "' is not recorded: only shaders created from source or byte code are supported.");
+        return;
+    }
+
+    ShaderCreateInfo CI = ShaderCI;
+    if (CI.Source != nullptr && CI.SourceLength == 0)
+        CI.SourceLength = strlen(CI.Source);
+
+    Uint32 NumMacros = 0;
+    if (CI.Macros != nullptr)
+    {
+        while (CI.Macros[NumMacros].Name != nullptr)
+            ++NumMacros;
+    }
+
+    Record(COMMAND_STREAM_CALL_CREATE_SHADER,
+           [&](auto& Ser) {
+               using SerializerType = std::remove_reference_t<decltype(Ser)>;
+               if (!ShaderSerializer<SerializerType::GetMode()>::SerializeCI(Ser, CI) || !Ser(NumMacros))
+                   return false;
+               for (Uint32 i = 0; i < NumMacros; ++i)
+               {
+                   if (!Ser(CI.Macros[i].Name, CI.Macros[i].Definition))
+                       return false;
+               }
+               return true;
+           });
+    AddObject(*ppShader);
+}
+
+void CommandStreamRecorder::CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
+{
+    m_pDevice->CreateGraphicsPipelineState(PSOCreateInfo, ppPipelineState);
+    if (*ppPipelineState == nullptr)
+        return;
+
+    if (PSOCreateInfo.ResourceSignaturesCount != 0 || PSOCreateInfo.GraphicsPipeline.pRenderPass != nullptr)
+    {
+        LOG_WARNING_MESSAGE("Pipeline state '", GetObjectName(*ppPipelineState), "' is not recorded: resource signatures and render passes are not supported.");
+        return;
+    }
+
+    Uint32 Dummy                         = 0;
+    Uint32 ShaderIds[NumGraphicsShaders] = {};
+    GetObjectRef(PSOCreateInfo.pVS, ShaderIds[0], Dummy);
+    GetObjectRef(PSOCreateInfo.pPS, ShaderIds[1], Dummy);
+    GetObjectRef(PSOCreateInfo.pDS, ShaderIds[2], Dummy);
+    GetObjectRef(PSOCreateInfo.pHS, ShaderIds[3], Dummy);
+    GetObjectRef(PSOCreateInfo.pGS, ShaderIds[4], Dummy);
+    GetObjectRef(PSOCreateInfo.pAS, ShaderIds[5], Dummy);
+    GetObjectRef(PSOCreateInfo.pMS, ShaderIds[6], Dummy);
+
+    Record(COMMAND_STREAM_CALL_CREATE_GRAPHICS_PIPELINE_STATE,
+           [&](auto& Ser) {
+               return Ser(PSOCreateInfo.PSODesc.Name) && SerializePSOCreateInfo(Ser, PSOCreateInfo, nullptr) && Ser(ShaderIds);
+           });
+    AddObject(*ppPipelineState);
+}
+
+void CommandStreamRecorder::CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
+{
+    m_pDevice->CreateComputePipelineState(PSOCreateInfo, ppPipelineState);
+    if (*ppPipelineState == nullptr)
+        return;
+
+    if (PSOCreateInfo.ResourceSignaturesCount != 0)
+    {
+        LOG_WARNING_MESSAGE("Pipeline state '", GetObjectName(*ppPipelineState), "' is not recorded: resource signatures are not supported.");
+        return;
+    }
+
+    Uint32 Dummy    = 0;
+    Uint32 ShaderId = 0;
+    GetObjectRef(PSOCreateInfo.pCS, ShaderId, Dummy);
+
+    Record(COMMAND_STREAM_CALL_CREATE_COMPUTE_PIPELINE_STATE,
+           [&](auto& Ser) {
+               return Ser(PSOCreateInfo.PSODesc.Name) && SerializePSOCreateInfo(Ser, PSOCreateInfo, nullptr) && Ser(ShaderId);
+           });
+    AddObject(*ppPipelineState);
+}
+
+void CommandStreamRecorder::CreateShaderResourceBinding(IPipelineState* pPSO, IShaderResourceBinding** ppSRB, bool InitStaticResources)
+{
+    pPSO->CreateShaderResourceBinding(ppSRB, InitStaticResources);
+    if (*ppSRB == nullptr)
+        return;
+
+    Uint32 PSOId = 0, Dummy = 0;
+    GetObjectRef(pPSO, PSOId, Dummy);
+    if (PSOId == 0)
+        return;
+
+    Record(COMMAND_STREAM_CALL_CREATE_SHADER_RESOURCE_BINDING,
+           [&](auto& Ser) {
+               return Ser(PSOId, InitStaticResources);
+           });
+    AddObject(*ppSRB);
+}
+
+void CommandStreamRecorder::SetStaticVariable(IPipelineState* pPSO, SHADER_TYPE ShaderType, const char* Name, IDeviceObject* pObject)
+{
+    auto* pVar = pPSO->GetStaticVariableByName(ShaderType, Name);
+    if (pVar == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Static variable '", Name, "' is not found in pipeline state '", GetObjectName(pPSO), "'");
+        return;
+    }
+    pVar->Set(pObject);
+
+    Uint32 PSOId = 0, Dummy = 0, ObjId = 0, ViewType = 0;
+    GetObjectRef(pPSO, PSOId, Dummy);
+    GetObjectRef(pObject, ObjId, ViewType);
+    if (PSOId == 0)
+        return;
+
+    Record(COMMAND_STREAM_CALL_SET_STATIC_VARIABLE,
+           [&](auto& Ser) {
+               return Ser(PSOId, ShaderType, Name, ObjId, ViewType);
+           });
+}
+
+void CommandStreamRecorder::SetShaderVariable(IShaderResourceBinding* pSRB, SHADER_TYPE ShaderType, const char* Name, IDeviceObject* pObject)
+{
+    auto* pVar = pSRB->GetVariableByName(ShaderType, Name);
+    if (pVar == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Variable '", Name, "' is not found in the shader resource binding");
+        return;
+    }
+    pVar->Set(pObject);
+
+    Uint32 SRBId = 0, Dummy = 0, ObjId = 0, ViewType = 0;
+    GetObjectRef(pSRB, SRBId, Dummy);
+    GetObjectRef(pObject, ObjId, ViewType);
+    if (SRBId == 0)
+        return;
+
+    Record(COMMAND_STREAM_CALL_SET_SHADER_VARIABLE,
+           [&](auto& Ser) {
+               return Ser(SRBId, ShaderType, Name, ObjId, ViewType);
+           });
+}
+
+void CommandStreamRecorder::SetPipelineState(IPipelineState* pPipelineState)
+{
+    m_pContext->SetPipelineState(pPipelineState);
+
+    Uint32 PSOId = 0, Dummy = 0;
+    GetObjectRef(pPipelineState, PSOId, Dummy);
+    Record(COMMAND_STREAM_CALL_SET_PIPELINE_STATE,
+           [&](auto& Ser) {
+               return Ser(PSOId);
+           });
+}
+
+void CommandStreamRecorder::CommitShaderResources(IShaderResourceBinding* pSRB, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    m_pContext->CommitShaderResources(pSRB, StateTransitionMode);
+
+    Uint32 SRBId = 0, Dummy = 0;
+    GetObjectRef(pSRB, SRBId, Dummy);
+    Record(COMMAND_STREAM_CALL_COMMIT_SHADER_RESOURCES,
+           [&](auto& Ser) {
+               return Ser(SRBId, StateTransitionMode);
+           });
+}
+
+void CommandStreamRecorder::SetVertexBuffers(Uint32                         StartSlot,
+                                             Uint32                         NumBuffersSet,
+                                             IBuffer**                      ppBuffers,
+                                             const Uint64*                  pOffsets,
+                                             RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                                             SET_VERTEX_BUFFERS_FLAGS       Flags)
+{
+    m_pContext->SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+
+    std::vector<Uint32> BufferIds(NumBuffersSet);
+    for (Uint32 i = 0; i < NumBuffersSet; ++i)
+    {
+        Uint32 Dummy = 0;
+        GetObjectRef(ppBuffers != nullptr ? ppBuffers[i] : nullptr, BufferIds[i], Dummy);
+    }
+
+    Record(COMMAND_STREAM_CALL_SET_VERTEX_BUFFERS,
+           [&](auto& Ser) {
+               if (!Ser(StartSlot, NumBuffersSet, StateTransitionMode, Flags))
+                   return false;
+               for (Uint32 i = 0; i < NumBuffersSet; ++i)
+               {
+                   const Uint64 Offset = pOffsets != nullptr ? pOffsets[i] : 0;
+                   if (!Ser(BufferIds[i], Offset))
+                       return false;
+               }
+               return true;
+           });
+}
+
+void CommandStreamRecorder::SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    m_pContext->SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+
+    Uint32 BufferId = 0, Dummy = 0;
+    GetObjectRef(pIndexBuffer, BufferId, Dummy);
+    Record(COMMAND_STREAM_CALL_SET_INDEX_BUFFER,
+           [&](auto& Ser) {
+               return Ser(BufferId, ByteOffset, StateTransitionMode);
+           });
+}
+
+void CommandStreamRecorder::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
+{
+    m_pContext->SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+
+    Record(COMMAND_STREAM_CALL_SET_VIEWPORTS,
+           [&](auto& Ser) {
+               return Ser(RTWidth, RTHeight) && Ser.SerializeArrayRaw(nullptr, pViewports, NumViewports);
+           });
+}
+
+void CommandStreamRecorder::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
+{
+    m_pContext->SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+
+    Record(COMMAND_STREAM_CALL_SET_SCISSOR_RECTS,
+           [&](auto& Ser) {
+               return Ser(RTWidth, RTHeight) && Ser.SerializeArrayRaw(nullptr, pRects, NumRects);
+           });
+}
+
+void CommandStreamRecorder::SetRenderTargets(Uint32                         NumRenderTargets,
+                                             ITextureView*                  ppRenderTargets[],
+                                             ITextureView*                  pDepthStencil,
+                                             RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    m_pContext->SetRenderTargets(NumRenderTargets, ppRenderTargets, pDepthStencil, StateTransitionMode);
+
+    Uint32 RTVIds[MAX_RENDER_TARGETS]       = {};
+    Uint32 RTVViewTypes[MAX_RENDER_TARGETS] = {};
+    for (Uint32 i = 0; i < std::min(NumRenderTargets, Uint32{MAX_RENDER_TARGETS}); ++i)
+        GetObjectRef(ppRenderTargets[i], RTVIds[i], RTVViewTypes[i]);
+
+    Uint32 DSVId = 0, DSVViewType = 0;
+    GetObjectRef(pDepthStencil, DSVId, DSVViewType);
+
+    Record(COMMAND_STREAM_CALL_SET_RENDER_TARGETS,
+           [&](auto& Ser) {
+               return Ser(NumRenderTargets, RTVIds, RTVViewTypes, DSVId, DSVViewType, StateTransitionMode);
+           });
+}
+
+void CommandStreamRecorder::SetStencilRef(Uint32 StencilRef)
+{
+    m_pContext->SetStencilRef(StencilRef);
+
+    Record(COMMAND_STREAM_CALL_SET_STENCIL_REF,
+           [&](auto& Ser) {
+               return Ser(StencilRef);
+           });
+}
+
+void CommandStreamRecorder::SetBlendFactors(const float* pBlendFactors)
+{
+    m_pContext->SetBlendFactors(pBlendFactors);
+
+    const Uint8 HasBlendFactors = pBlendFactors != nullptr ? 1 : 0;
+    float       BlendFactors[4] = {};
+    if (pBlendFactors != nullptr)
+        std::memcpy(BlendFactors, pBlendFactors, sizeof(BlendFactors));
+
+    Record(COMMAND_STREAM_CALL_SET_BLEND_FACTORS,
+           [&](auto& Ser) {
+               return Ser(HasBlendFactors, BlendFactors);
+           });
+}
+
+void CommandStreamRecorder::ClearRenderTarget(ITextureView* pView, const float* RGBA, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    m_pContext->ClearRenderTarget(pView, RGBA, StateTransitionMode);
+
+    Uint32 ViewId = 0, ViewType = 0;
+    GetObjectRef(pView, ViewId, ViewType);
+
+    float Color[4] = {};
+    if (RGBA != nullptr)
+        std::memcpy(Color, RGBA, sizeof(Color));
+
+    Record(COMMAND_STREAM_CALL_CLEAR_RENDER_TARGET,
+           [&](auto& Ser) {
+               return Ser(ViewId, ViewType, Color, StateTransitionMode);
+           });
+}
+
+void CommandStreamRecorder::ClearDepthStencil(ITextureView*                  pView,
+                                              CLEAR_DEPTH_STENCIL_FLAGS      ClearFlags,
+                                              float                          fDepth,
+                                              Uint8                          Stencil,
+                                              RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    m_pContext->ClearDepthStencil(pView, ClearFlags, fDepth, Stencil, StateTransitionMode);
+
+    Uint32 ViewId = 0, ViewType = 0;
+    GetObjectRef(pView, ViewId, ViewType);
+    Record(COMMAND_STREAM_CALL_CLEAR_DEPTH_STENCIL,
+           [&](auto& Ser) {
+               return Ser(ViewId, ViewType, ClearFlags, fDepth, Stencil, StateTransitionMode);
+           });
+}
+
+void CommandStreamRecorder::UpdateBuffer(IBuffer* pBuffer, Uint64 Offset, Uint64 Size, const void* pData, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    m_pContext->UpdateBuffer(pBuffer, Offset, Size, pData, StateTransitionMode);
+
+    Uint32 BufferId = 0, Dummy = 0;
+    GetObjectRef(pBuffer, BufferId, Dummy);
+    if (BufferId == 0)
+        return;
+
+    const size_t DataSize = static_cast<size_t>(Size);
+    Record(COMMAND_STREAM_CALL_UPDATE_BUFFER,
+           [&](auto& Ser) {
+               return Ser(BufferId, Offset, StateTransitionMode) && Ser.SerializeBytes(pData, DataSize);
+           });
+}
+
+void CommandStreamRecorder::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData)
+{
+    m_pContext->MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
+    if (MapType != MAP_WRITE || pMappedData == nullptr)
+        return;
+
+    Uint32 BufferId = 0, Dummy = 0;
+    GetObjectRef(pBuffer, BufferId, Dummy);
+    if (BufferId == 0)
+        return;
+
+    // Mapped memory may be write-only, so the caller writes to the shadow copy of
+    // the buffer, which is copied to the mapped memory and recorded by UnmapBuffer().
+    auto& ShadowData = m_ShadowData[pBuffer];
+    ShadowData.resize(static_cast<size_t>(pBuffer->GetDesc().Size));
+
+    MappedBufferInfo& MappedInfo = m_MappedBuffers[pBuffer];
+    MappedInfo.pData             = pMappedData;
+    MappedInfo.MapFlags          = MapFlags;
+
+    pMappedData = ShadowData.data();
+}
+
+void CommandStreamRecorder::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
+{
+    auto it = m_MappedBuffers.find(pBuffer);
+    if (it != m_MappedBuffers.end())
+    {
+        VERIFY_EXPR(MapType == MAP_WRITE);
+        const auto MappedInfo = it->second;
+        m_MappedBuffers.erase(it);
+
+        Uint32 BufferId = 0, Dummy = 0;
+        GetObjectRef(pBuffer, BufferId, Dummy);
+        VERIFY_EXPR(BufferId != 0);
+
+        const auto& ShadowData = m_ShadowData[pBuffer];
+        std::memcpy(MappedInfo.pData, ShadowData.data(), ShadowData.size());
+
+        const void*  pData    = ShadowData.data();
+        const size_t DataSize = ShadowData.size();
+        Record(COMMAND_STREAM_CALL_MAP_BUFFER,
+               [&](auto& Ser) {
+                   return Ser(BufferId, MappedInfo.MapFlags) && Ser.SerializeBytes(pData, DataSize);
+               });
+    }
+
+    m_pContext->UnmapBuffer(pBuffer, MapType);
+}
+
+void CommandStreamRecorder::Draw(const DrawAttribs& Attribs)
+{
+    m_pContext->Draw(Attribs);
+
+    Record(COMMAND_STREAM_CALL_DRAW,
+           [&](auto& Ser) {
+               return Ser(Attribs.NumVertices,
+                          Attribs.Flags,
+                          Attribs.NumInstances,
+                          Attribs.StartVertexLocation,
+                          Attribs.FirstInstanceLocation);
+           });
+}
+
+void CommandStreamRecorder::DrawIndexed(const DrawIndexedAttribs& Attribs)
+{
+    m_pContext->DrawIndexed(Attribs);
+
+    Record(COMMAND_STREAM_CALL_DRAW_INDEXED,
+           [&](auto& Ser) {
+               return Ser(Attribs.NumIndices,
+                          Attribs.IndexType,
+                          Attribs.Flags,
+                          Attribs.NumInstances,
+                          Attribs.FirstIndexLocation,
+                          Attribs.BaseVertex,
+                          Attribs.FirstInstanceLocation);
+           });
+}
+
+void CommandStreamRecorder::DispatchCompute(const DispatchComputeAttribs& Attribs)
+{
+    m_pContext->DispatchCompute(Attribs);
+
+    Record(COMMAND_STREAM_CALL_DISPATCH_COMPUTE,
+           [&](auto& Ser) {
+               return Ser(Attribs.ThreadGroupCountX,
+                          Attribs.ThreadGroupCountY,
+                          Attribs.ThreadGroupCountZ,
+                          Attribs.MtlThreadGroupSizeX,
+                          Attribs.MtlThreadGroupSizeY,
+                          Attribs.MtlThreadGroupSizeZ);
+           });
+}
+
+void CommandStreamRecorder::Flush()
+{
+    m_pContext->Flush();
+    Record(COMMAND_STREAM_CALL_FLUSH, [](auto&) { return true; });
+}
+
+void CommandStreamRecorder::FinishFrame()
+{
+    m_pContext->FinishFrame();
+    Record(COMMAND_STREAM_CALL_FINISH_FRAME, [](auto&) { return true; });
+}
+
+bool CommandStreamRecorder::SaveToFile(const char* FilePath) const
+{
+    VERIFY_EXPR(FilePath != nullptr);
+
+    FileWrapper File{FilePath, EFileAccessMode::Overwrite};
+    if (!File)
+    {
+        LOG_ERROR_MESSAGE("Failed to open file '", FilePath, "' for writing");
+        return false;
+    }
+
+    if (!File->Write(m_Data.data(), m_Data.size()))
+    {
+        LOG_ERROR_MESSAGE("Failed to write command stream to file '", FilePath, "'");
+        return false;
+    }
+
+    return true;
+}
+
+
+CommandStreamPlayer::CommandStreamPlayer(const CreateInfo& CI) :
+    m_pDevice{CI.pDevice},
+    m_pContext{CI.pContext},
+    m_pExternalRTV{CI.pExternalRTV},
+    m_pExternalDSV{CI.pExternalDSV}
+{
+    if (!m_pDevice)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+    if (!m_pContext)
+        LOG_ERROR_AND_THROW("Device context must not be null");
+}
+
+CommandStreamPlayer::~CommandStreamPlayer()
+{
+}
+
+bool CommandStreamPlayer::Load(const void* pData, size_t Size, Stats* pStats)
+{
+    m_Commands.clear();
+    m_Objects.clear();
+    m_Data.clear();
+
+    StreamHeader Header;
+    if (pData == nullptr || Size < sizeof(Header))
+    {
+        LOG_ERROR_MESSAGE("Command stream is empty");
+        return false;
+    }
+
+    std::memcpy(&Header, pData, sizeof(Header));
+    if (Header.Magic != CommandStreamMagic)
+    {
+        LOG_ERROR_MESSAGE("Invalid command stream header");
+        return false;
+    }
+    if (Header.Version != CommandStreamVersion)
+    {
+        LOG_ERROR_MESSAGE("Unsupported command stream version ", Header.Version, ". Expected version: ", CommandStreamVersion);
+        return false;
+    }
+
+    // The copy is aligned by the allocator, which keeps the payloads properly aligned
+    m_Data.assign(static_cast<const Uint8*>(pData), static_cast<const Uint8*>(pData) + Size);
+
+    size_t Offset = sizeof(Header);
+    while (Offset < m_Data.size())
+    {
+        CommandHeader CmdHeader;
+        if (m_Data.size() - Offset < sizeof(CmdHeader))
+        {
+            LOG_ERROR_MESSAGE("Command stream is truncated");
+            return false;
+        }
+        std::memcpy(&CmdHeader, m_Data.data() + Offset, sizeof(CmdHeader));
+        Offset += sizeof(CmdHeader);
+
+        if (CmdHeader.Call >= COMMAND_STREAM_CALL_COUNT || CmdHeader.Size > m_Data.size() - Offset)
+        {
+            LOG_ERROR_MESSAGE("Command stream is corrupted at offset ", Offset - sizeof(CmdHeader));
+            return false;
+        }
+
+        Command Cmd;
+        Cmd.Call   = static_cast<COMMAND_STREAM_CALL>(CmdHeader.Call);
+        Cmd.Size   = CmdHeader.Size;
+        Cmd.Offset = Offset;
+        Offset += CmdHeader.Size;
+
+        if (Cmd.Call < COMMAND_STREAM_CALL_SET_SHADER_VARIABLE)
+        {
+            if (!ExecuteDeviceCommand(Cmd, pStats))
+            {
+                LOG_ERROR_MESSAGE("Failed to parse the ", GetCommandStreamCallName(Cmd.Call), " command");
+                return false;
+            }
+        }
+        else
+        {
+            m_Commands.push_back(Cmd);
+        }
+    }
+
+    return true;
+}
+
+bool CommandStreamPlayer::LoadFromFile(const char* FilePath, Stats* pStats)
+{
+    std::vector<Uint8> Data;
+    if (!FileWrapper::ReadWholeFile(FilePath, Data))
+        return false;
+
+    return Load(Data.data(), Data.size(), pStats);
+}
+
+IObject* CommandStreamPlayer::ResolveObject(Uint32 Id, Uint32 ViewType) const
+{
+    if (Id == ExternalRTVId)
+        return m_pExternalRTV.RawPtr<IObject>();
+    if (Id == ExternalDSVId)
+        return m_pExternalDSV.RawPtr<IObject>();
+    if (Id == 0)
+        return nullptr;
+    if (Id > m_Objects.size())
+    {
+        LOG_ERROR_MESSAGE("Object id ", Id, " is out of range");
+        return nullptr;
+    }
+
+    auto* pObject = m_Objects[Id - 1].RawPtr<IObject>();
+    if (pObject == nullptr || ViewType == 0)
+        return pObject;
+
+    if ((ViewType & BufferViewBit) != 0)
+        return ClassPtrCast<IBuffer>(pObject)->GetDefaultView(static_cast<BUFFER_VIEW_TYPE>(ViewType & ~BufferViewBit));
+    else
+        return ClassPtrCast<ITexture>(pObject)->GetDefaultView(static_cast<TEXTURE_VIEW_TYPE>(ViewType));
+}
+
+bool CommandStreamPlayer::ExecuteDeviceCommand(const Command& Cmd, Stats* pStats)
+{
+    Serializer<SerializerMode::Read> Ser{SerializedData{m_Data.data() + Cmd.Offset, Cmd.Size}};
+
+    switch (Cmd.Call)
+    {
+        case COMMAND_STREAM_CALL_CREATE_BUFFER:
+        {
+            BufferDesc  Desc;
+            const void* pData    = nullptr;
+            size_t      DataSize = 0;
+            if (!SerializeBufferDesc(Ser, Desc) || !Ser.SerializeBytes(pData, DataSize))
+                return false;
+
+            BufferData             InitData{pData, DataSize};
+            RefCntAutoPtr<IBuffer> pBuffer;
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pDevice->CreateBuffer(Desc, DataSize > 0 ? &InitData : nullptr, &pBuffer);
+            });
+            m_Objects.emplace_back(pBuffer);
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_CREATE_TEXTURE:
+        {
+            TextureDesc Desc;
+            Uint32      NumSubresources = 0;
+            if (!SerializeTextureDesc(Ser, Desc) || !Ser(NumSubresources))
+                return false;
+
+            std::vector<TextureSubResData> SubResources(NumSubresources);
+            for (auto& SubResData : SubResources)
+            {
+                size_t DataSize = 0;
+                if (!Ser(SubResData.Stride, SubResData.DepthStride) || !Ser.SerializeBytes(SubResData.pData, DataSize))
+                    return false;
+            }
+
+            TextureData InitData;
+            InitData.pSubResources   = SubResources.data();
+            InitData.NumSubresources = NumSubresources;
+
+            RefCntAutoPtr<ITexture> pTexture;
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pDevice->CreateTexture(Desc, NumSubresources > 0 ? &InitData : nullptr, &pTexture);
+            });
+            m_Objects.emplace_back(pTexture);
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_CREATE_SAMPLER:
+        {
+            SamplerDesc Desc;
+            if (!SerializeSamplerDesc(Ser, Desc))
+                return false;
+
+            RefCntAutoPtr<ISampler> pSampler;
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pDevice->CreateSampler(Desc, &pSampler);
+            });
+            m_Objects.emplace_back(pSampler);
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_CREATE_SHADER:
+        {
+            ShaderCreateInfo CI;
+            Uint32           NumMacros = 0;
+            if (!ShaderSerializer<SerializerMode::Read>::SerializeCI(Ser, CI) || !Ser(NumMacros))
+                return false;
+
+            std::vector<ShaderMacro> Macros(NumMacros + 1);
+            for (Uint32 i = 0; i < NumMacros; ++i)
+            {
+                if (!Ser(Macros[i].Name, Macros[i].Definition))
+                    return false;
+            }
+            CI.Macros = NumMacros > 0 ? Macros.data() : nullptr;
+
+            RefCntAutoPtr<IShader> pShader;
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pDevice->CreateShader(CI, &pShader);
+            });
+            m_Objects.emplace_back(pShader);
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_CREATE_GRAPHICS_PIPELINE_STATE:
+        {
+            DynamicLinearAllocator          Allocator{GetRawAllocator()};
+            GraphicsPipelineStateCreateInfo PSOCreateInfo;
+            Uint32                          ShaderIds[NumGraphicsShaders] = {};
+            if (!Ser(PSOCreateInfo.PSODesc.Name) || !SerializePSOCreateInfo(Ser, PSOCreateInfo, &Allocator) || !Ser(ShaderIds))
+                return false;
+
+            PSOCreateInfo.pVS = ClassPtrCast<IShader>(ResolveObject(ShaderIds[0], 0));
+            PSOCreateInfo.pPS = ClassPtrCast<IShader>(ResolveObject(ShaderIds[1], 0));
+            PSOCreateInfo.pDS = ClassPtrCast<IShader>(ResolveObject(ShaderIds[2], 0));
+            PSOCreateInfo.pHS = ClassPtrCast<IShader>(ResolveObject(ShaderIds[3], 0));
+            PSOCreateInfo.pGS = ClassPtrCast<IShader>(ResolveObject(ShaderIds[4], 0));
+            PSOCreateInfo.pAS = ClassPtrCast<IShader>(ResolveObject(ShaderIds[5], 0));
+            PSOCreateInfo.pMS = ClassPtrCast<IShader>(ResolveObject(ShaderIds[6], 0));
+
+            RefCntAutoPtr<IPipelineState> pPSO;
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+            });
+            m_Objects.emplace_back(pPSO);
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_CREATE_COMPUTE_PIPELINE_STATE:
+        {
+            DynamicLinearAllocator         Allocator{GetRawAllocator()};
+            ComputePipelineStateCreateInfo PSOCreateInfo;
+            Uint32                         ShaderId = 0;
+            if (!Ser(PSOCreateInfo.PSODesc.Name) || !SerializePSOCreateInfo(Ser, PSOCreateInfo, &Allocator) || !Ser(ShaderId))
+                return false;
+
+            PSOCreateInfo.pCS = ClassPtrCast<IShader>(ResolveObject(ShaderId, 0));
+
+            RefCntAutoPtr<IPipelineState> pPSO;
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+            });
+            m_Objects.emplace_back(pPSO);
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_CREATE_SHADER_RESOURCE_BINDING:
+        {
+            Uint32 PSOId               = 0;
+            bool   InitStaticResources = false;
+            if (!Ser(PSOId, InitStaticResources))
+                return false;
+
+            RefCntAutoPtr<IShaderResourceBinding> pSRB;
+            if (auto* pPSO = ClassPtrCast<IPipelineState>(ResolveObject(PSOId, 0)))
+            {
+                TimeCall(pStats, Cmd.Call, [&]() {
+                    pPSO->CreateShaderResourceBinding(&pSRB, InitStaticResources);
+                });
+            }
+            m_Objects.emplace_back(pSRB);
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_SET_STATIC_VARIABLE:
+        {
+            Uint32      PSOId      = 0;
+            SHADER_TYPE ShaderType = SHADER_TYPE_UNKNOWN;
+            const char* Name       = nullptr;
+            Uint32      ObjId      = 0;
+            Uint32      ViewType   = 0;
+            if (!Ser(PSOId, ShaderType, Name, ObjId, ViewType))
+                return false;
+
+            if (auto* pPSO = ClassPtrCast<IPipelineState>(ResolveObject(PSOId, 0)))
+            {
+                auto* pObject = ClassPtrCast<IDeviceObject>(ResolveObject(ObjId, ViewType));
+                TimeCall(pStats, Cmd.Call, [&]() {
+                    if (auto* pVar = pPSO->GetStaticVariableByName(ShaderType, Name))
+                        pVar->Set(pObject);
+                });
+            }
+            break;
+        }
+
+        default:
+            UNEXPECTED("Unexpected device command");
+            return false;
+    }
+
+    return true;
+}
+
+bool CommandStreamPlayer::ExecuteContextCommand(const Command& Cmd, Stats* pStats)
+{
+    Serializer<SerializerMode::Read> Ser{SerializedData{m_Data.data() + Cmd.Offset, Cmd.Size}};
+
+    switch (Cmd.Call)
+    {
+        case COMMAND_STREAM_CALL_SET_SHADER_VARIABLE:
+        {
+            Uint32      SRBId      = 0;
+            SHADER_TYPE ShaderType = SHADER_TYPE_UNKNOWN;
+            const char* Name       = nullptr;
+            Uint32      ObjId      = 0;
+            Uint32      ViewType   = 0;
+            if (!Ser(SRBId, ShaderType, Name, ObjId, ViewType))
+                return false;
+
+            if (auto* pSRB = ClassPtrCast<IShaderResourceBinding>(ResolveObject(SRBId, 0)))
+            {
+                auto* pObject = ClassPtrCast<IDeviceObject>(ResolveObject(ObjId, ViewType));
+                TimeCall(pStats, Cmd.Call, [&]() {
+                    if (auto* pVar = pSRB->GetVariableByName(ShaderType, Name))
+                        pVar->Set(pObject);
+                });
+            }
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_SET_PIPELINE_STATE:
+        {
+            Uint32 PSOId = 0;
+            if (!Ser(PSOId))
+                return false;
+
+            if (auto* pPSO = ClassPtrCast<IPipelineState>(ResolveObject(PSOId, 0)))
+            {
+                TimeCall(pStats, Cmd.Call, [&]() {
+                    m_pContext->SetPipelineState(pPSO);
+                });
+            }
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_COMMIT_SHADER_RESOURCES:
+        {
+            Uint32                         SRBId = 0;
+            RESOURCE_STATE_TRANSITION_MODE Mode  = RESOURCE_STATE_TRANSITION_MODE_NONE;
+            if (!Ser(SRBId, Mode))
+                return false;
+
+            if (auto* pSRB = ClassPtrCast<IShaderResourceBinding>(ResolveObject(SRBId, 0)))
+            {
+                TimeCall(pStats, Cmd.Call, [&]() {
+                    m_pContext->CommitShaderResources(pSRB, Mode);
+                });
+            }
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_SET_VERTEX_BUFFERS:
+        {
+            Uint32                         StartSlot  = 0;
+            Uint32                         NumBuffers = 0;
+            RESOURCE_STATE_TRANSITION_MODE Mode       = RESOURCE_STATE_TRANSITION_MODE_NONE;
+            SET_VERTEX_BUFFERS_FLAGS       Flags      = SET_VERTEX_BUFFERS_FLAG_NONE;
+            if (!Ser(StartSlot, NumBuffers, Mode, Flags) || NumBuffers > MAX_BUFFER_SLOTS)
+                return false;
+
+            IBuffer* ppBuffers[MAX_BUFFER_SLOTS] = {};
+            Uint64   Offsets[MAX_BUFFER_SLOTS]   = {};
+            for (Uint32 i = 0; i < NumBuffers; ++i)
+            {
+                Uint32 BufferId = 0;
+                if (!Ser(BufferId, Offsets[i]))
+                    return false;
+                ppBuffers[i] = ClassPtrCast<IBuffer>(ResolveObject(BufferId, 0));
+            }
+
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pContext->SetVertexBuffers(StartSlot, NumBuffers, ppBuffers, Offsets, Mode, Flags);
+            });
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_SET_INDEX_BUFFER:
+        {
+            Uint32                         BufferId   = 0;
+            Uint64                         ByteOffset = 0;
+            RESOURCE_STATE_TRANSITION_MODE Mode       = RESOURCE_STATE_TRANSITION_MODE_NONE;
+            if (!Ser(BufferId, ByteOffset, Mode))
+                return false;
+
+            auto* pBuffer = ClassPtrCast<IBuffer>(ResolveObject(BufferId, 0));
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pContext->SetIndexBuffer(pBuffer, ByteOffset, Mode);
+            });
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_SET_VIEWPORTS:
+        {
+            Uint32          RTWidth = 0, RTHeight = 0, NumViewports = 0;
+            const Viewport* pViewports = nullptr;
+            if (!Ser(RTWidth, RTHeight) || !Ser.SerializeArrayRaw(nullptr, pViewports, NumViewports))
+                return false;
+
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pContext->SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+            });
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_SET_SCISSOR_RECTS:
+        {
+            Uint32      RTWidth = 0, RTHeight = 0, NumRects = 0;
+            const Rect* pRects = nullptr;
+            if (!Ser(RTWidth, RTHeight) || !Ser.SerializeArrayRaw(nullptr, pRects, NumRects))
+                return false;
+
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pContext->SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+            });
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_SET_RENDER_TARGETS:
+        {
+            Uint32                         NumRenderTargets                 = 0;
+            Uint32                         RTVIds[MAX_RENDER_TARGETS]       = {};
+            Uint32                         RTVViewTypes[MAX_RENDER_TARGETS] = {};
+            Uint32                         DSVId                            = 0;
+            Uint32                         DSVViewType                      = 0;
+            RESOURCE_STATE_TRANSITION_MODE Mode                             = RESOURCE_STATE_TRANSITION_MODE_NONE;
+            if (!Ser(NumRenderTargets, RTVIds, RTVViewTypes, DSVId, DSVViewType, Mode) || NumRenderTargets > MAX_RENDER_TARGETS)
+                return false;
+
+            ITextureView* ppRTVs[MAX_RENDER_TARGETS] = {};
+            for (Uint32 i = 0; i < NumRenderTargets; ++i)
+                ppRTVs[i] = ClassPtrCast<ITextureView>(ResolveObject(RTVIds[i], RTVViewTypes[i]));
+            auto* pDSV = ClassPtrCast<ITextureView>(ResolveObject(DSVId, DSVViewType));
+
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pContext->SetRenderTargets(NumRenderTargets, ppRTVs, pDSV, Mode);
+            });
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_SET_STENCIL_REF:
+        {
+            Uint32 StencilRef = 0;
+            if (!Ser(StencilRef))
+                return false;
+
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pContext->SetStencilRef(StencilRef);
+            });
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_SET_BLEND_FACTORS:
+        {
+            Uint8 HasBlendFactors = 0;
+            float BlendFactors[4] = {};
+            if (!Ser(HasBlendFactors, BlendFactors))
+                return false;
+
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pContext->SetBlendFactors(HasBlendFactors != 0 ? BlendFactors : nullptr);
+            });
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_CLEAR_RENDER_TARGET:
+        {
+            Uint32                         ViewId   = 0;
+            Uint32                         ViewType = 0;
+            float                          Color[4] = {};
+            RESOURCE_STATE_TRANSITION_MODE Mode     = RESOURCE_STATE_TRANSITION_MODE_NONE;
+            if (!Ser(ViewId, ViewType, Color, Mode))
+                return false;
+
+            if (auto* pView = ClassPtrCast<ITextureView>(ResolveObject(ViewId, ViewType)))
+            {
+                TimeCall(pStats, Cmd.Call, [&]() {
+                    m_pContext->ClearRenderTarget(pView, Color, Mode);
+                });
+            }
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_CLEAR_DEPTH_STENCIL:
+        {
+            Uint32                         ViewId     = 0;
+            Uint32                         ViewType   = 0;
+            CLEAR_DEPTH_STENCIL_FLAGS      ClearFlags = CLEAR_DEPTH_FLAG_NONE;
+            float                          Depth      = 0;
+            Uint8                          Stencil    = 0;
+            RESOURCE_STATE_TRANSITION_MODE Mode       = RESOURCE_STATE_TRANSITION_MODE_NONE;
+            if (!Ser(ViewId, ViewType, ClearFlags, Depth, Stencil, Mode))
+                return false;
+
+            if (auto* pView = ClassPtrCast<ITextureView>(ResolveObject(ViewId, ViewType)))
+            {
+                TimeCall(pStats, Cmd.Call, [&]() {
+                    m_pContext->ClearDepthStencil(pView, ClearFlags, Depth, Stencil, Mode);
+                });
+            }
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_UPDATE_BUFFER:
+        {
+            Uint32                         BufferId = 0;
+            Uint64                         Offset   = 0;
+            RESOURCE_STATE_TRANSITION_MODE Mode     = RESOURCE_STATE_TRANSITION_MODE_NONE;
+            const void*                    pData    = nullptr;
+            size_t                         DataSize = 0;
+            if (!Ser(BufferId, Offset, Mode) || !Ser.SerializeBytes(pData, DataSize))
+                return false;
+
+            if (auto* pBuffer = ClassPtrCast<IBuffer>(ResolveObject(BufferId, 0)))
+            {
+                TimeCall(pStats, Cmd.Call, [&]() {
+                    m_pContext->UpdateBuffer(pBuffer, Offset, DataSize, pData, Mode);
+                });
+            }
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_MAP_BUFFER:
+        {
+            Uint32      BufferId = 0;
+            MAP_FLAGS   MapFlags = MAP_FLAG_NONE;
+            const void* pData    = nullptr;
+            size_t      DataSize = 0;
+            if (!Ser(BufferId, MapFlags) || !Ser.SerializeBytes(pData, DataSize))
+                return false;
+
+            if (auto* pBuffer = ClassPtrCast<IBuffer>(ResolveObject(BufferId, 0)))
+            {
+                TimeCall(pStats, Cmd.Call, [&]() {
+                    PVoid pMappedData = nullptr;
+                    m_pContext->MapBuffer(pBuffer, MAP_WRITE, MapFlags, pMappedData);
+                    if (pMappedData != nullptr)
+                    {
+                        std::memcpy(pMappedData, pData, DataSize);
+                        m_pContext->UnmapBuffer(pBuffer, MAP_WRITE);
+                    }
+                });
+            }
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_DRAW:
+        {
+            DrawAttribs Attribs;
+            if (!Ser(Attribs.NumVertices,
+                     Attribs.Flags,
+                     Attribs.NumInstances,
+                     Attribs.StartVertexLocation,
+                     Attribs.FirstInstanceLocation))
+                return false;
+
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pContext->Draw(Attribs);
+            });
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_DRAW_INDEXED:
+        {
+            DrawIndexedAttribs Attribs;
+            if (!Ser(Attribs.NumIndices,
+                     Attribs.IndexType,
+                     Attribs.Flags,
+                     Attribs.NumInstances,
+                     Attribs.FirstIndexLocation,
+                     Attribs.BaseVertex,
+                     Attribs.FirstInstanceLocation))
+                return false;
+
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pContext->DrawIndexed(Attribs);
+            });
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_DISPATCH_COMPUTE:
+        {
+            DispatchComputeAttribs Attribs;
+            if (!Ser(Attribs.ThreadGroupCountX,
+                     Attribs.ThreadGroupCountY,
+                     Attribs.ThreadGroupCountZ,
+                     Attribs.MtlThreadGroupSizeX,
+                     Attribs.MtlThreadGroupSizeY,
+                     Attribs.MtlThreadGroupSizeZ))
+                return false;
+
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pContext->DispatchCompute(Attribs);
+            });
+            break;
+        }
+
+        case COMMAND_STREAM_CALL_FLUSH:
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pContext->Flush();
+            });
+            break;
+
+        case COMMAND_STREAM_CALL_FINISH_FRAME:
+            TimeCall(pStats, Cmd.Call, [&]() {
+                m_pContext->FinishFrame();
+            });
+            if (pStats != nullptr)
+                ++pStats->NumFrames;
+            break;
+
+        default:
+            UNEXPECTED("Unexpected context command");
+            return false;
+    }
+
+    return true;
+}
+
+bool CommandStreamPlayer::Replay(Stats* pStats)
+{
+    bool Succeeded = true;
+    for (const auto& Cmd : m_Commands)
+    {
+        if (!ExecuteContextCommand(Cmd, pStats))
+        {
+            LOG_ERROR_MESSAGE("Failed to parse the ", GetCommandStreamCallName(Cmd.Call), " command");
+            Succeeded = false;
+        }
+    }
+    return Succeeded;
+}
+
+} // namespace Diligent
@@ -0,0 +1,661 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ComputePrimitives.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/Shader.h"
+#include "GraphicsUtilities.h"
+#include "MapHelper.hpp"
+#include "ShaderMacroHelper.hpp"
+#include "Align.hpp"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// clang-format off
+static constexpr char ComputePrimitivesShaderSource[] = R"(
+#define ELEMENTS_PER_GROUP (THREAD_GROUP_SIZE * ITEMS_PER_THREAD)
+#define RADIX              (1u << RADIX_BITS)
+
+cbuffer cbPrimitiveAttribs
+{
+    uint g_NumElements;
+    uint g_NumBlocks;
+    uint g_Shift;
+    uint g_Inclusive;
+
+    uint g_ScanFlags;
+    uint g_Padding0;
+    uint g_Padding1;
+    uint g_Padding2;
+};
+
+groupshared uint g_SharedData[THREAD_GROUP_SIZE + 1];
+
+// Returns the exclusive prefix sum of Value over the thread group and writes the sum of all values to Total.
+// All threads of the group must call the function.
+uint GroupExclusiveSum(uint Value, uint LocalIdx, out uint Total)
+{
+#if USE_WAVE_OPS
+    // Consecutive threads of a one-dimensional thread group form a wave
+    uint WaveSize = WaveGetLaneCount();
+    uint WaveIdx  = LocalIdx / WaveSize;
+    uint NumWaves = (THREAD_GROUP_SIZE + WaveSize - 1u) / WaveSize;
+
+    uint WavePrefix = WavePrefixSum(Value);
+    uint WaveTotal  = WaveActiveSum(Value);
+    if (WaveIsFirstLane())
+        g_SharedData[WaveIdx] = WaveTotal;
+    GroupMemoryBarrierWithGroupSync();
+
+    // The number of waves is small, so the wave sums are scanned by one thread
+    if (LocalIdx == 0u)
+    {
+        uint Sum = 0u;
+        for (uint w = 0u; w < NumWaves; ++w)
+        {
+            uint WaveSum = g_SharedData[w];
+            g_SharedData[w] = Sum;
+            Sum += WaveSum;
+        }
+        g_SharedData[THREAD_GROUP_SIZE] = Sum;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    uint Prefix = g_SharedData[WaveIdx] + WavePrefix;
+    Total = g_SharedData[THREAD_GROUP_SIZE];
+#else
+    // Hillis-Steele inclusive scan
+    g_SharedData[LocalIdx] = Value;
+    GroupMemoryBarrierWithGroupSync();
+    for (uint Offset = 1u; Offset < THREAD_GROUP_SIZE; Offset <<= 1u)
+    {
+        uint Neighbor = 0u;
+        if (LocalIdx >= Offset)
+            Neighbor = g_SharedData[LocalIdx - Offset];
+        GroupMemoryBarrierWithGroupSync();
+        g_SharedData[LocalIdx] += Neighbor;
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    uint Prefix = g_SharedData[LocalIdx] - Value;
+    Total = g_SharedData[THREAD_GROUP_SIZE - 1u];
+#endif
+    // Make the shared memory available to the next call
+    GroupMemoryBarrierWithGroupSync();
+
+    return Prefix;
+}
+
+#if SCAN_BLOCKS
+
+#if SCAN_IN_PLACE
+#   define g_ScanInput g_ScanOutput
+#else
+StructuredBuffer<uint>   g_ScanInput;
+#endif
+RWStructuredBuffer<uint> g_ScanOutput;
+RWStructuredBuffer<uint> g_BlockSums;
+
+// Scans every block of ELEMENTS_PER_GROUP elements and writes the block sums
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void main(uint3 Gid  : SV_GroupID,
+          uint3 GTid : SV_GroupThreadID)
+{
+    uint FirstIdx = Gid.x * ELEMENTS_PER_GROUP + GTid.x * ITEMS_PER_THREAD;
+
+    uint Items[ITEMS_PER_THREAD];
+    uint ThreadSum = 0u;
+    for (uint i = 0u; i < ITEMS_PER_THREAD; ++i)
+    {
+        uint Item = 0u;
+        if (FirstIdx + i < g_NumElements)
+            Item = g_ScanInput[FirstIdx + i];
+        if (g_ScanFlags != 0u)
+            Item = Item != 0u ? 1u : 0u;
+
+        Items[i] = Item;
+        ThreadSum += Item;
+    }
+
+    uint Total;
+    uint Prefix = GroupExclusiveSum(ThreadSum, GTid.x, Total);
+
+    for (uint j = 0u; j < ITEMS_PER_THREAD; ++j)
+    {
+        if (FirstIdx + j < g_NumElements)
+            g_ScanOutput[FirstIdx + j] = g_Inclusive != 0u ? Prefix + Items[j] : Prefix;
+        Prefix += Items[j];
+    }
+
+    if (GTid.x == 0u && g_NumBlocks > 1u)
+        g_BlockSums[Gid.x] = Total;
+}
+
+#endif // SCAN_BLOCKS
+
+
+#if ADD_BLOCK_OFFSETS
+
+RWStructuredBuffer<uint> g_ScanOutput;
+RWStructuredBuffer<uint> g_BlockSums;
+
+// Adds the scanned block sums to the elements of every block
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void main(uint3 Gid  : SV_GroupID,
+          uint3 GTid : SV_GroupThreadID)
+{
+    uint Offset = g_BlockSums[Gid.x];
+    for (uint i = 0u; i < ITEMS_PER_THREAD; ++i)
+    {
+        uint Idx = Gid.x * ELEMENTS_PER_GROUP + i * THREAD_GROUP_SIZE + GTid.x;
+        if (Idx < g_NumElements)
+            g_ScanOutput[Idx] += Offset;
+    }
+}
+
+#endif // ADD_BLOCK_OFFSETS
+
+
+#if COMPACT_SCATTER
+
+StructuredBuffer<uint>   g_CompactInput;
+StructuredBuffer<uint>   g_CompactFlags;
+StructuredBuffer<uint>   g_CompactOffsets;
+RWStructuredBuffer<uint> g_CompactOutput;
+RWStructuredBuffer<uint> g_CompactCount;
+
+// Writes the flagged elements to the positions given by the exclusive scan of the flags
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void main(uint3 Gid  : SV_GroupID,
+          uint3 GTid : SV_GroupThreadID)
+{
+    for (uint i = 0u; i < ITEMS_PER_THREAD; ++i)
+    {
+        uint Idx = Gid.x * ELEMENTS_PER_GROUP + i * THREAD_GROUP_SIZE + GTid.x;
+        if (Idx < g_NumElements)
+        {
+            bool Keep   = g_CompactFlags[Idx] != 0u;
+            uint Offset = g_CompactOffsets[Idx];
+            if (Keep)
+                g_CompactOutput[Offset] = g_CompactInput[Idx];
+            if (Idx == g_NumElements - 1u)
+                g_CompactCount[0] = Offset + (Keep ? 1u : 0u);
+        }
+    }
+}
+
+#endif // COMPACT_SCATTER
+
+
+#if RADIX_HISTOGRAM
+
+StructuredBuffer<uint>   g_KeysIn;
+RWStructuredBuffer<uint> g_Histograms;
+
+groupshared uint g_DigitCounts[RADIX];
+
+// Counts the digits of every block. The counts are stored digit-major, so that the exclusive
+// scan of the histograms yields the output offset of every digit of every block.
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void main(uint3 Gid  : SV_GroupID,
+          uint3 GTid : SV_GroupThreadID)
+{
+    if (GTid.x < RADIX)
+        g_DigitCounts[GTid.x] = 0u;
+    GroupMemoryBarrierWithGroupSync();
+
+    for (uint i = 0u; i < ITEMS_PER_THREAD; ++i)
+    {
+        uint Idx = Gid.x * ELEMENTS_PER_GROUP + i * THREAD_GROUP_SIZE + GTid.x;
+        if (Idx < g_NumElements)
+        {
+            uint Digit = (g_KeysIn[Idx] >> g_Shift) & (RADIX - 1u);
+            InterlockedAdd(g_DigitCounts[Digit], 1u);
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (GTid.x < RADIX)
+        g_Histograms[GTid.x * g_NumBlocks + Gid.x] = g_DigitCounts[GTid.x];
+}
+
+#endif // RADIX_HISTOGRAM
+
+
+#if RADIX_SCATTER
+
+StructuredBuffer<uint>   g_KeysIn;
+RWStructuredBuffer<uint> g_KeysOut;
+RWStructuredBuffer<uint> g_Histograms;
+#if SORT_VALUES
+StructuredBuffer<uint>   g_ValuesIn;
+RWStructuredBuffer<uint> g_ValuesOut;
+#endif
+
+// Moves every key to its sorted position. The rank of the key among the keys of the block
+// with the same digit is computed by scanning the per-thread digit counts, which keeps the sort stable.
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void main(uint3 Gid  : SV_GroupID,
+          uint3 GTid : SV_GroupThreadID)
+{
+    uint FirstIdx = Gid.x * ELEMENTS_PER_GROUP + GTid.x * ITEMS_PER_THREAD;
+
+    // The digit counts of this thread, two 16-bit counts per element
+    uint PackedCounts[RADIX / 2u];
+    for (uint p = 0u; p < RADIX / 2u; ++p)
+        PackedCounts[p] = 0u;
+
+    uint Keys[ITEMS_PER_THREAD];
+    uint Digits[ITEMS_PER_THREAD];
+    for (uint i = 0u; i < ITEMS_PER_THREAD; ++i)
+    {
+        Keys[i]   = 0u;
+        Digits[i] = 0u;
+        if (FirstIdx + i < g_NumElements)
+        {
+            Keys[i]   = g_KeysIn[FirstIdx + i];
+            Digits[i] = (Keys[i] >> g_Shift) & (RADIX - 1u);
+            PackedCounts[Digits[i] >> 1u] += 1u << ((Digits[i] & 1u) * 16u);
+        }
+    }
+
+    // The counts never exceed ELEMENTS_PER_GROUP, so the 16-bit halves do not overflow
+    uint PackedRanks[RADIX / 2u];
+    for (uint q = 0u; q < RADIX / 2u; ++q)
+    {
+        uint Total;
+        PackedRanks[q] = GroupExclusiveSum(PackedCounts[q], GTid.x, Total);
+    }
+
+    for (uint j = 0u; j < ITEMS_PER_THREAD; ++j)
+    {
+        if (FirstIdx + j < g_NumElements)
+        {
+            uint Digit     = Digits[j];
+            uint HalfShift = (Digit & 1u) * 16u;
+            uint Rank      = (PackedRanks[Digit >> 1u] >> HalfShift) & 0xFFFFu;
+            PackedRanks[Digit >> 1u] += 1u << HalfShift;
+
+            uint DstIdx = g_Histograms[Digit * g_NumBlocks + Gid.x] + Rank;
+            g_KeysOut[DstIdx] = Keys[j];
+#if SORT_VALUES
+            g_ValuesOut[DstIdx] = g_ValuesIn[FirstIdx + j];
+#endif
+        }
+    }
+}
+
+#endif // RADIX_SCATTER
+)";
+// clang-format on
+
+struct PrimitiveAttribs
+{
+    Uint32 NumElements = 0;
+    Uint32 NumBlocks   = 0;
+    Uint32 Shift       = 0;
+    Uint32 Inclusive   = 0;
+
+    Uint32 ScanFlags = 0;
+    Uint32 Padding0  = 0;
+    Uint32 Padding1  = 0;
+    Uint32 Padding2  = 0;
+};
+static_assert(sizeof(PrimitiveAttribs) % 16 == 0, "Constant buffer size must be a multiple of 16 bytes");
+
+// The maximum number of thread groups in one dimension of a dispatch
+constexpr Uint32 MaxThreadGroupCount = 65535;
+
+IRenderDevice* ValidateDevice(IRenderDevice* pDevice)
+{
+    if (pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+        LOG_ERROR_AND_THROW("ComputePrimitives requires compute shaders");
+
+    return pDevice;
+}
+
+bool IsWaveOpSupported(IRenderDevice* pDevice)
+{
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    if (!DeviceInfo.Features.WaveOp)
+        return false;
+
+    // Wave intrinsics in HLSL shaders are only compiled by DXC
+    if (DeviceInfo.Type != RENDER_DEVICE_TYPE_D3D12 && DeviceInfo.Type != RENDER_DEVICE_TYPE_VULKAN)
+        return false;
+
+    const auto& WaveOp           = pDevice->GetAdapterInfo().WaveOp;
+    const auto  RequiredFeatures = WAVE_FEATURE_BASIC | WAVE_FEATURE_ARITHMETIC;
+    return (WaveOp.Features & RequiredFeatures) == RequiredFeatures && (WaveOp.SupportedStages & SHADER_TYPE_COMPUTE) != 0;
+}
+
+} // namespace
+
+ComputePrimitives::ComputePrimitives(const CreateInfo& CI) :
+    m_pDevice{ValidateDevice(CI.pDevice)},
+    m_ThreadGroupSize{CI.ThreadGroupSize}
+{
+    if (m_ThreadGroupSize < 32 || m_ThreadGroupSize > 1024 || !IsPowerOfTwo(m_ThreadGroupSize))
+        LOG_ERROR_AND_THROW("Thread group size (", m_ThreadGroupSize, ") must be a power of two between 32 and 1024");
+
+    CreateUniformBuffer(m_pDevice, sizeof(PrimitiveAttribs), "Compute primitives constants", &m_pConstants);
+    if (!m_pConstants)
+        LOG_ERROR_AND_THROW("Failed to create the constant buffer");
+
+    m_UseWaveOps = CI.UseWaveOps && IsWaveOpSupported(m_pDevice);
+    if (m_UseWaveOps && !CreatePipelines(true))
+    {
+        LOG_WARNING_MESSAGE("Failed to create compute primitives pipelines that use wave operations. Falling back to shared memory implementation.");
+        m_UseWaveOps = false;
+    }
+
+    if (!m_UseWaveOps && !CreatePipelines(false))
+        LOG_ERROR_AND_THROW("Failed to create compute primitives pipelines");
+}
+
+bool ComputePrimitives::CreatePipelines(bool UseWaveOps)
+{
+    // clang-format off
+    return CreatePipeline(m_ScanBlocks,            "Compute primitives scan blocks",             "SCAN_BLOCKS",       UseWaveOps, false, false) &&
+           CreatePipeline(m_ScanBlocksInPlace,     "Compute primitives scan blocks in place",    "SCAN_BLOCKS",       UseWaveOps, true,  false) &&
+           CreatePipeline(m_AddBlockOffsets,       "Compute primitives add block offsets",       "ADD_BLOCK_OFFSETS", UseWaveOps, false, false) &&
+           CreatePipeline(m_CompactScatter,        "Compute primitives compact scatter",         "COMPACT_SCATTER",   UseWaveOps, false, false) &&
+           CreatePipeline(m_RadixHistogram,        "Compute primitives radix histogram",         "RADIX_HISTOGRAM",   UseWaveOps, false, false) &&
+           CreatePipeline(m_RadixScatterKeys,      "Compute primitives radix scatter keys",      "RADIX_SCATTER",     UseWaveOps, false, false) &&
+           CreatePipeline(m_RadixScatterKeyValues, "Compute primitives radix scatter key-values", "RADIX_SCATTER",    UseWaveOps, false, true);
+    // clang-format on
+}
+
+bool ComputePrimitives::CreatePipeline(ComputePipeline& Pipeline, const char* Name, const char* Kernel, bool UseWaveOps, bool ScanInPlace, bool SortValues)
+{
+    ShaderMacroHelper Macros;
+    Macros.AddShaderMacro("THREAD_GROUP_SIZE", m_ThreadGroupSize);
+    Macros.AddShaderMacro("ITEMS_PER_THREAD", ItemsPerThread);
+    Macros.AddShaderMacro("RADIX_BITS", RadixBits);
+    Macros.AddShaderMacro("USE_WAVE_OPS", UseWaveOps);
+    Macros.AddShaderMacro("SCAN_IN_PLACE", ScanInPlace);
+    Macros.AddShaderMacro("SORT_VALUES", SortValues);
+    Macros.AddShaderMacro(Kernel, true);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name       = Name;
+    ShaderCI.EntryPoint      = "main";
+    ShaderCI.Source          = ComputePrimitivesShaderSource;
+    ShaderCI.Macros          = Macros;
+    if (UseWaveOps)
+    {
+        ShaderCI.ShaderCompiler = SHADER_COMPILER_DXC;
+        ShaderCI.HLSLVersion    = {6, 0};
+    }
+
+    RefCntAutoPtr<IShader> pCS;
+    m_pDevice->CreateShader(ShaderCI, &pCS);
+    if (!pCS)
+        return false;
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name         = Name;
+    PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.pCS                  = pCS;
+
+    // The constant buffer is the same for all dispatches, other resources are set every time
+    ShaderResourceVariableDesc Vars[] = {
+        {SHADER_TYPE_COMPUTE, "cbPrimitiveAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC} //
+    };
+    PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+    PSOCreateInfo.PSODesc.ResourceLayout.Variables           = Vars;
+    PSOCreateInfo.PSODesc.ResourceLayout.NumVariables        = _countof(Vars);
+
+    ComputePipeline NewPipeline;
+    m_pDevice->CreateComputePipelineState(PSOCreateInfo, &NewPipeline.pPSO);
+    if (!NewPipeline.pPSO)
+        return false;
+
+    NewPipeline.pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbPrimitiveAttribs")->Set(m_pConstants);
+    NewPipeline.pPSO->CreateShaderResourceBinding(&NewPipeline.pSRB, true);
+    if (!NewPipeline.pSRB)
+        return false;
+
+    Pipeline = std::move(NewPipeline);
+    return true;
+}
+
+IBuffer* ComputePrimitives::GetScratchBuffer(RefCntAutoPtr<IBuffer>& pBuffer, Uint32 NumElements, const char* Name)
+{
+    const Uint64 RequiredSize = Uint64{sizeof(Uint32)} * std::max(NumElements, 1u);
+    if (pBuffer && pBuffer->GetDesc().Size >= RequiredSize)
+        return pBuffer;
+
+    BufferDesc Desc;
+    Desc.Name              = Name;
+    Desc.Size              = RequiredSize;
+    Desc.Usage             = USAGE_DEFAULT;
+    Desc.BindFlags         = BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+    Desc.Mode              = BUFFER_MODE_STRUCTURED;
+    Desc.ElementByteStride = sizeof(Uint32);
+
+    pBuffer.Release();
+    m_pDevice->CreateBuffer(Desc, nullptr, &pBuffer);
+    DEV_CHECK_ERR(pBuffer, "Failed to create scratch buffer '", Name, "'");
+    return pBuffer;
+}
+
+void ComputePrimitives::UpdateConstants(IDeviceContext* pContext, Uint32 NumElements, Uint32 NumBlocks, Uint32 Shift, bool Inclusive, bool ScanFlags)
+{
+    MapHelper<PrimitiveAttribs> Constants{pContext, m_pConstants, MAP_WRITE, MAP_FLAG_DISCARD};
+    Constants->NumElements = NumElements;
+    Constants->NumBlocks   = NumBlocks;
+    Constants->Shift       = Shift;
+    Constants->Inclusive   = Inclusive ? 1 : 0;
+    Constants->ScanFlags   = ScanFlags ? 1 : 0;
+}
+
+void ComputePrimitives::Dispatch(IDeviceContext* pContext, ComputePipeline& Pipeline, Uint32 NumGroups)
+{
+    VERIFY(NumGroups <= MaxThreadGroupCount, "The number of thread groups exceeds the limit");
+
+    pContext->SetPipelineState(Pipeline.pPSO);
+    pContext->CommitShaderResources(Pipeline.pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    DispatchComputeAttribs DispatchAttribs;
+    DispatchAttribs.ThreadGroupCountX   = NumGroups;
+    DispatchAttribs.MtlThreadGroupSizeX = m_ThreadGroupSize;
+    DispatchAttribs.MtlThreadGroupSizeY = 1;
+    DispatchAttribs.MtlThreadGroupSizeZ = 1;
+    pContext->DispatchCompute(DispatchAttribs);
+}
+
+void ComputePrimitives::ScanLevel(IDeviceContext* pContext, IBuffer* pInput, IBuffer* pOutput, Uint32 NumElements, bool Inclusive, bool ScanFlags, size_t Level)
+{
+    const Uint32 ElementsPerGroup = GetElementsPerGroup();
+    const Uint32 NumBlocks        = (NumElements + ElementsPerGroup - 1) / ElementsPerGroup;
+
+    if (m_BlockSums.size() <= Level)
+        m_BlockSums.resize(Level + 1);
+    // The buffer is kept alive by m_BlockSums even if the vector is resized by the next level
+    IBuffer* pBlockSums = GetScratchBuffer(m_BlockSums[Level], NumBlocks, "Compute primitives block sums");
+
+    auto& ScanPipeline = pInput != nullptr ? m_ScanBlocks : m_ScanBlocksInPlace;
+    auto* pScanSRB     = ScanPipeline.pSRB.RawPtr<IShaderResourceBinding>();
+    if (pInput != nullptr)
+        pScanSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_ScanInput")->Set(pInput->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    pScanSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_ScanOutput")->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+    pScanSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_BlockSums")->Set(pBlockSums->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    UpdateConstants(pContext, NumElements, NumBlocks, 0, Inclusive, ScanFlags);
+    Dispatch(pContext, ScanPipeline, NumBlocks);
+
+    if (NumBlocks > 1)
+    {
+        // Scan the block sums to get the offset of every block
+        ScanLevel(pContext, nullptr, pBlockSums, NumBlocks, /*Inclusive = */ false, /*ScanFlags = */ false, Level + 1);
+
+        auto* pAddSRB = m_AddBlockOffsets.pSRB.RawPtr<IShaderResourceBinding>();
+        pAddSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_ScanOutput")->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+        pAddSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_BlockSums")->Set(pBlockSums->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+        UpdateConstants(pContext, NumElements, NumBlocks, 0, false, false);
+        Dispatch(pContext, m_AddBlockOffsets, NumBlocks);
+    }
+}
+
+void ComputePrimitives::Scan(IDeviceContext* pContext, const ScanAttribs& Attribs)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(Attribs.pInput != nullptr, "Input buffer must not be null");
+    DEV_CHECK_ERR(Attribs.pOutput != nullptr, "Output buffer must not be null");
+    DEV_CHECK_ERR(Attribs.pInput != Attribs.pOutput, "Input and output buffers must be different");
+    DEV_CHECK_ERR(Attribs.NumElements <= MaxThreadGroupCount * GetElementsPerGroup(), "The number of elements (", Attribs.NumElements, ") exceeds the limit");
+    DEV_CHECK_ERR(Attribs.pOutput->GetDesc().Size >= Uint64{sizeof(Uint32)} * Attribs.NumElements,
+                  "The output buffer is too small to hold ", Attribs.NumElements, " elements");
+
+    if (Attribs.NumElements == 0)
+        return;
+
+    ScanLevel(pContext, Attribs.pInput, Attribs.pOutput, Attribs.NumElements, Attribs.Inclusive, /*ScanFlags = */ false, 0);
+}
+
+void ComputePrimitives::Compact(IDeviceContext* pContext, const CompactAttribs& Attribs)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(Attribs.pInput != nullptr, "Input buffer must not be null");
+    DEV_CHECK_ERR(Attribs.pFlags != nullptr, "Flags buffer must not be null");
+    DEV_CHECK_ERR(Attribs.pOutput != nullptr, "Output buffer must not be null");
+    DEV_CHECK_ERR(Attribs.pCount != nullptr, "Count buffer must not be null");
+    DEV_CHECK_ERR(Attribs.NumElements <= MaxThreadGroupCount * GetElementsPerGroup(), "The number of elements (", Attribs.NumElements, ") exceeds the limit");
+
+    if (Attribs.NumElements == 0)
+    {
+        constexpr Uint32 ZeroCount = 0;
+        pContext->UpdateBuffer(Attribs.pCount, 0, sizeof(ZeroCount), &ZeroCount, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        return;
+    }
+
+    // The exclusive scan of the flags gives the output position of every kept element
+    IBuffer* pOffsets = GetScratchBuffer(m_pCompactOffsets, Attribs.NumElements, "Compute primitives compact offsets");
+    ScanLevel(pContext, Attribs.pFlags, pOffsets, Attribs.NumElements, /*Inclusive = */ false, /*ScanFlags = */ true, 0);
+
+    auto* pSRB = m_CompactScatter.pSRB.RawPtr<IShaderResourceBinding>();
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_CompactInput")->Set(Attribs.pInput->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_CompactFlags")->Set(Attribs.pFlags->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_CompactOffsets")->Set(pOffsets->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_CompactOutput")->Set(Attribs.pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_CompactCount")->Set(Attribs.pCount->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    const Uint32 ElementsPerGroup = GetElementsPerGroup();
+    const Uint32 NumBlocks        = (Attribs.NumElements + ElementsPerGroup - 1) / ElementsPerGroup;
+    UpdateConstants(pContext, Attribs.NumElements, NumBlocks, 0, false, false);
+    Dispatch(pContext, m_CompactScatter, NumBlocks);
+}
+
+void ComputePrimitives::Sort(IDeviceContext* pContext, const SortAttribs& Attribs)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(Attribs.pKeys != nullptr, "Keys buffer must not be null");
+    DEV_CHECK_ERR(Attribs.pTempKeys != nullptr, "Temporary keys buffer must not be null");
+    DEV_CHECK_ERR(Attribs.pValues == nullptr || Attribs.pTempValues != nullptr, "Temporary values buffer must not be null when values are sorted");
+    DEV_CHECK_ERR(Attribs.NumKeyBits > 0 && Attribs.NumKeyBits <= 32, "The number of key bits (", Attribs.NumKeyBits, ") must be between 1 and 32");
+    DEV_CHECK_ERR(Attribs.NumElements <= MaxThreadGroupCount * GetElementsPerGroup(), "The number of elements (", Attribs.NumElements, ") exceeds the limit");
+    DEV_CHECK_ERR(Attribs.pTempKeys->GetDesc().Size >= Uint64{sizeof(Uint32)} * Attribs.NumElements,
+                  "The temporary keys buffer is too small to hold ", Attribs.NumElements, " elements");
+
+    if (Attribs.NumElements <= 1)
+        return;
+
+    constexpr Uint32 Radix = 1u << RadixBits;
+
+    const Uint32 ElementsPerGroup = GetElementsPerGroup();
+    const Uint32 NumBlocks        = (Attribs.NumElements + ElementsPerGroup - 1) / ElementsPerGroup;
+    const Uint32 NumPasses        = (Attribs.NumKeyBits + RadixBits - 1) / RadixBits;
+
+    IBuffer* pHistograms = GetScratchBuffer(m_pRadixHistograms, Radix * NumBlocks, "Compute primitives radix histograms");
+
+    IBuffer* pKeysIn    = Attribs.pKeys;
+    IBuffer* pKeysOut   = Attribs.pTempKeys;
+    IBuffer* pValuesIn  = Attribs.pValues;
+    IBuffer* pValuesOut = Attribs.pTempValues;
+
+    auto& ScatterPipeline = Attribs.pValues != nullptr ? m_RadixScatterKeyValues : m_RadixScatterKeys;
+    auto* pHistogramSRB   = m_RadixHistogram.pSRB.RawPtr<IShaderResourceBinding>();
+    auto* pScatterSRB     = ScatterPipeline.pSRB.RawPtr<IShaderResourceBinding>();
+    for (Uint32 Pass = 0; Pass < NumPasses; ++Pass)
+    {
+        const Uint32 Shift = Pass * RadixBits;
+
+        pHistogramSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_KeysIn")->Set(pKeysIn->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+        pHistogramSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Histograms")->Set(pHistograms->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+        UpdateConstants(pContext, Attribs.NumElements, NumBlocks, Shift, false, false);
+        Dispatch(pContext, m_RadixHistogram, NumBlocks);
+
+        // Digit-major histograms turn into the output offsets of every digit of every block
+        ScanLevel(pContext, nullptr, pHistograms, Radix * NumBlocks, /*Inclusive = */ false, /*ScanFlags = */ false, 0);
+
+        pScatterSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_KeysIn")->Set(pKeysIn->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+        pScatterSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_KeysOut")->Set(pKeysOut->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+        pScatterSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Histograms")->Set(pHistograms->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+        if (Attribs.pValues != nullptr)
+        {
+            pScatterSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_ValuesIn")->Set(pValuesIn->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+            pScatterSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_ValuesOut")->Set(pValuesOut->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+        }
+        UpdateConstants(pContext, Attribs.NumElements, NumBlocks, Shift, false, false);
+        Dispatch(pContext, ScatterPipeline, NumBlocks);
+
+        std::swap(pKeysIn, pKeysOut);
+        std::swap(pValuesIn, pValuesOut);
+    }
+
+    // After an odd number of passes, the result is in the temporary buffers
+    if (pKeysIn != Attribs.pKeys)
+    {
+        const Uint64 Size = Uint64{sizeof(Uint32)} * Attribs.NumElements;
+        pContext->CopyBuffer(pKeysIn, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             Attribs.pKeys, 0, Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        if (Attribs.pValues != nullptr)
+        {
+            pContext->CopyBuffer(pValuesIn, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                 Attribs.pValues, 0, Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
+    }
+}
+
+} // namespace Diligent
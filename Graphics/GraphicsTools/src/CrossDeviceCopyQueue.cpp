@@ -0,0 +1,220 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "CrossDeviceCopyQueue.hpp"
+
+#include <cstring>
+
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+AsyncReadbackQueue::CreateInfo GetReadbackQueueCI(const CrossDeviceCopyQueue::CreateInfo& CI)
+{
+    if (CI.pSrcDevice == nullptr)
+        LOG_ERROR_AND_THROW("Source render device must not be null");
+
+    AsyncReadbackQueue::CreateInfo QueueCI;
+    QueueCI.pDevice            = CI.pSrcDevice;
+    QueueCI.pThreadPool        = CI.pThreadPool;
+    QueueCI.MaxPooledResources = CI.MaxPooledResources;
+    return QueueCI;
+}
+
+} // namespace
+
+struct CrossDeviceCopyQueue::PendingCopy
+{
+    RefCntAutoPtr<IBuffer> pDstBuffer;
+    Uint64                 DstOffset = 0;
+
+    RefCntAutoPtr<ITexture> pDstTexture;
+    Uint32                  DstMipLevel = 0;
+    Uint32                  DstSlice    = 0;
+    Uint32                  DstX        = 0;
+    Uint32                  DstY        = 0;
+    Uint32                  DstZ        = 0;
+
+    // Read back data. Texture data uses the row and depth slice strides of the staging texture.
+    std::vector<Uint8> Data;
+    Uint64             Stride      = 0;
+    Uint64             DepthStride = 0;
+    Box                Region;
+};
+
+CrossDeviceCopyQueue::CrossDeviceCopyQueue(const CreateInfo& CI) :
+    m_ReadbackQueue{GetReadbackQueueCI(CI)}
+{
+}
+
+CrossDeviceCopyQueue::~CrossDeviceCopyQueue()
+{
+    if (m_NumPendingCopies.load() != 0)
+        LOG_WARNING_MESSAGE(m_NumPendingCopies.load(), " cross-device copies have not been uploaded. Call Flush() before destroying the queue.");
+}
+
+bool CrossDeviceCopyQueue::CopyBuffer(IDeviceContext* pSrcContext,
+                                      IBuffer*        pSrcBuffer,
+                                      Uint64          SrcOffset,
+                                      Uint64          Size,
+                                      IBuffer*        pDstBuffer,
+                                      Uint64          DstOffset)
+{
+    if (pDstBuffer == nullptr)
+    {
+        DEV_ERROR("Destination buffer must not be null");
+        return false;
+    }
+    if (DstOffset + Size > pDstBuffer->GetDesc().Size)
+    {
+        DEV_ERROR("Copy region [", DstOffset, ", ", DstOffset + Size, ") is out of bounds of the destination buffer '", pDstBuffer->GetDesc().Name, "'");
+        return false;
+    }
+
+    auto pCopy        = std::make_shared<PendingCopy>();
+    pCopy->pDstBuffer = pDstBuffer;
+    pCopy->DstOffset  = DstOffset;
+
+    const auto Enqueued = m_ReadbackQueue.ReadBuffer(pSrcContext, pSrcBuffer, SrcOffset, Size,
+                                                     [this, pCopy](const AsyncReadbackQueue::ReadbackData& Data) {
+                                                         const auto* pData = static_cast<const Uint8*>(Data.pData);
+                                                         pCopy->Data.assign(pData, pData + Data.Size);
+
+                                                         std::lock_guard<std::mutex> Lock{m_ReadyCopiesMtx};
+                                                         m_ReadyCopies.emplace_back(pCopy);
+                                                     });
+    if (Enqueued)
+        ++m_NumPendingCopies;
+
+    return Enqueued;
+}
+
+bool CrossDeviceCopyQueue::CopyTexture(IDeviceContext* pSrcContext,
+                                       ITexture*       pSrcTexture,
+                                       Uint32          SrcMipLevel,
+                                       Uint32          SrcSlice,
+                                       const Box*      pSrcRegion,
+                                       ITexture*       pDstTexture,
+                                       Uint32          DstMipLevel,
+                                       Uint32          DstSlice,
+                                       Uint32          DstX,
+                                       Uint32          DstY,
+                                       Uint32          DstZ)
+{
+    if (pDstTexture == nullptr)
+    {
+        DEV_ERROR("Destination texture must not be null");
+        return false;
+    }
+    if (pSrcTexture != nullptr && pSrcTexture->GetDesc().Format != pDstTexture->GetDesc().Format)
+    {
+        DEV_ERROR("Source and destination textures must have the same format");
+        return false;
+    }
+
+    auto pCopy         = std::make_shared<PendingCopy>();
+    pCopy->pDstTexture = pDstTexture;
+    pCopy->DstMipLevel = DstMipLevel;
+    pCopy->DstSlice    = DstSlice;
+    pCopy->DstX        = DstX;
+    pCopy->DstY        = DstY;
+    pCopy->DstZ        = DstZ;
+
+    const auto Enqueued = m_ReadbackQueue.ReadTexture(pSrcContext, pSrcTexture, SrcMipLevel, SrcSlice, pSrcRegion,
+                                                      [this, pCopy](const AsyncReadbackQueue::ReadbackData& Data) {
+                                                          const auto* pData = static_cast<const Uint8*>(Data.pData);
+                                                          pCopy->Data.assign(pData, pData + Data.Size);
+                                                          pCopy->Stride      = Data.Stride;
+                                                          pCopy->DepthStride = Data.DepthStride;
+                                                          pCopy->Region      = Data.Region;
+
+                                                          std::lock_guard<std::mutex> Lock{m_ReadyCopiesMtx};
+                                                          m_ReadyCopies.emplace_back(pCopy);
+                                                      });
+    if (Enqueued)
+        ++m_NumPendingCopies;
+
+    return Enqueued;
+}
+
+void CrossDeviceCopyQueue::UploadReadyCopies(IDeviceContext* pDstContext)
+{
+    std::vector<std::shared_ptr<PendingCopy>> ReadyCopies;
+    {
+        std::lock_guard<std::mutex> Lock{m_ReadyCopiesMtx};
+        ReadyCopies.swap(m_ReadyCopies);
+    }
+
+    for (const auto& pCopy : ReadyCopies)
+    {
+        if (pCopy->pDstBuffer)
+        {
+            pDstContext->UpdateBuffer(pCopy->pDstBuffer, pCopy->DstOffset, pCopy->Data.size(), pCopy->Data.data(),
+                                      RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
+        else
+        {
+            VERIFY_EXPR(pCopy->pDstTexture);
+
+            const auto& Region = pCopy->Region;
+            const Box   DstBox{
+                pCopy->DstX, pCopy->DstX + Region.Width(),
+                pCopy->DstY, pCopy->DstY + Region.Height(),
+                pCopy->DstZ, pCopy->DstZ + Region.Depth()};
+
+            TextureSubResData SubresData;
+            SubresData.pData       = pCopy->Data.data();
+            SubresData.Stride      = pCopy->Stride;
+            SubresData.DepthStride = pCopy->DepthStride;
+            pDstContext->UpdateTexture(pCopy->pDstTexture, pCopy->DstMipLevel, pCopy->DstSlice, DstBox, SubresData,
+                                       RESOURCE_STATE_TRANSITION_MODE_NONE, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
+        --m_NumPendingCopies;
+    }
+}
+
+void CrossDeviceCopyQueue::Process(IDeviceContext* pSrcContext, IDeviceContext* pDstContext)
+{
+    m_ReadbackQueue.Process(pSrcContext);
+    UploadReadyCopies(pDstContext);
+}
+
+void CrossDeviceCopyQueue::Flush(IDeviceContext* pSrcContext, IDeviceContext* pDstContext)
+{
+    m_ReadbackQueue.Flush(pSrcContext);
+    UploadReadyCopies(pDstContext);
+    VERIFY_EXPR(m_NumPendingCopies.load() == 0);
+}
+
+} // namespace Diligent
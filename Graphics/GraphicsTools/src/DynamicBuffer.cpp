@@ -32,6 +32,7 @@
 
 #include "DebugUtilities.hpp"
 #include "Align.hpp"
+#include "PlatformMisc.hpp"
 
 namespace Diligent
 {
@@ -60,6 +61,11 @@ bool VerifySparseBufferCompatibility(IRenderDevice* pDevice)
     return true;
 }
 
+bool IsTransferContext(IDeviceContext* pContext)
+{
+    return (pContext->GetDesc().QueueType & COMMAND_QUEUE_TYPE_PRIMARY_MASK) == COMMAND_QUEUE_TYPE_TRANSFER;
+}
+
 } // namespace
 
 DynamicBuffer::DynamicBuffer(IRenderDevice*                 pDevice,
@@ -125,8 +131,13 @@ void DynamicBuffer::CreateSparseBuffer(IRenderDevice* pDevice)
         DEV_CHECK_ERR(m_pMemory, "Failed to create device memory");
     }
 
+    CreateResizeFences(pDevice);
+}
+
+void DynamicBuffer::CreateResizeFences(IRenderDevice* pDevice)
+{
     // Note: D3D11 does not support general fences
-    if (pDevice->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_D3D11)
+    if (pDevice->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_D3D11 && !m_pAfterResizeFence)
     {
         FenceDesc Desc;
         Desc.Type = FENCE_TYPE_GENERAL;
@@ -159,6 +170,11 @@ void DynamicBuffer::InitBuffer(IRenderDevice* pDevice)
             // The array was previously empty - nothing to copy
             m_Desc.Size = m_PendingSize;
         }
+
+        // When the buffer is shared between multiple immediate contexts, the contents may be
+        // copied by a transfer context, and other contexts will need to wait for the copy.
+        if (PlatformMisc::CountOneBits(m_Desc.ImmediateContextMask) > 1)
+            CreateResizeFences(pDevice);
     }
     DEV_CHECK_ERR(m_pBuffer, "Failed to create buffer for a dynamic buffer");
 
@@ -167,6 +183,8 @@ void DynamicBuffer::InitBuffer(IRenderDevice* pDevice)
 
 void DynamicBuffer::ResizeSparseBuffer(IDeviceContext* pContext)
 {
+    m_pCopyContext = nullptr;
+
     VERIFY_EXPR(m_pBuffer && m_pMemory);
     VERIFY_EXPR(m_PendingSize % m_MemoryPageSize == 0);
     DEV_CHECK_ERR(m_PendingSize <= m_pBuffer->GetDesc().Size,
@@ -246,6 +264,18 @@ void DynamicBuffer::ResizeDefaultBuffer(IDeviceContext* pContext)
     pContext->CopyBuffer(m_pStaleBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
                          m_pBuffer, 0, CopySize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
     m_pStaleBuffer.Release();
+
+    if (m_pAfterResizeFence && IsTransferContext(pContext))
+    {
+        DEV_CHECK_ERR((m_Desc.ImmediateContextMask & (Uint64{1} << pContext->GetDesc().ContextId)) != 0,
+                      "Transfer context '", pContext->GetDesc().Name, "' is not enabled by the ImmediateContextMask of dynamic buffer '", m_Desc.Name, "'.");
+
+        // Other contexts will wait for the fence in GetBuffer().
+        // The context must be flushed so that the signal is submitted before the wait.
+        pContext->EnqueueSignal(m_pAfterResizeFence, m_NextAfterResizeFenceValue++);
+        pContext->Flush();
+        m_pCopyContext = pContext;
+    }
 }
 
 void DynamicBuffer::CommitResize(IRenderDevice*  pDevice,
@@ -328,7 +358,8 @@ IBuffer* DynamicBuffer::GetBuffer(IRenderDevice*  pDevice,
 {
     CommitResize(pDevice, pContext, false /*AllowNull*/);
 
-    if (m_LastAfterResizeFenceValue + 1 < m_NextAfterResizeFenceValue)
+    // The transfer context that copied the contents does not need to wait for its own work
+    if (m_LastAfterResizeFenceValue + 1 < m_NextAfterResizeFenceValue && (pContext == nullptr || pContext != m_pCopyContext))
     {
         DEV_CHECK_ERR(pContext != nullptr, "Device context is null, but waiting for the fence is required");
         VERIFY_EXPR(m_pAfterResizeFence);
@@ -339,4 +370,15 @@ IBuffer* DynamicBuffer::GetBuffer(IRenderDevice*  pDevice,
     return m_pBuffer;
 }
 
+Uint64 DynamicBuffer::GetMemoryUsage() const
+{
+    if (m_Desc.Usage == USAGE_SPARSE)
+        return m_pMemory ? m_pMemory->GetCapacity() : 0;
+
+    Uint64 MemUsage = m_pBuffer ? m_pBuffer->GetDesc().Size : 0;
+    if (m_pStaleBuffer)
+        MemUsage += m_pStaleBuffer->GetDesc().Size;
+    return MemUsage;
+}
+
 } // namespace Diligent
@@ -32,6 +32,7 @@
 #include "DebugUtilities.hpp"
 #include "GraphicsAccessories.hpp"
 #include "Align.hpp"
+#include "PlatformMisc.hpp"
 
 namespace Diligent
 {
@@ -67,6 +68,11 @@ bool VerifySparseTextureCompatibility(IRenderDevice* pDevice, const TextureDesc&
     return true;
 }
 
+bool IsTransferContext(IDeviceContext* pContext)
+{
+    return (pContext->GetDesc().QueueType & COMMAND_QUEUE_TYPE_PRIMARY_MASK) == COMMAND_QUEUE_TYPE_TRANSFER;
+}
+
 } // namespace
 
 DynamicTextureArray::DynamicTextureArray(IRenderDevice* pDevice, const DynamicTextureArrayCreateInfo& CreateInfo) :
@@ -179,9 +185,13 @@ void DynamicTextureArray::CreateSparseTexture(IRenderDevice* pDevice)
         DEV_CHECK_ERR(m_pMemory, "Failed to create device memory");
     }
 
-    // Create fences
+    CreateResizeFences(pDevice);
+}
+
+void DynamicTextureArray::CreateResizeFences(IRenderDevice* pDevice)
+{
     // Note: D3D11 does not support general fences
-    if (pDevice->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_D3D11)
+    if (pDevice->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_D3D11 && !m_pAfterResizeFence)
     {
         FenceDesc Desc;
         Desc.Type = FENCE_TYPE_GENERAL;
@@ -215,6 +225,11 @@ void DynamicTextureArray::CreateResources(IRenderDevice* pDevice)
             // The array was previously empty - nothing to copy
             m_Desc.ArraySize = m_PendingSize;
         }
+
+        // When the texture is shared between multiple immediate contexts, the contents may be
+        // copied by a transfer context, and other contexts will need to wait for the copy.
+        if (PlatformMisc::CountOneBits(m_Desc.ImmediateContextMask) > 1)
+            CreateResizeFences(pDevice);
     }
     DEV_CHECK_ERR(m_pTexture, "Failed to create texture for a dynamic texture array");
 
@@ -224,6 +239,8 @@ void DynamicTextureArray::CreateResources(IRenderDevice* pDevice)
 
 void DynamicTextureArray::ResizeSparseTexture(IDeviceContext* pContext)
 {
+    m_pCopyContext = nullptr;
+
     VERIFY_EXPR(m_PendingSize != m_Desc.ArraySize);
     VERIFY_EXPR(m_pTexture && m_pMemory);
 
@@ -379,6 +396,18 @@ void DynamicTextureArray::ResizeDefaultTexture(IDeviceContext* pContext)
         }
     }
     m_pStaleTexture.Release();
+
+    if (m_pAfterResizeFence && IsTransferContext(pContext))
+    {
+        DEV_CHECK_ERR((m_Desc.ImmediateContextMask & (Uint64{1} << pContext->GetDesc().ContextId)) != 0,
+                      "Transfer context '", pContext->GetDesc().Name, "' is not enabled by the ImmediateContextMask of dynamic texture array '", m_Desc.Name, "'.");
+
+        // Other contexts will wait for the fence in GetTexture().
+        // The context must be flushed so that the signal is submitted before the wait.
+        pContext->EnqueueSignal(m_pAfterResizeFence, m_NextAfterResizeFenceValue++);
+        pContext->Flush();
+        m_pCopyContext = pContext;
+    }
 }
 
 void DynamicTextureArray::CommitResize(IRenderDevice*  pDevice,
@@ -460,7 +489,8 @@ ITexture* DynamicTextureArray::GetTexture(IRenderDevice*  pDevice,
 {
     CommitResize(pDevice, pContext, false /*AllowNull*/);
 
-    if (m_LastAfterResizeFenceValue + 1 < m_NextAfterResizeFenceValue)
+    // The transfer context that copied the contents does not need to wait for its own work
+    if (m_LastAfterResizeFenceValue + 1 < m_NextAfterResizeFenceValue && (pContext == nullptr || pContext != m_pCopyContext))
     {
         DEV_CHECK_ERR(pContext != nullptr, "Device context is null, but waiting for the fence is required");
         VERIFY_EXPR(m_pAfterResizeFence);
@@ -33,6 +33,8 @@
 #include <unordered_map>
 #include <map>
 #include <set>
+#include <unordered_set>
+#include <vector>
 
 #include "DynamicAtlasManager.hpp"
 #include "DynamicTextureArray.hpp"
@@ -42,6 +44,7 @@
 #include "DefaultRawMemoryAllocator.hpp"
 #include "GraphicsAccessories.hpp"
 #include "Align.hpp"
+#include "PlatformMisc.hpp"
 
 namespace Diligent
 {
@@ -115,6 +118,23 @@ public:
 
     virtual IDynamicTextureAtlas* GetAtlas() override final;
 
+    // Must be called with the parent's suballocation registry mutex locked when defragmentation is enabled
+    DynamicAtlasManager::Region& GetSubregion()
+    {
+        return m_Subregion;
+    }
+
+    // Replaces the subregion with the new one and returns the old subregion.
+    // Must be called with the parent's suballocation registry mutex locked.
+    DynamicAtlasManager::Region Move(Uint32 NewSlice, DynamicAtlasManager::Region&& NewSubregion)
+    {
+        VERIFY_EXPR(!NewSubregion.IsEmpty());
+        auto OldSubregion = std::move(m_Subregion);
+        m_Subregion       = std::move(NewSubregion);
+        m_Slice           = NewSlice;
+        return OldSubregion;
+    }
+
     virtual void SetUserData(IObject* pUserData) override final
     {
         m_pUserData = pUserData;
@@ -128,9 +148,10 @@ public:
 private:
     RefCntAutoPtr<DynamicTextureAtlasImpl> m_pParentAtlas;
 
+    // The subregion and the slice may be changed by defragmentation
     DynamicAtlasManager::Region m_Subregion;
+    Uint32                      m_Slice;
 
-    const Uint32 m_Slice;
     const Uint32 m_Alignment;
     const uint2  m_Size;
 
@@ -143,8 +164,8 @@ namespace
 class ThreadSafeAtlasManager
 {
 public:
-    ThreadSafeAtlasManager(const uint2& Dim) noexcept :
-        Mgr{Dim.x, Dim.y}
+    ThreadSafeAtlasManager(const uint2& Dim, DYNAMIC_ATLAS_MANAGER_POLICY Policy) noexcept :
+        Mgr{Dim.x, Dim.y, Policy}
     {}
 
     // clang-format off
@@ -273,8 +294,9 @@ private:
 
 struct SliceBatch
 {
-    SliceBatch(const uint2 AtlasDim) noexcept :
-        m_AtlasDim{AtlasDim}
+    SliceBatch(const uint2 AtlasDim, DYNAMIC_ATLAS_MANAGER_POLICY Policy) noexcept :
+        m_AtlasDim{AtlasDim},
+        m_Policy{Policy}
     {}
 
     ~SliceBatch()
@@ -318,7 +340,7 @@ struct SliceBatch
         std::lock_guard<std::mutex> Guard{m_Mtx};
 
         VERIFY(m_Slices.find(Slice) == m_Slices.end(), "Slice ", Slice, " already present in the batch.");
-        auto it = m_Slices.emplace(Slice, m_AtlasDim).first;
+        auto it = m_Slices.emplace(std::piecewise_construct, std::forward_as_tuple(Slice), std::forward_as_tuple(m_AtlasDim, m_Policy)).first;
         // NB: Lock() atomically increases the use count of the slice while we hold the mutex.
         return it->second.Lock();
     }
@@ -355,6 +377,8 @@ struct SliceBatch
 private:
     const uint2 m_AtlasDim;
 
+    const DYNAMIC_ATLAS_MANAGER_POLICY m_Policy;
+
     std::mutex m_Mtx;
     // For every alignment, we keep a list of slice managers sorted by the slice index.
     std::map<Uint32, ThreadSafeAtlasManager> m_Slices;
@@ -386,6 +410,8 @@ public:
         m_ExtraSliceCount {CreateInfo.ExtraSliceCount},
         m_MaxSliceCount   {CreateInfo.Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY ? std::min(CreateInfo.MaxSliceCount, Uint32{2048}) : 1},
         m_Silent          {CreateInfo.Silent},
+        m_PackingPolicy   {CreateInfo.PackingPolicy},
+        m_DefragmentationEnabled{CreateInfo.EnableDefragmentation},
         m_SuballocationsAllocator
         {
             DefaultRawMemoryAllocator::GetAllocator(),
@@ -445,6 +471,7 @@ public:
         VERIFY_EXPR(m_UsedArea.load() == 0);
         VERIFY_EXPR(m_AllocationCount.load() == 0);
         VERIFY_EXPR(m_AvailableSlices.size() == m_MaxSliceCount);
+        VERIFY_EXPR(m_Suballocations.empty());
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DynamicTextureAtlas, TBase)
@@ -565,9 +592,30 @@ public:
         };
         // clang-format on
 
+        if (m_DefragmentationEnabled)
+        {
+            std::lock_guard<std::mutex> Guard{m_SuballocationsMtx};
+            m_Suballocations.insert(pSuballocation);
+        }
+
         pSuballocation->QueryInterface(IID_TextureAtlasSuballocation, reinterpret_cast<IObject**>(ppSuballocation));
     }
 
+    void Free(TextureAtlasSuballocationImpl* pSuballocation)
+    {
+        std::unique_lock<std::mutex> Guard{m_SuballocationsMtx, std::defer_lock};
+        if (m_DefragmentationEnabled)
+        {
+            // NB: the mutex must be held while the region is released as
+            //     the slice and the subregion may be changed by Defragment().
+            Guard.lock();
+            m_Suballocations.erase(pSuballocation);
+        }
+
+        const auto Size = pSuballocation->GetSize();
+        Free(pSuballocation->GetSlice(), pSuballocation->GetAlignment(), std::move(pSuballocation->GetSubregion()), Size.x, Size.y);
+    }
+
     void Free(Uint32 Slice, Uint32 Alignment, DynamicAtlasManager::Region&& Subregion, Uint32 Width, Uint32 Height)
     {
         const auto AllocatedArea = Int64{Width} * Int64{Height};
@@ -582,48 +630,12 @@ public:
             return;
         }
 
-        if (auto SliceMgr = pBatch->LockSlice(Slice))
-        {
-            // NB: do not hold the slice batch mutex while releasing the region.
-            //     Different slices in the batch can be processed in parallel.
-            SliceMgr.Free(std::move(Subregion));
-        }
-        else
+        if (!ReleaseRegion(*pBatch, Slice, std::move(Subregion)))
         {
             UNEXPECTED("Slice ", Slice, " is not found in the batch of slices with alignment ", Alignment);
             return;
         }
 
-        // NB: we need to always purge the batch as the call to Free is not
-        //     protected by the slice batch mutex, so other threads may have
-        //     accessed and changed the same slice.
-        //
-        //           Thread 1                            |         Thread 2
-        //                                               |
-        //  SliceMgr = pBatch->LockSlice                 |
-        //  | UseCnt==1                                  |   SliceMgr = pBatch->LockSlice
-        //  | SliceMgr.Free                              |   | UseCnt==2
-        //  |   SliceMgr.IsEmpty==false                  |   | SliceMgr.Free
-        //  |                                            |   |   SliceMgr.IsEmpty==true
-        //  |                                            |   | SliceMgr.~ManagerGuard()
-        //  |                                            |   | UseCnt==1
-        //  |                                            |
-        //  |                                            |   pBatch->Purge
-        //  |                                            |   | UseCnt==1 -> No purge
-        //  |                                            |
-        //  | SliceMgr.~ManagerGuard()                   |
-        //  | UseCnt==0                                  |
-        //                                               |
-        //  pBatch->Purge                                |
-        //  | UseCnt==0, SliceMgr.IsEmpty==true -> Purge |
-        //
-        // Note that in the scenario above, Thread 1 purges the slice batch even though
-        // the slice was not empty after freeing the region.
-        if (pBatch->Purge(Slice))
-        {
-            RecycleSlice(Slice);
-        }
-
         m_AllocatedArea.fetch_add(-AllocatedArea);
         m_UsedArea.fetch_add(-UsedArea);
         m_AllocationCount.fetch_add(-1);
@@ -637,7 +649,7 @@ public:
     virtual Uint32 GetVersion() const override final
     {
         if (m_DynamicTexArray)
-            return m_DynamicTexArray->GetVersion();
+            return m_DynamicTexArray->GetVersion() + m_DefragmentationVersion.load();
         else if (m_pTexture)
             return 1;
         else
@@ -666,7 +678,264 @@ public:
         Stats.UsedArea        = m_UsedArea.load();
     }
 
+    virtual Uint32 Defragment(const DynamicTextureAtlasDefragmentAttribs& Attribs) override final
+    {
+        if (!m_DefragmentationEnabled)
+        {
+            DEV_ERROR("Defragmentation is not enabled. Set DynamicTextureAtlasCreateInfo::EnableDefragmentation to true.");
+            return 0;
+        }
+        DEV_CHECK_ERR(Attribs.pContext != nullptr, "Device context must not be null");
+
+        // Single-slice atlas can't be defragmented
+        if (!m_DynamicTexArray)
+            return 0;
+
+        // Commit pending resizes first so that the texture contains all slices.
+        auto* pTexture = GetTexture(Attribs.pDevice, Attribs.pContext);
+        if (pTexture == nullptr)
+            return 0;
+
+        std::lock_guard<std::mutex> Guard{m_SuballocationsMtx};
+
+        // Process suballocations starting from the last slice. Larger allocations
+        // are moved first as they are harder to fit.
+        std::vector<TextureAtlasSuballocationImpl*> Suballocations{m_Suballocations.begin(), m_Suballocations.end()};
+        std::sort(Suballocations.begin(), Suballocations.end(),
+                  [](TextureAtlasSuballocationImpl* lhs, TextureAtlasSuballocationImpl* rhs) {
+                      if (lhs->GetSlice() != rhs->GetSlice())
+                          return lhs->GetSlice() > rhs->GetSlice();
+                      const auto& lhsRegion = lhs->GetSubregion();
+                      const auto& rhsRegion = rhs->GetSubregion();
+                      return Uint64{lhsRegion.width} * lhsRegion.height > Uint64{rhsRegion.width} * rhsRegion.height;
+                  });
+
+        Uint32 NumMoved  = 0;
+        Uint64 AreaMoved = 0;
+        for (auto* pSuballocation : Suballocations)
+        {
+            const auto OldSlice = pSuballocation->GetSlice();
+            if (OldSlice == 0)
+                break;
+
+            const auto Size = pSuballocation->GetSize();
+            const auto Area = Uint64{Size.x} * Uint64{Size.y};
+            if (Attribs.MaxAreaToMove != 0 && NumMoved > 0 && AreaMoved + Area > Attribs.MaxAreaToMove)
+                break;
+
+            const auto Alignment = pSuballocation->GetAlignment();
+            auto*      pBatch    = GetSliceBatch(Alignment);
+            VERIFY_EXPR(pBatch != nullptr);
+
+            const auto& OldSubregion = pSuballocation->GetSubregion();
+
+            // Find the first lower slice in the same batch that has enough space
+            DynamicAtlasManager::Region NewSubregion;
+
+            Uint32 NewSlice = 0;
+            while (NewSlice < OldSlice)
+            {
+                auto SliceMgr = pBatch->LockSliceAfter(NewSlice);
+                if (!SliceMgr || NewSlice >= OldSlice)
+                    break;
+
+                NewSubregion = SliceMgr.Allocate(OldSubregion.width, OldSubregion.height);
+                if (!NewSubregion.IsEmpty())
+                    break;
+
+                ++NewSlice;
+            }
+
+            if (NewSubregion.IsEmpty())
+                continue;
+
+            if (!CopySubregion(Attribs.pDevice, Attribs.pContext, pTexture, Alignment, OldSlice, OldSubregion, NewSlice, NewSubregion))
+            {
+                ReleaseRegion(*pBatch, NewSlice, std::move(NewSubregion));
+                break;
+            }
+
+            const auto OldOrigin = pSuballocation->GetOrigin();
+            ReleaseRegion(*pBatch, OldSlice, pSuballocation->Move(NewSlice, std::move(NewSubregion)));
+
+            if (Attribs.MovedCallback != nullptr)
+                Attribs.MovedCallback(pSuballocation, OldOrigin, OldSlice, Attribs.pCallbackUserData);
+
+            ++NumMoved;
+            AreaMoved += Area;
+        }
+
+        if (NumMoved > 0)
+        {
+            m_DefragmentationVersion.fetch_add(1);
+            ShrinkTextureArray();
+        }
+
+        return NumMoved;
+    }
+
 private:
+    // Copies the subregion data between two slices of the texture array through the scratch texture.
+    bool CopySubregion(IRenderDevice*                     pDevice,
+                       IDeviceContext*                    pContext,
+                       ITexture*                          pTexture,
+                       Uint32                             Alignment,
+                       Uint32                             SrcSlice,
+                       const DynamicAtlasManager::Region& SrcRegion,
+                       Uint32                             DstSlice,
+                       const DynamicAtlasManager::Region& DstRegion)
+    {
+        VERIFY_EXPR(SrcRegion.width == DstRegion.width && SrcRegion.height == DstRegion.height);
+
+        const auto& TexDesc = pTexture->GetDesc();
+        const auto  Width   = SrcRegion.width * Alignment;
+        const auto  Height  = SrcRegion.height * Alignment;
+        // Coarser mip levels of the region do not cover whole texels and may be shared with other regions
+        const auto NumMips = std::min(TexDesc.MipLevels, PlatformMisc::GetLSB(Alignment) + 1);
+
+        if (!m_pScratchTexture ||
+            m_pScratchTexture->GetDesc().Width < Width ||
+            m_pScratchTexture->GetDesc().Height < Height ||
+            m_pScratchTexture->GetDesc().MipLevels < NumMips)
+        {
+            if (pDevice == nullptr)
+            {
+                DEV_ERROR("Render device must not be null when the scratch texture needs to be created");
+                return false;
+            }
+
+            TextureDesc ScratchDesc    = TexDesc;
+            ScratchDesc.Name           = "Dynamic texture atlas defragmentation scratch texture";
+            ScratchDesc.Type           = RESOURCE_DIM_TEX_2D;
+            ScratchDesc.ArraySize      = 1;
+            ScratchDesc.Usage          = USAGE_DEFAULT;
+            ScratchDesc.CPUAccessFlags = CPU_ACCESS_NONE;
+            ScratchDesc.MiscFlags      = MISC_TEXTURE_FLAG_NONE;
+            ScratchDesc.MipLevels      = NumMips;
+            if (m_pScratchTexture)
+            {
+                const auto& OldDesc   = m_pScratchTexture->GetDesc();
+                ScratchDesc.Width     = std::max(Width, OldDesc.Width);
+                ScratchDesc.Height    = std::max(Height, OldDesc.Height);
+                ScratchDesc.MipLevels = std::max(NumMips, OldDesc.MipLevels);
+            }
+            else
+            {
+                ScratchDesc.Width  = Width;
+                ScratchDesc.Height = Height;
+            }
+
+            m_pScratchTexture.Release();
+            pDevice->CreateTexture(ScratchDesc, nullptr, &m_pScratchTexture);
+            if (!m_pScratchTexture)
+            {
+                LOG_ERROR_MESSAGE("Failed to create the defragmentation scratch texture");
+                return false;
+            }
+        }
+
+        for (Uint32 mip = 0; mip < NumMips; ++mip)
+        {
+            const Box SrcBox{
+                (SrcRegion.x * Alignment) >> mip,
+                (SrcRegion.x * Alignment + Width) >> mip,
+                (SrcRegion.y * Alignment) >> mip,
+                (SrcRegion.y * Alignment + Height) >> mip,
+            };
+
+            CopyTextureAttribs CopyAttribs{pTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, m_pScratchTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+            CopyAttribs.SrcMipLevel = mip;
+            CopyAttribs.SrcSlice    = SrcSlice;
+            CopyAttribs.pSrcBox     = &SrcBox;
+            CopyAttribs.DstMipLevel = mip;
+            pContext->CopyTexture(CopyAttribs);
+
+            const Box ScratchBox{0, Width >> mip, 0, Height >> mip};
+
+            CopyAttribs             = CopyTextureAttribs{m_pScratchTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+            CopyAttribs.SrcMipLevel = mip;
+            CopyAttribs.pSrcBox     = &ScratchBox;
+            CopyAttribs.DstMipLevel = mip;
+            CopyAttribs.DstSlice    = DstSlice;
+            CopyAttribs.DstX        = (DstRegion.x * Alignment) >> mip;
+            CopyAttribs.DstY        = (DstRegion.y * Alignment) >> mip;
+            pContext->CopyTexture(CopyAttribs);
+        }
+
+        return true;
+    }
+
+    // Reduces the texture array size if the trailing slices are not used.
+    // The array is shrunk by the same steps it is expanded and never below the initial size.
+    void ShrinkTextureArray()
+    {
+        std::lock_guard<std::mutex> Guard{m_AvailableSlicesMtx};
+
+        auto ArraySize = m_TexArraySize.load();
+        while (ArraySize > m_Desc.ArraySize)
+        {
+            const auto NewArraySize = m_ExtraSliceCount != 0 ?
+                std::max(ArraySize - std::min(ArraySize, m_ExtraSliceCount), m_Desc.ArraySize) :
+                std::max(ArraySize / 2, m_Desc.ArraySize);
+
+            // All slices in the range [NewArraySize, ArraySize) must be available
+            const auto NumAvailable = std::distance(m_AvailableSlices.lower_bound(NewArraySize), m_AvailableSlices.lower_bound(ArraySize));
+            if (static_cast<Uint32>(NumAvailable) != ArraySize - NewArraySize)
+                break;
+
+            ArraySize = NewArraySize;
+        }
+        m_TexArraySize.store(ArraySize);
+    }
+
+    // Releases the region in the slice and recycles the slice if it becomes empty.
+    // Returns false if the slice is not found in the batch.
+    bool ReleaseRegion(SliceBatch& Batch, Uint32 Slice, DynamicAtlasManager::Region&& Subregion)
+    {
+        if (auto SliceMgr = Batch.LockSlice(Slice))
+        {
+            // NB: do not hold the slice batch mutex while releasing the region.
+            //     Different slices in the batch can be processed in parallel.
+            SliceMgr.Free(std::move(Subregion));
+        }
+        else
+        {
+            return false;
+        }
+
+        // NB: we need to always purge the batch as the call to Free is not
+        //     protected by the slice batch mutex, so other threads may have
+        //     accessed and changed the same slice.
+        //
+        //           Thread 1                            |         Thread 2
+        //                                               |
+        //  SliceMgr = pBatch->LockSlice                 |
+        //  | UseCnt==1                                  |   SliceMgr = pBatch->LockSlice
+        //  | SliceMgr.Free                              |   | UseCnt==2
+        //  |   SliceMgr.IsEmpty==false                  |   | SliceMgr.Free
+        //  |                                            |   |   SliceMgr.IsEmpty==true
+        //  |                                            |   | SliceMgr.~ManagerGuard()
+        //  |                                            |   | UseCnt==1
+        //  |                                            |
+        //  |                                            |   pBatch->Purge
+        //  |                                            |   | UseCnt==1 -> No purge
+        //  |                                            |
+        //  | SliceMgr.~ManagerGuard()                   |
+        //  | UseCnt==0                                  |
+        //                                               |
+        //  pBatch->Purge                                |
+        //  | UseCnt==0, SliceMgr.IsEmpty==true -> Purge |
+        //
+        // Note that in the scenario above, Thread 1 purges the slice batch even though
+        // the slice was not empty after freeing the region.
+        if (Batch.Purge(Slice))
+        {
+            RecycleSlice(Slice);
+        }
+
+        return true;
+    }
+
     Uint32 GetNextAvailableSlice()
     {
         std::lock_guard<std::mutex> Guard{m_AvailableSlicesMtx};
@@ -703,7 +972,7 @@ private:
         // Get the list of slices for this alignment
         auto BatchIt = m_SliceBatchesByAlignment.find(Alignment);
         if (BatchIt == m_SliceBatchesByAlignment.end() && AtlasWidth != 0 && AtlasHeight != 0)
-            BatchIt = m_SliceBatchesByAlignment.emplace(Alignment, uint2{AtlasWidth, AtlasHeight}).first;
+            BatchIt = m_SliceBatchesByAlignment.emplace(std::piecewise_construct, std::forward_as_tuple(Alignment), std::forward_as_tuple(uint2{AtlasWidth, AtlasHeight}, m_PackingPolicy)).first;
 
         return BatchIt != m_SliceBatchesByAlignment.end() ? &BatchIt->second : nullptr;
     }
@@ -717,6 +986,9 @@ private:
     const Uint32 m_MaxSliceCount;
     const bool   m_Silent;
 
+    const DYNAMIC_ATLAS_MANAGER_POLICY m_PackingPolicy;
+    const bool                         m_DefragmentationEnabled;
+
     std::unique_ptr<DynamicTextureArray> m_DynamicTexArray;
     RefCntAutoPtr<ITexture>              m_pTexture;
 
@@ -736,12 +1008,20 @@ private:
     // Keep available slice indices sorted.
     std::mutex       m_AvailableSlicesMtx;
     std::set<Uint32> m_AvailableSlices;
+
+    // Live suballocations; only tracked when defragmentation is enabled.
+    std::mutex                                         m_SuballocationsMtx;
+    std::unordered_set<TextureAtlasSuballocationImpl*> m_Suballocations;
+
+    RefCntAutoPtr<ITexture> m_pScratchTexture;
+
+    std::atomic<Uint32> m_DefragmentationVersion{0};
 };
 
 
 TextureAtlasSuballocationImpl::~TextureAtlasSuballocationImpl()
 {
-    m_pParentAtlas->Free(m_Slice, m_Alignment, std::move(m_Subregion), m_Size.x, m_Size.y);
+    m_pParentAtlas->Free(this);
 }
 
 IDynamicTextureAtlas* TextureAtlasSuballocationImpl::GetAtlas()
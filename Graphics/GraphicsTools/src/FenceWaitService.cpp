@@ -0,0 +1,210 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+#include "FenceWaitService.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+bool FencesSupportWorkerThread(RENDER_DEVICE_TYPE DeviceType)
+{
+    // Direct3D11 and OpenGL fences query the immediate context, which may only be
+    // used by the thread that owns it.
+    return (DeviceType == RENDER_DEVICE_TYPE_D3D12 ||
+            DeviceType == RENDER_DEVICE_TYPE_VULKAN ||
+            DeviceType == RENDER_DEVICE_TYPE_METAL);
+}
+
+} // namespace
+
+FenceWaitService::FenceWaitService(const CreateInfo& CI) :
+    m_PollInterval{CI.PollIntervalUs}
+{
+    if (CI.pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+
+    if (!CI.DisableWorkerThread && FencesSupportWorkerThread(CI.pDevice->GetDeviceInfo().Type))
+        m_Worker = std::thread{&FenceWaitService::WorkerThreadProc, this};
+}
+
+FenceWaitService::~FenceWaitService()
+{
+    if (m_Worker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            m_Stop = true;
+        }
+        m_WakeCV.notify_one();
+        // The worker drops the pending requests and exits
+        m_Worker.join();
+    }
+}
+
+void FenceWaitService::Enqueue(IFence* pFence, Uint64 Value, CallbackType Callback)
+{
+    DEV_CHECK_ERR(pFence != nullptr, "Fence must not be null");
+    DEV_CHECK_ERR(Callback, "Callback must not be empty");
+
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_Requests.push_back({RefCntAutoPtr<IFence>{pFence}, Value, std::move(Callback)});
+    }
+    m_WakeCV.notify_one();
+}
+
+void FenceWaitService::ExtractCompletedRequests(std::vector<Request>& Completed)
+{
+    // Requests for different fences may be interleaved, so the completed value
+    // of every fence is queried once and cached.
+    m_CompletedValues.clear();
+    for (auto it = m_Requests.begin(); it != m_Requests.end();)
+    {
+        auto val_it = std::find_if(m_CompletedValues.begin(), m_CompletedValues.end(),
+                                   [pFence = it->pFence.RawPtr()](const std::pair<IFence*, Uint64>& FenceValue) {
+                                       return FenceValue.first == pFence;
+                                   });
+        if (val_it == m_CompletedValues.end())
+        {
+            m_CompletedValues.emplace_back(it->pFence.RawPtr(), it->pFence->GetCompletedValue());
+            val_it = m_CompletedValues.end() - 1;
+        }
+
+        if (it->Value <= val_it->second)
+        {
+            Completed.emplace_back(std::move(*it));
+            it = m_Requests.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    m_NumRunningCallbacks += Completed.size();
+}
+
+void FenceWaitService::WorkerThreadProc()
+{
+    std::vector<Request> Completed;
+
+    std::unique_lock<std::mutex> Lock{m_Mtx};
+    while (true)
+    {
+        m_WakeCV.wait(Lock, [this] { return m_Stop || !m_Requests.empty(); });
+        if (m_Stop)
+            break;
+
+        ExtractCompletedRequests(Completed);
+        if (Completed.empty())
+        {
+            // IFence::Wait() can't wait for several fences at once and can't be interrupted,
+            // so none of the fences is waited for: blocking on one pending value would delay
+            // the callbacks of all other fences and prevent the worker from stopping.
+            // The thread sleeps until a new request is enqueued, the service is stopped,
+            // or the polling interval expires.
+            m_WakeCV.wait_for(Lock, m_PollInterval);
+            continue;
+        }
+        const size_t NumCompleted = Completed.size();
+
+        Lock.unlock();
+        for (Request& Req : Completed)
+            Req.Callback();
+        Completed.clear();
+        Lock.lock();
+
+        m_NumRunningCallbacks -= NumCompleted;
+        if (m_Requests.empty() && m_NumRunningCallbacks == 0)
+            m_IdleCV.notify_all();
+    }
+
+    // Requests whose fences have not completed are dropped without running the callbacks
+    m_Requests.clear();
+    m_IdleCV.notify_all();
+}
+
+Uint32 FenceWaitService::Poll()
+{
+    if (IsAsync())
+        return 0;
+
+    std::vector<Request> Completed;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        ExtractCompletedRequests(Completed);
+    }
+
+    for (Request& Req : Completed)
+        Req.Callback();
+
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_NumRunningCallbacks -= Completed.size();
+    }
+    return static_cast<Uint32>(Completed.size());
+}
+
+void FenceWaitService::WaitIdle()
+{
+    if (IsAsync())
+    {
+        std::unique_lock<std::mutex> Lock{m_Mtx};
+        m_IdleCV.wait(Lock, [this] { return m_Requests.empty() && m_NumRunningCallbacks == 0; });
+        return;
+    }
+
+    while (true)
+    {
+        RefCntAutoPtr<IFence> pFence;
+        Uint64                Value = 0;
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            if (m_Requests.empty())
+                break;
+            pFence = m_Requests.front().pFence;
+            Value  = m_Requests.front().Value;
+        }
+
+        pFence->Wait(Value);
+        Poll();
+    }
+}
+
+size_t FenceWaitService::GetNumPendingRequests() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_Requests.size() + m_NumRunningCallbacks;
+}
+
+} // namespace Diligent
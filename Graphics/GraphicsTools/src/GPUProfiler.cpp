@@ -0,0 +1,434 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GPUProfiler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+void AppendEscapedJsonString(std::string& Json, const std::string& Str)
+{
+    Json.push_back('"');
+    for (char c : Str)
+    {
+        switch (c)
+        {
+            case '"': Json.append("\\\""); break;
+            case '\\': Json.append("\\\\"); break;
+            case '\n': Json.append("\\n"); break;
+            case '\r': Json.append("\\r"); break;
+            case '\t': Json.append("\\t"); break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char Code[8];
+                    snprintf(Code, sizeof(Code), "\\u%04x", static_cast<unsigned int>(c));
+                    Json.append(Code);
+                }
+                else
+                {
+                    Json.push_back(c);
+                }
+        }
+    }
+    Json.push_back('"');
+}
+
+// Chrome trace timestamps are in microseconds
+void AppendMicroseconds(std::string& Json, double Seconds)
+{
+    char Str[32];
+    snprintf(Str, sizeof(Str), "%.3f", Seconds * 1e+6);
+    Json.append(Str);
+}
+
+double TimestampToSeconds(const QueryDataTimestamp& Data)
+{
+    return static_cast<double>(Data.Counter) / static_cast<double>(Data.Frequency);
+}
+
+} // namespace
+
+constexpr Uint32 GPUProfiler::InvalidIndex;
+
+GPUProfiler::GPUProfiler(const CreateInfo& CI) :
+    m_pDevice{CI.pDevice},
+    m_ExpectedFrameLatency{CI.ExpectedFrameLatency}
+{
+    DEV_CHECK_ERR(m_pDevice, "Render device must not be null");
+    DEV_CHECK_ERR(m_pDevice->GetDeviceInfo().Features.TimestampQueries, "Timestamp queries are not supported by this device");
+
+    m_AvailableQueries.reserve(CI.NumQueriesToReserve);
+    for (Uint32 i = 0; i < CI.NumQueriesToReserve; ++i)
+    {
+        QueryDesc queryDesc{QUERY_TYPE_TIMESTAMP};
+        queryDesc.Name = "GPU profiler timestamp query";
+
+        RefCntAutoPtr<IQuery> pQuery;
+        m_pDevice->CreateQuery(queryDesc, &pQuery);
+        VERIFY(pQuery, "Failed to create timestamp query");
+        m_AvailableQueries.emplace_back(std::move(pQuery));
+    }
+
+    if (CI.pCalibrationCtx != nullptr)
+        Calibrate(CI.pCalibrationCtx);
+}
+
+GPUProfiler::~GPUProfiler()
+{
+    DEV_CHECK_ERR(!m_FrameActive, "Destroying GPU profiler with an active frame");
+}
+
+RefCntAutoPtr<IQuery> GPUProfiler::AcquireQuery()
+{
+    if (!m_AvailableQueries.empty())
+    {
+        auto pQuery = std::move(m_AvailableQueries.back());
+        m_AvailableQueries.pop_back();
+        return pQuery;
+    }
+
+    QueryDesc queryDesc{QUERY_TYPE_TIMESTAMP};
+    queryDesc.Name = "GPU profiler timestamp query";
+
+    RefCntAutoPtr<IQuery> pQuery;
+    m_pDevice->CreateQuery(queryDesc, &pQuery);
+    VERIFY(pQuery, "Failed to create timestamp query");
+    return pQuery;
+}
+
+void GPUProfiler::ReleaseQuery(RefCntAutoPtr<IQuery>&& pQuery)
+{
+    if (pQuery)
+        m_AvailableQueries.emplace_back(std::move(pQuery));
+}
+
+bool GPUProfiler::Calibrate(IDeviceContext* pImmediateCtx)
+{
+    DEV_CHECK_ERR(pImmediateCtx != nullptr && !pImmediateCtx->GetDesc().IsDeferred, "Calibration requires an immediate context");
+
+    RefCntAutoPtr<IQuery> pQuery;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        pQuery = AcquireQuery();
+    }
+    if (!pQuery)
+        return false;
+
+    // Idle the GPU first so that the timestamp is executed as soon as it is submitted
+    pImmediateCtx->WaitForIdle();
+    pImmediateCtx->EndQuery(pQuery);
+    const double CPUStartTime = GetCPUTime();
+    pImmediateCtx->Flush();
+    pImmediateCtx->WaitForIdle();
+    const double CPUEndTime = GetCPUTime();
+
+    QueryDataTimestamp Data;
+    bool               DataAvailable = false;
+    // Even after the context is idle, some backends (e.g. OpenGL) may not make the
+    // data available immediately.
+    for (Uint32 i = 0; i < 1000 && !DataAvailable; ++i)
+        DataAvailable = pQuery->GetData(&Data, sizeof(Data));
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    ReleaseQuery(std::move(pQuery));
+
+    if (!DataAvailable || Data.Frequency == 0)
+    {
+        LOG_WARNING_MESSAGE("Failed to calibrate GPU profiler: calibration timestamp is not available");
+        return false;
+    }
+
+    // The timestamp was executed somewhere between the flush and the end of the wait
+    m_CalibrationOffset = (CPUStartTime + CPUEndTime) * 0.5 - TimestampToSeconds(Data);
+    m_IsCalibrated      = true;
+    return true;
+}
+
+void GPUProfiler::BeginFrame()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    DEV_CHECK_ERR(!m_FrameActive, "BeginFrame() must be matched by EndFrame()");
+
+    m_CurrentFrame.FrameNumber  = m_NextFrameNumber++;
+    m_CurrentFrame.CPUBeginTime = GetCPUTime();
+    m_CurrentFrame.Scopes.clear();
+    m_FrameActive = true;
+}
+
+void GPUProfiler::BeginScope(IDeviceContext* pCtx, const Char* Name)
+{
+    DEV_CHECK_ERR(pCtx != nullptr && Name != nullptr, "Context and name must not be null");
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    if (!m_FrameActive)
+    {
+        DEV_ERROR("Profiling scope '", Name, "' is begun outside of a frame");
+        return;
+    }
+
+    auto CtxIt = m_Contexts.find(pCtx);
+    if (CtxIt == m_Contexts.end())
+    {
+        const auto& CtxDesc = pCtx->GetDesc();
+
+        std::string CtxName = CtxDesc.Name != nullptr ? CtxDesc.Name : "Context";
+        if (CtxDesc.IsDeferred)
+            CtxName += " (deferred)";
+        CtxName += " #" + std::to_string(m_ContextNames.size());
+
+        ContextState State;
+        State.Index = static_cast<Uint32>(m_ContextNames.size());
+        m_ContextNames.emplace_back(std::move(CtxName));
+
+        CtxIt = m_Contexts.emplace(pCtx, std::move(State)).first;
+    }
+    auto& CtxState = CtxIt->second;
+
+    PendingScope NewScope;
+    NewScope.Name         = Name;
+    NewScope.ContextIndex = CtxState.Index;
+    NewScope.Depth        = static_cast<Uint32>(CtxState.ScopeStack.size());
+    NewScope.ParentIndex  = !CtxState.ScopeStack.empty() ? CtxState.ScopeStack.back() : InvalidIndex;
+    NewScope.pBeginQuery  = AcquireQuery();
+    if (!NewScope.pBeginQuery)
+        return;
+
+    pCtx->EndQuery(NewScope.pBeginQuery);
+
+    CtxState.ScopeStack.push_back(static_cast<Uint32>(m_CurrentFrame.Scopes.size()));
+    m_CurrentFrame.Scopes.emplace_back(std::move(NewScope));
+}
+
+void GPUProfiler::EndScope(IDeviceContext* pCtx)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    if (!m_FrameActive)
+        return;
+
+    auto CtxIt = m_Contexts.find(pCtx);
+    if (CtxIt == m_Contexts.end() || CtxIt->second.ScopeStack.empty())
+    {
+        DEV_ERROR("There are no open profiling scopes in this context, which likely indicates inconsistent BeginScope()/EndScope() calls");
+        return;
+    }
+    auto& ScopeStack = CtxIt->second.ScopeStack;
+
+    auto& Scope = m_CurrentFrame.Scopes[ScopeStack.back()];
+    ScopeStack.pop_back();
+
+    Scope.pEndQuery = AcquireQuery();
+    if (Scope.pEndQuery)
+        pCtx->EndQuery(Scope.pEndQuery);
+}
+
+bool GPUProfiler::EndFrame()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    if (!m_FrameActive)
+    {
+        DEV_ERROR("EndFrame() must be preceded by BeginFrame()");
+        return false;
+    }
+
+    for (auto& it : m_Contexts)
+    {
+        if (!it.second.ScopeStack.empty())
+        {
+            LOG_ERROR_MESSAGE("Context '", m_ContextNames[it.second.Index], "' has ", it.second.ScopeStack.size(),
+                              " profiling scope(s) that were not ended before EndFrame(). These scopes will be discarded.");
+            it.second.ScopeStack.clear();
+        }
+    }
+
+    m_CurrentFrame.CPUEndTime = GetCPUTime();
+    m_PendingFrames.emplace_back(std::move(m_CurrentFrame));
+    m_CurrentFrame = {};
+    m_FrameActive  = false;
+
+    if (m_PendingFrames.size() > m_ExpectedFrameLatency)
+    {
+        LOG_WARNING_MESSAGE("There are ", m_PendingFrames.size(), " frames pending readback which exceeds the specified expected latency (", m_ExpectedFrameLatency, ")");
+    }
+
+    bool Resolved = false;
+    while (!m_PendingFrames.empty() && ResolveFrame())
+        Resolved = true;
+
+    return Resolved;
+}
+
+bool GPUProfiler::ResolveFrame()
+{
+    auto& Frame = m_PendingFrames.front();
+
+    // Check that all queries of the frame are available. Query is not invalidated if pData is null.
+    for (auto& Scope : Frame.Scopes)
+    {
+        if (!Scope.pEndQuery)
+            continue;
+        if (!Scope.pEndQuery->GetData(nullptr, 0) || !Scope.pBeginQuery->GetData(nullptr, 0))
+            return false;
+    }
+
+    FrameData Resolved;
+    Resolved.FrameNumber  = Frame.FrameNumber;
+    Resolved.CPUBeginTime = Frame.CPUBeginTime;
+    Resolved.CPUEndTime   = Frame.CPUEndTime;
+    Resolved.Scopes.reserve(Frame.Scopes.size());
+
+    // Scopes that were not ended are discarded, so parent indices need to be remapped
+    std::vector<Uint32> ScopeRemap(Frame.Scopes.size(), InvalidIndex);
+
+    double MinGPUTime = 0;
+    for (size_t i = 0; i < Frame.Scopes.size(); ++i)
+    {
+        auto& Scope = Frame.Scopes[i];
+        if (!Scope.pEndQuery)
+            continue;
+
+        QueryDataTimestamp BeginData, EndData;
+        if (!Scope.pBeginQuery->GetData(&BeginData, sizeof(BeginData)) ||
+            !Scope.pEndQuery->GetData(&EndData, sizeof(EndData)) ||
+            BeginData.Frequency == 0 || EndData.Frequency == 0)
+            continue;
+
+        // A child of a discarded scope is attached to the closest resolved ancestor
+        Uint32 ParentIndex = Scope.ParentIndex;
+        while (ParentIndex != InvalidIndex && ScopeRemap[ParentIndex] == InvalidIndex)
+            ParentIndex = Frame.Scopes[ParentIndex].ParentIndex;
+
+        ScopeData Data;
+        Data.Name         = std::move(Scope.Name);
+        Data.ContextIndex = Scope.ContextIndex;
+        Data.ParentIndex  = ParentIndex != InvalidIndex ? ScopeRemap[ParentIndex] : InvalidIndex;
+        Data.Depth        = Data.ParentIndex != InvalidIndex ? Resolved.Scopes[Data.ParentIndex].Depth + 1 : 0;
+        Data.StartTime    = TimestampToSeconds(BeginData);
+        Data.EndTime      = std::max(TimestampToSeconds(EndData), Data.StartTime);
+
+        MinGPUTime = Resolved.Scopes.empty() ? Data.StartTime : std::min(MinGPUTime, Data.StartTime);
+
+        ScopeRemap[i] = static_cast<Uint32>(Resolved.Scopes.size());
+        Resolved.Scopes.emplace_back(std::move(Data));
+    }
+
+    const double Offset = m_IsCalibrated ? m_CalibrationOffset : Frame.CPUBeginTime - MinGPUTime;
+    for (auto& Scope : Resolved.Scopes)
+    {
+        Scope.StartTime += Offset;
+        Scope.EndTime += Offset;
+    }
+
+    for (auto& Scope : Frame.Scopes)
+    {
+        ReleaseQuery(std::move(Scope.pBeginQuery));
+        ReleaseQuery(std::move(Scope.pEndQuery));
+    }
+    m_PendingFrames.pop_front();
+
+    m_LastResolvedFrame = std::move(Resolved);
+    m_HasResolvedFrame  = true;
+
+    return true;
+}
+
+bool GPUProfiler::GetLastResolvedFrame(FrameData& Frame) const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    if (!m_HasResolvedFrame)
+        return false;
+
+    Frame = m_LastResolvedFrame;
+    return true;
+}
+
+std::vector<std::string> GPUProfiler::GetContextNames() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_ContextNames;
+}
+
+std::string GPUProfiler::GetChromeTrace() const
+{
+    std::string Json;
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    WriteChromeTrace(m_HasResolvedFrame ? m_LastResolvedFrame : FrameData{}, m_ContextNames, Json);
+    return Json;
+}
+
+void GPUProfiler::WriteChromeTrace(const FrameData& Frame, const std::vector<std::string>& ContextNames, std::string& Json)
+{
+    Json.append("{\"traceEvents\":[");
+
+    bool FirstEvent = true;
+
+    const auto BeginEvent = [&]() {
+        if (!FirstEvent)
+            Json.push_back(',');
+        Json.append("\n");
+        FirstEvent = false;
+    };
+
+    for (size_t i = 0; i < ContextNames.size(); ++i)
+    {
+        BeginEvent();
+        Json.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":");
+        Json.append(std::to_string(i));
+        Json.append(",\"args\":{\"name\":");
+        AppendEscapedJsonString(Json, ContextNames[i]);
+        Json.append("}}");
+    }
+
+    for (const auto& Scope : Frame.Scopes)
+    {
+        BeginEvent();
+        Json.append("{\"name\":");
+        AppendEscapedJsonString(Json, Scope.Name);
+        Json.append(",\"cat\":\"GPU\",\"ph\":\"X\",\"pid\":0,\"tid\":");
+        Json.append(std::to_string(Scope.ContextIndex));
+        Json.append(",\"ts\":");
+        AppendMicroseconds(Json, Scope.StartTime);
+        Json.append(",\"dur\":");
+        AppendMicroseconds(Json, Scope.EndTime - Scope.StartTime);
+        Json.append(",\"args\":{\"frame\":");
+        Json.append(std::to_string(Frame.FrameNumber));
+        Json.append("}}");
+    }
+
+    Json.append("\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+} // namespace Diligent
@@ -0,0 +1,534 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GeometryPreprocessing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "HashUtils.hpp"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+inline float3 GetPosition(const void* pPositions, Uint32 Stride, Uint32 Index)
+{
+    float3 Pos;
+    std::memcpy(&Pos, static_cast<const Uint8*>(pPositions) + size_t{Stride} * Index, sizeof(Pos));
+    return Pos;
+}
+
+// Returns the number of chunks the elements are split into by ProcessInParallel()
+inline Uint32 GetNumChunks(IThreadPool* pThreadPool, Uint32 NumElements, Uint32 ElementsPerTask)
+{
+    ElementsPerTask = std::max(ElementsPerTask, 1u);
+    if (pThreadPool == nullptr || NumElements <= ElementsPerTask)
+        return 1;
+    return (NumElements + ElementsPerTask - 1) / ElementsPerTask;
+}
+
+// Splits the range [0, NumElements) into chunks of ElementsPerTask elements and calls
+// Handler(Chunk, First, End) for every chunk. The last chunk is processed by the calling thread.
+template <typename HandlerType>
+void ProcessInParallel(IThreadPool* pThreadPool, Uint32 NumElements, Uint32 ElementsPerTask, const HandlerType& Handler)
+{
+    ElementsPerTask        = std::max(ElementsPerTask, 1u);
+    const Uint32 NumChunks = GetNumChunks(pThreadPool, NumElements, ElementsPerTask);
+    if (NumChunks == 1)
+    {
+        Handler(0u, 0u, NumElements);
+        return;
+    }
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+    Tasks.reserve(NumChunks - 1);
+    for (Uint32 Chunk = 0; Chunk < NumChunks - 1; ++Chunk)
+    {
+        const Uint32 First = Chunk * ElementsPerTask;
+        Tasks.emplace_back(EnqueueAsyncWork(pThreadPool,
+                                            [&Handler, Chunk, First, ElementsPerTask](Uint32 /*ThreadId*/) {
+                                                Handler(Chunk, First, First + ElementsPerTask);
+                                            }));
+    }
+
+    Handler(NumChunks - 1, (NumChunks - 1) * ElementsPerTask, NumElements);
+
+    for (auto& pTask : Tasks)
+        pTask->WaitForCompletion();
+}
+
+// Vertex score of the Forsyth's algorithm
+float ComputeVertexScore(int CachePos, Uint32 NumActiveTris, Uint32 CacheSize)
+{
+    if (NumActiveTris == 0)
+        return -1.f; // The vertex is not used by any remaining triangle
+
+    float Score = 0;
+    if (CachePos >= 0)
+    {
+        if (CachePos < 3)
+        {
+            // The vertices of the last triangle get a fixed score, so that the next
+            // triangle does not depend on the order of the vertices in the last one
+            Score = 0.75f;
+        }
+        else
+        {
+            const float Scale = 1.f / static_cast<float>(CacheSize - 3);
+            Score             = std::pow(1.f - static_cast<float>(CachePos - 3) * Scale, 1.5f);
+        }
+    }
+
+    // Vertices with few remaining triangles are preferred to avoid leaving lone triangles behind
+    Score += 2.f / std::sqrt(static_cast<float>(NumActiveTris));
+    return Score;
+}
+
+static constexpr Uint32 MaxCacheSize = 64;
+
+void OptimizeVertexCacheChunk(Uint32* pIndices, Uint32 NumTris, Uint32 CacheSize)
+{
+    const Uint32 NumIndices = NumTris * 3;
+
+    // Compact the vertices referenced by the chunk
+    std::vector<Uint32> Vertices{pIndices, pIndices + NumIndices};
+    std::sort(Vertices.begin(), Vertices.end());
+    Vertices.erase(std::unique(Vertices.begin(), Vertices.end()), Vertices.end());
+    const Uint32 NumVerts = static_cast<Uint32>(Vertices.size());
+
+    std::vector<Uint32> Local(NumIndices);
+    for (Uint32 i = 0; i < NumIndices; ++i)
+        Local[i] = static_cast<Uint32>(std::lower_bound(Vertices.begin(), Vertices.end(), pIndices[i]) - Vertices.begin());
+
+    // Triangles adjacent to every vertex. The active triangles of vertex v are
+    // AdjTris[AdjOffsets[v]] ... AdjTris[AdjOffsets[v] + NumActiveTris[v] - 1].
+    std::vector<Uint32> NumActiveTris(NumVerts);
+    for (Uint32 i = 0; i < NumIndices; ++i)
+        ++NumActiveTris[Local[i]];
+
+    std::vector<Uint32> AdjOffsets(NumVerts + 1);
+    for (Uint32 v = 0; v < NumVerts; ++v)
+        AdjOffsets[v + 1] = AdjOffsets[v] + NumActiveTris[v];
+
+    std::vector<Uint32> AdjTris(NumIndices);
+    {
+        std::vector<Uint32> Fill{AdjOffsets.begin(), AdjOffsets.end() - 1};
+        for (Uint32 i = 0; i < NumIndices; ++i)
+            AdjTris[Fill[Local[i]]++] = i / 3;
+    }
+
+    std::vector<int>   CachePos(NumVerts, -1);
+    std::vector<float> VertScores(NumVerts);
+    for (Uint32 v = 0; v < NumVerts; ++v)
+        VertScores[v] = ComputeVertexScore(-1, NumActiveTris[v], CacheSize);
+
+    auto ComputeTriScore = [&](Uint32 Tri) {
+        return VertScores[Local[Tri * 3 + 0]] + VertScores[Local[Tri * 3 + 1]] + VertScores[Local[Tri * 3 + 2]];
+    };
+
+    std::vector<float> TriScores(NumTris);
+    std::vector<bool>  Emitted(NumTris);
+
+    Uint32 BestTri   = 0;
+    float  BestScore = -FLT_MAX;
+    for (Uint32 t = 0; t < NumTris; ++t)
+    {
+        TriScores[t] = ComputeTriScore(t);
+        if (TriScores[t] > BestScore)
+        {
+            BestScore = TriScores[t];
+            BestTri   = t;
+        }
+    }
+
+    // The cache holds vertices of the emitted triangle plus the previous cache content
+    Uint32 Cache[MaxCacheSize + 3];
+    Uint32 NewCache[MaxCacheSize + 3];
+    Uint32 CacheCount = 0;
+
+    std::vector<Uint32> Output;
+    Output.reserve(NumIndices);
+
+    Uint32 Cursor = 0;
+    for (Uint32 NumEmitted = 0; NumEmitted < NumTris; ++NumEmitted)
+    {
+        if (BestTri == ~0u)
+        {
+            // No triangle is adjacent to the cache: take the next triangle in the original order
+            while (Emitted[Cursor])
+                ++Cursor;
+            BestTri = Cursor;
+        }
+        VERIFY_EXPR(!Emitted[BestTri]);
+
+        const Uint32* TriVerts = &Local[BestTri * 3];
+        Output.insert(Output.end(), pIndices + BestTri * 3, pIndices + BestTri * 3 + 3);
+        Emitted[BestTri] = true;
+
+        Uint32 NewCount = 0;
+        for (Uint32 i = 0; i < 3; ++i)
+        {
+            const Uint32 v = TriVerts[i];
+
+            // Remove the triangle from the active triangles of the vertex
+            Uint32*      pAdj  = &AdjTris[AdjOffsets[v]];
+            const Uint32 Count = NumActiveTris[v];
+            for (Uint32 a = 0; a < Count; ++a)
+            {
+                if (pAdj[a] == BestTri)
+                {
+                    std::swap(pAdj[a], pAdj[Count - 1]);
+                    --NumActiveTris[v];
+                    break;
+                }
+            }
+
+            if (std::find(NewCache, NewCache + NewCount, v) == NewCache + NewCount)
+                NewCache[NewCount++] = v;
+        }
+        for (Uint32 i = 0; i < CacheCount; ++i)
+        {
+            const Uint32 v = Cache[i];
+            if (v != TriVerts[0] && v != TriVerts[1] && v != TriVerts[2])
+                NewCache[NewCount++] = v;
+        }
+
+        // Vertices that do not fit into the cache are evicted
+        for (Uint32 i = 0; i < NewCount; ++i)
+            CachePos[NewCache[i]] = i < CacheSize ? static_cast<int>(i) : -1;
+
+        for (Uint32 i = 0; i < NewCount; ++i)
+        {
+            const Uint32 v = NewCache[i];
+            VertScores[v]  = ComputeVertexScore(CachePos[v], NumActiveTris[v], CacheSize);
+        }
+
+        // Update the scores of the triangles adjacent to the vertices whose score has changed,
+        // and select the best triangle among the ones that use the cached vertices
+        BestTri   = ~0u;
+        BestScore = -FLT_MAX;
+        for (Uint32 i = 0; i < NewCount; ++i)
+        {
+            const Uint32 v = NewCache[i];
+            for (Uint32 a = 0; a < NumActiveTris[v]; ++a)
+            {
+                const Uint32 Tri = AdjTris[AdjOffsets[v] + a];
+                TriScores[Tri]   = ComputeTriScore(Tri);
+                if (i < CacheSize && TriScores[Tri] > BestScore)
+                {
+                    BestScore = TriScores[Tri];
+                    BestTri   = Tri;
+                }
+            }
+        }
+
+        CacheCount = std::min(NewCount, CacheSize);
+        std::copy(NewCache, NewCache + CacheCount, Cache);
+    }
+
+    std::copy(Output.begin(), Output.end(), pIndices);
+}
+
+} // namespace
+
+bool ConvertIndicesToUint16(const Uint32* pSrcIndices,
+                            Uint32        NumIndices,
+                            Uint16*       pDstIndices,
+                            IThreadPool*  pThreadPool,
+                            Uint32        IndicesPerTask)
+{
+    DEV_CHECK_ERR(NumIndices == 0 || (pSrcIndices != nullptr && pDstIndices != nullptr), "Index data must not be null");
+
+    std::atomic<bool> Overflow{false};
+    ProcessInParallel(pThreadPool, NumIndices, IndicesPerTask,
+                      [&](Uint32 /*Chunk*/, Uint32 First, Uint32 End) {
+                          Uint32 MaxIndex = 0;
+                          for (Uint32 i = First; i < End; ++i)
+                          {
+                              const Uint32 Index = pSrcIndices[i];
+                              MaxIndex           = std::max(MaxIndex, Index);
+                              pDstIndices[i]     = static_cast<Uint16>(Index);
+                          }
+                          if (MaxIndex > 0xFFFFu)
+                              Overflow.store(true);
+                      });
+
+    return !Overflow.load();
+}
+
+Uint32 GenerateVertexWeldRemap(const void*  pVertices,
+                               Uint32       NumVertices,
+                               Uint32       VertexStride,
+                               Uint32*      pRemap,
+                               IThreadPool* pThreadPool,
+                               Uint32       VerticesPerTask)
+{
+    DEV_CHECK_ERR(NumVertices == 0 || (pVertices != nullptr && pRemap != nullptr), "Vertex data must not be null");
+    DEV_CHECK_ERR(VertexStride > 0, "Vertex stride must not be zero");
+    if (NumVertices == 0)
+        return 0;
+
+    const Uint8* pData = static_cast<const Uint8*>(pVertices);
+
+    // Hashing is the most expensive part and is done in parallel
+    std::vector<size_t> Hashes(NumVertices);
+    ProcessInParallel(pThreadPool, NumVertices, VerticesPerTask,
+                      [&](Uint32 /*Chunk*/, Uint32 First, Uint32 End) {
+                          for (Uint32 v = First; v < End; ++v)
+                              Hashes[v] = ComputeHashRaw(pData + size_t{VertexStride} * v, VertexStride);
+                      });
+
+    // Open addressing hash table with linear probing that stores the index of the first occurrence
+    size_t TableSize = 1;
+    while (TableSize < size_t{NumVertices} * 2)
+        TableSize *= 2;
+    const size_t        Mask = TableSize - 1;
+    std::vector<Uint32> Table(TableSize, ~0u);
+
+    Uint32 NumUnique = 0;
+    for (Uint32 v = 0; v < NumVertices; ++v)
+    {
+        const Uint8* pVert = pData + size_t{VertexStride} * v;
+        for (size_t Slot = Hashes[v] & Mask;; Slot = (Slot + 1) & Mask)
+        {
+            const Uint32 Other = Table[Slot];
+            if (Other == ~0u)
+            {
+                Table[Slot] = v;
+                pRemap[v]   = NumUnique++;
+                break;
+            }
+            if (Hashes[Other] == Hashes[v] && std::memcmp(pData + size_t{VertexStride} * Other, pVert, VertexStride) == 0)
+            {
+                pRemap[v] = pRemap[Other];
+                break;
+            }
+        }
+    }
+
+    return NumUnique;
+}
+
+Uint32 GenerateVertexFetchRemap(const Uint32* pIndices,
+                                Uint32        NumIndices,
+                                Uint32        NumVertices,
+                                Uint32*       pRemap) noexcept(false)
+{
+    if (pIndices == nullptr && NumIndices != 0)
+        LOG_ERROR_AND_THROW("Index data must not be null");
+    if (pRemap == nullptr && NumVertices != 0)
+        LOG_ERROR_AND_THROW("Remap table must not be null");
+
+    std::fill(pRemap, pRemap + NumVertices, ~0u);
+
+    Uint32 NumUsed = 0;
+    for (Uint32 i = 0; i < NumIndices; ++i)
+    {
+        const Uint32 Index = pIndices[i];
+        if (Index >= NumVertices)
+            LOG_ERROR_AND_THROW("Index ", Index, " at position ", i, " is out of range [0, ", NumVertices, ")");
+        if (pRemap[Index] == ~0u)
+            pRemap[Index] = NumUsed++;
+    }
+
+    return NumUsed;
+}
+
+void RemapIndices(const Uint32* pIndices,
+                  Uint32        NumIndices,
+                  const Uint32* pRemap,
+                  Uint32*       pDstIndices,
+                  IThreadPool*  pThreadPool,
+                  Uint32        IndicesPerTask)
+{
+    DEV_CHECK_ERR(NumIndices == 0 || (pIndices != nullptr && pRemap != nullptr && pDstIndices != nullptr), "Index data must not be null");
+
+    ProcessInParallel(pThreadPool, NumIndices, IndicesPerTask,
+                      [&](Uint32 /*Chunk*/, Uint32 First, Uint32 End) {
+                          for (Uint32 i = First; i < End; ++i)
+                              pDstIndices[i] = pRemap[pIndices[i]];
+                      });
+}
+
+void RemapVertices(const void*   pVertices,
+                   Uint32        NumVertices,
+                   Uint32        VertexStride,
+                   const Uint32* pRemap,
+                   void*         pDstVertices,
+                   IThreadPool*  pThreadPool,
+                   Uint32        VerticesPerTask)
+{
+    DEV_CHECK_ERR(NumVertices == 0 || (pVertices != nullptr && pRemap != nullptr && pDstVertices != nullptr), "Vertex data must not be null");
+    DEV_CHECK_ERR(pVertices != pDstVertices || NumVertices == 0, "Source and destination vertex buffers must not alias");
+
+    // Find the source of every destination vertex, so that every destination is written exactly once
+    std::vector<Uint32> Sources;
+    for (Uint32 v = 0; v < NumVertices; ++v)
+    {
+        const Uint32 Dst = pRemap[v];
+        if (Dst == ~0u)
+            continue;
+        if (Dst >= Sources.size())
+            Sources.resize(size_t{Dst} + 1, ~0u);
+        if (Sources[Dst] == ~0u)
+            Sources[Dst] = v;
+    }
+
+    const Uint8* pSrc = static_cast<const Uint8*>(pVertices);
+    Uint8*       pDst = static_cast<Uint8*>(pDstVertices);
+    ProcessInParallel(pThreadPool, static_cast<Uint32>(Sources.size()), VerticesPerTask,
+                      [&](Uint32 /*Chunk*/, Uint32 First, Uint32 End) {
+                          for (Uint32 v = First; v < End; ++v)
+                          {
+                              if (Sources[v] != ~0u)
+                                  std::memcpy(pDst + size_t{VertexStride} * v, pSrc + size_t{VertexStride} * Sources[v], VertexStride);
+                          }
+                      });
+}
+
+void OptimizeVertexCache(const VertexCacheOptimizationAttribs& Attribs) noexcept(false)
+{
+    if (Attribs.pIndices == nullptr && Attribs.NumIndices != 0)
+        LOG_ERROR_AND_THROW("Index data must not be null");
+    if (Attribs.NumIndices % 3 != 0)
+        LOG_ERROR_AND_THROW("The number of indices (", Attribs.NumIndices, ") must be a multiple of 3");
+    if (Attribs.CacheSize < 4 || Attribs.CacheSize > MaxCacheSize)
+        LOG_ERROR_AND_THROW("Cache size (", Attribs.CacheSize, ") must be in the range [4, ", MaxCacheSize, "]");
+    if (Attribs.pThreadPool != nullptr && Attribs.TrianglesPerTask == 0)
+        LOG_ERROR_AND_THROW("The number of triangles per task must not be zero");
+
+    for (Uint32 i = 0; i < Attribs.NumIndices; ++i)
+    {
+        if (Attribs.pIndices[i] >= Attribs.NumVertices)
+            LOG_ERROR_AND_THROW("Index ", Attribs.pIndices[i], " at position ", i, " is out of range [0, ", Attribs.NumVertices, ")");
+    }
+
+    const Uint32 NumTriangles = Attribs.NumIndices / 3;
+    if (NumTriangles == 0)
+        return;
+
+    ProcessInParallel(Attribs.pThreadPool, NumTriangles, Attribs.TrianglesPerTask,
+                      [&Attribs](Uint32 /*Chunk*/, Uint32 FirstTri, Uint32 EndTri) {
+                          OptimizeVertexCacheChunk(Attribs.pIndices + size_t{FirstTri} * 3, EndTri - FirstTri, Attribs.CacheSize);
+                      });
+}
+
+float ComputeVertexCacheACMR(const Uint32* pIndices, Uint32 NumIndices, Uint32 NumVertices, Uint32 CacheSize)
+{
+    const Uint32 NumTriangles = NumIndices / 3;
+    if (NumTriangles == 0)
+        return 0;
+
+    // A vertex is in the FIFO cache if fewer than CacheSize misses happened since it was loaded
+    std::vector<Uint32> LoadTime(NumVertices, 0);
+
+    Uint32 Time   = CacheSize + 1;
+    Uint32 Misses = 0;
+    for (Uint32 i = 0; i < NumTriangles * 3; ++i)
+    {
+        const Uint32 v = pIndices[i];
+        VERIFY_EXPR(v < NumVertices);
+        if (Time - LoadTime[v] > CacheSize)
+        {
+            LoadTime[v] = Time++;
+            ++Misses;
+        }
+    }
+
+    return static_cast<float>(Misses) / static_cast<float>(NumTriangles);
+}
+
+BoundBox ComputeBoundingBox(const void*  pPositions,
+                            Uint32       NumVertices,
+                            Uint32       PositionStride,
+                            IThreadPool* pThreadPool,
+                            Uint32       VerticesPerTask)
+{
+    DEV_CHECK_ERR(NumVertices == 0 || pPositions != nullptr, "Position data must not be null");
+
+    BoundBox EmptyBox;
+    EmptyBox.Min = float3{+FLT_MAX, +FLT_MAX, +FLT_MAX};
+    EmptyBox.Max = float3{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+    // Every chunk computes its own box, the boxes are merged at the end
+    std::vector<BoundBox> ChunkBoxes(GetNumChunks(pThreadPool, NumVertices, VerticesPerTask), EmptyBox);
+    ProcessInParallel(pThreadPool, NumVertices, VerticesPerTask,
+                      [&](Uint32 Chunk, Uint32 First, Uint32 End) {
+                          BoundBox Box = EmptyBox;
+                          for (Uint32 v = First; v < End; ++v)
+                          {
+                              const auto Pos = GetPosition(pPositions, PositionStride, v);
+                              Box.Min        = min(Box.Min, Pos);
+                              Box.Max        = max(Box.Max, Pos);
+                          }
+                          ChunkBoxes[Chunk] = Box;
+                      });
+
+    BoundBox Box = EmptyBox;
+    for (const auto& ChunkBox : ChunkBoxes)
+    {
+        Box.Min = min(Box.Min, ChunkBox.Min);
+        Box.Max = max(Box.Max, ChunkBox.Max);
+    }
+    return Box;
+}
+
+void ComputeTriangleBoundingBoxes(const Uint32* pIndices,
+                                  Uint32        NumIndices,
+                                  const void*   pPositions,
+                                  Uint32        PositionStride,
+                                  BoundBox*     pBoxes,
+                                  IThreadPool*  pThreadPool,
+                                  Uint32        TrianglesPerTask)
+{
+    DEV_CHECK_ERR(NumIndices % 3 == 0, "The number of indices (", NumIndices, ") must be a multiple of 3");
+    DEV_CHECK_ERR(NumIndices == 0 || (pIndices != nullptr && pPositions != nullptr && pBoxes != nullptr), "Geometry data must not be null");
+
+    ProcessInParallel(pThreadPool, NumIndices / 3, TrianglesPerTask,
+                      [&](Uint32 /*Chunk*/, Uint32 FirstTri, Uint32 EndTri) {
+                          for (Uint32 Tri = FirstTri; Tri < EndTri; ++Tri)
+                          {
+                              const auto P0 = GetPosition(pPositions, PositionStride, pIndices[Tri * 3 + 0]);
+                              const auto P1 = GetPosition(pPositions, PositionStride, pIndices[Tri * 3 + 1]);
+                              const auto P2 = GetPosition(pPositions, PositionStride, pIndices[Tri * 3 + 2]);
+
+                              pBoxes[Tri].Min = min(min(P0, P1), P2);
+                              pBoxes[Tri].Max = max(max(P0, P1), P2);
+                          }
+                      });
+}
+
+} // namespace Diligent
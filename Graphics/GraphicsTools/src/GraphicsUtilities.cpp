@@ -26,13 +26,18 @@
  */
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <limits>
+#include <vector>
 
 #include "GraphicsUtilities.h"
 #include "DebugUtilities.hpp"
 #include "GraphicsAccessories.hpp"
 #include "ColorConversion.h"
+#include "Intrinsics.hpp"
+#include "Align.hpp"
+#include "ThreadPool.hpp"
 
 #define PI_F 3.1415926f
 
@@ -133,28 +138,82 @@ void GenerateCheckerBoardPattern(Uint32 Width, Uint32 Height, TEXTURE_FORMAT Fmt
 
 
 
-template <typename ChannelType>
-ChannelType SRGBAverage(ChannelType c0, ChannelType c1, ChannelType c2, ChannelType c3, Uint32 /*col*/, Uint32 /*row*/)
+namespace
+{
+
+// Lookup tables that convert 8-bit sRGB values to linear space and back
+class SRGB8ConversionTables
 {
-    static_assert(std::numeric_limits<ChannelType>::is_integer && !std::numeric_limits<ChannelType>::is_signed, "Unsigned integers are expected");
+public:
+    static const SRGB8ConversionTables& Get()
+    {
+        static const SRGB8ConversionTables Tables;
+        return Tables;
+    }
+
+    float ToLinear(Uint8 x) const
+    {
+        return m_ToLinear[x];
+    }
 
-    static constexpr float MaxVal    = static_cast<float>(std::numeric_limits<ChannelType>::max());
-    static constexpr float MaxValInv = 1.f / MaxVal;
+    // Returns the 8-bit sRGB value that is closest to the linear value x
+    Uint8 ToSRGB(float x) const
+    {
+        x = std::min(std::max(x, 0.f), 1.f);
 
-    float fc0 = static_cast<float>(c0) * MaxValInv;
-    float fc1 = static_cast<float>(c1) * MaxValInv;
-    float fc2 = static_cast<float>(c2) * MaxValInv;
-    float fc3 = static_cast<float>(c3) * MaxValInv;
+        const auto Bucket = std::min(static_cast<Uint32>(x * static_cast<float>(NumBuckets)), NumBuckets - 1);
 
-    float fLinearAverage = (FastSRGBToLinear(fc0) + FastSRGBToLinear(fc1) + FastSRGBToLinear(fc2) + FastSRGBToLinear(fc3)) * 0.25f;
-    float fSRGBAverage   = FastLinearToSRGB(fLinearAverage) * MaxVal;
+        Uint32 Val = m_BucketStart[Bucket];
+        while (Val < 255 && m_Thresholds[Val] <= x)
+            ++Val;
 
-    // Clamping on both ends is essential because fast SRGB math is imprecise
-    fSRGBAverage = std::max(fSRGBAverage, 0.f);
-    fSRGBAverage = std::min(fSRGBAverage, MaxVal);
+        return static_cast<Uint8>(Val);
+    }
 
-    return static_cast<ChannelType>(fSRGBAverage);
-}
+private:
+    SRGB8ConversionTables() noexcept
+    {
+        for (Uint32 i = 0; i < 256; ++i)
+            m_ToLinear[i] = SRGBToLinear(static_cast<float>(i) / 255.f);
+
+        // Linear value above which rounding of the sRGB value gives i + 1 rather than i
+        for (Uint32 i = 0; i < 255; ++i)
+        {
+            const double SRGB = (static_cast<double>(i) + 0.5) / 255.0;
+            m_Thresholds[i]   = static_cast<float>(SRGB <= 0.04045 ? SRGB / 12.92 : std::pow((SRGB + 0.055) / 1.055, 2.4));
+        }
+
+        // Every bucket stores the sRGB value of its lower bound, so that ToSRGB()
+        // only needs to advance by a few thresholds to find the closest value.
+        Uint32 Val = 0;
+        for (Uint32 b = 0; b < NumBuckets; ++b)
+        {
+            const float x = static_cast<float>(b) / static_cast<float>(NumBuckets);
+            while (Val < 255 && m_Thresholds[Val] <= x)
+                ++Val;
+            m_BucketStart[b] = static_cast<Uint8>(Val);
+        }
+    }
+
+    static constexpr Uint32 NumBuckets = 1024;
+
+    std::array<float, 256>        m_ToLinear{};
+    std::array<float, 255>        m_Thresholds{};
+    std::array<Uint8, NumBuckets> m_BucketStart{};
+};
+
+struct SRGB8Average
+{
+    const SRGB8ConversionTables& Tables = SRGB8ConversionTables::Get();
+
+    Uint8 operator()(Uint8 c0, Uint8 c1, Uint8 c2, Uint8 c3, Uint32 /*col*/, Uint32 /*row*/) const
+    {
+        const float fLinearAverage = (Tables.ToLinear(c0) + Tables.ToLinear(c1) + Tables.ToLinear(c2) + Tables.ToLinear(c3)) * 0.25f;
+        return Tables.ToSRGB(fLinearAverage);
+    }
+};
+
+} // namespace
 
 template <typename ChannelType>
 ChannelType LinearAverage(ChannelType c0, ChannelType c1, ChannelType c2, ChannelType c3, Uint32 /*col*/, Uint32 /*row*/);
@@ -324,6 +383,157 @@ void FilterMipLevel(const ComputeMipLevelAttribs& Attribs,
     }
 }
 
+namespace
+{
+
+#if DILIGENT_SSE2_ENABLED
+// Computes the 2x2 box average of RGBA8 texels. The fine row must contain at least 2 * NumTexels texels.
+void BoxAverageRowRGBA8SSE2(const Uint8* pSrcRow0, const Uint8* pSrcRow1, Uint8* pDstRow, Uint32 NumTexels)
+{
+    const auto Zero = _mm_setzero_si128();
+
+    Uint32 x = 0;
+    for (; x + 2 <= NumTexels; x += 2)
+    {
+        // Four fine texels of each row produce two coarse texels
+        const auto Row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrcRow0 + x * 8));
+        const auto Row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrcRow1 + x * 8));
+
+        // | t0 | t1 | and | t2 | t3 |, every channel summed over the two rows as 16-bit value
+        const auto Sum01 = _mm_add_epi16(_mm_unpacklo_epi8(Row0, Zero), _mm_unpacklo_epi8(Row1, Zero));
+        const auto Sum23 = _mm_add_epi16(_mm_unpackhi_epi8(Row0, Zero), _mm_unpackhi_epi8(Row1, Zero));
+
+        // | t0 + t1 | t2 + t3 |
+        const auto Sum = _mm_add_epi16(_mm_unpacklo_epi64(Sum01, Sum23), _mm_unpackhi_epi64(Sum01, Sum23));
+        const auto Avg = _mm_srli_epi16(Sum, 2);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pDstRow + x * 4), _mm_packus_epi16(Avg, Avg));
+    }
+
+    for (; x < NumTexels; ++x)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            pDstRow[x * 4 + c] = LinearAverage<Uint8>(pSrcRow0[x * 8 + c], pSrcRow0[x * 8 + 4 + c],
+                                                      pSrcRow1[x * 8 + c], pSrcRow1[x * 8 + 4 + c], 0, 0);
+        }
+    }
+}
+
+void BoxAverageRowRGBA32FSSE2(const float* pSrcRow0, const float* pSrcRow1, float* pDstRow, Uint32 NumTexels)
+{
+    const auto Quarter = _mm_set1_ps(0.25f);
+    for (Uint32 x = 0; x < NumTexels; ++x)
+    {
+        // Add the texels in the same order as LinearAverage to produce identical results
+        auto Sum = _mm_add_ps(_mm_loadu_ps(pSrcRow0 + x * 8), _mm_loadu_ps(pSrcRow0 + x * 8 + 4));
+        Sum      = _mm_add_ps(Sum, _mm_loadu_ps(pSrcRow1 + x * 8));
+        Sum      = _mm_add_ps(Sum, _mm_loadu_ps(pSrcRow1 + x * 8 + 4));
+        _mm_storeu_ps(pDstRow + x * 4, _mm_mul_ps(Sum, Quarter));
+    }
+}
+#endif
+
+#if DILIGENT_NEON_ENABLED
+void BoxAverageRowRGBA8NEON(const Uint8* pSrcRow0, const Uint8* pSrcRow1, Uint8* pDstRow, Uint32 NumTexels)
+{
+    Uint32 x = 0;
+    for (; x + 2 <= NumTexels; x += 2)
+    {
+        const auto Row0 = vld1q_u8(pSrcRow0 + x * 8);
+        const auto Row1 = vld1q_u8(pSrcRow1 + x * 8);
+
+        // | t0 | t1 | and | t2 | t3 |, every channel summed over the two rows as 16-bit value
+        const auto Sum01 = vaddl_u8(vget_low_u8(Row0), vget_low_u8(Row1));
+        const auto Sum23 = vaddl_u8(vget_high_u8(Row0), vget_high_u8(Row1));
+
+        // | t0 + t1 | t2 + t3 |
+        const auto Sum = vcombine_u16(vadd_u16(vget_low_u16(Sum01), vget_high_u16(Sum01)),
+                                      vadd_u16(vget_low_u16(Sum23), vget_high_u16(Sum23)));
+        vst1_u8(pDstRow + x * 4, vshrn_n_u16(Sum, 2));
+    }
+
+    for (; x < NumTexels; ++x)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            pDstRow[x * 4 + c] = LinearAverage<Uint8>(pSrcRow0[x * 8 + c], pSrcRow0[x * 8 + 4 + c],
+                                                      pSrcRow1[x * 8 + c], pSrcRow1[x * 8 + 4 + c], 0, 0);
+        }
+    }
+}
+
+void BoxAverageRowRGBA32FNEON(const float* pSrcRow0, const float* pSrcRow1, float* pDstRow, Uint32 NumTexels)
+{
+    for (Uint32 x = 0; x < NumTexels; ++x)
+    {
+        // Add the texels in the same order as LinearAverage to produce identical results
+        auto Sum = vaddq_f32(vld1q_f32(pSrcRow0 + x * 8), vld1q_f32(pSrcRow0 + x * 8 + 4));
+        Sum      = vaddq_f32(Sum, vld1q_f32(pSrcRow1 + x * 8));
+        Sum      = vaddq_f32(Sum, vld1q_f32(pSrcRow1 + x * 8 + 4));
+        vst1q_f32(pDstRow + x * 4, vmulq_n_f32(Sum, 0.25f));
+    }
+}
+#endif
+
+// Filters the mip level of a 4-channel texture using the kernel that processes one coarse row at a time
+template <typename ChannelType, typename RowKernelType>
+void FilterMipLevelRows(const ComputeMipLevelAttribs& Attribs,
+                        RowKernelType                 RowKernel)
+{
+    VERIFY_EXPR(Attribs.FineMipWidth >= 2 && Attribs.FineMipHeight > 0);
+    DEV_CHECK_ERR(Attribs.FineMipHeight == 1 || Attribs.FineMipStride >= Attribs.FineMipWidth * sizeof(ChannelType) * 4, "Fine mip level stride is too small");
+
+    const auto CoarseMipWidth  = Attribs.FineMipWidth / Uint32{2};
+    const auto CoarseMipHeight = std::max(Attribs.FineMipHeight / Uint32{2}, Uint32{1});
+
+    VERIFY(CoarseMipHeight == 1 || Attribs.CoarseMipStride >= CoarseMipWidth * sizeof(ChannelType) * 4, "Coarse mip level stride is too small");
+    for (Uint32 row = 0; row < CoarseMipHeight; ++row)
+    {
+        const auto src_row0 = row * 2;
+        const auto src_row1 = std::min(row * 2 + 1, Attribs.FineMipHeight - 1);
+
+        const auto* pSrcRow0 = reinterpret_cast<const ChannelType*>(reinterpret_cast<const Uint8*>(Attribs.pFineMipData) + src_row0 * Attribs.FineMipStride);
+        const auto* pSrcRow1 = reinterpret_cast<const ChannelType*>(reinterpret_cast<const Uint8*>(Attribs.pFineMipData) + src_row1 * Attribs.FineMipStride);
+        auto*       pDstRow  = reinterpret_cast<ChannelType*>(reinterpret_cast<Uint8*>(Attribs.pCoarseMipData) + row * Attribs.CoarseMipStride);
+
+        RowKernel(pSrcRow0, pSrcRow1, pDstRow, CoarseMipWidth);
+    }
+}
+
+// Computes the box average of 4-channel textures using SIMD instructions.
+// Returns false if there is no fast path for the channel type on this platform.
+template <typename ChannelType>
+bool BoxAverageRGBAFast(const ComputeMipLevelAttribs& /*Attribs*/)
+{
+    return false;
+}
+
+#if DILIGENT_SSE2_ENABLED || DILIGENT_NEON_ENABLED
+template <>
+bool BoxAverageRGBAFast<Uint8>(const ComputeMipLevelAttribs& Attribs)
+{
+#    if DILIGENT_SSE2_ENABLED
+    FilterMipLevelRows<Uint8>(Attribs, BoxAverageRowRGBA8SSE2);
+#    else
+    FilterMipLevelRows<Uint8>(Attribs, BoxAverageRowRGBA8NEON);
+#    endif
+    return true;
+}
+
+template <>
+bool BoxAverageRGBAFast<float>(const ComputeMipLevelAttribs& Attribs)
+{
+#    if DILIGENT_SSE2_ENABLED
+    FilterMipLevelRows<float>(Attribs, BoxAverageRowRGBA32FSSE2);
+#    else
+    FilterMipLevelRows<float>(Attribs, BoxAverageRowRGBA32FNEON);
+#    endif
+    return true;
+}
+#endif
+
+} // namespace
+
 void RemapAlpha(const ComputeMipLevelAttribs& Attribs,
                 Uint32                        NumChannels,
                 Uint32                        AlphaChannelInd)
@@ -361,6 +571,12 @@ void ComputeMipLevelInternal(const ComputeMipLevelAttribs& Attribs,
             MIP_FILTER_TYPE_BOX_AVERAGE;
     }
 
+    if (FilterType == MIP_FILTER_TYPE_BOX_AVERAGE && FmtAttribs.NumComponents == 4 && Attribs.FineMipWidth >= 2)
+    {
+        if (BoxAverageRGBAFast<ChannelType>(Attribs))
+            return;
+    }
+
     FilterMipLevel<ChannelType>(Attribs, FmtAttribs.NumComponents,
                                 FilterType == MIP_FILTER_TYPE_BOX_AVERAGE ?
                                     LinearAverage<ChannelType> :
@@ -385,10 +601,10 @@ void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
     {
         case COMPONENT_TYPE_UNORM_SRGB:
             VERIFY(FmtAttribs.ComponentSize == 1, "Only 8-bit sRGB formats are expected");
-            FilterMipLevel<Uint8>(Attribs, FmtAttribs.NumComponents,
-                                  Attribs.FilterType == MIP_FILTER_TYPE_MOST_FREQUENT ?
-                                      MostFrequentSelector<Uint8> :
-                                      SRGBAverage<Uint8>);
+            if (Attribs.FilterType == MIP_FILTER_TYPE_MOST_FREQUENT)
+                FilterMipLevel<Uint8>(Attribs, FmtAttribs.NumComponents, MostFrequentSelector<Uint8>);
+            else
+                FilterMipLevel<Uint8>(Attribs, FmtAttribs.NumComponents, SRGB8Average{});
             if (Attribs.AlphaCutoff > 0)
             {
                 RemapAlpha(Attribs, FmtAttribs.NumComponents, FmtAttribs.NumComponents - 1);
@@ -451,6 +667,81 @@ void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
     }
 }
 
+void ComputeMipChain(const ComputeMipChainAttribs& Attribs)
+{
+    DEV_CHECK_ERR(Attribs.Format != TEX_FORMAT_UNKNOWN, "Format must not be unknown");
+    DEV_CHECK_ERR(Attribs.Width != 0 && Attribs.Height != 0, "Texture dimensions must not be zero");
+    DEV_CHECK_ERR(Attribs.ArraySize != 0, "Array size must not be zero");
+    DEV_CHECK_ERR(Attribs.ppSubresData != nullptr, "Subresource data must not be null");
+    DEV_CHECK_ERR(Attribs.pSubresStrides != nullptr, "Subresource strides must not be null");
+
+    const Uint32 MipLevels = Attribs.MipLevels != 0 ? Attribs.MipLevels : ComputeMipLevelsCount(Attribs.Width, Attribs.Height);
+    DEV_CHECK_ERR(MipLevels <= ComputeMipLevelsCount(Attribs.Width, Attribs.Height), "Too many mip levels");
+
+    std::vector<ComputeMipLevelAttribs> Jobs;
+    for (Uint32 Mip = 1; Mip < MipLevels; ++Mip)
+    {
+        const Uint32 FineWidth    = std::max(Attribs.Width >> (Mip - 1), 1u);
+        const Uint32 FineHeight   = std::max(Attribs.Height >> (Mip - 1), 1u);
+        const Uint32 CoarseWidth  = std::max(FineWidth / 2u, 1u);
+        const Uint32 CoarseHeight = std::max(FineHeight / 2u, 1u);
+
+        // Selectors such as MIP_FILTER_TYPE_MOST_FREQUENT depend on the row index modulo 4,
+        // so the bands must start at the rows that are multiples of 4 to produce identical results.
+        Uint32 RowsPerTask = Attribs.RowsPerTask != 0 ? Attribs.RowsPerTask : (1u << 18u) / CoarseWidth;
+        RowsPerTask        = AlignUp(std::max(RowsPerTask, 1u), 4u);
+
+        Jobs.clear();
+        for (Uint32 Slice = 0; Slice < Attribs.ArraySize; ++Slice)
+        {
+            const size_t FineSubres   = size_t{Slice} * MipLevels + Mip - 1;
+            const size_t CoarseSubres = FineSubres + 1;
+
+            const auto*  pFineData     = static_cast<const Uint8*>(Attribs.ppSubresData[FineSubres]);
+            auto*        pCoarseData   = static_cast<Uint8*>(Attribs.ppSubresData[CoarseSubres]);
+            const size_t FineStride    = Attribs.pSubresStrides[FineSubres];
+            const size_t CoarseStride  = Attribs.pSubresStrides[CoarseSubres];
+            const Uint32 BandRowsLimit = FineHeight > 1 ? RowsPerTask : CoarseHeight;
+            for (Uint32 Row = 0; Row < CoarseHeight; Row += BandRowsLimit)
+            {
+                const Uint32 NumRows = std::min(BandRowsLimit, CoarseHeight - Row);
+                Jobs.emplace_back(Attribs.Format,
+                                  FineWidth,
+                                  FineHeight > 1 ? NumRows * 2 : 1u,
+                                  pFineData + size_t{Row} * 2 * FineStride,
+                                  FineStride,
+                                  pCoarseData + size_t{Row} * CoarseStride,
+                                  CoarseStride,
+                                  Attribs.FilterType,
+                                  Attribs.AlphaCutoff);
+            }
+        }
+
+        if (Attribs.pThreadPool == nullptr || Jobs.size() <= 1)
+        {
+            for (const auto& Job : Jobs)
+                ComputeMipLevel(Job);
+            continue;
+        }
+
+        std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+        Tasks.reserve(Jobs.size() - 1);
+        for (size_t Job = 1; Job < Jobs.size(); ++Job)
+        {
+            Tasks.emplace_back(EnqueueAsyncWork(Attribs.pThreadPool,
+                                                [&Jobs, Job](Uint32 ThreadId) {
+                                                    ComputeMipLevel(Jobs[Job]);
+                                                }));
+        }
+
+        // The calling thread processes the first band while the thread pool works on the rest.
+        // Every level depends on the previous one, so all tasks must complete before the next level.
+        ComputeMipLevel(Jobs[0]);
+        for (auto& pTask : Tasks)
+            pTask->WaitForCompletion();
+    }
+}
+
 } // namespace Diligent
 
 
@@ -0,0 +1,371 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "IndirectDrawCompactor.hpp"
+
+#include <algorithm>
+
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../GraphicsEngine/interface/Shader.h"
+#include "GraphicsUtilities.h"
+#include "MapHelper.hpp"
+#include "ShaderMacroHelper.hpp"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// clang-format off
+static constexpr char CullingShaderSource[] = R"(
+struct ObjectBounds
+{
+    float4 Min;
+    float4 Max;
+};
+
+struct DrawRecord
+{
+    uint NumIndices;
+    uint NumInstances;
+    uint FirstIndexLocation;
+    int  BaseVertex;
+    uint FirstInstanceLocation;
+};
+
+cbuffer cbCullingAttribs
+{
+    float4x4 g_ViewProj;
+    float4   g_FrustumPlanes[6];
+
+    float2   g_HiZSize;
+    float    g_HiZMaxMip;
+    uint     g_NumObjects;
+
+    float    g_ZtoDepthScale;
+    float    g_ZtoDepthBias;
+    float    g_YtoVScale;
+    float    g_Padding;
+};
+
+StructuredBuffer<ObjectBounds>  g_Bounds;
+StructuredBuffer<DrawRecord>    g_DrawRecords;
+RWStructuredBuffer<DrawRecord>  g_CompactedArgs;
+RWStructuredBuffer<uint>        g_DrawCount;
+
+#if ENABLE_HIZ
+Texture2D<float> g_HiZ;
+#endif
+
+bool IsInsideFrustum(float3 BoxMin, float3 BoxMax)
+{
+    for (int i = 0; i < 6; ++i)
+    {
+        float4 Plane = g_FrustumPlanes[i];
+        // The box corner that is farthest along the plane normal
+        float3 MaxPoint = float3(Plane.x > 0.0 ? BoxMax.x : BoxMin.x,
+                                 Plane.y > 0.0 ? BoxMax.y : BoxMin.y,
+                                 Plane.z > 0.0 ? BoxMax.z : BoxMin.z);
+        if (dot(MaxPoint, Plane.xyz) + Plane.w < 0.0)
+            return false;
+    }
+    return true;
+}
+
+#if ENABLE_HIZ
+bool IsOccluded(float3 BoxMin, float3 BoxMax)
+{
+    float2 MinXY = float2(+1.0, +1.0);
+    float2 MaxXY = float2(-1.0, -1.0);
+    float  NearestDepth = REVERSE_Z ? 0.0 : 1.0;
+    for (int i = 0; i < 8; ++i)
+    {
+        float3 Corner = float3((i & 1) != 0 ? BoxMax.x : BoxMin.x,
+                               (i & 2) != 0 ? BoxMax.y : BoxMin.y,
+                               (i & 4) != 0 ? BoxMax.z : BoxMin.z);
+        float4 ClipPos = mul(float4(Corner, 1.0), g_ViewProj);
+        // The box crosses the camera plane
+        if (ClipPos.w <= 0.0)
+            return false;
+
+        float3 NDC = ClipPos.xyz / ClipPos.w;
+        MinXY = min(MinXY, NDC.xy);
+        MaxXY = max(MaxXY, NDC.xy);
+
+        float Depth = NDC.z * g_ZtoDepthScale + g_ZtoDepthBias;
+        NearestDepth = REVERSE_Z ? max(NearestDepth, Depth) : min(NearestDepth, Depth);
+    }
+    MinXY = clamp(MinXY, float2(-1.0, -1.0), float2(1.0, 1.0));
+    MaxXY = clamp(MaxXY, float2(-1.0, -1.0), float2(1.0, 1.0));
+
+    float2 UV0 = float2(MinXY.x, MinXY.y) * float2(0.5, g_YtoVScale) + float2(0.5, 0.5);
+    float2 UV1 = float2(MaxXY.x, MaxXY.y) * float2(0.5, g_YtoVScale) + float2(0.5, 0.5);
+    float2 MinUV = min(UV0, UV1);
+    float2 MaxUV = max(UV0, UV1);
+
+    // Select the mip level where the projected box covers at most 2x2 texels
+    float2 SizeInTexels = (MaxUV - MinUV) * g_HiZSize;
+    float  Mip = clamp(ceil(log2(max(max(SizeInTexels.x, SizeInTexels.y), 1.0))), 0.0, g_HiZMaxMip);
+
+    int   MipLevel = int(Mip);
+    int2  MipSize  = max(int2(g_HiZSize) >> MipLevel, int2(1, 1));
+    int2  MinTexel = clamp(int2(MinUV * float2(MipSize)), int2(0, 0), MipSize - int2(1, 1));
+    int2  MaxTexel = clamp(int2(MaxUV * float2(MipSize)), int2(0, 0), MipSize - int2(1, 1));
+
+    float Depth0 = g_HiZ.Load(int3(MinTexel.x, MinTexel.y, MipLevel));
+    float Depth1 = g_HiZ.Load(int3(MaxTexel.x, MinTexel.y, MipLevel));
+    float Depth2 = g_HiZ.Load(int3(MinTexel.x, MaxTexel.y, MipLevel));
+    float Depth3 = g_HiZ.Load(int3(MaxTexel.x, MaxTexel.y, MipLevel));
+
+#if REVERSE_Z
+    float FarthestDepth = min(min(Depth0, Depth1), min(Depth2, Depth3));
+    return NearestDepth < FarthestDepth;
+#else
+    float FarthestDepth = max(max(Depth0, Depth1), max(Depth2, Depth3));
+    return NearestDepth > FarthestDepth;
+#endif
+}
+#endif
+
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void main(uint3 DTid : SV_DispatchThreadID)
+{
+    uint ObjectIdx = DTid.x;
+    if (ObjectIdx >= g_NumObjects)
+        return;
+
+    DrawRecord Record = g_DrawRecords[ObjectIdx];
+    if (Record.NumIndices == 0u || Record.NumInstances == 0u)
+        return;
+
+    ObjectBounds Bounds = g_Bounds[ObjectIdx];
+    if (!IsInsideFrustum(Bounds.Min.xyz, Bounds.Max.xyz))
+        return;
+
+#if ENABLE_HIZ
+    if (IsOccluded(Bounds.Min.xyz, Bounds.Max.xyz))
+        return;
+#endif
+
+    uint DrawIdx;
+    InterlockedAdd(g_DrawCount[0], 1u, DrawIdx);
+    g_CompactedArgs[DrawIdx] = Record;
+}
+)";
+// clang-format on
+
+struct CullingAttribs
+{
+    float4x4 ViewProj;
+    float4   FrustumPlanes[ViewFrustum::NUM_PLANES];
+
+    float2 HiZSize;
+    float  HiZMaxMip  = 0;
+    Uint32 NumObjects = 0;
+
+    float ZtoDepthScale = 0;
+    float ZtoDepthBias  = 0;
+    float YtoVScale     = 0;
+    float Padding       = 0;
+};
+static_assert(sizeof(CullingAttribs) % 16 == 0, "Constant buffer size must be a multiple of 16 bytes");
+
+IRenderDevice* ValidateDevice(IRenderDevice* pDevice)
+{
+    if (pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+        LOG_ERROR_AND_THROW("IndirectDrawCompactor requires compute shaders");
+
+    return pDevice;
+}
+
+} // namespace
+
+IndirectDrawCompactor::IndirectDrawCompactor(const CreateInfo& CI) :
+    m_pDevice{ValidateDevice(CI.pDevice)},
+    m_ThreadGroupSize{CI.ThreadGroupSize},
+    m_ReverseZ{CI.ReverseZ}
+{
+    if (m_ThreadGroupSize == 0)
+        LOG_ERROR_AND_THROW("Thread group size must not be zero");
+
+    if ((m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER) == 0)
+        LOG_WARNING_MESSAGE("The device does not support indirect draw counter buffers: the count buffer produced by IndirectDrawCompactor can't be used as DrawIndexedIndirectAttribs::pCounterBuffer");
+
+    CreateUniformBuffer(m_pDevice, sizeof(CullingAttribs), "Indirect draw compactor constants", &m_pConstants);
+    if (!m_pConstants)
+        LOG_ERROR_AND_THROW("Failed to create the constant buffer");
+
+    m_FrustumPipeline = CreatePipeline(false);
+    if (CI.EnableHiZ)
+        m_HiZPipeline = CreatePipeline(true);
+}
+
+IndirectDrawCompactor::CullingPipeline IndirectDrawCompactor::CreatePipeline(bool EnableHiZ)
+{
+    ShaderMacroHelper Macros;
+    Macros.AddShaderMacro("THREAD_GROUP_SIZE", m_ThreadGroupSize);
+    Macros.AddShaderMacro("ENABLE_HIZ", EnableHiZ ? 1 : 0);
+    Macros.AddShaderMacro("REVERSE_Z", m_ReverseZ ? 1 : 0);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name       = EnableHiZ ? "Indirect draw compactor Hi-Z culling CS" : "Indirect draw compactor frustum culling CS";
+    ShaderCI.EntryPoint      = "main";
+    ShaderCI.Source          = CullingShaderSource;
+    ShaderCI.Macros          = Macros;
+
+    RefCntAutoPtr<IShader> pCS;
+    m_pDevice->CreateShader(ShaderCI, &pCS);
+    if (!pCS)
+        LOG_ERROR_AND_THROW("Failed to create the culling shader");
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name         = EnableHiZ ? "Indirect draw compactor Hi-Z culling PSO" : "Indirect draw compactor frustum culling PSO";
+    PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.pCS                  = pCS;
+
+    // The constant buffer is the same for all dispatches, other resources are set every time
+    ShaderResourceVariableDesc Vars[] = {
+        {SHADER_TYPE_COMPUTE, "cbCullingAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC} //
+    };
+    PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+    PSOCreateInfo.PSODesc.ResourceLayout.Variables           = Vars;
+    PSOCreateInfo.PSODesc.ResourceLayout.NumVariables        = _countof(Vars);
+
+    CullingPipeline Pipeline;
+    m_pDevice->CreateComputePipelineState(PSOCreateInfo, &Pipeline.pPSO);
+    if (!Pipeline.pPSO)
+        LOG_ERROR_AND_THROW("Failed to create the culling pipeline");
+
+    Pipeline.pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbCullingAttribs")->Set(m_pConstants);
+    Pipeline.pPSO->CreateShaderResourceBinding(&Pipeline.pSRB, true);
+    if (!Pipeline.pSRB)
+        LOG_ERROR_AND_THROW("Failed to create the shader resource binding");
+
+    return Pipeline;
+}
+
+void IndirectDrawCompactor::CreateOutputBuffers(Uint32 MaxDraws, IBuffer** ppArgsBuffer, IBuffer** ppCountBuffer)
+{
+    DEV_CHECK_ERR(MaxDraws > 0, "The maximum number of draws must not be zero");
+    DEV_CHECK_ERR(ppArgsBuffer != nullptr && ppCountBuffer != nullptr, "Output buffer pointers must not be null");
+
+    BufferDesc ArgsDesc;
+    ArgsDesc.Name              = "Indirect draw compactor args buffer";
+    ArgsDesc.Size              = Uint64{sizeof(DrawRecord)} * MaxDraws;
+    ArgsDesc.Usage             = USAGE_DEFAULT;
+    ArgsDesc.BindFlags         = BIND_UNORDERED_ACCESS | BIND_INDIRECT_DRAW_ARGS;
+    ArgsDesc.Mode              = BUFFER_MODE_STRUCTURED;
+    ArgsDesc.ElementByteStride = sizeof(DrawRecord);
+    m_pDevice->CreateBuffer(ArgsDesc, nullptr, ppArgsBuffer);
+
+    BufferDesc CountDesc;
+    CountDesc.Name              = "Indirect draw compactor count buffer";
+    CountDesc.Size              = sizeof(Uint32);
+    CountDesc.Usage             = USAGE_DEFAULT;
+    CountDesc.BindFlags         = BIND_UNORDERED_ACCESS | BIND_INDIRECT_DRAW_ARGS;
+    CountDesc.Mode              = BUFFER_MODE_STRUCTURED;
+    CountDesc.ElementByteStride = sizeof(Uint32);
+    m_pDevice->CreateBuffer(CountDesc, nullptr, ppCountBuffer);
+}
+
+void IndirectDrawCompactor::Compact(IDeviceContext* pContext, const CompactAttribs& Attribs)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(Attribs.pBoundsBuffer != nullptr, "Bounds buffer must not be null");
+    DEV_CHECK_ERR(Attribs.pDrawRecordsBuffer != nullptr, "Draw records buffer must not be null");
+    DEV_CHECK_ERR(Attribs.pArgsBuffer != nullptr, "Args buffer must not be null");
+    DEV_CHECK_ERR(Attribs.pCountBuffer != nullptr, "Count buffer must not be null");
+    DEV_CHECK_ERR(Attribs.pFrustum != nullptr, "View frustum must not be null");
+    DEV_CHECK_ERR(Attribs.pHiZ == nullptr || m_HiZPipeline.pPSO, "Hi-Z texture is provided, but the compactor was created without Hi-Z culling support");
+    DEV_CHECK_ERR(Attribs.pArgsBuffer->GetDesc().Size >= Uint64{sizeof(DrawRecord)} * Attribs.NumObjects,
+                  "The args buffer is too small to hold ", Attribs.NumObjects, " draw records");
+
+    // Reset the count before the culling shader appends the visible draws
+    constexpr Uint32 ZeroCount = 0;
+    pContext->UpdateBuffer(Attribs.pCountBuffer, 0, sizeof(ZeroCount), &ZeroCount, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    if (Attribs.NumObjects == 0)
+        return;
+
+    const bool UseHiZ   = Attribs.pHiZ != nullptr && m_HiZPipeline.pPSO;
+    auto&      Pipeline = UseHiZ ? m_HiZPipeline : m_FrustumPipeline;
+
+    {
+        MapHelper<CullingAttribs> Constants{pContext, m_pConstants, MAP_WRITE, MAP_FLAG_DISCARD};
+        Constants->ViewProj = Attribs.ViewProj.Transpose();
+        for (Uint32 i = 0; i < ViewFrustum::NUM_PLANES; ++i)
+        {
+            const auto& Plane           = Attribs.pFrustum->GetPlane(static_cast<ViewFrustum::PLANE_IDX>(i));
+            Constants->FrustumPlanes[i] = float4{Plane.Normal, Plane.Distance};
+        }
+        Constants->NumObjects = Attribs.NumObjects;
+
+        const auto& NDC          = m_pDevice->GetDeviceInfo().GetNDCAttribs();
+        Constants->ZtoDepthScale = NDC.ZtoDepthScale;
+        Constants->ZtoDepthBias  = NDC.GetZtoDepthBias();
+        Constants->YtoVScale     = NDC.YtoVScale;
+
+        if (UseHiZ)
+        {
+            const auto& ViewDesc = Attribs.pHiZ->GetDesc();
+            const auto& TexDesc  = Attribs.pHiZ->GetTexture()->GetDesc();
+            const auto  Width    = std::max(TexDesc.Width >> ViewDesc.MostDetailedMip, 1u);
+            const auto  Height   = std::max(TexDesc.Height >> ViewDesc.MostDetailedMip, 1u);
+
+            Constants->HiZSize   = float2{static_cast<float>(Width), static_cast<float>(Height)};
+            Constants->HiZMaxMip = static_cast<float>(ViewDesc.NumMipLevels - 1);
+        }
+    }
+
+    auto* pSRB = Pipeline.pSRB.RawPtr<IShaderResourceBinding>();
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Bounds")->Set(Attribs.pBoundsBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_DrawRecords")->Set(Attribs.pDrawRecordsBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_CompactedArgs")->Set(Attribs.pArgsBuffer->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_DrawCount")->Set(Attribs.pCountBuffer->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+    if (UseHiZ)
+        pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_HiZ")->Set(Attribs.pHiZ);
+
+    pContext->SetPipelineState(Pipeline.pPSO);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    DispatchComputeAttribs DispatchAttribs;
+    DispatchAttribs.ThreadGroupCountX   = (Attribs.NumObjects + m_ThreadGroupSize - 1) / m_ThreadGroupSize;
+    DispatchAttribs.MtlThreadGroupSizeX = m_ThreadGroupSize;
+    DispatchAttribs.MtlThreadGroupSizeY = 1;
+    DispatchAttribs.MtlThreadGroupSizeZ = 1;
+    pContext->DispatchCompute(DispatchAttribs);
+}
+
+} // namespace Diligent
@@ -0,0 +1,441 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "MeshletBuilder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "AdvancedMath.hpp"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+inline float3 GetPosition(const void* pPositions, Uint32 Stride, Uint32 Index)
+{
+    float3 Pos;
+    std::memcpy(&Pos, static_cast<const Uint8*>(pPositions) + size_t{Stride} * Index, sizeof(Pos));
+    return Pos;
+}
+
+void ValidateAttribs(const MeshletBuildAttribs& Attribs) noexcept(false)
+{
+    if (Attribs.pIndices == nullptr && Attribs.NumIndices != 0)
+        LOG_ERROR_AND_THROW("Index data must not be null");
+    if (Attribs.NumIndices % 3 != 0)
+        LOG_ERROR_AND_THROW("The number of indices (", Attribs.NumIndices, ") must be a multiple of 3");
+    if (Attribs.pPositions == nullptr && Attribs.NumVertices != 0)
+        LOG_ERROR_AND_THROW("Position data must not be null");
+    if (Attribs.PositionStride < sizeof(float3))
+        LOG_ERROR_AND_THROW("Position stride (", Attribs.PositionStride, ") must be at least ", sizeof(float3), " bytes");
+    if (Attribs.MaxVertices < 3 || Attribs.MaxVertices > 256)
+        LOG_ERROR_AND_THROW("The maximum number of meshlet vertices (", Attribs.MaxVertices, ") must be in the range [3, 256]");
+    if (Attribs.MaxPrimitives < 1 || Attribs.MaxPrimitives > 256)
+        LOG_ERROR_AND_THROW("The maximum number of meshlet primitives (", Attribs.MaxPrimitives, ") must be in the range [1, 256]");
+    if (Attribs.pThreadPool != nullptr && Attribs.TrianglesPerTask == 0)
+        LOG_ERROR_AND_THROW("The number of triangles per task must not be zero");
+
+    for (Uint32 i = 0; i < Attribs.NumIndices; ++i)
+    {
+        if (Attribs.pIndices[i] >= Attribs.NumVertices)
+            LOG_ERROR_AND_THROW("Index ", Attribs.pIndices[i], " at position ", i, " is out of range [0, ", Attribs.NumVertices, ")");
+    }
+}
+
+// Partitions the triangles [FirstTri, EndTri) into meshlets. Offsets in the output are relative to the chunk.
+void BuildMeshletChunk(const MeshletBuildAttribs& Attribs, Uint32 FirstTri, Uint32 EndTri, MeshletData& Data)
+{
+    Meshlet Current;
+
+    auto FinishMeshlet = [&]() {
+        if (Current.PrimitiveCount == 0)
+            return;
+        Data.Meshlets.push_back(Current);
+        Current.VertexOffset    = static_cast<Uint32>(Data.VertexIndices.size());
+        Current.VertexCount     = 0;
+        Current.PrimitiveOffset = static_cast<Uint32>(Data.PrimitiveIndices.size());
+        Current.PrimitiveCount  = 0;
+    };
+
+    // Returns the local index of the vertex in the current meshlet, or VertexCount if it is not there
+    auto FindVertex = [&](Uint32 Index) {
+        const Uint32* pVerts = Data.VertexIndices.data() + Current.VertexOffset;
+        Uint32        v      = 0;
+        while (v < Current.VertexCount && pVerts[v] != Index)
+            ++v;
+        return v;
+    };
+
+    for (Uint32 Tri = FirstTri; Tri < EndTri; ++Tri)
+    {
+        const Uint32* TriIndices = Attribs.pIndices + size_t{Tri} * 3;
+
+        Uint32 NumNewVerts = 0;
+        for (Uint32 i = 0; i < 3; ++i)
+        {
+            // Count the vertices that are not in the meshlet and are not repeated in the triangle
+            if (FindVertex(TriIndices[i]) == Current.VertexCount &&
+                (i < 1 || TriIndices[i] != TriIndices[0]) &&
+                (i < 2 || TriIndices[i] != TriIndices[1]))
+                ++NumNewVerts;
+        }
+
+        if (Current.VertexCount + NumNewVerts > Attribs.MaxVertices || Current.PrimitiveCount + 1 > Attribs.MaxPrimitives)
+            FinishMeshlet();
+
+        Uint32 Local[3] = {};
+        for (Uint32 i = 0; i < 3; ++i)
+        {
+            Local[i] = FindVertex(TriIndices[i]);
+            if (Local[i] == Current.VertexCount)
+            {
+                Data.VertexIndices.push_back(TriIndices[i]);
+                ++Current.VertexCount;
+            }
+        }
+        VERIFY_EXPR(Current.VertexCount <= Attribs.MaxVertices);
+
+        Data.PrimitiveIndices.push_back(Local[0] | (Local[1] << 8u) | (Local[2] << 16u));
+        ++Current.PrimitiveCount;
+    }
+    FinishMeshlet();
+
+    Data.Bounds.resize(Data.Meshlets.size());
+    for (size_t i = 0; i < Data.Meshlets.size(); ++i)
+        Data.Bounds[i] = ComputeMeshletBounds(Data, Data.Meshlets[i], Attribs.pPositions, Attribs.PositionStride);
+}
+
+} // namespace
+
+MeshletBounds ComputeMeshletBounds(const MeshletData& Data, const Meshlet& Meshlet, const void* pPositions, Uint32 PositionStride)
+{
+    VERIFY_EXPR(size_t{Meshlet.VertexOffset} + Meshlet.VertexCount <= Data.VertexIndices.size());
+    VERIFY_EXPR(size_t{Meshlet.PrimitiveOffset} + Meshlet.PrimitiveCount <= Data.PrimitiveIndices.size());
+
+    const Uint32* pVerts = Data.VertexIndices.data() + Meshlet.VertexOffset;
+
+    MeshletBounds Bounds;
+    if (Meshlet.VertexCount == 0)
+    {
+        Bounds.Cone.w = 1;
+        return Bounds;
+    }
+
+    // Bounding sphere around the center of the bounding box
+    float3 BoxMin = GetPosition(pPositions, PositionStride, pVerts[0]);
+    float3 BoxMax = BoxMin;
+    for (Uint32 v = 1; v < Meshlet.VertexCount; ++v)
+    {
+        const auto Pos = GetPosition(pPositions, PositionStride, pVerts[v]);
+        BoxMin         = min(BoxMin, Pos);
+        BoxMax         = max(BoxMax, Pos);
+    }
+    const float3 Center = (BoxMin + BoxMax) * 0.5f;
+
+    float Radius = 0;
+    for (Uint32 v = 0; v < Meshlet.VertexCount; ++v)
+        Radius = std::max(Radius, length(GetPosition(pPositions, PositionStride, pVerts[v]) - Center));
+    Bounds.Sphere = float4{Center, Radius};
+
+    // Normal cone, degenerate triangles are ignored
+    std::vector<float3> Normals;
+    Normals.reserve(Meshlet.PrimitiveCount);
+
+    float3 NormalSum;
+    for (Uint32 p = 0; p < Meshlet.PrimitiveCount; ++p)
+    {
+        const Uint32 Prim = Data.PrimitiveIndices[Meshlet.PrimitiveOffset + p];
+
+        const auto P0 = GetPosition(pPositions, PositionStride, pVerts[Prim & 0xFFu]);
+        const auto P1 = GetPosition(pPositions, PositionStride, pVerts[(Prim >> 8u) & 0xFFu]);
+        const auto P2 = GetPosition(pPositions, PositionStride, pVerts[(Prim >> 16u) & 0xFFu]);
+
+        const auto  N   = cross(P1 - P0, P2 - P0);
+        const float Len = length(N);
+        if (Len == 0)
+            continue;
+
+        Normals.push_back(N / Len);
+        NormalSum += Normals.back();
+    }
+
+    const float SumLen = length(NormalSum);
+    if (Normals.empty() || SumLen == 0)
+    {
+        Bounds.Cone = float4{0, 0, 0, 1};
+        return Bounds;
+    }
+
+    const float3 Axis = NormalSum / SumLen;
+
+    float MinDot = 1;
+    for (const auto& N : Normals)
+        MinDot = std::min(MinDot, dot(Axis, N));
+
+    // The cone is wider than 90 degrees minus a small margin: it can't be used for culling
+    const float Cutoff = MinDot <= 0.1f ? 1.f : std::sqrt(1.f - MinDot * MinDot);
+
+    Bounds.Cone = float4{Axis, Cutoff};
+    return Bounds;
+}
+
+void BuildMeshlets(const MeshletBuildAttribs& Attribs, MeshletData& Data) noexcept(false)
+{
+    ValidateAttribs(Attribs);
+
+    Data = {};
+
+    const Uint32 NumTriangles = Attribs.NumIndices / 3;
+    if (NumTriangles == 0)
+        return;
+
+    if (Attribs.pThreadPool == nullptr || NumTriangles <= Attribs.TrianglesPerTask)
+    {
+        BuildMeshletChunk(Attribs, 0, NumTriangles, Data);
+        return;
+    }
+
+    const Uint32 NumChunks = (NumTriangles + Attribs.TrianglesPerTask - 1) / Attribs.TrianglesPerTask;
+
+    // Every task writes to its own chunk
+    std::vector<MeshletData> Chunks(NumChunks);
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+    Tasks.reserve(NumChunks);
+    for (Uint32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+    {
+        const Uint32 FirstTri = Chunk * Attribs.TrianglesPerTask;
+        const Uint32 EndTri   = std::min(FirstTri + Attribs.TrianglesPerTask, NumTriangles);
+        Tasks.emplace_back(EnqueueAsyncWork(Attribs.pThreadPool,
+                                            [&Attribs, &Chunks, Chunk, FirstTri, EndTri](Uint32 /*ThreadId*/) {
+                                                BuildMeshletChunk(Attribs, FirstTri, EndTri, Chunks[Chunk]);
+                                            }));
+    }
+    for (auto& pTask : Tasks)
+        pTask->WaitForCompletion();
+
+    size_t NumMeshlets = 0, NumVertices = 0, NumPrimitives = 0;
+    for (const auto& Chunk : Chunks)
+    {
+        NumMeshlets += Chunk.Meshlets.size();
+        NumVertices += Chunk.VertexIndices.size();
+        NumPrimitives += Chunk.PrimitiveIndices.size();
+    }
+    Data.Meshlets.reserve(NumMeshlets);
+    Data.Bounds.reserve(NumMeshlets);
+    Data.VertexIndices.reserve(NumVertices);
+    Data.PrimitiveIndices.reserve(NumPrimitives);
+
+    for (const auto& Chunk : Chunks)
+    {
+        const auto VertexOffset    = static_cast<Uint32>(Data.VertexIndices.size());
+        const auto PrimitiveOffset = static_cast<Uint32>(Data.PrimitiveIndices.size());
+        for (auto Meshlet : Chunk.Meshlets)
+        {
+            Meshlet.VertexOffset += VertexOffset;
+            Meshlet.PrimitiveOffset += PrimitiveOffset;
+            Data.Meshlets.push_back(Meshlet);
+        }
+        Data.Bounds.insert(Data.Bounds.end(), Chunk.Bounds.begin(), Chunk.Bounds.end());
+        Data.VertexIndices.insert(Data.VertexIndices.end(), Chunk.VertexIndices.begin(), Chunk.VertexIndices.end());
+        Data.PrimitiveIndices.insert(Data.PrimitiveIndices.end(), Chunk.PrimitiveIndices.begin(), Chunk.PrimitiveIndices.end());
+    }
+}
+
+void InitMeshletCullingConstants(const float4x4& ViewProj, const float3& CameraPos, Uint32 NumMeshlets, bool IsGL, MeshletCullingConstants& Constants)
+{
+    ViewFrustum Frustum;
+    ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, IsGL);
+
+    Constants.ViewProj = ViewProj.Transpose();
+    for (Uint32 i = 0; i < ViewFrustum::NUM_PLANES; ++i)
+    {
+        // Normalize the planes so that the shader can compare the distance with the sphere radius
+        const auto& Plane = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(i));
+        const float Len   = length(Plane.Normal);
+
+        Constants.FrustumPlanes[i] = Len > 0 ? float4{Plane.Normal / Len, Plane.Distance / Len} : float4{0, 0, 0, 0};
+    }
+    Constants.CameraPos   = float4{CameraPos, 1};
+    Constants.NumMeshlets = NumMeshlets;
+}
+
+const char* GetMeshletCullingShaderSource()
+{
+    return R"(
+#ifndef MESHLET_AS_GROUP_SIZE
+#   define MESHLET_AS_GROUP_SIZE 32
+#endif
+
+struct MeshletBounds
+{
+    float4 Sphere;
+    float4 Cone;
+};
+
+struct MeshletPayload
+{
+    uint MeshletIndices[MESHLET_AS_GROUP_SIZE];
+};
+
+cbuffer cbMeshletCulling
+{
+    float4x4 g_ViewProj;
+    float4   g_FrustumPlanes[6];
+    float4   g_CameraPos;
+    uint     g_NumMeshlets;
+    uint3    g_Padding;
+};
+
+StructuredBuffer<MeshletBounds> g_MeshletBounds;
+
+groupshared MeshletPayload s_Payload;
+groupshared uint           s_VisibleCount;
+
+bool IsMeshletVisible(MeshletBounds Bounds)
+{
+    float3 Center = Bounds.Sphere.xyz;
+    float  Radius = Bounds.Sphere.w;
+    for (int i = 0; i < 6; ++i)
+    {
+        if (dot(g_FrustumPlanes[i].xyz, Center) + g_FrustumPlanes[i].w < -Radius)
+            return false;
+    }
+
+    // Normal cone culling: all triangles of the meshlet face away from the camera
+    float3 ToCenter = Center - g_CameraPos.xyz;
+    float  Dist     = length(ToCenter);
+    if (Bounds.Cone.w < 1.0 && Dist > Radius &&
+        dot(ToCenter, Bounds.Cone.xyz) >= Bounds.Cone.w * Dist + Radius)
+        return false;
+
+    return true;
+}
+
+[numthreads(MESHLET_AS_GROUP_SIZE, 1, 1)]
+void main(uint I   : SV_GroupIndex,
+          uint DTid : SV_DispatchThreadID)
+{
+    if (I == 0u)
+        s_VisibleCount = 0u;
+    GroupMemoryBarrierWithGroupSync();
+
+    if (DTid < g_NumMeshlets && IsMeshletVisible(g_MeshletBounds[DTid]))
+    {
+        uint Index;
+        InterlockedAdd(s_VisibleCount, 1u, Index);
+        s_Payload.MeshletIndices[Index] = DTid;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    DispatchMesh(s_VisibleCount, 1, 1, s_Payload);
+}
+)";
+}
+
+const char* GetMeshletShaderSource()
+{
+    return R"(
+#ifndef MESHLET_AS_GROUP_SIZE
+#   define MESHLET_AS_GROUP_SIZE 32
+#endif
+#ifndef MESHLET_MAX_VERTICES
+#   define MESHLET_MAX_VERTICES 64
+#endif
+#ifndef MESHLET_MAX_PRIMITIVES
+#   define MESHLET_MAX_PRIMITIVES 124
+#endif
+
+struct Meshlet
+{
+    uint VertexOffset;
+    uint VertexCount;
+    uint PrimitiveOffset;
+    uint PrimitiveCount;
+};
+
+struct MeshletPayload
+{
+    uint MeshletIndices[MESHLET_AS_GROUP_SIZE];
+};
+
+struct VertexOut
+{
+    float4 Position    : SV_Position;
+    uint   MeshletIndex : MESHLET_INDEX;
+};
+
+cbuffer cbMeshletCulling
+{
+    float4x4 g_ViewProj;
+    float4   g_FrustumPlanes[6];
+    float4   g_CameraPos;
+    uint     g_NumMeshlets;
+    uint3    g_Padding;
+};
+
+StructuredBuffer<Meshlet> g_Meshlets;
+StructuredBuffer<uint>    g_VertexIndices;
+StructuredBuffer<uint>    g_PrimitiveIndices;
+StructuredBuffer<float4>  g_Positions;
+
+[numthreads(MESHLET_MAX_PRIMITIVES > MESHLET_MAX_VERTICES ? MESHLET_MAX_PRIMITIVES : MESHLET_MAX_VERTICES, 1, 1)]
+[outputtopology("triangle")]
+void main(uint I   : SV_GroupIndex,
+          uint Gid : SV_GroupID,
+          in payload MeshletPayload Payload,
+          out indices  uint3     Tris[MESHLET_MAX_PRIMITIVES],
+          out vertices VertexOut Verts[MESHLET_MAX_VERTICES])
+{
+    uint    MeshletIndex = Payload.MeshletIndices[Gid];
+    Meshlet M            = g_Meshlets[MeshletIndex];
+
+    SetMeshOutputCounts(M.VertexCount, M.PrimitiveCount);
+
+    if (I < M.VertexCount)
+    {
+        float3 Pos = g_Positions[g_VertexIndices[M.VertexOffset + I]].xyz;
+        Verts[I].Position     = mul(float4(Pos, 1.0), g_ViewProj);
+        Verts[I].MeshletIndex = MeshletIndex;
+    }
+
+    if (I < M.PrimitiveCount)
+    {
+        uint Prim = g_PrimitiveIndices[M.PrimitiveOffset + I];
+        Tris[I] = uint3(Prim & 0xFFu, (Prim >> 8u) & 0xFFu, (Prim >> 16u) & 0xFFu);
+    }
+}
+)";
+}
+
+} // namespace Diligent
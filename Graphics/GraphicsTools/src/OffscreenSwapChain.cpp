@@ -0,0 +1,227 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "OffscreenSwapChain.hpp"
+
+#include "SwapChainBase.hpp"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+class OffscreenSwapChainImpl final : public SwapChainBase<ISwapChain>
+{
+public:
+    using TBase = SwapChainBase<ISwapChain>;
+
+    OffscreenSwapChainImpl(IReferenceCounters*                 pRefCounters,
+                           IRenderDevice*                      pDevice,
+                           IDeviceContext*                     pContext,
+                           const OffscreenSwapChainCreateInfo& CI) :
+        TBase{pRefCounters, pDevice, pContext, CI.Desc},
+        m_OnFrameReady{CI.OnFrameReady},
+        m_ReadbackQueue{GetReadbackQueueCI(pDevice, CI)}
+    {
+        if (m_SwapChainDesc.Width == 0 || m_SwapChainDesc.Height == 0)
+            LOG_ERROR_AND_THROW("Offscreen swap chain width and height must not be zero");
+        if (m_SwapChainDesc.BufferCount == 0)
+            m_SwapChainDesc.BufferCount = 1;
+        if (m_SwapChainDesc.PreTransform == SURFACE_TRANSFORM_OPTIMAL)
+            m_SwapChainDesc.PreTransform = SURFACE_TRANSFORM_IDENTITY;
+
+        FenceDesc FenceCI;
+        FenceCI.Name = "Offscreen swap chain frame fence";
+        pDevice->CreateFence(FenceCI, &m_pFrameFence);
+        if (!m_pFrameFence)
+            LOG_ERROR_AND_THROW("Failed to create offscreen swap chain frame fence");
+
+        CreateBuffers();
+    }
+
+    ~OffscreenSwapChainImpl()
+    {
+        if (auto pContext = m_wpDeviceContext.Lock())
+            m_ReadbackQueue.Flush(pContext);
+    }
+
+    virtual void DILIGENT_CALL_TYPE Present(Uint32 SyncInterval) override final
+    {
+        auto pContext = m_wpDeviceContext.Lock();
+        if (!pContext)
+        {
+            LOG_ERROR_MESSAGE("Immediate context has been released");
+            return;
+        }
+
+        // Frame N signals the fence value N + 1. Wait for the frame that was presented
+        // BufferCount frames ago to limit the number of readbacks in flight.
+        if (m_NextFrameId >= m_SwapChainDesc.BufferCount)
+            m_pFrameFence->Wait(m_NextFrameId - m_SwapChainDesc.BufferCount + 1);
+
+        const auto FrameId = m_NextFrameId++;
+        m_ReadbackQueue.ReadTexture(pContext, m_pColorBuffer, 0, 0, nullptr,
+                                    [this, FrameId](const AsyncReadbackQueue::ReadbackData& Data) {
+                                        if (m_OnFrameReady)
+                                            m_OnFrameReady(FrameId, Data);
+                                    });
+        pContext->EnqueueSignal(m_pFrameFence, m_NextFrameId);
+        pContext->Flush();
+
+        m_ReadbackQueue.Process(pContext);
+
+        if (m_SwapChainDesc.IsPrimary)
+        {
+            pContext->FinishFrame();
+            m_pRenderDevice->ReleaseStaleResources();
+        }
+    }
+
+    virtual void DILIGENT_CALL_TYPE Resize(Uint32 NewWidth, Uint32 NewHeight, SURFACE_TRANSFORM NewPreTransform) override final
+    {
+        if (NewPreTransform == SURFACE_TRANSFORM_OPTIMAL)
+            NewPreTransform = SURFACE_TRANSFORM_IDENTITY;
+
+        if (TBase::Resize(NewWidth, NewHeight, NewPreTransform, 0))
+        {
+            m_SwapChainDesc.PreTransform = NewPreTransform;
+            CreateBuffers();
+        }
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetFullscreenMode(const DisplayModeAttribs& DisplayMode) override final
+    {
+        UNSUPPORTED("Offscreen swap chain does not support fullscreen mode");
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetWindowedMode() override final
+    {
+        UNSUPPORTED("Offscreen swap chain does not support windowed mode");
+    }
+
+    virtual ITextureView* DILIGENT_CALL_TYPE GetCurrentBackBufferRTV() override final
+    {
+        return m_pColorBuffer->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+    }
+
+    virtual ITextureView* DILIGENT_CALL_TYPE GetDepthBufferDSV() override final
+    {
+        return m_pDepthBuffer ? m_pDepthBuffer->GetDefaultView(TEXTURE_VIEW_DEPTH_STENCIL) : nullptr;
+    }
+
+private:
+    static AsyncReadbackQueue::CreateInfo GetReadbackQueueCI(IRenderDevice* pDevice, const OffscreenSwapChainCreateInfo& CI)
+    {
+        AsyncReadbackQueue::CreateInfo QueueCI;
+        QueueCI.pDevice            = pDevice;
+        QueueCI.pThreadPool        = CI.pThreadPool;
+        QueueCI.MaxPooledResources = CI.MaxPooledResources;
+        return QueueCI;
+    }
+
+    // The readback of a frame is recorded before the next frame is rendered, so
+    // a single color buffer is sufficient for any number of frames in flight.
+    void CreateBuffers()
+    {
+        m_pColorBuffer.Release();
+        m_pDepthBuffer.Release();
+
+        TextureDesc ColorBufferDesc;
+        ColorBufferDesc.Name      = "Offscreen swap chain color buffer";
+        ColorBufferDesc.Type      = RESOURCE_DIM_TEX_2D;
+        ColorBufferDesc.Width     = m_SwapChainDesc.Width;
+        ColorBufferDesc.Height    = m_SwapChainDesc.Height;
+        ColorBufferDesc.Format    = m_SwapChainDesc.ColorBufferFormat;
+        ColorBufferDesc.Usage     = USAGE_DEFAULT;
+        ColorBufferDesc.BindFlags = BIND_RENDER_TARGET;
+        if (m_SwapChainDesc.Usage & SWAP_CHAIN_USAGE_SHADER_RESOURCE)
+            ColorBufferDesc.BindFlags |= BIND_SHADER_RESOURCE;
+        if (m_SwapChainDesc.Usage & SWAP_CHAIN_USAGE_INPUT_ATTACHMENT)
+            ColorBufferDesc.BindFlags |= BIND_INPUT_ATTACHMENT;
+
+        m_pRenderDevice->CreateTexture(ColorBufferDesc, nullptr, &m_pColorBuffer);
+        if (!m_pColorBuffer)
+            LOG_ERROR_AND_THROW("Failed to create offscreen swap chain color buffer");
+
+        if (m_SwapChainDesc.DepthBufferFormat != TEX_FORMAT_UNKNOWN)
+        {
+            TextureDesc DepthBufferDesc;
+            DepthBufferDesc.Name                            = "Offscreen swap chain depth buffer";
+            DepthBufferDesc.Type                            = RESOURCE_DIM_TEX_2D;
+            DepthBufferDesc.Width                           = m_SwapChainDesc.Width;
+            DepthBufferDesc.Height                          = m_SwapChainDesc.Height;
+            DepthBufferDesc.Format                          = m_SwapChainDesc.DepthBufferFormat;
+            DepthBufferDesc.Usage                           = USAGE_DEFAULT;
+            DepthBufferDesc.BindFlags                       = BIND_DEPTH_STENCIL;
+            DepthBufferDesc.ClearValue.Format               = DepthBufferDesc.Format;
+            DepthBufferDesc.ClearValue.DepthStencil.Depth   = m_SwapChainDesc.DefaultDepthValue;
+            DepthBufferDesc.ClearValue.DepthStencil.Stencil = m_SwapChainDesc.DefaultStencilValue;
+
+            m_pRenderDevice->CreateTexture(DepthBufferDesc, nullptr, &m_pDepthBuffer);
+            if (!m_pDepthBuffer)
+                LOG_ERROR_AND_THROW("Failed to create offscreen swap chain depth buffer");
+        }
+    }
+
+private:
+    const std::function<void(Uint64, const AsyncReadbackQueue::ReadbackData&)> m_OnFrameReady;
+
+    RefCntAutoPtr<ITexture> m_pColorBuffer;
+    RefCntAutoPtr<ITexture> m_pDepthBuffer;
+    RefCntAutoPtr<IFence>   m_pFrameFence;
+
+    Uint64 m_NextFrameId = 0;
+
+    // Must be destroyed before m_OnFrameReady as it waits for running callbacks
+    AsyncReadbackQueue m_ReadbackQueue;
+};
+
+} // namespace
+
+void CreateOffscreenSwapChain(IRenderDevice*                      pDevice,
+                              IDeviceContext*                     pContext,
+                              const OffscreenSwapChainCreateInfo& CreateInfo,
+                              ISwapChain**                        ppSwapChain)
+{
+    DEV_CHECK_ERR(pDevice != nullptr && pContext != nullptr, "Device and context must not be null");
+    DEV_CHECK_ERR(ppSwapChain != nullptr && *ppSwapChain == nullptr, "Swap chain pointer must not be null and must point to null");
+
+    try
+    {
+        auto* pSwapChain = MakeNewRCObj<OffscreenSwapChainImpl>()(pDevice, pContext, CreateInfo);
+        pSwapChain->QueryInterface(IID_SwapChain, reinterpret_cast<IObject**>(ppSwapChain));
+    }
+    catch (...)
+    {
+        LOG_ERROR_MESSAGE("Failed to create offscreen swap chain");
+    }
+}
+
+} // namespace Diligent
@@ -0,0 +1,209 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ParallelRecorder.hpp"
+
+#include <algorithm>
+
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../GraphicsEngine/interface/TextureView.h"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+void GetRenderTargetSize(const ParallelRecorder::InheritedState& State, Uint32& Width, Uint32& Height)
+{
+    Width  = State.RTWidth;
+    Height = State.RTHeight;
+    if (Width != 0 && Height != 0)
+        return;
+
+    ITextureView* pView = State.NumRenderTargets > 0 ? State.ppRenderTargets[0] : State.pDepthStencil;
+    if (pView == nullptr)
+        return;
+
+    const auto& TexDesc  = pView->GetTexture()->GetDesc();
+    const auto  MipLevel = pView->GetDesc().MostDetailedMip;
+
+    Width  = std::max(TexDesc.Width >> MipLevel, 1u);
+    Height = std::max(TexDesc.Height >> MipLevel, 1u);
+}
+
+} // namespace
+
+ParallelRecorder::ParallelRecorder(const CreateInfo& CI) noexcept(false) :
+    m_pImmediateCtx{CI.pImmediateCtx},
+    m_pThreadPool{CI.pThreadPool},
+    m_MinItemsPerContext{std::max(CI.MinItemsPerContext, 1u)}
+{
+    if (CI.pImmediateCtx == nullptr)
+        LOG_ERROR_AND_THROW("Immediate context must not be null");
+    if (CI.pImmediateCtx->GetDesc().IsDeferred)
+        LOG_ERROR_AND_THROW("Context '", CI.pImmediateCtx->GetDesc().Name, "' is not an immediate context");
+    if (CI.NumDeferredCtxs == 0 || CI.ppDeferredCtxs == nullptr)
+        LOG_ERROR_AND_THROW("At least one deferred context is required");
+
+    m_DeferredCtxs.reserve(CI.NumDeferredCtxs);
+    for (Uint32 i = 0; i < CI.NumDeferredCtxs; ++i)
+    {
+        IDeviceContext* pCtx = CI.ppDeferredCtxs[i];
+        if (pCtx == nullptr)
+            LOG_ERROR_AND_THROW("Deferred context ", i, " is null");
+        if (!pCtx->GetDesc().IsDeferred)
+            LOG_ERROR_AND_THROW("Context '", pCtx->GetDesc().Name, "' is not a deferred context");
+        m_DeferredCtxs.emplace_back(pCtx);
+    }
+}
+
+void ParallelRecorder::RecordRange(const InheritedState& State, Uint32 WorkerIndex, Uint32 FirstItem, Uint32 NumItems, const RecordFuncType& Record)
+{
+    IDeviceContext* pCtx = m_DeferredCtxs[WorkerIndex];
+
+    pCtx->Begin(m_pImmediateCtx->GetDesc().ContextId);
+
+    if (State.pRenderPass != nullptr)
+    {
+        pCtx->BeginRenderPass(*State.pRenderPass);
+    }
+    else if (State.NumRenderTargets > 0 || State.pDepthStencil != nullptr)
+    {
+        SetRenderTargetsAttribs RTAttribs;
+        RTAttribs.NumRenderTargets    = State.NumRenderTargets;
+        RTAttribs.ppRenderTargets     = const_cast<ITextureView**>(State.ppRenderTargets);
+        RTAttribs.pDepthStencil       = State.pDepthStencil;
+        RTAttribs.StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_VERIFY;
+        pCtx->SetRenderTargetsExt(RTAttribs);
+    }
+
+    if (State.pPSO != nullptr)
+        pCtx->SetPipelineState(State.pPSO);
+
+    Uint32 RTWidth  = 0;
+    Uint32 RTHeight = 0;
+    if (State.NumViewports > 0 || State.NumScissorRects > 0)
+        GetRenderTargetSize(State, RTWidth, RTHeight);
+    if (State.NumViewports > 0)
+        pCtx->SetViewports(State.NumViewports, State.pViewports, RTWidth, RTHeight);
+    if (State.NumScissorRects > 0)
+        pCtx->SetScissorRects(State.NumScissorRects, State.pScissorRects, RTWidth, RTHeight);
+
+    pCtx->SetStencilRef(State.StencilRef);
+    if (State.pBlendFactors != nullptr)
+        pCtx->SetBlendFactors(State.pBlendFactors);
+
+    Record(pCtx, WorkerIndex, FirstItem, NumItems);
+
+    if (State.pRenderPass != nullptr)
+        pCtx->EndRenderPass();
+
+    pCtx->FinishCommandList(&m_CmdLists[WorkerIndex]);
+}
+
+void ParallelRecorder::Record(const InheritedState& State, Uint32 NumItems, const RecordFuncType& Record, CommandListBatch* pBatch)
+{
+    DEV_CHECK_ERR(Record, "Record function must not be null");
+    DEV_CHECK_ERR(State.NumRenderTargets == 0 || State.ppRenderTargets != nullptr, "ppRenderTargets must not be null when NumRenderTargets is not zero");
+    DEV_CHECK_ERR(State.NumViewports == 0 || State.pViewports != nullptr, "pViewports must not be null when NumViewports is not zero");
+    DEV_CHECK_ERR(State.NumScissorRects == 0 || State.pScissorRects != nullptr, "pScissorRects must not be null when NumScissorRects is not zero");
+    if (NumItems == 0)
+        return;
+
+    const Uint32 NumWorkers      = std::min((NumItems + m_MinItemsPerContext - 1) / m_MinItemsPerContext, GetNumContexts());
+    const Uint32 ItemsPerRange   = NumItems / NumWorkers;
+    const Uint32 NumLargerRanges = NumItems % NumWorkers;
+
+    m_CmdLists.resize(NumWorkers);
+
+    // Distribute the remainder over the first ranges so that range sizes differ by at most one item.
+    auto GetRangeStart = [&](Uint32 Worker) {
+        return Worker * ItemsPerRange + std::min(Worker, NumLargerRanges);
+    };
+
+    m_Tasks.clear();
+    if (m_pThreadPool)
+    {
+        for (Uint32 Worker = 1; Worker < NumWorkers; ++Worker)
+        {
+            const Uint32 FirstItem = GetRangeStart(Worker);
+            const Uint32 EndItem   = GetRangeStart(Worker + 1);
+            m_Tasks.emplace_back(EnqueueAsyncWork(m_pThreadPool,
+                                                  [this, &State, &Record, Worker, FirstItem, EndItem](Uint32 /*ThreadId*/) {
+                                                      RecordRange(State, Worker, FirstItem, EndItem - FirstItem, Record);
+                                                  }));
+        }
+        // The calling thread records the first range while the workers are busy with the rest.
+        RecordRange(State, 0, 0, GetRangeStart(1), Record);
+        for (auto& pTask : m_Tasks)
+            pTask->WaitForCompletion();
+        m_Tasks.clear();
+    }
+    else
+    {
+        for (Uint32 Worker = 0; Worker < NumWorkers; ++Worker)
+            RecordRange(State, Worker, GetRangeStart(Worker), GetRangeStart(Worker + 1) - GetRangeStart(Worker), Record);
+    }
+
+    if (pBatch != nullptr)
+    {
+        const Uint32 FirstSlot = pBatch->ReserveSlots(NumWorkers);
+        for (Uint32 Worker = 0; Worker < NumWorkers; ++Worker)
+        {
+            VERIFY(m_CmdLists[Worker], "Command list ", Worker, " has not been recorded");
+            pBatch->SetCommandList(FirstSlot + Worker, m_CmdLists[Worker]);
+            m_CmdLists[Worker].Release();
+        }
+        return;
+    }
+
+    m_CmdListPtrs.resize(NumWorkers);
+    for (Uint32 Worker = 0; Worker < NumWorkers; ++Worker)
+    {
+        VERIFY(m_CmdLists[Worker], "Command list ", Worker, " has not been recorded");
+        m_CmdListPtrs[Worker] = m_CmdLists[Worker];
+    }
+
+    m_pImmediateCtx->ExecuteCommandLists(NumWorkers, m_CmdListPtrs.data());
+
+    // Command lists can only be executed once, so release them right away.
+    for (Uint32 Worker = 0; Worker < NumWorkers; ++Worker)
+    {
+        m_CmdListPtrs[Worker] = nullptr;
+        m_CmdLists[Worker].Release();
+    }
+}
+
+void ParallelRecorder::FinishFrame()
+{
+    for (auto& pCtx : m_DeferredCtxs)
+        pCtx->FinishFrame();
+}
+
+} // namespace Diligent
@@ -0,0 +1,392 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "PassScheduler.hpp"
+
+#include <algorithm>
+
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/BottomLevelAS.h"
+#include "../../GraphicsEngine/interface/TopLevelAS.h"
+#include "ScopedDebugGroup.hpp"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// States that are allowed in compute queues (see VerifyResourceState)
+constexpr RESOURCE_STATE ComputeQueueStates =
+    RESOURCE_STATE_UNDEFINED |
+    RESOURCE_STATE_COPY_DEST |
+    RESOURCE_STATE_COPY_SOURCE |
+    RESOURCE_STATE_COMMON |
+    RESOURCE_STATE_CONSTANT_BUFFER |
+    RESOURCE_STATE_UNORDERED_ACCESS |
+    RESOURCE_STATE_SHADER_RESOURCE |
+    RESOURCE_STATE_INDIRECT_ARGUMENT |
+    RESOURCE_STATE_BUILD_AS_READ |
+    RESOURCE_STATE_BUILD_AS_WRITE |
+    RESOURCE_STATE_RAY_TRACING;
+
+constexpr RESOURCE_STATE WriteStates =
+    RESOURCE_STATE_UNORDERED_ACCESS |
+    RESOURCE_STATE_RENDER_TARGET |
+    RESOURCE_STATE_DEPTH_WRITE |
+    RESOURCE_STATE_STREAM_OUT |
+    RESOURCE_STATE_COPY_DEST |
+    RESOURCE_STATE_RESOLVE_DEST |
+    RESOURCE_STATE_BUILD_AS_WRITE;
+
+RESOURCE_STATE GetResourceState(IDeviceObject* pResource)
+{
+    if (RefCntAutoPtr<ITexture> pTexture{pResource, IID_Texture})
+        return pTexture->GetState();
+    if (RefCntAutoPtr<IBuffer> pBuffer{pResource, IID_Buffer})
+        return pBuffer->GetState();
+    if (RefCntAutoPtr<IBottomLevelAS> pBLAS{pResource, IID_BottomLevelAS})
+        return pBLAS->GetState();
+    if (RefCntAutoPtr<ITopLevelAS> pTLAS{pResource, IID_TopLevelAS})
+        return pTLAS->GetState();
+
+    UNEXPECTED("Unexpected resource type");
+    return RESOURCE_STATE_UNKNOWN;
+}
+
+StateTransitionDesc GetTransition(IDeviceObject* pResource, RESOURCE_STATE NewState, STATE_TRANSITION_TYPE Type)
+{
+    StateTransitionDesc Barrier;
+    Barrier.pResource = pResource;
+    // Let the engine use the current resource state
+    Barrier.OldState       = RESOURCE_STATE_UNKNOWN;
+    Barrier.NewState       = NewState;
+    Barrier.TransitionType = Type;
+    // The state can't be updated by begin-split barriers
+    Barrier.Flags = Type != STATE_TRANSITION_TYPE_BEGIN ? STATE_TRANSITION_FLAG_UPDATE_STATE : STATE_TRANSITION_FLAG_NONE;
+    return Barrier;
+}
+
+} // namespace
+
+PassScheduler::PassScheduler(const CreateInfo& CI) noexcept(false) :
+    m_pDevice{CI.pDevice},
+    m_NumQueues{CI.pComputeCtx != nullptr && CI.pComputeCtx != CI.pGraphicsCtx ? 2u : 1u}
+{
+    if (CI.pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Device must not be null");
+    if (CI.pGraphicsCtx == nullptr)
+        LOG_ERROR_AND_THROW("Graphics context must not be null");
+    DEV_CHECK_ERR(!CI.pGraphicsCtx->GetDesc().IsDeferred && (CI.pComputeCtx == nullptr || !CI.pComputeCtx->GetDesc().IsDeferred),
+                  "Fence waits are only allowed in immediate contexts");
+
+    m_Queues[0].pCtx = CI.pGraphicsCtx;
+    if (m_NumQueues > 1)
+        m_Queues[1].pCtx = CI.pComputeCtx;
+
+    for (Uint32 q = 0; q < m_NumQueues; ++q)
+    {
+        FenceDesc Desc;
+        Desc.Name = q == 0 ? "Pass scheduler graphics queue fence" : "Pass scheduler compute queue fence";
+        Desc.Type = FENCE_TYPE_GENERAL;
+        m_pDevice->CreateFence(Desc, &m_Queues[q].pFence);
+        if (!m_Queues[q].pFence)
+            LOG_ERROR_AND_THROW("Failed to create pass scheduler fence");
+    }
+
+    // Prologue pass
+    m_Passes.emplace_back();
+    m_Passes[0].Name = "Pass scheduler prologue";
+}
+
+void PassScheduler::AddPass(const char*           Name,
+                            PASS_TYPE             Type,
+                            const ResourceAccess* pAccesses,
+                            Uint32                NumAccesses,
+                            ExecutePassFuncType   Execute)
+{
+    DEV_CHECK_ERR(NumAccesses == 0 || pAccesses != nullptr, "pAccesses must not be null when NumAccesses is not zero");
+
+    m_Passes.emplace_back();
+    auto& NewPass    = m_Passes.back();
+    NewPass.Name     = Name != nullptr ? Name : "";
+    NewPass.QueueIdx = GetQueueIndex(Type);
+    NewPass.Accesses.assign(pAccesses, pAccesses + NumAccesses);
+    NewPass.Execute = std::move(Execute);
+
+#ifdef DILIGENT_DEVELOPMENT
+    for (const auto& Access : NewPass.Accesses)
+    {
+        DEV_CHECK_ERR(Access.pResource != nullptr, "Resource in pass '", NewPass.Name, "' must not be null");
+        DEV_CHECK_ERR(Access.State != RESOURCE_STATE_UNKNOWN, "Resource state in pass '", NewPass.Name, "' must not be unknown");
+        DEV_CHECK_ERR(Type != PASS_TYPE_COMPUTE || (Access.State & ~ComputeQueueStates) == 0,
+                      "Compute pass '", NewPass.Name, "' accesses a resource in a state that is not supported by compute queues");
+    }
+#endif
+}
+
+PassScheduler::ResourceHistory& PassScheduler::GetHistory(IDeviceObject* pResource)
+{
+    auto it = m_Resources.find(pResource);
+    if (it != m_Resources.end() && !it->second.wpResource.IsValid())
+    {
+        // The object has been destroyed and a new one was created at the same address
+        m_Resources.erase(it);
+        it = m_Resources.end();
+    }
+
+    if (it == m_Resources.end())
+    {
+        auto& History      = m_Resources[pResource];
+        History.wpResource = RefCntWeakPtr<IDeviceObject>{pResource};
+        return History;
+    }
+
+    return it->second;
+}
+
+void PassScheduler::AddDependency(Pass& Dst, Uint32 SrcQueue, const SyncPoint& Src)
+{
+    if (SrcQueue == Dst.QueueIdx || !Src.IsValid())
+        return;
+
+    if (Src.Pass >= 0)
+    {
+        Dst.WaitPass[SrcQueue]    = std::max(Dst.WaitPass[SrcQueue], Src.Pass);
+        m_Passes[Src.Pass].Signal = true;
+    }
+    else
+    {
+        Dst.WaitValue[SrcQueue] = std::max(Dst.WaitValue[SrcQueue], Src.Value);
+    }
+}
+
+void PassScheduler::SchedulePass(int PassIdx)
+{
+    auto&        P = m_Passes[PassIdx];
+    const Uint32 q = P.QueueIdx;
+
+    for (const auto& Access : P.Accesses)
+    {
+        auto& History = GetHistory(Access.pResource);
+        if (History.LastPass < 0)
+        {
+            // The first access in this frame
+            History.State = GetResourceState(Access.pResource);
+        }
+
+        const auto OldState = History.State;
+        // Unknown states are managed by the application
+        const bool NeedsTransition =
+            OldState != RESOURCE_STATE_UNKNOWN &&
+            ((OldState & Access.State) != Access.State ||
+             (OldState == RESOURCE_STATE_UNORDERED_ACCESS && Access.State == RESOURCE_STATE_UNORDERED_ACCESS));
+
+        // State transitions are treated as writes
+        const bool IsWrite = (Access.State & WriteStates) != 0 || NeedsTransition;
+
+        // Compute queues can't transition resources from graphics states, so the graphics
+        // queue performs the transition after the last graphics pass that used the resource.
+        const bool TransitionOnGraphicsQueue = NeedsTransition && q != 0 && (OldState & ~ComputeQueueStates) != 0;
+
+        // Read-after-write and write-after-write dependency
+        AddDependency(P, History.LastWriteQueue, History.LastWrite);
+        // Write-after-read dependencies
+        if (IsWrite && !TransitionOnGraphicsQueue)
+        {
+            for (Uint32 p = 0; p < m_NumQueues; ++p)
+                AddDependency(P, p, History.LastRead[p]);
+        }
+
+        if (TransitionOnGraphicsQueue)
+        {
+            // Any compute queue accesses since the graphics queue set the current state have
+            // been waited for, so the transition only needs to be ordered with the graphics queue.
+            const int TransitionPass = History.LastPass >= 0 && History.LastPassQueue == 0 ? History.LastPass : 0;
+            m_Passes[TransitionPass].BarriersAfter.emplace_back(GetTransition(Access.pResource, Access.State, STATE_TRANSITION_TYPE_IMMEDIATE));
+
+            SyncPoint Transition;
+            Transition.Pass = TransitionPass;
+            AddDependency(P, 0, Transition);
+
+            History.LastWrite      = Transition;
+            History.LastWriteQueue = 0;
+            for (auto& Read : History.LastRead)
+                Read = {};
+        }
+        else if (NeedsTransition)
+        {
+            const bool IsUAVBarrier = OldState == RESOURCE_STATE_UNORDERED_ACCESS && Access.State == RESOURCE_STATE_UNORDERED_ACCESS;
+
+            // Use a split barrier if other passes on the same queue are executed between the accesses and
+            // no cross-queue waits are needed, since the waits would have to precede the begin barrier.
+            bool UseSplitBarrier = false;
+            if (!IsUAVBarrier && History.LastPass >= 0 && History.LastPassQueue == q &&
+                P.WaitPass[1 - q] < 0 && P.WaitValue[1 - q] == 0)
+            {
+                for (int i = History.LastPass + 1; i < PassIdx && !UseSplitBarrier; ++i)
+                    UseSplitBarrier = m_Passes[i].QueueIdx == q;
+            }
+
+            if (UseSplitBarrier)
+            {
+                m_Passes[History.LastPass].BarriersAfter.emplace_back(GetTransition(Access.pResource, Access.State, STATE_TRANSITION_TYPE_BEGIN));
+                P.BarriersBefore.emplace_back(GetTransition(Access.pResource, Access.State, STATE_TRANSITION_TYPE_END));
+            }
+            else
+            {
+                P.BarriersBefore.emplace_back(GetTransition(Access.pResource, Access.State, STATE_TRANSITION_TYPE_IMMEDIATE));
+            }
+        }
+
+        SyncPoint ThisPass;
+        ThisPass.Pass = PassIdx;
+        if ((Access.State & WriteStates) != 0 || (NeedsTransition && !TransitionOnGraphicsQueue))
+        {
+            History.LastWrite      = ThisPass;
+            History.LastWriteQueue = q;
+            for (auto& Read : History.LastRead)
+                Read = {};
+        }
+        else
+        {
+            History.LastRead[q] = ThisPass;
+        }
+
+        History.LastPass      = PassIdx;
+        History.LastPassQueue = q;
+        if (NeedsTransition)
+            History.State = Access.State;
+    }
+}
+
+void PassScheduler::Signal(Uint32 QueueIdx, Uint64& Value)
+{
+    auto& Q = m_Queues[QueueIdx];
+    Value   = ++Q.LastSignaledValue;
+    Q.pCtx->EnqueueSignal(Q.pFence, Value);
+    // The signal must be submitted before the other queue submits the wait
+    Q.pCtx->Flush();
+}
+
+void PassScheduler::ExecutePass(Pass& P)
+{
+    auto& Q = m_Queues[P.QueueIdx];
+
+    for (Uint32 p = 0; p < m_NumQueues; ++p)
+    {
+        Uint64 WaitValue = P.WaitValue[p];
+        if (P.WaitPass[p] >= 0)
+        {
+            const auto& SrcPass = m_Passes[P.WaitPass[p]];
+            VERIFY(SrcPass.Signal && SrcPass.SignalValue != 0, "Pass '", SrcPass.Name, "' must have been executed and signaled the fence. This is a bug.");
+            WaitValue = std::max(WaitValue, SrcPass.SignalValue);
+        }
+
+        if (WaitValue > Q.LastWaitedValue[p])
+        {
+            Q.pCtx->DeviceWaitForFence(m_Queues[p].pFence, WaitValue);
+            Q.LastWaitedValue[p] = WaitValue;
+        }
+    }
+
+    if (!P.BarriersBefore.empty())
+        Q.pCtx->TransitionResourceStates(static_cast<Uint32>(P.BarriersBefore.size()), P.BarriersBefore.data());
+
+    if (P.Execute)
+    {
+        ScopedDebugGroup DebugGroup{Q.pCtx, P.Name};
+        P.Execute(Q.pCtx);
+    }
+
+    if (!P.BarriersAfter.empty())
+        Q.pCtx->TransitionResourceStates(static_cast<Uint32>(P.BarriersAfter.size()), P.BarriersAfter.data());
+
+    if (P.Signal)
+        Signal(P.QueueIdx, P.SignalValue);
+}
+
+void PassScheduler::Execute()
+{
+    bool QueueUsed[MaxQueues] = {};
+    for (int i = 1; i < static_cast<int>(m_Passes.size()); ++i)
+    {
+        SchedulePass(i);
+        QueueUsed[m_Passes[i].QueueIdx] = true;
+    }
+
+    for (auto& P : m_Passes)
+        ExecutePass(P);
+
+    // Signal the end of the frame on every queue so that the passes of the next
+    // frames can wait for the accesses made by this frame.
+    Uint64 EndValue[MaxQueues] = {};
+    for (Uint32 q = 0; q < m_NumQueues; ++q)
+    {
+        if (QueueUsed[q])
+            Signal(q, EndValue[q]);
+        else
+            EndValue[q] = m_Queues[q].LastSignaledValue;
+    }
+
+    for (auto it = m_Resources.begin(); it != m_Resources.end();)
+    {
+        auto& History = it->second;
+        if (!History.wpResource.IsValid())
+        {
+            it = m_Resources.erase(it);
+            continue;
+        }
+
+        if (History.LastWrite.Pass >= 0)
+        {
+            History.LastWrite.Value = EndValue[History.LastWriteQueue];
+            History.LastWrite.Pass  = -1;
+        }
+        for (Uint32 q = 0; q < m_NumQueues; ++q)
+        {
+            auto& Read = History.LastRead[q];
+            if (Read.Pass >= 0)
+            {
+                Read.Value = EndValue[q];
+                Read.Pass  = -1;
+            }
+        }
+        History.LastPass = -1;
+        History.State    = RESOURCE_STATE_UNKNOWN;
+        ++it;
+    }
+
+    m_Passes.resize(1);
+    m_Passes[0].BarriersAfter.clear();
+    m_Passes[0].Signal      = false;
+    m_Passes[0].SignalValue = 0;
+}
+
+} // namespace Diligent
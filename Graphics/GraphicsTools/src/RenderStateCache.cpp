@@ -33,6 +33,9 @@
 #include <memory>
 #include <unordered_set>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <algorithm>
 
 #include "Archiver.h"
 #include "Dearchiver.h"
@@ -41,12 +44,17 @@
 
 #include "ObjectBase.hpp"
 #include "ShaderBase.hpp"
+#include "DeviceObjectArchive.hpp"
+#include "DataBlobImpl.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "SerializationDevice.h"
 #include "SerializedShader.h"
 #include "XXH128Hasher.hpp"
 #include "CallbackWrapper.hpp"
 #include "GraphicsUtilities.h"
+#include "ShaderToolsCommon.hpp"
+#include "CacheFileJournal.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -95,6 +103,95 @@ namespace Diligent
 
 class RenderStateCacheImpl;
 
+/// Hash map of weak object references that is split into shards with individual locks,
+/// so that threads that look up different keys rarely compete for the same mutex.
+template <typename KeyType, typename ObjectType>
+class ShardedWeakPtrMap
+{
+public:
+    /// Returns a strong reference to the object associated with the key, or null if the
+    /// key is not found or the object has been released. Expired entries are removed.
+    RefCntAutoPtr<ObjectType> Get(const KeyType& Key)
+    {
+        auto& Shard = GetShard(Key);
+
+        std::lock_guard<std::mutex> Guard{Shard.Mtx};
+
+        auto it = Shard.Map.find(Key);
+        if (it == Shard.Map.end())
+            return {};
+
+        auto pObject = it->second.Lock();
+        if (!pObject)
+            Shard.Map.erase(it);
+
+        return pObject;
+    }
+
+    /// Adds the object to the map. If the key is already present, the map is not modified.
+    void Add(const KeyType& Key, ObjectType* pObject)
+    {
+        auto& Shard = GetShard(Key);
+
+        std::lock_guard<std::mutex> Guard{Shard.Mtx};
+        Shard.Map.emplace(Key, RefCntWeakPtr<ObjectType>{pObject});
+    }
+
+    void Clear()
+    {
+        for (auto& Shard : m_Shards)
+        {
+            std::lock_guard<std::mutex> Guard{Shard.Mtx};
+            Shard.Map.clear();
+        }
+    }
+
+    /// Returns strong references to all objects that are still alive, so that the caller
+    /// can process them without holding any lock.
+    std::vector<RefCntAutoPtr<ObjectType>> GetObjects()
+    {
+        std::vector<RefCntAutoPtr<ObjectType>> Objects;
+        for (auto& Shard : m_Shards)
+        {
+            std::lock_guard<std::mutex> Guard{Shard.Mtx};
+            Objects.reserve(Objects.size() + Shard.Map.size());
+            for (auto it = Shard.Map.begin(); it != Shard.Map.end();)
+            {
+                if (auto pObject = it->second.Lock())
+                {
+                    Objects.emplace_back(std::move(pObject));
+                    ++it;
+                }
+                else
+                {
+                    it = Shard.Map.erase(it);
+                }
+            }
+        }
+        return Objects;
+    }
+
+private:
+    static constexpr Uint32 NumShardsLog2 = 4;
+    static constexpr size_t NumShards     = size_t{1} << NumShardsLog2;
+
+    struct ShardType
+    {
+        std::mutex                                             Mtx;
+        std::unordered_map<KeyType, RefCntWeakPtr<ObjectType>> Map;
+    };
+
+    ShardType& GetShard(const KeyType& Key)
+    {
+        // Pointer hashes typically have zero low bits, so use Fibonacci hashing to
+        // select the shard from the upper bits of the product.
+        const Uint64 Hash = static_cast<Uint64>(std::hash<KeyType>{}(Key)) * Uint64{0x9E3779B97F4A7C15ull};
+        return m_Shards[static_cast<size_t>(Hash >> (64u - NumShardsLog2))];
+    }
+
+    std::array<ShardType, NumShards> m_Shards;
+};
+
 
 /// Reloadable shader implements the IShader interface and delegates all
 /// calls to the internal shader object, which can be replaced at run-time.
@@ -167,7 +264,15 @@ public:
         }
     }
 
-    bool Reload();
+    /// Creates the shader from the current sources. The internal shader is not replaced.
+    RefCntAutoPtr<IShader> CreateReloadedShader(bool& FoundInCache);
+
+    /// Replaces the internal shader.
+    void SetShader(IShader* pShader) { m_pShader = pShader; }
+
+    IShader* GetInternalShader() const { return m_pShader.RawPtr<IShader>(); }
+
+    const ShaderCreateInfo& GetCreateInfo() const { return m_CreateInfo.Get(); }
 
 private:
     RefCntAutoPtr<RenderStateCacheImpl> m_pStateCache;
@@ -233,6 +338,7 @@ public:
     PROXY_CONST_METHOD1(m_pPipeline, bool, IsCompatibleWith, const IPipelineState*, pPSO)
     PROXY_CONST_METHOD(m_pPipeline, Uint32, GetResourceSignatureCount)
     PROXY_CONST_METHOD1(m_pPipeline, IPipelineResourceSignature*, GetResourceSignature, Uint32, Index)
+    PROXY_METHOD1(m_pPipeline, PIPELINE_STATE_STATUS, GetStatus, Bool, WaitForCompletion)
 
     static void Create(RenderStateCacheImpl*          pStateCache,
                        IPipelineState*                pPipeline,
@@ -250,11 +356,22 @@ public:
         }
     }
 
-    bool Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData);
+    /// Lets the application modify the create info of a graphics pipeline before it is reloaded.
+    void ModifyCreateInfo(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData);
+
+    /// Creates the pipeline from the current create info. The internal pipeline is not replaced.
+    RefCntAutoPtr<IPipelineState> CreateReloadedPipeline(bool& FoundInCache);
+
+    /// Replaces the internal pipeline and copies static resources to the new pipeline.
+    void SetPipeline(IPipelineState* pPipeline);
+
+    /// Returns true if the pipeline uses any of the shaders.
+    bool UsesAnyShader(const std::unordered_set<const IShader*>& Shaders) const;
 
 private:
-    template <typename CreateInfoType>
-    bool Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData);
+    // Calls the handler with the create info wrapper of the pipeline type
+    template <typename HandlerType>
+    void ProcessCreateInfo(HandlerType&& Handler);
 
     struct DynamicHeapObjectBase
     {
@@ -271,6 +388,9 @@ private:
     RefCntAutoPtr<IPipelineState>          m_pPipeline;
     std::unique_ptr<DynamicHeapObjectBase> m_pCreateInfo;
     const PIPELINE_TYPE                    m_Type;
+
+    // Reloadable shaders referenced by the create info
+    std::vector<const IShader*> m_Shaders;
 };
 
 constexpr INTERFACE_ID ReloadablePipelineState::IID_InternalImpl;
@@ -291,7 +411,13 @@ public:
     virtual bool DILIGENT_CALL_TYPE Load(const IDataBlob* pArchive,
                                          bool             MakeCopy) override final
     {
-        return m_pDearchiver->LoadArchive(pArchive, MakeCopy);
+        if (!m_pDearchiver->LoadArchive(pArchive, MakeCopy))
+            return false;
+
+        if (m_pJournal)
+            m_pJournal->Append(DataBlobImpl::Create(pArchive->GetSize(), pArchive->GetConstDataPtr()));
+
+        return true;
     }
 
     virtual bool DILIGENT_CALL_TYPE CreateShader(const ShaderCreateInfo& ShaderCI,
@@ -365,10 +491,25 @@ public:
     {
         m_pDearchiver->Reset();
         m_pArchiver->Reset();
-        m_Shaders.clear();
-        m_ReloadableShaders.clear();
-        m_Pipelines.clear();
-        m_ReloadablePipelines.clear();
+        m_Shaders.Clear();
+        m_ReloadableShaders.Clear();
+        m_Pipelines.Clear();
+        m_ReloadablePipelines.Clear();
+        {
+            std::lock_guard<std::mutex> Guard{m_SourceHashesMtx};
+            m_SourceHashes.clear();
+            m_FileHashes.clear();
+        }
+
+        if (m_pJournal)
+        {
+            {
+                std::lock_guard<std::mutex> Guard{m_JournalMtx};
+                m_pJournalArchiver->Reset();
+                m_HasPendingJournalData = false;
+            }
+            m_pJournal->Clear();
+        }
     }
 
     virtual Uint32 DILIGENT_CALL_TYPE Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData) override final;
@@ -382,20 +523,17 @@ public:
 
     RefCntAutoPtr<IShader> FindReloadableShader(IShader* pShader)
     {
-        std::lock_guard<std::mutex> Guard{m_ReloadableShadersMtx};
+        return m_ReloadableShaders.Get(pShader);
+    }
 
-        auto it = m_ReloadableShaders.find(pShader);
-        if (it == m_ReloadableShaders.end())
-            return {};
+private:
+    static RefCntAutoPtr<IDataBlob> MergeArchives(const std::vector<RefCntAutoPtr<IDataBlob>>& Archives);
 
-        auto pReloadableShader = it->second.Lock();
-        if (!pReloadableShader)
-            m_ReloadableShaders.erase(it);
+    RefCntAutoPtr<IDataBlob> ReadPendingJournalData();
 
-        return pReloadableShader;
-    }
+    template <typename AddObjectType>
+    void AddToJournal(AddObjectType&& AddObject);
 
-private:
     static std::string HashToStr(Uint64 Low, Uint64 High)
     {
         static constexpr std::array<char, 16> Symbols = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
@@ -428,6 +566,26 @@ private:
     bool CreatePipelineState(const CreateInfoType& PSOCreateInfo,
                              IPipelineState**      ppPipelineState);
 
+    XXH128Hash ComputeShaderHash(const ShaderCreateInfo& ShaderCI);
+    XXH128Hash GetShaderSourceHash(const ShaderCreateInfo& ShaderCI);
+
+    static XXH128Hash ComputeFileHash(const char* Source, size_t SourceLength)
+    {
+        XXH128State Hasher;
+        Hasher.UpdateStr(Source, SourceLength);
+        return Hasher.Digest();
+    }
+
+    // Removes the source hashes that depend on the files that have changed since the hashes were computed.
+    void InvalidateChangedSources();
+
+    // Returns true if the source of the shader may have changed since the shader was created.
+    bool IsShaderSourceChanged(const ShaderCreateInfo& ShaderCI);
+
+    // Calls Handler(i) for every i in [0, NumItems), using the reload thread pool when possible.
+    template <typename HandlerType>
+    void ProcessInParallel(size_t NumItems, HandlerType&& Handler);
+
 private:
     RefCntAutoPtr<IRenderDevice>                   m_pDevice;
     const RENDER_DEVICE_TYPE                       m_DeviceType;
@@ -437,17 +595,64 @@ private:
     RefCntAutoPtr<IArchiver>                       m_pArchiver;
     RefCntAutoPtr<IDearchiver>                     m_pDearchiver;
 
-    std::mutex                                             m_ShadersMtx;
-    std::unordered_map<XXH128Hash, RefCntWeakPtr<IShader>> m_Shaders;
+    ShardedWeakPtrMap<XXH128Hash, IShader>             m_Shaders;
+    ShardedWeakPtrMap<IShader*, IShader>               m_ReloadableShaders;
+    ShardedWeakPtrMap<XXH128Hash, IPipelineState>      m_Pipelines;
+    ShardedWeakPtrMap<IPipelineState*, IPipelineState> m_ReloadablePipelines;
+
+    // Digests of shaders, signatures and render passes referenced by pipeline create infos,
+    // so that pipeline hashing does not re-hash the shader bytecode and nested descriptions.
+    XXH128DigestCache m_ObjectDigests;
+
+    // Hashes of shader sources loaded from files, including all includes.
+    // Hashing the source requires reading and preprocessing all files, so the result is
+    // reused until the cache is reset or reloaded.
+    struct SourceHashKey
+    {
+        std::string                      FilePath;
+        IShaderSourceInputStreamFactory* pFactory = nullptr;
+
+        bool operator==(const SourceHashKey& RHS) const
+        {
+            return pFactory == RHS.pFactory && FilePath == RHS.FilePath;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const SourceHashKey& Key) const
+            {
+                return ComputeHash(Key.FilePath, Key.pFactory);
+            }
+        };
+    };
+    struct SourceHashInfo
+    {
+        // The factory is tracked to detect when a different factory is created at the same address
+        RefCntWeakPtr<IShaderSourceInputStreamFactory> pFactory;
+        XXH128Hash                                     Hash;
+
+        // Source file and all its includes. Only recorded when hot reload is enabled.
+        std::vector<std::string> Files;
+    };
+    std::mutex                                                               m_SourceHashesMtx;
+    std::unordered_map<SourceHashKey, SourceHashInfo, SourceHashKey::Hasher> m_SourceHashes;
+
+    // Hashes of the individual source files that the sources in m_SourceHashes depend on.
+    // When the cache is reloaded, only the files are read again, and the sources that
+    // depend on the changed files are invalidated. Protected by m_SourceHashesMtx.
+    std::unordered_map<SourceHashKey, SourceHashInfo, SourceHashKey::Hasher> m_FileHashes;
 
-    std::mutex                                           m_ReloadableShadersMtx;
-    std::unordered_map<IShader*, RefCntWeakPtr<IShader>> m_ReloadableShaders;
+    // Creates the shaders and pipelines when the cache is reloaded.
+    RefCntAutoPtr<IThreadPool> m_pReloadThreadPool;
 
-    std::mutex                                                    m_PipelinesMtx;
-    std::unordered_map<XXH128Hash, RefCntWeakPtr<IPipelineState>> m_Pipelines;
+    // Receives the same objects as m_pArchiver. The objects are serialized and
+    // appended to the cache file by the background task of m_pJournal.
+    std::mutex               m_JournalMtx;
+    RefCntAutoPtr<IArchiver> m_pJournalArchiver;
+    bool                     m_HasPendingJournalData = false;
 
-    std::mutex                                                         m_ReloadablePipelinesMtx;
-    std::unordered_map<IPipelineState*, RefCntWeakPtr<IPipelineState>> m_ReloadablePipelines;
+    // Must be destroyed first as it waits for the background tasks that access m_pJournalArchiver
+    std::unique_ptr<CacheFileJournal> m_pJournal;
 };
 
 RenderStateCacheImpl::RenderStateCacheImpl(IReferenceCounters*               pRefCounters,
@@ -519,6 +724,88 @@ RenderStateCacheImpl::RenderStateCacheImpl(IReferenceCounters*               pRe
     m_pDevice->GetEngineFactory()->CreateDearchiver(DearchiverCI, &m_pDearchiver);
     if (!m_pDearchiver)
         LOG_ERROR_AND_THROW("Failed to create dearchiver");
+
+    if (CreateInfo.FilePath != nullptr)
+    {
+        pArchiverFactory->CreateArchiver(m_pSerializationDevice, &m_pJournalArchiver);
+        if (!m_pJournalArchiver)
+            LOG_ERROR_AND_THROW("Failed to create journal archiver");
+
+        CacheFileJournal::CreateInfo JournalCI;
+        JournalCI.FilePath            = CreateInfo.FilePath;
+        JournalCI.Magic               = DeviceObjectArchive::HeaderMagicNumber;
+        JournalCI.Version             = DeviceObjectArchive::ArchiveVersion;
+        JournalCI.pThreadPool         = CreateInfo.pWriterThreadPool;
+        JournalCI.CompactionThreshold = CreateInfo.CompactionThreshold;
+        JournalCI.ReadPendingData     = [this]() {
+            return ReadPendingJournalData();
+        };
+        JournalCI.MergeRecords = MergeArchives;
+
+        m_pJournal = std::make_unique<CacheFileJournal>(JournalCI);
+
+        const auto Records = m_pJournal->Load();
+        if (!Records.empty())
+        {
+            auto pData = Records.size() > 1 ? MergeArchives(Records) : Records.front();
+            if (!pData || !m_pDearchiver->LoadArchive(pData))
+            {
+                LOG_WARNING_MESSAGE("Failed to load render states from file '", CreateInfo.FilePath, "'. The file will be cleared.");
+                m_pJournal->Clear();
+            }
+        }
+    }
+}
+
+RefCntAutoPtr<IDataBlob> RenderStateCacheImpl::MergeArchives(const std::vector<RefCntAutoPtr<IDataBlob>>& Archives)
+{
+    try
+    {
+        DeviceObjectArchive MergedArchive;
+        for (const auto& pArchive : Archives)
+            MergedArchive.Merge(DeviceObjectArchive{pArchive});
+
+        RefCntAutoPtr<IDataBlob> pData;
+        MergedArchive.Serialize(&pData);
+        return pData;
+    }
+    catch (...)
+    {
+        LOG_ERROR_MESSAGE("Failed to merge render state archives");
+        return {};
+    }
+}
+
+RefCntAutoPtr<IDataBlob> RenderStateCacheImpl::ReadPendingJournalData()
+{
+    std::lock_guard<std::mutex> Guard{m_JournalMtx};
+    if (!m_HasPendingJournalData)
+        return {};
+
+    RefCntAutoPtr<IDataBlob> pData;
+    if (!m_pJournalArchiver->SerializeToBlob(&pData))
+        LOG_ERROR_MESSAGE("Failed to serialize render state data");
+
+    m_pJournalArchiver->Reset();
+    m_HasPendingJournalData = false;
+
+    return pData;
+}
+
+template <typename AddObjectType>
+void RenderStateCacheImpl::AddToJournal(AddObjectType&& AddObject)
+{
+    if (!m_pJournal)
+        return;
+
+    {
+        std::lock_guard<std::mutex> Guard{m_JournalMtx};
+        if (!AddObject(m_pJournalArchiver.RawPtr()))
+            return;
+
+        m_HasPendingJournalData = true;
+    }
+    m_pJournal->RequestWrite();
 }
 
 #define RENDER_STATE_CACHE_LOG(Level, ...)                         \
@@ -551,18 +838,8 @@ bool RenderStateCacheImpl::CreateShader(const ShaderCreateInfo& ShaderCI,
     if (m_CI.EnableHotReload)
     {
         // Wrap shader in a reloadable shader object
-        {
-            std::lock_guard<std::mutex> Guard{m_ReloadableShadersMtx};
-
-            auto it = m_ReloadableShaders.find(pShader);
-            if (it != m_ReloadableShaders.end())
-            {
-                if (auto pReloadableShader = it->second.Lock())
-                    *ppShader = pReloadableShader.Detach();
-                else
-                    m_ReloadableShaders.erase(it);
-            }
-        }
+        if (auto pReloadableShader = m_ReloadableShaders.Get(pShader))
+            *ppShader = pReloadableShader.Detach();
 
         if (*ppShader == nullptr)
         {
@@ -570,9 +847,7 @@ bool RenderStateCacheImpl::CreateShader(const ShaderCreateInfo& ShaderCI,
             if (m_pReloadSource)
                 _ShaderCI.pShaderSourceStreamFactory = m_pReloadSource;
             ReloadableShader::Create(this, pShader, _ShaderCI, ppShader);
-
-            std::lock_guard<std::mutex> Guard{m_ReloadableShadersMtx};
-            m_ReloadableShaders.emplace(pShader, RefCntWeakPtr<IShader>{*ppShader});
+            m_ReloadableShaders.Add(pShader, *ppShader);
         }
     }
     else
@@ -583,38 +858,97 @@ bool RenderStateCacheImpl::CreateShader(const ShaderCreateInfo& ShaderCI,
     return FoundInCache;
 }
 
-bool RenderStateCacheImpl::CreateShaderInternal(const ShaderCreateInfo& ShaderCI,
-                                                IShader**               ppShader)
+XXH128Hash RenderStateCacheImpl::GetShaderSourceHash(const ShaderCreateInfo& ShaderCI)
 {
-    VERIFY_EXPR(ppShader != nullptr && *ppShader == nullptr);
+    VERIFY_EXPR(ShaderCI.FilePath != nullptr && ShaderCI.Source == nullptr);
+
+    SourceHashKey Key{ShaderCI.FilePath, ShaderCI.pShaderSourceStreamFactory};
+    {
+        std::lock_guard<std::mutex> Guard{m_SourceHashesMtx};
+
+        auto it = m_SourceHashes.find(Key);
+        if (it != m_SourceHashes.end())
+        {
+            if (it->second.pFactory.Lock() == ShaderCI.pShaderSourceStreamFactory)
+                return it->second.Hash;
+            m_SourceHashes.erase(it);
+        }
+    }
 
     XXH128State Hasher;
+
+    // File hashes are used to find the sources that need to be reloaded
+    std::vector<std::pair<std::string, XXH128Hash>> FileHashes;
+
+    const auto Succeeded = ProcessShaderIncludes(ShaderCI, [&](const ShaderIncludePreprocessInfo& ProcessInfo) {
+        Hasher.UpdateStr(ProcessInfo.Source, ProcessInfo.SourceLength);
+        if (m_CI.EnableHotReload)
+            FileHashes.emplace_back(ProcessInfo.FilePath, ComputeFileHash(ProcessInfo.Source, ProcessInfo.SourceLength));
+    });
+    const auto Hash      = Hasher.Digest();
+
+    // Do not remember the hash if some file could not be loaded, so that the
+    // error is reported again and the hash is recomputed once the file is available.
+    if (Succeeded)
+    {
+        RefCntWeakPtr<IShaderSourceInputStreamFactory> pFactory{ShaderCI.pShaderSourceStreamFactory};
+
+        SourceHashInfo SourceInfo{pFactory, Hash, {}};
+        SourceInfo.Files.reserve(FileHashes.size());
+
+        std::lock_guard<std::mutex> Guard{m_SourceHashesMtx};
+        for (auto& FileHash : FileHashes)
+        {
+            SourceInfo.Files.emplace_back(FileHash.first);
+            // If the file is already known, keep its original hash: other sources may have been
+            // hashed with the previous version of the file and must be invalidated when it changes.
+            m_FileHashes.emplace(SourceHashKey{std::move(FileHash.first), ShaderCI.pShaderSourceStreamFactory}, SourceHashInfo{pFactory, FileHash.second, {}});
+        }
+        m_SourceHashes.emplace(std::move(Key), std::move(SourceInfo));
+    }
+
+    return Hash;
+}
+
+XXH128Hash RenderStateCacheImpl::ComputeShaderHash(const ShaderCreateInfo& ShaderCI)
+{
 #ifdef DILIGENT_DEBUG
     constexpr bool IsDebug = true;
 #else
     constexpr bool IsDebug = false;
 #endif
-    Hasher.Update(ShaderCI, m_DeviceType, IsDebug);
-    const auto Hash = Hasher.Digest();
 
-    // First, try to check if the shader has already been requested
+    XXH128State Hasher;
+    if (ShaderCI.FilePath != nullptr && ShaderCI.Source == nullptr)
     {
-        std::lock_guard<std::mutex> Guard{m_ShadersMtx};
+        // Hash the create info without the file path and use the memoized source hash instead
+        // of reading and preprocessing the source file with all its includes.
+        const auto SourceHash = GetShaderSourceHash(ShaderCI);
 
-        auto it = m_Shaders.find(Hash);
-        if (it != m_Shaders.end())
-        {
-            if (auto pShader = it->second.Lock())
-            {
-                *ppShader = pShader.Detach();
-                RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE, "Reusing existing shader '", (ShaderCI.Desc.Name ? ShaderCI.Desc.Name : ""), "'.");
-                return true;
-            }
-            else
-            {
-                m_Shaders.erase(it);
-            }
-        }
+        auto ShaderCIWithoutSource     = ShaderCI;
+        ShaderCIWithoutSource.FilePath = nullptr;
+        Hasher.Update(ShaderCIWithoutSource, SourceHash.LowPart, SourceHash.HighPart, m_DeviceType, IsDebug);
+    }
+    else
+    {
+        Hasher.Update(ShaderCI, m_DeviceType, IsDebug);
+    }
+    return Hasher.Digest();
+}
+
+bool RenderStateCacheImpl::CreateShaderInternal(const ShaderCreateInfo& ShaderCI,
+                                                IShader**               ppShader)
+{
+    VERIFY_EXPR(ppShader != nullptr && *ppShader == nullptr);
+
+    const auto Hash = ComputeShaderHash(ShaderCI);
+
+    // First, try to check if the shader has already been requested
+    if (auto pShader = m_Shaders.Get(Hash))
+    {
+        *ppShader = pShader.Detach();
+        RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE, "Reusing existing shader '", (ShaderCI.Desc.Name ? ShaderCI.Desc.Name : ""), "'.");
+        return true;
     }
 
     class AddShaderHelper
@@ -630,10 +964,7 @@ bool RenderStateCacheImpl::CreateShaderInternal(const ShaderCreateInfo& ShaderCI
         ~AddShaderHelper()
         {
             if (*m_ppShader != nullptr)
-            {
-                std::lock_guard<std::mutex> Guard{m_Cache.m_ShadersMtx};
-                m_Cache.m_Shaders.emplace(m_Hash, *m_ppShader);
-            }
+                m_Cache.m_Shaders.Add(m_Hash, *m_ppShader);
         }
 
     private:
@@ -689,7 +1020,10 @@ bool RenderStateCacheImpl::CreateShaderInternal(const ShaderCreateInfo& ShaderCI
         if (pArchivedShader)
         {
             if (m_pArchiver->AddShader(pArchivedShader))
+            {
                 RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_NORMAL, "Added shader '", HashStr, "'.");
+                AddToJournal([&](IArchiver* pArchiver) { return pArchiver->AddShader(pArchivedShader); });
+            }
             else
                 LOG_ERROR_MESSAGE("Failed to archive shader '", HashStr, "'.");
         }
@@ -989,25 +1323,13 @@ bool RenderStateCacheImpl::CreatePipelineState(const CreateInfoType& PSOCreateIn
 
     if (m_CI.EnableHotReload)
     {
-        {
-            std::lock_guard<std::mutex> Guard{m_ReloadablePipelinesMtx};
-
-            auto it = m_ReloadablePipelines.find(pPSO);
-            if (it != m_ReloadablePipelines.end())
-            {
-                if (auto pReloadablePSO = it->second.Lock())
-                    *ppPipelineState = pReloadablePSO.Detach();
-                else
-                    m_ReloadablePipelines.erase(it);
-            }
-        }
+        if (auto pReloadablePSO = m_ReloadablePipelines.Get(pPSO))
+            *ppPipelineState = pReloadablePSO.Detach();
 
         if (*ppPipelineState == nullptr)
         {
             ReloadablePipelineState::Create(this, pPSO, PSOCreateInfo, ppPipelineState);
-
-            std::lock_guard<std::mutex> Guard{m_ReloadablePipelinesMtx};
-            m_ReloadablePipelines.emplace(pPSO, RefCntWeakPtr<IPipelineState>(*ppPipelineState));
+            m_ReloadablePipelines.Add(pPSO, *ppPipelineState);
         }
     }
     else
@@ -1024,28 +1346,16 @@ bool RenderStateCacheImpl::CreatePipelineStateInternal(const CreateInfoType& PSO
 {
     VERIFY_EXPR(ppPipelineState != nullptr && *ppPipelineState == nullptr);
 
-    XXH128State Hasher;
+    XXH128State Hasher{&m_ObjectDigests};
     Hasher.Update(PSOCreateInfo, m_DeviceType);
     const auto Hash = Hasher.Digest();
 
     // First, try to check if the PSO has already been requested
+    if (auto pPSO = m_Pipelines.Get(Hash))
     {
-        std::lock_guard<std::mutex> Guard{m_PipelinesMtx};
-
-        auto it = m_Pipelines.find(Hash);
-        if (it != m_Pipelines.end())
-        {
-            if (auto pPSO = it->second.Lock())
-            {
-                *ppPipelineState = pPSO.Detach();
-                RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE, "Reusing existing pipeline '", (PSOCreateInfo.PSODesc.Name ? PSOCreateInfo.PSODesc.Name : ""), "'.");
-                return true;
-            }
-            else
-            {
-                m_Pipelines.erase(it);
-            }
-        }
+        *ppPipelineState = pPSO.Detach();
+        RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE, "Reusing existing pipeline '", (PSOCreateInfo.PSODesc.Name ? PSOCreateInfo.PSODesc.Name : ""), "'.");
+        return true;
     }
 
     const auto HashStr = MakeHashStr(PSOCreateInfo.PSODesc.Name, Hash);
@@ -1089,10 +1399,7 @@ bool RenderStateCacheImpl::CreatePipelineStateInternal(const CreateInfoType& PSO
             return false;
     }
 
-    {
-        std::lock_guard<std::mutex> Guard{m_PipelinesMtx};
-        m_Pipelines.emplace(Hash, *ppPipelineState);
-    }
+    m_Pipelines.Add(Hash, *ppPipelineState);
 
     if (FoundInCache)
     {
@@ -1117,7 +1424,10 @@ bool RenderStateCacheImpl::CreatePipelineStateInternal(const CreateInfoType& PSO
         if (pSerializedPSO)
         {
             if (m_pArchiver->AddPipelineState(pSerializedPSO))
+            {
                 RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_NORMAL, "Added pipeline '", HashStr, "'.");
+                AddToJournal([&](IArchiver* pArchiver) { return pArchiver->AddPipelineState(pSerializedPSO); });
+            }
             else
                 LOG_ERROR_MESSAGE("Failed to archive PSO '", HashStr, "'.");
         }
@@ -1129,6 +1439,107 @@ bool RenderStateCacheImpl::CreatePipelineStateInternal(const CreateInfoType& PSO
     return false;
 }
 
+void RenderStateCacheImpl::InvalidateChangedSources()
+{
+    std::vector<std::pair<SourceHashKey, SourceHashInfo>> Files;
+    {
+        std::lock_guard<std::mutex> Guard{m_SourceHashesMtx};
+        Files.assign(m_FileHashes.begin(), m_FileHashes.end());
+    }
+
+    // Read every file once, no matter how many sources include it
+    std::unordered_set<SourceHashKey, SourceHashKey::Hasher> ChangedFiles;
+    for (auto& File : Files)
+    {
+        const auto& Key     = File.first;
+        bool        Changed = true;
+
+        auto pFactory = File.second.pFactory.Lock();
+        if (pFactory && pFactory == Key.pFactory)
+        {
+            try
+            {
+                const auto SourceData = ReadShaderSourceFile(nullptr, 0, pFactory, Key.FilePath.c_str());
+                Changed               = !(ComputeFileHash(SourceData.Source, SourceData.SourceLength) == File.second.Hash);
+            }
+            catch (...)
+            {
+            }
+        }
+
+        if (Changed)
+        {
+            RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE, "File '", Key.FilePath, "' has changed.");
+            ChangedFiles.emplace(Key);
+        }
+    }
+
+    if (ChangedFiles.empty())
+        return;
+
+    std::lock_guard<std::mutex> Guard{m_SourceHashesMtx};
+    for (const auto& Key : ChangedFiles)
+        m_FileHashes.erase(Key);
+
+    for (auto it = m_SourceHashes.begin(); it != m_SourceHashes.end();)
+    {
+        const auto& Key = it->first;
+
+        bool IsValid = it->second.pFactory.Lock() == Key.pFactory;
+        for (size_t i = 0; i < it->second.Files.size() && IsValid; ++i)
+            IsValid = ChangedFiles.find(SourceHashKey{it->second.Files[i], Key.pFactory}) == ChangedFiles.end();
+
+        if (IsValid)
+            ++it;
+        else
+            it = m_SourceHashes.erase(it);
+    }
+}
+
+bool RenderStateCacheImpl::IsShaderSourceChanged(const ShaderCreateInfo& ShaderCI)
+{
+    // Sources in memory can't change
+    if (ShaderCI.FilePath == nullptr || ShaderCI.Source != nullptr)
+        return false;
+
+    std::lock_guard<std::mutex> Guard{m_SourceHashesMtx};
+
+    // The hash is removed by InvalidateChangedSources() when any file of the source has changed.
+    // It is also not present if some file could not be loaded.
+    auto it = m_SourceHashes.find(SourceHashKey{ShaderCI.FilePath, ShaderCI.pShaderSourceStreamFactory});
+    return it == m_SourceHashes.end() || it->second.pFactory.Lock() != ShaderCI.pShaderSourceStreamFactory;
+}
+
+template <typename HandlerType>
+void RenderStateCacheImpl::ProcessInParallel(size_t NumItems, HandlerType&& Handler)
+{
+    // OpenGL shaders and pipelines must be created in the thread that owns the context
+    if (NumItems > 1 && !m_pReloadThreadPool && !m_pDevice->GetDeviceInfo().IsGLDevice())
+    {
+        ThreadPoolCreateInfo ThreadPoolCI;
+        ThreadPoolCI.NumThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        m_pReloadThreadPool     = CreateThreadPool(ThreadPoolCI);
+    }
+
+    if (NumItems <= 1 || !m_pReloadThreadPool)
+    {
+        for (size_t i = 0; i < NumItems; ++i)
+            Handler(i);
+        return;
+    }
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks(NumItems);
+    for (size_t i = 0; i < NumItems; ++i)
+    {
+        Tasks[i] = EnqueueAsyncWork(m_pReloadThreadPool,
+                                    [&Handler, i](Uint32 /*ThreadId*/) {
+                                        Handler(i);
+                                    });
+    }
+    for (auto& pTask : Tasks)
+        pTask->WaitForCompletion();
+}
+
 Uint32 RenderStateCacheImpl::Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData)
 {
     if (!m_CI.EnableHotReload)
@@ -1137,25 +1548,49 @@ Uint32 RenderStateCacheImpl::Reload(ReloadGraphicsPipelineCallbackType ReloadGra
         return 0;
     }
 
-    Uint32 NumStatesReloaded = 0;
+    // Only reload the shaders whose source files or includes have changed
+    InvalidateChangedSources();
 
-    // Reload all shaders first
+    std::vector<RefCntAutoPtr<ReloadableShader>> Shaders;
+    for (auto& pShader : m_ReloadableShaders.GetObjects())
     {
-        std::lock_guard<std::mutex> Guard{m_ReloadableShadersMtx};
-        for (auto shader_it : m_ReloadableShaders)
+        RefCntAutoPtr<ReloadableShader> pReloadableShader{pShader, ReloadableShader::IID_InternalImpl};
+        if (!pReloadableShader)
+        {
+            UNEXPECTED("Shader object is not a ReloadableShader");
+            continue;
+        }
+        if (IsShaderSourceChanged(pReloadableShader->GetCreateInfo()))
+            Shaders.emplace_back(std::move(pReloadableShader));
+    }
+
+    Uint32 NumStatesReloaded = 0;
+
+    // Create all new shaders first and then replace them, so that the pipelines
+    // are not re-created while only some of their shaders are updated.
+    std::unordered_set<const IShader*> ReloadedShaders;
+    {
+        std::vector<RefCntAutoPtr<IShader>> NewShaders(Shaders.size());
+        // std::vector<bool> elements can't be written from different threads
+        std::vector<Uint8> FoundInCache(Shaders.size());
+        ProcessInParallel(Shaders.size(),
+                          [&](size_t i) {
+                              bool Found      = false;
+                              NewShaders[i]   = Shaders[i]->CreateReloadedShader(Found);
+                              FoundInCache[i] = Found ? 1 : 0;
+                          });
+
+        for (size_t i = 0; i < Shaders.size(); ++i)
         {
-            if (auto pShader = shader_it.second.Lock())
+            if (!FoundInCache[i])
+                ++NumStatesReloaded;
+
+            if (NewShaders[i] && NewShaders[i] != Shaders[i]->GetInternalShader())
             {
-                RefCntAutoPtr<ReloadableShader> pReloadableShader{pShader, ReloadableShader::IID_InternalImpl};
-                if (pReloadableShader)
-                {
-                    if (pReloadableShader->Reload())
-                        ++NumStatesReloaded;
-                }
-                else
-                {
-                    UNEXPECTED("Shader object is not a ReloadableShader");
-                }
+                Shaders[i]->SetShader(NewShaders[i]);
+                ReloadedShaders.emplace(Shaders[i].RawPtr<IShader>());
+                // The bytecode of the reloadable shader has changed
+                m_ObjectDigests.Invalidate(Shaders[i].RawPtr<IShader>());
             }
         }
     }
@@ -1163,23 +1598,41 @@ Uint32 RenderStateCacheImpl::Reload(ReloadGraphicsPipelineCallbackType ReloadGra
     // Reload pipelines.
     // Note that create info structs reference reloadable shaders, so that when pipelines
     // are re-created, they will automatically use reloaded shaders.
+    std::vector<RefCntAutoPtr<ReloadablePipelineState>> Pipelines;
+    for (auto& pPSO : m_ReloadablePipelines.GetObjects())
     {
-        std::lock_guard<std::mutex> Guard{m_ReloadablePipelinesMtx};
-        for (auto pso_it : m_ReloadablePipelines)
+        RefCntAutoPtr<ReloadablePipelineState> pReloadablePSO{pPSO, ReloadablePipelineState::IID_InternalImpl};
+        if (!pReloadablePSO)
         {
-            if (auto pPSO = pso_it.second.Lock())
-            {
-                RefCntAutoPtr<ReloadablePipelineState> pReloadablePSO{pPSO, ReloadablePipelineState::IID_InternalImpl};
-                if (pPSO)
-                {
-                    if (pReloadablePSO->Reload(ReloadGraphicsPipeline, pUserData))
-                        ++NumStatesReloaded;
-                }
-                else
-                {
-                    UNEXPECTED("Pipeline state object is not a ReloadablePipelineState");
-                }
-            }
+            UNEXPECTED("Pipeline state object is not a ReloadablePipelineState");
+            continue;
+        }
+
+        // The callback may modify any graphics pipeline, so all pipelines are processed in this case
+        if (ReloadGraphicsPipeline != nullptr || pReloadablePSO->UsesAnyShader(ReloadedShaders))
+        {
+            pReloadablePSO->ModifyCreateInfo(ReloadGraphicsPipeline, pUserData);
+            Pipelines.emplace_back(std::move(pReloadablePSO));
+        }
+    }
+
+    {
+        std::vector<RefCntAutoPtr<IPipelineState>> NewPipelines(Pipelines.size());
+        std::vector<Uint8>                         FoundInCache(Pipelines.size());
+        ProcessInParallel(Pipelines.size(),
+                          [&](size_t i) {
+                              bool Found      = false;
+                              NewPipelines[i] = Pipelines[i]->CreateReloadedPipeline(Found);
+                              FoundInCache[i] = Found ? 1 : 0;
+                          });
+
+        for (size_t i = 0; i < Pipelines.size(); ++i)
+        {
+            if (!FoundInCache[i])
+                ++NumStatesReloaded;
+
+            if (NewPipelines[i])
+                Pipelines[i]->SetPipeline(NewPipelines[i]);
         }
     }
 
@@ -1253,6 +1706,12 @@ struct ReloadablePipelineState::CreateInfoWrapperBase : DynamicHeapObjectBase
         }
 
         m_Objects.emplace_back(pShader);
+        m_Shaders.emplace_back(pShader);
+    }
+
+    const std::vector<const IShader*>& GetShaders() const
+    {
+        return m_Shaders;
     }
 
 protected:
@@ -1263,6 +1722,7 @@ protected:
     std::vector<ImmutableSamplerDesc>        m_ImtblSamplers;
     std::vector<IPipelineResourceSignature*> m_ppSignatures;
     std::vector<RefCntAutoPtr<IObject>>      m_Objects;
+    std::vector<const IShader*>              m_Shaders;
 };
 
 template <>
@@ -1344,20 +1804,16 @@ ReloadableShader::ReloadableShader(IReferenceCounters*     pRefCounters,
 {
 }
 
-bool ReloadableShader::Reload()
+RefCntAutoPtr<IShader> ReloadableShader::CreateReloadedShader(bool& FoundInCache)
 {
     RefCntAutoPtr<IShader> pNewShader;
-    bool                   FoundInCache = m_pStateCache->CreateShaderInternal(m_CreateInfo, &pNewShader);
-    if (pNewShader)
-    {
-        m_pShader = pNewShader;
-    }
-    else
+    FoundInCache = m_pStateCache->CreateShaderInternal(m_CreateInfo, &pNewShader);
+    if (!pNewShader)
     {
         const auto* Name = m_CreateInfo.Get().Desc.Name;
         LOG_ERROR_MESSAGE("Failed to reload shader '", (Name ? Name : "<unnamed>"), "'.");
     }
-    return !FoundInCache;
+    return pNewShader;
 }
 
 
@@ -1393,6 +1849,13 @@ ReloadablePipelineState::ReloadablePipelineState(IReferenceCounters*
         default:
             UNEXPECTED("Unexpected pipeline type");
     }
+
+    if (m_pCreateInfo)
+    {
+        ProcessCreateInfo([this](auto& CreateInfo) {
+            m_Shaders = CreateInfo.GetShaders();
+        });
+    }
 }
 
 template <typename CreateInfoType>
@@ -1409,73 +1872,90 @@ void ModifyPsoCreateInfo(GraphicsPipelineStateCreateInfo& PsoCreateInfo, ReloadG
     }
 }
 
-template <typename CreateInfoType>
-bool ReloadablePipelineState::Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData)
+template <typename HandlerType>
+void ReloadablePipelineState::ProcessCreateInfo(HandlerType&& Handler)
+{
+    static_assert(PIPELINE_TYPE_COUNT == 5, "Did you add a new pipeline type? You may need to handle it here.");
+    switch (m_Type)
+    {
+        case PIPELINE_TYPE_GRAPHICS:
+        case PIPELINE_TYPE_MESH:
+            Handler(static_cast<CreateInfoWrapper<GraphicsPipelineStateCreateInfo>&>(*m_pCreateInfo));
+            break;
+
+        case PIPELINE_TYPE_COMPUTE:
+            Handler(static_cast<CreateInfoWrapper<ComputePipelineStateCreateInfo>&>(*m_pCreateInfo));
+            break;
+
+        case PIPELINE_TYPE_RAY_TRACING:
+            Handler(static_cast<CreateInfoWrapper<RayTracingPipelineStateCreateInfo>&>(*m_pCreateInfo));
+            break;
+
+        case PIPELINE_TYPE_TILE:
+            Handler(static_cast<CreateInfoWrapper<TilePipelineStateCreateInfo>&>(*m_pCreateInfo));
+            break;
+
+        default:
+            UNEXPECTED("Unexpected pipeline type");
+    }
+}
+
+void ReloadablePipelineState::ModifyCreateInfo(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData)
 {
-    auto& CreateInfo = static_cast<CreateInfoWrapper<CreateInfoType>&>(*m_pCreateInfo);
-    ModifyPsoCreateInfo<CreateInfoType>(static_cast<CreateInfoType&>(CreateInfo), ReloadGraphicsPipeline, pUserData);
+    ProcessCreateInfo([&](auto& CreateInfo) {
+        using CreateInfoType = typename std::decay<decltype(CreateInfo.Get())>::type;
+        ModifyPsoCreateInfo<CreateInfoType>(static_cast<CreateInfoType&>(CreateInfo), ReloadGraphicsPipeline, pUserData);
+    });
+}
 
+RefCntAutoPtr<IPipelineState> ReloadablePipelineState::CreateReloadedPipeline(bool& FoundInCache)
+{
     RefCntAutoPtr<IPipelineState> pNewPSO;
+    // Note that all shaders in the create info are reloadable shaders, so they will automatically redirect all calls
+    // to the updated internal shader
+    ProcessCreateInfo([&](auto& CreateInfo) {
+        FoundInCache = m_pStateCache->CreatePipelineStateInternal(CreateInfo.Get(), &pNewPSO);
+        if (!pNewPSO)
+        {
+            const auto* Name = CreateInfo.Get().PSODesc.Name;
+            LOG_ERROR_MESSAGE("Failed to reload pipeline state '", (Name ? Name : "<unnamed>"), "'.");
+        }
+    });
+    return pNewPSO;
+}
 
-    // Note that the create info struct references reloadable shaders, so that the pipeline will use the updated shaders
-    const auto FoundInCache = m_pStateCache->CreatePipelineStateInternal(static_cast<const CreateInfoType&>(CreateInfo), &pNewPSO);
+void ReloadablePipelineState::SetPipeline(IPipelineState* pNewPSO)
+{
+    if (m_pPipeline == pNewPSO)
+        return;
 
-    if (pNewPSO)
+    const auto SrcSignCount = m_pPipeline->GetResourceSignatureCount();
+    const auto DstSignCount = pNewPSO->GetResourceSignatureCount();
+    if (SrcSignCount == DstSignCount)
     {
-        if (m_pPipeline != pNewPSO)
+        for (Uint32 s = 0; s < SrcSignCount; ++s)
         {
-            const auto SrcSignCount = m_pPipeline->GetResourceSignatureCount();
-            const auto DstSignCount = pNewPSO->GetResourceSignatureCount();
-            if (SrcSignCount == DstSignCount)
-            {
-                for (Uint32 s = 0; s < SrcSignCount; ++s)
-                {
-                    auto* pSrcSign = m_pPipeline->GetResourceSignature(s);
-                    auto* pDstSign = pNewPSO->GetResourceSignature(s);
-                    if (pSrcSign != pDstSign)
-                        pSrcSign->CopyStaticResources(pDstSign);
-                }
-            }
-            else
-            {
-                UNEXPECTED("The number of resource signatures in old pipeline (", SrcSignCount, ") does not match the number of signatures in new pipeline (", DstSignCount, ")");
-            }
-            m_pPipeline = pNewPSO;
+            auto* pSrcSign = m_pPipeline->GetResourceSignature(s);
+            auto* pDstSign = pNewPSO->GetResourceSignature(s);
+            if (pSrcSign != pDstSign)
+                pSrcSign->CopyStaticResources(pDstSign);
         }
     }
     else
     {
-        const auto* Name = CreateInfo.Get().PSODesc.Name;
-        LOG_ERROR_MESSAGE("Failed to reload pipeline state '", (Name ? Name : "<unnamed>"), "'.");
+        UNEXPECTED("The number of resource signatures in old pipeline (", SrcSignCount, ") does not match the number of signatures in new pipeline (", DstSignCount, ")");
     }
-    return !FoundInCache;
+    m_pPipeline = pNewPSO;
 }
 
-
-bool ReloadablePipelineState::Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData)
+bool ReloadablePipelineState::UsesAnyShader(const std::unordered_set<const IShader*>& Shaders) const
 {
-    static_assert(PIPELINE_TYPE_COUNT == 5, "Did you add a new pipeline type? You may need to handle it here.");
-    // Note that all shaders in Create Info are reloadable shaders, so they will automatically redirect all calls
-    // to the updated internal shader
-    switch (m_Type)
+    for (const auto* pShader : m_Shaders)
     {
-        case PIPELINE_TYPE_GRAPHICS:
-        case PIPELINE_TYPE_MESH:
-            return Reload<GraphicsPipelineStateCreateInfo>(ReloadGraphicsPipeline, pUserData);
-
-        case PIPELINE_TYPE_COMPUTE:
-            return Reload<ComputePipelineStateCreateInfo>(ReloadGraphicsPipeline, pUserData);
-
-        case PIPELINE_TYPE_RAY_TRACING:
-            return Reload<RayTracingPipelineStateCreateInfo>(ReloadGraphicsPipeline, pUserData);
-
-        case PIPELINE_TYPE_TILE:
-            return Reload<TilePipelineStateCreateInfo>(ReloadGraphicsPipeline, pUserData);
-
-        default:
-            UNEXPECTED("Unexpected pipeline type");
-            return false;
+        if (Shaders.find(pShader) != Shaders.end())
+            return true;
     }
+    return false;
 }
 
 } // namespace Diligent
@@ -0,0 +1,474 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ResourceStreamer.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "FileWrapper.hpp"
+#include "GraphicsAccessories.hpp"
+#include "Align.hpp"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Buffer copies have no alignment requirements, but keep allocations cache line aligned.
+constexpr RingBuffer::OffsetType BufferStagingAlignment = 64;
+
+// D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT and D3D12_TEXTURE_DATA_PITCH_ALIGNMENT.
+// Both values also satisfy Vulkan buffer-image copy requirements for all formats
+// with power-of-two texel or block sizes.
+constexpr RingBuffer::OffsetType TextureStagingAlignment    = 512;
+constexpr Uint32                 TextureStagingRowAlignment = 256;
+
+} // namespace
+
+struct ResourceStreamer::Request
+{
+    explicit Request(const ReadRequest& Src) :
+        FilePath{Src.FilePath != nullptr ? Src.FilePath : ""},
+        FileOffset{Src.Offset},
+        FileSize{Src.Size},
+        UncompressedSize{Src.UncompressedSize}
+    {}
+
+    Uint64 GetDataSize() const { return UncompressedSize != 0 ? UncompressedSize : FileSize; }
+
+    const std::string FilePath;
+    const Uint64      FileOffset;
+    const Uint64      FileSize;
+    const Uint64      UncompressedSize;
+
+    RefCntAutoPtr<IBuffer> pDstBuffer;
+    Uint64                 DstOffset = 0;
+
+    RefCntAutoPtr<ITexture> pDstTexture;
+    Uint32                  MipLevel = 0;
+    Uint32                  Slice    = 0;
+    Box                     DstBox;
+    Uint64                  SrcStride      = 0;
+    Uint64                  SrcDepthStride = 0;
+    BufferToTextureCopyInfo CopyInfo;
+
+    Uint64                 StagingSize      = 0;
+    RingBuffer::OffsetType StagingAlignment = BufferStagingAlignment;
+    RingBuffer::OffsetType StagingOffset    = RingBuffer::InvalidOffset;
+
+    Uint64 FenceValue = 0;
+
+    RefCntAutoPtr<IAsyncTask> pTask;
+
+    // Written by the worker thread before the task is finished.
+    bool Succeeded = false;
+
+    bool IsTextureLayoutMatching() const
+    {
+        return SrcStride == CopyInfo.RowStride && (DstBox.Depth() == 1 || SrcDepthStride == CopyInfo.DepthStride);
+    }
+
+    // The size of the texture region data in the source layout.
+    Uint64 GetTextureDataSize() const
+    {
+        return (DstBox.Depth() - 1) * SrcDepthStride + (CopyInfo.RowCount - 1) * SrcStride + CopyInfo.RowSize;
+    }
+};
+
+ResourceStreamer::ResourceStreamer(const CreateInfo& CI) :
+    // clang-format off
+    m_pDevice           {CI.pDevice},
+    m_pContext          {CI.pContext},
+    m_pThreadPool       {CI.pThreadPool},
+    m_MaxConcurrentReads{std::max(CI.MaxConcurrentReads, 1u)},
+    m_Decompress        {CI.Decompress},
+    m_StagingRing       {StaticCast<RingBuffer::OffsetType>(CI.StagingBufferSize), DefaultRawMemoryAllocator::GetAllocator()}
+// clang-format on
+{
+    if (!m_pDevice)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+    if (!m_pContext)
+        LOG_ERROR_AND_THROW("Device context must not be null");
+    if (CI.StagingBufferSize == 0)
+        LOG_ERROR_AND_THROW("Staging buffer size must not be zero");
+
+    const auto DevType = m_pDevice->GetDeviceInfo().Type;
+    if (DevType != RENDER_DEVICE_TYPE_D3D12 && DevType != RENDER_DEVICE_TYPE_VULKAN)
+        LOG_ERROR_AND_THROW("Resource streamer requires persistently mapped staging buffers and is only supported in Direct3D12 and Vulkan backends");
+
+    {
+        FenceDesc Desc;
+        Desc.Name = "Resource streamer fence";
+        Desc.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+        m_pDevice->CreateFence(Desc, &m_pFence);
+        if (!m_pFence)
+            LOG_ERROR_AND_THROW("Failed to create resource streamer fence");
+    }
+
+    {
+        BufferDesc Desc;
+        Desc.Name           = "Resource streamer staging buffer";
+        Desc.Size           = CI.StagingBufferSize;
+        Desc.Usage          = USAGE_STAGING;
+        Desc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        m_pDevice->CreateBuffer(Desc, nullptr, &m_pStagingBuffer);
+        if (!m_pStagingBuffer)
+            LOG_ERROR_AND_THROW("Failed to create resource streamer staging buffer");
+
+        // The buffer stays mapped for the lifetime of the streamer so that workers can write to it directly.
+        PVoid pData = nullptr;
+        m_pContext->MapBuffer(m_pStagingBuffer, MAP_WRITE, MAP_FLAG_NONE, pData);
+        if (pData == nullptr)
+            LOG_ERROR_AND_THROW("Failed to map resource streamer staging buffer");
+        m_pStagingData = static_cast<Uint8*>(pData);
+    }
+}
+
+ResourceStreamer::~ResourceStreamer()
+{
+    Flush();
+
+    if (m_LastSignaledValue != 0)
+        m_pFence->Wait(m_LastSignaledValue);
+    m_StagingRing.ReleaseCompletedFrames(m_LastSignaledValue);
+
+    m_pContext->UnmapBuffer(m_pStagingBuffer, MAP_WRITE);
+}
+
+Uint64 ResourceStreamer::EnqueueRequest(std::unique_ptr<Request>&& pRequest)
+{
+    Uint64 FenceValue = 0;
+    {
+        std::lock_guard<std::mutex> Lock{m_PendingRequestsMtx};
+
+        FenceValue = m_NextFenceValue++;
+
+        pRequest->FenceValue = FenceValue;
+        m_PendingRequests.emplace_back(std::move(pRequest));
+    }
+    m_NumPendingRequests.fetch_add(1);
+
+    return FenceValue;
+}
+
+Uint64 ResourceStreamer::Enqueue(const BufferReadRequest& Request)
+{
+    DEV_CHECK_ERR(Request.pDstBuffer != nullptr, "Destination buffer must not be null");
+    DEV_CHECK_ERR(Request.FilePath != nullptr, "File path must not be null");
+    DEV_CHECK_ERR(Request.Size > 0, "File range size must not be zero");
+    DEV_CHECK_ERR(Request.UncompressedSize == 0 || m_Decompress, "Decompression function must be provided to read compressed data");
+
+    std::unique_ptr<ResourceStreamer::Request> pReq{new ResourceStreamer::Request{Request}};
+
+    const auto DataSize = pReq->GetDataSize();
+    DEV_CHECK_ERR(Request.DstOffset + DataSize <= Request.pDstBuffer->GetDesc().Size,
+                  "The range [", Request.DstOffset, ", ", Request.DstOffset + DataSize, ") is out of bounds of buffer '",
+                  Request.pDstBuffer->GetDesc().Name, "' of size ", Request.pDstBuffer->GetDesc().Size);
+
+    pReq->pDstBuffer       = Request.pDstBuffer;
+    pReq->DstOffset        = Request.DstOffset;
+    pReq->StagingSize      = DataSize;
+    pReq->StagingAlignment = BufferStagingAlignment;
+
+    return EnqueueRequest(std::move(pReq));
+}
+
+Uint64 ResourceStreamer::Enqueue(const TextureReadRequest& Request)
+{
+    DEV_CHECK_ERR(Request.pDstTexture != nullptr, "Destination texture must not be null");
+    DEV_CHECK_ERR(Request.FilePath != nullptr, "File path must not be null");
+    DEV_CHECK_ERR(Request.Size > 0, "File range size must not be zero");
+    DEV_CHECK_ERR(Request.UncompressedSize == 0 || m_Decompress, "Decompression function must be provided to read compressed data");
+
+    const auto& TexDesc = Request.pDstTexture->GetDesc();
+    DEV_CHECK_ERR(Request.MipLevel < TexDesc.MipLevels, "Mip level (", Request.MipLevel, ") is out of range");
+
+    std::unique_ptr<ResourceStreamer::Request> pReq{new ResourceStreamer::Request{Request}};
+
+    pReq->pDstTexture = Request.pDstTexture;
+    pReq->MipLevel    = Request.MipLevel;
+    pReq->Slice       = Request.Slice;
+    if (Request.pDstBox != nullptr)
+    {
+        pReq->DstBox = *Request.pDstBox;
+    }
+    else
+    {
+        const auto MipProps = GetMipLevelProperties(TexDesc, Request.MipLevel);
+        pReq->DstBox        = Box{0, MipProps.LogicalWidth, 0, MipProps.LogicalHeight, 0, MipProps.Depth};
+    }
+
+    pReq->CopyInfo       = GetBufferToTextureCopyInfo(TexDesc.Format, pReq->DstBox, TextureStagingRowAlignment);
+    pReq->SrcStride      = Request.Stride != 0 ? Request.Stride : pReq->CopyInfo.RowSize;
+    pReq->SrcDepthStride = Request.DepthStride != 0 ? Request.DepthStride : pReq->SrcStride * pReq->CopyInfo.RowCount;
+    DEV_CHECK_ERR(pReq->SrcStride >= pReq->CopyInfo.RowSize, "Source data stride (", pReq->SrcStride, ") is below the region row size (", pReq->CopyInfo.RowSize, ")");
+    DEV_CHECK_ERR(pReq->GetDataSize() >= pReq->GetTextureDataSize(), "Data size (", pReq->GetDataSize(),
+                  ") is smaller than the size required to update the region (", pReq->GetTextureDataSize(), ")");
+
+    pReq->StagingSize      = pReq->CopyInfo.MemorySize;
+    pReq->StagingAlignment = TextureStagingAlignment;
+
+    return EnqueueRequest(std::move(pReq));
+}
+
+bool ResourceStreamer::ReadData(const Request& Req, Uint8* pDst) const
+{
+    FileWrapper File{Req.FilePath.c_str(), EFileAccessMode::Read};
+    if (!File)
+    {
+        LOG_ERROR_MESSAGE("Failed to open file '", Req.FilePath, "'");
+        return false;
+    }
+
+    const auto FileOffset = StaticCast<size_t>(Req.FileOffset);
+    const auto FileSize   = StaticCast<size_t>(Req.FileSize);
+    if (!File->SetPos(FileOffset, FilePosOrigin::Start))
+    {
+        LOG_ERROR_MESSAGE("Failed to seek to offset ", FileOffset, " in file '", Req.FilePath, "'");
+        return false;
+    }
+
+    // Texture rows are padded in the staging buffer, so unless the source data already uses
+    // the same layout, it has to be scattered row by row.
+    const bool LayoutMatches = !Req.pDstTexture || Req.IsTextureLayoutMatching();
+
+    if (Req.UncompressedSize != 0)
+    {
+        std::vector<Uint8> CompressedData(FileSize);
+        if (!File->Read(CompressedData.data(), FileSize))
+        {
+            LOG_ERROR_MESSAGE("Failed to read ", FileSize, " bytes from file '", Req.FilePath, "'");
+            return false;
+        }
+
+        const auto DecompressedSize = StaticCast<size_t>(Req.UncompressedSize);
+        if (LayoutMatches && Req.UncompressedSize <= Req.StagingSize)
+        {
+            if (!m_Decompress(CompressedData.data(), FileSize, pDst, DecompressedSize))
+            {
+                LOG_ERROR_MESSAGE("Failed to decompress data from file '", Req.FilePath, "'");
+                return false;
+            }
+        }
+        else
+        {
+            VERIFY_EXPR(Req.pDstTexture);
+            std::vector<Uint8> DecompressedData(DecompressedSize);
+            if (!m_Decompress(CompressedData.data(), FileSize, DecompressedData.data(), DecompressedSize))
+            {
+                LOG_ERROR_MESSAGE("Failed to decompress data from file '", Req.FilePath, "'");
+                return false;
+            }
+
+            TextureSubResData SrcSubres{DecompressedData.data(), Req.SrcStride, Req.SrcDepthStride};
+            CopyTextureSubresource(SrcSubres, Req.CopyInfo.RowCount, Req.DstBox.Depth(), Req.CopyInfo.RowSize,
+                                   pDst, Req.CopyInfo.RowStride, Req.CopyInfo.DepthStride);
+        }
+        return true;
+    }
+
+    if (LayoutMatches)
+    {
+        const auto Size = Req.pDstTexture ? StaticCast<size_t>(Req.GetTextureDataSize()) : FileSize;
+        VERIFY_EXPR(Size <= FileSize && Size <= Req.StagingSize);
+        if (!File->Read(pDst, Size))
+        {
+            LOG_ERROR_MESSAGE("Failed to read ", Size, " bytes from file '", Req.FilePath, "'");
+            return false;
+        }
+        return true;
+    }
+
+    const auto RowSize = StaticCast<size_t>(Req.CopyInfo.RowSize);
+    for (Uint32 z = 0; z < Req.DstBox.Depth(); ++z)
+    {
+        for (Uint32 row = 0; row < Req.CopyInfo.RowCount; ++row)
+        {
+            const auto SrcOffset = StaticCast<size_t>(Req.FileOffset + z * Req.SrcDepthStride + row * Req.SrcStride);
+            if (File->GetPos() != SrcOffset && !File->SetPos(SrcOffset, FilePosOrigin::Start))
+            {
+                LOG_ERROR_MESSAGE("Failed to seek to offset ", SrcOffset, " in file '", Req.FilePath, "'");
+                return false;
+            }
+
+            auto* pDstRow = pDst + z * Req.CopyInfo.DepthStride + row * Req.CopyInfo.RowStride;
+            if (!File->Read(pDstRow, RowSize))
+            {
+                LOG_ERROR_MESSAGE("Failed to read ", RowSize, " bytes from file '", Req.FilePath, "'");
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool ResourceStreamer::StartRead(Request& Req)
+{
+    // The ring buffer aligns the allocation size, so a request that does not fit after alignment
+    // would never be allocated. Such requests are started as failed.
+    const auto AlignedStagingSize = AlignUp(Req.StagingSize, Uint64{Req.StagingAlignment});
+    if (AlignedStagingSize > m_StagingRing.GetMaxSize())
+    {
+        LOG_ERROR_MESSAGE("Request to read file '", Req.FilePath, "' requires ", AlignedStagingSize,
+                          " bytes of staging space, which exceeds the staging buffer size (", m_StagingRing.GetMaxSize(), ")");
+        Req.Succeeded = false;
+        return true;
+    }
+
+    Req.StagingOffset = m_StagingRing.Allocate(StaticCast<RingBuffer::OffsetType>(Req.StagingSize), Req.StagingAlignment);
+    if (Req.StagingOffset == RingBuffer::InvalidOffset)
+        return false;
+
+    // Requests are started in fence value order, so the space can be released
+    // as soon as the request's fence value is reached.
+    m_StagingRing.FinishCurrentFrame(Req.FenceValue);
+
+    Uint8* const pDst = m_pStagingData + Req.StagingOffset;
+    if (m_pThreadPool)
+    {
+        Request* pReq = &Req;
+        Req.pTask     = EnqueueAsyncWork(m_pThreadPool,
+                                     [this, pReq, pDst](Uint32) {
+                                         pReq->Succeeded = ReadData(*pReq, pDst);
+                                         return ASYNC_TASK_STATUS_COMPLETE;
+                                     });
+    }
+    else
+    {
+        Req.Succeeded = ReadData(Req, pDst);
+    }
+
+    return true;
+}
+
+void ResourceStreamer::SubmitRequest(Request& Req)
+{
+    if (Req.Succeeded)
+    {
+        VERIFY_EXPR(Req.StagingOffset != RingBuffer::InvalidOffset);
+        if ((m_pStagingBuffer->GetMemoryProperties() & MEMORY_PROPERTY_HOST_COHERENT) == 0)
+            m_pStagingBuffer->FlushMappedRange(Req.StagingOffset, Req.StagingSize);
+
+        if (Req.pDstBuffer)
+        {
+            m_pContext->CopyBuffer(m_pStagingBuffer, Req.StagingOffset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                   Req.pDstBuffer, Req.DstOffset, Req.StagingSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
+        else
+        {
+            VERIFY_EXPR(Req.pDstTexture);
+
+            TextureSubResData SubresData;
+            SubresData.pSrcBuffer  = m_pStagingBuffer;
+            SubresData.SrcOffset   = Req.StagingOffset;
+            SubresData.Stride      = Req.CopyInfo.RowStride;
+            SubresData.DepthStride = Req.CopyInfo.DepthStride;
+            m_pContext->UpdateTexture(Req.pDstTexture, Req.MipLevel, Req.Slice, Req.DstBox, SubresData,
+                                      RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
+    }
+
+    // Failed requests are signaled too so that waiting code does not stall.
+    m_pContext->EnqueueSignal(m_pFence, Req.FenceValue);
+    m_LastSignaledValue = Req.FenceValue;
+    m_NumPendingRequests.fetch_sub(1);
+}
+
+void ResourceStreamer::Process()
+{
+    m_StagingRing.ReleaseCompletedFrames(m_pFence->GetCompletedValue());
+
+    while (m_ActiveRequests.size() < m_MaxConcurrentReads)
+    {
+        std::unique_ptr<Request> pReq;
+        {
+            std::lock_guard<std::mutex> Lock{m_PendingRequestsMtx};
+            if (m_PendingRequests.empty())
+                break;
+            pReq = std::move(m_PendingRequests.front());
+            m_PendingRequests.pop_front();
+        }
+
+        if (!StartRead(*pReq))
+        {
+            // Not enough staging space - wait until the GPU releases some.
+            std::lock_guard<std::mutex> Lock{m_PendingRequestsMtx};
+            m_PendingRequests.emplace_front(std::move(pReq));
+            break;
+        }
+
+        m_ActiveRequests.emplace_back(std::move(pReq));
+    }
+
+    // Submit the requests in order so that fence values are signaled monotonically.
+    while (!m_ActiveRequests.empty())
+    {
+        auto& Req = *m_ActiveRequests.front();
+        if (Req.pTask && !Req.pTask->IsFinished())
+            break;
+
+        SubmitRequest(Req);
+        m_ActiveRequests.pop_front();
+    }
+}
+
+void ResourceStreamer::Flush()
+{
+    while (GetNumPendingRequests() > 0)
+    {
+        const auto NumPending = GetNumPendingRequests();
+
+        Process();
+        if (GetNumPendingRequests() < NumPending)
+            continue;
+
+        if (!m_ActiveRequests.empty())
+        {
+            // Wait for the oldest read to finish.
+            VERIFY_EXPR(m_ActiveRequests.front()->pTask);
+            m_ActiveRequests.front()->pTask->WaitForCompletion();
+        }
+        else
+        {
+            // All requests are waiting for the staging space.
+            VERIFY_EXPR(m_LastSignaledValue != 0);
+            m_pContext->Flush();
+            m_pFence->Wait(m_LastSignaledValue);
+        }
+    }
+
+    m_pContext->Flush();
+}
+
+} // namespace Diligent
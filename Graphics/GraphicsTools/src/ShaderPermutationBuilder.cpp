@@ -0,0 +1,254 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderPermutationBuilder.hpp"
+
+#include <cstring>
+#include <unordered_map>
+
+#include "ShaderToolsCommon.hpp"
+#include "XXH128Hasher.hpp"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+inline bool IsIdentifierChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+// Calls Handler for every identifier-like token in the string
+template <typename HandlerType>
+void ForEachIdentifier(const char* Str, size_t Len, HandlerType Handler)
+{
+    size_t i = 0;
+    while (i < Len)
+    {
+        if (!IsIdentifierChar(Str[i]))
+        {
+            ++i;
+            continue;
+        }
+
+        const size_t Start = i;
+        while (i < Len && IsIdentifierChar(Str[i]))
+            ++i;
+        // Skip numbers
+        if (Str[Start] < '0' || Str[Start] > '9')
+            Handler(Str + Start, i - Start);
+    }
+}
+
+struct XXH128HashHasher
+{
+    size_t operator()(const XXH128Hash& Hash) const noexcept
+    {
+        return static_cast<size_t>(Hash.LowPart ^ Hash.HighPart);
+    }
+};
+
+} // namespace
+
+void ShaderPermutationBuilder::AddMacro(const Char* Name, std::vector<std::string> Values)
+{
+    DEV_CHECK_ERR(Name != nullptr && Name[0] != '\0', "Macro name must not be null or empty");
+    DEV_CHECK_ERR(!Values.empty(), "Macro '", Name, "' must have at least one value");
+    if (Values.empty())
+        return;
+
+#ifdef DILIGENT_DEVELOPMENT
+    for (const auto& Macro : m_Macros)
+    {
+        DEV_CHECK_ERR(Macro.Name != Name, "Macro '", Name, "' already exists");
+    }
+    DEV_CHECK_ERR(Uint64{GetNumPermutations()} * Values.size() <= Uint64{UINT32_MAX}, "Too many permutations");
+#endif
+
+    m_Macros.emplace_back(MacroInfo{Name, std::move(Values)});
+}
+
+Uint32 ShaderPermutationBuilder::GetNumPermutations() const
+{
+    Uint32 NumPermutations = 1;
+    for (const auto& Macro : m_Macros)
+        NumPermutations *= static_cast<Uint32>(Macro.Values.size());
+    return NumPermutations;
+}
+
+void ShaderPermutationBuilder::GetPermutationMacros(Uint32 Permutation, ShaderMacroHelper& Macros) const
+{
+    VERIFY(Permutation < GetNumPermutations(), "Permutation index (", Permutation, ") is out of range");
+    for (const auto& Macro : m_Macros)
+    {
+        const auto NumValues = static_cast<Uint32>(Macro.Values.size());
+        Macros.AddShaderMacro(Macro.Name.c_str(), Macro.Values[Permutation % NumValues].c_str());
+        Permutation /= NumValues;
+    }
+}
+
+std::vector<Uint32> ShaderPermutationBuilder::FindUniquePermutations(const ShaderCreateInfo& ShaderCI) const noexcept(false)
+{
+    const auto NumPermutations = GetNumPermutations();
+
+    // Find macros that the preprocessor may expand or test
+    std::vector<bool> IsSignificant(m_Macros.size(), true);
+    if (ShaderCI.Source != nullptr || ShaderCI.FilePath != nullptr)
+    {
+        std::string Source;
+        try
+        {
+            Source = UnrollShaderIncludes(ShaderCI);
+        }
+        catch (...)
+        {
+            Source.clear();
+        }
+
+        // Token pasting may produce any identifier
+        if (!Source.empty() && Source.find("##") == std::string::npos)
+        {
+            std::unordered_map<std::string, size_t> NameToMacro;
+            for (size_t i = 0; i < m_Macros.size(); ++i)
+            {
+                NameToMacro.emplace(m_Macros[i].Name, i);
+                IsSignificant[i] = false;
+            }
+
+            std::string Identifier;
+            auto        MarkSignificant = [&](const char* Str, size_t Len) {
+                Identifier.assign(Str, Len);
+                auto it = NameToMacro.find(Identifier);
+                if (it != NameToMacro.end())
+                    IsSignificant[it->second] = true;
+            };
+
+            ForEachIdentifier(Source.c_str(), Source.length(), MarkSignificant);
+            for (const ShaderMacro* pMacro = ShaderCI.Macros; pMacro != nullptr && pMacro->Name != nullptr; ++pMacro)
+            {
+                if (pMacro->Definition != nullptr)
+                    ForEachIdentifier(pMacro->Definition, strlen(pMacro->Definition), MarkSignificant);
+            }
+            for (const auto& Macro : m_Macros)
+            {
+                for (const auto& Value : Macro.Values)
+                    ForEachIdentifier(Value.c_str(), Value.length(), MarkSignificant);
+            }
+        }
+    }
+
+    // Permutations with the same significant macro definitions produce identical preprocessed source
+    std::vector<Uint32>                                      UniquePermutations(NumPermutations);
+    std::unordered_map<XXH128Hash, Uint32, XXH128HashHasher> KeyToPermutation;
+    for (Uint32 Permutation = 0; Permutation < NumPermutations; ++Permutation)
+    {
+        XXH128State Hasher;
+
+        Uint32 Index = Permutation;
+        for (size_t i = 0; i < m_Macros.size(); ++i)
+        {
+            const auto& Macro     = m_Macros[i];
+            const auto  NumValues = static_cast<Uint32>(Macro.Values.size());
+            if (IsSignificant[i])
+            {
+                const auto& Value = Macro.Values[Index % NumValues];
+                // Hash the length to keep the key unambiguous
+                Hasher.Update(i, Value.length(), Value);
+            }
+            Index /= NumValues;
+        }
+
+        UniquePermutations[Permutation] = KeyToPermutation.emplace(Hasher.Digest(), Permutation).first->second;
+    }
+
+    return UniquePermutations;
+}
+
+std::vector<RefCntAutoPtr<IShader>> ShaderPermutationBuilder::CreateShaders(const ShaderCreateInfo& ShaderCI, const CreateShadersAttribs& Attribs) const noexcept(false)
+{
+    if (Attribs.pDevice == nullptr && Attribs.pStateCache == nullptr)
+        LOG_ERROR_AND_THROW("Either render device or render state cache must not be null");
+
+    const auto UniquePermutations = FindUniquePermutations(ShaderCI);
+
+    std::vector<RefCntAutoPtr<IShader>> Shaders(UniquePermutations.size());
+
+    // Every task writes to its own element of Shaders
+    auto CreateShader = [&](Uint32 Permutation) {
+        ShaderMacroHelper Macros;
+        for (const ShaderMacro* pMacro = ShaderCI.Macros; pMacro != nullptr && pMacro->Name != nullptr; ++pMacro)
+            Macros.AddShaderMacro(pMacro->Name, pMacro->Definition);
+        GetPermutationMacros(Permutation, Macros);
+
+        ShaderCreateInfo PermutationCI = ShaderCI;
+        PermutationCI.Macros           = Macros;
+
+        if (Attribs.pStateCache != nullptr)
+            Attribs.pStateCache->CreateShader(PermutationCI, &Shaders[Permutation]);
+        else
+            Attribs.pDevice->CreateShader(PermutationCI, &Shaders[Permutation]);
+    };
+
+    if (Attribs.pThreadPool != nullptr)
+    {
+        std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+        for (Uint32 Permutation = 0; Permutation < UniquePermutations.size(); ++Permutation)
+        {
+            if (UniquePermutations[Permutation] == Permutation)
+            {
+                Tasks.emplace_back(EnqueueAsyncWork(Attribs.pThreadPool,
+                                                    [&CreateShader, Permutation](Uint32 /*ThreadId*/) {
+                                                        CreateShader(Permutation);
+                                                    }));
+            }
+        }
+        for (auto& pTask : Tasks)
+            pTask->WaitForCompletion();
+    }
+    else
+    {
+        for (Uint32 Permutation = 0; Permutation < UniquePermutations.size(); ++Permutation)
+        {
+            if (UniquePermutations[Permutation] == Permutation)
+                CreateShader(Permutation);
+        }
+    }
+
+    for (Uint32 Permutation = 0; Permutation < UniquePermutations.size(); ++Permutation)
+    {
+        if (UniquePermutations[Permutation] != Permutation)
+            Shaders[Permutation] = Shaders[UniquePermutations[Permutation]];
+    }
+
+    return Shaders;
+}
+
+} // namespace Diligent
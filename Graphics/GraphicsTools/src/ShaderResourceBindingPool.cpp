@@ -0,0 +1,149 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderResourceBindingPool.hpp"
+
+#include "DebugUtilities.hpp"
+#include "BasicMath.hpp"
+#include "StringTools.hpp"
+
+namespace Diligent
+{
+
+ShaderResourceBindingPool::ShaderResourceBindingPool(const CreateInfo& CI) noexcept(false) :
+    m_pSignature{CI.pSignature},
+    m_InitStaticResources{CI.InitStaticResources},
+    m_MaxPooledSRBs{CI.MaxPooledSRBs}
+{
+    if (m_pSignature == nullptr)
+        LOG_ERROR_AND_THROW("Pipeline resource signature must not be null");
+}
+
+RefCntAutoPtr<IShaderResourceBinding> ShaderResourceBindingPool::Allocate()
+{
+    {
+        std::lock_guard<std::mutex> Lock{m_PoolMtx};
+        if (!m_PooledSRBs.empty())
+        {
+            auto pSRB = std::move(m_PooledSRBs.back());
+            m_PooledSRBs.pop_back();
+            return pSRB;
+        }
+    }
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    m_pSignature->CreateShaderResourceBinding(&pSRB, m_InitStaticResources);
+    if (!pSRB)
+    {
+        LOG_ERROR_MESSAGE("Failed to create shader resource binding for pipeline resource signature '", m_pSignature->GetDesc().Name, "'");
+    }
+    return pSRB;
+}
+
+void ShaderResourceBindingPool::InitResetUpdates(IShaderResourceBinding* pSRB)
+{
+    VERIFY_EXPR(!m_ResetUpdatesInitialized);
+
+    const auto& SignDesc = m_pSignature->GetDesc();
+
+    SHADER_TYPE DynamicVarStages = SHADER_TYPE_UNKNOWN;
+    for (Uint32 r = 0; r < SignDesc.NumResources; ++r)
+    {
+        const auto& Res = SignDesc.Resources[r];
+        if (Res.VarType == SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+            DynamicVarStages |= Res.ShaderStages;
+    }
+
+    while (DynamicVarStages != SHADER_TYPE_UNKNOWN)
+    {
+        const auto ShaderType = ExtractLSB(DynamicVarStages);
+
+        const auto NumVars = pSRB->GetVariableCount(ShaderType);
+        for (Uint32 v = 0; v < NumVars; ++v)
+        {
+            auto* pVar = pSRB->GetVariableByIndex(ShaderType, v);
+            if (pVar == nullptr || pVar->GetType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+                continue;
+
+            ShaderResourceDesc ResDesc;
+            pVar->GetResourceDesc(ResDesc);
+
+            // Inline constants are bound to buffers owned by the SRB
+            bool IsInlineConstants = false;
+            for (Uint32 r = 0; r < SignDesc.NumResources && !IsInlineConstants; ++r)
+            {
+                const auto& Res   = SignDesc.Resources[r];
+                IsInlineConstants = (Res.Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) != 0 &&
+                    (Res.ShaderStages & ShaderType) != 0 && SafeStrEqual(Res.Name, ResDesc.Name);
+            }
+            if (IsInlineConstants)
+                continue;
+
+            for (Uint32 elem = 0; elem < ResDesc.ArraySize; ++elem)
+                m_ResetUpdates.emplace_back(ShaderType, v, nullptr, elem);
+        }
+    }
+
+    m_ResetUpdatesInitialized = true;
+}
+
+void ShaderResourceBindingPool::Recycle(IShaderResourceBinding* pSRB)
+{
+    if (pSRB == nullptr)
+        return;
+
+    DEV_CHECK_ERR(pSRB->GetPipelineResourceSignature() == m_pSignature,
+                  "The SRB was not created by pipeline resource signature '", m_pSignature->GetDesc().Name, "' of this pool");
+
+    std::lock_guard<std::mutex> Lock{m_PoolMtx};
+
+    if (m_PooledSRBs.size() >= m_MaxPooledSRBs)
+        return;
+
+    if (!m_ResetUpdatesInitialized)
+        InitResetUpdates(pSRB);
+
+    // Release references to dynamic resources so that they do not outlive their last use
+    if (!m_ResetUpdates.empty())
+        pSRB->SetResources(m_ResetUpdates.data(), static_cast<Uint32>(m_ResetUpdates.size()));
+
+    m_PooledSRBs.emplace_back(pSRB);
+}
+
+void ShaderResourceBindingPool::Clear()
+{
+    std::lock_guard<std::mutex> Lock{m_PoolMtx};
+    m_PooledSRBs.clear();
+}
+
+size_t ShaderResourceBindingPool::GetNumPooledSRBs() const
+{
+    std::lock_guard<std::mutex> Lock{m_PoolMtx};
+    return m_PooledSRBs.size();
+}
+
+} // namespace Diligent
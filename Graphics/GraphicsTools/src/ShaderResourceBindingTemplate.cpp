@@ -0,0 +1,98 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderResourceBindingTemplate.hpp"
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+ShaderResourceBindingTemplate::ShaderResourceBindingTemplate(IShaderResourceBinding* pSRB,
+                                                             const VariableDesc*     pVariables,
+                                                             Uint32                  NumVariables)
+{
+    DEV_CHECK_ERR(pSRB != nullptr, "SRB must not be null");
+    DEV_CHECK_ERR(pVariables != nullptr || NumVariables == 0, "pVariables must not be null when NumVariables is not zero");
+
+    m_pSignature = pSRB->GetPipelineResourceSignature();
+
+    m_Updates.resize(NumVariables);
+    for (Uint32 i = 0; i < NumVariables; ++i)
+    {
+        const auto& Var = pVariables[i];
+        if (auto* pVar = pSRB->GetVariableByName(Var.ShaderType, Var.Name))
+        {
+            auto& Update         = m_Updates[i];
+            Update.ShaderType    = Var.ShaderType;
+            Update.VariableIndex = pVar->GetIndex();
+            Update.ArrayIndex    = Var.ArrayIndex;
+        }
+        else
+        {
+            LOG_WARNING_MESSAGE("Variable '", (Var.Name != nullptr ? Var.Name : "<null>"), "' was not found in shader stage ", GetShaderTypeLiteralName(Var.ShaderType),
+                                " of pipeline resource signature '", m_pSignature->GetDesc().Name, "'. The slot will be ignored.");
+        }
+    }
+}
+
+bool ShaderResourceBindingTemplate::IsResolved(Uint32 Slot) const
+{
+    DEV_CHECK_ERR(Slot < m_Updates.size(), "Slot ", Slot, " is out of range");
+    return m_Updates[Slot].ShaderType != SHADER_TYPE_UNKNOWN;
+}
+
+void ShaderResourceBindingTemplate::SetResource(Uint32 Slot, IDeviceObject* pObject)
+{
+    DEV_CHECK_ERR(Slot < m_Updates.size(), "Slot ", Slot, " is out of range");
+    auto& Update        = m_Updates[Slot];
+    Update.pObject      = pObject;
+    Update.BufferOffset = 0;
+    Update.BufferRange  = 0;
+}
+
+void ShaderResourceBindingTemplate::SetBufferRange(Uint32 Slot, IDeviceObject* pBuffer, Uint64 Offset, Uint64 Size)
+{
+    DEV_CHECK_ERR(Slot < m_Updates.size(), "Slot ", Slot, " is out of range");
+    auto& Update        = m_Updates[Slot];
+    Update.pObject      = pBuffer;
+    Update.BufferOffset = Offset;
+    Update.BufferRange  = Size;
+}
+
+void ShaderResourceBindingTemplate::Apply(IShaderResourceBinding* pSRB, SET_SHADER_RESOURCE_FLAGS Flags) const
+{
+    DEV_CHECK_ERR(pSRB != nullptr, "SRB must not be null");
+    DEV_CHECK_ERR(pSRB->GetPipelineResourceSignature()->IsCompatibleWith(m_pSignature),
+                  "The signature of the SRB is not compatible with the signature the template was created for");
+
+    if (!m_Updates.empty())
+        pSRB->SetResources(m_Updates.data(), static_cast<Uint32>(m_Updates.size()), Flags);
+}
+
+} // namespace Diligent
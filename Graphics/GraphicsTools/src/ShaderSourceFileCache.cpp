@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderSourceFileCache.hpp"
+
+#include "DataBlobImpl.hpp"
+#include "MemoryFileStream.hpp"
+
+namespace Diligent
+{
+
+constexpr INTERFACE_ID ShaderSourceFileCache::IID_InternalImpl;
+
+RefCntAutoPtr<ShaderSourceFileCache> ShaderSourceFileCache::Create(const CreateInfo& CI)
+{
+    return RefCntAutoPtr<ShaderSourceFileCache>{MakeNewRCObj<ShaderSourceFileCache>()(CI)};
+}
+
+ShaderSourceFileCache::ShaderSourceFileCache(IReferenceCounters* pRefCounters, const CreateInfo& CI) :
+    TBase{pRefCounters},
+    m_pFactory{CI.pFactory},
+    m_GetFileTimestamp{CI.GetFileTimestamp}
+{
+    DEV_CHECK_ERR(m_pFactory, "The source stream factory must not be null");
+}
+
+void ShaderSourceFileCache::CreateInputStream(const Char* Name, IFileStream** ppStream)
+{
+    CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_NONE, ppStream);
+}
+
+void ShaderSourceFileCache::CreateInputStream2(const Char*                             Name,
+                                               CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
+                                               IFileStream**                           ppStream)
+{
+    DEV_CHECK_ERR(Name != nullptr, "Name must not be null");
+    DEV_CHECK_ERR(ppStream != nullptr, "ppStream must not be null");
+    *ppStream = nullptr;
+
+    const Uint64 Timestamp = m_GetFileTimestamp ? m_GetFileTimestamp(Name) : 0;
+
+    RefCntAutoPtr<IDataBlob> pData;
+    {
+        std::lock_guard<std::mutex> Guard{m_FilesMtx};
+
+        auto it = m_Files.find(Name);
+        if (it != m_Files.end() && it->second.Timestamp == Timestamp)
+            pData = it->second.pData;
+    }
+
+    if (!pData)
+    {
+        // Load the file without holding the lock. If several threads request the same
+        // file at the same time, each loads it, and the last one replaces the entry.
+        RefCntAutoPtr<IFileStream> pSourceStream;
+        m_pFactory->CreateInputStream2(Name, Flags, &pSourceStream);
+        if (!pSourceStream)
+            return;
+
+        pData = DataBlobImpl::Create();
+        pSourceStream->ReadBlob(pData);
+
+        FileInfo File;
+        File.pData     = pData;
+        File.Timestamp = Timestamp;
+        if (pData->GetSize() > 0)
+        {
+            XXH128State Hasher;
+            Hasher.UpdateRaw(pData->GetConstDataPtr(), pData->GetSize());
+            File.Hash = Hasher.Digest();
+        }
+
+        std::lock_guard<std::mutex> Guard{m_FilesMtx};
+        m_Files[Name] = std::move(File);
+    }
+
+    // The data blob is shared by all streams, which are only ever read
+    auto pStream = MemoryFileStream::Create(pData);
+    pStream->QueryInterface(IID_FileStream, reinterpret_cast<IObject**>(ppStream));
+}
+
+bool ShaderSourceFileCache::GetFileHash(const Char* Name, XXH128Hash& Hash)
+{
+    std::lock_guard<std::mutex> Guard{m_FilesMtx};
+
+    auto it = m_Files.find(Name);
+    if (it == m_Files.end())
+        return false;
+
+    Hash = it->second.Hash;
+    return true;
+}
+
+void ShaderSourceFileCache::InvalidateFile(const Char* Name)
+{
+    std::lock_guard<std::mutex> Guard{m_FilesMtx};
+    m_Files.erase(Name);
+}
+
+void ShaderSourceFileCache::Clear()
+{
+    std::lock_guard<std::mutex> Guard{m_FilesMtx};
+    m_Files.clear();
+}
+
+} // namespace Diligent
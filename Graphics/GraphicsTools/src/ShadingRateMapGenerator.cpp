@@ -0,0 +1,350 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ShadingRateMapGenerator.hpp"
+
+#include <algorithm>
+
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../GraphicsEngine/interface/Shader.h"
+#include "GraphicsUtilities.h"
+#include "MapHelper.hpp"
+#include "ShaderMacroHelper.hpp"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// clang-format off
+static constexpr char ShadingRateShaderSource[] = R"(
+cbuffer cbShadingRateAttribs
+{
+    uint2  g_RTSize;
+    uint2  g_TileSize;
+
+    float2 g_MotionVectorScale;
+    float  g_LuminanceThreshold;
+    float  g_MotionSensitivity;
+
+    // Supported shading rate for every requested rate
+    uint4  g_RateRemap[4];
+};
+
+Texture2D<float4> g_Color;
+#if USE_MOTION_VECTORS
+Texture2D<float2> g_MotionVectors;
+#endif
+
+#if SHADING_RATE_UNORM8
+RWTexture2D<float2> g_ShadingRate;
+#else
+RWTexture2D<uint>   g_ShadingRate;
+#endif
+
+#define GROUP_SIZE_X 8
+#define GROUP_SIZE_Y 8
+
+// Gradient sum and pair count along X and Y
+groupshared float4 s_Gradients[GROUP_SIZE_X * GROUP_SIZE_Y];
+// Motion length sum and pixel count
+groupshared float2 s_Motion[GROUP_SIZE_X * GROUP_SIZE_Y];
+
+float GetLuminance(uint2 Pixel)
+{
+    return dot(g_Color.Load(int3(Pixel, 0)).rgb, float3(0.2126, 0.7152, 0.0722));
+}
+
+// Returns the axis shading rate: 0 - 1x, 1 - 2x, 2 - 4x
+uint GetAxisRate(float Gradient, float Threshold)
+{
+    if (Gradient * 2.0 < Threshold)
+        return 2u;
+    if (Gradient < Threshold)
+        return 1u;
+    return 0u;
+}
+
+[numthreads(GROUP_SIZE_X, GROUP_SIZE_Y, 1)]
+void main(uint3 Gid : SV_GroupID,
+          uint3 GTid : SV_GroupThreadID,
+          uint  GI : SV_GroupIndex)
+{
+    uint2 TileStart = Gid.xy * g_TileSize;
+    uint2 TileEnd   = min(TileStart + g_TileSize, g_RTSize);
+
+    float4 Gradients = float4(0.0, 0.0, 0.0, 0.0);
+    float2 Motion    = float2(0.0, 0.0);
+    for (uint y = TileStart.y + GTid.y; y < TileEnd.y; y += GROUP_SIZE_Y)
+    {
+        for (uint x = TileStart.x + GTid.x; x < TileEnd.x; x += GROUP_SIZE_X)
+        {
+            float L = GetLuminance(uint2(x, y));
+            if (x + 1u < TileEnd.x)
+                Gradients.xy += float2(abs(GetLuminance(uint2(x + 1u, y)) - L), 1.0);
+            if (y + 1u < TileEnd.y)
+                Gradients.zw += float2(abs(GetLuminance(uint2(x, y + 1u)) - L), 1.0);
+#if USE_MOTION_VECTORS
+            Motion += float2(length(g_MotionVectors.Load(int3(x, y, 0)) * g_MotionVectorScale), 1.0);
+#endif
+        }
+    }
+    s_Gradients[GI] = Gradients;
+    s_Motion[GI]    = Motion;
+    GroupMemoryBarrierWithGroupSync();
+
+    for (uint Stride = (GROUP_SIZE_X * GROUP_SIZE_Y) / 2u; Stride > 0u; Stride >>= 1u)
+    {
+        if (GI < Stride)
+        {
+            s_Gradients[GI] += s_Gradients[GI + Stride];
+            s_Motion[GI]    += s_Motion[GI + Stride];
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    if (GI != 0u)
+        return;
+
+    Gradients = s_Gradients[0];
+    Motion    = s_Motion[0];
+
+    float Velocity  = Motion.y > 0.0 ? Motion.x / Motion.y : 0.0;
+    float Threshold = g_LuminanceThreshold * (1.0 + g_MotionSensitivity * Velocity);
+
+    // Tiles that are one pixel wide or high have no gradients along that axis
+    uint RateX = Gradients.y > 0.0 ? GetAxisRate(Gradients.x / Gradients.y, Threshold) : 0u;
+    uint RateY = Gradients.w > 0.0 ? GetAxisRate(Gradients.z / Gradients.w, Threshold) : 0u;
+
+    uint Rate = g_RateRemap[RateX][RateY];
+#if SHADING_RATE_UNORM8
+    g_ShadingRate[Gid.xy] = float2(1.0 / float(1u << (Rate >> 2u)), 1.0 / float(1u << (Rate & 3u)));
+#else
+    g_ShadingRate[Gid.xy] = Rate;
+#endif
+}
+)";
+// clang-format on
+
+struct ShadingRateAttribs
+{
+    Uint32 RTSize[2]   = {};
+    Uint32 TileSize[2] = {};
+
+    float2 MotionVectorScale;
+    float  LuminanceThreshold = 0;
+    float  MotionSensitivity  = 0;
+
+    // uint4 g_RateRemap[4] in the shader: element [X][Y] is the rate for the requested X and Y axis rates
+    Uint32 RateRemap[4][4] = {};
+};
+static_assert(sizeof(ShadingRateAttribs) % 16 == 0, "Constant buffer size must be a multiple of 16 bytes");
+
+const ShadingRateProperties& ValidateShadingRateProperties(IRenderDevice* pDevice)
+{
+    if (pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    if (!DeviceInfo.Features.ComputeShaders)
+        LOG_ERROR_AND_THROW("ShadingRateMapGenerator requires compute shaders");
+    if (!DeviceInfo.Features.VariableRateShading)
+        LOG_ERROR_AND_THROW("ShadingRateMapGenerator requires variable rate shading");
+
+    const auto& SRProps = pDevice->GetAdapterInfo().ShadingRate;
+    if ((SRProps.CapFlags & SHADING_RATE_CAP_FLAG_TEXTURE_BASED) == 0)
+        LOG_ERROR_AND_THROW("The device does not support texture-based variable rate shading");
+    if (SRProps.Format != SHADING_RATE_FORMAT_PALETTE && SRProps.Format != SHADING_RATE_FORMAT_UNORM8)
+        LOG_ERROR_AND_THROW("Shading rate format ", Uint32{SRProps.Format}, " is not supported by ShadingRateMapGenerator");
+    if ((SRProps.BindFlags & BIND_UNORDERED_ACCESS) == 0)
+        LOG_ERROR_AND_THROW("The device does not allow writing shading rate textures in compute shaders");
+    if (SRProps.MaxTileSize[0] == 0 || SRProps.MaxTileSize[1] == 0)
+        LOG_ERROR_AND_THROW("The device reports zero shading rate tile size");
+
+    return SRProps;
+}
+
+} // namespace
+
+ShadingRateMapGenerator::ShadingRateMapGenerator(const CreateInfo& CI) :
+    m_pDevice{CI.pDevice},
+    m_Format{ValidateShadingRateProperties(CI.pDevice).Format},
+    m_UseMotionVectors{CI.UseMotionVectors}
+{
+    const auto& SRProps = m_pDevice->GetAdapterInfo().ShadingRate;
+
+    m_TileSize[0] = SRProps.MaxTileSize[0];
+    m_TileSize[1] = SRProps.MaxTileSize[1];
+
+    // Replace every requested rate with the coarsest supported rate that does not exceed it along either axis
+    for (Uint32 Rate = 0; Rate < _countof(m_RateRemap); ++Rate)
+    {
+        const Uint32 X = Rate >> SHADING_RATE_X_SHIFT;
+        const Uint32 Y = Rate & ((1u << SHADING_RATE_X_SHIFT) - 1u);
+
+        m_RateRemap[Rate] = SHADING_RATE_1X1;
+        for (Uint32 i = 0; i < SRProps.NumShadingRates; ++i)
+        {
+            const auto&  Mode  = SRProps.ShadingRates[i];
+            const Uint32 ModeX = Mode.Rate >> SHADING_RATE_X_SHIFT;
+            const Uint32 ModeY = Mode.Rate & ((1u << SHADING_RATE_X_SHIFT) - 1u);
+            if (ModeX > X || ModeY > Y || !Mode.HasSampleCount(CI.SampleCount))
+                continue;
+
+            const Uint32 BestX = m_RateRemap[Rate] >> SHADING_RATE_X_SHIFT;
+            const Uint32 BestY = m_RateRemap[Rate] & ((1u << SHADING_RATE_X_SHIFT) - 1u);
+            if (ModeX + ModeY > BestX + BestY)
+                m_RateRemap[Rate] = Mode.Rate;
+        }
+    }
+
+    CreateUniformBuffer(m_pDevice, sizeof(ShadingRateAttribs), "Shading rate generator constants", &m_pConstants);
+    if (!m_pConstants)
+        LOG_ERROR_AND_THROW("Failed to create the constant buffer");
+
+    ShaderMacroHelper Macros;
+    Macros.AddShaderMacro("USE_MOTION_VECTORS", m_UseMotionVectors ? 1 : 0);
+    Macros.AddShaderMacro("SHADING_RATE_UNORM8", m_Format == SHADING_RATE_FORMAT_UNORM8 ? 1 : 0);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name       = "Shading rate generator CS";
+    ShaderCI.EntryPoint      = "main";
+    ShaderCI.Source          = ShadingRateShaderSource;
+    ShaderCI.Macros          = Macros;
+
+    RefCntAutoPtr<IShader> pCS;
+    m_pDevice->CreateShader(ShaderCI, &pCS);
+    if (!pCS)
+        LOG_ERROR_AND_THROW("Failed to create the shading rate generator shader");
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name         = "Shading rate generator PSO";
+    PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.pCS                  = pCS;
+
+    ShaderResourceVariableDesc Vars[] = {
+        {SHADER_TYPE_COMPUTE, "cbShadingRateAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC} //
+    };
+    PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+    PSOCreateInfo.PSODesc.ResourceLayout.Variables           = Vars;
+    PSOCreateInfo.PSODesc.ResourceLayout.NumVariables        = _countof(Vars);
+
+    m_pDevice->CreateComputePipelineState(PSOCreateInfo, &m_pPSO);
+    if (!m_pPSO)
+        LOG_ERROR_AND_THROW("Failed to create the shading rate generator pipeline");
+
+    m_pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbShadingRateAttribs")->Set(m_pConstants);
+    m_pPSO->CreateShaderResourceBinding(&m_pSRB, true);
+    if (!m_pSRB)
+        LOG_ERROR_AND_THROW("Failed to create the shader resource binding");
+}
+
+void ShadingRateMapGenerator::CreateShadingRateTexture(Uint32 Width, Uint32 Height)
+{
+    m_pShadingRateTex.Release();
+    m_pShadingRateView.Release();
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Shading rate texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = (Width + m_TileSize[0] - 1) / m_TileSize[0];
+    TexDesc.Height    = (Height + m_TileSize[1] - 1) / m_TileSize[1];
+    TexDesc.Format    = m_Format == SHADING_RATE_FORMAT_UNORM8 ? TEX_FORMAT_RG8_UNORM : TEX_FORMAT_R8_UINT;
+    TexDesc.BindFlags = BIND_SHADING_RATE | BIND_UNORDERED_ACCESS;
+    TexDesc.Usage     = USAGE_DEFAULT;
+
+    m_pDevice->CreateTexture(TexDesc, nullptr, &m_pShadingRateTex);
+    if (!m_pShadingRateTex)
+    {
+        LOG_ERROR_MESSAGE("Failed to create the shading rate texture");
+        return;
+    }
+    m_pShadingRateView = m_pShadingRateTex->GetDefaultView(TEXTURE_VIEW_SHADING_RATE);
+
+    m_RTWidth  = Width;
+    m_RTHeight = Height;
+}
+
+void ShadingRateMapGenerator::Generate(IDeviceContext* pContext, const GenerateAttribs& Attribs)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(Attribs.pColor != nullptr, "Color texture view must not be null");
+    DEV_CHECK_ERR(!m_UseMotionVectors || Attribs.pMotionVectors != nullptr, "Motion vectors texture view must not be null");
+
+    const auto& ColorDesc = Attribs.pColor->GetTexture()->GetDesc();
+    const auto& ViewDesc  = Attribs.pColor->GetDesc();
+    const auto  Width     = std::max(ColorDesc.Width >> ViewDesc.MostDetailedMip, 1u);
+    const auto  Height    = std::max(ColorDesc.Height >> ViewDesc.MostDetailedMip, 1u);
+    if (!m_pShadingRateTex || m_RTWidth != Width || m_RTHeight != Height)
+    {
+        CreateShadingRateTexture(Width, Height);
+        if (!m_pShadingRateTex)
+            return;
+    }
+
+    {
+        MapHelper<ShadingRateAttribs> Constants{pContext, m_pConstants, MAP_WRITE, MAP_FLAG_DISCARD};
+        Constants->RTSize[0]          = Width;
+        Constants->RTSize[1]          = Height;
+        Constants->TileSize[0]        = m_TileSize[0];
+        Constants->TileSize[1]        = m_TileSize[1];
+        Constants->MotionVectorScale  = Attribs.MotionVectorScale;
+        Constants->LuminanceThreshold = Attribs.LuminanceThreshold;
+        Constants->MotionSensitivity  = Attribs.MotionSensitivity;
+        for (Uint32 X = 0; X <= AXIS_SHADING_RATE_MAX; ++X)
+        {
+            for (Uint32 Y = 0; Y <= AXIS_SHADING_RATE_MAX; ++Y)
+                Constants->RateRemap[X][Y] = m_RateRemap[(X << SHADING_RATE_X_SHIFT) | Y];
+        }
+    }
+
+    m_pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Color")->Set(Attribs.pColor);
+    if (m_UseMotionVectors)
+        m_pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_MotionVectors")->Set(Attribs.pMotionVectors);
+    m_pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_ShadingRate")->Set(m_pShadingRateTex->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+
+    pContext->SetPipelineState(m_pPSO);
+    pContext->CommitShaderResources(m_pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    const auto& TexDesc = m_pShadingRateTex->GetDesc();
+
+    DispatchComputeAttribs DispatchAttribs;
+    DispatchAttribs.ThreadGroupCountX   = TexDesc.Width;
+    DispatchAttribs.ThreadGroupCountY   = TexDesc.Height;
+    DispatchAttribs.MtlThreadGroupSizeX = 8;
+    DispatchAttribs.MtlThreadGroupSizeY = 8;
+    DispatchAttribs.MtlThreadGroupSizeZ = 1;
+    pContext->DispatchCompute(DispatchAttribs);
+}
+
+} // namespace Diligent
@@ -0,0 +1,451 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "SparseResidencyManager.hpp"
+
+#include <algorithm>
+#include <functional>
+
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "Align.hpp"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Bit layout of the packed tile identifier. The mip level occupies the most significant
+// bits, so that sorting the keys in descending order puts less detailed levels first.
+constexpr Uint32 TileCoordBits = 20;
+constexpr Uint32 TileSliceBits = 16;
+constexpr Uint32 TileMipBits   = 8;
+static_assert(2 * TileCoordBits + TileSliceBits + TileMipBits <= 64, "Packed tile identifier does not fit into 64 bits");
+
+constexpr Uint64 TileCoordMask = (Uint64{1} << TileCoordBits) - 1;
+constexpr Uint64 TileSliceMask = (Uint64{1} << TileSliceBits) - 1;
+constexpr Uint64 TileMipMask   = (Uint64{1} << TileMipBits) - 1;
+
+constexpr Uint8 FeedbackNotAccessed = 0xFF;
+
+IRenderDevice* ValidateDevice(IRenderDevice* pDevice)
+{
+    if (pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+    return pDevice;
+}
+
+ITexture* ValidateTexture(ITexture* pTexture)
+{
+    if (pTexture == nullptr)
+        LOG_ERROR_AND_THROW("Sparse texture must not be null");
+
+    const auto& Desc = pTexture->GetDesc();
+    if (Desc.Usage != USAGE_SPARSE)
+        LOG_ERROR_AND_THROW("Texture '", Desc.Name, "' must be created with USAGE_SPARSE");
+    if (Desc.Type != RESOURCE_DIM_TEX_2D && Desc.Type != RESOURCE_DIM_TEX_2D_ARRAY)
+        LOG_ERROR_AND_THROW("Texture '", Desc.Name, "' must be a 2D texture or a 2D texture array");
+    if (Desc.GetArraySize() > (Uint32{1} << TileSliceBits))
+        LOG_ERROR_AND_THROW("Texture '", Desc.Name, "' array size (", Desc.GetArraySize(), ") is too large");
+
+    return pTexture;
+}
+
+} // namespace
+
+SparseResidencyManager::SparseResidencyManager(const CreateInfo& CI) :
+    // clang-format off
+    m_pDevice        {ValidateDevice(CI.pDevice)},
+    m_pTexture       {ValidateTexture(CI.pTexture)},
+    m_pMemory        {CI.pMemory},
+    m_BlockSize      {m_pTexture->GetSparseProperties().BlockSize},
+    m_MemoryBudget   {CI.MemoryBudget != 0 ? CI.MemoryBudget : m_pTexture->GetSparseProperties().AddressSpaceSize},
+    m_MinTileLifetime{CI.MinTileLifetime}
+// clang-format on
+{
+    const auto& TexDesc = m_pTexture->GetDesc();
+    if (m_BlockSize == 0)
+        LOG_ERROR_AND_THROW("Sparse block size of texture '", TexDesc.Name, "' is zero");
+
+    if (!m_pMemory)
+    {
+        // Memory pages must be multiples of the block size, and a memory range that is bound
+        // to a tile must not cross the page boundary.
+        const Uint64 PageSize = m_BlockSize * std::max(std::min(Uint64{CI.TilesPerMemoryPage}, m_MemoryBudget / m_BlockSize), Uint64{1});
+
+        IDeviceObject* pCompatibleResource = m_pTexture;
+
+        DeviceMemoryCreateInfo MemCI;
+        MemCI.Desc.Name                 = "Sparse residency manager memory";
+        MemCI.Desc.Type                 = DEVICE_MEMORY_TYPE_SPARSE;
+        MemCI.Desc.PageSize             = PageSize;
+        MemCI.Desc.ImmediateContextMask = CI.ImmediateContextMask;
+        MemCI.InitialSize               = PageSize;
+        MemCI.ppCompatibleResources     = &pCompatibleResource;
+        MemCI.NumResources              = 1;
+        m_pDevice->CreateDeviceMemory(MemCI, &m_pMemory);
+        if (!m_pMemory)
+            LOG_ERROR_AND_THROW("Failed to create memory for sparse texture '", TexDesc.Name, "'");
+    }
+    else
+    {
+        DEV_CHECK_ERR(m_pMemory->GetDesc().PageSize % m_BlockSize == 0,
+                      "Memory page size (", m_pMemory->GetDesc().PageSize, ") must be a multiple of the texture block size (", m_BlockSize, ")");
+        DEV_CHECK_ERR(m_pMemory->IsCompatible(m_pTexture), "Memory is not compatible with texture '", TexDesc.Name, "'");
+    }
+
+    const auto NumBlocks = std::min(m_pMemory->GetCapacity(), m_MemoryBudget) / m_BlockSize;
+    m_FreeBlocks.reserve(static_cast<size_t>(NumBlocks));
+    // Keep the blocks with the lowest indices at the end, so that they are allocated first
+    for (Uint64 Block = NumBlocks; Block > 0; --Block)
+        m_FreeBlocks.push_back(static_cast<Uint32>(Block - 1));
+    m_NumMemoryBlocks = NumBlocks;
+
+    // Direct3D11 has a single immediate context that executes all commands in order
+    if (m_pDevice->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_D3D11)
+    {
+        FenceDesc Desc;
+        Desc.Name = "Sparse residency manager fence";
+        Desc.Type = FENCE_TYPE_GENERAL;
+        m_pDevice->CreateFence(Desc, &m_pFence);
+        if (!m_pFence)
+            LOG_ERROR_AND_THROW("Failed to create sparse residency manager fence");
+    }
+}
+
+SparseResidencyManager::~SparseResidencyManager()
+{
+}
+
+SparseResidencyManager::TileKey SparseResidencyManager::PackTileId(const TileId& Tile) const
+{
+    return (Uint64{Tile.MipLevel} << (2 * TileCoordBits + TileSliceBits)) |
+        (Uint64{Tile.Slice} << (2 * TileCoordBits)) |
+        (Uint64{Tile.Y} << TileCoordBits) |
+        Uint64{Tile.X};
+}
+
+SparseResidencyManager::TileId SparseResidencyManager::UnpackTileId(TileKey Key) const
+{
+    return TileId{
+        static_cast<Uint32>((Key >> (2 * TileCoordBits + TileSliceBits)) & TileMipMask),
+        static_cast<Uint32>((Key >> (2 * TileCoordBits)) & TileSliceMask),
+        static_cast<Uint32>(Key & TileCoordMask),
+        static_cast<Uint32>((Key >> TileCoordBits) & TileCoordMask),
+    };
+}
+
+Uint32 SparseResidencyManager::GetNumTilesX(Uint32 MipLevel) const
+{
+    const auto MipWidth = std::max(m_pTexture->GetDesc().Width >> MipLevel, 1u);
+    return (MipWidth + m_pTexture->GetSparseProperties().TileSize[0] - 1) / m_pTexture->GetSparseProperties().TileSize[0];
+}
+
+Uint32 SparseResidencyManager::GetNumTilesY(Uint32 MipLevel) const
+{
+    const auto MipHeight = std::max(m_pTexture->GetDesc().Height >> MipLevel, 1u);
+    return (MipHeight + m_pTexture->GetSparseProperties().TileSize[1] - 1) / m_pTexture->GetSparseProperties().TileSize[1];
+}
+
+bool SparseResidencyManager::ValidateTileId(const TileId& Tile) const
+{
+    const auto& TexDesc = m_pTexture->GetDesc();
+    const auto& Props   = m_pTexture->GetSparseProperties();
+
+    // clang-format off
+    return Tile.MipLevel < std::min(Props.FirstMipInTail, TexDesc.MipLevels) &&
+           Tile.Slice    < TexDesc.GetArraySize() &&
+           Tile.X        < GetNumTilesX(Tile.MipLevel) &&
+           Tile.Y        < GetNumTilesY(Tile.MipLevel);
+    // clang-format on
+}
+
+Box SparseResidencyManager::GetTileRegion(const TileId& Tile) const
+{
+    const auto& TexDesc   = m_pTexture->GetDesc();
+    const auto& Props     = m_pTexture->GetSparseProperties();
+    const auto  MipWidth  = std::max(TexDesc.Width >> Tile.MipLevel, 1u);
+    const auto  MipHeight = std::max(TexDesc.Height >> Tile.MipLevel, 1u);
+
+    Box Region;
+    Region.MinX = Tile.X * Props.TileSize[0];
+    Region.MaxX = std::min(Region.MinX + Props.TileSize[0], MipWidth);
+    Region.MinY = Tile.Y * Props.TileSize[1];
+    Region.MaxY = std::min(Region.MinY + Props.TileSize[1], MipHeight);
+    Region.MinZ = 0;
+    Region.MaxZ = 1;
+    return Region;
+}
+
+void SparseResidencyManager::RequestTile(const TileId& Tile)
+{
+    if (!ValidateTileId(Tile))
+    {
+        DEV_ERROR("Tile (", Tile.X, ", ", Tile.Y, ") of mip level ", Tile.MipLevel, ", slice ", Tile.Slice, " is out of range");
+        return;
+    }
+    m_RequestedTiles.insert(PackTileId(Tile));
+}
+
+void SparseResidencyManager::ProcessFeedback(const Uint8* pMinMip,
+                                             Uint32       Width,
+                                             Uint32       Height,
+                                             Uint32       Stride,
+                                             Uint32       Slice)
+{
+    DEV_CHECK_ERR(pMinMip != nullptr || Width == 0 || Height == 0, "Feedback data must not be null");
+    DEV_CHECK_ERR(Stride >= Width, "Feedback map stride (", Stride, ") must not be less than the width (", Width, ")");
+
+    const auto& TexDesc = m_pTexture->GetDesc();
+    const auto& Props   = m_pTexture->GetSparseProperties();
+    if (Slice >= TexDesc.GetArraySize())
+    {
+        DEV_ERROR("Slice ", Slice, " is out of range");
+        return;
+    }
+
+    const Uint32 NumTiledMips = std::min(Props.FirstMipInTail, TexDesc.MipLevels);
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        const auto* pRow = pMinMip + size_t{y} * size_t{Stride};
+        // The region of the most detailed mip level that is covered by the feedback texel
+        const auto MinY = static_cast<Uint32>(Uint64{y} * TexDesc.Height / Height);
+        const auto MaxY = std::max(static_cast<Uint32>(Uint64{y + 1} * TexDesc.Height / Height), MinY + 1);
+        for (Uint32 x = 0; x < Width; ++x)
+        {
+            if (pRow[x] == FeedbackNotAccessed)
+                continue;
+
+            const auto MinX = static_cast<Uint32>(Uint64{x} * TexDesc.Width / Width);
+            const auto MaxX = std::max(static_cast<Uint32>(Uint64{x + 1} * TexDesc.Width / Width), MinX + 1);
+            for (Uint32 Mip = pRow[x]; Mip < NumTiledMips; ++Mip)
+            {
+                // Tile dimensions in the pixels of the most detailed level
+                const auto TileW     = Props.TileSize[0] << Mip;
+                const auto TileH     = Props.TileSize[1] << Mip;
+                const auto LastTileX = std::min((MaxX - 1) / TileW, GetNumTilesX(Mip) - 1);
+                const auto LastTileY = std::min((MaxY - 1) / TileH, GetNumTilesY(Mip) - 1);
+                for (Uint32 TileY = MinY / TileH; TileY <= LastTileY; ++TileY)
+                {
+                    for (Uint32 TileX = MinX / TileW; TileX <= LastTileX; ++TileX)
+                        m_RequestedTiles.insert(PackTileId(TileId{Mip, Slice, TileX, TileY}));
+                }
+            }
+        }
+    }
+}
+
+bool SparseResidencyManager::IsTileResident(const TileId& Tile) const
+{
+    return m_ResidentTiles.find(PackTileId(Tile)) != m_ResidentTiles.end();
+}
+
+bool SparseResidencyManager::GrowMemory()
+{
+    const auto PageSize    = m_pMemory->GetDesc().PageSize;
+    const auto OldCapacity = m_pMemory->GetCapacity();
+    if (PageSize == 0 || OldCapacity + PageSize > m_MemoryBudget)
+        return false;
+
+    // Some implementations do not support resizing and return true without changing the capacity
+    if (!m_pMemory->Resize(OldCapacity + PageSize))
+        return false;
+
+    const auto NumBlocks = std::min(m_pMemory->GetCapacity(), m_MemoryBudget) / m_BlockSize;
+    if (NumBlocks <= m_NumMemoryBlocks)
+        return false;
+
+    for (Uint64 Block = NumBlocks; Block > m_NumMemoryBlocks; --Block)
+        m_FreeBlocks.push_back(static_cast<Uint32>(Block - 1));
+    m_NumMemoryBlocks = NumBlocks;
+
+    return true;
+}
+
+bool SparseResidencyManager::AllocateBlock(Uint32& Block, std::vector<SparseTextureMemoryBindRange>& Ranges)
+{
+    if (m_FreeBlocks.empty() && !GrowMemory())
+    {
+        // Evict the least recently requested tile, unless it may still be in use
+        if (m_LRU.empty() || m_LRU.back().LastRequest + m_MinTileLifetime > m_UpdateIndex)
+            return false;
+
+        const auto& Evicted = m_LRU.back();
+        const auto  Tile    = UnpackTileId(Evicted.Key);
+
+        SparseTextureMemoryBindRange Range;
+        Range.MipLevel   = Tile.MipLevel;
+        Range.ArraySlice = Tile.Slice;
+        Range.Region     = GetTileRegion(Tile);
+        Range.MemorySize = m_BlockSize;
+        Range.pMemory    = nullptr;
+        Ranges.push_back(Range);
+
+        m_EvictedTiles.push_back(Tile);
+        m_FreeBlocks.push_back(Evicted.Block);
+        m_ResidentTiles.erase(Evicted.Key);
+        m_LRU.pop_back();
+    }
+
+    VERIFY_EXPR(!m_FreeBlocks.empty());
+    Block = m_FreeBlocks.back();
+    m_FreeBlocks.pop_back();
+    return true;
+}
+
+void SparseResidencyManager::BindMipTail(std::vector<SparseTextureMemoryBindRange>& Ranges)
+{
+    const auto& TexDesc = m_pTexture->GetDesc();
+    const auto& Props   = m_pTexture->GetSparseProperties();
+    const bool  IsMetal = m_pDevice->GetDeviceInfo().IsMetalDevice();
+
+    m_MipTailBound = true;
+    if (Props.FirstMipInTail >= TexDesc.MipLevels)
+        return;
+
+    const Uint32 NumMipTails = (Props.Flags & SPARSE_TEXTURE_FLAG_SINGLE_MIPTAIL) != 0 ? 1 : TexDesc.GetArraySize();
+    for (Uint32 Slice = 0; Slice < NumMipTails; ++Slice)
+    {
+        for (Uint64 OffsetInMipTail = 0; OffsetInMipTail < Props.MipTailSize; OffsetInMipTail += m_BlockSize)
+        {
+            Uint32 Block = 0;
+            if (!AllocateBlock(Block, Ranges))
+            {
+                LOG_ERROR_MESSAGE("Memory budget (", m_MemoryBudget, " bytes) is not enough to keep the mip tail of texture '", TexDesc.Name, "' resident");
+                return;
+            }
+
+            // In Metal, the mip tail must be bound with a single range
+            if (IsMetal && OffsetInMipTail > 0)
+                continue;
+
+            SparseTextureMemoryBindRange Range;
+            Range.MipLevel        = Props.FirstMipInTail;
+            Range.ArraySlice      = Slice;
+            Range.OffsetInMipTail = OffsetInMipTail;
+            Range.MemoryOffset    = Uint64{Block} * m_BlockSize;
+            Range.MemorySize      = IsMetal ? Props.MipTailSize : m_BlockSize;
+            Range.pMemory         = m_pMemory;
+            Ranges.push_back(Range);
+        }
+    }
+}
+
+Uint64 SparseResidencyManager::Update(const UpdateAttribs& Attribs)
+{
+    DEV_CHECK_ERR(Attribs.pSparseBindingContext != nullptr, "Sparse binding context must not be null");
+    DEV_CHECK_ERR((Attribs.pSparseBindingContext->GetDesc().QueueType & COMMAND_QUEUE_TYPE_SPARSE_BINDING) == COMMAND_QUEUE_TYPE_SPARSE_BINDING,
+                  "Context '", Attribs.pSparseBindingContext->GetDesc().Name, "' does not support sparse binding");
+
+    ++m_UpdateIndex;
+    m_NewlyResidentTiles.clear();
+    m_EvictedTiles.clear();
+
+    std::vector<SparseTextureMemoryBindRange> Ranges;
+    if (!m_MipTailBound)
+        BindMipTail(Ranges);
+
+    // Mark the requested resident tiles as recently used first, so that they are not evicted
+    // to make room for the new ones.
+    std::vector<TileKey> NewTiles;
+    NewTiles.reserve(m_RequestedTiles.size());
+    for (auto Key : m_RequestedTiles)
+    {
+        auto it = m_ResidentTiles.find(Key);
+        if (it != m_ResidentTiles.end())
+        {
+            it->second->LastRequest = m_UpdateIndex;
+            m_LRU.splice(m_LRU.begin(), m_LRU, it->second);
+        }
+        else
+        {
+            NewTiles.push_back(Key);
+        }
+    }
+    m_RequestedTiles.clear();
+
+    // Less detailed levels cover larger regions and are used as the fallback, so bind them first
+    std::sort(NewTiles.begin(), NewTiles.end(), std::greater<TileKey>{});
+    for (auto Key : NewTiles)
+    {
+        Uint32 Block = 0;
+        if (!AllocateBlock(Block, Ranges))
+            break;
+
+        const auto Tile = UnpackTileId(Key);
+
+        SparseTextureMemoryBindRange Range;
+        Range.MipLevel     = Tile.MipLevel;
+        Range.ArraySlice   = Tile.Slice;
+        Range.Region       = GetTileRegion(Tile);
+        Range.MemoryOffset = Uint64{Block} * m_BlockSize;
+        Range.MemorySize   = m_BlockSize;
+        Range.pMemory      = m_pMemory;
+        Ranges.push_back(Range);
+
+        m_LRU.emplace_front(ResidentTile{Key, Block, m_UpdateIndex});
+        m_ResidentTiles.emplace(Key, m_LRU.begin());
+        m_NewlyResidentTiles.push_back(Tile);
+    }
+
+    if (Ranges.empty())
+        return 0;
+
+    SparseTextureMemoryBindInfo TexBind;
+    TexBind.pTexture  = m_pTexture;
+    TexBind.pRanges   = Ranges.data();
+    TexBind.NumRanges = static_cast<Uint32>(Ranges.size());
+
+    BindSparseResourceMemoryAttribs BindAttribs;
+    BindAttribs.pTextureBinds   = &TexBind;
+    BindAttribs.NumTextureBinds = 1;
+
+    IFence* pWaitFence = Attribs.pWaitFence;
+    if (pWaitFence != nullptr)
+    {
+        BindAttribs.ppWaitFences     = &pWaitFence;
+        BindAttribs.pWaitFenceValues = &Attribs.WaitFenceValue;
+        BindAttribs.NumWaitFences    = 1;
+    }
+
+    IFence*      pSignalFence = m_pFence;
+    const Uint64 FenceValue   = m_pFence ? m_NextFenceValue++ : 0;
+    if (pSignalFence != nullptr)
+    {
+        BindAttribs.ppSignalFences     = &pSignalFence;
+        BindAttribs.pSignalFenceValues = &FenceValue;
+        BindAttribs.NumSignalFences    = 1;
+    }
+
+    Attribs.pSparseBindingContext->BindSparseResourceMemory(BindAttribs);
+
+    return FenceValue;
+}
+
+} // namespace Diligent
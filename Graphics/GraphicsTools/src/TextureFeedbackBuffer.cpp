@@ -0,0 +1,107 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TextureFeedbackBuffer.hpp"
+
+#include <algorithm>
+
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Must match TEXTURE_FEEDBACK_NOT_ACCESSED in HLSLDefinitions.fxh
+constexpr Uint32 FeedbackNotAccessed = 0xFF;
+
+} // namespace
+
+TextureFeedbackBuffer::TextureFeedbackBuffer(const CreateInfo& CI) :
+    // clang-format off
+    m_Width    {CI.Width},
+    m_Height   {CI.Height},
+    m_NumSlices{CI.NumSlices}
+// clang-format on
+{
+    if (CI.pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+    if (m_Width == 0 || m_Height == 0 || m_NumSlices == 0)
+        LOG_ERROR_AND_THROW("Feedback map dimensions (", m_Width, "x", m_Height, "x", m_NumSlices, ") must not be zero");
+
+    m_ClearData.resize(size_t{m_Width} * size_t{m_Height} * size_t{m_NumSlices}, FeedbackNotAccessed);
+
+    BufferDesc Desc;
+    Desc.Name              = CI.Name != nullptr ? CI.Name : "Texture feedback buffer";
+    Desc.Size              = m_ClearData.size() * sizeof(Uint32);
+    Desc.BindFlags         = BIND_UNORDERED_ACCESS;
+    Desc.Usage             = USAGE_DEFAULT;
+    Desc.Mode              = BUFFER_MODE_STRUCTURED;
+    Desc.ElementByteStride = sizeof(Uint32);
+
+    BufferData InitData{m_ClearData.data(), Desc.Size};
+    CI.pDevice->CreateBuffer(Desc, &InitData, &m_pBuffer);
+    if (!m_pBuffer)
+        LOG_ERROR_AND_THROW("Failed to create texture feedback buffer");
+}
+
+void TextureFeedbackBuffer::Clear(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    pContext->UpdateBuffer(m_pBuffer, 0, m_pBuffer->GetDesc().Size, m_ClearData.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+bool TextureFeedbackBuffer::Readback(IDeviceContext* pContext, AsyncReadbackQueue& ReadbackQueue, CallbackType Callback)
+{
+    DEV_CHECK_ERR(Callback, "Callback must not be null");
+
+    const auto Width     = m_Width;
+    const auto Height    = m_Height;
+    const auto NumSlices = m_NumSlices;
+    return ReadbackQueue.ReadBuffer(
+        pContext, m_pBuffer, 0, m_pBuffer->GetDesc().Size,
+        [Width, Height, NumSlices, Callback = std::move(Callback)](const AsyncReadbackQueue::ReadbackData& Data) {
+            if (Data.pData == nullptr)
+                return;
+
+            // Convert the feedback map of every slice into the 8-bit min-mip map
+            const auto*        pSrc = static_cast<const Uint32*>(Data.pData);
+            std::vector<Uint8> MinMip(size_t{Width} * size_t{Height});
+            for (Uint32 Slice = 0; Slice < NumSlices; ++Slice)
+            {
+                std::transform(pSrc, pSrc + MinMip.size(), MinMip.begin(),
+                               [](Uint32 Mip) { return static_cast<Uint8>(std::min(Mip, FeedbackNotAccessed)); });
+                Callback(MinMip.data(), Width, Height, Width, Slice);
+                pSrc += MinMip.size();
+            }
+        });
+}
+
+} // namespace Diligent
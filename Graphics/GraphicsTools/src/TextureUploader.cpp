@@ -26,7 +26,13 @@
  */
 
 #include "TextureUploader.hpp"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
 
 #if D3D11_SUPPORTED
 #    include "TextureUploaderD3D11.hpp"
@@ -75,4 +81,137 @@ void CreateTextureUploader(IRenderDevice* pDevice, const TextureUploaderDesc& De
         (*ppUploader)->AddRef();
 }
 
+namespace
+{
+
+struct TranscodeState
+{
+    explicit TranscodeState(const TextureTranscodeAttribs& _Attribs) :
+        Attribs{_Attribs},
+        pUploadBuffer{_Attribs.pUploadBuffer},
+        pUploader{_Attribs.pUploader},
+        pDstTexture{_Attribs.pDstTexture}
+    {}
+
+    void TranscodeSubresource(Uint32 Mip, Uint32 Slice, Uint32 ThreadId)
+    {
+        if (Failed.load())
+            return;
+
+        const auto& Desc = pUploadBuffer->GetDesc();
+
+        const auto MipProps = GetMipLevelProperties(
+            TextureDesc{
+                nullptr,
+                Desc.Depth > 1 ? RESOURCE_DIM_TEX_3D : RESOURCE_DIM_TEX_2D_ARRAY,
+                Desc.Width,
+                Desc.Height,
+                Desc.Depth > 1 ? Desc.Depth : Desc.ArraySize,
+                Desc.Format,
+                Desc.MipLevels,
+            },
+            Mip);
+
+        TextureTranscodeSubresourceInfo Info;
+        Info.MipLevel   = Mip;
+        Info.ArraySlice = Slice;
+        Info.Width      = MipProps.LogicalWidth;
+        Info.Height     = MipProps.LogicalHeight;
+        Info.Depth      = MipProps.Depth;
+        Info.Format     = Desc.Format;
+        Info.DstData    = pUploadBuffer->GetMappedData(Mip, Slice);
+        Info.ThreadId   = ThreadId;
+        if (Info.DstData.pData == nullptr || !Attribs.TranscodeSubresource(Info))
+        {
+            LOG_ERROR_MESSAGE("Failed to transcode mip level ", Mip, ", slice ", Slice, " of the upload buffer");
+            Failed.store(true);
+        }
+    }
+
+    bool Finish()
+    {
+        if (Failed.load())
+            return false;
+
+        if (pUploader && pDstTexture)
+            pUploader->ScheduleGPUCopy(nullptr, pDstTexture, Attribs.DstArraySlice, Attribs.DstMipLevel, pUploadBuffer, Attribs.CopyPriority);
+
+        return true;
+    }
+
+    const TextureTranscodeAttribs   Attribs;
+    RefCntAutoPtr<IUploadBuffer>    pUploadBuffer;
+    RefCntAutoPtr<ITextureUploader> pUploader;
+    RefCntAutoPtr<ITexture>         pDstTexture;
+    std::atomic<bool>               Failed{false};
+};
+
+// The task that runs after all subresources are transcoded and reports the result through its status
+class TranscodeFinishTask final : public AsyncTaskBase
+{
+public:
+    TranscodeFinishTask(IReferenceCounters* pRefCounters, float fPriority, std::shared_ptr<TranscodeState> pState) :
+        AsyncTaskBase{pRefCounters, fPriority},
+        m_pState{std::move(pState)}
+    {}
+
+    virtual void Run(Uint32 ThreadId) override final
+    {
+        const auto Succeeded = m_pState->Finish();
+        m_pState.reset();
+        SetStatus(Succeeded ? ASYNC_TASK_STATUS_COMPLETE : ASYNC_TASK_STATUS_CANCELLED);
+    }
+
+private:
+    std::shared_ptr<TranscodeState> m_pState;
+};
+
+} // namespace
+
+RefCntAutoPtr<IAsyncTask> TranscodeToUploadBuffer(const TextureTranscodeAttribs& Attribs)
+{
+    DEV_CHECK_ERR(Attribs.pUploadBuffer != nullptr, "Upload buffer must not be null");
+    DEV_CHECK_ERR(Attribs.TranscodeSubresource, "Transcode callback must not be empty");
+    DEV_CHECK_ERR((Attribs.pUploader != nullptr) == (Attribs.pDstTexture != nullptr), "Texture uploader and destination texture must either both be null or both be non-null");
+
+    auto pState = std::make_shared<TranscodeState>(Attribs);
+
+    const auto& Desc = Attribs.pUploadBuffer->GetDesc();
+
+    RefCntAutoPtr<TranscodeFinishTask> pFinishTask{MakeNewRCObj<TranscodeFinishTask>()(Attribs.TaskPriority, pState)};
+    if (Attribs.pThreadPool == nullptr)
+    {
+        for (Uint32 Slice = 0; Slice < Desc.ArraySize; ++Slice)
+        {
+            for (Uint32 Mip = 0; Mip < Desc.MipLevels; ++Mip)
+                pState->TranscodeSubresource(Mip, Slice, 0);
+        }
+        pFinishTask->SetStatus(ASYNC_TASK_STATUS_RUNNING);
+        pFinishTask->Run(0);
+        return RefCntAutoPtr<IAsyncTask>{pFinishTask};
+    }
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+    Tasks.reserve(size_t{Desc.ArraySize} * size_t{Desc.MipLevels});
+    for (Uint32 Slice = 0; Slice < Desc.ArraySize; ++Slice)
+    {
+        for (Uint32 Mip = 0; Mip < Desc.MipLevels; ++Mip)
+        {
+            Tasks.emplace_back(EnqueueAsyncWork(
+                Attribs.pThreadPool,
+                [pState, Mip, Slice](Uint32 ThreadId) {
+                    pState->TranscodeSubresource(Mip, Slice, ThreadId);
+                },
+                Attribs.TaskPriority));
+        }
+    }
+
+    std::vector<IAsyncTask*> Prerequisites(Tasks.size());
+    for (size_t i = 0; i < Tasks.size(); ++i)
+        Prerequisites[i] = Tasks[i];
+    Attribs.pThreadPool->EnqueueTask(pFinishTask, Prerequisites.data(), static_cast<Uint32>(Prerequisites.size()));
+
+    return RefCntAutoPtr<IAsyncTask>{pFinishTask};
+}
+
 } // namespace Diligent
@@ -415,7 +415,8 @@ void TextureUploaderD3D11::ScheduleGPUCopy(IDeviceContext* pContext,
                                            ITexture*       pDstTexture,
                                            Uint32          ArraySlice,
                                            Uint32          MipLevel,
-                                           IUploadBuffer*  pUploadBuffer)
+                                           IUploadBuffer*  pUploadBuffer,
+                                           Uint32          Priority)
 {
     auto*                        pUploadBufferD3D11 = ClassPtrCast<UploadBufferD3D11>(pUploadBuffer);
     RefCntAutoPtr<ITextureD3D11> pDstTexD3D11(pDstTexture, IID_TextureD3D11);
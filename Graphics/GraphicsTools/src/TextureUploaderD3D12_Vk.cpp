@@ -29,6 +29,8 @@
 #include <unordered_map>
 #include <deque>
 #include <vector>
+#include <algorithm>
+#include <atomic>
 
 #include "TextureUploaderD3D12_Vk.hpp"
 #include "ThreadSignal.hpp"
@@ -110,6 +112,16 @@ public:
 
     ITexture* GetStagingTexture() { return m_pStagingTexture; }
 
+    // Returns the total size of all subresources of the staging texture
+    Uint64 GetDataSize() const
+    {
+        const auto& TexDesc  = m_pStagingTexture->GetDesc();
+        Uint64      DataSize = 0;
+        for (Uint32 Mip = 0; Mip < TexDesc.MipLevels; ++Mip)
+            DataSize += GetMipLevelProperties(TexDesc, Mip).MipSize;
+        return DataSize * TexDesc.GetArraySize();
+    }
+
     bool DbgIsCopyScheduled() const
     {
         return m_CopyScheduledSignal.IsTriggered();
@@ -150,23 +162,26 @@ struct TextureUploaderD3D12_Vk::InternalData
         RefCntAutoPtr<ITexture>      pDstTexture;
         Uint32                       DstSlice = 0;
         Uint32                       DstMip   = 0;
+        Uint32                       Priority = 0;
 
         // clang-format off
         PendingBufferOperation(Operation op, UploadTexture* pUploadTex) :
             operation     {op        },
             pUploadTexture{pUploadTex}
         {}
-        PendingBufferOperation(Operation op, UploadTexture* pUploadTex, ITexture* pDstTex, Uint32 dstSlice, Uint32 dstMip) :
+        PendingBufferOperation(Operation op, UploadTexture* pUploadTex, ITexture* pDstTex, Uint32 dstSlice, Uint32 dstMip, Uint32 priority = 0) :
             operation      {op        },
             pUploadTexture {pUploadTex},
             pDstTexture    {pDstTex   },
             DstSlice       {dstSlice  },
-            DstMip         {dstMip    }
+            DstMip         {dstMip    },
+            Priority       {priority  }
         {}
         // clang-format on
     };
 
-    InternalData(IRenderDevice* pDevice)
+    InternalData(IRenderDevice* pDevice, const TextureUploaderDesc& Desc) :
+        m_MaxCopyBytesPerUpdate{Desc.MaxCopyBytesPerUpdate}
     {
         FenceDesc fenceDesc;
         fenceDesc.Name = "Texture uploader sync fence";
@@ -195,10 +210,10 @@ struct TextureUploaderD3D12_Vk::InternalData
         return m_InWorkOperations;
     }
 
-    void EnqueueCopy(UploadTexture* pUploadBuffer, ITexture* pDstTex, Uint32 dstSlice, Uint32 dstMip)
+    void EnqueueCopy(UploadTexture* pUploadBuffer, ITexture* pDstTex, Uint32 dstSlice, Uint32 dstMip, Uint32 Priority)
     {
         std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
-        m_PendingOperations.emplace_back(PendingBufferOperation::Operation::Copy, pUploadBuffer, pDstTex, dstSlice, dstMip);
+        m_PendingOperations.emplace_back(PendingBufferOperation::Operation::Copy, pUploadBuffer, pDstTex, dstSlice, dstMip, Priority);
     }
 
     void EnqueueMap(UploadTexture* pUploadBuffer)
@@ -256,27 +271,42 @@ struct TextureUploaderD3D12_Vk::InternalData
     Uint32 GetNumPendingOperations()
     {
         std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
-        return static_cast<Uint32>(m_PendingOperations.size());
+        return static_cast<Uint32>(m_PendingOperations.size()) + GetNumDeferredCopies();
+    }
+
+    Uint32 GetNumDeferredCopies() const
+    {
+        return m_NumDeferredCopies.load();
     }
 
     void Execute(IDeviceContext* pContext, PendingBufferOperation& OperationInfo);
 
+    // Executes all pending map operations and the pending copy operations that fit into
+    // the budget in the priority order. The remaining copies are deferred to the next call.
+    void ExecutePendingOperations(IDeviceContext* pContext);
+
 private:
     std::mutex                          m_PendingOperationsMtx;
     std::vector<PendingBufferOperation> m_PendingOperations;
     std::vector<PendingBufferOperation> m_InWorkOperations;
 
+    // Copy operations deferred until the next RenderThreadUpdate. Only accessed by the render thread.
+    std::vector<PendingBufferOperation> m_DeferredCopies;
+
     std::mutex                                                                     m_UploadTexturesCacheMtx;
     std::unordered_map<UploadBufferDesc, std::deque<RefCntAutoPtr<UploadTexture>>> m_UploadTexturesCache;
 
     RefCntAutoPtr<IFence> m_pFence;
     Uint64                m_NextFenceValue      = 1;
     Uint64                m_CompletedFenceValue = 0;
+
+    const Uint64        m_MaxCopyBytesPerUpdate;
+    std::atomic<Uint32> m_NumDeferredCopies{0};
 };
 
 TextureUploaderD3D12_Vk::TextureUploaderD3D12_Vk(IReferenceCounters* pRefCounters, IRenderDevice* pDevice, const TextureUploaderDesc Desc) :
     TextureUploaderBase{pRefCounters, pDevice, Desc},
-    m_pInternalData{new InternalData(pDevice)}
+    m_pInternalData{new InternalData(pDevice, Desc)}
 {
 }
 
@@ -294,37 +324,61 @@ TextureUploaderD3D12_Vk::~TextureUploaderD3D12_Vk()
 
 void TextureUploaderD3D12_Vk::RenderThreadUpdate(IDeviceContext* pContext)
 {
-    auto& InWorkOperations = m_pInternalData->SwapMapQueues();
-    if (!InWorkOperations.empty())
+    m_pInternalData->ExecutePendingOperations(pContext);
+
+    // This must be called by the same thread that signals the fence
+    m_pInternalData->UpdatedCompletedFenceValue();
+}
+
+
+void TextureUploaderD3D12_Vk::InternalData::ExecutePendingOperations(IDeviceContext* pContext)
+{
+    auto& InWorkOperations = SwapMapQueues();
+    for (auto& OperationInfo : InWorkOperations)
     {
-        Uint32 NumCopyOperations = 0;
-        for (auto& OperationInfo : InWorkOperations)
-        {
-            m_pInternalData->Execute(pContext, OperationInfo);
-            if (OperationInfo.operation == InternalData::PendingBufferOperation::Copy)
-                ++NumCopyOperations;
-        }
+        // Map operations block worker threads, so execute them right away
+        if (OperationInfo.operation == PendingBufferOperation::Map)
+            Execute(pContext, OperationInfo);
+        else
+            m_DeferredCopies.emplace_back(std::move(OperationInfo));
+    }
+    InWorkOperations.clear();
 
-        if (NumCopyOperations > 0)
-        {
-            // The buffer may be recycled immediately after the copy scheduled is signaled,
-            // so we must signal the fence first.
-            auto SignaledFenceValue = m_pInternalData->SignalFence(pContext);
+    if (m_DeferredCopies.empty())
+        return;
 
-            for (auto& OperationInfo : InWorkOperations)
-            {
-                if (OperationInfo.operation == InternalData::PendingBufferOperation::Copy)
-                    OperationInfo.pUploadTexture->SignalCopyScheduled(SignaledFenceValue);
-            }
-        }
+    // Stable sort preserves the submission order of copies with equal priority
+    std::stable_sort(m_DeferredCopies.begin(), m_DeferredCopies.end(),
+                     [](const PendingBufferOperation& Op1, const PendingBufferOperation& Op2) {
+                         return Op1.Priority > Op2.Priority;
+                     });
 
-        InWorkOperations.clear();
+    size_t NumCopies   = 0;
+    Uint64 CopiedBytes = 0;
+    for (auto& OperationInfo : m_DeferredCopies)
+    {
+        const auto DataSize = OperationInfo.pUploadTexture->GetDataSize();
+        // Always execute at least one copy so that large copies do not stall the queue
+        if (m_MaxCopyBytesPerUpdate != 0 && NumCopies > 0 && CopiedBytes + DataSize > m_MaxCopyBytesPerUpdate)
+            break;
+
+        Execute(pContext, OperationInfo);
+        CopiedBytes += DataSize;
+        ++NumCopies;
     }
 
-    // This must be called by the same thread that signals the fence
-    m_pInternalData->UpdatedCompletedFenceValue();
-}
+    if (NumCopies > 0)
+    {
+        // The buffer may be recycled immediately after the copy scheduled is signaled,
+        // so we must signal the fence first.
+        auto SignaledFenceValue = SignalFence(pContext);
+        for (size_t i = 0; i < NumCopies; ++i)
+            m_DeferredCopies[i].pUploadTexture->SignalCopyScheduled(SignaledFenceValue);
 
+        m_DeferredCopies.erase(m_DeferredCopies.begin(), m_DeferredCopies.begin() + NumCopies);
+    }
+    m_NumDeferredCopies.store(static_cast<Uint32>(m_DeferredCopies.size()));
+}
 
 void TextureUploaderD3D12_Vk::InternalData::Execute(IDeviceContext*         pContext,
                                                     PendingBufferOperation& OperationInfo)
@@ -423,7 +477,8 @@ void TextureUploaderD3D12_Vk::ScheduleGPUCopy(IDeviceContext* pContext,
                                               ITexture*       pDstTexture,
                                               Uint32          ArraySlice,
                                               Uint32          MipLevel,
-                                              IUploadBuffer*  pUploadBuffer)
+                                              IUploadBuffer*  pUploadBuffer,
+                                              Uint32          Priority)
 {
     auto* pUploadTexture = ClassPtrCast<UploadTexture>(pUploadBuffer);
     if (pContext != nullptr)
@@ -449,7 +504,7 @@ void TextureUploaderD3D12_Vk::ScheduleGPUCopy(IDeviceContext* pContext,
     else
     {
         // Worker thread
-        m_pInternalData->EnqueueCopy(pUploadTexture, pDstTexture, ArraySlice, MipLevel);
+        m_pInternalData->EnqueueCopy(pUploadTexture, pDstTexture, ArraySlice, MipLevel, Priority);
     }
 }
 
@@ -465,6 +520,7 @@ TextureUploaderStats TextureUploaderD3D12_Vk::GetStats()
 {
     TextureUploaderStats Stats;
     Stats.NumPendingOperations = static_cast<Uint32>(m_pInternalData->GetNumPendingOperations());
+    Stats.NumDeferredCopies    = m_pInternalData->GetNumDeferredCopies();
     return Stats;
 }
 
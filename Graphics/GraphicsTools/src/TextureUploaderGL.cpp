@@ -358,7 +358,8 @@ void TextureUploaderGL::ScheduleGPUCopy(IDeviceContext* pContext,
                                         ITexture*       pDstTexture,
                                         Uint32          ArraySlice,
                                         Uint32          MipLevel,
-                                        IUploadBuffer*  pUploadBuffer)
+                                        IUploadBuffer*  pUploadBuffer,
+                                        Uint32          Priority)
 {
     auto* pUploadBufferGL = ClassPtrCast<UploadBufferGL>(pUploadBuffer);
     if (pContext != nullptr)
@@ -0,0 +1,518 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TransientResourceAllocator.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "Align.hpp"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+IRenderDevice* ValidateDevice(IRenderDevice* pDevice)
+{
+    if (pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+    return pDevice;
+}
+
+bool IsAliasingSupported(IRenderDevice* pDevice, bool DisableAliasing)
+{
+    if (DisableAliasing)
+        return false;
+
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    // In Metal, sparse textures must be created from the memory object
+    if (!DeviceInfo.Features.SparseResources || DeviceInfo.IsMetalDevice())
+        return false;
+
+    const auto& SparseRes = pDevice->GetAdapterInfo().SparseResources;
+    return (SparseRes.CapFlags & (SPARSE_RESOURCE_CAP_FLAG_ALIASED | SPARSE_RESOURCE_CAP_FLAG_TEXTURE_2D)) ==
+        (SPARSE_RESOURCE_CAP_FLAG_ALIASED | SPARSE_RESOURCE_CAP_FLAG_TEXTURE_2D) &&
+        SparseRes.StandardBlockSize != 0;
+}
+
+// Calls the handler for every memory block of the sparse texture. The memory offset of the
+// range passed to the handler is the index of the block within the texture.
+template <typename HandlerType>
+void ProcessTextureBlocks(ITexture* pTexture, HandlerType&& Handler)
+{
+    const auto& TexDesc = pTexture->GetDesc();
+    const auto& Props   = pTexture->GetSparseProperties();
+
+    Uint64 Block = 0;
+
+    const Uint32 NumTiledMips = std::min(Props.FirstMipInTail, TexDesc.MipLevels);
+    for (Uint32 Slice = 0; Slice < TexDesc.GetArraySize(); ++Slice)
+    {
+        for (Uint32 Mip = 0; Mip < NumTiledMips; ++Mip)
+        {
+            const auto MipWidth  = std::max(TexDesc.Width >> Mip, 1u);
+            const auto MipHeight = std::max(TexDesc.Height >> Mip, 1u);
+            for (Uint32 y = 0; y < MipHeight; y += Props.TileSize[1])
+            {
+                for (Uint32 x = 0; x < MipWidth; x += Props.TileSize[0])
+                {
+                    SparseTextureMemoryBindRange Range;
+                    Range.MipLevel     = Mip;
+                    Range.ArraySlice   = Slice;
+                    Range.Region       = Box{x, std::min(x + Props.TileSize[0], MipWidth), y, std::min(y + Props.TileSize[1], MipHeight)};
+                    Range.MemoryOffset = Block++;
+                    Range.MemorySize   = Props.BlockSize;
+                    Handler(Range);
+                }
+            }
+        }
+    }
+
+    if (Props.FirstMipInTail >= TexDesc.MipLevels)
+        return;
+
+    const Uint32 NumMipTails = (Props.Flags & SPARSE_TEXTURE_FLAG_SINGLE_MIPTAIL) != 0 ? 1 : TexDesc.GetArraySize();
+    for (Uint32 Slice = 0; Slice < NumMipTails; ++Slice)
+    {
+        for (Uint64 OffsetInMipTail = 0; OffsetInMipTail < Props.MipTailSize; OffsetInMipTail += Props.BlockSize)
+        {
+            SparseTextureMemoryBindRange Range;
+            Range.MipLevel        = Props.FirstMipInTail;
+            Range.ArraySlice      = Slice;
+            Range.OffsetInMipTail = OffsetInMipTail;
+            Range.MemoryOffset    = Block++;
+            Range.MemorySize      = Props.BlockSize;
+            Handler(Range);
+        }
+    }
+}
+
+TextureDesc GetRegularTextureDesc(const TextureDesc& Desc)
+{
+    TextureDesc RegularDesc{Desc};
+    RegularDesc.Usage = USAGE_DEFAULT;
+    RegularDesc.MiscFlags &= ~MISC_TEXTURE_FLAG_SPARSE_ALIASING;
+    return RegularDesc;
+}
+
+} // namespace
+
+TransientResourceAllocator::TransientResourceAllocator(const CreateInfo& CI) :
+    // clang-format off
+    m_pDevice             {ValidateDevice(CI.pDevice)},
+    m_MaxUnusedFrames     {CI.MaxUnusedFrames},
+    m_ImmediateContextMask{CI.ImmediateContextMask},
+    m_AliasingEnabled     {IsAliasingSupported(m_pDevice, CI.DisableAliasing)},
+    m_BlockSize           {m_AliasingEnabled ? m_pDevice->GetAdapterInfo().SparseResources.StandardBlockSize : 0},
+    m_MemoryPageSize      {m_AliasingEnabled ? AlignUp(std::max(CI.MemoryPageSize, m_BlockSize), m_BlockSize) : 0}
+// clang-format on
+{
+    // Direct3D11 has a single immediate context that executes all commands in order
+    if (m_AliasingEnabled && m_pDevice->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_D3D11)
+    {
+        FenceDesc Desc;
+        Desc.Name = "Transient resource allocator fence";
+        Desc.Type = FENCE_TYPE_GENERAL;
+        m_pDevice->CreateFence(Desc, &m_pFence);
+        if (!m_pFence)
+            LOG_ERROR_AND_THROW("Failed to create transient resource allocator fence");
+    }
+}
+
+TransientResourceAllocator::~TransientResourceAllocator()
+{
+}
+
+Uint64 TransientResourceAllocator::GetMemoryCapacity() const
+{
+    return m_pMemory ? m_pMemory->GetCapacity() : 0;
+}
+
+void TransientResourceAllocator::BeginFrame()
+{
+    ++m_FrameIndex;
+    m_Requests.clear();
+    m_FrameUpdated        = false;
+    m_FrameMemorySize     = 0;
+    m_RequestedMemorySize = 0;
+
+    // Release the textures that have not been requested for a while.
+    // Texture indices only need to be stable within a frame.
+    m_Textures.erase(std::remove_if(m_Textures.begin(), m_Textures.end(),
+                                    [this](const PooledTexture& Tex) {
+                                        return Tex.LastUsedFrame + m_MaxUnusedFrames < m_FrameIndex;
+                                    }),
+                     m_Textures.end());
+}
+
+bool TransientResourceAllocator::CanAlias(const TextureDesc& Desc) const
+{
+    if (!m_AliasingEnabled)
+        return false;
+
+    const auto& SparseRes = m_pDevice->GetAdapterInfo().SparseResources;
+    if (Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY)
+    {
+        if ((SparseRes.CapFlags & SPARSE_RESOURCE_CAP_FLAG_TEXTURE_2D_ARRAY_MIP_TAIL) == 0)
+            return false;
+    }
+    else if (Desc.Type != RESOURCE_DIM_TEX_2D)
+    {
+        return false;
+    }
+
+    if (Desc.SampleCount > 1)
+    {
+        const auto SampleCap = static_cast<SPARSE_RESOURCE_CAP_FLAGS>(
+            Desc.SampleCount == 2 ? SPARSE_RESOURCE_CAP_FLAG_TEXTURE_2_SAMPLES :
+                                    Desc.SampleCount == 4 ? SPARSE_RESOURCE_CAP_FLAG_TEXTURE_4_SAMPLES :
+                                                            Desc.SampleCount == 8 ? SPARSE_RESOURCE_CAP_FLAG_TEXTURE_8_SAMPLES :
+                                                                                    Desc.SampleCount == 16 ? SPARSE_RESOURCE_CAP_FLAG_TEXTURE_16_SAMPLES :
+                                                                                                             SPARSE_RESOURCE_CAP_FLAG_NONE);
+        if (SampleCap == SPARSE_RESOURCE_CAP_FLAG_NONE || (SparseRes.CapFlags & SampleCap) == 0)
+            return false;
+    }
+
+    const auto FmtInfo = m_pDevice->GetSparseTextureFormatInfo(Desc.Format, Desc.Type, Desc.SampleCount);
+    return (FmtInfo.BindFlags & Desc.BindFlags) == Desc.BindFlags;
+}
+
+bool TransientResourceAllocator::InitAliasedTexture(PooledTexture& Tex)
+{
+    const auto& Props = Tex.pTexture->GetSparseProperties();
+    if (Props.BlockSize != m_BlockSize)
+        return false;
+
+    if (!m_pMemory)
+    {
+        IDeviceObject* pCompatibleResource = Tex.pTexture;
+
+        DeviceMemoryCreateInfo MemCI;
+        MemCI.Desc.Name                 = "Transient resource allocator memory";
+        MemCI.Desc.Type                 = DEVICE_MEMORY_TYPE_SPARSE;
+        MemCI.Desc.PageSize             = m_MemoryPageSize;
+        MemCI.Desc.ImmediateContextMask = m_ImmediateContextMask;
+        MemCI.InitialSize               = m_MemoryPageSize;
+        MemCI.ppCompatibleResources     = &pCompatibleResource;
+        MemCI.NumResources              = 1;
+        m_pDevice->CreateDeviceMemory(MemCI, &m_pMemory);
+        if (!m_pMemory)
+        {
+            LOG_ERROR_MESSAGE("Failed to create transient resource allocator memory");
+            return false;
+        }
+    }
+    else if (!m_pMemory->IsCompatible(Tex.pTexture))
+    {
+        return false;
+    }
+
+    Tex.NumBlocks = 0;
+    ProcessTextureBlocks(Tex.pTexture, [&Tex](const SparseTextureMemoryBindRange&) { ++Tex.NumBlocks; });
+
+    return Tex.NumBlocks > 0;
+}
+
+Uint32 TransientResourceAllocator::FindOrCreateTexture(const TextureDesc& Desc, bool Aliased)
+{
+    TextureDesc PoolDesc = GetRegularTextureDesc(Desc);
+    if (Aliased)
+    {
+        PoolDesc.Usage = USAGE_SPARSE;
+        PoolDesc.MiscFlags |= MISC_TEXTURE_FLAG_SPARSE_ALIASING;
+    }
+    PoolDesc.ImmediateContextMask = m_ImmediateContextMask;
+
+    // A pooled texture may only be used by one request per frame
+    for (size_t i = 0; i < m_Textures.size(); ++i)
+    {
+        const auto& Tex = m_Textures[i];
+        if (Tex.LastUsedFrame != m_FrameIndex && Tex.pTexture->GetDesc() == PoolDesc)
+            return static_cast<Uint32>(i);
+    }
+
+    PooledTexture Tex;
+    m_pDevice->CreateTexture(PoolDesc, nullptr, &Tex.pTexture);
+    if (!Tex.pTexture)
+        return InvalidRequestId;
+
+    if (Aliased && !InitAliasedTexture(Tex))
+        return InvalidRequestId;
+
+    m_Textures.emplace_back(std::move(Tex));
+    return static_cast<Uint32>(m_Textures.size() - 1);
+}
+
+Uint32 TransientResourceAllocator::RequestTexture(const TextureDesc& Desc, Uint32 FirstPass, Uint32 LastPass)
+{
+    DEV_CHECK_ERR(!m_FrameUpdated, "Textures must be requested before Update() is called");
+    DEV_CHECK_ERR(Desc.Usage == USAGE_DEFAULT, "Transient texture '", Desc.Name, "' must use USAGE_DEFAULT");
+    DEV_CHECK_ERR(FirstPass <= LastPass, "The first pass (", FirstPass, ") must not be greater than the last pass (", LastPass, ")");
+
+    Uint32 TexIdx = CanAlias(Desc) ? FindOrCreateTexture(Desc, true) : InvalidRequestId;
+    if (TexIdx == InvalidRequestId)
+        TexIdx = FindOrCreateTexture(Desc, false);
+    if (TexIdx == InvalidRequestId)
+    {
+        LOG_ERROR_MESSAGE("Failed to create transient texture '", Desc.Name, "'");
+        return InvalidRequestId;
+    }
+
+    m_Textures[TexIdx].LastUsedFrame = m_FrameIndex;
+
+    Request Req;
+    Req.FirstPass  = FirstPass;
+    Req.LastPass   = LastPass;
+    Req.TextureIdx = TexIdx;
+    m_Requests.push_back(Req);
+
+    return static_cast<Uint32>(m_Requests.size() - 1);
+}
+
+ITexture* TransientResourceAllocator::GetTexture(Uint32 RequestId) const
+{
+    if (RequestId >= m_Requests.size())
+    {
+        DEV_ERROR("Request ", RequestId, " is out of range");
+        return nullptr;
+    }
+    return m_Textures[m_Requests[RequestId].TextureIdx].pTexture.RawPtr<ITexture>();
+}
+
+void TransientResourceAllocator::PlaceAliasedTextures()
+{
+    std::vector<Request*> Aliased;
+    for (auto& Req : m_Requests)
+    {
+        const auto NumBlocks = m_Textures[Req.TextureIdx].NumBlocks;
+        if (NumBlocks > 0)
+        {
+            Aliased.push_back(&Req);
+            m_RequestedMemorySize += NumBlocks * m_BlockSize;
+        }
+    }
+
+    // Place the largest textures first. The order is deterministic, so that the same set of
+    // requests results in the same placement and the memory is not rebound every frame.
+    std::stable_sort(Aliased.begin(), Aliased.end(),
+                     [this](const Request* pLHS, const Request* pRHS) {
+                         return m_Textures[pLHS->TextureIdx].NumBlocks > m_Textures[pRHS->TextureIdx].NumBlocks;
+                     });
+
+    std::vector<const Request*> Conflicts;
+    std::vector<Uint64>         Candidates;
+    for (size_t i = 0; i < Aliased.size(); ++i)
+    {
+        auto&      Req       = *Aliased[i];
+        const auto NumBlocks = m_Textures[Req.TextureIdx].NumBlocks;
+
+        // Textures placed so far whose lifetime overlaps with the lifetime of this texture
+        Conflicts.clear();
+        Candidates.assign(1, 0);
+        for (size_t j = 0; j < i; ++j)
+        {
+            const auto& Placed = *Aliased[j];
+            if (Placed.FirstPass <= Req.LastPass && Req.FirstPass <= Placed.LastPass)
+            {
+                Conflicts.push_back(&Placed);
+                Candidates.push_back(Placed.Offset + m_Textures[Placed.TextureIdx].NumBlocks);
+            }
+        }
+        std::sort(Candidates.begin(), Candidates.end());
+
+        // Take the lowest offset that does not intersect the memory of the conflicting textures
+        for (auto Offset : Candidates)
+        {
+            const auto IntersectsConflict = std::any_of(Conflicts.begin(), Conflicts.end(),
+                                                        [&](const Request* pPlaced) {
+                                                            return Offset < pPlaced->Offset + m_Textures[pPlaced->TextureIdx].NumBlocks &&
+                                                                pPlaced->Offset < Offset + NumBlocks;
+                                                        });
+            if (!IntersectsConflict)
+            {
+                Req.Offset = Offset;
+                break;
+            }
+        }
+        VERIFY(Req.Offset != InvalidOffset, "The end of the last conflicting texture is always a valid offset");
+        m_FrameMemorySize = std::max(m_FrameMemorySize, (Req.Offset + NumBlocks) * m_BlockSize);
+    }
+
+    if (m_FrameMemorySize > m_pMemory->GetCapacity())
+    {
+        // Some implementations do not support resizing and return true without changing the capacity
+        m_pMemory->Resize(AlignUp(m_FrameMemorySize, m_MemoryPageSize));
+    }
+
+    const auto NumMemoryBlocks = m_pMemory->GetCapacity() / m_BlockSize;
+    if (m_FrameMemorySize > NumMemoryBlocks * m_BlockSize)
+    {
+        LOG_WARNING_MESSAGE("Transient resource allocator memory could not grow to ", m_FrameMemorySize,
+                            " bytes. Textures that do not fit will not be aliased.");
+
+        m_FrameMemorySize = 0;
+        for (auto* pReq : Aliased)
+        {
+            const auto NumBlocks = m_Textures[pReq->TextureIdx].NumBlocks;
+            if (pReq->Offset + NumBlocks <= NumMemoryBlocks)
+            {
+                m_FrameMemorySize = std::max(m_FrameMemorySize, (pReq->Offset + NumBlocks) * m_BlockSize);
+                continue;
+            }
+
+            // The texture is no longer used by this frame
+            m_Textures[pReq->TextureIdx].LastUsedFrame = m_FrameIndex - 1;
+
+            const auto TexIdx = FindOrCreateTexture(m_Textures[pReq->TextureIdx].pTexture->GetDesc(), false);
+            if (TexIdx != InvalidRequestId)
+            {
+                m_Textures[TexIdx].LastUsedFrame = m_FrameIndex;
+                pReq->TextureIdx                 = TexIdx;
+            }
+            else
+            {
+                LOG_ERROR_MESSAGE("Failed to create fallback transient texture '", m_Textures[pReq->TextureIdx].pTexture->GetDesc().Name, "'");
+            }
+            pReq->Offset = InvalidOffset;
+        }
+    }
+}
+
+Uint64 TransientResourceAllocator::Update(const UpdateAttribs& Attribs)
+{
+    DEV_CHECK_ERR(!m_FrameUpdated, "Update() must be called once per frame");
+    m_FrameUpdated = true;
+
+    if (!m_pMemory)
+        return 0;
+
+    PlaceAliasedTextures();
+
+    // Collect the ranges of all textures whose memory offset has changed
+    std::vector<SparseTextureMemoryBindRange> Ranges;
+    std::vector<std::pair<ITexture*, size_t>> TexRanges;
+    for (const auto& Req : m_Requests)
+    {
+        auto& Tex = m_Textures[Req.TextureIdx];
+        if (Req.Offset == InvalidOffset || Req.Offset == Tex.BoundOffset)
+            continue;
+
+        TexRanges.emplace_back(Tex.pTexture.RawPtr<ITexture>(), Ranges.size());
+        ProcessTextureBlocks(Tex.pTexture,
+                             [&](SparseTextureMemoryBindRange Range) {
+                                 Range.MemoryOffset = (Req.Offset + Range.MemoryOffset) * m_BlockSize;
+                                 Range.pMemory      = m_pMemory;
+                                 Ranges.push_back(Range);
+                             });
+        Tex.BoundOffset = Req.Offset;
+    }
+
+    if (Ranges.empty())
+        return 0;
+
+    DEV_CHECK_ERR(Attribs.pSparseBindingContext != nullptr, "Sparse binding context must not be null");
+    DEV_CHECK_ERR((Attribs.pSparseBindingContext->GetDesc().QueueType & COMMAND_QUEUE_TYPE_SPARSE_BINDING) == COMMAND_QUEUE_TYPE_SPARSE_BINDING,
+                  "Context '", Attribs.pSparseBindingContext->GetDesc().Name, "' does not support sparse binding");
+
+    std::vector<SparseTextureMemoryBindInfo> TexBinds(TexRanges.size());
+    for (size_t i = 0; i < TexRanges.size(); ++i)
+    {
+        const auto FirstRange = TexRanges[i].second;
+        const auto EndRange   = i + 1 < TexRanges.size() ? TexRanges[i + 1].second : Ranges.size();
+
+        TexBinds[i].pTexture  = TexRanges[i].first;
+        TexBinds[i].pRanges   = &Ranges[FirstRange];
+        TexBinds[i].NumRanges = static_cast<Uint32>(EndRange - FirstRange);
+    }
+
+    BindSparseResourceMemoryAttribs BindAttribs;
+    BindAttribs.pTextureBinds   = TexBinds.data();
+    BindAttribs.NumTextureBinds = static_cast<Uint32>(TexBinds.size());
+
+    IFence* pWaitFence = Attribs.pWaitFence;
+    if (pWaitFence != nullptr)
+    {
+        BindAttribs.ppWaitFences     = &pWaitFence;
+        BindAttribs.pWaitFenceValues = &Attribs.WaitFenceValue;
+        BindAttribs.NumWaitFences    = 1;
+    }
+
+    IFence*      pSignalFence = m_pFence;
+    const Uint64 FenceValue   = m_pFence ? m_NextFenceValue++ : 0;
+    if (pSignalFence != nullptr)
+    {
+        BindAttribs.ppSignalFences     = &pSignalFence;
+        BindAttribs.pSignalFenceValues = &FenceValue;
+        BindAttribs.NumSignalFences    = 1;
+    }
+
+    Attribs.pSparseBindingContext->BindSparseResourceMemory(BindAttribs);
+
+    return FenceValue;
+}
+
+void TransientResourceAllocator::BeginPass(IDeviceContext* pContext, Uint32 Pass)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Context must not be null");
+    DEV_CHECK_ERR(m_FrameUpdated, "Update() must be called before the first pass");
+
+    std::vector<StateTransitionDesc> Barriers;
+    for (const auto& Req : m_Requests)
+    {
+        if (Req.FirstPass != Pass || Req.Offset == InvalidOffset)
+            continue;
+
+        const auto NumBlocks = m_Textures[Req.TextureIdx].NumBlocks;
+
+        // The texture that last used the same memory in this frame. If there is none, the memory
+        // may have been used by any texture in the previous frames.
+        const Request* pBefore = nullptr;
+        for (const auto& Other : m_Requests)
+        {
+            if (&Other == &Req || Other.Offset == InvalidOffset || Other.LastPass >= Pass)
+                continue;
+
+            const auto OtherNumBlocks = m_Textures[Other.TextureIdx].NumBlocks;
+            if (Other.Offset < Req.Offset + NumBlocks && Req.Offset < Other.Offset + OtherNumBlocks &&
+                (pBefore == nullptr || Other.LastPass > pBefore->LastPass))
+                pBefore = &Other;
+        }
+
+        Barriers.emplace_back(pBefore != nullptr ? m_Textures[pBefore->TextureIdx].pTexture.RawPtr<ITexture>() : nullptr,
+                              m_Textures[Req.TextureIdx].pTexture.RawPtr<ITexture>());
+    }
+
+    if (!Barriers.empty())
+        pContext->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
+}
+
+} // namespace Diligent
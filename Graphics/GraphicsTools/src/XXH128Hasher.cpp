@@ -26,11 +26,14 @@
 
 #include "XXH128Hasher.hpp"
 
+#include <algorithm>
+
 #include "xxhash.h"
 
 #include "DebugUtilities.hpp"
 #include "Cast.hpp"
 #include "ShaderToolsCommon.hpp"
+#include "ShaderSourceFileCache.hpp"
 
 namespace Diligent
 {
@@ -42,6 +45,12 @@ XXH128State::XXH128State() :
     XXH3_128bits_reset(m_State);
 }
 
+XXH128State::XXH128State(XXH128DigestCache* pDigestCache) :
+    XXH128State{}
+{
+    m_pDigestCache = pDigestCache;
+}
+
 XXH128State::~XXH128State()
 {
     XXH3_freeState(m_State);
@@ -78,8 +87,17 @@ void XXH128State::Update(const ShaderCreateInfo& ShaderCI) noexcept
     if (ShaderCI.Source != nullptr || ShaderCI.FilePath != nullptr)
     {
         DEV_CHECK_ERR(ShaderCI.ByteCode == nullptr, "ShaderCI.ByteCode must be null when either Source or FilePath is specified");
-        ProcessShaderIncludes(ShaderCI, [this](const ShaderIncludePreprocessInfo& ProcessInfo) {
-            UpdateStr(ProcessInfo.Source, ProcessInfo.SourceLength);
+        // If the files are loaded through the file cache, use the hashes it has already computed
+        RefCntAutoPtr<ShaderSourceFileCache> pFileCache;
+        if (ShaderCI.pShaderSourceStreamFactory != nullptr)
+            pFileCache = RefCntAutoPtr<ShaderSourceFileCache>{ShaderCI.pShaderSourceStreamFactory, ShaderSourceFileCache::IID_InternalImpl};
+
+        ProcessShaderIncludes(ShaderCI, [&](const ShaderIncludePreprocessInfo& ProcessInfo) {
+            XXH128Hash FileHash;
+            if (pFileCache && !ProcessInfo.FilePath.empty() && pFileCache->GetFileHash(ProcessInfo.FilePath.c_str(), FileHash))
+                Update(FileHash.LowPart, FileHash.HighPart);
+            else
+                UpdateStr(ProcessInfo.Source, ProcessInfo.SourceLength);
         });
     }
     else if (ShaderCI.ByteCode != nullptr && ShaderCI.ByteCodeSize != 0)
@@ -96,4 +114,121 @@ void XXH128State::Update(const ShaderCreateInfo& ShaderCI) noexcept
     }
 }
 
+void XXH128State::UpdateObject(IShader* pShader) noexcept
+{
+    UpdateDigest(m_pDigestCache != nullptr ? m_pDigestCache->GetDigest(pShader) : XXH128DigestCache::ComputeDigest(pShader));
+}
+
+void XXH128State::UpdateObject(const IPipelineResourceSignature* pSignature) noexcept
+{
+    UpdateDigest(m_pDigestCache != nullptr ? m_pDigestCache->GetDigest(pSignature) : XXH128DigestCache::ComputeDigest(pSignature));
+}
+
+void XXH128State::UpdateObject(const IRenderPass* pRenderPass) noexcept
+{
+    UpdateDigest(m_pDigestCache != nullptr ? m_pDigestCache->GetDigest(pRenderPass) : XXH128DigestCache::ComputeDigest(pRenderPass));
+}
+
+
+XXH128Hash XXH128DigestCache::ComputeDigest(IShader* pShader)
+{
+    VERIFY_EXPR(pShader != nullptr);
+    XXH128State Hasher;
+    HashShaderBytecode(Hasher, pShader);
+    return Hasher.Digest();
+}
+
+XXH128Hash XXH128DigestCache::ComputeDigest(const IPipelineResourceSignature* pSignature)
+{
+    VERIFY_EXPR(pSignature != nullptr);
+    XXH128State Hasher;
+    Hasher.Update(pSignature->GetDesc());
+    return Hasher.Digest();
+}
+
+XXH128Hash XXH128DigestCache::ComputeDigest(const IRenderPass* pRenderPass)
+{
+    VERIFY_EXPR(pRenderPass != nullptr);
+    XXH128State Hasher;
+    Hasher.Update(pRenderPass->GetDesc());
+    return Hasher.Digest();
+}
+
+template <typename ObjectType>
+XXH128Hash XXH128DigestCache::GetDigestImpl(ObjectType* pObject)
+{
+    VERIFY_EXPR(pObject != nullptr);
+    const IObject* pKey = pObject;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto it = m_Entries.find(pKey);
+        // The caller holds a reference to the object, so if the weak pointer has expired,
+        // the entry belongs to a destroyed object that had the same address.
+        if (it != m_Entries.end() && it->second.wpObject.IsValid())
+            return it->second.Digest;
+    }
+
+    // Compute the digest without holding the lock
+    const XXH128Hash Digest = ComputeDigest(pObject);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    Entry& NewEntry   = m_Entries[pKey];
+    NewEntry.wpObject = RefCntWeakPtr<IObject>{const_cast<IObject*>(pKey)};
+    NewEntry.Digest   = Digest;
+
+    if (m_Entries.size() >= m_PurgeThreshold)
+    {
+        PurgeExpired();
+        m_PurgeThreshold = std::max(m_PurgeThreshold, m_Entries.size() * 2);
+    }
+
+    return Digest;
+}
+
+XXH128Hash XXH128DigestCache::GetDigest(IShader* pShader)
+{
+    return GetDigestImpl(pShader);
+}
+
+XXH128Hash XXH128DigestCache::GetDigest(const IPipelineResourceSignature* pSignature)
+{
+    return GetDigestImpl(pSignature);
+}
+
+XXH128Hash XXH128DigestCache::GetDigest(const IRenderPass* pRenderPass)
+{
+    return GetDigestImpl(pRenderPass);
+}
+
+void XXH128DigestCache::PurgeExpired()
+{
+    for (auto it = m_Entries.begin(); it != m_Entries.end();)
+    {
+        if (!it->second.wpObject.IsValid())
+            it = m_Entries.erase(it);
+        else
+            ++it;
+    }
+}
+
+void XXH128DigestCache::Invalidate(const IObject* pObject)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Entries.erase(pObject);
+}
+
+void XXH128DigestCache::Clear()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Entries.clear();
+}
+
+size_t XXH128DigestCache::GetSize() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_Entries.size();
+}
+
 } // namespace Diligent
@@ -577,7 +577,7 @@ private:
                                           const String&            OutStreamName,
                                           const char*              EntryPoint);
 
-        String BuildGLSLSource();
+        String BuildGLSLSource(bool IncludeDefintions);
 
         // Tokenized source code
         TokenListType m_Tokens;
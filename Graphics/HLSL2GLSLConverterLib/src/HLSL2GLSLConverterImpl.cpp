@@ -697,12 +697,16 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
     // Put all the includes into the set to avoid multiple inclusion
     std::unordered_set<String> ProcessedIncludes;
 
+    // The text before the last processed #include contains no more directives,
+    // so there is no need to scan it again.
+    size_t SearchStart = 0;
+
     try
     {
         do
         {
-            // Find the first #include statement
-            auto Pos             = GLSLSource.begin();
+            // Find the next #include statement
+            auto Pos             = GLSLSource.begin() + SearchStart;
             auto IncludeStartPos = GLSLSource.end();
             while (Pos != GLSLSource.end())
             {
@@ -772,6 +776,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
             // #   include "TestFile.fxh"
             // ^                         ^
             // IncludeStartPos           Pos
+            SearchStart = IncludeStartPos - GLSLSource.begin();
             GLSLSource.erase(IncludeStartPos, Pos);
 
             // Convert the name to lower case
@@ -794,7 +799,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
                 size_t NumSymbols  = pIncludeData->GetSize();
 
                 // Insert the text into source
-                GLSLSource.insert(IncludeStartPos - GLSLSource.begin(), IncludeText, NumSymbols);
+                GLSLSource.insert(SearchStart, IncludeText, NumSymbols);
             }
         } while (true);
     }
@@ -807,14 +812,18 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
 // The function converts source code into a token list
 void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
 {
+    // Reuse the same buffer for all identifiers to avoid allocating a string
+    // and a key copy for every keyword lookup.
+    String Identifier;
     m_Tokens = Parsing::Tokenize<TokenInfo, decltype(m_Tokens)>(
         Source.begin(), Source.end(), TokenInfo::Create,
         [&](const std::string::const_iterator& Start, const std::string::const_iterator& End) //
         {
-            auto KeywordIt = m_Converter.m_HLSLKeywords.find(HashMapStringKey{std::string{Start, End}});
+            Identifier.assign(Start, End);
+            auto KeywordIt = m_Converter.m_HLSLKeywords.find(Identifier.c_str());
             if (KeywordIt != m_Converter.m_HLSLKeywords.end())
             {
-                VERIFY(std::string(Start, End) == KeywordIt->second.Literal, "Inconsistent literal");
+                VERIFY(Identifier == KeywordIt->second.Literal, "Inconsistent literal");
                 return KeywordIt->second.Type;
             }
             return TokenType::Identifier;
@@ -1566,9 +1575,11 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration(TokenLi
 // Finds an HLSL object with the given name in object stack
 const HLSL2GLSLConverterImpl::HLSLObjectInfo* HLSL2GLSLConverterImpl::ConversionStream::FindHLSLObject(const String& Name)
 {
+    // Compute the hash once for all scopes
+    const HashMapStringKey Key{Name.c_str()};
     for (auto ScopeIt = m_Objects.rbegin(); ScopeIt != m_Objects.rend(); ++ScopeIt)
     {
-        auto It = ScopeIt->m.find(Name.c_str());
+        auto It = ScopeIt->m.find(Key);
         if (It != ScopeIt->m.end())
             return &It->second;
     }
@@ -4257,16 +4268,32 @@ void HLSL2GLSLConverterImpl::ConversionStream::RemoveSpecialShaderAttributes()
     );
 }
 
-String HLSL2GLSLConverterImpl::ConversionStream::BuildGLSLSource()
+String HLSL2GLSLConverterImpl::ConversionStream::BuildGLSLSource(bool IncludeDefintions)
 {
+    auto IsInterpolationQualifier = [](const TokenInfo& Token) {
+        return (Token.Type == TokenType::kw_linear ||
+                Token.Type == TokenType::kw_nointerpolation ||
+                Token.Type == TokenType::kw_noperspective ||
+                Token.Type == TokenType::kw_centroid ||
+                Token.Type == TokenType::kw_sample);
+    };
+
+    // Compute the output size first so that the string is allocated only once
+    size_t OutputSize = IncludeDefintions ? strlen(g_GLSLDefinitions) : 0;
+    for (const auto& Token : m_Tokens)
+    {
+        if (!IsInterpolationQualifier(Token))
+            OutputSize += Token.GetDelimiterLen() + Token.GetLiteralLen();
+    }
+
     String Output;
+    Output.reserve(OutputSize);
+    if (IncludeDefintions)
+        Output.append(g_GLSLDefinitions);
+
     for (const auto& Token : m_Tokens)
     {
-        if ((Token.Type == TokenType::kw_linear ||
-             Token.Type == TokenType::kw_nointerpolation ||
-             Token.Type == TokenType::kw_noperspective ||
-             Token.Type == TokenType::kw_centroid ||
-             Token.Type == TokenType::kw_sample))
+        if (IsInterpolationQualifier(Token))
         {
             // Skip interpolation qualifiers.
             // We may get here if there are multiple shader functions in the same file.
@@ -4276,6 +4303,8 @@ String HLSL2GLSLConverterImpl::ConversionStream::BuildGLSLSource()
         Output.append(Token.Delimiter);
         Output.append(Token.Literal);
     }
+    VERIFY_EXPR(Output.length() == OutputSize);
+
     return Output;
 }
 
@@ -4633,7 +4662,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
 
     RemoveSpecialShaderAttributes();
 
-    auto GLSLSource = BuildGLSLSource();
+    auto GLSLSource = BuildGLSLSource(IncludeDefintions);
 
     if (m_bPreserveTokens)
     {
@@ -4642,9 +4671,6 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
         m_Objects.clear();
     }
 
-    if (IncludeDefintions)
-        GLSLSource.insert(0, g_GLSLDefinitions);
-
     return GLSLSource;
 }
 
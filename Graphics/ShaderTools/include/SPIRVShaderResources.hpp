@@ -111,6 +111,16 @@ struct SPIRVShaderResourceAttribs
                                Uint32                                _BufferStaticSize = 0,
                                Uint32                                _BufferStride     = 0) noexcept;
 
+    SPIRVShaderResourceAttribs(const char*        _Name,
+                               Uint16             _ArraySize,
+                               ResourceType       _Type,
+                               RESOURCE_DIMENSION _ResourceDim,
+                               bool               _IsMS,
+                               uint32_t           _BindingDecorationOffset,
+                               uint32_t           _DescriptorSetDecorationOffset,
+                               Uint32             _BufferStaticSize,
+                               Uint32             _BufferStride) noexcept;
+
     ShaderResourceDesc GetResourceDesc() const
     {
         return ShaderResourceDesc{Name, GetShaderResourceType(Type), ArraySize};
@@ -147,13 +157,16 @@ static_assert(sizeof(SPIRVShaderStageInputAttribs) % sizeof(void*) == 0, "Size o
 class SPIRVShaderResources
 {
 public:
+    // If ForceSPIRVCross is true, resources are always loaded through SPIRV-Cross reflection
+    // instead of the lightweight binary scanner. This is primarily intended for testing.
     SPIRVShaderResources(IMemoryAllocator&     Allocator,
                          std::vector<uint32_t> spirv_binary,
                          const ShaderDesc&     shaderDesc,
                          const char*           CombinedSamplerSuffix,
                          bool                  LoadShaderStageInputs,
                          bool                  LoadUniformBufferReflection,
-                         std::string&          EntryPoint);
+                         std::string&          EntryPoint,
+                         bool                  ForceSPIRVCross = false);
 
     // clang-format off
     SPIRVShaderResources             (const SPIRVShaderResources&)  = delete;
@@ -334,7 +347,19 @@ public:
 
     bool IsHLSLSource() const { return m_IsHLSLSource; }
 
+    // Returns true if the resources were loaded by the binary scanner rather than SPIRV-Cross
+    bool IsLoadedFromBinary() const { return m_IsLoadedFromBinary; }
+
 private:
+    // Loads resources by directly scanning the SPIRV binary without SPIRV-Cross.
+    // Returns false if the binary uses features that the scanner does not handle.
+    bool LoadFromBinary(IMemoryAllocator&            Allocator,
+                        const std::vector<uint32_t>& spirv_binary,
+                        const ShaderDesc&            shaderDesc,
+                        const char*                  CombinedSamplerSuffix,
+                        bool                         LoadShaderStageInputs,
+                        std::string&                 EntryPoint);
+
     void Initialize(IMemoryAllocator&       Allocator,
                     const ResourceCounters& Counters,
                     Uint32                  NumShaderStageInputs,
@@ -401,6 +426,9 @@ private:
 
     // Indicates if the shader was compiled from HLSL source.
     bool m_IsHLSLSource = false;
+
+    // Indicates if the resources were loaded by the binary scanner.
+    bool m_IsLoadedFromBinary = false;
 };
 
 } // namespace Diligent
@@ -40,13 +40,48 @@ enum SPIRV_OPTIMIZATION_FLAGS : Uint32
     SPIRV_OPTIMIZATION_FLAG_NONE             = 0u,
     SPIRV_OPTIMIZATION_FLAG_LEGALIZATION     = 1u << 0u,
     SPIRV_OPTIMIZATION_FLAG_PERFORMANCE      = 1u << 1u,
-    SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION = 1u << 2u
+    SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION = 1u << 2u,
+
+    /// Size-oriented optimization passes. Should not be combined with SPIRV_OPTIMIZATION_FLAG_PERFORMANCE.
+    SPIRV_OPTIMIZATION_FLAG_SIZE = 1u << 3u,
+
+    /// Fully unroll loops that are marked with the Unroll loop control (e.g. [unroll] in HLSL).
+    /// Performance passes already include loop unrolling; this flag is intended to be
+    /// combined with other passes.
+    SPIRV_OPTIMIZATION_FLAG_UNROLL_LOOPS = 1u << 4u,
+
+    /// Remove resource variables that are not referenced by the shader.
+    /// Note that removed resources will not be reported by shader reflection.
+    SPIRV_OPTIMIZATION_FLAG_REMOVE_DEAD_BINDINGS = 1u << 5u,
+
+    /// Do not look up or store the result in the optimized SPIRV cache.
+    SPIRV_OPTIMIZATION_FLAG_NO_CACHE = 1u << 6u,
+
+    /// Size-oriented preset: size passes and dead binding elimination.
+    SPIRV_OPTIMIZATION_PRESET_SIZE = SPIRV_OPTIMIZATION_FLAG_SIZE | SPIRV_OPTIMIZATION_FLAG_REMOVE_DEAD_BINDINGS,
+
+    /// Performance-oriented preset: performance passes (including loop unrolling) and dead binding elimination.
+    SPIRV_OPTIMIZATION_PRESET_PERFORMANCE = SPIRV_OPTIMIZATION_FLAG_PERFORMANCE | SPIRV_OPTIMIZATION_FLAG_REMOVE_DEAD_BINDINGS
 };
 DEFINE_FLAG_ENUM_OPERATORS(SPIRV_OPTIMIZATION_FLAGS);
 
 
+/// Runs the optimization passes defined by Passes on SrcSPIRV.
+
+/// Each thread reuses its own optimizer instance for every combination of the target
+/// environment and passes. Unless SPIRV_OPTIMIZATION_FLAG_NO_CACHE is set, optimized
+/// modules are also kept in a process-wide cache, so that optimizing an identical module
+/// again (e.g. when several pipelines in an archive share a shader) returns the cached result.
+///
+/// \return     Optimized SPIRV, or an empty vector if the optimization failed.
 std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV,
                                     spv_target_env               TargetEnv,
                                     SPIRV_OPTIMIZATION_FLAGS     Passes);
 
+/// Sets the maximum total size, in bytes, of the source and optimized modules
+/// kept in the optimized SPIRV cache. Zero disables the cache.
+///
+/// \warning   This function must not be called simultaneously with OptimizeSPIRV().
+void SetSPIRVOptimizationCacheSize(size_t MaxSize);
+
 } // namespace Diligent
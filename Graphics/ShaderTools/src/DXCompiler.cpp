@@ -47,6 +47,7 @@
 #include "DataBlobImpl.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "ShaderToolsCommon.hpp"
+#include "StartupProfiler.hpp"
 
 #if D3D12_SUPPORTED
 #    include "WinHPreface.h"
@@ -125,12 +126,18 @@ public:
 private:
     DxcCreateInstanceProc Load()
     {
+        // Load() is called by every compile, remap and reflection request, so do not
+        // serialize concurrent compilation threads on the mutex once the library is loaded.
+        if (m_IsInitialized.load(std::memory_order_acquire))
+            return m_pCreateInstance;
+
         std::unique_lock<std::mutex> lock{m_Guard};
 
-        if (m_IsInitialized)
+        if (m_IsInitialized.load(std::memory_order_relaxed))
             return m_pCreateInstance;
 
-        m_IsInitialized   = true;
+        StartupProfiler::Scope ProfilerScope{"Load DX Shader Compiler", m_LibName.c_str()};
+
         m_pCreateInstance = DXCompilerBase::Load(m_Target, m_LibName);
 
         if (m_pCreateInstance)
@@ -150,6 +157,9 @@ private:
             LOG_INFO_MESSAGE("Loaded DX Shader Compiler ", m_MajorVer, ".", m_MinorVer, ". Max supported shader model: ", m_MaxShaderModel.Major, '.', m_MaxShaderModel.Minor);
         }
 
+        // All members must be initialized before the flag is set
+        m_IsInitialized.store(true, std::memory_order_release);
+
         return m_pCreateInstance;
     }
 
@@ -183,7 +193,7 @@ private:
 
 private:
     DxcCreateInstanceProc  m_pCreateInstance = nullptr;
-    bool                   m_IsInitialized   = false;
+    std::atomic<bool>      m_IsInitialized{false};
     ShaderVersion          m_MaxShaderModel;
     std::mutex             m_Guard;
     const String           m_LibName;
@@ -45,6 +45,8 @@
 #include "RefCntAutoPtr.hpp"
 #include "ShaderToolsCommon.hpp"
 #include "SPIRVTools.hpp"
+#include "GraphicsAccessories.hpp"
+#include "StartupProfiler.hpp"
 
 // clang-format off
 static constexpr char g_HLSLDefinitions[] =
@@ -61,6 +63,7 @@ namespace GLSLangUtils
 
 void InitializeGlslang()
 {
+    StartupProfiler::Scope ProfilerScope{"Initialize glslang"};
     ::glslang::InitializeProcess();
 }
 
@@ -224,6 +227,52 @@ TBuiltInResource InitResources()
     return Resources;
 }
 
+// Resource limits are the same for all shaders, so they are initialized once
+const TBuiltInResource& GetBuiltInResources()
+{
+    static const TBuiltInResource Resources = InitResources();
+    return Resources;
+}
+
+// Returns the part of the HLSL preamble that only depends on the shader type.
+// HLSLDefinitions.fxh is large, so the preamble is assembled once per shader type
+// instead of on every compilation.
+const std::string& GetHLSLPreamble(SHADER_TYPE ShaderType)
+{
+    static const auto Preambles = []() {
+        std::array<std::string, LastShaderInd + 1> Preambles;
+        for (Int32 i = 0; i <= LastShaderInd; ++i)
+        {
+            auto& Preamble = Preambles[i];
+            Preamble       = "#define GLSLANG\n\n";
+            Preamble.append(g_HLSLDefinitions);
+            AppendShaderTypeDefinitions(Preamble, GetShaderTypeFromIndex(i));
+        }
+        return Preambles;
+    }();
+    return Preambles[GetShaderTypeIndex(ShaderType)];
+}
+
+// glslang process state is reference-counted. Every thread that compiles shaders holds
+// a reference until it exits, so that compilation is safe on any thread even if the
+// client that called InitializeGlslang() finalizes glslang in the meantime.
+void EnsureGlslangThreadInitialized()
+{
+    struct ThreadGlslangScope
+    {
+        ThreadGlslangScope()
+        {
+            ::glslang::InitializeProcess();
+        }
+        ~ThreadGlslangScope()
+        {
+            ::glslang::FinalizeProcess();
+        }
+    };
+    static thread_local ThreadGlslangScope Scope;
+    (void)Scope;
+}
+
 void LogCompilerError(const char* DebugOutputMessage,
                       const char* InfoLog,
                       const char* InfoDebugLog,
@@ -260,7 +309,7 @@ std::vector<unsigned int> CompileShaderInternal(::glslang::TShader&           Sh
 {
     Shader.setAutoMapBindings(true);
     Shader.setAutoMapLocations(true);
-    TBuiltInResource Resources = InitResources();
+    const TBuiltInResource& Resources = GetBuiltInResources();
 
     auto ParseResult = pIncluder != nullptr ?
         Shader.parse(&Resources, 100, shProfile, false, false, messages, *pIncluder) :
@@ -410,6 +459,8 @@ std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
                                       const char*             ExtraDefinitions,
                                       IDataBlob**             ppCompilerOutput)
 {
+    EnsureGlslangThreadInitialized();
+
     EShLanguage        ShLang = ShaderTypeToShLanguage(ShaderCI.Desc.ShaderType);
     ::glslang::TShader Shader{ShLang};
     EShMessages        messages  = (EShMessages)(EShMsgSpvRules | EShMsgVulkanRules | EShMsgReadHlsl | EShMsgHlslLegalization);
@@ -431,9 +482,7 @@ std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
 
     const auto SourceData = ReadShaderSourceFile(ShaderCI);
 
-    std::string Defines{"#define GLSLANG\n\n"};
-    Defines.append(g_HLSLDefinitions);
-    AppendShaderTypeDefinitions(Defines, ShaderCI.Desc.ShaderType);
+    std::string Defines{GetHLSLPreamble(ShaderCI.Desc.ShaderType)};
 
     if (ExtraDefinitions != nullptr)
         Defines += ExtraDefinitions;
@@ -478,6 +527,8 @@ std::vector<unsigned int> GLSLtoSPIRV(const GLSLtoSPIRVAttribs& Attribs)
 {
     VERIFY_EXPR(Attribs.ShaderSource != nullptr && Attribs.SourceCodeLen > 0);
 
+    EnsureGlslangThreadInitialized();
+
     const EShLanguage  ShLang = ShaderTypeToShLanguage(Attribs.ShaderType);
     ::glslang::TShader Shader(ShLang);
     spv_target_env     spvTarget = SPV_ENV_VULKAN_1_0;
@@ -26,6 +26,9 @@
  */
 
 #include <iomanip>
+#include <algorithm>
+#include <limits>
+#include <cstring>
 #include "SPIRVShaderResources.hpp"
 #include "spirv_parser.hpp"
 #include "spirv_cross.hpp"
@@ -125,6 +128,28 @@ SPIRVShaderResourceAttribs::SPIRVShaderResourceAttribs(const diligent_spirv_cros
 // clang-format on
 {}
 
+SPIRVShaderResourceAttribs::SPIRVShaderResourceAttribs(const char*        _Name,
+                                                       Uint16             _ArraySize,
+                                                       ResourceType       _Type,
+                                                       RESOURCE_DIMENSION _ResourceDim,
+                                                       bool               _IsMS,
+                                                       uint32_t           _BindingDecorationOffset,
+                                                       uint32_t           _DescriptorSetDecorationOffset,
+                                                       Uint32             _BufferStaticSize,
+                                                       Uint32             _BufferStride) noexcept :
+    // clang-format off
+    Name                          {_Name},
+    ArraySize                     {_ArraySize},
+    Type                          {_Type},
+    ResourceDim                   {static_cast<Uint8>(_ResourceDim)},
+    IsMS                          {_IsMS ? Uint8{1} : Uint8{0}},
+    BindingDecorationOffset       {_BindingDecorationOffset},
+    DescriptorSetDecorationOffset {_DescriptorSetDecorationOffset},
+    BufferStaticSize              {_BufferStaticSize},
+    BufferStride                  {_BufferStride}
+// clang-format on
+{}
+
 
 SHADER_RESOURCE_TYPE SPIRVShaderResourceAttribs::GetShaderResourceType(ResourceType Type)
 {
@@ -360,15 +385,977 @@ ShaderCodeBufferDescX LoadUBReflection(const diligent_spirv_cross::Compiler& Com
 }
 
 
+namespace
+{
+
+// Lightweight SPIRV binary scanner that collects resource information used by SPIRVShaderResources
+// in a single pass over the module, without building the SPIRV-Cross IR.
+// The scanner only handles the common cases and produces exactly the same results as SPIRV-Cross
+// reflection. For anything else (decoration groups, specialization constant array sizes, names that
+// SPIRV-Cross may sanitize, etc.) Scan() returns false, and the caller falls back to SPIRV-Cross.
+class SPIRVBinaryScanner
+{
+public:
+    // Resource groups in the order they are stored by SPIRVShaderResources
+    enum RESOURCE_GROUP : Uint32
+    {
+        RESOURCE_GROUP_UB = 0,
+        RESOURCE_GROUP_SB,
+        RESOURCE_GROUP_IMG,
+        RESOURCE_GROUP_SMPLD_IMG,
+        RESOURCE_GROUP_AC,
+        RESOURCE_GROUP_SEP_SMPLR,
+        RESOURCE_GROUP_SEP_IMG,
+        RESOURCE_GROUP_INPT_ATT,
+        RESOURCE_GROUP_ACCEL_STRUCT,
+        RESOURCE_GROUP_COUNT
+    };
+
+    struct ResourceInfo
+    {
+        const char* Name = nullptr;
+
+        Uint16                                   ArraySize = 1;
+        SPIRVShaderResourceAttribs::ResourceType Type      = SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes;
+        RESOURCE_DIMENSION                       Dim       = RESOURCE_DIM_UNDEFINED;
+        bool                                     IsMS      = false;
+
+        uint32_t BindingDecorationOffset       = 0;
+        uint32_t DescriptorSetDecorationOffset = 0;
+
+        Uint32 BufferStaticSize = 0;
+        Uint32 BufferStride     = 0;
+    };
+
+    struct StageInputInfo
+    {
+        // Null if the input has no HlslSemanticGOOGLE decoration
+        const char* Semantic = nullptr;
+        // Zero if the input has no Location decoration
+        uint32_t LocationDecorationOffset = 0;
+    };
+
+    explicit SPIRVBinaryScanner(const std::vector<uint32_t>& SPIRV) noexcept :
+        m_SPIRV{SPIRV}
+    {}
+
+    bool Scan(spv::ExecutionModel ExecutionModel);
+
+    std::array<std::vector<ResourceInfo>, RESOURCE_GROUP_COUNT> Resources;
+    std::vector<StageInputInfo>                                 StageInputs;
+
+    const char*           EntryPoint         = nullptr;
+    bool                  IsHLSLSource       = false;
+    bool                  HlslFunctionality1 = false;
+    std::array<Uint32, 3> ComputeGroupSize   = {};
+
+private:
+    static constexpr Uint32 HeaderSize = 5;
+
+    struct IdInfo
+    {
+        // Offset of the instruction that defines the id, or 0 if the id is not a type, constant or variable
+        Uint32 InstrOffset = 0;
+
+        // Offsets of decoration literals in the binary, or 0 if the decoration is not present
+        Uint32 BindingOffset       = 0;
+        Uint32 DescriptorSetOffset = 0;
+        Uint32 LocationOffset      = 0;
+
+        Uint32 ArrayStride = 0;
+
+        const char* Name     = nullptr;
+        const char* Semantic = nullptr;
+
+        bool HasArrayStride = false;
+        bool Block          = false;
+        bool BufferBlock    = false;
+        bool NonWritable    = false;
+        bool BuiltIn        = false;
+    };
+
+    struct MemberDecoration
+    {
+        Uint32 StructId;
+        Uint32 Member;
+        Uint32 Decoration;
+        Uint32 Value;
+
+        bool operator<(const MemberDecoration& rhs) const
+        {
+            return StructId != rhs.StructId ? StructId < rhs.StructId : Member < rhs.Member;
+        }
+    };
+
+    struct EntryPointInfo
+    {
+        Uint32      Model;
+        Uint32      FunctionId;
+        const char* Name;
+        Uint32      InterfaceStart;
+        Uint32      InterfaceEnd;
+    };
+
+    struct ExecutionModeInfo
+    {
+        Uint32 EntryPointId;
+        Uint32 Mode;
+        Uint32 OperandsOffset;
+        Uint32 NumOperands;
+    };
+
+    struct ImageInfo
+    {
+        Uint32 Dim     = spv::Dim1D;
+        bool   Arrayed = false;
+        bool   MS      = false;
+        Uint32 Sampled = 0;
+    };
+
+    bool ParseInstructions(std::vector<Uint32>& Variables);
+
+    const char* GetString(Uint32 Offset, Uint32 End) const;
+
+    const uint32_t* GetInstruction(Uint32 Id) const
+    {
+        return Id < m_Ids.size() && m_Ids[Id].InstrOffset != 0 ? &m_SPIRV[m_Ids[Id].InstrOffset] : nullptr;
+    }
+
+    Uint32 GetOpcode(Uint32 Id) const
+    {
+        const auto* pInstr = GetInstruction(Id);
+        return pInstr != nullptr ? (pInstr[0] & spv::OpCodeMask) : Uint32{spv::OpNop};
+    }
+
+    Uint32 GetWordCount(Uint32 Id) const
+    {
+        const auto* pInstr = GetInstruction(Id);
+        return pInstr != nullptr ? (pInstr[0] >> spv::WordCountShift) : 0;
+    }
+
+    const MemberDecoration* FindMemberDecoration(Uint32 StructId, Uint32 Member, spv::Decoration Decoration) const;
+
+    bool GetConstantValue(Uint32 Id, Uint32& Value) const;
+    bool GetImageInfo(Uint32 TypeId, ImageInfo& Info) const;
+    bool IsBuiltInVariable(Uint32 VarId, Uint32 BaseTypeId) const;
+    bool IsInEntryPointInterface(Uint32 VarId) const;
+
+    bool GetStructSize(Uint32 StructId, Uint32& Size) const;
+    bool GetStructMemberSize(Uint32 StructId, Uint32 Member, Uint32& Size) const;
+    bool GetRuntimeArrayStride(Uint32 StructId, Uint32& Stride) const;
+
+    bool ProcessVariable(Uint32 VarOffset);
+
+private:
+    const std::vector<uint32_t>& m_SPIRV;
+
+    std::vector<IdInfo>            m_Ids;
+    std::vector<MemberDecoration>  m_MemberDecorations;
+    std::vector<EntryPointInfo>    m_EntryPoints;
+    std::vector<ExecutionModeInfo> m_ExecutionModes;
+
+    const EntryPointInfo* m_pEntryPoint    = nullptr;
+    Uint32                m_SPIRVVersion   = 0;
+    Uint32                m_SourceLanguage = spv::SourceLanguageUnknown;
+};
+
+// Returns true if SPIRV-Cross reports the name as is. Some SPIRV-Cross versions
+// replace or drop names that are not valid or are reserved identifiers.
+bool IsPlainIdentifier(const char* Name)
+{
+    if (Name[0] == '\0')
+        return true;
+    if (IsNum(Name[0]))
+        return false;
+    // _[0-9]+ identifiers are reserved for temporaries
+    if (Name[0] == '_' && IsNum(Name[1]))
+        return false;
+    if (strncmp(Name, "gl_", 3) == 0 || strncmp(Name, "spv", 3) == 0)
+        return false;
+
+    for (const char* c = Name; *c != '\0'; ++c)
+    {
+        if (!((*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z') || IsNum(*c) || *c == '_'))
+            return false;
+        // Two underscores in a row are not allowed either
+        if (c[0] == '_' && c[1] == '_')
+            return false;
+    }
+
+    return true;
+}
+
+const char* SPIRVBinaryScanner::GetString(Uint32 Offset, Uint32 End) const
+{
+    // Literal strings are nul-terminated and padded to the word boundary
+    const auto* Str    = reinterpret_cast<const char*>(&m_SPIRV[Offset]);
+    const auto  MaxLen = (End - Offset) * sizeof(uint32_t);
+    return Offset < End && memchr(Str, '\0', MaxLen) != nullptr ? Str : nullptr;
+}
+
+const SPIRVBinaryScanner::MemberDecoration* SPIRVBinaryScanner::FindMemberDecoration(Uint32 StructId, Uint32 Member, spv::Decoration Decoration) const
+{
+    const auto Range = std::equal_range(m_MemberDecorations.begin(), m_MemberDecorations.end(), MemberDecoration{StructId, Member, 0, 0});
+
+    // The last decoration takes precedence
+    const MemberDecoration* pDecoration = nullptr;
+    for (auto it = Range.first; it != Range.second; ++it)
+    {
+        if (it->Decoration == static_cast<Uint32>(Decoration))
+            pDecoration = &*it;
+    }
+    return pDecoration;
+}
+
+bool SPIRVBinaryScanner::GetConstantValue(Uint32 Id, Uint32& Value) const
+{
+    // Specialization constants are not supported
+    if (GetOpcode(Id) != spv::OpConstant || GetWordCount(Id) < 4)
+        return false;
+
+    const auto* pConst = GetInstruction(Id);
+    if (GetOpcode(pConst[1]) != spv::OpTypeInt)
+        return false;
+
+    Value = pConst[3];
+    return true;
+}
+
+bool SPIRVBinaryScanner::GetImageInfo(Uint32 TypeId, ImageInfo& Info) const
+{
+    if (GetOpcode(TypeId) == spv::OpTypeSampledImage)
+        TypeId = GetInstruction(TypeId)[2];
+
+    if (GetOpcode(TypeId) != spv::OpTypeImage || GetWordCount(TypeId) < 9)
+        return false;
+
+    const auto* pImage = GetInstruction(TypeId);
+
+    Info.Dim     = pImage[3];
+    Info.Arrayed = pImage[5] != 0;
+    Info.MS      = pImage[6] != 0;
+    Info.Sampled = pImage[7];
+    return true;
+}
+
+bool SPIRVBinaryScanner::IsBuiltInVariable(Uint32 VarId, Uint32 BaseTypeId) const
+{
+    if (m_Ids[VarId].BuiltIn)
+        return true;
+
+    // If one member of a struct is a built-in, the struct is a built-in as well
+    if (GetOpcode(BaseTypeId) == spv::OpTypeStruct)
+    {
+        const auto Range = std::equal_range(m_MemberDecorations.begin(), m_MemberDecorations.end(), MemberDecoration{BaseTypeId, 0, 0, 0},
+                                            [](const MemberDecoration& lhs, const MemberDecoration& rhs) { return lhs.StructId < rhs.StructId; });
+        for (auto it = Range.first; it != Range.second; ++it)
+        {
+            if (it->Decoration == spv::DecorationBuiltIn)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+bool SPIRVBinaryScanner::IsInEntryPointInterface(Uint32 VarId) const
+{
+    // Older modules with a single entry point are assumed to use every interface variable
+    if (m_SPIRVVersion < 0x10400 && m_EntryPoints.size() <= 1)
+        return true;
+
+    for (Uint32 i = m_pEntryPoint->InterfaceStart; i < m_pEntryPoint->InterfaceEnd; ++i)
+    {
+        if (m_SPIRV[i] == VarId)
+            return true;
+    }
+    return false;
+}
+
+bool SPIRVBinaryScanner::GetStructMemberSize(Uint32 StructId, Uint32 Member, Uint32& Size) const
+{
+    const auto MemberTypeId = GetInstruction(StructId)[2 + Member];
+
+    // Check that the innermost element type has a defined size
+    auto ElementTypeId = MemberTypeId;
+    while (GetOpcode(ElementTypeId) == spv::OpTypeArray || GetOpcode(ElementTypeId) == spv::OpTypeRuntimeArray)
+        ElementTypeId = GetInstruction(ElementTypeId)[2];
+    switch (GetOpcode(ElementTypeId))
+    {
+        case spv::OpTypeInt:
+        case spv::OpTypeFloat:
+        case spv::OpTypeVector:
+        case spv::OpTypeMatrix:
+        case spv::OpTypeStruct:
+            break;
+
+        default:
+            // Booleans, pointers and opaque types
+            return false;
+    }
+
+    const auto* pType = GetInstruction(MemberTypeId);
+    switch (GetOpcode(MemberTypeId))
+    {
+        case spv::OpTypeArray:
+        case spv::OpTypeRuntimeArray:
+        {
+            if (!m_Ids[MemberTypeId].HasArrayStride)
+                return false;
+
+            Uint32 Length = 0;
+            if (GetOpcode(MemberTypeId) == spv::OpTypeArray && !GetConstantValue(pType[3], Length))
+                return false;
+
+            Size = m_Ids[MemberTypeId].ArrayStride * Length;
+            return true;
+        }
+
+        case spv::OpTypeStruct:
+            return GetStructSize(MemberTypeId, Size);
+
+        case spv::OpTypeInt:
+        case spv::OpTypeFloat:
+            Size = pType[2] / 8;
+            return true;
+
+        case spv::OpTypeVector:
+            Size = GetInstruction(pType[2])[2] / 8 * pType[3];
+            return true;
+
+        case spv::OpTypeMatrix:
+        {
+            const auto* pMatrixStride = FindMemberDecoration(StructId, Member, spv::DecorationMatrixStride);
+            if (pMatrixStride == nullptr)
+                return false;
+
+            const auto NumColumns = pType[3];
+            const auto VecSize    = GetInstruction(pType[2])[3];
+            if (FindMemberDecoration(StructId, Member, spv::DecorationRowMajor) != nullptr)
+                Size = pMatrixStride->Value * VecSize;
+            else if (FindMemberDecoration(StructId, Member, spv::DecorationColMajor) != nullptr)
+                Size = pMatrixStride->Value * NumColumns;
+            else
+                return false;
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+bool SPIRVBinaryScanner::GetStructSize(Uint32 StructId, Uint32& Size) const
+{
+    if (GetOpcode(StructId) != spv::OpTypeStruct)
+        return false;
+
+    const auto NumMembers = GetWordCount(StructId) - 2;
+    if (NumMembers == 0)
+        return false;
+
+    // Offsets can be declared out of order, so the size is determined by the member with the highest offset
+    Uint32 HighestOffset = 0;
+    Uint32 LastMember    = 0;
+    for (Uint32 i = 0; i < NumMembers; ++i)
+    {
+        const auto* pOffset = FindMemberDecoration(StructId, i, spv::DecorationOffset);
+        if (pOffset == nullptr)
+            return false;
+        if (pOffset->Value > HighestOffset)
+        {
+            HighestOffset = pOffset->Value;
+            LastMember    = i;
+        }
+    }
+
+    Uint32 MemberSize = 0;
+    if (!GetStructMemberSize(StructId, LastMember, MemberSize))
+        return false;
+
+    Size = HighestOffset + MemberSize;
+    return true;
+}
+
+bool SPIRVBinaryScanner::GetRuntimeArrayStride(Uint32 StructId, Uint32& Stride) const
+{
+    Stride = 0;
+
+    const auto NumMembers = GetWordCount(StructId) - 2;
+    VERIFY_EXPR(NumMembers > 0);
+    const auto LastMemberTypeId = GetInstruction(StructId)[2 + NumMembers - 1];
+
+    // Only a runtime array in the innermost dimension of the last member defines the stride
+    Uint32 InnermostArrayOp = spv::OpNop;
+    for (auto TypeId = LastMemberTypeId; GetOpcode(TypeId) == spv::OpTypeArray || GetOpcode(TypeId) == spv::OpTypeRuntimeArray;)
+    {
+        InnermostArrayOp = GetOpcode(TypeId);
+        TypeId           = GetInstruction(TypeId)[2];
+    }
+    if (InnermostArrayOp != spv::OpTypeRuntimeArray)
+        return true;
+
+    if (!m_Ids[LastMemberTypeId].HasArrayStride)
+        return false;
+
+    Stride = m_Ids[LastMemberTypeId].ArrayStride;
+    return true;
+}
+
+bool SPIRVBinaryScanner::ParseInstructions(std::vector<Uint32>& Variables)
+{
+    for (Uint32 Offset = HeaderSize; Offset < m_SPIRV.size();)
+    {
+        const auto Opcode    = m_SPIRV[Offset] & spv::OpCodeMask;
+        const auto WordCount = m_SPIRV[Offset] >> spv::WordCountShift;
+        if (WordCount == 0 || Offset + WordCount > m_SPIRV.size())
+            return false;
+
+        const auto  End    = Offset + WordCount;
+        const auto* pOps   = &m_SPIRV[Offset + 1];
+        const auto  NumOps = WordCount - 1;
+
+        auto GetId = [this](Uint32 Id) -> IdInfo* {
+            return Id < m_Ids.size() ? &m_Ids[Id] : nullptr;
+        };
+
+        switch (Opcode)
+        {
+            case spv::OpSource:
+                if (NumOps < 1)
+                    return false;
+                m_SourceLanguage = pOps[0];
+                break;
+
+            case spv::OpName:
+            {
+                auto* pId = NumOps >= 2 ? GetId(pOps[0]) : nullptr;
+                if (pId == nullptr || (pId->Name = GetString(Offset + 2, End)) == nullptr)
+                    return false;
+                break;
+            }
+
+            case spv::OpExtension:
+            {
+                const auto* Ext = GetString(Offset + 1, End);
+                if (Ext == nullptr)
+                    return false;
+                if (strcmp(Ext, "SPV_GOOGLE_hlsl_functionality1") == 0)
+                    HlslFunctionality1 = true;
+                break;
+            }
+
+            case spv::OpEntryPoint:
+            {
+                if (NumOps < 3)
+                    return false;
+                const auto* Name = GetString(Offset + 3, End);
+                if (Name == nullptr)
+                    return false;
+                const auto NameWords = static_cast<Uint32>(strlen(Name) / sizeof(uint32_t) + 1);
+                m_EntryPoints.emplace_back(EntryPointInfo{pOps[0], pOps[1], Name, Offset + 3 + NameWords, End});
+                break;
+            }
+
+            case spv::OpExecutionMode:
+            case spv::OpExecutionModeId:
+                if (NumOps < 2)
+                    return false;
+                m_ExecutionModes.emplace_back(ExecutionModeInfo{pOps[0], Opcode == spv::OpExecutionModeId ? ~0u : pOps[1], Offset + 3, NumOps - 2});
+                break;
+
+            case spv::OpDecorationGroup:
+            case spv::OpGroupDecorate:
+            case spv::OpGroupMemberDecorate:
+            case spv::OpTypeForwardPointer:
+                return false;
+
+            case spv::OpDecorate:
+            case spv::OpDecorateId:
+            {
+                auto* pId = NumOps >= 2 ? GetId(pOps[0]) : nullptr;
+                if (pId == nullptr)
+                    return false;
+                switch (pOps[1])
+                {
+                    // clang-format off
+                    case spv::DecorationBinding:       pId->BindingOffset       = Offset + 3; break;
+                    case spv::DecorationDescriptorSet: pId->DescriptorSetOffset = Offset + 3; break;
+                    case spv::DecorationLocation:      pId->LocationOffset      = Offset + 3; break;
+                    case spv::DecorationBlock:         pId->Block               = true;       break;
+                    case spv::DecorationBufferBlock:   pId->BufferBlock         = true;       break;
+                    case spv::DecorationNonWritable:   pId->NonWritable         = true;       break;
+                        // clang-format on
+
+                    case spv::DecorationArrayStride:
+                        pId->HasArrayStride = true;
+                        pId->ArrayStride    = NumOps >= 3 ? pOps[2] : 0;
+                        break;
+
+                    case spv::DecorationBuiltIn:
+                        // SPIRV-Cross uses the work group size built-in to override the local size
+                        if (NumOps >= 3 && pOps[2] == spv::BuiltInWorkgroupSize)
+                            return false;
+                        pId->BuiltIn = true;
+                        break;
+                }
+                if ((pOps[1] == spv::DecorationBinding || pOps[1] == spv::DecorationDescriptorSet || pOps[1] == spv::DecorationLocation) && NumOps < 3)
+                    return false;
+                break;
+            }
+
+            case spv::OpDecorateStringGOOGLE:
+            {
+                auto* pId = NumOps >= 3 ? GetId(pOps[0]) : nullptr;
+                if (pId == nullptr)
+                    return false;
+                if (pOps[1] == spv::DecorationHlslSemanticGOOGLE && (pId->Semantic = GetString(Offset + 3, End)) == nullptr)
+                    return false;
+                break;
+            }
+
+            case spv::OpMemberDecorate:
+                if (NumOps < 3)
+                    return false;
+                m_MemberDecorations.emplace_back(MemberDecoration{pOps[0], pOps[1], pOps[2], NumOps >= 4 ? pOps[3] : 0});
+                break;
+
+            case spv::OpVariable:
+            case spv::OpConstant:
+            case spv::OpSpecConstant:
+            {
+                auto* pId = NumOps >= 2 ? GetId(pOps[1]) : nullptr;
+                if (pId == nullptr)
+                    return false;
+                pId->InstrOffset = Offset;
+                if (Opcode == spv::OpVariable)
+                    Variables.push_back(Offset);
+                break;
+            }
+
+            case spv::OpTypeVoid:
+            case spv::OpTypeBool:
+            case spv::OpTypeInt:
+            case spv::OpTypeFloat:
+            case spv::OpTypeVector:
+            case spv::OpTypeMatrix:
+            case spv::OpTypeImage:
+            case spv::OpTypeSampler:
+            case spv::OpTypeSampledImage:
+            case spv::OpTypeArray:
+            case spv::OpTypeRuntimeArray:
+            case spv::OpTypeStruct:
+            case spv::OpTypePointer:
+            case spv::OpTypeAccelerationStructureKHR:
+            {
+                auto* pId = NumOps >= 1 ? GetId(pOps[0]) : nullptr;
+                if (pId == nullptr)
+                    return false;
+                pId->InstrOffset = Offset;
+                break;
+            }
+
+            case spv::OpFunction:
+                // All global declarations precede function definitions
+                return true;
+        }
+
+        Offset = End;
+    }
+
+    return true;
+}
+
+bool SPIRVBinaryScanner::ProcessVariable(Uint32 VarOffset)
+{
+    const auto* pVar       = &m_SPIRV[VarOffset];
+    const auto  VarId      = pVar[2];
+    const auto  VarStorage = pVar[3];
+
+    const auto* pPtrType = GetInstruction(pVar[1]);
+    if (VarStorage == spv::StorageClassFunction || pPtrType == nullptr || (pPtrType[0] & spv::OpCodeMask) != spv::OpTypePointer)
+        return true;
+
+    const auto PtrStorage = pPtrType[2];
+
+    // Strip array dimensions
+    Uint32 BaseTypeId = pPtrType[3];
+    Uint32 NumDims    = 0;
+    Uint32 ArraySize  = 1;
+    while (GetOpcode(BaseTypeId) == spv::OpTypeArray || GetOpcode(BaseTypeId) == spv::OpTypeRuntimeArray)
+    {
+        const auto* pArray = GetInstruction(BaseTypeId);
+        ArraySize          = 0;
+        if ((pArray[0] & spv::OpCodeMask) == spv::OpTypeArray && !GetConstantValue(pArray[3], ArraySize))
+            return false;
+        BaseTypeId = pArray[2];
+        ++NumDims;
+    }
+    // Only one-dimensional arrays are supported
+    if (NumDims > 1 || ArraySize > std::numeric_limits<Uint16>::max() || GetInstruction(BaseTypeId) == nullptr)
+        return false;
+
+    bool IsActive = true;
+    if (m_SPIRVVersion >= 0x10400 || VarStorage == spv::StorageClassInput || VarStorage == spv::StorageClassOutput)
+        IsActive = IsInEntryPointInterface(VarId);
+    if (!IsActive || IsBuiltInVariable(VarId, BaseTypeId))
+        return true;
+
+    const auto& Var     = m_Ids[VarId];
+    const auto  BaseOp  = GetOpcode(BaseTypeId);
+    const auto* VarName = Var.Name != nullptr ? Var.Name : "";
+
+    ImageInfo  Image;
+    const auto IsImage = GetImageInfo(BaseTypeId, Image);
+
+    if (VarStorage == spv::StorageClassInput)
+    {
+        StageInputs.emplace_back(StageInputInfo{Var.Semantic, Var.LocationOffset});
+        return true;
+    }
+
+    ResourceInfo Res;
+    Res.ArraySize = static_cast<Uint16>(ArraySize);
+    if (IsImage)
+    {
+        switch (Image.Dim)
+        {
+            // clang-format off
+            case spv::Dim1D:     Res.Dim = Image.Arrayed ? RESOURCE_DIM_TEX_1D_ARRAY   : RESOURCE_DIM_TEX_1D;   break;
+            case spv::Dim2D:     Res.Dim = Image.Arrayed ? RESOURCE_DIM_TEX_2D_ARRAY   : RESOURCE_DIM_TEX_2D;   break;
+            case spv::Dim3D:     Res.Dim = RESOURCE_DIM_TEX_3D;                                                 break;
+            case spv::DimCube:   Res.Dim = Image.Arrayed ? RESOURCE_DIM_TEX_CUBE_ARRAY : RESOURCE_DIM_TEX_CUBE; break;
+            case spv::DimBuffer: Res.Dim = RESOURCE_DIM_BUFFER;                                                 break;
+            default:             Res.Dim = RESOURCE_DIM_UNDEFINED;
+                // clang-format on
+        }
+        Res.IsMS = Image.MS;
+    }
+
+    RESOURCE_GROUP Group = RESOURCE_GROUP_COUNT;
+
+    const auto IsUniformConstant = PtrStorage == spv::StorageClassUniformConstant;
+    if (VarStorage == spv::StorageClassUniformConstant && IsImage && Image.Dim == spv::DimSubpassData)
+    {
+        Group    = RESOURCE_GROUP_INPT_ATT;
+        Res.Type = SPIRVShaderResourceAttribs::ResourceType::InputAttachment;
+        Res.Name = VarName;
+    }
+    else if (VarStorage == spv::StorageClassOutput)
+    {
+        return true;
+    }
+    else if ((PtrStorage == spv::StorageClassUniform && (m_Ids[BaseTypeId].Block || m_Ids[BaseTypeId].BufferBlock)) ||
+             PtrStorage == spv::StorageClassStorageBuffer)
+    {
+        const auto IsUB = PtrStorage == spv::StorageClassUniform && m_Ids[BaseTypeId].Block;
+
+        // For UBs and GLSL storage buffers, SPIRV-Cross reports the block name and falls back to the instance name.
+        // For HLSL, the instance name is significant.
+        const auto* BlockName = m_Ids[BaseTypeId].Name != nullptr ? m_Ids[BaseTypeId].Name : "";
+        Res.Name              = (IsHLSLSource || BlockName[0] == '\0') ? VarName : BlockName;
+        if (IsUB && IsHLSLSource && VarName[0] == '\0')
+            Res.Name = BlockName;
+        if (Res.Name[0] == '\0')
+        {
+            // SPIRV-Cross generates a fallback name
+            return false;
+        }
+
+        if (!GetStructSize(BaseTypeId, Res.BufferStaticSize))
+            return false;
+
+        if (IsUB)
+        {
+            Group    = RESOURCE_GROUP_UB;
+            Res.Type = SPIRVShaderResourceAttribs::ResourceType::UniformBuffer;
+        }
+        else
+        {
+            if (!GetRuntimeArrayStride(BaseTypeId, Res.BufferStride))
+                return false;
+
+            // Storage buffer is read-only if the variable or all members of its block are non-writable
+            auto IsReadOnly = Var.NonWritable;
+            if (!IsReadOnly)
+            {
+                const auto NumMembers = GetWordCount(BaseTypeId) - 2;
+                IsReadOnly            = true;
+                for (Uint32 i = 0; i < NumMembers && IsReadOnly; ++i)
+                    IsReadOnly = FindMemberDecoration(BaseTypeId, i, spv::DecorationNonWritable) != nullptr;
+            }
+
+            Group    = RESOURCE_GROUP_SB;
+            Res.Type = IsReadOnly ?
+                SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer :
+                SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer;
+        }
+    }
+    else if (PtrStorage == spv::StorageClassUniform || PtrStorage == spv::StorageClassPushConstant || PtrStorage == spv::StorageClassShaderRecordBufferKHR)
+    {
+        return true;
+    }
+    else if (IsUniformConstant && BaseOp == spv::OpTypeImage && Image.Sampled == 2)
+    {
+        Group    = RESOURCE_GROUP_IMG;
+        Res.Type = Image.Dim == spv::DimBuffer ?
+            SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer :
+            SPIRVShaderResourceAttribs::ResourceType::StorageImage;
+        Res.Name = VarName;
+    }
+    else if (IsUniformConstant && BaseOp == spv::OpTypeImage && Image.Sampled == 1)
+    {
+        Group    = RESOURCE_GROUP_SEP_IMG;
+        Res.Type = Image.Dim == spv::DimBuffer ?
+            SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer :
+            SPIRVShaderResourceAttribs::ResourceType::SeparateImage;
+        Res.Name = VarName;
+    }
+    else if (IsUniformConstant && BaseOp == spv::OpTypeSampler)
+    {
+        Group    = RESOURCE_GROUP_SEP_SMPLR;
+        Res.Type = SPIRVShaderResourceAttribs::ResourceType::SeparateSampler;
+        Res.Name = VarName;
+    }
+    else if (IsUniformConstant && BaseOp == spv::OpTypeSampledImage)
+    {
+        Group    = RESOURCE_GROUP_SMPLD_IMG;
+        Res.Type = Image.Dim == spv::DimBuffer ?
+            SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer :
+            SPIRVShaderResourceAttribs::ResourceType::SampledImage;
+        Res.Name = VarName;
+    }
+    else if (VarStorage == spv::StorageClassAtomicCounter)
+    {
+        Group    = RESOURCE_GROUP_AC;
+        Res.Type = SPIRVShaderResourceAttribs::ResourceType::AtomicCounter;
+        Res.Name = VarName;
+    }
+    else if (IsUniformConstant && BaseOp == spv::OpTypeAccelerationStructureKHR)
+    {
+        Group    = RESOURCE_GROUP_ACCEL_STRUCT;
+        Res.Type = SPIRVShaderResourceAttribs::ResourceType::AccelerationStructure;
+        Res.Name = VarName;
+    }
+    else
+    {
+        // Not a shader resource
+        return true;
+    }
+
+    if (!IsPlainIdentifier(Res.Name))
+        return false;
+
+    if (Var.BindingOffset == 0 || Var.DescriptorSetOffset == 0)
+        return false;
+    Res.BindingDecorationOffset       = Var.BindingOffset;
+    Res.DescriptorSetDecorationOffset = Var.DescriptorSetOffset;
+
+    Resources[Group].emplace_back(Res);
+    return true;
+}
+
+bool SPIRVBinaryScanner::Scan(spv::ExecutionModel ExecutionModel)
+{
+    if (m_SPIRV.size() < HeaderSize || m_SPIRV[0] != spv::MagicNumber)
+        return false;
+
+    m_SPIRVVersion = m_SPIRV[1];
+    m_Ids.resize(m_SPIRV[3]);
+
+    std::vector<Uint32> Variables;
+    if (!ParseInstructions(Variables))
+        return false;
+
+    // Only the source languages that SPIRV-Cross recognizes
+    if (m_SourceLanguage != spv::SourceLanguageESSL && m_SourceLanguage != spv::SourceLanguageGLSL && m_SourceLanguage != spv::SourceLanguageHLSL)
+        return false;
+    IsHLSLSource = m_SourceLanguage == spv::SourceLanguageHLSL;
+
+    // If there is no entry point of the requested type or there are multiple ones, let SPIRV-Cross report the problem
+    for (const auto& EP : m_EntryPoints)
+    {
+        if (EP.Model != static_cast<Uint32>(ExecutionModel))
+            continue;
+        if (m_pEntryPoint != nullptr)
+            return false;
+        m_pEntryPoint = &EP;
+    }
+    if (m_pEntryPoint == nullptr)
+        return false;
+    EntryPoint = m_pEntryPoint->Name;
+
+    for (const auto& Mode : m_ExecutionModes)
+    {
+        if (Mode.EntryPointId != m_pEntryPoint->FunctionId)
+            continue;
+
+        if (Mode.Mode == ~0u)
+        {
+            // Id execution modes (e.g. LocalSizeId) are not supported
+            return false;
+        }
+        if (Mode.Mode == spv::ExecutionModeLocalSize)
+        {
+            if (Mode.NumOperands < 3)
+                return false;
+            for (Uint32 i = 0; i < 3; ++i)
+                ComputeGroupSize[i] = m_SPIRV[Mode.OperandsOffset + i];
+        }
+    }
+
+    // Keep the order of decorations for the same member
+    std::stable_sort(m_MemberDecorations.begin(), m_MemberDecorations.end());
+
+    // Resources are reported in the order of variable declarations
+    for (auto VarOffset : Variables)
+    {
+        if (!ProcessVariable(VarOffset))
+            return false;
+    }
+
+    return true;
+}
+
+void LogNoHlslFunctionality1Warning(const char* ShaderName)
+{
+    LOG_WARNING_MESSAGE("SPIRV byte code of shader '", ShaderName,
+                        "' does not use SPV_GOOGLE_hlsl_functionality1 extension. "
+                        "As a result, it is not possible to get semantics of shader inputs and map them to proper locations. "
+                        "The shader will still work correctly if all attributes are declared in ascending order without any gaps. "
+                        "Enable SPV_GOOGLE_hlsl_functionality1 in your compiler to allow proper mapping of vertex shader inputs.");
+}
+
+} // namespace
+
+bool SPIRVShaderResources::LoadFromBinary(IMemoryAllocator&            Allocator,
+                                          const std::vector<uint32_t>& spirv_binary,
+                                          const ShaderDesc&            shaderDesc,
+                                          const char*                  CombinedSamplerSuffix,
+                                          bool                         LoadShaderStageInputs,
+                                          std::string&                 EntryPoint)
+{
+    SPIRVBinaryScanner Scanner{spirv_binary};
+    if (!Scanner.Scan(ShaderTypeToSpvExecutionModel(shaderDesc.ShaderType)))
+        return false;
+
+    if (!Scanner.IsHLSLSource || Scanner.StageInputs.empty())
+        LoadShaderStageInputs = false;
+    if (LoadShaderStageInputs && Scanner.HlslFunctionality1)
+    {
+        for (const auto& Input : Scanner.StageInputs)
+        {
+            // Let the SPIRV-Cross path report inputs without semantics
+            if (Input.Semantic == nullptr || Input.LocationDecorationOffset == 0)
+                return false;
+        }
+    }
+
+    // Nothing can fail after this point
+    m_IsHLSLSource = Scanner.IsHLSLSource;
+    EntryPoint     = Scanner.EntryPoint;
+
+    if (LoadShaderStageInputs && !Scanner.HlslFunctionality1)
+    {
+        LoadShaderStageInputs = false;
+        LogNoHlslFunctionality1Warning(shaderDesc.Name);
+    }
+
+    size_t ResourceNamesPoolSize = 0;
+    for (const auto& Group : Scanner.Resources)
+    {
+        for (const auto& Res : Group)
+            ResourceNamesPoolSize += strlen(Res.Name) + 1;
+    }
+
+    if (CombinedSamplerSuffix != nullptr)
+        ResourceNamesPoolSize += strlen(CombinedSamplerSuffix) + 1;
+
+    VERIFY_EXPR(shaderDesc.Name != nullptr);
+    ResourceNamesPoolSize += strlen(shaderDesc.Name) + 1;
+
+    const auto NumShaderStageInputs = LoadShaderStageInputs ? static_cast<Uint32>(Scanner.StageInputs.size()) : 0;
+    for (Uint32 i = 0; i < NumShaderStageInputs; ++i)
+        ResourceNamesPoolSize += strlen(Scanner.StageInputs[i].Semantic) + 1;
+
+    ResourceCounters ResCounters;
+    ResCounters.NumUBs          = static_cast<Uint32>(Scanner.Resources[SPIRVBinaryScanner::RESOURCE_GROUP_UB].size());
+    ResCounters.NumSBs          = static_cast<Uint32>(Scanner.Resources[SPIRVBinaryScanner::RESOURCE_GROUP_SB].size());
+    ResCounters.NumImgs         = static_cast<Uint32>(Scanner.Resources[SPIRVBinaryScanner::RESOURCE_GROUP_IMG].size());
+    ResCounters.NumSmpldImgs    = static_cast<Uint32>(Scanner.Resources[SPIRVBinaryScanner::RESOURCE_GROUP_SMPLD_IMG].size());
+    ResCounters.NumACs          = static_cast<Uint32>(Scanner.Resources[SPIRVBinaryScanner::RESOURCE_GROUP_AC].size());
+    ResCounters.NumSepSmplrs    = static_cast<Uint32>(Scanner.Resources[SPIRVBinaryScanner::RESOURCE_GROUP_SEP_SMPLR].size());
+    ResCounters.NumSepImgs      = static_cast<Uint32>(Scanner.Resources[SPIRVBinaryScanner::RESOURCE_GROUP_SEP_IMG].size());
+    ResCounters.NumInptAtts     = static_cast<Uint32>(Scanner.Resources[SPIRVBinaryScanner::RESOURCE_GROUP_INPT_ATT].size());
+    ResCounters.NumAccelStructs = static_cast<Uint32>(Scanner.Resources[SPIRVBinaryScanner::RESOURCE_GROUP_ACCEL_STRUCT].size());
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please set the new resource type counter here");
+
+    StringPool ResourceNamesPool;
+    Initialize(Allocator, ResCounters, NumShaderStageInputs, ResourceNamesPoolSize, ResourceNamesPool);
+
+    // Resource groups are stored contiguously in the same order
+    Uint32 ResIdx = 0;
+    for (const auto& Group : Scanner.Resources)
+    {
+        for (const auto& Res : Group)
+        {
+            new (&GetResource(ResIdx++)) SPIRVShaderResourceAttribs //
+                {
+                    ResourceNamesPool.CopyString(Res.Name),
+                    Res.ArraySize,
+                    Res.Type,
+                    Res.Dim,
+                    Res.IsMS,
+                    Res.BindingDecorationOffset,
+                    Res.DescriptorSetDecorationOffset,
+                    Res.BufferStaticSize,
+                    Res.BufferStride //
+                };
+        }
+    }
+    VERIFY_EXPR(ResIdx == GetTotalResources());
+
+    if (CombinedSamplerSuffix != nullptr)
+        m_CombinedSamplerSuffix = ResourceNamesPool.CopyString(CombinedSamplerSuffix);
+
+    m_ShaderName = ResourceNamesPool.CopyString(shaderDesc.Name);
+
+    for (Uint32 i = 0; i < NumShaderStageInputs; ++i)
+    {
+        const auto& Input = Scanner.StageInputs[i];
+        new (&GetShaderStageInputAttribs(i)) SPIRVShaderStageInputAttribs //
+            {
+                ResourceNamesPool.CopyString(Input.Semantic),
+                Input.LocationDecorationOffset //
+            };
+    }
+
+    VERIFY(ResourceNamesPool.GetRemainingSize() == 0, "Names pool must be empty");
+
+    if (shaderDesc.ShaderType == SHADER_TYPE_COMPUTE)
+        m_ComputeGroupSize = Scanner.ComputeGroupSize;
+
+    return true;
+}
+
+
 SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
                                            std::vector<uint32_t> spirv_binary,
                                            const ShaderDesc&     shaderDesc,
                                            const char*           CombinedSamplerSuffix,
                                            bool                  LoadShaderStageInputs,
                                            bool                  LoadUniformBufferReflection,
-                                           std::string&          EntryPoint) :
+                                           std::string&          EntryPoint,
+                                           bool                  ForceSPIRVCross) :
     m_ShaderType{shaderDesc.ShaderType}
 {
+    // Uniform buffer reflection requires full type information, which is only available through SPIRV-Cross
+    if (!ForceSPIRVCross && !LoadUniformBufferReflection && LoadFromBinary(Allocator, spirv_binary, shaderDesc, CombinedSamplerSuffix, LoadShaderStageInputs, EntryPoint))
+    {
+        m_IsLoadedFromBinary = true;
+        return;
+    }
+
     // https://github.com/KhronosGroup/SPIRV-Cross/wiki/Reflection-API-user-guide
     diligent_spirv_cross::Parser parser{std::move(spirv_binary)};
     parser.parse();
@@ -465,11 +1452,7 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
             LoadShaderStageInputs = false;
             if (m_IsHLSLSource)
             {
-                LOG_WARNING_MESSAGE("SPIRV byte code of shader '", shaderDesc.Name,
-                                    "' does not use SPV_GOOGLE_hlsl_functionality1 extension. "
-                                    "As a result, it is not possible to get semantics of shader inputs and map them to proper locations. "
-                                    "The shader will still work correctly if all attributes are declared in ascending order without any gaps. "
-                                    "Enable SPV_GOOGLE_hlsl_functionality1 in your compiler to allow proper mapping of vertex shader inputs.");
+                LogNoHlslFunctionality1Warning(shaderDesc.Name);
             }
         }
     }
@@ -25,7 +25,14 @@
  */
 
 #include "SPIRVTools.hpp"
+
+#include <memory>
+#include <atomic>
+#include <unordered_map>
+
 #include "DebugUtilities.hpp"
+#include "HashUtils.hpp"
+#include "LRUCache.hpp"
 
 #include "spirv-tools/optimizer.hpp"
 
@@ -105,42 +112,138 @@ spv_target_env SpvTargetEnvFromSPIRV(const std::vector<uint32_t>& SPIRV)
     }
 }
 
-} // namespace
-
-std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV, spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes)
+std::unique_ptr<spvtools::Optimizer> CreateOptimizer(spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes)
 {
-    VERIFY_EXPR(Passes != SPIRV_OPTIMIZATION_FLAG_NONE);
-
-    if (TargetEnv == SPV_ENV_MAX)
-        TargetEnv = SpvTargetEnvFromSPIRV(SrcSPIRV);
-
-    spvtools::Optimizer SpirvOptimizer(TargetEnv);
-    SpirvOptimizer.SetMessageConsumer(SpvOptimizerMessageConsumer);
+    auto pOptimizer = std::make_unique<spvtools::Optimizer>(TargetEnv);
+    pOptimizer->SetMessageConsumer(SpvOptimizerMessageConsumer);
 
     // SPIR-V bytecode generated from HLSL must be legalized to
     // turn it into a valid vulkan SPIR-V shader.
     if (Passes & SPIRV_OPTIMIZATION_FLAG_LEGALIZATION)
     {
-        SpirvOptimizer.RegisterLegalizationPasses();
+        pOptimizer->RegisterLegalizationPasses();
+    }
+
+    if (Passes & SPIRV_OPTIMIZATION_FLAG_UNROLL_LOOPS)
+    {
+        // Unroll before the main passes so that they can optimize the unrolled code
+        pOptimizer->RegisterPass(spvtools::CreateLoopUnrollPass(/*fully_unroll = */ true));
     }
 
     if (Passes & SPIRV_OPTIMIZATION_FLAG_PERFORMANCE)
     {
-        SpirvOptimizer.RegisterPerformancePasses();
+        pOptimizer->RegisterPerformancePasses();
+    }
+
+    if (Passes & SPIRV_OPTIMIZATION_FLAG_SIZE)
+    {
+        VERIFY((Passes & SPIRV_OPTIMIZATION_FLAG_PERFORMANCE) == 0, "Size and performance passes should not be combined");
+        pOptimizer->RegisterSizePasses();
+    }
+
+    if (Passes & SPIRV_OPTIMIZATION_FLAG_REMOVE_DEAD_BINDINGS)
+    {
+        // Dead code elimination may leave resource variables that are only referenced by decorations
+        pOptimizer->RegisterPass(spvtools::CreateAggressiveDCEPass());
+        pOptimizer->RegisterPass(spvtools::CreateDeadVariableEliminationPass());
     }
 
     if (Passes & SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION)
     {
         // Decorations defined in SPV_GOOGLE_hlsl_functionality1 are the only instructions
         // removed by strip-reflect-info pass. SPIRV offsets become INVALID after this operation.
-        SpirvOptimizer.RegisterPass(spvtools::CreateStripReflectInfoPass());
+        pOptimizer->RegisterPass(spvtools::CreateStripReflectInfoPass());
+    }
+
+    return pOptimizer;
+}
+
+// Returns the optimizer owned by the calling thread for the given target environment and passes.
+// spvtools::Optimizer is not thread-safe, but can run any number of modules once the passes are registered.
+const spvtools::Optimizer& GetThreadOptimizer(spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes)
+{
+    static thread_local std::unordered_map<Uint64, std::unique_ptr<spvtools::Optimizer>> Optimizers;
+
+    auto& pOptimizer = Optimizers[(Uint64{static_cast<Uint32>(TargetEnv)} << 32u) | Uint64{Passes}];
+    if (!pOptimizer)
+        pOptimizer = CreateOptimizer(TargetEnv, Passes);
+
+    return *pOptimizer;
+}
+
+struct OptimizedSPIRVKey
+{
+    std::vector<uint32_t>    SPIRV;
+    spv_target_env           TargetEnv;
+    SPIRV_OPTIMIZATION_FLAGS Passes;
+    size_t                   Hash;
+
+    OptimizedSPIRVKey(const std::vector<uint32_t>& _SPIRV, spv_target_env _TargetEnv, SPIRV_OPTIMIZATION_FLAGS _Passes) :
+        SPIRV{_SPIRV},
+        TargetEnv{_TargetEnv},
+        Passes{_Passes},
+        Hash{ComputeHash(static_cast<Uint32>(_TargetEnv), static_cast<Uint32>(_Passes), ComputeHashRaw(_SPIRV.data(), _SPIRV.size() * sizeof(uint32_t)))}
+    {}
+
+    bool operator==(const OptimizedSPIRVKey& rhs) const
+    {
+        return Hash == rhs.Hash && TargetEnv == rhs.TargetEnv && Passes == rhs.Passes && SPIRV == rhs.SPIRV;
     }
 
-    std::vector<uint32_t> OptimizedSPIRV;
-    if (!SpirvOptimizer.Run(SrcSPIRV.data(), SrcSPIRV.size(), &OptimizedSPIRV))
-        OptimizedSPIRV.clear();
+    struct Hasher
+    {
+        size_t operator()(const OptimizedSPIRVKey& Key) const
+        {
+            return Key.Hash;
+        }
+    };
+};
+
+constexpr size_t DefaultOptimizedSPIRVCacheSize = size_t{32} << 20;
+
+std::atomic<size_t> g_OptimizedSPIRVCacheSize{DefaultOptimizedSPIRVCacheSize};
+
+LRUCache<OptimizedSPIRVKey, std::vector<uint32_t>, OptimizedSPIRVKey::Hasher>& GetOptimizedSPIRVCache()
+{
+    static LRUCache<OptimizedSPIRVKey, std::vector<uint32_t>, OptimizedSPIRVKey::Hasher> Cache{DefaultOptimizedSPIRVCacheSize};
+    return Cache;
+}
 
-    return OptimizedSPIRV;
+} // namespace
+
+std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV, spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes)
+{
+    VERIFY_EXPR((Passes & ~SPIRV_OPTIMIZATION_FLAG_NO_CACHE) != SPIRV_OPTIMIZATION_FLAG_NONE);
+
+    if (TargetEnv == SPV_ENV_MAX)
+        TargetEnv = SpvTargetEnvFromSPIRV(SrcSPIRV);
+
+    const auto UseCache = (Passes & SPIRV_OPTIMIZATION_FLAG_NO_CACHE) == 0 && g_OptimizedSPIRVCacheSize.load() > 0;
+    Passes &= ~SPIRV_OPTIMIZATION_FLAG_NO_CACHE;
+
+    auto Optimize = [&]() {
+        std::vector<uint32_t> OptimizedSPIRV;
+        if (!GetThreadOptimizer(TargetEnv, Passes).Run(SrcSPIRV.data(), SrcSPIRV.size(), &OptimizedSPIRV))
+            OptimizedSPIRV.clear();
+        return OptimizedSPIRV;
+    };
+
+    if (!UseCache)
+        return Optimize();
+
+    return GetOptimizedSPIRVCache().Get(
+        OptimizedSPIRVKey{SrcSPIRV, TargetEnv, Passes},
+        [&](std::vector<uint32_t>& OptimizedSPIRV, size_t& Size) {
+            OptimizedSPIRV = Optimize();
+            // The cache keeps a copy of the source module in the key
+            Size = (SrcSPIRV.size() + OptimizedSPIRV.size()) * sizeof(uint32_t);
+        });
+}
+
+void SetSPIRVOptimizationCacheSize(size_t MaxSize)
+{
+    g_OptimizedSPIRVCacheSize.store(MaxSize);
+    GetOptimizedSPIRVCache().SetMaxSize(MaxSize);
 }
 
 } // namespace Diligent
@@ -53,6 +53,8 @@ public:
 
     bool Write(const void* Data, size_t BufferSize);
 
+    bool Write(const FileWriteRange* pRanges, size_t NumRanges);
+
     size_t GetSize() { return m_Size; }
 
     size_t GetPos();
@@ -36,6 +36,9 @@ namespace Diligent
 
 struct AndroidMisc : public LinuxMisc
 {
+    /// Sets the current thread affinity mask and on success returns the previous mask.
+    /// On failure, returns 0.
+    static Uint64 SetCurrentThreadAffinity(Uint64 Mask);
 };
 
 } // namespace Diligent
@@ -279,6 +279,16 @@ bool AndroidFile::Write(const void* Data, size_t BufferSize)
     return false;
 }
 
+bool AndroidFile::Write(const FileWriteRange* pRanges, size_t NumRanges)
+{
+    for (size_t i = 0; i < NumRanges; ++i)
+    {
+        if (pRanges[i].Size > 0 && !Write(pRanges[i].pData, pRanges[i].Size))
+            return false;
+    }
+    return true;
+}
+
 size_t AndroidFile::GetPos()
 {
     UNSUPPORTED("Not implemented");
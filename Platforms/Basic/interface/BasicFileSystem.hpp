@@ -62,6 +62,13 @@ struct FileOpenAttribs
     {}
 };
 
+/// Data range of a vectored file write
+struct FileWriteRange
+{
+    const void* pData = nullptr;
+    size_t      Size  = 0;
+};
+
 class BasicFile
 {
 public:
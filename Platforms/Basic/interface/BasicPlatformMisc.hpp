@@ -27,7 +27,10 @@
 
 #pragma once
 
+#include <vector>
+
 #include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Primitives/interface/FlagEnum.h"
 
 namespace Diligent
 {
@@ -42,6 +45,76 @@ enum class ThreadPriority
     Highest
 };
 
+/// CPU instruction set extension flags
+enum CPU_FEATURE_FLAGS : Uint32
+{
+    CPU_FEATURE_FLAG_NONE  = 0u,
+    CPU_FEATURE_FLAG_SSE2  = 1u << 0u,
+    CPU_FEATURE_FLAG_SSE41 = 1u << 1u,
+    CPU_FEATURE_FLAG_AVX   = 1u << 2u,
+    CPU_FEATURE_FLAG_AVX2  = 1u << 3u,
+    CPU_FEATURE_FLAG_FMA   = 1u << 4u,
+    CPU_FEATURE_FLAG_NEON  = 1u << 5u
+};
+DEFINE_FLAG_ENUM_OPERATORS(CPU_FEATURE_FLAGS)
+
+/// CPU core type
+enum CPU_CORE_TYPE : Uint8
+{
+    /// High-performance core (e.g. Intel P-core or ARM big core).
+    /// All cores of homogeneous CPUs are reported as performance cores.
+    CPU_CORE_TYPE_PERFORMANCE = 0,
+
+    /// Energy-efficient core (e.g. Intel E-core or ARM LITTLE core).
+    CPU_CORE_TYPE_EFFICIENCY
+};
+
+/// Logical processor (hardware thread) description
+struct LogicalProcessorInfo
+{
+    /// OS index of the logical processor.
+    /// Bit Index of the affinity mask corresponds to this processor, see SetCurrentThreadAffinity().
+    Uint32 Index = 0;
+
+    /// Index of the physical core in the range [0, CPUTopology::NumCores).
+    /// Logical processors that share the same core are SMT siblings.
+    Uint32 Core = 0;
+
+    /// Index of the NUMA node in the range [0, CPUTopology::NumNUMANodes).
+    Uint32 NUMANode = 0;
+
+    /// Core type, see Diligent::CPU_CORE_TYPE.
+    CPU_CORE_TYPE CoreType = CPU_CORE_TYPE_PERFORMANCE;
+};
+
+/// CPU topology
+
+/// \note  Affinity masks returned by the methods only include the first 64 logical processors.
+struct CPUTopology
+{
+    /// Logical processors sorted by index.
+    std::vector<LogicalProcessorInfo> LogicalProcessors;
+
+    /// The number of physical cores.
+    Uint32 NumCores = 0;
+
+    /// The number of NUMA nodes.
+    Uint32 NumNUMANodes = 0;
+
+    /// Returns true if the CPU has both performance and efficiency cores.
+    bool IsHybrid() const;
+
+    /// Returns the affinity mask of all logical processors of the given core type.
+    Uint64 GetAffinityMask(CPU_CORE_TYPE CoreType) const;
+
+    /// Returns the affinity mask of all logical processors of the given NUMA node.
+    Uint64 GetNUMANodeAffinityMask(Uint32 NUMANode) const;
+
+    /// Returns the indices of the first logical processor of every physical core,
+    /// performance cores first.
+    std::vector<Uint32> GetPrimaryLogicalProcessors() const;
+};
+
 struct BasicPlatformMisc
 {
     template <typename Type>
@@ -107,6 +180,30 @@ struct BasicPlatformMisc
     /// On failure, returns ThreadPriority::Unknown.
     static ThreadPriority SetCurrentThreadPriority(ThreadPriority Priority);
 
+    /// Sets the current thread affinity mask and on success returns the previous mask.
+    /// On failure, returns 0.
+    static Uint64 SetCurrentThreadAffinity(Uint64 Mask);
+
+    /// Returns the CPU topology. The topology is detected on the first call.
+
+    /// \remarks   If the topology can't be determined, every logical processor is reported
+    ///            as a separate performance core in a single NUMA node.
+    static const CPUTopology& GetCPUTopology();
+
+    /// Returns the instruction set extensions that are supported by both the CPU and the OS.
+    /// The features are detected on the first call.
+    static CPU_FEATURE_FLAGS GetCPUFeatures();
+
+    /// Returns true if all features in Features are supported.
+    static bool CheckCPUFeatures(CPU_FEATURE_FLAGS Features)
+    {
+        return (GetCPUFeatures() & Features) == Features;
+    }
+
+protected:
+    // Returns the topology where every logical processor is a separate performance core.
+    static CPUTopology GetDefaultCPUTopology();
+
 private:
     static void SwapBytes16(Uint16& Val)
     {
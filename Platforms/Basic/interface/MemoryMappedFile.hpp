@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "../../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Read-only memory-mapped view of the entire file.
+
+/// The file contents are mapped into the process address space, so pages are only read
+/// from the disk when they are first accessed. By default, the view has copy-on-write
+/// protection, and writing to it never modifies the file.
+///
+/// A read-only view maps the pages of the OS file cache directly: they are shared by all
+/// processes that map the same file, and the view is not charged against the commit limit
+/// of the process. Writing to a read-only view is not allowed and terminates the process.
+class MemoryMappedFile
+{
+public:
+    /// Maps the file at the given path. Throws an exception in case of failure.
+    explicit MemoryMappedFile(const Char* strFilePath, bool ReadOnly = false) noexcept(false);
+    ~MemoryMappedFile();
+
+    // clang-format off
+    MemoryMappedFile           (const MemoryMappedFile&) = delete;
+    MemoryMappedFile           (MemoryMappedFile&&)      = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(MemoryMappedFile&&)      = delete;
+    // clang-format on
+
+    const String& GetPath() const { return m_Path; }
+
+    /// Returns the pointer to the beginning of the mapped data, or null if the file is empty.
+    void* GetData() const { return m_pData; }
+
+    /// Returns the size of the mapped data, which is the file size.
+    size_t GetSize() const { return m_Size; }
+
+    /// Returns true if the view is read-only.
+    bool IsReadOnly() const { return m_ReadOnly; }
+
+private:
+    const String m_Path;
+    const bool   m_ReadOnly;
+
+    void*  m_pData = nullptr;
+    size_t m_Size  = 0;
+};
+
+} // namespace Diligent
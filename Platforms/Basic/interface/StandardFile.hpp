@@ -47,6 +47,10 @@ public:
 
     bool Write(const void* Data, size_t Size);
 
+    /// Writes the ranges one after another.
+    /// On POSIX platforms, the ranges are written with vectored writes (writev) that bypass the stream buffer.
+    bool Write(const FileWriteRange* pRanges, size_t NumRanges);
+
     size_t GetSize();
 
     size_t GetPos();
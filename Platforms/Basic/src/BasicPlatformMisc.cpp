@@ -25,11 +25,101 @@
  */
 
 #include "BasicPlatformMisc.hpp"
+
+#include <algorithm>
+#include <thread>
+
 #include "DebugUtilities.hpp"
 
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#    include <intrin.h>
+#    define DILIGENT_X86_CPUID_MSVC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+#    include <cpuid.h>
+#    define DILIGENT_X86_CPUID_GCC 1
+#endif
+
 namespace Diligent
 {
 
+namespace
+{
+
+#if DILIGENT_X86_CPUID_MSVC || DILIGENT_X86_CPUID_GCC
+
+void CPUID(Uint32 Leaf, Uint32 SubLeaf, Uint32 Regs[4])
+{
+#    if DILIGENT_X86_CPUID_MSVC
+    int Info[4] = {};
+    __cpuidex(Info, static_cast<int>(Leaf), static_cast<int>(SubLeaf));
+    for (int i = 0; i < 4; ++i)
+        Regs[i] = static_cast<Uint32>(Info[i]);
+#    else
+    __cpuid_count(Leaf, SubLeaf, Regs[0], Regs[1], Regs[2], Regs[3]);
+#    endif
+}
+
+Uint64 GetXCR0()
+{
+#    if DILIGENT_X86_CPUID_MSVC
+    return _xgetbv(0);
+#    else
+    Uint32 Eax = 0, Edx = 0;
+    __asm__ volatile("xgetbv"
+                     : "=a"(Eax), "=d"(Edx)
+                     : "c"(0));
+    return (Uint64{Edx} << 32u) | Eax;
+#    endif
+}
+
+#endif
+
+CPU_FEATURE_FLAGS DetectCPUFeatures()
+{
+    CPU_FEATURE_FLAGS Features = CPU_FEATURE_FLAG_NONE;
+
+#if DILIGENT_X86_CPUID_MSVC || DILIGENT_X86_CPUID_GCC
+    Uint32 Regs[4] = {};
+    CPUID(0, 0, Regs);
+    const Uint32 MaxLeaf = Regs[0];
+    if (MaxLeaf < 1)
+        return Features;
+
+    CPUID(1, 0, Regs);
+    const Uint32 Ecx = Regs[2];
+    const Uint32 Edx = Regs[3];
+
+    if (Edx & (1u << 26u))
+        Features |= CPU_FEATURE_FLAG_SSE2;
+    if (Ecx & (1u << 19u))
+        Features |= CPU_FEATURE_FLAG_SSE41;
+
+    // AVX requires the OS to save the YMM registers on context switch (XCR0 bits 1 and 2)
+    const bool OSXSave = (Ecx & (1u << 27u)) != 0;
+    if (OSXSave && (GetXCR0() & 0x6u) == 0x6u)
+    {
+        if (Ecx & (1u << 28u))
+            Features |= CPU_FEATURE_FLAG_AVX;
+        if (Ecx & (1u << 12u))
+            Features |= CPU_FEATURE_FLAG_FMA;
+
+        if ((Features & CPU_FEATURE_FLAG_AVX) != 0 && MaxLeaf >= 7)
+        {
+            CPUID(7, 0, Regs);
+            if (Regs[1] & (1u << 5u))
+                Features |= CPU_FEATURE_FLAG_AVX2;
+        }
+    }
+#elif defined(__ARM_NEON) || defined(_M_ARM64) || defined(_M_ARM)
+    // NEON is a mandatory part of the target architecture when the compiler is allowed to use it
+    Features |= CPU_FEATURE_FLAG_NEON;
+#endif
+
+    return Features;
+}
+
+} // namespace
+
 ThreadPriority BasicPlatformMisc::GetCurrentThreadPriority()
 {
     LOG_WARNING_MESSAGE_ONCE("GetCurrentThreadPriority is not implemented on this platform.");
@@ -42,4 +132,86 @@ ThreadPriority BasicPlatformMisc::SetCurrentThreadPriority(ThreadPriority Priori
     return ThreadPriority::Unknown;
 }
 
+Uint64 BasicPlatformMisc::SetCurrentThreadAffinity(Uint64 Mask)
+{
+    LOG_WARNING_MESSAGE_ONCE("SetCurrentThreadAffinity is not implemented on this platform.");
+    return 0;
+}
+
+CPUTopology BasicPlatformMisc::GetDefaultCPUTopology()
+{
+    CPUTopology Topology;
+
+    const Uint32 NumProcessors = std::max(std::thread::hardware_concurrency(), 1u);
+    Topology.LogicalProcessors.resize(NumProcessors);
+    for (Uint32 i = 0; i < NumProcessors; ++i)
+    {
+        Topology.LogicalProcessors[i].Index = i;
+        Topology.LogicalProcessors[i].Core  = i;
+    }
+    Topology.NumCores     = NumProcessors;
+    Topology.NumNUMANodes = 1;
+
+    return Topology;
+}
+
+const CPUTopology& BasicPlatformMisc::GetCPUTopology()
+{
+    static const CPUTopology Topology = GetDefaultCPUTopology();
+    return Topology;
+}
+
+bool CPUTopology::IsHybrid() const
+{
+    return GetAffinityMask(CPU_CORE_TYPE_EFFICIENCY) != 0 && GetAffinityMask(CPU_CORE_TYPE_PERFORMANCE) != 0;
+}
+
+Uint64 CPUTopology::GetAffinityMask(CPU_CORE_TYPE CoreType) const
+{
+    Uint64 Mask = 0;
+    for (const auto& Processor : LogicalProcessors)
+    {
+        if (Processor.CoreType == CoreType && Processor.Index < 64)
+            Mask |= Uint64{1} << Processor.Index;
+    }
+    return Mask;
+}
+
+Uint64 CPUTopology::GetNUMANodeAffinityMask(Uint32 NUMANode) const
+{
+    Uint64 Mask = 0;
+    for (const auto& Processor : LogicalProcessors)
+    {
+        if (Processor.NUMANode == NUMANode && Processor.Index < 64)
+            Mask |= Uint64{1} << Processor.Index;
+    }
+    return Mask;
+}
+
+std::vector<Uint32> CPUTopology::GetPrimaryLogicalProcessors() const
+{
+    std::vector<Uint32> Processors;
+
+    std::vector<bool> CoreVisited(NumCores);
+    for (auto CoreType : {CPU_CORE_TYPE_PERFORMANCE, CPU_CORE_TYPE_EFFICIENCY})
+    {
+        for (const auto& Processor : LogicalProcessors)
+        {
+            if (Processor.CoreType != CoreType || Processor.Core >= NumCores || CoreVisited[Processor.Core])
+                continue;
+
+            CoreVisited[Processor.Core] = true;
+            Processors.push_back(Processor.Index);
+        }
+    }
+
+    return Processors;
+}
+
+CPU_FEATURE_FLAGS BasicPlatformMisc::GetCPUFeatures()
+{
+    static const CPU_FEATURE_FLAGS Features = DetectCPUFeatures();
+    return Features;
+}
+
 } // namespace Diligent
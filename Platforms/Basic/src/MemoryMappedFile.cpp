@@ -0,0 +1,178 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "MemoryMappedFile.hpp"
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+#    include "../../Win32/interface/WinHPreface.h"
+#    include <Windows.h>
+#    include "../../Win32/interface/WinHPostface.h"
+#    include "../../../Common/interface/StringTools.hpp"
+#elif PLATFORM_LINUX || PLATFORM_ANDROID || PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS || PLATFORM_EMSCRIPTEN
+#    include <cerrno>
+#    include <cstring>
+#    include <fcntl.h>
+#    include <unistd.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#endif
+
+namespace Diligent
+{
+
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+
+MemoryMappedFile::MemoryMappedFile(const Char* strFilePath, bool ReadOnly) noexcept(false) :
+    m_Path{strFilePath != nullptr ? strFilePath : ""},
+    m_ReadOnly{ReadOnly}
+{
+    if (strFilePath == nullptr)
+        LOG_ERROR_AND_THROW("File path must not be null");
+
+    const auto PathW = WidenString(m_Path);
+#    if PLATFORM_WIN32
+    HANDLE hFile = CreateFileW(PathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+#    else
+    HANDLE hFile    = CreateFile2(PathW.c_str(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr);
+#    endif
+    if (hFile == INVALID_HANDLE_VALUE)
+        LOG_ERROR_AND_THROW("Failed to open file ", m_Path, ". Error code: ", GetLastError());
+
+    LARGE_INTEGER FileSize{};
+    if (!GetFileSizeEx(hFile, &FileSize))
+    {
+        const auto Error = GetLastError();
+        CloseHandle(hFile);
+        LOG_ERROR_AND_THROW("Failed to get the size of file ", m_Path, ". Error code: ", Error);
+    }
+    m_Size = static_cast<size_t>(FileSize.QuadPart);
+    if (m_Size == 0)
+    {
+        // Empty files can't be mapped
+        CloseHandle(hFile);
+        return;
+    }
+
+    // Copy-on-write views are charged against the commit limit for their entire size, read-only views are not.
+    const DWORD PageProtection = m_ReadOnly ? PAGE_READONLY : PAGE_WRITECOPY;
+    const DWORD ViewAccess     = m_ReadOnly ? FILE_MAP_READ : FILE_MAP_COPY;
+
+    // The view keeps references to the file and the mapping object, so both handles can be closed right away.
+#    if PLATFORM_WIN32
+    HANDLE hMapping = CreateFileMappingW(hFile, nullptr, PageProtection, 0, 0, nullptr);
+#    else
+    HANDLE hMapping = CreateFileMappingFromApp(hFile, nullptr, PageProtection, 0, nullptr);
+#    endif
+    const auto MappingError = GetLastError();
+    CloseHandle(hFile);
+    if (hMapping == nullptr)
+        LOG_ERROR_AND_THROW("Failed to create file mapping for ", m_Path, ". Error code: ", MappingError);
+
+#    if PLATFORM_WIN32
+    m_pData = MapViewOfFile(hMapping, ViewAccess, 0, 0, 0);
+#    else
+    m_pData         = MapViewOfFileFromApp(hMapping, ViewAccess, 0, 0);
+#    endif
+    const auto ViewError = GetLastError();
+    CloseHandle(hMapping);
+    if (m_pData == nullptr)
+        LOG_ERROR_AND_THROW("Failed to map file ", m_Path, ". Error code: ", ViewError);
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (m_pData != nullptr)
+        UnmapViewOfFile(m_pData);
+}
+
+#elif PLATFORM_LINUX || PLATFORM_ANDROID || PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS || PLATFORM_EMSCRIPTEN
+
+MemoryMappedFile::MemoryMappedFile(const Char* strFilePath, bool ReadOnly) noexcept(false) :
+    m_Path{strFilePath != nullptr ? strFilePath : ""},
+    m_ReadOnly{ReadOnly}
+{
+    if (strFilePath == nullptr)
+        LOG_ERROR_AND_THROW("File path must not be null");
+
+    const int fd = open(strFilePath, O_RDONLY);
+    if (fd < 0)
+        LOG_ERROR_AND_THROW("Failed to open file ", m_Path, "\nThe following error occurred: ", strerror(errno));
+
+    struct stat FileStat = {};
+    if (fstat(fd, &FileStat) != 0)
+    {
+        const auto Error = errno;
+        close(fd);
+        LOG_ERROR_AND_THROW("Failed to get the size of file ", m_Path, "\nThe following error occurred: ", strerror(Error));
+    }
+
+    m_Size = static_cast<size_t>(FileStat.st_size);
+    if (m_Size == 0)
+    {
+        // Empty files can't be mapped
+        close(fd);
+        return;
+    }
+
+    // Private mapping makes the pages copy-on-write, so the file is never modified.
+    // Read-only shared mapping references the page cache directly and is not accounted as committed memory.
+    // The mapping keeps its own reference to the file, so the descriptor can be closed right away.
+    void* pData = m_ReadOnly ?
+        mmap(nullptr, m_Size, PROT_READ, MAP_SHARED, fd, 0) :
+        mmap(nullptr, m_Size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+    const auto Error = errno;
+    close(fd);
+    if (pData == MAP_FAILED)
+        LOG_ERROR_AND_THROW("Failed to map file ", m_Path, "\nThe following error occurred: ", strerror(Error));
+
+    m_pData = pData;
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (m_pData != nullptr)
+        munmap(m_pData, m_Size);
+}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(const Char* strFilePath, bool ReadOnly) noexcept(false) :
+    m_Path{strFilePath != nullptr ? strFilePath : ""},
+    m_ReadOnly{ReadOnly}
+{
+    LOG_ERROR_AND_THROW("Memory-mapped files are not supported on this platform");
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+}
+
+#endif
+
+} // namespace Diligent
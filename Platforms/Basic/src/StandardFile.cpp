@@ -26,6 +26,15 @@
  */
 
 #include "StandardFile.hpp"
+
+#if PLATFORM_LINUX || PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS || PLATFORM_EMSCRIPTEN
+#    include <errno.h>
+#    include <sys/types.h>
+#    include <sys/uio.h>
+#    include <unistd.h>
+#    define DILIGENT_HAS_WRITEV 1
+#endif
+
 #include "DebugUtilities.hpp"
 #include "Errors.hpp"
 
@@ -84,6 +93,74 @@ bool StandardFile::Write(const void* Data, size_t Size)
     return BytesWritten == Size;
 }
 
+bool StandardFile::Write(const FileWriteRange* pRanges, size_t NumRanges)
+{
+    VERIFY(m_pFile, "File is not opened");
+    if (!m_pFile)
+        return false;
+
+#if DILIGENT_HAS_WRITEV
+    // Data written by fwrite() must reach the file before the ranges
+    if (fflush(m_pFile) != 0)
+        return false;
+
+    const int fd = fileno(m_pFile);
+
+    // POSIX guarantees that at least 16 (_XOPEN_IOV_MAX) ranges may be written at once
+    constexpr size_t MaxRangesPerCall = 16;
+
+    iovec  IOVecs[MaxRangesPerCall];
+    size_t RangeIdx    = 0;
+    size_t RangeOffset = 0; // Offset in pRanges[RangeIdx] that has already been written
+    while (RangeIdx < NumRanges)
+    {
+        int NumIOVecs = 0;
+        for (size_t i = RangeIdx; i < NumRanges && NumIOVecs < static_cast<int>(MaxRangesPerCall); ++i)
+        {
+            const size_t Offset = i == RangeIdx ? RangeOffset : 0;
+            if (pRanges[i].Size <= Offset)
+                continue;
+
+            IOVecs[NumIOVecs].iov_base = const_cast<Uint8*>(static_cast<const Uint8*>(pRanges[i].pData) + Offset);
+            IOVecs[NumIOVecs].iov_len  = pRanges[i].Size - Offset;
+            ++NumIOVecs;
+        }
+        if (NumIOVecs == 0)
+            break;
+
+        auto BytesWritten = writev(fd, IOVecs, NumIOVecs);
+        if (BytesWritten < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            LOG_ERROR_MESSAGE("Failed to write to file ", m_OpenAttribs.strFilePath, ": ", strerror(errno));
+            return false;
+        }
+
+        // Skip the ranges that were written completely, possibly partially writing the last one
+        auto BytesLeft = static_cast<size_t>(BytesWritten);
+        while (RangeIdx < NumRanges && BytesLeft >= pRanges[RangeIdx].Size - RangeOffset)
+        {
+            BytesLeft -= pRanges[RangeIdx].Size - RangeOffset;
+            RangeOffset = 0;
+            ++RangeIdx;
+        }
+        RangeOffset += BytesLeft;
+    }
+
+    // Resynchronize the stream with the file offset that was advanced by writev()
+    const auto Pos = lseek(fd, 0, SEEK_CUR);
+    return Pos >= 0 && fseeko(m_pFile, Pos, SEEK_SET) == 0;
+#else
+    for (size_t i = 0; i < NumRanges; ++i)
+    {
+        if (pRanges[i].Size > 0 && !Write(pRanges[i].pData, pRanges[i].Size))
+            return false;
+    }
+    return true;
+#endif
+}
+
 size_t StandardFile::GetSize()
 {
     VERIFY(m_pFile, "File is not opened");
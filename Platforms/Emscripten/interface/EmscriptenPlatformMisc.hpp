@@ -33,6 +33,10 @@ namespace Diligent
 {
 
 struct EmscriptenMisc : public LinuxMisc
-{};
+{
+    // Web workers can't be pinned to cores and the CPU topology is not exposed
+    using BasicPlatformMisc::GetCPUTopology;
+    using BasicPlatformMisc::SetCurrentThreadAffinity;
+};
 
 } // namespace Diligent
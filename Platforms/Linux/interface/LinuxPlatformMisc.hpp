@@ -111,6 +111,9 @@ struct LinuxMisc : public BasicPlatformMisc
     /// Sets the current thread affinity mask and on success returns the previous mask.
     /// On failure, returns 0.
     static Uint64 SetCurrentThreadAffinity(Uint64 Mask);
+
+    /// Returns the CPU topology read from sysfs. The topology is detected on the first call.
+    static const CPUTopology& GetCPUTopology();
 };
 
 } // namespace Diligent
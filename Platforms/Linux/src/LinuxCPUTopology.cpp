@@ -0,0 +1,214 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "LinuxPlatformMisc.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace Diligent
+{
+
+namespace
+{
+
+bool ReadSysFile(const std::string& Path, std::string& Value)
+{
+    std::ifstream File{Path};
+    if (!File)
+        return false;
+
+    std::getline(File, Value);
+    return !File.fail();
+}
+
+bool ReadSysFile(const std::string& Path, Uint32& Value)
+{
+    std::string Str;
+    if (!ReadSysFile(Path, Str))
+        return false;
+
+    char*               pEnd = nullptr;
+    const unsigned long Val  = strtoul(Str.c_str(), &pEnd, 10);
+    if (pEnd == Str.c_str())
+        return false;
+
+    Value = static_cast<Uint32>(Val);
+    return true;
+}
+
+// Parses the list format used by sysfs, e.g. "0-3,8,10-11"
+std::vector<Uint32> ParseCPUList(const std::string& List)
+{
+    std::vector<Uint32> Values;
+
+    const char* pCurr = List.c_str();
+    while (*pCurr != '\0')
+    {
+        char*               pEnd  = nullptr;
+        const unsigned long First = strtoul(pCurr, &pEnd, 10);
+        if (pEnd == pCurr)
+            break;
+        pCurr = pEnd;
+
+        unsigned long Last = First;
+        if (*pCurr == '-')
+        {
+            Last = strtoul(pCurr + 1, &pEnd, 10);
+            if (pEnd == pCurr + 1)
+                break;
+            pCurr = pEnd;
+        }
+
+        for (unsigned long Val = First; Val <= Last; ++Val)
+            Values.push_back(static_cast<Uint32>(Val));
+
+        if (*pCurr != ',')
+            break;
+        ++pCurr;
+    }
+
+    return Values;
+}
+
+CPUTopology DetectCPUTopology()
+{
+    CPUTopology Topology;
+
+    std::string OnlineCPUs;
+    if (!ReadSysFile("/sys/devices/system/cpu/online", OnlineCPUs))
+        return Topology;
+
+    const auto CPUs = ParseCPUList(OnlineCPUs);
+    if (CPUs.empty())
+        return Topology;
+
+    const std::string CPUDir = "/sys/devices/system/cpu/cpu";
+
+    // Physical cores are identified by the package and the core id
+    std::map<std::pair<Uint32, Uint32>, Uint32> CoreIndices;
+
+    Topology.LogicalProcessors.resize(CPUs.size());
+    for (size_t i = 0; i < CPUs.size(); ++i)
+    {
+        auto& Processor = Topology.LogicalProcessors[i];
+
+        Processor.Index = CPUs[i];
+
+        const auto TopologyDir = CPUDir + std::to_string(CPUs[i]) + "/topology/";
+
+        Uint32 PackageId = 0;
+        Uint32 CoreId    = CPUs[i];
+        ReadSysFile(TopologyDir + "physical_package_id", PackageId);
+        ReadSysFile(TopologyDir + "core_id", CoreId);
+
+        auto it = CoreIndices.emplace(std::make_pair(PackageId, CoreId), static_cast<Uint32>(CoreIndices.size())).first;
+
+        Processor.Core = it->second;
+    }
+    Topology.NumCores = static_cast<Uint32>(CoreIndices.size());
+
+    std::string OnlineNodes;
+    const auto  Nodes = ReadSysFile("/sys/devices/system/node/online", OnlineNodes) ? ParseCPUList(OnlineNodes) : std::vector<Uint32>{};
+    for (Uint32 NodeIdx = 0; NodeIdx < Nodes.size(); ++NodeIdx)
+    {
+        std::string NodeCPUs;
+        if (!ReadSysFile("/sys/devices/system/node/node" + std::to_string(Nodes[NodeIdx]) + "/cpulist", NodeCPUs))
+            continue;
+
+        for (auto CPU : ParseCPUList(NodeCPUs))
+        {
+            for (auto& Processor : Topology.LogicalProcessors)
+            {
+                if (Processor.Index == CPU)
+                    Processor.NUMANode = NodeIdx;
+            }
+        }
+    }
+    Topology.NumNUMANodes = std::max(static_cast<Uint32>(Nodes.size()), 1u);
+
+    std::string AtomCPUs;
+    if (ReadSysFile("/sys/devices/cpu_atom/cpus", AtomCPUs))
+    {
+        // Intel hybrid CPUs expose separate PMUs for the P-cores (cpu_core) and the E-cores (cpu_atom)
+        for (auto CPU : ParseCPUList(AtomCPUs))
+        {
+            for (auto& Processor : Topology.LogicalProcessors)
+            {
+                if (Processor.Index == CPU)
+                    Processor.CoreType = CPU_CORE_TYPE_EFFICIENCY;
+            }
+        }
+    }
+    else
+    {
+        // ARM heterogeneous CPUs report the relative capacity of every core.
+        // The cores with the lowest capacity are the efficiency cores.
+        std::vector<Uint32> Capacities(CPUs.size());
+        bool                HasCapacities = true;
+        for (size_t i = 0; i < CPUs.size() && HasCapacities; ++i)
+            HasCapacities = ReadSysFile(CPUDir + std::to_string(CPUs[i]) + "/cpu_capacity", Capacities[i]);
+
+        if (HasCapacities)
+        {
+            const auto MinMax = std::minmax_element(Capacities.begin(), Capacities.end());
+            if (*MinMax.first != *MinMax.second)
+            {
+                for (size_t i = 0; i < CPUs.size(); ++i)
+                {
+                    if (Capacities[i] == *MinMax.first)
+                        Topology.LogicalProcessors[i].CoreType = CPU_CORE_TYPE_EFFICIENCY;
+                }
+            }
+        }
+    }
+
+    std::sort(Topology.LogicalProcessors.begin(), Topology.LogicalProcessors.end(),
+              [](const LogicalProcessorInfo& LHS, const LogicalProcessorInfo& RHS) {
+                  return LHS.Index < RHS.Index;
+              });
+
+    return Topology;
+}
+
+} // namespace
+
+const CPUTopology& LinuxMisc::GetCPUTopology()
+{
+    static const CPUTopology Topology = []() {
+        CPUTopology Detected = DetectCPUTopology();
+        // /sys may not be accessible, e.g. in sandboxed processes
+        return !Detected.LogicalProcessors.empty() ? Detected : GetDefaultCPUTopology();
+    }();
+    return Topology;
+}
+
+} // namespace Diligent
@@ -53,6 +53,8 @@ public:
     void Write(IDataBlob* pData);
     bool Write(const void* Data, size_t BufferSize);
 
+    bool Write(const FileWriteRange* pRanges, size_t NumRanges);
+
     size_t GetSize();
 
     size_t GetPos();
@@ -194,6 +194,16 @@ bool WindowsStoreFile::Write(const void* Data, size_t BufferSize)
     return false;
 }
 
+bool WindowsStoreFile::Write(const FileWriteRange* pRanges, size_t NumRanges)
+{
+    for (size_t i = 0; i < NumRanges; ++i)
+    {
+        if (pRanges[i].Size > 0 && !Write(pRanges[i].pData, pRanges[i].Size))
+            return false;
+    }
+    return true;
+}
+
 size_t WindowsStoreFile::GetPos()
 {
     UNSUPPORTED("Not implemented");
@@ -167,6 +167,9 @@ struct WindowsMisc : public BasicPlatformMisc
     /// On failure, returns 0.
     static Uint64 SetCurrentThreadAffinity(Uint64 Mask);
 
+    /// Returns the CPU topology. The topology is detected on the first call.
+    static const CPUTopology& GetCPUTopology();
+
     static ThreadPriority GetCurrentThreadPriority();
 
     /// Sets the current thread priority and on success returns the previous priority.
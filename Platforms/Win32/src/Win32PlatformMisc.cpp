@@ -26,6 +26,9 @@
 
 #include "Win32PlatformMisc.hpp"
 
+#include <algorithm>
+#include <vector>
+
 #include "WinHPreface.h"
 #include <Windows.h>
 #include "WinHPostface.h"
@@ -35,8 +38,101 @@ namespace Diligent
 
 Uint64 WindowsMisc::SetCurrentThreadAffinity(Uint64 Mask)
 {
+#if PLATFORM_WIN32
     const auto hCurrThread = GetCurrentThread();
     return SetThreadAffinityMask(hCurrThread, static_cast<DWORD_PTR>(Mask));
+#else
+    // SetThreadAffinityMask is not available to UWP applications
+    return 0;
+#endif
+}
+
+static CPUTopology DetectCPUTopology()
+{
+    CPUTopology Topology;
+
+    DWORD BufferSize = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &BufferSize);
+    if (BufferSize == 0)
+        return Topology;
+
+    std::vector<Uint8> Buffer(BufferSize);
+    if (!GetLogicalProcessorInformationEx(RelationAll, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(Buffer.data()), &BufferSize))
+        return Topology;
+
+    // Processor index within a processor group is 64 * Group + Bit
+    auto ForEachProcessor = [](const GROUP_AFFINITY& Affinity, auto&& Handler) {
+        for (Uint32 Bit = 0; Bit < sizeof(KAFFINITY) * 8; ++Bit)
+        {
+            if (Affinity.Mask & (KAFFINITY{1} << Bit))
+                Handler(Uint32{Affinity.Group} * 64u + Bit);
+        }
+    };
+
+    // Efficiency classes are only reported by hybrid CPUs. Higher values indicate more performant cores.
+    BYTE MaxEfficiencyClass = 0;
+    for (DWORD Offset = 0; Offset < BufferSize;)
+    {
+        const auto& Info = *reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(&Buffer[Offset]);
+        if (Info.Relationship == RelationProcessorCore)
+            MaxEfficiencyClass = std::max(MaxEfficiencyClass, Info.Processor.EfficiencyClass);
+        Offset += Info.Size;
+    }
+
+    for (DWORD Offset = 0; Offset < BufferSize;)
+    {
+        const auto& Info = *reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(&Buffer[Offset]);
+        if (Info.Relationship == RelationProcessorCore)
+        {
+            const Uint32        Core     = Topology.NumCores++;
+            const CPU_CORE_TYPE CoreType = Info.Processor.EfficiencyClass < MaxEfficiencyClass ? CPU_CORE_TYPE_EFFICIENCY : CPU_CORE_TYPE_PERFORMANCE;
+            for (WORD g = 0; g < Info.Processor.GroupCount; ++g)
+            {
+                ForEachProcessor(Info.Processor.GroupMask[g], [&](Uint32 Index) {
+                    LogicalProcessorInfo Processor;
+                    Processor.Index    = Index;
+                    Processor.Core     = Core;
+                    Processor.CoreType = CoreType;
+                    Topology.LogicalProcessors.push_back(Processor);
+                });
+            }
+        }
+        Offset += Info.Size;
+    }
+
+    for (DWORD Offset = 0; Offset < BufferSize;)
+    {
+        const auto& Info = *reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(&Buffer[Offset]);
+        if (Info.Relationship == RelationNumaNode)
+        {
+            const Uint32 Node = Topology.NumNUMANodes++;
+            ForEachProcessor(Info.NumaNode.GroupMask, [&](Uint32 Index) {
+                for (auto& Processor : Topology.LogicalProcessors)
+                {
+                    if (Processor.Index == Index)
+                        Processor.NUMANode = Node;
+                }
+            });
+        }
+        Offset += Info.Size;
+    }
+    Topology.NumNUMANodes = std::max(Topology.NumNUMANodes, 1u);
+
+    std::sort(Topology.LogicalProcessors.begin(), Topology.LogicalProcessors.end(),
+              [](const LogicalProcessorInfo& LHS, const LogicalProcessorInfo& RHS) {
+                  return LHS.Index < RHS.Index;
+              });
+
+    return Topology;
+}
+
+const CPUTopology& WindowsMisc::GetCPUTopology()
+{
+    static const CPUTopology Topology = []() {
+        CPUTopology Detected = DetectCPUTopology();
+        return !Detected.LogicalProcessors.empty() ? Detected : GetDefaultCPUTopology();
+    }();
+    return Topology;
 }
 
 
@@ -34,3 +34,23 @@
 #if DILIGENT_AVX2_SUPPORTED && defined(__AVX2__)
 #    define DILIGENT_AVX2_ENABLED 1
 #endif
+
+#if DILIGENT_AVX2_SUPPORTED && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#    define DILIGENT_SSE2_ENABLED 1
+#endif
+
+// Functions marked with DILIGENT_TARGET_AVX2 may use AVX2 intrinsics even when the rest
+// of the code is not compiled with AVX2 enabled. Such functions must only be called
+// after checking CPU_FEATURE_FLAG_AVX2 with PlatformMisc::CheckCPUFeatures().
+#if DILIGENT_AVX2_SUPPORTED
+#    if defined(__clang__) || defined(__GNUC__)
+#        define DILIGENT_TARGET_AVX2 __attribute__((target("avx2")))
+#    else
+#        define DILIGENT_TARGET_AVX2
+#    endif
+#endif
+
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define DILIGENT_NEON_ENABLED 1
+#endif
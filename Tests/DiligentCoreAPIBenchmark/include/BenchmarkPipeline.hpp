@@ -0,0 +1,65 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "RenderDevice.h"
+#include "SwapChain.h"
+#include "DeviceContext.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+namespace Testing
+{
+
+/// Resources shared by the API benchmarks: a trivial procedural triangle
+/// PSO with a constant buffer bound through the SRB or as a static variable.
+struct BenchmarkPipeline
+{
+    RefCntAutoPtr<IShader>                pVS;
+    RefCntAutoPtr<IShader>                pPS;
+    RefCntAutoPtr<IPipelineState>         pPSO;
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    RefCntAutoPtr<IBuffer>                pConstants;
+
+    /// Creates the shaders, PSO, SRB and constant buffer.
+    /// Returns false if any of the objects could not be created.
+    bool Create(SHADER_RESOURCE_VARIABLE_TYPE CBVarType);
+
+    /// Fills the pipeline create info used by Create(). The shaders must
+    /// have been created, so that PSO creation may be benchmarked separately.
+    void GetCreateInfo(GraphicsPipelineStateCreateInfo& PSOCreateInfo,
+                       SHADER_RESOURCE_VARIABLE_TYPE    CBVarType);
+
+    /// Binds the swap chain back buffer as the render target.
+    static void SetRenderTargets(IDeviceContext* pContext, ISwapChain* pSwapChain);
+};
+
+} // namespace Testing
+
+} // namespace Diligent
@@ -0,0 +1,91 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <memory>
+#include <functional>
+
+#include "DeviceContext.h"
+#include "DurationQueryHelper.hpp"
+
+#include "benchmark/benchmark.h"
+
+namespace Diligent
+{
+
+namespace Testing
+{
+
+/// Measures CPU and GPU time per call for benchmarks that record the same
+/// number of commands in every iteration.
+///
+/// \remarks    Each benchmark iteration must be enclosed in BeginIteration()/EndIteration().
+///             The timer pauses the benchmark clock while it records timestamp queries,
+///             flushes the context and finishes the frame, so that only the recorded
+///             commands contribute to the CPU time.
+///             GPU time is only reported if MeasureGPUTime is true and the device supports
+///             timestamp queries.
+class GPUBenchmarkTimer
+{
+public:
+    GPUBenchmarkTimer(benchmark::State& State,
+                      IDeviceContext*   pContext,
+                      Uint32            CallsPerIteration,
+                      bool              MeasureGPUTime = true);
+
+    ~GPUBenchmarkTimer();
+
+    // clang-format off
+    GPUBenchmarkTimer           (const GPUBenchmarkTimer&) = delete;
+    GPUBenchmarkTimer& operator=(const GPUBenchmarkTimer&) = delete;
+    GPUBenchmarkTimer           (GPUBenchmarkTimer&&)      = delete;
+    GPUBenchmarkTimer& operator=(GPUBenchmarkTimer&&)      = delete;
+    // clang-format on
+
+    /// Starts a new iteration. RestoreState, if provided, is called with the clock
+    /// paused and should rebind the pipeline state and resources, which are reset
+    /// when the context is flushed at the end of the previous iteration.
+    void BeginIteration(const std::function<void()>& RestoreState = nullptr);
+    void EndIteration();
+
+private:
+    void ReadQuery();
+
+    benchmark::State& m_State;
+    IDeviceContext*   m_pContext;
+    const Uint32      m_CallsPerIteration;
+
+    std::unique_ptr<DurationQueryHelper> m_pQueryHelper;
+
+    Uint32 m_NumPendingQueries  = 0;
+    Uint64 m_NumResolvedQueries = 0;
+    double m_TotalGPUTime       = 0;
+};
+
+} // namespace Testing
+
+} // namespace Diligent
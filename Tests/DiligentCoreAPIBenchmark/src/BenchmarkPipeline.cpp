@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BenchmarkPipeline.hpp"
+
+#include "GPUTestingEnvironment.hpp"
+#include "GraphicsUtilities.h"
+
+#include "BenchmarkShadersHLSL.h"
+
+namespace Diligent
+{
+
+namespace Testing
+{
+
+void BenchmarkPipeline::GetCreateInfo(GraphicsPipelineStateCreateInfo& PSOCreateInfo,
+                                      SHADER_RESOURCE_VARIABLE_TYPE    CBVarType)
+{
+    auto* pSwapChain = GPUTestingEnvironment::GetInstance()->GetSwapChain();
+
+    auto& PSODesc          = PSOCreateInfo.PSODesc;
+    auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+    PSODesc.Name = "API benchmark PSO";
+
+    PSODesc.ResourceLayout.DefaultVariableType = CBVarType;
+
+    GraphicsPipeline.NumRenderTargets             = 1;
+    GraphicsPipeline.RTVFormats[0]                = pSwapChain->GetDesc().ColorBufferFormat;
+    GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+    GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+    PSOCreateInfo.pVS = pVS;
+    PSOCreateInfo.pPS = pPS;
+}
+
+bool BenchmarkPipeline::Create(SHADER_RESOURCE_VARIABLE_TYPE CBVarType)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+
+    ShaderCI.Desc       = {"API benchmark vertex shader", SHADER_TYPE_VERTEX, true};
+    ShaderCI.EntryPoint = "main";
+    ShaderCI.Source     = HLSL::Benchmark_VS.c_str();
+    pDevice->CreateShader(ShaderCI, &pVS);
+    if (!pVS)
+        return false;
+
+    ShaderCI.Desc       = {"API benchmark pixel shader", SHADER_TYPE_PIXEL, true};
+    ShaderCI.EntryPoint = "main";
+    ShaderCI.Source     = HLSL::Benchmark_PS.c_str();
+    pDevice->CreateShader(ShaderCI, &pPS);
+    if (!pPS)
+        return false;
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+    GetCreateInfo(PSOCreateInfo, CBVarType);
+    pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+    if (!pPSO)
+        return false;
+
+    // Use default buffer so that it does not need to be mapped every frame
+    float Offset[4] = {};
+    CreateUniformBuffer(pDevice, sizeof(Offset), "API benchmark constants", &pConstants,
+                        USAGE_DEFAULT, BIND_UNIFORM_BUFFER, CPU_ACCESS_NONE, Offset);
+    if (!pConstants)
+        return false;
+
+    if (CBVarType == SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+        pPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, "Constants")->Set(pConstants);
+
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    if (!pSRB)
+        return false;
+
+    if (CBVarType != SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+        pSRB->GetVariableByName(SHADER_TYPE_VERTEX, "Constants")->Set(pConstants);
+
+    return true;
+}
+
+void BenchmarkPipeline::SetRenderTargets(IDeviceContext* pContext, ISwapChain* pSwapChain)
+{
+    ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+    pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    const float ClearColor[] = {0.f, 0.f, 0.f, 0.f};
+    pContext->ClearRenderTarget(pRTVs[0], ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+} // namespace Testing
+
+} // namespace Diligent
@@ -0,0 +1,123 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+#include "GPUBenchmarkTimer.hpp"
+#include "MapHelper.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 NumCallsPerIteration = 64;
+
+RefCntAutoPtr<IBuffer> CreateBenchmarkBuffer(Uint64 Size, USAGE Usage, CPU_ACCESS_FLAGS CPUAccessFlags)
+{
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "API benchmark buffer";
+    BuffDesc.Size           = Size;
+    BuffDesc.Usage          = Usage;
+    BuffDesc.BindFlags      = BIND_VERTEX_BUFFER;
+    BuffDesc.CPUAccessFlags = CPUAccessFlags;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    GPUTestingEnvironment::GetInstance()->GetDevice()->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    return pBuffer;
+}
+
+// Range 0 is the update size in bytes.
+void BM_UpdateBuffer(benchmark::State& state)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    const auto UpdateSize = static_cast<Uint64>(state.range(0));
+
+    auto pBuffer = CreateBenchmarkBuffer(UpdateSize * NumCallsPerIteration, USAGE_DEFAULT, CPU_ACCESS_NONE);
+    if (!pBuffer)
+    {
+        state.SkipWithError("Failed to create benchmark buffer");
+        return;
+    }
+
+    std::vector<Uint8> Data(static_cast<size_t>(UpdateSize), 0xCD);
+
+    GPUBenchmarkTimer Timer{state, pContext, NumCallsPerIteration};
+    for (auto _ : state)
+    {
+        Timer.BeginIteration();
+        for (Uint32 i = 0; i < NumCallsPerIteration; ++i)
+            pContext->UpdateBuffer(pBuffer, UpdateSize * i, UpdateSize, Data.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        Timer.EndIteration();
+    }
+    state.SetBytesProcessed(state.iterations() * NumCallsPerIteration * state.range(0));
+}
+BENCHMARK(BM_UpdateBuffer)->Arg(256)->Arg(64 << 10)->ArgName("Size")->UseRealTime();
+
+
+// Range 0 is the map size in bytes.
+void BM_MapBuffer(benchmark::State& state)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    const auto MapSize = static_cast<size_t>(state.range(0));
+
+    auto pBuffer = CreateBenchmarkBuffer(MapSize, USAGE_DYNAMIC, CPU_ACCESS_WRITE);
+    if (!pBuffer)
+    {
+        state.SkipWithError("Failed to create benchmark buffer");
+        return;
+    }
+
+    // Mapping does not record any GPU commands
+    GPUBenchmarkTimer Timer{state, pContext, NumCallsPerIteration, /*MeasureGPUTime = */ false};
+    for (auto _ : state)
+    {
+        Timer.BeginIteration();
+        for (Uint32 i = 0; i < NumCallsPerIteration; ++i)
+        {
+            MapHelper<Uint8> pData{pContext, pBuffer, MAP_WRITE, MAP_FLAG_DISCARD};
+            std::memset(pData, static_cast<int>(i), MapSize);
+        }
+        Timer.EndIteration();
+    }
+    state.SetBytesProcessed(state.iterations() * NumCallsPerIteration * state.range(0));
+}
+BENCHMARK(BM_MapBuffer)->Arg(256)->Arg(64 << 10)->ArgName("Size")->UseRealTime();
+
+} // namespace
@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GPUTestingEnvironment.hpp"
+#include "GPUBenchmarkTimer.hpp"
+#include "BenchmarkPipeline.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 NumCallsPerIteration = 256;
+
+void BM_Draw(benchmark::State& state)
+{
+    auto* pEnv       = GPUTestingEnvironment::GetInstance();
+    auto* pContext   = pEnv->GetDeviceContext();
+    auto* pSwapChain = pEnv->GetSwapChain();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    BenchmarkPipeline Pipeline;
+    if (!Pipeline.Create(SHADER_RESOURCE_VARIABLE_TYPE_STATIC))
+    {
+        state.SkipWithError("Failed to create benchmark pipeline");
+        return;
+    }
+
+    BenchmarkPipeline::SetRenderTargets(pContext, pSwapChain);
+
+    const auto RestoreState = [&]() {
+        pContext->SetPipelineState(Pipeline.pPSO);
+        pContext->CommitShaderResources(Pipeline.pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    };
+
+    const DrawAttribs DrawAttrs{3, static_cast<DRAW_FLAGS>(state.range(0))};
+
+    GPUBenchmarkTimer Timer{state, pContext, NumCallsPerIteration};
+    for (auto _ : state)
+    {
+        Timer.BeginIteration(RestoreState);
+        for (Uint32 i = 0; i < NumCallsPerIteration; ++i)
+            pContext->Draw(DrawAttrs);
+        Timer.EndIteration();
+    }
+}
+BENCHMARK(BM_Draw)->Arg(DRAW_FLAG_NONE)->Arg(DRAW_FLAG_VERIFY_ALL)->ArgName("Flags")->UseRealTime();
+
+
+// Range 0 is the shader resource variable type, range 1 is the state transition mode.
+// Every commit is followed by a draw so that the backend cannot skip redundant bindings.
+void BM_CommitShaderResources(benchmark::State& state)
+{
+    auto* pEnv       = GPUTestingEnvironment::GetInstance();
+    auto* pContext   = pEnv->GetDeviceContext();
+    auto* pSwapChain = pEnv->GetSwapChain();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    BenchmarkPipeline Pipeline;
+    if (!Pipeline.Create(static_cast<SHADER_RESOURCE_VARIABLE_TYPE>(state.range(0))))
+    {
+        state.SkipWithError("Failed to create benchmark pipeline");
+        return;
+    }
+
+    BenchmarkPipeline::SetRenderTargets(pContext, pSwapChain);
+
+    const auto RestoreState = [&]() {
+        pContext->SetPipelineState(Pipeline.pPSO);
+        // Transition the resources so that RESOURCE_STATE_TRANSITION_MODE_VERIFY does not fail
+        pContext->CommitShaderResources(Pipeline.pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    };
+
+    const auto TransitionMode = static_cast<RESOURCE_STATE_TRANSITION_MODE>(state.range(1));
+
+    GPUBenchmarkTimer Timer{state, pContext, NumCallsPerIteration};
+    for (auto _ : state)
+    {
+        Timer.BeginIteration(RestoreState);
+        for (Uint32 i = 0; i < NumCallsPerIteration; ++i)
+        {
+            pContext->CommitShaderResources(Pipeline.pSRB, TransitionMode);
+            pContext->Draw(DrawAttribs{3, DRAW_FLAG_NONE});
+        }
+        Timer.EndIteration();
+    }
+}
+BENCHMARK(BM_CommitShaderResources)
+    ->ArgsProduct({{SHADER_RESOURCE_VARIABLE_TYPE_STATIC, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+                   {RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_VERIFY}})
+    ->ArgNames({"VarType", "TransitionMode"})
+    ->UseRealTime();
+
+} // namespace
@@ -0,0 +1,123 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GPUBenchmarkTimer.hpp"
+
+#include "GPUTestingEnvironment.hpp"
+
+namespace Diligent
+{
+
+namespace Testing
+{
+
+GPUBenchmarkTimer::GPUBenchmarkTimer(benchmark::State& State,
+                                     IDeviceContext*   pContext,
+                                     Uint32            CallsPerIteration,
+                                     bool              MeasureGPUTime) :
+    m_State{State},
+    m_pContext{pContext},
+    m_CallsPerIteration{CallsPerIteration}
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+    if (MeasureGPUTime && pDevice->GetDeviceInfo().Features.TimestampQueries)
+    {
+        // GPU typically lags a few frames behind, so reserve enough queries
+        // to not create new ones in the middle of the benchmark.
+        m_pQueryHelper = std::make_unique<DurationQueryHelper>(pDevice, 8, 8);
+    }
+}
+
+void GPUBenchmarkTimer::BeginIteration(const std::function<void()>& RestoreState)
+{
+    if (!RestoreState && !m_pQueryHelper)
+        return;
+
+    m_State.PauseTiming();
+    if (RestoreState)
+        RestoreState();
+    if (m_pQueryHelper)
+        m_pQueryHelper->Begin(m_pContext);
+    m_State.ResumeTiming();
+}
+
+void GPUBenchmarkTimer::ReadQuery()
+{
+    VERIFY_EXPR(m_pQueryHelper && m_NumPendingQueries > 0);
+
+    double Duration = 0;
+    if (m_pQueryHelper->End(m_pContext, Duration))
+    {
+        m_TotalGPUTime += Duration;
+        ++m_NumResolvedQueries;
+        --m_NumPendingQueries;
+    }
+}
+
+void GPUBenchmarkTimer::EndIteration()
+{
+    m_State.PauseTiming();
+    if (m_pQueryHelper)
+    {
+        ++m_NumPendingQueries;
+        ReadQuery();
+    }
+    m_pContext->Flush();
+    m_pContext->FinishFrame();
+    m_State.ResumeTiming();
+}
+
+GPUBenchmarkTimer::~GPUBenchmarkTimer()
+{
+    m_pContext->WaitForIdle();
+
+    if (m_pQueryHelper)
+    {
+        // Every End() returns the oldest pending query, so once the GPU is idle,
+        // a matching number of empty Begin()/End() pairs drains all results.
+        for (Uint32 i = m_NumPendingQueries; i > 0; --i)
+        {
+            m_pQueryHelper->Begin(m_pContext);
+            ++m_NumPendingQueries;
+            ReadQuery();
+        }
+        m_pContext->Flush();
+        m_pContext->WaitForIdle();
+    }
+
+    const auto NumCalls = static_cast<double>(m_State.iterations()) * m_CallsPerIteration;
+
+    m_State.SetItemsProcessed(static_cast<int64_t>(NumCalls));
+    m_State.counters["CPUTimePerCall"] = benchmark::Counter{NumCalls, benchmark::Counter::kIsRate | benchmark::Counter::kInvert};
+    if (m_NumResolvedQueries > 0)
+    {
+        m_State.counters["GPUTimePerCall"] = m_TotalGPUTime / (static_cast<double>(m_NumResolvedQueries) * m_CallsPerIteration);
+    }
+}
+
+} // namespace Testing
+
+} // namespace Diligent
@@ -0,0 +1,78 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GPUTestingEnvironment.hpp"
+#include "BenchmarkPipeline.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Measures the time to create a graphics pipeline from already compiled shaders.
+// Range 0 is the shader resource variable type.
+void BM_CreateGraphicsPipelineState(benchmark::State& state)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    const auto VarType = static_cast<SHADER_RESOURCE_VARIABLE_TYPE>(state.range(0));
+
+    BenchmarkPipeline Pipeline;
+    if (!Pipeline.Create(VarType))
+    {
+        state.SkipWithError("Failed to create benchmark pipeline");
+        return;
+    }
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+    Pipeline.GetCreateInfo(PSOCreateInfo, VarType);
+
+    for (auto _ : state)
+    {
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        if (!pPSO)
+        {
+            state.SkipWithError("Failed to create PSO");
+            break;
+        }
+        benchmark::DoNotOptimize(pPSO.RawPtr());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CreateGraphicsPipelineState)
+    ->Arg(SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+    ->Arg(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+    ->ArgName("VarType")
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
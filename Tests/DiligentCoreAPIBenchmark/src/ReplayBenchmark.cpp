@@ -0,0 +1,113 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ReplayBenchmark.hpp"
+
+#include "GPUTestingEnvironment.hpp"
+#include "CommandStreamCapture.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Replays all frames of the command stream in every iteration and reports
+// the CPU time per call of every call type as the <Call>TimePerCall counters.
+void BM_ReplayCommandStream(benchmark::State& state, const std::string& FilePath)
+{
+    auto* pEnv       = GPUTestingEnvironment::GetInstance();
+    auto* pContext   = pEnv->GetDeviceContext();
+    auto* pSwapChain = pEnv->GetSwapChain();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    CommandStreamPlayer::CreateInfo PlayerCI;
+    PlayerCI.pDevice      = pEnv->GetDevice();
+    PlayerCI.pContext     = pContext;
+    PlayerCI.pExternalRTV = pSwapChain != nullptr ? pSwapChain->GetCurrentBackBufferRTV() : nullptr;
+    PlayerCI.pExternalDSV = pSwapChain != nullptr ? pSwapChain->GetDepthBufferDSV() : nullptr;
+    CommandStreamPlayer Player{PlayerCI};
+    if (!Player.LoadFromFile(FilePath.c_str()))
+    {
+        state.SkipWithError("Failed to load the command stream");
+        return;
+    }
+
+    CommandStreamPlayer::Stats Stats;
+    for (auto _ : state)
+    {
+        if (!Player.Replay(&Stats))
+        {
+            state.SkipWithError("Failed to replay the command stream");
+            break;
+        }
+
+        // Submit the commands of the stream that does not finish its last frame
+        state.PauseTiming();
+        pContext->Flush();
+        pContext->FinishFrame();
+        state.ResumeTiming();
+    }
+    pContext->WaitForIdle();
+
+    for (Uint32 Call = 0; Call < COMMAND_STREAM_CALL_COUNT; ++Call)
+    {
+        const auto& CallStats = Stats.Calls[Call];
+        if (CallStats.NumCalls == 0)
+            continue;
+
+        const std::string Name = GetCommandStreamCallName(static_cast<COMMAND_STREAM_CALL>(Call));
+
+        state.counters[Name + "TimePerCall"] = CallStats.Time / CallStats.NumCalls;
+        state.counters[Name + "Calls"]       = benchmark::Counter{static_cast<double>(CallStats.NumCalls), benchmark::Counter::kAvgIterations};
+    }
+    state.counters["Frames"] = benchmark::Counter{static_cast<double>(Stats.NumFrames), benchmark::Counter::kAvgIterations};
+}
+
+} // namespace
+
+namespace Diligent
+{
+
+namespace Testing
+{
+
+void RegisterReplayBenchmarks(const std::vector<std::string>& CaptureFiles)
+{
+    for (const auto& FilePath : CaptureFiles)
+    {
+        benchmark::RegisterBenchmark(("BM_ReplayCommandStream/" + FilePath).c_str(), BM_ReplayCommandStream, FilePath)
+            ->UseRealTime();
+    }
+}
+
+} // namespace Testing
+
+} // namespace Diligent
@@ -0,0 +1,68 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+#include "ReplayBenchmark.hpp"
+
+#include "benchmark/benchmark.h"
+
+int main(int argc, char** argv)
+{
+    // Remove the benchmark flags first. The remaining arguments (e.g. --mode=vk)
+    // are parsed by the testing environment, exactly as in the API tests.
+    benchmark::Initialize(&argc, argv);
+
+    auto* pEnv = Diligent::Testing::GPUTestingEnvironment::Initialize(argc, argv);
+    if (pEnv == nullptr)
+        return -1;
+
+    benchmark::AddCustomContext("device", Diligent::GetRenderDeviceTypeString(pEnv->GetDevice()->GetDeviceInfo().Type));
+    benchmark::AddCustomContext("adapter", pEnv->GetDevice()->GetAdapterInfo().Description);
+
+    // Every --capture=<path> argument adds a benchmark that replays the command stream
+    // recorded by CommandStreamRecorder. Use --benchmark_out and Google Benchmark's
+    // compare.py to compare the results of two runs.
+    std::vector<std::string> CaptureFiles;
+    for (int i = 1; i < argc; ++i)
+    {
+        static constexpr char CaptureArg[] = "--capture=";
+        if (std::strncmp(argv[i], CaptureArg, sizeof(CaptureArg) - 1) == 0)
+            CaptureFiles.emplace_back(argv[i] + sizeof(CaptureArg) - 1);
+    }
+    Diligent::Testing::RegisterReplayBenchmarks(CaptureFiles);
+
+    benchmark::RunSpecifiedBenchmarks();
+
+    delete pEnv;
+
+    std::cout << "\n\n\n";
+    return 0;
+}
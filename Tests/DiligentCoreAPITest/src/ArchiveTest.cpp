@@ -26,6 +26,7 @@
 
 #include <array>
 #include <unordered_set>
+#include <cstring>
 
 #include "GPUTestingEnvironment.hpp"
 #include "TestingSwapChainBase.hpp"
@@ -35,6 +36,7 @@
 #include "SerializedPipelineState.h"
 #include "SerializedShader.h"
 #include "ShaderMacroHelper.hpp"
+#include "ThreadPool.hpp"
 
 #include "ResourceLayoutTestCommon.hpp"
 #include "gtest/gtest.h"
@@ -1274,7 +1276,7 @@ void CreateComputeShader(IRenderDevice*        pDevice,
     }
 }
 
-void TestComputePipeline(PSO_ARCHIVE_FLAGS ArchiveFlags)
+void TestComputePipeline(PSO_ARCHIVE_FLAGS ArchiveFlags, PSO_CREATE_FLAGS UnpackFlags = PSO_CREATE_FLAG_NONE)
 {
     auto* pEnv             = GPUTestingEnvironment::GetInstance();
     auto* pDevice          = pEnv->GetDevice();
@@ -1407,9 +1409,66 @@ void TestComputePipeline(PSO_ARCHIVE_FLAGS ArchiveFlags)
         UnpackInfo.Name         = PSO1Name;
         UnpackInfo.pDevice      = pDevice;
         UnpackInfo.PipelineType = PIPELINE_TYPE_COMPUTE;
+        UnpackInfo.Flags        = UnpackFlags;
 
         pDearchiver->UnpackPipelineState(UnpackInfo, &pUnpackedPSO);
         ASSERT_NE(pUnpackedPSO, nullptr);
+        ASSERT_EQ(pUnpackedPSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+
+        // The PSO is taken from the cache
+        RefCntAutoPtr<IPipelineState> pUnpackedPSO2;
+        pDearchiver->UnpackPipelineState(UnpackInfo, &pUnpackedPSO2);
+        EXPECT_EQ(pUnpackedPSO, pUnpackedPSO2);
+    }
+
+    // Prefetch the PSO into another dearchiver using the usage manifest
+    {
+        RefCntAutoPtr<IDataBlob> pManifest;
+        ASSERT_TRUE(pDearchiver->StoreUsageManifest(&pManifest));
+        ASSERT_NE(pManifest, nullptr);
+
+        RefCntAutoPtr<IDataBlob> pMergedArchive;
+        ASSERT_TRUE(pDearchiver->Store(&pMergedArchive));
+
+        RefCntAutoPtr<IDearchiver> pPrefetchDearchiver;
+        pDevice->GetEngineFactory()->CreateDearchiver(DearchiverCI, &pPrefetchDearchiver);
+        ASSERT_NE(pPrefetchDearchiver, nullptr);
+        ASSERT_TRUE(pPrefetchDearchiver->LoadArchive(pMergedArchive));
+
+        auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+        ASSERT_NE(pThreadPool, nullptr);
+
+        DearchiverPrefetchInfo PrefetchInfo;
+        PrefetchInfo.pDevice     = pDevice;
+        PrefetchInfo.pManifest   = pManifest;
+        PrefetchInfo.pThreadPool = pThreadPool;
+        PrefetchInfo.PSOFlags    = UnpackFlags;
+        ASSERT_TRUE(pPrefetchDearchiver->Prefetch(PrefetchInfo));
+        pThreadPool->WaitForAllTasks();
+
+        // Signatures unpacked by the PSO are not recorded
+        const auto Progress = pPrefetchDearchiver->GetPrefetchProgress();
+        EXPECT_EQ(Progress.NumResources, 1u);
+        EXPECT_EQ(Progress.NumUnpacked, 1u);
+        EXPECT_EQ(Progress.NumFailed, 0u);
+
+        PipelineStateUnpackInfo UnpackInfo;
+        UnpackInfo.Name         = PSO1Name;
+        UnpackInfo.pDevice      = pDevice;
+        UnpackInfo.PipelineType = PIPELINE_TYPE_COMPUTE;
+
+        RefCntAutoPtr<IPipelineState> pPrefetchedPSO;
+        pPrefetchDearchiver->UnpackPipelineState(UnpackInfo, &pPrefetchedPSO);
+        ASSERT_NE(pPrefetchedPSO, nullptr);
+        EXPECT_EQ(pPrefetchedPSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+
+        pPrefetchDearchiver->Reset();
+        EXPECT_EQ(pPrefetchDearchiver->GetPrefetchProgress().NumResources, 0u);
+
+        // Invalid manifest is rejected
+        PrefetchInfo.pManifest = pMergedArchive;
+        GPUTestingEnvironment::SetErrorAllowance(1);
+        EXPECT_FALSE(pPrefetchDearchiver->Prefetch(PrefetchInfo));
     }
 
     RefCntAutoPtr<IShaderResourceBinding> pSRB;
@@ -1468,6 +1527,82 @@ TEST(ArchiveTest, ComputePipeline_NoReflection_SplitArchive)
     TestComputePipeline(PSO_ARCHIVE_FLAG_STRIP_REFLECTION | PSO_ARCHIVE_FLAG_DO_NOT_PACK_SIGNATURES);
 }
 
+TEST(ArchiveTest, ComputePipeline_AsyncUnpack)
+{
+    TestComputePipeline(PSO_ARCHIVE_FLAG_NONE, PSO_CREATE_FLAG_ASYNCHRONOUS);
+}
+
+TEST(ArchiveTest, ParallelCompilation)
+{
+    auto* pEnv             = GPUTestingEnvironment::GetInstance();
+    auto* pDevice          = pEnv->GetDevice();
+    auto* pArchiverFactory = pEnv->GetArchiverFactory();
+    if (!pArchiverFactory)
+        GTEST_SKIP() << "Archiver library is not loaded";
+
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+        GTEST_SKIP() << "Compute shaders are not supported by device";
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    constexpr Uint32 NumPSOs = 4;
+
+    auto CreateArchive = [&](Uint32 NumThreads, bool ReverseOrder, IDataBlob** ppArchive) {
+        SerializationDeviceCreateInfo SerDeviceCI;
+        SerDeviceCI.DeviceInfo.Features.SeparablePrograms = pDevice->GetDeviceInfo().Features.SeparablePrograms;
+        SerDeviceCI.NumCompilationThreads                 = NumThreads;
+        RefCntAutoPtr<ISerializationDevice> pSerializationDevice;
+        pArchiverFactory->CreateSerializationDevice(SerDeviceCI, &pSerializationDevice);
+        ASSERT_NE(pSerializationDevice, nullptr);
+
+        RefCntAutoPtr<IArchiver> pArchiver;
+        pArchiverFactory->CreateArchiver(pSerializationDevice, &pArchiver);
+        ASSERT_NE(pArchiver, nullptr);
+
+        ShaderCreateInfo       ShaderCI;
+        RefCntAutoPtr<IShader> pSerializedCS;
+        CreateComputeShader(pDevice, pSerializationDevice, ShaderCI, nullptr, &pSerializedCS);
+        ASSERT_NE(pSerializedCS, nullptr);
+        EXPECT_TRUE(pArchiver->AddShader(pSerializedCS));
+
+        for (Uint32 i = 0; i < NumPSOs; ++i)
+        {
+            const auto PSOName = std::string{"ArchiveTest.ParallelCompilation - PSO "} + std::to_string(ReverseOrder ? NumPSOs - 1 - i : i);
+
+            // No signatures are provided, so the default signature is created for every device type
+            ComputePipelineStateCreateInfo PSOCreateInfo;
+            PSOCreateInfo.PSODesc.Name         = PSOName.c_str();
+            PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+            PSOCreateInfo.pCS                  = pSerializedCS;
+
+            PipelineStateArchiveInfo ArchiveInfo;
+            ArchiveInfo.DeviceFlags = GetDeviceBits();
+#if PLATFORM_MACOS
+            // Compute shaders are not supported in OpenGL on MacOS
+            ArchiveInfo.DeviceFlags &= ~(ARCHIVE_DEVICE_DATA_FLAG_GL | ARCHIVE_DEVICE_DATA_FLAG_GLES);
+#endif
+            RefCntAutoPtr<IPipelineState> pSerializedPSO;
+            pSerializationDevice->CreateComputePipelineState(PSOCreateInfo, ArchiveInfo, &pSerializedPSO);
+            ASSERT_NE(pSerializedPSO, nullptr);
+            EXPECT_TRUE(pArchiver->AddPipelineState(pSerializedPSO));
+        }
+
+        pArchiver->SerializeToBlob(ppArchive);
+    };
+
+    RefCntAutoPtr<IDataBlob> pSerialArchive;
+    CreateArchive(0, false, &pSerialArchive);
+    ASSERT_NE(pSerialArchive, nullptr);
+
+    RefCntAutoPtr<IDataBlob> pParallelArchive;
+    CreateArchive(4, true, &pParallelArchive);
+    ASSERT_NE(pParallelArchive, nullptr);
+
+    // The archive must not depend on the number of threads or the order in which objects are added
+    ASSERT_EQ(pSerialArchive->GetSize(), pParallelArchive->GetSize());
+    EXPECT_EQ(memcmp(pSerialArchive->GetConstDataPtr(), pParallelArchive->GetConstDataPtr(), pSerialArchive->GetSize()), 0);
+}
+
 TEST(ArchiveTest, RayTracingPipeline)
 {
     auto* pEnv             = GPUTestingEnvironment::GetInstance();
@@ -0,0 +1,459 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* VSSource = R"(
+float4 main() : SV_Position
+{
+    return float4(0.0, 0.0, 0.0, 0.0);
+}
+)";
+
+static const char* PSSource = R"(
+Texture2D<float4> g_Tex;
+SamplerState      g_Tex_sampler;
+float4 main() : SV_Target
+{
+    return g_Tex.Sample(g_Tex_sampler, float2(0.0, 0.0));
+}
+)";
+
+static const char* CSSource = R"(
+RWTexture2D<float4> g_RWTex;
+[numthreads(1, 1, 1)]
+void main()
+{
+    g_RWTex[int2(0, 0)] = float4(0.0, 0.0, 0.0, 0.0);
+}
+)";
+
+RefCntAutoPtr<IShader> CreateShader(GPUTestingEnvironment* pEnv, const char* Name, SHADER_TYPE ShaderType, const char* Source)
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.Desc           = {Name, ShaderType, true};
+    ShaderCI.EntryPoint     = "main";
+    ShaderCI.Source         = Source;
+
+    RefCntAutoPtr<IShader> pShader;
+    pEnv->GetDevice()->CreateShader(ShaderCI, &pShader);
+    return pShader;
+}
+
+// Creates a pixel shader that has not been compiled before, so that
+// the pipeline is not found in the driver's internal cache.
+RefCntAutoPtr<IShader> CreateUniquePixelShader(GPUTestingEnvironment* pEnv)
+{
+    static const Uint32 RunId = std::random_device{}() % 65536;
+    static Uint32       Counter{0};
+
+    std::stringstream SourceSS;
+    SourceSS << "float4 main() : SV_Target\n"
+             << "{\n"
+             << "    return float4(" << RunId << ".0, " << Counter++ << ".0, 0.0, 1.0);\n"
+             << "}\n";
+    const auto Source = SourceSS.str();
+    return CreateShader(pEnv, "Async PSO creation test unique PS", SHADER_TYPE_PIXEL, Source.c_str());
+}
+
+RefCntAutoPtr<IPipelineState> CreateCacheMissTestPSO(IRenderDevice*       pDevice,
+                                                     IShader*             pVS,
+                                                     IShader*             pPS,
+                                                     PSO_CREATE_FLAGS     Flags,
+                                                     IPipelineStateCache* pCache = nullptr)
+{
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name                      = "Async on cache miss PSO creation test";
+    PSOCreateInfo.Flags                             = Flags;
+    PSOCreateInfo.GraphicsPipeline.NumRenderTargets = 1;
+    PSOCreateInfo.GraphicsPipeline.RTVFormats[0]    = TEX_FORMAT_RGBA8_UNORM;
+    PSOCreateInfo.pVS                               = pVS;
+    PSOCreateInfo.pPS                               = pPS;
+    PSOCreateInfo.pPSOCache                         = pCache;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+    return pPSO;
+}
+
+RefCntAutoPtr<IPipelineStateCache> CreatePSOCache(IRenderDevice* pDevice, const IDataBlob* pData = nullptr)
+{
+    PipelineStateCacheCreateInfo PSOCacheCI;
+    PSOCacheCI.Desc.Name = "Async on cache miss PSO creation test cache";
+    if (pData != nullptr)
+    {
+        PSOCacheCI.pCacheData    = pData->GetConstDataPtr();
+        PSOCacheCI.CacheDataSize = static_cast<Uint32>(pData->GetSize());
+    }
+
+    RefCntAutoPtr<IPipelineStateCache> pCache;
+    pDevice->CreatePipelineStateCache(PSOCacheCI, &pCache);
+    return pCache;
+}
+
+TEST(AsyncPSOCreation, GraphicsPipelines)
+{
+    auto* const pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* const pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr size_t NumPSOs = 32;
+
+    std::array<RefCntAutoPtr<IPipelineState>, NumPSOs> PSOs;
+    {
+        auto pVS = CreateShader(pEnv, "Async PSO creation test VS", SHADER_TYPE_VERTEX, VSSource);
+        auto pPS = CreateShader(pEnv, "Async PSO creation test PS", SHADER_TYPE_PIXEL, PSSource);
+        ASSERT_TRUE(pVS && pPS);
+
+        for (size_t i = 0; i < NumPSOs; ++i)
+        {
+            // All data referenced by the create info goes out of scope before
+            // the pipelines are initialized.
+            const std::string Name = "Async PSO creation test " + std::to_string(i);
+
+            const ShaderResourceVariableDesc Vars[] =
+                {
+                    {SHADER_TYPE_PIXEL, "g_Tex", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+                };
+            const ImmutableSamplerDesc ImtblSamplers[] =
+                {
+                    {SHADER_TYPE_PIXEL, "g_Tex", SamplerDesc{}},
+                };
+
+            GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+            auto& PSODesc          = PSOCreateInfo.PSODesc;
+            auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+            PSODesc.Name                                  = Name.c_str();
+            PSODesc.ResourceLayout.Variables              = Vars;
+            PSODesc.ResourceLayout.NumVariables           = _countof(Vars);
+            PSODesc.ResourceLayout.ImmutableSamplers      = ImtblSamplers;
+            PSODesc.ResourceLayout.NumImmutableSamplers   = _countof(ImtblSamplers);
+            PSOCreateInfo.Flags                           = PSO_CREATE_FLAG_ASYNCHRONOUS;
+            GraphicsPipeline.NumRenderTargets             = 1;
+            GraphicsPipeline.RTVFormats[0]                = (i % 2 == 0) ? TEX_FORMAT_RGBA8_UNORM : TEX_FORMAT_RGBA16_FLOAT;
+            GraphicsPipeline.DepthStencilDesc.DepthEnable = (i % 4) < 2;
+            GraphicsPipeline.DSVFormat                    = TEX_FORMAT_D32_FLOAT;
+
+            PSOCreateInfo.pVS = pVS;
+            PSOCreateInfo.pPS = pPS;
+
+            pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &PSOs[i]);
+            ASSERT_TRUE(PSOs[i]);
+        }
+    }
+
+    for (auto& pPSO : PSOs)
+    {
+        ASSERT_EQ(pPSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+        EXPECT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_READY);
+
+        const auto& ResLayout = pPSO->GetDesc().ResourceLayout;
+        ASSERT_EQ(ResLayout.NumVariables, 1u);
+        EXPECT_STREQ(ResLayout.Variables[0].Name, "g_Tex");
+        ASSERT_EQ(ResLayout.NumImmutableSamplers, 1u);
+        EXPECT_STREQ(ResLayout.ImmutableSamplers[0].SamplerOrTextureName, "g_Tex");
+
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        pPSO->CreateShaderResourceBinding(&pSRB);
+        ASSERT_TRUE(pSRB);
+        EXPECT_NE(pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex"), nullptr);
+    }
+}
+
+TEST(AsyncPSOCreation, ComputePipelines)
+{
+    auto* const pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* const pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr size_t NumPSOs = 16;
+
+    std::vector<RefCntAutoPtr<IPipelineState>> PSOs(NumPSOs);
+    {
+        auto pCS = CreateShader(pEnv, "Async PSO creation test CS", SHADER_TYPE_COMPUTE, CSSource);
+        ASSERT_TRUE(pCS);
+
+        for (size_t i = 0; i < NumPSOs; ++i)
+        {
+            const std::string Name = "Async compute PSO creation test " + std::to_string(i);
+
+            ComputePipelineStateCreateInfo PSOCreateInfo;
+            PSOCreateInfo.PSODesc.Name = Name.c_str();
+            PSOCreateInfo.Flags        = PSO_CREATE_FLAG_ASYNCHRONOUS;
+            PSOCreateInfo.pCS          = pCS;
+
+            pDevice->CreateComputePipelineState(PSOCreateInfo, &PSOs[i]);
+            ASSERT_TRUE(PSOs[i]);
+        }
+    }
+
+    for (auto& pPSO : PSOs)
+    {
+        ASSERT_EQ(pPSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        pPSO->CreateShaderResourceBinding(&pSRB);
+        EXPECT_TRUE(pSRB);
+    }
+}
+
+TEST(AsyncPSOCreation, ReleaseBeforeReady)
+{
+    auto* const pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* const pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pVS = CreateShader(pEnv, "Async PSO creation test VS", SHADER_TYPE_VERTEX, VSSource);
+    auto pPS = CreateShader(pEnv, "Async PSO creation test PS", SHADER_TYPE_PIXEL, PSSource);
+    ASSERT_TRUE(pVS && pPS);
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name                      = "Async PSO release test";
+    PSOCreateInfo.Flags                             = PSO_CREATE_FLAG_ASYNCHRONOUS;
+    PSOCreateInfo.GraphicsPipeline.NumRenderTargets = 1;
+    PSOCreateInfo.GraphicsPipeline.RTVFormats[0]    = TEX_FORMAT_RGBA8_UNORM;
+    PSOCreateInfo.pVS                               = pVS;
+    PSOCreateInfo.pPS                               = pPS;
+
+    // Pipelines that are released while being initialized must wait
+    // for the initialization task or remove it from the thread pool.
+    for (size_t i = 0; i < 32; ++i)
+    {
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        ASSERT_TRUE(pPSO);
+        const auto Status = pPSO->GetStatus();
+        EXPECT_TRUE(Status == PIPELINE_STATE_STATUS_COMPILING || Status == PIPELINE_STATE_STATUS_READY);
+    }
+}
+
+TEST(AsyncPSOCreation, AsyncOnCacheMiss)
+{
+    auto* const pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* const pDevice = pEnv->GetDevice();
+
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    if (DeviceInfo.Type != RENDER_DEVICE_TYPE_D3D12 && !DeviceInfo.IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Pipelines are only compiled asynchronously on cache miss in Direct3D12 and Vulkan";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pVS = CreateShader(pEnv, "Async PSO creation test VS", SHADER_TYPE_VERTEX, VSSource);
+    ASSERT_TRUE(pVS);
+
+    auto pCache = CreatePSOCache(pDevice);
+
+    constexpr size_t NumPSOs = 16;
+
+    std::vector<RefCntAutoPtr<IShader>> PixelShaders(NumPSOs);
+    for (auto& pPS : PixelShaders)
+    {
+        pPS = CreateUniquePixelShader(pEnv);
+        ASSERT_TRUE(pPS);
+    }
+
+    // The pipelines are not in the cache, so they must be compiled by the thread pool.
+    // A pipeline may be ready by the time its status is checked if a worker thread has picked it
+    // up immediately, but the pool can't keep up with all of them.
+    std::vector<RefCntAutoPtr<IPipelineState>> PSOs(NumPSOs);
+    size_t                                     NumCompiling = 0;
+    for (size_t i = 0; i < NumPSOs; ++i)
+    {
+        PSOs[i] = CreateCacheMissTestPSO(pDevice, pVS, PixelShaders[i], PSO_CREATE_FLAG_ASYNCHRONOUS_ON_CACHE_MISS, pCache);
+        ASSERT_TRUE(PSOs[i]);
+
+        const auto Status = PSOs[i]->GetStatus();
+        if (Status == PIPELINE_STATE_STATUS_COMPILING)
+        {
+            ++NumCompiling;
+        }
+        else
+        {
+            EXPECT_EQ(Status, PIPELINE_STATE_STATUS_READY);
+        }
+    }
+    EXPECT_GT(NumCompiling, size_t{0});
+
+    for (auto& pPSO : PSOs)
+    {
+        while (pPSO->GetStatus() == PIPELINE_STATE_STATUS_COMPILING)
+            std::this_thread::yield();
+        EXPECT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_READY);
+    }
+}
+
+TEST(AsyncPSOCreation, AsyncOnCacheMiss_WaitForCompletion)
+{
+    auto* const pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* const pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pVS = CreateShader(pEnv, "Async PSO creation test VS", SHADER_TYPE_VERTEX, VSSource);
+    auto pPS = CreateUniquePixelShader(pEnv);
+    ASSERT_TRUE(pVS && pPS);
+
+    auto pPSO = CreateCacheMissTestPSO(pDevice, pVS, pPS, PSO_CREATE_FLAG_ASYNCHRONOUS_ON_CACHE_MISS);
+    ASSERT_TRUE(pPSO);
+
+    // Waits until the compilation is finished
+    EXPECT_EQ(pPSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+    EXPECT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_READY);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB);
+    EXPECT_TRUE(pSRB);
+}
+
+TEST(AsyncPSOCreation, AsyncOnCacheMiss_SeededCache)
+{
+    auto* const pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* const pDevice = pEnv->GetDevice();
+
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    if (DeviceInfo.Type != RENDER_DEVICE_TYPE_D3D12 && !DeviceInfo.IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Pipeline caches are only probed in Direct3D12 and Vulkan";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pVS = CreateShader(pEnv, "Async PSO creation test VS", SHADER_TYPE_VERTEX, VSSource);
+    auto pPS = CreateUniquePixelShader(pEnv);
+    ASSERT_TRUE(pVS && pPS);
+
+    RefCntAutoPtr<IDataBlob> pCacheData;
+    {
+        auto pCache = CreatePSOCache(pDevice);
+        ASSERT_TRUE(pCache);
+
+        auto pPSO = CreateCacheMissTestPSO(pDevice, pVS, pPS, PSO_CREATE_FLAG_ASYNCHRONOUS_ON_CACHE_MISS, pCache);
+        ASSERT_TRUE(pPSO);
+        ASSERT_EQ(pPSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+
+        pCache->GetData(&pCacheData);
+        ASSERT_TRUE(pCacheData);
+    }
+
+    auto pSeededCache = CreatePSOCache(pDevice, pCacheData);
+    ASSERT_TRUE(pSeededCache);
+
+    auto pPSO = CreateCacheMissTestPSO(pDevice, pVS, pPS, PSO_CREATE_FLAG_ASYNCHRONOUS_ON_CACHE_MISS, pSeededCache);
+    ASSERT_TRUE(pPSO);
+
+    const auto Status = pPSO->GetStatus();
+    if (DeviceInfo.IsVulkanDevice() && Status != PIPELINE_STATE_STATUS_READY)
+    {
+        // Vulkan can only probe the cache with VK_EXT_pipeline_creation_cache_control,
+        // and the driver is allowed to require compilation even if the pipeline is in the cache.
+        EXPECT_EQ(pPSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+        GTEST_SKIP() << "The driver did not create the pipeline from the cache";
+    }
+    // The pipeline is found in the cache and is ready when the creation method returns
+    EXPECT_EQ(Status, PIPELINE_STATE_STATUS_READY);
+}
+
+TEST(AsyncPSOCreation, AsyncOnCacheMiss_GL)
+{
+    auto* const pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* const pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().IsGLDevice())
+    {
+        GTEST_SKIP() << "This test is only relevant for OpenGL";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pVS = CreateShader(pEnv, "Async PSO creation test VS", SHADER_TYPE_VERTEX, VSSource);
+    ASSERT_TRUE(pVS);
+
+    // Returns true if any of the pipelines was still being linked when the creation method returned
+    auto CreatePSOs = [&](PSO_CREATE_FLAGS Flags) {
+        constexpr size_t NumPSOs = 8;
+
+        std::vector<RefCntAutoPtr<IPipelineState>> PSOs(NumPSOs);
+        bool                                       AnyCompiling = false;
+        for (auto& pPSO : PSOs)
+        {
+            auto pPS = CreateUniquePixelShader(pEnv);
+            EXPECT_TRUE(pPS);
+            pPSO = CreateCacheMissTestPSO(pDevice, pVS, pPS, Flags);
+            EXPECT_TRUE(pPSO);
+            if (!pPSO)
+                continue;
+
+            const auto Status = pPSO->GetStatus();
+            EXPECT_TRUE(Status == PIPELINE_STATE_STATUS_COMPILING || Status == PIPELINE_STATE_STATUS_READY);
+            AnyCompiling = AnyCompiling || Status == PIPELINE_STATE_STATUS_COMPILING;
+        }
+
+        for (auto& pPSO : PSOs)
+        {
+            if (pPSO)
+            {
+                EXPECT_EQ(pPSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+            }
+        }
+        return AnyCompiling;
+    };
+
+    // In OpenGL, the flag is equivalent to PSO_CREATE_FLAG_ASYNCHRONOUS: programs are
+    // linked in parallel if the driver supports it, and synchronously otherwise.
+    const auto AsyncCompiling       = CreatePSOs(PSO_CREATE_FLAG_ASYNCHRONOUS);
+    const auto AsyncOnMissCompiling = CreatePSOs(PSO_CREATE_FLAG_ASYNCHRONOUS_ON_CACHE_MISS);
+    EXPECT_EQ(AsyncCompiling, AsyncOnMissCompiling);
+}
+
+} // namespace
@@ -0,0 +1,198 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <vector>
+
+#include "AsyncReadbackQueue.hpp"
+#include "ThreadPool.hpp"
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+void TestBufferReadback(IThreadPool* pThreadPool)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    std::vector<Uint32> RefData(1024);
+    for (size_t i = 0; i < RefData.size(); ++i)
+        RefData[i] = static_cast<Uint32>(i * 7 + 3);
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = "Async readback test buffer";
+    BuffDesc.Size      = RefData.size() * sizeof(RefData[0]);
+    BuffDesc.BindFlags = BIND_VERTEX_BUFFER;
+    BuffDesc.Usage     = USAGE_DEFAULT;
+
+    BufferData InitData{RefData.data(), BuffDesc.Size};
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, &InitData, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    AsyncReadbackQueue::CreateInfo CI;
+    CI.pDevice     = pDevice;
+    CI.pThreadPool = pThreadPool;
+    AsyncReadbackQueue Queue{CI};
+
+    constexpr Uint32 NumFrames = 4;
+    constexpr Uint32 Offset    = 64;
+    constexpr Uint32 NumValues = 128;
+
+    std::atomic<Uint32> NumCallbacks{0};
+    std::atomic<Uint32> NumMismatches{0};
+    for (Uint32 frame = 0; frame < NumFrames; ++frame)
+    {
+        const Uint32 FirstValue = Offset / sizeof(Uint32) + frame;
+        EXPECT_TRUE(Queue.ReadBuffer(pContext, pBuffer, FirstValue * sizeof(Uint32), NumValues * sizeof(Uint32),
+                                     [&, FirstValue](const AsyncReadbackQueue::ReadbackData& Data) {
+                                         if (Data.pData == nullptr || Data.Size != NumValues * sizeof(Uint32))
+                                         {
+                                             ++NumMismatches;
+                                         }
+                                         else
+                                         {
+                                             const auto* pValues = static_cast<const Uint32*>(Data.pData);
+                                             for (Uint32 i = 0; i < NumValues; ++i)
+                                             {
+                                                 if (pValues[i] != RefData[FirstValue + i])
+                                                     ++NumMismatches;
+                                             }
+                                         }
+                                         ++NumCallbacks;
+                                     }));
+        pContext->Flush();
+        Queue.Process(pContext);
+    }
+    EXPECT_LE(Queue.GetNumPendingReadbacks(), size_t{NumFrames});
+
+    Queue.Flush(pContext);
+    EXPECT_EQ(Queue.GetNumPendingReadbacks(), size_t{0});
+    EXPECT_EQ(NumCallbacks.load(), NumFrames);
+    EXPECT_EQ(NumMismatches.load(), 0u);
+
+    // Staging buffers are reused by subsequent readbacks
+    const auto NumPooledResources = Queue.GetNumPooledResources();
+    EXPECT_GE(NumPooledResources, size_t{1});
+    EXPECT_LE(NumPooledResources, size_t{NumFrames});
+    EXPECT_TRUE(Queue.ReadBuffer(pContext, pBuffer, 0, NumValues * sizeof(Uint32), [&](const AsyncReadbackQueue::ReadbackData&) { ++NumCallbacks; }));
+    Queue.Flush(pContext);
+    EXPECT_EQ(NumCallbacks.load(), NumFrames + 1);
+    EXPECT_EQ(Queue.GetNumPooledResources(), NumPooledResources);
+}
+
+TEST(AsyncReadbackQueueTest, Buffer)
+{
+    TestBufferReadback(nullptr);
+}
+
+TEST(AsyncReadbackQueueTest, BufferWithThreadPool)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+    TestBufferReadback(pThreadPool);
+}
+
+TEST(AsyncReadbackQueueTest, Texture)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr Uint32 Width  = 64;
+    constexpr Uint32 Height = 32;
+
+    std::vector<Uint32> RefData(Width * Height);
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+            RefData[x + y * Width] = (x << 0u) | (y << 8u) | 0xFF000000u;
+    }
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Async readback test texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    TexDesc.Usage     = USAGE_DEFAULT;
+
+    TextureSubResData SubresData{RefData.data(), Width * sizeof(Uint32)};
+    TextureData       InitData{&SubresData, 1};
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, &InitData, &pTexture);
+    ASSERT_NE(pTexture, nullptr);
+
+    AsyncReadbackQueue::CreateInfo CI;
+    CI.pDevice = pDevice;
+    AsyncReadbackQueue Queue{CI};
+
+    const Box Region{8, 24, 4, 20};
+
+    bool   CallbackCalled = false;
+    Uint32 NumMismatches  = 0;
+    EXPECT_TRUE(Queue.ReadTexture(pContext, pTexture, 0, 0, &Region,
+                                  [&](const AsyncReadbackQueue::ReadbackData& Data) {
+                                      CallbackCalled = true;
+                                      EXPECT_EQ(Data.Region.MinX, Region.MinX);
+                                      EXPECT_EQ(Data.Region.MaxY, Region.MaxY);
+                                      EXPECT_GE(Data.Stride, Uint64{Region.Width()} * sizeof(Uint32));
+                                      ASSERT_NE(Data.pData, nullptr);
+                                      for (Uint32 y = 0; y < Region.Height(); ++y)
+                                      {
+                                          const auto* pRow = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(Data.pData) + y * Data.Stride);
+                                          for (Uint32 x = 0; x < Region.Width(); ++x)
+                                          {
+                                              if (pRow[x] != RefData[(Region.MinX + x) + (Region.MinY + y) * Width])
+                                                  ++NumMismatches;
+                                          }
+                                      }
+                                  }));
+    Queue.Flush(pContext);
+
+    EXPECT_TRUE(CallbackCalled);
+    EXPECT_EQ(NumMismatches, 0u);
+    EXPECT_EQ(Queue.GetNumPendingReadbacks(), size_t{0});
+    EXPECT_EQ(Queue.GetNumPooledResources(), size_t{1});
+}
+
+} // namespace
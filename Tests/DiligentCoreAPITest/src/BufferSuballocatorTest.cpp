@@ -149,4 +149,130 @@ TEST(BufferSuballocatorTest, Allocate)
     }
 }
 
+TEST(BufferSuballocatorTest, Shrink)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    BufferSuballocatorCreateInfo CI;
+    CI.Desc.Name         = "Buffer Suballocator Shrink Test";
+    CI.Desc.BindFlags    = BIND_VERTEX_BUFFER;
+    CI.Desc.Size         = 1024;
+    CI.ExpansionSize     = 1024;
+    CI.ShrinkUnusedSpace = true;
+
+    RefCntAutoPtr<IBufferSuballocator> pAllocator;
+    CreateBufferSuballocator(pDevice, CI, &pAllocator);
+
+    std::vector<RefCntAutoPtr<IBufferSuballocation>> Allocs(8);
+    for (auto& Alloc : Allocs)
+    {
+        pAllocator->Allocate(1024, 16, &Alloc);
+        ASSERT_TRUE(Alloc);
+    }
+    EXPECT_NE(pAllocator->GetBuffer(pDevice, pContext), nullptr);
+
+    BufferSuballocatorUsageStats Stats;
+    pAllocator->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.Size, Uint64{8192});
+    EXPECT_EQ(Stats.UsedSize, Uint64{8192});
+    EXPECT_GE(Stats.CommittedSize, Stats.Size);
+
+    // Releasing allocations at the end of the buffer shrinks it
+    for (size_t i = 4; i < Allocs.size(); ++i)
+        Allocs[i].Release();
+    EXPECT_NE(pAllocator->GetBuffer(pDevice, pContext), nullptr);
+    pAllocator->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.Size, Uint64{4096});
+    EXPECT_EQ(Stats.UsedSize, Uint64{4096});
+
+    // Releasing allocations in the middle of the buffer does not shrink it
+    Allocs[1].Release();
+    EXPECT_NE(pAllocator->GetBuffer(pDevice, pContext), nullptr);
+    pAllocator->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.Size, Uint64{4096});
+    EXPECT_EQ(Stats.UsedSize, Uint64{3072});
+
+    // The buffer is never shrunk below the initial size
+    Allocs.clear();
+    EXPECT_NE(pAllocator->GetBuffer(pDevice, pContext), nullptr);
+    pAllocator->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.Size, Uint64{1024});
+    EXPECT_EQ(Stats.UsedSize, Uint64{0});
+}
+
+TEST(BufferSuballocatorTest, Defragment)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    BufferSuballocatorCreateInfo CI;
+    CI.Desc.Name             = "Buffer Suballocator Defragment Test";
+    CI.Desc.BindFlags        = BIND_VERTEX_BUFFER;
+    CI.Desc.Size             = 4096;
+    CI.EnableDefragmentation = true;
+
+    RefCntAutoPtr<IBufferSuballocator> pAllocator;
+    CreateBufferSuballocator(pDevice, CI, &pAllocator);
+
+    std::vector<RefCntAutoPtr<IBufferSuballocation>> Allocs(4);
+    for (auto& Alloc : Allocs)
+    {
+        pAllocator->Allocate(1024, 16, &Alloc);
+        ASSERT_TRUE(Alloc);
+    }
+    EXPECT_NE(pAllocator->GetBuffer(pDevice, pContext), nullptr);
+
+    // Nothing to move
+    BufferSuballocatorDefragmentAttribs Attribs;
+    Attribs.pDevice  = pDevice;
+    Attribs.pContext = pContext;
+    EXPECT_EQ(pAllocator->Defragment(Attribs), 0u);
+
+    Allocs[0].Release();
+    Allocs[1].Release();
+
+    const auto Version = pAllocator->GetVersion();
+
+    struct MovedInfo
+    {
+        IBufferSuballocation* pSuballocation;
+        Uint32                OldOffset;
+    };
+    std::vector<MovedInfo> Moved;
+
+    Attribs.MaxBytesToMove    = 1024;
+    Attribs.pCallbackUserData = &Moved;
+    Attribs.MovedCallback     = [](IBufferSuballocation* pSuballocation, Uint32 OldOffset, void* pUserData) {
+        static_cast<std::vector<MovedInfo>*>(pUserData)->push_back({pSuballocation, OldOffset});
+    };
+
+    // Only one allocation is moved due to the budget
+    EXPECT_EQ(pAllocator->Defragment(Attribs), 1u);
+    ASSERT_EQ(Moved.size(), size_t{1});
+    EXPECT_EQ(Moved[0].pSuballocation, Allocs[3].RawPtr());
+    EXPECT_EQ(Moved[0].OldOffset, 3072u);
+    EXPECT_EQ(Allocs[3]->GetOffset(), 0u);
+    EXPECT_NE(pAllocator->GetVersion(), Version);
+
+    Moved.clear();
+    Attribs.MaxBytesToMove = 0;
+    EXPECT_EQ(pAllocator->Defragment(Attribs), 1u);
+    ASSERT_EQ(Moved.size(), size_t{1});
+    EXPECT_EQ(Moved[0].pSuballocation, Allocs[2].RawPtr());
+    EXPECT_EQ(Allocs[2]->GetOffset(), 1024u);
+
+    BufferSuballocatorUsageStats Stats;
+    pAllocator->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.UsedSize, Uint64{2048});
+    EXPECT_EQ(Stats.MaxFreeChunkSize, Uint64{2048});
+    EXPECT_EQ(Stats.AllocationCount, 2u);
+}
+
 } // namespace
@@ -0,0 +1,261 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "CommandStreamCapture.hpp"
+#include "GPUTestingEnvironment.hpp"
+#include "TestingSwapChainBase.hpp"
+#include "FileWrapper.hpp"
+#include "BasicMath.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr char CommandStreamTestVS[] = R"(
+struct PSInput
+{
+    float4 Pos : SV_POSITION;
+};
+
+void main(in  float4  Pos : ATTRIB0,
+          out PSInput PSIn)
+{
+    PSIn.Pos = Pos;
+}
+)";
+
+constexpr char CommandStreamTestPS[] = R"(
+cbuffer Constants
+{
+    float4 g_Color;
+};
+
+struct PSInput
+{
+    float4 Pos : SV_POSITION;
+};
+
+float4 main(in PSInput PSIn) : SV_Target
+{
+    return g_Color;
+}
+)";
+
+// Records a frame that draws a triangle into pRTV.
+void RecordTestFrame(CommandStreamRecorder& Recorder, ITextureView* pRTV)
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+
+    const auto& RTDesc = pRTV->GetTexture()->GetDesc();
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.EntryPoint     = "main";
+
+    ShaderCI.Desc   = {"Command stream test VS", SHADER_TYPE_VERTEX, true};
+    ShaderCI.Source = CommandStreamTestVS;
+    RefCntAutoPtr<IShader> pVS;
+    Recorder.CreateShader(ShaderCI, &pVS);
+    ASSERT_NE(pVS, nullptr);
+
+    ShaderCI.Desc   = {"Command stream test PS", SHADER_TYPE_PIXEL, true};
+    ShaderCI.Source = CommandStreamTestPS;
+    RefCntAutoPtr<IShader> pPS;
+    Recorder.CreateShader(ShaderCI, &pPS);
+    ASSERT_NE(pPS, nullptr);
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name = "Command stream test PSO";
+
+    auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+    GraphicsPipeline.NumRenderTargets             = 1;
+    GraphicsPipeline.RTVFormats[0]                = RTDesc.Format;
+    GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+    GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+    const LayoutElement Elements[] = {LayoutElement{0, 0, 4, VT_FLOAT32}};
+
+    GraphicsPipeline.InputLayout.LayoutElements = Elements;
+    GraphicsPipeline.InputLayout.NumElements    = _countof(Elements);
+
+    PSOCreateInfo.pVS = pVS;
+    PSOCreateInfo.pPS = pPS;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    Recorder.CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    const float4 Positions[] = {
+        float4{-0.75f, -0.5f, 0, 1},
+        float4{+0.00f, +0.75f, 0, 1},
+        float4{+0.50f, -0.75f, 0, 1},
+    };
+
+    RefCntAutoPtr<IBuffer> pVB;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "Command stream test vertex buffer";
+        BuffDesc.Size      = sizeof(Positions);
+        BuffDesc.BindFlags = BIND_VERTEX_BUFFER;
+        BuffDesc.Usage     = USAGE_IMMUTABLE;
+
+        BufferData InitData{Positions, sizeof(Positions)};
+        Recorder.CreateBuffer(BuffDesc, &InitData, &pVB);
+        ASSERT_NE(pVB, nullptr);
+    }
+
+    RefCntAutoPtr<IBuffer> pCB;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Command stream test constants";
+        BuffDesc.Size           = sizeof(float4);
+        BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+        BuffDesc.Usage          = USAGE_DYNAMIC;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        Recorder.CreateBuffer(BuffDesc, nullptr, &pCB);
+        ASSERT_NE(pCB, nullptr);
+    }
+
+    Recorder.SetStaticVariable(pPSO, SHADER_TYPE_PIXEL, "Constants", pCB);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    Recorder.CreateShaderResourceBinding(pPSO, &pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    // Context commands
+    ITextureView* ppRTVs[] = {pRTV};
+    Recorder.SetRenderTargets(1, ppRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    const float ClearColor[] = {0.25f, 0.5f, 0.75f, 1.0f};
+    Recorder.ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    Viewport VP;
+    VP.Width  = static_cast<float>(RTDesc.Width);
+    VP.Height = static_cast<float>(RTDesc.Height);
+    Recorder.SetViewports(1, &VP, RTDesc.Width, RTDesc.Height);
+
+    {
+        PVoid pData = nullptr;
+        Recorder.MapBuffer(pCB, MAP_WRITE, MAP_FLAG_DISCARD, pData);
+        ASSERT_NE(pData, nullptr);
+        *static_cast<float4*>(pData) = float4{0.875f, 0.125f, 0.375f, 1.0f};
+        Recorder.UnmapBuffer(pCB, MAP_WRITE);
+    }
+
+    IBuffer* ppVBs[] = {pVB};
+    Recorder.SetVertexBuffers(0, 1, ppVBs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+    Recorder.SetPipelineState(pPSO);
+    Recorder.CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    Recorder.Draw(DrawAttribs{3, DRAW_FLAG_VERIFY_ALL});
+    Recorder.Flush();
+}
+
+TEST(CommandStreamCaptureTest, RecordAndReplay)
+{
+    auto* pEnv       = GPUTestingEnvironment::GetInstance();
+    auto* pDevice    = pEnv->GetDevice();
+    auto* pContext   = pEnv->GetDeviceContext();
+    auto* pSwapChain = pEnv->GetSwapChain();
+
+    RefCntAutoPtr<ITestingSwapChain> pTestingSwapChain{pSwapChain, IID_TestingSwapChain};
+    if (!pTestingSwapChain)
+    {
+        GTEST_SKIP() << "Testing swap chain is required to compare the render targets";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr char FilePath[] = "CommandStreamCaptureTest.dcs";
+
+    const auto& SCDesc = pSwapChain->GetDesc();
+
+    // The recorded frame is rendered into a texture that is not created by the recorder,
+    // so that the player substitutes it with the swap chain back buffer.
+    auto pRecordedRT = pEnv->CreateTexture("Command stream test render target", SCDesc.ColorBufferFormat,
+                                           BIND_RENDER_TARGET, SCDesc.Width, SCDesc.Height);
+    ASSERT_NE(pRecordedRT, nullptr);
+
+    size_t NumCommands = 0;
+    {
+        CommandStreamRecorder::CreateInfo RecorderCI;
+        RecorderCI.pDevice  = pDevice;
+        RecorderCI.pContext = pContext;
+        CommandStreamRecorder Recorder{RecorderCI};
+
+        RecordTestFrame(Recorder, pRecordedRT->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET));
+        if (HasFatalFailure())
+            return;
+
+        NumCommands = Recorder.GetNumCommands();
+        EXPECT_GT(NumCommands, size_t{0});
+        ASSERT_TRUE(Recorder.SaveToFile(FilePath));
+    }
+
+    // The recorded frame is the reference image
+    StateTransitionDesc Barrier{pRecordedRT, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_SOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE};
+    pContext->TransitionResourceStates(1, &Barrier);
+    pContext->Flush();
+    pContext->InvalidateState(); // because TakeSnapshot() will clear state in D3D11
+    pTestingSwapChain->TakeSnapshot(pRecordedRT);
+
+    {
+        CommandStreamPlayer::CreateInfo PlayerCI;
+        PlayerCI.pDevice      = pDevice;
+        PlayerCI.pContext     = pContext;
+        PlayerCI.pExternalRTV = pSwapChain->GetCurrentBackBufferRTV();
+        CommandStreamPlayer Player{PlayerCI};
+
+        CommandStreamPlayer::Stats Stats;
+        const bool                 Loaded = Player.LoadFromFile(FilePath, &Stats);
+        FileSystem::DeleteFile(FilePath);
+        ASSERT_TRUE(Loaded);
+
+        // Shaders, pipeline state, buffers, SRB and the static variable
+        EXPECT_EQ(Stats.Calls[COMMAND_STREAM_CALL_CREATE_SHADER].NumCalls, 2u);
+        EXPECT_EQ(Stats.Calls[COMMAND_STREAM_CALL_CREATE_GRAPHICS_PIPELINE_STATE].NumCalls, 1u);
+        EXPECT_EQ(Stats.Calls[COMMAND_STREAM_CALL_CREATE_BUFFER].NumCalls, 2u);
+        EXPECT_EQ(Stats.Calls[COMMAND_STREAM_CALL_CREATE_SHADER_RESOURCE_BINDING].NumCalls, 1u);
+        EXPECT_EQ(Stats.Calls[COMMAND_STREAM_CALL_SET_STATIC_VARIABLE].NumCalls, 1u);
+        EXPECT_EQ(Player.GetNumCommands() + 7, NumCommands);
+
+        ASSERT_TRUE(Player.Replay(&Stats));
+        EXPECT_EQ(Stats.Calls[COMMAND_STREAM_CALL_MAP_BUFFER].NumCalls, 1u);
+        EXPECT_EQ(Stats.Calls[COMMAND_STREAM_CALL_DRAW].NumCalls, 1u);
+    }
+
+    // Compares the replayed frame with the recorded one
+    pSwapChain->Present();
+}
+
+} // namespace
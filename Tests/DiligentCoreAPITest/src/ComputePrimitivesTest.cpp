@@ -0,0 +1,231 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ComputePrimitives.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+RefCntAutoPtr<IBuffer> CreateBuffer(const char* Name, const std::vector<Uint32>& Data)
+{
+    BufferDesc Desc;
+    Desc.Name              = Name;
+    Desc.Size              = sizeof(Uint32) * std::max(Data.size(), size_t{1});
+    Desc.Usage             = USAGE_DEFAULT;
+    Desc.BindFlags         = BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+    Desc.Mode              = BUFFER_MODE_STRUCTURED;
+    Desc.ElementByteStride = sizeof(Uint32);
+
+    BufferData InitData{Data.data(), sizeof(Uint32) * Data.size()};
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    GPUTestingEnvironment::GetInstance()->GetDevice()->CreateBuffer(Desc, Data.empty() ? nullptr : &InitData, &pBuffer);
+    return pBuffer;
+}
+
+RefCntAutoPtr<IBuffer> CreateBuffer(const char* Name, size_t NumElements)
+{
+    return CreateBuffer(Name, std::vector<Uint32>(NumElements));
+}
+
+std::vector<Uint32> GenerateData(size_t NumElements, Uint32 MaxValue, Uint32 Seed)
+{
+    std::mt19937                          Gen{Seed};
+    std::uniform_int_distribution<Uint32> Distr{0, MaxValue};
+
+    std::vector<Uint32> Data(NumElements);
+    for (auto& Val : Data)
+        Val = Distr(Gen);
+    return Data;
+}
+
+class ComputePrimitivesTest : public ::testing::TestWithParam<bool>
+{
+protected:
+    void SetUp() override
+    {
+        auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+        if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+            GTEST_SKIP() << "Compute shaders are not supported by this device";
+
+        ComputePrimitives::CreateInfo CI;
+        CI.pDevice    = pDevice;
+        CI.UseWaveOps = GetParam();
+        m_Primitives.reset(new ComputePrimitives{CI});
+        if (GetParam() && !m_Primitives->IsUsingWaveOps())
+            GTEST_SKIP() << "Wave operations are not supported by this device";
+    }
+
+    void TearDown() override
+    {
+        m_Primitives.reset();
+        GPUTestingEnvironment::GetInstance()->Reset();
+    }
+
+    std::unique_ptr<ComputePrimitives> m_Primitives;
+};
+
+TEST_P(ComputePrimitivesTest, Scan)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    // Large enough to require three levels of block sums
+    const Uint32 ElementsPerGroup = m_Primitives->GetElementsPerGroup();
+    for (Uint32 NumElements : {1u, 17u, ElementsPerGroup, ElementsPerGroup * 3 + 5, ElementsPerGroup * ElementsPerGroup + 123})
+    {
+        const auto Input = GenerateData(NumElements, 16, NumElements);
+
+        auto pInput  = CreateBuffer("Scan input", Input);
+        auto pOutput = CreateBuffer("Scan output", NumElements);
+        ASSERT_TRUE(pInput && pOutput);
+
+        for (bool Inclusive : {false, true})
+        {
+            ComputePrimitives::ScanAttribs Attribs;
+            Attribs.pInput      = pInput;
+            Attribs.pOutput     = pOutput;
+            Attribs.NumElements = NumElements;
+            Attribs.Inclusive   = Inclusive;
+            m_Primitives->Scan(pContext, Attribs);
+
+            std::vector<Uint32> Expected(NumElements);
+            Uint32              Sum = 0;
+            for (size_t i = 0; i < Input.size(); ++i)
+            {
+                Expected[i] = Inclusive ? Sum + Input[i] : Sum;
+                Sum += Input[i];
+            }
+            EXPECT_EQ(pEnv->ReadBuffer<Uint32>(pOutput, NumElements), Expected) << "NumElements: " << NumElements << ", Inclusive: " << Inclusive;
+        }
+    }
+}
+
+TEST_P(ComputePrimitivesTest, Compact)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    const Uint32 NumElements = m_Primitives->GetElementsPerGroup() * 5 + 77;
+
+    std::vector<Uint32> Input(NumElements);
+    std::iota(Input.begin(), Input.end(), 1000u);
+    // Nonzero flags other than one must also be treated as 'keep'
+    const auto Flags = GenerateData(NumElements, 3, 7);
+
+    auto pInput  = CreateBuffer("Compact input", Input);
+    auto pFlags  = CreateBuffer("Compact flags", Flags);
+    auto pOutput = CreateBuffer("Compact output", NumElements);
+    auto pCount  = CreateBuffer("Compact count", 1);
+    ASSERT_TRUE(pInput && pFlags && pOutput && pCount);
+
+    ComputePrimitives::CompactAttribs Attribs;
+    Attribs.pInput      = pInput;
+    Attribs.pFlags      = pFlags;
+    Attribs.pOutput     = pOutput;
+    Attribs.pCount      = pCount;
+    Attribs.NumElements = NumElements;
+    m_Primitives->Compact(pContext, Attribs);
+
+    std::vector<Uint32> Expected;
+    for (size_t i = 0; i < Input.size(); ++i)
+    {
+        if (Flags[i] != 0)
+            Expected.push_back(Input[i]);
+    }
+
+    const auto Count = pEnv->ReadBuffer<Uint32>(pCount, 1);
+    ASSERT_EQ(Count.size(), size_t{1});
+    ASSERT_EQ(Count[0], static_cast<Uint32>(Expected.size()));
+    EXPECT_EQ(pEnv->ReadBuffer<Uint32>(pOutput, Count[0]), Expected);
+}
+
+TEST_P(ComputePrimitivesTest, Sort)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    const Uint32 NumElements = m_Primitives->GetElementsPerGroup() * 9 + 31;
+
+    // 12 key bits require an odd number of passes, so the result is copied back from the temporary buffers
+    for (Uint32 NumKeyBits : {32u, 12u})
+    {
+        const Uint32 MaxKey = NumKeyBits == 32 ? ~0u : (1u << NumKeyBits) - 1u;
+        const auto   Keys   = GenerateData(NumElements, MaxKey, NumKeyBits);
+
+        std::vector<Uint32> Values(NumElements);
+        std::iota(Values.begin(), Values.end(), 0u);
+
+        auto pKeys       = CreateBuffer("Sort keys", Keys);
+        auto pValues     = CreateBuffer("Sort values", Values);
+        auto pTempKeys   = CreateBuffer("Sort temp keys", NumElements);
+        auto pTempValues = CreateBuffer("Sort temp values", NumElements);
+        ASSERT_TRUE(pKeys && pValues && pTempKeys && pTempValues);
+
+        ComputePrimitives::SortAttribs Attribs;
+        Attribs.pKeys       = pKeys;
+        Attribs.pValues     = pValues;
+        Attribs.pTempKeys   = pTempKeys;
+        Attribs.pTempValues = pTempValues;
+        Attribs.NumElements = NumElements;
+        Attribs.NumKeyBits  = NumKeyBits;
+        m_Primitives->Sort(pContext, Attribs);
+
+        // The sort is stable, so the values must match the stable CPU sort
+        std::vector<Uint32> ExpectedValues = Values;
+        std::stable_sort(ExpectedValues.begin(), ExpectedValues.end(), [&Keys](Uint32 a, Uint32 b) { return Keys[a] < Keys[b]; });
+        std::vector<Uint32> ExpectedKeys(NumElements);
+        for (size_t i = 0; i < ExpectedValues.size(); ++i)
+            ExpectedKeys[i] = Keys[ExpectedValues[i]];
+
+        EXPECT_EQ(pEnv->ReadBuffer<Uint32>(pKeys, NumElements), ExpectedKeys) << "NumKeyBits: " << NumKeyBits;
+        EXPECT_EQ(pEnv->ReadBuffer<Uint32>(pValues, NumElements), ExpectedValues) << "NumKeyBits: " << NumKeyBits;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(ComputePrimitives,
+                         ComputePrimitivesTest,
+                         ::testing::Values(false, true),
+                         [](const testing::TestParamInfo<bool>& info) {
+                             return info.param ? std::string{"WaveOps"} : std::string{"SharedMemory"};
+                         });
+
+} // namespace
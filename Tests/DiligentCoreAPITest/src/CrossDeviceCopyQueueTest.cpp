@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "AsyncReadbackQueue.hpp"
+#include "CrossDeviceCopyQueue.hpp"
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+RefCntAutoPtr<IBuffer> CreateTestBuffer(IRenderDevice* pDevice, const char* Name, const std::vector<Uint32>& Data)
+{
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = Name;
+    BuffDesc.Size      = Data.size() * sizeof(Data[0]);
+    BuffDesc.BindFlags = BIND_VERTEX_BUFFER;
+    BuffDesc.Usage     = USAGE_DEFAULT;
+
+    BufferData InitData{Data.data(), BuffDesc.Size};
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, &InitData, &pBuffer);
+    return pBuffer;
+}
+
+// The test environment has a single device, so it is used as both the source and the destination.
+TEST(CrossDeviceCopyQueueTest, CopyBuffer)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    std::vector<Uint32> SrcData(256);
+    for (size_t i = 0; i < SrcData.size(); ++i)
+        SrcData[i] = static_cast<Uint32>(i * 5 + 1);
+
+    auto pSrcBuffer = CreateTestBuffer(pDevice, "Cross-device copy source", SrcData);
+    auto pDstBuffer = CreateTestBuffer(pDevice, "Cross-device copy destination", std::vector<Uint32>(SrcData.size()));
+    ASSERT_NE(pSrcBuffer, nullptr);
+    ASSERT_NE(pDstBuffer, nullptr);
+
+    CrossDeviceCopyQueue::CreateInfo CI;
+    CI.pSrcDevice = pDevice;
+    CrossDeviceCopyQueue CopyQueue{CI};
+
+    constexpr Uint32 Offset    = 32;
+    constexpr Uint32 NumValues = 64;
+    EXPECT_TRUE(CopyQueue.CopyBuffer(pContext, pSrcBuffer, Offset * sizeof(Uint32), NumValues * sizeof(Uint32),
+                                     pDstBuffer, 0));
+    EXPECT_EQ(CopyQueue.GetNumPendingCopies(), size_t{1});
+
+    CopyQueue.Flush(pContext, pContext);
+    EXPECT_EQ(CopyQueue.GetNumPendingCopies(), size_t{0});
+
+    AsyncReadbackQueue::CreateInfo ReadbackCI;
+    ReadbackCI.pDevice = pDevice;
+    AsyncReadbackQueue ReadbackQueue{ReadbackCI};
+
+    bool Verified = false;
+    ReadbackQueue.ReadBuffer(pContext, pDstBuffer, 0, NumValues * sizeof(Uint32),
+                             [&](const AsyncReadbackQueue::ReadbackData& Data) {
+                                 const auto* pValues = static_cast<const Uint32*>(Data.pData);
+                                 for (Uint32 i = 0; i < NumValues; ++i)
+                                     EXPECT_EQ(pValues[i], SrcData[Offset + i]) << "i=" << i;
+                                 Verified = true;
+                             });
+    ReadbackQueue.Flush(pContext);
+    EXPECT_TRUE(Verified);
+}
+
+} // namespace
@@ -50,4 +50,145 @@ TEST(DeviceContextTest, DebugGroups)
     pCtx->EndDebugGroup();
 }
 
+TEST(DeviceContextTest, InstrumentationStats)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    auto* pCtx    = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Instrumentation test buffer";
+    BuffDesc.Size           = 256;
+    BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+    BuffDesc.Usage          = USAGE_DYNAMIC;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    constexpr Uint32 NumMaps = 3;
+
+    // Start a new frame so that previous calls are not counted
+    pCtx->FinishFrame();
+    for (Uint32 i = 0; i < NumMaps; ++i)
+    {
+        void* pData = nullptr;
+        pCtx->MapBuffer(pBuffer, MAP_WRITE, MAP_FLAG_DISCARD, pData);
+        EXPECT_NE(pData, nullptr);
+        pCtx->UnmapBuffer(pBuffer, MAP_WRITE);
+    }
+    pCtx->FinishFrame();
+
+    DeviceContextInstrumentationStats Stats;
+    pCtx->GetInstrumentationStats(Stats);
+
+    // The statistics are only collected when the engine is built with the instrumentation
+    if (Stats.CallCounts[INSTRUMENTED_CALL_MAP_BUFFER] != 0)
+    {
+        EXPECT_EQ(Stats.CallCounts[INSTRUMENTED_CALL_MAP_BUFFER], NumMaps);
+        EXPECT_EQ(Stats.CallCounts[INSTRUMENTED_CALL_UNMAP_BUFFER], NumMaps);
+        EXPECT_EQ(Stats.CallCounts[INSTRUMENTED_CALL_DRAW], 0u);
+    }
+    else
+    {
+        for (Uint32 i = 0; i < INSTRUMENTED_CALL_COUNT; ++i)
+        {
+            EXPECT_EQ(Stats.CallCounts[i], 0u);
+            EXPECT_EQ(Stats.CallTimes[i], 0u);
+        }
+    }
+}
+
+TEST(DeviceContextTest, FrameStatistics)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    auto* pCtx    = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Frame statistics test buffer";
+    BuffDesc.Size           = 256;
+    BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+    BuffDesc.Usage          = USAGE_DYNAMIC;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    constexpr Uint32 NumMaps = 3;
+
+    // Start a new frame so that previous commands are not counted
+    pCtx->FinishFrame();
+    for (Uint32 i = 0; i < NumMaps; ++i)
+    {
+        void* pData = nullptr;
+        pCtx->MapBuffer(pBuffer, MAP_WRITE, MAP_FLAG_DISCARD, pData);
+        EXPECT_NE(pData, nullptr);
+        pCtx->UnmapBuffer(pBuffer, MAP_WRITE);
+    }
+    pCtx->Flush();
+    pCtx->FinishFrame();
+
+    DeviceContextFrameStatistics Stats;
+    pCtx->GetFrameStatistics(Stats);
+    EXPECT_EQ(Stats.DrawCount, 0u);
+    EXPECT_EQ(Stats.DispatchCount, 0u);
+    EXPECT_EQ(Stats.PipelineStateBindCount, 0u);
+    EXPECT_EQ(Stats.SRBCommitCount, 0u);
+    if (!pDevice->GetDeviceInfo().IsGLDevice())
+    {
+        // In OpenGL, the data may bypass the upload ring buffer
+        EXPECT_GE(Stats.DynamicHeapBytes, Uint64{NumMaps} * BuffDesc.Size);
+    }
+
+    // An empty frame
+    pCtx->FinishFrame();
+    pCtx->GetFrameStatistics(Stats);
+    EXPECT_EQ(Stats.DrawCount, 0u);
+    EXPECT_EQ(Stats.DispatchCount, 0u);
+    EXPECT_EQ(Stats.SRBCommitCount, 0u);
+    EXPECT_EQ(Stats.DynamicHeapBytes, 0u);
+    EXPECT_EQ(Stats.UploadHeapBytes, 0u);
+    EXPECT_EQ(Stats.DescriptorAllocationCount, 0u);
+}
+
+TEST(DeviceContextTest, ValidationLevel)
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+    auto* pCtx = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    const auto DefaultLevel = pCtx->GetValidationLevel();
+    EXPECT_NE(DefaultLevel, CONTEXT_VALIDATION_LEVEL_DEFAULT);
+
+    pCtx->SetValidationLevel(CONTEXT_VALIDATION_LEVEL_OFF);
+    EXPECT_EQ(pCtx->GetValidationLevel(), CONTEXT_VALIDATION_LEVEL_OFF);
+
+    pCtx->SetValidationLevel(CONTEXT_VALIDATION_LEVEL_BASIC);
+    EXPECT_EQ(pCtx->GetValidationLevel(), CONTEXT_VALIDATION_LEVEL_BASIC);
+
+    // No pipeline is bound: the commands must be skipped
+    pEnv->SetErrorAllowance(2, "No worries, errors are expected: testing basic validation\n");
+    pCtx->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+    pCtx->Draw(DrawAttribs{3, DRAW_FLAG_VERIFY_ALL});
+
+    // Full validation is not compiled in release builds, and the level is clamped to basic
+    pCtx->SetValidationLevel(CONTEXT_VALIDATION_LEVEL_FULL, 16);
+#ifdef DILIGENT_DEVELOPMENT
+    EXPECT_EQ(pCtx->GetValidationLevel(), CONTEXT_VALIDATION_LEVEL_FULL);
+#else
+    EXPECT_EQ(pCtx->GetValidationLevel(), CONTEXT_VALIDATION_LEVEL_BASIC);
+#endif
+
+    pCtx->SetValidationLevel(CONTEXT_VALIDATION_LEVEL_DEFAULT);
+    EXPECT_EQ(pCtx->GetValidationLevel(), DefaultLevel);
+}
+
 } // namespace
@@ -1029,6 +1029,69 @@ TEST_F(DrawCommandTest, DrawIndexed_IBOffset_BaseVertex)
     Present();
 }
 
+TEST_F(DrawCommandTest, MultiDraw)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        {}, {},
+        Vert[0], Vert[1], Vert[2],
+        {}, {}, {},
+        Vert[3], Vert[4], Vert[5]
+    };
+    // clang-format on
+
+    auto     pVB    = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    IBuffer* pVBs[] = {pVB};
+    pContext->SetVertexBuffers(0, 1, pVBs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    const MultiDrawItem DrawItems[] = {{3, 2}, {0, 0}, {3, 8}};
+
+    MultiDrawAttribs drawAttrs{_countof(DrawItems), DrawItems, DRAW_FLAG_VERIFY_ALL};
+    pContext->MultiDraw(drawAttrs);
+
+    Present();
+}
+
+TEST_F(DrawCommandTest, MultiDrawIndexed)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawPSO);
+
+    Uint32 bv = 2; // Base vertex of the second item
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        {}, {},
+        Vert[0], {}, Vert[1], {}, {}, Vert[2],
+        Vert[3], {}, {}, Vert[5], Vert[4]
+    };
+    const Uint32 Indices[] = {0,0,0,0, 2,4,7, 0,0, 8-bv,12-bv,11-bv};
+    // clang-format on
+
+    auto pVB = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    auto pIB = CreateIndexBuffer(Indices, _countof(Indices));
+
+    IBuffer*     pVBs[]    = {pVB};
+    const Uint64 Offsets[] = {0};
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+    pContext->SetIndexBuffer(pIB, sizeof(Uint32) * 4, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    const MultiDrawIndexedItem DrawItems[] = {{3, 0, 0}, {3, 5, bv}};
+
+    MultiDrawIndexedAttribs drawAttrs{_countof(DrawItems), DrawItems, VT_UINT32, DRAW_FLAG_VERIFY_ALL};
+    pContext->MultiDrawIndexed(drawAttrs);
+
+    Present();
+}
+
 
 // Instanced non-indexed draw calls (glDrawArraysInstanced/DrawInstanced)
 
@@ -2296,6 +2359,68 @@ TEST_F(DrawCommandTest, DeferredContexts)
     Present();
 }
 
+TEST_F(DrawCommandTest, ReusableCommandList)
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+    if (pEnv->GetNumDeferredContexts() == 0)
+    {
+        GTEST_SKIP() << "Deferred contexts are not supported by this device";
+    }
+
+    auto* pSwapChain    = pEnv->GetSwapChain();
+    auto* pImmediateCtx = pEnv->GetDeviceContext();
+
+    const float ClearColor[] = {sm_Rnd(), sm_Rnd(), sm_Rnd(), sm_Rnd()};
+    RenderDrawCommandReference(pSwapChain, ClearColor);
+
+    const Uint32 Indices[] = {0, 1, 2, 3, 4, 5};
+    auto         pVB       = CreateVertexBuffer(Vert, sizeof(Vert));
+    auto         pIB       = CreateIndexBuffer(Indices, _countof(Indices));
+
+    StateTransitionDesc Barriers[] = //
+        {
+            {pVB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE},
+            {pIB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_INDEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE} //
+        };
+    pImmediateCtx->TransitionResourceStates(_countof(Barriers), Barriers);
+
+    ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+    pImmediateCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    auto* pCtx = pEnv->GetDeferredContext(0);
+
+    pCtx->BeginReusable(0);
+    pCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    IBuffer*     pVBs[]    = {pVB};
+    const Uint64 Offsets[] = {0};
+    pCtx->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_RESET);
+    pCtx->SetIndexBuffer(pIB, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    pCtx->SetPipelineState(sm_pDrawPSO);
+    pCtx->DrawIndexed({6, VT_UINT32, DRAW_FLAG_VERIFY_ALL});
+
+    RefCntAutoPtr<ICommandList> pCmdList;
+    pCtx->FinishCommandList(&pCmdList);
+    ASSERT_NE(pCmdList, nullptr);
+
+    // Execute the same command list twice. The first result is overwritten
+    // by the clear, so the final image is only correct if the second execution succeeds.
+    ICommandList*      pCmdLists[]  = {pCmdList};
+    const float        OtherColor[] = {1.f - ClearColor[0], 1.f - ClearColor[1], 1.f - ClearColor[2], 1.f - ClearColor[3]};
+    const float* const Colors[]     = {OtherColor, ClearColor};
+    for (const auto* Color : Colors)
+    {
+        pImmediateCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pImmediateCtx->ClearRenderTarget(pRTVs[0], Color, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pImmediateCtx->ExecuteCommandLists(1, pCmdLists);
+    }
+
+    pCtx->FinishFrame();
+
+    Present();
+}
+
 
 void DrawCommandTest::TestDynamicBufferUpdates(IShader*                      pVS,
                                                IShader*                      pPS,
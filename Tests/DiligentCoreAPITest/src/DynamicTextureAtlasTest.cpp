@@ -28,6 +28,7 @@
 #include "DynamicTextureAtlas.h"
 
 #include <thread>
+#include <vector>
 
 #include "GPUTestingEnvironment.hpp"
 #include "gtest/gtest.h"
@@ -250,8 +251,151 @@ TEST(DynamicTextureAtlas, Allocate)
     }
 }
 
+TEST(DynamicTextureAtlas, ShelfPolicy)
+{
+    auto* const pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* const pDevice  = pEnv->GetDevice();
+    auto* const pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    DynamicTextureAtlasCreateInfo CI;
+    CI.ExtraSliceCount = 1;
+    CI.MinAlignment    = 4;
+    CI.PackingPolicy   = DYNAMIC_ATLAS_MANAGER_POLICY_SHELF;
+    CI.Desc.Format     = TEX_FORMAT_R8_UNORM;
+    CI.Desc.Name       = "Dynamic Texture Atlas Shelf Policy Test";
+    CI.Desc.Type       = RESOURCE_DIM_TEX_2D_ARRAY;
+    CI.Desc.BindFlags  = BIND_SHADER_RESOURCE;
+    CI.Desc.Width      = 256;
+    CI.Desc.Height     = 256;
+    CI.Desc.ArraySize  = 1;
+
+    RefCntAutoPtr<IDynamicTextureAtlas> pAtlas;
+    CreateDynamicTextureAtlas(pDevice, CI, &pAtlas);
+    ASSERT_NE(pAtlas, nullptr);
+
+    // Glyph-like regions of similar height
+    FastRandInt rnd{0, 6, 20};
+
+    std::vector<RefCntAutoPtr<ITextureAtlasSuballocation>> Allocs(512);
+    Uint64                                                 AllocatedArea = 0;
+    for (auto& Alloc : Allocs)
+    {
+        const Uint32 Width  = static_cast<Uint32>(rnd());
+        const Uint32 Height = static_cast<Uint32>(rnd());
+        pAtlas->Allocate(Width, Height, &Alloc);
+        ASSERT_TRUE(Alloc);
+        EXPECT_EQ(Alloc->GetSize().x, Width);
+        EXPECT_EQ(Alloc->GetSize().y, Height);
+        AllocatedArea += Uint64{Width} * Uint64{Height};
+    }
+
+    auto* pTexture = pAtlas->GetTexture(pDevice, pContext);
+    EXPECT_NE(pTexture, nullptr);
+
+    DynamicTextureAtlasUsageStats Stats;
+    pAtlas->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, Allocs.size());
+    EXPECT_GE(Stats.AllocatedArea, AllocatedArea);
+
+    // Release every other region and refill the holes
+    for (size_t i = 0; i < Allocs.size(); i += 2)
+        Allocs[i].Release();
+
+    for (size_t i = 0; i < Allocs.size(); i += 2)
+    {
+        pAtlas->Allocate(static_cast<Uint32>(rnd()), static_cast<Uint32>(rnd()), &Allocs[i]);
+        EXPECT_TRUE(Allocs[i]);
+    }
+
+    Allocs.clear();
+    pAtlas->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, 0u);
+    EXPECT_EQ(Stats.AllocatedArea, 0u);
+}
+
 
 // Allocate more regions than the atlas can hold
+TEST(DynamicTextureAtlas, Defragment)
+{
+    auto* const pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* const pDevice  = pEnv->GetDevice();
+    auto* const pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    DynamicTextureAtlasCreateInfo CI;
+    CI.ExtraSliceCount       = 1;
+    CI.MinAlignment          = 64;
+    CI.EnableDefragmentation = true;
+    CI.Desc.Format           = TEX_FORMAT_RGBA8_UNORM;
+    CI.Desc.Name             = "Dynamic Texture Atlas Defragment Test";
+    CI.Desc.Type             = RESOURCE_DIM_TEX_2D_ARRAY;
+    CI.Desc.BindFlags        = BIND_SHADER_RESOURCE;
+    CI.Desc.Width            = 512;
+    CI.Desc.Height           = 512;
+    CI.Desc.MipLevels        = 4;
+    CI.Desc.ArraySize        = 1;
+
+    RefCntAutoPtr<IDynamicTextureAtlas> pAtlas;
+    CreateDynamicTextureAtlas(pDevice, CI, &pAtlas);
+    ASSERT_TRUE(pAtlas);
+
+    // Fill the first slice
+    std::vector<RefCntAutoPtr<ITextureAtlasSuballocation>> Suballocs(5);
+    for (auto& pSuballoc : Suballocs)
+    {
+        pAtlas->Allocate(256, 256, &pSuballoc);
+        ASSERT_TRUE(pSuballoc);
+    }
+    EXPECT_EQ(Suballocs[4]->GetSlice(), 1u);
+    EXPECT_NE(pAtlas->GetTexture(pDevice, pContext), nullptr);
+    EXPECT_EQ(pAtlas->GetAtlasDesc().ArraySize, 2u);
+
+    DynamicTextureAtlasDefragmentAttribs Attribs;
+    Attribs.pDevice  = pDevice;
+    Attribs.pContext = pContext;
+    // There is no free space in the first slice
+    EXPECT_EQ(pAtlas->Defragment(Attribs), 0u);
+
+    const auto FreeOrigin = Suballocs[1]->GetOrigin();
+    Suballocs[1].Release();
+
+    const auto Version = pAtlas->GetVersion();
+
+    struct MovedInfo
+    {
+        ITextureAtlasSuballocation* pSuballoc;
+        uint2                       OldOrigin;
+        Uint32                      OldSlice;
+    };
+    std::vector<MovedInfo> Moved;
+
+    Attribs.pCallbackUserData = &Moved;
+    Attribs.MovedCallback     = [](ITextureAtlasSuballocation* pSuballoc, const uint2& OldOrigin, Uint32 OldSlice, void* pUserData) {
+        static_cast<std::vector<MovedInfo>*>(pUserData)->push_back({pSuballoc, OldOrigin, OldSlice});
+    };
+    EXPECT_EQ(pAtlas->Defragment(Attribs), 1u);
+    ASSERT_EQ(Moved.size(), size_t{1});
+    EXPECT_EQ(Moved[0].pSuballoc, Suballocs[4].RawPtr());
+    EXPECT_EQ(Moved[0].OldOrigin, uint2(0, 0));
+    EXPECT_EQ(Moved[0].OldSlice, 1u);
+    EXPECT_EQ(Suballocs[4]->GetSlice(), 0u);
+    EXPECT_EQ(Suballocs[4]->GetOrigin(), FreeOrigin);
+    EXPECT_NE(pAtlas->GetVersion(), Version);
+
+    // The unused slice is released
+    EXPECT_NE(pAtlas->GetTexture(pDevice, pContext), nullptr);
+    EXPECT_EQ(pAtlas->GetAtlasDesc().ArraySize, 1u);
+
+    DynamicTextureAtlasUsageStats Stats;
+    pAtlas->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, 4u);
+    EXPECT_EQ(Stats.TotalArea, Uint64{512} * Uint64{512});
+    EXPECT_EQ(Stats.UsedArea, Uint64{4} * Uint64{256} * Uint64{256});
+}
+
 TEST(DynamicTextureAtlas, Overflow)
 {
     auto* const pEnv     = GPUTestingEnvironment::GetInstance();
@@ -0,0 +1,210 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+#include "FenceWaitService.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+RefCntAutoPtr<IFence> CreateTestFence(const char* Name)
+{
+    FenceDesc Desc;
+    Desc.Name = Name;
+    Desc.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+
+    RefCntAutoPtr<IFence> pFence;
+    GPUTestingEnvironment::GetInstance()->GetDevice()->CreateFence(Desc, &pFence);
+    return pFence;
+}
+
+TEST(FenceWaitServiceTest, Callbacks)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pFence = CreateTestFence("Fence wait service test");
+    ASSERT_NE(pFence, nullptr);
+
+    FenceWaitService::CreateInfo CI;
+    CI.pDevice = pEnv->GetDevice();
+    FenceWaitService Service{CI};
+
+    std::mutex          CompletedMtx;
+    std::vector<Uint64> Completed;
+    for (Uint64 Value = 1; Value <= 3; ++Value)
+    {
+        Service.Enqueue(pFence, Value, [&, Value]() {
+            std::lock_guard<std::mutex> Lock{CompletedMtx};
+            Completed.push_back(Value);
+        });
+    }
+    EXPECT_EQ(Service.GetNumPendingRequests(), size_t{3});
+
+    pContext->EnqueueSignal(pFence, 1);
+    pContext->EnqueueSignal(pFence, 3);
+    pContext->Flush();
+
+    Service.WaitIdle();
+    EXPECT_EQ(Service.GetNumPendingRequests(), size_t{0});
+    EXPECT_EQ(Service.Poll(), 0u);
+
+    // Callbacks of one fence are called in the order of the values
+    const std::vector<Uint64> Expected{1, 2, 3};
+    EXPECT_EQ(Completed, Expected);
+}
+
+TEST(FenceWaitServiceTest, Poll)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pFence = CreateTestFence("Fence wait service poll test");
+    ASSERT_NE(pFence, nullptr);
+
+    FenceWaitService::CreateInfo CI;
+    CI.pDevice             = pEnv->GetDevice();
+    CI.DisableWorkerThread = true;
+    FenceWaitService Service{CI};
+    EXPECT_FALSE(Service.IsAsync());
+
+    std::atomic<Uint32> NumCalls{0};
+    Service.Enqueue(pFence, 1, [&]() { ++NumCalls; });
+    Service.Enqueue(pFence, 2, [&]() { ++NumCalls; });
+
+    // The fence has not been signaled
+    EXPECT_EQ(Service.Poll(), 0u);
+    EXPECT_EQ(NumCalls, 0u);
+
+    pContext->EnqueueSignal(pFence, 1);
+    pContext->Flush();
+    pFence->Wait(1);
+    EXPECT_EQ(Service.Poll(), 1u);
+    EXPECT_EQ(NumCalls, 1u);
+
+    pContext->EnqueueSignal(pFence, 2);
+    pContext->Flush();
+
+    Service.WaitIdle();
+    EXPECT_EQ(NumCalls, 2u);
+}
+
+TEST(FenceWaitServiceTest, OutOfOrderFences)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pFence0 = CreateTestFence("Fence wait service test fence 0");
+    ASSERT_NE(pFence0, nullptr);
+    auto pFence1 = CreateTestFence("Fence wait service test fence 1");
+    ASSERT_NE(pFence1, nullptr);
+
+    FenceWaitService::CreateInfo CI;
+    CI.pDevice = pEnv->GetDevice();
+    FenceWaitService Service{CI};
+
+    std::mutex          CompletedMtx;
+    std::vector<Uint32> Completed;
+
+    const auto AddCompleted = [&](Uint32 Id) {
+        std::lock_guard<std::mutex> Lock{CompletedMtx};
+        Completed.push_back(Id);
+    };
+    const auto GetCompleted = [&]() {
+        std::lock_guard<std::mutex> Lock{CompletedMtx};
+        return Completed;
+    };
+
+    // The request for the first fence is enqueued first, but the second fence is signaled first
+    Service.Enqueue(pFence0, 1, [&]() { AddCompleted(0); });
+    Service.Enqueue(pFence1, 1, [&]() { AddCompleted(1); });
+
+    pContext->EnqueueSignal(pFence1, 1);
+    pContext->Flush();
+    pFence1->Wait(1);
+
+    if (Service.IsAsync())
+    {
+        // The callback must be run without waiting for the first fence
+        for (Uint32 i = 0; i < 10000 && GetCompleted().empty(); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    else
+    {
+        EXPECT_EQ(Service.Poll(), 1u);
+    }
+    EXPECT_EQ(GetCompleted(), std::vector<Uint32>{1});
+    EXPECT_EQ(Service.GetNumPendingRequests(), size_t{1});
+
+    pContext->EnqueueSignal(pFence0, 1);
+    pContext->Flush();
+
+    Service.WaitIdle();
+    const std::vector<Uint32> Expected{1, 0};
+    EXPECT_EQ(GetCompleted(), Expected);
+}
+
+TEST(FenceWaitServiceTest, DropPendingRequests)
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pFence = CreateTestFence("Fence wait service drop test");
+    ASSERT_NE(pFence, nullptr);
+
+    std::atomic<Uint32> NumCalls{0};
+    {
+        FenceWaitService::CreateInfo CI;
+        CI.pDevice = pEnv->GetDevice();
+        FenceWaitService Service{CI};
+
+        // The fence is never signaled, so the destructor must not wait for the request
+        Service.Enqueue(pFence, 1, [&]() { ++NumCalls; });
+        EXPECT_EQ(Service.GetNumPendingRequests(), size_t{1});
+    }
+    EXPECT_EQ(NumCalls, 0u);
+}
+
+} // namespace
@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GPUProfiler.hpp"
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(GPUProfilerTest, NestedScopes)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().Features.TimestampQueries)
+    {
+        GTEST_SKIP() << "Timestamp queries are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    GPUProfiler::CreateInfo CI;
+    CI.pDevice             = pDevice;
+    CI.pCalibrationCtx     = pContext;
+    CI.NumQueriesToReserve = 8;
+
+    GPUProfiler Profiler{CI};
+
+    // Query data may not become available immediately, so keep rendering
+    // frames until one of them is resolved.
+    GPUProfiler::FrameData Frame;
+    for (Uint32 frame = 0; frame < 100 && !Profiler.GetLastResolvedFrame(Frame); ++frame)
+    {
+        Profiler.BeginFrame();
+        {
+            GPUProfiler::Scope FrameScope{Profiler, pContext, "Frame"};
+            {
+                GPUProfiler::Scope Pass0{Profiler, pContext, "Pass 0"};
+                GPUProfiler::Scope Draw{Profiler, pContext, "Draw"};
+            }
+            {
+                GPUProfiler::Scope Pass1{Profiler, pContext, "Pass 1"};
+            }
+        }
+        Profiler.EndFrame();
+
+        pContext->Flush();
+        pContext->FinishFrame();
+        pContext->WaitForIdle();
+    }
+    ASSERT_TRUE(Profiler.GetLastResolvedFrame(Frame));
+
+    ASSERT_EQ(Frame.Scopes.size(), size_t{4});
+    EXPECT_EQ(Frame.Scopes[0].Name, "Frame");
+    EXPECT_EQ(Frame.Scopes[0].Depth, 0u);
+    EXPECT_EQ(Frame.Scopes[0].ParentIndex, Uint32{GPUProfiler::InvalidIndex});
+    EXPECT_EQ(Frame.Scopes[1].Name, "Pass 0");
+    EXPECT_EQ(Frame.Scopes[1].ParentIndex, 0u);
+    EXPECT_EQ(Frame.Scopes[2].Name, "Draw");
+    EXPECT_EQ(Frame.Scopes[2].Depth, 2u);
+    EXPECT_EQ(Frame.Scopes[2].ParentIndex, 1u);
+    EXPECT_EQ(Frame.Scopes[3].Name, "Pass 1");
+    EXPECT_EQ(Frame.Scopes[3].ParentIndex, 0u);
+    for (const auto& Scope : Frame.Scopes)
+    {
+        EXPECT_LE(Scope.StartTime, Scope.EndTime);
+    }
+
+    const auto Trace = Profiler.GetChromeTrace();
+    EXPECT_NE(Trace.find("\"name\":\"Draw\""), std::string::npos);
+    EXPECT_EQ(Profiler.GetContextNames().size(), size_t{1});
+}
+
+} // namespace
@@ -130,4 +130,93 @@ TEST(GenerateMipsTest, GenerateMips)
     }
 }
 
+TEST(GenerateMipsTest, GenerateMipsBatch)
+{
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    struct TexInfo
+    {
+        TEXTURE_FORMAT Format;
+        Uint32         Width;
+        Uint32         Height;
+    };
+    // Mix formats and sizes, including odd dimensions and textures with different number of mip levels
+    const TexInfo TestTextures[] = //
+        {
+            {TEX_FORMAT_RGBA8_UNORM, 256, 256},
+            {TEX_FORMAT_RGBA8_UNORM_SRGB, 128 + 6, 128 + 5},
+            {TEX_FORMAT_RGBA8_UNORM, 64, 32},
+            {TEX_FORMAT_RGBA32_FLOAT, 100, 60},
+            {TEX_FORMAT_RGBA8_UNORM_SRGB, 256, 256},
+            {TEX_FORMAT_RGBA8_UNORM, 17, 9} //
+        };
+
+    std::vector<RefCntAutoPtr<ITexture>>     Textures;
+    std::vector<RefCntAutoPtr<ITextureView>> ArraySliceViews;
+    std::vector<ITextureView*>               Views;
+    for (const auto& Info : TestTextures)
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Mips generation batch test texture";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Format    = Info.Format;
+        TexDesc.Width     = Info.Width;
+        TexDesc.Height    = Info.Height;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+        TexDesc.MipLevels = 0;
+        TexDesc.Usage     = USAGE_DEFAULT;
+        TexDesc.MiscFlags = MISC_TEXTURE_FLAG_GENERATE_MIPS;
+
+        RefCntAutoPtr<ITexture> pTex;
+        pDevice->CreateTexture(TexDesc, nullptr, &pTex);
+        ASSERT_NE(pTex, nullptr) << "Failed to create texture: " << TexDesc;
+
+        Views.push_back(pTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        Textures.emplace_back(std::move(pTex));
+    }
+
+    // Two views that address different array slices of the same texture
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Mips generation batch test texture array";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D_ARRAY;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.Width     = 128;
+        TexDesc.Height    = 128;
+        TexDesc.ArraySize = 4;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+        TexDesc.MipLevels = 0;
+        TexDesc.Usage     = USAGE_DEFAULT;
+        TexDesc.MiscFlags = MISC_TEXTURE_FLAG_GENERATE_MIPS;
+
+        RefCntAutoPtr<ITexture> pTex;
+        pDevice->CreateTexture(TexDesc, nullptr, &pTex);
+        ASSERT_NE(pTex, nullptr) << "Failed to create texture array: " << TexDesc;
+
+        for (Uint32 Slice = 0; Slice < 2; ++Slice)
+        {
+            TextureViewDesc ViewDesc{nullptr, TEXTURE_VIEW_SHADER_RESOURCE, RESOURCE_DIM_TEX_2D_ARRAY};
+            ViewDesc.FirstArraySlice = Slice * 2;
+            ViewDesc.NumArraySlices  = 2;
+            ViewDesc.Flags           = TEXTURE_VIEW_FLAG_ALLOW_MIP_MAP_GENERATION;
+            RefCntAutoPtr<ITextureView> pTexView;
+            pTex->CreateView(ViewDesc, &pTexView);
+            ASSERT_NE(pTexView, nullptr) << "Failed to create SRV for texture array: " << TexDesc;
+            Views.push_back(pTexView);
+            ArraySliceViews.emplace_back(std::move(pTexView));
+        }
+        Textures.emplace_back(std::move(pTex));
+    }
+
+    pContext->GenerateMipsBatch(Views.data(), static_cast<Uint32>(Views.size()));
+    pContext->GenerateMipsBatch(nullptr, 0);
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
 } // namespace
@@ -0,0 +1,134 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "IndirectDrawCompactor.hpp"
+
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+template <typename T>
+RefCntAutoPtr<IBuffer> CreateStructuredBuffer(IRenderDevice* pDevice, const char* Name, const std::vector<T>& Data)
+{
+    BufferDesc Desc;
+    Desc.Name              = Name;
+    Desc.Size              = sizeof(T) * Data.size();
+    Desc.Usage             = USAGE_IMMUTABLE;
+    Desc.BindFlags         = BIND_SHADER_RESOURCE;
+    Desc.Mode              = BUFFER_MODE_STRUCTURED;
+    Desc.ElementByteStride = sizeof(T);
+
+    BufferData InitData{Data.data(), Desc.Size};
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(Desc, &InitData, &pBuffer);
+    return pBuffer;
+}
+
+TEST(IndirectDrawCompactorTest, FrustumCulling)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    IndirectDrawCompactor::CreateInfo CI;
+    CI.pDevice   = pDevice;
+    CI.EnableHiZ = false;
+    IndirectDrawCompactor Compactor{CI};
+
+    // With the identity view-projection matrix, the frustum is the clip-space box
+    using Bounds                           = IndirectDrawCompactor::ObjectBounds;
+    const std::vector<Bounds> ObjectBounds = {
+        Bounds{float4{-0.5f, -0.5f, 0.25f, 0}, float4{0.5f, 0.5f, 0.75f, 0}}, // Inside
+        Bounds{float4{+2.0f, -0.5f, 0.25f, 0}, float4{3.0f, 0.5f, 0.75f, 0}}, // Outside
+        Bounds{float4{-0.5f, -0.5f, 0.25f, 0}, float4{0.5f, 0.5f, 0.75f, 0}}, // Inside, but has no instances
+        Bounds{float4{+0.5f, +0.5f, 0.25f, 0}, float4{1.5f, 1.5f, 0.75f, 0}}, // Intersecting
+    };
+    std::vector<IndirectDrawCompactor::DrawRecord> DrawRecords(ObjectBounds.size());
+    for (Uint32 i = 0; i < DrawRecords.size(); ++i)
+    {
+        DrawRecords[i].NumIndices         = 3;
+        DrawRecords[i].NumInstances       = (i == 2) ? 0 : 1;
+        DrawRecords[i].FirstIndexLocation = i * 3;
+    }
+
+    auto pBoundsBuffer      = CreateStructuredBuffer(pDevice, "Indirect draw compactor test bounds", ObjectBounds);
+    auto pDrawRecordsBuffer = CreateStructuredBuffer(pDevice, "Indirect draw compactor test draw records", DrawRecords);
+    ASSERT_NE(pBoundsBuffer, nullptr);
+    ASSERT_NE(pDrawRecordsBuffer, nullptr);
+
+    const auto NumObjects = static_cast<Uint32>(ObjectBounds.size());
+
+    RefCntAutoPtr<IBuffer> pArgsBuffer, pCountBuffer;
+    Compactor.CreateOutputBuffers(NumObjects, &pArgsBuffer, &pCountBuffer);
+    ASSERT_NE(pArgsBuffer, nullptr);
+    ASSERT_NE(pCountBuffer, nullptr);
+
+    const auto  ViewProj = float4x4::Identity();
+    ViewFrustum Frustum;
+    ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, pDevice->GetDeviceInfo().IsGLDevice());
+
+    IndirectDrawCompactor::CompactAttribs Attribs;
+    Attribs.pBoundsBuffer      = pBoundsBuffer;
+    Attribs.pDrawRecordsBuffer = pDrawRecordsBuffer;
+    Attribs.pArgsBuffer        = pArgsBuffer;
+    Attribs.pCountBuffer       = pCountBuffer;
+    Attribs.NumObjects         = NumObjects;
+    Attribs.pFrustum           = &Frustum;
+    Attribs.ViewProj           = ViewProj;
+    Compactor.Compact(pContext, Attribs);
+
+    const auto Count = pEnv->ReadBuffer<Uint32>(pCountBuffer, 1);
+    ASSERT_EQ(Count.size(), size_t{1});
+    ASSERT_EQ(Count[0], 2u);
+
+    // The order of the compacted records is not defined
+    const auto Args = pEnv->ReadBuffer<IndirectDrawCompactor::DrawRecord>(pArgsBuffer, Count[0]);
+    ASSERT_EQ(Args.size(), size_t{2});
+    Uint32 FirstIndices = Args[0].FirstIndexLocation + Args[1].FirstIndexLocation;
+    EXPECT_EQ(FirstIndices, 0u + 9u);
+    EXPECT_NE(Args[0].FirstIndexLocation, Args[1].FirstIndexLocation);
+
+    // Repeated compaction resets the count
+    Compactor.Compact(pContext, Attribs);
+    EXPECT_EQ(pEnv->ReadBuffer<Uint32>(pCountBuffer, 1)[0], 2u);
+}
+
+} // namespace
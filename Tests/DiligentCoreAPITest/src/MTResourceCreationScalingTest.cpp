@@ -0,0 +1,542 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <thread>
+#include <atomic>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+#    include "WinHPreface.h"
+#    include <Windows.h>
+#    include "WinHPostface.h"
+#    define HAS_THREAD_CPU_TIME 1
+#elif PLATFORM_LINUX || PLATFORM_ANDROID || PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS
+#    include <time.h>
+#    define HAS_THREAD_CPU_TIME 1
+#endif
+
+#include "GPUTestingEnvironment.hpp"
+#include "Timer.hpp"
+#if D3D12_SUPPORTED
+#    include "D3D12/D3D12DebugLayerSetNameBugWorkaround.hpp"
+#endif
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// This test creates the same mix of objects from 1, 2, 4, ... N threads and reports
+// per-category throughput and the time the worker threads spent blocked, which is
+// dominated by waiting for the locks inside the engine. Compare the reports before and
+// after a change to verify that it reduces the contention and does not regress scaling.
+// The numbers are also recorded as test properties (see --gtest_output=xml).
+
+static const char g_TrivialShaderSource[] = R"(
+void VSMain(out float4 pos : SV_POSITION)
+{
+    pos = float4(0.0, 0.0, 0.0, 0.0);
+}
+
+void PSMain(out float4 col : SV_TARGET)
+{
+    col = float4(0.0, 0.0, 0.0, 0.0);
+}
+)";
+
+static const char g_ResourceShaderSource[] = R"(
+cbuffer cbConstants
+{
+    float4 g_Color;
+}
+
+Texture2D    g_Texture;
+SamplerState g_Texture_sampler;
+
+void PSMain(in float4 pos : SV_POSITION, out float4 col : SV_TARGET)
+{
+    col = g_Texture.Sample(g_Texture_sampler, float2(0.5, 0.5)) * g_Color;
+}
+)";
+
+enum WORKLOAD : Uint32
+{
+    WORKLOAD_BUFFERS = 0,
+    WORKLOAD_TEXTURES,
+    WORKLOAD_VIEWS,
+    WORKLOAD_SAMPLERS,
+    WORKLOAD_SRBS,
+    WORKLOAD_PSOS,
+    WORKLOAD_COUNT
+};
+
+const char* GetWorkloadName(Uint32 Workload)
+{
+    static constexpr const char* Names[] = {"Buffers", "Textures", "Views", "Samplers", "SRBs", "PSOs"};
+    static_assert(_countof(Names) == WORKLOAD_COUNT, "Please update the names array");
+    return Names[Workload];
+}
+
+constexpr Uint32 NumObjectsPerIteration[] = {
+    16, // Buffers
+    4,  // Textures
+    8,  // Views
+    16, // Samplers
+    32, // SRBs
+    2,  // PSOs
+};
+static_assert(_countof(NumObjectsPerIteration) == WORKLOAD_COUNT, "Please update the object counts array");
+
+#ifdef DILIGENT_DEBUG
+constexpr Uint32 NumIterations = 2;
+#else
+constexpr Uint32 NumIterations = 8;
+#endif
+
+// Returns the CPU time, in seconds, consumed by the calling thread.
+double GetThreadCPUTime()
+{
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+    FILETIME CreationTime, ExitTime, KernelTime, UserTime;
+    if (!GetThreadTimes(GetCurrentThread(), &CreationTime, &ExitTime, &KernelTime, &UserTime))
+        return 0;
+
+    // FILETIME is measured in 100-nanosecond intervals
+    const auto Ticks = (static_cast<Uint64>(KernelTime.dwHighDateTime) << 32u) + KernelTime.dwLowDateTime +
+        (static_cast<Uint64>(UserTime.dwHighDateTime) << 32u) + UserTime.dwLowDateTime;
+    return static_cast<double>(Ticks) * 1e-7;
+#elif HAS_THREAD_CPU_TIME
+    timespec Time{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &Time) != 0)
+        return 0;
+    return static_cast<double>(Time.tv_sec) + static_cast<double>(Time.tv_nsec) * 1e-9;
+#else
+    // Not available - the blocked time is not reported
+    return 0;
+#endif
+}
+
+struct WorkloadStats
+{
+    Uint32 NumObjects = 0;
+
+    // Wall-clock time spent in the workload
+    double WallTime = 0;
+
+    // The part of the wall-clock time when the thread was not running,
+    // i.e. was waiting for a lock, an allocation, or was preempted.
+    // Note that spin-waiting is not included.
+    double BlockedTime = 0;
+
+    WorkloadStats& operator+=(const WorkloadStats& RHS)
+    {
+        NumObjects += RHS.NumObjects;
+        WallTime += RHS.WallTime;
+        BlockedTime += RHS.BlockedTime;
+        return *this;
+    }
+};
+
+using ThreadStats = std::array<WorkloadStats, WORKLOAD_COUNT>;
+
+class ScopedWorkloadTimer
+{
+public:
+    explicit ScopedWorkloadTimer(WorkloadStats& Stats) :
+        m_Stats{Stats},
+        m_StartCPUTime{GetThreadCPUTime()}
+    {}
+
+    ~ScopedWorkloadTimer()
+    {
+        const auto WallTime = m_Timer.GetElapsedTime();
+        const auto CPUTime  = GetThreadCPUTime() - m_StartCPUTime;
+        m_Stats.WallTime += WallTime;
+        m_Stats.BlockedTime += std::max(WallTime - CPUTime, 0.0);
+    }
+
+private:
+    WorkloadStats& m_Stats;
+    Timer          m_Timer;
+    const double   m_StartCPUTime;
+};
+
+class MultithreadedResourceCreationScalingTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        auto* pEnv    = GPUTestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+
+        ShaderCI.Source     = g_TrivialShaderSource;
+        ShaderCI.EntryPoint = "VSMain";
+        ShaderCI.Desc       = {"Trivial VS (MTResourceCreationScalingTest)", SHADER_TYPE_VERTEX, true};
+        pDevice->CreateShader(ShaderCI, &sm_pTrivialVS);
+        ASSERT_NE(sm_pTrivialVS, nullptr);
+
+        ShaderCI.EntryPoint = "PSMain";
+        ShaderCI.Desc       = {"Trivial PS (MTResourceCreationScalingTest)", SHADER_TYPE_PIXEL, true};
+        pDevice->CreateShader(ShaderCI, &sm_pTrivialPS);
+        ASSERT_NE(sm_pTrivialPS, nullptr);
+
+        ShaderCI.Source = g_ResourceShaderSource;
+        ShaderCI.Desc   = {"Resource PS (MTResourceCreationScalingTest)", SHADER_TYPE_PIXEL, true};
+        RefCntAutoPtr<IShader> pResourcePS;
+        pDevice->CreateShader(ShaderCI, &pResourcePS);
+        ASSERT_NE(pResourcePS, nullptr);
+
+        // The PSO with resources is created once on the main thread and is only used to create SRBs.
+        // Worker threads create PSOs with trivial shaders that use an empty root signature in D3D12,
+        // see D3D12DebugLayerSetNameBugWorkaround.
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+        InitTrivialPSOCreateInfo(PSOCreateInfo, "MT creation scaling test SRB PSO");
+        PSOCreateInfo.pPS = pResourcePS;
+
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &sm_pSRBPSO);
+        ASSERT_NE(sm_pSRBPSO, nullptr);
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pTrivialVS.Release();
+        sm_pTrivialPS.Release();
+        sm_pSRBPSO.Release();
+    }
+
+    static void InitTrivialPSOCreateInfo(GraphicsPipelineStateCreateInfo& PSOCreateInfo, const char* Name)
+    {
+        auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+        PSOCreateInfo.PSODesc.Name         = Name;
+        PSOCreateInfo.pVS                  = sm_pTrivialVS;
+        PSOCreateInfo.pPS                  = sm_pTrivialPS;
+        GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+        GraphicsPipeline.NumRenderTargets  = 1;
+        GraphicsPipeline.RTVFormats[0]     = TEX_FORMAT_RGBA8_UNORM;
+        GraphicsPipeline.DSVFormat         = TEX_FORMAT_D32_FLOAT;
+    }
+
+    static void RunWorkload(ThreadStats& Stats);
+
+    static ThreadStats RunThreads(Uint32 NumThreads, double& ElapsedTime);
+
+    static RefCntAutoPtr<IShader>        sm_pTrivialVS;
+    static RefCntAutoPtr<IShader>        sm_pTrivialPS;
+    static RefCntAutoPtr<IPipelineState> sm_pSRBPSO;
+};
+
+RefCntAutoPtr<IShader>        MultithreadedResourceCreationScalingTest::sm_pTrivialVS;
+RefCntAutoPtr<IShader>        MultithreadedResourceCreationScalingTest::sm_pTrivialPS;
+RefCntAutoPtr<IPipelineState> MultithreadedResourceCreationScalingTest::sm_pSRBPSO;
+
+void MultithreadedResourceCreationScalingTest::RunWorkload(ThreadStats& Stats)
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+
+    constexpr Uint32 BufferSize = 1024;
+    constexpr Uint32 TexSize    = 256;
+
+    std::vector<Uint8> RawBufferData(BufferSize);
+
+    std::vector<RefCntAutoPtr<IBuffer>> Buffers(NumObjectsPerIteration[WORKLOAD_BUFFERS]);
+    {
+        ScopedWorkloadTimer WorkloadTimer{Stats[WORKLOAD_BUFFERS]};
+        for (size_t i = 0; i < Buffers.size(); ++i)
+        {
+            // Alternate uniform and formatted buffers
+            BufferDesc BuffDesc;
+            BuffDesc.Name  = "MT creation scaling test buffer";
+            BuffDesc.Usage = USAGE_DEFAULT;
+            BuffDesc.Size  = BufferSize;
+            if (i % 2 == 0)
+            {
+                BuffDesc.BindFlags = BIND_UNIFORM_BUFFER;
+            }
+            else
+            {
+                BuffDesc.BindFlags         = BIND_SHADER_RESOURCE;
+                BuffDesc.Mode              = BUFFER_MODE_FORMATTED;
+                BuffDesc.ElementByteStride = 16;
+            }
+
+            BufferData BuffData{RawBufferData.data(), BufferSize};
+            pDevice->CreateBuffer(BuffDesc, &BuffData, &Buffers[i]);
+            EXPECT_NE(Buffers[i], nullptr) << "Failed to create the following buffer:\n"
+                                           << BuffDesc;
+        }
+        Stats[WORKLOAD_BUFFERS].NumObjects += static_cast<Uint32>(Buffers.size());
+    }
+
+    std::vector<RefCntAutoPtr<ITexture>> Textures(NumObjectsPerIteration[WORKLOAD_TEXTURES]);
+    {
+        ScopedWorkloadTimer WorkloadTimer{Stats[WORKLOAD_TEXTURES]};
+        for (auto& pTexture : Textures)
+        {
+            TextureDesc TexDesc;
+            TexDesc.Name      = "MT creation scaling test texture";
+            TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+            TexDesc.Width     = TexSize;
+            TexDesc.Height    = TexSize;
+            TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+            TexDesc.MipLevels = 1;
+            TexDesc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
+
+            pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+            EXPECT_NE(pTexture, nullptr) << "Failed to create the following texture:\n"
+                                         << TexDesc;
+        }
+        Stats[WORKLOAD_TEXTURES].NumObjects += static_cast<Uint32>(Textures.size());
+    }
+
+    std::vector<RefCntAutoPtr<IDeviceObject>> Views(NumObjectsPerIteration[WORKLOAD_VIEWS]);
+    {
+        ScopedWorkloadTimer WorkloadTimer{Stats[WORKLOAD_VIEWS]};
+        for (size_t i = 0; i < Views.size(); ++i)
+        {
+            // Alternate texture and formatted buffer views
+            if (i % 2 == 0)
+            {
+                auto* pTexture = Textures[(i / 2) % Textures.size()].RawPtr();
+                if (pTexture == nullptr)
+                    continue;
+
+                TextureViewDesc ViewDesc;
+                ViewDesc.Name         = "MT creation scaling test texture view";
+                ViewDesc.ViewType     = TEXTURE_VIEW_SHADER_RESOURCE;
+                ViewDesc.NumMipLevels = 1;
+
+                RefCntAutoPtr<ITextureView> pView;
+                pTexture->CreateView(ViewDesc, &pView);
+                EXPECT_NE(pView, nullptr) << "Failed to create texture view";
+                Views[i] = pView;
+            }
+            else
+            {
+                auto* pBuffer = Buffers[(i | 1) % Buffers.size()].RawPtr();
+                if (pBuffer == nullptr)
+                    continue;
+
+                BufferViewDesc ViewDesc;
+                ViewDesc.Name                 = "MT creation scaling test buffer view";
+                ViewDesc.ViewType             = BUFFER_VIEW_SHADER_RESOURCE;
+                ViewDesc.Format.NumComponents = 4;
+                ViewDesc.Format.ValueType     = VT_FLOAT32;
+
+                RefCntAutoPtr<IBufferView> pView;
+                pBuffer->CreateView(ViewDesc, &pView);
+                EXPECT_NE(pView, nullptr) << "Failed to create buffer view";
+                Views[i] = pView;
+            }
+        }
+        Stats[WORKLOAD_VIEWS].NumObjects += static_cast<Uint32>(Views.size());
+    }
+
+    {
+        ScopedWorkloadTimer WorkloadTimer{Stats[WORKLOAD_SAMPLERS]};
+        for (Uint32 i = 0; i < NumObjectsPerIteration[WORKLOAD_SAMPLERS]; ++i)
+        {
+            // Samplers are deduplicated by the device, so most of the requests
+            // look up the existing objects in the registry.
+            SamplerDesc SamDesc;
+            SamDesc.Name       = "MT creation scaling test sampler";
+            SamDesc.MipLODBias = static_cast<float>(i % 4);
+
+            RefCntAutoPtr<ISampler> pSampler;
+            pDevice->CreateSampler(SamDesc, &pSampler);
+            EXPECT_NE(pSampler, nullptr) << "Failed to create sampler";
+        }
+        Stats[WORKLOAD_SAMPLERS].NumObjects += NumObjectsPerIteration[WORKLOAD_SAMPLERS];
+    }
+
+    {
+        ScopedWorkloadTimer WorkloadTimer{Stats[WORKLOAD_SRBS]};
+        for (Uint32 i = 0; i < NumObjectsPerIteration[WORKLOAD_SRBS]; ++i)
+        {
+            RefCntAutoPtr<IShaderResourceBinding> pSRB;
+            sm_pSRBPSO->CreateShaderResourceBinding(&pSRB);
+            EXPECT_NE(pSRB, nullptr) << "Failed to create SRB";
+        }
+        Stats[WORKLOAD_SRBS].NumObjects += NumObjectsPerIteration[WORKLOAD_SRBS];
+    }
+
+    {
+        ScopedWorkloadTimer WorkloadTimer{Stats[WORKLOAD_PSOS]};
+        for (Uint32 i = 0; i < NumObjectsPerIteration[WORKLOAD_PSOS]; ++i)
+        {
+            GraphicsPipelineStateCreateInfo PSOCreateInfo;
+            InitTrivialPSOCreateInfo(PSOCreateInfo, "MT creation scaling test PSO");
+
+            RefCntAutoPtr<IPipelineState> pPSO;
+            pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+            EXPECT_NE(pPSO, nullptr) << "Failed to create PSO";
+        }
+        Stats[WORKLOAD_PSOS].NumObjects += NumObjectsPerIteration[WORKLOAD_PSOS];
+    }
+}
+
+ThreadStats MultithreadedResourceCreationScalingTest::RunThreads(Uint32 NumThreads, double& ElapsedTime)
+{
+    std::vector<ThreadStats> Stats(NumThreads);
+    std::vector<std::thread> Threads(NumThreads);
+
+    std::atomic<Uint32> NumThreadsReady{0};
+    std::atomic<bool>   Start{false};
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads[t] = std::thread{
+            [&](ThreadStats& WorkerStats) {
+                ++NumThreadsReady;
+                while (!Start.load())
+                    std::this_thread::yield();
+
+                for (Uint32 iter = 0; iter < NumIterations; ++iter)
+                    RunWorkload(WorkerStats);
+            },
+            std::ref(Stats[t]) //
+        };
+    }
+
+    while (NumThreadsReady.load() < NumThreads)
+        std::this_thread::yield();
+
+    Timer RunTimer;
+    Start.store(true);
+    for (auto& Thread : Threads)
+        Thread.join();
+    ElapsedTime = RunTimer.GetElapsedTime();
+
+    ThreadStats TotalStats;
+    for (const auto& WorkerStats : Stats)
+    {
+        for (Uint32 w = 0; w < WORKLOAD_COUNT; ++w)
+            TotalStats[w] += WorkerStats[w];
+    }
+    return TotalStats;
+}
+
+TEST_F(MultithreadedResourceCreationScalingTest, CreateResources)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (pDevice->GetDeviceInfo().IsGLDevice())
+    {
+        GTEST_SKIP() << "Multithreading resource creation is not supported in OpenGL";
+    }
+
+#if D3D12_SUPPORTED
+    D3D12DebugLayerSetNameBugWorkaround D3D12DebugLayerBugWorkaround(pDevice);
+#endif
+
+    ASSERT_TRUE(sm_pSRBPSO) << "Failed to create the SRB PSO";
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    const Uint32 MaxThreads = std::max(std::thread::hardware_concurrency(), 2u);
+
+    std::vector<Uint32> ThreadCounts;
+    for (Uint32 NumThreads = 1; NumThreads < MaxThreads; NumThreads *= 2)
+        ThreadCounts.push_back(NumThreads);
+    ThreadCounts.push_back(MaxThreads);
+
+    // Warm up the device so that the first run does not pay for the initial allocations
+    {
+        double ElapsedTime = 0;
+        RunThreads(1, ElapsedTime);
+        pEnv->ReleaseResources();
+    }
+
+    std::array<double, WORKLOAD_COUNT> BaseThroughput{};
+
+    std::stringstream ss;
+    ss << "Multithreaded resource creation scaling (" << NumIterations << " iterations per thread):\n"
+       << "Threads  Workload     Objects    Obj/s   Scaling  Blocked ms/thread  Blocked %\n";
+    for (auto NumThreads : ThreadCounts)
+    {
+        double      ElapsedTime = 0;
+        const auto  Stats       = RunThreads(NumThreads, ElapsedTime);
+        std::string Prefix      = "Threads" + std::to_string(NumThreads) + ".";
+
+        Uint32 TotalObjects = 0;
+        for (Uint32 w = 0; w < WORKLOAD_COUNT; ++w)
+        {
+            const auto& WlStats = Stats[w];
+            TotalObjects += WlStats.NumObjects;
+
+            // All threads run the same workloads in the same order, so the workloads of
+            // different threads overlap and the average per-thread time approximates the
+            // wall-clock time of the workload.
+            const auto AvgWallTime = WlStats.WallTime / NumThreads;
+            const auto Throughput  = AvgWallTime > 0 ? WlStats.NumObjects / AvgWallTime : 0.0;
+            if (NumThreads == 1)
+                BaseThroughput[w] = Throughput;
+            const auto Scaling = BaseThroughput[w] > 0 ? Throughput / BaseThroughput[w] : 0.0;
+
+            const auto BlockedTimePerThread = WlStats.BlockedTime / NumThreads;
+            const auto BlockedPercent       = WlStats.WallTime > 0 ? WlStats.BlockedTime / WlStats.WallTime * 100.0 : 0.0;
+
+            ss << std::setw(7) << NumThreads << "  " << std::left << std::setw(10) << GetWorkloadName(w) << std::right
+               << std::setw(10) << WlStats.NumObjects
+               << std::setw(9) << static_cast<Uint32>(Throughput)
+               << std::setw(10) << std::fixed << std::setprecision(2) << Scaling;
+#if HAS_THREAD_CPU_TIME
+            ss << std::setw(19) << std::setprecision(2) << BlockedTimePerThread * 1000.0
+               << std::setw(11) << std::setprecision(1) << BlockedPercent;
+#else
+            ss << std::setw(19) << "n/a" << std::setw(11) << "n/a";
+#endif
+            ss << '\n';
+
+            const std::string Key = Prefix + GetWorkloadName(w);
+            RecordProperty(Key + ".ObjPerSec", static_cast<int>(Throughput));
+            RecordProperty(Key + ".BlockedUsPerThread", static_cast<int>(BlockedTimePerThread * 1e+6));
+        }
+        const auto TotalThroughput = ElapsedTime > 0 ? TotalObjects / ElapsedTime : 0.0;
+        ss << std::setw(7) << NumThreads << "  " << std::left << std::setw(10) << "Total" << std::right
+           << std::setw(10) << TotalObjects
+           << std::setw(9) << static_cast<Uint32>(TotalThroughput) << '\n';
+        RecordProperty(Prefix + "Total.ObjPerSec", static_cast<int>(TotalThroughput));
+
+        pEnv->ReleaseResources();
+    }
+
+    LOG_INFO_MESSAGE(ss.str());
+}
+
+} // namespace
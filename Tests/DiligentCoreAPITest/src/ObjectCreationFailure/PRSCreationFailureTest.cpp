@@ -178,7 +178,7 @@ TEST(PRSCreationFailureTest, InvalidTexSRVFlag)
         {SHADER_TYPE_VERTEX, "g_Texture2", 1, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_STATIC, PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS | PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER | PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER}};
     PRSDesc.Resources    = Resources;
     PRSDesc.NumResources = _countof(Resources);
-    TestCreatePRSFailure(PRSDesc, "Incorrect Desc.Resources[1].Flags (NO_DYNAMIC_BUFFERS|COMBINED_SAMPLER|FORMATTED_BUFFER). Only the following flags are valid for a texture SRV: COMBINED_SAMPLER, RUNTIME_ARRAY");
+    TestCreatePRSFailure(PRSDesc, "Incorrect Desc.Resources[1].Flags (NO_DYNAMIC_BUFFERS|COMBINED_SAMPLER|FORMATTED_BUFFER). Only the following flags are valid for a texture SRV: COMBINED_SAMPLER, RUNTIME_ARRAY, BINDLESS");
 }
 
 TEST(PRSCreationFailureTest, InvalidBuffSRVFlag)
@@ -190,7 +190,7 @@ TEST(PRSCreationFailureTest, InvalidBuffSRVFlag)
         {SHADER_TYPE_VERTEX, "g_Buffer", 1, SHADER_RESOURCE_TYPE_BUFFER_SRV, SHADER_RESOURCE_VARIABLE_TYPE_STATIC, PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER}};
     PRSDesc.Resources    = Resources;
     PRSDesc.NumResources = _countof(Resources);
-    TestCreatePRSFailure(PRSDesc, "Incorrect Desc.Resources[1].Flags (COMBINED_SAMPLER). Only the following flags are valid for a buffer SRV: NO_DYNAMIC_BUFFERS, FORMATTED_BUFFER, RUNTIME_ARRAY");
+    TestCreatePRSFailure(PRSDesc, "Incorrect Desc.Resources[1].Flags (COMBINED_SAMPLER). Only the following flags are valid for a buffer SRV: NO_DYNAMIC_BUFFERS, FORMATTED_BUFFER, RUNTIME_ARRAY, BINDLESS");
 }
 
 TEST(PRSCreationFailureTest, InvalidTexUAVFlag)
@@ -202,7 +202,7 @@ TEST(PRSCreationFailureTest, InvalidTexUAVFlag)
         {SHADER_TYPE_VERTEX, "g_Texture2", 1, SHADER_RESOURCE_TYPE_TEXTURE_UAV, SHADER_RESOURCE_VARIABLE_TYPE_STATIC, PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER}};
     PRSDesc.Resources    = Resources;
     PRSDesc.NumResources = _countof(Resources);
-    TestCreatePRSFailure(PRSDesc, "Incorrect Desc.Resources[1].Flags (COMBINED_SAMPLER). Only the following flags are valid for a texture UAV: RUNTIME_ARRAY");
+    TestCreatePRSFailure(PRSDesc, "Incorrect Desc.Resources[1].Flags (COMBINED_SAMPLER). Only the following flags are valid for a texture UAV: RUNTIME_ARRAY, BINDLESS");
 }
 
 TEST(PRSCreationFailureTest, InvalidBuffUAVFlag)
@@ -214,7 +214,7 @@ TEST(PRSCreationFailureTest, InvalidBuffUAVFlag)
         {SHADER_TYPE_VERTEX, "g_Buffer", 1, SHADER_RESOURCE_TYPE_BUFFER_UAV, SHADER_RESOURCE_VARIABLE_TYPE_STATIC, PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER | PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER}};
     PRSDesc.Resources    = Resources;
     PRSDesc.NumResources = _countof(Resources);
-    TestCreatePRSFailure(PRSDesc, "Incorrect Desc.Resources[1].Flags (COMBINED_SAMPLER|FORMATTED_BUFFER). Only the following flags are valid for a buffer UAV: NO_DYNAMIC_BUFFERS, FORMATTED_BUFFER, RUNTIME_ARRAY");
+    TestCreatePRSFailure(PRSDesc, "Incorrect Desc.Resources[1].Flags (COMBINED_SAMPLER|FORMATTED_BUFFER). Only the following flags are valid for a buffer UAV: NO_DYNAMIC_BUFFERS, FORMATTED_BUFFER, RUNTIME_ARRAY, BINDLESS");
 }
 
 TEST(PRSCreationFailureTest, InvalidSamplerFlag)
@@ -265,6 +265,89 @@ TEST(PRSCreationFailureTest, InvalidAccelStructFlag)
     TestCreatePRSFailure(PRSDesc, ExpectedErrorSubstring);
 }
 
+TEST(PRSCreationFailureTest, InvalidBindlessFlag)
+{
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name = "Invalid bindless Flag";
+    PipelineResourceDesc Resources[]{
+        {SHADER_TYPE_PIXEL, "g_Texture", 1, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+        {SHADER_TYPE_PIXEL, "g_Textures", 256, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, PIPELINE_RESOURCE_FLAG_BINDLESS}};
+    PRSDesc.Resources    = Resources;
+    PRSDesc.NumResources = _countof(Resources);
+    const char* ExpectedErrorSubstring;
+    if (GPUTestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo().IsVulkanDevice())
+        ExpectedErrorSubstring = "Desc.Resources[1].Flags contain BINDLESS, but the variable type is dynamic";
+    else
+        ExpectedErrorSubstring = "Desc.Resources[1].Flags contain BINDLESS which is only valid in Vulkan";
+
+    TestCreatePRSFailure(PRSDesc, ExpectedErrorSubstring);
+}
+
+TEST(PRSCreationFailureTest, BindlessWithDynamicBuffer)
+{
+    if (!GPUTestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo().IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Vulkan only";
+    }
+
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name = "Bindless with dynamic buffer";
+    PipelineResourceDesc Resources[]{
+        {SHADER_TYPE_PIXEL, "g_Buffer", 1, SHADER_RESOURCE_TYPE_BUFFER_SRV, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        {SHADER_TYPE_PIXEL, "g_Buffers", 256, SHADER_RESOURCE_TYPE_BUFFER_SRV, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, PIPELINE_RESOURCE_FLAG_BINDLESS}};
+    PRSDesc.Resources    = Resources;
+    PRSDesc.NumResources = _countof(Resources);
+    TestCreatePRSFailure(PRSDesc, "Desc.Resources[1].Flags contain BINDLESS, but neither NO_DYNAMIC_BUFFERS nor FORMATTED_BUFFER flag is set");
+}
+
+TEST(PRSCreationFailureTest, InvalidNumInlineConstants)
+{
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name = "Invalid number of inline constants";
+    PipelineResourceDesc Resources[]{
+        {SHADER_TYPE_PIXEL, "g_Texture", 1, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+        {SHADER_TYPE_PIXEL, "cbConstants", 1, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS, MAX_INLINE_CONSTANTS + 1}};
+    PRSDesc.Resources    = Resources;
+    PRSDesc.NumResources = _countof(Resources);
+    TestCreatePRSFailure(PRSDesc, "Desc.Resources[1].NumInlineConstants (65) must be in range [1, 64] for resources with INLINE_CONSTANTS flag");
+}
+
+TEST(PRSCreationFailureTest, InlineConstantsArray)
+{
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name = "Inline constants array";
+    PipelineResourceDesc Resources[]{
+        {SHADER_TYPE_PIXEL, "g_Texture", 1, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+        {SHADER_TYPE_PIXEL, "cbConstants", 2, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS, 4}};
+    PRSDesc.Resources    = Resources;
+    PRSDesc.NumResources = _countof(Resources);
+    TestCreatePRSFailure(PRSDesc, "Desc.Resources[1].Flags contain INLINE_CONSTANTS, but ArraySize is 2");
+}
+
+TEST(PRSCreationFailureTest, StaticInlineConstants)
+{
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name = "Static inline constants";
+    PipelineResourceDesc Resources[]{
+        {SHADER_TYPE_PIXEL, "g_Texture", 1, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+        {SHADER_TYPE_PIXEL, "cbConstants", 1, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_STATIC, PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS, 4}};
+    PRSDesc.Resources    = Resources;
+    PRSDesc.NumResources = _countof(Resources);
+    TestCreatePRSFailure(PRSDesc, "Desc.Resources[1].Flags contain INLINE_CONSTANTS, but the variable type is STATIC");
+}
+
+TEST(PRSCreationFailureTest, NumInlineConstantsWithoutFlag)
+{
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name = "Inline constants without flag";
+    PipelineResourceDesc Resources[]{
+        {SHADER_TYPE_PIXEL, "g_Texture", 1, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+        {SHADER_TYPE_PIXEL, "cbConstants", 1, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, PIPELINE_RESOURCE_FLAG_NONE, 4}};
+    PRSDesc.Resources    = Resources;
+    PRSDesc.NumResources = _countof(Resources);
+    TestCreatePRSFailure(PRSDesc, "Desc.Resources[1].NumInlineConstants is 4, but INLINE_CONSTANTS flag is not set");
+}
+
 TEST(PRSCreationFailureTest, InvalidCombinedSamplerFlag)
 {
     const auto& DeviceInfo = GPUTestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo();
@@ -0,0 +1,107 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+
+#include "OffscreenSwapChain.hpp"
+#include "ThreadPool.hpp"
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+void TestOffscreenSwapChain(IThreadPool* pThreadPool)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr Uint32 NumFrames = 8;
+
+    std::atomic<Uint32> NumFramesReady{0};
+    std::atomic<Uint32> NumMismatches{0};
+
+    OffscreenSwapChainCreateInfo CI;
+    CI.Desc.Width             = 64;
+    CI.Desc.Height            = 32;
+    CI.Desc.ColorBufferFormat = TEX_FORMAT_RGBA8_UNORM;
+    CI.Desc.BufferCount       = 3;
+    CI.Desc.IsPrimary         = false;
+    CI.pThreadPool            = pThreadPool;
+    CI.OnFrameReady           = [&](Uint64 FrameId, const AsyncReadbackQueue::ReadbackData& Data) {
+        // Every frame is cleared with the red channel equal to the frame index
+        const auto* pTexel = static_cast<const Uint8*>(Data.pData);
+        if (pTexel == nullptr || Data.Region.Width() != 64 || Data.Region.Height() != 32 || pTexel[0] != FrameId * 16 || pTexel[3] != 255)
+            ++NumMismatches;
+        ++NumFramesReady;
+    };
+
+    RefCntAutoPtr<ISwapChain> pSwapChain;
+    CreateOffscreenSwapChain(pDevice, pContext, CI, &pSwapChain);
+    ASSERT_NE(pSwapChain, nullptr);
+    ASSERT_NE(pSwapChain->GetCurrentBackBufferRTV(), nullptr);
+    ASSERT_NE(pSwapChain->GetDepthBufferDSV(), nullptr);
+
+    for (Uint32 frame = 0; frame < NumFrames; ++frame)
+    {
+        ITextureView* pRTV = pSwapChain->GetCurrentBackBufferRTV();
+        pContext->SetRenderTargets(1, &pRTV, pSwapChain->GetDepthBufferDSV(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        const float ClearColor[] = {static_cast<float>(frame * 16) / 255.f, 0, 0, 1};
+        pContext->ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+        pSwapChain->Present(0);
+    }
+
+    // Releasing the swap chain delivers all pending frames
+    pSwapChain.Release();
+    EXPECT_EQ(NumFramesReady.load(), NumFrames);
+    EXPECT_EQ(NumMismatches.load(), 0u);
+}
+
+TEST(OffscreenSwapChainTest, Present)
+{
+    TestOffscreenSwapChain(nullptr);
+}
+
+TEST(OffscreenSwapChainTest, PresentWithThreadPool)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+    TestOffscreenSwapChain(pThreadPool);
+}
+
+} // namespace
@@ -0,0 +1,209 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ParallelRecorder.hpp"
+#include "GPUTestingEnvironment.hpp"
+#include "MapHelper.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(ParallelRecorderTest, UpdateBuffer)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (pEnv->GetNumDeferredContexts() == 0)
+    {
+        GTEST_SKIP() << "Deferred contexts are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    std::vector<IDeviceContext*> DeferredCtxs;
+    for (size_t i = 0; i < pEnv->GetNumDeferredContexts(); ++i)
+        DeferredCtxs.push_back(pEnv->GetDeferredContext(i));
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{static_cast<Uint32>(DeferredCtxs.size())});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    ParallelRecorder::CreateInfo RecorderCI;
+    RecorderCI.pImmediateCtx      = pContext;
+    RecorderCI.ppDeferredCtxs     = DeferredCtxs.data();
+    RecorderCI.NumDeferredCtxs    = static_cast<Uint32>(DeferredCtxs.size());
+    RecorderCI.pThreadPool        = pThreadPool;
+    RecorderCI.MinItemsPerContext = 16;
+    ParallelRecorder Recorder{RecorderCI};
+
+    constexpr Uint32 NumValues = 256;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name  = "Parallel recorder test buffer";
+    BuffDesc.Size  = NumValues * sizeof(Uint32);
+    BuffDesc.Usage = USAGE_DEFAULT;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    BuffDesc.Name           = "Parallel recorder test staging buffer";
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    ASSERT_NE(pStagingBuffer, nullptr);
+
+    for (Uint32 frame = 0; frame < 2; ++frame)
+    {
+        std::vector<Uint32> RefData(NumValues);
+        for (Uint32 i = 0; i < NumValues; ++i)
+            RefData[i] = i * 3 + frame;
+
+        // Deferred contexts can't transition resources
+        StateTransitionDesc Barrier{pBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_DEST, STATE_TRANSITION_FLAG_UPDATE_STATE};
+        pContext->TransitionResourceStates(1, &Barrier);
+
+        std::vector<Uint32> RecordCount(NumValues);
+        Recorder.Record({}, NumValues,
+                        [&](IDeviceContext* pCtx, Uint32 WorkerIndex, Uint32 FirstItem, Uint32 NumItems) {
+                            EXPECT_EQ(pCtx, DeferredCtxs[WorkerIndex]);
+                            for (Uint32 i = FirstItem; i < FirstItem + NumItems; ++i)
+                            {
+                                pCtx->UpdateBuffer(pBuffer, i * sizeof(Uint32), sizeof(Uint32), &RefData[i], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+                                ++RecordCount[i];
+                            }
+                        });
+        Recorder.FinishFrame();
+
+        for (Uint32 i = 0; i < NumValues; ++i)
+            EXPECT_EQ(RecordCount[i], 1u) << "item " << i;
+
+        pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             pStagingBuffer, 0, NumValues * sizeof(Uint32), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->WaitForIdle();
+
+        MapHelper<Uint32> ReadBackData{pContext, pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT};
+        for (Uint32 i = 0; i < NumValues; ++i)
+            EXPECT_EQ(ReadBackData[i], RefData[i]) << "frame " << frame << ", value " << i;
+    }
+}
+
+TEST(ParallelRecorderTest, CommandListBatch)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (pEnv->GetNumDeferredContexts() == 0)
+    {
+        GTEST_SKIP() << "Deferred contexts are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    std::vector<IDeviceContext*> DeferredCtxs;
+    for (size_t i = 0; i < pEnv->GetNumDeferredContexts(); ++i)
+        DeferredCtxs.push_back(pEnv->GetDeferredContext(i));
+
+    ParallelRecorder::CreateInfo RecorderCI;
+    RecorderCI.pImmediateCtx      = pContext;
+    RecorderCI.ppDeferredCtxs     = DeferredCtxs.data();
+    RecorderCI.NumDeferredCtxs    = static_cast<Uint32>(DeferredCtxs.size());
+    RecorderCI.MinItemsPerContext = 16;
+    ParallelRecorder Recorder{RecorderCI};
+
+    constexpr Uint32 NumValues = 128;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name  = "Command list batch test buffer";
+    BuffDesc.Size  = NumValues * sizeof(Uint32);
+    BuffDesc.Usage = USAGE_DEFAULT;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    BuffDesc.Name           = "Command list batch test staging buffer";
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    ASSERT_NE(pStagingBuffer, nullptr);
+
+    StateTransitionDesc Barrier{pBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_DEST, STATE_TRANSITION_FLAG_UPDATE_STATE};
+    pContext->TransitionResourceStates(1, &Barrier);
+
+    std::vector<Uint32> RefData(NumValues);
+    for (Uint32 i = 0; i < NumValues; ++i)
+        RefData[i] = i * 7 + 1;
+
+    // The second pass overwrites the second half of the buffer written by the first pass,
+    // which verifies that the command lists of both passes are executed in order.
+    const std::vector<Uint32> FirstPassData(NumValues, 0xFFFFFFFFu);
+
+    CommandListBatch Batch;
+    Recorder.Record(
+        {}, NumValues,
+        [&](IDeviceContext* pCtx, Uint32 /*WorkerIndex*/, Uint32 FirstItem, Uint32 NumItems) {
+            for (Uint32 i = FirstItem; i < FirstItem + NumItems; ++i)
+            {
+                const auto* pData = i < NumValues / 2 ? &RefData[i] : &FirstPassData[i];
+                pCtx->UpdateBuffer(pBuffer, i * sizeof(Uint32), sizeof(Uint32), pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            }
+        },
+        &Batch);
+    Recorder.Record(
+        {}, NumValues / 2,
+        [&](IDeviceContext* pCtx, Uint32 /*WorkerIndex*/, Uint32 FirstItem, Uint32 NumItems) {
+            for (Uint32 i = NumValues / 2 + FirstItem; i < NumValues / 2 + FirstItem + NumItems; ++i)
+                pCtx->UpdateBuffer(pBuffer, i * sizeof(Uint32), sizeof(Uint32), &RefData[i], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        },
+        &Batch);
+
+    const auto NumCmdLists = Batch.GetNumSlots();
+    EXPECT_GE(NumCmdLists, 2u);
+    EXPECT_EQ(Batch.Execute(pContext), NumCmdLists);
+    EXPECT_EQ(Batch.GetNumSlots(), 0u);
+    Recorder.FinishFrame();
+
+    pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, NumValues * sizeof(Uint32), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    MapHelper<Uint32> ReadBackData{pContext, pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT};
+    for (Uint32 i = 0; i < NumValues; ++i)
+        EXPECT_EQ(ReadBackData[i], RefData[i]) << "value " << i;
+}
+
+} // namespace
@@ -0,0 +1,141 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "PassScheduler.hpp"
+#include "GPUTestingEnvironment.hpp"
+#include "MapHelper.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+IDeviceContext* FindAsyncComputeContext(GPUTestingEnvironment* pEnv, IDeviceContext* pGraphicsCtx)
+{
+    constexpr auto QueueTypeMask = COMMAND_QUEUE_TYPE_GRAPHICS | COMMAND_QUEUE_TYPE_COMPUTE;
+    for (Uint32 CtxInd = 0; CtxInd < pEnv->GetNumImmediateContexts(); ++CtxInd)
+    {
+        auto*       pCtx = pEnv->GetDeviceContext(CtxInd);
+        const auto& Desc = pCtx->GetDesc();
+        if ((Desc.QueueType & QueueTypeMask) == COMMAND_QUEUE_TYPE_COMPUTE && Desc.QueueId != pGraphicsCtx->GetDesc().QueueId)
+            return pCtx;
+    }
+    return nullptr;
+}
+
+TEST(PassSchedulerTest, CopyChain)
+{
+    auto* pEnv         = GPUTestingEnvironment::GetInstance();
+    auto* pDevice      = pEnv->GetDevice();
+    auto* pGraphicsCtx = pEnv->GetDeviceContext();
+    auto* pComputeCtx  = FindAsyncComputeContext(pEnv, pGraphicsCtx);
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    PassScheduler::CreateInfo SchedulerCI;
+    SchedulerCI.pDevice      = pDevice;
+    SchedulerCI.pGraphicsCtx = pGraphicsCtx;
+    SchedulerCI.pComputeCtx  = pComputeCtx;
+    PassScheduler Scheduler{SchedulerCI};
+    EXPECT_EQ(Scheduler.HasAsyncCompute(), pComputeCtx != nullptr);
+
+    Uint64 ContextMask = Uint64{1} << pGraphicsCtx->GetDesc().ContextId;
+    if (pComputeCtx != nullptr)
+        ContextMask |= Uint64{1} << pComputeCtx->GetDesc().ContextId;
+
+    constexpr Uint32 NumValues = 64;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name                 = "Pass scheduler test buffer";
+    BuffDesc.Size                 = NumValues * sizeof(Uint32);
+    BuffDesc.Usage                = USAGE_DEFAULT;
+    BuffDesc.ImmediateContextMask = ContextMask;
+
+    RefCntAutoPtr<IBuffer> pSrcBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pSrcBuffer);
+    ASSERT_NE(pSrcBuffer, nullptr);
+
+    RefCntAutoPtr<IBuffer> pDstBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pDstBuffer);
+    ASSERT_NE(pDstBuffer, nullptr);
+
+    BuffDesc.Name                 = "Pass scheduler test staging buffer";
+    BuffDesc.Usage                = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags       = CPU_ACCESS_READ;
+    BuffDesc.ImmediateContextMask = Uint64{1} << pGraphicsCtx->GetDesc().ContextId;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    ASSERT_NE(pStagingBuffer, nullptr);
+
+    // Run several frames to test the synchronization with the passes of the previous frames
+    for (Uint32 frame = 0; frame < 3; ++frame)
+    {
+        std::vector<Uint32> RefData(NumValues);
+        for (Uint32 i = 0; i < NumValues; ++i)
+            RefData[i] = i * 7 + frame;
+
+        {
+            const PassScheduler::ResourceAccess Accesses[] = {{pSrcBuffer, RESOURCE_STATE_COPY_DEST}};
+            Scheduler.AddPass("Update", PassScheduler::PASS_TYPE_GRAPHICS, Accesses, _countof(Accesses),
+                              [&](IDeviceContext* pCtx) {
+                                  pCtx->UpdateBuffer(pSrcBuffer, 0, NumValues * sizeof(Uint32), RefData.data(), RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+                              });
+        }
+        {
+            const PassScheduler::ResourceAccess Accesses[] = {{pSrcBuffer, RESOURCE_STATE_COPY_SOURCE}, {pDstBuffer, RESOURCE_STATE_COPY_DEST}};
+            Scheduler.AddPass("Copy", PassScheduler::PASS_TYPE_COMPUTE, Accesses, _countof(Accesses),
+                              [&](IDeviceContext* pCtx) {
+                                  EXPECT_EQ(pCtx, Scheduler.GetContext(PassScheduler::PASS_TYPE_COMPUTE));
+                                  pCtx->CopyBuffer(pSrcBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY,
+                                                   pDstBuffer, 0, NumValues * sizeof(Uint32), RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+                              });
+        }
+        {
+            const PassScheduler::ResourceAccess Accesses[] = {{pDstBuffer, RESOURCE_STATE_COPY_SOURCE}, {pStagingBuffer, RESOURCE_STATE_COPY_DEST}};
+            Scheduler.AddPass("Read back", PassScheduler::PASS_TYPE_GRAPHICS, Accesses, _countof(Accesses),
+                              [&](IDeviceContext* pCtx) {
+                                  pCtx->CopyBuffer(pDstBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY,
+                                                   pStagingBuffer, 0, NumValues * sizeof(Uint32), RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+                              });
+        }
+
+        Scheduler.Execute();
+
+        pGraphicsCtx->WaitForIdle();
+        if (pComputeCtx != nullptr)
+            pComputeCtx->WaitForIdle();
+
+        MapHelper<Uint32> ReadBackData{pGraphicsCtx, pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT};
+        for (Uint32 i = 0; i < NumValues; ++i)
+            EXPECT_EQ(ReadBackData[i], RefData[i]) << "frame " << frame << ", value " << i;
+    }
+}
+
+} // namespace
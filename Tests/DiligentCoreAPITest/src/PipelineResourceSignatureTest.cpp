@@ -36,6 +36,7 @@
 
 #if VULKAN_SUPPORTED
 #    include "Vulkan/TestingEnvironmentVk.hpp"
+#    include "ShaderResourceBindingVk.h"
 #endif
 
 #include "gtest/gtest.h"
@@ -2013,4 +2014,203 @@ TEST_F(PipelineResourceSignatureTest, UnusedNullResources)
     pSwapChain->Present();
 }
 
+#if VULKAN_SUPPORTED
+TEST_F(PipelineResourceSignatureTest, BindlessBuffers)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    const auto& deviceCaps = pDevice->GetDeviceInfo();
+    if (!deviceCaps.IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Bindless resources are only supported in Vulkan";
+    }
+
+    if (!deviceCaps.Features.ComputeShaders || !deviceCaps.Features.ShaderResourceRuntimeArray)
+    {
+        GTEST_SKIP() << "Compute shaders and shader resource runtime arrays are required for this test";
+    }
+
+    {
+        const auto& DescriptorIndexing = static_cast<TestingEnvironmentVk*>(pEnv)->DescriptorIndexing;
+        if (DescriptorIndexing.descriptorBindingUniformTexelBufferUpdateAfterBind != VK_TRUE ||
+            DescriptorIndexing.descriptorBindingPartiallyBound != VK_TRUE)
+        {
+            GTEST_SKIP() << "Update-after-bind uniform texel buffers are not supported by this device";
+        }
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    constexpr Uint32 BuffArraySize = 4;
+
+    const auto CreateFormattedBuffer = [&](const char* Name, BIND_FLAGS BindFlags, Uint32 NumElements, const Uint32* pInitData) {
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = Name;
+        BuffDesc.Size              = sizeof(Uint32) * NumElements;
+        BuffDesc.BindFlags         = BindFlags;
+        BuffDesc.Usage             = USAGE_DEFAULT;
+        BuffDesc.Mode              = BUFFER_MODE_FORMATTED;
+        BuffDesc.ElementByteStride = sizeof(Uint32);
+
+        BufferData InitData{pInitData, BuffDesc.Size};
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        pDevice->CreateBuffer(BuffDesc, pInitData != nullptr ? &InitData : nullptr, &pBuffer);
+        return pBuffer;
+    };
+
+    const auto CreateUintView = [](IBuffer* pBuffer, BUFFER_VIEW_TYPE ViewType) {
+        BufferViewDesc ViewDesc;
+        ViewDesc.ViewType             = ViewType;
+        ViewDesc.Format.ValueType     = VT_UINT32;
+        ViewDesc.Format.NumComponents = 1;
+
+        RefCntAutoPtr<IBufferView> pView;
+        pBuffer->CreateView(ViewDesc, &pView);
+        return pView;
+    };
+
+    // The last buffer replaces one of the first BuffArraySize buffers in the array
+    constexpr Uint32 BufferValues[BuffArraySize + 1] = {11, 22, 33, 44, 555};
+
+    RefCntAutoPtr<IBuffer>     pBuffers[BuffArraySize + 1];
+    RefCntAutoPtr<IBufferView> pBufferSRVs[BuffArraySize + 1];
+    for (Uint32 i = 0; i < BuffArraySize + 1; ++i)
+    {
+        pBuffers[i] = CreateFormattedBuffer("Bindless buffer", BIND_SHADER_RESOURCE, 1, &BufferValues[i]);
+        ASSERT_NE(pBuffers[i], nullptr);
+        pBufferSRVs[i] = CreateUintView(pBuffers[i], BUFFER_VIEW_SHADER_RESOURCE);
+        ASSERT_NE(pBufferSRVs[i], nullptr);
+    }
+
+    auto pOutBuffer = CreateFormattedBuffer("Bindless test output buffer", BIND_UNORDERED_ACCESS, BuffArraySize, nullptr);
+    ASSERT_NE(pOutBuffer, nullptr);
+    auto pOutBufferUAV = CreateUintView(pOutBuffer, BUFFER_VIEW_UNORDERED_ACCESS);
+    ASSERT_NE(pOutBufferUAV, nullptr);
+
+    RefCntAutoPtr<IPipelineResourceSignature> pPRS;
+    {
+        // clang-format off
+        const PipelineResourceDesc Resources[] =
+        {
+            {SHADER_TYPE_COMPUTE, "g_Buffers", BuffArraySize, SHADER_RESOURCE_TYPE_BUFFER_SRV, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER | PIPELINE_RESOURCE_FLAG_BINDLESS},
+            {SHADER_TYPE_COMPUTE, "g_Output",  1,             SHADER_RESOURCE_TYPE_BUFFER_UAV, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER}
+        };
+        // clang-format on
+
+        PipelineResourceSignatureDesc PRSDesc;
+        PRSDesc.Name         = "Bindless buffers test";
+        PRSDesc.Resources    = Resources;
+        PRSDesc.NumResources = _countof(Resources);
+
+        pDevice->CreatePipelineResourceSignature(PRSDesc, &pPRS);
+        ASSERT_NE(pPRS, nullptr);
+    }
+
+    static constexpr char CSSource[] = R"(
+Buffer<uint>                      g_Buffers[NUM_BUFFERS];
+RWBuffer<uint /*format=r32ui*/> g_Output;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    [unroll]
+    for (uint i = 0; i < NUM_BUFFERS; ++i)
+        g_Output[i] = g_Buffers[i].Load(0);
+}
+)";
+
+    ShaderMacroHelper Macros;
+    Macros.AddShaderMacro("NUM_BUFFERS", BuffArraySize);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.Desc           = {"Bindless buffers test CS", SHADER_TYPE_COMPUTE, true};
+    ShaderCI.EntryPoint     = "main";
+    ShaderCI.Source         = CSSource;
+    ShaderCI.Macros         = Macros;
+
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name         = "Bindless buffers test";
+    PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.pCS                  = pCS;
+
+    IPipelineResourceSignature* ppSignatures[] = {pPRS};
+    PSOCreateInfo.ppResourceSignatures         = ppSignatures;
+    PSOCreateInfo.ResourceSignaturesCount      = _countof(ppSignatures);
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPRS->CreateShaderResourceBinding(&pSRB);
+    ASSERT_NE(pSRB, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBindingVk> pSRBVk{pSRB, IID_ShaderResourceBindingVk};
+    ASSERT_NE(pSRBVk, nullptr);
+
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pOutBufferUAV);
+
+    auto* pBuffersVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Buffers");
+    ASSERT_NE(pBuffersVar, nullptr);
+
+    Uint32 Indices[BuffArraySize] = {};
+    for (Uint32 i = 0; i < BuffArraySize; ++i)
+    {
+        Indices[i] = pSRBVk->AddBindlessResource(pBuffersVar, pBufferSRVs[i]);
+        ASSERT_LT(Indices[i], BuffArraySize);
+        for (Uint32 j = 0; j < i; ++j)
+            EXPECT_NE(Indices[i], Indices[j]);
+    }
+    // Adding the same resource again must return the same index
+    EXPECT_EQ(pSRBVk->AddBindlessResource(pBuffersVar, pBufferSRVs[1]), Indices[1]);
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"all 4 elements of the array are in use"};
+        EXPECT_EQ(pSRBVk->AddBindlessResource(pBuffersVar, pBufferSRVs[BuffArraySize]), ~0u) << "The array is full";
+    }
+
+    const auto Dispatch = [&]() {
+        pContext->SetPipelineState(pPSO);
+        pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+    };
+
+    const auto VerifyOutput = [&](const Uint32* RefValues) {
+        const auto Output = pEnv->ReadBuffer<Uint32>(pOutBuffer, BuffArraySize);
+        ASSERT_EQ(Output.size(), size_t{BuffArraySize});
+        for (Uint32 i = 0; i < BuffArraySize; ++i)
+            EXPECT_EQ(Output[Indices[i]], RefValues[i]) << "i=" << i;
+    };
+
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    Dispatch();
+    VerifyOutput(BufferValues);
+
+    // Resources added to the array after the SRB has been committed are not transitioned
+    // by CommitShaderResources, so transition the replacement buffer explicitly.
+    StateTransitionDesc Barrier{pBuffers[BuffArraySize], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE};
+    pContext->TransitionResourceStates(1, &Barrier);
+
+    // Context state is reset by the flush in ReadBuffer, so the SRB has to be committed again
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    // Replace an element of the committed array. The freed index must be reused.
+    pSRBVk->RemoveBindlessResource(pBuffersVar, pBufferSRVs[1]);
+    EXPECT_EQ(pSRBVk->AddBindlessResource(pBuffersVar, pBufferSRVs[BuffArraySize]), Indices[1]);
+
+    Dispatch();
+
+    const Uint32 RefValues[BuffArraySize] = {BufferValues[0], BufferValues[BuffArraySize], BufferValues[2], BufferValues[3]};
+    VerifyOutput(RefValues);
+}
+#endif
+
 } // namespace Diligent
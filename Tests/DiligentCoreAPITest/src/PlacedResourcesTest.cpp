@@ -0,0 +1,176 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+#include "Align.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TextureDesc GetPlacedTextureDesc(const char* Name)
+{
+    TextureDesc TexDesc;
+    TexDesc.Name      = Name;
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 256;
+    TexDesc.Height    = 256;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    return TexDesc;
+}
+
+RefCntAutoPtr<IDeviceMemory> CreatePlacedMemory(Uint64 PageSize)
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+
+    DeviceMemoryCreateInfo MemCI;
+    MemCI.Desc.Name     = "Memory for placed resources";
+    MemCI.Desc.Type     = DEVICE_MEMORY_TYPE_PLACED;
+    MemCI.Desc.PageSize = PageSize;
+    MemCI.InitialSize   = PageSize;
+
+    RefCntAutoPtr<IDeviceMemory> pMemory;
+    pDevice->CreateDeviceMemory(MemCI, &pMemory);
+    return pMemory;
+}
+
+bool PlacedResourcesSupported()
+{
+    const auto DeviceType = GPUTestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo().Type;
+    return DeviceType == RENDER_DEVICE_TYPE_D3D12 || DeviceType == RENDER_DEVICE_TYPE_VULKAN;
+}
+
+TEST(PlacedResourcesTest, AliasedTextures)
+{
+    if (!PlacedResourcesSupported())
+        GTEST_SKIP() << "Placed resources are not supported by this device";
+
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    const auto DescA = GetPlacedTextureDesc("Placed texture A");
+    const auto DescB = GetPlacedTextureDesc("Placed texture B");
+
+    const auto MemReq = pDevice->GetTextureMemoryRequirements(DescA);
+    ASSERT_NE(MemReq.Size, Uint64{0});
+    ASSERT_NE(MemReq.Alignment, Uint64{0});
+
+    auto pMemory = CreatePlacedMemory(AlignUp(MemReq.Size, MemReq.Alignment));
+    ASSERT_NE(pMemory, nullptr);
+    ASSERT_EQ(pMemory->GetCapacity(), AlignUp(MemReq.Size, MemReq.Alignment));
+
+    // Both textures occupy the same memory range
+    TextureData TexData;
+    TexData.pMemory      = pMemory;
+    TexData.MemoryOffset = 0;
+
+    RefCntAutoPtr<ITexture> pTexA;
+    pDevice->CreateTexture(DescA, &TexData, &pTexA);
+    ASSERT_NE(pTexA, nullptr);
+
+    RefCntAutoPtr<ITexture> pTexB;
+    pDevice->CreateTexture(DescB, &TexData, &pTexB);
+    ASSERT_NE(pTexB, nullptr);
+
+    const float ClearColor[] = {1, 0, 0, 1};
+
+    StateTransitionDesc BarrierA{pTexA, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET, STATE_TRANSITION_FLAG_UPDATE_STATE};
+    pContext->TransitionResourceStates(1, &BarrierA);
+    ITextureView* pRTV = pTexA->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+    pContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    pContext->ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    // Texture B starts using the memory of texture A
+    StateTransitionDesc AliasingBarrier{pTexA, pTexB};
+    pContext->TransitionResourceStates(1, &AliasingBarrier);
+
+    StateTransitionDesc BarrierB{pTexB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET, STATE_TRANSITION_FLAG_UPDATE_STATE | STATE_TRANSITION_FLAG_DISCARD_CONTENT};
+    pContext->TransitionResourceStates(1, &BarrierB);
+    pRTV = pTexB->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+    pContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    pContext->ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    pContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+TEST(PlacedResourcesTest, PlacedBuffer)
+{
+    if (!PlacedResourcesSupported())
+        GTEST_SKIP() << "Placed resources are not supported by this device";
+
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = "Placed buffer";
+    BuffDesc.Size      = 4096;
+    BuffDesc.BindFlags = BIND_VERTEX_BUFFER;
+    BuffDesc.Usage     = USAGE_DEFAULT;
+
+    const auto MemReq = pDevice->GetBufferMemoryRequirements(BuffDesc);
+    ASSERT_GE(MemReq.Size, BuffDesc.Size);
+    ASSERT_NE(MemReq.Alignment, Uint64{0});
+
+    // Place the buffer at a non-zero offset within the page
+    const auto Offset   = AlignUp(Uint64{1}, MemReq.Alignment);
+    const auto PageSize = AlignUp(Offset + MemReq.Size, MemReq.Alignment);
+
+    auto pMemory = CreatePlacedMemory(PageSize);
+    ASSERT_NE(pMemory, nullptr);
+
+    BufferData BuffData;
+    BuffData.pMemory      = pMemory;
+    BuffData.MemoryOffset = Offset;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, &BuffData, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    std::vector<Uint8> Data(static_cast<size_t>(BuffDesc.Size), 0xAB);
+    pContext->UpdateBuffer(pBuffer, 0, BuffDesc.Size, Data.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+} // namespace
@@ -342,6 +342,76 @@ TEST_F(QueryTest, Occlusion)
     }
 }
 
+TEST_F(QueryTest, OcclusionArray)
+{
+    auto*       pEnv       = GPUTestingEnvironment::GetInstance();
+    auto*       pDevice    = pEnv->GetDevice();
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    if (!DeviceInfo.Features.OcclusionQueries)
+    {
+        GTEST_SKIP() << "Occlusion queries are not supported by this device";
+    }
+    if (DeviceInfo.Type != RENDER_DEVICE_TYPE_D3D12 && !DeviceInfo.IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Query arrays are only supported in Direct3D12 and Vulkan";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    RefCntAutoPtr<IQueryArray> pQueryArray;
+    pDevice->CreateQueryArray({"Occlusion query array", QUERY_TYPE_OCCLUSION, sm_NumTestQueries}, &pQueryArray);
+    ASSERT_NE(pQueryArray, nullptr);
+
+    const auto Stride = pQueryArray->GetQueryDataStride();
+    EXPECT_EQ(Stride, sizeof(Uint64));
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name  = "Query array resolve buffer";
+    BuffDesc.Size  = Stride * sm_NumTestQueries;
+    BuffDesc.Usage = USAGE_DEFAULT;
+    RefCntAutoPtr<IBuffer> pResolveBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pResolveBuffer);
+    ASSERT_NE(pResolveBuffer, nullptr);
+
+    BuffDesc.Name           = "Query array staging buffer";
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    ASSERT_NE(pStagingBuffer, nullptr);
+
+    for (Uint32 frame = 0; frame < sm_NumFrames; ++frame)
+    {
+        for (Uint32 i = 0; i < sm_NumTestQueries; ++i)
+        {
+            pContext->BeginIndexedQuery(pQueryArray, i);
+            for (Uint32 j = 0; j < i + 1; ++j)
+                DrawQuad(pContext);
+            pContext->EndIndexedQuery(pQueryArray, i);
+        }
+
+        // The results are written to the buffer by the GPU, so no readback is
+        // required to use them, e.g. for predication or indirect draws.
+        pContext->ResolveQueryArray({pQueryArray, 0, sm_NumTestQueries, pResolveBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION});
+        pContext->CopyBuffer(pResolveBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             pStagingBuffer, 0, BuffDesc.Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->WaitForIdle();
+
+        void* pData = nullptr;
+        pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        ASSERT_NE(pData, nullptr);
+        const auto* pNumSamples = static_cast<const Uint64*>(pData);
+        for (Uint32 i = 0; i < sm_NumTestQueries; ++i)
+        {
+            const auto NumPixels = sm_TextureSize * sm_TextureSize / 16;
+            EXPECT_GE(pNumSamples[i], Uint64{NumPixels} * (i + 1));
+        }
+        pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+    }
+}
+
 TEST_F(QueryTest, BinaryOcclusion)
 {
     const auto& DeviceInfo = GPUTestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo();
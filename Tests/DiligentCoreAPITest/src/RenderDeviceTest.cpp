@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(RenderDeviceTest, GetMemoryBudget)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    const auto Budget = pDevice->GetMemoryBudget();
+    if (Budget.Local.Budget == 0 && Budget.NonLocal.Budget == 0)
+    {
+        GTEST_SKIP() << "Memory budget is not supported by this device";
+    }
+
+    // The device has already allocated some memory, e.g. for the swap chain
+    EXPECT_GT(Budget.Local.Usage + Budget.NonLocal.Usage, 0u);
+}
+
+struct MemoryPressureCallbackData
+{
+    Uint32             NumCalls = 0;
+    DeviceMemoryBudget LastBudget;
+};
+
+void DILIGENT_CALL_TYPE OnMemoryPressure(const DeviceMemoryBudget* pBudget, void* pUserData)
+{
+    auto& Data = *static_cast<MemoryPressureCallbackData*>(pUserData);
+    ++Data.NumCalls;
+    Data.LastBudget = *pBudget;
+}
+
+TEST(RenderDeviceTest, MemoryPressureCallbacks)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    auto* pCtx    = pEnv->GetDeviceContext();
+
+    MemoryPressureCallbackData Data;
+    pDevice->AddMemoryPressureCallback(OnMemoryPressure, &Data);
+    pCtx->FinishFrame();
+    pDevice->RemoveMemoryPressureCallback(OnMemoryPressure, &Data);
+
+    // The callback is only invoked when the usage actually exceeds the threshold
+    if (Data.NumCalls > 0)
+    {
+        EXPECT_EQ(Data.NumCalls, 1u);
+        EXPECT_TRUE(Data.LastBudget.Local.Budget != 0 || Data.LastBudget.NonLocal.Budget != 0);
+    }
+
+    // The callback must not be invoked after it has been removed
+    const auto NumCalls = Data.NumCalls;
+    pCtx->FinishFrame();
+    EXPECT_EQ(Data.NumCalls, NumCalls);
+}
+
+} // namespace
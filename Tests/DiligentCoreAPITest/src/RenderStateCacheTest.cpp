@@ -24,6 +24,7 @@
  *  of the possibility of such damages.
  */
 
+#include <cstring>
 #include <functional>
 
 #include "GPUTestingEnvironment.hpp"
@@ -33,6 +34,9 @@
 #include "FastRand.hpp"
 #include "GraphicsTypesX.hpp"
 #include "CallbackWrapper.hpp"
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+#include "TempDirectory.hpp"
 #include "ResourceLayoutTestCommon.hpp"
 
 #include "InlineShaders/RayTracingTestHLSL.h"
@@ -967,6 +971,53 @@ TEST(RenderStateCacheTest, AppendData)
     }
 }
 
+TEST(RenderStateCacheTest, PersistentFile)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset AutoReset;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/RenderStateCache", &pShaderSourceFactory);
+    ASSERT_TRUE(pShaderSourceFactory);
+
+    auto pWhiteTexture = CreateWhiteTexture();
+
+    TempDirectory TmpDir;
+    const auto    FilePath = TmpDir.Get() + FileSystem::SlashSymbol + "RenderStateCache.bin";
+
+    constexpr bool UseRenderPass = false;
+
+    for (Uint32 CompactionThreshold = 0; CompactionThreshold < 3; ++CompactionThreshold)
+    {
+        for (Uint32 pass = 0; pass < 3; ++pass)
+        {
+            RenderStateCacheCreateInfo CacheCI{pDevice, RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE};
+            CacheCI.FilePath            = FilePath.c_str();
+            CacheCI.CompactionThreshold = CompactionThreshold;
+
+            RefCntAutoPtr<IRenderStateCache> pCache;
+            CreateRenderStateCache(CacheCI, &pCache);
+            ASSERT_TRUE(pCache);
+
+            RefCntAutoPtr<IShader> pVS, pPS;
+            CreateGraphicsShaders(pCache, pShaderSourceFactory, pVS, pPS, pass > 0);
+            ASSERT_NE(pVS, nullptr);
+            ASSERT_NE(pPS, nullptr);
+
+            RefCntAutoPtr<IPipelineState> pPSO;
+            CreateGraphicsPSO(pCache, pass > 0, pVS, pPS, UseRenderPass, &pPSO);
+            ASSERT_NE(pPSO, nullptr);
+
+            VerifyGraphicsPSO(pPSO, nullptr, pWhiteTexture, UseRenderPass);
+
+            if (pass == 2)
+                pCache->Reset();
+        }
+    }
+}
+
 TEST(RenderStateCacheTest, RenderDeviceWithCache)
 {
     constexpr bool Execute = false;
@@ -1291,4 +1342,82 @@ TEST(RenderStateCacheTest, Reload_Signatures_SrbBeforeReload)
     TestPipelineReload(/*UseRenderPass = */ false, /*CreateSrbBeforeReload = */ true, /*UseSignatures = */ true);
 }
 
+TEST(RenderStateCacheTest, Reload_ChangedFiles)
+{
+    auto* pEnv       = GPUTestingEnvironment::GetInstance();
+    auto* pDevice    = pEnv->GetDevice();
+    auto* pSwapChain = pEnv->GetSwapChain();
+
+    GPUTestingEnvironment::ScopedReset AutoReset;
+
+    TempDirectory TmpDir;
+    const auto&   TmpDirPath = TmpDir.Get();
+
+    auto WriteSource = [&](const char* FileName, const char* Source) {
+        const auto  Path = TmpDirPath + FileSystem::SlashSymbol + FileName;
+        FileWrapper File{Path.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        EXPECT_TRUE(File->Write(Source, strlen(Source)));
+    };
+
+    WriteSource("Common.fxh", "#define OFFSET 0.0\n");
+    WriteSource("VS.vsh",
+                "#include \"Common.fxh\"\n"
+                "float4 main(uint VertId : SV_VertexID) : SV_Position\n"
+                "{\n"
+                "    return float4(float(VertId & 1u) + OFFSET, float(VertId >> 1u), 0.0, 1.0);\n"
+                "}\n");
+    WriteSource("PS.psh",
+                "float4 main() : SV_Target\n"
+                "{\n"
+                "    return float4(1.0, 0.0, 0.0, 1.0);\n"
+                "}\n");
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory(TmpDirPath.c_str(), &pShaderSourceFactory);
+    ASSERT_TRUE(pShaderSourceFactory);
+
+    constexpr auto HotReload = true;
+
+    auto pCache = CreateCache(pDevice, HotReload);
+    ASSERT_TRUE(pCache);
+
+    RefCntAutoPtr<IShader> pVS, pPS;
+    CreateGraphicsShaders(pCache, pShaderSourceFactory, pVS, pPS, false, "VS.vsh", "PS.psh");
+    ASSERT_TRUE(pVS && pPS);
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    {
+        GraphicsPipelineStateCreateInfo PsoCI;
+        PsoCI.PSODesc.Name = "RenderStateCacheTest - Reload changed files";
+
+        auto& GraphicsPipeline{PsoCI.GraphicsPipeline};
+        GraphicsPipeline.NumRenderTargets             = 1;
+        GraphicsPipeline.RTVFormats[0]                = pSwapChain->GetDesc().ColorBufferFormat;
+        GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        PsoCI.pVS = pVS;
+        PsoCI.pPS = pPS;
+        EXPECT_FALSE(pCache->CreateGraphicsPipelineState(PsoCI, &pPSO));
+        ASSERT_TRUE(pPSO);
+    }
+
+    // No files have changed
+    EXPECT_EQ(pCache->Reload(), 0u);
+
+    // The include file only affects the vertex shader and the pipeline
+    WriteSource("Common.fxh", "#define OFFSET 0.5\n");
+    EXPECT_EQ(pCache->Reload(), 2u);
+    EXPECT_EQ(pCache->Reload(), 0u);
+
+    WriteSource("PS.psh",
+                "float4 main() : SV_Target\n"
+                "{\n"
+                "    return float4(0.0, 1.0, 0.0, 1.0);\n"
+                "}\n");
+    EXPECT_EQ(pCache->Reload(), 2u);
+    EXPECT_EQ(pCache->Reload(), 0u);
+}
+
 } // namespace
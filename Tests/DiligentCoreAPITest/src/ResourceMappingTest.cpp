@@ -0,0 +1,108 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+
+#include "GPUTestingEnvironment.hpp"
+#include "ResourceMapping.h"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(ResourceMappingTest, GetResourceArray)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    std::array<RefCntAutoPtr<ISampler>, 3> pSamplers;
+    for (auto& pSampler : pSamplers)
+    {
+        pDevice->CreateSampler(SamplerDesc{}, &pSampler);
+        ASSERT_NE(pSampler, nullptr);
+    }
+
+    RefCntAutoPtr<IResourceMapping> pResMapping;
+    pDevice->CreateResourceMapping(ResourceMappingDesc{}, &pResMapping);
+    ASSERT_NE(pResMapping, nullptr);
+
+    IDeviceObject* ppArray[] = {pSamplers[0], pSamplers[1]};
+    pResMapping->AddResourceArray("g_Samplers", 1, ppArray, 2, false);
+    pResMapping->AddResource("g_Sampler", pSamplers[2], false);
+
+    IDeviceObject* ppObjects[4] = {};
+    EXPECT_EQ(pResMapping->GetResourceArray("g_Samplers", 0, 4, ppObjects), 2u);
+    EXPECT_EQ(ppObjects[0], nullptr);
+    EXPECT_EQ(ppObjects[1], pSamplers[0]);
+    EXPECT_EQ(ppObjects[2], pSamplers[1]);
+    EXPECT_EQ(ppObjects[3], nullptr);
+
+    EXPECT_EQ(pResMapping->GetResourceArray("g_Sampler", 0, 1, ppObjects), 1u);
+    EXPECT_EQ(ppObjects[0], pSamplers[2]);
+
+    EXPECT_EQ(pResMapping->GetResourceArray("g_Missing", 0, 2, ppObjects), 0u);
+    EXPECT_EQ(ppObjects[0], nullptr);
+    EXPECT_EQ(ppObjects[1], nullptr);
+}
+
+TEST(ResourceMappingTest, Seal)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    RefCntAutoPtr<ISampler> pSampler;
+    pDevice->CreateSampler(SamplerDesc{}, &pSampler);
+    ASSERT_NE(pSampler, nullptr);
+
+    RefCntAutoPtr<IResourceMapping> pResMapping;
+    pDevice->CreateResourceMapping(ResourceMappingDesc{}, &pResMapping);
+    ASSERT_NE(pResMapping, nullptr);
+
+    pResMapping->AddResource("g_Sampler", pSampler, false);
+    EXPECT_FALSE(pResMapping->IsSealed());
+
+    pResMapping->Seal();
+    EXPECT_TRUE(pResMapping->IsSealed());
+
+    EXPECT_EQ(pResMapping->GetResource("g_Sampler"), pSampler);
+    EXPECT_EQ(pResMapping->GetResource("g_Sampler", 1), nullptr);
+
+    IDeviceObject* pObject = nullptr;
+    EXPECT_EQ(pResMapping->GetResourceArray("g_Sampler", 0, 1, &pObject), 1u);
+    EXPECT_EQ(pObject, pSampler);
+    EXPECT_EQ(pResMapping->GetSize(), 1u);
+}
+
+} // namespace
@@ -0,0 +1,359 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "ResourceStreamer.hpp"
+#include "GPUTestingEnvironment.hpp"
+#include "MapHelper.hpp"
+#include "FileWrapper.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+class ResourceStreamerTest : public testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        FileWrapper File{FilePath, EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+
+        FileData.resize(FileSize);
+        for (size_t i = 0; i < FileData.size(); ++i)
+            FileData[i] = static_cast<Uint8>((i * 7) ^ (i >> 8));
+        ASSERT_TRUE(File->Write(FileData.data(), FileData.size()));
+    }
+
+    static void TearDownTestSuite()
+    {
+        FileSystem::DeleteFile(FilePath);
+        FileData.clear();
+    }
+
+    void SetUp() override
+    {
+        const auto DevType = GPUTestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo().Type;
+        if (DevType != RENDER_DEVICE_TYPE_D3D12 && DevType != RENDER_DEVICE_TYPE_VULKAN)
+            GTEST_SKIP() << "Resource streamer is only supported in Direct3D12 and Vulkan";
+    }
+
+    static constexpr const char* FilePath = "ResourceStreamerTest.bin";
+    static constexpr size_t      FileSize = 1 << 16;
+
+    static std::vector<Uint8> FileData;
+};
+
+std::vector<Uint8> ResourceStreamerTest::FileData;
+
+// A trivial "compression": every byte is stored twice.
+bool Decompress(const void* pSrc, size_t SrcSize, void* pDst, size_t DstSize)
+{
+    if (SrcSize != DstSize * 2)
+        return false;
+    for (size_t i = 0; i < DstSize; ++i)
+        static_cast<Uint8*>(pDst)[i] = static_cast<const Uint8*>(pSrc)[i * 2];
+    return true;
+}
+
+TEST_F(ResourceStreamerTest, ReadBuffer)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    ResourceStreamer::CreateInfo StreamerCI;
+    StreamerCI.pDevice     = pDevice;
+    StreamerCI.pContext    = pContext;
+    StreamerCI.pThreadPool = pThreadPool;
+    // Small staging buffer to make the requests wait for the staging space
+    StreamerCI.StagingBufferSize = 4096;
+    ResourceStreamer Streamer{StreamerCI};
+
+    constexpr Uint32 NumChunks = 16;
+    constexpr Uint32 ChunkSize = 2048;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name  = "Resource streamer test buffer";
+    BuffDesc.Size  = NumChunks * ChunkSize;
+    BuffDesc.Usage = USAGE_DEFAULT;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    BuffDesc.Name           = "Resource streamer test staging buffer";
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    ASSERT_NE(pStagingBuffer, nullptr);
+
+    // Read the chunks in reverse order from odd file offsets
+    Uint64 LastFenceValue = 0;
+    for (Uint32 chunk = 0; chunk < NumChunks; ++chunk)
+    {
+        ResourceStreamer::BufferReadRequest Request;
+        Request.FilePath   = FilePath;
+        Request.Offset     = (NumChunks - 1 - chunk) * ChunkSize + 3;
+        Request.Size       = ChunkSize;
+        Request.pDstBuffer = pBuffer;
+        Request.DstOffset  = chunk * ChunkSize;
+
+        const auto FenceValue = Streamer.Enqueue(Request);
+        EXPECT_GT(FenceValue, LastFenceValue);
+        LastFenceValue = FenceValue;
+    }
+    EXPECT_EQ(Streamer.GetNumPendingRequests(), size_t{NumChunks});
+
+    Streamer.Flush();
+    EXPECT_EQ(Streamer.GetNumPendingRequests(), size_t{0});
+    Streamer.GetFence()->Wait(LastFenceValue);
+    EXPECT_TRUE(Streamer.IsComplete(LastFenceValue));
+
+    pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, NumChunks * ChunkSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    MapHelper<Uint8> ReadBackData{pContext, pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT};
+    for (Uint32 chunk = 0; chunk < NumChunks; ++chunk)
+    {
+        const auto* pRefData = &FileData[(NumChunks - 1 - chunk) * ChunkSize + 3];
+        EXPECT_EQ(memcmp(&ReadBackData[chunk * ChunkSize], pRefData, ChunkSize), 0) << "chunk " << chunk;
+    }
+}
+
+TEST_F(ResourceStreamerTest, ReadCompressedBuffer)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    ResourceStreamer::CreateInfo StreamerCI;
+    StreamerCI.pDevice    = pDevice;
+    StreamerCI.pContext   = pContext;
+    StreamerCI.Decompress = Decompress;
+    ResourceStreamer Streamer{StreamerCI};
+
+    constexpr Uint32 DataSize = 4096;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name  = "Resource streamer test buffer";
+    BuffDesc.Size  = DataSize;
+    BuffDesc.Usage = USAGE_DEFAULT;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    BuffDesc.Name           = "Resource streamer test staging buffer";
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    ASSERT_NE(pStagingBuffer, nullptr);
+
+    ResourceStreamer::BufferReadRequest Request;
+    Request.FilePath         = FilePath;
+    Request.Offset           = 100;
+    Request.Size             = DataSize * 2;
+    Request.UncompressedSize = DataSize;
+    Request.pDstBuffer       = pBuffer;
+
+    const auto FenceValue = Streamer.Enqueue(Request);
+    Streamer.Process();
+    EXPECT_EQ(Streamer.GetNumPendingRequests(), size_t{0});
+    pContext->Flush();
+    Streamer.GetFence()->Wait(FenceValue);
+
+    pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, DataSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    MapHelper<Uint8> ReadBackData{pContext, pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT};
+    for (Uint32 i = 0; i < DataSize; ++i)
+    {
+        ASSERT_EQ(ReadBackData[i], FileData[Request.Offset + i * 2]) << "byte " << i;
+    }
+}
+
+TEST_F(ResourceStreamerTest, ReadTexture)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    ResourceStreamer::CreateInfo StreamerCI;
+    StreamerCI.pDevice     = pDevice;
+    StreamerCI.pContext    = pContext;
+    StreamerCI.pThreadPool = pThreadPool;
+    ResourceStreamer Streamer{StreamerCI};
+
+    constexpr Uint32 Width  = 40;
+    constexpr Uint32 Height = 32;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Resource streamer test texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.MipLevels = 2;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+    ASSERT_NE(pTexture, nullptr);
+
+    TexDesc.Name           = "Resource streamer test staging texture";
+    TexDesc.Usage          = USAGE_STAGING;
+    TexDesc.BindFlags      = BIND_NONE;
+    TexDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<ITexture> pStagingTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pStagingTexture);
+    ASSERT_NE(pStagingTexture, nullptr);
+
+    // Mip 0 is tightly packed in the file, mip 1 uses a padded row stride
+    constexpr Uint64 Mip1Stride = Width / 2 * 4 + 12;
+    constexpr Uint64 Mip1Offset = Width * Height * 4;
+
+    ResourceStreamer::TextureReadRequest Request;
+    Request.FilePath    = FilePath;
+    Request.Size        = Width * Height * 4;
+    Request.pDstTexture = pTexture;
+    Streamer.Enqueue(Request);
+
+    Request.Offset   = Mip1Offset;
+    Request.Size     = Mip1Stride * Height / 2;
+    Request.MipLevel = 1;
+    Request.Stride   = Mip1Stride;
+
+    const auto FenceValue = Streamer.Enqueue(Request);
+    Streamer.Flush();
+    Streamer.GetFence()->Wait(FenceValue);
+
+    for (Uint32 mip = 0; mip < 2; ++mip)
+    {
+        CopyTextureAttribs CopyAttribs{pTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+        CopyAttribs.SrcMipLevel = mip;
+        CopyAttribs.DstMipLevel = mip;
+        pContext->CopyTexture(CopyAttribs);
+    }
+    pContext->WaitForIdle();
+
+    for (Uint32 mip = 0; mip < 2; ++mip)
+    {
+        const Uint32 MipWidth  = Width >> mip;
+        const Uint32 MipHeight = Height >> mip;
+        const Uint64 SrcStride = mip == 0 ? Uint64{MipWidth} * 4 : Mip1Stride;
+        const Uint64 SrcOffset = mip == 0 ? 0 : Mip1Offset;
+
+        MappedTextureSubresource MappedData;
+        pContext->MapTextureSubresource(pStagingTexture, mip, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+        ASSERT_NE(MappedData.pData, nullptr);
+        for (Uint32 row = 0; row < MipHeight; ++row)
+        {
+            const auto* pRow = static_cast<const Uint8*>(MappedData.pData) + row * MappedData.Stride;
+            EXPECT_EQ(memcmp(pRow, &FileData[StaticCast<size_t>(SrcOffset + row * SrcStride)], MipWidth * 4), 0) << "mip " << mip << ", row " << row;
+        }
+        pContext->UnmapTextureSubresource(pStagingTexture, mip, 0);
+    }
+}
+
+TEST_F(ResourceStreamerTest, RequestTooLargeAfterAlignment)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    ResourceStreamer::CreateInfo StreamerCI;
+    StreamerCI.pDevice  = pDevice;
+    StreamerCI.pContext = pContext;
+    // The staging size is not a multiple of the buffer staging alignment
+    StreamerCI.StagingBufferSize = 4096 + 32;
+    ResourceStreamer Streamer{StreamerCI};
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name  = "Resource streamer test buffer";
+    BuffDesc.Size  = 8192;
+    BuffDesc.Usage = USAGE_DEFAULT;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    // The request fits into the staging buffer, but its aligned size does not
+    ResourceStreamer::BufferReadRequest Request;
+    Request.FilePath   = FilePath;
+    Request.Size       = 4096 + 4;
+    Request.pDstBuffer = pBuffer;
+
+    Uint64 FailedFenceValue = 0;
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"bytes of staging space, which exceeds the staging buffer size"};
+
+        FailedFenceValue = Streamer.Enqueue(Request);
+        // Must not wait for the staging space forever
+        Streamer.Flush();
+    }
+    EXPECT_EQ(Streamer.GetNumPendingRequests(), size_t{0});
+    Streamer.GetFence()->Wait(FailedFenceValue);
+    EXPECT_TRUE(Streamer.IsComplete(FailedFenceValue));
+
+    // The streamer keeps processing other requests
+    Request.Size          = 4096;
+    const auto FenceValue = Streamer.Enqueue(Request);
+    EXPECT_GT(FenceValue, FailedFenceValue);
+    Streamer.Flush();
+    Streamer.GetFence()->Wait(FenceValue);
+    EXPECT_TRUE(Streamer.IsComplete(FenceValue));
+}
+
+} // namespace
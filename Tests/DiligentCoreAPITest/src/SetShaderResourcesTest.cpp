@@ -0,0 +1,185 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderResourceBindingTemplate.hpp"
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+class SetShaderResourcesTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        auto* pEnv    = GPUTestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        PipelineResourceSignatureDesc PRSDesc;
+        PRSDesc.Name = "Set shader resources test";
+
+        // clang-format off
+        const PipelineResourceDesc Resources[] =
+        {
+            {SHADER_TYPE_PIXEL,  "g_Tex2D_Mut",    1,             SHADER_RESOURCE_TYPE_TEXTURE_SRV,     SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+            {SHADER_TYPE_PIXEL,  "g_Tex2DArr_Dyn", TexArraySize,  SHADER_RESOURCE_TYPE_TEXTURE_SRV,     SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_VERTEX, "g_CB_Mut",       1,             SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        };
+        // clang-format on
+        PRSDesc.Resources    = Resources;
+        PRSDesc.NumResources = _countof(Resources);
+
+        pDevice->CreatePipelineResourceSignature(PRSDesc, &sm_pPRS);
+        ASSERT_NE(sm_pPRS, nullptr);
+
+        for (Uint32 i = 0; i < _countof(sm_pTexSRVs); ++i)
+        {
+            auto pTex = pEnv->CreateTexture("Set shader resources test texture", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 16, 16);
+            ASSERT_NE(pTex, nullptr);
+            sm_pTexSRVs[i] = pTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+        }
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "Set shader resources test buffer";
+        BuffDesc.Size      = 256;
+        BuffDesc.BindFlags = BIND_UNIFORM_BUFFER;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &sm_pBuffer);
+        ASSERT_NE(sm_pBuffer, nullptr);
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pPRS.Release();
+        for (auto& pSRV : sm_pTexSRVs)
+            pSRV.Release();
+        sm_pBuffer.Release();
+
+        GPUTestingEnvironment::GetInstance()->Reset();
+    }
+
+    static Uint32 GetVarIndex(IShaderResourceBinding* pSRB, SHADER_TYPE ShaderType, const char* Name)
+    {
+        auto* pVar = pSRB->GetVariableByName(ShaderType, Name);
+        VERIFY_EXPR(pVar != nullptr);
+        return pVar != nullptr ? pVar->GetIndex() : ~0u;
+    }
+
+    static constexpr Uint32 TexArraySize = 3;
+
+    static RefCntAutoPtr<IPipelineResourceSignature> sm_pPRS;
+    static RefCntAutoPtr<ITextureView>               sm_pTexSRVs[TexArraySize + 1];
+    static RefCntAutoPtr<IBuffer>                    sm_pBuffer;
+};
+
+RefCntAutoPtr<IPipelineResourceSignature> SetShaderResourcesTest::sm_pPRS;
+RefCntAutoPtr<ITextureView>               SetShaderResourcesTest::sm_pTexSRVs[];
+RefCntAutoPtr<IBuffer>                    SetShaderResourcesTest::sm_pBuffer;
+constexpr Uint32                          SetShaderResourcesTest::TexArraySize;
+
+TEST_F(SetShaderResourcesTest, SetResources)
+{
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    sm_pPRS->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    const auto TexIdx    = GetVarIndex(pSRB, SHADER_TYPE_PIXEL, "g_Tex2D_Mut");
+    const auto TexArrIdx = GetVarIndex(pSRB, SHADER_TYPE_PIXEL, "g_Tex2DArr_Dyn");
+    const auto CBIdx     = GetVarIndex(pSRB, SHADER_TYPE_VERTEX, "g_CB_Mut");
+
+    // clang-format off
+    const ShaderResourceVariableUpdate Updates[] =
+    {
+        {SHADER_TYPE_PIXEL,   TexIdx,    sm_pTexSRVs[0]},
+        {SHADER_TYPE_PIXEL,   TexArrIdx, sm_pTexSRVs[1], 0},
+        {SHADER_TYPE_UNKNOWN, TexArrIdx, sm_pTexSRVs[0], 1}, // Skipped
+        {SHADER_TYPE_PIXEL,   TexArrIdx, sm_pTexSRVs[3], 2},
+        {SHADER_TYPE_VERTEX,  CBIdx,     sm_pBuffer},
+    };
+    // clang-format on
+    pSRB->SetResources(Updates, _countof(Updates));
+
+    EXPECT_EQ(pSRB->GetVariableByIndex(SHADER_TYPE_PIXEL, TexIdx)->Get(0), sm_pTexSRVs[0]);
+    EXPECT_EQ(pSRB->GetVariableByIndex(SHADER_TYPE_PIXEL, TexArrIdx)->Get(0), sm_pTexSRVs[1]);
+    EXPECT_EQ(pSRB->GetVariableByIndex(SHADER_TYPE_PIXEL, TexArrIdx)->Get(1), nullptr);
+    EXPECT_EQ(pSRB->GetVariableByIndex(SHADER_TYPE_PIXEL, TexArrIdx)->Get(2), sm_pTexSRVs[3]);
+    EXPECT_EQ(pSRB->GetVariableByIndex(SHADER_TYPE_VERTEX, CBIdx)->Get(0), sm_pBuffer);
+
+    // Dynamic variables may be updated any time
+    const ShaderResourceVariableUpdate DynUpdate{SHADER_TYPE_PIXEL, TexArrIdx, sm_pTexSRVs[2], 1};
+    pSRB->SetResources(&DynUpdate, 1);
+    EXPECT_EQ(pSRB->GetVariableByIndex(SHADER_TYPE_PIXEL, TexArrIdx)->Get(1), sm_pTexSRVs[2]);
+
+    // Overwriting mutable variables requires the flag
+    const ShaderResourceVariableUpdate MutUpdate{SHADER_TYPE_PIXEL, TexIdx, sm_pTexSRVs[1]};
+    pSRB->SetResources(&MutUpdate, 1, SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
+    EXPECT_EQ(pSRB->GetVariableByIndex(SHADER_TYPE_PIXEL, TexIdx)->Get(0), sm_pTexSRVs[1]);
+}
+
+TEST_F(SetShaderResourcesTest, BindingTemplate)
+{
+    RefCntAutoPtr<IShaderResourceBinding> pSRB0, pSRB1;
+    sm_pPRS->CreateShaderResourceBinding(&pSRB0, true);
+    sm_pPRS->CreateShaderResourceBinding(&pSRB1, true);
+    ASSERT_TRUE(pSRB0 && pSRB1);
+
+    // clang-format off
+    const ShaderResourceBindingTemplate::VariableDesc Variables[] =
+    {
+        {SHADER_TYPE_PIXEL,  "g_Tex2D_Mut"},
+        {SHADER_TYPE_PIXEL,  "g_Tex2DArr_Dyn", 2},
+        {SHADER_TYPE_VERTEX, "g_CB_Mut"},
+    };
+    // clang-format on
+    ShaderResourceBindingTemplate Template{pSRB0, Variables, _countof(Variables)};
+    ASSERT_EQ(Template.GetNumSlots(), 3u);
+    for (Uint32 i = 0; i < Template.GetNumSlots(); ++i)
+        EXPECT_TRUE(Template.IsResolved(i));
+
+    Template.SetResource(0, sm_pTexSRVs[0]);
+    Template.SetResource(1, sm_pTexSRVs[1]);
+    Template.SetResource(2, sm_pBuffer);
+    Template.Apply(pSRB0);
+
+    Template.SetResource(0, sm_pTexSRVs[2]);
+    Template.Apply(pSRB1);
+
+    EXPECT_EQ(pSRB0->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2D_Mut")->Get(0), sm_pTexSRVs[0]);
+    EXPECT_EQ(pSRB1->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2D_Mut")->Get(0), sm_pTexSRVs[2]);
+    for (auto* pSRB : {pSRB0.RawPtr(), pSRB1.RawPtr()})
+    {
+        EXPECT_EQ(pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2DArr_Dyn")->Get(2), sm_pTexSRVs[1]);
+        EXPECT_EQ(pSRB->GetVariableByName(SHADER_TYPE_VERTEX, "g_CB_Mut")->Get(0), sm_pBuffer);
+    }
+}
+
+} // namespace
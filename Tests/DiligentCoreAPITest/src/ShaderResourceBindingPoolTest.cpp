@@ -0,0 +1,126 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderResourceBindingPool.hpp"
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(ShaderResourceBindingPoolTest, Recycle)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name = "SRB pool test";
+
+    // clang-format off
+    const PipelineResourceDesc Resources[] =
+    {
+        {SHADER_TYPE_PIXEL,  "g_Tex2D_Mut",    1, SHADER_RESOURCE_TYPE_TEXTURE_SRV,     SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        {SHADER_TYPE_PIXEL,  "g_Tex2DArr_Dyn", 2, SHADER_RESOURCE_TYPE_TEXTURE_SRV,     SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+        {SHADER_TYPE_VERTEX, "g_CB_Dyn",       1, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+    };
+    // clang-format on
+    PRSDesc.Resources    = Resources;
+    PRSDesc.NumResources = _countof(Resources);
+
+    RefCntAutoPtr<IPipelineResourceSignature> pPRS;
+    pDevice->CreatePipelineResourceSignature(PRSDesc, &pPRS);
+    ASSERT_NE(pPRS, nullptr);
+
+    auto pTex = pEnv->CreateTexture("SRB pool test texture", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 16, 16);
+    ASSERT_NE(pTex, nullptr);
+    auto* pSRV = pTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = "SRB pool test buffer";
+    BuffDesc.Size      = 256;
+    BuffDesc.BindFlags = BIND_UNIFORM_BUFFER;
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    ShaderResourceBindingPool::CreateInfo PoolCI;
+    PoolCI.pSignature    = pPRS;
+    PoolCI.MaxPooledSRBs = 2;
+    ShaderResourceBindingPool Pool{PoolCI};
+
+    auto pSRB0 = Pool.Allocate();
+    auto pSRB1 = Pool.Allocate();
+    auto pSRB2 = Pool.Allocate();
+    ASSERT_TRUE(pSRB0 && pSRB1 && pSRB2);
+    EXPECT_NE(pSRB0, pSRB1);
+    EXPECT_EQ(Pool.GetNumPooledSRBs(), size_t{0});
+
+    pSRB0->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2D_Mut")->Set(pSRV);
+    {
+        IDeviceObject* ppSRVs[] = {pSRV, pSRV};
+        pSRB0->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2DArr_Dyn")->SetArray(ppSRVs, 0, 2);
+    }
+    pSRB0->GetVariableByName(SHADER_TYPE_VERTEX, "g_CB_Dyn")->Set(pBuffer);
+
+    auto* const pRawSRB0 = pSRB0.RawPtr();
+    Pool.Recycle(pSRB0);
+    pSRB0.Release();
+    Pool.Recycle(pSRB1);
+    pSRB1.Release();
+    EXPECT_EQ(Pool.GetNumPooledSRBs(), size_t{2});
+
+    // The pool is full, so the SRB is not kept
+    Pool.Recycle(pSRB2);
+    pSRB2.Release();
+    EXPECT_EQ(Pool.GetNumPooledSRBs(), size_t{2});
+
+    // SRBs are reused in LIFO order
+    auto pSRB = Pool.Allocate();
+    pSRB      = Pool.Allocate();
+    ASSERT_EQ(pSRB, pRawSRB0);
+    EXPECT_EQ(Pool.GetNumPooledSRBs(), size_t{0});
+
+    // Mutable resources are kept, dynamic ones are unbound
+    EXPECT_EQ(pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2D_Mut")->Get(0), pSRV);
+    EXPECT_EQ(pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2DArr_Dyn")->Get(0), nullptr);
+    EXPECT_EQ(pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2DArr_Dyn")->Get(1), nullptr);
+    EXPECT_EQ(pSRB->GetVariableByName(SHADER_TYPE_VERTEX, "g_CB_Dyn")->Get(0), nullptr);
+
+    Pool.Recycle(pSRB);
+    EXPECT_EQ(Pool.GetNumPooledSRBs(), size_t{1});
+    Pool.Clear();
+    EXPECT_EQ(Pool.GetNumPooledSRBs(), size_t{0});
+}
+
+} // namespace
@@ -0,0 +1,164 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ShadingRateMapGenerator.hpp"
+
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+RefCntAutoPtr<ITexture> CreateColorTexture(IRenderDevice* pDevice, Uint32 Width, Uint32 Height, bool Checkerboard)
+{
+    std::vector<Uint32> Data(size_t{Width} * Height);
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+            Data[x + y * Width] = (!Checkerboard || ((x + y) & 1) == 0) ? 0xFF808080u : 0xFF000000u;
+    }
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Shading rate generator test color texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    TexDesc.Usage     = USAGE_IMMUTABLE;
+
+    TextureSubResData SubResData{Data.data(), Uint64{Width} * 4};
+    TextureData       InitData{&SubResData, 1};
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, &InitData, &pTexture);
+    return pTexture;
+}
+
+// Reads back the shading rate texture and checks that all texels are equal to the expected rate
+void VerifyShadingRate(ITexture* pShadingRateTex, SHADING_RATE ExpectedRate)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    auto StagingDesc           = pShadingRateTex->GetDesc();
+    StagingDesc.Name           = "Shading rate generator test staging texture";
+    StagingDesc.BindFlags      = BIND_NONE;
+    StagingDesc.Usage          = USAGE_STAGING;
+    StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<ITexture> pStagingTex;
+    pDevice->CreateTexture(StagingDesc, nullptr, &pStagingTex);
+    ASSERT_NE(pStagingTex, nullptr);
+
+    CopyTextureAttribs CopyAttribs{pShadingRateTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+    pContext->CopyTexture(CopyAttribs);
+    pContext->WaitForIdle();
+
+    MappedTextureSubresource MappedSubres;
+    pContext->MapTextureSubresource(pStagingTex, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedSubres);
+    ASSERT_NE(MappedSubres.pData, nullptr);
+
+    for (Uint32 y = 0; y < StagingDesc.Height; ++y)
+    {
+        const auto* pRow = static_cast<const Uint8*>(MappedSubres.pData) + y * MappedSubres.Stride;
+        for (Uint32 x = 0; x < StagingDesc.Width; ++x)
+        {
+            if (StagingDesc.Format == TEX_FORMAT_R8_UINT)
+            {
+                EXPECT_EQ(pRow[x], Uint8{ExpectedRate}) << "x=" << x << " y=" << y;
+            }
+            else
+            {
+                // Fragment density: 255 for 1x, 128 for 2x, 64 for 4x
+                const Uint8 DensityX = static_cast<Uint8>(255 >> (ExpectedRate >> SHADING_RATE_X_SHIFT));
+                const Uint8 DensityY = static_cast<Uint8>(255 >> (ExpectedRate & 3));
+                EXPECT_NEAR(pRow[x * 2 + 0], DensityX, 1) << "x=" << x << " y=" << y;
+                EXPECT_NEAR(pRow[x * 2 + 1], DensityY, 1) << "x=" << x << " y=" << y;
+            }
+        }
+    }
+
+    pContext->UnmapTextureSubresource(pStagingTex, 0, 0);
+}
+
+TEST(ShadingRateMapGeneratorTest, Generate)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    const auto& SRProps = pDevice->GetAdapterInfo().ShadingRate;
+    if (!pDevice->GetDeviceInfo().Features.VariableRateShading || !pDevice->GetDeviceInfo().Features.ComputeShaders)
+        GTEST_SKIP() << "Variable rate shading or compute shaders are not supported by this device";
+    if ((SRProps.CapFlags & SHADING_RATE_CAP_FLAG_TEXTURE_BASED) == 0 || (SRProps.BindFlags & BIND_UNORDERED_ACCESS) == 0)
+        GTEST_SKIP() << "Shading rate textures can't be written by compute shaders on this device";
+    if (SRProps.Format != SHADING_RATE_FORMAT_PALETTE && SRProps.Format != SHADING_RATE_FORMAT_UNORM8)
+        GTEST_SKIP() << "Shading rate format is not supported by the generator";
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    ShadingRateMapGenerator::CreateInfo CI;
+    CI.pDevice          = pDevice;
+    CI.UseMotionVectors = false;
+    ShadingRateMapGenerator Generator{CI};
+
+    constexpr Uint32 Width  = 256;
+    constexpr Uint32 Height = 128;
+
+    auto pFlatTex    = CreateColorTexture(pDevice, Width, Height, false);
+    auto pCheckerTex = CreateColorTexture(pDevice, Width, Height, true);
+    ASSERT_NE(pFlatTex, nullptr);
+    ASSERT_NE(pCheckerTex, nullptr);
+
+    ShadingRateMapGenerator::GenerateAttribs Attribs;
+
+    // Flat color allows the coarsest supported rate
+    Attribs.pColor = pFlatTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+    Generator.Generate(pContext, Attribs);
+    ASSERT_NE(Generator.GetShadingRateTexture(), nullptr);
+    ASSERT_NE(Generator.GetShadingRateView(), nullptr);
+
+    const auto& TexDesc = Generator.GetShadingRateTexture()->GetDesc();
+    EXPECT_EQ(TexDesc.Width, (Width + Generator.GetTileSize()[0] - 1) / Generator.GetTileSize()[0]);
+    EXPECT_EQ(TexDesc.Height, (Height + Generator.GetTileSize()[1] - 1) / Generator.GetTileSize()[1]);
+    VerifyShadingRate(Generator.GetShadingRateTexture(), Generator.GetSupportedShadingRate(SHADING_RATE_4X4));
+
+    // High-contrast checkerboard requires full rate
+    Attribs.pColor = pCheckerTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+    Generator.Generate(pContext, Attribs);
+    VerifyShadingRate(Generator.GetShadingRateTexture(), SHADING_RATE_1X1);
+}
+
+} // namespace
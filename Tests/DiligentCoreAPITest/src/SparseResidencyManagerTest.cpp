@@ -0,0 +1,241 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "SparseResidencyManager.hpp"
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+class SparseResidencyManagerTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        auto* pEnv    = GPUTestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        const auto& DeviceInfo = pDevice->GetDeviceInfo();
+        if (!DeviceInfo.Features.SparseResources)
+            GTEST_SKIP() << "Sparse resources are not supported by this device";
+
+        // In Metal, sparse textures must be created from the memory object
+        if (DeviceInfo.IsMetalDevice())
+            GTEST_SKIP() << "Sparse residency manager test is not supported in Metal";
+
+        if ((pDevice->GetAdapterInfo().SparseResources.CapFlags & SPARSE_RESOURCE_CAP_FLAG_TEXTURE_2D) == 0)
+            GTEST_SKIP() << "Sparse 2D textures are not supported by this device";
+
+        for (Uint32 CtxInd = 0; CtxInd < pEnv->GetNumImmediateContexts(); ++CtxInd)
+        {
+            auto* pCtx = pEnv->GetDeviceContext(CtxInd);
+            if ((pCtx->GetDesc().QueueType & COMMAND_QUEUE_TYPE_SPARSE_BINDING) == COMMAND_QUEUE_TYPE_SPARSE_BINDING)
+            {
+                m_pSparseBindingCtx = pCtx;
+                break;
+            }
+        }
+        if (m_pSparseBindingCtx == nullptr)
+            GTEST_SKIP() << "Sparse binding queue is not found";
+
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Sparse residency manager test texture";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = 1024;
+        TexDesc.Height    = 1024;
+        TexDesc.MipLevels = 0;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+        TexDesc.Usage     = USAGE_SPARSE;
+
+        pDevice->CreateTexture(TexDesc, nullptr, &m_pTexture);
+        ASSERT_NE(m_pTexture, nullptr);
+    }
+
+    void Update(SparseResidencyManager& Manager)
+    {
+        auto* pContext = GPUTestingEnvironment::GetInstance()->GetDeviceContext();
+
+        SparseResidencyManager::UpdateAttribs Attribs;
+        Attribs.pSparseBindingContext = m_pSparseBindingCtx;
+
+        const auto FenceValue = Manager.Update(Attribs);
+        if (FenceValue != 0)
+            pContext->DeviceWaitForFence(Manager.GetFence(), FenceValue);
+    }
+
+    void TearDown() override
+    {
+        if (m_pSparseBindingCtx != nullptr)
+            m_pSparseBindingCtx->WaitForIdle();
+        GPUTestingEnvironment::GetInstance()->GetDeviceContext()->WaitForIdle();
+    }
+
+    Uint64 GetMipTailSize() const
+    {
+        const auto& Props = m_pTexture->GetSparseProperties();
+        return Props.FirstMipInTail < m_pTexture->GetDesc().MipLevels ? Props.MipTailSize : 0;
+    }
+
+    IDeviceContext*         m_pSparseBindingCtx = nullptr;
+    RefCntAutoPtr<ITexture> m_pTexture;
+};
+
+TEST_F(SparseResidencyManagerTest, RequestTiles)
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    SparseResidencyManager::CreateInfo CI;
+    CI.pDevice            = pDevice;
+    CI.pTexture           = m_pTexture;
+    CI.TilesPerMemoryPage = 4;
+    SparseResidencyManager Manager{CI};
+
+    const auto BlockSize = m_pTexture->GetSparseProperties().BlockSize;
+
+    const SparseResidencyManager::TileId Tiles[] = {
+        {0, 0, 0, 0},
+        {0, 0, 1, 0},
+        {0, 0, 1, 1},
+        {1, 0, 0, 0},
+        {2, 0, 0, 0},
+    };
+    for (const auto& Tile : Tiles)
+        Manager.RequestTile(Tile);
+    // Duplicate requests are ignored
+    Manager.RequestTile(Tiles[0]);
+
+    Update(Manager);
+    EXPECT_EQ(Manager.GetNumResidentTiles(), _countof(Tiles));
+    EXPECT_EQ(Manager.GetNewlyResidentTiles().size(), _countof(Tiles));
+    EXPECT_TRUE(Manager.GetEvictedTiles().empty());
+    EXPECT_EQ(Manager.GetUsedMemorySize(), GetMipTailSize() + _countof(Tiles) * BlockSize);
+    EXPECT_GE(Manager.GetMemoryCapacity(), Manager.GetUsedMemorySize());
+    for (const auto& Tile : Tiles)
+        EXPECT_TRUE(Manager.IsTileResident(Tile));
+    EXPECT_FALSE(Manager.IsTileResident({0, 0, 2, 2}));
+
+    // Less detailed levels are bound first
+    EXPECT_EQ(Manager.GetNewlyResidentTiles().front().MipLevel, 2u);
+
+    // Requesting resident tiles does not bind them again
+    Manager.RequestTile(Tiles[1]);
+    Update(Manager);
+    EXPECT_TRUE(Manager.GetNewlyResidentTiles().empty());
+    EXPECT_EQ(Manager.GetNumResidentTiles(), _countof(Tiles));
+}
+
+TEST_F(SparseResidencyManagerTest, Eviction)
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    const auto BlockSize = m_pTexture->GetSparseProperties().BlockSize;
+
+    constexpr Uint32 MaxResidentTiles = 4;
+
+    SparseResidencyManager::CreateInfo CI;
+    CI.pDevice            = pDevice;
+    CI.pTexture           = m_pTexture;
+    CI.MemoryBudget       = GetMipTailSize() + MaxResidentTiles * BlockSize;
+    CI.TilesPerMemoryPage = 1;
+    CI.MinTileLifetime    = 1;
+    SparseResidencyManager Manager{CI};
+
+    for (Uint32 x = 0; x < MaxResidentTiles; ++x)
+        Manager.RequestTile({0, 0, x, 0});
+    Update(Manager);
+    EXPECT_EQ(Manager.GetNumResidentTiles(), size_t{MaxResidentTiles});
+    EXPECT_LE(Manager.GetMemoryCapacity(), CI.MemoryBudget);
+
+    // All tiles except (1, 0) are used again, so it becomes the least recently used one
+    Manager.RequestTile({0, 0, 0, 0});
+    Manager.RequestTile({0, 0, 2, 0});
+    Manager.RequestTile({0, 0, 3, 0});
+    Update(Manager);
+    Manager.RequestTile({0, 0, 0, 0});
+    Manager.RequestTile({0, 0, 0, 1});
+    Update(Manager);
+    EXPECT_EQ(Manager.GetNumResidentTiles(), size_t{MaxResidentTiles});
+    ASSERT_EQ(Manager.GetEvictedTiles().size(), size_t{1});
+    EXPECT_EQ(Manager.GetEvictedTiles()[0], (SparseResidencyManager::TileId{0, 0, 1, 0}));
+    EXPECT_TRUE(Manager.IsTileResident({0, 0, 0, 0}));
+    EXPECT_TRUE(Manager.IsTileResident({0, 0, 0, 1}));
+    EXPECT_FALSE(Manager.IsTileResident({0, 0, 1, 0}));
+
+    // Tiles that were requested during the last MinTileLifetime updates are not evicted
+    Manager.RequestTile({0, 0, 0, 2});
+    Manager.RequestTile({0, 0, 0, 3});
+    Manager.RequestTile({0, 0, 1, 1});
+    Update(Manager);
+    EXPECT_EQ(Manager.GetNumResidentTiles(), size_t{MaxResidentTiles});
+    EXPECT_EQ(Manager.GetUsedMemorySize(), CI.MemoryBudget);
+    EXPECT_TRUE(Manager.IsTileResident({0, 0, 0, 1}));
+}
+
+TEST_F(SparseResidencyManagerTest, Feedback)
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    SparseResidencyManager::CreateInfo CI;
+    CI.pDevice  = pDevice;
+    CI.pTexture = m_pTexture;
+    SparseResidencyManager Manager{CI};
+
+    constexpr Uint32   FeedbackSize = 8;
+    std::vector<Uint8> Feedback(FeedbackSize * FeedbackSize, Uint8{0xFF});
+    // The last texel of the first row requests mip level 1
+    Feedback[FeedbackSize - 1] = 1;
+
+    Manager.ProcessFeedback(Feedback.data(), FeedbackSize, FeedbackSize, FeedbackSize);
+    Update(Manager);
+
+    const auto& TexDesc = m_pTexture->GetDesc();
+    const auto& Props   = m_pTexture->GetSparseProperties();
+    EXPECT_FALSE(Manager.IsTileResident({0, 0, 0, 0}));
+    for (Uint32 Mip = 1; Mip < std::min(Props.FirstMipInTail, TexDesc.MipLevels); ++Mip)
+    {
+        const auto MipWidth = std::max(TexDesc.Width >> Mip, 1u);
+        const auto LastX    = (MipWidth - 1) / Props.TileSize[0];
+        EXPECT_TRUE(Manager.IsTileResident({Mip, 0, LastX, 0})) << "Mip " << Mip;
+    }
+}
+
+} // namespace
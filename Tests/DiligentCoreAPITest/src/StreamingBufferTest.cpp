@@ -26,6 +26,11 @@
  */
 
 #include "StreamingBuffer.hpp"
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+
 #include "GPUTestingEnvironment.hpp"
 
 #include "gtest/gtest.h"
@@ -101,4 +106,90 @@ TEST(StreamingBufferTest, MapUnmap)
     StreamBuff.Reset();
 }
 
+TEST(StreamingBufferTest, SharedMapping)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    StreamingBufferCreateInfo CI;
+    CI.pDevice = pDevice;
+
+    CI.BuffDesc.Name           = "Test streaming buffer";
+    CI.BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+    CI.BuffDesc.Usage          = USAGE_DYNAMIC;
+    CI.BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    CI.BuffDesc.Size           = 1024;
+
+    StreamingBuffer StreamBuff{CI};
+    ASSERT_TRUE(StreamBuff.GetBuffer() != nullptr);
+
+    {
+        auto Offset = StreamBuff.Map(pContext, pDevice, 100);
+        EXPECT_EQ(Offset, Uint32{0});
+        StreamBuff.Unmap();
+    }
+
+    // Copy the constant to avoid ODR-use of the static member
+    const auto InvalidOffset = StreamingBuffer::InvalidOffset;
+
+    constexpr Uint32 NumThreads               = 4;
+    constexpr Uint32 AllocsPerThread          = 16;
+    constexpr Uint32 AllocSize                = 48;
+    constexpr Uint32 Alignment                = 64;
+    constexpr Uint32 ReserveSize              = NumThreads * AllocsPerThread * Alignment + Alignment;
+    constexpr Uint32 TotalAllocCount          = NumThreads * AllocsPerThread;
+    constexpr Uint8  Data[AllocSize]          = {};
+    Uint32           Offsets[TotalAllocCount] = {};
+
+    StreamBuff.BeginSharedMapping(pContext, pDevice, ReserveSize);
+    EXPECT_NE(StreamBuff.GetMappedCPUAddress(), nullptr);
+    {
+        std::vector<std::thread> Threads(NumThreads);
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads[t] = std::thread{
+                [&](Uint32 thread_id) //
+                {
+                    for (Uint32 i = 0; i < AllocsPerThread; ++i)
+                        Offsets[thread_id * AllocsPerThread + i] = StreamBuff.UpdateShared(Data, AllocSize, Alignment);
+                },
+                t //
+            };
+        }
+
+        for (auto& Thread : Threads)
+            Thread.join();
+    }
+
+    std::sort(std::begin(Offsets), std::end(Offsets));
+    for (Uint32 i = 0; i < TotalAllocCount; ++i)
+    {
+        EXPECT_NE(Offsets[i], InvalidOffset);
+        EXPECT_EQ(Offsets[i] % Alignment, 0u);
+        EXPECT_GE(Offsets[i], Uint32{100});
+        if (i > 0)
+        {
+            EXPECT_GE(Offsets[i], Offsets[i - 1] + AllocSize);
+        }
+    }
+
+    // The reserved region is exhausted
+    EXPECT_EQ(StreamBuff.AllocateShared(ReserveSize, Alignment), InvalidOffset);
+
+    StreamBuff.EndSharedMapping();
+    EXPECT_EQ(StreamBuff.GetMappedCPUAddress(), nullptr);
+
+    {
+        // The unused tail of the reserved region is returned to the buffer
+        auto Offset = StreamBuff.Map(pContext, pDevice, 16);
+        EXPECT_EQ(Offset, Offsets[TotalAllocCount - 1] + AllocSize);
+        StreamBuff.Unmap();
+    }
+
+    StreamBuff.Reset();
+}
+
 } // namespace
@@ -804,4 +804,128 @@ INSTANTIATE_TEST_SUITE_P(TextureCreation,
                          } //
 );
 
+
+TEST(TextureViewCacheTest, ReuseViews)
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Texture view cache test";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D_ARRAY;
+    TexDesc.Width     = 64;
+    TexDesc.Height    = 64;
+    TexDesc.ArraySize = 4;
+    TexDesc.MipLevels = 2;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+    ASSERT_NE(pTexture, nullptr);
+
+    TextureViewDesc ViewDesc;
+    ViewDesc.Name            = "Slice 1 SRV";
+    ViewDesc.ViewType        = TEXTURE_VIEW_SHADER_RESOURCE;
+    ViewDesc.TextureDim      = RESOURCE_DIM_TEX_2D_ARRAY;
+    ViewDesc.FirstArraySlice = 1;
+    ViewDesc.NumArraySlices  = 1;
+
+    RefCntAutoPtr<ITextureView> pView0;
+    pTexture->CreateView(ViewDesc, &pView0);
+    ASSERT_NE(pView0, nullptr);
+
+    // The same description and name returns the live view
+    RefCntAutoPtr<ITextureView> pView1;
+    pTexture->CreateView(ViewDesc, &pView1);
+    EXPECT_EQ(pView0, pView1);
+
+    // Null name matches any name
+    {
+        ViewDesc.Name = nullptr;
+        RefCntAutoPtr<ITextureView> pUnnamedView;
+        pTexture->CreateView(ViewDesc, &pUnnamedView);
+        EXPECT_EQ(pView0, pUnnamedView);
+    }
+
+    // A different name creates a new view with that name
+    {
+        ViewDesc.Name = "Another slice 1 SRV";
+        RefCntAutoPtr<ITextureView> pRenamedView;
+        pTexture->CreateView(ViewDesc, &pRenamedView);
+        ASSERT_NE(pRenamedView, nullptr);
+        EXPECT_NE(pView0, pRenamedView);
+        EXPECT_STREQ(pRenamedView->GetDesc().Name, ViewDesc.Name);
+    }
+    ViewDesc.Name = "Slice 1 SRV";
+
+    // A different description creates a new view
+    ViewDesc.FirstArraySlice = 2;
+    RefCntAutoPtr<ITextureView> pView2;
+    pTexture->CreateView(ViewDesc, &pView2);
+    ASSERT_NE(pView2, nullptr);
+    EXPECT_NE(pView0, pView2);
+
+    // Released views are not kept alive by the cache
+    pView2.Release();
+    RefCntWeakPtr<ITextureView> pWeakView0{pView0};
+    pView0.Release();
+    pView1.Release();
+    EXPECT_FALSE(pWeakView0.IsValid());
+
+    ViewDesc.FirstArraySlice = 1;
+    pTexture->CreateView(ViewDesc, &pView0);
+    EXPECT_NE(pView0, nullptr);
+}
+
+TEST(TextureViewCacheTest, ViewsWithSampler)
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Texture view cache sampler test";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 64;
+    TexDesc.Height    = 64;
+    TexDesc.MipLevels = 2;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+    ASSERT_NE(pTexture, nullptr);
+
+    RefCntAutoPtr<ISampler> pSampler;
+    pDevice->CreateSampler(SamplerDesc{}, &pSampler);
+    ASSERT_NE(pSampler, nullptr);
+
+    TextureViewDesc ViewDesc;
+    ViewDesc.Name            = "Mip 1 SRV";
+    ViewDesc.ViewType        = TEXTURE_VIEW_SHADER_RESOURCE;
+    ViewDesc.TextureDim      = RESOURCE_DIM_TEX_2D;
+    ViewDesc.MostDetailedMip = 1;
+    ViewDesc.NumMipLevels    = 1;
+
+    RefCntAutoPtr<ITextureView> pView0;
+    pTexture->CreateView(ViewDesc, &pView0);
+    ASSERT_NE(pView0, nullptr);
+    pView0->SetSampler(pSampler);
+
+    // A view with a sampler is not shared
+    RefCntAutoPtr<ITextureView> pView1;
+    pTexture->CreateView(ViewDesc, &pView1);
+    ASSERT_NE(pView1, nullptr);
+    EXPECT_NE(pView0, pView1);
+    EXPECT_EQ(pView1->GetSampler(), nullptr);
+    EXPECT_EQ(pView0->GetSampler(), pSampler);
+
+    // The new view without a sampler is shared
+    RefCntAutoPtr<ITextureView> pView2;
+    pTexture->CreateView(ViewDesc, &pView2);
+    EXPECT_EQ(pView1, pView2);
+}
+
 } // namespace
@@ -0,0 +1,147 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "TextureFeedbackBuffer.hpp"
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Feedback helpers are defined in HLSLDefinitions.fxh
+const std::string FeedbackCSSource = R"(
+RWStructuredBuffer<uint> g_Feedback;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    uint2 FeedbackDim = uint2(8u, 4u);
+    WRITE_TEXTURE_FEEDBACK(g_Feedback, FeedbackDim, 1u, float2(0.9, 0.1), 2.5);
+    WRITE_TEXTURE_FEEDBACK(g_Feedback, FeedbackDim, 1u, float2(0.9, 0.1), 1.2);
+
+    float LOD = ComputeTextureFeedbackLOD(float2(4.0 / 256.0, 0.0), float2(0.0, 1.0 / 256.0), float2(256.0, 256.0));
+    WRITE_TEXTURE_FEEDBACK(g_Feedback, FeedbackDim, 0u, float2(1.3, 0.6), LOD);
+}
+)";
+
+TEST(TextureFeedbackBufferTest, WriteAndReadback)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    if (!DeviceInfo.Features.ComputeShaders)
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    // HLSL definitions are not used by HLSL-to-GLSL converter
+    if (DeviceInfo.IsGLDevice())
+        GTEST_SKIP() << "Texture feedback helpers are not available in OpenGL";
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr Uint32 Width     = 8;
+    constexpr Uint32 Height    = 4;
+    constexpr Uint32 NumSlices = 2;
+
+    TextureFeedbackBuffer::CreateInfo CI;
+    CI.pDevice   = pDevice;
+    CI.Width     = Width;
+    CI.Height    = Height;
+    CI.NumSlices = NumSlices;
+    TextureFeedbackBuffer Feedback{CI};
+    ASSERT_NE(Feedback.GetUAV(), nullptr);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Desc           = {"Texture feedback test CS", SHADER_TYPE_COMPUTE, true};
+    ShaderCI.EntryPoint     = "main";
+    ShaderCI.Source         = FeedbackCSSource.c_str();
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name                               = "Texture feedback test PSO";
+    PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+    PSOCreateInfo.pCS                                        = pCS;
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Feedback")->Set(Feedback.GetUAV());
+
+    AsyncReadbackQueue::CreateInfo QueueCI;
+    QueueCI.pDevice = pDevice;
+    AsyncReadbackQueue Queue{QueueCI};
+
+    std::vector<Uint8> RefFeedback(Width * Height * NumSlices, Uint8{0xFF});
+    RefFeedback[7 + 0 * Width + 1 * Width * Height] = 1;
+    RefFeedback[2 + 2 * Width + 0 * Width * Height] = 2;
+
+    // The second iteration verifies that the buffer is cleared
+    for (Uint32 i = 0; i < 2; ++i)
+    {
+        Feedback.Clear(pContext);
+
+        pContext->SetPipelineState(pPSO);
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+
+        Uint32 NumSlicesReceived = 0;
+        Uint32 NumMismatches     = 0;
+        EXPECT_TRUE(Feedback.Readback(pContext, Queue,
+                                      [&](const Uint8* pMinMip, Uint32 W, Uint32 H, Uint32 Stride, Uint32 Slice) {
+                                          ++NumSlicesReceived;
+                                          EXPECT_EQ(W, Width);
+                                          EXPECT_EQ(H, Height);
+                                          for (Uint32 y = 0; y < H; ++y)
+                                          {
+                                              for (Uint32 x = 0; x < W; ++x)
+                                              {
+                                                  if (pMinMip[x + y * Stride] != RefFeedback[x + y * Width + Slice * Width * Height])
+                                                      ++NumMismatches;
+                                              }
+                                          }
+                                      }));
+        Queue.Flush(pContext);
+
+        EXPECT_EQ(NumSlicesReceived, NumSlices);
+        EXPECT_EQ(NumMismatches, 0u);
+    }
+}
+
+} // namespace
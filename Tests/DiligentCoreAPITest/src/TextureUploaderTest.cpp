@@ -89,7 +89,7 @@ Uint32 WriteOrVerifyRGBAData(MappedTextureSubresource& MappedData,
     return NumInvalidPixels;
 }
 
-void TextureUploaderTest(bool IsRenderThread)
+void TextureUploaderTest(bool IsRenderThread, Uint64 MaxCopyBytesPerUpdate = 0)
 {
     auto* pEnv     = GPUTestingEnvironment::GetInstance();
     auto* pDevice  = pEnv->GetDevice();
@@ -102,7 +102,8 @@ void TextureUploaderTest(bool IsRenderThread)
 
     GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
 
-    TextureUploaderDesc             UploaderDesc;
+    TextureUploaderDesc UploaderDesc;
+    UploaderDesc.MaxCopyBytesPerUpdate = MaxCopyBytesPerUpdate;
     RefCntAutoPtr<ITextureUploader> pTexUploader;
     CreateTextureUploader(pDevice, UploaderDesc, &pTexUploader);
     ASSERT_TRUE(pTexUploader);
@@ -158,7 +159,7 @@ void TextureUploaderTest(bool IsRenderThread)
                     WriteOrVerifyRGBAData(MappedData, UploadBuffDesc, mip, slice, cnt, false);
                 }
             }
-            pTexUploader->ScheduleGPUCopy(pCtx, pDstTexture, StartDstSlice, StartDstMip, pUploadBuffer);
+            pTexUploader->ScheduleGPUCopy(pCtx, pDstTexture, StartDstSlice, StartDstMip, pUploadBuffer, i);
             if (pCtx == nullptr)
             {
                 pUploadBuffer->WaitForCopyScheduled();
@@ -220,4 +221,154 @@ TEST(TextureUploaderTest, WorkerThread)
     TextureUploaderTest(false);
 }
 
+TEST(TextureUploaderTest, WorkerThreadWithBudget)
+{
+    // The budget is smaller than a single upload buffer, so every update must still execute one copy
+    TextureUploaderTest(false, 1024);
+}
+
+TEST(TextureUploaderTest, Transcode)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (pDevice->GetDeviceInfo().IsMetalDevice())
+    {
+        GTEST_SKIP() << "Texture uploader is not currently implemented in Metal";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    RefCntAutoPtr<ITextureUploader> pTexUploader;
+    CreateTextureUploader(pDevice, TextureUploaderDesc{}, &pTexUploader);
+    ASSERT_TRUE(pTexUploader);
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Texture transcoding dst texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D_ARRAY;
+    TexDesc.Width     = 128;
+    TexDesc.Height    = 64;
+    TexDesc.MipLevels = 3;
+    TexDesc.ArraySize = 4;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    RefCntAutoPtr<ITexture> pDstTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pDstTexture);
+    ASSERT_TRUE(pDstTexture);
+
+    TexDesc.Name           = "Texture transcoding staging texture";
+    TexDesc.Usage          = USAGE_STAGING;
+    TexDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    TexDesc.BindFlags      = BIND_NONE;
+    RefCntAutoPtr<ITexture> pStagingTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pStagingTexture);
+    ASSERT_TRUE(pStagingTexture);
+
+    UploadBufferDesc UploadBuffDesc;
+    UploadBuffDesc.Width     = TexDesc.Width;
+    UploadBuffDesc.Height    = TexDesc.Height;
+    UploadBuffDesc.Format    = TexDesc.Format;
+    UploadBuffDesc.MipLevels = TexDesc.MipLevels;
+    UploadBuffDesc.ArraySize = TexDesc.ArraySize;
+
+    auto GetTexel = [](Uint32 x, Uint32 y, Uint32 Mip, Uint32 Slice) {
+        return (x & 0xFFu) | ((y & 0xFFu) << 8u) | (Mip << 16u) | (Slice << 24u);
+    };
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_TRUE(pThreadPool);
+
+    RefCntAutoPtr<IUploadBuffer> pUploadBuffer;
+    pTexUploader->AllocateUploadBuffer(pContext, UploadBuffDesc, &pUploadBuffer);
+    ASSERT_TRUE(pUploadBuffer);
+
+    std::atomic<Uint32> NumTranscodedSubresources{0};
+
+    TextureTranscodeAttribs TranscodeAttribs;
+    TranscodeAttribs.pUploadBuffer        = pUploadBuffer;
+    TranscodeAttribs.pThreadPool          = pThreadPool;
+    TranscodeAttribs.pUploader            = pTexUploader;
+    TranscodeAttribs.pDstTexture          = pDstTexture;
+    TranscodeAttribs.TranscodeSubresource = [&](const TextureTranscodeSubresourceInfo& Info) {
+        EXPECT_EQ(Info.Width, UploadBuffDesc.Width >> Info.MipLevel);
+        EXPECT_EQ(Info.Height, UploadBuffDesc.Height >> Info.MipLevel);
+        for (Uint32 y = 0; y < Info.Height; ++y)
+        {
+            auto* pRow = reinterpret_cast<Uint32*>(static_cast<Uint8*>(Info.DstData.pData) + size_t{Info.DstData.Stride} * y);
+            for (Uint32 x = 0; x < Info.Width; ++x)
+                pRow[x] = GetTexel(x, y, Info.MipLevel, Info.ArraySlice);
+        }
+        NumTranscodedSubresources.fetch_add(1);
+        return true;
+    };
+    auto pTask = TranscodeToUploadBuffer(TranscodeAttribs);
+    ASSERT_TRUE(pTask);
+    while (!pTask->IsFinished())
+        pTexUploader->RenderThreadUpdate(pContext);
+    EXPECT_EQ(pTask->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+    EXPECT_EQ(NumTranscodedSubresources.load(), UploadBuffDesc.MipLevels * UploadBuffDesc.ArraySize);
+
+    pTexUploader->RenderThreadUpdate(pContext);
+    pUploadBuffer->WaitForCopyScheduled();
+    pTexUploader->RecycleBuffer(pUploadBuffer);
+
+    for (Uint32 slice = 0; slice < TexDesc.ArraySize; ++slice)
+    {
+        for (Uint32 mip = 0; mip < TexDesc.MipLevels; ++mip)
+        {
+            CopyTextureAttribs CopyAttribs{pDstTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+            CopyAttribs.SrcMipLevel = mip;
+            CopyAttribs.SrcSlice    = slice;
+            CopyAttribs.DstMipLevel = mip;
+            CopyAttribs.DstSlice    = slice;
+            pContext->CopyTexture(CopyAttribs);
+        }
+    }
+    pContext->WaitForIdle();
+
+    for (Uint32 slice = 0; slice < TexDesc.ArraySize; ++slice)
+    {
+        for (Uint32 mip = 0; mip < TexDesc.MipLevels; ++mip)
+        {
+            MappedTextureSubresource MappedData;
+            pContext->MapTextureSubresource(pStagingTexture, mip, slice, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+
+            Uint32 NumInvalidTexels = 0;
+            for (Uint32 y = 0; y < (TexDesc.Height >> mip); ++y)
+            {
+                const auto* pRow = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(MappedData.pData) + size_t{MappedData.Stride} * y);
+                for (Uint32 x = 0; x < (TexDesc.Width >> mip); ++x)
+                    NumInvalidTexels += pRow[x] != GetTexel(x, y, mip, slice) ? 1 : 0;
+            }
+            EXPECT_EQ(NumInvalidTexels, 0u) << "mip " << mip << ", slice " << slice;
+
+            pContext->UnmapTextureSubresource(pStagingTexture, mip, slice);
+        }
+    }
+
+    // A failed subresource cancels the task and the copy is not scheduled.
+    // Without the thread pool, the subresources are transcoded by this thread.
+    pUploadBuffer.Release();
+    pTexUploader->AllocateUploadBuffer(pContext, UploadBuffDesc, &pUploadBuffer);
+    ASSERT_TRUE(pUploadBuffer);
+
+    TranscodeAttribs.pUploadBuffer        = pUploadBuffer;
+    TranscodeAttribs.pThreadPool          = nullptr;
+    TranscodeAttribs.pUploader            = nullptr;
+    TranscodeAttribs.pDstTexture          = nullptr;
+    TranscodeAttribs.TranscodeSubresource = [](const TextureTranscodeSubresourceInfo& Info) {
+        return Info.MipLevel != 1;
+    };
+
+    pEnv->SetErrorAllowance(1);
+    pTask = TranscodeToUploadBuffer(TranscodeAttribs);
+    ASSERT_TRUE(pTask);
+    EXPECT_TRUE(pTask->IsFinished());
+    EXPECT_EQ(pTask->GetStatus(), ASYNC_TASK_STATUS_CANCELLED);
+    pTexUploader->RecycleBuffer(pUploadBuffer);
+
+    pThreadPool->StopThreads();
+}
+
 } // namespace
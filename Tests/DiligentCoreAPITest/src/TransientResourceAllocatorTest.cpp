@@ -0,0 +1,185 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TransientResourceAllocator.hpp"
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TextureDesc GetRenderTargetDesc(const char* Name, Uint32 Width, Uint32 Height)
+{
+    TextureDesc TexDesc;
+    TexDesc.Name      = Name;
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
+    return TexDesc;
+}
+
+IDeviceContext* FindSparseBindingContext()
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+    for (Uint32 CtxInd = 0; CtxInd < pEnv->GetNumImmediateContexts(); ++CtxInd)
+    {
+        auto* pCtx = pEnv->GetDeviceContext(CtxInd);
+        if ((pCtx->GetDesc().QueueType & COMMAND_QUEUE_TYPE_SPARSE_BINDING) == COMMAND_QUEUE_TYPE_SPARSE_BINDING)
+            return pCtx;
+    }
+    return nullptr;
+}
+
+void RunFrame(TransientResourceAllocator& Allocator, IDeviceContext* pSparseBindingCtx, Uint32 NumPasses)
+{
+    auto* pContext = GPUTestingEnvironment::GetInstance()->GetDeviceContext();
+
+    TransientResourceAllocator::UpdateAttribs Attribs;
+    Attribs.pSparseBindingContext = pSparseBindingCtx;
+
+    const auto FenceValue = Allocator.Update(Attribs);
+    if (FenceValue != 0)
+        pContext->DeviceWaitForFence(Allocator.GetFence(), FenceValue);
+
+    for (Uint32 Pass = 0; Pass < NumPasses; ++Pass)
+        Allocator.BeginPass(pContext, Pass);
+}
+
+TEST(TransientResourceAllocatorTest, Pooling)
+{
+    auto* pDevice  = GPUTestingEnvironment::GetInstance()->GetDevice();
+    auto* pContext = GPUTestingEnvironment::GetInstance()->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    TransientResourceAllocator::CreateInfo CI;
+    CI.pDevice         = pDevice;
+    CI.MaxUnusedFrames = 1;
+    CI.DisableAliasing = true;
+    TransientResourceAllocator Allocator{CI};
+    EXPECT_FALSE(Allocator.IsAliasingEnabled());
+
+    const auto Desc = GetRenderTargetDesc("Transient resource allocator test RT", 256, 256);
+
+    Allocator.BeginFrame();
+    const auto Req0 = Allocator.RequestTexture(Desc, 0, 1);
+    const auto Req1 = Allocator.RequestTexture(Desc, 2, 3);
+    ASSERT_NE(Req0, TransientResourceAllocator::InvalidRequestId);
+    ASSERT_NE(Req1, TransientResourceAllocator::InvalidRequestId);
+    RunFrame(Allocator, nullptr, 4);
+
+    // Without aliasing, all requests of one frame use different textures
+    auto* pTex0 = Allocator.GetTexture(Req0);
+    auto* pTex1 = Allocator.GetTexture(Req1);
+    ASSERT_NE(pTex0, nullptr);
+    ASSERT_NE(pTex1, nullptr);
+    EXPECT_NE(pTex0, pTex1);
+    EXPECT_EQ(pTex0->GetDesc().Usage, USAGE_DEFAULT);
+    EXPECT_EQ(Allocator.GetNumPooledTextures(), size_t{2});
+    EXPECT_EQ(Allocator.GetFrameMemorySize(), Uint64{0});
+
+    // The textures are reused by the next frame
+    Allocator.BeginFrame();
+    const auto Req2 = Allocator.RequestTexture(Desc, 0, 0);
+    RunFrame(Allocator, nullptr, 1);
+    EXPECT_EQ(Allocator.GetTexture(Req2), pTex0);
+    EXPECT_EQ(Allocator.GetNumPooledTextures(), size_t{2});
+
+    // The texture that is not requested for MaxUnusedFrames frames is released
+    Allocator.BeginFrame();
+    Allocator.RequestTexture(Desc, 0, 0);
+    RunFrame(Allocator, nullptr, 1);
+    Allocator.BeginFrame();
+    EXPECT_EQ(Allocator.GetNumPooledTextures(), size_t{1});
+
+    pContext->WaitForIdle();
+}
+
+TEST(TransientResourceAllocatorTest, Aliasing)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    auto* pSparseBindingCtx = FindSparseBindingContext();
+    if (pSparseBindingCtx == nullptr)
+        GTEST_SKIP() << "Sparse binding queue is not found";
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    TransientResourceAllocator::CreateInfo CI;
+    CI.pDevice        = pDevice;
+    CI.MemoryPageSize = 1 << 20;
+    TransientResourceAllocator Allocator{CI};
+    if (!Allocator.IsAliasingEnabled())
+        GTEST_SKIP() << "Sparse aliasing is not supported by this device";
+
+    // Pass 0 writes A, pass 1 reads A and writes B, pass 2 reads B and writes C.
+    // C does not overlap with A and may reuse its memory.
+    Allocator.BeginFrame();
+    const auto ReqA = Allocator.RequestTexture(GetRenderTargetDesc("Transient texture A", 512, 512), 0, 1);
+    const auto ReqB = Allocator.RequestTexture(GetRenderTargetDesc("Transient texture B", 512, 512), 1, 2);
+    const auto ReqC = Allocator.RequestTexture(GetRenderTargetDesc("Transient texture C", 512, 512), 2, 2);
+    RunFrame(Allocator, pSparseBindingCtx, 3);
+
+    auto* pTexA = Allocator.GetTexture(ReqA);
+    auto* pTexC = Allocator.GetTexture(ReqC);
+    ASSERT_NE(pTexA, nullptr);
+    ASSERT_NE(Allocator.GetTexture(ReqB), nullptr);
+    ASSERT_NE(pTexC, nullptr);
+    if (pTexA->GetDesc().Usage != USAGE_SPARSE)
+        GTEST_SKIP() << "Sparse aliasing is not supported for render targets";
+
+    EXPECT_EQ(pTexC->GetDesc().Usage, USAGE_SPARSE);
+    EXPECT_EQ(Allocator.GetRequestedMemorySize(), Allocator.GetFrameMemorySize() * 3 / 2);
+    EXPECT_GE(Allocator.GetMemoryCapacity(), Allocator.GetFrameMemorySize());
+
+    // The same requests in the next frame reuse the textures and do not rebind the memory
+    Allocator.BeginFrame();
+    Allocator.RequestTexture(GetRenderTargetDesc("Transient texture A", 512, 512), 0, 1);
+    Allocator.RequestTexture(GetRenderTargetDesc("Transient texture B", 512, 512), 1, 2);
+    Allocator.RequestTexture(GetRenderTargetDesc("Transient texture C", 512, 512), 2, 2);
+
+    TransientResourceAllocator::UpdateAttribs Attribs;
+    Attribs.pSparseBindingContext = pSparseBindingCtx;
+    EXPECT_EQ(Allocator.Update(Attribs), Uint64{0});
+    for (Uint32 Pass = 0; Pass < 3; ++Pass)
+        Allocator.BeginPass(pContext, Pass);
+    EXPECT_EQ(Allocator.GetNumPooledTextures(), size_t{3});
+
+    pSparseBindingCtx->WaitForIdle();
+    pContext->WaitForIdle();
+}
+
+} // namespace
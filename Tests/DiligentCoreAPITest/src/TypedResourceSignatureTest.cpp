@@ -0,0 +1,135 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+#include "TypedResourceSignature.hpp"
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+struct g_CB_Stat : TypedResource<SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_STATIC>
+{
+    static constexpr const char* GetName() { return "g_CB_Stat"; }
+};
+
+struct g_Tex2D_Mut : TypedResource<SHADER_TYPE_PIXEL, SHADER_RESOURCE_TYPE_TEXTURE_SRV>
+{
+    static constexpr const char* GetName() { return "g_Tex2D_Mut"; }
+};
+
+struct g_Tex2DArr_Dyn : TypedResource<SHADER_TYPE_PIXEL, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, 3>
+{
+    static constexpr const char* GetName() { return "g_Tex2DArr_Dyn"; }
+};
+
+struct g_CB_Mut : TypedResource<SHADER_TYPE_VERTEX, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER>
+{
+    static constexpr const char* GetName() { return "g_CB_Mut"; }
+};
+
+using TestSignature = TypedResourceSignature<g_CB_Stat, g_Tex2D_Mut, g_Tex2DArr_Dyn, g_CB_Mut>;
+
+static_assert(TestSignature::NumResources == 4, "Unexpected number of resources");
+static_assert(TestSignature::GetSlot<g_CB_Stat>() == 0, "Unexpected slot index");
+static_assert(TestSignature::GetSlot<g_Tex2DArr_Dyn>() == 2, "Unexpected slot index");
+static_assert(TestSignature::GetSlot<g_CB_Mut>() == 3, "Unexpected slot index");
+static_assert(TypedResourceSignatureInternal::GetLookupStage(g_CB_Stat::ShaderStages) == SHADER_TYPE_VERTEX, "Unexpected lookup stage");
+
+TEST(TypedResourceSignatureTest, MakeDesc)
+{
+    const auto Desc = TestSignature::MakeDesc("Typed resource signature test", 2);
+    EXPECT_STREQ(Desc.Name, "Typed resource signature test");
+    EXPECT_EQ(Desc.BindingIndex, 2);
+    ASSERT_EQ(Desc.NumResources, TestSignature::NumResources);
+
+    EXPECT_STREQ(Desc.Resources[1].Name, "g_Tex2D_Mut");
+    EXPECT_EQ(Desc.Resources[0].ShaderStages, SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL);
+    EXPECT_EQ(Desc.Resources[0].VarType, SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
+    EXPECT_EQ(Desc.Resources[2].ArraySize, 3u);
+    EXPECT_EQ(Desc.Resources[3].ResourceType, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER);
+}
+
+TEST(TypedResourceSignatureTest, SetResources)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto Signature = TestSignature::Create(pDevice, "Typed resource signature test");
+    ASSERT_TRUE(Signature);
+    ASSERT_NE(Signature.GetStaticVariable<g_CB_Stat>(), nullptr);
+
+    RefCntAutoPtr<ITextureView> pTexSRVs[3];
+    for (auto& pSRV : pTexSRVs)
+    {
+        auto pTex = pEnv->CreateTexture("Typed resource signature test texture", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 16, 16);
+        ASSERT_NE(pTex, nullptr);
+        pSRV = pTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+    }
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "Typed resource signature test buffer";
+        BuffDesc.Size      = 256;
+        BuffDesc.BindFlags = BIND_UNIFORM_BUFFER;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+        ASSERT_NE(pBuffer, nullptr);
+    }
+
+    Signature.SetStatic<g_CB_Stat>(pBuffer);
+    EXPECT_EQ(Signature.GetStaticVariable<g_CB_Stat>()->Get(0), pBuffer);
+
+    auto SRB = Signature.CreateSRB();
+    ASSERT_TRUE(SRB);
+    EXPECT_TRUE(SRB.GetSRB()->StaticResourcesInitialized());
+
+    SRB.Set<g_Tex2D_Mut>(pTexSRVs[0]);
+    IDeviceObject* ppArray[] = {pTexSRVs[1], pTexSRVs[2]};
+    SRB.SetArray<g_Tex2DArr_Dyn>(ppArray, 1, 2);
+    SRB.SetBufferRange<g_CB_Mut>(pBuffer, 0, 128);
+
+    auto* pRawSRB = SRB.GetSRB();
+    EXPECT_EQ(SRB.GetVariable<g_Tex2D_Mut>(), pRawSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2D_Mut"));
+    EXPECT_EQ(pRawSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2D_Mut")->Get(0), pTexSRVs[0]);
+    EXPECT_EQ(pRawSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2DArr_Dyn")->Get(0), nullptr);
+    EXPECT_EQ(pRawSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2DArr_Dyn")->Get(1), pTexSRVs[1]);
+    EXPECT_EQ(pRawSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2DArr_Dyn")->Get(2), pTexSRVs[2]);
+    EXPECT_EQ(pRawSRB->GetVariableByName(SHADER_TYPE_VERTEX, "g_CB_Mut")->Get(0), pBuffer);
+
+    // Dynamic variables may be updated any time
+    SRB.Set<g_Tex2DArr_Dyn>(pTexSRVs[0]);
+    EXPECT_EQ(pRawSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2DArr_Dyn")->Get(0), pTexSRVs[0]);
+}
+
+} // namespace
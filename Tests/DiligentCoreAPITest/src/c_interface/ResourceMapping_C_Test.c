@@ -72,4 +72,7 @@ void TestResourceMappingC_API(struct IResourceMapping* pResourceMapping)
     pObject = IResourceMapping_GetResource(pResourceMapping, "Resource Name", ArrayIndex);
     Size    = IResourceMapping_GetSize(pResourceMapping);
     (void)Size;
+    IResourceMapping_GetResourceArray(pResourceMapping, "Resource Array Name", 0, 1, &pObject);
+    IResourceMapping_Seal(pResourceMapping);
+    (void)IResourceMapping_IsSealed(pResourceMapping);
 }
@@ -82,6 +82,8 @@ int TestShaderResourceBindingCInterface(struct IShaderResourceBinding* pSRB)
 
 void TestShaderResourceBindingC_API(struct IShaderResourceBinding* pSRB)
 {
-    struct IResourceMapping* pResMapping = NULL;
+    struct IResourceMapping*     pResMapping = NULL;
+    ShaderResourceVariableUpdate Update      = {SHADER_TYPE_VERTEX, 0, 0, NULL, 0, 0};
     IShaderResourceBinding_BindResources(pSRB, SHADER_TYPE_VERTEX, pResMapping, BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED);
+    IShaderResourceBinding_SetResources(pSRB, &Update, 1, SET_SHADER_RESOURCE_FLAG_NONE);
 }
@@ -0,0 +1,99 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "FixedBlockMemoryAllocator.hpp"
+#include "DynamicLinearAllocator.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+void BM_FixedBlockMemoryAllocator(benchmark::State& state)
+{
+    const auto NumAllocations    = static_cast<size_t>(state.range(0));
+    const bool EnableThreadCache = state.range(1) != 0;
+
+    FixedBlockMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), 64, 256, EnableThreadCache};
+
+    std::vector<void*> Ptrs(NumAllocations);
+    for (auto _ : state)
+    {
+        for (auto& Ptr : Ptrs)
+            Ptr = Allocator.Allocate(64, "Benchmark allocation", __FILE__, __LINE__);
+        benchmark::DoNotOptimize(Ptrs.data());
+        for (auto* Ptr : Ptrs)
+            Allocator.Free(Ptr);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NumAllocations));
+}
+BENCHMARK(BM_FixedBlockMemoryAllocator)->ArgsProduct({{64, 4096}, {0, 1}})->ArgNames({"Allocs", "ThreadCache"});
+BENCHMARK(BM_FixedBlockMemoryAllocator)->Args({4096, 0})->ArgNames({"Allocs", "ThreadCache"})->Threads(4)->UseRealTime();
+BENCHMARK(BM_FixedBlockMemoryAllocator)->Args({4096, 1})->ArgNames({"Allocs", "ThreadCache"})->Threads(4)->UseRealTime();
+
+void BM_DefaultRawMemoryAllocator(benchmark::State& state)
+{
+    const auto NumAllocations = static_cast<size_t>(state.range(0));
+
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    std::vector<void*> Ptrs(NumAllocations);
+    for (auto _ : state)
+    {
+        for (auto& Ptr : Ptrs)
+            Ptr = Allocator.Allocate(64, "Benchmark allocation", __FILE__, __LINE__);
+        benchmark::DoNotOptimize(Ptrs.data());
+        for (auto* Ptr : Ptrs)
+            Allocator.Free(Ptr);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NumAllocations));
+}
+BENCHMARK(BM_DefaultRawMemoryAllocator)->Arg(64)->Arg(4096)->ArgName("Allocs");
+
+void BM_DynamicLinearAllocator(benchmark::State& state)
+{
+    const auto NumAllocations = static_cast<size_t>(state.range(0));
+
+    DynamicLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), 4 << 10};
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < NumAllocations; ++i)
+        {
+            auto* pData = Allocator.Allocate(16 + (i & 63), 16);
+            benchmark::DoNotOptimize(pData);
+        }
+        Allocator.Discard();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NumAllocations));
+}
+BENCHMARK(BM_DynamicLinearAllocator)->Arg(64)->Arg(4096)->ArgName("Allocs");
+
+} // namespace
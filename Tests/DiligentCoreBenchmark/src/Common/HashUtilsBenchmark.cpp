@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "HashUtils.hpp"
+#include "BasicMath.hpp"
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+void BM_ComputeHash_Scalars(benchmark::State& state)
+{
+    Uint32 Val = 0;
+    for (auto _ : state)
+    {
+        auto Hash = ComputeHash(Val, Val + 1, static_cast<float>(Val), Val * 3u);
+        benchmark::DoNotOptimize(Hash);
+        ++Val;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ComputeHash_Scalars);
+
+void BM_ComputeHashRaw(benchmark::State& state)
+{
+    const auto Size = static_cast<size_t>(state.range(0));
+
+    std::vector<Uint8> Data(Size);
+    for (size_t i = 0; i < Size; ++i)
+        Data[i] = static_cast<Uint8>(i * 31);
+
+    for (auto _ : state)
+    {
+        auto Hash = ComputeHashRaw(Data.data(), Data.size());
+        benchmark::DoNotOptimize(Hash);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(Size));
+}
+BENCHMARK(BM_ComputeHashRaw)->Arg(16)->Arg(256)->Arg(4096)->ArgName("Bytes");
+
+void BM_HashMapStringKey(benchmark::State& state)
+{
+    const String Str = "Diligent Engine hash map string key benchmark";
+    for (auto _ : state)
+    {
+        HashMapStringKey Key{Str.c_str()};
+        auto             Hash = Key.GetHash();
+        benchmark::DoNotOptimize(Hash);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HashMapStringKey);
+
+} // namespace
@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "LRUCache.hpp"
+#include "ShardedLRUCache.hpp"
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct CacheData
+{
+    Uint32 Value = ~0u;
+};
+
+// Range 0 is the number of distinct keys, range 1 is the cache capacity.
+// When the key count exceeds the capacity, every Get() misses and evicts.
+void BM_LRUCache_Get(benchmark::State& state)
+{
+    const auto NumKeys  = static_cast<int>(state.range(0));
+    const auto Capacity = static_cast<size_t>(state.range(1));
+
+    LRUCache<int, CacheData> Cache{Capacity};
+
+    int Key = 0;
+    for (auto _ : state)
+    {
+        auto Data = Cache.Get(Key, [Key](CacheData& Data, size_t& Size) {
+            Data.Value = static_cast<Uint32>(Key);
+            Size       = 1;
+        });
+        benchmark::DoNotOptimize(Data);
+        if (++Key == NumKeys)
+            Key = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LRUCache_Get)->Args({64, 128})->Args({256, 128})->ArgNames({"Keys", "Capacity"});
+BENCHMARK(BM_LRUCache_Get)->Args({64, 128})->ArgNames({"Keys", "Capacity"})->Threads(4)->UseRealTime();
+BENCHMARK(BM_LRUCache_Get)->Args({64, 128})->ArgNames({"Keys", "Capacity"})->Threads(8)->UseRealTime();
+
+
+// Same as BM_LRUCache_Get, but all benchmark threads share the same sharded cache
+template <CacheEvictionPolicy Policy>
+void BM_ShardedLRUCache_Get(benchmark::State& state)
+{
+    const auto NumKeys  = static_cast<int>(state.range(0));
+    const auto Capacity = static_cast<size_t>(state.range(1));
+
+    static ShardedLRUCache<int, CacheData> Cache{{Capacity, 16, Policy}};
+
+    int Key = 0;
+    for (auto _ : state)
+    {
+        auto Data = Cache.Get(Key, [Key](CacheData& Data, size_t& Size) {
+            Data.Value = static_cast<Uint32>(Key);
+            Size       = 1;
+        });
+        benchmark::DoNotOptimize(Data);
+        if (++Key == NumKeys)
+            Key = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_ShardedLRUCache_Get, CacheEvictionPolicy::LRU)->Args({64, 128})->ArgNames({"Keys", "Capacity"})->Threads(8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ShardedLRUCache_Get, CacheEvictionPolicy::Clock)->Args({64, 128})->ArgNames({"Keys", "Capacity"})->Threads(8)->UseRealTime();
+
+} // namespace
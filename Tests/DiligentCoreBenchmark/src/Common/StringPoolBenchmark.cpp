@@ -0,0 +1,67 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "StringPool.hpp"
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+void BM_StringPool_CopyString(benchmark::State& state)
+{
+    const auto NumStrings = static_cast<size_t>(state.range(0));
+
+    std::vector<String> Strings(NumStrings);
+    size_t              TotalSize = 0;
+    for (size_t i = 0; i < NumStrings; ++i)
+    {
+        Strings[i] = "String pool benchmark string #" + std::to_string(i);
+        TotalSize += Strings[i].length() + 1;
+    }
+
+    // The pool does not own the memory, so Clear() only resets it
+    std::vector<Char> Buffer(TotalSize);
+
+    StringPool Pool;
+    for (auto _ : state)
+    {
+        Pool.AssignMemory(Buffer.data(), Buffer.size());
+        for (const auto& Str : Strings)
+            benchmark::DoNotOptimize(Pool.CopyString(Str));
+        Pool.Clear();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NumStrings));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(TotalSize));
+}
+BENCHMARK(BM_StringPool_CopyString)->Arg(64)->Arg(1024)->ArgName("Strings");
+
+} // namespace
@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Range 0 is the number of worker threads, range 1 is the scheduling mode.
+// Every iteration enqueues a batch of tiny tasks and waits for all of them, so the
+// measured time is dominated by the scheduling overhead and queue contention.
+void BM_ThreadPool_Throughput(benchmark::State& state)
+{
+    constexpr Uint32 NumTasks = 1024;
+
+    ThreadPoolCreateInfo PoolCI;
+    PoolCI.NumThreads     = static_cast<size_t>(state.range(0));
+    PoolCI.SchedulingMode = static_cast<THREAD_POOL_SCHEDULING_MODE>(state.range(1));
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+
+    std::atomic<Uint32> Counter{0};
+    for (auto _ : state)
+    {
+        for (Uint32 i = 0; i < NumTasks; ++i)
+        {
+            EnqueueAsyncWork(pThreadPool,
+                             [&Counter](Uint32 ThreadId) {
+                                 Counter.fetch_add(1, std::memory_order_relaxed);
+                             });
+        }
+        pThreadPool->WaitForAllTasks();
+    }
+    pThreadPool->StopThreads();
+
+    benchmark::DoNotOptimize(Counter.load());
+    state.SetItemsProcessed(state.iterations() * NumTasks);
+}
+BENCHMARK(BM_ThreadPool_Throughput)
+    ->ArgsProduct({{1, 4, 8}, {THREAD_POOL_SCHEDULING_MODE_PRIORITY_QUEUE, THREAD_POOL_SCHEDULING_MODE_WORK_STEALING}})
+    ->ArgNames({"Threads", "Mode"})
+    ->UseRealTime();
+
+} // namespace
@@ -0,0 +1,81 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "DynamicAtlasManager.hpp"
+#include "FastRand.hpp"
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Allocates a batch of small regions of pseudo-random sizes, similar to glyphs,
+// and frees them in an interleaved order.
+// Range 0 is the number of allocations, range 1 is the region management policy.
+void BM_DynamicAtlasManager(benchmark::State& state)
+{
+    using Region = DynamicAtlasManager::Region;
+
+    const auto NumAllocations = static_cast<size_t>(state.range(0));
+
+    const auto Policy = static_cast<DYNAMIC_ATLAS_MANAGER_POLICY>(state.range(1));
+
+    DynamicAtlasManager Mgr{2048, 2048, Policy};
+
+    FastRandInt Rnd{0, 8, 32};
+
+    std::vector<std::pair<Uint32, Uint32>> Sizes(NumAllocations);
+    for (auto& Size : Sizes)
+        Size = {static_cast<Uint32>(Rnd()), static_cast<Uint32>(Rnd())};
+
+    std::vector<Region> Regions(NumAllocations);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < NumAllocations; ++i)
+            Regions[i] = Mgr.Allocate(Sizes[i].first, Sizes[i].second);
+        for (size_t i = 0; i < NumAllocations; i += 2)
+        {
+            if (!Regions[i].IsEmpty())
+                Mgr.Free(std::move(Regions[i]));
+        }
+        for (size_t i = 1; i < NumAllocations; i += 2)
+        {
+            if (!Regions[i].IsEmpty())
+                Mgr.Free(std::move(Regions[i]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NumAllocations));
+}
+BENCHMARK(BM_DynamicAtlasManager)
+    ->ArgsProduct({{64, 1024}, {DYNAMIC_ATLAS_MANAGER_POLICY_TREE, DYNAMIC_ATLAS_MANAGER_POLICY_SHELF}})
+    ->ArgNames({"Allocs", "Policy"});
+
+} // namespace
@@ -0,0 +1,64 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "RingBuffer.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Simulates per-frame dynamic allocations with a fixed number of frames in flight.
+void BM_RingBuffer(benchmark::State& state)
+{
+    using OffsetType = RingBuffer::OffsetType;
+
+    const auto NumAllocationsPerFrame = static_cast<size_t>(state.range(0));
+
+    constexpr Uint64 NumFramesInFlight = 3;
+
+    RingBuffer Buffer{OffsetType{16} << 20, DefaultRawMemoryAllocator::GetAllocator()};
+
+    Uint64 FenceValue = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < NumAllocationsPerFrame; ++i)
+        {
+            auto Offset = Buffer.Allocate(256, 16);
+            benchmark::DoNotOptimize(Offset);
+        }
+        Buffer.FinishCurrentFrame(++FenceValue);
+        if (FenceValue > NumFramesInFlight)
+            Buffer.ReleaseCompletedFrames(FenceValue - NumFramesInFlight);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NumAllocationsPerFrame));
+}
+BENCHMARK(BM_RingBuffer)->Arg(64)->Arg(1024)->ArgName("AllocsPerFrame");
+
+} // namespace
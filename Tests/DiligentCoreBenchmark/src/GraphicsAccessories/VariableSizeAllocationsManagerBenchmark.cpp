@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "VariableSizeAllocationsManager.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "FastRand.hpp"
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Allocates a batch of blocks of pseudo-random sizes and frees them in an interleaved
+// order to exercise both free-block lookup and coalescing.
+// Range 0 is the number of allocations, range 1 is the free block management policy.
+void BM_VariableSizeAllocationsManager(benchmark::State& state)
+{
+    using Allocation = VariableSizeAllocationsManager::Allocation;
+
+    const auto NumAllocations = static_cast<size_t>(state.range(0));
+
+    const auto Policy = static_cast<VARIABLE_SIZE_ALLOCATIONS_POLICY>(state.range(1));
+
+    VariableSizeAllocationsManager Mgr{size_t{64} << 20, DefaultRawMemoryAllocator::GetAllocator(), Policy};
+
+    FastRandInt Rnd{0, 16, 4096};
+
+    std::vector<size_t> Sizes(NumAllocations);
+    for (auto& Size : Sizes)
+        Size = static_cast<size_t>(Rnd());
+
+    std::vector<Allocation> Allocs(NumAllocations);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < NumAllocations; ++i)
+            Allocs[i] = Mgr.Allocate(Sizes[i], 16);
+        for (size_t i = 0; i < NumAllocations; i += 2)
+            Mgr.Free(std::move(Allocs[i]));
+        for (size_t i = 1; i < NumAllocations; i += 2)
+            Mgr.Free(std::move(Allocs[i]));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NumAllocations));
+}
+BENCHMARK(BM_VariableSizeAllocationsManager)
+    ->ArgsProduct({{64, 1024}, {VARIABLE_SIZE_ALLOCATIONS_POLICY_ORDERED_MAPS, VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF}})
+    ->ArgNames({"Allocs", "Policy"});
+
+} // namespace
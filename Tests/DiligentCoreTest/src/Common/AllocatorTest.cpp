@@ -26,11 +26,17 @@
  */
 
 #include <array>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 #include "DefaultRawMemoryAllocator.hpp"
 #include "FixedBlockMemoryAllocator.hpp"
 #include "FixedLinearAllocator.hpp"
 #include "DynamicLinearAllocator.hpp"
+#include "TrackingMemoryAllocator.hpp"
+#include "STDAllocator.hpp"
 
 #include "gtest/gtest.h"
 
@@ -124,6 +130,103 @@ TEST(Common_FixedBlockMemoryAllocator, UnalignedSize)
     }
 }
 
+TEST(Common_FixedBlockMemoryAllocator, ThreadCache)
+{
+    constexpr Uint32 AllocSize             = 16;
+    constexpr Uint32 NumAllocationsPerPage = 8;
+    constexpr size_t NumAllocations        = FixedBlockMemoryAllocator::MagazineCapacity * 5 + 3;
+
+    FixedBlockMemoryAllocator TestAllocator(DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage, true);
+
+    for (int iter = 0; iter < 3; ++iter)
+    {
+        std::vector<void*> Allocations(NumAllocations);
+        for (auto& Ptr : Allocations)
+        {
+            Ptr = TestAllocator.Allocate(AllocSize, "Thread cache test", __FILE__, __LINE__);
+            ASSERT_NE(Ptr, nullptr);
+            memset(Ptr, iter, AllocSize);
+        }
+
+        auto SortedAllocations = Allocations;
+        std::sort(SortedAllocations.begin(), SortedAllocations.end());
+        EXPECT_EQ(std::adjacent_find(SortedAllocations.begin(), SortedAllocations.end()), SortedAllocations.end()) << "Same block allocated twice";
+
+        for (size_t s = 0; s < 3; ++s)
+        {
+            for (size_t i = s; i < Allocations.size(); i += 3)
+                TestAllocator.Free(Allocations[i]);
+        }
+    }
+}
+
+TEST(Common_FixedBlockMemoryAllocator, ThreadCacheMultithreaded)
+{
+    constexpr Uint32 AllocSize             = 32;
+    constexpr Uint32 NumAllocationsPerPage = 64;
+    constexpr size_t NumAllocations        = 2048;
+
+    FixedBlockMemoryAllocator TestAllocator(DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage, true);
+
+    const auto NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    // Every thread allocates blocks and releases the blocks allocated by the next thread
+    std::vector<std::vector<void*>> Allocations(NumThreads);
+    std::atomic<Uint32>             NumThreadsAllocated{0};
+    std::atomic<Uint32>             NumErrors{0};
+
+    std::vector<std::thread> Threads(NumThreads);
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads[t] = std::thread{
+            [&, t]() {
+                auto& ThreadAllocations = Allocations[t];
+                ThreadAllocations.resize(NumAllocations);
+                for (auto& Ptr : ThreadAllocations)
+                {
+                    Ptr = TestAllocator.Allocate(AllocSize, "Multithreaded thread cache test", __FILE__, __LINE__);
+                    memset(Ptr, static_cast<int>(t), AllocSize);
+                }
+                NumThreadsAllocated.fetch_add(1);
+                while (NumThreadsAllocated.load() < NumThreads)
+                    std::this_thread::yield();
+
+                // Make sure that no other thread has written to the blocks
+                for (auto* Ptr : ThreadAllocations)
+                {
+                    const auto* pBytes = static_cast<const Uint8*>(Ptr);
+                    for (Uint32 i = 0; i < AllocSize; ++i)
+                    {
+                        if (pBytes[i] != static_cast<Uint8>(t))
+                        {
+                            NumErrors.fetch_add(1);
+                            break;
+                        }
+                    }
+                }
+                NumThreadsAllocated.fetch_add(1);
+                while (NumThreadsAllocated.load() < NumThreads * 2)
+                    std::this_thread::yield();
+
+                for (auto* Ptr : Allocations[(t + 1) % NumThreads])
+                    TestAllocator.Free(Ptr);
+            } //
+        };
+    }
+
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(NumErrors.load(), 0u);
+
+    // Blocks released by other threads must be available to this thread
+    std::vector<void*> MainAllocations(NumAllocations);
+    for (auto& Ptr : MainAllocations)
+        Ptr = TestAllocator.Allocate(AllocSize, "Multithreaded thread cache test", __FILE__, __LINE__);
+    for (auto* Ptr : MainAllocations)
+        TestAllocator.Free(Ptr);
+}
+
 TEST(Common_FixedLinearAllocator, EmptyAllocator)
 {
     FixedLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
@@ -289,4 +392,123 @@ TEST(Common_DynamicLinearAllocator, ObjectConstruction)
     EXPECT_TRUE(reinterpret_cast<size_t>(Allocator.Allocate(200, 64)) % 64 == 0);
 }
 
+
+TEST(Common_STDLinearAllocator, Vector)
+{
+    DynamicLinearAllocator LinearAllocator{DefaultRawMemoryAllocator::GetAllocator(), 256};
+
+    using VectorType = std::vector<Uint64, STDLinearAllocator<Uint64, DynamicLinearAllocator>>;
+    for (Uint32 frame = 0; frame < 3; ++frame)
+    {
+        {
+            VectorType Vec{STDLinearAllocator<Uint64, DynamicLinearAllocator>{LinearAllocator}};
+            Vec.reserve(16);
+            for (Uint64 i = 0; i < 16; ++i)
+                Vec.push_back(i * i);
+            for (Uint64 i = 0; i < 16; ++i)
+                EXPECT_EQ(Vec[static_cast<size_t>(i)], i * i);
+            EXPECT_EQ(reinterpret_cast<size_t>(Vec.data()) % alignof(Uint64), size_t{0});
+        }
+        LinearAllocator.Discard();
+        // Discarded pages are reused, so no new pages are allocated
+        EXPECT_EQ(LinearAllocator.GetBlockCount(), size_t{1});
+    }
+}
+
+TEST(Common_TrackingMemoryAllocator, Stats)
+{
+    TrackingMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    const char* const TagA = "Tag A";
+    const char* const TagB = "Tag B";
+
+    void* pA0 = Allocator.Allocate(100, TagA, "FileA.cpp", 1);
+    void* pA1 = Allocator.Allocate(50, TagA, "FileA.cpp", 2);
+    void* pB0 = Allocator.Allocate(30, TagB, "FileA.cpp", 3);
+    void* pB1 = Allocator.Allocate(20, TagB, "FileB.cpp", 4);
+    ASSERT_NE(pA0, nullptr);
+    EXPECT_EQ(reinterpret_cast<size_t>(pA0) % alignof(std::max_align_t), size_t{0});
+    std::memset(pA0, 0xAB, 100);
+
+    const auto Snapshot0 = Allocator.GetSnapshot();
+    EXPECT_EQ(Snapshot0.Tags.size(), size_t{3});
+
+    const auto Total0 = Snapshot0.GetTotal();
+    EXPECT_EQ(Total0.LiveBytes, 200);
+    EXPECT_EQ(Total0.LiveAllocations, 4);
+    EXPECT_EQ(Total0.NumAllocations, Uint64{4});
+
+    const auto ByDesc = Snapshot0.GetByDescription();
+    ASSERT_EQ(ByDesc.size(), size_t{2});
+    EXPECT_EQ(ByDesc[0].Description, TagA);
+    EXPECT_EQ(ByDesc[0].LiveBytes, 150);
+    EXPECT_EQ(ByDesc[1].Description, TagB);
+    EXPECT_EQ(ByDesc[1].LiveBytes, 50);
+
+    const auto ByFile = Snapshot0.GetByFileName();
+    ASSERT_EQ(ByFile.size(), size_t{2});
+    EXPECT_EQ(ByFile[0].FileName, "FileA.cpp");
+    EXPECT_EQ(ByFile[0].LiveBytes, 180);
+    EXPECT_EQ(ByFile[1].FileName, "FileB.cpp");
+    EXPECT_EQ(ByFile[1].LiveBytes, 20);
+
+    Allocator.Free(pA0);
+    Allocator.Free(pB0);
+    void* pA2 = Allocator.Allocate(10, TagA, "FileA.cpp", 5);
+
+    const auto Snapshot1 = Allocator.GetSnapshot();
+    const auto Total1    = Snapshot1.GetTotal();
+    EXPECT_EQ(Total1.LiveBytes, 80);
+    EXPECT_EQ(Total1.LiveAllocations, 3);
+    EXPECT_EQ(Total1.NumAllocations, Uint64{5});
+
+    const auto Diff = MemoryStatsSnapshot::Diff(Snapshot0, Snapshot1);
+    EXPECT_GE(Diff.Time, 0.0);
+    const auto DiffTotal = Diff.GetTotal();
+    EXPECT_EQ(DiffTotal.LiveBytes, -120);
+    EXPECT_EQ(DiffTotal.NumAllocations, Uint64{1});
+    EXPECT_EQ(DiffTotal.AllocatedBytes, Uint64{10});
+
+    for (const auto& Tag : Snapshot1.Tags)
+    {
+        if (Tag.Description == TagA)
+        {
+            EXPECT_EQ(Tag.LiveBytes, 60);
+            EXPECT_EQ(Tag.PeakBytes, 150);
+        }
+    }
+
+    Allocator.Free(pA1);
+    Allocator.Free(pA2);
+    Allocator.Free(pB1);
+    EXPECT_EQ(Allocator.GetSnapshot().GetTotal().LiveBytes, 0);
+}
+
+TEST(Common_TrackingMemoryAllocator, MultiThreaded)
+{
+    TrackingMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    constexpr int NumThreads     = 4;
+    constexpr int NumAllocations = 1000;
+
+    std::vector<std::thread> Threads;
+    for (int t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&Allocator]() {
+            std::vector<void*> Allocations;
+            for (int i = 0; i < NumAllocations; ++i)
+                Allocations.push_back(Allocator.Allocate(16, "Tag", __FILE__, __LINE__));
+            for (void* Ptr : Allocations)
+                Allocator.Free(Ptr);
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    const auto Total = Allocator.GetSnapshot().GetTotal();
+    EXPECT_EQ(Total.LiveBytes, 0);
+    EXPECT_EQ(Total.NumAllocations, Uint64{NumThreads * NumAllocations});
+    EXPECT_GE(Total.PeakBytes, 16 * NumAllocations);
+}
+
 } // namespace
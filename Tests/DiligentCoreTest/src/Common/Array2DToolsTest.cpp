@@ -31,6 +31,7 @@
 #include "gtest/gtest.h"
 
 #include "FastRand.hpp"
+#include "ThreadPool.hpp"
 
 using namespace Diligent;
 
@@ -111,4 +112,43 @@ TEST(Common_Array2DTools, GetArray2DMinMaxValue)
     }
 }
 
+
+TEST(Common_Array2DTools, GetArray2DMinMaxValueParallel)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    FastRandFloat Rnd{1, -100, +100};
+
+    constexpr Uint32 Width  = 251;
+    constexpr Uint32 Height = 317;
+    constexpr size_t Stride = 256;
+
+    std::vector<float> Data(Stride * Height);
+    for (auto& Val : Data)
+        Val = Rnd();
+
+    for (Uint32 test = 0; test < 4; ++test)
+    {
+        // Place the extrema in different tasks
+        const size_t MinIdx = (test * 7919) % Height * Stride + (test * 13) % Width;
+        const size_t MaxIdx = (test * 104729 + 50) % Height * Stride + (test * 31 + 5) % Width;
+        Data[MinIdx]        = -1000.f - static_cast<float>(test);
+        Data[MaxIdx]        = +1000.f + static_cast<float>(test);
+
+        float RefMin, RefMax;
+        GetArray2DMinMaxValue(Data.data(), Stride, Width, Height, RefMin, RefMax);
+        EXPECT_EQ(RefMin, Data[MinIdx]);
+        EXPECT_EQ(RefMax, Data[MaxIdx]);
+
+        for (Uint32 RowsPerTask : {0u, 1u, 10u, 64u, Height})
+        {
+            float Min = 0, Max = 0;
+            GetArray2DMinMaxValue(Data.data(), Stride, Width, Height, Min, Max, pThreadPool, RowsPerTask);
+            EXPECT_EQ(Min, RefMin) << "RowsPerTask=" << RowsPerTask;
+            EXPECT_EQ(Max, RefMax) << "RowsPerTask=" << RowsPerTask;
+        }
+    }
+}
+
 } // namespace
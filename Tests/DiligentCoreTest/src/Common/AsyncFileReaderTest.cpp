@@ -0,0 +1,221 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "AsyncFileReader.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+#include "FastRand.hpp"
+#include "TempDirectory.hpp"
+#include "TestingEnvironment.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+std::vector<Uint8> WriteTestFile(const std::string& Path, size_t Size, Uint32 Seed)
+{
+    std::vector<Uint8> Data(Size);
+
+    FastRandInt rnd{Seed, 0, 255};
+    for (auto& Byte : Data)
+        Byte = static_cast<Uint8>(rnd());
+
+    FileWrapper File{Path.c_str(), EFileAccessMode::Overwrite};
+    EXPECT_TRUE(File);
+    if (File && Size > 0)
+    {
+        EXPECT_TRUE(File->Write(Data.data(), Data.size()));
+    }
+
+    return Data;
+}
+
+void TestRead(bool ForceThreadPool)
+{
+    TempDirectory TmpDir;
+    const auto&   TmpDirPath = TmpDir.Get();
+    ASSERT_TRUE(FileSystem::PathExists(TmpDirPath.c_str()));
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_TRUE(pThreadPool);
+
+    AsyncFileReader::CreateInfo ReaderCI;
+    ReaderCI.pThreadPool     = pThreadPool;
+    ReaderCI.QueueDepth      = 4;
+    ReaderCI.ForceThreadPool = ForceThreadPool;
+    AsyncFileReader Reader{ReaderCI};
+    if (ForceThreadPool)
+    {
+        EXPECT_EQ(Reader.GetBackend(), AsyncFileReader::BACKEND_THREAD_POOL);
+    }
+
+    constexpr Uint32 NumFiles = 16;
+
+    std::vector<std::string>        Paths(NumFiles);
+    std::vector<std::vector<Uint8>> RefData(NumFiles);
+    for (Uint32 i = 0; i < NumFiles; ++i)
+    {
+        Paths[i]   = TmpDirPath + FileSystem::SlashSymbol + "File" + std::to_string(i) + ".bin";
+        RefData[i] = WriteTestFile(Paths[i], i == 0 ? 0 : size_t{1} << (4 + i), i + 1);
+    }
+
+    // Read the whole files in a single batch that exceeds the queue depth
+    {
+        std::vector<AsyncFileReader::ReadRequest> Requests(NumFiles);
+        for (Uint32 i = 0; i < NumFiles; ++i)
+            Requests[i].Path = Paths[i].c_str();
+
+        std::vector<RefCntAutoPtr<AsyncFileReader::ReadTask>> Tasks(NumFiles);
+        Reader.Read(Requests.data(), NumFiles, Tasks.data());
+
+        for (Uint32 i = 0; i < NumFiles; ++i)
+        {
+            ASSERT_TRUE(Tasks[i]);
+            Tasks[i]->WaitForCompletion();
+            EXPECT_EQ(Tasks[i]->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+            ASSERT_TRUE(Tasks[i]->IsSucceeded()) << Paths[i];
+
+            IDataBlob* pData = Tasks[i]->GetData();
+            ASSERT_NE(pData, nullptr);
+            ASSERT_EQ(pData->GetSize(), RefData[i].size());
+            if (!RefData[i].empty())
+            {
+                EXPECT_EQ(std::memcmp(pData->GetConstDataPtr(), RefData[i].data(), RefData[i].size()), 0);
+            }
+        }
+    }
+
+    // Read a range
+    {
+        const auto& Ref  = RefData[NumFiles - 1];
+        auto        Task = Reader.Read({Paths[NumFiles - 1].c_str(), 100, 1000});
+        ASSERT_TRUE(Task);
+        Task->WaitForCompletion();
+        ASSERT_TRUE(Task->IsSucceeded());
+        ASSERT_EQ(Task->GetData()->GetSize(), size_t{1000});
+        EXPECT_EQ(std::memcmp(Task->GetData()->GetConstDataPtr(), &Ref[100], 1000), 0);
+
+        Task = Reader.Read({Paths[NumFiles - 1].c_str(), 1000});
+        ASSERT_TRUE(Task);
+        Task->WaitForCompletion();
+        ASSERT_TRUE(Task->IsSucceeded());
+        ASSERT_EQ(Task->GetData()->GetSize(), Ref.size() - 1000);
+        EXPECT_EQ(std::memcmp(Task->GetData()->GetConstDataPtr(), &Ref[1000], Ref.size() - 1000), 0);
+    }
+
+    // Errors
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"Failed to open file"};
+
+        const auto MissingPath = TmpDirPath + FileSystem::SlashSymbol + "Missing.bin";
+
+        auto Task = Reader.Read({MissingPath.c_str()});
+        ASSERT_TRUE(Task);
+        Task->WaitForCompletion();
+        EXPECT_EQ(Task->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+        EXPECT_FALSE(Task->IsSucceeded());
+        EXPECT_EQ(Task->GetData(), nullptr);
+    }
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"exceeds the file size"};
+
+        auto Task = Reader.Read({Paths[1].c_str(), 0, RefData[1].size() + 1});
+        ASSERT_TRUE(Task);
+        Task->WaitForCompletion();
+        EXPECT_FALSE(Task->IsSucceeded());
+        EXPECT_EQ(Task->GetData(), nullptr);
+    }
+
+    Reader.WaitForIdle();
+    pThreadPool->WaitForAllTasks();
+}
+
+TEST(Common_AsyncFileReader, Read)
+{
+    TestRead(false);
+}
+
+TEST(Common_AsyncFileReader, ReadThreadPool)
+{
+    TestRead(true);
+}
+
+// Read tasks can be used as prerequisites of other tasks in the same thread pool
+TEST(Common_AsyncFileReader, Prerequisites)
+{
+    TempDirectory TmpDir;
+
+    const auto Path0 = TmpDir.Get() + FileSystem::SlashSymbol + "File0.bin";
+    const auto Path1 = TmpDir.Get() + FileSystem::SlashSymbol + "File1.bin";
+    const auto Data0 = WriteTestFile(Path0, 65536, 10);
+    const auto Data1 = WriteTestFile(Path1, 12345, 20);
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_TRUE(pThreadPool);
+
+    AsyncFileReader::CreateInfo ReaderCI;
+    ReaderCI.pThreadPool = pThreadPool;
+    AsyncFileReader Reader{ReaderCI};
+
+    const AsyncFileReader::ReadRequest Requests[] = {{Path0.c_str()}, {Path1.c_str()}};
+
+    RefCntAutoPtr<AsyncFileReader::ReadTask> ReadTasks[2];
+    Reader.Read(Requests, 2, ReadTasks);
+
+    std::atomic<size_t> TotalSize{0};
+    IAsyncTask*         Prerequisites[] = {ReadTasks[0], ReadTasks[1]};
+
+    auto pTask = EnqueueAsyncWork(
+        pThreadPool, Prerequisites, 2,
+        [&](Uint32 ThreadId) {
+            EXPECT_TRUE(ReadTasks[0]->IsFinished());
+            EXPECT_TRUE(ReadTasks[1]->IsFinished());
+            size_t Size = 0;
+            for (const auto& ReadTask : ReadTasks)
+            {
+                if (IDataBlob* pData = ReadTask->GetData())
+                    Size += pData->GetSize();
+            }
+            TotalSize.store(Size);
+        });
+    ASSERT_TRUE(pTask);
+
+    pThreadPool->WaitForAllTasks();
+    EXPECT_EQ(pTask->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+    EXPECT_EQ(TotalSize.load(), Data0.size() + Data1.size());
+}
+
+} // namespace
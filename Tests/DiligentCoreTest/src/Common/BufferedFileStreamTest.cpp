@@ -0,0 +1,170 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BufferedFileStream.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+#include "FastRand.hpp"
+#include "TempDirectory.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+std::vector<Uint8> MakeTestData(size_t Size, Uint32 Seed)
+{
+    std::vector<Uint8> Data(Size);
+
+    FastRandInt rnd{Seed, 0, 255};
+    for (auto& Byte : Data)
+        Byte = static_cast<Uint8>(rnd());
+
+    return Data;
+}
+
+std::vector<Uint8> ReadTestFile(const std::string& Path)
+{
+    FileWrapper File{Path.c_str(), EFileAccessMode::Read};
+    EXPECT_TRUE(File);
+    if (!File)
+        return {};
+
+    std::vector<Uint8> Data(File->GetSize());
+    if (!Data.empty())
+    {
+        EXPECT_TRUE(File->Read(Data.data(), Data.size()));
+    }
+    return Data;
+}
+
+// Writes the data in chunks of the given sizes, cycling through them
+void TestWrite(size_t BufferSize, const std::vector<size_t>& ChunkSizes)
+{
+    TempDirectory TmpDir;
+    const auto    Path = TmpDir.Get() + FileSystem::SlashSymbol + "Buffered.bin";
+
+    const auto RefData = MakeTestData(size_t{1} << 20, static_cast<Uint32>(BufferSize));
+    {
+        auto pStream = BufferedFileStream::Create(Path.c_str(), EFileAccessMode::Overwrite, BufferSize);
+        ASSERT_TRUE(pStream);
+        ASSERT_TRUE(pStream->IsValid());
+
+        size_t Offset = 0;
+        for (size_t i = 0; Offset < RefData.size(); ++i)
+        {
+            const auto Size = std::min(ChunkSizes[i % ChunkSizes.size()], RefData.size() - Offset);
+            ASSERT_TRUE(pStream->Write(&RefData[Offset], Size));
+            Offset += Size;
+        }
+        EXPECT_EQ(pStream->GetSize(), RefData.size());
+    }
+
+    const auto Data = ReadTestFile(Path);
+    ASSERT_EQ(Data.size(), RefData.size());
+    EXPECT_EQ(std::memcmp(Data.data(), RefData.data(), Data.size()), 0);
+}
+
+TEST(Common_BufferedFileStream, SmallWrites)
+{
+    TestWrite(4096, {1, 7, 64, 100, 333});
+}
+
+TEST(Common_BufferedFileStream, LargeWrites)
+{
+    TestWrite(4096, {5000, 65536, 100000});
+}
+
+TEST(Common_BufferedFileStream, MixedWrites)
+{
+    TestWrite(4096, {3, 4093, 4096, 1, 10000, 17, 4095});
+    TestWrite(BufferedFileStream::DefaultBufferSize, {3, 4093, 1 << 16, 1, 10000});
+}
+
+TEST(Common_BufferedFileStream, Read)
+{
+    TempDirectory TmpDir;
+    const auto    Path = TmpDir.Get() + FileSystem::SlashSymbol + "Buffered.bin";
+
+    const auto RefData = MakeTestData(1000, 1);
+    {
+        FileWrapper File{Path.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        ASSERT_TRUE(File->Write(RefData.data(), RefData.size()));
+    }
+
+    auto pStream = BufferedFileStream::Create(Path.c_str(), EFileAccessMode::Read);
+    ASSERT_TRUE(pStream);
+    EXPECT_EQ(pStream->GetSize(), RefData.size());
+
+    std::vector<Uint8> Data(RefData.size());
+    ASSERT_TRUE(pStream->Read(Data.data(), Data.size()));
+    EXPECT_EQ(Data, RefData);
+}
+
+TEST(Common_BufferedFileStream, WriteRanges)
+{
+    TempDirectory TmpDir;
+    const auto    Path = TmpDir.Get() + FileSystem::SlashSymbol + "Ranges.bin";
+
+    // More ranges than may be written with one system call, including empty ones
+    const auto                  RefData = MakeTestData(100000, 2);
+    std::vector<FileWriteRange> Ranges;
+    for (size_t Offset = 0; Offset < RefData.size();)
+    {
+        const auto Size = std::min(Ranges.size() % 3 == 0 ? size_t{0} : Ranges.size() * 37, RefData.size() - Offset);
+        Ranges.push_back({&RefData[Offset], Size});
+        Offset += Size;
+    }
+    ASSERT_GT(Ranges.size(), size_t{16});
+
+    {
+        FileWrapper File{Path.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        ASSERT_TRUE(File->Write(RefData.data(), 10));
+        ASSERT_TRUE(File->Write(Ranges.data(), Ranges.size()));
+        ASSERT_TRUE(File->Write(RefData.data(), 10));
+    }
+
+    const auto Data = ReadTestFile(Path);
+    ASSERT_EQ(Data.size(), RefData.size() + 20);
+    EXPECT_EQ(std::memcmp(Data.data(), RefData.data(), 10), 0);
+    EXPECT_EQ(std::memcmp(&Data[10], RefData.data(), RefData.size()), 0);
+    EXPECT_EQ(std::memcmp(&Data[10 + RefData.size()], RefData.data(), 10), 0);
+}
+
+} // namespace
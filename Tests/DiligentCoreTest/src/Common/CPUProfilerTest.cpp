@@ -0,0 +1,141 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "CPUProfiler.hpp"
+#include "Timer.hpp"
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_CPUTimer, Frequency)
+{
+    const auto Frequency = GetCPUTimestampFrequency();
+    EXPECT_GT(Frequency, Uint64{1000000});
+    EXPECT_EQ(GetCPUTimestampFrequency(), Frequency);
+    EXPECT_EQ(CPUTicksToNanoseconds(Frequency), Uint64{1000000000});
+    EXPECT_EQ(CPUTicksToNanoseconds(Frequency * 3), Uint64{3000000000});
+    EXPECT_DOUBLE_EQ(CPUTicksToSeconds(Frequency * 2), 2.0);
+}
+
+TEST(Common_CPUTimer, ElapsedTime)
+{
+    CPUTimer CPUClock;
+    Timer    Clock;
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    const auto CPUElapsed = CPUClock.GetElapsedTime();
+    const auto Elapsed    = Clock.GetElapsedTime();
+
+    EXPECT_GE(CPUElapsed, 0.015);
+    EXPECT_NEAR(CPUElapsed, Elapsed, 0.01);
+
+    CPUClock.Restart();
+    EXPECT_LT(CPUClock.GetElapsedTime(), CPUElapsed);
+}
+
+struct ProfilerEvent
+{
+    std::string Name;
+    bool        Begin     = false;
+    Uint64      Timestamp = 0;
+};
+
+CPUProfilerSink CreateTestSink(std::vector<ProfilerEvent>& Events)
+{
+    CPUProfilerSink Sink;
+    Sink.BeginScope = [](const Char* Name, Uint64 Timestamp, void* pUserData) {
+        static_cast<std::vector<ProfilerEvent>*>(pUserData)->push_back({Name, true, Timestamp});
+    };
+    Sink.EndScope = [](const Char* Name, Uint64 Timestamp, void* pUserData) {
+        static_cast<std::vector<ProfilerEvent>*>(pUserData)->push_back({Name, false, Timestamp});
+    };
+    Sink.pUserData = &Events;
+    return Sink;
+}
+
+TEST(Common_CPUProfiler, Scopes)
+{
+    EXPECT_FALSE(CPUProfiler::IsEnabled());
+    {
+        // Scopes are not recorded when there is no sink
+        CPUProfiler::Scope Scope{"Disabled"};
+    }
+
+    std::vector<ProfilerEvent> Events;
+    CPUProfiler::SetSink(CreateTestSink(Events));
+    EXPECT_TRUE(CPUProfiler::IsEnabled());
+    {
+        CPUProfiler::Scope Outer{"Outer"};
+        {
+            CPUProfiler::Scope Inner{"Inner"};
+        }
+    }
+
+    std::vector<ProfilerEvent> Events2;
+    {
+        CPUProfiler::Scope Unfinished{"Unfinished"};
+
+        // The scope that began before the sink is changed ends in the original sink
+        CPUProfiler::SetSink(CreateTestSink(Events2));
+        CPUProfiler::Scope Scope2{"Second sink"};
+        CPUProfiler::SetSink({});
+    }
+    EXPECT_FALSE(CPUProfiler::IsEnabled());
+    {
+        CPUProfiler::Scope Scope{"Disabled"};
+    }
+
+    ASSERT_EQ(Events.size(), size_t{6});
+    const char* ExpectedNames[] = {"Outer", "Inner", "Inner", "Outer", "Unfinished", "Unfinished"};
+    const bool  ExpectedBegin[] = {true, true, false, false, true, false};
+    for (size_t i = 0; i < Events.size(); ++i)
+    {
+        EXPECT_EQ(Events[i].Name, ExpectedNames[i]) << "i=" << i;
+        EXPECT_EQ(Events[i].Begin, ExpectedBegin[i]) << "i=" << i;
+        if (i > 0)
+        {
+            EXPECT_GE(Events[i].Timestamp, Events[i - 1].Timestamp) << "i=" << i;
+        }
+    }
+
+    ASSERT_EQ(Events2.size(), size_t{2});
+    EXPECT_EQ(Events2[0].Name, "Second sink");
+    EXPECT_TRUE(Events2[0].Begin);
+    EXPECT_EQ(Events2[1].Name, "Second sink");
+    EXPECT_FALSE(Events2[1].Begin);
+}
+
+} // namespace
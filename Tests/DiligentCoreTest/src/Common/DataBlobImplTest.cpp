@@ -0,0 +1,115 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "DataBlobImpl.hpp"
+#include "ExternalDataBlob.hpp"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_DataBlobImpl, CreateResize)
+{
+    const std::vector<Uint8> RefData = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    auto pBlob = DataBlobImpl::Create(RefData.size(), RefData.data());
+    ASSERT_TRUE(pBlob);
+    ASSERT_EQ(pBlob->GetSize(), RefData.size());
+    EXPECT_EQ(memcmp(pBlob->GetConstDataPtr(), RefData.data(), RefData.size()), 0);
+
+    // Grow beyond the inline capacity and beyond the first size classes
+    for (size_t NewSize : {size_t{100}, size_t{1000}, size_t{5000}, size_t{3 << 20}})
+    {
+        pBlob->Resize(NewSize);
+        ASSERT_EQ(pBlob->GetSize(), NewSize);
+
+        const auto* pData = pBlob->GetConstDataPtr<Uint8>();
+        EXPECT_EQ(memcmp(pData, RefData.data(), RefData.size()), 0);
+        for (size_t i = RefData.size(); i < NewSize; ++i)
+        {
+            if (pData[i] != 0)
+            {
+                ADD_FAILURE() << "New bytes must be zero-initialized";
+                break;
+            }
+        }
+    }
+
+    // Grown bytes must be zero-initialized after shrinking
+    pBlob->Resize(4);
+    pBlob->Resize(RefData.size());
+    EXPECT_EQ(memcmp(pBlob->GetConstDataPtr(), RefData.data(), 4), 0);
+    for (size_t i = 4; i < RefData.size(); ++i)
+        EXPECT_EQ(pBlob->GetConstDataPtr<Uint8>()[i], 0);
+
+    auto pCopy = DataBlobImpl::MakeCopy(pBlob);
+    ASSERT_TRUE(pCopy);
+    EXPECT_EQ(pCopy->GetSize(), pBlob->GetSize());
+    EXPECT_EQ(memcmp(pCopy->GetConstDataPtr(), pBlob->GetConstDataPtr(), pBlob->GetSize()), 0);
+
+    auto pEmptyBlob = DataBlobImpl::Create();
+    EXPECT_EQ(pEmptyBlob->GetSize(), size_t{0});
+}
+
+TEST(Common_DataBlobImpl, BufferReuse)
+{
+    const void* pData = nullptr;
+    {
+        auto pBlob = DataBlobImpl::Create(1000);
+        pData      = pBlob->GetConstDataPtr();
+    }
+
+    // The buffer of the released blob is reused by the blob of the same size class
+    auto pBlob = DataBlobImpl::Create(900);
+    EXPECT_EQ(pBlob->GetConstDataPtr(), pData);
+    EXPECT_EQ(pBlob->GetConstDataPtr<Uint8>()[899], 0);
+}
+
+TEST(Common_ExternalDataBlob, ReleaseCallback)
+{
+    std::vector<Uint8> Data(16, 7);
+
+    bool IsReleased = false;
+    {
+        auto pBlob = ExternalDataBlob::Create(Data.data(), Data.size(), [&IsReleased]() { IsReleased = true; });
+        ASSERT_TRUE(pBlob);
+        EXPECT_EQ(pBlob->GetDataPtr(), Data.data());
+        EXPECT_EQ(pBlob->GetSize(), Data.size());
+
+        RefCntAutoPtr<IDataBlob> pDataBlob{pBlob, IID_DataBlob};
+        EXPECT_TRUE(pDataBlob);
+        EXPECT_FALSE(IsReleased);
+    }
+    EXPECT_TRUE(IsReleased);
+}
+
+} // namespace
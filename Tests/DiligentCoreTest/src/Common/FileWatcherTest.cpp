@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "FileWatcher.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+#include "TempDirectory.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+void WriteFile(const std::string& Path, const char* Data)
+{
+    FileWrapper File{Path.c_str(), EFileAccessMode::Overwrite};
+    ASSERT_TRUE(File);
+    EXPECT_TRUE(File->Write(Data, strlen(Data)));
+}
+
+bool Contains(const std::vector<std::string>& Files, const std::string& Path)
+{
+    return std::find(Files.begin(), Files.end(), Path) != Files.end();
+}
+
+void TestWatcher(bool ForcePolling)
+{
+    TempDirectory TmpDir;
+    const auto&   TmpDirPath = TmpDir.Get();
+    ASSERT_TRUE(FileSystem::PathExists(TmpDirPath.c_str()));
+
+    const auto FilePath   = TmpDirPath + FileSystem::SlashSymbol + "File.txt";
+    const auto SubdirPath = TmpDirPath + FileSystem::SlashSymbol + "Subdir";
+    WriteFile(FilePath, "Initial");
+    ASSERT_TRUE(FileSystem::CreateDirectory(SubdirPath.c_str()));
+
+    FileWatcher::CreateInfo WatcherCI;
+    WatcherCI.ForcePolling    = ForcePolling;
+    WatcherCI.PollingInterval = 0;
+    FileWatcher Watcher{WatcherCI};
+    if (ForcePolling)
+    {
+        EXPECT_EQ(Watcher.GetBackend(), FileWatcher::BACKEND_POLLING);
+    }
+
+    EXPECT_FALSE(Watcher.AddDirectory((TmpDirPath + FileSystem::SlashSymbol + "Missing").c_str()));
+    ASSERT_TRUE(Watcher.AddDirectory(TmpDirPath.c_str()));
+    EXPECT_TRUE(Watcher.GetChangedFiles().empty());
+
+    // Modify the existing file. The size is changed so that the polling backend
+    // detects the change even if the modification time is the same.
+    WriteFile(FilePath, "Modified data");
+    {
+        const auto ChangedFiles = Watcher.GetChangedFiles();
+        EXPECT_TRUE(Contains(ChangedFiles, FilePath));
+    }
+    EXPECT_TRUE(Watcher.GetChangedFiles().empty());
+
+    // Create a file in the subdirectory
+    const auto SubdirFilePath = SubdirPath + FileSystem::SlashSymbol + "SubdirFile.txt";
+    WriteFile(SubdirFilePath, "Data");
+    {
+        const auto ChangedFiles = Watcher.GetChangedFiles();
+        EXPECT_TRUE(Contains(ChangedFiles, SubdirFilePath));
+        EXPECT_FALSE(Contains(ChangedFiles, FilePath));
+    }
+
+    // Create a new subdirectory with a file
+    const auto NewSubdirPath = TmpDirPath + FileSystem::SlashSymbol + "NewSubdir";
+    ASSERT_TRUE(FileSystem::CreateDirectory(NewSubdirPath.c_str()));
+    const auto NewSubdirFilePath = NewSubdirPath + FileSystem::SlashSymbol + "NewFile.txt";
+    WriteFile(NewSubdirFilePath, "Data");
+    {
+        const auto ChangedFiles = Watcher.GetChangedFiles();
+        EXPECT_TRUE(Contains(ChangedFiles, NewSubdirFilePath));
+    }
+
+    // Delete the file
+    FileSystem::DeleteFile(FilePath.c_str());
+    {
+        const auto ChangedFiles = Watcher.GetChangedFiles();
+        EXPECT_TRUE(Contains(ChangedFiles, FilePath));
+    }
+}
+
+TEST(Common_FileWatcher, Native)
+{
+    TestWatcher(false);
+}
+
+TEST(Common_FileWatcher, Polling)
+{
+    TestWatcher(true);
+}
+
+TEST(Common_FileWatcher, NonRecursive)
+{
+    TempDirectory TmpDir;
+    const auto&   TmpDirPath = TmpDir.Get();
+
+    const auto SubdirPath = TmpDirPath + FileSystem::SlashSymbol + "Subdir";
+    ASSERT_TRUE(FileSystem::CreateDirectory(SubdirPath.c_str()));
+
+    FileWatcher::CreateInfo WatcherCI;
+    WatcherCI.PollingInterval = 0;
+    FileWatcher Watcher{WatcherCI};
+    ASSERT_TRUE(Watcher.AddDirectory(TmpDirPath.c_str(), /*Recursive = */ false));
+
+    const auto FilePath       = TmpDirPath + FileSystem::SlashSymbol + "File.txt";
+    const auto SubdirFilePath = SubdirPath + FileSystem::SlashSymbol + "File.txt";
+    WriteFile(FilePath, "Data");
+    WriteFile(SubdirFilePath, "Data");
+
+    const auto ChangedFiles = Watcher.GetChangedFiles();
+    EXPECT_TRUE(Contains(ChangedFiles, FilePath));
+    EXPECT_FALSE(Contains(ChangedFiles, SubdirFilePath));
+}
+
+} // namespace
@@ -292,4 +292,50 @@ TEST(Common_FilteringTools, FilterTexture2DBilinear)
     }
 }
 
+
+template <TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+void TestFilterTexture2DBilinearRow()
+{
+    constexpr Uint32 Width  = 7;
+    constexpr Uint32 Height = 5;
+    constexpr size_t Stride = 9;
+
+    float Data[Stride * Height] = {};
+    for (size_t i = 0; i < _countof(Data); ++i)
+        Data[i] = static_cast<float>((i * 37) % 23);
+
+    // Sample coordinates cover the texture and go beyond its boundaries
+    float U[32] = {};
+    for (size_t i = 0; i < _countof(U); ++i)
+    {
+        U[i] = static_cast<float>(i) * 0.3f - 1.f;
+        if (IsNormalizedCoord)
+            U[i] /= static_cast<float>(Width);
+    }
+
+    for (float v : {-0.75f, 1.25f, 3.5f, 6.25f})
+    {
+        if (IsNormalizedCoord)
+            v /= static_cast<float>(Height);
+
+        float Row[_countof(U)] = {};
+        FilterTexture2DBilinearRow<float, float, AddressMode, AddressMode, IsNormalizedCoord>(Width, Height, Data, Stride, U, _countof(U), v, Row);
+        for (size_t i = 0; i < _countof(U); ++i)
+        {
+            auto Ref = FilterTexture2DBilinear<float, float, AddressMode, AddressMode, IsNormalizedCoord>(Width, Height, Data, Stride, U[i], v);
+            EXPECT_EQ(Row[i], Ref) << "u=" << U[i] << " v=" << v;
+        }
+    }
+}
+
+TEST(Common_FilteringTools, FilterTexture2DBilinearRow)
+{
+    TestFilterTexture2DBilinearRow<TEXTURE_ADDRESS_CLAMP, false>();
+    TestFilterTexture2DBilinearRow<TEXTURE_ADDRESS_CLAMP, true>();
+    TestFilterTexture2DBilinearRow<TEXTURE_ADDRESS_WRAP, false>();
+    TestFilterTexture2DBilinearRow<TEXTURE_ADDRESS_WRAP, true>();
+    TestFilterTexture2DBilinearRow<TEXTURE_ADDRESS_MIRROR, false>();
+    TestFilterTexture2DBilinearRow<TEXTURE_ADDRESS_MIRROR, true>();
+}
+
 } // namespace
@@ -186,6 +186,24 @@ TEST(Common_HashUtils, ComputeHashRaw)
     }
 }
 
+TEST(Common_HashUtils, SignedZero)
+{
+    // Values that compare equal must have equal hashes
+    EXPECT_EQ(ComputeHash(0.f), ComputeHash(-0.f));
+    EXPECT_EQ(ComputeHash(0.0), ComputeHash(-0.0));
+    EXPECT_EQ(ComputeHash(1, 0.f, 2.0), ComputeHash(1, -0.f, 2.0));
+    EXPECT_EQ(ComputeHash(1, 0.0, 2.f), ComputeHash(1, -0.0, 2.f));
+
+    SamplerDesc Desc0;
+    Desc0.MipLODBias = 0.f;
+    SamplerDesc Desc1;
+    Desc1.MipLODBias = -0.f;
+    ASSERT_EQ(Desc0, Desc1);
+    EXPECT_EQ(std::hash<SamplerDesc>{}(Desc0), std::hash<SamplerDesc>{}(Desc1));
+
+    EXPECT_NE(ComputeHash(1.f), ComputeHash(-1.f));
+}
+
 
 template <typename Type>
 class StdHasherTestHelper
@@ -982,6 +1000,7 @@ void TestGraphicsPipelineDescHasher()
     TEST_RANGE(NumViewports, Uint8{2u}, Uint8{32u});
     TEST_RANGE(SubpassIndex, Uint8{1u}, Uint8{8u});
     TEST_FLAGS(ShadingRateFlags, static_cast<PIPELINE_SHADING_RATE_FLAGS>(1), PIPELINE_SHADING_RATE_FLAG_LAST);
+    TEST_FLAGS(DynamicStateFlags, static_cast<PIPELINE_DYNAMIC_STATE_FLAGS>(1), PIPELINE_DYNAMIC_STATE_FLAG_LAST);
 
     for (Uint8 i = 1; i < MAX_RENDER_TARGETS; ++i)
     {
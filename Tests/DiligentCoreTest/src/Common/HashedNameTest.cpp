@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "HashedName.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_HashedName, Intern)
+{
+    const HashedName Null;
+    EXPECT_FALSE(Null);
+    EXPECT_EQ(Null.GetStr(), nullptr);
+    EXPECT_EQ(Null.GetHash(), size_t{0});
+
+    const std::string Str1{"HashedNameTest.Intern.Name1"};
+    const HashedName  Name1{Str1};
+    EXPECT_TRUE(Name1);
+    EXPECT_STREQ(Name1.GetStr(), Str1.c_str());
+    EXPECT_NE(Name1.GetStr(), Str1.c_str());
+    EXPECT_EQ(Name1.GetLength(), Str1.length());
+    EXPECT_NE(Name1, Null);
+
+    // Equal strings must map to the same entry
+    const HashedName Name1Copy{std::string{Str1}.c_str()};
+    EXPECT_EQ(Name1Copy, Name1);
+    EXPECT_EQ(Name1Copy.GetStr(), Name1.GetStr());
+    EXPECT_EQ(Name1Copy.GetHash(), Name1.GetHash());
+
+    const HashedName Name2{"HashedNameTest.Intern.Name2"};
+    EXPECT_NE(Name2, Name1);
+
+    const HashedName Empty{""};
+    EXPECT_TRUE(Empty);
+    EXPECT_STREQ(Empty.GetStr(), "");
+    EXPECT_EQ(Empty, HashedName{""});
+
+    std::unordered_set<HashedName> Set{Name1, Name2, Empty};
+    EXPECT_EQ(Set.count(HashedName{"HashedNameTest.Intern.Name1"}), size_t{1});
+    EXPECT_EQ(Set.size(), size_t{3});
+}
+
+TEST(Common_HashedName, Find)
+{
+    EXPECT_FALSE(HashedName::Find("HashedNameTest.Find.NeverInterned"));
+    EXPECT_FALSE(HashedName::Find(nullptr));
+
+    const HashedName Name{"HashedNameTest.Find.Interned"};
+    EXPECT_EQ(HashedName::Find("HashedNameTest.Find.Interned"), Name);
+    // Prefixes of interned strings must not match
+    EXPECT_FALSE(HashedName::Find("HashedNameTest.Find.Intern"));
+}
+
+TEST(Common_HashedName, MultithreadedIntern)
+{
+    constexpr size_t NumThreads = 8;
+    constexpr size_t NumNames   = 2000;
+
+    std::vector<std::vector<HashedName>> Names(NumThreads);
+    std::vector<std::thread>             Threads;
+
+    std::atomic<size_t> NumThreadsReady{0};
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&, t]() {
+            NumThreadsReady.fetch_add(1);
+            while (NumThreadsReady.load() < NumThreads)
+                std::this_thread::yield();
+
+            Names[t].resize(NumNames);
+            // Threads intern the same names in different order
+            for (size_t i = 0; i < NumNames; ++i)
+            {
+                const size_t Idx = (t % 2 == 0) ? i : NumNames - 1 - i;
+                Names[t][Idx]    = HashedName{"HashedNameTest.Multithreaded." + std::to_string(Idx)};
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    for (size_t i = 0; i < NumNames; ++i)
+    {
+        const auto RefStr = "HashedNameTest.Multithreaded." + std::to_string(i);
+        for (size_t t = 0; t < NumThreads; ++t)
+        {
+            ASSERT_EQ(Names[t][i], Names[0][i]);
+        }
+        EXPECT_STREQ(Names[0][i].GetStr(), RefStr.c_str());
+        EXPECT_EQ(HashedName::Find(RefStr.c_str()), Names[0][i]);
+    }
+}
+
+} // namespace
@@ -25,11 +25,13 @@
  */
 
 #include "LRUCache.hpp"
+#include "ShardedLRUCache.hpp"
 
 #include "gtest/gtest.h"
 
 #include <thread>
 #include <functional>
+#include <stdexcept>
 
 #include "ThreadSignal.hpp"
 
@@ -183,4 +185,138 @@ TEST(Common_LRUCache, Exceptions)
     }
 }
 
+
+using TestShardedCache = ShardedLRUCache<int, CacheData>;
+
+TEST(Common_ShardedLRUCache, Get)
+{
+    for (auto Policy : {CacheEvictionPolicy::LRU, CacheEvictionPolicy::Clock})
+    {
+        TestShardedCache Cache{{64, 4, Policy}};
+
+        constexpr Uint32                    NumThreads = 16;
+        std::vector<std::thread>            Threads(NumThreads);
+        std::vector<std::vector<CacheData>> ThreadsData(NumThreads);
+
+        Threading::Signal StartSignal;
+        for (Uint32 i = 0; i < NumThreads; ++i)
+        {
+            ThreadsData[i].resize(256);
+
+            Threads[i] = std::thread(
+                [&](Uint32 ThreadId) {
+                    StartSignal.Wait();
+
+                    auto& Data = ThreadsData[ThreadId];
+                    for (Uint32 i = 0; i < Data.size(); ++i)
+                    {
+                        // Access the same keys from all threads, with many repeated hits
+                        const Uint32 Key = (i * 7) % 96;
+                        Data[i]          = Cache.Get(static_cast<int>(Key),
+                                            [&](CacheData& Data, size_t& Size) //
+                                            {
+                                                Data.Value = Key;
+                                                Size       = 1;
+                                            });
+                    }
+                },
+                i);
+        }
+        StartSignal.Trigger(true);
+
+        for (auto& T : Threads)
+            T.join();
+
+        for (auto& Data : ThreadsData)
+        {
+            for (Uint32 i = 0; i < Data.size(); ++i)
+            {
+                EXPECT_EQ(Data[i].Value, (i * 7) % 96);
+            }
+        }
+        // Every shard may exceed its budget only by the entries that are being initialized
+        EXPECT_LE(Cache.GetCurrSize(), size_t{64});
+    }
+}
+
+TEST(Common_ShardedLRUCache, EvictionOrder)
+{
+    auto Init = [](int Key) {
+        return [Key](CacheData& Data, size_t& Size) {
+            Data.Value = static_cast<Uint32>(Key);
+            Size       = 1;
+        };
+    };
+    auto IsCached = [](TestShardedCache& Cache, int Key) {
+        bool Initialized = false;
+        Cache.Get(Key, [&](CacheData& Data, size_t& Size) {
+            Initialized = true;
+            Size        = 1;
+        });
+        return !Initialized;
+    };
+
+    for (auto Policy : {CacheEvictionPolicy::LRU, CacheEvictionPolicy::Clock})
+    {
+        TestShardedCache Cache{{3, 1, Policy}};
+        Cache.Get(0, Init(0));
+        Cache.Get(1, Init(1));
+        Cache.Get(2, Init(2));
+        // Access the oldest entry so that the next one is evicted instead
+        Cache.Get(0, Init(0));
+        Cache.Get(3, Init(3));
+        EXPECT_EQ(Cache.GetCurrSize(), size_t{3});
+
+        EXPECT_FALSE(IsCached(Cache, 1));
+        EXPECT_TRUE(IsCached(Cache, 0));
+    }
+}
+
+TEST(Common_ShardedLRUCache, Budget)
+{
+    std::atomic<size_t> Budget{100};
+
+    TestShardedCache::CreateInfo CI;
+    CI.NumShards = 4;
+    CI.GetBudget = [&Budget]() {
+        return Budget.load();
+    };
+    TestShardedCache Cache{CI};
+
+    for (int i = 0; i < 50; ++i)
+    {
+        Cache.Get(i, [](CacheData& Data, size_t& Size) {
+            Size = 2;
+        });
+    }
+    // Each shard is limited by its part of the budget, so keys that are
+    // unevenly distributed between shards may be evicted earlier.
+    EXPECT_LE(Cache.GetCurrSize(), size_t{100});
+    EXPECT_GE(Cache.GetCurrSize(), size_t{50});
+
+    Budget.store(20);
+    Cache.Trim();
+    EXPECT_LE(Cache.GetCurrSize(), size_t{20});
+
+    Budget.store(0);
+    Cache.Trim();
+    EXPECT_EQ(Cache.GetCurrSize(), size_t{0});
+}
+
+TEST(Common_ShardedLRUCache, Exceptions)
+{
+    TestShardedCache Cache{{16, 2, CacheEvictionPolicy::Clock}};
+
+    EXPECT_THROW(Cache.Get(1, [](CacheData& Data, size_t& Size) { throw std::runtime_error("test error"); }), std::runtime_error);
+    EXPECT_EQ(Cache.GetCurrSize(), size_t{0});
+
+    // The failed entry must be reinitialized
+    auto Data = Cache.Get(1, [](CacheData& Data, size_t& Size) {
+        Data.Value = 10;
+        Size       = 1;
+    });
+    EXPECT_EQ(Data.Value, 10u);
+    EXPECT_EQ(Cache.GetCurrSize(), size_t{1});
+}
+
 } // namespace
@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "LockFreeQueue.hpp"
+
+#include <vector>
+#include <thread>
+#include <atomic>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_LockFreeQueue, PushPop)
+{
+    Threading::LockFreeQueue<int> Queue{4};
+    EXPECT_EQ(Queue.GetCapacity(), 4u);
+
+    int Val = -1;
+    EXPECT_FALSE(Queue.TryPop(Val));
+
+    for (int lap = 0; lap < 3; ++lap)
+    {
+        for (int i = 0; i < 4; ++i)
+            EXPECT_TRUE(Queue.TryPush(i + lap * 10));
+        EXPECT_FALSE(Queue.TryPush(100));
+
+        for (int i = 0; i < 4; ++i)
+        {
+            EXPECT_TRUE(Queue.TryPop(Val));
+            EXPECT_EQ(Val, i + lap * 10);
+        }
+        EXPECT_FALSE(Queue.TryPop(Val));
+    }
+}
+
+TEST(Common_LockFreeQueue, MultipleProducersConsumers)
+{
+    const auto NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+    LOG_INFO_MESSAGE("Running LockFreeQueue test on ", NumThreads, " threads");
+
+    static constexpr size_t NumThreadIterations = 16384;
+
+    Threading::LockFreeQueue<size_t> Queue{256};
+
+    std::atomic<size_t> PoppedCount{0};
+    std::atomic<size_t> PoppedSum{0};
+
+    std::vector<std::thread> Workers;
+    Workers.reserve(NumThreads * 2);
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        Workers.emplace_back(
+            [&Queue, t]() {
+                for (size_t i = 0; i < NumThreadIterations; ++i)
+                {
+                    size_t Val = t * NumThreadIterations + i + 1;
+                    while (!Queue.TryPush(std::move(Val)))
+                        std::this_thread::yield();
+                }
+            });
+        Workers.emplace_back(
+            [&Queue, &PoppedCount, &PoppedSum]() {
+                for (size_t i = 0; i < NumThreadIterations; ++i)
+                {
+                    size_t Val = 0;
+                    while (!Queue.TryPop(Val))
+                        std::this_thread::yield();
+                    PoppedSum.fetch_add(Val);
+                    PoppedCount.fetch_add(1);
+                }
+            });
+    }
+    for (auto& Thread : Workers)
+        Thread.join();
+
+    const size_t TotalCount = NumThreads * NumThreadIterations;
+    EXPECT_EQ(PoppedCount.load(), TotalCount);
+    EXPECT_EQ(PoppedSum.load(), TotalCount * (TotalCount + 1) / 2);
+
+    size_t Val = 0;
+    EXPECT_FALSE(Queue.TryPop(Val));
+}
+
+} // namespace
@@ -26,7 +26,9 @@
  */
 
 #include <climits>
+#include <cstring>
 #include <sstream>
+#include <vector>
 
 #include "BasicMath.hpp"
 #include "AdvancedMath.hpp"
@@ -1177,6 +1179,90 @@ TEST(Common_BasicMath, MatrixMultiply)
     }
 }
 
+// Float wrapper that makes the math library use the generic scalar implementation
+struct ScalarFloat
+{
+    float f = 0;
+
+    constexpr ScalarFloat() noexcept {}
+    constexpr ScalarFloat(float _f) noexcept :
+        f{_f}
+    {}
+
+    // clang-format off
+    constexpr ScalarFloat operator+(ScalarFloat rhs) const { return f + rhs.f; }
+    constexpr ScalarFloat operator-(ScalarFloat rhs) const { return f - rhs.f; }
+    constexpr ScalarFloat operator*(ScalarFloat rhs) const { return f * rhs.f; }
+    constexpr ScalarFloat operator/(ScalarFloat rhs) const { return f / rhs.f; }
+    constexpr ScalarFloat operator-() const { return -f; }
+    ScalarFloat& operator+=(ScalarFloat rhs) { f += rhs.f; return *this; }
+    ScalarFloat& operator-=(ScalarFloat rhs) { f -= rhs.f; return *this; }
+    ScalarFloat& operator*=(ScalarFloat rhs) { f *= rhs.f; return *this; }
+    // clang-format on
+};
+
+template <typename DstType, typename SrcType>
+DstType RecastMatrix(const SrcType& Src)
+{
+    DstType Dst;
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = 0; j < 4; ++j)
+            reinterpret_cast<float&>(Dst.m[i][j]) = reinterpret_cast<const float&>(Src.m[i][j]);
+    }
+    return Dst;
+}
+
+// Float operations must produce bit-identical results regardless of whether SIMD is enabled
+TEST(Common_BasicMath, FloatOpsBitExactness)
+{
+    static_assert(sizeof(ScalarFloat) == sizeof(float), "Unexpected ScalarFloat size");
+
+    unsigned int Seed = 19;
+    auto         Rand = [&Seed]() {
+        Seed = Seed * 1103515245u + 12345u;
+        return static_cast<float>((Seed >> 8) & 0xFFFF) / 4096.f - 8.f;
+    };
+
+    for (int iter = 0; iter < 64; ++iter)
+    {
+        float4x4 m1, m2;
+        float4   v;
+        for (int i = 0; i < 4; ++i)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                m1.m[i][j] = Rand();
+                m2.m[i][j] = Rand();
+            }
+            v[i] = Rand();
+        }
+
+        const auto rm1 = RecastMatrix<Matrix4x4<ScalarFloat>>(m1);
+        const auto rm2 = RecastMatrix<Matrix4x4<ScalarFloat>>(m2);
+        const auto rv  = Vector4<ScalarFloat>{v.x, v.y, v.z, v.w};
+
+        auto ExpectBitEqual = [](const float4x4& m, const Matrix4x4<ScalarFloat>& ref) {
+            EXPECT_EQ(memcmp(m.Data(), ref.Data(), sizeof(m)), 0);
+        };
+        ExpectBitEqual(m1 * m2, rm1 * rm2);
+        ExpectBitEqual(m1.Transpose(), rm1.Transpose());
+        ExpectBitEqual(m1.Inverse(), rm1.Inverse());
+
+        const auto vm  = v * m1;
+        const auto rvm = rv * rm1;
+        EXPECT_EQ(memcmp(&vm, &rvm, sizeof(vm)), 0);
+
+        const auto mv  = m1 * v;
+        const auto rmv = rm1 * rv;
+        EXPECT_EQ(memcmp(&mv, &rmv, sizeof(mv)), 0);
+
+        const float d  = dot(v, float4{m2.m[0][0], m2.m[0][1], m2.m[0][2], m2.m[0][3]});
+        const auto  rd = dot(rv, Vector4<ScalarFloat>{rm2.m[0][0], rm2.m[0][1], rm2.m[0][2], rm2.m[0][3]});
+        EXPECT_EQ(memcmp(&d, &rd.f, sizeof(d)), 0);
+    }
+}
+
 TEST(Common_BasicMath, VectorRecast)
 {
     EXPECT_EQ(float2(1, 2).Recast<int>(), Vector2<int>(1, 2));
@@ -2287,6 +2373,74 @@ TEST(Common_AdvancedMath, TransformBoundBox)
     }
 }
 
+TEST(Common_AdvancedMath, GetBoxVisibilityBatch)
+{
+    unsigned int Seed = 7;
+    auto         Rand = [&Seed](float Min, float Max) {
+        Seed = Seed * 1103515245u + 12345u;
+        return Min + (Max - Min) * static_cast<float>((Seed >> 8) & 0xFFFF) / 65535.f;
+    };
+
+    // Use a number of boxes that is not a multiple of 32 to test the tail handling
+    constexpr size_t   NumBoxes = 1000;
+    std::vector<float> Coords[6];
+    for (auto& Stream : Coords)
+        Stream.resize(NumBoxes);
+
+    std::vector<BoundBox> Boxes(NumBoxes);
+    for (size_t i = 0; i < NumBoxes; ++i)
+    {
+        const float3 Center{Rand(-40, 40), Rand(-40, 40), Rand(-10, 70)};
+        const float3 Extent{Rand(0, 5), Rand(0, 5), Rand(0, 5)};
+
+        Boxes[i].Min = Center - Extent;
+        Boxes[i].Max = Center + Extent;
+        for (int c = 0; c < 3; ++c)
+        {
+            Coords[c][i]     = Boxes[i].Min[c];
+            Coords[c + 3][i] = Boxes[i].Max[c];
+        }
+    }
+    const BoundBoxSoA BoxesSoA{Coords[0].data(), Coords[1].data(), Coords[2].data(), Coords[3].data(), Coords[4].data(), Coords[5].data()};
+
+    const float4x4 ViewProj = float4x4::RotationY(0.5f) * float4x4::RotationX(-0.25f) * float4x4::Projection(PI_F / 3.f, 1.5f, 1.f, 50.f, false);
+
+    ViewFrustumExt Frustum;
+    ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, false);
+
+    const FRUSTUM_PLANE_FLAGS TestFlags[] = {
+        FRUSTUM_PLANE_FLAG_FULL_FRUSTUM,
+        FRUSTUM_PLANE_FLAG_OPEN_NEAR,
+        FRUSTUM_PLANE_FLAG_LEFT_PLANE | FRUSTUM_PLANE_FLAG_TOP_PLANE,
+        FRUSTUM_PLANE_FLAG_NONE,
+    };
+    for (auto PlaneFlags : TestFlags)
+    {
+        std::vector<Uint32> Mask(NumBoxes / 32 + 1, 0xFFFFFFFFu);
+        std::vector<Uint32> MaskExt(NumBoxes / 32 + 1, 0xFFFFFFFFu);
+        GetBoxVisibilityBatch(static_cast<const ViewFrustum&>(Frustum), BoxesSoA, NumBoxes, Mask.data(), PlaneFlags);
+        GetBoxVisibilityBatch(Frustum, BoxesSoA, NumBoxes, MaskExt.data(), PlaneFlags);
+
+        size_t NumVisible = 0;
+        for (size_t i = 0; i < NumBoxes; ++i)
+        {
+            const bool IsVisible    = GetBoxVisibility(static_cast<const ViewFrustum&>(Frustum), Boxes[i], PlaneFlags) != BoxVisibility::Invisible;
+            const bool IsVisibleExt = GetBoxVisibility(Frustum, Boxes[i], PlaneFlags) != BoxVisibility::Invisible;
+            EXPECT_EQ((Mask[i / 32] >> (i % 32)) & 1u, IsVisible ? 1u : 0u) << "Box " << i;
+            EXPECT_EQ((MaskExt[i / 32] >> (i % 32)) & 1u, IsVisibleExt ? 1u : 0u) << "Box " << i;
+            NumVisible += IsVisibleExt ? 1 : 0;
+        }
+        EXPECT_GT(NumVisible, size_t{0});
+        if (PlaneFlags == FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+        {
+            EXPECT_LT(NumVisible, NumBoxes);
+        }
+
+        // Unused bits of the last element must be zero
+        EXPECT_EQ(Mask.back() >> (NumBoxes % 32), 0u);
+    }
+}
+
 TEST(Common_AdvancedMath, CheckBox2DBox2DOverlap)
 {
     // clang-format off
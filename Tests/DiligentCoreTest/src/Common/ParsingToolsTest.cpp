@@ -26,6 +26,8 @@
 
 #include "ParsingTools.hpp"
 
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "TestingEnvironment.hpp"
@@ -317,6 +319,47 @@ TEST(Common_ParsingTools, SkipIdentifier)
     Test("_a1b2c3[5]", "[5]");
 }
 
+TEST(Common_ParsingTools, ContiguousFastPath)
+{
+    // Contiguous ranges are scanned with SIMD, while std::vector<char> iterators use the generic path.
+    // Both must produce the same results for inputs that are longer than one SIMD block.
+    const std::string Padding(37, ' ');
+    const std::string LongIdent = "_abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    const std::string Sources[] =
+        {
+            LongIdent + "+1",
+            LongIdent + "\xC0",
+            Padding + "\t\r\n" + Padding + "x",
+            Padding,
+            "// " + LongIdent + Padding + "\r\nNext",
+            "// " + LongIdent + Padding,
+            "/* " + LongIdent + " * / ** " + Padding + "*/" + LongIdent,
+            LongIdent + std::string(1, '\0') + LongIdent,
+        };
+
+    for (const auto& Src : Sources)
+    {
+        const std::vector<char> Chars{Src.begin(), Src.end()};
+
+        const char* const pStart = Src.c_str();
+        const char* const pEnd   = pStart + Src.length();
+
+        auto CheckPos = [&](const char* Pos, std::vector<char>::const_iterator CharsPos) {
+            EXPECT_EQ(static_cast<size_t>(Pos - pStart), static_cast<size_t>(std::distance(Chars.begin(), CharsPos))) << Src;
+        };
+
+        CheckPos(SkipLine(pStart, pEnd), SkipLine(Chars.begin(), Chars.end()));
+        CheckPos(SkipLine(pStart, pEnd, true), SkipLine(Chars.begin(), Chars.end(), true));
+        CheckPos(SkipDelimiters(pStart, pEnd), SkipDelimiters(Chars.begin(), Chars.end()));
+        CheckPos(SkipIdentifier(pStart, pEnd), SkipIdentifier(Chars.begin(), Chars.end()));
+        CheckPos(SkipComment(pStart, pEnd), SkipComment(Chars.begin(), Chars.end()));
+
+        // std::string iterators also use the fast path
+        EXPECT_EQ(SkipDelimitersAndComments(Src.begin(), Src.end()) - Src.begin(),
+                  SkipDelimitersAndComments(pStart, pEnd) - pStart);
+    }
+}
+
 TEST(Common_ParsingTools, SplitString)
 {
     static const char* TestStr = R"(
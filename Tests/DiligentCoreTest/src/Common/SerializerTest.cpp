@@ -53,6 +53,8 @@ TEST(SerializerTest, SerializerTest)
     const size_t RefNumBytes2            = 5;
     const Uint8  RefBytes2[RefNumBytes2] = {37, 53, 13, 94, 129};
     const size_t RefNumBytes3            = 7;
+    const Uint32 RefArray64Size          = 2;
+    const Uint64 RefArray64[]            = {0x123456789ABCDEF0ull, 0x0FEDCBA987654321ull};
     const Uint8  RefBytes3[RefNumBytes3] = {93, 67, 50, 145, 41, 59, 43};
 
     auto& RawAllocator{DefaultRawMemoryAllocator::GetAllocator()};
@@ -67,6 +69,7 @@ TEST(SerializerTest, SerializerTest)
         EXPECT_TRUE(Ser(RefU32));
         EXPECT_TRUE(Ser.SerializeArrayRaw(&TmpAllocator, RefArray, RefArraySize));
         EXPECT_TRUE(Ser.CopyBytes(RefBytes1, sizeof(RefBytes1)));
+        EXPECT_TRUE(Ser.SerializeArrayRaw(&TmpAllocator, RefArray64, RefArray64Size));
         EXPECT_TRUE(Ser.SerializeBytes(RefBytes2, RefNumBytes2));
         EXPECT_TRUE(Ser.SerializeBytes(RefBytes3, RefNumBytes3));
     };
@@ -143,6 +146,19 @@ TEST(SerializerTest, SerializerTest)
             EXPECT_EQ(Bytes[i], RefBytes1[i]);
     }
 
+    {
+        // Const arrays reference the source data
+        Uint32        ArraySize = 0;
+        const Uint64* pArray    = nullptr;
+        EXPECT_TRUE(RSer.SerializeArrayRaw(nullptr, pArray, ArraySize));
+        EXPECT_EQ(ArraySize, RefArray64Size);
+        EXPECT_EQ(reinterpret_cast<size_t>(pArray) % alignof(Uint64), size_t{0});
+        EXPECT_GE(reinterpret_cast<const Uint8*>(pArray), Data.Ptr<const Uint8>());
+        EXPECT_LT(reinterpret_cast<const Uint8*>(pArray), Data.Ptr<const Uint8>() + Data.Size());
+        for (Uint32 i = 0; i < RefArray64Size; ++i)
+            EXPECT_EQ(RefArray64[i], pArray[i]);
+    }
+
     {
         size_t      NumBytes2 = 0;
         const void* pBytes2   = nullptr;
@@ -0,0 +1,139 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "StartupProfiler.hpp"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_StartupProfiler, Hierarchy)
+{
+    {
+        // Scopes are not recorded when the profiler is not active
+        StartupProfiler::Scope Scope{"Inactive"};
+    }
+
+    ASSERT_TRUE(StartupProfiler::Start());
+    EXPECT_TRUE(StartupProfiler::IsActive());
+    EXPECT_FALSE(StartupProfiler::Start());
+
+    {
+        StartupProfiler::Scope Root{"Create device"};
+        {
+            StartupProfiler::Scope Child{"Create", "Texture"};
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        StartupProfiler::AddMark("Mark");
+
+        std::thread Worker{
+            []() {
+                StartupProfiler::Scope WorkerScope{"Worker"};
+            }};
+        Worker.join();
+    }
+    StartupProfiler::Scope Unfinished{"Unfinished"};
+
+    StartupTimeline Timeline;
+    ASSERT_TRUE(StartupProfiler::Stop(Timeline));
+    EXPECT_FALSE(StartupProfiler::IsActive());
+    {
+        StartupTimeline Timeline2;
+        EXPECT_FALSE(StartupProfiler::Stop(Timeline2));
+    }
+
+    ASSERT_EQ(Timeline.Events.size(), 5u);
+
+    const auto& Root = Timeline.Events[0];
+    EXPECT_EQ(Root.Name, "Create device");
+    EXPECT_EQ(Root.Depth, 0u);
+    EXPECT_EQ(Root.Parent, Uint32{StartupTimelineEvent::InvalidParent});
+    EXPECT_EQ(Root.ThreadIndex, 0u);
+    EXPECT_GT(Root.Duration, 0.0);
+
+    const auto& Child = Timeline.Events[1];
+    EXPECT_EQ(Child.Name, "Create 'Texture'");
+    EXPECT_EQ(Child.Depth, 1u);
+    EXPECT_EQ(Child.Parent, 0u);
+    EXPECT_GE(Child.StartTime, Root.StartTime);
+    EXPECT_GE(Child.Duration, 0.001);
+    EXPECT_LE(Child.Duration, Root.Duration);
+
+    const auto& Mark = Timeline.Events[2];
+    EXPECT_EQ(Mark.Name, "Mark");
+    EXPECT_EQ(Mark.Parent, 0u);
+    EXPECT_EQ(Mark.Duration, 0.0);
+
+    const auto& Worker = Timeline.Events[3];
+    EXPECT_EQ(Worker.Name, "Worker");
+    EXPECT_EQ(Worker.ThreadIndex, 1u);
+    EXPECT_EQ(Worker.Depth, 0u);
+    EXPECT_EQ(Worker.Parent, Uint32{StartupTimelineEvent::InvalidParent});
+
+    const auto& UnfinishedEvent = Timeline.Events[4];
+    EXPECT_EQ(UnfinishedEvent.Name, "Unfinished");
+    EXPECT_LT(UnfinishedEvent.Duration, 0.0);
+    EXPECT_GE(Timeline.TotalTime, UnfinishedEvent.StartTime);
+
+    const auto Report = Timeline.GetReport();
+    EXPECT_NE(Report.find("Thread 1:"), std::string::npos);
+    EXPECT_NE(Report.find("Unfinished: in progress"), std::string::npos);
+
+    const auto JSON = Timeline.GetJSON();
+    EXPECT_NE(JSON.find("\"name\":\"Create 'Texture'\""), std::string::npos);
+    EXPECT_NE(JSON.find("\"ph\":\"i\""), std::string::npos);
+}
+
+TEST(Common_StartupProfiler, Restart)
+{
+    ASSERT_TRUE(StartupProfiler::Start());
+    {
+        StartupProfiler::Scope Scope{"First \"session\""};
+        StartupTimeline Timeline;
+        ASSERT_TRUE(StartupProfiler::Stop(Timeline));
+        ASSERT_EQ(Timeline.Events.size(), 1u);
+        EXPECT_NE(Timeline.GetJSON().find("\"First \\\"session\\\"\""), std::string::npos);
+
+        // The scope of the previous session must not affect the new one
+        ASSERT_TRUE(StartupProfiler::Start());
+    }
+    StartupProfiler::AddMark("Second session");
+
+    StartupTimeline Timeline;
+    ASSERT_TRUE(StartupProfiler::Stop(Timeline));
+    ASSERT_EQ(Timeline.Events.size(), 1u);
+    EXPECT_EQ(Timeline.Events[0].Name, "Second session");
+    EXPECT_EQ(Timeline.Events[0].Depth, 0u);
+}
+
+} // namespace
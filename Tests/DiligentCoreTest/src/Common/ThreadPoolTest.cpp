@@ -30,8 +30,11 @@
 
 #include <array>
 #include <cmath>
+#include <vector>
 
 #include "ThreadSignal.hpp"
+#include "ParallelFrustumCulling.hpp"
+#include "PlatformMisc.hpp"
 
 
 using namespace Diligent;
@@ -222,6 +225,7 @@ TEST(Common_ThreadPool, RemoveTask)
     {
         auto res = pThreadPool->RemoveTask(Task, true);
         EXPECT_TRUE(res);
+        EXPECT_EQ(Task->GetStatus(), ASYNC_TASK_STATUS_CANCELLED);
     }
 
     // Wait until tasks are started
@@ -356,4 +360,359 @@ TEST(Common_ThreadPool, Priorities)
     }
 }
 
+
+TEST(Common_ThreadPool, WorkStealing)
+{
+    constexpr Uint32 NumThreads = 4;
+    constexpr Uint32 NumTasks   = 256;
+
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.SchedulingMode = THREAD_POOL_SCHEDULING_MODE_WORK_STEALING;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::array<std::atomic<bool>, NumTasks> WorkComplete{};
+    std::atomic<Uint32>                     NumSubtasksComplete{0};
+    for (size_t i = 0; i < NumTasks; ++i)
+    {
+        EnqueueAsyncWork(pThreadPool,
+                         [i, &WorkComplete, &NumSubtasksComplete, &ThreadPool = *pThreadPool](Uint32 ThreadId) //
+                         {
+                             // Subtasks enqueued from the worker thread go to the thread's local queue
+                             EnqueueAsyncWork(&ThreadPool,
+                                              [&NumSubtasksComplete](Uint32 ThreadId) //
+                                              {
+                                                  NumSubtasksComplete.fetch_add(1);
+                                              });
+                             WorkComplete[i].store(true);
+                         });
+    }
+
+    pThreadPool->WaitForAllTasks();
+
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+    EXPECT_EQ(pThreadPool->GetRunningTaskCount(), 0u);
+    EXPECT_EQ(NumSubtasksComplete.load(), NumTasks);
+    for (size_t i = 0; i < WorkComplete.size(); ++i)
+        EXPECT_TRUE(WorkComplete[i]) << "i=" << i;
+}
+
+
+TEST(Common_ThreadPool, Placement)
+{
+    constexpr Uint32 NumThreads = 4;
+    constexpr Uint32 NumTasks   = 64;
+
+    const auto& Topology = PlatformMisc::GetCPUTopology();
+    for (auto Placement : {THREAD_POOL_PLACEMENT_ANY,
+                           THREAD_POOL_PLACEMENT_PERFORMANCE_CORES,
+                           THREAD_POOL_PLACEMENT_EFFICIENCY_CORES,
+                           THREAD_POOL_PLACEMENT_ONE_THREAD_PER_CORE})
+    {
+        for (Uint64 AffinityMask : {Uint64{0}, Topology.GetAffinityMask(CPU_CORE_TYPE_PERFORMANCE)})
+        {
+            ThreadPoolCreateInfo PoolCI{NumThreads};
+            PoolCI.Placement    = Placement;
+            PoolCI.AffinityMask = AffinityMask;
+
+            auto pThreadPool = CreateThreadPool(PoolCI);
+            ASSERT_NE(pThreadPool, nullptr);
+
+            std::atomic<Uint32> NumTasksComplete{0};
+            for (Uint32 i = 0; i < NumTasks; ++i)
+            {
+                EnqueueAsyncWork(pThreadPool,
+                                 [&NumTasksComplete](Uint32 ThreadId) //
+                                 {
+                                     NumTasksComplete.fetch_add(1);
+                                 });
+            }
+
+            pThreadPool->WaitForAllTasks();
+            EXPECT_EQ(NumTasksComplete.load(), NumTasks) << "Placement: " << Uint32{Placement};
+        }
+    }
+}
+
+
+void TestPrerequisites(THREAD_POOL_SCHEDULING_MODE Mode)
+{
+    constexpr Uint32 NumThreads = 4;
+    constexpr Uint32 NumChains  = 16;
+    constexpr Uint32 ChainLen   = 8;
+
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.SchedulingMode = Mode;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::array<std::array<std::atomic<Uint32>, ChainLen>, NumChains> CompletionIdx{};
+    std::atomic<Uint32>                                              Counter{0};
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> LastTasks;
+    for (Uint32 chain = 0; chain < NumChains; ++chain)
+    {
+        RefCntAutoPtr<IAsyncTask> pPrevTask;
+        for (Uint32 i = 0; i < ChainLen; ++i)
+        {
+            IAsyncTask* pPrerequisite = pPrevTask;
+            pPrevTask =
+                EnqueueAsyncWork(pThreadPool, &pPrerequisite, pPrerequisite != nullptr ? 1 : 0,
+                                 [chain, i, &CompletionIdx, &Counter](Uint32 ThreadId) //
+                                 {
+                                     CompletionIdx[chain][i].store(Counter.fetch_add(1) + 1);
+                                 });
+        }
+        LastTasks.emplace_back(std::move(pPrevTask));
+    }
+
+    // The final task depends on the last task of every chain
+    std::vector<IAsyncTask*> Prerequisites;
+    for (auto& pTask : LastTasks)
+        Prerequisites.push_back(pTask);
+
+    std::atomic<Uint32> FinalIdx{0};
+    auto                pFinalTask =
+        EnqueueAsyncWork(pThreadPool, Prerequisites.data(), static_cast<Uint32>(Prerequisites.size()),
+                         [&FinalIdx, &Counter](Uint32 ThreadId) //
+                         {
+                             FinalIdx.store(Counter.fetch_add(1) + 1);
+                         });
+
+    pThreadPool->WaitForAllTasks();
+
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+    EXPECT_TRUE(pFinalTask->IsFinished());
+    EXPECT_EQ(FinalIdx.load(), NumChains * ChainLen + 1);
+    for (Uint32 chain = 0; chain < NumChains; ++chain)
+    {
+        for (Uint32 i = 1; i < ChainLen; ++i)
+        {
+            EXPECT_GT(CompletionIdx[chain][i], CompletionIdx[chain][i - 1]) << "chain=" << chain << " i=" << i;
+        }
+    }
+}
+
+TEST(Common_ThreadPool, Prerequisites)
+{
+    TestPrerequisites(THREAD_POOL_SCHEDULING_MODE_PRIORITY_QUEUE);
+}
+
+TEST(Common_ThreadPool, Prerequisites_WorkStealing)
+{
+    TestPrerequisites(THREAD_POOL_SCHEDULING_MODE_WORK_STEALING);
+}
+
+
+TEST(Common_ThreadPool, RemovePrerequisite)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{1});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    Threading::Signal       Signal;
+    RefCntAutoPtr<WaitTask> pWaitTask{MakeNewRCObj<WaitTask>()(Signal)};
+    pThreadPool->EnqueueTask(pWaitTask);
+    pWaitTask->WaitUntilRunning();
+
+    RefCntAutoPtr<DummyTask> pPrerequisite{MakeNewRCObj<DummyTask>()()};
+    pThreadPool->EnqueueTask(pPrerequisite);
+
+    IAsyncTask*              pPrerequisites[] = {pPrerequisite};
+    RefCntAutoPtr<DummyTask> pDependent{MakeNewRCObj<DummyTask>()()};
+    pThreadPool->EnqueueTask(pDependent, pPrerequisites, 1);
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 2u);
+
+    // Removing the prerequisite must move the dependent task to the ready queue
+    EXPECT_TRUE(pThreadPool->RemoveTask(pPrerequisite, true));
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 1u);
+
+    // The removed task is cancelled
+    EXPECT_EQ(pPrerequisite->GetStatus(), ASYNC_TASK_STATUS_CANCELLED);
+
+    // A task enqueued after the prerequisite has been removed must not wait for it
+    RefCntAutoPtr<DummyTask> pLateDependent{MakeNewRCObj<DummyTask>()()};
+    pThreadPool->EnqueueTask(pLateDependent, pPrerequisites, 1);
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 2u);
+
+    Signal.Trigger(true, 1);
+    pThreadPool->WaitForAllTasks();
+
+    EXPECT_EQ(pPrerequisite->GetStatus(), ASYNC_TASK_STATUS_CANCELLED);
+    EXPECT_EQ(pDependent->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+    EXPECT_EQ(pLateDependent->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+}
+
+
+TEST(Common_ThreadPool, RemovePendingTask)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{1});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    Threading::Signal       Signal;
+    RefCntAutoPtr<WaitTask> pWaitTask{MakeNewRCObj<WaitTask>()(Signal)};
+    pThreadPool->EnqueueTask(pWaitTask);
+    pWaitTask->WaitUntilRunning();
+
+    // The task is pending because its prerequisite is running
+    IAsyncTask*              pPrerequisites[] = {pWaitTask};
+    RefCntAutoPtr<DummyTask> pPending{MakeNewRCObj<DummyTask>()()};
+    pThreadPool->EnqueueTask(pPending, pPrerequisites, 1);
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 1u);
+
+    EXPECT_TRUE(pThreadPool->RemoveTask(pPending, true));
+    EXPECT_EQ(pPending->GetStatus(), ASYNC_TASK_STATUS_CANCELLED);
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+
+    // Tasks that depend on the removed pending task run as if it has finished
+    IAsyncTask*              pRemovedPrerequisites[] = {pPending};
+    RefCntAutoPtr<DummyTask> pDependent{MakeNewRCObj<DummyTask>()()};
+    pThreadPool->EnqueueTask(pDependent, pRemovedPrerequisites, 1);
+
+    Signal.Trigger(true, 1);
+    pThreadPool->WaitForAllTasks();
+
+    EXPECT_EQ(pPending->GetStatus(), ASYNC_TASK_STATUS_CANCELLED);
+    EXPECT_EQ(pDependent->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+}
+
+
+TEST(Common_ThreadPool, Tracing)
+{
+    {
+        auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{1});
+        ASSERT_NE(pThreadPool, nullptr);
+
+        ThreadPoolTrace Trace;
+        EXPECT_FALSE(pThreadPool->GetTrace(Trace));
+    }
+
+    constexpr Uint32 NumThreads = 4;
+    constexpr Uint32 NumTasks   = 16;
+
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.TraceCapacity = 64;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    RefCntAutoPtr<IAsyncTask> pPrerequisite = EnqueueAsyncWork(
+        pThreadPool, [](Uint32 ThreadId) {}, 1.f);
+    for (Uint32 i = 1; i < NumTasks; ++i)
+    {
+        IAsyncTask* pPrerequisites[] = {pPrerequisite};
+        EnqueueAsyncWork(
+            pThreadPool, pPrerequisites, 1, [](Uint32 ThreadId) {}, static_cast<float>(i));
+    }
+    pThreadPool->WaitForAllTasks();
+
+    ThreadPoolTrace Trace;
+    ASSERT_TRUE(pThreadPool->GetTrace(Trace, /*Clear = */ true));
+    EXPECT_EQ(Trace.NumDroppedEvents, 0u);
+    ASSERT_EQ(Trace.Events.size(), size_t{NumTasks});
+
+    // The first task is the prerequisite of all other tasks
+    const auto& FirstEvent = Trace.Events[0];
+    EXPECT_EQ(FirstEvent.TaskId, 0u);
+    EXPECT_EQ(FirstEvent.Priority, 1.f);
+
+    std::vector<bool> TaskFound(NumTasks);
+    for (const auto& Event : Trace.Events)
+    {
+        ASSERT_LT(Event.TaskId, NumTasks);
+        EXPECT_FALSE(TaskFound[Event.TaskId]) << "TaskId=" << Event.TaskId;
+        TaskFound[Event.TaskId] = true;
+
+        EXPECT_LT(Event.ThreadId, NumThreads);
+        EXPECT_FALSE(Event.Cancelled);
+        EXPECT_LE(Event.EnqueueTime, Event.ReadyTime);
+        EXPECT_LE(Event.ReadyTime, Event.StartTime);
+        EXPECT_LE(Event.StartTime, Event.EndTime);
+        EXPECT_LE(Event.EndTime, Trace.CaptureTime);
+        if (Event.TaskId != 0)
+        {
+            EXPECT_EQ(Event.Priority, static_cast<float>(Event.TaskId));
+            EXPECT_GE(Event.ReadyTime, FirstEvent.EndTime);
+        }
+    }
+
+    const auto JSON = Trace.GetJSON();
+    EXPECT_NE(JSON.find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(JSON.find("\"name\":\"Task 15\""), std::string::npos);
+
+    // All events have been cleared
+    ASSERT_TRUE(pThreadPool->GetTrace(Trace));
+    EXPECT_TRUE(Trace.Events.empty());
+}
+
+
+TEST(Common_ThreadPool, TracingOverflow)
+{
+    ThreadPoolCreateInfo PoolCI{1};
+    PoolCI.TraceCapacity = 4;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    constexpr Uint32 NumTasks = 10;
+    for (Uint32 i = 0; i < NumTasks; ++i)
+        EnqueueAsyncWork(pThreadPool, [](Uint32 ThreadId) {});
+    pThreadPool->WaitForAllTasks();
+
+    ThreadPoolTrace Trace;
+    ASSERT_TRUE(pThreadPool->GetTrace(Trace));
+    ASSERT_EQ(Trace.Events.size(), size_t{PoolCI.TraceCapacity});
+    EXPECT_EQ(Trace.NumDroppedEvents, Uint64{NumTasks - PoolCI.TraceCapacity});
+
+    // The oldest events are overwritten
+    for (size_t i = 0; i < Trace.Events.size(); ++i)
+        EXPECT_EQ(Trace.Events[i].TaskId, NumTasks - PoolCI.TraceCapacity + i);
+}
+
+
+TEST(Common_ThreadPool, GetBoxVisibilityBatchParallel)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    // Boxes are laid out along the X axis so that roughly half of them is visible
+    constexpr size_t   NumBoxes = 10000;
+    std::vector<float> Coords[6];
+    for (auto& Stream : Coords)
+        Stream.resize(NumBoxes);
+    for (size_t i = 0; i < NumBoxes; ++i)
+    {
+        const float x = (static_cast<float>(i % 200) - 100.f) * 0.5f;
+        const float z = 2.f + static_cast<float>(i / 200);
+
+        Coords[0][i] = x - 0.25f;
+        Coords[1][i] = -0.25f;
+        Coords[2][i] = z - 0.25f;
+        Coords[3][i] = x + 0.25f;
+        Coords[4][i] = 0.25f;
+        Coords[5][i] = z + 0.25f;
+    }
+    const BoundBoxSoA Boxes{Coords[0].data(), Coords[1].data(), Coords[2].data(), Coords[3].data(), Coords[4].data(), Coords[5].data()};
+
+    ViewFrustumExt Frustum;
+    ExtractViewFrustumPlanesFromMatrix(float4x4::Projection(PI_F / 2.f, 1.f, 1.f, 100.f, false), Frustum, false);
+
+    std::vector<Uint32> RefMask((NumBoxes + 31) / 32);
+    GetBoxVisibilityBatch(Frustum, Boxes, NumBoxes, RefMask.data());
+
+    for (size_t BoxesPerTask : {1, 100, 1024, 20000})
+    {
+        std::vector<Uint32> Mask(RefMask.size(), 0xFFFFFFFFu);
+        GetBoxVisibilityBatchParallel(pThreadPool.RawPtr(), Frustum, Boxes, NumBoxes, Mask.data(), FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, BoxesPerTask);
+        EXPECT_EQ(Mask, RefMask) << "BoxesPerTask = " << BoxesPerTask;
+    }
+
+    size_t NumVisible = 0;
+    for (auto Bits : RefMask)
+        NumVisible += PlatformMisc::CountOneBits(Bits);
+    EXPECT_GT(NumVisible, size_t{0});
+    EXPECT_LT(NumVisible, NumBoxes);
+}
+
 } // namespace
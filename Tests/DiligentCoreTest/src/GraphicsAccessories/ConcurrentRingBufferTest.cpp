@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ConcurrentRingBuffer.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, AllocDealloc)
+{
+    // Need to define local variable to avoid vexing linker errors
+    const auto InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
+    using OffsetType         = ConcurrentRingBuffer::OffsetType;
+
+    ConcurrentRingBuffer RB{1023, DefaultRawMemoryAllocator::GetAllocator()};
+    EXPECT_TRUE(RB.IsEmpty());
+
+    EXPECT_EQ(RB.Allocate(120, 16), OffsetType{0});
+    EXPECT_EQ(RB.Allocate(10, 1), OffsetType{128});
+    EXPECT_EQ(RB.Allocate(256, 256), OffsetType{256});
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{512});
+    RB.FinishCurrentFrame(1);
+
+    EXPECT_EQ(RB.Allocate(500, 4), OffsetType{512});
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{1012});
+    RB.FinishCurrentFrame(2);
+
+    // The space at the end of the buffer is not large enough, and the beginning is still in use
+    EXPECT_EQ(RB.Allocate(16, 16), InvalidOffset);
+
+    // Zero-size frames are ignored
+    RB.FinishCurrentFrame(3);
+
+    RB.ReleaseCompletedFrames(1);
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{500});
+
+    // The allocation wraps around to the beginning of the buffer
+    EXPECT_EQ(RB.Allocate(16, 16), OffsetType{0});
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{500 + 11 + 16});
+    RB.FinishCurrentFrame(4);
+
+    EXPECT_EQ(RB.Allocate(1024, 1), InvalidOffset);
+
+    RB.ReleaseCompletedFrames(4);
+    EXPECT_TRUE(RB.IsEmpty());
+}
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, MultipleProducers)
+{
+    using OffsetType = ConcurrentRingBuffer::OffsetType;
+
+    constexpr OffsetType BufferSize       = 1 << 16;
+    constexpr OffsetType AllocSize        = 48;
+    constexpr size_t     NumFrames        = 16;
+    constexpr size_t     NumThreadAllocs  = 64;
+    const size_t         NumThreads       = std::max(std::thread::hardware_concurrency(), 4u);
+    const size_t         MaxAllocsInFrame = NumThreads * NumThreadAllocs;
+
+    ConcurrentRingBuffer RB{BufferSize, DefaultRawMemoryAllocator::GetAllocator()};
+
+    std::vector<std::vector<OffsetType>> ThreadOffsets(NumThreads);
+    for (Uint64 Frame = 1; Frame <= NumFrames; ++Frame)
+    {
+        std::vector<std::thread> Workers;
+        Workers.reserve(NumThreads);
+        for (size_t t = 0; t < NumThreads; ++t)
+        {
+            Workers.emplace_back(
+                [&RB, &Offsets = ThreadOffsets[t]] //
+                {
+                    Offsets.clear();
+                    for (size_t i = 0; i < NumThreadAllocs; ++i)
+                    {
+                        const auto Offset = RB.Allocate(AllocSize, 16);
+                        if (Offset != ConcurrentRingBuffer::InvalidOffset)
+                            Offsets.push_back(Offset);
+                    }
+                } //
+            );
+        }
+        for (auto& Worker : Workers)
+            Worker.join();
+
+        // All allocations within the frame must be disjoint
+        std::vector<OffsetType> FrameOffsets;
+        FrameOffsets.reserve(MaxAllocsInFrame);
+        for (const auto& Offsets : ThreadOffsets)
+            FrameOffsets.insert(FrameOffsets.end(), Offsets.begin(), Offsets.end());
+        std::sort(FrameOffsets.begin(), FrameOffsets.end());
+        for (size_t i = 0; i < FrameOffsets.size(); ++i)
+        {
+            EXPECT_EQ(FrameOffsets[i] % 16, OffsetType{0});
+            EXPECT_LE(FrameOffsets[i] + AllocSize, BufferSize);
+            if (i > 0)
+            {
+                EXPECT_GE(FrameOffsets[i], FrameOffsets[i - 1] + AllocSize);
+            }
+        }
+        EXPECT_LE(RB.GetUsedSize(), BufferSize);
+
+        RB.FinishCurrentFrame(Frame);
+        // Emulate the GPU lagging one frame behind
+        RB.ReleaseCompletedFrames(Frame - 1);
+    }
+
+    RB.ReleaseCompletedFrames(NumFrames);
+    EXPECT_TRUE(RB.IsEmpty());
+}
+
+} // namespace
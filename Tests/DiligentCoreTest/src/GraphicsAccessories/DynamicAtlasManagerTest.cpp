@@ -465,4 +465,136 @@ TEST(GraphicsAccessories_DynamicAtlasManager, AllocateRandom)
     }
 }
 
+TEST(GraphicsAccessories_DynamicAtlasManager, ShelfHeight)
+{
+    EXPECT_EQ(ShelfAtlasManager::GetShelfHeight(1), 1u);
+    EXPECT_EQ(ShelfAtlasManager::GetShelfHeight(16), 16u);
+    EXPECT_EQ(ShelfAtlasManager::GetShelfHeight(17), 18u);
+    EXPECT_EQ(ShelfAtlasManager::GetShelfHeight(32), 32u);
+    EXPECT_EQ(ShelfAtlasManager::GetShelfHeight(33), 36u);
+    EXPECT_EQ(ShelfAtlasManager::GetShelfHeight(100), 104u);
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, Shelf_Allocate)
+{
+    {
+        DynamicAtlasManager Mgr{16, 8, DYNAMIC_ATLAS_MANAGER_POLICY_SHELF};
+        EXPECT_EQ(Mgr.GetPolicy(), DYNAMIC_ATLAS_MANAGER_POLICY_SHELF);
+        EXPECT_TRUE(Mgr.IsEmpty());
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+
+        auto R = Mgr.Allocate(16, 8);
+        EXPECT_EQ(R, Region(0, 0, 16, 8));
+        EXPECT_FALSE(Mgr.IsEmpty());
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 0u);
+        EXPECT_TRUE(Mgr.Allocate(1, 1).IsEmpty());
+
+        Mgr.Free(std::move(R));
+        EXPECT_TRUE(Mgr.IsEmpty());
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+        EXPECT_EQ(Mgr.GetTotalFreeArea(), 16u * 8u);
+    }
+
+    {
+        DynamicAtlasManager Mgr{32, 32, DYNAMIC_ATLAS_MANAGER_POLICY_SHELF};
+
+        // Regions of the same height share the shelf
+        auto R0 = Mgr.Allocate(8, 4);
+        auto R1 = Mgr.Allocate(16, 4);
+        EXPECT_EQ(R0, Region(0, 0, 8, 4));
+        EXPECT_EQ(R1, Region(8, 0, 16, 4));
+
+        // A taller region starts a new shelf
+        auto R2 = Mgr.Allocate(8, 8);
+        EXPECT_EQ(R2, Region(0, 4, 8, 8));
+
+        // A region that does not fit the first shelf goes to another one
+        auto R3 = Mgr.Allocate(10, 4);
+        EXPECT_EQ(R3, Region(0, 12, 10, 4));
+
+        auto R4 = Mgr.Allocate(8, 4);
+        EXPECT_EQ(R4, Region(24, 0, 8, 4));
+        EXPECT_EQ(Mgr.GetTotalFreeArea(), 32u * 32u - (8u * 4u + 16u * 4u + 8u * 8u + 10u * 4u + 8u * 4u));
+
+        // Releasing regions in the middle of the shelf merges free spans
+        Mgr.Free(std::move(R1));
+        Mgr.Free(std::move(R0));
+        auto R5 = Mgr.Allocate(24, 3);
+        EXPECT_EQ(R5, Region(0, 16, 24, 3));
+        auto R6 = Mgr.Allocate(24, 4);
+        EXPECT_EQ(R6, Region(0, 0, 24, 4));
+
+        // Empty shelves are merged with the free space
+        Mgr.Free(std::move(R2));
+        Mgr.Free(std::move(R3));
+        Mgr.Free(std::move(R5));
+        auto R7 = Mgr.Allocate(32, 28);
+        EXPECT_EQ(R7, Region(0, 4, 32, 28));
+
+        Mgr.Free(std::move(R4));
+        Mgr.Free(std::move(R6));
+        Mgr.Free(std::move(R7));
+        EXPECT_TRUE(Mgr.IsEmpty());
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+    }
+
+    {
+        DynamicAtlasManager Mgr{16, 16, DYNAMIC_ATLAS_MANAGER_POLICY_SHELF};
+
+        // When there is no space for a new shelf, taller shelves are used
+        auto R0 = Mgr.Allocate(4, 8);
+        auto R1 = Mgr.Allocate(4, 8);
+        EXPECT_EQ(R1, Region(4, 0, 4, 8));
+        auto R2 = Mgr.Allocate(16, 8);
+        EXPECT_EQ(R2, Region(0, 8, 16, 8));
+        auto R3 = Mgr.Allocate(8, 2);
+        EXPECT_EQ(R3, Region(8, 0, 8, 2));
+
+        Mgr.Free(std::move(R0));
+        Mgr.Free(std::move(R1));
+        Mgr.Free(std::move(R2));
+        Mgr.Free(std::move(R3));
+        EXPECT_TRUE(Mgr.IsEmpty());
+    }
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, Shelf_Move)
+{
+    DynamicAtlasManager Mgr0{16, 8, DYNAMIC_ATLAS_MANAGER_POLICY_SHELF};
+
+    auto R = Mgr0.Allocate(16, 8);
+
+    DynamicAtlasManager Mgr1{std::move(Mgr0)};
+    Mgr1.Free(std::move(R));
+    EXPECT_TRUE(Mgr1.IsEmpty());
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, Shelf_AllocateRandom)
+{
+    DynamicAtlasManager Mgr{256, 256, DYNAMIC_ATLAS_MANAGER_POLICY_SHELF};
+    const Uint32        NumIterations = 10;
+    for (Uint32 i = 0; i < NumIterations; ++i)
+    {
+        FastRandInt         rnd{static_cast<unsigned int>(i), 1, 40};
+        std::vector<Region> Regions(i * 64);
+        for (auto& R : Regions)
+        {
+            R = Mgr.Allocate(rnd(), rnd());
+        }
+        // Release every other region first to exercise span merging
+        for (size_t r = 0; r < Regions.size(); r += 2)
+        {
+            if (!Regions[r].IsEmpty())
+                Mgr.Free(std::move(Regions[r]));
+        }
+        for (auto& R : Regions)
+        {
+            if (!R.IsEmpty())
+                Mgr.Free(std::move(R));
+        }
+        EXPECT_TRUE(Mgr.IsEmpty());
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+    }
+}
+
 } // namespace
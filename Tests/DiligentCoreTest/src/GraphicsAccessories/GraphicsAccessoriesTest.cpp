@@ -697,7 +697,7 @@ TEST(GraphicsAccessories_GraphicsAccessories, PipelineTypeFromShaderStages)
 
 TEST(GraphicsAccessories_GraphicsAccessories, GetPipelineResourceFlagsString)
 {
-    static_assert(PIPELINE_RESOURCE_FLAG_LAST == (1u << 4), "Please add a test for the new flag here");
+    static_assert(PIPELINE_RESOURCE_FLAG_LAST == (1u << 6), "Please add a test for the new flag here");
 
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_NONE, true).c_str(), "PIPELINE_RESOURCE_FLAG_NONE");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_NONE).c_str(), "UNKNOWN");
@@ -706,11 +706,15 @@ TEST(GraphicsAccessories_GraphicsAccessories, GetPipelineResourceFlagsString)
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER, true).c_str(), "PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER, true).c_str(), "PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_GENERAL_INPUT_ATTACHMENT, true).c_str(), "PIPELINE_RESOURCE_FLAG_GENERAL_INPUT_ATTACHMENT");
+    EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_BINDLESS, true).c_str(), "PIPELINE_RESOURCE_FLAG_BINDLESS");
+    EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS, true).c_str(), "PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS");
 
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS).c_str(), "NO_DYNAMIC_BUFFERS");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER).c_str(), "COMBINED_SAMPLER");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER).c_str(), "FORMATTED_BUFFER");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_GENERAL_INPUT_ATTACHMENT).c_str(), "GENERAL_INPUT_ATTACHMENT");
+    EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_BINDLESS).c_str(), "BINDLESS");
+    EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS).c_str(), "INLINE_CONSTANTS");
 
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS | PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER, true).c_str(),
                  "PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS|PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER");
@@ -738,6 +742,29 @@ TEST(GraphicsAccessories_GraphicsAccessories, GetPipelineShadingRateFlagsString)
     EXPECT_STREQ(GetPipelineShadingRateFlagsString(PIPELINE_SHADING_RATE_FLAG_PER_PRIMITIVE | PIPELINE_SHADING_RATE_FLAG_TEXTURE_BASED).c_str(), "PER_PRIMITIVE | TEXTURE_BASED");
 }
 
+TEST(GraphicsAccessories_GraphicsAccessories, GetPipelineDynamicStateFlagsString)
+{
+    static_assert(PIPELINE_DYNAMIC_STATE_FLAG_LAST == 0x08, "Please update the switch below to handle the new pipeline dynamic state flag");
+
+    EXPECT_STREQ(GetPipelineDynamicStateFlagsString(PIPELINE_DYNAMIC_STATE_FLAG_NONE).c_str(), "NONE");
+    EXPECT_STREQ(GetPipelineDynamicStateFlagsString(PIPELINE_DYNAMIC_STATE_FLAG_CULL_MODE).c_str(), "CULL_MODE");
+    EXPECT_STREQ(GetPipelineDynamicStateFlagsString(PIPELINE_DYNAMIC_STATE_FLAG_DEPTH).c_str(), "DEPTH");
+    EXPECT_STREQ(GetPipelineDynamicStateFlagsString(PIPELINE_DYNAMIC_STATE_FLAG_STENCIL).c_str(), "STENCIL");
+    EXPECT_STREQ(GetPipelineDynamicStateFlagsString(PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY).c_str(), "PRIMITIVE_TOPOLOGY");
+    EXPECT_STREQ(GetPipelineDynamicStateFlagsString(PIPELINE_DYNAMIC_STATE_FLAG_CULL_MODE | PIPELINE_DYNAMIC_STATE_FLAG_STENCIL).c_str(), "CULL_MODE | STENCIL");
+}
+
+TEST(GraphicsAccessories_GraphicsAccessories, IsSamePrimitiveTopologyClass)
+{
+    EXPECT_TRUE(IsSamePrimitiveTopologyClass(PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP));
+    EXPECT_TRUE(IsSamePrimitiveTopologyClass(PRIMITIVE_TOPOLOGY_LINE_STRIP_ADJ, PRIMITIVE_TOPOLOGY_LINE_LIST));
+    EXPECT_TRUE(IsSamePrimitiveTopologyClass(PRIMITIVE_TOPOLOGY_POINT_LIST, PRIMITIVE_TOPOLOGY_POINT_LIST));
+    EXPECT_TRUE(IsSamePrimitiveTopologyClass(PRIMITIVE_TOPOLOGY_1_CONTROL_POINT_PATCHLIST, PRIMITIVE_TOPOLOGY_32_CONTROL_POINT_PATCHLIST));
+    EXPECT_FALSE(IsSamePrimitiveTopologyClass(PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, PRIMITIVE_TOPOLOGY_LINE_LIST));
+    EXPECT_FALSE(IsSamePrimitiveTopologyClass(PRIMITIVE_TOPOLOGY_POINT_LIST, PRIMITIVE_TOPOLOGY_3_CONTROL_POINT_PATCHLIST));
+    EXPECT_FALSE(IsSamePrimitiveTopologyClass(PRIMITIVE_TOPOLOGY_UNDEFINED, PRIMITIVE_TOPOLOGY_UNDEFINED));
+}
+
 TEST(GraphicsAccessories_GraphicsAccessories, GetMipLevelProperties)
 {
     TextureDesc        Desc;
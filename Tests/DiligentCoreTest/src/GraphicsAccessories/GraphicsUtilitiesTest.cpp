@@ -28,6 +28,8 @@
 #include "GraphicsUtilities.h"
 #include "FastRand.hpp"
 #include "ColorConversion.h"
+#include "GraphicsAccessories.hpp"
+#include "ThreadPool.hpp"
 
 #include <vector>
 #include <array>
@@ -557,22 +559,129 @@ TEST(GraphicsTools_CalculateMipLevel, sRGB_BOX_AVE)
             for (Uint32 c = 0; c < NumChannels; ++c)
             {
                 float fLinearAverage =
-                    (FastSRGBToLinear(FineData[((x * 2 + 0) + (y * 2 + 0) * FineWidth) * NumChannels + c] / 255.f) +
-                     FastSRGBToLinear(FineData[((x * 2 + 1) + (y * 2 + 0) * FineWidth) * NumChannels + c] / 255.f) +
-                     FastSRGBToLinear(FineData[((x * 2 + 0) + (y * 2 + 1) * FineWidth) * NumChannels + c] / 255.f) +
-                     FastSRGBToLinear(FineData[((x * 2 + 1) + (y * 2 + 1) * FineWidth) * NumChannels + c] / 255.f)) *
+                    (SRGBToLinear(FineData[((x * 2 + 0) + (y * 2 + 0) * FineWidth) * NumChannels + c]) +
+                     SRGBToLinear(FineData[((x * 2 + 1) + (y * 2 + 0) * FineWidth) * NumChannels + c]) +
+                     SRGBToLinear(FineData[((x * 2 + 0) + (y * 2 + 1) * FineWidth) * NumChannels + c]) +
+                     SRGBToLinear(FineData[((x * 2 + 1) + (y * 2 + 1) * FineWidth) * NumChannels + c])) *
                     0.25f;
-                fLinearAverage = std::min(std::max(fLinearAverage, 0.f), 255.f);
-                float fSRGB    = FastLinearToSRGB(fLinearAverage);
+                fLinearAverage = std::min(std::max(fLinearAverage, 0.f), 1.f);
+                float fSRGB    = LinearToSRGB(fLinearAverage);
 
-                RefCoarseData[(x + y * CoarseWidth) * NumChannels + c] = static_cast<Uint8>(fSRGB * 255.f);
+                RefCoarseData[(x + y * CoarseWidth) * NumChannels + c] = static_cast<Uint8>(fSRGB * 255.f + 0.5f);
             }
         }
     }
 
     std::vector<Uint8> CoarseData(RefCoarseData.size());
     ComputeMipLevel({TEX_FORMAT_RGBA8_UNORM_SRGB, FineWidth, FineHeight, FineData.data(), FineWidth * NumChannels, CoarseData.data(), CoarseWidth * NumChannels});
+
+    // The reference values are computed with single precision and may be off by one at rounding boundaries
+    Uint32 NumMismatches = 0;
+    for (size_t i = 0; i < CoarseData.size(); ++i)
+    {
+        EXPECT_LE(std::abs(int{CoarseData[i]} - int{RefCoarseData[i]}), 1) << "at index " << i;
+        if (CoarseData[i] != RefCoarseData[i])
+            ++NumMismatches;
+    }
+    EXPECT_LT(NumMismatches, CoarseData.size() / 100);
+}
+
+TEST(GraphicsTools_CalculateMipLevel, RGBA32F_BOX_AVE)
+{
+    const Uint32 FineWidth   = 37;
+    const Uint32 FineHeight  = 15;
+    const Uint32 NumChannels = 4;
+
+    std::vector<float> FineData(FineWidth * FineHeight * NumChannels);
+
+    FastRandFloat rnd(0, -100.f, 100.f);
+    for (auto& c : FineData)
+        c = rnd();
+
+    const Uint32 CoarseWidth  = FineWidth / 2;
+    const Uint32 CoarseHeight = FineHeight / 2;
+
+    std::vector<float> RefCoarseData(CoarseWidth * CoarseHeight * NumChannels);
+    for (Uint32 y = 0; y < CoarseHeight; ++y)
+    {
+        for (Uint32 x = 0; x < CoarseWidth; ++x)
+        {
+            for (Uint32 c = 0; c < NumChannels; ++c)
+            {
+                RefCoarseData[(x + y * CoarseWidth) * NumChannels + c] =
+                    (FineData[((x * 2 + 0) + (y * 2 + 0) * FineWidth) * NumChannels + c] +
+                     FineData[((x * 2 + 1) + (y * 2 + 0) * FineWidth) * NumChannels + c] +
+                     FineData[((x * 2 + 0) + (y * 2 + 1) * FineWidth) * NumChannels + c] +
+                     FineData[((x * 2 + 1) + (y * 2 + 1) * FineWidth) * NumChannels + c]) *
+                    0.25f;
+            }
+        }
+    }
+
+    std::vector<float> CoarseData(RefCoarseData.size());
+    ComputeMipLevel({TEX_FORMAT_RGBA32_FLOAT, FineWidth, FineHeight, FineData.data(), FineWidth * NumChannels * sizeof(float), CoarseData.data(), CoarseWidth * NumChannels * sizeof(float)});
     EXPECT_TRUE(CoarseData == RefCoarseData);
 }
 
+TEST(GraphicsTools_ComputeMipChain, TextureArray)
+{
+    constexpr Uint32 Width     = 67;
+    constexpr Uint32 Height    = 45;
+    constexpr Uint32 ArraySize = 3;
+
+    constexpr Uint32 NumComponents = 4;
+
+    for (auto Fmt : {TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_RGBA8_UINT})
+    {
+        const Uint32 MipLevels = ComputeMipLevelsCount(Width, Height);
+
+        std::vector<std::vector<Uint8>> RefData(ArraySize * MipLevels);
+        std::vector<std::vector<Uint8>> Data(ArraySize * MipLevels);
+        std::vector<void*>              pSubresData(ArraySize * MipLevels);
+        std::vector<size_t>             Strides(ArraySize * MipLevels);
+
+        FastRandInt rnd(0, 0, 255);
+        for (Uint32 Slice = 0; Slice < ArraySize; ++Slice)
+        {
+            for (Uint32 Mip = 0; Mip < MipLevels; ++Mip)
+            {
+                const Uint32 Subres   = Slice * MipLevels + Mip;
+                const Uint32 MipWidth = std::max(Width >> Mip, 1u);
+                Strides[Subres]       = MipWidth * NumComponents;
+                RefData[Subres].resize(Strides[Subres] * std::max(Height >> Mip, 1u));
+                Data[Subres].resize(RefData[Subres].size());
+                pSubresData[Subres] = Data[Subres].data();
+            }
+
+            for (auto& c : RefData[Slice * MipLevels])
+                c = static_cast<Uint8>(rnd());
+            Data[Slice * MipLevels] = RefData[Slice * MipLevels];
+
+            for (Uint32 Mip = 1; Mip < MipLevels; ++Mip)
+            {
+                const Uint32 Subres = Slice * MipLevels + Mip;
+                ComputeMipLevel({Fmt, std::max(Width >> (Mip - 1), 1u), std::max(Height >> (Mip - 1), 1u),
+                                 RefData[Subres - 1].data(), Strides[Subres - 1], RefData[Subres].data(), Strides[Subres]});
+            }
+        }
+
+        RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+        ASSERT_TRUE(pThreadPool);
+
+        ComputeMipChainAttribs Attribs;
+        Attribs.Format         = Fmt;
+        Attribs.Width          = Width;
+        Attribs.Height         = Height;
+        Attribs.ArraySize      = ArraySize;
+        Attribs.ppSubresData   = pSubresData.data();
+        Attribs.pSubresStrides = Strides.data();
+        Attribs.pThreadPool    = pThreadPool.RawPtr();
+        Attribs.RowsPerTask    = 4;
+        ComputeMipChain(Attribs);
+
+        for (size_t Subres = 0; Subres < Data.size(); ++Subres)
+            EXPECT_TRUE(Data[Subres] == RefData[Subres]) << "Subresource " << Subres;
+    }
+}
+
 } // namespace
@@ -0,0 +1,187 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "LinearProbingTable.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+using IndexTable = LinearProbingTable<Uint32, LinearProbingIndexSlotTraits>;
+
+// The keys are stored outside of the table, which only keeps the indices
+class IndexTableTester
+{
+public:
+    explicit IndexTableTester(Uint64 HashDivisor) :
+        m_HashDivisor{HashDivisor}
+    {}
+
+    void Insert(Uint64 Key)
+    {
+        const auto Idx = static_cast<Uint32>(m_Keys.size());
+        m_Keys.push_back(Key);
+        m_Table.Insert(GetKeyHash(Key), Idx, GetSlotHash());
+    }
+
+    size_t Find(Uint64 Key) const
+    {
+        return m_Table.Find(GetKeyHash(Key), [&](Uint32 Idx) { return m_Keys[Idx] == Key; });
+    }
+
+    bool Remove(Uint64 Key)
+    {
+        const auto Pos = Find(Key);
+        if (Pos == IndexTable::InvalidPos)
+            return false;
+        m_Table.Remove(Pos, GetSlotHash());
+        return true;
+    }
+
+    const IndexTable& GetTable() const { return m_Table; }
+
+private:
+    // A large divisor makes many keys share the same hash and stresses the probing
+    Uint64 GetKeyHash(Uint64 Key) const { return Key / m_HashDivisor; }
+
+    struct SlotHasher
+    {
+        const IndexTableTester& Tester;
+        Uint64                  operator()(Uint32 Idx) const { return Tester.GetKeyHash(Tester.m_Keys[Idx]); }
+    };
+    SlotHasher GetSlotHash() const { return SlotHasher{*this}; }
+
+    const Uint64        m_HashDivisor;
+    std::vector<Uint64> m_Keys;
+    IndexTable          m_Table;
+};
+
+void TestInsertRemove(Uint64 HashDivisor)
+{
+    constexpr Uint64 NumKeys = 1000;
+
+    IndexTableTester Tester{HashDivisor};
+    EXPECT_EQ(Tester.Find(0), IndexTable::InvalidPos);
+    EXPECT_FALSE(Tester.Remove(0));
+
+    std::vector<Uint64> Keys;
+    for (Uint64 i = 0; i < NumKeys; ++i)
+    {
+        Keys.push_back(i * 3);
+        Tester.Insert(i * 3);
+    }
+    EXPECT_EQ(Tester.GetTable().GetSize(), size_t{NumKeys});
+    // The load factor never exceeds 1/2
+    EXPECT_GE(Tester.GetTable().GetCapacity(), size_t{NumKeys * 2});
+
+    for (auto Key : Keys)
+        EXPECT_NE(Tester.Find(Key), IndexTable::InvalidPos) << Key;
+    EXPECT_EQ(Tester.Find(1), IndexTable::InvalidPos);
+
+    // Remove the keys in random order and check that the remaining ones are still found
+    std::mt19937 gen{0};
+    std::shuffle(Keys.begin(), Keys.end(), gen);
+    const auto NumRemoved = Keys.size() / 2;
+    for (size_t i = 0; i < NumRemoved; ++i)
+    {
+        EXPECT_TRUE(Tester.Remove(Keys[i]));
+        EXPECT_FALSE(Tester.Remove(Keys[i]));
+    }
+    EXPECT_EQ(Tester.GetTable().GetSize(), Keys.size() - NumRemoved);
+
+    for (size_t i = 0; i < Keys.size(); ++i)
+    {
+        if (i < NumRemoved)
+            EXPECT_EQ(Tester.Find(Keys[i]), IndexTable::InvalidPos) << Keys[i];
+        else
+            EXPECT_NE(Tester.Find(Keys[i]), IndexTable::InvalidPos) << Keys[i];
+    }
+
+    for (size_t i = NumRemoved; i < Keys.size(); ++i)
+        EXPECT_TRUE(Tester.Remove(Keys[i]));
+    EXPECT_EQ(Tester.GetTable().GetSize(), size_t{0});
+}
+
+TEST(GraphicsAccessories_LinearProbingTable, InsertRemove)
+{
+    TestInsertRemove(1);
+}
+
+TEST(GraphicsAccessories_LinearProbingTable, InsertRemoveCollisions)
+{
+    TestInsertRemove(16);
+}
+
+TEST(GraphicsAccessories_LinearProbingTable, GrowWithFilter)
+{
+    struct Slot
+    {
+        Uint64 Key   = 0;
+        bool   Valid = false;
+    };
+    struct SlotTraits
+    {
+        static Slot EmptySlot() { return Slot{}; }
+        static bool IsEmpty(const Slot& S) { return !S.Valid; }
+    };
+    const auto GetSlotHash = [](const Slot& S) {
+        return S.Key;
+    };
+
+    LinearProbingTable<Slot, SlotTraits> Table;
+    for (Uint64 Key = 0; Key < 8; ++Key)
+        Table.Insert(Key, Slot{Key, true}, GetSlotHash);
+    EXPECT_EQ(Table.GetSize(), size_t{8});
+
+    // Drop odd keys while growing
+    const auto Capacity = Table.GetCapacity();
+    Table.Grow(GetSlotHash, [](const Slot& S) { return S.Key % 2 == 0; });
+    EXPECT_EQ(Table.GetCapacity(), Capacity * 2);
+    EXPECT_EQ(Table.GetSize(), size_t{4});
+    for (Uint64 Key = 0; Key < 8; ++Key)
+    {
+        const auto Pos = Table.Find(Key, [Key](const Slot& S) { return S.Key == Key; });
+        if (Key % 2 == 0)
+        {
+            ASSERT_NE(Pos, (LinearProbingTable<Slot, SlotTraits>::InvalidPos));
+            EXPECT_EQ(Table[Pos].Key, Key);
+        }
+        else
+        {
+            EXPECT_EQ(Pos, (LinearProbingTable<Slot, SlotTraits>::InvalidPos));
+        }
+    }
+}
+
+} // namespace
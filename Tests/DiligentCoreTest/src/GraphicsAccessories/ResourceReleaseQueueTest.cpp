@@ -26,6 +26,9 @@
  */
 
 #include <memory>
+#include <thread>
+#include <vector>
+#include <atomic>
 
 #include "ResourceReleaseQueue.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
@@ -128,4 +131,148 @@ TEST(GraphicsAccessories_ResourceReleaseQueue, GetFilterTypeLiteralName)
     }
 }
 
+struct CountedResource
+{
+    explicit CountedResource(std::atomic<int>* _pCounter = nullptr) :
+        pCounter{_pCounter}
+    {}
+
+    CountedResource(CountedResource&& rhs) noexcept :
+        pCounter{rhs.pCounter}
+    {
+        rhs.pCounter = nullptr;
+    }
+
+    CountedResource& operator=(CountedResource&& rhs) noexcept
+    {
+        pCounter     = rhs.pCounter;
+        rhs.pCounter = nullptr;
+        return *this;
+    }
+
+    ~CountedResource()
+    {
+        if (pCounter != nullptr)
+            pCounter->fetch_add(1);
+    }
+
+    std::atomic<int>* pCounter;
+};
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, SafeReleaseResources)
+{
+    std::atomic<int> NumDestroyed{0};
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+    Queue.SafeReleaseResource(CountedResource{&NumDestroyed}, 0);
+
+    int NumResources = 0;
+    Queue.SafeReleaseResources<CountedResource>(1, [&](CountedResource& Res) {
+        if (NumResources == 3)
+            return false;
+        Res = CountedResource{&NumDestroyed};
+        ++NumResources;
+        return true;
+    });
+    EXPECT_EQ(Queue.GetStaleResourceCount(), 4u);
+
+    Queue.DiscardStaleResources(0, 1);
+    EXPECT_EQ(Queue.GetStaleResourceCount(), 3u);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 1u);
+
+    Queue.DiscardStaleResources(1, 2);
+    EXPECT_EQ(Queue.GetStaleResourceCount(), 0u);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 4u);
+
+    EXPECT_TRUE(Queue.Purge(1));
+    EXPECT_EQ(NumDestroyed, 1);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 3u);
+
+    EXPECT_TRUE(Queue.Purge(2));
+    EXPECT_EQ(NumDestroyed, 4);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 0u);
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, PurgeTimeBudget)
+{
+    struct SlowResource
+    {
+        explicit SlowResource(std::atomic<int>* _pCounter = nullptr) :
+            Counter{_pCounter}
+        {}
+
+        SlowResource(SlowResource&&) = default;
+
+        ~SlowResource()
+        {
+            if (Counter.pCounter != nullptr)
+                std::this_thread::sleep_for(std::chrono::microseconds{100});
+        }
+
+        CountedResource Counter;
+    };
+
+    constexpr int NumResources = 256;
+
+    std::atomic<int> NumDestroyed{0};
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+    for (int i = 0; i < NumResources; ++i)
+        Queue.DiscardResource(SlowResource{&NumDestroyed}, 1);
+
+    // Objects whose fence value is not completed are never destroyed
+    EXPECT_TRUE(Queue.Purge(0, 1));
+    EXPECT_EQ(NumDestroyed, 0);
+
+    // At least one batch is destroyed in every call
+    EXPECT_FALSE(Queue.Purge(1, 1));
+    EXPECT_GT(NumDestroyed, 0);
+    EXPECT_LT(NumDestroyed, NumResources);
+
+    while (!Queue.Purge(1, 1))
+    {
+    }
+    EXPECT_EQ(NumDestroyed, NumResources);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 0u);
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, ConcurrentRelease)
+{
+    constexpr int NumThreads            = 4;
+    constexpr int NumResourcesPerThread = 1000;
+
+    std::atomic<int> NumDestroyed{0};
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+    std::vector<std::thread> Threads;
+    for (int t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&]() {
+            for (int i = 0; i < NumResourcesPerThread; ++i)
+                Queue.SafeReleaseResource(CountedResource{&NumDestroyed}, 0);
+        });
+    }
+
+    // Discard and purge the resources while they are being released
+    Uint64 FenceValue = 1;
+    while (NumDestroyed < NumThreads * NumResourcesPerThread)
+    {
+        Queue.DiscardStaleResources(0, FenceValue);
+        Queue.Purge(FenceValue);
+        ++FenceValue;
+
+        if (Queue.GetStaleResourceCount() == 0 && Queue.GetPendingReleaseResourceCount() == 0)
+            std::this_thread::yield();
+    }
+
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(NumDestroyed, NumThreads * NumResourcesPerThread);
+    EXPECT_EQ(Queue.GetStaleResourceCount(), 0u);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 0u);
+}
+
 } // namespace
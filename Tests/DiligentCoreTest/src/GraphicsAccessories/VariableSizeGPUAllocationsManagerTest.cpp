@@ -28,6 +28,10 @@
 #include "VariableSizeGPUAllocationsManager.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
 #include "PlatformDefinitions.h"
+#include "Align.hpp"
+
+#include <algorithm>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -249,4 +253,265 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Free)
     }
 }
 
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, TLSF_AllocateFree)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+
+    VariableSizeAllocationsManager ListMgr(128, Allocator, VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF);
+    EXPECT_EQ(ListMgr.GetPolicy(), VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF);
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(ListMgr.GetFreeSize(), size_t{128});
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{128});
+
+    auto a1 = ListMgr.Allocate(17, 4);
+    EXPECT_EQ(a1.UnalignedOffset, OffsetType{0});
+    EXPECT_EQ(a1.Size, OffsetType{20});
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(ListMgr.GetUsedSize(), size_t{20});
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{128 - 20});
+
+    // The allocation is padded to be 16-aligned
+    auto a2 = ListMgr.Allocate(16, 16);
+    EXPECT_EQ(a2.UnalignedOffset, OffsetType{20});
+    EXPECT_EQ(a2.Size, OffsetType{12 + 16});
+    EXPECT_EQ(AlignUp(a2.UnalignedOffset, OffsetType{16}), OffsetType{32});
+
+    auto a3 = ListMgr.Allocate(80, 1);
+    EXPECT_EQ(a3.UnalignedOffset, OffsetType{48});
+    EXPECT_TRUE(ListMgr.IsFull());
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{0});
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{0});
+    EXPECT_FALSE(ListMgr.Allocate(1, 1).IsValid());
+
+    ListMgr.Free(std::move(a2));
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{28});
+
+    // The block is large enough, but cannot fit the aligned allocation
+    EXPECT_FALSE(ListMgr.Allocate(16, 32).IsValid());
+
+    // Exact fit
+    a2 = ListMgr.Allocate(28, 1);
+    EXPECT_EQ(a2.UnalignedOffset, OffsetType{20});
+    EXPECT_TRUE(ListMgr.IsFull());
+
+    ListMgr.Free(std::move(a1));
+    ListMgr.Free(std::move(a3));
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{2});
+    ListMgr.Free(std::move(a2));
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_TRUE(ListMgr.IsEmpty());
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{128});
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, TLSF_FreeOrder)
+{
+    auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+
+    const auto NumAllocs = 6;
+    size_t     ReleaseOrder[NumAllocs];
+    for (size_t a = 0; a < NumAllocs; ++a)
+        ReleaseOrder[a] = a;
+    do
+    {
+        VariableSizeAllocationsManager ListMgr(NumAllocs * 4, Allocator, VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF);
+
+        VariableSizeAllocationsManager::Allocation allocs[NumAllocs];
+        for (size_t a = 0; a < NumAllocs; ++a)
+        {
+            allocs[a] = ListMgr.Allocate(4, 1);
+            EXPECT_EQ(allocs[a].UnalignedOffset, a * 4);
+            EXPECT_EQ(allocs[a].Size, OffsetType{4});
+        }
+        for (size_t a = 0; a < NumAllocs; ++a)
+        {
+            ListMgr.Free(std::move(allocs[ReleaseOrder[a]]));
+        }
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+        EXPECT_TRUE(ListMgr.IsEmpty());
+    } while (std::next_permutation(std::begin(ReleaseOrder), std::end(ReleaseOrder)));
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, TLSF_Extend)
+{
+    auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+
+    VariableSizeAllocationsManager ListMgr(64, Allocator, VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF);
+
+    auto a1 = ListMgr.Allocate(32, 1);
+    EXPECT_FALSE(ListMgr.Allocate(64, 1).IsValid());
+
+    // The last block is free and is extended
+    ListMgr.Extend(64);
+    EXPECT_EQ(ListMgr.GetMaxSize(), size_t{128});
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{96});
+
+    auto a2 = ListMgr.Allocate(96, 1);
+    EXPECT_EQ(a2.UnalignedOffset, OffsetType{32});
+    EXPECT_TRUE(ListMgr.IsFull());
+
+    // The last block is allocated, so a new one is added
+    ListMgr.Extend(16);
+    auto a3 = ListMgr.Allocate(16, 1);
+    EXPECT_EQ(a3.UnalignedOffset, OffsetType{128});
+
+    ListMgr.Free(std::move(a2));
+    ListMgr.Free(std::move(a3));
+    ListMgr.Free(std::move(a1));
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{144});
+
+    VariableSizeAllocationsManager EmptyMgr(0, Allocator, VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF);
+    EXPECT_FALSE(EmptyMgr.Allocate(1, 1).IsValid());
+    EmptyMgr.Extend(256);
+    auto a4 = EmptyMgr.Allocate(256, 256);
+    EXPECT_EQ(a4.UnalignedOffset, OffsetType{0});
+    EmptyMgr.Free(std::move(a4));
+}
+
+void TestShrink(VARIABLE_SIZE_ALLOCATIONS_POLICY Policy)
+{
+    auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+
+    VariableSizeAllocationsManager ListMgr(128, Allocator, Policy);
+    EXPECT_EQ(ListMgr.GetTrailingFreeSize(), size_t{128});
+
+    auto a1 = ListMgr.Allocate(32, 1);
+    auto a2 = ListMgr.Allocate(32, 1);
+    EXPECT_EQ(a2.UnalignedOffset, OffsetType{32});
+    EXPECT_EQ(ListMgr.GetTrailingFreeSize(), size_t{64});
+
+    // Shrink part of the trailing block
+    ListMgr.Shrink(32);
+    EXPECT_EQ(ListMgr.GetMaxSize(), size_t{96});
+    EXPECT_EQ(ListMgr.GetFreeSize(), size_t{32});
+    EXPECT_EQ(ListMgr.GetTrailingFreeSize(), size_t{32});
+
+    // Shrink the whole trailing block
+    ListMgr.Shrink(32);
+    EXPECT_EQ(ListMgr.GetMaxSize(), size_t{64});
+    EXPECT_TRUE(ListMgr.IsFull());
+    EXPECT_EQ(ListMgr.GetTrailingFreeSize(), size_t{0});
+    EXPECT_FALSE(ListMgr.Allocate(16, 1).IsValid());
+
+    // Freeing a block in the middle does not create trailing free space
+    ListMgr.Free(std::move(a1));
+    EXPECT_EQ(ListMgr.GetTrailingFreeSize(), size_t{0});
+
+    ListMgr.Free(std::move(a2));
+    EXPECT_TRUE(ListMgr.IsEmpty());
+    EXPECT_EQ(ListMgr.GetTrailingFreeSize(), size_t{64});
+
+    ListMgr.Shrink(64);
+    EXPECT_EQ(ListMgr.GetMaxSize(), size_t{0});
+    EXPECT_TRUE(ListMgr.IsEmpty());
+
+    // The manager can be extended again after it has been shrunk
+    ListMgr.Extend(64);
+    auto a3 = ListMgr.Allocate(64, 1);
+    EXPECT_EQ(a3.UnalignedOffset, OffsetType{0});
+    ListMgr.Free(std::move(a3));
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Shrink)
+{
+    TestShrink(VARIABLE_SIZE_ALLOCATIONS_POLICY_ORDERED_MAPS);
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, TLSF_Shrink)
+{
+    TestShrink(VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF);
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, TLSF_RandomAllocations)
+{
+    auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+
+    constexpr OffsetType MaxSize = 1 << 20;
+
+    VariableSizeAllocationsManager ListMgr(MaxSize, Allocator, VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF);
+
+    std::vector<VariableSizeAllocationsManager::Allocation> Allocs;
+    std::vector<OffsetType>                                 Alignments;
+
+    Uint32 Seed = 19;
+    auto   Rand = [&Seed]() {
+        Seed = Seed * 1103515245u + 12345u;
+        return (Seed >> 8) & 0xFFFF;
+    };
+
+    for (Uint32 i = 0; i < 20000; ++i)
+    {
+        if (Allocs.empty() || Rand() % 3 != 0)
+        {
+            const OffsetType Alignment = OffsetType{1} << (Rand() % 9);
+            const OffsetType Size      = AlignUp(OffsetType{1} + Rand() % 4096, Alignment);
+
+            auto Alloc = ListMgr.Allocate(Size, Alignment);
+            if (!Alloc.IsValid())
+                continue;
+
+            const auto AlignedOffset = AlignUp(Alloc.UnalignedOffset, Alignment);
+            EXPECT_GE(Alloc.UnalignedOffset + Alloc.Size, AlignedOffset + Size);
+            EXPECT_LE(Alloc.UnalignedOffset + Alloc.Size, MaxSize);
+            Allocs.emplace_back(Alloc);
+        }
+        else
+        {
+            auto Idx = Rand() % Allocs.size();
+            std::swap(Allocs[Idx], Allocs.back());
+            ListMgr.Free(std::move(Allocs.back()));
+            Allocs.pop_back();
+        }
+    }
+
+    // Allocations must not overlap
+    std::sort(Allocs.begin(), Allocs.end(), [](const auto& lhs, const auto& rhs) { return lhs.UnalignedOffset < rhs.UnalignedOffset; });
+    OffsetType UsedSize = 0;
+    for (size_t i = 0; i < Allocs.size(); ++i)
+    {
+        if (i > 0)
+        {
+            EXPECT_LE(Allocs[i - 1].UnalignedOffset + Allocs[i - 1].Size, Allocs[i].UnalignedOffset);
+        }
+        UsedSize += Allocs[i].Size;
+    }
+    EXPECT_EQ(ListMgr.GetUsedSize(), UsedSize);
+
+    for (auto& Alloc : Allocs)
+        ListMgr.Free(std::move(Alloc));
+    EXPECT_TRUE(ListMgr.IsEmpty());
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, TLSF_Free)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    VariableSizeGPUAllocationsManager ListMgr(128, Allocator, VARIABLE_SIZE_ALLOCATIONS_POLICY_TLSF);
+
+    VariableSizeGPUAllocationsManager::Allocation al[16];
+    for (size_t o = 0; o < _countof(al); ++o)
+        al[o] = ListMgr.Allocate(8, 4);
+    EXPECT_TRUE(ListMgr.IsFull());
+
+    for (size_t o = 0; o < _countof(al); o += 2)
+        ListMgr.Free(std::move(al[o]), 1);
+    for (size_t o = 1; o < _countof(al); o += 2)
+        ListMgr.Free(std::move(al[o]), 2);
+
+    ListMgr.ReleaseStaleAllocations(1);
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{8});
+    ListMgr.ReleaseStaleAllocations(2);
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_TRUE(ListMgr.IsEmpty());
+}
+
 } // namespace
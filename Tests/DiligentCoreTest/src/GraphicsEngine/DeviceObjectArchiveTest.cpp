@@ -0,0 +1,341 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "../../../../Graphics/GraphicsEngine/include/DeviceObjectArchive.hpp"
+#include "../../../../Graphics/GraphicsEngine/include/EngineMemory.h"
+
+#include <vector>
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+#include "DataBlobImpl.hpp"
+#include "MemoryMappedFileDataBlob.hpp"
+#include "TempDirectory.hpp"
+#include "TestingEnvironment.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+using DeviceType   = DeviceObjectArchive::DeviceType;
+using ResourceType = DeviceObjectArchive::ResourceType;
+
+SerializedData MakeTestData(size_t Size, Uint8 Seed)
+{
+    SerializedData Data{Size, GetRawAllocator()};
+    for (size_t i = 0; i < Size; ++i)
+        Data.Ptr<Uint8>()[i] = static_cast<Uint8>(Seed + i * 7);
+    return Data;
+}
+
+void InitTestArchive(DeviceObjectArchive& Archive)
+{
+    {
+        auto& ResData = Archive.GetResourceData(ResourceType::ResourceSignature, "Signature");
+
+        ResData.Common                                                      = MakeTestData(17, 1);
+        ResData.DeviceSpecific[static_cast<size_t>(DeviceType::Vulkan)]     = MakeTestData(33, 2);
+        ResData.DeviceSpecific[static_cast<size_t>(DeviceType::Direct3D12)] = MakeTestData(5, 3);
+    }
+    {
+        auto& ResData = Archive.GetResourceData(ResourceType::GraphicsPipeline, "PSO");
+
+        ResData.Common                                                  = MakeTestData(64, 4);
+        ResData.DeviceSpecific[static_cast<size_t>(DeviceType::OpenGL)] = MakeTestData(8, 5);
+        ResData.DeviceSpecific[static_cast<size_t>(DeviceType::Vulkan)] = MakeTestData(12, 6);
+    }
+    {
+        auto& ResData = Archive.GetResourceData(ResourceType::RenderPass, "Render Pass");
+
+        ResData.Common = MakeTestData(3, 7);
+    }
+
+    auto& VkShaders = Archive.GetDeviceShaders(DeviceType::Vulkan);
+    VkShaders.emplace_back(MakeTestData(1023, 8));
+    VkShaders.emplace_back(MakeTestData(255, 9));
+
+    auto& GLShaders = Archive.GetDeviceShaders(DeviceType::OpenGL);
+    GLShaders.emplace_back(MakeTestData(131, 10));
+}
+
+void CompareArchives(const DeviceObjectArchive& Ref, const DeviceObjectArchive& Archive)
+{
+    const auto& RefResources = Ref.GetNamedResources();
+    const auto& Resources    = Archive.GetNamedResources();
+    ASSERT_EQ(RefResources.size(), Resources.size());
+
+    for (const auto& ref_it : RefResources)
+    {
+        auto it = Resources.find(ref_it.first);
+        ASSERT_NE(it, Resources.end()) << ref_it.first.GetName();
+
+        EXPECT_EQ(ref_it.second.Common, it->second.Common) << ref_it.first.GetName();
+        for (size_t dev = 0; dev < static_cast<size_t>(DeviceType::Count); ++dev)
+        {
+            const auto& RefData = ref_it.second.DeviceSpecific[dev];
+            const auto& Data    = it->second.DeviceSpecific[dev];
+            EXPECT_EQ(RefData, Data) << ref_it.first.GetName();
+            EXPECT_EQ(static_cast<bool>(RefData), static_cast<bool>(Data)) << ref_it.first.GetName();
+        }
+    }
+
+    for (size_t dev = 0; dev < static_cast<size_t>(DeviceType::Count); ++dev)
+    {
+        const auto DevType = static_cast<DeviceType>(dev);
+        for (size_t i = 0; i < 4; ++i)
+        {
+            EXPECT_EQ(Ref.GetSerializedShader(DevType, i), Archive.GetSerializedShader(DevType, i));
+        }
+    }
+}
+
+TEST(DeviceObjectArchiveTest, SerializeDeserialize)
+{
+    DeviceObjectArchive RefArchive;
+    InitTestArchive(RefArchive);
+
+    RefCntAutoPtr<IDataBlob> pData;
+    RefArchive.Serialize(&pData);
+    ASSERT_TRUE(pData);
+
+    DeviceObjectArchive Archive{pData};
+    CompareArchives(RefArchive, Archive);
+
+    // Data blocks must be referenced in place
+    const auto* pArchiveStart = static_cast<const Uint8*>(pData->GetConstDataPtr());
+    const auto* pArchiveEnd   = pArchiveStart + pData->GetSize();
+    for (const auto& it : Archive.GetNamedResources())
+    {
+        const auto* pCommonData = it.second.Common.Ptr<const Uint8>();
+        EXPECT_GE(pCommonData, pArchiveStart);
+        EXPECT_LT(pCommonData, pArchiveEnd);
+        EXPECT_EQ(reinterpret_cast<size_t>(pCommonData) % 8, size_t{0});
+    }
+
+    // Round trip through the deserialized archive
+    RefCntAutoPtr<IDataBlob> pData2;
+    Archive.Serialize(&pData2);
+    ASSERT_TRUE(pData2);
+
+    DeviceObjectArchive Archive2{pData2};
+    CompareArchives(RefArchive, Archive2);
+}
+
+TEST(DeviceObjectArchiveTest, MemoryMappedFile)
+{
+    DeviceObjectArchive RefArchive;
+    InitTestArchive(RefArchive);
+
+    RefCntAutoPtr<IDataBlob> pData;
+    RefArchive.Serialize(&pData);
+    ASSERT_TRUE(pData);
+
+    TempDirectory TmpDir;
+    const auto    FilePath = TmpDir.Get() + FileSystem::SlashSymbol + "Archive.bin";
+    {
+        FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        EXPECT_TRUE(File->Write(pData->GetConstDataPtr(), pData->GetSize()));
+    }
+
+    {
+        auto pMappedData = MemoryMappedFileDataBlob::Create(FilePath.c_str());
+        ASSERT_TRUE(pMappedData);
+
+        DeviceObjectArchive Archive{pMappedData};
+        CompareArchives(RefArchive, Archive);
+    }
+
+    FileSystem::DeleteFile(FilePath.c_str());
+}
+
+TEST(DeviceObjectArchiveTest, TruncatedData)
+{
+    DeviceObjectArchive RefArchive;
+    InitTestArchive(RefArchive);
+
+    RefCntAutoPtr<IDataBlob> pData;
+    RefArchive.Serialize(&pData);
+    ASSERT_TRUE(pData);
+
+    auto pTruncatedData = DataBlobImpl::Create(pData->GetSize() - 1, pData->GetConstDataPtr());
+
+    TestingEnvironment::ErrorScope ExpectedErrors{"is out of the archive bounds"};
+    EXPECT_THROW(DeviceObjectArchive{pTruncatedData}, std::runtime_error);
+}
+
+TEST(DeviceObjectArchiveTest, DuplicateDataBlocks)
+{
+    DeviceObjectArchive RefArchive;
+    InitTestArchive(RefArchive);
+
+    RefCntAutoPtr<IDataBlob> pRefData;
+    RefArchive.Serialize(&pRefData);
+    ASSERT_TRUE(pRefData);
+
+    // Add the copies of existing blocks
+    DeviceObjectArchive Archive;
+    InitTestArchive(Archive);
+    Archive.GetDeviceShaders(DeviceType::Direct3D12).emplace_back(MakeTestData(1023, 8));
+    Archive.GetResourceData(ResourceType::ComputePipeline, "PSO").Common = MakeTestData(64, 4);
+
+    RefCntAutoPtr<IDataBlob> pData;
+    Archive.Serialize(&pData);
+    ASSERT_TRUE(pData);
+
+    // Duplicate blocks must not be written to the archive
+    EXPECT_LT(pData->GetSize(), pRefData->GetSize() + 64 + 1023);
+
+    DeviceObjectArchive Archive2{pData};
+    CompareArchives(Archive, Archive2);
+
+    const auto& VkShader    = Archive2.GetSerializedShader(DeviceType::Vulkan, 0);
+    const auto& D3D12Shader = Archive2.GetSerializedShader(DeviceType::Direct3D12, 0);
+    EXPECT_EQ(VkShader.Ptr(), D3D12Shader.Ptr());
+}
+
+TEST(DeviceObjectArchiveTest, MergeSharedShaders)
+{
+    DeviceObjectArchive Archive;
+    InitTestArchive(Archive);
+
+    DeviceObjectArchive Src;
+    {
+        auto& VkShaders = Src.GetDeviceShaders(DeviceType::Vulkan);
+        VkShaders.emplace_back(MakeTestData(77, 11));
+        // Same as the second Vulkan shader in the test archive
+        VkShaders.emplace_back(MakeTestData(255, 9));
+
+        constexpr Uint32                    ShaderIndex = 1;
+        Serializer<SerializerMode::Measure> MeasureSer;
+        MeasureSer(ShaderIndex);
+
+        auto& DevData = Src.GetResourceData(ResourceType::StandaloneShader, "Shader").DeviceSpecific[static_cast<size_t>(DeviceType::Vulkan)];
+        DevData       = MeasureSer.AllocateData(GetRawAllocator());
+        Serializer<SerializerMode::Write> Ser{DevData};
+        Ser(ShaderIndex);
+    }
+
+    Archive.Merge(Src);
+
+    // Only the new shader must be added
+    EXPECT_EQ(Archive.GetDeviceShaders(DeviceType::Vulkan).size(), size_t{3});
+    EXPECT_EQ(Archive.GetSerializedShader(DeviceType::Vulkan, 2), MakeTestData(77, 11));
+
+    const auto& DevData = Archive.GetDeviceSpecificData(ResourceType::StandaloneShader, "Shader", DeviceType::Vulkan);
+
+    Uint32                           ShaderIndex = 0;
+    Serializer<SerializerMode::Read> Ser{DevData};
+    EXPECT_TRUE(Ser(ShaderIndex));
+    EXPECT_EQ(ShaderIndex, Uint32{1});
+}
+
+TEST(DeviceObjectArchiveTest, MergeFilter)
+{
+    DeviceObjectArchive Src;
+    {
+        auto& VkShaders = Src.GetDeviceShaders(DeviceType::Vulkan);
+        VkShaders.emplace_back(MakeTestData(77, 11));
+        VkShaders.emplace_back(MakeTestData(99, 12));
+
+        const char* ShaderNames[] = {"Shader A", "Shader B"};
+        for (Uint32 ShaderIndex = 0; ShaderIndex < 2; ++ShaderIndex)
+        {
+            Serializer<SerializerMode::Measure> MeasureSer;
+            MeasureSer(ShaderIndex);
+
+            auto& DevData = Src.GetResourceData(ResourceType::StandaloneShader, ShaderNames[ShaderIndex]).DeviceSpecific[static_cast<size_t>(DeviceType::Vulkan)];
+            DevData       = MeasureSer.AllocateData(GetRawAllocator());
+            Serializer<SerializerMode::Write> Ser{DevData};
+            Ser(ShaderIndex);
+        }
+        Src.GetResourceData(ResourceType::RenderPass, "Render Pass").Common = MakeTestData(6, 13);
+    }
+
+    DeviceObjectArchive Archive;
+    Archive.Merge(Src, /*OverrideExisting = */ false,
+                  [](ResourceType Type, const char* Name) {
+                      return Type == ResourceType::StandaloneShader && strcmp(Name, "Shader B") == 0;
+                  });
+
+    // Only the filtered resource and the shader it references must be copied
+    EXPECT_EQ(Archive.GetNamedResources().size(), size_t{1});
+    ASSERT_EQ(Archive.GetDeviceShaders(DeviceType::Vulkan).size(), size_t{1});
+    EXPECT_EQ(Archive.GetSerializedShader(DeviceType::Vulkan, 0), MakeTestData(99, 12));
+
+    const auto& DevData = Archive.GetDeviceSpecificData(ResourceType::StandaloneShader, "Shader B", DeviceType::Vulkan);
+
+    Uint32                           ShaderIndex = ~0u;
+    Serializer<SerializerMode::Read> Ser{DevData};
+    EXPECT_TRUE(Ser(ShaderIndex));
+    EXPECT_EQ(ShaderIndex, Uint32{0});
+}
+
+
+TEST(DeviceObjectArchiveTest, MergeOverride)
+{
+    DeviceObjectArchive Patch;
+    {
+        auto& ResData = Patch.GetResourceData(ResourceType::RenderPass, "Render Pass");
+
+        ResData.Common = MakeTestData(21, 42);
+    }
+    {
+        auto& ResData = Patch.GetResourceData(ResourceType::RenderPass, "New Render Pass");
+
+        ResData.Common = MakeTestData(6, 43);
+    }
+
+    {
+        DeviceObjectArchive Archive;
+        InitTestArchive(Archive);
+        Archive.Merge(Patch);
+
+        // Existing resources must be kept
+        EXPECT_EQ(Archive.GetNamedResources().size(), size_t{4});
+        EXPECT_EQ(Archive.GetResourceData(ResourceType::RenderPass, "Render Pass").Common, MakeTestData(3, 7));
+        EXPECT_EQ(Archive.GetResourceData(ResourceType::RenderPass, "New Render Pass").Common, MakeTestData(6, 43));
+    }
+
+    {
+        DeviceObjectArchive Archive;
+        InitTestArchive(Archive);
+        Archive.Merge(Patch, /*OverrideExisting = */ true);
+
+        // Existing resources must be replaced
+        EXPECT_EQ(Archive.GetNamedResources().size(), size_t{4});
+        EXPECT_EQ(Archive.GetResourceData(ResourceType::RenderPass, "Render Pass").Common, MakeTestData(21, 42));
+        EXPECT_EQ(Archive.GetResourceData(ResourceType::RenderPass, "New Render Pass").Common, MakeTestData(6, 43));
+        EXPECT_EQ(Archive.GetResourceData(ResourceType::GraphicsPipeline, "PSO").Common, MakeTestData(64, 4));
+    }
+}
+
+} // namespace
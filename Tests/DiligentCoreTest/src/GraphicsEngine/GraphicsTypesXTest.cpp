@@ -300,6 +300,59 @@ TEST(GraphicsTypesXTest, InputLayoutDescX)
 }
 
 
+TEST(GraphicsTypesXTest, GetHash)
+{
+    {
+        SubpassDescX Subpass;
+        EXPECT_EQ(Subpass.GetHash(), StdHasher<SubpassDesc>{}(Subpass));
+
+        const auto EmptyHash = Subpass.GetHash();
+        Subpass.AddRenderTarget({1, RESOURCE_STATE_RENDER_TARGET});
+        EXPECT_NE(Subpass.GetHash(), EmptyHash);
+        EXPECT_EQ(Subpass.GetHash(), StdHasher<SubpassDesc>{}(Subpass));
+
+        const auto RTHash = Subpass.GetHash();
+        Subpass.SetDepthStencil({0, RESOURCE_STATE_DEPTH_WRITE});
+        EXPECT_NE(Subpass.GetHash(), RTHash);
+        EXPECT_EQ(Subpass.GetHash(), StdHasher<SubpassDesc>{}(Subpass));
+
+        SubpassDescX Subpass2{Subpass};
+        EXPECT_EQ(Subpass2.GetHash(), Subpass.GetHash());
+        EXPECT_EQ(std::hash<SubpassDescX>{}(Subpass2), Subpass.GetHash());
+
+        Subpass.ClearRenderTargets();
+        EXPECT_EQ(Subpass.GetHash(), StdHasher<SubpassDesc>{}(Subpass));
+        EXPECT_NE(Subpass.GetHash(), Subpass2.GetHash());
+    }
+
+    {
+        RenderPassDescX RP;
+        RP.AddAttachment({TEX_FORMAT_RGBA8_UNORM});
+        EXPECT_EQ(RP.GetHash(), StdHasher<RenderPassDesc>{}(RP));
+
+        const auto Hash = RP.GetHash();
+        RP.AddAttachment({TEX_FORMAT_D32_FLOAT});
+        EXPECT_NE(RP.GetHash(), Hash);
+        EXPECT_EQ(RP.GetHash(), StdHasher<RenderPassDesc>{}(RP));
+
+        RenderPassDescX RP2{RP};
+        EXPECT_EQ(std::hash<RenderPassDescX>{}(RP2), RP.GetHash());
+    }
+
+    {
+        InputLayoutDescX Layout{{"ATTRIB0", 0u, 0u, 3u, VT_FLOAT32}};
+        EXPECT_EQ(Layout.GetHash(), StdHasher<InputLayoutDesc>{}(Layout));
+
+        const auto Hash = Layout.GetHash();
+        Layout.Add("ATTRIB1", 1u, 0u, 2u, VT_FLOAT32);
+        EXPECT_NE(Layout.GetHash(), Hash);
+        EXPECT_EQ(Layout.GetHash(), StdHasher<InputLayoutDesc>{}(Layout));
+
+        Layout.Clear();
+        EXPECT_EQ(Layout.GetHash(), StdHasher<InputLayoutDesc>{}(InputLayoutDesc{}));
+    }
+}
+
 TEST(GraphicsTypesXTest, FramebufferDescX)
 {
     ITextureView* ppAttachments[] = {
@@ -364,6 +364,7 @@ TEST(PSOSerializerTest, SerializeGraphicsPSOCreateInfo)
             GraphicsPipeline.NumViewports      = Val(Uint8{1}, Uint8{8});
             GraphicsPipeline.SubpassIndex      = Val(Uint8{1}, Uint8{8});
             GraphicsPipeline.ShadingRateFlags  = Val(PIPELINE_SHADING_RATE_FLAG_NONE, (PIPELINE_SHADING_RATE_FLAG_LAST << 1) - 1);
+            GraphicsPipeline.DynamicStateFlags = Val(PIPELINE_DYNAMIC_STATE_FLAG_NONE, (PIPELINE_DYNAMIC_STATE_FLAG_LAST << 1) - 1);
             GraphicsPipeline.NumRenderTargets  = Val(Uint8{1}, Uint8{8});
             for (Uint32 i = 0; i < GraphicsPipeline.NumRenderTargets; ++i)
             {
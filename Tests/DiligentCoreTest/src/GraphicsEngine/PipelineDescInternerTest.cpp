@@ -0,0 +1,167 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "../../../../Graphics/GraphicsEngine/include/PipelineDescInterner.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsEngine_PipelineDescInterner, ResourceLayout)
+{
+    PipelineDescInterner Interner{DefaultRawMemoryAllocator::GetAllocator()};
+
+    std::string VarName0 = "g_Texture";
+    std::string VarName1 = "g_Buffer";
+    std::string SamName  = "g_Texture_sampler";
+
+    const ShaderResourceVariableDesc Vars[] = {
+        {SHADER_TYPE_PIXEL, VarName0.c_str(), SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        {SHADER_TYPE_VERTEX, VarName1.c_str(), SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+    };
+    const ImmutableSamplerDesc ImtblSamplers[] = {
+        {SHADER_TYPE_PIXEL, SamName.c_str(), SamplerDesc{}},
+    };
+
+    PipelineResourceLayoutDesc Layout;
+    Layout.Variables            = Vars;
+    Layout.NumVariables         = _countof(Vars);
+    Layout.ImmutableSamplers    = ImtblSamplers;
+    Layout.NumImmutableSamplers = _countof(ImtblSamplers);
+
+    auto pLayout0 = Interner.Intern(Layout);
+    ASSERT_NE(pLayout0, nullptr);
+    EXPECT_EQ(*pLayout0, Layout);
+    // The interned block must not reference the source memory
+    EXPECT_NE(pLayout0->Variables, Layout.Variables);
+    EXPECT_NE(pLayout0->Variables[0].Name, VarName0.c_str());
+    EXPECT_NE(pLayout0->ImmutableSamplers[0].SamplerOrTextureName, SamName.c_str());
+    EXPECT_EQ(Interner.GetNumResourceLayouts(), size_t{1});
+
+    // Equal layout with different string storage must be shared
+    std::string VarName0Copy = VarName0;
+
+    ShaderResourceVariableDesc Vars2[] = {Vars[0], Vars[1]};
+    Vars2[0].Name                      = VarName0Copy.c_str();
+
+    PipelineResourceLayoutDesc Layout2 = Layout;
+    Layout2.Variables                  = Vars2;
+
+    auto pLayout1 = Interner.Intern(Layout2);
+    EXPECT_EQ(pLayout1, pLayout0);
+    EXPECT_EQ(Interner.GetNumResourceLayouts(), size_t{1});
+
+    // Different layout
+    Layout2.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+
+    auto pLayout2 = Interner.Intern(Layout2);
+    EXPECT_NE(pLayout2, pLayout0);
+    EXPECT_EQ(Interner.GetNumResourceLayouts(), size_t{2});
+
+    // The interned copy stays valid after the source is gone
+    VarName0.clear();
+    EXPECT_STREQ(pLayout0->Variables[0].Name, "g_Texture");
+
+    pLayout0.reset();
+    EXPECT_EQ(Interner.GetNumResourceLayouts(), size_t{2});
+    pLayout1.reset();
+    EXPECT_EQ(Interner.GetNumResourceLayouts(), size_t{1});
+    pLayout2.reset();
+    EXPECT_EQ(Interner.GetNumResourceLayouts(), size_t{0});
+}
+
+TEST(GraphicsEngine_PipelineDescInterner, InputLayout)
+{
+    PipelineDescInterner Interner{DefaultRawMemoryAllocator::GetAllocator()};
+
+    const LayoutElement Elems[] = {
+        LayoutElement{0, 0, 3, VT_FLOAT32},
+        LayoutElement{1, 0, 2, VT_FLOAT32},
+    };
+    const InputLayoutDesc Layout{Elems, _countof(Elems)};
+
+    auto pLayout0 = Interner.Intern(Layout);
+    ASSERT_NE(pLayout0, nullptr);
+    EXPECT_EQ(*pLayout0, Layout);
+    EXPECT_NE(pLayout0->LayoutElements, Layout.LayoutElements);
+    EXPECT_NE(pLayout0->LayoutElements[0].HLSLSemantic, Layout.LayoutElements[0].HLSLSemantic);
+
+    auto pLayout1 = Interner.Intern(InputLayoutDesc{Elems, 1});
+    EXPECT_NE(pLayout1, pLayout0);
+    EXPECT_EQ(Interner.Intern(Layout), pLayout0);
+    EXPECT_EQ(Interner.GetNumInputLayouts(), size_t{2});
+    EXPECT_EQ(Interner.GetNumResourceLayouts(), size_t{0});
+
+    pLayout0.reset();
+    pLayout1.reset();
+    EXPECT_EQ(Interner.GetNumInputLayouts(), size_t{0});
+}
+
+TEST(GraphicsEngine_PipelineDescInterner, Parallel)
+{
+    PipelineDescInterner Interner{DefaultRawMemoryAllocator::GetAllocator()};
+
+    constexpr Uint32 NumThreads    = 8;
+    constexpr Uint32 NumIterations = 1000;
+    constexpr Uint32 NumLayouts    = 4;
+
+    const LayoutElement Elems[NumLayouts] = {
+        LayoutElement{0, 0, 1, VT_FLOAT32},
+        LayoutElement{0, 0, 2, VT_FLOAT32},
+        LayoutElement{0, 0, 3, VT_FLOAT32},
+        LayoutElement{0, 0, 4, VT_FLOAT32},
+    };
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back(
+            [&Interner, &Elems, t]() {
+                for (Uint32 i = 0; i < NumIterations; ++i)
+                {
+                    const auto& Elem    = Elems[(i + t) % NumLayouts];
+                    auto        pLayout = Interner.Intern(InputLayoutDesc{&Elem, 1});
+                    EXPECT_EQ(pLayout->LayoutElements[0], Elem);
+                }
+            });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(Interner.GetNumInputLayouts(), size_t{0});
+}
+
+} // namespace
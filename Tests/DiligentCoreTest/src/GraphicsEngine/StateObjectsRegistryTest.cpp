@@ -0,0 +1,209 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "../../../../Graphics/GraphicsEngine/include/StateObjectsRegistry.hpp"
+
+#include <thread>
+#include <vector>
+
+#include "ObjectBase.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct TestObjectDesc
+{
+    Uint32 Value = 0;
+
+    bool operator==(const TestObjectDesc& rhs) const
+    {
+        return Value == rhs.Value;
+    }
+};
+
+} // namespace
+
+namespace std
+{
+
+template <>
+struct hash<TestObjectDesc>
+{
+    size_t operator()(const TestObjectDesc& Desc) const
+    {
+        // Make every four descriptions share the same hash and the same shard
+        // to exercise collision handling.
+        return size_t{Desc.Value / 4} * StateObjectsRegistry<TestObjectDesc>::NumShards;
+    }
+};
+
+} // namespace std
+
+namespace
+{
+
+class TestObject final : public ObjectBase<IDeviceObject>
+{
+public:
+    using TBase = ObjectBase<IDeviceObject>;
+
+    TestObject(IReferenceCounters* pRefCounters, StateObjectsRegistry<TestObjectDesc>& Registry) :
+        TBase{pRefCounters},
+        m_Registry{Registry}
+    {}
+
+    ~TestObject()
+    {
+        m_Registry.ReportDeletedObject();
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DeviceObject, TBase)
+
+    virtual const DeviceObjectAttribs& DILIGENT_CALL_TYPE GetDesc() const override final { return m_Desc; }
+    virtual Int32 DILIGENT_CALL_TYPE                      GetUniqueID() const override final { return 1; }
+    virtual void DILIGENT_CALL_TYPE                       SetUserData(IObject* pUserData) override final {}
+    virtual IObject* DILIGENT_CALL_TYPE                   GetUserData() const override final { return nullptr; }
+
+private:
+    StateObjectsRegistry<TestObjectDesc>& m_Registry;
+    DeviceObjectAttribs                   m_Desc;
+};
+
+RefCntAutoPtr<IDeviceObject> FindObject(StateObjectsRegistry<TestObjectDesc>& Registry, Uint32 Value)
+{
+    RefCntAutoPtr<IDeviceObject> pObject;
+    Registry.Find(TestObjectDesc{Value}, &pObject);
+    return pObject;
+}
+
+TEST(GraphicsEngine_StateObjectsRegistry, AddFind)
+{
+    StateObjectsRegistry<TestObjectDesc> Registry{DefaultRawMemoryAllocator::GetAllocator(), "test"};
+
+    constexpr Uint32 NumObjects = 256;
+
+    std::vector<RefCntAutoPtr<IDeviceObject>> Objects;
+    for (Uint32 i = 0; i < NumObjects; ++i)
+    {
+        EXPECT_EQ(FindObject(Registry, i), nullptr);
+
+        const TestObjectDesc Desc{i};
+        Objects.emplace_back(MakeNewRCObj<TestObject>()(Registry));
+        Registry.Add(Desc, Registry.ComputeDescHash(Desc), Objects.back());
+    }
+
+    for (Uint32 i = 0; i < NumObjects; ++i)
+        EXPECT_EQ(FindObject(Registry, i), Objects[i]) << i;
+    EXPECT_EQ(FindObject(Registry, NumObjects), nullptr);
+
+    // Replace existing reference
+    RefCntAutoPtr<IDeviceObject> pNewObj{MakeNewRCObj<TestObject>()(Registry)};
+    Registry.Add(TestObjectDesc{5}, pNewObj);
+    EXPECT_EQ(FindObject(Registry, 5), pNewObj);
+}
+
+TEST(GraphicsEngine_StateObjectsRegistry, ExpiredObjects)
+{
+    StateObjectsRegistry<TestObjectDesc> Registry{DefaultRawMemoryAllocator::GetAllocator(), "test"};
+
+    constexpr Uint32 NumObjects = 512;
+
+    std::vector<RefCntAutoPtr<IDeviceObject>> Objects;
+    for (Uint32 i = 0; i < NumObjects; ++i)
+    {
+        Objects.emplace_back(MakeNewRCObj<TestObject>()(Registry));
+        Registry.Add(TestObjectDesc{i}, Objects.back());
+    }
+
+    // Release every third object
+    for (Uint32 i = 0; i < NumObjects; i += 3)
+        Objects[i].Release();
+
+    // Expired references must be removed while the rest of the objects remain reachable
+    for (Uint32 i = 0; i < NumObjects; ++i)
+        EXPECT_EQ(FindObject(Registry, i), Objects[i]) << i;
+
+    // Adding new objects incrementally purges expired references
+    for (Uint32 i = 1; i < NumObjects; i += 3)
+        Objects[i].Release();
+    for (Uint32 i = NumObjects; i < NumObjects * 2; ++i)
+    {
+        Objects.emplace_back(MakeNewRCObj<TestObject>()(Registry));
+        Registry.Add(TestObjectDesc{i}, Objects.back());
+    }
+    for (Uint32 i = 0; i < NumObjects * 2; ++i)
+        EXPECT_EQ(FindObject(Registry, i), Objects[i]) << i;
+
+    Registry.Purge();
+    for (Uint32 i = 0; i < NumObjects * 2; ++i)
+        EXPECT_EQ(FindObject(Registry, i), Objects[i]) << i;
+
+    Objects.clear();
+    Registry.Purge();
+    for (Uint32 i = 0; i < NumObjects * 2; ++i)
+        EXPECT_EQ(FindObject(Registry, i), nullptr) << i;
+}
+
+TEST(GraphicsEngine_StateObjectsRegistry, Multithreading)
+{
+    StateObjectsRegistry<TestObjectDesc> Registry{DefaultRawMemoryAllocator::GetAllocator(), "test"};
+
+    constexpr Uint32 NumThreads    = 8;
+    constexpr Uint32 NumIterations = 2000;
+    constexpr Uint32 NumDescs      = 128;
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back(
+            [&Registry, t]() {
+                for (Uint32 i = 0; i < NumIterations; ++i)
+                {
+                    const TestObjectDesc Desc{(i * 7 + t) % NumDescs};
+                    const auto           DescHash = Registry.ComputeDescHash(Desc);
+
+                    RefCntAutoPtr<IDeviceObject> pObject;
+                    Registry.Find(Desc, DescHash, &pObject);
+                    if (!pObject)
+                    {
+                        pObject = MakeNewRCObj<TestObject>()(Registry);
+                        Registry.Add(Desc, DescHash, pObject);
+                    }
+                    EXPECT_NE(pObject, nullptr);
+                }
+            });
+    }
+
+    for (auto& Thread : Threads)
+        Thread.join();
+}
+
+} // namespace
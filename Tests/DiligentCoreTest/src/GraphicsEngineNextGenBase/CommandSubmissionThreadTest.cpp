@@ -0,0 +1,266 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "CommandSubmissionThread.hpp"
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+
+#include "ThreadSignal.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class MockCommandQueue
+{
+public:
+    Uint64 GetNextFenceValue() const
+    {
+        return m_NextFenceValue.load();
+    }
+
+    // Must be called while the queue mutex is locked
+    Uint64 Submit()
+    {
+        return m_NextFenceValue.fetch_add(1);
+    }
+
+    std::mutex Mtx;
+
+private:
+    std::atomic<Uint64> m_NextFenceValue{1};
+};
+
+using SubmissionThread = CommandSubmissionThread<MockCommandQueue>;
+
+// Enqueues the submission and records the fence value that the queue has signaled for it
+Uint64 EnqueueSubmission(SubmissionThread&                    Thread,
+                         std::shared_ptr<std::atomic<Uint64>> pSignaledValue,
+                         Threading::Signal*                   pGate    = nullptr,
+                         std::atomic<bool>*                   pStarted = nullptr)
+{
+    return Thread.Enqueue(
+        [pSignaledValue, pGate, pStarted](MockCommandQueue* pQueue) {
+            if (pStarted != nullptr)
+                pStarted->store(true);
+            if (pGate != nullptr)
+                pGate->Wait();
+            const auto FenceValue = pQueue->Submit();
+            pSignaledValue->store(FenceValue);
+            return FenceValue;
+        },
+        []() {});
+}
+
+TEST(GraphicsEngineNextGenBase_CommandSubmissionThread, ConcurrentEnqueue)
+{
+    const auto NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    static constexpr size_t NumThreadSubmissions = 1024;
+
+    MockCommandQueue Queue;
+
+    std::vector<std::vector<Uint64>>                               Returned(NumThreads);
+    std::vector<std::vector<std::shared_ptr<std::atomic<Uint64>>>> Signaled(NumThreads);
+    std::vector<std::vector<size_t>>                               HandlerOrder(NumThreads);
+    size_t                                                         NumHandlerCalls = 0;
+    {
+        SubmissionThread Thread{&Queue, Queue.Mtx};
+
+        std::vector<std::thread> Workers;
+        Workers.reserve(NumThreads);
+        for (size_t t = 0; t < NumThreads; ++t)
+        {
+            Workers.emplace_back(
+                [&, t]() {
+                    Returned[t].reserve(NumThreadSubmissions);
+                    Signaled[t].reserve(NumThreadSubmissions);
+                    HandlerOrder[t].reserve(NumThreadSubmissions);
+                    for (size_t i = 0; i < NumThreadSubmissions; ++i)
+                    {
+                        auto pSignaledValue = std::make_shared<std::atomic<Uint64>>(0);
+                        Signaled[t].push_back(pSignaledValue);
+
+                        size_t Order = 0;
+
+                        const auto FenceValue = Thread.Enqueue(
+                            [pSignaledValue](MockCommandQueue* pQueue) {
+                                const auto Value = pQueue->Submit();
+                                pSignaledValue->store(Value);
+                                return Value;
+                            },
+                            [&]() {
+                                // The handlers are serialized by the thread
+                                Order = NumHandlerCalls++;
+                            });
+                        Returned[t].push_back(FenceValue);
+                        HandlerOrder[t].push_back(Order);
+                    }
+                });
+        }
+        for (auto& Worker : Workers)
+            Worker.join();
+
+        // Wait until all submissions are executed
+        Thread.BeginExclusiveAccess();
+        Thread.EndExclusiveAccess();
+    }
+
+    const Uint64 TotalSubmissions = Uint64{NumThreads} * NumThreadSubmissions;
+    EXPECT_EQ(Queue.GetNextFenceValue(), TotalSubmissions + 1);
+
+    std::vector<Uint64> AllFenceValues;
+    AllFenceValues.reserve(static_cast<size_t>(TotalSubmissions));
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        for (size_t i = 0; i < NumThreadSubmissions; ++i)
+        {
+            if (i > 0)
+            {
+                EXPECT_GT(Returned[t][i], Returned[t][i - 1]);
+            }
+            EXPECT_EQ(Signaled[t][i]->load(), Returned[t][i]) << "Thread " << t << ", submission " << i;
+            // The handlers must have been called in the order of the fence values
+            EXPECT_EQ(Uint64{HandlerOrder[t][i] + 1}, Returned[t][i]) << "Thread " << t << ", submission " << i;
+            AllFenceValues.push_back(Returned[t][i]);
+        }
+    }
+
+    // Every fence value must have been returned exactly once
+    std::sort(AllFenceValues.begin(), AllFenceValues.end());
+    for (size_t i = 0; i < AllFenceValues.size(); ++i)
+        ASSERT_EQ(AllFenceValues[i], Uint64{i + 1});
+}
+
+TEST(GraphicsEngineNextGenBase_CommandSubmissionThread, FullQueue)
+{
+    // Must match CommandSubmissionThread::MaxPendingSubmissions
+    static constexpr size_t MaxPendingSubmissions = 64;
+
+    MockCommandQueue Queue;
+    SubmissionThread Thread{&Queue, Queue.Mtx};
+
+    Threading::Signal Gate;
+
+    // Block the thread in the first submission after it has been popped from the queue
+    std::atomic<bool> FirstStarted{false};
+    auto              pFirstSignaled = std::make_shared<std::atomic<Uint64>>(0);
+    EXPECT_EQ(EnqueueSubmission(Thread, pFirstSignaled, &Gate, &FirstStarted), 1u);
+    while (!FirstStarted.load())
+        std::this_thread::yield();
+
+    // The submission being executed is still pending
+    std::vector<std::shared_ptr<std::atomic<Uint64>>> Signaled;
+    for (size_t i = 0; i < MaxPendingSubmissions - 1; ++i)
+    {
+        Signaled.push_back(std::make_shared<std::atomic<Uint64>>(0));
+        EXPECT_EQ(EnqueueSubmission(Thread, Signaled.back()), Uint64{i + 2});
+    }
+
+    // The maximum number of submissions is pending: the next one must wait for the thread
+    std::atomic<Uint64> BlockedFenceValue{0};
+    auto                pBlockedSignaled = std::make_shared<std::atomic<Uint64>>(0);
+
+    std::thread Producer{
+        [&]() {
+            BlockedFenceValue.store(EnqueueSubmission(Thread, pBlockedSignaled));
+        }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    EXPECT_EQ(BlockedFenceValue.load(), 0u) << "Enqueue must wait while the queue is full";
+    EXPECT_EQ(pFirstSignaled->load(), 0u);
+
+    Gate.Trigger(true);
+    Producer.join();
+
+    EXPECT_EQ(BlockedFenceValue.load(), Uint64{MaxPendingSubmissions + 1});
+
+    Thread.BeginExclusiveAccess();
+    EXPECT_EQ(pFirstSignaled->load(), 1u);
+    for (size_t i = 0; i < Signaled.size(); ++i)
+        EXPECT_EQ(Signaled[i]->load(), Uint64{i + 2});
+    EXPECT_EQ(pBlockedSignaled->load(), Uint64{MaxPendingSubmissions + 1});
+    Thread.EndExclusiveAccess();
+}
+
+TEST(GraphicsEngineNextGenBase_CommandSubmissionThread, ExclusiveAccess)
+{
+    MockCommandQueue Queue;
+    SubmissionThread Thread{&Queue, Queue.Mtx};
+
+    std::vector<std::shared_ptr<std::atomic<Uint64>>> Signaled;
+    for (Uint64 i = 0; i < 8; ++i)
+    {
+        Signaled.push_back(std::make_shared<std::atomic<Uint64>>(0));
+        EXPECT_EQ(EnqueueSubmission(Thread, Signaled.back()), i + 1);
+    }
+
+    // Waits for all pending submissions
+    Thread.BeginExclusiveAccess();
+    for (Uint64 i = 0; i < 8; ++i)
+        EXPECT_EQ(Signaled[i]->load(), i + 1);
+
+    // Access the queue directly
+    {
+        std::lock_guard<std::mutex> Lock{Queue.Mtx};
+        EXPECT_EQ(Queue.Submit(), 9u);
+    }
+
+    std::atomic<Uint64> BlockedFenceValue{0};
+    auto                pBlockedSignaled = std::make_shared<std::atomic<Uint64>>(0);
+
+    std::thread Producer{
+        [&]() {
+            BlockedFenceValue.store(EnqueueSubmission(Thread, pBlockedSignaled));
+        }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    EXPECT_EQ(BlockedFenceValue.load(), 0u) << "Enqueue must wait until the exclusive access ends";
+    EXPECT_EQ(pBlockedSignaled->load(), 0u);
+
+    // The direct submission must be accounted for
+    EXPECT_EQ(Thread.GetNextFenceValue(), 10u);
+
+    Thread.EndExclusiveAccess();
+    Producer.join();
+
+    EXPECT_EQ(BlockedFenceValue.load(), 10u);
+
+    Thread.BeginExclusiveAccess();
+    EXPECT_EQ(pBlockedSignaled->load(), 10u);
+    Thread.EndExclusiveAccess();
+}
+
+} // namespace
@@ -0,0 +1,226 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "DynamicHeap.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+using PageRingManager = DynamicHeap::MasterBlockLockFreeRingManager;
+using OffsetType      = PageRingManager::OffsetType;
+
+constexpr OffsetType PageSize = 256;
+
+TEST(GraphicsEngineNextGenBase_DynamicHeapPageRing, WrapSkipsTailPages)
+{
+    PageRingManager Ring{DefaultRawMemoryAllocator::GetAllocator(), PageSize * 4, PageSize};
+    EXPECT_EQ(Ring.GetSize(), PageSize * 4);
+
+    auto Block = Ring.AllocateMasterBlock(PageSize, 16);
+    EXPECT_EQ(Block.UnalignedOffset, OffsetType{0});
+    EXPECT_EQ(Block.Size, PageSize);
+    Ring.FinishFrame(1);
+
+    // Rounded up to two pages
+    Block = Ring.AllocateMasterBlock(PageSize + 1, 0);
+    EXPECT_EQ(Block.UnalignedOffset, PageSize);
+    EXPECT_EQ(Block.Size, PageSize * 2);
+    Ring.FinishFrame(2);
+    EXPECT_EQ(Ring.GetUsedSize(), PageSize * 3);
+
+    Ring.ReleaseCompletedFrames(1);
+    EXPECT_EQ(Ring.GetUsedSize(), PageSize * 2);
+
+    // Two pages do not fit into the last page of the ring. The block must start at the beginning of
+    // the ring, but the first page is still used by the second frame.
+    EXPECT_FALSE(Ring.AllocateMasterBlock(PageSize * 2, 0).IsValid());
+    EXPECT_EQ(Ring.GetUsedSize(), PageSize * 2);
+
+    Ring.ReleaseCompletedFrames(2);
+    EXPECT_EQ(Ring.GetUsedSize(), OffsetType{0});
+
+    Block = Ring.AllocateMasterBlock(PageSize * 2, 0);
+    EXPECT_EQ(Block.UnalignedOffset, OffsetType{0});
+    EXPECT_EQ(Block.Size, PageSize * 2);
+    // The skipped page at the end of the ring is used until the frame is released
+    EXPECT_EQ(Ring.GetUsedSize(), PageSize * 3);
+
+    // The next block continues after the wrapped one
+    Block = Ring.AllocateMasterBlock(PageSize, 0);
+    EXPECT_EQ(Block.UnalignedOffset, PageSize * 2);
+    EXPECT_EQ(Ring.GetUsedSize(), PageSize * 4);
+    Ring.FinishFrame(3);
+
+    Ring.ReleaseCompletedFrames(3);
+    EXPECT_EQ(Ring.GetUsedSize(), OffsetType{0});
+}
+
+TEST(GraphicsEngineNextGenBase_DynamicHeapPageRing, FullRing)
+{
+    PageRingManager Ring{DefaultRawMemoryAllocator::GetAllocator(), PageSize * 4, PageSize};
+
+    // Larger than the ring
+    EXPECT_FALSE(Ring.AllocateMasterBlock(PageSize * 4 + 1, 0).IsValid());
+
+    for (OffsetType i = 0; i < 4; ++i)
+    {
+        const auto Block = Ring.AllocateMasterBlock(PageSize, 0);
+        EXPECT_EQ(Block.UnalignedOffset, PageSize * i);
+    }
+    EXPECT_EQ(Ring.GetUsedSize(), Ring.GetSize());
+
+    EXPECT_FALSE(Ring.AllocateMasterBlock(1, 0).IsValid());
+    EXPECT_EQ(Ring.GetUsedSize(), Ring.GetSize());
+
+    Ring.FinishFrame(1);
+    // The frame is not completed yet
+    Ring.ReleaseCompletedFrames(0);
+    EXPECT_FALSE(Ring.AllocateMasterBlock(1, 0).IsValid());
+
+    Ring.ReleaseCompletedFrames(1);
+    const auto Block = Ring.AllocateMasterBlock(PageSize * 4, 0);
+    EXPECT_EQ(Block.UnalignedOffset, OffsetType{0});
+    EXPECT_EQ(Block.Size, PageSize * 4);
+    EXPECT_FALSE(Ring.AllocateMasterBlock(1, 0).IsValid());
+
+    Ring.FinishFrame(2);
+    Ring.ReleaseCompletedFrames(2);
+}
+
+TEST(GraphicsEngineNextGenBase_DynamicHeapPageRing, ReleaseCompletedFrames)
+{
+    PageRingManager Ring{DefaultRawMemoryAllocator::GetAllocator(), PageSize * 8, PageSize};
+
+    Ring.AllocateMasterBlock(PageSize, 0);
+    Ring.FinishFrame(5);
+
+    Ring.AllocateMasterBlock(PageSize * 2, 0);
+    Ring.FinishFrame(7);
+
+    // Empty frames are ignored
+    Ring.FinishFrame(8);
+
+    Ring.AllocateMasterBlock(PageSize, 0);
+    EXPECT_EQ(Ring.GetUsedSize(), PageSize * 4);
+
+    Ring.ReleaseCompletedFrames(4);
+    EXPECT_EQ(Ring.GetUsedSize(), PageSize * 4);
+
+    Ring.ReleaseCompletedFrames(5);
+    EXPECT_EQ(Ring.GetUsedSize(), PageSize * 3);
+
+    Ring.ReleaseCompletedFrames(6);
+    EXPECT_EQ(Ring.GetUsedSize(), PageSize * 3);
+
+    Ring.ReleaseCompletedFrames(7);
+    EXPECT_EQ(Ring.GetUsedSize(), PageSize);
+
+    // The pages allocated after the last frame was finished are not released
+    Ring.ReleaseCompletedFrames(100);
+    EXPECT_EQ(Ring.GetUsedSize(), PageSize);
+
+    Ring.FinishFrame(9);
+    Ring.ReleaseCompletedFrames(8);
+    EXPECT_EQ(Ring.GetUsedSize(), PageSize);
+    Ring.ReleaseCompletedFrames(9);
+    EXPECT_EQ(Ring.GetUsedSize(), OffsetType{0});
+}
+
+TEST(GraphicsEngineNextGenBase_DynamicHeapPageRing, ConcurrentAllocate)
+{
+    const auto NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    constexpr OffsetType NumPages = 1021;
+    PageRingManager      Ring{DefaultRawMemoryAllocator::GetAllocator(), static_cast<Uint32>(PageSize * NumPages), static_cast<Uint32>(PageSize)};
+
+    std::vector<std::vector<PageRingManager::MasterBlock>> ThreadBlocks(NumThreads);
+    for (Uint64 Frame = 1; Frame <= 8; ++Frame)
+    {
+        std::vector<std::thread> Workers;
+        Workers.reserve(NumThreads);
+        for (size_t t = 0; t < NumThreads; ++t)
+        {
+            Workers.emplace_back(
+                [&Ring, &Blocks = ThreadBlocks[t], Seed = static_cast<unsigned int>(Frame * NumThreads + t)]() {
+                    FastRandInt Rnd{Seed, 1, 3};
+                    Blocks.clear();
+                    // Allocate until the ring is exhausted
+                    while (true)
+                    {
+                        const auto Block = Ring.AllocateMasterBlock(PageSize * static_cast<OffsetType>(Rnd()), 0);
+                        if (!Block.IsValid())
+                            break;
+                        Blocks.push_back(Block);
+                    }
+                });
+        }
+        for (auto& Worker : Workers)
+            Worker.join();
+
+        // Every page must have been allocated at most once
+        std::vector<bool> PageUsed(NumPages);
+        size_t            NumUsedPages = 0;
+        for (const auto& Blocks : ThreadBlocks)
+        {
+            for (const auto& Block : Blocks)
+            {
+                ASSERT_EQ(Block.UnalignedOffset % PageSize, OffsetType{0});
+                const auto FirstPage = Block.UnalignedOffset / PageSize;
+                const auto EndPage   = FirstPage + Block.Size / PageSize;
+                ASSERT_LE(EndPage, NumPages) << "Blocks must not wrap around the end of the ring";
+                for (auto Page = FirstPage; Page < EndPage; ++Page)
+                {
+                    ASSERT_FALSE(PageUsed[Page]) << "Page " << Page << " has been allocated twice in frame " << Frame;
+                    PageUsed[Page] = true;
+                    ++NumUsedPages;
+                }
+            }
+        }
+        // At most two pages may remain free, and at most two pages may be skipped at the end of the ring
+        EXPECT_GE(NumUsedPages + 4, NumPages);
+        EXPECT_GE(Ring.GetUsedSize(), NumUsedPages * PageSize);
+        EXPECT_LE(Ring.GetUsedSize(), Ring.GetSize());
+
+        Ring.FinishFrame(Frame);
+        Ring.ReleaseCompletedFrames(Frame);
+        EXPECT_EQ(Ring.GetUsedSize(), OffsetType{0});
+    }
+}
+
+} // namespace
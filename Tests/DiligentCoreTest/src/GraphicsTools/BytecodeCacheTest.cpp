@@ -27,9 +27,12 @@
 #include "BytecodeCache.h"
 #include "DataBlobImpl.hpp"
 #include "DefaultShaderSourceStreamFactory.h"
+#include "FileSystem.hpp"
+#include "TempDirectory.hpp"
 #include "gtest/gtest.h"
 
 using namespace Diligent;
+using namespace Diligent::Testing;
 
 namespace
 {
@@ -138,6 +141,63 @@ TEST(BytecodeCacheTest, DoubleAdd)
     }
 }
 
+TEST(BytecodeCacheTest, DeviceAPIVersion)
+{
+    ShaderCreateInfo ShaderCI{};
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name       = "TestName";
+    ShaderCI.Source          = "SomeCode";
+
+    const std::string        Data{"TestString"};
+    RefCntAutoPtr<IDataBlob> pReferenceBytecode = DataBlobImpl::Create(Data.length(), Data.c_str());
+
+    RefCntAutoPtr<IDataBlob> pCacheData;
+    {
+        BytecodeCacheCreateInfo CacheCI;
+        CacheCI.DeviceType       = RENDER_DEVICE_TYPE_GLES;
+        CacheCI.DeviceAPIVersion = Version{3, 2};
+
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CacheCI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+        pCache->AddBytecode(ShaderCI, pReferenceBytecode);
+        pCache->Store(&pCacheData);
+        ASSERT_NE(pCacheData, nullptr);
+    }
+
+    {
+        BytecodeCacheCreateInfo CacheCI;
+        CacheCI.DeviceType       = RENDER_DEVICE_TYPE_GLES;
+        CacheCI.DeviceAPIVersion = Version{3, 0};
+
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CacheCI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+        EXPECT_TRUE(pCache->Load(pCacheData));
+
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecode(ShaderCI, &pBytecode);
+        EXPECT_EQ(pBytecode, nullptr);
+    }
+
+    {
+        BytecodeCacheCreateInfo CacheCI;
+        CacheCI.DeviceType       = RENDER_DEVICE_TYPE_GLES;
+        CacheCI.DeviceAPIVersion = Version{3, 2};
+
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CacheCI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+        EXPECT_TRUE(pCache->Load(pCacheData));
+
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecode(ShaderCI, &pBytecode);
+        ASSERT_NE(pBytecode, nullptr);
+        EXPECT_EQ(pReferenceBytecode->GetSize(), pBytecode->GetSize());
+        EXPECT_EQ(memcmp(pReferenceBytecode->GetConstDataPtr(), pBytecode->GetConstDataPtr(), pBytecode->GetSize()), 0);
+    }
+}
+
 TEST(BytecodeCacheTest, Include)
 {
     RefCntAutoPtr<IBytecodeCache> pCache;
@@ -186,4 +246,77 @@ TEST(BytecodeCacheTest, Include)
     }
 }
 
+TEST(BytecodeCacheTest, PersistentFile)
+{
+    TempDirectory TmpDir;
+    const auto    FilePath = TmpDir.Get() + FileSystem::SlashSymbol + "BytecodeCache.bin";
+
+    BytecodeCacheCreateInfo CacheCI;
+    CacheCI.DeviceType          = RENDER_DEVICE_TYPE_VULKAN;
+    CacheCI.FilePath            = FilePath.c_str();
+    CacheCI.CompactionThreshold = 3;
+
+    constexpr Uint32 NumShaders = 8;
+
+    std::vector<std::string> Names(NumShaders);
+    for (Uint32 i = 0; i < NumShaders; ++i)
+        Names[i] = "TestName" + std::to_string(i);
+
+    auto GetShaderCI = [&](Uint32 i) {
+        ShaderCreateInfo ShaderCI{};
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+        ShaderCI.Desc.Name       = Names[i].c_str();
+        ShaderCI.Source          = Names[i].c_str();
+        return ShaderCI;
+    };
+
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CacheCI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        for (Uint32 i = 0; i < NumShaders; ++i)
+        {
+            const std::string        Data{"TestString" + std::to_string(i)};
+            RefCntAutoPtr<IDataBlob> pBytecode = DataBlobImpl::Create(Data.length(), Data.c_str());
+            pCache->AddBytecode(GetShaderCI(i), pBytecode);
+        }
+        pCache->RemoveBytecode(GetShaderCI(0));
+    }
+
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CacheCI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        for (Uint32 i = 0; i < NumShaders; ++i)
+        {
+            RefCntAutoPtr<IDataBlob> pBytecode;
+            pCache->GetBytecode(GetShaderCI(i), &pBytecode);
+            if (i == 0)
+            {
+                EXPECT_EQ(pBytecode, nullptr);
+                continue;
+            }
+            ASSERT_NE(pBytecode, nullptr);
+
+            const std::string Data{"TestString" + std::to_string(i)};
+            EXPECT_EQ(pBytecode->GetSize(), Data.length());
+            EXPECT_EQ(memcmp(Data.c_str(), pBytecode->GetConstDataPtr(), Data.length()), 0);
+        }
+
+        pCache->Clear();
+    }
+
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CacheCI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecode(GetShaderCI(1), &pBytecode);
+        EXPECT_EQ(pBytecode, nullptr);
+    }
+}
+
 } // namespace
@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GPUProfiler.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GPUProfilerTest, WriteChromeTrace)
+{
+    GPUProfiler::FrameData Frame;
+    Frame.FrameNumber = 7;
+
+    GPUProfiler::ScopeData Scope;
+    Scope.Name      = "Frame";
+    Scope.StartTime = 1.0;
+    Scope.EndTime   = 1.5;
+    Frame.Scopes.push_back(Scope);
+
+    Scope.Name         = "Shadow \"pass\"\n";
+    Scope.ContextIndex = 1;
+    Scope.Depth        = 1;
+    Scope.ParentIndex  = 0;
+    Scope.StartTime    = 1.25;
+    Scope.EndTime      = 1.25;
+    Frame.Scopes.push_back(Scope);
+
+    std::string Json;
+    GPUProfiler::WriteChromeTrace(Frame, {"Main", "Compute\\Async"}, Json);
+
+    EXPECT_EQ(Json,
+              "{\"traceEvents\":[\n"
+              "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Main\"}},\n"
+              "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"Compute\\\\Async\"}},\n"
+              "{\"name\":\"Frame\",\"cat\":\"GPU\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":1000000.000,\"dur\":500000.000,\"args\":{\"frame\":7}},\n"
+              "{\"name\":\"Shadow \\\"pass\\\"\\n\",\"cat\":\"GPU\",\"ph\":\"X\",\"pid\":0,\"tid\":1,\"ts\":1250000.000,\"dur\":0.000,\"args\":{\"frame\":7}}\n"
+              "],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+TEST(GPUProfilerTest, WriteEmptyChromeTrace)
+{
+    std::string Json;
+    GPUProfiler::WriteChromeTrace({}, {}, Json);
+    EXPECT_EQ(Json, "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+} // namespace
@@ -0,0 +1,262 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GeometryPreprocessing.hpp"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "FastRand.hpp"
+#include "TestingEnvironment.hpp"
+#include "GridMesh.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Shuffles the triangles within every block of BlockSize triangles
+void ShuffleTriangles(std::vector<Uint32>& Indices, size_t BlockSize)
+{
+    FastRand Rnd{1};
+
+    const size_t NumTris = Indices.size() / 3;
+    for (size_t Block = 0; Block < NumTris; Block += BlockSize)
+    {
+        const size_t Count = std::min(BlockSize, NumTris - Block);
+        for (size_t t = Count - 1; t > 0; --t)
+        {
+            const size_t Other = ((size_t{Rnd()} << 15u) | size_t{Rnd()}) % (t + 1);
+            for (size_t i = 0; i < 3; ++i)
+                std::swap(Indices[(Block + t) * 3 + i], Indices[(Block + Other) * 3 + i]);
+        }
+    }
+}
+
+std::vector<std::array<Uint32, 3>> GetSortedTriangles(const std::vector<Uint32>& Indices)
+{
+    std::vector<std::array<Uint32, 3>> Tris;
+    for (size_t t = 0; t < Indices.size() / 3; ++t)
+        Tris.push_back({Indices[t * 3 + 0], Indices[t * 3 + 1], Indices[t * 3 + 2]});
+    std::sort(Tris.begin(), Tris.end());
+    return Tris;
+}
+
+TEST(GeometryPreprocessingTest, ConvertIndicesToUint16)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::vector<Uint32> Indices(10000);
+    for (Uint32 i = 0; i < Indices.size(); ++i)
+        Indices[i] = (i * 7919u) % 65536u;
+
+    for (auto* pPool : {static_cast<IThreadPool*>(nullptr), pThreadPool.RawPtr()})
+    {
+        std::vector<Uint16> Indices16(Indices.size());
+        EXPECT_TRUE(ConvertIndicesToUint16(Indices.data(), static_cast<Uint32>(Indices.size()), Indices16.data(), pPool, 1000));
+        for (size_t i = 0; i < Indices.size(); ++i)
+            EXPECT_EQ(Indices16[i], Indices[i]);
+
+        auto LargeIndices  = Indices;
+        LargeIndices[7777] = 65536;
+        EXPECT_FALSE(ConvertIndicesToUint16(LargeIndices.data(), static_cast<Uint32>(LargeIndices.size()), Indices16.data(), pPool, 1000));
+    }
+
+    pThreadPool->StopThreads();
+}
+
+TEST(GeometryPreprocessingTest, WeldVertices)
+{
+    std::vector<float3> GridPositions;
+    std::vector<Uint32> GridIndices;
+    CreateGrid(32, GridPositions, GridIndices);
+
+    // Unweld the grid: every index references its own vertex
+    std::vector<float3> Positions;
+    for (auto Index : GridIndices)
+        Positions.push_back(GridPositions[Index]);
+    const auto NumVertices = static_cast<Uint32>(Positions.size());
+
+    std::vector<Uint32> Indices(NumVertices);
+    for (Uint32 i = 0; i < NumVertices; ++i)
+        Indices[i] = i;
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    for (auto* pPool : {static_cast<IThreadPool*>(nullptr), pThreadPool.RawPtr()})
+    {
+        std::vector<Uint32> Remap(NumVertices);
+        const auto          NumUnique = GenerateVertexWeldRemap(Positions.data(), NumVertices, sizeof(float3), Remap.data(), pPool, 500);
+        EXPECT_EQ(NumUnique, GridPositions.size());
+
+        std::vector<Uint32> WeldedIndices(Indices.size());
+        RemapIndices(Indices.data(), static_cast<Uint32>(Indices.size()), Remap.data(), WeldedIndices.data(), pPool, 500);
+
+        std::vector<float3> WeldedPositions(NumUnique);
+        RemapVertices(Positions.data(), NumVertices, sizeof(float3), Remap.data(), WeldedPositions.data(), pPool, 500);
+
+        for (size_t i = 0; i < Indices.size(); ++i)
+        {
+            ASSERT_LT(WeldedIndices[i], NumUnique);
+            EXPECT_EQ(WeldedPositions[WeldedIndices[i]], Positions[Indices[i]]);
+        }
+    }
+
+    pThreadPool->StopThreads();
+}
+
+TEST(GeometryPreprocessingTest, OptimizeVertexCache)
+{
+    std::vector<float3> Positions;
+    std::vector<Uint32> Indices;
+    CreateGrid(64, Positions, Indices);
+
+    // Chunks of the parallel optimization contain spatially coherent sets of triangles
+    constexpr Uint32 TrianglesPerTask = 2048;
+    ShuffleTriangles(Indices, TrianglesPerTask);
+
+    const auto NumVertices = static_cast<Uint32>(Positions.size());
+    const auto NumIndices  = static_cast<Uint32>(Indices.size());
+    const auto SrcACMR     = ComputeVertexCacheACMR(Indices.data(), NumIndices, NumVertices, 16);
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    for (auto* pPool : {static_cast<IThreadPool*>(nullptr), pThreadPool.RawPtr()})
+    {
+        auto OptimizedIndices = Indices;
+
+        VertexCacheOptimizationAttribs Attribs;
+        Attribs.pIndices         = OptimizedIndices.data();
+        Attribs.NumIndices       = NumIndices;
+        Attribs.NumVertices      = NumVertices;
+        Attribs.pThreadPool      = pPool;
+        Attribs.TrianglesPerTask = TrianglesPerTask;
+        OptimizeVertexCache(Attribs);
+
+        // The triangles must be the same, only the order may change
+        EXPECT_EQ(GetSortedTriangles(OptimizedIndices), GetSortedTriangles(Indices));
+
+        const auto OptimizedACMR = ComputeVertexCacheACMR(OptimizedIndices.data(), NumIndices, NumVertices, 16);
+        EXPECT_LT(OptimizedACMR, 0.8f);
+        EXPECT_LT(OptimizedACMR, SrcACMR * 0.5f);
+
+        // Reorder the vertices for fetch locality
+        std::vector<Uint32> Remap(NumVertices);
+        EXPECT_EQ(GenerateVertexFetchRemap(OptimizedIndices.data(), NumIndices, NumVertices, Remap.data()), NumVertices);
+
+        std::vector<Uint32> FetchIndices(NumIndices);
+        RemapIndices(OptimizedIndices.data(), NumIndices, Remap.data(), FetchIndices.data(), pPool);
+
+        std::vector<float3> FetchPositions(NumVertices);
+        RemapVertices(Positions.data(), NumVertices, sizeof(float3), Remap.data(), FetchPositions.data(), pPool);
+
+        Uint32 NextVertex = 0;
+        for (Uint32 i = 0; i < NumIndices; ++i)
+        {
+            // Vertices are numbered in the order of their first use
+            EXPECT_LE(FetchIndices[i], NextVertex);
+            NextVertex = std::max(NextVertex, FetchIndices[i] + 1);
+            EXPECT_EQ(FetchPositions[FetchIndices[i]], Positions[OptimizedIndices[i]]);
+        }
+    }
+
+    pThreadPool->StopThreads();
+}
+
+TEST(GeometryPreprocessingTest, BoundingBoxes)
+{
+    std::vector<float3> Positions;
+    std::vector<Uint32> Indices;
+    CreateGrid(64, Positions, Indices);
+    Positions[1234].z = -5;
+    Positions[4000].z = 7;
+
+    const auto NumVertices = static_cast<Uint32>(Positions.size());
+    const auto NumTris     = static_cast<Uint32>(Indices.size() / 3);
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    for (auto* pPool : {static_cast<IThreadPool*>(nullptr), pThreadPool.RawPtr()})
+    {
+        const auto Box = ComputeBoundingBox(Positions.data(), NumVertices, sizeof(float3), pPool, 1000);
+        EXPECT_EQ(Box.Min, float3(0, 0, -5));
+        EXPECT_EQ(Box.Max, float3(64, 64, 7));
+
+        std::vector<BoundBox> TriBoxes(NumTris);
+        ComputeTriangleBoundingBoxes(Indices.data(), static_cast<Uint32>(Indices.size()), Positions.data(), sizeof(float3), TriBoxes.data(), pPool, 1000);
+        for (Uint32 t = 0; t < NumTris; ++t)
+        {
+            for (Uint32 i = 0; i < 3; ++i)
+            {
+                const auto& Pos = Positions[Indices[t * 3 + i]];
+                EXPECT_TRUE(Pos.x >= TriBoxes[t].Min.x && Pos.y >= TriBoxes[t].Min.y && Pos.z >= TriBoxes[t].Min.z);
+                EXPECT_TRUE(Pos.x <= TriBoxes[t].Max.x && Pos.y <= TriBoxes[t].Max.y && Pos.z <= TriBoxes[t].Max.z);
+            }
+        }
+    }
+
+    const auto EmptyBox = ComputeBoundingBox(nullptr, 0);
+    EXPECT_GT(EmptyBox.Min.x, EmptyBox.Max.x);
+
+    pThreadPool->StopThreads();
+}
+
+TEST(GeometryPreprocessingTest, InvalidAttribs)
+{
+    Uint32 Indices[3] = {0, 1, 3};
+
+    VertexCacheOptimizationAttribs Attribs;
+    Attribs.pIndices    = Indices;
+    Attribs.NumIndices  = 3;
+    Attribs.NumVertices = 3;
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"is out of range"};
+        EXPECT_THROW(OptimizeVertexCache(Attribs), std::runtime_error);
+    }
+
+    Attribs.NumIndices = 2;
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"must be a multiple of 3"};
+        EXPECT_THROW(OptimizeVertexCache(Attribs), std::runtime_error);
+    }
+
+    Uint32 Remap[3] = {};
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"is out of range"};
+        EXPECT_THROW(GenerateVertexFetchRemap(Indices, 3, 3, Remap), std::runtime_error);
+    }
+}
+
+} // namespace
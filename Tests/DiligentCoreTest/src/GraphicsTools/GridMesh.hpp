@@ -0,0 +1,64 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "BasicMath.hpp"
+
+namespace Diligent
+{
+
+namespace Testing
+{
+
+// Creates a flat grid of GridSize x GridSize quads in the XY plane facing +Z
+inline void CreateGrid(Uint32 GridSize, std::vector<float3>& Positions, std::vector<Uint32>& Indices)
+{
+    for (Uint32 y = 0; y <= GridSize; ++y)
+    {
+        for (Uint32 x = 0; x <= GridSize; ++x)
+            Positions.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.f);
+    }
+
+    for (Uint32 y = 0; y < GridSize; ++y)
+    {
+        for (Uint32 x = 0; x < GridSize; ++x)
+        {
+            const Uint32 v0 = y * (GridSize + 1) + x;
+            const Uint32 v1 = v0 + 1;
+            const Uint32 v2 = v0 + GridSize + 1;
+            const Uint32 v3 = v2 + 1;
+            Indices.insert(Indices.end(), {v0, v1, v2, v2, v1, v3});
+        }
+    }
+}
+
+} // namespace Testing
+
+} // namespace Diligent
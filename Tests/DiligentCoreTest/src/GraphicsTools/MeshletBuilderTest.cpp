@@ -0,0 +1,178 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "MeshletBuilder.hpp"
+
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "GridMesh.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+void VerifyMeshlets(const MeshletBuildAttribs& Attribs, const MeshletData& Data, const std::vector<float3>& Positions)
+{
+    ASSERT_EQ(Data.Meshlets.size(), Data.Bounds.size());
+
+    // The meshlets must reproduce the original triangles in the original order
+    std::vector<Uint32> Indices;
+    Uint32              VertexOffset = 0, PrimitiveOffset = 0;
+    for (size_t m = 0; m < Data.Meshlets.size(); ++m)
+    {
+        const auto& Meshlet = Data.Meshlets[m];
+        EXPECT_EQ(Meshlet.VertexOffset, VertexOffset);
+        EXPECT_EQ(Meshlet.PrimitiveOffset, PrimitiveOffset);
+        EXPECT_GT(Meshlet.PrimitiveCount, 0u);
+        EXPECT_LE(Meshlet.VertexCount, Attribs.MaxVertices);
+        EXPECT_LE(Meshlet.PrimitiveCount, Attribs.MaxPrimitives);
+        VertexOffset += Meshlet.VertexCount;
+        PrimitiveOffset += Meshlet.PrimitiveCount;
+
+        const auto& Sphere = Data.Bounds[m].Sphere;
+        for (Uint32 p = 0; p < Meshlet.PrimitiveCount; ++p)
+        {
+            const Uint32 Prim = Data.PrimitiveIndices[Meshlet.PrimitiveOffset + p];
+            for (Uint32 i = 0; i < 3; ++i)
+            {
+                const Uint32 Local = (Prim >> (i * 8)) & 0xFFu;
+                ASSERT_LT(Local, Meshlet.VertexCount);
+                const Uint32 Index = Data.VertexIndices[Meshlet.VertexOffset + Local];
+                Indices.push_back(Index);
+                EXPECT_LE(length(Positions[Index] - float3{Sphere.x, Sphere.y, Sphere.z}), Sphere.w * 1.0001f);
+            }
+        }
+    }
+    EXPECT_EQ(VertexOffset, Data.VertexIndices.size());
+    EXPECT_EQ(PrimitiveOffset, Data.PrimitiveIndices.size());
+    EXPECT_EQ(Indices, std::vector<Uint32>(Attribs.pIndices, Attribs.pIndices + Attribs.NumIndices));
+}
+
+TEST(MeshletBuilderTest, Grid)
+{
+    std::vector<float3> Positions;
+    std::vector<Uint32> Indices;
+    CreateGrid(32, Positions, Indices);
+
+    MeshletBuildAttribs Attribs;
+    Attribs.pIndices    = Indices.data();
+    Attribs.NumIndices  = static_cast<Uint32>(Indices.size());
+    Attribs.pPositions  = Positions.data();
+    Attribs.NumVertices = static_cast<Uint32>(Positions.size());
+
+    MeshletData Data;
+    BuildMeshlets(Attribs, Data);
+    VerifyMeshlets(Attribs, Data, Positions);
+
+    // 2048 triangles need at least 17 meshlets of 124 triangles
+    EXPECT_GE(Data.Meshlets.size(), size_t{17});
+
+    // All triangles of a flat grid face +Z, so the cone is the +Z axis with zero spread
+    for (const auto& Bounds : Data.Bounds)
+    {
+        EXPECT_NEAR(Bounds.Cone.x, 0.f, 1e-5f);
+        EXPECT_NEAR(Bounds.Cone.y, 0.f, 1e-5f);
+        EXPECT_NEAR(Bounds.Cone.z, 1.f, 1e-5f);
+        EXPECT_NEAR(Bounds.Cone.w, 0.f, 1e-3f);
+    }
+}
+
+TEST(MeshletBuilderTest, SmallMeshlets)
+{
+    std::vector<float3> Positions;
+    std::vector<Uint32> Indices;
+    CreateGrid(8, Positions, Indices);
+
+    MeshletBuildAttribs Attribs;
+    Attribs.pIndices      = Indices.data();
+    Attribs.NumIndices    = static_cast<Uint32>(Indices.size());
+    Attribs.pPositions    = Positions.data();
+    Attribs.NumVertices   = static_cast<Uint32>(Positions.size());
+    Attribs.MaxVertices   = 4;
+    Attribs.MaxPrimitives = 2;
+
+    MeshletData Data;
+    BuildMeshlets(Attribs, Data);
+    VerifyMeshlets(Attribs, Data, Positions);
+
+    // Every quad forms its own meshlet
+    EXPECT_EQ(Data.Meshlets.size(), size_t{64});
+}
+
+TEST(MeshletBuilderTest, Parallel)
+{
+    std::vector<float3> Positions;
+    std::vector<Uint32> Indices;
+    CreateGrid(64, Positions, Indices);
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    MeshletBuildAttribs Attribs;
+    Attribs.pIndices         = Indices.data();
+    Attribs.NumIndices       = static_cast<Uint32>(Indices.size());
+    Attribs.pPositions       = Positions.data();
+    Attribs.NumVertices      = static_cast<Uint32>(Positions.size());
+    Attribs.pThreadPool      = pThreadPool;
+    Attribs.TrianglesPerTask = 1000;
+
+    MeshletData Data;
+    BuildMeshlets(Attribs, Data);
+    VerifyMeshlets(Attribs, Data, Positions);
+
+    pThreadPool->StopThreads();
+}
+
+TEST(MeshletBuilderTest, InvalidAttribs)
+{
+    const float3        Positions[3] = {};
+    const Uint32        Indices[3]   = {0, 1, 3};
+    MeshletBuildAttribs Attribs;
+    Attribs.pIndices    = Indices;
+    Attribs.NumIndices  = 3;
+    Attribs.pPositions  = Positions;
+    Attribs.NumVertices = 3;
+
+    MeshletData Data;
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"is out of range"};
+        EXPECT_THROW(BuildMeshlets(Attribs, Data), std::runtime_error);
+    }
+
+    Attribs.NumIndices = 2;
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"must be a multiple of 3"};
+        EXPECT_THROW(BuildMeshlets(Attribs, Data), std::runtime_error);
+    }
+}
+
+} // namespace
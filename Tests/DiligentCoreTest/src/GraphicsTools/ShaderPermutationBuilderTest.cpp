@@ -0,0 +1,148 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderPermutationBuilder.hpp"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(ShaderPermutationBuilderTest, Enumerate)
+{
+    ShaderPermutationBuilder Builder;
+    EXPECT_EQ(Builder.GetNumPermutations(), 1u);
+
+    Builder.AddMacro("A", {"0", "1"});
+    Builder.AddMacro("B", {1u, 2u, 3u});
+    EXPECT_EQ(Builder.GetNumPermutations(), 6u);
+
+    // The first macro changes fastest
+    {
+        ShaderMacroHelper Macros;
+        Builder.GetPermutationMacros(5, Macros);
+        const ShaderMacro* pMacros = Macros;
+        EXPECT_STREQ(pMacros[0].Name, "A");
+        EXPECT_STREQ(pMacros[0].Definition, "1");
+        EXPECT_STREQ(pMacros[1].Name, "B");
+        EXPECT_STREQ(pMacros[1].Definition, "3u");
+        EXPECT_EQ(pMacros[2].Name, nullptr);
+    }
+
+    {
+        ShaderMacroHelper Macros;
+        Macros.AddShaderMacro("C", true);
+        Builder.GetPermutationMacros(2, Macros);
+        const ShaderMacro* pMacros = Macros;
+        EXPECT_STREQ(pMacros[0].Name, "C");
+        EXPECT_STREQ(pMacros[1].Definition, "0");
+        EXPECT_STREQ(pMacros[2].Definition, "2u");
+    }
+}
+
+TEST(ShaderPermutationBuilderTest, FindUniquePermutations)
+{
+    ShaderPermutationBuilder Builder;
+    Builder.AddMacro("USE_FOG", {false, true});
+    Builder.AddMacro("UNUSED", {"0", "1", "2"});
+    Builder.AddMacro("QUALITY", {"0", "1"});
+
+    const char* Source =
+        "#if USE_FOG\n"
+        "#   define FOG_QUALITY QUALITY\n"
+        "#endif\n"
+        "// UNUSED_IN_COMMENT\n"
+        "void main() {}\n";
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source         = Source;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+
+    const auto Unique = Builder.FindUniquePermutations(ShaderCI);
+    ASSERT_EQ(Unique.size(), 12u);
+    for (Uint32 p = 0; p < 12; ++p)
+    {
+        const Uint32 UseFog  = p % 2;
+        const Uint32 Quality = p / 6;
+        EXPECT_EQ(Unique[p], UseFog + Quality * 6) << p;
+    }
+
+    // Macro referenced by another macro
+    {
+        ShaderPermutationBuilder Builder2;
+        Builder2.AddMacro("A", {"0", "1"});
+        Builder2.AddMacro("B", {"0", "1"});
+
+        ShaderMacro Macros[] = {{"C", "B"}, {nullptr, nullptr}};
+
+        ShaderCreateInfo ShaderCI2;
+        ShaderCI2.Source = "float x = C;";
+        ShaderCI2.Macros = Macros;
+
+        const auto Unique2 = Builder2.FindUniquePermutations(ShaderCI2);
+        ASSERT_EQ(Unique2.size(), 4u);
+        EXPECT_EQ(Unique2[0], 0u);
+        EXPECT_EQ(Unique2[1], 0u);
+        EXPECT_EQ(Unique2[2], 2u);
+        EXPECT_EQ(Unique2[3], 2u);
+    }
+
+    // Token pasting may reference any macro
+    {
+        ShaderPermutationBuilder Builder2;
+        Builder2.AddMacro("MODE_A", {"0", "1"});
+
+        ShaderCreateInfo ShaderCI2;
+        ShaderCI2.Source = "#define CONCAT(x, y) x##y\nint v = CONCAT(MODE, _A);";
+
+        const auto Unique2 = Builder2.FindUniquePermutations(ShaderCI2);
+        ASSERT_EQ(Unique2.size(), 2u);
+        EXPECT_EQ(Unique2[0], 0u);
+        EXPECT_EQ(Unique2[1], 1u);
+    }
+
+    // Equal definitions of a significant macro produce the same source
+    {
+        ShaderPermutationBuilder Builder2;
+        Builder2.AddMacro("A", {"1", "2", "1"});
+
+        ShaderCreateInfo ShaderCI2;
+        ShaderCI2.Source = "int v = A;";
+
+        const auto Unique2 = Builder2.FindUniquePermutations(ShaderCI2);
+        ASSERT_EQ(Unique2.size(), 3u);
+        EXPECT_EQ(Unique2[0], 0u);
+        EXPECT_EQ(Unique2[1], 1u);
+        EXPECT_EQ(Unique2[2], 0u);
+    }
+}
+
+} // namespace
@@ -0,0 +1,227 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderSourceFileCache.hpp"
+
+#include <atomic>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include "DataBlobImpl.hpp"
+#include "MemoryFileStream.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Serves files from memory and counts how many times each file is opened
+class TestSourceFactory final : public ObjectBase<IShaderSourceInputStreamFactory>
+{
+public:
+    using TBase = ObjectBase<IShaderSourceInputStreamFactory>;
+
+    explicit TestSourceFactory(IReferenceCounters* pRefCounters) :
+        TBase{pRefCounters}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, TBase)
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final
+    {
+        CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_NONE, ppStream);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream2(const Char*                             Name,
+                                                       CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
+                                                       IFileStream**                           ppStream) override final
+    {
+        ++NumOpened;
+        *ppStream = nullptr;
+
+        auto it = Files.find(Name);
+        if (it == Files.end())
+            return;
+
+        auto pStream = MemoryFileStream::Create(DataBlobImpl::Create(it->second.length(), it->second.c_str()));
+        pStream->QueryInterface(IID_FileStream, reinterpret_cast<IObject**>(ppStream));
+    }
+
+    std::map<std::string, std::string> Files;
+    std::atomic<int>                   NumOpened{0};
+};
+
+RefCntAutoPtr<TestSourceFactory> CreateTestSourceFactory()
+{
+    RefCntAutoPtr<TestSourceFactory> pFactory{MakeNewRCObj<TestSourceFactory>()()};
+    pFactory->Files["Main.hlsl"]   = "#include \"Common.fxh\"\nvoid main() {}\n";
+    pFactory->Files["Common.fxh"]  = "#include \"Defines.fxh\"\nfloat4 Color;\n";
+    pFactory->Files["Defines.fxh"] = "#define VALUE 1\n";
+    return pFactory;
+}
+
+std::string ReadFile(IShaderSourceInputStreamFactory* pFactory, const char* Name)
+{
+    RefCntAutoPtr<IFileStream> pStream;
+    pFactory->CreateInputStream(Name, &pStream);
+    if (!pStream)
+        return "";
+
+    auto pData = DataBlobImpl::Create();
+    pStream->ReadBlob(pData);
+    return std::string{static_cast<const char*>(pData->GetConstDataPtr()), pData->GetSize()};
+}
+
+TEST(ShaderSourceFileCacheTest, LoadOnce)
+{
+    auto pFactory = CreateTestSourceFactory();
+
+    ShaderSourceFileCache::CreateInfo CacheCI;
+    CacheCI.pFactory = pFactory;
+    auto pCache      = ShaderSourceFileCache::Create(CacheCI);
+    ASSERT_NE(pCache, nullptr);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(ReadFile(pCache, "Common.fxh"), pFactory->Files["Common.fxh"]);
+        EXPECT_EQ(ReadFile(pCache, "Defines.fxh"), pFactory->Files["Defines.fxh"]);
+    }
+    EXPECT_EQ(pFactory->NumOpened, 2);
+
+    RefCntAutoPtr<IFileStream> pStream;
+    pCache->CreateInputStream2("Missing.fxh", CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pStream);
+    EXPECT_EQ(pStream, nullptr);
+
+    XXH128Hash Hash;
+    EXPECT_TRUE(pCache->GetFileHash("Common.fxh", Hash));
+    EXPECT_FALSE(pCache->GetFileHash("Missing.fxh", Hash));
+
+    pCache->InvalidateFile("Common.fxh");
+    EXPECT_FALSE(pCache->GetFileHash("Common.fxh", Hash));
+    EXPECT_EQ(ReadFile(pCache, "Common.fxh"), pFactory->Files["Common.fxh"]);
+    EXPECT_EQ(pFactory->NumOpened, 4);
+}
+
+TEST(ShaderSourceFileCacheTest, Timestamp)
+{
+    auto pFactory = CreateTestSourceFactory();
+
+    std::atomic<Uint64> Timestamp{1};
+
+    ShaderSourceFileCache::CreateInfo CacheCI;
+    CacheCI.pFactory         = pFactory;
+    CacheCI.GetFileTimestamp = [&](const Char* Name) -> Uint64 {
+        return Timestamp;
+    };
+    auto pCache = ShaderSourceFileCache::Create(CacheCI);
+    ASSERT_NE(pCache, nullptr);
+
+    EXPECT_EQ(ReadFile(pCache, "Defines.fxh"), "#define VALUE 1\n");
+    XXH128Hash Hash0;
+    EXPECT_TRUE(pCache->GetFileHash("Defines.fxh", Hash0));
+
+    pFactory->Files["Defines.fxh"] = "#define VALUE 2\n";
+    EXPECT_EQ(ReadFile(pCache, "Defines.fxh"), "#define VALUE 1\n");
+    EXPECT_EQ(pFactory->NumOpened, 1);
+
+    Timestamp = 2;
+    EXPECT_EQ(ReadFile(pCache, "Defines.fxh"), "#define VALUE 2\n");
+    EXPECT_EQ(pFactory->NumOpened, 2);
+
+    XXH128Hash Hash1;
+    EXPECT_TRUE(pCache->GetFileHash("Defines.fxh", Hash1));
+    EXPECT_FALSE(Hash0 == Hash1);
+}
+
+TEST(ShaderSourceFileCacheTest, ShaderHash)
+{
+    auto pFactory = CreateTestSourceFactory();
+
+    Uint64 Timestamp = 1;
+
+    ShaderSourceFileCache::CreateInfo CacheCI;
+    CacheCI.pFactory         = pFactory;
+    CacheCI.GetFileTimestamp = [&](const Char* Name) {
+        return Timestamp;
+    };
+    auto pCache = ShaderSourceFileCache::Create(CacheCI);
+    ASSERT_NE(pCache, nullptr);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.FilePath                   = "Main.hlsl";
+    ShaderCI.pShaderSourceStreamFactory = pCache;
+
+    auto ComputeHash = [&]() {
+        XXH128State Hasher;
+        Hasher.Update(ShaderCI);
+        return Hasher.Digest();
+    };
+
+    const auto Hash0 = ComputeHash();
+    EXPECT_EQ(pFactory->NumOpened, 3);
+    EXPECT_EQ(ComputeHash(), Hash0);
+    EXPECT_EQ(pFactory->NumOpened, 3);
+
+    pFactory->Files["Defines.fxh"] = "#define VALUE 2\n";
+    Timestamp                      = 2;
+    EXPECT_FALSE(ComputeHash() == Hash0);
+}
+
+TEST(ShaderSourceFileCacheTest, Multithreading)
+{
+    auto pFactory = CreateTestSourceFactory();
+
+    ShaderSourceFileCache::CreateInfo CacheCI;
+    CacheCI.pFactory = pFactory;
+    auto pCache      = ShaderSourceFileCache::Create(CacheCI);
+    ASSERT_NE(pCache, nullptr);
+
+    std::atomic<int>         NumErrors{0};
+    std::vector<std::thread> Threads(4);
+    for (auto& Thread : Threads)
+    {
+        Thread = std::thread{[&]() {
+            for (int i = 0; i < 100; ++i)
+            {
+                for (const auto& File : pFactory->Files)
+                {
+                    if (ReadFile(pCache, File.first.c_str()) != File.second)
+                        ++NumErrors;
+                }
+            }
+        }};
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(NumErrors, 0);
+}
+
+} // namespace
@@ -25,6 +25,7 @@
  */
 
 #include "XXH128Hasher.hpp"
+#include "ObjectBase.hpp"
 #include "gtest/gtest.h"
 #include <memory>
 #include <unordered_set>
@@ -76,4 +77,54 @@ TEST(XXH128HasherTest, Struct)
     EXPECT_EQ(Hasher1.Digest(), Hasher2.Digest());
 }
 
+class TestRenderPass final : public ObjectBase<IRenderPass>
+{
+public:
+    using TBase = ObjectBase<IRenderPass>;
+
+    TestRenderPass(IReferenceCounters* pRefCounters, const RenderPassDesc& Desc) :
+        TBase{pRefCounters},
+        m_Desc{Desc}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_RenderPass, TBase)
+
+    virtual const RenderPassDesc& DILIGENT_CALL_TYPE GetDesc() const override final { return m_Desc; }
+    virtual Int32 DILIGENT_CALL_TYPE                 GetUniqueID() const override final { return 1; }
+    virtual void DILIGENT_CALL_TYPE                  SetUserData(IObject* pUserData) override final {}
+    virtual IObject* DILIGENT_CALL_TYPE              GetUserData() const override final { return nullptr; }
+
+private:
+    RenderPassDesc m_Desc;
+};
+
+TEST(XXH128HasherTest, DigestCache)
+{
+    SubpassDesc Subpass;
+
+    RenderPassDesc RPDesc;
+    RPDesc.SubpassCount = 1;
+    RPDesc.pSubpasses   = &Subpass;
+
+    RefCntAutoPtr<IRenderPass> pRenderPass{MakeNewRCObj<TestRenderPass>()(RPDesc)};
+
+    XXH128DigestCache DigestCache;
+
+    XXH128State Hasher1;
+    Hasher1.UpdateObject(pRenderPass.RawPtr<const IRenderPass>());
+    XXH128State Hasher2{&DigestCache};
+    Hasher2.UpdateObject(pRenderPass.RawPtr<const IRenderPass>());
+    EXPECT_EQ(Hasher1.Digest(), Hasher2.Digest());
+    EXPECT_EQ(DigestCache.GetSize(), size_t{1});
+
+    // The cached digest is reused
+    XXH128State Hasher3{&DigestCache};
+    Hasher3.UpdateObject(pRenderPass.RawPtr<const IRenderPass>());
+    EXPECT_EQ(Hasher1.Digest(), Hasher3.Digest());
+    EXPECT_EQ(DigestCache.GetSize(), size_t{1});
+
+    DigestCache.Invalidate(pRenderPass);
+    EXPECT_EQ(DigestCache.GetSize(), size_t{0});
+}
+
 } // namespace
@@ -28,14 +28,17 @@
 
 #include <vector>
 #include <unordered_set>
+#include <cstring>
 
 #include "gtest/gtest.h"
 
 #include "DebugUtilities.hpp"
 #include "TempDirectory.hpp"
+#include "TestingEnvironment.hpp"
 #include "FileWrapper.hpp"
 #include "FastRand.hpp"
 #include "DataBlobImpl.hpp"
+#include "MemoryMappedFileDataBlob.hpp"
 
 using namespace Diligent;
 using namespace Diligent::Testing;
@@ -457,6 +460,82 @@ TEST(Platforms_FileSystem, File)
     EXPECT_FALSE(FileSystem::FileExists(FilePath.c_str()));
 }
 
+TEST(Platforms_FileSystem, MemoryMappedFile)
+{
+    TempDirectory TmpDir;
+    const auto&   TmpDirPath = TmpDir.Get();
+    ASSERT_TRUE(FileSystem::PathExists(TmpDirPath.c_str()));
+
+    std::vector<Int32> Data(4096);
+
+    FastRandInt rnd{1, 0, static_cast<Int32>(FastRand::Max - 1)};
+    for (auto& Elem : Data)
+        Elem = rnd();
+    const auto FilePath = TmpDirPath + FileSystem::SlashSymbol + "MappedFile.ext";
+
+    {
+        FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        EXPECT_TRUE(File->Write(Data.data(), Data.size() * sizeof(Data[0])));
+    }
+
+    {
+        auto pDataBlob = MemoryMappedFileDataBlob::Create(FilePath.c_str());
+        ASSERT_TRUE(pDataBlob);
+        ASSERT_EQ(pDataBlob->GetSize(), Data.size() * sizeof(Data[0]));
+        ASSERT_NE(pDataBlob->GetConstDataPtr(), nullptr);
+        EXPECT_EQ(std::memcmp(pDataBlob->GetConstDataPtr(), Data.data(), pDataBlob->GetSize()), 0);
+
+        // Writing to the mapped data must not modify the file
+        static_cast<Int32*>(pDataBlob->GetDataPtr())[0] = ~Data[0];
+    }
+
+    {
+        auto pDataBlob0 = MemoryMappedFileDataBlob::Create(FilePath.c_str(), /*ReadOnly = */ true);
+        auto pDataBlob1 = MemoryMappedFileDataBlob::Create(FilePath.c_str(), /*ReadOnly = */ true);
+        ASSERT_TRUE(pDataBlob0);
+        ASSERT_TRUE(pDataBlob1);
+        EXPECT_TRUE(pDataBlob0->IsReadOnly());
+        ASSERT_EQ(pDataBlob0->GetSize(), Data.size() * sizeof(Data[0]));
+        ASSERT_EQ(pDataBlob1->GetSize(), Data.size() * sizeof(Data[0]));
+        EXPECT_EQ(std::memcmp(pDataBlob0->GetConstDataPtr(), Data.data(), pDataBlob0->GetSize()), 0);
+        EXPECT_EQ(std::memcmp(pDataBlob1->GetConstDataPtr(), Data.data(), pDataBlob1->GetSize()), 0);
+    }
+
+    {
+        FileWrapper File{FilePath.c_str(), EFileAccessMode::Read};
+        ASSERT_TRUE(File);
+        std::vector<Int32> InData(Data.size());
+        EXPECT_TRUE(File->Read(InData.data(), InData.size() * sizeof(InData[0])));
+        EXPECT_EQ(InData, Data);
+    }
+
+    const auto EmptyFilePath = TmpDirPath + FileSystem::SlashSymbol + "EmptyFile.ext";
+    {
+        FileWrapper File{EmptyFilePath.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+    }
+    {
+        auto pDataBlob = MemoryMappedFileDataBlob::Create(EmptyFilePath.c_str());
+        ASSERT_TRUE(pDataBlob);
+        EXPECT_EQ(pDataBlob->GetSize(), size_t{0});
+
+        auto pReadOnlyBlob = MemoryMappedFileDataBlob::Create(EmptyFilePath.c_str(), /*ReadOnly = */ true);
+        ASSERT_TRUE(pReadOnlyBlob);
+        EXPECT_EQ(pReadOnlyBlob->GetSize(), size_t{0});
+    }
+
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"Failed to open file"};
+
+        const auto MissingFilePath = TmpDirPath + FileSystem::SlashSymbol + "MissingFile.ext";
+        EXPECT_FALSE(MemoryMappedFileDataBlob::Create(MissingFilePath.c_str()));
+    }
+
+    FileSystem::DeleteFile(FilePath.c_str());
+    FileSystem::DeleteFile(EmptyFilePath.c_str());
+}
+
 TEST(Platforms_FileSystem, Directories)
 {
     TempDirectory TmpDir;
@@ -27,6 +27,8 @@
 
 #include "PlatformMisc.hpp"
 
+#include <vector>
+
 #include "gtest/gtest.h"
 
 using namespace Diligent;
@@ -114,4 +116,85 @@ TEST(Platforms_PlatformMisc, SwapBytes)
     EXPECT_EQ(PlatformMisc::SwapBytes(fswap), f);
 }
 
+
+TEST(Platforms_PlatformMisc, GetCPUTopology)
+{
+    const auto& Topology = PlatformMisc::GetCPUTopology();
+    EXPECT_EQ(&Topology, &PlatformMisc::GetCPUTopology());
+
+    ASSERT_FALSE(Topology.LogicalProcessors.empty());
+    EXPECT_GT(Topology.NumCores, 0u);
+    EXPECT_LE(Topology.NumCores, Topology.LogicalProcessors.size());
+    EXPECT_GT(Topology.NumNUMANodes, 0u);
+
+    std::vector<bool> CoreFound(Topology.NumCores);
+    for (size_t i = 0; i < Topology.LogicalProcessors.size(); ++i)
+    {
+        const auto& Processor = Topology.LogicalProcessors[i];
+        if (i > 0)
+        {
+            EXPECT_GT(Processor.Index, Topology.LogicalProcessors[i - 1].Index);
+        }
+        ASSERT_LT(Processor.Core, Topology.NumCores);
+        EXPECT_LT(Processor.NUMANode, Topology.NumNUMANodes);
+        CoreFound[Processor.Core] = true;
+
+        // SMT siblings share the core type
+        for (const auto& Sibling : Topology.LogicalProcessors)
+        {
+            if (Sibling.Core == Processor.Core)
+            {
+                EXPECT_EQ(Sibling.CoreType, Processor.CoreType);
+            }
+        }
+    }
+    for (size_t i = 0; i < CoreFound.size(); ++i)
+    {
+        EXPECT_TRUE(CoreFound[i]) << "Core " << i << " has no logical processors";
+    }
+
+    const auto PerformanceMask = Topology.GetAffinityMask(CPU_CORE_TYPE_PERFORMANCE);
+    const auto EfficiencyMask  = Topology.GetAffinityMask(CPU_CORE_TYPE_EFFICIENCY);
+    EXPECT_NE(PerformanceMask, Uint64{0});
+    EXPECT_EQ(PerformanceMask & EfficiencyMask, Uint64{0});
+    EXPECT_EQ(Topology.IsHybrid(), EfficiencyMask != 0);
+
+    Uint64 NUMAMask = 0;
+    for (Uint32 Node = 0; Node < Topology.NumNUMANodes; ++Node)
+    {
+        const auto NodeMask = Topology.GetNUMANodeAffinityMask(Node);
+        EXPECT_EQ(NUMAMask & NodeMask, Uint64{0});
+        NUMAMask |= NodeMask;
+    }
+    EXPECT_EQ(NUMAMask, PerformanceMask | EfficiencyMask);
+
+    const auto PrimaryProcessors = Topology.GetPrimaryLogicalProcessors();
+    EXPECT_EQ(PrimaryProcessors.size(), Topology.NumCores);
+}
+
+TEST(Platforms_PlatformMisc, GetCPUFeatures)
+{
+    const auto Features = PlatformMisc::GetCPUFeatures();
+    EXPECT_EQ(Features, PlatformMisc::GetCPUFeatures());
+    EXPECT_TRUE(PlatformMisc::CheckCPUFeatures(CPU_FEATURE_FLAG_NONE));
+    EXPECT_TRUE(PlatformMisc::CheckCPUFeatures(Features));
+
+    // Every extension implies the ones it is built on
+    if (Features & CPU_FEATURE_FLAG_AVX2)
+    {
+        EXPECT_TRUE(PlatformMisc::CheckCPUFeatures(CPU_FEATURE_FLAG_AVX));
+    }
+    if (Features & CPU_FEATURE_FLAG_AVX)
+    {
+        EXPECT_TRUE(PlatformMisc::CheckCPUFeatures(CPU_FEATURE_FLAG_SSE41 | CPU_FEATURE_FLAG_SSE2));
+    }
+
+#if defined(__x86_64__) || defined(_M_X64)
+    EXPECT_TRUE(PlatformMisc::CheckCPUFeatures(CPU_FEATURE_FLAG_SSE2));
+#endif
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+    EXPECT_TRUE(PlatformMisc::CheckCPUFeatures(CPU_FEATURE_FLAG_NEON));
+#endif
+}
+
 } // namespace
@@ -0,0 +1,590 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "SPIRVShaderResources.hpp"
+#include "GLSLangUtils.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "EngineMemory.h"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class SPIRVShaderResourcesTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        GLSLangUtils::InitializeGlslang();
+    }
+
+    static void TearDownTestSuite()
+    {
+        GLSLangUtils::FinalizeGlslang();
+    }
+};
+
+std::vector<uint32_t> CompileGLSL(SHADER_TYPE ShaderType, const char* Source, GLSLangUtils::SpirvVersion Version = GLSLangUtils::SpirvVersion::Vk100)
+{
+    GLSLangUtils::GLSLtoSPIRVAttribs Attribs;
+    Attribs.ShaderType     = ShaderType;
+    Attribs.ShaderSource   = Source;
+    Attribs.SourceCodeLen  = static_cast<int>(strlen(Source));
+    Attribs.Version        = Version;
+    Attribs.AssignBindings = false;
+    return GLSLangUtils::GLSLtoSPIRV(Attribs);
+}
+
+std::vector<uint32_t> CompileHLSL(SHADER_TYPE ShaderType, const char* Source)
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source          = Source;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.EntryPoint      = "main";
+    ShaderCI.Desc.ShaderType = ShaderType;
+    ShaderCI.Desc.Name       = "SPIRVShaderResourcesTest";
+    return GLSLangUtils::HLSLtoSPIRV(ShaderCI, GLSLangUtils::SpirvVersion::Vk100, nullptr, nullptr);
+}
+
+struct SPIRVShaderResourcesDeleter
+{
+    void operator()(SPIRVShaderResources* pResources) const
+    {
+        pResources->~SPIRVShaderResources();
+        DefaultRawMemoryAllocator::GetAllocator().Free(pResources);
+    }
+};
+
+using SPIRVShaderResourcesPtr = std::unique_ptr<SPIRVShaderResources, SPIRVShaderResourcesDeleter>;
+
+SPIRVShaderResourcesPtr CreateResources(const std::vector<uint32_t>& SPIRV,
+                                        SHADER_TYPE                  ShaderType,
+                                        const char*                  CombinedSamplerSuffix,
+                                        bool                         LoadShaderStageInputs,
+                                        bool                         ForceSPIRVCross,
+                                        std::string&                 EntryPoint)
+{
+    ShaderDesc Desc;
+    Desc.Name       = "SPIRVShaderResourcesTest";
+    Desc.ShaderType = ShaderType;
+
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    auto* pRawMem   = ALLOCATE(Allocator, "Memory for SPIRVShaderResources", SPIRVShaderResources, 1);
+    return SPIRVShaderResourcesPtr{
+        new (pRawMem) SPIRVShaderResources //
+        {
+            Allocator,
+            SPIRV,
+            Desc,
+            CombinedSamplerSuffix,
+            LoadShaderStageInputs,
+            false, // LoadUniformBufferReflection
+            EntryPoint,
+            ForceSPIRVCross //
+        }                   //
+    };
+}
+
+// Loads resources through both the binary scanner and SPIRV-Cross and checks that the results are identical.
+// Returns the resources loaded without forcing SPIRV-Cross.
+SPIRVShaderResourcesPtr TestResources(const std::vector<uint32_t>& SPIRV,
+                                      SHADER_TYPE                  ShaderType,
+                                      bool                         ExpectLoadedFromBinary,
+                                      const char*                  CombinedSamplerSuffix = nullptr,
+                                      bool                         LoadShaderStageInputs = false)
+{
+    std::string RefEntryPoint;
+    std::string EntryPoint;
+
+    auto pRefResources = CreateResources(SPIRV, ShaderType, CombinedSamplerSuffix, LoadShaderStageInputs, true, RefEntryPoint);
+    auto pResources    = CreateResources(SPIRV, ShaderType, CombinedSamplerSuffix, LoadShaderStageInputs, false, EntryPoint);
+
+    const auto& Ref = *pRefResources;
+    const auto& Res = *pResources;
+    EXPECT_FALSE(Ref.IsLoadedFromBinary());
+    EXPECT_EQ(Res.IsLoadedFromBinary(), ExpectLoadedFromBinary);
+
+    EXPECT_EQ(EntryPoint, RefEntryPoint);
+    EXPECT_EQ(Res.GetShaderType(), Ref.GetShaderType());
+    EXPECT_EQ(Res.IsHLSLSource(), Ref.IsHLSLSource());
+    EXPECT_EQ(Res.GetComputeGroupSize(), Ref.GetComputeGroupSize());
+    EXPECT_STREQ(Res.GetShaderName(), Ref.GetShaderName());
+    EXPECT_STREQ(Res.GetCombinedSamplerSuffix(), Ref.GetCombinedSamplerSuffix());
+
+    EXPECT_EQ(Res.GetNumUBs(), Ref.GetNumUBs());
+    EXPECT_EQ(Res.GetNumSBs(), Ref.GetNumSBs());
+    EXPECT_EQ(Res.GetNumImgs(), Ref.GetNumImgs());
+    EXPECT_EQ(Res.GetNumSmpldImgs(), Ref.GetNumSmpldImgs());
+    EXPECT_EQ(Res.GetNumACs(), Ref.GetNumACs());
+    EXPECT_EQ(Res.GetNumSepSmplrs(), Ref.GetNumSepSmplrs());
+    EXPECT_EQ(Res.GetNumSepImgs(), Ref.GetNumSepImgs());
+    EXPECT_EQ(Res.GetNumInptAtts(), Ref.GetNumInptAtts());
+    EXPECT_EQ(Res.GetNumAccelStructs(), Ref.GetNumAccelStructs());
+    EXPECT_EQ(Res.GetTotalResources(), Ref.GetTotalResources());
+    if (Res.GetTotalResources() == Ref.GetTotalResources())
+    {
+        for (Uint32 i = 0; i < Res.GetTotalResources(); ++i)
+        {
+            const auto& RefAttribs = Ref.GetResource(i);
+            const auto& Attribs    = Res.GetResource(i);
+            EXPECT_STREQ(Attribs.Name, RefAttribs.Name) << "Resource " << i;
+            EXPECT_EQ(Attribs.ArraySize, RefAttribs.ArraySize) << RefAttribs.Name;
+            EXPECT_EQ(Attribs.Type, RefAttribs.Type) << RefAttribs.Name;
+            EXPECT_EQ(Attribs.GetResourceDimension(), RefAttribs.GetResourceDimension()) << RefAttribs.Name;
+            EXPECT_EQ(Attribs.IsMultisample(), RefAttribs.IsMultisample()) << RefAttribs.Name;
+            EXPECT_EQ(Attribs.BindingDecorationOffset, RefAttribs.BindingDecorationOffset) << RefAttribs.Name;
+            EXPECT_EQ(Attribs.DescriptorSetDecorationOffset, RefAttribs.DescriptorSetDecorationOffset) << RefAttribs.Name;
+            EXPECT_EQ(Attribs.BufferStaticSize, RefAttribs.BufferStaticSize) << RefAttribs.Name;
+            EXPECT_EQ(Attribs.BufferStride, RefAttribs.BufferStride) << RefAttribs.Name;
+        }
+    }
+
+    EXPECT_EQ(Res.GetNumShaderStageInputs(), Ref.GetNumShaderStageInputs());
+    if (Res.GetNumShaderStageInputs() == Ref.GetNumShaderStageInputs())
+    {
+        for (Uint32 i = 0; i < Res.GetNumShaderStageInputs(); ++i)
+        {
+            const auto& RefInput = Ref.GetShaderStageInputAttribs(i);
+            const auto& Input    = Res.GetShaderStageInputAttribs(i);
+            EXPECT_STREQ(Input.Semantic, RefInput.Semantic) << "Input " << i;
+            EXPECT_EQ(Input.LocationDecorationOffset, RefInput.LocationDecorationOffset) << "Input " << i;
+        }
+    }
+
+    return pResources;
+}
+
+TEST_F(SPIRVShaderResourcesTest, Buffers)
+{
+    static constexpr char Source[] = R"(
+#version 450
+
+layout(local_size_x = 8, local_size_y = 4, local_size_z = 1) in;
+
+layout(std140, set = 0, binding = 0) uniform CBuffer
+{
+    mat4 g_WorldViewProj;
+    vec4 g_Color;
+    layout(row_major) mat3x4 g_RowMajor;
+    float g_Floats[3];
+} g_CB;
+
+layout(std140, set = 1, binding = 1) uniform ArrCBuffer
+{
+    vec4 Data;
+} g_ArrCB[2];
+
+struct Item
+{
+    vec4 Pos;
+    mat2 Rot;
+};
+
+layout(std430, binding = 2) readonly buffer ROBuffer
+{
+    Item g_Items[];
+} g_ROBuff;
+
+layout(std430, binding = 3) buffer RWBuffer
+{
+    uvec4 g_Header;
+    float g_Data[];
+} g_RWBuff;
+
+layout(std430, binding = 4) buffer FixedBuffer
+{
+    layout(row_major) mat3 g_Mats[4];
+    vec2 g_Tail;
+} g_FixedBuff;
+
+layout(std430, binding = 5) buffer RWBufferArr
+{
+    vec4 g_Vals[];
+} g_RWBuffArr[3];
+
+void main()
+{
+    g_RWBuff.g_Data[gl_GlobalInvocationID.x] = g_CB.g_Color.x + g_ROBuff.g_Items[0].Pos.y;
+}
+)";
+
+    const auto SPIRV = CompileGLSL(SHADER_TYPE_COMPUTE, Source);
+    ASSERT_FALSE(SPIRV.empty());
+    const auto pResources = TestResources(SPIRV, SHADER_TYPE_COMPUTE, true);
+    EXPECT_EQ(pResources->GetNumUBs(), 2u);
+    EXPECT_EQ(pResources->GetNumSBs(), 4u);
+    EXPECT_EQ(pResources->GetComputeGroupSize(), (std::array<Uint32, 3>{8, 4, 1}));
+}
+
+TEST_F(SPIRVShaderResourcesTest, Textures)
+{
+    static constexpr char Source[] = R"(
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(binding = 0) uniform sampler2D      g_Tex2D;
+layout(binding = 1) uniform sampler2DArray g_Tex2DArr[2];
+layout(binding = 2) uniform sampler2DMS    g_TexMS;
+layout(binding = 3) uniform samplerCube    g_TexCube;
+
+layout(binding = 4) uniform texture2D   g_SepTex;
+layout(binding = 5) uniform texture3D   g_SepTex3D[4];
+layout(binding = 6) uniform textureCube g_SepTexCube;
+layout(binding = 7) uniform texture2D   g_RuntimeArr[];
+
+layout(binding = 8) uniform sampler g_Sampler;
+layout(binding = 9) uniform sampler g_Samplers[2];
+
+layout(binding = 10, rgba8) uniform readonly image2D g_RWTex;
+layout(binding = 11, r32f)  uniform image2DArray     g_RWTexArr[3];
+
+layout(binding = 12) uniform samplerBuffer g_TexelBuff;
+layout(binding = 13) uniform textureBuffer g_SepTexelBuff;
+layout(binding = 14, r32ui) uniform uimageBuffer g_RWTexelBuff;
+
+layout(input_attachment_index = 0, binding = 15) uniform subpassInput g_Subpass;
+
+layout(location = 0) in vec2 in_UV;
+layout(location = 0) out vec4 out_Color;
+
+void main()
+{
+    out_Color = texture(g_Tex2D, in_UV) + texture(sampler2D(g_SepTex, g_Sampler), in_UV) + subpassLoad(g_Subpass);
+    out_Color += texture(sampler2D(g_RuntimeArr[nonuniformEXT(int(in_UV.x))], g_Sampler), in_UV);
+}
+)";
+
+    const auto SPIRV = CompileGLSL(SHADER_TYPE_PIXEL, Source);
+    ASSERT_FALSE(SPIRV.empty());
+    const auto pResources = TestResources(SPIRV, SHADER_TYPE_PIXEL, true);
+    EXPECT_EQ(pResources->GetNumSmpldImgs(), 5u);
+    EXPECT_EQ(pResources->GetNumSepImgs(), 5u);
+    EXPECT_EQ(pResources->GetNumSepSmplrs(), 2u);
+    EXPECT_EQ(pResources->GetNumImgs(), 3u);
+    EXPECT_EQ(pResources->GetNumInptAtts(), 1u);
+}
+
+TEST_F(SPIRVShaderResourcesTest, CombinedSamplerSuffix)
+{
+    static constexpr char Source[] = R"(
+#version 450
+
+layout(binding = 0) uniform texture2D g_Tex;
+layout(binding = 1) uniform sampler   g_Tex_sampler;
+
+layout(location = 0) out vec4 out_Color;
+
+void main()
+{
+    out_Color = texture(sampler2D(g_Tex, g_Tex_sampler), vec2(0.5, 0.5));
+}
+)";
+
+    const auto SPIRV = CompileGLSL(SHADER_TYPE_PIXEL, Source);
+    ASSERT_FALSE(SPIRV.empty());
+    TestResources(SPIRV, SHADER_TYPE_PIXEL, true, "_sampler");
+}
+
+TEST_F(SPIRVShaderResourcesTest, AccelerationStructures)
+{
+    static constexpr char Source[] = R"(
+#version 460
+#extension GL_EXT_ray_tracing : require
+
+layout(set = 0, binding = 0) uniform accelerationStructureEXT g_TLAS;
+layout(set = 0, binding = 1) uniform accelerationStructureEXT g_TLASArr[2];
+layout(set = 1, binding = 0, rgba8) uniform image2D g_Output;
+
+layout(location = 0) rayPayloadEXT vec4 g_Payload;
+
+void main()
+{
+    traceRayEXT(g_TLAS, gl_RayFlagsNoneEXT, 0xFF, 0, 1, 0, vec3(0.0), 0.01, vec3(0.0, 0.0, 1.0), 100.0, 0);
+    imageStore(g_Output, ivec2(gl_LaunchIDEXT.xy), g_Payload);
+}
+)";
+
+    const auto SPIRV = CompileGLSL(SHADER_TYPE_RAY_GEN, Source, GLSLangUtils::SpirvVersion::Vk120);
+    ASSERT_FALSE(SPIRV.empty());
+    const auto pResources = TestResources(SPIRV, SHADER_TYPE_RAY_GEN, true);
+    EXPECT_EQ(pResources->GetNumAccelStructs(), 2u);
+    EXPECT_EQ(pResources->GetNumImgs(), 1u);
+}
+
+TEST_F(SPIRVShaderResourcesTest, HLSLVertexShader)
+{
+    static constexpr char Source[] = R"(
+cbuffer Constants
+{
+    float4x4 g_WorldViewProj;
+    float4   g_Color;
+};
+
+Texture2D    g_Texture;
+SamplerState g_Texture_sampler;
+
+struct VSInput
+{
+    float3 Pos   : ATTRIB0;
+    float2 UV    : ATTRIB1;
+    float4 Color : COLOR;
+};
+
+struct PSInput
+{
+    float4 Pos   : SV_POSITION;
+    float4 Color : COLOR0;
+};
+
+void main(in VSInput VSIn, out PSInput PSIn)
+{
+    PSIn.Pos   = mul(float4(VSIn.Pos, 1.0), g_WorldViewProj);
+    PSIn.Color = VSIn.Color * g_Color * g_Texture.SampleLevel(g_Texture_sampler, VSIn.UV, 0.0);
+}
+)";
+
+    const auto SPIRV = CompileHLSL(SHADER_TYPE_VERTEX, Source);
+    ASSERT_FALSE(SPIRV.empty());
+    const auto pResources = TestResources(SPIRV, SHADER_TYPE_VERTEX, true, "_sampler", true);
+    EXPECT_TRUE(pResources->IsHLSLSource());
+    EXPECT_EQ(pResources->GetNumUBs(), 1u);
+    EXPECT_EQ(pResources->GetNumShaderStageInputs(), 3u);
+}
+
+TEST_F(SPIRVShaderResourcesTest, HLSLPixelShader)
+{
+    static constexpr char Source[] = R"(
+struct BufferData
+{
+    float4   Data;
+    float4x4 Transform;
+};
+
+StructuredBuffer<BufferData>   g_ROBuffer;
+RWStructuredBuffer<BufferData> g_RWBuffer;
+ByteAddressBuffer              g_RawBuffer;
+Buffer<float4>                 g_TexelBuffer;
+RWBuffer<float4>               g_RWTexelBuffer;
+RWTexture2D<float4>            g_RWTex;
+Texture2DArray<float4>         g_TexArr[2];
+Texture2DMS<float4>            g_TexMS;
+SamplerState                   g_Sampler;
+
+float4 main(in float4 Pos : SV_Position) : SV_Target
+{
+    uint2 UV = uint2(Pos.xy);
+    g_RWBuffer[UV.x].Data = g_ROBuffer[UV.y].Data;
+    g_RWTexelBuffer[UV.x] = g_TexelBuffer.Load(UV.y);
+    g_RWTex[UV]           = g_TexMS.Load(UV, 0);
+    return mul(g_ROBuffer[0].Transform, g_TexArr[1].Sample(g_Sampler, float3(Pos.xy, 0.0))) + asfloat(g_RawBuffer.Load(0));
+}
+)";
+
+    const auto SPIRV = CompileHLSL(SHADER_TYPE_PIXEL, Source);
+    ASSERT_FALSE(SPIRV.empty());
+    const auto pResources = TestResources(SPIRV, SHADER_TYPE_PIXEL, true);
+    EXPECT_TRUE(pResources->IsHLSLSource());
+    EXPECT_EQ(pResources->GetNumSBs(), 3u);
+}
+
+TEST_F(SPIRVShaderResourcesTest, WorkgroupSizeBuiltIn)
+{
+    // Specialization constant work group size produces the WorkgroupSize built-in,
+    // which the binary scanner does not handle.
+    static constexpr char Source[] = R"(
+#version 450
+
+layout(local_size_x_id = 0, local_size_y = 4, local_size_z = 1) in;
+
+layout(std430, binding = 0) buffer RWBuffer
+{
+    uint g_Data[];
+} g_RWBuff;
+
+void main()
+{
+    g_RWBuff.g_Data[gl_GlobalInvocationID.x] = gl_WorkGroupSize.x;
+}
+)";
+
+    const auto SPIRV = CompileGLSL(SHADER_TYPE_COMPUTE, Source);
+    ASSERT_FALSE(SPIRV.empty());
+    const auto pResources = TestResources(SPIRV, SHADER_TYPE_COMPUTE, false);
+    EXPECT_EQ(pResources->GetNumSBs(), 1u);
+}
+
+// Minimal SPIRV assembler for tests that require constructs glslang never emits
+class SPIRVBuilder
+{
+public:
+    Uint32 NewId()
+    {
+        return m_Bound++;
+    }
+
+    void Add(Uint32 Opcode, std::initializer_list<Uint32> Operands, const char* Str = nullptr)
+    {
+        const auto Start = m_Words.size();
+        m_Words.push_back(Opcode);
+        m_Words.insert(m_Words.end(), Operands.begin(), Operands.end());
+        if (Str != nullptr)
+        {
+            // Literal strings are nul-terminated and padded to the word boundary
+            const auto Len      = strlen(Str);
+            const auto NumWords = Len / sizeof(Uint32) + 1;
+            const auto Offset   = m_Words.size();
+            m_Words.resize(Offset + NumWords, 0);
+            memcpy(&m_Words[Offset], Str, Len);
+        }
+        m_Words[Start] |= static_cast<Uint32>(m_Words.size() - Start) << 16;
+    }
+
+    std::vector<uint32_t> GetSPIRV() const
+    {
+        auto SPIRV = m_Words;
+        SPIRV[3]   = m_Bound;
+        return SPIRV;
+    }
+
+private:
+    std::vector<uint32_t> m_Words = {0x07230203, 0x00010000, 0, 0, 0};
+    Uint32                m_Bound = 1;
+};
+
+TEST_F(SPIRVShaderResourcesTest, DecorationGroups)
+{
+    // clang-format off
+    enum : Uint32
+    {
+        OpSource          = 3,
+        OpName            = 5,
+        OpMemoryModel     = 14,
+        OpEntryPoint      = 15,
+        OpExecutionMode   = 16,
+        OpCapability      = 17,
+        OpTypeVoid        = 19,
+        OpTypeFloat       = 22,
+        OpTypeVector      = 23,
+        OpTypeImage       = 25,
+        OpTypeStruct      = 30,
+        OpTypePointer     = 32,
+        OpTypeFunction    = 33,
+        OpFunction        = 54,
+        OpFunctionEnd     = 56,
+        OpVariable        = 59,
+        OpDecorate        = 71,
+        OpMemberDecorate  = 72,
+        OpDecorationGroup = 73,
+        OpGroupDecorate   = 74,
+        OpLabel           = 248,
+        OpReturn          = 253,
+
+        DecorationBlock         = 2,
+        DecorationBinding       = 33,
+        DecorationDescriptorSet = 34,
+        DecorationOffset        = 35,
+
+        StorageClassUniformConstant = 0,
+        StorageClassUniform         = 2,
+    };
+    // clang-format on
+
+    SPIRVBuilder Builder;
+
+    const auto Main   = Builder.NewId();
+    const auto Group  = Builder.NewId();
+    const auto Void   = Builder.NewId();
+    const auto FnType = Builder.NewId();
+    const auto Float  = Builder.NewId();
+    const auto Vec4   = Builder.NewId();
+    const auto Block  = Builder.NewId();
+    const auto PtrUB  = Builder.NewId();
+    const auto Image  = Builder.NewId();
+    const auto PtrImg = Builder.NewId();
+    const auto UB     = Builder.NewId();
+    const auto Tex    = Builder.NewId();
+    const auto Label  = Builder.NewId();
+
+    Builder.Add(OpCapability, {1 /*Shader*/});
+    Builder.Add(OpMemoryModel, {0 /*Logical*/, 1 /*GLSL450*/});
+    Builder.Add(OpEntryPoint, {4 /*Fragment*/, Main}, "main");
+    Builder.Add(OpExecutionMode, {Main, 7 /*OriginUpperLeft*/});
+    Builder.Add(OpSource, {2 /*GLSL*/, 450});
+    Builder.Add(OpName, {Main}, "main");
+    Builder.Add(OpName, {Block}, "CBuffer");
+    Builder.Add(OpName, {UB}, "g_CB");
+    Builder.Add(OpName, {Tex}, "g_Tex");
+    Builder.Add(OpDecorate, {Block, DecorationBlock});
+    Builder.Add(OpMemberDecorate, {Block, 0, DecorationOffset, 0});
+    Builder.Add(OpDecorate, {UB, DecorationBinding, 0});
+    Builder.Add(OpDecorate, {Tex, DecorationBinding, 1});
+    // Descriptor set is applied through a decoration group
+    Builder.Add(OpDecorate, {Group, DecorationDescriptorSet, 2});
+    Builder.Add(OpDecorationGroup, {Group});
+    Builder.Add(OpGroupDecorate, {Group, UB, Tex});
+    Builder.Add(OpTypeVoid, {Void});
+    Builder.Add(OpTypeFunction, {FnType, Void});
+    Builder.Add(OpTypeFloat, {Float, 32});
+    Builder.Add(OpTypeVector, {Vec4, Float, 4});
+    Builder.Add(OpTypeStruct, {Block, Vec4});
+    Builder.Add(OpTypePointer, {PtrUB, StorageClassUniform, Block});
+    Builder.Add(OpTypeImage, {Image, Float, 1 /*2D*/, 0, 0, 0, 1 /*Sampled*/, 0 /*Unknown*/});
+    Builder.Add(OpTypePointer, {PtrImg, StorageClassUniformConstant, Image});
+    Builder.Add(OpVariable, {PtrUB, UB, StorageClassUniform});
+    Builder.Add(OpVariable, {PtrImg, Tex, StorageClassUniformConstant});
+    Builder.Add(OpFunction, {Void, Main, 0, FnType});
+    Builder.Add(OpLabel, {Label});
+    Builder.Add(OpReturn, {});
+    Builder.Add(OpFunctionEnd, {});
+
+    const auto  SPIRV      = Builder.GetSPIRV();
+    const auto  pResources = TestResources(SPIRV, SHADER_TYPE_PIXEL, false);
+    const auto& Resources  = *pResources;
+    ASSERT_EQ(Resources.GetNumUBs(), 1u);
+    ASSERT_EQ(Resources.GetNumSepImgs(), 1u);
+
+    const auto& UBAttribs = Resources.GetUB(0);
+    EXPECT_STREQ(UBAttribs.Name, "CBuffer");
+    EXPECT_EQ(UBAttribs.BufferStaticSize, 16u);
+    ASSERT_NE(UBAttribs.DescriptorSetDecorationOffset, 0u);
+    EXPECT_EQ(SPIRV[UBAttribs.DescriptorSetDecorationOffset], 2u);
+
+    const auto& TexAttribs = Resources.GetSepImg(0);
+    EXPECT_STREQ(TexAttribs.Name, "g_Tex");
+    ASSERT_NE(TexAttribs.BindingDecorationOffset, 0u);
+    EXPECT_EQ(SPIRV[TexAttribs.BindingDecorationOffset], 1u);
+}
+
+} // namespace
@@ -28,6 +28,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "TestingEnvironment.hpp"
 #include "RenderDevice.h"
@@ -54,11 +55,12 @@ public:
 
     struct CreateInfo
     {
-        RENDER_DEVICE_TYPE deviceType             = RENDER_DEVICE_TYPE_UNDEFINED;
-        ADAPTER_TYPE       AdapterType            = ADAPTER_TYPE_UNKNOWN;
-        Uint32             AdapterId              = DEFAULT_ADAPTER_ID;
-        Uint32             NumDeferredContexts    = 4;
-        bool               EnableDeviceSimulation = false;
+        RENDER_DEVICE_TYPE deviceType                       = RENDER_DEVICE_TYPE_UNDEFINED;
+        ADAPTER_TYPE       AdapterType                      = ADAPTER_TYPE_UNKNOWN;
+        Uint32             AdapterId                        = DEFAULT_ADAPTER_ID;
+        Uint32             NumDeferredContexts              = 4;
+        Uint32             NumAsyncShaderCompilationThreads = 4;
+        bool               EnableDeviceSimulation           = false;
 
         DeviceFeatures Features{DEVICE_FEATURE_STATE_OPTIONAL};
     };
@@ -136,6 +138,22 @@ public:
 
     RefCntAutoPtr<ISampler> CreateSampler(const SamplerDesc& Desc);
 
+    // Copies Size bytes from the beginning of the buffer to a staging buffer, waits
+    // for the immediate context to become idle and writes the data to pData.
+    // Returns false if the staging buffer could not be created.
+    bool ReadBuffer(IBuffer* pBuffer, Uint64 Size, void* pData);
+
+    // Reads the first NumElements elements of type T from the buffer.
+    // Returns an empty vector if the data could not be read.
+    template <typename T>
+    std::vector<T> ReadBuffer(IBuffer* pBuffer, size_t NumElements)
+    {
+        std::vector<T> Data(NumElements);
+        if (!ReadBuffer(pBuffer, Uint64{sizeof(T)} * NumElements, Data.data()))
+            Data.clear();
+        return Data;
+    }
+
     void            SetDefaultCompiler(SHADER_COMPILER compiler);
     SHADER_COMPILER GetDefaultCompiler(SHADER_SOURCE_LANGUAGE lang) const;
 
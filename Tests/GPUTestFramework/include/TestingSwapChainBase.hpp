@@ -209,6 +209,10 @@ public:
         UNEXPECTED("Testing swap chain can't set the maximum frame latency");
     }
 
+    virtual void DILIGENT_CALL_TYPE WaitForFrame() override final
+    {
+    }
+
     virtual ITextureView* DILIGENT_CALL_TYPE GetCurrentBackBufferRTV() override final
     {
         return m_pRTV;
@@ -30,12 +30,14 @@
 #include <string>
 #include <vector>
 #include <atomic>
+#include <cstring>
 
 #include "GPUTestingEnvironment.hpp"
 #include "PlatformDebug.hpp"
 #include "TestingSwapChainBase.hpp"
 #include "StringTools.hpp"
 #include "GraphicsAccessories.hpp"
+#include "Cast.hpp"
 
 #if D3D11_SUPPORTED
 #    include "EngineFactoryD3D11.h"
@@ -252,9 +254,10 @@ GPUTestingEnvironment::GPUTestingEnvironment(const CreateInfo& EnvCI, const Swap
                                   return DisplayModes;
                               });
 
-            EngineCI.AdapterId           = FindAdapter(Adapters, EnvCI.AdapterType, EnvCI.AdapterId);
-            NumDeferredCtx               = EnvCI.NumDeferredContexts;
-            EngineCI.NumDeferredContexts = NumDeferredCtx;
+            EngineCI.AdapterId                        = FindAdapter(Adapters, EnvCI.AdapterType, EnvCI.AdapterId);
+            NumDeferredCtx                            = EnvCI.NumDeferredContexts;
+            EngineCI.NumDeferredContexts              = NumDeferredCtx;
+            EngineCI.NumAsyncShaderCompilationThreads = EnvCI.NumAsyncShaderCompilationThreads;
             ppContexts.resize(std::max(size_t{1}, ContextCI.size()) + NumDeferredCtx);
             pFactoryD3D11->CreateDeviceAndContextsD3D11(EngineCI, &m_pDevice, ppContexts.data());
         }
@@ -316,8 +319,9 @@ GPUTestingEnvironment::GPUTestingEnvironment(const CreateInfo& EnvCI, const Swap
             EngineCI.DynamicDescriptorAllocationChunkSize[0] = 8;  // D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV
             EngineCI.DynamicDescriptorAllocationChunkSize[1] = 8;  // D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER
 
-            NumDeferredCtx               = EnvCI.NumDeferredContexts;
-            EngineCI.NumDeferredContexts = NumDeferredCtx;
+            NumDeferredCtx                            = EnvCI.NumDeferredContexts;
+            EngineCI.NumDeferredContexts              = NumDeferredCtx;
+            EngineCI.NumAsyncShaderCompilationThreads = EnvCI.NumAsyncShaderCompilationThreads;
             ppContexts.resize(std::max(size_t{1}, ContextCI.size()) + NumDeferredCtx);
             pFactoryD3D12->CreateDeviceAndContextsD3D12(EngineCI, &m_pDevice, ppContexts.data());
         }
@@ -403,8 +407,9 @@ GPUTestingEnvironment::GPUTestingEnvironment(const CreateInfo& EnvCI, const Swap
             //EngineCI.HostVisibleMemoryReserveSize = 48 << 20;
             EngineCI.Features = EnvCI.Features;
 
-            NumDeferredCtx               = EnvCI.NumDeferredContexts;
-            EngineCI.NumDeferredContexts = NumDeferredCtx;
+            NumDeferredCtx                            = EnvCI.NumDeferredContexts;
+            EngineCI.NumDeferredContexts              = NumDeferredCtx;
+            EngineCI.NumAsyncShaderCompilationThreads = EnvCI.NumAsyncShaderCompilationThreads;
             ppContexts.resize(std::max(size_t{1}, ContextCI.size()) + NumDeferredCtx);
             pFactoryVk->CreateDeviceAndContextsVk(EngineCI, &m_pDevice, ppContexts.data());
         }
@@ -436,8 +441,9 @@ GPUTestingEnvironment::GPUTestingEnvironment(const CreateInfo& EnvCI, const Swap
             // Always enable validation
             EngineCI.SetValidationLevel(VALIDATION_LEVEL_1);
 
-            NumDeferredCtx               = EnvCI.NumDeferredContexts;
-            EngineCI.NumDeferredContexts = NumDeferredCtx;
+            NumDeferredCtx                            = EnvCI.NumDeferredContexts;
+            EngineCI.NumDeferredContexts              = NumDeferredCtx;
+            EngineCI.NumAsyncShaderCompilationThreads = EnvCI.NumAsyncShaderCompilationThreads;
             ppContexts.resize(std::max(size_t{1}, ContextCI.size()) + NumDeferredCtx);
             pFactoryMtl->CreateDeviceAndContextsMtl(EngineCI, &m_pDevice, ppContexts.data());
         }
@@ -641,6 +647,38 @@ RefCntAutoPtr<ISampler> GPUTestingEnvironment::CreateSampler(const SamplerDesc&
     return pSampler;
 }
 
+bool GPUTestingEnvironment::ReadBuffer(IBuffer* pBuffer, Uint64 Size, void* pData)
+{
+    VERIFY_EXPR(pBuffer != nullptr && pData != nullptr);
+    if (Size == 0)
+        return true;
+
+    BufferDesc Desc;
+    Desc.Name           = "Testing environment read-back staging buffer";
+    Desc.Size           = Size;
+    Desc.Usage          = USAGE_STAGING;
+    Desc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<IBuffer> pStaging;
+    m_pDevice->CreateBuffer(Desc, nullptr, &pStaging);
+    if (!pStaging)
+        return false;
+
+    auto* pContext = GetDeviceContext();
+    pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStaging, 0, Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    void* pMappedData = nullptr;
+    pContext->MapBuffer(pStaging, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pMappedData);
+    if (pMappedData == nullptr)
+        return false;
+
+    memcpy(pData, pMappedData, StaticCast<size_t>(Size));
+    pContext->UnmapBuffer(pStaging, MAP_READ);
+    return true;
+}
+
 void GPUTestingEnvironment::SetDefaultCompiler(SHADER_COMPILER compiler)
 {
     switch (m_pDevice->GetDeviceInfo().Type)
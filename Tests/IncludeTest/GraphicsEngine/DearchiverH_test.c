@@ -28,11 +28,15 @@
 
 void TestDearchiver_CInterface(IDearchiver* pDearchiver)
 {
-    IDearchiver_LoadArchive(pDearchiver, (IDataBlob*)NULL, false);
+    IDearchiver_LoadArchive(pDearchiver, (IDataBlob*)NULL, false, false);
     IDearchiver_UnpackShader(pDearchiver, (const ShaderUnpackInfo*)NULL, (IShader**)NULL);
     IDearchiver_UnpackPipelineState(pDearchiver, (const PipelineStateUnpackInfo*)NULL, (IPipelineState**)NULL);
     IDearchiver_UnpackResourceSignature(pDearchiver, (const ResourceSignatureUnpackInfo*)NULL, (IPipelineResourceSignature**)NULL);
     IDearchiver_UnpackRenderPass(pDearchiver, (const RenderPassUnpackInfo*)NULL, (IRenderPass**)NULL);
     IDearchiver_Store(pDearchiver, (IDataBlob**)NULL);
+    IDearchiver_StoreUsageManifest(pDearchiver, (IDataBlob**)NULL);
+    IDearchiver_Prefetch(pDearchiver, (const DearchiverPrefetchInfo*)NULL);
+    DearchiverPrefetchProgress Progress = IDearchiver_GetPrefetchProgress(pDearchiver);
+    (void)Progress;
     IDearchiver_Reset(pDearchiver);
 }
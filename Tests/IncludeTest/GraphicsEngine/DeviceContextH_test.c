@@ -36,6 +36,7 @@ void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
     (void)(pDesc);
 
     IDeviceContext_Begin(pCtx, 0u);
+    IDeviceContext_BeginReusable(pCtx, 0u);
 
     IDeviceContext_TransitionShaderResources(pCtx, (struct IPipelineState*)NULL, (struct IShaderResourceBinding*)NULL);
     IDeviceContext_TransitionResourceStates(pCtx, 1u, (const struct StateTransitionDesc*)NULL);
@@ -63,6 +64,8 @@ void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
     IDeviceContext_DrawIndexedIndirect(pCtx, (struct DrawIndexedIndirectAttribs*)NULL);
     IDeviceContext_DrawMesh(pCtx, (struct DrawMeshAttribs*)NULL);
     IDeviceContext_DrawMeshIndirect(pCtx, (struct DrawMeshIndirectAttribs*)NULL);
+    IDeviceContext_MultiDraw(pCtx, (struct MultiDrawAttribs*)NULL);
+    IDeviceContext_MultiDrawIndexed(pCtx, (struct MultiDrawIndexedAttribs*)NULL);
 
     IDeviceContext_DispatchCompute(pCtx, (const DispatchComputeAttribs*)NULL);
     IDeviceContext_DispatchComputeIndirect(pCtx, (const DispatchComputeIndirectAttribs*)NULL);
@@ -81,6 +84,14 @@ void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
 
     IDeviceContext_BeginQuery(pCtx, (struct IQuery*)NULL);
     IDeviceContext_EndQuery(pCtx, (struct IQuery*)NULL);
+    IDeviceContext_BeginIndexedQuery(pCtx, (struct IQueryArray*)NULL, 0u);
+    IDeviceContext_EndIndexedQuery(pCtx, (struct IQueryArray*)NULL, 0u);
+    IDeviceContext_ResolveQueryArray(pCtx, (const struct ResolveQueryArrayAttribs*)NULL);
+    IDeviceContext_SetPredication(pCtx, (struct IBuffer*)NULL, (Uint64)0, PREDICATION_OP_SKIP_IF_ZERO);
+    IDeviceContext_SetQueryPredication(pCtx, (struct IQuery*)NULL, PREDICATION_OP_SKIP_IF_ZERO);
+    IDeviceContext_SetCullMode(pCtx, CULL_MODE_BACK);
+    IDeviceContext_SetDepthStencilState(pCtx, (const struct DepthStencilStateDesc*)NULL);
+    IDeviceContext_SetPrimitiveTopology(pCtx, PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
 
     IDeviceContext_UpdateBuffer(pCtx, (struct IBuffer*)NULL, (Uint64)1, (Uint64)1, NULL, RESOURCE_STATE_TRANSITION_MODE_NONE);
     IDeviceContext_CopyBuffer(pCtx, (struct IBuffer*)NULL, (Uint64)0, RESOURCE_STATE_TRANSITION_MODE_NONE, (struct IBuffer*)NULL, (Uint64)0, (Uint64)128, RESOURCE_STATE_TRANSITION_MODE_NONE);
@@ -91,9 +102,11 @@ void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
     IDeviceContext_MapTextureSubresource(pCtx, (struct ITexture*)NULL, 0u, 0u, MAP_WRITE, MAP_FLAG_DISCARD, (const struct Box*)NULL, (struct MappedTextureSubresource*)NULL);
     IDeviceContext_UnmapTextureSubresource(pCtx, (struct ITexture*)NULL, 0u, 0u);
     IDeviceContext_GenerateMips(pCtx, (struct ITextureView*)NULL);
+    IDeviceContext_GenerateMipsBatch(pCtx, (struct ITextureView* const*)NULL, 0u);
     IDeviceContext_ResolveTextureSubresource(pCtx, (struct ITexture*)NULL, (struct ITexture*)NULL, (const struct ResolveTextureSubresourceAttribs*)NULL);
 
     IDeviceContext_BuildBLAS(pCtx, (struct BuildBLASAttribs*)NULL);
+    IDeviceContext_BuildBLASBatch(pCtx, (struct BuildBLASBatchAttribs*)NULL);
     IDeviceContext_BuildTLAS(pCtx, (struct BuildTLASAttribs*)NULL);
     IDeviceContext_CopyBLAS(pCtx, (struct CopyBLASAttribs*)NULL);
     IDeviceContext_CopyTLAS(pCtx, (struct CopyTLASAttribs*)NULL);
@@ -51,4 +51,7 @@ void TestPipelineState_CInterface(IPipelineState* pPSO)
     (void)Compatible;
 
     IPipelineState_InitializeStaticSRBResources(pPSO, (struct IShaderResourceBinding*)NULL);
+
+    PIPELINE_STATE_STATUS Status = IPipelineState_GetStatus(pPSO, false);
+    (void)Status;
 }
@@ -37,3 +37,12 @@ void TestQueryCInterface(IQuery* pQuery)
 
     IQuery_Invalidate(pQuery);
 }
+
+void TestQueryArrayCInterface(IQueryArray* pQueryArray)
+{
+    const QueryArrayDesc* pDesc = IQueryArray_GetDesc(pQueryArray);
+    (void)pDesc;
+
+    Uint32 Stride = IQueryArray_GetQueryDataStride(pQueryArray);
+    (void)Stride;
+}
@@ -40,4 +40,12 @@ void TestRenderDeviceD3D12CInterface(IRenderDeviceD3D12* pDevice)
     IRenderDeviceD3D12_CreateTLASFromD3DResource(pDevice, (ID3D12Resource*)NULL, (TopLevelASDesc*)NULL, RESOURCE_STATE_BUILD_AS_READ, (ITopLevelAS**)NULL);
     const ShaderVersion* MaxVer = IRenderDeviceD3D12_GetMaxShaderVersion(pDevice);
     (void)MaxVer;
+
+    GPUDescriptorHeapStatsD3D12 HeapStats;
+    IRenderDeviceD3D12_GetGPUDescriptorHeapStats(pDevice, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, &HeapStats);
+    Uint32 NumRelocated = IRenderDeviceD3D12_CompactGPUDescriptorHeaps(pDevice, 256);
+    (void)NumRelocated;
+
+    DynamicHeapStatsD3D12 DynHeapStats;
+    IRenderDeviceD3D12_GetDynamicHeapStats(pDevice, &DynHeapStats);
 }
@@ -30,4 +30,5 @@
 void TestShaderD3D_CInterface(IShaderD3D* pShaderD3D)
 {
     IShaderD3D_GetHLSLResource(pShaderD3D, 0, (HLSLShaderResourceDesc*)NULL);
+    IShaderD3D_GetBytecodeWithResources(pShaderD3D, (IDataBlob**)NULL);
 }
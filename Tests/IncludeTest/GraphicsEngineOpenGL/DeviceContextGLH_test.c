@@ -32,4 +32,8 @@ void TestDeviceContextGL_CInterface(IDeviceContextGL* pCtxGL)
     bool res = IDeviceContextGL_UpdateCurrentGLContext(pCtxGL);
     (void)res;
     IDeviceContextGL_SetSwapChain(pCtxGL, (struct ISwapChainGL*)NULL);
+
+    GLStateCacheStats Stats;
+    IDeviceContextGL_GetStateCacheStats(pCtxGL, &Stats);
+    IDeviceContextGL_ResetStateCacheStats(pCtxGL);
 }
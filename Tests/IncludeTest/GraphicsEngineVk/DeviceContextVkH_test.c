@@ -32,4 +32,6 @@ void TestDeviceContextVk_CInterface(IDeviceContextVk* pCtx)
 {
     IDeviceContextVk_TransitionImageLayout(pCtx, (ITexture*)NULL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
     IDeviceContextVk_BufferMemoryBarrier(pCtx, (IBuffer*)NULL, VK_ACCESS_HOST_READ_BIT);
+    IDeviceContextVk_BeginSecondary(pCtx, 0, (IRenderPass*)NULL, 0, (IFramebuffer*)NULL);
+    IDeviceContextVk_SetSubpassContents(pCtx, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
 }